@@ -32,49 +32,111 @@
 #include <DcgmUtilities.h>
 #include <Defer.hpp>
 
+#include <array>
 #include <atomic>
 #include <boost/asio.hpp>
 #include <boost/process.hpp>
 #include <boost/process/extend.hpp>
+#include <boost/process/posix.hpp>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/syscall.h>
 #include <thread>
+#include <unistd.h>
 
 
 namespace DcgmNs::Common::Subprocess
 {
 
-void ChangeUser(std::optional<std::string> userName)
+/*
+ * The child is started with vfork(), so everything between vfork and exec runs on the parent's memory while the
+ * parent thread is suspended. Only async-signal-safe calls are allowed there: no allocations, no logging, no stdio
+ * and no exit(), which would run the parent's atexit handlers.
+ */
+
+/* Report an error on the stderr of the child, which is already redirected to the parent, and exit. */
+[[noreturn]] void ExitChild(std::string_view msg) noexcept
 {
-    if (!userName)
+    [[maybe_unused]] auto const ret = write(STDERR_FILENO, msg.data(), msg.size());
+    _exit(EXIT_FAILURE);
+}
+
+/* Make each parent fd available in the child as its child fd. Runs in the child between vfork and exec */
+void ShareFds(std::vector<std::pair<int, int>> const &sharedFds) noexcept
+{
+    for (auto const &[childFd, parentFd] : sharedFds)
     {
-        return;
+        // dup2 onto the same fd keeps FD_CLOEXEC, so clear it explicitly
+        int const ret = childFd == parentFd ? fcntl(childFd, F_SETFD, 0) : dup2(parentFd, childFd);
+        if (ret < 0)
+        {
+            ExitChild("Unable to share an fd with the child\n");
+        }
     }
+}
 
+/*
+ * Look up the service account in the parent: getpwnam_r may load NSS modules and allocates, so it cannot run after
+ * vfork. Returns std::nullopt if there is no such user, in which case the child exits with an error.
+ */
+std::optional<UserCredentials> ResolveUser(std::string const &userName)
+{
     try
     {
-        if (auto const newCred = GetUserCredentials(userName->c_str()); newCred.has_value())
-        {
-            ChangeUser(ChangeUserPolicy::Permanently, *newCred);
-            log_debug("Successfully change user to [{}].", *userName);
-        }
-        else
+        auto newCred = GetUserCredentials(userName.c_str());
+        if (!newCred.has_value())
         {
-            std::string errMsg
-                = fmt::format("Unable to find credentials for specified service account [{}]", userName->c_str());
-            log_error(errMsg);
-            fmt::print(stderr, "{}\n", errMsg);
-            fflush(stderr);
-
-            exit(EXIT_FAILURE);
+            log_error("Unable to find credentials for specified service account [{}]", userName);
         }
+        return newCred;
     }
     catch (std::exception const &ex)
     {
-        std::string errMsg = fmt::format("Unable to change privileges. Ex: [{}]", ex.what());
-        log_error(errMsg);
-        fmt::print(stderr, "{}\n", errMsg);
-        fflush(stderr);
+        log_error("Unable to get credentials of service account [{}]. Ex: [{}]", userName, ex.what());
+        return std::nullopt;
+    }
+}
+
+/*
+ * Permanently switch the child to the credentials resolved by ResolveUser(). Runs in the child between vfork and
+ * exec. Mirrors ChangeUser(ChangeUserPolicy::Permanently, ...) but calls the kernel directly: the glibc wrappers of
+ * setuid() and friends would broadcast the change to every thread they know of, which are the parent's threads.
+ */
+void ChangeUser(std::optional<std::string> const &userName, std::optional<UserCredentials> const &newCred) noexcept
+{
+    if (!userName)
+    {
+        return;
+    }
+    if (!newCred)
+    {
+        ExitChild("Unable to find credentials for specified service account\n");
+    }
+
+    uid_t const oldUid = geteuid();
+    gid_t const oldGid = getegid();
 
-        exit(EXIT_FAILURE);
+    if (oldUid == 0 && syscall(SYS_setgroups, 1, &newCred->gid) != 0)
+    {
+        ExitChild("Unable to change groups\n");
+    }
+    if (syscall(SYS_setresgid, newCred->gid, newCred->gid, newCred->gid) != 0)
+    {
+        ExitChild("Unable to permanently drop root privileges. setresgid failed\n");
+    }
+    if (newCred->uid != oldUid && syscall(SYS_setresuid, newCred->uid, newCred->uid, newCred->uid) != 0)
+    {
+        ExitChild("Unable to permanently drop root privileges. setresuid failed\n");
+    }
+
+    /* Trying to reacquire root privileges. This must fail as we are permanently dropping them */
+    if (newCred->gid != oldGid && (syscall(SYS_setresgid, -1, oldGid, -1) == 0 || getegid() != newCred->gid))
+    {
+        ExitChild("Failed to drop root privileges. Managed to reacquire root egid.\n");
+    }
+    if (newCred->uid != oldUid && (syscall(SYS_setresuid, -1, oldUid, -1) == 0 || geteuid() != newCred->uid))
+    {
+        ExitChild("Failed to drop root privileges. Managed to reacquire root euid.\n");
     }
 }
 
@@ -104,16 +166,21 @@ struct ChildProcess::Impl
 
     static auto FdProcess(ChildProcess::Impl &self) -> boost::asio::awaitable<int>
     {
-        auto cancellationState            = co_await boost::asio::this_coro::cancellation_state;
-        constexpr unsigned int bufferSize = 65536;
-        std::vector<std::byte> buffer(bufferSize);
+        auto cancellationState             = co_await boost::asio::this_coro::cancellation_state;
+        constexpr unsigned int minReadSize = 65536;
         while (cancellationState.cancelled() == boost::asio::cancellation_type::none)
         {
             try
             {
-                size_t read = co_await self.fdResponses.ReadEnd().async_read_some(boost::asio::buffer(buffer),
-                                                                                  boost::asio::use_awaitable);
-                self.fdChannel.Write({ buffer.data(), read });
+                // Read straight into the free space of the channel. With two buffers asio issues a single readv()
+                auto const regions = self.fdChannel.PrepareWrite(minReadSize);
+                std::array<boost::asio::mutable_buffer, 2> const buffers {
+                    boost::asio::buffer(regions[0].data(), regions[0].size()),
+                    boost::asio::buffer(regions[1].data(), regions[1].size()),
+                };
+                size_t read
+                    = co_await self.fdResponses.ReadEnd().async_read_some(buffers, boost::asio::use_awaitable);
+                self.fdChannel.CommitWrite(read);
             }
             catch (boost::system::system_error const &e)
             {
@@ -149,11 +216,11 @@ struct ChildProcess::Impl
         {
             try
             {
-                co_await boost::asio::async_read_until(sourcePipe, buffer, '\n', boost::asio::use_awaitable);
-                std::istream tmpInputStream(&buffer);
-                std::string line;
-                std::getline(tmpInputStream, line);
-                target.Write(line);
+                size_t const lineSize
+                    = co_await boost::asio::async_read_until(sourcePipe, buffer, '\n', boost::asio::use_awaitable);
+                auto const begin = boost::asio::buffers_begin(buffer.data());
+                target.Write(std::string(begin, begin + (lineSize - 1)));
+                buffer.consume(lineSize);
             }
             catch (boost::system::system_error const &e)
             {
@@ -184,7 +251,13 @@ struct ChildProcess::Impl
     void Run()
     {
         namespace bp = boost::process;
-        process      = bp::child { executable,
+
+        if (userName)
+        {
+            userCredentials = ResolveUser(*userName);
+        }
+
+        process = bp::child { executable,
                               bp::args(args),
                               bp::std_out > stdOutPipe,
                               bp::std_err > stdErrPipe,
@@ -192,7 +265,10 @@ struct ChildProcess::Impl
                               bp::env = environment,
                               bp::posix::fd.bind(channelFd, fdResponses.WriteEnd().native_handle()),
                               bp::extend::on_success([this](auto      &/* exec */) { fdResponses.CloseWriteEnd(); }),
-                              bp::extend::on_exec_setup([this](auto & /* exec */) { ChangeUser(this->userName); }),
+                              bp::extend::on_exec_setup([this](auto & /* exec */) {
+                                  ShareFds(this->sharedFds);
+                                  ChangeUser(this->userName, this->userCredentials);
+                              }),
                               bp::on_exit([this](int exit, const std::error_code & /* ec */) {
                                   {
                                       std::unique_lock<std::mutex> lock(lockProcessStatus);
@@ -211,6 +287,7 @@ struct ChildProcess::Impl
                                   }
                                   cvProcessStatus.notify_one();
                               }),
+                              bp::posix::use_vfork,
                               ioContext };
 
         log_info("Process {} spawned with pid: {}", executable.string(), process.id());
@@ -378,6 +455,7 @@ struct ChildProcess::Impl
     }
 
     int channelFd;
+    std::vector<std::pair<int, int>> sharedFds; // child fd, parent fd
     boost::asio::io_context ioContext;
 
     Pipe fdResponses;
@@ -391,6 +469,7 @@ struct ChildProcess::Impl
     boost::filesystem::path executable;
     std::vector<std::string> args;
     std::optional<std::string> userName;
+    std::optional<UserCredentials> userCredentials; // resolved in the parent before vfork
     boost::process::environment environment;
 
     StdLines stdOutLines;
@@ -441,11 +520,13 @@ ChildProcess Create(boost::filesystem::path const &executable,
                     std::vector<std::string> const &args,
                     std::unordered_map<std::string, std::string> const &env,
                     std::optional<std::string> const &userName,
-                    int channelFd)
+                    int channelFd,
+                    std::vector<std::pair<int, int>> const &sharedFds)
 {
     auto impl         = std::make_unique<ChildProcess::Impl>();
     impl->executable  = executable;
     impl->channelFd   = channelFd;
+    impl->sharedFds   = sharedFds;
     impl->args        = args;
     impl->userName    = userName;
     impl->environment = static_cast<boost::process::environment>(boost::this_process::environment());
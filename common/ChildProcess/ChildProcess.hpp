@@ -26,6 +26,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 
@@ -63,13 +64,15 @@ private:
                                std::vector<std::string> const &args,
                                std::unordered_map<std::string, std::string> const &env,
                                std::optional<std::string> const &userName,
-                               int channelFd);
+                               int channelFd,
+                               std::vector<std::pair<int, int>> const &sharedFds);
 };
 
 ChildProcess Create(boost::filesystem::path const &executable,
                     std::vector<std::string> const &args,
                     std::unordered_map<std::string, std::string> const &env,
                     std::optional<std::string> const &userName,
-                    int channelFd);
+                    int channelFd,
+                    std::vector<std::pair<int, int>> const &sharedFds);
 
 } //namespace DcgmNs::Common::Subprocess
\ No newline at end of file
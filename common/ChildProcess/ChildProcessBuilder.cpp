@@ -50,8 +50,12 @@ ChildProcessBuilder &ChildProcessBuilder::AddArgs(std::vector<std::string> args)
 
 ChildProcess ChildProcessBuilder::Build()
 {
-    return Create(
-        m_executable, m_args, m_environment, m_user.empty() ? std::nullopt : std::optional { m_user }, m_channelFd);
+    return Create(m_executable,
+                  m_args,
+                  m_environment,
+                  m_user.empty() ? std::nullopt : std::optional { m_user },
+                  m_channelFd,
+                  m_sharedFds);
 }
 
 ChildProcessBuilder &ChildProcessBuilder::AddEnvironment(std::unordered_map<std::string, std::string> env)
@@ -69,4 +73,10 @@ ChildProcessBuilder &ChildProcessBuilder::SetChannelFd(int const fd)
     return *this;
 }
 
+ChildProcessBuilder &ChildProcessBuilder::ShareFd(int const childFd, int const parentFd)
+{
+    m_sharedFds.emplace_back(childFd, parentFd);
+    return *this;
+}
+
 } //namespace DcgmNs::Common::Subprocess
\ No newline at end of file
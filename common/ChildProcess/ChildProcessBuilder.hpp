@@ -38,6 +38,8 @@ public:
     ChildProcessBuilder &AddArgs(std::vector<std::string> args);
     ChildProcessBuilder &AddEnvironment(std::unordered_map<std::string, std::string> env);
     ChildProcessBuilder &SetChannelFd(int const fd);
+    /* Make parentFd available to the child as childFd. The caller keeps ownership of parentFd */
+    ChildProcessBuilder &ShareFd(int const childFd, int const parentFd);
     ChildProcess Build();
 
 private:
@@ -46,6 +48,7 @@ private:
     std::unordered_map<std::string, std::string> m_environment;
     std::string m_user;
     int m_channelFd = DEFAULT_CHANNEL_FD;
+    std::vector<std::pair<int, int>> m_sharedFds;
 };
 
 } //namespace DcgmNs::Common::Subprocess
\ No newline at end of file
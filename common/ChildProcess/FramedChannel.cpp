@@ -18,11 +18,13 @@
 
 #include <DcgmLogging.h>
 
-#include <boost/circular_buffer.hpp>
-
+#include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
+#include <mutex>
 
 namespace DcgmNs::Common::Subprocess
 {
@@ -53,7 +55,12 @@ bool FramedChannel::FramedChannelIterator::equal(Sentinel) const
 struct FramedChannel::Impl
 {
     friend class FramedChannel::FramedChannelIterator;
-    boost::circular_buffer<std::byte> m_buffer;
+    std::vector<std::byte> m_storage; //!< Ring buffer
+    std::size_t m_head   = 0;         //!< Offset of the first byte that has not been consumed
+    std::size_t m_size   = 0;         //!< Bytes in the ring, including the frame the consumer is viewing
+    std::size_t m_pinned = 0;         //!< Bytes of the frame the consumer is viewing, released by its next read
+    std::vector<std::vector<std::byte>> m_retired; //!< Storage replaced while the consumer was viewing a frame in it
+    std::vector<std::byte> m_scratch;              //!< Frames that wrap around the end of the ring are copied here
     std::mutex m_lock;
     std::condition_variable m_notEmpty; //!< Condvar to signal that the buffer has some data to try to parse
     std::atomic_bool m_closed   = false;
@@ -74,65 +81,110 @@ struct FramedChannel::Impl
     }
 
     /**
-     * @brief Consumes one complete frame from the stream.
-     * Will block if there is no complete frame in the buffer yet.
-     * @returns One complete frame from the stream. The result will not contain length prefix from the protocol.
+     * @brief Copies \a count bytes starting \a offset bytes after the head of the ring to \a dest.
      */
-    [[nodiscard]] std::optional<std::vector<std::byte>> ReadOneFrame()
+    void CopyOut(std::size_t offset, std::size_t count, void *dest) const
     {
-        std::unique_lock<std::mutex> lock(m_lock);
-        if (m_buffer.size() < sizeof(std::uint32_t))
+        std::size_t const pos   = (m_head + offset) % m_storage.size();
+        std::size_t const first = std::min(count, m_storage.size() - pos);
+        memcpy(dest, m_storage.data() + pos, first);
+        memcpy(static_cast<std::byte *>(dest) + first, m_storage.data(), count - first);
+    }
+
+    /**
+     * @brief Drops \a count consumed bytes from the head of the ring.
+     */
+    void Consume(std::size_t count)
+    {
+        m_head = (m_head + count) % m_storage.size();
+        m_size -= count;
+    }
+
+    /**
+     * @brief Grows the ring so that it has at least \a count free bytes. Called by the producer with the lock held.
+     */
+    void Reserve(std::size_t count)
+    {
+        if (m_storage.size() - m_size >= count)
         {
-            do
-            {
-                m_notEmpty.wait_for(lock, std::chrono::milliseconds(100), [&] {
-                    return m_buffer.size() >= sizeof(std::uint32_t) || m_closed.load(std::memory_order_relaxed);
-                });
-            } while (m_buffer.size() < sizeof(std::uint32_t) && !m_closed.load(std::memory_order_relaxed));
+            return;
         }
 
-        if (m_buffer.size() < sizeof(std::uint32_t))
+        // The ring only grows: the reader waits till the whole frame is in the buffer, so a frame larger than the
+        // buffer would deadlock if the producer had to wait for free space instead.
+        std::vector<std::byte> storage(
+            std::max(m_storage.size() + count, static_cast<std::size_t>(m_storage.size() * 1.5)));
+        if (m_size > 0)
         {
-            assert(m_closed.load(std::memory_order_relaxed));
-            return std::nullopt;
+            CopyOut(0, m_size, storage.data());
         }
-
-        std::uint32_t len = 0;
-        if (m_buffer.array_one().second > sizeof(std::uint32_t))
+        if (m_pinned > 0)
         {
-            memcpy(&len, m_buffer.array_one().first, sizeof(std::uint32_t));
+            // The consumer holds a view into the current storage
+            m_retired.push_back(std::move(m_storage));
         }
-        else
+        m_storage = std::move(storage);
+        m_head    = 0;
+    }
+
+    /**
+     * @brief Waits until the ring holds at least \a count bytes.
+     * @returns false if the stream was closed before that
+     */
+    bool WaitFor(std::unique_lock<std::mutex> &lock, std::size_t count)
+    {
+        while (m_size < count && !m_closed.load(std::memory_order_relaxed))
         {
-            std::byte lenBytes[sizeof(std::uint32_t)] = {};
-            std::copy_n(m_buffer.begin(), sizeof(std::uint32_t), lenBytes);
-            memcpy(&len, lenBytes, sizeof(std::uint32_t));
+            m_notEmpty.wait_for(lock, std::chrono::milliseconds(100), [&] {
+                return m_size >= count || m_closed.load(std::memory_order_relaxed);
+            });
         }
+        return m_size >= count;
+    }
 
-        assert(len != 0);
-        m_buffer.rerase(m_buffer.begin(), m_buffer.begin() + sizeof(int));
+    /**
+     * @brief Consumes one complete frame from the stream.
+     * Will block if there is no complete frame in the buffer yet. Releases the frame returned by the previous call.
+     * @returns One complete frame from the stream. The result will not contain length prefix from the protocol.
+     *          It points into the ring or into the scratch buffer and is valid until the next call.
+     */
+    [[nodiscard]] std::optional<std::span<std::byte const>> ReadOneFrame()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (m_pinned > 0)
+        {
+            Consume(m_pinned);
+            m_pinned = 0;
+            m_retired.clear();
+        }
 
-        if ((size_t)len > m_buffer.size())
+        if (!WaitFor(lock, sizeof(std::uint32_t)))
         {
-            do
-            {
-                m_notEmpty.wait_for(lock, std::chrono::milliseconds(100), [&] {
-                    return m_buffer.size() >= (size_t)len || m_closed.load(std::memory_order_relaxed);
-                });
-            } while ((size_t)len > m_buffer.size() && !m_closed.load(std::memory_order_relaxed));
+            assert(m_closed.load(std::memory_order_relaxed));
+            return std::nullopt;
         }
 
-        if (m_buffer.size() < (size_t)len)
+        std::uint32_t len = 0;
+        CopyOut(0, sizeof(len), &len);
+        assert(len != 0);
+
+        if (!WaitFor(lock, sizeof(len) + len))
         {
             assert(m_closed.load(std::memory_order_relaxed));
             return std::nullopt;
         }
 
-        std::vector<std::byte> result(len);
-        std::copy_n(m_buffer.begin(), len, result.begin());
-        m_buffer.rerase(m_buffer.begin(), m_buffer.begin() + len);
+        std::size_t const pos = (m_head + sizeof(len)) % m_storage.size();
+        if (pos + len <= m_storage.size())
+        {
+            m_pinned = sizeof(len) + len;
+            return std::span<std::byte const>(m_storage.data() + pos, len);
+        }
 
-        return result;
+        m_scratch.resize(len);
+        CopyOut(sizeof(len), len, m_scratch.data());
+        Consume(sizeof(len) + len);
+        return std::span<std::byte const>(m_scratch.data(), len);
     }
 
     /**
@@ -146,13 +198,11 @@ struct FramedChannel::Impl
     }
 
     /**
-     * @brief Writes a chunk of bytes to the stream.
-     * Will block if there is not enough room in the buffer.
-
-     * @param[in] data Bytes to write
+     * @brief Returns the free space of the ring, growing it to at least \a count bytes.
+     * The consumer only moves the head, so the free space stays free while the producer fills it without the lock.
      * @throws \c StreamClosedException if the stream is closed
      */
-    void Write(std::span<std::byte const> data)
+    std::array<std::span<std::byte>, 2> PrepareWrite(std::size_t count)
     {
         if (m_closed.load(std::memory_order_relaxed))
         {
@@ -160,28 +210,49 @@ struct FramedChannel::Impl
             throw StreamClosedException { "Attempt to write to closed stream" };
         }
 
-        if (data.empty())
+        std::unique_lock<std::mutex> lock(m_lock);
+        Reserve(count);
+        std::size_t const free  = m_storage.size() - m_size;
+        std::size_t const tail  = (m_head + m_size) % m_storage.size();
+        std::size_t const first = std::min(free, m_storage.size() - tail);
+        return { std::span<std::byte>(m_storage.data() + tail, first),
+                 std::span<std::byte>(m_storage.data(), free - first) };
+    }
+
+    void CommitWrite(std::size_t count)
+    {
+        if (count == 0)
         {
             return;
         }
-
         {
             std::unique_lock<std::mutex> lock(m_lock);
-            if (data.size() > m_buffer.reserve())
-            {
-                // Here we could check that the size of the data is greater than m_buffer.capacity() and increase the
-                // capacity to the size of the data.
-                // Unfortunately, this would lead to a deadlock as the reader waits till the whole frame can be read
-                // from the buffer. If a frame cannot be fully written here without overwriting data that has not been
-                // consumed by the reader, we would get a deadlock.
-                m_buffer.set_capacity(std::max(m_buffer.capacity() + data.size(),
-                                               decltype(m_buffer)::capacity_type(m_buffer.capacity() * 1.5)));
-            }
-
-            m_buffer.insert(m_buffer.end(), data.begin(), data.end());
+            assert(m_size + count <= m_storage.size());
+            m_size += count;
         }
         m_notEmpty.notify_one();
     }
+
+    /**
+     * @brief Writes a chunk of bytes to the stream.
+     * Grows the buffer if there is not enough room in it.
+
+     * @param[in] data Bytes to write
+     * @throws \c StreamClosedException if the stream is closed
+     */
+    void Write(std::span<std::byte const> data)
+    {
+        auto const regions = PrepareWrite(data.size());
+        if (data.empty())
+        {
+            return;
+        }
+
+        std::size_t const first = std::min(data.size(), regions[0].size());
+        memcpy(regions[0].data(), data.data(), first);
+        memcpy(regions[1].data(), data.data() + first, data.size() - first);
+        CommitWrite(data.size());
+    }
 };
 
 FramedChannel::FramedChannelIterator FramedChannel::begin()
@@ -189,11 +260,26 @@ FramedChannel::FramedChannelIterator FramedChannel::begin()
     return FramedChannel::FramedChannelIterator(*this);
 }
 
+FramedChannel::FrameReader FramedChannel::Frames()
+{
+    return FramedChannel::FrameReader(*this);
+}
+
 void FramedChannel::Write(std::span<std::byte const> buffer)
 {
     m_impl->Write(buffer);
 }
 
+std::array<std::span<std::byte>, 2> FramedChannel::PrepareWrite(size_t minBytes)
+{
+    return m_impl->PrepareWrite(minBytes);
+}
+
+void FramedChannel::CommitWrite(size_t bytes)
+{
+    m_impl->CommitWrite(bytes);
+}
+
 void FramedChannel::Close()
 {
     m_impl->Close();
@@ -201,7 +287,7 @@ void FramedChannel::Close()
 
 FramedChannel::FramedChannel(size_t bufferSize)
 {
-    m_impl->m_buffer.set_capacity(bufferSize);
+    m_impl->m_storage.resize(std::max(bufferSize, size_t { 1 }));
 }
 
 FramedChannel::~FramedChannel() = default;
@@ -215,7 +301,8 @@ void FramedChannel::FramedChannelIterator::increment()
     }
     else
     {
-        m_value = *frame;
+        // Reuses the capacity of the previous frame
+        m_value.assign(frame->begin(), frame->end());
     }
 }
 
@@ -233,4 +320,20 @@ FramedChannel::FramedChannelIterator::~FramedChannelIterator()
         m_channel->m_impl->ReleaseConsumer();
     }
 }
+
+FramedChannel::FrameReader::FrameReader(FramedChannel &channel)
+    : m_channel(&channel)
+{
+    m_channel->m_impl->AddConsumer();
+}
+
+FramedChannel::FrameReader::~FrameReader()
+{
+    m_channel->m_impl->ReleaseConsumer();
+}
+
+std::optional<std::span<std::byte const>> FramedChannel::FrameReader::Next()
+{
+    return m_channel->m_impl->ReadOneFrame();
+}
 } //namespace DcgmNs::Common::Subprocess
\ No newline at end of file
@@ -21,7 +21,9 @@
 #include <DcgmUtilities.h>
 #include <boost/iterator/iterator_facade.hpp>
 
+#include <array>
 #include <cstddef>
+#include <optional>
 #include <span>
 
 
@@ -31,6 +33,10 @@ namespace DcgmNs::Common::Subprocess
 /**
  * @brief This is a single-producer, single-consumer channel that allows to write and read framed messages.
  * Each message is prefixed with a 32-bit size of the message.
+ *
+ * Bytes are kept in a ring buffer. A producer can read straight into its free space with \c PrepareWrite() and
+ * \c CommitWrite(), and a \c FrameReader hands frames out as views into it, so a frame is not copied on its way from
+ * the pipe to the consumer unless it wraps around the end of the ring.
  */
 class FramedChannel
 {
@@ -79,11 +85,47 @@ public:
         FramedChannel *m_channel       = nullptr;
         std::vector<std::byte> m_value = {};
     };
+
+    /**
+     * @brief Consumer that receives frames as views into the channel instead of copies.
+     * Like the iterator, only one consumer may exist at a time.
+     */
+    class FrameReader
+    {
+    public:
+        explicit FrameReader(FramedChannel &);
+        ~FrameReader();
+        FrameReader(FrameReader const &)            = delete;
+        FrameReader &operator=(FrameReader const &) = delete;
+
+        /**
+         * @brief Waits for the next frame.
+         * @returns The frame without the length prefix. The view is valid until the next call to \c Next() or until
+         *          the reader is destroyed. \c std::nullopt once the channel is closed and all frames are read.
+         */
+        [[nodiscard]] std::optional<std::span<std::byte const>> Next();
+
+    private:
+        FramedChannel *m_channel;
+    };
+
     /**
      * @brief Writes FramedMessage bytes into the channel.
      * @param[in] buffer message bytes. May be partial of the whole message if the buffer length is already written.
      */
     void Write(std::span<std::byte const> buffer);
+    /**
+     * @brief Returns the free space of the channel for a producer that reads straight into it, e.g. with readv().
+     * The regions are filled in order. The second one is only non-empty if the free space wraps around the end of the
+     * ring buffer. They stay valid until the next call of \c PrepareWrite(), \c CommitWrite() or \c Write().
+     * @param[in] minBytes The channel grows if it has less free space than this.
+     * @throws \c StreamClosedException if the channel is closed
+     */
+    std::array<std::span<std::byte>, 2> PrepareWrite(size_t minBytes);
+    /**
+     * @brief Hands \a bytes written into the regions returned by \c PrepareWrite() over to the consumer.
+     */
+    void CommitWrite(size_t bytes);
     /**
      * Closes the channel.
      *
@@ -92,6 +134,7 @@ public:
     void Close();
 
     FramedChannelIterator begin();
+    FrameReader Frames();
     static FramedChannelIterator end()
     {
         return FramedChannelIterator(Sentinel {});
@@ -103,9 +146,9 @@ public:
 private:
     struct Impl;
 #if defined(__x86_64__)
-    DcgmNs::Common::FastPimpl<Impl, 136, 8> m_impl;
+    DcgmNs::Common::FastPimpl<Impl, 192, 8> m_impl;
 #elif defined(__aarch64__)
-    DcgmNs::Common::FastPimpl<Impl, 144, 8> m_impl;
+    DcgmNs::Common::FastPimpl<Impl, 200, 8> m_impl;
 #endif
 };
 } //namespace DcgmNs::Common::Subprocess
@@ -49,7 +49,7 @@ void StdLines::StdLinesIterator::increment()
         m_stdlines = nullptr;
         return;
     }
-    m_currentValue = *lineOpt;
+    m_currentValue = std::move(*lineOpt);
 }
 
 StdLines::StdLinesIterator::StdLinesIterator(StdLines::StdOutSentinel /*sentinel*/)
@@ -72,10 +72,10 @@ StdLines::StdLinesIterator StdLines::end()
     return StdLines::StdLinesIterator(StdOutSentinel {});
 }
 
-void StdLines::Write(std::string const &str)
+void StdLines::Write(std::string str)
 {
     std::unique_lock<std::mutex> lock(m_lock);
-    m_container.push(str);
+    m_container.push(std::move(str));
     lock.unlock();
     m_notEmpty.notify_one();
 }
@@ -101,7 +101,7 @@ std::optional<std::string> StdLines::Read()
         return std::nullopt;
     }
 
-    std::string result = m_container.front();
+    std::string result = std::move(m_container.front());
     m_container.pop();
 
     // coverity[uninit_use_in_call]
@@ -109,4 +109,17 @@ std::optional<std::string> StdLines::Read()
     return result;
 }
 
+std::vector<std::string> StdLines::TakeBuffered()
+{
+    std::vector<std::string> lines;
+    std::unique_lock<std::mutex> lock(m_lock);
+    lines.reserve(m_container.size());
+    while (!m_container.empty())
+    {
+        lines.push_back(std::move(m_container.front()));
+        m_container.pop();
+    }
+    return lines;
+}
+
 } //namespace DcgmNs::Common::Subprocess
@@ -23,6 +23,7 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <vector>
 
 
 namespace DcgmNs::Common::Subprocess
@@ -59,15 +60,20 @@ public:
 
     /**
      * @brief Writes one line into buffer.
-     * @param[in] str message.
+     * @param[in] str message. Moved into the buffer.
      */
-    void Write(std::string const &str);
+    void Write(std::string str);
 
     /**
      * @brief Reads one line from buffer.
      */
     std::optional<std::string> Read();
 
+    /**
+     * @brief Takes the lines buffered so far without waiting for more.
+     */
+    std::vector<std::string> TakeBuffered();
+
     /**
      * Closes the channel.
      *
@@ -22,6 +22,9 @@
 #include <ChildProcess.hpp>
 #include <ChildProcessBuilder.hpp>
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 using namespace DcgmNs::Common::Subprocess;
 
 TEST_CASE("ChildProcessBuilder: Build with StdOut")
@@ -102,6 +105,30 @@ TEST_CASE("ChildProcessBuilder: Build with Channel File Descriptor")
     REQUIRE(process.ReceivedSignal() == std::nullopt);
 }
 
+TEST_CASE("ChildProcessBuilder: Build with Shared File Descriptor")
+{
+    int const sharedFd = memfd_create("childprocesstest", MFD_CLOEXEC);
+    REQUIRE(sharedFd >= 0);
+
+    auto process = ChildProcessBuilder {}
+                       .SetExecutable("./childprocesstesttool")
+                       .ShareFd(7, sharedFd)
+                       .AddArg("shared-fd")
+                       .AddArg("7")
+                       .AddArg("Capoo")
+                       .Build();
+    process.Run();
+    process.Wait();
+    REQUIRE(process.GetExitCode().has_value());
+    REQUIRE(*process.GetExitCode() == 0);
+
+    std::string data(5, '\0');
+    auto const bytesRead = pread(sharedFd, data.data(), data.size(), 0);
+    close(sharedFd);
+    REQUIRE(bytesRead == 5);
+    REQUIRE(data == "Capoo");
+}
+
 TEST_CASE("ChildProcessBuilder: Build with ReceivedSignal")
 {
     auto process = ChildProcessBuilder {}.SetExecutable("./childprocesstesttool").AddArg("sleep").AddArg("6").Build();
@@ -96,6 +96,20 @@ int FdChannel(int /* argc */, char *argv[])
     return 0;
 }
 
+int SharedFd(int /* argc */, char *argv[])
+{
+    int sharedFd    = atoi(argv[0]);
+    std::string msg = argv[1];
+
+    if (pwrite(sharedFd, msg.data(), msg.size(), 0) != static_cast<ssize_t>(msg.size()))
+    {
+        std::cerr << "Unable to write to shared fd " << sharedFd << "." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
 int Sleep(int /* argc */, char *argv[])
 {
     int seconds = atoi(argv[0]);
@@ -114,7 +128,7 @@ int main(int argc, char *argv[])
 
     std::unordered_map<std::string, std::pair<int, std::function<int(int, char *[])>>> handlers {
         { "stdout", { 1, Stdout } },        { "stderr", { 1, Stderr } }, { "env", { 1, Env } },
-        { "fd-channel", { 2, FdChannel } }, { "sleep", { 1, Sleep } },
+        { "fd-channel", { 2, FdChannel } }, { "sleep", { 1, Sleep } }, { "shared-fd", { 2, SharedFd } },
     };
 
     if (!handlers.contains(argv[1]))
@@ -18,8 +18,12 @@
 
 #include <ChildProcess/FramedChannel.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 
 TEST_CASE("FramedChannel: Write")
@@ -175,4 +179,97 @@ TEST_CASE("FramedChannel: Read from closed channel")
         ++count;
     }
     REQUIRE(count == 3);
-}
\ No newline at end of file
+}
+
+TEST_CASE("FramedChannel: FrameReader views frames in place")
+{
+    using namespace DcgmNs::Common::Subprocess;
+
+    // Small enough that the frames wrap around the end of the ring and make it grow
+    auto channel = FramedChannel { 16 };
+
+    auto writeFrame = [&channel](std::string_view message) {
+        std::uint32_t length = message.length();
+        channel.Write({ reinterpret_cast<std::byte const *>(&length), sizeof(length) });
+        channel.Write({ reinterpret_cast<std::byte const *>(message.data()), message.length() });
+    };
+
+    auto toString = [](std::span<std::byte const> frame) {
+        return std::string_view(reinterpret_cast<char const *>(frame.data()), frame.size());
+    };
+
+    auto frames = channel.Frames();
+    REQUIRE_THROWS_AS(channel.begin(), FramedChannel::ConsumerOccupiedException);
+
+    writeFrame("Capoo");
+    writeFrame("DogDog");
+    auto frame = frames.Next();
+    REQUIRE(frame.has_value());
+    CHECK(toString(*frame) == "Capoo");
+
+    // Growing the ring must not invalidate the frame that is being viewed
+    writeFrame(std::string(100, 'x'));
+    CHECK(toString(*frame) == "Capoo");
+
+    frame = frames.Next();
+    REQUIRE(frame.has_value());
+    CHECK(toString(*frame) == "DogDog");
+    frame = frames.Next();
+    REQUIRE(frame.has_value());
+    CHECK(toString(*frame) == std::string(100, 'x'));
+
+    for (int i = 0; i < 50; i++)
+    {
+        auto const message = std::to_string(i * 1000);
+        writeFrame(message);
+        frame = frames.Next();
+        REQUIRE(frame.has_value());
+        CHECK(toString(*frame) == message);
+    }
+
+    channel.Close();
+    CHECK_FALSE(frames.Next().has_value());
+}
+
+TEST_CASE("FramedChannel: PrepareWrite and CommitWrite")
+{
+    using namespace DcgmNs::Common::Subprocess;
+
+    auto channel = FramedChannel { 8 };
+
+    std::string_view message = "Hello, world!";
+    std::vector<std::byte> bytes(sizeof(std::uint32_t) + message.length());
+    std::uint32_t length = message.length();
+    std::memcpy(bytes.data(), &length, sizeof(length));
+    std::memcpy(bytes.data() + sizeof(length), message.data(), message.length());
+
+    for (int frame = 0; frame < 3; frame++)
+    {
+        std::span<std::byte const> remaining = bytes;
+        while (!remaining.empty())
+        {
+            // Fill the regions the way readv() would, a few bytes at a time
+            auto const regions = channel.PrepareWrite(4);
+            REQUIRE(regions[0].size() + regions[1].size() >= 4);
+            std::size_t written = 0;
+            for (auto const &region : regions)
+            {
+                auto const count = std::min({ region.size(), remaining.size(), size_t { 5 } - written });
+                std::memcpy(region.data(), remaining.data(), count);
+                remaining = remaining.subspan(count);
+                written += count;
+            }
+            channel.CommitWrite(written);
+        }
+    }
+    channel.Close();
+
+    int count = 0;
+    for (auto const &msg : channel)
+    {
+        CHECK(std::string_view(reinterpret_cast<char const *>(msg.data()), msg.size()) == message);
+        ++count;
+    }
+    CHECK(count == 3);
+    REQUIRE_THROWS_AS(channel.PrepareWrite(1), FramedChannel::StreamClosedException);
+}
@@ -21,6 +21,7 @@
 #include <cstring>
 #include <string>
 #include <thread>
+#include <vector>
 
 
 TEST_CASE("StdLines: Write")
@@ -128,3 +129,27 @@ TEST_CASE("StdLines: Read from closed channel")
     }
     REQUIRE(count == 3);
 }
+
+TEST_CASE("StdLines: Take buffered lines from an open channel")
+{
+    using namespace DcgmNs::Common::Subprocess;
+
+    auto stdLines = StdLines {};
+    REQUIRE(stdLines.TakeBuffered().empty());
+
+    stdLines.Write("Capoo");
+    stdLines.Write("Is");
+    REQUIRE(stdLines.TakeBuffered() == std::vector<std::string> { "Capoo", "Is" });
+    REQUIRE(stdLines.TakeBuffered().empty());
+
+    // Still usable after taking the lines
+    stdLines.Write("Cute!");
+    stdLines.Close();
+    int count = 0;
+    for (auto const &msg : stdLines)
+    {
+        REQUIRE(msg == "Cute!");
+        ++count;
+    }
+    REQUIRE(count == 1);
+}
@@ -0,0 +1,607 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Task.hpp"
+#include "TaskRunner.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <pthread.h>
+
+
+/**
+ * C++20 coroutines on top of the TaskRunner.
+ *
+ * A multi-step operation is written as a coroutine returning CoTask<T> and started with CoSpawn() on a TaskRunner,
+ * its home runner. Whenever it waits for something it suspends instead of blocking the runner thread, and it's resumed
+ * by a task queued on the home runner once the wait is over. Things that can be waited for with co_await are:
+ *  - Another CoTask<T>. It runs on the same home runner.
+ *  - CoRunOn(runner, func): func runs as a task on another runner, for example a thread that makes driver calls.
+ *  - CoSleepFor(duration) and CoSleepUntil(timePoint)
+ *  - CoCallback<T>(start): start is given a completion function to call with the result, from any thread.
+ *    This is how IPC responses are waited for. @sa DcgmClientHandler::AwaitModuleCommand()
+ *
+ * @code{.cpp}
+ * ```
+ *      CoTask<dcgmReturn_t> EnforceConfig(TaskRunner &nvmlRunner, unsigned int gpuId)
+ *      {
+ *          auto ret = co_await CoRunOn(nvmlRunner, [gpuId] { return SetClocks(gpuId); });
+ *          if (ret != DCGM_ST_OK)
+ *          {
+ *              co_return ret;
+ *          }
+ *          co_await CoSleepFor(std::chrono::milliseconds(100));
+ *          co_return co_await CoRunOn(nvmlRunner, [gpuId] { return VerifyClocks(gpuId); });
+ *      }
+ *
+ *      auto result = CoSpawn(taskRunner, EnforceConfig(nvmlRunner, 0));
+ * ```
+ * @endcode
+ *
+ * Runners have to outlive the coroutines that use them. If a runner drops a queued resumption, for example because
+ * it's destroyed, the whole coroutine is destroyed and the future returned by CoSpawn() reports a broken promise.
+ */
+namespace DcgmNs
+{
+template <class T>
+class CoTask;
+
+/**
+ * The one pending resumption of a suspended coroutine.
+ * Destroying it without calling Resume() destroys the coroutine that was spawned, together with the coroutines it's
+ * waiting for, so that a dropped resumption doesn't leak their frames.
+ */
+class CoResumption
+{
+public:
+    CoResumption(std::coroutine_handle<> handle, std::coroutine_handle<> root)
+        : m_handle(handle)
+        , m_root(root)
+    {}
+
+    CoResumption(CoResumption const &)            = delete;
+    CoResumption &operator=(CoResumption const &) = delete;
+
+    ~CoResumption()
+    {
+        if (m_handle)
+        {
+            m_root.destroy();
+        }
+    }
+
+    void Resume()
+    {
+        std::exchange(m_handle, nullptr).resume();
+    }
+
+private:
+    std::coroutine_handle<> m_handle; //!< The innermost suspended coroutine
+    std::coroutine_handle<> m_root;   //!< The coroutine that was given to CoSpawn()
+};
+
+/**
+ * Queue the resumption on \a runner.
+ * It's queued as a continuation because it belongs to work that was accepted already, so it's never rejected for the
+ * queue capacity.
+ */
+inline void CoPost(TaskRunner &runner, std::shared_ptr<CoResumption> resumption)
+{
+    [[maybe_unused]] auto _ = runner.Enqueue(
+        make_task("Coroutine resumption", [resumption = std::move(resumption)]() { resumption->Resume(); }), true);
+}
+
+/**
+ * State shared by the promises of all CoTask<T>
+ */
+class CoPromiseBase
+{
+public:
+    [[nodiscard]] TaskRunner *GetRunner() const
+    {
+        return m_runner;
+    }
+
+    [[nodiscard]] std::coroutine_handle<> GetRoot() const
+    {
+        return m_root;
+    }
+
+    void Bind(TaskRunner *runner, std::coroutine_handle<> root, std::coroutine_handle<> continuation)
+    {
+        m_runner       = runner;
+        m_root         = root;
+        m_continuation = continuation;
+    }
+
+    /**
+     * Make a resumption of the coroutine \a handle, which has to be suspended in a coroutine of this promise
+     */
+    [[nodiscard]] std::shared_ptr<CoResumption> MakeResumption(std::coroutine_handle<> handle) const
+    {
+        return std::make_shared<CoResumption>(handle, m_root);
+    }
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+protected:
+    TaskRunner *m_runner = nullptr;         //!< The home runner. The coroutine is always resumed on it
+    std::coroutine_handle<> m_root;         //!< The coroutine that was given to CoSpawn()
+    std::coroutine_handle<> m_continuation; //!< The coroutine awaiting this one. Empty for the spawned one
+    std::exception_ptr m_exception;         //!< What the coroutine threw
+};
+
+template <class T>
+class CoPromise : public CoPromiseBase
+{
+public:
+    template <class U>
+    void return_value(U &&value)
+    {
+        m_value.emplace(std::forward<U>(value));
+    }
+
+    T TakeResult()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+        return std::move(*m_value);
+    }
+
+    void SetDetachedResult(std::promise<T> &promise)
+    {
+        if (m_exception)
+        {
+            promise.set_exception(m_exception);
+            return;
+        }
+        promise.set_value(std::move(*m_value));
+    }
+
+private:
+    std::optional<T> m_value;
+};
+
+template <>
+class CoPromise<void> : public CoPromiseBase
+{
+public:
+    void return_void()
+    {}
+
+    void TakeResult()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+    void SetDetachedResult(std::promise<void> &promise)
+    {
+        if (m_exception)
+        {
+            promise.set_exception(m_exception);
+            return;
+        }
+        promise.set_value();
+    }
+};
+
+/**
+ * Return type of a coroutine that produces a T.
+ * The coroutine doesn't start until it's awaited by another CoTask or given to CoSpawn().
+ */
+template <class T = void>
+class [[nodiscard]] CoTask
+{
+public:
+    class promise_type : public CoPromise<T>
+    {
+    public:
+        CoTask get_return_object()
+        {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        auto final_suspend() noexcept
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    auto &promise = handle.promise();
+                    if (promise.m_continuation)
+                    {
+                        return promise.m_continuation;
+                    }
+
+                    /* Spawned. Nobody owns the frame, so it goes away with the result delivered */
+                    promise.SetDetachedResult(promise.m_detached);
+                    handle.destroy();
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept
+                {}
+            };
+            return FinalAwaiter {};
+        }
+
+        std::promise<T> m_detached; //!< Result of a spawned coroutine
+    };
+
+    CoTask(CoTask const &)            = delete;
+    CoTask &operator=(CoTask const &) = delete;
+
+    CoTask(CoTask &&other) noexcept
+        : m_handle(std::exchange(other.m_handle, nullptr))
+    {}
+
+    CoTask &operator=(CoTask &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~CoTask()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    /* Run this coroutine on the home runner of the awaiting one and resume that once it's done */
+    auto operator co_await() && noexcept
+    {
+        return Awaiter { m_handle };
+    }
+
+private:
+    template <class U>
+    friend auto CoSpawn(TaskRunner &runner, CoTask<U> task) -> std::optional<std::shared_future<U>>;
+
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> m_child;
+
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template <class P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> parent) noexcept
+        {
+            auto &parentPromise = parent.promise();
+            m_child.promise().Bind(parentPromise.GetRunner(), parentPromise.GetRoot(), parent);
+            return m_child;
+        }
+
+        T await_resume()
+        {
+            return m_child.promise().TakeResult();
+        }
+    };
+
+    explicit CoTask(std::coroutine_handle<promise_type> handle)
+        : m_handle(handle)
+    {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/**
+ * Start \a task on \a runner, its home runner.
+ *
+ * @return  A future of the coroutine result.
+ *          std::nullopt if the task could not be queued because the runner queue is full.
+ */
+template <class T>
+auto CoSpawn(TaskRunner &runner, CoTask<T> task) -> std::optional<std::shared_future<T>>
+{
+    auto handle = std::exchange(task.m_handle, nullptr);
+    handle.promise().Bind(&runner, handle, nullptr);
+    auto result = handle.promise().m_detached.get_future().share();
+
+    auto resumption = std::make_shared<CoResumption>(handle, handle);
+    if (!runner.Enqueue(make_task("Coroutine start", [resumption]() { resumption->Resume(); })).has_value())
+    {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+/**
+ * co_await CoRunOn(runner, func) runs func as a task on \a runner and resumes the awaiting coroutine on its home
+ * runner with the result. Exceptions thrown by func are rethrown in the coroutine.
+ */
+template <std::invocable Func>
+class [[nodiscard]] CoRunOn
+{
+public:
+    using ResultType = std::invoke_result_t<Func>;
+
+    CoRunOn(TaskRunner &runner, Func func)
+        : m_runner(runner)
+        , m_func(std::move(func))
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> handle)
+    {
+        TaskRunner *home = handle.promise().GetRunner();
+        auto resumption  = handle.promise().MakeResumption(handle);
+
+        auto task = make_task("Coroutine step", [this, home, resumption]() {
+            try
+            {
+                if constexpr (std::is_void_v<ResultType>)
+                {
+                    std::invoke(m_func);
+                }
+                else
+                {
+                    m_result.emplace(std::invoke(m_func));
+                }
+            }
+            catch (...)
+            {
+                m_exception = std::current_exception();
+            }
+            CoPost(*home, resumption);
+        });
+
+        if (!m_runner.Enqueue(std::move(task)).has_value())
+        {
+            /* Resume with an error rather than leaving the coroutine suspended forever */
+            m_exception = std::make_exception_ptr(std::runtime_error("The TaskRunner queue is full"));
+            CoPost(*home, resumption);
+        }
+    }
+
+    ResultType await_resume()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+        if constexpr (!std::is_void_v<ResultType>)
+        {
+            return std::move(*m_result);
+        }
+    }
+
+private:
+    using StoredType = std::conditional_t<std::is_void_v<ResultType>, int, ResultType>;
+
+    TaskRunner &m_runner;
+    Func m_func;
+    std::optional<StoredType> m_result;
+    std::exception_ptr m_exception;
+};
+
+/**
+ * Thread that queues the resumptions of sleeping coroutines once they are due
+ */
+class CoTimerQueue
+{
+public:
+    CoTimerQueue()
+        : m_thread([this] { Run(); })
+    {
+        pthread_setname_np(m_thread.native_handle(), "co_timer_queue");
+    }
+
+    CoTimerQueue(CoTimerQueue const &)            = delete;
+    CoTimerQueue &operator=(CoTimerQueue const &) = delete;
+
+    ~CoTimerQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeUp.notify_one();
+        m_thread.join();
+    }
+
+    /* The timer queue used by CoSleepFor() and CoSleepUntil() */
+    static CoTimerQueue &Instance()
+    {
+        static CoTimerQueue instance;
+        return instance;
+    }
+
+    /* Queue \a resumption on \a runner at \a when */
+    void Add(std::chrono::steady_clock::time_point when, TaskRunner &runner, std::shared_ptr<CoResumption> resumption)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_timers.emplace(when, Timer { &runner, std::move(resumption) });
+        }
+        m_wakeUp.notify_one();
+    }
+
+private:
+    struct Timer
+    {
+        TaskRunner *runner;
+        std::shared_ptr<CoResumption> resumption;
+    };
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop)
+        {
+            if (m_timers.empty())
+            {
+                m_wakeUp.wait(lock);
+                continue;
+            }
+
+            auto it = m_timers.begin();
+            if (it->first > std::chrono::steady_clock::now())
+            {
+                m_wakeUp.wait_until(lock, it->first);
+                continue;
+            }
+
+            Timer timer = std::move(it->second);
+            m_timers.erase(it);
+
+            lock.unlock();
+            CoPost(*timer.runner, std::move(timer.resumption));
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex; //!< Protects m_timers and m_stop
+    std::condition_variable m_wakeUp;
+    std::multimap<std::chrono::steady_clock::time_point, Timer> m_timers;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+/**
+ * co_await CoSleepUntil(when) resumes the awaiting coroutine on its home runner at \a when
+ */
+class [[nodiscard]] CoSleepUntil
+{
+public:
+    explicit CoSleepUntil(std::chrono::steady_clock::time_point when)
+        : m_when(when)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return m_when <= std::chrono::steady_clock::now();
+    }
+
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> handle)
+    {
+        CoTimerQueue::Instance().Add(m_when, *handle.promise().GetRunner(), handle.promise().MakeResumption(handle));
+    }
+
+    void await_resume() const noexcept
+    {}
+
+private:
+    std::chrono::steady_clock::time_point m_when;
+};
+
+/**
+ * co_await CoSleepFor(duration) resumes the awaiting coroutine on its home runner after \a duration
+ */
+template <class Rep, class Period>
+CoSleepUntil CoSleepFor(std::chrono::duration<Rep, Period> duration)
+{
+    return CoSleepUntil(std::chrono::steady_clock::now()
+                        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+}
+
+/**
+ * co_await CoCallback<T>(start) calls start with a completion function and resumes the awaiting coroutine on its
+ * home runner with the T the completion is called with.
+ *
+ * The completion may be called from any thread, even before start returns, and has to be called exactly once.
+ * If it's destroyed without being called, the coroutine is destroyed.
+ */
+template <class T>
+class [[nodiscard]] CoCallback
+{
+public:
+    using Complete_f = std::function<void(T)>;
+    using Start_f    = std::function<void(Complete_f)>;
+
+    explicit CoCallback(Start_f start)
+        : m_start(std::move(start))
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <class P>
+    void await_suspend(std::coroutine_handle<P> handle)
+    {
+        TaskRunner *home = handle.promise().GetRunner();
+        auto resumption  = handle.promise().MakeResumption(handle);
+
+        /* The coroutine may be resumed on another thread before m_start returns, so nothing touches this after it */
+        auto start = std::move(m_start);
+        start([this, home, resumption](T value) {
+            m_result.emplace(std::move(value));
+            CoPost(*home, resumption);
+        });
+    }
+
+    T await_resume()
+    {
+        return std::move(*m_result);
+    }
+
+private:
+    Start_f m_start;
+    std::optional<T> m_result;
+};
+
+} // namespace DcgmNs
@@ -17,13 +17,14 @@
 #include "CpuHelpers.h"
 #include "DcgmLogging.h"
 #include "DcgmStringHelpers.h"
+#include "HwInventory.h"
 
 #include <memory>
 #include <regex>
 #include <unordered_set>
 
 CpuHelpers::CpuHelpers()
-    : CpuHelpers(std::make_unique<FileSystemOperator>(), std::make_unique<LsHw>())
+    : CpuHelpers(std::make_unique<FileSystemOperator>(), nullptr)
 {}
 
 CpuHelpers::CpuHelpers(std::unique_ptr<FileSystemOperator> fileSystemOp, std::unique_ptr<LsHw> lshw)
@@ -154,7 +155,7 @@ std::string const &CpuHelpers::GetModel() const
 
 std::optional<std::vector<std::string>> CpuHelpers::GetCpuSerials() const
 {
-    auto const cpuSerials = m_lshw->GetCpuSerials();
+    auto const cpuSerials = m_lshw != nullptr ? m_lshw->GetCpuSerials() : HwInventory::Instance().Get()->cpuSerials;
     if (!cpuSerials)
     {
         log_debug("failed to get serials from lshw.");
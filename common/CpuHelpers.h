@@ -33,6 +33,7 @@ class CpuHelpers
 {
 public:
     CpuHelpers();
+    /* A null lshw takes the CPU serials from HwInventory::Instance(), which runs lshw once */
     explicit CpuHelpers(std::unique_ptr<FileSystemOperator> fileSystemOp, std::unique_ptr<LsHw> lshw);
 
     void Init();
@@ -216,6 +216,15 @@ dcgmReturn_t CudaWorkerThread::LoadModule(void)
         return DCGM_ST_GENERIC_ERROR;
     }
 
+    /* Optional. Workers fall back to launching a kernel per duty cycle without it */
+    cuSt = cuModuleGetFunction(&m_cudaDevice.m_cuFuncWaitForStop, m_cudaDevice.m_module, "waitForStop");
+    if (cuSt)
+    {
+        DCGM_LOG_WARNING << "Unable to load cuda function waitForStop. Persistent kernels are disabled. cuSt: "
+                         << cuSt;
+        m_cudaDevice.m_cuFuncWaitForStop = nullptr;
+    }
+
     return DCGM_ST_OK;
 }
 
@@ -503,6 +512,10 @@ void CudaWorkerThread::SetWorkloadAndTargetFromTaskThread(unsigned int fieldId,
     {
         /* We changed active field IDs. Allocate our object */
         m_fieldWorker = AllocateFieldWorker(fieldId, preferCublas);
+        if (m_fieldWorker != nullptr)
+        {
+            m_fieldWorker->SetPersistentKernels(m_persistentKernels);
+        }
     }
 
     m_activeFieldId = fieldId;
@@ -515,6 +528,18 @@ void CudaWorkerThread::SetPeerByBusIdFromTaskThread(std::string peerBusId)
     m_cudaPeerBusId = peerBusId;
 }
 
+/*****************************************************************************/
+void CudaWorkerThread::SetPersistentKernelsFromTaskThread(bool persistentKernels)
+{
+    DCGM_LOG_DEBUG << "Set m_persistentKernels to " << persistentKernels;
+    m_persistentKernels = persistentKernels;
+
+    if (m_fieldWorker != nullptr)
+    {
+        m_fieldWorker->SetPersistentKernels(persistentKernels);
+    }
+}
+
 /*****************************************************************************/
 void CudaWorkerThread::SetWorkerToIdle(void)
 {
@@ -556,6 +581,15 @@ void CudaWorkerThread::SetPeerByBusId(std::string peerBusId)
         make_task("SetPeerByBusId in TaskRunner", [this, peerBusId] { SetPeerByBusIdFromTaskThread(peerBusId); }));
 }
 
+/*****************************************************************************/
+void CudaWorkerThread::SetPersistentKernels(bool persistentKernels)
+{
+    using namespace DcgmNs;
+    auto const task = Enqueue(make_task("SetPersistentKernels in TaskRunner", [this, persistentKernels] {
+        SetPersistentKernelsFromTaskThread(persistentKernels);
+    }));
+}
+
 /*****************************************************************************/
 double CudaWorkerThread::GetCurrentAchievedLoad(void)
 {
@@ -103,6 +103,16 @@ public:
      */
     void SetPeerByBusId(std::string peerBusId);
 
+    /*************************************************************************/
+    /**
+     * Set whether workloads that support it keep one kernel resident on the
+     * GPU across duty cycles rather than launching one per duty cycle. This
+     * avoids the gaps between kernels that host scheduling jitter causes.
+     *
+     * The actual work is done from the task thread as to be thread safe.
+     */
+    void SetPersistentKernels(bool persistentKernels);
+
     /*************************************************************************/
 private:
     void run() override;
@@ -146,6 +156,12 @@ private:
      */
     void SetPeerByBusIdFromTaskThread(std::string peerBusId);
 
+    /*************************************************************************/
+    /**
+     * Helper for SetPersistentKernels() to be called from the task thread
+     */
+    void SetPersistentKernelsFromTaskThread(bool persistentKernels);
+
     /*************************************************************************/
     /**
      * Helper to allocate a FieldWorkerBase instance based on fieldId
@@ -184,4 +200,6 @@ private:
         = 0.0; /* Currently achieved workload snapshotted from m_fieldWorker->GetAchievedLoad() */
 
     std::string m_cudaPeerBusId; /* PCI bus ID of our peer GPU */
+
+    bool m_persistentKernels = false; /* Passed to each m_fieldWorker we allocate */
 };
@@ -41,6 +41,7 @@ typedef struct
     CUfunction m_cuFuncDoWorkFP64 {};     //!< Pointer to doWorkloadFP64() cuda kernel
     CUfunction m_cuFuncDoWorkFP32 {};     //!< Pointer to doWorkloadFP32() cuda kernel
     CUfunction m_cuFuncDoWorkFP16 {};     //!< Pointer to doWorkloadFP16() cuda kernel
+    CUfunction m_cuFuncWaitForStop {};    //!< Pointer to waitForStop() cuda kernel. Null if the module lacks it
     CUmodule m_module { nullptr };        //!< .PTX file that belongs to m_context
     int m_maxThreadsPerMultiProcessor {}; //!< threads per multiprocessor
     int m_multiProcessorCount {};         //!< multiprocessors
@@ -65,6 +66,21 @@ protected:
     static const unsigned int s_gcdThreadsPerSmLimit     = 128;
     static const unsigned int s_cudaThreadsPerBlockLimit = 1024; // CUDA limitation
 
+    /* How often the persistent kernel checks its control words, and how many duty cycles without a
+       heartbeat it waits before giving up on the host */
+    static const unsigned int s_persistentPollNs            = 100000;
+    static const unsigned int s_persistentHeartbeatTimeouts = 4;
+
+    bool m_persistentKernels = false; /* Keep the sleep kernel resident across duty cycles? */
+
+    /* Persistent kernel state. m_persistentControl is host memory mapped into the device:
+       [0] is nonzero to stop the kernel, [1] is the heartbeat */
+    volatile uint32_t *m_persistentControl = nullptr;
+    CUdeviceptr m_persistentControlDevice   = 0;
+    bool m_persistentRunning                = false;
+    unsigned int m_persistentNumSms         = 0;
+    unsigned int m_persistentThreadsPerSm   = 0;
+
 public:
     /* Attributes for the device we're running our workload on */
     CudaWorkerDevice_t m_cudaDevice;
@@ -81,7 +97,35 @@ public:
 
     /*************************************************************************/
     /* Destructor */
-    virtual ~FieldWorkerBase() = default;
+    virtual ~FieldWorkerBase()
+    {
+        StopPersistentKernel();
+
+        if (m_persistentControl != nullptr)
+        {
+            cuMemFreeHost((void *)m_persistentControl);
+            m_persistentControl = nullptr;
+        }
+    }
+
+    /*************************************************************************/
+    /* Set whether workers that support it keep their kernel resident across duty cycles
+       instead of launching and synchronizing one per duty cycle */
+    void SetPersistentKernels(bool persistentKernels)
+    {
+        if (!persistentKernels)
+        {
+            StopPersistentKernel();
+        }
+        m_persistentKernels = persistentKernels;
+    }
+
+    /*************************************************************************/
+    /* Should this duty cycle use RunPersistentSleepKernel()? */
+    bool UsePersistentKernel() const
+    {
+        return m_persistentKernels && m_cudaDevice.m_cuFuncWaitForStop != nullptr;
+    }
 
     /*************************************************************************/
     unsigned int GetFieldId()
@@ -252,6 +296,117 @@ public:
         return DCGM_ST_OK;
     }
 
+    /*************************************************************************/
+    /*
+     * Do one duty cycle of sleep kernel work with a kernel that stays resident on the GPU.
+     *
+     * The kernel is only (re)launched when it isn't running or its dimensions change. Otherwise this
+     * just bumps its heartbeat and sleeps for the duty cycle, so there are no gaps between kernels
+     * from launching and synchronizing every duty cycle. The kernel stops itself if the heartbeat
+     * stops for several duty cycles.
+     */
+    dcgmReturn_t RunPersistentSleepKernel(unsigned int numSms,
+                                          unsigned int threadsPerSm,
+                                          std::chrono::milliseconds dutyCycleLengthMs)
+    {
+        CUresult cuSt;
+
+        if (numSms == 0)
+        {
+            DCGM_LOG_ERROR << "numSms " << numSms << " must be >= 1";
+            return DCGM_ST_BADPARAM;
+        }
+
+        if (m_persistentRunning && (numSms != m_persistentNumSms || threadsPerSm != m_persistentThreadsPerSm))
+        {
+            StopPersistentKernel();
+        }
+
+        if (!m_persistentRunning)
+        {
+            if (m_persistentControl == nullptr)
+            {
+                void *hostMem = nullptr;
+                cuSt          = cuMemHostAlloc(&hostMem, 2 * sizeof(uint32_t), CU_MEMHOSTALLOC_DEVICEMAP);
+                if (cuSt)
+                {
+                    DCGM_LOG_ERROR << "cuMemHostAlloc returned " << cuSt;
+                    return DCGM_ST_GENERIC_ERROR;
+                }
+
+                cuSt = cuMemHostGetDevicePointer(&m_persistentControlDevice, hostMem, 0);
+                if (cuSt)
+                {
+                    DCGM_LOG_ERROR << "cuMemHostGetDevicePointer returned " << cuSt;
+                    cuMemFreeHost(hostMem);
+                    return DCGM_ST_GENERIC_ERROR;
+                }
+                m_persistentControl = (volatile uint32_t *)hostMem;
+            }
+
+            m_persistentControl[0] = 0;
+            m_persistentControl[1] = 0;
+
+            auto const [blockDim, gridDim] = ComputeProperCudaDimensions(numSms, threadsPerSm);
+
+            uint32_t pollNs    = s_persistentPollNs;
+            uint64_t timeoutNs = static_cast<uint64_t>(s_persistentHeartbeatTimeouts)
+                                 * std::chrono::duration_cast<std::chrono::nanoseconds>(dutyCycleLengthMs).count();
+            void *kernelParams[3] = { &m_persistentControlDevice, &pollNs, &timeoutNs };
+
+            log_debug("Running persistent sleep kernel with gridDim({},{},{}), blockDim({},{},{}), timeoutNs={}",
+                      gridDim.x,
+                      gridDim.y,
+                      gridDim.z,
+                      blockDim.x,
+                      blockDim.y,
+                      blockDim.z,
+                      timeoutNs);
+            cuSt = cuLaunchKernel(m_cudaDevice.m_cuFuncWaitForStop,
+                                  gridDim.x,
+                                  gridDim.y,
+                                  gridDim.z,
+                                  blockDim.x,
+                                  blockDim.y,
+                                  blockDim.z,
+                                  0,
+                                  NULL,
+                                  kernelParams,
+                                  NULL);
+            if (cuSt)
+            {
+                DCGM_LOG_ERROR << "cuLaunchKernel returned " << cuSt;
+                return DCGM_ST_GENERIC_ERROR;
+            }
+
+            m_persistentRunning      = true;
+            m_persistentNumSms       = numSms;
+            m_persistentThreadsPerSm = threadsPerSm;
+        }
+        else
+        {
+            m_persistentControl[1] = m_persistentControl[1] + 1;
+        }
+
+        usleep(1000 * dutyCycleLengthMs.count());
+        return DCGM_ST_OK;
+    }
+
+    /*************************************************************************/
+    /* Tell the persistent kernel to exit and wait for it. No-op if it isn't running */
+    void StopPersistentKernel()
+    {
+        if (!m_persistentRunning)
+        {
+            return;
+        }
+
+        m_persistentControl[0] = 1;
+        cuCtxSynchronize();
+        m_persistentRunning = false;
+    }
+
+    /*************************************************************************/
     dcgmReturn_t RunDoWorkKernel(unsigned int numSms, unsigned int threadsPerSm, unsigned int runForUsec)
     {
         CUresult cuSt;
@@ -374,12 +529,21 @@ public:
         unsigned int numSms = (unsigned int)(loadTarget * m_cudaDevice.m_multiProcessorCount);
         if (numSms < 1)
         {
+            StopPersistentKernel();
             usleep(1000 * dutyCycleLengthMs.count());
             return;
         }
 
         if ((int)numSms > m_cudaDevice.m_multiProcessorCount)
             numSms = m_cudaDevice.m_multiProcessorCount;
+
+        if (UsePersistentKernel())
+        {
+            RunPersistentSleepKernel(numSms, 1, dutyCycleLengthMs);
+            m_achievedLoad = loadTarget;
+            return;
+        }
+
         RunSleepKernel(numSms, 1, dutyCycleLengthMs.count() * 1000);
 
         /* Wait for this kernel to finish. This will block for dutyCycleLengthMs until the kernel finishes */
@@ -408,6 +572,7 @@ public:
 
         if (threadsPerSm < 1)
         {
+            StopPersistentKernel();
             usleep(1000 * dutyCycleLengthMs.count());
             return;
         }
@@ -443,6 +608,13 @@ public:
          *s_cudaThreadsPerBlockLimit.
          */
 
+        if (UsePersistentKernel())
+        {
+            RunPersistentSleepKernel(numSms, threadsPerSm, dutyCycleLengthMs);
+            m_achievedLoad = loadTarget;
+            return;
+        }
+
         RunSleepKernel(numSms, threadsPerSm, dutyCycleLengthMs.count() * 1000);
 
         /**
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmArrowWriter.h"
+#include "DcgmLogging.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+
+/* Arrow IPC and its FlatBuffers metadata are little-endian. Values are written as they are in memory */
+static_assert(std::endian::native == std::endian::little, "DcgmArrowWriter needs a little-endian host");
+
+namespace
+{
+/* "ARROW1" and the padding to 8 bytes that follows it at the start of the file */
+constexpr char ARROW_MAGIC[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+
+/* Values of the Arrow format that are written. See Schema.fbs and Message.fbs of the Arrow format */
+constexpr std::int16_t ARROW_METADATA_V5      = 4;
+constexpr std::uint8_t ARROW_TYPE_INT         = 2;
+constexpr std::uint8_t ARROW_TYPE_FLOAT       = 3;
+constexpr std::uint8_t ARROW_TYPE_TIMESTAMP   = 10;
+constexpr std::int16_t ARROW_PRECISION_DOUBLE = 2;
+constexpr std::int16_t ARROW_UNIT_MICROSECOND = 2;
+constexpr std::uint8_t ARROW_HEADER_SCHEMA    = 1;
+constexpr std::uint8_t ARROW_HEADER_BATCH     = 3;
+
+/* Marker before the length of each message */
+constexpr std::uint32_t ARROW_CONTINUATION = 0xFFFFFFFF;
+
+/*****************************************************************************/
+size_t PadTo8(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+/*****************************************************************************/
+/*
+ * Minimal FlatBuffers builder for the Arrow metadata. Like the FlatBuffers
+ * library, it builds the buffer from its end, so that every object is written
+ * before the objects that refer to it. Objects are identified by their
+ * distance from the end of the buffer until Finish()
+ */
+class FlatBuilder
+{
+public:
+    using Ref = std::uint32_t;
+
+    /* Pad so that size() is a multiple of align once additional bytes are written */
+    void Prep(size_t align, size_t additional)
+    {
+        m_minAlign = std::max(m_minAlign, align);
+        size_t pad = (~(m_buf.size() + additional) + 1) & (align - 1);
+        m_buf.insert(m_buf.begin(), pad, 0);
+    }
+
+    Ref CreateString(std::string_view str)
+    {
+        Prep(sizeof(std::uint32_t), str.size() + 1);
+        m_buf.insert(m_buf.begin(), 1, 0);
+        m_buf.insert(m_buf.begin(), str.begin(), str.end());
+        Push<std::uint32_t>((std::uint32_t)str.size());
+        return size();
+    }
+
+    Ref CreateOffsetVector(std::vector<Ref> const &refs)
+    {
+        Prep(sizeof(std::uint32_t), refs.size() * sizeof(std::uint32_t));
+        for (auto ref = refs.rbegin(); ref != refs.rend(); ++ref)
+        {
+            PushOffset(*ref);
+        }
+        Push<std::uint32_t>((std::uint32_t)refs.size());
+        return size();
+    }
+
+    /* Vector of count structs of 8-byte aligned fields */
+    Ref CreateStructVector(void const *structs, size_t structSize, size_t count)
+    {
+        size_t const bytes = structSize * count;
+        Prep(sizeof(std::uint32_t), bytes);
+        Prep(sizeof(std::int64_t), bytes);
+        m_buf.insert(m_buf.begin(), (std::uint8_t const *)structs, (std::uint8_t const *)structs + bytes);
+        Push<std::uint32_t>((std::uint32_t)count);
+        return size();
+    }
+
+    void StartTable()
+    {
+        m_fieldRefs.clear();
+        m_tableStart = size();
+    }
+
+    template <typename T>
+    void AddScalar(unsigned int id, T value)
+    {
+        Prep(sizeof(T), 0);
+        Push<T>(value);
+        Track(id);
+    }
+
+    void AddOffset(unsigned int id, Ref ref)
+    {
+        PushOffset(ref);
+        Track(id);
+    }
+
+    Ref EndTable()
+    {
+        /* The table starts with the offset to its vtable, which is written right before it */
+        Prep(sizeof(std::int32_t), 0);
+        Push<std::int32_t>(0);
+        Ref const table = size();
+
+        for (auto fieldRef = m_fieldRefs.rbegin(); fieldRef != m_fieldRefs.rend(); ++fieldRef)
+        {
+            Push<std::uint16_t>(*fieldRef ? (std::uint16_t)(table - *fieldRef) : 0);
+        }
+        Push<std::uint16_t>((std::uint16_t)(table - m_tableStart));
+        Push<std::uint16_t>((std::uint16_t)((m_fieldRefs.size() + 2) * sizeof(std::uint16_t)));
+
+        std::int32_t const vtableOffset = (std::int32_t)size() - (std::int32_t)table;
+        std::memcpy(&m_buf[m_buf.size() - table], &vtableOffset, sizeof(vtableOffset));
+        return table;
+    }
+
+    std::vector<std::uint8_t> Finish(Ref root)
+    {
+        Prep(m_minAlign, sizeof(std::uint32_t));
+        PushOffset(root);
+        return std::move(m_buf);
+    }
+
+private:
+    Ref size() const
+    {
+        return (Ref)m_buf.size();
+    }
+
+    template <typename T>
+    void Push(T value)
+    {
+        std::uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        m_buf.insert(m_buf.begin(), bytes, bytes + sizeof(T));
+    }
+
+    /* Offsets are relative to where they are stored and point forward */
+    void PushOffset(Ref ref)
+    {
+        Prep(sizeof(std::uint32_t), 0);
+        Push<std::uint32_t>(size() + sizeof(std::uint32_t) - ref);
+    }
+
+    void Track(unsigned int id)
+    {
+        if (m_fieldRefs.size() <= id)
+        {
+            m_fieldRefs.resize(id + 1, 0);
+        }
+        m_fieldRefs[id] = size();
+    }
+
+    std::vector<std::uint8_t> m_buf;
+    size_t m_minAlign = 1;
+    std::vector<Ref> m_fieldRefs; /* Where each field of the current table is. 0 if absent */
+    Ref m_tableStart = 0;
+};
+
+/*****************************************************************************/
+struct ColumnDesc
+{
+    char const *name;
+    std::uint8_t typeType;
+    int bitWidth; /* For ARROW_TYPE_INT */
+    bool isSigned;
+    bool nullable;
+};
+
+constexpr ColumnDesc c_columns[] = {
+    { "timestamp", ARROW_TYPE_TIMESTAMP, 0, false, false },
+    { "entity_group_id", ARROW_TYPE_INT, 8, false, false },
+    { "entity_id", ARROW_TYPE_INT, 32, false, false },
+    { "field_id", ARROW_TYPE_INT, 16, false, false },
+    { "value_int64", ARROW_TYPE_INT, 64, true, true },
+    { "value_double", ARROW_TYPE_FLOAT, 0, false, true },
+};
+
+constexpr size_t c_numColumns = sizeof(c_columns) / sizeof(c_columns[0]);
+
+/*****************************************************************************/
+FlatBuilder::Ref BuildSchema(FlatBuilder &fb)
+{
+    std::vector<FlatBuilder::Ref> fields;
+
+    for (ColumnDesc const &column : c_columns)
+    {
+        FlatBuilder::Ref const name = fb.CreateString(column.name);
+
+        FlatBuilder::Ref type;
+        if (column.typeType == ARROW_TYPE_TIMESTAMP)
+        {
+            FlatBuilder::Ref const timezone = fb.CreateString("UTC");
+            fb.StartTable();
+            fb.AddScalar<std::int16_t>(0, ARROW_UNIT_MICROSECOND);
+            fb.AddOffset(1, timezone);
+            type = fb.EndTable();
+        }
+        else if (column.typeType == ARROW_TYPE_FLOAT)
+        {
+            fb.StartTable();
+            fb.AddScalar<std::int16_t>(0, ARROW_PRECISION_DOUBLE);
+            type = fb.EndTable();
+        }
+        else
+        {
+            fb.StartTable();
+            fb.AddScalar<std::int32_t>(0, column.bitWidth);
+            fb.AddScalar<std::uint8_t>(1, column.isSigned ? 1 : 0);
+            type = fb.EndTable();
+        }
+
+        /* Readers expect the children of every field, even of the ones that can't have any */
+        FlatBuilder::Ref const children = fb.CreateOffsetVector({});
+
+        fb.StartTable();
+        fb.AddOffset(0, name);
+        fb.AddScalar<std::uint8_t>(1, column.nullable ? 1 : 0);
+        fb.AddScalar<std::uint8_t>(2, column.typeType);
+        fb.AddOffset(3, type);
+        fb.AddOffset(5, children);
+        fields.push_back(fb.EndTable());
+    }
+
+    FlatBuilder::Ref const fieldsVector = fb.CreateOffsetVector(fields);
+
+    fb.StartTable();
+    fb.AddOffset(1, fieldsVector);
+    return fb.EndTable();
+}
+
+/*****************************************************************************/
+std::vector<std::uint8_t> BuildMessage(FlatBuilder &fb,
+                                       std::uint8_t headerType,
+                                       FlatBuilder::Ref header,
+                                       std::int64_t bodyLength)
+{
+    fb.StartTable();
+    fb.AddScalar<std::int16_t>(0, ARROW_METADATA_V5);
+    fb.AddScalar<std::uint8_t>(1, headerType);
+    fb.AddOffset(2, header);
+    fb.AddScalar<std::int64_t>(3, bodyLength);
+    return fb.Finish(fb.EndTable());
+}
+
+/*****************************************************************************/
+void SetBit(std::vector<std::uint8_t> &bitmap, size_t index, bool value)
+{
+    if (index / 8 >= bitmap.size())
+    {
+        bitmap.push_back(0);
+    }
+    if (value)
+    {
+        bitmap[index / 8] |= (std::uint8_t)(1 << (index % 8));
+    }
+}
+} // namespace
+
+/*****************************************************************************/
+DcgmArrowWriter::DcgmArrowWriter(FILE *out, unsigned int rowsPerBatch)
+    : m_out(out)
+    , m_rowsPerBatch(std::max(rowsPerBatch, 1u))
+{}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::IsNumeric(unsigned short fieldType)
+{
+    return fieldType == DCGM_FT_INT64 || fieldType == DCGM_FT_TIMESTAMP || fieldType == DCGM_FT_DOUBLE;
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::WriteBytes(void const *data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, m_out) != size)
+    {
+        log_error("Writing {} bytes of the Arrow file failed with errno {}", size, errno);
+        return false;
+    }
+    m_offset += size;
+    return true;
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::WritePadded(void const *data, size_t size)
+{
+    static char const zeros[8] = {};
+    return WriteBytes(data, size) && WriteBytes(zeros, PadTo8(size) - size);
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::WriteMessage(std::vector<std::uint8_t> const &metadata, Block *block)
+{
+    /* The message is followed by its body, which starts on an 8-byte boundary */
+    std::uint32_t const metadataLength = PadTo8(metadata.size());
+
+    if (block != nullptr)
+    {
+        block->offset         = m_offset;
+        block->metaDataLength = sizeof(ARROW_CONTINUATION) + sizeof(metadataLength) + metadataLength;
+        block->padding        = 0;
+    }
+
+    return WriteBytes(&ARROW_CONTINUATION, sizeof(ARROW_CONTINUATION))
+           && WriteBytes(&metadataLength, sizeof(metadataLength)) && WritePadded(metadata.data(), metadata.size());
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::Begin()
+{
+    FlatBuilder fb;
+    FlatBuilder::Ref const schema = BuildSchema(fb);
+
+    return WriteBytes(ARROW_MAGIC, sizeof(ARROW_MAGIC))
+           && WriteMessage(BuildMessage(fb, ARROW_HEADER_SCHEMA, schema, 0), nullptr);
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::Add(dcgm_field_entity_group_t entityGroupId,
+                          dcgm_field_eid_t entityId,
+                          dcgmFieldValue_v1 const &value)
+{
+    if (!IsNumeric(value.fieldType))
+    {
+        return true;
+    }
+
+    size_t const row = m_timestamps.size();
+
+    m_timestamps.push_back(value.ts);
+    m_entityGroupIds.push_back((std::uint8_t)entityGroupId);
+    m_entityIds.push_back(entityId);
+    m_fieldIds.push_back(value.fieldId);
+
+    bool const isDouble  = value.fieldType == DCGM_FT_DOUBLE;
+    bool const hasInt64  = !isDouble && !DCGM_INT64_IS_BLANK(value.value.i64);
+    bool const hasDouble = isDouble && !DCGM_FP64_IS_BLANK(value.value.dbl);
+
+    m_int64Values.push_back(hasInt64 ? value.value.i64 : 0);
+    m_doubleValues.push_back(hasDouble ? value.value.dbl : 0.0);
+    SetBit(m_int64Validity, row, hasInt64);
+    SetBit(m_doubleValidity, row, hasDouble);
+    m_int64NullCount += hasInt64 ? 0 : 1;
+    m_doubleNullCount += hasDouble ? 0 : 1;
+
+    m_numRows++;
+
+    if (m_timestamps.size() >= m_rowsPerBatch)
+    {
+        return WriteBatch();
+    }
+    return true;
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::WriteBatch()
+{
+    size_t const numRows = m_timestamps.size();
+    if (numRows == 0)
+    {
+        return true;
+    }
+
+    struct FieldNode
+    {
+        std::int64_t length;
+        std::int64_t nullCount;
+    };
+
+    struct Buffer
+    {
+        std::int64_t offset;
+        std::int64_t length;
+    };
+
+    /* Each column has a validity bitmap and a data buffer. The bitmap is left out of columns without nulls */
+    struct ColumnData
+    {
+        void const *validity;
+        size_t validityBytes;
+        void const *data;
+        size_t dataBytes;
+        size_t nullCount;
+    };
+
+    ColumnData const columnData[c_numColumns] = {
+        { nullptr, 0, m_timestamps.data(), numRows * sizeof(std::int64_t), 0 },
+        { nullptr, 0, m_entityGroupIds.data(), numRows * sizeof(std::uint8_t), 0 },
+        { nullptr, 0, m_entityIds.data(), numRows * sizeof(std::uint32_t), 0 },
+        { nullptr, 0, m_fieldIds.data(), numRows * sizeof(std::uint16_t), 0 },
+        { m_int64Validity.data(),
+          m_int64NullCount ? m_int64Validity.size() : 0,
+          m_int64Values.data(),
+          numRows * sizeof(std::int64_t),
+          m_int64NullCount },
+        { m_doubleValidity.data(),
+          m_doubleNullCount ? m_doubleValidity.size() : 0,
+          m_doubleValues.data(),
+          numRows * sizeof(double),
+          m_doubleNullCount },
+    };
+
+    std::vector<FieldNode> nodes;
+    std::vector<Buffer> buffers;
+    std::int64_t bodyLength = 0;
+    for (ColumnData const &column : columnData)
+    {
+        nodes.push_back({ (std::int64_t)numRows, (std::int64_t)column.nullCount });
+        buffers.push_back({ bodyLength, (std::int64_t)column.validityBytes });
+        bodyLength += PadTo8(column.validityBytes);
+        buffers.push_back({ bodyLength, (std::int64_t)column.dataBytes });
+        bodyLength += PadTo8(column.dataBytes);
+    }
+
+    FlatBuilder fb;
+    FlatBuilder::Ref const nodesVector   = fb.CreateStructVector(nodes.data(), sizeof(FieldNode), nodes.size());
+    FlatBuilder::Ref const buffersVector = fb.CreateStructVector(buffers.data(), sizeof(Buffer), buffers.size());
+    fb.StartTable();
+    fb.AddScalar<std::int64_t>(0, numRows);
+    fb.AddOffset(1, nodesVector);
+    fb.AddOffset(2, buffersVector);
+    FlatBuilder::Ref const recordBatch = fb.EndTable();
+
+    Block block;
+    if (!WriteMessage(BuildMessage(fb, ARROW_HEADER_BATCH, recordBatch, bodyLength), &block))
+    {
+        return false;
+    }
+
+    for (ColumnData const &column : columnData)
+    {
+        if (!WritePadded(column.validity, column.validityBytes) || !WritePadded(column.data, column.dataBytes))
+        {
+            return false;
+        }
+    }
+
+    block.bodyLength = bodyLength;
+    m_batches.push_back(block);
+
+    m_timestamps.clear();
+    m_entityGroupIds.clear();
+    m_entityIds.clear();
+    m_fieldIds.clear();
+    m_int64Values.clear();
+    m_doubleValues.clear();
+    m_int64Validity.clear();
+    m_doubleValidity.clear();
+    m_int64NullCount  = 0;
+    m_doubleNullCount = 0;
+    return true;
+}
+
+/*****************************************************************************/
+bool DcgmArrowWriter::Finish()
+{
+    if (!WriteBatch())
+    {
+        return false;
+    }
+
+    /* End of the stream of messages */
+    std::uint32_t const endOfStream[2] = { ARROW_CONTINUATION, 0 };
+    if (!WriteBytes(endOfStream, sizeof(endOfStream)))
+    {
+        return false;
+    }
+
+    FlatBuilder fb;
+    FlatBuilder::Ref const schema        = BuildSchema(fb);
+    FlatBuilder::Ref const dictionaries  = fb.CreateStructVector(nullptr, sizeof(Block), 0);
+    FlatBuilder::Ref const recordBatches = fb.CreateStructVector(m_batches.data(), sizeof(Block), m_batches.size());
+    fb.StartTable();
+    fb.AddScalar<std::int16_t>(0, ARROW_METADATA_V5);
+    fb.AddOffset(1, schema);
+    fb.AddOffset(2, dictionaries);
+    fb.AddOffset(3, recordBatches);
+    std::vector<std::uint8_t> const footer = fb.Finish(fb.EndTable());
+
+    std::int32_t const footerLength = footer.size();
+    if (!WriteBytes(footer.data(), footer.size()) || !WriteBytes(&footerLength, sizeof(footerLength))
+        || !WriteBytes(ARROW_MAGIC, 6))
+    {
+        return false;
+    }
+
+    if (fflush(m_out) != 0)
+    {
+        log_error("Flushing the Arrow file failed with errno {}", errno);
+        return false;
+    }
+    return true;
+}
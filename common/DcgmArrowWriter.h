@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_fields.h"
+#include "dcgm_structs.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * DcgmArrowWriter writes field values to an Arrow IPC file (Feather V2), which
+ * pyarrow, pandas and polars load directly and can convert to Parquet. The
+ * file has a row per value and these columns:
+ *
+ *   timestamp        timestamp[us, tz=UTC]
+ *   entity_group_id  uint8. dcgm_field_entity_group_t
+ *   entity_id        uint32. dcgm_field_eid_t
+ *   field_id         uint16. DCGM_FI_?
+ *   value_int64      int64. Null unless the field is DCGM_FT_INT64 or DCGM_FT_TIMESTAMP and the value isn't blank
+ *   value_double     double. Null unless the field is DCGM_FT_DOUBLE and the value isn't blank
+ *
+ * Only numeric values are written. Rows are buffered and written as a record
+ * batch every rowsPerBatch rows, so memory stays bounded however many values
+ * are written.
+ *
+ * This class is not thread safe.
+ */
+class DcgmArrowWriter
+{
+public:
+    /*************************************************************************/
+    /*
+     * out           IN: Stream to write the file to. Not closed by the writer
+     * rowsPerBatch  IN: Rows of each record batch
+     */
+    explicit DcgmArrowWriter(FILE *out, unsigned int rowsPerBatch = 65536);
+
+    DcgmArrowWriter(DcgmArrowWriter const &)            = delete;
+    DcgmArrowWriter &operator=(DcgmArrowWriter const &) = delete;
+
+    /*************************************************************************/
+    /*
+     * Write the start of the file and the schema. Call once before Add()
+     *
+     * Returns false if writing to the stream failed
+     */
+    bool Begin();
+
+    /*************************************************************************/
+    /*
+     * Add a value of an entity. Values of DCGM_FT_STRING and DCGM_FT_BINARY
+     * fields are ignored. Check IsNumeric() to count them
+     *
+     * Returns false if writing a full record batch to the stream failed
+     */
+    bool Add(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId, dcgmFieldValue_v1 const &value);
+
+    /*************************************************************************/
+    /*
+     * Write the rows that are still buffered and the end of the file. The
+     * file is only readable once this returns true
+     *
+     * Returns false if writing to the stream failed
+     */
+    bool Finish();
+
+    /*************************************************************************/
+    /* Returns whether Add() writes values of fields of fieldType */
+    static bool IsNumeric(unsigned short fieldType);
+
+    /*************************************************************************/
+    /* Number of rows added so far */
+    unsigned long long GetNumRows() const
+    {
+        return m_numRows;
+    }
+
+private:
+    /* File location of a record batch, as listed in the footer */
+    struct Block
+    {
+        std::int64_t offset;
+        std::int32_t metaDataLength;
+        std::int32_t padding;
+        std::int64_t bodyLength;
+    };
+
+    bool WriteBatch();
+    bool WriteMessage(std::vector<std::uint8_t> const &metadata, Block *block);
+    bool WriteBytes(void const *data, size_t size);
+    bool WritePadded(void const *data, size_t size);
+
+    FILE *m_out;
+    unsigned int m_rowsPerBatch;
+    std::int64_t m_offset        = 0; /* Bytes written to m_out so far */
+    unsigned long long m_numRows = 0;
+    std::vector<Block> m_batches;
+
+    /* Columns of the batch being buffered */
+    std::vector<std::int64_t> m_timestamps;
+    std::vector<std::uint8_t> m_entityGroupIds;
+    std::vector<std::uint32_t> m_entityIds;
+    std::vector<std::uint16_t> m_fieldIds;
+    std::vector<std::int64_t> m_int64Values;
+    std::vector<double> m_doubleValues;
+    std::vector<std::uint8_t> m_int64Validity;  /* Bit per row, set if the row has an int64 value */
+    std::vector<std::uint8_t> m_doubleValidity; /* Bit per row, set if the row has a double value */
+    size_t m_int64NullCount  = 0;
+    size_t m_doubleNullCount = 0;
+};
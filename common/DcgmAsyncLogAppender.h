@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "MpmcQueue.hpp"
+
+#include <plog/Appenders/IAppender.h>
+#include <plog/Log.h>
+#include <plog/Record.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/* Depth of the queue of records of the asynchronous file appender. Unset or 0 = log synchronously */
+#define DCGM_LOGGING_ENV_ASYNC_QUEUE_DEPTH "__DCGM_LOG_ASYNC_QUEUE_DEPTH__"
+
+/* Max INFO and lower records per second of each call site when logging asynchronously. 0 = unlimited */
+#define DCGM_LOGGING_ENV_RATE_LIMIT     "__DCGM_LOG_RATE_LIMIT__"
+#define DCGM_LOGGING_DEFAULT_RATE_LIMIT 1000
+
+namespace DcgmNs::Logging
+{
+/*****************************************************************************/
+/* Formatter of the appender behind an AsyncLogAppender. The records it's given are already formatted */
+class PreformattedLogFormatter
+{
+public:
+    static plog::util::nstring header()
+    {
+        return plog::util::nstring();
+    }
+
+    static plog::util::nstring format(plog::Record const &record)
+    {
+        return record.getMessage();
+    }
+};
+
+/*****************************************************************************/
+struct AsyncLogAppenderStats
+{
+    unsigned long long written            = 0; /* Records written to the downstream appender */
+    unsigned long long droppedQueueFull   = 0; /* Records dropped because the queue was full */
+    unsigned long long droppedRateLimited = 0; /* Records dropped because their call site was over its rate */
+};
+
+/*****************************************************************************/
+/*
+ * Appender that formats records on the logging thread and queues them for a
+ * background thread to write to the downstream appender, so that logging never
+ * waits on file I/O or on the downstream appender's lock.
+ *
+ * The queue is a lock-free MpmcQueue of fixed depth. When it's full, INFO and
+ * lower records are dropped and counted. ERROR and FATAL records are written on
+ * the logging thread instead, after the queue is drained to keep them in order.
+ * FATAL records always drain the queue and are written before write() returns.
+ *
+ * INFO and lower records are also rate limited per call site (file and line),
+ * so that one chatty log line in a hot loop can't crowd out the others. Call
+ * sites share c_callSiteSlots counters by hash, so colliding sites share a rate.
+ *
+ * Drop counts are written to the log as they change.
+ */
+template <class Formatter>
+class AsyncLogAppender : public plog::IAppender
+{
+public:
+    static constexpr unsigned int c_callSiteSlots = 4096;
+
+    /*************************************************************************/
+    /*
+     * downstream                  Appender to write to. Its formatter has to be PreformattedLogFormatter
+     * queueDepth                  Number of queued records before INFO and lower records are dropped
+     * maxRecordsPerSecPerCallSite Rate limit of INFO and lower records of each call site. 0 = unlimited
+     */
+    AsyncLogAppender(std::unique_ptr<plog::IAppender> downstream,
+                     std::size_t queueDepth,
+                     unsigned int maxRecordsPerSecPerCallSite)
+        : m_downstream(std::move(downstream))
+        , m_queue(queueDepth)
+        , m_maxRecordsPerSecPerCallSite(maxRecordsPerSecPerCallSite)
+        , m_callSites(std::make_unique<CallSite[]>(c_callSiteSlots))
+    {
+        m_thread = std::thread([this] { Run(); });
+    }
+
+    ~AsyncLogAppender() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stop = true;
+        }
+        m_wakeCondition.notify_one();
+        m_thread.join();
+    }
+
+    AsyncLogAppender(AsyncLogAppender const &)            = delete;
+    AsyncLogAppender &operator=(AsyncLogAppender const &) = delete;
+
+    /*************************************************************************/
+    void write(plog::Record const &record) override
+    {
+        plog::Severity const severity = record.getSeverity();
+
+        if (IsRateLimited(record))
+        {
+            m_droppedRateLimited.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::string line = Formatter::format(record);
+
+        if (severity == plog::fatal)
+        {
+            WriteNow(line);
+            return;
+        }
+
+        if (!m_queue.TryEnqueue(line))
+        {
+            if (severity <= plog::error)
+            {
+                WriteNow(line);
+            }
+            else
+            {
+                m_droppedQueueFull.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+
+        /* One wakeup per batch. A wakeup lost to the race with the drain only delays it until c_drainInterval */
+        if (!m_pending.exchange(true, std::memory_order_relaxed))
+        {
+            m_wakeCondition.notify_one();
+        }
+    }
+
+    /*************************************************************************/
+    /* Write all queued records on the calling thread */
+    void Flush()
+    {
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        DrainLocked();
+    }
+
+    /*************************************************************************/
+    AsyncLogAppenderStats GetStats() const
+    {
+        AsyncLogAppenderStats stats;
+        stats.written            = m_written.load(std::memory_order_relaxed);
+        stats.droppedQueueFull   = m_droppedQueueFull.load(std::memory_order_relaxed);
+        stats.droppedRateLimited = m_droppedRateLimited.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr std::chrono::milliseconds c_drainInterval { 100 };
+
+    struct CallSite
+    {
+        std::atomic<std::int64_t> second { 0 }; /* Second the count is of */
+        std::atomic<std::uint32_t> count { 0 };
+    };
+
+    /* Record whose message is a line that is already formatted */
+    class PreformattedRecord : public plog::Record
+    {
+    public:
+        explicit PreformattedRecord(std::string const &line)
+            : plog::Record(plog::none, "", 0, "", nullptr, PLOG_DEFAULT_INSTANCE_ID)
+            , m_line(line)
+        {}
+
+        plog::util::nchar const *getMessage() const override
+        {
+            return m_line.c_str();
+        }
+
+    private:
+        std::string const &m_line;
+    };
+
+    /*************************************************************************/
+    bool IsRateLimited(plog::Record const &record)
+    {
+        if (m_maxRecordsPerSecPerCallSite == 0 || record.getSeverity() <= plog::warning)
+        {
+            return false;
+        }
+
+        std::size_t const hash
+            = std::hash<void const *> {}(record.getFile()) ^ (record.getLine() * 0x9e3779b97f4a7c15ULL);
+        CallSite &callSite = m_callSites[hash % c_callSiteSlots];
+
+        /* Racing resets at the turn of a second may let a few extra records through, which is fine */
+        std::int64_t const now = record.getTime().time;
+        if (callSite.second.load(std::memory_order_relaxed) != now)
+        {
+            callSite.second.store(now, std::memory_order_relaxed);
+            callSite.count.store(0, std::memory_order_relaxed);
+        }
+
+        return callSite.count.fetch_add(1, std::memory_order_relaxed) >= m_maxRecordsPerSecPerCallSite;
+    }
+
+    /*************************************************************************/
+    /* Write line on the calling thread after the records queued before it */
+    void WriteNow(std::string const &line)
+    {
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        DrainLocked();
+        m_downstream->write(PreformattedRecord(line));
+        m_written.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*************************************************************************/
+    /* Caller must hold m_drainMutex */
+    void DrainLocked()
+    {
+        m_pending.store(false, std::memory_order_relaxed);
+
+        while (auto line = m_queue.TryDequeue())
+        {
+            m_downstream->write(PreformattedRecord(*line));
+            m_written.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ReportDropsLocked();
+    }
+
+    /*************************************************************************/
+    /* Log the drop counts if they changed since they were last logged. Caller must hold m_drainMutex */
+    void ReportDropsLocked()
+    {
+        auto const droppedQueueFull   = m_droppedQueueFull.load(std::memory_order_relaxed);
+        auto const droppedRateLimited = m_droppedRateLimited.load(std::memory_order_relaxed);
+
+        if (droppedQueueFull == m_reportedQueueFull && droppedRateLimited == m_reportedRateLimited)
+        {
+            return;
+        }
+
+        plog::Record record(plog::warning, __func__, __LINE__, __FILE__, nullptr, PLOG_DEFAULT_INSTANCE_ID);
+        record << "Dropped " << droppedQueueFull - m_reportedQueueFull
+               << " log records because the queue was full and " << droppedRateLimited - m_reportedRateLimited
+               << " because of rate limits. Totals: " << droppedQueueFull << ", " << droppedRateLimited;
+        m_downstream->write(PreformattedRecord(Formatter::format(record)));
+
+        m_reportedQueueFull   = droppedQueueFull;
+        m_reportedRateLimited = droppedRateLimited;
+    }
+
+    /*************************************************************************/
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+        while (!m_stop)
+        {
+            m_wakeCondition.wait_for(
+                lock, c_drainInterval, [this] { return m_stop || m_pending.load(std::memory_order_relaxed); });
+
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+
+        lock.unlock();
+        Flush();
+    }
+
+    std::unique_ptr<plog::IAppender> m_downstream;
+    DcgmNs::MpmcQueue<std::string> m_queue;
+    unsigned int const m_maxRecordsPerSecPerCallSite;
+    std::unique_ptr<CallSite[]> m_callSites;
+
+    std::atomic<bool> m_pending { false }; /* Records were queued since the last drain started */
+    std::atomic<unsigned long long> m_written { 0 };
+    std::atomic<unsigned long long> m_droppedQueueFull { 0 };
+    std::atomic<unsigned long long> m_droppedRateLimited { 0 };
+
+    std::mutex m_drainMutex; /* Serializes writes to m_downstream and protects the below */
+    unsigned long long m_reportedQueueFull   = 0;
+    unsigned long long m_reportedRateLimited = 0;
+
+    std::mutex m_wakeMutex; /* Protects m_stop */
+    std::condition_variable m_wakeCondition;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+} // namespace DcgmNs::Logging
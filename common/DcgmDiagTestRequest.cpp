@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmDiagTestRequest.h"
+#include "DcgmLogging.h"
+#include "DcgmProtocol.h"
+
+#include <cstring>
+#include <memory>
+
+/*****************************************************************************/
+DcgmDiagTestRequest::DcgmDiagTestRequest(dcgmDiagTestCompleted_f callback, void *userData)
+    : DcgmRequest(0)
+    , m_callback(callback)
+    , m_userData(userData)
+{}
+
+/*****************************************************************************/
+int DcgmDiagTestRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
+{
+    if (!msg)
+        return DCGM_ST_BADPARAM;
+
+    dcgm_message_header_t *header = msg->GetMessageHdr();
+    if (header->msgType != DCGM_MSG_DIAG_TEST_NOTIFY)
+    {
+        log_error("Ignoring unexpected msgType {} for diagnostic test results", header->msgType);
+        return DCGM_ST_OK; /* Returning an error here doesn't affect anything we want to affect */
+    }
+
+    auto msgBytes = msg->GetMsgBytesPtr();
+    if (msgBytes->size() != sizeof(dcgmDiagTestCompletion_v1))
+    {
+        log_error("Got a diagnostic test completion of {} bytes. Expected {}",
+                  msgBytes->size(),
+                  sizeof(dcgmDiagTestCompletion_v1));
+        return DCGM_ST_OK;
+    }
+
+    /* The message buffer has no particular alignment */
+    auto completion = std::make_unique<dcgmDiagTestCompletion_v1>();
+    memcpy(completion.get(), msgBytes->data(), sizeof(*completion));
+
+    try
+    {
+        m_callback(completion.get(), m_userData);
+    }
+    catch (std::exception const &e)
+    {
+        log_error("Callback thrown exception: {}.", e.what());
+    }
+    catch (...)
+    {
+        log_error("Callback thrown unknown exception.");
+    }
+
+    return DCGM_ST_OK;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DCGMDIAGTESTREQUEST_H
+#define DCGMDIAGTESTREQUEST_H
+
+#include "DcgmRequest.h"
+#include "dcgm_structs.h"
+
+/*****************************************************************************/
+/*
+ * Client side of a streaming diagnostic run. The run's response completes the
+ * blocking request as usual. Every DCGM_MSG_DIAG_TEST_NOTIFY before it is
+ * handed to the callback.
+ */
+class DcgmDiagTestRequest : public DcgmRequest
+{
+public:
+    DcgmDiagTestRequest(dcgmDiagTestCompleted_f callback, void *userData);
+    ~DcgmDiagTestRequest() override = default;
+    int ProcessMessage(std::unique_ptr<DcgmMessage> msg) override;
+
+private:
+    dcgmDiagTestCompleted_f m_callback;
+    void *m_userData;
+};
+
+#endif /* DCGMDIAGTESTREQUEST_H */
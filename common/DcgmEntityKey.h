@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <dcgm_fields.h>
+#include <dcgm_structs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/*****************************************************************************/
+/* Unique key for a given fieldEntityGroup + entityId + fieldId combination */
+typedef struct
+{
+    dcgm_field_eid_t entityId;    /* Entity ID of this watch */
+    unsigned short fieldId;       /* Field ID of this watch */
+    unsigned short entityGroupId; /* DCGM_FE_? #define of the entity group this
+                                           belongs to */
+} dcgm_entity_key_t;              /* 8 bytes */
+
+inline bool operator==(dcgm_entity_key_t const &lhs, dcgm_entity_key_t const &rhs)
+{
+    return lhs.fieldId == rhs.fieldId && lhs.entityId == rhs.entityId && lhs.entityGroupId == rhs.entityGroupId;
+}
+
+namespace DcgmNs
+{
+/*****************************************************************************/
+/*
+ * An entity + field packed in 64 bits, as the key of hash tables of entities
+ * and fields: entityGroupId in bits 48-63, fieldId in bits 32-47 and entityId
+ * in bits 0-31. Keys of an entity without a field have fieldId 0.
+ *
+ * Packed keys compare as a single integer and hash with HashPackedEntityKey().
+ */
+using PackedEntityKey = std::uint64_t;
+
+constexpr PackedEntityKey PackEntityKey(unsigned int entityGroupId, dcgm_field_eid_t entityId, unsigned short fieldId)
+{
+    return (static_cast<std::uint64_t>(entityGroupId & 0xFFFF) << 48) | (static_cast<std::uint64_t>(fieldId) << 32)
+           | static_cast<std::uint64_t>(entityId);
+}
+
+constexpr PackedEntityKey PackEntityKey(dcgm_entity_key_t const &key)
+{
+    return PackEntityKey(key.entityGroupId, key.entityId, key.fieldId);
+}
+
+constexpr PackedEntityKey PackEntityKey(dcgmGroupEntityPair_t const &entity)
+{
+    return PackEntityKey(entity.entityGroupId, entity.entityId, 0);
+}
+
+/*****************************************************************************/
+/*
+ * splitmix64 finalizer. Entity and field ids are small and dense, so every bit
+ * is mixed into the low bits that pick a bucket, which std::hash<std::uint64_t>
+ * doesn't do since it is the identity.
+ */
+constexpr std::size_t HashPackedEntityKey(PackedEntityKey key)
+{
+    std::uint64_t x = key;
+    x               = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x               = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return (std::size_t)(x ^ (x >> 31));
+}
+
+/*****************************************************************************/
+/* Hasher of PackedEntityKey, dcgm_entity_key_t and dcgmGroupEntityPair_t keys of unordered containers */
+struct EntityKeyHash
+{
+    std::size_t operator()(PackedEntityKey key) const noexcept
+    {
+        return HashPackedEntityKey(key);
+    }
+
+    std::size_t operator()(dcgm_entity_key_t const &key) const noexcept
+    {
+        return HashPackedEntityKey(PackEntityKey(key));
+    }
+
+    std::size_t operator()(dcgmGroupEntityPair_t const &entity) const noexcept
+    {
+        return HashPackedEntityKey(PackEntityKey(entity));
+    }
+};
+
+} // namespace DcgmNs
+
+namespace std
+{
+template <>
+struct hash<dcgm_entity_key_t>
+{
+    std::size_t operator()(dcgm_entity_key_t const &k) const noexcept
+    {
+        return DcgmNs::HashPackedEntityKey(DcgmNs::PackEntityKey(k));
+    }
+};
+} // namespace std
@@ -16,6 +16,8 @@
 #include "DcgmFvBuffer.h"
 #include "DcgmLogging.h"
 
+#include <cachealloc.h>
+
 /******************************************************************************/
 DcgmFvBuffer::DcgmFvBuffer(size_t initialCapacity, bool growExponentially)
 {
@@ -34,7 +36,7 @@ DcgmFvBuffer::~DcgmFvBuffer()
 {
     if (m_buffer)
     {
-        free(m_buffer);
+        cachealloc_free(m_buffer);
         m_buffer = 0;
     }
 
@@ -51,14 +53,14 @@ dcgmReturn_t DcgmFvBuffer::Resize(size_t newCapacity)
     if (newCapacity <= m_bufferCapacity)
         return DCGM_ST_OK;
 
-    char *tmp_buffer = (char *)realloc(m_buffer, newCapacity);
+    char *tmp_buffer = (char *)cachealloc_realloc(m_buffer, newCapacity);
     if (!tmp_buffer)
     {
         log_error("Unable to resize buffer to {}", (int)newCapacity);
         m_bufferUsed     = 0;
         m_bufferCapacity = 0;
         m_numEntries     = 0;
-        free(m_buffer);
+        cachealloc_free(m_buffer);
         m_buffer = nullptr;
         return DCGM_ST_MEMORY;
     }
@@ -309,18 +311,42 @@ dcgmBufferedFv_t *DcgmFvBuffer::AddFV1Value(dcgm_field_entity_group_t entityGrou
     return nullptr;
 }
 
+/******************************************************************************/
+dcgmBufferedFv_t *DcgmFvBuffer::AddBufferedFv(dcgmBufferedFv_t const *fv)
+{
+    assert(fv != nullptr);
+
+    dcgmBufferedFv_t *retPtr = AddFvReally(fv->length);
+    if (!retPtr)
+    {
+        return nullptr;
+    }
+
+    memcpy(retPtr, fv, fv->length);
+    return retPtr;
+}
+
 /******************************************************************************/
 dcgmBufferedFv_t *DcgmFvBuffer::GetNextFv(dcgmBufferedFvCursor_t *cursor)
 {
-    dcgmBufferedFv_t *retPtr;
+    /* m_buffer is ours to modify */
+    return const_cast<dcgmBufferedFv_t *>(GetNextFv(m_buffer, m_bufferUsed, cursor));
+}
 
-    if (!m_buffer || !m_bufferUsed)
+/******************************************************************************/
+dcgmBufferedFv_t const *DcgmFvBuffer::GetNextFv(const char *buffer,
+                                                size_t bufferSize,
+                                                dcgmBufferedFvCursor_t *cursor)
+{
+    dcgmBufferedFv_t const *retPtr;
+
+    if (!buffer || !bufferSize)
         return 0;
 
-    if ((*cursor) >= m_bufferUsed)
+    if ((*cursor) >= bufferSize)
         return 0;
 
-    retPtr = (dcgmBufferedFv_t *)&m_buffer[*cursor];
+    retPtr = (dcgmBufferedFv_t const *)&buffer[*cursor];
 
     /* Do some basic sanity on the FV */
     if (retPtr->version != dcgmBufferedFv_version)
@@ -328,9 +354,9 @@ dcgmBufferedFv_t *DcgmFvBuffer::GetNextFv(dcgmBufferedFvCursor_t *cursor)
         log_error("Corrupt fv. version {} found.", (int)retPtr->version);
         return 0;
     }
-    if (retPtr->length + (*cursor) > m_bufferUsed)
+    if (retPtr->length + (*cursor) > bufferSize)
     {
-        log_error("Corrupt fv length {} at {} / {}", retPtr->length, (int)(*cursor), (int)m_bufferUsed);
+        log_error("Corrupt fv length {} at {} / {}", retPtr->length, (int)(*cursor), (int)bufferSize);
         return 0;
     }
 
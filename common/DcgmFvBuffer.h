@@ -112,6 +112,20 @@ public:
      */
     dcgmBufferedFv_t *GetNextFv(dcgmBufferedFvCursor_t *cursor);
 
+    /**************************************************************************
+     * Get the next field value of a serialized FV buffer, such as the one of
+     * GetBuffer(), in place. This reads another DcgmFvBuffer's contents
+     * without copying them with SetFromBuffer()
+     *
+     * buffer      IN: Serialized FVs, one after another
+     * bufferSize  IN: Size of buffer in bytes
+     * cursor  IN/OUT: Cursor from a previous call to GetNextFv(). Pass 0 on first call.
+     *
+     * Returns Pointer to the next element in buffer
+     *         NULL if we have walked the entire buffer or an error occurs
+     */
+    static dcgmBufferedFv_t const *GetNextFv(const char *buffer, size_t bufferSize, dcgmBufferedFvCursor_t *cursor);
+
     /**************************************************************************
      * Set the contents of this FV from a buffer. This is essentially
      * deserialization
@@ -222,6 +236,14 @@ public:
                                   dcgm_field_eid_t entityId,
                                   dcgmFieldValue_v1 *fv1);
 
+    /**************************************************************************
+     * Append a copy of fv, which may come from another fvBuffer
+     *
+     * Returns A pointer to the allocated field-value structure
+     *         nullptr on error (will be logged)
+     */
+    dcgmBufferedFv_t *AddBufferedFv(dcgmBufferedFv_t const *fv);
+
     /**************************************************************************
      * Tell this object whether to grow exponentially or not from now on
      *
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFvBufferV2.h"
+#include "DcgmLogging.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+/* Size of a dcgmBufferedFv_t without its value union */
+constexpr size_t BUFFERED_FV_HEADER_SIZE = sizeof(dcgmBufferedFv_t) - sizeof(((dcgmBufferedFv_t *)0)->value);
+
+/*****************************************************************************/
+size_t PadTo8(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+/*****************************************************************************/
+bool IsVarType(unsigned char fieldType)
+{
+    return fieldType == DCGM_FT_STRING || fieldType == DCGM_FT_BINARY;
+}
+
+/*****************************************************************************/
+/* Offsets of the sections of a serialized buffer from its start */
+struct SectionOffsets
+{
+    size_t timestamps;
+    size_t values;
+    size_t entityIds;
+    size_t fieldIds;
+    size_t entityGroupIds;
+    size_t statuses;
+    size_t fieldTypes;
+    size_t varOffsets;
+    size_t varData;
+    size_t end;
+};
+
+SectionOffsets GetSectionOffsets(size_t headerBytes, size_t rowCount, size_t varCount, size_t varBytes)
+{
+    SectionOffsets offsets;
+    offsets.timestamps     = PadTo8(headerBytes);
+    offsets.values         = offsets.timestamps + PadTo8(rowCount * sizeof(std::int64_t));
+    offsets.entityIds      = offsets.values + PadTo8(rowCount * sizeof(std::int64_t));
+    offsets.fieldIds       = offsets.entityIds + PadTo8(rowCount * sizeof(std::uint32_t));
+    offsets.entityGroupIds = offsets.fieldIds + PadTo8(rowCount * sizeof(std::uint16_t));
+    offsets.statuses       = offsets.entityGroupIds + PadTo8(rowCount);
+    offsets.fieldTypes     = offsets.statuses + PadTo8(rowCount);
+    offsets.varOffsets     = offsets.fieldTypes + PadTo8(rowCount);
+    offsets.varData        = offsets.varOffsets + PadTo8((varCount + 1) * sizeof(std::uint32_t));
+    offsets.end            = offsets.varData + PadTo8(varBytes);
+    return offsets;
+}
+} // namespace
+
+/*****************************************************************************/
+DcgmFvBufferV2::Chunk *DcgmFvBufferV2::AddRow(dcgm_field_entity_group_t entityGroupId,
+                                              dcgm_field_eid_t entityId,
+                                              unsigned short fieldId,
+                                              unsigned char fieldType,
+                                              long long timestamp,
+                                              dcgmReturn_t status,
+                                              size_t &index)
+{
+    size_t const chunkIndex = m_rowCount / c_chunkRows;
+
+    if (chunkIndex == m_chunks.size())
+    {
+        /* Not value-initialized on purpose. Only the first count rows are ever read */
+        std::unique_ptr<Chunk> chunk(new (std::nothrow) Chunk);
+        if (!chunk)
+        {
+            log_error("Unable to allocate a chunk of {} rows", c_chunkRows);
+            return nullptr;
+        }
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    Chunk *chunk = m_chunks[chunkIndex].get();
+    if (m_rowCount % c_chunkRows == 0)
+    {
+        chunk->count = 0;
+    }
+
+    index                        = chunk->count++;
+    chunk->timestamps[index]     = timestamp;
+    chunk->entityIds[index]      = entityId;
+    chunk->fieldIds[index]       = fieldId;
+    chunk->entityGroupIds[index] = entityGroupId;
+    chunk->statuses[index]       = status;
+    chunk->fieldTypes[index]     = fieldType;
+    m_rowCount++;
+    return chunk;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddInt64Value(dcgm_field_entity_group_t entityGroupId,
+                                           dcgm_field_eid_t entityId,
+                                           unsigned short fieldId,
+                                           long long value,
+                                           long long timestamp,
+                                           dcgmReturn_t status)
+{
+    size_t index;
+    Chunk *chunk = AddRow(entityGroupId, entityId, fieldId, DCGM_FT_INT64, timestamp, status, index);
+    if (!chunk)
+    {
+        return DCGM_ST_MEMORY;
+    }
+
+    chunk->values[index].i64 = value;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddDoubleValue(dcgm_field_entity_group_t entityGroupId,
+                                            dcgm_field_eid_t entityId,
+                                            unsigned short fieldId,
+                                            double value,
+                                            long long timestamp,
+                                            dcgmReturn_t status)
+{
+    size_t index;
+    Chunk *chunk = AddRow(entityGroupId, entityId, fieldId, DCGM_FT_DOUBLE, timestamp, status, index);
+    if (!chunk)
+    {
+        return DCGM_ST_MEMORY;
+    }
+
+    chunk->values[index].dbl = value;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddVarRow(dcgm_field_entity_group_t entityGroupId,
+                                       dcgm_field_eid_t entityId,
+                                       unsigned short fieldId,
+                                       unsigned char fieldType,
+                                       void const *value,
+                                       size_t valueSize,
+                                       long long timestamp,
+                                       dcgmReturn_t status)
+{
+    if (m_varBlockIndex == m_varBlocks.size() || m_varBlockUsed + valueSize > c_varBlockBytes)
+    {
+        if (m_varBlockIndex < m_varBlocks.size())
+        {
+            m_varBlockIndex++;
+            m_varBlockUsed = 0;
+        }
+        if (m_varBlockIndex == m_varBlocks.size())
+        {
+            std::unique_ptr<char[]> block(new (std::nothrow) char[c_varBlockBytes]);
+            if (!block)
+            {
+                log_error("Unable to allocate a var block of {} bytes", c_varBlockBytes);
+                return DCGM_ST_MEMORY;
+            }
+            m_varBlocks.push_back(std::move(block));
+        }
+    }
+
+    size_t index;
+    Chunk *chunk = AddRow(entityGroupId, entityId, fieldId, fieldType, timestamp, status, index);
+    if (!chunk)
+    {
+        return DCGM_ST_MEMORY;
+    }
+
+    char *data = m_varBlocks[m_varBlockIndex].get() + m_varBlockUsed;
+    memcpy(data, value, valueSize);
+    m_varBlockUsed += valueSize;
+    m_varBytes += valueSize;
+
+    chunk->values[index].var = (std::int64_t)m_varValues.size();
+    m_varValues.push_back({ data, (std::uint32_t)valueSize });
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddStringValue(dcgm_field_entity_group_t entityGroupId,
+                                            dcgm_field_eid_t entityId,
+                                            unsigned short fieldId,
+                                            const char *value,
+                                            long long timestamp,
+                                            dcgmReturn_t status)
+{
+    if (!value || !(*value))
+    {
+        log_error("Bad parameter");
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Keep the terminator, like DcgmFvBuffer does */
+    size_t const valueSize = strlen(value) + 1;
+    if (valueSize > DCGM_MAX_STR_LENGTH)
+    {
+        log_error("String {} is too big to buffer. (> {})", value, DCGM_MAX_STR_LENGTH);
+        return DCGM_ST_BADPARAM;
+    }
+
+    return AddVarRow(entityGroupId, entityId, fieldId, DCGM_FT_STRING, value, valueSize, timestamp, status);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddBlobValue(dcgm_field_entity_group_t entityGroupId,
+                                          dcgm_field_eid_t entityId,
+                                          unsigned short fieldId,
+                                          void const *value,
+                                          size_t valueSize,
+                                          long long timestamp,
+                                          dcgmReturn_t status)
+{
+    if (!value || !valueSize || valueSize > DCGM_MAX_BLOB_LENGTH)
+    {
+        log_error("Bad blob of {} bytes. Max {}", valueSize, DCGM_MAX_BLOB_LENGTH);
+        return DCGM_ST_BADPARAM;
+    }
+
+    return AddVarRow(entityGroupId, entityId, fieldId, DCGM_FT_BINARY, value, valueSize, timestamp, status);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddBufferedFv(dcgmBufferedFv_t const *fv)
+{
+    if (fv->length < BUFFERED_FV_HEADER_SIZE || fv->length > sizeof(*fv))
+    {
+        log_error("Bad FV length {}", fv->length);
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto const entityGroupId = (dcgm_field_entity_group_t)fv->entityGroupId;
+    auto const status        = (dcgmReturn_t)fv->status;
+    size_t const valueSize   = fv->length - BUFFERED_FV_HEADER_SIZE;
+
+    if (IsVarType(fv->fieldType))
+    {
+        return AddVarRow(
+            entityGroupId, fv->entityId, fv->fieldId, fv->fieldType, &fv->value, valueSize, fv->timestamp, status);
+    }
+
+    size_t index;
+    Chunk *chunk = AddRow(entityGroupId, fv->entityId, fv->fieldId, fv->fieldType, fv->timestamp, status, index);
+    if (!chunk)
+    {
+        return DCGM_ST_MEMORY;
+    }
+
+    chunk->values[index].i64 = 0;
+    memcpy(&chunk->values[index], &fv->value, std::min(valueSize, sizeof(Value)));
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::AddFvBuffer(DcgmFvBuffer &fvBuffer)
+{
+    dcgmBufferedFvCursor_t cursor = 0;
+
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        dcgmReturn_t dcgmReturn = AddBufferedFv(fv);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+std::string_view DcgmFvBufferV2::GetVarValue(size_t row) const
+{
+    Chunk const &chunk = *m_chunks[row / c_chunkRows];
+    size_t const index = row % c_chunkRows;
+
+    if (!IsVarType(chunk.fieldTypes[index]))
+    {
+        return {};
+    }
+
+    VarValue const &varValue = m_varValues[chunk.values[index].var];
+    return { varValue.data, varValue.size };
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::GetBufferedFv(size_t row, dcgmBufferedFv_t &fv) const
+{
+    if (row >= m_rowCount)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    Chunk const &chunk = *m_chunks[row / c_chunkRows];
+    size_t const index = row % c_chunkRows;
+
+    fv.version       = dcgmBufferedFv_version;
+    fv.fieldType     = chunk.fieldTypes[index];
+    fv.status        = chunk.statuses[index];
+    fv.entityGroupId = chunk.entityGroupIds[index];
+    fv.fieldId       = chunk.fieldIds[index];
+    fv.timestamp     = chunk.timestamps[index];
+    fv.entityId      = chunk.entityIds[index];
+    fv.unused        = 0;
+
+    if (IsVarType(fv.fieldType))
+    {
+        std::string_view const value = GetVarValue(row);
+        memcpy(&fv.value, value.data(), value.size());
+        fv.length = BUFFERED_FV_HEADER_SIZE + value.size();
+    }
+    else
+    {
+        fv.value.i64 = chunk.values[index].i64;
+        fv.length    = DCGM_BUFFERED_FV1_MIN_ENTRY_SIZE;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::Serialize(std::vector<char> &bytes) const
+{
+    if (m_varBytes > UINT32_MAX || m_rowCount > UINT32_MAX)
+    {
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    SectionOffsets const offsets
+        = GetSectionOffsets(sizeof(dcgm_fv_buffer_v2_header_t), m_rowCount, m_varValues.size(), m_varBytes);
+    bytes.assign(offsets.end, 0);
+
+    dcgm_fv_buffer_v2_header_t header {};
+    header.magic       = DCGM_FV_BUFFER_V2_MAGIC;
+    header.version     = DCGM_FV_BUFFER_V2_VERSION;
+    header.headerBytes = sizeof(header);
+    header.rowCount    = m_rowCount;
+    header.varCount    = m_varValues.size();
+    header.varBytes    = m_varBytes;
+    memcpy(bytes.data(), &header, sizeof(header));
+
+    /* The columns are copied a chunk at a time */
+    size_t row = 0;
+    for (size_t chunkIndex = 0; chunkIndex < GetChunkCount(); chunkIndex++)
+    {
+        Chunk const &chunk = *m_chunks[chunkIndex];
+        size_t const count = chunk.count;
+
+        memcpy(&bytes[offsets.timestamps + row * sizeof(std::int64_t)], chunk.timestamps, count * sizeof(std::int64_t));
+        memcpy(&bytes[offsets.values + row * sizeof(std::int64_t)], chunk.values, count * sizeof(std::int64_t));
+        memcpy(&bytes[offsets.entityIds + row * sizeof(std::uint32_t)], chunk.entityIds, count * sizeof(std::uint32_t));
+        memcpy(&bytes[offsets.fieldIds + row * sizeof(std::uint16_t)], chunk.fieldIds, count * sizeof(std::uint16_t));
+        memcpy(&bytes[offsets.entityGroupIds + row], chunk.entityGroupIds, count);
+        memcpy(&bytes[offsets.statuses + row], chunk.statuses, count);
+        memcpy(&bytes[offsets.fieldTypes + row], chunk.fieldTypes, count);
+        row += count;
+    }
+
+    std::uint32_t varOffset = 0;
+    for (size_t i = 0; i < m_varValues.size(); i++)
+    {
+        memcpy(&bytes[offsets.varOffsets + i * sizeof(std::uint32_t)], &varOffset, sizeof(varOffset));
+        memcpy(&bytes[offsets.varData + varOffset], m_varValues[i].data, m_varValues[i].size);
+        varOffset += m_varValues[i].size;
+    }
+    memcpy(&bytes[offsets.varOffsets + m_varValues.size() * sizeof(std::uint32_t)], &varOffset, sizeof(varOffset));
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+bool DcgmFvBufferV2::IsV2(const char *buffer, size_t bufferSize)
+{
+    std::uint32_t magic = 0;
+
+    if (!buffer || bufferSize < sizeof(magic))
+    {
+        return false;
+    }
+
+    memcpy(&magic, buffer, sizeof(magic));
+    return magic == DCGM_FV_BUFFER_V2_MAGIC;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvBufferV2::SetFromBuffer(const char *buffer, size_t bufferSize)
+{
+    Clear();
+
+    if (!IsV2(buffer, bufferSize))
+    {
+        DcgmFvBuffer fvBuffer(0);
+        dcgmReturn_t dcgmReturn = fvBuffer.SetFromBuffer(buffer, bufferSize);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+        return AddFvBuffer(fvBuffer);
+    }
+
+    dcgm_fv_buffer_v2_header_t header {};
+    if (bufferSize < sizeof(header))
+    {
+        log_error("Buffer of {} bytes is too small for a header", bufferSize);
+        return DCGM_ST_BADPARAM;
+    }
+    memcpy(&header, buffer, sizeof(header));
+
+    if (header.version != DCGM_FV_BUFFER_V2_VERSION)
+    {
+        log_error("Unsupported FV buffer v2 version {}", header.version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    if (header.headerBytes < sizeof(header) || header.varCount > header.rowCount)
+    {
+        log_error("Bad header. headerBytes {}, rowCount {}, varCount {}",
+                  header.headerBytes,
+                  header.rowCount,
+                  header.varCount);
+        return DCGM_ST_BADPARAM;
+    }
+
+    SectionOffsets const offsets
+        = GetSectionOffsets(header.headerBytes, header.rowCount, header.varCount, header.varBytes);
+    if (header.varBytes > UINT32_MAX || offsets.end > bufferSize)
+    {
+        log_error("Buffer of {} bytes is too small for {} rows", bufferSize, header.rowCount);
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::uint32_t varOffset = 0;
+    std::uint32_t nextVarOffset;
+
+    for (size_t row = 0; row < header.rowCount; row++)
+    {
+        std::int64_t timestamp;
+        Value value;
+        std::uint32_t entityId;
+        std::uint16_t fieldId;
+
+        memcpy(&timestamp, buffer + offsets.timestamps + row * sizeof(timestamp), sizeof(timestamp));
+        memcpy(&value, buffer + offsets.values + row * sizeof(value), sizeof(value));
+        memcpy(&entityId, buffer + offsets.entityIds + row * sizeof(entityId), sizeof(entityId));
+        memcpy(&fieldId, buffer + offsets.fieldIds + row * sizeof(fieldId), sizeof(fieldId));
+        auto const entityGroupId = (dcgm_field_entity_group_t)(std::uint8_t)buffer[offsets.entityGroupIds + row];
+        auto const status        = (dcgmReturn_t)(std::int8_t)buffer[offsets.statuses + row];
+        auto const fieldType     = (unsigned char)buffer[offsets.fieldTypes + row];
+
+        dcgmReturn_t dcgmReturn;
+
+        if (IsVarType(fieldType))
+        {
+            if (value.var < 0 || value.var >= header.varCount)
+            {
+                log_error("Row {} has var index {} of {}", row, value.var, header.varCount);
+                return DCGM_ST_BADPARAM;
+            }
+
+            /* Var values are stored in row order */
+            memcpy(&varOffset, buffer + offsets.varOffsets + value.var * sizeof(varOffset), sizeof(varOffset));
+            memcpy(&nextVarOffset,
+                   buffer + offsets.varOffsets + (value.var + 1) * sizeof(nextVarOffset),
+                   sizeof(nextVarOffset));
+            if (nextVarOffset < varOffset || nextVarOffset > header.varBytes
+                || nextVarOffset - varOffset > DCGM_MAX_BLOB_LENGTH)
+            {
+                log_error("Row {} has bad var offsets {} and {}", row, varOffset, nextVarOffset);
+                return DCGM_ST_BADPARAM;
+            }
+
+            dcgmReturn = AddVarRow(entityGroupId,
+                                   entityId,
+                                   fieldId,
+                                   fieldType,
+                                   buffer + offsets.varData + varOffset,
+                                   nextVarOffset - varOffset,
+                                   timestamp,
+                                   status);
+        }
+        else
+        {
+            size_t index;
+            Chunk *chunk = AddRow(entityGroupId, entityId, fieldId, fieldType, timestamp, status, index);
+            if (chunk)
+            {
+                chunk->values[index] = value;
+            }
+            dcgmReturn = chunk ? DCGM_ST_OK : DCGM_ST_MEMORY;
+        }
+
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            Clear();
+            return dcgmReturn;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmFvBufferV2::Clear()
+{
+    m_rowCount      = 0;
+    m_varBlockIndex = 0;
+    m_varBlockUsed  = 0;
+    m_varBytes      = 0;
+    m_varValues.clear();
+}
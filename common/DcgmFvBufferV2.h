@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmFvBuffer.h"
+#include "dcgm_fields.h"
+#include "dcgm_structs.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/*****************************************************************************/
+/* First 4 bytes of a serialized DcgmFvBufferV2 ("DFV2"). Like DCGM_FV_COLUMNS_MAGIC,
+   it can't be mistaken for a serialized DcgmFvBuffer because its third byte
+   isn't dcgmBufferedFv_version */
+#define DCGM_FV_BUFFER_V2_MAGIC 0x32564644
+
+/* Current version of the serialized DcgmFvBufferV2 layout */
+#define DCGM_FV_BUFFER_V2_VERSION 1
+
+/*****************************************************************************/
+/*
+ * Header of a serialized DcgmFvBufferV2. It is followed by these sections, each
+ * of which starts on an 8-byte boundary:
+ *
+ *   timestamps        rowCount x int64_t
+ *   values            rowCount x int64_t. The int64 or the bits of the double of
+ *                     fixed-width rows. The index into var offsets of var rows
+ *   entity IDs        rowCount x uint32_t
+ *   field IDs         rowCount x uint16_t
+ *   entity group IDs  rowCount x uint8_t
+ *   statuses          rowCount x int8_t
+ *   field types       rowCount x uint8_t
+ *   var offsets       (varCount + 1) x uint32_t into var data
+ *   var data          varBytes bytes. Strings include their terminator
+ *
+ * Readers skip headerBytes to get to the sections, so later versions can grow the header.
+ */
+typedef struct
+{
+    std::uint32_t magic;       //!< DCGM_FV_BUFFER_V2_MAGIC
+    std::uint16_t version;     //!< DCGM_FV_BUFFER_V2_VERSION
+    std::uint16_t headerBytes; //!< Size of this header
+    std::uint32_t rowCount;    //!< Number of field values
+    std::uint32_t varCount;    //!< Number of DCGM_FT_STRING and DCGM_FT_BINARY rows
+    std::uint64_t varBytes;    //!< Size of the var data section
+} dcgm_fv_buffer_v2_header_t;
+
+/*****************************************************************************/
+/*
+ * DcgmFvBufferV2 buffers field values like DcgmFvBuffer, in columns instead of
+ * back-to-back dcgmBufferedFv_t records.
+ *
+ * Every row has a fixed-width entry in the columns of a Chunk: entity, field,
+ * timestamp, status, type and an 8-byte value. Strings and blobs are kept in a
+ * separate var section, and their rows' value is an index into it. So int64 and
+ * double values can be processed in tight loops over a chunk's columns, and any
+ * row is found by index without walking the rows before it.
+ *
+ * Storage grows by whole chunks and var blocks, so nothing is ever copied on
+ * growth and pointers into chunks stay valid until Clear().
+ *
+ * This class is not thread safe.
+ */
+class DcgmFvBufferV2
+{
+public:
+    static constexpr size_t c_chunkRows     = 1024;
+    static constexpr size_t c_varBlockBytes = 64 * 1024;
+
+    union Value
+    {
+        std::int64_t i64; //!< DCGM_FT_INT64 and DCGM_FT_TIMESTAMP
+        double dbl;       //!< DCGM_FT_DOUBLE
+        std::int64_t var; //!< DCGM_FT_STRING and DCGM_FT_BINARY. Index of the var value
+    };
+
+    /* c_chunkRows rows in columns. Only the first count rows are set */
+    struct Chunk
+    {
+        std::int64_t timestamps[c_chunkRows];
+        Value values[c_chunkRows];
+        dcgm_field_eid_t entityIds[c_chunkRows];
+        std::uint16_t fieldIds[c_chunkRows];
+        std::uint8_t entityGroupIds[c_chunkRows];
+        std::int8_t statuses[c_chunkRows];
+        std::uint8_t fieldTypes[c_chunkRows];
+        size_t count;
+    };
+
+    /*************************************************************************/
+    /*
+     * Add a field value
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if a string or blob value is empty or too large
+     *         DCGM_ST_MEMORY if out of memory
+     */
+    dcgmReturn_t AddInt64Value(dcgm_field_entity_group_t entityGroupId,
+                               dcgm_field_eid_t entityId,
+                               unsigned short fieldId,
+                               long long value,
+                               long long timestamp,
+                               dcgmReturn_t status);
+    dcgmReturn_t AddDoubleValue(dcgm_field_entity_group_t entityGroupId,
+                                dcgm_field_eid_t entityId,
+                                unsigned short fieldId,
+                                double value,
+                                long long timestamp,
+                                dcgmReturn_t status);
+    dcgmReturn_t AddStringValue(dcgm_field_entity_group_t entityGroupId,
+                                dcgm_field_eid_t entityId,
+                                unsigned short fieldId,
+                                const char *value,
+                                long long timestamp,
+                                dcgmReturn_t status);
+    dcgmReturn_t AddBlobValue(dcgm_field_entity_group_t entityGroupId,
+                              dcgm_field_eid_t entityId,
+                              unsigned short fieldId,
+                              void const *value,
+                              size_t valueSize,
+                              long long timestamp,
+                              dcgmReturn_t status);
+
+    /*************************************************************************/
+    /* Add a copy of fv, which may come from a DcgmFvBuffer. Same returns as AddInt64Value() */
+    dcgmReturn_t AddBufferedFv(dcgmBufferedFv_t const *fv);
+
+    /*************************************************************************/
+    /* Add a copy of every FV of fvBuffer. Same returns as AddInt64Value() */
+    dcgmReturn_t AddFvBuffer(DcgmFvBuffer &fvBuffer);
+
+    /*************************************************************************/
+    /* Number of field values */
+    size_t GetRowCount() const
+    {
+        return m_rowCount;
+    }
+
+    /*************************************************************************/
+    /* Number of chunks in use. Row r is at r % c_chunkRows of chunk r / c_chunkRows */
+    size_t GetChunkCount() const
+    {
+        return (m_rowCount + c_chunkRows - 1) / c_chunkRows;
+    }
+
+    /*************************************************************************/
+    Chunk const &GetChunk(size_t chunkIndex) const
+    {
+        return *m_chunks[chunkIndex];
+    }
+
+    /*************************************************************************/
+    /* Var value of a DCGM_FT_STRING or DCGM_FT_BINARY row. Empty for any other row */
+    std::string_view GetVarValue(size_t row) const;
+
+    /*************************************************************************/
+    /*
+     * Copy the field value at index row to fv
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if row is out of range
+     */
+    dcgmReturn_t GetBufferedFv(size_t row, dcgmBufferedFv_t &fv) const;
+
+    /*************************************************************************/
+    /*
+     * Serialize this buffer into bytes in the layout of dcgm_fv_buffer_v2_header_t
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NOT_SUPPORTED if the var section doesn't fit 32-bit offsets
+     */
+    dcgmReturn_t Serialize(std::vector<char> &bytes) const;
+
+    /*************************************************************************/
+    /* Returns whether buffer starts with a serialized DcgmFvBufferV2 rather than a DcgmFvBuffer */
+    static bool IsV2(const char *buffer, size_t bufferSize);
+
+    /*************************************************************************/
+    /*
+     * Set the contents of this buffer from a serialized DcgmFvBufferV2 or DcgmFvBuffer
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if buffer isn't well-formed
+     *         Any error of DcgmFvBuffer::SetFromBuffer() for a DcgmFvBuffer
+     *         DCGM_ST_VER_MISMATCH if the layout version isn't supported
+     *         DCGM_ST_MEMORY if out of memory
+     */
+    dcgmReturn_t SetFromBuffer(const char *buffer, size_t bufferSize);
+
+    /*************************************************************************/
+    /* Forget the contents. Allocated chunks and var blocks are kept for reuse */
+    void Clear();
+
+private:
+    struct VarValue
+    {
+        char const *data;
+        std::uint32_t size;
+    };
+
+    /*************************************************************************/
+    /* Append a row whose value the caller sets. nullptr if out of memory */
+    Chunk *AddRow(dcgm_field_entity_group_t entityGroupId,
+                  dcgm_field_eid_t entityId,
+                  unsigned short fieldId,
+                  unsigned char fieldType,
+                  long long timestamp,
+                  dcgmReturn_t status,
+                  size_t &index);
+
+    /*************************************************************************/
+    /* Append a row with a copy of value in the var section */
+    dcgmReturn_t AddVarRow(dcgm_field_entity_group_t entityGroupId,
+                           dcgm_field_eid_t entityId,
+                           unsigned short fieldId,
+                           unsigned char fieldType,
+                           void const *value,
+                           size_t valueSize,
+                           long long timestamp,
+                           dcgmReturn_t status);
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks; /* Only the first GetChunkCount() are in use */
+    size_t m_rowCount = 0;
+
+    std::vector<std::unique_ptr<char[]>> m_varBlocks; /* c_varBlockBytes each */
+    size_t m_varBlockIndex = 0;                       /* Block var values are being added to */
+    size_t m_varBlockUsed  = 0;                       /* Bytes used of that block */
+    std::vector<VarValue> m_varValues;
+    size_t m_varBytes = 0;
+};
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFvColumns.h"
+#include "DcgmEntityKey.h"
+#include "DcgmLogging.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+/* Size of a dcgmBufferedFv_t without its value union */
+constexpr size_t BUFFERED_FV_HEADER_SIZE = sizeof(dcgmBufferedFv_t) - sizeof(((dcgmBufferedFv_t *)0)->value);
+
+/*****************************************************************************/
+size_t PadTo8(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+/*****************************************************************************/
+bool IsNumericType(unsigned char fieldType)
+{
+    return fieldType == DCGM_FT_INT64 || fieldType == DCGM_FT_DOUBLE;
+}
+
+/*****************************************************************************/
+bool IsVarType(unsigned char fieldType)
+{
+    return fieldType == DCGM_FT_STRING || fieldType == DCGM_FT_BINARY;
+}
+
+/*****************************************************************************/
+/* Bytes of fv's value that are worth sending. Strings are sent without their terminator */
+size_t GetVarValueLength(dcgmBufferedFv_t const *fv)
+{
+    size_t dataSize = fv->length - BUFFERED_FV_HEADER_SIZE;
+    if (fv->fieldType == DCGM_FT_STRING)
+    {
+        return strnlen(fv->value.str, dataSize);
+    }
+    return dataSize;
+}
+} // namespace
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvColumns::Encode(DcgmFvBuffer &fvBuffer, std::vector<char> &bytes)
+{
+    std::vector<dcgm_fv_columns_entity_t> entities;
+    std::vector<dcgm_fv_columns_field_t> fields;
+    std::vector<dcgm_fv_columns_row_key_t> rowKeys;
+    std::unordered_map<DcgmNs::PackedEntityKey, std::uint16_t, DcgmNs::EntityKeyHash> entityIndexes;
+    std::unordered_map<std::uint16_t, std::uint16_t> fieldIndexes;
+    std::vector<dcgmBufferedFv_t *> fvs;
+    size_t numberCount  = 0;
+    size_t varCount     = 0;
+    size_t varBytes     = 0;
+    size_t invalidCount = 0;
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        if (!IsNumericType(fv->fieldType) && !IsVarType(fv->fieldType))
+        {
+            DCGM_LOG_DEBUG << "Can't encode fieldType " << (int)fv->fieldType << " of fieldId " << fv->fieldId;
+            return DCGM_ST_NOT_SUPPORTED;
+        }
+
+        DcgmNs::PackedEntityKey entityKey = DcgmNs::PackEntityKey(fv->entityGroupId, fv->entityId, 0);
+        auto entityIt                     = entityIndexes.find(entityKey);
+        if (entityIt == entityIndexes.end())
+        {
+            if (entities.size() > UINT16_MAX)
+            {
+                return DCGM_ST_NOT_SUPPORTED;
+            }
+            entityIt = entityIndexes.emplace(entityKey, (std::uint16_t)entities.size()).first;
+            entities.push_back({ fv->entityGroupId, fv->entityId });
+        }
+
+        auto fieldIt = fieldIndexes.find(fv->fieldId);
+        if (fieldIt == fieldIndexes.end())
+        {
+            if (fields.size() > UINT16_MAX)
+            {
+                return DCGM_ST_NOT_SUPPORTED;
+            }
+            fieldIt = fieldIndexes.emplace(fv->fieldId, (std::uint16_t)fields.size()).first;
+            fields.push_back({ fv->fieldId, fv->fieldType, 0 });
+        }
+        else if (fields[fieldIt->second].fieldType != fv->fieldType)
+        {
+            DCGM_LOG_DEBUG << "fieldId " << fv->fieldId << " has values of types " << fields[fieldIt->second].fieldType
+                           << " and " << fv->fieldType;
+            return DCGM_ST_NOT_SUPPORTED;
+        }
+
+        if (IsNumericType(fv->fieldType))
+        {
+            numberCount++;
+        }
+        else
+        {
+            varCount++;
+            varBytes += GetVarValueLength(fv);
+        }
+
+        if (fv->status != DCGM_ST_OK)
+        {
+            invalidCount++;
+        }
+
+        rowKeys.push_back({ entityIt->second, fieldIt->second });
+        fvs.push_back(fv);
+    }
+
+    size_t const rowCount = fvs.size();
+    if (rowCount > UINT32_MAX || varBytes > UINT32_MAX)
+    {
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    /* Latest value queries return every field of every entity in order. Don't send keys for those */
+    bool dense = rowCount == entities.size() * fields.size();
+    for (size_t i = 0; dense && i < rowCount; i++)
+    {
+        dense = rowKeys[i].entityIndex == i / fields.size() && rowKeys[i].fieldIndex == i % fields.size();
+    }
+
+    dcgm_fv_columns_header_t header {};
+    header.magic        = DCGM_FV_COLUMNS_MAGIC;
+    header.version      = DCGM_FV_COLUMNS_VERSION;
+    header.flags        = dense ? DCGM_FV_COLUMNS_FLAG_DENSE : 0;
+    header.rowCount     = rowCount;
+    header.entityCount  = entities.size();
+    header.fieldCount   = fields.size();
+    header.invalidCount = invalidCount;
+    header.varBytes     = varBytes;
+
+    size_t totalSize = PadTo8(sizeof(header)) + PadTo8(entities.size() * sizeof(entities[0]))
+                       + PadTo8(fields.size() * sizeof(fields[0]))
+                       + (dense ? 0 : PadTo8(rowCount * sizeof(rowKeys[0]))) + rowCount * sizeof(std::int64_t)
+                       + PadTo8((rowCount + 7) / 8) + PadTo8(invalidCount) + numberCount * sizeof(std::int64_t)
+                       + PadTo8((varCount + 1) * sizeof(std::uint32_t)) + varBytes;
+
+    bytes.clear();
+    bytes.reserve(totalSize);
+
+    auto append = [&bytes](void const *data, size_t size) {
+        bytes.insert(bytes.end(), (char const *)data, (char const *)data + size);
+    };
+    auto pad = [&bytes]() {
+        bytes.resize(PadTo8(bytes.size()), 0);
+    };
+
+    append(&header, sizeof(header));
+    pad();
+    append(entities.data(), entities.size() * sizeof(entities[0]));
+    pad();
+    append(fields.data(), fields.size() * sizeof(fields[0]));
+    pad();
+    if (!dense)
+    {
+        append(rowKeys.data(), rowCount * sizeof(rowKeys[0]));
+        pad();
+    }
+
+    for (auto const *fv : fvs)
+    {
+        append(&fv->timestamp, sizeof(fv->timestamp));
+    }
+
+    size_t validityStart = bytes.size();
+    bytes.resize(validityStart + (rowCount + 7) / 8, 0);
+    for (size_t i = 0; i < rowCount; i++)
+    {
+        if (fvs[i]->status == DCGM_ST_OK)
+        {
+            bytes[validityStart + i / 8] |= (char)(1 << (i % 8));
+        }
+    }
+    pad();
+
+    for (auto const *fv : fvs)
+    {
+        if (fv->status != DCGM_ST_OK)
+        {
+            append(&fv->status, sizeof(fv->status));
+        }
+    }
+    pad();
+
+    for (auto const *fv : fvs)
+    {
+        if (IsNumericType(fv->fieldType))
+        {
+            /* i64 and dbl share their storage, so either can be copied */
+            append(&fv->value.i64, sizeof(fv->value.i64));
+        }
+    }
+
+    std::uint32_t varOffset = 0;
+    for (auto const *fv : fvs)
+    {
+        if (IsVarType(fv->fieldType))
+        {
+            append(&varOffset, sizeof(varOffset));
+            varOffset += GetVarValueLength(fv);
+        }
+    }
+    append(&varOffset, sizeof(varOffset));
+    pad();
+
+    for (auto const *fv : fvs)
+    {
+        if (IsVarType(fv->fieldType))
+        {
+            append(&fv->value, GetVarValueLength(fv));
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+bool DcgmFvColumns::IsColumnar(const char *buffer, size_t bufferSize)
+{
+    std::uint32_t magic = 0;
+    if (!buffer || bufferSize < sizeof(magic))
+    {
+        return false;
+    }
+
+    memcpy(&magic, buffer, sizeof(magic));
+    return magic == DCGM_FV_COLUMNS_MAGIC;
+}
+
+/*****************************************************************************/
+void DcgmFvColumns::Clear()
+{
+    m_bytes.clear();
+    m_rows.clear();
+    m_entities   = nullptr;
+    m_fields     = nullptr;
+    m_timestamps = nullptr;
+    m_numbers    = nullptr;
+    m_varOffsets = nullptr;
+    m_varData    = nullptr;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvColumns::SetFromBuffer(const char *buffer, size_t bufferSize)
+{
+    Clear();
+
+    if (!buffer && bufferSize)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (!IsColumnar(buffer, bufferSize))
+    {
+        /* Older host engines send a serialized DcgmFvBuffer. Convert it so callers only deal with columns */
+        DcgmFvBuffer fvBuffer(0);
+        dcgmReturn_t ret = fvBuffer.SetFromBuffer(buffer, bufferSize);
+        if (ret == DCGM_ST_OK)
+        {
+            ret = Encode(fvBuffer, m_bytes);
+        }
+        if (ret != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Unable to convert a " << bufferSize << " byte fvBuffer to columns: " << errorString(ret);
+            return ret;
+        }
+    }
+    else
+    {
+        m_bytes.assign(buffer, buffer + bufferSize);
+    }
+
+    if (m_bytes.size() < sizeof(dcgm_fv_columns_header_t))
+    {
+        DCGM_LOG_ERROR << "Columnar payload of " << m_bytes.size() << " bytes is too small";
+        Clear();
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgm_fv_columns_header_t header;
+    memcpy(&header, m_bytes.data(), sizeof(header));
+    if (header.version != DCGM_FV_COLUMNS_VERSION)
+    {
+        DCGM_LOG_ERROR << "Unsupported columnar payload version " << header.version;
+        Clear();
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    bool const dense = (header.flags & DCGM_FV_COLUMNS_FLAG_DENSE) != 0;
+    if (dense && (std::uint64_t)header.entityCount * header.fieldCount != header.rowCount)
+    {
+        DCGM_LOG_ERROR << "Dense payload of " << header.rowCount << " rows has " << header.entityCount
+                       << " entities and " << header.fieldCount << " fields";
+        Clear();
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Walk the sections, making sure each one fits before pointing at it. All sizes are bounded
+       by the 32-bit counts, so none of this can overflow a size_t */
+    size_t offset    = PadTo8(sizeof(header));
+    bool truncated   = false;
+    auto takeSection = [&](size_t size, bool padded) -> char const * {
+        if (truncated || offset + size > m_bytes.size())
+        {
+            truncated = true;
+            return nullptr;
+        }
+        char const *section = m_bytes.data() + offset;
+        offset += padded ? PadTo8(size) : size;
+        return section;
+    };
+
+    m_entities
+        = (dcgm_fv_columns_entity_t const *)takeSection(header.entityCount * sizeof(dcgm_fv_columns_entity_t), true);
+    m_fields = (dcgm_fv_columns_field_t const *)takeSection(header.fieldCount * sizeof(dcgm_fv_columns_field_t), true);
+    auto const *rowKeys = dense ? nullptr
+                                : (dcgm_fv_columns_row_key_t const *)takeSection(
+                                    header.rowCount * sizeof(dcgm_fv_columns_row_key_t), true);
+    m_timestamps         = (std::int64_t const *)takeSection((size_t)header.rowCount * sizeof(std::int64_t), false);
+    auto const *validity = takeSection((header.rowCount + (size_t)7) / 8, true);
+    auto const *statuses = (std::int8_t const *)takeSection(header.invalidCount, true);
+
+    if (truncated)
+    {
+        DCGM_LOG_ERROR << "Columnar payload of " << m_bytes.size() << " bytes is truncated";
+        Clear();
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* The sizes of the value sections depend on the field type of each row */
+    size_t numberCount  = 0;
+    size_t varCount     = 0;
+    size_t invalidCount = 0;
+    m_rows.resize(header.rowCount);
+
+    for (size_t i = 0; i < header.rowCount; i++)
+    {
+        Row &row = m_rows[i];
+        if (dense)
+        {
+            row.entityIndex = i / header.fieldCount;
+            row.fieldIndex  = i % header.fieldCount;
+        }
+        else
+        {
+            row.entityIndex = rowKeys[i].entityIndex;
+            row.fieldIndex  = rowKeys[i].fieldIndex;
+            if (row.entityIndex >= header.entityCount || row.fieldIndex >= header.fieldCount)
+            {
+                DCGM_LOG_ERROR << "Row " << i << " references a missing entity or field";
+                Clear();
+                return DCGM_ST_BADPARAM;
+            }
+        }
+
+        if (validity[i / 8] & (1 << (i % 8)))
+        {
+            row.status = DCGM_ST_OK;
+        }
+        else if (invalidCount < header.invalidCount)
+        {
+            row.status = statuses[invalidCount++];
+        }
+        else
+        {
+            DCGM_LOG_ERROR << "Columnar payload has more invalid rows than " << header.invalidCount;
+            Clear();
+            return DCGM_ST_BADPARAM;
+        }
+
+        unsigned char fieldType = m_fields[row.fieldIndex].fieldType;
+        if (IsNumericType(fieldType))
+        {
+            row.valueIndex = numberCount++;
+        }
+        else if (IsVarType(fieldType))
+        {
+            row.valueIndex = varCount++;
+        }
+        else
+        {
+            DCGM_LOG_ERROR << "Unknown fieldType " << (int)fieldType << " in the columnar payload";
+            Clear();
+            return DCGM_ST_BADPARAM;
+        }
+    }
+
+    m_numbers    = (std::int64_t const *)takeSection(numberCount * sizeof(std::int64_t), false);
+    m_varOffsets = (std::uint32_t const *)takeSection((varCount + 1) * sizeof(std::uint32_t), true);
+    m_varData    = takeSection(header.varBytes, false);
+
+    if (truncated)
+    {
+        DCGM_LOG_ERROR << "Columnar payload of " << m_bytes.size() << " bytes is truncated";
+        Clear();
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Offsets must be ascending and within var data for ConvertRowToFv2() to trust them */
+    for (size_t i = 0; i < varCount; i++)
+    {
+        if (m_varOffsets[i] > m_varOffsets[i + 1] || m_varOffsets[i + 1] > header.varBytes
+            || m_varOffsets[i + 1] - m_varOffsets[i] > DCGM_MAX_BLOB_LENGTH)
+        {
+            DCGM_LOG_ERROR << "Bad var offset " << m_varOffsets[i + 1] << " at index " << i + 1;
+            Clear();
+            return DCGM_ST_BADPARAM;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmFvColumns::ConvertRowToFv2(size_t row, dcgmFieldValue_v2 *fv2) const
+{
+    if (row >= m_rows.size() || !fv2)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    Row const &r                           = m_rows[row];
+    dcgm_fv_columns_entity_t const &entity = m_entities[r.entityIndex];
+    dcgm_fv_columns_field_t const &field   = m_fields[r.fieldIndex];
+
+    fv2->version       = dcgmFieldValue_version2;
+    fv2->entityGroupId = (dcgm_field_entity_group_t)entity.entityGroupId;
+    fv2->entityId      = entity.entityId;
+    fv2->fieldId       = field.fieldId;
+    fv2->fieldType     = field.fieldType;
+    fv2->unused        = 0;
+    fv2->status        = r.status;
+    fv2->ts            = m_timestamps[row];
+
+    if (IsNumericType(field.fieldType))
+    {
+        /* i64 and dbl share their storage, so the bits can be copied as-is */
+        memcpy(&fv2->value.i64, &m_numbers[r.valueIndex], sizeof(fv2->value.i64));
+    }
+    else
+    {
+        size_t length = m_varOffsets[r.valueIndex + 1] - m_varOffsets[r.valueIndex];
+        if (field.fieldType == DCGM_FT_STRING)
+        {
+            length = std::min(length, sizeof(fv2->value.str) - 1);
+            fv2->value.str[length] = '\0';
+        }
+        memmove(&fv2->value, m_varData + m_varOffsets[r.valueIndex], length);
+    }
+
+    return DCGM_ST_OK;
+}
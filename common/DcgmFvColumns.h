@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmFvBuffer.h"
+#include "dcgm_fields.h"
+#include "dcgm_structs.h"
+
+#include <cstdint>
+#include <vector>
+
+/*****************************************************************************/
+/* First 4 bytes of a columnar FV payload ("DFVC"). The low 16 bits can't be
+   mistaken for a dcgmBufferedFv_t length because the following byte isn't
+   dcgmBufferedFv_version */
+#define DCGM_FV_COLUMNS_MAGIC 0x43564644
+
+/* Current version of the columnar FV payload */
+#define DCGM_FV_COLUMNS_VERSION 1
+
+/* Rows are every entity x every field, entity-major, so no row key column is sent */
+#define DCGM_FV_COLUMNS_FLAG_DENSE 0x0001
+
+/*****************************************************************************/
+/*
+ * Header of a columnar FV payload. It is followed by these sections, each of
+ * which starts on an 8-byte boundary:
+ *
+ *   entities      entityCount x dcgm_fv_columns_entity_t
+ *   fields        fieldCount x dcgm_fv_columns_field_t
+ *   row keys      rowCount x dcgm_fv_columns_row_key_t. Absent if DCGM_FV_COLUMNS_FLAG_DENSE
+ *   timestamps    rowCount x int64_t
+ *   validity      (rowCount + 7) / 8 bytes. Bit set = status of that row is DCGM_ST_OK
+ *   statuses      invalidCount x int8_t. Status of each row whose validity bit is clear
+ *   numbers       int64_t or double of each DCGM_FT_INT64 and DCGM_FT_DOUBLE row
+ *   var offsets   (varCount + 1) x uint32_t into var data for each DCGM_FT_STRING and DCGM_FT_BINARY row
+ *   var data      varBytes bytes
+ */
+typedef struct
+{
+    std::uint32_t magic;        //!< DCGM_FV_COLUMNS_MAGIC
+    std::uint16_t version;      //!< DCGM_FV_COLUMNS_VERSION
+    std::uint16_t flags;        //!< Mask of DCGM_FV_COLUMNS_FLAG_?
+    std::uint32_t rowCount;     //!< Number of field values
+    std::uint32_t entityCount;  //!< Number of entries in the entity table
+    std::uint32_t fieldCount;   //!< Number of entries in the field table
+    std::uint32_t invalidCount; //!< Number of rows whose status isn't DCGM_ST_OK
+    std::uint32_t varBytes;     //!< Size of the var data section
+    std::uint32_t reserved;     //!< Set to 0
+} dcgm_fv_columns_header_t;
+
+typedef struct
+{
+    std::uint32_t entityGroupId; //!< dcgm_field_entity_group_t
+    std::uint32_t entityId;      //!< dcgm_field_eid_t
+} dcgm_fv_columns_entity_t;
+
+typedef struct
+{
+    std::uint16_t fieldId;  //!< One of DCGM_FI_?
+    std::uint8_t fieldType; //!< One of DCGM_FT_?, as buffered by DcgmFvBuffer. Shared by every row of this field
+    std::uint8_t reserved;  //!< Set to 0
+} dcgm_fv_columns_field_t;
+
+typedef struct
+{
+    std::uint16_t entityIndex; //!< Index into the entity table
+    std::uint16_t fieldIndex;  //!< Index into the field table
+} dcgm_fv_columns_row_key_t;
+
+/*****************************************************************************/
+/*
+ * DcgmFvColumns is a compact, read-only alternative to a serialized
+ * DcgmFvBuffer for bulk value responses. Entities and fields are sent once
+ * and each value is stored in a column of its type, so an int64 value costs
+ * 8 bytes plus its timestamp instead of a whole dcgmBufferedFv_t.
+ *
+ * Use Encode() on the host engine and SetFromBuffer() on the client.
+ *
+ * This class is not thread safe.
+ */
+class DcgmFvColumns
+{
+public:
+    /*************************************************************************/
+    /*
+     * Encode every FV in fvBuffer as a columnar payload into bytes
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NOT_SUPPORTED if fvBuffer can't be represented in columns,
+     *                               like a field that has values of two types.
+     *                               Send the fvBuffer as-is in this case
+     */
+    static dcgmReturn_t Encode(DcgmFvBuffer &fvBuffer, std::vector<char> &bytes);
+
+    /*************************************************************************/
+    /*
+     * Returns whether buffer starts with a columnar payload rather than a
+     * serialized DcgmFvBuffer
+     */
+    static bool IsColumnar(const char *buffer, size_t bufferSize);
+
+    /*************************************************************************/
+    /*
+     * Set the contents of this object from a columnar payload. A serialized
+     * DcgmFvBuffer is also accepted so that clients work with host engines
+     * that don't send columns. The buffer is copied.
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if buffer isn't a well-formed payload
+     *         DCGM_ST_VER_MISMATCH if the payload version isn't supported
+     */
+    dcgmReturn_t SetFromBuffer(const char *buffer, size_t bufferSize);
+
+    /*************************************************************************/
+    /* Number of field values */
+    size_t GetRowCount() const
+    {
+        return m_rows.size();
+    }
+
+    /*************************************************************************/
+    /*
+     * Convert the field value at index row to a FV version 2
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if row is out of range
+     */
+    dcgmReturn_t ConvertRowToFv2(size_t row, dcgmFieldValue_v2 *fv2) const;
+
+    /*************************************************************************/
+    /* Forget the current contents */
+    void Clear();
+
+private:
+    struct Row
+    {
+        std::uint16_t entityIndex;
+        std::uint16_t fieldIndex;
+        std::int8_t status;
+        std::uint32_t valueIndex; /* Into m_numbers or m_varOffsets depending on the field type */
+    };
+
+    std::vector<char> m_bytes; /* Copy of the payload the members below point into */
+    dcgm_fv_columns_entity_t const *m_entities = nullptr;
+    dcgm_fv_columns_field_t const *m_fields    = nullptr;
+    std::int64_t const *m_timestamps           = nullptr;
+    std::int64_t const *m_numbers              = nullptr; /* Reinterpret as double for DCGM_FT_DOUBLE */
+    std::uint32_t const *m_varOffsets          = nullptr;
+    char const *m_varData                      = nullptr;
+    std::vector<Row> m_rows;
+};
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFvStreamRequest.h"
+#include "DcgmFvBuffer.h"
+#include "DcgmLogging.h"
+#include "DcgmProtocol.h"
+
+#include <vector>
+
+/*****************************************************************************/
+DcgmFvStreamRequest::DcgmFvStreamRequest(dcgmFieldValueEntityEnumeration_f callback, void *userData)
+    : DcgmRequest(0)
+    , m_callback(callback)
+    , m_userData(userData)
+{}
+
+/*****************************************************************************/
+int DcgmFvStreamRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
+{
+    if (!msg)
+        return DCGM_ST_BADPARAM;
+
+    dcgm_message_header_t *header = msg->GetMessageHdr();
+
+    if (header->msgType != DCGM_MSG_FV_NOTIFY)
+    {
+        Lock();
+        /* The first response is the core module confirming the subscription */
+        if (!m_isAckRecvd)
+        {
+            m_status     = DCGM_ST_OK;
+            m_isAckRecvd = true;
+            m_messages.push_back(std::move(msg));
+        }
+        else
+        {
+            log_error("Ignoring unexpected msgType {} for field value stream", header->msgType);
+        }
+        Unlock();
+        return DCGM_ST_OK;
+    }
+
+    auto msgBytes = msg->GetMsgBytesPtr();
+    DcgmFvBuffer fvBuffer(0);
+
+    if (msgBytes->empty() || fvBuffer.SetFromBuffer(msgBytes->data(), msgBytes->size()) != DCGM_ST_OK)
+    {
+        log_error("Got a corrupt field value notification of {} bytes", msgBytes->size());
+        return DCGM_ST_OK; /* Returning an error here doesn't affect anything we want to affect */
+    }
+
+    /* Hand each run of values of the same entity to the callback at once */
+    std::vector<dcgmFieldValue_v1> values;
+    dcgm_field_entity_group_t entityGroupId = DCGM_FE_NONE;
+    dcgm_field_eid_t entityId               = 0;
+    bool stopped                            = false;
+
+    auto flushValues = [&]() {
+        if (values.empty() || stopped)
+        {
+            return;
+        }
+
+        if (m_callback(entityGroupId, entityId, values.data(), values.size(), m_userData) != 0)
+        {
+            /* The user only wants to stop for this notification */
+            stopped = true;
+        }
+        values.clear();
+    };
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        if (!values.empty() && (fv->entityGroupId != entityGroupId || fv->entityId != entityId))
+        {
+            flushValues();
+        }
+
+        entityGroupId = (dcgm_field_entity_group_t)fv->entityGroupId;
+        entityId      = fv->entityId;
+        values.emplace_back();
+        DcgmFvBuffer::ConvertBufferedFvToFv1(fv, &values.back());
+    }
+
+    flushValues();
+    return DCGM_ST_OK;
+}
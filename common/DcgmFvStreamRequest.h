@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DCGMFVSTREAMREQUEST_H
+#define DCGMFVSTREAMREQUEST_H
+
+#include "DcgmRequest.h"
+#include "dcgm_structs.h"
+
+/*****************************************************************************/
+/*
+ * Client side of a field value subscription. Its first response is the ack of
+ * the subscribe request. Every DCGM_MSG_FV_NOTIFY after that is handed to the
+ * callback one entity at a time.
+ */
+class DcgmFvStreamRequest : public DcgmRequest
+{
+public:
+    DcgmFvStreamRequest(dcgmFieldValueEntityEnumeration_f callback, void *userData);
+    ~DcgmFvStreamRequest() override = default;
+    int ProcessMessage(std::unique_ptr<DcgmMessage> msg) override;
+
+private:
+    bool m_isAckRecvd = false;
+    dcgmFieldValueEntityEnumeration_f m_callback;
+    void *m_userData;
+};
+
+#endif /* DCGMFVSTREAMREQUEST_H */
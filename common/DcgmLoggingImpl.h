@@ -16,6 +16,7 @@
 #pragma once
 
 // This tells plog to store file information in log records
+#include "DcgmAsyncLogAppender.h"
 #include "DcgmLogging.h"
 #include "dcgm_errors.h"
 
@@ -33,6 +34,7 @@
 
 #include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <dcgm_structs.h>
 #include <dcgm_structs_internal.h>
 #include <iomanip>
@@ -459,6 +461,17 @@ private:
         {
             appender = &consoleAppender;
         }
+        else if (std::size_t const asyncQueueDepth = GetEnvValue(DCGM_LOGGING_ENV_ASYNC_QUEUE_DEPTH, 0);
+                 asyncQueueDepth > 0)
+        {
+            // Records are formatted on the logging thread and written to the file on a background thread
+            using namespace DcgmNs::Logging;
+            appender = new AsyncLogAppender<DcgmLogFormatter<PlogSeverityMapper>>(
+                std::make_unique<plog::RollingFileAppender<PreformattedLogFormatter>>(logFile),
+                asyncQueueDepth,
+                GetEnvValue(DCGM_LOGGING_ENV_RATE_LIMIT, DCGM_LOGGING_DEFAULT_RATE_LIMIT));
+            m_appenders.push_back(std::unique_ptr<plog::IAppender>(appender));
+        }
         else
         {
             appender = new plog::RollingFileAppender<DcgmLogFormatter<PlogSeverityMapper>>(logFile);
@@ -468,6 +481,16 @@ private:
         plog::init<logger>(severity, appender);
         return 0;
     }
+
+    static unsigned int GetEnvValue(const char *envName, unsigned int defaultValue)
+    {
+        const char *envStr = std::getenv(envName);
+        if (envStr == nullptr || envStr[0] == '\0')
+        {
+            return defaultValue;
+        }
+        return (unsigned int)strtoul(envStr, nullptr, 10);
+    }
 };
 
 // Whenever BASE severity is changed, we also want to change FILE severity
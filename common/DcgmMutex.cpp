@@ -17,9 +17,69 @@
 #include "DcgmLogging.h"
 #include "timelib.h"
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <chrono>
+#include <cstdlib>
+#include <map>
 #include <ratio>
+#include <utility>
+
+/* Lock statistics of a profiled mutex */
+struct DcgmMutexProfile
+{
+    std::string name;
+    std::mutex mutex; /* Protects sites. Shared lockers record concurrently */
+    std::map<std::pair<const char *, int>, dcgm_mutex_site_profile_t> sites;
+};
+
+namespace
+{
+/* A mutex this thread holds shared. Threads rarely hold more than one or two at once */
+struct SharedHold
+{
+    DcgmMutex const *mutex;
+    const char *file;
+    int line;
+    int depth; /* Number of LockShared() calls not unlocked yet */
+    std::chrono::steady_clock::time_point lockedAt;
+};
+
+constexpr int c_maxSharedHolds = 8;
+thread_local SharedHold t_sharedHolds[c_maxSharedHolds];
+thread_local int t_numSharedHolds = 0;
+
+SharedHold *FindSharedHold(DcgmMutex const *mutex)
+{
+    for (int i = 0; i < t_numSharedHolds; i++)
+    {
+        if (t_sharedHolds[i].mutex == mutex)
+        {
+            return &t_sharedHolds[i];
+        }
+    }
+    return nullptr;
+}
+
+/* Every profiled mutex of the process */
+std::mutex g_profiledMutexesLock;
+std::vector<DcgmMutex *> g_profiledMutexes;
+
+unsigned int HistogramBucket(long long usec)
+{
+    if (usec <= 0)
+    {
+        return 0;
+    }
+    return std::min<unsigned int>(DCGM_MUTEX_HIST_BUCKETS - 1, std::bit_width((unsigned long long)usec));
+}
+
+long long UsecSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
 
 /*****************************************************************************/
 DcgmMutex::DcgmMutex(int timeoutMs)
@@ -28,6 +88,9 @@ DcgmMutex::DcgmMutex(int timeoutMs)
     , m_handleInit(1)
     , m_debugLogging(false)
     , m_lockCount(0)
+    , m_contendedCount(0)
+    , m_contendedWaitUsec(0)
+    , m_sharedCount(0)
     , m_mutex()
     , m_locker()
 {
@@ -53,6 +116,12 @@ DcgmMutex::~DcgmMutex()
 
     m_handleInit = 0;
 
+    if (m_profile)
+    {
+        std::lock_guard<std::mutex> guard(g_profiledMutexesLock);
+        std::erase(g_profiledMutexes, this);
+    }
+
     if (m_debugLogging)
     {
         DCGM_LOG_DEBUG << "Mutex " << std::hex << (void *)this << " destroyed";
@@ -94,6 +163,11 @@ dcgmMutexReturn_t DcgmMutex::Unlock(const char *file, int line)
         return DCGM_MUTEX_ST_LOCKEDBYOTHER;
     }
 
+    if (m_profile)
+    {
+        RecordSite(m_locker.file, m_locker.line, false, -1, UsecSince(m_lockedAt));
+    }
+
     /* Clear locker info */
     m_locker = dcgm_mutex_locker_t {};
 
@@ -110,9 +184,9 @@ dcgmMutexReturn_t DcgmMutex::Unlock(const char *file, int line)
 /*****************************************************************************/
 dcgmMutexReturn_t DcgmMutex::Lock(int complainMe, const char *file, int line)
 {
-    // When acquiring the lock with a timeout, sleep for 100 microseconds between attempts to lock
     std::thread::id myTid   = std::this_thread::get_id();
     dcgmMutexReturn_t retSt = DCGM_MUTEX_ST_OK;
+    long long waitUsec      = 0;
     timelib64_t diff;
 
     if (m_locker.ownerTid == myTid)
@@ -124,40 +198,14 @@ dcgmMutexReturn_t DcgmMutex::Lock(int complainMe, const char *file, int line)
         return DCGM_MUTEX_ST_LOCKEDBYME;
     }
 
-    /* Try and get the lock */
-    if (!m_timeoutUsec)
+    if (FindSharedHold(this) != nullptr)
     {
-        m_mutex.lock();
-
-        /* Got lock */
-        retSt = DCGM_MUTEX_ST_OK;
+        /* Waiting for the shared lockers to leave would wait for ourselves */
+        log_error("{}[{}] can't lock mutex {} exclusively while holding it shared", file, line, (void *)this);
+        return DCGM_MUTEX_ST_ERROR;
     }
-    else
-    {
-        std::chrono::microseconds timeout(m_timeoutUsec);
-        auto end    = std::chrono::steady_clock::now() + timeout;
-        bool locked = false;
 
-        while (!locked && std::chrono::steady_clock::now() <= end)
-        {
-            locked = m_mutex.try_lock();
-            if (!locked)
-            {
-                std::this_thread::yield();
-            }
-        }
-
-        if (!locked)
-        {
-            // Couldn't acquire the lock during the timeout
-            retSt = DCGM_MUTEX_ST_TIMEOUT;
-        }
-        else
-        {
-            // Lock acquired
-            retSt = DCGM_MUTEX_ST_OK;
-        }
-    }
+    retSt = Acquire(true, waitUsec);
 
     /* Handle the mutex statuses */
     switch (retSt)
@@ -196,6 +244,11 @@ dcgmMutexReturn_t DcgmMutex::Lock(int complainMe, const char *file, int line)
     {
         m_locker.whenLockedUsec = timelib_usecSince1970();
     }
+    if (m_profile)
+    {
+        m_lockedAt = std::chrono::steady_clock::now();
+        RecordSite(file, line, false, waitUsec, -1);
+    }
 
     if (m_debugLogging)
     {
@@ -210,12 +263,221 @@ dcgmMutexReturn_t DcgmMutex::Lock(int complainMe, const char *file, int line)
     return DCGM_MUTEX_ST_OK;
 }
 
+/*****************************************************************************/
+dcgmMutexReturn_t DcgmMutex::Acquire(bool exclusive, long long &waitUsec)
+{
+    bool locked = m_mutex.try_lock();
+    if (locked && (!exclusive || m_sharedCount.load(std::memory_order_acquire) == 0))
+    {
+        return DCGM_MUTEX_ST_OK;
+    }
+
+    /* Someone else owns the lock or shares it. Track how long we wait for it */
+    auto waitStart = std::chrono::steady_clock::now();
+
+    if (!m_timeoutUsec)
+    {
+        if (!locked)
+        {
+            m_mutex.lock();
+            locked = true;
+        }
+
+        /* New shared lockers need m_mutex, which we now hold. Wait for the current ones to leave */
+        while (exclusive && m_sharedCount.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    else
+    {
+        auto end = waitStart + std::chrono::microseconds(m_timeoutUsec);
+
+        while (!locked && std::chrono::steady_clock::now() <= end)
+        {
+            std::this_thread::yield();
+            locked = m_mutex.try_lock();
+        }
+
+        while (locked && exclusive && m_sharedCount.load(std::memory_order_acquire) != 0)
+        {
+            if (std::chrono::steady_clock::now() > end)
+            {
+                m_mutex.unlock();
+                locked = false;
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    waitUsec = RecordContention(waitStart);
+
+    // Couldn't acquire the lock during the timeout otherwise
+    return locked ? DCGM_MUTEX_ST_OK : DCGM_MUTEX_ST_TIMEOUT;
+}
+
+/*****************************************************************************/
+dcgmMutexReturn_t DcgmMutex::LockShared(const char *file, int line)
+{
+    if (m_locker.ownerTid == std::this_thread::get_id())
+    {
+        return DCGM_MUTEX_ST_LOCKEDBYME;
+    }
+
+    SharedHold *hold = FindSharedHold(this);
+    if (hold != nullptr)
+    {
+        /* Don't touch m_mutex. A waiting exclusive locker holds it and waits for us */
+        hold->depth++;
+        return DCGM_MUTEX_ST_OK;
+    }
+
+    if (t_numSharedHolds == c_maxSharedHolds)
+    {
+        log_error("{}[{}] holds too many mutexes shared to lock mutex {}", file, line, (void *)this);
+        return DCGM_MUTEX_ST_ERROR;
+    }
+
+    long long waitUsec      = 0;
+    dcgmMutexReturn_t retSt = Acquire(false, waitUsec);
+    if (retSt != DCGM_MUTEX_ST_OK)
+    {
+        log_error("Shared mutex timeout by {}[{}] while owned by {}[{}]", file, line, m_locker.file, m_locker.line);
+        return retSt;
+    }
+
+    m_sharedCount.fetch_add(1, std::memory_order_relaxed);
+    m_mutex.unlock();
+    m_lockCount.fetch_add(1, std::memory_order_relaxed);
+
+    hold  = &t_sharedHolds[t_numSharedHolds++];
+    *hold = SharedHold { this, file, line, 1, {} };
+
+    if (m_profile)
+    {
+        hold->lockedAt = std::chrono::steady_clock::now();
+        RecordSite(file, line, true, waitUsec, -1);
+    }
+
+    if (m_debugLogging)
+    {
+        log_debug("Mutex {} locked shared by {}[{}]", (void *)this, file, line);
+    }
+
+    return DCGM_MUTEX_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmMutexReturn_t DcgmMutex::UnlockShared(const char *file, int line)
+{
+    SharedHold *hold = FindSharedHold(this);
+    if (hold == nullptr)
+    {
+        log_error("{}[{}] passed in a mutex it doesn't hold shared to UnlockShared", file, line);
+        return DCGM_MUTEX_ST_NOTLOCKED;
+    }
+
+    if (--hold->depth > 0)
+    {
+        return DCGM_MUTEX_ST_OK;
+    }
+
+    if (m_profile)
+    {
+        RecordSite(hold->file, hold->line, true, -1, UsecSince(hold->lockedAt));
+    }
+
+    *hold = t_sharedHolds[--t_numSharedHolds];
+    m_sharedCount.fetch_sub(1, std::memory_order_release);
+
+    if (m_debugLogging)
+    {
+        log_debug("Mutex {} unlocked shared from {}[{}]", (void *)this, file, line);
+    }
+
+    return DCGM_MUTEX_ST_OK;
+}
+
 /*****************************************************************************/
 void DcgmMutex::EnableDebugLogging(bool enabled)
 {
     m_debugLogging = enabled;
 }
 
+/*****************************************************************************/
+void DcgmMutex::EnableProfiling(const char *name)
+{
+    if (m_profile)
+    {
+        return;
+    }
+
+    m_profile       = std::make_unique<DcgmMutexProfile>();
+    m_profile->name = name;
+
+    std::lock_guard<std::mutex> guard(g_profiledMutexesLock);
+    g_profiledMutexes.push_back(this);
+}
+
+/*****************************************************************************/
+bool DcgmMutex::ProfilingRequested()
+{
+    const char *envStr = getenv(DCGM_MUTEX_PROFILING_ENV);
+    return envStr != nullptr && envStr[0] == '1';
+}
+
+/*****************************************************************************/
+std::vector<dcgm_mutex_site_profile_t> DcgmMutex::GetProfiles()
+{
+    std::vector<dcgm_mutex_site_profile_t> profiles;
+
+    {
+        std::lock_guard<std::mutex> guard(g_profiledMutexesLock);
+
+        for (DcgmMutex *mutex : g_profiledMutexes)
+        {
+            std::lock_guard<std::mutex> profileGuard(mutex->m_profile->mutex);
+            for (auto const &[key, site] : mutex->m_profile->sites)
+            {
+                profiles.push_back(site);
+            }
+        }
+    }
+
+    std::sort(profiles.begin(), profiles.end(), [](auto const &a, auto const &b) { return a.waitUsec > b.waitUsec; });
+    return profiles;
+}
+
+/*****************************************************************************/
+void DcgmMutex::RecordSite(const char *file, int line, bool shared, long long waitUsec, long long holdUsec)
+{
+    std::lock_guard<std::mutex> guard(m_profile->mutex);
+
+    dcgm_mutex_site_profile_t &site = m_profile->sites[{ file, line }];
+    if (site.file == nullptr)
+    {
+        site.mutexName = m_profile->name;
+        site.file      = file;
+        site.line      = line;
+    }
+
+    if (waitUsec >= 0)
+    {
+        (shared ? site.sharedLockCount : site.lockCount)++;
+        site.waitUsec += waitUsec;
+        site.maxWaitUsec = std::max(site.maxWaitUsec, waitUsec);
+        site.waitHistogram[HistogramBucket(waitUsec)]++;
+    }
+
+    if (holdUsec >= 0)
+    {
+        site.holdUsec += holdUsec;
+        site.maxHoldUsec = std::max(site.maxHoldUsec, holdUsec);
+        site.holdHistogram[HistogramBucket(holdUsec)]++;
+    }
+}
+
 /*****************************************************************************/
 dcgmMutexReturn_t DcgmMutex::CondWait(std::condition_variable &cv,
                                       unsigned int timeoutMs,
@@ -237,6 +499,12 @@ dcgmMutexReturn_t DcgmMutex::CondWait(std::condition_variable &cv,
     // adopt_lock tells unique_lock we don't want to take ownership of the lock locally
     std::unique_lock<std::mutex> lock(m_mutex, std::adopt_lock);
 
+    /* Waiting isn't holding. Close the hold before wait_for unlocks the mutex */
+    if (m_profile)
+    {
+        RecordSite(m_locker.file, m_locker.line, false, -1, UsecSince(m_lockedAt));
+    }
+
     /* Back up the owner and clear it since wait_for will unlock the mutex */
     backupLocker      = m_locker;
     m_locker          = dcgm_mutex_locker_t {};
@@ -273,6 +541,13 @@ dcgmMutexReturn_t DcgmMutex::CondWait(std::condition_variable &cv,
 
     lock.release(); // Instruct unique_lock to not release the mutex at the end of the function
 
+    /* Shared lockers may have come in while the mutex was unlocked. Wait for them to leave */
+    while (m_sharedCount.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::yield();
+    }
+    m_lockedAt = std::chrono::steady_clock::now();
+
     /* We now have the lock again. Restore the locker info */
     m_locker = backupLocker;
 
@@ -291,3 +566,24 @@ long long DcgmMutex::GetLockCount(void)
 }
 
 /*****************************************************************************/
+long long DcgmMutex::GetContendedCount(void)
+{
+    return m_contendedCount.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+long long DcgmMutex::GetContendedWaitUsec(void)
+{
+    return m_contendedWaitUsec.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+long long DcgmMutex::RecordContention(std::chrono::steady_clock::time_point waitStart)
+{
+    long long waitedUsec = UsecSince(waitStart);
+    m_contendedCount.fetch_add(1, std::memory_order_relaxed);
+    m_contendedWaitUsec.fetch_add(waitedUsec, std::memory_order_relaxed);
+    return waitedUsec;
+}
+
+/*****************************************************************************/
@@ -17,10 +17,14 @@
 #define DCGMMUTEX_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 /* API Status codes */
 typedef enum dcgmMutexSt
@@ -51,8 +55,37 @@ struct dcgm_mutex_locker_t
 };
 using dcgm_mutex_locker_p = dcgm_mutex_locker_t *;
 
+/* Number of buckets of the wait and hold time histograms of a profiled DcgmMutex. Bucket 0 counts times under
+   1 usec, bucket i times in [2^(i-1), 2^i) usec and the last bucket everything longer */
+#define DCGM_MUTEX_HIST_BUCKETS 16
 
-/* DcgmMutex class. Instantiate this class to get a mutex */
+/* Set __DCGM_MUTEX_PROFILING__=1 to profile the mutexes that call EnableProfiling() if ProfilingRequested() */
+#define DCGM_MUTEX_PROFILING_ENV "__DCGM_MUTEX_PROFILING__"
+
+/* Lock statistics of one place (file and line) that locks a profiled DcgmMutex */
+struct dcgm_mutex_site_profile_t
+{
+    std::string mutexName;                            /* Name passed to EnableProfiling() */
+    const char *file;                                 /* __FILE__ of the locker */
+    int line;                                         /* __LINE__ of the locker */
+    long long lockCount;                              /* Exclusive locks from here */
+    long long sharedLockCount;                        /* Shared locks from here */
+    long long waitUsec;                               /* Total usec spent waiting to acquire the mutex */
+    long long holdUsec;                               /* Total usec the mutex was held for */
+    long long maxWaitUsec;                            /* Longest wait */
+    long long maxHoldUsec;                            /* Longest hold */
+    long long waitHistogram[DCGM_MUTEX_HIST_BUCKETS]; /* Waits by duration. See DCGM_MUTEX_HIST_BUCKETS */
+    long long holdHistogram[DCGM_MUTEX_HIST_BUCKETS]; /* Holds by duration */
+};
+
+struct DcgmMutexProfile;
+
+
+/* DcgmMutex class. Instantiate this class to get a mutex
+ *
+ * The mutex can be locked exclusively with Lock() or shared with LockShared(). Any number of threads can hold
+ * it shared at once. A thread that waits for it exclusively keeps new shared lockers out, so writers don't starve.
+ */
 class DcgmMutex
 {
 public:
@@ -108,6 +141,41 @@ public:
 
 #define dcgm_mutex_unlock(m) (m)->Unlock(__FILE__, __LINE__)
 
+    /*************************************************************************/
+    /**
+     * Lock this mutex shared, for code that only reads what it protects
+     *
+     * A thread that holds the mutex shared can lock it shared again. It can't
+     * lock it exclusively without unlocking it first.
+     *
+     * file        IN: Should be __FILE__ or some other heap-allocated pointer to
+     *                 a source code line.
+     * line        IN: Should be __LINE__
+     *
+     * RETURNS: DCGM_MUTEX_ST_OK if OK. Call UnlockShared() when done
+     *          DCGM_MUTEX_ST_LOCKEDBYME if my thread holds the mutex exclusively.
+     *                                   Don't call UnlockShared() in that case
+     *          DCGM_MUTEX_ST_? enum on error
+     */
+    dcgmMutexReturn_t LockShared(const char *file, int line);
+
+#define dcgm_mutex_lock_shared(m) (m)->LockShared(__FILE__, __LINE__)
+
+    /*************************************************************************/
+    /**
+     * Unlock a mutex that was locked with LockShared()
+     *
+     * file IN: Should be __FILE__ or some other heap-allocated pointer to
+     *          a source code line.
+     * line IN: Should be __LINE__
+     *
+     *   RETURNS: 0 if OK
+     *            DCGM_MUTEX_ST_NOTLOCKED if my thread doesn't hold the mutex shared
+     */
+    dcgmMutexReturn_t UnlockShared(const char *file, int line);
+
+#define dcgm_mutex_unlock_shared(m) (m)->UnlockShared(__FILE__, __LINE__)
+
     /*************************************************************************/
     /*
      * Query the current state of this mutex
@@ -124,6 +192,26 @@ public:
      */
     void EnableDebugLogging(bool enabled);
 
+    /*************************************************************************/
+    /* Record wait and hold time histograms of this mutex for each place that
+     * locks it. See GetProfiles()
+     *
+     * Call this before the mutex is shared between threads
+     *
+     * name IN: Name of the mutex in the profiles
+     */
+    void EnableProfiling(const char *name);
+
+    /*************************************************************************/
+    /* Returns whether DCGM_MUTEX_PROFILING_ENV asks for mutexes to be profiled */
+    static bool ProfilingRequested();
+
+    /*************************************************************************/
+    /* Get the lock statistics of every profiled mutex of the process, one entry
+     * per place that locked it, ordered by total wait time. Longest first.
+     */
+    static std::vector<dcgm_mutex_site_profile_t> GetProfiles();
+
     /*************************************************************************/
     /* Wait on a condition variable using this mutex as the underlying mutex
      *
@@ -152,7 +240,48 @@ public:
      */
     long long GetLockCount(void);
 
+    /*************************************************************************/
+    /*
+     * Get the number of times a Lock() call found this mutex already owned by
+     * another thread and had to wait for it. Recursive locks are not counted.
+     *
+     * RETURNS: Number of contended locks of this mutex.
+     */
+    long long GetContendedCount(void);
+
+    /*************************************************************************/
+    /*
+     * Get the total time in usec that contended Lock() calls spent waiting
+     * to acquire this mutex.
+     *
+     * RETURNS: Cumulative wait time in usec.
+     */
+    long long GetContendedWaitUsec(void);
+
 private:
+    /*************************************************************************/
+    /*
+     * Account for a Lock() call that had to wait since waitStart
+     */
+    long long RecordContention(std::chrono::steady_clock::time_point waitStart);
+
+    /*************************************************************************/
+    /*
+     * Acquire m_mutex, honoring m_timeoutUsec. If exclusive, also wait for the
+     * shared lockers to leave. waitUsec is set to how long that took if the
+     * mutex was contended
+     *
+     * RETURNS: DCGM_MUTEX_ST_OK or DCGM_MUTEX_ST_TIMEOUT
+     */
+    dcgmMutexReturn_t Acquire(bool exclusive, long long &waitUsec);
+
+    /*************************************************************************/
+    /*
+     * Add a lock from file:line that waited waitUsec, or an unlock after holding
+     * the mutex holdUsec, to the profile. Pass -1 for the one that doesn't apply
+     */
+    void RecordSite(const char *file, int line, bool shared, long long waitUsec, long long holdUsec);
+
     /*************************************************************************/
 
     /* OS Handle to the mutex */
@@ -160,8 +289,16 @@ private:
     int m_handleInit;              /* Is handle/critSec is initialized? */
     bool m_debugLogging;           /* Should we log verbose debug logs? true=yes */
     std::atomic_llong m_lockCount; /* Number of times this mutex has been locked. This doesn't count recursive locks */
+
+    std::atomic_llong m_contendedCount;    /* Number of locks that had to wait for another owner */
+    std::atomic_llong m_contendedWaitUsec; /* Total usec spent waiting in contended locks */
+    std::atomic_int m_sharedCount;         /* Number of threads that hold this mutex shared. Only incremented
+                                              while holding m_mutex */
     std::mutex m_mutex;
 
+    std::unique_ptr<DcgmMutexProfile> m_profile;      /* Set by EnableProfiling(). Null = not profiled */
+    std::chrono::steady_clock::time_point m_lockedAt; /* When the exclusive lock was taken. Only set if profiled */
+
     dcgm_mutex_locker_t m_locker; /* Information about the locker of this mutex */
 
     /*************************************************************************/
@@ -225,4 +362,31 @@ private:
     dcgmMutexReturn_t m_mutexReturn;
 };
 
+/**
+ * RAII style shared locking of a DcgmMutex. Non-copyable.
+ */
+class [[nodiscard]] DcgmSharedLockGuard
+{
+public:
+    explicit DcgmSharedLockGuard(DcgmMutex *mutex) noexcept
+        : m_mutex(mutex)
+    {
+        /* DCGM_MUTEX_ST_LOCKEDBYME if this thread holds the mutex exclusively. The destructor leaves it be */
+        m_mutexReturn = dcgm_mutex_lock_shared(m_mutex);
+    }
+
+    ~DcgmSharedLockGuard() noexcept
+    {
+        if (m_mutexReturn == DCGM_MUTEX_ST_OK)
+            dcgm_mutex_unlock_shared(m_mutex);
+    }
+
+    DcgmSharedLockGuard &operator=(DcgmSharedLockGuard const &) = delete;
+    DcgmSharedLockGuard(DcgmSharedLockGuard const &)            = delete;
+
+private:
+    DcgmMutex *m_mutex;
+    dcgmMutexReturn_t m_mutexReturn;
+};
+
 #endif // DCGMMUTEX_H
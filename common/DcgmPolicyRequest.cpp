@@ -22,8 +22,10 @@
 #include "DcgmSettings.h"
 #include "dcgm_structs.h"
 
+#include <cstddef>
+
 /*****************************************************************************/
-DcgmPolicyRequest::DcgmPolicyRequest(fpRecvUpdates callback, uint64_t userData, std::mutex &cbMutex)
+DcgmPolicyRequest::DcgmPolicyRequest(fpRecvUpdates callback, uint64_t userData, std::shared_mutex &cbMutex)
     : DcgmRequest(0)
     , mCbMutex(cbMutex)
 {
@@ -66,6 +68,7 @@ int DcgmPolicyRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
             return DCGM_ST_OK;
 
         case DCGM_MSG_POLICY_NOTIFY:
+        case DCGM_MSG_POLICY_NOTIFY_BATCH:
             break; /* Code handled below */
 
         default:
@@ -75,8 +78,36 @@ int DcgmPolicyRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
     }
 
     /* We should only be here if we got a policy notification */
-    auto msgBytes                    = msg->GetMsgBytesPtr();
-    dcgm_msg_policy_notify_t *policy = (dcgm_msg_policy_notify_t *)msgBytes->data();
+    auto msgBytes                           = msg->GetMsgBytesPtr();
+    dcgmPolicyCallbackResponse_t *responses = nullptr;
+    unsigned int numResponses               = 0;
+
+    if (header->msgType == DCGM_MSG_POLICY_NOTIFY)
+    {
+        responses    = &((dcgm_msg_policy_notify_t *)msgBytes->data())->response;
+        numResponses = 1;
+    }
+    else
+    {
+        auto *batch = (dcgm_msg_policy_notify_batch_t *)msgBytes->data();
+        if (msgBytes->size() < offsetof(dcgm_msg_policy_notify_batch_t, responses)
+            || batch->numResponses > DCGM_MSG_POLICY_NOTIFY_BATCH_MAX
+            || msgBytes->size() < offsetof(dcgm_msg_policy_notify_batch_t, responses)
+                                      + batch->numResponses * sizeof(batch->responses[0]))
+        {
+            log_error("Ignoring truncated policy notification batch of {} bytes", msgBytes->size());
+            Unlock();
+            return DCGM_ST_OK;
+        }
+
+        if (batch->numDropped > 0)
+        {
+            log_warning("The host engine dropped {} policy violations to stay within the rate limit",
+                        batch->numDropped);
+        }
+        responses    = batch->responses;
+        numResponses = batch->numResponses;
+    }
 
     /* Make local copies of the callback so we can safely unlock. I don't want this code to deadlock if someone
        removes this object from one of the callbacks */
@@ -84,15 +115,17 @@ int DcgmPolicyRequest::ProcessMessage(std::unique_ptr<DcgmMessage> msg)
 
     Unlock();
 
-    /* Grab a callback mutex to prevent users from unregistering callback while we are handling them. */
-    std::lock_guard<std::mutex> guard(mCbMutex);
+    /* Grab the callback mutex to prevent users from unregistering callback while we are handling them.
+       Shared, so that the callbacks of other registrations can run at the same time. A batch is handled under
+       one hold of it */
+    std::shared_lock<std::shared_mutex> guard(mCbMutex);
 
     /* Call the callback if it is present */
-    if (callback)
+    for (unsigned int i = 0; callback && i < numResponses; i++)
     {
         try
         {
-            callback(&policy->response, mUserData);
+            callback(&responses[i], mUserData);
         }
         catch (std::exception const &e)
         {
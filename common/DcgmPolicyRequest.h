@@ -19,11 +19,12 @@
 #include "DcgmRequest.h"
 #include "dcgm_structs.h"
 #include <iostream>
+#include <shared_mutex>
 
 class DcgmPolicyRequest : public DcgmRequest
 {
 public:
-    DcgmPolicyRequest(fpRecvUpdates callback, uint64_t userData, std::mutex &cbMutex);
+    DcgmPolicyRequest(fpRecvUpdates callback, uint64_t userData, std::shared_mutex &cbMutex);
     virtual ~DcgmPolicyRequest();
     int ProcessMessage(std::unique_ptr<DcgmMessage> msg) override;
 
@@ -31,7 +32,7 @@ private:
     bool mIsAckRecvd;
     fpRecvUpdates mCallback;
     uint64_t mUserData;
-    std::mutex &mCbMutex;
+    std::shared_mutex &mCbMutex;
 };
 
 #endif /* DCGMPOLICYREQUEST_H */
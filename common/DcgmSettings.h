@@ -30,6 +30,13 @@
 /* Environmental variable to bypass the allow list */
 #define DCGM_ENV_WL_BYPASS "__DCGM_WL_BYPASS"
 
+/* Environmental variable with the budget in MB for the samples cached by the host engine. Unset or 0 = unlimited */
+#define DCGM_ENV_CACHE_MEMORY_BUDGET_MB "__DCGM_CACHE_MEMORY_BUDGET_MB__"
+
+/* Environmental variable that makes the host engine attach the GPUs in the background when set to 1, so that it can
+   accept connections right away. Requests that need the GPUs are queued until they are attached */
+#define DCGM_ENV_BACKGROUND_INIT "__DCGM_BACKGROUND_INIT__"
+
 #define DCGM_MODE_EMBEDDED_HE   0 /* Mode when Host Engine is Embedded. ISV Agent Use Case */
 #define DCGM_MODE_STANDALONE_HE 1 /* Mode when Host Engine is Standalone. NV Agent Use Case */
 
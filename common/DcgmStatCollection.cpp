@@ -33,6 +33,7 @@ static std::string g_entityJsonTags[SC_ENTITY_GROUP_COUNT] = { "gpus", "switches
 DcgmStatCollection::DcgmStatCollection()
     : m_globalCollection(0)
     , m_switchOutput(true)
+    , m_globalValues { 0, {} }
 {
     int st;
 
@@ -45,6 +46,7 @@ DcgmStatCollection::DcgmStatCollection()
 DcgmStatCollection::DcgmStatCollection(bool switchOutput)
     : m_globalCollection(0)
     , m_switchOutput(switchOutput)
+    , m_globalValues { 0, {} }
 {
     int st;
 
@@ -114,6 +116,13 @@ void DcgmStatCollection::Empty()
         mcollect_destroy(m_globalCollection);
         m_globalCollection = 0;
     }
+
+    /* Forget the cached values. Interned keys stay valid */
+    m_globalValues.mc = 0;
+    m_globalValues.byKey.clear();
+    m_groupedValues.clear();
+    for (auto &byEntity : m_entityValues)
+        byEntity.clear();
 }
 
 /*****************************************************************************/
@@ -180,6 +189,7 @@ void DcgmStatCollection::RemoveEntity(sc_entity_group_t entityGroupId, sc_entity
     mc = it->second; /* Entity found */
     mcollect_destroy(mc);
     collection->erase(it);
+    m_entityValues[entityGroupId].erase(entityId);
 }
 
 /*****************************************************************************/
@@ -238,65 +248,6 @@ int DcgmStatCollection::CoerceAndSetFromDouble(mcollect_value_p mcValue, double
     return -1; /* Wasn't set */
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::SetGlobalStat(std::string key, double value)
-{
-    mcollect_value_p mcValue;
-    mcollect_p mc = m_globalCollection;
-
-    if (!mc)
-        return -1;
-
-    mcValue = mcollect_value_add_double(mc, (char *)key.c_str(), value);
-    if (!mcValue)
-        return -2;
-
-    return CoerceAndSetFromDouble(mcValue, value);
-}
-
-/*****************************************************************************/
-int DcgmStatCollection::SetGroupedStat(std::string group, std::string key, double value)
-{
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
-        return -1;
-
-    mcValue = mcollect_value_add_double(mc, (char *)key.c_str(), value);
-    if (!mcValue)
-        return -2;
-
-    return CoerceAndSetFromDouble(mcValue, value);
-}
-
-/*****************************************************************************/
-int DcgmStatCollection::SetGpuStat(unsigned int nvmlGpuIdx, std::string key, double value)
-{
-    return SetEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value);
-}
-
-/*****************************************************************************/
-int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
-                                      sc_entity_id_t entityId,
-                                      std::string key,
-                                      double value)
-{
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
-        return -1;
-
-    mcValue = mcollect_value_add_double(mc, (char *)key.c_str(), value);
-    if (!mcValue)
-        return -2;
-
-    return CoerceAndSetFromDouble(mcValue, value);
-}
-
 /*****************************************************************************/
 int DcgmStatCollection::CoerceAndSetFromInt64(mcollect_value_p mcValue, long long value)
 {
@@ -328,65 +279,6 @@ int DcgmStatCollection::CoerceAndSetFromInt64(mcollect_value_p mcValue, long lon
     return -1; /* Wasn't set */
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::SetGlobalStat(std::string key, long long value)
-{
-    mcollect_value_p mcValue;
-    mcollect_p mc = m_globalCollection;
-
-    if (!mc)
-        return -1;
-
-    mcValue = mcollect_value_add_int64(mc, (char *)key.c_str(), value);
-    if (!mcValue)
-        return -2;
-
-    return CoerceAndSetFromInt64(mcValue, value);
-}
-
-/*****************************************************************************/
-int DcgmStatCollection::SetGroupedStat(std::string group, std::string key, long long value)
-{
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
-        return -1;
-
-    mcValue = mcollect_value_add_int64(mc, (char *)key.c_str(), value);
-    if (!mcValue)
-        return -2;
-
-    return CoerceAndSetFromInt64(mcValue, value);
-}
-
-/*****************************************************************************/
-int DcgmStatCollection::SetGpuStat(unsigned int nvmlGpuIdx, std::string key, long long value)
-{
-    return SetEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value);
-}
-
-/*****************************************************************************/
-int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
-                                      sc_entity_id_t entityId,
-                                      std::string key,
-                                      long long value)
-{
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
-        return -1;
-
-    mcValue = mcollect_value_add_int64(mc, (char *)key.c_str(), value);
-    if (!mcValue)
-        return -2;
-
-    return CoerceAndSetFromInt64(mcValue, value);
-}
-
 /*****************************************************************************/
 int DcgmStatCollection::CoerceAndSetFromString(mcollect_value_p mcValue, std::string value)
 {
@@ -415,362 +307,512 @@ int DcgmStatCollection::CoerceAndSetFromString(mcollect_value_p mcValue, std::st
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::SetGlobalStat(std::string key, std::string value)
+sc_stat_key_t DcgmStatCollection::GetKey(std::string const &name)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = m_globalCollection;
+    auto it = m_keyIds.find(name);
+    if (it != m_keyIds.end())
+        return it->second;
 
-    if (!mc)
-        return -1;
+    sc_stat_key_t key = (sc_stat_key_t)m_keyNames.size();
+    m_keyNames.push_back(name);
+    m_keyIds.emplace(name, key);
+    return key;
+}
 
-    mcValue = mcollect_value_add_string(mc, (char *)key.c_str(), (char *)value.c_str());
-    if (!mcValue)
-        return -2;
+/*****************************************************************************/
+DcgmStatCollection::sc_key_values_t *DcgmStatCollection::GetGlobalValues()
+{
+    if (!m_globalCollection)
+        return NULL;
 
-    return CoerceAndSetFromString(mcValue, value);
+    m_globalValues.mc = m_globalCollection;
+    return &m_globalValues;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::SetGroupedStat(std::string group, std::string key, std::string value)
+DcgmStatCollection::sc_key_values_t *DcgmStatCollection::GetGroupedValues(sc_stat_key_t group)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
+    if (group >= m_keyNames.size())
+        return NULL;
 
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
-        return -1;
+    if (group >= m_groupedValues.size())
+        m_groupedValues.resize(m_keyNames.size(), { 0, {} });
 
-    mcValue = mcollect_value_add_string(mc, (char *)key.c_str(), (char *)value.c_str());
-    if (!mcValue)
-        return -2;
+    sc_key_values_t *values = &m_groupedValues[group];
+    if (!values->mc)
+    {
+        values->mc = GetOrCreateGroupedCollection(m_keyNames[group]);
+        if (!values->mc)
+            return NULL;
+    }
 
-    return CoerceAndSetFromString(mcValue, value);
+    return values;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::SetGpuStat(unsigned int nvmlGpuIdx, std::string key, std::string value)
+DcgmStatCollection::sc_key_values_t *DcgmStatCollection::GetEntityValues(sc_entity_group_t entityGroupId,
+                                                                         sc_entity_id_t entityId)
 {
-    return SetEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value);
+    if ((unsigned int)entityGroupId >= SC_ENTITY_GROUP_COUNT)
+        return NULL;
+
+    std::map<sc_entity_id_t, sc_key_values_t> &byEntity = m_entityValues[entityGroupId];
+
+    auto it = byEntity.find(entityId);
+    if (it != byEntity.end())
+        return &it->second;
+
+    mcollect_p mc = GetOrCreateEntityCollection(entityGroupId, entityId);
+    if (!mc)
+        return NULL;
+
+    sc_key_values_t *values = &byEntity[entityId];
+    values->mc              = mc;
+    return values;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
-                                      sc_entity_id_t entityId,
-                                      std::string key,
-                                      std::string value)
+mcollect_value_p DcgmStatCollection::GetOrAddValue(sc_key_values_t *values, sc_stat_key_t key, int mcType)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
+    mcollect_value_p mcValue = 0;
 
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
+    if (!values || key >= m_keyNames.size())
+        return NULL;
+
+    if (key >= values->byKey.size())
+        values->byKey.resize(m_keyNames.size(), 0);
+
+    mcValue = values->byKey[key];
+    if (!mcValue)
+    {
+        /* The mcollect_value_add_? functions return the current value if there is one */
+        char *name = (char *)m_keyNames[key].c_str();
+        switch (mcType)
+        {
+            case MC_TYPE_DOUBLE:
+                mcValue = mcollect_value_add_double(values->mc, name, 0.0);
+                break;
+            case MC_TYPE_INT64:
+                mcValue = mcollect_value_add_int64(values->mc, name, 0);
+                break;
+            case MC_TYPE_STRING:
+                mcValue = mcollect_value_add_string(values->mc, name, NULL);
+                break;
+            case MC_TYPE_TIMESERIES_DOUBLE:
+                mcValue = mcollect_value_add_timeseries_double(values->mc, name);
+                break;
+            case MC_TYPE_TIMESERIES_INT64:
+                mcValue = mcollect_value_add_timeseries_int64(values->mc, name);
+                break;
+            case MC_TYPE_TIMESERIES_STRING:
+                mcValue = mcollect_value_add_timeseries_string(values->mc, name);
+                break;
+            case MC_TYPE_TIMESERIES_BLOB:
+                mcValue = mcollect_value_add_timeseries_blob(values->mc, name);
+                break;
+            default:
+                return NULL;
+        }
+
+        if (!mcValue)
+            return NULL;
+
+        values->byKey[key] = mcValue;
+    }
+
+    /* Sets coerce to whatever type is already there. Appends can only do that between time series */
+    if (mcollect_type_is_timeseries(mcType) && !mcollect_type_is_timeseries(mcValue->type))
+    {
+        DCGM_LOG_WARNING << "Unable to append to non-time series stat " << m_keyNames[key];
+        return NULL;
+    }
+
+    return mcValue;
+}
+
+/*****************************************************************************/
+int DcgmStatCollection::SetStat(sc_key_values_t *values, sc_stat_key_t key, double value)
+{
+    if (!values)
         return -1;
 
-    mcValue = mcollect_value_add_string(mc, (char *)key.c_str(), (char *)value.c_str());
+    mcollect_value_p mcValue = GetOrAddValue(values, key, MC_TYPE_DOUBLE);
     if (!mcValue)
         return -2;
 
-    return CoerceAndSetFromString(mcValue, value);
+    return CoerceAndSetFromDouble(mcValue, value);
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
-                                      std::string key,
-                                      std::string value,
-                                      timelib64_t timestamp)
+int DcgmStatCollection::SetStat(sc_key_values_t *values, sc_stat_key_t key, long long value)
 {
-    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value, timestamp);
+    if (!values)
+        return -1;
+
+    mcollect_value_p mcValue = GetOrAddValue(values, key, MC_TYPE_INT64);
+    if (!mcValue)
+        return -2;
+
+    return CoerceAndSetFromInt64(mcValue, value);
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
-                                         sc_entity_id_t entityId,
-                                         std::string key,
-                                         std::string value,
-                                         timelib64_t timestamp)
+int DcgmStatCollection::SetStat(sc_key_values_t *values, sc_stat_key_t key, std::string const &value)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-    int st;
-
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
+    if (!values)
         return -1;
 
-    mcValue = mcollect_value_add_timeseries_string(mc, (char *)key.c_str());
+    mcollect_value_p mcValue = GetOrAddValue(values, key, MC_TYPE_STRING);
     if (!mcValue)
         return -2;
 
-    st = timeseries_insert_string(mcValue->val.tseries, timestamp, (char *)value.c_str());
-    if (st)
-        return -3;
-
-    return 0;
+    return CoerceAndSetFromString(mcValue, value);
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendGlobalStat(std::string key, std::string value, timelib64_t timestamp)
+int DcgmStatCollection::AppendStat(sc_key_values_t *values,
+                                   sc_stat_key_t key,
+                                   int mcType,
+                                   double value1,
+                                   double value2,
+                                   timelib64_t timestamp)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-    int st;
-
-    mc = m_globalCollection;
-    if (!mc)
+    if (!values)
         return -1;
 
-    mcValue = mcollect_value_add_timeseries_string(mc, (char *)key.c_str());
+    mcollect_value_p mcValue = GetOrAddValue(values, key, mcType);
     if (!mcValue)
         return -2;
 
-    st = timeseries_insert_string(mcValue->val.tseries, timestamp, (char *)value.c_str());
-    if (st)
+    if (timeseries_insert_double_coerce(mcValue->val.tseries, timestamp, value1, value2))
         return -3;
 
     return 0;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendGlobalStat(std::string key, void *value, int valueSize, timelib64_t timestamp)
+int DcgmStatCollection::AppendStat(sc_key_values_t *values,
+                                   sc_stat_key_t key,
+                                   int mcType,
+                                   long long value1,
+                                   long long value2,
+                                   timelib64_t timestamp)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-    int st;
-
-    mc = m_globalCollection;
-    if (!mc)
+    if (!values)
         return -1;
 
-    mcValue = mcollect_value_add_timeseries_blob(mc, (char *)key.c_str());
+    mcollect_value_p mcValue = GetOrAddValue(values, key, mcType);
     if (!mcValue)
         return -2;
 
-    st = timeseries_insert_blob(mcValue->val.tseries, timestamp, value, valueSize);
-    if (st)
+    if (timeseries_insert_int64_coerce(mcValue->val.tseries, timestamp, value1, value2))
         return -3;
 
     return 0;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendGroupedStat(std::string group, std::string key, std::string value, timelib64_t timestamp)
+int DcgmStatCollection::AppendStat(sc_key_values_t *values,
+                                   sc_stat_key_t key,
+                                   std::string const &value,
+                                   timelib64_t timestamp)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-    int st;
-
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
+    if (!values)
         return -1;
 
-    mcValue = mcollect_value_add_timeseries_string(mc, (char *)key.c_str());
+    mcollect_value_p mcValue = GetOrAddValue(values, key, MC_TYPE_TIMESERIES_STRING);
     if (!mcValue)
         return -2;
 
-    st = timeseries_insert_string(mcValue->val.tseries, timestamp, (char *)value.c_str());
-    if (st)
+    if (timeseries_insert_string(mcValue->val.tseries, timestamp, value.c_str()))
         return -3;
 
     return 0;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendGroupedStat(std::string group,
-                                          std::string key,
-                                          void *value,
-                                          int valueSize,
-                                          timelib64_t timestamp)
+int DcgmStatCollection::AppendStat(sc_key_values_t *values,
+                                   sc_stat_key_t key,
+                                   void *value,
+                                   int valueSize,
+                                   timelib64_t timestamp)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-    int st;
-
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
+    if (!values)
         return -1;
 
-    mcValue = mcollect_value_add_timeseries_blob(mc, (char *)key.c_str());
+    mcollect_value_p mcValue = GetOrAddValue(values, key, MC_TYPE_TIMESERIES_BLOB);
     if (!mcValue)
         return -2;
 
-    st = timeseries_insert_blob(mcValue->val.tseries, timestamp, value, valueSize);
-    if (st)
+    if (timeseries_insert_blob(mcValue->val.tseries, timestamp, value, valueSize))
         return -3;
 
     return 0;
 }
 
 /*****************************************************************************/
-int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
-                                      std::string key,
-                                      void *value,
-                                      int valueSize,
-                                      timelib64_t timestamp)
+/* Global collection */
+int DcgmStatCollection::SetGlobalStat(sc_stat_key_t key, double value)
 {
-    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value, valueSize, timestamp);
+    return SetStat(GetGlobalValues(), key, value);
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
-                                         sc_entity_id_t entityId,
-                                         std::string key,
-                                         void *value,
-                                         int valueSize,
-                                         timelib64_t timestamp)
+int DcgmStatCollection::SetGlobalStat(sc_stat_key_t key, long long value)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
-    int st;
+    return SetStat(GetGlobalValues(), key, value);
+}
 
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
-        return -1;
+int DcgmStatCollection::SetGlobalStat(sc_stat_key_t key, std::string const &value)
+{
+    return SetStat(GetGlobalValues(), key, value);
+}
 
-    mcValue = mcollect_value_add_timeseries_blob(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::AppendGlobalStat(sc_stat_key_t key, double value, timelib64_t timestamp)
+{
+    return AppendStat(GetGlobalValues(), key, MC_TYPE_TIMESERIES_DOUBLE, value, 0.0, timestamp);
+}
 
-    st = timeseries_insert_blob(mcValue->val.tseries, timestamp, value, valueSize);
-    if (st)
-        return -3;
+int DcgmStatCollection::AppendGlobalStat(sc_stat_key_t key, long long value, timelib64_t timestamp)
+{
+    return AppendStat(GetGlobalValues(), key, MC_TYPE_TIMESERIES_INT64, value, 0LL, timestamp);
+}
 
-    return 0;
+int DcgmStatCollection::AppendGlobalStat(sc_stat_key_t key, std::string const &value, timelib64_t timestamp)
+{
+    return AppendStat(GetGlobalValues(), key, value, timestamp);
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::AppendGlobalStat(std::string key, double value, timelib64_t timestamp)
+int DcgmStatCollection::AppendGlobalStat(sc_stat_key_t key, void *value, int valueSize, timelib64_t timestamp)
 {
-    mcollect_value_p mcValue;
-    mcollect_p mc = m_globalCollection;
-    int st;
+    return AppendStat(GetGlobalValues(), key, value, valueSize, timestamp);
+}
 
-    if (!mc)
-        return -1;
+int DcgmStatCollection::SetGlobalStat(std::string key, double value)
+{
+    return SetGlobalStat(GetKey(key), value);
+}
 
-    mcValue = mcollect_value_add_timeseries_double(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::SetGlobalStat(std::string key, long long value)
+{
+    return SetGlobalStat(GetKey(key), value);
+}
 
-    st = timeseries_insert_double_coerce(mcValue->val.tseries, timestamp, value, 0);
-    if (st)
-        return -3;
+int DcgmStatCollection::SetGlobalStat(std::string key, std::string value)
+{
+    return SetGlobalStat(GetKey(key), value);
+}
 
-    return 0;
+int DcgmStatCollection::AppendGlobalStat(std::string key, double value, timelib64_t timestamp)
+{
+    return AppendGlobalStat(GetKey(key), value, timestamp);
 }
 
-/*****************************************************************************/
 int DcgmStatCollection::AppendGlobalStat(std::string key, long long value, timelib64_t timestamp)
 {
-    int st;
-    mcollect_value_p mcValue;
-    mcollect_p mc = m_globalCollection;
+    return AppendGlobalStat(GetKey(key), value, timestamp);
+}
 
-    if (!mc)
-        return -1;
+int DcgmStatCollection::AppendGlobalStat(std::string key, std::string value, timelib64_t timestamp)
+{
+    return AppendGlobalStat(GetKey(key), value, timestamp);
+}
 
-    mcValue = mcollect_value_add_timeseries_int64(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::AppendGlobalStat(std::string key, void *value, int valueSize, timelib64_t timestamp)
+{
+    return AppendGlobalStat(GetKey(key), value, valueSize, timestamp);
+}
 
-    st = timeseries_insert_int64_coerce(mcValue->val.tseries, timestamp, value, 0);
-    if (st)
-        return -3;
+/*****************************************************************************/
+/* Grouped collections */
+int DcgmStatCollection::SetGroupedStat(sc_stat_key_t group, sc_stat_key_t key, double value)
+{
+    return SetStat(GetGroupedValues(group), key, value);
+}
 
-    return 0;
+int DcgmStatCollection::SetGroupedStat(sc_stat_key_t group, sc_stat_key_t key, long long value)
+{
+    return SetStat(GetGroupedValues(group), key, value);
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::AppendGroupedStat(std::string group, std::string key, double value, timelib64_t timestamp)
+int DcgmStatCollection::SetGroupedStat(sc_stat_key_t group, sc_stat_key_t key, std::string const &value)
 {
-    int st;
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
+    return SetStat(GetGroupedValues(group), key, value);
+}
 
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
-        return -1;
+int DcgmStatCollection::AppendGroupedStat(sc_stat_key_t group,
+                                          sc_stat_key_t key,
+                                          double value,
+                                          timelib64_t timestamp)
+{
+    return AppendStat(GetGroupedValues(group), key, MC_TYPE_TIMESERIES_DOUBLE, value, 0.0, timestamp);
+}
 
-    mcValue = mcollect_value_add_timeseries_double(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::AppendGroupedStat(sc_stat_key_t group,
+                                          sc_stat_key_t key,
+                                          long long value,
+                                          timelib64_t timestamp)
+{
+    /* Grouped integer stats have always been kept in a double time series */
+    return AppendStat(GetGroupedValues(group), key, MC_TYPE_TIMESERIES_DOUBLE, value, 0LL, timestamp);
+}
 
-    st = timeseries_insert_double_coerce(mcValue->val.tseries, timestamp, value, 0);
-    if (st)
-        return -3;
+int DcgmStatCollection::AppendGroupedStat(sc_stat_key_t group,
+                                          sc_stat_key_t key,
+                                          std::string const &value,
+                                          timelib64_t timestamp)
+{
+    return AppendStat(GetGroupedValues(group), key, value, timestamp);
+}
 
-    return 0;
+int DcgmStatCollection::AppendGroupedStat(sc_stat_key_t group,
+                                          sc_stat_key_t key,
+                                          void *value,
+                                          int valueSize,
+                                          timelib64_t timestamp)
+{
+    return AppendStat(GetGroupedValues(group), key, value, valueSize, timestamp);
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::AppendGroupedStat(std::string group, std::string key, long long value, timelib64_t timestamp)
+int DcgmStatCollection::SetGroupedStat(std::string group, std::string key, double value)
 {
-    int st;
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
+    return SetGroupedStat(GetKey(group), GetKey(key), value);
+}
 
-    mc = GetOrCreateGroupedCollection(group);
-    if (!mc)
-        return -1;
+int DcgmStatCollection::SetGroupedStat(std::string group, std::string key, long long value)
+{
+    return SetGroupedStat(GetKey(group), GetKey(key), value);
+}
 
-    mcValue = mcollect_value_add_timeseries_double(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::SetGroupedStat(std::string group, std::string key, std::string value)
+{
+    return SetGroupedStat(GetKey(group), GetKey(key), value);
+}
 
-    st = timeseries_insert_int64_coerce(mcValue->val.tseries, timestamp, value, 0);
-    if (st)
-        return -3;
+int DcgmStatCollection::AppendGroupedStat(std::string group, std::string key, double value, timelib64_t timestamp)
+{
+    return AppendGroupedStat(GetKey(group), GetKey(key), value, timestamp);
+}
 
-    return 0;
+int DcgmStatCollection::AppendGroupedStat(std::string group, std::string key, long long value, timelib64_t timestamp)
+{
+    return AppendGroupedStat(GetKey(group), GetKey(key), value, timestamp);
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
-                                      std::string key,
-                                      double value1,
-                                      double value2,
-                                      timelib64_t timestamp)
+int DcgmStatCollection::AppendGroupedStat(std::string group, std::string key, std::string value, timelib64_t timestamp)
 {
-    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value1, value2, timestamp);
+    return AppendGroupedStat(GetKey(group), GetKey(key), value, timestamp);
+}
+
+int DcgmStatCollection::AppendGroupedStat(std::string group,
+                                          std::string key,
+                                          void *value,
+                                          int valueSize,
+                                          timelib64_t timestamp)
+{
+    return AppendGroupedStat(GetKey(group), GetKey(key), value, valueSize, timestamp);
 }
 
 /*****************************************************************************/
+/* Entity-based collections */
+int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
+                                      sc_entity_id_t entityId,
+                                      sc_stat_key_t key,
+                                      double value)
+{
+    return SetStat(GetEntityValues(entityGroupId, entityId), key, value);
+}
+
+int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
+                                      sc_entity_id_t entityId,
+                                      sc_stat_key_t key,
+                                      long long value)
+{
+    return SetStat(GetEntityValues(entityGroupId, entityId), key, value);
+}
+
+int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
+                                      sc_entity_id_t entityId,
+                                      sc_stat_key_t key,
+                                      std::string const &value)
+{
+    return SetStat(GetEntityValues(entityGroupId, entityId), key, value);
+}
+
 int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
                                          sc_entity_id_t entityId,
-                                         std::string key,
+                                         sc_stat_key_t key,
                                          double value1,
                                          double value2,
                                          timelib64_t timestamp)
 {
-    int st;
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
+    return AppendStat(
+        GetEntityValues(entityGroupId, entityId), key, MC_TYPE_TIMESERIES_DOUBLE, value1, value2, timestamp);
+}
 
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
-        return -1;
+int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
+                                         sc_entity_id_t entityId,
+                                         sc_stat_key_t key,
+                                         long long value1,
+                                         long long value2,
+                                         timelib64_t timestamp)
+{
+    return AppendStat(
+        GetEntityValues(entityGroupId, entityId), key, MC_TYPE_TIMESERIES_INT64, value1, value2, timestamp);
+}
 
-    mcValue = mcollect_value_add_timeseries_double(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
+                                         sc_entity_id_t entityId,
+                                         sc_stat_key_t key,
+                                         std::string const &value,
+                                         timelib64_t timestamp)
+{
+    return AppendStat(GetEntityValues(entityGroupId, entityId), key, value, timestamp);
+}
 
-    st = timeseries_insert_double_coerce(mcValue->val.tseries, timestamp, value1, value2);
-    if (st)
-        return -3;
+int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
+                                         sc_entity_id_t entityId,
+                                         sc_stat_key_t key,
+                                         void *value,
+                                         int valueSize,
+                                         timelib64_t timestamp)
+{
+    return AppendStat(GetEntityValues(entityGroupId, entityId), key, value, valueSize, timestamp);
+}
 
-    return 0;
+int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
+                                      sc_entity_id_t entityId,
+                                      std::string key,
+                                      double value)
+{
+    return SetEntityStat(entityGroupId, entityId, GetKey(key), value);
 }
 
-/*****************************************************************************/
-int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
+int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
+                                      sc_entity_id_t entityId,
                                       std::string key,
-                                      long long value1,
-                                      long long value2,
-                                      timelib64_t timestamp)
+                                      long long value)
 {
-    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value1, value2, timestamp);
+    return SetEntityStat(entityGroupId, entityId, GetKey(key), value);
+}
+
+int DcgmStatCollection::SetEntityStat(sc_entity_group_t entityGroupId,
+                                      sc_entity_id_t entityId,
+                                      std::string key,
+                                      std::string value)
+{
+    return SetEntityStat(entityGroupId, entityId, GetKey(key), value);
+}
+
+int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
+                                         sc_entity_id_t entityId,
+                                         std::string key,
+                                         double value1,
+                                         double value2,
+                                         timelib64_t timestamp)
+{
+    return AppendEntityStat(entityGroupId, entityId, GetKey(key), value1, value2, timestamp);
 }
 
-/*****************************************************************************/
 int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
                                          sc_entity_id_t entityId,
                                          std::string key,
@@ -778,23 +820,78 @@ int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
                                          long long value2,
                                          timelib64_t timestamp)
 {
-    int st;
-    mcollect_value_p mcValue;
-    mcollect_p mc = 0;
+    return AppendEntityStat(entityGroupId, entityId, GetKey(key), value1, value2, timestamp);
+}
 
-    mc = GetOrCreateEntityCollection(entityGroupId, entityId);
-    if (!mc)
-        return -1;
+int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
+                                         sc_entity_id_t entityId,
+                                         std::string key,
+                                         std::string value,
+                                         timelib64_t timestamp)
+{
+    return AppendEntityStat(entityGroupId, entityId, GetKey(key), value, timestamp);
+}
 
-    mcValue = mcollect_value_add_timeseries_int64(mc, (char *)key.c_str());
-    if (!mcValue)
-        return -2;
+int DcgmStatCollection::AppendEntityStat(sc_entity_group_t entityGroupId,
+                                         sc_entity_id_t entityId,
+                                         std::string key,
+                                         void *value,
+                                         int valueSize,
+                                         timelib64_t timestamp)
+{
+    return AppendEntityStat(entityGroupId, entityId, GetKey(key), value, valueSize, timestamp);
+}
 
-    st = timeseries_insert_int64_coerce(mcValue->val.tseries, timestamp, value1, value2);
-    if (st)
-        return -3;
+/*****************************************************************************/
+/* GPU collections (Deprecated) */
+int DcgmStatCollection::SetGpuStat(unsigned int nvmlGpuIdx, std::string key, double value)
+{
+    return SetEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value);
+}
 
-    return 0;
+int DcgmStatCollection::SetGpuStat(unsigned int nvmlGpuIdx, std::string key, long long value)
+{
+    return SetEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value);
+}
+
+int DcgmStatCollection::SetGpuStat(unsigned int nvmlGpuIdx, std::string key, std::string value)
+{
+    return SetEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value);
+}
+
+int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
+                                      std::string key,
+                                      double value1,
+                                      double value2,
+                                      timelib64_t timestamp)
+{
+    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value1, value2, timestamp);
+}
+
+int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
+                                      std::string key,
+                                      long long value1,
+                                      long long value2,
+                                      timelib64_t timestamp)
+{
+    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value1, value2, timestamp);
+}
+
+int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
+                                      std::string key,
+                                      std::string value,
+                                      timelib64_t timestamp)
+{
+    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value, timestamp);
+}
+
+int DcgmStatCollection::AppendGpuStat(unsigned int nvmlGpuIdx,
+                                      std::string key,
+                                      void *value,
+                                      int valueSize,
+                                      timelib64_t timestamp)
+{
+    return AppendEntityStat(SC_ENTITY_GROUP_GPU, nvmlGpuIdx, key, value, valueSize, timestamp);
 }
 
 /*****************************************************************************/
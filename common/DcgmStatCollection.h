@@ -21,6 +21,7 @@
 #include "timelib.h"
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /*****************************************************************************/
@@ -44,6 +45,10 @@ typedef unsigned int sc_entity_id_t;
 /* Base data structure for entity-based collections */
 typedef std::map<sc_entity_id_t, mcollect_p> entity_collection_t;
 
+/* Interned stat key or group name. Get one with DcgmStatCollection::GetKey(). Only valid for the
+ * collection that returned it */
+typedef unsigned int sc_stat_key_t;
+
 /*****************************************************************************/
 
 class DcgmStatCollection
@@ -94,6 +99,23 @@ private:
 
     bool m_switchOutput;
 
+    /* Values of one top-level collection, indexed by interned key. Filled in the first time a key
+     * is used so later sets and appends don't hash the key name */
+    typedef struct
+    {
+        mcollect_p mc;
+        std::vector<mcollect_value_p> byKey;
+    } sc_key_values_t;
+
+    /* Interned key names, indexed by sc_stat_key_t, and the reverse lookup */
+    std::vector<std::string> m_keyNames;
+    std::unordered_map<std::string, sc_stat_key_t> m_keyIds;
+
+    sc_key_values_t m_globalValues;
+    /* Indexed by the interned group name */
+    std::vector<sc_key_values_t> m_groupedValues;
+    std::map<sc_entity_id_t, sc_key_values_t> m_entityValues[SC_ENTITY_GROUP_COUNT];
+
     /*************************************************************************/
     /*
      * Return an entity collection data structure based on the provided entity group
@@ -105,6 +127,15 @@ private:
     entity_collection_t *GetCollectionByEntityGroupId(sc_entity_group_t entityGroupId);
 
 public:
+    /*************************************************************************/
+    /*
+     * Intern a stat key or group name. Get it once and pass it to the sc_stat_key_t
+     * setters below instead of a string to avoid hashing and copying the name on
+     * every call. Calling this again with the same name returns the same key.
+     *
+     */
+    sc_stat_key_t GetKey(std::string const &name);
+
     /*************************************************************************/
     /* Setters
      *
@@ -118,6 +149,9 @@ public:
      * differing between them. Cast value as the desired type to make sure the
      * right overriden method is called
      *
+     * The std::string key versions intern the key with GetKey() and call the
+     * sc_stat_key_t versions
+     *
      * Returns: 0 on success
      *         <0 on error
      *
@@ -154,6 +188,60 @@ public:
     int AppendGpuStat(unsigned int nvmlGpuIdx, std::string key, std::string value, timelib64_t timestamp = 0);
     int AppendGpuStat(unsigned int nvmlGpuIdx, std::string key, void *value, int valueSize, timelib64_t timestamp = 0);
 
+    /* Interned-key versions of the above */
+    int SetGlobalStat(sc_stat_key_t key, double value);
+    int SetGlobalStat(sc_stat_key_t key, long long value);
+    int SetGlobalStat(sc_stat_key_t key, std::string const &value);
+    int AppendGlobalStat(sc_stat_key_t key, double value, timelib64_t timestamp = 0);
+    int AppendGlobalStat(sc_stat_key_t key, long long value, timelib64_t timestamp = 0);
+    int AppendGlobalStat(sc_stat_key_t key, std::string const &value, timelib64_t timestamp = 0);
+    int AppendGlobalStat(sc_stat_key_t key, void *value, int valueSize, timelib64_t timestamp = 0);
+
+    int SetGroupedStat(sc_stat_key_t group, sc_stat_key_t key, double value);
+    int SetGroupedStat(sc_stat_key_t group, sc_stat_key_t key, long long value);
+    int SetGroupedStat(sc_stat_key_t group, sc_stat_key_t key, std::string const &value);
+    int AppendGroupedStat(sc_stat_key_t group, sc_stat_key_t key, double value, timelib64_t timestamp = 0);
+    int AppendGroupedStat(sc_stat_key_t group, sc_stat_key_t key, long long value, timelib64_t timestamp = 0);
+    int AppendGroupedStat(sc_stat_key_t group,
+                          sc_stat_key_t key,
+                          std::string const &value,
+                          timelib64_t timestamp = 0);
+    int AppendGroupedStat(sc_stat_key_t group,
+                          sc_stat_key_t key,
+                          void *value,
+                          int valueSize,
+                          timelib64_t timestamp = 0);
+
+    int SetEntityStat(sc_entity_group_t entityGroupId, sc_entity_id_t entityId, sc_stat_key_t key, double value);
+    int SetEntityStat(sc_entity_group_t entityGroupId, sc_entity_id_t entityId, sc_stat_key_t key, long long value);
+    int SetEntityStat(sc_entity_group_t entityGroupId,
+                      sc_entity_id_t entityId,
+                      sc_stat_key_t key,
+                      std::string const &value);
+    int AppendEntityStat(sc_entity_group_t entityGroupId,
+                         sc_entity_id_t entityId,
+                         sc_stat_key_t key,
+                         double value1,
+                         double value2,
+                         timelib64_t timestamp);
+    int AppendEntityStat(sc_entity_group_t entityGroupId,
+                         sc_entity_id_t entityId,
+                         sc_stat_key_t key,
+                         long long value1,
+                         long long value2,
+                         timelib64_t timestamp);
+    int AppendEntityStat(sc_entity_group_t entityGroupId,
+                         sc_entity_id_t entityId,
+                         sc_stat_key_t key,
+                         std::string const &value,
+                         timelib64_t timestamp = 0);
+    int AppendEntityStat(sc_entity_group_t entityGroupId,
+                         sc_entity_id_t entityId,
+                         sc_stat_key_t key,
+                         void *value,
+                         int valueSize,
+                         timelib64_t timestamp = 0);
+
     /* Entity-based collections */
     int SetEntityStat(sc_entity_group_t entityGroupId, sc_entity_id_t entityId, std::string key, double value);
     int SetEntityStat(sc_entity_group_t entityGroupId, sc_entity_id_t entityId, std::string key, long long value);
@@ -360,6 +448,52 @@ private:
     mcollect_p GetOrCreateGroupedCollection(std::string group);
     mcollect_p GetOrCreateEntityCollection(sc_entity_group_t entityGroupId, sc_entity_id_t entityId);
 
+    /*************************************************************************/
+    /*
+     * Helper functions to return the interned-key values of top level collections,
+     * creating the collections as needed
+     *
+     * Returns NULL on error
+     *
+     */
+    sc_key_values_t *GetGlobalValues();
+    sc_key_values_t *GetGroupedValues(sc_stat_key_t group);
+    sc_key_values_t *GetEntityValues(sc_entity_group_t entityGroupId, sc_entity_id_t entityId);
+
+    /*************************************************************************/
+    /*
+     * Return the value for key in values, adding it to the collection as type
+     * mcType if it isn't there yet
+     *
+     * Returns NULL on error or if an append (time series mcType) finds a value
+     * that isn't a time series
+     *
+     */
+    mcollect_value_p GetOrAddValue(sc_key_values_t *values, sc_stat_key_t key, int mcType);
+
+    /*************************************************************************/
+    /*
+     * Common implementations of the sc_stat_key_t setters
+     *
+     */
+    int SetStat(sc_key_values_t *values, sc_stat_key_t key, double value);
+    int SetStat(sc_key_values_t *values, sc_stat_key_t key, long long value);
+    int SetStat(sc_key_values_t *values, sc_stat_key_t key, std::string const &value);
+    int AppendStat(sc_key_values_t *values,
+                   sc_stat_key_t key,
+                   int mcType,
+                   double value1,
+                   double value2,
+                   timelib64_t timestamp);
+    int AppendStat(sc_key_values_t *values,
+                   sc_stat_key_t key,
+                   int mcType,
+                   long long value1,
+                   long long value2,
+                   timelib64_t timestamp);
+    int AppendStat(sc_key_values_t *values, sc_stat_key_t key, std::string const &value, timelib64_t timestamp);
+    int AppendStat(sc_key_values_t *values, sc_stat_key_t key, void *value, int valueSize, timelib64_t timestamp);
+
     /*************************************************************************/
 };
 
@@ -18,6 +18,10 @@
 #include "DcgmLogging.h"
 #include <stdexcept>
 
+DcgmTaskRunner::DcgmTaskRunner(DcgmNs::TaskQueueKind queueKind)
+    : DcgmNs::TaskRunner(queueKind)
+{}
+
 DcgmTaskRunner::~DcgmTaskRunner()
 {
     /* Wait for the worker. DcgmThread::StopAndWait() will call DcgmThread::Stop(),
@@ -28,6 +28,11 @@ class DcgmTaskRunner
     , public DcgmNs::TaskRunner
 {
 public:
+    /**
+     * @param[in] queueKind     Which queue to keep the scheduled tasks in. See DcgmNs::TaskQueueKind
+     */
+    explicit DcgmTaskRunner(DcgmNs::TaskQueueKind queueKind = DcgmNs::TaskQueueKind::Locked);
+
     ~DcgmTaskRunner() override;
 
     /** Virtual method inherited from DcgmThread that is the main() for this thread */
@@ -17,12 +17,15 @@
 
 #include "DcgmThread.h"
 #include "DcgmLogging.h"
+#include "DcgmThreadPlacement.h"
 #include <cstdio>
 
 #ifdef __linux__
+#include <sys/eventfd.h> //eventfd()
 #include <sys/syscall.h> //syscall()
-#include <unistd.h>      //usleep()
+#include <unistd.h>      //read(), write(), close()
 #endif
+#include <cstring>
 
 /*****************************************************************************/
 /*
@@ -47,11 +50,27 @@ DcgmThread::DcgmThread(std::string threadName)
     m_handle   = NULL;
     m_threadId = 0;
 #endif
+
+    m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_wakeFd < 0)
+    {
+        log_error("eventfd() failed with error: {}. Waking up thread {} may be delayed", strerror(errno), m_threadName);
+    }
 }
 
 /*****************************************************************************/
 DcgmThread::~DcgmThread()
-{}
+{
+    /* RunInternal() notifies m_exitCond with m_mutex held. Don't destroy them under it */
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+    }
+
+    if (m_wakeFd >= 0)
+    {
+        close(m_wakeFd);
+    }
+}
 
 void DcgmThread::resetStatusFlags()
 {
@@ -126,9 +145,68 @@ void DcgmThread::Stop()
     m_stopCond.notify_all();
     m_mutex.unlock();
 
+    SignalWakeFd();
+
     OnStop();
 }
 
+/*****************************************************************************/
+void DcgmThread::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_wakePending = true;
+        m_stopCond.notify_all();
+    }
+
+    SignalWakeFd();
+}
+
+/*****************************************************************************/
+void DcgmThread::SignalWakeFd()
+{
+    if (m_wakeFd < 0)
+    {
+        return;
+    }
+
+    uint64_t one = 1;
+    if (write(m_wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+    {
+        log_debug("Writing the wake eventfd of thread {} failed: {}", m_threadName, strerror(errno));
+    }
+}
+
+/*****************************************************************************/
+int DcgmThread::GetWakeFd() const
+{
+    return m_wakeFd;
+}
+
+/*****************************************************************************/
+bool DcgmThread::ConsumeWake()
+{
+    bool wasPending;
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        wasPending    = m_wakePending;
+        m_wakePending = false;
+        if (m_shouldStop)
+        {
+            /* Leave m_wakeFd readable so that waiters keep seeing the stop */
+            return wasPending;
+        }
+    }
+
+    if (m_wakeFd >= 0)
+    {
+        uint64_t count;
+        [[maybe_unused]] ssize_t ret = read(m_wakeFd, &count, sizeof(count));
+    }
+
+    return wasPending;
+}
+
 /*****************************************************************************/
 void DcgmThread::Kill()
 {
@@ -168,9 +246,9 @@ int DcgmThread::Wait(int timeoutMs)
     if (timeoutMs == 0)
     {
         /* Does this thread exist yet? */
-        while (!m_hasRun)
         {
-            usleep(1000);
+            std::unique_lock<std::mutex> uniqueLock(m_mutex);
+            m_exitCond.wait(uniqueLock, [this] { return m_hasRun.load(); });
         }
 
         /* Calling pthread_join a second time results in undefined behavior */
@@ -202,31 +280,24 @@ int DcgmThread::Wait(int timeoutMs)
         return 0;
     }
 
-    /* Does this thread exist yet? */
-    while (!m_hasRun && timeoutMs > 0)
-    {
-        /* Sleep for small intervals until we exhaust our timeout */
-        usleep(1000);
-        timeoutMs -= 1;
-    }
-
-    if (timeoutMs < 0)
-    {
-        DCGM_LOG_DEBUG << "Thread " << m_pthread << " had timeoutMs < 0: " << timeoutMs;
-        return 1; /* Hasn't started yet. I guess it's running */
-    }
-
 #if 1
-    while (!m_hasExited && timeoutMs > 0)
+    /* Returns as soon as the thread exits rather than on the next tick of a polling loop */
     {
-        usleep(1000);
-        timeoutMs -= 1;
-    }
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        std::unique_lock<std::mutex> uniqueLock(m_mutex);
 
-    if (!m_hasExited)
-    {
-        DCGM_LOG_DEBUG << "Thread " << m_pthread << " had !m_hasExited";
-        return 1; /* Running still */
+        /* Does this thread exist yet? */
+        if (!m_exitCond.wait_until(uniqueLock, deadline, [this] { return m_hasRun.load(); }))
+        {
+            DCGM_LOG_DEBUG << "Thread " << m_pthread << " hasn't run after " << timeoutMs << " ms";
+            return 1; /* Hasn't started yet. I guess it's running */
+        }
+
+        if (!m_exitCond.wait_until(uniqueLock, deadline, [this] { return m_hasExited.load(); }))
+        {
+            DCGM_LOG_DEBUG << "Thread " << m_pthread << " had !m_hasExited";
+            return 1; /* Running still */
+        }
     }
 
     DCGM_LOG_DEBUG << "Thread " << m_pthread << " had m_alreadyJoined " << m_alreadyJoined;
@@ -295,9 +366,17 @@ int DcgmThread::StopAndWait(int timeoutMs)
 /*****************************************************************************/
 void DcgmThread::RunInternal(void)
 {
-    m_hasRun = true;
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_hasRun = true;
+        m_exitCond.notify_all();
+    }
 
     log_debug("Thread handle {} running", (unsigned int)m_pthread);
+
+    /* Placed from the thread itself since the preferred NUMA node can only be set for the calling thread */
+    DcgmNs::ThreadPlacement::ApplyToCurrentThread(m_threadName);
+
     try
     {
         run();
@@ -308,7 +387,9 @@ void DcgmThread::RunInternal(void)
     }
     log_debug("Thread id {} stopped", (unsigned int)m_pthread);
 
+    std::lock_guard<std::mutex> lg(m_mutex);
     m_hasExited = true;
+    m_exitCond.notify_all();
 }
 
 /*****************************************************************************/
@@ -344,14 +425,28 @@ void DcgmThread::Sleep(long long howLongUsec)
         return; /* Bad value */
     }
 
-    std::unique_lock<std::mutex> uniqueLock(m_mutex);
+    if (SleepUntil(std::chrono::steady_clock::now() + std::chrono::microseconds(howLongUsec)))
+    {
+        DCGM_LOG_DEBUG << "Sleep was woken up";
+    }
+}
 
-    if (m_stopCond.wait_for(uniqueLock, std::chrono::microseconds(howLongUsec), [this] {
-            return m_shouldStop.load(std::memory_order_relaxed);
-        }))
+/*****************************************************************************/
+bool DcgmThread::SleepUntil(std::chrono::steady_clock::time_point deadline)
+{
     {
-        DCGM_LOG_DEBUG << "Sleep hit m_shouldStop";
+        std::unique_lock<std::mutex> uniqueLock(m_mutex);
+
+        if (!m_stopCond.wait_until(uniqueLock, deadline, [this] {
+                return m_wakePending || m_shouldStop.load(std::memory_order_relaxed);
+            }))
+        {
+            return false;
+        }
     }
+
+    ConsumeWake();
+    return true;
 }
 
 /*****************************************************************************/
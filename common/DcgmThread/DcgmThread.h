@@ -26,6 +26,7 @@
 #include <string>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
@@ -43,8 +44,11 @@ private:
 
     std::exception_ptr m_exception; /*!< Exception preserved from the running thread. Will be thrown on Wait */
 
-    std::mutex m_mutex;                 /* Mutex used for m_stopCond */
-    std::condition_variable m_stopCond; /* Condition used to signal that it's time to stop */
+    std::mutex m_mutex;                 /* Mutex used for m_stopCond and m_exitCond */
+    std::condition_variable m_stopCond; /* Condition used to signal that it's time to stop or to wake up */
+    std::condition_variable m_exitCond; /* Condition used to signal that m_hasRun or m_hasExited was set */
+    bool m_wakePending = false;         /* Wake() was called and hasn't been consumed yet. Protected by m_mutex */
+    int m_wakeFd       = -1;            /* eventfd written by Wake() and Stop(). -1 if it couldn't be created */
     std::string m_threadName;           /* Textual name of this thread that will appear in gdb */
 
 public:
@@ -161,11 +165,49 @@ public:
      * Sleep for a specified time
      *
      * How long to sleep in microseconds (at least). This will return
-     * immediately if ShouldStop() is true
+     * immediately if ShouldStop() is true, and early on Stop() or Wake()
      */
     void Sleep(long long howLongUsec);
 
 
+    /*************************************************************************/
+    /*
+     * Sleep until deadline, Stop() or Wake(), whichever comes first. A Wake()
+     * that came while the thread wasn't sleeping ends the next sleep right away.
+     *
+     * RETURNS: true if woken up by Stop() or Wake() before the deadline
+     *          false if the deadline passed
+     */
+    bool SleepUntil(std::chrono::steady_clock::time_point deadline);
+
+    /*************************************************************************/
+    /*
+     * Wake this thread up from Sleep(), SleepUntil() or a poll() on
+     * GetWakeFd(). Can be called from any thread, typically after handing
+     * the thread new work.
+     */
+    void Wake();
+
+    /*************************************************************************/
+    /*
+     * Get an eventfd that becomes readable on Wake() and Stop(), so that a
+     * thread waiting in poll() or epoll on its own descriptors can add it and
+     * block without a timeout. Call ConsumeWake() once it's readable. It
+     * stays readable from Stop() on.
+     *
+     * RETURNS: The eventfd. Owned by this object
+     *          -1 if it couldn't be created. Fall back to polling ShouldStop()
+     */
+    int GetWakeFd() const;
+
+    /*************************************************************************/
+    /*
+     * Clear a pending Wake() and reset GetWakeFd() to not readable.
+     *
+     * RETURNS: true if Wake() was called since the last time it was consumed
+     */
+    bool ConsumeWake();
+
     /*************************************************************************/
     /*
      * Method to check if the this thread has run yet
@@ -211,6 +253,9 @@ public:
 
 private:
     void resetStatusFlags();
+
+    /* Make m_wakeFd readable */
+    void SignalWakeFd();
 };
 
 
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmThreadPlacement.h"
+#include "DcgmLogging.h"
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <set>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace DcgmNs::ThreadPlacement
+{
+namespace
+{
+    struct ThreadClass
+    {
+        std::string_view name;
+        std::string_view threadNamePrefix;
+    };
+
+    constexpr std::array<ThreadClass, 6> c_threadClasses { {
+        { "cache", "cache_mgr_" },
+        { "ipc", "dcgm_ipc" },
+        { "modules", "mod_" },
+        { "kmsg", "dcgm_kmsg" },
+        { "metrics", "dcgm_metrics" },
+        { "default", "" },
+    } };
+
+    constexpr std::string_view c_auto = "auto";
+
+    /* Largest NUMA node set_mempolicy() is called with */
+    constexpr unsigned int c_maxNumaNodes = 1024;
+
+    bool IsKnownClass(std::string_view name)
+    {
+        for (auto const &threadClass : c_threadClasses)
+        {
+            if (threadClass.name == name)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::optional<unsigned int> ParseUnsigned(std::string_view value)
+    {
+        unsigned int result  = 0;
+        auto const [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        if (value.empty() || ec != std::errc() || end != value.data() + value.size())
+        {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    /* Calls func with the sysfs directory of each NVIDIA display controller */
+    template <typename TFunc>
+    void ForEachNvidiaGpu(TFunc func)
+    {
+        std::error_code ec;
+        for (auto const &entry : std::filesystem::directory_iterator("/sys/bus/pci/devices", ec))
+        {
+            std::string vendor;
+            std::string pciClass;
+            std::ifstream(entry.path() / "vendor") >> vendor;
+            std::ifstream(entry.path() / "class") >> pciClass;
+
+            if (vendor == "0x10de" && pciClass.starts_with("0x03"))
+            {
+                func(entry.path());
+            }
+        }
+    }
+
+    std::vector<unsigned int> GpuLocalCpus()
+    {
+        std::set<unsigned int> cpus;
+        ForEachNvidiaGpu([&cpus](std::filesystem::path const &device) {
+            std::string cpuList;
+            std::ifstream(device / "local_cpulist") >> cpuList;
+            if (auto const parsed = ParseCpuList(cpuList); parsed.has_value())
+            {
+                cpus.insert(parsed->begin(), parsed->end());
+            }
+        });
+        return { cpus.begin(), cpus.end() };
+    }
+
+    std::optional<unsigned int> GpuLocalNumaNode()
+    {
+        std::optional<unsigned int> numaNode;
+        ForEachNvidiaGpu([&numaNode](std::filesystem::path const &device) {
+            std::string value;
+            std::ifstream(device / "numa_node") >> value;
+            /* -1 when the platform does not report a node */
+            if (auto const parsed = ParseUnsigned(value); !numaNode.has_value() && parsed.has_value())
+            {
+                numaNode = parsed;
+            }
+        });
+        return numaNode;
+    }
+
+    struct Placement
+    {
+        std::vector<unsigned int> cpus; /* Empty to leave the affinity alone */
+        std::optional<unsigned int> numaNode;
+    };
+
+    /* Placement of each class as given by the environment */
+    std::map<std::string, Placement, std::less<>> ReadPlacements()
+    {
+        std::map<std::string, Placement, std::less<>> placements;
+
+        char const *cpusEnv = getenv(DCGM_ENV_THREAD_CPUS);
+        if (cpusEnv != nullptr && cpusEnv[0] != '\0')
+        {
+            if (!IsValidCpusSpec(cpusEnv))
+            {
+                log_error("Ignoring invalid {}={}", DCGM_ENV_THREAD_CPUS, cpusEnv);
+            }
+            else
+            {
+                auto const spec = ParseSpec(cpusEnv).value();
+                for (auto const &[threadClass, value] : spec)
+                {
+                    placements[threadClass].cpus = value == c_auto ? GpuLocalCpus() : ParseCpuList(value).value();
+                }
+            }
+        }
+
+        char const *numaEnv = getenv(DCGM_ENV_THREAD_NUMA_NODES);
+        if (numaEnv != nullptr && numaEnv[0] != '\0')
+        {
+            if (!IsValidNumaNodesSpec(numaEnv))
+            {
+                log_error("Ignoring invalid {}={}", DCGM_ENV_THREAD_NUMA_NODES, numaEnv);
+            }
+            else
+            {
+                auto const spec = ParseSpec(numaEnv).value();
+                for (auto const &[threadClass, value] : spec)
+                {
+                    placements[threadClass].numaNode = value == c_auto ? GpuLocalNumaNode() : ParseUnsigned(value);
+                }
+            }
+        }
+
+        return placements;
+    }
+
+    void SetAffinity(std::string_view threadClass, std::vector<unsigned int> const &cpus)
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (unsigned int const cpu : cpus)
+        {
+            if (cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+
+        if (CPU_COUNT(&cpuSet) == 0)
+        {
+            log_warning("No usable CPU to pin the {} threads to", threadClass);
+            return;
+        }
+
+        int const st = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (st != 0)
+        {
+            log_warning("Unable to pin a {} thread to its CPUs: {}", threadClass, strerror(st));
+        }
+    }
+
+    void SetPreferredNumaNode(std::string_view threadClass, unsigned int numaNode)
+    {
+        if (numaNode >= c_maxNumaNodes)
+        {
+            log_warning("NUMA node {} of the {} threads is out of range", numaNode, threadClass);
+            return;
+        }
+
+        constexpr unsigned int bitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+        std::array<unsigned long, c_maxNumaNodes / bitsPerWord> nodeMask {};
+        nodeMask[numaNode / bitsPerWord] = 1UL << (numaNode % bitsPerWord);
+
+        /* libnuma is not a dependency, so call set_mempolicy() directly. The kernel ignores the last bit of maxnode */
+        if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.data(), c_maxNumaNodes + 1) != 0)
+        {
+            log_warning("Unable to prefer NUMA node {} for a {} thread: {}", numaNode, threadClass, strerror(errno));
+        }
+    }
+} // namespace
+
+/*****************************************************************************/
+std::string_view ClassOfThread(std::string_view threadName)
+{
+    for (auto const &threadClass : c_threadClasses)
+    {
+        if (!threadClass.threadNamePrefix.empty() && threadName.starts_with(threadClass.threadNamePrefix))
+        {
+            return threadClass.name;
+        }
+    }
+    return {};
+}
+
+/*****************************************************************************/
+std::optional<std::map<std::string, std::string>> ParseSpec(std::string_view spec)
+{
+    std::map<std::string, std::string> result;
+
+    while (!spec.empty())
+    {
+        auto const end        = spec.find(';');
+        std::string_view pair = spec.substr(0, end);
+        spec                  = end == std::string_view::npos ? std::string_view {} : spec.substr(end + 1);
+
+        auto const equals = pair.find('=');
+        if (equals == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+
+        std::string_view const name  = pair.substr(0, equals);
+        std::string_view const value = pair.substr(equals + 1);
+        if (!IsKnownClass(name) || value.empty() || !result.emplace(name, value).second)
+        {
+            return std::nullopt;
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+std::optional<std::vector<unsigned int>> ParseCpuList(std::string_view cpuList)
+{
+    std::vector<unsigned int> cpus;
+
+    while (!cpuList.empty())
+    {
+        auto const end         = cpuList.find(',');
+        std::string_view range = cpuList.substr(0, end);
+        cpuList                = end == std::string_view::npos ? std::string_view {} : cpuList.substr(end + 1);
+
+        auto const dash  = range.find('-');
+        auto const first = ParseUnsigned(range.substr(0, dash));
+        auto const last  = dash == std::string_view::npos ? first : ParseUnsigned(range.substr(dash + 1));
+        if (!first.has_value() || !last.has_value() || *last < *first || *last >= CPU_SETSIZE)
+        {
+            return std::nullopt;
+        }
+
+        for (unsigned int cpu = *first; cpu <= *last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    if (cpus.empty())
+    {
+        return std::nullopt;
+    }
+    return cpus;
+}
+
+/*****************************************************************************/
+bool IsValidCpusSpec(std::string_view spec)
+{
+    auto const parsed = ParseSpec(spec);
+    if (!parsed.has_value())
+    {
+        return false;
+    }
+
+    for (auto const &[threadClass, value] : *parsed)
+    {
+        if (value != c_auto && !ParseCpuList(value).has_value())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************/
+bool IsValidNumaNodesSpec(std::string_view spec)
+{
+    auto const parsed = ParseSpec(spec);
+    if (!parsed.has_value())
+    {
+        return false;
+    }
+
+    for (auto const &[threadClass, value] : *parsed)
+    {
+        if (value == c_auto)
+        {
+            continue;
+        }
+        if (auto const numaNode = ParseUnsigned(value); !numaNode.has_value() || *numaNode >= c_maxNumaNodes)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************/
+void ApplyClass(std::string_view threadClass)
+{
+    static auto const placements = ReadPlacements();
+
+    auto const it = placements.find(threadClass);
+    if (it == placements.end())
+    {
+        return;
+    }
+
+    Placement const &placement = it->second;
+    if (!placement.cpus.empty())
+    {
+        SetAffinity(threadClass, placement.cpus);
+    }
+    if (placement.numaNode.has_value())
+    {
+        SetPreferredNumaNode(threadClass, *placement.numaNode);
+    }
+}
+
+/*****************************************************************************/
+void ApplyToCurrentThread(std::string_view threadName)
+{
+    std::string_view const threadClass = ClassOfThread(threadName);
+    if (!threadClass.empty())
+    {
+        ApplyClass(threadClass);
+    }
+}
+} // namespace DcgmNs::ThreadPlacement
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* CPUs of each thread class as CLASS=CPULIST[;CLASS=CPULIST...]. See DcgmNs::ThreadPlacement */
+#define DCGM_ENV_THREAD_CPUS "__DCGM_THREAD_CPUS__"
+
+/* Preferred NUMA node of each thread class as CLASS=NODE[;CLASS=NODE...] */
+#define DCGM_ENV_THREAD_NUMA_NODES "__DCGM_THREAD_NUMA_NODES__"
+
+/**
+ * Placement of the host engine threads on CPUs and NUMA nodes.
+ *
+ * Threads are grouped into classes by the prefix of their name:
+ *     cache    - cache_mgr_*: the cache manager update, event and per-GPU threads
+ *     ipc      - dcgm_ipc*: the IPC event loop and its worker pool
+ *     modules  - mod_*: the task runners of the modules
+ *     kmsg     - dcgm_kmsg: the kernel message reader
+ *     metrics  - dcgm_metrics: the OpenMetrics exporter
+ *     default  - the main thread. Threads of no class inherit the placement of the thread that created them
+ *
+ * A CPU list uses the sysfs format (0-3,8,10-11). A value of "auto" stands for the CPUs, or the NUMA node, that
+ * the NVIDIA GPUs of the system are attached to.
+ *
+ * The placement is read from DCGM_ENV_THREAD_CPUS and DCGM_ENV_THREAD_NUMA_NODES the first time a thread asks
+ * for it. DcgmThread applies it when a named thread starts.
+ */
+namespace DcgmNs::ThreadPlacement
+{
+/*****************************************************************************/
+/**
+ * Returns the class of the thread named threadName. Empty if it has none
+ */
+std::string_view ClassOfThread(std::string_view threadName);
+
+/*****************************************************************************/
+/**
+ * Splits CLASS=VALUE[;CLASS=VALUE...] into a map of class to value
+ *
+ * @return std::nullopt if a pair is malformed, names an unknown class or repeats a class
+ */
+std::optional<std::map<std::string, std::string>> ParseSpec(std::string_view spec);
+
+/*****************************************************************************/
+/**
+ * Parses a CPU list in the sysfs format, such as 0-3,8,10-11
+ *
+ * @return std::nullopt if the list is empty or malformed
+ */
+std::optional<std::vector<unsigned int>> ParseCpuList(std::string_view cpuList);
+
+/*****************************************************************************/
+/**
+ * Returns whether spec is a valid value of DCGM_ENV_THREAD_CPUS
+ */
+bool IsValidCpusSpec(std::string_view spec);
+
+/*****************************************************************************/
+/**
+ * Returns whether spec is a valid value of DCGM_ENV_THREAD_NUMA_NODES
+ */
+bool IsValidNumaNodesSpec(std::string_view spec);
+
+/*****************************************************************************/
+/**
+ * Pins the calling thread to the CPUs of threadClass and prefers its NUMA node for new allocations.
+ * Does nothing for a class that has no placement.
+ */
+void ApplyClass(std::string_view threadClass);
+
+/*****************************************************************************/
+/**
+ * ApplyClass() with the class of the thread named threadName
+ */
+void ApplyToCurrentThread(std::string_view threadName);
+} // namespace DcgmNs::ThreadPlacement
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmTrace.h"
+#include "DcgmLogging.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <semaphore.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace DcgmNs::Trace
+{
+namespace
+{
+    struct TraceEvent
+    {
+        char const *name;
+        char const *arg0Name;
+        long long arg0;
+        char const *arg1Name;
+        long long arg1;
+        std::int64_t startUsec;
+        std::int64_t durationUsec;
+    };
+
+    /* Events of one thread. The lock is only contended while the trace is being written out */
+    struct ThreadBuffer
+    {
+        std::mutex lock;
+        std::vector<TraceEvent> events; /* Ring of up to DCGM_TRACE_EVENTS_PER_THREAD events */
+        std::size_t next = 0;           /* Where the next event goes once the ring is full */
+        long tid         = 0;
+    };
+
+    /* Buffers of every thread that recorded an event. They outlive their threads so that the
+       events of finished threads still show up in the trace */
+    std::mutex g_buffersLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> g_buffers;
+
+    thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+
+    ThreadBuffer &GetThreadBuffer()
+    {
+        if (!t_buffer)
+        {
+            t_buffer      = std::make_shared<ThreadBuffer>();
+            t_buffer->tid = syscall(SYS_gettid);
+            t_buffer->events.reserve(DCGM_TRACE_EVENTS_PER_THREAD);
+
+            std::lock_guard<std::mutex> guard(g_buffersLock);
+            g_buffers.push_back(t_buffer);
+        }
+        return *t_buffer;
+    }
+
+    void AppendArg(std::string &json, bool &first, char const *name, long long value)
+    {
+        if (name == nullptr)
+        {
+            return;
+        }
+        fmt::format_to(std::back_inserter(json), "{}\"{}\":{}", first ? "" : ",", name, value);
+        first = false;
+    }
+
+    /* State of StartDumpOnSignal() */
+    std::mutex g_dumpLock;
+    std::thread g_dumpThread;
+    sem_t g_dumpSem;
+    std::atomic<bool> g_dumpStop { false };
+    struct sigaction g_oldDumpAction;
+
+    void DumpSignalHandler(int)
+    {
+        /* sem_post() is async-signal-safe. The dump thread does the work */
+        sem_post(&g_dumpSem);
+    }
+
+    std::string GetDumpPath()
+    {
+        char const *envStr = getenv(DCGM_TRACE_FILE_ENV);
+        if (envStr != nullptr && envStr[0] != '\0')
+        {
+            return envStr;
+        }
+        return fmt::format("/tmp/dcgm-trace-{}.json", getpid());
+    }
+
+    void DumpThreadMain()
+    {
+        while (true)
+        {
+            while (sem_wait(&g_dumpSem) == -1 && errno == EINTR)
+            {
+            }
+
+            if (g_dumpStop.load())
+            {
+                return;
+            }
+
+            std::string const path = GetDumpPath();
+            if (WriteChromeTrace(path) == DCGM_ST_OK)
+            {
+                log_info("Wrote the trace to {}", path);
+            }
+        }
+    }
+} // namespace
+
+namespace detail
+{
+    std::atomic<bool> g_enabled { RequestedByEnv() };
+
+    std::int64_t NowUsec()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void Record(char const *name,
+                char const *arg0Name,
+                long long arg0,
+                char const *arg1Name,
+                long long arg1,
+                std::int64_t startUsec)
+    {
+        TraceEvent const event { name, arg0Name, arg0, arg1Name, arg1, startUsec, NowUsec() - startUsec };
+
+        ThreadBuffer &buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> guard(buffer.lock);
+
+        if (buffer.events.size() < DCGM_TRACE_EVENTS_PER_THREAD)
+        {
+            buffer.events.push_back(event);
+            return;
+        }
+
+        buffer.events[buffer.next] = event;
+        buffer.next                = (buffer.next + 1) % DCGM_TRACE_EVENTS_PER_THREAD;
+    }
+} // namespace detail
+
+/*****************************************************************************/
+void Enable(bool enabled)
+{
+    detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+bool RequestedByEnv()
+{
+    char const *envStr = getenv(DCGM_TRACE_ENV);
+    return envStr != nullptr && envStr[0] == '1';
+}
+
+/*****************************************************************************/
+void Clear()
+{
+    std::lock_guard<std::mutex> guard(g_buffersLock);
+
+    for (auto const &buffer : g_buffers)
+    {
+        std::lock_guard<std::mutex> bufferGuard(buffer->lock);
+        buffer->events.clear();
+        buffer->next = 0;
+    }
+}
+
+/*****************************************************************************/
+std::string ToChromeTraceJson()
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool firstEvent  = true;
+    int const pid    = getpid();
+
+    std::lock_guard<std::mutex> guard(g_buffersLock);
+
+    for (auto const &buffer : g_buffers)
+    {
+        std::lock_guard<std::mutex> bufferGuard(buffer->lock);
+
+        /* Oldest first. next is 0 until the ring wraps */
+        std::size_t const count = buffer->events.size();
+        for (std::size_t i = 0; i < count; i++)
+        {
+            TraceEvent const &event = buffer->events[(buffer->next + i) % count];
+
+            fmt::format_to(std::back_inserter(json),
+                           "{}{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":{},\"tid\":{},\"args\":{{",
+                           firstEvent ? "" : ",",
+                           event.name,
+                           event.startUsec,
+                           event.durationUsec,
+                           pid,
+                           buffer->tid);
+            firstEvent = false;
+
+            bool firstArg = true;
+            AppendArg(json, firstArg, event.arg0Name, event.arg0);
+            AppendArg(json, firstArg, event.arg1Name, event.arg1);
+            json += "}}";
+        }
+    }
+
+    json += "]}";
+    return json;
+}
+
+/*****************************************************************************/
+dcgmReturn_t WriteChromeTrace(std::string const &path)
+{
+    std::string const json = ToChromeTraceJson();
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        log_error("Unable to open {} to write the trace", path);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    file << json;
+    if (!file)
+    {
+        log_error("Unable to write the trace to {}", path);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void StartDumpOnSignal()
+{
+    std::lock_guard<std::mutex> guard(g_dumpLock);
+
+    if (g_dumpThread.joinable())
+    {
+        return;
+    }
+
+    sem_init(&g_dumpSem, 0, 0);
+    g_dumpStop   = false;
+    g_dumpThread = std::thread(DumpThreadMain);
+
+    struct sigaction action = {};
+    action.sa_handler       = DumpSignalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(DCGM_TRACE_DUMP_SIGNAL, &action, &g_oldDumpAction);
+
+    log_info("Send signal {} to write the trace to {}", DCGM_TRACE_DUMP_SIGNAL, GetDumpPath());
+}
+
+/*****************************************************************************/
+void StopDumpOnSignal()
+{
+    std::lock_guard<std::mutex> guard(g_dumpLock);
+
+    if (!g_dumpThread.joinable())
+    {
+        return;
+    }
+
+    sigaction(DCGM_TRACE_DUMP_SIGNAL, &g_oldDumpAction, nullptr);
+
+    g_dumpStop = true;
+    sem_post(&g_dumpSem);
+    g_dumpThread.join();
+    sem_destroy(&g_dumpSem);
+}
+} // namespace DcgmNs::Trace
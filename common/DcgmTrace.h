@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <string>
+
+/* Set __DCGM_TRACE__=1 to record trace events from the start. See DcgmNs::Trace */
+#define DCGM_TRACE_ENV "__DCGM_TRACE__"
+
+/* File the trace is written to on DCGM_TRACE_DUMP_SIGNAL. Defaults to /tmp/dcgm-trace-<pid>.json */
+#define DCGM_TRACE_FILE_ENV "__DCGM_TRACE_FILE__"
+
+/* Signal that writes the trace to DCGM_TRACE_FILE_ENV once StartDumpOnSignal() was called */
+#define DCGM_TRACE_DUMP_SIGNAL SIGUSR2
+
+/* Number of events each thread keeps. Older events are overwritten */
+#define DCGM_TRACE_EVENTS_PER_THREAD 16384
+
+/**
+ * Timeline tracing of the request and update paths.
+ *
+ * Each thread records the spans it passes through into its own ring buffer of the last
+ * DCGM_TRACE_EVENTS_PER_THREAD events, so recording never contends with other threads. The
+ * buffers are written out in the Chrome trace event format, which chrome://tracing and
+ * Perfetto both load.
+ *
+ * Recording is off unless Enable() was called or DCGM_TRACE_ENV is set. Scopes cost one
+ * relaxed load when it is off.
+ *
+ * Note: The trace only holds the events of the copy of this code that recorded them. Modules
+ *       link their own copy, so spans are recorded around the calls into modules instead.
+ */
+namespace DcgmNs::Trace
+{
+namespace detail
+{
+    extern std::atomic<bool> g_enabled;
+
+    void Record(char const *name,
+                char const *arg0Name,
+                long long arg0,
+                char const *arg1Name,
+                long long arg1,
+                std::int64_t startUsec);
+
+    std::int64_t NowUsec();
+} // namespace detail
+
+/*****************************************************************************/
+/**
+ * Returns whether events are being recorded
+ */
+inline bool Enabled()
+{
+    return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/**
+ * Starts or stops recording. Events that were already recorded are kept
+ */
+void Enable(bool enabled);
+
+/*****************************************************************************/
+/**
+ * Returns whether DCGM_TRACE_ENV asks for tracing
+ */
+bool RequestedByEnv();
+
+/*****************************************************************************/
+/**
+ * Drops all recorded events
+ */
+void Clear();
+
+/*****************************************************************************/
+/**
+ * Returns the recorded events of all threads as a Chrome trace JSON document
+ */
+std::string ToChromeTraceJson();
+
+/*****************************************************************************/
+/**
+ * Writes ToChromeTraceJson() to path
+ *
+ * @return DCGM_ST_OK on success
+ *         DCGM_ST_GENERIC_ERROR if the file could not be written
+ */
+dcgmReturn_t WriteChromeTrace(std::string const &path);
+
+/*****************************************************************************/
+/**
+ * Writes the trace to DCGM_TRACE_FILE_ENV whenever the process gets DCGM_TRACE_DUMP_SIGNAL.
+ * The file is written by a helper thread since little is safe to do in a signal handler.
+ * Does nothing if it was already started.
+ */
+void StartDumpOnSignal();
+
+/*****************************************************************************/
+/**
+ * Restores the previous handler of DCGM_TRACE_DUMP_SIGNAL and stops the helper thread
+ */
+void StopDumpOnSignal();
+
+/*****************************************************************************/
+/**
+ * Records the span from construction to destruction as one event of the calling thread.
+ *
+ * name and the argument names must be string literals. They are stored by pointer.
+ * Arguments with a null name are left out of the event.
+ *
+ * @code
+ *     DcgmNs::Trace::Scope traceScope("ProcessMessage", "moduleId", moduleId);
+ * @endcode
+ */
+class Scope
+{
+public:
+    explicit Scope(char const *name,
+                   char const *arg0Name = nullptr,
+                   long long arg0       = 0,
+                   char const *arg1Name = nullptr,
+                   long long arg1       = 0)
+        : m_name(Enabled() ? name : nullptr)
+    {
+        if (m_name == nullptr)
+        {
+            return;
+        }
+
+        m_arg0Name  = arg0Name;
+        m_arg0      = arg0;
+        m_arg1Name  = arg1Name;
+        m_arg1      = arg1;
+        m_startUsec = detail::NowUsec();
+    }
+
+    ~Scope()
+    {
+        if (m_name != nullptr)
+        {
+            detail::Record(m_name, m_arg0Name, m_arg0, m_arg1Name, m_arg1, m_startUsec);
+        }
+    }
+
+    Scope(Scope const &)            = delete;
+    Scope &operator=(Scope const &) = delete;
+
+private:
+    char const *m_name; /* Null if recording was off when the scope started */
+    char const *m_arg0Name   = nullptr;
+    long long m_arg0         = 0;
+    char const *m_arg1Name   = nullptr;
+    long long m_arg1         = 0;
+    std::int64_t m_startUsec = 0;
+};
+} // namespace DcgmNs::Trace
@@ -36,6 +36,7 @@
 #include <string>
 #include <sys/epoll.h>
 #include <sys/prctl.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -536,6 +537,29 @@ pid_t ForkAndExecCommand(std::vector<std::string> const &args,
         return -1;
     }
 
+    /* The user lookup may load NSS modules and the argv conversion allocates. Neither is safe after fork() in a
+       multithreaded process, so both are done before forking */
+    std::optional<UserCredentials> newCred;
+    if (userName != nullptr)
+    {
+        try
+        {
+            newCred = GetUserCredentials(userName);
+        }
+        catch (std::exception const &ex)
+        {
+            log_error("Unable to get credentials of service account {}. Ex: {}", userName, ex.what());
+        }
+    }
+
+    // Convert args to argv style char** for execvp
+    std::vector<const char *> argv(args.size() + 1);
+    for (unsigned int i = 0; i < args.size(); i++)
+    {
+        argv[i] = args[i].c_str();
+    }
+    argv[args.size()] = nullptr;
+
     EnableDeathSignalToChildProcesses();
 
     sigset_t signalsBlocked = {};
@@ -658,7 +682,7 @@ pid_t ForkAndExecCommand(std::vector<std::string> const &args,
         {
             try
             {
-                if (auto const newCred = GetUserCredentials(userName); newCred.has_value())
+                if (newCred.has_value())
                 {
                     ChangeUser(ChangeUserPolicy::Permanently, *newCred);
                 }
@@ -689,14 +713,6 @@ pid_t ForkAndExecCommand(std::vector<std::string> const &args,
             }
         }
 
-        // Convert args to argv style char** for execvp
-        std::vector<const char *> argv(args.size() + 1);
-        for (unsigned int i = 0; i < args.size(); i++)
-        {
-            argv[i] = args[i].c_str();
-        }
-        argv[args.size()] = nullptr;
-
         execvp(argv[0], const_cast<char **>(argv.data()));
 
         auto const err = errno;
@@ -985,6 +1001,50 @@ bool IsRunningAsRoot()
     return geteuid() == 0;
 }
 
+std::optional<std::string> EnsureWritableCudaJitCache(std::string const &fallbackDir)
+{
+    if (getenv("CUDA_CACHE_PATH") != nullptr || getenv("CUDA_CACHE_DISABLE") != nullptr)
+    {
+        return std::nullopt;
+    }
+
+    /* CUDA caches in $HOME/.nv/ComputeCache by default */
+    if (char const *home = getenv("HOME"); home != nullptr && home[0] != '\0')
+    {
+        std::string const nvDir = fmt::format("{}/.nv", home);
+        if (access(nvDir.c_str(), W_OK) == 0 || (errno == ENOENT && access(home, W_OK) == 0))
+        {
+            return std::nullopt;
+        }
+    }
+
+    std::string const dir
+        = fallbackDir.empty() ? fmt::format("/tmp/nvidia-dcgm-cuda-cache-{}", geteuid()) : fallbackDir;
+    if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST)
+    {
+        log_warning("Unable to create CUDA JIT cache directory {}. errno {}", dir, errno);
+        return std::nullopt;
+    }
+
+    /* Anyone can create the directory first. Kernels cached by someone else would run in place of ours */
+    struct stat st {};
+    if (lstat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode) || st.st_uid != geteuid()
+        || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+    {
+        log_warning("Not using {} as the CUDA JIT cache. It is not a directory that only we can write to", dir);
+        return std::nullopt;
+    }
+
+    if (setenv("CUDA_CACHE_PATH", dir.c_str(), 0) != 0)
+    {
+        log_warning("Unable to set CUDA_CACHE_PATH. errno {}", errno);
+        return std::nullopt;
+    }
+
+    log_debug("Caching JIT-compiled CUDA kernels in {}", dir);
+    return dir;
+}
+
 bool RunningUserChecker::IsRoot() const
 {
     return IsRunningAsRoot();
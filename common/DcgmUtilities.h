@@ -489,6 +489,19 @@ public:
 
 bool IsRunningAsRoot();
 
+/*************************************************************************/
+/*
+ * Point the CUDA JIT cache at a directory of our own if the default one under $HOME can't be written, as in
+ * containers with a read-only home directory. Without a cache, every run JIT-compiles our PTX kernels again.
+ * Must be called before cuInit(). Does nothing if CUDA_CACHE_PATH or CUDA_CACHE_DISABLE is set.
+ *
+ * @param fallbackDir: (IN) directory to use instead. Empty for /tmp/nvidia-dcgm-cuda-cache-<euid>. It is created
+ *                     if needed and only used if it is a directory that no one but us can write to.
+ *
+ * @return: The directory CUDA_CACHE_PATH was set to, or std::nullopt if the environment was left alone.
+ */
+std::optional<std::string> EnsureWritableCudaJitCache(std::string const &fallbackDir = {});
+
 class RunningUserChecker
 {
 public:
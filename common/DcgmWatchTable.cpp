@@ -19,6 +19,8 @@
 #include "DcgmUtilities.h"
 #include "DcgmWatchTable.h"
 
+#include <algorithm>
+
 /*****************************************************************************/
 DcgmWatchTable::DcgmWatchTable()
     : m_entityWatchHashTable()
@@ -28,6 +30,12 @@ DcgmWatchTable::DcgmWatchTable()
 void DcgmWatchTable::ClearWatches()
 {
     m_entityWatchHashTable.clear();
+    m_connectionWatches.clear();
+
+    for (auto &heap : m_dueWatches)
+    {
+        heap.clear();
+    }
 }
 
 /*****************************************************************************/
@@ -35,9 +43,26 @@ dcgmReturn_t DcgmWatchTable::ClearEntityWatches(dcgm_field_entity_group_t entity
 {
     dcgmReturn_t ret = DCGM_ST_OK;
 
-    DcgmNs::Utils::EraseIf(m_entityWatchHashTable, [&](auto const &pair) {
-        return pair.first.entityGroupId == entityGroupId && pair.first.entityId == entityId;
-    });
+    DcgmNs::Utils::EraseAndNotifyIf(
+        m_entityWatchHashTable,
+        [&](auto const &pair) {
+            return pair.first.entityGroupId == entityGroupId && pair.first.entityId == entityId;
+        },
+        [&](auto const &pair) {
+            for (auto const &watcherInfo : pair.second.watchers)
+            {
+                auto connectionIt = m_connectionWatches.find(watcherInfo.watcher.connectionId);
+                if (connectionIt == m_connectionWatches.end())
+                {
+                    continue;
+                }
+                connectionIt->second.erase(pair.first);
+                if (connectionIt->second.empty())
+                {
+                    m_connectionWatches.erase(connectionIt);
+                }
+            }
+        });
 
     return ret;
 }
@@ -71,8 +96,26 @@ dcgmReturn_t DcgmWatchTable::RemoveConnectionWatches(dcgm_connection_id_t connec
 {
     size_t totalWatchersRemoved = 0;
 
-    for (auto &[watchKey, watchInfo] : m_entityWatchHashTable)
+    auto connectionIt = m_connectionWatches.find(connectionId);
+    if (connectionIt == m_connectionWatches.end())
     {
+        DCGM_LOG_DEBUG << "[WatchTable] connectionId " << connectionId << " did not have any active watchers";
+        return DCGM_ST_OK;
+    }
+
+    /* Only the watches this connection has watchers in need to be visited */
+    std::unordered_set<dcgm_entity_key_t> const watchKeys = std::move(connectionIt->second);
+    m_connectionWatches.erase(connectionIt);
+
+    for (auto const &watchKey : watchKeys)
+    {
+        auto watchIt = m_entityWatchHashTable.find(watchKey);
+        if (watchIt == m_entityWatchHashTable.end())
+        {
+            continue;
+        }
+        dcgm_watch_info_t &watchInfo = watchIt->second;
+
         auto const numOfRemoved = DcgmNs::Utils::EraseIf(
             watchInfo.watchers, [&](auto const &w) { return w.watcher.connectionId == connectionId; });
 
@@ -116,15 +159,30 @@ dcgmReturn_t DcgmWatchTable::RemoveConnectionWatches(dcgm_connection_id_t connec
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+bool DcgmWatchTable::HasConnectionWatches(dcgm_connection_id_t connectionId) const
+{
+    return m_connectionWatches.contains(connectionId);
+}
+
+/*****************************************************************************/
 dcgmReturn_t DcgmWatchTable::RemoveWatches(DcgmWatcher watcher, dcgmPostWatchInfo_t *postWatchInfo)
 {
     dcgm_watcher_info_t watcherInfo;
     watcherInfo.watcher = std::move(watcher);
 
-    for ([[maybe_unused]] auto &[_, watchInfo] : m_entityWatchHashTable)
+    auto connectionIt = m_connectionWatches.find(watcherInfo.watcher.connectionId);
+    if (connectionIt == m_connectionWatches.end())
+    {
+        return DCGM_ST_OK;
+    }
+
+    /* Copied since RemoveWatcher updates m_connectionWatches */
+    std::vector<dcgm_entity_key_t> const watchKeys(connectionIt->second.begin(), connectionIt->second.end());
+    for (auto const &watchKey : watchKeys)
     {
         /* RemoveWatcher will log any failures */
-        RemoveWatcher(watchInfo, watcherInfo, postWatchInfo);
+        RemoveWatcher(m_entityWatchHashTable[watchKey], watcherInfo, postWatchInfo);
     }
 
     return DCGM_ST_OK;
@@ -208,6 +266,7 @@ dcgmReturn_t DcgmWatchTable::RemoveWatcher(dcgm_watch_info_t &watchInfo,
                            << ", connectionId " << watcher.watcher.connectionId;
 
             watchInfo.watchers.erase(it);
+            UnindexConnectionWatch(watchInfo, watcher.watcher.connectionId);
             /* Update the watchInfo interval and quota now that we removed a watcher */
             if (UpdateWatchFromWatchers(watchInfo) == DCGM_ST_NOT_WATCHED)
             {
@@ -263,6 +322,9 @@ dcgmReturn_t DcgmWatchTable::UpdateWatchFromWatchers(dcgm_watch_info_t &watchInf
     watchInfo.maxAgeUsec            = minMaxAgeUsec;
     watchInfo.hasSubscribedWatchers = hasSubscribedWatchers;
 
+    /* With no watchers left, the interval is blank and this unschedules the watch */
+    ScheduleWatch(watchInfo);
+
     if (watched == false)
     {
         watchInfo.hasSubscribedWatchers = 0;
@@ -276,11 +338,56 @@ dcgmReturn_t DcgmWatchTable::UpdateWatchFromWatchers(dcgm_watch_info_t &watchInf
 }
 
 /*****************************************************************************/
-static inline void UpdateNextUpdateTime(timelib64_t &earliestNextUpdate, timelib64_t fieldNextUpdate)
+bool DcgmWatchTable::IsLaterDue(DueEntry const &a, DueEntry const &b)
+{
+    return a.dueUsec > b.dueUsec;
+}
+
+/*****************************************************************************/
+void DcgmWatchTable::ScheduleWatch(dcgm_watch_info_t &watchInfo)
 {
-    if (!(earliestNextUpdate) || fieldNextUpdate < earliestNextUpdate)
+    if (!watchInfo.isWatched || DCGM_INT64_IS_BLANK(watchInfo.updateIntervalUsec))
+    {
+        /* Any entries left in the heaps are now stale */
+        watchInfo.scheduledUsec = DCGM_INT64_BLANK;
+        return;
+    }
+
+    timelib64_t const dueUsec = watchInfo.lastQueriedUsec + watchInfo.updateIntervalUsec;
+    if (dueUsec == watchInfo.scheduledUsec)
+    {
+        return; /* Already in the heaps at this time */
+    }
+
+    watchInfo.scheduledUsec = dueUsec;
+
+    for (unsigned int moduleId = 0; moduleId < DcgmModuleIdCount; moduleId++)
     {
-        earliestNextUpdate = fieldNextUpdate;
+        if (IsFieldIgnored(watchInfo.watchKey.fieldId, static_cast<dcgmModuleId_t>(moduleId)))
+        {
+            continue;
+        }
+
+        std::vector<DueEntry> &heap = m_dueWatches[moduleId];
+        heap.push_back(DueEntry { dueUsec, watchInfo.watchKey });
+        std::push_heap(heap.begin(), heap.end(), IsLaterDue);
+    }
+}
+
+/*****************************************************************************/
+void DcgmWatchTable::DropStaleDueWatches(std::vector<DueEntry> &heap) const
+{
+    while (!heap.empty())
+    {
+        DueEntry const &top = heap.front();
+        auto watchIt        = m_entityWatchHashTable.find(top.watchKey);
+        if (watchIt != m_entityWatchHashTable.end() && watchIt->second.scheduledUsec == top.dueUsec)
+        {
+            return;
+        }
+
+        std::pop_heap(heap.begin(), heap.end(), IsLaterDue);
+        heap.pop_back();
     }
 }
 
@@ -290,34 +397,24 @@ dcgmReturn_t DcgmWatchTable::GetFieldsToUpdate(dcgmModuleId_t currentModule,
                                                std::vector<dcgm_field_update_info_t> &toUpdate,
                                                timelib64_t &earliestNextUpdate)
 {
-    timelib64_t age;
-    timelib64_t nextUpdate;
     dcgm_field_meta_p fieldMeta = 0;
+    std::vector<dcgm_watch_info_t *> queried;
 
     earliestNextUpdate = 0;
 
-    /* Walk the hash table of watch objects, looking for any that have expired */
-    for (auto &[watchkey, watchInfo] : m_entityWatchHashTable)
+    if (currentModule < 0 || currentModule >= DcgmModuleIdCount)
     {
-        if (!watchInfo.isWatched)
-        {
-            continue; /* Not watched */
-        }
+        return DCGM_ST_OK; /* IsFieldIgnored() ignores every field for other modules */
+    }
 
-        /* Some fields are pushed by modules. Don't handle those fields here */
-        if (IsFieldIgnored(watchInfo.watchKey.fieldId, currentModule))
-        {
-            continue;
-        }
+    std::vector<DueEntry> &heap = m_dueWatches[currentModule];
 
-        /* Last sample time old enough to take another? */
-        age = now - watchInfo.lastQueriedUsec;
-        if (age < watchInfo.updateIntervalUsec)
-        {
-            nextUpdate = watchInfo.lastQueriedUsec + watchInfo.updateIntervalUsec;
-            UpdateNextUpdateTime(earliestNextUpdate, nextUpdate);
-            continue; /* Not old enough to update */
-        }
+    /* Pop the watches that are due. Everything left in the heap is in the future */
+    for (DropStaleDueWatches(heap); !heap.empty() && heap.front().dueUsec <= now; DropStaleDueWatches(heap))
+    {
+        dcgm_watch_info_t &watchInfo = m_entityWatchHashTable.find(heap.front().watchKey)->second;
+        std::pop_heap(heap.begin(), heap.end(), IsLaterDue);
+        heap.pop_back();
 
         fieldMeta = DcgmFieldGetById(watchInfo.watchKey.fieldId);
         if (fieldMeta == nullptr)
@@ -330,12 +427,6 @@ dcgmReturn_t DcgmWatchTable::GetFieldsToUpdate(dcgmModuleId_t currentModule,
                        << watchInfo.watchKey.entityGroupId << ", eid " << watchInfo.watchKey.entityId << ", fieldId "
                        << watchInfo.watchKey.fieldId;
 
-        /* Base when we sync again on before the driver call so we don't continuously
-         * get behind by how long the driver call took
-         */
-        nextUpdate = now + watchInfo.updateIntervalUsec;
-        UpdateNextUpdateTime(earliestNextUpdate, nextUpdate);
-
         // At this point we know we want to update the field
         dcgm_field_update_info_t updateInfo;
         updateInfo.entityGroupId      = static_cast<dcgm_field_entity_group_t>(watchInfo.watchKey.entityGroupId);
@@ -344,6 +435,25 @@ dcgmReturn_t DcgmWatchTable::GetFieldsToUpdate(dcgmModuleId_t currentModule,
         updateInfo.updateIntervalUsec = watchInfo.updateIntervalUsec;
         watchInfo.lastQueriedUsec     = now;
         toUpdate.push_back(updateInfo);
+
+        /* Unscheduled until the loop is done so that any duplicate entries are stale and a
+           zero interval can't make it due again in this pass */
+        watchInfo.scheduledUsec = DCGM_INT64_BLANK;
+        queried.push_back(&watchInfo);
+    }
+
+    /* Base when we sync again on before the driver call so we don't continuously
+     * get behind by how long the driver call took
+     */
+    for (dcgm_watch_info_t *watchInfo : queried)
+    {
+        ScheduleWatch(*watchInfo);
+    }
+
+    DropStaleDueWatches(heap);
+    if (!heap.empty())
+    {
+        earliestNextUpdate = heap.front().dueUsec;
     }
 
     return DCGM_ST_OK;
@@ -373,6 +483,7 @@ bool DcgmWatchTable::AddWatcher(dcgm_field_entity_group_t entityGroupId,
         watchInfo.maxAgeUsec         = maxAgeUsec;
         watchInfo.updateIntervalUsec = updateIntervalUsec;
         watchInfo.watchers.push_back(watcherInfo);
+        m_connectionWatches[watcher.connectionId].insert(key);
         watchInfo.lastQueriedUsec = 0; // mark as never having been queried
     }
     else
@@ -389,6 +500,8 @@ bool DcgmWatchTable::AddWatcher(dcgm_field_entity_group_t entityGroupId,
         watchInfo.hasSubscribedWatchers = true;
     }
 
+    ScheduleWatch(watchInfo);
+
     return newWatch;
 }
 
@@ -407,6 +520,31 @@ void DcgmWatchTable::AddWatcherInfoIfNeeded(dcgm_watch_info_t &watchInfo, dcgm_w
 
     // If we reach here, it means we didn't find a match
     watchInfo.watchers.push_back(watcherInfo);
+    m_connectionWatches[watcherInfo.watcher.connectionId].insert(watchInfo.watchKey);
+}
+
+/*****************************************************************************/
+void DcgmWatchTable::UnindexConnectionWatch(dcgm_watch_info_t const &watchInfo, dcgm_connection_id_t connectionId)
+{
+    for (auto const &watcherInfo : watchInfo.watchers)
+    {
+        if (watcherInfo.watcher.connectionId == connectionId)
+        {
+            return; /* Still watched by another watcher of this connection */
+        }
+    }
+
+    auto connectionIt = m_connectionWatches.find(connectionId);
+    if (connectionIt == m_connectionWatches.end())
+    {
+        return;
+    }
+
+    connectionIt->second.erase(watchInfo.watchKey);
+    if (connectionIt->second.empty())
+    {
+        m_connectionWatches.erase(connectionIt);
+    }
 }
 
 /*****************************************************************************/
@@ -429,6 +567,18 @@ timelib64_t DcgmWatchTable::GetMaxAgeUsec(dcgm_field_entity_group_t entityGroupI
     return watchInfo.maxAgeUsec;
 }
 
+/*****************************************************************************/
+void DcgmWatchTable::GetWatchedKeys(dcgmModuleId_t currentModule, std::vector<dcgm_entity_key_t> &watched) const
+{
+    for (auto const &[watchKey, watchInfo] : m_entityWatchHashTable)
+    {
+        if (watchInfo.isWatched && !IsFieldIgnored(watchKey.fieldId, currentModule))
+        {
+            watched.push_back(watchKey);
+        }
+    }
+}
+
 /*****************************************************************************/
 bool DcgmWatchTable::GetIsSubscribed(dcgm_field_entity_group_t entityGroupId,
                                      dcgm_field_eid_t entityId,
@@ -438,10 +588,3 @@ bool DcgmWatchTable::GetIsSubscribed(dcgm_field_entity_group_t entityGroupId,
     dcgm_watch_info_t &watchInfo = m_entityWatchHashTable[key];
     return watchInfo.hasSubscribedWatchers;
 }
-
-/*****************************************************************************/
-// Define the == operator for dcgm_entity_key_t
-bool operator==(const dcgm_entity_key_t &lhs, const dcgm_entity_key_t &rhs)
-{
-    return lhs.fieldId == rhs.fieldId && lhs.entityId == rhs.entityId && lhs.entityGroupId == rhs.entityGroupId;
-}
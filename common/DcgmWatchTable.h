@@ -20,8 +20,12 @@
 #include <hashtable.h>
 #include <timelib.h>
 #include <timeseries.h>
+#include <array>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "DcgmEntityKey.h"
 #include "DcgmMutex.h"
 #include "DcgmWatcher.h"
 
@@ -47,30 +51,6 @@ typedef struct dcgm_watcher_info_t
                                          when this field value updates? */
 } dcgm_watcher_info_t, *dcgm_watcher_info_p;
 
-/*****************************************************************************/
-/* Unique key for a given fieldEntityGroup + entityId + fieldId combination */
-typedef struct
-{
-    dcgm_field_eid_t entityId;    /* Entity ID of this watch */
-    unsigned short fieldId;       /* Field ID of this watch */
-    unsigned short entityGroupId; /* DCGM_FE_? #define of the entity group this
-                                           belongs to */
-} dcgm_entity_key_t;              /* 8 bytes */
-
-// Define the hash function for dcgm_entity_key_t
-namespace std
-{
-template <>
-struct hash<dcgm_entity_key_t>
-{
-    std::size_t operator()(const dcgm_entity_key_t &k) const
-    {
-        return hash<uint64_t>()(static_cast<std::uint64_t>(k.entityId) << 32
-                                | static_cast<std::uint64_t>(k.fieldId) << 16 | k.entityGroupId);
-    }
-};
-} // namespace std
-
 extern const int GLOBAL_WATCH_ENTITY_INDEX;
 
 /*****************************************************************************/
@@ -86,6 +66,7 @@ struct dcgm_watch_info_t
         , lastQueriedUsec(0)
         , updateIntervalUsec(0)
         , maxAgeUsec(0)
+        , scheduledUsec(DCGM_INT64_BLANK)
         , watchers()
     {}
 
@@ -101,6 +82,9 @@ struct dcgm_watch_info_t
     timelib64_t updateIntervalUsec;            /* How often this field should be sampled */
     timelib64_t maxAgeUsec;                    /* Maximum time to cache samples of this
                                            field. If 0, the class default is used */
+    timelib64_t scheduledUsec;                 /* When this watch is due in the watch table's
+                                           due-time index. DCGM_INT64_BLANK if it isn't
+                                           scheduled */
     std::vector<dcgm_watcher_info_t> watchers; /* Info for each watcher of this
                                                   field. updateIntervalUsec and
                                                   maxAgeUsec come from this array */
@@ -162,6 +146,14 @@ public:
      */
     dcgmReturn_t RemoveConnectionWatches(dcgm_connection_id_t connectionId, dcgmPostWatchInfo_t *postWatchInfo);
 
+    /*****************************************************************************/
+    /**
+     * Returns whether any watcher of this connection id is in the table
+     *
+     * @param connectionId[in] - the connection id to look for
+     */
+    bool HasConnectionWatches(dcgm_connection_id_t connectionId) const;
+
     /*****************************************************************************/
     /**
      * Remove all watch info tied to this watcher. If that leaves no further watches, then clear the
@@ -222,6 +214,8 @@ public:
     /**
      * Populates a list of the fields for each entity to update
      *
+     * Only the watches that are due are visited. See m_dueWatches.
+     *
      * @param currentModule[in]       - the module performing this check
      * @param now[in]                 - the current time
      * @param toUpdate[out]           - a list of all the relevant information
@@ -236,6 +230,16 @@ public:
                                    std::vector<dcgm_field_update_info_t> &toUpdate,
                                    timelib64_t &earliestNextUpdate);
 
+    /*****************************************************************************/
+    /**
+     * Gets the keys of every watch that currentModule updates, regardless of
+     * whether it is due for an update
+     *
+     * @param currentModule[in] - the module performing this check
+     * @param watched[out]      - the keys of the watched fields
+     */
+    void GetWatchedKeys(dcgmModuleId_t currentModule, std::vector<dcgm_entity_key_t> &watched) const;
+
     /*****************************************************************************/
     /**
      * Gets the update interval for the specified watch, if it exists
@@ -314,6 +318,50 @@ private:
     // Track per-entity watches of fields
     std::unordered_map<dcgm_entity_key_t, dcgm_watch_info_t> m_entityWatchHashTable;
 
+    /*
+     * Keys of the watches that each connection has a watcher in, so that
+     * RemoveConnectionWatches() and RemoveWatches() only visit the watches of
+     * that connection. Connections without any watchers have no entry.
+     */
+    std::unordered_map<dcgm_connection_id_t, std::unordered_set<dcgm_entity_key_t>> m_connectionWatches;
+
+    /* An entry of the due-time index. Stale once the watch's scheduledUsec no longer matches dueUsec */
+    struct DueEntry
+    {
+        timelib64_t dueUsec;
+        dcgm_entity_key_t watchKey;
+    };
+
+    /*
+     * Per module min-heaps of watches by the time they're next due, so
+     * GetFieldsToUpdate() doesn't walk every watch each cycle. A watch is in
+     * the heap of every module that doesn't ignore its field. Entries are
+     * never removed in place. Stale ones are dropped when they reach the top.
+     */
+    std::array<std::vector<DueEntry>, DcgmModuleIdCount> m_dueWatches;
+
+    /*****************************************************************************/
+    /**
+     * Schedules watchInfo at lastQueriedUsec + updateIntervalUsec in the
+     * due-time index if that changed, or unschedules it if it isn't watched.
+     * NOTE: must be called with m_mutex locked
+     *
+     * @param watchInfo[in/out] - the watch to schedule
+     */
+    void ScheduleWatch(dcgm_watch_info_t &watchInfo);
+
+    /*****************************************************************************/
+    /**
+     * Pops stale entries off the top of heap until the top is a live one
+     *
+     * @param heap[in/out] - one of m_dueWatches
+     */
+    void DropStaleDueWatches(std::vector<DueEntry> &heap) const;
+
+    /*****************************************************************************/
+    /* Comparator for std::push_heap and friends that puts the earliest entry on top */
+    static bool IsLaterDue(DueEntry const &a, DueEntry const &b);
+
     /*****************************************************************************/
     /**
      * Iterates over the watchers in watchInfo and updates intervals and other
@@ -349,4 +397,15 @@ private:
      * @param watcherInfo[in] - what information to add
      */
     void AddWatcherInfoIfNeeded(dcgm_watch_info_t &watchInfo, dcgm_watcher_info_t &watcherInfo);
+
+    /*****************************************************************************/
+    /**
+     * Drops watchInfo from the m_connectionWatches entry of connectionId
+     * unless another of its watchers still belongs to that connection
+     * NOTE: must be called with m_mutex locked
+     *
+     * @param watchInfo[in]    - the watch a watcher of connectionId was removed from
+     * @param connectionId[in] - the connection of the removed watcher
+     */
+    void UnindexConnectionWatch(dcgm_watch_info_t const &watchInfo, dcgm_connection_id_t connectionId);
 };
@@ -175,17 +175,29 @@ EntityMap &operator<<(EntityMap &entityMap, dcgmMigHierarchyInfo_v2 const &info)
     return entityMap;
 }
 
+/**
+ * An entity map and the version of what it was built from
+ */
+struct VersionedEntityMap
+{
+    std::shared_ptr<EntityMap const> entities;
+    std::optional<std::size_t> version; /* Not set if the map is missing entities */
+};
+
 /**
  * Fills in a lookup table for entity ids for GPUs and MIG devices known to the hostengine
  * @param dcgmHandle A handle associated with a live connection to the hostengine.
  * @return A map from ParseResult to entity pairs.
  * @note This function writes to stdout in case of errors
+ * @note The last map is reused while the MIG hierarchy and the list of GPUs stay the same, which saves asking the
+ *       hostengine for the attributes of every GPU.
  */
-[[nodiscard]] static EntityMap PopulateEntitiesMap(dcgmHandle_t dcgmHandle)
+[[nodiscard]] static VersionedEntityMap PopulateEntitiesMap(dcgmHandle_t dcgmHandle)
 {
     using namespace DcgmNs;
 
-    EntityMap entityMap;
+    static std::mutex s_mutex;
+    static VersionedEntityMap s_lastMap;
 
     // Mig Hierarchy
 
@@ -198,14 +210,7 @@ EntityMap &operator<<(EntityMap &entityMap, dcgmMigHierarchyInfo_v2 const &info)
         DCGM_LOG_DEBUG << "Failed to collect MIG hierarchy information. "
                           "EntityIds associated with MIG devices will not be possible to specify. "
                        << "Result: " << ret << " " << errorString(ret);
-    }
-    else
-    {
-        for (size_t idx = 0; idx < migHierarchy.count; ++idx)
-        {
-            auto const &instance = migHierarchy.entityList[idx];
-            entityMap << instance;
-        }
+        migHierarchy.count = 0;
     }
 
     // GPU entities
@@ -223,35 +228,76 @@ EntityMap &operator<<(EntityMap &entityMap, dcgmMigHierarchyInfo_v2 const &info)
                   "Result: {}, {}",
                   ret,
                   errorString(ret));
+        numItems = 0;
     }
-    else
+
+    /* The UUIDs aren't known yet, so the version is of the GPU ids. The handle tells hostengines apart */
+    std::vector<std::pair<unsigned, std::string>> gpuIds;
+    gpuIds.reserve(numItems);
+    for (size_t idx = 0; idx < (size_t)numItems; ++idx)
+    {
+        gpuIds.emplace_back(entities[idx], std::string {});
+    }
+
+    VersionedEntityMap result;
+    result.version = Utils::Hash::CompoundHash(EntityMapVersion(migHierarchy, gpuIds), dcgmHandle);
+
     {
-        for (size_t idx = 0; idx < (size_t)numItems; ++idx)
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (s_lastMap.entities != nullptr && s_lastMap.version == result.version)
         {
-            entityMap.insert_or_assign(ParsedGpu { std::to_string(entities[idx]) },
-                                       dcgmGroupEntityPair_t { DCGM_FE_GPU, entities[idx] });
+            return s_lastMap;
+        }
+    }
 
-            dcgmDeviceAttributes_t deviceAttributes {};
-            deviceAttributes.version = dcgmDeviceAttributes_version3;
+    auto entityMap = std::make_shared<EntityMap>();
+    bool complete  = true;
 
-            ret = dcgmGetDeviceAttributes(dcgmHandle, entities[idx], &deviceAttributes);
-            if (ret != DCGM_ST_OK)
-            {
-                log_error("Unable to collect GPU attributes for GpuId {}"
-                          ". It may be impossible to specify GPU UUID as entity id. "
-                          "Result: {}, {}",
-                          entities[idx],
-                          ret,
-                          errorString(ret));
-                continue;
-            }
+    for (size_t idx = 0; idx < migHierarchy.count; ++idx)
+    {
+        auto const &instance = migHierarchy.entityList[idx];
+        *entityMap << instance;
+    }
+
+    for (size_t idx = 0; idx < (size_t)numItems; ++idx)
+    {
+        entityMap->insert_or_assign(ParsedGpu { std::to_string(entities[idx]) },
+                                    dcgmGroupEntityPair_t { DCGM_FE_GPU, entities[idx] });
 
-            auto const uuid = CutUuidPrefix(deviceAttributes.identifiers.uuid);
-            entityMap.insert_or_assign(ParseInstanceId(uuid), dcgmGroupEntityPair_t { DCGM_FE_GPU, entities[idx] });
+        dcgmDeviceAttributes_t deviceAttributes {};
+        deviceAttributes.version = dcgmDeviceAttributes_version3;
+
+        ret = dcgmGetDeviceAttributes(dcgmHandle, entities[idx], &deviceAttributes);
+        if (ret != DCGM_ST_OK)
+        {
+            log_error("Unable to collect GPU attributes for GpuId {}"
+                      ". It may be impossible to specify GPU UUID as entity id. "
+                      "Result: {}, {}",
+                      entities[idx],
+                      ret,
+                      errorString(ret));
+            complete = false;
+            continue;
         }
+
+        auto const uuid = CutUuidPrefix(deviceAttributes.identifiers.uuid);
+        entityMap->insert_or_assign(ParseInstanceId(uuid), dcgmGroupEntityPair_t { DCGM_FE_GPU, entities[idx] });
     }
 
-    return entityMap;
+    result.entities = std::move(entityMap);
+
+    /* Don't keep a map with missing UUIDs around, nor anything resolved against it. The next call tries again */
+    if (complete)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_lastMap = result;
+    }
+    else
+    {
+        result.version.reset();
+    }
+
+    return result;
 }
 
 /**
@@ -354,11 +400,86 @@ namespace detail
                                                                                              std::string const &ids)
 {
     auto entities = DcgmNs::PopulateEntitiesMap(dcgmHandle);
-    return TryParseEntityList(entities, ids);
+    return EntitySelector::Get(ids)->TryResolve(*entities.entities);
 }
 
 [[nodiscard]] std::tuple<std::vector<dcgmGroupEntityPair_t>, std::string> TryParseEntityList(EntityMap entities,
                                                                                              std::string const &ids)
+{
+    return EntitySelector::Get(ids)->TryResolve(entities);
+}
+
+std::size_t EntityMapVersion(dcgmMigHierarchy_v2 const &migHierarchy,
+                             std::vector<std::pair<unsigned, std::string>> const &gpuIdUuids)
+{
+    using Utils::Hash::CompoundHash;
+
+    std::size_t version = CompoundHash(migHierarchy.count, gpuIdUuids.size());
+    for (size_t idx = 0; idx < migHierarchy.count && idx < DCGM_MAX_HIERARCHY_INFO; ++idx)
+    {
+        auto const &instance = migHierarchy.entityList[idx];
+        version              = CompoundHash(version,
+                                instance.entity.entityGroupId,
+                                instance.entity.entityId,
+                                instance.parent.entityId,
+                                std::string_view { instance.info.gpuUuid },
+                                instance.info.nvmlGpuIndex,
+                                instance.info.nvmlInstanceId,
+                                instance.info.nvmlComputeInstanceId);
+    }
+    for (auto const &[gpuId, uuid] : gpuIdUuids)
+    {
+        version = CompoundHash(version, gpuId, uuid);
+    }
+    return version;
+}
+
+EntitySelector::EntitySelector(std::string_view entityList)
+{
+    auto tokens = Split(entityList, ',');
+    m_tokens.reserve(tokens.size());
+
+    for (auto const &token : tokens)
+    {
+        /// For wildcard cases, we need to understand which part is wildcarded.
+        ///     *       - all GPUs
+        ///     */*     - all MIG GPU instances
+        ///     */*/*   - all Compute Instances
+        ///     To add all possible entities, we will have to specify "*,*/*,*/*/*"
+        ///     0/*     - all GPU instance on GPU 0
+        ///     0/*/0   - all Compute Instances 0 on all GPU Instance on GPU 0
+        m_tokens.push_back(Token { std::string { token }, ParseInstanceId(token) });
+        m_hasCpuWildcard = m_hasCpuWildcard || token.ends_with(":*");
+    }
+}
+
+std::shared_ptr<EntitySelector const> EntitySelector::Get(std::string_view entityList)
+{
+    /* Entity lists usually come from a handful of command lines and config files */
+    constexpr size_t c_maxCachedSelectors = 64;
+
+    static std::mutex s_mutex;
+    static std::unordered_map<std::string, std::shared_ptr<EntitySelector const>> s_selectors;
+
+    std::string key { entityList };
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (auto it = s_selectors.find(key); it != s_selectors.end())
+    {
+        return it->second;
+    }
+
+    if (s_selectors.size() >= c_maxCachedSelectors)
+    {
+        s_selectors.clear();
+    }
+
+    auto selector = std::make_shared<EntitySelector const>(entityList);
+    s_selectors.emplace(std::move(key), selector);
+    return selector;
+}
+
+std::tuple<std::vector<dcgmGroupEntityPair_t>, std::string> EntitySelector::TryResolve(EntityMap const &entities) const
 {
     detail::EntityGroupContainer entityList;
     std::string rejectedIds;
@@ -369,21 +490,11 @@ namespace detail
      */
 
     {
-        auto tokens = Split(ids, ',');
         std::vector<std::string_view> rejectedTokens;
-        rejectedTokens.reserve(tokens.size());
+        rejectedTokens.reserve(m_tokens.size());
 
-        for (auto const &token : tokens)
+        for (auto const &[token, parsedResult] : m_tokens)
         {
-            /// For wildcard cases, we need to understand which part is wildcarded.
-            ///     *       - all GPUs
-            ///     */*     - all MIG GPU instances
-            ///     */*/*   - all Compute Instances
-            ///     To add all possible entities, we will have to specify "*,*/*,*/*/*"
-            ///     0/*     - all GPU instance on GPU 0
-            ///     0/*/0   - all Compute Instances 0 on all GPU Instance on GPU 0
-
-            auto parsedResult = ParseInstanceId(token);
             if (std::holds_alternative<ParsedUnknown>(parsedResult))
             {
                 rejectedTokens.push_back(token);
@@ -444,6 +555,89 @@ namespace detail
     return std::make_tuple(std::move(result), std::move(rejectedIds));
 }
 
+EntitySelector::Fallback const &EntitySelector::GetFallback(std::string const &token) const
+{
+    if (auto it = m_fallbacks.find(token); it != m_fallbacks.end())
+    {
+        return it->second;
+    }
+
+    Fallback fallback;
+    fallback.error = EntityListParser(token, fallback.entityGroups);
+    return m_fallbacks.emplace(token, std::move(fallback)).first->second;
+}
+
+std::string EntitySelector::Resolve(EntityMap const &entities,
+                                    std::optional<std::size_t> version,
+                                    std::vector<dcgmGroupEntityPair_t> &entityGroups) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_hasCpuWildcard && version.has_value() && m_lastVersion == version)
+    {
+        if (m_lastError.empty())
+        {
+            entityGroups.insert(entityGroups.end(), m_lastEntityGroups.begin(), m_lastEntityGroups.end());
+        }
+        return m_lastError;
+    }
+
+    auto [resolved, rejectedIds] = TryResolve(entities);
+
+    /*
+     * Fallback to old method for the rejected ids. EntityListParser() handles a list one token at a time, so each
+     * token's result is kept and reused. Only an empty token depends on the rest of the list.
+     */
+    std::string error;
+    if (!rejectedIds.empty())
+    {
+        auto rejectedTokens = Split(rejectedIds, ',');
+        for (size_t i = 0; i < rejectedTokens.size(); ++i)
+        {
+            std::string const token { rejectedTokens[i] };
+            if (token.empty())
+            {
+                error = fmt::format(
+                    "Error: Comma without a value detected at token {} of input {}", i + 1, rejectedIds);
+                log_error(error);
+                break;
+            }
+
+            if (token.ends_with(":*"))
+            {
+                error = EntityListParser(token, resolved);
+                if (!error.empty())
+                {
+                    break;
+                }
+                continue;
+            }
+
+            /* EntityListParser() logged the error when the fallback was made */
+            auto const &fallback = GetFallback(token);
+            if (!fallback.error.empty())
+            {
+                error = fallback.error;
+                break;
+            }
+            resolved.insert(resolved.end(), fallback.entityGroups.begin(), fallback.entityGroups.end());
+        }
+    }
+
+    if (!m_hasCpuWildcard)
+    {
+        m_lastVersion      = version;
+        m_lastEntityGroups = resolved;
+        m_lastError        = error;
+    }
+
+    if (error.empty())
+    {
+        std::move(begin(resolved), end(resolved), std::back_inserter(entityGroups));
+    }
+    return error;
+}
+
 std::string EntityListParser(std::string const &entityList, std::vector<dcgmGroupEntityPair_t> &entityGroups)
 {
     std::stringstream ss(entityList);
@@ -643,46 +837,40 @@ std::string EntityListWithMigAndUuidParser(dcgmHandle_t dcgmHandle,
                                            std::string const &entityList,
                                            std::vector<dcgmGroupEntityPair_t> &entityGroups)
 {
-    auto [gpuEntities, rejectedIds] = DcgmNs::TryParseEntityList(dcgmHandle, entityList);
-
-    // Fallback to old method
-    std::vector<dcgmGroupEntityPair_t> oldEntityList;
-
-    /* Convert the string to a list of entities */
-    auto err = DcgmNs::EntityListParser(rejectedIds, oldEntityList);
-    if (!err.empty())
-    {
-        return err;
-    }
-
-    std::move(begin(gpuEntities), end(gpuEntities), std::back_inserter(entityGroups));
-    std::move(begin(oldEntityList), end(oldEntityList), std::back_inserter(entityGroups));
-    return "";
+    auto entities = DcgmNs::PopulateEntitiesMap(dcgmHandle);
+    return EntitySelector::Get(entityList)->Resolve(*entities.entities, entities.version, entityGroups);
 }
 
 std::vector<std::uint32_t> ParseEntityIdsAndFilterGpu(dcgmMigHierarchy_v2 const &migHierarchy,
                                                       std::vector<std::pair<unsigned, std::string>> const &gpuIdUuids,
                                                       std::string_view entityIds)
 {
-    DcgmNs::EntityMap entities = DcgmNs::PopulateEntitiesMap(migHierarchy, gpuIdUuids);
+    static std::mutex s_mutex;
+    static std::size_t s_lastVersion = 0;
+    static std::shared_ptr<DcgmNs::EntityMap const> s_lastEntities;
 
-    std::vector<dcgmGroupEntityPair_t> entityGroups;
-    auto [gpuEntities, rejectedIds] = DcgmNs::TryParseEntityList(entities, std::string(entityIds));
-
-    // Fallback to old method
-    std::vector<dcgmGroupEntityPair_t> oldEntityList;
+    /* Only build the entity map again when the hierarchy or the GPUs changed */
+    std::size_t const version = DcgmNs::EntityMapVersion(migHierarchy, gpuIdUuids);
+    std::shared_ptr<DcgmNs::EntityMap const> entities;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (s_lastEntities == nullptr || s_lastVersion != version)
+        {
+            s_lastEntities = std::make_shared<DcgmNs::EntityMap const>(
+                DcgmNs::PopulateEntitiesMap(migHierarchy, gpuIdUuids));
+            s_lastVersion = version;
+        }
+        entities = s_lastEntities;
+    }
 
-    /* Convert the string to a list of entities */
-    auto err = DcgmNs::EntityListParser(rejectedIds, oldEntityList);
+    std::vector<dcgmGroupEntityPair_t> entityGroups;
+    auto err = EntitySelector::Get(entityIds)->Resolve(*entities, version, entityGroups);
     if (!err.empty())
     {
         log_error("failed to parse entity ids: {}", entityIds);
         return {};
     }
 
-    std::move(begin(gpuEntities), end(gpuEntities), std::back_inserter(entityGroups));
-    std::move(begin(oldEntityList), end(oldEntityList), std::back_inserter(entityGroups));
-
     std::vector<std::uint32_t> gpuList;
     gpuList.reserve(DCGM_MAX_NUM_DEVICES);
     for (auto const &entity : entityGroups)
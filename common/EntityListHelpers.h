@@ -15,10 +15,14 @@
  */
 #pragma once
 
+#include "DcgmEntityKey.h"
 #include "DcgmUtilities.h"
 #include "MigIdParser.hpp"
 
 #include <dcgm_structs.h>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -63,7 +67,7 @@ namespace detail
     {
         size_t operator()(dcgmGroupEntityPair_t const &value) const
         {
-            return Utils::Hash::CompoundHash(value.entityGroupId, value.entityId);
+            return HashPackedEntityKey(PackEntityKey(value));
         }
     };
 
@@ -137,6 +141,81 @@ std::string EntityListWithMigAndUuidParser(dcgmHandle_t dcgmHandle,
                                            std::vector<dcgmGroupEntityPair_t> &entityGroups);
 
 
+/**
+ * Computes a version of the inputs an entity map is built from.
+ * Entity maps built by PopulateEntitiesMap() from inputs with the same version are the same, so anything resolved
+ * against one of them is valid for the others.
+ * @param migHierarchy GPU instance hierachy.
+ * @param gpuIdUuids GPU ID and UUID pairs in this system.
+ * @return Hash of the GPU and MIG instance ids and UUIDs.
+ */
+std::size_t EntityMapVersion(dcgmMigHierarchy_v2 const &migHierarchy,
+                             std::vector<std::pair<unsigned, std::string>> const &gpuIdUuids);
+
+/**
+ * An entity list string (e.g. "0,1,{2-3},gpu:4,0/1,cpu:*") split and parsed once, so that it can be resolved against
+ * entity maps any number of times without parsing it again.
+ *
+ * The last resolved entities are kept with the version of the entity map they were resolved against. Resolving the
+ * selector again with the same version returns them without looking anything up.
+ */
+class EntitySelector
+{
+public:
+    explicit EntitySelector(std::string_view entityList);
+
+    /**
+     * Returns the selector for \a entityList, compiling it the first time the string is seen.
+     * Selectors are shared by the whole process, so the cached resolution of an entity list survives between calls.
+     */
+    [[nodiscard]] static std::shared_ptr<EntitySelector const> Get(std::string_view entityList);
+
+    /**
+     * Resolves the GPU and MIG entity ids and UUIDs of the list against \a entities.
+     * @return Same as TryParseEntityList(entities, entityList)
+     */
+    [[nodiscard]] std::tuple<std::vector<dcgmGroupEntityPair_t>, std::string> TryResolve(
+        EntityMap const &entities) const;
+
+    /**
+     * Resolves the whole list, falling back to EntityListParser() for the entities not in \a entities.
+     * @param[in] entities      Entity map to resolve against
+     * @param[in] version       EntityMapVersion() of the inputs \a entities was built from. The result isn't
+     *                          cached if it's not set
+     * @param[out] entityGroups Resolved entities are appended here
+     * @return A string to indicate error message.
+     */
+    std::string Resolve(EntityMap const &entities,
+                        std::optional<std::size_t> version,
+                        std::vector<dcgmGroupEntityPair_t> &entityGroups) const;
+
+private:
+    struct Token
+    {
+        std::string text;
+        ParseResult parsed;
+    };
+
+    /* What EntityListParser() makes of a token the entity map doesn't know */
+    struct Fallback
+    {
+        std::vector<dcgmGroupEntityPair_t> entityGroups;
+        std::string error;
+    };
+
+    std::vector<Token> m_tokens;
+    /* Wildcards like cpu:* depend on the system rather than on the entity map, so they are never cached */
+    bool m_hasCpuWildcard = false;
+
+    mutable std::mutex m_mutex;
+    mutable std::unordered_map<std::string, Fallback> m_fallbacks;
+    mutable std::optional<std::size_t> m_lastVersion;
+    mutable std::vector<dcgmGroupEntityPair_t> m_lastEntityGroups;
+    mutable std::string m_lastError;
+
+    Fallback const &GetFallback(std::string const &token) const;
+};
+
 std::vector<std::uint32_t> ParseEntityIdsAndFilterGpu(dcgmMigHierarchy_v2 const &migHierarchy,
                                                       std::vector<std::pair<unsigned, std::string>> const &gpuIdUuids,
                                                       std::string_view entityIds);
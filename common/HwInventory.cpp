@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HwInventory.h"
+#include "DcgmLogging.h"
+#include "DcgmStringHelpers.h"
+#include "DcgmUtilities.h"
+
+#include <charconv>
+#include <cstdio>
+#include <fcntl.h>
+#include <future>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <json/reader.h>
+#include <json/value.h>
+#include <json/writer.h>
+
+#define HWI_KEY_BOOT_ID             "bootId"
+#define HWI_KEY_NUMA_NODES          "numaNodes"
+#define HWI_KEY_NODE_ID             "nodeId"
+#define HWI_KEY_CPU_LIST            "cpuList"
+#define HWI_KEY_PHYSICAL_PACKAGE_ID "physicalPackageId"
+#define HWI_KEY_CPU_SERIALS         "cpuSerials"
+
+namespace
+{
+
+std::string_view TrimWhitespace(std::string_view value)
+{
+    auto const first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    auto const last = value.find_last_not_of(" \t\r\n");
+    return value.substr(first, last - first + 1);
+}
+
+std::optional<unsigned int> ParseUnsigned(std::string_view value)
+{
+    unsigned int result  = 0;
+    auto const [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (value.empty() || ec != std::errc() || end != value.data() + value.size())
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::string ResolveCachePath()
+{
+    char const *envPath = getenv(DCGM_ENV_HW_INVENTORY_CACHE);
+    return envPath != nullptr ? envPath : HW_INVENTORY_CACHE_PATH;
+}
+
+} // namespace
+
+HwInventory::HwInventory()
+    : HwInventory(std::make_unique<FileSystemOperator>(), std::make_unique<LsHw>(), ResolveCachePath())
+{}
+
+HwInventory::HwInventory(std::unique_ptr<FileSystemOperator> fileSystemOp,
+                         std::unique_ptr<LsHw> lshw,
+                         std::string cachePath)
+    : m_fileSystemOp(std::move(fileSystemOp))
+    , m_lshw(std::move(lshw))
+    , m_cachePath(std::move(cachePath))
+{}
+
+HwInventory &HwInventory::Instance()
+{
+    static HwInventory instance;
+    return instance;
+}
+
+std::shared_ptr<HwInventorySnapshot const> HwInventory::Get()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_snapshot != nullptr)
+    {
+        return m_snapshot;
+    }
+
+    std::string bootId;
+    if (auto const contents = m_fileSystemOp->Read(HW_INVENTORY_BOOT_ID_PATH); contents.has_value())
+    {
+        bootId = TrimWhitespace(*contents);
+    }
+
+    /* Without a boot ID, a cached snapshot could be from another boot */
+    if (!bootId.empty())
+    {
+        if (auto cached = LoadCache(bootId); cached.has_value())
+        {
+            log_debug("Read the hardware inventory from {}", m_cachePath);
+            m_snapshot = std::make_shared<HwInventorySnapshot const>(std::move(*cached));
+            return m_snapshot;
+        }
+    }
+
+    auto snapshot = std::make_shared<HwInventorySnapshot const>(Collect(std::move(bootId)));
+    if (!snapshot->bootId.empty())
+    {
+        StoreCache(*snapshot);
+    }
+    m_snapshot = std::move(snapshot);
+    return m_snapshot;
+}
+
+HwInventorySnapshot HwInventory::Collect(std::string bootId)
+{
+    HwInventorySnapshot snapshot;
+    snapshot.bootId = std::move(bootId);
+
+    /* lshw is by far the slowest part. Scan sysfs while it runs */
+    std::future<std::optional<std::vector<std::string>>> cpuSerials;
+    try
+    {
+        cpuSerials = std::async(std::launch::async, [this] { return m_lshw->GetCpuSerials(); });
+    }
+    catch (std::system_error const &e)
+    {
+        log_debug("Couldn't start a thread for lshw: {}. Running it after the sysfs scan", e.what());
+    }
+
+    std::optional<std::vector<unsigned int>> nodeIds;
+    if (auto const contents = m_fileSystemOp->Read(HW_INVENTORY_NODES_PATH); contents.has_value())
+    {
+        nodeIds = ParseList(TrimWhitespace(*contents));
+    }
+    if (!nodeIds.has_value())
+    {
+        log_error("Couldn't enumerate the NUMA nodes from {}", HW_INVENTORY_NODES_PATH);
+    }
+
+    for (unsigned int nodeId : nodeIds.value_or(std::vector<unsigned int> {}))
+    {
+        HwInventoryNumaNode node;
+        node.nodeId = nodeId;
+
+        std::string const cpuListPath = fmt::format("/sys/devices/system/node/node{}/cpulist", nodeId);
+        if (auto const contents = m_fileSystemOp->Read(cpuListPath); contents.has_value())
+        {
+            node.cpuList = TrimWhitespace(*contents);
+        }
+        else
+        {
+            log_error("Couldn't read {}", cpuListPath);
+        }
+
+        if (auto const cpus = ParseList(node.cpuList); cpus.has_value() && !cpus->empty())
+        {
+            std::string const packagePath
+                = fmt::format("/sys/devices/system/cpu/cpu{}/topology/physical_package_id", cpus->front());
+            if (auto const contents = m_fileSystemOp->Read(packagePath); contents.has_value())
+            {
+                node.physicalPackageId = ParseUnsigned(TrimWhitespace(*contents));
+            }
+        }
+
+        snapshot.numaNodes.push_back(std::move(node));
+    }
+
+    snapshot.cpuSerials = cpuSerials.valid() ? cpuSerials.get() : m_lshw->GetCpuSerials();
+    return snapshot;
+}
+
+std::optional<HwInventorySnapshot> HwInventory::LoadCache(std::string const &bootId) const
+{
+    if (m_cachePath.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto const contents = FileSystemOperator().Read(m_cachePath);
+    if (!contents.has_value())
+    {
+        return std::nullopt;
+    }
+
+    auto snapshot = FromJson(*contents);
+    if (!snapshot.has_value() || snapshot->bootId != bootId)
+    {
+        log_debug("Ignoring the hardware inventory in {}. It doesn't parse or is from another boot", m_cachePath);
+        return std::nullopt;
+    }
+
+    return snapshot;
+}
+
+void HwInventory::StoreCache(HwInventorySnapshot const &snapshot) const
+{
+    /* The snapshot has the CPU serials, which only root can read. Only root writes it, for root */
+    if (m_cachePath.empty() || !DcgmNs::Utils::IsRunningAsRoot())
+    {
+        return;
+    }
+
+    std::string const json    = ToJson(snapshot);
+    std::string const tmpPath = fmt::format("{}.{}", m_cachePath, getpid());
+
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        log_debug("Couldn't create {}. errno {}", tmpPath, errno);
+        return;
+    }
+
+    bool const written = write(fd, json.data(), json.size()) == static_cast<ssize_t>(json.size());
+    close(fd);
+
+    /* Readers see either the old file or the whole new one */
+    if (!written || rename(tmpPath.c_str(), m_cachePath.c_str()) != 0)
+    {
+        log_debug("Couldn't write {}. errno {}", m_cachePath, errno);
+        unlink(tmpPath.c_str());
+    }
+}
+
+std::string HwInventory::ToJson(HwInventorySnapshot const &snapshot)
+{
+    Json::Value root;
+    root[HWI_KEY_BOOT_ID]    = snapshot.bootId;
+    root[HWI_KEY_NUMA_NODES] = Json::Value(Json::arrayValue);
+
+    for (auto const &node : snapshot.numaNodes)
+    {
+        Json::Value jv;
+        jv[HWI_KEY_NODE_ID]  = node.nodeId;
+        jv[HWI_KEY_CPU_LIST] = node.cpuList;
+        if (node.physicalPackageId.has_value())
+        {
+            jv[HWI_KEY_PHYSICAL_PACKAGE_ID] = *node.physicalPackageId;
+        }
+        root[HWI_KEY_NUMA_NODES].append(jv);
+    }
+
+    if (snapshot.cpuSerials.has_value())
+    {
+        root[HWI_KEY_CPU_SERIALS] = Json::Value(Json::arrayValue);
+        for (auto const &serial : *snapshot.cpuSerials)
+        {
+            root[HWI_KEY_CPU_SERIALS].append(serial);
+        }
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, root);
+}
+
+std::optional<HwInventorySnapshot> HwInventory::FromJson(std::string const &json)
+{
+    Json::Reader jsonReader;
+    Json::Value root;
+
+    if (!jsonReader.parse(json, root) || !root.isObject() || !root[HWI_KEY_NUMA_NODES].isArray())
+    {
+        return std::nullopt;
+    }
+
+    HwInventorySnapshot snapshot;
+    try
+    {
+        snapshot.bootId = root[HWI_KEY_BOOT_ID].asString();
+
+        for (auto const &jv : root[HWI_KEY_NUMA_NODES])
+        {
+            HwInventoryNumaNode node;
+            node.nodeId  = jv[HWI_KEY_NODE_ID].asUInt();
+            node.cpuList = jv[HWI_KEY_CPU_LIST].asString();
+            if (jv.isMember(HWI_KEY_PHYSICAL_PACKAGE_ID))
+            {
+                node.physicalPackageId = jv[HWI_KEY_PHYSICAL_PACKAGE_ID].asUInt();
+            }
+            snapshot.numaNodes.push_back(std::move(node));
+        }
+
+        if (root[HWI_KEY_CPU_SERIALS].isArray())
+        {
+            snapshot.cpuSerials.emplace();
+            for (auto const &serial : root[HWI_KEY_CPU_SERIALS])
+            {
+                snapshot.cpuSerials->push_back(serial.asString());
+            }
+        }
+    }
+    catch (std::exception const &e)
+    {
+        log_debug("Unexpected hardware inventory json format: {}", e.what());
+        return std::nullopt;
+    }
+
+    return snapshot;
+}
+
+std::optional<std::vector<unsigned int>> HwInventory::ParseList(std::string_view list)
+{
+    /* Way beyond any CPU or node count. Keeps a corrupt list from taking all the memory */
+    constexpr unsigned int MaxRangeSize = 1 << 20;
+
+    std::vector<unsigned int> values;
+    if (list.empty())
+    {
+        return values;
+    }
+
+    for (auto const range : DcgmNs::Split(list, ','))
+    {
+        auto const firstLast = DcgmNs::Split(range, '-');
+        if (firstLast.size() > 2)
+        {
+            return std::nullopt;
+        }
+
+        auto const first = ParseUnsigned(firstLast.front());
+        auto const last  = ParseUnsigned(firstLast.back());
+        if (!first.has_value() || !last.has_value() || *first > *last || *last - *first > MaxRangeSize)
+        {
+            return std::nullopt;
+        }
+
+        for (unsigned int value = *first; value <= *last; value++)
+        {
+            values.push_back(value);
+        }
+    }
+
+    return values;
+}
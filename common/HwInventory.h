@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "FileSystemOperator.h"
+#include "LsHw.h"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define HW_INVENTORY_BOOT_ID_PATH "/proc/sys/kernel/random/boot_id"
+#define HW_INVENTORY_NODES_PATH   "/sys/devices/system/node/has_cpu"
+#define HW_INVENTORY_CACHE_PATH   "/var/run/nvidia-dcgm-hw-inventory.json"
+
+/* Environment variable with a path to use instead of HW_INVENTORY_CACHE_PATH. Empty to not use a cache file */
+#define DCGM_ENV_HW_INVENTORY_CACHE "DCGM_HW_INVENTORY_CACHE"
+
+/* A NUMA node that has CPUs */
+struct HwInventoryNumaNode
+{
+    unsigned int nodeId = 0;
+    std::string cpuList;                           /* Contents of its cpulist, like "0-15,32-47" */
+    std::optional<unsigned int> physicalPackageId; /* Socket of the first CPU of cpuList, if it could be read */
+
+    bool operator==(HwInventoryNumaNode const &other) const = default;
+};
+
+/* The CPU hardware of this boot. None of it changes until the next reboot */
+struct HwInventorySnapshot
+{
+    std::string bootId;
+    std::vector<HwInventoryNumaNode> numaNodes;         /* Sorted by nodeId */
+    std::optional<std::vector<std::string>> cpuSerials; /* From lshw. Only available to root */
+
+    bool operator==(HwInventorySnapshot const &other) const = default;
+};
+
+/*
+ * Reads the CPU hardware once and shares it with everything in the process
+ * that needs it: sysmon's CPU list and topology, dcgmGetCpuHierarchy_v2 and
+ * the CPU serials that diag reports.
+ *
+ * lshw takes seconds and the sysfs scan grows with the number of NUMA nodes,
+ * so the snapshot is also written to a root-only cache file keyed by the boot
+ * ID. Host engine restarts and the modules, which each have their own copy of
+ * this class, read it from there instead of probing the hardware again.
+ */
+class HwInventory
+{
+public:
+    HwInventory();
+    HwInventory(std::unique_ptr<FileSystemOperator> fileSystemOp, std::unique_ptr<LsHw> lshw, std::string cachePath);
+
+    /*
+     * The inventory of the process, with the real file system and lshw
+     */
+    static HwInventory &Instance();
+
+    /*
+     * Returns the snapshot, reading it from the cache file or the hardware on the first call.
+     * Thread safe. Concurrent first calls wait for a single read
+     */
+    std::shared_ptr<HwInventorySnapshot const> Get();
+
+    /*
+     * (De)serialize a snapshot for the cache file. FromJson returns nullopt if json doesn't parse
+     */
+    static std::string ToJson(HwInventorySnapshot const &snapshot);
+    static std::optional<HwInventorySnapshot> FromJson(std::string const &json);
+
+    /*
+     * Parse a sysfs list like "0-3,8,10-11" into the values it covers, in order.
+     * Returns nullopt if it's malformed
+     */
+    static std::optional<std::vector<unsigned int>> ParseList(std::string_view list);
+
+private:
+    /* Read the snapshot from the hardware. lshw runs on another thread while sysfs is scanned */
+    HwInventorySnapshot Collect(std::string bootId);
+
+    std::optional<HwInventorySnapshot> LoadCache(std::string const &bootId) const;
+    void StoreCache(HwInventorySnapshot const &snapshot) const;
+
+    std::unique_ptr<FileSystemOperator> m_fileSystemOp;
+    std::unique_ptr<LsHw> m_lshw;
+    std::string m_cachePath; /* Empty to not use a cache file */
+
+    std::mutex m_mutex; /* Protects m_snapshot */
+    std::shared_ptr<HwInventorySnapshot const> m_snapshot;
+};
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+
+namespace DcgmNs
+{
+/**
+ * Bounded lock-free Multiple-Producers-Multiple-Consumers queue.
+ *
+ * This is Dmitry Vyukov's array based queue. Each cell carries a sequence number that tells producers and consumers
+ * whether the cell is free for the current lap of the ring, so the only contended operation is one CAS of the
+ * enqueue or dequeue position.
+ *
+ * The queue never blocks and never allocates after construction. Callers that need to wait for items or for free
+ * space have to pair it with their own signalling, like the Semaphore in the TaskRunner.
+ *
+ * @tparam T    A type of the stored objects. It must be move constructible.
+ */
+template <class T>
+class MpmcQueue
+{
+public:
+    /**
+     * Creates a queue.
+     * @param[in] minCapacity   How many objects the queue should hold at least. It's rounded up to a power of two.
+     */
+    explicit MpmcQueue(std::size_t minCapacity)
+        : m_mask(std::bit_ceil(std::max(minCapacity, std::size_t { 2 })) - 1)
+        , m_cells(std::make_unique<Cell[]>(m_mask + 1))
+    {
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(MpmcQueue const &)            = delete;
+    MpmcQueue &operator=(MpmcQueue const &) = delete;
+
+    /**
+     * Adds an object to the end of the queue.
+     * @param[in,out] value     An object to add. It's moved from only if the function succeeds.
+     * @return  true if the object was added
+     *          false if the queue is full. \a value is left intact in this case.
+     */
+    [[nodiscard]] bool TryEnqueue(T &value)
+    {
+        Cell *cell      = nullptr;
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            cell               = &m_cells[pos & m_mask];
+            std::size_t seq    = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)pos;
+
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* The consumers haven't freed this cell from the previous lap yet */
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value.emplace(std::move(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Removes an object from the head of the queue.
+     * @return  The object. Its ownership is transferred to the caller.
+     *          std::nullopt if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> TryDequeue()
+    {
+        Cell *cell      = nullptr;
+        std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            cell               = &m_cells[pos & m_mask];
+            std::size_t seq    = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)(pos + 1);
+
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* No producer has filled this cell yet */
+                return std::nullopt;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> result = std::move(cell->value);
+        cell->value.reset();
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return result;
+    }
+
+    /**
+     * Returns how many objects the queue can hold.
+     */
+    [[nodiscard]] std::size_t GetCapacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /**
+     * Returns the number of objects in the queue.
+     * @note    The value is already stale when it's returned if other threads use the queue, so it should only be used
+     *          as a hint, like for the capacity checks of the TaskRunner.
+     */
+    [[nodiscard]] std::size_t GetApproxSize() const
+    {
+        std::size_t const dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+        std::size_t const enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+private:
+    /* Keep each cell and each position on its own cache line so that producers and consumers don't false share */
+    static constexpr std::size_t CacheLineSize = 64;
+
+    struct alignas(CacheLineSize) Cell
+    {
+        std::atomic_size_t sequence;
+        std::optional<T> value;
+    };
+
+    std::size_t const m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(CacheLineSize) std::atomic_size_t m_enqueuePos { 0 };
+    alignas(CacheLineSize) std::atomic_size_t m_dequeuePos { 0 };
+};
+} // namespace DcgmNs
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "MpmcQueue.hpp"
 #include "Semaphore.hpp"
 #include "Task.hpp"
 #include "ThreadSafeQueue.hpp"
@@ -23,6 +24,8 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -49,6 +52,15 @@ struct UnwrapFutureNestedType<std::future<T>>
 template <class T>
 using UnwrapFutureNestedType_t = typename UnwrapFutureNestedType<T>::type;
 
+/**
+ * Which queue a TaskRunner keeps its scheduled tasks in
+ */
+enum class TaskQueueKind : std::uint8_t
+{
+    Locked,   //!< A ThreadSafeQueue. Every enqueue and every check of the queue size takes the queue mutex
+    LockFree, //!< A MpmcQueue ring. The ThreadSafeQueue is only used for the tasks that don't fit in the ring
+};
+
 /**
  * A class that represents Multiple-Producers-Single-Consumer working queue.
  * Only one thread is running the scheduled tasks and multiple threads can enqueue tasks for execution.
@@ -59,7 +71,11 @@ using UnwrapFutureNestedType_t = typename UnwrapFutureNestedType<T>::type;
 class TaskRunner
 {
 public:
-    TaskRunner()
+    /**
+     * @param[in] queueKind     Which queue to keep the scheduled tasks in. The __DCGM_TASK_RUNNER_LOCK_FREE environment
+     *                          variable set to 1 makes every TaskRunner use TaskQueueKind::LockFree.
+     */
+    explicit TaskRunner(TaskQueueKind queueKind = TaskQueueKind::Locked)
         : m_runInterval(std::chrono::minutes(1))
         , m_runnerSemaphore(std::make_shared<Semaphore>())
         , m_stop(false)
@@ -92,6 +108,19 @@ public:
                     << "Bad value of the __DCGM_TASK_RUNNER_DEBUG environment variable. A 0 or 1 numbers are expected";
             }
         }
+
+        envVar = getenv("__DCGM_TASK_RUNNER_LOCK_FREE");
+        if (envVar != nullptr && std::string_view(envVar) == "1")
+        {
+            queueKind = TaskQueueKind::LockFree;
+        }
+
+        if (queueKind == TaskQueueKind::LockFree)
+        {
+            /* Leave room for continuations and deferred tasks, which don't count against the capacity */
+            m_ring = std::make_unique<MpmcQueue<std::unique_ptr<ITask>>>(
+                std::max(m_queueCapacity.load(std::memory_order_relaxed) * 2, MinRingCapacity));
+        }
     }
 
     virtual ~TaskRunner() = default;
@@ -140,26 +169,10 @@ public:
                 "Enqueueing simple task '{}' for the {:#x} TaskRunner", task->GetName(), (size_t)this);
         }
 
-        if (!isContinuation)
+        if (!isContinuation && GetQueueSize() > m_queueCapacity.load(std::memory_order_relaxed))
         {
-            auto queueHandleRo = m_queue.LockRO();
-            if (queueHandleRo.GetSize() > m_queueCapacity.load(std::memory_order_relaxed))
-            {
-                DCGM_LOG_ERROR << fmt::format(
-                    "Unable to add task {} to the TaskRunner {:#x} queue as the queue is full",
-                    task->GetName(),
-                    (size_t)this);
-                [[maybe_unused]] auto releaseResult = m_runnerSemaphore->Release();
-                if (releaseResult != Semaphore::ReleaseResult::Ok)
-                {
-                    auto const msg = fmt::format(
-                        "Unable to trigger consumers for the TaskRunner {:#x} while the event queue is full",
-                        (size_t)this);
-                    DCGM_LOG_FATAL << msg;
-                    throw std::runtime_error(msg);
-                }
-                return std::nullopt;
-            }
+            OnQueueFull(task->GetName());
+            return std::nullopt;
         }
 
         std::promise<P> prom;
@@ -167,23 +180,12 @@ public:
 
         task->SetPromise(std::move(prom)); /* after this prom is invalid */
 
-        auto queueHandle = m_queue.LockRW();
-        if (!isContinuation && queueHandle.GetSize() > m_queueCapacity.load(std::memory_order::relaxed))
+        std::unique_ptr<ITask> queuedTask = std::move(task);
+        if (!PushTask(queuedTask, !isContinuation))
         {
-            DCGM_LOG_ERROR << fmt::format("Unable to add task {} to the TaskRunner {:#x} queue as the queue is full",
-                                          task->GetName(),
-                                          (size_t)this);
-            [[maybe_unused]] auto releaseResult = m_runnerSemaphore->Release();
-            if (releaseResult != Semaphore::ReleaseResult::Ok)
-            {
-                auto const msg = fmt::format(
-                    "Unable to trigger consumers for the TaskRunner {:#x} while the event queue is full", (size_t)this);
-                DCGM_LOG_FATAL << msg;
-                throw std::runtime_error(msg);
-            }
+            OnQueueFull(queuedTask->GetName());
             return std::nullopt;
         }
-        queueHandle.Enqueue(std::move(task));
         [[maybe_unused]] auto _ = m_runnerSemaphore->Release();
 
         return result;
@@ -240,25 +242,10 @@ public:
             DCGM_LOG_DEBUG << fmt::format(
                 "Enqueueing deferred task '{}' for the {:#x} TaskRunner", task->GetName(), (size_t)this);
         }
+        if (GetQueueSize() > m_queueCapacity.load(std::memory_order_relaxed))
         {
-            auto queueHandleRo = m_queue.LockRO();
-            if (queueHandleRo.GetSize() > m_queueCapacity.load(std::memory_order::relaxed))
-            {
-                DCGM_LOG_ERROR << fmt::format(
-                    "Unable to add task {} to the TaskRunner {:#x} queue as the queue is full",
-                    task->GetName(),
-                    (size_t)this);
-                [[maybe_unused]] auto releaseResult = m_runnerSemaphore->Release();
-                if (releaseResult != Semaphore::ReleaseResult::Ok)
-                {
-                    auto const msg = fmt::format(
-                        "Unable to trigger consumers for the TaskRunner {:#x} while the event queue is full",
-                        (size_t)this);
-                    DCGM_LOG_FATAL << msg;
-                    throw std::runtime_error(msg);
-                }
-                return std::nullopt;
-            }
+            OnQueueFull(task->GetName());
+            return std::nullopt;
         }
 
         std::promise<std::shared_future<T>> contProm;
@@ -267,26 +254,13 @@ public:
         task->SetPromise(std::move(contProm)); /* after this prom is invalid */
         auto taskNameCopy = task->GetName();
 
+        std::unique_ptr<ITask> queuedTask = std::move(task);
+        if (!PushTask(queuedTask, true))
         {
-            auto queueHandle = m_queue.LockRW();
-            if (queueHandle.GetSize() > m_queueCapacity.load(std::memory_order_relaxed))
-            {
-                DCGM_LOG_ERROR << "Unable to add task " << task->GetName() << " to the TaskRunner " << (size_t)this
-                               << " queue as the queue is full";
-                [[maybe_unused]] auto releaseResult = m_runnerSemaphore->Release();
-                if (releaseResult != Semaphore::ReleaseResult::Ok)
-                {
-                    auto const msg = fmt::format(
-                        "Unable to trigger consumers for the TaskRunner {:#x} while the event queue is full",
-                        (size_t)this);
-                    DCGM_LOG_FATAL << msg;
-                    throw std::runtime_error(msg);
-                }
-                return std::nullopt;
-            }
-            queueHandle.Enqueue(std::move(task));
-            [[maybe_unused]] auto _ = m_runnerSemaphore->Release();
+            OnQueueFull(queuedTask->GetName());
+            return std::nullopt;
         }
+        [[maybe_unused]] auto _ = m_runnerSemaphore->Release();
 
         auto continuation = [contFuture = std::move(contFuture)]() mutable -> std::optional<T> {
             if (contFuture.get().wait_for(std::chrono::microseconds(0)) != std::future_status::ready)
@@ -383,34 +357,11 @@ public:
             /*
              * We need to check the queue even if the semaphore has timed out.
              */
-            std::queue<decltype(m_queue)::QueueItemType> tmpTasks;
-            {
-                {
-                    auto queueHandle = m_queue.LockRO();
-                    if (queueHandle.IsEmpty())
-                    {
-                        continue;
-                    }
-                }
-
-                auto queueHandle = m_queue.LockRW();
-                if (m_debugLogging.load(std::memory_order_relaxed))
-                {
-                    DCGM_LOG_DEBUG << "TaskRunner is consuming " << std::to_string(queueHandle.GetSize())
-                                   << " tasks from the queue";
-                }
-
-                tasks.reserve(queueHandle.GetSize());
-                deferredTasks.reserve(queueHandle.GetSize());
-
-                queueHandle.Swap(tmpTasks);
-            }
-
-            while (!tmpTasks.empty())
+            if (!PopAllTasks(tasks))
             {
-                tasks.emplace_back(std::move(tmpTasks.front()));
-                tmpTasks.pop();
+                continue;
             }
+            deferredTasks.reserve(tasks.size());
 
             for (auto &task : tasks)
             {
@@ -449,11 +400,7 @@ public:
 
             if (!deferredTasks.empty())
             {
-                auto queueHandle = m_queue.LockRW();
-                for (auto &task : deferredTasks)
-                {
-                    queueHandle.Enqueue(std::move(task));
-                }
+                PushDeferredTasks(deferredTasks);
                 [[maybe_unused]] auto _ = m_runnerSemaphore->Release();
             }
 
@@ -491,7 +438,153 @@ protected:
     }
 
 private:
+    static constexpr std::size_t MinRingCapacity = 256; //!< Smallest m_ring for TaskQueueKind::LockFree
+
+    /**
+     * Number of tasks in the queue. For TaskQueueKind::LockFree this is approximate.
+     */
+    [[nodiscard]] std::size_t GetQueueSize()
+    {
+        if (!m_ring)
+        {
+            return m_queue.LockRO().GetSize();
+        }
+
+        return m_ring->GetApproxSize() + m_overflowCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Add a task to the end of the queue.
+     * @param[in,out] task          The task. It's moved from only if the function succeeds.
+     * @param[in] checkCapacity     Fail if the queue already holds more than m_queueCapacity tasks.
+     * @return  false if the queue is full. \a task is left intact in this case.
+     */
+    [[nodiscard]] bool PushTask(std::unique_ptr<ITask> &task, bool checkCapacity)
+    {
+        if (!m_ring)
+        {
+            auto queueHandle = m_queue.LockRW();
+            if (checkCapacity && queueHandle.GetSize() > m_queueCapacity.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            queueHandle.Enqueue(std::move(task));
+            return true;
+        }
+
+        if (checkCapacity && GetQueueSize() > m_queueCapacity.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        /*
+         * Once tasks spill over to m_queue, keep adding to it until it's drained so that the tasks of each producer
+         * are still run in order. Consumers always empty m_ring before m_queue.
+         */
+        if (m_overflowCount.load(std::memory_order_acquire) == 0 && m_ring->TryEnqueue(task))
+        {
+            return true;
+        }
+
+        auto queueHandle = m_queue.LockRW();
+        queueHandle.Enqueue(std::move(task));
+        m_overflowCount.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Put back tasks that are not ready yet. They don't count against the queue capacity.
+     */
+    void PushDeferredTasks(std::vector<std::unique_ptr<ITask>> &deferredTasks)
+    {
+        if (!m_ring)
+        {
+            auto queueHandle = m_queue.LockRW();
+            for (auto &task : deferredTasks)
+            {
+                queueHandle.Enqueue(std::move(task));
+            }
+            return;
+        }
+
+        for (auto &task : deferredTasks)
+        {
+            [[maybe_unused]] bool const pushed = PushTask(task, false);
+        }
+    }
+
+    /**
+     * Move every task in the queue to the end of \a tasks.
+     * @return  false if the queue was empty
+     */
+    bool PopAllTasks(std::vector<std::unique_ptr<ITask>> &tasks)
+    {
+        std::queue<decltype(m_queue)::QueueItemType> tmpTasks;
+
+        if (m_ring)
+        {
+            while (auto task = m_ring->TryDequeue())
+            {
+                tasks.emplace_back(std::move(*task));
+            }
+
+            if (m_overflowCount.load(std::memory_order_acquire) > 0)
+            {
+                auto queueHandle = m_queue.LockRW();
+                m_overflowCount.fetch_sub(queueHandle.GetSize(), std::memory_order_relaxed);
+                queueHandle.Swap(tmpTasks);
+            }
+        }
+        else
+        {
+            {
+                auto queueHandle = m_queue.LockRO();
+                if (queueHandle.IsEmpty())
+                {
+                    return false;
+                }
+            }
+
+            auto queueHandle = m_queue.LockRW();
+            tasks.reserve(queueHandle.GetSize());
+            queueHandle.Swap(tmpTasks);
+        }
+
+        while (!tmpTasks.empty())
+        {
+            tasks.emplace_back(std::move(tmpTasks.front()));
+            tmpTasks.pop();
+        }
+
+        if (!tasks.empty() && m_debugLogging.load(std::memory_order_relaxed))
+        {
+            DCGM_LOG_DEBUG << "TaskRunner is consuming " << std::to_string(tasks.size()) << " tasks from the queue";
+        }
+
+        return !tasks.empty();
+    }
+
+    /**
+     * Report that the task named \a taskName could not be added to the full queue.
+     * Consumers are woken up so that they drain the queue.
+     */
+    void OnQueueFull(char const *taskName)
+    {
+        DCGM_LOG_ERROR << fmt::format(
+            "Unable to add task {} to the TaskRunner {:#x} queue as the queue is full", taskName, (size_t)this);
+        [[maybe_unused]] auto releaseResult = m_runnerSemaphore->Release();
+        if (releaseResult != Semaphore::ReleaseResult::Ok)
+        {
+            auto const msg = fmt::format(
+                "Unable to trigger consumers for the TaskRunner {:#x} while the event queue is full", (size_t)this);
+            DCGM_LOG_FATAL << msg;
+            throw std::runtime_error(msg);
+        }
+    }
+
     ThreadSafeQueue<std::unique_ptr<ITask>> m_queue;      //!< A queue of scheduled tasks. Thread Safe.
+                                                          //!< With TaskQueueKind::LockFree, only holds the tasks
+                                                          //!< that didn't fit in m_ring.
     std::atomic<std::chrono::milliseconds> m_runInterval; //!< How long a worker will wait for a new task signal.
     std::shared_ptr<Semaphore> m_runnerSemaphore;         //!< Signals if there is new task in the queue.
     std::atomic_bool m_stop;                              //!< Signals that the task runner should stop its work.
@@ -502,6 +595,10 @@ private:
     std::atomic_size_t m_queueCapacity = 100; //!< How many events can be stored in the queue.
                                               //!< Attempt to add more events will fail.
                                               //!< Can be overridden by env variable __DCGM_TASK_RUNNER_QUEUE_SIZE
+
+    std::unique_ptr<MpmcQueue<std::unique_ptr<ITask>>> m_ring; //!< Lock-free queue of scheduled tasks.
+                                                               //!< nullptr unless TaskQueueKind::LockFree.
+    std::atomic_size_t m_overflowCount = 0; //!< Number of tasks in m_queue with TaskQueueKind::LockFree
 };
 
 } // namespace DcgmNs
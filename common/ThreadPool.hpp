@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include <pthread.h>
@@ -32,13 +33,18 @@ namespace DcgmNs
 class ThreadPool
 {
 public:
-    explicit ThreadPool(std::size_t numOfWorkers)
+    /*
+     * threadName is given to every worker so that they can be told apart in gdb and in
+     * /proc/<pid>/task. Linux limits thread names to 15 characters, longer names are truncated
+     */
+    explicit ThreadPool(std::size_t numOfWorkers, std::string threadName = "thread_pool")
         : m_shouldStop(false)
         , m_numOfWorkers(numOfWorkers)
     {
-        std::stringstream ss;
-        ss << "Worker of a ThreadPool at 0x" << std::hex << this;
-        const std::string threadName = ss.str();
+        if (threadName.size() > 15)
+        {
+            threadName.resize(15);
+        }
 
         m_threads.reserve(numOfWorkers);
         for (std::size_t i = 0; i < numOfWorkers; ++i)
@@ -150,7 +156,7 @@ private:
         }
     };
 
-    DcgmNs::TaskRunner m_runner;
+    DcgmNs::TaskRunner m_runner { TaskQueueKind::LockFree }; /* Every worker consumes from it */
 
     std::vector<WorkingThread> m_threads;
     std::atomic_bool m_shouldStop;
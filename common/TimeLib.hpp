@@ -55,4 +55,90 @@ template <typename TChronoResult>
     return std::chrono::duration_cast<std::chrono::microseconds>(value.time_since_epoch()).count();
 }
 
+/**
+ * @brief Returns how many milliseconds passed since \a start on the monotonic clock. Used to time start-up phases.
+ * @param[in] start     Time point taken with std::chrono::steady_clock::now().
+ * @return Whole milliseconds since \a start.
+ */
+[[nodiscard]] inline std::int64_t MillisecondsSince(std::chrono::steady_clock::time_point start) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Timestamps for a loop that takes many of them per cycle, like the cache manager's update loop.
+ *
+ * StartCycle() reads the wall clock once and anchors it to the monotonic clock. Now() is that anchor plus the
+ * monotonic time elapsed since, so the timestamps of a cycle never go backwards and the intervals between them are
+ * immune to wall clock steps. Outside of a cycle, Now() reads the wall clock.
+ *
+ * CLOCK_MONOTONIC_COARSE is not used since its resolution of a scheduler tick is too coarse to time driver calls.
+ *
+ * The class is trivial so that it can be part of structures cleared with memset. All zeros is stopped.
+ */
+class CycleClock
+{
+public:
+    /**
+     * @brief Starts a cycle.
+     * @return Legacy timestamp of the start of the cycle.
+     */
+    std::int64_t StartCycle() noexcept
+    {
+        m_anchorUsec       = ToLegacyTimestamp(Timelib::Now());
+        m_anchorSteadyNsec = SteadyNsec();
+        m_fixed            = false;
+        return m_anchorUsec;
+    }
+
+    /**
+     * @brief Starts a cycle in which Now() always returns timestampUsec, so that samples taken by several
+     *        threads share one timestamp.
+     */
+    void StartFixedCycle(std::int64_t timestampUsec) noexcept
+    {
+        m_anchorUsec       = timestampUsec;
+        m_anchorSteadyNsec = 0;
+        m_fixed            = true;
+    }
+
+    /**
+     * @brief Ends the cycle. Now() reads the wall clock until the next StartCycle().
+     */
+    void Stop() noexcept
+    {
+        m_anchorUsec       = 0;
+        m_anchorSteadyNsec = 0;
+        m_fixed            = false;
+    }
+
+    /**
+     * @brief Returns the current legacy timestamp.
+     */
+    [[nodiscard]] std::int64_t Now() const noexcept
+    {
+        if (m_anchorUsec == 0)
+        {
+            return ToLegacyTimestamp(Timelib::Now());
+        }
+        if (m_fixed)
+        {
+            return m_anchorUsec;
+        }
+        return m_anchorUsec + (SteadyNsec() - m_anchorSteadyNsec) / 1000;
+    }
+
+private:
+    static std::int64_t SteadyNsec() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    std::int64_t m_anchorUsec;       //!< Wall clock at the start of the cycle. 0 = stopped
+    std::int64_t m_anchorSteadyNsec; //!< Monotonic clock at the start of the cycle
+    bool m_fixed;                    //!< Does Now() return m_anchorUsec? See StartFixedCycle()
+};
+
 } // namespace DcgmNs::Timelib
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <pthread.h>
+
+
+namespace DcgmNs
+{
+/**
+ * Thread pool where every worker has its own queues instead of all of them sharing one.
+ *
+ * Tasks given to Enqueue(func) are spread over the workers round-robin. A worker that runs out of its own tasks steals
+ * the newest task of another worker, so a burst that lands on one worker doesn't leave the others idle.
+ *
+ * Tasks given to Enqueue(affinityKey, func) always go to the worker affinityKey % GetNumWorkers() and are never
+ * stolen. Tasks with the same key therefore run one at a time, in the order they were enqueued, without the caller
+ * having to lock anything. The price is that they wait for that worker even if others are idle.
+ *
+ * The only locks are the per-worker ones. A producer takes the lock of the worker it enqueues to, and a thief the lock
+ * of the worker it steals from.
+ */
+class WorkStealingThreadPool
+{
+public:
+    /*
+     * threadName is given to every worker so that they can be told apart in gdb and in
+     * /proc/<pid>/task. Linux limits thread names to 15 characters, longer names are truncated.
+     * onWorkerStart, if given, is run by every worker before it takes its first task
+     */
+    explicit WorkStealingThreadPool(std::size_t numOfWorkers,
+                                    std::string threadName             = "ws_thread_pool",
+                                    std::function<void()> onWorkerStart = {})
+        : m_workers(std::max(numOfWorkers, std::size_t { 1 }))
+    {
+        if (threadName.size() > 15)
+        {
+            threadName.resize(15);
+        }
+
+        /* All the workers have to exist before any thread starts looking for something to steal */
+        for (std::size_t i = 0; i < m_workers.size(); ++i)
+        {
+            m_workers[i].thread = std::thread([this, i, onWorkerStart]() {
+                if (onWorkerStart)
+                {
+                    onWorkerStart();
+                }
+                Run(i);
+            });
+            pthread_setname_np(m_workers[i].thread.native_handle(), threadName.c_str());
+        }
+    }
+
+    WorkStealingThreadPool(WorkStealingThreadPool const &)            = delete;
+    WorkStealingThreadPool &operator=(WorkStealingThreadPool const &) = delete;
+
+    /*
+     * Stop accepting tasks and tell the workers to exit once they finish what they are running now.
+     * Tasks that haven't started are dropped and their futures get std::future_errc::broken_promise
+     */
+    void Stop()
+    {
+        m_stop.store(true);
+        for (auto &worker : m_workers)
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.wakeUp.notify_all();
+        }
+    }
+
+    void StopAndWait()
+    {
+        Stop();
+
+        for (auto &worker : m_workers)
+        {
+            if (worker.thread.joinable())
+            {
+                worker.thread.join();
+            }
+        }
+
+        for (auto &worker : m_workers)
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.pinned.clear();
+            worker.shared.clear();
+        }
+    }
+
+    ~WorkStealingThreadPool()
+    {
+        try
+        {
+            StopAndWait();
+        }
+        catch (std::exception &e)
+        {
+            std::cerr << "Caught exception in ~WorkStealingThreadPool. Swallowing " << e.what() << std::endl;
+        }
+    }
+
+    [[nodiscard]] std::size_t GetNumWorkers() const
+    {
+        return m_workers.size();
+    }
+
+    /* How many tasks were run by a worker other than the one they were given to */
+    [[nodiscard]] std::uint64_t GetStealCount() const
+    {
+        return m_steals.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Queue func on the next worker in turn. Any idle worker may end up running it.
+     *
+     * Returns std::nullopt if the pool is stopped
+     */
+    template <std::invocable Func>
+    auto Enqueue(Func func) -> std::optional<std::shared_future<std::invoke_result_t<Func>>>
+    {
+        std::size_t const index = m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+        return Push(index, false, std::move(func));
+    }
+
+    /*
+     * Queue func on the worker that owns affinityKey. Tasks with the same key run in the order they were queued and
+     * never at the same time.
+     *
+     * Returns std::nullopt if the pool is stopped
+     */
+    template <std::invocable Func>
+    auto Enqueue(std::size_t affinityKey, Func func) -> std::optional<std::shared_future<std::invoke_result_t<Func>>>
+    {
+        return Push(affinityKey % m_workers.size(), true, std::move(func));
+    }
+
+private:
+    class Job
+    {
+    public:
+        virtual ~Job()     = default;
+        virtual void Run() = 0;
+    };
+
+    template <class R>
+    class PackagedJob : public Job
+    {
+    public:
+        template <class Func>
+        explicit PackagedJob(Func &&func)
+            : m_task(std::forward<Func>(func))
+        {}
+
+        void Run() override
+        {
+            m_task();
+        }
+
+        std::shared_future<R> GetFuture()
+        {
+            return m_task.get_future().share();
+        }
+
+    private:
+        std::packaged_task<R()> m_task;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex; /* Protects pinned and shared */
+        std::condition_variable wakeUp;
+        std::deque<std::unique_ptr<Job>> pinned; /* Only this worker runs these, oldest first */
+        std::deque<std::unique_ptr<Job>> shared; /* This worker takes the oldest, thieves the newest */
+        bool preferPinned = true;                /* Alternate between the two deques so neither starves */
+        std::atomic_bool sleeping { false };
+        std::thread thread;
+    };
+
+    std::vector<Worker> m_workers;
+    std::atomic_bool m_stop { false };
+    std::atomic_size_t m_nextWorker { 0 };
+    std::atomic_size_t m_stealable { 0 }; /* Number of tasks in all shared deques */
+    std::atomic_uint64_t m_steals { 0 };
+
+    template <class Func>
+    auto Push(std::size_t index, bool pinned, Func func) -> std::optional<std::shared_future<std::invoke_result_t<Func>>>
+    {
+        using R = std::invoke_result_t<Func>;
+
+        if (m_stop.load())
+        {
+            return std::nullopt;
+        }
+
+        auto job    = std::make_unique<PackagedJob<R>>(std::move(func));
+        auto result = job->GetFuture();
+
+        Worker &worker = m_workers[index];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (pinned)
+            {
+                worker.pinned.push_back(std::move(job));
+            }
+            else
+            {
+                worker.shared.push_back(std::move(job));
+                m_stealable.fetch_add(1);
+            }
+        }
+        worker.wakeUp.notify_one();
+
+        if (!pinned)
+        {
+            WakeUpThief(index);
+        }
+
+        return result;
+    }
+
+    /* Wake one sleeping worker other than index so it can steal a task that index may be too busy to get to */
+    void WakeUpThief(std::size_t index)
+    {
+        for (std::size_t i = 1; i < m_workers.size(); ++i)
+        {
+            Worker &other = m_workers[(index + i) % m_workers.size()];
+            if (other.sleeping.load())
+            {
+                /* Taking the lock makes sure the worker is waiting already or will see m_stealable before it waits */
+                std::lock_guard<std::mutex> lock(other.mutex);
+                other.wakeUp.notify_one();
+                return;
+            }
+        }
+    }
+
+    std::unique_ptr<Job> PopOwn(Worker &worker)
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+
+        bool const takePinned = !worker.pinned.empty() && (worker.preferPinned || worker.shared.empty());
+        worker.preferPinned   = !takePinned;
+
+        std::unique_ptr<Job> job;
+        if (takePinned)
+        {
+            job = std::move(worker.pinned.front());
+            worker.pinned.pop_front();
+        }
+        else if (!worker.shared.empty())
+        {
+            job = std::move(worker.shared.front());
+            worker.shared.pop_front();
+            m_stealable.fetch_sub(1);
+        }
+        return job;
+    }
+
+    std::unique_ptr<Job> Steal(std::size_t thiefIndex)
+    {
+        for (std::size_t i = 1; i < m_workers.size() && m_stealable.load() > 0; ++i)
+        {
+            Worker &victim = m_workers[(thiefIndex + i) % m_workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.shared.empty())
+            {
+                auto job = std::move(victim.shared.back());
+                victim.shared.pop_back();
+                m_stealable.fetch_sub(1);
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void Run(std::size_t index)
+    {
+        Worker &self = m_workers[index];
+
+        while (!m_stop.load())
+        {
+            auto job = PopOwn(self);
+            if (job == nullptr)
+            {
+                job = Steal(index);
+            }
+
+            if (job != nullptr)
+            {
+                job->Run();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(self.mutex);
+            self.sleeping.store(true);
+            self.wakeUp.wait(lock, [this, &self] {
+                return m_stop.load() || !self.pinned.empty() || !self.shared.empty() || m_stealable.load() > 0;
+            });
+            self.sleeping.store(false);
+        }
+    }
+};
+
+} // namespace DcgmNs
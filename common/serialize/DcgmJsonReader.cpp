@@ -0,0 +1,505 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DcgmJsonReader.hpp"
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <limits>
+#include <utility>
+
+
+namespace DcgmNs::JsonSerialize
+{
+
+namespace
+{
+int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool IsNumberChar(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+/* Accepted like Json::CharReaderBuilder's allowSpecialFloats */
+constexpr std::pair<std::string_view, double> c_specialFloats[] = {
+    { "NaN", std::numeric_limits<double>::quiet_NaN() },
+    { "Infinity", std::numeric_limits<double>::infinity() },
+    { "-Infinity", -std::numeric_limits<double>::infinity() },
+};
+
+void AppendUtf8(std::string &out, unsigned int codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        out.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+} // namespace
+
+JsonReader::JsonReader(std::string_view json)
+    : m_json(json)
+{}
+
+JsonToken JsonReader::Next()
+{
+    if (m_hasPeeked)
+    {
+        m_hasPeeked = false;
+        return m_peeked;
+    }
+    return ReadToken();
+}
+
+JsonToken JsonReader::Peek()
+{
+    if (!m_hasPeeked)
+    {
+        m_peeked    = ReadToken();
+        m_hasPeeked = true;
+    }
+    return m_peeked;
+}
+
+bool JsonReader::SkipValue()
+{
+    switch (Next())
+    {
+        case JsonToken::StartObject:
+        case JsonToken::StartArray:
+            return SkipRest();
+
+        case JsonToken::String:
+        case JsonToken::Number:
+        case JsonToken::Bool:
+        case JsonToken::Null:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool JsonReader::SkipRest()
+{
+    size_t const depth = m_stack.size();
+    while (m_stack.size() >= depth)
+    {
+        JsonToken const token = Next();
+        if (token == JsonToken::Error || token == JsonToken::End)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+JsonToken JsonReader::Fail(std::string_view why)
+{
+    if (m_error.empty())
+    {
+        m_error = fmt::format("{} at offset {}", why, m_pos);
+    }
+    return JsonToken::Error;
+}
+
+bool JsonReader::SkipWhitespaceAndComments()
+{
+    while (m_pos < m_json.size())
+    {
+        char const c = m_json[m_pos];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        {
+            m_pos++;
+        }
+        else if (c == '/' && m_pos + 1 < m_json.size() && m_json[m_pos + 1] == '/')
+        {
+            size_t const end = m_json.find('\n', m_pos);
+            m_pos            = end == std::string_view::npos ? m_json.size() : end + 1;
+        }
+        else if (c == '/' && m_pos + 1 < m_json.size() && m_json[m_pos + 1] == '*')
+        {
+            size_t const end = m_json.find("*/", m_pos + 2);
+            if (end == std::string_view::npos)
+            {
+                return false;
+            }
+            m_pos = end + 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+void JsonReader::AfterValue()
+{
+    m_expect = m_stack.empty() ? Expect::Done : Expect::CommaOrEnd;
+}
+
+JsonToken JsonReader::ReadToken()
+{
+    if (!m_error.empty())
+    {
+        return JsonToken::Error;
+    }
+
+    if (!SkipWhitespaceAndComments())
+    {
+        return Fail("Unterminated comment");
+    }
+
+    if (m_pos == m_json.size())
+    {
+        return m_expect == Expect::Done ? JsonToken::End : Fail("Unexpected end of JSON");
+    }
+
+    char const c = m_json[m_pos];
+    switch (m_expect)
+    {
+        case Expect::Done:
+            return Fail("Unexpected text after the JSON value");
+
+        case Expect::Value:
+            return ReadValue();
+
+        case Expect::FirstValueOrEnd:
+            if (c == ']')
+            {
+                m_pos++;
+                return Close(']');
+            }
+            return ReadValue();
+
+        case Expect::KeyOrEnd:
+            if (c == '}')
+            {
+                m_pos++;
+                return Close('}');
+            }
+            if (c != '"' && c != '\'')
+            {
+                return Fail("Expected a key");
+            }
+            if (ReadString(JsonToken::Key) == JsonToken::Error)
+            {
+                return JsonToken::Error;
+            }
+            if (!SkipWhitespaceAndComments() || m_pos == m_json.size() || m_json[m_pos] != ':')
+            {
+                return Fail("Expected ':' after a key");
+            }
+            m_pos++;
+            m_expect = Expect::Value;
+            return JsonToken::Key;
+
+        case Expect::CommaOrEnd:
+            m_pos++;
+            if (c == ',')
+            {
+                /* A trailing comma is allowed, so the next token may still close the object or array */
+                m_expect = m_stack.back() == '{' ? Expect::KeyOrEnd : Expect::FirstValueOrEnd;
+                return ReadToken();
+            }
+            if (c == '}' || c == ']')
+            {
+                return Close(c);
+            }
+            m_pos--;
+            return Fail("Expected ',' or the end of an object or array");
+    }
+
+    return Fail("Unexpected state");
+}
+
+JsonToken JsonReader::Close(char close)
+{
+    char const open = close == '}' ? '{' : '[';
+    if (m_stack.empty() || m_stack.back() != open)
+    {
+        return Fail(fmt::format("Unexpected '{}'", close));
+    }
+
+    m_stack.pop_back();
+    AfterValue();
+    return close == '}' ? JsonToken::EndObject : JsonToken::EndArray;
+}
+
+JsonToken JsonReader::ReadValue()
+{
+    char const c = m_json[m_pos];
+    switch (c)
+    {
+        case '{':
+            m_pos++;
+            m_stack.push_back('{');
+            m_expect = Expect::KeyOrEnd;
+            return JsonToken::StartObject;
+
+        case '[':
+            m_pos++;
+            m_stack.push_back('[');
+            m_expect = Expect::FirstValueOrEnd;
+            return JsonToken::StartArray;
+
+        case '"':
+        case '\'':
+            if (ReadString(JsonToken::String) == JsonToken::Error)
+            {
+                return JsonToken::Error;
+            }
+            AfterValue();
+            return JsonToken::String;
+
+        case 't':
+        case 'f':
+        case 'n':
+            return ReadLiteral();
+
+        default:
+            if (c == '-' || c == 'N' || c == 'I' || (c >= '0' && c <= '9'))
+            {
+                return ReadNumber();
+            }
+            return Fail(fmt::format("Unexpected character '{}'", c));
+    }
+}
+
+JsonToken JsonReader::ReadString(JsonToken token)
+{
+    char const quote = m_json[m_pos++];
+    size_t const start = m_pos;
+
+    /* Most strings have no escapes and are returned in place */
+    while (m_pos < m_json.size() && m_json[m_pos] != quote && m_json[m_pos] != '\\')
+    {
+        m_pos++;
+    }
+    if (m_pos == m_json.size())
+    {
+        return Fail("Unterminated string");
+    }
+    if (m_json[m_pos] == quote)
+    {
+        m_string = m_json.substr(start, m_pos - start);
+        m_pos++;
+        return token;
+    }
+
+    m_unescaped.assign(m_json.substr(start, m_pos - start));
+    while (m_pos < m_json.size() && m_json[m_pos] != quote)
+    {
+        char const c = m_json[m_pos++];
+        if (c != '\\')
+        {
+            m_unescaped.push_back(c);
+            continue;
+        }
+        if (m_pos == m_json.size())
+        {
+            break;
+        }
+
+        char const escaped = m_json[m_pos++];
+        switch (escaped)
+        {
+            case '"':
+            case '\'':
+            case '\\':
+            case '/':
+                m_unescaped.push_back(escaped);
+                break;
+            case 'b':
+                m_unescaped.push_back('\b');
+                break;
+            case 'f':
+                m_unescaped.push_back('\f');
+                break;
+            case 'n':
+                m_unescaped.push_back('\n');
+                break;
+            case 'r':
+                m_unescaped.push_back('\r');
+                break;
+            case 't':
+                m_unescaped.push_back('\t');
+                break;
+            case 'u':
+            {
+                auto readHex4 = [this](unsigned int &value) {
+                    if (m_pos + 4 > m_json.size())
+                    {
+                        return false;
+                    }
+                    value = 0;
+                    for (int i = 0; i < 4; i++)
+                    {
+                        int const digit = HexDigit(m_json[m_pos++]);
+                        if (digit < 0)
+                        {
+                            return false;
+                        }
+                        value = value * 16 + digit;
+                    }
+                    return true;
+                };
+
+                unsigned int codePoint = 0;
+                if (!readHex4(codePoint))
+                {
+                    return Fail("Invalid \\u escape");
+                }
+                /* A high surrogate must be followed by the low one */
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                {
+                    unsigned int low = 0;
+                    if (m_json.substr(m_pos, 2) != "\\u")
+                    {
+                        return Fail("Missing low surrogate");
+                    }
+                    m_pos += 2;
+                    if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                    {
+                        return Fail("Invalid low surrogate");
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                AppendUtf8(m_unescaped, codePoint);
+                break;
+            }
+            default:
+                return Fail(fmt::format("Invalid escape '\\{}'", escaped));
+        }
+    }
+    if (m_pos == m_json.size())
+    {
+        return Fail("Unterminated string");
+    }
+
+    m_pos++;
+    m_string = m_unescaped;
+    return token;
+}
+
+JsonToken JsonReader::ReadNumber()
+{
+    std::string_view const rest = m_json.substr(m_pos);
+    for (auto const &[text, value] : c_specialFloats)
+    {
+        if (rest.starts_with(text))
+        {
+            m_pos += text.size();
+            m_isInt64 = false;
+            m_double  = value;
+            AfterValue();
+            return JsonToken::Number;
+        }
+    }
+
+    size_t length = 0;
+    bool isInt    = true;
+    while (length < rest.size() && IsNumberChar(rest[length]))
+    {
+        isInt = isInt && rest[length] != '.' && rest[length] != 'e' && rest[length] != 'E';
+        length++;
+    }
+
+    char const *begin = rest.data();
+    char const *end   = begin + length;
+
+    m_isInt64 = false;
+    if (isInt)
+    {
+        auto const [ptr, ec] = std::from_chars(begin, end, m_int64);
+        m_isInt64            = ec == std::errc {} && ptr == end;
+    }
+    if (!m_isInt64)
+    {
+        auto const [ptr, ec] = std::from_chars(begin, end, m_double);
+        if (ec != std::errc {} || ptr != end || length == 0)
+        {
+            return Fail(fmt::format("Invalid number '{}'", rest.substr(0, length)));
+        }
+    }
+
+    m_pos += length;
+    AfterValue();
+    return JsonToken::Number;
+}
+
+JsonToken JsonReader::ReadLiteral()
+{
+    std::string_view const rest = m_json.substr(m_pos);
+    if (rest.starts_with("true"))
+    {
+        m_pos += 4;
+        m_bool = true;
+        AfterValue();
+        return JsonToken::Bool;
+    }
+    if (rest.starts_with("false"))
+    {
+        m_pos += 5;
+        m_bool = false;
+        AfterValue();
+        return JsonToken::Bool;
+    }
+    if (rest.starts_with("null"))
+    {
+        m_pos += 4;
+        AfterValue();
+        return JsonToken::Null;
+    }
+    return Fail("Invalid literal");
+}
+
+} // namespace DcgmNs::JsonSerialize
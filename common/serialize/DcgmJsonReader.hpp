@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace DcgmNs::JsonSerialize
+{
+
+enum class JsonToken
+{
+    StartObject,
+    EndObject,
+    StartArray,
+    EndArray,
+    Key,    /*!< Key of an object member. Its value is the next token */
+    String,
+    Number,
+    Bool,
+    Null,
+    End,    /*!< The whole document was read */
+    Error,  /*!< The document isn't well-formed. See GetError() */
+};
+
+/**
+ * @brief Reads JSON text one token at a time, without building a Json::Value tree.
+ *
+ * Strings without escapes are returned as views into the text, so nothing is allocated for them. The text must
+ * outlive the reader.
+ *
+ * It accepts the same relaxed JSON as DcgmNs::JsonSerialize::TryDeserialize(std::string_view) does for Json::Value:
+ * comments, trailing commas, single-quoted strings, NaN and Infinity. Nothing but whitespace and comments may follow
+ * the document. Duplicate keys aren't detected; the reader doesn't remember keys.
+ *
+ * @code
+ *  JsonReader reader(R"({"gpuId": 1, "values": [1.5, 2.5]})");
+ *  long long gpuId = -1;
+ *  bool ok = ReadObject(reader, [&](std::string_view key) {
+ *      if (key == "gpuId") {
+ *          if (reader.Next() != JsonToken::Number) {
+ *              return false;
+ *          }
+ *          gpuId = reader.GetInt64();
+ *          return true;
+ *      }
+ *      return reader.SkipValue();
+ *  });
+ * @endcode
+ */
+class JsonReader
+{
+public:
+    explicit JsonReader(std::string_view json);
+
+    /**
+     * @brief Read the next token
+     */
+    JsonToken Next();
+
+    /**
+     * @brief The next token, without reading it
+     */
+    JsonToken Peek();
+
+    /**
+     * @brief Read and throw away the next value, including everything in it if it's an object or an array
+     * @return false if the document isn't well-formed
+     */
+    bool SkipValue();
+
+    /**
+     * @brief Throw away the rest of the object or array whose StartObject or StartArray token was just read
+     * @return false if the document isn't well-formed
+     */
+    bool SkipRest();
+
+    /**
+     * @brief The text of the last Key or String token. Only valid until the next call to Next().
+     */
+    std::string_view GetString() const
+    {
+        return m_string;
+    }
+
+    /**
+     * @brief The value of the last Bool token
+     */
+    bool GetBool() const
+    {
+        return m_bool;
+    }
+
+    /**
+     * @brief Whether the last Number token was written without a fraction or exponent and fits an int64
+     */
+    bool IsInt64() const
+    {
+        return m_isInt64;
+    }
+
+    std::int64_t GetInt64() const
+    {
+        return m_isInt64 ? m_int64 : static_cast<std::int64_t>(m_double);
+    }
+
+    double GetDouble() const
+    {
+        return m_isInt64 ? static_cast<double>(m_int64) : m_double;
+    }
+
+    /**
+     * @brief Why the last Error token was returned, and where
+     */
+    std::string const &GetError() const
+    {
+        return m_error;
+    }
+
+private:
+    enum class Expect
+    {
+        Value,           /* A value: at the top, after a key or after a comma in an array */
+        FirstValueOrEnd, /* After [ */
+        KeyOrEnd,        /* After { or a comma in an object */
+        CommaOrEnd,      /* After a value in an object or array */
+        Done,            /* After the top-level value */
+    };
+
+    std::string_view m_json;
+    size_t m_pos    = 0;
+    Expect m_expect = Expect::Value;
+    std::vector<char> m_stack; /* '{' or '[' of each open object or array */
+
+    bool m_hasPeeked = false;
+    JsonToken m_peeked {};
+
+    std::string_view m_string;
+    std::string m_unescaped; /* Backs m_string if the string had escapes */
+    bool m_bool          = false;
+    bool m_isInt64       = false;
+    std::int64_t m_int64 = 0;
+    double m_double      = 0;
+    std::string m_error;
+
+    JsonToken ReadToken();
+    JsonToken ReadValue();
+    JsonToken ReadString(JsonToken token);
+    JsonToken ReadNumber();
+    JsonToken ReadLiteral();
+    JsonToken Close(char close);
+    void AfterValue();
+    bool SkipWhitespaceAndComments();
+    JsonToken Fail(std::string_view why);
+};
+
+/**
+ * @brief Read an object, calling \a onMember(key) for each member. onMember must read or skip the member's value.
+ *        key is only valid until then.
+ * @return false if the next value isn't an object, the document isn't well-formed or onMember returned false
+ */
+template <class OnMember>
+bool ReadObject(JsonReader &reader, OnMember &&onMember)
+{
+    if (reader.Next() != JsonToken::StartObject)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        switch (reader.Next())
+        {
+            case JsonToken::EndObject:
+                return true;
+
+            case JsonToken::Key:
+                if (!onMember(reader.GetString()))
+                {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+        }
+    }
+}
+
+/**
+ * @brief Read an array, calling \a onElement() for each element. onElement must read or skip the element.
+ * @return false if the next value isn't an array, the document isn't well-formed or onElement returned false
+ */
+template <class OnElement>
+bool ReadArray(JsonReader &reader, OnElement &&onElement)
+{
+    if (reader.Next() != JsonToken::StartArray)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        switch (reader.Peek())
+        {
+            case JsonToken::EndArray:
+                reader.Next();
+                return true;
+
+            case JsonToken::Error:
+            case JsonToken::End:
+                return false;
+
+            default:
+                if (!onElement())
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+}
+
+} // namespace DcgmNs::JsonSerialize
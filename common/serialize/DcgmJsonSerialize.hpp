@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include "DcgmJsonReader.hpp"
+#include "DcgmJsonWriter.hpp"
+
 #include <DcgmLogging.h>
 
 #include <json/json.h>
 #include <optional>
+#include <string>
 
 
 /**
@@ -52,6 +56,36 @@
  *      // Do something with exampleClass.value()
  *  }
  * @endcode
+ *
+ * Building a Json::Value tree is the slow part for large documents. Types can skip it with overloads that work on
+ * JSON text directly, through a JsonWriter and a JsonReader:
+ *
+ * @code
+ *  namespace Example::Nested::Namespace {
+ *    void ToJson(DcgmNs::JsonSerialize::JsonWriter &writer, ExampleClass const &exampleClass) {
+ *      writer.StartObject();
+ *      writer.Key("i");
+ *      writer.Int(exampleClass.i);
+ *      writer.EndObject();
+ *    }
+ *    std::optional<ExampleClass> ParseJson(DcgmNs::JsonSerialize::JsonReader &reader,
+ *                                          DcgmNs::JsonSerialize::To<ExampleClass>) {
+ *      std::optional<int> i;
+ *      bool const ok = ReadObject(reader, [&](std::string_view key) {
+ *          if (key == "i" && reader.Next() == JsonToken::Number && reader.IsInt64()) {
+ *              i = reader.GetInt64();
+ *              return true;
+ *          }
+ *          return key != "i" && reader.SkipValue();
+ *      });
+ *      return ok && i.has_value() ? std::optional<ExampleClass> { ExampleClass { *i } } : std::nullopt;
+ *    }
+ *  }
+ *
+ *  // Usage. These use the streaming overloads when the type has them and Json::Value otherwise:
+ *  std::string json = DcgmNs::JsonSerialize::SerializeToString(exampleClass);
+ *  auto exampleClass = DcgmNs::JsonSerialize::TryDeserialize<ExampleClass>(std::string_view { json });
+ * @endcode
  */
 namespace DcgmNs::JsonSerialize
 {
@@ -79,12 +113,59 @@ concept IsJsonSerializable = requires(T object) {
     { ToJson(object) } -> std::same_as<Json::Value>;
 };
 
+/**
+ * @brief Concept that validates if an object can be parsed from JSON text without a Json::Value tree
+ * @tparam T Type should implement ParseJson(JsonReader &, To<T>) method, which reads exactly one value
+ */
+template <class T>
+concept IsJsonStreamDeserializable = requires(JsonReader &reader) {
+    { ParseJson(reader, To<T> {}) } -> std::same_as<std::optional<T>>;
+};
+
+/**
+ * @brief Concept that validates if an object can be written as JSON text without a Json::Value tree
+ * @tparam T Type should implement ToJson(JsonWriter &, T const &) method, which writes exactly one value
+ */
+template <class T>
+concept IsJsonStreamSerializable = requires(JsonWriter &writer, T const &object) {
+    { ToJson(writer, object) } -> std::same_as<void>;
+};
+
 template <IsJsonSerializable T>
 auto Serialize(T const &value)
 {
     return ToJson(value);
 }
 
+/**
+ * @brief Writes \a value to \a writer, directly if T has a streaming ToJson and through a Json::Value otherwise.
+ */
+template <class T>
+    requires IsJsonStreamSerializable<T> || IsJsonSerializable<T>
+void Serialize(JsonWriter &writer, T const &value)
+{
+    if constexpr (IsJsonStreamSerializable<T>)
+    {
+        ToJson(writer, value);
+    }
+    else
+    {
+        writer.Value(ToJson(value));
+    }
+}
+
+/**
+ * @brief Serializes \a value to JSON text. See Serialize(JsonWriter &, T const &).
+ */
+template <class T>
+    requires IsJsonStreamSerializable<T> || IsJsonSerializable<T>
+std::string SerializeToString(T const &value, bool pretty = false)
+{
+    JsonWriter writer(pretty);
+    Serialize(writer, value);
+    return writer.Take();
+}
+
 template <IsJsonDeserializable T>
 auto TryDeserialize(Json::Value const &root)
 {
@@ -110,6 +191,7 @@ auto TryDeserialize(Json::Value const &root)
  * and produces a JSON value with a length-prefixed string. This is not what we want.
  */
 template <IsJsonDeserializable T>
+    requires(!IsJsonStreamDeserializable<T>)
 auto TryDeserialize(std::string_view jsonStr)
 {
     Json::Value root;
@@ -140,6 +222,7 @@ auto Deserialize(Json::Value const &root) -> T
 }
 
 template <IsJsonDeserializable T>
+    requires(!IsJsonStreamDeserializable<T>)
 auto Deserialize(std::string_view jsonStr) -> T
 {
     Json::Value root;
@@ -163,4 +246,43 @@ auto Deserialize(std::string_view jsonStr) -> T
     throw std::runtime_error { fmt::format("Failed to parse JSON: {}", errors) };
 }
 
+/**
+ * @brief Deserializes from a string JSON value into a given type that can be parsed without a Json::Value tree.
+ *
+ * Preferred over the Json::Value path when T has both ParseJson overloads. The same relaxed JSON is accepted.
+ * See TryDeserialize(std::string_view) above for why std::string arguments have to be cast to std::string_view.
+ */
+template <IsJsonStreamDeserializable T>
+auto TryDeserialize(std::string_view jsonStr) -> std::optional<T>
+{
+    JsonReader reader(jsonStr);
+    std::optional<T> result = ParseJson(reader, To<T>());
+    if (result.has_value() && reader.Next() != JsonToken::End)
+    {
+        result = std::nullopt;
+    }
+    if (!result.has_value())
+    {
+        log_error("Failed to parse JSON:\n{}\n\nRAW JSON:\n{}",
+                  reader.GetError().empty() ? "Unexpected value" : reader.GetError(),
+                  jsonStr);
+    }
+    return result;
+}
+
+template <IsJsonStreamDeserializable T>
+auto Deserialize(std::string_view jsonStr) -> T
+{
+    JsonReader reader(jsonStr);
+    std::optional<T> result = ParseJson(reader, To<T>());
+    if (!result.has_value() || reader.Next() != JsonToken::End)
+    {
+        std::string const errors = reader.GetError().empty() ? "Unexpected value" : reader.GetError();
+        log_error("Failed to parse JSON: {}", errors);
+        log_debug("JSON: {}", jsonStr);
+        throw std::runtime_error { fmt::format("Failed to parse JSON: {}", errors) };
+    }
+    return std::move(*result);
+}
+
 } // namespace DcgmNs::JsonSerialize
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DcgmJsonWriter.hpp"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <iterator>
+
+
+namespace DcgmNs::JsonSerialize
+{
+
+namespace
+{
+/* Flush to the output stream once the buffer gets this big */
+constexpr size_t c_flushBytes = 64 * 1024;
+
+/* Indentation per level of pretty output, as in Json::Value::toStyledString() */
+constexpr std::string_view c_indent = "   ";
+} // namespace
+
+JsonWriter::JsonWriter(bool pretty)
+    : m_pretty(pretty)
+{}
+
+JsonWriter::JsonWriter(std::ostream &out, bool pretty)
+    : m_out(&out)
+    , m_pretty(pretty)
+{
+    m_buffer.reserve(c_flushBytes + 4096);
+}
+
+void JsonWriter::NewLine()
+{
+    m_buffer.push_back('\n');
+    for (size_t i = 0; i < m_scopes.size(); i++)
+    {
+        m_buffer.append(c_indent);
+    }
+}
+
+void JsonWriter::BeginValue()
+{
+    FlushIfFull();
+
+    if (m_afterKey)
+    {
+        m_afterKey = false;
+        return;
+    }
+
+    if (m_scopes.empty())
+    {
+        return;
+    }
+
+    Scope &scope = m_scopes.back();
+    if (!scope.isEmpty)
+    {
+        m_buffer.push_back(',');
+    }
+    scope.isEmpty = false;
+
+    if (m_pretty)
+    {
+        NewLine();
+    }
+}
+
+void JsonWriter::StartScope(bool isObject, char open)
+{
+    BeginValue();
+    m_buffer.push_back(open);
+    m_scopes.push_back({ isObject, true });
+}
+
+void JsonWriter::EndScope(char close)
+{
+    bool const wasEmpty = m_scopes.back().isEmpty;
+    m_scopes.pop_back();
+
+    if (m_pretty && !wasEmpty)
+    {
+        NewLine();
+    }
+    m_buffer.push_back(close);
+
+    if (m_scopes.empty() && m_pretty)
+    {
+        m_buffer.push_back('\n');
+    }
+}
+
+void JsonWriter::StartObject()
+{
+    StartScope(true, '{');
+}
+
+void JsonWriter::EndObject()
+{
+    EndScope('}');
+}
+
+void JsonWriter::StartArray()
+{
+    StartScope(false, '[');
+}
+
+void JsonWriter::EndArray()
+{
+    EndScope(']');
+}
+
+void JsonWriter::Key(std::string_view key)
+{
+    BeginValue();
+    WriteEscaped(key);
+    m_buffer.append(m_pretty ? " : " : ":");
+    m_afterKey = true;
+}
+
+void JsonWriter::Null()
+{
+    BeginValue();
+    m_buffer.append("null");
+}
+
+void JsonWriter::Bool(bool value)
+{
+    BeginValue();
+    m_buffer.append(value ? "true" : "false");
+}
+
+void JsonWriter::Int(std::int64_t value)
+{
+    BeginValue();
+    fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+}
+
+void JsonWriter::Uint(std::uint64_t value)
+{
+    BeginValue();
+    fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+}
+
+void JsonWriter::Double(double value)
+{
+    BeginValue();
+    if (!std::isfinite(value))
+    {
+        m_buffer.append("null");
+        return;
+    }
+
+    size_t const start = m_buffer.size();
+    fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+
+    /* Keep whole doubles doubles when they are read back */
+    if (m_buffer.find_first_of(".e", start) == std::string::npos)
+    {
+        m_buffer.append(".0");
+    }
+}
+
+void JsonWriter::String(std::string_view value)
+{
+    BeginValue();
+    WriteEscaped(value);
+}
+
+void JsonWriter::WriteEscaped(std::string_view value)
+{
+    m_buffer.push_back('"');
+
+    size_t runStart = 0;
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        auto const c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+
+        m_buffer.append(value.substr(runStart, i - runStart));
+        runStart = i + 1;
+
+        switch (c)
+        {
+            case '"':
+                m_buffer.append("\\\"");
+                break;
+            case '\\':
+                m_buffer.append("\\\\");
+                break;
+            case '\b':
+                m_buffer.append("\\b");
+                break;
+            case '\f':
+                m_buffer.append("\\f");
+                break;
+            case '\n':
+                m_buffer.append("\\n");
+                break;
+            case '\r':
+                m_buffer.append("\\r");
+                break;
+            case '\t':
+                m_buffer.append("\\t");
+                break;
+            default:
+                fmt::format_to(std::back_inserter(m_buffer), "\\u{:04x}", c);
+                break;
+        }
+    }
+    m_buffer.append(value.substr(runStart));
+
+    m_buffer.push_back('"');
+}
+
+void JsonWriter::Value(Json::Value const &value)
+{
+    switch (value.type())
+    {
+        case Json::nullValue:
+            Null();
+            break;
+
+        case Json::intValue:
+            Int(value.asInt64());
+            break;
+
+        case Json::uintValue:
+            Uint(value.asUInt64());
+            break;
+
+        case Json::realValue:
+            Double(value.asDouble());
+            break;
+
+        case Json::stringValue:
+        {
+            char const *begin = nullptr;
+            char const *end   = nullptr;
+            value.getString(&begin, &end);
+            String(std::string_view(begin, end - begin));
+            break;
+        }
+
+        case Json::booleanValue:
+            Bool(value.asBool());
+            break;
+
+        case Json::arrayValue:
+            /* Index rather than iterate: arrays set out of order only hold the elements that were set */
+            StartArray();
+            for (Json::ArrayIndex i = 0; i < value.size(); i++)
+            {
+                Value(value[i]);
+            }
+            EndArray();
+            break;
+
+        case Json::objectValue:
+            StartObject();
+            for (auto it = value.begin(); it != value.end(); ++it)
+            {
+                char const *end   = nullptr;
+                char const *begin = it.memberName(&end);
+                Key(std::string_view(begin, end - begin));
+                Value(*it);
+            }
+            EndObject();
+            break;
+    }
+}
+
+void JsonWriter::FlushIfFull()
+{
+    if (m_out != nullptr && m_buffer.size() >= c_flushBytes)
+    {
+        Flush();
+    }
+}
+
+void JsonWriter::Flush()
+{
+    if (m_out == nullptr)
+    {
+        return;
+    }
+
+    m_out->write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}
+
+std::string JsonWriter::Take()
+{
+    std::string result = std::move(m_buffer);
+    m_buffer.clear();
+    return result;
+}
+
+} // namespace DcgmNs::JsonSerialize
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace DcgmNs::JsonSerialize
+{
+
+/**
+ * @brief Writes JSON text as it goes, without building a Json::Value tree first.
+ *
+ * Values are appended to an internal buffer. If the writer was given an output stream, the buffer is written to it
+ * whenever it grows past a few dozen KB, so the memory used doesn't grow with the size of the document.
+ *
+ * @code
+ *  JsonWriter writer(std::cout, true);
+ *  writer.StartObject();
+ *  writer.Key("gpuId");
+ *  writer.Uint(0);
+ *  writer.Key("values");
+ *  writer.StartArray();
+ *  writer.Double(1.5);
+ *  writer.EndArray();
+ *  writer.EndObject();
+ *  writer.Flush();
+ * @endcode
+ *
+ * The writer trusts its caller to produce well-formed JSON: keys only directly inside objects, values only after keys
+ * or inside arrays, and every Start* matched by an End*. Pretty output puts every member and array element on its own
+ * line, indented like Json::Value::toStyledString().
+ */
+class JsonWriter
+{
+public:
+    /**
+     * @brief Write into a string. Get it with GetString() or Take().
+     */
+    explicit JsonWriter(bool pretty = false);
+
+    /**
+     * @brief Write to \a out. Call Flush() once the document is complete.
+     */
+    explicit JsonWriter(std::ostream &out, bool pretty = false);
+
+    ~JsonWriter() = default;
+
+    JsonWriter(JsonWriter const &)            = delete;
+    JsonWriter &operator=(JsonWriter const &) = delete;
+
+    void StartObject();
+    void EndObject();
+    void StartArray();
+    void EndArray();
+
+    /**
+     * @brief Write the key of the next member of the current object
+     */
+    void Key(std::string_view key);
+
+    void Null();
+    void Bool(bool value);
+    void Int(std::int64_t value);
+    void Uint(std::uint64_t value);
+
+    /**
+     * @brief Write a double. Values that aren't finite are written as null, like Json::StreamWriterBuilder does.
+     */
+    void Double(double value);
+    void String(std::string_view value);
+
+    /**
+     * @brief Write a Json::Value tree. Lets DOM-based ToJson() functions be mixed with streamed output.
+     */
+    void Value(Json::Value const &value);
+
+    /**
+     * @brief Write anything that's buffered to the output stream, if there is one.
+     */
+    void Flush();
+
+    /**
+     * @brief The JSON text written so far that hasn't been flushed to the output stream.
+     */
+    std::string const &GetString() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     * @brief Move the JSON text written so far out of the writer.
+     */
+    std::string Take();
+
+private:
+    struct Scope
+    {
+        bool isObject;
+        bool isEmpty;
+    };
+
+    std::ostream *m_out = nullptr;
+    bool m_pretty       = false;
+    bool m_afterKey     = false; /* The next value is the value of a member whose key was just written */
+    std::vector<Scope> m_scopes;
+    std::string m_buffer;
+
+    /* Write what goes before a value: a comma and a new line, depending on where the value is */
+    void BeginValue();
+    void StartScope(bool isObject, char open);
+    void EndScope(char close);
+    void NewLine();
+    void WriteEscaped(std::string_view value);
+    void FlushIfFull();
+};
+
+} // namespace DcgmNs::JsonSerialize
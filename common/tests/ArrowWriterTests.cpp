@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmArrowWriter.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename T>
+T Read(std::vector<std::uint8_t> const &bytes, size_t offset)
+{
+    REQUIRE(offset + sizeof(T) <= bytes.size());
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+/* Just enough of a FlatBuffers reader to follow the Arrow metadata the writer produces */
+class FlatTable
+{
+public:
+    FlatTable(std::vector<std::uint8_t> const &bytes, size_t pos)
+        : m_bytes(bytes)
+        , m_pos(pos)
+        , m_vtable(pos - Read<std::int32_t>(bytes, pos))
+    {}
+
+    static FlatTable Root(std::vector<std::uint8_t> const &bytes, size_t start)
+    {
+        return FlatTable(bytes, start + Read<std::uint32_t>(bytes, start));
+    }
+
+    template <typename T>
+    T Scalar(unsigned int id) const
+    {
+        size_t const offset = FieldOffset(id);
+        return offset ? Read<T>(m_bytes, m_pos + offset) : T {};
+    }
+
+    FlatTable Table(unsigned int id) const
+    {
+        return FlatTable(m_bytes, Deref(id));
+    }
+
+    std::string String(unsigned int id) const
+    {
+        size_t const pos = Deref(id);
+        return std::string((char const *)m_bytes.data() + pos + 4, Read<std::uint32_t>(m_bytes, pos));
+    }
+
+    std::vector<FlatTable> Tables(unsigned int id) const
+    {
+        size_t const pos = Deref(id);
+        std::vector<FlatTable> tables;
+        for (std::uint32_t i = 0; i < Read<std::uint32_t>(m_bytes, pos); i++)
+        {
+            size_t const element = pos + 4 + 4 * i;
+            tables.emplace_back(m_bytes, element + Read<std::uint32_t>(m_bytes, element));
+        }
+        return tables;
+    }
+
+    /* Vector of structs of two int64s, like Block (without its padding), FieldNode and Buffer */
+    std::vector<std::pair<std::int64_t, std::int64_t>> Pairs(unsigned int id, size_t structSize) const
+    {
+        size_t const pos = Deref(id);
+        std::vector<std::pair<std::int64_t, std::int64_t>> pairs;
+        for (std::uint32_t i = 0; i < Read<std::uint32_t>(m_bytes, pos); i++)
+        {
+            size_t const element = pos + 4 + structSize * i;
+            pairs.emplace_back(Read<std::int64_t>(m_bytes, element),
+                               Read<std::int64_t>(m_bytes, element + structSize - 8));
+        }
+        return pairs;
+    }
+
+private:
+    size_t FieldOffset(unsigned int id) const
+    {
+        size_t const entry = 4 + 2 * id;
+        return entry < Read<std::uint16_t>(m_bytes, m_vtable) ? Read<std::uint16_t>(m_bytes, m_vtable + entry) : 0;
+    }
+
+    size_t Deref(unsigned int id) const
+    {
+        size_t const pos = m_pos + FieldOffset(id);
+        REQUIRE(pos != m_pos);
+        return pos + Read<std::uint32_t>(m_bytes, pos);
+    }
+
+    std::vector<std::uint8_t> const &m_bytes;
+    size_t m_pos;
+    size_t m_vtable;
+};
+
+std::vector<std::uint8_t> WriteFile(std::vector<dcgmFieldValue_v1> const &values, unsigned int rowsPerBatch)
+{
+    FILE *file = tmpfile();
+    REQUIRE(file != nullptr);
+
+    DcgmArrowWriter writer(file, rowsPerBatch);
+    REQUIRE(writer.Begin());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        REQUIRE(writer.Add(DCGM_FE_GPU, (dcgm_field_eid_t)i % 2, values[i]));
+    }
+    REQUIRE(writer.Finish());
+
+    std::vector<std::uint8_t> bytes(ftell(file));
+    rewind(file);
+    REQUIRE(fread(bytes.data(), 1, bytes.size(), file) == bytes.size());
+    fclose(file);
+    return bytes;
+}
+
+dcgmFieldValue_v1 MakeValue(unsigned short fieldId, unsigned short fieldType, long long ts)
+{
+    dcgmFieldValue_v1 value {};
+    value.version   = dcgmFieldValue_version1;
+    value.fieldId   = fieldId;
+    value.fieldType = fieldType;
+    value.ts        = ts;
+    return value;
+}
+
+/* Column values of one record batch. Nulls are std::nullopt */
+struct Batch
+{
+    std::int64_t numRows;
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::uint32_t> entityIds;
+    std::vector<std::uint16_t> fieldIds;
+    std::vector<std::optional<std::int64_t>> int64Values;
+    std::vector<std::optional<double>> doubleValues;
+};
+
+/* Check the framing of the file and decode its record batches */
+std::vector<Batch> ReadFile(std::vector<std::uint8_t> const &bytes)
+{
+    REQUIRE(bytes.size() > 16);
+    REQUIRE(std::memcmp(bytes.data(), "ARROW1\0\0", 8) == 0);
+    REQUIRE(std::memcmp(bytes.data() + bytes.size() - 6, "ARROW1", 6) == 0);
+
+    std::int32_t const footerLength = Read<std::int32_t>(bytes, bytes.size() - 10);
+    size_t const footerStart        = bytes.size() - 10 - footerLength;
+    REQUIRE(footerStart % 8 == 0);
+
+    FlatTable const footer = FlatTable::Root(bytes, footerStart);
+    CHECK(footer.Scalar<std::int16_t>(0) == 4);
+
+    std::vector<FlatTable> const fields = footer.Table(1).Tables(1);
+    REQUIRE(fields.size() == 6);
+    CHECK(fields[0].String(0) == "timestamp");
+    CHECK(fields[0].Table(3).String(1) == "UTC");
+    CHECK(fields[2].String(0) == "entity_id");
+    CHECK(fields[2].Table(3).Scalar<std::int32_t>(0) == 32);
+    CHECK(fields[4].String(0) == "value_int64");
+    CHECK(fields[4].Scalar<std::uint8_t>(1) == 1);
+    CHECK(fields[5].String(0) == "value_double");
+
+    std::vector<Batch> batches;
+    for (auto const &[offset, bodyLength] : footer.Pairs(3, 24))
+    {
+        REQUIRE(offset % 8 == 0);
+        REQUIRE(Read<std::uint32_t>(bytes, offset) == 0xFFFFFFFF);
+        size_t const metadataLength = Read<std::int32_t>(bytes, offset + 4);
+        size_t const body           = offset + 8 + metadataLength;
+        REQUIRE(body + bodyLength <= footerStart);
+
+        FlatTable const message = FlatTable::Root(bytes, offset + 8);
+        REQUIRE(message.Scalar<std::uint8_t>(1) == 3);
+        FlatTable const recordBatch = message.Table(2);
+
+        auto const nodes   = recordBatch.Pairs(1, 16);
+        auto const buffers = recordBatch.Pairs(2, 16);
+        REQUIRE(nodes.size() == 6);
+        REQUIRE(buffers.size() == 12);
+
+        Batch batch {};
+        batch.numRows = recordBatch.Scalar<std::int64_t>(0);
+
+        auto isValid = [&](size_t column, std::int64_t row) {
+            auto const [validityOffset, validityLength] = buffers[2 * column];
+            return validityLength == 0 || (bytes[body + validityOffset + row / 8] >> (row % 8)) & 1;
+        };
+        auto data = [&]<typename T>(size_t column, std::int64_t row, T) {
+            return Read<T>(bytes, body + buffers[2 * column + 1].first + row * sizeof(T));
+        };
+
+        for (std::int64_t row = 0; row < batch.numRows; row++)
+        {
+            batch.timestamps.push_back(data(0, row, std::int64_t {}));
+            batch.entityIds.push_back(data(2, row, std::uint32_t {}));
+            batch.fieldIds.push_back(data(3, row, std::uint16_t {}));
+            batch.int64Values.push_back(isValid(4, row) ? std::optional(data(4, row, std::int64_t {})) : std::nullopt);
+            batch.doubleValues.push_back(isValid(5, row) ? std::optional(data(5, row, double {})) : std::nullopt);
+        }
+        batches.push_back(std::move(batch));
+    }
+    return batches;
+}
+} // namespace
+
+TEST_CASE("ArrowWriter: values are split into record batches")
+{
+    std::vector<dcgmFieldValue_v1> values;
+    for (int i = 0; i < 7; i++)
+    {
+        if (i % 2 == 0)
+        {
+            values.push_back(MakeValue(DCGM_FI_DEV_GPU_TEMP, DCGM_FT_INT64, 1000 + i));
+            values.back().value.i64 = 40 + i;
+        }
+        else
+        {
+            values.push_back(MakeValue(DCGM_FI_DEV_POWER_USAGE, DCGM_FT_DOUBLE, 1000 + i));
+            values.back().value.dbl = 100.5 + i;
+        }
+    }
+
+    std::vector<Batch> const batches = ReadFile(WriteFile(values, 3));
+    REQUIRE(batches.size() == 3);
+    CHECK(batches[0].numRows == 3);
+    CHECK(batches[1].numRows == 3);
+    CHECK(batches[2].numRows == 1);
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        Batch const &batch = batches[i / 3];
+        size_t const row   = i % 3;
+        CHECK(batch.timestamps[row] == values[i].ts);
+        CHECK(batch.entityIds[row] == i % 2);
+        CHECK(batch.fieldIds[row] == values[i].fieldId);
+        if (values[i].fieldType == DCGM_FT_INT64)
+        {
+            CHECK(batch.int64Values[row] == values[i].value.i64);
+            CHECK(!batch.doubleValues[row].has_value());
+        }
+        else
+        {
+            CHECK(!batch.int64Values[row].has_value());
+            CHECK(batch.doubleValues[row] == values[i].value.dbl);
+        }
+    }
+}
+
+TEST_CASE("ArrowWriter: blank and non-numeric values")
+{
+    std::vector<dcgmFieldValue_v1> values;
+    values.push_back(MakeValue(DCGM_FI_DEV_GPU_TEMP, DCGM_FT_INT64, 1));
+    values.back().value.i64 = DCGM_INT64_BLANK;
+    values.push_back(MakeValue(DCGM_FI_DEV_NAME, DCGM_FT_STRING, 2));
+    values.push_back(MakeValue(DCGM_FI_DEV_POWER_USAGE, DCGM_FT_DOUBLE, 3));
+    values.back().value.dbl = DCGM_FP64_BLANK;
+    values.push_back(MakeValue(DCGM_FI_DEV_GPU_TEMP, DCGM_FT_INT64, 4));
+    values.back().value.i64 = 45;
+
+    std::vector<Batch> const batches = ReadFile(WriteFile(values, 100));
+    REQUIRE(batches.size() == 1);
+    REQUIRE(batches[0].numRows == 3);
+    CHECK((batches[0].timestamps == std::vector<std::int64_t> { 1, 3, 4 }));
+    CHECK(!batches[0].int64Values[0].has_value());
+    CHECK(!batches[0].doubleValues[1].has_value());
+    CHECK(batches[0].int64Values[2] == 45);
+}
+
+TEST_CASE("ArrowWriter: a file without values")
+{
+    std::vector<Batch> const batches = ReadFile(WriteFile({}, 100));
+    CHECK(batches.empty());
+}
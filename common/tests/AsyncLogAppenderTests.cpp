@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmAsyncLogAppender.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+using namespace DcgmNs::Logging;
+
+namespace
+{
+/* Formats a record as its message */
+class MessageFormatter
+{
+public:
+    static plog::util::nstring format(plog::Record const &record)
+    {
+        return record.getMessage();
+    }
+};
+
+/* Lines written to a CapturingAppender. Writes block while the test holds m_blockMutex */
+class Capture
+{
+public:
+    void Add(std::string line)
+    {
+        std::lock_guard<std::mutex> blockLock(m_blockMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lines.push_back(std::move(line));
+    }
+
+    std::vector<std::string> GetLines()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lines;
+    }
+
+    std::mutex m_blockMutex;
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_lines;
+};
+
+/* Owned by the AsyncLogAppender under test. The test keeps the Capture */
+class CapturingAppender : public plog::IAppender
+{
+public:
+    explicit CapturingAppender(std::shared_ptr<Capture> capture)
+        : m_capture(std::move(capture))
+    {}
+
+    void write(plog::Record const &record) override
+    {
+        m_capture->Add(record.getMessage());
+    }
+
+private:
+    std::shared_ptr<Capture> m_capture;
+};
+
+void Log(plog::IAppender &appender, plog::Severity severity, std::string const &message, size_t line = __LINE__)
+{
+    plog::Record record(severity, "Log", line, __FILE__, nullptr, PLOG_DEFAULT_INSTANCE_ID);
+    record << message;
+    appender.write(record);
+}
+} // namespace
+
+TEST_CASE("AsyncLogAppender: Records are written in order")
+{
+    auto capture     = std::make_shared<Capture>();
+    auto asyncLogger = std::make_unique<AsyncLogAppender<MessageFormatter>>(
+        std::make_unique<CapturingAppender>(capture), 1024, 0);
+
+    for (int i = 0; i < 100; i++)
+    {
+        Log(*asyncLogger, i % 10 == 0 ? plog::error : plog::debug, std::to_string(i));
+    }
+    asyncLogger->Flush();
+
+    auto const lines = capture->GetLines();
+    REQUIRE(lines.size() == 100);
+    for (int i = 0; i < 100; i++)
+    {
+        CHECK(lines[i] == std::to_string(i));
+    }
+
+    auto const stats = asyncLogger->GetStats();
+    CHECK(stats.written == 100);
+    CHECK(stats.droppedQueueFull == 0);
+    CHECK(stats.droppedRateLimited == 0);
+
+    /* Queued records are written when the appender is destroyed */
+    Log(*asyncLogger, plog::info, "last");
+    asyncLogger.reset();
+    CHECK(capture->GetLines().size() == 101);
+}
+
+TEST_CASE("AsyncLogAppender: Debug records are dropped when the queue is full")
+{
+    auto capture = std::make_shared<Capture>();
+    AsyncLogAppender<MessageFormatter> asyncLogger(std::make_unique<CapturingAppender>(capture), 4, 0);
+
+    {
+        /* At most the queue depth plus the record the background thread is writing get through */
+        std::lock_guard<std::mutex> blockLock(capture->m_blockMutex);
+        for (int i = 0; i < 100; i++)
+        {
+            Log(asyncLogger, plog::debug, std::to_string(i));
+        }
+    }
+    asyncLogger.Flush();
+
+    auto const stats = asyncLogger.GetStats();
+    CHECK(stats.written <= 5);
+    CHECK(stats.written + stats.droppedQueueFull == 100);
+
+    /* The written records, then the drop report */
+    auto const lines = capture->GetLines();
+    REQUIRE(lines.size() == stats.written + 1);
+    CHECK(lines.back().find("Dropped " + std::to_string(stats.droppedQueueFull)) == 0);
+}
+
+TEST_CASE("AsyncLogAppender: Errors are never dropped")
+{
+    auto capture = std::make_shared<Capture>();
+    AsyncLogAppender<MessageFormatter> asyncLogger(std::make_unique<CapturingAppender>(capture), 2, 1);
+
+    /* Errors that don't fit in the queue are written on this thread after what was queued */
+    for (int i = 0; i < 100; i++)
+    {
+        Log(asyncLogger, plog::error, std::to_string(i));
+    }
+    asyncLogger.Flush();
+
+    auto const lines = capture->GetLines();
+    REQUIRE(lines.size() == 100);
+    for (int i = 0; i < 100; i++)
+    {
+        CHECK(lines[i] == std::to_string(i));
+    }
+
+    auto const stats = asyncLogger.GetStats();
+    CHECK(stats.written == 100);
+    CHECK(stats.droppedQueueFull == 0);
+    CHECK(stats.droppedRateLimited == 0);
+}
+
+TEST_CASE("AsyncLogAppender: Info records are rate limited per call site")
+{
+    auto capture = std::make_shared<Capture>();
+    AsyncLogAppender<MessageFormatter> asyncLogger(std::make_unique<CapturingAppender>(capture), 1024, 3);
+
+    for (int i = 0; i < 100; i++)
+    {
+        Log(asyncLogger, plog::info, "chatty", 1);
+        Log(asyncLogger, plog::info, "quiet", 2);
+    }
+    asyncLogger.Flush();
+
+    /* 3 per second per call site, and the loop may straddle a second */
+    auto const stats = asyncLogger.GetStats();
+    CHECK(stats.written >= 6);
+    CHECK(stats.written <= 12);
+    CHECK(stats.written + stats.droppedRateLimited == 200);
+    CHECK(stats.droppedQueueFull == 0);
+}
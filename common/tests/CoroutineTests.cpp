@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <Coroutine.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+
+using namespace DcgmNs;
+
+namespace
+{
+/* A TaskRunner with its own thread */
+class RunnerThread : public TaskRunner
+{
+public:
+    RunnerThread()
+    {
+        SetRunInterval(std::chrono::milliseconds(10));
+        m_thread = std::thread([this] {
+            m_threadId = std::this_thread::get_id();
+            while (Run() == RunResult::Ok)
+            {}
+        });
+    }
+
+    ~RunnerThread() override
+    {
+        Stop();
+        m_thread.join();
+    }
+
+    std::thread::id GetThreadId() const
+    {
+        return m_threadId.load();
+    }
+
+private:
+    std::atomic<std::thread::id> m_threadId;
+    std::thread m_thread;
+};
+
+CoTask<int> Add(int a, int b)
+{
+    co_return a + b;
+}
+
+CoTask<int> Nested()
+{
+    int const x = co_await Add(1, 2);
+    int const y = co_await Add(x, 3);
+    co_return y * 10;
+}
+
+CoTask<void> Throws()
+{
+    co_await Add(1, 1);
+    throw std::runtime_error("boom");
+}
+} // namespace
+
+TEST_CASE("Coroutine: Awaiting other coroutines")
+{
+    RunnerThread home;
+
+    auto result = CoSpawn(home, Nested());
+    REQUIRE(result.has_value());
+    REQUIRE(result->get() == 60);
+}
+
+TEST_CASE("Coroutine: Exceptions reach the future")
+{
+    RunnerThread home;
+
+    auto result = CoSpawn(home, Throws());
+    REQUIRE(result.has_value());
+    REQUIRE_THROWS_AS(result->get(), std::runtime_error);
+}
+
+TEST_CASE("Coroutine: Steps run on another runner and resume on the home one")
+{
+    RunnerThread home;
+    RunnerThread worker;
+
+    auto coroutine = [](RunnerThread &home, RunnerThread &worker) -> CoTask<bool> {
+        auto stepThread = co_await CoRunOn(worker, [] { return std::this_thread::get_id(); });
+        bool const resumedAtHome = std::this_thread::get_id() == home.GetThreadId();
+
+        bool threw = false;
+        try
+        {
+            co_await CoRunOn(worker, []() -> int { throw std::runtime_error("step failed"); });
+        }
+        catch (std::runtime_error const &)
+        {
+            threw = true;
+        }
+
+        co_return stepThread == worker.GetThreadId() && resumedAtHome && threw;
+    };
+
+    auto result = CoSpawn(home, coroutine(home, worker));
+    REQUIRE(result.has_value());
+    REQUIRE(result->get());
+}
+
+TEST_CASE("Coroutine: Sleeping does not block the home runner")
+{
+    RunnerThread home;
+
+    auto sleeper = []() -> CoTask<std::chrono::steady_clock::duration> {
+        auto const start = std::chrono::steady_clock::now();
+        co_await CoSleepFor(std::chrono::milliseconds(50));
+        co_return std::chrono::steady_clock::now() - start;
+    };
+
+    auto slept = CoSpawn(home, sleeper());
+    REQUIRE(slept.has_value());
+
+    /* Runs while the sleeper is suspended */
+    auto other = CoSpawn(home, Add(2, 2));
+    REQUIRE(other.has_value());
+    REQUIRE(other->wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    CHECK(slept->wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+
+    REQUIRE(slept->get() >= std::chrono::milliseconds(50));
+}
+
+TEST_CASE("Coroutine: Callbacks")
+{
+    RunnerThread home;
+    std::function<void(int)> pending;
+    std::mutex mutex;
+
+    auto waiter = [&pending, &mutex]() -> CoTask<int> {
+        int const immediate = co_await CoCallback<int>([](auto complete) { complete(1); });
+        int const later     = co_await CoCallback<int>([&pending, &mutex](auto complete) {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = std::move(complete);
+        });
+        co_return immediate + later;
+    };
+
+    auto result = CoSpawn(home, waiter());
+    REQUIRE(result.has_value());
+
+    /* Complete from another thread, like an IPC response */
+    std::thread responder([&pending, &mutex] {
+        for (;;)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending)
+            {
+                pending(41);
+                return;
+            }
+        }
+    });
+
+    REQUIRE(result->get() == 42);
+    responder.join();
+}
+
+TEST_CASE("Coroutine: Dropped resumptions destroy the coroutine")
+{
+    std::optional<std::shared_future<int>> result;
+    {
+        RunnerThread home;
+        auto *worker = new TaskRunner(); /* Never run */
+
+        auto coroutine = [](TaskRunner &worker) -> CoTask<int> {
+            co_return co_await CoRunOn(worker, [] { return 1; });
+        };
+        result = CoSpawn(home, coroutine(*worker));
+        REQUIRE(result.has_value());
+
+        /* Wait for the step to be queued on the worker, then drop it */
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        delete worker;
+    }
+
+    REQUIRE_THROWS_AS(result->get(), std::future_error);
+}
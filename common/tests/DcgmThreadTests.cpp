@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmThread.h>
+
+#include <atomic>
+#include <chrono>
+#include <poll.h>
+#include <thread>
+
+namespace
+{
+/* Sleeps for an hour at a time, counting how often it's woken up */
+class SleepyThread : public DcgmThread
+{
+public:
+    std::atomic_int m_numWakes = 0;
+
+    SleepyThread()
+        : DcgmThread("sleepy")
+    {}
+
+    void run() override
+    {
+        while (!ShouldStop())
+        {
+            if (SleepUntil(std::chrono::steady_clock::now() + std::chrono::hours(1)))
+            {
+                m_numWakes++;
+            }
+        }
+    }
+};
+} // namespace
+
+TEST_CASE("DcgmThread: Stop wakes a sleeping thread right away")
+{
+    SleepyThread thread;
+    REQUIRE(thread.Start() == 0);
+
+    thread.Wake();
+    auto const wakeDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (thread.m_numWakes == 0 && std::chrono::steady_clock::now() < wakeDeadline)
+    {
+        std::this_thread::yield();
+    }
+    CHECK(thread.m_numWakes >= 1);
+
+    auto const start = std::chrono::steady_clock::now();
+    CHECK(thread.StopAndWait(10000) == 0);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
+
+TEST_CASE("DcgmThread: Wake fd")
+{
+    SleepyThread thread;
+    int const wakeFd = thread.GetWakeFd();
+    REQUIRE(wakeFd >= 0);
+
+    struct pollfd pfd
+    {
+        wakeFd, POLLIN, 0
+    };
+    CHECK(poll(&pfd, 1, 0) == 0);
+
+    /* A wake that comes before the sleep isn't lost */
+    thread.Wake();
+    CHECK(poll(&pfd, 1, 0) == 1);
+    CHECK(thread.SleepUntil(std::chrono::steady_clock::now() + std::chrono::hours(1)));
+    CHECK(poll(&pfd, 1, 0) == 0);
+    CHECK_FALSE(thread.ConsumeWake());
+    CHECK_FALSE(thread.SleepUntil(std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+
+    /* Stays readable once stopped */
+    thread.Stop();
+    thread.ConsumeWake();
+    CHECK(poll(&pfd, 1, 0) == 1);
+}
@@ -18,8 +18,11 @@
 
 #include <DcgmException.hpp>
 #include <chrono>
+#include <cstdlib>
+#include <filesystem>
 #include <map>
 #include <set>
+#include <sys/stat.h>
 #include <unordered_set>
 
 #include <catch2/catch_all.hpp>
@@ -143,3 +146,49 @@ TEST_CASE("Dcgmi Config: Bitmask helper")
         REQUIRE(result == "Not Specified");
     }
 }
+
+TEST_CASE("Utils: EnsureWritableCudaJitCache")
+{
+    std::string const savedHome = getenv("HOME") == nullptr ? "" : getenv("HOME");
+    unsetenv("CUDA_CACHE_PATH");
+    unsetenv("CUDA_CACHE_DISABLE");
+    unsetenv("HOME");
+
+    char tmpl[] = "/tmp/dcgm-jit-cache-test-XXXXXX";
+    REQUIRE(mkdtemp(tmpl) != nullptr);
+    std::string const parent = tmpl;
+    std::string const dir    = parent + "/cache";
+
+    SECTION("Already set")
+    {
+        setenv("CUDA_CACHE_PATH", "/somewhere", 1);
+        CHECK(DcgmNs::Utils::EnsureWritableCudaJitCache(dir) == std::nullopt);
+        CHECK(std::string(getenv("CUDA_CACHE_PATH")) == "/somewhere");
+    }
+
+    SECTION("No home directory")
+    {
+        CHECK(DcgmNs::Utils::EnsureWritableCudaJitCache(dir) == dir);
+        REQUIRE(getenv("CUDA_CACHE_PATH") != nullptr);
+        CHECK(std::string(getenv("CUDA_CACHE_PATH")) == dir);
+
+        struct stat st {};
+        REQUIRE(stat(dir.c_str(), &st) == 0);
+        CHECK((st.st_mode & 0777) == 0700);
+    }
+
+    SECTION("Fallback writable by others")
+    {
+        REQUIRE(mkdir(dir.c_str(), 0700) == 0);
+        REQUIRE(chmod(dir.c_str(), 0777) == 0);
+        CHECK(DcgmNs::Utils::EnsureWritableCudaJitCache(dir) == std::nullopt);
+        CHECK(getenv("CUDA_CACHE_PATH") == nullptr);
+    }
+
+    unsetenv("CUDA_CACHE_PATH");
+    if (!savedHome.empty())
+    {
+        setenv("HOME", savedHome.c_str(), 1);
+    }
+    std::filesystem::remove_all(parent);
+}
@@ -20,6 +20,8 @@
 
 #include <EntityListHelpers.h>
 
+#include <algorithm>
+
 namespace
 {
 
@@ -435,6 +437,78 @@ TEST_CASE("ParseEntityIdsAndFilterGpu")
     }
 }
 
+TEST_CASE("EntitySelector")
+{
+    std::string const gpuUuid        = "GPU-26a0ce63-ce32-b34e-acf2-5a0273328ee5";
+    dcgmMigHierarchy_v2 migHierarchy = CreateFakeMigHierachy(gpuUuid);
+    std::vector<std::pair<unsigned, std::string>> gpuIdUuids { { 0, gpuUuid } };
+
+    auto const entityMap = DcgmNs::PopulateEntitiesMap(migHierarchy, gpuIdUuids);
+    auto const version   = DcgmNs::EntityMapVersion(migHierarchy, gpuIdUuids);
+
+    SECTION("Same results as parsing the string")
+    {
+        for (std::string const entityIds : { "",
+                                             "0,1,{2-3},gpu:4",
+                                             "GPU-26a0ce63-ce32-b34e-acf2-5a0273328ee5,0/5,*/*/*,cpu:1",
+                                             "nvswitch:0,instance:0,compute_instance:{0-1}",
+                                             "0,,1",
+                                             ",",
+                                             "0,bob",
+                                             "{0-1",
+                                             "gpu:*",
+                                             "0,cpu:*" })
+        {
+            INFO(entityIds);
+
+            auto [expected, rejectedIds] = DcgmNs::TryParseEntityList(entityMap, entityIds);
+            std::vector<dcgmGroupEntityPair_t> legacy;
+            std::string const expectedErr = DcgmNs::EntityListParser(rejectedIds, legacy);
+            expected.insert(expected.end(), legacy.begin(), legacy.end());
+
+            auto const selector = DcgmNs::EntitySelector::Get(entityIds);
+            CHECK(selector == DcgmNs::EntitySelector::Get(entityIds));
+
+            /* The second time comes from the cached result */
+            for (int i = 0; i < 2; i++)
+            {
+                std::vector<dcgmGroupEntityPair_t> entityGroups;
+                std::string const err = selector->Resolve(entityMap, version, entityGroups);
+                CHECK(err == expectedErr);
+                if (expectedErr.empty())
+                {
+                    CHECK(std::ranges::equal(entityGroups, expected, [](auto const &left, auto const &right) {
+                        return left.entityGroupId == right.entityGroupId && left.entityId == right.entityId;
+                    }));
+                }
+                else
+                {
+                    CHECK(entityGroups.empty());
+                }
+            }
+        }
+    }
+
+    SECTION("A new hierarchy version resolves again")
+    {
+        auto const selector = DcgmNs::EntitySelector::Get("*/*");
+
+        std::vector<dcgmGroupEntityPair_t> entityGroups;
+        CHECK(selector->Resolve(entityMap, version, entityGroups).empty());
+        REQUIRE(entityGroups.size() == 1);
+        CHECK(entityGroups[0].entityGroupId == DCGM_FE_GPU_I);
+
+        dcgmMigHierarchy_v2 const noMig {};
+        auto const noMigMap     = DcgmNs::PopulateEntitiesMap(noMig, gpuIdUuids);
+        auto const noMigVersion = DcgmNs::EntityMapVersion(noMig, gpuIdUuids);
+        CHECK(noMigVersion != version);
+
+        entityGroups.clear();
+        CHECK(selector->Resolve(noMigMap, noMigVersion, entityGroups).empty());
+        CHECK(entityGroups.empty());
+    }
+}
+
 TEST_CASE("ParseExpectedNumEntitiesForGpus")
 {
     SECTION("Default string")
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmFvBufferV2.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace
+{
+/* Add rows of every type to fvBuffer. Every 10th row is a string and every 100th a blob */
+void AddRows(DcgmFvBufferV2 &fvBuffer, size_t rowCount)
+{
+    for (size_t i = 0; i < rowCount; i++)
+    {
+        dcgmReturn_t dcgmReturn;
+        if (i % 100 == 0)
+        {
+            std::string const blob(1 + i % 4000, (char)i);
+            dcgmReturn = fvBuffer.AddBlobValue(DCGM_FE_GPU, i % 8, 100, blob.data(), blob.size(), 1000 + i, DCGM_ST_OK);
+        }
+        else if (i % 10 == 0)
+        {
+            dcgmReturn = fvBuffer.AddStringValue(
+                DCGM_FE_GPU, i % 8, 101, std::to_string(i).c_str(), 1000 + i, DCGM_ST_NO_DATA);
+        }
+        else if (i % 2 == 0)
+        {
+            dcgmReturn = fvBuffer.AddDoubleValue(DCGM_FE_GPU_I, i % 8, 102, i * 0.5, 1000 + i, DCGM_ST_OK);
+        }
+        else
+        {
+            dcgmReturn = fvBuffer.AddInt64Value(DCGM_FE_SWITCH, i % 8, 103, -(long long)i, 1000 + i, DCGM_ST_OK);
+        }
+        REQUIRE(dcgmReturn == DCGM_ST_OK);
+    }
+}
+
+/* Check that fvBuffer holds exactly what AddRows() added */
+void RequireRows(DcgmFvBufferV2 const &fvBuffer, size_t rowCount)
+{
+    REQUIRE(fvBuffer.GetRowCount() == rowCount);
+
+    auto fv = std::make_unique<dcgmBufferedFv_t>();
+    for (size_t i = 0; i < rowCount; i++)
+    {
+        REQUIRE(fvBuffer.GetBufferedFv(i, *fv) == DCGM_ST_OK);
+        REQUIRE(fv->entityId == i % 8);
+        REQUIRE(fv->timestamp == (long long)(1000 + i));
+
+        if (i % 100 == 0)
+        {
+            std::string const blob(1 + i % 4000, (char)i);
+            REQUIRE(fv->fieldType == DCGM_FT_BINARY);
+            REQUIRE(fvBuffer.GetVarValue(i) == blob);
+            REQUIRE(memcmp(fv->value.blob, blob.data(), blob.size()) == 0);
+        }
+        else if (i % 10 == 0)
+        {
+            REQUIRE(fv->fieldType == DCGM_FT_STRING);
+            REQUIRE(fv->status == DCGM_ST_NO_DATA);
+            REQUIRE(std::string(fv->value.str) == std::to_string(i));
+        }
+        else if (i % 2 == 0)
+        {
+            REQUIRE(fv->fieldType == DCGM_FT_DOUBLE);
+            REQUIRE(fv->entityGroupId == DCGM_FE_GPU_I);
+            REQUIRE(fv->value.dbl == i * 0.5);
+            REQUIRE(fvBuffer.GetVarValue(i).empty());
+        }
+        else
+        {
+            REQUIRE(fv->fieldType == DCGM_FT_INT64);
+            REQUIRE(fv->entityGroupId == DCGM_FE_SWITCH);
+            REQUIRE(fv->fieldId == 103);
+            REQUIRE(fv->value.i64 == -(long long)i);
+        }
+    }
+
+    REQUIRE(fvBuffer.GetBufferedFv(rowCount, *fv) == DCGM_ST_BADPARAM);
+}
+} // namespace
+
+TEST_CASE("FvBufferV2: Rows span chunks")
+{
+    DcgmFvBufferV2 fvBuffer;
+    AddRows(fvBuffer, 2500);
+    RequireRows(fvBuffer, 2500);
+
+    REQUIRE(fvBuffer.GetChunkCount() == 3);
+    REQUIRE(fvBuffer.GetChunk(0).count == DcgmFvBufferV2::c_chunkRows);
+    REQUIRE(fvBuffer.GetChunk(2).count == 2500 - 2 * DcgmFvBufferV2::c_chunkRows);
+    REQUIRE(fvBuffer.GetChunk(1).values[1].i64 == -(long long)(DcgmFvBufferV2::c_chunkRows + 1));
+}
+
+TEST_CASE("FvBufferV2: Bad values")
+{
+    DcgmFvBufferV2 fvBuffer;
+    std::string const tooLong(DCGM_MAX_STR_LENGTH, 'a');
+    std::string const tooBig(DCGM_MAX_BLOB_LENGTH + 1, 'a');
+
+    REQUIRE(fvBuffer.AddStringValue(DCGM_FE_GPU, 0, 1, "", 0, DCGM_ST_OK) == DCGM_ST_BADPARAM);
+    REQUIRE(fvBuffer.AddStringValue(DCGM_FE_GPU, 0, 1, tooLong.c_str(), 0, DCGM_ST_OK) == DCGM_ST_BADPARAM);
+    REQUIRE(fvBuffer.AddBlobValue(DCGM_FE_GPU, 0, 1, tooBig.data(), tooBig.size(), 0, DCGM_ST_OK) == DCGM_ST_BADPARAM);
+    REQUIRE(fvBuffer.GetRowCount() == 0);
+}
+
+TEST_CASE("FvBufferV2: Serialize round trip")
+{
+    DcgmFvBufferV2 fvBuffer;
+    AddRows(fvBuffer, 1500);
+
+    std::vector<char> bytes;
+    REQUIRE(fvBuffer.Serialize(bytes) == DCGM_ST_OK);
+    REQUIRE(DcgmFvBufferV2::IsV2(bytes.data(), bytes.size()));
+
+    DcgmFvBufferV2 copy;
+    REQUIRE(copy.SetFromBuffer(bytes.data(), bytes.size()) == DCGM_ST_OK);
+    RequireRows(copy, 1500);
+
+    /* Truncated */
+    REQUIRE(copy.SetFromBuffer(bytes.data(), bytes.size() - 8) == DCGM_ST_BADPARAM);
+
+    /* From a later version */
+    bytes[4] = 2;
+    REQUIRE(copy.SetFromBuffer(bytes.data(), bytes.size()) == DCGM_ST_VER_MISMATCH);
+}
+
+TEST_CASE("FvBufferV2: From a DcgmFvBuffer")
+{
+    DcgmFvBuffer v1;
+    v1.AddInt64Value(DCGM_FE_GPU, 1, 150, 42, 1000, DCGM_ST_OK);
+    v1.AddDoubleValue(DCGM_FE_GPU, 2, 151, 4.5, 1001, DCGM_ST_OK);
+    v1.AddStringValue(DCGM_FE_GPU, 3, 152, "hello", 1002, DCGM_ST_OK);
+
+    size_t bufferSize = 0, elementCount = 0;
+    REQUIRE(v1.GetSize(&bufferSize, &elementCount) == DCGM_ST_OK);
+    REQUIRE(!DcgmFvBufferV2::IsV2(v1.GetBuffer(), bufferSize));
+
+    DcgmFvBufferV2 fvBuffer;
+    REQUIRE(fvBuffer.SetFromBuffer(v1.GetBuffer(), bufferSize) == DCGM_ST_OK);
+    REQUIRE(fvBuffer.GetRowCount() == 3);
+
+    /* Rebuilt records match the originals byte for byte */
+    auto fv                       = std::make_unique<dcgmBufferedFv_t>();
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (size_t row = 0; row < 3; row++)
+    {
+        dcgmBufferedFv_t *expected = v1.GetNextFv(&cursor);
+        REQUIRE(expected != nullptr);
+        REQUIRE(fvBuffer.GetBufferedFv(row, *fv) == DCGM_ST_OK);
+        REQUIRE(fv->length == expected->length);
+        REQUIRE(memcmp(fv.get(), expected, expected->length) == 0);
+    }
+}
+
+TEST_CASE("FvBufferV2: Clear keeps storage for reuse")
+{
+    DcgmFvBufferV2 fvBuffer;
+    AddRows(fvBuffer, 1100);
+    DcgmFvBufferV2::Chunk const *firstChunk = &fvBuffer.GetChunk(0);
+
+    fvBuffer.Clear();
+    REQUIRE(fvBuffer.GetRowCount() == 0);
+    REQUIRE(fvBuffer.GetChunkCount() == 0);
+
+    AddRows(fvBuffer, 300);
+    RequireRows(fvBuffer, 300);
+    REQUIRE(&fvBuffer.GetChunk(0) == firstChunk);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmFvColumns.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstring>
+#include <memory>
+
+namespace
+{
+/* Check that fv2 holds the same value as a buffered fv */
+void RequireSameValue(dcgmBufferedFv_t *fv, dcgmFieldValue_v2 const &fv2)
+{
+    auto expected = std::make_unique<dcgmFieldValue_v2>();
+    DcgmFvBuffer::ConvertBufferedFvToFv2(fv, expected.get());
+
+    REQUIRE(fv2.entityGroupId == expected->entityGroupId);
+    REQUIRE(fv2.entityId == expected->entityId);
+    REQUIRE(fv2.fieldId == expected->fieldId);
+    REQUIRE(fv2.fieldType == expected->fieldType);
+    REQUIRE(fv2.status == expected->status);
+    REQUIRE(fv2.ts == expected->ts);
+
+    switch (fv2.fieldType)
+    {
+        case DCGM_FT_INT64:
+            REQUIRE(fv2.value.i64 == expected->value.i64);
+            break;
+        case DCGM_FT_DOUBLE:
+            REQUIRE(fv2.value.dbl == expected->value.dbl);
+            break;
+        case DCGM_FT_STRING:
+            REQUIRE(std::string(fv2.value.str) == std::string(expected->value.str));
+            break;
+        default:
+            FAIL("Unexpected field type");
+    }
+}
+
+/* Decode the payload in bytes and compare it to fvBuffer */
+void RequireRoundTrip(DcgmFvBuffer &fvBuffer, std::vector<char> const &bytes)
+{
+    DcgmFvColumns columns;
+    REQUIRE(columns.SetFromBuffer(bytes.data(), bytes.size()) == DCGM_ST_OK);
+
+    size_t bufferSize = 0, elementCount = 0;
+    fvBuffer.GetSize(&bufferSize, &elementCount);
+    REQUIRE(columns.GetRowCount() == elementCount);
+
+    auto fv2                      = std::make_unique<dcgmFieldValue_v2>();
+    dcgmBufferedFvCursor_t cursor = 0;
+    size_t row                    = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor), row++)
+    {
+        REQUIRE(columns.ConvertRowToFv2(row, fv2.get()) == DCGM_ST_OK);
+        RequireSameValue(fv, *fv2);
+    }
+}
+} // namespace
+
+TEST_CASE("FvColumns: dense latest values round trip")
+{
+    DcgmFvBuffer fvBuffer;
+    for (unsigned int gpuId = 0; gpuId < 4; gpuId++)
+    {
+        fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, 40 + gpuId, 1000 + gpuId, DCGM_ST_OK);
+        fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_POWER_USAGE, 100.5 * gpuId, 2000, DCGM_ST_OK);
+        fvBuffer.AddStringValue(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_NAME, "Some GPU", 3000, DCGM_ST_OK);
+    }
+
+    std::vector<char> bytes;
+    REQUIRE(DcgmFvColumns::Encode(fvBuffer, bytes) == DCGM_ST_OK);
+    REQUIRE(DcgmFvColumns::IsColumnar(bytes.data(), bytes.size()));
+
+    dcgm_fv_columns_header_t header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    REQUIRE(header.rowCount == 12);
+    REQUIRE(header.entityCount == 4);
+    REQUIRE(header.fieldCount == 3);
+    REQUIRE((header.flags & DCGM_FV_COLUMNS_FLAG_DENSE) != 0);
+    REQUIRE(header.invalidCount == 0);
+
+    size_t bufferSize = 0, elementCount = 0;
+    fvBuffer.GetSize(&bufferSize, &elementCount);
+    REQUIRE(bytes.size() < bufferSize);
+
+    RequireRoundTrip(fvBuffer, bytes);
+}
+
+TEST_CASE("FvColumns: sparse rows and error statuses round trip")
+{
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 1, DCGM_FI_DEV_GPU_TEMP, 50, 1000, DCGM_ST_OK);
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, 1, DCGM_FI_DEV_POWER_USAGE, DCGM_FP64_BLANK, 0, DCGM_ST_NOT_WATCHED);
+    fvBuffer.AddInt64Value(DCGM_FE_SWITCH, 7, DCGM_FI_DEV_GPU_TEMP, 60, 1001, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 1, DCGM_FI_DEV_GPU_TEMP, DCGM_INT64_BLANK, 0, DCGM_ST_NO_DATA);
+
+    std::vector<char> bytes;
+    REQUIRE(DcgmFvColumns::Encode(fvBuffer, bytes) == DCGM_ST_OK);
+
+    dcgm_fv_columns_header_t header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    REQUIRE((header.flags & DCGM_FV_COLUMNS_FLAG_DENSE) == 0);
+    REQUIRE(header.invalidCount == 2);
+
+    RequireRoundTrip(fvBuffer, bytes);
+}
+
+TEST_CASE("FvColumns: a serialized fvBuffer is accepted")
+{
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 42, 1000, DCGM_ST_OK);
+    fvBuffer.AddStringValue(DCGM_FE_NONE, 0, DCGM_FI_DRIVER_VERSION, "555.42", 1000, DCGM_ST_OK);
+
+    size_t bufferSize = 0, elementCount = 0;
+    fvBuffer.GetSize(&bufferSize, &elementCount);
+    REQUIRE(!DcgmFvColumns::IsColumnar(fvBuffer.GetBuffer(), bufferSize));
+
+    std::vector<char> bytes(fvBuffer.GetBuffer(), fvBuffer.GetBuffer() + bufferSize);
+    RequireRoundTrip(fvBuffer, bytes);
+}
+
+TEST_CASE("FvColumns: fields with values of two types aren't encoded")
+{
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 42, 1000, DCGM_ST_OK);
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, 1, DCGM_FI_DEV_GPU_TEMP, 42.0, 1000, DCGM_ST_OK);
+
+    std::vector<char> bytes;
+    REQUIRE(DcgmFvColumns::Encode(fvBuffer, bytes) == DCGM_ST_NOT_SUPPORTED);
+}
+
+TEST_CASE("FvColumns: malformed payloads are rejected")
+{
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddStringValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_NAME, "Some GPU", 1000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 42, 1000, DCGM_ST_OK);
+
+    std::vector<char> bytes;
+    REQUIRE(DcgmFvColumns::Encode(fvBuffer, bytes) == DCGM_ST_OK);
+
+    DcgmFvColumns columns;
+
+    SECTION("Truncated")
+    {
+        for (size_t size = sizeof(std::uint32_t); size < bytes.size(); size++)
+        {
+            REQUIRE(columns.SetFromBuffer(bytes.data(), size) == DCGM_ST_BADPARAM);
+            REQUIRE(columns.GetRowCount() == 0);
+        }
+    }
+
+    SECTION("Unknown version")
+    {
+        dcgm_fv_columns_header_t header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        header.version = DCGM_FV_COLUMNS_VERSION + 1;
+        memcpy(bytes.data(), &header, sizeof(header));
+        REQUIRE(columns.SetFromBuffer(bytes.data(), bytes.size()) == DCGM_ST_VER_MISMATCH);
+    }
+
+    SECTION("Var offset past the end")
+    {
+        /* The final var offset is the last 4 bytes before the string data */
+        size_t endOffset     = bytes.size() - strlen("Some GPU") - sizeof(std::uint32_t);
+        std::uint32_t badEnd = 1000;
+        memcpy(&bytes[endOffset], &badEnd, sizeof(badEnd));
+        REQUIRE(columns.SetFromBuffer(bytes.data(), bytes.size()) == DCGM_ST_BADPARAM);
+    }
+}
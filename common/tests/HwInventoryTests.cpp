@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <HwInventory.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace
+{
+
+class InventoryFileSystem : public FileSystemOperator
+{
+public:
+    std::optional<std::string> Read(std::string_view path) override
+    {
+        auto const it = m_files.find(std::string(path));
+        if (it == m_files.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::unordered_map<std::string, std::string> m_files;
+};
+
+class InventoryLsHw : public LsHw
+{
+public:
+    std::optional<std::vector<std::string>> GetCpuSerials() const override
+    {
+        m_calls++;
+        return std::vector<std::string> { "serial0", "serial1" };
+    }
+
+    mutable std::atomic<int> m_calls = 0;
+};
+
+std::unique_ptr<InventoryFileSystem> MakeTwoNodeSystem(std::string const &bootId)
+{
+    auto fileSystem     = std::make_unique<InventoryFileSystem>();
+    fileSystem->m_files = {
+        { HW_INVENTORY_BOOT_ID_PATH, bootId + "\n" },
+        { HW_INVENTORY_NODES_PATH, "0-1\n" },
+        { "/sys/devices/system/node/node0/cpulist", "0-3,8-11\n" },
+        { "/sys/devices/system/node/node1/cpulist", "4-7\n" },
+        { "/sys/devices/system/cpu/cpu0/topology/physical_package_id", "0\n" },
+        { "/sys/devices/system/cpu/cpu4/topology/physical_package_id", "1\n" },
+    };
+    return fileSystem;
+}
+
+} // namespace
+
+TEST_CASE("HwInventory::ParseList")
+{
+    CHECK(HwInventory::ParseList("") == std::vector<unsigned int> {});
+    CHECK(HwInventory::ParseList("3") == std::vector<unsigned int> { 3 });
+    CHECK(HwInventory::ParseList("0-2,5,7-8") == std::vector<unsigned int> { 0, 1, 2, 5, 7, 8 });
+    CHECK(!HwInventory::ParseList("0-").has_value());
+    CHECK(!HwInventory::ParseList("2-1").has_value());
+    CHECK(!HwInventory::ParseList("0-1-2").has_value());
+    CHECK(!HwInventory::ParseList("a").has_value());
+    CHECK(!HwInventory::ParseList("0-4294967295").has_value());
+}
+
+TEST_CASE("HwInventory: snapshot is read once")
+{
+    auto lshw              = std::make_unique<InventoryLsHw>();
+    InventoryLsHw *lshwPtr = lshw.get();
+    HwInventory inventory(MakeTwoNodeSystem("boot-a"), std::move(lshw), "");
+
+    auto snapshot = inventory.Get();
+    REQUIRE(snapshot != nullptr);
+    CHECK(snapshot->bootId == "boot-a");
+    REQUIRE(snapshot->numaNodes.size() == 2);
+    CHECK(snapshot->numaNodes[0] == HwInventoryNumaNode { 0, "0-3,8-11", 0 });
+    CHECK(snapshot->numaNodes[1] == HwInventoryNumaNode { 1, "4-7", 1 });
+    REQUIRE(snapshot->cpuSerials.has_value());
+    CHECK(snapshot->cpuSerials->size() == 2);
+
+    CHECK(inventory.Get() == snapshot);
+    CHECK(lshwPtr->m_calls == 1);
+}
+
+TEST_CASE("HwInventory: missing sysfs files")
+{
+    auto fileSystem = MakeTwoNodeSystem("boot-a");
+    fileSystem->m_files.erase("/sys/devices/system/cpu/cpu4/topology/physical_package_id");
+    HwInventory inventory(std::move(fileSystem), std::make_unique<InventoryLsHw>(), "");
+
+    auto snapshot = inventory.Get();
+    REQUIRE(snapshot->numaNodes.size() == 2);
+    CHECK(snapshot->numaNodes[0].physicalPackageId == 0);
+    CHECK(!snapshot->numaNodes[1].physicalPackageId.has_value());
+
+    auto noNodes = std::make_unique<InventoryFileSystem>();
+    HwInventory emptyInventory(std::move(noNodes), std::make_unique<InventoryLsHw>(), "");
+    CHECK(emptyInventory.Get()->numaNodes.empty());
+    CHECK(emptyInventory.Get()->bootId.empty());
+}
+
+TEST_CASE("HwInventory: json round trip")
+{
+    HwInventorySnapshot snapshot;
+    snapshot.bootId    = "boot-a";
+    snapshot.numaNodes = { { 0, "0-3", 0 }, { 2, "4-7", std::nullopt } };
+
+    auto parsed = HwInventory::FromJson(HwInventory::ToJson(snapshot));
+    REQUIRE(parsed.has_value());
+    CHECK(*parsed == snapshot);
+    CHECK(!parsed->cpuSerials.has_value());
+
+    snapshot.cpuSerials = std::vector<std::string> { "serial0" };
+    parsed              = HwInventory::FromJson(HwInventory::ToJson(snapshot));
+    REQUIRE(parsed.has_value());
+    CHECK(*parsed == snapshot);
+
+    CHECK(!HwInventory::FromJson("not json").has_value());
+    CHECK(!HwInventory::FromJson("{}").has_value());
+}
+
+TEST_CASE("HwInventory: cache file of the same boot is used")
+{
+    std::string const cachePath
+        = (std::filesystem::temp_directory_path() / fmt::format("dcgm-hw-inventory-test-{}.json", getpid())).string();
+
+    HwInventorySnapshot cached;
+    cached.bootId    = "boot-a";
+    cached.numaNodes = { { 0, "0-63", 0 } };
+    std::ofstream(cachePath) << HwInventory::ToJson(cached);
+
+    SECTION("Same boot")
+    {
+        auto lshw              = std::make_unique<InventoryLsHw>();
+        InventoryLsHw *lshwPtr = lshw.get();
+        HwInventory inventory(MakeTwoNodeSystem("boot-a"), std::move(lshw), cachePath);
+
+        CHECK(*inventory.Get() == cached);
+        CHECK(lshwPtr->m_calls == 0);
+    }
+
+    SECTION("Another boot")
+    {
+        HwInventory inventory(MakeTwoNodeSystem("boot-b"), std::make_unique<InventoryLsHw>(), cachePath);
+
+        auto snapshot = inventory.Get();
+        CHECK(snapshot->bootId == "boot-b");
+        CHECK(snapshot->numaNodes.size() == 2);
+    }
+
+    std::filesystem::remove(cachePath);
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DcgmJsonSerialize.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace DcgmNs::JsonSerialize;
+
+namespace JsonStreamTests
+{
+struct Sample
+{
+    long long timestamp;
+    double value;
+};
+
+struct Series
+{
+    std::string name;
+    std::vector<Sample> samples;
+};
+
+void ToJson(JsonWriter &writer, Series const &series)
+{
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(series.name);
+    writer.Key("samples");
+    writer.StartArray();
+    for (auto const &sample : series.samples)
+    {
+        writer.StartObject();
+        writer.Key("timestamp");
+        writer.Int(sample.timestamp);
+        writer.Key("value");
+        writer.Double(sample.value);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+}
+
+std::optional<Series> ParseJson(JsonReader &reader, To<Series>)
+{
+    Series series;
+    bool const ok = ReadObject(reader, [&](std::string_view key) {
+        if (key == "name")
+        {
+            if (reader.Next() != JsonToken::String)
+            {
+                return false;
+            }
+            series.name = reader.GetString();
+            return true;
+        }
+        if (key == "samples")
+        {
+            return ReadArray(reader, [&]() {
+                Sample &sample = series.samples.emplace_back();
+                return ReadObject(reader, [&](std::string_view sampleKey) {
+                    bool const isTimestamp = sampleKey == "timestamp";
+                    if (reader.Next() != JsonToken::Number)
+                    {
+                        return false;
+                    }
+                    if (isTimestamp)
+                    {
+                        sample.timestamp = reader.GetInt64();
+                    }
+                    else
+                    {
+                        sample.value = reader.GetDouble();
+                    }
+                    return true;
+                });
+            });
+        }
+        return reader.SkipValue();
+    });
+
+    return ok ? std::optional<Series> { std::move(series) } : std::nullopt;
+}
+
+/* Only has the Json::Value customization points */
+struct Legacy
+{
+    int i;
+};
+
+Json::Value ToJson(Legacy const &legacy)
+{
+    Json::Value root;
+    root["i"]           = legacy.i;
+    return root;
+}
+} // namespace JsonStreamTests
+
+using JsonStreamTests::Legacy;
+using JsonStreamTests::Series;
+
+TEST_CASE("JsonStream: Round trip without Json::Value")
+{
+    Series series { "power \"W\"\n", {} };
+    for (int i = 0; i < 1000; i++)
+    {
+        series.samples.push_back({ 1000000 + i, i * 0.25 });
+    }
+
+    for (bool pretty : { false, true })
+    {
+        std::string const json = SerializeToString(series, pretty);
+
+        auto const parsed = TryDeserialize<Series>(std::string_view { json });
+        REQUIRE(parsed.has_value());
+        CHECK(parsed->name == series.name);
+        REQUIRE(parsed->samples.size() == series.samples.size());
+        for (size_t i = 0; i < series.samples.size(); i++)
+        {
+            CHECK(parsed->samples[i].timestamp == series.samples[i].timestamp);
+            CHECK(parsed->samples[i].value == series.samples[i].value);
+        }
+
+        /* jsoncpp reads the same thing */
+        Json::Value root;
+        std::istringstream in(json);
+        in >> root;
+        CHECK(root["name"].asString() == series.name);
+        CHECK(root["samples"][10]["value"].isDouble());
+        CHECK(root["samples"][10]["value"].asDouble() == 2.5);
+        CHECK(root["samples"][999]["timestamp"].asInt64() == 1000999);
+    }
+
+    CHECK(!TryDeserialize<Series>(std::string_view { R"({"name": "x", "samples": [{"timestamp": "bad"}]})" }));
+    CHECK(!TryDeserialize<Series>(std::string_view { R"({"name": "x"} extra)" }));
+    CHECK_THROWS(Deserialize<Series>(std::string_view { R"({"name": )" }));
+}
+
+TEST_CASE("JsonStream: Writer matches jsoncpp")
+{
+    Json::Value root;
+    root["string"]      = "tab\there \x01 \\ \"quoted\" ünïcode";
+    root["int"]         = -42;
+    root["uint"]        = Json::UInt64(18446744073709551615ULL);
+    root["double"]      = 1e-7;
+    root["whole"]       = 3.0;
+    root["bool"]        = true;
+    root["null"]        = Json::Value();
+    root["emptyArray"]  = Json::Value(Json::arrayValue);
+    root["emptyObject"] = Json::Value(Json::objectValue);
+
+    /* Elements 0 and 1 are implicitly null */
+    root["nested"]["array"][2] = "x";
+
+    /* Compare with what jsoncpp reads back from its own output. It fills in the implicit nulls */
+    Json::Value expected;
+    std::istringstream expectedIn(root.toStyledString());
+    expectedIn >> expected;
+
+    for (bool pretty : { false, true })
+    {
+        JsonWriter writer(pretty);
+        writer.Value(root);
+
+        Json::Value reread;
+        std::istringstream in(writer.GetString());
+        in >> reread;
+        CHECK(reread == expected);
+        CHECK(reread["whole"].isDouble());
+        CHECK(reread["nested"]["array"].size() == 3);
+    }
+
+    /* A Json::Value ToJson is used when there's no streaming one */
+    CHECK(SerializeToString(Legacy { 7 }) == R"({"i":7})");
+
+    JsonWriter writer;
+    writer.StartArray();
+    writer.Double(NAN);
+    writer.Double(INFINITY);
+    writer.EndArray();
+    CHECK(writer.GetString() == "[null,null]");
+}
+
+TEST_CASE("JsonStream: Writer flushes to the stream")
+{
+    std::ostringstream out;
+    JsonWriter writer(out);
+
+    writer.StartArray();
+    for (int i = 0; i < 100000; i++)
+    {
+        writer.Int(i);
+    }
+    /* Most of it was written out already */
+    CHECK(writer.GetString().size() < 100000);
+    writer.EndArray();
+    writer.Flush();
+    CHECK(writer.GetString().empty());
+
+    Json::Value root;
+    std::istringstream in(out.str());
+    in >> root;
+    REQUIRE(root.size() == 100000);
+    CHECK(root[99999].asInt() == 99999);
+}
+
+TEST_CASE("JsonStream: Reader tokens")
+{
+    std::string_view const json = R"(
+        // A comment
+        {
+            "a" : [1, -2.5, 1e3, 9223372036854775807, 18446744073709551615, NaN, -Infinity,],
+            'b': 'single \' quoted',
+            "c": "esc\"aped \u00e9 \ud83d\ude00 \/",
+            "d": {"e": [true, false, null, {}], }, /* trailing comma */
+            "f": []
+        }
+    )";
+
+    JsonReader reader(json);
+    REQUIRE(reader.Next() == JsonToken::StartObject);
+    REQUIRE(reader.Next() == JsonToken::Key);
+    CHECK(reader.GetString() == "a");
+    REQUIRE(reader.Next() == JsonToken::StartArray);
+
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(reader.IsInt64());
+    CHECK(reader.GetInt64() == 1);
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(!reader.IsInt64());
+    CHECK(reader.GetDouble() == -2.5);
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(reader.GetDouble() == 1000);
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(reader.GetInt64() == 9223372036854775807LL);
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(!reader.IsInt64());
+    CHECK(reader.GetDouble() == 18446744073709551615.0);
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(std::isnan(reader.GetDouble()));
+    REQUIRE(reader.Next() == JsonToken::Number);
+    CHECK(reader.GetDouble() == -INFINITY);
+    REQUIRE(reader.Next() == JsonToken::EndArray);
+
+    REQUIRE(reader.Next() == JsonToken::Key);
+    CHECK(reader.GetString() == "b");
+    REQUIRE(reader.Next() == JsonToken::String);
+    CHECK(reader.GetString() == "single ' quoted");
+
+    REQUIRE(reader.Next() == JsonToken::Key);
+    REQUIRE(reader.Next() == JsonToken::String);
+    CHECK(reader.GetString() == "esc\"aped \xc3\xa9 \xf0\x9f\x98\x80 /");
+
+    REQUIRE(reader.Next() == JsonToken::Key);
+    CHECK(reader.GetString() == "d");
+    CHECK(reader.SkipValue());
+
+    REQUIRE(reader.Next() == JsonToken::Key);
+    CHECK(reader.GetString() == "f");
+    REQUIRE(reader.Next() == JsonToken::StartArray);
+    REQUIRE(reader.Next() == JsonToken::EndArray);
+
+    REQUIRE(reader.Next() == JsonToken::EndObject);
+    REQUIRE(reader.Next() == JsonToken::End);
+}
+
+TEST_CASE("JsonStream: Reader errors")
+{
+    for (std::string_view json : { "", "{", "[1 2]", "{\"a\" 1}", "{\"a\":}", "[1,,2]", "[}", "\"abc", "tru",
+                                   "{\"a\":1}}", "1 2", "[1] /* unterminated", "\"\\x\"", "\"\\ud83d\"" })
+    {
+        INFO(json);
+        JsonReader reader(json);
+        JsonToken token;
+        do
+        {
+            token = reader.Next();
+        } while (token != JsonToken::Error && token != JsonToken::End);
+        CHECK(token == JsonToken::Error);
+        CHECK(!reader.GetError().empty());
+    }
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <MpmcQueue.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+using namespace DcgmNs;
+
+TEST_CASE("MpmcQueue: Capacity is rounded up")
+{
+    REQUIRE(MpmcQueue<int>(0).GetCapacity() == 2);
+    REQUIRE(MpmcQueue<int>(100).GetCapacity() == 128);
+    REQUIRE(MpmcQueue<int>(128).GetCapacity() == 128);
+}
+
+TEST_CASE("MpmcQueue: FIFO, full and empty")
+{
+    MpmcQueue<std::unique_ptr<int>> queue(4);
+
+    REQUIRE(!queue.TryDequeue().has_value());
+
+    /* Go around the ring a few times */
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            auto value = std::make_unique<int>(lap * 10 + i);
+            REQUIRE(queue.TryEnqueue(value));
+            REQUIRE(value == nullptr);
+        }
+        REQUIRE(queue.GetApproxSize() == 4);
+
+        auto extra = std::make_unique<int>(-1);
+        REQUIRE(!queue.TryEnqueue(extra));
+        REQUIRE(extra != nullptr); /* Not moved from when the queue is full */
+
+        for (int i = 0; i < 4; ++i)
+        {
+            auto value = queue.TryDequeue();
+            REQUIRE(value.has_value());
+            REQUIRE(**value == lap * 10 + i);
+        }
+        REQUIRE(!queue.TryDequeue().has_value());
+        REQUIRE(queue.GetApproxSize() == 0);
+    }
+}
+
+TEST_CASE("MpmcQueue: Remaining objects are destroyed with the queue")
+{
+    auto shared = std::make_shared<int>(1);
+    {
+        MpmcQueue<std::shared_ptr<int>> queue(8);
+        for (int i = 0; i < 5; ++i)
+        {
+            auto copy = shared;
+            REQUIRE(queue.TryEnqueue(copy));
+        }
+        REQUIRE(shared.use_count() == 6);
+    }
+    REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("MpmcQueue: Multiple producers and consumers")
+{
+    const int cNumProducers     = 8;
+    const int cNumConsumers     = 4;
+    const int cItemsPerProducer = 20000;
+
+    /* Small, so that producers often find it full */
+    MpmcQueue<int> queue(64);
+
+    std::atomic_int producersDone { 0 };
+    std::atomic_llong sum { 0 };
+    std::atomic_int consumed { 0 };
+
+    /* Each consumer checks that the items of each producer come out in the order they went in */
+    std::atomic_bool outOfOrder { false };
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < cNumProducers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < cItemsPerProducer; ++i)
+            {
+                int value = p * cItemsPerProducer + i;
+                while (!queue.TryEnqueue(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            producersDone.fetch_add(1);
+        });
+    }
+
+    for (int c = 0; c < cNumConsumers; ++c)
+    {
+        threads.emplace_back([&] {
+            std::vector<int> lastSeen(cNumProducers, -1);
+            while (true)
+            {
+                auto value = queue.TryDequeue();
+                if (!value.has_value())
+                {
+                    if (producersDone.load() == cNumProducers && queue.GetApproxSize() == 0)
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                int producer = *value / cItemsPerProducer;
+                if (*value <= lastSeen[producer])
+                {
+                    outOfOrder.store(true);
+                }
+                lastSeen[producer] = *value;
+
+                sum.fetch_add(*value);
+                consumed.fetch_add(1);
+            }
+        });
+    }
+
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+
+    long long const total = (long long)cNumProducers * cItemsPerProducer;
+    REQUIRE(consumed.load() == total);
+    REQUIRE(sum.load() == total * (total - 1) / 2);
+    REQUIRE(!outOfOrder.load());
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Enqueue/dequeue throughput of the TaskRunner queues.
+ * These are hidden from the default run. Use: commontests "[queue-benchmark]"
+ */
+#include <MpmcQueue.hpp>
+#include <ThreadSafeQueue.hpp>
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+using namespace DcgmNs;
+
+namespace
+{
+constexpr int cItemsPerRun = 1 << 18;
+
+/* Have numProducers threads push cItemsPerRun items in total while one consumer pops them all */
+template <class Push, class Pop>
+void RunThroughput(int numProducers, Push push, Pop pop)
+{
+    std::vector<std::thread> producers;
+    producers.reserve(numProducers);
+    for (int p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([&push, numProducers] {
+            for (int i = 0; i < cItemsPerRun / numProducers; ++i)
+            {
+                push(i);
+            }
+        });
+    }
+
+    int const expected = (cItemsPerRun / numProducers) * numProducers;
+    for (int consumed = 0; consumed < expected;)
+    {
+        consumed += pop();
+    }
+
+    for (auto &th : producers)
+    {
+        th.join();
+    }
+}
+} // namespace
+
+TEST_CASE("Queue throughput", "[.][queue-benchmark]")
+{
+    int const numProducers = GENERATE(1, 2, 4, 8, 16, 32);
+
+    BENCHMARK(fmt::format("ThreadSafeQueue, {} producers", numProducers))
+    {
+        ThreadSafeQueue<int> queue;
+        RunThroughput(
+            numProducers,
+            [&queue](int value) { queue.LockRW().Enqueue(value); },
+            [&queue] {
+                /* Drain everything at once like TaskRunner::Run() does */
+                std::queue<int> items;
+                {
+                    if (queue.LockRO().IsEmpty())
+                    {
+                        std::this_thread::yield();
+                        return 0;
+                    }
+                    auto handle = queue.LockRW();
+                    handle.Swap(items);
+                }
+                return (int)items.size();
+            });
+    };
+
+    BENCHMARK(fmt::format("MpmcQueue, {} producers", numProducers))
+    {
+        MpmcQueue<int> queue(4096);
+        RunThroughput(
+            numProducers,
+            [&queue](int value) {
+                while (!queue.TryEnqueue(value))
+                {
+                    std::this_thread::yield();
+                }
+            },
+            [&queue] {
+                int count = 0;
+                while (queue.TryDequeue().has_value())
+                {
+                    ++count;
+                }
+                if (count == 0)
+                {
+                    std::this_thread::yield();
+                }
+                return count;
+            });
+    };
+}
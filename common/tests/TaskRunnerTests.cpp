@@ -26,8 +26,8 @@ using namespace DcgmNs;
 class TestTaskRunner : public TaskRunner
 {
 public:
-    TestTaskRunner()
-        : TaskRunner()
+    explicit TestTaskRunner(TaskQueueKind queueKind = TaskQueueKind::Locked)
+        : TaskRunner(queueKind)
     {
         SetRunInterval(std::chrono::milliseconds(10));
     }
@@ -140,7 +140,7 @@ TEST_CASE("TaskRunner: Complex")
 
 TEST_CASE("TaskRunner: Complex with multiple runners")
 {
-    TaskRunner tr;
+    TaskRunner tr { GENERATE(TaskQueueKind::Locked, TaskQueueKind::LockFree) };
     std::atomic_bool stop { false };
     std::thread runner1([&tr, &stop] {
         while (!stop.load(std::memory_order_relaxed))
@@ -239,7 +239,7 @@ TEST_CASE("TaskRunner: Multiple runners", "[!mayfail]")
 TEST_CASE("TaskRunner: Limited Queue")
 {
     const size_t cTaskRunnerCapacity = 10;
-    TaskRunner tr;
+    TaskRunner tr { GENERATE(TaskQueueKind::Locked, TaskQueueKind::LockFree) };
     tr.SetQueueCapacity(cTaskRunnerCapacity);
 
     std::jthread runner([&tr](std::stop_token const &stop_token) {
@@ -312,3 +312,54 @@ TEST_CASE("TaskRunner: Task with attempts")
     REQUIRE_THROWS_AS((*fut).get(), std::future_error);
     tr.Stop();
 }
+
+TEST_CASE("TaskRunner: Lock-free queue overflow")
+{
+    /* The ring is sized from the default capacity, so most of these tasks spill over to the locked queue */
+    TestTaskRunner tr { TaskQueueKind::LockFree };
+    tr.SetQueueCapacity(10000);
+
+    const int cNumTasks = 5000;
+    std::vector<int> order;
+    order.reserve(cNumTasks);
+
+    for (int i = 0; i < cNumTasks; ++i)
+    {
+        auto fut = tr.Enqueue(make_task([&order, i] { order.push_back(i); }));
+        REQUIRE(fut.has_value());
+    }
+
+    REQUIRE(tr.Run(true) == TaskRunner::RunResult::Ok);
+    REQUIRE(order.size() == cNumTasks);
+    for (int i = 0; i < cNumTasks; ++i)
+    {
+        REQUIRE(order[i] == i);
+    }
+
+    /* The ring is used again once the overflow is drained */
+    auto fut = tr.Enqueue(make_task([] { return 10; }));
+    REQUIRE(tr.Run(true) == TaskRunner::RunResult::Ok);
+    REQUIRE(fut.has_value());
+    REQUIRE((*fut).get() == 10);
+}
+
+TEST_CASE("TaskRunner: Lock-free queue deferred")
+{
+    TestTaskRunner tr { TaskQueueKind::LockFree };
+    int runs = 0;
+
+    auto fut = tr.Enqueue(make_task([&runs]() mutable -> std::optional<int> {
+        if (++runs < 3)
+        {
+            return std::nullopt;
+        }
+        return runs;
+    }));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(tr.Run(true) == TaskRunner::RunResult::Ok);
+    }
+    REQUIRE(fut.has_value());
+    REQUIRE((*fut).get() == 3);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmThreadPlacement.h>
+
+namespace ThreadPlacement = DcgmNs::ThreadPlacement;
+
+TEST_CASE("ThreadPlacement: Threads are classed by name")
+{
+    CHECK(ThreadPlacement::ClassOfThread("cache_mgr_main") == "cache");
+    CHECK(ThreadPlacement::ClassOfThread("cache_mgr_gpu3") == "cache");
+    CHECK(ThreadPlacement::ClassOfThread("dcgm_ipc") == "ipc");
+    CHECK(ThreadPlacement::ClassOfThread("dcgm_ipc_worker") == "ipc");
+    CHECK(ThreadPlacement::ClassOfThread("mod_sysmon") == "modules");
+    CHECK(ThreadPlacement::ClassOfThread("dcgm_kmsg") == "kmsg");
+    CHECK(ThreadPlacement::ClassOfThread("dcgm_metrics") == "metrics");
+    CHECK(ThreadPlacement::ClassOfThread("co_timer_queue").empty());
+    CHECK(ThreadPlacement::ClassOfThread("").empty());
+}
+
+TEST_CASE("ThreadPlacement: CPU lists")
+{
+    CHECK(ThreadPlacement::ParseCpuList("0-3,8,10-11") == std::vector<unsigned int> { 0, 1, 2, 3, 8, 10, 11 });
+    CHECK(ThreadPlacement::ParseCpuList("5") == std::vector<unsigned int> { 5 });
+
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("3-1").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("1,,2").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("1-").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("a").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("1x").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseCpuList("0-100000").has_value());
+}
+
+TEST_CASE("ThreadPlacement: Specs")
+{
+    auto const spec = ThreadPlacement::ParseSpec("cache=0-3;ipc=auto");
+    REQUIRE(spec.has_value());
+    CHECK(spec->size() == 2);
+    CHECK(spec->at("cache") == "0-3");
+    CHECK(spec->at("ipc") == "auto");
+
+    CHECK_FALSE(ThreadPlacement::ParseSpec("unknown=1").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseSpec("cache=1;cache=2").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseSpec("cache").has_value());
+    CHECK_FALSE(ThreadPlacement::ParseSpec("cache=").has_value());
+
+    CHECK(ThreadPlacement::IsValidCpusSpec("cache=0-3;default=auto"));
+    CHECK_FALSE(ThreadPlacement::IsValidCpusSpec("cache=0-"));
+
+    CHECK(ThreadPlacement::IsValidNumaNodesSpec("cache=1;modules=auto"));
+    CHECK_FALSE(ThreadPlacement::IsValidNumaNodesSpec("cache=0-1"));
+    CHECK_FALSE(ThreadPlacement::IsValidNumaNodesSpec("cache=-1"));
+}
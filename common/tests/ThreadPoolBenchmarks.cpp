@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Throughput of the IPC worker pools under bursty load from many producers.
+ * These are hidden from the default run. Use: commontests "[thread-pool-benchmark]"
+ */
+#include <ThreadPool.hpp>
+#include <WorkStealingThreadPool.hpp>
+
+#include <catch2/catch_all.hpp>
+#include <fmt/format.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+using namespace DcgmNs;
+
+namespace
+{
+constexpr int cTasksPerRun = 1 << 16;
+constexpr int cWorkers     = 8;
+
+/*
+ * Have numProducers threads (think exporter connections) queue cTasksPerRun small tasks in total and wait for all
+ * of them to run. enqueue(producer, task) returns false if the task wasn't queued
+ */
+template <class EnqueueFunc>
+void RunBurst(int numProducers, EnqueueFunc enqueue)
+{
+    std::atomic_int done { 0 };
+    int const perProducer = cTasksPerRun / numProducers;
+
+    std::vector<std::thread> producers;
+    producers.reserve(numProducers);
+    for (int p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([&enqueue, &done, p, perProducer] {
+            for (int i = 0; i < perProducer; ++i)
+            {
+                while (!enqueue(p, [&done] { done.fetch_add(1, std::memory_order_relaxed); }))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto &th : producers)
+    {
+        th.join();
+    }
+
+    while (done.load(std::memory_order_relaxed) < perProducer * numProducers)
+    {
+        std::this_thread::yield();
+    }
+}
+} // namespace
+
+TEST_CASE("Thread pool throughput", "[.][thread-pool-benchmark]")
+{
+    int const numProducers = GENERATE(1, 4, 16, 64);
+
+    ThreadPool threadPool(cWorkers);
+    WorkStealingThreadPool workStealingPool(cWorkers);
+
+    BENCHMARK(fmt::format("ThreadPool, {} producers", numProducers))
+    {
+        RunBurst(numProducers, [&threadPool](int, auto task) { return threadPool.Enqueue(task).has_value(); });
+    };
+
+    BENCHMARK(fmt::format("WorkStealingThreadPool, {} producers", numProducers))
+    {
+        RunBurst(numProducers,
+                 [&workStealingPool](int, auto task) { return workStealingPool.Enqueue(task).has_value(); });
+    };
+
+    BENCHMARK(fmt::format("WorkStealingThreadPool with affinity, {} producers", numProducers))
+    {
+        RunBurst(numProducers, [&workStealingPool](int producer, auto task) {
+            return workStealingPool.Enqueue(producer, task).has_value();
+        });
+    };
+}
@@ -18,6 +18,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <thread>
+
 using namespace DcgmNs::Timelib;
 
 TEST_CASE("TimeLib: ToLegacyTimestamp")
@@ -36,3 +38,40 @@ TEST_CASE("TimeLib: FromLegacyTimestamp. Negative")
     REQUIRE(newTs == (-std::chrono::milliseconds(50)));
     REQUIRE(newTs == std::chrono::milliseconds(-50));
 }
+
+TEST_CASE("TimeLib: CycleClock")
+{
+    CycleClock clock {};
+
+    /* Stopped, it reads the wall clock */
+    auto const before  = ToLegacyTimestamp(Now());
+    auto const stopped = clock.Now();
+    REQUIRE(stopped >= before);
+    REQUIRE(stopped <= ToLegacyTimestamp(Now()));
+
+    auto const start = clock.StartCycle();
+    REQUIRE(start >= stopped);
+
+    std::int64_t prev = start;
+    for (int i = 0; i < 1000; i++)
+    {
+        auto const now = clock.Now();
+        REQUIRE(now >= prev);
+        prev = now;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    REQUIRE(clock.Now() - start >= 2000);
+
+    clock.Stop();
+    REQUIRE(clock.Now() >= prev);
+
+    /* A fixed cycle doesn't advance */
+    clock.StartFixedCycle(12345);
+    REQUIRE(clock.Now() == 12345);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    REQUIRE(clock.Now() == 12345);
+
+    REQUIRE(clock.StartCycle() > 12345);
+    REQUIRE(clock.Now() >= prev);
+}
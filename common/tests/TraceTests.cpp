@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmTrace.h>
+
+#include <json/json.h>
+
+#include <thread>
+
+namespace Trace = DcgmNs::Trace;
+
+namespace
+{
+Json::Value ParseTrace()
+{
+    Json::Value root;
+    Json::Reader reader;
+    REQUIRE(reader.parse(Trace::ToChromeTraceJson(), root));
+    return root;
+}
+} // namespace
+
+TEST_CASE("Trace: Scopes are recorded only while enabled")
+{
+    Trace::Clear();
+    Trace::Enable(false);
+    {
+        Trace::Scope scope("Disabled");
+    }
+
+    Trace::Enable(true);
+    {
+        Trace::Scope scope("Enabled", "gpuId", 3, "fieldId", 150);
+    }
+    std::thread([] { Trace::Scope scope("OtherThread"); }).join();
+    Trace::Enable(false);
+
+    Json::Value const root = ParseTrace();
+    REQUIRE(root["traceEvents"].size() == 2);
+
+    Json::Value const &event = root["traceEvents"][0];
+    CHECK(event["name"].asString() == "Enabled");
+    CHECK(event["ph"].asString() == "X");
+    CHECK(event["args"]["gpuId"].asInt() == 3);
+    CHECK(event["args"]["fieldId"].asInt() == 150);
+    CHECK(root["traceEvents"][1]["name"].asString() == "OtherThread");
+    CHECK(root["traceEvents"][1]["tid"].asInt64() != event["tid"].asInt64());
+}
+
+TEST_CASE("Trace: The ring keeps the newest events")
+{
+    Trace::Clear();
+    Trace::Enable(true);
+    for (int i = 0; i < DCGM_TRACE_EVENTS_PER_THREAD + 10; i++)
+    {
+        Trace::Scope scope("Event", "i", i);
+    }
+    Trace::Enable(false);
+
+    Json::Value const root = ParseTrace();
+    REQUIRE(root["traceEvents"].size() == DCGM_TRACE_EVENTS_PER_THREAD);
+    CHECK(root["traceEvents"][0]["args"]["i"].asInt() == 10);
+    CHECK(root["traceEvents"][DCGM_TRACE_EVENTS_PER_THREAD - 1]["args"]["i"].asInt()
+          == DCGM_TRACE_EVENTS_PER_THREAD + 9);
+}
@@ -93,6 +93,57 @@ TEST_CASE("WatchTable: RemoveConnectionWatches")
     }
 }
 
+TEST_CASE("WatchTable: Connection watch index")
+{
+    DcgmWatchTable wt;
+    std::unordered_map<int, std::vector<unsigned short>> postWatchInfo;
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        wt.AddWatcher(
+            DCGM_FE_GPU, i, DCGM_FI_DEV_GPU_TEMP, DcgmWatcher(DcgmWatcherTypeClient, 1), 1000, 1000000, false);
+        wt.AddWatcher(
+            DCGM_FE_GPU, i, DCGM_FI_DEV_GPU_TEMP, DcgmWatcher(DcgmWatcherTypeClient, 2), 5000, 1000000, false);
+    }
+    wt.AddWatcher(DCGM_FE_SWITCH, 0, DCGM_FI_DEV_GPU_TEMP, DcgmWatcher(DcgmWatcherTypeClient, 3), 10, 1000000, false);
+    CHECK(wt.HasConnectionWatches(1));
+    CHECK(wt.HasConnectionWatches(2));
+    CHECK(wt.HasConnectionWatches(3));
+    CHECK_FALSE(wt.HasConnectionWatches(4));
+
+    // Removing one watch at a time keeps the connection until its last watch is gone
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        CHECK(wt.HasConnectionWatches(1));
+        REQUIRE(wt.RemoveWatcher(DCGM_FE_GPU, i, DCGM_FI_DEV_GPU_TEMP, DcgmWatcher(DcgmWatcherTypeClient, 1), nullptr)
+                == DCGM_ST_OK);
+        REQUIRE(wt.GetUpdateIntervalUsec(DCGM_FE_GPU, i, DCGM_FI_DEV_GPU_TEMP) == 5000);
+    }
+    CHECK_FALSE(wt.HasConnectionWatches(1));
+
+    // Clearing an entity drops its watches from the index
+    REQUIRE(wt.ClearEntityWatches(DCGM_FE_SWITCH, 0) == DCGM_ST_OK);
+    CHECK_FALSE(wt.HasConnectionWatches(3));
+    REQUIRE(wt.RemoveConnectionWatches(3, &postWatchInfo) == DCGM_ST_OK);
+    CHECK(postWatchInfo.empty());
+
+    // RemoveWatches only visits the watches of the watcher's connection
+    REQUIRE(wt.RemoveWatches(DcgmWatcher(DcgmWatcherTypeClient, 2), &postWatchInfo) == DCGM_ST_OK);
+    CHECK_FALSE(wt.HasConnectionWatches(2));
+    REQUIRE(postWatchInfo.size() == 4);
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        REQUIRE(postWatchInfo[i].size() == 1);
+        CHECK(postWatchInfo[i][0] == DCGM_FI_DEV_GPU_TEMP);
+    }
+
+    // A connection can come back after all of its watches are gone
+    wt.AddWatcher(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, DcgmWatcher(DcgmWatcherTypeClient, 1), 1000, 1000000, false);
+    CHECK(wt.HasConnectionWatches(1));
+    wt.ClearWatches();
+    CHECK_FALSE(wt.HasConnectionWatches(1));
+}
+
 TEST_CASE("WatchTable: GetFieldsToUpdate")
 {
     DcgmWatchTable wt;
@@ -233,3 +284,82 @@ TEST_CASE("WatchTable: Removing watches recalculates updateInterval")
     CHECK(minUpdateInterval == 2);
     CHECK(maxUpdateInterval == 3);
 }
+
+TEST_CASE("WatchTable: GetFieldsToUpdate only returns due watches")
+{
+    DcgmWatchTable wt;
+    auto ret = DcgmFieldsInit();
+    REQUIRE(ret == DCGM_ST_OK);
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+
+    DcgmWatcher fastWatcher(DcgmWatcherTypeClient, 1);
+    DcgmWatcher slowWatcher(DcgmWatcherTypeClient, 2);
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        REQUIRE(wt.AddWatcher(DCGM_FE_GPU, i, DCGM_FI_DEV_GPU_TEMP, fastWatcher, 100, 1000000, false) == true);
+        REQUIRE(wt.AddWatcher(DCGM_FE_GPU, i, DCGM_FI_DEV_MEMORY_TEMP, slowWatcher, 1000, 1000000, false) == true);
+    }
+
+    std::vector<dcgm_field_update_info_t> toUpdate;
+    timelib64_t now                = 1000000;
+    timelib64_t earliestNextUpdate = 0;
+
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    CHECK(toUpdate.size() == 8);
+    CHECK(earliestNextUpdate == now + 100);
+
+    // Nothing is due yet
+    toUpdate.clear();
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now + 99, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    CHECK(toUpdate.empty());
+    CHECK(earliestNextUpdate == now + 100);
+
+    // Only the fast watches are due
+    toUpdate.clear();
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now + 100, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    REQUIRE(toUpdate.size() == 4);
+    for (auto const &updateInfo : toUpdate)
+    {
+        CHECK(updateInfo.fieldMeta->fieldId == DCGM_FI_DEV_GPU_TEMP);
+    }
+    CHECK(earliestNextUpdate == now + 200);
+
+    // A faster watcher reschedules the watch
+    REQUIRE(wt.AddWatcher(DCGM_FE_GPU, 0, DCGM_FI_DEV_MEMORY_TEMP, fastWatcher, 10, 1000000, false) == false);
+    toUpdate.clear();
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now + 110, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    REQUIRE(toUpdate.size() == 1);
+    CHECK(toUpdate[0].fieldMeta->fieldId == DCGM_FI_DEV_MEMORY_TEMP);
+    CHECK(toUpdate[0].entityId == 0);
+    CHECK(earliestNextUpdate == now + 120);
+
+    // Removing it goes back to the slow interval
+    REQUIRE(wt.RemoveWatcher(DCGM_FE_GPU, 0, DCGM_FI_DEV_MEMORY_TEMP, fastWatcher, nullptr) == DCGM_ST_OK);
+    toUpdate.clear();
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now + 120, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    CHECK(toUpdate.empty());
+    CHECK(earliestNextUpdate == now + 200);
+
+    // Unwatched and cleared watches aren't returned
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        REQUIRE(wt.RemoveWatcher(DCGM_FE_GPU, i, DCGM_FI_DEV_GPU_TEMP, fastWatcher, nullptr) == DCGM_ST_OK);
+    }
+    REQUIRE(wt.ClearEntityWatches(DCGM_FE_GPU, 1) == DCGM_ST_OK);
+    toUpdate.clear();
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now + 1110, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    CHECK(toUpdate.size() == 3);
+    for (auto const &updateInfo : toUpdate)
+    {
+        CHECK(updateInfo.fieldMeta->fieldId == DCGM_FI_DEV_MEMORY_TEMP);
+        CHECK(updateInfo.entityId != 1);
+    }
+    CHECK(earliestNextUpdate == now + 2110);
+
+    wt.ClearWatches();
+    toUpdate.clear();
+    REQUIRE(wt.GetFieldsToUpdate(DcgmModuleIdCore, now + 10000, toUpdate, earliestNextUpdate) == DCGM_ST_OK);
+    CHECK(toUpdate.empty());
+    CHECK(earliestNextUpdate == 0);
+}
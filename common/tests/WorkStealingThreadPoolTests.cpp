@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <WorkStealingThreadPool.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using namespace DcgmNs;
+
+TEST_CASE("WorkStealingThreadPool: Runs every task and returns results")
+{
+    WorkStealingThreadPool pool(4);
+    REQUIRE(pool.GetNumWorkers() == 4);
+
+    std::vector<std::shared_future<int>> results;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto result = pool.Enqueue([i] { return i * 2; });
+        REQUIRE(result.has_value());
+        results.push_back(*result);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        REQUIRE(results[i].get() == i * 2);
+    }
+}
+
+TEST_CASE("WorkStealingThreadPool: Tasks with the same key run in order on one thread")
+{
+    WorkStealingThreadPool pool(4);
+
+    constexpr int cKeys         = 8;
+    constexpr int cTasksPerKey  = 500;
+    std::vector<std::vector<int>> seen(cKeys);
+    std::vector<std::thread::id> threadOfKey(cKeys);
+    std::atomic_bool sameThread { true };
+
+    std::vector<std::shared_future<void>> results;
+    for (int i = 0; i < cTasksPerKey; ++i)
+    {
+        for (int key = 0; key < cKeys; ++key)
+        {
+            /* No locking: tasks of one key never run concurrently */
+            auto result = pool.Enqueue(key, [&seen, &threadOfKey, &sameThread, key, i] {
+                if (i == 0)
+                {
+                    threadOfKey[key] = std::this_thread::get_id();
+                }
+                else if (threadOfKey[key] != std::this_thread::get_id())
+                {
+                    sameThread = false;
+                }
+                seen[key].push_back(i);
+            });
+            REQUIRE(result.has_value());
+            results.push_back(*result);
+        }
+    }
+
+    for (auto &result : results)
+    {
+        result.get();
+    }
+
+    CHECK(sameThread);
+    for (int key = 0; key < cKeys; ++key)
+    {
+        REQUIRE(seen[key].size() == cTasksPerKey);
+        for (int i = 0; i < cTasksPerKey; ++i)
+        {
+            REQUIRE(seen[key][i] == i);
+        }
+    }
+}
+
+TEST_CASE("WorkStealingThreadPool: Idle workers steal from a busy one")
+{
+    WorkStealingThreadPool pool(2);
+
+    /* Keep worker 0 busy until the shared tasks queued behind it are done */
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker  = pool.Enqueue(0, [released] { released.wait(); });
+    REQUIRE(blocker.has_value());
+
+    std::atomic_int done { 0 };
+    std::vector<std::shared_future<void>> results;
+    for (int i = 0; i < 10; ++i)
+    {
+        /* Round-robin puts half of these on the blocked worker */
+        auto result = pool.Enqueue([&done] { ++done; });
+        REQUIRE(result.has_value());
+        results.push_back(*result);
+    }
+
+    for (auto &result : results)
+    {
+        REQUIRE(result.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    }
+    CHECK(done == 10);
+    CHECK(pool.GetStealCount() > 0);
+
+    release.set_value();
+    blocker->get();
+}
+
+TEST_CASE("WorkStealingThreadPool: Stop")
+{
+    WorkStealingThreadPool pool(2);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker  = pool.Enqueue(0, [released] { released.wait(); });
+    auto pending  = pool.Enqueue(0, [] { return 1; });
+    REQUIRE(blocker.has_value());
+    REQUIRE(pending.has_value());
+
+    pool.Stop();
+    REQUIRE(!pool.Enqueue([] { return 2; }).has_value());
+
+    release.set_value();
+    pool.StopAndWait();
+
+    /* The task that never started is dropped */
+    REQUIRE_THROWS_AS(pending->get(), std::future_error);
+}
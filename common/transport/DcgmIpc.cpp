@@ -16,7 +16,11 @@
 
 
 #include "DcgmIpc.h"
+#include "DcgmIpcCompress.h"
 #include <DcgmLogging.h>
+#include <DcgmThreadPlacement.h>
+#include <DcgmTrace.h>
+#include <algorithm>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <optional>
@@ -28,10 +32,39 @@
    to validate that we're indeed in the correct thread */
 #define ASSERT_IS_IPC_THREAD assert(pthread_equal(pthread_self(), m_ipcThreadId))
 
+/*****************************************************************************/
+static unsigned int GetMaxQueuedMessages()
+{
+    const char *envStr = getenv("__DCGM_IPC_MAX_QUEUED_MESSAGES__");
+    if (envStr != nullptr && atoi(envStr) > 0)
+    {
+        return (unsigned int)atoi(envStr);
+    }
+    return DcgmIpcScheduler::DEFAULT_MAX_QUEUED;
+}
+
+/*****************************************************************************/
+static bool GetConnectionAffinity()
+{
+    const char *envStr = getenv("__DCGM_IPC_CONNECTION_AFFINITY__");
+    return envStr != nullptr && envStr[0] == '1';
+}
+
 /*****************************************************************************/
 DcgmIpc::DcgmIpc(int numWorkerThreads)
     : DcgmThread("dcgm_ipc")
-    , m_workersPool(numWorkerThreads)
+    , m_scheduler(
+          GetMaxQueuedMessages(),
+          [this](dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> dcgmMessage) {
+              DcgmNs::Trace::Scope traceScope("IpcDispatch", "connectionId", connectionId);
+              m_processMessageFunc(connectionId, std::move(dcgmMessage), m_processMessageData);
+          },
+          [this](dcgm_connection_id_t connectionId) { m_processDisconnectFunc(connectionId, m_processDisconnectData); },
+          [this](dcgm_connection_id_t connectionId) { OnSchedulerResume(connectionId); },
+          GetConnectionAffinity())
+    , m_workersPool(numWorkerThreads, "dcgm_ipc_worker", []() {
+        DcgmNs::ThreadPlacement::ApplyToCurrentThread("dcgm_ipc_worker");
+    })
 {
     m_tcpParameters         = std::nullopt;
     m_domainParameters      = std::nullopt;
@@ -41,9 +74,18 @@ DcgmIpc::DcgmIpc(int numWorkerThreads)
     m_eventBase             = nullptr;
     m_dnsBase               = nullptr;
     m_processDisconnectData = nullptr;
+    m_processCancelData     = nullptr;
     m_tcpListenEvent        = nullptr;
     m_domainListenEvent     = nullptr;
     m_processMessageData    = nullptr;
+    m_shmRingBytes          = 0;
+
+    const char *shmRingEnvStr = getenv("__DCGM_IPC_SHM_RING__");
+    if (shmRingEnvStr && shmRingEnvStr[0] == '1')
+    {
+        m_shmRingBytes = DCGM_IPC_SHM_RING_BYTES;
+    }
+    DCGM_LOG_DEBUG << "Set m_shmRingBytes to " << m_shmRingBytes;
 }
 
 /*****************************************************************************/
@@ -73,7 +115,9 @@ dcgmReturn_t DcgmIpc::Init(std::optional<DcgmIpcTcpServerParams_t> tcpParameters
                            DcgmIpcProcessMessageFunc_f processMessageFunc,
                            void *processMessageData,
                            DcgmIpcProcessDisconnectFunc_f processDisconnectFunc,
-                           void *processDisconnectData)
+                           void *processDisconnectData,
+                           DcgmIpcProcessCancelFunc_f processCancelFunc,
+                           void *processCancelData)
 {
     (void)evthread_use_pthreads();
 
@@ -113,6 +157,9 @@ dcgmReturn_t DcgmIpc::Init(std::optional<DcgmIpcTcpServerParams_t> tcpParameters
     m_processDisconnectFunc = processDisconnectFunc;
     m_processDisconnectData = processDisconnectData;
 
+    m_processCancelFunc = processCancelFunc;
+    m_processCancelData = processCancelData;
+
     m_initPromise = {};
 
     auto initFuture = m_initPromise.get_future();
@@ -155,6 +202,11 @@ DcgmIpc::~DcgmIpc()
         DCGM_LOG_ERROR << "StopAndWait() threw unknown exception";
     }
 
+    auto poolStats = DcgmMessagePool::GetInstance().GetStats();
+    DCGM_LOG_DEBUG << "Message pool served " << poolStats.hits << "/" << poolStats.gets << " gets, discarded "
+                   << poolStats.discards << "/" << poolStats.puts << " puts and holds " << poolStats.retainedMessages
+                   << " messages of " << poolStats.retainedBytes << " bytes";
+
     if (m_tcpListenEvent != nullptr)
     {
         event_free(m_tcpListenEvent);
@@ -273,19 +325,11 @@ static int SetNonBlocking(int fd)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmIpc::InitTCPListenerSocket()
+dcgmReturn_t DcgmIpc::CreateTCPListenerSocket()
 {
     struct sockaddr_in listenAddr;
     int reuseAddrOn;
 
-    ASSERT_IS_IPC_THREAD;
-
-    if (!m_tcpParameters.has_value())
-    {
-        DCGM_LOG_DEBUG << "m_tcpParameters was not set.";
-        return DCGM_ST_OK;
-    }
-
     /* Create our listening socket. */
     m_tcpListenSocketFd = socket(AF_INET, SOCK_STREAM, 0);
     if (m_tcpListenSocketFd < 0)
@@ -338,6 +382,33 @@ dcgmReturn_t DcgmIpc::InitTCPListenerSocket()
         return DCGM_ST_IN_USE;
     }
 
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpc::InitTCPListenerSocket()
+{
+    ASSERT_IS_IPC_THREAD;
+
+    if (!m_tcpParameters.has_value())
+    {
+        DCGM_LOG_DEBUG << "m_tcpParameters was not set.";
+        return DCGM_ST_OK;
+    }
+
+    if (m_tcpParameters.value().listenFd >= 0)
+    {
+        m_tcpListenSocketFd = m_tcpParameters.value().listenFd;
+    }
+    else
+    {
+        dcgmReturn_t dcgmReturn = CreateTCPListenerSocket();
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+    }
+
     if (SetNonBlocking(m_tcpListenSocketFd))
     {
         DCGM_LOG_ERROR << "SetNonBlocking failed";
@@ -367,19 +438,11 @@ dcgmReturn_t DcgmIpc::InitTCPListenerSocket()
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmIpc::InitUnixListenerSocket()
+dcgmReturn_t DcgmIpc::CreateUnixListenerSocket()
 {
     struct sockaddr_un listenAddr;
     int reuseAddrOn;
 
-    ASSERT_IS_IPC_THREAD;
-
-    if (!m_domainParameters.has_value())
-    {
-        DCGM_LOG_DEBUG << "m_domainParameters was not set.";
-        return DCGM_ST_OK;
-    }
-
     /* Create our listening socket. */
     m_domainListenSocketFd = socket(AF_UNIX, SOCK_STREAM, 0);
     if (m_domainListenSocketFd < 0)
@@ -419,6 +482,33 @@ dcgmReturn_t DcgmIpc::InitUnixListenerSocket()
         return DCGM_ST_IN_USE;
     }
 
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpc::InitUnixListenerSocket()
+{
+    ASSERT_IS_IPC_THREAD;
+
+    if (!m_domainParameters.has_value())
+    {
+        DCGM_LOG_DEBUG << "m_domainParameters was not set.";
+        return DCGM_ST_OK;
+    }
+
+    if (m_domainParameters.value().listenFd >= 0)
+    {
+        m_domainListenSocketFd = m_domainParameters.value().listenFd;
+    }
+    else
+    {
+        dcgmReturn_t dcgmReturn = CreateUnixListenerSocket();
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+    }
+
     if (SetNonBlocking(m_domainListenSocketFd))
     {
         DCGM_LOG_ERROR << "SetNonBlocking failed";
@@ -539,12 +629,11 @@ dcgmReturn_t DcgmIpc::RemoveConnectionByBev(struct bufferevent *bev)
     m_connections.erase(connectionIt);
 
     /* Notify our parent that we got a disconnect */
-    DcgmIpcProcessDisconnect_t pd {};
-    pd.connectionId      = connectionId;
-    pd.processDisconnect = m_processDisconnectFunc;
-    pd.userData          = m_processDisconnectData;
-
-    m_workersPool.Enqueue([pd]() mutable { DcgmIpc::ProcessDisconnectInPool(pd); });
+    /* Replaces any messages from this connection that haven't been processed yet */
+    m_scheduler.PushDisconnect(connectionId);
+    EnqueueSchedulerTask(connectionId);
+    /* The disconnect can be queued behind a request that is still running on its worker */
+    CancelRequest(connectionId, DCGM_REQUEST_ID_NONE);
     return DCGM_ST_OK;
 }
 
@@ -575,6 +664,11 @@ void DcgmIpc::ConnectTcpAsyncImpl(DcgmIpcConnectTcp &tcpConnect)
         return;
     }
 
+    if (tcpConnect.m_compressMinBytes > 0)
+    {
+        ConnectionIdToPtr(tcpConnect.m_connectionId)->SetCompressRequestMinBytes(tcpConnect.m_compressMinBytes);
+    }
+
     /* Track our event before callbacks could be invoked */
     bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
     bufferevent_enable(bev, EV_READ | EV_WRITE);
@@ -606,13 +700,14 @@ void DcgmIpc::ConnectTcpAsyncImplCB(evutil_socket_t, short, void *data)
 dcgmReturn_t DcgmIpc::ConnectTcp(std::string hostname,
                                  int port,
                                  dcgm_connection_id_t &connectionId,
-                                 unsigned int timeoutMs)
+                                 unsigned int timeoutMs,
+                                 unsigned int compressMinBytes)
 {
     connectionId = GetNextConnectionId();
 
     /* Using new here because we're transferring it through a C callback. The callback will
        assign this to a unique_ptr and then free it automatically */
-    DcgmIpcConnectTcp *connectTcp = new DcgmIpcConnectTcp(this, hostname, port, connectionId);
+    DcgmIpcConnectTcp *connectTcp = new DcgmIpcConnectTcp(this, hostname, port, connectionId, compressMinBytes);
 
     std::future<dcgmReturn_t> connectReturn = connectTcp->m_promise.get_future();
 
@@ -680,6 +775,12 @@ void DcgmIpc::ConnectDomainAsyncImpl(DcgmIpcConnectDomain &domainConnect)
         return;
     }
 
+    /* The host engine is on this host. Offer it a shared-memory ring once we're connected */
+    if (m_shmRingBytes > 0)
+    {
+        ConnectionIdToPtr(domainConnect.m_connectionId)->SetShmRingRequestBytes(m_shmRingBytes);
+    }
+
     /* Track our event before callbacks could be invoked */
     bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
     bufferevent_enable(bev, EV_READ | EV_WRITE);
@@ -852,6 +953,16 @@ void DcgmIpc::EventCB(struct bufferevent *bev, short events)
     {
         /* Connected */
         DCGM_LOG_DEBUG << "Got connected event for connectionId " << connectionId << " bev " << bev;
+
+        /* Before the connection is marked active so that the ring request is sent ahead of
+           any message from our caller */
+        DcgmIpcConnection *connection = ConnectionIdToPtr(connectionId);
+        if (connection != nullptr)
+        {
+            connection->RequestShmRing();
+            connection->RequestCompression();
+        }
+
         SetConnectionState(connectionId, DCGM_IPC_CS_ACTIVE);
     }
     else if ((events & BEV_EVENT_ERROR) || (events & BEV_EVENT_EOF))
@@ -892,20 +1003,6 @@ dcgmReturn_t DcgmIpc::SetConnectionState(dcgm_connection_id_t connectionId, Dcgm
     return DCGM_ST_OK;
 }
 
-/*****************************************************************************/
-void DcgmIpc::ProcessMessageInPool(DcgmIpcProcessMessage_t &processMe)
-{
-    std::unique_ptr<DcgmMessage> dcgmMessage(processMe.dcgmMessage);
-
-    processMe.processMessage(processMe.connectionId, std::move(dcgmMessage), processMe.userData);
-}
-
-/*****************************************************************************/
-void DcgmIpc::ProcessDisconnectInPool(DcgmIpcProcessDisconnect_t &processMe)
-{
-    processMe.processDisconnect(processMe.connectionId, processMe.userData);
-}
-
 /*****************************************************************************/
 DcgmIpcConnection *DcgmIpc::ConnectionIdToPtr(dcgm_connection_id_t connectionId)
 {
@@ -938,6 +1035,8 @@ void DcgmIpc::ReadCB(bufferevent *bev)
         return;
     }
 
+    DcgmNs::Trace::Scope traceScope("IpcRead", "connectionId", connectionId);
+
     std::vector<std::unique_ptr<DcgmMessage>> messages;
 
     dcgmReturn_t dcgmReturn = connection->ReadMessages(bev, messages);
@@ -955,24 +1054,119 @@ void DcgmIpc::ReadCB(bufferevent *bev)
         return;
     }
 
-    DcgmIpcProcessMessage_t processMessage {};
-
-    processMessage.connectionId   = connectionId;
-    processMessage.processMessage = m_processMessageFunc;
-    processMessage.userData       = m_processMessageData;
+    bool throttle = false;
 
     for (auto &&dcgmMessage : messages)
     {
-        processMessage.dcgmMessage = dcgmMessage.release();
+        if (dcgmMessage->GetMsgType() == DCGM_MSG_REQUEST_CANCEL)
+        {
+            CancelRequest(connectionId, dcgmMessage->GetRequestId());
+            continue;
+        }
+
+        throttle = m_scheduler.Push(connectionId, std::move(dcgmMessage)) || throttle;
 
-        auto const task
-            = m_workersPool.Enqueue([processMessage]() mutable { DcgmIpc::ProcessMessageInPool(processMessage); });
-        if (!task.has_value())
+        if (!EnqueueSchedulerTask(connectionId))
         {
-            delete processMessage.dcgmMessage; // we are responsible for this memory if the enqueue fails
             DCGM_LOG_ERROR << "Unable to enqueue message";
         }
     }
+
+    if (throttle)
+    {
+        /* This connection is sending faster than we process. Let the socket buffer fill up so the
+           sender blocks, rather than queueing without bound. ResumeReading() undoes this */
+        DCGM_LOG_DEBUG << "Pausing reads from connectionId " << connectionId;
+        bufferevent_disable(bev, EV_READ);
+    }
+}
+
+/*****************************************************************************/
+bool DcgmIpc::EnqueueSchedulerTask(dcgm_connection_id_t connectionId)
+{
+    if (m_scheduler.IsPerConnection())
+    {
+        return m_workersPool.Enqueue(connectionId, [this, connectionId]() { m_scheduler.RunNext(connectionId); })
+            .has_value();
+    }
+
+    return m_workersPool.Enqueue([this]() { m_scheduler.RunNext(); }).has_value();
+}
+
+/*****************************************************************************/
+void DcgmIpc::CancelRequest(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId)
+{
+    if (requestId != DCGM_REQUEST_ID_NONE && m_scheduler.Cancel(connectionId, requestId))
+    {
+        DCGM_LOG_DEBUG << "Dropped queued requestId " << requestId << " of connectionId " << connectionId;
+        return;
+    }
+
+    if (!m_processCancelFunc)
+    {
+        return;
+    }
+
+    /* Not pinned to the connection's worker, which may be busy with the very request to stop */
+    auto task = m_workersPool.Enqueue([this, connectionId, requestId]() {
+        m_processCancelFunc(connectionId, requestId, m_processCancelData);
+    });
+    if (!task.has_value())
+    {
+        /* The worker pool is stopped while shutting down */
+        DCGM_LOG_DEBUG << "Unable to enqueue the cancel of requestId " << requestId << " of connectionId "
+                       << connectionId;
+    }
+}
+
+/*****************************************************************************/
+void DcgmIpc::OnSchedulerResume(dcgm_connection_id_t connectionId)
+{
+    /* Using new here because we're transferring it through a C callback */
+    DcgmIpcResumeReading *resumeReading = new DcgmIpcResumeReading { this, connectionId };
+
+    int st = event_base_once(m_eventBase, -1, EV_TIMEOUT, DcgmIpc::ResumeReadingCB, resumeReading, 0);
+    if (st)
+    {
+        DCGM_LOG_ERROR << "Got error " << st << " from event_base_once. connectionId " << connectionId
+                       << " stays paused.";
+        delete resumeReading;
+    }
+}
+
+/*****************************************************************************/
+void DcgmIpc::ResumeReadingCB(evutil_socket_t, short, void *data)
+{
+    std::unique_ptr<DcgmIpcResumeReading> resumeReading((DcgmIpcResumeReading *)data);
+
+    resumeReading->m_ipc->ResumeReading(resumeReading->m_connectionId);
+}
+
+/*****************************************************************************/
+void DcgmIpc::ResumeReading(dcgm_connection_id_t connectionId)
+{
+    ASSERT_IS_IPC_THREAD;
+
+    DcgmIpcConnection *connection = ConnectionIdToPtr(connectionId);
+    if (connection == nullptr)
+    {
+        return; /* It went away while paused */
+    }
+
+    DCGM_LOG_DEBUG << "Resuming reads from connectionId " << connectionId;
+
+    struct bufferevent *bev = connection->GetBev();
+    bufferevent_enable(bev, EV_READ);
+
+    /* Complete messages could already be sitting in the input buffer. libevent won't call
+       ReadCB() for those until more data arrives */
+    ReadCB(bev);
+}
+
+/*****************************************************************************/
+std::vector<dcgm_ipc_queue_stats_t> DcgmIpc::GetConnectionQueueStats() const
+{
+    return m_scheduler.GetStats();
 }
 
 /*****************************************************************************/
@@ -997,6 +1191,12 @@ DcgmIpcConnection::DcgmIpcConnection(struct bufferevent *bev,
     , m_connectionState(connectionState)
     , m_shouldReadHeader(true)
     , m_readHeader({})
+    , m_shmRingProducer(false)
+    , m_allowShmRing(false)
+    , m_shmRingRequestBytes(0)
+    , m_compressRequestMinBytes(0)
+    , m_compressMinBytes(0)
+    , m_compressOffered(false)
     , m_connectPromise(std::move(connectPromise))
 {
     DCGM_LOG_DEBUG << "DcgmIpcConnection constructor for bev " << m_bev;
@@ -1040,29 +1240,15 @@ void DcgmIpcConnection::SetConnectionState(DcgmIpcConnectionState_t state)
 }
 
 /*****************************************************************************/
-std::unique_ptr<DcgmMessage> DcgmIpcConnection::GetDcgmMessage(void)
+std::unique_ptr<DcgmMessage> DcgmIpcConnection::GetDcgmMessage(std::size_t minCapacity)
 {
-    if (m_reuseMessages.size() > 0)
-    {
-        std::unique_ptr<DcgmMessage> retVal = std::move(m_reuseMessages.top());
-        m_reuseMessages.pop();
-        return retVal;
-    }
-    else
-    {
-        return std::make_unique<DcgmMessage>();
-    }
+    return DcgmMessagePool::GetInstance().Get(minCapacity);
 }
 
 /*****************************************************************************/
 void DcgmIpcConnection::CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg)
 {
-    if (m_reuseMessages.size() < MAX_REUSE_MESSAGES_COUNT)
-    {
-        m_reuseMessages.emplace(std::move(msg));
-    }
-
-    /* Otherwise the message goes out of scope and is freed */
+    DcgmMessagePool::GetInstance().Put(std::move(msg));
 }
 
 /*****************************************************************************/
@@ -1128,7 +1314,7 @@ dcgmReturn_t DcgmIpcConnection::ReadMessages(struct bufferevent *bev,
         }
 
         /* Allocate a new DCGM Message */
-        std::unique_ptr<DcgmMessage> dcgmMessage = GetDcgmMessage();
+        std::unique_ptr<DcgmMessage> dcgmMessage = GetDcgmMessage(m_readHeader.length);
         *(dcgmMessage->GetMessageHdr())          = m_readHeader;
 
         auto msgBytes = dcgmMessage->GetMsgBytesPtr();
@@ -1150,13 +1336,355 @@ dcgmReturn_t DcgmIpcConnection::ReadMessages(struct bufferevent *bev,
         /* We read an entire message. We should read a header next */
         m_shouldReadHeader = true;
 
-        messages.push_back(std::move(dcgmMessage));
+        if (m_readHeader.msgType == DCGM_MSG_SHM_ATTACH || m_readHeader.msgType == DCGM_MSG_SHM_PAYLOAD)
+        {
+            dcgmReturn_t dcgmReturn = ProcessShmMessage(dcgmMessage);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                return dcgmReturn;
+            }
+        }
+        else if (m_readHeader.msgType == DCGM_MSG_COMPRESS_NEGOTIATE || m_readHeader.msgType == DCGM_MSG_COMPRESSED)
+        {
+            dcgmReturn_t dcgmReturn = ProcessCompressMessage(dcgmMessage);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                return dcgmReturn;
+            }
+        }
+
+        if (dcgmMessage != nullptr)
+        {
+            messages.push_back(std::move(dcgmMessage));
+        }
         retSt = DCGM_ST_OK; /* We read at least one complete message */
     }
 
     return retSt;
 }
 
+/*****************************************************************************/
+void DcgmIpcConnection::AllowShmRing()
+{
+    m_allowShmRing = true;
+}
+
+/*****************************************************************************/
+void DcgmIpcConnection::SetShmRingRequestBytes(std::size_t capacity)
+{
+    m_shmRingRequestBytes = capacity;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcConnection::RequestShmRing()
+{
+    if (m_shmRingRequestBytes == 0 || m_shmRing != nullptr)
+    {
+        return DCGM_ST_OK;
+    }
+
+    m_shmRing = DcgmIpcShmRing::Create(m_shmRingRequestBytes);
+    if (m_shmRing == nullptr)
+    {
+        DCGM_LOG_WARNING << "Unable to create a shm ring for bev " << m_bev << ". Using the socket only.";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+    m_shmRingProducer = false;
+
+    dcgm_msg_shm_attach_t attach {};
+    snprintf(attach.name, sizeof(attach.name), "%s", m_shmRing->GetName().c_str());
+    attach.capacity = m_shmRing->GetCapacity();
+
+    std::unique_ptr<DcgmMessage> dcgmMessage = GetDcgmMessage(sizeof(attach));
+    dcgmMessage->UpdateMsgHdr(DCGM_MSG_SHM_ATTACH, DCGM_REQUEST_ID_NONE, DCGM_ST_OK, sizeof(attach));
+    dcgmMessage->GetMsgBytesPtr()->assign((char *)&attach, (char *)&attach + sizeof(attach));
+
+    return SendMessage(std::move(dcgmMessage));
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcConnection::AttachShmRing(std::unique_ptr<DcgmMessage> request)
+{
+    dcgmReturn_t status = DCGM_ST_NOT_SUPPORTED;
+    auto msgBytes       = request->GetMsgBytesPtr();
+    struct ucred peerCred {};
+    socklen_t peerCredLen = sizeof(peerCred);
+
+    if (m_shmRing != nullptr)
+    {
+        DCGM_LOG_ERROR << "Ignoring a second shm ring request for bev " << m_bev;
+    }
+    else if (msgBytes->size() != sizeof(dcgm_msg_shm_attach_t))
+    {
+        DCGM_LOG_ERROR << "Got shm ring request of " << msgBytes->size() << " bytes for bev " << m_bev;
+        status = DCGM_ST_BADPARAM;
+    }
+    else if (getsockopt(bufferevent_getfd(m_bev), SOL_SOCKET, SO_PEERCRED, &peerCred, &peerCredLen) != 0)
+    {
+        DCGM_LOG_ERROR << "Unable to get the peer of bev " << m_bev << ". errno " << errno;
+    }
+    else
+    {
+        dcgm_msg_shm_attach_t attach {};
+        memcpy(&attach, msgBytes->data(), sizeof(attach));
+        attach.name[sizeof(attach.name) - 1] = '\0';
+
+        if (attach.capacity > SHM_MAX_RING_BYTES)
+        {
+            DCGM_LOG_ERROR << "Refusing shm ring of " << attach.capacity << " bytes for bev " << m_bev;
+            status = DCGM_ST_BADPARAM;
+        }
+        else
+        {
+            m_shmRing = DcgmIpcShmRing::Attach(attach.name, attach.capacity, peerCred.uid);
+            if (m_shmRing != nullptr)
+            {
+                m_shmRingProducer = true;
+                status            = DCGM_ST_OK;
+            }
+        }
+    }
+
+    DCGM_LOG_DEBUG << "shm ring request for bev " << m_bev << " returned " << errorString(status);
+
+    /* Reply with the outcome. The client falls back to the socket if this isn't DCGM_ST_OK */
+    request->UpdateMsgHdr(DCGM_MSG_SHM_ATTACH, request->GetRequestId(), status, 0);
+    msgBytes->clear();
+    return SendMessage(std::move(request));
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcConnection::ProcessShmMessage(std::unique_ptr<DcgmMessage> &dcgmMessage)
+{
+    auto msgHdr = dcgmMessage->GetMessageHdr();
+
+    if (msgHdr->msgType == DCGM_MSG_SHM_ATTACH)
+    {
+        if (m_allowShmRing)
+        {
+            /* We're the host engine. The client is offering us a ring */
+            return AttachShmRing(std::move(dcgmMessage));
+        }
+
+        /* We're the client. This is the host engine's reply to our offer */
+        if (msgHdr->status != DCGM_ST_OK && m_shmRing != nullptr)
+        {
+            DCGM_LOG_DEBUG << "Host engine declined shm ring " << m_shmRing->GetName() << ": "
+                           << errorString((dcgmReturn_t)msgHdr->status);
+            m_shmRing.reset();
+        }
+        else if (m_shmRing != nullptr)
+        {
+            m_shmRing->Unlink();
+        }
+
+        CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+        dcgmMessage = nullptr;
+        return DCGM_ST_OK;
+    }
+
+    /* DCGM_MSG_SHM_PAYLOAD */
+    auto msgBytes = dcgmMessage->GetMsgBytesPtr();
+
+    if (m_shmRing == nullptr || m_shmRingProducer || msgBytes->size() != sizeof(dcgm_msg_shm_payload_t))
+    {
+        DCGM_LOG_ERROR << "Got unexpected shm ring payload message for bev " << m_bev;
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    dcgm_msg_shm_payload_t payload {};
+    memcpy(&payload, msgBytes->data(), sizeof(payload));
+
+    if (payload.length < 0 || payload.length > DCGM_PROTO_MAX_MESSAGE_SIZE)
+    {
+        DCGM_LOG_ERROR << "Got bad shm ring payload size " << payload.length << ". Closing connection.";
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    dcgmReturn_t dcgmReturn = m_shmRing->Read(payload.offset, payload.length, *msgBytes);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    msgHdr->msgType = payload.msgType;
+    msgHdr->length  = payload.length;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmIpcConnection::SetCompressRequestMinBytes(unsigned int minBytes)
+{
+    m_compressRequestMinBytes = minBytes;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcConnection::RequestCompression()
+{
+    if (m_compressRequestMinBytes == 0 || m_compressOffered)
+    {
+        return DCGM_ST_OK;
+    }
+
+    dcgm_msg_compress_negotiate_t negotiate {};
+    negotiate.algorithm = DCGM_MSG_COMPRESS_ALGO_LZ4_BLOCK;
+    negotiate.minBytes  = std::max(m_compressRequestMinBytes, COMPRESS_MIN_BYTES_FLOOR);
+
+    m_compressOffered = true;
+
+    std::unique_ptr<DcgmMessage> dcgmMessage = GetDcgmMessage(sizeof(negotiate));
+    dcgmMessage->UpdateMsgHdr(DCGM_MSG_COMPRESS_NEGOTIATE, DCGM_REQUEST_ID_NONE, DCGM_ST_OK, sizeof(negotiate));
+    dcgmMessage->GetMsgBytesPtr()->assign((char *)&negotiate, (char *)&negotiate + sizeof(negotiate));
+
+    return SendMessage(std::move(dcgmMessage));
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcConnection::ProcessCompressMessage(std::unique_ptr<DcgmMessage> &dcgmMessage)
+{
+    auto msgHdr   = dcgmMessage->GetMessageHdr();
+    auto msgBytes = dcgmMessage->GetMsgBytesPtr();
+
+    if (msgHdr->msgType == DCGM_MSG_COMPRESS_NEGOTIATE)
+    {
+        dcgm_msg_compress_negotiate_t negotiate {};
+        if (msgBytes->size() == sizeof(negotiate))
+        {
+            memcpy(&negotiate, msgBytes->data(), sizeof(negotiate));
+        }
+
+        if (m_compressOffered)
+        {
+            /* We're the client. This is the host engine's reply to our offer */
+            if (msgHdr->status == DCGM_ST_OK && negotiate.algorithm == DCGM_MSG_COMPRESS_ALGO_LZ4_BLOCK)
+            {
+                m_compressMinBytes = std::max(negotiate.minBytes, COMPRESS_MIN_BYTES_FLOOR);
+            }
+            DCGM_LOG_DEBUG << "Compression offer for bev " << m_bev << " returned "
+                           << errorString((dcgmReturn_t)msgHdr->status) << ". m_compressMinBytes "
+                           << m_compressMinBytes;
+
+            CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+            dcgmMessage = nullptr;
+            return DCGM_ST_OK;
+        }
+
+        /* We're the host engine. The client is offering to compress */
+        dcgmReturn_t status = DCGM_ST_NOT_SUPPORTED;
+        if (msgBytes->size() != sizeof(negotiate))
+        {
+            DCGM_LOG_ERROR << "Got compression offer of " << msgBytes->size() << " bytes for bev " << m_bev;
+            status = DCGM_ST_BADPARAM;
+        }
+        else if (negotiate.algorithm == DCGM_MSG_COMPRESS_ALGO_LZ4_BLOCK)
+        {
+            negotiate.minBytes = std::max(negotiate.minBytes, COMPRESS_MIN_BYTES_FLOOR);
+            m_compressMinBytes = negotiate.minBytes;
+            status             = DCGM_ST_OK;
+        }
+
+        DCGM_LOG_DEBUG << "Compression offer of algorithm " << negotiate.algorithm << " for bev " << m_bev
+                       << " returned " << errorString(status);
+
+        /* Reply with the outcome. It's far below any threshold, so it goes out uncompressed */
+        dcgmMessage->UpdateMsgHdr(DCGM_MSG_COMPRESS_NEGOTIATE, msgHdr->requestId, status, sizeof(negotiate));
+        msgBytes->assign((char *)&negotiate, (char *)&negotiate + sizeof(negotiate));
+        return SendMessage(std::move(dcgmMessage));
+    }
+
+    /* DCGM_MSG_COMPRESSED */
+    dcgm_msg_compressed_t compressed {};
+
+    if ((!m_compressOffered && m_compressMinBytes == 0) || msgBytes->size() < sizeof(compressed))
+    {
+        DCGM_LOG_ERROR << "Got unexpected compressed message for bev " << m_bev;
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    memcpy(&compressed, msgBytes->data(), sizeof(compressed));
+
+    if (compressed.algorithm != DCGM_MSG_COMPRESS_ALGO_LZ4_BLOCK || compressed.length < 0
+        || compressed.length > DCGM_PROTO_MAX_MESSAGE_SIZE)
+    {
+        DCGM_LOG_ERROR << "Got bad compressed message of algorithm " << compressed.algorithm << ", length "
+                       << compressed.length << ". Closing connection.";
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    std::unique_ptr<DcgmMessage> decompressed = GetDcgmMessage(compressed.length);
+    dcgmReturn_t dcgmReturn = DcgmIpcCompress::Decompress(msgBytes->data() + sizeof(compressed),
+                                                          msgBytes->size() - sizeof(compressed),
+                                                          compressed.length,
+                                                          *decompressed->GetMsgBytesPtr());
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Unable to decompress message of length " << compressed.length << ". Closing connection.";
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    auto decompressedHdr     = decompressed->GetMessageHdr();
+    *decompressedHdr         = *msgHdr;
+    decompressedHdr->msgType = compressed.msgType;
+    decompressedHdr->length  = compressed.length;
+
+    CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+    dcgmMessage = std::move(decompressed);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+bool DcgmIpcConnection::SendCompressedMessage(DcgmMessage &dcgmMessage, dcgmReturn_t &dcgmReturn)
+{
+    auto msgHdr   = dcgmMessage.GetMessageHdr();
+    auto msgBytes = dcgmMessage.GetMsgBytesPtr();
+
+    char const *src    = msgBytes->data();
+    std::size_t srcLen = msgBytes->size();
+    std::vector<char> gathered;
+
+    /* The compressor wants contiguous input. Copying here is cheap next to the compression itself */
+    if (!dcgmMessage.GetExternalSegments().empty())
+    {
+        gathered.reserve(dcgmMessage.GetLength());
+        gathered.insert(gathered.end(), msgBytes->begin(), msgBytes->end());
+        for (auto const &segment : dcgmMessage.GetExternalSegments())
+        {
+            gathered.insert(gathered.end(), (char const *)segment.data, (char const *)segment.data + segment.length);
+        }
+        src    = gathered.data();
+        srcLen = gathered.size();
+    }
+
+    dcgm_msg_compressed_t compressed {};
+    compressed.msgType   = msgHdr->msgType;
+    compressed.length    = (int)srcLen;
+    compressed.algorithm = DCGM_MSG_COMPRESS_ALGO_LZ4_BLOCK;
+
+    std::vector<char> compressedBytes;
+    if (!DcgmIpcCompress::Compress(src, srcLen, compressedBytes)
+        || compressedBytes.size() + sizeof(compressed) >= srcLen)
+    {
+        return false;
+    }
+
+    dcgm_message_header_t compressedHdr = *msgHdr;
+    compressedHdr.msgType               = DCGM_MSG_COMPRESSED;
+    compressedHdr.length                = sizeof(compressed) + compressedBytes.size();
+
+    int st  = bufferevent_write(m_bev, &compressedHdr, sizeof(compressedHdr));
+    int st2 = bufferevent_write(m_bev, &compressed, sizeof(compressed));
+    int st3 = bufferevent_write(m_bev, compressedBytes.data(), compressedBytes.size());
+    if (st || st2 || st3)
+    {
+        DCGM_LOG_ERROR << "Got error from compressed message writes " << st << ", " << st2 << ", " << st3;
+        dcgmReturn = DCGM_ST_CONNECTION_NOT_VALID;
+        return true;
+    }
+
+    dcgmReturn = DCGM_ST_OK;
+    return true;
+}
+
 /*****************************************************************************/
 void DcgmIpc::OnAccept(int listenerFd)
 {
@@ -1200,6 +1728,12 @@ void DcgmIpc::OnAccept(int listenerFd)
         return;
     }
 
+    /* Only clients on this host can share memory with us */
+    if (listenerFd == m_domainListenSocketFd)
+    {
+        ConnectionIdToPtr(connectionId)->AllowShmRing();
+    }
+
     /* Track our event before callbacks could be invoked */
     bufferevent_setcb(bev, DcgmIpc::StaticReadCB, NULL, DcgmIpc::StaticEventCB, this);
     bufferevent_enable(bev, EV_READ | EV_WRITE);
@@ -1285,24 +1819,129 @@ dcgmReturn_t DcgmIpcConnection::SendMessage(std::unique_ptr<DcgmMessage> dcgmMes
     auto msgHdr   = dcgmMessage->GetMessageHdr();
     auto msgBytes = dcgmMessage->GetMsgBytesPtr();
 
+    void const *body    = msgBytes->data();
+    std::size_t bodyLen = msgBytes->size();
+    dcgm_message_header_t shmHdr {};
+    dcgm_msg_shm_payload_t shmPayload {};
+    bool hasExternalSegments = !dcgmMessage->GetExternalSegments().empty();
+
+    if (hasExternalSegments && msgHdr->length != (int)dcgmMessage->GetLength())
+    {
+        DCGM_LOG_ERROR << "Header length " << msgHdr->length << " != message length " << dcgmMessage->GetLength();
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Bodies over the negotiated threshold are compressed. Shared-memory rings are only set up on
+       domain sockets and compression on TCP connections, so at most one of these applies */
+    if (m_compressMinBytes > 0 && dcgmMessage->GetLength() >= m_compressMinBytes)
+    {
+        dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+        if (SendCompressedMessage(*dcgmMessage, dcgmReturn))
+        {
+            if (dcgmReturn == DCGM_ST_OK)
+            {
+                CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+            }
+            return dcgmReturn;
+        }
+        /* Otherwise it didn't compress. Send it as is */
+    }
+
+    /* Large bodies go through the shared-memory ring if the client gave us one. Only a
+       small stand-in message goes over the socket, which also keeps messages in order.
+       The ring wants a contiguous body, so scattered messages always use the socket */
+    if (m_shmRing != nullptr && m_shmRingProducer && !hasExternalSegments && bodyLen >= SHM_MIN_PAYLOAD_BYTES)
+    {
+        std::uint64_t offset = 0;
+        if (m_shmRing->Write(body, bodyLen, offset))
+        {
+            shmPayload.msgType = msgHdr->msgType;
+            shmPayload.length  = (int)bodyLen;
+            shmPayload.offset  = offset;
+
+            shmHdr         = *msgHdr;
+            shmHdr.msgType = DCGM_MSG_SHM_PAYLOAD;
+            shmHdr.length  = sizeof(shmPayload);
+
+            msgHdr  = &shmHdr;
+            body    = &shmPayload;
+            bodyLen = sizeof(shmPayload);
+        }
+        /* Otherwise the ring is full. Send this one over the socket */
+    }
 
     /* Note that we're only able to do these calls in succession because
        we only write to connections from a single thread. Otherwise, we'd have
        to stage the entire message in an evbuffer and call bufferevent_write_buffer */
-    int st  = bufferevent_write(m_bev, msgHdr, sizeof(*msgHdr));
-    int st2 = bufferevent_write(m_bev, msgBytes->data(), msgBytes->size());
-    if (st || st2)
+    int st = bufferevent_write(m_bev, msgHdr, sizeof(*msgHdr));
+    if (st)
     {
-        DCGM_LOG_ERROR << "Got error from first or second write " << st << ", " << st2;
+        DCGM_LOG_ERROR << "Got error " << st << " from header write";
         return DCGM_ST_CONNECTION_NOT_VALID;
     }
 
-    /* Possibly save the message object for reuse */
-    CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+    if (!hasExternalSegments && (body != msgBytes->data() || bodyLen < ZERO_COPY_MIN_BODY_BYTES))
+    {
+        st = bufferevent_write(m_bev, body, bodyLen);
+        if (st)
+        {
+            DCGM_LOG_ERROR << "Got error " << st << " from body write";
+            return DCGM_ST_CONNECTION_NOT_VALID;
+        }
+
+        /* Possibly save the message object for reuse */
+        CacheOrFreeDcgmMessage(std::move(dcgmMessage));
+        return DCGM_ST_OK;
+    }
+
+    /* Hand the message's own bytes and its external segments to libevent by reference. The message
+       now lives until the last of its bytes has been written to the socket. The header was copied
+       above so it doesn't matter that msgHdr goes away with the message */
+    std::shared_ptr<DcgmMessage const> sharedMessage(std::move(dcgmMessage));
+
+    dcgmReturn_t dcgmReturn = WriteReference(body, bodyLen, sharedMessage);
+    for (auto const &segment : sharedMessage->GetExternalSegments())
+    {
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            break;
+        }
+        dcgmReturn = WriteReference(segment.data, segment.length, segment.owner);
+    }
+
+    return dcgmReturn;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcConnection::WriteReference(void const *data,
+                                               std::size_t length,
+                                               std::shared_ptr<void const> const &owner)
+{
+    if (length == 0)
+    {
+        return DCGM_ST_OK;
+    }
+
+    auto *ownerRef = new std::shared_ptr<void const>(owner);
+
+    /* libevent doesn't call ReleaseReferenceCB if this fails */
+    int st = evbuffer_add_reference(bufferevent_get_output(m_bev), data, length, ReleaseReferenceCB, ownerRef);
+    if (st)
+    {
+        delete ownerRef;
+        DCGM_LOG_ERROR << "Got error " << st << " from evbuffer_add_reference of " << length << " bytes";
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
 
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmIpcConnection::ReleaseReferenceCB(void const * /* data */, size_t /* length */, void *extra)
+{
+    delete static_cast<std::shared_ptr<void const> *>(extra);
+}
+
 /*****************************************************************************/
 void DcgmIpc::CloseConnectionImpl(DcgmIpcCloseConnection &closeConnection)
 {
@@ -15,9 +15,12 @@
  */
 #pragma once
 
+#include "DcgmIpcScheduler.h"
+#include "DcgmIpcShmRing.h"
+#include "DcgmMessagePool.h"
 #include "DcgmProtocol.h"
 #include <DcgmThread.h>
-#include <ThreadPool.hpp>
+#include <WorkStealingThreadPool.hpp>
 #include <atomic>
 #include <dcgm_structs.h>
 #include <dcgm_structs_internal.h>
@@ -29,7 +32,6 @@
 #include <functional>
 #include <future>
 #include <optional>
-#include <stack>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -37,11 +39,15 @@ typedef struct
 {
     std::string bindIPAddress; /* IPv4/IPv6 address of the NIC to bind to. "" = all NICs */
     int port;                  /* TCP port to bind to */
+    int listenFd = -1;         /* Socket that is already bound and listening, like one passed by systemd socket
+                                  activation. bindIPAddress and port are ignored if set. -1 = create one */
 } DcgmIpcTcpServerParams_t;
 
 typedef struct
 {
     std::string domainSocketPath; /* Path to the domain socket file to listen on */
+    int listenFd = -1;            /* Socket that is already bound and listening, like one passed by systemd socket
+                                     activation. domainSocketPath is ignored if set. -1 = create one */
 } DcgmIpcDomainServerParams_t;
 
 typedef enum
@@ -71,6 +77,11 @@ typedef std::function<void(dcgm_connection_id_t, std::unique_ptr<DcgmMessage>, v
    This will be invoked on a separate worker pool */
 typedef std::function<void(dcgm_connection_id_t, void *userData)> DcgmIpcProcessDisconnectFunc_f;
 
+/* Callback function to pass to DcgmIpc::Init that will stop a request its client no longer waits for.
+   requestId is DCGM_REQUEST_ID_NONE for every request of a connection that was lost.
+   This will be invoked on a separate worker pool, possibly while the request is still being processed */
+typedef std::function<void(dcgm_connection_id_t, dcgm_request_id_t, void *userData)> DcgmIpcProcessCancelFunc_f;
+
 class DcgmIpcConnection
 {
 private:
@@ -79,15 +90,48 @@ private:
     bool m_shouldReadHeader;            /* Should we read the message header next (true) or the message body (false) */
     dcgm_message_header_t m_readHeader; /* Header of the message we are currently reading. This gets updated
                                            by ReadMessages */
-    std::stack<std::unique_ptr<DcgmMessage>> m_reuseMessages; /* Reuse messages rather than allocating and freeing them.
-                                                                 Capacity is controlled with MAX_REUSE_MESSAGES_COUNT */
+    std::unique_ptr<DcgmIpcShmRing> m_shmRing; /* Ring that carries large message bodies from the host engine.
+                                                  nullptr if none was negotiated for this connection */
+    bool m_shmRingProducer;                    /* Do we write to m_shmRing (host engine) or read from it (client)? */
+    bool m_allowShmRing;                       /* Can the peer ask us to attach to its ring? Only set for connections
+                                                  accepted on the domain socket */
+    std::size_t m_shmRingRequestBytes;         /* Size of the ring to ask for once connected. 0 = don't */
+    unsigned int m_compressRequestMinBytes;    /* Threshold to offer to compress at once connected. 0 = don't */
+    unsigned int m_compressMinBytes;           /* Compress bodies at least this big when sending.
+                                                  0 = compression wasn't negotiated for this connection */
+    bool m_compressOffered;                    /* Did we offer compression? Only then can we get compressed messages
+                                                  before we've accepted an offer */
+
+    static const size_t SHM_MIN_PAYLOAD_BYTES = 4096; /* Bodies smaller than this are cheaper to send over the socket */
+    static const size_t SHM_MAX_RING_BYTES
+        = 256 * 1024 * 1024; /* Largest ring a peer can ask us to attach to. Limits what a client can make us map */
+    static const size_t ZERO_COPY_MIN_BODY_BYTES
+        = 64 * 1024; /* Bodies at least this big are referenced by the output evbuffer rather than copied into it */
+    static const unsigned int COMPRESS_MIN_BYTES_FLOOR
+        = 512; /* Smallest compression threshold we'll honor. Smaller bodies rarely shrink enough to be worth it */
+
+    /* Helpers to get/free a DcgmMessage object through the process-wide DcgmMessagePool */
+    std::unique_ptr<DcgmMessage> GetDcgmMessage(std::size_t minCapacity);
+    void CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg);
 
-    static const size_t MAX_REUSE_MESSAGES_COUNT
-        = 10; /* Maximum number of DcgmMessages we're willing to keep cached for reuse */
+    /* Append length bytes at data to the output of m_bev without copying them. A reference to owner
+       is held until libevent has written the bytes to the socket or freed the output buffer */
+    dcgmReturn_t WriteReference(void const *data, std::size_t length, std::shared_ptr<void const> const &owner);
+    static void ReleaseReferenceCB(void const *data, size_t length, void *extra);
 
-    /* Helpers to get/free a DcgmMessage object, possibly using the m_reuseMessages cache */
-    std::unique_ptr<DcgmMessage> GetDcgmMessage(void);
-    void CacheOrFreeDcgmMessage(std::unique_ptr<DcgmMessage> msg);
+    /* Handle a DCGM_MSG_SHM_ATTACH or DCGM_MSG_SHM_PAYLOAD message read from the socket.
+       A payload is replaced in place by the message it stands in for. Anything else is
+       consumed and dcgmMessage is set to nullptr */
+    dcgmReturn_t ProcessShmMessage(std::unique_ptr<DcgmMessage> &dcgmMessage);
+    dcgmReturn_t AttachShmRing(std::unique_ptr<DcgmMessage> request);
+
+    /* Handle a DCGM_MSG_COMPRESS_NEGOTIATE or DCGM_MSG_COMPRESSED message read from the socket.
+       A compressed message is replaced in place by the message it stands in for. Anything else is
+       consumed and dcgmMessage is set to nullptr */
+    dcgmReturn_t ProcessCompressMessage(std::unique_ptr<DcgmMessage> &dcgmMessage);
+
+    /* Try to send dcgmMessage compressed. Returns false without sending if it didn't shrink */
+    bool SendCompressedMessage(DcgmMessage &dcgmMessage, dcgmReturn_t &dcgmReturn);
 
 public:
     /* Promise used for async connect. Making this public for ease of use as a private class */
@@ -101,7 +145,20 @@ public:
 
     dcgmReturn_t SendMessage(std::unique_ptr<DcgmMessage> dcgmMessage);
     void SetConnectionState(DcgmIpcConnectionState_t state);
+    struct bufferevent *GetBev() const
+    {
+        return m_bev;
+    }
     dcgmReturn_t ReadMessages(struct bufferevent *bev, std::vector<std::unique_ptr<DcgmMessage>> &messages);
+
+    /* Shared-memory ring negotiation. See DcgmIpcShmRing.h */
+    void AllowShmRing();
+    void SetShmRingRequestBytes(std::size_t capacity);
+    dcgmReturn_t RequestShmRing();
+
+    /* Compression negotiation. See DCGM_MSG_COMPRESS_NEGOTIATE */
+    void SetCompressRequestMinBytes(unsigned int minBytes);
+    dcgmReturn_t RequestCompression();
 };
 
 class DcgmIpc : public DcgmThread
@@ -118,9 +175,14 @@ private:
     std::optional<DcgmIpcTcpServerParams_t> m_tcpParameters;
     std::optional<DcgmIpcDomainServerParams_t> m_domainParameters;
 
+    /* Per-connection queues of messages waiting for m_workersPool. Declared before m_workersPool so
+       that it outlives the workers that call into it. __DCGM_IPC_CONNECTION_AFFINITY__=1 makes it
+       per-connection, so each connection is served in order by one worker */
+    DcgmIpcScheduler m_scheduler;
+
     /* Worker threads where cllbacks like
        ProcessMessage() and OnClientDisconnect() are called from */
-    DcgmNs::ThreadPool m_workersPool;
+    DcgmNs::WorkStealingThreadPool m_workersPool;
 
     /* State of this instance's event base thread, including our server listeners */
     std::atomic<DcgmIpcState_t> m_state = DCGM_IPC_STATE_NOT_STARTED;
@@ -139,6 +201,10 @@ private:
     DcgmIpcProcessDisconnectFunc_f m_processDisconnectFunc;
     void *m_processDisconnectData;
 
+    /* Optional callback to call when a request that is no longer queued is cancelled */
+    DcgmIpcProcessCancelFunc_f m_processCancelFunc;
+    void *m_processCancelData;
+
     /* This tracks the next connectionId that will be allocated to a client. Use
        GetNextConnectionId() to access this */
     std::atomic<dcgm_connection_id_t> m_connectionId = DCGM_CONNECTION_ID_NONE;
@@ -152,11 +218,19 @@ private:
     /* Start-up promise. gets set by worker thread after init finishes or fails */
     std::promise<dcgmReturn_t> m_initPromise;
 
+    /* Size of the shared-memory ring to negotiate on domain socket connections to the host engine so
+       that large responses don't have to be copied through the socket. 0 = don't.
+       Set by __DCGM_IPC_SHM_RING__=1 */
+    std::size_t m_shmRingBytes;
+
 public:
     /* How many un-accepted connections to allow at a time. This value has worked
        since the beginning of DCGM */
     static const int DCGM_IPC_CONNECTION_BACKLOG = 6;
 
+    /* Size of the shared-memory ring requested by clients. Holds a few maximum size messages */
+    static const size_t DCGM_IPC_SHM_RING_BYTES = 4 * DCGM_PROTO_MAX_MESSAGE_SIZE;
+
     /*************************************************************************/
     explicit DcgmIpc(int numWorkerThreads);
     ~DcgmIpc();
@@ -167,13 +241,17 @@ public:
     void run() override;
 
     /*************************************************************************/
-    /* Soft constructor. Returns DCGM_ST_OK on success */
+    /* Soft constructor. Returns DCGM_ST_OK on success.
+     *
+     * processCancelFunc is optional. Requests that are cancelled while queued are dropped without it */
     dcgmReturn_t Init(std::optional<DcgmIpcTcpServerParams_t> tcpParameters,
                       std::optional<DcgmIpcDomainServerParams_t> domainParameters,
                       DcgmIpcProcessMessageFunc_f processMessageFunc,
                       void *processMessageData,
                       DcgmIpcProcessDisconnectFunc_f processDisconnectFunc,
-                      void *processDisconnectData);
+                      void *processDisconnectData,
+                      DcgmIpcProcessCancelFunc_f processCancelFunc = nullptr,
+                      void *processCancelData                      = nullptr);
 
     /*************************************************************************/
     /* Connect to a TCP/IP Host
@@ -182,15 +260,26 @@ public:
      * port          IN: TCP port to connect to
      * connectionId OUT: Connection ID that was allocated for this
      * timeoutMs     IN: How long to wait for this connection to establish in ms
+     * compressMinBytes IN: Offer the host engine to compress message bodies of at least
+     *                      this many bytes in both directions. 0 = don't. Messages are
+     *                      sent uncompressed if the host engine doesn't accept
      *
      * Returns: DCGM_ST_OK if the request was successful.
      *          DCGM_ST_CONNECTION_NOT_VALID if the connection failed
      *
      */
-    dcgmReturn_t ConnectTcp(std::string hostname, int port, dcgm_connection_id_t &connectionId, unsigned int timeoutMs);
+    dcgmReturn_t ConnectTcp(std::string hostname,
+                            int port,
+                            dcgm_connection_id_t &connectionId,
+                            unsigned int timeoutMs,
+                            unsigned int compressMinBytes = 0);
 
     /*************************************************************************/
     /* Connect to a domain socket
+     *
+     * If __DCGM_IPC_SHM_RING__=1 is set, this also offers the host engine a
+     * shared-memory ring to send large message bodies through. The socket is
+     * used for everything if the host engine doesn't take it.
      *
      * path          IN: Domain socket to connect to
      * connectionId OUT: Connection ID that was allocated for this
@@ -243,12 +332,25 @@ public:
      */
     dcgmReturn_t CloseConnection(dcgm_connection_id_t connectionId);
 
+    /*************************************************************************/
+    /* Get how deep each connection's queue of messages waiting for a worker
+     * thread is, how long they waited and how often reading from it had to be
+     * paused because it sent more than we could keep up with.
+     */
+    std::vector<dcgm_ipc_queue_stats_t> GetConnectionQueueStats() const;
+
 private:
     /*************************************************************************/
     /* Helpers to start listening sockets */
     dcgmReturn_t InitTCPListenerSocket();
     dcgmReturn_t InitUnixListenerSocket();
 
+    /*************************************************************************/
+    /* Helpers to create, bind and listen on the sockets of the Init?ListenerSocket() helpers when the
+       parameters don't come with a listening socket */
+    dcgmReturn_t CreateTCPListenerSocket();
+    dcgmReturn_t CreateUnixListenerSocket();
+
     /*************************************************************************/
     dcgm_connection_id_t GetNextConnectionId();
 
@@ -271,13 +373,19 @@ private:
         int m_port;                           /* Port to connect to */
         dcgm_connection_id_t m_connectionId;  /* Connection ID that was assigned to this
                                              pending connect */
+        unsigned int m_compressMinBytes;      /* Compression threshold to offer once connected. 0 = don't */
         std::promise<dcgmReturn_t> m_promise; /* Promise used to return if we connected or not */
 
-        DcgmIpcConnectTcp(DcgmIpc *ipc, std::string hostname, int port, dcgm_connection_id_t connectionId)
+        DcgmIpcConnectTcp(DcgmIpc *ipc,
+                          std::string hostname,
+                          int port,
+                          dcgm_connection_id_t connectionId,
+                          unsigned int compressMinBytes)
             : m_ipc(ipc)
             , m_hostname(hostname)
             , m_port(port)
             , m_connectionId(connectionId)
+            , m_compressMinBytes(compressMinBytes)
         {}
     };
 
@@ -381,29 +489,32 @@ private:
     DcgmIpcConnection *ConnectionIdToPtr(dcgm_connection_id_t connectionId);
 
     /*************************************************************************/
-    /* Function to call to process a message in our worker pool. We queue this outside
-       of the IPC thread to avoid deadlocks and keep sockets responsive */
-    typedef struct
+    /* Resume reading from a connection that m_scheduler throttled. Called from the IPC thread */
+    struct DcgmIpcResumeReading
     {
-        dcgm_connection_id_t connectionId;          /* Connection this message came from */
-        DcgmMessage *dcgmMessage;                   /* Message to process */
-        DcgmIpcProcessMessageFunc_f processMessage; /* Function to call with the message */
-        void *userData;                             /* User context pointer that was passed to Init() */
-    } DcgmIpcProcessMessage_t;
+        DcgmIpc *m_ipc;                      /* Instance of DcgmIpc this is associated with. Not owned here */
+        dcgm_connection_id_t m_connectionId; /* Connection to resume */
+    };
 
-    static void ProcessMessageInPool(DcgmIpcProcessMessage_t &processMe);
+    static void ResumeReadingCB(evutil_socket_t, short, void *data);
+    void ResumeReading(dcgm_connection_id_t connectionId);
 
     /*************************************************************************/
-    /* Function to call to process a client disconnect in our worker pool. We queue this outside
-       of the IPC thread to avoid deadlocks and keep sockets responsive */
-    typedef struct
-    {
-        dcgm_connection_id_t connectionId;                /* Connection this message came from */
-        DcgmIpcProcessDisconnectFunc_f processDisconnect; /* Function to call */
-        void *userData;                                   /* User context pointer that was passed to Init() */
-    } DcgmIpcProcessDisconnect_t;
+    /* Queue a worker task that processes the next item m_scheduler has. With connection affinity,
+       the task is pinned to the worker that owns connectionId.
+
+       Returns: true if the task was queued
+                false if the worker pool is stopped */
+    bool EnqueueSchedulerTask(dcgm_connection_id_t connectionId);
 
-    static void ProcessDisconnectInPool(DcgmIpcProcessDisconnect_t &processMe);
+    /*************************************************************************/
+    /* Called by m_scheduler from a worker thread once a throttled connection has drained */
+    void OnSchedulerResume(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /* Drop requestId of connectionId if it is still queued, else have m_processCancelFunc stop it.
+       DCGM_REQUEST_ID_NONE stops every request of the connection. Called from the IPC thread */
+    void CancelRequest(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
 
     /*************************************************************************/
     /* Helper method to wait for a connection future for a given timeout */
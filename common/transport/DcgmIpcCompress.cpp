@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmIpcCompress.h"
+
+#include <cstdint>
+#include <cstring>
+
+/*****************************************************************************/
+static std::uint32_t ReadU32(char const *p)
+{
+    std::uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/*****************************************************************************/
+void DcgmIpcCompress::AppendExtendedLength(std::size_t length, std::vector<char> &dst)
+{
+    while (length >= 255)
+    {
+        dst.push_back((char)255);
+        length -= 255;
+    }
+    dst.push_back((char)length);
+}
+
+/*****************************************************************************/
+bool DcgmIpcCompress::Compress(char const *src, std::size_t srcLen, std::vector<char> &dst)
+{
+    dst.clear();
+
+    if (srcLen <= MATCH_LIMIT + MIN_MATCH)
+    {
+        return false;
+    }
+
+    dst.reserve(srcLen);
+
+    /* Positions + 1 of the last occurrence of each hashed 4-byte sequence. 0 = none */
+    std::vector<std::uint32_t> table(1 << HASH_BITS, 0);
+
+    std::size_t anchor     = 0; /* Start of the literals not emitted yet */
+    std::size_t pos        = 0;
+    std::size_t matchStart = srcLen - MATCH_LIMIT; /* Matches can't start at or past this */
+    std::size_t matchEnd   = srcLen - LAST_LITERALS;
+
+    auto appendSequence = [&](std::size_t literalEnd, std::size_t offset, std::size_t matchLength) {
+        std::size_t literalLength = literalEnd - anchor;
+        std::size_t tokenIndex    = dst.size();
+        unsigned char token       = (unsigned char)((literalLength >= 15 ? 15 : literalLength) << 4);
+
+        dst.push_back(0);
+        if (literalLength >= 15)
+        {
+            AppendExtendedLength(literalLength - 15, dst);
+        }
+        dst.insert(dst.end(), src + anchor, src + literalEnd);
+
+        if (matchLength > 0)
+        {
+            dst.push_back((char)(offset & 0xFF));
+            dst.push_back((char)(offset >> 8));
+
+            std::size_t encodedLength = matchLength - MIN_MATCH;
+            token |= (unsigned char)(encodedLength >= 15 ? 15 : encodedLength);
+            if (encodedLength >= 15)
+            {
+                AppendExtendedLength(encodedLength - 15, dst);
+            }
+        }
+
+        dst[tokenIndex] = (char)token;
+    };
+
+    while (pos < matchStart)
+    {
+        std::uint32_t sequence = ReadU32(src + pos);
+        std::uint32_t hash     = (sequence * 2654435761U) >> (32 - HASH_BITS);
+        std::size_t candidate  = table[hash];
+        table[hash]            = (std::uint32_t)(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || ReadU32(src + candidate - 1) != sequence)
+        {
+            pos++;
+            continue;
+        }
+
+        std::size_t ref         = candidate - 1;
+        std::size_t matchLength = MIN_MATCH;
+        while (pos + matchLength < matchEnd && src[ref + matchLength] == src[pos + matchLength])
+        {
+            matchLength++;
+        }
+
+        appendSequence(pos, pos - ref, matchLength);
+
+        pos += matchLength;
+        anchor = pos;
+
+        /* Don't let the output grow past the input. It isn't worth sending compressed */
+        if (dst.size() >= srcLen)
+        {
+            return false;
+        }
+    }
+
+    appendSequence(srcLen, 0, 0);
+    return dst.size() < srcLen;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcCompress::Decompress(char const *src,
+                                         std::size_t srcLen,
+                                         std::size_t dstLen,
+                                         std::vector<char> &dst)
+{
+    dst.resize(dstLen);
+
+    std::size_t in  = 0;
+    std::size_t out = 0;
+
+    /* Read the rest of a length whose nibble was 15. Stops early if it gets absurd */
+    auto readExtendedLength = [&](std::size_t &length) {
+        unsigned char byte;
+        do
+        {
+            if (in >= srcLen || length > dstLen)
+            {
+                return false;
+            }
+            byte = (unsigned char)src[in++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (in < srcLen)
+    {
+        unsigned char token       = (unsigned char)src[in++];
+        std::size_t literalLength = token >> 4;
+
+        if (literalLength == 15 && !readExtendedLength(literalLength))
+        {
+            return DCGM_ST_BADPARAM;
+        }
+
+        if (literalLength > srcLen - in || literalLength > dstLen - out)
+        {
+            return DCGM_ST_BADPARAM;
+        }
+
+        memcpy(dst.data() + out, src + in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        if (in == srcLen)
+        {
+            break; /* The last sequence has no match */
+        }
+
+        if (srcLen - in < 2)
+        {
+            return DCGM_ST_BADPARAM;
+        }
+
+        std::size_t offset = (unsigned char)src[in] | ((std::size_t)(unsigned char)src[in + 1] << 8);
+        in += 2;
+
+        std::size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readExtendedLength(matchLength))
+        {
+            return DCGM_ST_BADPARAM;
+        }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > out || matchLength > dstLen - out)
+        {
+            return DCGM_ST_BADPARAM;
+        }
+
+        /* Byte by byte since the match can overlap what it's producing */
+        for (std::size_t i = 0; i < matchLength; i++)
+        {
+            dst[out + i] = dst[out - offset + i];
+        }
+        out += matchLength;
+    }
+
+    return out == dstLen ? DCGM_ST_OK : DCGM_ST_BADPARAM;
+}
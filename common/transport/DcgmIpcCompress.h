@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <dcgm_structs.h>
+
+#include <cstddef>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Compression of DcgmIpc message bodies on connections that negotiated it
+ * with DCGM_MSG_COMPRESS_NEGOTIATE.
+ *
+ * The encoding is the LZ4 block format: a series of sequences, each a token
+ * byte holding the literal and match lengths, the literals, then a 2-byte
+ * little-endian match offset. The last sequence only has literals. This is
+ * implemented here rather than linking liblz4 since DCGM messages are at
+ * most DCGM_PROTO_MAX_MESSAGE_SIZE and only need the fast, greedy compressor.
+ *
+ * Field value responses compress well since they repeat entity IDs, field
+ * IDs and close timestamps at fixed strides.
+ */
+class DcgmIpcCompress
+{
+public:
+    /*************************************************************************/
+    /*
+     * Compress srcLen bytes at src into dst, replacing its contents.
+     *
+     * RETURNS: true if dst holds the compressed bytes
+     *          false if the data didn't compress to less than srcLen. dst
+     *          is unspecified in that case and src should be sent as is
+     */
+    static bool Compress(char const *src, std::size_t srcLen, std::vector<char> &dst);
+
+    /*************************************************************************/
+    /*
+     * Decompress srcLen bytes at src into dst, which is resized to dstLen.
+     * The input is untrusted, so every length and offset is bounds checked.
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_BADPARAM if src is malformed or doesn't decompress to
+     *          exactly dstLen bytes
+     */
+    static dcgmReturn_t Decompress(char const *src, std::size_t srcLen, std::size_t dstLen, std::vector<char> &dst);
+
+private:
+    static constexpr std::size_t MIN_MATCH     = 4;  /* Shortest match that can be encoded */
+    static constexpr std::size_t LAST_LITERALS = 5;  /* The last bytes of a block are always literals */
+    static constexpr std::size_t MATCH_LIMIT   = 12; /* The last match starts at least this far from the end */
+    static constexpr std::size_t MAX_OFFSET    = 65535;
+    static constexpr unsigned int HASH_BITS    = 12;
+
+    /*************************************************************************/
+    /* Append a length that didn't fit in a token nibble */
+    static void AppendExtendedLength(std::size_t length, std::vector<char> &dst);
+};
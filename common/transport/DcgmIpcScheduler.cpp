@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmIpcScheduler.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+DcgmIpcScheduler::DcgmIpcScheduler(unsigned int maxQueued,
+                                   OnMessage_f onMessage,
+                                   OnDisconnect_f onDisconnect,
+                                   OnResume_f onResume,
+                                   bool perConnection)
+    : m_maxQueued(std::max(maxQueued, 2U))
+    , m_perConnection(perConnection)
+    , m_onMessage(std::move(onMessage))
+    , m_onDisconnect(std::move(onDisconnect))
+    , m_onResume(std::move(onResume))
+{}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::Push(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Queue &queue             = m_queues[connectionId];
+    queue.stats.connectionId = connectionId;
+
+    if (queue.items.empty() && !m_perConnection)
+    {
+        m_ready.push_back(connectionId);
+    }
+    queue.items.push_back({ std::move(message), std::chrono::steady_clock::now() });
+
+    queue.stats.depth    = queue.items.size();
+    queue.stats.maxDepth = std::max(queue.stats.maxDepth, queue.stats.depth);
+
+    if (!queue.isThrottled && queue.stats.depth >= m_maxQueued)
+    {
+        queue.isThrottled = true;
+        queue.stats.throttled++;
+        return true;
+    }
+
+    return false;
+}
+
+/*****************************************************************************/
+void DcgmIpcScheduler::PushDisconnect(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Queue &queue             = m_queues[connectionId];
+    queue.stats.connectionId = connectionId;
+
+    if (queue.items.empty() && !m_perConnection)
+    {
+        m_ready.push_back(connectionId);
+    }
+
+    /* A connection that was in line stays there with just its disconnect */
+    queue.stats.dropped += queue.items.size();
+    queue.items.clear();
+    queue.stats.depth = 0;
+    queue.items.push_back({ nullptr, std::chrono::steady_clock::now() });
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::Cancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId)
+{
+    bool resume = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto queueIt = m_queues.find(connectionId);
+        if (queueIt == m_queues.end())
+        {
+            return false;
+        }
+
+        Queue &queue = queueIt->second;
+        auto it      = std::find_if(queue.items.begin(), queue.items.end(), [requestId](Item const &item) {
+            return item.message != nullptr && item.message->GetRequestId() == requestId;
+        });
+        if (it == queue.items.end())
+        {
+            return false;
+        }
+
+        queue.items.erase(it);
+        queue.stats.depth = queue.items.size();
+        queue.stats.dropped++;
+
+        if (queue.items.empty() && !m_perConnection)
+        {
+            /* RunNext() expects every connection in line to have an item */
+            std::erase(m_ready, connectionId);
+        }
+
+        resume = ResumeIfDrainedLocked(queue);
+    }
+
+    if (resume)
+    {
+        m_onResume(connectionId);
+    }
+    return true;
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::ResumeIfDrainedLocked(Queue &queue)
+{
+    if (queue.isThrottled && queue.stats.depth <= m_maxQueued / 2)
+    {
+        queue.isThrottled = false;
+        return true;
+    }
+    return false;
+}
+
+/*****************************************************************************/
+bool DcgmIpcScheduler::ExpireRequest(DcgmMessage &message, std::uint64_t waitUsec)
+{
+    /* Only requests have a timeout. Responses read by clients have a status <= 0 in its place */
+    auto *header = message.GetMessageHdr();
+    if ((header->msgType != DCGM_MSG_MODULE_COMMAND && header->msgType != DCGM_MSG_MODULE_COMMAND_BATCH)
+        || header->timeoutMs <= 0)
+    {
+        return false;
+    }
+
+    std::uint64_t const waitMs = waitUsec / 1000;
+    if (waitMs >= (std::uint64_t)header->timeoutMs)
+    {
+        return true;
+    }
+
+    header->timeoutMs -= (int)waitMs;
+    return false;
+}
+
+/*****************************************************************************/
+DcgmIpcScheduler::Item DcgmIpcScheduler::PopLocked(dcgm_connection_id_t connectionId, bool &resume)
+{
+    Queue &queue = m_queues[connectionId];
+    Item item    = std::move(queue.items.front());
+    queue.items.pop_front();
+
+    if (item.message == nullptr)
+    {
+        /* The disconnect is the last item of its connection */
+        m_queues.erase(connectionId);
+        return item;
+    }
+
+    auto waitUsec
+        = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - item.queuedAt)
+              .count();
+
+    queue.stats.depth = queue.items.size();
+    resume            = ResumeIfDrainedLocked(queue);
+
+    if (ExpireRequest(*item.message, waitUsec))
+    {
+        item.isExpired = true;
+        queue.stats.dropped++;
+        return item;
+    }
+
+    queue.stats.processed++;
+    queue.stats.totalWaitUsec += waitUsec;
+    queue.stats.maxWaitUsec = std::max(queue.stats.maxWaitUsec, (std::uint64_t)waitUsec);
+
+    return item;
+}
+
+/*****************************************************************************/
+void DcgmIpcScheduler::Dispatch(dcgm_connection_id_t connectionId, Item item, bool resume)
+{
+    /* Callbacks are made unlocked since they can take a while and can queue more work */
+    if (item.message == nullptr)
+    {
+        m_onDisconnect(connectionId);
+        return;
+    }
+
+    if (resume)
+    {
+        m_onResume(connectionId);
+    }
+
+    if (item.isExpired)
+    {
+        /* The client stopped waiting for the response while this was queued */
+        return;
+    }
+
+    m_onMessage(connectionId, std::move(item.message));
+}
+
+/*****************************************************************************/
+void DcgmIpcScheduler::RunNext()
+{
+    dcgm_connection_id_t connectionId;
+    Item item;
+    bool resume = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_ready.empty())
+        {
+            return;
+        }
+
+        connectionId = m_ready.front();
+        m_ready.pop_front();
+
+        item = PopLocked(connectionId, resume);
+
+        auto it = m_queues.find(connectionId);
+        if (it != m_queues.end() && !it->second.items.empty())
+        {
+            /* Go to the back of the line */
+            m_ready.push_back(connectionId);
+        }
+    }
+
+    Dispatch(connectionId, std::move(item), resume);
+}
+
+/*****************************************************************************/
+void DcgmIpcScheduler::RunNext(dcgm_connection_id_t connectionId)
+{
+    Item item;
+    bool resume = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_queues.find(connectionId);
+        if (it == m_queues.end() || it->second.items.empty())
+        {
+            return;
+        }
+
+        item = PopLocked(connectionId, resume);
+    }
+
+    Dispatch(connectionId, std::move(item), resume);
+}
+
+/*****************************************************************************/
+std::vector<dcgm_ipc_queue_stats_t> DcgmIpcScheduler::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<dcgm_ipc_queue_stats_t> stats;
+    stats.reserve(m_queues.size());
+    for (auto const &[connectionId, queue] : m_queues)
+    {
+        stats.push_back(queue.stats);
+    }
+    return stats;
+}
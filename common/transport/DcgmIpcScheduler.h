@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmProtocol.h"
+
+#include <dcgm_structs_internal.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/* Per-connection counters of a DcgmIpcScheduler */
+struct dcgm_ipc_queue_stats_t
+{
+    dcgm_connection_id_t connectionId = DCGM_CONNECTION_ID_NONE;
+    unsigned int depth                = 0; /* Messages waiting to be processed now */
+    unsigned int maxDepth             = 0; /* Most messages that were ever waiting at once */
+    std::uint64_t processed           = 0; /* Messages handed to the worker pool so far */
+    std::uint64_t totalWaitUsec       = 0; /* Sum of how long the processed messages waited */
+    std::uint64_t maxWaitUsec         = 0; /* Longest any processed message waited */
+    std::uint64_t throttled           = 0; /* Times reading from this connection was paused */
+    std::uint64_t dropped             = 0; /* Messages dropped unprocessed because they were cancelled, their
+                                              timeout passed while they waited or the connection closed */
+};
+
+/*****************************************************************************/
+/*
+ * Queues incoming messages per connection and hands them to the worker pool
+ * round-robin across connections, so that a client that floods the host
+ * engine only delays its own requests.
+ *
+ * The owner enqueues one worker pool task that calls RunNext() for every
+ * Push() or PushDisconnect(). Each task processes whatever connection is
+ * next in line rather than the message that caused it to be queued.
+ *
+ * With perConnection set the owner instead enqueues RunNext(connectionId)
+ * tasks pinned to one worker per connection. Each connection is then served
+ * in order by a single worker and the round-robin line isn't kept.
+ *
+ * A connection with maxQueued messages waiting is throttled: Push() tells the
+ * owner to stop reading from it, and onResume is called once it has drained
+ * to half of that.
+ *
+ * Work nobody waits for anymore is dropped before it reaches the worker pool:
+ * the remaining messages of a connection once it disconnects, requests the
+ * client cancelled and requests whose header timeoutMs passed while they were
+ * waiting. A request that is handed on has its timeoutMs lowered by how long
+ * it waited, so the owner can keep to the client's deadline from then on.
+ */
+class DcgmIpcScheduler
+{
+public:
+    using OnMessage_f    = std::function<void(dcgm_connection_id_t, std::unique_ptr<DcgmMessage>)>;
+    using OnDisconnect_f = std::function<void(dcgm_connection_id_t)>;
+    using OnResume_f     = std::function<void(dcgm_connection_id_t)>;
+
+    DcgmIpcScheduler(unsigned int maxQueued,
+                     OnMessage_f onMessage,
+                     OnDisconnect_f onDisconnect,
+                     OnResume_f onResume,
+                     bool perConnection = false);
+
+    /*************************************************************************/
+    /*
+     * Queue message from connectionId.
+     *
+     * RETURNS: true if connectionId just became throttled. Stop reading from
+     *          it until onResume is called
+     *          false otherwise
+     */
+    bool Push(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message);
+
+    /*************************************************************************/
+    /*
+     * Queue the disconnect of connectionId. Its remaining messages are
+     * dropped since nobody can read their responses. onDisconnect is never
+     * called before one of its onMessage calls.
+     */
+    void PushDisconnect(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /*
+     * Drop the message of requestId from connectionId if it is still waiting.
+     *
+     * RETURNS: true if it was dropped
+     *          false if it isn't queued. It may be being processed
+     */
+    bool Cancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
+
+    /*************************************************************************/
+    /* Process the next message of the next connection in line. Called from worker threads */
+    void RunNext();
+
+    /*************************************************************************/
+    /* Process the next message of connectionId. Used instead of RunNext() when perConnection is set */
+    void RunNext(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    bool IsPerConnection() const
+    {
+        return m_perConnection;
+    }
+
+    /*************************************************************************/
+    /* Counters of every connection that has messages queued or hasn't disconnected yet */
+    std::vector<dcgm_ipc_queue_stats_t> GetStats() const;
+
+    /*************************************************************************/
+    /* Default for maxQueued. Overridden with __DCGM_IPC_MAX_QUEUED_MESSAGES__ */
+    static const unsigned int DEFAULT_MAX_QUEUED = 256;
+
+private:
+    struct Item
+    {
+        std::unique_ptr<DcgmMessage> message; /* nullptr for a disconnect */
+        std::chrono::steady_clock::time_point queuedAt;
+        bool isExpired = false; /* Set by PopLocked() if message is a request whose timeout passed */
+    };
+
+    struct Queue
+    {
+        std::deque<Item> items;
+        bool isThrottled = false;
+        dcgm_ipc_queue_stats_t stats;
+    };
+
+    unsigned int m_maxQueued;
+    bool m_perConnection;
+    OnMessage_f m_onMessage;
+    OnDisconnect_f m_onDisconnect;
+    OnResume_f m_onResume;
+
+    mutable std::mutex m_mutex; /* Protects everything below */
+    std::unordered_map<dcgm_connection_id_t, Queue> m_queues;
+    std::deque<dcgm_connection_id_t> m_ready; /* Connections with queued items, in the order they are served */
+
+    /* Take the next item of connectionId and update its counters. Sets resume if the connection should be resumed.
+       m_mutex must be held */
+    Item PopLocked(dcgm_connection_id_t connectionId, bool &resume);
+
+    /* Unthrottle queue if it drained far enough. Returns true if its connection should be resumed.
+       m_mutex must be held */
+    bool ResumeIfDrainedLocked(Queue &queue);
+
+    /* Check the timeout of a request that waited waitUsec. Returns true if it passed, else lowers it by waitUsec */
+    static bool ExpireRequest(DcgmMessage &message, std::uint64_t waitUsec);
+
+    /* Make the callbacks for an item taken by PopLocked() */
+    void Dispatch(dcgm_connection_id_t connectionId, Item item, bool resume);
+};
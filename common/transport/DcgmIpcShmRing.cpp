@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmIpcShmRing.h"
+
+#include <DcgmLogging.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+DcgmIpcShmRing::DcgmIpcShmRing(std::string name, int fd, void *mapping, std::size_t capacity)
+    : m_name(std::move(name))
+    , m_fd(fd)
+    , m_mapping(mapping)
+    , m_capacity(capacity)
+    , m_header((Header *)mapping)
+    , m_data((char *)mapping + c_dataOffset)
+{}
+
+/*****************************************************************************/
+DcgmIpcShmRing::~DcgmIpcShmRing()
+{
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, c_dataOffset + m_capacity);
+        m_mapping = nullptr;
+    }
+
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+
+    Unlink();
+}
+
+/*****************************************************************************/
+std::unique_ptr<DcgmIpcShmRing> DcgmIpcShmRing::Create(std::size_t capacity)
+{
+    static std::atomic<unsigned int> s_ringCounter = 0;
+
+    if (capacity == 0)
+    {
+        DCGM_LOG_ERROR << "Invalid shm ring capacity 0";
+        return nullptr;
+    }
+
+    std::string name;
+    int fd = -1;
+
+    /* The counter makes names unique within this process. Retry in case a
+       stale ring of a dead process with the same pid is still around */
+    for (int attempt = 0; attempt < 8 && fd < 0; attempt++)
+    {
+        name = "/dcgm-ipc-" + std::to_string(getpid()) + "-" + std::to_string(s_ringCounter++);
+        fd   = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0 && errno != EEXIST)
+        {
+            DCGM_LOG_ERROR << "shm_open of " << name << " failed with errno " << errno;
+            return nullptr;
+        }
+    }
+
+    if (fd < 0)
+    {
+        DCGM_LOG_ERROR << "Unable to find an unused shm ring name";
+        return nullptr;
+    }
+
+    std::size_t mappingSize = c_dataOffset + capacity;
+    if (ftruncate(fd, (off_t)mappingSize) != 0)
+    {
+        DCGM_LOG_ERROR << "ftruncate of " << name << " to " << mappingSize << " failed with errno " << errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        DCGM_LOG_ERROR << "mmap of " << name << " failed with errno " << errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    std::unique_ptr<DcgmIpcShmRing> ring(new DcgmIpcShmRing(name, fd, mapping, capacity));
+
+    ring->m_header->version  = c_version;
+    ring->m_header->reserved = 0;
+    ring->m_header->capacity = capacity;
+    ring->m_header->readOffset.store(0, std::memory_order_relaxed);
+    /* Set magic last so that a producer never sees a half-initialized header */
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->m_header->magic = c_magic;
+
+    DCGM_LOG_DEBUG << "Created shm ring " << name << " of " << capacity << " bytes";
+    return ring;
+}
+
+/*****************************************************************************/
+std::unique_ptr<DcgmIpcShmRing> DcgmIpcShmRing::Attach(std::string const &name, std::size_t capacity, uid_t ownerUid)
+{
+    if (name.empty() || name[0] != '/' || name.find('/', 1) != std::string::npos || capacity == 0)
+    {
+        DCGM_LOG_ERROR << "Invalid shm ring name \"" << name << "\" or capacity " << capacity;
+        return nullptr;
+    }
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        DCGM_LOG_WARNING << "shm_open of " << name << " failed with errno " << errno;
+        return nullptr;
+    }
+
+    std::size_t mappingSize = c_dataOffset + capacity;
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size != mappingSize)
+    {
+        DCGM_LOG_ERROR << "shm ring " << name << " has size " << st.st_size << " instead of " << mappingSize;
+        close(fd);
+        return nullptr;
+    }
+
+    /* Don't let one client make us write into a ring owned by someone else */
+    if (st.st_uid != ownerUid)
+    {
+        DCGM_LOG_ERROR << "shm ring " << name << " is owned by uid " << st.st_uid << " instead of " << ownerUid;
+        close(fd);
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        DCGM_LOG_ERROR << "mmap of " << name << " failed with errno " << errno;
+        close(fd);
+        return nullptr;
+    }
+
+    std::unique_ptr<DcgmIpcShmRing> ring(new DcgmIpcShmRing(name, fd, mapping, capacity));
+    ring->m_unlinked = true; /* Leave the name to the creator unless we attach successfully */
+
+    if (ring->m_header->magic != c_magic || ring->m_header->version != c_version
+        || ring->m_header->capacity != capacity)
+    {
+        DCGM_LOG_ERROR << "shm ring " << name << " has an unexpected header";
+        return nullptr;
+    }
+
+    /* The name is no longer needed. The ring stays until both sides unmap it */
+    ring->m_unlinked = false;
+    ring->Unlink();
+
+    ring->m_writeOffset = ring->m_header->readOffset.load(std::memory_order_acquire);
+
+    DCGM_LOG_DEBUG << "Attached to shm ring " << name << " of " << capacity << " bytes";
+    return ring;
+}
+
+/*****************************************************************************/
+bool DcgmIpcShmRing::Write(void const *data, std::size_t length, std::uint64_t &offset)
+{
+    if (m_corrupt || length == 0 || length > m_capacity)
+    {
+        return false;
+    }
+
+    std::uint64_t readOffset = m_header->readOffset.load(std::memory_order_acquire);
+    if (readOffset > m_writeOffset || m_writeOffset - readOffset > m_capacity)
+    {
+        /* The consumer's side of the mapping can't be trusted anymore. Stop using the ring */
+        DCGM_LOG_ERROR << "shm ring " << m_name << " has invalid readOffset " << readOffset << " for writeOffset "
+                       << m_writeOffset;
+        m_corrupt = true;
+        return false;
+    }
+
+    /* Payloads don't wrap. Skip to the start of the ring if this one would */
+    std::uint64_t start    = m_writeOffset;
+    std::size_t ringOffset = start % m_capacity;
+    if (ringOffset + length > m_capacity)
+    {
+        start += m_capacity - ringOffset;
+        ringOffset = 0;
+    }
+
+    if (start + length - readOffset > m_capacity)
+    {
+        return false; /* Full. The consumer hasn't caught up yet */
+    }
+
+    memcpy(m_data + ringOffset, data, length);
+    m_writeOffset = start + length;
+    offset        = start;
+    return true;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmIpcShmRing::Read(std::uint64_t offset, std::size_t length, std::vector<char> &dest)
+{
+    std::uint64_t readOffset = m_header->readOffset.load(std::memory_order_relaxed);
+
+    /* The payload must start where the last one ended, or at the start of the ring
+       if it didn't fit in what's left at the end. See Write() */
+    std::uint64_t expected = readOffset;
+    if ((readOffset % m_capacity) + length > m_capacity)
+    {
+        expected += m_capacity - (readOffset % m_capacity);
+    }
+
+    if (length == 0 || length > m_capacity || offset != expected)
+    {
+        DCGM_LOG_ERROR << "Invalid shm ring payload at " << offset << " of " << length << " bytes. readOffset "
+                       << readOffset;
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    dest.resize(length);
+    memcpy(dest.data(), m_data + (offset % m_capacity), length);
+
+    m_header->readOffset.store(offset + length, std::memory_order_release);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmIpcShmRing::Unlink()
+{
+    if (m_unlinked || m_name.empty())
+    {
+        return;
+    }
+
+    shm_unlink(m_name.c_str());
+    m_unlinked = true;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <dcgm_structs.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Single producer, single consumer byte ring in POSIX shared memory that
+ * carries message bodies from nv-hostengine to a client on the same host.
+ *
+ * The client creates the ring and passes its name to the host engine over the
+ * domain socket. The host engine attaches to it and writes large message
+ * bodies into it, only sending their offset and length over the socket. The
+ * socket stays the control channel and keeps messages in order.
+ *
+ * Offsets are logical and only ever grow. offset % capacity is where a
+ * payload starts in the ring. A payload never wraps around the end of the
+ * ring. The producer skips to the start of the ring instead.
+ */
+class DcgmIpcShmRing
+{
+public:
+    static constexpr std::uint64_t c_magic   = 0x474e495248534344; /* "DCSHRING" */
+    static constexpr std::uint32_t c_version = 1;
+
+    /*************************************************************************/
+    ~DcgmIpcShmRing();
+
+    DcgmIpcShmRing(DcgmIpcShmRing const &)            = delete;
+    DcgmIpcShmRing &operator=(DcgmIpcShmRing const &) = delete;
+
+    /*************************************************************************/
+    /*
+     * Create a new ring with a unique name. Used by the consumer (client).
+     *
+     * capacity IN: Size of the data area of the ring in bytes
+     *
+     * Returns the ring on success
+     *         nullptr on error
+     */
+    static std::unique_ptr<DcgmIpcShmRing> Create(std::size_t capacity);
+
+    /*************************************************************************/
+    /*
+     * Attach to a ring created by Create() and remove its name so that it
+     * goes away once both sides unmap it. Used by the producer (host engine).
+     *
+     * name     IN: Name returned by GetName() on the creating side
+     * capacity IN: Capacity passed to Create() on the creating side
+     * ownerUid IN: User that must own the ring. This is the peer of the
+     *              domain socket the name came from
+     *
+     * Returns the ring on success
+     *         nullptr if the ring could not be opened or doesn't match capacity
+     */
+    static std::unique_ptr<DcgmIpcShmRing> Attach(std::string const &name, std::size_t capacity, uid_t ownerUid);
+
+    /*************************************************************************/
+    /*
+     * Copy a payload into the ring. Producer only.
+     *
+     * data    IN: Payload to copy
+     * length  IN: Size of data in bytes
+     * offset OUT: Logical offset of the payload to pass to Read() on the consumer
+     *
+     * Returns true if the payload was written
+     *         false if there isn't room for it right now. The caller should send
+     *         the payload some other way
+     */
+    bool Write(void const *data, std::size_t length, std::uint64_t &offset);
+
+    /*************************************************************************/
+    /*
+     * Copy a payload out of the ring and release its space to the producer.
+     * Consumer only. Payloads must be read in the order they were written.
+     *
+     * offset  IN: Logical offset returned by Write()
+     * length  IN: Size of the payload in bytes
+     * dest   OUT: Resized to length and filled with the payload
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if offset and length don't describe the next payload in the ring
+     */
+    dcgmReturn_t Read(std::uint64_t offset, std::size_t length, std::vector<char> &dest);
+
+    /*************************************************************************/
+    /* Remove the name of the ring if it is still there. Safe to call more than once */
+    void Unlink();
+
+    /*************************************************************************/
+    std::string const &GetName() const
+    {
+        return m_name;
+    }
+
+    std::size_t GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    /* Start of the shared mapping. The data area follows at c_dataOffset */
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t capacity;
+        alignas(64) std::atomic<std::uint64_t> readOffset; /* Written by the consumer only */
+    };
+
+    static constexpr std::size_t c_dataOffset = 128;
+
+    DcgmIpcShmRing(std::string name, int fd, void *mapping, std::size_t capacity);
+
+    std::string m_name;               /* Name of the ring as passed to shm_open */
+    bool m_unlinked        = false;   /* Has m_name been removed yet? */
+    int m_fd               = -1;      /* fd from shm_open */
+    void *m_mapping        = nullptr; /* Start of the shared mapping */
+    std::size_t m_capacity = 0;       /* Size of the data area in bytes */
+    Header *m_header       = nullptr; /* Start of m_mapping */
+    char *m_data           = nullptr; /* Data area of m_mapping */
+
+    std::uint64_t m_writeOffset = 0;     /* Producer only. Logical offset of the end of the last payload written */
+    bool m_corrupt              = false; /* Producer only. Set once the consumer's readOffset was invalid */
+};
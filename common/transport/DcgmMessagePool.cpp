@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmMessagePool.h"
+
+/*****************************************************************************/
+DcgmMessagePool::DcgmMessagePool(std::size_t maxRetainedBytes)
+    : m_maxRetainedBytes(maxRetainedBytes)
+{}
+
+/*****************************************************************************/
+DcgmMessagePool &DcgmMessagePool::GetInstance()
+{
+    /* Never destroyed so that IPC threads that outlive static destruction can still use it */
+    static DcgmMessagePool *instance = new DcgmMessagePool();
+    return *instance;
+}
+
+/*****************************************************************************/
+std::size_t DcgmMessagePool::GetClassBytes(unsigned int sizeClass)
+{
+    return MIN_CLASS_BYTES << (2 * sizeClass);
+}
+
+/*****************************************************************************/
+unsigned int DcgmMessagePool::GetClassForRequest(std::size_t minCapacity)
+{
+    unsigned int sizeClass = 0;
+    while (sizeClass < NUM_SIZE_CLASSES && GetClassBytes(sizeClass) < minCapacity)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+/*****************************************************************************/
+unsigned int DcgmMessagePool::GetClassForCapacity(std::size_t capacity)
+{
+    if (capacity >= GetClassBytes(NUM_SIZE_CLASSES))
+    {
+        return NUM_SIZE_CLASSES;
+    }
+
+    unsigned int sizeClass = 0;
+    while (sizeClass + 1 < NUM_SIZE_CLASSES && GetClassBytes(sizeClass + 1) <= capacity)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+/*****************************************************************************/
+std::unique_ptr<DcgmMessage> DcgmMessagePool::Get(std::size_t minCapacity)
+{
+    unsigned int sizeClass = GetClassForRequest(minCapacity);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stats.gets++;
+
+        if (sizeClass < NUM_SIZE_CLASSES && !m_classes[sizeClass].empty())
+        {
+            std::unique_ptr<DcgmMessage> message = std::move(m_classes[sizeClass].back());
+            m_classes[sizeClass].pop_back();
+
+            m_stats.hits++;
+            m_stats.retainedMessages--;
+            m_stats.retainedBytes -= message->GetMsgBytesPtr()->capacity();
+            return message;
+        }
+    }
+
+    auto message = std::make_unique<DcgmMessage>();
+    if (sizeClass < NUM_SIZE_CLASSES)
+    {
+        /* Round up to the class size so that this message can go back into the pool */
+        message->GetMsgBytesPtr()->reserve(GetClassBytes(sizeClass));
+    }
+    return message;
+}
+
+/*****************************************************************************/
+void DcgmMessagePool::Put(std::unique_ptr<DcgmMessage> message)
+{
+    if (message == nullptr)
+    {
+        return;
+    }
+
+    auto msgBytes = message->GetMsgBytesPtr();
+    msgBytes->clear();
+    message->ClearExternalSegments();
+    *message->GetMessageHdr() = {};
+
+    std::size_t capacity = msgBytes->capacity();
+    if (capacity < MIN_CLASS_BYTES)
+    {
+        /* Messages built with vector::assign etc. are exactly as big as their body. An undersized
+           buffer would make every Get() reallocate, so grow it once here instead */
+        msgBytes->reserve(MIN_CLASS_BYTES);
+        capacity = msgBytes->capacity();
+    }
+
+    unsigned int sizeClass = GetClassForCapacity(capacity);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stats.puts++;
+
+    if (sizeClass >= NUM_SIZE_CLASSES || m_classes[sizeClass].size() >= MAX_MESSAGES_PER_CLASS
+        || m_stats.retainedBytes + capacity > m_maxRetainedBytes)
+    {
+        m_stats.discards++;
+        return; /* message is freed when it goes out of scope */
+    }
+
+    m_classes[sizeClass].push_back(std::move(message));
+    m_stats.retainedMessages++;
+    m_stats.retainedBytes += capacity;
+}
+
+/*****************************************************************************/
+dcgm_message_pool_stats_t DcgmMessagePool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/*****************************************************************************/
+void DcgmMessagePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto &messages : m_classes)
+    {
+        messages.clear();
+    }
+    m_stats.retainedMessages = 0;
+    m_stats.retainedBytes    = 0;
+}
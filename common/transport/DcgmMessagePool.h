@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmProtocol.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*****************************************************************************/
+/* Counters of a DcgmMessagePool */
+struct dcgm_message_pool_stats_t
+{
+    std::uint64_t gets           = 0; /* Calls to Get() */
+    std::uint64_t hits           = 0; /* Calls to Get() that were served from the pool */
+    std::uint64_t puts           = 0; /* Calls to Put() */
+    std::uint64_t discards       = 0; /* Calls to Put() that freed the message instead of keeping it */
+    std::size_t retainedMessages = 0; /* Messages currently in the pool */
+    std::size_t retainedBytes    = 0; /* Sum of the body capacities of the messages currently in the pool */
+};
+
+/*****************************************************************************/
+/*
+ * Thread-safe pool of DcgmMessage objects whose body buffers are kept
+ * allocated between uses.
+ *
+ * Messages are kept in size classes by the capacity of their body so that a
+ * small request is never served a multi-MB buffer and a large read doesn't
+ * have to grow a small one. Bodies bigger than the largest class are freed,
+ * as is anything that would take the pool past its byte cap.
+ *
+ * The pool returned by GetInstance() is shared by every connection of the
+ * process, so connections that only live for a request or two still reuse
+ * the buffers of the ones before them.
+ */
+class DcgmMessagePool
+{
+public:
+    static constexpr std::size_t DEFAULT_MAX_RETAINED_BYTES = 16 * 1024 * 1024;
+
+    explicit DcgmMessagePool(std::size_t maxRetainedBytes = DEFAULT_MAX_RETAINED_BYTES);
+
+    /*************************************************************************/
+    /* The process-wide pool */
+    static DcgmMessagePool &GetInstance();
+
+    /*************************************************************************/
+    /*
+     * Get an empty message whose body can hold at least minCapacity bytes
+     * without reallocating. The message is newly allocated if the pool has
+     * none that fit.
+     */
+    std::unique_ptr<DcgmMessage> Get(std::size_t minCapacity = 0);
+
+    /*************************************************************************/
+    /*
+     * Return message to the pool. Its header, body and external segments are
+     * cleared. The message is freed if the pool doesn't want it.
+     */
+    void Put(std::unique_ptr<DcgmMessage> message);
+
+    /*************************************************************************/
+    dcgm_message_pool_stats_t GetStats() const;
+
+    /*************************************************************************/
+    /* Free every message in the pool. The counters are kept */
+    void Clear();
+
+private:
+    static constexpr std::size_t NUM_SIZE_CLASSES       = 8;
+    static constexpr std::size_t MIN_CLASS_BYTES        = 256; /* Class i holds bodies of MIN_CLASS_BYTES << 2i */
+    static constexpr std::size_t MAX_MESSAGES_PER_CLASS = 64;
+
+    /*************************************************************************/
+    static std::size_t GetClassBytes(unsigned int sizeClass);
+
+    /*************************************************************************/
+    /* Smallest class whose messages can all hold minCapacity bytes. NUM_SIZE_CLASSES if none can */
+    static unsigned int GetClassForRequest(std::size_t minCapacity);
+
+    /*************************************************************************/
+    /* Largest class whose size is <= capacity. NUM_SIZE_CLASSES if capacity is too big to keep */
+    static unsigned int GetClassForCapacity(std::size_t capacity);
+
+    std::size_t m_maxRetainedBytes;
+
+    mutable std::mutex m_mutex; /* Protects everything below */
+    std::array<std::vector<std::unique_ptr<DcgmMessage>>, NUM_SIZE_CLASSES> m_classes;
+    dcgm_message_pool_stats_t m_stats;
+};
@@ -50,7 +50,24 @@ std::vector<char> *DcgmMessage::GetMsgBytesPtr()
 
 size_t DcgmMessage::GetLength()
 {
-    return m_msgBytes.size();
+    return m_msgBytes.size() + m_externalLength;
+}
+
+void DcgmMessage::AddExternalSegment(void const *data, std::size_t length, std::shared_ptr<void const> owner)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    m_externalSegments.push_back({ data, length, std::move(owner) });
+    m_externalLength += length;
+}
+
+void DcgmMessage::ClearExternalSegments()
+{
+    m_externalSegments.clear();
+    m_externalLength = 0;
 }
 
 dcgm_request_id_t DcgmMessage::GetRequestId()
@@ -65,5 +82,7 @@ void DcgmMessage::SetRequestId(dcgm_request_id_t requestId)
 
 bool DcgmMessage::IsAsyncNotification(void)
 {
-    return m_messageHdr.msgType == DCGM_MSG_POLICY_NOTIFY;
+    return m_messageHdr.msgType == DCGM_MSG_POLICY_NOTIFY || m_messageHdr.msgType == DCGM_MSG_FV_NOTIFY
+           || m_messageHdr.msgType == DCGM_MSG_DIAG_TEST_NOTIFY || m_messageHdr.msgType == DCGM_MSG_POLICY_NOTIFY_BATCH
+           || m_messageHdr.msgType == DCGM_MSG_METADATA_NOTIFY;
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "dcgm_structs.h"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 /* Align to byte boundaries */
@@ -52,7 +53,13 @@ typedef struct
     int length;                  /* Length of message body (not including this header). The full size of this
                                     message on the wire is sizeof(*header) + header->length */
     int msgType;                 /* Type of message. One of DCGM_MSG_? */
-    int status;                  /* Status. One of DCGM_ST_? #defines from dcgm_structs.h */
+    union
+    {
+        int status;    /* Status. One of DCGM_ST_? #defines from dcgm_structs.h */
+        int timeoutMs; /* DCGM_MSG_MODULE_COMMAND and DCGM_MSG_MODULE_COMMAND_BATCH requests only. How long the
+                          client waits for the response. The host engine drops or stops the request once this
+                          passed. 0 = forever. Older clients always send DCGM_ST_OK, which is 0 */
+    };
 } dcgm_message_header_t;
 
 #pragma pack() /* Undo the 1-byte alignment */
@@ -66,6 +73,25 @@ typedef struct
 #define DCGM_MSG_MODULE_COMMAND 0x0300 /* A module command message */
 #define DCGM_MSG_POLICY_NOTIFY  0x0400 /* Async notification of a policy violation */
 #define DCGM_MSG_REQUEST_NOTIFY 0x0500 /* Notify an async request that it will receive no further updates */
+#define DCGM_MSG_SHM_ATTACH     0x0600 /* Set up a shared-memory ring for bulk payloads. Handled within DcgmIpc */
+#define DCGM_MSG_SHM_PAYLOAD    0x0700 /* The body of this message is in the shared-memory ring. Handled within
+                                          DcgmIpc */
+#define DCGM_MSG_MODULE_COMMAND_BATCH 0x0800 /* Several module commands in one message */
+#define DCGM_MSG_FV_NOTIFY            0x0900 /* Async push of field values to a subscribed client. The body is a
+                                                serialized DcgmFvBuffer */
+#define DCGM_MSG_COMPRESS_NEGOTIATE   0x0A00 /* Agree to compress message bodies. Handled within DcgmIpc */
+#define DCGM_MSG_COMPRESSED           0x0B00 /* The body of this message is compressed. Handled within DcgmIpc */
+#define DCGM_MSG_DIAG_TEST_NOTIFY     0x0C00 /* Async push of a completed diagnostic test. The body is a
+                                                dcgmDiagTestCompletion_v1 */
+#define DCGM_MSG_POLICY_NOTIFY_BATCH  0x0D00 /* Async notification of several policy violations. Sent to
+                                                registrations with a coalescing window */
+#define DCGM_MSG_METADATA_NOTIFY      0x0E00 /* Async notification that groups, field groups, MIG or topology
+                                                changed. The body is a dcgm_msg_metadata_notify_t */
+#define DCGM_MSG_REQUEST_CANCEL       0x0F00 /* The client no longer waits for the response to the request of the
+                                                header requestId. There is no body and no response */
+
+/* Algorithms for DCGM_MSG_COMPRESS_NEGOTIATE */
+#define DCGM_MSG_COMPRESS_ALGO_LZ4_BLOCK 1 /* LZ4 block format. See DcgmIpcCompress.h */
 
 /* DCGM_MSG_POLICY_NOTIFY - Signal a client that a policy has been violated */
 typedef struct
@@ -73,6 +99,26 @@ typedef struct
     dcgmPolicyCallbackResponse_t response; /* Policy response to pass to client callbacks */
 } dcgm_msg_policy_notify_t;
 
+/* DCGM_MSG_METADATA_NOTIFY - Signal a client that cached metadata is out of date */
+typedef struct
+{
+    unsigned long long generation; /* Metadata generation of the host engine after the change */
+} dcgm_msg_metadata_notify_t;
+
+/* Most violations in one DCGM_MSG_POLICY_NOTIFY_BATCH */
+#define DCGM_MSG_POLICY_NOTIFY_BATCH_MAX 64
+
+/* DCGM_MSG_POLICY_NOTIFY_BATCH - Signal a client that policies have been violated. Only the first numResponses
+ *                                entries of responses[] are sent
+ **/
+typedef struct
+{
+    unsigned int numResponses; /* Number of entries of responses[] that are set */
+    unsigned int numDropped;   /* Violations dropped by the rate limit of the registration since the last batch */
+    dcgmPolicyCallbackResponse_t responses[DCGM_MSG_POLICY_NOTIFY_BATCH_MAX]; /* Policy responses to pass to client
+                                                                                 callbacks, oldest first */
+} dcgm_msg_policy_notify_batch_t;
+
 /* DCGM_MSG_REQUEST_NOTIFY - Notify an async request that it will receive
  *                           no further updates
  **/
@@ -82,6 +128,84 @@ typedef struct
                                message contents */
 } dcgm_msg_request_notify_t;
 
+/* DCGM_MSG_SHM_ATTACH - Sent by a client on the same host with the name of a
+ *                       DcgmIpcShmRing it created. The host engine replies with
+ *                       an empty DCGM_MSG_SHM_ATTACH whose header status says
+ *                       whether it will use the ring
+ **/
+typedef struct
+{
+    char name[64];               /* Name of the ring to shm_open() */
+    unsigned long long capacity; /* Size of the data area of the ring in bytes */
+} dcgm_msg_shm_attach_t;
+
+/* DCGM_MSG_SHM_PAYLOAD - Stands in for a message whose body was written to the
+ *                        shared-memory ring. The header requestId and status
+ *                        are those of the original message
+ **/
+typedef struct
+{
+    int msgType;               /* msgType of the original message */
+    int length;                /* Length of the original message body */
+    unsigned long long offset; /* Logical offset of the body in the ring */
+} dcgm_msg_shm_payload_t;
+
+/* DCGM_MSG_COMPRESS_NEGOTIATE - Sent by a client once connected with the
+ *                               algorithm it wants and the smallest body
+ *                               worth compressing. The host engine replies
+ *                               with the values it will use and a header
+ *                               status of DCGM_ST_OK if it accepts. Each side
+ *                               only compresses what it sends once it knows
+ *                               the other side accepted
+ **/
+typedef struct
+{
+    unsigned int algorithm; /* DCGM_MSG_COMPRESS_ALGO_? */
+    unsigned int minBytes;  /* Bodies smaller than this are sent uncompressed */
+} dcgm_msg_compress_negotiate_t;
+
+/* DCGM_MSG_COMPRESSED - Stands in for a message whose body follows this
+ *                       struct compressed. The header requestId and status
+ *                       are those of the original message
+ **/
+typedef struct
+{
+    int msgType;            /* msgType of the original message */
+    int length;             /* Length of the original message body */
+    unsigned int algorithm; /* DCGM_MSG_COMPRESS_ALGO_? the body was compressed with */
+    unsigned int reserved;  /* Must be 0 */
+} dcgm_msg_compressed_t;
+
+/* DCGM_MSG_MODULE_COMMAND_BATCH - Several module commands that the host engine
+ *                                 processes back to back. The body is a
+ *                                 dcgm_msg_module_command_batch_t followed by
+ *                                 numCommands entries. Each entry is a
+ *                                 dcgm_msg_module_command_batch_entry_t followed
+ *                                 by a module command of entry length, padded
+ *                                 with DCGM_MSG_MODULE_COMMAND_BATCH_PADDED().
+ *
+ *                                 The response is a batch of the same commands
+ *                                 in the same order. Each is replaced by its
+ *                                 response and its entry status is what the host
+ *                                 engine returned for it.
+ **/
+#define DCGM_MSG_MODULE_COMMAND_BATCH_MAX 64 /* Maximum numCommands in one batch */
+
+/* Each module command of a batch starts 8-byte aligned */
+#define DCGM_MSG_MODULE_COMMAND_BATCH_PADDED(length) (((size_t)(length) + 7) & ~(size_t)7)
+
+typedef struct
+{
+    unsigned int numCommands; /* Number of entries that follow */
+    unsigned int reserved;    /* Must be 0 */
+} dcgm_msg_module_command_batch_t;
+
+typedef struct
+{
+    int status;          /* Response only. DCGM_ST_? the host engine returned for this command */
+    unsigned int length; /* Length of the module command that follows, not counting padding */
+} dcgm_msg_module_command_batch_entry_t;
+
 class DcgmMessage
 {
 public:
@@ -119,10 +243,43 @@ public:
     std::vector<char> *GetMsgBytesPtr();
 
     /**
-     * This method is used to get the length of the message
+     * This method is used to get the length of the message. This includes any external segments
      */
     std::size_t GetLength();
 
+    /**
+     * Append length bytes at data to the body of this message without copying them. External segments
+     * are sent after the bytes of GetMsgBytesPtr(), in the order they were added. owner is kept alive
+     * until the transport is done with data, which can be after this message has been destroyed.
+     *
+     * Only messages that are sent can have external segments. The header's length is not updated, so
+     * call UpdateMsgHdr() with GetLength() once all segments have been added.
+     */
+    void AddExternalSegment(void const *data, std::size_t length, std::shared_ptr<void const> owner);
+
+    /**
+     * An externally owned part of the body of a message
+     */
+    struct ExternalSegment
+    {
+        void const *data;                  /*!< First byte of the segment */
+        std::size_t length;                /*!< Number of bytes at data */
+        std::shared_ptr<void const> owner; /*!< Keeps data valid */
+    };
+
+    /**
+     * This method returns the external segments of this message, in the order they are sent
+     */
+    std::vector<ExternalSegment> const &GetExternalSegments() const
+    {
+        return m_externalSegments;
+    }
+
+    /**
+     * Drop all external segments, releasing this message's references to their owners
+     */
+    void ClearExternalSegments();
+
     /**
      * This method is used to get the msgType
      */
@@ -151,7 +308,10 @@ private:
     dcgm_message_header_t m_messageHdr {}; /*!< Sender populates the message to be sent */
     std::vector<char> m_msgBytes;          /*!< The bytes of the message that come after m_messageHdr on the
                                                socket stream. The .size() member of this is the size of
-                                               the message. This should match m_messageHdr.length */
+                                               the message if there are no m_externalSegments.
+                                               This should match m_messageHdr.length */
+    std::vector<ExternalSegment> m_externalSegments; /*!< Bytes sent after m_msgBytes without being copied */
+    std::size_t m_externalLength = 0;                /*!< Sum of the lengths of m_externalSegments */
 };
 
 #endif /* DCGM_PROTOCOL_H */
@@ -16,7 +16,10 @@
 #include "cublas_proxy.hpp"
 #include <DcgmLogging.h>
 
+#include <array>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 
 /*
  * Cublas
@@ -119,6 +122,184 @@ cublasStatus_t CublasHgemm(cublasHandle_t handle,
 {
     MAKE_API_CALL(cublasHgemm, handle, transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
+
+/*
+ * Shared handles
+ */
+namespace
+{
+struct SharedHandle
+{
+    cublasHandle_t handle = nullptr;
+    bool acquired         = false;
+};
+
+std::mutex g_sharedHandlesMutex;
+
+/* Never destroyed: the CUDA runtime may already be torn down when static destructors run */
+auto &g_sharedHandles = *new std::unordered_map<int, SharedHandle>();
+
+/* Run a small GEMM of each precision so that cuBLAS loads its kernels before the first test needs them */
+void WarmUp(cublasHandle_t handle)
+{
+    constexpr int dim = 64;
+    std::array<void *, 3> buffers {};
+    bool allocated = true;
+    for (auto &buffer : buffers)
+    {
+        allocated = allocated && cudaMalloc(&buffer, dim * dim * sizeof(double)) == cudaSuccess
+                    && cudaMemset(buffer, 0, dim * dim * sizeof(double)) == cudaSuccess;
+    }
+
+    if (allocated)
+    {
+        double const dOne  = 1.0;
+        double const dZero = 0.0;
+        float const sOne   = 1.0f;
+        float const sZero  = 0.0f;
+        __half const hOne  = __float2half(1.0f);
+        __half const hZero = __float2half(0.0f);
+
+        auto const [a, b, c] = buffers;
+
+        cublasDgemm(handle,
+                    CUBLAS_OP_N,
+                    CUBLAS_OP_N,
+                    dim,
+                    dim,
+                    dim,
+                    &dOne,
+                    static_cast<double const *>(a),
+                    dim,
+                    static_cast<double const *>(b),
+                    dim,
+                    &dZero,
+                    static_cast<double *>(c),
+                    dim);
+        cublasSgemm(handle,
+                    CUBLAS_OP_N,
+                    CUBLAS_OP_N,
+                    dim,
+                    dim,
+                    dim,
+                    &sOne,
+                    static_cast<float const *>(a),
+                    dim,
+                    static_cast<float const *>(b),
+                    dim,
+                    &sZero,
+                    static_cast<float *>(c),
+                    dim);
+        // Not supported by every GPU, which is fine for a warm-up
+        cublasHgemm(handle,
+                    CUBLAS_OP_N,
+                    CUBLAS_OP_N,
+                    dim,
+                    dim,
+                    dim,
+                    &hOne,
+                    static_cast<__half const *>(a),
+                    dim,
+                    static_cast<__half const *>(b),
+                    dim,
+                    &hZero,
+                    static_cast<__half *>(c),
+                    dim);
+        if (cudaDeviceSynchronize() != cudaSuccess)
+        {
+            log_debug("cuBLAS warm-up did not complete");
+        }
+    }
+
+    for (auto buffer : buffers)
+    {
+        if (buffer != nullptr)
+        {
+            cudaFree(buffer);
+        }
+    }
+}
+} // namespace
+
+cublasStatus_t CublasAcquireSharedHandle(int cudaDeviceIdx, cublasHandle_t *handle)
+{
+    std::lock_guard<std::mutex> lock(g_sharedHandlesMutex);
+
+    SharedHandle &shared = g_sharedHandles[cudaDeviceIdx];
+    if (shared.acquired)
+    {
+        log_debug("The shared cuBLAS handle of device {} is in use, creating another one", cudaDeviceIdx);
+        return cublasCreate(handle);
+    }
+
+    if (shared.handle == nullptr)
+    {
+        int currentDevice = 0;
+        if (cudaGetDevice(&currentDevice) != cudaSuccess || cudaSetDevice(cudaDeviceIdx) != cudaSuccess)
+        {
+            log_error("Unable to make device {} current to create its cuBLAS handle", cudaDeviceIdx);
+            return CUBLAS_STATUS_NOT_INITIALIZED;
+        }
+
+        cublasStatus_t const st = cublasCreate(&shared.handle);
+        if (st == CUBLAS_STATUS_SUCCESS)
+        {
+            WarmUp(shared.handle);
+        }
+        cudaSetDevice(currentDevice);
+
+        if (st != CUBLAS_STATUS_SUCCESS)
+        {
+            shared.handle = nullptr;
+            return st;
+        }
+        log_debug("Created the shared cuBLAS handle {} of device {}", (void *)shared.handle, cudaDeviceIdx);
+    }
+
+    shared.acquired = true;
+    *handle         = shared.handle;
+    return CUBLAS_STATUS_SUCCESS;
+}
+
+cublasStatus_t CublasReleaseSharedHandle(cublasHandle_t handle)
+{
+    std::lock_guard<std::mutex> lock(g_sharedHandlesMutex);
+
+    for (auto &[cudaDeviceIdx, shared] : g_sharedHandles)
+    {
+        if (shared.handle == handle && shared.acquired)
+        {
+            // The stream may be destroyed along with the plugin that set it
+            cublasSetStream(handle, nullptr);
+            cublasSetMathMode(handle, CUBLAS_DEFAULT_MATH);
+            shared.acquired = false;
+            return CUBLAS_STATUS_SUCCESS;
+        }
+    }
+
+    return cublasDestroy(handle);
+}
+
+void CublasDestroySharedHandles()
+{
+    std::lock_guard<std::mutex> lock(g_sharedHandlesMutex);
+
+    for (auto it = g_sharedHandles.begin(); it != g_sharedHandles.end();)
+    {
+        if (it->second.acquired)
+        {
+            log_warning("Not destroying the shared cuBLAS handle of device {} as it is in use", it->first);
+            ++it;
+            continue;
+        }
+        if (it->second.handle != nullptr)
+        {
+            cublasDestroy(it->second.handle);
+        }
+        it = g_sharedHandles.erase(it);
+    }
+}
+
 /*
  * CublasLt
  */
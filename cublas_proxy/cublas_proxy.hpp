@@ -83,6 +83,25 @@ cublasStatus_t PUBLIC_API CublasHgemm(cublasHandle_t handle,
                                       const __half *beta, /* host or device pointer */
                                       __half *C,
                                       int ldc);
+
+/*
+ * Handles shared by all the plugins of the process, one per CUDA device, on the primary context of the device.
+ * Creating a cuBLAS handle and loading its kernels takes a while on the first use of a device, so this is only paid
+ * once per NVVS run instead of once per plugin. The first acquisition for a device also runs a small GEMM of each
+ * precision to load the kernels.
+ *
+ * A handle that is already acquired is not shared: the caller gets a handle of its own, which is destroyed when it is
+ * released. Released handles get back the default stream and math mode.
+ */
+cublasStatus_t PUBLIC_API CublasAcquireSharedHandle(int cudaDeviceIdx, cublasHandle_t *handle);
+cublasStatus_t PUBLIC_API CublasReleaseSharedHandle(cublasHandle_t handle);
+
+/*
+ * Destroys the shared handles that are not acquired. Must be called before the primary context of a device is
+ * destroyed, e.g. by cudaDeviceReset(), as the handles belong to it.
+ */
+void PUBLIC_API CublasDestroySharedHandles();
+
 /*
  * CublasLt
  */
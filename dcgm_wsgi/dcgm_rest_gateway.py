@@ -0,0 +1,459 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+'''
+Asynchronous REST gateway to DCGM. Serves the same /dcgmjsonrest?action=...
+requests as dcgm_wsgi.py, but:
+
+- Requests are handled by an asyncio server. DCGM calls run on worker threads
+  that share a small pool of host engine connections, so a slow call doesn't
+  block the others and all clients share the same connections.
+- Identical concurrent queries are coalesced into one host engine call, and
+  its response is reused for DCGM_REST_CACHE_TTL seconds.
+- action=rundiagnostic starts a diagnostic job and returns its jobId right
+  away. Poll it with action=getjob&jobid=<jobId> until its state is 'done' or
+  'error'. Diagnostics run on their own connection, so they never hold up
+  queries.
+
+Run with PYTHONPATH pointing at the DCGM python bindings:
+
+    PYTHONPATH=/usr/local/dcgm/bindings python3 dcgm_rest_gateway.py --port 1981
+'''
+
+import argparse
+import asyncio
+import concurrent.futures
+import itertools
+import json
+import queue
+import time
+import urllib.parse
+
+import DcgmHandle
+import dcgm_structs
+from dcgm_structs import dcgmExceptionClass
+
+###############################################################################
+DCGM_REST_PORT = 1981
+DCGM_REST_JSON_DIR = 'dcgmjsonrest'
+DCGM_JSON_VERSION = '1.1' #Minor version bump from dcgm_wsgi.py: rundiagnostic returns a job
+DCGM_IP_ADDRESS = "127.0.0.1"
+DCGM_REST_POOL_SIZE = 4 #Host engine connections shared by queries
+DCGM_REST_CACHE_TTL = 1.0 #Seconds a query response is reused for
+DCGM_REST_JOB_TTL = 3600.0 #Seconds a finished diagnostic job is kept for polling
+DCGM_REST_MAX_REQUEST_SIZE = 8192
+DCGM_REST_REQUEST_TIMEOUT = 10.0 #Seconds a client has to send its request
+
+###############################################################################
+DCGM_HTTP_CODE_OK           = 200
+DCGM_HTTP_CODE_ACCEPTED     = 202
+DCGM_HTTP_CODE_BAD_REQUEST  = 400
+DCGM_HTTP_CODE_NOT_FOUND    = 404
+DCGM_HTTP_CODE_METHOD       = 405
+DCGM_HTTP_CODE_INT_ERROR    = 500
+DCGM_HTTP_CODE_UNAVAILABLE  = 503
+
+DCGM_HTTP_REASONS = {
+    DCGM_HTTP_CODE_OK: 'OK',
+    DCGM_HTTP_CODE_ACCEPTED: 'Accepted',
+    DCGM_HTTP_CODE_BAD_REQUEST: 'Bad Request',
+    DCGM_HTTP_CODE_NOT_FOUND: 'Not Found',
+    DCGM_HTTP_CODE_METHOD: 'Method Not Allowed',
+    DCGM_HTTP_CODE_INT_ERROR: 'Internal Server Error',
+    DCGM_HTTP_CODE_UNAVAILABLE: 'Service Unavailable',
+}
+
+###############################################################################
+class DcgmRestError(Exception):
+    '''
+    A request that can't be served. Reported to the client as a JSON error with httpCode
+    '''
+    def __init__(self, httpCode, errorString):
+        Exception.__init__(self, errorString)
+        self.httpCode = httpCode
+        self.errorString = errorString
+
+###############################################################################
+def GetJsonError(errorString):
+    responseObj = {'version':DCGM_JSON_VERSION,
+                   'status':'ERROR',
+                   'errorString':errorString}
+    return json.dumps(responseObj)
+
+###############################################################################
+def GetJsonResponse(encodeObject):
+    responseObj = {'version':DCGM_JSON_VERSION,
+                   'status':'OK',
+                   'responseData':encodeObject}
+    return json.dumps(responseObj, cls=dcgm_structs.DcgmJSONEncoder)
+
+###############################################################################
+class DcgmPooledConnection:
+    '''
+    One host engine connection of a DcgmConnectionPool, and the state set up on it
+    '''
+    def __init__(self, ipAddress):
+        self._ipAddress = ipAddress
+        self._dcgmHandle = None
+        self.dcgmSystem = None
+        self.defaultGpuGroup = None
+        self._haveWatchedHealth = False
+
+    ###########################################################################
+    def Connect(self):
+        if self._dcgmHandle is not None:
+            return
+
+        self._dcgmHandle = DcgmHandle.DcgmHandle(handle=None, ipAddress=self._ipAddress)
+        self.dcgmSystem = self._dcgmHandle.GetSystem()
+        self.defaultGpuGroup = self.dcgmSystem.GetDefaultGroup()
+        self._haveWatchedHealth = False
+
+    ###########################################################################
+    def Disconnect(self):
+        if self._dcgmHandle is not None:
+            self._dcgmHandle.Shutdown()
+        self._dcgmHandle = None
+        self.dcgmSystem = None
+        self.defaultGpuGroup = None
+
+    ###########################################################################
+    def WatchHealth(self):
+        '''
+        Health watches belong to the connection, so every connection sets its own
+        '''
+        if self._haveWatchedHealth:
+            return
+
+        self.defaultGpuGroup.health.Set(dcgm_structs.DCGM_HEALTH_WATCH_ALL)
+        #Make sure the health has updated at least once
+        self.dcgmSystem.UpdateAllFields(1)
+        self._haveWatchedHealth = True
+
+###############################################################################
+class DcgmConnectionPool:
+    '''
+    A fixed number of host engine connections shared by worker threads.
+
+    Connections are opened the first time they're used and reopened once if
+    the host engine drops them.
+    '''
+    def __init__(self, ipAddress, size):
+        self._connections = queue.Queue()
+        for _ in range(size):
+            self._connections.put(DcgmPooledConnection(ipAddress))
+
+    ###########################################################################
+    def Call(self, fn):
+        '''
+        Call fn(connection) on a pooled connection and return what it returns.
+        Blocks until a connection is free. Call from a worker thread
+        '''
+        connection = self._connections.get()
+        try:
+            for attempt in range(2):
+                try:
+                    connection.Connect()
+                    return fn(connection)
+                except dcgmExceptionClass(dcgm_structs.DCGM_ST_CONNECTION_NOT_VALID):
+                    connection.Disconnect()
+                    if attempt == 1:
+                        raise DcgmRestError(DCGM_HTTP_CODE_UNAVAILABLE, "Unable to connect to the DCGM daemon")
+        finally:
+            self._connections.put(connection)
+
+    ###########################################################################
+    def Close(self):
+        while not self._connections.empty():
+            self._connections.get().Disconnect()
+
+###############################################################################
+class DcgmResponseCoalescer:
+    '''
+    Serves identical concurrent queries from one call.
+
+    While a call for a key is running, other requests for the key wait for
+    it. Its response is then reused until it's ttl seconds old. Errors are
+    never reused.
+    '''
+    def __init__(self, ttl):
+        self._ttl = ttl
+        self._inFlight = {} #key -> asyncio.Future of the response
+        self._cache = {} #key -> (time of the response, response)
+
+    ###########################################################################
+    async def Get(self, key, call):
+        '''
+        Return the response for key, awaiting call() if there's none to reuse
+        '''
+        now = time.monotonic()
+        cached = self._cache.get(key)
+        if cached is not None and now - cached[0] < self._ttl:
+            return cached[1]
+
+        future = self._inFlight.get(key)
+        if future is None:
+            future = asyncio.ensure_future(call())
+            self._inFlight[key] = future
+            future.add_done_callback(lambda f: self._OnDone(key, f))
+
+        #Shielded so that a client going away doesn't cancel the call for the others
+        return await asyncio.shield(future)
+
+    ###########################################################################
+    def _OnDone(self, key, future):
+        del self._inFlight[key]
+        if not future.cancelled() and future.exception() is None:
+            self._cache[key] = (time.monotonic(), future.result())
+
+        #Drop expired responses so that the cache stays as small as the set of recent queries
+        now = time.monotonic()
+        for expiredKey in [k for k, v in self._cache.items() if now - v[0] >= self._ttl]:
+            del self._cache[expiredKey]
+
+###############################################################################
+class DcgmDiagJob:
+    def __init__(self, jobId, validationLevel):
+        self.jobId = jobId
+        self.validationLevel = validationLevel
+        self.state = 'running' #running, done or error
+        self.startTime = time.time()
+        self.endTime = None
+        self.response = None #Diag response once done
+        self.task = None
+        self.errorString = None #Set once the job fails
+
+    ###########################################################################
+    def ToDict(self):
+        retVal = {'jobId':self.jobId,
+                  'state':self.state,
+                  'level':self.validationLevel,
+                  'startTime':self.startTime,
+                  'endTime':self.endTime}
+        if self.response is not None:
+            retVal['diagResponse'] = self.response
+        if self.errorString is not None:
+            retVal['errorString'] = self.errorString
+        return retVal
+
+###############################################################################
+class DcgmRestGateway:
+    ###########################################################################
+    def __init__(self, ipAddress, poolSize, cacheTtl):
+        self._queryPool = DcgmConnectionPool(ipAddress, poolSize)
+        self._queryExecutor = concurrent.futures.ThreadPoolExecutor(max_workers=poolSize,
+                                                                    thread_name_prefix='dcgm_query')
+        #The host engine runs one diagnostic at a time, so one connection and thread is enough
+        self._diagPool = DcgmConnectionPool(ipAddress, 1)
+        self._diagExecutor = concurrent.futures.ThreadPoolExecutor(max_workers=1, thread_name_prefix='dcgm_diag')
+        self._coalescer = DcgmResponseCoalescer(cacheTtl)
+        self._jobs = {} #jobId -> DcgmDiagJob
+        self._nextJobId = itertools.count(1)
+
+    ###########################################################################
+    async def _Query(self, fn):
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(self._queryExecutor, self._queryPool.Call, fn)
+
+    ###########################################################################
+    async def GetAllGpuIds(self, queryParams):
+        getGpuIds = lambda c: GetJsonResponse(c.dcgmSystem.discovery.GetAllGpuIds())
+        return DCGM_HTTP_CODE_OK, await self._coalescer.Get(('getallgpuids',), lambda: self._Query(getGpuIds))
+
+    ###########################################################################
+    async def GetGpuAttributes(self, queryParams):
+        if 'gpuid' not in queryParams:
+            raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "Missing 'gpuid' parameter")
+
+        try:
+            gpuId = int(queryParams['gpuid'][0])
+        except ValueError:
+            raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "gpuid parameter is invalid")
+
+        def GetAttributes(connection):
+            if gpuId not in connection.dcgmSystem.discovery.GetAllGpuIds():
+                raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "gpuid parameter is invalid")
+            #Encode on the worker thread so that the response is plain JSON by the time it's shared
+            return GetJsonResponse(connection.dcgmSystem.discovery.GetGpuAttributes(gpuId))
+
+        return DCGM_HTTP_CODE_OK, await self._coalescer.Get(('getgpuattributes', gpuId),
+                                                           lambda: self._Query(GetAttributes))
+
+    ###########################################################################
+    async def CheckGpuHealth(self, queryParams):
+        def CheckHealth(connection):
+            connection.WatchHealth()
+            return GetJsonResponse(connection.defaultGpuGroup.health.Check())
+
+        return DCGM_HTTP_CODE_OK, await self._coalescer.Get(('checkgpuhealth',), lambda: self._Query(CheckHealth))
+
+    ###########################################################################
+    async def RunDiagnostic(self, queryParams):
+        validationLevel = 1
+
+        if 'level' in queryParams:
+            try:
+                validationLevel = int(queryParams['level'][0])
+            except ValueError:
+                validationLevel = 0
+            if validationLevel < dcgm_structs.DCGM_POLICY_VALID_SV_SHORT or \
+               validationLevel > dcgm_structs.DCGM_POLICY_VALID_SV_XLONG:
+                raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "\"level\" parameter must be between 1 and 4")
+
+        self._ExpireJobs()
+
+        job = DcgmDiagJob(next(self._nextJobId), validationLevel)
+        self._jobs[job.jobId] = job
+        job.task = asyncio.ensure_future(self._RunDiagJob(job))
+
+        return DCGM_HTTP_CODE_ACCEPTED, GetJsonResponse(job.ToDict())
+
+    ###########################################################################
+    async def _RunDiagJob(self, job):
+        loop = asyncio.get_running_loop()
+        validate = lambda c: c.defaultGpuGroup.action.Validate(job.validationLevel)
+        try:
+            job.response = await loop.run_in_executor(self._diagExecutor, self._diagPool.Call, validate)
+            job.state = 'done'
+        except dcgmExceptionClass(dcgm_structs.DCGM_ST_NOT_SUPPORTED):
+            job.state = 'error'
+            job.errorString = "The DCGM diagnostic program is not installed. Please install the Tesla-recommended driver."
+        except DcgmRestError as e:
+            job.state = 'error'
+            job.errorString = e.errorString
+        except dcgm_structs.DCGMError as e:
+            job.state = 'error'
+            job.errorString = str(e)
+        job.endTime = time.time()
+        job.task = None
+
+    ###########################################################################
+    async def GetJob(self, queryParams):
+        if 'jobid' not in queryParams:
+            raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "Missing 'jobid' parameter")
+
+        try:
+            job = self._jobs.get(int(queryParams['jobid'][0]))
+        except ValueError:
+            job = None
+        if job is None:
+            raise DcgmRestError(DCGM_HTTP_CODE_NOT_FOUND, "Unknown jobid")
+
+        return DCGM_HTTP_CODE_OK, GetJsonResponse(job.ToDict())
+
+    ###########################################################################
+    def _ExpireJobs(self):
+        now = time.time()
+        for jobId in [j.jobId for j in self._jobs.values() if j.endTime is not None and now - j.endTime > DCGM_REST_JOB_TTL]:
+            del self._jobs[jobId]
+
+    ###########################################################################
+    async def GetJsonRestContents(self, queryParams):
+        if 'action' not in queryParams:
+            raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "Missing 'action' parameter")
+
+        action = queryParams['action'][0].lower()
+
+        if action == 'getallgpuids':
+            return await self.GetAllGpuIds(queryParams)
+        elif action == 'getgpuattributes':
+            return await self.GetGpuAttributes(queryParams)
+        elif action == 'checkgpuhealth':
+            return await self.CheckGpuHealth(queryParams)
+        elif action == 'rundiagnostic':
+            return await self.RunDiagnostic(queryParams)
+        elif action == 'getjob':
+            return await self.GetJob(queryParams)
+        else:
+            raise DcgmRestError(DCGM_HTTP_CODE_BAD_REQUEST, "Unknown action: %s" % action)
+
+    ###########################################################################
+    async def HandleRequest(self, method, target):
+        '''
+        Returns (HTTP code, JSON body) for a request
+        '''
+        if method != 'GET':
+            return DCGM_HTTP_CODE_METHOD, GetJsonError("Only GET is supported")
+
+        url = urllib.parse.urlsplit(target)
+        if url.path.strip('/').split('/')[0] != DCGM_REST_JSON_DIR:
+            return DCGM_HTTP_CODE_NOT_FOUND, GetJsonError("%s not found" % url.path)
+
+        try:
+            return await self.GetJsonRestContents(urllib.parse.parse_qs(url.query))
+        except DcgmRestError as e:
+            return e.httpCode, GetJsonError(e.errorString)
+        except dcgm_structs.DCGMError as e:
+            return DCGM_HTTP_CODE_INT_ERROR, GetJsonError(str(e))
+
+    ###########################################################################
+    async def HandleConnection(self, reader, writer):
+        try:
+            request = await asyncio.wait_for(reader.readuntil(b'\r\n\r\n'), DCGM_REST_REQUEST_TIMEOUT)
+            requestLine = request.split(b'\r\n', 1)[0].decode('latin-1').split(' ')
+            if len(requestLine) != 3:
+                httpCode, body = DCGM_HTTP_CODE_BAD_REQUEST, GetJsonError("Malformed request")
+            else:
+                httpCode, body = await self.HandleRequest(requestLine[0], requestLine[1])
+
+            body = body.encode('utf-8')
+            header = "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %d\r\n" \
+                     "Connection: close\r\n\r\n" % (httpCode, DCGM_HTTP_REASONS[httpCode], len(body))
+            writer.write(header.encode('latin-1') + body)
+            await writer.drain()
+        except (asyncio.TimeoutError, asyncio.IncompleteReadError, asyncio.LimitOverrunError, ConnectionError):
+            pass
+        finally:
+            writer.close()
+
+    ###########################################################################
+    def Close(self):
+        self._queryExecutor.shutdown(wait=True)
+        self._diagExecutor.shutdown(wait=False, cancel_futures=True)
+        self._queryPool.Close()
+
+###############################################################################
+async def ServeForever(gateway, bindAddress, port):
+    server = await asyncio.start_server(gateway.HandleConnection, bindAddress, port,
+                                        limit=DCGM_REST_MAX_REQUEST_SIZE)
+    print("Serving DCGM REST requests on %s:%d..." % (bindAddress or '*', port))
+    async with server:
+        await server.serve_forever()
+
+###############################################################################
+def main():
+    parser = argparse.ArgumentParser(description='Asynchronous REST gateway to DCGM')
+    parser.add_argument('--port', type=int, default=DCGM_REST_PORT, help='Port to serve requests on')
+    parser.add_argument('--bind', default='127.0.0.1', help='Address to serve requests on. "" = all interfaces')
+    parser.add_argument('--hostengine', default=DCGM_IP_ADDRESS, help='Host engine address to connect to')
+    parser.add_argument('--pool-size', type=int, default=DCGM_REST_POOL_SIZE,
+                        help='Host engine connections shared by queries')
+    parser.add_argument('--cache-ttl', type=float, default=DCGM_REST_CACHE_TTL,
+                        help='Seconds a query response is reused for')
+    args = parser.parse_args()
+
+    if args.pool_size < 1:
+        parser.error('--pool-size must be at least 1')
+
+    dcgm_structs._dcgmInit()
+    gateway = DcgmRestGateway(args.hostengine, args.pool_size, args.cache_ttl)
+    try:
+        asyncio.run(ServeForever(gateway, args.bind or None, args.port))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        gateway.Close()
+
+if __name__ == '__main__':
+    main()
@@ -21,3 +21,6 @@ PYTHONPATH=/usr/local/dcgm/bindings  /usr/local/bin/uwsgi --enable-threads --soc
 
 #Start using the HTTP protocol
 #PYTHONPATH=/usr/local/dcgm/bindings  /usr/local/bin/uwsgi --enable-threads --http :1980 --wsgi-file /usr/share/dcgm_wsgi/dcgm_wsgi.py --logger syslog:dcgm_wsgi --daemonize2
+
+#Or start the asynchronous REST gateway instead. Use the proxy_pass location in dcgm_wsgi_nginx.conf with it
+#PYTHONPATH=/usr/local/dcgm/bindings python3 /usr/share/dcgm_wsgi/dcgm_rest_gateway.py --port 1980 &
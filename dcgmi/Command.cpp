@@ -21,11 +21,62 @@
 #include "dcgm_agent.h"
 #include "dcgm_structs.h"
 #include "dcgmi_common.h"
+
+#include <DcgmStringHelpers.h>
+
+#include <fmt/format.h>
+#include <json/json.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string.h>
 
+namespace
+{
+/* A host of a multi-host command, run in a child process whose stdout and stderr go to a pipe */
+struct HostRun
+{
+    std::string host;
+    pid_t pid = -1;
+    int outFd = -1;
+    std::string output; /* Everything read so far in JSON mode, otherwise the unfinished line */
+    dcgmReturn_t result = DCGM_ST_OK;
+};
+
+unsigned int GetMaxParallelHosts()
+{
+    char const *value = std::getenv(DCGMI_MAX_PARALLEL_HOSTS_ENV);
+    if (value != nullptr)
+    {
+        int maxParallel = atoi(value);
+        if (maxParallel > 0)
+        {
+            return maxParallel;
+        }
+    }
+    return DCGMI_DEFAULT_PARALLEL_HOSTS;
+}
+
+/* Print each complete line in output prefixed with host and keep the rest */
+void PrintHostLines(std::string const &host, size_t hostWidth, std::string &output)
+{
+    size_t start = 0;
+    for (size_t end = output.find('\n'); end != std::string::npos; end = output.find('\n', start))
+    {
+        fmt::print("{:<{}} | {}\n", host, hostWidth, std::string_view(output).substr(start, end - start));
+        start = end + 1;
+    }
+    output.erase(0, start);
+}
+} // namespace
+
 /*****************************************************************************/
 Command::Command() = default;
 
@@ -91,6 +142,20 @@ dcgmReturn_t Command::Connect(void)
 /*****************************************************************************/
 dcgmReturn_t Command::Execute()
 {
+    if (m_hostName.find(',') != std::string::npos)
+    {
+        std::vector<std::string> hosts;
+        for (auto const &host : DcgmNs::Split(m_hostName, ','))
+        {
+            if (!host.empty())
+            {
+                hosts.emplace_back(host);
+            }
+        }
+
+        return ExecuteOnHosts(hosts, GetMaxParallelHosts());
+    }
+
     dcgmReturn_t const result = Connect();
     if (DCGM_ST_OK != result)
     {
@@ -100,6 +165,164 @@ dcgmReturn_t Command::Execute()
     return DoExecuteConnected();
 }
 
+/*****************************************************************************/
+dcgmReturn_t Command::ExecuteOnHosts(std::vector<std::string> const &hosts, unsigned int maxParallel)
+{
+    std::vector<HostRun> runs(hosts.size());
+    size_t hostWidth = 0;
+    for (size_t i = 0; i < hosts.size(); i++)
+    {
+        runs[i].host = hosts[i];
+        hostWidth    = std::max(hostWidth, hosts[i].size());
+    }
+
+    /* Nothing buffered may be written twice by the children */
+    std::cout.flush();
+    fflush(stdout);
+
+    size_t nextRun = 0;
+    std::vector<HostRun *> active;
+
+    while (nextRun < runs.size() || !active.empty())
+    {
+        while (nextRun < runs.size() && active.size() < maxParallel)
+        {
+            HostRun &run = runs[nextRun++];
+            int fds[2];
+
+            if (pipe(fds) != 0)
+            {
+                SHOW_AND_LOG_ERROR << fmt::format("Unable to run on {}: {}", run.host, strerror(errno));
+                run.result = DCGM_ST_GENERIC_ERROR;
+                continue;
+            }
+
+            run.pid = fork();
+            if (run.pid == 0)
+            {
+                /* Child: run the command on this host alone. DCGM isn't initialized until Connect() */
+                close(fds[0]);
+                dup2(fds[1], STDOUT_FILENO);
+                dup2(fds[1], STDERR_FILENO);
+                close(fds[1]);
+
+                m_hostName                = run.host;
+                dcgmReturn_t const result = Execute();
+                std::cout.flush();
+                fflush(stdout);
+                /* dcgmReturn_t values are negative and small enough for an exit status */
+                _exit(-result);
+            }
+
+            close(fds[1]);
+            if (run.pid < 0)
+            {
+                close(fds[0]);
+                SHOW_AND_LOG_ERROR << fmt::format("Unable to run on {}: {}", run.host, strerror(errno));
+                run.result = DCGM_ST_GENERIC_ERROR;
+                continue;
+            }
+
+            run.outFd = fds[0];
+            active.push_back(&run);
+        }
+
+        if (active.empty())
+        {
+            continue;
+        }
+
+        std::vector<pollfd> pollFds(active.size());
+        for (size_t i = 0; i < active.size(); i++)
+        {
+            pollFds[i] = { .fd = active[i]->outFd, .events = POLLIN, .revents = 0 };
+        }
+
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            SHOW_AND_LOG_ERROR << fmt::format("Unable to read the output of hosts: {}", strerror(errno));
+            break;
+        }
+
+        for (size_t i = 0; i < active.size(); i++)
+        {
+            if (pollFds[i].revents == 0)
+            {
+                continue;
+            }
+
+            HostRun &run = *active[i];
+            char buffer[4096];
+            ssize_t const bytes = read(run.outFd, buffer, sizeof(buffer));
+
+            if (bytes > 0)
+            {
+                run.output.append(buffer, bytes);
+                if (!m_json)
+                {
+                    PrintHostLines(run.host, hostWidth, run.output);
+                }
+                continue;
+            }
+            if (bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            /* The host is done */
+            close(run.outFd);
+            run.outFd  = -1;
+            int status = 0;
+            waitpid(run.pid, &status, 0);
+            run.result = WIFEXITED(status) ? static_cast<dcgmReturn_t>(-WEXITSTATUS(status)) : DCGM_ST_GENERIC_ERROR;
+
+            if (!m_json && !run.output.empty())
+            {
+                run.output += '\n';
+                PrintHostLines(run.host, hostWidth, run.output);
+            }
+        }
+
+        std::erase_if(active, [](HostRun const *run) { return run->outFd < 0; });
+        fflush(stdout);
+    }
+
+    if (m_json)
+    {
+        Json::Value merged(Json::objectValue);
+        Json::CharReaderBuilder readerBuilder;
+        std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+
+        for (auto const &run : runs)
+        {
+            Json::Value hostValue;
+            std::string errors;
+            if (!reader->parse(run.output.data(), run.output.data() + run.output.size(), &hostValue, &errors))
+            {
+                /* Errors and other output that isn't JSON are kept as text */
+                hostValue           = Json::Value(Json::objectValue);
+                hostValue["output"] = run.output;
+            }
+            merged[run.host] = hostValue;
+        }
+        std::cout << merged.toStyledString();
+        std::cout.flush();
+    }
+
+    for (auto const &run : runs)
+    {
+        if (run.result != DCGM_ST_OK)
+        {
+            return run.result;
+        }
+    }
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************/
 void Command::SetPersistAfterDisconnect(unsigned int persistAfterDisconnect)
 {
@@ -23,7 +23,11 @@
 #include "dcgm_structs.h"
 
 #include <string>
+#include <vector>
 
+/* Environment variable bounding how many hosts a multi-host command runs on at once */
+#define DCGMI_MAX_PARALLEL_HOSTS_ENV "DCGMI_MAX_PARALLEL_HOSTS"
+#define DCGMI_DEFAULT_PARALLEL_HOSTS 16
 
 class Command
 {
@@ -46,6 +50,9 @@ public:
 
     /*****************************************************************************
      * Execute command on the Host Engine
+     *
+     * If the host name is a comma-separated list of hosts, the command runs on
+     * each of them in parallel. See ExecuteOnHosts()
      *****************************************************************************/
     dcgmReturn_t Execute();
 
@@ -59,6 +66,20 @@ protected:
 
     virtual dcgmReturn_t DoExecuteConnectionFailure(dcgmReturn_t connectionStatus);
 
+    /**
+     * Run the command on each of hosts, in a child process per host so that
+     * the commands' output and global state stay separate. At most
+     * maxParallel hosts run at once.
+     *
+     * Each line a host prints is prefixed with the host as it arrives. In
+     * JSON mode, the output of every host is collected into one JSON object
+     * keyed by host instead.
+     *
+     * @return DCGM_ST_OK if the command succeeded on every host, or the
+     *         first error of the hosts in the order they were given
+     */
+    dcgmReturn_t ExecuteOnHosts(std::vector<std::string> const &hosts, unsigned int maxParallel);
+
     std::string m_hostName;
     dcgmHandle_t m_dcgmHandle {};
     unsigned int m_timeout {};
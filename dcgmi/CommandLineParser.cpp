@@ -23,6 +23,7 @@
 #include "DcgmiTest.h"
 #include "DeviceMonitor.h"
 #include "Diag.h"
+#include "Export.h"
 #include "FieldGroup.h"
 #include "Group.h"
 #include "Health.h"
@@ -58,7 +59,7 @@
     throw TCLAP::CmdLineParseException("Positive value expected, negative value found", name)
 
 static const string g_hostnameHelpText
-    = "Connects to specified IP or fully-qualified domain name. To connect to a host engine that was started with -d (unix socket), prefix the unix socket filename with 'unix://'. [default = localhost]";
+    = "Connects to specified IP or fully-qualified domain name. To connect to a host engine that was started with -d (unix socket), prefix the unix socket filename with 'unix://'. A comma-separated list of hosts runs the command on all of them in parallel, prefixing each line of output with its host. The DCGMI_MAX_PARALLEL_HOSTS environment variable limits how many hosts run at once [default = 16]. [default = localhost]";
 
 static const std::string HW_SLOWDOWN("hw_slowdown");
 static const std::string SW_THERMAL("sw_thermal");
@@ -86,6 +87,7 @@ CommandLineParser::StaticConstructor::StaticConstructor()
     m_functionMap.insert(std::make_pair("introspect", &CommandLineParser::ProcessIntrospectCommandLine));
     m_functionMap.insert(std::make_pair("nvlink", &CommandLineParser::ProcessNvlinkCommandLine));
     m_functionMap.insert(std::make_pair("dmon", &CommandLineParser::ProcessDmonCommandLine));
+    m_functionMap.insert(std::make_pair("export", &CommandLineParser::ProcessExportCommandLine));
     m_functionMap.insert(std::make_pair("modules", &CommandLineParser::ProcessModuleCommandLine));
     m_functionMap.insert(std::make_pair("profile", &CommandLineParser::ProcessProfileCommandLine));
     m_functionMap.insert(std::make_pair("set", &CommandLineParser::ProcessSettingsCommandLine));
@@ -154,6 +156,8 @@ dcgmReturn_t CommandLineParser::ProcessCommandLine(int argc, char const *const *
             cmd);
         TCLAP::ValueArg<std::string> dmonArg(
             "", "dmon", "Stats Monitoring of GPUs [dcgmi dmon –h for more info]", false, "", "", cmd);
+        TCLAP::ValueArg<std::string> exportArg(
+            "", "export", "Export cached values to a file [dcgmi export –h for more info]", false, "", "", cmd);
         TCLAP::ValueArg<std::string> moduleArg("", "modules", "Control and list DCGM modules", false, "", "", cmd);
         TCLAP::ValueArg<std::string> profileArg(
             "", "profile", "Control and list DCGM profiling metrics", false, "", "", cmd);
@@ -2065,10 +2069,15 @@ dcgmReturn_t CommandLineParser::ProcessIntrospectCommandLine(int argc, char cons
                           "Show introspection info for the host engine.  "
                           "Must be accompanied by --hostengine.",
                           false);
+    TCLAP::SwitchArg fields("",
+                            "fields",
+                            "Show what each watched field costs the host engine, most expensive first.",
+                            false);
     TCLAP::ValueArg<std::string> hostAddress("", "host", g_hostnameHelpText, false, "localhost", "IP/FQDN");
 
     std::vector<TCLAP::Arg *> cmdXors;
     cmdXors.push_back(&show);
+    cmdXors.push_back(&fields);
 
     TCLAP::SwitchArg hostengineTarget(
         "H", "hostengine", "Specify the hostengine process as a target to retrieve introspection stats for.", false);
@@ -2084,6 +2093,9 @@ dcgmReturn_t CommandLineParser::ProcessIntrospectCommandLine(int argc, char cons
     helpOutput.addToGroup("summary", &show);
     helpOutput.addToGroup("summary", &hostengineTarget);
 
+    helpOutput.addToGroup("fields", &hostAddress);
+    helpOutput.addToGroup("fields", &fields);
+
     cmd.parse(argc, argv);
 
     if (show.isSet())
@@ -2096,6 +2108,10 @@ dcgmReturn_t CommandLineParser::ProcessIntrospectCommandLine(int argc, char cons
 
         result = DisplayIntrospectSummary(hostAddress.getValue(), hostengineTarget.getValue()).Execute();
     }
+    else if (fields.isSet())
+    {
+        result = DisplayIntrospectFieldCosts(hostAddress.getValue()).Execute();
+    }
 
     return result;
 }
@@ -2204,6 +2220,21 @@ dcgmReturn_t CommandLineParser::ProcessDmonCommandLine(int argc, char const *con
                                0,
                                "count");
     TCLAP::SwitchArg list("l", "list", "List to look up the long names, short names and field ids.", false);
+    TCLAP::ValueArg<std::string> output("o",
+                                        "output",
+                                        " Record every value to this file instead of printing the table. "
+                                        "Use - for stdout.",
+                                        false,
+                                        "",
+                                        "path",
+                                        cmd);
+    TCLAP::ValueArg<std::string> format(
+        "", "format", " Format of --output: csv or binary. [default = csv]", false, "csv", "format", cmd);
+    TCLAP::SwitchArg subscribe("",
+                               "subscribe",
+                               " With --output, have the host engine push each update instead of polling for them.",
+                               cmd,
+                               false);
 
     // Set help output information
     helpOutput.addDescription("dmon -- Used to monitor GPUs and their stats.");
@@ -2214,6 +2245,9 @@ dcgmReturn_t CommandLineParser::ProcessDmonCommandLine(int argc, char const *con
     helpOutput.addToGroup("1", &delay);
     helpOutput.addToGroup("1", &count);
     helpOutput.addToGroup("1", &list);
+    helpOutput.addToGroup("1", &output);
+    helpOutput.addToGroup("1", &format);
+    helpOutput.addToGroup("1", &subscribe);
 
     std::vector<TCLAP::Arg *> xorsFields;
     xorsFields.push_back(&fieldGroupId);
@@ -2242,7 +2276,7 @@ dcgmReturn_t CommandLineParser::ProcessDmonCommandLine(int argc, char const *con
 
     if (list.isSet()
         && (groupId.isSet() || entityIds.isSet() || fieldId.isSet() || fieldGroupId.isSet() || delay.isSet()
-            || count.isSet()))
+            || count.isSet() || output.isSet()))
     {
         throw TCLAP::CmdLineParseException("Invalid parameters with list arg. Usage : dmon -l");
     }
@@ -2272,6 +2306,25 @@ dcgmReturn_t CommandLineParser::ProcessDmonCommandLine(int argc, char const *con
         throw TCLAP::CmdLineParseException("Invalid value", "field-id");
     }
 
+    DmonRecordOptions recordOptions;
+    if ((format.isSet() || subscribe.isSet()) && !output.isSet())
+    {
+        throw TCLAP::CmdLineParseException("--format and --subscribe require --output");
+    }
+    if (output.isSet())
+    {
+        if (output.getValue().empty())
+        {
+            throw TCLAP::CmdLineParseException("Invalid value", "output");
+        }
+        if (!DmonRecordWriter::ParseFormat(format.getValue(), recordOptions.format))
+        {
+            throw TCLAP::CmdLineParseException("Invalid value", "format");
+        }
+        recordOptions.path      = output.getValue();
+        recordOptions.subscribe = subscribe.getValue();
+    }
+
     return DeviceMonitor(hostAddress.getValue(),
                          entityIdsStr,
                          groupId.getValue(),
@@ -2279,7 +2332,92 @@ dcgmReturn_t CommandLineParser::ProcessDmonCommandLine(int argc, char const *con
                          fieldGroupId.getValue(),
                          std::chrono::milliseconds(delay.getValue()),
                          count.getValue(),
-                         false)
+                         false,
+                         std::move(recordOptions))
+        .Execute();
+}
+
+dcgmReturn_t CommandLineParser::ProcessExportCommandLine(int argc, char const *const *argv)
+{
+    static const std::string myName = "export";
+    DCGMOutput helpOutput;
+
+    DCGMSubsystemCmdLine cmd(myName, _DCGMI_FORMAL_NAME, ' ', std::string(DcgmNs::DcgmBuildInfo().GetVersion()));
+    cmd.setOutput(&helpOutput);
+
+    TCLAP::ValueArg<std::string> hostAddress("", "host", g_hostnameHelpText, false, "localhost", "IP/FQDN", cmd);
+    TCLAP::ValueArg<std::string> groupId("g",
+                                         "group-id",
+                                         " The group to export values of. all_gpus, all_nvswitches or a group ID. "
+                                         "[default = all_gpus]",
+                                         false,
+                                         "all_gpus",
+                                         "groupId",
+                                         cmd);
+    TCLAP::ValueArg<int> fieldGroupId(
+        "f", "field-group-id", " The field group to export values of.", false, 0, "fieldGroupId");
+    TCLAP::ValueArg<std::string> fieldId(
+        "e", "field-id", " Comma-separated list of field identifiers to export values of.", false, "", "fieldId");
+    TCLAP::ValueArg<long long> startTime("",
+                                         "start",
+                                         " Export values at or after this time in usec since 1970. "
+                                         "[default = the oldest cached value]",
+                                         false,
+                                         0,
+                                         "usec",
+                                         cmd);
+    TCLAP::ValueArg<long long> endTime("",
+                                       "end",
+                                       " Export values at or before this time in usec since 1970. [default = now]",
+                                       false,
+                                       0,
+                                       "usec",
+                                       cmd);
+    TCLAP::ValueArg<std::string> output("o",
+                                        "output",
+                                        " Arrow IPC (Feather V2) file to write. Replaced if it exists.",
+                                        true,
+                                        "",
+                                        "path",
+                                        cmd);
+
+    // Set help output information
+    helpOutput.addDescription("export -- Used to export cached values to a file for offline analysis.");
+    helpOutput.addToGroup("1", &groupId);
+    helpOutput.addToGroup("1", &fieldGroupId);
+    helpOutput.addToGroup("1", &fieldId);
+    helpOutput.addToGroup("1", &startTime);
+    helpOutput.addToGroup("1", &endTime);
+    helpOutput.addToGroup("1", &output);
+    helpOutput.addToGroup("1", &hostAddress);
+
+    cmd.xorAdd(fieldGroupId, fieldId);
+
+    cmd.parse(argc, argv);
+
+    CHECK_TCLAP_ARG_NEGATIVE_VALUE(fieldGroupId, "field-group-id");
+    CHECK_TCLAP_ARG_NEGATIVE_VALUE(startTime, "start");
+    CHECK_TCLAP_ARG_NEGATIVE_VALUE(endTime, "end");
+    if (fieldGroupId.isSet() && fieldGroupId.getValue() == 0)
+    {
+        throw TCLAP::CmdLineParseException("Invalid value", "field-group-id");
+    }
+    if (endTime.isSet() && endTime.getValue() < startTime.getValue())
+    {
+        throw TCLAP::CmdLineParseException("--end must not be before --start");
+    }
+    if (output.getValue().empty())
+    {
+        throw TCLAP::CmdLineParseException("Invalid value", "output");
+    }
+
+    return ExportValues(hostAddress.getValue(),
+                        groupId.getValue(),
+                        fieldId.getValue(),
+                        fieldGroupId.getValue(),
+                        startTime.getValue(),
+                        endTime.getValue(),
+                        output.getValue())
         .Execute();
 }
 
@@ -55,6 +55,7 @@ private:
     static dcgmReturn_t ProcessIntrospectCommandLine(int argc, char const *const *argv);
     static dcgmReturn_t ProcessNvlinkCommandLine(int argc, char const *const *argv);
     static dcgmReturn_t ProcessDmonCommandLine(int argc, char const *const *argv);
+    static dcgmReturn_t ProcessExportCommandLine(int argc, char const *const *argv);
     static dcgmReturn_t ProcessModuleCommandLine(int argc, char const *const *argv);
     static dcgmReturn_t ProcessProfileCommandLine(int argc, char const *const *argv);
     static dcgmReturn_t ProcessSettingsCommandLine(int argc, char const *const *argv);
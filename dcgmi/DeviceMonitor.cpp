@@ -25,6 +25,8 @@
 #include <DcgmUtilities.h>
 #include <EntityListHelpers.h>
 
+#include <cerrno>
+#include <cstring>
 #include <memory>
 #include <thread>
 #include <type_traits>
@@ -37,6 +39,7 @@
 #define MAX_KEEP_AGE           0.0 /*!< Enforce quota via MAX_KEEP_SAMPLES */
 #define DEFAULT_COUNT          0 /*!< Magic number. Default value for the number of iterations that means run forever */
 #define PADDING                2U
+#define RECORD_KEEP_AGE        30.0 /*!< Seconds of samples kept while recording, so a late poll misses none */
 
 static const char cNA[] = "N/A";
 
@@ -110,7 +113,8 @@ DeviceMonitor::DeviceMonitor(std::string hostname,
                              int fieldGroupId,
                              std::chrono::milliseconds updateDelay,
                              int numOfIterations,
-                             bool listOptionMentioned)
+                             bool listOptionMentioned,
+                             DmonRecordOptions recordOptions)
     : m_requestedEntityIds(std::move(requestedEntityIds))
     , m_groupIdStr(std::move(grpIdStr))
     , m_fieldIdsStr(std::move(fldIds))
@@ -120,6 +124,7 @@ DeviceMonitor::DeviceMonitor(std::string hostname,
     , m_myGroupId(0)
     , m_fieldGroupId(0)
     , m_list(listOptionMentioned)
+    , m_recordOptions(std::move(recordOptions))
     , m_widthArray()
 {
     gDeviceMonitorShouldStop = false;
@@ -380,6 +385,32 @@ static int ListFieldValues(dcgm_field_entity_group_t entityGroupId,
     return 0;
 }
 
+/**
+ * Show why watching the fields failed
+ *
+ * @param[in] result    Return of dcgmWatchFields or dcgmFieldValueSubscribe
+ */
+static void ShowWatchError(dcgmReturn_t result)
+{
+    const char *e = errorString(result);
+
+    switch (result)
+    {
+        case DCGM_ST_REQUIRES_ROOT:
+            e = "Unable to watch one or more of the requested fields because doing so requires the host engine to be running as root.";
+            break;
+
+        case DCGM_ST_INSUFFICIENT_DRIVER_VERSION:
+            e = "Unable to watch one or more of the requested fields because doing so requires a newer driver version than what is currently installed.";
+            break;
+
+        default:
+            break; /* Intentional fall-through. e is initialized before this switch statement */
+    }
+
+    SHOW_AND_LOG_ERROR << fmt::format("Error setting watches. Result: {}: {}\n", result, e);
+}
+
 template <typename T>
 void PrintMetricsRow(dcgmi_entity_pair_t const &entity,
                      std::vector<EntityStatItem> const &values,
@@ -598,23 +629,7 @@ dcgmReturn_t DeviceMonitor::LockWatchAndUpdate()
     // Check result to see if DCGM operation was successful.
     if (result != DCGM_ST_OK)
     {
-        const char *e = errorString(result);
-
-        switch (result)
-        {
-            case DCGM_ST_REQUIRES_ROOT:
-                e = "Unable to watch one or more of the requested fields because doing so requires the host engine to be running as root.";
-                break;
-
-            case DCGM_ST_INSUFFICIENT_DRIVER_VERSION:
-                e = "Unable to watch one or more of the requested fields because doing so requires a newer driver version than what is currently installed.";
-                break;
-
-            default:
-                break; /* Intentional fall-through. e is initialized before this switch statement */
-        }
-
-        SHOW_AND_LOG_ERROR << fmt::format("Error setting watches. Result: {}: {}\n", result, e);
+        ShowWatchError(result);
         return result;
     }
 
@@ -717,6 +732,109 @@ dcgmReturn_t DeviceMonitor::LockWatchAndUpdate()
     return result;
 }
 
+dcgmReturn_t DeviceMonitor::RecordValues()
+{
+    std::unique_ptr<FILE, decltype(&fclose)> file(nullptr, &fclose);
+    FILE *out = stdout;
+
+    if (m_recordOptions.path != "-")
+    {
+        file.reset(fopen(m_recordOptions.path.c_str(), "wb"));
+        if (file == nullptr)
+        {
+            SHOW_AND_LOG_ERROR << fmt::format("Unable to open {}: {}", m_recordOptions.path, strerror(errno));
+            return DCGM_ST_BADPARAM;
+        }
+        out = file.get();
+    }
+
+    DmonRecordWriter writer(out, m_recordOptions.format);
+    writer.WriteHeader();
+
+    /* Install a signal handler to catch ctrl-c */
+    signal(SIGINT, &killHandler);
+
+    long long const updateFreq = std::chrono::duration_cast<std::chrono::microseconds>(m_delay).count();
+    dcgmReturn_t result        = DCGM_ST_OK;
+
+    if (m_recordOptions.subscribe)
+    {
+        result = dcgmFieldValueSubscribe(m_dcgmHandle,
+                                         m_myGroupId,
+                                         m_fieldGroupId,
+                                         updateFreq,
+                                         RECORD_KEEP_AGE,
+                                         0,
+                                         &DmonRecordWriter::EnumCallback,
+                                         &writer);
+    }
+    else
+    {
+        result = dcgmWatchFields(m_dcgmHandle, m_myGroupId, m_fieldGroupId, updateFreq, RECORD_KEEP_AGE, 0);
+    }
+
+    if (result != DCGM_ST_OK)
+    {
+        ShowWatchError(result);
+        return result;
+    }
+
+    dcgmUpdateAllFields(m_dcgmHandle, 1);
+
+    /* Poll on a fixed schedule rather than sleeping m_delay after each poll, so the polls don't drift */
+    long long sinceTimestamp = 0;
+    int iterations           = 0;
+    auto nextPoll            = std::chrono::steady_clock::now();
+
+    while (!gDeviceMonitorShouldStop.load(std::memory_order_relaxed))
+    {
+        if (!m_recordOptions.subscribe)
+        {
+            result = dcgmGetValuesSince_v2(m_dcgmHandle,
+                                           m_myGroupId,
+                                           m_fieldGroupId,
+                                           sinceTimestamp,
+                                           &sinceTimestamp,
+                                           &DmonRecordWriter::EnumCallback,
+                                           &writer);
+            if (result != DCGM_ST_OK)
+            {
+                SHOW_AND_LOG_ERROR << fmt::format(
+                    "Error getting values information. Return {}: {}", result, errorString(result));
+                break;
+            }
+        }
+
+        if (!writer.Flush())
+        {
+            SHOW_AND_LOG_ERROR << fmt::format("Unable to write to {}", m_recordOptions.path);
+            result = DCGM_ST_GENERIC_ERROR;
+            break;
+        }
+
+        iterations++;
+        if (m_count != DEFAULT_COUNT && iterations >= m_count)
+        {
+            break;
+        }
+
+        nextPoll += m_delay;
+        std::this_thread::sleep_until(nextPoll);
+    }
+
+    if (m_recordOptions.subscribe)
+    {
+        /* No more callbacks touch the writer once this returns */
+        dcgmFieldValueUnsubscribe(m_dcgmHandle, m_myGroupId, m_fieldGroupId);
+    }
+
+    writer.Flush();
+
+    /* stdout may be the recording, so report on stderr */
+    fmt::print(stderr, "dmon recorded {} values\n", writer.GetValueCount());
+    return result;
+}
+
 /**
  * printHeaderForOutput - Directs the header to Console output stream.
  */
@@ -931,6 +1049,11 @@ dcgmReturn_t DeviceMonitor::CreateFieldGroupAndGpuGroup()
         return dcgmReturn;
     }
 
+    if (!m_recordOptions.path.empty())
+    {
+        return RecordValues();
+    }
+
     PrintHeaderForOutput();
 
     dcgmReturn = LockWatchAndUpdate();
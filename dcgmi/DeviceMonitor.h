@@ -21,6 +21,7 @@
 #define DEVICEMONITOR_H_
 
 #include "Command.h"
+#include "DmonRecordWriter.h"
 #include "dcgm_agent.h"
 #include "dcgm_structs.h"
 #include "dcgmi_common.h"
@@ -81,6 +82,18 @@ struct EntityStatItem
     {}
 };
 
+/**
+ * Where and how dmon records field values instead of printing the table. See DmonRecordWriter
+ */
+struct DmonRecordOptions
+{
+    /** File to write records to. "-" is stdout. Empty prints the table instead */
+    std::string path;
+    DmonRecordWriter::Format format = DmonRecordWriter::Format::Csv;
+    /** Have the host engine push updates instead of polling with dcgmGetValuesSince_v2 */
+    bool subscribe = false;
+};
+
 class DeviceMonitor : public Command
 {
 public:
@@ -91,7 +104,8 @@ public:
                   int fieldGroupId,
                   std::chrono::milliseconds updateDelay,
                   int numOfIterations,
-                  bool listOptionMentioned);
+                  bool listOptionMentioned,
+                  DmonRecordOptions recordOptions = {});
 
     using EntityStats = std::unordered_map<dcgmi_entity_pair_t, std::vector<EntityStatItem>>;
 
@@ -123,6 +137,7 @@ private:
     dcgmGpuGrp_t m_myGroupId;          /*!< Gpu group id of the group created by dmon. */
     dcgmFieldGrp_t m_fieldGroupId;     /*!< Field group id of the fieldgroup created by the dmon.*/
     bool m_list;                       /*!< Boolean value that states if list option is mentioned in the command line.*/
+    DmonRecordOptions m_recordOptions; /*!< Set when recording values instead of printing the table */
     std::vector<FieldDetails> m_fieldDetails {}; /*!< Vector or the field details structure for each field. Populated
                                                     and used when list option is mentioned with command.  */
     std::string m_header;                        /*!< The header for formatting the output. */
@@ -168,6 +183,17 @@ private:
     dcgmReturn_t GetSortedEntities(dcgmGroupInfo_t &dcgmGroupInfo);
 
     dcgmReturn_t LockWatchAndUpdate();
+
+    /**
+     * RecordValues: write every value of the watched fields to m_recordOptions.path until the
+     * iteration count is reached or dmon is stopped.
+     *
+     * With subscribe, the host engine pushes each update cycle's values. Otherwise values are
+     * polled with dcgmGetValuesSince_v2, resuming from the previous poll so none are skipped.
+     *
+     * @return dcgmReturn_t: DCGM return code.
+     */
+    dcgmReturn_t RecordValues();
     void PrintHeaderForOutput() const;
     void SetHeaderForOutput(unsigned short fieldIds[], unsigned int numFields);
     void PopulateFieldDetails();
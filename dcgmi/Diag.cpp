@@ -150,42 +150,43 @@ void InstallSigHandlers()
     SET_NEW_HANDLER_AND_SAVE_OLD_HANDLER(SIGTERM, Term, handle_signal_during_diag);
 }
 
-std::optional<std::string> GetEudTestVersion(std::string_view testName, dcgmDiagResponse_v11 const &diagResponse)
+/* The aux data of test, if it has any */
+std::optional<Json::Value> GetTestAuxData(dcgmDiagTestRun_v1 const &test)
 {
-    dcgmDiagTestAuxData_v1 const *auxData = nullptr;
-
-    for (unsigned int idx = 0; idx < diagResponse.numTests; ++idx)
-    {
-        if (std::string_view(diagResponse.tests[idx].name) == testName)
-        {
-            auxData = &diagResponse.tests[idx].auxData;
-            break;
-        }
-    }
-
-    if (auxData == nullptr)
+    if (test.auxData.version != dcgmDiagTestAuxData_version || test.auxData.data[0] == '\0')
     {
         return std::nullopt;
     }
 
-    if (auxData->version != dcgmDiagTestAuxData_version || auxData->data[0] == '\0')
+    Json::Value json;
+    Json::Reader reader;
+
+    bool parsingSuccessful = reader.parse(test.auxData.data, json);
+    if (!parsingSuccessful || !json.isObject())
     {
         return std::nullopt;
     }
+    return json;
+}
 
-    Json::Value json;
-    Json::Reader reader;
+std::optional<std::string> GetEudTestVersion(std::string_view testName, dcgmDiagResponse_v11 const &diagResponse)
+{
+    std::optional<Json::Value> json;
 
-    bool parsingSuccessful = reader.parse(auxData->data, json);
-    if (!parsingSuccessful)
+    for (unsigned int idx = 0; idx < diagResponse.numTests; ++idx)
     {
-        return std::nullopt;
+        if (std::string_view(diagResponse.tests[idx].name) == testName)
+        {
+            json = GetTestAuxData(diagResponse.tests[idx]);
+            break;
+        }
     }
-    if (!json.isMember("version") || !json["version"].isString())
+
+    if (!json.has_value() || !json->isMember("version") || !(*json)["version"].isString())
     {
         return std::nullopt;
     }
-    return json["version"].asString();
+    return (*json)["version"].asString();
 }
 
 /* Equality test for two entity pairs. DCGM-4223: This is cloned from
@@ -1241,6 +1242,11 @@ void Diag::HelperJsonBuildOutput(Json::Value &output, dcgmDiagResponse_v11 const
                 }
             }
 
+            if (auto auxData = GetTestAuxData(test); auxData.has_value() && auxData->isMember(NVVS_PHASE_TIMINGS))
+            {
+                testEntry[NVVS_PHASE_TIMINGS] = (*auxData)[NVVS_PHASE_TIMINGS];
+            }
+
             if (!testEntry.empty())
             {
                 HelperJsonAddTest(categoryEntry, jsonTestIdx, testEntry);
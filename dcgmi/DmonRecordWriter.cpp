@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DmonRecordWriter.h"
+
+#include <DcgmLogging.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+DmonRecordWriter::DmonRecordWriter(FILE *out, Format format)
+    : m_out(out)
+    , m_format(format)
+{
+    /* Room for a full buffer plus the largest single record, so appending never reallocates */
+    m_buffer.reserve(c_flushSize + sizeof(DmonBinaryRecord) + DCGM_MAX_BLOB_LENGTH);
+}
+
+DmonRecordWriter::~DmonRecordWriter()
+{
+    Flush();
+}
+
+bool DmonRecordWriter::ParseFormat(std::string_view name, Format &format)
+{
+    if (name == "csv")
+    {
+        format = Format::Csv;
+        return true;
+    }
+    if (name == "binary")
+    {
+        format = Format::Binary;
+        return true;
+    }
+    return false;
+}
+
+void DmonRecordWriter::WriteHeader()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_format == Format::Csv)
+    {
+        fmt::format_to(std::back_inserter(m_buffer), "timestamp,entity_group,entity_id,field_id,status,value\n");
+        return;
+    }
+
+    DmonBinaryFileHeader header {};
+    memcpy(header.magic, DMON_BINARY_MAGIC, sizeof(header.magic));
+    header.version = DMON_BINARY_VERSION;
+    Append(&header, sizeof(header));
+}
+
+void DmonRecordWriter::Write(dcgm_field_entity_group_t entityGroupId,
+                             dcgm_field_eid_t entityId,
+                             dcgmFieldValue_v1 const *values,
+                             int numValues)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (int i = 0; i < numValues; i++)
+    {
+        if (m_format == Format::Csv)
+        {
+            WriteCsv(entityGroupId, entityId, values[i]);
+        }
+        else
+        {
+            WriteBinary(entityGroupId, entityId, values[i]);
+        }
+
+        if (m_buffer.size() >= c_flushSize)
+        {
+            FlushLocked();
+        }
+    }
+
+    m_valueCount += numValues;
+}
+
+bool DmonRecordWriter::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return FlushLocked();
+}
+
+bool DmonRecordWriter::FlushLocked()
+{
+    bool written = m_buffer.size() == 0 || fwrite(m_buffer.data(), 1, m_buffer.size(), m_out) == m_buffer.size();
+    m_buffer.clear();
+    written = fflush(m_out) == 0 && written;
+
+    if (!written && !m_failed)
+    {
+        /* Only log the first failure. A closed pipe fails every write after it */
+        log_error("Unable to write dmon records: {}", strerror(errno));
+        m_failed = true;
+    }
+    return !m_failed;
+}
+
+int DmonRecordWriter::EnumCallback(dcgm_field_entity_group_t entityGroupId,
+                                   dcgm_field_eid_t entityId,
+                                   dcgmFieldValue_v1 *values,
+                                   int numValues,
+                                   void *userData)
+{
+    static_cast<DmonRecordWriter *>(userData)->Write(entityGroupId, entityId, values, numValues);
+    return 0;
+}
+
+void DmonRecordWriter::WriteCsv(dcgm_field_entity_group_t entityGroupId,
+                                dcgm_field_eid_t entityId,
+                                dcgmFieldValue_v1 const &value)
+{
+    auto out = std::back_inserter(m_buffer);
+
+    fmt::format_to(out,
+                   "{},{},{},{},{},",
+                   value.ts,
+                   DcgmFieldsGetEntityGroupString(entityGroupId),
+                   entityId,
+                   value.fieldId,
+                   value.status);
+
+    if (value.status == DCGM_ST_OK)
+    {
+        switch (value.fieldType)
+        {
+            case DCGM_FT_DOUBLE:
+                fmt::format_to(out, "{}", value.value.dbl);
+                break;
+
+            case DCGM_FT_INT64:
+            case DCGM_FT_TIMESTAMP:
+                fmt::format_to(out, "{}", value.value.i64);
+                break;
+
+            case DCGM_FT_STRING:
+                /* Quoted so that commas in the string don't split the line */
+                fmt::format_to(out, "\"");
+                for (char const *c = value.value.str; *c != '\0' && c < value.value.str + DCGM_MAX_STR_LENGTH; c++)
+                {
+                    if (*c == '"')
+                    {
+                        fmt::format_to(out, "\"");
+                    }
+                    m_buffer.push_back(*c);
+                }
+                fmt::format_to(out, "\"");
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    m_buffer.push_back('\n');
+}
+
+void DmonRecordWriter::WriteBinary(dcgm_field_entity_group_t entityGroupId,
+                                   dcgm_field_eid_t entityId,
+                                   dcgmFieldValue_v1 const &value)
+{
+    DmonBinaryRecord record {};
+    record.timestamp     = value.ts;
+    record.entityId      = entityId;
+    record.fieldId       = value.fieldId;
+    record.entityGroupId = entityGroupId;
+    record.fieldType     = value.fieldType;
+    record.status        = value.status;
+
+    switch (value.fieldType)
+    {
+        case DCGM_FT_DOUBLE:
+        case DCGM_FT_INT64:
+        case DCGM_FT_TIMESTAMP:
+            record.length = sizeof(value.value.i64);
+            break;
+
+        case DCGM_FT_STRING:
+            record.length = strnlen(value.value.str, DCGM_MAX_STR_LENGTH);
+            break;
+
+        default:
+            break;
+    }
+
+    Append(&record, sizeof(record));
+    Append(&value.value, record.length);
+}
+
+void DmonRecordWriter::Append(void const *data, std::size_t length)
+{
+    auto const *bytes = static_cast<char const *>(data);
+    m_buffer.append(bytes, bytes + length);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_fields.h"
+#include "dcgm_structs.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+
+/**
+ * Record stream written by dcgmi dmon --output. Every field value received becomes one record, so nothing is
+ * dropped or merged the way the table output merges values into rows.
+ *
+ * CSV is one line per value:
+ *   timestamp,entity_group,entity_id,field_id,status,value
+ * where timestamp is in usec since 1970 and value is empty for blobs and for statuses other than DCGM_ST_OK.
+ *
+ * Binary starts with DmonBinaryFileHeader and is followed by records, in host byte order. Each record is a
+ * DmonBinaryRecord and then length bytes of value: 8 for DCGM_FT_INT64, DCGM_FT_TIMESTAMP and DCGM_FT_DOUBLE,
+ * the characters without the terminator for DCGM_FT_STRING and 0 for blobs.
+ */
+struct DmonBinaryFileHeader
+{
+    char magic[8];         /*!< DMON_BINARY_MAGIC */
+    std::uint32_t version; /*!< DMON_BINARY_VERSION */
+    std::uint32_t reserved;
+};
+
+struct DmonBinaryRecord
+{
+    std::int64_t timestamp;     /*!< usec since 1970 */
+    std::uint32_t entityId;     /*!< dcgm_field_eid_t */
+    std::uint16_t fieldId;      /*!< DCGM_FI_? */
+    std::uint8_t entityGroupId; /*!< dcgm_field_entity_group_t */
+    std::uint8_t fieldType;     /*!< DCGM_FT_? */
+    std::int32_t status;        /*!< dcgmReturn_t of the value */
+    std::uint32_t length;       /*!< Bytes of value following this record */
+};
+
+static_assert(sizeof(DmonBinaryRecord) == 24, "DmonBinaryRecord is part of the file format");
+
+inline constexpr char DMON_BINARY_MAGIC[8]         = { 'D', 'C', 'G', 'M', 'D', 'M', 'O', 'N' };
+inline constexpr std::uint32_t DMON_BINARY_VERSION = 1;
+
+class DmonRecordWriter
+{
+public:
+    enum class Format
+    {
+        Csv,
+        Binary,
+    };
+
+    /**
+     * @param out       Stream to write records to. Not closed by the writer
+     * @param format    Record format
+     */
+    DmonRecordWriter(FILE *out, Format format);
+    ~DmonRecordWriter();
+
+    DmonRecordWriter(DmonRecordWriter const &)            = delete;
+    DmonRecordWriter &operator=(DmonRecordWriter const &) = delete;
+
+    /**
+     * Parse "csv" or "binary".
+     *
+     * @return true if name is a format. format is set to it
+     */
+    static bool ParseFormat(std::string_view name, Format &format);
+
+    /**
+     * Write the CSV column names or the binary file header. Call once before any values
+     */
+    void WriteHeader();
+
+    /**
+     * Add the values of an entity. They are buffered and written once the buffer fills or on Flush().
+     * Write() and Flush() may be called from different threads
+     */
+    void Write(dcgm_field_entity_group_t entityGroupId,
+               dcgm_field_eid_t entityId,
+               dcgmFieldValue_v1 const *values,
+               int numValues);
+
+    /**
+     * Write out everything buffered so far.
+     *
+     * @return false if writing to the stream failed
+     */
+    bool Flush();
+
+    /**
+     * dcgmFieldValueEntityEnumeration_f that adds the values to the DmonRecordWriter in userData
+     */
+    static int EnumCallback(dcgm_field_entity_group_t entityGroupId,
+                            dcgm_field_eid_t entityId,
+                            dcgmFieldValue_v1 *values,
+                            int numValues,
+                            void *userData);
+
+    /**
+     * Number of values written since construction
+     */
+    std::uint64_t GetValueCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_valueCount;
+    }
+
+private:
+    static constexpr std::size_t c_flushSize = 64 * 1024; /*!< Buffered bytes that trigger a write */
+
+    std::mutex m_mutex; /*!< Guards everything below */
+    FILE *m_out;
+    Format m_format;
+    fmt::memory_buffer m_buffer;
+    std::uint64_t m_valueCount = 0;
+    bool m_failed              = false;
+
+    void WriteCsv(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId, dcgmFieldValue_v1 const &value);
+    void WriteBinary(dcgm_field_entity_group_t entityGroupId,
+                     dcgm_field_eid_t entityId,
+                     dcgmFieldValue_v1 const &value);
+    void Append(void const *data, std::size_t length);
+    bool FlushLocked();
+};
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * File:   Export.cpp
+ */
+#include "Export.h"
+
+#include "dcgmi_common.h"
+
+#include <DcgmStringHelpers.h>
+#include <dcgm_agent.h>
+#include <dcgm_structs.h>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+ExportValues::ExportValues(std::string hostname,
+                           std::string groupIdStr,
+                           std::string fieldIdsStr,
+                           unsigned int fieldGroupId,
+                           long long startTime,
+                           long long endTime,
+                           std::string filename)
+    : m_groupIdStr(std::move(groupIdStr))
+    , m_fieldIdsStr(std::move(fieldIdsStr))
+    , m_fieldGroupId(fieldGroupId)
+    , m_startTime(startTime)
+    , m_endTime(endTime)
+    , m_filename(std::move(filename))
+{
+    m_hostName = std::move(hostname);
+}
+
+/*****************************************************************************/
+dcgmReturn_t ExportValues::DoExecuteConnected()
+{
+    dcgmGroupType_t groupType = DCGM_GROUP_DEFAULT;
+    dcgmGpuGrp_t groupId      = 0;
+
+    if (!dcgmi_entity_group_id_is_special(m_groupIdStr, &groupType, &groupId))
+    {
+        int groupIdAsInt = atoi(m_groupIdStr.c_str());
+        if (!groupIdAsInt && (m_groupIdStr.empty() || m_groupIdStr.at(0) != '0'))
+        {
+            std::cout << "Error: Expected a numerical groupId. Instead got '" << m_groupIdStr << "'" << std::endl;
+            return DCGM_ST_BADPARAM;
+        }
+        groupId = (dcgmGpuGrp_t)(intptr_t)groupIdAsInt;
+    }
+
+    /* Export the fields given by ID through a field group that only lives as long as the export */
+    dcgmFieldGrp_t fieldGroupId = (dcgmFieldGrp_t)(intptr_t)m_fieldGroupId;
+    bool const ownFieldGroup    = m_fieldGroupId == 0;
+    if (ownFieldGroup)
+    {
+        std::vector<unsigned short> fieldIds;
+        dcgmReturn_t dcgmReturn = dcgmi_parse_field_id_list_string(m_fieldIdsStr, fieldIds, true);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+
+        dcgmReturn = dcgmi_create_field_group(m_dcgmHandle, &fieldGroupId, fieldIds);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+    }
+
+    dcgmExportValues_t exportValues {};
+    exportValues.version   = dcgmExportValues_version;
+    exportValues.format    = DCGM_EXPORT_FORMAT_ARROW_IPC;
+    exportValues.startTime = m_startTime;
+    exportValues.endTime   = m_endTime;
+    SafeCopyTo(exportValues.filename, m_filename.c_str());
+
+    dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+    if (m_filename.size() >= sizeof(exportValues.filename))
+    {
+        std::cout << "Error: The file name is longer than " << sizeof(exportValues.filename) - 1 << " characters."
+                  << std::endl;
+        dcgmReturn = DCGM_ST_BADPARAM;
+    }
+    else
+    {
+        dcgmReturn = dcgmExportValues(m_dcgmHandle, groupId, fieldGroupId, &exportValues);
+    }
+
+    if (ownFieldGroup)
+    {
+        dcgmFieldGroupDestroy(m_dcgmHandle, fieldGroupId);
+    }
+
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        SHOW_AND_LOG_ERROR << "Error: Unable to export values to " << m_filename << ". Return: "
+                           << errorString(dcgmReturn) << ".";
+        return dcgmReturn;
+    }
+
+    std::cout << "Exported " << exportValues.numValues << " values to " << m_filename << "." << std::endl;
+    if (exportValues.numSkipped > 0)
+    {
+        std::cout << "Skipped " << exportValues.numSkipped << " values of string and binary fields." << std::endl;
+    }
+    return DCGM_ST_OK;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * File:   Export.h
+ */
+
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include "Command.h"
+
+#include <string>
+
+/*****************************************************************************
+ * Define classes to extend commands
+ ****************************************************************************/
+
+/**
+ * Export Values Invoker class. Writes the cached values of a group and fields
+ * over a range of time to a file with dcgmExportValues()
+ */
+class ExportValues : public Command
+{
+public:
+    /*****************************************************************************
+     * groupIdStr     Group ID, all_gpus or all_nvswitches
+     * fieldIdsStr    Comma-separated field IDs. Used if fieldGroupId is 0
+     * fieldGroupId   Field group to export. 0 = a field group of fieldIdsStr
+     * startTime      Export values at or after this time in usec since 1970. 0 = all
+     * endTime        Export values at or before this time in usec since 1970. 0 = up to now
+     * filename       Arrow IPC file to write
+     *****************************************************************************/
+    ExportValues(std::string hostname,
+                 std::string groupIdStr,
+                 std::string fieldIdsStr,
+                 unsigned int fieldGroupId,
+                 long long startTime,
+                 long long endTime,
+                 std::string filename);
+
+protected:
+    dcgmReturn_t DoExecuteConnected() override;
+
+private:
+    std::string m_groupIdStr;
+    std::string m_fieldIdsStr;
+    unsigned int m_fieldGroupId;
+    long long m_startTime;
+    long long m_endTime;
+    std::string m_filename;
+};
+
+#endif /* EXPORT_H */
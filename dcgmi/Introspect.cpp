@@ -15,6 +15,7 @@
  */
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "DcgmLogging.h"
 #include "Introspect.h"
 #include "dcgm_agent.h"
+#include "dcgm_fields.h"
 #include "dcgm_structs.h"
 
 static char const INTROSPECT_HEADER[]
@@ -50,9 +52,27 @@ static char const INTROSPECT_FOOTER[]
 
 static const char ERROR_STRING[] = "Error";
 
+static char const INTROSPECT_FIELD_COSTS_HEADER[]
+    = "+---------------+--------+------------+------------+------------+------------+\n"
+      "| Entity        | Field  | Fetches    | Total Time | Max Time   | Memory     |\n"
+      "+===============+========+============+============+============+============+\n";
+static char const INTROSPECT_FIELD_COSTS_DATA[]
+    = "| <ENTITY      >| <FIELD>| <FETCHES  >| <TOTAL    >| <MAX      >| <MEMORY   >|\n";
+static char const INTROSPECT_FIELD_COSTS_NOTE[]
+    = "| <NOTE                                                                     >|\n";
+static char const INTROSPECT_FIELD_COSTS_FOOTER[]
+    = "+---------------+--------+------------+------------+------------+------------+\n";
+
 #define TARGET_TAG         "<TARGET"
 #define ATTRIBUTE_TAG      "<ATTRIBUTE"
 #define ATTRIBUTE_DATA_TAG "<ATTRIBUTE_DATA"
+#define ENTITY_TAG         "<ENTITY"
+#define FIELD_TAG          "<FIELD"
+#define FETCHES_TAG        "<FETCHES"
+#define TOTAL_TAG          "<TOTAL"
+#define MAX_TAG            "<MAX"
+#define MEMORY_TAG         "<MEMORY"
+#define NOTE_TAG           "<NOTE"
 
 Introspect::Introspect()
 {}
@@ -65,11 +85,11 @@ dcgmReturn_t Introspect::DisplayStats(dcgmHandle_t handle, bool forHostengine)
     // hostengine stats
     dcgmReturn_t heMemReturn = DCGM_ST_GENERIC_ERROR;
     dcgmIntrospectMemory_t heMemInfo;
-    heMemInfo.version = dcgmIntrospectMemory_version1;
+    heMemInfo.version = dcgmIntrospectMemory_version;
 
     dcgmReturn_t heCpuReturn = DCGM_ST_GENERIC_ERROR;
     dcgmIntrospectCpuUtil_t heCpuInfo;
-    heCpuInfo.version = dcgmIntrospectCpuUtil_version1;
+    heCpuInfo.version = dcgmIntrospectCpuUtil_version;
 
     // always retrieve hostengine mem usage as a way to check if introspection is enabled
     heMemReturn = dcgmIntrospectGetHostengineMemoryUsage(handle, &heMemInfo, true);
@@ -113,6 +133,14 @@ dcgmReturn_t Introspect::DisplayStats(dcgmHandle_t handle, bool forHostengine)
         }
         cmdView.display();
 
+        // Compressed sample storage. Only present when the hostengine has it enabled
+        if (DCGM_ST_OK == heMemReturn && heMemInfo.compressedSampleBytes > 0)
+        {
+            cmdView.addDisplayParameter(ATTRIBUTE_TAG, "Compressed Samples");
+            cmdView.addDisplayParameter(ATTRIBUTE_DATA_TAG, readableMemory(heMemInfo.compressedSampleBytes));
+            cmdView.display();
+        }
+
         // CPU util
         cmdView.addDisplayParameter(ATTRIBUTE_TAG, "CPU Utilization");
 
@@ -126,6 +154,28 @@ dcgmReturn_t Introspect::DisplayStats(dcgmHandle_t handle, bool forHostengine)
         }
         cmdView.display();
 
+        // CPU util of each group of threads. Idle threads are left out
+        for (unsigned int i = 0; DCGM_ST_OK == heCpuReturn && i < heCpuInfo.numThreadUtils
+                                 && i < DCGM_INTROSPECT_MAX_THREAD_CPU_UTILS;
+             i++)
+        {
+            dcgmIntrospectThreadCpuUtil_v1 const &threadUtil = heCpuInfo.threads[i];
+            if (threadUtil.total <= 0)
+            {
+                continue;
+            }
+
+            std::string data = readablePercent(threadUtil.total);
+            if (threadUtil.numThreads > 1)
+            {
+                data += fmt::format(" ({} threads)", threadUtil.numThreads);
+            }
+
+            cmdView.addDisplayParameter(ATTRIBUTE_TAG, fmt::format("  {}", threadUtil.name));
+            cmdView.addDisplayParameter(ATTRIBUTE_DATA_TAG, data);
+            cmdView.display();
+        }
+
         cmdView.setDisplayStencil(INTROSPECT_TARGET_SEPARATOR);
         cmdView.display();
     }
@@ -133,6 +183,87 @@ dcgmReturn_t Introspect::DisplayStats(dcgmHandle_t handle, bool forHostengine)
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t Introspect::DisplayFieldCosts(dcgmHandle_t handle)
+{
+    auto fieldCosts     = std::make_unique<dcgmIntrospectFieldCosts_t>();
+    fieldCosts->version = dcgmIntrospectFieldCosts_version;
+
+    dcgmReturn_t ret = dcgmIntrospectGetFieldCosts(handle, fieldCosts.get());
+    if (DCGM_ST_OK != ret)
+    {
+        log_error("Error retrieving field costs. Return: {}", errorString(ret));
+        std::cout << "Error: Unable to retrieve field costs. Return: " << errorString(ret) << "." << std::endl;
+        return ret;
+    }
+
+    CommandOutputController cmdView;
+    cmdView.setDisplayStencil(INTROSPECT_HEADER);
+    cmdView.display();
+    cmdView.setDisplayStencil(INTROSPECT_FIELD_COSTS_HEADER);
+    cmdView.display();
+
+    cmdView.setDisplayStencil(INTROSPECT_FIELD_COSTS_DATA);
+    bool anyPushed = false;
+    for (unsigned int i = 0; i < fieldCosts->numFieldCosts && i < DCGM_INTROSPECT_MAX_FIELD_COSTS; i++)
+    {
+        dcgmIntrospectFieldCost_v1 const &cost = fieldCosts->fieldCosts[i];
+
+        if (cost.entityGroupId == DCGM_FE_NONE)
+        {
+            cmdView.addDisplayParameter(ENTITY_TAG, "Global");
+        }
+        else
+        {
+            cmdView.addDisplayParameter(ENTITY_TAG,
+                                        fmt::format("{} {}", DcgmFieldsGetEntityGroupString(cost.entityGroupId),
+                                                    cost.entityId));
+        }
+        cmdView.addDisplayParameter(FIELD_TAG, (unsigned int)cost.fieldId);
+        cmdView.addDisplayParameter(FETCHES_TAG, cost.fetchCount);
+
+        if (cost.flags & DCGM_INTROSPECT_FIELD_COST_F_PUSHED)
+        {
+            /* Exec times aren't measured for fields pushed by modules */
+            anyPushed = true;
+            cmdView.addDisplayParameter(TOTAL_TAG, "Pushed");
+            cmdView.addDisplayParameter(MAX_TAG, "Pushed");
+        }
+        else
+        {
+            cmdView.addDisplayParameter(TOTAL_TAG, readableTime(cost.execTimeUsec));
+            cmdView.addDisplayParameter(MAX_TAG, readableTime(cost.maxExecTimeUsec));
+        }
+        cmdView.addDisplayParameter(MEMORY_TAG, readableMemory(cost.bytesUsed));
+        cmdView.display();
+    }
+
+    cmdView.setDisplayStencil(INTROSPECT_FIELD_COSTS_FOOTER);
+    cmdView.display();
+
+    bool const truncated = fieldCosts->numWatches > fieldCosts->numFieldCosts;
+    cmdView.setDisplayStencil(INTROSPECT_FIELD_COSTS_NOTE);
+    if (truncated)
+    {
+        cmdView.addDisplayParameter(NOTE_TAG,
+                                    fmt::format("Showing the {} most expensive of {} watches",
+                                                fieldCosts->numFieldCosts,
+                                                fieldCosts->numWatches));
+        cmdView.display();
+    }
+    if (anyPushed)
+    {
+        cmdView.addDisplayParameter(NOTE_TAG, "Pushed: updated by a module, so fetch times aren't measured");
+        cmdView.display();
+    }
+    if (truncated || anyPushed)
+    {
+        cmdView.setDisplayStencil(INTROSPECT_FIELD_COSTS_FOOTER);
+        cmdView.display();
+    }
+
+    return DCGM_ST_OK;
+}
+
 template <typename T>
 string Introspect::readableTime(T usec)
 {
@@ -155,6 +286,17 @@ string Introspect::readablePercent(double p)
     return ss.str();
 }
 
+DisplayIntrospectFieldCosts::DisplayIntrospectFieldCosts(std::string hostname)
+    : Command()
+{
+    m_hostName = std::move(hostname);
+}
+
+dcgmReturn_t DisplayIntrospectFieldCosts::DoExecuteConnected()
+{
+    return introspectObj.DisplayFieldCosts(m_dcgmHandle);
+}
+
 DisplayIntrospectSummary::DisplayIntrospectSummary(std::string hostname, bool forHostengine)
     : Command()
     , forHostengine(forHostengine)
@@ -33,6 +33,7 @@ public:
     virtual ~Introspect();
 
     dcgmReturn_t DisplayStats(dcgmHandle_t handle, bool forHostengine);
+    dcgmReturn_t DisplayFieldCosts(dcgmHandle_t handle);
 
 private:
     string readableMemory(long long bytes);
@@ -58,5 +59,20 @@ private:
     bool forHostengine;
 };
 
+/**
+ * Display the cost of each watched field, most expensive first
+ */
+class DisplayIntrospectFieldCosts : public Command
+{
+public:
+    explicit DisplayIntrospectFieldCosts(string hostname);
+
+protected:
+    dcgmReturn_t DoExecuteConnected() override;
+
+private:
+    Introspect introspectObj;
+};
+
 
 #endif /* INTROSPECT_H_ */
@@ -46,6 +46,7 @@
 
 // Misc. strings
 #define FAILURE     "Failure"
+#define INIT_TIME   "Init Time (usec)"
 #define MODULE_ID   "Module ID"
 #define MODULES     "Modules"
 #define NAME        "Name"
@@ -223,6 +224,8 @@ dcgmReturn_t Module::RunListModule(dcgmHandle_t dcgmHandle, DcgmiOutput &out)
         out[moduleStr][STATE]     = statusStr;
         out[moduleStr][MODULE_ID] = i;
         out[moduleStr][NAME]      = moduleStr;
+        out[moduleStr][INIT_TIME]
+            = statuses.statuses[i].initTimeUsec > 0 ? std::to_string(statuses.statuses[i].initTimeUsec) : "";
     }
 
     out.addHeader(STATUS ": " SUCCESS);
@@ -335,10 +338,12 @@ dcgmReturn_t ListModule::DoExecuteConnected()
     DcgmiOutputFieldSelector moduleIdSelector   = DcgmiOutputFieldSelector().child(MODULE_ID);
     DcgmiOutputFieldSelector moduleNameSelector = DcgmiOutputFieldSelector().child(NAME);
     DcgmiOutputFieldSelector stateSelector      = DcgmiOutputFieldSelector().child(STATE);
+    DcgmiOutputFieldSelector initTimeSelector   = DcgmiOutputFieldSelector().child(INIT_TIME);
 
     out.addColumn(11, MODULE_ID, moduleIdSelector);
     out.addColumn(20, NAME, moduleNameSelector);
-    out.addColumn(50, STATE, stateSelector);
+    out.addColumn(32, STATE, stateSelector);
+    out.addColumn(18, INIT_TIME, initTimeSelector);
 
     out.addHeader(LIST_MODULES);
 
@@ -32,6 +32,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string.h>
+#include <vector>
 
 
 /**************************************************************************************/
@@ -187,11 +188,44 @@ dcgmReturn_t Query::DisplayDiscoveredDevices(dcgmHandle_t dcgmHandle)
             return result;
         }
 
+        /* Fetch the attributes of all GPUs with one request. Any GPU missing from the answer, like one
+           attached after the GPU list was read, is queried on its own below */
+        std::map<unsigned int, dcgmDeviceAttributes_t const *> allAttributes;
+        std::vector<dcgmDeviceAttributes_t> attributesList(DCGM_MAX_NUM_DEVICES);
+        std::vector<unsigned int> attributesGpuIds(DCGM_MAX_NUM_DEVICES);
+        unsigned int attributesCount = 0;
+        for (auto &attributes : attributesList)
+        {
+            attributes.version = dcgmDeviceAttributes_version;
+        }
+        result = dcgmGetAllDeviceAttributes(
+            dcgmHandle, DCGM_MAX_NUM_DEVICES, attributesGpuIds.data(), attributesList.data(), &attributesCount);
+        if (result == DCGM_ST_OK)
+        {
+            for (unsigned int i = 0; i < attributesCount; i++)
+            {
+                allAttributes[attributesGpuIds[i]] = &attributesList[i];
+            }
+        }
+        else
+        {
+            log_debug("dcgmGetAllDeviceAttributes returned {}. Querying each GPU instead.", result);
+        }
+
         std::cout << entityIds.size() << " GPU" << (entityIds.size() == 1 ? "" : "s") << " found." << std::endl;
         for (unsigned int i = 0; i < entityIds.size(); i++)
         {
-            stDeviceAttributes.version = dcgmDeviceAttributes_version;
-            result                     = dcgmGetDeviceAttributes(dcgmHandle, entityIds[i], &stDeviceAttributes);
+            auto found = allAttributes.find(entityIds[i]);
+            if (found != allAttributes.end())
+            {
+                stDeviceAttributes = *found->second;
+                result             = DCGM_ST_OK;
+            }
+            else
+            {
+                stDeviceAttributes.version = dcgmDeviceAttributes_version;
+                result = dcgmGetDeviceAttributes(dcgmHandle, entityIds[i], &stDeviceAttributes);
+            }
 
             entityId = std::to_string(entityIds[i]);
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DmonRecordWriter.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<dcgmFieldValue_v1> MakeValues()
+{
+    std::vector<dcgmFieldValue_v1> values(3);
+
+    values[0].fieldId   = DCGM_FI_DEV_GPU_TEMP;
+    values[0].fieldType = DCGM_FT_INT64;
+    values[0].status    = DCGM_ST_OK;
+    values[0].ts        = 1000;
+    values[0].value.i64 = 42;
+
+    values[1].fieldId   = DCGM_FI_DEV_POWER_USAGE;
+    values[1].fieldType = DCGM_FT_DOUBLE;
+    values[1].status    = DCGM_ST_OK;
+    values[1].ts        = 1001;
+    values[1].value.dbl = 1.5;
+
+    values[2].fieldId   = DCGM_FI_DEV_NAME;
+    values[2].fieldType = DCGM_FT_STRING;
+    values[2].status    = DCGM_ST_OK;
+    values[2].ts        = 1002;
+    snprintf(values[2].value.str, sizeof(values[2].value.str), "a \"b\", c");
+
+    return values;
+}
+
+std::string ReadAll(FILE *file)
+{
+    std::string contents;
+    char buffer[4096];
+    size_t read;
+
+    rewind(file);
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        contents.append(buffer, read);
+    }
+    return contents;
+}
+} // namespace
+
+TEST_CASE("DmonRecordWriter: CSV")
+{
+    std::unique_ptr<FILE, decltype(&fclose)> file(tmpfile(), &fclose);
+    REQUIRE(file != nullptr);
+    auto values = MakeValues();
+
+    {
+        DmonRecordWriter writer(file.get(), DmonRecordWriter::Format::Csv);
+        writer.WriteHeader();
+        writer.Write(DCGM_FE_GPU, 3, values.data(), values.size());
+
+        values[0].status = DCGM_ST_NO_DATA;
+        writer.Write(DCGM_FE_GPU, 4, values.data(), 1);
+        CHECK(writer.GetValueCount() == 4);
+        REQUIRE(writer.Flush());
+    }
+
+    CHECK(ReadAll(file.get())
+          == "timestamp,entity_group,entity_id,field_id,status,value\n"
+             "1000,GPU,3,150,0,42\n"
+             "1001,GPU,3,155,0,1.5\n"
+             "1002,GPU,3,50,0,\"a \"\"b\"\", c\"\n"
+             "1000,GPU,4,150,-14,\n");
+}
+
+TEST_CASE("DmonRecordWriter: Binary")
+{
+    std::unique_ptr<FILE, decltype(&fclose)> file(tmpfile(), &fclose);
+    REQUIRE(file != nullptr);
+    auto values = MakeValues();
+
+    {
+        DmonRecordWriter writer(file.get(), DmonRecordWriter::Format::Binary);
+        writer.WriteHeader();
+        writer.Write(DCGM_FE_GPU_I, 7, values.data(), values.size());
+    }
+
+    std::string const contents = ReadAll(file.get());
+    char const *p              = contents.data();
+    std::string const name     = values[2].value.str;
+    REQUIRE(contents.size() == sizeof(DmonBinaryFileHeader) + 3 * sizeof(DmonBinaryRecord) + 8 + 8 + name.size());
+
+    DmonBinaryFileHeader header;
+    memcpy(&header, p, sizeof(header));
+    p += sizeof(header);
+    CHECK(memcmp(header.magic, DMON_BINARY_MAGIC, sizeof(header.magic)) == 0);
+    CHECK(header.version == DMON_BINARY_VERSION);
+
+    DmonBinaryRecord record;
+    memcpy(&record, p, sizeof(record));
+    p += sizeof(record);
+    CHECK(record.timestamp == 1000);
+    CHECK(record.entityGroupId == DCGM_FE_GPU_I);
+    CHECK(record.entityId == 7);
+    CHECK(record.fieldId == DCGM_FI_DEV_GPU_TEMP);
+    CHECK(record.fieldType == DCGM_FT_INT64);
+    CHECK(record.status == DCGM_ST_OK);
+    REQUIRE(record.length == 8);
+    int64_t i64;
+    memcpy(&i64, p, sizeof(i64));
+    p += sizeof(i64);
+    CHECK(i64 == 42);
+
+    memcpy(&record, p, sizeof(record));
+    p += sizeof(record);
+    REQUIRE(record.length == 8);
+    double dbl;
+    memcpy(&dbl, p, sizeof(dbl));
+    p += sizeof(dbl);
+    CHECK(dbl == 1.5);
+
+    memcpy(&record, p, sizeof(record));
+    p += sizeof(record);
+    CHECK(record.fieldType == DCGM_FT_STRING);
+    REQUIRE(record.length == name.size());
+    CHECK(std::string(p, record.length) == name);
+}
+
+TEST_CASE("DmonRecordWriter: ParseFormat")
+{
+    DmonRecordWriter::Format format = DmonRecordWriter::Format::Binary;
+
+    CHECK(DmonRecordWriter::ParseFormat("csv", format));
+    CHECK(format == DmonRecordWriter::Format::Csv);
+    CHECK(DmonRecordWriter::ParseFormat("binary", format));
+    CHECK(format == DmonRecordWriter::Format::Binary);
+    CHECK_FALSE(DmonRecordWriter::ParseFormat("json", format));
+}
@@ -347,6 +347,35 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmGetDeviceAttributes(dcgmHandle_t pDcgmHandle,
                                                      unsigned int gpuId,
                                                      dcgmDeviceAttributes_t *pDcgmAttr);
 
+/**
+ * Gets the device attributes of every GPU on the system, like \ref dcgmGetAllDevices followed by
+ * \ref dcgmGetDeviceAttributes for each GPU, but with a single request to the host engine.
+ *
+ * Attributes that don't change while the driver is loaded, like names, UUIDs, supported clocks and
+ * power limit bounds, are read from the driver once per GPU by the host engine and served from its
+ * cache afterwards.
+ *
+ * @param pDcgmHandle    IN: DCGM Handle
+ * @param capacity       IN: Number of entries of \a gpuIdList and \a attributes. DCGM_MAX_NUM_DEVICES is
+ *                           always enough.
+ * @param gpuIdList     OUT: GPU ID of each entry of \a attributes
+ * @param attributes IN/OUT: Device attributes of each GPU. .version of the first \a capacity entries should
+ *                           be set to \ref dcgmDeviceAttributes_version before this call.
+ * @param count         OUT: Number of GPUs on the system
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                 if the call was successful.
+ *        - \ref DCGM_ST_BADPARAM           if \a gpuIdList, \a attributes or \a count is NULL.
+ *        - \ref DCGM_ST_VER_MISMATCH       if .version of an entry of \a attributes is not set or is invalid.
+ *        - \ref DCGM_ST_INSUFFICIENT_SIZE  if there are more than \a capacity GPUs. \a count is set to the
+ *                                          number of GPUs.
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmGetAllDeviceAttributes(dcgmHandle_t pDcgmHandle,
+                                                        unsigned int capacity,
+                                                        unsigned int gpuIdList[],
+                                                        dcgmDeviceAttributes_t attributes[],
+                                                        unsigned int *count);
+
 /**
  * Gets the list of entities that exist for a given entity group. This API can be used in place of
  * \ref dcgmGetAllDevices.
@@ -840,6 +869,10 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmConfigSet(dcgmHandle_t pDcgmHandle,
 * Set type as \a DCGM_CONFIG_CURRENT_STATE to get the actually configuration state. Ideally, the
 * actual configuration state will be exact same as the target configuration state.
 *
+* The current configuration state is served from values DCGM samples periodically, which are at most
+* a minute old and never predate the last \ref dcgmConfigSet or \ref dcgmConfigEnforce of the GPU.
+* Set type as \a DCGM_CONFIG_CURRENT_STATE_LIVE to read it from every GPU of the group instead.
+*
 * If any of the property in the target configuration is unknown then the property value in the
 * output is populated as  one of DCGM_INT32_BLANK, DCGM_INT64_BLANK, DCGM_FP64_BLANK or
 * DCGM_STR_BLANK based on the data type of the property.
@@ -983,6 +1016,63 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmUnwatchFields(dcgmHandle_t pDcgmHandle,
                                                dcgmGpuGrp_t groupId,
                                                dcgmFieldGrp_t fieldGroupId);
 
+/**
+ * Watch a field collection and have the host engine push every update of it to a callback, instead of
+ * polling with \ref dcgmGetValuesSince_v2 or \ref dcgmGetLatestValues_v2.
+ *
+ * The host engine sends the values that updated after each field update cycle, so updates arrive within
+ * one update cycle of being sampled. enumCB is called from the DCGM connection's thread once per entity
+ * with updated values. It should return quickly and must not call DCGM APIs on the same connection.
+ *
+ * Subscriptions only exist for the lifetime of the connection, regardless of persistAfterDisconnect.
+ * Subscribing again to the same groupId and fieldGroupId replaces the prior subscription.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle of a remote host engine
+ * @param groupId             IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                                for details on creating the group. Alternatively, pass in the group id as
+ *                                \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                                \a DCGM_GROUP_ALL_NVSWITCHES to to perform the operation on all NvSwitches.
+ * @param fieldGroupId        IN: Fields to watch and push updates of.
+ * @param updateFreq          IN: How often to update this field in usec
+ * @param maxKeepAge          IN: How long to keep data for this field in seconds
+ * @param maxKeepSamples      IN: Maximum number of samples to keep. 0=no limit
+ * @param enumCB              IN: Callback to invoke with the updated values of each entity. A non-zero return skips
+ *                                the rest of the current update
+ * @param userData            IN: User data pointer to pass to the userData field of enumCB.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_NOT_SUPPORTED        if pDcgmHandle is an embedded host engine
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmFieldValueSubscribe(dcgmHandle_t pDcgmHandle,
+                                                     dcgmGpuGrp_t groupId,
+                                                     dcgmFieldGrp_t fieldGroupId,
+                                                     long long updateFreq,
+                                                     double maxKeepAge,
+                                                     int maxKeepSamples,
+                                                     dcgmFieldValueEntityEnumeration_f enumCB,
+                                                     void *userData);
+
+/**
+ * Stop a subscription made with \ref dcgmFieldValueSubscribe and unwatch its fields. No more callbacks
+ * are made for the subscription once this returns.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param groupId             IN: Group ID that was passed to \ref dcgmFieldValueSubscribe
+ * @param fieldGroupId        IN: Field group ID that was passed to \ref dcgmFieldValueSubscribe
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_NOT_WATCHED          if there is no such subscription on this connection
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmFieldValueUnsubscribe(dcgmHandle_t pDcgmHandle,
+                                                       dcgmGpuGrp_t groupId,
+                                                       dcgmFieldGrp_t fieldGroupId);
+
 /**
  * Request updates for all field values that have updated since a given timestamp
  *
@@ -1046,6 +1136,172 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmGetValuesSince_v2(dcgmHandle_t pDcgmHandle,
                                                    dcgmFieldValueEntityEnumeration_f enumCB,
                                                    void *userData);
 
+/**
+ * Request updates for all field values that have updated since a given timestamp, as flat arrays
+ *
+ * This returns the same numeric values as \ref dcgmGetValuesSince_v2, but writes them into the arrays of columns
+ * instead of calling back for each of them. Use it to hand many values to code that works on arrays, like numpy.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param groupId             IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                                for details on creating the group. Alternatively, pass in the group id as
+ *                                \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                                \a DCGM_GROUP_ALL_NVSWITCHES to perform the operation on all NvSwitches.
+ * @param fieldGroupId        IN: Fields to return data for
+ * @param sinceTimestamp      IN: Timestamp to request values since in usec since 1970. This will be returned in
+ *                                nextSinceTimestamp for subsequent calls 0 = request all data
+ * @param nextSinceTimestamp OUT: Timestamp to use for sinceTimestamp on next call to this function
+ * @param columns         IN/OUT: Arrays to write the values to. See \ref dcgmFieldValueColumns_t
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_VER_MISMATCH         if columns has the wrong version
+ *        - \ref DCGM_ST_INSUFFICIENT_SIZE    if more than columns->capacity values updated. columns->count is the
+ *                                           number of values and nextSinceTimestamp isn't advanced. Call again
+ *                                           with arrays that large
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmGetValuesSinceColumns(dcgmHandle_t pDcgmHandle,
+                                                       dcgmGpuGrp_t groupId,
+                                                       dcgmFieldGrp_t fieldGroupId,
+                                                       long long sinceTimestamp,
+                                                       long long *nextSinceTimestamp,
+                                                       dcgmFieldValueColumns_t *columns);
+
+/**
+ * Get the values of a field collection resampled to a common grid of times, as a dense matrix
+ *
+ * The host engine reads the cached samples of every entity of \a groupId and field of \a fieldGroupId and fills a
+ * row for each time from resampled->startTime to resampled->endTime, stepUsec apart. Each (entity, field) is a
+ * column. resampled->fill picks what a cell holds when its column has no sample at the row's time. Use it to get
+ * the series of many fields lined up in time without reading all of their samples.
+ *
+ * Fields that aren't watched on an entity still get a column, which is blank. Samples that aged out of the cache
+ * aren't used.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param groupId             IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                                for details on creating the group. Alternatively, pass in the group id as
+ *                                \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                                \a DCGM_GROUP_ALL_NVSWITCHES to perform the operation on all NvSwitches.
+ * @param fieldGroupId        IN: Fields to return data for
+ * @param resampled       IN/OUT: Grid to resample to and arrays to write the matrix to. See \ref dcgmResampledValues_t
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_VER_MISMATCH         if resampled has the wrong version
+ *        - \ref DCGM_ST_INSUFFICIENT_SIZE    if the columns or values don't fit in the arrays. resampled->numRows and
+ *                                           resampled->numColumns are the size of the matrix. Call again with
+ *                                           arrays that large
+ *        - \ref DCGM_ST_MAX_LIMIT            if there are more than DCGM_RESAMPLE_MAX_COLUMNS columns
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmGetResampledValues(dcgmHandle_t pDcgmHandle,
+                                                    dcgmGpuGrp_t groupId,
+                                                    dcgmFieldGrp_t fieldGroupId,
+                                                    dcgmResampledValues_t *resampled);
+
+/**
+ * Open a cursor over the field values of a field collection that updated since a given timestamp.
+ *
+ * This returns the same values as \ref dcgmGetValuesSince_v2, but in chunks of bounded size that are read with
+ * \ref dcgmValuesSinceCursorNext. Use it to read long histories, like a backfill after a restart. The host engine
+ * only remembers where the cursor stopped, so no lock is held and no values are kept between chunks.
+ *
+ * Values that update after the cursor is opened aren't returned. Values that age out of the cache before the
+ * cursor reaches them are skipped. A connection can have 16 cursors open at once. Cursors are closed when their
+ * connection goes away.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param groupId             IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                                for details on creating the group. Alternatively, pass in the group id as
+ *                                \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                                \a DCGM_GROUP_ALL_NVSWITCHES to perform the operation on all NvSwitches.
+ * @param fieldGroupId        IN: Fields to return data for
+ * @param sinceTimestamp      IN: Timestamp to request values since in usec since 1970. 0 = request all data
+ * @param cursor             OUT: Cursor to pass to \ref dcgmValuesSinceCursorNext and \ref dcgmValuesSinceCursorClose
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_MAX_LIMIT            if the connection has too many cursors open
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmValuesSinceCursorOpen(dcgmHandle_t pDcgmHandle,
+                                                       dcgmGpuGrp_t groupId,
+                                                       dcgmFieldGrp_t fieldGroupId,
+                                                       long long sinceTimestamp,
+                                                       dcgmValuesCursor_t *cursor);
+
+/**
+ * Get the next chunk of values of a cursor opened with \ref dcgmValuesSinceCursorOpen.
+ *
+ * Values are returned one entity and field at a time, in ascending timestamp order for each.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param cursor              IN: Cursor returned by \ref dcgmValuesSinceCursorOpen
+ * @param enumCB              IN: Callback to invoke for every field value of the chunk. A non-zero return skips the
+ *                                rest of the chunk
+ * @param userData            IN: User data pointer to pass to the userData field of enumCB.
+ * @param done               OUT: Set to 1 once the cursor has returned all of its values, 0 otherwise
+ * @param nextSinceTimestamp OUT: Once done, the timestamp to use for sinceTimestamp of the next
+ *                                \ref dcgmGetValuesSince_v2 or \ref dcgmValuesSinceCursorOpen
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid or cursor isn't open
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmValuesSinceCursorNext(dcgmHandle_t pDcgmHandle,
+                                                       dcgmValuesCursor_t cursor,
+                                                       dcgmFieldValueEntityEnumeration_f enumCB,
+                                                       void *userData,
+                                                       int *done,
+                                                       long long *nextSinceTimestamp);
+
+/**
+ * Close a cursor opened with \ref dcgmValuesSinceCursorOpen.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param cursor              IN: Cursor returned by \ref dcgmValuesSinceCursorOpen
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if cursor isn't open
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmValuesSinceCursorClose(dcgmHandle_t pDcgmHandle, dcgmValuesCursor_t cursor);
+
+/**
+ * Export the cached values of a field collection over a range of time to a file, for offline analysis.
+ *
+ * The file is written by the calling process while the values are read from the host engine in chunks with a
+ * cursor (see \ref dcgmValuesSinceCursorOpen), so memory stays bounded however long the range is and sampling is
+ * never stalled. Values are written one entity and field at a time, in ascending timestamp order for each.
+ *
+ * @param pDcgmHandle         IN: DCGM Handle
+ * @param groupId             IN: Group ID representing collection of one or more entities. Look at \ref dcgmGroupCreate
+ *                                for details on creating the group. Alternatively, pass in the group id as
+ *                                \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs or
+ *                                \a DCGM_GROUP_ALL_NVSWITCHES to perform the operation on all NvSwitches.
+ * @param fieldGroupId        IN: Fields to export
+ * @param exportValues    IN/OUT: Time range, format and file to write. See \ref dcgmExportValues_t
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_VER_MISMATCH         if exportValues has the wrong version
+ *        - \ref DCGM_ST_GENERIC_ERROR        if the file couldn't be written. It is removed
+ *        - \ref DCGM_ST_MAX_LIMIT            if the connection has too many cursors open
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmExportValues(dcgmHandle_t pDcgmHandle,
+                                              dcgmGpuGrp_t groupId,
+                                              dcgmFieldGrp_t fieldGroupId,
+                                              dcgmExportValues_t *exportValues);
+
 /**
  * Request latest cached field value for a field value collection
  *
@@ -1159,15 +1415,163 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmEntitiesGetLatestValues(dcgmHandle_t pDcgmHandl
                                                          unsigned int flags,
                                                          dcgmFieldValue_v2 values[]);
 
+/**
+ * Open a read-only view over the latest cached numeric values of a list of fields for a group of entities.
+ *
+ * This is only available to clients of an embedded host engine (see \ref dcgmStartEmbedded_v2). Values are read
+ * from the view with \ref dcgmLatestValueViewRead, which reads the host engine's cache in place without any
+ * request, allocation or lock. The fields must still be watched for values to be cached.
+ *
+ * The view and its slots stay valid until the embedded host engine is stopped. Opening a view again for the same
+ * entities and fields returns the same slots.
+ *
+ * @param pDcgmHandle   IN: DCGM Handle of an embedded host engine
+ * @param entities      IN: List of entities to get values for
+ * @param entityCount   IN: Number of entries in entities[]
+ * @param fields        IN: Field IDs to get values for. Only DCGM_FT_INT64 and DCGM_FT_DOUBLE fields are supported.
+ * @param fieldCount    IN: Number of field IDs in fields[] array.
+ * @param view         OUT: Handle to the view
+ * @param slots        OUT: Slot of each entity and field in the view. This must be able to hold entityCount *
+ *                          fieldCount entries. slots[entityIndex * fieldCount + fieldIndex] is the slot of
+ *                          fields[fieldIndex] of entities[entityIndex], or \ref DCGM_LATEST_VALUE_VIEW_NO_SLOT if
+ *                          the field isn't numeric or the view is full.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                if the call was successful
+ *        - \ref DCGM_ST_BADPARAM          if a parameter is invalid
+ *        - \ref DCGM_ST_NOT_SUPPORTED     if pDcgmHandle is not an embedded host engine
+ *        - \ref DCGM_ST_UNINITIALIZED     if the embedded host engine isn't running
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmLatestValueViewOpen(dcgmHandle_t pDcgmHandle,
+                                                     dcgmGroupEntityPair_t entities[],
+                                                     unsigned int entityCount,
+                                                     unsigned short fields[],
+                                                     unsigned int fieldCount,
+                                                     dcgmLatestValueView_t *view,
+                                                     unsigned int slots[]);
+
+/**
+ * Read the latest values of slots of a view opened with \ref dcgmLatestValueViewOpen.
+ *
+ * This does not block the host engine and can be called from any thread. Check each sample's status to see if it
+ * has a value.
+ *
+ * @param view          IN: View returned by \ref dcgmLatestValueViewOpen
+ * @param slots         IN: Slots to read
+ * @param count         IN: Number of entries in slots[]
+ * @param samples      OUT: Value of each slot. This must be able to hold count entries.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                if the call was successful
+ *        - \ref DCGM_ST_BADPARAM          if a parameter is invalid
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmLatestValueViewRead(dcgmLatestValueView_t view,
+                                                     unsigned int slots[],
+                                                     unsigned int count,
+                                                     dcgmLatestValueSample_t samples[]);
+
+/**
+ * Open the shared memory table of latest values that a host engine on this machine publishes (nv-hostengine
+ * --shm-latest-values).
+ *
+ * This needs no connection to the host engine, nor \ref dcgmInit. The table is mapped read-only and holds the
+ * latest numeric value of the host engine's shared fields for every entity they are watched on, updated as the
+ * values are cached.
+ *
+ * @param name          IN: Name of the table. "" or NULL = \ref DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME
+ * @param values       OUT: Handle to the table. Release it with \ref dcgmSharedLatestValuesClose
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_NO_DATA              if no host engine publishes a table with that name
+ *        - \ref DCGM_ST_NO_PERMISSION        if the table can't be read by this user
+ *        - \ref DCGM_ST_VER_MISMATCH         if the table was published by an incompatible host engine
+ *        - \ref DCGM_ST_CONNECTION_NOT_VALID if the host engine has stopped publishing the table
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmSharedLatestValuesOpen(char const *name, dcgmSharedLatestValues_t *values);
+
+/**
+ * Look up the rows of a list of fields for a group of entities in a table opened with
+ * \ref dcgmSharedLatestValuesOpen.
+ *
+ * Rows never move, so this only needs to be called again for entities and fields that had no row yet. They get one
+ * once the host engine watches them.
+ *
+ * @param values        IN: Table returned by \ref dcgmSharedLatestValuesOpen
+ * @param entities      IN: List of entities to get values for. Global fields are found with any entity
+ * @param entityCount   IN: Number of entries in entities[]
+ * @param fields        IN: Field IDs to get values for
+ * @param fieldCount    IN: Number of field IDs in fields[] array.
+ * @param rows         OUT: Row of each entity and field. This must be able to hold entityCount * fieldCount
+ *                          entries. rows[entityIndex * fieldCount + fieldIndex] is the row of fields[fieldIndex] of
+ *                          entities[entityIndex], or \ref DCGM_LATEST_VALUE_VIEW_NO_SLOT if the table has none.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                if the call was successful
+ *        - \ref DCGM_ST_BADPARAM          if a parameter is invalid
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmSharedLatestValuesFind(dcgmSharedLatestValues_t values,
+                                                        dcgmGroupEntityPair_t entities[],
+                                                        unsigned int entityCount,
+                                                        unsigned short fields[],
+                                                        unsigned int fieldCount,
+                                                        unsigned int rows[]);
+
+/**
+ * Read the latest values of rows of a table opened with \ref dcgmSharedLatestValuesOpen.
+ *
+ * This does not block the host engine or take any lock and can be called from any thread. Check each sample's
+ * status to see if it has a value. DCGM_ST_STALE_DATA means that the host engine stopped in the middle of
+ * updating the row.
+ *
+ * @param values        IN: Table returned by \ref dcgmSharedLatestValuesOpen
+ * @param rows          IN: Rows to read
+ * @param count         IN: Number of entries in rows[]
+ * @param samples      OUT: Value of each row. This must be able to hold count entries.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is invalid
+ *        - \ref DCGM_ST_CONNECTION_NOT_VALID if the host engine has stopped publishing the table. Close it and
+ *                                             open it again once the host engine is back
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmSharedLatestValuesRead(dcgmSharedLatestValues_t values,
+                                                        unsigned int rows[],
+                                                        unsigned int count,
+                                                        dcgmLatestValueSample_t samples[]);
+
+/**
+ * Unmap a table opened with \ref dcgmSharedLatestValuesOpen.
+ *
+ * @param values        IN: Table returned by \ref dcgmSharedLatestValuesOpen
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                if the call was successful
+ *        - \ref DCGM_ST_BADPARAM          if values is invalid
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmSharedLatestValuesClose(dcgmSharedLatestValues_t values);
+
 /*************************************************************************/
 /**
  * Get a summary of the values for a field id over a period of time.
  *
+ * A dcgmFieldSummaryRequest_v2 can also be passed to get percentiles and a histogram of the values.
+ * These come from per-watch quantile sketches, so they don't need the samples to be transferred.
+ *
  * @param pDcgmHandle       IN: DCGM Handle
  * @param request       IN/OUT: a pointer to the struct detailing the request and containing the response
  *
  * @return
  *       - \ref DCGM_ST_OK                if the call was successful
+ *       - \ref DCGM_ST_BADPARAM          if a v2 request asks for more than DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS
+ *                                       histogram buckets
  *       - \ref DCGM_ST_FIELD_UNSUPPORTED_BY_API if the field is not int64 or double type
  *
  */
@@ -1200,6 +1604,61 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmGetFieldSummary(dcgmHandle_t pDcgmHandle, dcgmF
  */
 dcgmReturn_t DCGM_PUBLIC_API dcgmUpdateAllFields(dcgmHandle_t pDcgmHandle, int waitForUpdate);
 
+/**
+ * This method is used to tell DCGM to update the watched fields of a field group on a group of entities
+ * now, whether or not they are due, without updating any other watch. Use it instead of
+ * \ref dcgmUpdateAllFields when fresh values are only needed for a few fields.
+ *
+ * Fields of \a fieldGroupId that aren't watched on an entity of \a groupId are skipped. Watch them with
+ * \ref dcgmWatchFields first.
+ *
+ * @param pDcgmHandle           IN: DCGM Handle
+ * @param groupId               IN: Group ID representing collection of one or more entities
+ * @param fieldGroupId          IN: Fields to update
+ * @param waitForUpdate         IN: Whether or not to wait for the update to complete before returning to the
+ *                                  caller 1=wait. 0=do not wait.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_NOT_CONFIGURED       if \a groupId or \a fieldGroupId does not exist
+ *        - \ref DCGM_ST_GENERIC_ERROR        if an unspecified DCGM error occurs
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmUpdateFields(dcgmHandle_t pDcgmHandle,
+                                              dcgmGpuGrp_t groupId,
+                                              dcgmFieldGrp_t fieldGroupId,
+                                              int waitForUpdate);
+
+/**
+ * This method is used to take a consistent snapshot of the watched fields of a field group across the entities
+ * of a group. Unlike \ref dcgmUpdateFields, the GPUs are sampled at the same time: the driver calls of each GPU are
+ * made in parallel, and every sample of the snapshot is stamped with the same timestamp, so values of different
+ * GPUs can be compared with each other.
+ *
+ * That timestamp is returned as \a snapshotId. Snapshot IDs increase with every snapshot. Read the snapshot with
+ * the usual sample APIs: its samples are the ones whose timestamp is \a snapshotId. Fields that the driver reports
+ * with timestamps of their own keep those. A sample that a change-only watch drops is not part of the snapshot.
+ *
+ * Fields of \a fieldGroupId that aren't watched on an entity of \a groupId are skipped. Watch them with
+ * \ref dcgmWatchFields first. This call returns once the snapshot is in the cache.
+ *
+ * @param pDcgmHandle           IN: DCGM Handle
+ * @param groupId               IN: Group ID representing collection of one or more entities
+ * @param fieldGroupId          IN: Fields to sample
+ * @param snapshotId           OUT: ID of the snapshot, which is the timestamp of its samples in usec since 1970
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if \a snapshotId is NULL
+ *        - \ref DCGM_ST_NOT_CONFIGURED       if \a groupId or \a fieldGroupId does not exist
+ *        - \ref DCGM_ST_GENERIC_ERROR        if an unspecified DCGM error occurs
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmSnapshotFields(dcgmHandle_t pDcgmHandle,
+                                                dcgmGpuGrp_t groupId,
+                                                dcgmFieldGrp_t fieldGroupId,
+                                                long long *snapshotId);
+
 /** @} */ // Closing for DCGMAPI_Admin_ExecCtrl
 
 
@@ -1342,6 +1801,10 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmJobStopStats(dcgmHandle_t pDcgmHandle, char job
  * point when the job is in process.
  * If you want to reuse this jobId, call \ref dcgmJobRemove after this call.
  *
+ * If nv-hostengine was started with __DCGM_JOB_JOURNAL_FILE__ set to a file path, the stats of each job are
+ * appended to that file when the job is stopped. They can then still be retrieved after \ref dcgmJobRemove or
+ * a restart of nv-hostengine.
+ *
  * @param pDcgmHandle        IN: DCGM Handle
  * @param jobId              IN: User provided string to represent the job
  * @param pJobInfo       IN/OUT: Structure to return information about the job.<br> .version should be set to
@@ -1577,6 +2040,42 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmPolicyRegister_v2(dcgmHandle_t pDcgmHandle,
                                                    fpRecvUpdates callback,
                                                    uint64_t userData);
 
+/**
+ * Register a function to be called when a specific policy condition (see \ref dcgmPolicyCondition_t) has been
+ * violated, like \ref dcgmPolicyRegister_v2 does, with violations delivered in batches.
+ *
+ * The violations that occur within options->coalesceWindowMs of each other are sent to the client as one message.
+ * callback is called once for each of them, one after the other. Violations of a condition beyond
+ * options->maxPerConditionPerSec per second are dropped, so that a storm of violations across many GPUs can't
+ * overwhelm the client.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param groupId            IN: Group ID representing collection of one or more GPUs. Look at \ref dcgmGroupCreate for
+ *                               details on creating the group. Alternatively, pass in the group id as
+ *                               \a DCGM_GROUP_ALL_GPUS to perform operation on all the GPUs.
+ * @param condition          IN: The set of conditions specified as an OR'd list (see \ref dcgmPolicyCondition_t) for
+ *                               which to register a callback function
+ * @param callback           IN: A reference to a function that should be called for each violation.
+ * @param userData           IN: User data pointer to pass to the userData field of callback
+ * @param options            IN: How violations are coalesced and rate limited. See \ref dcgmPolicyNotifyOptions_t
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if \a groupId, \a condition, is invalid, \a callback or \a options is
+ *                                            NULL, or options->coalesceWindowMs is above
+ *                                            DCGM_POLICY_COALESCE_WINDOW_MS_MAX
+ *        - \ref DCGM_ST_VER_MISMATCH         if \a options has the wrong version or the host engine is too old to
+ *                                            batch violations
+ *        - \ref DCGM_ST_NOT_SUPPORTED        if any unsupported GPUs are part of the GPU group specified in groupId
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmPolicyRegisterBatched(dcgmHandle_t pDcgmHandle,
+                                                       dcgmGpuGrp_t groupId,
+                                                       dcgmPolicyCondition_t condition,
+                                                       fpRecvUpdates callback,
+                                                       uint64_t userData,
+                                                       dcgmPolicyNotifyOptions_t const *options);
+
 /**
  * Unregister a function to be called for a specific policy condition (see \ref dcgmPolicyCondition_t).
  * This function will unregister all callbacks for a given condition and handle.
@@ -1660,6 +2159,34 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmActionValidate_v2(dcgmHandle_t pDcgmHandle,
                                                    dcgmRunDiag_v9 *drd,
                                                    dcgmDiagResponse_v11 *response);
 
+/**
+ * Same as \ref dcgmActionValidate_v2, but also calls a callback with the results of each test as soon as it
+ * completes, instead of only returning all of them once the whole run is done.
+ *
+ * callback is called from the DCGM connection's thread, once per completed test and before this call returns.
+ * It should return quickly and must not call DCGM APIs on the same connection. The completion passed to it is only
+ * valid for the duration of the call. To stop the run early, call \ref dcgmStopDiagnostic from another thread.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param drd                IN: Same as for \ref dcgmActionValidate_v2. .version must be \ref dcgmRunDiag_version9.
+ * @param callback           IN: Callback to invoke with the results of each completed test
+ * @param userData           IN: User data pointer to pass to the userData field of callback
+ * @param response          OUT: Result of the validation process. Refer to \ref dcgmDiagResponse_t for details.
+ *                               .version must be \ref dcgmDiagResponse_version11.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a parameter is NULL or invalid
+ *        - \ref DCGM_ST_VER_MISMATCH         if the version of \a drd or \a response is not supported
+ *        - \ref DCGM_ST_FUNCTION_NOT_FOUND   if the host engine doesn't support streaming test results
+ *        - Any other return of \ref dcgmActionValidate_v2
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmRunDiagnosticWithCallback(dcgmHandle_t pDcgmHandle,
+                                                           dcgmRunDiag_v9 *drd,
+                                                           dcgmDiagTestCompleted_f callback,
+                                                           void *userData,
+                                                           dcgmDiagResponse_v11 *response);
+
 
 /**
  * Run a diagnostic on a group of GPUs
@@ -1828,6 +2355,66 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetHostengineCpuUtilization(dcgmHandl
                                                                        dcgmIntrospectCpuUtil_t *cpuUtil,
                                                                        int waitIfNoData);
 
+/*************************************************************************/
+/**
+ * Retrieve what each watched field of each entity costs the hostengine: how many times it has been fetched,
+ * the total and longest time spent fetching it from the driver and how many bytes of samples are cached for it.
+ * Fields whose samples are pushed by a module like NvSwitch or sysmon are included with
+ * DCGM_INTROSPECT_FIELD_COST_F_PUSHED set. Entries are ordered from the most expensive to the least expensive.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param fieldCosts     IN/OUT: see \ref dcgmIntrospectFieldCosts_t. fieldCosts->version must be set to
+ *                               dcgmIntrospectFieldCosts_version prior to this call.
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if \a fieldCosts is NULL
+ *       - \ref DCGM_ST_VER_MISMATCH         if fieldCosts->version is 0 or invalid.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetFieldCosts(dcgmHandle_t pDcgmHandle,
+                                                        dcgmIntrospectFieldCosts_t *fieldCosts);
+
+/*************************************************************************/
+/**
+ * Retrieve how long the hostengine waited for and held each of its profiled mutexes, for each place in its source
+ * that locks them, with histograms of the wait and hold times. Places that waited longest come first.
+ *
+ * Mutexes are only profiled if nv-hostengine was started with __DCGM_MUTEX_PROFILING__=1. Otherwise
+ * lockProfile->numSites is 0.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param lockProfile    IN/OUT: see \ref dcgmIntrospectLockProfile_t. lockProfile->version must be set to
+ *                               dcgmIntrospectLockProfile_version prior to this call.
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if \a lockProfile is NULL
+ *       - \ref DCGM_ST_VER_MISMATCH         if lockProfile->version is 0 or invalid.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetLockProfile(dcgmHandle_t pDcgmHandle,
+                                                         dcgmIntrospectLockProfile_t *lockProfile);
+
+/*************************************************************************/
+/**
+ * Retrieve the counters of the hostengine's cache manager: how many update cycles it ran, how long it spent in
+ * them and asleep, and how often its mutex was contended. The counters only go up, so the difference between
+ * two calls describes the interval between them.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param runtimeStats   IN/OUT: see \ref dcgmIntrospectRuntimeStats_t. runtimeStats->version must be set to
+ *                               dcgmIntrospectRuntimeStats_version prior to this call.
+ *
+ * @return
+ *       - \ref DCGM_ST_OK                   if the call was successful
+ *       - \ref DCGM_ST_BADPARAM             if \a runtimeStats is NULL
+ *       - \ref DCGM_ST_VER_MISMATCH         if runtimeStats->version is 0 or invalid.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmIntrospectGetRuntimeStats(dcgmHandle_t pDcgmHandle,
+                                                          dcgmIntrospectRuntimeStats_t *runtimeStats);
+
 /** @} */ // Closing for DCGMAPI_METADATA
 
 /***************************************************************************************************/
@@ -1949,6 +2536,30 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmModuleGetStatuses(dcgmHandle_t pDcgmHandle, dcg
 dcgmReturn_t DCGM_PUBLIC_API dcgmProfGetSupportedMetricGroups(dcgmHandle_t pDcgmHandle,
                                                               dcgmProfGetMetricGroups_t *metricGroups);
 
+/*************************************************************************/
+/**
+ * Get how the profiling fields watched for a GPU group are time-multiplexed.
+ *
+ * When the profiling fields passed to \ref dcgmWatchFields are spread over metric groups with the same .majorId,
+ * they can't be collected at the same time. Instead of failing the watch, DCGM splits the fields into passes and
+ * rotates through them, watching each pass for windowUsec. A field is only collected during the passes that
+ * contain it, so its cached values are estimates based on the fraction of the time that it was collected.
+ *
+ * GPUs that support GPM collect every profiling field at the same time and are never multiplexed.
+ *
+ * @param pDcgmHandle        IN: DCGM Handle
+ * @param multiplexInfo  IN/OUT: multiplexInfo->version should be set to dcgmProfMultiplexInfo_version and
+ *                               multiplexInfo->groupId to the group that the fields were watched for.
+ *                               multiplexInfo->numPasses is 0 if the fields of the group aren't multiplexed.
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                     if the request succeeds.
+ *        - \ref DCGM_ST_BADPARAM               if a parameter is missing or bad.
+ *        - \ref DCGM_ST_VER_MISMATCH           if multiplexInfo->version is not supported.
+ *
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmProfGetMultiplexInfo(dcgmHandle_t pDcgmHandle, dcgmProfMultiplexInfo_t *multiplexInfo);
+
 /**
  * Pause profiling activities in DCGM. This should be used when you are monitoring profiling fields
  * from DCGM but want to be able to still run developer tools like nvprof, nsight systems, and nsight compute.
@@ -2419,10 +2419,83 @@ typedef unsigned int dcgm_field_eid_t;
  */
 #define DCGM_FI_DEV_NVLINK_COUNT_SYMBOL_BER 1215
 
+/**
+ * Derived fields. These are computed by the host engine from other fields of the same entity each time those are
+ * updated. Watching one watches its inputs at the same interval.
+ */
+
+/**
+ * Power usage as a percentage of the enforced power limit. Derived from DCGM_FI_DEV_POWER_USAGE and
+ * DCGM_FI_DEV_ENFORCED_POWER_LIMIT
+ */
+#define DCGM_FI_DEV_POWER_USAGE_PERCENT 1216
+
+/**
+ * PCIe replays per second. Derived from DCGM_FI_DEV_PCIE_REPLAY_COUNTER
+ */
+#define DCGM_FI_DEV_PCIE_REPLAY_RATE 1217
+
+/**
+ * Volatile single-bit ECC errors per second. Derived from DCGM_FI_DEV_ECC_SBE_VOL_TOTAL
+ */
+#define DCGM_FI_DEV_ECC_SBE_VOL_RATE 1218
+
+/**
+ * Volatile double-bit ECC errors per second. Derived from DCGM_FI_DEV_ECC_DBE_VOL_TOTAL
+ */
+#define DCGM_FI_DEV_ECC_DBE_VOL_RATE 1219
+
+/**
+ * NVLink flow-control CRC errors per second for all lanes. Derived from DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_TOTAL
+ */
+#define DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_RATE 1220
+
+/**
+ * NVLink replay errors per second for all lanes. Derived from DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_TOTAL
+ */
+#define DCGM_FI_DEV_NVLINK_REPLAY_ERROR_RATE 1221
+
+/**
+ * Seconds the GPU spent with DCGM_CLOCKS_EVENT_REASON_SW_POWER_CAP set since this field was watched. Derived from
+ * DCGM_FI_DEV_CLOCKS_EVENT_REASONS, whose samples are taken to hold until the next one. The time spent during a job
+ * is the difference of the values at its start and end
+ */
+#define DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME 1222
+
+/**
+ * Seconds the GPU spent with DCGM_CLOCKS_EVENT_REASON_HW_SLOWDOWN set since this field was watched. See
+ * DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME
+ */
+#define DCGM_FI_DEV_CLOCKS_EVENT_HW_SLOWDOWN_TIME 1223
+
+/**
+ * Seconds the GPU spent with DCGM_CLOCKS_EVENT_REASON_SYNC_BOOST set since this field was watched. See
+ * DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME
+ */
+#define DCGM_FI_DEV_CLOCKS_EVENT_SYNC_BOOST_TIME 1224
+
+/**
+ * Seconds the GPU spent with DCGM_CLOCKS_EVENT_REASON_SW_THERMAL set since this field was watched. See
+ * DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME
+ */
+#define DCGM_FI_DEV_CLOCKS_EVENT_SW_THERMAL_TIME 1225
+
+/**
+ * Seconds the GPU spent with DCGM_CLOCKS_EVENT_REASON_HW_THERMAL set since this field was watched. See
+ * DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME
+ */
+#define DCGM_FI_DEV_CLOCKS_EVENT_HW_THERMAL_TIME 1226
+
+/**
+ * Seconds the GPU spent with DCGM_CLOCKS_EVENT_REASON_HW_POWER_BRAKE set since this field was watched. See
+ * DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME
+ */
+#define DCGM_FI_DEV_CLOCKS_EVENT_HW_POWER_BRAKE_TIME 1227
+
 /**
  * 1 greater than maximum fields above. This is the 1 greater than the maximum field id that could be allocated
  */
-#define DCGM_FI_MAX_FIELDS 1216
+#define DCGM_FI_MAX_FIELDS 1228
 
 
 /** @} */
@@ -440,8 +440,9 @@ typedef enum dcgmChipArchitecture_enum
  */
 typedef enum dcgmConfigType_enum
 {
-    DCGM_CONFIG_TARGET_STATE  = 0, //!< The target configuration values to be applied
-    DCGM_CONFIG_CURRENT_STATE = 1, //!< The current configuration state
+    DCGM_CONFIG_TARGET_STATE       = 0, //!< The target configuration values to be applied
+    DCGM_CONFIG_CURRENT_STATE      = 1, //!< The current configuration state
+    DCGM_CONFIG_CURRENT_STATE_LIVE = 2, //!< The current configuration state, read from every GPU by this call
 } dcgmConfigType_t;
 
 /**
@@ -461,10 +462,11 @@ typedef enum dcgmConfigPowerLimitType_enum
  *  @{
  */
 /***************************************************************************************************/
-typedef uintptr_t dcgmHandle_t;   //!< Identifier for DCGM Handle
-typedef uintptr_t dcgmGpuGrp_t;   //!< Identifier for a group of GPUs. A group can have one or more GPUs
-typedef uintptr_t dcgmFieldGrp_t; //!< Identifier for a group of fields.
-typedef uintptr_t dcgmStatus_t;   //!< Identifier for list of status codes
+typedef uintptr_t dcgmHandle_t;       //!< Identifier for DCGM Handle
+typedef uintptr_t dcgmGpuGrp_t;       //!< Identifier for a group of GPUs. A group can have one or more GPUs
+typedef uintptr_t dcgmFieldGrp_t;     //!< Identifier for a group of fields.
+typedef uintptr_t dcgmStatus_t;       //!< Identifier for list of status codes
+typedef uintptr_t dcgmValuesCursor_t; //!< Identifier for a cursor over field values since a timestamp
 
 /**
  * DCGM Logging Severities. These match up with plog severities defined in Severity.h
@@ -530,6 +532,8 @@ typedef struct
 
 /**
  * Connection options for dcgmConnect_v2 (v2)
+ *
+ * NOTE: This version is deprecated. use dcgmConnectV2Params_v3
  */
 typedef struct
 {
@@ -545,19 +549,75 @@ typedef struct
 } dcgmConnectV2Params_v2;
 
 /**
- * Typedef for \ref dcgmConnectV2Params_v2
+ * Version 2 for \ref dcgmConnectV2Params_v2
  */
-typedef dcgmConnectV2Params_v2 dcgmConnectV2Params_t;
+#define dcgmConnectV2Params_version2 MAKE_DCGM_VERSION(dcgmConnectV2Params_v2, 2)
 
 /**
- * Version 2 for \ref dcgmConnectV2Params_v2
+ * Connection options for dcgmConnect_v2 (v3)
+ *
+ * NOTE: This version is deprecated. use dcgmConnectV2Params_v4
  */
-#define dcgmConnectV2Params_version2 MAKE_DCGM_VERSION(dcgmConnectV2Params_v2, 2)
+typedef struct
+{
+    unsigned int version;                /*!< Version number. Use dcgmConnectV2Params_version */
+    unsigned int persistAfterDisconnect; /*!< Whether to persist DCGM state modified by this connection once the
+                                              connection is terminated. Normally, all field watches created by a
+                                              connection are removed once a connection goes away. 1 = do not clean up
+                                              after this connection. 0 = clean up after this connection */
+    unsigned int timeoutMs;              /*!< When attempting to connect to the specified host engine, how long should
+                                              we wait in milliseconds before giving up */
+    unsigned int addressIsUnixSocket;    /*!< Whether or not the passed-in address is a unix socket filename (1) or a
+                                              TCP/IP address (0) */
+    unsigned int compressMinBytes;       /*!< Compress messages of at least this many bytes in both directions if the
+                                              host engine supports it. This trades CPU for bandwidth, so it is meant
+                                              for remote host engines. Values below 512 are raised to 512. Ignored
+                                              for unix sockets. 0 = don't compress */
+} dcgmConnectV2Params_v3;
+
+/**
+ * Version 3 for \ref dcgmConnectV2Params_v3
+ */
+#define dcgmConnectV2Params_version3 MAKE_DCGM_VERSION(dcgmConnectV2Params_v3, 3)
+
+/**
+ * Connection options for dcgmConnect_v2 (v4)
+ */
+typedef struct
+{
+    unsigned int version;                /*!< Version number. Use dcgmConnectV2Params_version */
+    unsigned int persistAfterDisconnect; /*!< Whether to persist DCGM state modified by this connection once the
+                                              connection is terminated. Normally, all field watches created by a
+                                              connection are removed once a connection goes away. 1 = do not clean up
+                                              after this connection. 0 = clean up after this connection */
+    unsigned int timeoutMs;              /*!< When attempting to connect to the specified host engine, how long should
+                                              we wait in milliseconds before giving up */
+    unsigned int addressIsUnixSocket;    /*!< Whether or not the passed-in address is a unix socket filename (1) or a
+                                              TCP/IP address (0) */
+    unsigned int compressMinBytes;       /*!< Compress messages of at least this many bytes in both directions if the
+                                              host engine supports it. This trades CPU for bandwidth, so it is meant
+                                              for remote host engines. Values below 512 are raised to 512. Ignored
+                                              for unix sockets. 0 = don't compress */
+    unsigned int metadataCache;          /*!< Whether to cache group, field group, entity, MIG hierarchy and
+                                              topology information in the client (1) or not (0). The host engine
+                                              notifies the client when any of them change. The cache is not used
+                                              with host engines that don't support these notifications */
+} dcgmConnectV2Params_v4;
+
+/**
+ * Typedef for \ref dcgmConnectV2Params_v4
+ */
+typedef dcgmConnectV2Params_v4 dcgmConnectV2Params_t;
+
+/**
+ * Version 4 for \ref dcgmConnectV2Params_v4
+ */
+#define dcgmConnectV2Params_version4 MAKE_DCGM_VERSION(dcgmConnectV2Params_v4, 4)
 
 /**
  * Latest version for \ref dcgmConnectV2Params_t
  */
-#define dcgmConnectV2Params_version dcgmConnectV2Params_version2
+#define dcgmConnectV2Params_version dcgmConnectV2Params_version4
 
 /**
  * Typedef for \ref dcgmHostengineHealth_v1
@@ -2028,6 +2088,44 @@ typedef dcgmPolicyCallbackResponse_v2 dcgmPolicyCallbackResponse_t;
  */
 typedef int (*fpRecvUpdates)(dcgmPolicyCallbackResponse_t *response, uint64_t userData);
 
+/**
+ * Coalescing window of \ref dcgmPolicyNotifyOptions_v1 that is used when it is left at 0
+ */
+#define DCGM_POLICY_COALESCE_WINDOW_MS_DEFAULT 100
+
+/**
+ * Longest coalescing window of \ref dcgmPolicyNotifyOptions_v1
+ */
+#define DCGM_POLICY_COALESCE_WINDOW_MS_MAX 10000
+
+/**
+ * How the violations of a registration made with \ref dcgmPolicyRegisterBatched are delivered
+ */
+typedef struct
+{
+    unsigned int version;               //!< Version number (dcgmPolicyNotifyOptions_version)
+    unsigned int coalesceWindowMs;      //!< Violations that occur within this many ms of the first one that is not
+                                        //!< delivered yet are delivered together.
+                                        //!< 0 = DCGM_POLICY_COALESCE_WINDOW_MS_DEFAULT
+    unsigned int maxPerConditionPerSec; //!< Most violations of one condition that are delivered per second, across all
+                                        //!< the GPUs of the registration. Further ones are dropped. 0 = no limit
+} dcgmPolicyNotifyOptions_v1;
+
+/**
+ * Typedef for \ref dcgmPolicyNotifyOptions_v1
+ */
+typedef dcgmPolicyNotifyOptions_v1 dcgmPolicyNotifyOptions_t;
+
+/**
+ * Version 1 for \ref dcgmPolicyNotifyOptions_v1
+ */
+#define dcgmPolicyNotifyOptions_version1 MAKE_DCGM_VERSION(dcgmPolicyNotifyOptions_v1, 1)
+
+/**
+ * Latest version for \ref dcgmPolicyNotifyOptions_t
+ */
+#define dcgmPolicyNotifyOptions_version dcgmPolicyNotifyOptions_version1
+
 /**
  * Set above size of largest blob entry. Currently this is dcgmDeviceVgpuTypeInfo_v1
  */
@@ -2087,6 +2185,118 @@ typedef struct
  */
 #define dcgmFieldValue_version2 MAKE_DCGM_VERSION(dcgmFieldValue_v2, 2)
 
+/**
+ * Field values returned by \ref dcgmGetValuesSinceColumns as parallel arrays, one element per value. Element i of
+ * every array describes the same value. The caller allocates the arrays and sets capacity to the number of elements
+ * each of them can hold.
+ *
+ * Only numeric values are returned. A value is in int64Values or doubleValues depending on fieldTypes. The element of
+ * the other array is DCGM_INT64_BLANK or DCGM_FP64_BLANK.
+ */
+typedef struct
+{
+    unsigned int version;          //!< IN: Version number (dcgmFieldValueColumns_version)
+    unsigned int capacity;         //!< IN: Number of elements each of the arrays below can hold
+    unsigned int count;            //!< OUT: Number of values returned. More than capacity if the arrays were too small
+    unsigned int numSkipped;       //!< OUT: Number of DCGM_FT_STRING and DCGM_FT_BINARY values that were left out
+    unsigned char *entityGroupIds; //!< OUT: dcgm_field_entity_group_t of each value's entity
+    unsigned int *entityIds;       //!< OUT: dcgm_field_eid_t of each value's entity
+    unsigned short *fieldIds;      //!< OUT: One of DCGM_FI_?
+    unsigned char *fieldTypes;     //!< OUT: DCGM_FT_INT64, DCGM_FT_TIMESTAMP or DCGM_FT_DOUBLE
+    int64_t *timestamps;           //!< OUT: Timestamp in usec since 1970
+    int64_t *int64Values;          //!< OUT: Value of DCGM_FT_INT64 and DCGM_FT_TIMESTAMP fields
+    double *doubleValues;          //!< OUT: Value of DCGM_FT_DOUBLE fields
+} dcgmFieldValueColumns_v1;
+
+/**
+ * Version 1 for \ref dcgmFieldValueColumns_v1
+ */
+#define dcgmFieldValueColumns_version1 MAKE_DCGM_VERSION(dcgmFieldValueColumns_v1, 1)
+#define dcgmFieldValueColumns_version  dcgmFieldValueColumns_version1
+typedef dcgmFieldValueColumns_v1 dcgmFieldValueColumns_t;
+
+/**
+ * How \ref dcgmGetResampledValues fills the cell of a row whose time has no sample of its column
+ */
+typedef enum
+{
+    DCGM_RESAMPLE_FILL_NONE     = 0, //!< The latest sample of the step that ends at the row's time. Blank if the
+                                     //!< step has no sample
+    DCGM_RESAMPLE_FILL_PREVIOUS = 1, //!< The latest sample at or before the row's time, however old it is
+    DCGM_RESAMPLE_FILL_LINEAR   = 2, //!< Interpolated linearly between the samples around the row's time. Blank
+                                     //!< if there is no sample after it yet
+} dcgmResampleFill_t;
+
+/**
+ * Most columns a matrix of \ref dcgmGetResampledValues can have
+ */
+#define DCGM_RESAMPLE_MAX_COLUMNS 1024
+
+/**
+ * Field values returned by \ref dcgmGetResampledValues as a dense matrix with a row per time of a grid and a column per
+ * entity and field. The caller allocates the arrays and sets the capacities to the number of elements they can hold.
+ *
+ * Row i is at startTime + i * stepUsec. The cell of row i and column j is values[i * numColumns + j]. Cells without a
+ * value are DCGM_FP64_BLANK. Only numeric fields get columns.
+ */
+typedef struct
+{
+    unsigned int version;                  //!< IN: Version number (dcgmResampledValues_version)
+    unsigned int fill;                     //!< IN: How cells are filled. See \ref dcgmResampleFill_t
+    long long startTime;                   //!< IN: Time of the first row in usec since 1970
+    long long endTime;                     //!< IN: Time in usec since 1970 that the last row is at or before
+    long long stepUsec;                    //!< IN: Time between rows in usec
+    unsigned int columnCapacity;           //!< IN: Number of elements columnEntities and columnFieldIds can hold
+    unsigned int capacity;                 //!< IN: Number of elements values can hold
+    unsigned int numRows;                  //!< OUT: Number of rows
+    unsigned int numColumns;               //!< OUT: Number of columns
+    dcgmGroupEntityPair_t *columnEntities; //!< OUT: Entity of each column
+    unsigned short *columnFieldIds;        //!< OUT: Field of each column. One of DCGM_FI_?
+    double *values;                        //!< OUT: numRows x numColumns values, row after row
+} dcgmResampledValues_v1;
+
+/**
+ * Version 1 for \ref dcgmResampledValues_v1
+ */
+#define dcgmResampledValues_version1 MAKE_DCGM_VERSION(dcgmResampledValues_v1, 1)
+#define dcgmResampledValues_version  dcgmResampledValues_version1
+typedef dcgmResampledValues_v1 dcgmResampledValues_t;
+
+/**
+ * File formats \ref dcgmExportValues can write
+ */
+typedef enum
+{
+    DCGM_EXPORT_FORMAT_ARROW_IPC = 0, //!< Arrow IPC file, also known as Feather V2. See \ref dcgmExportValues_v1
+} dcgmExportFormat_t;
+
+/**
+ * Where and what \ref dcgmExportValues writes.
+ *
+ * An Arrow IPC file has a row per value with the columns timestamp (timestamp[us, UTC]), entity_group_id (uint8),
+ * entity_id (uint32), field_id (uint16), value_int64 (int64) and value_double (double). value_int64 is set for
+ * DCGM_FT_INT64 and DCGM_FT_TIMESTAMP fields and value_double for DCGM_FT_DOUBLE fields. The other one is null, as
+ * are both for blank values. Values of string and binary fields aren't written.
+ */
+typedef struct
+{
+    unsigned int version;                   //!< IN: Version number (dcgmExportValues_version)
+    unsigned int format;                    //!< IN: Format of the file. See \ref dcgmExportFormat_t
+    long long startTime;                    //!< IN: Export values at or after this time in usec since 1970. 0 = all
+    long long endTime;                      //!< IN: Export values at or before this time in usec since 1970.
+                                            //!<     0 = up to the time of the call
+    char filename[DCGM_MAX_STR_LENGTH * 2]; //!< IN: Path of the file to write. Replaced if it exists
+    unsigned long long numValues;           //!< OUT: Number of values written to the file
+    unsigned long long numSkipped;          //!< OUT: Number of values of string and binary fields left out
+} dcgmExportValues_v1;
+
+/**
+ * Version 1 for \ref dcgmExportValues_v1
+ */
+#define dcgmExportValues_version1 MAKE_DCGM_VERSION(dcgmExportValues_v1, 1)
+#define dcgmExportValues_version  dcgmExportValues_version1
+typedef dcgmExportValues_v1 dcgmExportValues_t;
+
 /**
  * Field value flags used by \ref dcgmEntitiesGetLatestValues
  *
@@ -2096,6 +2306,48 @@ typedef struct
  */
 #define DCGM_FV_FLAG_LIVE_DATA 0x00000001
 
+/**
+ * Handle to a read-only view over the latest cached numeric values of an embedded host engine.
+ * See \ref dcgmLatestValueViewOpen
+ */
+typedef uintptr_t dcgmLatestValueView_t;
+
+/**
+ * Slot index returned by \ref dcgmLatestValueViewOpen for an entity and field that could not be
+ * placed in the view
+ */
+#define DCGM_LATEST_VALUE_VIEW_NO_SLOT 0xFFFFFFFF
+
+/**
+ * One numeric value as read from a \ref dcgmLatestValueView_t
+ */
+typedef struct
+{
+    dcgm_field_entity_group_t entityGroupId; //!< Entity group of the value
+    dcgm_field_eid_t entityId;               //!< Entity id of the value
+    unsigned short fieldId;                  //!< Field id of the value
+    unsigned short fieldType;                //!< DCGM_FT_INT64 or DCGM_FT_DOUBLE. Only valid if status is DCGM_ST_OK
+    int status;                              //!< DCGM_ST_OK if value is valid. DCGM_ST_NO_DATA if there is no
+                                             //!< cached value. DCGM_ST_BADPARAM if the slot is invalid
+    int64_t ts;                              //!< Timestamp in usec since 1970
+    union
+    {
+        int64_t i64; //!< Int64 value
+        double dbl;  //!< Double value
+    } value;         //!< Value
+} dcgmLatestValueSample_t;
+
+/**
+ * Handle to the shared memory table of latest values a host engine publishes for local processes.
+ * See \ref dcgmSharedLatestValuesOpen
+ */
+typedef uintptr_t dcgmSharedLatestValues_t;
+
+/**
+ * Name of the shared memory table of latest values if the host engine isn't given one
+ */
+#define DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME "/nvidia-dcgm-latest-values"
+
 /**
  * User callback function for processing one or more field updates. This callback will
  * be invoked one or more times per field until all of the expected field values have been
@@ -2940,6 +3192,48 @@ typedef dcgmDiagStatus_v1 dcgmDiagStatus_t;
  */
 #define dcgmDiagStatus_version dcgmDiagStatus_version1
 
+/**
+ * Results of one test of a diagnostic run, sent as soon as the test completes. The errors, info messages and
+ * per-entity results are those that the test adds to \ref dcgmDiagResponse_v11 at the end of the run.
+ */
+typedef struct
+{
+    unsigned int version;                         //!< The version of this struct
+    unsigned int totalTests;                      //!< The number of tests that will execute
+    unsigned int completedTests;                  //!< The number of tests that have completed, including this one
+    char testName[DCGM_DIAG_TEST_RUN_NAME_LEN];   //!< The name of the test
+    char pluginName[DCGM_DIAG_TEST_RUN_NAME_LEN]; //!< Plugin name that this test belongs to
+    dcgmDiagResult_t result;                      //!< Overall result of the test (PASS, FAIL, SKIP, WARN, NOT_RUN)
+
+    unsigned char numErrors;   //!< Number of entries of errors
+    unsigned char numInfo;     //!< Number of entries of info
+    unsigned short numResults; //!< Number of entries of results
+
+    dcgmDiagError_v1 errors[DCGM_DIAG_TEST_RUN_ERROR_INDICES_MAX]; //!< Per-entity errors of this test
+    dcgmDiagInfo_v1 info[DCGM_DIAG_TEST_RUN_INFO_INDICES_MAX];     //!< Per-entity info messages of this test
+    dcgmDiagEntityResult_v1 results[DCGM_DIAG_TEST_RUN_RESULTS_MAX]; //!< Per-entity results of this test
+} dcgmDiagTestCompletion_v1;
+
+typedef dcgmDiagTestCompletion_v1 dcgmDiagTestCompletion_t;
+
+/**
+ * Version 1 for \ref dcgmDiagTestCompletion_v1
+ */
+#define dcgmDiagTestCompletion_version1 MAKE_DCGM_VERSION(dcgmDiagTestCompletion_v1, 1)
+
+/**
+ * Latest version for \ref dcgmDiagTestCompletion_t
+ */
+#define dcgmDiagTestCompletion_version dcgmDiagTestCompletion_version1
+
+/**
+ * Callback of \ref dcgmRunDiagnosticWithCallback, called once per test as it completes.
+ *
+ * @param completion  IN: Results of the test that completed. Only valid during the call
+ * @param userData    IN: The userData passed to \ref dcgmRunDiagnosticWithCallback
+ */
+typedef void (*dcgmDiagTestCompleted_f)(dcgmDiagTestCompletion_t const *completion, void *userData);
+
 /**
  * Represents level relationships within a system between two GPUs
  * The enums are spaced to allow for future relationships.
@@ -3073,20 +3367,36 @@ typedef struct
     long long bytesUsed;  //!< number of bytes
 } dcgmIntrospectMemory_v1;
 
+/**
+ * DCGM Memory usage information, including the cached sample storage
+ */
+typedef struct
+{
+    unsigned int version;            //!< version number (dcgmIntrospectMemory_version)
+    long long bytesUsed;             //!< number of bytes
+    long long compressedSampleBytes; //!< number of bytes of cached samples held compressed. 0 unless compressed
+                                     //!< sample storage is enabled in the host engine
+} dcgmIntrospectMemory_v2;
+
 /**
  * Typedef for \ref dcgmIntrospectMemory_t
  */
-typedef dcgmIntrospectMemory_v1 dcgmIntrospectMemory_t;
+typedef dcgmIntrospectMemory_v2 dcgmIntrospectMemory_t;
 
 /**
  * Version 1 for \ref dcgmIntrospectMemory_t
  */
 #define dcgmIntrospectMemory_version1 MAKE_DCGM_VERSION(dcgmIntrospectMemory_v1, 1)
 
+/**
+ * Version 2 for \ref dcgmIntrospectMemory_t
+ */
+#define dcgmIntrospectMemory_version2 MAKE_DCGM_VERSION(dcgmIntrospectMemory_v2, 2)
+
 /**
  * Latest version for \ref dcgmIntrospectMemory_t
  */
-#define dcgmIntrospectMemory_version dcgmIntrospectMemory_version1
+#define dcgmIntrospectMemory_version dcgmIntrospectMemory_version2
 
 /**
  * DCGM CPU Utilization information.  Multiply values by 100 to get them in %.
@@ -3099,20 +3409,214 @@ typedef struct
     double user;          //!< fraction of device's CPU resources that were used in user mode
 } dcgmIntrospectCpuUtil_v1;
 
+/**
+ * Maximum number of entries in \ref dcgmIntrospectCpuUtil_v2.threads
+ */
+#define DCGM_INTROSPECT_MAX_THREAD_CPU_UTILS 64
+
+/**
+ * Maximum length of a thread name, including the terminating NUL. This is the Linux limit
+ */
+#define DCGM_INTROSPECT_THREAD_NAME_LEN 16
+
+/**
+ * CPU utilization of the host engine threads that share a name.  Multiply values by 100 to get them in %.
+ */
+typedef struct
+{
+    char name[DCGM_INTROSPECT_THREAD_NAME_LEN]; //!< Name of the threads, like "cache_mgr_main" or "dcgm_ipc"
+    unsigned int numThreads;                    //!< Number of threads that currently have this name
+    double total;                               //!< fraction of device's CPU resources used by these threads
+    double kernel;                              //!< fraction of device's CPU resources used in kernel mode
+    double user;                                //!< fraction of device's CPU resources used in user mode
+} dcgmIntrospectThreadCpuUtil_v1;
+
+/**
+ * DCGM CPU Utilization information, broken down by thread.  Multiply values by 100 to get them in %.
+ */
+typedef struct
+{
+    unsigned int version;        //!< version number (dcgmIntrospectCpuUtil_version)
+    double total;                //!< fraction of device's CPU resources that were used
+    double kernel;               //!< fraction of device's CPU resources that were used in kernel mode
+    double user;                 //!< fraction of device's CPU resources that were used in user mode
+    unsigned int numThreadUtils; //!< Number of entries of threads[] that are populated
+    dcgmIntrospectThreadCpuUtil_v1 threads[DCGM_INTROSPECT_MAX_THREAD_CPU_UTILS]; //!< Threads grouped by name.
+                                                                                   //!< Highest total first
+} dcgmIntrospectCpuUtil_v2;
+
 /**
  * Typedef for \ref dcgmIntrospectCpuUtil_t
  */
-typedef dcgmIntrospectCpuUtil_v1 dcgmIntrospectCpuUtil_t;
+typedef dcgmIntrospectCpuUtil_v2 dcgmIntrospectCpuUtil_t;
 
 /**
  * Version 1 for \ref dcgmIntrospectCpuUtil_t
  */
 #define dcgmIntrospectCpuUtil_version1 MAKE_DCGM_VERSION(dcgmIntrospectCpuUtil_v1, 1)
 
+/**
+ * Version 2 for \ref dcgmIntrospectCpuUtil_t
+ */
+#define dcgmIntrospectCpuUtil_version2 MAKE_DCGM_VERSION(dcgmIntrospectCpuUtil_v2, 2)
+
 /**
  * Latest version for \ref dcgmIntrospectCpuUtil_t
  */
-#define dcgmIntrospectCpuUtil_version dcgmIntrospectCpuUtil_version1
+#define dcgmIntrospectCpuUtil_version dcgmIntrospectCpuUtil_version2
+
+/**
+ * Maximum number of entries in \ref dcgmIntrospectFieldCosts_t
+ */
+#define DCGM_INTROSPECT_MAX_FIELD_COSTS 2048
+
+/**
+ * Flags for \ref dcgmIntrospectFieldCost_v1.flags
+ */
+#define DCGM_INTROSPECT_FIELD_COST_F_PUSHED 0x0001 //!< Samples are pushed to the cache by a module like NvSwitch or
+                                                   //!< sysmon. Exec times aren't measured for these fields
+
+/**
+ * What it costs the host engine to keep one watched field of one entity up to date
+ */
+typedef struct
+{
+    dcgm_field_entity_group_t entityGroupId; //!< Entity group of the watch. DCGM_FE_NONE for global fields
+    dcgm_field_eid_t entityId;               //!< Entity ID of the watch. 0 for global fields
+    unsigned short fieldId;                  //!< One of DCGM_FI_?
+    unsigned short flags;                    //!< Mask of DCGM_INTROSPECT_FIELD_COST_F_?
+    long long fetchCount;                    //!< Number of times this field has been fetched or pushed
+    long long execTimeUsec;                  //!< Total time in usec spent fetching this field from the driver
+    long long maxExecTimeUsec;               //!< Longest single fetch of this field in usec
+    long long bytesUsed;                     //!< Bytes of cached samples held for this field
+} dcgmIntrospectFieldCost_v1;
+
+/**
+ * Per-field costs of every watch in the host engine, most expensive first
+ */
+typedef struct
+{
+    unsigned int version;       //!< version number (dcgmIntrospectFieldCosts_version)
+    unsigned int numFieldCosts; //!< Number of entries of fieldCosts[] that are populated
+    unsigned int numWatches;    //!< Number of watches in the host engine. If this is more than numFieldCosts, only
+                                //!< the DCGM_INTROSPECT_MAX_FIELD_COSTS most expensive ones were returned
+    dcgmIntrospectFieldCost_v1 fieldCosts[DCGM_INTROSPECT_MAX_FIELD_COSTS]; //!< Ordered by execTimeUsec, then by
+                                                                             //!< bytesUsed. Largest first
+} dcgmIntrospectFieldCosts_v1;
+
+/**
+ * Typedef for \ref dcgmIntrospectFieldCosts_t
+ */
+typedef dcgmIntrospectFieldCosts_v1 dcgmIntrospectFieldCosts_t;
+
+/**
+ * Version 1 for \ref dcgmIntrospectFieldCosts_t
+ */
+#define dcgmIntrospectFieldCosts_version1 MAKE_DCGM_VERSION(dcgmIntrospectFieldCosts_v1, 1)
+
+/**
+ * Latest version for \ref dcgmIntrospectFieldCosts_t
+ */
+#define dcgmIntrospectFieldCosts_version dcgmIntrospectFieldCosts_version1
+
+/**
+ * Maximum number of entries in \ref dcgmIntrospectLockProfile_t
+ */
+#define DCGM_INTROSPECT_MAX_LOCK_SITES 256
+
+/**
+ * Number of buckets of the histograms of \ref dcgmIntrospectLockSite_v1. Bucket 0 counts times under 1 usec,
+ * bucket i times in [2^(i-1), 2^i) usec and the last bucket everything longer
+ */
+#define DCGM_INTROSPECT_LOCK_HIST_BUCKETS 16
+
+/**
+ * How one place in the host engine source uses one of its mutexes
+ */
+typedef struct
+{
+    char mutexName[32];        //!< Name of the mutex, like "CacheManager"
+    char file[64];             //!< Source file that locks the mutex. Truncated from the left if too long
+    unsigned int line;         //!< Line of file that locks the mutex
+    unsigned int unused;       //!< Padding
+    long long lockCount;       //!< Number of exclusive locks
+    long long sharedLockCount; //!< Number of shared locks
+    long long waitUsec;        //!< Total usec spent waiting to acquire the mutex
+    long long holdUsec;        //!< Total usec the mutex was held for
+    long long maxWaitUsec;     //!< Longest wait in usec
+    long long maxHoldUsec;     //!< Longest hold in usec
+    unsigned int waitHistogram[DCGM_INTROSPECT_LOCK_HIST_BUCKETS]; //!< Number of waits by duration
+    unsigned int holdHistogram[DCGM_INTROSPECT_LOCK_HIST_BUCKETS]; //!< Number of holds by duration
+} dcgmIntrospectLockSite_v1;
+
+/**
+ * Contention profile of the host engine's mutexes. Only populated if nv-hostengine was started with
+ * __DCGM_MUTEX_PROFILING__=1
+ */
+typedef struct
+{
+    unsigned int version;       //!< version number (dcgmIntrospectLockProfile_version)
+    unsigned int numSites;      //!< Number of entries of sites[] that are populated
+    unsigned int numSitesTotal; //!< Number of places that locked a profiled mutex. If this is more than numSites,
+                                //!< only the DCGM_INTROSPECT_MAX_LOCK_SITES that waited longest were returned
+    unsigned int unused;        //!< Padding
+    dcgmIntrospectLockSite_v1 sites[DCGM_INTROSPECT_MAX_LOCK_SITES]; //!< Ordered by waitUsec. Largest first
+} dcgmIntrospectLockProfile_v1;
+
+/**
+ * Typedef for \ref dcgmIntrospectLockProfile_t
+ */
+typedef dcgmIntrospectLockProfile_v1 dcgmIntrospectLockProfile_t;
+
+/**
+ * Version 1 for \ref dcgmIntrospectLockProfile_t
+ */
+#define dcgmIntrospectLockProfile_version1 MAKE_DCGM_VERSION(dcgmIntrospectLockProfile_v1, 1)
+
+/**
+ * Latest version for \ref dcgmIntrospectLockProfile_t
+ */
+#define dcgmIntrospectLockProfile_version dcgmIntrospectLockProfile_version1
+
+/**
+ * Counters of the host engine's cache manager since it started. Take two snapshots and subtract them to get
+ * the rates over an interval
+ */
+typedef struct
+{
+    unsigned int version;            //!< version number (dcgmIntrospectRuntimeStats_version)
+    unsigned int unused;             //!< Padding
+    long long updateCycles;          //!< Number of update cycles of watched fields that finished
+    long long awakeTimeUsec;         //!< Total usec the update thread spent running update cycles
+    long long sleepTimeUsec;         //!< Total usec the update thread spent sleeping between update cycles
+    long long numSleepsDone;         //!< Number of times the update thread slept
+    long long numSleepsSkipped;      //!< Number of times the update thread didn't sleep because a cycle ran long
+    long long updatesCoalesced;      //!< Requests to update all fields that joined an update cycle already queued
+    long long lockCount;             //!< Number of times the cache manager mutex was locked
+    long long lockContendedCount;    //!< Number of those locks that had to wait for another thread
+    long long lockContendedWaitUsec; //!< Total usec spent waiting for the cache manager mutex
+    long long latestValueHits;       //!< Latest-value reads served without taking the cache manager mutex
+    long long latestValueMisses;     //!< Latest-value reads that fell back to the cache manager mutex
+    long long latestValueContended;  //!< Latest-value reads that had to wait for a writer
+    long long compressedSampleBytes; //!< Bytes of encoded samples held by compressed timeseries
+    long long arenaReservedBytes;    //!< Bytes held from the heap for string and blob samples
+    long long arenaLiveBytes;        //!< Bytes of those holding samples that haven't been evicted
+} dcgmIntrospectRuntimeStats_v1;
+
+/**
+ * Typedef for \ref dcgmIntrospectRuntimeStats_t
+ */
+typedef dcgmIntrospectRuntimeStats_v1 dcgmIntrospectRuntimeStats_t;
+
+/**
+ * Version 1 for \ref dcgmIntrospectRuntimeStats_t
+ */
+#define dcgmIntrospectRuntimeStats_version1 MAKE_DCGM_VERSION(dcgmIntrospectRuntimeStats_v1, 1)
+
+/**
+ * Latest version for \ref dcgmIntrospectRuntimeStats_t
+ */
+#define dcgmIntrospectRuntimeStats_version dcgmIntrospectRuntimeStats_version1
 
 #define DCGM_MAX_CONFIG_FILE_LEN   10000
 #define DCGM_MAX_TEST_NAMES        20
@@ -3397,6 +3901,17 @@ typedef dcgmNvLinkStatus_v4 dcgmNvLinkStatus_t;
 #define DCGM_SUMMARY_DIFF     0x00000040
 #define DCGM_SUMMARY_SIZE     7
 
+/* Percentiles, within 1% of a sample's value. Only answered for dcgmFieldSummaryRequest_v2 */
+#define DCGM_SUMMARY_P50     0x00000080
+#define DCGM_SUMMARY_P95     0x00000100
+#define DCGM_SUMMARY_P99     0x00000200
+#define DCGM_SUMMARY_SIZE_V2 10
+
+/**
+ * Maximum number of histogram buckets a dcgmFieldSummaryRequest_v2 can ask for
+ */
+#define DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS 32
+
 /* dcgmSummaryResponse_t is part of dcgmFieldSummaryRequest, so it uses dcgmFieldSummaryRequest's version. */
 
 typedef struct
@@ -3431,6 +3946,50 @@ typedef dcgmFieldSummaryRequest_v1 dcgmFieldSummaryRequest_t;
 
 #define dcgmFieldSummaryRequest_version1 MAKE_DCGM_VERSION(dcgmFieldSummaryRequest_v1, 1)
 
+/* dcgmSummaryResponse_v2 is part of dcgmFieldSummaryRequest_v2, so it uses dcgmFieldSummaryRequest_v2's version. */
+
+typedef struct
+{
+    unsigned int fieldType;    //!< type of field that is summarized (int64 or fp64)
+    unsigned int summaryCount; //!< the number of populated summaries in \ref values
+    union
+    {
+        int64_t i64;
+        double fp64;
+    } values[DCGM_SUMMARY_SIZE_V2]; //!< array for storing the values of each summary. The summaries are stored
+                                    //!< in order, same as dcgmSummaryResponse_t
+    long long histogramCounts[DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS]; //!< number of samples in each histogram bucket.
+                                                                   //!< The first histogramBucketCount are populated.
+                                                                   //!< Approximate, within 1% of a bucket's edges
+} dcgmSummaryResponse_v2;
+
+/**
+ * Version 2 of dcgmFieldSummaryRequest. Adds percentile summaries and a histogram of the values.
+ *
+ * Pass it to dcgmGetFieldSummary() cast to a dcgmFieldSummaryRequest_t *
+ */
+typedef struct
+{
+    unsigned int version;                    //!< version of this message - dcgmFieldSummaryRequest_version2
+    unsigned short fieldId;                  //!< field id to be summarized
+    dcgm_field_entity_group_t entityGroupId; //!< the type of entity whose field we're getting
+    dcgm_field_eid_t entityId;               //!< ordinal id for this entity
+    uint32_t summaryTypeMask;                //!< bit-mask of DCGM_SUMMARY_*, the requested summaries
+    uint64_t startTime;                      //!< start time for the interval being summarized. 0 means to use
+                                             //!< any data before.
+    uint64_t endTime;                        //!< end time for the interval being summarized. 0 means to use
+                                             //!< any data after.
+    unsigned int histogramBucketCount;       //!< number of histogram buckets to count samples in. 0 for no
+                                             //!< histogram. At most DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS
+    double histogramMin;                     //!< lower edge of the first histogram bucket
+    double histogramMax;                     //!< upper edge of the last histogram bucket. Buckets are equally
+                                             //!< wide. Samples outside of [histogramMin, histogramMax] count
+                                             //!< toward the first or last bucket
+    dcgmSummaryResponse_v2 response;         //!< response data for this request
+} dcgmFieldSummaryRequest_v2;
+
+#define dcgmFieldSummaryRequest_version2 MAKE_DCGM_VERSION(dcgmFieldSummaryRequest_v2, 2)
+
 /**
  * Module IDs
  */
@@ -3489,8 +4048,43 @@ typedef struct
  * Version 1 of dcgmModuleGetStatuses
  */
 #define dcgmModuleGetStatuses_version1 MAKE_DCGM_VERSION(dcgmModuleGetStatuses_v1, 1)
-#define dcgmModuleGetStatuses_version  dcgmModuleGetStatuses_version1
-typedef dcgmModuleGetStatuses_v1 dcgmModuleGetStatuses_t;
+
+/**
+ * When the host engine loads a module
+ */
+typedef enum
+{
+    DcgmModuleLoadOnDemand = 0, //!< Module is loaded by the first request that needs it
+    DcgmModuleLoadPrewarm  = 1, /*!< Module is loaded in the background once the host engine is ready
+                                     to serve requests. A request that arrives first still loads it. */
+} dcgmModuleLoadPolicy_t;
+
+/**
+ * Status, load policy and init time of a module of the host engine
+ */
+typedef struct
+{
+    dcgmModuleId_t id;                 //!< ID of this module
+    dcgmModuleStatus_t status;         //!< Status of this module
+    dcgmModuleLoadPolicy_t loadPolicy; //!< When this module is loaded
+    unsigned int unused;               //!< Padding. Always 0
+    long long initTimeUsec;            /*!< Time spent loading and initializing this module in usec.
+                                            0 if the module has not been loaded */
+} dcgmModuleGetStatusesModule_v2;
+
+typedef struct
+{
+    unsigned int version;     //!< Version of this request. Should be dcgmModuleGetStatuses_version2
+    unsigned int numStatuses; //!< Number of entries in statuses[] that are populated
+    dcgmModuleGetStatusesModule_v2 statuses[DCGM_MODULE_STATUSES_CAPACITY]; //!< Per-module status information
+} dcgmModuleGetStatuses_v2;
+
+/**
+ * Version 2 of dcgmModuleGetStatuses
+ */
+#define dcgmModuleGetStatuses_version2 MAKE_DCGM_VERSION(dcgmModuleGetStatuses_v2, 2)
+#define dcgmModuleGetStatuses_version  dcgmModuleGetStatuses_version2
+typedef dcgmModuleGetStatuses_v2 dcgmModuleGetStatuses_t;
 
 /**
  * Options for dcgmStartEmbedded_v2
@@ -3589,6 +4183,48 @@ typedef struct
 #define dcgmProfGetMetricGroups_version  dcgmProfGetMetricGroups_version3
 typedef dcgmProfGetMetricGroups_v3 dcgmProfGetMetricGroups_t;
 
+/**
+ * Maximum number of fields \ref dcgmProfGetMultiplexInfo can report
+ */
+#define DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS 64
+
+/**
+ * How the profiling fields watched for a group of GPUs are time-multiplexed. See \ref dcgmProfGetMultiplexInfo
+ */
+typedef struct
+{
+    /** \name Input parameters
+     * @{
+     */
+    unsigned int version; //!< Version of this request. Should be dcgmProfMultiplexInfo_version
+    dcgmGpuGrp_t groupId; //!< Group of GPUs the profiling fields were watched for
+    /**
+     * @}
+     */
+
+    /** \name Output
+     * @{
+     */
+    unsigned int numPasses;   //!< Number of passes the watched fields are rotated through. 0 if the fields of groupId
+                              //!< are collected in a single pass and aren't multiplexed
+    long long windowUsec;     //!< How long each pass is watched in usec
+    unsigned int numFieldIds; //!< Number of entries that are populated in fieldIds[] and sampledFraction[]
+    unsigned short fieldIds[DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS]; //!< DCGM_FI_PROF_* fields that are multiplexed
+    double sampledFraction[DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS];  //!< Fraction of the time fieldIds[i] is collected.
+                                                                //!< Its cached values are estimates for the whole
+                                                                //!< time, based on this fraction of it
+    /**
+     * @}
+     */
+} dcgmProfMultiplexInfo_v1;
+
+/**
+ * Version 1 of dcgmProfMultiplexInfo_t
+ */
+#define dcgmProfMultiplexInfo_version1 MAKE_DCGM_VERSION(dcgmProfMultiplexInfo_v1, 1)
+#define dcgmProfMultiplexInfo_version  dcgmProfMultiplexInfo_version1
+typedef dcgmProfMultiplexInfo_v1 dcgmProfMultiplexInfo_t;
+
 /**
  * Version 1 of dcgmSettingsSetLoggingSeverity_t
  */
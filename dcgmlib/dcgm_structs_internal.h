@@ -185,6 +185,7 @@ typedef enum
     DcgmWatcherTypeCacheManager    = 4, /* Watcher is DcgmCacheManager */
     DcgmWatcherTypeConfigManager   = 5, /* Watcher is DcgmConfigMgr */
     DcgmWatcherTypeNvSwitchManager = 6, /* Watcher is NvSwitchManager */
+    DcgmWatcherTypeDiagManager     = 7, /* Watcher is DcgmDiagManager */
 
     DcgmWatcherTypeCount /* Should always be last */
 } DcgmWatcherType_t;
@@ -379,6 +380,31 @@ typedef struct
 #define dcgmModuleDenylist_version1 MAKE_DCGM_VERSION(dcgmModuleDenylist_v1, 1)
 
 
+/**
+ * Sent by NVVS over its channel fd instead of the diag response when it wrote the response
+ * into the shared memory region passed with --response-fd
+ */
+typedef struct
+{
+    unsigned int version;         /*!< Version. Should be dcgmDiagResponseReady_version1 */
+    unsigned int responseVersion; /*!< Version of the dcgmDiagResponse_v* at the start of the region */
+    unsigned int responseSize;    /*!< Size in bytes of that response */
+} dcgmDiagResponseReady_v1;
+
+#define dcgmDiagResponseReady_version1 MAKE_DCGM_VERSION(dcgmDiagResponseReady_v1, 1)
+
+/**
+ * Sent by an NVVS worker (nvvs --worker-fd) over its channel fd after each run it was asked to do
+ */
+typedef struct
+{
+    unsigned int version; /*!< Version. Should be dcgmNvvsRunDone_version1 */
+    int returnCode;       /*!< What nvvs would have exited with for this run. See NvvsExitCode.h */
+} dcgmNvvsRunDone_v1;
+
+#define dcgmNvvsRunDone_version1 MAKE_DCGM_VERSION(dcgmNvvsRunDone_v1, 1)
+
+
 /**
  * Counter to use for NvLink
  */
@@ -422,7 +448,9 @@ typedef enum dcgmEntityStatusType_enum
                                    returning NVML_ERROR_GPU_IS_LOST */
     DcgmEntityStatusFake,         /* Entity is a fake, injection-only entity for testing */
     DcgmEntityStatusDisabled,     /* Don't collect values from this GPU */
-    DcgmEntityStatusDetached      /* Entity is detached, not good for any uses */
+    DcgmEntityStatusDetached,     /* Entity is detached, not good for any uses */
+    DcgmEntityStatusQuarantined   /* Driver calls to the GPU keep timing out. Its fields are only
+                                     updated by a periodic probe until a call completes in time */
 } DcgmEntityStatus_t;
 
 /**
@@ -564,6 +592,13 @@ typedef struct
 
 #define SAMPLES_BUFFER_SIZE_V2 4186112 // 4MB - 8k for header
 
+/**
+ * Internal flag for dcgmEntitiesGetLatestValues_v3.flags. Asks the host engine to return buffer[] as a
+ * DcgmFvColumns payload rather than a serialized DcgmFvBuffer. Host engines that don't know this flag
+ * ignore it, so check the payload with DcgmFvColumns::IsColumnar()
+ */
+#define DCGM_FV_FLAG_COLUMNAR_RESPONSE 0x80000000
+
 /**
  * Version 2 of dcgmEntitiesGetLatestValues_t
  */
@@ -635,6 +670,58 @@ typedef struct
     char buffer[SAMPLES_BUFFER_SIZE_V2]; //!< OUT:: this field is last, and can be truncated for speed */
 } dcgmGetMultipleValuesForField_v2;
 
+/* Largest chunk of values a values cursor returns at once */
+#define DCGM_VALUES_CURSOR_BUFFER_SIZE 262144
+
+/**
+ * Request for dcgmValuesSinceCursorOpen, dcgmValuesSinceCursorNext and dcgmValuesSinceCursorClose
+ */
+typedef struct
+{
+    unsigned int groupId;                         //!< IN: Group to open a cursor over (open)
+    unsigned int fieldGroupId;                    //!< IN: Fields to open a cursor over (open)
+    long long sinceTimestamp;                     //!< IN: Return values from this timestamp on (open)
+    unsigned int cursorId;                        //!< IN: Cursor (next, close). OUT: New cursor (open)
+    unsigned int done;                            //!< OUT: 1 if this was the cursor's last chunk (next)
+    long long nextSinceTimestamp;                 //!< OUT: sinceTimestamp to continue from once done (next)
+    unsigned int cmdRet;                          //!< OUT: Error code generated
+    unsigned int bufferSize;                      //!< OUT: Length of populated buffer (next)
+    char buffer[DCGM_VALUES_CURSOR_BUFFER_SIZE]; //!< OUT: Serialized DcgmFvBuffer. This field is last, and can be
+                                                  //!<      truncated for speed
+} dcgmValuesCursor_v1;
+
+/* Most values of a resampled matrix that are returned at once */
+#define DCGM_RESAMPLE_BUFFER_VALUES 32768
+
+/**
+ * Column of a resampled matrix
+ */
+typedef struct
+{
+    unsigned short entityGroupId; //!< dcgm_field_entity_group_t of the column's entity
+    unsigned short fieldId;       //!< Field of the column
+    unsigned int entityId;        //!< dcgm_field_eid_t of the column's entity
+} dcgmResampleColumn_t;
+
+/**
+ * Request for a chunk of rows of dcgmGetResampledValues
+ */
+typedef struct
+{
+    unsigned int groupId;                                    //!< IN: Group ID representing collection of entities
+    unsigned int fieldGroupId;                               //!< IN: Fields to resample
+    long long startTime;                                     //!< IN: Time of the first row in usec since 1970
+    long long stepUsec;                                      //!< IN: Time between rows in usec
+    unsigned int fill;                                       //!< IN: See dcgmResampleFill_t
+    unsigned int numRows;                                    //!< IN: Rows to return. OUT: Rows returned, fewer if
+                                                             //!<     they don't all fit in values
+    unsigned int numColumns;                                 //!< OUT: Number of columns
+    unsigned int cmdRet;                                     //!< OUT: Error code generated
+    dcgmResampleColumn_t columns[DCGM_RESAMPLE_MAX_COLUMNS]; //!< OUT: Entity and field of each column
+    double values[DCGM_RESAMPLE_BUFFER_VALUES];              //!< OUT: numRows x numColumns values, row after row. This
+                                                             //!<      field is last, and can be truncated for speed
+} dcgmResampleValues_v1;
+
 /**
  * Version 1 of dcgmJobCmd_t
  */
@@ -699,6 +786,29 @@ typedef struct
     unsigned int cmdRet; //!< OUT: Error code generated
 } dcgmUpdateAllFields_v1;
 
+/**
+ * Version 1 of dcgmUpdateFields_v1
+ */
+typedef struct
+{
+    unsigned int groupId;      //!< IN: Group ID representing collection of one or more entities
+    unsigned int fieldGroupId; //!< IN: Fields to update
+    int waitForUpdate;         //!< IN: Whether or not to wait for the update to complete before returning to the
+                               //       caller 1=wait. 0=do not wait.
+    unsigned int cmdRet;       //!< OUT: Error code generated
+} dcgmUpdateFields_v1;
+
+/**
+ * Version 1 of dcgmSnapshotFields_v1
+ */
+typedef struct
+{
+    unsigned int groupId;      //!< IN: Group ID representing collection of one or more entities
+    unsigned int fieldGroupId; //!< IN: Fields to sample
+    long long snapshotId;      //!< OUT: ID of the snapshot. The timestamp of its samples
+    unsigned int cmdRet;       //!< OUT: Error code generated
+} dcgmSnapshotFields_v1;
+
 /**
  * Version 1 of dcgmUnwatchFieldValue_t
  */
@@ -727,6 +837,20 @@ typedef struct
 #define dcgmInjectFieldValueMsg_version  dcgmInjectFieldValueMsg_version1
 typedef dcgmInjectFieldValueMsg_v1 dcgmInjectFieldValueMsg_t;
 
+/* Largest batch of values one inject field values request carries */
+#define DCGM_INJECT_FIELD_VALUES_BUFFER_SIZE 262144
+
+/**
+ * Request for dcgmInjectEntityFieldValues
+ */
+typedef struct
+{
+    unsigned int cmdRet;                               //!< OUT: Error code generated
+    unsigned int bufferSize;                           //!< IN: Length of populated buffer
+    char buffer[DCGM_INJECT_FIELD_VALUES_BUFFER_SIZE]; //!< IN: Serialized DcgmFvBuffer. This field is last, and can
+                                                       //!<     be truncated for speed
+} dcgmInjectFieldValues_v1;
+
 /**
  * Version 2 of dcgmGetCacheManagerFieldInfo_t
  */
@@ -807,6 +931,12 @@ typedef struct
     unsigned int cmdRet;           //!< OUT: Error code generated
 } dcgmGetFieldSummary_v1;
 
+typedef struct
+{
+    dcgmFieldSummaryRequest_v2 fsr; //!< IN/OUT: field summary populated on success
+    unsigned int cmdRet;            //!< OUT: Error code generated
+} dcgmGetFieldSummary_v2;
+
 typedef struct
 {
     dcgmNvLinkStatus_v4 ls; //!< IN/OUT: nvlink status populated on success
@@ -833,10 +963,16 @@ typedef struct
 
 typedef struct
 {
-    dcgmModuleGetStatuses_t st; //!< IN/OUT: module status
-    unsigned int cmdRet;        //!< OUT: Error code generated
+    dcgmModuleGetStatuses_v1 st; //!< IN/OUT: module status
+    unsigned int cmdRet;         //!< OUT: Error code generated
 } dcgmMsgModuleStatus_v1;
 
+typedef struct
+{
+    dcgmModuleGetStatuses_v2 st; //!< IN/OUT: module status, load policy and init time
+    unsigned int cmdRet;         //!< OUT: Error code generated
+} dcgmMsgModuleStatus_v2;
+
 typedef struct
 {
     unsigned int overallHealth; //!< IN/OUT: hostengine health
@@ -939,7 +1075,10 @@ DCGM_CASSERT(dcgmWorkloadPowerProfileProfilesInfo_version == (long)0x1002bdc, 1)
 DCGM_CASSERT(dcgmDeviceWorkloadPowerProfilesStatus_version1 == (long)0x1000064, 1);
 DCGM_CASSERT(dcgmDeviceWorkloadPowerProfilesStatus_version == (long)0x1000064, 1);
 DCGM_CASSERT(dcgmConnectV2Params_version1 == (long)16777224, 1);
-DCGM_CASSERT(dcgmConnectV2Params_version == (long)0x02000010, 1);
+DCGM_CASSERT(dcgmConnectV2Params_version2 == (long)0x02000010, 1);
+DCGM_CASSERT(dcgmConnectV2Params_version3 == (long)0x03000014, 1);
+DCGM_CASSERT(dcgmConnectV2Params_version4 == (long)0x04000018, 1);
+DCGM_CASSERT(dcgmConnectV2Params_version == (long)0x04000018, 1);
 DCGM_CASSERT(dcgmCpuHierarchyOwnedCores_version1 == (long)0x1000088, 1);
 DCGM_CASSERT(dcgmCpuHierarchy_version1 == (long)0x1000488, 1);
 DCGM_CASSERT(dcgmCpuHierarchy_version2 == (long)0x2000C88, 1);
@@ -948,8 +1087,12 @@ DCGM_CASSERT(dcgmAllFieldGroup_version == (long)16811016, 1);
 DCGM_CASSERT(dcgmDeviceAttributes_version3 == (long)0x3001464, 1);
 DCGM_CASSERT(dcgmDeviceAttributes_version == (long)0x3001464, 1);
 DCGM_CASSERT(dcgmHealthResponse_version5 == (long)0x510500c, 5);
-DCGM_CASSERT(dcgmIntrospectMemory_version == (long)16777232, 1);
-DCGM_CASSERT(dcgmIntrospectCpuUtil_version == (long)16777248, 1);
+DCGM_CASSERT(dcgmIntrospectMemory_version1 == (long)16777232, 1);
+DCGM_CASSERT(dcgmIntrospectMemory_version == (long)0x2000018, 2);
+DCGM_CASSERT(dcgmIntrospectCpuUtil_version1 == (long)16777248, 1);
+DCGM_CASSERT(dcgmIntrospectCpuUtil_version == (long)0x2000c28, 2);
+DCGM_CASSERT(dcgmIntrospectFieldCosts_version == (long)0x1018010, 1);
+DCGM_CASSERT(dcgmIntrospectLockProfile_version == (long)0x1011810, 1);
 DCGM_CASSERT(dcgmJobInfo_version == (long)0x030098A8, 1);
 DCGM_CASSERT(dcgmPolicy_version == (long)16777360, 1);
 DCGM_CASSERT(dcgmPolicyCallbackResponse_version == (long)33554464, 2);
@@ -969,7 +1112,9 @@ DCGM_CASSERT(dcgmVgpuDeviceAttributes_version7 == (long)117451168, 1);
 DCGM_CASSERT(dcgmVgpuDeviceAttributes_version == (long)117451168, 1);
 DCGM_CASSERT(dcgmVgpuInstanceAttributes_version == (long)16777556, 1);
 DCGM_CASSERT(dcgmVgpuConfig_version == (long)16777256, 1);
-DCGM_CASSERT(dcgmModuleGetStatuses_version == (long)0x01000088, 1);
+DCGM_CASSERT(dcgmModuleGetStatuses_version1 == (long)0x01000088, 1);
+DCGM_CASSERT(dcgmModuleGetStatuses_version2 == (long)0x02000188, 2);
+DCGM_CASSERT(dcgmModuleGetStatuses_version == (long)0x02000188, 2);
 DCGM_CASSERT(dcgmModuleDenylist_version1 == (long)0x01000008, 1);
 DCGM_CASSERT(dcgmSettingsSetLoggingSeverity_version1 == (long)0x01000008, 1);
 DCGM_CASSERT(dcgmVersionInfo_version == (long)0x2000204, 1);
@@ -978,7 +1123,10 @@ DCGM_CASSERT(dcgmStartEmbeddedV2Params_version2 == (long)0x02000050, 2);
 DCGM_CASSERT(dcgmInjectFieldValue_version1 == (long)0x1001018, 1);
 DCGM_CASSERT(dcgmInjectFieldValue_version == (long)0x1001018, 1);
 DCGM_CASSERT(dcgmNvLinkStatus_version4 == (long)0x40039BC, 4);
+DCGM_CASSERT(dcgmDiagTestCompletion_version1 == (long)0x100A414, 1);
 DCGM_CASSERT(dcgmDiagStatus_version1 == (long)0x1000090, 1);
+DCGM_CASSERT(dcgmDiagResponseReady_version1 == (long)0x100000C, 1);
+DCGM_CASSERT(dcgmNvvsRunDone_version1 == (long)0x1000008, 1);
 
 #ifndef DCGM_ARRAY_CAPACITY
 #ifdef __cplusplus
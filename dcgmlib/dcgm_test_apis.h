@@ -52,6 +52,50 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmEngineRun(unsigned short portNumber,
                                            char const *socketPath,
                                            unsigned int isConnectionTCP);
 
+/**
+ * This method starts serving the latest values of watched fields as OpenMetrics text at /metrics
+ *
+ * @param portNumber      IN: TCP port to listen on
+ * @param bindAddress     IN: IPv4 address to listen on. "" or NULL = All interfaces
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmEngineRunMetricsServer(unsigned short portNumber, char const *bindAddress);
+
+/**
+ * This method watches numeric fields on all GPUs and copies their latest values into a shared memory segment as they
+ * are cached, so that local processes can read them with dcgmSharedLatestValuesOpen() without connecting
+ *
+ * @param name            IN: Name of the segment. "" or NULL = DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME
+ * @param fieldIds        IN: Numeric fields to share
+ * @param fieldCount      IN: Number of entries in fieldIds
+ * @param updateFreqUsec  IN: How often to update the fields in usec
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmEngineRunSharedLatestValues(char const *name,
+                                                             unsigned short const *fieldIds,
+                                                             unsigned int fieldCount,
+                                                             long long updateFreqUsec);
+
+/**
+ * This method starts the Host Engine Server on a socket that is already bound and listening, like one passed by
+ * systemd socket activation
+ *
+ * @param listenFd        IN: The listening socket. The host engine owns it from here on
+ * @param isConnectionTCP IN: Whether listenFd is a TCP/IP socket (1) or a unix domain socket (0)
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmEngineRunOnSocket(int listenFd, unsigned int isConnectionTCP);
+
+/**
+ * This method waits for the Host Engine to finish attaching the GPUs when it attaches them in the background
+ *
+ * @param timeoutMs       IN: How long to wait in milliseconds. 0 = just check
+ *
+ * @return
+ *        - \ref DCGM_ST_OK            if the Host Engine is fully initialized
+ *        - \ref DCGM_ST_TIMEOUT       if it is still attaching the GPUs
+ *        - \ref DCGM_ST_INIT_ERROR    if attaching them failed
+ *        - \ref DCGM_ST_UNINITIALIZED if the Host Engine wasn't started
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmEngineWaitForInit(unsigned int timeoutMs);
+
 /**
  * This method is used to get values corresponding to the fields.
  * @return
@@ -375,6 +419,26 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmEntityInjectFieldValue(dcgmHandle_t pDcgmHandle
                                                         dcgm_field_eid_t entityId,
                                                         dcgmInjectFieldValue_t *dcgmInjectFieldValue);
 
+/**
+ * This method injects a batch of samples for any mix of entities and fields into the cache manager
+ *
+ * Values are sent to the host engine in requests of up to DCGM_INJECT_FIELD_VALUES_BUFFER_SIZE bytes.
+ * Each request is checked and then injected in one pass, with one notification to subscribers. If a
+ * value of a request is bad, none of that request's values are injected.
+ *
+ * @param values    Values to inject. Each must have version dcgmFieldValue_version2. status is ignored
+ *                  and blobs are not supported
+ * @param numValues Number of entries in values
+ *
+ * @return
+ *        - \ref DCGM_ST_OK                   if the call was successful
+ *        - \ref DCGM_ST_BADPARAM             if a provided parameter or value is invalid
+ *        - \ref DCGM_ST_VER_MISMATCH         if a value has the wrong version
+ */
+dcgmReturn_t DCGM_PUBLIC_API dcgmInjectEntityFieldValues(dcgmHandle_t pDcgmHandle,
+                                                         dcgmFieldValue_v2 *values,
+                                                         unsigned int numValues);
+
 /**
  * This method sets the link state of an entity's NvLink
  *
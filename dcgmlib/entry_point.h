@@ -59,6 +59,14 @@ DCGM_ENTRY_POINT(dcgmInjectEntityFieldValue,
                  entityId,
                  pDcgmInjectFieldValue)
 
+DCGM_ENTRY_POINT(dcgmInjectEntityFieldValues,
+                 tsapiInjectEntityFieldValues,
+                 (dcgmHandle_t pDcgmHandle, dcgmFieldValue_v2 *values, unsigned int numValues),
+                 "({} {} {})",
+                 pDcgmHandle,
+                 values,
+                 numValues)
+
 DCGM_ENTRY_POINT(dcgmSetEntityNvLinkLinkState,
                  tsapiSetEntityNvLinkLinkState,
                  (dcgmHandle_t pDcgmHandle, dcgmSetNvLinkLinkState_v1 *linkState),
@@ -78,6 +86,31 @@ DCGM_ENTRY_POINT(dcgmEngineRun,
                  socketPath,
                  isConnectionTCP)
 
+DCGM_ENTRY_POINT(dcgmEngineRunMetricsServer,
+                 tsapiEngineRunMetricsServer,
+                 (unsigned short portNumber, char const *bindAddress),
+                 "({} {})",
+                 portNumber,
+                 bindAddress)
+
+DCGM_ENTRY_POINT(dcgmEngineRunSharedLatestValues,
+                 tsapiEngineRunSharedLatestValues,
+                 (char const *name, unsigned short const *fieldIds, unsigned int fieldCount, long long updateFreqUsec),
+                 "({} {} {} {})",
+                 name,
+                 (void *)fieldIds,
+                 fieldCount,
+                 updateFreqUsec)
+
+DCGM_ENTRY_POINT(dcgmEngineRunOnSocket,
+                 tsapiEngineRunOnSocket,
+                 (int listenFd, unsigned int isConnectionTCP),
+                 "({} {})",
+                 listenFd,
+                 isConnectionTCP)
+
+DCGM_ENTRY_POINT(dcgmEngineWaitForInit, tsapiEngineWaitForInit, (unsigned int timeoutMs), "({})", timeoutMs)
+
 DCGM_ENTRY_POINT(dcgmGetAllDevices,
                  tsapiEngineGetAllDevices,
                  (dcgmHandle_t pDcgmHandle, unsigned int gpuIdList[DCGM_MAX_NUM_DEVICES], int *count),
@@ -102,6 +135,20 @@ DCGM_ENTRY_POINT(dcgmGetDeviceAttributes,
                  gpuId,
                  pDcgmDeviceAttr)
 
+DCGM_ENTRY_POINT(dcgmGetAllDeviceAttributes,
+                 tsapiEngineGetAllDeviceAttributes,
+                 (dcgmHandle_t pDcgmHandle,
+                  unsigned int capacity,
+                  unsigned int gpuIdList[],
+                  dcgmDeviceAttributes_t attributes[],
+                  unsigned int *count),
+                 "({} {} {} {} {})",
+                 pDcgmHandle,
+                 capacity,
+                 gpuIdList,
+                 attributes,
+                 count)
+
 DCGM_ENTRY_POINT(dcgmGetEntityGroupEntities,
                  tsapiGetEntityGroupEntities,
                  (dcgmHandle_t dcgmHandle,
@@ -413,6 +460,24 @@ DCGM_ENTRY_POINT(dcgmUpdateAllFields,
                  pDcgmHandle,
                  waitForUpdate)
 
+DCGM_ENTRY_POINT(dcgmUpdateFields,
+                 tsapiEngineUpdateFields,
+                 (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmFieldGrp_t fieldGroupId, int waitForUpdate),
+                 "({} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 waitForUpdate)
+
+DCGM_ENTRY_POINT(dcgmSnapshotFields,
+                 tsapiEngineSnapshotFields,
+                 (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmFieldGrp_t fieldGroupId, long long *snapshotId),
+                 "({} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 snapshotId)
+
 DCGM_ENTRY_POINT(dcgmPolicySet,
                  tsapiEnginePolicySet,
                  (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmPolicy_t *policy, dcgmStatus_t statusHandle),
@@ -449,6 +514,22 @@ DCGM_ENTRY_POINT(dcgmPolicyRegister_v2,
                  callback,
                  userData)
 
+DCGM_ENTRY_POINT(dcgmPolicyRegisterBatched,
+                 tsapiEnginePolicyRegisterBatched,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmPolicyCondition_t condition,
+                  fpRecvUpdates callback,
+                  uint64_t userData,
+                  dcgmPolicyNotifyOptions_t const *options),
+                 "({} {}, {}, {}, {}, {})",
+                 pDcgmHandle,
+                 groupId,
+                 condition,
+                 callback,
+                 userData,
+                 options)
+
 DCGM_ENTRY_POINT(dcgmPolicyUnregister,
                  tsapiEnginePolicyUnregister,
                  (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmPolicyCondition_t condition),
@@ -513,6 +594,83 @@ DCGM_ENTRY_POINT(dcgmGetValuesSince_v2,
                  enumCB,
                  userData)
 
+DCGM_ENTRY_POINT(dcgmGetValuesSinceColumns,
+                 tsapiGetValuesSinceColumns,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  long long sinceTimestamp,
+                  long long *nextSinceTimestamp,
+                  dcgmFieldValueColumns_t *columns),
+                 "({} {} {} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 sinceTimestamp,
+                 nextSinceTimestamp,
+                 columns)
+
+DCGM_ENTRY_POINT(dcgmGetResampledValues,
+                 tsapiGetResampledValues,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  dcgmResampledValues_t *resampled),
+                 "({} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 resampled)
+
+DCGM_ENTRY_POINT(dcgmValuesSinceCursorOpen,
+                 tsapiValuesSinceCursorOpen,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  long long sinceTimestamp,
+                  dcgmValuesCursor_t *cursor),
+                 "({} {} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 sinceTimestamp,
+                 cursor)
+
+DCGM_ENTRY_POINT(dcgmValuesSinceCursorNext,
+                 tsapiValuesSinceCursorNext,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmValuesCursor_t cursor,
+                  dcgmFieldValueEntityEnumeration_f enumCB,
+                  void *userData,
+                  int *done,
+                  long long *nextSinceTimestamp),
+                 "({} {} {} {} {} {})",
+                 pDcgmHandle,
+                 cursor,
+                 enumCB,
+                 userData,
+                 done,
+                 nextSinceTimestamp)
+
+DCGM_ENTRY_POINT(dcgmValuesSinceCursorClose,
+                 tsapiValuesSinceCursorClose,
+                 (dcgmHandle_t pDcgmHandle, dcgmValuesCursor_t cursor),
+                 "({} {})",
+                 pDcgmHandle,
+                 cursor)
+
+DCGM_ENTRY_POINT(dcgmExportValues,
+                 tsapiExportValues,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  dcgmExportValues_t *exportValues),
+                 "({} {} {} {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 exportValues)
+
 DCGM_ENTRY_POINT(dcgmGetLatestValues,
                  tsapiEngineGetLatestValues,
                  (dcgmHandle_t pDcgmHandle,
@@ -559,6 +717,77 @@ DCGM_ENTRY_POINT(dcgmEntitiesGetLatestValues,
                  flags,
                  values)
 
+DCGM_ENTRY_POINT(dcgmLatestValueViewOpen,
+                 tsapiLatestValueViewOpen,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGroupEntityPair_t entities[],
+                  unsigned int entityCount,
+                  unsigned short fields[],
+                  unsigned int fieldCount,
+                  dcgmLatestValueView_t *view,
+                  unsigned int slots[]),
+                 "({} {} {} {} {} {} {})",
+                 pDcgmHandle,
+                 entities,
+                 entityCount,
+                 fields,
+                 fieldCount,
+                 view,
+                 slots)
+
+DCGM_ENTRY_POINT(dcgmLatestValueViewRead,
+                 tsapiLatestValueViewRead,
+                 (dcgmLatestValueView_t view,
+                  unsigned int slots[],
+                  unsigned int count,
+                  dcgmLatestValueSample_t samples[]),
+                 "({} {} {} {})",
+                 view,
+                 slots,
+                 count,
+                 samples)
+
+DCGM_ENTRY_POINT(dcgmSharedLatestValuesOpen,
+                 tsapiSharedLatestValuesOpen,
+                 (char const *name, dcgmSharedLatestValues_t *values),
+                 "({} {})",
+                 name,
+                 values)
+
+DCGM_ENTRY_POINT(dcgmSharedLatestValuesFind,
+                 tsapiSharedLatestValuesFind,
+                 (dcgmSharedLatestValues_t values,
+                  dcgmGroupEntityPair_t entities[],
+                  unsigned int entityCount,
+                  unsigned short fields[],
+                  unsigned int fieldCount,
+                  unsigned int rows[]),
+                 "({} {} {} {} {} {})",
+                 values,
+                 entities,
+                 entityCount,
+                 fields,
+                 fieldCount,
+                 rows)
+
+DCGM_ENTRY_POINT(dcgmSharedLatestValuesRead,
+                 tsapiSharedLatestValuesRead,
+                 (dcgmSharedLatestValues_t values,
+                  unsigned int rows[],
+                  unsigned int count,
+                  dcgmLatestValueSample_t samples[]),
+                 "({} {} {} {})",
+                 values,
+                 rows,
+                 count,
+                 samples)
+
+DCGM_ENTRY_POINT(dcgmSharedLatestValuesClose,
+                 tsapiSharedLatestValuesClose,
+                 (dcgmSharedLatestValues_t values),
+                 "({})",
+                 values)
+
 DCGM_ENTRY_POINT(dcgmWatchFields,
                  tsapiWatchFields,
                  (dcgmHandle_t pDcgmHandle,
@@ -583,6 +812,34 @@ DCGM_ENTRY_POINT(dcgmUnwatchFields,
                  groupId,
                  fieldGroupId)
 
+DCGM_ENTRY_POINT(dcgmFieldValueSubscribe,
+                 tsapiFieldValueSubscribe,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmGpuGrp_t groupId,
+                  dcgmFieldGrp_t fieldGroupId,
+                  long long updateFreq,
+                  double maxKeepAge,
+                  int maxKeepSamples,
+                  dcgmFieldValueEntityEnumeration_f enumCB,
+                  void *userData),
+                 "({} {}, {}, {}, {}, {}, {}, {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId,
+                 updateFreq,
+                 maxKeepAge,
+                 maxKeepSamples,
+                 enumCB,
+                 userData)
+
+DCGM_ENTRY_POINT(dcgmFieldValueUnsubscribe,
+                 tsapiFieldValueUnsubscribe,
+                 (dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmFieldGrp_t fieldGroupId),
+                 "({} {}, {})",
+                 pDcgmHandle,
+                 groupId,
+                 fieldGroupId)
+
 DCGM_ENTRY_POINT(dcgmFieldGroupCreate,
                  tsapiFieldGroupCreate,
                  (dcgmHandle_t pDcgmHandle,
@@ -679,6 +936,20 @@ DCGM_ENTRY_POINT(dcgmRunDiagnostic,
                  diagLevel,
                  diagResponse)
 
+DCGM_ENTRY_POINT(dcgmRunDiagnosticWithCallback,
+                 tsapiEngineRunDiagnosticWithCallback,
+                 (dcgmHandle_t pDcgmHandle,
+                  dcgmRunDiag_v9 *drd,
+                  dcgmDiagTestCompleted_f callback,
+                  void *userData,
+                  dcgmDiagResponse_v11 *response),
+                 "({}, {}, {}, {}, {})",
+                 pDcgmHandle,
+                 drd,
+                 callback,
+                 userData,
+                 response)
+
 DCGM_ENTRY_POINT(dcgmStopDiagnostic, tsapiEngineStopDiagnostic, (dcgmHandle_t pDcgmHandle), "({})", pDcgmHandle)
 
 DCGM_ENTRY_POINT(
@@ -788,6 +1059,27 @@ DCGM_ENTRY_POINT(dcgmIntrospectGetHostengineMemoryUsage,
                  memoryInfo,
                  waitIfNoData)
 
+DCGM_ENTRY_POINT(dcgmIntrospectGetFieldCosts,
+                 tsapiIntrospectGetFieldCosts,
+                 (dcgmHandle_t pDcgmHandle, dcgmIntrospectFieldCosts_t *fieldCosts),
+                 "({} {})",
+                 pDcgmHandle,
+                 fieldCosts)
+
+DCGM_ENTRY_POINT(dcgmIntrospectGetLockProfile,
+                 tsapiIntrospectGetLockProfile,
+                 (dcgmHandle_t pDcgmHandle, dcgmIntrospectLockProfile_t *lockProfile),
+                 "({} {})",
+                 pDcgmHandle,
+                 lockProfile)
+
+DCGM_ENTRY_POINT(dcgmIntrospectGetRuntimeStats,
+                 tsapiIntrospectGetRuntimeStats,
+                 (dcgmHandle_t pDcgmHandle, dcgmIntrospectRuntimeStats_t *runtimeStats),
+                 "({} {})",
+                 pDcgmHandle,
+                 runtimeStats)
+
 DCGM_ENTRY_POINT(
     dcgmSelectGpusByTopology,
     tsapiSelectGpusByTopology,
@@ -827,6 +1119,13 @@ DCGM_ENTRY_POINT(dcgmProfGetSupportedMetricGroups,
                  pDcgmHandle,
                  metricGroups)
 
+DCGM_ENTRY_POINT(dcgmProfGetMultiplexInfo,
+                 tsapiProfGetMultiplexInfo,
+                 (dcgmHandle_t pDcgmHandle, dcgmProfMultiplexInfo_t *multiplexInfo),
+                 "({}, {})",
+                 pDcgmHandle,
+                 multiplexInfo)
+
 DCGM_ENTRY_POINT(dcgmProfPause, tsapiProfPause, (dcgmHandle_t pDcgmHandle), "({})", pDcgmHandle)
 
 DCGM_ENTRY_POINT(dcgmProfResume, tsapiProfResume, (dcgmHandle_t pDcgmHandle), "({})", pDcgmHandle)
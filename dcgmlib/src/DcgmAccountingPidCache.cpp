@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmAccountingPidCache.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/*****************************************************************************/
+size_t DcgmAccountingPidCache::Hash(unsigned int pid, timelib64_t startTimestamp)
+{
+    /* splitmix64 finalizer. PIDs and start times are both close together, so mix every bit */
+    uint64_t x = (uint64_t)startTimestamp * 0x9e3779b97f4a7c15ULL ^ pid;
+    x          = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x          = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return (size_t)(x ^ (x >> 31));
+}
+
+/*****************************************************************************/
+size_t DcgmAccountingPidCache::FindSlot(unsigned int pid, timelib64_t startTimestamp) const
+{
+    size_t const mask = m_slots.size() - 1;
+
+    /* The table is never more than half full, so this always finds an empty slot */
+    for (size_t i = Hash(pid, startTimestamp) & mask;; i = (i + 1) & mask)
+    {
+        Slot const &slot = m_slots[i];
+        if (!slot.used || (slot.pid == pid && slot.startTimestamp == startTimestamp))
+        {
+            return i;
+        }
+    }
+}
+
+/*****************************************************************************/
+template <typename Fn>
+void DcgmAccountingPidCache::Rehash(size_t numEntries, Fn &&keep)
+{
+    size_t capacity = c_minCapacity;
+    while (capacity < numEntries * 2)
+    {
+        capacity *= 2;
+    }
+
+    std::vector<Slot> oldSlots(capacity);
+    oldSlots.swap(m_slots);
+    m_size              = 0;
+    m_earliestKeepUntil = c_keepForever;
+
+    for (Slot const &slot : oldSlots)
+    {
+        if (slot.used && keep(slot))
+        {
+            m_slots[FindSlot(slot.pid, slot.startTimestamp)] = slot;
+            m_size++;
+            m_earliestKeepUntil = std::min(m_earliestKeepUntil, slot.keepUntil);
+        }
+    }
+}
+
+/*****************************************************************************/
+bool DcgmAccountingPidCache::Refresh(unsigned int pid, timelib64_t startTimestamp, timelib64_t keepUntil)
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+
+    Slot &slot = m_slots[FindSlot(pid, startTimestamp)];
+    if (!slot.used)
+    {
+        return false;
+    }
+
+    slot.keepUntil = std::max(slot.keepUntil, keepUntil);
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmAccountingPidCache::Insert(unsigned int pid, timelib64_t startTimestamp, timelib64_t keepUntil)
+{
+    if ((m_size + 1) * 2 > m_slots.size())
+    {
+        Rehash(m_size + 1, [](Slot const &) { return true; });
+    }
+
+    Slot &slot = m_slots[FindSlot(pid, startTimestamp)];
+    if (slot.used)
+    {
+        slot.keepUntil = std::max(slot.keepUntil, keepUntil);
+        return;
+    }
+
+    slot.used           = true;
+    slot.pid            = pid;
+    slot.startTimestamp = startTimestamp;
+    slot.keepUntil      = keepUntil;
+    m_size++;
+    m_earliestKeepUntil = std::min(m_earliestKeepUntil, keepUntil);
+}
+
+/*****************************************************************************/
+void DcgmAccountingPidCache::EvictExpired(timelib64_t now)
+{
+    if (m_size == 0 || now <= m_earliestKeepUntil)
+    {
+        return;
+    }
+
+    auto const isKept = [now](Slot const &slot) { return slot.keepUntil >= now; };
+
+    size_t const numKept = std::count_if(
+        m_slots.begin(), m_slots.end(), [&isKept](Slot const &slot) { return slot.used && isKept(slot); });
+    if (numKept == m_size)
+    {
+        /* Only refreshed entries were due. Move the next check out to the earliest of them */
+        m_earliestKeepUntil = c_keepForever;
+        for (Slot const &slot : m_slots)
+        {
+            if (slot.used)
+            {
+                m_earliestKeepUntil = std::min(m_earliestKeepUntil, slot.keepUntil);
+            }
+        }
+        return;
+    }
+
+    /* Removing from a linear probing table without tombstones means moving entries
+       around anyway, so build a table that fits what is left */
+    Rehash(numKept, isKept);
+}
+
+/*****************************************************************************/
+void DcgmAccountingPidCache::Clear()
+{
+    m_slots.clear();
+    m_size              = 0;
+    m_earliestKeepUntil = c_keepForever;
+}
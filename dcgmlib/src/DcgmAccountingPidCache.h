@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "timelib.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Set of the accounting PIDs that have already been saved to the cache, keyed
+ * by (pid, start timestamp) since PIDs get reused.
+ *
+ * This is an open-addressing hash set with linear probing. Each entry carries
+ * the time it can be forgotten, which callers push out every time NVML still
+ * reports the PID. Once NVML has dropped a PID from its accounting buffer and
+ * the record has aged out of the cache, the entry is evicted, so the set stays
+ * as big as the PIDs that are still around rather than every PID ever seen.
+ *
+ * Not thread safe. DcgmCacheManager only touches it under its m_mutex.
+ */
+class DcgmAccountingPidCache
+{
+public:
+    static constexpr timelib64_t c_keepForever = std::numeric_limits<timelib64_t>::max();
+
+    /*************************************************************************/
+    /*
+     * Check whether (pid, startTimestamp) is in the set. If it is, it is kept
+     * until at least keepUntil.
+     *
+     * Returns: true if (pid, startTimestamp) is in the set
+     *          false if not
+     */
+    bool Refresh(unsigned int pid, timelib64_t startTimestamp, timelib64_t keepUntil);
+
+    /*************************************************************************/
+    /*
+     * Add (pid, startTimestamp) to the set, to be kept until keepUntil, or
+     * c_keepForever.
+     */
+    void Insert(unsigned int pid, timelib64_t startTimestamp, timelib64_t keepUntil);
+
+    /*************************************************************************/
+    /*
+     * Remove the entries whose keepUntil is before now. This is a no-op until
+     * the earliest keepUntil has passed, so it is cheap to call every cycle.
+     */
+    void EvictExpired(timelib64_t now);
+
+    /*************************************************************************/
+    /* Remove all entries */
+    void Clear();
+
+    /*************************************************************************/
+    /* Number of entries in the set */
+    size_t GetSize() const
+    {
+        return m_size;
+    }
+
+private:
+    struct Slot
+    {
+        unsigned int pid           = 0;
+        bool used                  = false;
+        timelib64_t startTimestamp = 0;
+        timelib64_t keepUntil      = 0;
+    };
+
+    static constexpr size_t c_minCapacity = 64; /* Must be a power of 2 */
+
+    /*************************************************************************/
+    static size_t Hash(unsigned int pid, timelib64_t startTimestamp);
+
+    /*************************************************************************/
+    /* Index of the slot holding (pid, startTimestamp), or of the empty slot it would go in */
+    size_t FindSlot(unsigned int pid, timelib64_t startTimestamp) const;
+
+    /*************************************************************************/
+    /* Rebuild the table with room for numEntries, keeping only the entries that pass keep(slot) */
+    template <typename Fn>
+    void Rehash(size_t numEntries, Fn &&keep);
+
+    std::vector<Slot> m_slots;
+    size_t m_size                   = 0;
+    timelib64_t m_earliestKeepUntil = c_keepForever;
+};
@@ -18,12 +18,17 @@
 #include "dcgm_util.h"
 #include "nvcmvalue.h"
 
+#include "DcgmArrowWriter.h"
 #include "DcgmBuildInfo.hpp"
 #include "DcgmFvBuffer.h"
+#include "DcgmFvColumns.h"
+#include "DcgmDiagTestRequest.h"
+#include "DcgmFvStreamRequest.h"
 #include "DcgmLogging.h"
 #include "DcgmModuleApi.h"
 #include "DcgmPolicyRequest.h"
 #include "DcgmSettings.h"
+#include "DcgmSharedLatestValues.h"
 #include "DcgmStatus.h"
 #include "DcgmVersion.hpp"
 #include "dcgm_config_structs.h"
@@ -40,11 +45,16 @@
 #include <fmt/core.h>
 
 #include <bit>
+#include <cerrno>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <iterator>
+#include <limits>
 #include <type_traits>
 #include <unistd.h>
+#include <unordered_map>
+#include <vector>
 
 #ifdef INJECTION_LIBRARY_AVAILABLE
 void nvmlClearLibraryHandleIfNeeded(void);
@@ -90,35 +100,43 @@ extern "C" {
 
 #include "DcgmClientHandler.h"
 #include "DcgmHostEngineHandler.h"
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 /* Define these outside of C linkage since they use C++ features */
 
 /**
  * Structure for representing the global variables of DCGM within a process
  *
- * Variables of this structure are controlled by dcgmGlobalsMutex. Call dcgmGlobalsLock() and dcgmGlobalsUnlock()
- * to access these variables consistently
+ * Variables of this structure are changed under dcgmGlobalsMutex. Call dcgmGlobalsLock() and dcgmGlobalsUnlock()
+ * around init, shutdown and starting or stopping the embedded host engine.
+ *
+ * API calls only read isInitialized and clientHandler, which are atomic so that concurrent calls from many
+ * threads don't serialize on the lock. See dcgmapiAcquireClientHandler()
  */
 typedef struct dcgm_globals_t
 {
-    int isInitialized;                /* Has DcgmInit() been successfully called? dcgmShutdown() sets this back to 0 */
-    int fieldsAreInitialized;         /* Has DcgmFieldsInit() been successfully called? */
-    int embeddedEngineStarted;        /* Have we started an embedded host engine? */
-    int clientHandlerRefCount;        /* How many threads are currently using the client handler? This should be
-                                  0 unless threads are in requests */
-    DcgmClientHandler *clientHandler; /* Pointer to our client handler. This cannot be freed unless
-                                         clientHandlerRefCount reaches 0. Eventually, this should be replaced
-                                         with a shared_ptr */
+    std::atomic<int> isInitialized;                 /* Has DcgmInit() been successfully called? dcgmShutdown() sets
+                                                       this back to 0 */
+    int fieldsAreInitialized;                       /* Has DcgmFieldsInit() been successfully called? */
+    int embeddedEngineStarted;                      /* Have we started an embedded host engine? */
+    std::atomic<int> clientHandlerRefCount;         /* How many threads are currently using the client handler? This
+                                                       should be 0 unless threads are in requests */
+    std::atomic<DcgmClientHandler *> clientHandler; /* Pointer to our client handler. Only allocated and freed under
+                                                       the globals lock. It cannot be freed unless
+                                                       clientHandlerRefCount reaches 0 */
 } dcgm_globals_t, *dcgm_globals_p;
 
 // Globals
-static std::mutex g_dcgmGlobalsMutex;     /* Lock to control access to g_dcgmGlobals. This
-                                         is declared outside of g_dcgmGlobals so g_dcgmGlobals
-                                         can be memset to 0 in dcgmShutdown() */
-static dcgm_globals_t g_dcgmGlobals = {}; /* Declared static so we don't export it */
-static std::mutex g_dcgmPolicyCbMutex;    /* Lock to prevent users from unregistering policy callbacks while we
-                                             are in the process of handling them. */
+static std::mutex g_dcgmGlobalsMutex;         /* Lock to control changes to g_dcgmGlobals */
+static dcgm_globals_t g_dcgmGlobals = {};     /* Declared static so we don't export it */
+static std::shared_mutex g_dcgmPolicyCbMutex; /* Held shared by policy callbacks while they run and exclusively by
+                                                 unregistration, so that users can't unregister policy callbacks
+                                                 while we are in the process of handling them. Callbacks of different
+                                                 registrations don't wait for each other */
 
 /*****************************************************************************
  * Functions used for locking/unlocking the globals of DCGM within a process
@@ -159,106 +177,92 @@ int helperUpdateErrorCodes(dcgmStatus_t statusHandle, int numStatuses, dcgm_conf
 
 /*****************************************************************************/
 /* Get a pointer to the client handler. If this returns non-NULL, you need to call
-   dcgmapiReleaseClientHandler() to decrease the reference count to it */
+   dcgmapiReleaseClientHandler() to decrease the reference count to it.
+   Only takes the globals lock if the client handler has to be allocated */
 static DcgmClientHandler *dcgmapiAcquireClientHandler(bool shouldAllocate)
 {
-    DcgmClientHandler *retVal = NULL;
-
-    dcgmGlobalsLock();
-
-    if (g_dcgmGlobals.clientHandler)
+    while (true)
     {
-        g_dcgmGlobals.clientHandlerRefCount++;
-        retVal = g_dcgmGlobals.clientHandler;
-        log_debug("Incremented the client handler to {}", g_dcgmGlobals.clientHandlerRefCount);
-    }
-    else if (shouldAllocate)
-    {
-        try
+        /* Count ourselves in before looking at the handler. dcgmapiFreeClientHandler() unpublishes the handler
+           before it waits for the count to drain, so a handler seen here stays alive until we release it */
+        g_dcgmGlobals.clientHandlerRefCount.fetch_add(1);
+        DcgmClientHandler *clientHandler = g_dcgmGlobals.clientHandler.load();
+        if (clientHandler != nullptr)
         {
-            g_dcgmGlobals.clientHandler = new DcgmClientHandler();
+            return clientHandler;
         }
-        catch (const std::exception &e)
+        g_dcgmGlobals.clientHandlerRefCount.fetch_sub(1);
+
+        if (!shouldAllocate)
         {
-            DCGM_LOG_ERROR << "Got system error exception: " << e.what();
-            dcgmGlobalsUnlock();
             return nullptr;
         }
 
-        DCGM_LOG_INFO << "Allocated the client handler";
-        retVal                              = g_dcgmGlobals.clientHandler;
-        g_dcgmGlobals.clientHandlerRefCount = 1;
-    }
-    /* Else: retVal is left as NULL. We want this in case another thread gets in and
-             changes g_dcgmGlobals.clientHandler between the unlock and return */
+        dcgmGlobalsLock();
 
-    dcgmGlobalsUnlock();
+        /* Another thread may have allocated it while we waited for the lock */
+        if (g_dcgmGlobals.clientHandler.load() == nullptr)
+        {
+            try
+            {
+                g_dcgmGlobals.clientHandler.store(new DcgmClientHandler());
+            }
+            catch (const std::exception &e)
+            {
+                DCGM_LOG_ERROR << "Got system error exception: " << e.what();
+                dcgmGlobalsUnlock();
+                return nullptr;
+            }
 
-    return retVal;
+            DCGM_LOG_INFO << "Allocated the client handler";
+        }
+
+        dcgmGlobalsUnlock();
+        /* Take our reference like any other thread would */
+    }
 }
 
 /*****************************************************************************/
 /* Release a client handler that was acquired with dcgmapiAcquireClientHandler */
 static void dcgmapiReleaseClientHandler()
 {
-    dcgmGlobalsLock();
-
-    if (g_dcgmGlobals.clientHandler)
+    int const refCount = g_dcgmGlobals.clientHandlerRefCount.fetch_sub(1);
+    if (refCount < 1)
     {
-        if (g_dcgmGlobals.clientHandlerRefCount < 1)
-        {
-            log_error("Client handler ref count underflowed. Tried to decrement from {}",
-                      g_dcgmGlobals.clientHandlerRefCount);
-        }
-        else
-        {
-            g_dcgmGlobals.clientHandlerRefCount--;
-            log_debug("Decremented the client handler to {}", g_dcgmGlobals.clientHandlerRefCount);
-        }
+        log_error("Client handler ref count underflowed. Tried to decrement from {}", refCount);
+        g_dcgmGlobals.clientHandlerRefCount.fetch_add(1);
     }
-
-    dcgmGlobalsUnlock();
 }
 
 /*****************************************************************************/
 /* free the client handler that was allocated with dcgmapiAcquireClientHandler */
 static void dcgmapiFreeClientHandler()
 {
-    while (1)
-    {
-        /* We must not have the globals lock here or nobody else will be able to decrement the ref count */
-        while (g_dcgmGlobals.clientHandlerRefCount > 0)
-        {
-            log_info("Waiting to destroy the client handler. Current refCount: {}",
-                     g_dcgmGlobals.clientHandlerRefCount);
-            sleep(1);
-        }
-
-        dcgmGlobalsLock();
-
-        /* Now that we have the lock, we have to re-check state */
+    /* Unpublish the handler first. Threads that acquire it from here on don't find it */
+    dcgmGlobalsLock();
+    DcgmClientHandler *clientHandler = g_dcgmGlobals.clientHandler.exchange(nullptr);
+    dcgmGlobalsUnlock();
 
-        if (!g_dcgmGlobals.clientHandler)
-        {
-            /* Another thread did our work for us. Unlock and get out */
-            log_info("Another thread freed the client handler for us.");
-            dcgmGlobalsUnlock();
-            return;
-        }
-        if (g_dcgmGlobals.clientHandlerRefCount > 0)
-        {
-            /* Someone else got the lock and incremented the ref count while we were sleeping. Start over */
-            dcgmGlobalsUnlock();
-            log_info("Another thread acquired the client handler while we were sleeping.");
-            continue;
-        }
+    if (clientHandler == nullptr)
+    {
+        log_info("Another thread freed the client handler for us.");
+        return;
+    }
 
-        delete g_dcgmGlobals.clientHandler;
-        g_dcgmGlobals.clientHandler = NULL;
-        dcgmGlobalsUnlock();
-        log_info("Freed the client handler");
-        break;
+    /* Wait for the threads that are still in requests. We must not have the globals lock here since a thread may
+       need it to allocate a new client handler. Threads that didn't find the handler back out their count at once */
+    if (g_dcgmGlobals.clientHandlerRefCount.load() > 0)
+    {
+        log_info("Waiting to destroy the client handler. Current refCount: {}",
+                 g_dcgmGlobals.clientHandlerRefCount.load());
+    }
+    while (g_dcgmGlobals.clientHandlerRefCount.load() > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
+
+    delete clientHandler;
+    log_info("Freed the client handler");
 }
 
 /*****************************************************************************/
@@ -633,8 +637,10 @@ dcgmReturn_t helperGroupGetInfo(dcgmHandle_t pDcgmHandle,
  * fieldIdList      IN: List of field IDs to retrieve values for. This value takes
  *                      precedence over fieldGroupId
  * fieldIdListCount IN: How many entries are contained in fieldIdList
- * fvBuffer        OUT: Field value buffer to save values into
+ * fvBuffer        OUT: Field value buffer to save values into. May be nullptr if fvColumns is provided
  * flags            IN: Mask of DCGM_GMLV_FLAG_? flags that modify this request
+ * fvColumns       OUT: Optional columns to save values into instead of fvBuffer. These are
+ *                      smaller on the wire and cheaper to convert to dcgmFieldValue_v2s
  *
  *
  * @return DCGM_ST_OK on success
@@ -649,7 +655,8 @@ dcgmReturn_t helperGetLatestValuesForFields(dcgmHandle_t dcgmHandle,
                                             unsigned short fieldIdList[],
                                             unsigned int fieldIdListCount,
                                             DcgmFvBuffer *fvBuffer,
-                                            unsigned int flags)
+                                            unsigned int flags,
+                                            DcgmFvColumns *fvColumns = nullptr)
 {
     dcgmReturn_t ret;
 
@@ -663,7 +670,7 @@ dcgmReturn_t helperGetLatestValuesForFields(dcgmHandle_t dcgmHandle,
     msg->header.subCommand = DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V3;
     msg->header.version    = dcgm_core_msg_entities_get_latest_values_version3;
 
-    if ((entityList && !entityListCount) || (fieldIdList && !fieldIdListCount) || !fvBuffer
+    if ((entityList && !entityListCount) || (fieldIdList && !fieldIdListCount) || (!fvBuffer && !fvColumns)
         || entityListCount > DCGM_GROUP_MAX_ENTITIES_V2 || fieldIdListCount > DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP)
     {
         DCGM_LOG_ERROR << "Bad parameter";
@@ -671,6 +678,10 @@ dcgmReturn_t helperGetLatestValuesForFields(dcgmHandle_t dcgmHandle,
     }
 
     msg->ev.flags = flags;
+    if (fvColumns)
+    {
+        msg->ev.flags |= DCGM_FV_FLAG_COLUMNAR_RESPONSE;
+    }
 
     if (entityList)
     {
@@ -707,6 +718,12 @@ dcgmReturn_t helperGetLatestValuesForFields(dcgmHandle_t dcgmHandle,
         return (dcgmReturn_t)msg->ev.cmdRet;
     }
 
+    /* Older host engines ignore DCGM_FV_FLAG_COLUMNAR_RESPONSE. fvColumns accepts either payload */
+    if (fvColumns)
+    {
+        return fvColumns->SetFromBuffer(msg->ev.buffer, msg->ev.bufferSize);
+    }
+
     /* Make a FV buffer from our protobuf string */
     fvBuffer->SetFromBuffer(msg->ev.buffer, msg->ev.bufferSize);
     return DCGM_ST_OK;
@@ -729,17 +746,14 @@ dcgmReturn_t tsapiEntitiesGetLatestValues(dcgmHandle_t dcgmHandle,
         return DCGM_ST_BADPARAM;
     }
 
-    DcgmFvBuffer fvBuffer(0);
+    DcgmFvColumns fvColumns;
 
-    dcgmReturn
-        = helperGetLatestValuesForFields(dcgmHandle, 0, entities, entityCount, 0, fields, fieldCount, &fvBuffer, flags);
+    dcgmReturn = helperGetLatestValuesForFields(
+        dcgmHandle, 0, entities, entityCount, 0, fields, fieldCount, nullptr, flags, &fvColumns);
     if (dcgmReturn != DCGM_ST_OK)
         return dcgmReturn;
 
-    size_t bufferSize = 0, elementCount = 0;
-    dcgmReturn = fvBuffer.GetSize(&bufferSize, &elementCount);
-    if (dcgmReturn != DCGM_ST_OK)
-        return dcgmReturn;
+    size_t elementCount = fvColumns.GetRowCount();
 
     /* Check that we got as many fields back as we requested */
     if (elementCount != fieldCount * entityCount)
@@ -749,15 +763,150 @@ dcgmReturn_t tsapiEntitiesGetLatestValues(dcgmHandle_t dcgmHandle,
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    /* Convert the buffered FVs to our output array */
-    dcgmBufferedFvCursor_t cursor = 0;
-    unsigned int valuesIndex      = 0;
-    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    /* Convert the columns to our output array */
+    for (size_t valuesIndex = 0; valuesIndex < elementCount; valuesIndex++)
+    {
+        fvColumns.ConvertRowToFv2(valuesIndex, &values[valuesIndex]);
+    }
+
+    return DCGM_ST_OK;
+}
+
+/****************************************************************************/
+dcgmReturn_t tsapiLatestValueViewOpen(dcgmHandle_t dcgmHandle,
+                                      dcgmGroupEntityPair_t entities[],
+                                      unsigned int entityCount,
+                                      unsigned short fields[],
+                                      unsigned int fieldCount,
+                                      dcgmLatestValueView_t *view,
+                                      unsigned int slots[])
+{
+    if (!entities || entityCount < 1 || !fields || fieldCount < 1 || !view || !slots)
+    {
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* The view points into the host engine's memory, so it can only be used in-process */
+    if (dcgmHandle != (dcgmHandle_t)DCGM_EMBEDDED_HANDLE)
+    {
+        DCGM_LOG_ERROR << "Latest value views are only supported by embedded host engines";
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    DcgmHostEngineHandler *heHandler = DcgmHostEngineHandler::Instance();
+    if (!heHandler || !heHandler->GetCacheManager())
+    {
+        DCGM_LOG_ERROR << "The embedded host engine isn't running";
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    return heHandler->GetCacheManager()->OpenLatestValueView(entities, entityCount, fields, fieldCount, *view, slots);
+}
+
+/****************************************************************************/
+dcgmReturn_t tsapiLatestValueViewRead(dcgmLatestValueView_t view,
+                                      unsigned int slots[],
+                                      unsigned int count,
+                                      dcgmLatestValueSample_t samples[])
+{
+    if (!view || (count && (!slots || !samples)))
+    {
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
+    }
+
+    ((DcgmLatestValueSlots const *)view)->Read(slots, count, samples);
+    return DCGM_ST_OK;
+}
+
+/****************************************************************************/
+dcgmReturn_t tsapiSharedLatestValuesOpen(char const *name, dcgmSharedLatestValues_t *values)
+{
+    if (!values)
+    {
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::unique_ptr<DcgmSharedLatestValues> table;
+    dcgmReturn_t ret
+        = DcgmSharedLatestValues::Open((name && name[0]) ? name : DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME, table);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    *values = (dcgmSharedLatestValues_t)table.release();
+    return DCGM_ST_OK;
+}
+
+/****************************************************************************/
+dcgmReturn_t tsapiSharedLatestValuesFind(dcgmSharedLatestValues_t values,
+                                         dcgmGroupEntityPair_t entities[],
+                                         unsigned int entityCount,
+                                         unsigned short fields[],
+                                         unsigned int fieldCount,
+                                         unsigned int rows[])
+{
+    if (!values || !entities || entityCount < 1 || !fields || fieldCount < 1 || !rows)
+    {
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto *table = (DcgmSharedLatestValues *)values;
+
+    unsigned int rowIndex = 0;
+    for (unsigned int i = 0; i < entityCount; i++)
+    {
+        for (unsigned int j = 0; j < fieldCount; j++, rowIndex++)
+        {
+            dcgm_entity_key_t watchKey {};
+            watchKey.entityGroupId = entities[i].entityGroupId;
+            watchKey.entityId      = entities[i].entityId;
+            watchKey.fieldId       = fields[j];
+            rows[rowIndex]         = table->Find(watchKey);
+
+            /* Global fields are published once under DCGM_FE_NONE. Readers may not have the field metadata
+               initialized, so fall back to that row rather than look up the scope of the field */
+            if (rows[rowIndex] == DcgmSharedLatestValues::c_noRow)
+            {
+                watchKey.entityGroupId = DCGM_FE_NONE;
+                watchKey.entityId      = 0;
+                rows[rowIndex]         = table->Find(watchKey);
+            }
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/****************************************************************************/
+dcgmReturn_t tsapiSharedLatestValuesRead(dcgmSharedLatestValues_t values,
+                                         unsigned int rows[],
+                                         unsigned int count,
+                                         dcgmLatestValueSample_t samples[])
+{
+    if (!values || (count && (!rows || !samples)))
     {
-        fvBuffer.ConvertBufferedFvToFv2(fv, &values[valuesIndex]);
-        valuesIndex++;
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
     }
 
+    return ((DcgmSharedLatestValues const *)values)->Read(rows, count, samples);
+}
+
+/****************************************************************************/
+dcgmReturn_t tsapiSharedLatestValuesClose(dcgmSharedLatestValues_t values)
+{
+    if (!values)
+    {
+        DCGM_LOG_ERROR << "Bad parameter";
+        return DCGM_ST_BADPARAM;
+    }
+
+    delete (DcgmSharedLatestValues *)values;
     return DCGM_ST_OK;
 }
 
@@ -807,335 +956,455 @@ dcgmReturn_t cmHelperGetAllDevices(dcgmHandle_t pDcgmHandle, unsigned int *pGpuI
     return (dcgmReturn_t)msg.dev.cmdRet;
 }
 
+/* Fields device attributes are filled from. Update DcgmStaticFieldCache when adding fields that never change */
+static unsigned short const c_deviceAttributeFieldIds[] = {
+    DCGM_FI_DEV_SLOWDOWN_TEMP,
+    DCGM_FI_DEV_SHUTDOWN_TEMP,
+    DCGM_FI_DEV_ENFORCED_POWER_LIMIT,
+    DCGM_FI_DEV_POWER_MGMT_LIMIT,
+    DCGM_FI_DEV_POWER_MGMT_LIMIT_DEF,
+    DCGM_FI_DEV_POWER_MGMT_LIMIT_MAX,
+    DCGM_FI_DEV_POWER_MGMT_LIMIT_MIN,
+    DCGM_FI_DEV_SUPPORTED_CLOCKS,
+    DCGM_FI_DEV_UUID,
+    DCGM_FI_DEV_VBIOS_VERSION,
+    DCGM_FI_DEV_INFOROM_IMAGE_VER,
+    DCGM_FI_DEV_BRAND,
+    DCGM_FI_DEV_NAME,
+    DCGM_FI_DEV_SERIAL,
+    DCGM_FI_DEV_PCI_BUSID,
+    DCGM_FI_DEV_PCI_COMBINED_ID,
+    DCGM_FI_DEV_PCI_SUBSYS_ID,
+    DCGM_FI_DEV_BAR1_TOTAL,
+    DCGM_FI_DEV_FB_TOTAL,
+    DCGM_FI_DEV_FB_USED,
+    DCGM_FI_DEV_FB_FREE,
+    DCGM_FI_DRIVER_VERSION,
+    DCGM_FI_DEV_VIRTUAL_MODE,
+    DCGM_FI_DEV_PERSISTENCE_MODE,
+    DCGM_FI_DEV_MIG_MODE,
+    DCGM_FI_DEV_CC_MODE,
+};
+
 /**
- * Common helper to get device attributes
- * @param mode
- * @param pDcgmHandle
- * @param gpuId
- * @param pDcgmDeviceAttr
- * @return
+ * Set the member of attr that fv holds
+ * @param fv    One of the values of c_deviceAttributeFieldIds
+ * @param attr  Device attributes to update
+ * @return DCGM_ST_GENERIC_ERROR if fv isn't a device attribute field
  */
-dcgmReturn_t helperDeviceGetAttributes(dcgmHandle_t pDcgmHandle, int gpuId, dcgmDeviceAttributes_t *pDcgmDeviceAttr)
+static dcgmReturn_t helperSetDeviceAttribute(dcgmBufferedFv_t *fv, dcgmDeviceAttributes_t *attr)
 {
-    unsigned short fieldIds[34];
-    dcgmBufferedFv_t *fv;
-    unsigned int count = 0;
-    dcgmReturn_t ret;
-
-    if (NULL == pDcgmDeviceAttr)
+    switch (fv->fieldId)
     {
-        return DCGM_ST_BADPARAM;
-    }
+        case DCGM_FI_DEV_SLOWDOWN_TEMP:
+            attr->thermalSettings.slowdownTemp = (unsigned int)nvcmvalue_int64_to_int32(fv->value.i64);
+            break;
 
-    if (pDcgmDeviceAttr->version != dcgmDeviceAttributes_version)
-    {
-        return DCGM_ST_VER_MISMATCH;
-    }
+        case DCGM_FI_DEV_SHUTDOWN_TEMP:
+            attr->thermalSettings.shutdownTemp = (unsigned int)nvcmvalue_int64_to_int32(fv->value.i64);
+            break;
 
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT:
+            attr->powerLimits.curPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
+            break;
 
-    fieldIds[count++] = DCGM_FI_DEV_SLOWDOWN_TEMP;
-    fieldIds[count++] = DCGM_FI_DEV_SHUTDOWN_TEMP;
-    fieldIds[count++] = DCGM_FI_DEV_ENFORCED_POWER_LIMIT;
-    fieldIds[count++] = DCGM_FI_DEV_POWER_MGMT_LIMIT;
-    fieldIds[count++] = DCGM_FI_DEV_POWER_MGMT_LIMIT_DEF;
-    fieldIds[count++] = DCGM_FI_DEV_POWER_MGMT_LIMIT_MAX;
-    fieldIds[count++] = DCGM_FI_DEV_POWER_MGMT_LIMIT_MIN;
-    fieldIds[count++] = DCGM_FI_DEV_SUPPORTED_CLOCKS;
-    fieldIds[count++] = DCGM_FI_DEV_UUID;
-    fieldIds[count++] = DCGM_FI_DEV_VBIOS_VERSION;
-    fieldIds[count++] = DCGM_FI_DEV_INFOROM_IMAGE_VER;
-    fieldIds[count++] = DCGM_FI_DEV_BRAND;
-    fieldIds[count++] = DCGM_FI_DEV_NAME;
-    fieldIds[count++] = DCGM_FI_DEV_SERIAL;
-    fieldIds[count++] = DCGM_FI_DEV_PCI_BUSID;
-    fieldIds[count++] = DCGM_FI_DEV_PCI_COMBINED_ID;
-    fieldIds[count++] = DCGM_FI_DEV_PCI_SUBSYS_ID;
-    fieldIds[count++] = DCGM_FI_DEV_BAR1_TOTAL;
-    fieldIds[count++] = DCGM_FI_DEV_FB_TOTAL;
-    fieldIds[count++] = DCGM_FI_DEV_FB_USED;
-    fieldIds[count++] = DCGM_FI_DEV_FB_FREE;
-    fieldIds[count++] = DCGM_FI_DRIVER_VERSION;
-    fieldIds[count++] = DCGM_FI_DEV_VIRTUAL_MODE;
-    fieldIds[count++] = DCGM_FI_DEV_PERSISTENCE_MODE;
-    fieldIds[count++] = DCGM_FI_DEV_MIG_MODE;
-    fieldIds[count++] = DCGM_FI_DEV_CC_MODE;
-
-    if (count >= sizeof(fieldIds) / sizeof(fieldIds[0]))
-    {
-        log_error("Update DeviceGetAttributes to accommodate more fields");
-        return DCGM_ST_GENERIC_ERROR;
-    }
+        case DCGM_FI_DEV_ENFORCED_POWER_LIMIT:
+            attr->powerLimits.enforcedPowerLimit
+                = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
+            break;
 
-    dcgmGroupEntityPair_t entityPair;
-    entityPair.entityGroupId = DCGM_FE_GPU;
-    entityPair.entityId      = gpuId;
-    DcgmFvBuffer fvBuffer(0);
-    ret = helperGetLatestValuesForFields(
-        pDcgmHandle, 0, &entityPair, 1, 0, fieldIds, count, &fvBuffer, DCGM_FV_FLAG_LIVE_DATA);
-    if (DCGM_ST_OK != ret)
-    {
-        return ret;
-    }
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT_DEF:
+            attr->powerLimits.defaultPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
 
-    size_t bufferSize = 0, elementCount = 0;
-    ret = fvBuffer.GetSize(&bufferSize, &elementCount);
-    if (elementCount != count)
-    {
-        log_error("Unexpected elementCount {} != count {} or ret {}", (int)elementCount, count, (int)ret);
-        /* Keep going. We will only process what we have */
-    }
+            break;
 
-    dcgmBufferedFvCursor_t cursor = 0;
-    for (fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
-    {
-        switch (fv->fieldId)
-        {
-            case DCGM_FI_DEV_SLOWDOWN_TEMP:
-                pDcgmDeviceAttr->thermalSettings.slowdownTemp = (unsigned int)nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT_MAX:
+            attr->powerLimits.maxPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
+            break;
 
-            case DCGM_FI_DEV_SHUTDOWN_TEMP:
-                pDcgmDeviceAttr->thermalSettings.shutdownTemp = (unsigned int)nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT_MIN:
+            attr->powerLimits.minPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
+            break;
 
-            case DCGM_FI_DEV_POWER_MGMT_LIMIT:
-                pDcgmDeviceAttr->powerLimits.curPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
-                break;
+        case DCGM_FI_DEV_UUID:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.uuid))
+            {
+                log_error("String overflow error for the requested UUID field");
+                SafeCopyTo(attr->identifiers.uuid, DCGM_STR_BLANK);
+            }
+            else
+            {
+                SafeCopyTo(attr->identifiers.uuid, fv->value.str);
+            }
 
-            case DCGM_FI_DEV_ENFORCED_POWER_LIMIT:
-                pDcgmDeviceAttr->powerLimits.enforcedPowerLimit
-                    = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
-                break;
+            break;
+        }
 
-            case DCGM_FI_DEV_POWER_MGMT_LIMIT_DEF:
-                pDcgmDeviceAttr->powerLimits.defaultPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
+        case DCGM_FI_DEV_VBIOS_VERSION:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.vbios))
+            {
+                log_error("String overflow error for the requested VBIOS field");
+                SafeCopyTo(attr->identifiers.vbios, DCGM_STR_BLANK);
+            }
+            else
+            {
+                SafeCopyTo(attr->identifiers.vbios, fv->value.str);
+            }
 
-                break;
+            break;
+        }
 
-            case DCGM_FI_DEV_POWER_MGMT_LIMIT_MAX:
-                pDcgmDeviceAttr->powerLimits.maxPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
-                break;
+        case DCGM_FI_DEV_INFOROM_IMAGE_VER:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.inforomImageVersion))
+            {
+                log_error("String overflow error for the requested Inforom field");
+                SafeCopyTo(attr->identifiers.inforomImageVersion, DCGM_STR_BLANK);
+            }
+            else
+            {
+                SafeCopyTo(attr->identifiers.inforomImageVersion, fv->value.str);
+            }
 
-            case DCGM_FI_DEV_POWER_MGMT_LIMIT_MIN:
-                pDcgmDeviceAttr->powerLimits.minPowerLimit = (unsigned int)nvcmvalue_double_to_int32(fv->value.dbl);
-                break;
+            break;
+        }
 
-            case DCGM_FI_DEV_UUID:
+        case DCGM_FI_DEV_BRAND:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.brandName))
             {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.uuid))
-                {
-                    log_error("String overflow error for the requested UUID field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.uuid, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.uuid, fv->value.str);
-                }
-
-                break;
+                log_error("String overflow error for the requested brand name field");
+                SafeCopyTo(attr->identifiers.brandName, DCGM_STR_BLANK);
             }
-
-            case DCGM_FI_DEV_VBIOS_VERSION:
+            else
             {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.vbios))
-                {
-                    log_error("String overflow error for the requested VBIOS field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.vbios, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.vbios, fv->value.str);
-                }
-
-                break;
+                SafeCopyTo(attr->identifiers.brandName, fv->value.str);
             }
 
-            case DCGM_FI_DEV_INFOROM_IMAGE_VER:
-            {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.inforomImageVersion))
-                {
-                    log_error("String overflow error for the requested Inforom field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.inforomImageVersion, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.inforomImageVersion, fv->value.str);
-                }
+            break;
+        }
 
-                break;
+        case DCGM_FI_DEV_NAME:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.deviceName))
+            {
+                log_error("String overflow error for the requested device name field");
+                SafeCopyTo(attr->identifiers.deviceName, DCGM_STR_BLANK);
             }
-
-            case DCGM_FI_DEV_BRAND:
+            else
             {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.brandName))
-                {
-                    log_error("String overflow error for the requested brand name field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.brandName, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.brandName, fv->value.str);
-                }
-
-                break;
+                SafeCopyTo(attr->identifiers.deviceName, fv->value.str);
             }
 
-            case DCGM_FI_DEV_NAME:
-            {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.deviceName))
-                {
-                    log_error("String overflow error for the requested device name field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.deviceName, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.deviceName, fv->value.str);
-                }
+            break;
+        }
 
-                break;
+        case DCGM_FI_DEV_SERIAL:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.serial))
+            {
+                log_error("String overflow error for the requested serial field");
+                SafeCopyTo(attr->identifiers.serial, DCGM_STR_BLANK);
             }
-
-            case DCGM_FI_DEV_SERIAL:
+            else
             {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.serial))
-                {
-                    log_error("String overflow error for the requested serial field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.serial, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.serial, fv->value.str);
-                }
-
-                break;
+                SafeCopyTo(attr->identifiers.serial, fv->value.str);
             }
 
-            case DCGM_FI_DEV_PCI_BUSID:
-            {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.pciBusId))
-                {
-                    log_error("String overflow error for the requested serial field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.pciBusId, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.pciBusId, fv->value.str);
-                }
+            break;
+        }
 
-                break;
+        case DCGM_FI_DEV_PCI_BUSID:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.pciBusId))
+            {
+                log_error("String overflow error for the requested serial field");
+                SafeCopyTo(attr->identifiers.pciBusId, DCGM_STR_BLANK);
             }
-
-            case DCGM_FI_DEV_SUPPORTED_CLOCKS:
+            else
             {
-                dcgmDeviceSupportedClockSets_t *supClocks = (dcgmDeviceSupportedClockSets_t *)fv->value.blob;
+                SafeCopyTo(attr->identifiers.pciBusId, fv->value.str);
+            }
 
-                if (!supClocks)
-                {
-                    memset(&pDcgmDeviceAttr->clockSets, 0, sizeof(pDcgmDeviceAttr->clockSets));
-                    log_error("Null field value for DCGM_FI_DEV_SUPPORTED_CLOCKS");
-                }
-                else if (supClocks->version != dcgmDeviceSupportedClockSets_version)
+            break;
+        }
+
+        case DCGM_FI_DEV_SUPPORTED_CLOCKS:
+        {
+            dcgmDeviceSupportedClockSets_t *supClocks = (dcgmDeviceSupportedClockSets_t *)fv->value.blob;
+
+            if (!supClocks)
+            {
+                memset(&attr->clockSets, 0, sizeof(attr->clockSets));
+                log_error("Null field value for DCGM_FI_DEV_SUPPORTED_CLOCKS");
+            }
+            else if (supClocks->version != dcgmDeviceSupportedClockSets_version)
+            {
+                memset(&attr->clockSets, 0, sizeof(attr->clockSets));
+                log_error("Expected dcgmDeviceSupportedClockSets_version {}. Got {}",
+                          (int)dcgmDeviceSupportedClockSets_version,
+                          (int)supClocks->version);
+            }
+            else
+            {
+                int payloadSize = (sizeof(*supClocks) - sizeof(supClocks->clockSet))
+                                  + (supClocks->count * sizeof(supClocks->clockSet[0]));
+                if (payloadSize > (int)(fv->length - (sizeof(*fv) - sizeof(fv->value))))
                 {
-                    memset(&pDcgmDeviceAttr->clockSets, 0, sizeof(pDcgmDeviceAttr->clockSets));
-                    log_error("Expected dcgmDeviceSupportedClockSets_version {}. Got {}",
-                              (int)dcgmDeviceSupportedClockSets_version,
-                              (int)supClocks->version);
+                    log_error("DCGM_FI_DEV_SUPPORTED_CLOCKS calculated size {} > possible size {}",
+                              payloadSize,
+                              (int)(fv->length - (sizeof(*fv) - sizeof(fv->value))));
+                    memset(&attr->clockSets, 0, sizeof(attr->clockSets));
                 }
                 else
                 {
-                    int payloadSize = (sizeof(*supClocks) - sizeof(supClocks->clockSet))
-                                      + (supClocks->count * sizeof(supClocks->clockSet[0]));
-                    if (payloadSize > (int)(fv->length - (sizeof(*fv) - sizeof(fv->value))))
-                    {
-                        log_error("DCGM_FI_DEV_SUPPORTED_CLOCKS calculated size {} > possible size {}",
-                                  payloadSize,
-                                  (int)(fv->length - (sizeof(*fv) - sizeof(fv->value))));
-                        memset(&pDcgmDeviceAttr->clockSets, 0, sizeof(pDcgmDeviceAttr->clockSets));
-                    }
-                    else
-                    {
-                        /* Success */
-                        memcpy(&pDcgmDeviceAttr->clockSets, supClocks, payloadSize);
-                    }
+                    /* Success */
+                    memcpy(&attr->clockSets, supClocks, payloadSize);
                 }
-                break;
             }
+            break;
+        }
 
-            case DCGM_FI_DEV_PCI_COMBINED_ID:
-                pDcgmDeviceAttr->identifiers.pciDeviceId = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_PCI_COMBINED_ID:
+            attr->identifiers.pciDeviceId = fv->value.i64;
+            break;
 
-            case DCGM_FI_DEV_PCI_SUBSYS_ID:
-                pDcgmDeviceAttr->identifiers.pciSubSystemId = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_PCI_SUBSYS_ID:
+            attr->identifiers.pciSubSystemId = fv->value.i64;
+            break;
 
-            case DCGM_FI_DEV_BAR1_TOTAL:
-                pDcgmDeviceAttr->memoryUsage.bar1Total = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_BAR1_TOTAL:
+            attr->memoryUsage.bar1Total = fv->value.i64;
+            break;
 
-            case DCGM_FI_DEV_FB_TOTAL:
-                pDcgmDeviceAttr->memoryUsage.fbTotal = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_FB_TOTAL:
+            attr->memoryUsage.fbTotal = fv->value.i64;
+            break;
 
-            case DCGM_FI_DEV_FB_USED:
-                pDcgmDeviceAttr->memoryUsage.fbUsed = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_FB_USED:
+            attr->memoryUsage.fbUsed = fv->value.i64;
+            break;
 
-            case DCGM_FI_DEV_FB_FREE:
-                pDcgmDeviceAttr->memoryUsage.fbFree = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_FB_FREE:
+            attr->memoryUsage.fbFree = fv->value.i64;
+            break;
 
-            case DCGM_FI_DRIVER_VERSION:
+        case DCGM_FI_DRIVER_VERSION:
+        {
+            size_t length;
+            length = strlen(fv->value.str);
+            if (length + 1 > sizeof(attr->identifiers.driverVersion))
             {
-                size_t length;
-                length = strlen(fv->value.str);
-                if (length + 1 > sizeof(pDcgmDeviceAttr->identifiers.driverVersion))
-                {
-                    log_error("String overflow error for the requested driver version field");
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.driverVersion, DCGM_STR_BLANK);
-                }
-                else
-                {
-                    SafeCopyTo(pDcgmDeviceAttr->identifiers.driverVersion, fv->value.str);
-                }
-
-                break;
+                log_error("String overflow error for the requested driver version field");
+                SafeCopyTo(attr->identifiers.driverVersion, DCGM_STR_BLANK);
+            }
+            else
+            {
+                SafeCopyTo(attr->identifiers.driverVersion, fv->value.str);
             }
 
-            case DCGM_FI_DEV_VIRTUAL_MODE:
-                pDcgmDeviceAttr->identifiers.virtualizationMode = (unsigned int)nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
+            break;
+        }
 
-            case DCGM_FI_DEV_PERSISTENCE_MODE:
-                pDcgmDeviceAttr->settings.persistenceModeEnabled = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_VIRTUAL_MODE:
+            attr->identifiers.virtualizationMode = (unsigned int)nvcmvalue_int64_to_int32(fv->value.i64);
+            break;
 
-            case DCGM_FI_DEV_MIG_MODE:
-                pDcgmDeviceAttr->settings.migModeEnabled = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_PERSISTENCE_MODE:
+            attr->settings.persistenceModeEnabled = fv->value.i64;
+            break;
 
-            case DCGM_FI_DEV_CC_MODE:
-                pDcgmDeviceAttr->settings.confidentialComputeMode = fv->value.i64;
-                break;
+        case DCGM_FI_DEV_MIG_MODE:
+            attr->settings.migModeEnabled = fv->value.i64;
+            break;
 
-            default:
-                /* This should never happen */
-                return DCGM_ST_GENERIC_ERROR;
-                break;
+        case DCGM_FI_DEV_CC_MODE:
+            attr->settings.confidentialComputeMode = fv->value.i64;
+            break;
+
+        default:
+            /* This should never happen */
+            return DCGM_ST_GENERIC_ERROR;
+            break;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/**
+ * Common helper to get device attributes
+ * @param mode
+ * @param pDcgmHandle
+ * @param gpuId
+ * @param pDcgmDeviceAttr
+ * @return
+ */
+dcgmReturn_t helperDeviceGetAttributes(dcgmHandle_t pDcgmHandle, int gpuId, dcgmDeviceAttributes_t *pDcgmDeviceAttr)
+{
+    dcgmBufferedFv_t *fv;
+    unsigned int const count = std::size(c_deviceAttributeFieldIds);
+    dcgmReturn_t ret;
+
+    if (NULL == pDcgmDeviceAttr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (pDcgmDeviceAttr->version != dcgmDeviceAttributes_version)
+    {
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    dcgmGroupEntityPair_t entityPair;
+    entityPair.entityGroupId = DCGM_FE_GPU;
+    entityPair.entityId      = gpuId;
+    DcgmFvBuffer fvBuffer(0);
+    ret = helperGetLatestValuesForFields(pDcgmHandle,
+                                         0,
+                                         &entityPair,
+                                         1,
+                                         0,
+                                         const_cast<unsigned short *>(c_deviceAttributeFieldIds),
+                                         count,
+                                         &fvBuffer,
+                                         DCGM_FV_FLAG_LIVE_DATA);
+    if (DCGM_ST_OK != ret)
+    {
+        return ret;
+    }
+
+    size_t bufferSize = 0, elementCount = 0;
+    ret = fvBuffer.GetSize(&bufferSize, &elementCount);
+    if (elementCount != count)
+    {
+        log_error("Unexpected elementCount {} != count {} or ret {}", (int)elementCount, count, (int)ret);
+        /* Keep going. We will only process what we have */
+    }
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        ret = helperSetDeviceAttribute(fv, pDcgmDeviceAttr);
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/**
+ * Common helper to get the device attributes of every GPU with one request
+ * @param pDcgmHandle
+ * @param capacity    Number of entries of gpuIdList and attributes
+ * @param gpuIdList   GPU IDs of the attributes
+ * @param attributes  Attributes of each GPU. .version must be set on the first capacity entries
+ * @param count       Number of GPUs
+ * @return
+ */
+dcgmReturn_t helperGetAllDeviceAttributes(dcgmHandle_t pDcgmHandle,
+                                          unsigned int capacity,
+                                          unsigned int gpuIdList[],
+                                          dcgmDeviceAttributes_t attributes[],
+                                          unsigned int *count)
+{
+    if (gpuIdList == nullptr || attributes == nullptr || count == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        if (attributes[i].version != dcgmDeviceAttributes_version)
+        {
+            return DCGM_ST_VER_MISMATCH;
+        }
+    }
+
+    unsigned int allGpuIds[DCGM_MAX_NUM_DEVICES];
+    int numGpus      = 0;
+    dcgmReturn_t ret = cmHelperGetAllDevices(pDcgmHandle, allGpuIds, &numGpus, 0);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    *count = numGpus;
+    if ((unsigned int)numGpus > capacity)
+    {
+        return DCGM_ST_INSUFFICIENT_SIZE;
+    }
+    if (numGpus == 0)
+    {
+        return DCGM_ST_OK;
+    }
+
+    std::vector<dcgmGroupEntityPair_t> entities(numGpus);
+    std::unordered_map<unsigned int, dcgmDeviceAttributes_t *> attributesByGpuId;
+    for (int i = 0; i < numGpus; i++)
+    {
+        entities[i]  = { DCGM_FE_GPU, allGpuIds[i] };
+        gpuIdList[i] = allGpuIds[i];
+        attributesByGpuId[allGpuIds[i]] = &attributes[i];
+    }
+
+    /* All of the GPUs' attributes come back in a single message */
+    DcgmFvBuffer fvBuffer(0);
+    ret = helperGetLatestValuesForFields(pDcgmHandle,
+                                         0,
+                                         entities.data(),
+                                         entities.size(),
+                                         0,
+                                         const_cast<unsigned short *>(c_deviceAttributeFieldIds),
+                                         std::size(c_deviceAttributeFieldIds),
+                                         &fvBuffer,
+                                         DCGM_FV_FLAG_LIVE_DATA);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        /* The driver version is global, so it has no GPU. It's the same for all of them */
+        if (fv->entityGroupId == DCGM_FE_NONE)
+        {
+            for (int i = 0; i < numGpus; i++)
+            {
+                helperSetDeviceAttribute(fv, &attributes[i]);
+            }
+            continue;
+        }
+
+        auto it = attributesByGpuId.find(fv->entityId);
+        if (it == attributesByGpuId.end())
+        {
+            log_error("Got a value of fieldId {} for unrequested GPU {}", fv->fieldId, fv->entityId);
+            continue;
+        }
+
+        ret = helperSetDeviceAttribute(fv, it->second);
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
         }
     }
 
@@ -1185,19 +1454,54 @@ dcgmReturn_t helperWatchFieldValue(dcgmHandle_t pDcgmHandle,
         return ret;
     }
 
-    return (dcgmReturn_t)msg.fv.cmdRet;
+    return (dcgmReturn_t)msg.fv.cmdRet;
+}
+
+/*****************************************************************************/
+dcgmReturn_t helperUpdateAllFields(dcgmHandle_t pDcgmHandle, int waitForUpdate)
+{
+    dcgm_core_msg_update_all_fields_t msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_UPDATE_ALL_FIELDS;
+    msg.header.version    = dcgm_core_msg_update_all_fields_version;
+
+    msg.uf.waitForUpdate = waitForUpdate;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Return code " << ret;
+        return ret;
+    }
+
+    return (dcgmReturn_t)msg.uf.cmdRet;
 }
 
 /*****************************************************************************/
-dcgmReturn_t helperUpdateAllFields(dcgmHandle_t pDcgmHandle, int waitForUpdate)
+static dcgmReturn_t tsapiEngineUpdateAllFields(dcgmHandle_t pDcgmHandle, int waitForUpdate)
 {
-    dcgm_core_msg_update_all_fields_t msg = {};
+    return helperUpdateAllFields(pDcgmHandle, waitForUpdate);
+}
+
+/*****************************************************************************/
+static dcgmReturn_t tsapiEngineUpdateFields(dcgmHandle_t pDcgmHandle,
+                                            dcgmGpuGrp_t groupId,
+                                            dcgmFieldGrp_t fieldGroupId,
+                                            int waitForUpdate)
+{
+    dcgm_core_msg_update_fields_t msg = {};
 
     msg.header.length     = sizeof(msg);
     msg.header.moduleId   = DcgmModuleIdCore;
-    msg.header.subCommand = DCGM_CORE_SR_UPDATE_ALL_FIELDS;
-    msg.header.version    = dcgm_core_msg_update_all_fields_version;
+    msg.header.subCommand = DCGM_CORE_SR_UPDATE_FIELDS;
+    msg.header.version    = dcgm_core_msg_update_fields_version;
 
+    msg.uf.groupId       = groupId;
+    msg.uf.fieldGroupId  = fieldGroupId;
     msg.uf.waitForUpdate = waitForUpdate;
 
     // coverity[overrun-buffer-arg]
@@ -1213,9 +1517,37 @@ dcgmReturn_t helperUpdateAllFields(dcgmHandle_t pDcgmHandle, int waitForUpdate)
 }
 
 /*****************************************************************************/
-static dcgmReturn_t tsapiEngineUpdateAllFields(dcgmHandle_t pDcgmHandle, int waitForUpdate)
+static dcgmReturn_t tsapiEngineSnapshotFields(dcgmHandle_t pDcgmHandle,
+                                              dcgmGpuGrp_t groupId,
+                                              dcgmFieldGrp_t fieldGroupId,
+                                              long long *snapshotId)
 {
-    return helperUpdateAllFields(pDcgmHandle, waitForUpdate);
+    if (snapshotId == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgm_core_msg_snapshot_fields_t msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_SNAPSHOT_FIELDS;
+    msg.header.version    = dcgm_core_msg_snapshot_fields_version;
+
+    msg.sf.groupId      = groupId;
+    msg.sf.fieldGroupId = fieldGroupId;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+
+    if (DCGM_ST_OK != ret)
+    {
+        DCGM_LOG_ERROR << "Return code " << ret;
+        return ret;
+    }
+
+    *snapshotId = msg.sf.snapshotId;
+    return (dcgmReturn_t)msg.sf.cmdRet;
 }
 
 /*****************************************************************************/
@@ -1717,7 +2049,8 @@ dcgmReturn_t helperConfigGet(dcgmHandle_t dcgmHandle,
     unsigned int versionAtBaseIndex;
 
     if ((!pDeviceConfigList) || (count <= 0)
-        || ((reqType != DCGM_CONFIG_TARGET_STATE) && (reqType != DCGM_CONFIG_CURRENT_STATE)))
+        || ((reqType != DCGM_CONFIG_TARGET_STATE) && (reqType != DCGM_CONFIG_CURRENT_STATE)
+            && (reqType != DCGM_CONFIG_CURRENT_STATE_LIVE)))
     {
         log_error("Bad parameter");
         return DCGM_ST_BADPARAM;
@@ -1873,6 +2206,104 @@ static dcgmReturn_t tsapiInjectEntityFieldValue(dcgmHandle_t pDcgmHandle,
     return (dcgmReturn_t)msg.iv.cmdRet;
 }
 
+/*****************************************************************************/
+static dcgmReturn_t tsapiInjectEntityFieldValues(dcgmHandle_t pDcgmHandle,
+                                                 dcgmFieldValue_v2 *values,
+                                                 unsigned int numValues)
+{
+    if (!values || numValues == 0)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto msg = std::make_unique<dcgm_core_msg_inject_field_values_t>();
+    DcgmFvBuffer fvBuffer;
+
+    /* Send the values buffered so far as one request. The host engine injects each request in one pass */
+    auto sendBuffered = [&]() -> dcgmReturn_t {
+        size_t bufferSize   = 0;
+        size_t elementCount = 0;
+        fvBuffer.GetSize(&bufferSize, &elementCount);
+        if (elementCount == 0)
+        {
+            return DCGM_ST_OK;
+        }
+
+        /* Avoid transferring the unused part of the buffer */
+        msg->header.length     = sizeof(*msg) - sizeof(msg->iv.buffer) + bufferSize;
+        msg->header.moduleId   = DcgmModuleIdCore;
+        msg->header.subCommand = DCGM_CORE_SR_INJECT_FIELD_VALUES;
+        msg->header.version    = dcgm_core_msg_inject_field_values_version;
+
+        msg->iv.cmdRet     = DCGM_ST_OK;
+        msg->iv.bufferSize = bufferSize;
+        memcpy(msg->iv.buffer, fvBuffer.GetBuffer(), bufferSize);
+
+        // coverity[overrun-buffer-arg]
+        dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg->header, sizeof(*msg));
+        if (ret != DCGM_ST_OK)
+        {
+            log_debug("dcgmModuleSendBlockingFixedRequest returned {}", (int)ret);
+            return ret;
+        }
+
+        fvBuffer.Clear();
+        return (dcgmReturn_t)msg->iv.cmdRet;
+    };
+
+    for (unsigned int i = 0; i < numValues; i++)
+    {
+        dcgmFieldValue_v2 const &value = values[i];
+        if (value.version != dcgmFieldValue_version2)
+        {
+            log_error("Value {} has version {:#x} instead of {:#x}", i, value.version, dcgmFieldValue_version2);
+            return DCGM_ST_VER_MISMATCH;
+        }
+
+        /* Make sure the largest possible value still fits before adding this one */
+        size_t bufferSize   = 0;
+        size_t elementCount = 0;
+        fvBuffer.GetSize(&bufferSize, &elementCount);
+        if (bufferSize + sizeof(dcgmBufferedFv_t) > sizeof(msg->iv.buffer))
+        {
+            dcgmReturn_t ret = sendBuffered();
+            if (ret != DCGM_ST_OK)
+            {
+                return ret;
+            }
+        }
+
+        switch (value.fieldType)
+        {
+            case DCGM_FT_INT64:
+                fvBuffer.AddInt64Value(
+                    value.entityGroupId, value.entityId, value.fieldId, value.value.i64, value.ts, DCGM_ST_OK);
+                break;
+
+            case DCGM_FT_DOUBLE:
+                fvBuffer.AddDoubleValue(
+                    value.entityGroupId, value.entityId, value.fieldId, value.value.dbl, value.ts, DCGM_ST_OK);
+                break;
+
+            case DCGM_FT_STRING:
+            {
+                std::string str(value.value.str, strnlen(value.value.str, sizeof(value.value.str)));
+                fvBuffer.AddStringValue(
+                    value.entityGroupId, value.entityId, value.fieldId, str.c_str(), value.ts, DCGM_ST_OK);
+                break;
+            }
+
+            default:
+                /* Same as dcgmInjectEntityFieldValue, which doesn't take blobs either */
+                log_error("Value {} has unsupported fieldType {}", i, value.fieldType);
+                return DCGM_ST_BADPARAM;
+        }
+    }
+
+    return sendBuffered();
+}
+
 /*****************************************************************************/
 dcgmReturn_t helperInjectFieldValue(dcgmHandle_t pDcgmHandle,
                                     unsigned int gpuId,
@@ -2177,22 +2608,42 @@ dcgmReturn_t helperPolicyRegister(dcgmHandle_t dcgmHandle,
                                   dcgmGpuGrp_t groupId,
                                   dcgmPolicyCondition_t condition,
                                   fpRecvUpdates callback,
-                                  uint64_t userData)
+                                  uint64_t userData,
+                                  dcgmPolicyNotifyOptions_t const *options = nullptr)
 {
     dcgmReturn_t dcgmReturn;
-    dcgm_policy_msg_register_t msg;
 
     /* Make an ansync object. We're going to pass ownership off, so we won't have to free it */
     std::unique_ptr<DcgmPolicyRequest> policyRequest
         = std::make_unique<DcgmPolicyRequest>(callback, userData, g_dcgmPolicyCbMutex);
 
-    memset(&msg, 0, sizeof(msg));
-    msg.header.length     = sizeof(msg);
-    msg.header.moduleId   = DcgmModuleIdPolicy;
-    msg.header.subCommand = DCGM_POLICY_SR_REGISTER;
-    msg.header.version    = dcgm_policy_msg_register_version;
-    msg.groupId           = groupId;
-    msg.condition         = condition;
+    if (options == nullptr)
+    {
+        /* Unbatched registrations stay on v1 so that they still work with older host engines */
+        dcgm_policy_msg_register_v1 msg = {};
+        msg.header.length               = sizeof(msg);
+        msg.header.moduleId             = DcgmModuleIdPolicy;
+        msg.header.subCommand           = DCGM_POLICY_SR_REGISTER;
+        msg.header.version              = dcgm_policy_msg_register_version1;
+        msg.groupId                     = groupId;
+        msg.condition                   = condition;
+
+        // coverity[overrun-buffer-arg]
+        dcgmReturn
+            = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg), std::move(policyRequest));
+        return dcgmReturn;
+    }
+
+    dcgm_policy_msg_register_v2 msg = {};
+    msg.header.length               = sizeof(msg);
+    msg.header.moduleId             = DcgmModuleIdPolicy;
+    msg.header.subCommand           = DCGM_POLICY_SR_REGISTER;
+    msg.header.version              = dcgm_policy_msg_register_version2;
+    msg.groupId                     = groupId;
+    msg.condition                   = condition;
+    msg.coalesceWindowMs
+        = options->coalesceWindowMs ? options->coalesceWindowMs : DCGM_POLICY_COALESCE_WINDOW_MS_DEFAULT;
+    msg.maxPerConditionPerSec = options->maxPerConditionPerSec;
 
     // coverity[overrun-buffer-arg]
     dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg), std::move(policyRequest));
@@ -2687,6 +3138,90 @@ dcgmReturn_t tsapiUnwatchFields(dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId,
     return (dcgmReturn_t)msg.watchInfo.cmdRet;
 }
 
+dcgmReturn_t tsapiFieldValueSubscribe(dcgmHandle_t pDcgmHandle,
+                                      dcgmGpuGrp_t groupId,
+                                      dcgmFieldGrp_t fieldGroupId,
+                                      long long updateFreq,
+                                      double maxKeepAge,
+                                      int maxKeepSamples,
+                                      dcgmFieldValueEntityEnumeration_f enumCB,
+                                      void *userData)
+{
+    if (!groupId || !enumCB)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (pDcgmHandle == (dcgmHandle_t)DCGM_EMBEDDED_HANDLE)
+    {
+        /* Embedded clients share the host engine's address space. Polling costs them no round trip */
+        DCGM_LOG_DEBUG << "Field value subscriptions are only supported for remote host engines";
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    /* Ownership passes to the client handler, which frees it once the host engine completes it */
+    auto streamRequest = std::make_unique<DcgmFvStreamRequest>(enumCB, userData);
+
+    dcgm_core_msg_watch_fields_t msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_SUBSCRIBE_FIELDS;
+    msg.header.version    = dcgm_core_msg_watch_fields_version;
+
+    msg.watchInfo.groupId        = groupId;
+    msg.watchInfo.fieldGroupId   = fieldGroupId;
+    msg.watchInfo.updateFreq     = updateFreq;
+    msg.watchInfo.maxKeepAge     = maxKeepAge;
+    msg.watchInfo.maxKeepSamples = maxKeepSamples;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret
+        = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg), std::move(streamRequest));
+
+    if (DCGM_ST_OK != ret)
+    {
+        return ret;
+    }
+
+    return (dcgmReturn_t)msg.watchInfo.cmdRet;
+}
+
+dcgmReturn_t tsapiFieldValueUnsubscribe(dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, dcgmFieldGrp_t fieldGroupId)
+{
+    if (!groupId)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (pDcgmHandle == (dcgmHandle_t)DCGM_EMBEDDED_HANDLE)
+    {
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    dcgm_core_msg_watch_fields_t msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_UNSUBSCRIBE_FIELDS;
+    msg.header.version    = dcgm_core_msg_watch_fields_version;
+
+    msg.watchInfo.groupId      = groupId;
+    msg.watchInfo.fieldGroupId = fieldGroupId;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+
+    if (DCGM_ST_OK != ret)
+    {
+        return ret;
+    }
+
+    return (dcgmReturn_t)msg.watchInfo.cmdRet;
+}
+
 dcgmReturn_t tsapiFieldGroupCreate(dcgmHandle_t pDcgmHandle,
                                    int numFieldIds,
                                    unsigned short *fieldIds,
@@ -3082,6 +3617,45 @@ dcgmReturn_t helperActionManager(dcgmHandle_t dcgmHandle,
     return dcgmReturn;
 }
 
+/*****************************************************************************/
+static dcgmReturn_t helperRunDiagnosticWithCallback(dcgmHandle_t dcgmHandle,
+                                                    dcgmRunDiag_v9 *drd,
+                                                    dcgmDiagTestCompleted_f callback,
+                                                    void *userData,
+                                                    dcgmDiagResponse_v11 *response)
+{
+    if (!drd || !callback || !response)
+    {
+        log_error("drd {}, callback {} or response {} was NULL.", (void *)drd, (void *)callback, (void *)response);
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Per-test results only exist since dcgmDiagResponse_v11 */
+    if (drd->version != dcgmRunDiag_version9 || response->version != dcgmDiagResponse_version11)
+    {
+        log_error("Unexpected run diag version {:X} or response version {:X}", drd->version, response->version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    auto msg = std::make_unique<dcgm_diag_msg_run_v10>();
+    dcgm_module_command_header_t *header
+        = helperInitDiagMsgRun(msg.get(), dcgm_diag_msg_run_version10, DCGM_POLICY_ACTION_NONE);
+    header->moduleId   = DcgmModuleIdDiag;
+    header->subCommand = DCGM_DIAG_SR_RUN_STREAMING;
+    memcpy(&msg->runDiag, drd, sizeof(*drd));
+
+    /* Completed by the host engine after the last test, before the response */
+    auto testRequest = std::make_unique<DcgmDiagTestRequest>(callback, userData);
+
+    constexpr unsigned int secToMsMultiplier = 1000;
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(
+        dcgmHandle, header, sizeof(*msg), std::move(testRequest), drd->timeoutSeconds * secToMsMultiplier);
+
+    memcpy(response, &msg->diagResponse, sizeof(msg->diagResponse));
+    return dcgmReturn;
+}
+
 dcgmReturn_t helperStopDiag(dcgmHandle_t dcgmHandle)
 {
     dcgm_diag_msg_stop_t msg;
@@ -3236,11 +3810,38 @@ dcgmReturn_t helperSelectGpusByTopology(dcgmHandle_t pDcgmHandle,
     return (dcgmReturn_t)msg.sgt.cmdRet;
 }
 
+static dcgmReturn_t helperGetFieldSummaryV2(dcgmHandle_t pDcgmHandle, dcgmFieldSummaryRequest_v2 *request)
+{
+    dcgm_core_msg_get_field_summary_v2 msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_GET_FIELD_SUMMARY_V2;
+    msg.header.version    = dcgm_core_msg_get_field_summary_version2;
+
+    memcpy(&msg.info.fsr, request, sizeof(msg.info.fsr));
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+
+    if (DCGM_ST_OK != ret)
+    {
+        return ret;
+    }
+
+    memcpy(request, &msg.info.fsr, sizeof(msg.info.fsr));
+
+    return (dcgmReturn_t)msg.info.cmdRet;
+}
+
 static dcgmReturn_t helperGetFieldSummary(dcgmHandle_t pDcgmHandle, dcgmFieldSummaryRequest_t *request)
 {
     if (!request)
         return DCGM_ST_BADPARAM;
 
+    if (request->version == dcgmFieldSummaryRequest_version2)
+        return helperGetFieldSummaryV2(pDcgmHandle, (dcgmFieldSummaryRequest_v2 *)request);
+
     if (request->version != dcgmFieldSummaryRequest_version1)
         return DCGM_ST_VER_MISMATCH;
 
@@ -3296,24 +3897,81 @@ dcgmReturn_t helperGetTopologyPci(dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId
         return ret;
     }
 
-    memcpy(groupTopology, &msg.topo.topology, sizeof(msg.topo.topology));
-
-    return (dcgmReturn_t)msg.topo.cmdRet;
+    memcpy(groupTopology, &msg.topo.topology, sizeof(msg.topo.topology));
+
+    return (dcgmReturn_t)msg.topo.cmdRet;
+}
+
+/*****************************************************************************
+ The entry points for DCGM Host Engine APIs
+ *****************************************************************************/
+
+
+static dcgmReturn_t tsapiEngineRun(unsigned short portNumber, char const *socketPath, unsigned int isConnectionTCP)
+{
+    if (NULL == DcgmHostEngineHandler::Instance())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    return (dcgmReturn_t)DcgmHostEngineHandler::Instance()->RunServer(portNumber, socketPath, isConnectionTCP);
+}
+
+static dcgmReturn_t tsapiEngineRunMetricsServer(unsigned short portNumber, char const *bindAddress)
+{
+    if (NULL == DcgmHostEngineHandler::Instance())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    return DcgmHostEngineHandler::Instance()->RunMetricsServer(portNumber, bindAddress);
+}
+
+static dcgmReturn_t tsapiEngineRunSharedLatestValues(char const *name,
+                                                     unsigned short const *fieldIds,
+                                                     unsigned int fieldCount,
+                                                     long long updateFreqUsec)
+{
+    if ((fieldCount && !fieldIds) || fieldCount > DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP || updateFreqUsec <= 0)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (NULL == DcgmHostEngineHandler::Instance())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    std::string const segmentName
+        = (name != nullptr && name[0] != '\0') ? name : DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME;
+
+    return DcgmHostEngineHandler::Instance()->RunSharedLatestValues(
+        segmentName, std::vector<unsigned short>(fieldIds, fieldIds + fieldCount), updateFreqUsec);
+}
+
+static dcgmReturn_t tsapiEngineRunOnSocket(int listenFd, unsigned int isConnectionTCP)
+{
+    if (NULL == DcgmHostEngineHandler::Instance())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    if (listenFd < 0)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    return DcgmHostEngineHandler::Instance()->RunServer(0, nullptr, isConnectionTCP, listenFd);
 }
 
-/*****************************************************************************
- The entry points for DCGM Host Engine APIs
- *****************************************************************************/
-
-
-static dcgmReturn_t tsapiEngineRun(unsigned short portNumber, char const *socketPath, unsigned int isConnectionTCP)
+static dcgmReturn_t tsapiEngineWaitForInit(unsigned int timeoutMs)
 {
     if (NULL == DcgmHostEngineHandler::Instance())
     {
         return DCGM_ST_UNINITIALIZED;
     }
 
-    return (dcgmReturn_t)DcgmHostEngineHandler::Instance()->RunServer(portNumber, socketPath, isConnectionTCP);
+    return DcgmHostEngineHandler::Instance()->WaitForInit(std::chrono::milliseconds(timeoutMs));
 }
 
 static dcgmReturn_t tsapiEngineGroupAddDevice(dcgmHandle_t pDcgmHandle, dcgmGpuGrp_t groupId, unsigned int gpuId)
@@ -3735,6 +4393,15 @@ static dcgmReturn_t tsapiEngineGetDeviceAttributes(dcgmHandle_t pDcgmHandle,
     return helperDeviceGetAttributes(pDcgmHandle, gpuId, pDcgmDeviceAttr);
 }
 
+static dcgmReturn_t tsapiEngineGetAllDeviceAttributes(dcgmHandle_t pDcgmHandle,
+                                                      unsigned int capacity,
+                                                      unsigned int gpuIdList[],
+                                                      dcgmDeviceAttributes_t attributes[],
+                                                      unsigned int *count)
+{
+    return helperGetAllDeviceAttributes(pDcgmHandle, capacity, gpuIdList, attributes, count);
+}
+
 static dcgmReturn_t tsapiEngineGetVgpuDeviceAttributes(dcgmHandle_t pDcgmHandle,
                                                        unsigned int gpuId,
                                                        dcgmVgpuDeviceAttributes_t *pDcgmVgpuDeviceAttr)
@@ -3945,65 +4612,572 @@ static dcgmReturn_t tsapiEnginePolicySet(dcgmHandle_t pDcgmHandle,
     return helperPolicySet(pDcgmHandle, groupId, policy, statusHandle);
 }
 
-static dcgmReturn_t tsapiEnginePolicyTrigger(dcgmHandle_t /* pDcgmHandle */)
-{
-    /* Policy management is now edge-triggered, so this function has no reason
-       to exist anymore. Also, it only ever worked in the embedded case.
-       Just returning OK to not break old clients. */
+static dcgmReturn_t tsapiEnginePolicyTrigger(dcgmHandle_t /* pDcgmHandle */)
+{
+    /* Policy management is now edge-triggered, so this function has no reason
+       to exist anymore. Also, it only ever worked in the embedded case.
+       Just returning OK to not break old clients. */
+    return DCGM_ST_OK;
+}
+
+static dcgmReturn_t tsapiEnginePolicyRegister(dcgmHandle_t pDcgmHandle,
+                                              dcgmGpuGrp_t groupId,
+                                              dcgmPolicyCondition_t condition,
+                                              fpRecvUpdates callback,
+                                              uint64_t userData)
+{
+    return helperPolicyRegister(pDcgmHandle, groupId, condition, callback, userData);
+}
+
+static dcgmReturn_t tsapiEnginePolicyRegisterBatched(dcgmHandle_t pDcgmHandle,
+                                                     dcgmGpuGrp_t groupId,
+                                                     dcgmPolicyCondition_t condition,
+                                                     fpRecvUpdates callback,
+                                                     uint64_t userData,
+                                                     dcgmPolicyNotifyOptions_t const *options)
+{
+    if (callback == nullptr || options == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (options->version != dcgmPolicyNotifyOptions_version)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", options->version, dcgmPolicyNotifyOptions_version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    if (options->coalesceWindowMs > DCGM_POLICY_COALESCE_WINDOW_MS_MAX)
+    {
+        log_error("coalesceWindowMs {} is above {}", options->coalesceWindowMs, DCGM_POLICY_COALESCE_WINDOW_MS_MAX);
+        return DCGM_ST_BADPARAM;
+    }
+
+    return helperPolicyRegister(pDcgmHandle, groupId, condition, callback, userData, options);
+}
+
+static dcgmReturn_t tsapiEnginePolicyUnregister(dcgmHandle_t pDcgmHandle,
+                                                dcgmGpuGrp_t groupId,
+                                                dcgmPolicyCondition_t condition)
+{
+    return helperPolicyUnregister(pDcgmHandle, groupId, condition);
+}
+
+static dcgmReturn_t tsapiEngineGetFieldValuesSince(dcgmHandle_t pDcgmHandle,
+                                                   dcgmGpuGrp_t groupId,
+                                                   long long sinceTimestamp,
+                                                   unsigned short *fieldIds,
+                                                   int numFieldIds,
+                                                   long long *nextSinceTimestamp,
+                                                   dcgmFieldValueEnumeration_f enumCB,
+                                                   void *userData)
+{
+    return helperGetFieldValuesSince(
+        pDcgmHandle, groupId, sinceTimestamp, fieldIds, numFieldIds, nextSinceTimestamp, enumCB, userData);
+}
+
+static dcgmReturn_t tsapiEngineGetValuesSince(dcgmHandle_t pDcgmHandle,
+                                              dcgmGpuGrp_t groupId,
+                                              dcgmFieldGrp_t fieldGroupId,
+                                              long long sinceTimestamp,
+                                              long long *nextSinceTimestamp,
+                                              dcgmFieldValueEnumeration_f enumCB,
+                                              void *userData)
+{
+    return helperGetValuesSince(
+        pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, nextSinceTimestamp, enumCB, 0, userData);
+}
+
+static dcgmReturn_t tsapiEngineGetValuesSince_v2(dcgmHandle_t pDcgmHandle,
+                                                 dcgmGpuGrp_t groupId,
+                                                 dcgmFieldGrp_t fieldGroupId,
+                                                 long long sinceTimestamp,
+                                                 long long *nextSinceTimestamp,
+                                                 dcgmFieldValueEntityEnumeration_f enumCB,
+                                                 void *userData)
+{
+    return helperGetValuesSince(
+        pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, nextSinceTimestamp, 0, enumCB, userData);
+}
+
+/*****************************************************************************/
+static int helperValuesSinceColumnsCB(dcgm_field_entity_group_t entityGroupId,
+                                      dcgm_field_eid_t entityId,
+                                      dcgmFieldValue_v1 *values,
+                                      int numValues,
+                                      void *userData)
+{
+    auto *columns = static_cast<dcgmFieldValueColumns_t *>(userData);
+
+    for (int i = 0; i < numValues; i++)
+    {
+        dcgmFieldValue_v1 const &value = values[i];
+        if (value.fieldType != DCGM_FT_INT64 && value.fieldType != DCGM_FT_TIMESTAMP
+            && value.fieldType != DCGM_FT_DOUBLE)
+        {
+            columns->numSkipped++;
+            continue;
+        }
+
+        /* Keep counting once the arrays are full so the caller knows how large to make them */
+        unsigned int const index = columns->count++;
+        if (index >= columns->capacity)
+        {
+            continue;
+        }
+
+        columns->entityGroupIds[index] = entityGroupId;
+        columns->entityIds[index]      = entityId;
+        columns->fieldIds[index]       = value.fieldId;
+        columns->fieldTypes[index]     = value.fieldType;
+        columns->timestamps[index]     = value.ts;
+
+        if (value.fieldType == DCGM_FT_DOUBLE)
+        {
+            columns->int64Values[index]  = DCGM_INT64_BLANK;
+            columns->doubleValues[index] = value.value.dbl;
+        }
+        else
+        {
+            columns->int64Values[index]  = value.value.i64;
+            columns->doubleValues[index] = DCGM_FP64_BLANK;
+        }
+    }
+
+    return 0;
+}
+
+static dcgmReturn_t tsapiGetValuesSinceColumns(dcgmHandle_t pDcgmHandle,
+                                               dcgmGpuGrp_t groupId,
+                                               dcgmFieldGrp_t fieldGroupId,
+                                               long long sinceTimestamp,
+                                               long long *nextSinceTimestamp,
+                                               dcgmFieldValueColumns_t *columns)
+{
+    if (!columns || !nextSinceTimestamp)
+    {
+        log_error("Bad param to dcgmGetValuesSinceColumns");
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (columns->version != dcgmFieldValueColumns_version)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", columns->version, dcgmFieldValueColumns_version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    if (columns->capacity > 0
+        && (!columns->entityGroupIds || !columns->entityIds || !columns->fieldIds || !columns->fieldTypes
+            || !columns->timestamps || !columns->int64Values || !columns->doubleValues))
+    {
+        log_error("dcgmGetValuesSinceColumns called with capacity {} and a null array", columns->capacity);
+        return DCGM_ST_BADPARAM;
+    }
+
+    columns->count      = 0;
+    columns->numSkipped = 0;
+
+    dcgmReturn_t dcgmReturn = helperGetValuesSince(
+        pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, nextSinceTimestamp, 0, helperValuesSinceColumnsCB, columns);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    if (columns->count > columns->capacity)
+    {
+        /* The values that didn't fit will be requested again */
+        *nextSinceTimestamp = sinceTimestamp;
+        return DCGM_ST_INSUFFICIENT_SIZE;
+    }
+
+    return DCGM_ST_OK;
+}
+
+static dcgmReturn_t tsapiGetResampledValues(dcgmHandle_t pDcgmHandle,
+                                            dcgmGpuGrp_t groupId,
+                                            dcgmFieldGrp_t fieldGroupId,
+                                            dcgmResampledValues_t *resampled)
+{
+    if (!resampled)
+    {
+        log_error("Bad param to dcgmGetResampledValues");
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (resampled->version != dcgmResampledValues_version)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", resampled->version, dcgmResampledValues_version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    if (resampled->stepUsec <= 0 || resampled->endTime < resampled->startTime
+        || resampled->fill > DCGM_RESAMPLE_FILL_LINEAR)
+    {
+        log_error("dcgmGetResampledValues called with startTime {} endTime {} stepUsec {} fill {}",
+                  resampled->startTime,
+                  resampled->endTime,
+                  resampled->stepUsec,
+                  resampled->fill);
+        return DCGM_ST_BADPARAM;
+    }
+
+    if ((resampled->capacity > 0 && !resampled->values)
+        || (resampled->columnCapacity > 0 && (!resampled->columnEntities || !resampled->columnFieldIds)))
+    {
+        log_error("dcgmGetResampledValues called with capacity {} columnCapacity {} and a null array",
+                  resampled->capacity,
+                  resampled->columnCapacity);
+        return DCGM_ST_BADPARAM;
+    }
+
+    long long const numRows = (resampled->endTime - resampled->startTime) / resampled->stepUsec + 1;
+    if (numRows > std::numeric_limits<unsigned int>::max())
+    {
+        log_error("dcgmGetResampledValues called for {} rows", numRows);
+        return DCGM_ST_BADPARAM;
+    }
+
+    resampled->numRows    = (unsigned int)numRows;
+    resampled->numColumns = 0;
+
+    auto msg = std::make_unique<dcgm_core_msg_resample_values_t>();
+
+    /* The host engine returns as many rows as fit in one response. Ask for the rest until all of them are read */
+    unsigned int rowsRead = 0;
+    while (rowsRead < resampled->numRows)
+    {
+        /* Avoid transferring the values, which are only used by the response */
+        msg->header.length     = sizeof(*msg) - sizeof(msg->rv.values);
+        msg->header.moduleId   = DcgmModuleIdCore;
+        msg->header.subCommand = DCGM_CORE_SR_RESAMPLE_VALUES;
+        msg->header.version    = dcgm_core_msg_resample_values_version;
+
+        msg->rv.groupId      = groupId;
+        msg->rv.fieldGroupId = fieldGroupId;
+        msg->rv.startTime    = resampled->startTime + rowsRead * resampled->stepUsec;
+        msg->rv.stepUsec     = resampled->stepUsec;
+        msg->rv.fill         = resampled->fill;
+        msg->rv.numRows      = resampled->numRows - rowsRead;
+
+        // coverity[overrun-buffer-arg]
+        dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg->header, sizeof(*msg));
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+
+        ret = (dcgmReturn_t)msg->rv.cmdRet;
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+
+        if (rowsRead == 0)
+        {
+            resampled->numColumns = msg->rv.numColumns;
+            if (resampled->numColumns > resampled->columnCapacity
+                || (unsigned long long)resampled->numRows * resampled->numColumns > resampled->capacity)
+            {
+                return DCGM_ST_INSUFFICIENT_SIZE;
+            }
+
+            for (unsigned int i = 0; i < resampled->numColumns; i++)
+            {
+                resampled->columnEntities[i].entityGroupId
+                    = (dcgm_field_entity_group_t)msg->rv.columns[i].entityGroupId;
+                resampled->columnEntities[i].entityId = msg->rv.columns[i].entityId;
+                resampled->columnFieldIds[i]          = msg->rv.columns[i].fieldId;
+            }
+        }
+        else if (msg->rv.numColumns != resampled->numColumns)
+        {
+            log_error("The columns changed from {} to {} while reading the rows. Was the group modified?",
+                      resampled->numColumns,
+                      msg->rv.numColumns);
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        if (msg->rv.numRows == 0 || msg->rv.numRows > resampled->numRows - rowsRead
+            || (size_t)msg->rv.numRows * resampled->numColumns > DCGM_RESAMPLE_BUFFER_VALUES)
+        {
+            log_error("Got {} rows for a request of {}", msg->rv.numRows, resampled->numRows - rowsRead);
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        memcpy(resampled->values + (size_t)rowsRead * resampled->numColumns,
+               msg->rv.values,
+               sizeof(double) * msg->rv.numRows * resampled->numColumns);
+        rowsRead += msg->rv.numRows;
+    }
+
+    return DCGM_ST_OK;
+}
+
+static dcgmReturn_t tsapiValuesSinceCursorOpen(dcgmHandle_t pDcgmHandle,
+                                               dcgmGpuGrp_t groupId,
+                                               dcgmFieldGrp_t fieldGroupId,
+                                               long long sinceTimestamp,
+                                               dcgmValuesCursor_t *cursor)
+{
+    if (!cursor)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto msg = std::make_unique<dcgm_core_msg_values_cursor_t>();
+
+    /* Avoid transferring the buffer, which is only used by responses to NEXT */
+    msg->header.length     = sizeof(*msg) - sizeof(msg->vc.buffer);
+    msg->header.moduleId   = DcgmModuleIdCore;
+    msg->header.subCommand = DCGM_CORE_SR_VALUES_CURSOR_OPEN;
+    msg->header.version    = dcgm_core_msg_values_cursor_version;
+
+    msg->vc.groupId        = groupId;
+    msg->vc.fieldGroupId   = fieldGroupId;
+    msg->vc.sinceTimestamp = sinceTimestamp;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg->header, sizeof(*msg));
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    ret = (dcgmReturn_t)msg->vc.cmdRet;
+    if (ret == DCGM_ST_OK)
+    {
+        *cursor = (dcgmValuesCursor_t)msg->vc.cursorId;
+    }
+    return ret;
+}
+
+static dcgmReturn_t tsapiValuesSinceCursorNext(dcgmHandle_t pDcgmHandle,
+                                               dcgmValuesCursor_t cursor,
+                                               dcgmFieldValueEntityEnumeration_f enumCB,
+                                               void *userData,
+                                               int *done,
+                                               long long *nextSinceTimestamp)
+{
+    if (!enumCB || !done || !nextSinceTimestamp)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto msg = std::make_unique<dcgm_core_msg_values_cursor_t>();
+
+    msg->header.length     = sizeof(*msg) - sizeof(msg->vc.buffer);
+    msg->header.moduleId   = DcgmModuleIdCore;
+    msg->header.subCommand = DCGM_CORE_SR_VALUES_CURSOR_NEXT;
+    msg->header.version    = dcgm_core_msg_values_cursor_version;
+
+    msg->vc.cursorId = (unsigned int)cursor;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg->header, sizeof(*msg));
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    ret = (dcgmReturn_t)msg->vc.cmdRet;
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    *done               = msg->vc.done ? 1 : 0;
+    *nextSinceTimestamp = msg->vc.nextSinceTimestamp;
+
+    if (msg->vc.bufferSize == 0)
+    {
+        return DCGM_ST_OK;
+    }
+    else if (msg->vc.bufferSize > sizeof(msg->vc.buffer))
+    {
+        log_error("Unexpected bufferSize {}", msg->vc.bufferSize);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    DcgmFvBuffer fvBuffer(0);
+    ret = fvBuffer.SetFromBuffer(msg->vc.buffer, msg->vc.bufferSize);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Got {} from fvBuffer.SetFromBuffer()", (int)ret);
+        return ret;
+    }
+
+    dcgmFieldValue_v1 fv1;
+    dcgmBufferedFvCursor_t fvCursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&fvCursor); fv; fv = fvBuffer.GetNextFv(&fvCursor))
+    {
+        fvBuffer.ConvertBufferedFvToFv1(fv, &fv1);
+        if (enumCB((dcgm_field_entity_group_t)fv->entityGroupId, fv->entityId, &fv1, 1, userData) != 0)
+        {
+            log_debug("User requested callback exit");
+            /* Leaving status as OK. User requested the exit */
+            break;
+        }
+    }
+
     return DCGM_ST_OK;
 }
 
-static dcgmReturn_t tsapiEnginePolicyRegister(dcgmHandle_t pDcgmHandle,
-                                              dcgmGpuGrp_t groupId,
-                                              dcgmPolicyCondition_t condition,
-                                              fpRecvUpdates callback,
-                                              uint64_t userData)
+static dcgmReturn_t tsapiValuesSinceCursorClose(dcgmHandle_t pDcgmHandle, dcgmValuesCursor_t cursor)
 {
-    return helperPolicyRegister(pDcgmHandle, groupId, condition, callback, userData);
-}
+    auto msg = std::make_unique<dcgm_core_msg_values_cursor_t>();
 
-static dcgmReturn_t tsapiEnginePolicyUnregister(dcgmHandle_t pDcgmHandle,
-                                                dcgmGpuGrp_t groupId,
-                                                dcgmPolicyCondition_t condition)
-{
-    return helperPolicyUnregister(pDcgmHandle, groupId, condition);
+    msg->header.length     = sizeof(*msg) - sizeof(msg->vc.buffer);
+    msg->header.moduleId   = DcgmModuleIdCore;
+    msg->header.subCommand = DCGM_CORE_SR_VALUES_CURSOR_CLOSE;
+    msg->header.version    = dcgm_core_msg_values_cursor_version;
+
+    msg->vc.cursorId = (unsigned int)cursor;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg->header, sizeof(*msg));
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    return (dcgmReturn_t)msg->vc.cmdRet;
 }
 
-static dcgmReturn_t tsapiEngineGetFieldValuesSince(dcgmHandle_t pDcgmHandle,
-                                                   dcgmGpuGrp_t groupId,
-                                                   long long sinceTimestamp,
-                                                   unsigned short *fieldIds,
-                                                   int numFieldIds,
-                                                   long long *nextSinceTimestamp,
-                                                   dcgmFieldValueEnumeration_f enumCB,
-                                                   void *userData)
+/*****************************************************************************/
+/* State of a dcgmExportValues() call, passed to helperExportValuesCB */
+struct helperExportValuesState
 {
-    return helperGetFieldValuesSince(
-        pDcgmHandle, groupId, sinceTimestamp, fieldIds, numFieldIds, nextSinceTimestamp, enumCB, userData);
-}
+    DcgmArrowWriter *writer;
+    long long endTime;
+    unsigned long long numSkipped = 0;
+    bool writeFailed              = false;
+};
 
-static dcgmReturn_t tsapiEngineGetValuesSince(dcgmHandle_t pDcgmHandle,
-                                              dcgmGpuGrp_t groupId,
-                                              dcgmFieldGrp_t fieldGroupId,
-                                              long long sinceTimestamp,
-                                              long long *nextSinceTimestamp,
-                                              dcgmFieldValueEnumeration_f enumCB,
-                                              void *userData)
+static int helperExportValuesCB(dcgm_field_entity_group_t entityGroupId,
+                                dcgm_field_eid_t entityId,
+                                dcgmFieldValue_v1 *values,
+                                int numValues,
+                                void *userData)
 {
-    return helperGetValuesSince(
-        pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, nextSinceTimestamp, enumCB, 0, userData);
+    auto *state = static_cast<helperExportValuesState *>(userData);
+
+    for (int i = 0; i < numValues; i++)
+    {
+        if (state->endTime != 0 && values[i].ts > state->endTime)
+        {
+            continue;
+        }
+        if (!DcgmArrowWriter::IsNumeric(values[i].fieldType))
+        {
+            state->numSkipped++;
+            continue;
+        }
+        if (!state->writer->Add(entityGroupId, entityId, values[i]))
+        {
+            state->writeFailed = true;
+            return 1;
+        }
+    }
+    return 0;
 }
 
-static dcgmReturn_t tsapiEngineGetValuesSince_v2(dcgmHandle_t pDcgmHandle,
-                                                 dcgmGpuGrp_t groupId,
-                                                 dcgmFieldGrp_t fieldGroupId,
-                                                 long long sinceTimestamp,
-                                                 long long *nextSinceTimestamp,
-                                                 dcgmFieldValueEntityEnumeration_f enumCB,
-                                                 void *userData)
+/*****************************************************************************/
+static dcgmReturn_t tsapiExportValues(dcgmHandle_t pDcgmHandle,
+                                      dcgmGpuGrp_t groupId,
+                                      dcgmFieldGrp_t fieldGroupId,
+                                      dcgmExportValues_t *exportValues)
 {
-    return helperGetValuesSince(
-        pDcgmHandle, groupId, fieldGroupId, sinceTimestamp, nextSinceTimestamp, 0, enumCB, userData);
+    if (!exportValues)
+    {
+        log_error("Bad param to dcgmExportValues");
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (exportValues->version != dcgmExportValues_version)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", exportValues->version, dcgmExportValues_version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    exportValues->numValues  = 0;
+    exportValues->numSkipped = 0;
+
+    std::string const filename(exportValues->filename,
+                               strnlen(exportValues->filename, sizeof(exportValues->filename)));
+    if (filename.empty() || filename.size() == sizeof(exportValues->filename)
+        || exportValues->format != DCGM_EXPORT_FORMAT_ARROW_IPC || exportValues->startTime < 0
+        || (exportValues->endTime != 0 && exportValues->endTime < exportValues->startTime))
+    {
+        log_error("dcgmExportValues called with format {} startTime {} endTime {} and filename length {}",
+                  exportValues->format,
+                  exportValues->startTime,
+                  exportValues->endTime,
+                  filename.size());
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgmValuesCursor_t cursor = 0;
+    dcgmReturn_t ret = tsapiValuesSinceCursorOpen(pDcgmHandle, groupId, fieldGroupId, exportValues->startTime, &cursor);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Opening a values cursor for the export returned {}", (int)ret);
+        return ret;
+    }
+
+    FILE *out = fopen(filename.c_str(), "wb");
+    if (out == nullptr)
+    {
+        log_error("Unable to open {} for writing. errno {}", filename, errno);
+        tsapiValuesSinceCursorClose(pDcgmHandle, cursor);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    DcgmArrowWriter writer(out);
+    helperExportValuesState state { &writer, exportValues->endTime };
+
+    if (!writer.Begin())
+    {
+        ret = DCGM_ST_GENERIC_ERROR;
+    }
+
+    /* Each chunk is written before the next is requested, so only one chunk and one record batch are in memory */
+    int done                     = 0;
+    long long nextSinceTimestamp = 0;
+    while (ret == DCGM_ST_OK && !done)
+    {
+        ret = tsapiValuesSinceCursorNext(pDcgmHandle, cursor, helperExportValuesCB, &state, &done, &nextSinceTimestamp);
+        if (ret == DCGM_ST_OK && state.writeFailed)
+        {
+            ret = DCGM_ST_GENERIC_ERROR;
+        }
+    }
+
+    tsapiValuesSinceCursorClose(pDcgmHandle, cursor);
+
+    if (ret == DCGM_ST_OK && !writer.Finish())
+    {
+        ret = DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (fclose(out) != 0 && ret == DCGM_ST_OK)
+    {
+        log_error("Closing {} failed with errno {}", filename, errno);
+        ret = DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Exporting values to {} failed with {}. Removing the file", filename, (int)ret);
+        unlink(filename.c_str());
+        return ret;
+    }
+
+    exportValues->numValues  = writer.GetNumRows();
+    exportValues->numSkipped = state.numSkipped;
+    return DCGM_ST_OK;
 }
 
 static dcgmReturn_t tsapiEngineGetLatestValues(dcgmHandle_t pDcgmHandle,
@@ -4150,6 +5324,15 @@ static dcgmReturn_t tsapiEngineRunDiagnostic(dcgmHandle_t pDcgmHandle,
     }
 }
 
+static dcgmReturn_t tsapiEngineRunDiagnosticWithCallback(dcgmHandle_t pDcgmHandle,
+                                                         dcgmRunDiag_v9 *drd,
+                                                         dcgmDiagTestCompleted_f callback,
+                                                         void *userData,
+                                                         dcgmDiagResponse_v11 *response)
+{
+    return helperRunDiagnosticWithCallback(pDcgmHandle, drd, callback, userData, response);
+}
+
 static dcgmReturn_t tsapiEngineStopDiagnostic(dcgmHandle_t pDcgmHandle)
 {
     return helperStopDiag(pDcgmHandle);
@@ -4573,22 +5756,45 @@ static dcgmReturn_t tsapiIntrospectGetHostengineMemoryUsage(dcgmHandle_t dcgmHan
                                                             dcgmIntrospectMemory_t *memoryInfo,
                                                             int waitIfNoData)
 {
-    dcgm_introspect_msg_he_mem_usage_v1 msg;
     dcgmReturn_t dcgmReturn;
 
     if (!memoryInfo)
         return DCGM_ST_BADPARAM;
-    if (memoryInfo->version != dcgmIntrospectMemory_version1)
+
+    if (memoryInfo->version == dcgmIntrospectMemory_version1)
+    {
+        /* Older clients. Use the v1 message so that older host engines still understand us */
+        dcgm_introspect_msg_he_mem_usage_v1 msg;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.header.length     = sizeof(msg);
+        msg.header.moduleId   = DcgmModuleIdIntrospect;
+        msg.header.subCommand = DCGM_INTROSPECT_SR_HOSTENGINE_MEM_USAGE;
+        msg.header.version    = dcgm_introspect_msg_he_mem_usage_version1;
+        msg.waitIfNoData      = waitIfNoData;
+        memcpy(&msg.memoryInfo, memoryInfo, sizeof(msg.memoryInfo));
+
+        // coverity[overrun-buffer-arg]
+        dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+        /* Copy the response back over the request */
+        memcpy(memoryInfo, &msg.memoryInfo, sizeof(msg.memoryInfo));
+        return dcgmReturn;
+    }
+
+    if (memoryInfo->version != dcgmIntrospectMemory_version2)
     {
-        log_error("Version mismatch x{:X} != x{:X}", memoryInfo->version, dcgmIntrospectMemory_version1);
+        log_error("Version mismatch x{:X} != x{:X}", memoryInfo->version, dcgmIntrospectMemory_version2);
         return DCGM_ST_VER_MISMATCH;
     }
 
+    dcgm_introspect_msg_he_mem_usage_v2 msg;
+
     memset(&msg, 0, sizeof(msg));
     msg.header.length     = sizeof(msg);
     msg.header.moduleId   = DcgmModuleIdIntrospect;
     msg.header.subCommand = DCGM_INTROSPECT_SR_HOSTENGINE_MEM_USAGE;
-    msg.header.version    = dcgm_introspect_msg_he_mem_usage_version1;
+    msg.header.version    = dcgm_introspect_msg_he_mem_usage_version2;
     msg.waitIfNoData      = waitIfNoData;
     memcpy(&msg.memoryInfo, memoryInfo, sizeof(*memoryInfo));
 
@@ -4604,22 +5810,45 @@ static dcgmReturn_t tsapiIntrospectGetHostengineCpuUtilization(dcgmHandle_t dcgm
                                                                dcgmIntrospectCpuUtil_t *cpuUtil,
                                                                int waitIfNoData)
 {
-    dcgm_introspect_msg_he_cpu_util_v1 msg;
     dcgmReturn_t dcgmReturn;
 
     if (!cpuUtil)
         return DCGM_ST_BADPARAM;
-    if (cpuUtil->version != dcgmIntrospectCpuUtil_version1)
+
+    if (cpuUtil->version == dcgmIntrospectCpuUtil_version1)
+    {
+        /* Older clients. Use the v1 message so that older host engines still understand us */
+        dcgm_introspect_msg_he_cpu_util_v1 msg;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.header.length     = sizeof(msg);
+        msg.header.moduleId   = DcgmModuleIdIntrospect;
+        msg.header.subCommand = DCGM_INTROSPECT_SR_HOSTENGINE_CPU_UTIL;
+        msg.header.version    = dcgm_introspect_msg_he_cpu_util_version1;
+        msg.waitIfNoData      = waitIfNoData;
+        memcpy(&msg.cpuUtil, cpuUtil, sizeof(msg.cpuUtil));
+
+        // coverity[overrun-buffer-arg]
+        dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+        /* Copy the response back over the request */
+        memcpy(cpuUtil, &msg.cpuUtil, sizeof(msg.cpuUtil));
+        return dcgmReturn;
+    }
+
+    if (cpuUtil->version != dcgmIntrospectCpuUtil_version2)
     {
-        log_error("Version mismatch x{:X} != x{:X}", cpuUtil->version, dcgmIntrospectCpuUtil_version1);
+        log_error("Version mismatch x{:X} != x{:X}", cpuUtil->version, dcgmIntrospectCpuUtil_version2);
         return DCGM_ST_VER_MISMATCH;
     }
 
+    dcgm_introspect_msg_he_cpu_util_v2 msg;
+
     memset(&msg, 0, sizeof(msg));
     msg.header.length     = sizeof(msg);
     msg.header.moduleId   = DcgmModuleIdIntrospect;
     msg.header.subCommand = DCGM_INTROSPECT_SR_HOSTENGINE_CPU_UTIL;
-    msg.header.version    = dcgm_introspect_msg_he_cpu_util_version1;
+    msg.header.version    = dcgm_introspect_msg_he_cpu_util_version2;
 
     msg.waitIfNoData = waitIfNoData;
 
@@ -4633,6 +5862,87 @@ static dcgmReturn_t tsapiIntrospectGetHostengineCpuUtilization(dcgmHandle_t dcgm
     return dcgmReturn;
 }
 
+static dcgmReturn_t tsapiIntrospectGetFieldCosts(dcgmHandle_t dcgmHandle, dcgmIntrospectFieldCosts_t *fieldCosts)
+{
+    if (!fieldCosts)
+        return DCGM_ST_BADPARAM;
+    if (fieldCosts->version != dcgmIntrospectFieldCosts_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", fieldCosts->version, dcgmIntrospectFieldCosts_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    auto msg = std::make_unique<dcgm_introspect_msg_field_costs_v1>();
+
+    msg->header.length     = sizeof(*msg);
+    msg->header.moduleId   = DcgmModuleIdIntrospect;
+    msg->header.subCommand = DCGM_INTROSPECT_SR_FIELD_COSTS;
+    msg->header.version    = dcgm_introspect_msg_field_costs_version1;
+
+    msg->fieldCosts.version = fieldCosts->version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg->header, sizeof(*msg));
+
+    /* Copy the response back over the request */
+    memcpy(fieldCosts, &msg->fieldCosts, sizeof(*fieldCosts));
+    return dcgmReturn;
+}
+
+static dcgmReturn_t tsapiIntrospectGetLockProfile(dcgmHandle_t dcgmHandle, dcgmIntrospectLockProfile_t *lockProfile)
+{
+    if (!lockProfile)
+        return DCGM_ST_BADPARAM;
+    if (lockProfile->version != dcgmIntrospectLockProfile_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", lockProfile->version, dcgmIntrospectLockProfile_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    auto msg = std::make_unique<dcgm_introspect_msg_lock_profile_v1>();
+
+    msg->header.length     = sizeof(*msg);
+    msg->header.moduleId   = DcgmModuleIdIntrospect;
+    msg->header.subCommand = DCGM_INTROSPECT_SR_LOCK_PROFILE;
+    msg->header.version    = dcgm_introspect_msg_lock_profile_version1;
+
+    msg->lockProfile.version = lockProfile->version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg->header, sizeof(*msg));
+
+    /* Copy the response back over the request */
+    memcpy(lockProfile, &msg->lockProfile, sizeof(*lockProfile));
+    return dcgmReturn;
+}
+
+static dcgmReturn_t tsapiIntrospectGetRuntimeStats(dcgmHandle_t dcgmHandle, dcgmIntrospectRuntimeStats_t *runtimeStats)
+{
+    if (!runtimeStats)
+        return DCGM_ST_BADPARAM;
+    if (runtimeStats->version != dcgmIntrospectRuntimeStats_version1)
+    {
+        log_error("Version mismatch x{:X} != x{:X}", runtimeStats->version, dcgmIntrospectRuntimeStats_version1);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    dcgm_introspect_msg_runtime_stats_v1 msg {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdIntrospect;
+    msg.header.subCommand = DCGM_INTROSPECT_SR_RUNTIME_STATS;
+    msg.header.version    = dcgm_introspect_msg_runtime_stats_version1;
+
+    msg.runtimeStats.version = runtimeStats->version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(runtimeStats, &msg.runtimeStats, sizeof(*runtimeStats));
+    return dcgmReturn;
+}
+
 static dcgmReturn_t tsapiSelectGpusByTopology(dcgmHandle_t pDcgmHandle,
                                               uint64_t inputGpuIds,
                                               uint32_t numGpus,
@@ -4676,6 +5986,34 @@ static dcgmReturn_t tsapiModuleDenylist(dcgmHandle_t pDcgmHandle, dcgmModuleId_t
     return (dcgmReturn_t)msg.bl.cmdRet;
 }
 
+/*****************************************************************************/
+static dcgmReturn_t helperModuleGetStatusesV2(dcgmHandle_t pDcgmHandle, dcgmModuleGetStatuses_v2 *moduleStatuses)
+{
+    dcgm_core_msg_module_status_v2 msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_MODULE_STATUS_V2;
+    msg.header.version    = dcgm_core_msg_module_status_version2;
+
+    memcpy(&msg.info.st, moduleStatuses, sizeof(msg.info.st));
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t ret = dcgmModuleSendBlockingFixedRequest(pDcgmHandle, &msg.header, sizeof(msg));
+
+    if (DCGM_ST_OK != ret)
+    {
+        return ret;
+    }
+
+    if (msg.info.cmdRet == DCGM_ST_OK)
+    {
+        memcpy(moduleStatuses, &msg.info.st, sizeof(msg.info.st));
+    }
+
+    return (dcgmReturn_t)msg.info.cmdRet;
+}
+
 /*****************************************************************************/
 static dcgmReturn_t tsapiModuleGetStatuses(dcgmHandle_t pDcgmHandle, dcgmModuleGetStatuses_t *moduleStatuses)
 {
@@ -4685,7 +6023,12 @@ static dcgmReturn_t tsapiModuleGetStatuses(dcgmHandle_t pDcgmHandle, dcgmModuleG
         return DCGM_ST_BADPARAM;
     }
 
-    if (moduleStatuses->version != dcgmModuleGetStatuses_version)
+    if (moduleStatuses->version == dcgmModuleGetStatuses_version2)
+    {
+        return helperModuleGetStatusesV2(pDcgmHandle, (dcgmModuleGetStatuses_v2 *)moduleStatuses);
+    }
+
+    if (moduleStatuses->version != dcgmModuleGetStatuses_version1)
     {
         DCGM_LOG_ERROR << "Version mismatch";
         return DCGM_ST_VER_MISMATCH;
@@ -4754,6 +6097,43 @@ dcgmReturn_t tsapiProfGetSupportedMetricGroups(dcgmHandle_t dcgmHandle, dcgmProf
     return dcgmReturn;
 }
 
+/*****************************************************************************/
+dcgmReturn_t tsapiProfGetMultiplexInfo(dcgmHandle_t dcgmHandle, dcgmProfMultiplexInfo_t *multiplexInfo)
+{
+    dcgmReturn_t dcgmReturn;
+
+    if (!multiplexInfo)
+    {
+        DCGM_LOG_ERROR << "Bad param";
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (multiplexInfo->version != dcgmProfMultiplexInfo_version1)
+    {
+        DCGM_LOG_ERROR << "Version mismatch " << std::hex << multiplexInfo->version
+                       << " != " << dcgmProfMultiplexInfo_version1;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    dcgm_core_msg_prof_multiplex_info_t msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_PROF_GET_MULTIPLEX_INFO;
+    msg.header.version    = dcgm_core_msg_prof_multiplex_info_version;
+
+    memcpy(&msg.multiplexInfo, multiplexInfo, sizeof(*multiplexInfo));
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn = dcgmModuleSendBlockingFixedRequest(dcgmHandle, &msg.header, sizeof(msg));
+
+    /* Copy the response back over the request */
+    memcpy(multiplexInfo, &msg.multiplexInfo, sizeof(*multiplexInfo));
+
+    return dcgmReturn;
+}
+
 /*****************************************************************************/
 static dcgmReturn_t helperProfPauseResume(dcgmHandle_t dcgmHandle, bool pause)
 {
@@ -5562,7 +6942,7 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmConnect_v2(const char *ipAddress,
                                             dcgmHandle_t *pDcgmHandle)
 {
     dcgmReturn_t dcgmReturn;
-    dcgmConnectV2Params_v2 paramsCopy;
+    dcgmConnectV2Params_v4 paramsCopy;
 
     if (!ipAddress || !ipAddress[0] || !pDcgmHandle || !connectParams)
         return DCGM_ST_BADPARAM;
@@ -5582,6 +6962,17 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmConnect_v2(const char *ipAddress,
         /* Other fields default to 0 from the memset above */
         connectParams = &paramsCopy;
     }
+    else if (connectParams->version == dcgmConnectV2Params_version2
+             || connectParams->version == dcgmConnectV2Params_version3)
+    {
+        /* Each version only appended fields to the one before it */
+        size_t const oldSize = connectParams->version == dcgmConnectV2Params_version2 ? sizeof(dcgmConnectV2Params_v2)
+                                                                                      : sizeof(dcgmConnectV2Params_v3);
+        memset(&paramsCopy, 0, sizeof(paramsCopy));
+        memcpy(&paramsCopy, connectParams, oldSize);
+        paramsCopy.version = dcgmConnectV2Params_version;
+        connectParams      = &paramsCopy;
+    }
     else if (connectParams->version != dcgmConnectV2Params_version)
     {
         log_error("dcgmConnect_v2 Version mismatch {:X} != {:X}", connectParams->version, dcgmConnectV2Params_version);
@@ -5596,8 +6987,12 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmConnect_v2(const char *ipAddress,
     }
 
     /* Add connection to the client handler */
-    dcgmReturn_t status = clientHandler->GetConnHandleForHostEngine(
-        ipAddress, pDcgmHandle, connectParams->timeoutMs, connectParams->addressIsUnixSocket ? true : false);
+    dcgmReturn_t status = clientHandler->GetConnHandleForHostEngine(ipAddress,
+                                                                    pDcgmHandle,
+                                                                    connectParams->timeoutMs,
+                                                                    connectParams->addressIsUnixSocket ? true : false,
+                                                                    connectParams->compressMinBytes,
+                                                                    connectParams->metadataCache ? true : false);
     dcgmapiReleaseClientHandler();
     if (DCGM_ST_OK != status)
     {
@@ -5671,8 +7066,9 @@ dcgmReturn_t DCGM_PUBLIC_API dcgmInit(void)
         return DCGM_ST_OK;
     }
 
-    /* globals are uninitialized. Zero the structure */
-    memset(&g_dcgmGlobals, 0, sizeof(g_dcgmGlobals));
+    /* globals are uninitialized. The client handler and its ref count were taken care of by dcgmShutdown() */
+    g_dcgmGlobals.fieldsAreInitialized  = 0;
+    g_dcgmGlobals.embeddedEngineStarted = 0;
 
     int ret = DcgmFieldsInit();
     if (ret != DCGM_ST_OK)
@@ -15,6 +15,8 @@
  */
 #include "DcgmCMUtils.h"
 
+#include <array>
+
 
 /*****************************************************************************/
 bool DcgmFieldIsMappedToNvmlField(dcgm_field_meta_p fieldMeta, bool driver520OrNewer)
@@ -117,6 +119,151 @@ bool DcgmFieldIsMappedToNvmlField(dcgm_field_meta_p fieldMeta, bool driver520OrN
     }
 }
 
+/*****************************************************************************/
+unsigned int DcgmFieldGetBatchedNvmlFieldId(dcgm_field_meta_p fieldMeta, bool driver520OrNewer)
+{
+    if (fieldMeta == nullptr)
+    {
+        return 0;
+    }
+
+    if (DcgmFieldIsMappedToNvmlField(fieldMeta, driver520OrNewer))
+    {
+        return fieldMeta->nvmlFieldId;
+    }
+
+    /* These have no nvmlFieldId of their own because their value needs fixing up after
+       nvmlDeviceGetFieldValues(). See DcgmCacheManager::ActuallyUpdateGpuFieldValues() */
+    switch (fieldMeta->fieldId)
+    {
+        case DCGM_FI_DEV_MEMORY_TEMP:
+            return NVML_FI_DEV_MEMORY_TEMP;
+
+        case DCGM_FI_DEV_POWER_USAGE_INSTANT:
+            return NVML_FI_DEV_POWER_INSTANT;
+
+        default:
+            return 0;
+    }
+}
+
+/*****************************************************************************/
+unsigned int DcgmFieldGetBatchedNvmlFieldId(dcgm_field_meta_p fieldMeta, bool driver520OrNewer, unsigned int &scopeId)
+{
+    scopeId = 0;
+
+    unsigned int nvmlFieldId = DcgmFieldGetBatchedNvmlFieldId(fieldMeta, driver520OrNewer);
+    if (nvmlFieldId != 0 || fieldMeta == nullptr || !driver520OrNewer)
+    {
+        return nvmlFieldId;
+    }
+
+    nvmlNvLinkErrorCounter_t counter;
+    unsigned int linkId;
+    if (!DcgmFieldGetNvLinkErrorCounter(fieldMeta->fieldId, counter, linkId))
+    {
+        return 0;
+    }
+
+    /* There is no field value for NVML_NVLINK_ERROR_DL_CRC_DATA. Those keep their own driver call */
+    switch (counter)
+    {
+        case NVML_NVLINK_ERROR_DL_CRC_FLIT:
+            nvmlFieldId = NVML_FI_DEV_NVLINK_ERROR_DL_CRC;
+            break;
+
+        case NVML_NVLINK_ERROR_DL_REPLAY:
+            nvmlFieldId = NVML_FI_DEV_NVLINK_ERROR_DL_REPLAY;
+            break;
+
+        case NVML_NVLINK_ERROR_DL_RECOVERY:
+            nvmlFieldId = NVML_FI_DEV_NVLINK_ERROR_DL_RECOVERY;
+            break;
+
+        default:
+            return 0;
+    }
+
+    scopeId = linkId;
+    return nvmlFieldId;
+}
+
+/*****************************************************************************/
+bool DcgmFieldGetNvLinkErrorCounter(unsigned short fieldId, nvmlNvLinkErrorCounter_t &counter, unsigned int &linkId)
+{
+    /* Field ids of each counter, indexed by link */
+    static constexpr std::array<unsigned short, 18> crcFlitFieldIds {
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L0,  DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L1,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L2,  DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L3,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L4,  DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L5,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L6,  DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L7,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L8,  DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L9,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L10, DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L11,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L12, DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L13,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L14, DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L15,
+        DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L16, DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L17,
+    };
+    static constexpr std::array<unsigned short, 18> crcDataFieldIds {
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L0,  DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L1,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L2,  DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L3,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L4,  DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L5,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L6,  DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L7,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L8,  DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L9,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L10, DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L11,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L12, DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L13,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L14, DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L15,
+        DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L16, DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L17,
+    };
+    static constexpr std::array<unsigned short, 18> replayFieldIds {
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L0,  DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L1,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L2,  DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L3,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L4,  DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L5,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L6,  DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L7,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L8,  DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L9,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L10, DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L11,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L12, DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L13,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L14, DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L15,
+        DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L16, DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L17,
+    };
+    static constexpr std::array<unsigned short, 18> recoveryFieldIds {
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L0,  DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L1,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L2,  DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L3,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L4,  DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L5,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L6,  DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L7,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L8,  DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L9,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L10, DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L11,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L12, DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L13,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L14, DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L15,
+        DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L16, DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L17,
+    };
+
+    struct
+    {
+        nvmlNvLinkErrorCounter_t counter;
+        std::array<unsigned short, 18> const &fieldIds;
+    } const counters[] = {
+        { NVML_NVLINK_ERROR_DL_CRC_FLIT, crcFlitFieldIds },
+        { NVML_NVLINK_ERROR_DL_CRC_DATA, crcDataFieldIds },
+        { NVML_NVLINK_ERROR_DL_REPLAY, replayFieldIds },
+        { NVML_NVLINK_ERROR_DL_RECOVERY, recoveryFieldIds },
+    };
+
+    for (auto const &[candidate, fieldIds] : counters)
+    {
+        for (unsigned int i = 0; i < fieldIds.size(); i++)
+        {
+            if (fieldIds[i] == fieldId)
+            {
+                counter = candidate;
+                linkId  = i;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 /*****************************************************************************/
 const char *NvmlErrorToStringValue(nvmlReturn_t nvmlReturn)
 {
@@ -24,6 +24,41 @@
 /*************************************************************************/
 bool DcgmFieldIsMappedToNvmlField(dcgm_field_meta_p fieldMeta, bool driver520OrNewer);
 
+/*************************************************************************/
+/*
+ * Get the NVML_FI_? to request for fieldMeta in the cache manager's batched
+ * nvmlDeviceGetFieldValues() call. This covers every field that
+ * DcgmFieldIsMappedToNvmlField() accepts plus a few fields that only need their
+ * value converted afterwards.
+ *
+ * Returns: The NVML field id
+ *          0 if fieldMeta has to be fetched with its own driver call
+ */
+unsigned int DcgmFieldGetBatchedNvmlFieldId(dcgm_field_meta_p fieldMeta, bool driver520OrNewer);
+
+/*************************************************************************/
+/*
+ * Same as above for callers that can set nvmlFieldValue_t::scopeId. This also
+ * batches the per-link NvLink error counters that r520+ drivers report through
+ * scoped NVML_FI_DEV_NVLINK_ERROR_DL_* field values.
+ *
+ * scopeId   OUT: The scopeId to request the NVML field id with
+ *
+ * Returns: The NVML field id
+ *          0 if fieldMeta has to be fetched with its own driver call
+ */
+unsigned int DcgmFieldGetBatchedNvmlFieldId(dcgm_field_meta_p fieldMeta, bool driver520OrNewer, unsigned int &scopeId);
+
+/*************************************************************************/
+/*
+ * Get the nvmlDeviceGetNvLinkErrorCounter() arguments that read a per-link NvLink
+ * error counter field like DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L0
+ *
+ * Returns: true if fieldId is a per-link NvLink error counter. counter and linkId are set
+ *          false otherwise
+ */
+bool DcgmFieldGetNvLinkErrorCounter(unsigned short fieldId, nvmlNvLinkErrorCounter_t &counter, unsigned int &linkId);
+
 /*************************************************************************/
 /* Convert a NVML return code to an appropriate null value */
 const char *NvmlErrorToStringValue(nvmlReturn_t nvmlReturn);
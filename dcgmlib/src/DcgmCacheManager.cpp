@@ -15,19 +15,25 @@
  */
 #include "DcgmCacheManager.h"
 #include "DcgmCMUtils.h"
+#include "DcgmDerivedFields.h"
 #include "DcgmGpuInstance.h"
 #include "DcgmHostEngineHandler.h"
+#include "DcgmInflightRequests.h"
 #include "DcgmMutex.h"
 #include "DcgmProfiles.h"
+#include "DcgmSummaryKernels.h"
 #include "DcgmTopology.hpp"
 #include "DcgmVgpu.hpp"
-#include "MurmurHash3.h"
 #include "dcgm_structs_internal.h"
 #include "nvml.h"
 #include <DcgmException.hpp>
 #include <DcgmStringHelpers.h>
+#include <DcgmThreadPlacement.h>
+#include <DcgmTrace.h>
 #include <DcgmUtilities.h>
 #include <TimeLib.hpp>
+#include <WorkStealingThreadPool.hpp>
+#include <cachealloc.h>
 #include <dcgm_agent.h>
 #include <dcgm_nvswitch_structs.h>
 
@@ -35,93 +41,36 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <list>
 #include <map>
 #include <numeric>
+#include <optional>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <sys/types.h>
+#include <type_traits>
 #include <unistd.h>
+#include <unordered_set>
 
 #define DRIVER_VERSION_510 510
 
-/*****************************************************************************/
-/* Conditional / Debug Features */
-//#define DEBUG_UPDATE_LOOP 1
-
-/*****************************************************************************/
-/* Keyed vector definition for pids that we've seen */
-typedef struct dcgmcm_pid_seen_t
-{
-    unsigned int pid;
-    timelib64_t timestamp;
-} dcgmcm_pid_seen_t, *dcgmcm_pid_seen_p;
-
-static int dcgmcm_pidSeenCmpCB(void *L, void *R)
-{
-    dcgmcm_pid_seen_p l = (dcgmcm_pid_seen_p)L;
-    dcgmcm_pid_seen_p r = (dcgmcm_pid_seen_p)R;
-
-    if (l->pid < r->pid)
-        return -1;
-    else if (l->pid > r->pid)
-        return 1;
-
-    if (l->timestamp < r->timestamp)
-        return -1;
-    else if (l->timestamp > r->timestamp)
-        return 1;
-
-    return 0;
-}
+/* Bounds on the initial number of entries reserved for a ring buffer timeseries */
+#define DCGMCM_RING_MIN_CAPACITY 16
+#define DCGMCM_RING_MAX_CAPACITY (1024 * 1024)
 
-static int dcgmcm_pidSeenMergeCB(void * /* current */, void * /* inserting */, void * /* user */)
-{
-    log_error("Unexpected dcgmcm_pidSeenMergeCB");
-    return KV_ST_DUPLICATE;
-}
+/* Maximum number of the most recent samples of each watch that are persisted to a cache snapshot */
+#define DCGMCM_SNAPSHOT_MAX_SAMPLES 1024
 
 /*****************************************************************************/
-/* Hash callbacks for m_entityWatchHashTable */
-static unsigned int entityKeyHashCB(const void *key)
-{
-    unsigned int retVal = 0;
-
-    /* We're passing address to key because the pointer passed in is the actual value */
-    MurmurHash3_x86_32(&key, sizeof(key), 0, &retVal);
-    return retVal;
-}
-
-/* Comparison callbacks for m_entityWatchHashTable */
-static int entityKeyCmpCB(const void *key1, const void *key2)
-{
-    if (key1 == key2)
-        return 1; /* Yes. The caller expects 1 for == */
-    else
-        return 0;
-}
-
-static void entityValueFreeCB(void *WatchInfo)
-{
-    dcgmcm_watch_info_p watchInfo = (dcgmcm_watch_info_p)WatchInfo;
-
-    if (!watchInfo)
-    {
-        log_error("FreeWatchInfo got NULL watchInfo");
-        return;
-    }
-
-    if (watchInfo->timeSeries)
-    {
-        timeseries_destroy(watchInfo->timeSeries);
-        watchInfo->timeSeries = 0;
-    }
-
-    delete (watchInfo);
-}
+/* Conditional / Debug Features */
+//#define DEBUG_UPDATE_LOOP 1
 
 static dcgmReturn_t helperNvSwitchAddFieldWatch(dcgm_field_entity_group_t entityGroupId,
                                                 unsigned int entityId,
@@ -201,6 +150,9 @@ void DcgmCacheManager::ClearGpuMigInfo(dcgmcm_gpu_info_t &gpuInfo)
     m_numInstances -= gpuInfo.instances.size();
     m_numComputeInstances -= ciCount;
     gpuInfo.instances.clear();
+
+    // Watches of this GPU's MIG entities may now map to a different update shard
+    m_watchSetGeneration++;
 }
 
 namespace
@@ -610,6 +562,69 @@ public:
 private:
     std::vector<nvmlComputeInstance_t> m_instances;
 };
+
+/*
+ * Hands out the DCGM IDs of one kind of MIG entity of a GPU, which are base + a slot below capacity.
+ * An entity that had an ID before gets it back. A new one gets the lowest slot nobody had before,
+ * so that an ID never moves from one instance to another while both might be watched.
+ */
+template <class Key>
+class MigIdAllocator
+{
+public:
+    MigIdAllocator(unsigned int base, unsigned int capacity)
+        : m_base(base)
+        , m_capacity(capacity)
+    {}
+
+    void Reserve(Key const &key, unsigned int id)
+    {
+        if (id < m_base || id - m_base >= m_capacity)
+        {
+            /* Numbered for a different maxGpcs. Let the entity get a new ID */
+            return;
+        }
+
+        m_previous[key] = id - m_base;
+        m_used.insert(id - m_base);
+    }
+
+    /* Returns std::nullopt if every slot is taken */
+    std::optional<unsigned int> Take(Key const &key)
+    {
+        if (auto it = m_previous.find(key); it != m_previous.end())
+        {
+            return m_base + it->second;
+        }
+
+        unsigned int slot = 0;
+        while (m_used.contains(slot))
+        {
+            slot++;
+        }
+
+        /* Without previous IDs, keep numbering past capacity like we always did */
+        if (slot >= m_capacity && !m_previous.empty())
+        {
+            return std::nullopt;
+        }
+
+        m_used.insert(slot);
+        return m_base + slot;
+    }
+
+private:
+    unsigned int m_base;
+    unsigned int m_capacity;
+    std::map<Key, unsigned int> m_previous;
+    std::set<unsigned int> m_used;
+};
+
+class MigIdsExhausted : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
 } // namespace
 
 dcgmReturn_t DcgmCacheManager::FindAndStoreMigDeviceHandles(dcgmcm_gpu_info_t &gpuInfo)
@@ -694,7 +709,37 @@ dcgmReturn_t DcgmCacheManager::FindAndStoreDeviceHandle(dcgmcm_gpu_info_t &gpuIn
 
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo)
+dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo,
+                                                      DcgmMigIdSnapshot const *previousIds)
+{
+    dcgmReturn_t const ret = ReadGpuInstances(gpuInfo, previousIds);
+    RecordGpuInstances(gpuInfo);
+    return ret;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::RecordGpuInstances(dcgmcm_gpu_info_t const &gpuInfo)
+{
+    for (auto const &gpuInstance : gpuInfo.instances)
+    {
+        for (unsigned int i = 0; i < gpuInstance.GetComputeInstanceCount(); i++)
+        {
+            dcgmcm_gpu_compute_instance_t ci {};
+            if (gpuInstance.GetComputeInstance(i, ci) == DCGM_ST_OK)
+            {
+                m_migManager.RecordGpuComputeInstance(
+                    gpuInfo.gpuId, gpuInstance.GetInstanceId(), ci.dcgmComputeInstanceId);
+            }
+        }
+
+        m_migManager.RecordGpuInstance(gpuInfo.gpuId, gpuInstance.GetInstanceId());
+        m_numInstances++;
+        m_numComputeInstances += gpuInstance.GetComputeInstanceCount();
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ReadGpuInstances(dcgmcm_gpu_info_t &gpuInfo, DcgmMigIdSnapshot const *previousIds)
 {
     // When the NVML code is ready & supported
     unsigned int currentMode = 0;
@@ -759,6 +804,20 @@ dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo
 
     unsigned int maxGpcsInProfiles = 0;
 
+    MigIdAllocator<unsigned int> gpuInstanceIds(gpuInfo.gpuId * gpuInfo.maxGpcs, maxGpcs);
+    MigIdAllocator<std::pair<unsigned int, unsigned int>> computeInstanceIds(gpuInfo.gpuId * maxGpcs, maxGpcs);
+    if (previousIds != nullptr)
+    {
+        for (auto const &[nvmlGpuInstanceId, gpuInstanceId] : previousIds->gpuInstances)
+        {
+            gpuInstanceIds.Reserve(nvmlGpuInstanceId, gpuInstanceId.id);
+        }
+        for (auto const &[nvmlIds, computeInstanceId] : previousIds->computeInstances)
+        {
+            computeInstanceIds.Reserve(nvmlIds, computeInstanceId.id);
+        }
+    }
+
     try
     {
         for (auto const &[profileIndex, profileInfo, profileName] : GpuInstanceProfiles { gpuInfo.nvmlDevice })
@@ -767,7 +826,12 @@ dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo
 
             for (auto const &[gpuInstance, gpuInstanceInfo] : GpuInstances(gpuInfo.nvmlDevice, profileInfo))
             {
-                DcgmNs::Mig::GpuInstanceId gpuInstanceId { gpuInfo.gpuId * gpuInfo.maxGpcs + gpuInfo.instances.size() };
+                auto const gpuInstanceSlot = gpuInstanceIds.Take(gpuInstanceInfo.id);
+                if (!gpuInstanceSlot.has_value())
+                {
+                    throw MigIdsExhausted("No free GPU instance ID");
+                }
+                DcgmNs::Mig::GpuInstanceId gpuInstanceId { *gpuInstanceSlot };
 
                 DcgmGpuInstance dgi(gpuInstanceId,
                                     gpuInstanceInfo.id,
@@ -801,8 +865,13 @@ dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo
                         }
                         first = false;
 
-                        ci.dcgmComputeInstanceId
-                            = DcgmNs::Mig::ComputeInstanceId { gpuInfo.gpuId * maxGpcs + gpuInfo.ciCount };
+                        auto const computeInstanceSlot
+                            = computeInstanceIds.Take({ gpuInstanceInfo.id, computeInstanceInfo.id });
+                        if (!computeInstanceSlot.has_value())
+                        {
+                            throw MigIdsExhausted("No free compute instance ID");
+                        }
+                        ci.dcgmComputeInstanceId = DcgmNs::Mig::ComputeInstanceId { *computeInstanceSlot };
 
                         gpuInfo.ciCount += 1;
 
@@ -839,8 +908,6 @@ dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo
                         }
 
                         dgi.AddComputeInstance(ci);
-                        m_migManager.RecordGpuComputeInstance(gpuInfo.gpuId, gpuInstanceId, ci.dcgmComputeInstanceId);
-                        m_numComputeInstances++;
                     }
                 }
 
@@ -853,12 +920,14 @@ dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo
                 }
 
                 gpuInfo.instances.push_back(dgi);
-
-                m_migManager.RecordGpuInstance(gpuInfo.gpuId, gpuInstanceId);
-                m_numInstances++;
             }
         }
     }
+    catch (MigIdsExhausted const &ex)
+    {
+        log_debug("[MIG] Cannot keep the IDs of the MIG entities of gpuId {}: {}", gpuInfo.gpuId, ex.what());
+        return DCGM_ST_INSUFFICIENT_RESOURCES;
+    }
     catch (DcgmNs::DcgmException const &ex)
     {
         DCGM_LOG_ERROR << "[MIG] Unable to initialize gpu instances. Ex: " << ex.what();
@@ -877,10 +946,112 @@ dcgmReturn_t DcgmCacheManager::InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ReinitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo)
+{
+    DcgmMigIdSnapshot const before = SnapshotMigIds(gpuInfo);
+
+    /* Subscribers hear about every re-read since the last notification at once */
+    m_unnotifiedMigIds.try_emplace(gpuInfo.gpuId, before);
+
+    /* Memory totals are read again under the new MIG configuration */
+    m_staticFields.InvalidateGpu(gpuInfo.gpuId);
+
+    ClearGpuMigInfo(gpuInfo);
+    dcgmReturn_t ret = InitializeGpuInstances(gpuInfo, &before);
+    if (ret == DCGM_ST_INSUFFICIENT_RESOURCES)
+    {
+        log_info("Too many MIG entities were replaced at once on gpuId {} to keep their IDs. Renumbering them all",
+                 gpuInfo.gpuId);
+        ClearGpuMigInfo(gpuInfo);
+        ret = InitializeGpuInstances(gpuInfo);
+    }
+
+    DcgmMigHierarchyDelta const delta = DiffMigIds(before, SnapshotMigIds(gpuInfo));
+    if (!delta.IsEmpty())
+    {
+        InvalidateTopologySnapshot();
+    }
+
+    /* Forget the IDs that nothing has anymore. The ones that were handed to a new instance were recorded again */
+    for (auto const &gpuInstanceId : delta.removedGpuInstances)
+    {
+        if (std::ranges::find(delta.addedGpuInstances, gpuInstanceId) == delta.addedGpuInstances.end())
+        {
+            m_migManager.RemoveGpuInstance(gpuInstanceId);
+        }
+    }
+    for (auto const &computeInstanceId : delta.removedComputeInstances)
+    {
+        if (std::ranges::find(delta.addedComputeInstances, computeInstanceId) == delta.addedComputeInstances.end())
+        {
+            m_migManager.RemoveComputeInstance(computeInstanceId);
+        }
+    }
+
+    log_debug("MIG reconfiguration of gpuId {} added {} GPU instances and {} compute instances, removed {} and {}",
+              gpuInfo.gpuId,
+              delta.addedGpuInstances.size(),
+              delta.addedComputeInstances.size(),
+              delta.removedGpuInstances.size(),
+              delta.removedComputeInstances.size());
+
+    return ret;
+}
+
+/*****************************************************************************/
+DcgmMigIdSnapshot DcgmCacheManager::SnapshotMigIds(dcgmcm_gpu_info_t const &gpuInfo)
+{
+    DcgmMigIdSnapshot snapshot;
+
+    for (auto const &gpuInstance : gpuInfo.instances)
+    {
+        unsigned int const nvmlGpuInstanceId = gpuInstance.GetNvmlInstanceId().id;
+        snapshot.gpuInstances[nvmlGpuInstanceId] = gpuInstance.GetInstanceId();
+
+        for (unsigned int i = 0; i < gpuInstance.GetComputeInstanceCount(); i++)
+        {
+            dcgmcm_gpu_compute_instance_t ci {};
+            if (gpuInstance.GetComputeInstance(i, ci) == DCGM_ST_OK)
+            {
+                snapshot.computeInstances[{ nvmlGpuInstanceId, ci.nvmlComputeInstanceId.id }]
+                    = ci.dcgmComputeInstanceId;
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+/*****************************************************************************/
+DcgmMigHierarchyDelta DcgmCacheManager::DiffMigIds(DcgmMigIdSnapshot const &before, DcgmMigIdSnapshot const &after)
+{
+    DcgmMigHierarchyDelta delta;
+
+    auto diff = [](auto const &from, auto const &to, auto &changed) {
+        for (auto const &[nvmlIds, dcgmId] : from)
+        {
+            auto it = to.find(nvmlIds);
+            if (it == to.end() || it->second != dcgmId)
+            {
+                changed.push_back(dcgmId);
+            }
+        }
+    };
+
+    diff(after.gpuInstances, before.gpuInstances, delta.addedGpuInstances);
+    diff(before.gpuInstances, after.gpuInstances, delta.removedGpuInstances);
+    diff(after.computeInstances, before.computeInstances, delta.addedComputeInstances);
+    diff(before.computeInstances, after.computeInstances, delta.removedComputeInstances);
+
+    return delta;
+}
+
 /*****************************************************************************/
 // NOTE: NVML is initialized by DcgmHostEngineHandler before DcgmCacheManager is instantiated
 DcgmCacheManager::DcgmCacheManager()
-    : m_pollInLockStep(0)
+    : DcgmTaskRunner(DcgmNs::TaskQueueKind::LockFree)
+    , m_pollInLockStep(0)
     , m_maxSampleAgeUsec((timelib64_t)3600 * 1000000)
     , m_driverIsR450OrNewer(false)
     , m_driverIsR520OrNewer(false)
@@ -895,36 +1066,53 @@ DcgmCacheManager::DcgmCacheManager()
     , m_waitForDriverClearCount(0)
     , m_nvmlEventSetInitialized(false)
     , m_nvmlEventSet()
+    , m_gpuEventSetInitialized {}
+    , m_gpuEventSets {}
     , m_runStats {}
     , m_subscriptions()
     , m_migManager()
     , m_delayedMigReconfigProcessingTimestamp(0)
+    , m_lastNvLinkStateRefreshUsec(0)
     , m_forceProfMetricsThroughGpm(false)
     , m_nvmlInjectionManager()
     , m_updateThreadCtx(nullptr)
+    , m_perGpuUpdateWorkers(false)
+    , m_ringBufferTimeSeries(false)
+    , m_compressedTimeSeries(false)
+    , m_deadlineScheduler(false)
+    , m_updateSlackUsec(0)
+    , m_sampleRollups(false)
+    , m_sampleArena(false)
+    , m_nvmlSampleBufferUsec(0)
+    , m_snapshotIntervalUsec(60 * 1000000LL)
+    , m_lastSnapshotUsec(0)
+    , m_lastMemoryBudgetCheckUsec(0)
+    , m_perGpuEventThreads(false)
+    , m_eventDrivenMemoryErrors(false)
+    , m_memoryErrorSafetyPollUsec(300 * 1000000LL)
+    , m_memoryErrorEventsRegistered {}
+    , m_memoryErrorEventUsec {}
+    , m_breakerTimeoutUsec(0)
+    , m_breakerThreshold(3)
+    , m_updateWorkerCycle(0)
+    , m_updateWorkersPending(0)
+    , m_fieldSnapshotPool()
+    , m_lastFieldSnapshotId(0)
     , m_skipDriverCalls(false)
 {
-    int kvSt = 0;
-
-    m_entityWatchHashTable   = 0;
     m_haveAnyLiveSubscribers = false;
 
     m_mutex         = new DcgmMutex(0);
     m_nvmlTopoMutex = new DcgmMutex(0);
     // m_mutex->EnableDebugLogging(true);
-
-    m_entityWatchHashTable = hashtable_create(entityKeyHashCB, entityKeyCmpCB, 0, entityValueFreeCB);
-    if (!m_entityWatchHashTable)
+    if (DcgmMutex::ProfilingRequested())
     {
-        log_fatal("hashtable_create failed");
-        throw std::runtime_error("DcgmCacheManager failed to create its hashtable.");
+        m_mutex->EnableProfiling("CacheManager");
+        m_nvmlTopoMutex->EnableProfiling("CacheManagerNvmlTopo");
     }
 
     memset(&m_currentEventMask[0], 0, sizeof(m_currentEventMask));
 
-    m_accountingPidsSeen
-        = keyedvector_alloc(sizeof(dcgmcm_pid_seen_t), 0, dcgmcm_pidSeenCmpCB, dcgmcm_pidSeenMergeCB, 0, 0, &kvSt);
-
     for (unsigned short fieldId = 1; fieldId < DCGM_FI_MAX_FIELDS; ++fieldId)
     {
         dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
@@ -943,6 +1131,131 @@ DcgmCacheManager::DcgmCacheManager()
         m_forceProfMetricsThroughGpm = true;
     }
     DCGM_LOG_DEBUG << "Set m_forceProfMetricsThroughGpm to " << m_forceProfMetricsThroughGpm;
+
+    const char *workersEnvStr = getenv("__DCGM_PER_GPU_UPDATE_WORKERS__");
+    if (workersEnvStr && workersEnvStr[0] == '1')
+    {
+        m_perGpuUpdateWorkers = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_perGpuUpdateWorkers to " << m_perGpuUpdateWorkers;
+
+    const char *eventThreadsEnvStr = getenv("__DCGM_PER_GPU_EVENT_THREADS__");
+    if (eventThreadsEnvStr && eventThreadsEnvStr[0] == '1')
+    {
+        m_perGpuEventThreads = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_perGpuEventThreads to " << m_perGpuEventThreads;
+
+    const char *memoryErrorsEnvStr = getenv("__DCGM_EVENT_DRIVEN_MEMORY_ERRORS__");
+    if (memoryErrorsEnvStr && memoryErrorsEnvStr[0] == '1')
+    {
+        m_eventDrivenMemoryErrors = true;
+    }
+    const char *safetyPollEnvStr = getenv("__DCGM_MEMORY_ERROR_SAFETY_POLL_SEC__");
+    if (safetyPollEnvStr)
+    {
+        m_memoryErrorSafetyPollUsec = std::max(1LL, strtoll(safetyPollEnvStr, nullptr, 10)) * 1000000LL;
+    }
+    DCGM_LOG_DEBUG << "Set m_eventDrivenMemoryErrors to " << m_eventDrivenMemoryErrors
+                   << ", m_memoryErrorSafetyPollUsec to " << m_memoryErrorSafetyPollUsec;
+
+    const char *breakerTimeoutEnvStr = getenv("__DCGM_GPU_BREAKER_TIMEOUT_MS__");
+    if (breakerTimeoutEnvStr)
+    {
+        m_breakerTimeoutUsec = std::max(0LL, strtoll(breakerTimeoutEnvStr, nullptr, 10)) * 1000LL;
+    }
+    const char *breakerThresholdEnvStr = getenv("__DCGM_GPU_BREAKER_THRESHOLD__");
+    if (breakerThresholdEnvStr)
+    {
+        m_breakerThreshold = std::max(1LL, strtoll(breakerThresholdEnvStr, nullptr, 10));
+    }
+    DCGM_LOG_DEBUG << "Set m_breakerTimeoutUsec to " << m_breakerTimeoutUsec << ", m_breakerThreshold to "
+                   << m_breakerThreshold;
+
+    const char *ringEnvStr = getenv("__DCGM_RING_BUFFER_TIMESERIES__");
+    if (ringEnvStr && ringEnvStr[0] == '1')
+    {
+        m_ringBufferTimeSeries = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_ringBufferTimeSeries to " << m_ringBufferTimeSeries;
+
+    const char *compressedEnvStr = getenv("__DCGM_COMPRESSED_TIMESERIES__");
+    if (compressedEnvStr && compressedEnvStr[0] == '1')
+    {
+        m_compressedTimeSeries = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_compressedTimeSeries to " << m_compressedTimeSeries;
+
+    const char *schedulerEnvStr = getenv("__DCGM_DEADLINE_SCHEDULER__");
+    if (schedulerEnvStr && schedulerEnvStr[0] == '1')
+    {
+        m_deadlineScheduler = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_deadlineScheduler to " << m_deadlineScheduler;
+
+    const char *slackEnvStr = getenv("__DCGM_UPDATE_SLACK_USEC__");
+    if (slackEnvStr)
+    {
+        m_updateSlackUsec = std::max(0LL, strtoll(slackEnvStr, nullptr, 10));
+    }
+    DCGM_LOG_DEBUG << "Set m_updateSlackUsec to " << m_updateSlackUsec;
+
+    const char *rollupsEnvStr = getenv("__DCGM_SAMPLE_ROLLUPS__");
+    if (rollupsEnvStr && rollupsEnvStr[0] == '1')
+    {
+        m_sampleRollups = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_sampleRollups to " << m_sampleRollups;
+
+    const char *arenaEnvStr = getenv("__DCGM_SAMPLE_ARENA__");
+    if (arenaEnvStr && arenaEnvStr[0] == '1')
+    {
+        m_sampleArena = true;
+    }
+    DCGM_LOG_DEBUG << "Set m_sampleArena to " << m_sampleArena;
+
+    const char *changeOnlyEnvStr = getenv("__DCGM_CHANGE_ONLY_FIELDS__");
+    if (changeOnlyEnvStr)
+    {
+        for (auto const &fieldIdStr : dcgmTokenizeString(changeOnlyEnvStr, ","))
+        {
+            unsigned long const fieldId = strtoul(fieldIdStr.c_str(), nullptr, 10);
+            if (fieldId == 0 || fieldId >= DCGM_FI_MAX_FIELDS)
+            {
+                log_error("Ignoring invalid fieldId \"{}\" in __DCGM_CHANGE_ONLY_FIELDS__", fieldIdStr);
+                continue;
+            }
+            m_changeOnlyFieldIds.set(fieldId);
+        }
+    }
+    DCGM_LOG_DEBUG << "Set " << m_changeOnlyFieldIds.count() << " change-only fields";
+
+    const char *sampleBufferEnvStr = getenv("__DCGM_NVML_SAMPLE_BUFFER_USEC__");
+    if (sampleBufferEnvStr)
+    {
+        m_nvmlSampleBufferUsec = std::max(0LL, strtoll(sampleBufferEnvStr, nullptr, 10));
+    }
+    DCGM_LOG_DEBUG << "Set m_nvmlSampleBufferUsec to " << m_nvmlSampleBufferUsec;
+
+    const char *snapshotEnvStr = getenv("__DCGM_CACHE_SNAPSHOT_FILE__");
+    if (snapshotEnvStr && snapshotEnvStr[0] != '\0')
+    {
+        m_snapshotPath = snapshotEnvStr;
+    }
+    const char *snapshotIntervalEnvStr = getenv("__DCGM_CACHE_SNAPSHOT_INTERVAL_SEC__");
+    if (snapshotIntervalEnvStr)
+    {
+        m_snapshotIntervalUsec = std::max(1LL, strtoll(snapshotIntervalEnvStr, nullptr, 10)) * 1000000LL;
+    }
+    DCGM_LOG_DEBUG << "Set m_snapshotPath to \"" << m_snapshotPath << "\", m_snapshotIntervalUsec to "
+                   << m_snapshotIntervalUsec;
+
+    const char *memoryBudgetEnvStr = getenv(DCGM_ENV_CACHE_MEMORY_BUDGET_MB);
+    if (memoryBudgetEnvStr)
+    {
+        SetMemoryBudget(std::max(0LL, strtoll(memoryBudgetEnvStr, nullptr, 10)) * 1024LL * 1024LL);
+    }
+    DCGM_LOG_DEBUG << "Set the memory budget to " << m_memoryBudgetStats.budgetBytes << " bytes";
 }
 
 /*****************************************************************************/
@@ -956,17 +1269,7 @@ DcgmCacheManager::~DcgmCacheManager()
     delete m_nvmlTopoMutex;
     m_nvmlTopoMutex = nullptr;
 
-    if (m_entityWatchHashTable)
-    {
-        hashtable_destroy(m_entityWatchHashTable);
-        m_entityWatchHashTable = 0;
-    }
-
-    if (m_accountingPidsSeen)
-    {
-        keyedvector_destroy(m_accountingPidsSeen);
-        m_accountingPidsSeen = 0;
-    }
+    FreeAllWatchInfos();
 
     UninitializeNvmlEventSet();
 }
@@ -979,6 +1282,20 @@ void DcgmCacheManager::UninitializeNvmlEventSet()
         nvmlEventSetFree(m_nvmlEventSet);
         m_nvmlEventSetInitialized = false;
     }
+
+    for (unsigned int gpuId = 0; gpuId < DCGM_MAX_NUM_DEVICES; gpuId++)
+    {
+        if (m_gpuEventSetInitialized[gpuId])
+        {
+            nvmlEventSetFree(m_gpuEventSets[gpuId]);
+            m_gpuEventSetInitialized[gpuId] = false;
+            /* Events have to be registered again on the next set */
+            m_currentEventMask[gpuId] = 0;
+        }
+    }
+
+    /* Memory error watches are polled until their events are registered on a new set */
+    m_memoryErrorEventsRegistered.fill(false);
 }
 
 /*****************************************************************************/
@@ -998,6 +1315,30 @@ dcgmReturn_t DcgmCacheManager::InitializeNvmlEventSet()
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetEventSetForGpu(unsigned int gpuId, nvmlEventSet_t &eventSet)
+{
+    if (!m_perGpuEventThreads)
+    {
+        eventSet = m_nvmlEventSet;
+        return DCGM_ST_OK;
+    }
+
+    if (!m_gpuEventSetInitialized[gpuId])
+    {
+        nvmlReturn_t nvmlReturn = nvmlEventSetCreate(&m_gpuEventSets[gpuId]);
+        if (nvmlReturn != NVML_SUCCESS)
+        {
+            log_error("Error {} from nvmlEventSetCreate for gpuId {}", nvmlErrorString(nvmlReturn), gpuId);
+            return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+        }
+        m_gpuEventSetInitialized[gpuId] = true;
+    }
+
+    eventSet = m_gpuEventSets[gpuId];
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************/
 dcgmcm_watch_info_p DcgmCacheManager::GetGlobalWatchInfo(unsigned int fieldId, int createIfNotExists)
 {
@@ -1181,6 +1522,8 @@ dcgmReturn_t DcgmCacheManager::DetachGpus()
     {
         m_gpus[i].status = DcgmEntityStatusDetached; // Should we use an existing status?
     }
+    InvalidateTopologySnapshot();
+    m_staticFields.InvalidateAll();
 
     dcgm_mutex_unlock(m_mutex);
 
@@ -1278,24 +1621,104 @@ void DcgmCacheManager::InitializeNvLinkCount(dcgmcm_gpu_info_t &gpuInfo)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AttachGpus()
+dcgmReturn_t DcgmCacheManager::ProbeGpu(dcgmcm_gpu_info_t &gpuInfo)
 {
     nvmlReturn_t nvmlSt;
-    unsigned int nvmlDeviceCount = 0;
-    int detectedGpusCount        = 0;
-    dcgmcm_gpu_info_t detectedGpus[DCGM_MAX_NUM_DEVICES]; /* All of the GPUs we know about, indexed by gpuId */
-    memset(&detectedGpus, 0, sizeof(detectedGpus));
     dcgmReturn_t ret;
 
-    if (m_nvmlLoaded == false)
+    nvmlSt = nvmlDeviceGetHandleByIndex_v2(gpuInfo.nvmlIndex, &gpuInfo.nvmlDevice);
+
+    // if nvmlReturn == NVML_ERROR_NO_PERMISSION this is ok
+    // but it should be logged in case it is unexpected
+    if (nvmlSt == NVML_ERROR_NO_PERMISSION)
     {
-        log_debug("Not attaching to GPUs because NVML is not loaded.");
-        // NO-OP
+        log_warning("GPU {} initialization was skipped due to no permissions.", gpuInfo.nvmlIndex);
+        gpuInfo.status = DcgmEntityStatusInaccessible;
         return DCGM_ST_OK;
     }
-
-    dcgm_mutex_lock(m_mutex);
-    m_numInstances        = 0;
+    else if (nvmlSt != NVML_SUCCESS)
+    {
+        log_error(
+            "Got nvml error {} from nvmlDeviceGetHandleByIndex_v2 of nvmlIndex {}", (int)nvmlSt, gpuInfo.nvmlIndex);
+        /* Treat this error as inaccessible */
+        gpuInfo.status = DcgmEntityStatusInaccessible;
+        return DCGM_ST_OK;
+    }
+
+    nvmlSt = nvmlDeviceGetUUID(gpuInfo.nvmlDevice, gpuInfo.uuid, sizeof(gpuInfo.uuid));
+    if (nvmlSt != NVML_SUCCESS)
+    {
+        log_error("Got nvml error {} from nvmlDeviceGetUUID of nvmlIndex {}", (int)nvmlSt, gpuInfo.nvmlIndex);
+        /* Non-fatal. Keep going. */
+    }
+
+    nvmlBrandType_t nvmlBrand = NVML_BRAND_UNKNOWN;
+    nvmlSt                    = nvmlDeviceGetBrand(gpuInfo.nvmlDevice, &nvmlBrand);
+    if (nvmlSt != NVML_SUCCESS)
+    {
+        log_error("Got nvml error {} from nvmlDeviceGetBrand of nvmlIndex {}", (int)nvmlSt, gpuInfo.nvmlIndex);
+        /* Non-fatal. Keep going. */
+    }
+    gpuInfo.brand = (dcgmGpuBrandType_t)nvmlBrand;
+
+    nvmlSt = nvmlDeviceGetPciInfo_v3(gpuInfo.nvmlDevice, &gpuInfo.pciInfo);
+    if (nvmlSt != NVML_SUCCESS)
+    {
+        log_error("Got nvml error {} from nvmlDeviceGetPciInfo_v3 of nvmlIndex {}", (int)nvmlSt, gpuInfo.nvmlIndex);
+        /* Non-fatal. Keep going. */
+    }
+
+    /* Read the arch before we check the allowlist since the arch is used for the allowlist */
+    ret = HelperGetLiveChipArch(gpuInfo.nvmlDevice, gpuInfo.arch);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Got error {} from HelperGetLiveChipArch of nvmlIndex {}", (int)ret, gpuInfo.nvmlIndex);
+        /* Non-fatal. Keep going. */
+    }
+
+    /* Get the virtualization mode of the GPU */
+
+    nvmlGpuVirtualizationMode_t nvmlVirtualMode;
+    nvmlSt = nvmlDeviceGetVirtualizationMode(gpuInfo.nvmlDevice, &nvmlVirtualMode);
+    if (nvmlSt == NVML_SUCCESS)
+    {
+        gpuInfo.virtualizationMode = (dcgmGpuVirtualizationMode_t)nvmlVirtualMode;
+    }
+    else
+    {
+        gpuInfo.virtualizationMode = DCGM_GPU_VIRTUALIZATION_MODE_NONE;
+        DCGM_LOG_ERROR << "nvmlDeviceGetVirtualizationMode returned " << (int)nvmlSt << " for nvmlIndex "
+                       << gpuInfo.nvmlIndex;
+        /* Non-fatal. Keep going. */
+    }
+
+    InitializeNvLinkCount(gpuInfo);
+
+    return ReadGpuInstances(gpuInfo);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AttachGpus()
+{
+    nvmlReturn_t nvmlSt;
+    unsigned int nvmlDeviceCount = 0;
+    int detectedGpusCount        = 0;
+    dcgmcm_gpu_info_t detectedGpus[DCGM_MAX_NUM_DEVICES]; /* All of the GPUs we know about, indexed by gpuId */
+    memset(&detectedGpus, 0, sizeof(detectedGpus));
+    dcgmReturn_t ret;
+
+    if (m_nvmlLoaded == false)
+    {
+        log_debug("Not attaching to GPUs because NVML is not loaded.");
+        // NO-OP
+        return DCGM_ST_OK;
+    }
+
+    auto const attachStart = std::chrono::steady_clock::now();
+    auto phaseStart        = attachStart;
+
+    dcgm_mutex_lock(m_mutex);
+    m_numInstances        = 0;
     m_numComputeInstances = 0;
 
     // Generally speaking this will be true every time except the first time this is called
@@ -1346,83 +1769,51 @@ dcgmReturn_t DcgmCacheManager::AttachGpus()
         /* Non-fatal. Keep going. */
     }
 
+    log_info("[Startup] Initialized NVML and read the driver versions in {} ms",
+             DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    phaseStart = std::chrono::steady_clock::now();
+
     for (int i = 0; i < detectedGpusCount; i++)
     {
         detectedGpus[i].gpuId     = i; /* For now, gpuId == index == nvmlIndex */
         detectedGpus[i].nvmlIndex = i;
         detectedGpus[i].status    = DcgmEntityStatusOk; /* Start out OK */
         detectedGpus[i].ccMode    = ccMode.ccFeature;
+    }
 
-        nvmlSt = nvmlDeviceGetHandleByIndex_v2(detectedGpus[i].nvmlIndex, &detectedGpus[i].nvmlDevice);
-
-        // if nvmlReturn == NVML_ERROR_NO_PERMISSION this is ok
-        // but it should be logged in case it is unexpected
-        if (nvmlSt == NVML_ERROR_NO_PERMISSION)
-        {
-            log_warning("GPU {} initialization was skipped due to no permissions.", i);
-            detectedGpus[i].status = DcgmEntityStatusInaccessible;
-            continue;
-        }
-        else if (nvmlSt != NVML_SUCCESS)
-        {
-            log_error("Got nvml error {} from nvmlDeviceGetHandleByIndex_v2 of nvmlIndex {}", (int)nvmlSt, i);
-            /* Treat this error as inaccessible */
-            detectedGpus[i].status = DcgmEntityStatusInaccessible;
-            continue;
-        }
-
-        nvmlSt = nvmlDeviceGetUUID(detectedGpus[i].nvmlDevice, detectedGpus[i].uuid, sizeof(detectedGpus[i].uuid));
-        if (nvmlSt != NVML_SUCCESS)
-        {
-            log_error("Got nvml error {} from nvmlDeviceGetUUID of nvmlIndex {}", (int)nvmlSt, i);
-            /* Non-fatal. Keep going. */
-        }
-
-        nvmlBrandType_t nvmlBrand = NVML_BRAND_UNKNOWN;
-        nvmlSt                    = nvmlDeviceGetBrand(detectedGpus[i].nvmlDevice, &nvmlBrand);
-        if (nvmlSt != NVML_SUCCESS)
-        {
-            log_error("Got nvml error {} from nvmlDeviceGetBrand of nvmlIndex {}", (int)nvmlSt, i);
-            /* Non-fatal. Keep going. */
-        }
-        detectedGpus[i].brand = (dcgmGpuBrandType_t)nvmlBrand;
-
-        nvmlSt = nvmlDeviceGetPciInfo_v3(detectedGpus[i].nvmlDevice, &detectedGpus[i].pciInfo);
-        if (nvmlSt != NVML_SUCCESS)
-        {
-            log_error("Got nvml error {} from nvmlDeviceGetPciInfo_v3 of nvmlIndex {}", (int)nvmlSt, i);
-            /* Non-fatal. Keep going. */
-        }
-
-        /* Read the arch before we check the allowlist since the arch is used for the allowlist */
-        ret = HelperGetLiveChipArch(detectedGpus[i].nvmlDevice, detectedGpus[i].arch);
-        if (ret != DCGM_ST_OK)
-        {
-            log_error("Got error {} from HelperGetLiveChipArch of nvmlIndex {}", (int)ret, i);
-            /* Non-fatal. Keep going. */
-        }
-
-        /* Get the virtualization mode of the GPU */
-
-        nvmlGpuVirtualizationMode_t nvmlVirtualMode;
-        nvmlSt = nvmlDeviceGetVirtualizationMode(detectedGpus[i].nvmlDevice, &nvmlVirtualMode);
-        if (nvmlSt == NVML_SUCCESS)
+    /* Every GPU takes dozens of NVML calls to probe, more with MIG enabled. They only touch their own
+       detectedGpus entry, so probe them at the same time and record what they found in order afterwards */
+    std::vector<dcgmReturn_t> probeResults(detectedGpusCount, DCGM_ST_OK);
+    if (detectedGpusCount > 1)
+    {
+        /* The workers mostly wait in the driver, so one per GPU regardless of the number of CPUs */
+        DcgmNs::WorkStealingThreadPool probePool(detectedGpusCount, "dcgm_attach");
+        std::vector<std::optional<std::shared_future<dcgmReturn_t>>> probes;
+        probes.reserve(detectedGpusCount);
+        for (int i = 0; i < detectedGpusCount; i++)
         {
-            detectedGpus[i].virtualizationMode = (dcgmGpuVirtualizationMode_t)nvmlVirtualMode;
+            probes.push_back(probePool.Enqueue([this, &detectedGpus, i] { return ProbeGpu(detectedGpus[i]); }));
         }
-        else
+        for (int i = 0; i < detectedGpusCount; i++)
         {
-            detectedGpus[i].virtualizationMode = DCGM_GPU_VIRTUALIZATION_MODE_NONE;
-            DCGM_LOG_ERROR << "nvmlDeviceGetVirtualizationMode returned " << (int)nvmlSt << " for nvmlIndex " << i;
-            /* Non-fatal. Keep going. */
+            probeResults[i] = probes[i].has_value() ? probes[i]->get() : ProbeGpu(detectedGpus[i]);
         }
+    }
+    else if (detectedGpusCount == 1)
+    {
+        probeResults[0] = ProbeGpu(detectedGpus[0]);
+    }
 
-        InitializeNvLinkCount(detectedGpus[i]);
+    log_info("[Startup] Probed {} GPUs in {} ms", detectedGpusCount, DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    phaseStart = std::chrono::steady_clock::now();
 
-        ret = InitializeGpuInstances(detectedGpus[i]);
-        if (ret != DCGM_ST_OK)
+    for (int i = 0; i < detectedGpusCount; i++)
+    {
+        RecordGpuInstances(detectedGpus[i]);
+        if (probeResults[i] != DCGM_ST_OK)
         {
-            return ret;
+            dcgm_mutex_unlock(m_mutex);
+            return probeResults[i];
         }
     }
 
@@ -1445,12 +1836,22 @@ dcgmReturn_t DcgmCacheManager::AttachGpus()
 
         UpdateNvLinkLinkState(m_gpus[i].gpuId);
     }
+    InvalidateTopologySnapshot();
+    m_staticFields.InvalidateAll();
+
+    log_info("[Startup] Merged the GPU list and read the NvLink states in {} ms",
+             DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    phaseStart = std::chrono::steady_clock::now();
 
     /* Read and cache the GPU exclusion list on each attach */
     ReadAndCacheGpuExclusionList();
 
     dcgm_mutex_unlock(m_mutex);
 
+    log_info("[Startup] Read the GPU exclusion list in {} ms", DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    log_info(
+        "[Startup] Attached to {} GPUs in {} ms", detectedGpusCount, DcgmNs::Timelib::MillisecondsSince(attachStart));
+
     return DCGM_ST_OK;
 }
 
@@ -1595,6 +1996,7 @@ unsigned int DcgmCacheManager::AddFakeGpu(unsigned int pciDeviceId, unsigned int
 
     m_numGpus++;
     m_numFakeGpus++;
+    InvalidateTopologySnapshot();
     dcgm_mutex_unlock(m_mutex);
 
     log_info("DcgmCacheManager::AddFakeGpu {}", gpuId);
@@ -1620,25 +2022,22 @@ unsigned int DcgmCacheManager::AddFakeGpu(void)
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::GetAllGpuInfo(std::vector<dcgmcm_gpu_info_cached_t> &gpuInfo)
 {
-    unsigned int i;
-
-    /* Acquire the lock for consistency */
-    DcgmLockGuard dlg(m_mutex);
-
-    gpuInfo.resize(m_numGpus);
+    gpuInfo = GetGpuInventory()->gpus;
+    return DCGM_ST_OK;
+}
 
-    for (i = 0; i < m_numGpus; i++)
+/*****************************************************************************/
+std::shared_ptr<DcgmGpuInventorySnapshot const> DcgmCacheManager::GetGpuInventory()
+{
+    auto snapshot = m_gpuInventorySnapshot.load();
+    if (snapshot == nullptr)
     {
-        gpuInfo[i].gpuId              = m_gpus[i].gpuId;
-        gpuInfo[i].status             = m_gpus[i].status;
-        gpuInfo[i].brand              = m_gpus[i].brand;
-        gpuInfo[i].nvmlIndex          = m_gpus[i].nvmlIndex;
-        gpuInfo[i].pciInfo            = m_gpus[i].pciInfo;
-        gpuInfo[i].arch               = m_gpus[i].arch;
-        gpuInfo[i].virtualizationMode = m_gpus[i].virtualizationMode;
+        DcgmSharedLockGuard dlg(m_mutex);
+        PublishGpuInventory();
+        snapshot = m_gpuInventorySnapshot.load();
     }
 
-    return DCGM_ST_OK;
+    return snapshot;
 }
 
 /*****************************************************************************/
@@ -1744,19 +2143,7 @@ bool DcgmCacheManager::GetIsValidEntityId(dcgm_field_entity_group_t entityGroupI
             break;
     }
 
-    /* This is O(n^2) but only used by injecting FVs from the test framework */
-    for (size_t i = 0; i < m_numGpus; i++)
-    {
-        for (dcgmcm_vgpu_info_p vgpu = m_gpus[i].vgpuList; vgpu != nullptr; vgpu = vgpu->next)
-        {
-            if (vgpu->vgpuId == entityId)
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return m_vgpuInstanceGpuIds.contains(entityId);
 }
 
 /*****************************************************************************/
@@ -1792,6 +2179,7 @@ dcgm_field_eid_t DcgmCacheManager::AddFakeInstance(dcgm_field_eid_t parentId)
     m_gpus[parentId].migEnabled = true;
     m_gpus[parentId].usedGpcs += 1;
     m_gpus[parentId].maxGpcs = DCGM_MAX_INSTANCES_PER_GPU;
+    PublishEntityStatuses();
 
     return entityId;
 }
@@ -1858,6 +2246,7 @@ dcgm_field_eid_t DcgmCacheManager::AddFakeComputeInstance(dcgm_field_eid_t paren
                 m_migManager.RecordGpuComputeInstance(gpuIndex, gpuInstance.GetInstanceId(), ci.dcgmComputeInstanceId);
                 m_numComputeInstances++;
                 m_gpus[gpuIndex].ciCount++;
+                PublishEntityStatuses();
                 found = true;
                 break;
             }
@@ -1898,6 +2287,7 @@ dcgmReturn_t DcgmCacheManager::SetGpuNvLinkLinkState(unsigned int gpuId,
 
     log_info("Setting gpuId {}, link {} to link state {}", gpuId, linkId, linkState);
     m_gpus[gpuId].nvLinkLinkState[linkId] = linkState;
+    InvalidateTopologySnapshot();
     return DCGM_ST_OK;
 }
 
@@ -1928,6 +2318,14 @@ dcgmReturn_t DcgmCacheManager::Init(int pollInLockStep, double /*maxSampleAge*/,
         return ret;
     }
 
+    if (!m_snapshotPath.empty())
+    {
+        auto const snapshotStart = std::chrono::steady_clock::now();
+        /* A missing or stale snapshot just means a cold start */
+        (void)LoadSnapshot();
+        log_info("[Startup] Loaded the cache snapshot in {} ms", DcgmNs::Timelib::MillisecondsSince(snapshotStart));
+    }
+
     /* Start the event watch before we start the event reading thread */
     ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
 
@@ -1957,6 +2355,12 @@ dcgmReturn_t DcgmCacheManager::Init(int pollInLockStep, double /*maxSampleAge*/,
             log_error("m_kmsgThread->Start() returned {}", st);
             return DCGM_ST_GENERIC_ERROR;
         }
+
+        ret = StartGpuEventThreads();
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
     }
 
     return DCGM_ST_OK;
@@ -2009,6 +2413,8 @@ dcgmReturn_t DcgmCacheManager::Shutdown()
     StopThread(m_eventThread);
     m_eventThread = nullptr;
 
+    StopGpuEventThreads();
+
     log_info("Stopping kmsg thread.");
     StopThread(m_kmsgThread);
     m_kmsgThread = nullptr;
@@ -2039,18 +2445,47 @@ dcgmReturn_t DcgmCacheManager::Shutdown()
         Kill();
     }
 
-    /* Sending an empty vgpuList to free vgpuList of all GPUs*/
+    {
+        /* A cycle still queued will never run. Its waiters were released by its broken promise */
+        std::lock_guard<std::mutex> guard(m_pendingUpdateLock);
+        m_pendingUpdate.reset();
+    }
+
+    /* The main thread is the only one that starts update cycles. Now that it has exited,
+       the update workers can be stopped as well */
+    StopUpdateWorkers();
+    m_fieldSnapshotPool.reset();
+
+    /* Sending an empty vGPU list to unwatch the vGPU instances of all GPUs */
     vgpuInstanceCount = 0;
     for (unsigned int i = 0; i < m_numGpus; i++)
     {
         ManageVgpuList(m_gpus[i].gpuId, &vgpuInstanceCount);
     }
 
-    if (m_entityWatchHashTable)
+    /* Persist the final state so that a restart loses as little history as possible */
+    if (!m_snapshotPath.empty() && m_entityWatchTable.GetSize() > 0)
+    {
+        (void)SaveSnapshot();
+    }
+
+    FreeAllWatchInfos();
+    m_latestValues.Clear();
+    if (m_latestValueSlots)
+    {
+        m_latestValueSlots->UnpublishAll();
+    }
+    if (m_sharedLatestValues)
+    {
+        m_sharedLatestValues->UnpublishAll();
+    }
+
+    for (auto &plan : m_fieldValuePlan)
     {
-        hashtable_destroy(m_entityWatchHashTable);
-        m_entityWatchHashTable = 0;
+        plan.clear();
     }
+    m_watchSchedules.clear();
+    m_watchSetGeneration++;
 
     return retSt;
 }
@@ -2195,9 +2630,24 @@ dcgmcm_watch_info_p DcgmCacheManager::AllocWatchInfo(dcgm_entity_key_t entityKey
     retInfo->monitorIntervalUsec   = 0;
     retInfo->maxAgeUsec            = DCGM_MAX_AGE_USEC_DEFAULT;
     retInfo->execTimeUsec          = 0;
+    retInfo->maxExecTimeUsec       = 0;
     retInfo->fetchCount            = 0;
     retInfo->timeSeries            = 0;
     retInfo->pushedByModule        = false;
+    retInfo->inFieldValuePlan      = false;
+    retInfo->changeOnly            = m_changeOnlyFieldIds.test(entityKey.fieldId);
+    retInfo->historyTimeSeries     = nullptr;
+    retInfo->historyIntervalUsec   = 0;
+    retInfo->historyMaxAgeUsec     = 0;
+    retInfo->lastReadUsec          = 0;
+    retInfo->derivedPrevInput      = 0.0;
+    retInfo->derivedPrevInputUsec  = 0;
+    retInfo->derivedTotal          = 0.0;
+    retInfo->lastDriverReadUsec    = 0;
+    retInfo->lastNvmlSampleTs      = 0;
+    retInfo->latestValueSlot       = m_latestValueSlots ? m_latestValueSlots->Find(entityKey)
+                                                        : DcgmLatestValueSlots::c_noSlot;
+    retInfo->sharedLatestValueRow  = ReserveSharedLatestValueRow(entityKey);
 
     // Explicitly initialize these fields to make valgrind happy
     retInfo->practicalEntityGroupId = static_cast<dcgm_field_entity_group_t>(retInfo->watchKey.entityGroupId);
@@ -2212,8 +2662,36 @@ dcgmcm_watch_info_p DcgmCacheManager::AllocWatchInfo(dcgm_entity_key_t entityKey
 /*****************************************************************************/
 void DcgmCacheManager::FreeWatchInfo(dcgmcm_watch_info_p watchInfo)
 {
-    /* Call the static version that is used by the hashtable callbacks */
-    entityValueFreeCB(watchInfo);
+    if (!watchInfo)
+    {
+        log_error("FreeWatchInfo got NULL watchInfo");
+        return;
+    }
+
+    if (watchInfo->timeSeries)
+    {
+        timeseries_destroy(watchInfo->timeSeries);
+        watchInfo->timeSeries = 0;
+    }
+
+    if (watchInfo->historyTimeSeries)
+    {
+        timeseries_destroy(watchInfo->historyTimeSeries);
+        watchInfo->historyTimeSeries = nullptr;
+    }
+
+    delete (watchInfo);
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::FreeAllWatchInfos()
+{
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        FreeWatchInfo(watchInfo);
+    }
+    m_entityWatchTable.Clear();
+    m_connectionWatches.clear();
 }
 
 /*****************************************************************************/
@@ -2224,9 +2702,7 @@ dcgmcm_watch_info_p DcgmCacheManager::GetEntityWatchInfo(dcgm_field_entity_group
 {
     dcgmcm_watch_info_p retInfo = 0;
     dcgmMutexReturn_t mutexReturn;
-    void *hashKey = 0;
-    static_assert(sizeof(hashKey) == sizeof(dcgm_entity_key_t));
-    int st;
+    dcgm_entity_key_t watchKey;
 
     mutexReturn = dcgm_mutex_lock_me(m_mutex);
 
@@ -2234,9 +2710,9 @@ dcgmcm_watch_info_p DcgmCacheManager::GetEntityWatchInfo(dcgm_field_entity_group
     if (entityGroupId == DCGM_FE_NONE)
         entityId = 0;
 
-    EntityIdToWatchKey((dcgm_entity_key_t *)&hashKey, entityGroupId, entityId, fieldId);
+    EntityIdToWatchKey(&watchKey, entityGroupId, entityId, fieldId);
 
-    retInfo = (dcgmcm_watch_info_p)hashtable_get(m_entityWatchHashTable, hashKey);
+    retInfo = m_entityWatchTable.Find(watchKey);
     if (!retInfo)
     {
         if (!createIfNotExists)
@@ -2251,21 +2727,9 @@ dcgmcm_watch_info_p DcgmCacheManager::GetEntityWatchInfo(dcgm_field_entity_group
         }
 
         /* Allocate a new one */
-        log_debug("Adding WatchInfo on entityKey {} (eg {}, entityId {}, fieldId {})",
-                  (void *)hashKey,
-                  entityGroupId,
-                  entityId,
-                  fieldId);
-        dcgm_entity_key_t addKey;
-        EntityIdToWatchKey(&addKey, entityGroupId, entityId, fieldId);
-        retInfo = AllocWatchInfo(addKey);
-        st      = hashtable_set(m_entityWatchHashTable, hashKey, retInfo);
-        if (st)
-        {
-            log_error("hashtable_set failed with st {}. Likely out of memory", st);
-            FreeWatchInfo(retInfo);
-            retInfo = 0;
-        }
+        log_debug("Adding WatchInfo on eg {}, entityId {}, fieldId {}", entityGroupId, entityId, fieldId);
+        retInfo = AllocWatchInfo(watchKey);
+        m_entityWatchTable.Insert(watchKey, retInfo);
     }
 
     if (mutexReturn == DCGM_MUTEX_ST_OK)
@@ -2274,53 +2738,11 @@ dcgmcm_watch_info_p DcgmCacheManager::GetEntityWatchInfo(dcgm_field_entity_group
     return retInfo;
 }
 
-/*****************************************************************************/
-int DcgmCacheManager::HasAccountingPidBeenSeen(unsigned int pid, timelib64_t timestamp)
-{
-    dcgmcm_pid_seen_t key, *elem;
-    kv_cursor_t cursor;
-
-    key.pid       = pid;
-    key.timestamp = timestamp;
-
-    elem = (dcgmcm_pid_seen_p)keyedvector_find_by_key(m_accountingPidsSeen, &key, KV_LGE_EQUAL, &cursor);
-    if (elem)
-    {
-        log_debug("PID {}, ts {} FOUND in seen cache", key.pid, (long long)key.timestamp);
-        return 1;
-    }
-    else
-    {
-        log_debug("PID {}, ts {} NOT FOUND in seen cache", key.pid, (long long)key.timestamp);
-        return 0;
-    }
-}
-
-/*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::CacheAccountingPid(unsigned int pid, timelib64_t timestamp)
-{
-    dcgmcm_pid_seen_t key;
-    int st;
-    kv_cursor_t cursor;
-
-    key.pid       = pid;
-    key.timestamp = timestamp;
-
-    st = keyedvector_insert(m_accountingPidsSeen, &key, &cursor);
-    if (st)
-    {
-        log_error("Error {} from keyedvector_insert pid {}, timestamp {}", st, key.pid, (long long)key.timestamp);
-        return DCGM_ST_GENERIC_ERROR;
-    }
-
-    return DCGM_ST_OK;
-}
-
 /*****************************************************************************/
 void DcgmCacheManager::EmptyAccountingPidCache(void)
 {
     log_debug("Pid seen cache emptied");
-    keyedvector_empty(m_accountingPidsSeen);
+    m_accountingPidsSeen.Clear();
 }
 
 /*****************************************************************************/
@@ -2362,10 +2784,19 @@ dcgmReturn_t DcgmCacheManager::Start(void)
 {
     SetThreadName("cache_mgr_main");
 
+    /* The workers only wait for cycles until the cache manager thread runs one. Start them first so that
+       m_updateWorkers never changes under that thread */
+    dcgmReturn_t dcgmReturn = StartUpdateWorkers();
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
     int st = DcgmThread::Start();
     if (st)
     {
         DCGM_LOG_ERROR << "DcgmThread::Start() returned " << st;
+        StopUpdateWorkers();
         return DCGM_ST_GENERIC_ERROR;
     }
 
@@ -2393,13 +2824,30 @@ dcgmReturn_t DcgmCacheManager::Start(void)
 /*********************************f********************************************/
 DcgmEntityStatus_t DcgmCacheManager::GetGpuStatus(unsigned int gpuId)
 {
-    log_debug("Checking status for gpu {}", gpuId);
+    if (auto const status = m_entityStatuses.GetGpuStatus(gpuId); status.has_value())
+    {
+        return *status;
+    }
+
     if (gpuId >= m_numGpus)
         return DcgmEntityStatusUnknown;
 
     return m_gpus[gpuId].status;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SetGpuStatus(unsigned int gpuId, DcgmEntityStatus_t status)
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    if (gpuId >= m_numGpus)
+        return DCGM_ST_BADPARAM;
+
+    m_gpus[gpuId].status = status;
+    InvalidateTopologySnapshot();
+    return DCGM_ST_OK;
+}
+
 /******************************************************************************/
 dcgmReturn_t DcgmCacheManager::GetGpuArch(unsigned int gpuId, dcgmChipArchitecture_t &arch)
 {
@@ -2429,6 +2877,7 @@ dcgmReturn_t DcgmCacheManager::PauseGpu(unsigned int gpuId)
             /* Pause the GPU */
             log_info("gpuId {} PAUSED.", gpuId);
             m_gpus[gpuId].status = DcgmEntityStatusDisabled;
+            InvalidateTopologySnapshot();
             /* Force an update to occur so that we get blank values saved */
             (void)UpdateAllFields(1);
             return DCGM_ST_OK;
@@ -2453,6 +2902,7 @@ dcgmReturn_t DcgmCacheManager::ResumeGpu(unsigned int gpuId)
             /* Pause the GPU */
             log_info("gpuId {} RESUMED.", gpuId);
             m_gpus[gpuId].status = DcgmEntityStatusOk;
+            InvalidateTopologySnapshot();
             return DCGM_ST_OK;
     }
 
@@ -2487,20 +2937,57 @@ dcgmReturn_t DcgmCacheManager::Resume()
 dcgmReturn_t DcgmCacheManager::UpdateAllFields(int waitForUpdate)
 {
     using namespace DcgmNs;
-    auto task = Enqueue(make_task("DoOneUpdateAllFields", [this] { return DoOneUpdateAllFields(); }));
+    std::shared_future<void> updateDone;
 
-    if (!task.has_value())
     {
-        DCGM_LOG_ERROR << "Unable to enqueueDoOneUpdateAllFields";
-        return DCGM_ST_GENERIC_ERROR;
+        std::lock_guard<std::mutex> guard(m_pendingUpdateLock);
+
+        if (m_pendingUpdate.has_value()
+            && m_pendingUpdate->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            /* The task of this cycle was dropped without running, breaking its promise. Queue a new one */
+            log_debug("Replacing an update cycle that was dropped before it started");
+            m_pendingUpdate.reset();
+        }
+
+        if (m_pendingUpdate.has_value())
+        {
+            /* A cycle that hasn't started yet will see everything this caller wants updated */
+            updateDone = *m_pendingUpdate;
+            m_runStats.updatesCoalesced++;
+        }
+        else
+        {
+            auto updatePromise = std::make_shared<std::promise<void>>();
+            updateDone         = updatePromise->get_future().share();
+
+            auto task = Enqueue(make_task("DoOneUpdateAllFields", [this, updatePromise] {
+                {
+                    /* Callers from here on need another cycle */
+                    std::lock_guard<std::mutex> startGuard(m_pendingUpdateLock);
+                    m_pendingUpdate.reset();
+                }
+
+                timelib64_t nextWakeup = DoOneUpdateAllFields();
+                updatePromise->set_value();
+                return nextWakeup;
+            }));
+
+            if (!task.has_value())
+            {
+                DCGM_LOG_ERROR << "Unable to enqueueDoOneUpdateAllFields";
+                return DCGM_ST_GENERIC_ERROR;
+            }
+
+            m_pendingUpdate = updateDone;
+        }
     }
-    else if (waitForUpdate)
+
+    if (waitForUpdate)
     {
         if (HasRun())
         {
-            /* Wait for the return value */
-            timelib64_t nextWakeup = (*task).get();
-            DCGM_LOG_DEBUG << "DoOneUpdateAllFields returned " << (long long)nextWakeup;
+            updateDone.wait();
         }
         else
         {
@@ -2512,37 +2999,141 @@ dcgmReturn_t DcgmCacheManager::UpdateAllFields(int waitForUpdate)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::ManageDeviceEvents(unsigned int /* addWatchOnGpuId */,
-                                                  unsigned short /* addWatchOnFieldId */)
+dcgmReturn_t DcgmCacheManager::UpdateFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                            std::vector<unsigned short> const &fieldIds,
+                                            int waitForUpdate)
 {
-    unsigned long long desiredEvents[DCGM_MAX_NUM_DEVICES] = { 0 };
-    unsigned long long eventsMap                           = nvmlEventTypeXidCriticalError;
-    int somethingChanged;
-    unsigned int gpuId;
-    nvmlReturn_t nvmlReturn;
-    nvmlDevice_t nvmlDevice = 0;
-    dcgmReturn_t ret        = DCGM_ST_OK;
+    using namespace DcgmNs;
 
-    /* First, walk all GPUs to build a bitmask of which event types we care about */
-    somethingChanged = 0;
-    for (gpuId = 0; gpuId < m_numGpus; gpuId++)
+    for (unsigned short fieldId : fieldIds)
     {
-        if (m_gpus[gpuId].status == DcgmEntityStatusDetached)
-            continue;
-
-            /* We always subscribe for XIDs so that we have SOMETHING watched. Otherwise,
-           the event thread won't start */
-#if 1
-        if (m_gpus[gpuId].arch >= DCGM_CHIP_ARCH_AMPERE && m_driverIsR450OrNewer && IsGpuMigEnabled(gpuId))
-        {
-            desiredEvents[gpuId] |= eventsMap | nvmlEventMigConfigChange;
-        }
-        else
+        if (DcgmFieldGetById(fieldId) == nullptr)
         {
-            desiredEvents[gpuId] |= eventsMap;
+            return DCGM_ST_UNKNOWN_FIELD;
         }
+    }
 
-#else
+    auto task = Enqueue(make_task("DoOneUpdateFields", [this, entities, fieldIds] {
+        DoOneUpdateFields(entities, fieldIds);
+    }));
+
+    if (!task.has_value())
+    {
+        DCGM_LOG_ERROR << "Unable to enqueue DoOneUpdateFields";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+    else if (waitForUpdate)
+    {
+        if (HasRun())
+        {
+            (*task).wait();
+        }
+        else
+        {
+            DCGM_LOG_DEBUG << "Skipping waitForUpdate since cache thread hasn't run yet.";
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SnapshotFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                              std::vector<unsigned short> const &fieldIds,
+                                              timelib64_t &snapshotId)
+{
+    using namespace DcgmNs;
+
+    for (unsigned short fieldId : fieldIds)
+    {
+        if (DcgmFieldGetById(fieldId) == nullptr)
+        {
+            log_error("Unknown fieldId {}", fieldId);
+            return DCGM_ST_UNKNOWN_FIELD;
+        }
+    }
+
+    auto task = Enqueue(make_task("DoOneSnapshotFields", [this, entities, fieldIds] {
+        return DoOneSnapshotFields(entities, fieldIds);
+    }));
+
+    if (!task.has_value())
+    {
+        log_error("Unable to enqueue DoOneSnapshotFields");
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    snapshotId = (*task).get();
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::GetWatchesOfFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                          std::vector<unsigned short> const &fieldIds,
+                                          std::vector<dcgmcm_watch_info_p> &watches)
+{
+    watches.reserve(entities.size() * fieldIds.size());
+
+    for (unsigned short fieldId : fieldIds)
+    {
+        if (DcgmFieldGetById(fieldId)->scope == DCGM_FS_GLOBAL)
+        {
+            dcgmcm_watch_info_p watchInfo = GetGlobalWatchInfo(fieldId, 0);
+            if (watchInfo != nullptr && watchInfo->isWatched)
+            {
+                watches.push_back(watchInfo);
+            }
+            continue;
+        }
+
+        for (auto const &entity : entities)
+        {
+            dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(entity.entityGroupId, entity.entityId, fieldId, 0);
+            if (watchInfo != nullptr && watchInfo->isWatched)
+            {
+                watches.push_back(watchInfo);
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ManageDeviceEvents(unsigned int /* addWatchOnGpuId */,
+                                                  unsigned short /* addWatchOnFieldId */)
+{
+    unsigned long long desiredEvents[DCGM_MAX_NUM_DEVICES] = { 0 };
+    unsigned long long eventsMap                           = nvmlEventTypeXidCriticalError;
+    int somethingChanged;
+    unsigned int gpuId;
+    nvmlReturn_t nvmlReturn;
+    nvmlDevice_t nvmlDevice = 0;
+    dcgmReturn_t ret        = DCGM_ST_OK;
+
+    /* First, walk all GPUs to build a bitmask of which event types we care about */
+    somethingChanged = 0;
+    for (gpuId = 0; gpuId < m_numGpus; gpuId++)
+    {
+        if (m_gpus[gpuId].status == DcgmEntityStatusDetached)
+            continue;
+
+            /* We always subscribe for XIDs so that we have SOMETHING watched. Otherwise,
+           the event thread won't start */
+#if 1
+        if (m_gpus[gpuId].arch >= DCGM_CHIP_ARCH_AMPERE && m_driverIsR450OrNewer && IsGpuMigEnabled(gpuId))
+        {
+            desiredEvents[gpuId] |= eventsMap | nvmlEventMigConfigChange;
+        }
+        else
+        {
+            desiredEvents[gpuId] |= eventsMap;
+        }
+
+        if (m_eventDrivenMemoryErrors)
+        {
+            desiredEvents[gpuId] |= c_memoryErrorEventMask;
+        }
+
+#else
         watchInfo = GetEntityWatchInfo(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS);
         if (watchInfo->isWatched || ((gpuId == addWatchOnGpuId) && (addWatchOnFieldId == watchInfo->fieldId)))
         {
@@ -2592,12 +3183,36 @@ dcgmReturn_t DcgmCacheManager::ManageDeviceEvents(unsigned int /* addWatchOnGpuI
                 return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
             }
 
-            nvmlReturn = nvmlDeviceRegisterEvents(nvmlDevice, desiredEvents[gpuId], m_nvmlEventSet);
+            nvmlEventSet_t eventSet {};
+            ret = GetEventSetForGpu(gpuId, eventSet);
+            if (ret != DCGM_ST_OK)
+            {
+                return ret;
+            }
+
+            /* Only ask for the memory error events this GPU can raise. m_currentEventMask keeps the full mask so that
+               the GPU isn't registered again on every call */
+            unsigned long long registerEvents = desiredEvents[gpuId];
+            if (registerEvents & c_memoryErrorEventMask)
+            {
+                unsigned long long supportedEvents = 0;
+                if (nvmlDeviceGetSupportedEventTypes(nvmlDevice, &supportedEvents) != NVML_SUCCESS)
+                {
+                    supportedEvents = 0;
+                }
+                registerEvents &= ~c_memoryErrorEventMask | supportedEvents;
+            }
+
+            /* ECC counters can only be left unread if both kinds of ECC errors raise an event */
+            unsigned long long const eccEvents = nvmlEventTypeSingleBitEccError | nvmlEventTypeDoubleBitEccError;
+            m_memoryErrorEventsRegistered[gpuId] = false;
+
+            nvmlReturn = nvmlDeviceRegisterEvents(nvmlDevice, registerEvents, eventSet);
             if (nvmlReturn == NVML_ERROR_NOT_SUPPORTED)
             {
                 log_warning("ManageDeviceEvents: Desired events are not supported for gpuId: {}. Events mask: {}",
                             (int)gpuId,
-                            desiredEvents[gpuId]);
+                            registerEvents);
                 continue;
             }
             else if (nvmlReturn != NVML_SUCCESS)
@@ -2608,9 +3223,10 @@ dcgmReturn_t DcgmCacheManager::ManageDeviceEvents(unsigned int /* addWatchOnGpuI
                 return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
             }
 
-            log_debug("Set nvmlIndex {} event mask to x{}", gpuId, desiredEvents[gpuId]);
+            log_debug("Set nvmlIndex {} event mask to x{}", gpuId, registerEvents);
 
-            m_currentEventMask[gpuId] = desiredEvents[gpuId];
+            m_currentEventMask[gpuId]            = desiredEvents[gpuId];
+            m_memoryErrorEventsRegistered[gpuId] = (registerEvents & eccEvents) == eccEvents;
         }
     }
 
@@ -2689,12 +3305,15 @@ void DcgmCacheManager::ReadAndCacheDriverVersions(void)
         m_driverIsR520OrNewer = false;
     }
 
+    /* The driver version decides which fields can be batched */
+    m_watchSetGeneration++;
+
     DCGM_LOG_INFO << "Parsed driver string is " << m_driverVersion << ", IsR450OrNewer: " << m_driverIsR450OrNewer
                   << ", IsR520OrNewer: " << m_driverIsR520OrNewer;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId)
+dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId, bool *deferredDeviceEvents)
 {
     if (m_nvmlLoaded == false)
     {
@@ -2723,18 +3342,20 @@ dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short d
             log_debug("Skipping NvmlPreWatch for fieldId {}, fake gpuId {}", dcgmFieldId, gpuId);
             return DCGM_ST_OK;
         }
-
-        nvmlReturn = nvmlDeviceGetHandleByIndex_v2(m_gpus[gpuId].nvmlIndex, &nvmlDevice);
-        if (nvmlReturn != NVML_SUCCESS)
-        {
-            log_error("NvmlPreWatch: nvmlDeviceGetHandleByIndex_v2 returned {} for gpuId {}", (int)nvmlReturn, gpuId);
-            return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-        }
     }
 
     switch (dcgmFieldId)
     {
         case DCGM_FI_DEV_ACCOUNTING_DATA:
+            /* Only look up the handle for the fields that need it. Most watches don't */
+            nvmlReturn = nvmlDeviceGetHandleByIndex_v2(m_gpus[gpuId].nvmlIndex, &nvmlDevice);
+            if (nvmlReturn != NVML_SUCCESS)
+            {
+                log_error(
+                    "NvmlPreWatch: nvmlDeviceGetHandleByIndex_v2 returned {} for gpuId {}", (int)nvmlReturn, gpuId);
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
             nvmlReturn = nvmlDeviceGetAccountingMode(nvmlDevice, &enabledState);
             if (nvmlReturn == NVML_ERROR_NOT_SUPPORTED)
             {
@@ -2775,7 +3396,14 @@ dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short d
 
         case DCGM_FI_DEV_XID_ERRORS:
         case DCGM_FI_DEV_GPU_NVLINK_ERRORS:
-            ManageDeviceEvents(gpuId, dcgmFieldId);
+            if (deferredDeviceEvents)
+            {
+                *deferredDeviceEvents = true;
+            }
+            else
+            {
+                ManageDeviceEvents(gpuId, dcgmFieldId);
+            }
             break;
 
         default:
@@ -2787,7 +3415,9 @@ dcgmReturn_t DcgmCacheManager::NvmlPreWatch(unsigned int gpuId, unsigned short d
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::NvmlPostWatch(unsigned int /* gpuId */, unsigned short dcgmFieldId)
+dcgmReturn_t DcgmCacheManager::NvmlPostWatch(unsigned int /* gpuId */,
+                                             unsigned short dcgmFieldId,
+                                             bool *deferredDeviceEvents)
 {
     if (m_nvmlLoaded == false)
     {
@@ -2798,7 +3428,14 @@ dcgmReturn_t DcgmCacheManager::NvmlPostWatch(unsigned int /* gpuId */, unsigned
     {
         case DCGM_FI_DEV_XID_ERRORS:
         case DCGM_FI_DEV_GPU_NVLINK_ERRORS:
-            ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
+            if (deferredDeviceEvents)
+            {
+                *deferredDeviceEvents = true;
+            }
+            else
+            {
+                ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
+            }
             break;
 
         default:
@@ -2905,6 +3542,7 @@ dcgmReturn_t DcgmCacheManager::UpdateFieldWatch(dcgmcm_watch_info_p watchInfo,
     }
 
     watchInfo->monitorIntervalUsec = monitorIntervalUsec;
+    m_watchSetGeneration++;
 
     watchInfo->maxAgeUsec = ToLegacyTimestamp(GetMaxAge(
         FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxAgeSec)), maxKeepSamples));
@@ -2937,392 +3575,709 @@ dcgmReturn_t DcgmCacheManager::RemoveFieldWatch(dcgm_field_entity_group_t entity
 }
 
 
-/*************************************************************************/
-dcgmReturn_t DcgmCacheManager::RemoveWatcher(dcgmcm_watch_info_p watchInfo, dcgm_watch_watcher_info_t *watcher)
+/*****************************************************************************/
+/*
+ * Helper for AddFieldWatches() and RemoveFieldWatches(). Every field of a DCGM_FE_NONE entity is watched
+ * globally, like AddFieldWatch() and RemoveFieldWatch() do for a single pair
+ */
+static void AddGlobalEntityFieldIds(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                    std::vector<unsigned short> const &entityFieldIds,
+                                    std::vector<unsigned short> &globalFieldIds)
 {
-    std::vector<dcgm_watch_watcher_info_t>::iterator it;
+    bool const anyGlobalEntities
+        = std::any_of(entities.begin(), entities.end(), [](dcgmGroupEntityPair_t const &entity) {
+              return entity.entityGroupId == DCGM_FE_NONE;
+          });
+    if (anyGlobalEntities)
+    {
+        globalFieldIds.insert(globalFieldIds.end(), entityFieldIds.begin(), entityFieldIds.end());
+    }
+}
 
-    if (watchInfo == nullptr)
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AddFieldWatches(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                               std::vector<unsigned short> const &fieldIds,
+                                               timelib64_t monitorIntervalUsec,
+                                               double maxSampleAge,
+                                               int maxKeepSamples,
+                                               DcgmWatcher watcher,
+                                               bool subscribeForUpdates,
+                                               bool &anyFirstWatcher)
+{
+    dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+    std::vector<unsigned short> entityFieldIds;
+    std::vector<unsigned short> globalFieldIds;
+    bool anyProfFields = false;
+
+    anyFirstWatcher = false;
+
+    if (entities.empty() || fieldIds.empty())
     {
-        DCGM_LOG_ERROR << "RemoveWatcher got watchInfo == null";
-        return DCGM_ST_BADPARAM;
+        return DCGM_ST_OK;
     }
 
-    for (it = watchInfo->watchers.begin(); it != watchInfo->watchers.end(); ++it)
+    if (!m_nvmlLoaded)
     {
-        if ((*it).watcher == watcher->watcher)
+        for (auto const &entity : entities)
         {
-            log_debug("RemoveWatcher removing existing watcher type {}, connectionId {}",
-                      watcher->watcher.watcherType,
-                      watcher->watcher.connectionId);
-
-            watchInfo->watchers.erase(it);
-            /* Update the watchInfo frequency and quota now that we removed a watcher */
-            UpdateWatchFromWatchers(watchInfo);
-
-            /* Last watcher? */
-            if (watchInfo->watchers.size() < 1)
+            switch (entity.entityGroupId)
             {
-                watchInfo->isWatched = 0;
-
-                if (m_nvmlLoaded == true)
-                {
-                    if (watchInfo->watchKey.entityGroupId == DCGM_FE_GPU)
-                    {
-                        NvmlPostWatch(GpuIdToNvmlIndex(watchInfo->watchKey.entityId), watchInfo->watchKey.fieldId);
-                    }
-                    else if (watchInfo->watchKey.entityGroupId == DCGM_FE_NONE)
-                    {
-                        NvmlPostWatch(-1, watchInfo->watchKey.fieldId);
-                    }
-                }
+                case DCGM_FE_GPU:    // Fall through
+                case DCGM_FE_VGPU:   // Fall through
+                case DCGM_FE_GPU_I:  // Fall through
+                case DCGM_FE_GPU_CI: // Fall through
+                case DCGM_FE_LINK:   // Fall through
+                    log_debug("Cannot watch requested fields because NVML is not loaded.");
+                    return DCGM_ST_NVML_NOT_LOADED;
+                default:
+                    // NO-OP
+                    break;
             }
+        }
+    }
 
-            return DCGM_ST_OK;
+    for (unsigned short fieldId : fieldIds)
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (!fieldMeta)
+            return DCGM_ST_UNKNOWN_FIELD;
+        if (fieldId >= DCGM_FI_MAX_FIELDS)
+            return DCGM_ST_BADPARAM;
+
+        /* A global field has a single watch no matter how many entities asked for it */
+        if (fieldMeta->scope == DCGM_FS_GLOBAL)
+        {
+            globalFieldIds.push_back(fieldId);
+        }
+        else
+        {
+            entityFieldIds.push_back(fieldId);
+            anyProfFields = anyProfFields || DCGM_FIELD_ID_IS_PROF_FIELD(fieldId);
         }
     }
 
-    log_debug("RemoveWatcher() type {}, connectionId {} was not a watcher",
-              watcher->watcher.watcherType,
-              watcher->watcher.connectionId);
-    return DCGM_ST_NOT_WATCHED;
-}
+    AddGlobalEntityFieldIds(entities, entityFieldIds, globalFieldIds);
 
-/*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AddOrUpdateWatcher(dcgmcm_watch_info_p watchInfo,
-                                                  bool *wasAdded,
-                                                  dcgm_watch_watcher_info_t *newWatcher)
-{
-    if (watchInfo == nullptr)
+    /* Trigger the update loop to buffer updates from now on */
+    if (subscribeForUpdates)
+        m_haveAnyLiveSubscribers = true;
+
+    std::vector<dcgm_watch_watcher_info_t> newWatchers;
+    newWatchers.reserve(entityFieldIds.size());
+    for (unsigned short fieldId : entityFieldIds)
     {
-        DCGM_LOG_ERROR << "AddOrUpdateWatcher got watchInfo == null";
-        return DCGM_ST_BADPARAM;
+        newWatchers.push_back(
+            MakeWatcherInfo(fieldId, monitorIntervalUsec, maxSampleAge, maxKeepSamples, watcher, subscribeForUpdates));
     }
 
-    for (auto it = watchInfo->watchers.begin(); it != watchInfo->watchers.end(); ++it)
+    /* GPM support only depends on the entity, so check it once per entity rather than once per watch */
+    std::vector<bool> entitySupportsGpm(entities.size(), false);
+    if (anyProfFields)
     {
-        if ((*it).watcher == newWatcher->watcher)
+        for (size_t i = 0; i < entities.size(); i++)
         {
-            log_debug("Updating existing watcher type {}, connectionId {}",
-                      newWatcher->watcher.watcherType,
-                      newWatcher->watcher.connectionId);
-
-            *it       = *newWatcher;
-            *wasAdded = false;
-            /* Update the watchInfo frequency and quota now that we updated a watcher */
-            UpdateWatchFromWatchers(watchInfo);
-            return DCGM_ST_OK;
+            entitySupportsGpm[i] = EntityPairSupportsGpm(entities[i]);
         }
     }
 
-    log_debug("Adding new watcher type {}, connectionId {}",
-              newWatcher->watcher.watcherType,
-              newWatcher->watcher.connectionId);
+    {
+        /* Scoped lock. One pass for every watch so the update thread isn't interleaved with each one */
+        DcgmLockGuard dlg(m_mutex);
+        bool deferredDeviceEvents = false;
 
-    watchInfo->watchers.push_back(*newWatcher);
-    *wasAdded = true;
+        for (size_t i = 0; i < entities.size() * entityFieldIds.size() && dcgmReturn == DCGM_ST_OK; i++)
+        {
+            size_t const entityIndex = i / entityFieldIds.size();
+            size_t const fieldIndex  = i % entityFieldIds.size();
+            if (entities[entityIndex].entityGroupId == DCGM_FE_NONE)
+            {
+                continue;
+            }
 
-    /* Update the watchInfo frequency and quota now that we added a watcher */
-    UpdateWatchFromWatchers(watchInfo);
+            dcgm_entity_key_t entityKey;
+            entityKey.entityGroupId = entities[entityIndex].entityGroupId;
+            entityKey.entityId      = entities[entityIndex].entityId;
+            entityKey.fieldId       = entityFieldIds[fieldIndex];
 
-    return DCGM_ST_OK;
-}
+            bool const entityKeySupportsGpm
+                = entitySupportsGpm[entityIndex] && DCGM_FIELD_ID_IS_PROF_FIELD(entityKey.fieldId);
+            bool wereFirstWatcher = false;
 
-/*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::UpdateWatchFromWatchers(dcgmcm_watch_info_p watchInfo)
-{
-    if (watchInfo == nullptr)
-    {
-        DCGM_LOG_ERROR << "UpdateWatchFromWatchers got watchInfo == null";
-        return DCGM_ST_BADPARAM;
-    }
+            dcgmReturn = AddEntityFieldWatchLocked(entityKey,
+                                                   newWatchers[fieldIndex],
+                                                   entityKeySupportsGpm,
+                                                   maxSampleAge,
+                                                   maxKeepSamples,
+                                                   &deferredDeviceEvents,
+                                                   wereFirstWatcher);
+            anyFirstWatcher = anyFirstWatcher || wereFirstWatcher;
+        }
 
-    if (watchInfo->watchers.empty())
+        /* Rebuild the NVML event set once for all of the new watches */
+        if (deferredDeviceEvents)
+        {
+            ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
+        }
+    } /* End scoped lock */
+
+    if (dcgmReturn != DCGM_ST_OK)
     {
-        watchInfo->hasSubscribedWatchers = 0;
-        return DCGM_ST_NOT_WATCHED;
+        return dcgmReturn;
     }
 
-    auto it = watchInfo->watchers.begin();
+    /* After the cache manager has the watches. See AddEntityFieldWatch() */
+    for (auto const &entity : entities)
+    {
+        if (entity.entityGroupId != DCGM_FE_SWITCH && entity.entityGroupId != DCGM_FE_LINK)
+        {
+            continue;
+        }
 
-    /* Don't update watchInfo's value here because we don't want non-locking readers to them in a temporary state */
-    timelib64_t minMonitorFreqUsec = it->monitorIntervalUsec;
-    timelib64_t minMaxAgeUsec      = it->maxAgeUsec;
-    bool hasSubscribedWatchers     = it->isSubscribed;
+        for (size_t j = 0; j < entityFieldIds.size(); j++)
+        {
+            dcgmReturn_t retSt = helperNvSwitchAddFieldWatch(
+                entity.entityGroupId, entity.entityId, entityFieldIds[j], newWatchers[j].monitorIntervalUsec, watcher);
+            if (retSt != DCGM_ST_OK)
+            {
+                DCGM_LOG_ERROR << "Got status " << errorString(retSt) << "(" << retSt << ")"
+                               << " when trying to set watches";
+            }
+        }
+    }
 
-    for (++it; it != watchInfo->watchers.end(); ++it)
+    for (unsigned short fieldId : globalFieldIds)
     {
-        minMonitorFreqUsec = std::min(minMonitorFreqUsec, it->monitorIntervalUsec);
-        minMaxAgeUsec      = std::min(minMaxAgeUsec, it->maxAgeUsec);
-        if (it->isSubscribed)
-            hasSubscribedWatchers = 1;
+        bool wereFirstWatcher = false;
+
+        dcgmReturn = AddGlobalFieldWatch(fieldId,
+                                         monitorIntervalUsec,
+                                         maxSampleAge,
+                                         maxKeepSamples,
+                                         watcher,
+                                         subscribeForUpdates,
+                                         false,
+                                         wereFirstWatcher);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+        anyFirstWatcher = anyFirstWatcher || wereFirstWatcher;
     }
 
-    watchInfo->monitorIntervalUsec   = minMonitorFreqUsec;
-    watchInfo->maxAgeUsec            = minMaxAgeUsec;
-    watchInfo->hasSubscribedWatchers = hasSubscribedWatchers;
+    log_debug("AddFieldWatches {} entities x {} fields, mfu {}, msa {}, mka {}, sfu {}",
+              entities.size(),
+              fieldIds.size(),
+              (long long)monitorIntervalUsec,
+              maxSampleAge,
+              maxKeepSamples,
+              subscribeForUpdates ? 1 : 0);
 
-    log_debug("UpdateWatchFromWatchers minMonitorFreqUsec {}, minMaxAgeUsec {}, hsw {}",
-              (long long)minMonitorFreqUsec,
-              (long long)minMaxAgeUsec,
-              watchInfo->hasSubscribedWatchers);
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t entityGroupId,
-                                                   unsigned int entityId,
-                                                   unsigned short dcgmFieldId,
-                                                   timelib64_t monitorIntervalUsec,
-                                                   double maxSampleAge,
-                                                   int maxKeepSamples,
-                                                   DcgmWatcher watcher,
-                                                   bool subscribeForUpdates,
-                                                   bool updateOnFirstWatch,
-                                                   bool &wereFirstWatcher)
+dcgmReturn_t DcgmCacheManager::RemoveFieldWatches(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                                  std::vector<unsigned short> const &fieldIds,
+                                                  int clearCache,
+                                                  DcgmWatcher watcher)
 {
-    dcgmcm_watch_info_p watchInfo;
-    dcgmReturn_t dcgmReturn = DCGM_ST_OK;
-    bool wasAdded           = false;
-    dcgm_watch_watcher_info_t newWatcher;
+    dcgmReturn_t retSt = DCGM_ST_OK;
+    std::vector<unsigned short> entityFieldIds;
+    std::vector<unsigned short> globalFieldIds;
+    dcgm_watch_watcher_info_t remWatcher;
+    bool anyProfFields = false;
 
-    if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
-        return DCGM_ST_BADPARAM;
-    else if (dcgmFieldId == DCGM_FI_DEV_INFOROM_CONFIG_CHECK || dcgmFieldId == DCGM_FI_DEV_INFOROM_CONFIG_VALID)
+    if (entities.empty() || fieldIds.empty())
     {
-        /* For inforom checks, enforce a 30-second minumum to avoid excessive CPU cycles */
-        const timelib64_t minMonitorFrequenceUsec = 30000000;
-        if (monitorIntervalUsec < minMonitorFrequenceUsec)
+        return DCGM_ST_OK;
+    }
+
+    for (unsigned short fieldId : fieldIds)
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (!fieldMeta || fieldId >= DCGM_FI_MAX_FIELDS)
         {
-            DCGM_LOG_DEBUG << "Adjusted logging for eg " << entityGroupId << " eid " << entityId << " fieldId "
-                           << dcgmFieldId << " from " << monitorIntervalUsec << " to " << minMonitorFrequenceUsec;
-            monitorIntervalUsec = minMonitorFrequenceUsec;
+            log_error("RemoveFieldWatches got unknown fieldId {}", fieldId);
+            retSt = DCGM_ST_UNKNOWN_FIELD;
+            /* Keep going so we don't leave watches active */
+            continue;
+        }
+
+        if (fieldMeta->scope == DCGM_FS_GLOBAL)
+        {
+            globalFieldIds.push_back(fieldId);
+        }
+        else
+        {
+            entityFieldIds.push_back(fieldId);
+            anyProfFields = anyProfFields || DCGM_FIELD_ID_IS_PROF_FIELD(fieldId);
         }
     }
 
-    dcgm_field_entity_group_t watchEntityGroupId = entityGroupId;
-    unsigned int watchEntityId                   = entityId;
+    AddGlobalEntityFieldIds(entities, entityFieldIds, globalFieldIds);
 
-    /* Populate the cache manager version of watcher so we can insert/update it in this watchInfo's
-       watcher table */
-    newWatcher.watcher             = watcher;
-    newWatcher.monitorIntervalUsec = monitorIntervalUsec;
+    /* The NvSwitch module tracks watches per watcher, so one call covers every switch watch */
+    bool const anySwitches = std::any_of(entities.begin(), entities.end(), [](dcgmGroupEntityPair_t const &entity) {
+        return entity.entityGroupId == DCGM_FE_SWITCH;
+    });
+    if (anySwitches && !entityFieldIds.empty())
+    {
+        dcgmReturn_t dcgmReturn = helperNvSwitchRemoveFieldWatch(watcher);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Got status " << errorString(dcgmReturn) << "(" << dcgmReturn << ")"
+                           << " when trying to unset watches";
+            retSt = dcgmReturn;
+        }
+    }
 
-    using DcgmNs::Timelib::FromLegacyTimestamp;
-    using DcgmNs::Timelib::ToLegacyTimestamp;
-    using DcgmNs::Utils::GetMaxAge;
-    using namespace std::chrono;
+    std::vector<bool> entitySupportsGpm(entities.size(), false);
+    if (anyProfFields)
+    {
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            entitySupportsGpm[i] = EntityPairSupportsGpm(entities[i]);
+        }
+    }
 
-    newWatcher.maxAgeUsec   = ToLegacyTimestamp(GetMaxAge(
-        FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxSampleAge)), maxKeepSamples));
-    newWatcher.isSubscribed = subscribeForUpdates ? 1 : 0;
+    remWatcher.watcher = watcher;
 
     {
-        dcgm_entity_key_t entityKey;
-        entityKey.entityGroupId   = entityGroupId;
-        entityKey.entityId        = entityId;
-        entityKey.fieldId         = dcgmFieldId;
-        bool entityKeySupportsGpm = EntityKeySupportsGpm(entityKey);
-
         /* Scoped lock */
         DcgmLockGuard dlg(m_mutex);
+        bool deferredDeviceEvents = false;
 
-        watchInfo = GetEntityWatchInfo(watchEntityGroupId, watchEntityId, dcgmFieldId, 1);
-        if (watchInfo == nullptr)
-        {
-            DCGM_LOG_ERROR << "Got watchInfo == null from the GetEntityWatchInfo";
-            return DCGM_ST_GENERIC_ERROR;
-        }
-
-        /* New watch? */
-        if (!watchInfo->isWatched && watchEntityGroupId == DCGM_FE_GPU)
+        for (size_t i = 0; i < entities.size(); i++)
         {
-            watchInfo->lastQueriedUsec = 0;
-
-            /* Do the pre-watch first in case it fails */
-            dcgmReturn = NvmlPreWatch(GpuIdToNvmlIndex(watchEntityId), dcgmFieldId);
-            if (dcgmReturn != DCGM_ST_OK)
+            if (entities[i].entityGroupId == DCGM_FE_NONE)
             {
-                log_error(
-                    "NvmlPreWatch eg {}, eid {}, failed with {}", watchEntityGroupId, watchEntityId, (int)dcgmReturn);
-                return dcgmReturn;
+                continue;
             }
-        }
 
-        /* Add or update the watcher in our table */
-        AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
+            for (unsigned short fieldId : entityFieldIds)
+            {
+                dcgm_entity_key_t entityKey;
+                entityKey.entityGroupId = entities[i].entityGroupId;
+                entityKey.entityId      = entities[i].entityId;
+                entityKey.fieldId       = fieldId;
 
-        watchInfo->isWatched      = 1;
-        watchInfo->pushedByModule = false;
+                dcgmReturn_t dcgmReturn = RemoveEntityFieldWatchLocked(entityKey,
+                                                                       remWatcher,
+                                                                       entitySupportsGpm[i]
+                                                                           && DCGM_FIELD_ID_IS_PROF_FIELD(fieldId),
+                                                                       &deferredDeviceEvents);
+                if (dcgmReturn != DCGM_ST_OK)
+                {
+                    retSt = dcgmReturn;
+                    /* Keep going so we don't leave watches active */
+                }
+            }
+        }
 
-        if (entityKeySupportsGpm)
+        for (unsigned short fieldId : globalFieldIds)
         {
-            timelib64_t maxSampleAgeUsec = std::uint64_t(maxSampleAge) * 1000000;
-            dcgmReturn
-                = m_gpmManager.AddWatcher(entityKey, watcher, monitorIntervalUsec, maxSampleAgeUsec, maxKeepSamples);
-            if (dcgmReturn != DCGM_ST_OK)
+            dcgmcm_watch_info_p watchInfo = GetGlobalWatchInfo(fieldId, 0);
+            if (watchInfo)
             {
-                DCGM_LOG_ERROR << "Unexpected return " << dcgmReturn << " from m_gpmManager->AddWatcher()";
+                RemoveWatcher(watchInfo, &remWatcher, &deferredDeviceEvents);
             }
         }
-        else if (IsModulePushedFieldId(watchInfo->watchKey.fieldId))
-        {
-            /* If this isn't a supported GPM field and the field is a module-pushed field, mark it so */
-            DCGM_LOG_DEBUG << "Setting eg " << watchEntityGroupId << ", eid " << watchEntityId << ", fieldId "
-                           << dcgmFieldId << " as module-pushed";
-            watchInfo->pushedByModule = true;
-        }
 
-        wereFirstWatcher = false;
-        if (watchInfo->lastQueriedUsec == 0)
+        /* Rebuild the NVML event set once for all of the removed watches */
+        if (deferredDeviceEvents)
         {
-            wereFirstWatcher = true;
+            ManageDeviceEvents(DCGM_GPU_ID_BAD, 0);
         }
-
     } /* End scoped lock */
 
-    /* The NVSwitch/NVLink watch needs to be added after the cache manager adds the watch on its side to avoid the
-       race condition, that is, if NVSwitch module knows about the watch first, it might call CacheManager before
-       the watch has been added on the CacheManager side. */
-    if ((entityGroupId == DCGM_FE_SWITCH) || (entityGroupId == DCGM_FE_LINK))
+    log_debug(
+        "RemoveFieldWatches {} entities x {} fields, clearCache {}", entities.size(), fieldIds.size(), clearCache);
+
+    return retSt;
+}
+
+/*************************************************************************/
+dcgmReturn_t DcgmCacheManager::RemoveWatcher(dcgmcm_watch_info_p watchInfo,
+                                             dcgm_watch_watcher_info_t *watcher,
+                                             bool *deferredDeviceEvents)
+{
+    std::vector<dcgm_watch_watcher_info_t>::iterator it;
+
+    if (watchInfo == nullptr)
     {
-        dcgmReturn_t retSt
-            = helperNvSwitchAddFieldWatch(entityGroupId, entityId, dcgmFieldId, monitorIntervalUsec, watcher);
+        DCGM_LOG_ERROR << "RemoveWatcher got watchInfo == null";
+        return DCGM_ST_BADPARAM;
+    }
 
-        if (retSt != DCGM_ST_OK)
+    for (it = watchInfo->watchers.begin(); it != watchInfo->watchers.end(); ++it)
+    {
+        if ((*it).watcher == watcher->watcher)
         {
-            DCGM_LOG_ERROR << "Got status " << errorString(retSt) << "(" << retSt << ")"
-                           << " when trying to set watches";
+            log_debug("RemoveWatcher removing existing watcher type {}, connectionId {}",
+                      watcher->watcher.watcherType,
+                      watcher->watcher.connectionId);
+
+            UntrackConnectionWatch(watchInfo, it->watcher);
+            watchInfo->watchers.erase(it);
+            /* Update the watchInfo frequency and quota now that we removed a watcher */
+            UpdateWatchFromWatchers(watchInfo);
+
+            /* Last watcher? */
+            if (watchInfo->watchers.size() < 1)
+            {
+                watchInfo->isWatched = 0;
+                m_watchSetGeneration++;
+
+                if (m_nvmlLoaded == true)
+                {
+                    if (watchInfo->watchKey.entityGroupId == DCGM_FE_GPU)
+                    {
+                        NvmlPostWatch(GpuIdToNvmlIndex(watchInfo->watchKey.entityId),
+                                      watchInfo->watchKey.fieldId,
+                                      deferredDeviceEvents);
+                    }
+                    else if (watchInfo->watchKey.entityGroupId == DCGM_FE_NONE)
+                    {
+                        NvmlPostWatch(-1, watchInfo->watchKey.fieldId, deferredDeviceEvents);
+                    }
+                }
+            }
+
+            SyncDerivedFieldInputs(watchInfo, deferredDeviceEvents);
+            return DCGM_ST_OK;
         }
     }
 
-    /* If our field has never been queried. Force an update to get the cache to start updating. Otherwise,
-       this field may not update until the cache manager thread times out in 10 seconds */
-    if (wereFirstWatcher && updateOnFirstWatch)
+    log_debug("RemoveWatcher() type {}, connectionId {} was not a watcher",
+              watcher->watcher.watcherType,
+              watcher->watcher.connectionId);
+    return DCGM_ST_NOT_WATCHED;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AddOrUpdateWatcher(dcgmcm_watch_info_p watchInfo,
+                                                  bool *wasAdded,
+                                                  dcgm_watch_watcher_info_t *newWatcher)
+{
+    if (watchInfo == nullptr)
     {
-        UpdateAllFields(1);
+        DCGM_LOG_ERROR << "AddOrUpdateWatcher got watchInfo == null";
+        return DCGM_ST_BADPARAM;
+    }
+
+    for (auto it = watchInfo->watchers.begin(); it != watchInfo->watchers.end(); ++it)
+    {
+        if ((*it).watcher == newWatcher->watcher)
+        {
+            log_debug("Updating existing watcher type {}, connectionId {}",
+                      newWatcher->watcher.watcherType,
+                      newWatcher->watcher.connectionId);
+
+            *it       = *newWatcher;
+            *wasAdded = false;
+            /* Update the watchInfo frequency and quota now that we updated a watcher */
+            UpdateWatchFromWatchers(watchInfo);
+            return DCGM_ST_OK;
+        }
     }
 
-    DCGM_LOG_DEBUG << "AddFieldWatch eg " << watchEntityGroupId << ", eid " << watchEntityId << ", fieldId "
-                   << dcgmFieldId << ", mfu " << (long long int)monitorIntervalUsec << ", msa " << maxSampleAge
-                   << ", mka " << maxKeepSamples << ", sfu " << subscribeForUpdates;
+    log_debug("Adding new watcher type {}, connectionId {}",
+              newWatcher->watcher.watcherType,
+              newWatcher->watcher.connectionId);
+
+    watchInfo->watchers.push_back(*newWatcher);
+    TrackConnectionWatch(watchInfo, newWatcher->watcher);
+    *wasAdded = true;
 
-    return dcgmReturn;
+    /* Update the watchInfo frequency and quota now that we added a watcher */
+    UpdateWatchFromWatchers(watchInfo);
+
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-bool DcgmCacheManager::EntityPairSupportsGpm(dcgmGroupEntityPair_t const &entityPair)
+void DcgmCacheManager::TrackConnectionWatch(dcgmcm_watch_info_p watchInfo, DcgmWatcher const &watcher)
 {
-    if (!m_nvmlLoaded)
+    if (watcher.watcherType == DcgmWatcherTypeClient)
     {
-        log_debug("GPM cannot be used: NVML is not loaded");
-        return false;
+        m_connectionWatches[watcher.connectionId].insert(watchInfo);
     }
+}
 
-    switch (entityPair.entityGroupId)
+/*****************************************************************************/
+void DcgmCacheManager::UntrackConnectionWatch(dcgmcm_watch_info_p watchInfo, DcgmWatcher const &watcher)
+{
+    if (watcher.watcherType != DcgmWatcherTypeClient)
     {
-        case DCGM_FE_GPU:
-        case DCGM_FE_GPU_I:
-        case DCGM_FE_GPU_CI:
-            break;
-        default:
-            return false;
+        return;
     }
 
-    unsigned int gpuId = m_numGpus; // Initialize to an invalid value for check below
-    dcgmReturn_t ret   = GetGpuId(entityPair.entityGroupId, entityPair.entityId, gpuId);
-
-    if (ret != DCGM_ST_OK || gpuId >= m_numGpus)
+    auto it = m_connectionWatches.find(watcher.connectionId);
+    if (it == m_connectionWatches.end())
     {
-        log_error(
-            "Could not query eg {} eid {} gpu {}. ret {}", entityPair.entityGroupId, entityPair.entityId, gpuId, ret);
-        return false;
+        return;
     }
 
-    if (m_forceProfMetricsThroughGpm)
+    it->second.erase(watchInfo);
+    if (it->second.empty())
     {
-        return true;
+        m_connectionWatches.erase(it);
     }
-
-    nvmlDevice_t nvmlDevice = m_gpus[gpuId].nvmlDevice;
-    return m_gpmManager.DoesNvmlDeviceSupportGpm(nvmlDevice);
 }
+
 /*****************************************************************************/
-bool DcgmCacheManager::EntityKeySupportsGpm(const dcgm_entity_key_t &entityKey)
+/* Returns whichever of two maxAges keeps samples longer. A maxAge of 0 keeps them forever */
+static timelib64_t LongerMaxAgeUsec(timelib64_t maxAgeUsec1, timelib64_t maxAgeUsec2)
 {
-    if (!DCGM_FIELD_ID_IS_PROF_FIELD(entityKey.fieldId))
+    if (maxAgeUsec1 == 0 || maxAgeUsec2 == 0)
     {
-        return false;
+        return 0;
     }
-    return EntityPairSupportsGpm(
-        dcgmGroupEntityPair_t { .entityGroupId = static_cast<dcgm_field_entity_group_t>(entityKey.entityGroupId),
-                                .entityId      = entityKey.entityId });
+    return std::max(maxAgeUsec1, maxAgeUsec2);
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::RemoveEntityFieldWatch(dcgm_field_entity_group_t entityGroupId,
-                                                      unsigned int entityId,
-                                                      unsigned short dcgmFieldId,
-                                                      int clearCache,
-                                                      DcgmWatcher watcher)
+/* Which of NVML's sample buffers holds the samples of fieldId? Returns false if none does */
+static bool GetNvmlSamplingType(unsigned short fieldId, nvmlSamplingType_t &samplingType)
 {
-    dcgmcm_watch_info_p watchInfo;
-    dcgm_watch_watcher_info_t remWatcher;
-    dcgmReturn_t retSt = DCGM_ST_OK;
-
-    if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
-        return DCGM_ST_BADPARAM;
-
-    /* Populate the cache manager version of watcher so we can remove it in this watchInfo's
-       watcher table */
-    remWatcher.watcher = watcher;
-
-    if (entityGroupId == DCGM_FE_SWITCH)
+    switch (fieldId)
     {
-        retSt = helperNvSwitchRemoveFieldWatch(watcher);
-
-        if (retSt != DCGM_ST_OK)
-        {
-            DCGM_LOG_ERROR << "Got status " << errorString(retSt) << "(" << retSt << ")"
-                           << " when trying to unset watches";
+        case DCGM_FI_DEV_POWER_USAGE:
+            samplingType = NVML_TOTAL_POWER_SAMPLES;
+            return true;
+        case DCGM_FI_DEV_GPU_UTIL:
+            samplingType = NVML_GPU_UTILIZATION_SAMPLES;
+            return true;
+        case DCGM_FI_DEV_MEM_COPY_UTIL:
+            samplingType = NVML_MEMORY_UTILIZATION_SAMPLES;
+            return true;
+        case DCGM_FI_DEV_ENC_UTIL:
+            samplingType = NVML_ENC_UTILIZATION_SAMPLES;
+            return true;
+        case DCGM_FI_DEV_DEC_UTIL:
+            samplingType = NVML_DEC_UTILIZATION_SAMPLES;
+            return true;
+        case DCGM_FI_DEV_SM_CLOCK:
+            samplingType = NVML_PROCESSOR_CLK_SAMPLES;
+            return true;
+        case DCGM_FI_DEV_MEM_CLOCK:
+            samplingType = NVML_MEMORY_CLK_SAMPLES;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::UpdateWatchFromWatchers(dcgmcm_watch_info_p watchInfo)
+{
+    if (watchInfo == nullptr)
+    {
+        DCGM_LOG_ERROR << "UpdateWatchFromWatchers got watchInfo == null";
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (watchInfo->watchers.empty())
+    {
+        watchInfo->hasSubscribedWatchers = 0;
+        return DCGM_ST_NOT_WATCHED;
+    }
+
+    auto it = watchInfo->watchers.begin();
+
+    /* Don't update watchInfo's value here because we don't want non-locking readers to them in a temporary state */
+    timelib64_t minMonitorFreqUsec = it->monitorIntervalUsec;
+    bool hasSubscribedWatchers     = it->isSubscribed;
+
+    for (++it; it != watchInfo->watchers.end(); ++it)
+    {
+        minMonitorFreqUsec = std::min(minMonitorFreqUsec, it->monitorIntervalUsec);
+        if (it->isSubscribed)
+            hasSubscribedWatchers = 1;
+    }
+
+    /* The field is sampled at the fastest interval, but those samples are only kept as long as the watchers at that
+       interval want them. Slower watchers that want samples for longer get them from a history tier thinned to the
+       fastest of their intervals, so that one of them doesn't make the fast samples stay around for its maxAge */
+    timelib64_t primaryMaxAgeUsec = -1;
+    for (auto const &watcher : watchInfo->watchers)
+    {
+        if (watcher.monitorIntervalUsec == minMonitorFreqUsec)
+        {
+            primaryMaxAgeUsec = primaryMaxAgeUsec < 0 ? watcher.maxAgeUsec
+                                                      : LongerMaxAgeUsec(primaryMaxAgeUsec, watcher.maxAgeUsec);
         }
     }
 
-    dcgm_entity_key_t entityKey;
-    entityKey.entityGroupId   = entityGroupId;
-    entityKey.entityId        = entityId;
-    entityKey.fieldId         = dcgmFieldId;
-    bool entityKeySupportsGpm = EntityKeySupportsGpm(entityKey);
+    timelib64_t historyIntervalUsec = 0;
+    timelib64_t historyMaxAgeUsec   = 0;
+    for (auto const &watcher : watchInfo->watchers)
+    {
+        if (LongerMaxAgeUsec(watcher.maxAgeUsec, primaryMaxAgeUsec) == primaryMaxAgeUsec)
+        {
+            continue; /* The primary tier already keeps its samples long enough */
+        }
 
-    DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+        if (historyIntervalUsec == 0)
+        {
+            historyIntervalUsec = watcher.monitorIntervalUsec;
+            historyMaxAgeUsec   = watcher.maxAgeUsec;
+        }
+        else
+        {
+            historyIntervalUsec = std::min(historyIntervalUsec, watcher.monitorIntervalUsec);
+            historyMaxAgeUsec   = LongerMaxAgeUsec(historyMaxAgeUsec, watcher.maxAgeUsec);
+        }
+    }
 
-    watchInfo = GetEntityWatchInfo(entityGroupId, entityId, dcgmFieldId, 0);
-    if (!watchInfo)
+    /* Fields drained from NVML's sample buffers get every sample the driver took however seldom they're updated */
+    timelib64_t monitorIntervalUsec = minMonitorFreqUsec;
+    nvmlSamplingType_t samplingType;
+    if (m_nvmlSampleBufferUsec > 0 && watchInfo->watchKey.entityGroupId == DCGM_FE_GPU
+        && GetNvmlSamplingType(watchInfo->watchKey.fieldId, samplingType))
     {
-        DCGM_LOG_WARNING << "Got unwatch for unknown eg " << entityGroupId << ", eid " << entityId << ", fieldId "
-                         << dcgmFieldId;
-        return DCGM_ST_NOT_WATCHED;
+        monitorIntervalUsec = std::max(monitorIntervalUsec, m_nvmlSampleBufferUsec);
+    }
+
+    if (watchInfo->monitorIntervalUsec != monitorIntervalUsec)
+    {
+        m_watchSetGeneration++;
     }
 
-    RemoveWatcher(watchInfo, &remWatcher);
+    watchInfo->monitorIntervalUsec   = monitorIntervalUsec;
+    watchInfo->maxAgeUsec            = primaryMaxAgeUsec;
+    watchInfo->hasSubscribedWatchers = hasSubscribedWatchers;
+    watchInfo->historyIntervalUsec   = historyIntervalUsec;
+    watchInfo->historyMaxAgeUsec     = historyMaxAgeUsec;
 
-    if (entityKeySupportsGpm)
+    if (historyIntervalUsec == 0 && watchInfo->historyTimeSeries)
     {
-        retSt = m_gpmManager.RemoveWatcher(entityKey, watcher);
-        if (retSt != DCGM_ST_OK)
+        timeseries_destroy(watchInfo->historyTimeSeries);
+        watchInfo->historyTimeSeries = nullptr;
+    }
+
+    log_debug("UpdateWatchFromWatchers monitorIntervalUsec {}, maxAgeUsec {}, historyIntervalUsec {}, "
+              "historyMaxAgeUsec {}, hsw {}",
+              (long long)monitorIntervalUsec,
+              (long long)primaryMaxAgeUsec,
+              (long long)historyIntervalUsec,
+              (long long)historyMaxAgeUsec,
+              watchInfo->hasSubscribedWatchers);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgm_watch_watcher_info_t DcgmCacheManager::MakeWatcherInfo(unsigned short dcgmFieldId,
+                                                            timelib64_t monitorIntervalUsec,
+                                                            double maxSampleAge,
+                                                            int maxKeepSamples,
+                                                            DcgmWatcher const &watcher,
+                                                            bool subscribeForUpdates)
+{
+    using DcgmNs::Timelib::FromLegacyTimestamp;
+    using DcgmNs::Timelib::ToLegacyTimestamp;
+    using DcgmNs::Utils::GetMaxAge;
+    using namespace std::chrono;
+
+    if (dcgmFieldId == DCGM_FI_DEV_INFOROM_CONFIG_CHECK || dcgmFieldId == DCGM_FI_DEV_INFOROM_CONFIG_VALID)
+    {
+        /* For inforom checks, enforce a 30-second minumum to avoid excessive CPU cycles */
+        const timelib64_t minMonitorFrequenceUsec = 30000000;
+        if (monitorIntervalUsec < minMonitorFrequenceUsec)
         {
-            DCGM_LOG_ERROR << "Unexpected return " << retSt << " from m_gpmManager->RemoveWatcher()";
+            DCGM_LOG_DEBUG << "Adjusted logging for fieldId " << dcgmFieldId << " from " << monitorIntervalUsec
+                           << " to " << minMonitorFrequenceUsec;
+            monitorIntervalUsec = minMonitorFrequenceUsec;
         }
     }
 
-    DCGM_LOG_DEBUG << "RemoveEntityFieldWatch eg " << entityGroupId << ", eid " << entityId << ", fieldId "
-                   << dcgmFieldId << ", clearCache " << clearCache;
+    /* Populate the cache manager version of watcher so we can insert/update it in a watchInfo's
+       watcher table */
+    dcgm_watch_watcher_info_t newWatcher;
+    newWatcher.watcher             = watcher;
+    newWatcher.monitorIntervalUsec = monitorIntervalUsec;
+    newWatcher.maxAgeUsec          = ToLegacyTimestamp(GetMaxAge(
+        FromLegacyTimestamp<milliseconds>(monitorIntervalUsec), seconds(std::uint64_t(maxSampleAge)), maxKeepSamples));
+    newWatcher.isSubscribed        = subscribeForUpdates ? 1 : 0;
+    return newWatcher;
+}
 
-    return retSt;
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AddEntityFieldWatchLocked(dcgm_entity_key_t const &entityKey,
+                                                         dcgm_watch_watcher_info_t &newWatcher,
+                                                         bool entityKeySupportsGpm,
+                                                         double maxSampleAge,
+                                                         int maxKeepSamples,
+                                                         bool *deferredDeviceEvents,
+                                                         bool &wereFirstWatcher)
+{
+    dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+    bool wasAdded           = false;
+
+    auto const watchEntityGroupId = static_cast<dcgm_field_entity_group_t>(entityKey.entityGroupId);
+    unsigned int watchEntityId    = entityKey.entityId;
+    unsigned short dcgmFieldId    = entityKey.fieldId;
+
+    dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(watchEntityGroupId, watchEntityId, dcgmFieldId, 1);
+    if (watchInfo == nullptr)
+    {
+        DCGM_LOG_ERROR << "Got watchInfo == null from the GetEntityWatchInfo";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    /* New watch? */
+    if (!watchInfo->isWatched && watchEntityGroupId == DCGM_FE_GPU)
+    {
+        watchInfo->lastQueriedUsec = 0;
+
+        /* Do the pre-watch first in case it fails */
+        dcgmReturn = NvmlPreWatch(GpuIdToNvmlIndex(watchEntityId), dcgmFieldId, deferredDeviceEvents);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            log_error("NvmlPreWatch eg {}, eid {}, failed with {}", watchEntityGroupId, watchEntityId, (int)dcgmReturn);
+            return dcgmReturn;
+        }
+    }
+
+    /* Add or update the watcher in our table */
+    AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
+
+    watchInfo->isWatched      = 1;
+    watchInfo->pushedByModule = false;
+    m_watchSetGeneration++;
+
+    if (entityKeySupportsGpm)
+    {
+        timelib64_t maxSampleAgeUsec = std::uint64_t(maxSampleAge) * 1000000;
+        dcgmReturn                   = m_gpmManager.AddWatcher(
+            entityKey, newWatcher.watcher, newWatcher.monitorIntervalUsec, maxSampleAgeUsec, maxKeepSamples);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Unexpected return " << dcgmReturn << " from m_gpmManager->AddWatcher()";
+        }
+    }
+    else if (DcgmDerivedFields::GetDef(dcgmFieldId) != nullptr)
+    {
+        /* Derived fields are appended along with their inputs rather than read in the update loop */
+        watchInfo->pushedByModule = true;
+        SyncDerivedFieldInputs(watchInfo, deferredDeviceEvents);
+    }
+    else if (IsModulePushedFieldId(watchInfo->watchKey.fieldId))
+    {
+        /* If this isn't a supported GPM field and the field is a module-pushed field, mark it so */
+        DCGM_LOG_DEBUG << "Setting eg " << watchEntityGroupId << ", eid " << watchEntityId << ", fieldId "
+                       << dcgmFieldId << " as module-pushed";
+        watchInfo->pushedByModule = true;
+    }
+
+    wereFirstWatcher = (watchInfo->lastQueriedUsec == 0);
+    return dcgmReturn;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AddGlobalFieldWatch(unsigned short dcgmFieldId,
+dcgmReturn_t DcgmCacheManager::AddEntityFieldWatch(dcgm_field_entity_group_t entityGroupId,
+                                                   unsigned int entityId,
+                                                   unsigned short dcgmFieldId,
                                                    timelib64_t monitorIntervalUsec,
                                                    double maxSampleAge,
                                                    int maxKeepSamples,
@@ -3331,55 +4286,48 @@ dcgmReturn_t DcgmCacheManager::AddGlobalFieldWatch(unsigned short dcgmFieldId,
                                                    bool updateOnFirstWatch,
                                                    bool &wereFirstWatcher)
 {
-    using namespace DcgmNs::Timelib;
-    using namespace std::chrono;
-    using DcgmNs::Utils::GetMaxAge;
-
-    dcgmcm_watch_info_p watchInfo;
-    bool wasAdded = false;
-    dcgm_watch_watcher_info_t newWatcher;
+    dcgmReturn_t dcgmReturn;
 
     if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
         return DCGM_ST_BADPARAM;
 
-    { /* Scoped lock */
-        DcgmLockGuard dlg(m_mutex);
-
-        watchInfo = GetGlobalWatchInfo(dcgmFieldId, 1);
-        if (watchInfo == nullptr)
-        {
-            DCGM_LOG_ERROR << "Got watchInfo == null from GetGlobalWatchInfo";
-            return DCGM_ST_GENERIC_ERROR;
-        }
+    dcgm_watch_watcher_info_t newWatcher
+        = MakeWatcherInfo(dcgmFieldId, monitorIntervalUsec, maxSampleAge, maxKeepSamples, watcher, subscribeForUpdates);
+    monitorIntervalUsec = newWatcher.monitorIntervalUsec;
 
-        /* Populate the cache manager version of watcher so we can insert/update it in this watchInfo's
-            watcher table */
-        newWatcher.watcher             = watcher;
-        newWatcher.monitorIntervalUsec = monitorIntervalUsec;
+    {
+        dcgm_entity_key_t entityKey;
+        entityKey.entityGroupId   = entityGroupId;
+        entityKey.entityId        = entityId;
+        entityKey.fieldId         = dcgmFieldId;
+        bool entityKeySupportsGpm = EntityKeySupportsGpm(entityKey);
 
-        newWatcher.maxAgeUsec   = ToLegacyTimestamp(GetMaxAge(FromLegacyTimestamp<milliseconds>(monitorIntervalUsec),
-                                                            seconds(std::uint64_t(maxSampleAge)),
-                                                            maxKeepSamples));
-        newWatcher.isSubscribed = subscribeForUpdates;
+        /* Scoped lock */
+        DcgmLockGuard dlg(m_mutex);
 
-        /* New watch? */
-        if (!watchInfo->isWatched)
+        dcgmReturn = AddEntityFieldWatchLocked(
+            entityKey, newWatcher, entityKeySupportsGpm, maxSampleAge, maxKeepSamples, nullptr, wereFirstWatcher);
+        if (dcgmReturn != DCGM_ST_OK)
         {
-            NvmlPreWatch(-1, dcgmFieldId);
+            return dcgmReturn;
         }
 
-        /* Add or update the watcher in our table */
-        AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
+    } /* End scoped lock */
 
-        watchInfo->isWatched = 1;
+    /* The NVSwitch/NVLink watch needs to be added after the cache manager adds the watch on its side to avoid the
+       race condition, that is, if NVSwitch module knows about the watch first, it might call CacheManager before
+       the watch has been added on the CacheManager side. */
+    if ((entityGroupId == DCGM_FE_SWITCH) || (entityGroupId == DCGM_FE_LINK))
+    {
+        dcgmReturn_t retSt
+            = helperNvSwitchAddFieldWatch(entityGroupId, entityId, dcgmFieldId, monitorIntervalUsec, watcher);
 
-        wereFirstWatcher = false;
-        if (watchInfo->lastQueriedUsec == 0)
+        if (retSt != DCGM_ST_OK)
         {
-            wereFirstWatcher = true;
+            DCGM_LOG_ERROR << "Got status " << errorString(retSt) << "(" << retSt << ")"
+                           << " when trying to set watches";
         }
-
-    } /* End scoped lock */
+    }
 
     /* If our field has never been queried. Force an update to get the cache to start updating. Otherwise,
        this field may not update until the cache manager thread times out in 10 seconds */
@@ -3388,57 +4336,307 @@ dcgmReturn_t DcgmCacheManager::AddGlobalFieldWatch(unsigned short dcgmFieldId,
         UpdateAllFields(1);
     }
 
-    log_debug("AddGlobalFieldWatch dcgmFieldId {}, mfu {}, msa {}, mka {}, sfu {}",
-              dcgmFieldId,
-              (long long int)monitorIntervalUsec,
-              maxSampleAge,
-              maxKeepSamples,
-              subscribeForUpdates ? 1 : 0);
+    DCGM_LOG_DEBUG << "AddFieldWatch eg " << entityGroupId << ", eid " << entityId << ", fieldId " << dcgmFieldId
+                   << ", mfu " << (long long int)monitorIntervalUsec << ", msa " << maxSampleAge << ", mka "
+                   << maxKeepSamples << ", sfu " << subscribeForUpdates;
 
-    return DCGM_ST_OK;
+    return dcgmReturn;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::RemoveGlobalFieldWatch(unsigned short dcgmFieldId, int clearCache, DcgmWatcher watcher)
+bool DcgmCacheManager::EntityPairSupportsGpm(dcgmGroupEntityPair_t const &entityPair)
 {
-    dcgmcm_watch_info_p watchInfo;
-    dcgm_watch_watcher_info_t remWatcher;
-
-    if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
-        return DCGM_ST_BADPARAM;
-
-    /* Populate the cache manager version of watcher so we can remove it in this watchInfo's
-       watcher table */
-    remWatcher.watcher = watcher;
+    if (!m_nvmlLoaded)
+    {
+        log_debug("GPM cannot be used: NVML is not loaded");
+        return false;
+    }
 
-    DcgmLockGuard dlg(m_mutex);
+    switch (entityPair.entityGroupId)
+    {
+        case DCGM_FE_GPU:
+        case DCGM_FE_GPU_I:
+        case DCGM_FE_GPU_CI:
+            break;
+        default:
+            return false;
+    }
 
-    watchInfo = GetGlobalWatchInfo(dcgmFieldId, 0);
+    unsigned int gpuId = m_numGpus; // Initialize to an invalid value for check below
+    dcgmReturn_t ret   = GetGpuId(entityPair.entityGroupId, entityPair.entityId, gpuId);
 
-    if (watchInfo)
-        RemoveWatcher(watchInfo, &remWatcher);
+    if (ret != DCGM_ST_OK || gpuId >= m_numGpus)
+    {
+        log_error(
+            "Could not query eg {} eid {} gpu {}. ret {}", entityPair.entityGroupId, entityPair.entityId, gpuId, ret);
+        return false;
+    }
 
-    log_debug("RemoveGlobalFieldWatch dcgmFieldId {}, clearCache {}", dcgmFieldId, clearCache);
+    if (m_forceProfMetricsThroughGpm)
+    {
+        return true;
+    }
 
-    return DCGM_ST_OK;
+    nvmlDevice_t nvmlDevice = m_gpus[gpuId].nvmlDevice;
+    return m_gpmManager.DoesNvmlDeviceSupportGpm(nvmlDevice);
 }
-
 /*****************************************************************************/
-/*
- * Helper to convert a timeseries entry to a sample
- *
- */
-static dcgmReturn_t DcgmcmTimeSeriesEntryToSample(dcgmcm_sample_p sample,
-                                                  timeseries_entry_p entry,
-                                                  timeseries_p timeseries)
+bool DcgmCacheManager::EntityKeySupportsGpm(const dcgm_entity_key_t &entityKey)
 {
-    sample->timestamp = entry->usecSince1970;
-
-
-    switch (timeseries->tsType)
+    if (!DCGM_FIELD_ID_IS_PROF_FIELD(entityKey.fieldId))
     {
-        case TS_TYPE_DOUBLE:
-            sample->val.d  = entry->val.dbl;
+        return false;
+    }
+    return EntityPairSupportsGpm(
+        dcgmGroupEntityPair_t { .entityGroupId = static_cast<dcgm_field_entity_group_t>(entityKey.entityGroupId),
+                                .entityId      = entityKey.entityId });
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::RemoveEntityFieldWatch(dcgm_field_entity_group_t entityGroupId,
+                                                      unsigned int entityId,
+                                                      unsigned short dcgmFieldId,
+                                                      int clearCache,
+                                                      DcgmWatcher watcher)
+{
+    dcgm_watch_watcher_info_t remWatcher;
+    dcgmReturn_t retSt = DCGM_ST_OK;
+
+    if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
+        return DCGM_ST_BADPARAM;
+
+    /* Populate the cache manager version of watcher so we can remove it in this watchInfo's
+       watcher table */
+    remWatcher.watcher = watcher;
+
+    if (entityGroupId == DCGM_FE_SWITCH)
+    {
+        retSt = helperNvSwitchRemoveFieldWatch(watcher);
+
+        if (retSt != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Got status " << errorString(retSt) << "(" << retSt << ")"
+                           << " when trying to unset watches";
+        }
+    }
+
+    dcgm_entity_key_t entityKey;
+    entityKey.entityGroupId   = entityGroupId;
+    entityKey.entityId        = entityId;
+    entityKey.fieldId         = dcgmFieldId;
+    bool entityKeySupportsGpm = EntityKeySupportsGpm(entityKey);
+
+    DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+
+    retSt = RemoveEntityFieldWatchLocked(entityKey, remWatcher, entityKeySupportsGpm, nullptr);
+
+    DCGM_LOG_DEBUG << "RemoveEntityFieldWatch eg " << entityGroupId << ", eid " << entityId << ", fieldId "
+                   << dcgmFieldId << ", clearCache " << clearCache;
+
+    return retSt;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::RemoveEntityFieldWatchLocked(dcgm_entity_key_t const &entityKey,
+                                                            dcgm_watch_watcher_info_t &remWatcher,
+                                                            bool entityKeySupportsGpm,
+                                                            bool *deferredDeviceEvents)
+{
+    dcgmReturn_t retSt = DCGM_ST_OK;
+
+    dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(
+        static_cast<dcgm_field_entity_group_t>(entityKey.entityGroupId), entityKey.entityId, entityKey.fieldId, 0);
+    if (!watchInfo)
+    {
+        DCGM_LOG_WARNING << "Got unwatch for unknown eg " << entityKey.entityGroupId << ", eid " << entityKey.entityId
+                         << ", fieldId " << entityKey.fieldId;
+        return DCGM_ST_NOT_WATCHED;
+    }
+
+    RemoveWatcher(watchInfo, &remWatcher, deferredDeviceEvents);
+
+    if (entityKeySupportsGpm)
+    {
+        retSt = m_gpmManager.RemoveWatcher(entityKey, remWatcher.watcher);
+        if (retSt != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Unexpected return " << retSt << " from m_gpmManager->RemoveWatcher()";
+        }
+    }
+
+    return retSt;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::SyncDerivedFieldInputs(dcgmcm_watch_info_p watchInfo, bool *deferredDeviceEvents)
+{
+    DcgmDerivedFieldDef const *def = DcgmDerivedFields::GetDef(watchInfo->watchKey.fieldId);
+    if (def == nullptr)
+    {
+        return;
+    }
+
+    /* Each derived field watches its inputs as its own watcher so that the inputs stay watched as long as one of the
+       derived fields that need them is. The connectionId tells these watchers apart */
+    dcgm_watch_watcher_info_t inputWatcher;
+    inputWatcher.watcher             = DcgmWatcher(DcgmWatcherTypeCacheManager, watchInfo->watchKey.fieldId);
+    inputWatcher.monitorIntervalUsec = watchInfo->monitorIntervalUsec;
+    inputWatcher.maxAgeUsec          = watchInfo->maxAgeUsec;
+    inputWatcher.isSubscribed        = 0;
+
+    if (!watchInfo->isWatched)
+    {
+        /* Don't compute a rate across the time the field was not watched. Durations start over */
+        watchInfo->derivedPrevInputUsec = 0;
+        watchInfo->derivedTotal         = 0.0;
+    }
+
+    for (unsigned short const inputFieldId : def->inputs)
+    {
+        if (inputFieldId == 0)
+        {
+            continue;
+        }
+
+        dcgm_entity_key_t inputKey = watchInfo->watchKey;
+        inputKey.fieldId           = inputFieldId;
+
+        if (watchInfo->isWatched)
+        {
+            bool wereFirstWatcher = false;
+            dcgmReturn_t dcgmReturn = AddEntityFieldWatchLocked(
+                inputKey, inputWatcher, false, 0, 0, deferredDeviceEvents, wereFirstWatcher);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                log_error("Unable to watch input {} of derived fieldId {}: {}",
+                          inputFieldId,
+                          def->fieldId,
+                          errorString(dcgmReturn));
+            }
+        }
+        else
+        {
+            RemoveEntityFieldWatchLocked(inputKey, inputWatcher, false, deferredDeviceEvents);
+        }
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AddGlobalFieldWatch(unsigned short dcgmFieldId,
+                                                   timelib64_t monitorIntervalUsec,
+                                                   double maxSampleAge,
+                                                   int maxKeepSamples,
+                                                   DcgmWatcher watcher,
+                                                   bool subscribeForUpdates,
+                                                   bool updateOnFirstWatch,
+                                                   bool &wereFirstWatcher)
+{
+    using namespace DcgmNs::Timelib;
+    using namespace std::chrono;
+    using DcgmNs::Utils::GetMaxAge;
+
+    dcgmcm_watch_info_p watchInfo;
+    bool wasAdded = false;
+    dcgm_watch_watcher_info_t newWatcher;
+
+    if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
+        return DCGM_ST_BADPARAM;
+
+    { /* Scoped lock */
+        DcgmLockGuard dlg(m_mutex);
+
+        watchInfo = GetGlobalWatchInfo(dcgmFieldId, 1);
+        if (watchInfo == nullptr)
+        {
+            DCGM_LOG_ERROR << "Got watchInfo == null from GetGlobalWatchInfo";
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        /* Populate the cache manager version of watcher so we can insert/update it in this watchInfo's
+            watcher table */
+        newWatcher.watcher             = watcher;
+        newWatcher.monitorIntervalUsec = monitorIntervalUsec;
+
+        newWatcher.maxAgeUsec   = ToLegacyTimestamp(GetMaxAge(FromLegacyTimestamp<milliseconds>(monitorIntervalUsec),
+                                                            seconds(std::uint64_t(maxSampleAge)),
+                                                            maxKeepSamples));
+        newWatcher.isSubscribed = subscribeForUpdates;
+
+        /* New watch? */
+        if (!watchInfo->isWatched)
+        {
+            NvmlPreWatch(-1, dcgmFieldId);
+        }
+
+        /* Add or update the watcher in our table */
+        AddOrUpdateWatcher(watchInfo, &wasAdded, &newWatcher);
+
+        watchInfo->isWatched = 1;
+
+        wereFirstWatcher = false;
+        if (watchInfo->lastQueriedUsec == 0)
+        {
+            wereFirstWatcher = true;
+        }
+
+    } /* End scoped lock */
+
+    /* If our field has never been queried. Force an update to get the cache to start updating. Otherwise,
+       this field may not update until the cache manager thread times out in 10 seconds */
+    if (wereFirstWatcher && updateOnFirstWatch)
+    {
+        UpdateAllFields(1);
+    }
+
+    log_debug("AddGlobalFieldWatch dcgmFieldId {}, mfu {}, msa {}, mka {}, sfu {}",
+              dcgmFieldId,
+              (long long int)monitorIntervalUsec,
+              maxSampleAge,
+              maxKeepSamples,
+              subscribeForUpdates ? 1 : 0);
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::RemoveGlobalFieldWatch(unsigned short dcgmFieldId, int clearCache, DcgmWatcher watcher)
+{
+    dcgmcm_watch_info_p watchInfo;
+    dcgm_watch_watcher_info_t remWatcher;
+
+    if (dcgmFieldId >= DCGM_FI_MAX_FIELDS)
+        return DCGM_ST_BADPARAM;
+
+    /* Populate the cache manager version of watcher so we can remove it in this watchInfo's
+       watcher table */
+    remWatcher.watcher = watcher;
+
+    DcgmLockGuard dlg(m_mutex);
+
+    watchInfo = GetGlobalWatchInfo(dcgmFieldId, 0);
+
+    if (watchInfo)
+        RemoveWatcher(watchInfo, &remWatcher);
+
+    log_debug("RemoveGlobalFieldWatch dcgmFieldId {}, clearCache {}", dcgmFieldId, clearCache);
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+/*
+ * Helper to convert a timeseries entry to a sample
+ *
+ */
+static dcgmReturn_t DcgmcmTimeSeriesEntryToSample(dcgmcm_sample_p sample, timeseries_entry_t const *entry, int tsType)
+{
+    sample->timestamp = entry->usecSince1970;
+
+
+    switch (tsType)
+    {
+        case TS_TYPE_DOUBLE:
+            sample->val.d  = entry->val.dbl;
             sample->val2.d = entry->val2.dbl;
             break;
         case TS_TYPE_INT64:
@@ -3466,7 +4664,7 @@ static dcgmReturn_t DcgmcmTimeSeriesEntryToSample(dcgmcm_sample_p sample,
             break;
 
         default:
-            log_error("Shouldn't get here for type {}", (int)timeseries->tsType);
+            log_error("Shouldn't get here for type {}", tsType);
             return DCGM_ST_BADPARAM;
     }
 
@@ -3477,13 +4675,13 @@ static dcgmReturn_t DcgmcmTimeSeriesEntryToSample(dcgmcm_sample_p sample,
 static dcgmReturn_t DcgmcmWriteTimeSeriesEntryToFvBuffer(dcgm_field_entity_group_t entityGroupId,
                                                          dcgm_field_eid_t entityId,
                                                          unsigned short fieldId,
-                                                         timeseries_entry_p entry,
+                                                         timeseries_entry_t const *entry,
                                                          DcgmFvBuffer *fvBuffer,
-                                                         timeseries_p timeseries)
+                                                         int tsType)
 {
     dcgmBufferedFv_t *fv = 0;
 
-    switch (timeseries->tsType)
+    switch (tsType)
     {
         case TS_TYPE_DOUBLE:
             fv = fvBuffer->AddDoubleValue(
@@ -3508,7 +4706,7 @@ static dcgmReturn_t DcgmcmWriteTimeSeriesEntryToFvBuffer(dcgm_field_entity_group
             break;
 
         default:
-            log_error("Shouldn't get here for type {}", (int)timeseries->tsType);
+            log_error("Shouldn't get here for type {}", tsType);
             return DCGM_ST_BADPARAM;
     }
 
@@ -3575,15 +4773,12 @@ dcgmReturn_t DcgmCacheManager::GetUniquePidLists(dcgm_field_entity_group_t entit
     /* Walk forward  */
     if (startTime)
     {
-        timeseries_entry_t key;
-
-        key.usecSince1970 = startTime;
-        entry = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
+        entry = timeseries_find(timeseries, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
-        entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
+        entry = timeseries_first(timeseries, &cursor);
 
-    for (; entry; entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
+    for (; entry; entry = timeseries_next(timeseries, &cursor))
     {
         /* Past our time range? */
         if (endTime && entry->usecSince1970 > endTime)
@@ -3686,15 +4881,12 @@ dcgmReturn_t DcgmCacheManager::GetUniquePidLists(dcgm_field_entity_group_t entit
     /* Walk forward  */
     if (startTime)
     {
-        timeseries_entry_t key;
-
-        key.usecSince1970 = startTime;
-        entry = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
+        entry = timeseries_find(timeseries, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
-        entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
+        entry = timeseries_first(timeseries, &cursor);
 
-    for (; entry; entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
+    for (; entry; entry = timeseries_next(timeseries, &cursor))
     {
         /* Past our time range? */
         if (endTime && entry->usecSince1970 > endTime)
@@ -3759,6 +4951,9 @@ dcgmReturn_t DcgmCacheManager::PrecheckWatchInfoForSamples(dcgmcm_watch_info_p w
         return DCGM_ST_NOT_WATCHED;
     }
 
+    /* Every locked read of samples comes through here. Keeps recently read watches from being evicted */
+    watchInfo->lastReadUsec = timelib_usecSince1970();
+
     /* Matching existing behavior: if there is data for an entity, then we can
        return it. This bypasses recent NVML failures or the field no longer
        being watched. */
@@ -3797,6 +4992,15 @@ dcgmReturn_t DcgmCacheManager::PrecheckWatchInfoForSamples(dcgmcm_watch_info_p w
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+/* Timestamp of the oldest entry of timeseries. 0 if it is empty */
+static timelib64_t GetOldestTimestamp(timeseries_p timeseries)
+{
+    kv_cursor_t cursor;
+    timeseries_entry_p entry = timeseries_first(timeseries, &cursor);
+    return entry ? entry->usecSince1970 : 0;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::GetUniquePidUtilLists(dcgm_field_entity_group_t entityGroupId,
                                                      dcgm_field_eid_t entityId,
@@ -3837,6 +5041,57 @@ dcgmReturn_t DcgmCacheManager::GetUniquePidUtilLists(dcgm_field_entity_group_t e
         return DCGM_ST_GENERIC_ERROR;
     }
 
+    if (maxPids > 0 && watchInfo->processStatsIndex)
+    {
+        /* Only the samples that are still in the timeseries */
+        timelib64_t const oldestTimestamp = GetOldestTimestamp(watchInfo->timeSeries);
+        std::vector<DcgmProcessStatsIndex::PidUtilSum> sums;
+        long long numRangeSamples = 0;
+
+        if (oldestTimestamp != 0 && includePid > 0)
+        {
+            DcgmProcessStatsIndex::PidUtilSum sum { includePid, 0, 0.0 };
+            if (watchInfo->processStatsIndex->GetUtilSum(
+                    includePid, std::max(startTime, oldestTimestamp), endTime, sum.utilSum, numRangeSamples))
+            {
+                sums.push_back(sum);
+            }
+        }
+        else if (oldestTimestamp != 0)
+        {
+            watchInfo->processStatsIndex->GetAllUtilSums(
+                std::max(startTime, oldestTimestamp), endTime, sums, numRangeSamples);
+        }
+
+        dcgm_mutex_unlock(m_mutex);
+
+        /* Skip samples without a process and return PIDs in the order the timeseries walk below would */
+        std::erase_if(sums, [](auto const &sum) { return sum.pid == std::numeric_limits<unsigned>::max(); });
+        std::sort(sums.begin(), sums.end(), [](auto const &a, auto const &b) {
+            return std::tie(a.firstTimestamp, a.pid) < std::tie(b.firstTimestamp, b.pid);
+        });
+
+        for (auto const &sum : sums)
+        {
+            if (*numUniqueSamples >= maxPids)
+            {
+                log_debug("Reached Max Capacity of ProcessSamples  - {}, maxPids = {}", *numUniqueSamples, maxPids);
+                break;
+            }
+
+            processUtilSamples[*numUniqueSamples].pid  = sum.pid;
+            processUtilSamples[*numUniqueSamples].util = sum.utilSum / numRangeSamples;
+            (*numUniqueSamples)++;
+        }
+
+        if (!(*numUniqueSamples))
+        {
+            return watchInfo->isWatched ? DCGM_ST_NO_DATA : DCGM_ST_NOT_WATCHED;
+        }
+
+        return DCGM_ST_OK;
+    }
+
     /* Data type is assumed to be a time series type */
     timeseries_p timeseries = watchInfo->timeSeries;
     kv_cursor_t cursor;
@@ -3848,15 +5103,12 @@ dcgmReturn_t DcgmCacheManager::GetUniquePidUtilLists(dcgm_field_entity_group_t e
     /* Walk forward  */
     if (startTime)
     {
-        timeseries_entry_t key;
-
-        key.usecSince1970 = startTime;
-        entry = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
+        entry = timeseries_find(timeseries, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
-        entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
+        entry = timeseries_first(timeseries, &cursor);
 
-    for (; entry; entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
+    for (; entry; entry = timeseries_next(timeseries, &cursor))
     {
         /* Past our time range? */
         if (endTime && entry->usecSince1970 > endTime)
@@ -3951,17 +5203,34 @@ dcgmReturn_t DcgmCacheManager::GetLatestProcessInfo(unsigned int gpuId,
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    /* Data type is assumed to be a time series type */
-    timeseries_p timeseries = watchInfo->timeSeries;
-    kv_cursor_t cursor;
-    timeseries_entry_p entry = 0;
-    dcgmDevicePidAccountingStats_t *accStats;
-    dcgmDevicePidAccountingStats_t *matchingAccStats = 0;
-    int Nseen                                        = 0;
-
+    if (watchInfo->processStatsIndex)
+    {
+        /* Only the records that are still in the timeseries */
+        timelib64_t const oldestTimestamp = GetOldestTimestamp(watchInfo->timeSeries);
+        bool const found                  = oldestTimestamp != 0
+                           && watchInfo->processStatsIndex->GetLatestAccountingStats(pid, oldestTimestamp, *pidInfo);
+        dcgm_mutex_unlock(m_mutex);
+
+        if (!found)
+        {
+            log_debug("Pid {} not found in the process stats index", pid);
+            return watchInfo->isWatched ? DCGM_ST_NO_DATA : DCGM_ST_NOT_WATCHED;
+        }
+
+        return DCGM_ST_OK;
+    }
+
+    /* Data type is assumed to be a time series type */
+    timeseries_p timeseries = watchInfo->timeSeries;
+    kv_cursor_t cursor;
+    timeseries_entry_p entry = 0;
+    dcgmDevicePidAccountingStats_t *accStats;
+    dcgmDevicePidAccountingStats_t *matchingAccStats = 0;
+    int Nseen                                        = 0;
+
     /* Walk backwards looking for our PID */
-    for (entry = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor); entry && !matchingAccStats;
-         entry = (timeseries_entry_p)keyedvector_prev(timeseries->keyedVector, &cursor))
+    for (entry = timeseries_last(timeseries, &cursor); entry && !matchingAccStats;
+         entry = timeseries_prev(timeseries, &cursor))
     {
         Nseen++;
         accStats = (dcgmDevicePidAccountingStats_t *)entry->val.ptr;
@@ -4006,6 +5275,330 @@ dcgmReturn_t DcgmCacheManager::GetLatestProcessInfo(unsigned int gpuId,
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+/* Get the quantile of a percentile summary type. Returns false for the other summary types */
+static bool GetSummaryTypeQuantile(DcgmcmSummaryType_t summaryType, double &quantile)
+{
+    switch (summaryType)
+    {
+        case DcgmcmSummaryTypeP50:
+            quantile = 0.50;
+            return true;
+        case DcgmcmSummaryTypeP95:
+            quantile = 0.95;
+            return true;
+        case DcgmcmSummaryTypeP99:
+            quantile = 0.99;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************/
+static bool HasQuantileSummaryTypes(int numSummaryTypes, DcgmcmSummaryType_t const *summaryTypes)
+{
+    double quantile;
+    for (int stIndex = 0; stIndex < numSummaryTypes; stIndex++)
+    {
+        if (GetSummaryTypeQuantile(summaryTypes[stIndex], quantile))
+            return true;
+    }
+    return false;
+}
+
+/*****************************************************************************/
+/* Set the percentile summary types of summaryValues from sketch. Other summary types are left alone */
+template <typename T>
+static void FillQuantileSummaryValues(DcgmQuantileSketch const &sketch,
+                                      int numSummaryTypes,
+                                      DcgmcmSummaryType_t const *summaryTypes,
+                                      T *summaryValues)
+{
+    double quantile;
+    double value;
+
+    for (int stIndex = 0; stIndex < numSummaryTypes; stIndex++)
+    {
+        if (!GetSummaryTypeQuantile(summaryTypes[stIndex], quantile) || !sketch.GetQuantile(quantile, value))
+            continue;
+
+        if constexpr (std::is_integral_v<T>)
+            summaryValues[stIndex] = std::llround(value);
+        else
+            summaryValues[stIndex] = value;
+    }
+}
+
+/*****************************************************************************/
+static bool SummaryTypesServedByRollups(int numSummaryTypes, DcgmcmSummaryType_t const *summaryTypes)
+{
+    for (int stIndex = 0; stIndex < numSummaryTypes; stIndex++)
+    {
+        switch (summaryTypes[stIndex])
+        {
+            case DcgmcmSummaryTypeMinimum:
+            case DcgmcmSummaryTypeMaximum:
+            case DcgmcmSummaryTypeAverage:
+            case DcgmcmSummaryTypeSum:
+            case DcgmcmSummaryTypeCount:
+            case DcgmcmSummaryTypeP50:
+            case DcgmcmSummaryTypeP95:
+            case DcgmcmSummaryTypeP99:
+                break;
+
+            default:
+                return false; /* Needs the individual samples in order */
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+static void GetSummaryEntryValue(timeseries_entry_p entry, long long &value, bool &isBlank)
+{
+    value   = entry->val.i64;
+    isBlank = DCGM_INT64_IS_BLANK(value);
+}
+
+static void GetSummaryEntryValue(timeseries_entry_p entry, double &value, bool &isBlank)
+{
+    value   = entry->val.dbl;
+    isBlank = DCGM_FP64_IS_BLANK(value);
+}
+
+/*****************************************************************************/
+/*
+ * Add the raw samples of timeseries in [startTime, endTime] to summary and, if it's
+ * given, their non-blank values to sketch. 0 for startTime or endTime means unbounded
+ */
+template <typename T>
+static void AddRawSamplesToSummary(timeseries_p timeseries,
+                                   timelib64_t startTime,
+                                   timelib64_t endTime,
+                                   DcgmRollupSummary<T> &summary,
+                                   DcgmQuantileSketch *sketch)
+{
+    kv_cursor_t cursor;
+    timeseries_entry_p entry;
+    T value;
+    bool isBlank;
+
+    if (startTime)
+        entry = timeseries_find(timeseries, startTime, TS_LGE_GREATEQUAL, &cursor);
+    else
+        entry = timeseries_first(timeseries, &cursor);
+
+    for (; entry; entry = timeseries_next(timeseries, &cursor))
+    {
+        if (endTime && entry->usecSince1970 > endTime)
+            break;
+
+        GetSummaryEntryValue(entry, value, isBlank);
+        summary.Add(value, isBlank);
+        if (sketch != nullptr && !isBlank)
+            sketch->Add((double)value);
+    }
+}
+
+/*****************************************************************************/
+/*
+ * Answer a summary request from a watch's rollups, reading raw samples only for
+ * the partial buckets at the edges of [startTime, endTime].
+ *
+ * Returns: true if the request was answered. Nseen is set to the number of samples summarized
+ *          false if the rollups don't cover any of the range. Use the raw samples instead
+ */
+template <typename T>
+static bool SummarizeFromRollups(DcgmSampleRollups<T> const &rollups,
+                                 timeseries_p timeseries,
+                                 timelib64_t startTime,
+                                 timelib64_t endTime,
+                                 int numSummaryTypes,
+                                 DcgmcmSummaryType_t const *summaryTypes,
+                                 T *summaryValues,
+                                 long long &Nseen)
+{
+    DcgmRollupSummary<T> summary;
+    timelib64_t interiorStart = 0;
+    timelib64_t interiorEnd   = 0;
+    DcgmQuantileSketch sketch;
+    DcgmQuantileSketch *sketchPtr = HasQuantileSummaryTypes(numSummaryTypes, summaryTypes) ? &sketch : nullptr;
+
+    if (!rollups.Summarize(startTime, endTime, summary, interiorStart, interiorEnd, sketchPtr))
+        return false;
+
+    AddRawSamplesToSummary(timeseries, startTime, interiorStart - 1, summary, sketchPtr);
+    AddRawSamplesToSummary(timeseries, interiorEnd, endTime, summary, sketchPtr);
+
+    Nseen = summary.count;
+
+    /* Like the raw path, every summary type stays blank if all of the values are blank */
+    if (!summary.nonBlankCount)
+        return true;
+
+    for (int stIndex = 0; stIndex < numSummaryTypes; stIndex++)
+    {
+        switch (summaryTypes[stIndex])
+        {
+            case DcgmcmSummaryTypeMinimum:
+                summaryValues[stIndex] = summary.minValue;
+                break;
+            case DcgmcmSummaryTypeMaximum:
+                summaryValues[stIndex] = summary.maxValue;
+                break;
+            case DcgmcmSummaryTypeAverage:
+                summaryValues[stIndex] = summary.sumValue / (T)summary.count;
+                break;
+            case DcgmcmSummaryTypeSum:
+                summaryValues[stIndex] = summary.sumValue;
+                break;
+            case DcgmcmSummaryTypeCount:
+                summaryValues[stIndex] = (T)summary.count;
+                break;
+            default:
+                break; /* Percentiles are below. The rest is filtered out by SummaryTypesServedByRollups() */
+        }
+    }
+
+    FillQuantileSummaryValues(sketch, numSummaryTypes, summaryTypes, summaryValues);
+    return true;
+}
+
+/*****************************************************************************/
+/*
+ * Summarize the samples of timeseries in [startTime, endTime] that pfUseEntryCB accepts.
+ * The samples are copied into contiguous chunks for the DcgmSummarizeChunk() kernels.
+ * Their non-blank values are also added to sketch if it's given
+ *
+ * Returns false if the request this runs for was stopped before all samples were seen
+ */
+template <typename T>
+static bool SummarizeRawSamples(timeseries_p timeseries,
+                                timelib64_t startTime,
+                                timelib64_t endTime,
+                                pfUseEntryForSummary pfUseEntryCB,
+                                void *userData,
+                                bool wantIntegral,
+                                DcgmQuantileSketch *sketch,
+                                DcgmSummaryState<T> &state)
+{
+    static constexpr size_t c_chunkSize = 512;
+    T values[c_chunkSize];
+    timelib64_t timestamps[c_chunkSize];
+    size_t count = 0;
+    bool isBlank;
+    kv_cursor_t cursor;
+    timeseries_entry_p entry;
+
+    auto summarizeChunk = [&]() {
+        DcgmSummarizeChunk(values, timestamps, count, wantIntegral, state);
+        if (sketch != nullptr)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!(values[i] >= DcgmSummaryBlank<T>()))
+                    sketch->Add((double)values[i]);
+            }
+        }
+        count = 0;
+    };
+
+    if (startTime)
+        entry = timeseries_find(timeseries, startTime, TS_LGE_GREATEQUAL, &cursor);
+    else
+        entry = timeseries_first(timeseries, &cursor);
+
+    for (; entry; entry = timeseries_next(timeseries, &cursor))
+    {
+        if (endTime && entry->usecSince1970 > endTime)
+            break;
+
+        if (pfUseEntryCB && !pfUseEntryCB(entry, userData))
+            continue;
+
+        GetSummaryEntryValue(entry, values[count], isBlank);
+        timestamps[count] = entry->usecSince1970;
+        if (++count == c_chunkSize)
+        {
+            summarizeChunk();
+            /* Windows can hold millions of samples. Don't hold the lock for a client that's gone */
+            if (DcgmInflightRequests::ShouldStop())
+                return false;
+        }
+    }
+
+    summarizeChunk();
+    return true;
+}
+
+/*****************************************************************************/
+/*
+ * Set summaryValues from state. Percentiles are left alone for FillQuantileSummaryValues().
+ * Every summary type but the integral stays blank if all of the values were blank
+ *
+ * Returns: DCGM_ST_OK on success
+ *          DCGM_ST_BADPARAM if a summary type is unknown
+ */
+template <typename T>
+static dcgmReturn_t FillSummaryValues(DcgmSummaryState<T> const &state,
+                                      int numSummaryTypes,
+                                      DcgmcmSummaryType_t const *summaryTypes,
+                                      T *summaryValues)
+{
+    bool const haveValue = state.numSeenAtLastValue > 0;
+
+    for (int stIndex = 0; stIndex < numSummaryTypes; stIndex++)
+    {
+        switch (summaryTypes[stIndex])
+        {
+            case DcgmcmSummaryTypeMinimum:
+                summaryValues[stIndex] = state.minValue;
+                break;
+
+            case DcgmcmSummaryTypeMaximum:
+                summaryValues[stIndex] = state.maxValue;
+                break;
+
+            case DcgmcmSummaryTypeAverage:
+                if (haveValue)
+                    summaryValues[stIndex] = state.sumValue / (T)state.numSeenAtLastValue;
+                break;
+
+            case DcgmcmSummaryTypeSum:
+                if (haveValue)
+                    summaryValues[stIndex] = state.sumValue;
+                break;
+
+            case DcgmcmSummaryTypeCount:
+                if (haveValue)
+                    summaryValues[stIndex] = (T)state.numSeenAtLastValue;
+                break;
+
+            case DcgmcmSummaryTypeIntegral:
+                summaryValues[stIndex] = state.integral;
+                break;
+
+            case DcgmcmSummaryTypeDifference:
+                if (haveValue)
+                    summaryValues[stIndex] = state.lastValue - state.firstValue;
+                break;
+
+            case DcgmcmSummaryTypeP50:
+            case DcgmcmSummaryTypeP95:
+            case DcgmcmSummaryTypeP99:
+                break; /* Answered from the sketch */
+
+            default:
+                log_error("Unhandled summaryType {}", (int)summaryTypes[stIndex]);
+                return DCGM_ST_BADPARAM;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::GetInt64SummaryData(dcgm_field_entity_group_t entityGroupId,
                                                    dcgm_field_eid_t entityId,
@@ -4051,134 +5644,49 @@ dcgmReturn_t DcgmCacheManager::GetInt64SummaryData(dcgm_field_entity_group_t ent
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    /* Data type is assumed to be a time series type */
-    timeseries_p timeseries = watchInfo->timeSeries;
-    kv_cursor_t cursor;
-    timeseries_entry_p entry  = 0;
-    timelib64_t prevTimestamp = 0;
-    int Nseen                 = 0;
-    long long value = 0, prevValue = 0, sumValue = 0;
-    long long firstValue = DCGM_INT64_BLANK;
-
-    /* Walk forward  */
-    if (startTime)
-    {
-        timeseries_entry_t key;
-
-        key.usecSince1970 = startTime;
-        entry = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
-    }
-    else
-        entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
-
-    for (; entry; entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
+    long long rollupNseen = 0;
+    if (watchInfo->int64Rollups && !pfUseEntryCB && SummaryTypesServedByRollups(numSummaryTypes, summaryTypes)
+        && SummarizeFromRollups(*watchInfo->int64Rollups,
+                                watchInfo->timeSeries,
+                                startTime,
+                                endTime,
+                                numSummaryTypes,
+                                summaryTypes,
+                                summaryValues,
+                                rollupNseen))
     {
-        /* Past our time range? */
-        if (endTime && entry->usecSince1970 > endTime)
-            break;
-
-
-        if (pfUseEntryCB)
-        {
-            if (!pfUseEntryCB(entry, userData))
-            {
-                continue;
-            }
-        }
-
-        Nseen++;
-        value = entry->val.i64;
-
-        /* All of the current summary types ignore blank values */
-        if (DCGM_INT64_IS_BLANK(value))
-        {
-            log_debug("Skipping blank value at Nseen {}. fieldId {}", Nseen, watchInfo->watchKey.fieldId);
-            prevValue     = value;
-            prevTimestamp = entry->usecSince1970;
-            continue;
-        }
-
-        /* Keep track of first non-blank value */
-        if (DCGM_INT64_IS_BLANK(firstValue))
-        {
-            firstValue = value;
-        }
-
-        /* Keep a running sum */
-        sumValue += value;
-
-        /* Walk over each summary type the caller is requesting and do the necessary work
-         * for this value */
-        for (stIndex = 0; stIndex < numSummaryTypes; stIndex++)
-        {
-            switch (summaryTypes[stIndex])
-            {
-                case DcgmcmSummaryTypeMinimum:
-                    if (DCGM_INT64_IS_BLANK(summaryValues[stIndex]) || value < summaryValues[stIndex])
-                    {
-                        summaryValues[stIndex] = value;
-                    }
-                    break;
-
-                case DcgmcmSummaryTypeMaximum:
-                    if (DCGM_INT64_IS_BLANK(summaryValues[stIndex]) || value > summaryValues[stIndex])
-                    {
-                        summaryValues[stIndex] = value;
-                    }
-                    break;
-
-                case DcgmcmSummaryTypeAverage:
-                    summaryValues[stIndex] = sumValue / (long long)Nseen;
-                    break;
-
-                case DcgmcmSummaryTypeSum:
-                    summaryValues[stIndex] = sumValue;
-                    break;
-
-                case DcgmcmSummaryTypeCount:
-                    summaryValues[stIndex] = Nseen;
-                    break;
+        dcgm_mutex_unlock(m_mutex);
 
-                case DcgmcmSummaryTypeIntegral:
-                {
-                    timelib64_t timeDiff;
-                    long long avgValue, area;
+        if (!rollupNseen)
+            return watchInfo->isWatched ? DCGM_ST_NO_DATA : DCGM_ST_NOT_WATCHED;
 
-                    /* Need a time difference to calculate an area */
-                    if (!prevTimestamp)
-                    {
-                        summaryValues[stIndex] = 0; /* Make sure our starting value is non-blank */
-                        break;
-                    }
+        return DCGM_ST_OK;
+    }
 
-                    avgValue = (value + prevValue) / 2;
-                    timeDiff = entry->usecSince1970 - prevTimestamp;
-                    area     = (avgValue * timeDiff);
-                    summaryValues[stIndex] += area;
-                    break;
-                }
+    DcgmSummaryState<long long> state;
+    DcgmQuantileSketch sketch;
+    bool const wantIntegral = std::find(summaryTypes, summaryTypes + numSummaryTypes, DcgmcmSummaryTypeIntegral)
+                              != summaryTypes + numSummaryTypes;
 
-                case DcgmcmSummaryTypeDifference:
-                {
-                    summaryValues[stIndex] = value - firstValue;
-                    break;
-                }
+    bool const completed
+        = SummarizeRawSamples(watchInfo->timeSeries,
+                              startTime,
+                              endTime,
+                              pfUseEntryCB,
+                              userData,
+                              wantIntegral,
+                              HasQuantileSummaryTypes(numSummaryTypes, summaryTypes) ? &sketch : nullptr,
+                              state);
 
-                default:
-                    dcgm_mutex_unlock(m_mutex);
-                    log_error("Unhandled summaryType {}", (int)summaryTypes[stIndex]);
-                    return DCGM_ST_BADPARAM;
-            }
-        }
+    dcgm_mutex_unlock(m_mutex);
 
-        /* Save previous values before going around loop */
-        prevValue     = value;
-        prevTimestamp = entry->usecSince1970;
+    if (!completed)
+    {
+        log_debug("Stopped summarizing field {} for a cancelled or timed out request", dcgmFieldId);
+        return DCGM_ST_TIMEOUT;
     }
 
-    dcgm_mutex_unlock(m_mutex);
-
-    if (!Nseen)
+    if (!state.numSeen)
     {
         log_debug("No values found");
 
@@ -4188,6 +5696,11 @@ dcgmReturn_t DcgmCacheManager::GetInt64SummaryData(dcgm_field_entity_group_t ent
             return DCGM_ST_NO_DATA;
     }
 
+    dcgmReturn = FillSummaryValues(state, numSummaryTypes, summaryTypes, summaryValues);
+    if (dcgmReturn != DCGM_ST_OK)
+        return dcgmReturn;
+
+    FillQuantileSummaryValues(sketch, numSummaryTypes, summaryTypes, summaryValues);
     return DCGM_ST_OK;
 }
 
@@ -4236,140 +5749,209 @@ dcgmReturn_t DcgmCacheManager::GetFp64SummaryData(dcgm_field_entity_group_t enti
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    /* Data type is assumed to be a time series type */
-    timeseries_p timeseries = watchInfo->timeSeries;
-    kv_cursor_t cursor;
-    timeseries_entry_p entry  = 0;
-    timelib64_t prevTimestamp = 0;
-    int Nseen                 = 0;
-    double value = 0.0, prevValue = 0.0, sumValue = 0.0;
-    double firstValue = DCGM_FP64_BLANK;
-
-    /* Walk forward  */
-    if (startTime)
+    long long rollupNseen = 0;
+    if (watchInfo->fp64Rollups && !pfUseEntryCB && SummaryTypesServedByRollups(numSummaryTypes, summaryTypes)
+        && SummarizeFromRollups(*watchInfo->fp64Rollups,
+                                watchInfo->timeSeries,
+                                startTime,
+                                endTime,
+                                numSummaryTypes,
+                                summaryTypes,
+                                summaryValues,
+                                rollupNseen))
     {
-        timeseries_entry_t key;
+        dcgm_mutex_unlock(m_mutex);
 
-        key.usecSince1970 = startTime;
-        entry = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
+        if (!rollupNseen)
+            return watchInfo->isWatched ? DCGM_ST_NO_DATA : DCGM_ST_NOT_WATCHED;
+
+        return DCGM_ST_OK;
     }
-    else
-        entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
 
-    for (; entry; entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
-    {
-        /* Past our time range? */
-        if (endTime && entry->usecSince1970 > endTime)
-            break;
+    DcgmSummaryState<double> state;
+    DcgmQuantileSketch sketch;
+    bool const wantIntegral = std::find(summaryTypes, summaryTypes + numSummaryTypes, DcgmcmSummaryTypeIntegral)
+                              != summaryTypes + numSummaryTypes;
 
-        if (pfUseEntryCB)
-        {
-            if (!pfUseEntryCB(entry, userData))
-            {
-                continue;
-            }
-        }
+    bool const completed
+        = SummarizeRawSamples(watchInfo->timeSeries,
+                              startTime,
+                              endTime,
+                              pfUseEntryCB,
+                              userData,
+                              wantIntegral,
+                              HasQuantileSummaryTypes(numSummaryTypes, summaryTypes) ? &sketch : nullptr,
+                              state);
 
-        Nseen++;
-        value = entry->val.dbl;
+    dcgm_mutex_unlock(m_mutex);
 
-        /* All of the current summary types ignore blank values */
-        if (DCGM_FP64_IS_BLANK(value))
-        {
-            log_debug("Skipping blank value at Nseen {}. fieldId {}", Nseen, watchInfo->watchKey.fieldId);
-            prevValue     = value;
-            prevTimestamp = entry->usecSince1970;
-            continue;
-        }
+    if (!completed)
+    {
+        log_debug("Stopped summarizing field {} for a cancelled or timed out request", dcgmFieldId);
+        return DCGM_ST_TIMEOUT;
+    }
 
-        /* Keep track of the first non-blank value seen */
-        if (DCGM_FP64_IS_BLANK(firstValue))
-        {
-            firstValue = value;
-        }
+    if (!state.numSeen)
+    {
+        log_debug("No values found");
 
-        /* Keep a running sum */
-        sumValue += value;
+        if (!watchInfo->isWatched)
+            return DCGM_ST_NOT_WATCHED;
+        else
+            return DCGM_ST_NO_DATA;
+    }
 
-        /* Walk over each summary type the caller is requesting and do the necessary work
-         * for this value */
-        for (stIndex = 0; stIndex < numSummaryTypes; stIndex++)
-        {
-            switch (summaryTypes[stIndex])
-            {
-                case DcgmcmSummaryTypeMinimum:
-                    if (DCGM_FP64_IS_BLANK(summaryValues[stIndex]) || value < summaryValues[stIndex])
-                    {
-                        summaryValues[stIndex] = value;
-                    }
-                    break;
+    dcgmReturn = FillSummaryValues(state, numSummaryTypes, summaryTypes, summaryValues);
+    if (dcgmReturn != DCGM_ST_OK)
+        return dcgmReturn;
 
-                case DcgmcmSummaryTypeMaximum:
-                    if (DCGM_FP64_IS_BLANK(summaryValues[stIndex]) || value > summaryValues[stIndex])
-                    {
-                        summaryValues[stIndex] = value;
-                    }
-                    break;
+    FillQuantileSummaryValues(sketch, numSummaryTypes, summaryTypes, summaryValues);
+    return DCGM_ST_OK;
+}
 
-                case DcgmcmSummaryTypeAverage:
-                    summaryValues[stIndex] = sumValue / (double)Nseen;
-                    break;
+/*****************************************************************************/
+/*
+ * Add the non-blank samples of timeseries in [startTime, endTime] to sketch, taking
+ * the whole buckets of rollups if it is given.
+ *
+ * Returns: The number of samples in the range, including blank ones
+ */
+template <typename T>
+static long long AddSamplesToSketch(DcgmSampleRollups<T> const *rollups,
+                                    timeseries_p timeseries,
+                                    timelib64_t startTime,
+                                    timelib64_t endTime,
+                                    DcgmQuantileSketch &sketch)
+{
+    DcgmRollupSummary<T> summary;
+    timelib64_t interiorStart = 0;
+    timelib64_t interiorEnd   = 0;
 
-                case DcgmcmSummaryTypeSum:
-                    summaryValues[stIndex] = sumValue;
-                    break;
+    if (rollups != nullptr && rollups->Summarize(startTime, endTime, summary, interiorStart, interiorEnd, &sketch))
+    {
+        AddRawSamplesToSummary(timeseries, startTime, interiorStart - 1, summary, &sketch);
+        AddRawSamplesToSummary(timeseries, interiorEnd, endTime, summary, &sketch);
+    }
+    else
+    {
+        AddRawSamplesToSummary(timeseries, startTime, endTime, summary, &sketch);
+    }
 
-                case DcgmcmSummaryTypeCount:
-                    summaryValues[stIndex] = Nseen;
-                    break;
+    return summary.count;
+}
 
-                case DcgmcmSummaryTypeIntegral:
-                {
-                    timelib64_t timeDiff;
-                    double avgValue, area;
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetSummarySketch(dcgm_field_entity_group_t entityGroupId,
+                                                dcgm_field_eid_t entityId,
+                                                unsigned short dcgmFieldId,
+                                                timelib64_t startTime,
+                                                timelib64_t endTime,
+                                                DcgmQuantileSketch &sketch)
+{
+    long long Nseen = 0;
 
-                    /* Need a time difference to calculate an area */
-                    if (!prevTimestamp)
-                    {
-                        summaryValues[stIndex] = 0; /* Make sure our starting value is non-blank */
-                        break;
-                    }
+    sketch = {};
 
-                    avgValue = (value + prevValue) / 2.0;
-                    timeDiff = entry->usecSince1970 - prevTimestamp;
-                    area     = (avgValue * timeDiff);
-                    summaryValues[stIndex] += area;
-                    break;
-                }
+    dcgm_mutex_lock(m_mutex);
 
-                case DcgmcmSummaryTypeDifference:
-                {
-                    summaryValues[stIndex] = value - firstValue;
-                    break;
-                }
+    dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(entityGroupId, entityId, dcgmFieldId, 0);
 
-                default:
-                    dcgm_mutex_unlock(m_mutex);
-                    log_error("Unhandled summaryType {}", (int)summaryTypes[stIndex]);
-                    return DCGM_ST_BADPARAM;
-            }
-        }
+    dcgmReturn_t dcgmReturn = PrecheckWatchInfoForSamples(watchInfo);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        dcgm_mutex_unlock(m_mutex);
+        return dcgmReturn;
+    }
+
+    switch (watchInfo->timeSeries->tsType)
+    {
+        case TS_TYPE_INT64:
+            Nseen = AddSamplesToSketch(
+                watchInfo->int64Rollups.get(), watchInfo->timeSeries, startTime, endTime, sketch);
+            break;
+
+        case TS_TYPE_DOUBLE:
+            Nseen = AddSamplesToSketch(
+                watchInfo->fp64Rollups.get(), watchInfo->timeSeries, startTime, endTime, sketch);
+            break;
 
-        /* Save previous values before going around loop */
-        prevValue     = value;
-        prevTimestamp = entry->usecSince1970;
+        default:
+            log_error(
+                "Expected a numeric time series for field {}. Got {}", dcgmFieldId, watchInfo->timeSeries->tsType);
+            dcgm_mutex_unlock(m_mutex);
+            return DCGM_ST_GENERIC_ERROR;
     }
 
+    bool const isWatched = watchInfo->isWatched;
+
     dcgm_mutex_unlock(m_mutex);
 
     if (!Nseen)
+        return isWatched ? DCGM_ST_NO_DATA : DCGM_ST_NOT_WATCHED;
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+/* Converts the entries of timeseries between startTime and endTime in order to samples and/or fvBuffer,
+   starting at index numSamples, until numSamples reaches maxSamples.
+   A startTime or endTime of 0 leaves that end of the range open. m_mutex must be held */
+static dcgmReturn_t CopySeriesRangeToSamples(timeseries_p timeseries,
+                                             timelib64_t startTime,
+                                             timelib64_t endTime,
+                                             dcgmOrder_t order,
+                                             int maxSamples,
+                                             dcgm_field_entity_group_t entityGroupId,
+                                             dcgm_field_eid_t entityId,
+                                             unsigned short dcgmFieldId,
+                                             dcgmcm_sample_p samples,
+                                             DcgmFvBuffer *fvBuffer,
+                                             int &numSamples)
+{
+    kv_cursor_t cursor;
+    timeseries_entry_p entry = 0;
+    bool const ascending     = order == DCGM_ORDER_ASCENDING;
+
+    /* Which entry we start on depends on if a starting timestamp was provided or not */
+    if (ascending)
     {
-        log_debug("No values found");
+        entry = startTime ? timeseries_find(timeseries, startTime, TS_LGE_GREATEQUAL, &cursor)
+                          : timeseries_first(timeseries, &cursor);
+    }
+    else /* DCGM_ORDER_DESCENDING */
+    {
+        entry = endTime ? timeseries_find(timeseries, endTime, TS_LGE_LESSEQUAL, &cursor)
+                        : timeseries_last(timeseries, &cursor);
+    }
 
-        if (!watchInfo->isWatched)
-            return DCGM_ST_NOT_WATCHED;
-        else
-            return DCGM_ST_NO_DATA;
+    /* Walk all samples until we fill our buffer, run out of samples, or go past our end timestamp */
+    for (; entry && numSamples < maxSamples;
+         entry = ascending ? timeseries_next(timeseries, &cursor) : timeseries_prev(timeseries, &cursor))
+    {
+        /* Past our time range? */
+        if (ascending && endTime && entry->usecSince1970 > endTime)
+            break;
+        if (!ascending && startTime && entry->usecSince1970 < startTime)
+            break;
+
+        /* Got an entry. Convert it to a sample */
+        dcgmReturn_t st = DCGM_ST_OK;
+        if (samples)
+        {
+            st = DcgmcmTimeSeriesEntryToSample(&samples[numSamples], entry, timeseries->tsType);
+        }
+        if (fvBuffer)
+        {
+            st = DcgmcmWriteTimeSeriesEntryToFvBuffer(
+                entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries->tsType);
+        }
+
+        if (st)
+        {
+            return st;
+        }
+
+        numSamples++;
     }
 
     return DCGM_ST_OK;
@@ -4414,28 +5996,18 @@ dcgmReturn_t DcgmCacheManager::GetSamples(dcgm_field_entity_group_t entityGroupI
     if (!fieldMeta)
         return DCGM_ST_UNKNOWN_FIELD;
 
-    dcgm_field_entity_group_t watchEntityGroupId = entityGroupId;
-    unsigned int watchEntityId                   = entityId;
+    DCGM_LOG_DEBUG << "eg " << entityGroupId << ", eid " << entityId << ", fieldId " << dcgmFieldId << ", maxSamples "
+                   << maxSamples << ", startTime " << startTime << ", endTime " << endTime << ", order " << order;
 
-    if (fieldMeta->scope == DCGM_FS_GLOBAL && watchEntityGroupId != DCGM_FE_NONE)
+    if (DcgmInflightRequests::ShouldStop())
     {
-        DCGM_LOG_DEBUG << "Fixing entityGroupId for global field";
-        watchEntityGroupId = DCGM_FE_NONE;
+        return DCGM_ST_TIMEOUT;
     }
 
-    DCGM_LOG_DEBUG << "eg " << entityGroupId << ", eid " << entityId << ", fieldId " << dcgmFieldId << ", maxSamples "
-                   << maxSamples << ", startTime " << startTime << ", endTime " << endTime << ", order " << order;
-
+    int numSamples = 0;
     DcgmLockGuard dlg(m_mutex);
 
-    if (watchEntityGroupId != DCGM_FE_NONE)
-    {
-        watchInfo = GetEntityWatchInfo(watchEntityGroupId, watchEntityId, fieldMeta->fieldId, 0);
-    }
-    else
-    {
-        watchInfo = GetGlobalWatchInfo(fieldMeta->fieldId, 0);
-    }
+    watchInfo = GetWatchInfoForSamples(entityGroupId, entityId, fieldMeta);
 
     st = PrecheckWatchInfoForSamples(watchInfo);
     if (st != DCGM_ST_OK)
@@ -4446,106 +6018,53 @@ dcgmReturn_t DcgmCacheManager::GetSamples(dcgm_field_entity_group_t entityGroupI
     /* Data type is assumed to be a time series type */
 
     timeseries = watchInfo->timeSeries;
-    kv_cursor_t cursor;
-    timeseries_entry_p entry = 0;
 
-    if (order == DCGM_ORDER_ASCENDING)
+    /* The history tier only contributes the samples that are older than the oldest one of the series */
+    timeseries_p history       = watchInfo->historyTimeSeries;
+    timelib64_t historyEndTime = 0;
+    if (history)
     {
-        /* Which entry we start on depends on if a starting timestamp was provided or not */
-        if (!startTime)
+        kv_cursor_t cursor;
+        timeseries_entry_p oldest = timeseries_first(timeseries, &cursor);
+        historyEndTime = oldest ? oldest->usecSince1970 - 1 : std::numeric_limits<timelib64_t>::max();
+        if (endTime)
         {
-            entry = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
+            historyEndTime = std::min(historyEndTime, endTime);
         }
-        else
+        if (startTime > historyEndTime)
         {
-            timeseries_entry_t key;
-
-            key.usecSince1970 = startTime;
-            entry             = (timeseries_entry_p)keyedvector_find_by_key(
-                timeseries->keyedVector, &key, KV_LGE_GREATEQUAL, &cursor);
+            history = nullptr;
         }
+    }
 
-        /* Walk all samples until we fill our buffer, run out of samples, or go past our end timestamp */
-        for (; entry && (*Msamples) < maxSamples;
-             entry = (timeseries_entry_p)keyedvector_next(timeseries->keyedVector, &cursor))
-        {
-            /* Past our time range? */
-            if (endTime && entry->usecSince1970 > endTime)
-                break;
-
-            /* Got an entry. Convert it to a sample */
-            st = DCGM_ST_OK;
-            if (samples)
-            {
-                st = DcgmcmTimeSeriesEntryToSample(&samples[*Msamples], entry, timeseries);
-            }
-            if (fvBuffer)
-            {
-                st = DcgmcmWriteTimeSeriesEntryToFvBuffer(
-                    entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries);
-            }
-
-            if (st)
-            {
-                DCGM_LOG_ERROR << "st " << st;
-                *Msamples = 0;
-                return st;
-            }
+    /* Ascending reads the older history tier first, descending reads it last */
+    timeseries_p const first    = order == DCGM_ORDER_ASCENDING ? history : timeseries;
+    timeseries_p const second   = order == DCGM_ORDER_ASCENDING ? timeseries : history;
+    timelib64_t const firstEnd  = order == DCGM_ORDER_ASCENDING ? historyEndTime : endTime;
+    timelib64_t const secondEnd = order == DCGM_ORDER_ASCENDING ? endTime : historyEndTime;
 
-            (*Msamples)++;
-        }
+    if (first)
+    {
+        retSt = CopySeriesRangeToSamples(first, startTime, firstEnd, order, maxSamples, entityGroupId, entityId,
+                                         dcgmFieldId, samples, fvBuffer, numSamples);
     }
-    else /* DCGM_ORDER_DESCENDING */
+    if (retSt == DCGM_ST_OK && second)
     {
-        /* Which entry we start on depends on if a starting timestamp was provided or not */
-        if (!endTime)
-        {
-            entry = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor);
-        }
-        else
-        {
-            timeseries_entry_t key;
-
-            key.usecSince1970 = endTime;
-            entry
-                = (timeseries_entry_p)keyedvector_find_by_key(timeseries->keyedVector, &key, KV_LGE_LESSEQUAL, &cursor);
-        }
-
-        /* Walk all samples until we fill our buffer, run out of samples, or go past our end timestamp */
-        for (; entry && (*Msamples) < maxSamples;
-             entry = (timeseries_entry_p)keyedvector_prev(timeseries->keyedVector, &cursor))
-        {
-            /* Past our time range? */
-            if (startTime && entry->usecSince1970 < startTime)
-                break;
-
-            /* Got an entry. Convert it to a sample */
-            st = DCGM_ST_OK;
-            if (samples)
-            {
-                st = DcgmcmTimeSeriesEntryToSample(&samples[*Msamples], entry, timeseries);
-            }
-            if (fvBuffer)
-            {
-                st = DcgmcmWriteTimeSeriesEntryToFvBuffer(
-                    entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries);
-            }
-
-            if (st)
-            {
-                DCGM_LOG_ERROR << "st " << st;
-                *Msamples = 0;
-                return st;
-            }
+        retSt = CopySeriesRangeToSamples(second, startTime, secondEnd, order, maxSamples, entityGroupId, entityId,
+                                         dcgmFieldId, samples, fvBuffer, numSamples);
+    }
 
-            (*Msamples)++;
-        }
+    if (retSt != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "st " << retSt;
+        return retSt;
     }
 
     /* Handle case where no samples are returned because of nvml errors calling the API */
-    if (!(*Msamples))
+    if (numSamples == 0)
     {
-        if (keyedvector_size(timeseries->keyedVector) > 0)
+        if (timeseries_size(timeseries) > 0
+            || (watchInfo->historyTimeSeries && timeseries_size(watchInfo->historyTimeSeries) > 0))
             retSt = DCGM_ST_NO_DATA; /* User just asked for a time range that has no records */
         else if (watchInfo->lastStatus != NVML_SUCCESS)
             retSt = DcgmNs::Utils::NvmlReturnToDcgmReturn(watchInfo->lastStatus);
@@ -4553,711 +6072,2541 @@ dcgmReturn_t DcgmCacheManager::GetSamples(dcgm_field_entity_group_t entityGroupI
             retSt = DCGM_ST_NOT_WATCHED;
         else
             retSt = DCGM_ST_NO_DATA;
-    }
 
+        DCGM_LOG_DEBUG << "Returning " << retSt << " Msamples 0";
+        return retSt;
+    }
 
+    *Msamples = numSamples;
     DCGM_LOG_DEBUG << "Returning " << retSt << " Msamples " << *Msamples;
     return retSt;
 }
 
+namespace
+{
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::GetLatestSample(dcgm_field_entity_group_t entityGroupId,
-                                               dcgm_field_eid_t entityId,
-                                               unsigned short dcgmFieldId,
-                                               dcgmcm_sample_p sample,
-                                               DcgmFvBuffer *fvBuffer)
+/*
+ * Fills the rows of a resampled column from the samples of a series, which are
+ * fed to Add() in ascending order. A row is filled once the first sample after
+ * its time is seen, since that sample is what LINEAR interpolates towards
+ */
+class SeriesResampler
 {
-    dcgm_field_meta_p fieldMeta = 0;
-    dcgmReturn_t st, retSt = DCGM_ST_OK;
-    timeseries_p timeseries       = 0;
-    dcgmcm_watch_info_p watchInfo = 0;
-
-    if (!sample && !fvBuffer)
-        return DCGM_ST_BADPARAM;
+public:
+    SeriesResampler(timelib64_t startTime,
+                    timelib64_t stepUsec,
+                    unsigned int numRows,
+                    dcgmResampleFill_t fill,
+                    double *values,
+                    size_t stride)
+        : m_startTime(startTime)
+        , m_stepUsec(stepUsec)
+        , m_numRows(numRows)
+        , m_fill(fill)
+        , m_values(values)
+        , m_stride(stride)
+    {}
 
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta)
+    /* Returns false once every row is filled. Later samples don't matter */
+    bool Add(timelib64_t timestamp, double value)
     {
-        if (fvBuffer)
-            fvBuffer->AddInt64Value(entityGroupId, entityId, dcgmFieldId, 0, 0, DCGM_ST_UNKNOWN_FIELD);
-        return DCGM_ST_UNKNOWN_FIELD;
-    }
+        for (; m_row < m_numRows && RowTime(m_row) < timestamp; m_row++)
+        {
+            FillRow(m_row, true, timestamp, value);
+        }
 
-    dcgm_field_entity_group_t watchEntityGroupId = entityGroupId;
+        m_hasPrev   = true;
+        m_prevTs    = timestamp;
+        m_prevValue = value;
+        return m_row < m_numRows;
+    }
 
-    DcgmLockGuard dlg(m_mutex);
+    /* Fill the rows that are after the last sample */
+    void Finish()
+    {
+        for (; m_row < m_numRows; m_row++)
+        {
+            FillRow(m_row, false, 0, DCGM_FP64_BLANK);
+        }
+    }
 
-    if (fieldMeta->scope == DCGM_FS_GLOBAL && watchEntityGroupId != DCGM_FE_NONE)
+private:
+    timelib64_t RowTime(unsigned int row) const
     {
-        DCGM_LOG_DEBUG << "Fixing entityGroupId for global field";
-        watchEntityGroupId = DCGM_FE_NONE;
+        return m_startTime + (timelib64_t)row * m_stepUsec;
     }
 
-    /* Don't need to GetIsValidEntityId(entityGroupId, entityId) here because Get*WatchInfo will
-       return null if there isn't a valid watch */
+    void FillRow(unsigned int row, bool hasNext, timelib64_t nextTs, double nextValue)
+    {
+        timelib64_t const rowTime = RowTime(row);
+        double value              = DCGM_FP64_BLANK;
 
-    if (watchEntityGroupId == DCGM_FE_NONE)
-        watchInfo = GetGlobalWatchInfo(fieldMeta->fieldId, 0);
-    else
-        watchInfo = GetEntityWatchInfo(watchEntityGroupId, entityId, fieldMeta->fieldId, 0);
+        if (m_hasPrev)
+        {
+            switch (m_fill)
+            {
+                case DCGM_RESAMPLE_FILL_NONE:
+                    if (m_prevTs > rowTime - m_stepUsec)
+                    {
+                        value = m_prevValue;
+                    }
+                    break;
 
-    st = PrecheckWatchInfoForSamples(watchInfo);
-    if (st != DCGM_ST_OK)
-    {
-        if (fvBuffer)
-            fvBuffer->AddInt64Value(entityGroupId, entityId, dcgmFieldId, 0, 0, st);
-        return st;
+                case DCGM_RESAMPLE_FILL_PREVIOUS:
+                    value = m_prevValue;
+                    break;
+
+                case DCGM_RESAMPLE_FILL_LINEAR:
+                    if (m_prevTs == rowTime)
+                    {
+                        value = m_prevValue;
+                    }
+                    else if (hasNext && !DCGM_FP64_IS_BLANK(m_prevValue) && !DCGM_FP64_IS_BLANK(nextValue))
+                    {
+                        value = m_prevValue
+                                + (nextValue - m_prevValue) * (double)(rowTime - m_prevTs)
+                                      / (double)(nextTs - m_prevTs);
+                    }
+                    break;
+            }
+        }
+
+        m_values[row * m_stride] = value;
     }
 
-    /* Data type is assumed to be a time series type */
+    timelib64_t m_startTime;
+    timelib64_t m_stepUsec;
+    unsigned int m_numRows;
+    dcgmResampleFill_t m_fill;
+    double *m_values;
+    size_t m_stride;
 
-    timeseries = watchInfo->timeSeries;
+    unsigned int m_row   = 0;
+    bool m_hasPrev       = false;
+    timelib64_t m_prevTs = 0;
+    double m_prevValue   = DCGM_FP64_BLANK;
+};
+
+/*****************************************************************************/
+/* Feeds the entries of timeseries up to endTime to resampler, from the latest one at or before startTime on. An
+   endTime of 0 leaves the range open. Returns false once resampler needs no more entries */
+bool ResampleSeries(timeseries_p timeseries, timelib64_t startTime, timelib64_t endTime, SeriesResampler &resampler)
+{
     kv_cursor_t cursor;
-    timeseries_entry_p entry = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor);
+    timeseries_entry_p entry = timeseries_find(timeseries, startTime, TS_LGE_LESSEQUAL, &cursor);
     if (!entry)
     {
-        /* No entries in time series. If NVML apis failed, return their error code */
-        if (watchInfo->lastStatus != NVML_SUCCESS)
-            retSt = DcgmNs::Utils::NvmlReturnToDcgmReturn(watchInfo->lastStatus);
-        else if (!watchInfo->isWatched)
-            retSt = DCGM_ST_NOT_WATCHED;
-        else
-            retSt = DCGM_ST_NO_DATA;
-
-        if (fvBuffer)
-            fvBuffer->AddInt64Value(entityGroupId, entityId, dcgmFieldId, 0, 0, retSt);
-        return retSt;
+        entry = timeseries_first(timeseries, &cursor);
     }
 
-    /* Got an entry. Convert it to a sample */
-    if (sample)
-    {
-        st    = DcgmcmTimeSeriesEntryToSample(sample, entry, timeseries);
-        retSt = st;
-    }
-    /* If the user provided a FV buffer, append our sample to it */
-    if (fvBuffer)
+    for (; entry; entry = timeseries_next(timeseries, &cursor))
     {
-        st    = DcgmcmWriteTimeSeriesEntryToFvBuffer(entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries);
-        retSt = st;
+        if (endTime && entry->usecSince1970 > endTime)
+        {
+            break;
+        }
+
+        double value;
+        if (timeseries->tsType == TS_TYPE_DOUBLE)
+        {
+            value = DCGM_FP64_IS_BLANK(entry->val.dbl) ? DCGM_FP64_BLANK : entry->val.dbl;
+        }
+        else
+        {
+            value = DCGM_INT64_IS_BLANK(entry->val.i64) ? DCGM_FP64_BLANK : (double)entry->val.i64;
+        }
+
+        if (!resampler.Add(entry->usecSince1970, value))
+        {
+            return false;
+        }
     }
 
-    return retSt;
+    return true;
 }
+} // namespace
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::GetMultipleLatestSamples(std::vector<dcgmGroupEntityPair_t> &entities,
-                                                        std::vector<unsigned short> &fieldIds,
-                                                        DcgmFvBuffer *fvBuffer)
+dcgmReturn_t DcgmCacheManager::ResampleField(dcgm_field_entity_group_t entityGroupId,
+                                             dcgm_field_eid_t entityId,
+                                             unsigned short dcgmFieldId,
+                                             timelib64_t startTime,
+                                             timelib64_t stepUsec,
+                                             unsigned int numRows,
+                                             dcgmResampleFill_t fill,
+                                             double *values,
+                                             size_t stride)
 {
-    std::vector<dcgmGroupEntityPair_t>::iterator entityIt;
-    std::vector<unsigned short>::iterator fieldIdIt;
-
-    if (!fvBuffer)
+    if (!values || stepUsec <= 0)
+    {
         return DCGM_ST_BADPARAM;
+    }
 
-    /* Lock the cache manager once for the whole request */
-    dcgm_mutex_lock(m_mutex);
+    SeriesResampler resampler(startTime, stepUsec, numRows, fill, values, stride);
 
-    for (entityIt = entities.begin(); entityIt != entities.end(); ++entityIt)
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta)
     {
-        for (fieldIdIt = fieldIds.begin(); fieldIdIt != fieldIds.end(); ++fieldIdIt)
+        resampler.Finish();
+        return DCGM_ST_UNKNOWN_FIELD;
+    }
+
+    DcgmLockGuard dlg(m_mutex);
+
+    dcgmcm_watch_info_p watchInfo = GetWatchInfoForSamples(entityGroupId, entityId, fieldMeta);
+    dcgmReturn_t st               = PrecheckWatchInfoForSamples(watchInfo);
+    if (st != DCGM_ST_OK)
+    {
+        resampler.Finish();
+        return st;
+    }
+
+    timeseries_p timeseries = watchInfo->timeSeries;
+    if (timeseries->tsType != TS_TYPE_INT64 && timeseries->tsType != TS_TYPE_DOUBLE)
+    {
+        log_error("Expected a numeric time series for field {}. Got {}", dcgmFieldId, timeseries->tsType);
+        resampler.Finish();
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    /* The history tier only contributes the samples that are older than the oldest one of the series. It is only
+       needed if the series doesn't reach back to startTime */
+    bool more                  = true;
+    timeseries_p const history = watchInfo->historyTimeSeries;
+    if (history)
+    {
+        kv_cursor_t cursor;
+        timeseries_entry_p oldest = timeseries_first(timeseries, &cursor);
+        if (!oldest || startTime < oldest->usecSince1970)
         {
-            /* Buffer each sample. Errors are written as statuses for each fv in fvBuffer */
-            dcgmReturn_t ret
-                = GetLatestSample((*entityIt).entityGroupId, (*entityIt).entityId, (*fieldIdIt), 0, fvBuffer);
-            if (DCGM_ST_OK != ret)
-            {
-                DCGM_LOG_ERROR << "GetLatestSample returned " << errorString(ret) << " for entityId "
-                               << entityIt->entityId << " groupId " << entityIt->entityGroupId << " fieldId "
-                               << *fieldIdIt;
-            }
+            timelib64_t const historyEndTime
+                = oldest ? oldest->usecSince1970 - 1 : std::numeric_limits<timelib64_t>::max();
+            more = ResampleSeries(history, startTime, historyEndTime, resampler);
         }
     }
 
-    dcgm_mutex_unlock(m_mutex);
+    if (more)
+    {
+        ResampleSeries(timeseries, startTime, 0, resampler);
+    }
 
+    resampler.Finish();
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::SetValue(int gpuId, unsigned short dcgmFieldId, dcgmcm_sample_p value)
+dcgmcm_watch_info_p DcgmCacheManager::GetWatchInfoForSamples(dcgm_field_entity_group_t entityGroupId,
+                                                             dcgm_field_eid_t entityId,
+                                                             dcgm_field_meta_p fieldMeta)
 {
-    dcgm_field_meta_p fieldMeta = 0;
-    nvmlReturn_t nvmlReturn;
-    nvmlDevice_t nvmlDevice = 0;
-    timelib64_t now, expireTime;
-    dcgmcm_watch_info_p watchInfo = 0;
-    dcgmcm_update_thread_t updateCtx;
-
-    if (!value)
-        return DCGM_ST_BADPARAM;
-
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta)
-        return DCGM_ST_UNKNOWN_FIELD;
-
-    if (m_nvmlLoaded == false)
+    if (fieldMeta->scope == DCGM_FS_GLOBAL || entityGroupId == DCGM_FE_NONE)
     {
-        log_error("Cannot set NVML values: NVML isn't loaded.");
-        return DCGM_ST_NVML_NOT_LOADED;
+        return GetGlobalWatchInfo(fieldMeta->fieldId, 0);
     }
 
-    memset(&updateCtx, 0, sizeof(updateCtx));
-    ClearThreadCtx(&updateCtx);
-    updateCtx.entityKey.entityGroupId = DCGM_FE_GPU;
-    updateCtx.entityKey.entityId      = gpuId;
-    updateCtx.entityKey.fieldId       = dcgmFieldId;
+    return GetEntityWatchInfo(entityGroupId, entityId, fieldMeta->fieldId, 0);
+}
 
-    if (fieldMeta->scope == DCGM_FS_ENTITY)
+/*****************************************************************************/
+bool DcgmCacheManager::GetPublishedLatestSample(dcgm_field_entity_group_t entityGroupId,
+                                                dcgm_field_eid_t entityId,
+                                                dcgm_field_meta_p fieldMeta,
+                                                dcgmcm_sample_p sample,
+                                                DcgmFvBuffer *fvBuffer,
+                                                dcgmReturn_t &retSt)
+{
+    dcgm_entity_key_t watchKey {};
+    dcgmcm_latest_value_t value {};
+
+    watchKey.fieldId = fieldMeta->fieldId;
+    if (fieldMeta->scope == DCGM_FS_GLOBAL || entityGroupId == DCGM_FE_NONE)
     {
-        watchInfo = GetEntityWatchInfo(DCGM_FE_GPU, GpuIdToNvmlIndex(gpuId), dcgmFieldId, 1);
+        watchKey.entityGroupId = DCGM_FE_NONE;
+        watchKey.entityId      = 0;
     }
     else
     {
-        watchInfo = GetGlobalWatchInfo(dcgmFieldId, 1);
-    }
-
-    if (watchInfo == nullptr)
-    {
-        DCGM_LOG_ERROR << "Got watchInfo == null from GetGlobalWatchInfo";
-        return DCGM_ST_GENERIC_ERROR;
+        watchKey.entityGroupId = entityGroupId;
+        watchKey.entityId      = entityId;
     }
 
-    now = timelib_usecSince1970();
-
-    expireTime = 0;
-    if (watchInfo->maxAgeUsec)
-        expireTime = now - watchInfo->maxAgeUsec;
+    if (!m_latestValues.Get(watchKey, value))
+        return false;
 
-    /* Is the field watched? If so, cause live updates to occur */
-    if (watchInfo->isWatched)
-        updateCtx.watchInfo = watchInfo;
+    retSt = DCGM_ST_OK;
 
-    /* Do we need a device handle? */
-    if (fieldMeta->scope == DCGM_FS_DEVICE)
+    if (sample)
     {
-        nvmlReturn = nvmlDeviceGetHandleByIndex_v2(GpuIdToNvmlIndex(gpuId), &nvmlDevice);
-        if (nvmlReturn != NVML_SUCCESS)
+        sample->timestamp = value.timestamp;
+        if (value.tsType == TS_TYPE_DOUBLE)
         {
-            log_error(
-                "nvmlDeviceGetHandleByIndex_v2 returned {} for gpuId {}", (int)nvmlReturn, GpuIdToNvmlIndex(gpuId));
-            return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            sample->val.d  = value.val.d;
+            sample->val2.d = value.val2.d;
+        }
+        else
+        {
+            sample->val.i64  = value.val.i64;
+            sample->val2.i64 = value.val2.i64;
         }
     }
 
-    switch (fieldMeta->fieldId)
+    if (fvBuffer)
     {
-        case DCGM_FI_DEV_AUTOBOOST:
+        dcgmBufferedFv_t *fv = nullptr;
+
+        if (value.tsType == TS_TYPE_DOUBLE)
+            fv = fvBuffer->AddDoubleValue(
+                entityGroupId, entityId, fieldMeta->fieldId, value.val.d, value.timestamp, DCGM_ST_OK);
+        else
+            fv = fvBuffer->AddInt64Value(
+                entityGroupId, entityId, fieldMeta->fieldId, value.val.i64, value.timestamp, DCGM_ST_OK);
+
+        if (!fv)
         {
-            nvmlEnableState_t enabledState;
+            log_error("Unexpected NULL fv returned for eg {}, eid {}, fieldId {}. Out of memory?",
+                      entityGroupId,
+                      entityId,
+                      fieldMeta->fieldId);
+            retSt = DCGM_ST_MEMORY;
+        }
+    }
 
-            enabledState = value->val.i64 ? NVML_FEATURE_ENABLED : NVML_FEATURE_DISABLED;
+    return true;
+}
 
-            nvmlReturn = nvmlDeviceSetDefaultAutoBoostedClocksEnabled(nvmlDevice, enabledState, 0);
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+/*****************************************************************************/
+void DcgmCacheManager::PublishLatestValue(dcgmcm_watch_info_p watchInfo)
+{
+    timeseries_p timeseries  = watchInfo->timeSeries;
+    timeseries_entry_p entry = nullptr;
+    kv_cursor_t cursor;
 
-            if (watchInfo->isWatched)
-            {
-                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
-            }
-            break;
-        }
+    if (timeseries && (timeseries->tsType == TS_TYPE_INT64 || timeseries->tsType == TS_TYPE_DOUBLE))
+        entry = timeseries_last(timeseries, &cursor);
 
-        case DCGM_FI_DEV_ENFORCED_POWER_LIMIT: /* Fall through is intentional */
-        case DCGM_FI_DEV_POWER_MGMT_LIMIT:
+    if (!entry)
+    {
+        m_latestValues.Unpublish(watchInfo->watchKey);
+        if (m_latestValueSlots && watchInfo->latestValueSlot != DcgmLatestValueSlots::c_noSlot)
         {
-            unsigned int currLimit, minLimit, maxLimit, newPowerLimit;
+            m_latestValueSlots->Unpublish(watchInfo->latestValueSlot);
+        }
+        if (m_sharedLatestValues && watchInfo->sharedLatestValueRow != DcgmSharedLatestValues::c_noRow)
+        {
+            m_sharedLatestValues->Unpublish(watchInfo->sharedLatestValueRow);
+        }
+        return;
+    }
 
-            newPowerLimit = (unsigned int)(value->val.d * 1000); // convert from W to mW
+    dcgmcm_latest_value_t value {};
+    value.timestamp = entry->usecSince1970;
+    value.tsType    = timeseries->tsType;
+    if (value.tsType == TS_TYPE_DOUBLE)
+    {
+        value.val.d  = entry->val.dbl;
+        value.val2.d = entry->val2.dbl;
+    }
+    else
+    {
+        value.val.i64  = entry->val.i64;
+        value.val2.i64 = entry->val2.i64;
+    }
 
-            nvmlReturn = nvmlDeviceGetPowerManagementLimit(nvmlDevice, &currLimit);
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+    m_latestValues.Publish(watchInfo->watchKey, value);
+    if (m_latestValueSlots && watchInfo->latestValueSlot != DcgmLatestValueSlots::c_noSlot)
+    {
+        m_latestValueSlots->Publish(watchInfo->latestValueSlot, value);
+    }
+    if (m_sharedLatestValues && watchInfo->sharedLatestValueRow != DcgmSharedLatestValues::c_noRow)
+    {
+        m_sharedLatestValues->Publish(watchInfo->sharedLatestValueRow, value);
+    }
+}
 
-            nvmlReturn = nvmlDeviceGetPowerManagementLimitConstraints(nvmlDevice, &minLimit, &maxLimit);
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+/*****************************************************************************/
+unsigned int DcgmCacheManager::ReserveLatestValueSlot(dcgmGroupEntityPair_t const &entity, unsigned short fieldId)
+{
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+    if (!fieldMeta || (fieldMeta->fieldType != DCGM_FT_INT64 && fieldMeta->fieldType != DCGM_FT_DOUBLE))
+    {
+        return DcgmLatestValueSlots::c_noSlot;
+    }
 
-            if (newPowerLimit < minLimit || newPowerLimit > maxLimit)
-            {
-                log_warning("gpuId {}. Power limit {} is outside of range {} < x < {}",
-                            gpuId,
-                            newPowerLimit,
-                            minLimit,
-                            maxLimit);
-                return DCGM_ST_BADPARAM;
-            }
+    dcgm_entity_key_t watchKey {};
+    watchKey.fieldId = fieldMeta->fieldId;
+    if (fieldMeta->scope == DCGM_FS_GLOBAL || entity.entityGroupId == DCGM_FE_NONE)
+    {
+        watchKey.entityGroupId = DCGM_FE_NONE;
+        watchKey.entityId      = 0;
+    }
+    else
+    {
+        watchKey.entityGroupId = entity.entityGroupId;
+        watchKey.entityId      = entity.entityId;
+    }
 
-            nvmlReturn = nvmlDeviceSetPowerManagementLimit(nvmlDevice, newPowerLimit);
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+    unsigned int const slot = m_latestValueSlots->Reserve(watchKey);
+    if (slot == DcgmLatestValueSlots::c_noSlot)
+    {
+        log_warning("Latest value slots are full. Not adding eg {} eid {} fieldId {}",
+                    watchKey.entityGroupId,
+                    watchKey.entityId,
+                    watchKey.fieldId);
+        return slot;
+    }
 
+    /* Watches allocated later pick up their slot in AllocWatchInfo() */
+    dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(
+        (dcgm_field_entity_group_t)watchKey.entityGroupId, watchKey.entityId, watchKey.fieldId, 0);
+    if (watchInfo)
+    {
+        watchInfo->latestValueSlot = slot;
+        PublishLatestValue(watchInfo);
+    }
 
-            if (watchInfo->isWatched)
-            {
-                AppendEntityDouble(&updateCtx, newPowerLimit / 1000, 0, now, expireTime);
-            }
+    return slot;
+}
 
-            break;
-        }
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::OpenLatestValueView(dcgmGroupEntityPair_t const entities[],
+                                                   unsigned int entityCount,
+                                                   unsigned short const fields[],
+                                                   unsigned int fieldCount,
+                                                   dcgmLatestValueView_t &view,
+                                                   unsigned int slots[])
+{
+    if ((entityCount && !entities) || (fieldCount && !fields) || (entityCount && fieldCount && !slots))
+    {
+        return DCGM_ST_BADPARAM;
+    }
 
-        case DCGM_FI_DEV_APP_SM_CLOCK: // Fall-through is intentional
-        case DCGM_FI_DEV_APP_MEM_CLOCK:
-        {
-            /* Special Handling as two different values are set simultaneously in this case */
-            dcgm_field_meta_p fieldMetaSM    = 0;
-            dcgm_field_meta_p fieldMetaMEM   = 0;
-            dcgmcm_watch_info_p watchInfoSM  = 0;
-            dcgmcm_watch_info_p watchInfoMEM = 0;
+    DcgmLockGuard dlg(m_mutex);
 
+    if (!m_latestValueSlots)
+    {
+        m_latestValueSlots = std::make_unique<DcgmLatestValueSlots>();
+    }
 
-            fieldMetaSM = DcgmFieldGetById(DCGM_FI_DEV_APP_SM_CLOCK);
-            if (!fieldMetaSM)
-                return DCGM_ST_UNKNOWN_FIELD;
+    unsigned int slotIndex = 0;
+    for (unsigned int i = 0; i < entityCount; i++)
+    {
+        for (unsigned int j = 0; j < fieldCount; j++, slotIndex++)
+        {
+            slots[slotIndex] = ReserveLatestValueSlot(entities[i], fields[j]);
+        }
+    }
 
-            watchInfoSM = GetEntityWatchInfo(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_APP_SM_CLOCK, 1);
+    view = (dcgmLatestValueView_t)m_latestValueSlots.get();
+    return DCGM_ST_OK;
+}
 
-            fieldMetaMEM = DcgmFieldGetById(DCGM_FI_DEV_APP_MEM_CLOCK);
-            if (!fieldMetaMEM)
-                return DCGM_ST_UNKNOWN_FIELD;
+/*****************************************************************************/
+unsigned int DcgmCacheManager::ReserveSharedLatestValueRow(dcgm_entity_key_t const &watchKey)
+{
+    if (!m_sharedLatestValues || !m_sharedLatestValueFieldIds.test(watchKey.fieldId))
+    {
+        return DcgmSharedLatestValues::c_noRow;
+    }
 
-            watchInfoMEM = GetEntityWatchInfo(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_APP_MEM_CLOCK, 1);
+    unsigned int const row = m_sharedLatestValues->Reserve(watchKey);
+    if (row == DcgmSharedLatestValues::c_noRow)
+    {
+        log_warning("Shared latest values are full. Not adding eg {} eid {} fieldId {}",
+                    watchKey.entityGroupId,
+                    watchKey.entityId,
+                    watchKey.fieldId);
+    }
 
-            /* Both blank means ignore */
-            if (DCGM_INT64_IS_BLANK(value->val.i64) && DCGM_INT64_IS_BLANK(value->val2.i64))
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(NVML_SUCCESS);
+    return row;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::StartSharedLatestValues(std::string const &name,
+                                                       std::vector<unsigned short> const &fieldIds)
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    if (m_sharedLatestValues)
+    {
+        log_error("Shared latest values were already started");
+        return DCGM_ST_IN_USE;
+    }
+
+    std::bitset<DCGM_FI_MAX_FIELDS> sharedFieldIds;
+    for (unsigned short const fieldId : fieldIds)
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (!fieldMeta || (fieldMeta->fieldType != DCGM_FT_INT64 && fieldMeta->fieldType != DCGM_FT_DOUBLE))
+        {
+            log_error("Field ID {} can't be shared. Only numeric fields can", fieldId);
+            return DCGM_ST_BADPARAM;
+        }
+        sharedFieldIds.set(fieldId);
+    }
+
+    dcgmReturn_t ret
+        = DcgmSharedLatestValues::Create(name, DcgmSharedLatestValues::c_defaultCapacity, m_sharedLatestValues);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    m_sharedLatestValueFieldIds = sharedFieldIds;
+
+    /* Watches allocated later get their row in AllocWatchInfo() */
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        watchInfo->sharedLatestValueRow = ReserveSharedLatestValueRow(watchInfo->watchKey);
+        if (watchInfo->sharedLatestValueRow != DcgmSharedLatestValues::c_noRow)
+        {
+            PublishLatestValue(watchInfo);
+        }
+    }
+
+    log_info("Sharing the latest values of {} fields in {}", sharedFieldIds.count(), name);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::UpdateLatestValueExportPlan(dcgmcm_export_plan_t &plan)
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    if (plan.generation == m_watchSetGeneration)
+    {
+        return false;
+    }
+
+    if (!m_latestValueSlots)
+    {
+        m_latestValueSlots = std::make_unique<DcgmLatestValueSlots>();
+    }
+
+    plan.keys.clear();
+    plan.slots.clear();
+
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        if (!watchInfo->isWatched)
+        {
+            continue;
+        }
+
+        dcgm_entity_key_t const &key = watchInfo->watchKey;
+        unsigned int const slot      = ReserveLatestValueSlot(
+            { (dcgm_field_entity_group_t)key.entityGroupId, key.entityId }, key.fieldId);
+        if (slot == DcgmLatestValueSlots::c_noSlot)
+        {
+            /* Not numeric or out of slots */
+            continue;
+        }
+
+        plan.keys.push_back(key);
+        plan.slots.push_back(slot);
+    }
+
+    GetGpuUuidsForSnapshot(plan.gpuUuids);
+    plan.slotTable  = m_latestValueSlots.get();
+    plan.generation = m_watchSetGeneration;
+    return true;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetLatestSample(dcgm_field_entity_group_t entityGroupId,
+                                               dcgm_field_eid_t entityId,
+                                               unsigned short dcgmFieldId,
+                                               dcgmcm_sample_p sample,
+                                               DcgmFvBuffer *fvBuffer)
+{
+    dcgm_field_meta_p fieldMeta = 0;
+    dcgmReturn_t retSt          = DCGM_ST_OK;
+
+    if (!sample && !fvBuffer)
+        return DCGM_ST_BADPARAM;
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta)
+    {
+        if (fvBuffer)
+            fvBuffer->AddInt64Value(entityGroupId, entityId, dcgmFieldId, 0, 0, DCGM_ST_UNKNOWN_FIELD);
+        return DCGM_ST_UNKNOWN_FIELD;
+    }
+
+    /* Numeric values are published outside of m_mutex. Only take the lock if we missed there */
+    if (GetPublishedLatestSample(entityGroupId, entityId, fieldMeta, sample, fvBuffer, retSt))
+        return retSt;
+
+    DcgmLockGuard dlg(m_mutex);
+
+    return GetLatestSampleLocked(entityGroupId, entityId, fieldMeta, sample, fvBuffer);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetLatestSampleLocked(dcgm_field_entity_group_t entityGroupId,
+                                                     dcgm_field_eid_t entityId,
+                                                     dcgm_field_meta_p fieldMeta,
+                                                     dcgmcm_sample_p sample,
+                                                     DcgmFvBuffer *fvBuffer)
+{
+    dcgmReturn_t st;
+    dcgmReturn_t retSt            = DCGM_ST_OK;
+    timeseries_p timeseries       = 0;
+    dcgmcm_watch_info_p watchInfo = 0;
+    unsigned short dcgmFieldId    = fieldMeta->fieldId;
+
+    dcgm_field_entity_group_t watchEntityGroupId = entityGroupId;
+
+    if (fieldMeta->scope == DCGM_FS_GLOBAL && watchEntityGroupId != DCGM_FE_NONE)
+    {
+        DCGM_LOG_DEBUG << "Fixing entityGroupId for global field";
+        watchEntityGroupId = DCGM_FE_NONE;
+    }
+
+    /* Don't need to GetIsValidEntityId(entityGroupId, entityId) here because Get*WatchInfo will
+       return null if there isn't a valid watch */
+
+    if (watchEntityGroupId == DCGM_FE_NONE)
+        watchInfo = GetGlobalWatchInfo(fieldMeta->fieldId, 0);
+    else
+        watchInfo = GetEntityWatchInfo(watchEntityGroupId, entityId, fieldMeta->fieldId, 0);
+
+    st = PrecheckWatchInfoForSamples(watchInfo);
+    if (st != DCGM_ST_OK)
+    {
+        if (fvBuffer)
+            fvBuffer->AddInt64Value(entityGroupId, entityId, dcgmFieldId, 0, 0, st);
+        return st;
+    }
+
+    /* Data type is assumed to be a time series type */
+
+    timeseries = watchInfo->timeSeries;
+    kv_cursor_t cursor;
+    timeseries_entry_p entry = timeseries_last(timeseries, &cursor);
+    if (!entry)
+    {
+        /* No entries in time series. If NVML apis failed, return their error code */
+        if (watchInfo->lastStatus != NVML_SUCCESS)
+            retSt = DcgmNs::Utils::NvmlReturnToDcgmReturn(watchInfo->lastStatus);
+        else if (!watchInfo->isWatched)
+            retSt = DCGM_ST_NOT_WATCHED;
+        else
+            retSt = DCGM_ST_NO_DATA;
+
+        if (fvBuffer)
+            fvBuffer->AddInt64Value(entityGroupId, entityId, dcgmFieldId, 0, 0, retSt);
+        return retSt;
+    }
+
+    /* Got an entry. Convert it to a sample */
+    if (sample)
+    {
+        st    = DcgmcmTimeSeriesEntryToSample(sample, entry, timeseries->tsType);
+        retSt = st;
+    }
+    /* If the user provided a FV buffer, append our sample to it */
+    if (fvBuffer)
+    {
+        st    = DcgmcmWriteTimeSeriesEntryToFvBuffer(
+            entityGroupId, entityId, dcgmFieldId, entry, fvBuffer, timeseries->tsType);
+        retSt = st;
+    }
+
+    return retSt;
+}
+
+/*****************************************************************************/
+std::shared_ptr<dcgmcm_latest_value_plan_t const> DcgmCacheManager::GetLatestValuePlan(
+    std::vector<dcgmGroupEntityPair_t> const &entities,
+    std::vector<unsigned short> const &fieldIds)
+{
+    std::size_t planKey = DcgmNs::HashPackedEntityKey(entities.size());
+    for (auto const &entity : entities)
+    {
+        planKey = DcgmNs::HashPackedEntityKey(planKey ^ DcgmNs::PackEntityKey(entity));
+    }
+    for (unsigned short fieldId : fieldIds)
+    {
+        planKey = DcgmNs::HashPackedEntityKey(planKey ^ fieldId);
+    }
+
+    auto const samePair = [](dcgmGroupEntityPair_t const &a, dcgmGroupEntityPair_t const &b) {
+        return a.entityGroupId == b.entityGroupId && a.entityId == b.entityId;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m_latestValuePlansMutex);
+        auto it = m_latestValuePlans.find(planKey);
+        if (it != m_latestValuePlans.end() && it->second->fieldIds == fieldIds
+            && std::equal(entities.begin(), entities.end(), it->second->entities.begin(), it->second->entities.end(),
+                          samePair))
+        {
+            return it->second;
+        }
+    }
+
+    auto plan      = std::make_shared<dcgmcm_latest_value_plan_t>();
+    plan->entities = entities;
+    plan->fieldIds = fieldIds;
+    plan->slots.reserve(entities.size() * fieldIds.size());
+
+    {
+        DcgmLockGuard dlg(m_mutex);
+
+        if (!m_latestValueSlots)
+        {
+            m_latestValueSlots = std::make_unique<DcgmLatestValueSlots>();
+        }
+        plan->slotTable = m_latestValueSlots.get();
+
+        for (auto const &entity : entities)
+        {
+            for (unsigned short fieldId : fieldIds)
+            {
+                plan->slots.push_back(ReserveLatestValueSlot(entity, fieldId));
             }
-            else if ((value->val.i64 == 0) && (value->val2.i64 == 0))
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_latestValuePlansMutex);
+    if (m_latestValuePlans.size() >= c_maxLatestValuePlans)
+    {
+        m_latestValuePlans.clear();
+    }
+    m_latestValuePlans[planKey] = plan;
+    return plan;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetMultipleLatestSamples(std::vector<dcgmGroupEntityPair_t> &entities,
+                                                        std::vector<unsigned short> &fieldIds,
+                                                        DcgmFvBuffer *fvBuffer)
+{
+    bool haveLock = false;
+
+    if (!fvBuffer)
+        return DCGM_ST_BADPARAM;
+
+    /* Read every pair that has a slot at once, without locking the cache manager */
+    std::shared_ptr<dcgmcm_latest_value_plan_t const> plan = GetLatestValuePlan(entities, fieldIds);
+    std::vector<dcgmLatestValueSample_t> slotSamples(plan->slots.size());
+    plan->slotTable->Read(plan->slots.data(), (unsigned int)plan->slots.size(), slotSamples.data());
+
+    size_t pairIndex = 0;
+    for (auto const &entity : entities)
+    {
+        for (unsigned short fieldId : fieldIds)
+        {
+            dcgmLatestValueSample_t const &slotSample = slotSamples[pairIndex++];
+            dcgmReturn_t ret                          = DCGM_ST_OK;
+
+            if (slotSample.status == DCGM_ST_OK)
             {
-                /* Both 0s means reset application clocks */
-                nvmlReturn = nvmlDeviceResetApplicationsClocks(nvmlDevice);
-                log_debug("nvmlDeviceResetApplicationsClocks() returned {}", (int)nvmlReturn);
-                if (NVML_SUCCESS != nvmlReturn)
+                dcgmBufferedFv_t *fv = nullptr;
+
+                if (slotSample.fieldType == DCGM_FT_DOUBLE)
+                    fv = fvBuffer->AddDoubleValue(entity.entityGroupId,
+                                                  entity.entityId,
+                                                  fieldId,
+                                                  slotSample.value.dbl,
+                                                  slotSample.ts,
+                                                  DCGM_ST_OK);
+                else
+                    fv = fvBuffer->AddInt64Value(entity.entityGroupId,
+                                                 entity.entityId,
+                                                 fieldId,
+                                                 slotSample.value.i64,
+                                                 slotSample.ts,
+                                                 DCGM_ST_OK);
+
+                if (!fv)
                 {
-                    return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+                    log_error("Unexpected NULL fv returned for eg {}, eid {}, fieldId {}. Out of memory?",
+                              entity.entityGroupId,
+                              entity.entityId,
+                              fieldId);
                 }
+                continue;
             }
-            else
+
+            /* No slot or no value in it. Buffer each sample. Errors are written as statuses for each fv in fvBuffer */
+            dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+            if (!fieldMeta)
             {
-                /* Set Memory clock and Proc clock pair via NVML */
-                nvmlReturn = nvmlDeviceSetApplicationsClocks(nvmlDevice, value->val.i64, value->val2.i64);
-                log_debug("nvmlDeviceSetApplicationsClocks({}, {}) returned {}",
-                          value->val.i64,
-                          value->val2.i64,
-                          (int)nvmlReturn);
-                if (NVML_SUCCESS != nvmlReturn)
+                ret = GetLatestSample(entity.entityGroupId, entity.entityId, fieldId, 0, fvBuffer);
+            }
+            else if (!GetPublishedLatestSample(entity.entityGroupId, entity.entityId, fieldMeta, 0, fvBuffer, ret))
+            {
+                /* Lock the cache manager once for the rest of the request on the first miss */
+                if (!haveLock)
                 {
-                    return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+                    dcgm_mutex_lock(m_mutex);
+                    haveLock = true;
                 }
+
+                ret = GetLatestSampleLocked(entity.entityGroupId, entity.entityId, fieldMeta, 0, fvBuffer);
+            }
+
+            if (DCGM_ST_OK != ret)
+            {
+                DCGM_LOG_ERROR << "GetLatestSample returned " << errorString(ret) << " for entityId "
+                               << entity.entityId << " groupId " << entity.entityGroupId << " fieldId " << fieldId;
             }
+        }
+    }
+
+    if (haveLock)
+        dcgm_mutex_unlock(m_mutex);
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SetValue(int gpuId, unsigned short dcgmFieldId, dcgmcm_sample_p value)
+{
+    dcgm_field_meta_p fieldMeta = 0;
+    nvmlReturn_t nvmlReturn;
+    nvmlDevice_t nvmlDevice = 0;
+    timelib64_t now, expireTime;
+    dcgmcm_watch_info_p watchInfo = 0;
+    dcgmcm_update_thread_t updateCtx;
+
+    if (!value)
+        return DCGM_ST_BADPARAM;
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta)
+        return DCGM_ST_UNKNOWN_FIELD;
+
+    if (m_nvmlLoaded == false)
+    {
+        log_error("Cannot set NVML values: NVML isn't loaded.");
+        return DCGM_ST_NVML_NOT_LOADED;
+    }
+
+    memset(&updateCtx, 0, sizeof(updateCtx));
+    ClearThreadCtx(&updateCtx);
+    updateCtx.entityKey.entityGroupId = DCGM_FE_GPU;
+    updateCtx.entityKey.entityId      = gpuId;
+    updateCtx.entityKey.fieldId       = dcgmFieldId;
+
+    if (fieldMeta->scope == DCGM_FS_ENTITY)
+    {
+        watchInfo = GetEntityWatchInfo(DCGM_FE_GPU, GpuIdToNvmlIndex(gpuId), dcgmFieldId, 1);
+    }
+    else
+    {
+        watchInfo = GetGlobalWatchInfo(dcgmFieldId, 1);
+    }
+
+    if (watchInfo == nullptr)
+    {
+        DCGM_LOG_ERROR << "Got watchInfo == null from GetGlobalWatchInfo";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    now = timelib_usecSince1970();
+
+    expireTime = 0;
+    if (watchInfo->maxAgeUsec)
+        expireTime = now - watchInfo->maxAgeUsec;
+
+    /* Is the field watched? If so, cause live updates to occur */
+    if (watchInfo->isWatched)
+        updateCtx.watchInfo = watchInfo;
+
+    /* Do we need a device handle? */
+    if (fieldMeta->scope == DCGM_FS_DEVICE)
+    {
+        nvmlReturn = nvmlDeviceGetHandleByIndex_v2(GpuIdToNvmlIndex(gpuId), &nvmlDevice);
+        if (nvmlReturn != NVML_SUCCESS)
+        {
+            log_error(
+                "nvmlDeviceGetHandleByIndex_v2 returned {} for gpuId {}", (int)nvmlReturn, GpuIdToNvmlIndex(gpuId));
+            return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+        }
+    }
+
+    switch (fieldMeta->fieldId)
+    {
+        case DCGM_FI_DEV_AUTOBOOST:
+        {
+            nvmlEnableState_t enabledState;
+
+            enabledState = value->val.i64 ? NVML_FEATURE_ENABLED : NVML_FEATURE_DISABLED;
+
+            nvmlReturn = nvmlDeviceSetDefaultAutoBoostedClocksEnabled(nvmlDevice, enabledState, 0);
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+            if (watchInfo->isWatched)
+            {
+                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
+            }
+            break;
+        }
+
+        case DCGM_FI_DEV_ENFORCED_POWER_LIMIT: /* Fall through is intentional */
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT:
+        {
+            unsigned int currLimit, minLimit, maxLimit, newPowerLimit;
+
+            newPowerLimit = (unsigned int)(value->val.d * 1000); // convert from W to mW
+
+            nvmlReturn = nvmlDeviceGetPowerManagementLimit(nvmlDevice, &currLimit);
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+            nvmlReturn = nvmlDeviceGetPowerManagementLimitConstraints(nvmlDevice, &minLimit, &maxLimit);
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+            if (newPowerLimit < minLimit || newPowerLimit > maxLimit)
+            {
+                log_warning("gpuId {}. Power limit {} is outside of range {} < x < {}",
+                            gpuId,
+                            newPowerLimit,
+                            minLimit,
+                            maxLimit);
+                return DCGM_ST_BADPARAM;
+            }
+
+            nvmlReturn = nvmlDeviceSetPowerManagementLimit(nvmlDevice, newPowerLimit);
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+
+            if (watchInfo->isWatched)
+            {
+                AppendEntityDouble(&updateCtx, newPowerLimit / 1000, 0, now, expireTime);
+            }
+
+            break;
+        }
+
+        case DCGM_FI_DEV_APP_SM_CLOCK: // Fall-through is intentional
+        case DCGM_FI_DEV_APP_MEM_CLOCK:
+        {
+            /* Special Handling as two different values are set simultaneously in this case */
+            dcgm_field_meta_p fieldMetaSM    = 0;
+            dcgm_field_meta_p fieldMetaMEM   = 0;
+            dcgmcm_watch_info_p watchInfoSM  = 0;
+            dcgmcm_watch_info_p watchInfoMEM = 0;
+
+
+            fieldMetaSM = DcgmFieldGetById(DCGM_FI_DEV_APP_SM_CLOCK);
+            if (!fieldMetaSM)
+                return DCGM_ST_UNKNOWN_FIELD;
+
+            watchInfoSM = GetEntityWatchInfo(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_APP_SM_CLOCK, 1);
+
+            fieldMetaMEM = DcgmFieldGetById(DCGM_FI_DEV_APP_MEM_CLOCK);
+            if (!fieldMetaMEM)
+                return DCGM_ST_UNKNOWN_FIELD;
+
+            watchInfoMEM = GetEntityWatchInfo(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_APP_MEM_CLOCK, 1);
+
+            /* Both blank means ignore */
+            if (DCGM_INT64_IS_BLANK(value->val.i64) && DCGM_INT64_IS_BLANK(value->val2.i64))
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(NVML_SUCCESS);
+            }
+            else if ((value->val.i64 == 0) && (value->val2.i64 == 0))
+            {
+                /* Both 0s means reset application clocks */
+                nvmlReturn = nvmlDeviceResetApplicationsClocks(nvmlDevice);
+                log_debug("nvmlDeviceResetApplicationsClocks() returned {}", (int)nvmlReturn);
+                if (NVML_SUCCESS != nvmlReturn)
+                {
+                    return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+                }
+            }
+            else
+            {
+                /* Set Memory clock and Proc clock pair via NVML */
+                nvmlReturn = nvmlDeviceSetApplicationsClocks(nvmlDevice, value->val.i64, value->val2.i64);
+                log_debug("nvmlDeviceSetApplicationsClocks({}, {}) returned {}",
+                          value->val.i64,
+                          value->val2.i64,
+                          (int)nvmlReturn);
+                if (NVML_SUCCESS != nvmlReturn)
+                {
+                    return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+                }
+            }
+
+            if (watchInfoMEM->isWatched)
+            {
+                updateCtx.watchInfo = watchInfoMEM;
+                updateCtx.entityKey = watchInfoMEM->watchKey;
+                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
+            }
+
+            if (watchInfoSM->isWatched)
+            {
+                updateCtx.watchInfo = watchInfoSM;
+                updateCtx.entityKey = watchInfoSM->watchKey;
+                AppendEntityInt64(&updateCtx, value->val2.i64, 0, now, expireTime);
+            }
+
+            /* Supported clocks are read again after a clock change */
+            m_staticFields.InvalidateGpu(gpuId);
+            break;
+        }
+
+        case DCGM_FI_DEV_ECC_CURRENT: // Fall-through is intentional
+        case DCGM_FI_DEV_ECC_PENDING:
+        {
+            nvmlEnableState_t nvmlState;
+            nvmlState = (value->val.i64 == true) ? NVML_FEATURE_ENABLED : NVML_FEATURE_DISABLED;
+
+            nvmlReturn = nvmlDeviceSetEccMode(nvmlDevice, nvmlState);
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+
+            if (watchInfo->isWatched)
+            {
+                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
+            }
+
+            break;
+        }
+
+
+        case DCGM_FI_DEV_COMPUTE_MODE:
+        {
+            nvmlComputeMode_t computeMode;
+
+            if (value->val.i64 == DCGM_CONFIG_COMPUTEMODE_DEFAULT)
+                computeMode = NVML_COMPUTEMODE_DEFAULT;
+            else if (value->val.i64 == DCGM_CONFIG_COMPUTEMODE_PROHIBITED)
+                computeMode = NVML_COMPUTEMODE_PROHIBITED;
+            else if (value->val.i64 == DCGM_CONFIG_COMPUTEMODE_EXCLUSIVE_PROCESS)
+                computeMode = NVML_COMPUTEMODE_EXCLUSIVE_PROCESS;
+            else
+                return DCGM_ST_BADPARAM;
+
+
+            nvmlReturn = nvmlDeviceSetComputeMode(nvmlDevice, computeMode);
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+            if (watchInfo->isWatched)
+            {
+                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
+            }
+
+            break;
+        }
+
+        case DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK:
+        {
+            bool isBlank = true; // User didn't specify any requested profile
+            bool isEmpty = true; // User specified requested profiles should be blank
+
+            nvmlWorkloadPowerProfileRequestedProfiles_t nvmlProfile = {};
+
+            nvmlProfile.version = nvmlWorkloadPowerProfileRequestedProfiles_v1;
+            memcpy(nvmlProfile.requestedProfilesMask.mask,
+                   value->val.blob,
+                   sizeof(nvmlProfile.requestedProfilesMask.mask));
+
+            for (int i = 0; i < DCGM_POWER_PROFILE_ARRAY_SIZE; i++)
+            {
+                if (!DCGM_INT32_IS_BLANK(nvmlProfile.requestedProfilesMask.mask[i]))
+                {
+                    isBlank = false;
+                }
+
+                if (nvmlProfile.requestedProfilesMask.mask[i] != 0)
+                {
+                    isEmpty = false;
+                }
+            }
+
+            if (isBlank == true)
+            {
+                /* nothing specified, do nothing */
+                break;
+            }
+            else if (isEmpty == true)
+            {
+                memset(nvmlProfile.requestedProfilesMask.mask, 0xff, sizeof(nvmlProfile.requestedProfilesMask.mask));
+                nvmlReturn = nvmlDeviceWorkloadPowerProfileClearRequestedProfiles(nvmlDevice, &nvmlProfile);
+            }
+            else
+            {
+                nvmlReturn = nvmlDeviceWorkloadPowerProfileSetRequestedProfiles(nvmlDevice, &nvmlProfile);
+            }
+
+            if (NVML_SUCCESS != nvmlReturn)
+            {
+                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+            }
+
+            break;
+        }
+
+        default:
+            log_warning("Unimplemented fieldId: {}", (int)fieldMeta->fieldId);
+            return DCGM_ST_GENERIC_ERROR;
+    }
+
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AppendSamples(DcgmFvBuffer *fvBuffer)
+{
+    if (!fvBuffer)
+        return DCGM_ST_BADPARAM;
+
+    size_t bufferSize   = 0;
+    size_t elementCount = 0;
+    fvBuffer->GetSize(&bufferSize, &elementCount);
+    return AppendSamples(fvBuffer->GetBuffer(), bufferSize);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AppendSamples(const char *buffer, size_t bufferSize)
+{
+    if (!buffer && bufferSize > 0)
+        return DCGM_ST_BADPARAM;
+
+    dcgmcm_update_thread_t threadCtx;
+    InitAndClearThreadCtx(&threadCtx);
+
+    /* Lock the mutex for every FV so we only take it once */
+
+    DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+
+    timelib64_t now = timelib_usecSince1970();
+    dcgmBufferedFv_t const *fv;
+    dcgmBufferedFvCursor_t cursor = 0;
+
+    /* Modules usually send several samples of a field in a row. Those are appended to its time series at once */
+    std::vector<timeseries_entry_t> run;
+    dcgmcm_watch_info_t *runWatchInfo = nullptr;
+    unsigned char runFieldType        = 0;
+    timelib64_t runExpireTime         = 0;
+
+    for (fv = DcgmFvBuffer::GetNextFv(buffer, bufferSize, &cursor); fv;
+         fv = DcgmFvBuffer::GetNextFv(buffer, bufferSize, &cursor))
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fv->fieldId);
+        if (!fieldMeta)
+        {
+            log_error("Unknown fieldId {} in fvBuffer", fv->fieldId);
+            continue;
+        }
+
+        dcgmcm_watch_info_t *watchInfo;
+        if (fieldMeta->scope == DCGM_FS_GLOBAL)
+            watchInfo = GetGlobalWatchInfo(fv->fieldId, 1);
+        else
+        {
+            /* This CoreCommunication API is only used by DCGM modules (profiling, nvswitch, etc),
+               If no watchInfo is already created by other methods (fieldgroup, dmon, etc) then
+               don't accept the values being sent by those modules */
+            watchInfo = GetEntityWatchInfo((dcgm_field_entity_group_t)fv->entityGroupId, fv->entityId, fv->fieldId, 0);
+        }
+
+        if (watchInfo == nullptr)
+        {
+            log_warning("Got watchInfo == null from GetEntityWatchInfo");
+            continue;
+        }
+
+        timelib64_t expireTime = 0;
+        if (watchInfo->maxAgeUsec)
+            expireTime = now - watchInfo->maxAgeUsec;
+
+        threadCtx.watchInfo = watchInfo;
+        threadCtx.entityKey = watchInfo->watchKey;
+
+        /* Modules don't report how long their fetches take, so only the fetch is counted */
+        watchInfo->fetchCount++;
+
+        if (runWatchInfo && (watchInfo != runWatchInfo || fv->fieldType != runFieldType))
+        {
+            AppendSampleRun(runWatchInfo, run, runExpireTime);
+            runWatchInfo = nullptr;
+        }
+
+        if (!runWatchInfo && CanAppendSampleRun(watchInfo, fv->fieldType))
+        {
+            runWatchInfo = watchInfo;
+            runFieldType = fv->fieldType;
+        }
+
+        if (runWatchInfo)
+        {
+            timeseries_entry_t entry {};
+            entry.usecSince1970 = fv->timestamp;
+            if (fv->fieldType == DCGM_FT_DOUBLE)
+            {
+                entry.val.dbl = fv->value.dbl;
+            }
+            else
+            {
+                entry.val.i64 = fv->value.i64;
+            }
+            run.push_back(entry);
+            runExpireTime = expireTime;
+            continue;
+        }
+
+        switch (fv->fieldType)
+        {
+            case DCGM_FT_DOUBLE:
+                AppendEntityDouble(&threadCtx, fv->value.dbl, 0.0, fv->timestamp, expireTime);
+                break;
+
+            case DCGM_FT_INT64:
+                AppendEntityInt64(&threadCtx, fv->value.i64, 0, fv->timestamp, expireTime);
+                break;
+
+            case DCGM_FT_STRING:
+                AppendEntityString(&threadCtx, fv->value.str, fv->timestamp, expireTime);
+                break;
+
+            case DCGM_FT_BINARY:
+            {
+                size_t valueSize = (size_t)fv->length - (sizeof(*fv) - sizeof(fv->value));
+                /* AppendEntityBlob() copies the blob without modifying it */
+                AppendEntityBlob(
+                    &threadCtx, const_cast<char *>(fv->value.blob), valueSize, fv->timestamp, expireTime);
+                break;
+            }
+
+            default:
+                log_error("Unknown field type: {}", fv->fieldType);
+                break;
+        }
+    }
+
+    if (runWatchInfo)
+    {
+        AppendSampleRun(runWatchInfo, run, runExpireTime);
+    }
+
+    return DCGM_ST_OK;
+}
+
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AppendSamples(dcgm_field_entity_group_t entityGroupId,
+                                             dcgm_field_eid_t entityId,
+                                             unsigned short dcgmFieldId,
+                                             dcgmcm_sample_p samples,
+                                             int Nsamples)
+{
+    return InjectSamples(entityGroupId, entityId, dcgmFieldId, samples, Nsamples);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::InjectSamples(dcgm_field_entity_group_t entityGroupId,
+                                             dcgm_field_eid_t entityId,
+                                             unsigned short dcgmFieldId,
+                                             dcgmcm_sample_p samples,
+                                             int Nsamples)
+{
+    dcgm_field_meta_p fieldMeta = 0;
+    int sampleIndex;
+    dcgmcm_sample_p currentSample = 0;
+    dcgmcm_watch_info_p watchInfo = 0;
+    timelib64_t now;
+    timelib64_t expireTime;
+    dcgmReturn_t retVal = DCGM_ST_OK;
+
+    dcgmcm_update_thread_t threadCtx;
+    InitAndClearThreadCtx(&threadCtx);
+    threadCtx.fvBuffer = 0;
+
+    if (!dcgmFieldId || !samples || Nsamples < 1)
+        return DCGM_ST_BADPARAM;
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta)
+        return DCGM_ST_GENERIC_ERROR;
+
+    if (fieldMeta->scope == DCGM_FS_GLOBAL)
+    {
+        watchInfo = GetGlobalWatchInfo(dcgmFieldId, 1);
+    }
+    else
+    {
+        /* Note: we can only validate entity types other than switches here, as those are tracked by
+                 the switch module */
+        if (entityGroupId != DCGM_FE_SWITCH && !GetIsValidEntityId(entityGroupId, entityId))
+        {
+            DCGM_LOG_ERROR << "Got fv injection for invalid entityId " << entityId << " in entityGroupId "
+                           << entityGroupId;
+            return DCGM_ST_BADPARAM;
+        }
+
+        watchInfo = GetEntityWatchInfo(entityGroupId, entityId, dcgmFieldId, 1);
+    }
+
+    if (!watchInfo)
+    {
+        log_debug("InjectSamples eg {}, eid {}, fieldId {} got NULL", entityGroupId, entityId, dcgmFieldId);
+        return DCGM_ST_MEMORY;
+    }
+
+    /* If anyone is watching this watchInfo, we need to create a
+       fv buffer for the resulting notifcations */
+    if (watchInfo->hasSubscribedWatchers)
+        threadCtx.fvBuffer = new DcgmFvBuffer();
+
+    threadCtx.watchInfo               = watchInfo;
+    threadCtx.entityKey.entityGroupId = entityGroupId;
+    threadCtx.entityKey.entityId      = entityId;
+    threadCtx.entityKey.fieldId       = fieldMeta->fieldId;
+
+    now        = timelib_usecSince1970();
+    expireTime = 0;
+    if (watchInfo->maxAgeUsec)
+        expireTime = now - watchInfo->maxAgeUsec;
+    /* Update the last queried timestamp to now so that a watch on this field doesn't
+       update every single cycle. After all, we are injecting values. If the injected value
+       is in the future, then this field won't update live until after the injected timestamp
+       Note that we are also updating lastQueriedUsec in the loop below to achieve this. */
+    watchInfo->lastQueriedUsec = now;
+
+    /* A future optimization would be to Lock() + Unlock() around this loop
+     * and inject all samples at once This is fine for now
+     */
+    for (sampleIndex = 0; sampleIndex < Nsamples; sampleIndex++)
+    {
+        currentSample = &samples[sampleIndex];
+
+        /* Use the latest timestamp of the injected samples as the last queried time */
+        watchInfo->lastQueriedUsec = std::max(now, currentSample->timestamp);
+
+        switch (fieldMeta->fieldType)
+        {
+            case DCGM_FT_DOUBLE:
+                AppendEntityDouble(
+                    &threadCtx, currentSample->val.d, currentSample->val2.d, currentSample->timestamp, expireTime);
+                break;
+
+            case DCGM_FT_INT64:
+                AppendEntityInt64(
+                    &threadCtx, currentSample->val.i64, currentSample->val2.i64, currentSample->timestamp, expireTime);
+                break;
+
+            case DCGM_FT_STRING:
+                if (!currentSample->val.str)
+                {
+                    log_error("InjectSamples: Null string at index {} of samples", sampleIndex);
+                    /* Our injected samples before this one will still be in the data
+                     * cache. We can't do anything about this if their timestamp field
+                     * was 0 since it will assign a timestamp we won't know
+                     */
+                    return DCGM_ST_BADPARAM;
+                }
+
+                AppendEntityString(&threadCtx, currentSample->val.str, currentSample->timestamp, expireTime);
+                break;
+
+            case DCGM_FT_BINARY:
+                if (!currentSample->val.blob)
+                {
+                    log_error("InjectSamples: Null blob at index {} of samples", sampleIndex);
+                    /* Our injected samples before this one will still be in the data
+                     * cache. We can't do anything about this if their timestamp field
+                     * was 0 since it will assign a timestamp we won't know
+                     */
+                    return DCGM_ST_BADPARAM;
+                }
+
+                AppendEntityBlob(&threadCtx,
+                                 currentSample->val.blob,
+                                 currentSample->val2.ptrSize,
+                                 currentSample->timestamp,
+                                 expireTime);
+                break;
+
+            default:
+                log_error("InjectSamples: Unhandled field type: {}", fieldMeta->fieldType);
+                return DCGM_ST_BADPARAM;
+        }
+    }
+
+    /* Broadcast any accumulated notifications */
+    if (threadCtx.fvBuffer && threadCtx.affectedSubscribers)
+        UpdateFvSubscribers(&threadCtx);
+
+    FreeThreadCtx(&threadCtx);
+
+    return retVal;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::InjectSamples(DcgmFvBuffer *fvBuffer)
+{
+    if (!fvBuffer)
+        return DCGM_ST_BADPARAM;
+
+    dcgmBufferedFv_t *fv;
+    dcgmBufferedFvCursor_t cursor = 0;
+
+    /* Check the whole batch first. InjectSamples() above leaves the samples before a bad one in the cache */
+    for (fv = fvBuffer->GetNextFv(&cursor); fv; fv = fvBuffer->GetNextFv(&cursor))
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fv->fieldId);
+        if (!fieldMeta)
+        {
+            log_error("InjectSamples: Unknown fieldId {}", fv->fieldId);
+            return DCGM_ST_BADPARAM;
+        }
+
+        if (fv->fieldType != fieldMeta->fieldType)
+        {
+            log_error("InjectSamples: Unexpected fieldType {} != {} expected for fieldId {}",
+                      fv->fieldType,
+                      fieldMeta->fieldType,
+                      fv->fieldId);
+            return DCGM_ST_BADPARAM;
+        }
+
+        /* Switches are tracked by the switch module, so they can't be validated here */
+        if (fieldMeta->scope != DCGM_FS_GLOBAL && fv->entityGroupId != DCGM_FE_SWITCH
+            && !GetIsValidEntityId((dcgm_field_entity_group_t)fv->entityGroupId, fv->entityId))
+        {
+            DCGM_LOG_ERROR << "Got fv injection for invalid entityId " << fv->entityId << " in entityGroupId "
+                           << (int)fv->entityGroupId;
+            return DCGM_ST_BADPARAM;
+        }
+    }
+
+    dcgmcm_update_thread_t threadCtx;
+    InitAndClearThreadCtx(&threadCtx);
+
+    /* Only values of watches with subscribers go in here. threadCtx.fvBuffer points at it for those values */
+    DcgmFvBuffer notifyBuffer;
+    dcgmReturn_t retVal = DCGM_ST_OK;
+    timelib64_t now     = timelib_usecSince1970();
+
+    {
+        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+
+        cursor = 0;
+        for (fv = fvBuffer->GetNextFv(&cursor); fv; fv = fvBuffer->GetNextFv(&cursor))
+        {
+            dcgm_field_entity_group_t entityGroupId = (dcgm_field_entity_group_t)fv->entityGroupId;
+            dcgmcm_watch_info_p watchInfo;
+
+            if (DcgmFieldGetById(fv->fieldId)->scope == DCGM_FS_GLOBAL)
+                watchInfo = GetGlobalWatchInfo(fv->fieldId, 1);
+            else
+                watchInfo = GetEntityWatchInfo(entityGroupId, fv->entityId, fv->fieldId, 1);
+
+            if (!watchInfo)
+            {
+                log_debug("InjectSamples eg {}, eid {}, fieldId {} got NULL", entityGroupId, fv->entityId, fv->fieldId);
+                retVal = DCGM_ST_MEMORY;
+                break;
+            }
+
+            threadCtx.fvBuffer                = watchInfo->hasSubscribedWatchers ? &notifyBuffer : nullptr;
+            threadCtx.watchInfo               = watchInfo;
+            threadCtx.entityKey.entityGroupId = entityGroupId;
+            threadCtx.entityKey.entityId      = fv->entityId;
+            threadCtx.entityKey.fieldId       = fv->fieldId;
+
+            timelib64_t expireTime = 0;
+            if (watchInfo->maxAgeUsec)
+                expireTime = now - watchInfo->maxAgeUsec;
+
+            /* As in InjectSamples() above, keep live updates from overwriting injected values */
+            watchInfo->lastQueriedUsec = std::max(now, (timelib64_t)fv->timestamp);
+
+            switch (fv->fieldType)
+            {
+                case DCGM_FT_DOUBLE:
+                    AppendEntityDouble(&threadCtx, fv->value.dbl, 0.0, fv->timestamp, expireTime);
+                    break;
+
+                case DCGM_FT_INT64:
+                    AppendEntityInt64(&threadCtx, fv->value.i64, 0, fv->timestamp, expireTime);
+                    break;
+
+                case DCGM_FT_STRING:
+                    AppendEntityString(&threadCtx, fv->value.str, fv->timestamp, expireTime);
+                    break;
+
+                case DCGM_FT_BINARY:
+                {
+                    size_t valueSize = (size_t)fv->length - (sizeof(*fv) - sizeof(fv->value));
+                    AppendEntityBlob(&threadCtx, fv->value.blob, valueSize, fv->timestamp, expireTime);
+                    break;
+                }
+
+                default:
+                    log_error("InjectSamples: Unhandled field type: {}", fv->fieldType);
+                    break;
+            }
+        }
+    }
+
+    /* Broadcast the whole batch at once, outside of the lock */
+    threadCtx.fvBuffer = &notifyBuffer;
+    if (threadCtx.affectedSubscribers)
+        UpdateFvSubscribers(&threadCtx);
+
+    threadCtx.fvBuffer = nullptr;
+    FreeThreadCtx(&threadCtx);
+
+    return retVal;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::FreeSamples(dcgmcm_sample_p samples, int Nsamples, unsigned short dcgmFieldId)
+{
+    dcgm_field_meta_p fieldMeta = 0;
+    int sampleIndex;
+    dcgmcm_sample_p currentSample = 0;
+
+    if (!dcgmFieldId || !samples || Nsamples < 1)
+        return DCGM_ST_BADPARAM;
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta)
+        return DCGM_ST_GENERIC_ERROR;
+
+    /* Only strings/binary need their values freed. */
+    if ((DCGM_FT_STRING != fieldMeta->fieldType) && (DCGM_FT_BINARY != fieldMeta->fieldType))
+    {
+        return DCGM_ST_OK;
+    }
+
+    for (sampleIndex = 0; sampleIndex < Nsamples; sampleIndex++)
+    {
+        currentSample = &samples[sampleIndex];
+
+        if (fieldMeta->fieldType == DCGM_FT_STRING)
+        {
+            if (currentSample->val.str)
+            {
+                free(currentSample->val.str);
+                currentSample->val.str      = 0;
+                currentSample->val2.ptrSize = 0;
+            }
+        }
+
+        if (fieldMeta->fieldType == DCGM_FT_BINARY)
+        {
+            if (currentSample->val.blob)
+            {
+                free(currentSample->val.blob);
+                currentSample->val.blob     = 0;
+                currentSample->val2.ptrSize = 0;
+            }
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::FreeThreadCtx(dcgmcm_update_thread_t *threadCtx)
+{
+    if (!threadCtx)
+        return;
+
+    ClearThreadCtx(threadCtx);
+
+    if (threadCtx->fvBuffer)
+        delete threadCtx->fvBuffer;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::InitAndClearThreadCtx(dcgmcm_update_thread_t *threadCtx)
+{
+    if (!threadCtx)
+        return;
+
+    threadCtx->fvBuffer = NULL;
+
+    ClearThreadCtx(threadCtx);
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::QueueGpuFieldValue(dcgmcm_update_thread_t *threadCtx,
+                                          unsigned int gpuId,
+                                          dcgmcm_field_value_plan_entry_t const &entry)
+{
+    auto &fieldValues = threadCtx->fieldValues[gpuId];
+    if (fieldValues.empty())
+    {
+        threadCtx->fieldValueGpuIds.push_back(gpuId);
+    }
+    fieldValues.push_back(entry);
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::ClearThreadCtx(dcgmcm_update_thread_t *threadCtx)
+{
+    if (!threadCtx)
+        return;
+
+    /* Only the GPUs that had field values queued. clear() keeps the capacity for the next cycle */
+    for (unsigned int gpuId : threadCtx->fieldValueGpuIds)
+    {
+        threadCtx->fieldValues[gpuId].clear();
+    }
+    threadCtx->fieldValueGpuIds.clear();
+    /* MIG memory info is read again in the next cycle */
+    memset(threadCtx->migFbMemoryRead, 0, sizeof(threadCtx->migFbMemoryRead));
+    memset(threadCtx->migBar1MemoryRead, 0, sizeof(threadCtx->migBar1MemoryRead));
+
+    threadCtx->watchInfo = 0;
+    if (threadCtx->fvBuffer)
+        threadCtx->fvBuffer->Clear();
+    threadCtx->affectedSubscribers = 0;
+    threadCtx->clock.Stop();
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::UpdateFvSubscribers(dcgmcm_update_thread_t *updateCtx)
+{
+    int numWatcherTypes = 0;
+    unsigned int i;
+    DcgmWatcherType_t watchers[DcgmWatcherTypeCount];
+
+    if (!updateCtx->fvBuffer || !updateCtx->affectedSubscribers)
+        return DCGM_ST_OK; /* Nothing to do */
+
+    /* Ok. We've got FVs and subscribers. Let's build the list */
+    for (i = 0; i < DcgmWatcherTypeCount; i++)
+    {
+        if (updateCtx->affectedSubscribers & (1 << i))
+        {
+            watchers[numWatcherTypes] = (DcgmWatcherType_t)i;
+            numWatcherTypes++;
+        }
+    }
+
+    /* Locking the cache manager for now to protect m_subscriptions
+       We can reevaluate this later if there are deadlock issues. Technically,
+       we only modify this structure on start-up when we're single threaded. */
+    dcgmMutexReturn_t mutexSt = dcgm_mutex_lock_me(m_mutex);
+
+    std::vector<dcgmcmEventSubscription_t> localCopy(begin(m_subscriptions[DcgmcmEventTypeFvUpdate]),
+                                                     end(m_subscriptions[DcgmcmEventTypeFvUpdate]));
+
+    if (mutexSt != DCGM_MUTEX_ST_LOCKEDBYME)
+        dcgm_mutex_unlock(m_mutex);
+
+    for (auto &&entry : localCopy)
+    {
+        DcgmNs::Trace::Scope traceScope("FvSubscriberCallback", "numWatcherTypes", numWatcherTypes);
+        entry.fn.fvCb(updateCtx->fvBuffer, watchers, numWatcherTypes, entry.userData);
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SubscribeForEvent(const dcgmcmEventSubscription_t &eventSub)
+{
+    switch (eventSub.type)
+    {
+        case DcgmcmEventTypeFvUpdate:
+        {
+            if (eventSub.fn.fvCb == nullptr)
+            {
+                DCGM_LOG_DEBUG << "Cannot subscribe to field value updates using a null callback function";
+                return DCGM_ST_BADPARAM;
+            }
+            break;
+        }
+
+        case DcgmcmEventTypeMigReconfigure:
+        {
+            if (eventSub.fn.migCb == nullptr)
+            {
+                DCGM_LOG_DEBUG << "Cannot subscribe to mig reconfigure updates using a null callback function";
+                return DCGM_ST_BADPARAM;
+            }
+            break;
+        }
+
+        default:
+        {
+            DCGM_LOG_DEBUG << "Cannot process cache manager event type " << eventSub.type;
+            return DCGM_ST_BADPARAM;
+        }
+    }
+
+
+    dcgm_mutex_lock(m_mutex);
+    m_subscriptions[eventSub.type].push_back(eventSub);
+    dcgm_mutex_unlock(m_mutex);
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::MarkEnteredDriver()
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    // Make sure we aren't waiting to detach from the GPUs
+    WaitForDriverToBeReady();
+
+    m_inDriverCount++;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::MarkReturnedFromDriver()
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    m_inDriverCount--;
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::IsModulePushedFieldId(unsigned int fieldId)
+{
+    if (fieldId < DCGM_FI_FIRST_NVSWITCH_FIELD_ID || DcgmDerivedFields::GetDef(fieldId) != nullptr)
+    {
+        return false;
+    }
+
+    switch (fieldId)
+    {
+        case DCGM_FI_DEV_NVLINK_COUNT_TX_PACKETS:
+        case DCGM_FI_DEV_NVLINK_COUNT_TX_BYTES:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_PACKETS:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_BYTES:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_MALFORMED_PACKET_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_BUFFER_OVERRUN_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_REMOTE_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_GENERAL_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_LOCAL_LINK_INTEGRITY_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_TX_DISCARDS:
+        case DCGM_FI_DEV_NVLINK_COUNT_LINK_RECOVERY_SUCCESSFUL_EVENTS:
+        case DCGM_FI_DEV_NVLINK_COUNT_LINK_RECOVERY_FAILED_EVENTS:
+        case DCGM_FI_DEV_NVLINK_COUNT_LINK_RECOVERY_EVENTS:
+        case DCGM_FI_DEV_NVLINK_COUNT_RX_SYMBOL_ERRORS:
+        case DCGM_FI_DEV_NVLINK_COUNT_SYMBOL_BER:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ActuallyUpdateAllFields(dcgmcm_update_thread_t *threadCtx,
+                                                       timelib64_t *earliestNextUpdate,
+                                                       unsigned int updateShard)
+{
+    timelib64_t now;
+    dcgmMutexReturn_t mutexReturn; /* Tracks the state of the cache manager mutex */
+    int anyFieldValues = 0;        /* Have we queued any field values to be fetched from nvml? */
+
+    mutexReturn = m_mutex->Poll();
+    if (mutexReturn != DCGM_MUTEX_ST_LOCKEDBYME)
+    {
+        log_error("Entered ActuallyUpdateAllFields() without the lock st {}", (int)mutexReturn);
+        return DCGM_ST_GENERIC_ERROR; /* We need the lock in here */
+    }
+
+    DcgmNs::Trace::Scope traceScope("ActuallyUpdateAllFields", "updateShard", updateShard);
+
+    ClearThreadCtx(threadCtx);
+
+    *earliestNextUpdate = 0;
+    now                 = threadCtx->clock.StartCycle();
+
+    if (m_deadlineScheduler)
+    {
+        UpdateScheduledWatches(threadCtx, now, earliestNextUpdate, updateShard, anyFieldValues);
+    }
+    else
+    {
+        WalkAndUpdateWatches(threadCtx, now, earliestNextUpdate, updateShard, anyFieldValues);
+    }
+
+    if (!anyFieldValues)
+        return DCGM_ST_OK;
+
+    UpdateQueuedGpuFieldValues(threadCtx);
+    return DCGM_ST_OK;
+}
 
-            if (watchInfoMEM->isWatched)
-            {
-                updateCtx.watchInfo = watchInfoMEM;
-                updateCtx.entityKey = watchInfoMEM->watchKey;
-                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
-            }
+/*****************************************************************************/
+void DcgmCacheManager::ActuallyUpdateWatches(dcgmcm_update_thread_t *threadCtx,
+                                             std::vector<dcgmcm_watch_info_p> const &watches,
+                                             timelib64_t fixedTimestamp)
+{
+    int anyFieldValues             = 0;
+    timelib64_t earliestNextUpdate = 0;
 
-            if (watchInfoSM->isWatched)
-            {
-                updateCtx.watchInfo = watchInfoSM;
-                updateCtx.entityKey = watchInfoSM->watchKey;
-                AppendEntityInt64(&updateCtx, value->val2.i64, 0, now, expireTime);
-            }
+    DcgmNs::Trace::Scope traceScope("ActuallyUpdateWatches", "numWatches", watches.size());
 
-            break;
+    ClearThreadCtx(threadCtx);
+
+    timelib64_t now = 0;
+    if (fixedTimestamp != 0)
+    {
+        threadCtx->clock.StartFixedCycle(fixedTimestamp);
+        now = fixedTimestamp;
+    }
+    else
+    {
+        now = threadCtx->clock.StartCycle();
+    }
+
+    for (dcgmcm_watch_info_p watchInfo : watches)
+    {
+        /* The watch could have been removed while the mutex was dropped for a driver call */
+        if (!watchInfo->isWatched || watchInfo->pushedByModule)
+        {
+            continue;
         }
 
-        case DCGM_FI_DEV_ECC_CURRENT: // Fall-through is intentional
-        case DCGM_FI_DEV_ECC_PENDING:
+        UpdateWatchIfDue(threadCtx, watchInfo, now, &earliestNextUpdate, anyFieldValues, true);
+    }
+
+    if (anyFieldValues)
+    {
+        UpdateQueuedGpuFieldValues(threadCtx);
+    }
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::UpdateQueuedGpuFieldValues(dcgmcm_update_thread_t *threadCtx)
+{
+    /* Unlock the mutex before the driver call */
+    bool const relock = m_mutex->Poll() == DCGM_MUTEX_ST_LOCKEDBYME;
+    if (relock)
+    {
+        dcgm_mutex_unlock(m_mutex);
+    }
+
+    for (unsigned int gpuId : threadCtx->fieldValueGpuIds)
+    {
+        std::size_t const numFieldValues = threadCtx->fieldValues[gpuId].size();
+
+        log_debug("Got {} field value fields for gpuId {}", numFieldValues, gpuId);
+
+        DcgmNs::Trace::Scope gpuTraceScope("UpdateGpuFieldValues", "gpuId", gpuId, "numFieldValues", numFieldValues);
+
+        MarkEnteredDriver();
+        timelib64_t const callStart = timelib_usecSince1970();
+        ActuallyUpdateGpuFieldValues(threadCtx, gpuId);
+        RecordGpuDriverCall(gpuId, timelib_usecSince1970() - callStart);
+        MarkReturnedFromDriver();
+    }
+
+    /* relock the mutex if we need to */
+    if (relock)
+        dcgm_mutex_lock(m_mutex);
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::WalkAndUpdateWatches(dcgmcm_update_thread_t *threadCtx,
+                                            timelib64_t &now,
+                                            timelib64_t *earliestNextUpdate,
+                                            unsigned int updateShard,
+                                            int &anyFieldValues)
+{
+
+    if (m_fieldValuePlanGeneration != m_watchSetGeneration)
+    {
+        BuildFieldValuePlan();
+    }
+
+    /* Queue the field-value-backed watches first. They are all fetched below with one
+       nvmlDeviceGetFieldValues() call per GPU */
+    if (QueueDueFieldValuePlanWatches(threadCtx, now, earliestNextUpdate, updateShard))
+    {
+        anyFieldValues = 1;
+    }
+
+    /* Collect the watches to update before updating any of them. UpdateWatchIfDue() drops the mutex around
+       driver calls, and a watch added meanwhile can make the watch table grow under an iterator. Watch objects
+       themselves are never freed while the cache manager runs */
+    threadCtx->walkWatches.clear();
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        if (!watchInfo->isWatched)
+            continue; /* Not watched */
+
+        /* Already handled by QueueDueFieldValuePlanWatches() */
+        if (watchInfo->inFieldValuePlan)
         {
-            nvmlEnableState_t nvmlState;
-            nvmlState = (value->val.i64 == true) ? NVML_FEATURE_ENABLED : NVML_FEATURE_DISABLED;
+            continue;
+        }
 
-            nvmlReturn = nvmlDeviceSetEccMode(nvmlDevice, nvmlState);
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+        /* Some fields or entities are pushed by modules. Don't handle those fields here
+           Examples are prof fields for non-GPM GPUs and any NvSwitch fields */
+        if (watchInfo->pushedByModule)
+        {
+            continue;
+        }
 
+        /* Leave watches that belong to another shard to that shard's update worker */
+        if (updateShard != DCGM_CM_UPDATE_SHARD_ALL && GetWatchUpdateShard(watchInfo) != updateShard)
+        {
+            continue;
+        }
 
-            if (watchInfo->isWatched)
-            {
-                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
-            }
+        threadCtx->walkWatches.push_back(watchInfo);
+    }
 
-            break;
+    for (dcgmcm_watch_info_p watchInfo : threadCtx->walkWatches)
+    {
+        /* The watch could have been removed while the mutex was dropped for a driver call */
+        if (!watchInfo->isWatched || watchInfo->pushedByModule)
+        {
+            continue;
         }
 
+        UpdateWatchIfDue(threadCtx, watchInfo, now, earliestNextUpdate, anyFieldValues);
+    }
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::UpdateScheduledWatches(dcgmcm_update_thread_t *threadCtx,
+                                              timelib64_t &now,
+                                              timelib64_t *earliestNextUpdate,
+                                              unsigned int updateShard,
+                                              int &anyFieldValues)
+{
+    /* Each shard is only ever updated by one thread at a time, so its schedule can be
+       used across the unlocked driver calls in UpdateWatchIfDue() */
+    dcgmcm_watch_schedule_t &schedule = m_watchSchedules[updateShard];
+
+    if (schedule.generation != m_watchSetGeneration)
+    {
+        BuildWatchSchedule(schedule, updateShard);
+    }
 
-        case DCGM_FI_DEV_COMPUTE_MODE:
+    schedule.dueWatches.clear();
+    schedule.scheduler.PopDue(now + m_updateSlackUsec, schedule.dueWatches);
+
+    for (dcgmcm_watch_info_p watchInfo : schedule.dueWatches)
+    {
+        /* Unwatched watches drop out of the schedule here. Rewatching them rebuilds it */
+        if (!watchInfo->isWatched || watchInfo->pushedByModule)
         {
-            nvmlComputeMode_t computeMode;
+            continue;
+        }
 
-            if (value->val.i64 == DCGM_CONFIG_COMPUTEMODE_DEFAULT)
-                computeMode = NVML_COMPUTEMODE_DEFAULT;
-            else if (value->val.i64 == DCGM_CONFIG_COMPUTEMODE_PROHIBITED)
-                computeMode = NVML_COMPUTEMODE_PROHIBITED;
-            else if (value->val.i64 == DCGM_CONFIG_COMPUTEMODE_EXCLUSIVE_PROCESS)
-                computeMode = NVML_COMPUTEMODE_EXCLUSIVE_PROCESS;
-            else
-                return DCGM_ST_BADPARAM;
+        timelib64_t nextUpdate = UpdateWatchIfDue(threadCtx, watchInfo, now, earliestNextUpdate, anyFieldValues);
+        schedule.scheduler.Schedule(nextUpdate, watchInfo);
+    }
 
+    timelib64_t earliestDue = schedule.scheduler.GetEarliestDue();
+    if (earliestDue && (!(*earliestNextUpdate) || earliestDue < (*earliestNextUpdate)))
+    {
+        *earliestNextUpdate = earliestDue;
+    }
+}
 
-            nvmlReturn = nvmlDeviceSetComputeMode(nvmlDevice, computeMode);
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+/*****************************************************************************/
+void DcgmCacheManager::BuildWatchSchedule(dcgmcm_watch_schedule_t &schedule, unsigned int updateShard)
+{
+    schedule.scheduler.Clear();
 
-            if (watchInfo->isWatched)
-            {
-                AppendEntityInt64(&updateCtx, value->val.i64, 0, now, expireTime);
-            }
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        if (!watchInfo->isWatched || watchInfo->pushedByModule)
+        {
+            continue;
+        }
 
-            break;
+        if (updateShard != DCGM_CM_UPDATE_SHARD_ALL && GetWatchUpdateShard(watchInfo) != updateShard)
+        {
+            continue;
         }
 
-        case DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK:
+        /* Watches that have never been updated are due immediately */
+        schedule.scheduler.Schedule(watchInfo->lastQueriedUsec + watchInfo->monitorIntervalUsec, watchInfo);
+    }
+
+    schedule.generation = m_watchSetGeneration;
+
+    log_debug("Built watch schedule for shard {} with {} watches", updateShard, schedule.scheduler.GetSize());
+}
+
+/*****************************************************************************/
+timelib64_t DcgmCacheManager::UpdateWatchIfDue(dcgmcm_update_thread_t *threadCtx,
+                                               dcgmcm_watch_info_p watchInfo,
+                                               timelib64_t &now,
+                                               timelib64_t *earliestNextUpdate,
+                                               int &anyFieldValues,
+                                               bool force)
+{
+    timelib64_t newNow, age, nextUpdate;
+    dcgmMutexReturn_t mutexReturn; /* Tracks the state of the cache manager mutex */
+    dcgm_field_meta_p fieldMeta = 0;
+
+    /* Last sample time old enough to take another? */
+    age = now - watchInfo->lastQueriedUsec;
+    if (!force && age + m_updateSlackUsec < watchInfo->monitorIntervalUsec)
+    {
+        nextUpdate = watchInfo->lastQueriedUsec + watchInfo->monitorIntervalUsec;
+        if (!(*earliestNextUpdate) || nextUpdate < (*earliestNextUpdate))
         {
-            bool isBlank = true; // User didn't specify any requested profile
-            bool isEmpty = true; // User specified requested profiles should be blank
+            *earliestNextUpdate = nextUpdate;
+        }
+        return nextUpdate; /* Not old enough to update */
+    }
 
-            nvmlWorkloadPowerProfileRequestedProfiles_t nvmlProfile = {};
+    /* Base when we sync again on before the driver call so we don't continuously
+     * get behind by how long the driver call took
+     */
+    nextUpdate = now + watchInfo->monitorIntervalUsec;
 
-            nvmlProfile.version = nvmlWorkloadPowerProfileRequestedProfiles_v1;
-            memcpy(nvmlProfile.requestedProfilesMask.mask,
-                   value->val.blob,
-                   sizeof(nvmlProfile.requestedProfilesMask.mask));
+    fieldMeta = DcgmFieldGetById(watchInfo->watchKey.fieldId);
+    if (!fieldMeta)
+    {
+        log_error("Unexpected null fieldMeta for field {}", watchInfo->watchKey.fieldId);
+        return nextUpdate;
+    }
 
-            for (int i = 0; i < DCGM_POWER_PROFILE_ARRAY_SIZE; i++)
-            {
-                if (!DCGM_INT32_IS_BLANK(nvmlProfile.requestedProfilesMask.mask[i]))
-                {
-                    isBlank = false;
-                }
+    log_debug("Preparing to update watchInfo {}, eg {}, eid {}, fieldId {}",
+              (void *)watchInfo,
+              watchInfo->watchKey.entityGroupId,
+              watchInfo->watchKey.entityId,
+              watchInfo->watchKey.fieldId);
 
-                if (nvmlProfile.requestedProfilesMask.mask[i] != 0)
-                {
-                    isEmpty = false;
-                }
-            }
+    if (watchInfo->practicalEntityGroupId == DCGM_FE_GPU)
+    {
+        /*
+         * Don't cache GPU fields if the GPU is not available. Lost GPUs have blank
+         * field values inserted later.
+         */
+        DcgmEntityStatus_t gpuStatus = GetGpuStatus(watchInfo->practicalEntityId);
+        if (gpuStatus != DcgmEntityStatusOk && gpuStatus != DcgmEntityStatusLost)
+        {
+            log_debug("Skipping gpuId {} in status {}", watchInfo->practicalEntityId, gpuStatus);
+            return nextUpdate;
+        }
+    }
 
-            if (isBlank == true)
-            {
-                /* nothing specified, do nothing */
-                break;
-            }
-            else if (isEmpty == true)
-            {
-                memset(nvmlProfile.requestedProfilesMask.mask, 0xff, sizeof(nvmlProfile.requestedProfilesMask.mask));
-                nvmlReturn = nvmlDeviceWorkloadPowerProfileClearRequestedProfiles(nvmlDevice, &nvmlProfile);
-            }
-            else
-            {
-                nvmlReturn = nvmlDeviceWorkloadPowerProfileSetRequestedProfiles(nvmlDevice, &nvmlProfile);
-            }
+    unsigned int const watchGpuId = m_breakerTimeoutUsec ? GetWatchGpuId(watchInfo) : DCGM_GPU_ID_BAD;
+    if (SkipQuarantinedGpu(watchGpuId, now))
+    {
+        log_debug("Skipping quarantined gpuId {}", watchGpuId);
+        return nextUpdate;
+    }
 
-            if (NVML_SUCCESS != nvmlReturn)
-            {
-                return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-            }
+    if (!(*earliestNextUpdate) || nextUpdate < (*earliestNextUpdate))
+    {
+        *earliestNextUpdate = nextUpdate;
+    }
 
-            break;
+    if (!force && SkipUnchangedMemoryErrorWatch(watchInfo, now))
+    {
+        return nextUpdate;
+    }
+
+    /* Set key information before we call child functions */
+    threadCtx->entityKey.entityGroupId = watchInfo->practicalEntityGroupId;
+    threadCtx->entityKey.entityId      = watchInfo->practicalEntityId;
+    threadCtx->entityKey.fieldId       = watchInfo->watchKey.fieldId;
+    threadCtx->watchInfo               = watchInfo;
+
+    DcgmNs::Trace::Scope traceScope(
+        "UpdateWatch", "entityId", watchInfo->practicalEntityId, "fieldId", watchInfo->watchKey.fieldId);
+
+    MarkEnteredDriver();
+
+    unsigned int scopeId            = 0;
+    unsigned int batchedNvmlFieldId = 0;
+    if (watchInfo->practicalEntityGroupId == DCGM_FE_GPU)
+    {
+        /* Only GPUs are read through the per-GPU batch. See BuildFieldValuePlan() */
+        batchedNvmlFieldId = GetBatchedNvmlFieldId(watchInfo->practicalEntityId, fieldMeta, scopeId);
+    }
+
+    /* Unlock the mutex before the driver call, unless we're just buffering a list of field values */
+    mutexReturn = m_mutex->Poll();
+    if ((watchInfo->practicalEntityGroupId != DCGM_FE_GPU || !batchedNvmlFieldId)
+        && mutexReturn == DCGM_MUTEX_ST_LOCKEDBYME)
+    {
+        dcgm_mutex_unlock(m_mutex);
+        mutexReturn = DCGM_MUTEX_ST_NOTLOCKED;
+    }
+
+    if (watchInfo->practicalEntityGroupId == DCGM_FE_NONE)
+        BufferOrCacheLatestGpuValue(threadCtx, fieldMeta);
+    else if (watchInfo->practicalEntityGroupId == DCGM_FE_GPU || watchInfo->practicalEntityGroupId == DCGM_FE_GPU_CI
+             || watchInfo->practicalEntityGroupId == DCGM_FE_GPU_I)
+    {
+        /* Is this a mapped field? Set aside the info for the field and handle it below. This only
+           happens for watches that were added since the field value plan was last built */
+        if (batchedNvmlFieldId)
+        {
+            QueueGpuFieldValue(
+                threadCtx, watchInfo->practicalEntityId, { watchInfo, fieldMeta, batchedNvmlFieldId, scopeId });
+            anyFieldValues = 1;
+            MarkReturnedFromDriver();
+            return nextUpdate;
         }
 
-        default:
-            log_warning("Unimplemented fieldId: {}", (int)fieldMeta->fieldId);
-            return DCGM_ST_GENERIC_ERROR;
+        BufferOrCacheLatestGpuValue(threadCtx, fieldMeta);
+    }
+    else if (watchInfo->practicalEntityGroupId == DCGM_FE_VGPU)
+    {
+        if (m_skipDriverCalls)
+        {
+            InsertNvmlErrorValue(threadCtx, fieldMeta->fieldType, NVML_ERROR_UNKNOWN, watchInfo->maxAgeUsec);
+            log_error(
+                "Cannot retrieve value for fieldId {} due to detected driver timeout error; inserting blank value instead.",
+                fieldMeta->fieldId);
+        }
+        else
+        {
+            BufferOrCacheLatestVgpuValue(*this, threadCtx, watchInfo->practicalEntityId, fieldMeta);
+        }
     }
+    else
+        log_debug("Unhandled entityGroupId {}", watchInfo->practicalEntityGroupId);
+    /* Resync clock after a value fetch since a driver call may take a while */
+    newNow = threadCtx->clock.Now();
 
+    RecordGpuDriverCall(watchGpuId, newNow - now);
 
-    return DCGM_ST_OK;
+    // accumulate the time spent retrieving this field
+    watchInfo->execTimeUsec += newNow - now;
+    watchInfo->maxExecTimeUsec = std::max(watchInfo->maxExecTimeUsec, newNow - now);
+    watchInfo->fetchCount += 1;
+    now = newNow;
+
+    /* Relock the mutex if we need to */
+    if (mutexReturn == DCGM_MUTEX_ST_NOTLOCKED)
+        mutexReturn = dcgm_mutex_lock(m_mutex);
+
+    MarkReturnedFromDriver();
+
+    return nextUpdate;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AppendSamples(DcgmFvBuffer *fvBuffer)
+void DcgmCacheManager::BuildFieldValuePlan()
 {
-    if (!fvBuffer)
-        return DCGM_ST_BADPARAM;
-
-    dcgmcm_update_thread_t threadCtx;
-    InitAndClearThreadCtx(&threadCtx);
+    unsigned int numPlanned = 0;
 
-    /* Lock the mutex for every FV so we only take it once */
+    for (auto &plan : m_fieldValuePlan)
+    {
+        plan.clear();
+    }
 
-    DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        watchInfo->inFieldValuePlan = false;
 
-    timelib64_t now = timelib_usecSince1970();
-    dcgmBufferedFv_t *fv;
-    dcgmBufferedFvCursor_t cursor = 0;
+        if (!watchInfo->isWatched || watchInfo->pushedByModule)
+        {
+            continue;
+        }
 
-    for (fv = fvBuffer->GetNextFv(&cursor); fv; fv = fvBuffer->GetNextFv(&cursor))
-    {
-        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fv->fieldId);
-        if (!fieldMeta)
+        /* The plan is indexed by gpuId. The practicalEntityId of a GPU or compute instance watch is the ID of
+           the instance, and nvmlDeviceGetFieldValues() can't read an instance anyway */
+        if (watchInfo->practicalEntityGroupId != DCGM_FE_GPU)
         {
-            log_error("Unknown fieldId {} in fvBuffer", fv->fieldId);
             continue;
         }
 
-        dcgmcm_watch_info_t *watchInfo;
-        if (fieldMeta->scope == DCGM_FS_GLOBAL)
-            watchInfo = GetGlobalWatchInfo(fv->fieldId, 1);
-        else
+        if (watchInfo->practicalEntityId >= DCGM_MAX_NUM_DEVICES)
         {
-            /* This CoreCommunication API is only used by DCGM modules (profiling, nvswitch, etc),
-               If no watchInfo is already created by other methods (fieldgroup, dmon, etc) then
-               don't accept the values being sent by those modules */
-            watchInfo = GetEntityWatchInfo((dcgm_field_entity_group_t)fv->entityGroupId, fv->entityId, fv->fieldId, 0);
+            continue;
         }
 
-        if (watchInfo == nullptr)
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(watchInfo->watchKey.fieldId);
+        unsigned int scopeId        = 0;
+        unsigned int nvmlFieldId    = GetBatchedNvmlFieldId(watchInfo->practicalEntityId, fieldMeta, scopeId);
+        if (!nvmlFieldId)
         {
-            log_warning("Got watchInfo == null from GetEntityWatchInfo");
             continue;
         }
 
-        timelib64_t expireTime = 0;
-        if (watchInfo->maxAgeUsec)
-            expireTime = now - watchInfo->maxAgeUsec;
+        auto &plan = m_fieldValuePlan[watchInfo->practicalEntityId];
+        if (plan.size() + 1 >= NVML_FI_MAX)
+        {
+            /* ActuallyUpdateGpuFieldValues() can't take any more. Leave it to the walk of the watch table */
+            continue;
+        }
 
-        threadCtx.watchInfo = watchInfo;
-        threadCtx.entityKey = watchInfo->watchKey;
+        plan.push_back({ watchInfo, fieldMeta, nvmlFieldId, scopeId });
+        watchInfo->inFieldValuePlan = true;
+        numPlanned++;
+    }
 
-        switch (fv->fieldType)
+    m_fieldValuePlanGeneration = m_watchSetGeneration;
+
+    log_debug("Built field value plan with {} watches", numPlanned);
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::QueueDueFieldValuePlanWatches(dcgmcm_update_thread_t *threadCtx,
+                                                     timelib64_t now,
+                                                     timelib64_t *earliestNextUpdate,
+                                                     unsigned int updateShard)
+{
+    bool anyQueued = false;
+
+    for (unsigned int gpuId = 0; gpuId < DCGM_MAX_NUM_DEVICES; gpuId++)
+    {
+        for (auto const &entry : m_fieldValuePlan[gpuId])
         {
-            case DCGM_FT_DOUBLE:
-                AppendEntityDouble(&threadCtx, fv->value.dbl, 0.0, fv->timestamp, expireTime);
-                break;
+            dcgmcm_watch_info_p watchInfo = entry.watchInfo;
 
-            case DCGM_FT_INT64:
-                AppendEntityInt64(&threadCtx, fv->value.i64, 0, fv->timestamp, expireTime);
-                break;
+            if (updateShard != DCGM_CM_UPDATE_SHARD_ALL && GetWatchUpdateShard(watchInfo) != updateShard)
+            {
+                continue;
+            }
 
-            case DCGM_FT_STRING:
-                AppendEntityString(&threadCtx, fv->value.str, fv->timestamp, expireTime);
-                break;
+            timelib64_t nextUpdate = watchInfo->lastQueriedUsec + watchInfo->monitorIntervalUsec;
+            if (now - watchInfo->lastQueriedUsec + m_updateSlackUsec < watchInfo->monitorIntervalUsec)
+            {
+                if (!(*earliestNextUpdate) || nextUpdate < (*earliestNextUpdate))
+                {
+                    *earliestNextUpdate = nextUpdate;
+                }
+                continue; /* Not old enough to update */
+            }
 
-            case DCGM_FT_BINARY:
+            if (watchInfo->practicalEntityGroupId == DCGM_FE_GPU)
             {
-                size_t valueSize = (size_t)fv->length - (sizeof(*fv) - sizeof(fv->value));
-                AppendEntityBlob(&threadCtx, fv->value.blob, valueSize, fv->timestamp, expireTime);
-                break;
+                /* Lost GPUs have blank field values inserted by ActuallyUpdateGpuFieldValues() */
+                DcgmEntityStatus_t gpuStatus = GetGpuStatus(gpuId);
+                if (gpuStatus != DcgmEntityStatusOk && gpuStatus != DcgmEntityStatusLost)
+                {
+                    continue;
+                }
             }
 
-            default:
-                log_error("Unknown field type: {}", fv->fieldType);
-                break;
+            if (SkipQuarantinedGpu(gpuId, now))
+            {
+                continue;
+            }
+
+            nextUpdate = now + watchInfo->monitorIntervalUsec;
+            if (!(*earliestNextUpdate) || nextUpdate < (*earliestNextUpdate))
+            {
+                *earliestNextUpdate = nextUpdate;
+            }
+
+            if (SkipUnchangedMemoryErrorWatch(watchInfo, now))
+            {
+                continue;
+            }
+
+            QueueGpuFieldValue(threadCtx, gpuId, entry);
+            anyQueued = true;
         }
     }
 
-    return DCGM_ST_OK;
+    return anyQueued;
 }
 
-
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AppendSamples(dcgm_field_entity_group_t entityGroupId,
-                                             dcgm_field_eid_t entityId,
-                                             unsigned short dcgmFieldId,
-                                             dcgmcm_sample_p samples,
-                                             int Nsamples)
+static bool FieldSupportsLiveUpdates(dcgm_field_entity_group_t entityGroupId, unsigned short fieldId)
 {
-    return InjectSamples(entityGroupId, entityId, dcgmFieldId, samples, Nsamples);
+    if (entityGroupId != DCGM_FE_NONE && entityGroupId != DCGM_FE_GPU && entityGroupId != DCGM_FE_GPU_I
+        && entityGroupId != DCGM_FE_GPU_CI)
+    {
+        return false;
+    }
+
+    /* Any fieldIds that result in multiple samples need to be excluded from live updates */
+    switch (fieldId)
+    {
+        case DCGM_FI_DEV_SUPPORTED_TYPE_INFO:
+        case DCGM_FI_DEV_GRAPHICS_PIDS:
+        case DCGM_FI_DEV_COMPUTE_PIDS:
+        case DCGM_FI_DEV_GPU_UTIL_SAMPLES:
+        case DCGM_FI_DEV_MEM_COPY_UTIL_SAMPLES:
+            return false;
+
+        default:
+            break;
+    }
+
+    return true;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::InjectSamples(dcgm_field_entity_group_t entityGroupId,
-                                             dcgm_field_eid_t entityId,
-                                             unsigned short dcgmFieldId,
-                                             dcgmcm_sample_p samples,
-                                             int Nsamples)
+dcgmReturn_t DcgmCacheManager::GetMultipleLatestLiveSamples(std::vector<dcgmGroupEntityPair_t> &entities,
+                                                            std::vector<unsigned short> &fieldIds,
+                                                            DcgmFvBuffer *fvBuffer)
 {
+    std::vector<dcgmGroupEntityPair_t>::iterator entityIt;
+    std::vector<unsigned short>::iterator fieldIdIt;
+    unsigned short fieldId;
     dcgm_field_meta_p fieldMeta = 0;
-    int sampleIndex;
-    dcgmcm_sample_p currentSample = 0;
-    dcgmcm_watch_info_p watchInfo = 0;
-    timelib64_t now;
-    timelib64_t expireTime;
-    dcgmReturn_t retVal = DCGM_ST_OK;
+
+    if (!fvBuffer)
+        return DCGM_ST_BADPARAM;
+
+    /* Allocate a thread context in this function in case we're in a user thread (embeded host engine) */
 
     dcgmcm_update_thread_t threadCtx;
     InitAndClearThreadCtx(&threadCtx);
-    threadCtx.fvBuffer = 0;
 
-    if (!dcgmFieldId || !samples || Nsamples < 1)
-        return DCGM_ST_BADPARAM;
+    threadCtx.fvBuffer = fvBuffer;
 
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta)
-        return DCGM_ST_GENERIC_ERROR;
+    /* Values read below are offered to m_staticFields once the loop is done */
+    size_t firstNewValueOffset = 0;
+    size_t existingValueCount  = 0;
+    fvBuffer->GetSize(&firstNewValueOffset, &existingValueCount);
 
-    if (fieldMeta->scope == DCGM_FS_GLOBAL)
-    {
-        watchInfo = GetGlobalWatchInfo(dcgmFieldId, 1);
-    }
-    else
+    /* Note: because we're handling fields that come from the NVML field value APIs out of order
+             from those that don't, we don't guarantee any order of returned results */
+
+    for (entityIt = entities.begin(); entityIt != entities.end(); ++entityIt)
     {
-        /* Note: we can only validate entity types other than switches here, as those are tracked by
-                 the switch module */
-        if (entityGroupId != DCGM_FE_SWITCH && !GetIsValidEntityId(entityGroupId, entityId))
-        {
-            DCGM_LOG_ERROR << "Got fv injection for invalid entityId " << entityId << " in entityGroupId "
-                           << entityGroupId;
-            return DCGM_ST_BADPARAM;
-        }
+        dcgm_field_entity_group_t entityGroupId = (*entityIt).entityGroupId;
+        dcgm_field_eid_t entityId               = (*entityIt).entityId;
 
-        watchInfo = GetEntityWatchInfo(entityGroupId, entityId, dcgmFieldId, 1);
-    }
+        threadCtx.entityKey.entityGroupId = entityGroupId;
+        threadCtx.entityKey.entityId      = entityId;
 
-    if (!watchInfo)
-    {
-        log_debug("InjectSamples eg {}, eid {}, fieldId {} got NULL", entityGroupId, entityId, dcgmFieldId);
-        return DCGM_ST_MEMORY;
-    }
+        for (fieldIdIt = fieldIds.begin(); fieldIdIt != fieldIds.end(); ++fieldIdIt)
+        {
+            fieldId                     = *fieldIdIt;
+            threadCtx.entityKey.fieldId = fieldId;
+            /* Restore entityGroupId since it may have been changed by a previous iteration */
+            entityGroupId = (*entityIt).entityGroupId;
 
-    /* If anyone is watching this watchInfo, we need to create a
-       fv buffer for the resulting notifcations */
-    if (watchInfo->hasSubscribedWatchers)
-        threadCtx.fvBuffer = new DcgmFvBuffer();
+            fieldMeta = DcgmFieldGetById(fieldId);
+            if (!fieldMeta)
+            {
+                log_error("Invalid field ID {} passed in.", fieldId);
+                fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_UNKNOWN_FIELD);
+                continue;
+            }
 
-    threadCtx.watchInfo               = watchInfo;
-    threadCtx.entityKey.entityGroupId = entityGroupId;
-    threadCtx.entityKey.entityId      = entityId;
-    threadCtx.entityKey.fieldId       = fieldMeta->fieldId;
+            /* Handle if the user accidentally marked this field as an entity field if it's global */
+            if (fieldMeta->scope == DCGM_FS_GLOBAL)
+            {
+                log_debug("Fixed entityGroupId to be DCGM_FE_NONE fieldId {}", fieldId);
+                entityGroupId = DCGM_FE_NONE;
+            }
 
-    now        = timelib_usecSince1970();
-    expireTime = 0;
-    if (watchInfo->maxAgeUsec)
-        expireTime = now - watchInfo->maxAgeUsec;
-    /* Update the last queried timestamp to now so that a watch on this field doesn't
-       update every single cycle. After all, we are injecting values. If the injected value
-       is in the future, then this field won't update live until after the injected timestamp
-       Note that we are also updating lastQueriedUsec in the loop below to achieve this. */
-    watchInfo->lastQueriedUsec = now;
+            /* Does this entity + fieldId even support live updates?
+               This will filter out VGPUs and NvSwitches */
+            if (!FieldSupportsLiveUpdates(entityGroupId, fieldId))
+            {
+                log_debug("eg {} fieldId {} doesn't support live updates.", entityGroupId, fieldId);
+                fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_FIELD_UNSUPPORTED_BY_API);
+                continue;
+            }
 
-    /* A future optimization would be to Lock() + Unlock() around this loop
-     * and inject all samples at once This is fine for now
-     */
-    for (sampleIndex = 0; sampleIndex < Nsamples; sampleIndex++)
-    {
-        currentSample = &samples[sampleIndex];
+            if (entityGroupId == DCGM_FE_NONE)
+            {
+                BufferOrCacheLatestGpuValue(&threadCtx, fieldMeta);
+            }
+            else if (entityGroupId == DCGM_FE_GPU || entityGroupId == DCGM_FE_GPU_I || entityGroupId == DCGM_FE_GPU_CI)
+            {
+                /* Is the entityId valid? */
+                if (!GetIsValidEntityId(entityGroupId, entityId))
+                {
+                    log_warning("Got invalid eg {}, eid {}", entityGroupId, entityId);
+                    fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_BADPARAM);
+                    continue;
+                }
 
-        /* Use the latest timestamp of the injected samples as the last queried time */
-        watchInfo->lastQueriedUsec = std::max(now, currentSample->timestamp);
+                /* Static attributes are only read from the driver once per GPU. GPUs that aren't up skip the
+                   cache so that lost GPUs keep reporting blank values */
+                if (entityGroupId == DCGM_FE_GPU && m_gpus[entityId].status == DcgmEntityStatusOk
+                    && DcgmStaticFieldCache::IsStaticField(fieldId) && m_staticFields.Get(entityId, fieldId, *fvBuffer))
+                {
+                    continue;
+                }
 
-        switch (fieldMeta->fieldType)
+                /* Is this a mapped field? Set aside the info for the field and handle it below */
+                unsigned int scopeId            = 0;
+                unsigned int batchedNvmlFieldId = GetBatchedNvmlFieldId(entityId, fieldMeta, scopeId);
+                if (batchedNvmlFieldId > 0)
+                {
+                    /* No watch info: don't cache. Only buffer it */
+                    QueueGpuFieldValue(&threadCtx, entityId, { nullptr, fieldMeta, batchedNvmlFieldId, scopeId });
+                }
+                else
+                    BufferOrCacheLatestGpuValue(&threadCtx, fieldMeta);
+            }
+            else
+            {
+                /* Unhandled entity group. Should have been caught by FieldSupportsLiveUpdates() */
+                log_error("Didn't expect to get here for eg {}, eid {}, fieldId {}",
+                          threadCtx.entityKey.entityGroupId,
+                          threadCtx.entityKey.entityId,
+                          fieldId);
+                fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_FIELD_UNSUPPORTED_BY_API);
+            }
+        }
+
+        /* Handle any field values that come from the NVML FV APIs. Note that entityId could be invalid, so
+           we need to check it */
+        if (entityGroupId == DCGM_FE_GPU && GetIsValidEntityId(entityGroupId, entityId)
+            && !threadCtx.fieldValues[entityId].empty())
         {
-            case DCGM_FT_DOUBLE:
-                AppendEntityDouble(
-                    &threadCtx, currentSample->val.d, currentSample->val2.d, currentSample->timestamp, expireTime);
-                break;
+            ActuallyUpdateGpuFieldValues(&threadCtx, entityId);
+        }
+    }
 
-            case DCGM_FT_INT64:
-                AppendEntityInt64(
-                    &threadCtx, currentSample->val.i64, currentSample->val2.i64, currentSample->timestamp, expireTime);
-                break;
+    dcgmBufferedFvCursor_t cursor = firstNewValueOffset;
+    for (dcgmBufferedFv_t *fv = fvBuffer->GetNextFv(&cursor); fv != nullptr; fv = fvBuffer->GetNextFv(&cursor))
+    {
+        m_staticFields.Store(*fv);
+    }
 
-            case DCGM_FT_STRING:
-                if (!currentSample->val.str)
-                {
-                    log_error("InjectSamples: Null string at index {} of samples", sampleIndex);
-                    /* Our injected samples before this one will still be in the data
-                     * cache. We can't do anything about this if their timestamp field
-                     * was 0 since it will assign a timestamp we won't know
-                     */
-                    return DCGM_ST_BADPARAM;
-                }
+    return DCGM_ST_OK;
+}
 
-                AppendEntityString(&threadCtx, currentSample->val.str, currentSample->timestamp, expireTime);
-                break;
+/*****************************************************************************/
+static double NvmlFieldValueToDouble(nvmlFieldValue_t *v)
+{
+    long long retVal = 0;
 
-            case DCGM_FT_BINARY:
-                if (!currentSample->val.blob)
-                {
-                    log_error("InjectSamples: Null blob at index {} of samples", sampleIndex);
-                    /* Our injected samples before this one will still be in the data
-                     * cache. We can't do anything about this if their timestamp field
-                     * was 0 since it will assign a timestamp we won't know
-                     */
-                    return DCGM_ST_BADPARAM;
-                }
+    switch (v->valueType)
+    {
+        case NVML_VALUE_TYPE_DOUBLE:
+            return (double)v->value.dVal;
 
-                AppendEntityBlob(&threadCtx,
-                                 currentSample->val.blob,
-                                 currentSample->val2.ptrSize,
-                                 currentSample->timestamp,
-                                 expireTime);
-                break;
+        case NVML_VALUE_TYPE_UNSIGNED_INT:
+            return (double)v->value.uiVal;
 
-            default:
-                log_error("InjectSamples: Unhandled field type: {}", fieldMeta->fieldType);
-                return DCGM_ST_BADPARAM;
-        }
-    }
+        case NVML_VALUE_TYPE_UNSIGNED_LONG:
+            return (double)v->value.ulVal;
 
-    /* Broadcast any accumulated notifications */
-    if (threadCtx.fvBuffer && threadCtx.affectedSubscribers)
-        UpdateFvSubscribers(&threadCtx);
+        case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG:
+            return (double)v->value.ullVal;
 
-    FreeThreadCtx(&threadCtx);
+        case NVML_VALUE_TYPE_SIGNED_LONG_LONG:
+            return (double)v->value.sllVal;
+
+        default:
+            log_error("Unhandled valueType: {}", (int)v->valueType);
+            return retVal;
+    }
 
     return retVal;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::FreeSamples(dcgmcm_sample_p samples, int Nsamples, unsigned short dcgmFieldId)
+static double NvmlSampleValueToDouble(nvmlValueType_t valueType, nvmlValue_t const &value)
 {
-    dcgm_field_meta_p fieldMeta = 0;
-    int sampleIndex;
-    dcgmcm_sample_p currentSample = 0;
+    switch (valueType)
+    {
+        case NVML_VALUE_TYPE_DOUBLE:
+            return value.dVal;
+        case NVML_VALUE_TYPE_UNSIGNED_INT:
+            return (double)value.uiVal;
+        case NVML_VALUE_TYPE_UNSIGNED_LONG:
+            return (double)value.ulVal;
+        case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG:
+            return (double)value.ullVal;
+        case NVML_VALUE_TYPE_SIGNED_LONG_LONG:
+            return (double)value.sllVal;
+        case NVML_VALUE_TYPE_SIGNED_INT:
+            return (double)value.siVal;
+        case NVML_VALUE_TYPE_UNSIGNED_SHORT:
+            return (double)value.usVal;
+        default:
+            log_error("Unhandled valueType: {}", (int)valueType);
+            return 0.0;
+    }
+}
 
-    if (!dcgmFieldId || !samples || Nsamples < 1)
-        return DCGM_ST_BADPARAM;
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::AppendNvmlSampleBuffer(dcgmcm_update_thread_t *threadCtx,
+                                                      nvmlDevice_t nvmlDevice,
+                                                      dcgm_field_meta_p fieldMeta,
+                                                      nvmlSamplingType_t samplingType,
+                                                      timelib64_t now,
+                                                      timelib64_t expireTime)
+{
+    dcgmcm_watch_info_p watchInfo = threadCtx->watchInfo;
+    nvmlValueType_t valueType     = NVML_VALUE_TYPE_UNSIGNED_INT;
+    unsigned int sampleCount      = 0;
+    std::vector<nvmlSample_t> samples;
 
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta)
-        return DCGM_ST_GENERIC_ERROR;
+    /* Only the samples newer than the last one we cached. 0 gets everything the driver buffered */
+    unsigned long long const lastSeenTs = watchInfo->lastNvmlSampleTs;
 
-    /* Only strings/binary need their values freed. */
-    if ((DCGM_FT_STRING != fieldMeta->fieldType) && (DCGM_FT_BINARY != fieldMeta->fieldType))
+    /* First call with samples == NULL to get how many there are */
+    nvmlReturn_t nvmlReturn
+        = nvmlDeviceGetSamples(nvmlDevice, samplingType, lastSeenTs, &valueType, &sampleCount, nullptr);
+    if (nvmlReturn == NVML_SUCCESS && sampleCount > 0)
     {
-        return DCGM_ST_OK;
+        samples.resize(sampleCount);
+        nvmlReturn
+            = nvmlDeviceGetSamples(nvmlDevice, samplingType, lastSeenTs, &valueType, &sampleCount, samples.data());
+        samples.resize(std::min<size_t>(sampleCount, samples.size()));
     }
+    watchInfo->lastStatus = nvmlReturn;
 
-    for (sampleIndex = 0; sampleIndex < Nsamples; sampleIndex++)
+    if (nvmlReturn == NVML_ERROR_NOT_FOUND)
     {
-        currentSample = &samples[sampleIndex];
+        return DCGM_ST_OK; /* Nothing new since lastSeenTs */
+    }
+    else if (nvmlReturn == NVML_ERROR_NOT_SUPPORTED)
+    {
+        log_debug(
+            "nvmlDeviceGetSamples type {} is not supported for fieldId {}", (int)samplingType, fieldMeta->fieldId);
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+    else if (nvmlReturn != NVML_SUCCESS)
+    {
+        if (fieldMeta->fieldType == DCGM_FT_DOUBLE)
+        {
+            AppendEntityDouble(threadCtx, NvmlErrorToDoubleValue(nvmlReturn), 0, now, expireTime);
+        }
+        else
+        {
+            AppendEntityInt64(threadCtx, NvmlErrorToInt64Value(nvmlReturn), 0, now, expireTime);
+        }
+        return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+    }
 
-        if (fieldMeta->fieldType == DCGM_FT_STRING)
+    /* Samples come oldest first */
+    for (nvmlSample_t const &sample : samples)
+    {
+        if (sample.timeStamp <= watchInfo->lastNvmlSampleTs)
         {
-            if (currentSample->val.str)
-            {
-                free(currentSample->val.str);
-                currentSample->val.str      = 0;
-                currentSample->val2.ptrSize = 0;
-            }
+            continue;
         }
+        watchInfo->lastNvmlSampleTs = sample.timeStamp;
 
-        if (fieldMeta->fieldType == DCGM_FT_BINARY)
+        double value = NvmlSampleValueToDouble(valueType, sample.sampleValue);
+        if (fieldMeta->fieldId == DCGM_FI_DEV_POWER_USAGE)
         {
-            if (currentSample->val.blob)
-            {
-                free(currentSample->val.blob);
-                currentSample->val.blob     = 0;
-                currentSample->val2.ptrSize = 0;
-            }
+            value /= 1000.0; /* Convert mW to watts */
+        }
+
+        if (fieldMeta->fieldType == DCGM_FT_DOUBLE)
+        {
+            AppendEntityDouble(threadCtx, value, 0, (timelib64_t)sample.timeStamp, expireTime);
+        }
+        else
+        {
+            AppendEntityInt64(threadCtx, (long long)value, 0, (timelib64_t)sample.timeStamp, expireTime);
         }
     }
 
@@ -5265,895 +8614,1167 @@ dcgmReturn_t DcgmCacheManager::FreeSamples(dcgmcm_sample_p samples, int Nsamples
 }
 
 /*****************************************************************************/
-void DcgmCacheManager::FreeThreadCtx(dcgmcm_update_thread_t *threadCtx)
+long long NvmlFieldValueToInt64(nvmlFieldValue_t *v)
 {
-    if (!threadCtx)
-        return;
+    long long retVal = 0;
 
-    ClearThreadCtx(threadCtx);
+    switch (v->valueType)
+    {
+        case NVML_VALUE_TYPE_DOUBLE:
+            return (long long)v->value.dVal;
 
-    if (threadCtx->fvBuffer)
-        delete threadCtx->fvBuffer;
-}
+        case NVML_VALUE_TYPE_UNSIGNED_INT:
+            return (long long)v->value.uiVal;
 
-/*****************************************************************************/
-void DcgmCacheManager::InitAndClearThreadCtx(dcgmcm_update_thread_t *threadCtx)
-{
-    if (!threadCtx)
-        return;
+        case NVML_VALUE_TYPE_UNSIGNED_LONG:
+            return (long long)v->value.ulVal;
 
-    threadCtx->fvBuffer = NULL;
+        case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG:
+            return (long long)v->value.ullVal;
 
-    ClearThreadCtx(threadCtx);
+        case NVML_VALUE_TYPE_SIGNED_LONG_LONG:
+            return (long long)v->value.sllVal;
+
+        default:
+            log_error("Unhandled valueType: {}", (int)v->valueType);
+            return retVal;
+    }
+
+    return retVal;
 }
 
-/*****************************************************************************/
-void DcgmCacheManager::ClearThreadCtx(dcgmcm_update_thread_t *threadCtx)
+void DcgmCacheManager::InsertNvmlErrorValue(dcgmcm_update_thread_t *threadCtx,
+                                            unsigned char fieldType,
+                                            nvmlReturn_t err,
+                                            timelib64_t maxAgeUsec)
+
 {
-    if (!threadCtx)
-        return;
+    timelib64_t now            = threadCtx->clock.Now();
+    timelib64_t oldestKeepTime = 0;
 
-    /* Clear the field-values counts */
-    memset(threadCtx->numFieldValues, 0, sizeof(threadCtx->numFieldValues));
+    if (maxAgeUsec)
+        oldestKeepTime = now - maxAgeUsec;
 
-    threadCtx->watchInfo = 0;
-    if (threadCtx->fvBuffer)
-        threadCtx->fvBuffer->Clear();
-    threadCtx->affectedSubscribers = 0;
+    /* Append a blank value of the correct type for our fieldId */
+    switch (fieldType)
+    {
+        case DCGM_FT_DOUBLE:
+            AppendEntityDouble(threadCtx, NvmlErrorToDoubleValue(err), 0, now, oldestKeepTime);
+            break;
+
+        case DCGM_FT_INT64:
+            AppendEntityInt64(threadCtx, NvmlErrorToInt64Value(err), 0, now, oldestKeepTime);
+            break;
+
+        case DCGM_FT_STRING:
+            AppendEntityString(threadCtx, NvmlErrorToStringValue(err), now, oldestKeepTime);
+            break;
+
+        default:
+            log_error("Field Type {} is unsupported for conversion from NVML errors", fieldType);
+            break;
+    }
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::UpdateFvSubscribers(dcgmcm_update_thread_t *updateCtx)
+dcgmReturn_t DcgmCacheManager::ActuallyUpdateGpuFieldValues(dcgmcm_update_thread_t *threadCtx, unsigned int gpuId)
 {
-    int numWatcherTypes = 0;
-    unsigned int i;
-    DcgmWatcherType_t watchers[DcgmWatcherTypeCount];
+    nvmlFieldValue_t *fv; /* Cached field value pointer */
+    int i;
+    nvmlReturn_t nvmlReturn;
+    timelib64_t expireTime;
 
-    if (!updateCtx->fvBuffer || !updateCtx->affectedSubscribers)
-        return DCGM_ST_OK; /* Nothing to do */
+    if (gpuId >= DCGM_MAX_NUM_DEVICES)
+        return DCGM_ST_GENERIC_ERROR;
 
-    /* Ok. We've got FVs and subscribers. Let's build the list */
-    for (i = 0; i < DcgmWatcherTypeCount; i++)
+    /* Make local variables for threadCtx members to simplify the code */
+    std::vector<dcgmcm_field_value_plan_entry_t> const &queued = threadCtx->fieldValues[gpuId];
+    int numFields                                              = (int)queued.size();
+
+    if (m_nvmlLoaded == false)
     {
-        if (updateCtx->affectedSubscribers & (1 << i))
+        log_error("Cannot update NVML values: NVML isn't loaded.");
+        return DCGM_ST_NVML_NOT_LOADED;
+    }
+
+    if (gpuId >= m_numGpus)
+        return DCGM_ST_GENERIC_ERROR;
+
+    if (numFields >= NVML_FI_MAX)
+    {
+        log_fatal("numFieldValueFields {} > NVML_FI_MAX", numFields);
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Initialize the values[] array. Its storage is reused across cycles */
+    std::vector<nvmlFieldValue_t> &values = threadCtx->nvmlFieldValues;
+    values.assign(numFields, nvmlFieldValue_t {});
+    for (i = 0; i < numFields; i++)
+    {
+        values[i].fieldId = queued[i].nvmlFieldId;
+        values[i].scopeId = queued[i].scopeId;
+    }
+
+    if (m_skipDriverCalls)
+    {
+        threadCtx->entityKey.entityGroupId = DCGM_FE_GPU;
+        threadCtx->entityKey.entityId      = gpuId;
+
+        // Insert blank values in all requested fields
+        for (i = 0; i < numFields; i++)
+        {
+            dcgm_field_meta_p const fieldMeta   = queued[i].fieldMeta;
+            dcgmcm_watch_info_p const watchInfo = queued[i].watchInfo;
+
+            threadCtx->entityKey.fieldId = fieldMeta->fieldId;
+            threadCtx->watchInfo         = watchInfo;
+
+            InsertNvmlErrorValue(threadCtx,
+                                 fieldMeta->fieldType,
+                                 NVML_ERROR_UNKNOWN,
+                                 watchInfo != nullptr ? watchInfo->maxAgeUsec : 0);
+            log_error(
+                "Cannot retrieve value for fieldId {} due to detected driver timeout error, inserting blank value instead.",
+                fieldMeta->fieldId);
+        }
+        return DCGM_ST_NVML_DRIVER_TIMEOUT;
+    }
+
+    // Do not attempt to poll NVML for values of detached GPUs
+    if (m_gpus[gpuId].status != DcgmEntityStatusDetached && m_gpus[gpuId].status != DcgmEntityStatusFake
+        && m_gpus[gpuId].status != DcgmEntityStatusLost)
+    {
+        /* The fieldId field of fieldValueValues[] was already populated above. Make the NVML call */
+        nvmlReturn = nvmlDeviceGetFieldValues(m_gpus[gpuId].nvmlDevice, numFields, values.data());
+        if (nvmlReturn != NVML_SUCCESS)
         {
-            watchers[numWatcherTypes] = (DcgmWatcherType_t)i;
-            numWatcherTypes++;
+            /* Any given field failure will be on a single fieldValueValues[] entry. A global failure is
+             * unexpected */
+            log_error("Unexpected NVML return {} from nvmlDeviceGetFieldValues", nvmlReturn);
+            return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
         }
     }
 
-    /* Locking the cache manager for now to protect m_subscriptions
-       We can reevaluate this later if there are deadlock issues. Technically,
-       we only modify this structure on start-up when we're single threaded. */
-    dcgmMutexReturn_t mutexSt = dcgm_mutex_lock_me(m_mutex);
+    /* Set thread context variables that won't change */
+    threadCtx->entityKey.entityGroupId = DCGM_FE_GPU;
+    threadCtx->entityKey.entityId      = gpuId;
 
-    std::vector<dcgmcmEventSubscription_t> localCopy(begin(m_subscriptions[DcgmcmEventTypeFvUpdate]),
-                                                     end(m_subscriptions[DcgmcmEventTypeFvUpdate]));
+    for (i = 0; i < numFields; i++)
+    {
+        fv                                  = &values[i];
+        dcgm_field_meta_p const fieldMeta   = queued[i].fieldMeta;
+        dcgmcm_watch_info_p const watchInfo = queued[i].watchInfo;
 
-    if (mutexSt != DCGM_MUTEX_ST_LOCKEDBYME)
-        dcgm_mutex_unlock(m_mutex);
+        /* Set threadCtx variables before we possibly use them */
+        threadCtx->entityKey.fieldId = fieldMeta->fieldId;
+        threadCtx->watchInfo         = watchInfo;
 
-    for (auto &&entry : localCopy)
-    {
-        entry.fn.fvCb(updateCtx->fvBuffer, watchers, numWatcherTypes, entry.userData);
-    }
+        if (m_gpus[gpuId].status == DcgmEntityStatusDetached || m_gpus[gpuId].status == DcgmEntityStatusFake
+            || m_gpus[gpuId].status == DcgmEntityStatusLost)
+        {
+            // Detached GPUs get an intentional NVML error and we're done
+            // Treating Fake GPUs as lost GPUs too since NVML has no idea about them
 
-    return DCGM_ST_OK;
-}
+            InsertNvmlErrorValue(threadCtx,
+                                 fieldMeta->fieldType,
+                                 NVML_ERROR_GPU_IS_LOST,
+                                 watchInfo != nullptr ? watchInfo->maxAgeUsec : 0);
+            DCGM_LOG_WARNING << "Wrote blank value for fieldId " << fieldMeta->fieldId << ", gpuId " << gpuId
+                             << ", status " << m_gpus[gpuId].status;
+            continue;
+        }
 
-/*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::SubscribeForEvent(const dcgmcmEventSubscription_t &eventSub)
-{
-    switch (eventSub.type)
-    {
-        case DcgmcmEventTypeFvUpdate:
+        /* We need a timestamp on every FV or we'll just keep saving it over and over */
+        if (!fv->timestamp)
         {
-            if (eventSub.fn.fvCb == nullptr)
+            log_debug("gpuId {}, fieldId {}, index {} had a null timestamp.", gpuId, fv->fieldId, i);
+            fv->timestamp = threadCtx->clock.Now();
+
+            /* WaR for NVML bug 2009232 where fields ECC can be left uninitialized if ECC is disabled */
+
+            if (!fv->latencyUsec
+                && fv->valueType == NVML_VALUE_TYPE_DOUBLE /* 0 */ && fv->fieldId >= NVML_FI_DEV_ECC_CURRENT
+                && fv->fieldId <= NVML_FI_DEV_RETIRED_PENDING)
             {
-                DCGM_LOG_DEBUG << "Cannot subscribe to field value updates using a null callback function";
-                return DCGM_ST_BADPARAM;
+                if (fv->fieldId > NVML_FI_DEV_ECC_PENDING)
+                    fv->nvmlReturn = NVML_ERROR_NOT_SUPPORTED;
+                else
+                {
+                    /* Read current/pending manually so that they have a valid value */
+                    nvmlEnableState_t currentIsEnabled, pendingIsEnabled;
+                    fv->nvmlReturn
+                        = nvmlDeviceGetEccMode(m_gpus[gpuId].nvmlDevice, &currentIsEnabled, &pendingIsEnabled);
+                    fv->valueType = NVML_VALUE_TYPE_UNSIGNED_LONG_LONG;
+                    if (fv->fieldId == NVML_FI_DEV_ECC_CURRENT)
+                        fv->value.ullVal = currentIsEnabled;
+                    else
+                        fv->value.ullVal = pendingIsEnabled;
+                }
             }
-            break;
         }
 
-        case DcgmcmEventTypeMigReconfigure:
+        /* Expiration is either measured in absolute time or 0 */
+        expireTime = 0;
+        if (watchInfo)
         {
-            if (eventSub.fn.migCb == nullptr)
+            if (watchInfo->maxAgeUsec)
             {
-                DCGM_LOG_DEBUG << "Cannot subscribe to mig reconfigure updates using a null callback function";
-                return DCGM_ST_BADPARAM;
+                expireTime = fv->timestamp - watchInfo->maxAgeUsec;
             }
-            break;
+            watchInfo->execTimeUsec += fv->latencyUsec;
+            watchInfo->maxExecTimeUsec = std::max(watchInfo->maxExecTimeUsec, (timelib64_t)fv->latencyUsec);
+            watchInfo->fetchCount++;
+            watchInfo->lastQueriedUsec = fv->timestamp;
+            watchInfo->lastStatus      = fv->nvmlReturn;
         }
 
-        default:
+        /* WAR for NVML Bug 2032468. Force the valueType to unsigned long long for ECC fields, because NVML
+         * isn't setting them and it's defaulting to a double which doesn't get stored properly. */
+        if ((threadCtx->entityKey.fieldId <= DCGM_FI_DEV_ECC_DBE_AGG_TEX)
+            && (threadCtx->entityKey.fieldId >= DCGM_FI_DEV_ECC_CURRENT))
         {
-            DCGM_LOG_DEBUG << "Cannot process cache manager event type " << eventSub.type;
-            return DCGM_ST_BADPARAM;
+            fv->valueType = NVML_VALUE_TYPE_UNSIGNED_LONG_LONG;
         }
-    }
 
+        if (fv->nvmlReturn != NVML_SUCCESS && RetryNvLinkErrorFieldValue(gpuId, fieldMeta->fieldId, *fv))
+        {
+            if (watchInfo)
+            {
+                watchInfo->lastStatus = fv->nvmlReturn;
+            }
+        }
 
-    dcgm_mutex_lock(m_mutex);
-    m_subscriptions[eventSub.type].push_back(eventSub);
-    dcgm_mutex_unlock(m_mutex);
+        if (fv->nvmlReturn != NVML_SUCCESS)
+        {
+            /* Store an appropriate error for the destination type */
+            timelib64_t maxAgeUsec = DCGM_MAX_AGE_USEC_DEFAULT;
+            if (watchInfo)
+                maxAgeUsec = watchInfo->maxAgeUsec;
+            InsertNvmlErrorValue(threadCtx, fieldMeta->fieldType, fv->nvmlReturn, maxAgeUsec);
+        }
+        else /* NVML_SUCCESS */
+        {
+            log_debug("fieldId {} got good value type {}, value {:#X}", fv->fieldId, fv->valueType, fv->value.ullVal);
 
-    return DCGM_ST_OK;
-}
+            /* Fields from DcgmFieldGetBatchedNvmlFieldId() that need their value fixed up. These checks
+               match what BufferOrCacheLatestGpuValue() does when it fetches them individually */
+            if (fieldMeta->fieldId == DCGM_FI_DEV_POWER_USAGE_INSTANT)
+            {
+                double powerDbl = ((double)fv->value.uiVal) / 1000.0; /* Convert to watts */
+                AppendEntityDouble(threadCtx, powerDbl, 0.0, (timelib64_t)fv->timestamp, expireTime);
+                continue;
+            }
+            else if (fieldMeta->fieldId == DCGM_FI_DEV_MEMORY_TEMP)
+            {
+                /* Ignore fv->valueType, WaR for nvml setting type as double. See nvbugs/4300930 */
+                long long temp = (fv->value.uiVal > 200) ? NvmlErrorToInt64Value(fv->nvmlReturn) : fv->value.uiVal;
+                AppendEntityInt64(threadCtx, temp, 0, (timelib64_t)fv->timestamp, expireTime);
+                continue;
+            }
 
-/*****************************************************************************/
-void DcgmCacheManager::MarkEnteredDriver()
-{
-    DcgmLockGuard dlg(m_mutex);
+            /* Store an appropriate error for the destination type */
+            switch (fieldMeta->fieldType)
+            {
+                case DCGM_FT_INT64:
+                    AppendEntityInt64(threadCtx, NvmlFieldValueToInt64(fv), 0, (timelib64_t)fv->timestamp, expireTime);
+                    break;
 
-    // Make sure we aren't waiting to detach from the GPUs
-    WaitForDriverToBeReady();
+                case DCGM_FT_DOUBLE:
+                    AppendEntityDouble(
+                        threadCtx, NvmlFieldValueToDouble(fv), 0.0, (timelib64_t)fv->timestamp, expireTime);
+                    break;
 
-    m_inDriverCount++;
+                default:
+                    log_error("Unhandled field value output type: {}", fieldMeta->fieldType);
+                    break;
+            }
+        }
+    }
+
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-void DcgmCacheManager::MarkReturnedFromDriver()
+unsigned int DcgmCacheManager::GetBatchedNvmlFieldId(unsigned int gpuId,
+                                                     dcgm_field_meta_p fieldMeta,
+                                                     unsigned int &scopeId) const
 {
-    DcgmLockGuard dlg(m_mutex);
+    if (gpuId < DCGM_MAX_NUM_DEVICES && m_nvLinkErrorFieldValuesRejected[gpuId])
+    {
+        scopeId = 0;
+        return DcgmFieldGetBatchedNvmlFieldId(fieldMeta, m_driverIsR520OrNewer);
+    }
 
-    m_inDriverCount--;
+    return DcgmFieldGetBatchedNvmlFieldId(fieldMeta, m_driverIsR520OrNewer, scopeId);
 }
 
 /*****************************************************************************/
-bool DcgmCacheManager::IsModulePushedFieldId(unsigned int fieldId)
+bool DcgmCacheManager::RetryNvLinkErrorFieldValue(unsigned int gpuId, unsigned short fieldId, nvmlFieldValue_t &fv)
 {
-    if (fieldId < DCGM_FI_FIRST_NVSWITCH_FIELD_ID)
+    if (fv.fieldId != NVML_FI_DEV_NVLINK_ERROR_DL_CRC && fv.fieldId != NVML_FI_DEV_NVLINK_ERROR_DL_REPLAY
+        && fv.fieldId != NVML_FI_DEV_NVLINK_ERROR_DL_RECOVERY)
     {
         return false;
     }
 
-    switch (fieldId)
+    nvmlNvLinkErrorCounter_t counter;
+    unsigned int linkId;
+    if (!m_driverIsR520OrNewer || gpuId >= DCGM_MAX_NUM_DEVICES
+        || !DcgmFieldGetNvLinkErrorCounter(fieldId, counter, linkId))
     {
-        case DCGM_FI_DEV_NVLINK_COUNT_TX_PACKETS:
-        case DCGM_FI_DEV_NVLINK_COUNT_TX_BYTES:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_PACKETS:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_BYTES:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_MALFORMED_PACKET_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_BUFFER_OVERRUN_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_REMOTE_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_GENERAL_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_LOCAL_LINK_INTEGRITY_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_TX_DISCARDS:
-        case DCGM_FI_DEV_NVLINK_COUNT_LINK_RECOVERY_SUCCESSFUL_EVENTS:
-        case DCGM_FI_DEV_NVLINK_COUNT_LINK_RECOVERY_FAILED_EVENTS:
-        case DCGM_FI_DEV_NVLINK_COUNT_LINK_RECOVERY_EVENTS:
-        case DCGM_FI_DEV_NVLINK_COUNT_RX_SYMBOL_ERRORS:
-        case DCGM_FI_DEV_NVLINK_COUNT_SYMBOL_BER:
-            return false;
-        default:
-            return true;
+        return false;
     }
-}
-
-/*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::ActuallyUpdateAllFields(dcgmcm_update_thread_t *threadCtx,
-                                                       timelib64_t *earliestNextUpdate)
-{
-    dcgmcm_watch_info_p watchInfo = 0;
-    timelib64_t now, newNow, age, nextUpdate;
-    dcgmMutexReturn_t mutexReturn;   /* Tracks the state of the cache manager mutex */
-    int anyFieldValues          = 0; /* Have we queued any field values to be fetched from nvml? */
-    dcgm_field_meta_p fieldMeta = 0;
 
-    mutexReturn = m_mutex->Poll();
-    if (mutexReturn != DCGM_MUTEX_ST_LOCKEDBYME)
+    unsigned long long value = 0;
+    nvmlReturn_t nvmlReturn  = nvmlDeviceGetNvLinkErrorCounter(m_gpus[gpuId].nvmlDevice, linkId, counter, &value);
+    if (nvmlReturn != NVML_SUCCESS)
     {
-        log_error("Entered ActuallyUpdateAllFields() without the lock st {}", (int)mutexReturn);
-        return DCGM_ST_GENERIC_ERROR; /* We need the lock in here */
+        /* The counter isn't available either way. Keep the error of the batched call */
+        return false;
     }
 
-    ClearThreadCtx(threadCtx);
+    log_debug("gpuId {} rejected NVML field {} for link {} with {}. Reading NvLink error counters one at a time",
+              gpuId,
+              fv.fieldId,
+              linkId,
+              fv.nvmlReturn);
 
-    *earliestNextUpdate = 0;
-    now                 = timelib_usecSince1970();
+    fv.nvmlReturn   = NVML_SUCCESS;
+    fv.valueType    = NVML_VALUE_TYPE_UNSIGNED_LONG_LONG;
+    fv.value.ullVal = value;
 
-    /* Walk the hash table of watch objects, looking for any that have expired */
-    for (void *hashIter = hashtable_iter(m_entityWatchHashTable); hashIter;
-         hashIter       = hashtable_iter_next(m_entityWatchHashTable, hashIter))
+    DcgmLockGuard dlg(m_mutex);
+    if (!m_nvLinkErrorFieldValuesRejected[gpuId])
     {
-        watchInfo = (dcgmcm_watch_info_p)hashtable_iter_value(hashIter);
-        if (watchInfo == nullptr)
-        {
-            continue;
-        }
+        m_nvLinkErrorFieldValuesRejected[gpuId] = true;
+        /* Take the counters out of the field value plan */
+        m_watchSetGeneration++;
+    }
 
-        if (!watchInfo->isWatched)
-            continue; /* Not watched */
+    return true;
+}
 
-        /* Some fields or entities are pushed by modules. Don't handle those fields here
-           Examples are prof fields for non-GPM GPUs and any NvSwitch fields */
-        if (watchInfo->pushedByModule)
-        {
-            continue;
-        }
+/*****************************************************************************/
+void DcgmCacheManager::ClearWatchInfo(dcgmcm_watch_info_p watchInfo, int clearCache)
+{
+    if (!watchInfo)
+        return;
 
-        /* Last sample time old enough to take another? */
-        age = now - watchInfo->lastQueriedUsec;
-        if (age < watchInfo->monitorIntervalUsec)
-        {
-            nextUpdate = watchInfo->lastQueriedUsec + watchInfo->monitorIntervalUsec;
-            if (!(*earliestNextUpdate) || nextUpdate < (*earliestNextUpdate))
-            {
-                *earliestNextUpdate = nextUpdate;
-            }
-            continue; /* Not old enough to update */
-        }
+    for (auto const &watcherInfo : watchInfo->watchers)
+    {
+        UntrackConnectionWatch(watchInfo, watcherInfo.watcher);
+    }
+    watchInfo->watchers.clear();
+    watchInfo->isWatched            = 0;
+    watchInfo->pushedByModule       = false;
+    watchInfo->monitorIntervalUsec  = 0;
+    watchInfo->maxAgeUsec           = DCGM_MAX_AGE_USEC_DEFAULT;
+    watchInfo->lastQueriedUsec      = 0;
+    watchInfo->historyIntervalUsec  = 0;
+    watchInfo->historyMaxAgeUsec    = 0;
+    watchInfo->derivedPrevInputUsec = 0;
+    watchInfo->derivedTotal         = 0.0;
+    watchInfo->lastDriverReadUsec   = 0;
+    watchInfo->lastNvmlSampleTs     = 0;
+    m_watchSetGeneration++;
+    if (watchInfo->historyTimeSeries && clearCache)
+    {
+        timeseries_destroy(watchInfo->historyTimeSeries);
+        watchInfo->historyTimeSeries = nullptr;
+    }
+    if (watchInfo->timeSeries && clearCache)
+    {
+        timeseries_destroy(watchInfo->timeSeries);
+        watchInfo->timeSeries = 0;
+        watchInfo->int64Rollups.reset();
+        watchInfo->fp64Rollups.reset();
+        watchInfo->processStatsIndex.reset();
+        PublishLatestValue(watchInfo);
+    }
+}
 
-        fieldMeta = DcgmFieldGetById(watchInfo->watchKey.fieldId);
-        if (!fieldMeta)
-        {
-            log_error("Unexpected null fieldMeta for field {}", watchInfo->watchKey.fieldId);
-            continue;
-        }
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ClearAllEntities(int clearCache)
+{
+    dcgmMutexReturn_t mutexReturn;
+    int numCleared = 0;
 
-        log_debug("Preparing to update watchInfo {}, eg {}, eid {}, fieldId {}",
-                  (void *)watchInfo,
-                  watchInfo->watchKey.entityGroupId,
-                  watchInfo->watchKey.entityId,
-                  watchInfo->watchKey.fieldId);
+    mutexReturn = dcgm_mutex_lock_me(m_mutex);
 
-        if (watchInfo->practicalEntityGroupId == DCGM_FE_GPU)
-        {
-            /*
-             * Don't cache GPU fields if the GPU is not available. Lost GPUs have blank
-             * field values inserted later.
-             */
-            DcgmEntityStatus_t gpuStatus = GetGpuStatus(watchInfo->practicalEntityId);
-            if (gpuStatus != DcgmEntityStatusOk && gpuStatus != DcgmEntityStatusLost)
-            {
-                log_debug("Skipping gpuId {} in status {}", watchInfo->practicalEntityId, gpuStatus);
-                continue;
-            }
-        }
+    /* Walk the watch table and clear every entry */
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        numCleared++;
+        ClearWatchInfo(watchInfo, clearCache);
+    }
 
-        /* Base when we sync again on before the driver call so we don't continuously
-         * get behind by how long the driver call took
-         */
-        nextUpdate = now + watchInfo->monitorIntervalUsec;
-        if (!(*earliestNextUpdate) || nextUpdate < (*earliestNextUpdate))
-        {
-            *earliestNextUpdate = nextUpdate;
-        }
+    if (mutexReturn == DCGM_MUTEX_ST_OK)
+        dcgm_mutex_unlock(m_mutex);
+
+    log_debug("ClearAllEntities clearCache {}, numCleared {}", clearCache, numCleared);
+
+    return DCGM_ST_OK;
+}
 
-        /* Set key information before we call child functions */
-        threadCtx->entityKey.entityGroupId = watchInfo->practicalEntityGroupId;
-        threadCtx->entityKey.entityId      = watchInfo->practicalEntityId;
-        threadCtx->entityKey.fieldId       = watchInfo->watchKey.fieldId;
-        threadCtx->watchInfo               = watchInfo;
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ClearEntity(dcgm_field_entity_group_t entityGroupId,
+                                           dcgm_field_eid_t entityId,
+                                           int clearCache)
+{
+    dcgmMutexReturn_t mutexReturn;
+    int numMatched = 0;
+    int numScanned = 0;
 
-        MarkEnteredDriver();
+    mutexReturn = dcgm_mutex_lock_me(m_mutex);
+
+    /* Walk the watch table and clear anything that points at this entityGroup + entityId combo */
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        numScanned++;
 
-        /* Unlock the mutex before the driver call, unless we're just buffering a list of field values */
-        mutexReturn = m_mutex->Poll();
-        if ((watchInfo->practicalEntityGroupId != DCGM_FE_GPU || !fieldMeta->nvmlFieldId)
-            && mutexReturn == DCGM_MUTEX_ST_LOCKEDBYME)
+        if (watchInfo->watchKey.entityGroupId != entityGroupId || watchInfo->watchKey.entityId != entityId)
         {
-            dcgm_mutex_unlock(m_mutex);
-            mutexReturn = DCGM_MUTEX_ST_NOTLOCKED;
+            continue; /* Not a match */
         }
 
-        if (watchInfo->practicalEntityGroupId == DCGM_FE_NONE)
-            BufferOrCacheLatestGpuValue(threadCtx, fieldMeta);
-        else if (watchInfo->practicalEntityGroupId == DCGM_FE_GPU || watchInfo->practicalEntityGroupId == DCGM_FE_GPU_CI
-                 || watchInfo->practicalEntityGroupId == DCGM_FE_GPU_I)
-        {
-            /* Is this a mapped field? Set aside the info for the field and handle it below */
-            if (DcgmFieldIsMappedToNvmlField(fieldMeta, m_driverIsR520OrNewer))
-            {
-                unsigned int gpuId                                                      = watchInfo->practicalEntityId;
-                threadCtx->fieldValueFields[gpuId][threadCtx->numFieldValues[gpuId]]    = fieldMeta;
-                threadCtx->fieldValueWatchInfo[gpuId][threadCtx->numFieldValues[gpuId]] = watchInfo;
-                threadCtx->numFieldValues[gpuId]++;
-                anyFieldValues = 1;
-                MarkReturnedFromDriver();
-                continue;
-            }
+        numMatched++;
+        ClearWatchInfo(watchInfo, clearCache);
+    }
 
-            BufferOrCacheLatestGpuValue(threadCtx, fieldMeta);
-        }
-        else if (watchInfo->practicalEntityGroupId == DCGM_FE_VGPU)
-        {
-            if (m_skipDriverCalls)
-            {
-                InsertNvmlErrorValue(threadCtx, fieldMeta->fieldType, NVML_ERROR_UNKNOWN, watchInfo->maxAgeUsec);
-                log_error(
-                    "Cannot retrieve value for fieldId {} due to detected driver timeout error; inserting blank value instead.",
-                    fieldMeta->fieldId);
-            }
-            else
-            {
-                BufferOrCacheLatestVgpuValue(*this, threadCtx, watchInfo->practicalEntityId, fieldMeta);
-            }
-        }
-        else
-            log_debug("Unhandled entityGroupId {}", watchInfo->practicalEntityGroupId);
-        /* Resync clock after a value fetch since a driver call may take a while */
-        newNow = timelib_usecSince1970();
+    if (mutexReturn == DCGM_MUTEX_ST_OK)
+        dcgm_mutex_unlock(m_mutex);
 
-        // accumulate the time spent retrieving this field
-        watchInfo->execTimeUsec += newNow - now;
-        watchInfo->fetchCount += 1;
-        now = newNow;
+    log_debug("ClearEntity eg {}, eid {}, clearCache {}, numScanned {}, numMatched {}",
+              entityGroupId,
+              entityId,
+              clearCache,
+              numScanned,
+              numMatched);
 
-        /* Relock the mutex if we need to */
-        if (mutexReturn == DCGM_MUTEX_ST_NOTLOCKED)
-            mutexReturn = dcgm_mutex_lock(m_mutex);
+    return DCGM_ST_OK;
+}
 
-        MarkReturnedFromDriver();
-    }
+/*****************************************************************************/
+timelib64_t DcgmCacheManager::DoOneUpdateAllFields(void)
+{
+    timelib64_t earliestNextUpdate    = 0;
+    dcgmcm_update_thread_t *threadCtx = m_updateThreadCtx;
 
-    if (!anyFieldValues)
-        return DCGM_ST_OK;
+    assert(threadCtx != nullptr);
 
-    /* Unlock the mutex before the driver call */
-    mutexReturn = m_mutex->Poll();
-    if (mutexReturn == DCGM_MUTEX_ST_LOCKEDBYME)
+    /* If we haven't allocated fvBuffer yet, do so only if there are any live subscribers */
+    if (!threadCtx->fvBuffer && m_haveAnyLiveSubscribers)
     {
-        dcgm_mutex_unlock(m_mutex);
-        mutexReturn = DCGM_MUTEX_ST_NOTLOCKED;
+        /* Buffer live updates for subscribers */
+        threadCtx->fvBuffer = new DcgmFvBuffer();
     }
 
-    for (unsigned int gpuId = 0; gpuId < m_numGpus; gpuId++)
+    if (!m_updateWorkers.empty())
     {
-        if (!threadCtx->numFieldValues[gpuId])
-            continue;
-
-        log_debug("Got {} field value fields for gpuId {}", threadCtx->numFieldValues[gpuId], gpuId);
+        earliestNextUpdate = RunShardedUpdateCycle(threadCtx);
+    }
+    else
+    {
+        /* ActuallyUpdateAllFields needs a locked mutex */
+        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
 
-        MarkEnteredDriver();
-        ActuallyUpdateGpuFieldValues(threadCtx, gpuId);
-        MarkReturnedFromDriver();
+        /* Try to update all fields */
+        earliestNextUpdate = 0;
+        ActuallyUpdateAllFields(threadCtx, &earliestNextUpdate);
     }
 
-    /* relock the mutex if we need to */
-    if (mutexReturn == DCGM_MUTEX_ST_NOTLOCKED)
-        mutexReturn = dcgm_mutex_lock(m_mutex);
+    if (threadCtx->fvBuffer)
+        UpdateFvSubscribers(threadCtx);
 
-    return DCGM_ST_OK;
+    m_runStats.updateCycleFinished++;
+
+    return earliestNextUpdate;
 }
 
 /*****************************************************************************/
-static bool FieldSupportsLiveUpdates(dcgm_field_entity_group_t entityGroupId, unsigned short fieldId)
+void DcgmCacheManager::DoOneUpdateFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                         std::vector<unsigned short> const &fieldIds)
 {
-    if (entityGroupId != DCGM_FE_NONE && entityGroupId != DCGM_FE_GPU && entityGroupId != DCGM_FE_GPU_I
-        && entityGroupId != DCGM_FE_GPU_CI)
+    dcgmcm_update_thread_t *threadCtx = m_updateThreadCtx;
+
+    assert(threadCtx != nullptr);
+
+    if (!threadCtx->fvBuffer && m_haveAnyLiveSubscribers)
     {
-        return false;
+        threadCtx->fvBuffer = new DcgmFvBuffer();
     }
 
-    /* Any fieldIds that result in multiple samples need to be excluded from live updates */
-    switch (fieldId)
     {
-        case DCGM_FI_DEV_SUPPORTED_TYPE_INFO:
-        case DCGM_FI_DEV_GRAPHICS_PIDS:
-        case DCGM_FI_DEV_COMPUTE_PIDS:
-        case DCGM_FI_DEV_GPU_UTIL_SAMPLES:
-        case DCGM_FI_DEV_MEM_COPY_UTIL_SAMPLES:
-            return false;
+        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
 
-        default:
-            break;
+        std::vector<dcgmcm_watch_info_p> watches;
+        GetWatchesOfFields(entities, fieldIds, watches);
+
+        log_debug("Updating {} watches of {} entities x {} fields", watches.size(), entities.size(), fieldIds.size());
+
+        ActuallyUpdateWatches(threadCtx, watches);
     }
 
-    return true;
+    if (threadCtx->fvBuffer)
+        UpdateFvSubscribers(threadCtx);
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::GetMultipleLatestLiveSamples(std::vector<dcgmGroupEntityPair_t> &entities,
-                                                            std::vector<unsigned short> &fieldIds,
-                                                            DcgmFvBuffer *fvBuffer)
+timelib64_t DcgmCacheManager::DoOneSnapshotFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                                  std::vector<unsigned short> const &fieldIds)
 {
-    std::vector<dcgmGroupEntityPair_t>::iterator entityIt;
-    std::vector<unsigned short>::iterator fieldIdIt;
-    unsigned short fieldId;
-    dcgm_field_meta_p fieldMeta = 0;
-
-    if (!fvBuffer)
-        return DCGM_ST_BADPARAM;
+    std::map<unsigned int, std::vector<dcgmcm_watch_info_p>> watchesByGpu;
+    timelib64_t snapshotId = 0;
+    unsigned int numGpus   = 0;
 
-    /* Allocate a thread context in this function in case we're in a user thread (embeded host engine) */
-
-    dcgmcm_update_thread_t threadCtx;
-    InitAndClearThreadCtx(&threadCtx);
+    {
+        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
 
-    threadCtx.fvBuffer = fvBuffer;
+        std::vector<dcgmcm_watch_info_p> watches;
+        GetWatchesOfFields(entities, fieldIds, watches);
+        for (auto const &watchInfo : watches)
+        {
+            watchesByGpu[GetWatchGpuId(watchInfo)].push_back(watchInfo);
+        }
 
-    /* Note: because we're handling fields that come from the NVML field value APIs out of order
-             from those that don't, we don't guarantee any order of returned results */
+        /* Two snapshots taken within the same usec still need different IDs */
+        snapshotId            = std::max(timelib_usecSince1970(), m_lastFieldSnapshotId + 1);
+        m_lastFieldSnapshotId = snapshotId;
+        numGpus               = m_numGpus;
+    }
 
-    for (entityIt = entities.begin(); entityIt != entities.end(); ++entityIt)
+    /* The workers spend their time waiting in the driver, so give every GPU its own */
+    if (!m_fieldSnapshotPool || m_fieldSnapshotPool->GetNumWorkers() < numGpus)
     {
-        dcgm_field_entity_group_t entityGroupId = (*entityIt).entityGroupId;
-        dcgm_field_eid_t entityId               = (*entityIt).entityId;
-
-        threadCtx.entityKey.entityGroupId = entityGroupId;
-        threadCtx.entityKey.entityId      = entityId;
-
-        for (fieldIdIt = fieldIds.begin(); fieldIdIt != fieldIds.end(); ++fieldIdIt)
-        {
-            fieldId                     = *fieldIdIt;
-            threadCtx.entityKey.fieldId = fieldId;
-            /* Restore entityGroupId since it may have been changed by a previous iteration */
-            entityGroupId = (*entityIt).entityGroupId;
+        m_fieldSnapshotPool
+            = std::make_unique<DcgmNs::WorkStealingThreadPool>(std::max(numGpus, 1u), "cache_mgr_snap", [] {
+                  DcgmNs::ThreadPlacement::ApplyToCurrentThread("cache_mgr_snap");
+              });
+    }
 
-            fieldMeta = DcgmFieldGetById(fieldId);
-            if (!fieldMeta)
-            {
-                log_error("Invalid field ID {} passed in.", fieldId);
-                fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_UNKNOWN_FIELD);
-                continue;
-            }
+    log_debug("Snapshot {} of {} entities x {} fields", snapshotId, entities.size(), fieldIds.size());
 
-            /* Handle if the user accidentally marked this field as an entity field if it's global */
-            if (fieldMeta->scope == DCGM_FS_GLOBAL)
-            {
-                log_debug("Fixed entityGroupId to be DCGM_FE_NONE fieldId {}", fieldId);
-                entityGroupId = DCGM_FE_NONE;
-            }
+    std::vector<std::unique_ptr<dcgmcm_update_thread_t>> threadCtxs;
+    std::vector<std::shared_future<void>> pending;
 
-            /* Does this entity + fieldId even support live updates?
-               This will filter out VGPUs and NvSwitches */
-            if (!FieldSupportsLiveUpdates(entityGroupId, fieldId))
-            {
-                log_debug("eg {} fieldId {} doesn't support live updates.", entityGroupId, fieldId);
-                fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_FIELD_UNSUPPORTED_BY_API);
-                continue;
-            }
+    for (auto const &[gpuId, watches] : watchesByGpu)
+    {
+        auto *threadCtx = threadCtxs.emplace_back(std::make_unique<dcgmcm_update_thread_t>()).get();
+        if (m_haveAnyLiveSubscribers)
+        {
+            threadCtx->fvBuffer = new DcgmFvBuffer();
+        }
 
-            if (entityGroupId == DCGM_FE_NONE)
-            {
-                BufferOrCacheLatestGpuValue(&threadCtx, fieldMeta);
-            }
-            else if (entityGroupId == DCGM_FE_GPU || entityGroupId == DCGM_FE_GPU_I || entityGroupId == DCGM_FE_GPU_CI)
-            {
-                /* Is the entityId valid? */
-                if (!GetIsValidEntityId(entityGroupId, entityId))
-                {
-                    log_warning("Got invalid eg {}, eid {}", entityGroupId, entityId);
-                    fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_BADPARAM);
-                    continue;
-                }
+        /* ActuallyUpdateWatches drops m_mutex around driver calls, which is what lets the GPUs be in the driver at
+           the same time */
+        auto const updateWatches = [this, threadCtx, &watches, snapshotId] {
+            DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+            ActuallyUpdateWatches(threadCtx, watches, snapshotId);
+        };
 
-                /* Is this a mapped field? Set aside the info for the field and handle it below */
-                if (fieldMeta->nvmlFieldId > 0)
-                {
-                    threadCtx.fieldValueFields[entityId][threadCtx.numFieldValues[entityId]] = fieldMeta;
-                    threadCtx.fieldValueWatchInfo[entityId][threadCtx.numFieldValues[entityId]]
-                        = 0; /* Don't cache. Only buffer it */
-                    threadCtx.numFieldValues[entityId]++;
-                }
-                else
-                    BufferOrCacheLatestGpuValue(&threadCtx, fieldMeta);
-            }
-            else
-            {
-                /* Unhandled entity group. Should have been caught by FieldSupportsLiveUpdates() */
-                log_error("Didn't expect to get here for eg {}, eid {}, fieldId {}",
-                          threadCtx.entityKey.entityGroupId,
-                          threadCtx.entityKey.entityId,
-                          fieldId);
-                fvBuffer->AddInt64Value(entityGroupId, entityId, fieldId, 0, 0, DCGM_ST_FIELD_UNSUPPORTED_BY_API);
-            }
+        /* Watches that aren't owned by a GPU are updated by this thread while the workers run */
+        if (gpuId == DCGM_GPU_ID_BAD)
+        {
+            updateWatches();
+            continue;
         }
 
-        /* Handle any field values that come from the NVML FV APIs. Note that entityId could be invalid, so
-           we need to check it */
-        if (entityGroupId == DCGM_FE_GPU && GetIsValidEntityId(entityGroupId, entityId)
-            && threadCtx.numFieldValues[entityId] > 0)
+        if (auto task = m_fieldSnapshotPool->Enqueue(gpuId, updateWatches); task.has_value())
         {
-            ActuallyUpdateGpuFieldValues(&threadCtx, entityId);
+            pending.push_back(std::move(*task));
+        }
+        else
+        {
+            log_error("Unable to enqueue the snapshot of gpuId {}. Updating it inline", gpuId);
+            updateWatches();
         }
     }
 
-    return DCGM_ST_OK;
-}
-
-/*****************************************************************************/
-static double NvmlFieldValueToDouble(nvmlFieldValue_t *v)
-{
-    long long retVal = 0;
-
-    switch (v->valueType)
+    for (auto const &task : pending)
     {
-        case NVML_VALUE_TYPE_DOUBLE:
-            return (double)v->value.dVal;
-
-        case NVML_VALUE_TYPE_UNSIGNED_INT:
-            return (double)v->value.uiVal;
-
-        case NVML_VALUE_TYPE_UNSIGNED_LONG:
-            return (double)v->value.ulVal;
-
-        case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG:
-            return (double)v->value.ullVal;
-
-        case NVML_VALUE_TYPE_SIGNED_LONG_LONG:
-            return (double)v->value.sllVal;
-
-        default:
-            log_error("Unhandled valueType: {}", (int)v->valueType);
-            return retVal;
+        task.wait();
     }
 
-    return retVal;
-}
-
-/*****************************************************************************/
-long long NvmlFieldValueToInt64(nvmlFieldValue_t *v)
-{
-    long long retVal = 0;
-
-    switch (v->valueType)
+    /* Notify subscribers from this thread so callbacks are still only made from the cache manager's main thread */
+    for (auto const &threadCtx : threadCtxs)
     {
-        case NVML_VALUE_TYPE_DOUBLE:
-            return (long long)v->value.dVal;
-
-        case NVML_VALUE_TYPE_UNSIGNED_INT:
-            return (long long)v->value.uiVal;
-
-        case NVML_VALUE_TYPE_UNSIGNED_LONG:
-            return (long long)v->value.ulVal;
+        if (threadCtx->fvBuffer)
+        {
+            UpdateFvSubscribers(threadCtx.get());
+        }
+        FreeThreadCtx(threadCtx.get());
+    }
 
-        case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG:
-            return (long long)v->value.ullVal;
+    return snapshotId;
+}
 
-        case NVML_VALUE_TYPE_SIGNED_LONG_LONG:
-            return (long long)v->value.sllVal;
+/*****************************************************************************/
+unsigned int DcgmCacheManager::GetWatchUpdateShard(dcgmcm_watch_info_p watchInfo) const
+{
+    unsigned int const gpuId = GetWatchGpuId(watchInfo);
 
-        default:
-            log_error("Unhandled valueType: {}", (int)v->valueType);
-            return retVal;
+    /* GPUs that were added after the workers were started (fake GPUs) and entities we
+       can't resolve are updated by the main thread */
+    if (gpuId >= m_updateWorkers.size())
+    {
+        return DCGM_CM_UPDATE_SHARD_NON_GPU;
     }
 
-    return retVal;
+    return gpuId;
 }
 
-void DcgmCacheManager::InsertNvmlErrorValue(dcgmcm_update_thread_t *threadCtx,
-                                            unsigned char fieldType,
-                                            nvmlReturn_t err,
-                                            timelib64_t maxAgeUsec)
-
+/*****************************************************************************/
+unsigned int DcgmCacheManager::GetWatchGpuId(dcgmcm_watch_info_p watchInfo) const
 {
-    timelib64_t now            = timelib_usecSince1970();
-    timelib64_t oldestKeepTime = 0;
-
-    if (maxAgeUsec)
-        oldestKeepTime = now - maxAgeUsec;
+    unsigned int gpuId = DCGM_GPU_ID_BAD;
+    dcgmReturn_t ret   = DCGM_ST_OK;
 
-    /* Append a blank value of the correct type for our fieldId */
-    switch (fieldType)
+    switch (watchInfo->practicalEntityGroupId)
     {
-        case DCGM_FT_DOUBLE:
-            AppendEntityDouble(threadCtx, NvmlErrorToDoubleValue(err), 0, now, oldestKeepTime);
+        case DCGM_FE_GPU:
+            gpuId = watchInfo->practicalEntityId;
             break;
 
-        case DCGM_FT_INT64:
-            AppendEntityInt64(threadCtx, NvmlErrorToInt64Value(err), 0, now, oldestKeepTime);
+        case DCGM_FE_GPU_I:
+            ret = m_migManager.GetGpuIdFromInstanceId(DcgmNs::Mig::GpuInstanceId { watchInfo->practicalEntityId },
+                                                      gpuId);
             break;
 
-        case DCGM_FT_STRING:
-            AppendEntityString(threadCtx, NvmlErrorToStringValue(err), now, oldestKeepTime);
+        case DCGM_FE_GPU_CI:
+            ret = m_migManager.GetGpuIdFromComputeInstanceId(
+                DcgmNs::Mig::ComputeInstanceId { watchInfo->practicalEntityId }, gpuId);
             break;
 
         default:
-            log_error("Field Type {} is unsupported for conversion from NVML errors", fieldType);
-            break;
+            return DCGM_GPU_ID_BAD;
+    }
+
+    if (ret != DCGM_ST_OK || gpuId >= DCGM_MAX_NUM_DEVICES)
+    {
+        return DCGM_GPU_ID_BAD;
     }
+
+    return gpuId;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::ActuallyUpdateGpuFieldValues(dcgmcm_update_thread_t *threadCtx, unsigned int gpuId)
+void DcgmCacheManager::RecordGpuDriverCall(unsigned int gpuId, timelib64_t elapsedUsec)
 {
-    nvmlFieldValue_t values[NVML_FI_MAX]; /* Place to store actual NVML field values */
-    nvmlFieldValue_t *fv;                 /* Cached field value pointer */
-    int i;
-    nvmlReturn_t nvmlReturn;
-    timelib64_t expireTime;
+    if (m_breakerTimeoutUsec == 0 || gpuId >= DCGM_MAX_NUM_DEVICES)
+    {
+        return;
+    }
 
-    /* Make local variables for threadCtx members to simplify the code */
-    int numFields                  = threadCtx->numFieldValues[gpuId];
-    dcgm_field_meta_p *fieldMeta   = threadCtx->fieldValueFields[gpuId];
-    dcgmcm_watch_info_p *watchInfo = threadCtx->fieldValueWatchInfo[gpuId];
+    dcgmcm_gpu_breaker_t &breaker = m_gpuBreakers[gpuId];
 
-    if (m_nvmlLoaded == false)
+    if (elapsedUsec <= m_breakerTimeoutUsec)
     {
-        log_error("Cannot update NVML values: NVML isn't loaded.");
-        return DCGM_ST_NVML_NOT_LOADED;
+        /* Only touch the shared state if there's something to reset */
+        if (breaker.consecutiveTimeouts.load(std::memory_order_relaxed) != 0)
+        {
+            breaker.consecutiveTimeouts = 0;
+        }
+        if (breaker.quarantined.load(std::memory_order_relaxed) && breaker.quarantined.exchange(false))
+        {
+            log_info("Driver calls to gpuId {} complete in time again. Ending its quarantine", gpuId);
+            m_entityStatuses.SetGpuQuarantined(gpuId, false);
+        }
+        return;
     }
 
-    if (gpuId >= m_numGpus)
-        return DCGM_ST_GENERIC_ERROR;
+    unsigned int const timeouts = ++breaker.consecutiveTimeouts;
+    log_warning("A driver call to gpuId {} took {} usec. {} timeouts in a row", gpuId, elapsedUsec, timeouts);
 
-    if (numFields >= NVML_FI_MAX)
+    if (timeouts >= m_breakerThreshold && !breaker.quarantined.exchange(true))
     {
-        log_fatal("numFieldValueFields {} > NVML_FI_MAX", numFields);
-        return DCGM_ST_BADPARAM;
+        m_entityStatuses.SetGpuQuarantined(gpuId, true);
+        breaker.nextProbeUsec = timelib_usecSince1970() + c_breakerProbeIntervalUsec;
+        log_error("Quarantining gpuId {} after {} driver call timeouts in a row. It will only be probed every {} usec",
+                  gpuId,
+                  timeouts,
+                  c_breakerProbeIntervalUsec);
     }
+}
 
-    /* Initialize the values[] array */
-    memset(&values[0], 0, sizeof(values[0]) * numFields);
-    for (i = 0; i < numFields; i++)
+/*****************************************************************************/
+bool DcgmCacheManager::SkipQuarantinedGpu(unsigned int gpuId, timelib64_t now)
+{
+    if (gpuId >= DCGM_MAX_NUM_DEVICES || !m_gpuBreakers[gpuId].quarantined.load(std::memory_order_relaxed))
     {
-        values[i].fieldId = fieldMeta[i]->nvmlFieldId;
+        return false;
     }
 
-    if (m_skipDriverCalls)
+    dcgmcm_gpu_breaker_t &breaker = m_gpuBreakers[gpuId];
+    long long nextProbeUsec       = breaker.nextProbeUsec;
+    if (now < nextProbeUsec)
     {
-        threadCtx->entityKey.entityGroupId = DCGM_FE_GPU;
-        threadCtx->entityKey.entityId      = gpuId;
+        return true;
+    }
 
-        // Insert blank values in all requested fields
-        for (i = 0; i < numFields; i++)
-        {
-            fv                           = &values[i];
-            threadCtx->entityKey.fieldId = fieldMeta[i]->fieldId;
-            threadCtx->watchInfo         = watchInfo[i];
+    /* Let only the caller that wins the update through as the probe */
+    return !breaker.nextProbeUsec.compare_exchange_strong(nextProbeUsec, now + c_breakerProbeIntervalUsec);
+}
 
-            InsertNvmlErrorValue(threadCtx,
-                                 fieldMeta[i]->fieldType,
-                                 NVML_ERROR_UNKNOWN,
-                                 watchInfo[i] != nullptr ? watchInfo[i]->maxAgeUsec : 0);
-            log_error(
-                "Cannot retrieve value for fieldId {} due to detected driver timeout error, inserting blank value instead.",
-                fieldMeta[i]->fieldId);
-        }
-        return DCGM_ST_NVML_DRIVER_TIMEOUT;
+/*****************************************************************************/
+static bool IsMemoryErrorField(unsigned short fieldId)
+{
+    return (fieldId >= DCGM_FI_DEV_ECC_SBE_VOL_TOTAL && fieldId <= DCGM_FI_DEV_ECC_DBE_AGG_TEX)
+           || (fieldId >= DCGM_FI_DEV_BANKS_REMAP_ROWS_AVAIL_MAX && fieldId <= DCGM_FI_DEV_ROW_REMAP_PENDING);
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::SkipUnchangedMemoryErrorWatch(dcgmcm_watch_info_p watchInfo, timelib64_t now)
+{
+    if (!m_eventDrivenMemoryErrors || watchInfo->practicalEntityGroupId != DCGM_FE_GPU
+        || !IsMemoryErrorField(watchInfo->watchKey.fieldId))
+    {
+        return false;
     }
 
-    // Do not attempt to poll NVML for values of detached GPUs
-    if (m_gpus[gpuId].status != DcgmEntityStatusDetached && m_gpus[gpuId].status != DcgmEntityStatusFake
-        && m_gpus[gpuId].status != DcgmEntityStatusLost)
+    unsigned int const gpuId = watchInfo->practicalEntityId;
+    if (gpuId >= DCGM_MAX_NUM_DEVICES || !m_memoryErrorEventsRegistered[gpuId])
     {
-        /* The fieldId field of fieldValueValues[] was already populated above. Make the NVML call */
-        nvmlReturn = nvmlDeviceGetFieldValues(m_gpus[gpuId].nvmlDevice, numFields, &values[0]);
-        if (nvmlReturn != NVML_SUCCESS)
-        {
-            /* Any given field failure will be on a single fieldValueValues[] entry. A global failure is
-             * unexpected */
-            log_error("Unexpected NVML return {} from nvmlDeviceGetFieldValues", nvmlReturn);
-            return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
-        }
+        return false;
     }
 
-    /* Set thread context variables that won't change */
-    threadCtx->entityKey.entityGroupId = DCGM_FE_GPU;
-    threadCtx->entityKey.entityId      = gpuId;
+    /* An event that arrived while the driver was last read counts as newer than the read */
+    timelib64_t const lastEventUsec = m_memoryErrorEventUsec[gpuId].load(std::memory_order_relaxed);
+    if (watchInfo->lastDriverReadUsec != 0 && lastEventUsec < watchInfo->lastDriverReadUsec
+        && now - watchInfo->lastDriverReadUsec < m_memoryErrorSafetyPollUsec)
+    {
+        watchInfo->lastQueriedUsec = now;
+        return true;
+    }
 
-    for (i = 0; i < numFields; i++)
+    watchInfo->lastDriverReadUsec = now;
+    return false;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::MarkMemoryErrorEvent(unsigned int gpuId, timelib64_t now)
+{
+    if (gpuId < DCGM_MAX_NUM_DEVICES)
     {
-        fv = &values[i];
+        m_memoryErrorEventUsec[gpuId].store(now, std::memory_order_relaxed);
+    }
+}
 
-        /* Set threadCtx variables before we possibly use them */
-        threadCtx->entityKey.fieldId = fieldMeta[i]->fieldId;
-        threadCtx->watchInfo         = watchInfo[i];
+/*****************************************************************************/
+timelib64_t DcgmCacheManager::RunShardedUpdateCycle(dcgmcm_update_thread_t *threadCtx)
+{
+    timelib64_t earliestNextUpdate = 0;
+    std::vector<DcgmCacheManagerUpdateWorker *> cycleWorkers; /* Workers that were given this cycle */
 
-        if (m_gpus[gpuId].status == DcgmEntityStatusDetached || m_gpus[gpuId].status == DcgmEntityStatusFake
-            || m_gpus[gpuId].status == DcgmEntityStatusLost)
+    {
+        std::lock_guard<std::mutex> lg(m_updateWorkerMutex);
+        m_updateWorkerCycle++;
+        m_updateWorkersPending = 0;
+
+        timelib64_t const now = timelib_usecSince1970();
+        for (auto const &worker : m_updateWorkers)
         {
-            // Detached GPUs get an intentional NVML error and we're done
-            // Treating Fake GPUs as lost GPUs too since NVML has no idea about them
+            /* A worker that is still stuck in the driver from an earlier cycle is left alone. Every cycle it
+               misses counts as another timeout of its GPU */
+            if (worker->m_busy)
+            {
+                RecordGpuDriverCall(worker->m_gpuId, now - worker->m_cycleStartUsec);
+                continue;
+            }
 
-            InsertNvmlErrorValue(threadCtx,
-                                 fieldMeta[i]->fieldType,
-                                 NVML_ERROR_GPU_IS_LOST,
-                                 watchInfo[i] != nullptr ? watchInfo[i]->maxAgeUsec : 0);
-            DCGM_LOG_WARNING << "Wrote blank value for fieldId " << fieldMeta[i]->fieldId << ", gpuId " << gpuId
-                             << ", status " << m_gpus[gpuId].status;
-            continue;
+            /* Idle workers can't touch their contexts, so it's safe to do it here */
+            if (!worker->m_threadCtx->fvBuffer && m_haveAnyLiveSubscribers)
+            {
+                worker->m_threadCtx->fvBuffer = new DcgmFvBuffer();
+            }
+
+            worker->m_assignedCycle = m_updateWorkerCycle;
+            worker->m_busy          = true;
+            m_updateWorkersPending++;
+            cycleWorkers.push_back(worker.get());
         }
+    }
+    m_updateWorkerCond.notify_all();
 
-        /* We need a timestamp on every FV or we'll just keep saving it over and over */
-        if (!fv->timestamp)
+    /* Update everything that isn't owned by a GPU while the workers update their GPUs */
+    {
+        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+        ActuallyUpdateAllFields(threadCtx, &earliestNextUpdate, DCGM_CM_UPDATE_SHARD_NON_GPU);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_updateWorkerMutex);
+        /* Workers exit without finishing their cycle if they are stopped. Don't wait for them in that case */
+        auto const cycleDone = [this] { return m_updateWorkersPending == 0 || ShouldStop(); };
+        if (m_breakerTimeoutUsec == 0)
         {
-            log_debug("gpuId {}, fieldId {}, index {} had a null timestamp.", gpuId, fv->fieldId, i);
-            fv->timestamp = timelib_usecSince1970();
+            m_updateWorkerCond.wait(lock, cycleDone);
+        }
+        else if (!m_updateWorkerCond.wait_for(lock, std::chrono::microseconds(m_breakerTimeoutUsec), cycleDone))
+        {
+            /* Don't let a GPU that hangs in the driver hold up the others. Its worker is skipped until it
+               returns. See the start of the cycle */
+            log_warning("{} update workers didn't finish within {} usec. Moving on without them",
+                        m_updateWorkersPending,
+                        m_breakerTimeoutUsec);
+            m_updateWorkersPending = 0;
+        }
 
-            /* WaR for NVML bug 2009232 where fields ECC can be left uninitialized if ECC is disabled */
+        std::erase_if(cycleWorkers, [](DcgmCacheManagerUpdateWorker const *worker) { return worker->m_busy; });
 
-            if (!fv->latencyUsec
-                && fv->valueType == NVML_VALUE_TYPE_DOUBLE /* 0 */ && fv->fieldId >= NVML_FI_DEV_ECC_CURRENT
-                && fv->fieldId <= NVML_FI_DEV_RETIRED_PENDING)
+        for (auto const *worker : cycleWorkers)
+        {
+            if (worker->m_earliestNextUpdate
+                && (!earliestNextUpdate || worker->m_earliestNextUpdate < earliestNextUpdate))
             {
-                if (fv->fieldId > NVML_FI_DEV_ECC_PENDING)
-                    fv->nvmlReturn = NVML_ERROR_NOT_SUPPORTED;
-                else
-                {
-                    /* Read current/pending manually so that they have a valid value */
-                    nvmlEnableState_t currentIsEnabled, pendingIsEnabled;
-                    fv->nvmlReturn
-                        = nvmlDeviceGetEccMode(m_gpus[gpuId].nvmlDevice, &currentIsEnabled, &pendingIsEnabled);
-                    fv->valueType = NVML_VALUE_TYPE_UNSIGNED_LONG_LONG;
-                    if (fv->fieldId == NVML_FI_DEV_ECC_CURRENT)
-                        fv->value.ullVal = currentIsEnabled;
-                    else
-                        fv->value.ullVal = pendingIsEnabled;
-                }
+                earliestNextUpdate = worker->m_earliestNextUpdate;
             }
         }
+    }
 
-        /* Expiration is either measured in absolute time or 0 */
-        expireTime = 0;
-        if (watchInfo[i])
+    /* Notify subscribers from this thread so callbacks are still only made from the
+       cache manager's main thread. Samples that busy workers cache after we moved on aren't pushed
+       to live subscribers */
+    for (auto const *worker : cycleWorkers)
+    {
+        if (worker->m_threadCtx->fvBuffer)
         {
-            if (watchInfo[i]->maxAgeUsec)
-            {
-                expireTime = fv->timestamp - watchInfo[i]->maxAgeUsec;
-            }
-            watchInfo[i]->execTimeUsec += fv->latencyUsec;
-            watchInfo[i]->fetchCount++;
-            watchInfo[i]->lastQueriedUsec = fv->timestamp;
-            watchInfo[i]->lastStatus      = fv->nvmlReturn;
+            UpdateFvSubscribers(worker->m_threadCtx);
         }
+    }
 
-        /* WAR for NVML Bug 2032468. Force the valueType to unsigned long long for ECC fields, because NVML
-         * isn't setting them and it's defaulting to a double which doesn't get stored properly. */
-        if ((threadCtx->entityKey.fieldId <= DCGM_FI_DEV_ECC_DBE_AGG_TEX)
-            && (threadCtx->entityKey.fieldId >= DCGM_FI_DEV_ECC_CURRENT))
+    return earliestNextUpdate;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::UpdateWorkerMain(DcgmCacheManagerUpdateWorker *updateWorker)
+{
+    timelib64_t earliestNextUpdate = 0;
+
+    {
+        std::unique_lock<std::mutex> lock(m_updateWorkerMutex);
+        m_updateWorkerCond.wait(lock, [updateWorker] {
+            return updateWorker->m_lastCycle != updateWorker->m_assignedCycle || updateWorker->ShouldStop();
+        });
+
+        if (updateWorker->ShouldStop())
         {
-            fv->valueType = NVML_VALUE_TYPE_UNSIGNED_LONG_LONG;
+            updateWorker->m_busy = false;
+            return;
         }
 
-        if (fv->nvmlReturn != NVML_SUCCESS)
+        updateWorker->m_lastCycle      = updateWorker->m_assignedCycle;
+        updateWorker->m_cycleStartUsec = timelib_usecSince1970();
+    }
+
+    /* ActuallyUpdateAllFields needs a locked mutex. It will drop it around driver calls,
+       which is what allows the workers to be in the driver at the same time */
+    {
+        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+        ActuallyUpdateAllFields(updateWorker->m_threadCtx, &earliestNextUpdate, updateWorker->m_gpuId);
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_updateWorkerMutex);
+        updateWorker->m_earliestNextUpdate = earliestNextUpdate;
+        updateWorker->m_busy               = false;
+        /* The main thread stops counting us if we took longer than the breaker timeout */
+        if (updateWorker->m_lastCycle == m_updateWorkerCycle && m_updateWorkersPending > 0)
         {
-            /* Store an appropriate error for the destination type */
-            timelib64_t maxAgeUsec = DCGM_MAX_AGE_USEC_DEFAULT;
-            if (watchInfo[i])
-                maxAgeUsec = watchInfo[i]->maxAgeUsec;
-            InsertNvmlErrorValue(threadCtx, fieldMeta[i]->fieldType, fv->nvmlReturn, maxAgeUsec);
+            m_updateWorkersPending--;
         }
-        else /* NVML_SUCCESS */
+    }
+    m_updateWorkerCond.notify_all();
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::WakeUpdateWorkers(void)
+{
+    /* Lock so the wake-up can't slip in between a waiter's predicate check and its wait */
+    {
+        std::lock_guard<std::mutex> lg(m_updateWorkerMutex);
+    }
+    m_updateWorkerCond.notify_all();
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::WakeEventThread(void)
+{
+    /* The kmsg thread is stopped after the event thread, so it's still around */
+    if (m_kmsgThread != nullptr)
+    {
+        m_kmsgThread->WakeXidWaiters();
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::StartUpdateWorkers(void)
+{
+    if (!m_perGpuUpdateWorkers || !m_updateWorkers.empty())
+    {
+        return DCGM_ST_OK;
+    }
+
+    unsigned int numGpus = 0;
+    {
+        DcgmLockGuard dlg(m_mutex);
+        numGpus = m_numGpus;
+    }
+
+    for (unsigned int gpuId = 0; gpuId < numGpus; gpuId++)
+    {
+        auto worker = std::make_unique<DcgmCacheManagerUpdateWorker>(this, gpuId);
+        if (worker->m_threadCtx == nullptr || worker->Start())
         {
-            log_debug("fieldId {} got good value type {}, value {:#X}", fv->fieldId, fv->valueType, fv->value.ullVal);
+            log_error("Unable to start the update worker for gpuId {}", gpuId);
+            StopUpdateWorkers();
+            return DCGM_ST_GENERIC_ERROR;
+        }
+        m_updateWorkers.push_back(std::move(worker));
+    }
 
-            /* Store an appropriate error for the destination type */
-            switch (fieldMeta[i]->fieldType)
-            {
-                case DCGM_FT_INT64:
-                    AppendEntityInt64(threadCtx, NvmlFieldValueToInt64(fv), 0, (timelib64_t)fv->timestamp, expireTime);
-                    break;
+    log_info("Started {} per-GPU cache manager update workers", m_updateWorkers.size());
+    return DCGM_ST_OK;
+}
 
-                case DCGM_FT_DOUBLE:
-                    AppendEntityDouble(
-                        threadCtx, NvmlFieldValueToDouble(fv), 0.0, (timelib64_t)fv->timestamp, expireTime);
-                    break;
+/*****************************************************************************/
+void DcgmCacheManager::StopUpdateWorkers(void)
+{
+    for (auto &worker : m_updateWorkers)
+    {
+        /* StopThread() frees the thread. Hand our ownership over to it */
+        StopThread(worker.release());
+    }
+
+    m_updateWorkers.clear();
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::StartGpuEventThreads(void)
+{
+    if (!m_perGpuEventThreads || !m_gpuEventThreads.empty())
+    {
+        return DCGM_ST_OK;
+    }
+
+    unsigned int numGpus = 0;
+    {
+        DcgmLockGuard dlg(m_mutex);
+        numGpus = m_numGpus;
+    }
 
-                default:
-                    log_error("Unhandled field value output type: {}", fieldMeta[i]->fieldType);
-                    break;
-            }
+    for (unsigned int gpuId = 0; gpuId < numGpus; gpuId++)
+    {
+        /* GPUs without a set, like fake GPUs, never get an event */
+        if (!m_gpuEventSetInitialized[gpuId])
+        {
+            continue;
+        }
+
+        auto eventThread = std::make_unique<DcgmCacheManagerGpuEventThread>(this, gpuId);
+        if (eventThread->Start())
+        {
+            log_error("Unable to start the event thread for gpuId {}", gpuId);
+            StopGpuEventThreads();
+            return DCGM_ST_GENERIC_ERROR;
         }
+        m_gpuEventThreads.push_back(std::move(eventThread));
     }
 
+    log_info("Started {} per-GPU cache manager event threads", m_gpuEventThreads.size());
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-void DcgmCacheManager::ClearWatchInfo(dcgmcm_watch_info_p watchInfo, int clearCache)
+void DcgmCacheManager::StopGpuEventThreads(void)
 {
-    if (!watchInfo)
-        return;
-
-    watchInfo->watchers.clear();
-    watchInfo->isWatched           = 0;
-    watchInfo->pushedByModule      = false;
-    watchInfo->monitorIntervalUsec = 0;
-    watchInfo->maxAgeUsec          = DCGM_MAX_AGE_USEC_DEFAULT;
-    watchInfo->lastQueriedUsec     = 0;
-    if (watchInfo->timeSeries && clearCache)
+    for (auto &eventThread : m_gpuEventThreads)
     {
-        timeseries_destroy(watchInfo->timeSeries);
-        watchInfo->timeSeries = 0;
+        /* StopThread() frees the thread. Hand our ownership over to it */
+        StopThread(eventThread.release());
     }
+
+    m_gpuEventThreads.clear();
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::ClearAllEntities(int clearCache)
+void DcgmCacheManager::GetGpuUuidsForSnapshot(std::vector<std::string> &gpuUuids)
 {
-    dcgmcm_watch_info_p watchInfo = 0;
-    dcgmMutexReturn_t mutexReturn;
-    int numCleared = 0;
-
-    mutexReturn = dcgm_mutex_lock_me(m_mutex);
-
-    /* Walk the watch table and clear every entry */
-    for (void *hashIter = hashtable_iter(m_entityWatchHashTable); hashIter;
-         hashIter       = hashtable_iter_next(m_entityWatchHashTable, hashIter))
+    gpuUuids.clear();
+    for (unsigned int i = 0; i < m_numGpus; i++)
     {
-        numCleared++;
-        watchInfo = (dcgmcm_watch_info_p)hashtable_iter_value(hashIter);
-        ClearWatchInfo(watchInfo, clearCache);
+        gpuUuids.emplace_back(m_gpus[i].uuid);
     }
-
-    if (mutexReturn == DCGM_MUTEX_ST_OK)
-        dcgm_mutex_unlock(m_mutex);
-
-    log_debug("ClearAllEntities clearCache {}, numCleared {}", clearCache, numCleared);
-
-    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::ClearEntity(dcgm_field_entity_group_t entityGroupId,
-                                           dcgm_field_eid_t entityId,
-                                           int clearCache)
+dcgmReturn_t DcgmCacheManager::SaveSnapshot()
 {
-    dcgmcm_watch_info_p watchInfo = 0;
-    dcgmMutexReturn_t mutexReturn;
-    int numMatched = 0;
-    int numScanned = 0;
+    DcgmCacheSnapshot snapshot;
 
-    mutexReturn = dcgm_mutex_lock_me(m_mutex);
-
-    /* Walk the watch table and clear anything that points at this entityGroup + entityId combo */
-    for (void *hashIter = hashtable_iter(m_entityWatchHashTable); hashIter;
-         hashIter       = hashtable_iter_next(m_entityWatchHashTable, hashIter))
     {
-        numScanned++;
-        watchInfo = (dcgmcm_watch_info_p)hashtable_iter_value(hashIter);
-        if (watchInfo == nullptr)
-        {
-            continue;
-        }
+        DcgmLockGuard dlg(m_mutex);
 
-        if (watchInfo->watchKey.entityGroupId != entityGroupId || watchInfo->watchKey.entityId != entityId)
+        snapshot.driverVersion = m_driverVersion;
+        GetGpuUuidsForSnapshot(snapshot.gpuUuids);
+
+        for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
         {
-            continue; /* Not a match */
-        }
+            if (watchInfo->pushedByModule)
+            {
+                continue;
+            }
 
-        numMatched++;
-        ClearWatchInfo(watchInfo, clearCache);
-    }
+            /* Other entity ids aren't guaranteed to be stable across a restart */
+            if (watchInfo->watchKey.entityGroupId != DCGM_FE_NONE && watchInfo->watchKey.entityGroupId != DCGM_FE_GPU)
+            {
+                continue;
+            }
 
-    if (mutexReturn == DCGM_MUTEX_ST_OK)
-        dcgm_mutex_unlock(m_mutex);
+            dcgmcm_snapshot_watch_t watch {};
+            watch.watchKey            = watchInfo->watchKey;
+            watch.monitorIntervalUsec = watchInfo->monitorIntervalUsec;
+            watch.maxAgeUsec          = watchInfo->maxAgeUsec;
 
-    log_debug("ClearEntity eg {}, eid {}, clearCache {}, numScanned {}, numMatched {}",
-              entityGroupId,
-              entityId,
-              clearCache,
-              numScanned,
-              numMatched);
+            /* Watchers tied to a client connection go away with the connection */
+            for (auto const &watcherInfo : watchInfo->watchers)
+            {
+                if (watcherInfo.watcher.connectionId == DCGM_CONNECTION_ID_NONE)
+                {
+                    watch.watcherTypes.push_back(watcherInfo.watcher.watcherType);
+                }
+            }
 
-    return DCGM_ST_OK;
+            timeseries_p timeseries = watchInfo->timeSeries;
+            if (timeseries && (timeseries->tsType == TS_TYPE_INT64 || timeseries->tsType == TS_TYPE_DOUBLE))
+            {
+                kv_cursor_t cursor;
+                watch.tsType = timeseries->tsType;
+
+                for (timeseries_entry_p entry = timeseries_last(timeseries, &cursor);
+                     entry && watch.samples.size() < DCGMCM_SNAPSHOT_MAX_SAMPLES;
+                     entry = timeseries_prev(timeseries, &cursor))
+                {
+                    dcgmcm_snapshot_sample_t sample {};
+                    sample.timestamp = entry->usecSince1970;
+                    memcpy(&sample.value, &entry->val, sizeof(sample.value));
+                    memcpy(&sample.value2, &entry->val2, sizeof(sample.value2));
+                    watch.samples.push_back(sample);
+                }
+                std::reverse(watch.samples.begin(), watch.samples.end());
+            }
+
+            if (watch.watcherTypes.empty() && watch.samples.empty())
+            {
+                continue;
+            }
+
+            snapshot.watches.push_back(std::move(watch));
+        }
+    }
+
+    /* The file is written without holding the lock */
+    return snapshot.WriteToFile(m_snapshotPath);
 }
 
 /*****************************************************************************/
-timelib64_t DcgmCacheManager::DoOneUpdateAllFields(void)
+dcgmReturn_t DcgmCacheManager::LoadSnapshot()
 {
-    timelib64_t earliestNextUpdate    = 0;
-    dcgmcm_update_thread_t *threadCtx = m_updateThreadCtx;
+    DcgmCacheSnapshot snapshot;
+    std::vector<std::string> gpuUuids;
 
-    assert(threadCtx != nullptr);
+    dcgmReturn_t ret = snapshot.ReadFromFile(m_snapshotPath);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
 
-    /* If we haven't allocated fvBuffer yet, do so only if there are any live subscribers */
-    if (!threadCtx->fvBuffer && m_haveAnyLiveSubscribers)
     {
-        /* Buffer live updates for subscribers */
-        threadCtx->fvBuffer = new DcgmFvBuffer();
+        DcgmLockGuard dlg(m_mutex);
+        GetGpuUuidsForSnapshot(gpuUuids);
     }
 
-    /* ActuallyUpdateAllFields needs a locked mutex */
+    if (!snapshot.Matches(m_driverVersion, gpuUuids))
     {
-        DcgmLockGuard dlg = DcgmLockGuard(m_mutex);
+        log_info("Ignoring cache snapshot {} from driver {} with {} GPUs. Current driver is {} with {} GPUs",
+                 m_snapshotPath,
+                 snapshot.driverVersion,
+                 snapshot.gpuUuids.size(),
+                 m_driverVersion,
+                 gpuUuids.size());
+        return DCGM_ST_NO_DATA;
+    }
 
-        /* Try to update all fields */
-        earliestNextUpdate = 0;
-        ActuallyUpdateAllFields(threadCtx, &earliestNextUpdate);
+    /* Re-establish the watches first so that the samples land in timeseries sized for them */
+    for (auto const &watch : snapshot.watches)
+    {
+        for (auto watcherType : watch.watcherTypes)
+        {
+            bool wereFirstWatcher = false;
+
+            ret = AddFieldWatch((dcgm_field_entity_group_t)watch.watchKey.entityGroupId,
+                                watch.watchKey.entityId,
+                                watch.watchKey.fieldId,
+                                watch.monitorIntervalUsec,
+                                (double)watch.maxAgeUsec / 1000000.0,
+                                0,
+                                DcgmWatcher(watcherType),
+                                false,
+                                false,
+                                wereFirstWatcher);
+            if (ret != DCGM_ST_OK)
+            {
+                log_warning("Unable to restore watch of eg {} eid {} fieldId {}: {}",
+                            watch.watchKey.entityGroupId,
+                            watch.watchKey.entityId,
+                            watch.watchKey.fieldId,
+                            errorString(ret));
+            }
+        }
     }
 
-    if (threadCtx->fvBuffer)
-        UpdateFvSubscribers(threadCtx);
+    size_t numSamples = 0;
+    DcgmLockGuard dlg(m_mutex);
 
-    m_runStats.updateCycleFinished++;
+    for (auto const &watch : snapshot.watches)
+    {
+        if (watch.samples.empty() || (watch.tsType != TS_TYPE_INT64 && watch.tsType != TS_TYPE_DOUBLE))
+        {
+            continue;
+        }
 
-    return earliestNextUpdate;
+        auto entityGroupId            = (dcgm_field_entity_group_t)watch.watchKey.entityGroupId;
+        dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(entityGroupId, watch.watchKey.entityId, watch.watchKey.fieldId, 1);
+        if (!watchInfo || AllocWatchInfoTimeSeries(watchInfo, watch.tsType) != DCGM_ST_OK
+            || watchInfo->timeSeries->tsType != watch.tsType)
+        {
+            continue;
+        }
+
+        for (auto const &sample : watch.samples)
+        {
+            if (watch.tsType == TS_TYPE_DOUBLE)
+            {
+                double value1;
+                double value2;
+                memcpy(&value1, &sample.value, sizeof(value1));
+                memcpy(&value2, &sample.value2, sizeof(value2));
+                timeseries_insert_double(watchInfo->timeSeries, sample.timestamp, value1, value2);
+            }
+            else
+            {
+                timeseries_insert_int64(watchInfo->timeSeries, sample.timestamp, sample.value, sample.value2);
+            }
+        }
+        numSamples += watch.samples.size();
+
+        PublishLatestValue(watchInfo);
+    }
+
+    log_info("Restored {} watches and {} samples from cache snapshot {}",
+             snapshot.watches.size(),
+             numSamples,
+             m_snapshotPath);
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
@@ -6190,6 +9811,24 @@ void DcgmCacheManager::RunWrapped(void)
 
         earliestNextUpdate = DoOneUpdateAllFields();
 
+        if (!m_snapshotPath.empty() && startOfLoop - m_lastSnapshotUsec >= m_snapshotIntervalUsec)
+        {
+            m_lastSnapshotUsec = startOfLoop;
+            (void)SaveSnapshot();
+        }
+
+        if (startOfLoop - m_lastMemoryBudgetCheckUsec >= c_memoryBudgetCheckIntervalUsec)
+        {
+            m_lastMemoryBudgetCheckUsec = startOfLoop;
+            EnforceMemoryBudget();
+        }
+
+        if (startOfLoop - m_lastNvLinkStateRefreshUsec >= c_nvLinkStateRefreshIntervalUsec)
+        {
+            m_lastNvLinkStateRefreshUsec = startOfLoop;
+            RefreshNvLinkLinkStates();
+        }
+
         /* Resync */
         now = timelib_usecSince1970();
         m_runStats.awakeTimeUsec += (now - startOfLoop);
@@ -6224,8 +9863,13 @@ void DcgmCacheManager::RunWrapped(void)
             continue;
         }
 
-        sleepAtATimeMs       = diff / 1000;
-        m_runStats.lockCount = m_mutex->GetLockCount();
+        sleepAtATimeMs                   = diff / 1000;
+        m_runStats.lockCount             = m_mutex->GetLockCount();
+        m_runStats.lockContendedCount    = m_mutex->GetContendedCount();
+        m_runStats.lockContendedWaitUsec = m_mutex->GetContendedWaitUsec();
+        m_runStats.latestValueHits       = m_latestValues.GetHitCount();
+        m_runStats.latestValueMisses     = m_latestValues.GetMissCount();
+        m_runStats.latestValueContended  = m_latestValues.GetContendedCount();
         m_runStats.numSleepsDone++;
         /* Note: sleepTimeUsec is measured above in the loop */
         SetRunInterval(std::chrono::milliseconds(sleepAtATimeMs));
@@ -6235,20 +9879,22 @@ void DcgmCacheManager::RunWrapped(void)
 /*****************************************************************************/
 void DcgmCacheManager::run(void)
 {
-    m_updateThreadCtx = (dcgmcm_update_thread_t *)malloc(sizeof(*m_updateThreadCtx));
-    if (m_updateThreadCtx == nullptr)
+    /* From the update thread itself so that a NUMA-local cachealloc pool places it on this thread's node */
+    void *updateThreadCtxMem = cachealloc_malloc(sizeof(*m_updateThreadCtx));
+    if (updateThreadCtxMem == nullptr)
     {
         log_error("Unable to alloc updateThreadCtx. Exiting update thread");
         return;
     }
-    memset(m_updateThreadCtx, 0, sizeof(*m_updateThreadCtx));
+    m_updateThreadCtx = new (updateThreadCtxMem) dcgmcm_update_thread_t {};
 
     log_info("Cache manager update thread starting");
 
     RunWrapped();
 
     FreeThreadCtx(m_updateThreadCtx);
-    free(m_updateThreadCtx);
+    m_updateThreadCtx->~dcgmcm_update_thread_t();
+    cachealloc_free(m_updateThreadCtx);
 
     log_info("Cache manager update thread ending");
 }
@@ -6337,7 +9983,7 @@ dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInf
     kv_cursor_t cursor;
     timeseries_entry_p entry = 0;
 
-    fieldInfo->numSamples = keyedvector_size(timeseries->keyedVector);
+    fieldInfo->numSamples = timeseries_size(timeseries);
     if (!fieldInfo->numSamples)
     {
         /* No values yet */
@@ -6348,9 +9994,9 @@ dcgmReturn_t DcgmCacheManager::GetCacheManagerFieldInfo(dcgmCacheManagerFieldInf
     }
 
     /* Get the first and last records to get their timestamps */
-    entry                      = (timeseries_entry_p)keyedvector_first(timeseries->keyedVector, &cursor);
+    entry                      = timeseries_first(timeseries, &cursor);
     fieldInfo->oldestTimestamp = entry == nullptr ? 0 : entry->usecSince1970;
-    entry                      = (timeseries_entry_p)keyedvector_last(timeseries->keyedVector, &cursor);
+    entry                      = timeseries_last(timeseries, &cursor);
     fieldInfo->newestTimestamp = entry->usecSince1970;
 
     dcgm_mutex_unlock(m_mutex);
@@ -6384,6 +10030,71 @@ void DcgmCacheManager::MarkSubscribersInThreadCtx(dcgmcm_update_thread_t *thread
     }
 }
 
+/*****************************************************************************/
+/* Is fieldId a per-process field whose watches keep a DcgmProcessStatsIndex? */
+static bool IsProcessStatsIndexedField(unsigned short fieldId)
+{
+    switch (fieldId)
+    {
+        case DCGM_FI_DEV_ACCOUNTING_DATA:
+        case DCGM_FI_DEV_GPU_UTIL_SAMPLES:
+        case DCGM_FI_DEV_MEM_COPY_UTIL_SAMPLES:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::CanAppendSampleRun(dcgmcm_watch_info_p watchInfo, unsigned char fieldType)
+{
+    int tsType;
+    if (fieldType == DCGM_FT_DOUBLE)
+    {
+        tsType = TS_TYPE_DOUBLE;
+    }
+    else if (fieldType == DCGM_FT_INT64)
+    {
+        tsType = TS_TYPE_INT64;
+    }
+    else
+    {
+        return false;
+    }
+
+    return watchInfo->timeSeries && watchInfo->timeSeries->tsType == tsType && !watchInfo->changeOnly
+           && !m_sampleRollups && !watchInfo->historyIntervalUsec
+           && !IsProcessStatsIndexedField(watchInfo->watchKey.fieldId)
+           && DcgmDerivedFields::GetDefsTriggeredBy(watchInfo->watchKey.fieldId).empty();
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::AppendSampleRun(dcgmcm_watch_info_p watchInfo,
+                                       std::vector<timeseries_entry_t> &run,
+                                       timelib64_t oldestKeepTimestamp)
+{
+    if (run.empty())
+    {
+        return;
+    }
+
+    /* Samples that aren't newer than the ones before them are inserted one at a time by timeseries_append() */
+    int st = timeseries_append(watchInfo->timeSeries, run.data(), (int)run.size());
+    if (st != TS_ST_OK)
+    {
+        log_error("timeseries_append of {} samples returned {} for eg {}, eid {}, fieldId {}",
+                  run.size(),
+                  st,
+                  watchInfo->watchKey.entityGroupId,
+                  watchInfo->watchKey.entityId,
+                  watchInfo->watchKey.fieldId);
+    }
+
+    EnforceWatchInfoQuota(watchInfo, run.back().usecSince1970, oldestKeepTimestamp);
+    PublishLatestValue(watchInfo);
+    run.clear();
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::AppendEntityDouble(dcgmcm_update_thread_t *threadCtx,
                                                   double value1,
@@ -6394,6 +10105,11 @@ dcgmReturn_t DcgmCacheManager::AppendEntityDouble(dcgmcm_update_thread_t *thread
     dcgmReturn_t dcgmReturn;
     dcgmcm_watch_info_p watchInfo = threadCtx->watchInfo;
 
+    if (IsRepeatedSample(watchInfo, value1, value2))
+    {
+        return DCGM_ST_OK;
+    }
+
     if (threadCtx->fvBuffer)
     {
         threadCtx->fvBuffer->AddDoubleValue((dcgm_field_entity_group_t)threadCtx->entityKey.entityGroupId,
@@ -6419,13 +10135,40 @@ dcgmReturn_t DcgmCacheManager::AppendEntityDouble(dcgmcm_update_thread_t *thread
                 dcgm_mutex_unlock(m_mutex);
                 return dcgmReturn;
             }
+
+            if (IsProcessStatsIndexedField(watchInfo->watchKey.fieldId)
+                && watchInfo->timeSeries->tsType == TS_TYPE_DOUBLE)
+            {
+                watchInfo->processStatsIndex = std::make_shared<DcgmProcessStatsIndex>();
+            }
         }
 
         timeseries_insert_double_coerce(watchInfo->timeSeries, timestamp, value1, value2);
+        if (watchInfo->processStatsIndex)
+        {
+            /* value2 is the PID of a process utilization sample */
+            watchInfo->processStatsIndex->AddUtilSample(timestamp, (unsigned int)value2, value1);
+            watchInfo->processStatsIndex->Prune(oldestKeepTimestamp);
+        }
+        if (m_sampleRollups && watchInfo->timeSeries->tsType == TS_TYPE_DOUBLE)
+        {
+            if (!watchInfo->fp64Rollups)
+            {
+                watchInfo->fp64Rollups = std::make_shared<DcgmSampleRollups<double>>();
+            }
+            watchInfo->fp64Rollups->Append(timestamp, value1, DCGM_FP64_IS_BLANK(value1));
+        }
+        AppendHistorySample(watchInfo, timestamp);
         EnforceWatchInfoQuota(watchInfo, timestamp, oldestKeepTimestamp);
+        PublishLatestValue(watchInfo);
 
         if (mutexSt == DCGM_MUTEX_ST_OK)
             dcgm_mutex_unlock(m_mutex);
+
+        if (!DCGM_FP64_IS_BLANK(value1))
+        {
+            UpdateDerivedFields(threadCtx, value1, timestamp);
+        }
     }
 
     log_debug("Appended entity double eg {}, eid {}, fieldId {}, ts {}, value1 {}, value2 {}, cached {}, buffered {}",
@@ -6452,7 +10195,48 @@ dcgmReturn_t DcgmCacheManager::AllocWatchInfoTimeSeries(dcgmcm_watch_info_p watc
     if (watchInfo->timeSeries)
         return DCGM_ST_OK; /* Already alloc'd */
 
-    int errorSt           = 0;
+    int errorSt = 0;
+
+    if (m_compressedTimeSeries && (tsType == TS_TYPE_INT64 || tsType == TS_TYPE_DOUBLE))
+    {
+        watchInfo->timeSeries = timeseries_alloc_compressed(tsType, &errorSt);
+        if (watchInfo->timeSeries)
+        {
+            return DCGM_ST_OK;
+        }
+
+        log_error("timeseries_alloc_compressed(tsType={}) failed with {}", tsType, errorSt);
+    }
+
+    if (m_ringBufferTimeSeries && (tsType == TS_TYPE_INT64 || tsType == TS_TYPE_DOUBLE)
+        && watchInfo->monitorIntervalUsec > 0 && watchInfo->maxAgeUsec > 0)
+    {
+        /* Leave a little headroom for jitter in the update loop. The ring grows if this is exceeded */
+        timelib64_t capacity = (watchInfo->maxAgeUsec / watchInfo->monitorIntervalUsec) + 2;
+        capacity             = std::clamp<timelib64_t>(capacity, DCGMCM_RING_MIN_CAPACITY, DCGMCM_RING_MAX_CAPACITY);
+
+        watchInfo->timeSeries = timeseries_alloc_ring(tsType, (int)capacity, &errorSt);
+        if (watchInfo->timeSeries)
+        {
+            return DCGM_ST_OK;
+        }
+
+        log_error("timeseries_alloc_ring(tsType={}, capacity={}) failed with {}", tsType, capacity, errorSt);
+    }
+
+    /* Static attributes repeat the same value every sample. The arena lets those samples share it */
+    if ((m_sampleArena || DcgmStaticFieldCache::IsStaticField(watchInfo->watchKey.fieldId))
+        && (tsType == TS_TYPE_STRING || tsType == TS_TYPE_BLOB))
+    {
+        watchInfo->timeSeries = timeseries_alloc_arena(tsType, &errorSt);
+        if (watchInfo->timeSeries)
+        {
+            return DCGM_ST_OK;
+        }
+
+        log_error("timeseries_alloc_arena(tsType={}) failed with {}", tsType, errorSt);
+    }
+
     watchInfo->timeSeries = timeseries_alloc(tsType, &errorSt);
     if (!watchInfo->timeSeries)
     {
@@ -6471,15 +10255,63 @@ dcgmReturn_t DcgmCacheManager::EnforceWatchInfoQuota(dcgmcm_watch_info_p watchIn
     if (!watchInfo || !watchInfo->timeSeries)
         return DCGM_ST_OK; /* Nothing to do */
 
-    /* Passing count quota as 0 since we enforce quota by time alone */
-    int st = timeseries_enforce_quota(watchInfo->timeSeries, oldestKeepTimestamp, 0);
-    if (st)
+    /* Passing count quota as 0 since we enforce quota by time alone */
+    int st = timeseries_enforce_quota(watchInfo->timeSeries, oldestKeepTimestamp, 0);
+    if (st)
+    {
+        log_error("timeseries_enforce_quota returned {}", st);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::AppendHistorySample(dcgmcm_watch_info_p watchInfo, timelib64_t timestamp)
+{
+    if (!watchInfo || !watchInfo->historyIntervalUsec || !watchInfo->timeSeries)
+    {
+        return;
+    }
+
+    int const tsType = watchInfo->timeSeries->tsType;
+    if (tsType != TS_TYPE_INT64 && tsType != TS_TYPE_DOUBLE)
+    {
+        return;
+    }
+
+    if (!watchInfo->historyTimeSeries)
+    {
+        int errorSt                  = 0;
+        watchInfo->historyTimeSeries = timeseries_alloc(tsType, &errorSt);
+        if (!watchInfo->historyTimeSeries)
+        {
+            log_error("timeseries_alloc(tsType={}) failed with {} for the history tier", tsType, errorSt);
+            return;
+        }
+    }
+
+    kv_cursor_t cursor;
+    timeseries_entry_p lastKept = timeseries_last(watchInfo->historyTimeSeries, &cursor);
+    if (!lastKept || timestamp - lastKept->usecSince1970 >= watchInfo->historyIntervalUsec)
     {
-        log_error("timeseries_enforce_quota returned {}", st);
-        return DCGM_ST_GENERIC_ERROR;
+        timeseries_entry_p sample = timeseries_last(watchInfo->timeSeries, &cursor);
+        if (sample && tsType == TS_TYPE_INT64)
+        {
+            timeseries_insert_int64(
+                watchInfo->historyTimeSeries, sample->usecSince1970, sample->val.i64, sample->val2.i64);
+        }
+        else if (sample)
+        {
+            timeseries_insert_double(
+                watchInfo->historyTimeSeries, sample->usecSince1970, sample->val.dbl, sample->val2.dbl);
+        }
     }
 
-    return DCGM_ST_OK;
+    if (watchInfo->historyMaxAgeUsec)
+    {
+        timeseries_enforce_quota(watchInfo->historyTimeSeries, timestamp - watchInfo->historyMaxAgeUsec, 0);
+    }
 }
 
 /*****************************************************************************/
@@ -6492,6 +10324,11 @@ dcgmReturn_t DcgmCacheManager::AppendEntityInt64(dcgmcm_update_thread_t *threadC
     dcgmReturn_t dcgmReturn;
     dcgmcm_watch_info_p watchInfo = threadCtx->watchInfo;
 
+    if (IsRepeatedSample(watchInfo, value1, value2))
+    {
+        return DCGM_ST_OK;
+    }
+
     if (threadCtx->fvBuffer)
     {
         threadCtx->fvBuffer->AddInt64Value((dcgm_field_entity_group_t)threadCtx->entityKey.entityGroupId,
@@ -6519,10 +10356,25 @@ dcgmReturn_t DcgmCacheManager::AppendEntityInt64(dcgmcm_update_thread_t *threadC
         }
 
         timeseries_insert_int64_coerce(watchInfo->timeSeries, timestamp, value1, value2);
+        if (m_sampleRollups && watchInfo->timeSeries->tsType == TS_TYPE_INT64)
+        {
+            if (!watchInfo->int64Rollups)
+            {
+                watchInfo->int64Rollups = std::make_shared<DcgmSampleRollups<long long>>();
+            }
+            watchInfo->int64Rollups->Append(timestamp, value1, DCGM_INT64_IS_BLANK(value1));
+        }
+        AppendHistorySample(watchInfo, timestamp);
         EnforceWatchInfoQuota(watchInfo, timestamp, oldestKeepTimestamp);
+        PublishLatestValue(watchInfo);
 
         if (mutexSt == DCGM_MUTEX_ST_OK)
             dcgm_mutex_unlock(m_mutex);
+
+        if (!DCGM_INT64_IS_BLANK(value1))
+        {
+            UpdateDerivedFields(threadCtx, static_cast<double>(value1), timestamp);
+        }
     }
 
     log_debug("Appended entity i64 eg {}, eid {}, fieldId {}, ts {}, value1 {}, value2 {}, cached {}, buffered {}",
@@ -6537,6 +10389,146 @@ dcgmReturn_t DcgmCacheManager::AppendEntityInt64(dcgmcm_update_thread_t *threadC
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+bool DcgmCacheManager::IsRepeatedSample(dcgmcm_watch_info_p watchInfo, long long value1, long long value2)
+{
+    if (!watchInfo || !watchInfo->changeOnly)
+    {
+        return false;
+    }
+
+    DcgmLockGuard dlg(m_mutex);
+
+    if (!watchInfo->timeSeries || watchInfo->timeSeries->tsType != TS_TYPE_INT64)
+    {
+        return false;
+    }
+
+    timeseries_entry_p last = timeseries_last(watchInfo->timeSeries, nullptr);
+    return last && last->val.i64 == value1 && last->val2.i64 == value2;
+}
+
+/*****************************************************************************/
+bool DcgmCacheManager::IsRepeatedSample(dcgmcm_watch_info_p watchInfo, double value1, double value2)
+{
+    if (!watchInfo || !watchInfo->changeOnly)
+    {
+        return false;
+    }
+
+    DcgmLockGuard dlg(m_mutex);
+
+    if (!watchInfo->timeSeries || watchInfo->timeSeries->tsType != TS_TYPE_DOUBLE)
+    {
+        return false;
+    }
+
+    timeseries_entry_p last = timeseries_last(watchInfo->timeSeries, nullptr);
+    return last && last->val.dbl == value1 && last->val2.dbl == value2;
+}
+
+/*****************************************************************************/
+/* Latest sample of a numeric timeSeries as a double. std::nullopt if there is none or it is blank */
+static std::optional<double> LatestNumericSample(timeseries_p timeSeries)
+{
+    timeseries_entry_p last = timeSeries ? timeseries_last(timeSeries, nullptr) : nullptr;
+    if (last == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    if (timeSeries->tsType == TS_TYPE_INT64 && !DCGM_INT64_IS_BLANK(last->val.i64))
+    {
+        return static_cast<double>(last->val.i64);
+    }
+    if (timeSeries->tsType == TS_TYPE_DOUBLE && !DCGM_FP64_IS_BLANK(last->val.dbl))
+    {
+        return last->val.dbl;
+    }
+    return std::nullopt;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::UpdateDerivedFields(dcgmcm_update_thread_t *threadCtx, double value, timelib64_t timestamp)
+{
+    auto const defs = DcgmDerivedFields::GetDefsTriggeredBy(threadCtx->entityKey.fieldId);
+    if (defs.empty())
+    {
+        return;
+    }
+
+    auto const entityGroupId    = static_cast<dcgm_field_entity_group_t>(threadCtx->entityKey.entityGroupId);
+    unsigned int const entityId = threadCtx->entityKey.entityId;
+
+    for (DcgmDerivedFieldDef const *def : defs)
+    {
+        dcgmcm_watch_info_p derivedWatchInfo = nullptr;
+        std::optional<double> result;
+
+        {
+            DcgmLockGuard dlg(m_mutex);
+
+            derivedWatchInfo = GetEntityWatchInfo(entityGroupId, entityId, def->fieldId, 0);
+            if (derivedWatchInfo == nullptr || !derivedWatchInfo->isWatched)
+            {
+                continue;
+            }
+
+            if (def->op == DcgmDerivedOp::Rate)
+            {
+                result = DcgmDerivedFields::EvaluateRate(
+                    *def, derivedWatchInfo->derivedPrevInput, derivedWatchInfo->derivedPrevInputUsec, value, timestamp);
+                derivedWatchInfo->derivedPrevInput     = value;
+                derivedWatchInfo->derivedPrevInputUsec = timestamp;
+            }
+            else if (def->op == DcgmDerivedOp::Duration)
+            {
+                result = DcgmDerivedFields::EvaluateDuration(*def,
+                                                             derivedWatchInfo->derivedPrevInput,
+                                                             derivedWatchInfo->derivedPrevInputUsec,
+                                                             timestamp,
+                                                             derivedWatchInfo->derivedTotal);
+                if (result.has_value())
+                {
+                    derivedWatchInfo->derivedPrevInput     = value;
+                    derivedWatchInfo->derivedPrevInputUsec = timestamp;
+                    derivedWatchInfo->derivedTotal         = *result;
+                }
+            }
+            else
+            {
+                dcgmcm_watch_info_p denominatorWatchInfo
+                    = GetEntityWatchInfo(entityGroupId, entityId, def->inputs[1], 0);
+                std::optional<double> const denominator
+                    = denominatorWatchInfo ? LatestNumericSample(denominatorWatchInfo->timeSeries) : std::nullopt;
+                if (denominator.has_value())
+                {
+                    result = DcgmDerivedFields::EvaluateRatio(*def, value, *denominator);
+                }
+            }
+        }
+
+        if (!result.has_value())
+        {
+            continue;
+        }
+
+        timelib64_t oldestKeepTimestamp = 0;
+        if (derivedWatchInfo->maxAgeUsec)
+        {
+            oldestKeepTimestamp = timestamp - derivedWatchInfo->maxAgeUsec;
+        }
+
+        /* Append as the derived field, then point threadCtx back at the input it was appending */
+        dcgmcm_watch_info_p const inputWatchInfo = threadCtx->watchInfo;
+        threadCtx->watchInfo                     = derivedWatchInfo;
+        threadCtx->entityKey.fieldId             = def->fieldId;
+        AppendEntityDouble(threadCtx, *result, 0, timestamp, oldestKeepTimestamp);
+        threadCtx->watchInfo         = inputWatchInfo;
+        threadCtx->entityKey.fieldId = def->inputs[0];
+    }
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::AppendEntityString(dcgmcm_update_thread_t *threadCtx,
                                                   const char *value,
@@ -6625,9 +10617,25 @@ dcgmReturn_t DcgmCacheManager::AppendEntityBlob(dcgmcm_update_thread_t *threadCt
                 dcgm_mutex_unlock(m_mutex);
                 return dcgmReturn;
             }
+
+            if (IsProcessStatsIndexedField(watchInfo->watchKey.fieldId)
+                && watchInfo->timeSeries->tsType == TS_TYPE_BLOB)
+            {
+                watchInfo->processStatsIndex = std::make_shared<DcgmProcessStatsIndex>();
+            }
         }
 
         timeseries_insert_blob(watchInfo->timeSeries, timestamp, value, valueSize);
+        if (watchInfo->processStatsIndex)
+        {
+            auto const *accountingStats = (dcgmDevicePidAccountingStats_t const *)value;
+            if (valueSize >= (int)sizeof(*accountingStats)
+                && accountingStats->version == dcgmDevicePidAccountingStats_version)
+            {
+                watchInfo->processStatsIndex->AddAccountingStats(timestamp, *accountingStats);
+            }
+            watchInfo->processStatsIndex->Prune(oldestKeepTimestamp);
+        }
         EnforceWatchInfoQuota(watchInfo, timestamp, oldestKeepTimestamp);
 
         if (mutexSt == DCGM_MUTEX_ST_OK)
@@ -6681,17 +10689,14 @@ std::optional<unsigned int> DcgmCacheManager::GetGpuIdForEntity(dcgm_field_entit
             }
             break;
         case DCGM_FE_VGPU:
-            for (unsigned int i = 0; i < m_numGpus; i++)
+        {
+            auto const it = m_vgpuInstanceGpuIds.find(entityId);
+            if (it != m_vgpuInstanceGpuIds.end())
             {
-                for (dcgmcm_vgpu_info_p vgpu = m_gpus[i].vgpuList; vgpu != nullptr; vgpu = vgpu->next)
-                {
-                    if (vgpu->vgpuId == entityId)
-                    {
-                        return m_gpus[i].gpuId;
-                    }
-                }
+                return it->second;
             }
             break;
+        }
         default:
             return std::nullopt;
     }
@@ -6781,7 +10786,7 @@ void DcgmCacheManager::GetProfModuleServicedEntities(std::vector<dcgmGroupEntity
 }
 
 /*****************************************************************************/
-void DcgmCacheManager::NotifyMigUpdateSubscribers(unsigned int gpuId)
+void DcgmCacheManager::NotifyMigUpdateSubscribers(unsigned int gpuId, DcgmMigHierarchyDelta const &delta)
 {
     dcgmMutexReturn_t mutexSt = dcgm_mutex_lock_me(m_mutex);
 
@@ -6793,8 +10798,43 @@ void DcgmCacheManager::NotifyMigUpdateSubscribers(unsigned int gpuId)
 
     for (auto &&entry : localCopy)
     {
-        entry.fn.migCb(gpuId, entry.userData);
+        entry.fn.migCb(gpuId, delta, entry.userData);
+    }
+}
+
+/*****************************************************************************/
+DcgmMigHierarchyDelta DcgmCacheManager::TakeMigDelta(unsigned int gpuId)
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    auto it = m_unnotifiedMigIds.find(gpuId);
+    if (it == m_unnotifiedMigIds.end() || gpuId >= m_numGpus)
+    {
+        return {};
+    }
+
+    DcgmMigHierarchyDelta delta = DiffMigIds(it->second, SnapshotMigIds(m_gpus[gpuId]));
+    m_unnotifiedMigIds.erase(it);
+    return delta;
+}
+
+/*****************************************************************************/
+DcgmGpuInstance *DcgmCacheManager::FindGpuInstance(unsigned int gpuId, DcgmNs::Mig::GpuInstanceId const &gpuInstanceId)
+{
+    if (gpuId >= m_numGpus)
+    {
+        return nullptr;
+    }
+
+    for (auto &gpuInstance : m_gpus[gpuId].instances)
+    {
+        if (gpuInstance.GetInstanceId() == gpuInstanceId)
+        {
+            return &gpuInstance;
+        }
     }
+
+    return nullptr;
 }
 
 /*****************************************************************************/
@@ -6986,6 +11026,7 @@ void DcgmCacheManager::UpdateLostGpus()
                     m_gpus[i].status = DcgmEntityStatusLost;
                     log_warning("GPU {} is lost. Updating status of GPU to: {}", m_gpus[i].gpuId, m_gpus[i].status);
                     m_lostGpus.insert(m_gpus[i].uuid);
+                    InvalidateTopologySnapshot();
                 }
             }
             else
@@ -6999,6 +11040,8 @@ void DcgmCacheManager::UpdateLostGpus()
                                 m_gpus[i].gpuId,
                                 m_gpus[i].status);
                     m_lostGpus.erase(m_gpus[i].uuid);
+                    InvalidateTopologySnapshot();
+                    m_staticFields.InvalidateGpu(m_gpus[i].gpuId);
                 }
             }
         }
@@ -7010,13 +11053,10 @@ void DcgmCacheManager::EventThreadMain(DcgmCacheManagerEventThread *eventThread)
 {
     nvmlReturn_t nvmlReturn;
     nvmlEventData_t eventData = {};
-    unsigned int nvmlGpuIndex;
     timelib64_t now;
-    unsigned int gpuId;
     int numErrors          = 0;
     unsigned int timeoutMs = 0; // Do not block in the NVML event call
     dcgmcm_update_thread_t threadCtx;
-    static const unsigned int MIG_RECONFIG_DELAY_TIMEOUT = 10000000; // 10 seconds in microseconds
 
     if (m_nvmlLoaded == false)
     {
@@ -7026,7 +11066,7 @@ void DcgmCacheManager::EventThreadMain(DcgmCacheManagerEventThread *eventThread)
 
     InitAndClearThreadCtx(&threadCtx);
 
-    if (!m_nvmlEventSetInitialized)
+    if (!m_nvmlEventSetInitialized && !m_perGpuEventThreads)
     {
         log_error("event set not initialized");
         TaskRunner::Stop(); /* Skip the next loop */
@@ -7061,6 +11101,7 @@ void DcgmCacheManager::EventThreadMain(DcgmCacheManagerEventThread *eventThread)
                 {
                     auto gpuId = pciBusGpuIdMap[kmsgXid->pciBdf];
                     RecordXidForGpu(gpuId, threadCtx, kmsgXid->xid, NVML_SUCCESS, kmsgXid->timestamp);
+                    MarkMemoryErrorEvent(gpuId, timelib_usecSince1970());
                     if (fatalXids.contains(kmsgXid->xid))
                     {
                         m_skipDriverCalls = true;
@@ -7083,10 +11124,18 @@ void DcgmCacheManager::EventThreadMain(DcgmCacheManagerEventThread *eventThread)
             // Update status of GPUs that may have fallen off the bus.
             UpdateLostGpus();
 
+            if (m_perGpuEventThreads)
+            {
+                /* NVML events are waited for by the per-GPU event threads. We only handle kmsg XIDs */
+                MarkReturnedFromDriver();
+                m_kmsgThread->WaitForXids(1000, eventThread);
+                continue;
+            }
+
             if (!m_nvmlEventSetInitialized)
             {
                 MarkReturnedFromDriver();
-                Sleep(1000000);
+                eventThread->Sleep(1000000);
                 continue;
             }
 
@@ -7102,102 +11151,239 @@ void DcgmCacheManager::EventThreadMain(DcgmCacheManagerEventThread *eventThread)
                 // This happens often and is expected to. Only log if set to verbose to reduce noise
                 DCGM_LOG_VERBOSE << "nvmlEventSetWait timeout.";
                 MarkReturnedFromDriver();
-                Sleep(1000000);
+                /* Wake up as soon as the kmsg reader parses an XID rather than a second later */
+                m_kmsgThread->WaitForXids(1000, eventThread);
                 continue; /* We expect to get this 99.9% of the time. Keep on reading */
             }
-            else if (nvmlReturn != NVML_SUCCESS)
+            else if (nvmlReturn != NVML_SUCCESS)
+            {
+                log_warning("Got st {} from nvmlEventSetWait", (int)nvmlReturn);
+                numErrors++;
+                if (numErrors >= 1000)
+                {
+                    /* If we get an excessive number of errors, quit instead of spinning in a hot loop
+                    this will cripple event reading, but it will prevent DCGM from using 100% CPU */
+                    log_fatal("Quitting EventThreadMain() after {} errors.", numErrors);
+                }
+                MarkReturnedFromDriver();
+                eventThread->Sleep(1000000);
+                continue;
+            }
+
+            now = timelib_usecSince1970();
+
+            if (ProcessNvmlEvent(threadCtx, eventData, now, updatedMigGpuId) != DCGM_ST_OK)
+            {
+                MarkReturnedFromDriver();
+                eventThread->Sleep(1000000);
+                continue;
+            }
+
+            MarkReturnedFromDriver();
+
+            if (updatedMigGpuId != DCGM_MAX_NUM_DEVICES)
+            {
+                NotifyMigConfigChange(updatedMigGpuId);
+            }
+        }
+        m_kmsgThread->WaitForXids(1000, eventThread);
+    }
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::GpuEventThreadMain(DcgmCacheManagerGpuEventThread *gpuEventThread)
+{
+    unsigned int const gpuId = gpuEventThread->m_gpuId;
+    /* Bounds how long stopping the thread or detaching from the GPUs waits for us to leave the driver */
+    unsigned int const timeoutMs = 250;
+    int numErrors                = 0;
+    dcgmcm_update_thread_t threadCtx;
+
+    InitAndClearThreadCtx(&threadCtx);
+
+    while (!gpuEventThread->ShouldStop())
+    {
+        nvmlEventData_t eventData    = {};
+        unsigned int updatedMigGpuId = DCGM_MAX_NUM_DEVICES;
+
+        ClearThreadCtx(&threadCtx);
+
+        if (!threadCtx.fvBuffer && m_haveAnyLiveSubscribers)
+        {
+            threadCtx.fvBuffer = new DcgmFvBuffer();
+        }
+
+        if (m_skipDriverCalls)
+        {
+            gpuEventThread->Sleep(1000000);
+            continue;
+        }
+
+        MarkEnteredDriver();
+
+        /* The set is only freed while we are out of the driver, so it can't go away under the wait */
+        if (!m_gpuEventSetInitialized[gpuId])
+        {
+            MarkReturnedFromDriver();
+            gpuEventThread->Sleep(1000000);
+            continue;
+        }
+
+        nvmlReturn_t nvmlReturn = nvmlEventSetWait_v2(m_gpuEventSets[gpuId], &eventData, timeoutMs);
+        if (nvmlReturn == NVML_ERROR_NOT_SUPPORTED || nvmlReturn == NVML_ERROR_FUNCTION_NOT_FOUND)
+        {
+            nvmlReturn = nvmlEventSetWait(m_gpuEventSets[gpuId], &eventData, timeoutMs);
+        }
+        if (nvmlReturn == NVML_ERROR_TIMEOUT)
+        {
+            MarkReturnedFromDriver();
+            continue;
+        }
+        else if (nvmlReturn != NVML_SUCCESS)
+        {
+            log_warning("Got st {} from nvmlEventSetWait for gpuId {}", (int)nvmlReturn, gpuId);
+            numErrors++;
+            if (numErrors >= 1000)
+            {
+                log_fatal("Quitting the event thread of gpuId {} after {} errors.", gpuId, numErrors);
+                MarkReturnedFromDriver();
+                gpuEventThread->Stop();
+                break;
+            }
+            MarkReturnedFromDriver();
+            gpuEventThread->Sleep(1000000);
+            continue;
+        }
+
+        timelib64_t const now = timelib_usecSince1970();
+
+        dcgmReturn_t const ret = ProcessNvmlEvent(threadCtx, eventData, now, updatedMigGpuId);
+
+        MarkReturnedFromDriver();
+
+        if (ret != DCGM_ST_OK)
+        {
+            gpuEventThread->Sleep(1000000);
+            continue;
+        }
+
+        if (updatedMigGpuId != DCGM_MAX_NUM_DEVICES)
+        {
+            NotifyMigConfigChange(updatedMigGpuId);
+        }
+    }
+
+    FreeThreadCtx(&threadCtx);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::ProcessNvmlEvent(dcgmcm_update_thread_t &threadCtx,
+                                                nvmlEventData_t &eventData,
+                                                timelib64_t now,
+                                                unsigned int &updatedMigGpuId)
+{
+    static const unsigned int MIG_RECONFIG_DELAY_TIMEOUT = 10000000; // 10 seconds in microseconds
+    unsigned int nvmlGpuIndex;
+
+    updatedMigGpuId = DCGM_MAX_NUM_DEVICES;
+
+    nvmlReturn_t nvmlReturn = nvmlDeviceGetIndex(eventData.device, &nvmlGpuIndex);
+    if (nvmlReturn != NVML_SUCCESS)
+    {
+        log_warning("Unable to convert device handle to index");
+        return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlReturn);
+    }
+
+    unsigned int const gpuId = NvmlIndexToGpuId(nvmlGpuIndex);
+
+    log_debug("Got nvmlEvent {} for gpuId {}", eventData.eventType, gpuId);
+
+    switch (eventData.eventType)
+    {
+        case nvmlEventTypeXidCriticalError:
+            /* Page retirement and row remapping are reported as XIDs too */
+            MarkMemoryErrorEvent(gpuId, now);
+            if (!m_driverIsR450OrNewer || m_gpus[gpuId].migEnabled == false)
+            {
+                RecordXidForGpu(gpuId, threadCtx, eventData.eventData, nvmlReturn, now);
+            }
+            else if (eventData.gpuInstanceId == DCGM_BLANK_ENTITY_ID
+                     && eventData.computeInstanceId == DCGM_BLANK_ENTITY_ID)
+            {
+                RecordXidForGpu(gpuId, threadCtx, eventData.eventData, nvmlReturn, now);
+            }
+            else if (eventData.computeInstanceId != DCGM_BLANK_ENTITY_ID)
             {
-                log_warning("Got st {} from nvmlEventSetWait", (int)nvmlReturn);
-                numErrors++;
-                if (numErrors >= 1000)
-                {
-                    /* If we get an excessive number of errors, quit instead of spinning in a hot loop
-                    this will cripple event reading, but it will prevent DCGM from using 100% CPU */
-                    log_fatal("Quitting EventThreadMain() after {} errors.", numErrors);
-                }
-                MarkReturnedFromDriver();
-                Sleep(1000000);
-                continue;
+                RecordXidForComputeInstance(gpuId, threadCtx, eventData, nvmlReturn, now);
             }
-
-            now = timelib_usecSince1970();
-
-            nvmlReturn = nvmlDeviceGetIndex(eventData.device, &nvmlGpuIndex);
-            if (nvmlReturn != NVML_SUCCESS)
+            else
             {
-                log_warning("Unable to convert device handle to index");
-                MarkReturnedFromDriver();
-                Sleep(1000000);
-                continue;
+                RecordXidForGpuInstance(gpuId, threadCtx, eventData, nvmlReturn, now);
             }
+            break;
 
-            gpuId = NvmlIndexToGpuId(nvmlGpuIndex);
-
-            log_debug("Got nvmlEvent {} for gpuId {}", eventData.eventType, gpuId);
+        case nvmlEventMigConfigChange:
+        {
+            updatedMigGpuId = gpuId;
 
-            switch (eventData.eventType)
+            dcgmMutexReturn_t mutexSt = dcgm_mutex_lock_me(m_mutex);
+            // If the user has requested that we delay processing this event within a reasonable timeout,
+            // then do so.
+            dcgmReturn_t ret = DCGM_ST_OK;
+            if (now - m_delayedMigReconfigProcessingTimestamp >= MIG_RECONFIG_DELAY_TIMEOUT)
             {
-                case nvmlEventTypeXidCriticalError:
-                    if (!m_driverIsR450OrNewer || m_gpus[gpuId].migEnabled == false)
-                    {
-                        RecordXidForGpu(gpuId, threadCtx, eventData.eventData, nvmlReturn, now);
-                    }
-                    else if (eventData.gpuInstanceId == DCGM_BLANK_ENTITY_ID
-                             && eventData.computeInstanceId == DCGM_BLANK_ENTITY_ID)
-                    {
-                        RecordXidForGpu(gpuId, threadCtx, eventData.eventData, nvmlReturn, now);
-                    }
-                    else if (eventData.computeInstanceId != DCGM_BLANK_ENTITY_ID)
-                    {
-                        RecordXidForComputeInstance(gpuId, threadCtx, eventData, nvmlReturn, now);
-                    }
-                    else
-                    {
-                        RecordXidForGpuInstance(gpuId, threadCtx, eventData, nvmlReturn, now);
-                    }
-                    break;
+                ret = ReinitializeGpuInstances(m_gpus[gpuId]);
+            }
+            if (mutexSt != DCGM_MUTEX_ST_LOCKEDBYME)
+                dcgm_mutex_unlock(m_mutex);
 
-                case nvmlEventMigConfigChange:
-                {
-                    updatedMigGpuId = gpuId;
+            if (ret != DCGM_ST_OK)
+            {
+                DCGM_LOG_ERROR << "Could not re-initialize MIG information for GPU " << gpuId << ": "
+                               << errorString(ret);
+            }
 
-                    dcgmMutexReturn_t mutexSt = dcgm_mutex_lock_me(m_mutex);
-                    // If the user has requested that we delay processing this event within a reasonable timeout,
-                    // then do so.
-                    dcgmReturn_t ret = DCGM_ST_OK;
-                    if (now - m_delayedMigReconfigProcessingTimestamp >= MIG_RECONFIG_DELAY_TIMEOUT)
-                    {
-                        ClearGpuMigInfo(m_gpus[gpuId]);
-                        ret = InitializeGpuInstances(m_gpus[gpuId]);
-                    }
-                    if (mutexSt != DCGM_MUTEX_ST_LOCKEDBYME)
-                        dcgm_mutex_unlock(m_mutex);
+            break;
+        }
 
-                    if (ret != DCGM_ST_OK)
-                    {
-                        DCGM_LOG_ERROR << "Could not re-initialize MIG information for GPU " << gpuId << ": "
-                                       << errorString(ret);
-                    }
+        case nvmlEventTypeSingleBitEccError:
+        case nvmlEventTypeDoubleBitEccError:
+        case nvmlEventTypeDramRetirementEvent:
+        case nvmlEventTypeDramRetirementFailure:
+            MarkMemoryErrorEvent(gpuId, now);
+            break;
 
-                    break;
-                }
+        default:
+            log_warning("Unhandled event type {:X}", eventData.eventType);
+            break;
+    }
 
-                default:
-                    log_warning("Unhandled event type {:X}", eventData.eventType);
-                    break;
-            }
+    if (threadCtx.fvBuffer)
+        UpdateFvSubscribers(&threadCtx);
 
-            if (threadCtx.fvBuffer)
-                UpdateFvSubscribers(&threadCtx);
+    /* NVML doesn't say when the event was raised. Measure from when we dequeued it */
+    timelib64_t const latencyUsec = timelib_usecSince1970() - now;
+    {
+        DcgmLockGuard dlg(m_mutex);
+        dcgmcm_watch_info_p watchInfo = GetEntityWatchInfo(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS, 0);
+        if (watchInfo)
+        {
+            watchInfo->execTimeUsec += latencyUsec;
+            watchInfo->maxExecTimeUsec = std::max(watchInfo->maxExecTimeUsec, latencyUsec);
+        }
+    }
 
-            MarkReturnedFromDriver();
+    return DCGM_ST_OK;
+}
 
-            if (updatedMigGpuId != DCGM_MAX_NUM_DEVICES)
-            {
-                NotifyMigUpdateSubscribers(updatedMigGpuId);
-            }
-        }
-        Sleep(1000000);
+/*****************************************************************************/
+void DcgmCacheManager::NotifyMigConfigChange(unsigned int gpuId)
+{
+    /* This includes what CreateMigEntity and DeleteMigEntity already re-read */
+    DcgmMigHierarchyDelta const delta = TakeMigDelta(gpuId);
+    if (!delta.IsEmpty())
+    {
+        NotifyMigUpdateSubscribers(gpuId, delta);
     }
 }
 
@@ -7206,9 +11392,7 @@ dcgmReturn_t DcgmCacheManager::CacheTopologyAffinity(dcgmcm_update_thread_t *thr
                                                      timelib64_t now,
                                                      timelib64_t expireTime)
 {
-    dcgmAffinity_t affinity = {};
-
-    PopulateTopologyAffinity(GetTopologyHelper(), affinity);
+    dcgmAffinity_t affinity = GetTopologySnapshot()->affinity;
 
     AppendEntityBlob(threadCtx, &affinity, sizeof(dcgmAffinity_t), now, expireTime);
 
@@ -7220,23 +11404,194 @@ dcgmReturn_t DcgmCacheManager::CacheTopologyNvLink(dcgmcm_update_thread_t *threa
                                                    timelib64_t now,
                                                    timelib64_t expireTime)
 {
-    dcgmTopology_t *topology_p = NULL;
-    unsigned int topologySize  = 0;
-    dcgmReturn_t ret           = PopulateTopologyNvLink(GetTopologyHelper(true), &topology_p, topologySize);
+    std::shared_ptr<DcgmTopologySnapshot const> snapshot = GetTopologySnapshot();
+    dcgmReturn_t ret                                     = snapshot->nvLinkRet;
 
     if (ret == DCGM_ST_NOT_SUPPORTED && threadCtx->watchInfo)
     {
         threadCtx->watchInfo->lastStatus = NVML_ERROR_NOT_SUPPORTED;
     }
 
-    AppendEntityBlob(threadCtx, topology_p, topologySize, now, expireTime);
-
-    if (topology_p != NULL)
-        free(topology_p);
+    AppendEntityBlob(threadCtx, snapshot->nvLink.get(), snapshot->nvLinkSize, now, expireTime);
 
     return ret;
 }
 
+/*****************************************************************************/
+std::shared_ptr<DcgmTopologySnapshot const> DcgmCacheManager::GetTopologySnapshot()
+{
+    if (auto snapshot = m_topologySnapshot.load(); snapshot != nullptr)
+    {
+        return snapshot;
+    }
+
+    std::lock_guard<std::mutex> lock(m_topologyBuildMutex);
+    if (auto snapshot = m_topologySnapshot.load(); snapshot != nullptr)
+    {
+        /* Another thread read it while we were waiting */
+        return snapshot;
+    }
+
+    auto snapshot        = std::make_shared<DcgmTopologySnapshot>();
+    snapshot->generation = m_topologyGeneration.load();
+
+    std::vector<dcgm_topology_helper_t> const gpuInfo = GetTopologyHelper(true);
+
+    snapshot->affinityRet = PopulateTopologyAffinity(gpuInfo, snapshot->affinity);
+
+    dcgmTopology_t *topology = nullptr;
+    snapshot->nvLinkRet      = PopulateTopologyNvLink(gpuInfo, &topology, snapshot->nvLinkSize);
+    if (snapshot->nvLinkRet == DCGM_ST_OK)
+    {
+        snapshot->nvLink.reset(topology);
+        BuildLinkScores(topology, snapshot->linkScores);
+    }
+    else
+    {
+        /* PopulateTopologyNvLink can fail after it allocated a partially filled topology */
+        free(topology);
+        snapshot->nvLinkSize = 0;
+    }
+
+    std::shared_ptr<DcgmTopologySnapshot const> published = snapshot;
+    std::shared_ptr<DcgmTopologySnapshot const> expected;
+    if (m_topologySnapshot.compare_exchange_strong(expected, published)
+        && m_topologyGeneration.load() != snapshot->generation)
+    {
+        /* The topology changed while we were reading it. Hand this one out once, but don't keep it */
+        m_topologySnapshot.compare_exchange_strong(published, nullptr);
+    }
+
+    return snapshot;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::InvalidateTopologySnapshot()
+{
+    /* The generation goes first so that a snapshot being read right now is not kept either */
+    m_topologyGeneration.fetch_add(1);
+    m_topologySnapshot.store(nullptr);
+
+    PublishGpuNvLinkStatus();
+    PublishGpuInventory();
+    PublishEntityStatuses();
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::PublishEntityStatuses()
+{
+    std::vector<DcgmEntityStatusTable::Entry> gpus;
+    std::vector<DcgmEntityStatusTable::Entry> gpuInstances;
+    std::vector<DcgmEntityStatusTable::Entry> computeInstances;
+
+    for (unsigned int i = 0; i < m_numGpus; i++)
+    {
+        gpus.push_back({ m_gpus[i].gpuId, m_gpus[i].status });
+
+        for (auto const &instance : m_gpus[i].instances)
+        {
+            gpuInstances.push_back({ instance.GetInstanceId().id, m_gpus[i].gpuId });
+
+            for (unsigned int ciIndex = 0; ciIndex < instance.GetComputeInstanceCount(); ciIndex++)
+            {
+                dcgmcm_gpu_compute_instance_t ci {};
+                if (instance.GetComputeInstance(ciIndex, ci) == DCGM_ST_OK)
+                {
+                    computeInstances.push_back({ ci.dcgmComputeInstanceId.id, m_gpus[i].gpuId });
+                }
+            }
+        }
+    }
+
+    /* The GPUs go last so that new instances never point to a GPU that isn't published yet */
+    m_entityStatuses.Publish(DCGM_FE_GPU_I, gpuInstances);
+    m_entityStatuses.Publish(DCGM_FE_GPU_CI, computeInstances);
+    m_entityStatuses.Publish(DCGM_FE_GPU, gpus);
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::PublishGpuInventory()
+{
+    std::lock_guard<std::mutex> lg(m_gpuInventoryPublishMutex);
+
+    auto const previous = m_gpuInventorySnapshot.load();
+    auto snapshot       = std::make_shared<DcgmGpuInventorySnapshot>();
+
+    /* Value-initialized, so that padding is zeroed and the entries can be compared with memcmp */
+    snapshot->gpus.resize(m_numGpus);
+    for (unsigned int i = 0; i < m_numGpus; i++)
+    {
+        dcgmcm_gpu_info_cached_t &gpu = snapshot->gpus[i];
+
+        gpu.gpuId              = m_gpus[i].gpuId;
+        gpu.status             = m_gpus[i].status;
+        gpu.brand              = m_gpus[i].brand;
+        gpu.nvmlIndex          = m_gpus[i].nvmlIndex;
+        gpu.arch               = m_gpus[i].arch;
+        gpu.virtualizationMode = m_gpus[i].virtualizationMode;
+        memcpy(&gpu.pciInfo, &m_gpus[i].pciInfo, sizeof(gpu.pciInfo));
+        SafeCopyTo(gpu.uuid, m_gpus[i].uuid);
+    }
+
+    if (previous != nullptr && previous->gpus.size() == snapshot->gpus.size()
+        && memcmp(previous->gpus.data(), snapshot->gpus.data(), snapshot->gpus.size() * sizeof(snapshot->gpus[0])) == 0)
+    {
+        return;
+    }
+
+    snapshot->version = previous != nullptr ? previous->version + 1 : 1;
+    log_debug("Publishing GPU inventory version {} for {} GPUs", snapshot->version, m_numGpus);
+    m_gpuInventorySnapshot.store(std::move(snapshot));
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::PublishGpuNvLinkStatus()
+{
+    std::lock_guard<std::mutex> lg(m_nvLinkStatusPublishMutex);
+
+    auto const previous = m_nvLinkStatusSnapshot.load();
+    auto snapshot       = previous != nullptr ? std::make_shared<DcgmNvLinkStatusSnapshot>(*previous)
+                                              : std::make_shared<DcgmNvLinkStatusSnapshot>();
+    dcgmNvLinkStatus_v4 &status = snapshot->status;
+
+    status.version = dcgmNvLinkStatus_version4;
+    memset(status.gpus, 0, sizeof(status.gpus));
+    for (unsigned int i = 0; i < m_numGpus; i++)
+    {
+        if (m_gpus[i].status == DcgmEntityStatusDetached)
+            continue;
+
+        status.gpus[i].entityId = m_gpus[i].gpuId;
+        memcpy(status.gpus[i].linkState, m_gpus[i].nvLinkLinkState, sizeof(status.gpus[i].linkState));
+    }
+    status.numGpus = m_numGpus;
+
+    if (previous != nullptr && previous->status.numGpus == status.numGpus
+        && memcmp(previous->status.gpus, status.gpus, sizeof(status.gpus)) == 0)
+    {
+        return;
+    }
+
+    snapshot->version++;
+    log_debug("Publishing NvLink status version {} for {} GPUs", snapshot->version, status.numGpus);
+    m_nvLinkStatusSnapshot.store(std::move(snapshot));
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::RefreshNvLinkLinkStates()
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    /* UpdateNvLinkLinkState() publishes a new snapshot for each GPU whose link states changed */
+    for (unsigned int i = 0; i < m_numGpus; i++)
+    {
+        if (m_gpus[i].status == DcgmEntityStatusDetached || m_gpus[i].status == DcgmEntityStatusLost)
+            continue;
+
+        UpdateNvLinkLinkState(m_gpus[i].gpuId);
+    }
+}
+
 dcgmReturn_t DcgmCacheManager::GetFMStatusFromStruct(nvmlGpuFabricInfoV_t const &gpuFabricInfo,
                                                      dcgmFabricManagerStatus_t &status,
                                                      uint64_t &fmError)
@@ -7342,15 +11697,23 @@ void DcgmCacheManager::GenerateCudaVisibleDevicesValue(unsigned int gpuId,
         }
         case DCGM_FE_GPU_I:
         {
-            unsigned int localGIIndex = entityId % m_gpus[gpuId].maxGpcs;
-            const char *uuid          = m_gpus[gpuId].uuid;
+            DcgmGpuInstance const *instance = FindGpuInstance(gpuId, DcgmNs::Mig::GpuInstanceId { entityId });
+            const char *uuid                = m_gpus[gpuId].uuid;
+
+            if (instance == nullptr)
+            {
+                valbuf << errorString(DCGM_ST_INSTANCE_NOT_FOUND);
+                DCGM_LOG_ERROR << "Cannot create CUDA_VISIBLE_DEVICES value for GPU instance " << entityId << ": "
+                               << valbuf.str();
+                break;
+            }
 
             if (std::strncmp(uuid, "GPU-", 4) == 0)
             {
                 uuid += 4;
             }
 
-            valbuf << "MIG-GPU-" << uuid << "/" << m_gpus[gpuId].instances[localGIIndex].GetNvmlInstanceId().id;
+            valbuf << "MIG-GPU-" << uuid << "/" << instance->GetNvmlInstanceId().id;
             break;
         }
         case DCGM_FE_GPU_CI:
@@ -7366,10 +11729,11 @@ void DcgmCacheManager::GenerateCudaVisibleDevicesValue(unsigned int gpuId,
             }
             else
             {
-                unsigned int localGIIndex = gpuInstanceId.id % m_gpus[gpuId].maxGpcs;
+                DcgmGpuInstance *instance = FindGpuInstance(gpuId, gpuInstanceId);
                 dcgmcm_gpu_compute_instance_t ci {};
-                ret = m_gpus[gpuId].instances[localGIIndex].GetComputeInstanceById(
-                    DcgmNs::Mig::ComputeInstanceId { entityId }, ci);
+                ret = instance == nullptr ? DCGM_ST_INSTANCE_NOT_FOUND
+                                          : instance->GetComputeInstanceById(
+                                                DcgmNs::Mig::ComputeInstanceId { entityId }, ci);
                 if (ret == DCGM_ST_OK)
                 {
                     const char *uuid = m_gpus[gpuId].uuid;
@@ -7379,8 +11743,8 @@ void DcgmCacheManager::GenerateCudaVisibleDevicesValue(unsigned int gpuId,
                         uuid += 4;
                     }
 
-                    valbuf << "MIG-GPU-" << uuid << "/" << m_gpus[gpuId].instances[localGIIndex].GetNvmlInstanceId().id
-                           << "/" << ci.nvmlComputeInstanceId.id;
+                    valbuf << "MIG-GPU-" << uuid << "/" << instance->GetNvmlInstanceId().id << "/"
+                           << ci.nvmlComputeInstanceId.id;
                 }
                 else
                 {
@@ -7591,7 +11955,7 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
 
     dcgmcm_watch_info_p watchInfo = threadCtx->watchInfo;
 
-    now = timelib_usecSince1970();
+    now = threadCtx->clock.Now();
 
     /* Expiration is measured in absolute time */
     if (watchInfo && watchInfo->maxAgeUsec)
@@ -7607,6 +11971,33 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
         watchInfo->lastQueriedUsec = now;
     }
 
+    /* Watched static attributes are read from the driver once and served from m_staticFields after that */
+    bool const isStaticWatch = watchInfo && entityGroupId == DCGM_FE_GPU
+                               && DcgmStaticFieldCache::IsStaticField(fieldMeta->fieldId) && gpuId < m_numGpus
+                               && m_gpus[gpuId].status == DcgmEntityStatusOk;
+    if (isStaticWatch)
+    {
+        std::shared_ptr<dcgmBufferedFv_t const> staticValue = m_staticFields.Get(gpuId, fieldMeta->fieldId);
+        if (staticValue)
+        {
+            watchInfo->lastStatus = NVML_SUCCESS;
+            AppendStaticFieldValue(threadCtx, *staticValue, now, expireTime);
+            return DCGM_ST_OK;
+        }
+    }
+
+    nvmlSamplingType_t samplingType;
+    if (m_nvmlSampleBufferUsec > 0 && watchInfo && entityGroupId == DCGM_FE_GPU && nvmlDevice != nullptr
+        && GetNvmlSamplingType(fieldMeta->fieldId, samplingType))
+    {
+        ret = AppendNvmlSampleBuffer(threadCtx, nvmlDevice, fieldMeta, samplingType, now, expireTime);
+        if (ret != DCGM_ST_NOT_SUPPORTED)
+        {
+            return ret;
+        }
+        /* Otherwise read the field the usual way below */
+    }
+
     switch (fieldMeta->fieldId)
     {
         case DCGM_FI_DRIVER_VERSION:
@@ -7714,15 +12105,15 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                         DCGM_LOG_ERROR << "A MIG related fields is requested for GPU without enabled MIG";
                         return DCGM_ST_NOT_SUPPORTED;
                     }
-                    unsigned int localGIIndex      = entityId % m_gpus[gpuId].maxGpcs;
-                    std::string const &profileName = m_gpus[gpuId].instances[localGIIndex].GetProfileName();
-                    if (profileName.empty())
+                    DcgmGpuInstance const *instance
+                        = FindGpuInstance(gpuId, DcgmNs::Mig::GpuInstanceId { entityId });
+                    if (instance == nullptr || instance->GetProfileName().empty())
                     {
                         snprintf(buf, sizeof(buf), "%s", DCGM_STR_BLANK);
                     }
                     else
                     {
-                        snprintf(buf, sizeof(buf), "%s", profileName.c_str());
+                        snprintf(buf, sizeof(buf), "%s", instance->GetProfileName().c_str());
                     }
                     AppendEntityString(threadCtx, buf, now, expireTime);
 
@@ -7783,10 +12174,11 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                     }
                     else
                     {
-                        unsigned int localGIIndex = gpuInstanceId.id % m_gpus[gpuId].maxGpcs;
+                        DcgmGpuInstance *instance = FindGpuInstance(gpuId, gpuInstanceId);
                         dcgmcm_gpu_compute_instance_t ci {};
-                        ret = m_gpus[gpuId].instances[localGIIndex].GetComputeInstanceById(
-                            DcgmNs::Mig::ComputeInstanceId { entityId }, ci);
+                        ret = instance == nullptr ? DCGM_ST_INSTANCE_NOT_FOUND
+                                                  : instance->GetComputeInstanceById(
+                                                        DcgmNs::Mig::ComputeInstanceId { entityId }, ci);
                         if (ret != DCGM_ST_OK || ci.profileName.empty())
                         {
                             snprintf(buf, sizeof(buf), "%s", DCGM_STR_BLANK);
@@ -8800,13 +13192,7 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                 case DCGM_FE_GPU_I: // Fall through
                 case DCGM_FE_GPU_CI:
                 {
-                    // Pass NVML the NVML device for the GPU instance
-                    nvmlDevice_t instanceDevice = GetComputeInstanceNvmlDevice(
-                        gpuId,
-                        static_cast<dcgm_field_entity_group_t>(threadCtx->entityKey.entityGroupId),
-                        threadCtx->entityKey.entityId);
-                    nvmlReturn = (instanceDevice == nullptr) ? NVML_ERROR_INVALID_ARGUMENT
-                                                             : nvmlDeviceGetBAR1MemoryInfo(instanceDevice, &bar1Memory);
+                    nvmlReturn = ReadMigBar1MemoryInfo(threadCtx, gpuId, bar1Memory);
                     break;
                 }
                 default:
@@ -10354,7 +14740,8 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
             unsigned int maxPidCount = 0;
             unsigned int pidCount    = 0;
             unsigned int *pids       = 0;
-            nvmlAccountingStats_t accountingStats;
+            nvmlAccountingStats_t nvmlAccountingStats;
+            std::vector<dcgmDevicePidAccountingStats_t> accountingStats;
 
             /* Find out how many PIDs we can query */
             nvmlReturn = (nvmlDevice == nullptr) ? NVML_ERROR_INVALID_ARGUMENT
@@ -10401,9 +14788,10 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
             log_debug("Read {} pids for gpuId {}", pidCount, gpuId);
 
             /* Walk over the PIDs */
+            accountingStats.reserve(pidCount);
             for (i = 0; i < pidCount; i++)
             {
-                nvmlReturn = nvmlDeviceGetAccountingStats(nvmlDevice, pids[i], &accountingStats);
+                nvmlReturn = nvmlDeviceGetAccountingStats(nvmlDevice, pids[i], &nvmlAccountingStats);
                 if (watchInfo)
                     watchInfo->lastStatus = nvmlReturn;
                 if (nvmlReturn != NVML_SUCCESS)
@@ -10416,13 +14804,21 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                     continue;
                 }
 
-
-                /* Append a stats record for the PID */
-                AppendDeviceAccountingStats(threadCtx, pids[i], &accountingStats, now, expireTime);
+                dcgmDevicePidAccountingStats_t &stats = accountingStats.emplace_back();
+                stats.version                         = dcgmDevicePidAccountingStats_version;
+                stats.pid                             = pids[i];
+                stats.gpuUtilization                  = nvmlAccountingStats.gpuUtilization;
+                stats.memoryUtilization               = nvmlAccountingStats.memoryUtilization;
+                stats.maxMemoryUsage                  = nvmlAccountingStats.maxMemoryUsage;
+                stats.startTimestamp                  = nvmlAccountingStats.startTime;
+                stats.activeTimeUsec                  = nvmlAccountingStats.time * 1000;
             }
 
             free(pids);
             pids = 0;
+
+            /* Append a stats record for each PID that hasn't been recorded yet */
+            AppendDeviceAccountingStats(threadCtx, accountingStats, now, expireTime);
             break;
         }
 
@@ -11294,7 +15690,6 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                 break;
             }
 
-            unsigned int localGIIndex      = 0;
             DcgmGpuInstance *pGpuInstance  = nullptr;
             nvmlDevice_t nvmlDeviceToQuery = nvmlDevice;
 
@@ -11307,8 +15702,7 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                         DCGM_LOG_ERROR << "A MIG related fields is requested for GPU without enabled MIG";
                         return DCGM_ST_NOT_SUPPORTED;
                     }
-                    localGIIndex = entityId % m_gpus[gpuId].maxGpcs;
-                    pGpuInstance = &m_gpus[gpuId].instances[localGIIndex];
+                    pGpuInstance = FindGpuInstance(gpuId, DcgmNs::Mig::GpuInstanceId { entityId });
                     break;
                 }
 
@@ -11325,45 +15719,132 @@ dcgmReturn_t DcgmCacheManager::BufferOrCacheLatestGpuValue(dcgmcm_update_thread_
                 }
             }
 
-            double value = DCGM_FP64_BLANK;
-            dcgmReturn_t dcgmReturn
-                = m_gpmManager.GetLatestSample(watchInfo->watchKey, nvmlDeviceToQuery, pGpuInstance, value, now);
-            if (dcgmReturn != DCGM_ST_OK)
-            {
-                DCGM_LOG_ERROR << "Got unexpected return " << dcgmReturn << " from m_gpmManager.GetLatestSample";
-            }
+            double value = DCGM_FP64_BLANK;
+            dcgmReturn_t dcgmReturn
+                = m_gpmManager.GetLatestSample(watchInfo->watchKey, nvmlDeviceToQuery, pGpuInstance, value, now);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                DCGM_LOG_ERROR << "Got unexpected return " << dcgmReturn << " from m_gpmManager.GetLatestSample";
+            }
+
+            if (fieldMeta->fieldType == DCGM_FT_DOUBLE)
+            {
+                AppendEntityDouble(threadCtx, value, 0.0, now, expireTime);
+            }
+            else if (fieldMeta->fieldType == DCGM_FT_INT64)
+            {
+                long long i64Value = DCGM_INT64_BLANK;
+
+                /* All of the int64 GPM metrics are bandwidth values returned in MiB. DCGM's are in bytes.
+                   Hence the multiplication here. Verified this in the NVML code as well. */
+                if (!DCGM_FP64_IS_BLANK(value))
+                {
+                    i64Value = (long long)(value * 1024.0 * 1024.0);
+                }
+
+                AppendEntityInt64(threadCtx, i64Value, 0.0, now, expireTime);
+            }
+            else
+            {
+                DCGM_LOG_ERROR << "Unhandled field type " << fieldMeta->fieldType << " for fieldId "
+                               << fieldMeta->fieldId;
+            }
+            break;
+        }
+
+        default:
+            log_warning("Unimplemented fieldId: {}", (int)fieldMeta->fieldId);
+            return DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (isStaticWatch && watchInfo->lastStatus == NVML_SUCCESS)
+    {
+        StoreStaticWatchValue(watchInfo, gpuId);
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::AppendStaticFieldValue(dcgmcm_update_thread_t *threadCtx,
+                                              dcgmBufferedFv_t const &fv,
+                                              timelib64_t now,
+                                              timelib64_t expireTime)
+{
+    switch (fv.fieldType)
+    {
+        case DCGM_FT_INT64:
+            AppendEntityInt64(threadCtx, fv.value.i64, 0, now, expireTime);
+            break;
+
+        case DCGM_FT_DOUBLE:
+            AppendEntityDouble(threadCtx, fv.value.dbl, 0.0, now, expireTime);
+            break;
+
+        case DCGM_FT_STRING:
+            AppendEntityString(threadCtx, fv.value.str, now, expireTime);
+            break;
+
+        case DCGM_FT_BINARY:
+        {
+            size_t const valueSize = (size_t)fv.length - (sizeof(fv) - sizeof(fv.value));
+            AppendEntityBlob(threadCtx, (void *)fv.value.blob, valueSize, now, expireTime);
+            break;
+        }
+
+        default:
+            log_error("Unexpected fieldType {} for static fieldId {}", fv.fieldType, fv.fieldId);
+            break;
+    }
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::StoreStaticWatchValue(dcgmcm_watch_info_p watchInfo, unsigned int gpuId)
+{
+    DcgmLockGuard dlg(m_mutex);
+
+    timeseries_entry_p entry = watchInfo->timeSeries ? timeseries_last(watchInfo->timeSeries, nullptr) : nullptr;
+    if (entry == nullptr)
+    {
+        return;
+    }
 
-            if (fieldMeta->fieldType == DCGM_FT_DOUBLE)
-            {
-                AppendEntityDouble(threadCtx, value, 0.0, now, expireTime);
-            }
-            else if (fieldMeta->fieldType == DCGM_FT_INT64)
-            {
-                long long i64Value = DCGM_INT64_BLANK;
+    DcgmFvBuffer value;
+    unsigned short const fieldId = watchInfo->watchKey.fieldId;
+    timelib64_t const timestamp  = entry->usecSince1970;
 
-                /* All of the int64 GPM metrics are bandwidth values returned in MiB. DCGM's are in bytes.
-                   Hence the multiplication here. Verified this in the NVML code as well. */
-                if (!DCGM_FP64_IS_BLANK(value))
-                {
-                    i64Value = (long long)(value * 1024.0 * 1024.0);
-                }
+    switch (watchInfo->timeSeries->tsType)
+    {
+        case TS_TYPE_INT64:
+            value.AddInt64Value(DCGM_FE_GPU, gpuId, fieldId, entry->val.i64, timestamp, DCGM_ST_OK);
+            break;
 
-                AppendEntityInt64(threadCtx, i64Value, 0.0, now, expireTime);
-            }
-            else
+        case TS_TYPE_DOUBLE:
+            value.AddDoubleValue(DCGM_FE_GPU, gpuId, fieldId, entry->val.dbl, timestamp, DCGM_ST_OK);
+            break;
+
+        case TS_TYPE_STRING:
+            value.AddStringValue(DCGM_FE_GPU, gpuId, fieldId, (char const *)entry->val.ptr, timestamp, DCGM_ST_OK);
+            break;
+
+        case TS_TYPE_BLOB:
+            /* Blobs too big to buffer, like long vGPU type lists, are read from the driver every time */
+            if (entry->val2.ptrSize > DCGM_MAX_BLOB_LENGTH)
             {
-                DCGM_LOG_ERROR << "Unhandled field type " << fieldMeta->fieldType << " for fieldId "
-                               << fieldMeta->fieldId;
+                return;
             }
+            value.AddBlobValue(DCGM_FE_GPU, gpuId, fieldId, entry->val.ptr, entry->val2.ptrSize, timestamp, DCGM_ST_OK);
             break;
-        }
 
         default:
-            log_warning("Unimplemented fieldId: {}", (int)fieldMeta->fieldId);
-            return DCGM_ST_GENERIC_ERROR;
+            return;
     }
 
-    return DCGM_ST_OK;
+    dcgmBufferedFvCursor_t cursor = 0;
+    if (dcgmBufferedFv_t *buffered = value.GetNextFv(&cursor); buffered != nullptr)
+    {
+        m_staticFields.Store(*buffered);
+    }
 }
 
 /*****************************************************************************/
@@ -11389,9 +15870,22 @@ void DcgmCacheManager::ReadAndCacheFBMemoryInfo(unsigned int gpuId,
 
     nvmlReturn_t nvmlReturn;
 
-    timelib64_t now = timelib_usecSince1970();
+    timelib64_t now = threadCtx->clock.Now();
 
-    if (m_driverMajorVersion >= DRIVER_VERSION_510)
+    if (threadCtx->entityKey.entityGroupId == DCGM_FE_GPU_I || threadCtx->entityKey.entityGroupId == DCGM_FE_GPU_CI)
+    {
+        nvmlMemory_v2_t fbMemory {};
+
+        nvmlReturn = ReadMigFbMemoryInfo(threadCtx, gpuId, fbMemory);
+        if (NVML_SUCCESS == nvmlReturn)
+        {
+            nvTotal    = fbMemory.total;
+            nvFree     = fbMemory.free;
+            nvUsed     = fbMemory.used;
+            nvReserved = fbMemory.reserved;
+        }
+    }
+    else if (m_driverMajorVersion >= DRIVER_VERSION_510)
     {
         nvmlMemory_v2_t fbMemory;
 
@@ -11405,18 +15899,6 @@ void DcgmCacheManager::ReadAndCacheFBMemoryInfo(unsigned int gpuId,
                                                      : nvmlDeviceGetMemoryInfo_v2(nvmlDevice, &fbMemory);
                 break;
             }
-            case DCGM_FE_GPU_I: // Fall through
-            case DCGM_FE_GPU_CI:
-            {
-                // Pass NVML the NVML device for the GPU instance
-                nvmlDevice_t instanceDevice = GetComputeInstanceNvmlDevice(
-                    gpuId,
-                    static_cast<dcgm_field_entity_group_t>(threadCtx->entityKey.entityGroupId),
-                    threadCtx->entityKey.entityId);
-                nvmlReturn = (instanceDevice == nullptr) ? NVML_ERROR_INVALID_ARGUMENT
-                                                         : nvmlDeviceGetMemoryInfo_v2(instanceDevice, &fbMemory);
-                break;
-            }
             default:
             {
                 nvmlReturn = NVML_ERROR_INVALID_ARGUMENT;
@@ -11444,18 +15926,6 @@ void DcgmCacheManager::ReadAndCacheFBMemoryInfo(unsigned int gpuId,
                                                      : nvmlDeviceGetMemoryInfo(nvmlDevice, &fbMemory);
                 break;
             }
-            case DCGM_FE_GPU_I: // Fall through
-            case DCGM_FE_GPU_CI:
-            {
-                // Pass NVML the NVML device for the GPU instance
-                nvmlDevice_t instanceDevice = GetComputeInstanceNvmlDevice(
-                    gpuId,
-                    static_cast<dcgm_field_entity_group_t>(threadCtx->entityKey.entityGroupId),
-                    threadCtx->entityKey.entityId);
-                nvmlReturn = (instanceDevice == nullptr) ? NVML_ERROR_INVALID_ARGUMENT
-                                                         : nvmlDeviceGetMemoryInfo(instanceDevice, &fbMemory);
-                break;
-            }
             default:
             {
                 nvmlReturn = NVML_ERROR_INVALID_ARGUMENT;
@@ -11584,7 +16054,7 @@ void DcgmCacheManager::ReadAndCacheNvLinkBandwidthTotal(dcgmcm_update_thread_t *
     timelib64_t fvTimestamp = std::max(fv[0].timestamp, fv[1].timestamp);
     if (fvTimestamp == 0)
     {
-        fvTimestamp = timelib_usecSince1970();
+        fvTimestamp = threadCtx->clock.Now();
     }
 
     /* We need a lock when we're accessing the cached values */
@@ -11639,7 +16109,7 @@ void DcgmCacheManager::ReadAndCacheNvLinkData(dcgmcm_update_thread_t *threadCtx,
 {
     dcgmcm_watch_info_p watchInfo = threadCtx->watchInfo;
 
-    timelib64_t now = timelib_usecSince1970();
+    timelib64_t now = threadCtx->clock.Now();
 
     if (!m_driverIsR520OrNewer)
     {
@@ -11689,105 +16159,55 @@ void DcgmCacheManager::ReadAndCacheNvLinkData(dcgmcm_update_thread_t *threadCtx,
 dcgmReturn_t DcgmCacheManager::ManageVgpuList(unsigned int gpuId, nvmlVgpuInstance_t *vgpuInstanceIds)
 {
     DcgmLockGuard dlg(m_mutex);
-    dcgmcm_vgpu_info_p curr = NULL, temp = NULL, initialVgpuListState = NULL, finalVgpuListState = NULL;
 
     /* First element of the vgpuInstanceIds array must hold the count of vGPU instances running */
-    unsigned int vgpuCount = vgpuInstanceIds[0];
-
-    /* Stores the initial state of vgpuList for the current GPU */
-    initialVgpuListState = m_gpus[gpuId].vgpuList;
-
-    /* Checking if new vGPU instances have spawned up in this iteration.
-       A vGPU instance is new if its instance ID is present in the refreshed
-       list returned by NVML, but is absent from the current GPU's vgpuList. */
-    for (unsigned int i = 0; i < vgpuCount; i++)
+    std::span<nvmlVgpuInstance_t const> const activeIds(vgpuInstanceIds + 1, vgpuInstanceIds[0]);
+    std::vector<nvmlVgpuInstance_t> &instances = m_gpus[gpuId].vgpuInstances;
+    bool const hadInstances                    = !instances.empty();
+
+    /* Remove the instances that are no longer active, keeping the rest in order */
+    std::unordered_set<nvmlVgpuInstance_t> const activeSet(activeIds.begin(), activeIds.end());
+    auto const stale = std::stable_partition(instances.begin(), instances.end(), [&activeSet](auto vgpuId) {
+        return activeSet.contains(vgpuId);
+    });
+    for (auto it = stale; it != instances.end(); ++it)
     {
-        bool new_entry = 1;
-        temp = curr = m_gpus[gpuId].vgpuList;
-
-        while (curr)
+        auto const indexIt = m_vgpuInstanceGpuIds.find(*it);
+        if (indexIt != m_vgpuInstanceGpuIds.end() && indexIt->second != gpuId)
         {
-            if (vgpuInstanceIds[i + 1] == curr->vgpuId)
-            {
-                new_entry = 0;
-                /* Marking the current vgpuList entry as "found", since it is present in
-                   the refreshed vGPU ID list returned by NVML */
-                curr->found = 1;
-                break;
-            }
-            temp = curr;
-            curr = curr->next;
+            continue; /* Moved to another GPU, which owns its watches now */
         }
-
-        /* Add the new vGPU Instance info to the vgpuList of the current GPU */
-        if (new_entry)
+        if (indexIt != m_vgpuInstanceGpuIds.end())
         {
-            dcgmcm_vgpu_info_p vgpuInfo = (dcgmcm_vgpu_info_p)malloc(sizeof(dcgmcm_vgpu_info_t));
-            if (!vgpuInfo)
-            {
-                log_error("malloc of {} bytes failed for metadata of vGPU instance {}",
-                          (int)(sizeof(dcgmcm_vgpu_info_t)),
-                          vgpuInstanceIds[i + 1]);
-                continue;
-            }
-
-            vgpuInfo->vgpuId = vgpuInstanceIds[i + 1];
-            vgpuInfo->found  = 1;
-            vgpuInfo->next   = NULL;
-
-
-            if (!m_gpus[gpuId].vgpuList)
-                m_gpus[gpuId].vgpuList = vgpuInfo;
-            else
-            {
-                vgpuInfo->next = temp->next;
-                temp->next     = vgpuInfo;
-            }
-
-            WatchVgpuFields(vgpuInfo->vgpuId);
+            m_vgpuInstanceGpuIds.erase(indexIt);
         }
+        UnwatchVgpuFields(*it);
+        log_debug("Removing vgpuId {} for gpuId {}", *it, gpuId);
     }
+    instances.erase(stale, instances.end());
 
-    temp = nullptr;
-    curr = m_gpus[gpuId].vgpuList;
-
-    /* Remove entries of inactive vGPU instances from the current GPU's list. */
-    while (curr)
+    /* Add the instances that have spawned since the last refresh */
+    for (nvmlVgpuInstance_t const vgpuId : activeIds)
     {
-        dcgmcm_vgpu_info_p toBeDeleted = NULL;
-        /*Any vGPU metadata node in m_vgpus that is not marked as "found" in the previous loop is stale/inactive. */
-        if (!curr->found)
+        auto const [indexIt, inserted] = m_vgpuInstanceGpuIds.try_emplace(vgpuId, gpuId);
+        if (!inserted)
         {
-            toBeDeleted = curr;
-            if (curr == m_gpus[gpuId].vgpuList)
-            {
-                m_gpus[gpuId].vgpuList = curr->next;
-            }
-            else if (temp != nullptr)
+            if (indexIt->second == gpuId)
             {
-                temp->next = curr->next;
+                continue;
             }
-            curr = curr->next;
-
-            UnwatchVgpuFields(toBeDeleted->vgpuId);
-            log_debug("Removing vgpuId {} for gpuId {}", toBeDeleted->vgpuId, gpuId);
-            free(toBeDeleted);
-        }
-        else
-        {
-            curr->found = 0;
-            temp        = curr;
-            curr        = curr->next;
+            log_warning("vgpuId {} moved from gpuId {} to gpuId {}", vgpuId, indexIt->second, gpuId);
+            indexIt->second = gpuId;
         }
-    }
 
-    /* Stores the final state of vgpuList after any addition/removal of vGPU entries on the current GPU */
-    finalVgpuListState = m_gpus[gpuId].vgpuList;
+        instances.push_back(vgpuId);
+        WatchVgpuFields(vgpuId);
+    }
 
     DcgmWatcher watcher(DcgmWatcherTypeCacheManager);
 
     /* Watching frequently cached fields only when there are vGPU instances running on the GPU. */
-    if ((!initialVgpuListState) && (finalVgpuListState))
+    if (!hadInstances && !instances.empty())
     {
         bool wereFirstWatcher = false;
         AddFieldWatch(DCGM_FE_GPU,
@@ -11825,7 +16245,7 @@ dcgmReturn_t DcgmCacheManager::ManageVgpuList(unsigned int gpuId, nvmlVgpuInstan
                       false,
                       wereFirstWatcher);
     }
-    else if ((initialVgpuListState) && (!finalVgpuListState))
+    else if (hadInstances && instances.empty())
     {
         RemoveFieldWatch(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_VGPU_UTILIZATIONS, 1, watcher);
         RemoveFieldWatch(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_VGPU_PER_PROCESS_UTILIZATION, 1, watcher);
@@ -11834,33 +16254,16 @@ dcgmReturn_t DcgmCacheManager::ManageVgpuList(unsigned int gpuId, nvmlVgpuInstan
         RemoveFieldWatch(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_FBC_SESSIONS_INFO, 1, watcher);
     }
 
-    /* Verifying vpuList to match the input vGPU instance ids array, in case of mismatch return
-     * DCGM_ST_GENERIC_ERROR */
-    temp = m_gpus[gpuId].vgpuList;
-    while (temp)
-    {
-        unsigned int i = 0;
-        while (i < vgpuCount && temp->vgpuId != vgpuInstanceIds[i + 1])
-        {
-            i++;
-        }
-        if (i >= vgpuCount)
-            return DCGM_ST_GENERIC_ERROR;
-        temp = temp->next;
-    }
-
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::AppendDeviceAccountingStats(dcgmcm_update_thread_t *threadCtx,
-                                                           unsigned int pid,
-                                                           nvmlAccountingStats_t *nvmlAccountingStats,
-                                                           timelib64_t timestamp,
-                                                           timelib64_t oldestKeepTimestamp)
+dcgmReturn_t DcgmCacheManager::AppendDeviceAccountingStats(
+    dcgmcm_update_thread_t *threadCtx,
+    std::vector<dcgmDevicePidAccountingStats_t> const &accountingStats,
+    timelib64_t timestamp,
+    timelib64_t oldestKeepTimestamp)
 {
-    dcgmDevicePidAccountingStats_t accountingStats;
-
     // Again, we shouldn't enter here without NVML loaded due to other checks
     if (!m_nvmlLoaded)
     {
@@ -11868,45 +16271,50 @@ dcgmReturn_t DcgmCacheManager::AppendDeviceAccountingStats(dcgmcm_update_thread_
         return DCGM_ST_NVML_NOT_LOADED;
     }
 
-    memset(&accountingStats, 0, sizeof(accountingStats));
-    accountingStats.version = dcgmDevicePidAccountingStats_version;
+    /* A PID is remembered for as long as its record is kept, counting from the last time NVML reported it.
+       oldestKeepTimestamp is 0 when records are kept forever */
+    timelib64_t const keepUntil = oldestKeepTimestamp == 0 ? DcgmAccountingPidCache::c_keepForever
+                                                           : timestamp + (timestamp - oldestKeepTimestamp);
 
-    accountingStats.pid               = pid;
-    accountingStats.gpuUtilization    = nvmlAccountingStats->gpuUtilization;
-    accountingStats.memoryUtilization = nvmlAccountingStats->memoryUtilization;
-    accountingStats.maxMemoryUsage    = nvmlAccountingStats->maxMemoryUsage;
-    accountingStats.startTimestamp    = nvmlAccountingStats->startTime;
-    accountingStats.activeTimeUsec    = nvmlAccountingStats->time * 1000;
+    std::vector<dcgmDevicePidAccountingStats_t const *> toAppend;
+    toAppend.reserve(accountingStats.size());
 
     dcgm_mutex_lock(m_mutex);
 
-    /* Use startTimestamp as the 2nd key since that won't change */
-    if (HasAccountingPidBeenSeen(accountingStats.pid, (timelib64_t)accountingStats.startTimestamp))
-    {
-        dcgm_mutex_unlock(m_mutex);
-        log_debug("Skipping pid {}, startTimestamp {} that has already been seen",
-                  accountingStats.pid,
-                  accountingStats.startTimestamp);
-        return DCGM_ST_OK;
-    }
+    m_accountingPidsSeen.EvictExpired(timestamp);
 
-    /* Cache the PID when the process completes as no further updates will be required for the process */
-    if (accountingStats.activeTimeUsec > 0)
+    for (dcgmDevicePidAccountingStats_t const &stats : accountingStats)
     {
-        CacheAccountingPid(accountingStats.pid, (timelib64_t)accountingStats.startTimestamp);
+        /* Use startTimestamp as the 2nd key since that won't change */
+        if (m_accountingPidsSeen.Refresh(stats.pid, (timelib64_t)stats.startTimestamp, keepUntil))
+        {
+            log_debug("Skipping pid {}, startTimestamp {} that has already been seen", stats.pid, stats.startTimestamp);
+            continue;
+        }
+
+        /* Cache the PID when the process completes as no further updates will be required for the process */
+        if (stats.activeTimeUsec > 0)
+        {
+            m_accountingPidsSeen.Insert(stats.pid, (timelib64_t)stats.startTimestamp, keepUntil);
+        }
+
+        toAppend.push_back(&stats);
     }
 
     dcgm_mutex_unlock(m_mutex);
 
-    AppendEntityBlob(threadCtx, &accountingStats, sizeof(accountingStats), timestamp, oldestKeepTimestamp);
+    for (dcgmDevicePidAccountingStats_t const *stats : toAppend)
+    {
+        AppendEntityBlob(threadCtx, (void *)stats, sizeof(*stats), timestamp, oldestKeepTimestamp);
 
-    log_debug("Recording PID {}, gpu {}, mem {}, maxMemory {}, startTs {}, activeTime {}",
-              accountingStats.pid,
-              accountingStats.gpuUtilization,
-              accountingStats.memoryUtilization,
-              accountingStats.maxMemoryUsage,
-              accountingStats.startTimestamp,
-              accountingStats.activeTimeUsec);
+        log_debug("Recording PID {}, gpu {}, mem {}, maxMemory {}, startTs {}, activeTime {}",
+                  stats->pid,
+                  stats->gpuUtilization,
+                  stats->memoryUtilization,
+                  stats->maxMemoryUsage,
+                  stats->startTimestamp,
+                  stats->activeTimeUsec);
+    }
 
     return DCGM_ST_OK;
 }
@@ -12028,7 +16436,7 @@ dcgmReturn_t DcgmCacheManager::GetGpuIds(int activeOnly, std::vector<unsigned in
         return DCGM_ST_NVML_NOT_LOADED;
     }
 
-    dcgm_mutex_lock(m_mutex);
+    DcgmSharedLockGuard dlg(m_mutex);
 
     for (unsigned int i = 0; i < m_numGpus; i++)
     {
@@ -12040,8 +16448,6 @@ dcgmReturn_t DcgmCacheManager::GetGpuIds(int activeOnly, std::vector<unsigned in
         log_debug("Skipping gpu {} due to inactive status", m_gpus[i].gpuId);
     }
 
-    dcgm_mutex_unlock(m_mutex);
-
     return DCGM_ST_OK;
 }
 
@@ -12053,7 +16459,7 @@ int DcgmCacheManager::GetGpuCount(int activeOnly)
     if (!activeOnly)
         return m_numGpus; /* Easy answer */
 
-    dcgm_mutex_lock(m_mutex);
+    DcgmSharedLockGuard dlg(m_mutex);
 
     for (unsigned int i = 0; i < m_numGpus; i++)
     {
@@ -12063,8 +16469,6 @@ int DcgmCacheManager::GetGpuCount(int activeOnly)
         }
     }
 
-    dcgm_mutex_unlock(m_mutex);
-
     return count;
 }
 
@@ -12152,8 +16556,25 @@ dcgmReturn_t DcgmCacheManager::GetAllEntitiesOfEntityGroup(int activeOnly,
 /*****************************************************************************/
 DcgmEntityStatus_t DcgmCacheManager::GetEntityStatus(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId)
 {
+    if (entityGroupId == DCGM_FE_GPU || entityGroupId == DCGM_FE_GPU_I || entityGroupId == DCGM_FE_GPU_CI)
+    {
+        if (auto const status = m_entityStatuses.Get(entityGroupId, entityId); status.has_value())
+        {
+            return *status;
+        }
+    }
+
     DcgmEntityStatus_t entityStatus = DcgmEntityStatusUnknown;
 
+    /* A GPU that is otherwise fine reports the state of its circuit breaker */
+    auto const gpuStatus = [this](unsigned int gpuId) {
+        if (m_gpus[gpuId].status == DcgmEntityStatusOk && m_gpuBreakers[gpuId].quarantined)
+        {
+            return DcgmEntityStatusQuarantined;
+        }
+        return m_gpus[gpuId].status;
+    };
+
     dcgm_mutex_lock(m_mutex);
 
     switch (entityGroupId)
@@ -12162,7 +16583,7 @@ DcgmEntityStatus_t DcgmCacheManager::GetEntityStatus(dcgm_field_entity_group_t e
             if (entityId >= m_numGpus)
                 break; /* Not a valid GPU */
 
-            entityStatus = m_gpus[entityId].status;
+            entityStatus = gpuStatus(entityId);
             break;
 
         case DCGM_FE_GPU_I:
@@ -12170,7 +16591,7 @@ DcgmEntityStatus_t DcgmCacheManager::GetEntityStatus(dcgm_field_entity_group_t e
             auto gpuId = GetGpuIdForEntity(entityGroupId, entityId);
             if (gpuId)
             {
-                entityStatus = m_gpus[*gpuId].status;
+                entityStatus = gpuStatus(*gpuId);
             }
             break;
         }
@@ -12180,7 +16601,7 @@ DcgmEntityStatus_t DcgmCacheManager::GetEntityStatus(dcgm_field_entity_group_t e
             auto gpuId = GetGpuIdForEntity(entityGroupId, entityId);
             if (gpuId)
             {
-                entityStatus = m_gpus[*gpuId].status;
+                entityStatus = gpuStatus(*gpuId);
             }
             break;
         }
@@ -12190,7 +16611,7 @@ DcgmEntityStatus_t DcgmCacheManager::GetEntityStatus(dcgm_field_entity_group_t e
             auto gpuId = GetGpuIdForEntity(entityGroupId, entityId);
             if (gpuId)
             {
-                entityStatus = m_gpus[*gpuId].status;
+                entityStatus = gpuStatus(*gpuId);
             }
             break;
         }
@@ -12206,6 +16627,27 @@ DcgmEntityStatus_t DcgmCacheManager::GetEntityStatus(dcgm_field_entity_group_t e
     return entityStatus;
 }
 
+/*****************************************************************************/
+std::optional<DcgmEntityStatus_t> DcgmCacheManager::GetPublishedEntityStatus(dcgm_field_entity_group_t entityGroupId,
+                                                                             dcgm_field_eid_t entityId) const
+{
+    return m_entityStatuses.Get(entityGroupId, entityId);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SetEntityStatuses(dcgm_field_entity_group_t entityGroupId,
+                                                 std::span<DcgmEntityStatusTable::Entry const> entries)
+{
+    if (entityGroupId != DCGM_FE_SWITCH && entityGroupId != DCGM_FE_CPU && entityGroupId != DCGM_FE_CPU_CORE)
+    {
+        log_error("The statuses of eg {} can't be set by a module", entityGroupId);
+        return DCGM_ST_BADPARAM;
+    }
+
+    log_debug("Publishing the statuses of {} entities of eg {}", entries.size(), entityGroupId);
+    return m_entityStatuses.Publish(entityGroupId, entries);
+}
+
 /*****************************************************************************/
 int DcgmCacheManager::AreAllGpuIdsSameSku(std::vector<unsigned int> &gpuIds)
 {
@@ -12254,65 +16696,350 @@ int DcgmCacheManager::AreAllGpuIdsSameSku(std::vector<unsigned int> &gpuIds)
         }
     }
 
-    log_debug("All GPUs in list of {} are the same", (int)gpuIds.size());
-    return 1;
+    log_debug("All GPUs in list of {} are the same", (int)gpuIds.size());
+    return 1;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::CheckValidGlobalField(unsigned short dcgmFieldId)
+{
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(dcgmFieldId);
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta || fieldMeta->fieldId == DCGM_FI_UNKNOWN)
+    {
+        log_error("dcgmFieldId is invalid: {}", dcgmFieldId);
+        return DCGM_ST_UNKNOWN_FIELD;
+    }
+
+    if (fieldMeta->scope != DCGM_FS_GLOBAL)
+    {
+        log_error("field {} does not have scope DCGM_FS_GLOBAL", dcgmFieldId);
+        return DCGM_ST_BADPARAM;
+    }
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmCacheManager::CheckValidGpuField(unsigned int gpuId, unsigned short dcgmFieldId)
+{
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(dcgmFieldId);
+
+    fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    if (!fieldMeta || fieldMeta->fieldId == DCGM_FI_UNKNOWN)
+    {
+        log_error("dcgmFieldId does not exist: {}", dcgmFieldId);
+        return DCGM_ST_UNKNOWN_FIELD;
+    }
+
+    if (fieldMeta->scope != DCGM_FS_DEVICE)
+    {
+        log_error("field {} does not have scope DCGM_FS_DEVICE", dcgmFieldId);
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (gpuId >= m_numGpus)
+    {
+        log_error("invalid gpuId: {}", gpuId);
+        return DCGM_ST_BADPARAM;
+    }
+
+    return DCGM_ST_OK;
+}
+
+void DcgmCacheManager::GetRuntimeStats(dcgmcm_runtime_stats_p stats)
+{
+    if (!stats)
+        return;
+
+    m_runStats.lockCount             = m_mutex->GetLockCount();
+    m_runStats.lockContendedCount    = m_mutex->GetContendedCount();
+    m_runStats.lockContendedWaitUsec = m_mutex->GetContendedWaitUsec();
+    m_runStats.latestValueHits       = m_latestValues.GetHitCount();
+    m_runStats.latestValueMisses     = m_latestValues.GetMissCount();
+    m_runStats.latestValueContended  = m_latestValues.GetContendedCount();
+    m_runStats.compressedSampleBytes = GetCompressedSampleBytes();
+    GetSampleArenaBytes(m_runStats.arenaReservedBytes, m_runStats.arenaLiveBytes);
+
+    *stats = m_runStats;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::SetMemoryBudget(long long budgetBytes)
+{
+    std::lock_guard<std::mutex> guard(m_memoryBudgetStatsLock);
+    m_memoryBudgetStats.budgetBytes = std::max(0LL, budgetBytes);
+}
+
+/*****************************************************************************/
+/* Bytes charged to a watch against the memory budget */
+static long long WatchInfoBytesUsed(dcgmcm_watch_info_p watchInfo)
+{
+    long long bytesUsed = 0;
+    if (watchInfo->timeSeries)
+    {
+        bytesUsed += timeseries_bytes_used(watchInfo->timeSeries);
+    }
+    if (watchInfo->historyTimeSeries)
+    {
+        bytesUsed += timeseries_bytes_used(watchInfo->historyTimeSeries);
+    }
+    return bytesUsed;
+}
+
+/*****************************************************************************/
+void DcgmCacheManager::EnforceMemoryBudget()
+{
+    dcgmcm_memory_budget_stats_t stats;
+    GetMemoryBudgetStats(stats);
+
+    long long const budgetBytes = stats.budgetBytes;
+    if (budgetBytes == 0)
+    {
+        return;
+    }
+
+    DcgmLockGuard dlg(m_mutex);
+
+    struct EvictionCandidate
+    {
+        dcgmcm_watch_info_p watchInfo;
+        long long bytesUsed;
+        bool isInternal; /* Does an internal module watch this? Those are evicted last */
+        timelib64_t lastReadUsec;
+    };
+
+    std::vector<EvictionCandidate> candidates;
+    long long cachedBytes = 0;
+
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        long long const bytesUsed = WatchInfoBytesUsed(watchInfo);
+        if (bytesUsed == 0)
+        {
+            continue;
+        }
+        cachedBytes += bytesUsed;
+
+        bool const isInternal = std::any_of(watchInfo->watchers.begin(), watchInfo->watchers.end(), [](auto const &w) {
+            return w.watcher.watcherType != DcgmWatcherTypeClient;
+        });
+        candidates.push_back({ watchInfo, bytesUsed, isInternal, watchInfo->lastReadUsec });
+    }
+
+    if (cachedBytes <= budgetBytes)
+    {
+        std::lock_guard<std::mutex> guard(m_memoryBudgetStatsLock);
+        m_memoryBudgetStats.cachedBytes = cachedBytes;
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](EvictionCandidate const &a, EvictionCandidate const &b) {
+        return std::tie(a.isInternal, a.lastReadUsec) < std::tie(b.isInternal, b.lastReadUsec);
+    });
+
+    for (EvictionCandidate const &candidate : candidates)
+    {
+        if (cachedBytes <= budgetBytes)
+        {
+            break;
+        }
+
+        dcgmcm_watch_info_p watchInfo  = candidate.watchInfo;
+        long long const evictedSamples = EvictWatchInfoSamples(watchInfo);
+        if (evictedSamples == 0)
+        {
+            continue;
+        }
+
+        long long const freedBytes = candidate.bytesUsed - WatchInfoBytesUsed(watchInfo);
+        cachedBytes -= freedBytes;
+
+        stats.evictions++;
+        stats.evictedSamples += evictedSamples;
+        stats.evictedBytes += freedBytes;
+
+        log_debug("Evicted {} samples ({} bytes) of eg {}, eid {}, fieldId {} to stay within the memory budget",
+                  evictedSamples,
+                  freedBytes,
+                  watchInfo->watchKey.entityGroupId,
+                  watchInfo->watchKey.entityId,
+                  watchInfo->watchKey.fieldId);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_memoryBudgetStatsLock);
+        m_memoryBudgetStats.cachedBytes    = cachedBytes;
+        m_memoryBudgetStats.evictions      = stats.evictions;
+        m_memoryBudgetStats.evictedSamples = stats.evictedSamples;
+        m_memoryBudgetStats.evictedBytes   = stats.evictedBytes;
+    }
+
+    if (cachedBytes > budgetBytes)
+    {
+        log_debug("Cached samples take {} bytes after eviction. The budget is {} bytes", cachedBytes, budgetBytes);
+    }
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmCacheManager::CheckValidGlobalField(unsigned short dcgmFieldId)
+long long DcgmCacheManager::EvictWatchInfoSamples(dcgmcm_watch_info_p watchInfo)
 {
-    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    long long evictedSamples = 0;
 
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta || fieldMeta->fieldId == DCGM_FI_UNKNOWN)
+    if (watchInfo->historyTimeSeries)
     {
-        log_error("dcgmFieldId is invalid: {}", dcgmFieldId);
-        return DCGM_ST_UNKNOWN_FIELD;
+        evictedSamples += timeseries_size(watchInfo->historyTimeSeries);
+        timeseries_destroy(watchInfo->historyTimeSeries);
+        watchInfo->historyTimeSeries = nullptr;
     }
 
-    if (fieldMeta->scope != DCGM_FS_GLOBAL)
+    int const numSamples = watchInfo->timeSeries ? timeseries_size(watchInfo->timeSeries) : 0;
+    if (numSamples <= 1)
     {
-        log_error("field {} does not have scope DCGM_FS_GLOBAL", dcgmFieldId);
-        return DCGM_ST_BADPARAM;
+        return evictedSamples;
     }
 
-    return DCGM_ST_OK;
+    /* Evicting entries doesn't give back the capacity of a series, so move the latest sample to a new one */
+    timeseries_p oldSeries = watchInfo->timeSeries;
+    kv_cursor_t cursor;
+    timeseries_entry_t const latest = *timeseries_last(oldSeries, &cursor);
+
+    watchInfo->timeSeries = nullptr;
+    if (AllocWatchInfoTimeSeries(watchInfo, oldSeries->tsType) != DCGM_ST_OK)
+    {
+        watchInfo->timeSeries = oldSeries;
+        return evictedSamples;
+    }
+
+    switch (oldSeries->tsType)
+    {
+        case TS_TYPE_INT64:
+            timeseries_insert_int64(watchInfo->timeSeries, latest.usecSince1970, latest.val.i64, latest.val2.i64);
+            break;
+        case TS_TYPE_DOUBLE:
+            timeseries_insert_double(watchInfo->timeSeries, latest.usecSince1970, latest.val.dbl, latest.val2.dbl);
+            break;
+        case TS_TYPE_STRING:
+            timeseries_insert_string(watchInfo->timeSeries, latest.usecSince1970, (char const *)latest.val.ptr);
+            break;
+        case TS_TYPE_BLOB:
+            timeseries_insert_blob(
+                watchInfo->timeSeries, latest.usecSince1970, latest.val.ptr, (int)latest.val2.ptrSize);
+            break;
+        default:
+            break;
+    }
+
+    /* latest.val.ptr of a string or blob belongs to oldSeries. The insert above copied it */
+    timeseries_destroy(oldSeries);
+
+    if (watchInfo->processStatsIndex)
+    {
+        watchInfo->processStatsIndex->Prune(latest.usecSince1970);
+    }
+    PublishLatestValue(watchInfo);
+
+    return evictedSamples + numSamples - 1;
 }
 
-dcgmReturn_t DcgmCacheManager::CheckValidGpuField(unsigned int gpuId, unsigned short dcgmFieldId)
+/*****************************************************************************/
+void DcgmCacheManager::GetMemoryBudgetStats(dcgmcm_memory_budget_stats_t &stats)
 {
-    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(dcgmFieldId);
+    std::lock_guard<std::mutex> guard(m_memoryBudgetStatsLock);
+    stats = m_memoryBudgetStats;
+}
 
-    fieldMeta = DcgmFieldGetById(dcgmFieldId);
-    if (!fieldMeta || fieldMeta->fieldId == DCGM_FI_UNKNOWN)
+/*****************************************************************************/
+long long DcgmCacheManager::GetCompressedSampleBytes()
+{
+    long long compressedBytes = 0;
+
+    if (!m_compressedTimeSeries)
     {
-        log_error("dcgmFieldId does not exist: {}", dcgmFieldId);
-        return DCGM_ST_UNKNOWN_FIELD;
+        return 0;
     }
 
-    if (fieldMeta->scope != DCGM_FS_DEVICE)
+    DcgmSharedLockGuard dlg(m_mutex);
+
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
     {
-        log_error("field {} does not have scope DCGM_FS_DEVICE", dcgmFieldId);
-        return DCGM_ST_BADPARAM;
+        if (watchInfo->timeSeries)
+        {
+            compressedBytes += timeseries_compressed_bytes(watchInfo->timeSeries);
+        }
     }
 
-    if (gpuId >= m_numGpus)
+    return compressedBytes;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::GetFieldCosts(dcgmIntrospectFieldCosts_v1 &fieldCosts)
+{
+    std::vector<dcgmIntrospectFieldCost_v1> costs;
+
     {
-        log_error("invalid gpuId: {}", gpuId);
-        return DCGM_ST_BADPARAM;
+        DcgmSharedLockGuard dlg(m_mutex);
+
+        for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+        {
+            if (!watchInfo->isWatched)
+            {
+                continue;
+            }
+
+            dcgmIntrospectFieldCost_v1 cost {};
+            cost.entityGroupId   = (dcgm_field_entity_group_t)watchInfo->watchKey.entityGroupId;
+            cost.entityId        = watchInfo->watchKey.entityId;
+            cost.fieldId         = watchInfo->watchKey.fieldId;
+            cost.flags           = watchInfo->pushedByModule ? DCGM_INTROSPECT_FIELD_COST_F_PUSHED : 0;
+            cost.fetchCount      = watchInfo->fetchCount;
+            cost.execTimeUsec    = watchInfo->execTimeUsec;
+            cost.maxExecTimeUsec = watchInfo->maxExecTimeUsec;
+            cost.bytesUsed       = watchInfo->timeSeries ? timeseries_bytes_used(watchInfo->timeSeries) : 0;
+            costs.push_back(cost);
+        }
     }
 
+    std::sort(costs.begin(), costs.end(), [](dcgmIntrospectFieldCost_v1 const &a, dcgmIntrospectFieldCost_v1 const &b) {
+        if (a.execTimeUsec != b.execTimeUsec)
+        {
+            return a.execTimeUsec > b.execTimeUsec;
+        }
+        return a.bytesUsed > b.bytesUsed;
+    });
+
+    fieldCosts.version       = dcgmIntrospectFieldCosts_version1;
+    fieldCosts.numWatches    = costs.size();
+    fieldCosts.numFieldCosts = std::min<size_t>(costs.size(), DCGM_INTROSPECT_MAX_FIELD_COSTS);
+    std::copy_n(costs.begin(), fieldCosts.numFieldCosts, fieldCosts.fieldCosts);
+
     return DCGM_ST_OK;
 }
 
-void DcgmCacheManager::GetRuntimeStats(dcgmcm_runtime_stats_p stats)
+/*****************************************************************************/
+void DcgmCacheManager::GetSampleArenaBytes(long long &reservedBytes, long long &liveBytes)
 {
-    if (!stats)
+    reservedBytes = 0;
+    liveBytes     = 0;
+
+    if (!m_sampleArena)
+    {
         return;
+    }
 
-    m_runStats.lockCount = m_mutex->GetLockCount();
+    DcgmLockGuard dlg(m_mutex);
 
-    *stats = m_runStats;
+    for (dcgmcm_watch_info_p watchInfo : m_entityWatchTable)
+    {
+        if (watchInfo->timeSeries)
+        {
+            long long watchReserved = 0;
+            long long watchLive     = 0;
+            timeseries_arena_bytes(watchInfo->timeSeries, &watchReserved, &watchLive);
+            reservedBytes += watchReserved;
+            liveBytes += watchLive;
+        }
+    }
 }
 
 void DcgmCacheManager::GetValidFieldIds(std::vector<unsigned short> &validFieldIds, bool includeModulePublished)
@@ -12367,31 +17094,46 @@ dcgmReturn_t DcgmCacheManager::GetEntityWatchInfoSnapshot(dcgm_field_entity_grou
 
     return retSt;
 }
+
 /*****************************************************************************/
-void DcgmCacheManager::GetAllWatchObjects(std::vector<dcgmcm_watch_info_p> &watchers)
+std::vector<dcgm_entity_key_t> DcgmCacheManager::GetFieldValuePlanKeys(unsigned int gpuId)
 {
+    std::vector<dcgm_entity_key_t> keys;
+
+    if (gpuId >= DCGM_MAX_NUM_DEVICES)
+    {
+        return keys;
+    }
+
     DcgmLockGuard dlg(m_mutex);
 
-    watchers.clear();
-    watchers.reserve(m_entityWatchHashTable->size);
+    if (m_fieldValuePlanGeneration != m_watchSetGeneration)
+    {
+        BuildFieldValuePlan();
+    }
 
-    for (void *hashIter = hashtable_iter(m_entityWatchHashTable); hashIter;
-         hashIter       = hashtable_iter_next(m_entityWatchHashTable, hashIter))
+    for (auto const &entry : m_fieldValuePlan[gpuId])
     {
-        watchers.push_back((dcgmcm_watch_info_p)hashtable_iter_value(hashIter));
+        keys.push_back(entry.watchInfo->watchKey);
     }
+    return keys;
 }
-
 /*****************************************************************************/
 void DcgmCacheManager::OnConnectionRemove(dcgm_connection_id_t connectionId)
 {
-    /* Since most users of DCGM have a single daemon / user, it's easy enough just
-       to walk every watch in existence and see if the connectionId in question has
-       any watches. If we ever have a lot of different remote clients at once, we can
-       reevaluate doing this and possibly track watches for each user */
+    /* Only visit the watches this connection is a watcher of. Short-lived clients come and go
+       against caches of many watches, so walking every watch here would stall the cache lock */
 
     std::vector<dcgmcm_watch_info_p> watchers;
-    GetAllWatchObjects(watchers);
+    {
+        DcgmLockGuard dlg(m_mutex);
+        auto it = m_connectionWatches.find(connectionId);
+        if (it == m_connectionWatches.end())
+        {
+            return;
+        }
+        watchers.assign(it->second.begin(), it->second.end());
+    }
 
     DcgmWatcher dcgmWatcher(DcgmWatcherTypeClient, connectionId);
 
@@ -12569,40 +17311,26 @@ dcgmReturn_t DcgmCacheManager::UnwatchVgpuFields(nvmlVgpuInstance_t vgpuId)
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::PopulateCpuAffinity(dcgmAffinity_t &affinity)
 {
-    dcgmcm_sample_t sample = {};
-    dcgmReturn_t ret       = GetLatestSample(DCGM_FE_GPU, 0, DCGM_FI_GPU_TOPOLOGY_AFFINITY, &sample, 0);
-
-    if (ret != DCGM_ST_OK)
-    {
-        // The information isn't saved
-        ret = PopulateTopologyAffinity(GetTopologyHelper(), affinity);
-    }
-    else
-    {
-        dcgmAffinity_t *tmp = (dcgmAffinity_t *)sample.val.blob;
-        memcpy(&affinity, tmp, sizeof(affinity));
-        free(tmp);
-    }
+    std::shared_ptr<DcgmTopologySnapshot const> snapshot = GetTopologySnapshot();
 
-    return ret;
+    affinity = snapshot->affinity;
+    return snapshot->affinityRet;
 }
 
 /*****************************************************************************/
 dcgmTopology_t *DcgmCacheManager::GetNvLinkTopologyInformation()
 {
-    unsigned int topologySize = 0;
-    dcgmTopology_t *topPtr    = NULL;
-    dcgmcm_sample_t sample;
+    std::shared_ptr<DcgmTopologySnapshot const> snapshot = GetTopologySnapshot();
 
-    dcgmReturn_t ret = GetLatestSample(DCGM_FE_GPU, 0, DCGM_FI_GPU_TOPOLOGY_NVLINK, &sample, 0);
-
-    if (ret != DCGM_ST_OK)
+    if (snapshot->nvLink == nullptr)
     {
-        PopulateTopologyNvLink(GetTopologyHelper(true), &topPtr, topologySize);
+        return nullptr;
     }
-    else
+
+    auto *topPtr = (dcgmTopology_t *)malloc(snapshot->nvLinkSize);
+    if (topPtr != nullptr)
     {
-        topPtr = (dcgmTopology_t *)sample.val.blob;
+        memcpy(topPtr, snapshot->nvLink.get(), snapshot->nvLinkSize);
     }
 
     return topPtr;
@@ -12613,12 +17341,6 @@ dcgmReturn_t DcgmCacheManager::SelectGpusByTopology(std::vector<unsigned int> &g
                                                     uint32_t numGpus,
                                                     uint64_t &outputGpus)
 {
-    dcgmReturn_t ret = DCGM_ST_OK;
-
-    // First, group them by cpu affinity
-    dcgmAffinity_t affinity  = {};
-    dcgmTopology_t *topology = nullptr;
-
     if (gpuIds.size() <= numGpus)
     {
         // We don't have enough healthy gpus to be picky, just set the bitmap
@@ -12632,44 +17354,87 @@ dcgmReturn_t DcgmCacheManager::SelectGpusByTopology(std::vector<unsigned int> &g
         }
     }
 
-    ret = PopulateCpuAffinity(affinity);
+    std::shared_ptr<DcgmTopologySnapshot const> snapshot = GetTopologySnapshot();
 
-    if (ret != DCGM_ST_OK)
+    if (snapshot->affinityRet != DCGM_ST_OK)
     {
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    topology = GetNvLinkTopologyInformation();
+    // First, group them by cpu affinity
+    dcgmAffinity_t affinity = snapshot->affinity;
 
-    return HelperSelectGpusByTopology(gpuIds, numGpus, outputGpus, affinity, topology);
+    return HelperSelectGpusByTopology(
+        gpuIds, numGpus, outputGpus, affinity, snapshot->nvLink != nullptr ? &snapshot->linkScores : nullptr);
 }
 
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::PopulateNvLinkLinkStatus(dcgmNvLinkStatus_v4 &nvLinkStatus)
 {
-    int j;
+    auto snapshot = m_nvLinkStatusSnapshot.load();
+    if (snapshot == nullptr)
+    {
+        PublishGpuNvLinkStatus();
+        snapshot = m_nvLinkStatusSnapshot.load();
+    }
 
-    nvLinkStatus.version = dcgmNvLinkStatus_version4;
+    nvLinkStatus = snapshot->status;
+    return DCGM_ST_OK;
+}
 
-    for (unsigned int i = 0; i < m_numGpus; i++)
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheManager::SetNvSwitchLinkStatus(dcgmReturn_t nvSwitchRet,
+                                                     unsigned int numNvSwitches,
+                                                     dcgmNvLinkNvSwitchLinkStatus_t const *nvSwitches)
+{
+    if (numNvSwitches > DCGM_MAX_NUM_SWITCHES || (numNvSwitches > 0 && nvSwitches == nullptr))
     {
-        if (m_gpus[i].status == DcgmEntityStatusDetached)
-            continue;
+        log_error("Bad parameter: {} NvSwitches", numNvSwitches);
+        return DCGM_ST_BADPARAM;
+    }
 
-        /* Make sure the GPU NvLink states are up to date before we return them to users */
-        UpdateNvLinkLinkState(m_gpus[i].gpuId);
+    std::lock_guard<std::mutex> lg(m_nvLinkStatusPublishMutex);
 
-        nvLinkStatus.gpus[i].entityId = m_gpus[i].gpuId;
-        for (j = 0; j < DCGM_NVLINK_MAX_LINKS_PER_GPU; j++)
-        {
-            nvLinkStatus.gpus[i].linkState[j] = m_gpus[i].nvLinkLinkState[j];
-        }
+    auto const previous = m_nvLinkStatusSnapshot.load();
+    auto snapshot       = previous != nullptr ? std::make_shared<DcgmNvLinkStatusSnapshot>(*previous)
+                                              : std::make_shared<DcgmNvLinkStatusSnapshot>();
+    dcgmNvLinkStatus_v4 &status = snapshot->status;
+
+    status.version = dcgmNvLinkStatus_version4;
+    memset(status.nvSwitches, 0, sizeof(status.nvSwitches));
+    if (numNvSwitches > 0)
+    {
+        memcpy(status.nvSwitches, nvSwitches, numNvSwitches * sizeof(nvSwitches[0]));
     }
-    nvLinkStatus.numGpus = m_numGpus;
+    status.numNvSwitches = numNvSwitches;
+    snapshot->nvSwitchRet = nvSwitchRet;
 
+    if (previous != nullptr && previous->nvSwitchRet == nvSwitchRet && previous->status.numNvSwitches == numNvSwitches
+        && memcmp(previous->status.nvSwitches, status.nvSwitches, sizeof(status.nvSwitches)) == 0)
+    {
+        return DCGM_ST_OK;
+    }
+
+    snapshot->version++;
+    log_debug("Publishing NvLink status version {} for {} NvSwitches ({})",
+              snapshot->version,
+              numNvSwitches,
+              errorString(nvSwitchRet));
+    m_nvLinkStatusSnapshot.store(std::move(snapshot));
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+std::optional<dcgmReturn_t> DcgmCacheManager::GetNvSwitchLinkStatusRet() const
+{
+    auto const snapshot = m_nvLinkStatusSnapshot.load();
+    if (snapshot == nullptr)
+    {
+        return std::nullopt;
+    }
+    return snapshot->nvSwitchRet;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::CreateMigEntity(const dcgmCreateMigEntity_v1 &cme)
 {
@@ -12725,6 +17490,10 @@ dcgmReturn_t DcgmCacheManager::CreateMigEntity(const dcgmCreateMigEntity_v1 &cme
                         {
                             DCGM_LOG_ERROR << "Couldn't create GPU instance: " << nvmlErrorString(nvmlRet);
                         }
+                        else
+                        {
+                            ApplyMigEntityChange(gpuId, cme.flags);
+                        }
                     }
                     else
                     {
@@ -12778,17 +17547,18 @@ dcgmReturn_t DcgmCacheManager::CreateMigEntity(const dcgmCreateMigEntity_v1 &cme
                         return DCGM_ST_BADPARAM;
                     }
 
-                    unsigned int localIndex = cme.parentId % m_gpus[gpuId].maxGpcs;
-                    if (localIndex >= m_gpus[gpuId].instances.size())
+                    DcgmGpuInstance const *parent
+                        = FindGpuInstance(gpuId, DcgmNs::Mig::GpuInstanceId { cme.parentId });
+                    if (parent == nullptr)
                     {
-                        DCGM_LOG_ERROR << "Cannot create compute instance as the computed NVML GPU instance index "
-                                       << "exceeds known GPU instances on GPU. GpuId: " << gpuId
-                                       << ", computed NVML index: " << localIndex
+                        DCGM_LOG_ERROR << "Cannot create compute instance as the GPU instance is not among the known "
+                                       << "GPU instances on GPU. GpuId: " << gpuId
+                                       << ", GpuInstanceId: " << cme.parentId
                                        << ", number of known GPU instances: " << m_gpus[gpuId].instances.size();
                         return DCGM_ST_BADPARAM;
                     }
 
-                    nvmlGpuInstance_t instance = m_gpus[gpuId].instances[localIndex].GetInstanceHandle();
+                    nvmlGpuInstance_t instance = parent->GetInstanceHandle();
 
                     nvmlComputeInstanceProfileInfo_t ciProfileInfo {};
                     nvmlReturn_t nvmlRet = nvmlGpuInstanceGetComputeInstanceProfileInfo(
@@ -12802,6 +17572,10 @@ dcgmReturn_t DcgmCacheManager::CreateMigEntity(const dcgmCreateMigEntity_v1 &cme
                         {
                             DCGM_LOG_ERROR << "Couldn't create compute instance: " << nvmlErrorString(nvmlRet);
                         }
+                        else
+                        {
+                            ApplyMigEntityChange(gpuId, cme.flags);
+                        }
                     }
                     else
                     {
@@ -12826,6 +17600,24 @@ dcgmReturn_t DcgmCacheManager::CreateMigEntity(const dcgmCreateMigEntity_v1 &cme
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmCacheManager::ApplyMigEntityChange(unsigned int gpuId, unsigned int flags)
+{
+    if (flags & DCGM_MIG_RECONFIG_DELAY_PROCESSING)
+    {
+        /* The caller has more changes coming and will wait for them to be processed together */
+        return;
+    }
+
+    /* Re-read just this GPU now rather than when the NVML event comes in. The event thread tells the subscribers */
+    DcgmLockGuard dlg(m_mutex);
+    dcgmReturn_t ret = ReinitializeGpuInstances(m_gpus[gpuId]);
+    if (ret != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "Could not re-initialize MIG information for GPU " << gpuId << ": " << errorString(ret);
+    }
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmCacheManager::DeleteMigEntity(const dcgmDeleteMigEntity_v1 &dme)
 {
@@ -12854,14 +17646,18 @@ dcgmReturn_t DcgmCacheManager::DeleteMigEntity(const dcgmDeleteMigEntity_v1 &dme
                 return ret;
             }
 
-            unsigned int localIndex = dme.entityId % m_gpus[gpuId].maxGpcs;
-            if (m_gpus[gpuId].instances.size() <= localIndex)
+            DcgmGpuInstance const *instance = FindGpuInstance(gpuId, DcgmNs::Mig::GpuInstanceId { dme.entityId });
+            if (instance == nullptr)
             {
                 DCGM_LOG_ERROR << "Cannot delete unknown instance id " << dme.entityId;
                 return DCGM_ST_BADPARAM;
             }
 
-            nvmlReturn_t nvmlRet = nvmlGpuInstanceDestroy(m_gpus[gpuId].instances[localIndex].GetInstanceHandle());
+            nvmlReturn_t nvmlRet = nvmlGpuInstanceDestroy(instance->GetInstanceHandle());
+            if (nvmlRet == NVML_SUCCESS)
+            {
+                ApplyMigEntityChange(gpuId, dme.flags);
+            }
             return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlRet);
 
             break; // NOT REACHED
@@ -12879,17 +17675,16 @@ dcgmReturn_t DcgmCacheManager::DeleteMigEntity(const dcgmDeleteMigEntity_v1 &dme
                 return ret;
             }
 
-            unsigned int localInstanceIndex  = instanceId.id % m_gpus[gpuId].maxGpcs;
+            DcgmGpuInstance *instance        = FindGpuInstance(gpuId, instanceId);
             dcgmcm_gpu_compute_instance_t ci = {};
 
-            if (m_gpus[gpuId].instances.size() <= localInstanceIndex)
+            if (instance == nullptr)
             {
                 DCGM_LOG_ERROR << "Cannot delete unknown compute instance id " << dme.entityId;
                 return DCGM_ST_BADPARAM;
             }
 
-            ret = m_gpus[gpuId].instances[localInstanceIndex].GetComputeInstanceById(
-                DcgmNs::Mig::ComputeInstanceId { dme.entityId }, ci);
+            ret = instance->GetComputeInstanceById(DcgmNs::Mig::ComputeInstanceId { dme.entityId }, ci);
             if (ret != DCGM_ST_OK)
             {
                 DCGM_LOG_ERROR << "Cannot delete unknown compute instance id " << dme.entityId;
@@ -12897,6 +17692,10 @@ dcgmReturn_t DcgmCacheManager::DeleteMigEntity(const dcgmDeleteMigEntity_v1 &dme
             }
 
             nvmlReturn_t nvmlRet = nvmlComputeInstanceDestroy(ci.computeInstance);
+            if (nvmlRet == NVML_SUCCESS)
+            {
+                ApplyMigEntityChange(gpuId, dme.flags);
+            }
             return DcgmNs::Utils::NvmlReturnToDcgmReturn(nvmlRet);
 
             break; // NOT REACHED
@@ -12926,9 +17725,7 @@ dcgmReturn_t DcgmCacheManager::GetEntityNvLinkLinkStatus(dcgm_field_entity_group
         return DCGM_ST_BADPARAM;
     }
 
-    /* Make sure the GPU NvLink states are up to date before we return them to users */
-    UpdateNvLinkLinkState(entityId);
-
+    /* The update thread keeps these up to date. See RefreshNvLinkLinkStates() */
     memcpy(linkStates, m_gpus[entityId].nvLinkLinkState, sizeof(m_gpus[entityId].nvLinkLinkState));
 
     return DCGM_ST_OK;
@@ -12954,6 +17751,9 @@ dcgmReturn_t DcgmCacheManager::UpdateNvLinkLinkState(unsigned int gpuId)
     bool migIsEnabledForGpu    = IsGpuMigEnabled(gpuId);
     bool migIsEnabledForAnyGpu = IsMigEnabledAnywhere();
 
+    dcgmNvLinkLinkState_t previousLinkState[DCGM_NVLINK_MAX_LINKS_PER_GPU];
+    memcpy(previousLinkState, gpu->nvLinkLinkState, sizeof(previousLinkState));
+
     DCGM_LOG_DEBUG << "gpuId " << gpuId << " has migIsEnabledForGpu = " << migIsEnabledForGpu
                    << " migIsEnabledForAnyGpu " << migIsEnabledForAnyGpu;
 
@@ -12978,6 +17778,11 @@ dcgmReturn_t DcgmCacheManager::UpdateNvLinkLinkState(unsigned int gpuId)
         memcpy(gpu->nvLinkLinkState, gpuInfo.nvLinkLinkState, sizeof(gpuInfo.nvLinkLinkState));
     }
 
+    if (memcmp(previousLinkState, gpu->nvLinkLinkState, sizeof(previousLinkState)) != 0)
+    {
+        InvalidateTopologySnapshot();
+    }
+
     return DCGM_ST_OK;
 }
 
@@ -13173,7 +17978,8 @@ dcgmReturn_t DcgmCacheManager::GetMigIndicesForEntity(dcgmGroupEntityPair_t cons
 
 nvmlDevice_t DcgmCacheManager::GetComputeInstanceNvmlDevice(unsigned int gpuId,
                                                             dcgm_field_entity_group_t entityGroupId,
-                                                            unsigned int entityId)
+                                                            unsigned int entityId,
+                                                            unsigned int *instanceIndex)
 {
     if (gpuId >= m_numGpus)
     {
@@ -13209,6 +18015,10 @@ nvmlDevice_t DcgmCacheManager::GetComputeInstanceNvmlDevice(unsigned int gpuId,
     {
         if (m_gpus[gpuId].instances[i].GetInstanceId().id == gpuInstanceId)
         {
+            if (instanceIndex != nullptr)
+            {
+                *instanceIndex = i;
+            }
             return m_gpus[gpuId].instances[i].GetMigDeviceHandle(computeInstanceId);
         }
     }
@@ -13217,6 +18027,78 @@ nvmlDevice_t DcgmCacheManager::GetComputeInstanceNvmlDevice(unsigned int gpuId,
     return nullptr;
 }
 
+/*****************************************************************************/
+nvmlReturn_t DcgmCacheManager::ReadMigFbMemoryInfo(dcgmcm_update_thread_t *threadCtx,
+                                                   unsigned int gpuId,
+                                                   nvmlMemory_v2_t &fbMemory)
+{
+    unsigned int instanceIndex  = DCGM_MAX_INSTANCES_PER_GPU;
+    nvmlDevice_t instanceDevice = GetComputeInstanceNvmlDevice(
+        gpuId,
+        static_cast<dcgm_field_entity_group_t>(threadCtx->entityKey.entityGroupId),
+        threadCtx->entityKey.entityId,
+        &instanceIndex);
+    if (instanceDevice == nullptr || instanceIndex >= DCGM_MAX_INSTANCES_PER_GPU)
+    {
+        return NVML_ERROR_INVALID_ARGUMENT;
+    }
+
+    dcgmcm_mig_memory_t &memory = threadCtx->migMemory[gpuId][instanceIndex];
+    unsigned char const bit     = 1 << instanceIndex;
+
+    if ((threadCtx->migFbMemoryRead[gpuId] & bit) == 0)
+    {
+        memory.fbMemory = {};
+        if (m_driverMajorVersion >= DRIVER_VERSION_510)
+        {
+            memory.fbMemory.version = nvmlMemory_v2;
+            memory.fbStatus         = nvmlDeviceGetMemoryInfo_v2(instanceDevice, &memory.fbMemory);
+        }
+        else
+        {
+            nvmlMemory_t fbMemoryV1 {};
+            memory.fbStatus       = nvmlDeviceGetMemoryInfo(instanceDevice, &fbMemoryV1);
+            memory.fbMemory.total = fbMemoryV1.total;
+            memory.fbMemory.free  = fbMemoryV1.free;
+            memory.fbMemory.used  = fbMemoryV1.used;
+        }
+        threadCtx->migFbMemoryRead[gpuId] |= bit;
+    }
+
+    fbMemory = memory.fbMemory;
+    return memory.fbStatus;
+}
+
+/*****************************************************************************/
+nvmlReturn_t DcgmCacheManager::ReadMigBar1MemoryInfo(dcgmcm_update_thread_t *threadCtx,
+                                                     unsigned int gpuId,
+                                                     nvmlBAR1Memory_t &bar1Memory)
+{
+    unsigned int instanceIndex  = DCGM_MAX_INSTANCES_PER_GPU;
+    nvmlDevice_t instanceDevice = GetComputeInstanceNvmlDevice(
+        gpuId,
+        static_cast<dcgm_field_entity_group_t>(threadCtx->entityKey.entityGroupId),
+        threadCtx->entityKey.entityId,
+        &instanceIndex);
+    if (instanceDevice == nullptr || instanceIndex >= DCGM_MAX_INSTANCES_PER_GPU)
+    {
+        return NVML_ERROR_INVALID_ARGUMENT;
+    }
+
+    dcgmcm_mig_memory_t &memory = threadCtx->migMemory[gpuId][instanceIndex];
+    unsigned char const bit     = 1 << instanceIndex;
+
+    if ((threadCtx->migBar1MemoryRead[gpuId] & bit) == 0)
+    {
+        memory.bar1Memory = {};
+        memory.bar1Status = nvmlDeviceGetBAR1MemoryInfo(instanceDevice, &memory.bar1Memory);
+        threadCtx->migBar1MemoryRead[gpuId] |= bit;
+    }
+
+    bar1Memory = memory.bar1Memory;
+    return memory.bar1Status;
+}
+
 nvmlDevice_t DcgmCacheManager::GetNvmlDeviceFromEntityId(dcgm_field_eid_t entityId) const
 {
     if (entityId >= m_numGpus)
@@ -13235,6 +18117,7 @@ dcgmReturn_t DcgmCacheManager::InjectNvmlGpu(dcgm_field_eid_t gpuId,
                                              const injectNvmlRet_t &injectNvmlRet)
 {
     nvmlDevice_t nvmlDevice = GetNvmlDeviceFromEntityId(gpuId);
+    m_staticFields.InvalidateGpu(gpuId);
     return m_nvmlInjectionManager.InjectGpu(nvmlDevice, key, extraKeys, extraKeyCount, injectNvmlRet);
 }
 
@@ -13246,6 +18129,7 @@ dcgmReturn_t DcgmCacheManager::InjectNvmlGpuForFollowingCalls(dcgm_field_eid_t g
                                                               unsigned int retCount)
 {
     nvmlDevice_t nvmlDevice = GetNvmlDeviceFromEntityId(gpuId);
+    m_staticFields.InvalidateGpu(gpuId);
     return m_nvmlInjectionManager.InjectGpuForFollowingCalls(
         nvmlDevice, key, extraKeys, extraKeyCount, injectNvmlRets, retCount);
 }
@@ -13253,6 +18137,7 @@ dcgmReturn_t DcgmCacheManager::InjectNvmlGpuForFollowingCalls(dcgm_field_eid_t g
 dcgmReturn_t DcgmCacheManager::InjectedNvmlGpuReset(dcgm_field_eid_t gpuId)
 {
     nvmlDevice_t nvmlDevice = GetNvmlDeviceFromEntityId(gpuId);
+    m_staticFields.InvalidateGpu(gpuId);
     return m_nvmlInjectionManager.InjectedGpuReset(nvmlDevice);
 }
 
@@ -13263,11 +18148,13 @@ dcgmReturn_t DcgmCacheManager::GetNvmlInjectFuncCallCount(injectNvmlFuncCallCoun
 
 dcgmReturn_t DcgmCacheManager::RemoveNvmlInjectedGpu(char const *uuid)
 {
+    m_staticFields.InvalidateAll();
     return m_nvmlInjectionManager.RemoveGpu(uuid);
 }
 
 dcgmReturn_t DcgmCacheManager::RestoreNvmlInjectedGpu(char const *uuid)
 {
+    m_staticFields.InvalidateAll();
     return m_nvmlInjectionManager.RestoreGpu(uuid);
 }
 
@@ -13293,6 +18180,7 @@ dcgmReturn_t DcgmCacheManager::InjectNvmlFieldValue(dcgm_field_eid_t gpuId,
                                                     dcgm_field_meta_p fieldMeta)
 {
     nvmlDevice_t nvmlDevice = GetNvmlDeviceFromEntityId(gpuId);
+    m_staticFields.InvalidateGpu(gpuId);
     return m_nvmlInjectionManager.InjectFieldValue(nvmlDevice, value, fieldMeta);
 }
 
@@ -13311,6 +18199,61 @@ DcgmCacheManagerEventThread::DcgmCacheManagerEventThread(DcgmCacheManager *cache
 DcgmCacheManagerEventThread::~DcgmCacheManagerEventThread(void)
 {}
 
+/*****************************************************************************/
+DcgmCacheManagerUpdateWorker::DcgmCacheManagerUpdateWorker(DcgmCacheManager *cacheManager, unsigned int gpuId)
+    : DcgmThread(fmt::format("cache_mgr_gpu{}", gpuId))
+    , m_cacheManager(cacheManager)
+    , m_gpuId(gpuId)
+    , m_threadCtx(nullptr)
+    , m_lastCycle(0)
+    , m_earliestNextUpdate(0)
+    , m_assignedCycle(0)
+    , m_busy(false)
+    , m_cycleStartUsec(0)
+{
+    m_threadCtx = new dcgmcm_update_thread_t {};
+}
+
+/*****************************************************************************/
+DcgmCacheManagerUpdateWorker::~DcgmCacheManagerUpdateWorker()
+{
+    /* The thread has to be gone before its context can be freed */
+    try
+    {
+        StopAndWait(10000);
+    }
+    catch (...)
+    {
+        log_error("Exception while stopping the update worker for gpuId {}", m_gpuId);
+    }
+
+    if (m_threadCtx != nullptr)
+    {
+        delete m_threadCtx->fvBuffer;
+        delete m_threadCtx;
+        m_threadCtx = nullptr;
+    }
+}
+
+/*****************************************************************************/
+void DcgmCacheManagerUpdateWorker::run(void)
+{
+    log_info("DcgmCacheManagerUpdateWorker started for gpuId {}", m_gpuId);
+
+    while (!ShouldStop())
+    {
+        m_cacheManager->UpdateWorkerMain(this);
+    }
+
+    log_info("DcgmCacheManagerUpdateWorker ended for gpuId {}", m_gpuId);
+}
+
+/*****************************************************************************/
+void DcgmCacheManagerUpdateWorker::OnStop(void)
+{
+    m_cacheManager->WakeUpdateWorkers();
+}
+
 /*****************************************************************************/
 void DcgmCacheManagerEventThread::run(void)
 {
@@ -13325,3 +18268,29 @@ void DcgmCacheManagerEventThread::run(void)
 }
 
 /*****************************************************************************/
+void DcgmCacheManagerEventThread::OnStop(void)
+{
+    m_cacheManager->WakeEventThread();
+}
+
+/*****************************************************************************/
+DcgmCacheManagerGpuEventThread::DcgmCacheManagerGpuEventThread(DcgmCacheManager *cacheManager, unsigned int gpuId)
+    : DcgmThread(fmt::format("cache_mgr_ev{}", gpuId))
+    , m_cacheManager(cacheManager)
+    , m_gpuId(gpuId)
+{}
+
+/*****************************************************************************/
+void DcgmCacheManagerGpuEventThread::run(void)
+{
+    log_info("DcgmCacheManagerGpuEventThread started for gpuId {}", m_gpuId);
+
+    while (!ShouldStop())
+    {
+        m_cacheManager->GpuEventThreadMain(this);
+    }
+
+    log_info("DcgmCacheManagerGpuEventThread ended for gpuId {}", m_gpuId);
+}
+
+/*****************************************************************************/
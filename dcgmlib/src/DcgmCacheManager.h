@@ -15,34 +15,55 @@
  */
 #pragma once
 
+#include "DcgmAccountingPidCache.h"
 #include "DcgmDiscovery.h"
+#include "DcgmEntityStatusTable.h"
+#include "DcgmEntityKeyMap.h"
 #include "DcgmFvBuffer.h"
 #include "DcgmGpmManager.hpp"
+#include "DcgmCacheSnapshot.h"
 #include "DcgmGpuInstance.h"
 #include "DcgmInjectionNvmlManager.h"
 #include "DcgmKmsgReader.h"
+#include "DcgmLatestValueCache.h"
+#include "DcgmLatestValueSlots.h"
 #include "DcgmMigManager.h"
 #include "DcgmMutex.h"
+#include "DcgmProcessStatsIndex.h"
+#include "DcgmSampleRollups.h"
 #include "DcgmSettings.h"
+#include "DcgmSharedLatestValues.h"
+#include "DcgmStaticFieldCache.h"
 #include "DcgmTopology.hpp"
+#include "DcgmWatchScheduler.h"
 #include "DcgmWatchTable.h"
 #include "DcgmWatcher.h"
 #include "dcgm_fields.h"
 #include "dcgm_fields_internal.hpp"
 #include "dcgm_structs.h"
-#include "hashtable.h"
 #include "timelib.h"
 #include "timeseries.h"
 
 #include <DcgmTaskRunner.h>
+#include <TimeLib.hpp>
+#include <WorkStealingThreadPool.hpp>
 
+#include <array>
+#include <atomic>
 #include <bitset>
 #include <condition_variable>
 #include <dcgm_nvml.h>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 /*****************************************************************************/
 /* Summary information types */
@@ -56,6 +77,9 @@ typedef enum
     DcgmcmSummaryTypeIntegral,    /* Integral of the values (area under values) */
     DcgmcmSummaryTypeDifference,  /* Difference between the first and last
                                        non-blank value (last - first) */
+    DcgmcmSummaryTypeP50,         /* 50th percentile of the values. Within DcgmQuantileSketch::c_relativeAccuracy */
+    DcgmcmSummaryTypeP95,         /* 95th percentile of the values. Same accuracy as DcgmcmSummaryTypeP50 */
+    DcgmcmSummaryTypeP99,         /* 99th percentile of the values. Same accuracy as DcgmcmSummaryTypeP50 */
 
     DcgmcmSummaryTypeSize /* Always last entry */
 } DcgmcmSummaryType_t;
@@ -129,8 +153,9 @@ typedef struct dcgmcm_watch_info_t
                                            field. If 0, the class default is used */
     timelib64_t execTimeUsec;                        /* Cumulative time spent updating this
                                            field since the cache manager started */
+    timelib64_t maxExecTimeUsec;                     /* Longest single update of this field */
     long long fetchCount;                            /* Number of times that this field has been
-                                           fetched from the driver */
+                                           fetched from the driver or pushed by a module */
     timeseries_p timeSeries;                         /* Time-series of values for this watch */
     std::vector<dcgm_watch_watcher_info_t> watchers; /* Info for each watcher of this
                                                        field. monitorIntervalUsec and
@@ -141,16 +166,95 @@ typedef struct dcgmcm_watch_info_t
     dcgm_field_entity_group_t practicalEntityGroupId; /* the entity group id where data should
                                                         be polled */
     dcgm_field_eid_t practicalEntityId;               /* the entity id where data should be pulled */
+    bool inFieldValuePlan;                            /* Is this watch updated from a GPU's field value plan
+                                                         rather than the walk of the watch table? See
+                                                         DcgmCacheManager::m_fieldValuePlan */
+    unsigned int latestValueSlot;                     /* Slot of this watch in DcgmCacheManager::m_latestValueSlots.
+                                                         DCGM_LATEST_VALUE_VIEW_NO_SLOT if it has none */
+    unsigned int sharedLatestValueRow;                /* Row of this watch in DcgmCacheManager::m_sharedLatestValues.
+                                                         DcgmSharedLatestValues::c_noRow if it has none */
+    std::shared_ptr<DcgmSampleRollups<long long>> int64Rollups; /* Downsampled tiers of an int64 timeSeries.
+                                                                   Only kept if m_sampleRollups is set */
+    std::shared_ptr<DcgmSampleRollups<double>> fp64Rollups;     /* Same as int64Rollups for a double timeSeries */
+    std::shared_ptr<DcgmProcessStatsIndex> processStatsIndex;   /* Per-PID index of an accounting data or process
+                                                                   utilization timeSeries. Only kept if it was
+                                                                   created along with the timeSeries */
+    bool changeOnly; /* Are numeric samples that repeat the last cached one dropped rather than cached and published
+                        to subscribers? The last cached sample then stays valid until lastQueriedUsec.
+                        See DcgmCacheManager::m_changeOnlyFieldIds */
+    timeseries_p historyTimeSeries;  /* Samples of a numeric timeSeries thinned to one per historyIntervalUsec and kept
+                                        for historyMaxAgeUsec. Serves the watchers that want samples for longer than
+                                        the fastest watchers. Null if no watcher does. See UpdateWatchFromWatchers() */
+    timelib64_t historyIntervalUsec; /* Spacing of the samples of historyTimeSeries. 0 if there is no history tier */
+    timelib64_t historyMaxAgeUsec;   /* How long historyTimeSeries keeps samples. 0 keeps them forever */
+    timelib64_t lastReadUsec;        /* When samples of this watch were last read under the cache manager mutex.
+                                        Watches read least recently are evicted first to stay within the memory
+                                        budget. See DcgmCacheManager::EnforceMemoryBudget() */
+    double derivedPrevInput;          /* Last sample of inputs[0] of a derived Rate or Duration field. See
+                                         DcgmDerivedFields */
+    timelib64_t derivedPrevInputUsec; /* Timestamp of derivedPrevInput. 0 if there is none yet */
+    double derivedTotal;              /* Running total of a derived Duration field since it was watched */
+    timelib64_t lastDriverReadUsec;   /* When a memory error watch last read the driver rather than skipping an update
+                                         for lack of events. See DcgmCacheManager::SkipUnchangedMemoryErrorWatch() */
+    unsigned long long lastNvmlSampleTs; /* Timestamp of the newest sample cached from NVML's sample buffer. 0 if
+                                            none yet. See DcgmCacheManager::m_nvmlSampleBufferUsec */
 } dcgmcm_watch_info_t, *dcgmcm_watch_info_p;
 
 /*****************************************************************************/
-typedef struct dcgmcm_vgpu_info_t
+/* One watch that is updated by a GPU's batched nvmlDeviceGetFieldValues() call. Also what the update thread
+   context queues for that call, where watchInfo can be NULL for values that are only buffered */
+typedef struct
+{
+    dcgmcm_watch_info_p watchInfo; /* Watch to update */
+    dcgm_field_meta_p fieldMeta;   /* Field meta of watchInfo->watchKey.fieldId */
+    unsigned int nvmlFieldId;      /* NVML_FI_? to request for this watch */
+    unsigned int scopeId;          /* scopeId to request nvmlFieldId with. The NvLink id for per-link fields */
+} dcgmcm_field_value_plan_entry_t;
+
+/*****************************************************************************/
+/* Resolved slots of one GetMultipleLatestSamples() request. See DcgmCacheManager::m_latestValuePlans */
+typedef struct
+{
+    std::vector<dcgmGroupEntityPair_t> entities; /* Entities of the request */
+    std::vector<unsigned short> fieldIds;        /* Field IDs of the request */
+    std::vector<unsigned int> slots;             /* Slot of each entity/field pair in slotTable, entity-major.
+                                                    DcgmLatestValueSlots::c_noSlot for pairs that are looked
+                                                    up one at a time, like non-numeric fields */
+    DcgmLatestValueSlots const *slotTable;       /* DcgmCacheManager::m_latestValueSlots */
+} dcgmcm_latest_value_plan_t;
+
+/*****************************************************************************/
+/* Every watched numeric field and its latest value slot, for exporters that read all of them.
+   See DcgmCacheManager::UpdateLatestValueExportPlan() */
+typedef struct
+{
+    unsigned long long generation         = 0;       /* m_watchSetGeneration this plan was built at. 0 = never */
+    std::vector<dcgm_entity_key_t> keys;             /* Watch keys. Global fields are keyed under DCGM_FE_NONE */
+    std::vector<unsigned int> slots;                 /* Slot of each of keys in slotTable */
+    std::vector<std::string> gpuUuids;               /* UUID of each GPU, indexed by gpuId */
+    DcgmLatestValueSlots const *slotTable = nullptr; /* DcgmCacheManager::m_latestValueSlots */
+} dcgmcm_export_plan_t;
+
+/*****************************************************************************/
+/* Next-due schedule of the watches of one update shard. Only used if
+   DcgmCacheManager::m_deadlineScheduler is set */
+typedef struct dcgmcm_watch_schedule_t
 {
-    nvmlVgpuInstance_t vgpuId;       /* vGPU Instance ID */
-    bool found;                      /* Flag to denote that the vGPU instance is
-                                           still active */
-    struct dcgmcm_vgpu_info_t *next; /* Pointer to the next node in the list */
-} dcgmcm_vgpu_info_t, *dcgmcm_vgpu_info_p;
+    DcgmWatchScheduler scheduler;                  /* Watches of the shard ordered by their next update time */
+    unsigned long long generation = 0;             /* m_watchSetGeneration this schedule was built at */
+    std::vector<dcgmcm_watch_info_p> dueWatches {}; /* Scratch space for the watches popped each cycle */
+} dcgmcm_watch_schedule_t;
+
+/*****************************************************************************/
+/* Circuit breaker of the driver calls made to one GPU. A GPU whose calls keep
+   timing out is quarantined: its watches are skipped, except for a periodic probe
+   call, until a call completes in time again. See DcgmCacheManager::RecordGpuDriverCall() */
+typedef struct dcgmcm_gpu_breaker_t
+{
+    std::atomic_uint consecutiveTimeouts = 0; /* Driver calls in a row that took longer than the breaker timeout */
+    std::atomic_bool quarantined         = false; /* Is the breaker open? */
+    std::atomic_llong nextProbeUsec      = 0;     /* When the next probe of a quarantined GPU is due */
+} dcgmcm_gpu_breaker_t;
 
 extern const unsigned int DCGM_BLANK_ENTITY_ID;
 
@@ -168,7 +272,6 @@ typedef struct dcgmcm_gpu_info_t
         memset(&pciInfo, 0, sizeof(pciInfo));
         arch               = DCGM_CHIP_ARCH_UNKNOWN;
         virtualizationMode = DCGM_GPU_VIRTUALIZATION_MODE_NONE;
-        memset(&vgpuList, 0, sizeof(vgpuList));
         memset(nvLinkLinkState, DcgmNvLinkLinkStateNotSupported, sizeof(nvLinkLinkState));
         numNvLinks = 0;
     }
@@ -185,12 +288,12 @@ typedef struct dcgmcm_gpu_info_t
         , ccMode(0)
         , maxGpcs(other.maxGpcs)
         , usedGpcs(other.usedGpcs)
+        , vgpuInstances(other.vgpuInstances)
         , instances(other.instances)
         , ciCount(other.ciCount)
     {
         memcpy(uuid, other.uuid, sizeof(uuid));
         memcpy(&pciInfo, &other.pciInfo, sizeof(pciInfo));
-        memcpy(&vgpuList, &other.vgpuList, sizeof(vgpuList));
         memcpy(nvLinkLinkState, other.nvLinkLinkState, sizeof(nvLinkLinkState));
     }
 
@@ -212,10 +315,10 @@ typedef struct dcgmcm_gpu_info_t
             numNvLinks         = other.numNvLinks;
             memcpy(uuid, other.uuid, sizeof(uuid));
             memcpy(&pciInfo, &other.pciInfo, sizeof(pciInfo));
-            memcpy(&vgpuList, &other.vgpuList, sizeof(vgpuList));
             memcpy(nvLinkLinkState, other.nvLinkLinkState, sizeof(nvLinkLinkState));
-            instances = other.instances;
-            ciCount   = other.ciCount;
+            vgpuInstances = other.vgpuInstances;
+            instances     = other.instances;
+            ciCount       = other.ciCount;
         }
         return *this;
     }
@@ -237,7 +340,8 @@ typedef struct dcgmcm_gpu_info_t
     unsigned int usedGpcs = 0; /*!< Number of actually used GPCs */
 
     /* vGPU Instance metadata */
-    dcgmcm_vgpu_info_p vgpuList; /* Head pointer of the vGPU linked list for this GPU */
+    std::vector<nvmlVgpuInstance_t> vgpuInstances; /* Active vGPU instances of this GPU, oldest first.
+                                                      Diffed in place by DcgmCacheManager::ManageVgpuList() */
 
     /* NvLink per-lane status */
     dcgmNvLinkLinkState_t nvLinkLinkState[DCGM_NVLINK_MAX_LINKS_PER_GPU];
@@ -279,29 +383,59 @@ struct dcgmcm_runtime_stats_t
     long long lockCount                   = 0; /* Number of times that the cache manager mutex has been locked. This is
                                               periodically snapshotted from the cache manager update threads */
 
+    long long lockContendedCount    = 0; /* Number of cache manager mutex locks that had to wait for another thread */
+    long long lockContendedWaitUsec = 0; /* Total usec spent waiting for the cache manager mutex when contended */
+    long long latestValueHits       = 0; /* Latest-value reads served without taking the cache manager mutex */
+    long long latestValueMisses     = 0; /* Latest-value reads that fell back to the cache manager mutex */
+    long long latestValueContended  = 0; /* Latest-value stripe locks that had to wait for another thread */
+    long long compressedSampleBytes = 0; /* Bytes of encoded samples held by compressed timeseries */
+    long long arenaReservedBytes    = 0; /* Bytes held from the heap by the arenas of string and blob timeseries */
+    long long arenaLiveBytes        = 0; /* Bytes of those arenas holding samples that haven't been evicted */
+
+    std::atomic_llong updatesCoalesced = 0; /* UpdateAllFields() calls that joined an update cycle already queued.
+                                               Counted under m_pendingUpdateLock rather than m_mutex */
+
     dcgmcm_runtime_stats_t() = default;
 
     dcgmcm_runtime_stats_t(dcgmcm_runtime_stats_t const &other) noexcept
     {
-        numSleepsSkipped = other.numSleepsSkipped;
-        numSleepsDone    = other.numSleepsDone;
-        sleepTimeUsec    = other.sleepTimeUsec;
-        awakeTimeUsec    = other.awakeTimeUsec;
-        lockCount        = other.lockCount;
+        numSleepsSkipped      = other.numSleepsSkipped;
+        numSleepsDone         = other.numSleepsDone;
+        sleepTimeUsec         = other.sleepTimeUsec;
+        awakeTimeUsec         = other.awakeTimeUsec;
+        lockCount             = other.lockCount;
+        lockContendedCount    = other.lockContendedCount;
+        lockContendedWaitUsec = other.lockContendedWaitUsec;
+        latestValueHits       = other.latestValueHits;
+        latestValueMisses     = other.latestValueMisses;
+        latestValueContended  = other.latestValueContended;
+        compressedSampleBytes = other.compressedSampleBytes;
+        arenaReservedBytes    = other.arenaReservedBytes;
+        arenaLiveBytes        = other.arenaLiveBytes;
 
         updateCycleFinished.store(other.updateCycleFinished);
+        updatesCoalesced.store(other.updatesCoalesced);
     }
     dcgmcm_runtime_stats_t &operator=(dcgmcm_runtime_stats_t const &other) noexcept
     {
         if (this != &other)
         {
-            numSleepsSkipped = other.numSleepsSkipped;
-            numSleepsDone    = other.numSleepsDone;
-            sleepTimeUsec    = other.sleepTimeUsec;
-            awakeTimeUsec    = other.awakeTimeUsec;
-            lockCount        = other.lockCount;
+            numSleepsSkipped      = other.numSleepsSkipped;
+            numSleepsDone         = other.numSleepsDone;
+            sleepTimeUsec         = other.sleepTimeUsec;
+            awakeTimeUsec         = other.awakeTimeUsec;
+            lockCount             = other.lockCount;
+            lockContendedCount    = other.lockContendedCount;
+            lockContendedWaitUsec = other.lockContendedWaitUsec;
+            latestValueHits       = other.latestValueHits;
+            latestValueMisses     = other.latestValueMisses;
+            latestValueContended  = other.latestValueContended;
+            compressedSampleBytes = other.compressedSampleBytes;
+            arenaReservedBytes    = other.arenaReservedBytes;
+            arenaLiveBytes        = other.arenaLiveBytes;
 
             updateCycleFinished.store(other.updateCycleFinished);
+            updatesCoalesced.store(other.updatesCoalesced);
         }
 
         return *this;
@@ -310,6 +444,28 @@ struct dcgmcm_runtime_stats_t
 
 using dcgmcm_runtime_stats_p = dcgmcm_runtime_stats_t *;
 
+/*****************************************************************************/
+/* Usage of the memory budget of the cached samples. See DcgmCacheManager::EnforceMemoryBudget() */
+struct dcgmcm_memory_budget_stats_t
+{
+    long long budgetBytes    = 0; /* Budget for the samples cached by all watches. 0 = unlimited */
+    long long cachedBytes    = 0; /* Bytes of cached samples as of the last check of the budget */
+    long long evictions      = 0; /* Number of times the samples of a watch were evicted to stay within the budget */
+    long long evictedSamples = 0; /* Samples evicted to stay within the budget */
+    long long evictedBytes   = 0; /* Bytes freed by those evictions */
+};
+
+/*****************************************************************************/
+/* Memory info of one GPU instance. Read at most once per update cycle and shared by
+   the GPU instance and its compute instances, which all report the memory of the GPU instance */
+typedef struct
+{
+    nvmlReturn_t fbStatus;       /* Return of the FB memory query */
+    nvmlMemory_v2_t fbMemory;    /* FB memory. reserved is 0 for drivers older than r510 */
+    nvmlReturn_t bar1Status;     /* Return of the BAR1 memory query */
+    nvmlBAR1Memory_t bar1Memory;  /* BAR1 memory */
+} dcgmcm_mig_memory_t;
+
 /*****************************************************************************/
 /* Cache manager update thread context structure. This exists to prevent stack
    overflow in the update thread by storing large objects on the heap */
@@ -329,11 +485,27 @@ typedef struct dcgmcm_update_thread_t
                                          Finally, we're not tracking clientId yet. If we ever extend this
                                          functionality to clients, we will have to track client ID as well. */
 
-    int numFieldValues[DCGM_MAX_NUM_DEVICES];                              /* Number of field values per device
-                                                                              saved in fieldValueFields and fieldValueWatchInfo*/
-    dcgm_field_meta_p fieldValueFields[DCGM_MAX_NUM_DEVICES][NVML_FI_MAX]; /* Fields to update with field-value APIs
-                                                                              rather than CacheLatest*Value() */
-    dcgmcm_watch_info_p fieldValueWatchInfo[DCGM_MAX_NUM_DEVICES][NVML_FI_MAX]; /* Watch info for field values */
+    std::vector<dcgmcm_field_value_plan_entry_t> fieldValues[DCGM_MAX_NUM_DEVICES]; /* Per gpuId, fields to update
+                                                                                      with field-value APIs rather
+                                                                                      than CacheLatest*Value(). Only
+                                                                                      cleared between cycles, so they
+                                                                                      keep their capacity */
+    std::vector<unsigned int> fieldValueGpuIds; /* gpuIds with entries in fieldValues, in the order their first
+                                                   entry was queued. Clearing only touches these */
+    std::vector<nvmlFieldValue_t> nvmlFieldValues; /* Scratch for ActuallyUpdateGpuFieldValues(). Reused across
+                                                      cycles */
+    std::vector<dcgmcm_watch_info_p> walkWatches;  /* Watches WalkAndUpdateWatches() is updating. Copied out of
+                                                      the watch table because inserts while the mutex is dropped
+                                                      for a driver call invalidate its iterators */
+    DcgmNs::Timelib::CycleClock clock; /* Timestamps of the current update cycle. Started by
+                                          ActuallyUpdateAllFields() and stopped by ClearThreadCtx() */
+
+    unsigned char migFbMemoryRead[DCGM_MAX_NUM_DEVICES];   /* Bitmask per GPU of the instance indexes whose
+                                                              migMemory FB values were read this cycle */
+    unsigned char migBar1MemoryRead[DCGM_MAX_NUM_DEVICES]; /* Same for the BAR1 values of migMemory */
+    dcgmcm_mig_memory_t migMemory[DCGM_MAX_NUM_DEVICES][DCGM_MAX_INSTANCES_PER_GPU]; /* Memory info of each GPU
+                                                                                        instance, by the index in
+                                                                                        dcgmcm_gpu_info_t::instances */
 } dcgmcm_update_thread_t, *dcgmcm_update_thread_p;
 
 /*****************************************************************************/
@@ -377,7 +549,49 @@ typedef enum
     DcgmcmEventTypeSize // Always last entry
 } DcgmcmEventType_t;
 
-typedef void (*dcgmOnMigReconfigure_f)(unsigned int gpuId, void *userData);
+/* MIG entities of one GPU that appeared or went away in a MIG reconfiguration. An ID that now belongs to a
+   different NVML instance is both removed and added */
+struct DcgmMigHierarchyDelta
+{
+    std::vector<DcgmNs::Mig::GpuInstanceId> addedGpuInstances;
+    std::vector<DcgmNs::Mig::GpuInstanceId> removedGpuInstances;
+    std::vector<DcgmNs::Mig::ComputeInstanceId> addedComputeInstances;
+    std::vector<DcgmNs::Mig::ComputeInstanceId> removedComputeInstances;
+
+    bool IsEmpty() const
+    {
+        return addedGpuInstances.empty() && removedGpuInstances.empty() && addedComputeInstances.empty()
+               && removedComputeInstances.empty();
+    }
+};
+
+/* DCGM IDs of the MIG entities of one GPU, by their NVML IDs */
+struct DcgmMigIdSnapshot
+{
+    std::map<unsigned int, DcgmNs::Mig::GpuInstanceId> gpuInstances; /* NVML GPU instance ID -> DCGM ID */
+    std::map<std::pair<unsigned int, unsigned int>, DcgmNs::Mig::ComputeInstanceId>
+        computeInstances; /* (NVML GPU instance ID, NVML compute instance ID) -> DCGM ID */
+};
+
+/* NvLink link states of every GPU and NvSwitch as dcgmGetNvLinkLinkStatus() returns them. A new one is published
+   whenever a link state changes, so that reads don't have to ask the driver or the NvSwitch module */
+struct DcgmNvLinkStatusSnapshot
+{
+    unsigned long long version = 0; /* Incremented by every published change */
+    dcgmNvLinkStatus_v4 status {};
+    std::optional<dcgmReturn_t> nvSwitchRet; /* Status of getting the NvSwitch link states. nullopt until the
+                                                NvSwitch module has reported them once */
+};
+
+/* Every GPU the cache manager knows of, as GetAllGpuInfo() returns them. A new one is published whenever GPUs are
+   attached, detached, added or change status, so that readers share it instead of copying the GPU table */
+struct DcgmGpuInventorySnapshot
+{
+    unsigned long long version = 0; /* Incremented by every published change */
+    std::vector<dcgmcm_gpu_info_cached_t> gpus;
+};
+
+typedef void (*dcgmOnMigReconfigure_f)(unsigned int gpuId, DcgmMigHierarchyDelta const &delta, void *userData);
 
 typedef struct
 {
@@ -413,6 +627,90 @@ public:
      *
      */
     void run(void) override;
+
+    /*************************************************************************/
+    /*
+     * Inherited virtual method from DcgmThread. Wakes the thread up if it's
+     * waiting for kmsg XIDs
+     */
+    void OnStop(void) override;
+};
+
+/*****************************************************************************/
+/* This class waits for the NVML events of a single GPU. Threads are only created
+   when per-GPU event threads are enabled. Each one blocks in nvmlEventSetWait on
+   its GPU's own event set so that an event is handled as soon as it is raised
+   rather than on the next poll of the shared event thread */
+class DcgmCacheManagerGpuEventThread : public DcgmThread
+{
+private:
+    friend class DcgmCacheManager;
+
+    DcgmCacheManager *m_cacheManager; /* Pointer to the cache manager instance
+                                         we belong to */
+    unsigned int m_gpuId;             /* GPU whose events this thread waits for */
+
+public:
+    DcgmCacheManagerGpuEventThread(DcgmCacheManager *cacheManager, unsigned int gpuId);
+    ~DcgmCacheManagerGpuEventThread() override = default;
+
+    /*************************************************************************/
+    /*
+     * Inherited virtual method from DcgmThread. Waits for and handles the
+     * events of our GPU
+     */
+    void run(void) override;
+};
+
+/*****************************************************************************/
+/* Update shard selectors for DcgmCacheManager::ActuallyUpdateAllFields(). Any other
+   value is the gpuId of the per-GPU update worker whose watches should be updated */
+#define DCGM_CM_UPDATE_SHARD_ALL     0xFFFFFFFF /* Update every watch regardless of owner */
+#define DCGM_CM_UPDATE_SHARD_NON_GPU 0xFFFFFFFE /* Only update watches that aren't owned by an update worker */
+
+/*****************************************************************************/
+/* This class updates the watches of a single GPU and its MIG children. Workers
+   are only created when per-GPU update workers are enabled. Each worker has its own
+   update thread context so the NVML calls of different GPUs can run in parallel */
+class DcgmCacheManagerUpdateWorker : public DcgmThread
+{
+private:
+    friend class DcgmCacheManager;
+
+    DcgmCacheManager *m_cacheManager;    /* Pointer to the cache manager instance
+                                            we belong to */
+    unsigned int m_gpuId;                /* GPU whose watches this worker updates */
+    dcgmcm_update_thread_t *m_threadCtx; /* Update context used by this worker. Is heap allocated
+                                            for the same reason as DcgmCacheManager::m_updateThreadCtx */
+    unsigned long long m_lastCycle;      /* Last update cycle this worker started. Protected by
+                                            DcgmCacheManager::m_updateWorkerMutex */
+    timelib64_t m_earliestNextUpdate;    /* Earliest next update this worker reported for its last cycle.
+                                            Protected by DcgmCacheManager::m_updateWorkerMutex */
+    unsigned long long m_assignedCycle;  /* Last update cycle this worker was given. Workers that are still busy
+                                            with an earlier cycle aren't given new ones. Protected by
+                                            DcgmCacheManager::m_updateWorkerMutex */
+    bool m_busy;                         /* Is this worker in the middle of a cycle? Protected by
+                                            DcgmCacheManager::m_updateWorkerMutex */
+    timelib64_t m_cycleStartUsec;        /* When this worker started its current cycle. Protected by
+                                            DcgmCacheManager::m_updateWorkerMutex */
+
+public:
+    DcgmCacheManagerUpdateWorker(DcgmCacheManager *cacheManager, unsigned int gpuId);
+    ~DcgmCacheManagerUpdateWorker() override;
+
+    /*************************************************************************/
+    /*
+     * Inherited virtual method from DcgmThread. Waits for update cycles to be
+     * started by the cache manager and runs them for our GPU
+     */
+    void run(void) override;
+
+    /*************************************************************************/
+    /*
+     * Inherited virtual method from DcgmThread. Wakes up our thread if it's
+     * waiting for an update cycle so it can exit
+     */
+    void OnStop(void) override;
 };
 
 /*****************************************************************************/
@@ -483,13 +781,23 @@ public:
 
     /*************************************************************************/
     /*
-     * Get info about all of the GPUs the cache manager knows about
+     * Get info about all of the GPUs the cache manager knows about. This is a
+     * copy of GetGpuInventory()->gpus
      *
      * Returns DCGM_ST_OK on success
      *         Other DCGM_ST_? #define on error
      */
     dcgmReturn_t GetAllGpuInfo(std::vector<dcgmcm_gpu_info_cached_t> &gpuInfo);
 
+    /*************************************************************************/
+    /*
+     * Return the latest DcgmGpuInventorySnapshot. It is immutable and can be
+     * kept for as long as the caller likes without holding any lock.
+     *
+     * Never returns nullptr
+     */
+    std::shared_ptr<DcgmGpuInventorySnapshot const> GetGpuInventory();
+
     /*************************************************************************/
     /*
      * Are any GPUs in HOST VGPU mode?
@@ -573,9 +881,32 @@ public:
      *
      * Returns a GPU status enum
      *
+     * GPUs and their instances are read from m_entityStatuses without taking the cache manager lock
+     *
      */
     DcgmEntityStatus_t GetEntityStatus(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId);
 
+    /*************************************************************************/
+    /*
+     * Get the status of an entity of any group from the status table, without a lock.
+     *
+     * Returns nullopt if the owner of entityGroupId hasn't published it yet. The caller has to ask the owner then
+     *
+     */
+    std::optional<DcgmEntityStatus_t> GetPublishedEntityStatus(dcgm_field_entity_group_t entityGroupId,
+                                                               dcgm_field_eid_t entityId) const;
+
+    /*************************************************************************/
+    /*
+     * Replace the statuses of every switch, CPU or CPU core. Called by the modules that own them
+     * whenever the statuses change
+     *
+     * Returns DCGM_ST_BADPARAM for the entity groups of the cache manager itself
+     *
+     */
+    dcgmReturn_t SetEntityStatuses(dcgm_field_entity_group_t entityGroupId,
+                                   std::span<DcgmEntityStatusTable::Entry const> entries);
+
     /*************************************************************************/
     /*
      * Get the status of a GPU
@@ -587,6 +918,16 @@ public:
      */
     DcgmEntityStatus_t GetGpuStatus(unsigned int gpuId);
 
+    /*************************************************************************/
+    /*
+     * Set the status of a GPU as if the driver had reported it. Lets unit tests have the update loop
+     * read fake GPUs like real ones (public for unit tests)
+     *
+     * Returns DCGM_ST_BADPARAM if gpuId doesn't exist
+     *
+     */
+    dcgmReturn_t SetGpuStatus(unsigned int gpuId, DcgmEntityStatus_t status);
+
     /*************************************************************************/
     /*
      * Get the brand of a given GPU
@@ -657,12 +998,54 @@ public:
      * waitForUpdate IN: Whether (1) or not (0) the caller should wait for the
      *                   triggered update cycle to finish before returning.
      *
+     * Calls made while an update cycle is queued but hasn't started yet join that
+     * cycle rather than queueing another one, since it will see all of their watches.
+     *
      * Returns 0 on success
      *         DCGM_ST_? #define on error.
      *
      */
     dcgmReturn_t UpdateAllFields(int waitForUpdate);
 
+    /*************************************************************************/
+    /*
+     * Update the watches of fieldIds on entities now, whether or not they are due,
+     * without updating any other watch. Fields that aren't watched are skipped.
+     *
+     * entities      IN: Entities to update. Global fields are updated once no matter
+     *                   which entities are passed
+     * fieldIds      IN: Fields to update on each of entities
+     * waitForUpdate IN: Whether (1) or not (0) the caller should wait for the
+     *                   update to finish before returning.
+     *
+     * Returns 0 on success
+     *         DCGM_ST_? #define on error.
+     *
+     */
+    dcgmReturn_t UpdateFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                              std::vector<unsigned short> const &fieldIds,
+                              int waitForUpdate);
+
+    /*************************************************************************/
+    /*
+     * Like UpdateFields(), but samples the watches as one snapshot: the
+     * watches of each GPU are updated by a thread of their own at the same
+     * time, and every sample is stamped with the same timestamp. Returns once
+     * the snapshot is cached.
+     *
+     * entities      IN: Entities to sample
+     * fieldIds      IN: Fields to sample on each of entities
+     * snapshotId   OUT: Timestamp of the samples of the snapshot. Increases with
+     *                   every snapshot
+     *
+     * Returns 0 on success
+     *         DCGM_ST_? #define on error.
+     *
+     */
+    dcgmReturn_t SnapshotFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                std::vector<unsigned short> const &fieldIds,
+                                timelib64_t &snapshotId);
+
 
     /*************************************************************************/
     /*
@@ -755,6 +1138,51 @@ public:
                                   int clearCache,
                                   DcgmWatcher watcher);
 
+    /*************************************************************************/
+    /*
+     * Add a watch for every field in fieldIds on every entity in entities.
+     *
+     * This is the same as calling AddFieldWatch() for each pair with
+     * updateOnFirstWatch=false, but the watches are added in a single pass
+     * under the cache manager lock, pre-watch driver calls are only made for
+     * the fields that need them, and the NVML event set is rebuilt once at
+     * the end rather than once per watch.
+     *
+     * Parameters are the same as AddFieldWatch() except:
+     * anyFirstWatcher   OUT: Whether we were the first watcher of any of the watches.
+     *                        If so, you will need to call UpdateAllFields(true) for
+     *                        values to be present in the cache.
+     *
+     * Returns 0 on success
+     *        <0 on error. See DCGM_ST_? #defines. Watches added before the error are
+     *           left in place for the caller to remove
+     *
+     */
+    dcgmReturn_t AddFieldWatches(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                 std::vector<unsigned short> const &fieldIds,
+                                 timelib64_t monitorIntervalUsec,
+                                 double maxSampleAge,
+                                 int maxKeepSamples,
+                                 DcgmWatcher watcher,
+                                 bool subscribeForUpdates,
+                                 bool &anyFirstWatcher);
+
+    /*************************************************************************/
+    /*
+     * Remove watcher's watch of every field in fieldIds on every entity in
+     * entities, in a single pass under the cache manager lock. See
+     * RemoveFieldWatch() for the parameters.
+     *
+     * Returns 0 on success
+     *        <0 on error. See DCGM_ST_? #defines. The remaining watches are still
+     *           removed after an error
+     *
+     */
+    dcgmReturn_t RemoveFieldWatches(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                    std::vector<unsigned short> const &fieldIds,
+                                    int clearCache,
+                                    DcgmWatcher watcher);
+
     /*************************************************************************/
     /*
      * Get the latest instance of a PID's accounting data from the cache manager
@@ -900,6 +1328,30 @@ public:
                                     pfUseEntryForSummary enumCB,
                                     void *userData);
 
+    /*************************************************************************/
+    /*
+     * Get a quantile sketch of the non-blank samples of an int64 or double field.
+     * Comes from the watch's rollups where they cover the range, so this doesn't
+     * need to visit every sample of a long range.
+     *
+     * entityGroupId IN: Which entity group to get the sketch for
+     * entityId      IN: The entity to get the sketch for
+     * dcgmFieldId   IN: Which DCGM field to get the sketch for
+     * startTime     IN: Optional starting timestamp. 0=From the first sample
+     * endTime       IN: Optional ending timestamp. 0=Up until the last sample
+     * sketch       OUT: Sketch of the samples in [startTime, endTime]
+     *
+     * Returns: DCGM_ST_OK on success
+     *          DCGM_ST_NO_DATA or DCGM_ST_NOT_WATCHED if there are no samples in the range
+     *          DCGM_ST_? #define on other errors
+     */
+    dcgmReturn_t GetSummarySketch(dcgm_field_entity_group_t entityGroupId,
+                                  dcgm_field_eid_t entityId,
+                                  unsigned short dcgmFieldId,
+                                  timelib64_t startTime,
+                                  timelib64_t endTime,
+                                  DcgmQuantileSketch &sketch);
+
     /*************************************************************************/
     /*
      * Get samples of a time series field
@@ -940,6 +1392,38 @@ public:
                             dcgmOrder_t order,
                             DcgmFvBuffer *fvBuffer);
 
+    /*************************************************************************/
+    /*
+     * Resample the cached samples of a numeric field to numRows times that are
+     * stepUsec apart, starting at startTime. The samples are walked once, from
+     * the latest one at or before startTime on. Cells that fill leaves without
+     * a value are DCGM_FP64_BLANK, as are blank samples.
+     *
+     * entityGroupId IN: Which entity group to resample the field of
+     * entityId      IN: The entity to resample the field of
+     * dcgmFieldId   IN: Which DCGM field to resample
+     * startTime     IN: Time of the first row in usec since 1970
+     * stepUsec      IN: Time between rows in usec
+     * numRows       IN: Number of rows
+     * fill          IN: How rows without a sample at their time are filled
+     * values       OUT: Where to write the row values. Row i goes to
+     *                   values[i * stride]
+     * stride        IN: Distance between the values of consecutive rows
+     *
+     * Returns 0 on success
+     *         DCGM_ST_NOT_WATCHED if the field has no samples. values are blank
+     *        <0 on error. See DCGM_ST_? #defines
+     */
+    dcgmReturn_t ResampleField(dcgm_field_entity_group_t entityGroupId,
+                               dcgm_field_eid_t entityId,
+                               unsigned short dcgmFieldId,
+                               timelib64_t startTime,
+                               timelib64_t stepUsec,
+                               unsigned int numRows,
+                               dcgmResampleFill_t fill,
+                               double *values,
+                               size_t stride);
+
 
     /*************************************************************************/
     /*
@@ -960,6 +1444,55 @@ public:
                                  dcgmcm_sample_p sample,
                                  DcgmFvBuffer *fvBuffer);
 
+    /*************************************************************************/
+    /*
+     * Open a read-only view over the latest values of the given entities and fields for an
+     * embedded client. Each entity/field pair gets a slot in the view that the client can read
+     * with DcgmLatestValueSlots::Read() without going through the cache manager or its lock.
+     * Pairs that are watched later are published into their slot once they get samples.
+     *
+     * entities     IN: Entities to open the view on
+     * entityCount  IN: Number of entries in entities[]
+     * fields       IN: Field IDs to open the view on
+     * fieldCount   IN: Number of entries in fields[]
+     * view        OUT: Handle to the view. This stays valid until the cache manager is destroyed
+     * slots       OUT: entityCount * fieldCount slot indexes, entity-major. DCGM_LATEST_VALUE_VIEW_NO_SLOT
+     *                  for non-numeric fields or if the view is full
+     *
+     * Returns DCGM_ST_OK on success
+     *         Other DCGM_ST_? on error
+     */
+    dcgmReturn_t OpenLatestValueView(dcgmGroupEntityPair_t const entities[],
+                                     unsigned int entityCount,
+                                     unsigned short const fields[],
+                                     unsigned int fieldCount,
+                                     dcgmLatestValueView_t &view,
+                                     unsigned int slots[]);
+
+    /*************************************************************************/
+    /*
+     * Start copying the latest numeric sample of every watch of fieldIds, on any entity, into the shared memory
+     * segment name as it is cached. Local processes read it with dcgmSharedLatestValuesOpen(). The segment is
+     * removed when the cache manager is destroyed.
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_IN_USE if a segment was already started
+     *         Other DCGM_ST_? on error. See DcgmSharedLatestValues::Create()
+     */
+    dcgmReturn_t StartSharedLatestValues(std::string const &name, std::vector<unsigned short> const &fieldIds);
+
+    /*************************************************************************/
+    /*
+     * Rebuild plan with every currently watched numeric field if the watches
+     * changed since plan was built, reserving a latest value slot for each.
+     * The values can then be read from plan.slotTable without the cache
+     * manager lock until the watches change again.
+     *
+     * Returns true if plan was rebuilt
+     *         false if plan was already up to date
+     */
+    bool UpdateLatestValueExportPlan(dcgmcm_export_plan_t &plan);
+
     /*************************************************************************/
     /*
      * Get the most recent sample of multiple entities for multiple fields into
@@ -1031,6 +1564,21 @@ public:
      */
     dcgmReturn_t AppendSamples(DcgmFvBuffer *fvBuffer);
 
+    /*****************************************************************************/
+    /*
+     * AppendSamples() of a serialized DcgmFvBuffer, such as the one a module
+     * posts through DcgmCoreProxy. The FVs are read in place and each value is
+     * copied once, into its time series.
+     *
+     * buffer     IN: Serialized FVs. This remains owned by the caller after this call.
+     * bufferSize IN: Size of buffer in bytes
+     *
+     * Returns 0 on success
+     *        <0 on error. See DCGM_ST_? #defines
+     *
+     */
+    dcgmReturn_t AppendSamples(const char *buffer, size_t bufferSize);
+
     /*************************************************************************/
     /*
      * Inject fake value(s) for a GPU for a field into the cache manager
@@ -1051,6 +1599,24 @@ public:
                                dcgmcm_sample_p samples,
                                int Nsamples);
 
+    /*************************************************************************/
+    /*
+     * Inject a batch of fake values for any mix of entities and fields into
+     * the cache manager.
+     *
+     * Every value is checked before any is injected, so a bad value leaves the
+     * cache unchanged. The values are then appended while holding the cache
+     * manager lock once, and subscribers get one notification for the batch.
+     *
+     * fvBuffer IN: Values to inject. Their status is ignored. This remains
+     *              owned by the caller after this call.
+     *
+     * Returns 0 on success
+     *        <0 on error. See DCGM_ST_? #defines
+     *
+     */
+    dcgmReturn_t InjectSamples(DcgmFvBuffer *fvBuffer);
+
     /*************************************************************************/
     /*
      * Free an array of DCGM samples, freeing any memory they might have
@@ -1071,9 +1637,37 @@ public:
      * threadCtx           IO: Update thread context
      * earliestNextUpdate OUT: Timestamp in usec since 1970 of the next time
      *                         any stat should be updated (minimum timestamp)
+     * updateShard         IN: Which watches to update. DCGM_CM_UPDATE_SHARD_ALL for every watch,
+     *                         DCGM_CM_UPDATE_SHARD_NON_GPU for watches that aren't owned by a per-GPU
+     *                         update worker, or a gpuId to only update that GPU's worker's watches.
+     *
+     */
+    dcgmReturn_t ActuallyUpdateAllFields(dcgmcm_update_thread_t *threadCtx,
+                                         timelib64_t *earliestNextUpdate,
+                                         unsigned int updateShard = DCGM_CM_UPDATE_SHARD_ALL);
+
+    /*************************************************************************/
+    /*
+     * Like ActuallyUpdateAllFields(), but only updates watches and updates them
+     * whether or not they are due. Must be called with m_mutex held
      *
+     * threadCtx           IO: Update thread context
+     * watches             IN: Watches to update
+     * fixedTimestamp      IN: If not 0, the timestamp of every sample of this update
+     *                         rather than the time it is taken. See SnapshotFields()
+     *
+     */
+    void ActuallyUpdateWatches(dcgmcm_update_thread_t *threadCtx,
+                               std::vector<dcgmcm_watch_info_p> const &watches,
+                               timelib64_t fixedTimestamp = 0);
+
+    /*************************************************************************/
+    /*
+     * Read the field values that the update cycle of threadCtx queued for
+     * nvmlDeviceGetFieldValues(), one call per GPU. Drops m_mutex around the
+     * driver calls if it is held
      */
-    dcgmReturn_t ActuallyUpdateAllFields(dcgmcm_update_thread_t *threadCtx, timelib64_t *earliestNextUpdate);
+    void UpdateQueuedGpuFieldValues(dcgmcm_update_thread_t *threadCtx);
 
     /*************************************************************************/
     /*
@@ -1089,10 +1683,32 @@ public:
     /*************************************************************************/
     /*
      * Populate a dcgmNvLinkStatus_v4 response with the NvLink link states
-     * of every GPU and NvSwitch in the system
+     * of every GPU and NvSwitch in the system. This copies the latest
+     * DcgmNvLinkStatusSnapshot and doesn't call the driver. The NvSwitch part
+     * is empty until SetNvSwitchLinkStatus() is first called
      */
     dcgmReturn_t PopulateNvLinkLinkStatus(dcgmNvLinkStatus_v4 &nvLinkStatus);
 
+    /*************************************************************************/
+    /*
+     * Store the NvLink link states of every NvSwitch for PopulateNvLinkLinkStatus().
+     * Publishes a new snapshot only if they changed
+     *
+     * nvSwitchRet    IN: Status of getting the link states from the NvSwitch module
+     * numNvSwitches  IN: Number of entries in nvSwitches
+     * nvSwitches     IN: Link states of each NvSwitch. Can be nullptr if numNvSwitches is 0
+     */
+    dcgmReturn_t SetNvSwitchLinkStatus(dcgmReturn_t nvSwitchRet,
+                                       unsigned int numNvSwitches,
+                                       dcgmNvLinkNvSwitchLinkStatus_t const *nvSwitches);
+
+    /*************************************************************************/
+    /*
+     * Get the status stored by the last SetNvSwitchLinkStatus(). nullopt if it
+     * was never called
+     */
+    std::optional<dcgmReturn_t> GetNvSwitchLinkStatusRet() const;
+
     /*************************************************************************/
     /*
      * Populate a dcgmMigHierarchy_v2 response with pairings of GPUs, GPU Instances,
@@ -1249,6 +1865,66 @@ public:
      */
     void GetRuntimeStats(dcgmcm_runtime_stats_p stats);
 
+    /*************************************************************************/
+    /*
+     * Set the budget for the samples cached by all watches. 0 = unlimited,
+     * which is the default. Set by __DCGM_CACHE_MEMORY_BUDGET_MB__, which
+     * nv-hostengine sets from --cache-memory-budget
+     *
+     * budgetBytes  IN: Budget in bytes
+     */
+    void SetMemoryBudget(long long budgetBytes);
+
+    /*************************************************************************/
+    /*
+     * Evict samples until the samples cached by all watches fit in the memory
+     * budget. The watches of clients are evicted before the watches of internal
+     * modules, each in the order they were last read. Eviction leaves the latest
+     * sample of a watch so that latest-value reads keep working.
+     * Called by the update thread every c_memoryBudgetCheckIntervalUsec.
+     * Does nothing if there is no budget
+     */
+    void EnforceMemoryBudget();
+
+    /*************************************************************************/
+    /*
+     * Get the usage and evictions of the memory budget
+     *
+     * stats   OUT: Stats as of the last EnforceMemoryBudget()
+     *
+     * Note: Doesn't take the cache manager mutex
+     */
+    void GetMemoryBudgetStats(dcgmcm_memory_budget_stats_t &stats);
+
+    /*************************************************************************/
+    /*
+     * Get the number of bytes of encoded samples held by the compressed
+     * timeseries of all watches. This is 0 unless __DCGM_COMPRESSED_TIMESERIES__=1
+     */
+    long long GetCompressedSampleBytes();
+
+    /*************************************************************************/
+    /*
+     * Get the fetch count, exec time and cached bytes of every watched field of
+     * every entity, most expensive first. Only the DCGM_INTROSPECT_MAX_FIELD_COSTS
+     * most expensive watches are returned.
+     *
+     * fieldCosts OUT: The costs. fieldCosts.version is set by this call
+     *
+     * Returns DCGM_ST_OK on success
+     */
+    dcgmReturn_t GetFieldCosts(dcgmIntrospectFieldCosts_v1 &fieldCosts);
+
+    /*************************************************************************/
+    /*
+     * Get the arena usage of the string and blob timeseries of all watches.
+     * Both are 0 unless __DCGM_SAMPLE_ARENA__=1
+     *
+     * reservedBytes OUT: Bytes the arenas hold from the heap
+     * liveBytes     OUT: Bytes of the arenas holding samples that are still cached
+     */
+    void GetSampleArenaBytes(long long &reservedBytes, long long &liveBytes);
+
     /*************************************************************************/
     /*
      * Add field watches for the given vGPU instance
@@ -1266,9 +1942,8 @@ public:
     /*************************************************************************/
     /*
      * Manage the dynamic addition/removal of the vGPUs.
-     * Active vGPU instance (linked) list is maintained per GPU within the function depending on addition of
-     * new vGPU instance or removal of any running vGPU instance.
-     * Also vgpuIndex is mapped to the vGPU instances running within range specified for the nvmlIndex.
+     * The active vGPU instances of the GPU and m_vgpuInstanceGpuIds are diffed in place against
+     * vgpuInstanceIds, watching the fields of new instances and unwatching those of removed ones.
      * First element of vgpuInstanceIds array passed as input must hold the count of vGPU instances running.
      *
      * Note that index 0 of vgpuInstanceIds is ignored
@@ -1305,22 +1980,68 @@ public:
 
     /*************************************************************************/
     /*
-     * Return a topology struct populated with the information on the NVLink for
-     * this system.
+     * Return the CPU affinity and NvLink topology of this node. They are read from NVML the first time after
+     * InvalidateTopologySnapshot() and shared by every caller until the next one.
      *
-     * Returns a pointer to the populated topology object
-     *         NULL on error
+     * Never returns nullptr
      */
-    dcgmTopology_t *GetNvLinkTopologyInformation();
+    std::shared_ptr<DcgmTopologySnapshot const> GetTopologySnapshot();
 
     /*************************************************************************/
     /*
-     * Cache the topology information relevant to NvLink for this host.
-     *
-     * Returns 0 if ok
-     *         DCGM_ST_* on module error
+     * Make the next GetTopologySnapshot() read the topology again. Called whenever GPUs are attached, detached,
+     * lost, paused or resumed, their NvLink states change or a GPU is MIG-reconfigured.
      */
-    dcgmReturn_t CacheTopologyNvLink(dcgmcm_update_thread_t *threadCtx, timelib64_t now, timelib64_t expireTime);
+    void InvalidateTopologySnapshot();
+
+    /*************************************************************************/
+    /*
+     * Publish a new DcgmNvLinkStatusSnapshot if the NvLink link states or the
+     * statuses of the GPUs changed since the last one. Called by
+     * InvalidateTopologySnapshot(), which every such change goes through
+     */
+    void PublishGpuNvLinkStatus();
+
+    /*************************************************************************/
+    /*
+     * Publish a new DcgmGpuInventorySnapshot if the GPUs changed since the last
+     * one. Called by InvalidateTopologySnapshot()
+     */
+    void PublishGpuInventory();
+
+    /*************************************************************************/
+    /*
+     * Publish the statuses of the GPUs and the GPUs of their instances to
+     * m_entityStatuses. Called by InvalidateTopologySnapshot() and whenever
+     * fake instances are added. The caller holds m_mutex
+     */
+    void PublishEntityStatuses();
+
+    /*************************************************************************/
+    /*
+     * Read the NvLink link states of every GPU from the driver. Called by the
+     * update thread every c_nvLinkStateRefreshIntervalUsec
+     */
+    void RefreshNvLinkLinkStates();
+
+    /*************************************************************************/
+    /*
+     * Return a topology struct populated with the information on the NVLink for
+     * this system.
+     *
+     * Returns a pointer to the populated topology object
+     *         NULL on error
+     */
+    dcgmTopology_t *GetNvLinkTopologyInformation();
+
+    /*************************************************************************/
+    /*
+     * Cache the topology information relevant to NvLink for this host.
+     *
+     * Returns 0 if ok
+     *         DCGM_ST_* on module error
+     */
+    dcgmReturn_t CacheTopologyNvLink(dcgmcm_update_thread_t *threadCtx, timelib64_t now, timelib64_t expireTime);
 
     /*************************************************************************/
     /*
@@ -1346,6 +2067,13 @@ public:
                                             unsigned int fieldId,
                                             dcgmcm_watch_info_p watchInfo);
 
+    /*************************************************************************/
+    /*
+     * Get the keys of the watches in the field value plan of gpuId, rebuilding the plan first if the
+     * watch set changed since it was built. (public for unit tests)
+     */
+    std::vector<dcgm_entity_key_t> GetFieldValuePlanKeys(unsigned int gpuId);
+
     /*************************************************************************/
     /*
      * Handle a client disconnecting from the host engine
@@ -1361,6 +2089,33 @@ public:
      */
     void EventThreadMain(DcgmCacheManagerEventThread *eventThread);
 
+    /*************************************************************************/
+    /*
+     * Method that will be called by a DcgmCacheManagerGpuEventThread. Blocks
+     * until the next NVML event of the thread's GPU and handles it.
+     */
+    void GpuEventThreadMain(DcgmCacheManagerGpuEventThread *gpuEventThread);
+
+    /*************************************************************************/
+    /*
+     * Method that will be called by a DcgmCacheManagerUpdateWorker. Waits for the
+     * next update cycle to start and then updates the worker's GPU.
+     */
+    void UpdateWorkerMain(DcgmCacheManagerUpdateWorker *updateWorker);
+
+    /*************************************************************************/
+    /*
+     * Wake up any per-GPU update workers that are waiting for an update cycle
+     */
+    void WakeUpdateWorkers(void);
+
+    /*************************************************************************/
+    /*
+     * Wake up the event thread if it's waiting for kmsg XIDs. Called when the
+     * event thread is stopped
+     */
+    void WakeEventThread(void);
+
     /*************************************************************************/
     /*
      * Find all GPUs in the system and set their state appropriately in this
@@ -1376,10 +2131,64 @@ public:
      * Find all GPU instances and compute instacnes in the system and set their state appropriately in this
      * object.
      *
+     * If previousIds is given, instances found in it keep their DCGM IDs and new instances get IDs that are
+     * not in it.
+     *
      * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_INSUFFICIENT_RESOURCES if previousIds leaves too few free IDs for the new instances
      *          DCGM_ST_GENERIC_ERROR on NVML error
      */
-    dcgmReturn_t InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo);
+    dcgmReturn_t InitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo, DcgmMigIdSnapshot const *previousIds = nullptr);
+
+    /*************************************************************************/
+    /*
+     * The part of InitializeGpuInstances() that only reads NVML and fills in gpuInfo. It doesn't touch
+     * anything shared, so it may run for several GPUs at once. RecordGpuInstances() has to follow it.
+     */
+    dcgmReturn_t ReadGpuInstances(dcgmcm_gpu_info_t &gpuInfo, DcgmMigIdSnapshot const *previousIds = nullptr);
+
+    /*************************************************************************/
+    /*
+     * Add the instances that ReadGpuInstances() put in gpuInfo to m_migManager and the instance counts.
+     * The caller must hold m_mutex
+     */
+    void RecordGpuInstances(dcgmcm_gpu_info_t const &gpuInfo);
+
+    /*************************************************************************/
+    /*
+     * Read everything AttachGpus() needs to know about one GPU: its handle, identity, arch, NvLink count
+     * and MIG hierarchy. gpuId, nvmlIndex, status and ccMode must be set already. Only gpuInfo is written,
+     * so GPUs are probed concurrently. The MIG instances still have to be given to RecordGpuInstances()
+     */
+    dcgmReturn_t ProbeGpu(dcgmcm_gpu_info_t &gpuInfo);
+
+    /*************************************************************************/
+    /*
+     * Re-read the MIG hierarchy of one GPU after it was reconfigured. Instances that are still there keep their
+     * DCGM IDs, and with them their watches and cached values. The other GPUs aren't touched.
+     * The caller must hold m_mutex. What changed is returned by TakeMigDelta()
+     *
+     * @param gpuInfo - the GPU that was reconfigured
+     */
+    dcgmReturn_t ReinitializeGpuInstances(dcgmcm_gpu_info_t &gpuInfo);
+
+    /*************************************************************************/
+    /*
+     * Return the MIG entities of gpuId that were added or removed since the last call
+     */
+    DcgmMigHierarchyDelta TakeMigDelta(unsigned int gpuId);
+
+    /*************************************************************************/
+    /*
+     * Return the DCGM IDs of the MIG entities of a GPU by their NVML IDs
+     */
+    static DcgmMigIdSnapshot SnapshotMigIds(dcgmcm_gpu_info_t const &gpuInfo);
+
+    /*************************************************************************/
+    /*
+     * Return the entities that are in after but not in before and vice versa
+     */
+    static DcgmMigHierarchyDelta DiffMigIds(DcgmMigIdSnapshot const &before, DcgmMigIdSnapshot const &after);
 
     /*************************************************************************/
     /**
@@ -1439,11 +2248,24 @@ public:
     bool IsMigEnabledAnywhere();
 
     /**
-     * Notifies subscribers (if any) that MIG has been reconfigured
+     * Notifies subscribers (if any) that MIG has been reconfigured on gpuId
      * (public for unit tests)
      */
     /*************************************************************************/
-    void NotifyMigUpdateSubscribers(unsigned int gpuId);
+    void NotifyMigUpdateSubscribers(unsigned int gpuId, DcgmMigHierarchyDelta const &delta);
+
+    /*************************************************************************/
+    /*
+     * Re-read the MIG hierarchy of gpuId after CreateMigEntity or DeleteMigEntity changed it, unless flags
+     * has DCGM_MIG_RECONFIG_DELAY_PROCESSING
+     */
+    void ApplyMigEntityChange(unsigned int gpuId, unsigned int flags);
+
+    /*************************************************************************/
+    /*
+     * Return the GPU instance of gpuId with the given DCGM ID, or nullptr if there is none
+     */
+    DcgmGpuInstance *FindGpuInstance(unsigned int gpuId, DcgmNs::Mig::GpuInstanceId const &gpuInstanceId);
 
     /**
      * Generates the appropriate value for CUDA_VISIBLE_DEVICES for the specified
@@ -1578,6 +2400,49 @@ public:
                                    long long value2,
                                    timelib64_t timestamp,
                                    timelib64_t oldestKeepTimestamp);
+
+    /*************************************************************************/
+    /*
+     * Return whether samples of fieldType for watchInfo can skip
+     * AppendEntityDouble()/AppendEntityInt64() and be appended to its time
+     * series in bulk by AppendSampleRun(). Only watches whose time series
+     * already holds fieldType and whose samples don't feed anything else
+     * (change-only filtering, rollups, the history tier, per-process indexes
+     * or derived fields) qualify.
+     *
+     * Must be called with m_mutex held
+     */
+    bool CanAppendSampleRun(dcgmcm_watch_info_p watchInfo, unsigned char fieldType);
+
+    /*************************************************************************/
+    /*
+     * Append run, samples sorted by timestamp, to watchInfo's time series at
+     * once. Then enforce its quota and publish its latest value, once for the
+     * run rather than once per sample.
+     *
+     * Must be called with m_mutex held
+     */
+    void AppendSampleRun(dcgmcm_watch_info_p watchInfo,
+                         std::vector<timeseries_entry_t> &run,
+                         timelib64_t oldestKeepTimestamp);
+
+    /*************************************************************************/
+    /*
+     * Return whether a numeric sample of a change-only watch repeats the last
+     * sample cached for the watch and should be dropped. Always false for
+     * watches that aren't change-only or have nothing cached yet.
+     */
+    bool IsRepeatedSample(dcgmcm_watch_info_p watchInfo, long long value1, long long value2);
+    bool IsRepeatedSample(dcgmcm_watch_info_p watchInfo, double value1, double value2);
+
+    /*************************************************************************/
+    /*
+     * Evaluate the derived fields of threadCtx->entityKey's entity that are
+     * triggered by the sample of threadCtx->entityKey.fieldId that was just
+     * appended, and append their results. Watched derived fields only.
+     * See DcgmDerivedFields
+     */
+    void UpdateDerivedFields(dcgmcm_update_thread_t *threadCtx, double value, timelib64_t timestamp);
     dcgmReturn_t AppendEntityBlob(dcgmcm_update_thread_t *threadCtx,
                                   void *value,
                                   int valueSize,
@@ -1659,6 +2524,10 @@ private:
     unsigned int m_numComputeInstances;                         // Number of total compute instances created
     std::array<dcgmcm_gpu_info_t, DCGM_MAX_NUM_DEVICES> m_gpus; /* All of the GPUs we know about, indexed by gpuId */
 
+    /* gpuId of every active vGPU instance. Kept in step with dcgmcm_gpu_info_t::vgpuInstances by ManageVgpuList()
+       so that vGPU lookups don't have to walk the instances of every GPU */
+    std::unordered_map<nvmlVgpuInstance_t, unsigned int> m_vgpuInstanceGpuIds;
+
     bool m_nvmlInitted; /* Tracks whether or not NVML has been initialized. since NVML keeps a count
                            of initializations, we don't want to double initialize or we won't be able
                            to detach and attach to GPUs correctly. */
@@ -1670,14 +2539,17 @@ private:
     unsigned int m_waitForDriverClearCount; // Count of threads waiting for the driver to be clear
 
     /* Track per-entity watches of fields. Use GetEntityWatchInfo() method to get a
-       pointer to an element of this.
-       Is a hash of dcgm_entity_key_t -> entity_watch_table_t */
-    hashtable_t *m_entityWatchHashTable;
+       pointer to an element of this. Owns the watch infos. Protected by m_mutex */
+    DcgmEntityKeyMap<dcgmcm_watch_info_t> m_entityWatchTable;
+
+    /* Watch infos of m_entityWatchTable that each client connection is a watcher of, so that
+       OnConnectionRemove() only visits the watches of the connection that went away. Protected by m_mutex */
+    std::unordered_map<dcgm_connection_id_t, std::unordered_set<dcgmcm_watch_info_p>> m_connectionWatches;
 
     /* Cache of which PIDs we have already saved to the cache with which start times
      * This saves us having to scan the entire accounting data structure to find
-     * which PIDs we have already saved */
-    keyedvector_p m_accountingPidsSeen;
+     * which PIDs we have already saved. Protected by m_mutex */
+    DcgmAccountingPidCache m_accountingPidsSeen;
 
     /* NVML events */
 
@@ -1686,6 +2558,11 @@ private:
     bool m_nvmlEventSetInitialized; /* Is m_nvmlEventSet initialized */
     nvmlEventSet_t m_nvmlEventSet;
 
+    /* Per-GPU event sets, indexed by gpuId. Only used when m_perGpuEventThreads is set, in which case
+       events are registered here instead of on m_nvmlEventSet. Created once and only freed when NVML is */
+    bool m_gpuEventSetInitialized[DCGM_MAX_NUM_DEVICES];
+    nvmlEventSet_t m_gpuEventSets[DCGM_MAX_NUM_DEVICES];
+
     /* Vector of the field IDs that are actually defined. This will never change
      * after start-up, so iterators for this can be used without locking */
     std::vector<unsigned short> m_allValidFieldIds;
@@ -1693,6 +2570,57 @@ private:
     /* Runtime stats of the cache manager */
     dcgmcm_runtime_stats_t m_runStats;
 
+    /* Completion of the update cycle queued by UpdateAllFields() that hasn't started yet. Unset
+       when no cycle is waiting to start. A cycle that starts unsets it before it is done, so it is only
+       ever ready if its task was dropped without running. Protected by m_pendingUpdateLock */
+    std::mutex m_pendingUpdateLock;
+    std::optional<std::shared_future<void>> m_pendingUpdate;
+
+    /* Incremented whenever a watch is added or removed or its update interval changes so that
+       structures derived from the watch table know to rebuild. Protected by m_mutex */
+    unsigned long long m_watchSetGeneration { 1 };
+
+    /* Per-GPU list of the watches that are updated by the batched nvmlDeviceGetFieldValues() call,
+       indexed by gpuId. Only watches whose practical entity is a GPU are planned. This is rebuilt by
+       BuildFieldValuePlan() only when m_watchSetGeneration moves so the update loop doesn't have to classify
+       every watch each cycle. Both are protected by m_mutex */
+    std::vector<dcgmcm_field_value_plan_entry_t> m_fieldValuePlan[DCGM_MAX_NUM_DEVICES];
+    unsigned long long m_fieldValuePlanGeneration { 0 }; /* m_watchSetGeneration m_fieldValuePlan was built at */
+
+    /* GPUs whose driver rejected the scoped NVML_FI_DEV_NVLINK_ERROR_DL_* field values while
+       nvmlDeviceGetNvLinkErrorCounter() worked. Their per-link NvLink error counters go back to one driver
+       call each. Protected by m_mutex */
+    bool m_nvLinkErrorFieldValuesRejected[DCGM_MAX_NUM_DEVICES] {};
+
+    /* Next-due schedules keyed by update shard. See ActuallyUpdateAllFields() for the shards.
+       Protected by m_mutex */
+    std::unordered_map<unsigned int, dcgmcm_watch_schedule_t> m_watchSchedules;
+
+    /* Latest numeric sample of each cached watch. Readers can use this without locking m_mutex */
+    DcgmLatestValueCache m_latestValues;
+
+    /* Static GPU attributes read by GetMultipleLatestLiveSamples(). Invalidated when GPUs are attached or detached,
+       when a GPU's MIG configuration changes and when NVML injection changes a GPU */
+    DcgmStaticFieldCache m_staticFields;
+
+    /* Latest numeric sample of the watches embedded clients opened a view on or that are in m_latestValuePlans.
+       Allocated by the first OpenLatestValueView() or plan and kept until destruction so that views stay valid.
+       Creation is protected by m_mutex */
+    std::unique_ptr<DcgmLatestValueSlots> m_latestValueSlots;
+
+    /* Plans of recent GetMultipleLatestSamples() requests, keyed by a hash of their entities and field IDs.
+       Exporters ask for the same entities and fields every scrape, so each pair's slot in m_latestValueSlots is
+       resolved once and later requests read the slots by index. Slots are never moved or reused, so plans stay
+       valid as watches come and go. Protected by m_latestValuePlansMutex */
+    std::mutex m_latestValuePlansMutex;
+    std::unordered_map<std::size_t, std::shared_ptr<dcgmcm_latest_value_plan_t const>> m_latestValuePlans;
+    static constexpr size_t c_maxLatestValuePlans = 64; /* The plans are all dropped when there are more */
+
+    /* Shared memory copy of the latest numeric sample of every watch of m_sharedLatestValueFieldIds, for local
+       processes that read it without a connection. Set by StartSharedLatestValues(). Protected by m_mutex */
+    std::unique_ptr<DcgmSharedLatestValues> m_sharedLatestValues;
+    std::bitset<DCGM_FI_MAX_FIELDS> m_sharedLatestValueFieldIds;
+
     DcgmCacheManagerEventThread *m_eventThread { nullptr }; /* Thread for reading NVML events */
 
     DcgmKmsgReaderThread *m_kmsgThread { nullptr }; /* Thread for reading additional NVML events in /dev/kmsg */
@@ -1709,9 +2637,31 @@ private:
     DcgmMigManager m_migManager; // Tracks MIG information for quick lookup
                                  // Tracks the timestamp of a user request that we delay mig reconfig processing
     timelib64_t m_delayedMigReconfigProcessingTimestamp;
+    std::map<unsigned int, DcgmMigIdSnapshot> m_unnotifiedMigIds; /* Per gpuId, the MIG IDs subscribers last heard
+                                                                     of, while there is a change they haven't. Protected
+                                                                     by m_mutex */
 
     DcgmMutex *m_nvmlTopoMutex; /* NVML topology APIs aren't thread safe. Make sure only one thread is using them */
 
+    std::atomic<std::shared_ptr<DcgmTopologySnapshot const>> m_topologySnapshot; /* nullptr until the topology is
+                                                                                    read after an invalidation */
+    std::atomic_uint64_t m_topologyGeneration { 0 }; /* Incremented by every InvalidateTopologySnapshot() */
+    std::mutex m_topologyBuildMutex;                 /* Only one thread reads the topology from NVML at a time */
+
+    std::atomic<std::shared_ptr<DcgmNvLinkStatusSnapshot const>> m_nvLinkStatusSnapshot; /* nullptr until the GPUs
+                                                                                            are attached */
+    std::mutex m_nvLinkStatusPublishMutex; /* Only one thread publishes a m_nvLinkStatusSnapshot at a time. Not
+                                              m_mutex, so that the NvSwitch module can publish while core waits on
+                                              it */
+    std::atomic<std::shared_ptr<DcgmGpuInventorySnapshot const>> m_gpuInventorySnapshot; /* nullptr until the GPUs
+                                                                                            are attached */
+    std::mutex m_gpuInventoryPublishMutex; /* Only one thread publishes a m_gpuInventorySnapshot at a time */
+    timelib64_t m_lastNvLinkStateRefreshUsec; /* When RefreshNvLinkLinkStates() last ran. Only used by the update
+                                                 thread */
+
+    /* How often the update thread reads the NvLink link states of the GPUs */
+    static constexpr timelib64_t c_nvLinkStateRefreshIntervalUsec = 5000000;
+
     bool m_forceProfMetricsThroughGpm; /* Should we force profiling metrics through GPM? True=yes. False=no. This
                                           is useful for using the GPM simulator in NVML to test end-to-end with
                                           control values */
@@ -1721,6 +2671,110 @@ private:
     dcgmcm_update_thread_t
         *m_updateThreadCtx; /* Thread context for the update thread (our TaskRunner) under the run() method */
 
+    bool m_perGpuUpdateWorkers; /* Should each GPU and its MIG children be updated by its own
+                                   DcgmCacheManagerUpdateWorker? Set by __DCGM_PER_GPU_UPDATE_WORKERS__=1 */
+
+    bool m_ringBufferTimeSeries; /* Should numeric watches cache their samples in a ring buffer timeseries
+                                    rather than a keyedvector? Set by __DCGM_RING_BUFFER_TIMESERIES__=1 */
+
+    bool m_compressedTimeSeries; /* Should numeric watches cache their samples delta-of-delta and XOR
+                                    encoded? Takes precedence over m_ringBufferTimeSeries.
+                                    Set by __DCGM_COMPRESSED_TIMESERIES__=1 */
+
+    bool m_deadlineScheduler; /* Should the update loop only visit the watches that are due from a per-shard
+                                 min-heap rather than walking the whole watch table every cycle?
+                                 Set by __DCGM_DEADLINE_SCHEDULER__=1 */
+
+    timelib64_t m_updateSlackUsec; /* Watches due within this many usec of now are updated early so that watches
+                                      with nearby deadlines share one wake-up. Set by __DCGM_UPDATE_SLACK_USEC__ */
+
+    bool m_sampleRollups; /* Should numeric watches keep 1s/10s/60s rollups that answer min/max/avg/sum/count
+                             summaries without rescanning every sample? Set by __DCGM_SAMPLE_ROLLUPS__=1 */
+
+    bool m_sampleArena; /* Should string and blob watches allocate their samples from a per-watch arena that
+                           is released a chunk at a time on eviction? Set by __DCGM_SAMPLE_ARENA__=1 */
+
+    std::bitset<DCGM_FI_MAX_FIELDS> m_changeOnlyFieldIds; /* Fields whose watches only cache and publish samples
+                                                             that differ from the last one. Set by a comma-separated
+                                                             list of field IDs in __DCGM_CHANGE_ONLY_FIELDS__ */
+
+    timelib64_t m_nvmlSampleBufferUsec; /* If > 0, GPU power, utilization and clock watches are updated no more often
+                                           than this, each time caching every sample the driver buffered since the
+                                           last update (nvmlDeviceGetSamples) with its own timestamp.
+                                           Set by __DCGM_NVML_SAMPLE_BUFFER_USEC__ */
+
+    std::string m_snapshotPath;         /* File to persist the watch table and recent samples to so that they survive
+                                           a restart. Empty = don't. Set by __DCGM_CACHE_SNAPSHOT_FILE__ */
+    timelib64_t m_snapshotIntervalUsec; /* How often to write m_snapshotPath.
+                                           Set by __DCGM_CACHE_SNAPSHOT_INTERVAL_SEC__ */
+    timelib64_t m_lastSnapshotUsec;     /* When m_snapshotPath was last written. Only used by the update thread */
+
+    dcgmcm_memory_budget_stats_t m_memoryBudgetStats; /* Budget for the samples cached by all watches and its
+                                                         evictions. Protected by m_memoryBudgetStatsLock rather
+                                                         than m_mutex so that scrapes don't wait for the cache */
+    std::mutex m_memoryBudgetStatsLock;
+    timelib64_t m_lastMemoryBudgetCheckUsec; /* When EnforceMemoryBudget() last ran. Only used by the update thread */
+
+    /* How often the update thread checks the memory budget */
+    static constexpr timelib64_t c_memoryBudgetCheckIntervalUsec = 1000000;
+
+    bool m_perGpuEventThreads; /* Should each GPU's NVML events be waited for by its own
+                                  DcgmCacheManagerGpuEventThread? Set by __DCGM_PER_GPU_EVENT_THREADS__=1 */
+
+    bool m_eventDrivenMemoryErrors;         /* Should ECC, retired page and row remapping counters only be read from
+                                               the driver after their GPU raised an ECC, page retirement or XID event?
+                                               Set by __DCGM_EVENT_DRIVEN_MEMORY_ERRORS__=1 */
+    timelib64_t m_memoryErrorSafetyPollUsec; /* Longest time an event-driven memory error watch goes without being
+                                                read. Set by __DCGM_MEMORY_ERROR_SAFETY_POLL_SEC__ */
+
+    /* NVML events that can change the memory error counters. Registered when m_eventDrivenMemoryErrors is set */
+    static constexpr unsigned long long c_memoryErrorEventMask = nvmlEventTypeSingleBitEccError
+                                                                 | nvmlEventTypeDoubleBitEccError
+                                                                 | nvmlEventTypeDramRetirementEvent
+                                                                 | nvmlEventTypeDramRetirementFailure;
+
+    /* GPUs, by gpuId, that have at least their ECC error events registered, so that their memory error watches
+       can be event-driven. Protected by m_mutex */
+    std::array<bool, DCGM_MAX_NUM_DEVICES> m_memoryErrorEventsRegistered;
+
+    /* When each GPU, by gpuId, last raised an event that can change its memory error counters. 0 = never.
+       Written by the event threads and read by the update threads */
+    std::array<std::atomic<timelib64_t>, DCGM_MAX_NUM_DEVICES> m_memoryErrorEventUsec;
+
+    timelib64_t m_breakerTimeoutUsec; /* A driver call to a GPU that takes longer than this counts as a timeout
+                                         towards the GPU's circuit breaker. 0 = breakers are disabled.
+                                         Set by __DCGM_GPU_BREAKER_TIMEOUT_MS__ */
+    unsigned int m_breakerThreshold;  /* Timeouts in a row that quarantine a GPU.
+                                         Set by __DCGM_GPU_BREAKER_THRESHOLD__ */
+
+    /* How often a quarantined GPU is probed with a single driver call */
+    static constexpr timelib64_t c_breakerProbeIntervalUsec = 10000000;
+
+    /* Circuit breakers of the driver calls to each GPU, indexed by gpuId */
+    std::array<dcgmcm_gpu_breaker_t, DCGM_MAX_NUM_DEVICES> m_gpuBreakers;
+
+    /* Statuses of every entity, for lock-free status checks. The GPU groups are republished by
+       PublishEntityStatuses(), the others by the modules through SetEntityStatuses() */
+    DcgmEntityStatusTable m_entityStatuses;
+
+    /* Per-GPU event threads. Empty unless m_perGpuEventThreads is set */
+    std::vector<std::unique_ptr<DcgmCacheManagerGpuEventThread>> m_gpuEventThreads;
+
+    /* Per-GPU update workers, indexed by gpuId. Empty unless m_perGpuUpdateWorkers is set. Only changed while
+       the cache manager thread isn't running, so that thread reads it without a lock */
+    std::vector<std::unique_ptr<DcgmCacheManagerUpdateWorker>> m_updateWorkers;
+
+    std::mutex m_updateWorkerMutex;             /* Protects the next three members and the cycle state of
+                                                   each update worker */
+    std::condition_variable m_updateWorkerCond; /* Signalled when an update cycle starts or a worker finishes */
+    unsigned long long m_updateWorkerCycle;     /* Counter of update cycles started for the update workers */
+    unsigned int m_updateWorkersPending;        /* Number of workers that haven't finished the current cycle */
+
+    /* Threads that sample the GPUs of a field snapshot in parallel. Only used by the cache manager thread, which
+       creates it on the first SnapshotFields() */
+    std::unique_ptr<DcgmNs::WorkStealingThreadPool> m_fieldSnapshotPool;
+    timelib64_t m_lastFieldSnapshotId; /* snapshotId of the last SnapshotFields(). Protected by m_mutex */
+
     bool m_nvmlLoaded; /* true if NVML was successfully loaded */
 
     /*
@@ -1742,6 +2796,21 @@ private:
      */
     std::vector<dcgm_topology_helper_t> GetTopologyHelper(bool includeLinkStatus = false);
 
+    /*************************************************************************/
+    /*
+     * Append a value of m_staticFields to the watch in threadCtx as a sample taken at now
+     */
+    void AppendStaticFieldValue(dcgmcm_update_thread_t *threadCtx,
+                                dcgmBufferedFv_t const &fv,
+                                timelib64_t now,
+                                timelib64_t expireTime);
+
+    /*************************************************************************/
+    /*
+     * Offer the newest sample of watchInfo, a static field of gpuId, to m_staticFields
+     */
+    void StoreStaticWatchValue(dcgmcm_watch_info_p watchInfo, unsigned int gpuId);
+
     /*************************************************************************/
     /*
      * Helper function for DCGM_FI_DEV_FB_* fields.
@@ -1780,6 +2849,88 @@ private:
      */
     dcgmReturn_t PrecheckWatchInfoForSamples(dcgmcm_watch_info_p watchInfo);
 
+    /*************************************************************************/
+    /*
+     * Get the watch that GetSamples() reads for a field
+     * of an entity. Global fields are looked up without the entity.
+     * m_mutex must be held
+     */
+    dcgmcm_watch_info_p GetWatchInfoForSamples(dcgm_field_entity_group_t entityGroupId,
+                                               dcgm_field_eid_t entityId,
+                                               dcgm_field_meta_p fieldMeta);
+
+    /*************************************************************************/
+    /*
+     * Get the most recent sample of a field from m_latestValues without locking
+     * the cache manager. Only numeric samples are published there.
+     *
+     * retSt OUT: Status of writing the sample to sample and/or fvBuffer
+     *
+     * Returns: true if the sample was found and written. retSt is set.
+     *          false if the caller needs to look the sample up under m_mutex
+     */
+    bool GetPublishedLatestSample(dcgm_field_entity_group_t entityGroupId,
+                                  dcgm_field_eid_t entityId,
+                                  dcgm_field_meta_p fieldMeta,
+                                  dcgmcm_sample_p sample,
+                                  DcgmFvBuffer *fvBuffer,
+                                  dcgmReturn_t &retSt);
+
+    /*************************************************************************/
+    /*
+     * Reserve the m_latestValueSlots slot of a numeric entity/field pair and
+     * point its watch at it, if it has one.
+     *
+     * Note: This code assumes that the cache manager is locked and that
+     *       m_latestValueSlots is allocated
+     *
+     * Returns: Index of the slot
+     *          DcgmLatestValueSlots::c_noSlot for non-numeric fields or if every slot is reserved
+     */
+    unsigned int ReserveLatestValueSlot(dcgmGroupEntityPair_t const &entity, unsigned short fieldId);
+
+    /*************************************************************************/
+    /*
+     * Get the m_sharedLatestValues row of a watch, appending it if its field
+     * is one of m_sharedLatestValueFieldIds.
+     *
+     * Note: This code assumes that the cache manager is locked
+     *
+     * Returns: Index of the row
+     *          DcgmSharedLatestValues::c_noRow if the watch isn't shared or the segment is full
+     */
+    unsigned int ReserveSharedLatestValueRow(dcgm_entity_key_t const &watchKey);
+
+    /*************************************************************************/
+    /*
+     * Get the plan of a GetMultipleLatestSamples() request from
+     * m_latestValuePlans, building it the first time it is asked for.
+     */
+    std::shared_ptr<dcgmcm_latest_value_plan_t const> GetLatestValuePlan(
+        std::vector<dcgmGroupEntityPair_t> const &entities,
+        std::vector<unsigned short> const &fieldIds);
+
+    /*************************************************************************/
+    /*
+     * Body of GetLatestSample() that reads the watch's time series.
+     *
+     * Note: This code assumes that the cache manager is locked
+     */
+    dcgmReturn_t GetLatestSampleLocked(dcgm_field_entity_group_t entityGroupId,
+                                       dcgm_field_eid_t entityId,
+                                       dcgm_field_meta_p fieldMeta,
+                                       dcgmcm_sample_p sample,
+                                       DcgmFvBuffer *fvBuffer);
+
+    /*************************************************************************/
+    /*
+     * Mirror the last entry of watchInfo's time series into m_latestValues,
+     * or remove it from there if the time series is empty or not numeric.
+     *
+     * Note: This code assumes that the cache manager is locked
+     */
+    void PublishLatestValue(dcgmcm_watch_info_p watchInfo);
+
     /*************************************************************************/
     /*
      * Helper function to enforce the quota for a watchInfo's time series.
@@ -1794,6 +2945,28 @@ private:
                                        timelib64_t timestamp,
                                        timelib64_t oldestKeepTimestamp);
 
+    /*************************************************************************/
+    /*
+     * Copy the sample that was just appended to watchInfo's time series into
+     * its history tier if historyIntervalUsec has passed since the last sample
+     * there, and drop the history samples older than historyMaxAgeUsec.
+     * Does nothing if watchInfo has no history tier.
+     *
+     * Note: This code assumes that the cache manager is locked
+     */
+    void AppendHistorySample(dcgmcm_watch_info_p watchInfo, timelib64_t timestamp);
+
+    /*************************************************************************/
+    /*
+     * Evict all samples of watchInfo but its latest one, freeing the memory
+     * they took up. Drops its history tier as well.
+     *
+     * Returns the number of samples that were evicted
+     *
+     * Note: This code assumes that the cache manager is locked
+     */
+    long long EvictWatchInfoSamples(dcgmcm_watch_info_p watchInfo);
+
     /*************************************************************************/
     /*
      * Helper functions for adding or removing watch info classes
@@ -1801,10 +2974,18 @@ private:
     dcgmcm_watch_info_p AllocWatchInfo(dcgm_entity_key_t entityKey);
     void FreeWatchInfo(dcgmcm_watch_info_p watchInfo);
 
+    /*************************************************************************/
+    /* Free every watch info and empty m_entityWatchTable. Caller must hold m_mutex or be the only user */
+    void FreeAllWatchInfos();
+
     /*************************************************************************/
     /*
      * Allocate the timeSeries part of a watchInfo
      *
+     * If m_compressedTimeSeries is set, numeric watches get a compressed timeseries.
+     * Otherwise, if m_ringBufferTimeSeries is set, numeric watches get a ring buffer
+     * sized from their maxAgeUsec and monitorIntervalUsec.
+     *
      * Returns: DCGM_ST_OK on success
      *          Any other DCGM_ST_? on error
      */
@@ -1832,22 +3013,38 @@ private:
      * NOTE: This function assumes the cache manager is already locked so that
      *       watchInfo is safe to modify
      *
+     * deferredDeviceEvents IN/OUT: See NvmlPostWatch()
+     *
      * RETURNS: DCGM_ST_OK if the watcher was found and removed
      *          DCGM_ST_NOT_WATCHED if the given watcher wasn't found
      *
      */
-    dcgmReturn_t RemoveWatcher(dcgmcm_watch_info_p watchInfo, dcgm_watch_watcher_info_t *watcher);
+    dcgmReturn_t RemoveWatcher(dcgmcm_watch_info_p watchInfo,
+                               dcgm_watch_watcher_info_t *watcher,
+                               bool *deferredDeviceEvents = nullptr);
 
     /*************************************************************************/
     /*
-     * Cache a snapshot of all valid watch objects so we don't need to hold
-     * the cache manager mutex while we iterate over them. This is useful in
-     * avoiding deadlocks if you'll be RPCing out of the cache manager.
+     * Add or remove watchInfo from m_connectionWatches for watcher. Only client
+     * watchers are tracked since they are the ones OnConnectionRemove() removes
      *
-     * NOTE: You still need to hold the cache manager mutex to modify any entry.
+     * NOTE: Assumes the cache manager is locked by the caller
+     */
+    void TrackConnectionWatch(dcgmcm_watch_info_p watchInfo, DcgmWatcher const &watcher);
+    void UntrackConnectionWatch(dcgmcm_watch_info_p watchInfo, DcgmWatcher const &watcher);
+
+    /*************************************************************************/
+    /*
+     * Make the watches of the inputs of a derived field follow the watch of
+     * the derived field: watched at its interval while it is watched, and
+     * unwatched once it no longer is. Does nothing if watchInfo is not a
+     * derived field.
+     *
+     * deferredDeviceEvents IN/OUT: See NvmlPreWatch()
      *
+     * NOTE: Assumes the cache manager is locked by the caller
      */
-    void GetAllWatchObjects(std::vector<dcgmcm_watch_info_p> &watchers);
+    void SyncDerivedFieldInputs(dcgmcm_watch_info_p watchInfo, bool *deferredDeviceEvents);
 
     /*************************************************************************/
     /*
@@ -1933,6 +3130,14 @@ private:
      */
     void ClearThreadCtx(dcgmcm_update_thread_t *threadCtx);
 
+    /*************************************************************************/
+    /*
+     * Queue a field of gpuId for the next ActuallyUpdateGpuFieldValues() of threadCtx
+     */
+    static void QueueGpuFieldValue(dcgmcm_update_thread_t *threadCtx,
+                                   unsigned int gpuId,
+                                   dcgmcm_field_value_plan_entry_t const &entry);
+
     /*************************************************************************/
     /*
      * Free the contents of a thread context variable. This does not free threadCtx
@@ -1943,41 +3148,86 @@ private:
 
     /*************************************************************************/
     /*
-     * Check to see if an accounting PID has already been cached at a given timestamp
+     * Clear all values from the accounting PID cache
+     *
+     * RETURNS: Nothing
+     *
+     */
+    void EmptyAccountingPidCache();
+
+    /*************************************************************************/
+    /*
+     * Read a value for a GPU field and cache or buffer it. See
+     * dcgmcm_update_thread_t documentation for details.
      *
-     * RETURNS: 1 if PID has been cached
-     *          0 if not
+     * Returns 0 if OK
+     *        <0 DCGM_ST_? on module error
      */
-    int HasAccountingPidBeenSeen(unsigned int pid, timelib64_t timestamp);
+    dcgmReturn_t BufferOrCacheLatestGpuValue(dcgmcm_update_thread_t *threadCtx, dcgm_field_meta_p fieldMeta);
 
     /*************************************************************************/
     /*
-     * Mark a PID as having been cached
+     * Cache the samples of threadCtx->watchInfo's field that NVML buffered
+     * since the last call, each with the timestamp the driver took it at.
+     * See m_nvmlSampleBufferUsec
      *
-     * RETURNS: 0 if OK
-     *         <0 on error. See DCGM_ST_? enumerations for details.
+     * samplingType IN: Buffer of fieldMeta's samples
      *
+     * Returns DCGM_ST_OK if OK, including when there were no new samples
+     *         DCGM_ST_NOT_SUPPORTED if the GPU doesn't buffer these samples. Nothing is cached then so that
+     *                               the caller can read the field the usual way
+     *         Other DCGM_ST_? on error. An error value is cached
      */
-    dcgmReturn_t CacheAccountingPid(unsigned int pid, timelib64_t timestamp);
+    dcgmReturn_t AppendNvmlSampleBuffer(dcgmcm_update_thread_t *threadCtx,
+                                        nvmlDevice_t nvmlDevice,
+                                        dcgm_field_meta_p fieldMeta,
+                                        nvmlSamplingType_t samplingType,
+                                        timelib64_t now,
+                                        timelib64_t expireTime);
 
     /*************************************************************************/
     /*
-     * Clear all values from the accounting PID cache
+     * Build the watcher table entry for a watch of dcgmFieldId. This is also
+     * where the minimum update interval of some fields is enforced, so use
+     * the returned monitorIntervalUsec from then on.
+     */
+    static dcgm_watch_watcher_info_t MakeWatcherInfo(unsigned short dcgmFieldId,
+                                                     timelib64_t monitorIntervalUsec,
+                                                     double maxSampleAge,
+                                                     int maxKeepSamples,
+                                                     DcgmWatcher const &watcher,
+                                                     bool subscribeForUpdates);
+
+    /*************************************************************************/
+    /*
+     * Add or update newWatcher on the watch of entityKey, creating the watch
+     * if needed. This is the locked part of AddEntityFieldWatch().
      *
-     * RETURNS: Nothing
+     * deferredDeviceEvents IN/OUT: See NvmlPreWatch()
      *
+     * NOTE: Assumes the cache manager is locked by the caller
      */
-    void EmptyAccountingPidCache();
+    dcgmReturn_t AddEntityFieldWatchLocked(dcgm_entity_key_t const &entityKey,
+                                           dcgm_watch_watcher_info_t &newWatcher,
+                                           bool entityKeySupportsGpm,
+                                           double maxSampleAge,
+                                           int maxKeepSamples,
+                                           bool *deferredDeviceEvents,
+                                           bool &wereFirstWatcher);
 
     /*************************************************************************/
     /*
-     * Read a value for a GPU field and cache or buffer it. See
-     * dcgmcm_update_thread_t documentation for details.
+     * Remove remWatcher from the watch of entityKey. This is the locked part
+     * of RemoveEntityFieldWatch().
      *
-     * Returns 0 if OK
-     *        <0 DCGM_ST_? on module error
+     * deferredDeviceEvents IN/OUT: See NvmlPostWatch()
+     *
+     * NOTE: Assumes the cache manager is locked by the caller
      */
-    dcgmReturn_t BufferOrCacheLatestGpuValue(dcgmcm_update_thread_t *threadCtx, dcgm_field_meta_p fieldMeta);
+    dcgmReturn_t RemoveEntityFieldWatchLocked(dcgm_entity_key_t const &entityKey,
+                                              dcgm_watch_watcher_info_t &remWatcher,
+                                              bool entityKeySupportsGpm,
+                                              bool *deferredDeviceEvents);
 
     /*************************************************************************/
     /*
@@ -2069,9 +3319,14 @@ private:
                                              timelib64_t timestamp,
                                              timelib64_t oldestKeepTimestamp);
 
+    /*************************************************************************/
+    /*
+     * Append a record for each of one GPU's accounting PIDs from this update
+     * cycle that hasn't been recorded already. The PID cache is checked for the
+     * whole batch under one hold of m_mutex.
+     */
     dcgmReturn_t AppendDeviceAccountingStats(dcgmcm_update_thread_t *threadCtx,
-                                             unsigned int pid,
-                                             nvmlAccountingStats_t *nvmlAccountingStats,
+                                             std::vector<dcgmDevicePidAccountingStats_t> const &accountingStats,
                                              timelib64_t timestamp,
                                              timelib64_t oldestKeepTimestamp);
 
@@ -2093,15 +3348,143 @@ private:
      * Helper to update all fields for a GPU that can be retrieved in batch
      * from NVML via their nvmlFieldId.
      *
-     * threadCtx     IN: Thread context that has the following entries populated:
-     *                   numFieldIds[gpuId] -> Number of entries in next two
-     *                   fieldValueFields[gpuId] -> Field meta for each field
-     *                   fieldValueWatchInfo[gpuId] -> Watch info for each field. NULL=don't cache (just buffer)
+     * threadCtx     IN: Thread context whose fieldValues[gpuId] holds the fields to fetch. Their watchInfo
+     *                   is NULL for values that are only buffered, not cached
      * gpuId         IN: ID of the GPU to fetch fields for
      *
      */
     dcgmReturn_t ActuallyUpdateGpuFieldValues(dcgmcm_update_thread_t *threadCtx, unsigned int gpuId);
 
+    /*************************************************************************/
+    /*
+     * DcgmFieldGetBatchedNvmlFieldId() for a field of GPU gpuId, leaving out the scoped NvLink
+     * error counters if that GPU's driver rejected them. Must be called with m_mutex held
+     *
+     * scopeId  OUT: The scopeId to request the returned NVML field id with
+     *
+     * Returns: The NVML field id
+     *          0 if fieldMeta has to be fetched with its own driver call
+     */
+    unsigned int GetBatchedNvmlFieldId(unsigned int gpuId, dcgm_field_meta_p fieldMeta, unsigned int &scopeId) const;
+
+    /*************************************************************************/
+    /*
+     * Re-read a per-link NvLink error counter that the batched field value call
+     * failed for with nvmlDeviceGetNvLinkErrorCounter(). If that works, the driver
+     * doesn't serve the scoped field value, so later updates of gpuId fetch these
+     * counters with their own driver call.
+     *
+     * fv   IN/OUT: The failed field value. Replaced by the counter value on success
+     *
+     * Returns: true if fv now holds a good value
+     *          false if fv is left alone
+     */
+    bool RetryNvLinkErrorFieldValue(unsigned int gpuId, unsigned short fieldId, nvmlFieldValue_t &fv);
+
+    /*************************************************************************/
+    /*
+     * Rebuild m_fieldValuePlan from the watch table.
+     * Must be called with m_mutex held
+     */
+    void BuildFieldValuePlan();
+
+    /*************************************************************************/
+    /*
+     * Queue every watch of m_fieldValuePlan that is due for an update into
+     * threadCtx->fieldValues so that ActuallyUpdateGpuFieldValues() fetches it.
+     * Must be called with m_mutex held
+     *
+     * threadCtx           IN/OUT: Update thread context to queue watches into
+     * now                     IN: Current timestamp in usec since 1970
+     * earliestNextUpdate  IN/OUT: Lowered to the next update time of any watch of the plan
+     * updateShard             IN: See ActuallyUpdateAllFields()
+     *
+     * Returns: true if any watch was queued
+     *          false if not
+     */
+    bool QueueDueFieldValuePlanWatches(dcgmcm_update_thread_t *threadCtx,
+                                       timelib64_t now,
+                                       timelib64_t *earliestNextUpdate,
+                                       unsigned int updateShard);
+
+    /*************************************************************************/
+    /*
+     * Update a single watch if it is due, queueing it into threadCtx if it is
+     * served by the batched field value call. This may unlock and relock
+     * m_mutex around driver calls. Must be called with m_mutex held
+     *
+     * threadCtx           IN/OUT: Update thread context
+     * watchInfo               IN: Watch to update
+     * now                 IN/OUT: Current timestamp in usec since 1970. Refreshed after driver calls
+     * earliestNextUpdate  IN/OUT: Lowered to the next update time of watchInfo
+     * anyFieldValues      IN/OUT: Set to 1 if watchInfo was queued for the batched field value call
+     * force                   IN: Update watchInfo even if it isn't due
+     *
+     * Returns: The timestamp in usec since 1970 when watchInfo is next due
+     */
+    timelib64_t UpdateWatchIfDue(dcgmcm_update_thread_t *threadCtx,
+                                 dcgmcm_watch_info_p watchInfo,
+                                 timelib64_t &now,
+                                 timelib64_t *earliestNextUpdate,
+                                 int &anyFieldValues,
+                                 bool force = false);
+
+    /*************************************************************************/
+    /*
+     * Update the due watches of updateShard by walking the whole watch table.
+     * Watches of m_fieldValuePlan are queued from the plan instead.
+     * Must be called with m_mutex held. Parameters are as for UpdateWatchIfDue()
+     */
+    void WalkAndUpdateWatches(dcgmcm_update_thread_t *threadCtx,
+                              timelib64_t &now,
+                              timelib64_t *earliestNextUpdate,
+                              unsigned int updateShard,
+                              int &anyFieldValues);
+
+    /*************************************************************************/
+    /*
+     * Update the due watches of updateShard from its entry in m_watchSchedules,
+     * rebuilding it first if the watch set changed.
+     * Must be called with m_mutex held. Parameters are as for UpdateWatchIfDue()
+     */
+    void UpdateScheduledWatches(dcgmcm_update_thread_t *threadCtx,
+                                timelib64_t &now,
+                                timelib64_t *earliestNextUpdate,
+                                unsigned int updateShard,
+                                int &anyFieldValues);
+
+    /*************************************************************************/
+    /*
+     * Write the watch table and the most recent samples of each numeric watch to
+     * m_snapshotPath. Must be called without m_mutex held
+     */
+    dcgmReturn_t SaveSnapshot();
+
+    /*************************************************************************/
+    /*
+     * Restore the watches and samples of m_snapshotPath if it was written on a
+     * system with the same driver version and GPUs. Called from Init() after the
+     * GPUs are attached.
+     *
+     * Returns DCGM_ST_OK if the snapshot was restored
+     *         DCGM_ST_NO_DATA if there is no snapshot or it doesn't match this system
+     *         Other DCGM_ST_? on error
+     */
+    dcgmReturn_t LoadSnapshot();
+
+    /*************************************************************************/
+    /*
+     * Get the UUID of each GPU, indexed by gpuId. Must be called with m_mutex held
+     */
+    void GetGpuUuidsForSnapshot(std::vector<std::string> &gpuUuids);
+
+    /*************************************************************************/
+    /*
+     * Rebuild schedule from the watches of the watch table that belong to updateShard.
+     * Must be called with m_mutex held
+     */
+    void BuildWatchSchedule(dcgmcm_watch_schedule_t &schedule, unsigned int updateShard);
+
     /*************************************************************************/
     /*
      * Polling thread run() top level helpers
@@ -2111,6 +3494,32 @@ private:
      */
     timelib64_t DoOneUpdateAllFields(void);
 
+    /*************************************************************************/
+    /*
+     * Task of UpdateFields(). Updates the watches of fieldIds on entities and
+     * notifies subscribers of the new values
+     */
+    void DoOneUpdateFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                           std::vector<unsigned short> const &fieldIds);
+
+    /*************************************************************************/
+    /*
+     * Task of SnapshotFields(). Returns the snapshotId
+     */
+    timelib64_t DoOneSnapshotFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                                    std::vector<unsigned short> const &fieldIds);
+
+    /*************************************************************************/
+    /*
+     * Append the watched watches of fieldIds on entities to watches. Global
+     * fields are added once no matter which entities are passed
+     *
+     * NOTE: Assumes the cache manager is locked by the caller
+     */
+    void GetWatchesOfFields(std::vector<dcgmGroupEntityPair_t> const &entities,
+                            std::vector<unsigned short> const &fieldIds,
+                            std::vector<dcgmcm_watch_info_p> &watches);
+
     /*************************************************************************/
     /*
      * The part of run() that actually does work. This exists so that all
@@ -2119,16 +3528,103 @@ private:
      */
     void RunWrapped(void);
 
+    /*************************************************************************/
+    /*
+     * Start one DcgmCacheManagerUpdateWorker per GPU if per-GPU update workers
+     * are enabled. Is a no-op otherwise. Must be called before the cache
+     * manager thread starts. See m_updateWorkers
+     *
+     * Returns DCGM_ST_OK on success.
+     *         Other DCGM_ST_? on error.
+     */
+    dcgmReturn_t StartUpdateWorkers(void);
+
+    /*************************************************************************/
+    /*
+     * Stop and free all of the per-GPU update workers
+     */
+    void StopUpdateWorkers(void);
+
+    /*************************************************************************/
+    /*
+     * Return which update shard owns a watch. This is the gpuId of the update worker
+     * of the GPU the watch's practical entity belongs to or DCGM_CM_UPDATE_SHARD_NON_GPU
+     * if no update worker owns it.
+     *
+     * NOTE: This function assumes it is inside of a Lock() / Unlock() pair.
+     */
+    unsigned int GetWatchUpdateShard(dcgmcm_watch_info_p watchInfo) const;
+
+    /*************************************************************************/
+    /*
+     * Return the gpuId of the GPU a watch's practical entity belongs to or
+     * DCGM_GPU_ID_BAD if it doesn't belong to a GPU.
+     *
+     * NOTE: This function assumes it is inside of a Lock() / Unlock() pair.
+     */
+    unsigned int GetWatchGpuId(dcgmcm_watch_info_p watchInfo) const;
+
+    /*************************************************************************/
+    /*
+     * Feed the duration of a driver call made to gpuId to its circuit breaker.
+     * A call that took longer than m_breakerTimeoutUsec counts as a timeout and
+     * m_breakerThreshold timeouts in a row quarantine the GPU. A call that
+     * completed in time closes the breaker again. Is a no-op if breakers are
+     * disabled. Is thread safe.
+     */
+    void RecordGpuDriverCall(unsigned int gpuId, timelib64_t elapsedUsec);
+
+    /*************************************************************************/
+    /*
+     * Return whether the watches of gpuId should be skipped because the GPU is
+     * quarantined. Once every c_breakerProbeIntervalUsec, one caller is let
+     * through to probe the GPU. Is thread safe.
+     */
+    bool SkipQuarantinedGpu(unsigned int gpuId, timelib64_t now);
+
+    /*************************************************************************/
+    /*
+     * Return whether a due update of watchInfo can be skipped because it is
+     * an ECC, retired page or row remapping counter and its GPU has raised no
+     * event that could change it since it was last read. The skipped update
+     * counts as a query, so the watch comes due again one interval later.
+     * Watches are read at least every m_memoryErrorSafetyPollUsec anyway.
+     * Always false unless m_eventDrivenMemoryErrors is set and the GPU's memory
+     * error events are registered. Only called by the thread updating watchInfo.
+     */
+    bool SkipUnchangedMemoryErrorWatch(dcgmcm_watch_info_p watchInfo, timelib64_t now);
+
+    /*************************************************************************/
+    /*
+     * Note that gpuId raised an event that may change its memory error counters. Is thread safe.
+     */
+    void MarkMemoryErrorEvent(unsigned int gpuId, timelib64_t now);
+
+    /*************************************************************************/
+    /*
+     * Start an update cycle on every per-GPU update worker, update the watches
+     * that aren't owned by any worker with threadCtx, and then wait for the workers
+     * to finish their cycle.
+     *
+     * Returns the earliest next update across all of the shards.
+     */
+    timelib64_t RunShardedUpdateCycle(dcgmcm_update_thread_t *threadCtx);
+
     /*************************************************************************/
     /*
      * Helpers to prepare or unprepare NVML for field updates for a given field ID.
      * This handles tasks like telling NVML to watch/unwatch accounting data
      *
+     * deferredDeviceEvents IN/OUT: If not null, fields that change which NVML events
+     *                               we want set this to true instead of calling
+     *                               ManageDeviceEvents(). The caller then calls it once
+     *                               after a batch of watches.
+     *
      * NOTE: This function assumes it is inside of a Lock() / Unlock() pair.
      *
      */
-    dcgmReturn_t NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId);
-    dcgmReturn_t NvmlPostWatch(unsigned int gpuId, unsigned short dcgmFieldId);
+    dcgmReturn_t NvmlPreWatch(unsigned int gpuId, unsigned short dcgmFieldId, bool *deferredDeviceEvents = nullptr);
+    dcgmReturn_t NvmlPostWatch(unsigned int gpuId, unsigned short dcgmFieldId, bool *deferredDeviceEvents = nullptr);
 
     /*************************************************************************/
     /*
@@ -2154,7 +3650,8 @@ private:
      * we care about
      *
      * NOTE: This function assumes it is inside of a Lock() / Unlock() pair.
-     *       Currently, it is only called from NvmlPreWatch/NvmlPostWatch
+     *       Currently, it is only called from NvmlPreWatch/NvmlPostWatch and
+     *       after a batch of watches by AddFieldWatches/RemoveFieldWatches
      *
      * addWatchOnGpuId     IN: Optional GPU ID of a watch that will be created
      *                         after this call that we should prepare for. -1 = none
@@ -2241,6 +3738,63 @@ private:
      */
     dcgmReturn_t InitializeNvmlEventSet();
 
+    /*************************************************************************/
+    /*
+     * Returns the event set that gpuId's events should be registered on, creating
+     * it if needed. This is the GPU's own set when per-GPU event threads are
+     * enabled and m_nvmlEventSet otherwise.
+     *
+     * Returns DCGM_ST_OK on success.
+     *         Other DCGM_ST_? on error.
+     */
+    dcgmReturn_t GetEventSetForGpu(unsigned int gpuId, nvmlEventSet_t &eventSet);
+
+    /*************************************************************************/
+    /*
+     * Start one DcgmCacheManagerGpuEventThread per GPU with an event set if
+     * per-GPU event threads are enabled. Is a no-op otherwise.
+     *
+     * Returns DCGM_ST_OK on success.
+     *         Other DCGM_ST_? on error.
+     */
+    dcgmReturn_t StartGpuEventThreads(void);
+
+    /*************************************************************************/
+    /*
+     * Stop and free all of the per-GPU event threads
+     */
+    void StopGpuEventThreads(void);
+
+    /*************************************************************************/
+    /*
+     * Handle an event that was read from an NVML event set: record XIDs and
+     * re-read the MIG hierarchy, then push the new values to live subscribers.
+     * The time from now until the subscribers were updated is accumulated as
+     * the exec time of the GPU's DCGM_FI_DEV_XID_ERRORS watch.
+     * NOTE: The caller must have marked that it entered the driver
+     *
+     * @param threadCtx       [in,out] - event thread context to buffer samples in
+     * @param eventData       [in]     - the event
+     * @param now             [in]     - when the event was dequeued
+     * @param updatedMigGpuId [out]    - gpuId whose MIG configuration changed.
+     *                                   DCGM_MAX_NUM_DEVICES if none
+     *
+     * Returns DCGM_ST_OK on success.
+     *         Other DCGM_ST_? if the GPU of the event couldn't be found.
+     */
+    dcgmReturn_t ProcessNvmlEvent(dcgmcm_update_thread_t &threadCtx,
+                                  nvmlEventData_t &eventData,
+                                  timelib64_t now,
+                                  unsigned int &updatedMigGpuId);
+
+    /*************************************************************************/
+    /*
+     * Notify the MIG update subscribers of what changed in gpuId's MIG hierarchy
+     * after ProcessNvmlEvent() handled a MIG configuration change.
+     * NOTE: The caller must have returned from the driver
+     */
+    void NotifyMigConfigChange(unsigned int gpuId);
+
     /*************************************************************************/
     /*
      * Read the chip architecture from NVML. Note that this may be inferred
@@ -2299,12 +3853,33 @@ private:
      * @param gpuId         - the ID for the GPU
      * @param entityId      - the entity ID for the
      * @param entityGroupId - the type of entity
+     * @param instanceIndex - if not nullptr, set to the index of the GPU instance in m_gpus[gpuId].instances
      *
      * @return nullptr if no GPU instance is found, the handle otherwise
      */
     nvmlDevice_t GetComputeInstanceNvmlDevice(unsigned int gpuId,
                                               dcgm_field_entity_group_t entityGroupId,
-                                              unsigned int entityId);
+                                              unsigned int entityId,
+                                              unsigned int *instanceIndex = nullptr);
+
+    /*************************************************************************/
+    /*
+     * Reads the FB memory info of the GPU_I or GPU_CI entity in threadCtx->entityKey
+     *
+     * The driver is called once per GPU instance and update cycle. The GPU instance and all of
+     * its compute instances are served from the values cached in threadCtx->migMemory.
+     *
+     * @return the NVML return of the query
+     */
+    nvmlReturn_t ReadMigFbMemoryInfo(dcgmcm_update_thread_t *threadCtx, unsigned int gpuId, nvmlMemory_v2_t &fbMemory);
+
+    /*************************************************************************/
+    /*
+     * Same as ReadMigFbMemoryInfo() for the BAR1 memory info
+     */
+    nvmlReturn_t ReadMigBar1MemoryInfo(dcgmcm_update_thread_t *threadCtx,
+                                       unsigned int gpuId,
+                                       nvmlBAR1Memory_t &bar1Memory);
 
     /*************************************************************************/
     /*
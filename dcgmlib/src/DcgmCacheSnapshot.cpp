@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmCacheSnapshot.h"
+
+#include <DcgmLogging.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr char c_snapshotMagic[8]        = { 'D', 'C', 'G', 'M', 'C', 'S', 'N', 'P' };
+constexpr std::uint32_t c_snapshotFormat = 1;
+constexpr size_t c_uuidBytes             = 128;
+constexpr size_t c_driverVersionBytes    = 80;
+
+/* On-disk layout. The header is followed by numGpus UUIDs of c_uuidBytes each, then by numWatches
+   records. Each record is followed by its watcher types and then by its samples */
+struct SnapshotFileHeader
+{
+    char magic[8];
+    std::uint32_t format;
+    std::uint32_t numGpus;
+    std::uint32_t numWatches;
+    std::uint32_t reserved;
+    std::uint64_t fileBytes;
+    char driverVersion[c_driverVersionBytes];
+};
+static_assert(sizeof(SnapshotFileHeader) == 112);
+
+struct SnapshotFileWatch
+{
+    std::uint16_t entityGroupId;
+    std::uint16_t fieldId;
+    std::uint32_t entityId;
+    std::int64_t monitorIntervalUsec;
+    std::int64_t maxAgeUsec;
+    std::int32_t tsType;
+    std::uint32_t numWatcherTypes;
+    std::uint32_t numSamples;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(SnapshotFileWatch) == 40);
+
+struct SnapshotFileSample
+{
+    std::int64_t timestamp;
+    std::int64_t value;
+    std::int64_t value2;
+};
+static_assert(sizeof(SnapshotFileSample) == 24);
+
+/*****************************************************************************/
+/* Bounds-checked cursor over the mapped file */
+class SnapshotReader
+{
+public:
+    SnapshotReader(unsigned char const *data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {}
+
+    bool Read(void *out, size_t bytes)
+    {
+        if (bytes > m_size - m_offset)
+        {
+            return false;
+        }
+        memcpy(out, m_data + m_offset, bytes);
+        m_offset += bytes;
+        return true;
+    }
+
+private:
+    unsigned char const *m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+} // namespace
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheSnapshot::WriteToFile(std::string const &path) const
+{
+    size_t fileBytes = sizeof(SnapshotFileHeader) + gpuUuids.size() * c_uuidBytes;
+    for (auto const &watch : watches)
+    {
+        fileBytes += sizeof(SnapshotFileWatch) + watch.watcherTypes.size() * sizeof(std::uint32_t)
+                     + watch.samples.size() * sizeof(SnapshotFileSample);
+    }
+
+    std::string tempPath = path + ".tmp";
+    int fd               = open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        log_error("Unable to open {} for writing. errno {}", tempPath, errno);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (ftruncate(fd, (off_t)fileBytes) != 0)
+    {
+        log_error("Unable to size {} to {} bytes. errno {}", tempPath, fileBytes, errno);
+        close(fd);
+        unlink(tempPath.c_str());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    void *mapping = mmap(nullptr, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        log_error("Unable to map {}. errno {}", tempPath, errno);
+        close(fd);
+        unlink(tempPath.c_str());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    unsigned char *cursor = (unsigned char *)mapping;
+
+    SnapshotFileHeader header {};
+    memcpy(header.magic, c_snapshotMagic, sizeof(header.magic));
+    header.format     = c_snapshotFormat;
+    header.numGpus    = (std::uint32_t)gpuUuids.size();
+    header.numWatches = (std::uint32_t)watches.size();
+    header.fileBytes  = fileBytes;
+    snprintf(header.driverVersion, sizeof(header.driverVersion), "%s", driverVersion.c_str());
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (auto const &uuid : gpuUuids)
+    {
+        char uuidBuf[c_uuidBytes] {};
+        snprintf(uuidBuf, sizeof(uuidBuf), "%s", uuid.c_str());
+        memcpy(cursor, uuidBuf, sizeof(uuidBuf));
+        cursor += sizeof(uuidBuf);
+    }
+
+    for (auto const &watch : watches)
+    {
+        SnapshotFileWatch record {};
+        record.entityGroupId       = watch.watchKey.entityGroupId;
+        record.fieldId             = watch.watchKey.fieldId;
+        record.entityId            = watch.watchKey.entityId;
+        record.monitorIntervalUsec = watch.monitorIntervalUsec;
+        record.maxAgeUsec          = watch.maxAgeUsec;
+        record.tsType              = watch.tsType;
+        record.numWatcherTypes     = (std::uint32_t)watch.watcherTypes.size();
+        record.numSamples          = (std::uint32_t)watch.samples.size();
+        memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+
+        for (auto watcherType : watch.watcherTypes)
+        {
+            std::uint32_t type = (std::uint32_t)watcherType;
+            memcpy(cursor, &type, sizeof(type));
+            cursor += sizeof(type);
+        }
+
+        for (auto const &sample : watch.samples)
+        {
+            SnapshotFileSample fileSample { sample.timestamp, sample.value, sample.value2 };
+            memcpy(cursor, &fileSample, sizeof(fileSample));
+            cursor += sizeof(fileSample);
+        }
+    }
+
+    int syncSt = msync(mapping, fileBytes, MS_SYNC);
+    munmap(mapping, fileBytes);
+    close(fd);
+
+    if (syncSt != 0)
+    {
+        log_error("Unable to flush {}. errno {}", tempPath, errno);
+        unlink(tempPath.c_str());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        log_error("Unable to rename {} to {}. errno {}", tempPath, path, errno);
+        unlink(tempPath.c_str());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    log_debug("Wrote cache snapshot of {} watches and {} bytes to {}", watches.size(), fileBytes, path);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmCacheSnapshot::ReadFromFile(std::string const &path)
+{
+    driverVersion.clear();
+    gpuUuids.clear();
+    watches.clear();
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        log_debug("No cache snapshot at {}. errno {}", path, errno);
+        return DCGM_ST_NO_DATA;
+    }
+
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(SnapshotFileHeader))
+    {
+        log_error("Cache snapshot {} is too small to be valid", path);
+        close(fd);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    size_t fileBytes = (size_t)fileStat.st_size;
+    void *mapping    = mmap(nullptr, fileBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        log_error("Unable to map {}. errno {}", path, errno);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    SnapshotReader reader((unsigned char const *)mapping, fileBytes);
+    dcgmReturn_t ret = DCGM_ST_OK;
+    SnapshotFileHeader header {};
+
+    if (!reader.Read(&header, sizeof(header)) || memcmp(header.magic, c_snapshotMagic, sizeof(header.magic)) != 0
+        || header.fileBytes != fileBytes)
+    {
+        log_error("Cache snapshot {} has a bad header", path);
+        ret = DCGM_ST_GENERIC_ERROR;
+    }
+    else if (header.format != c_snapshotFormat)
+    {
+        log_info("Ignoring cache snapshot {} of format {} != {}", path, header.format, c_snapshotFormat);
+        ret = DCGM_ST_VER_MISMATCH;
+    }
+
+    if (ret == DCGM_ST_OK)
+    {
+        header.driverVersion[sizeof(header.driverVersion) - 1] = '\0';
+        driverVersion                                          = header.driverVersion;
+
+        for (std::uint32_t i = 0; i < header.numGpus && ret == DCGM_ST_OK; i++)
+        {
+            char uuidBuf[c_uuidBytes];
+            if (!reader.Read(uuidBuf, sizeof(uuidBuf)))
+            {
+                ret = DCGM_ST_GENERIC_ERROR;
+                break;
+            }
+            uuidBuf[sizeof(uuidBuf) - 1] = '\0';
+            gpuUuids.emplace_back(uuidBuf);
+        }
+
+        for (std::uint32_t i = 0; i < header.numWatches && ret == DCGM_ST_OK; i++)
+        {
+            SnapshotFileWatch record {};
+            if (!reader.Read(&record, sizeof(record)))
+            {
+                ret = DCGM_ST_GENERIC_ERROR;
+                break;
+            }
+
+            dcgmcm_snapshot_watch_t watch {};
+            watch.watchKey.entityGroupId = record.entityGroupId;
+            watch.watchKey.fieldId       = record.fieldId;
+            watch.watchKey.entityId      = record.entityId;
+            watch.monitorIntervalUsec    = record.monitorIntervalUsec;
+            watch.maxAgeUsec             = record.maxAgeUsec;
+            watch.tsType                 = record.tsType;
+
+            for (std::uint32_t j = 0; j < record.numWatcherTypes; j++)
+            {
+                std::uint32_t type = 0;
+                if (!reader.Read(&type, sizeof(type)) || type >= DcgmWatcherTypeCount)
+                {
+                    ret = DCGM_ST_GENERIC_ERROR;
+                    break;
+                }
+                watch.watcherTypes.push_back((DcgmWatcherType_t)type);
+            }
+
+            for (std::uint32_t j = 0; j < record.numSamples && ret == DCGM_ST_OK; j++)
+            {
+                SnapshotFileSample fileSample {};
+                if (!reader.Read(&fileSample, sizeof(fileSample)))
+                {
+                    ret = DCGM_ST_GENERIC_ERROR;
+                    break;
+                }
+                watch.samples.push_back({ fileSample.timestamp, fileSample.value, fileSample.value2 });
+            }
+
+            watches.push_back(std::move(watch));
+        }
+
+        if (ret != DCGM_ST_OK)
+        {
+            log_error("Cache snapshot {} is truncated", path);
+        }
+    }
+
+    munmap(mapping, fileBytes);
+
+    if (ret != DCGM_ST_OK)
+    {
+        driverVersion.clear();
+        gpuUuids.clear();
+        watches.clear();
+    }
+
+    return ret;
+}
+
+/*****************************************************************************/
+bool DcgmCacheSnapshot::Matches(std::string const &currentDriverVersion,
+                                std::vector<std::string> const &currentGpuUuids) const
+{
+    return driverVersion == currentDriverVersion && gpuUuids == currentGpuUuids;
+}
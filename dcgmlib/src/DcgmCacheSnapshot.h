@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmWatchTable.h"
+#include "dcgm_structs.h"
+#include "dcgm_structs_internal.h"
+#include "timelib.h"
+
+#include <string>
+#include <vector>
+
+/*****************************************************************************/
+/* One cached sample. For TS_TYPE_DOUBLE watches, value and value2 hold the bits of the doubles */
+struct dcgmcm_snapshot_sample_t
+{
+    timelib64_t timestamp = 0;
+    long long value       = 0;
+    long long value2      = 0;
+};
+
+/*****************************************************************************/
+/* One watch of the watch table along with its most recent samples */
+struct dcgmcm_snapshot_watch_t
+{
+    dcgm_entity_key_t watchKey {};
+    timelib64_t monitorIntervalUsec = 0;
+    timelib64_t maxAgeUsec          = 0;
+    int tsType                      = 0;       /* TS_TYPE_INT64 or TS_TYPE_DOUBLE. 0 if there are no samples */
+    std::vector<DcgmWatcherType_t> watcherTypes;   /* Watchers that survive a restart. Empty = history only */
+    std::vector<dcgmcm_snapshot_sample_t> samples; /* Oldest first */
+};
+
+/*****************************************************************************/
+/*
+ * Contents of the cache manager that are persisted across host engine restarts,
+ * along with what identifies the system they were taken on.
+ *
+ * The file is written to a temporary file through a shared mapping and renamed
+ * into place so that a crash mid-write never leaves a torn snapshot behind.
+ */
+class DcgmCacheSnapshot
+{
+public:
+    std::string driverVersion;                    /* DcgmCacheManager::m_driverVersion at the time of the snapshot */
+    std::vector<std::string> gpuUuids;            /* UUID of each GPU, indexed by gpuId */
+    std::vector<dcgmcm_snapshot_watch_t> watches; /* Watches of the watch table */
+
+    /*************************************************************************/
+    /*
+     * Write this snapshot to path, replacing any existing file
+     *
+     * Returns DCGM_ST_OK on success
+     *         Other DCGM_ST_? on error
+     */
+    dcgmReturn_t WriteToFile(std::string const &path) const;
+
+    /*************************************************************************/
+    /*
+     * Replace the contents of this snapshot with the one in path
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NO_DATA if there is no snapshot at path
+     *         DCGM_ST_VER_MISMATCH if the file was written by another snapshot format version
+     *         DCGM_ST_GENERIC_ERROR if the file is truncated or otherwise can't be parsed
+     */
+    dcgmReturn_t ReadFromFile(std::string const &path);
+
+    /*************************************************************************/
+    /*
+     * Is this snapshot from a system with the given driver version and GPUs?
+     */
+    bool Matches(std::string const &currentDriverVersion, std::vector<std::string> const &currentGpuUuids) const;
+};
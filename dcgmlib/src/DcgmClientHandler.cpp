@@ -15,7 +15,9 @@
  */
 
 #include "DcgmClientHandler.h"
+#include "DcgmClientMetadataCache.h"
 #include "DcgmLogging.h"
+#include "DcgmMessagePool.h"
 #include "DcgmMutex.h"
 #include "DcgmProtocol.h"
 #include "DcgmRequest.h"
@@ -24,6 +26,8 @@
 #include "timelib.h"
 #include <DcgmIpc.h>
 #include <dcgm_core_structs.h>
+#include <algorithm>
+#include <climits>
 #include <iostream>
 #include <stdexcept>
 #include <stdlib.h>
@@ -79,6 +83,7 @@ DcgmClientHandler::~DcgmClientHandler()
         DcgmLockGuard dlg(&m_mutex);
         m_blockingReqs.clear();
         m_persistentReqs.clear();
+        m_asyncReqs.clear();
         m_connectionRequests.clear();
         m_connectionAttributes.clear();
     }
@@ -91,6 +96,10 @@ void DcgmClientHandler::ProcessDisconnect(dcgm_connection_id_t connectionId)
 {
     DCGM_LOG_VERBOSE << "ProcessDisconnect for connectionId " << connectionId;
 
+    /* Before taking m_mutex since this calls completion callbacks */
+    FailAsyncRequests(connectionId, DCGM_ST_CONNECTION_NOT_VALID);
+    m_metadataCache.Remove(connectionId);
+
     DcgmLockGuard dlg(&m_mutex);
 
     auto it = m_connectionRequests.find(connectionId);
@@ -140,6 +149,35 @@ void DcgmClientHandler::ProcessMessage(dcgm_connection_id_t connectionId, std::u
         return;
     }
 
+    if (msgHdr->msgType == DCGM_MSG_REQUEST_NOTIFY)
+    {
+        /* The host engine won't send this persistent request anything else. This is not a
+           response, so it must not complete a blocking or async request of the same requestId */
+        DCGM_LOG_DEBUG << "Removing completed persistent requestId " << msgHdr->requestId;
+        RemovePersistentRequest(connectionId, msgHdr->requestId);
+        return;
+    }
+
+    if (msgHdr->msgType == DCGM_MSG_METADATA_NOTIFY)
+    {
+        auto msgBytes = dcgmMessage->GetMsgBytesPtr();
+        if (msgBytes->size() < sizeof(dcgm_msg_metadata_notify_t))
+        {
+            DCGM_LOG_ERROR << "Metadata notification of " << msgBytes->size() << " bytes is too short";
+            return;
+        }
+        dcgm_msg_metadata_notify_t notify;
+        memcpy(&notify, msgBytes->data(), sizeof(notify));
+        m_metadataCache.SetGeneration(connectionId, notify.generation);
+        return;
+    }
+
+    /* Before taking m_mutex since this can call a completion callback */
+    if (!dcgmMessage->IsAsyncNotification() && CompleteAsyncRequest(msgHdr->requestId, dcgmMessage))
+    {
+        return;
+    }
+
     DcgmLockGuard dlg { &m_mutex };
 
     /* Only mark requests as complete if this is a response to a request (not an async notification) */
@@ -192,7 +230,8 @@ dcgmReturn_t DcgmClientHandler::TryConnectingToHostEngine(char identifier[],
                                                           unsigned int portNumber,
                                                           dcgmHandle_t *pDcgmHandle,
                                                           bool addressIsUnixSocket,
-                                                          int connectionTimeoutMs)
+                                                          int connectionTimeoutMs,
+                                                          unsigned int compressMinBytes)
 {
     dcgm_connection_id_t connectionId { DCGM_CONNECTION_ID_NONE };
     dcgmReturn_t dcgmReturn;
@@ -203,7 +242,8 @@ dcgmReturn_t DcgmClientHandler::TryConnectingToHostEngine(char identifier[],
     }
     else
     {
-        dcgmReturn = m_dcgmIpc.ConnectTcp(identifier, portNumber, connectionId, connectionTimeoutMs);
+        dcgmReturn
+            = m_dcgmIpc.ConnectTcp(identifier, portNumber, connectionId, connectionTimeoutMs, compressMinBytes);
     }
 
     *pDcgmHandle = (dcgmHandle_t)connectionId;
@@ -216,7 +256,9 @@ dcgmReturn_t DcgmClientHandler::TryConnectingToHostEngine(char identifier[],
 dcgmReturn_t DcgmClientHandler::GetConnHandleForHostEngine(const char *identifier,
                                                            dcgmHandle_t *pDcgmHandle,
                                                            unsigned int timeoutMs,
-                                                           bool addressIsUnixSocket)
+                                                           bool addressIsUnixSocket,
+                                                           unsigned int compressMinBytes,
+                                                           bool metadataCache)
 {
     if (!timeoutMs)
         timeoutMs = 5000; /* 5-second default timeout */
@@ -263,7 +305,7 @@ dcgmReturn_t DcgmClientHandler::GetConnHandleForHostEngine(const char *identifie
         attempt++;
         if (DCGM_ST_OK
             == TryConnectingToHostEngine(
-                identifierTemp.data(), portNumber, pDcgmHandle, addressIsUnixSocket, timeoutMs))
+                identifierTemp.data(), portNumber, pDcgmHandle, addressIsUnixSocket, timeoutMs, compressMinBytes))
         {
             connected = true;
             break;
@@ -285,6 +327,11 @@ dcgmReturn_t DcgmClientHandler::GetConnHandleForHostEngine(const char *identifie
     {
         DCGM_LOG_DEBUG << "successfully connected to hostengine. Getting connection attributes.";
         PopulateConnectionAttributes((dcgm_connection_id_t)*pDcgmHandle);
+        ProbeRequestCancel((dcgm_connection_id_t)*pDcgmHandle);
+        if (metadataCache)
+        {
+            EnableMetadataCache((dcgm_connection_id_t)*pDcgmHandle);
+        }
         return DCGM_ST_OK;
     }
     else
@@ -307,6 +354,7 @@ void DcgmClientHandler::CloseConnForHostEngine(dcgmHandle_t connHandle)
         return;
     }
 
+    m_metadataCache.Remove(connectionId);
     m_dcgmIpc.CloseConnection(connectionId);
 }
 
@@ -399,19 +447,28 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
                                                            size_t maxResponseSize,
                                                            unsigned int timeoutMs)
 {
-    std::unique_ptr<DcgmMessage> dcgmSendMsg = std::make_unique<DcgmMessage>();
     dcgm_request_id_t requestId;
     dcgm_connection_id_t connectionId = (dcgm_connection_id_t)dcgmHandle;
 
+    /* Persistent requests have to reach the host engine */
+    bool const cacheable = request == nullptr && DcgmClientMetadataCache::IsCacheable(*moduleCommand)
+                           && m_metadataCache.IsEnabled(connectionId);
+    std::string cacheKey;
+    unsigned long long cacheGeneration = 0;
+    if (cacheable)
+    {
+        cacheKey = DcgmClientMetadataCache::MakeKey(*moduleCommand);
+        if (m_metadataCache.Lookup(connectionId, cacheKey, moduleCommand, maxResponseSize, cacheGeneration))
+        {
+            return DCGM_ST_OK;
+        }
+    }
+
     // Get Next Request ID
     requestId       = GetNextRequestId();
     auto requestFut = AddBlockingRequest(connectionId, requestId);
 
-    /* Update Encoded Message with a header to be sent over socket */
-    dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, requestId, DCGM_ST_OK, moduleCommand->length);
-    auto msgData = dcgmSendMsg->GetMsgBytesPtr();
-    msgData->resize(moduleCommand->length);
-    memcpy(msgData->data(), moduleCommand, moduleCommand->length);
+    std::unique_ptr<DcgmMessage> dcgmSendMsg = BuildModuleCommandMessage(moduleCommand, requestId, timeoutMs);
 
     if (request != nullptr)
     {
@@ -441,6 +498,7 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
                            << timeoutMs << " ms.";
             RemoveBlockingRequest(connectionId, requestId, std::nullopt);
             RemovePersistentRequest(connectionId, requestId);
+            SendRequestCancel(connectionId, requestId);
             return DCGM_ST_TIMEOUT;
         }
     }
@@ -457,7 +515,184 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
 
     DCGM_LOG_DEBUG << "Request Wait completed for connectionId " << connectionId << " request ID: " << requestId;
 
+    /* If the request was persistent, it still exists in m_persistentReqs */
+    retSt = CopyModuleCommandResponse(*response.response, moduleCommand, maxResponseSize);
+    DcgmMessagePool::GetInstance().Put(std::move(response.response));
+    if (cacheable && retSt == DCGM_ST_OK)
+    {
+        m_metadataCache.Store(connectionId, cacheGeneration, std::move(cacheKey), moduleCommand);
+    }
+    return retSt;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandBatch(
+    dcgmHandle_t dcgmHandle,
+    std::vector<dcgm_module_command_header_t *> const &moduleCommands,
+    std::vector<size_t> const &maxResponseSizes,
+    std::vector<dcgmReturn_t> &statuses,
+    unsigned int timeoutMs)
+{
+    dcgm_connection_id_t connectionId = (dcgm_connection_id_t)dcgmHandle;
+
+    if (moduleCommands.empty() || moduleCommands.size() > DCGM_MSG_MODULE_COMMAND_BATCH_MAX
+        || moduleCommands.size() != maxResponseSizes.size())
+    {
+        DCGM_LOG_ERROR << "Bad module command batch of " << moduleCommands.size() << " commands";
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgm_msg_module_command_batch_t batch {};
+    batch.numCommands = moduleCommands.size();
+
+    auto dcgmSendMsg = DcgmMessagePool::GetInstance().Get();
+    auto msgData     = dcgmSendMsg->GetMsgBytesPtr();
+    msgData->insert(msgData->end(), (char *)&batch, (char *)&batch + sizeof(batch));
+
+    for (auto const *moduleCommand : moduleCommands)
+    {
+        if (moduleCommand == nullptr)
+        {
+            return DCGM_ST_BADPARAM;
+        }
+
+        dcgm_msg_module_command_batch_entry_t entry {};
+        entry.length = moduleCommand->length;
+        msgData->insert(msgData->end(), (char *)&entry, (char *)&entry + sizeof(entry));
+        msgData->insert(msgData->end(), (char *)moduleCommand, (char *)moduleCommand + moduleCommand->length);
+        msgData->resize(msgData->size() + DCGM_MSG_MODULE_COMMAND_BATCH_PADDED(entry.length) - entry.length, 0);
+    }
+
+    if (msgData->size() > DCGM_PROTO_MAX_MESSAGE_SIZE)
+    {
+        DCGM_LOG_ERROR << "Module command batch of " << msgData->size() << " bytes is too large";
+        return DCGM_ST_BADPARAM;
+    }
+
+    dcgm_request_id_t requestId = GetNextRequestId();
+    dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND_BATCH, requestId, DCGM_ST_OK, msgData->size());
+    dcgmSendMsg->GetMessageHdr()->timeoutMs = (int)std::min(timeoutMs, (unsigned int)INT_MAX);
+
+    auto requestFut = AddBlockingRequest(connectionId, requestId);
+
+    dcgmReturn_t retSt = m_dcgmIpc.SendMessage(connectionId, std::move(dcgmSendMsg), true);
+    if (retSt != DCGM_ST_OK)
+    {
+        RemoveBlockingRequest(connectionId, requestId, retSt);
+        return retSt;
+    }
+
+    if (timeoutMs == 0)
+    {
+        requestFut.wait();
+    }
+    else if (requestFut.wait_for(std::chrono::milliseconds(timeoutMs)) != std::future_status::ready)
+    {
+        DCGM_LOG_ERROR << "connectionId " << connectionId << " batch requestId " << requestId << " timed out after "
+                       << timeoutMs << " ms.";
+        RemoveBlockingRequest(connectionId, requestId, std::nullopt);
+        SendRequestCancel(connectionId, requestId);
+        return DCGM_ST_TIMEOUT;
+    }
+
+    auto response = requestFut.get();
+    RemoveBlockingRequest(connectionId, requestId, std::nullopt);
+
+    if (response.dcgmReturn != DCGM_ST_OK)
+    {
+        return response.dcgmReturn;
+    }
+
     dcgm_message_header_t *recvHeader = response.response->GetMessageHdr();
+    auto recvBytes                    = response.response->GetMsgBytesPtr();
+
+    if (recvHeader->msgType != DCGM_MSG_MODULE_COMMAND_BATCH)
+    {
+        DCGM_LOG_ERROR << "Unexpected response type " << std::hex << recvHeader->msgType << " to module command batch.";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (recvHeader->status != DCGM_ST_OK)
+    {
+        return (dcgmReturn_t)recvHeader->status;
+    }
+
+    if (recvBytes->size() < sizeof(batch))
+    {
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    memcpy(&batch, recvBytes->data(), sizeof(batch));
+    if (batch.numCommands != moduleCommands.size())
+    {
+        DCGM_LOG_ERROR << "Module command batch response has " << batch.numCommands << " != "
+                       << moduleCommands.size() << " commands";
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    statuses.assign(moduleCommands.size(), DCGM_ST_GENERIC_ERROR);
+    size_t offset = sizeof(batch);
+
+    for (size_t i = 0; i < moduleCommands.size(); i++)
+    {
+        dcgm_msg_module_command_batch_entry_t entry {};
+        if (recvBytes->size() - offset < sizeof(entry))
+        {
+            DCGM_LOG_ERROR << "Module command batch response is truncated at entry " << i;
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        memcpy(&entry, recvBytes->data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        if (recvBytes->size() - offset < entry.length)
+        {
+            DCGM_LOG_ERROR << "Module command batch response entry " << i << " is truncated";
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        if (entry.length > maxResponseSizes[i])
+        {
+            DCGM_LOG_ERROR << "Module command response size " << entry.length << " was bigger than max allowed of "
+                           << maxResponseSizes[i];
+            statuses[i] = DCGM_ST_GENERIC_ERROR;
+        }
+        else
+        {
+            memcpy(moduleCommands[i], recvBytes->data() + offset, entry.length);
+            statuses[i] = (dcgmReturn_t)entry.status;
+        }
+
+        offset += std::min(DCGM_MSG_MODULE_COMMAND_BATCH_PADDED(entry.length), recvBytes->size() - offset);
+    }
+
+    DcgmMessagePool::GetInstance().Put(std::move(response.response));
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+std::unique_ptr<DcgmMessage> DcgmClientHandler::BuildModuleCommandMessage(
+    dcgm_module_command_header_t const *moduleCommand,
+    dcgm_request_id_t requestId,
+    unsigned int timeoutMs)
+{
+    std::unique_ptr<DcgmMessage> dcgmSendMsg = DcgmMessagePool::GetInstance().Get(moduleCommand->length);
+
+    /* Update Encoded Message with a header to be sent over socket */
+    dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, requestId, DCGM_ST_OK, moduleCommand->length);
+    dcgmSendMsg->GetMessageHdr()->timeoutMs = (int)std::min(timeoutMs, (unsigned int)INT_MAX);
+    auto msgData = dcgmSendMsg->GetMsgBytesPtr();
+    msgData->resize(moduleCommand->length);
+    memcpy(msgData->data(), moduleCommand, moduleCommand->length);
+    return dcgmSendMsg;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmClientHandler::CopyModuleCommandResponse(DcgmMessage &response,
+                                                          dcgm_module_command_header_t *moduleCommand,
+                                                          size_t maxResponseSize)
+{
+    dcgm_message_header_t *recvHeader = response.GetMessageHdr();
 
     if (recvHeader->msgType != DCGM_MSG_MODULE_COMMAND)
     {
@@ -472,15 +707,337 @@ dcgmReturn_t DcgmClientHandler::ExchangeModuleCommandAsync(dcgmHandle_t dcgmHand
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    auto msgBytes = response.response->GetMsgBytesPtr();
+    auto msgBytes = response.GetMsgBytesPtr();
     memcpy(moduleCommand, msgBytes->data(), recvHeader->length);
 
     DCGM_LOG_DEBUG << "Got module command response of length " << recvHeader->length;
 
-    /* If the request was persistent, it still exists in m_persistentReqs */
     return (dcgmReturn_t)recvHeader->status;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmClientHandler::SubmitModuleCommand(dcgmHandle_t dcgmHandle,
+                                                    dcgm_module_command_header_t const *moduleCommand,
+                                                    dcgm_request_id_t &requestId,
+                                                    DcgmClientCompletionFunc_f onComplete)
+{
+    dcgm_connection_id_t connectionId = (dcgm_connection_id_t)dcgmHandle;
+
+    if (moduleCommand == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    requestId = GetNextRequestId();
+
+    auto asyncRequest            = std::make_shared<DcgmClientAsyncRequest>();
+    asyncRequest->m_connectionId = connectionId;
+    asyncRequest->m_onComplete   = std::move(onComplete);
+    asyncRequest->m_future       = asyncRequest->m_promise.get_future();
+
+    /* Track the request before sending it since the response can come back before SendMessage() returns */
+    {
+        DcgmLockGuard dlg(&m_mutex);
+        m_asyncReqs[requestId] = asyncRequest;
+        m_connectionRequests[connectionId].insert(requestId);
+    }
+
+    dcgmReturn_t retSt = m_dcgmIpc.SendMessage(connectionId, BuildModuleCommandMessage(moduleCommand, requestId), true);
+    if (retSt != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "connectionId " << connectionId << " requestId " << requestId << " failed to send: "
+                       << errorString(retSt);
+        CancelModuleCommand(dcgmHandle, requestId);
+        return retSt;
+    }
+
+    DCGM_LOG_DEBUG << "Submitted requestId " << requestId << " on connectionId " << connectionId;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+DcgmNs::CoCallback<DcgmClientBlockingResponse_t> DcgmClientHandler::AwaitModuleCommand(
+    dcgmHandle_t dcgmHandle,
+    dcgm_module_command_header_t const *moduleCommand)
+{
+    using Complete_f = DcgmNs::CoCallback<DcgmClientBlockingResponse_t>::Complete_f;
+
+    return DcgmNs::CoCallback<DcgmClientBlockingResponse_t>([this, dcgmHandle, moduleCommand](Complete_f complete) {
+        dcgm_request_id_t requestId = 0;
+
+        dcgmReturn_t dcgmReturn = SubmitModuleCommand(
+            dcgmHandle,
+            moduleCommand,
+            requestId,
+            [complete](dcgm_request_id_t, dcgmReturn_t ret, std::unique_ptr<DcgmMessage> response) {
+                complete(DcgmClientBlockingResponse_t { ret, std::move(response) });
+            });
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            /* onComplete won't be called */
+            complete(DcgmClientBlockingResponse_t { dcgmReturn, nullptr });
+        }
+    });
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmClientHandler::PollModuleCommand(dcgmHandle_t dcgmHandle,
+                                                  dcgm_request_id_t requestId,
+                                                  dcgm_module_command_header_t *moduleCommand,
+                                                  size_t maxResponseSize,
+                                                  unsigned int timeoutMs)
+{
+    dcgm_connection_id_t connectionId = (dcgm_connection_id_t)dcgmHandle;
+    std::shared_ptr<DcgmClientAsyncRequest> asyncRequest;
+
+    {
+        DcgmLockGuard dlg(&m_mutex);
+        auto it = m_asyncReqs.find(requestId);
+        if (it == m_asyncReqs.end() || it->second->m_connectionId != connectionId || it->second->m_onComplete)
+        {
+            DCGM_LOG_ERROR << "requestId " << requestId << " is not a pollable request of connectionId "
+                           << connectionId;
+            return DCGM_ST_BADPARAM;
+        }
+        asyncRequest = it->second;
+    }
+
+    /* Wait without m_mutex so that the response can be delivered */
+    if (asyncRequest->m_future.wait_for(std::chrono::milliseconds(timeoutMs)) != std::future_status::ready)
+    {
+        return DCGM_ST_PENDING;
+    }
+
+    {
+        DcgmLockGuard dlg(&m_mutex);
+        if (m_asyncReqs.erase(requestId) == 0)
+        {
+            /* Another thread collected or cancelled it while we were waiting */
+            return DCGM_ST_BADPARAM;
+        }
+        UntrackConnectionRequest(connectionId, requestId);
+    }
+
+    auto response = asyncRequest->m_future.get();
+    if (response.dcgmReturn != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "connectionId " << connectionId << " requestId " << requestId << " returned "
+                       << errorString(response.dcgmReturn);
+        return response.dcgmReturn;
+    }
+
+    dcgmReturn_t retSt = CopyModuleCommandResponse(*response.response, moduleCommand, maxResponseSize);
+    DcgmMessagePool::GetInstance().Put(std::move(response.response));
+    return retSt;
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::CancelModuleCommand(dcgmHandle_t dcgmHandle, dcgm_request_id_t requestId)
+{
+    dcgm_connection_id_t connectionId = (dcgm_connection_id_t)dcgmHandle;
+
+    DcgmLockGuard dlg(&m_mutex);
+    auto it = m_asyncReqs.find(requestId);
+    if (it == m_asyncReqs.end() || it->second->m_connectionId != connectionId)
+    {
+        DCGM_LOG_VERBOSE << "async requestId " << requestId << " was not found.";
+        return;
+    }
+
+    /* Keep a late response from reaching the callback */
+    it->second->m_completed = true;
+    m_asyncReqs.erase(it);
+    UntrackConnectionRequest(connectionId, requestId);
+    DCGM_LOG_VERBOSE << "async requestId " << requestId << " was cancelled.";
+
+    SendRequestCancel(connectionId, requestId);
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::SendRequestCancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId)
+{
+    {
+        DcgmLockGuard dlg(&m_mutex);
+        auto it = m_connectionAttributes.find(connectionId);
+        if (it == m_connectionAttributes.end() || !it->second.m_requestCancel)
+        {
+            return;
+        }
+    }
+
+    auto dcgmSendMsg = DcgmMessagePool::GetInstance().Get();
+    dcgmSendMsg->UpdateMsgHdr(DCGM_MSG_REQUEST_CANCEL, requestId, DCGM_ST_OK, 0);
+
+    /* Best effort. The connection may already be gone */
+    m_dcgmIpc.SendMessage(connectionId, std::move(dcgmSendMsg), false);
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::UntrackConnectionRequest(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId)
+{
+    /* Don't recreate the entry of a connection that ProcessDisconnect() already cleaned up */
+    auto it = m_connectionRequests.find(connectionId);
+    if (it != m_connectionRequests.end())
+    {
+        it->second.erase(requestId);
+    }
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::DeliverAsyncResponse(dcgm_request_id_t requestId,
+                                             DcgmClientAsyncRequest &asyncRequest,
+                                             DcgmClientBlockingResponse_t response)
+{
+    if (asyncRequest.m_onComplete)
+    {
+        asyncRequest.m_onComplete(requestId, response.dcgmReturn, std::move(response.response));
+    }
+    else
+    {
+        asyncRequest.m_promise.set_value(std::move(response));
+    }
+}
+
+/*****************************************************************************/
+bool DcgmClientHandler::CompleteAsyncRequest(dcgm_request_id_t requestId, std::unique_ptr<DcgmMessage> &dcgmMessage)
+{
+    std::shared_ptr<DcgmClientAsyncRequest> asyncRequest;
+
+    {
+        DcgmLockGuard dlg(&m_mutex);
+        auto it = m_asyncReqs.find(requestId);
+        if (it == m_asyncReqs.end())
+        {
+            return false;
+        }
+
+        asyncRequest = it->second;
+        if (asyncRequest->m_completed)
+        {
+            DCGM_LOG_ERROR << "Dropping extra response to async requestId " << requestId;
+            return true;
+        }
+        asyncRequest->m_completed = true;
+
+        /* Requests with a callback are done now. The rest wait in m_asyncReqs to be polled */
+        if (asyncRequest->m_onComplete)
+        {
+            UntrackConnectionRequest(asyncRequest->m_connectionId, requestId);
+            m_asyncReqs.erase(it);
+        }
+    }
+
+    DCGM_LOG_DEBUG << "Found async request for requestId " << requestId;
+
+    DcgmClientBlockingResponse_t response;
+    response.dcgmReturn = DCGM_ST_OK;
+    response.response   = std::move(dcgmMessage);
+    DeliverAsyncResponse(requestId, *asyncRequest, std::move(response));
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::FailAsyncRequests(dcgm_connection_id_t connectionId, dcgmReturn_t dcgmReturn)
+{
+    std::vector<std::pair<dcgm_request_id_t, std::shared_ptr<DcgmClientAsyncRequest>>> failed;
+
+    {
+        DcgmLockGuard dlg(&m_mutex);
+        for (auto it = m_asyncReqs.begin(); it != m_asyncReqs.end();)
+        {
+            auto &asyncRequest = it->second;
+            if (asyncRequest->m_connectionId != connectionId || asyncRequest->m_completed)
+            {
+                ++it;
+                continue;
+            }
+
+            asyncRequest->m_completed = true;
+            failed.emplace_back(it->first, asyncRequest);
+
+            /* Polled requests stay around so that the poller gets the error */
+            if (asyncRequest->m_onComplete)
+            {
+                UntrackConnectionRequest(connectionId, it->first);
+                it = m_asyncReqs.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (auto &[requestId, asyncRequest] : failed)
+    {
+        DcgmClientBlockingResponse_t response {};
+        response.dcgmReturn = dcgmReturn;
+        DeliverAsyncResponse(requestId, *asyncRequest, std::move(response));
+    }
+
+    if (!failed.empty())
+    {
+        DCGM_LOG_DEBUG << "Failed " << failed.size() << " async requests for connectionId " << connectionId;
+    }
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::EnableMetadataCache(dcgm_connection_id_t connectionId)
+{
+    dcgm_core_msg_metadata_subscribe_t msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_METADATA_SUBSCRIBE;
+    msg.header.version    = dcgm_core_msg_metadata_subscribe_version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = ExchangeModuleCommandAsync(connectionId, &msg.header, nullptr, sizeof(msg));
+    if (dcgmReturn == DCGM_ST_OK)
+    {
+        dcgmReturn = (dcgmReturn_t)msg.cmdRet;
+    }
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        /* Host engines from before DCGM_CORE_SR_METADATA_SUBSCRIBE would never tell us to drop entries */
+        log_info("Not caching metadata for connectionId {}. Subscribing returned {}", connectionId, (int)dcgmReturn);
+        return;
+    }
+
+    log_debug("Caching metadata for connectionId {} from generation {}", connectionId, msg.generation);
+    m_metadataCache.Enable(connectionId, msg.generation);
+}
+
+/*****************************************************************************/
+void DcgmClientHandler::ProbeRequestCancel(dcgm_connection_id_t connectionId)
+{
+    dcgm_core_msg_request_cancel_support_t msg = {};
+
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_REQUEST_CANCEL_SUPPORT;
+    msg.header.version    = dcgm_core_msg_request_cancel_support_version;
+
+    // coverity[overrun-buffer-arg]
+    dcgmReturn_t dcgmReturn = ExchangeModuleCommandAsync(connectionId, &msg.header, nullptr, sizeof(msg));
+    if (dcgmReturn == DCGM_ST_OK)
+    {
+        dcgmReturn = (dcgmReturn_t)msg.cmdRet;
+    }
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_debug("Not sending request cancels to connectionId {}. Probing returned {}", connectionId, (int)dcgmReturn);
+        return;
+    }
+
+    DcgmLockGuard dlg(&m_mutex);
+    auto it = m_connectionAttributes.find(connectionId);
+    if (it != m_connectionAttributes.end())
+    {
+        it->second.m_requestCancel = true;
+    }
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmClientHandler::PopulateConnectionAttributes(dcgmHandle_t dcgmHandle)
 {
@@ -15,13 +15,17 @@
  */
 #pragma once
 
+#include "DcgmClientMetadataCache.h"
 #include "DcgmIpc.h"
 #include "DcgmMutex.h"
 #include "DcgmRequest.h"
 #include "dcgm_module_structs.h"
 #include "dcgm_structs.h"
+#include <Coroutine.hpp>
 #include <DcgmBuildInfo.hpp>
+#include <functional>
 #include <iostream>
+#include <memory>
 
 typedef struct
 {
@@ -29,6 +33,24 @@ typedef struct
     std::unique_ptr<DcgmMessage> response; /* The reply message we waited for */
 } DcgmClientBlockingResponse_t;
 
+/* Callback for a request submitted with DcgmClientHandler::SubmitModuleCommand().
+   dcgmReturn is DCGM_ST_OK if response was received. Otherwise response is null.
+   This is called from the IPC worker thread. It must not block or wait on other requests
+   from the same DcgmClientHandler, but it can submit new ones */
+typedef std::function<void(dcgm_request_id_t requestId, dcgmReturn_t dcgmReturn, std::unique_ptr<DcgmMessage> response)>
+    DcgmClientCompletionFunc_f;
+
+/* A request submitted with DcgmClientHandler::SubmitModuleCommand() */
+class DcgmClientAsyncRequest
+{
+public:
+    dcgm_connection_id_t m_connectionId = DCGM_CONNECTION_ID_NONE; /* Connection the request was sent on */
+    DcgmClientCompletionFunc_f m_onComplete; /* Called with the response. Empty = keep it for PollModuleCommand() */
+    bool m_completed = false;                /* Has the response or an error been delivered yet? */
+    std::promise<DcgmClientBlockingResponse_t> m_promise; /* Set once completed if m_onComplete is empty */
+    std::future<DcgmClientBlockingResponse_t> m_future;   /* Future of m_promise */
+};
+
 /* Attributes of each client connection of the DcgmClientHandler */
 class DCHConnectionAttributes
 {
@@ -38,6 +60,7 @@ public:
     {}
 
     DcgmNs::DcgmBuildInfo m_buildInfo; /* Build info retrieved from the server */
+    bool m_requestCancel = false;      /* Does the server act on DCGM_MSG_REQUEST_CANCEL? */
 };
 
 class DcgmClientHandler
@@ -52,11 +75,18 @@ public:
     /*****************************************************************************
      * This method is used to get Connection to the host engine corresponding to
      * the IP address
+     *
+     * compressMinBytes: Offer to compress message bodies of at least this many
+     *                   bytes on TCP connections. 0 = don't
+     * metadataCache:    Cache responses to metadata requests if the host engine
+     *                   notifies us of changes. See DcgmClientMetadataCache
      *****************************************************************************/
     dcgmReturn_t GetConnHandleForHostEngine(const char *identifier,
                                             dcgmHandle_t *pDcgmHandle,
                                             unsigned int timeoutMs,
-                                            bool addressIsUnixSocket);
+                                            bool addressIsUnixSocket,
+                                            unsigned int compressMinBytes = 0,
+                                            bool metadataCache            = false);
 
     /*****************************************************************************
      * This method is used to close connection with the Host Engine
@@ -73,6 +103,102 @@ public:
                                             size_t maxResponseSize,
                                             unsigned int timeoutMs = 60000);
 
+    /*****************************************************************************
+     * Send several module commands to the host engine as one message. The host
+     * engine processes them in order in one task and replies once, saving a
+     * round trip and a worker hand-off per command. Host engines that predate
+     * DCGM_MSG_MODULE_COMMAND_BATCH don't reply, so this times out against them.
+     *
+     * dcgmHandle        IN: Connection to send the batch on
+     * moduleCommands IN/OUT: Requests to send. Each is overwritten by its response
+     * maxResponseSizes  IN: Size of the buffer of each entry of moduleCommands
+     * statuses         OUT: Status of each module command
+     * timeoutMs         IN: How long to wait for the whole batch. 0 = forever
+     *
+     * Returns DCGM_ST_OK if the batch was processed. Check statuses for the
+     *         result of each module command
+     *         Other DCGM_ST_? if the batch itself failed
+     *****************************************************************************/
+    dcgmReturn_t ExchangeModuleCommandBatch(dcgmHandle_t dcgmHandle,
+                                            std::vector<dcgm_module_command_header_t *> const &moduleCommands,
+                                            std::vector<size_t> const &maxResponseSizes,
+                                            std::vector<dcgmReturn_t> &statuses,
+                                            unsigned int timeoutMs = 60000);
+
+    /*****************************************************************************
+     * Send a module command without waiting for its response so that many
+     * requests can be in flight on a connection at once. Responses are matched
+     * to requests by requestId like they are for ExchangeModuleCommandAsync().
+     *
+     * dcgmHandle     IN: Connection to send the request on
+     * moduleCommand  IN: Request to send. This is copied before returning
+     * requestId     OUT: ID of the request. Pass this to PollModuleCommand()
+     * onComplete     IN: Called once the response arrives or the connection is lost.
+     *                    Pass an empty function to collect it with PollModuleCommand()
+     *
+     * Returns DCGM_ST_OK if the request was sent
+     *         Other DCGM_ST_? on error. onComplete is not called in this case
+     *****************************************************************************/
+    dcgmReturn_t SubmitModuleCommand(dcgmHandle_t dcgmHandle,
+                                     dcgm_module_command_header_t const *moduleCommand,
+                                     dcgm_request_id_t &requestId,
+                                     DcgmClientCompletionFunc_f onComplete = nullptr);
+
+    /*****************************************************************************
+     * Send a module command from a DcgmNs::CoTask coroutine and suspend it until
+     * the response arrives, instead of blocking its thread:
+     *
+     *     auto response = co_await handler.AwaitModuleCommand(dcgmHandle, &cmd.header);
+     *
+     * moduleCommand is copied when the co_await starts, so it only has to stay
+     * valid until then.
+     *
+     * The result has dcgmReturn set to the error and no response if the request
+     * couldn't be sent or the connection was lost
+     *****************************************************************************/
+    DcgmNs::CoCallback<DcgmClientBlockingResponse_t> AwaitModuleCommand(
+        dcgmHandle_t dcgmHandle,
+        dcgm_module_command_header_t const *moduleCommand);
+
+    /*****************************************************************************
+     * Collect the response of a request submitted with SubmitModuleCommand()
+     * without a completion callback. The request is forgotten once this returns
+     * anything other than DCGM_ST_PENDING.
+     *
+     * dcgmHandle       IN: Connection the request was submitted on
+     * requestId        IN: ID returned by SubmitModuleCommand()
+     * moduleCommand   OUT: Where to copy the response to
+     * maxResponseSize  IN: Size of the buffer at moduleCommand
+     * timeoutMs        IN: How long to wait for the response. 0 = just check
+     *
+     * Returns DCGM_ST_PENDING if the response hasn't arrived yet
+     *         DCGM_ST_BADPARAM if requestId isn't a pollable request of dcgmHandle
+     *         Otherwise the same as ExchangeModuleCommandAsync()
+     *****************************************************************************/
+    dcgmReturn_t PollModuleCommand(dcgmHandle_t dcgmHandle,
+                                   dcgm_request_id_t requestId,
+                                   dcgm_module_command_header_t *moduleCommand,
+                                   size_t maxResponseSize,
+                                   unsigned int timeoutMs = 0);
+
+    /*****************************************************************************
+     * Forget about a request submitted with SubmitModuleCommand(). Its response
+     * is dropped if it still arrives and its callback isn't called.
+     *****************************************************************************/
+    void CancelModuleCommand(dcgmHandle_t dcgmHandle, dcgm_request_id_t requestId);
+
+    /*****************************************************************************
+     * Copy the response of a module command to moduleCommand, checking that it
+     * is a module command and fits in maxResponseSize. Completion callbacks of
+     * SubmitModuleCommand() can use this to decode their response.
+     *
+     * Returns the status of the module command on the host engine
+     *         Other DCGM_ST_? if the response is not valid
+     *****************************************************************************/
+    static dcgmReturn_t CopyModuleCommandResponse(DcgmMessage &response,
+                                                  dcgm_module_command_header_t *moduleCommand,
+                                                  size_t maxResponseSize);
+
 private:
     DcgmIpc m_dcgmIpc;
     std::atomic<dcgm_request_id_t> m_requestId = DCGM_REQUEST_ID_NONE;
@@ -86,6 +212,10 @@ private:
        Protected by m_mutex */
     std::unordered_map<dcgm_request_id_t, std::unique_ptr<DcgmRequest>> m_persistentReqs;
 
+    /* Requests submitted with SubmitModuleCommand() that haven't been collected yet.
+       Protected by m_mutex */
+    std::unordered_map<dcgm_request_id_t, std::shared_ptr<DcgmClientAsyncRequest>> m_asyncReqs;
+
     /* A map of connectionId-> set of requestIds. This is here so we can delete outstanding
         m_blockingReqs and m_persistentReqs entries when a client unexpectedly disconnects.
         Protected by m_mutex */
@@ -94,11 +224,15 @@ private:
     /* A map of connectionId -> attributes for each connection */
     std::unordered_map<dcgm_connection_id_t, DCHConnectionAttributes> m_connectionAttributes;
 
+    /* Cached metadata of the connections that asked for it. Has its own lock */
+    DcgmClientMetadataCache m_metadataCache;
+
     dcgmReturn_t TryConnectingToHostEngine(char identifier[],
                                            unsigned int portNumber,
                                            dcgmHandle_t *pDcgmHandle,
                                            bool addressIsUnixSocket,
-                                           int connectionTimeoutMs);
+                                           int connectionTimeoutMs,
+                                           unsigned int compressMinBytes);
 
     /*************************************************************************/
     /* Callback functions for DcgmIpc to call */
@@ -120,6 +254,18 @@ private:
      */
     dcgmReturn_t PopulateConnectionAttributes(dcgmHandle_t dcgmHandle);
 
+    /*************************************************************************/
+    /* Subscribe to metadata changes of a newly established connection and
+     * cache its metadata if the host engine supports it
+     */
+    void EnableMetadataCache(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /* Ask the host engine of a newly established connection whether it acts
+     * on DCGM_MSG_REQUEST_CANCEL and note it in m_connectionAttributes
+     */
+    void ProbeRequestCancel(dcgm_connection_id_t connectionId);
+
     /*************************************************************************/
 
     /* Get the next request ID to use for a client request */
@@ -135,4 +281,26 @@ private:
     /* Helpers for manipulating m_persistentReqs */
     void AddPersistentRequest(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmRequest> request);
     void RemovePersistentRequest(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
+
+    /* Helpers for manipulating m_asyncReqs. These take m_mutex themselves and call completion
+       callbacks without holding it. CompleteAsyncRequest() returns false if requestId is not an
+       async request, leaving dcgmMessage alone */
+    bool CompleteAsyncRequest(dcgm_request_id_t requestId, std::unique_ptr<DcgmMessage> &dcgmMessage);
+    void FailAsyncRequests(dcgm_connection_id_t connectionId, dcgmReturn_t dcgmReturn);
+    static void DeliverAsyncResponse(dcgm_request_id_t requestId,
+                                     DcgmClientAsyncRequest &asyncRequest,
+                                     DcgmClientBlockingResponse_t response);
+
+    /* Remove requestId from m_connectionRequests. Caller must hold m_mutex */
+    void UntrackConnectionRequest(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
+
+    /* Build the message that carries moduleCommand to the host engine. timeoutMs is how long we'll wait for the
+       response. 0 = forever */
+    static std::unique_ptr<DcgmMessage> BuildModuleCommandMessage(dcgm_module_command_header_t const *moduleCommand,
+                                                                  dcgm_request_id_t requestId,
+                                                                  unsigned int timeoutMs = 0);
+
+    /* Tell the host engine that we no longer wait for the response to requestId so that it can drop or stop it.
+       Nothing is sent to host engines that predate DCGM_MSG_REQUEST_CANCEL. They would log an error for it */
+    void SendRequestCancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
 };
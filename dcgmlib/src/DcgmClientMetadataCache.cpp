@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmClientMetadataCache.h"
+
+#include <DcgmLogging.h>
+#include <DcgmProtocol.h>
+#include <dcgm_core_structs.h>
+
+#include <cstring>
+
+/*****************************************************************************/
+bool DcgmClientMetadataCache::IsCacheable(dcgm_module_command_header_t const &moduleCommand)
+{
+    if (moduleCommand.moduleId != DcgmModuleIdCore)
+    {
+        return false;
+    }
+
+    switch (moduleCommand.subCommand)
+    {
+        case DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES:
+        case DCGM_CORE_SR_GROUP_GET_ALL_IDS:
+        case DCGM_CORE_SR_GROUP_GET_INFO:
+        case DCGM_CORE_SR_GET_TOPOLOGY:
+        case DCGM_CORE_SR_GET_TOPOLOGY_AFFINITY:
+        case DCGM_CORE_SR_GET_ALL_DEVICES:
+        case DCGM_CORE_SR_FIELDGROUP_GET_INFO:
+        case DCGM_CORE_SR_FIELDGROUP_GET_ALL:
+        case DCGM_CORE_SR_GET_GPU_INSTANCE_HIERARCHY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************/
+std::string DcgmClientMetadataCache::MakeKey(dcgm_module_command_header_t const &moduleCommand)
+{
+    std::string key(reinterpret_cast<char const *>(&moduleCommand), moduleCommand.length);
+
+    /* The same request is sent with a different requestId each time */
+    auto *header         = reinterpret_cast<dcgm_module_command_header_t *>(key.data());
+    header->connectionId = DCGM_CONNECTION_ID_NONE;
+    header->requestId    = DCGM_REQUEST_ID_NONE;
+    return key;
+}
+
+/*****************************************************************************/
+void DcgmClientMetadataCache::Enable(dcgm_connection_id_t connectionId, unsigned long long generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_connections[connectionId] = Connection { generation, {} };
+}
+
+/*****************************************************************************/
+void DcgmClientMetadataCache::Remove(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_connections.erase(connectionId);
+}
+
+/*****************************************************************************/
+bool DcgmClientMetadataCache::IsEnabled(dcgm_connection_id_t connectionId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_connections.contains(connectionId);
+}
+
+/*****************************************************************************/
+void DcgmClientMetadataCache::SetGeneration(dcgm_connection_id_t connectionId, unsigned long long generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_connections.find(connectionId);
+    if (it == m_connections.end() || generation <= it->second.generation)
+    {
+        return;
+    }
+
+    log_debug("connectionId {} dropped {} metadata entries for generation {}",
+              connectionId,
+              it->second.entries.size(),
+              generation);
+    it->second.generation = generation;
+    it->second.entries.clear();
+}
+
+/*****************************************************************************/
+bool DcgmClientMetadataCache::Lookup(dcgm_connection_id_t connectionId,
+                                     std::string const &key,
+                                     dcgm_module_command_header_t *moduleCommand,
+                                     size_t maxResponseSize,
+                                     unsigned long long &generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    generation = 0;
+
+    auto connectionIt = m_connections.find(connectionId);
+    if (connectionIt == m_connections.end())
+    {
+        return false;
+    }
+
+    generation = connectionIt->second.generation;
+
+    auto entryIt = connectionIt->second.entries.find(key);
+    if (entryIt == connectionIt->second.entries.end() || entryIt->second.size() > maxResponseSize)
+    {
+        return false;
+    }
+
+    memcpy(moduleCommand, entryIt->second.data(), entryIt->second.size());
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmClientMetadataCache::Store(dcgm_connection_id_t connectionId,
+                                    unsigned long long generation,
+                                    std::string key,
+                                    dcgm_module_command_header_t const *response)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_connections.find(connectionId);
+    if (it == m_connections.end() || it->second.generation != generation)
+    {
+        /* Metadata changed while the request was in flight. The response may be from before the change */
+        return;
+    }
+
+    if (it->second.entries.size() >= c_maxEntries)
+    {
+        it->second.entries.clear();
+    }
+
+    auto const *bytes = reinterpret_cast<char const *>(response);
+    it->second.entries.insert_or_assign(std::move(key), std::vector<char>(bytes, bytes + response->length));
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_module_structs.h"
+#include "dcgm_structs.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Responses of module commands that only change when groups, field groups,
+ * MIG instances or the topology do, cached per connection by the client.
+ *
+ * Each connection that enables the cache tracks the metadata generation of its
+ * host engine, which the host engine pushes to it with DCGM_MSG_METADATA_NOTIFY.
+ * Every entry of a connection is dropped when its generation changes. A
+ * response is only stored if the generation didn't change while its request
+ * was in flight, so an entry never predates the generation it is kept under.
+ *
+ * Changes made by other clients are seen once their notification arrives.
+ * Changes made on the same connection are seen right away since the host
+ * engine sends the notification before the response of the change.
+ */
+class DcgmClientMetadataCache
+{
+public:
+    /* A connection that caches more responses than this starts over */
+    static constexpr size_t c_maxEntries = 1024;
+
+    /*************************************************************************/
+    /*
+     * RETURNS: Whether the response to moduleCommand may be cached
+     */
+    static bool IsCacheable(dcgm_module_command_header_t const &moduleCommand);
+
+    /*************************************************************************/
+    /*
+     * RETURNS: Key of moduleCommand. This is the request without the fields that differ between calls
+     */
+    static std::string MakeKey(dcgm_module_command_header_t const &moduleCommand);
+
+    /*************************************************************************/
+    /*
+     * Start caching responses of connectionId, whose host engine is at generation
+     */
+    void Enable(dcgm_connection_id_t connectionId, unsigned long long generation);
+
+    /*************************************************************************/
+    /*
+     * Stop caching responses of connectionId and drop its entries
+     */
+    void Remove(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    bool IsEnabled(dcgm_connection_id_t connectionId) const;
+
+    /*************************************************************************/
+    /*
+     * Note that the host engine of connectionId is at generation. Entries are dropped if
+     * it is newer than the generation we had. Older generations are ignored since
+     * notifications can arrive after the response that already reported a newer one
+     */
+    void SetGeneration(dcgm_connection_id_t connectionId, unsigned long long generation);
+
+    /*************************************************************************/
+    /*
+     * Copy the cached response of key to moduleCommand.
+     *
+     * generation OUT: Generation to pass to Store() on a miss. 0 if connectionId doesn't cache
+     *
+     * RETURNS: true if there was a response of at most maxResponseSize bytes
+     *          false otherwise. moduleCommand is left alone
+     */
+    bool Lookup(dcgm_connection_id_t connectionId,
+                std::string const &key,
+                dcgm_module_command_header_t *moduleCommand,
+                size_t maxResponseSize,
+                unsigned long long &generation);
+
+    /*************************************************************************/
+    /*
+     * Cache response as the response of key if connectionId is still at generation
+     */
+    void Store(dcgm_connection_id_t connectionId,
+               unsigned long long generation,
+               std::string key,
+               dcgm_module_command_header_t const *response);
+
+private:
+    struct Connection
+    {
+        unsigned long long generation;
+        std::unordered_map<std::string, std::vector<char>> entries; /* Key -> response */
+    };
+
+    mutable std::mutex m_mutex; /* Protects m_connections */
+    std::unordered_map<dcgm_connection_id_t, Connection> m_connections;
+};
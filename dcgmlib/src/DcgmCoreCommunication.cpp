@@ -15,14 +15,19 @@
  */
 #include <chrono>
 #include <fmt/format.h>
+#include <algorithm>
+#include <limits>
 #include <mutex>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include <dcgm_module_structs.h>
 
 #include "DcgmCoreCommunication.h"
 #include "DcgmHostEngineHandler.h"
 #include "DcgmModule.h"
+#include "DcgmStringHelpers.h"
 #include "dcgm_core_communication.h"
 #include "dcgm_nvswitch_structs.h"
 #include "dcgm_structs.h"
@@ -49,6 +54,124 @@ bool DcgmCoreCommunication::IsInitialized() const
     return m_cacheManagerPtr != nullptr && m_groupManagerPtr != nullptr;
 }
 
+dcgmCoreDirectInterface_t const *DcgmCoreCommunication::GetDirectInterface() const
+{
+    return &m_direct;
+}
+
+dcgmReturn_t DcgmCoreCommunication::DirectGetLatestSample(void *context,
+                                                          dcgm_field_entity_group_t entityGroupId,
+                                                          dcgm_field_eid_t entityId,
+                                                          unsigned short fieldId,
+                                                          dcgmcm_sample_p sample,
+                                                          DcgmFvBuffer *fvBuffer)
+{
+    auto const *self = static_cast<DcgmCoreCommunication const *>(context);
+    if (self == nullptr || !self->IsInitialized())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    return self->m_cacheManagerPtr->GetLatestSample(entityGroupId, entityId, fieldId, sample, fvBuffer);
+}
+
+dcgmReturn_t DcgmCoreCommunication::DirectGetSamples(void *context,
+                                                     dcgm_field_entity_group_t entityGroupId,
+                                                     dcgm_field_eid_t entityId,
+                                                     unsigned short fieldId,
+                                                     std::span<dcgmcm_sample_t> samples,
+                                                     int *numSamples,
+                                                     timelib64_t startTime,
+                                                     timelib64_t endTime,
+                                                     dcgmOrder_t order)
+{
+    auto const *self = static_cast<DcgmCoreCommunication const *>(context);
+    if (self == nullptr || !self->IsInitialized())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    if (numSamples == nullptr || samples.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    *numSamples = static_cast<int>(samples.size());
+    return self->m_cacheManagerPtr->GetSamples(
+        entityGroupId, entityId, fieldId, samples.data(), numSamples, startTime, endTime, order, nullptr);
+}
+
+dcgmReturn_t DcgmCoreCommunication::DirectGetInt64SummaryData(void *context,
+                                                              dcgm_field_entity_group_t entityGroupId,
+                                                              dcgm_field_eid_t entityId,
+                                                              unsigned short fieldId,
+                                                              std::span<DcgmcmSummaryType_t const> summaryTypes,
+                                                              std::span<long long> summaryValues,
+                                                              timelib64_t startTime,
+                                                              timelib64_t endTime,
+                                                              pfUseEntryForSummary useEntryCB,
+                                                              void *userData)
+{
+    auto const *self = static_cast<DcgmCoreCommunication const *>(context);
+    if (self == nullptr || !self->IsInitialized())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    if (summaryValues.size() < summaryTypes.size() || summaryTypes.size() > DcgmcmSummaryTypeSize)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* The cache manager takes the summary types as non-const but only reads them */
+    return self->m_cacheManagerPtr->GetInt64SummaryData(entityGroupId,
+                                                        entityId,
+                                                        fieldId,
+                                                        static_cast<int>(summaryTypes.size()),
+                                                        const_cast<DcgmcmSummaryType_t *>(summaryTypes.data()),
+                                                        summaryValues.data(),
+                                                        startTime,
+                                                        endTime,
+                                                        useEntryCB,
+                                                        userData);
+}
+
+dcgmReturn_t DcgmCoreCommunication::DirectGetMultipleLatestLiveSamples(void *context,
+                                                                       std::span<dcgmGroupEntityPair_t const> entities,
+                                                                       std::span<unsigned short const> fieldIds,
+                                                                       DcgmFvBuffer *fvBuffer)
+{
+    auto const *self = static_cast<DcgmCoreCommunication const *>(context);
+    if (self == nullptr || !self->IsInitialized())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    if (fvBuffer == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::vector<dcgmGroupEntityPair_t> entityList(entities.begin(), entities.end());
+    std::vector<unsigned short> fieldIdList(fieldIds.begin(), fieldIds.end());
+
+    /* Fill the caller's buffer directly. There is no response buffer to page the values through */
+    return self->m_cacheManagerPtr->GetMultipleLatestLiveSamples(entityList, fieldIdList, fvBuffer);
+}
+
+dcgmReturn_t DcgmCoreCommunication::DirectGetGpuInventory(void *context,
+                                                          std::shared_ptr<DcgmGpuInventorySnapshot const> &inventory)
+{
+    auto const *self = static_cast<DcgmCoreCommunication const *>(context);
+    if (self == nullptr || !self->IsInitialized())
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    inventory = self->m_cacheManagerPtr->GetGpuInventory();
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmCoreCommunication::ProcessGetGpuIds(dcgm_module_command_header_t *header)
 {
     dcgmCoreGetGpuList_t cgg;
@@ -492,7 +615,6 @@ dcgmReturn_t DcgmCoreCommunication::ProcessRemoveFieldWatch(dcgm_module_command_
 
 dcgmReturn_t DcgmCoreCommunication::ProcessGetAllGpuInfo(dcgm_module_command_header_t *header)
 {
-    std::vector<dcgmcm_gpu_info_cached_t> gpuInfo;
     dcgmCoreQueryGpuInfo_t ginfo;
 
     if (header == nullptr)
@@ -509,14 +631,11 @@ dcgmReturn_t DcgmCoreCommunication::ProcessGetAllGpuInfo(dcgm_module_command_hea
 
     memcpy(&ginfo, header, sizeof(ginfo));
 
-    ginfo.response.ret = m_cacheManagerPtr->GetAllGpuInfo(gpuInfo);
+    auto const inventory = m_cacheManagerPtr->GetGpuInventory();
 
-    for (unsigned int i = 0; i < gpuInfo.size(); i++)
-    {
-        ginfo.response.info[i] = gpuInfo[i];
-    }
-
-    ginfo.response.infoCount = gpuInfo.size();
+    std::copy(inventory->gpus.begin(), inventory->gpus.end(), ginfo.response.info);
+    ginfo.response.ret       = DCGM_ST_OK;
+    ginfo.response.infoCount = inventory->gpus.size();
 
     memcpy(header, &ginfo, sizeof(ginfo));
 
@@ -540,10 +659,9 @@ dcgmReturn_t DcgmCoreCommunication::ProcessAppendSamples(dcgm_module_command_hea
     }
 
     memcpy(&as, header, sizeof(as));
-    DcgmFvBuffer fvbuf;
-    fvbuf.SetFromBuffer(as.request.buffer, as.request.bufferSize);
 
-    as.ret = m_cacheManagerPtr->AppendSamples(&fvbuf);
+    /* Modules are in-process and wait for this call, so their buffer is read in place rather than copied */
+    as.ret = m_cacheManagerPtr->AppendSamples(as.request.buffer, as.request.bufferSize);
     memcpy(header, &as, sizeof(as));
 
     return DCGM_ST_OK;
@@ -1109,6 +1227,184 @@ dcgmReturn_t DcgmCoreCommunication::ProcessGetGpuInstanceHierarchy(dcgm_module_c
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmCoreCommunication::ProcessGetCompressedSampleBytes(dcgm_module_command_header_t *header)
+{
+    if (header == nullptr || header->length != sizeof(dcgmCoreGetCompressedSampleBytes_t))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreGetCompressedSampleBytes_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    auto *query                           = reinterpret_cast<dcgmCoreGetCompressedSampleBytes_t *>(header);
+    query->response.compressedSampleBytes = m_cacheManagerPtr->GetCompressedSampleBytes();
+    query->response.ret                   = DCGM_ST_OK;
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmCoreCommunication::ProcessGetFieldCosts(dcgm_module_command_header_t *header)
+{
+    if (header == nullptr || header->length != sizeof(dcgmCoreGetFieldCosts_t))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreGetFieldCosts_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    auto *query         = reinterpret_cast<dcgmCoreGetFieldCosts_t *>(header);
+    query->response.ret = m_cacheManagerPtr->GetFieldCosts(query->response.fieldCosts);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmCoreCommunication::ProcessGetLockProfile(dcgm_module_command_header_t *header)
+{
+    if (header == nullptr || header->length != sizeof(dcgmCoreGetLockProfile_t))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreGetLockProfile_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    auto *query                                           = reinterpret_cast<dcgmCoreGetLockProfile_t *>(header);
+    dcgmIntrospectLockProfile_v1 &out                     = query->response.lockProfile;
+    std::vector<dcgm_mutex_site_profile_t> const profiles = DcgmMutex::GetProfiles();
+
+    out.version       = dcgmIntrospectLockProfile_version1;
+    out.numSitesTotal = profiles.size();
+    out.numSites      = std::min<size_t>(profiles.size(), DCGM_INTROSPECT_MAX_LOCK_SITES);
+
+    for (unsigned int i = 0; i < out.numSites; i++)
+    {
+        dcgm_mutex_site_profile_t const &profile = profiles[i];
+        dcgmIntrospectLockSite_v1 &site          = out.sites[i];
+
+        /* Keep the end of long paths. It's the part that tells sites apart */
+        std::string_view file(profile.file);
+        if (file.size() >= sizeof(site.file))
+        {
+            file.remove_prefix(file.size() - sizeof(site.file) + 1);
+        }
+        SafeCopyTo(site.file, std::string(file).c_str());
+        SafeCopyTo(site.mutexName, profile.mutexName.c_str());
+
+        site.line            = profile.line;
+        site.lockCount       = profile.lockCount;
+        site.sharedLockCount = profile.sharedLockCount;
+        site.waitUsec        = profile.waitUsec;
+        site.holdUsec        = profile.holdUsec;
+        site.maxWaitUsec     = profile.maxWaitUsec;
+        site.maxHoldUsec     = profile.maxHoldUsec;
+        for (unsigned int bucket = 0; bucket < DCGM_INTROSPECT_LOCK_HIST_BUCKETS; bucket++)
+        {
+            site.waitHistogram[bucket] = (unsigned int)profile.waitHistogram[bucket];
+            site.holdHistogram[bucket] = (unsigned int)profile.holdHistogram[bucket];
+        }
+    }
+
+    query->response.ret = DCGM_ST_OK;
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmCoreCommunication::ProcessSetNvSwitchLinkStatus(dcgm_module_command_header_t *header)
+{
+    if (header == nullptr || header->length != sizeof(dcgmCoreSetNvSwitchLinkStatus_t))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreSetNvSwitchLinkStatus_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    auto *query = reinterpret_cast<dcgmCoreSetNvSwitchLinkStatus_t *>(header);
+    query->response.ret
+        = m_cacheManagerPtr->SetNvSwitchLinkStatus(DCGM_ST_OK, query->request.numNvSwitches, query->request.nvSwitches);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmCoreCommunication::ProcessSetEntityStatuses(dcgm_module_command_header_t *header)
+{
+    if (header == nullptr || header->length != sizeof(dcgmCoreSetEntityStatuses_t))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreSetEntityStatuses_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    auto *query = reinterpret_cast<dcgmCoreSetEntityStatuses_t *>(header);
+    if (query->request.numEntities > std::size(query->request.entities))
+    {
+        query->response.ret = DCGM_ST_BADPARAM;
+        return DCGM_ST_OK;
+    }
+
+    std::vector<DcgmEntityStatusTable::Entry> entries;
+    entries.reserve(query->request.numEntities);
+    for (unsigned int i = 0; i < query->request.numEntities; i++)
+    {
+        entries.push_back({ query->request.entities[i].entityId, query->request.entities[i].status });
+    }
+    query->response.ret = m_cacheManagerPtr->SetEntityStatuses(query->request.entityGroupId, entries);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmCoreCommunication::ProcessGetRuntimeStats(dcgm_module_command_header_t *header)
+{
+    if (header == nullptr || header->length != sizeof(dcgmCoreGetRuntimeStats_t))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (auto const ret = DcgmModule::CheckVersion(header, dcgmCoreGetRuntimeStats_version1); ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    dcgmcm_runtime_stats_t stats;
+    m_cacheManagerPtr->GetRuntimeStats(&stats);
+
+    auto *query                        = reinterpret_cast<dcgmCoreGetRuntimeStats_t *>(header);
+    dcgmIntrospectRuntimeStats_v1 &out = query->response.runtimeStats;
+
+    out                       = {};
+    out.version               = dcgmIntrospectRuntimeStats_version1;
+    out.updateCycles          = stats.updateCycleFinished.load(std::memory_order_relaxed);
+    out.awakeTimeUsec         = stats.awakeTimeUsec;
+    out.sleepTimeUsec         = stats.sleepTimeUsec;
+    out.numSleepsDone         = stats.numSleepsDone;
+    out.numSleepsSkipped      = stats.numSleepsSkipped;
+    out.updatesCoalesced      = stats.updatesCoalesced;
+    out.lockCount             = stats.lockCount;
+    out.lockContendedCount    = stats.lockContendedCount;
+    out.lockContendedWaitUsec = stats.lockContendedWaitUsec;
+    out.latestValueHits       = stats.latestValueHits;
+    out.latestValueMisses     = stats.latestValueMisses;
+    out.latestValueContended  = stats.latestValueContended;
+    out.compressedSampleBytes = stats.compressedSampleBytes;
+    out.arenaReservedBytes    = stats.arenaReservedBytes;
+    out.arenaLiveBytes        = stats.arenaLiveBytes;
+
+    query->response.ret = DCGM_ST_OK;
+    return DCGM_ST_OK;
+}
+
 dcgmReturn_t DcgmCoreCommunication::ProcessRequestInCore(dcgm_module_command_header_t *header)
 {
     dcgmReturn_t ret = DCGM_ST_OK;
@@ -1311,6 +1607,42 @@ dcgmReturn_t DcgmCoreCommunication::ProcessRequestInCore(dcgm_module_command_hea
             break;
         }
 
+        case DcgmCoreReqIdCMGetCompressedSampleBytes:
+        {
+            ret = ProcessGetCompressedSampleBytes(header);
+            break;
+        }
+
+        case DcgmCoreReqIdCMGetFieldCosts:
+        {
+            ret = ProcessGetFieldCosts(header);
+            break;
+        }
+
+        case DcgmCoreReqIdGetLockProfile:
+        {
+            ret = ProcessGetLockProfile(header);
+            break;
+        }
+
+        case DcgmCoreReqIdCMSetNvSwitchLinkStatus:
+        {
+            ret = ProcessSetNvSwitchLinkStatus(header);
+            break;
+        }
+
+        case DcgmCoreReqIdCMGetRuntimeStats:
+        {
+            ret = ProcessGetRuntimeStats(header);
+            break;
+        }
+
+        case DcgmCoreReqIdCMSetEntityStatuses:
+        {
+            ret = ProcessSetEntityStatuses(header);
+            break;
+        }
+
         default:
             DCGM_LOG_DEBUG << "Unhandled sub command " << header->subCommand << " received and ignored.";
             break;
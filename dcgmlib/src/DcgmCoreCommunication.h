@@ -38,6 +38,13 @@ public:
         , m_groupManagerPtr(nullptr)
         , m_fvBufferCache(nullptr)
         , m_fvbufferCacheSize(0)
+        , m_direct { dcgmCoreDirectInterface_version,
+                     this,
+                     DirectGetLatestSample,
+                     DirectGetSamples,
+                     DirectGetInt64SummaryData,
+                     DirectGetMultipleLatestLiveSamples,
+                     DirectGetGpuInventory }
     {}
 
     ~DcgmCoreCommunication()
@@ -62,6 +69,12 @@ public:
      */
     dcgmReturn_t ProcessRequestInCore(dcgm_module_command_header_t *header);
 
+    /**
+     * @return The typed interface that in-process modules call instead of posting the hottest requests.
+     *         Valid for the lifetime of this object.
+     */
+    dcgmCoreDirectInterface_t const *GetDirectInterface() const;
+
 private:
     DcgmCacheManager *m_cacheManagerPtr; // Owned elsewhere, not freed. Used to process API requests
     DcgmGroupManager *m_groupManagerPtr; // Owned elsewhere, not freed. Used to process API requests
@@ -72,6 +85,8 @@ private:
     char *m_fvBufferCache;
     size_t m_fvbufferCacheSize;
 
+    dcgmCoreDirectInterface_t m_direct;
+
     /**
      * Methods for handling each core module API call
      */
@@ -114,6 +129,47 @@ private:
     dcgmReturn_t ProcessGetMigIndicesForEntity(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGetServiceAccount(dcgm_module_command_header_t *header);
     dcgmReturn_t ProcessGetGpuInstanceHierarchy(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessGetCompressedSampleBytes(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessGetFieldCosts(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessGetLockProfile(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessSetNvSwitchLinkStatus(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessGetRuntimeStats(dcgm_module_command_header_t *header);
+    dcgmReturn_t ProcessSetEntityStatuses(dcgm_module_command_header_t *header);
+
+    /**
+     * Entries of m_direct. context is the DcgmCoreCommunication that owns the table
+     */
+    static dcgmReturn_t DirectGetLatestSample(void *context,
+                                              dcgm_field_entity_group_t entityGroupId,
+                                              dcgm_field_eid_t entityId,
+                                              unsigned short fieldId,
+                                              dcgmcm_sample_p sample,
+                                              DcgmFvBuffer *fvBuffer);
+    static dcgmReturn_t DirectGetSamples(void *context,
+                                         dcgm_field_entity_group_t entityGroupId,
+                                         dcgm_field_eid_t entityId,
+                                         unsigned short fieldId,
+                                         std::span<dcgmcm_sample_t> samples,
+                                         int *numSamples,
+                                         timelib64_t startTime,
+                                         timelib64_t endTime,
+                                         dcgmOrder_t order);
+    static dcgmReturn_t DirectGetInt64SummaryData(void *context,
+                                                  dcgm_field_entity_group_t entityGroupId,
+                                                  dcgm_field_eid_t entityId,
+                                                  unsigned short fieldId,
+                                                  std::span<DcgmcmSummaryType_t const> summaryTypes,
+                                                  std::span<long long> summaryValues,
+                                                  timelib64_t startTime,
+                                                  timelib64_t endTime,
+                                                  pfUseEntryForSummary useEntryCB,
+                                                  void *userData);
+    static dcgmReturn_t DirectGetMultipleLatestLiveSamples(void *context,
+                                                           std::span<dcgmGroupEntityPair_t const> entities,
+                                                           std::span<unsigned short const> fieldIds,
+                                                           DcgmFvBuffer *fvBuffer);
+    static dcgmReturn_t DirectGetGpuInventory(void *context,
+                                              std::shared_ptr<DcgmGpuInventorySnapshot const> &inventory);
 };
 
 #endif
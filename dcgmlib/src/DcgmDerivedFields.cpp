@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmDerivedFields.h"
+
+#include <dcgm_fields.h>
+
+#include <array>
+#include <vector>
+
+namespace
+{
+constexpr std::array<DcgmDerivedFieldDef, 12> c_derivedFields { {
+    { DCGM_FI_DEV_POWER_USAGE_PERCENT,
+      DcgmDerivedOp::Ratio,
+      { DCGM_FI_DEV_POWER_USAGE, DCGM_FI_DEV_ENFORCED_POWER_LIMIT },
+      100.0,
+      0 },
+    { DCGM_FI_DEV_PCIE_REPLAY_RATE, DcgmDerivedOp::Rate, { DCGM_FI_DEV_PCIE_REPLAY_COUNTER, 0 }, 1.0, 0 },
+    { DCGM_FI_DEV_ECC_SBE_VOL_RATE, DcgmDerivedOp::Rate, { DCGM_FI_DEV_ECC_SBE_VOL_TOTAL, 0 }, 1.0, 0 },
+    { DCGM_FI_DEV_ECC_DBE_VOL_RATE, DcgmDerivedOp::Rate, { DCGM_FI_DEV_ECC_DBE_VOL_TOTAL, 0 }, 1.0, 0 },
+    { DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_RATE,
+      DcgmDerivedOp::Rate,
+      { DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_TOTAL, 0 },
+      1.0,
+      0 },
+    { DCGM_FI_DEV_NVLINK_REPLAY_ERROR_RATE,
+      DcgmDerivedOp::Rate,
+      { DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_TOTAL, 0 },
+      1.0,
+      0 },
+    { DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME,
+      DcgmDerivedOp::Duration,
+      { DCGM_FI_DEV_CLOCKS_EVENT_REASONS, 0 },
+      1.0,
+      DCGM_CLOCKS_EVENT_REASON_SW_POWER_CAP },
+    { DCGM_FI_DEV_CLOCKS_EVENT_HW_SLOWDOWN_TIME,
+      DcgmDerivedOp::Duration,
+      { DCGM_FI_DEV_CLOCKS_EVENT_REASONS, 0 },
+      1.0,
+      DCGM_CLOCKS_EVENT_REASON_HW_SLOWDOWN },
+    { DCGM_FI_DEV_CLOCKS_EVENT_SYNC_BOOST_TIME,
+      DcgmDerivedOp::Duration,
+      { DCGM_FI_DEV_CLOCKS_EVENT_REASONS, 0 },
+      1.0,
+      DCGM_CLOCKS_EVENT_REASON_SYNC_BOOST },
+    { DCGM_FI_DEV_CLOCKS_EVENT_SW_THERMAL_TIME,
+      DcgmDerivedOp::Duration,
+      { DCGM_FI_DEV_CLOCKS_EVENT_REASONS, 0 },
+      1.0,
+      DCGM_CLOCKS_EVENT_REASON_SW_THERMAL },
+    { DCGM_FI_DEV_CLOCKS_EVENT_HW_THERMAL_TIME,
+      DcgmDerivedOp::Duration,
+      { DCGM_FI_DEV_CLOCKS_EVENT_REASONS, 0 },
+      1.0,
+      DCGM_CLOCKS_EVENT_REASON_HW_THERMAL },
+    { DCGM_FI_DEV_CLOCKS_EVENT_HW_POWER_BRAKE_TIME,
+      DcgmDerivedOp::Duration,
+      { DCGM_FI_DEV_CLOCKS_EVENT_REASONS, 0 },
+      1.0,
+      DCGM_CLOCKS_EVENT_REASON_HW_POWER_BRAKE },
+} };
+
+/* Derived fields evaluated when each field is appended, indexed by fieldId. Only inputs[0] triggers an evaluation */
+std::vector<std::vector<DcgmDerivedFieldDef const *>> const &TriggeredByTable()
+{
+    static std::vector<std::vector<DcgmDerivedFieldDef const *>> const table = [] {
+        std::vector<std::vector<DcgmDerivedFieldDef const *>> result(DCGM_FI_MAX_FIELDS);
+        for (auto const &def : c_derivedFields)
+        {
+            result[def.inputs[0]].push_back(&def);
+        }
+        return result;
+    }();
+    return table;
+}
+} // namespace
+
+/*****************************************************************************/
+DcgmDerivedFieldDef const *DcgmDerivedFields::GetDef(unsigned short fieldId)
+{
+    for (auto const &def : c_derivedFields)
+    {
+        if (def.fieldId == fieldId)
+        {
+            return &def;
+        }
+    }
+    return nullptr;
+}
+
+/*****************************************************************************/
+std::span<DcgmDerivedFieldDef const *const> DcgmDerivedFields::GetDefsTriggeredBy(unsigned short fieldId)
+{
+    if (fieldId >= DCGM_FI_MAX_FIELDS)
+    {
+        return {};
+    }
+    return TriggeredByTable()[fieldId];
+}
+
+/*****************************************************************************/
+std::span<DcgmDerivedFieldDef const> DcgmDerivedFields::GetAllDefs()
+{
+    return c_derivedFields;
+}
+
+/*****************************************************************************/
+std::optional<double> DcgmDerivedFields::EvaluateRate(DcgmDerivedFieldDef const &def,
+                                                      double prevValue,
+                                                      timelib64_t prevTimestamp,
+                                                      double value,
+                                                      timelib64_t timestamp)
+{
+    if (prevTimestamp == 0 || timestamp <= prevTimestamp || value < prevValue)
+    {
+        return std::nullopt;
+    }
+
+    double const elapsedSec = (timestamp - prevTimestamp) / 1000000.0;
+    return (value - prevValue) / elapsedSec * def.scale;
+}
+
+/*****************************************************************************/
+std::optional<double> DcgmDerivedFields::EvaluateRatio(DcgmDerivedFieldDef const &def,
+                                                       double numerator,
+                                                       double denominator)
+{
+    if (denominator == 0.0)
+    {
+        return std::nullopt;
+    }
+    return numerator / denominator * def.scale;
+}
+
+/*****************************************************************************/
+std::optional<double> DcgmDerivedFields::EvaluateDuration(DcgmDerivedFieldDef const &def,
+                                                          double prevValue,
+                                                          timelib64_t prevTimestamp,
+                                                          timelib64_t timestamp,
+                                                          double total)
+{
+    if (prevTimestamp == 0)
+    {
+        return total;
+    }
+    if (timestamp <= prevTimestamp)
+    {
+        return std::nullopt;
+    }
+
+    if ((static_cast<long long>(prevValue) & def.mask) != 0)
+    {
+        total += (timestamp - prevTimestamp) / 1000000.0 * def.scale;
+    }
+    return total;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "timelib.h"
+
+#include <optional>
+#include <span>
+
+/*****************************************************************************/
+/* How a derived field is computed from its inputs */
+enum class DcgmDerivedOp
+{
+    Rate,     /* Change of inputs[0] per second between its last two samples. A counter that went down was reset and
+                 yields no sample */
+    Ratio,    /* inputs[0] / inputs[1] * scale, using the latest sample of inputs[1] */
+    Duration, /* Seconds inputs[0] had any of the bits of mask set since the derived field was watched. Each sample
+                 of inputs[0] is taken to hold until the next one */
+};
+
+/*****************************************************************************/
+/* Definition of one derived field */
+struct DcgmDerivedFieldDef
+{
+    unsigned short fieldId;   /* The derived field. Always DCGM_FT_DOUBLE */
+    DcgmDerivedOp op;         /* How the field is computed */
+    unsigned short inputs[2]; /* Fields of the same entity it is computed from. inputs[1] is 0 for Rate */
+    double scale;             /* Factor the result is multiplied by */
+    long long mask;           /* Bits of inputs[0] a Duration counts. 0 for other ops */
+};
+
+/*****************************************************************************/
+/*
+ * Fields the cache manager computes from other fields of the same entity
+ * instead of reading them from the driver. See dcgm_fields.h for the list.
+ *
+ * A watch on a derived field watches its inputs at the same interval. Each
+ * time inputs[0] is appended to the cache, the derived field is evaluated and
+ * appended along with it, so clients read one precomputed value instead of
+ * fetching the inputs and computing it themselves.
+ */
+class DcgmDerivedFields
+{
+public:
+    /*************************************************************************/
+    /* Definition of fieldId. nullptr if fieldId is not a derived field */
+    static DcgmDerivedFieldDef const *GetDef(unsigned short fieldId);
+
+    /*************************************************************************/
+    /* Definitions of the derived fields that are evaluated when fieldId is appended */
+    static std::span<DcgmDerivedFieldDef const *const> GetDefsTriggeredBy(unsigned short fieldId);
+
+    /*************************************************************************/
+    /* All derived field definitions */
+    static std::span<DcgmDerivedFieldDef const> GetAllDefs();
+
+    /*************************************************************************/
+    /*
+     * Evaluate a Rate
+     *
+     * RETURNS: The rate per second of the change from prevValue at prevTimestamp to value at timestamp
+     *          std::nullopt if there is no earlier sample, time did not move forward or the counter was reset
+     */
+    static std::optional<double> EvaluateRate(DcgmDerivedFieldDef const &def,
+                                              double prevValue,
+                                              timelib64_t prevTimestamp,
+                                              double value,
+                                              timelib64_t timestamp);
+
+    /*************************************************************************/
+    /*
+     * Evaluate a Ratio
+     *
+     * RETURNS: numerator / denominator * def.scale
+     *          std::nullopt if denominator is 0
+     */
+    static std::optional<double> EvaluateRatio(DcgmDerivedFieldDef const &def, double numerator, double denominator);
+
+    /*************************************************************************/
+    /*
+     * Evaluate a Duration
+     *
+     * RETURNS: total plus the time from prevTimestamp to timestamp if prevValue had any of def.mask set.
+     *          Just total for the first sample
+     *          std::nullopt if time did not move forward
+     */
+    static std::optional<double> EvaluateDuration(DcgmDerivedFieldDef const &def,
+                                                  double prevValue,
+                                                  timelib64_t prevTimestamp,
+                                                  timelib64_t timestamp,
+                                                  double total);
+};
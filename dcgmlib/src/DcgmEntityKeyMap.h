@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmWatchTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Map of dcgm_entity_key_t -> T *, used for the cache manager's watch table.
+ *
+ * This is an open-addressing hash map with linear probing. Keys are packed
+ * into 64 bits and stored inline next to their value, so a lookup is a hash
+ * and a short scan of adjacent slots rather than a walk of chained nodes
+ * through hash and compare callbacks.
+ *
+ * Values must not be nullptr, which marks an empty slot. Entries are never
+ * removed one at a time, matching how watches are only dropped all at once.
+ * The map doesn't own the values.
+ *
+ * Inserting may move entries, which invalidates iterators. Unlike the chained
+ * hashtable this replaced, that includes iterators of a walk that let go of
+ * the lock guarding the map. Such walks have to copy the values out first.
+ * Not thread safe.
+ */
+template <typename T>
+class DcgmEntityKeyMap
+{
+private:
+    struct Slot
+    {
+        std::uint64_t key = 0;
+        T *value          = nullptr;
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        T *operator*() const
+        {
+            return m_slot->value;
+        }
+
+        const_iterator &operator++()
+        {
+            ++m_slot;
+            SkipEmpty();
+            return *this;
+        }
+
+        bool operator==(const_iterator const &other) const
+        {
+            return m_slot == other.m_slot;
+        }
+
+        bool operator!=(const_iterator const &other) const
+        {
+            return m_slot != other.m_slot;
+        }
+
+    private:
+        friend class DcgmEntityKeyMap;
+
+        const_iterator(Slot const *slot, Slot const *end)
+            : m_slot(slot)
+            , m_end(end)
+        {
+            SkipEmpty();
+        }
+
+        void SkipEmpty()
+        {
+            while (m_slot != m_end && m_slot->value == nullptr)
+            {
+                ++m_slot;
+            }
+        }
+
+        Slot const *m_slot;
+        Slot const *m_end;
+    };
+
+    /*************************************************************************/
+    /* Get the value of key, or nullptr if key isn't in the map */
+    T *Find(dcgm_entity_key_t const &key) const
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+
+        return m_slots[FindSlot(DcgmNs::PackEntityKey(key))].value;
+    }
+
+    /*************************************************************************/
+    /*
+     * Add key -> value. value must not be nullptr.
+     *
+     * Returns: true if key was added
+     *          false if key was already in the map. Its value is unchanged
+     */
+    bool Insert(dcgm_entity_key_t const &key, T *value)
+    {
+        /* Keep the load factor at or under 1/2 so probe sequences stay short */
+        if ((m_size + 1) * 2 > m_slots.size())
+        {
+            Grow();
+        }
+
+        std::uint64_t const packedKey = DcgmNs::PackEntityKey(key);
+        Slot &slot                    = m_slots[FindSlot(packedKey)];
+        if (slot.value != nullptr)
+        {
+            return false;
+        }
+
+        slot.key   = packedKey;
+        slot.value = value;
+        m_size++;
+        return true;
+    }
+
+    /*************************************************************************/
+    /* Remove all entries. The values are left to the caller */
+    void Clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    /*************************************************************************/
+    /* Number of entries in the map */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /*************************************************************************/
+    /* Iterate the values, in no particular order */
+    const_iterator begin() const
+    {
+        return const_iterator(m_slots.data(), m_slots.data() + m_slots.size());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size());
+    }
+
+private:
+    static constexpr std::size_t c_minCapacity = 64; /* Must be a power of 2 */
+
+    /*************************************************************************/
+    /* Index of the slot holding packedKey, or of the empty slot it would go in */
+    std::size_t FindSlot(std::uint64_t packedKey) const
+    {
+        std::size_t const mask = m_slots.size() - 1;
+
+        /* The table is never more than half full, so this always finds an empty slot */
+        for (std::size_t i = DcgmNs::HashPackedEntityKey(packedKey) & mask;; i = (i + 1) & mask)
+        {
+            Slot const &slot = m_slots[i];
+            if (slot.value == nullptr || slot.key == packedKey)
+            {
+                return i;
+            }
+        }
+    }
+
+    /*************************************************************************/
+    /* Double the capacity and re-insert every entry */
+    void Grow()
+    {
+        std::vector<Slot> oldSlots(m_slots.empty() ? c_minCapacity : m_slots.size() * 2);
+        oldSlots.swap(m_slots);
+
+        for (Slot const &slot : oldSlots)
+        {
+            if (slot.value != nullptr)
+            {
+                m_slots[FindSlot(slot.key)] = slot;
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::size_t m_size = 0;
+};
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmEntityStatusTable.h"
+
+#include <DcgmLogging.h>
+
+#include <utility>
+#include <vector>
+
+/*****************************************************************************/
+DcgmEntityStatusTable::DenseGroup::DenseGroup(unsigned int capacity)
+    : slots(std::make_unique<std::atomic_uint32_t[]>(capacity))
+    , capacity(capacity)
+{
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        slots[i].store(c_noEntity, std::memory_order_relaxed);
+    }
+}
+
+/*****************************************************************************/
+DcgmEntityStatusTable::DcgmEntityStatusTable()
+    : m_gpus(DCGM_MAX_NUM_DEVICES)
+    , m_gpuInstances(DCGM_MAX_INSTANCES)
+    , m_computeInstances(DCGM_MAX_COMPUTE_INSTANCES)
+    , m_cpus(DCGM_MAX_NUM_CPUS)
+    , m_cpuCores(DCGM_MAX_NUM_CPU_CORES)
+{
+    for (auto &entry : m_switches)
+    {
+        entry.store(UINT64_MAX, std::memory_order_relaxed);
+    }
+}
+
+/*****************************************************************************/
+DcgmEntityStatusTable::DenseGroup *DcgmEntityStatusTable::GetDenseGroup(dcgm_field_entity_group_t entityGroupId)
+{
+    return const_cast<DenseGroup *>(std::as_const(*this).GetDenseGroup(entityGroupId));
+}
+
+/*****************************************************************************/
+DcgmEntityStatusTable::DenseGroup const *DcgmEntityStatusTable::GetDenseGroup(
+    dcgm_field_entity_group_t entityGroupId) const
+{
+    switch (entityGroupId)
+    {
+        case DCGM_FE_GPU:
+            return &m_gpus;
+        case DCGM_FE_GPU_I:
+            return &m_gpuInstances;
+        case DCGM_FE_GPU_CI:
+            return &m_computeInstances;
+        case DCGM_FE_CPU:
+            return &m_cpus;
+        case DCGM_FE_CPU_CORE:
+            return &m_cpuCores;
+        default:
+            return nullptr;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmEntityStatusTable::Publish(dcgm_field_entity_group_t entityGroupId, std::span<Entry const> entries)
+{
+    std::lock_guard<std::mutex> lg(m_publishMutex);
+
+    if (entityGroupId == DCGM_FE_SWITCH)
+    {
+        return PublishSwitches(entries);
+    }
+
+    DenseGroup *group = GetDenseGroup(entityGroupId);
+    if (group == nullptr)
+    {
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    /* Build the whole group first, so that each slot is written once. Readers never see an entity go missing
+       while its group is republished */
+    std::vector<std::uint32_t> values(group->capacity, c_noEntity);
+    for (auto const &entry : entries)
+    {
+        if (entry.entityId >= group->capacity)
+        {
+            log_error("eg {} eid {} is past the {} entities of the status table. Not serving the group from it",
+                      entityGroupId,
+                      entry.entityId,
+                      group->capacity);
+            group->published.store(false, std::memory_order_release);
+            return DCGM_ST_BADPARAM;
+        }
+        values[entry.entityId] = entry.value;
+    }
+
+    for (unsigned int i = 0; i < group->capacity; i++)
+    {
+        if (group->slots[i].load(std::memory_order_relaxed) != values[i])
+        {
+            group->slots[i].store(values[i], std::memory_order_release);
+        }
+    }
+    group->published.store(true, std::memory_order_release);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmEntityStatusTable::PublishSwitches(std::span<Entry const> entries)
+{
+    if (entries.size() > m_switches.size())
+    {
+        log_error("{} switches don't fit in the {} of the status table", entries.size(), m_switches.size());
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::uint32_t const sequence = m_switchesSequence.load(std::memory_order_relaxed);
+    m_switchesSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (unsigned int i = 0; i < m_switches.size(); i++)
+    {
+        std::uint64_t const packed = i < entries.size()
+                                         ? (std::uint64_t { entries[i].entityId } << 32) | entries[i].value
+                                         : UINT64_MAX;
+        m_switches[i].store(packed, std::memory_order_relaxed);
+    }
+
+    m_switchesSequence.store(sequence + 2, std::memory_order_release);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmEntityStatusTable::SetGpuQuarantined(unsigned int gpuId, bool quarantined)
+{
+    if (gpuId < m_gpuQuarantined.size())
+    {
+        m_gpuQuarantined[gpuId].store(quarantined, std::memory_order_relaxed);
+    }
+}
+
+/*****************************************************************************/
+std::optional<DcgmEntityStatus_t> DcgmEntityStatusTable::GetGpuStatus(unsigned int gpuId) const
+{
+    if (!m_gpus.published.load(std::memory_order_acquire))
+    {
+        return std::nullopt;
+    }
+    if (gpuId >= m_gpus.capacity)
+    {
+        return DcgmEntityStatusUnknown;
+    }
+
+    std::uint32_t const status = m_gpus.slots[gpuId].load(std::memory_order_acquire);
+    return status == c_noEntity ? DcgmEntityStatusUnknown : static_cast<DcgmEntityStatus_t>(status);
+}
+
+/*****************************************************************************/
+std::optional<DcgmEntityStatus_t> DcgmEntityStatusTable::Get(dcgm_field_entity_group_t entityGroupId,
+                                                             dcgm_field_eid_t entityId) const
+{
+    if (entityGroupId == DCGM_FE_SWITCH)
+    {
+        return GetSwitchStatus(entityId);
+    }
+
+    DenseGroup const *group = GetDenseGroup(entityGroupId);
+    if (group == nullptr || !group->published.load(std::memory_order_acquire))
+    {
+        return std::nullopt;
+    }
+    if (entityId >= group->capacity)
+    {
+        return DcgmEntityStatusUnknown;
+    }
+
+    std::uint32_t const value = group->slots[entityId].load(std::memory_order_acquire);
+    if (value == c_noEntity)
+    {
+        return DcgmEntityStatusUnknown;
+    }
+    if (entityGroupId != DCGM_FE_GPU && entityGroupId != DCGM_FE_GPU_I && entityGroupId != DCGM_FE_GPU_CI)
+    {
+        return static_cast<DcgmEntityStatus_t>(value);
+    }
+
+    /* Instances have the status of their GPU */
+    unsigned int const gpuId = entityGroupId == DCGM_FE_GPU ? entityId : value;
+    auto const gpuStatus     = GetGpuStatus(gpuId);
+    if (!gpuStatus.has_value())
+    {
+        return std::nullopt;
+    }
+    if (*gpuStatus == DcgmEntityStatusOk && gpuId < m_gpuQuarantined.size()
+        && m_gpuQuarantined[gpuId].load(std::memory_order_relaxed))
+    {
+        return DcgmEntityStatusQuarantined;
+    }
+    return gpuStatus;
+}
+
+/*****************************************************************************/
+std::optional<DcgmEntityStatus_t> DcgmEntityStatusTable::GetSwitchStatus(dcgm_field_eid_t entityId) const
+{
+    std::uint32_t const sequence = m_switchesSequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1) != 0)
+    {
+        return std::nullopt;
+    }
+
+    DcgmEntityStatus_t status = DcgmEntityStatusUnknown;
+    for (auto const &entry : m_switches)
+    {
+        std::uint64_t const packed = entry.load(std::memory_order_relaxed);
+        if (packed == UINT64_MAX)
+        {
+            break;
+        }
+        if (static_cast<dcgm_field_eid_t>(packed >> 32) == entityId)
+        {
+            status = static_cast<DcgmEntityStatus_t>(packed & UINT32_MAX);
+            break;
+        }
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_switchesSequence.load(std::memory_order_relaxed) != sequence)
+    {
+        /* Overlapped a publish. The caller asks nvswitch instead */
+        return std::nullopt;
+    }
+    return status;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+#include "dcgm_structs_internal.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+
+/*****************************************************************************/
+/*
+ * Statuses of the entities of the host engine, readable without a lock.
+ *
+ * GPUs, CPUs and CPU cores are dense arrays indexed by entity ID. GPU and
+ * compute instances store the ID of their GPU, so that they follow its status
+ * and its quarantine. NvSwitch entity IDs are physical IDs, so the few
+ * switches are kept in a short list guarded by a sequence lock.
+ *
+ * A group is only served once its owner published it. Until then, Get()
+ * returns nullopt and callers ask the owner (the cache manager, nvswitch or
+ * sysmon) the way they used to. Publishing is serialized internally, reads
+ * are a couple of atomic loads.
+ */
+class DcgmEntityStatusTable
+{
+public:
+    struct Entry
+    {
+        dcgm_field_eid_t entityId;
+        unsigned int value; /* DcgmEntityStatus_t, or the parent gpuId of GPU and compute instances */
+    };
+
+    DcgmEntityStatusTable();
+
+    /*************************************************************************/
+    /*
+     * Replace every entity of entityGroupId. Entities that aren't in entries
+     * are unknown from now on.
+     *
+     * RETURNS: DCGM_ST_OK if the group was published
+     *          DCGM_ST_NOT_SUPPORTED if entityGroupId isn't kept in this table
+     *          DCGM_ST_BADPARAM if an entity ID is out of range or there are too many switches. The group
+     *                           is no longer served until it is published again
+     */
+    dcgmReturn_t Publish(dcgm_field_entity_group_t entityGroupId, std::span<Entry const> entries);
+
+    /*************************************************************************/
+    /*
+     * Set whether gpuId is quarantined. A quarantined GPU that is otherwise
+     * fine, and its instances, are DcgmEntityStatusQuarantined
+     */
+    void SetGpuQuarantined(unsigned int gpuId, bool quarantined);
+
+    /*************************************************************************/
+    /*
+     * RETURNS: The status of the entity. DcgmEntityStatusUnknown if it doesn't exist
+     *          nullopt if the group was never published or is being published right now
+     */
+    std::optional<DcgmEntityStatus_t> Get(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId) const;
+
+    /*************************************************************************/
+    /*
+     * Like Get(DCGM_FE_GPU, gpuId), but ignoring the quarantine
+     */
+    std::optional<DcgmEntityStatus_t> GetGpuStatus(unsigned int gpuId) const;
+
+private:
+    static constexpr std::uint32_t c_noEntity = UINT32_MAX;
+
+    /* A group indexed by entity ID */
+    struct DenseGroup
+    {
+        explicit DenseGroup(unsigned int capacity);
+
+        std::unique_ptr<std::atomic_uint32_t[]> slots; /* Status or parent gpuId. c_noEntity if there's none */
+        unsigned int capacity;
+        std::atomic_bool published { false };
+    };
+
+    DenseGroup *GetDenseGroup(dcgm_field_entity_group_t entityGroupId);
+    DenseGroup const *GetDenseGroup(dcgm_field_entity_group_t entityGroupId) const;
+
+    dcgmReturn_t PublishSwitches(std::span<Entry const> entries);
+    std::optional<DcgmEntityStatus_t> GetSwitchStatus(dcgm_field_eid_t entityId) const;
+
+    std::mutex m_publishMutex; /* Serializes Publish() */
+
+    DenseGroup m_gpus;
+    DenseGroup m_gpuInstances;
+    DenseGroup m_computeInstances;
+    DenseGroup m_cpus;
+    DenseGroup m_cpuCores;
+    std::array<std::atomic_bool, DCGM_MAX_NUM_DEVICES> m_gpuQuarantined {};
+
+    /* entityId << 32 | status of each switch. UINT64_MAX past the last one */
+    std::array<std::atomic_uint64_t, DCGM_MAX_NUM_SWITCHES> m_switches;
+    std::atomic_uint32_t m_switchesSequence { 0 }; /* Odd while m_switches is written. 0 until the first Publish */
+};
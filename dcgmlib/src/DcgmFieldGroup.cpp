@@ -379,7 +379,7 @@ dcgmReturn_t DcgmFieldGroupManager::PopulateFieldGroupGetAll(dcgmAllFieldGroup_t
 }
 
 /*****************************************************************************/
-void DcgmFieldGroupManager::OnConnectionRemove(dcgm_connection_id_t connectionId)
+bool DcgmFieldGroupManager::OnConnectionRemove(dcgm_connection_id_t connectionId)
 {
     dcgmReturn_t dcgmReturn;
     fieldGroupConnectionMap::iterator outer_it;
@@ -395,7 +395,7 @@ void DcgmFieldGroupManager::OnConnectionRemove(dcgm_connection_id_t connectionId
     {
         Unlock();
         log_debug("No field groups found for connectionId {}", connectionId);
-        return;
+        return false;
     }
 
     /* Walk all of the group IDs of this connection and remove the groups */
@@ -418,6 +418,8 @@ void DcgmFieldGroupManager::OnConnectionRemove(dcgm_connection_id_t connectionId
             log_warning("RemoveFieldGroup of fieldGroupId {} returned {}.", *uint_it, (int)dcgmReturn);
         }
     }
+
+    return !groupIdsToRemove.empty();
 }
 
 /*****************************************************************************/
@@ -170,8 +170,10 @@ public:
 
     /**************************************************************************
      * Handle a client disconnecting
+     *
+     * Returns true if field groups of connectionId were removed
      *************************************************************************/
-    void OnConnectionRemove(dcgm_connection_id_t connectionId);
+    bool OnConnectionRemove(dcgm_connection_id_t connectionId);
 
     /*************************************************************************/
 };
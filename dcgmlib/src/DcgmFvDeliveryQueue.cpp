@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFvDeliveryQueue.h"
+
+#include <DcgmLogging.h>
+
+/*****************************************************************************/
+DcgmFvDeliveryQueue::DcgmFvDeliveryQueue(unsigned int maxDepth, DeliverFn deliver)
+    : m_maxDepth(maxDepth)
+    , m_deliver(std::move(deliver))
+{
+    /* m_depth bounds the queue. Leave the TaskRunner some headroom so that it never rejects a task itself */
+    SetQueueCapacity(maxDepth + 1);
+}
+
+/*****************************************************************************/
+DcgmFvDeliveryQueue::~DcgmFvDeliveryQueue()
+{
+    /* Stop here rather than in ~DcgmTaskRunner() so that no task runs once m_deliver is gone */
+    try
+    {
+        StopAndWait(60000);
+    }
+    catch (std::exception const &e)
+    {
+        DCGM_LOG_ERROR << "DcgmFvDeliveryQueue::~DcgmFvDeliveryQueue(): " << e.what();
+    }
+}
+
+/*****************************************************************************/
+bool DcgmFvDeliveryQueue::Push(std::shared_ptr<DcgmFvBuffer> fvBuffer)
+{
+    unsigned int depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (depth > m_maxDepth)
+    {
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+        unsigned long long dropped = m_dropped.fetch_add(1, std::memory_order_relaxed) + 1;
+        /* Don't log every drop. A stalled subscriber would flood the log */
+        if (dropped == 1 || dropped % 1000 == 0)
+        {
+            log_warning("Dropped {} field value batches. {} are waiting to be delivered", dropped, m_maxDepth);
+        }
+        return false;
+    }
+
+    unsigned int highWater = m_highWaterDepth.load(std::memory_order_relaxed);
+    while (depth > highWater
+           && !m_highWaterDepth.compare_exchange_weak(highWater, depth, std::memory_order_relaxed))
+    {
+    }
+
+    auto task = Enqueue(DcgmNs::make_task("Deliver field values", [this, fvBuffer = std::move(fvBuffer)]() {
+        m_deliver(*fvBuffer);
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+        m_delivered.fetch_add(1, std::memory_order_relaxed);
+    }));
+
+    if (!task.has_value())
+    {
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+dcgm_fv_delivery_stats_t DcgmFvDeliveryQueue::GetStats() const
+{
+    dcgm_fv_delivery_stats_t stats;
+    stats.depth          = m_depth.load(std::memory_order_relaxed);
+    stats.maxDepth       = m_maxDepth;
+    stats.highWaterDepth = m_highWaterDepth.load(std::memory_order_relaxed);
+    stats.delivered      = m_delivered.load(std::memory_order_relaxed);
+    stats.dropped        = m_dropped.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmFvBuffer.h"
+#include "dcgm_structs.h"
+#include <DcgmTaskRunner.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/*****************************************************************************/
+/* Counters of one DcgmFvDeliveryQueue */
+typedef struct
+{
+    unsigned int depth;           /* Batches waiting to be delivered */
+    unsigned int maxDepth;        /* Batches that can wait before new ones are dropped */
+    unsigned int highWaterDepth;  /* Largest depth seen */
+    unsigned long long delivered; /* Batches passed to the deliver function */
+    unsigned long long dropped;   /* Batches dropped because the queue was full */
+} dcgm_fv_delivery_stats_t;
+
+/*****************************************************************************/
+/*
+ * Bounded queue of field value update batches for one subscriber, drained on
+ * the queue's own thread. This lets the cache manager update thread hand off
+ * a batch without waiting for the subscriber to process it.
+ *
+ * Batches are shared between the queues of every subscriber that wants them,
+ * so they must not be modified once pushed. Batches are delivered in the
+ * order they were pushed. When maxDepth batches are waiting, new batches are
+ * dropped rather than blocking the pusher.
+ */
+class DcgmFvDeliveryQueue : public DcgmTaskRunner
+{
+public:
+    using DeliverFn = std::function<void(DcgmFvBuffer &fvBuffer)>;
+
+    /*************************************************************************/
+    /*
+     * deliver is called on the queue's thread with each batch. The thread is
+     * started by Start()
+     */
+    DcgmFvDeliveryQueue(unsigned int maxDepth, DeliverFn deliver);
+
+    /*************************************************************************/
+    /* Stops the thread. Batches that are still waiting are not delivered */
+    ~DcgmFvDeliveryQueue() override;
+
+    /*************************************************************************/
+    /*
+     * Queue fvBuffer for delivery
+     *
+     * RETURNS: true if fvBuffer was queued
+     *          false if it was dropped because the queue is full
+     */
+    bool Push(std::shared_ptr<DcgmFvBuffer> fvBuffer);
+
+    /*************************************************************************/
+    dcgm_fv_delivery_stats_t GetStats() const;
+
+private:
+    unsigned int const m_maxDepth;
+    DeliverFn m_deliver;
+
+    std::atomic_uint m_depth { 0 };
+    std::atomic_uint m_highWaterDepth { 0 };
+    std::atomic_ullong m_delivered { 0 };
+    std::atomic_ullong m_dropped { 0 };
+};
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmFvStreams.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+DcgmNs::PackedEntityKey DcgmFvStreams::PackKey(unsigned int entityGroupId,
+                                               dcgm_field_eid_t entityId,
+                                               unsigned short fieldId)
+{
+    /* Global fields are cached under entityId 0 regardless of what was watched */
+    if (entityGroupId == DCGM_FE_NONE)
+    {
+        entityId = 0;
+    }
+
+    return DcgmNs::PackEntityKey(entityGroupId, entityId, fieldId);
+}
+
+/*****************************************************************************/
+dcgm_request_id_t DcgmFvStreams::Add(dcgm_connection_id_t connectionId,
+                                     dcgm_request_id_t requestId,
+                                     unsigned int groupId,
+                                     unsigned int fieldGroupId,
+                                     std::vector<dcgm_entity_key_t> const &keys)
+{
+    Stream stream;
+    stream.connectionId = connectionId;
+    stream.requestId    = requestId;
+    stream.groupId      = groupId;
+    stream.fieldGroupId = fieldGroupId;
+    stream.keys.reserve(keys.size());
+
+    for (auto const &key : keys)
+    {
+        stream.keys.insert(PackKey(key.entityGroupId, key.entityId, key.fieldId));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    dcgm_request_id_t replacedRequestId = DCGM_REQUEST_ID_NONE;
+
+    auto it = std::find_if(m_streams.begin(), m_streams.end(), [&](Stream const &s) {
+        return s.connectionId == connectionId && s.groupId == groupId && s.fieldGroupId == fieldGroupId;
+    });
+    if (it != m_streams.end())
+    {
+        replacedRequestId = it->requestId;
+        *it               = std::move(stream);
+    }
+    else
+    {
+        m_streams.push_back(std::move(stream));
+    }
+
+    m_count.store(m_streams.size(), std::memory_order_relaxed);
+    return replacedRequestId;
+}
+
+/*****************************************************************************/
+dcgm_request_id_t DcgmFvStreams::Remove(dcgm_connection_id_t connectionId,
+                                        unsigned int groupId,
+                                        unsigned int fieldGroupId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = std::find_if(m_streams.begin(), m_streams.end(), [&](Stream const &s) {
+        return s.connectionId == connectionId && s.groupId == groupId && s.fieldGroupId == fieldGroupId;
+    });
+    if (it == m_streams.end())
+    {
+        return DCGM_REQUEST_ID_NONE;
+    }
+
+    dcgm_request_id_t requestId = it->requestId;
+    m_streams.erase(it);
+    m_count.store(m_streams.size(), std::memory_order_relaxed);
+    return requestId;
+}
+
+/*****************************************************************************/
+void DcgmFvStreams::RemoveConnection(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::erase_if(m_streams, [connectionId](Stream const &s) { return s.connectionId == connectionId; });
+    m_count.store(m_streams.size(), std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+std::vector<dcgm_fv_stream_notification_t> DcgmFvStreams::Dispatch(DcgmFvBuffer &fvBuffer,
+                                                                   size_t maxNotificationBytes)
+{
+    std::vector<dcgm_fv_stream_notification_t> notifications;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_streams.empty())
+    {
+        return notifications;
+    }
+
+    /* One scratch buffer per stream, indexed like m_streams */
+    std::vector<std::vector<char>> streamBytes(m_streams.size());
+
+    auto flush = [&](size_t i) {
+        dcgm_fv_stream_notification_t notification;
+        notification.connectionId = m_streams[i].connectionId;
+        notification.requestId    = m_streams[i].requestId;
+        notification.fvBytes      = std::move(streamBytes[i]);
+        notifications.push_back(std::move(notification));
+        streamBytes[i].clear();
+    };
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        DcgmNs::PackedEntityKey key = PackKey(fv->entityGroupId, fv->entityId, fv->fieldId);
+
+        for (size_t i = 0; i < m_streams.size(); i++)
+        {
+            if (m_streams[i].keys.contains(key))
+            {
+                if (!streamBytes[i].empty() && streamBytes[i].size() + fv->length > maxNotificationBytes)
+                {
+                    flush(i);
+                }
+
+                /* Buffered FVs are self-describing, so copying them verbatim
+                   produces a valid serialized DcgmFvBuffer */
+                streamBytes[i].insert(streamBytes[i].end(), (char *)fv, (char *)fv + fv->length);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_streams.size(); i++)
+    {
+        if (!streamBytes[i].empty())
+        {
+            flush(i);
+        }
+    }
+
+    return notifications;
+}
+
+/*****************************************************************************/
+unsigned int DcgmFvStreams::GetCount() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
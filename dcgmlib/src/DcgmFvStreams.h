@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmFvBuffer.h"
+#include "DcgmProtocol.h"
+#include "DcgmWatchTable.h"
+#include "dcgm_fields.h"
+#include "dcgm_structs_internal.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+/*****************************************************************************/
+/* Field values that should be pushed to one subscribed client request */
+struct dcgm_fv_stream_notification_t
+{
+    dcgm_connection_id_t connectionId = DCGM_CONNECTION_ID_NONE;
+    dcgm_request_id_t requestId       = DCGM_REQUEST_ID_NONE;
+    std::vector<char> fvBytes; /* Serialized DcgmFvBuffer. Pass to DcgmFvBuffer::SetFromBuffer() */
+};
+
+/*****************************************************************************/
+/*
+ * Table of client (group, fieldGroup) subscriptions whose field value updates
+ * are pushed to the client after each cache manager update cycle instead of
+ * being polled for.
+ *
+ * The subscribed entity keys are resolved when a stream is added, so
+ * dispatching an update cycle only has to match each updated value against
+ * the keys of each stream.
+ */
+class DcgmFvStreams
+{
+public:
+    /*************************************************************************/
+    /*
+     * Add a stream that pushes updates of keys to requestId of connectionId.
+     * A stream for the same connectionId, groupId and fieldGroupId is replaced.
+     *
+     * RETURNS: The requestId of the replaced stream
+     *          DCGM_REQUEST_ID_NONE if no stream was replaced
+     */
+    dcgm_request_id_t Add(dcgm_connection_id_t connectionId,
+                          dcgm_request_id_t requestId,
+                          unsigned int groupId,
+                          unsigned int fieldGroupId,
+                          std::vector<dcgm_entity_key_t> const &keys);
+
+    /*************************************************************************/
+    /*
+     * Remove the stream of connectionId for groupId and fieldGroupId.
+     *
+     * RETURNS: The requestId of the removed stream
+     *          DCGM_REQUEST_ID_NONE if there was no such stream
+     */
+    dcgm_request_id_t Remove(dcgm_connection_id_t connectionId, unsigned int groupId, unsigned int fieldGroupId);
+
+    /*************************************************************************/
+    /*
+     * Remove all streams of connectionId. Used when the connection goes away
+     */
+    void RemoveConnection(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /*
+     * Split fvBuffer into what each stream subscribed to. Streams that have
+     * no values in fvBuffer don't get a notification. A stream gets more than
+     * one notification if its values don't fit in maxNotificationBytes.
+     */
+    std::vector<dcgm_fv_stream_notification_t> Dispatch(DcgmFvBuffer &fvBuffer, size_t maxNotificationBytes);
+
+    /*************************************************************************/
+    /* Number of streams. This doesn't lock so it can be used as a fast path */
+    unsigned int GetCount() const;
+
+private:
+    struct Stream
+    {
+        dcgm_connection_id_t connectionId;
+        dcgm_request_id_t requestId;
+        unsigned int groupId;
+        unsigned int fieldGroupId;
+        /* PackKey() of each subscribed entity + field */
+        std::unordered_set<DcgmNs::PackedEntityKey, DcgmNs::EntityKeyHash> keys;
+    };
+
+    /*************************************************************************/
+    static DcgmNs::PackedEntityKey PackKey(unsigned int entityGroupId,
+                                          dcgm_field_eid_t entityId,
+                                          unsigned short fieldId);
+
+    std::mutex m_mutex; /* Protects m_streams */
+    std::vector<Stream> m_streams;
+    std::atomic_uint m_count { 0 }; /* m_streams.size() for lockless readers */
+};
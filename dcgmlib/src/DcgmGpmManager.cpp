@@ -18,6 +18,7 @@
 #include <DcgmUtilities.h>
 #include <TimeLib.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <ranges>
 
@@ -54,6 +55,8 @@ void DcgmGpmManagerEntity::AddWatcher(unsigned short fieldId,
                             false);
     m_watchTable.GetMinAndMaxUpdateInterval(m_minUpdateInterval, m_maxUpdateInterval);
     m_watchTable.GetMaxAgeUsecAllWatches(_discard, m_maxSampleAge);
+    ResizeSampleRing();
+    UpdateWatchedMetrics();
 }
 
 /****************************************************************************/
@@ -65,69 +68,204 @@ void DcgmGpmManagerEntity::RemoveWatcher(unsigned short dcgmFieldId, DcgmWatcher
 
     m_watchTable.GetMinAndMaxUpdateInterval(m_minUpdateInterval, m_maxUpdateInterval);
     m_watchTable.GetMaxAgeUsecAllWatches(_discard, m_maxSampleAge);
+    ResizeSampleRing();
+    UpdateWatchedMetrics();
 }
 
 /****************************************************************************/
 dcgmReturn_t DcgmGpmManagerEntity::RemoveConnectionWatches(dcgm_connection_id_t connectionId)
 {
+    if (!m_watchTable.HasConnectionWatches(connectionId))
+    {
+        return DCGM_ST_OK;
+    }
+
     m_watchTable.RemoveConnectionWatches(connectionId, nullptr);
 
     /* Update our max watch interval after any watch table changes */
     m_watchTable.GetMinAndMaxUpdateInterval(m_minUpdateInterval, m_maxUpdateInterval);
+    ResizeSampleRing();
+    UpdateWatchedMetrics();
     return DCGM_ST_OK;
 }
 
 /****************************************************************************/
-DcgmGpmSample DcgmGpmManagerEntity::reuseOrAllocateSample()
+bool DcgmGpmManagerEntity::HasConnectionWatches(dcgm_connection_id_t connectionId) const
 {
-    if (m_freedGpmSamples.empty())
+    return m_watchTable.HasConnectionWatches(connectionId);
+}
+
+/****************************************************************************/
+void DcgmGpmManagerEntity::ResizeSampleRing()
+{
+    std::size_t capacity = DcgmGpmSampleRing::MinCapacity;
+    m_minSampleSpacing   = 0;
+
+    if (m_minUpdateInterval > 0)
     {
-        return DcgmGpmSample();
+        /* Samples are at least m_minUpdateInterval apart. Besides the ones that cover m_maxUpdateInterval, keep
+           the newest one, the oldest one that is never used as a baseline and one for a sample being taken */
+        timelib64_t const needed = (m_maxUpdateInterval + m_minUpdateInterval - 1) / m_minUpdateInterval + 3;
+        if (needed > static_cast<timelib64_t>(DcgmGpmSampleRing::MaxCapacity))
+        {
+            capacity                 = DcgmGpmSampleRing::MaxCapacity;
+            timelib64_t const spread = static_cast<timelib64_t>(capacity) - 3;
+            m_minSampleSpacing       = (m_maxUpdateInterval + spread - 1) / spread;
+        }
+        else
+        {
+            capacity = std::max(static_cast<std::size_t>(needed), capacity);
+        }
     }
 
-    auto sample = std::move(m_freedGpmSamples.back());
-    m_freedGpmSamples.pop_back();
-    return sample;
+    m_gpmSamples.Resize(capacity);
+
+    log_debug("eg {}, eid {} keeps up to {} GPM samples at least {} usec apart",
+              m_entityPair.entityGroupId,
+              m_entityPair.entityId,
+              capacity,
+              m_minSampleSpacing);
 }
 
 /****************************************************************************/
-void DcgmGpmManagerEntity::PruneOldSamples(timelib64_t now)
+bool DcgmGpmManagerEntity::IsFieldSupported(dcgm_field_meta_p fieldMeta) const
 {
-    using namespace std::ranges;
+    switch (m_entityPair.entityGroupId)
+    {
+        case DCGM_FE_GPU:
+            // All GPM metrics supported at the GPU level
+            return true;
+        case DCGM_FE_GPU_I:
+            return fieldMeta->entityLevel == DCGM_FE_GPU_I || fieldMeta->entityLevel == DCGM_FE_GPU_CI;
+        case DCGM_FE_GPU_CI:
+            return fieldMeta->entityLevel == DCGM_FE_GPU_CI;
+        default:
+            return false;
+    }
+}
+
+/****************************************************************************/
+void DcgmGpmManagerEntity::UpdateWatchedMetrics()
+{
+    std::vector<dcgm_entity_key_t> watched;
+    m_watchTable.GetWatchedKeys(DcgmModuleIdProfiling, watched);
+
+    m_watchedMetricIds.clear();
+    for (auto const &watchKey : watched)
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(watchKey.fieldId);
+        if (fieldMeta == nullptr || !IsFieldSupported(fieldMeta))
+        {
+            continue;
+        }
+
+        bool isPercentageField = false;
+        unsigned int metricId  = DcgmFieldIdToNvmlGpmMetricId(watchKey.fieldId, isPercentageField);
+        if (metricId != 0 && std::ranges::find(m_watchedMetricIds, metricId) == m_watchedMetricIds.end())
+        {
+            m_watchedMetricIds.push_back(metricId);
+        }
+    }
+
+    /* Values computed for the old set of metrics may lack the new ones */
+    for (auto &metricValues : m_metricValues)
+    {
+        metricValues = DcgmGpmMetricValues {};
+    }
+
+    log_debug("eg {}, eid {} has {} watched GPM metrics",
+              m_entityPair.entityGroupId,
+              m_entityPair.entityId,
+              m_watchedMetricIds.size());
+}
+
+/****************************************************************************/
+const DcgmGpmMetricValues &DcgmGpmManagerEntity::GetMetricValues(std::size_t baselineSampleIndex,
+                                                                 std::size_t latestSampleIndex)
+{
+    auto const &baseline = m_gpmSamples.At(baselineSampleIndex);
+    auto const &latest   = m_gpmSamples.At(latestSampleIndex);
+
+    for (auto const &metricValues : m_metricValues)
+    {
+        if (metricValues.baselineTs == baseline.timestamp && metricValues.latestTs == latest.timestamp)
+        {
+            return metricValues;
+        }
+    }
+
+    DcgmGpmMetricValues &metricValues = m_metricValues[m_nextMetricValues];
+    m_nextMetricValues                = (m_nextMetricValues + 1) % m_metricValues.size();
 
+    metricValues.baselineTs = baseline.timestamp;
+    metricValues.latestTs   = latest.timestamp;
+    metricValues.values.clear();
 
-    timelib64_t cutOffMinimumExclusive = now - m_maxSampleAge;
-    auto upperBound                    = m_gpmSamples.upper_bound(cutOffMinimumExclusive);
+    /* One call for all the metrics, unless there are more of them than one call takes */
+    for (std::size_t first = 0; first < m_watchedMetricIds.size(); first += NVML_GPM_METRIC_MAX)
+    {
+        std::size_t const count = std::min<std::size_t>(m_watchedMetricIds.size() - first, NVML_GPM_METRIC_MAX);
+
+        nvmlGpmMetricsGet_t mg {};
+        mg.version    = NVML_GPM_METRICS_GET_VERSION;
+        mg.numMetrics = count;
+        mg.sample1    = baseline.sample.m_sample;
+        mg.sample2    = latest.sample.m_sample;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            mg.metrics[i].metricId = m_watchedMetricIds[first + i];
+        }
 
-    move(subrange(begin(m_gpmSamples), upperBound) | views::values, std::back_inserter(m_freedGpmSamples));
+        nvmlReturn_t nvmlReturn = nvmlGpmMetricsGet(&mg);
+        if (nvmlReturn != NVML_SUCCESS)
+        {
+            DCGM_LOG_ERROR << "Got nvmlReturn " << nvmlReturn << " from nvmlGpmMetricsGet for " << count
+                           << " metrics";
+        }
 
-    m_gpmSamples.erase(m_gpmSamples.begin(), upperBound);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            metricValues.values.push_back(
+                { .metricId   = mg.metrics[i].metricId,
+                  .nvmlReturn = nvmlReturn != NVML_SUCCESS ? nvmlReturn : mg.metrics[i].nvmlReturn,
+                  .value      = mg.metrics[i].value });
+        }
+    }
 
-    log_debug("Pruned old samples. gpmSamples.size = {}. freedGpmSamples.size = {}",
-              m_gpmSamples.size(),
-              m_freedGpmSamples.size());
+    return metricValues;
 }
+
+/****************************************************************************/
+void DcgmGpmManagerEntity::PruneOldSamples(timelib64_t now)
+{
+    m_gpmSamples.PopFrontUpTo(now - m_maxSampleAge);
+
+    log_debug("Pruned old samples. gpmSamples.size = {}. gpmSamples.capacity = {}",
+              m_gpmSamples.Size(),
+              m_gpmSamples.Capacity());
+}
+
 /****************************************************************************/
 dcgmReturn_t DcgmGpmManagerEntity::MaybeFetchNewSample(nvmlDevice_t nvmlDevice,
                                                        DcgmGpuInstance *const pGpuInstance,
                                                        timelib64_t now,
                                                        timelib64_t updateInterval,
-                                                       dcgmSampleMap::iterator &latestSampleIt)
+                                                       std::size_t &latestSampleIndex)
 {
-    if (m_gpmSamples.size() > 0)
+    if (m_gpmSamples.Size() > 0)
     {
-        auto latestIt         = std::prev(m_gpmSamples.end());
-        timelib64_t sampleAge = now - latestIt->first;
+        latestSampleIndex     = m_gpmSamples.Size() - 1;
+        timelib64_t sampleAge = now - m_gpmSamples.At(latestSampleIndex).timestamp;
         if (sampleAge < updateInterval)
         {
-            latestSampleIt = latestIt;
             return DCGM_ST_OK;
         }
     }
 
-    /* Fetch a new sample, insert it, and return its iterator */
+    /* Fetch a new sample, insert it, and return its index. It is dropped again if that fails */
 
-    latestSampleIt = m_gpmSamples.try_emplace(now, reuseOrAllocateSample()).first;
+    DcgmGpmSampleRing::Entry &latestSample = m_gpmSamples.PushBack(now);
+    latestSampleIndex                      = m_gpmSamples.Size() - 1;
 
     bool isMigSample        = m_entityPair.entityGroupId == DCGM_FE_GPU_I;
     nvmlReturn_t nvmlReturn = NVML_SUCCESS;
@@ -136,6 +274,7 @@ dcgmReturn_t DcgmGpmManagerEntity::MaybeFetchNewSample(nvmlDevice_t nvmlDevice,
         if (!pGpuInstance)
         {
             log_error("Received null pGpuInstance");
+            m_gpmSamples.PopBack();
             return DCGM_ST_BADPARAM;
         }
 
@@ -148,9 +287,10 @@ dcgmReturn_t DcgmGpmManagerEntity::MaybeFetchNewSample(nvmlDevice_t nvmlDevice,
             log_warning("Requested samples for GPU-I {} (NVML id: {}) which has no child GPU-CIs. No data available",
                         entityId,
                         giIndex.id);
+            m_gpmSamples.PopBack();
             return DCGM_ST_NO_DATA;
         }
-        nvmlReturn = nvmlGpmMigSampleGet(nvmlDevice, giIndex.id, latestSampleIt->second.m_sample);
+        nvmlReturn = nvmlGpmMigSampleGet(nvmlDevice, giIndex.id, latestSample.sample.m_sample);
     }
     else
     {
@@ -158,17 +298,28 @@ dcgmReturn_t DcgmGpmManagerEntity::MaybeFetchNewSample(nvmlDevice_t nvmlDevice,
         if (!nvmlDevice)
         {
             DCGM_LOG_ERROR << "Received null nvmlDevice ";
+            m_gpmSamples.PopBack();
             return DCGM_ST_NO_DATA;
         }
-        nvmlReturn = nvmlGpmSampleGet(nvmlDevice, latestSampleIt->second.m_sample);
+        nvmlReturn = nvmlGpmSampleGet(nvmlDevice, latestSample.sample.m_sample);
     }
     if (nvmlReturn != NVML_SUCCESS)
     {
         DCGM_LOG_ERROR << "Got nvml st " << nvmlReturn << " from nvmlGpmSampleGet().";
-        m_gpmSamples.erase(latestSampleIt);
+        m_gpmSamples.PopBack();
         return DCGM_ST_NVML_ERROR;
     }
 
+    /* Thin out the samples when the ring is too small to keep one per m_minUpdateInterval. Fields with short
+       intervals then get a baseline somewhat older than they asked for */
+    std::size_t const numSamples = m_gpmSamples.Size();
+    if (m_minSampleSpacing > 0 && numSamples >= 3
+        && m_gpmSamples.At(numSamples - 2).timestamp - m_gpmSamples.At(numSamples - 3).timestamp < m_minSampleSpacing)
+    {
+        m_gpmSamples.DropBeforeNewest();
+        latestSampleIndex = m_gpmSamples.Size() - 1;
+    }
+
     return DCGM_ST_OK;
 }
 
@@ -192,25 +343,9 @@ dcgmReturn_t DcgmGpmManagerEntity::GetLatestSample(nvmlDevice_t nvmlDevice,
         return DCGM_ST_UNKNOWN_FIELD;
     }
 
-    switch (m_entityPair.entityGroupId)
+    if (!IsFieldSupported(fieldMeta))
     {
-        case DCGM_FE_GPU:
-            // All GPM metrics supported at the GPU level
-            break;
-        case DCGM_FE_GPU_I:
-            if (fieldMeta->entityLevel != DCGM_FE_GPU_I && fieldMeta->entityLevel != DCGM_FE_GPU_CI)
-            {
-                return DCGM_ST_NO_DATA;
-            }
-            break;
-        case DCGM_FE_GPU_CI:
-            if (fieldMeta->entityLevel != DCGM_FE_GPU_CI)
-            {
-                return DCGM_ST_NO_DATA;
-            }
-            break;
-        default:
-            return DCGM_ST_NO_DATA;
+        return DCGM_ST_NO_DATA;
     }
 
     timelib64_t updateInterval
@@ -231,26 +366,19 @@ dcgmReturn_t DcgmGpmManagerEntity::GetLatestSample(nvmlDevice_t nvmlDevice,
     // in a separate thread in order to avoid requiring a mutex
     PruneOldSamples(now);
 
-    dcgmSampleMap::iterator latestSampleIt;
-    dcgmReturn = MaybeFetchNewSample(nvmlDevice, pGpuInstance, now, updateInterval, latestSampleIt);
+    std::size_t latestSampleIndex = 0;
+    dcgmReturn = MaybeFetchNewSample(nvmlDevice, pGpuInstance, now, updateInterval, latestSampleIndex);
     if (dcgmReturn != DCGM_ST_OK)
     {
         /* Any error is already logged by MaybeFetchNewSample */
         return dcgmReturn;
     }
 
-    timelib64_t searchTs = latestSampleIt->first - updateInterval;
+    timelib64_t searchTs = m_gpmSamples.At(latestSampleIndex).timestamp - updateInterval;
 
-    /* See if there are any samples sufficiently old to be our baseline */
-    auto baselineSampleIt = m_gpmSamples.upper_bound(searchTs);
-    if (baselineSampleIt == m_gpmSamples.begin())
-    {
-        /* No samples available > searchTs */
-        return DCGM_ST_OK;
-    }
-    /* Upper bound returns first sample larger. prev() will be our first match */
-    baselineSampleIt = std::prev(baselineSampleIt);
-    if (baselineSampleIt == m_gpmSamples.begin())
+    /* See if there are any samples sufficiently old to be our baseline. The oldest sample is never used */
+    auto baselineSampleIndex = m_gpmSamples.FindAtOrBefore(searchTs);
+    if (!baselineSampleIndex.has_value() || *baselineSampleIndex == 0)
     {
         /* No samples available <= searchTs */
         return DCGM_ST_OK;
@@ -264,23 +392,25 @@ dcgmReturn_t DcgmGpmManagerEntity::GetLatestSample(nvmlDevice_t nvmlDevice,
         return DCGM_ST_NOT_SUPPORTED;
     }
 
-    nvmlGpmMetricsGet_t mg {};
-    mg.version              = NVML_GPM_METRICS_GET_VERSION;
-    mg.numMetrics           = 1;
-    mg.sample1              = baselineSampleIt->second.m_sample;
-    mg.sample2              = latestSampleIt->second.m_sample;
-    mg.metrics[0].metricId  = metricId;
-    nvmlReturn_t nvmlReturn = nvmlGpmMetricsGet(&mg);
+    if (std::ranges::find(m_watchedMetricIds, metricId) == m_watchedMetricIds.end())
+    {
+        UpdateWatchedMetrics();
+    }
+
+    /* Every watched metric of this sample pair is computed at once and reused by the other fields */
+    const DcgmGpmMetricValues &metricValues = GetMetricValues(*baselineSampleIndex, latestSampleIndex);
 
-    if (nvmlReturn != NVML_SUCCESS || mg.metrics[0].nvmlReturn != NVML_SUCCESS)
+    auto metricValue = std::ranges::find(metricValues.values, metricId, &DcgmGpmMetricValue::metricId);
+    if (metricValue == metricValues.values.end() || metricValue->nvmlReturn != NVML_SUCCESS)
     {
-        DCGM_LOG_ERROR << "Got nonzero nvmlReturn " << nvmlReturn << " or mg->metrics[0].nvmlReturn "
-                       << mg.metrics[0].nvmlReturn;
+        DCGM_LOG_ERROR << "Got nvmlReturn "
+                       << (metricValue == metricValues.values.end() ? NVML_ERROR_NOT_FOUND : metricValue->nvmlReturn)
+                       << " for metric " << metricId;
         return DCGM_ST_NVML_ERROR;
     }
 
     /* Success! */
-    value = mg.metrics[0].value;
+    value = metricValue->value;
 
     if (std::isnan(value))
     {
@@ -292,8 +422,8 @@ dcgmReturn_t DcgmGpmManagerEntity::GetLatestSample(nvmlDevice_t nvmlDevice,
     }
 
     DCGM_LOG_DEBUG << "eg " << m_entityPair.entityGroupId << ", eid " << m_entityPair.entityId << ", fieldId "
-                   << fieldId << " got value " << value << " between ts1 " << baselineSampleIt->first << " and ts2 "
-                   << latestSampleIt->first;
+                   << fieldId << " got value " << value << " between ts1 " << metricValues.baselineTs << " and ts2 "
+                   << metricValues.latestTs;
     return DCGM_ST_OK;
 }
 
@@ -303,6 +433,11 @@ dcgmReturn_t DcgmGpmManagerEntity::GetLatestSample(nvmlDevice_t nvmlDevice,
 void DcgmGpmManager::RemoveEntity(dcgmGroupEntityPair_t entity)
 {
     auto numErased = m_entities.erase(entity);
+
+    DcgmNs::Utils::EraseIf(m_connectionEntities, [&](auto &pair) {
+        pair.second.erase(entity);
+        return pair.second.empty();
+    });
     DCGM_LOG_DEBUG << "Removed eg " << entity.entityGroupId << ", eid " << entity.entityId << ". Found " << numErased
                    << " matches.";
 }
@@ -310,10 +445,22 @@ void DcgmGpmManager::RemoveEntity(dcgmGroupEntityPair_t entity)
 /****************************************************************************/
 void DcgmGpmManager::RemoveConnectionWatches(dcgm_connection_id_t connectionId)
 {
-    for (auto &entity : m_entities)
+    auto connectionIt = m_connectionEntities.find(connectionId);
+    if (connectionIt == m_connectionEntities.end())
+    {
+        return;
+    }
+
+    for (auto const &entityPair : connectionIt->second)
     {
-        entity.second.RemoveConnectionWatches(connectionId);
+        auto entityIt = m_entities.find(entityPair);
+        if (entityIt != m_entities.end())
+        {
+            entityIt->second.RemoveConnectionWatches(connectionId);
+        }
     }
+
+    m_connectionEntities.erase(connectionIt);
 }
 
 /****************************************************************************/
@@ -331,6 +478,7 @@ dcgmReturn_t DcgmGpmManager::AddWatcher(dcgm_entity_key_t entityKey,
     auto entityIt = m_entities.try_emplace(entityPair, entityPair).first;
 
     entityIt->second.AddWatcher(entityKey.fieldId, watcher, updateIntervalUsec, maxAgeUsec, maxKeepSamples);
+    m_connectionEntities[watcher.connectionId].insert(entityPair);
     return DCGM_ST_OK;
 }
 
@@ -351,6 +499,19 @@ dcgmReturn_t DcgmGpmManager::RemoveWatcher(dcgm_entity_key_t entityKey, DcgmWatc
     }
 
     entityIt->second.RemoveWatcher(entityKey.fieldId, watcher);
+
+    if (!entityIt->second.HasConnectionWatches(watcher.connectionId))
+    {
+        auto connectionIt = m_connectionEntities.find(watcher.connectionId);
+        if (connectionIt != m_connectionEntities.end())
+        {
+            connectionIt->second.erase(entityPair);
+            if (connectionIt->second.empty())
+            {
+                m_connectionEntities.erase(connectionIt);
+            }
+        }
+    }
     return DCGM_ST_OK;
 }
 
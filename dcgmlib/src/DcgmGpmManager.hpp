@@ -16,11 +16,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "DcgmEntityTypes.hpp"
 #include "DcgmGpuInstance.h"
+#include <DcgmEntityKey.h>
 #include <DcgmLogging.h>
 #include <DcgmUtilities.h>
 #include <DcgmWatchTable.h>
@@ -39,7 +48,7 @@ struct hash<dcgmGroupEntityPair_t>
 {
     std::size_t operator()(const dcgmGroupEntityPair_t &k) const
     {
-        return DcgmNs::Utils::Hash::CompoundHash(k.entityId, k.entityGroupId);
+        return DcgmNs::EntityKeyHash {}(k);
     }
 };
 template <>
@@ -95,7 +104,167 @@ public:
     }
 };
 
-typedef std::map<timelib64_t, DcgmGpmSample> dcgmSampleMap;
+/**
+ * GPM samples of one entity, oldest first, in a fixed number of reusable slots.
+ *
+ * The slots and the nvmlGpmSample_t in them are allocated by Resize() only.
+ * Dropping a sample keeps its slot, and adding one to a full ring overwrites
+ * the oldest sample, so taking a new sample never allocates anything.
+ */
+class DcgmGpmSampleRing
+{
+public:
+    struct Entry
+    {
+        timelib64_t timestamp = 0;
+        DcgmGpmSample sample;
+    };
+
+    std::size_t Size() const
+    {
+        return m_size;
+    }
+
+    std::size_t Capacity() const
+    {
+        return m_slots.size();
+    }
+
+    /* index 0 is the oldest sample */
+    Entry &At(std::size_t index)
+    {
+        return m_slots[(m_head + index) % m_slots.size()];
+    }
+
+    const Entry &At(std::size_t index) const
+    {
+        return m_slots[(m_head + index) % m_slots.size()];
+    }
+
+    /* Change the number of slots to capacity, keeping the newest samples that fit */
+    void Resize(std::size_t capacity)
+    {
+        if (capacity == m_slots.size())
+        {
+            return;
+        }
+
+        std::size_t const keep = std::min(m_size, capacity);
+        std::vector<Entry> slots;
+        slots.reserve(capacity);
+        for (std::size_t i = m_size - keep; i < m_size; i++)
+        {
+            slots.push_back(std::move(At(i)));
+        }
+        slots.resize(capacity);
+
+        m_slots.swap(slots);
+        m_head = 0;
+        m_size = keep;
+    }
+
+    /* Add a sample taken at timestamp, which has to be later than the ones already there. Its sample is filled
+       in by the caller. The oldest sample is dropped if the ring is full */
+    Entry &PushBack(timelib64_t timestamp)
+    {
+        if (m_slots.empty())
+        {
+            Resize(MinCapacity);
+        }
+        else if (m_size == m_slots.size())
+        {
+            m_head = (m_head + 1) % m_slots.size();
+            m_size--;
+        }
+
+        Entry &entry    = At(m_size);
+        entry.timestamp = timestamp;
+        m_size++;
+        return entry;
+    }
+
+    /* Drop the newest sample */
+    void PopBack()
+    {
+        m_size--;
+    }
+
+    /* Drop the sample before the newest one */
+    void DropBeforeNewest()
+    {
+        Entry &dropped = At(m_size - 2);
+        Entry &newest  = At(m_size - 1);
+        std::swap(dropped.timestamp, newest.timestamp);
+        std::swap(dropped.sample.m_sample, newest.sample.m_sample);
+        m_size--;
+    }
+
+    /* Drop the samples taken at or before cutOff */
+    void PopFrontUpTo(timelib64_t cutOff)
+    {
+        while (m_size > 0 && At(0).timestamp <= cutOff)
+        {
+            m_head = (m_head + 1) % m_slots.size();
+            m_size--;
+        }
+    }
+
+    /* Index of the newest sample taken at or before timestamp */
+    std::optional<std::size_t> FindAtOrBefore(timelib64_t timestamp) const
+    {
+        std::size_t first = 0;
+        std::size_t count = m_size;
+
+        /* Number of samples taken at or before timestamp */
+        while (count > 0)
+        {
+            std::size_t const step = count / 2;
+            if (At(first + step).timestamp <= timestamp)
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        if (first == 0)
+        {
+            return std::nullopt;
+        }
+        return first - 1;
+    }
+
+    static constexpr std::size_t MinCapacity = 4;
+    static constexpr std::size_t MaxCapacity = 64;
+
+private:
+    std::vector<Entry> m_slots;
+    std::size_t m_head = 0; /* Slot of the oldest sample */
+    std::size_t m_size = 0; /* Number of samples, starting at m_head */
+};
+
+/**
+ * Value of one GPM metric between two samples
+ */
+struct DcgmGpmMetricValue
+{
+    unsigned int metricId;
+    nvmlReturn_t nvmlReturn;
+    double value;
+};
+
+/**
+ * Values of every watched GPM metric of an entity between the same two samples
+ */
+struct DcgmGpmMetricValues
+{
+    timelib64_t baselineTs = 0; /* Timestamp of sample1. 0 = unused */
+    timelib64_t latestTs   = 0; /* Timestamp of sample2 */
+    std::vector<DcgmGpmMetricValue> values;
+};
 
 /**
  * Represents a single entity's GPM sample array and watch table
@@ -133,6 +302,12 @@ public:
      */
     dcgmReturn_t RemoveConnectionWatches(dcgm_connection_id_t connectionId);
 
+    /*************************************************************************/
+    /*
+     * Returns whether the given connection ID has any watches in the watch table
+     */
+    bool HasConnectionWatches(dcgm_connection_id_t connectionId) const;
+
     /*************************************************************************/
     /*
      * Get a sample for the given fieldId
@@ -148,13 +323,6 @@ public:
 private:
 #endif // #ifndef DCGM_GPM_TESTS
 
-    /*************************************************************************/
-    /*
-     * Get a previously pruned GPM sample if we have one available; otherwise
-     * allocate and return a new GPM sample
-     */
-    DcgmGpmSample reuseOrAllocateSample();
-
     /*************************************************************************/
     /*
      * Delete samples in m_gpmSamples older than maxAgeUsec
@@ -165,26 +333,62 @@ private:
     /*
      * First, checks to see if the latest sample in our sample buffer is new enough. If not,
      * fetches one from NVML.
-     * Either way, return a pointer to the latest sample in our sample buffer.
+     * Either way, return the index of the latest sample in our sample buffer.
      */
     dcgmReturn_t MaybeFetchNewSample(nvmlDevice_t nvmlDevice,
                                      DcgmGpuInstance *const pGpuInstance,
                                      timelib64_t now,
                                      timelib64_t updateInterval,
-                                     dcgmSampleMap::iterator &latestSampleIt);
-
-    dcgmSampleMap m_gpmSamples;                   /* map of of nvmlGpmSample_t *'s, sorted by timestamp */
-    std::vector<DcgmGpmSample> m_freedGpmSamples; /* map of of nvmlGpmSample_t *'s, sorted by timestamp */
-    DcgmWatchTable m_watchTable;                  /* Table of watchers of GPM fields for this entity */
-    dcgmGroupEntityPair_t m_entityPair;           /* Entity pair this class instance represents */
-    timelib64_t m_minUpdateInterval;              /* Minimum update interval contained in m_watchTable.
-                                                     this is used for determining how often to update from
-                                                     NVML */
-    timelib64_t m_maxUpdateInterval;              /* Maximum update interval contained in m_watchTable.
-                                                     this is used for determining how long to keep samples
-                                                     in m_gpmSamples */
-    timelib64_t m_maxSampleAge;                   /* Maximum sample age across all watches. Used for
-                                                     garbage collection */
+                                     std::size_t &latestSampleIndex);
+
+    /*************************************************************************/
+    /*
+     * Size m_gpmSamples for the watched update intervals and set m_minSampleSpacing.
+     * Called after every watch change
+     */
+    void ResizeSampleRing();
+
+    /*************************************************************************/
+    /*
+     * Returns whether fieldMeta can be read for our entity
+     */
+    bool IsFieldSupported(dcgm_field_meta_p fieldMeta) const;
+
+    /*************************************************************************/
+    /*
+     * Rebuild m_watchedMetricIds from m_watchTable. Called after every watch change
+     */
+    void UpdateWatchedMetrics();
+
+    /*************************************************************************/
+    /*
+     * Return the values of all the watched metrics between two samples, computing them with one
+     * nvmlGpmMetricsGet() call if they aren't in m_metricValues yet
+     */
+    const DcgmGpmMetricValues &GetMetricValues(std::size_t baselineSampleIndex, std::size_t latestSampleIndex);
+
+    static constexpr std::size_t MetricValuesCacheSize = 4;
+
+    DcgmGpmSampleRing m_gpmSamples;     /* nvmlGpmSample_t's, sorted by timestamp */
+    DcgmWatchTable m_watchTable;        /* Table of watchers of GPM fields for this entity */
+    dcgmGroupEntityPair_t m_entityPair; /* Entity pair this class instance represents */
+    timelib64_t m_minUpdateInterval;    /* Minimum update interval contained in m_watchTable.
+                                           this is used for determining how often to update from
+                                           NVML */
+    timelib64_t m_maxUpdateInterval;    /* Maximum update interval contained in m_watchTable.
+                                           this is used for determining how long to keep samples
+                                           in m_gpmSamples */
+    timelib64_t m_maxSampleAge;         /* Maximum sample age across all watches. Used for
+                                           garbage collection */
+    timelib64_t m_minSampleSpacing = 0; /* Minimum time between two kept samples other than the newest
+                                           one. Nonzero when m_gpmSamples can't hold a sample per
+                                           m_minUpdateInterval for all of m_maxUpdateInterval, in which
+                                           case the samples are thinned out to fit */
+    std::vector<unsigned int> m_watchedMetricIds; /* NVML GPM metric of each watched field we support */
+    std::array<DcgmGpmMetricValues, MetricValuesCacheSize> m_metricValues; /* Recently computed sample pairs.
+                                                                              Fields with different update
+                                                                              intervals use different pairs */
+    std::size_t m_nextMetricValues = 0; /* Entry of m_metricValues to replace next */
 };
 
 /**
@@ -195,6 +399,10 @@ class DcgmGpmManager
     /* Per-entity instances of DcgmGpmManagerEntity */
     std::unordered_map<dcgmGroupEntityPair_t, DcgmGpmManagerEntity> m_entities;
 
+    /* Entities of m_entities that each connection has watches on, so that RemoveConnectionWatches() only
+       visits those. Connections without any watches have no entry */
+    std::unordered_map<dcgm_connection_id_t, std::unordered_set<dcgmGroupEntityPair_t>> m_connectionEntities;
+
 public:
     DcgmGpmManager()  = default;
     ~DcgmGpmManager() = default;
@@ -37,6 +37,7 @@ DcgmGroupManager::DcgmGroupManager(DcgmCacheManager *cacheManager, bool createDe
     , mNumGroups(0)
     , mAllGpusGroupId(0)
     , mAllNvSwitchesGroupId(0)
+    , m_groupEntities(std::make_shared<GroupEntitiesMap const>())
     , mpCacheManager(cacheManager)
 {
     if (createDefaultGroups)
@@ -266,7 +267,8 @@ dcgmReturn_t DcgmGroupManager::AddNewGroup(dcgm_connection_id_t connectionId,
     }
 
     mGroupIdMap[newGroupId] = pDcgmGrp;
-    *pGroupId               = newGroupId;
+    PublishGroupEntities(newGroupId, pDcgmGrp->GetEntityList());
+    *pGroupId = newGroupId;
     mNumGroups++;
     Unlock();
 
@@ -303,6 +305,7 @@ dcgmReturn_t DcgmGroupManager::RemoveGroup(unsigned int groupId)
         delete pDcgmGrp;
         pDcgmGrp = NULL;
         mGroupIdMap.erase(itGroup);
+        PublishGroupEntities(groupId, nullptr);
     }
 
     mNumGroups--;
@@ -389,19 +392,50 @@ DcgmGroupInfo *DcgmGroupManager::GetGroupById(unsigned int groupId)
     return pDcgmGrp;
 }
 
+/*****************************************************************************/
+bool DcgmGroupManager::IsDynamicGroup(unsigned int groupId, dcgm_field_entity_group_t &entityGroupId) const
+{
+    if (groupId == mAllGpusGroupId)
+    {
+        entityGroupId = DCGM_FE_GPU;
+        return true;
+    }
+    else if (groupId == mAllNvSwitchesGroupId)
+    {
+        entityGroupId = DCGM_FE_SWITCH;
+        return true;
+    }
+
+    return false;
+}
+
+/*****************************************************************************/
+void DcgmGroupManager::PublishGroupEntities(unsigned int groupId, EntityListPtr entities)
+{
+    /* There are at most DCGM_MAX_NUM_GROUPS groups, so copying the map of pointers is cheap */
+    auto groupEntities = std::make_shared<GroupEntitiesMap>(*m_groupEntities.load());
+
+    if (entities)
+    {
+        (*groupEntities)[groupId] = std::move(entities);
+    }
+    else
+    {
+        groupEntities->erase(groupId);
+    }
+
+    m_groupEntities.store(std::move(groupEntities));
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmGroupManager::GetGroupEntities(unsigned int groupId, std::vector<dcgmGroupEntityPair_t> &entities)
 {
     dcgmReturn_t ret;
+    dcgm_field_entity_group_t entityGroupId;
 
-    Lock();
     /* See if this is one of the special fully-dynamic all-entity groups */
-    if (groupId == mAllGpusGroupId || groupId == mAllNvSwitchesGroupId)
+    if (IsDynamicGroup(groupId, entityGroupId))
     {
-        dcgm_field_entity_group_t entityGroupId = DCGM_FE_GPU;
-        if (groupId == mAllNvSwitchesGroupId)
-            entityGroupId = DCGM_FE_SWITCH;
-
         ret = DcgmHostEngineHandler::Instance()->GetAllEntitiesOfEntityGroup(1, entityGroupId, entities);
         if (ret != DCGM_ST_OK)
         {
@@ -409,22 +443,46 @@ dcgmReturn_t DcgmGroupManager::GetGroupEntities(unsigned int groupId, std::vecto
         }
         else
             log_debug("GetGroupEntities got {} entities for dynamic group {}", (unsigned int)entities.size(), groupId);
-        Unlock();
         return ret;
     }
 
-    /* This is a regular group. Just return its list */
-    DcgmGroupInfo *groupObj = GetGroupById(groupId);
-    if (!groupObj)
+    /* This is a regular group. Just return a copy of its list */
+    EntityListPtr entityList;
+    ret = GetGroupEntities(groupId, entityList);
+    if (ret == DCGM_ST_OK)
+    {
+        entities = *entityList;
+    }
+    return ret;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmGroupManager::GetGroupEntities(unsigned int groupId, EntityListPtr &entities)
+{
+    dcgm_field_entity_group_t entityGroupId;
+
+    if (IsDynamicGroup(groupId, entityGroupId))
+    {
+        auto dynamicEntities = std::make_shared<std::vector<dcgmGroupEntityPair_t>>();
+        dcgmReturn_t ret     = GetGroupEntities(groupId, *dynamicEntities);
+        if (ret == DCGM_ST_OK)
+        {
+            entities = std::move(dynamicEntities);
+        }
+        return ret;
+    }
+
+    std::shared_ptr<GroupEntitiesMap const> groupEntities = m_groupEntities.load();
+
+    auto it = groupEntities->find(groupId);
+    if (it == groupEntities->end())
     {
-        Unlock();
         DCGM_LOG_DEBUG << "Group " << groupId << " not found";
         return DCGM_ST_NOT_CONFIGURED;
     }
 
-    ret = groupObj->GetEntities(entities);
-    Unlock();
-    return ret;
+    entities = it->second;
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
@@ -432,18 +490,17 @@ dcgmReturn_t DcgmGroupManager::GetGroupGpuIds(dcgm_connection_id_t /* connection
                                               unsigned int groupId,
                                               std::vector<unsigned int> &gpuIds)
 {
-    std::vector<dcgmGroupEntityPair_t>::iterator entityIter;
-    std::vector<dcgmGroupEntityPair_t> entities;
+    EntityListPtr entities;
     dcgmReturn_t ret = GetGroupEntities(groupId, entities);
     if (ret != DCGM_ST_OK)
         return ret;
 
-    for (entityIter = entities.begin(); entityIter != entities.end(); ++entityIter)
+    for (auto const &entity : *entities)
     {
-        if ((*entityIter).entityGroupId != DCGM_FE_GPU)
+        if (entity.entityGroupId != DCGM_FE_GPU)
             continue;
 
-        gpuIds.push_back((*entityIter).entityId);
+        gpuIds.push_back(entity.entityId);
     }
 
     return DCGM_ST_OK;
@@ -485,8 +542,17 @@ dcgmReturn_t DcgmGroupManager::AddEntityToGroup(unsigned int groupId,
     }
 
     ret = groupObj->AddEntityToGroup(entityGroupId, entityId);
+    if (ret == DCGM_ST_OK)
+    {
+        PublishGroupEntities(groupId, groupObj->GetEntityList());
+    }
     Unlock();
 
+    if (ret == DCGM_ST_OK)
+    {
+        NotifyGroupEntitiesChange(groupId);
+    }
+
     DCGM_LOG_DEBUG << "groupId " << groupId << " added eg " << entityGroupId << ", eid " << entityId << ". ret " << ret;
     return ret;
 }
@@ -509,8 +575,17 @@ dcgmReturn_t DcgmGroupManager::RemoveEntityFromGroup(dcgm_connection_id_t connec
     }
 
     ret = groupObj->RemoveEntityFromGroup(entityGroupId, entityId);
+    if (ret == DCGM_ST_OK)
+    {
+        PublishGroupEntities(groupId, groupObj->GetEntityList());
+    }
     Unlock();
 
+    if (ret == DCGM_ST_OK)
+    {
+        NotifyGroupEntitiesChange(groupId);
+    }
+
     log_debug("conn {}, groupId {} removed eg {}, eid {}. ret {}", connectionId, groupId, entityGroupId, entityId, ret);
     return ret;
 }
@@ -549,19 +624,15 @@ dcgmReturn_t DcgmGroupManager::verifyAndUpdateGroupId(unsigned int *groupId)
         *groupId = mAllNvSwitchesGroupId;
     }
 
-    /* Check that the groupId is actually a valid group */
-    dcgmReturn_t ret = DCGM_ST_OK;
-
-    Lock();
-    DcgmGroupInfo *groupObj = GetGroupById(*groupId);
-    if (!groupObj)
+    /* Check that the groupId is actually a valid group. Every group has an entry in m_groupEntities */
+    std::shared_ptr<GroupEntitiesMap const> groupEntities = m_groupEntities.load();
+    if (!groupEntities->contains(*groupId))
     {
         log_debug("Group {} not found", *groupId);
-        ret = DCGM_ST_NOT_CONFIGURED;
+        return DCGM_ST_NOT_CONFIGURED;
     }
-    Unlock();
 
-    return ret;
+    return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
@@ -599,7 +670,9 @@ void DcgmGroupManager::OnConnectionRemove(dcgm_connection_id_t connectionId)
 }
 
 /*****************************************************************************/
-void DcgmGroupManager::SubscribeForGroupEvents(dcgmOnRemoveGroup_f onRemoveCB, void *userData)
+void DcgmGroupManager::SubscribeForGroupEvents(dcgmOnRemoveGroup_f onRemoveCB,
+                                               void *userData,
+                                               dcgmOnGroupEntitiesChange_f onEntitiesChangeCB)
 {
     dcgmGroupRemoveCBEntry_t insertEntry;
 
@@ -609,8 +682,25 @@ void DcgmGroupManager::SubscribeForGroupEvents(dcgmOnRemoveGroup_f onRemoveCB, v
     Lock();
 
     mOnRemoveCBs.push_back(insertEntry);
+    if (onEntitiesChangeCB != nullptr)
+    {
+        m_onEntitiesChangeCBs.emplace_back(onEntitiesChangeCB, userData);
+    }
+
+    Unlock();
+}
 
+/*****************************************************************************/
+void DcgmGroupManager::NotifyGroupEntitiesChange(unsigned int groupId)
+{
+    Lock();
+    auto const callbacks = m_onEntitiesChangeCBs;
     Unlock();
+
+    for (auto const &[callback, userData] : callbacks)
+    {
+        callback(groupId, userData);
+    }
 }
 
 /*****************************************************************************
@@ -625,15 +715,14 @@ DcgmGroupInfo::DcgmGroupInfo(dcgm_connection_id_t connectionId,
 {
     mGroupId       = groupId;
     mName          = name;
+    mEntityList    = std::make_shared<std::vector<dcgmGroupEntityPair_t> const>();
     mpCacheManager = cacheManager;
     mConnectionId  = connectionId;
 }
 
 /*****************************************************************************/
 DcgmGroupInfo::~DcgmGroupInfo()
-{
-    mEntityList.clear();
-}
+{}
 
 /*****************************************************************************/
 dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId)
@@ -641,7 +730,9 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
     dcgmGroupEntityPair_t insertEntity;
 
     DcgmEntityStatus_t entityStatus = DcgmHostEngineHandler::Instance()->GetEntityStatus(entityGroupId, entityId);
-    if (entityStatus != DcgmEntityStatusOk && entityStatus != DcgmEntityStatusFake)
+    /* Quarantined GPUs are expected to recover. Keep them groupable so watches survive the quarantine */
+    if (entityStatus != DcgmEntityStatusOk && entityStatus != DcgmEntityStatusFake
+        && entityStatus != DcgmEntityStatusQuarantined)
     {
         log_error("eg {}, eid {} is in status {}. Not adding to group.", entityGroupId, entityId, entityStatus);
         if (entityStatus == DcgmEntityStatusUnsupported)
@@ -656,10 +747,9 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
     insertEntity.entityId      = entityId;
 
     /* Check if entity is already added to the group */
-    for (unsigned int i = 0; i < mEntityList.size(); ++i)
+    for (auto const &entity : *mEntityList)
     {
-        if (mEntityList[i].entityGroupId == insertEntity.entityGroupId
-            && mEntityList[i].entityId == insertEntity.entityId)
+        if (entity.entityGroupId == insertEntity.entityGroupId && entity.entityId == insertEntity.entityId)
         {
             log_warning("AddEntityToGroup groupId {} eg {}, eid {} was already in the group",
                         mGroupId,
@@ -669,7 +759,7 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
         }
     }
 
-    if (mEntityList.size() >= DCGM_GROUP_MAX_ENTITIES_V2)
+    if (mEntityList->size() >= DCGM_GROUP_MAX_ENTITIES_V2)
     {
         /*
          * This is a safeguard for public API that has hardcoded array of DCGM_GROUP_MAX_ENTITIES_V2 elements in a
@@ -679,7 +769,13 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
         return DCGM_ST_MAX_LIMIT;
     }
 
-    mEntityList.push_back(insertEntity);
+    /* Readers may still hold the old list, so build a new one */
+    auto entityList = std::make_shared<std::vector<dcgmGroupEntityPair_t>>();
+    entityList->reserve(mEntityList->size() + 1);
+    entityList->assign(mEntityList->begin(), mEntityList->end());
+    entityList->push_back(insertEntity);
+    mEntityList = std::move(entityList);
+
     log_info("AddEntityToGroup groupId {}, eg {}, eid {} added to the group",
              mGroupId,
              insertEntity.entityGroupId,
@@ -690,11 +786,14 @@ dcgmReturn_t DcgmGroupInfo::AddEntityToGroup(dcgm_field_entity_group_t entityGro
 /*****************************************************************************/
 dcgmReturn_t DcgmGroupInfo::RemoveEntityFromGroup(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId)
 {
-    for (unsigned int i = 0; i < mEntityList.size(); ++i)
+    for (unsigned int i = 0; i < mEntityList->size(); ++i)
     {
-        if (mEntityList[i].entityGroupId == entityGroupId && mEntityList[i].entityId == entityId)
+        if ((*mEntityList)[i].entityGroupId == entityGroupId && (*mEntityList)[i].entityId == entityId)
         {
-            mEntityList.erase(mEntityList.begin() + i);
+            /* Readers may still hold the old list, so build a new one */
+            auto entityList = std::make_shared<std::vector<dcgmGroupEntityPair_t>>(*mEntityList);
+            entityList->erase(entityList->begin() + i);
+            mEntityList = std::move(entityList);
             return DCGM_ST_OK;
         }
     }
@@ -724,17 +823,23 @@ dcgm_connection_id_t DcgmGroupInfo::GetConnectionId()
 /*****************************************************************************/
 dcgmReturn_t DcgmGroupInfo::GetEntities(std::vector<dcgmGroupEntityPair_t> &entities)
 {
-    entities = mEntityList;
+    entities = *mEntityList;
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+DcgmGroupManager::EntityListPtr DcgmGroupInfo::GetEntityList() const
+{
+    return mEntityList;
+}
+
 /*****************************************************************************/
 bool DcgmGroupInfo::AreAllTheSameSku()
 {
     std::unordered_set<unsigned int> uniqueGpuIds;
 
     /* Make a copy of the gpuIds. We're passing by ref to AreAllGpuIdsSameSku() */
-    for (auto const &entity : mEntityList)
+    for (auto const &entity : *mEntityList)
     {
         switch (entity.entityGroupId)
         {
@@ -25,7 +25,9 @@
 #include <atomic>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 /******************************************************************************
@@ -46,6 +48,18 @@ typedef struct
     void *userData;
 } dcgmGroupRemoveCBEntry_t;
 
+/******************************************************************************
+ *
+ * This is a callback to provide DcgmGroupManager to be called after an entity
+ * was added to or removed from a group. It is called without the group manager
+ * lock held, so it may look up the group's entities
+ *
+ * userData IN: A user-supplied pointer that was passed to
+ * DcgmGroupManager::SubscribeForGroupEvents
+ *
+ *****************************************************************************/
+typedef void (*dcgmOnGroupEntitiesChange_f)(unsigned int groupId, void *userData);
+
 /*****************************************************************************/
 
 class DcgmGroupInfo;
@@ -53,6 +67,9 @@ class DcgmGroupInfo;
 class DcgmGroupManager
 {
 public:
+    /* Immutable snapshot of the entities of a group. Holding one doesn't block changes to the group */
+    using EntityListPtr = std::shared_ptr<std::vector<dcgmGroupEntityPair_t> const>;
+
     DcgmGroupManager(DcgmCacheManager *cacheManager, bool createDefaultGroups = true);
     ~DcgmGroupManager();
 
@@ -200,6 +217,20 @@ public:
      */
     dcgmReturn_t GetGroupEntities(unsigned int groupId, std::vector<dcgmGroupEntityPair_t> &entities);
 
+    /*****************************************************************************
+     * This method is used to get a snapshot of the entities of a group without
+     * copying them or taking the group manager lock
+     *
+     * @param groupId      IN  Group to get the entities of
+     * @param entities    OUT: Entities of the group as of this call. Later changes
+     *                         to the group publish a new list rather than modify this one
+     *
+     * @return
+     * DCGM_ST_OK       :   On Success
+     * DCGM_ST_?        :   On Error
+     */
+    dcgmReturn_t GetGroupEntities(unsigned int groupId, EntityListPtr &entities);
+
     /*****************************************************************************
      * Gets Name of the group
      *
@@ -233,11 +264,14 @@ public:
     /*****************************************************************************
      * Subscribe to be notified when events occur for a group
      *
-     * onRemoveCB  IN: Callback to invoke when a group is removed
-     * userData    IN: User data pointer to pass to the callbacks. This can be the
-     *                 "this" of your object.
+     * onRemoveCB          IN: Callback to invoke when a group is removed
+     * userData            IN: User data pointer to pass to the callbacks. This can be the
+     *                         "this" of your object.
+     * onEntitiesChangeCB  IN: Optional callback to invoke after the entities of a group changed
      */
-    void SubscribeForGroupEvents(dcgmOnRemoveGroup_f onRemoveCB, void *userData);
+    void SubscribeForGroupEvents(dcgmOnRemoveGroup_f onRemoveCB,
+                                 void *userData,
+                                 dcgmOnGroupEntitiesChange_f onEntitiesChangeCB = nullptr);
 
     /*****************************************************************************
      * This method is used to create the default groups containing all the GPUs on
@@ -272,6 +306,29 @@ private:
 
     DcgmGroupInfo *GetGroupById(unsigned int groupId);
 
+    /*****************************************************************************
+     * Is groupId one of the groups whose entities are looked up on every call?
+     *
+     * @param groupId        IN  Group to check
+     * @param entityGroupId OUT: Entity group whose entities are the group's entities
+     */
+    bool IsDynamicGroup(unsigned int groupId, dcgm_field_entity_group_t &entityGroupId) const;
+
+    /*****************************************************************************
+     * Call the entity change callbacks for groupId.
+     *
+     * NOTE: Must be called without the group manager locked
+     */
+    void NotifyGroupEntitiesChange(unsigned int groupId);
+
+    /*****************************************************************************
+     * Publish a new snapshot of the group entities where groupId has entities,
+     * or where groupId no longer exists if entities is nullptr
+     *
+     * NOTE: Assumes group manager has been locked with Lock()
+     */
+    void PublishGroupEntities(unsigned int groupId, EntityListPtr entities);
+
     /*****************************************************************************
      * Add every entity of a given entityGroup to this group.
      *
@@ -296,10 +353,19 @@ private:
 
     GroupIdMap mGroupIdMap; /* GroupId -> DcgmGroupInfo object map of all groups */
 
+    using GroupEntitiesMap = std::unordered_map<unsigned int, EntityListPtr>;
+
+    /* GroupId -> entities of every group in mGroupIdMap. A new map is published under mLock whenever a
+       group or its membership changes, so readers can look groups up without the lock */
+    std::atomic<std::shared_ptr<GroupEntitiesMap const>> m_groupEntities;
+
     DcgmCacheManager *mpCacheManager; /* Pointer to the cache manager */
 
     std::vector<dcgmGroupRemoveCBEntry_t> mOnRemoveCBs; /* Callbacks to invoke when a group is removed */
 
+    /* Callbacks to invoke after the entities of a group changed */
+    std::vector<std::pair<dcgmOnGroupEntitiesChange_f, void *>> m_onEntitiesChangeCBs;
+
     bool m_defaultGroupsCreated = false; /* Have we created default groups yet? */
 };
 
@@ -371,6 +437,12 @@ public:
      */
     dcgmReturn_t GetEntities(std::vector<dcgmGroupEntityPair_t> &entities);
 
+    /*****************************************************************************
+     * Get the current entity list of this group without copying it. Adding or
+     * removing entities replaces the list rather than modifying it
+     */
+    DcgmGroupManager::EntityListPtr GetEntityList() const;
+
     /**
      * Checks that all GPUs, directly specified in the group, have the same SKU.
      * For each non-GPU entity in the group, extracts ID of the related GPU and checks that it also have the same SKU.
@@ -383,7 +455,7 @@ public:
 private:
     unsigned int mGroupId;                          /* ID representing GPU group */
     std::string mName;                              /* Name for the group group */
-    std::vector<dcgmGroupEntityPair_t> mEntityList; /* List of entities */
+    DcgmGroupManager::EntityListPtr mEntityList;    /* List of entities. Copied on write */
     dcgm_connection_id_t mConnectionId;             /* Connection ID that created this group */
     DcgmCacheManager *mpCacheManager;               /* Pointer to the cache manager */
 };
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmGroupWatches.h"
+
+#include <algorithm>
+#include <iterator>
+
+/*****************************************************************************/
+bool DcgmGroupWatches::EntityLess(dcgmGroupEntityPair_t const &a, dcgmGroupEntityPair_t const &b)
+{
+    if (a.entityGroupId != b.entityGroupId)
+    {
+        return a.entityGroupId < b.entityGroupId;
+    }
+    return a.entityId < b.entityId;
+}
+
+/*****************************************************************************/
+std::vector<dcgmGroupEntityPair_t> DcgmGroupWatches::SortedUnique(std::vector<dcgmGroupEntityPair_t> entities)
+{
+    std::sort(entities.begin(), entities.end(), EntityLess);
+
+    auto const equal = [](dcgmGroupEntityPair_t const &a, dcgmGroupEntityPair_t const &b) {
+        return !EntityLess(a, b) && !EntityLess(b, a);
+    };
+    entities.erase(std::unique(entities.begin(), entities.end(), equal), entities.end());
+    return entities;
+}
+
+/*****************************************************************************/
+void DcgmGroupWatches::Diff(std::vector<dcgmGroupEntityPair_t> const &before,
+                            std::vector<dcgmGroupEntityPair_t> const &after,
+                            dcgm_group_watch_delta_t &delta)
+{
+    delta.added.clear();
+    delta.removed.clear();
+    std::set_difference(
+        after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(delta.added), EntityLess);
+    std::set_difference(
+        before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(delta.removed), EntityLess);
+}
+
+/*****************************************************************************/
+dcgm_group_watch_delta_t DcgmGroupWatches::Bind(unsigned int groupId,
+                                                unsigned int fieldGroupId,
+                                                DcgmWatcher const &watcher,
+                                                dcgm_group_watch_params_t const &params,
+                                                std::vector<dcgmGroupEntityPair_t> const &entities)
+{
+    dcgm_group_watch_delta_t delta;
+    delta.groupId      = groupId;
+    delta.fieldGroupId = fieldGroupId;
+    delta.watcher      = watcher;
+    delta.params       = params;
+
+    std::vector<dcgmGroupEntityPair_t> sorted = SortedUnique(entities);
+
+    auto it = std::find_if(m_bindings.begin(), m_bindings.end(), [&](Binding const &binding) {
+        return binding.groupId == groupId && binding.fieldGroupId == fieldGroupId && binding.watcher == watcher;
+    });
+
+    if (it == m_bindings.end())
+    {
+        delta.added = sorted;
+        m_bindings.push_back(Binding { groupId, fieldGroupId, watcher, params, std::move(sorted) });
+        return delta;
+    }
+
+    Diff(it->entities, sorted, delta);
+    if (it->params != params)
+    {
+        /* The entities that stay have to be watched again to pick up the new params */
+        delta.added = sorted;
+    }
+
+    it->params   = params;
+    it->entities = std::move(sorted);
+    return delta;
+}
+
+/*****************************************************************************/
+bool DcgmGroupWatches::Unbind(unsigned int groupId,
+                              unsigned int fieldGroupId,
+                              DcgmWatcher const &watcher,
+                              std::vector<dcgmGroupEntityPair_t> &entities)
+{
+    auto it = std::find_if(m_bindings.begin(), m_bindings.end(), [&](Binding const &binding) {
+        return binding.groupId == groupId && binding.fieldGroupId == fieldGroupId && binding.watcher == watcher;
+    });
+    if (it == m_bindings.end())
+    {
+        return false;
+    }
+
+    entities = std::move(it->entities);
+    m_bindings.erase(it);
+    return true;
+}
+
+/*****************************************************************************/
+std::vector<dcgm_group_watch_delta_t> DcgmGroupWatches::SetGroupEntities(
+    unsigned int groupId,
+    std::vector<dcgmGroupEntityPair_t> const &entities)
+{
+    std::vector<dcgm_group_watch_delta_t> deltas;
+    std::vector<dcgmGroupEntityPair_t> const sorted = SortedUnique(entities);
+
+    for (auto &binding : m_bindings)
+    {
+        if (binding.groupId != groupId)
+        {
+            continue;
+        }
+
+        dcgm_group_watch_delta_t delta;
+        Diff(binding.entities, sorted, delta);
+        if (delta.Empty())
+        {
+            continue;
+        }
+
+        delta.groupId      = groupId;
+        delta.fieldGroupId = binding.fieldGroupId;
+        delta.watcher      = binding.watcher;
+        delta.params       = binding.params;
+        binding.entities   = sorted;
+        deltas.push_back(std::move(delta));
+    }
+
+    return deltas;
+}
+
+/*****************************************************************************/
+void DcgmGroupWatches::RemoveGroup(unsigned int groupId)
+{
+    std::erase_if(m_bindings, [groupId](Binding const &binding) { return binding.groupId == groupId; });
+}
+
+/*****************************************************************************/
+void DcgmGroupWatches::RemoveConnection(dcgm_connection_id_t connectionId)
+{
+    std::erase_if(m_bindings,
+                  [connectionId](Binding const &binding) { return binding.watcher.connectionId == connectionId; });
+}
+
+/*****************************************************************************/
+bool DcgmGroupWatches::HasGroup(unsigned int groupId) const
+{
+    return std::any_of(
+        m_bindings.begin(), m_bindings.end(), [groupId](Binding const &binding) { return binding.groupId == groupId; });
+}
+
+/*****************************************************************************/
+std::size_t DcgmGroupWatches::GetCount() const
+{
+    return m_bindings.size();
+}
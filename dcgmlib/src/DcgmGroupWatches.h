@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmWatcher.h"
+#include "dcgm_structs.h"
+#include "timelib.h"
+
+#include <cstddef>
+#include <vector>
+
+/*****************************************************************************/
+/* How a field group watch samples each entity it covers */
+struct dcgm_group_watch_params_t
+{
+    timelib64_t monitorIntervalUsec = 0;
+    double maxSampleAge             = 0.0;
+    int maxKeepSamples              = 0;
+    bool subscribeForUpdates        = false;
+
+    bool operator==(dcgm_group_watch_params_t const &other) const = default;
+};
+
+/*****************************************************************************/
+/* Entities a field group watch has to start or stop watching */
+struct dcgm_group_watch_delta_t
+{
+    unsigned int groupId      = 0;
+    unsigned int fieldGroupId = 0;
+    DcgmWatcher watcher;
+    dcgm_group_watch_params_t params;
+    std::vector<dcgmGroupEntityPair_t> added;   /* Watch the field group on these */
+    std::vector<dcgmGroupEntityPair_t> removed; /* Unwatch the field group on these */
+
+    bool Empty() const
+    {
+        return added.empty() && removed.empty();
+    }
+};
+
+/*****************************************************************************/
+/*
+ * Field group watches bound to the group they were made on, with the entities
+ * each one watches in the cache manager.
+ *
+ * When the group's entities change, or the same watch is made again, only the
+ * entities that were added or removed since have to be watched or unwatched,
+ * so the watch churn and the time spent under the cache manager lock grow with
+ * the change rather than with the group.
+ *
+ * This doesn't lock. The host engine serializes calls together with the cache
+ * manager changes they lead to, so deltas are applied in the order they were
+ * computed.
+ */
+class DcgmGroupWatches
+{
+public:
+    /*************************************************************************/
+    /*
+     * Bind the watch of fieldGroupId by watcher to groupId, covering entities.
+     * An existing binding of the same groupId, fieldGroupId and watcher is replaced.
+     *
+     * RETURNS: The entities that weren't covered before, and those that no longer are.
+     *          Every entity is added if the binding is new or params changed
+     */
+    dcgm_group_watch_delta_t Bind(unsigned int groupId,
+                                  unsigned int fieldGroupId,
+                                  DcgmWatcher const &watcher,
+                                  dcgm_group_watch_params_t const &params,
+                                  std::vector<dcgmGroupEntityPair_t> const &entities);
+
+    /*************************************************************************/
+    /*
+     * Remove the binding of groupId, fieldGroupId and watcher.
+     *
+     * RETURNS: true and sets entities to the entities it covered
+     *          false if there was no such binding
+     */
+    bool Unbind(unsigned int groupId,
+                unsigned int fieldGroupId,
+                DcgmWatcher const &watcher,
+                std::vector<dcgmGroupEntityPair_t> &entities);
+
+    /*************************************************************************/
+    /*
+     * Note that groupId now has entities.
+     *
+     * RETURNS: What changed for each binding of groupId. Bindings that already covered entities are left out
+     */
+    std::vector<dcgm_group_watch_delta_t> SetGroupEntities(unsigned int groupId,
+                                                           std::vector<dcgmGroupEntityPair_t> const &entities);
+
+    /*************************************************************************/
+    /*
+     * Drop the bindings of groupId or of watchers of connectionId without
+     * returning what they watched. Used when the group or connection goes away
+     */
+    void RemoveGroup(unsigned int groupId);
+    void RemoveConnection(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    bool HasGroup(unsigned int groupId) const;
+    std::size_t GetCount() const;
+
+private:
+    struct Binding
+    {
+        unsigned int groupId;
+        unsigned int fieldGroupId;
+        DcgmWatcher watcher;
+        dcgm_group_watch_params_t params;
+        std::vector<dcgmGroupEntityPair_t> entities; /* Sorted by EntityLess and unique */
+    };
+
+    /*************************************************************************/
+    static bool EntityLess(dcgmGroupEntityPair_t const &a, dcgmGroupEntityPair_t const &b);
+    static std::vector<dcgmGroupEntityPair_t> SortedUnique(std::vector<dcgmGroupEntityPair_t> entities);
+
+    /*************************************************************************/
+    /* Set added and removed of delta to what changes going from before to after. Both are sorted */
+    static void Diff(std::vector<dcgmGroupEntityPair_t> const &before,
+                     std::vector<dcgmGroupEntityPair_t> const &after,
+                     dcgm_group_watch_delta_t &delta);
+
+    std::vector<Binding> m_bindings;
+};
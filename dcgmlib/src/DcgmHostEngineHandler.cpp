@@ -23,6 +23,7 @@
 #include "DcgmGroupManager.h"
 
 #include <DcgmLogging.h>
+#include <DcgmMessagePool.h>
 #include <DcgmMetadataMgr.h>
 #include <DcgmModule.h>
 #include <DcgmModuleHealth.h>
@@ -30,6 +31,10 @@
 #include <DcgmModulePolicy.h>
 #include <DcgmSettings.h>
 #include <DcgmStatus.h>
+#include <DcgmStringHelpers.h>
+#include <DcgmTrace.h>
+#include <TimeLib.hpp>
+#include <dcgm_diag_structs.h>
 #include <dcgm_health_structs.h>
 #include <dcgm_helpers.h>
 #include <dcgm_nvswitch_structs.h>
@@ -42,6 +47,7 @@
 #include <nvcmvalue.h>
 
 #include <algorithm>
+#include <chrono>
 #include <dlfcn.h> //dlopen, dlsym..etc
 #include <iostream>
 #include <sstream>
@@ -839,7 +845,7 @@ dcgmReturn_t DcgmHostEngineHandler::HelperModuleDenylist(dcgmModuleId_t moduleId
 /*****************************************************************************/
 dcgmReturn_t DcgmHostEngineHandler::HelperModuleStatus(dcgmModuleGetStatuses_v1 &msg)
 {
-    if (msg.version != dcgmModuleGetStatuses_version)
+    if (msg.version != dcgmModuleGetStatuses_version1)
     {
         DCGM_LOG_ERROR << "Version mismatch";
         return DCGM_ST_VER_MISMATCH;
@@ -861,8 +867,37 @@ dcgmReturn_t DcgmHostEngineHandler::HelperModuleStatus(dcgmModuleGetStatuses_v1
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmHostEngineHandler::HelperGetFieldSummary(dcgmFieldSummaryRequest_t &fieldSummary)
+dcgmReturn_t DcgmHostEngineHandler::HelperModuleStatus(dcgmModuleGetStatuses_v2 &msg)
 {
+    if (msg.version != dcgmModuleGetStatuses_version2)
+    {
+        DCGM_LOG_ERROR << "Version mismatch";
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    /* Note: not locking here because we're not looking at anything sensitive */
+
+    msg.numStatuses = 0;
+    for (unsigned int moduleId = DcgmModuleIdCore;
+         moduleId < DcgmModuleIdCount && msg.numStatuses < DCGM_MODULE_STATUSES_CAPACITY;
+         moduleId++)
+    {
+        msg.statuses[msg.numStatuses]              = {};
+        msg.statuses[msg.numStatuses].id           = m_modules[moduleId].id;
+        msg.statuses[msg.numStatuses].status       = m_modules[moduleId].status;
+        msg.statuses[msg.numStatuses].loadPolicy   = m_modules[moduleId].loadPolicy;
+        msg.statuses[msg.numStatuses].initTimeUsec = m_modules[moduleId].initTimeUsec;
+        msg.numStatuses++;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::HelperGetFieldSummary(dcgmFieldSummaryRequest_v2 &fieldSummary)
+{
+    static_assert(DcgmcmSummaryTypeSize == DCGM_SUMMARY_SIZE_V2, "DCGM_SUMMARY_* out of sync with DcgmcmSummaryType_t");
+
     dcgmReturn_t ret;
     dcgm_field_meta_p fm = DcgmFieldGetById(fieldSummary.fieldId);
 
@@ -871,6 +906,13 @@ dcgmReturn_t DcgmHostEngineHandler::HelperGetFieldSummary(dcgmFieldSummaryReques
         return DCGM_ST_BADPARAM;
     }
 
+    if (fieldSummary.histogramBucketCount > DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS)
+    {
+        log_error(
+            "histogramBucketCount {} > {}", fieldSummary.histogramBucketCount, DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS);
+        return DCGM_ST_BADPARAM;
+    }
+
     int numSummaryTypes   = 0;
     timelib64_t startTime = fieldSummary.startTime;
     timelib64_t endTime   = fieldSummary.endTime;
@@ -952,6 +994,25 @@ dcgmReturn_t DcgmHostEngineHandler::HelperGetFieldSummary(dcgmFieldSummaryReques
         }
     }
 
+    memset(fieldSummary.response.histogramCounts, 0, sizeof(fieldSummary.response.histogramCounts));
+
+    if (ret == DCGM_ST_OK && fieldSummary.histogramBucketCount > 0)
+    {
+        DcgmQuantileSketch sketch;
+        dcgmReturn_t sketchRet = mpCacheManager->GetSummarySketch(
+            entityGroupId, fieldSummary.entityId, fieldSummary.fieldId, startTime, endTime, sketch);
+        if (sketchRet != DCGM_ST_OK)
+        {
+            /* Only possible if the samples were removed since the summaries were read */
+            log_debug("GetSummarySketch returned {}", (int)sketchRet);
+        }
+
+        sketch.GetHistogram(fieldSummary.histogramMin,
+                            fieldSummary.histogramMax,
+                            fieldSummary.histogramBucketCount,
+                            fieldSummary.response.histogramCounts);
+    }
+
     return ret;
 }
 
@@ -962,8 +1023,6 @@ dcgmReturn_t DcgmHostEngineHandler::SendRawMessageToEmbeddedClient(unsigned int
                                                                    int msgLength,
                                                                    dcgmReturn_t status)
 {
-    watchedRequests_t::iterator requestIt;
-
     /* Embedded client */
     if (requestId == DCGM_REQUEST_ID_NONE)
     {
@@ -971,15 +1030,6 @@ dcgmReturn_t DcgmHostEngineHandler::SendRawMessageToEmbeddedClient(unsigned int
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    auto lock = Lock();
-
-    requestIt = m_watchedRequests.find(requestId);
-    if (requestIt == m_watchedRequests.end())
-    {
-        log_error("SendRawMessageToEmbeddedClient unable to find requestId {}", requestId);
-        return DCGM_ST_BADPARAM;
-    }
-
     /* ProcessMessage is expecting an allocated message */
     std::unique_ptr<DcgmMessage> msg = std::make_unique<DcgmMessage>();
     msg->UpdateMsgHdr(msgType, requestId, status, msgLength);
@@ -989,8 +1039,13 @@ dcgmReturn_t DcgmHostEngineHandler::SendRawMessageToEmbeddedClient(unsigned int
     msgBytes->resize(msgLength);
     memcpy(msgBytes->data(), msgData, msgLength);
 
-    requestIt->second->ProcessMessage(std::move(msg));
-    return DCGM_ST_OK;
+    /* Delivered outside of the requests lock, since the callback of the request may call back into us */
+    dcgmReturn_t ret = m_watchedRequests.Deliver(requestId, std::move(msg));
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("SendRawMessageToEmbeddedClient unable to find requestId {}", requestId);
+    }
+    return ret;
 }
 
 /*****************************************************************************/
@@ -1007,7 +1062,7 @@ dcgmReturn_t DcgmHostEngineHandler::SendRawMessageToClient(dcgm_connection_id_t
     }
 
     /* Copy the raw message to a message object that we will move to DcgmIpc */
-    std::unique_ptr<DcgmMessage> dcgmMessage = std::make_unique<DcgmMessage>();
+    std::unique_ptr<DcgmMessage> dcgmMessage = DcgmMessagePool::GetInstance().Get(msgLength);
 
     dcgmMessage->UpdateMsgHdr(msgType, requestId, status, msgLength);
 
@@ -1066,11 +1121,42 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommand(dcgm_module_command_hea
     if (moduleCommand->moduleId == DcgmModuleIdCore && moduleCommand->subCommand == DCGM_CORE_SR_PAUSE_RESUME)
     {
         /* Pause and resume command are dispatched to all modules in specific order */
-        return ProcessPauseResume(reinterpret_cast<dcgm_core_msg_pause_resume_v1 *>(moduleCommand));
+        dcgmReturn = ProcessPauseResume(reinterpret_cast<dcgm_core_msg_pause_resume_v1 *>(moduleCommand));
+    }
+    else
+    {
+        /* Dispatch the message */
+        dcgmReturn = SendModuleMessage(moduleCommand->moduleId, moduleCommand);
+    }
+
+    if (dcgmReturn == DCGM_ST_OK && moduleCommand->moduleId == DcgmModuleIdCore)
+    {
+        /* Before the response is sent, so that the client that made the change already sees the new generation.
+           A change that failed with an error in its cmdRet bumps it too, which only costs clients a refetch */
+        switch (moduleCommand->subCommand)
+        {
+            case DCGM_CORE_SR_MIG_ENTITY_CREATE:
+            case DCGM_CORE_SR_MIG_ENTITY_DELETE:
+            case DCGM_CORE_SR_CREATE_GROUP:
+            case DCGM_CORE_SR_REMOVE_ENTITY:
+            case DCGM_CORE_SR_GROUP_ADD_ENTITY:
+            case DCGM_CORE_SR_SET_ENTITY_LINK_STATE:
+            case DCGM_CORE_SR_FIELDGROUP_CREATE:
+            case DCGM_CORE_SR_FIELDGROUP_DESTROY:
+            case DCGM_CORE_SR_CREATE_FAKE_ENTITIES:
+            case DCGM_CORE_SR_NVML_CREATE_FAKE_ENTITY:
+            case DCGM_CORE_SR_PAUSE_RESUME:
+            case DCGM_CORE_SR_REMOVE_NVML_INJECTED_GPU:
+            case DCGM_CORE_SR_RESTORE_NVML_INJECTED_GPU:
+                BumpMetadataGeneration();
+                break;
+            default:
+                /* Group destruction is handled by OnGroupRemove() */
+                break;
+        }
     }
 
-    /* Dispatch the message */
-    return SendModuleMessage(moduleCommand->moduleId, moduleCommand);
+    return dcgmReturn;
 }
 
 /*****************************************************************************/
@@ -1082,13 +1168,27 @@ dcgmReturn_t DcgmHostEngineHandler::GetCacheManagerFieldInfo(dcgmCacheManagerFie
 /*****************************************************************************/
 void DcgmHostEngineHandler::OnConnectionRemove(dcgm_connection_id_t connectionId)
 {
+    /* The connection's watches are removed by the cache manager below */
+    m_fvStreams.RemoveConnection(connectionId);
+    /* Before the profiling module drops the connection's watches, so no pass is watched again */
+    m_profMultiplexer.RemoveConnection(connectionId);
+    m_valuesCursors.RemoveConnection(connectionId);
+    {
+        std::lock_guard<std::mutex> lock(m_metadataMutex);
+        m_metadataSubscribers.erase(connectionId);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_groupWatchesMutex);
+        m_groupWatches.RemoveConnection(connectionId);
+    }
+
     if (mpGroupManager != nullptr)
     {
         mpGroupManager->OnConnectionRemove(connectionId);
     }
-    if (mpFieldGroupManager != nullptr)
+    if (mpFieldGroupManager != nullptr && mpFieldGroupManager->OnConnectionRemove(connectionId))
     {
-        mpFieldGroupManager->OnConnectionRemove(connectionId);
+        BumpMetadataGeneration();
     }
     /* Call the cache manager last since the rest of the modules refer to it */
     if (mpCacheManager != nullptr)
@@ -1117,34 +1217,36 @@ void DcgmHostEngineHandler::OnConnectionRemove(dcgm_connection_id_t connectionId
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t connectionId,
-                                                            std::unique_ptr<DcgmMessage> message)
+dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandBytes(dcgm_connection_id_t connectionId,
+                                                              dcgm_request_id_t requestId,
+                                                              std::vector<char> &commandBytes,
+                                                              dcgmReturn_t &requestStatus)
 {
-    dcgmReturn_t retSt = DCGM_ST_OK;
-
-    auto msgBytes  = message->GetMsgBytesPtr();
-    auto msgHeader = message->GetMessageHdr();
-
 /* Resize our buffer to be the maximum size of a DCGM message. This is so
    the module command response can be larger than the request
-
    Note: We aren't doing this for now since we don't have any assymetric requests
    where module commands have different response size from request size.
 
    This avoids the performance penalty of allocating and zeroing 4 MB of memory
    on every user request */
 #if 0
-    msgBytes->resize(DCGM_PROTO_MAX_MESSAGE_SIZE);
+    commandBytes.resize(DCGM_PROTO_MAX_MESSAGE_SIZE);
 #endif
 
-    auto moduleCommand = (dcgm_module_command_header_t *)msgBytes->data();
+    if (commandBytes.size() < sizeof(dcgm_module_command_header_t))
+    {
+        DCGM_LOG_ERROR << "Module command of " << commandBytes.size() << " bytes is too short";
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto moduleCommand = (dcgm_module_command_header_t *)commandBytes.data();
 
     /* Verify that we didn't get a malicious moduleCommand->length. This also implicitly
        checks that our message isn't larger than DCGM_PROTO_MAX_MESSAGE_SIZE
        since DcgmIpc checks that when it assembles messages from the socket stream. */
-    if (moduleCommand->length != message->GetLength())
+    if (moduleCommand->length != commandBytes.size())
     {
-        DCGM_LOG_ERROR << "Module command has bad length " << moduleCommand->length << " != " << message->GetLength();
+        DCGM_LOG_ERROR << "Module command has bad length " << moduleCommand->length << " != " << commandBytes.size();
         return DCGM_ST_BADPARAM;
     }
 
@@ -1154,30 +1256,40 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t
         switch (moduleCommand->subCommand)
         {
             case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V3:
-                msgBytes->resize(sizeof(dcgm_core_msg_entities_get_latest_values_v3));
-                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                commandBytes.resize(sizeof(dcgm_core_msg_entities_get_latest_values_v3));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
                 moduleCommand->length = sizeof(dcgm_core_msg_entities_get_latest_values_v3);
                 break;
             case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V2:
-                msgBytes->resize(sizeof(dcgm_core_msg_entities_get_latest_values_v2));
-                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                commandBytes.resize(sizeof(dcgm_core_msg_entities_get_latest_values_v2));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
                 moduleCommand->length = sizeof(dcgm_core_msg_entities_get_latest_values_v2);
                 break;
             case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V1:
-                msgBytes->resize(sizeof(dcgm_core_msg_entities_get_latest_values_v1));
-                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                commandBytes.resize(sizeof(dcgm_core_msg_entities_get_latest_values_v1));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
                 moduleCommand->length = sizeof(dcgm_core_msg_entities_get_latest_values_v1);
                 break;
             case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V1:
-                msgBytes->resize(sizeof(dcgm_core_msg_get_multiple_values_for_field_v1));
-                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                commandBytes.resize(sizeof(dcgm_core_msg_get_multiple_values_for_field_v1));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
                 moduleCommand->length = sizeof(dcgm_core_msg_get_multiple_values_for_field_v1);
                 break;
             case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V2:
-                msgBytes->resize(sizeof(dcgm_core_msg_get_multiple_values_for_field_v2));
-                moduleCommand         = (dcgm_module_command_header_t *)msgBytes->data();
+                commandBytes.resize(sizeof(dcgm_core_msg_get_multiple_values_for_field_v2));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
                 moduleCommand->length = sizeof(dcgm_core_msg_get_multiple_values_for_field_v2);
                 break;
+            case DCGM_CORE_SR_VALUES_CURSOR_NEXT:
+                commandBytes.resize(sizeof(dcgm_core_msg_values_cursor_v1));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
+                moduleCommand->length = sizeof(dcgm_core_msg_values_cursor_v1);
+                break;
+            case DCGM_CORE_SR_RESAMPLE_VALUES:
+                commandBytes.resize(sizeof(dcgm_core_msg_resample_values_v1));
+                moduleCommand         = (dcgm_module_command_header_t *)commandBytes.data();
+                moduleCommand->length = sizeof(dcgm_core_msg_resample_values_v1);
+                break;
             default:
                 /* No need to resize */
                 break;
@@ -1185,24 +1297,208 @@ dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t
     }
 
     if (moduleCommand->requestId == DCGM_REQUEST_ID_NONE)
-        moduleCommand->requestId = msgHeader->requestId;
+        moduleCommand->requestId = requestId;
 
     moduleCommand->connectionId = connectionId;
 
-    dcgmReturn_t requestStatus = ProcessModuleCommand(moduleCommand);
+    m_inflightRequests.SetCurrentCommand(moduleCommand->moduleId, moduleCommand->subCommand);
+
+    requestStatus = ProcessModuleCommand(moduleCommand);
 
     /* Resize msgBytes to whatever moduleCommand's updated size is */
-    msgBytes->resize(moduleCommand->length);
+    commandBytes.resize(moduleCommand->length);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandMsg(dcgm_connection_id_t connectionId,
+                                                            std::unique_ptr<DcgmMessage> message)
+{
+    DcgmNs::Trace::Scope traceScope("ProcessModuleCommandMsg", "connectionId", connectionId);
+
+    auto msgBytes  = message->GetMsgBytesPtr();
+    auto msgHeader = message->GetMessageHdr();
+
+    DcgmInflightRequests::Scope inflight(m_inflightRequests, connectionId, msgHeader->requestId, msgHeader->timeoutMs);
+
+    dcgmReturn_t requestStatus = DCGM_ST_OK;
+    dcgmReturn_t retSt = ProcessModuleCommandBytes(connectionId, msgHeader->requestId, *msgBytes, requestStatus);
+    if (retSt != DCGM_ST_OK)
+    {
+        return retSt;
+    }
+
+    auto moduleCommand = (dcgm_module_command_header_t *)msgBytes->data();
 
     message->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, moduleCommand->requestId, requestStatus, moduleCommand->length);
 
     m_dcgmIpc.SendMessage(connectionId, std::move(message), false);
-    return retSt;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::ProcessModuleCommandBatchMsg(dcgm_connection_id_t connectionId,
+                                                                 std::unique_ptr<DcgmMessage> message)
+{
+    auto msgBytes  = message->GetMsgBytesPtr();
+    auto msgHeader = message->GetMessageHdr();
+    dcgm_msg_module_command_batch_t batch {};
+
+    DcgmInflightRequests::Scope inflight(m_inflightRequests, connectionId, msgHeader->requestId, msgHeader->timeoutMs);
+
+    if (msgBytes->size() < sizeof(batch))
+    {
+        DCGM_LOG_ERROR << "Module command batch of " << msgBytes->size() << " bytes is too short";
+        return DCGM_ST_BADPARAM;
+    }
+
+    memcpy(&batch, msgBytes->data(), sizeof(batch));
+    if (batch.numCommands == 0 || batch.numCommands > DCGM_MSG_MODULE_COMMAND_BATCH_MAX)
+    {
+        DCGM_LOG_ERROR << "Module command batch has bad numCommands " << batch.numCommands;
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* Validate the layout of the whole batch before processing any of it so that a
+       malformed batch has no side effects */
+    std::vector<std::pair<size_t, unsigned int>> commands; /* Offset and length of each command */
+    commands.reserve(batch.numCommands);
+    size_t offset = sizeof(batch);
+
+    for (unsigned int i = 0; i < batch.numCommands; i++)
+    {
+        dcgm_msg_module_command_batch_entry_t entry {};
+        if (msgBytes->size() - offset < sizeof(entry))
+        {
+            DCGM_LOG_ERROR << "Module command batch is truncated at entry " << i;
+            return DCGM_ST_BADPARAM;
+        }
+
+        memcpy(&entry, msgBytes->data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        if (msgBytes->size() - offset < entry.length)
+        {
+            DCGM_LOG_ERROR << "Module command batch entry " << i << " of length " << entry.length << " is truncated";
+            return DCGM_ST_BADPARAM;
+        }
+
+        commands.emplace_back(offset, entry.length);
+        offset += std::min(DCGM_MSG_MODULE_COMMAND_BATCH_PADDED(entry.length), msgBytes->size() - offset);
+    }
+
+    std::vector<char> response;
+    response.reserve(msgBytes->size());
+    response.insert(response.end(), (char *)&batch, (char *)&batch + sizeof(batch));
+
+    std::vector<char> commandBytes;
+
+    for (auto const &[commandOffset, commandLength] : commands)
+    {
+        commandBytes.assign(msgBytes->data() + commandOffset, msgBytes->data() + commandOffset + commandLength);
+
+        dcgmReturn_t requestStatus = DCGM_ST_OK;
+        dcgmReturn_t dcgmReturn    = DCGM_ST_TIMEOUT;
+        if (!DcgmInflightRequests::ShouldStop())
+        {
+            dcgmReturn = ProcessModuleCommandBytes(connectionId, msgHeader->requestId, commandBytes, requestStatus);
+        }
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            /* Echo the command back unprocessed with the error */
+            requestStatus = dcgmReturn;
+        }
+
+        size_t paddedLength = DCGM_MSG_MODULE_COMMAND_BATCH_PADDED(commandBytes.size());
+        if (response.size() + sizeof(dcgm_msg_module_command_batch_entry_t) + paddedLength
+            > DCGM_PROTO_MAX_MESSAGE_SIZE)
+        {
+            DCGM_LOG_ERROR << "Module command batch response for connectionId " << connectionId
+                           << " would exceed the maximum message size";
+            requestStatus = DCGM_ST_INSUFFICIENT_SIZE;
+            commandBytes.clear();
+            paddedLength = 0;
+        }
+
+        dcgm_msg_module_command_batch_entry_t entry {};
+        entry.status = requestStatus;
+        entry.length = commandBytes.size();
+        response.insert(response.end(), (char *)&entry, (char *)&entry + sizeof(entry));
+        response.insert(response.end(), commandBytes.begin(), commandBytes.end());
+        response.resize(response.size() + (paddedLength - commandBytes.size()), 0);
+    }
+
+    *msgBytes = std::move(response);
+    message->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND_BATCH, msgHeader->requestId, DCGM_ST_OK, msgBytes->size());
+
+    DCGM_LOG_DEBUG << "Processed batch of " << batch.numCommands << " module commands for connectionId "
+                   << connectionId;
+
+    m_dcgmIpc.SendMessage(connectionId, std::move(message), false);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+bool DcgmHostEngineHandler::IsServedDuringInit(DcgmMessage &message)
+{
+    if (message.GetMsgType() != DCGM_MSG_MODULE_COMMAND)
+    {
+        return false;
+    }
+
+    auto const *msgBytes = message.GetMsgBytesPtr();
+    if (msgBytes->size() < sizeof(dcgm_module_command_header_t))
+    {
+        return false;
+    }
+
+    auto const *moduleCommand = (dcgm_module_command_header_t const *)msgBytes->data();
+    if (moduleCommand->moduleId != DcgmModuleIdCore)
+    {
+        return false;
+    }
+
+    switch (moduleCommand->subCommand)
+    {
+        case DCGM_CORE_SR_HOSTENGINE_VERSION:
+        case DCGM_CORE_SR_HOSTENGINE_HEALTH:
+        case DCGM_CORE_SR_CLIENT_LOGIN:
+            return true;
+
+        default:
+            return false;
+    }
 }
 
 /*****************************************************************************/
 void DcgmHostEngineHandler::ProcessMessage(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message)
 {
+    if (!m_initDone.load(std::memory_order_acquire) && !IsServedDuringInit(*message))
+    {
+        std::lock_guard<std::mutex> lg(m_pendingRequestsMutex);
+        if (!m_initDone.load(std::memory_order_relaxed))
+        {
+            m_pendingRequests.emplace_back(connectionId, std::move(message));
+            return;
+        }
+    }
+
+    DispatchMessage(connectionId, std::move(message));
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::DispatchMessage(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message)
+{
+    if (!IsServedDuringInit(*message) && m_initResult != DCGM_ST_OK)
+    {
+        /* The host engine is about to exit. Don't leave the client waiting until then */
+        auto msgHeader = message->GetMessageHdr();
+        message->UpdateMsgHdr(
+            message->GetMsgType(), msgHeader->requestId, m_initResult, message->GetMsgBytesPtr()->size());
+        m_dcgmIpc.SendMessage(connectionId, std::move(message), false);
+        return;
+    }
+
     switch (message->GetMsgType())
     {
         case DCGM_MSG_PROTO_REQUEST:
@@ -1214,6 +1510,10 @@ void DcgmHostEngineHandler::ProcessMessage(dcgm_connection_id_t connectionId, st
             ProcessModuleCommandMsg(connectionId, std::move(message));
             break;
 
+        case DCGM_MSG_MODULE_COMMAND_BATCH:
+            ProcessModuleCommandBatchMsg(connectionId, std::move(message));
+            break;
+
         default:
             DCGM_LOG_ERROR << "Unable to process msgType 0x" << std::hex << message->GetMsgType();
             break;
@@ -1352,9 +1652,25 @@ static void HostEngineOnGroupEventCB(unsigned int groupId, void *userData)
     hostEngineHandler->OnGroupRemove(groupId);
 }
 
+/*****************************************************************************/
+static void HostEngineOnGroupEntitiesChangeCB(unsigned int groupId, void *userData)
+{
+    auto *hostEngineHandler = (DcgmHostEngineHandler *)userData;
+
+    hostEngineHandler->OnGroupEntitiesChange(groupId);
+}
+
 /*****************************************************************************/
 void DcgmHostEngineHandler::OnGroupRemove(unsigned int groupId)
 {
+    BumpMetadataGeneration();
+
+    {
+        /* The watches themselves are removed by the owner or with its connection */
+        std::lock_guard<std::mutex> lock(m_groupWatchesMutex);
+        m_groupWatches.RemoveGroup(groupId);
+    }
+
     /* Notify each module about the client disconnect */
     dcgm_core_msg_group_removed_t msg;
     memset(&msg, 0, sizeof(msg));
@@ -1374,71 +1690,278 @@ void DcgmHostEngineHandler::OnGroupRemove(unsigned int groupId)
 }
 
 /*****************************************************************************/
-void DcgmHostEngineHandler::OnFvUpdates(DcgmFvBuffer *fvBuffer,
-                                        DcgmWatcherType_t *watcherTypes,
-                                        int numWatcherTypes,
-                                        void * /*userData*/)
+void DcgmHostEngineHandler::OnGroupEntitiesChange(unsigned int groupId)
 {
-    static dcgmModuleId_t watcherToModuleMap[DcgmWatcherTypeCount]
-        = { DcgmModuleIdCore, DcgmModuleIdCore, DcgmModuleIdHealth,  DcgmModuleIdPolicy,
-            DcgmModuleIdCore, DcgmModuleIdCore, DcgmModuleIdNvSwitch };
+    std::vector<dcgmGroupEntityPair_t> entities;
 
-    /* prepare the message for sending to modules */
-    dcgm_core_msg_field_values_updated_t msg;
-    size_t elementCount = 0;
-    memset(&msg, 0, sizeof(msg));
-    msg.header.length      = sizeof(msg);
-    msg.header.version     = dcgm_core_msg_field_values_updated_version;
-    msg.header.subCommand  = DCGM_CORE_SR_FIELD_VALUES_UPDATED;
-    msg.fieldValues.buffer = fvBuffer->GetBuffer();
-    fvBuffer->GetSize(&msg.fieldValues.bufferSize, &elementCount);
+    std::lock_guard<std::mutex> lock(m_groupWatchesMutex);
 
-    /* Dispatch each watcher to the corresponding module */
-    dcgmModuleId_t destinationModuleId;
-    int i;
+    if (!m_groupWatches.HasGroup(groupId))
+    {
+        return;
+    }
 
-    for (i = 0; i < numWatcherTypes; i++)
+    /* Read under the lock so that the last change of the group is the last one applied */
+    dcgmReturn_t dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    if (dcgmReturn != DCGM_ST_OK)
     {
-        destinationModuleId = watcherToModuleMap[watcherTypes[i]];
-        if (destinationModuleId == DcgmModuleIdCore)
+        log_error("Error {} from GetGroupEntities() for group {}", (int)dcgmReturn, groupId);
+        return;
+    }
+
+    bool shouldUpdateAllFields = false;
+
+    for (auto const &delta : m_groupWatches.SetGroupEntities(groupId, entities))
+    {
+        std::vector<unsigned short> fieldIds;
+        dcgmReturn = mpFieldGroupManager->GetFieldGroupFields((dcgmFieldGrp_t)delta.fieldGroupId, fieldIds);
+        if (dcgmReturn != DCGM_ST_OK)
         {
-            log_error("Unhandled watcherType {} can't be dispatched to a module.", watcherTypes[i]);
+            log_error("Got {} from GetFieldGroupFields() for field group {}", (int)dcgmReturn, delta.fieldGroupId);
             continue;
         }
 
-        if (m_modules[destinationModuleId].ptr == nullptr)
+        log_debug("Group {} field group {}: watching {} and unwatching {} entities",
+                  groupId,
+                  delta.fieldGroupId,
+                  delta.added.size(),
+                  delta.removed.size());
+
+        /* Errors are logged by ApplyGroupWatchDelta. There is no one to return them to */
+        ApplyGroupWatchDelta(delta, fieldIds, shouldUpdateAllFields);
+    }
+
+    if (shouldUpdateAllFields)
+    {
+        dcgmReturn = mpCacheManager->UpdateAllFields(1);
+        if (dcgmReturn != DCGM_ST_OK)
         {
-            log_debug("Skipping FV update for moduleId {} that is not loaded.", destinationModuleId);
-            continue;
+            log_error("Got {} from UpdateAllFields()", (int)dcgmReturn);
         }
-
-        SendModuleMessage((dcgmModuleId_t)destinationModuleId, (dcgm_module_command_header_t *)&msg);
     }
 }
 
 /*****************************************************************************/
-void DcgmHostEngineHandler::OnMigUpdates(unsigned int gpuId)
+dcgmReturn_t DcgmHostEngineHandler::ApplyGroupWatchDelta(dcgm_group_watch_delta_t const &delta,
+                                                         std::vector<unsigned short> const &fieldIds,
+                                                         bool &shouldUpdateAllFields)
 {
-    dcgm_core_msg_mig_updated_t msg;
-    memset(&msg, 0, sizeof(msg));
-    msg.header.length     = sizeof(msg);
-    msg.header.moduleId   = DcgmModuleIdCore;
-    msg.header.subCommand = DCGM_CORE_SR_MIG_UPDATED;
-    msg.header.version    = dcgm_core_msg_mig_updated_version;
-    msg.gpuId             = gpuId;
+    dcgmReturn_t retSt = DCGM_ST_OK;
 
-    for (auto &m_module : m_modules)
+    if (!delta.removed.empty())
     {
-        if (m_module.ptr == nullptr)
+        retSt = mpCacheManager->RemoveFieldWatches(delta.removed, fieldIds, 0, delta.watcher);
+        if (retSt != DCGM_ST_OK)
         {
-            /* Module not loaded */
-            continue;
+            log_error("RemoveFieldWatches({} entities, {} fields) returned {}",
+                      delta.removed.size(),
+                      fieldIds.size(),
+                      (int)retSt);
         }
+    }
 
-        if (m_module.id == DcgmModuleIdCore)
+    if (!delta.added.empty())
+    {
+        bool anyFirstWatcher    = false;
+        dcgmReturn_t dcgmReturn = mpCacheManager->AddFieldWatches(delta.added,
+                                                                  fieldIds,
+                                                                  delta.params.monitorIntervalUsec,
+                                                                  delta.params.maxSampleAge,
+                                                                  delta.params.maxKeepSamples,
+                                                                  delta.watcher,
+                                                                  delta.params.subscribeForUpdates,
+                                                                  anyFirstWatcher);
+        shouldUpdateAllFields = shouldUpdateAllFields || anyFirstWatcher;
+        if (dcgmReturn != DCGM_ST_OK)
         {
-            /* Don't dispatch to ourself */
-            continue;
+            log_error("AddFieldWatches({} entities, {} fields) returned {}",
+                      delta.added.size(),
+                      fieldIds.size(),
+                      (int)dcgmReturn);
+            return dcgmReturn;
+        }
+    }
+
+    return retSt;
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::SendFvUpdateToModule(dcgmModuleId_t moduleId, DcgmFvBuffer &fvBuffer)
+{
+    /* prepare the message for sending to modules */
+    dcgm_core_msg_field_values_updated_t msg;
+    size_t elementCount = 0;
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length      = sizeof(msg);
+    msg.header.version     = dcgm_core_msg_field_values_updated_version;
+    msg.header.subCommand  = DCGM_CORE_SR_FIELD_VALUES_UPDATED;
+    msg.fieldValues.buffer = fvBuffer.GetBuffer();
+    fvBuffer.GetSize(&msg.fieldValues.bufferSize, &elementCount);
+
+    SendModuleMessage(moduleId, (dcgm_module_command_header_t *)&msg);
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::OnFvUpdates(DcgmFvBuffer *fvBuffer,
+                                        DcgmWatcherType_t *watcherTypes,
+                                        int numWatcherTypes,
+                                        void * /*userData*/)
+{
+    static dcgmModuleId_t watcherToModuleMap[DcgmWatcherTypeCount]
+        = { DcgmModuleIdCore, DcgmModuleIdCore, DcgmModuleIdHealth,   DcgmModuleIdPolicy,
+            DcgmModuleIdCore, DcgmModuleIdCore, DcgmModuleIdNvSwitch, DcgmModuleIdDiag };
+
+    /* Copy of fvBuffer shared by the delivery queues. fvBuffer is reused by the cache manager once we return */
+    std::shared_ptr<DcgmFvBuffer> sharedFvBuffer;
+
+    /* Dispatch each watcher to the corresponding module */
+    dcgmModuleId_t destinationModuleId;
+    int i;
+
+    for (i = 0; i < numWatcherTypes; i++)
+    {
+        if (watcherTypes[i] == DcgmWatcherTypeClient)
+        {
+            /* Only client subscriptions made through SubscribeFieldGroup() subscribe for updates */
+            DispatchFvStreams(fvBuffer);
+            continue;
+        }
+
+        if (watcherTypes[i] == DcgmWatcherTypeHostEngine)
+        {
+            /* The host engine only subscribes for the fields of running jobs */
+            m_jobStats.Update(*fvBuffer);
+            continue;
+        }
+
+        destinationModuleId = watcherToModuleMap[watcherTypes[i]];
+        if (destinationModuleId == DcgmModuleIdCore)
+        {
+            log_error("Unhandled watcherType {} can't be dispatched to a module.", watcherTypes[i]);
+            continue;
+        }
+
+        if (m_modules[destinationModuleId].ptr == nullptr)
+        {
+            log_debug("Skipping FV update for moduleId {} that is not loaded.", destinationModuleId);
+            continue;
+        }
+
+        if (m_fvDeliveryQueues[destinationModuleId] == nullptr)
+        {
+            SendFvUpdateToModule(destinationModuleId, *fvBuffer);
+            continue;
+        }
+
+        if (sharedFvBuffer == nullptr)
+        {
+            size_t bufferSize = 0, elementCount = 0;
+            fvBuffer->GetSize(&bufferSize, &elementCount);
+            sharedFvBuffer = std::make_shared<DcgmFvBuffer>(bufferSize);
+            sharedFvBuffer->SetFromBuffer(fvBuffer->GetBuffer(), bufferSize);
+        }
+
+        m_fvDeliveryQueues[destinationModuleId]->Push(sharedFvBuffer);
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::GetFvDeliveryStats(dcgmModuleId_t moduleId, dcgm_fv_delivery_stats_t &stats)
+{
+    if (moduleId >= DcgmModuleIdCount)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (m_fvDeliveryQueues[moduleId] == nullptr)
+    {
+        return DCGM_ST_NOT_CONFIGURED;
+    }
+
+    stats = m_fvDeliveryQueues[moduleId]->GetStats();
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::StartFvDeliveryQueues()
+{
+    unsigned int maxDepth = 0;
+
+    const char *envStr = getenv("__DCGM_FV_DELIVERY_QUEUE_DEPTH__");
+    if (envStr != nullptr && atoi(envStr) > 0)
+    {
+        maxDepth = (unsigned int)atoi(envStr);
+    }
+
+    if (maxDepth == 0)
+    {
+        /* Field value updates are dispatched to modules on the cache manager thread */
+        return;
+    }
+
+    /* Modules that subscribe for field value updates */
+    for (dcgmModuleId_t moduleId : { DcgmModuleIdHealth, DcgmModuleIdPolicy, DcgmModuleIdNvSwitch })
+    {
+        auto queue = std::make_unique<DcgmFvDeliveryQueue>(
+            maxDepth, [this, moduleId](DcgmFvBuffer &fvBuffer) { SendFvUpdateToModule(moduleId, fvBuffer); });
+
+        if (queue->Start() != 0)
+        {
+            log_error("Unable to start the field value delivery queue of moduleId {}", moduleId);
+            continue;
+        }
+
+        m_fvDeliveryQueues[moduleId] = std::move(queue);
+    }
+
+    log_info("Field value updates are delivered to modules through queues of depth {}", maxDepth);
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::OnMigUpdates(unsigned int gpuId, DcgmMigHierarchyDelta const &delta)
+{
+    BumpMetadataGeneration();
+
+    dcgm_core_msg_mig_updated_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length     = sizeof(msg);
+    msg.header.moduleId   = DcgmModuleIdCore;
+    msg.header.subCommand = DCGM_CORE_SR_MIG_UPDATED;
+    msg.header.version    = dcgm_core_msg_mig_updated_version;
+    msg.gpuId             = gpuId;
+
+    auto copyIds = [](auto const &ids, unsigned int *dest, unsigned int capacity, unsigned int &count) {
+        count = std::min(static_cast<unsigned int>(ids.size()), capacity);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            dest[i] = ids[i].id;
+        }
+    };
+
+    copyIds(delta.addedGpuInstances, msg.addedGpuInstances, DCGM_MAX_INSTANCES_PER_GPU, msg.numAddedGpuInstances);
+    copyIds(
+        delta.removedGpuInstances, msg.removedGpuInstances, DCGM_MAX_INSTANCES_PER_GPU, msg.numRemovedGpuInstances);
+    copyIds(delta.addedComputeInstances,
+            msg.addedComputeInstances,
+            DCGM_MAX_COMPUTE_INSTANCES_PER_GPU,
+            msg.numAddedComputeInstances);
+    copyIds(delta.removedComputeInstances,
+            msg.removedComputeInstances,
+            DCGM_MAX_COMPUTE_INSTANCES_PER_GPU,
+            msg.numRemovedComputeInstances);
+
+    for (auto &m_module : m_modules)
+    {
+        if (m_module.ptr == nullptr)
+        {
+            /* Module not loaded */
+            continue;
+        }
+
+        if (m_module.id == DcgmModuleIdCore)
+        {
+            /* Don't dispatch to ourself */
+            continue;
         }
 
         SendModuleMessage((dcgmModuleId_t)m_module.id, (dcgm_module_command_header_t *)&msg);
@@ -1456,10 +1979,10 @@ static void nvHostEngineFvCallback(DcgmFvBuffer *fvBuffer,
     hostEngineHandler->OnFvUpdates(fvBuffer, watcherTypes, numWatcherTypes, userData);
 }
 
-static void nvHostEngineMigCallback(unsigned int gpuId, void *userData)
+static void nvHostEngineMigCallback(unsigned int gpuId, DcgmMigHierarchyDelta const &delta, void *userData)
 {
     auto *hostEngineHandler = (DcgmHostEngineHandler *)userData;
-    hostEngineHandler->OnMigUpdates(gpuId);
+    hostEngineHandler->OnMigUpdates(gpuId, delta);
 }
 
 void DcgmHostEngineHandler::ShutdownNvml()
@@ -1532,16 +2055,23 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
     , m_usingInjectionNvml(false)
     , m_nvmlLoaded(false)
 {
-    int ret;
-    dcgmReturn_t dcgmRet;
-
     mpCacheManager = nullptr;
 
     /* Set this in case a child class calls our Instance() method during this constructor.
        We really need to move away from the singleton model */
     mpHostEngineHandlerInstance = this;
 
-    m_nextWatchedRequestId = 1;
+    if (DcgmMutex::ProfilingRequested())
+    {
+        m_lock.EnableProfiling("HostEngine");
+        m_watchedRequests.EnableProfiling("HostEngineRequests");
+        m_jobsLock.EnableProfiling("HostEngineJobs");
+    }
+
+    if (DcgmNs::Trace::Enabled())
+    {
+        DcgmNs::Trace::StartDumpOnSignal();
+    }
 
     memset(&m_modules, 0, sizeof(m_modules));
     /* Do explicit initialization of the modules */
@@ -1583,6 +2113,47 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         m_modules[params.denyList[i]].status = DcgmModuleStatusDenylisted;
     }
 
+    ApplyModuleLoadPolicies();
+
+    char const *backgroundInitEnv = getenv(DCGM_ENV_BACKGROUND_INIT);
+    if (backgroundInitEnv == nullptr || backgroundInitEnv[0] != '1')
+    {
+        FinishInit(params);
+        SetInitResult(DCGM_ST_OK);
+        return;
+    }
+
+    /* Attach the GPUs in the background so that RunServer() can accept connections right away. ProcessMessage()
+       queues the requests that need them until this is done */
+    log_info("[Startup] Attaching GPUs in the background");
+    m_initThread = std::jthread([this, params] {
+        pthread_setname_np(pthread_self(), "dcgm_he_init");
+
+        dcgmReturn_t initResult = DCGM_ST_OK;
+        try
+        {
+            FinishInit(params);
+        }
+        catch (std::exception const &e)
+        {
+            DCGM_LOG_ERROR << "Cannot initialize the hostengine: " << e.what();
+            fprintf(stderr, "%s\n", e.what());
+            initResult = DCGM_ST_INIT_ERROR;
+        }
+
+        SetInitResult(initResult);
+    });
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::FinishInit(dcgmStartEmbeddedV2Params_v1 const &params)
+{
+    int ret;
+    dcgmReturn_t dcgmRet;
+
+    auto const startupStart = std::chrono::steady_clock::now();
+    auto phaseStart         = startupStart;
+
     LoadNvml();
 
     if (m_nvmlLoaded)
@@ -1621,6 +2192,9 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         }
     }
 
+    log_info("[Startup] Loaded NVML and the field metadata in {} ms", DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    phaseStart = std::chrono::steady_clock::now();
+
     mpCacheManager = new DcgmCacheManager();
     mModuleCoreObj.Initialize(mpCacheManager);
 
@@ -1647,6 +2221,25 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         }
     }
 
+    log_info("[Startup] Initialized the cache manager in {} ms", DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    phaseStart = std::chrono::steady_clock::now();
+
+    StartFvDeliveryQueues();
+
+    const char *jobJournalEnvStr = getenv("__DCGM_JOB_JOURNAL_FILE__");
+    if (jobJournalEnvStr != nullptr && jobJournalEnvStr[0] != '\0')
+    {
+        auto jobJournal = std::make_unique<DcgmJobJournal>();
+        if (jobJournal->Open(jobJournalEnvStr) == DCGM_ST_OK)
+        {
+            m_jobJournal = std::move(jobJournal);
+        }
+        else
+        {
+            log_error("Unable to open the job journal {}. Stopped jobs won't be journaled", jobJournalEnvStr);
+        }
+    }
+
     dcgmcmEventSubscription_t fv  = {};
     dcgmcmEventSubscription_t mig = {};
     fv.type                       = DcgmcmEventTypeFvUpdate;
@@ -1671,7 +2264,7 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
 
     /* Initialize the group manager before we add our default watches */
     mpGroupManager = new DcgmGroupManager(mpCacheManager, false);
-    mpGroupManager->SubscribeForGroupEvents(HostEngineOnGroupEventCB, this);
+    mpGroupManager->SubscribeForGroupEvents(HostEngineOnGroupEventCB, this, HostEngineOnGroupEntitiesChangeCB);
     mModuleCoreObj.SetGroupManager(mpGroupManager);
 
     mpFieldGroupManager = new DcgmFieldGroupManager();
@@ -1681,6 +2274,7 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
     m_coreCallbacks.poster     = &m_communicator;
     m_coreCallbacks.version    = dcgmCoreCallbacks_version;
     m_coreCallbacks.loggerfunc = (dcgmLoggerCallback_f)DcgmLoggingGetCallback();
+    m_coreCallbacks.direct     = m_communicator.GetDirectInterface();
 
     /* Create default groups after we've set up core callbacks. This is because creating
        default groups causes the NvSwitch module to load, which in turn tries to ask m_coreCallbacks
@@ -1699,6 +2293,10 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         throw std::runtime_error("WatchHostEngineFields failed.");
     }
 
+    log_info("[Startup] Created the default groups and host engine watches in {} ms",
+             DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    phaseStart = std::chrono::steady_clock::now();
+
     /* Start the cache manager update thread */
     ret = mpCacheManager->Start();
     if (ret != 0)
@@ -1716,6 +2314,10 @@ DcgmHostEngineHandler::DcgmHostEngineHandler(dcgmStartEmbeddedV2Params_v1 params
         ss << "CacheManager UpdateAllFields. Error: " << ret;
         throw std::runtime_error(ss.str());
     }
+
+    log_info("[Startup] Finished the first round of field updates in {} ms",
+             DcgmNs::Timelib::MillisecondsSince(phaseStart));
+    log_info("[Startup] Host engine was ready after {} ms", DcgmNs::Timelib::MillisecondsSince(startupStart));
 }
 
 /*****************************************************************************
@@ -1739,6 +2341,36 @@ DcgmHostEngineHandler::~DcgmHostEngineHandler()
         DCGM_LOG_ERROR << "Unknown exception caught in DcgmHostEngineHandler::~DcgmHostEngineHandler()";
     }
 
+    /* Attaching GPUs can't be interrupted. Wait for it before anything it initializes is freed */
+    if (m_initThread.joinable())
+    {
+        m_initThread.join();
+    }
+
+    /* Stop scrapes before the cache manager they read is freed */
+    m_metricsExporter.reset();
+
+    DcgmNs::Trace::StopDumpOnSignal();
+
+    /* Stop loading modules in the background before they're freed */
+    if (m_modulePrewarmThread.joinable())
+    {
+        m_modulePrewarmThread.request_stop();
+        m_modulePrewarmThread.join();
+    }
+
+    /* Stop switching profiling passes before the profiling module is freed */
+    m_profMultiplexer.Stop();
+
+    /* Stop delivering field values before the modules they're delivered to are freed */
+    for (auto &queue : m_fvDeliveryQueues)
+    {
+        if (queue != nullptr)
+        {
+            queue->StopAndWait(60000);
+        }
+    }
+
     auto lock = Lock();
 
     /* Free sub-modules before we unload core modules */
@@ -1762,6 +2394,12 @@ DcgmHostEngineHandler::~DcgmHostEngineHandler()
     deleteNotNull(mpCacheManager);
     deleteNotNull(mpFieldGroupManager);
 
+    /* The cache manager could push to these until it was gone */
+    for (auto &queue : m_fvDeliveryQueues)
+    {
+        queue.reset();
+    }
+
     for (auto &m_module : m_modules)
     {
         /* now that modules and CacheManager are stopped, close the modules */
@@ -1795,6 +2433,7 @@ dcgmReturn_t DcgmHostEngineHandler::SendModuleMessage(dcgmModuleId_t id, dcgm_mo
         return DCGM_ST_BADPARAM;
     }
 
+    DcgmNs::Trace::Scope traceScope("ModuleProcessMessage", "moduleId", id, "subCommand", moduleCommand->subCommand);
     return m_modules[id].msgCB(m_modules[id].ptr, moduleCommand);
 }
 
@@ -1811,6 +2450,97 @@ char const *ModuleIdToName(dcgmModuleId_t moduleId)
 }
 } //namespace
 
+/*****************************************************************************/
+void DcgmHostEngineHandler::ApplyModuleLoadPolicies()
+{
+    const char *envStr = getenv("__DCGM_MODULE_LOAD_POLICY__");
+    if (envStr == nullptr)
+    {
+        return;
+    }
+
+    for (auto const &entry : DcgmNs::Split(envStr, ','))
+    {
+        auto const tokens = DcgmNs::Split(entry, ':');
+        if (tokens.size() != 2)
+        {
+            log_warning("Ignoring module load policy '{}'. Expected <module>:<ondemand|prewarm>", entry);
+            continue;
+        }
+
+        std::string const policyStr = dcgmStrToLower(std::string(tokens[1]));
+        dcgmModuleLoadPolicy_t policy;
+        if (policyStr == "ondemand")
+        {
+            policy = DcgmModuleLoadOnDemand;
+        }
+        else if (policyStr == "prewarm")
+        {
+            policy = DcgmModuleLoadPrewarm;
+        }
+        else
+        {
+            log_warning("Ignoring unknown load policy '{}' of module {}", tokens[1], tokens[0]);
+            continue;
+        }
+
+        std::string const name = dcgmStrToLower(std::string(tokens[0]));
+        bool found             = false;
+        for (unsigned int i = DcgmModuleIdCore + 1; i < DcgmModuleIdCount; i++)
+        {
+            if (dcgmStrToLower(ModuleIdToName((dcgmModuleId_t)i)) == name)
+            {
+                m_modules[i].loadPolicy = policy;
+                found                   = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            log_warning("Ignoring load policy of unknown module {}", tokens[0]);
+        }
+    }
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::StartModulePrewarm()
+{
+    if (m_modulePrewarmThread.joinable())
+    {
+        return;
+    }
+
+    bool anyPrewarm = std::ranges::any_of(m_modules, [](dcgmhe_module_info_t const &module) {
+        return module.loadPolicy == DcgmModuleLoadPrewarm;
+    });
+    if (!anyPrewarm)
+    {
+        return;
+    }
+
+    m_modulePrewarmThread = std::jthread([this](std::stop_token stopToken) {
+        /* Modules are initialized with the cache manager */
+        if (m_initFuture.get() != DCGM_ST_OK)
+        {
+            return;
+        }
+
+        for (unsigned int i = DcgmModuleIdCore + 1; i < DcgmModuleIdCount && !stopToken.stop_requested(); i++)
+        {
+            if (m_modules[i].loadPolicy != DcgmModuleLoadPrewarm || m_modules[i].status != DcgmModuleStatusNotLoaded)
+            {
+                continue;
+            }
+
+            if (LoadModule((dcgmModuleId_t)i) != DCGM_ST_OK)
+            {
+                log_warning("Unable to prewarm module {}", ModuleIdToName((dcgmModuleId_t)i));
+            }
+        }
+    });
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmHostEngineHandler::LoadModule(dcgmModuleId_t moduleId)
 {
@@ -1843,6 +2573,8 @@ dcgmReturn_t DcgmHostEngineHandler::LoadModule(dcgmModuleId_t moduleId)
         return DCGM_ST_OK;
     }
 
+    auto const loadStart = std::chrono::steady_clock::now();
+
     /* Do we have a library name to open? */
     if (m_modules[moduleId].filename == nullptr)
     {
@@ -1909,8 +2641,11 @@ dcgmReturn_t DcgmHostEngineHandler::LoadModule(dcgmModuleId_t moduleId)
     }
     else
     {
-        m_modules[moduleId].status = DcgmModuleStatusLoaded;
-        log_info("Loaded module {}", moduleId);
+        m_modules[moduleId].status       = DcgmModuleStatusLoaded;
+        m_modules[moduleId].initTimeUsec = std::chrono::duration_cast<std::chrono::microseconds>(
+                                               std::chrono::steady_clock::now() - loadStart)
+                                               .count();
+        log_info("Loaded module {} in {} usec", moduleId, m_modules[moduleId].initTimeUsec);
     }
 
     if (m_modules[moduleId].status == DcgmModuleStatusLoaded)
@@ -1949,6 +2684,12 @@ DcgmLockGuard DcgmHostEngineHandler::Lock()
     return result;
 }
 
+/*****************************************************************************/
+DcgmLockGuard DcgmHostEngineHandler::LockJobs()
+{
+    return DcgmLockGuard(&m_jobsLock);
+}
+
 /*****************************************************************************/
 void DcgmHostEngineHandler::Unlock(DcgmLockGuard /*guard*/)
 {
@@ -2770,30 +3511,97 @@ dcgmReturn_t DcgmHostEngineHandler::GetProcessInfo(unsigned int groupId, dcgmPid
 
 
 /*****************************************************************************/
-dcgmReturn_t DcgmHostEngineHandler::JobStartStats(std::string const &jobId, unsigned int groupId)
+void DcgmHostEngineHandler::WatchJobStatsFields(std::vector<unsigned int> const &gpuIds, bool watch)
 {
-    jobIdMap_t::iterator it;
-
-    /* If the entry already exists return error to provide unique key. Override it with */
-    auto lock = Lock();
+    /* Polling this rarely and keeping samples this long makes the client's job watches decide both. The minimum
+       of the watchers' sample ages is what the cache keeps */
+    timelib64_t const monitorIntervalUsec = 3600000000;
+    double const maxSampleAge             = 30 * 86400.0;
+    DcgmWatcher watcher(DcgmWatcherTypeHostEngine, DCGM_CONNECTION_ID_NONE);
 
-    it = mJobIdMap.find(jobId);
-    if (it == mJobIdMap.end())
-    {
-        /* Insert it as a record */
-        jobRecord_t record;
-        record.startTime = timelib_usecSince1970();
-        record.endTime   = 0;
-        record.groupId   = groupId;
-        mJobIdMap.insert(make_pair(jobId, record));
-    }
-    else
+    for (unsigned int gpuId : gpuIds)
     {
-        log_error("Duplicate JobId as input : {}", jobId.c_str());
-        /* Implies that the entry corresponding to the job id already exists */
+        for (unsigned short fieldId : DcgmJobStats::c_fieldIds)
+        {
+            dcgmReturn_t dcgmReturn;
+            if (watch)
+            {
+                bool wereFirstWatcher = false;
+                dcgmReturn            = mpCacheManager->AddFieldWatch(DCGM_FE_GPU,
+                                                           gpuId,
+                                                           fieldId,
+                                                           monitorIntervalUsec,
+                                                           maxSampleAge,
+                                                           0,
+                                                           watcher,
+                                                           true,
+                                                           false,
+                                                           wereFirstWatcher);
+            }
+            else
+            {
+                dcgmReturn = mpCacheManager->RemoveFieldWatch(DCGM_FE_GPU, gpuId, fieldId, 0, watcher);
+            }
+
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                log_error("Unable to {} fieldId {} of gpuId {} for job stats: {}",
+                          watch ? "watch" : "unwatch",
+                          fieldId,
+                          gpuId,
+                          errorString(dcgmReturn));
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::JobStartStats(std::string const &jobId, unsigned int groupId)
+{
+    jobIdMap_t::iterator it;
+    std::vector<dcgmGroupEntityPair_t> entities;
+    std::vector<unsigned int> gpuIds;
+
+    /* Resolve the groupId -> entities[] -> gpuIds[]. The job's stats are of the GPUs it started on */
+    dcgmReturn_t dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    /* Process stats are only supported for GPUs for now */
+    for (auto const &entity : entities)
+    {
+        if (entity.entityGroupId == DCGM_FE_GPU)
+        {
+            gpuIds.push_back(entity.entityId);
+        }
+    }
+
+    std::lock_guard<std::mutex> jobStatsLock(m_jobStatsWatchMutex);
+
+    /* If the entry already exists return error to provide unique key. Override it with */
+    auto lock = LockJobs();
+
+    it = mJobIdMap.find(jobId);
+    if (it != mJobIdMap.end())
+    {
+        log_error("Duplicate JobId as input : {}", jobId.c_str());
+        /* Implies that the entry corresponding to the job id already exists */
         return DCGM_ST_DUPLICATE_KEY;
     }
 
+    /* Insert it as a record */
+    jobRecord_t record;
+    record.startTime = timelib_usecSince1970();
+    record.endTime   = 0;
+    record.groupId   = groupId;
+    mJobIdMap.insert(make_pair(jobId, record));
+    Unlock(std::move(lock));
+
+    WatchJobStatsFields(m_jobStats.StartJob(jobId, record.startTime, gpuIds), true);
+
     return DCGM_ST_OK;
 }
 
@@ -2803,8 +3611,10 @@ dcgmReturn_t DcgmHostEngineHandler::JobStopStats(std::string const &jobId)
 {
     jobIdMap_t::iterator it;
 
+    std::lock_guard<std::mutex> jobStatsLock(m_jobStatsWatchMutex);
+
     /* If the entry already exists return error to provide unique key. Override it with */
-    auto lock = Lock();
+    auto lock = LockJobs();
 
     it = mJobIdMap.find(jobId);
     if (it == mJobIdMap.end())
@@ -2813,8 +3623,28 @@ dcgmReturn_t DcgmHostEngineHandler::JobStopStats(std::string const &jobId)
         return DCGM_ST_NO_DATA;
     }
 
-    jobRecord_t *pRecord = &(it->second);
-    pRecord->endTime     = timelib_usecSince1970();
+    jobRecord_t *pRecord      = &(it->second);
+    pRecord->endTime          = timelib_usecSince1970();
+    timelib64_t const endTime = pRecord->endTime;
+    Unlock(std::move(lock));
+
+    WatchJobStatsFields(m_jobStats.StopJob(jobId, endTime), false);
+
+    if (m_jobJournal != nullptr)
+    {
+        auto jobInfo     = std::make_unique<dcgmJobInfo_t>();
+        jobInfo->version = dcgmJobInfo_version;
+
+        dcgmReturn_t dcgmReturn = JobGetStats(jobId, jobInfo.get());
+        if (dcgmReturn == DCGM_ST_OK)
+        {
+            dcgmReturn = m_jobJournal->Append(jobId, *jobInfo);
+        }
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            log_error("Unable to journal the stats of job {}: {}", jobId, errorString(dcgmReturn));
+        }
+    }
 
     return DCGM_ST_OK;
 }
@@ -2861,7 +3691,6 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
     jobIdMap_t::iterator it;
     jobRecord_t *pRecord;
     unsigned int groupId;
-    std::vector<dcgmGroupEntityPair_t> entities;
     std::vector<unsigned int> gpuIds;
     std::vector<unsigned int>::iterator gpuIdIt;
     dcgmGpuUsageInfo_t *singleInfo;
@@ -2873,8 +3702,6 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
     DcgmcmSummaryType_t summaryTypes[DcgmcmSummaryTypeSize];
     int i;
     double doubleVals[DcgmcmSummaryTypeSize];
-    int Msamples = 10; /* Should match size of samples[] */
-    dcgmcm_sample_t samples[10];
     dcgmStatSummaryInt32_t blankSummary32  = { DCGM_INT32_BLANK, DCGM_INT32_BLANK, DCGM_INT32_BLANK };
     dcgmStatSummaryInt64_t blankSummary64  = { DCGM_INT64_BLANK, DCGM_INT64_BLANK, DCGM_INT64_BLANK };
     dcgmStatSummaryFp64_t blankSummaryFP64 = { DCGM_FP64_BLANK, DCGM_FP64_BLANK, DCGM_FP64_BLANK };
@@ -2887,11 +3714,18 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
     }
 
     /* If entry can't be found then return error back to the caller */
-    auto lock = Lock();
+    auto lock = LockJobs();
 
     it = mJobIdMap.find(jobId);
     if (it == mJobIdMap.end())
     {
+        /* Stopped jobs that were removed or started before a restart are only left in the journal */
+        if (m_jobJournal != nullptr && m_jobJournal->Get(jobId, *pJobInfo) == DCGM_ST_OK)
+        {
+            log_debug("Got the stats of job {} from the job journal", jobId);
+            return DCGM_ST_OK;
+        }
+
         log_error("Can't find entry corresponding to the Job Id : {}", jobId.c_str());
         return DCGM_ST_NO_DATA;
     }
@@ -2917,24 +3751,39 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         return DCGM_ST_GENERIC_ERROR;
     }
 
-    /* Resolve the groupId -> entities[] -> gpuIds[] */
-    dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    /* The GPUs were resolved from the group when the job was started */
+    dcgmReturn = m_jobStats.GetGpuIds(jobId, gpuIds);
     if (dcgmReturn != DCGM_ST_OK)
     {
-        log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
+        log_error("Error {} from GetGpuIds()", (int)dcgmReturn);
         return dcgmReturn;
     }
 
-    /* Process stats are only supported for GPUs for now */
-    for (i = 0; i < (int)entities.size(); i++)
-    {
-        if (entities[i].entityGroupId != DCGM_FE_GPU)
+    /* Same as HelperGetInt64StatSummary() and HelperGetInt32StatSummary(), from the job's running statistics */
+    auto getInt64StatSummary = [&](unsigned int gpuId, unsigned short fieldId, dcgmStatSummaryInt64_t *summary) {
+        DcgmcmSummaryType_t const statTypes[]
+            = { DcgmcmSummaryTypeMinimum, DcgmcmSummaryTypeMaximum, DcgmcmSummaryTypeAverage };
+        long long statValues[3];
+
+        if (m_jobStats.GetInt64Summary(jobId, gpuId, fieldId, 3, statTypes, statValues) == DCGM_ST_OK)
         {
-            continue;
+            summary->minValue = statValues[0];
+            summary->maxValue = statValues[1];
+            summary->average  = statValues[2];
         }
+    };
+    auto getInt32StatSummary = [&](unsigned int gpuId, unsigned short fieldId, dcgmStatSummaryInt32_t *summary) {
+        DcgmcmSummaryType_t const statTypes[]
+            = { DcgmcmSummaryTypeMinimum, DcgmcmSummaryTypeMaximum, DcgmcmSummaryTypeAverage };
+        long long statValues[3];
 
-        gpuIds.push_back(entities[i].entityId);
-    }
+        if (m_jobStats.GetInt64Summary(jobId, gpuId, fieldId, 3, statTypes, statValues) == DCGM_ST_OK)
+        {
+            summary->minValue = nvcmvalue_int64_to_int32(statValues[0]);
+            summary->maxValue = nvcmvalue_int64_to_int32(statValues[1]);
+            summary->average  = nvcmvalue_int64_to_int32(statValues[2]);
+        }
+    };
 
     /* Initialize a health response to be populated later */
     std::unique_ptr<dcgmHealthResponse_t> response = std::make_unique<dcgmHealthResponse_t>();
@@ -2981,29 +3830,13 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         summaryTypes[2] = DcgmcmSummaryTypeMaximum;
         summaryTypes[3] = DcgmcmSummaryTypeAverage;
 
-        mpCacheManager->GetFp64SummaryData(DCGM_FE_GPU,
-                                           singleInfo->gpuId,
-                                           DCGM_FI_DEV_POWER_USAGE,
-                                           4,
-                                           &summaryTypes[0],
-                                           &doubleVals[0],
-                                           startTime,
-                                           endTime,
-                                           nullptr,
-                                           nullptr);
+        m_jobStats.GetFp64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_POWER_USAGE, 4, &summaryTypes[0], &doubleVals[0]);
 
         /* See if the energy counter is supported. If so, use that rather than integrating the power usage */
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_TOTAL_ENERGY_CONSUMPTION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_TOTAL_ENERGY_CONSUMPTION, 1, &summaryTypes[0], &i64Val);
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
             singleInfo->energyConsumed = i64Val;
@@ -3054,18 +3887,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
          * GPUS. One GPUs minimum could occur at a different time than another GPU's minimum
          */
 
-        DcgmHostEngineHandler::Instance()->HelperGetInt64StatSummary(DCGM_FE_GPU,
-                                                                     singleInfo->gpuId,
-                                                                     DCGM_FI_DEV_PCIE_RX_THROUGHPUT,
-                                                                     &singleInfo->pcieRxBandwidth,
-                                                                     startTime,
-                                                                     endTime);
-        DcgmHostEngineHandler::Instance()->HelperGetInt64StatSummary(DCGM_FE_GPU,
-                                                                     singleInfo->gpuId,
-                                                                     DCGM_FI_DEV_PCIE_TX_THROUGHPUT,
-                                                                     &singleInfo->pcieTxBandwidth,
-                                                                     startTime,
-                                                                     endTime);
+        getInt64StatSummary(singleInfo->gpuId, DCGM_FI_DEV_PCIE_RX_THROUGHPUT, &singleInfo->pcieRxBandwidth);
+        getInt64StatSummary(singleInfo->gpuId, DCGM_FI_DEV_PCIE_TX_THROUGHPUT, &singleInfo->pcieTxBandwidth);
 
         /* If the PCIE Tx BW is blank, update the average with the PCIE Tx BW value as 0 for this GPU*/
         if (DCGM_INT64_IS_BLANK(singleInfo->pcieTxBandwidth.average))
@@ -3094,16 +3917,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
             = (pJobInfo->summary.pcieRxBandwidth.average * (pJobInfo->numGpus - 1) + fieldValue) / (pJobInfo->numGpus);
 
         summaryTypes[0] = DcgmcmSummaryTypeMaximum;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_PCIE_REPLAY_COUNTER,
-                                            1,
-                                            &summaryTypes[0],
-                                            &singleInfo->pcieReplays,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_PCIE_REPLAY_COUNTER, 1, &summaryTypes[0], &singleInfo->pcieReplays);
         if (!DCGM_INT64_IS_BLANK(singleInfo->pcieReplays))
         {
             if (DCGM_INT64_IS_BLANK(pJobInfo->summary.pcieReplays))
@@ -3119,8 +3934,7 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         singleInfo->startTime = startTime;
         singleInfo->endTime   = endTime;
 
-        DcgmHostEngineHandler::Instance()->HelperGetInt32StatSummary(
-            DCGM_FE_GPU, singleInfo->gpuId, DCGM_FI_DEV_GPU_UTIL, &singleInfo->smUtilization, startTime, endTime);
+        getInt32StatSummary(singleInfo->gpuId, DCGM_FI_DEV_GPU_UTIL, &singleInfo->smUtilization);
 
         /* If the SM utilization is blank, update the average with the SM utilization value as 0 for this GPU*/
         if (DCGM_INT32_IS_BLANK(singleInfo->smUtilization.average))
@@ -3135,12 +3949,7 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         pJobInfo->summary.smUtilization.average
             = (pJobInfo->summary.smUtilization.average * (pJobInfo->numGpus - 1) + fieldValue) / (pJobInfo->numGpus);
 
-        DcgmHostEngineHandler::Instance()->HelperGetInt32StatSummary(DCGM_FE_GPU,
-                                                                     singleInfo->gpuId,
-                                                                     DCGM_FI_DEV_MEM_COPY_UTIL,
-                                                                     &singleInfo->memoryUtilization,
-                                                                     startTime,
-                                                                     endTime);
+        getInt32StatSummary(singleInfo->gpuId, DCGM_FI_DEV_MEM_COPY_UTIL, &singleInfo->memoryUtilization);
 
         /* If  mem utilization is blank, update the average with the mem utilization value as 0 for this GPU*/
         if (DCGM_INT32_IS_BLANK(singleInfo->memoryUtilization.average))
@@ -3157,16 +3966,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
               / (pJobInfo->numGpus);
 
         summaryTypes[0] = DcgmcmSummaryTypeMaximum;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_ECC_DBE_VOL_TOTAL,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_ECC_DBE_VOL_TOTAL, 1, &summaryTypes[0], &i64Val);
         singleInfo->eccDoubleBit = nvcmvalue_int64_to_int32(i64Val);
 
         if (!DCGM_INT32_IS_BLANK(singleInfo->eccDoubleBit))
@@ -3181,8 +3982,7 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
             }
         }
 
-        DcgmHostEngineHandler::Instance()->HelperGetInt32StatSummary(
-            DCGM_FE_GPU, singleInfo->gpuId, DCGM_FI_DEV_SM_CLOCK, &singleInfo->smClock, startTime, endTime);
+        getInt32StatSummary(singleInfo->gpuId, DCGM_FI_DEV_SM_CLOCK, &singleInfo->smClock);
 
         /* If  SM clock is blank, update the average with the SM  clock value as 0 for this GPU*/
         if (DCGM_INT32_IS_BLANK(singleInfo->smClock.average))
@@ -3197,8 +3997,7 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         pJobInfo->summary.smClock.average
             = (pJobInfo->summary.smClock.average * (pJobInfo->numGpus - 1) + fieldValue) / (pJobInfo->numGpus);
 
-        DcgmHostEngineHandler::Instance()->HelperGetInt32StatSummary(
-            DCGM_FE_GPU, singleInfo->gpuId, DCGM_FI_DEV_MEM_CLOCK, &singleInfo->memoryClock, startTime, endTime);
+        getInt32StatSummary(singleInfo->gpuId, DCGM_FI_DEV_MEM_CLOCK, &singleInfo->memoryClock);
 
         /* If memory clock is blank, update the average with the memory clock  value as 0 for this GPU*/
         if (DCGM_INT32_IS_BLANK(singleInfo->memoryClock.average))
@@ -3214,33 +4013,18 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
             = (pJobInfo->summary.memoryClock.average * (pJobInfo->numGpus - 1) + fieldValue) / (pJobInfo->numGpus);
 
 
-        singleInfo->numXidCriticalErrors = Msamples;
-        dcgmReturn                       = mpCacheManager->GetSamples(DCGM_FE_GPU,
-                                                singleInfo->gpuId,
-                                                DCGM_FI_DEV_XID_ERRORS,
-                                                samples,
-                                                &singleInfo->numXidCriticalErrors,
-                                                startTime,
-                                                endTime,
-                                                DCGM_ORDER_ASCENDING,
-                                                nullptr);
-        if (dcgmReturn != DCGM_ST_OK)
-        {
-            DCGM_LOG_ERROR << "Got " << dcgmReturn << " from GetSamples()";
-            /* Keep going. We used to just ignore this return */
-        }
-
+        std::vector<timelib64_t> xidTimestamps = m_jobStats.GetXidTimestamps(jobId, singleInfo->gpuId);
+        singleInfo->numXidCriticalErrors       = (int)xidTimestamps.size();
         for (i = 0; i < singleInfo->numXidCriticalErrors; i++)
         {
-            singleInfo->xidCriticalErrorsTs[i] = samples[i].timestamp;
+            singleInfo->xidCriticalErrorsTs[i] = xidTimestamps[i];
             if (pJobInfo->summary.numXidCriticalErrors
                 < (int)DCGM_ARRAY_CAPACITY(pJobInfo->summary.xidCriticalErrorsTs))
             {
-                pJobInfo->summary.xidCriticalErrorsTs[pJobInfo->summary.numXidCriticalErrors] = samples[i].timestamp;
+                pJobInfo->summary.xidCriticalErrorsTs[pJobInfo->summary.numXidCriticalErrors] = xidTimestamps[i];
                 pJobInfo->summary.numXidCriticalErrors++;
             }
         }
-        mpCacheManager->FreeSamples(samples, singleInfo->numXidCriticalErrors, DCGM_FI_DEV_XID_ERRORS);
 
         singleInfo->numComputePids = (int)DCGM_ARRAY_CAPACITY(singleInfo->computePidInfo);
         dcgmReturn                 = mpCacheManager->GetUniquePidLists(DCGM_FE_GPU,
@@ -3361,16 +4145,7 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
 
 
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_POWER_VIOLATION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(jobId, singleInfo->gpuId, DCGM_FI_DEV_POWER_VIOLATION, 1, &summaryTypes[0], &i64Val);
         singleInfo->powerViolationTime = i64Val;
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
@@ -3385,16 +4160,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         }
 
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_THERMAL_VIOLATION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_THERMAL_VIOLATION, 1, &summaryTypes[0], &i64Val);
         singleInfo->thermalViolationTime = i64Val;
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
@@ -3409,16 +4176,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         }
 
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_RELIABILITY_VIOLATION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_RELIABILITY_VIOLATION, 1, &summaryTypes[0], &i64Val);
         singleInfo->reliabilityViolationTime = i64Val;
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
@@ -3433,16 +4192,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         }
 
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_BOARD_LIMIT_VIOLATION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_BOARD_LIMIT_VIOLATION, 1, &summaryTypes[0], &i64Val);
         singleInfo->boardLimitViolationTime = i64Val;
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
@@ -3457,16 +4208,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         }
 
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_LOW_UTIL_VIOLATION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_LOW_UTIL_VIOLATION, 1, &summaryTypes[0], &i64Val);
         singleInfo->lowUtilizationTime = i64Val;
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
@@ -3481,16 +4224,8 @@ dcgmReturn_t DcgmHostEngineHandler::JobGetStats(const std::string &jobId, dcgmJo
         }
 
         summaryTypes[0] = DcgmcmSummaryTypeDifference;
-        mpCacheManager->GetInt64SummaryData(DCGM_FE_GPU,
-                                            singleInfo->gpuId,
-                                            DCGM_FI_DEV_SYNC_BOOST_VIOLATION,
-                                            1,
-                                            &summaryTypes[0],
-                                            &i64Val,
-                                            startTime,
-                                            endTime,
-                                            nullptr,
-                                            nullptr);
+        m_jobStats.GetInt64Summary(
+            jobId, singleInfo->gpuId, DCGM_FI_DEV_SYNC_BOOST_VIOLATION, 1, &summaryTypes[0], &i64Val);
         singleInfo->syncBoostTime = i64Val;
         if (!DCGM_INT64_IS_BLANK(i64Val))
         {
@@ -3546,8 +4281,10 @@ dcgmReturn_t DcgmHostEngineHandler::JobRemove(std::string const &jobId)
 {
     jobIdMap_t::iterator it;
 
+    std::lock_guard<std::mutex> jobStatsLock(m_jobStatsWatchMutex);
+
     /* If the entry already exists return error to provide unique key. Override it with */
-    auto lock = Lock();
+    auto lock = LockJobs();
 
     it = mJobIdMap.find(jobId);
     if (it == mJobIdMap.end())
@@ -3557,6 +4294,9 @@ dcgmReturn_t DcgmHostEngineHandler::JobRemove(std::string const &jobId)
     }
 
     mJobIdMap.erase(it);
+    Unlock(std::move(lock));
+
+    WatchJobStatsFields(m_jobStats.RemoveJob(jobId), false);
 
     log_debug("JobRemove: Removed jobId {}", jobId);
     return DCGM_ST_OK;
@@ -3567,10 +4307,15 @@ dcgmReturn_t DcgmHostEngineHandler::JobRemoveAll()
 {
     jobIdMap_t::iterator it;
 
+    std::lock_guard<std::mutex> jobStatsLock(m_jobStatsWatchMutex);
+
     /* If the entry already exists return error to provide unique key. Override it with */
-    auto lock = Lock();
+    auto lock = LockJobs();
 
     mJobIdMap.clear();
+    Unlock(std::move(lock));
+
+    WatchJobStatsFields(m_jobStats.RemoveAllJobs(), false);
 
     log_debug("JobRemoveAll: Removed all jobs");
     return DCGM_ST_OK;
@@ -3676,10 +4421,9 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroup(unsigned int groupId,
                                                     timelib64_t monitorIntervalUsec,
                                                     double maxSampleAge,
                                                     int maxKeepSamples,
-                                                    DcgmWatcher const &watcher)
+                                                    DcgmWatcher const &watcher,
+                                                    bool subscribeForUpdates)
 {
-    int i;
-    int j;
     dcgmReturn_t dcgmReturn;
     std::vector<dcgmGroupEntityPair_t> entities;
     std::vector<unsigned short> fieldIds;
@@ -3687,6 +4431,10 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroup(unsigned int groupId,
     dcgm_sysmon_msg_watch_fields_t sysmonMsg = {};
     dcgmReturn_t retSt                       = DCGM_ST_OK;
 
+    /* Held from reading the entities until the watch is bound to them so that a concurrent change of the
+       group is applied after it */
+    std::unique_lock<std::mutex> groupWatchesLock(m_groupWatchesMutex);
+
     dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
     if (dcgmReturn != DCGM_ST_OK)
     {
@@ -3703,41 +4451,25 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroup(unsigned int groupId,
 
     log_debug("Got {} entities and {} fields", (int)entities.size(), (int)fieldIds.size());
 
-    bool wasFirstWatcher    = false;
-    bool updateOnFirstWatch = false; /* Don't have the cache manager update after every watch. Instead,
-                                        we will set shouldUpdateAllFields and UpdateAllFields at the end */
+    /* The cache manager doesn't update after every watch. Instead, we UpdateAllFields at the end
+       if any of the watches were new */
     bool shouldUpdateAllFields = false;
 
-    for (i = 0; i < (int)entities.size(); i++)
     {
-        for (j = 0; j < (int)fieldIds.size(); j++)
-        {
-            dcgmReturn = mpCacheManager->AddFieldWatch(entities[i].entityGroupId,
-                                                       entities[i].entityId,
-                                                       fieldIds[j],
-                                                       monitorIntervalUsec,
-                                                       maxSampleAge,
-                                                       maxKeepSamples,
-                                                       watcher,
-                                                       false,
-                                                       updateOnFirstWatch,
-                                                       wasFirstWatcher);
-            if (dcgmReturn != DCGM_ST_OK)
-            {
-                log_error("AddFieldWatch({}, {}, {}) returned {}",
-                          entities[i].entityGroupId,
-                          entities[i].entityId,
-                          (int)fieldIds[j],
-                          (int)dcgmReturn);
-                retSt = dcgmReturn;
-                goto GETOUT;
-            }
+        /* Watching the same field group on the same group again only watches what changed since */
+        dcgm_group_watch_params_t const params {
+            monitorIntervalUsec, maxSampleAge, maxKeepSamples, subscribeForUpdates
+        };
+        dcgm_group_watch_delta_t const delta
+            = m_groupWatches.Bind(groupId, (unsigned int)fieldGroupId, watcher, params, entities);
+        dcgmReturn = ApplyGroupWatchDelta(delta, fieldIds, shouldUpdateAllFields);
+    }
+    groupWatchesLock.unlock();
 
-            if (wasFirstWatcher)
-            {
-                shouldUpdateAllFields = true;
-            }
-        }
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        retSt = dcgmReturn;
+        goto GETOUT;
     }
 
     if (shouldUpdateAllFields)
@@ -3756,42 +4488,23 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroup(unsigned int groupId,
 
     if (!profFieldIds.empty())
     {
-        dcgm_profiling_msg_watch_fields_t msg;
-        memset(&msg, 0, sizeof(msg));
-
-        if (profFieldIds.size() > DCGM_ARRAY_CAPACITY(msg.watchFields.fieldIds))
-        {
-            log_error("Too many prof field IDs {} for request DCGM_PROFILING_SR_WATCH_FIELDS",
-                      (int)profFieldIds.size());
-
-            retSt = DCGM_ST_GENERIC_ERROR;
-            goto GETOUT;
-        }
-
         /* Do we need to forward on a profiling watch request to the profiling module */
         mpCacheManager->GetProfModuleServicedEntities(entities);
 
         if (!entities.empty())
         {
-            msg.header.length           = sizeof(msg);
-            msg.header.moduleId         = DcgmModuleIdProfiling;
-            msg.header.subCommand       = DCGM_PROFILING_SR_WATCH_FIELDS;
-            msg.header.connectionId     = watcher.connectionId;
-            msg.header.version          = dcgm_profiling_msg_watch_fields_version;
-            msg.watchFields.version     = dcgmProfWatchFields_version;
-            msg.watchFields.groupId     = (dcgmGpuGrp_t)groupId;
-            msg.watchFields.numFieldIds = profFieldIds.size();
-            memcpy(&msg.watchFields.fieldIds[0],
-                   &profFieldIds[0],
-                   profFieldIds.size() * sizeof(msg.watchFields.fieldIds[0]));
-            msg.watchFields.updateFreq     = monitorIntervalUsec;
-            msg.watchFields.maxKeepAge     = maxSampleAge;
-            msg.watchFields.maxKeepSamples = maxKeepSamples;
-
-            dcgmReturn = ProcessModuleCommand((dcgm_module_command_header_t *)&msg);
+            /* The new watch replaces what the profiling module watched for this group */
+            m_profMultiplexer.Remove(groupId);
+
+            dcgmReturn = SendProfWatchFields(
+                groupId, watcher.connectionId, profFieldIds, monitorIntervalUsec, maxSampleAge, maxKeepSamples);
+            if (dcgmReturn == DCGM_ST_PROFILING_MULTI_PASS)
+            {
+                dcgmReturn = MultiplexProfWatch(
+                    groupId, entities, profFieldIds, watcher, monitorIntervalUsec, maxSampleAge, maxKeepSamples);
+            }
             if (dcgmReturn != DCGM_ST_OK)
             {
-                log_error("DCGM_PROFILING_SR_WATCH_FIELDS failed with {}", dcgmReturn);
                 retSt = dcgmReturn;
                 goto GETOUT;
             }
@@ -3822,20 +4535,14 @@ GETOUT:
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmHostEngineHandler::UnwatchFieldGroup(unsigned int groupId,
+dcgmReturn_t DcgmHostEngineHandler::GetFieldGroupKeys(unsigned int groupId,
                                                       dcgmFieldGrp_t fieldGroupId,
-                                                      DcgmWatcher const &watcher)
+                                                      std::vector<dcgm_entity_key_t> &keys)
 {
-    int i;
-    int j;
-    dcgmReturn_t dcgmReturn;
-    dcgmReturn_t retSt = DCGM_ST_OK;
-    std::vector<dcgmGroupEntityPair_t> entities;
+    DcgmGroupManager::EntityListPtr entities;
     std::vector<unsigned short> fieldIds;
-    std::vector<unsigned short> profFieldIds;
-    dcgm_sysmon_msg_watch_fields_t sysmonMsg = {};
 
-    dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    dcgmReturn_t dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
     if (dcgmReturn != DCGM_ST_OK)
     {
         log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
@@ -3849,56 +4556,608 @@ dcgmReturn_t DcgmHostEngineHandler::UnwatchFieldGroup(unsigned int groupId,
         return dcgmReturn;
     }
 
-    log_debug("Got {} entities and {} fields", (int)entities.size(), (int)fieldIds.size());
-
-    for (i = 0; i < (int)entities.size(); i++)
+    keys.clear();
+    keys.reserve(entities->size() * fieldIds.size());
+    for (auto const &entity : *entities)
     {
-        for (j = 0; j < (int)fieldIds.size(); j++)
+        for (auto fieldId : fieldIds)
         {
-            dcgmReturn = mpCacheManager->RemoveFieldWatch(
-                entities[i].entityGroupId, entities[i].entityId, fieldIds[j], 0, watcher);
-            if (dcgmReturn != DCGM_ST_OK)
+            dcgm_entity_key_t key {};
+            key.entityGroupId = entity.entityGroupId;
+            key.entityId      = entity.entityId;
+            key.fieldId       = fieldId;
+
+            /* The cache manager watches global fields under DCGM_FE_NONE */
+            dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+            if (fieldMeta != nullptr && fieldMeta->scope == DCGM_FS_GLOBAL)
             {
-                log_error("RemoveFieldWatch({}, {}, {}) returned {}",
-                          entities[i].entityGroupId,
-                          entities[i].entityId,
-                          (int)fieldIds[j],
-                          (int)dcgmReturn);
-                retSt = dcgmReturn;
-                /* Keep going so we don't leave watches active */
+                key.entityGroupId = DCGM_FE_NONE;
+                key.entityId      = 0;
             }
+
+            keys.push_back(key);
         }
     }
 
-    /* Send a module command to the profiling module to unwatch any fieldIds */
-    helper_get_prof_field_ids(fieldIds, profFieldIds);
+    return DCGM_ST_OK;
+}
 
-    if (!profFieldIds.empty())
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::SubscribeFieldGroup(dcgm_connection_id_t connectionId,
+                                                        dcgm_request_id_t requestId,
+                                                        unsigned int groupId,
+                                                        dcgmFieldGrp_t fieldGroupId,
+                                                        timelib64_t monitorIntervalUsec,
+                                                        double maxSampleAge,
+                                                        int maxKeepSamples)
+{
+    std::vector<dcgm_entity_key_t> keys;
+
+    if (connectionId == DCGM_CONNECTION_ID_NONE)
     {
-        /* Do we need to forward on a profiling unwatch request to the profiling module? */
-        mpCacheManager->GetProfModuleServicedEntities(entities);
+        log_debug("Field value subscriptions are only supported for remote clients");
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+    if (requestId == DCGM_REQUEST_ID_NONE)
+    {
+        log_error("Field value subscription of connectionId {} has no requestId", connectionId);
+        return DCGM_ST_BADPARAM;
+    }
 
-        if (entities.empty())
-        {
-            DCGM_LOG_DEBUG << "No entities were serviced by the profiling module";
+    dcgmReturn_t dcgmReturn = GetFieldGroupKeys(groupId, fieldGroupId, keys);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        /* The client won't get any notifications for this request */
+        NotifyRequestOfCompletion(connectionId, requestId);
+        return dcgmReturn;
+    }
+
+    /* Subscriptions are tied to their connection, so don't honor persist-after-disconnect here */
+    DcgmWatcher watcher(DcgmWatcherTypeClient, connectionId);
+
+    dcgmReturn = WatchFieldGroup(
+        groupId, fieldGroupId, monitorIntervalUsec, maxSampleAge, maxKeepSamples, watcher, true);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        NotifyRequestOfCompletion(connectionId, requestId);
+        return dcgmReturn;
+    }
+
+    dcgm_request_id_t replacedRequestId
+        = m_fvStreams.Add(connectionId, requestId, groupId, (unsigned int)fieldGroupId, keys);
+    if (replacedRequestId != DCGM_REQUEST_ID_NONE)
+    {
+        NotifyRequestOfCompletion(connectionId, replacedRequestId);
+    }
+
+    log_debug("connectionId {} requestId {} subscribed to groupId {}, fieldGroupId {}: {} keys",
+              connectionId,
+              requestId,
+              groupId,
+              fieldGroupId,
+              keys.size());
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::UnsubscribeFieldGroup(dcgm_connection_id_t connectionId,
+                                                          unsigned int groupId,
+                                                          dcgmFieldGrp_t fieldGroupId)
+{
+    dcgm_request_id_t requestId = m_fvStreams.Remove(connectionId, groupId, (unsigned int)fieldGroupId);
+    if (requestId == DCGM_REQUEST_ID_NONE)
+    {
+        log_debug("connectionId {} has no subscription to groupId {}, fieldGroupId {}",
+                  connectionId,
+                  groupId,
+                  fieldGroupId);
+        return DCGM_ST_NOT_WATCHED;
+    }
+
+    DcgmWatcher watcher(DcgmWatcherTypeClient, connectionId);
+    dcgmReturn_t dcgmReturn = UnwatchFieldGroup(groupId, fieldGroupId, watcher);
+
+    /* Sent before the response to the unsubscribe so that the client has dropped the
+       request by the time the unsubscribe returns */
+    NotifyRequestOfCompletion(connectionId, requestId);
+    return dcgmReturn;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::SubscribeMetadata(dcgm_connection_id_t connectionId,
+                                                      dcgm_request_id_t requestId,
+                                                      unsigned long long &generation)
+{
+    if (connectionId == DCGM_CONNECTION_ID_NONE)
+    {
+        log_debug("Metadata subscriptions are only supported for remote clients");
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    std::lock_guard<std::mutex> lock(m_metadataMutex);
+
+    m_metadataSubscribers[connectionId] = requestId;
+    generation                          = m_metadataGeneration.load();
+    log_debug("connectionId {} subscribed to metadata generation {} with requestId {}",
+              connectionId,
+              generation,
+              requestId);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::BumpMetadataGeneration()
+{
+    /* Bumped under the lock so that subscribers are sent generations in increasing order */
+    std::lock_guard<std::mutex> lock(m_metadataMutex);
+
+    dcgm_msg_metadata_notify_t notify {};
+    notify.generation = ++m_metadataGeneration;
+
+    for (auto const &[connectionId, requestId] : m_metadataSubscribers)
+    {
+        SendRawMessageToClient(connectionId, DCGM_MSG_METADATA_NOTIFY, requestId, &notify, sizeof(notify), DCGM_ST_OK);
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::OpenValuesCursor(dcgm_connection_id_t connectionId,
+                                                     unsigned int groupId,
+                                                     dcgmFieldGrp_t fieldGroupId,
+                                                     timelib64_t sinceTimestamp,
+                                                     unsigned int &cursorId)
+{
+    std::vector<dcgm_entity_key_t> keys;
+
+    /* Values that update from here on are left to the next cursor, like dcgmGetValuesSince_v2 does */
+    timelib64_t const endTimestamp = timelib_usecSince1970();
+
+    dcgmReturn_t dcgmReturn = GetFieldGroupKeys(groupId, fieldGroupId, keys);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    size_t const numKeys = keys.size();
+
+    dcgmReturn = m_valuesCursors.Open(connectionId, std::move(keys), sinceTimestamp, endTimestamp, cursorId);
+    if (dcgmReturn == DCGM_ST_OK)
+    {
+        log_debug("connectionId {} opened values cursor {} over groupId {}, fieldGroupId {}: {} keys since {}",
+                  connectionId,
+                  cursorId,
+                  groupId,
+                  fieldGroupId,
+                  numKeys,
+                  sinceTimestamp);
+    }
+    return dcgmReturn;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::NextValuesCursor(dcgm_connection_id_t connectionId,
+                                                     unsigned int cursorId,
+                                                     size_t maxBytes,
+                                                     dcgm_values_cursor_chunk_t &chunk)
+{
+    auto reader = [this](dcgm_entity_key_t const &key,
+                         int *count,
+                         timelib64_t startTs,
+                         timelib64_t endTs,
+                         DcgmFvBuffer &fvBuffer) {
+        return mpCacheManager->GetSamples((dcgm_field_entity_group_t)key.entityGroupId,
+                                          key.entityId,
+                                          key.fieldId,
+                                          nullptr,
+                                          count,
+                                          startTs,
+                                          endTs,
+                                          DCGM_ORDER_ASCENDING,
+                                          &fvBuffer);
+    };
+
+    return m_valuesCursors.Next(connectionId, cursorId, reader, maxBytes, chunk);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::CloseValuesCursor(dcgm_connection_id_t connectionId, unsigned int cursorId)
+{
+    return m_valuesCursors.Close(connectionId, cursorId);
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::DispatchFvStreams(DcgmFvBuffer *fvBuffer)
+{
+    if (fvBuffer == nullptr || m_fvStreams.GetCount() == 0)
+    {
+        return;
+    }
+
+    auto notifications = m_fvStreams.Dispatch(*fvBuffer, DCGM_PROTO_MAX_MESSAGE_SIZE);
+
+    for (auto &notification : notifications)
+    {
+        /* The notification's bytes are sent by reference rather than copied into the message */
+        auto fvBytes = std::make_shared<std::vector<char> const>(std::move(notification.fvBytes));
+
+        std::unique_ptr<DcgmMessage> dcgmMessage = DcgmMessagePool::GetInstance().Get();
+        dcgmMessage->AddExternalSegment(fvBytes->data(), fvBytes->size(), fvBytes);
+        dcgmMessage->UpdateMsgHdr(DCGM_MSG_FV_NOTIFY, notification.requestId, DCGM_ST_OK, dcgmMessage->GetLength());
+
+        dcgmReturn_t dcgmReturn = m_dcgmIpc.SendMessage(notification.connectionId, std::move(dcgmMessage), false);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            DCGM_LOG_DEBUG << "Got " << errorString(dcgmReturn) << " sending FV notification to connectionId "
+                           << notification.connectionId;
         }
-        else
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::UpdateFieldGroup(unsigned int groupId,
+                                                     dcgmFieldGrp_t fieldGroupId,
+                                                     int waitForUpdate)
+{
+    std::vector<dcgmGroupEntityPair_t> entities;
+    std::vector<unsigned short> fieldIds;
+
+    dcgmReturn_t dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    dcgmReturn = mpFieldGroupManager->GetFieldGroupFields(fieldGroupId, fieldIds);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Got {} from mpFieldGroupManager->GetFieldGroupFields()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    return mpCacheManager->UpdateFields(entities, fieldIds, waitForUpdate);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::SnapshotFieldGroup(unsigned int groupId,
+                                                       dcgmFieldGrp_t fieldGroupId,
+                                                       timelib64_t &snapshotId)
+{
+    std::vector<dcgmGroupEntityPair_t> entities;
+    std::vector<unsigned short> fieldIds;
+
+    dcgmReturn_t dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    dcgmReturn = mpFieldGroupManager->GetFieldGroupFields(fieldGroupId, fieldIds);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Got {} from mpFieldGroupManager->GetFieldGroupFields()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    return mpCacheManager->SnapshotFields(entities, fieldIds, snapshotId);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::ResampleFieldGroup(unsigned int groupId,
+                                                       dcgmFieldGrp_t fieldGroupId,
+                                                       timelib64_t startTime,
+                                                       timelib64_t stepUsec,
+                                                       dcgmResampleFill_t fill,
+                                                       unsigned int &numRows,
+                                                       std::vector<dcgm_entity_key_t> &columns,
+                                                       double *values,
+                                                       size_t maxValues)
+{
+    std::vector<dcgmGroupEntityPair_t> entities;
+    std::vector<unsigned short> fieldIds;
+
+    columns.clear();
+
+    dcgmReturn_t dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    dcgmReturn = mpFieldGroupManager->GetFieldGroupFields(fieldGroupId, fieldIds);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Got {} from mpFieldGroupManager->GetFieldGroupFields()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    for (auto const &entity : entities)
+    {
+        for (auto const fieldId : fieldIds)
+        {
+            dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+            if (fieldMeta == nullptr
+                || (fieldMeta->fieldType != DCGM_FT_INT64 && fieldMeta->fieldType != DCGM_FT_TIMESTAMP
+                    && fieldMeta->fieldType != DCGM_FT_DOUBLE))
+            {
+                continue;
+            }
+
+            dcgm_entity_key_t column;
+            column.entityGroupId = entity.entityGroupId;
+            column.entityId      = entity.entityId;
+            column.fieldId       = fieldId;
+            columns.push_back(column);
+        }
+    }
+
+    if (columns.size() > DCGM_RESAMPLE_MAX_COLUMNS)
+    {
+        log_error("Can't resample {} columns. The limit is {}", columns.size(), DCGM_RESAMPLE_MAX_COLUMNS);
+        return DCGM_ST_MAX_LIMIT;
+    }
+
+    if (columns.empty())
+    {
+        return DCGM_ST_OK;
+    }
+
+    numRows = (unsigned int)std::min<size_t>(numRows, maxValues / columns.size());
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        dcgm_entity_key_t const &column = columns[i];
+
+        /* Columns without samples are left blank */
+        dcgmReturn = mpCacheManager->ResampleField((dcgm_field_entity_group_t)column.entityGroupId,
+                                                   column.entityId,
+                                                   column.fieldId,
+                                                   startTime,
+                                                   stepUsec,
+                                                   numRows,
+                                                   fill,
+                                                   values + i,
+                                                   columns.size());
+        if (dcgmReturn != DCGM_ST_OK)
         {
-            dcgm_profiling_msg_unwatch_fields_t msg;
-            memset(&msg, 0, sizeof(msg));
+            log_debug("Got {} resampling eg {} eid {} fieldId {}",
+                      (int)dcgmReturn,
+                      column.entityGroupId,
+                      column.entityId,
+                      column.fieldId);
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::SendProfWatchFields(unsigned int groupId,
+                                                        dcgm_connection_id_t connectionId,
+                                                        std::vector<unsigned short> const &profFieldIds,
+                                                        timelib64_t updateFreq,
+                                                        double maxKeepAge,
+                                                        int maxKeepSamples)
+{
+    dcgm_profiling_msg_watch_fields_t msg;
+    memset(&msg, 0, sizeof(msg));
+
+    if (profFieldIds.size() > DCGM_ARRAY_CAPACITY(msg.watchFields.fieldIds))
+    {
+        log_error("Too many prof field IDs {} for request DCGM_PROFILING_SR_WATCH_FIELDS", (int)profFieldIds.size());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    msg.header.length           = sizeof(msg);
+    msg.header.moduleId         = DcgmModuleIdProfiling;
+    msg.header.subCommand       = DCGM_PROFILING_SR_WATCH_FIELDS;
+    msg.header.connectionId     = connectionId;
+    msg.header.version          = dcgm_profiling_msg_watch_fields_version;
+    msg.watchFields.version     = dcgmProfWatchFields_version;
+    msg.watchFields.groupId     = (dcgmGpuGrp_t)groupId;
+    msg.watchFields.numFieldIds = profFieldIds.size();
+    memcpy(&msg.watchFields.fieldIds[0], &profFieldIds[0], profFieldIds.size() * sizeof(msg.watchFields.fieldIds[0]));
+    msg.watchFields.updateFreq     = updateFreq;
+    msg.watchFields.maxKeepAge     = maxKeepAge;
+    msg.watchFields.maxKeepSamples = maxKeepSamples;
+
+    dcgmReturn_t dcgmReturn = ProcessModuleCommand((dcgm_module_command_header_t *)&msg);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("DCGM_PROFILING_SR_WATCH_FIELDS failed with {}", dcgmReturn);
+    }
+    return dcgmReturn;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::SendProfUnwatchFields(unsigned int groupId, dcgm_connection_id_t connectionId)
+{
+    dcgm_profiling_msg_unwatch_fields_t msg;
+    memset(&msg, 0, sizeof(msg));
+
+    msg.header.length         = sizeof(msg);
+    msg.header.moduleId       = DcgmModuleIdProfiling;
+    msg.header.subCommand     = DCGM_PROFILING_SR_UNWATCH_FIELDS;
+    msg.header.connectionId   = connectionId;
+    msg.header.version        = dcgm_profiling_msg_unwatch_fields_version;
+    msg.unwatchFields.version = dcgmProfUnwatchFields_version;
+    msg.unwatchFields.groupId = (dcgmGpuGrp_t)groupId;
+
+    dcgmReturn_t dcgmReturn = ProcessModuleCommand((dcgm_module_command_header_t *)&msg);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("DCGM_PROFILING_SR_UNWATCH_FIELDS failed with {}", dcgmReturn);
+    }
+    return dcgmReturn;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::ApplyProfMultiplexPass(unsigned int groupId,
+                                                           DcgmProfMultiplexWatch const &watch,
+                                                           std::vector<unsigned short> const &fieldIds)
+{
+    dcgmReturn_t dcgmReturn = SendProfUnwatchFields(groupId, watch.connectionId);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
 
-            msg.header.length         = sizeof(msg);
-            msg.header.moduleId       = DcgmModuleIdProfiling;
-            msg.header.subCommand     = DCGM_PROFILING_SR_UNWATCH_FIELDS;
-            msg.header.connectionId   = watcher.connectionId;
-            msg.header.version        = dcgm_profiling_msg_unwatch_fields_version;
-            msg.unwatchFields.version = dcgmProfUnwatchFields_version;
-            msg.unwatchFields.groupId = (dcgmGpuGrp_t)groupId;
+    return SendProfWatchFields(
+        groupId, watch.connectionId, fieldIds, watch.updateFreq, watch.maxKeepAge, watch.maxKeepSamples);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::MultiplexProfWatch(unsigned int groupId,
+                                                       std::vector<dcgmGroupEntityPair_t> const &entities,
+                                                       std::vector<unsigned short> const &profFieldIds,
+                                                       DcgmWatcher const &watcher,
+                                                       timelib64_t updateFreq,
+                                                       double maxKeepAge,
+                                                       int maxKeepSamples)
+{
+    /* The GPUs of a profiling watch are identical, so the metric groups of one apply to all of them */
+    auto const gpu = std::ranges::find_if(
+        entities, [](dcgmGroupEntityPair_t const &entity) { return entity.entityGroupId == DCGM_FE_GPU; });
+    if (gpu == entities.end())
+    {
+        log_error("groupId {} has no GPU to get the profiling metric groups of", groupId);
+        return DCGM_ST_PROFILING_MULTI_PASS;
+    }
+
+    dcgm_profiling_msg_get_mgs_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.header.length        = sizeof(msg);
+    msg.header.moduleId      = DcgmModuleIdProfiling;
+    msg.header.subCommand    = DCGM_PROFILING_SR_GET_MGS;
+    msg.header.connectionId  = watcher.connectionId;
+    msg.header.version       = dcgm_profiling_msg_get_mgs_version;
+    msg.metricGroups.version = dcgmProfGetMetricGroups_version;
+    msg.metricGroups.gpuId   = gpu->entityId;
+
+    dcgmReturn_t dcgmReturn = ProcessModuleCommand(&msg.header);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("DCGM_PROFILING_SR_GET_MGS failed with {}", dcgmReturn);
+        return dcgmReturn;
+    }
+
+    DcgmProfMultiplexWatch watch;
+    dcgmReturn = DcgmProfMultiplexPlan::Build(msg.metricGroups, profFieldIds, watch.plan);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
 
-            dcgmReturn = ProcessModuleCommand((dcgm_module_command_header_t *)&msg);
+    watch.connectionId   = watcher.connectionId;
+    watch.updateFreq     = updateFreq;
+    watch.maxKeepAge     = maxKeepAge;
+    watch.maxKeepSamples = maxKeepSamples;
+
+    for (unsigned short fieldId : watch.plan.FieldIds())
+    {
+        log_debug(
+            "groupId {} fieldId {} is collected {} of the time", groupId, fieldId, watch.plan.SampledFraction(fieldId));
+    }
+
+    return m_profMultiplexer.Add(groupId, std::move(watch), timelib_usecSince1970());
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::GetProfMultiplexInfo(unsigned int groupId, dcgmProfMultiplexInfo_t &multiplexInfo)
+{
+    multiplexInfo.numPasses   = 0;
+    multiplexInfo.windowUsec  = 0;
+    multiplexInfo.numFieldIds = 0;
+
+    auto const watch = m_profMultiplexer.GetWatch(groupId);
+    if (!watch.has_value())
+    {
+        return;
+    }
+
+    multiplexInfo.numPasses  = watch->plan.NumPasses();
+    multiplexInfo.windowUsec = watch->windowUsec;
+    for (unsigned short fieldId : watch->plan.FieldIds())
+    {
+        if (multiplexInfo.numFieldIds >= DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS)
+        {
+            break;
+        }
+        multiplexInfo.fieldIds[multiplexInfo.numFieldIds]        = fieldId;
+        multiplexInfo.sampledFraction[multiplexInfo.numFieldIds] = watch->plan.SampledFraction(fieldId);
+        multiplexInfo.numFieldIds++;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::UnwatchFieldGroup(unsigned int groupId,
+                                                      dcgmFieldGrp_t fieldGroupId,
+                                                      DcgmWatcher const &watcher)
+{
+    dcgmReturn_t dcgmReturn;
+    dcgmReturn_t retSt = DCGM_ST_OK;
+    std::vector<dcgmGroupEntityPair_t> entities;
+    std::vector<unsigned short> fieldIds;
+    std::vector<unsigned short> profFieldIds;
+    dcgm_sysmon_msg_watch_fields_t sysmonMsg = {};
+
+    dcgmReturn = mpGroupManager->GetGroupEntities(groupId, entities);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Error {} from GetGroupEntities()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    dcgmReturn = mpFieldGroupManager->GetFieldGroupFields(fieldGroupId, fieldIds);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Got {} from mpFieldGroupManager->GetFieldGroupFields()", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    log_debug("Got {} entities and {} fields", (int)entities.size(), (int)fieldIds.size());
+
+    {
+        /* Unwatch what the watch was last applied to, which the group may no longer contain */
+        std::lock_guard<std::mutex> lock(m_groupWatchesMutex);
+        std::vector<dcgmGroupEntityPair_t> boundEntities;
+        bool const wasBound = m_groupWatches.Unbind(groupId, (unsigned int)fieldGroupId, watcher, boundEntities);
+        std::vector<dcgmGroupEntityPair_t> const &watchedEntities = wasBound ? boundEntities : entities;
+
+        /* This keeps going after an error so we don't leave watches active */
+        dcgmReturn = mpCacheManager->RemoveFieldWatches(watchedEntities, fieldIds, 0, watcher);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            log_error("RemoveFieldWatches({} entities, {} fields) returned {}",
+                      (int)watchedEntities.size(),
+                      (int)fieldIds.size(),
+                      (int)dcgmReturn);
+            retSt = dcgmReturn;
+        }
+    }
+
+    /* Send a module command to the profiling module to unwatch any fieldIds */
+    helper_get_prof_field_ids(fieldIds, profFieldIds);
+
+    if (!profFieldIds.empty())
+    {
+        /* Do we need to forward on a profiling unwatch request to the profiling module? */
+        mpCacheManager->GetProfModuleServicedEntities(entities);
+
+        if (entities.empty())
+        {
+            DCGM_LOG_DEBUG << "No entities were serviced by the profiling module";
+        }
+        else
+        {
+            /* Stop rotating passes first so that none is watched again after the unwatch */
+            m_profMultiplexer.Remove(groupId);
+
+            dcgmReturn = SendProfUnwatchFields(groupId, watcher.connectionId);
             if (dcgmReturn != DCGM_ST_OK)
             {
-                log_error("DCGM_PROFILING_SR_UNWATCH_FIELDS failed with {}", dcgmReturn);
                 retSt = dcgmReturn;
             }
         }
@@ -3938,8 +5197,6 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroupAllGpus(dcgmFieldGrp_t fieldG
                                                            int activeOnly,
                                                            DcgmWatcher const &watcher)
 {
-    int i;
-    int j;
     dcgmReturn_t dcgmReturn;
     std::vector<unsigned int> gpuIds;
     std::vector<unsigned short> fieldIds;
@@ -3961,36 +5218,29 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroupAllGpus(dcgmFieldGrp_t fieldG
 
     log_debug("Got {} gpus and {} fields", (int)gpuIds.size(), (int)fieldIds.size());
 
-    bool wasFirstWatcher    = false;
-    bool updateOnFirstWatch = false; /* Don't have the cache manager update after every watch. Instead,
-                                        we will set shouldUpdateAllFields and UpdateAllFields at the end */
+    std::vector<dcgmGroupEntityPair_t> entities;
+    entities.reserve(gpuIds.size());
+    for (auto const gpuId : gpuIds)
+    {
+        entities.push_back({ DCGM_FE_GPU, gpuId });
+    }
+
+    /* Don't have the cache manager update after every watch. Instead, we UpdateAllFields at the end
+       if any of the watches were new */
     bool shouldUpdateAllFields = false;
 
-    for (i = 0; i < (int)gpuIds.size(); i++)
     {
-        for (j = 0; j < (int)fieldIds.size(); j++)
-        {
-            dcgmReturn = mpCacheManager->AddFieldWatch(DCGM_FE_GPU,
-                                                       gpuIds[i],
-                                                       fieldIds[j],
-                                                       monitorIntervalUsec,
-                                                       maxSampleAge,
-                                                       maxKeepSamples,
-                                                       watcher,
-                                                       false,
-                                                       updateOnFirstWatch,
-                                                       wasFirstWatcher);
-            if (dcgmReturn != DCGM_ST_OK)
-            {
-                log_error("AddFieldWatch({}, {}) returned {}", (int)gpuIds[i], (int)fieldIds[j], (int)dcgmReturn);
-                return DCGM_ST_GENERIC_ERROR;
-            }
-
-            if (wasFirstWatcher)
-            {
-                shouldUpdateAllFields = true;
-            }
-        }
+        /* Bound to the all-GPUs group so that calling this again as GPUs come and go only watches the
+           GPUs that changed */
+        std::lock_guard<std::mutex> lock(m_groupWatchesMutex);
+        dcgm_group_watch_params_t const params { monitorIntervalUsec, maxSampleAge, maxKeepSamples, false };
+        dcgm_group_watch_delta_t const delta = m_groupWatches.Bind(
+            mpGroupManager->GetAllGpusGroup(), (unsigned int)fieldGroupId, watcher, params, entities);
+        dcgmReturn = ApplyGroupWatchDelta(delta, fieldIds, shouldUpdateAllFields);
+    }
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return DCGM_ST_GENERIC_ERROR;
     }
 
     if (shouldUpdateAllFields)
@@ -4010,32 +5260,7 @@ dcgmReturn_t DcgmHostEngineHandler::WatchFieldGroupAllGpus(dcgmFieldGrp_t fieldG
 dcgmReturn_t DcgmHostEngineHandler::AddRequestWatcher(std::unique_ptr<DcgmRequest> request,
                                                       dcgm_request_id_t &requestId)
 {
-    if (request == nullptr)
-    {
-        return DCGM_ST_BADPARAM;
-    }
-
-    auto lock = Lock();
-
-    m_nextWatchedRequestId++;
-
-    /* Search for a nonzero, unused request ID. This should only take more than one
-       loop if we've served more than 4 billion requests */
-    while (m_nextWatchedRequestId == DCGM_REQUEST_ID_NONE
-           || m_watchedRequests.find(m_nextWatchedRequestId) != m_watchedRequests.end())
-    {
-        m_nextWatchedRequestId++;
-    }
-
-    request->SetRequestId(m_nextWatchedRequestId);
-    requestId = m_nextWatchedRequestId;
-
-    m_watchedRequests[m_nextWatchedRequestId] = std::move(request);
-
-    /* Log while we still have the lock */
-    DCGM_LOG_DEBUG << "Assigned requestId " << m_nextWatchedRequestId << " to request " << std::hex << request.get();
-
-    return DCGM_ST_OK;
+    return m_watchedRequests.Add(std::move(request), requestId);
 }
 
 /*****************************************************************************/
@@ -4044,16 +5269,12 @@ void DcgmHostEngineHandler::NotifyRequestOfCompletion(dcgm_connection_id_t conne
     if (connectionId == DCGM_CONNECTION_ID_NONE)
     {
         /* Local request. Just remove our object */
-        auto lock = Lock();
-
-        watchedRequests_t::iterator it = m_watchedRequests.find(requestId);
-        if (it == m_watchedRequests.end())
+        if (!m_watchedRequests.Remove(requestId))
         {
             log_error("Unable to find requestId {}", requestId);
         }
         else
         {
-            m_watchedRequests.erase(it);
             log_debug("Removed requestId {}", requestId);
         }
         return;
@@ -4071,8 +5292,7 @@ dcgmReturn_t DcgmHostEngineHandler::RemoveAllTrackedRequests()
 {
     log_debug("Entering RemoveAllTrackedRequests");
 
-    auto lock = Lock();
-    m_watchedRequests.clear();
+    m_watchedRequests.Clear();
 
     return DCGM_ST_OK;
 }
@@ -4084,31 +5304,38 @@ dcgmReturn_t DcgmHostEngineHandler::RemoveAllTrackedRequests()
  *****************************************************************************/
 dcgmReturn_t DcgmHostEngineHandler::RunServer(unsigned short portNumber,
                                               char const *socketPath,
-                                              unsigned int isConnectionTCP)
+                                              unsigned int isConnectionTCP,
+                                              int listenFd)
 {
     dcgmReturn_t dcgmReturn;
 
     if (isConnectionTCP)
     {
         DcgmIpcTcpServerParams_t tcpParams {};
-        tcpParams.bindIPAddress = socketPath;
+        tcpParams.bindIPAddress = socketPath != nullptr ? socketPath : "";
         tcpParams.port          = portNumber;
+        tcpParams.listenFd      = listenFd;
         dcgmReturn              = m_dcgmIpc.Init(tcpParams,
                                     std::nullopt,
                                     DcgmHostEngineHandler::StaticProcessMessage,
                                     this,
                                     DcgmHostEngineHandler::StaticProcessDisconnect,
+                                    this,
+                                    DcgmHostEngineHandler::StaticProcessCancel,
                                     this);
     }
     else
     {
         DcgmIpcDomainServerParams_t domainParams {};
-        domainParams.domainSocketPath = socketPath;
+        domainParams.domainSocketPath = socketPath != nullptr ? socketPath : "";
+        domainParams.listenFd         = listenFd;
         dcgmReturn                    = m_dcgmIpc.Init(std::nullopt,
                                     domainParams,
                                     DcgmHostEngineHandler::StaticProcessMessage,
                                     this,
                                     DcgmHostEngineHandler::StaticProcessDisconnect,
+                                    this,
+                                    DcgmHostEngineHandler::StaticProcessCancel,
                                     this);
     }
 
@@ -4118,6 +5345,79 @@ dcgmReturn_t DcgmHostEngineHandler::RunServer(unsigned short portNumber,
         return DCGM_ST_INIT_ERROR;
     }
 
+    /* Requests are served from here on, so modules can be loaded without delaying startup */
+    StartModulePrewarm();
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::RunMetricsServer(unsigned short portNumber, char const *bindAddress)
+{
+    if (m_metricsExporter != nullptr)
+    {
+        log_error("The metrics server is already running");
+        return DCGM_ST_IN_USE;
+    }
+
+    /* The exporter reads the cache manager, which is created while the GPUs are attached */
+    if (dcgmReturn_t initResult = m_initFuture.get(); initResult != DCGM_ST_OK)
+    {
+        return initResult;
+    }
+
+    auto exporter = std::make_unique<DcgmMetricsExporter>(*mpCacheManager);
+
+    dcgmReturn_t dcgmReturn = exporter->Listen(portNumber, bindAddress != nullptr ? bindAddress : "");
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    if (exporter->Start() != 0)
+    {
+        log_error("Unable to start the metrics server thread");
+        return DCGM_ST_INIT_ERROR;
+    }
+
+    m_metricsExporter = std::move(exporter);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::RunSharedLatestValues(std::string const &name,
+                                                          std::vector<unsigned short> const &fieldIds,
+                                                          timelib64_t updateFreqUsec)
+{
+    if (dcgmReturn_t initResult = m_initFuture.get(); initResult != DCGM_ST_OK)
+    {
+        return initResult;
+    }
+
+    dcgmReturn_t dcgmReturn = mpCacheManager->StartSharedLatestValues(name, fieldIds);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    /* Only the latest values are read from the segment, so keep no more history than the cache requires */
+    DcgmWatcher watcher(DcgmWatcherTypeHostEngine, DCGM_CONNECTION_ID_NONE);
+    dcgmFieldGrp_t fieldGroup {};
+    std::vector<unsigned short> groupFieldIds(fieldIds);
+    dcgmReturn = mpFieldGroupManager->AddFieldGroup("DCGM_INTERNAL_SHM_LATEST", groupFieldIds, &fieldGroup, watcher);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("AddFieldGroup returned {}", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
+    dcgmReturn = WatchFieldGroup(mpGroupManager->GetAllGpusGroup(), fieldGroup, updateFreqUsec, 0.0, 1, watcher);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("WatchFieldGroup returned {}", (int)dcgmReturn);
+        return dcgmReturn;
+    }
+
     return DCGM_ST_OK;
 }
 
@@ -4137,6 +5437,12 @@ void DcgmHostEngineHandler::Cleanup()
 DcgmEntityStatus_t DcgmHostEngineHandler::GetEntityStatus(dcgm_field_entity_group_t entityGroupId,
                                                           dcgm_field_eid_t entityId)
 {
+    /* Switches, CPUs and CPU cores are only asked of their module until it published their statuses */
+    if (auto const status = mpCacheManager->GetPublishedEntityStatus(entityGroupId, entityId); status.has_value())
+    {
+        return *status;
+    }
+
     if ((entityGroupId == DCGM_FE_SWITCH) || (entityGroupId == DCGM_FE_LINK))
     {
         dcgm_nvswitch_msg_get_entity_status_t nvsMsg {};
@@ -4189,7 +5495,110 @@ DcgmEntityStatus_t DcgmHostEngineHandler::GetEntityStatus(dcgm_field_entity_grou
 void DcgmHostEngineHandler::StaticProcessDisconnect(dcgm_connection_id_t connectionId, void *userData)
 {
     DcgmHostEngineHandler *he = (DcgmHostEngineHandler *)userData;
-    he->OnConnectionRemove(connectionId);
+
+    if (!he->m_initDone.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lg(he->m_pendingRequestsMutex);
+        if (!he->m_initDone.load(std::memory_order_relaxed))
+        {
+            /* After the requests of the connection that are still queued */
+            he->m_pendingRequests.emplace_back(connectionId, nullptr);
+            return;
+        }
+    }
+
+    if (he->m_initResult == DCGM_ST_OK)
+    {
+        he->OnConnectionRemove(connectionId);
+    }
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::StaticProcessCancel(dcgm_connection_id_t connectionId,
+                                                dcgm_request_id_t requestId,
+                                                void *userData)
+{
+    DcgmHostEngineHandler *he = (DcgmHostEngineHandler *)userData;
+    he->OnRequestCancel(connectionId, requestId);
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::OnRequestCancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId)
+{
+    for (auto const &command : m_inflightRequests.Cancel(connectionId, requestId))
+    {
+        DCGM_LOG_DEBUG << "Cancelled requestId " << requestId << " of connectionId " << connectionId
+                       << " running module " << command.moduleId << " subCommand " << command.subCommand;
+
+        if (command.moduleId != DcgmModuleIdDiag
+            || (command.subCommand != DCGM_DIAG_SR_RUN && command.subCommand != DCGM_DIAG_SR_RUN_STREAMING))
+        {
+            continue;
+        }
+
+        /* The diag waits on nvvs rather than polling. Only one diag runs at a time, so this stops ours */
+        dcgm_diag_msg_stop_t msg {};
+        msg.header.length     = sizeof(msg);
+        msg.header.moduleId   = DcgmModuleIdDiag;
+        msg.header.subCommand = DCGM_DIAG_SR_STOP;
+        msg.header.version    = dcgm_diag_msg_stop_version;
+
+        dcgmReturn_t dcgmReturn = ProcessModuleCommand(&msg.header);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            log_error("Got {} stopping the diag of cancelled requestId {}", errorString(dcgmReturn), requestId);
+        }
+    }
+}
+
+/*****************************************************************************/
+void DcgmHostEngineHandler::SetInitResult(dcgmReturn_t initResult)
+{
+    {
+        std::lock_guard<std::mutex> lg(m_pendingRequestsMutex);
+        m_initResult = initResult;
+    }
+
+    /* Keep queueing new requests until the queued ones are served so that each connection is served in order */
+    while (true)
+    {
+        std::deque<std::pair<dcgm_connection_id_t, std::unique_ptr<DcgmMessage>>> pendingRequests;
+        {
+            std::lock_guard<std::mutex> lg(m_pendingRequestsMutex);
+            if (m_pendingRequests.empty())
+            {
+                m_initDone.store(true, std::memory_order_release);
+                break;
+            }
+            pendingRequests.swap(m_pendingRequests);
+        }
+
+        log_debug("Serving {} requests that were queued during initialization", pendingRequests.size());
+        for (auto &[connectionId, message] : pendingRequests)
+        {
+            if (message != nullptr)
+            {
+                DispatchMessage(connectionId, std::move(message));
+            }
+            else if (initResult == DCGM_ST_OK)
+            {
+                OnConnectionRemove(connectionId);
+            }
+        }
+    }
+
+    m_initPromise.set_value(initResult);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHostEngineHandler::WaitForInit(std::chrono::milliseconds timeout)
+{
+    if (m_initFuture.wait_for(timeout) != std::future_status::ready)
+    {
+        return DCGM_ST_TIMEOUT;
+    }
+
+    return m_initFuture.get();
 }
 
 /*****************************************************************************/
@@ -23,16 +23,31 @@
 #include "DcgmCacheManager.h"
 #include "DcgmCoreCommunication.h"
 #include "DcgmFieldGroup.h"
+#include "DcgmFvDeliveryQueue.h"
+#include "DcgmFvStreams.h"
 #include "DcgmGroupManager.h"
+#include "DcgmGroupWatches.h"
+#include "DcgmInflightRequests.h"
 #include "DcgmIpc.h"
+#include "DcgmJobJournal.h"
+#include "DcgmJobStats.h"
+#include "DcgmMetricsExporter.h"
 #include "DcgmModule.h"
+#include "DcgmProfMultiplexer.h"
 #include "DcgmRequest.h"
+#include "DcgmValuesCursors.h"
+#include "DcgmWatchedRequests.h"
 #include "DcgmWatcher.h"
 #include "dcgm_agent.h"
 #include <core/DcgmModuleCore.h>
 #include <dcgm_core_communication.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <iostream>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #define INJECTION_MODE_ENV_VAR "NVML_INJECTION_MODE"
@@ -40,14 +55,16 @@
 /* Module status structure */
 typedef struct dcgmhe_module_info_t
 {
-    dcgmModuleId_t id;                /* ID of this module  */
-    dcgmModuleStatus_t status;        /* Status of this module */
-    DcgmModule *ptr;                  /* Pointer to the loaded class of this module */
-    const char *filename;             /* Filename for this module like libdcgmmodulehealth.so */
-    void *dlopenPtr;                  /* Pointer to this loaded module returned by dlopen(). NULL if not loaded */
-    dcgmModuleAlloc_f allocCB;        /* Module function for allocating a DcgmModule object. NULL if not set */
-    dcgmModuleFree_f freeCB;          /* Module function for freeing a DcgmModule object. NULL if not set */
-    dcgmModuleProcessMessage_f msgCB; /* Module function for receiving/processing messages. NULL if not set */
+    dcgmModuleId_t id;                 /* ID of this module  */
+    dcgmModuleStatus_t status;         /* Status of this module */
+    DcgmModule *ptr;                   /* Pointer to the loaded class of this module */
+    const char *filename;              /* Filename for this module like libdcgmmodulehealth.so */
+    void *dlopenPtr;                   /* Pointer to this loaded module returned by dlopen(). NULL if not loaded */
+    dcgmModuleAlloc_f allocCB;         /* Module function for allocating a DcgmModule object. NULL if not set */
+    dcgmModuleFree_f freeCB;           /* Module function for freeing a DcgmModule object. NULL if not set */
+    dcgmModuleProcessMessage_f msgCB;  /* Module function for receiving/processing messages. NULL if not set */
+    dcgmModuleLoadPolicy_t loadPolicy; /* When this module is loaded */
+    long long initTimeUsec;            /* Time LoadModule() spent loading this module. 0 if not loaded */
 } dcgmhe_module_info_t, *dcgmhe_module_info_p;
 
 /* Job definition */
@@ -86,8 +103,38 @@ public:
      The corresponding "C" API will not be in the public header for the agent.
      The "C" API for this method will be part of Internal control APIs which can
      be invoked by NV Host Engine
+     listenFd is a socket that is already bound and listening, like one passed by
+     systemd socket activation. -1 = create one from portNumber and socketPath
      *****************************************************************************/
-    dcgmReturn_t RunServer(unsigned short portNumber, char const *socketPath, unsigned int isConnectionTCP);
+    dcgmReturn_t RunServer(unsigned short portNumber,
+                           char const *socketPath,
+                           unsigned int isConnectionTCP,
+                           int listenFd = -1);
+
+    /*****************************************************************************
+     This method waits up to timeout for the GPUs to be attached when they are
+     attached in the background (__DCGM_BACKGROUND_INIT__=1).
+
+     Returns DCGM_ST_OK once the host engine is fully initialized
+             DCGM_ST_TIMEOUT if it is still attaching the GPUs
+             DCGM_ST_INIT_ERROR if attaching them failed
+     *****************************************************************************/
+    dcgmReturn_t WaitForInit(std::chrono::milliseconds timeout);
+
+    /*****************************************************************************
+     This method starts serving the latest values of watched fields as OpenMetrics
+     text at http://<bindAddress>:<portNumber>/metrics. bindAddress "" or NULL
+     = all interfaces
+     *****************************************************************************/
+    dcgmReturn_t RunMetricsServer(unsigned short portNumber, char const *bindAddress);
+
+    /*****************************************************************************
+     This method watches fieldIds on all GPUs every updateFreqUsec and copies
+     their latest values into the shared memory segment name as they are cached
+     *****************************************************************************/
+    dcgmReturn_t RunSharedLatestValues(std::string const &name,
+                                       std::vector<unsigned short> const &fieldIds,
+                                       timelib64_t updateFreqUsec);
 
     /*****************************************************************************
      * This method is used to handle a client disconnecting from the host engine
@@ -122,6 +169,12 @@ public:
     dcgmReturn_t ProcessModuleCommandMsg(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message);
     dcgmReturn_t ProcessModuleCommand(dcgm_module_command_header_t *moduleCommand);
 
+    /*****************************************************************************
+     Process every module command of a DCGM_MSG_MODULE_COMMAND_BATCH message in
+     this thread and send back one response with all of their responses
+     *****************************************************************************/
+    dcgmReturn_t ProcessModuleCommandBatchMsg(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message);
+
     /*****************************************************************************
      Get the status for an entity
      *****************************************************************************/
@@ -184,15 +237,30 @@ public:
      *****************************************************************************/
     void OnGroupRemove(unsigned int groupId);
 
+    /*****************************************************************************
+     Notify this object that an entity was added to or removed from a group
+     *****************************************************************************/
+    void OnGroupEntitiesChange(unsigned int groupId);
+
     /*****************************************************************************
      Notify this object that field values we subscribed for updated.
      *****************************************************************************/
     void OnFvUpdates(DcgmFvBuffer *fvBuffer, DcgmWatcherType_t *watcherTypes, int numWatcherTypes, void *userData);
 
     /*****************************************************************************
-     Notify this object that mig configuration has updated.
+     Get the counters of the queue that delivers field value updates to moduleId.
+
+     Returns DCGM_ST_OK on success
+             DCGM_ST_NOT_CONFIGURED if updates are delivered to moduleId on the
+                                    cache manager thread
+     *****************************************************************************/
+    dcgmReturn_t GetFvDeliveryStats(dcgmModuleId_t moduleId, dcgm_fv_delivery_stats_t &stats);
+
+    /*****************************************************************************
+     Notify this object that mig configuration has updated. delta lists the MIG
+     entities of gpuId that were added and removed.
      *****************************************************************************/
-    void OnMigUpdates(unsigned int gpuId);
+    void OnMigUpdates(unsigned int gpuId, DcgmMigHierarchyDelta const &delta);
 
     /*****************************************************************************
      * Add a watcher to a local request. This watcher will be assigned a requestId
@@ -275,7 +343,8 @@ public:
                                  timelib64_t monitorIntervalUsec,
                                  double maxSampleAge,
                                  int maxKeepSamples,
-                                 DcgmWatcher const &watcher);
+                                 DcgmWatcher const &watcher,
+                                 bool subscribeForUpdates = false);
 
     /*****************************************************************************
      * Remove a watch on a field group
@@ -285,14 +354,136 @@ public:
      ****************************************************************************/
     dcgmReturn_t UnwatchFieldGroup(unsigned int groupId, dcgmFieldGrp_t fieldGroupId, DcgmWatcher const &watcher);
 
+    /*****************************************************************************
+     * Update the watches of a field group on the entities of a group now,
+     * without updating any other watch. See DcgmCacheManager::UpdateFields()
+     *
+     ****************************************************************************/
+    dcgmReturn_t UpdateFieldGroup(unsigned int groupId, dcgmFieldGrp_t fieldGroupId, int waitForUpdate);
+
+    /*****************************************************************************
+     * Sample the watches of a field group on the entities of a group as one
+     * snapshot. See DcgmCacheManager::SnapshotFields()
+     *
+     ****************************************************************************/
+    dcgmReturn_t SnapshotFieldGroup(unsigned int groupId, dcgmFieldGrp_t fieldGroupId, timelib64_t &snapshotId);
+
+    /*****************************************************************************
+     * Resample the numeric fields of a field group on the entities of a group to
+     * numRows times stepUsec apart, starting at startTime. Each entity and field
+     * is a column, in the order of the group's entities and then the fields.
+     * See DcgmCacheManager::ResampleField()
+     *
+     * numRows    IN/OUT: Rows to resample. Set to the rows that fit in maxValues
+     * columns       OUT: Entity and field of each column
+     * values        OUT: numRows x columns.size() values, row after row
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_MAX_LIMIT if there are more than DCGM_RESAMPLE_MAX_COLUMNS columns
+     *         Other DCGM_ST_? on error
+     ****************************************************************************/
+    dcgmReturn_t ResampleFieldGroup(unsigned int groupId,
+                                    dcgmFieldGrp_t fieldGroupId,
+                                    timelib64_t startTime,
+                                    timelib64_t stepUsec,
+                                    dcgmResampleFill_t fill,
+                                    unsigned int &numRows,
+                                    std::vector<dcgm_entity_key_t> &columns,
+                                    double *values,
+                                    size_t maxValues);
+
+    /*****************************************************************************
+     * Watch a field group on behalf of a remote client and push each update of
+     * it to requestId of connectionId as a DCGM_MSG_FV_NOTIFY after every cache
+     * manager update cycle. An existing subscription of connectionId to the same
+     * groupId and fieldGroupId is replaced and its request is completed.
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NOT_SUPPORTED for embedded clients, which can read the cache directly
+     *         Other DCGM_ST_? from WatchFieldGroup() on error
+     ****************************************************************************/
+    dcgmReturn_t SubscribeFieldGroup(dcgm_connection_id_t connectionId,
+                                     dcgm_request_id_t requestId,
+                                     unsigned int groupId,
+                                     dcgmFieldGrp_t fieldGroupId,
+                                     timelib64_t monitorIntervalUsec,
+                                     double maxSampleAge,
+                                     int maxKeepSamples);
+
+    /*****************************************************************************
+     * Stop pushing updates of a subscription made with SubscribeFieldGroup(),
+     * unwatch its fields and complete its request.
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NOT_WATCHED if connectionId has no such subscription
+     *         Other DCGM_ST_? from UnwatchFieldGroup() on error
+     ****************************************************************************/
+    dcgmReturn_t UnsubscribeFieldGroup(dcgm_connection_id_t connectionId,
+                                       unsigned int groupId,
+                                       dcgmFieldGrp_t fieldGroupId);
+
+    /*****************************************************************************
+     * Send a DCGM_MSG_METADATA_NOTIFY to requestId of connectionId every time
+     * BumpMetadataGeneration() is called, until connectionId disconnects. This
+     * lets clients cache groups, field groups and entities until they change.
+     *
+     * generation OUT: Current metadata generation
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NOT_SUPPORTED for embedded clients, which don't need to cache
+     ****************************************************************************/
+    dcgmReturn_t SubscribeMetadata(dcgm_connection_id_t connectionId,
+                                   dcgm_request_id_t requestId,
+                                   unsigned long long &generation);
+
+    /*****************************************************************************
+     * Note that groups, field groups, MIG instances or topology have changed and
+     * notify the subscribers of SubscribeMetadata()
+     ****************************************************************************/
+    void BumpMetadataGeneration();
+
+    /*****************************************************************************
+     * Open a cursor of connectionId over the cached values of groupId and
+     * fieldGroupId from sinceTimestamp until now.
+     *
+     * Returns DCGM_ST_OK on success. cursorId is set to the new cursor
+     *         Other DCGM_ST_? from DcgmValuesCursors::Open() on error
+     ****************************************************************************/
+    dcgmReturn_t OpenValuesCursor(dcgm_connection_id_t connectionId,
+                                  unsigned int groupId,
+                                  dcgmFieldGrp_t fieldGroupId,
+                                  timelib64_t sinceTimestamp,
+                                  unsigned int &cursorId);
+
+    /*****************************************************************************
+     * Read the next chunk of at most maxBytes of a cursor opened with
+     * OpenValuesCursor(). See DcgmValuesCursors::Next()
+     ****************************************************************************/
+    dcgmReturn_t NextValuesCursor(dcgm_connection_id_t connectionId,
+                                  unsigned int cursorId,
+                                  size_t maxBytes,
+                                  dcgm_values_cursor_chunk_t &chunk);
+
+    /*****************************************************************************
+     * Close a cursor opened with OpenValuesCursor()
+     ****************************************************************************/
+    dcgmReturn_t CloseValuesCursor(dcgm_connection_id_t connectionId, unsigned int cursorId);
+
+    /*****************************************************************************
+     * Fill in the output fields of multiplexInfo for the profiling watch of groupId.
+     * numPasses is 0 if the watch isn't multiplexed
+     ****************************************************************************/
+    void GetProfMultiplexInfo(unsigned int groupId, dcgmProfMultiplexInfo_t &multiplexInfo);
+
     dcgmReturn_t HelperGetTopologyIO(unsigned int groupid, dcgmTopology_t &gpuTopology);
     dcgmReturn_t HelperGetTopologyAffinity(unsigned int groupid, dcgmAffinity_t &gpuAffinity);
     dcgmReturn_t HelperSelectGpusByTopology(uint32_t numGpus, uint64_t inputGpus, uint64_t hints, uint64_t &outputGpus);
-    dcgmReturn_t HelperGetFieldSummary(dcgmFieldSummaryRequest_t &fieldSummary);
+    dcgmReturn_t HelperGetFieldSummary(dcgmFieldSummaryRequest_v2 &fieldSummary);
     dcgmReturn_t HelperCreateFakeEntities(dcgmCreateFakeEntities_t *fakeEntities);
     dcgmReturn_t HelperWatchPredefined(dcgmWatchPredefined_t *watchPredef, DcgmWatcher &dcgmWatcher);
     dcgmReturn_t HelperModuleDenylist(dcgmModuleId_t moduleId);
     dcgmReturn_t HelperModuleStatus(dcgmModuleGetStatuses_v1 &msg);
+    dcgmReturn_t HelperModuleStatus(dcgmModuleGetStatuses_v2 &msg);
     unsigned int GetHostEngineHealth() const;
 
     /*****************************************************************************
@@ -347,12 +538,29 @@ public:
     dcgmReturn_t ResumeModule(dcgmModuleId_t moduleId);
 
 private:
-    DcgmMutex m_lock = DcgmMutex(0);
+    /* Locks of the host engine. A thread that needs more than one takes them in the order they are declared in.
+       m_lock protects the modules in m_modules and m_persistAfterDisconnect */
+    DcgmMutex m_lock         = DcgmMutex(0);
+    DcgmMutex m_jobsLock     = DcgmMutex(0); /* Protects mJobIdMap */
+
+    /**************************************************************************
+     * Process one module command that is in commandBytes, resizing commandBytes
+     * for its response. requestId is used if the command doesn't have one.
+     *
+     * Returns DCGM_ST_OK if the command was processed. requestStatus is what
+     *         processing it returned
+     *         DCGM_ST_BADPARAM if commandBytes doesn't hold a valid module command
+     **************************************************************************/
+    dcgmReturn_t ProcessModuleCommandBytes(dcgm_connection_id_t connectionId,
+                                           dcgm_request_id_t requestId,
+                                           std::vector<char> &commandBytes,
+                                           dcgmReturn_t &requestStatus);
 
     /**************************************************************************
      * Lock/Unlocks methods
      **************************************************************************/
     DcgmLockGuard Lock();
+    DcgmLockGuard LockJobs();
     /**
      * @brief Takes a previously acquired lock guard and releases it by calling its destructor.
      * @param[in] lock  The lock guard that needs to be released.
@@ -421,6 +629,20 @@ private:
                                         int activeOnly,
                                         DcgmWatcher const &watcher);
 
+    /*****************************************************************************
+     * Unwatch fieldIds on the removed entities of delta and watch them on its
+     * added entities. m_groupWatchesMutex must be held.
+     *
+     * shouldUpdateAllFields: Set to true if any of the watches was new. The
+     *                        caller has to UpdateAllFields() then
+     *
+     * Returns the first error from adding watches, else the first from removing them
+     *
+     ****************************************************************************/
+    dcgmReturn_t ApplyGroupWatchDelta(dcgm_group_watch_delta_t const &delta,
+                                      std::vector<unsigned short> const &fieldIds,
+                                      bool &shouldUpdateAllFields);
+
     /*****************************************************************************
      Helper functions for the scheduler hint API
      *****************************************************************************/
@@ -482,6 +704,40 @@ private:
 
     static void StaticProcessDisconnect(dcgm_connection_id_t connectionId, void *userData);
 
+    static void StaticProcessCancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId, void *userData);
+
+    /*****************************************************************************
+     * Stop requestId of connectionId, or every request of connectionId if it is
+     * DCGM_REQUEST_ID_NONE, since its client no longer waits for the response.
+     * Running diagnostics are stopped through the diag module
+     *****************************************************************************/
+    void OnRequestCancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
+
+    /*****************************************************************************
+     * Process a message once the host engine is initialized. Answers it with
+     * the initialization error if initialization failed
+     *****************************************************************************/
+    void DispatchMessage(dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message);
+
+    /*****************************************************************************
+     * Whether message is a cheap request, like the host engine version or
+     * health, that is served while the GPUs are being attached
+     *****************************************************************************/
+    static bool IsServedDuringInit(DcgmMessage &message);
+
+    /*****************************************************************************
+     * The part of construction that attaches the GPUs: loading NVML, the cache
+     * manager, the group managers and the first round of field updates. Throws
+     * std::runtime_error on failure
+     *****************************************************************************/
+    void FinishInit(dcgmStartEmbeddedV2Params_v1 const &params);
+
+    /*****************************************************************************
+     * Serve the requests that were queued during initialization and fulfill
+     * m_initFuture with initResult
+     *****************************************************************************/
+    void SetInitResult(dcgmReturn_t initResult);
+
     /*****************************************************************************/
 
     /*****************************************************************************
@@ -520,13 +776,156 @@ private:
 
     void HandleAddWatchError(int ret, std::string field);
 
+    /*****************************************************************************
+     * Push the values in fvBuffer to the client subscriptions that want them
+     *****************************************************************************/
+    void DispatchFvStreams(DcgmFvBuffer *fvBuffer);
+
+    /*****************************************************************************
+     * Send the values in fvBuffer to moduleId as DCGM_CORE_SR_FIELD_VALUES_UPDATED
+     *****************************************************************************/
+    void SendFvUpdateToModule(dcgmModuleId_t moduleId, DcgmFvBuffer &fvBuffer);
+
+    /*****************************************************************************
+     * Create m_fvDeliveryQueues if __DCGM_FV_DELIVERY_QUEUE_DEPTH__ is set
+     *****************************************************************************/
+    void StartFvDeliveryQueues();
+
+    /*****************************************************************************
+     * Set the load policy of each module from __DCGM_MODULE_LOAD_POLICY__, a comma
+     * separated list of <module name>:<ondemand|prewarm>. Modules that aren't listed
+     * are loaded on demand
+     *****************************************************************************/
+    void ApplyModuleLoadPolicies();
+
+    /*****************************************************************************
+     * Load the DcgmModuleLoadPrewarm modules on m_modulePrewarmThread, one at a time
+     *****************************************************************************/
+    void StartModulePrewarm();
+
+    /*****************************************************************************
+     * Ask the profiling module to watch profFieldIds for groupId on behalf of connectionId
+     *****************************************************************************/
+    dcgmReturn_t SendProfWatchFields(unsigned int groupId,
+                                     dcgm_connection_id_t connectionId,
+                                     std::vector<unsigned short> const &profFieldIds,
+                                     timelib64_t updateFreq,
+                                     double maxKeepAge,
+                                     int maxKeepSamples);
+
+    /*****************************************************************************
+     * Ask the profiling module to stop watching the fields of groupId
+     *****************************************************************************/
+    dcgmReturn_t SendProfUnwatchFields(unsigned int groupId, dcgm_connection_id_t connectionId);
+
+    /*****************************************************************************
+     * Replace what the profiling module watches for groupId with the fieldIds of
+     * one pass of watch. Called by m_profMultiplexer
+     *****************************************************************************/
+    dcgmReturn_t ApplyProfMultiplexPass(unsigned int groupId,
+                                        DcgmProfMultiplexWatch const &watch,
+                                        std::vector<unsigned short> const &fieldIds);
+
+    /*****************************************************************************
+     * Watch profFieldIds of groupId, which the profiling module can't collect in
+     * a single pass, by rotating through passes of them with m_profMultiplexer.
+     * entities are the ones of groupId that the profiling module services
+     *****************************************************************************/
+    dcgmReturn_t MultiplexProfWatch(unsigned int groupId,
+                                    std::vector<dcgmGroupEntityPair_t> const &entities,
+                                    std::vector<unsigned short> const &profFieldIds,
+                                    DcgmWatcher const &watcher,
+                                    timelib64_t updateFreq,
+                                    double maxKeepAge,
+                                    int maxKeepSamples);
+
+    /*****************************************************************************
+     * Subscribe for or unsubscribe from DcgmJobStats::c_fieldIds of gpuIds as the
+     * host engine. The subscription never shortens the interval or the sample age
+     * of the client's own job watches. Caller must hold m_jobStatsWatchMutex
+     *****************************************************************************/
+    void WatchJobStatsFields(std::vector<unsigned int> const &gpuIds, bool watch);
+
+    /*****************************************************************************
+     * Resolve the entity + field keys of groupId and fieldGroupId, the way the
+     * cache manager stores them. Global fields are keyed under DCGM_FE_NONE
+     *****************************************************************************/
+    dcgmReturn_t GetFieldGroupKeys(unsigned int groupId,
+                                   dcgmFieldGrp_t fieldGroupId,
+                                   std::vector<dcgm_entity_key_t> &keys);
+
     /* This data structure stores pluggable modules for handling client requests */
     dcgmhe_module_info_t m_modules[DcgmModuleIdCount] {};
 
-    /* Watched requests. Currently used to track policy management callbacks. Protected by Lock()/Unlock() */
-    dcgm_request_id_t m_nextWatchedRequestId {};
-    typedef std::unordered_map<dcgm_request_id_t, std::unique_ptr<DcgmRequest>> watchedRequests_t;
-    watchedRequests_t m_watchedRequests;
+    /* Watched requests. Currently used to track policy management callbacks. Has its own lock, which is
+       never held while a message is delivered to a request */
+    DcgmWatchedRequests m_watchedRequests;
+
+    /* Client subscriptions from SubscribeFieldGroup(). Has its own lock since it is
+       dispatched from the cache manager update thread */
+    DcgmFvStreams m_fvStreams;
+
+    /* Metadata generation and the connectionId -> requestId of each subscriber of SubscribeMetadata().
+       The subscribers are protected by m_metadataMutex */
+    std::atomic<unsigned long long> m_metadataGeneration { 1 };
+    std::mutex m_metadataMutex;
+    std::unordered_map<dcgm_connection_id_t, dcgm_request_id_t> m_metadataSubscribers;
+
+    /* Client cursors from OpenValuesCursor(). Has its own lock so that chunks are read without the host
+       engine lock */
+    DcgmValuesCursors m_valuesCursors;
+
+    /* Running statistics of the jobs in mJobIdMap. Has its own lock since it is updated from the
+       cache manager update thread */
+    DcgmJobStats m_jobStats;
+
+    /* Serializes starting and stopping jobs with the watches WatchJobStatsFields() adds and removes for them */
+    std::mutex m_jobStatsWatchMutex;
+
+    /* Client requests being processed, so that cancelled or timed out ones can stop early. Has its own lock */
+    DcgmInflightRequests m_inflightRequests;
+
+    /* Field group watches bound to their group, so that membership changes only watch or unwatch the
+       entities that changed. Protected by m_groupWatchesMutex, which is also held while the resulting
+       deltas are applied to the cache manager so that they land in order */
+    DcgmGroupWatches m_groupWatches;
+    std::mutex m_groupWatchesMutex;
+
+    /* Statistics of stopped jobs, kept across JobRemove() and restarts. Null unless __DCGM_JOB_JOURNAL_FILE__
+       is set. Only set during construction */
+    std::unique_ptr<DcgmJobJournal> m_jobJournal;
+
+    /* Per-module queues that deliver field value updates off of the cache manager thread. Null for modules
+       that are sent updates on the cache manager thread. Only set during construction */
+    std::unique_ptr<DcgmFvDeliveryQueue> m_fvDeliveryQueues[DcgmModuleIdCount];
+
+    /* Serves /metrics if RunMetricsServer() was called. Reads mpCacheManager, so it's stopped before that is freed */
+    std::unique_ptr<DcgmMetricsExporter> m_metricsExporter;
+
+    /* Loads the DcgmModuleLoadPrewarm modules once RunServer() succeeds. Stopped before the modules are freed */
+    std::jthread m_modulePrewarmThread;
+
+    /* Runs FinishInit() when __DCGM_BACKGROUND_INIT__=1, so that RunServer() can accept connections while the
+       GPUs are attached. Joined before anything it initializes is freed */
+    std::jthread m_initThread;
+
+    /* Fulfilled with the result of FinishInit() once the requests queued during it are served */
+    std::promise<dcgmReturn_t> m_initPromise;
+    std::shared_future<dcgmReturn_t> m_initFuture { m_initPromise.get_future().share() };
+
+    /* Requests that arrived during initialization and the disconnects after them (null message), in arrival
+       order. m_initDone is set once the last of them is served. Both are protected by m_pendingRequestsMutex */
+    std::mutex m_pendingRequestsMutex;
+    std::deque<std::pair<dcgm_connection_id_t, std::unique_ptr<DcgmMessage>>> m_pendingRequests;
+    std::atomic<bool> m_initDone {};
+    dcgmReturn_t m_initResult = DCGM_ST_OK;
+
+    /* Rotates the profiling watches that can't be collected in a single pass. Stopped before the modules are freed */
+    DcgmProfMultiplexer m_profMultiplexer {
+        [this](unsigned int groupId, DcgmProfMultiplexWatch const &watch, std::vector<unsigned short> const &fieldIds) {
+            return ApplyProfMultiplexPass(groupId, watch, fieldIds);
+        }
+    };
 
     unsigned int m_hostengineHealth {};
     std::string m_serviceAccount;
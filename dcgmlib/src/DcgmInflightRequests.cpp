@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmInflightRequests.h"
+
+#include <algorithm>
+
+thread_local DcgmInflightRequests::Request *DcgmInflightRequests::t_current = nullptr;
+
+/*****************************************************************************/
+DcgmInflightRequests::Scope::Scope(DcgmInflightRequests &owner,
+                                   dcgm_connection_id_t connectionId,
+                                   dcgm_request_id_t requestId,
+                                   int timeoutMs)
+    : m_owner(owner)
+    , m_previous(t_current)
+{
+    m_request.connectionId = connectionId;
+    m_request.requestId    = requestId;
+    m_request.deadline     = timeoutMs > 0
+                                 ? std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs)
+                                 : std::chrono::steady_clock::time_point::max();
+
+    {
+        std::lock_guard<std::mutex> lock(m_owner.m_mutex);
+        m_owner.m_requests.emplace(connectionId, &m_request);
+    }
+    t_current = &m_request;
+}
+
+/*****************************************************************************/
+DcgmInflightRequests::Scope::~Scope()
+{
+    t_current = m_previous;
+
+    std::lock_guard<std::mutex> lock(m_owner.m_mutex);
+    auto [begin, end] = m_owner.m_requests.equal_range(m_request.connectionId);
+    auto it = std::find_if(begin, end, [this](auto const &entry) { return entry.second == &m_request; });
+    if (it != end)
+    {
+        m_owner.m_requests.erase(it);
+    }
+}
+
+/*****************************************************************************/
+void DcgmInflightRequests::SetCurrentCommand(dcgmModuleId_t moduleId, unsigned int subCommand)
+{
+    if (t_current == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    t_current->command = { moduleId, subCommand };
+}
+
+/*****************************************************************************/
+std::vector<dcgm_inflight_command_t> DcgmInflightRequests::Cancel(dcgm_connection_id_t connectionId,
+                                                                  dcgm_request_id_t requestId)
+{
+    std::vector<dcgm_inflight_command_t> commands;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [begin, end] = m_requests.equal_range(connectionId);
+    for (auto it = begin; it != end; ++it)
+    {
+        Request &request = *it->second;
+        if (requestId != DCGM_REQUEST_ID_NONE && request.requestId != requestId)
+        {
+            continue;
+        }
+
+        request.isCancelled.store(true, std::memory_order_relaxed);
+        commands.push_back(request.command);
+    }
+
+    return commands;
+}
+
+/*****************************************************************************/
+bool DcgmInflightRequests::ShouldStop()
+{
+    Request const *request = t_current;
+    if (request == nullptr)
+    {
+        return false;
+    }
+
+    if (request->isCancelled.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+
+    return request->deadline != std::chrono::steady_clock::time_point::max()
+           && std::chrono::steady_clock::now() >= request->deadline;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmProtocol.h"
+#include "dcgm_structs.h"
+#include "dcgm_structs_internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/* The module command a request was running when it was cancelled */
+struct dcgm_inflight_command_t
+{
+    dcgmModuleId_t moduleId;
+    unsigned int subCommand;
+};
+
+/*****************************************************************************/
+/*
+ * Client requests the host engine is processing, so that work nobody waits for
+ * anymore can stop early: the client's timeout passed, it cancelled the
+ * request or its connection closed.
+ *
+ * The worker processing a request holds a Scope for it. Long operations on
+ * that thread poll ShouldStop() at interruption points and give up with
+ * DCGM_ST_TIMEOUT once it returns true. The short response that follows is
+ * sent as usual and ignored by the client.
+ */
+class DcgmInflightRequests
+{
+    struct Request
+    {
+        dcgm_connection_id_t connectionId;
+        dcgm_request_id_t requestId;
+        std::chrono::steady_clock::time_point deadline; /* time_point::max() if there is none */
+        std::atomic<bool> isCancelled { false };
+        dcgm_inflight_command_t command {}; /* Protected by m_mutex of the owner */
+    };
+
+public:
+    /*************************************************************************/
+    /* Track a request for as long as the calling thread processes it */
+    class Scope
+    {
+    public:
+        /* timeoutMs is the header timeoutMs of the request, counted from now. 0 = no deadline */
+        Scope(DcgmInflightRequests &owner,
+              dcgm_connection_id_t connectionId,
+              dcgm_request_id_t requestId,
+              int timeoutMs);
+        ~Scope();
+
+        Scope(Scope const &)            = delete;
+        Scope &operator=(Scope const &) = delete;
+
+    private:
+        DcgmInflightRequests &m_owner;
+        Request m_request;
+        Request *m_previous; /* Request of the calling thread before this one */
+    };
+
+    /*************************************************************************/
+    /*
+     * Note the module command the request of the calling thread is running.
+     * A batch sets each of its commands in turn. No-op outside of a Scope
+     */
+    void SetCurrentCommand(dcgmModuleId_t moduleId, unsigned int subCommand);
+
+    /*************************************************************************/
+    /*
+     * Have requestId of connectionId stop, or every request of connectionId
+     * if requestId is DCGM_REQUEST_ID_NONE.
+     *
+     * RETURNS: The module commands the cancelled requests are running, for
+     *          the ones that can only be stopped from outside
+     */
+    std::vector<dcgm_inflight_command_t> Cancel(dcgm_connection_id_t connectionId, dcgm_request_id_t requestId);
+
+    /*************************************************************************/
+    /*
+     * Should the request the calling thread is processing stop?
+     *
+     * RETURNS: true if it was cancelled or its deadline passed
+     *          false otherwise, or if the thread isn't processing a request
+     */
+    static bool ShouldStop();
+
+private:
+    std::mutex m_mutex; /* Protects m_requests */
+    std::unordered_multimap<dcgm_connection_id_t, Request *> m_requests;
+
+    static thread_local Request *t_current; /* Innermost request of the calling thread. nullptr if none */
+};
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmJobJournal.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr char c_journalMagic[8]        = { 'D', 'C', 'G', 'M', 'J', 'O', 'B', 'J' };
+constexpr std::uint32_t c_journalFormat = 1;
+constexpr size_t c_jobIdBytes           = 64;
+constexpr size_t c_initialFileBytes     = 1024 * 1024;
+
+/* On-disk layout. The header is followed by usedBytes of records. Each record is followed by the summary
+   and then by numGpus dcgmGpuUsageInfo_t of the job's GPUs */
+struct JournalFileHeader
+{
+    char magic[8];
+    std::uint32_t format;
+    std::uint32_t jobInfoVersion; /* dcgmJobInfo_version the records were written with */
+    std::uint64_t numRecords;
+    std::uint64_t usedBytes; /* Bytes of complete records after the header */
+};
+static_assert(sizeof(JournalFileHeader) == 32);
+
+struct JournalFileRecord
+{
+    char jobId[c_jobIdBytes];
+    std::int64_t endTime;
+    std::uint32_t numGpus;
+    std::uint32_t recordBytes; /* Including this struct */
+};
+static_assert(sizeof(JournalFileRecord) == 80);
+static_assert(sizeof(JournalFileRecord) % alignof(dcgmGpuUsageInfo_t) == 0);
+static_assert(sizeof(dcgmGpuUsageInfo_t) % alignof(JournalFileRecord) == 0);
+
+size_t RecordBytes(unsigned int numGpus)
+{
+    return sizeof(JournalFileRecord) + (1 + numGpus) * sizeof(dcgmGpuUsageInfo_t);
+}
+} // namespace
+
+/*****************************************************************************/
+DcgmJobJournal::~DcgmJobJournal()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CloseLocked();
+}
+
+/*****************************************************************************/
+void DcgmJobJournal::CloseLocked()
+{
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, m_mappingBytes);
+        m_mapping      = nullptr;
+        m_mappingBytes = 0;
+    }
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+    m_byJobId.clear();
+    m_byEndTime.clear();
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobJournal::GrowLocked(size_t fileBytes)
+{
+    if (ftruncate(m_fd, (off_t)fileBytes) != 0)
+    {
+        log_error("Unable to size {} to {} bytes. errno {}", m_path, fileBytes, errno);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    void *mapping = mmap(nullptr, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        log_error("Unable to map {}. errno {}", m_path, errno);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, m_mappingBytes);
+    }
+    m_mapping      = static_cast<unsigned char *>(mapping);
+    m_mappingBytes = fileBytes;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmJobJournal::IndexRecordLocked(size_t offset)
+{
+    auto const *record = reinterpret_cast<JournalFileRecord const *>(m_mapping + offset);
+
+    m_byJobId[std::string(record->jobId, strnlen(record->jobId, c_jobIdBytes))] = offset;
+    m_byEndTime.emplace(record->endTime, offset);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobJournal::Open(std::string const &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CloseLocked();
+    m_path = path;
+
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (m_fd < 0)
+    {
+        log_error("Unable to open {}. errno {}", path, errno);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    struct stat st {};
+    if (fstat(m_fd, &st) != 0)
+    {
+        log_error("Unable to stat {}. errno {}", path, errno);
+        CloseLocked();
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    bool const isNew        = st.st_size == 0;
+    dcgmReturn_t dcgmReturn = GrowLocked(isNew ? c_initialFileBytes : (size_t)st.st_size);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        CloseLocked();
+        return dcgmReturn;
+    }
+
+    auto *header = reinterpret_cast<JournalFileHeader *>(m_mapping);
+    if (isNew)
+    {
+        memcpy(header->magic, c_journalMagic, sizeof(header->magic));
+        header->format         = c_journalFormat;
+        header->jobInfoVersion = dcgmJobInfo_version;
+        header->numRecords     = 0;
+        header->usedBytes      = 0;
+        return DCGM_ST_OK;
+    }
+
+    if (m_mappingBytes < sizeof(JournalFileHeader)
+        || memcmp(header->magic, c_journalMagic, sizeof(c_journalMagic)) != 0 || header->format != c_journalFormat
+        || header->jobInfoVersion != dcgmJobInfo_version)
+    {
+        log_error("{} is not a job journal of format {} with dcgmJobInfo_t version {:X}",
+                  path,
+                  c_journalFormat,
+                  dcgmJobInfo_version);
+        CloseLocked();
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    /* Walk the records, stopping at the first one that doesn't fit, in case the header was corrupted */
+    size_t const endOffset        = sizeof(JournalFileHeader) + header->usedBytes;
+    size_t offset                 = sizeof(JournalFileHeader);
+    unsigned long long numRecords = 0;
+
+    while (numRecords < header->numRecords && offset + sizeof(JournalFileRecord) <= endOffset
+           && endOffset <= m_mappingBytes)
+    {
+        auto const *record = reinterpret_cast<JournalFileRecord const *>(m_mapping + offset);
+        if (record->numGpus > DCGM_MAX_NUM_DEVICES || record->recordBytes != RecordBytes(record->numGpus)
+            || offset + record->recordBytes > endOffset)
+        {
+            break;
+        }
+
+        IndexRecordLocked(offset);
+        offset += record->recordBytes;
+        numRecords++;
+    }
+
+    if (numRecords != header->numRecords)
+    {
+        log_warning("{} has {} readable records out of {}. Later records will replace the rest",
+                    path,
+                    numRecords,
+                    header->numRecords);
+        header->numRecords = numRecords;
+        header->usedBytes  = offset - sizeof(JournalFileHeader);
+    }
+
+    log_debug("Opened job journal {} with {} records", path, numRecords);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobJournal::Append(std::string const &jobId, dcgmJobInfo_t const &jobInfo)
+{
+    if (jobId.size() >= c_jobIdBytes || jobInfo.numGpus < 0 || jobInfo.numGpus > DCGM_MAX_NUM_DEVICES)
+    {
+        log_error("Invalid job {} with {} GPUs", jobId, jobInfo.numGpus);
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_mapping == nullptr)
+    {
+        return DCGM_ST_UNINITIALIZED;
+    }
+
+    size_t const recordBytes = RecordBytes(jobInfo.numGpus);
+    size_t const offset
+        = sizeof(JournalFileHeader) + reinterpret_cast<JournalFileHeader const *>(m_mapping)->usedBytes;
+
+    if (offset + recordBytes > m_mappingBytes)
+    {
+        dcgmReturn_t dcgmReturn = GrowLocked(std::max(2 * m_mappingBytes, offset + recordBytes));
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+    }
+
+    auto *record = reinterpret_cast<JournalFileRecord *>(m_mapping + offset);
+    memset(record->jobId, 0, sizeof(record->jobId));
+    memcpy(record->jobId, jobId.data(), jobId.size());
+    record->endTime     = jobInfo.summary.endTime;
+    record->numGpus     = jobInfo.numGpus;
+    record->recordBytes = recordBytes;
+
+    auto *usageInfo = reinterpret_cast<dcgmGpuUsageInfo_t *>(record + 1);
+    memcpy(&usageInfo[0], &jobInfo.summary, sizeof(jobInfo.summary));
+    memcpy(&usageInfo[1], &jobInfo.gpus[0], jobInfo.numGpus * sizeof(jobInfo.gpus[0]));
+
+    /* Only count the record once it's complete */
+    auto *header = reinterpret_cast<JournalFileHeader *>(m_mapping);
+    header->usedBytes += recordBytes;
+    header->numRecords++;
+
+    IndexRecordLocked(offset);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobJournal::Get(std::string const &jobId, dcgmJobInfo_t &jobInfo) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_byJobId.find(jobId);
+    if (it == m_byJobId.end())
+    {
+        return DCGM_ST_NO_DATA;
+    }
+
+    auto const *record    = reinterpret_cast<JournalFileRecord const *>(m_mapping + it->second);
+    auto const *usageInfo = reinterpret_cast<dcgmGpuUsageInfo_t const *>(record + 1);
+
+    jobInfo.version = dcgmJobInfo_version;
+    jobInfo.numGpus = record->numGpus;
+    memcpy(&jobInfo.summary, &usageInfo[0], sizeof(jobInfo.summary));
+    memcpy(&jobInfo.gpus[0], &usageInfo[1], record->numGpus * sizeof(jobInfo.gpus[0]));
+    memset(&jobInfo.gpus[record->numGpus], 0, (DCGM_MAX_NUM_DEVICES - record->numGpus) * sizeof(jobInfo.gpus[0]));
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+std::vector<std::string> DcgmJobJournal::GetJobIdsEndedBetween(timelib64_t startTime, timelib64_t endTime) const
+{
+    std::vector<std::string> jobIds;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_byEndTime.lower_bound(startTime); it != m_byEndTime.end() && it->first <= endTime; ++it)
+    {
+        auto const *record = reinterpret_cast<JournalFileRecord const *>(m_mapping + it->second);
+        std::string jobId(record->jobId, strnlen(record->jobId, c_jobIdBytes));
+
+        /* Skip records that were superseded by a later one of the same job */
+        if (m_byJobId.at(jobId) == it->second)
+        {
+            jobIds.push_back(std::move(jobId));
+        }
+    }
+
+    return jobIds;
+}
+
+/*****************************************************************************/
+unsigned long long DcgmJobJournal::GetRecordCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_mapping == nullptr)
+    {
+        return 0;
+    }
+    return reinterpret_cast<JournalFileHeader const *>(m_mapping)->numRecords;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+#include "timelib.h"
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Append-only file of the statistics of stopped jobs, so that they can still be
+ * looked up after the job was removed, its samples aged out of the cache or the
+ * host engine restarted.
+ *
+ * The file is memory-mapped. Each record holds a job's summary and only the GPUs
+ * it ran on. The record count in the file header is only bumped once a record is
+ * completely written, so a crash mid-append loses that record and nothing else.
+ * Records are indexed by job ID and by end time when the file is opened and as
+ * they are appended. The most recent record of a job ID wins.
+ *
+ * All methods are thread safe.
+ */
+class DcgmJobJournal
+{
+public:
+    DcgmJobJournal() = default;
+    ~DcgmJobJournal();
+
+    DcgmJobJournal(DcgmJobJournal const &)            = delete;
+    DcgmJobJournal &operator=(DcgmJobJournal const &) = delete;
+
+    /*************************************************************************/
+    /*
+     * Open the journal at path, creating it if it doesn't exist
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_VER_MISMATCH if the file isn't a journal of this format and dcgmJobInfo_t version
+     *         DCGM_ST_GENERIC_ERROR if the file can't be opened or mapped
+     */
+    dcgmReturn_t Open(std::string const &path);
+
+    /*************************************************************************/
+    /*
+     * Append the statistics of jobId
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_BADPARAM if jobId is too long or jobInfo is invalid
+     *         DCGM_ST_UNINITIALIZED if the journal isn't open
+     *         DCGM_ST_GENERIC_ERROR if the file can't be grown
+     */
+    dcgmReturn_t Append(std::string const &jobId, dcgmJobInfo_t const &jobInfo);
+
+    /*************************************************************************/
+    /*
+     * Get the most recently appended statistics of jobId
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NO_DATA if jobId isn't in the journal
+     */
+    dcgmReturn_t Get(std::string const &jobId, dcgmJobInfo_t &jobInfo) const;
+
+    /*************************************************************************/
+    /* Get the IDs of the jobs that ended between startTime and endTime, inclusive, by end time */
+    std::vector<std::string> GetJobIdsEndedBetween(timelib64_t startTime, timelib64_t endTime) const;
+
+    /*************************************************************************/
+    /* Number of records in the journal, including superseded ones */
+    unsigned long long GetRecordCount() const;
+
+private:
+    /*************************************************************************/
+    /* Resize the file to at least fileBytes and map it again. Caller must hold m_mutex */
+    dcgmReturn_t GrowLocked(size_t fileBytes);
+
+    /*************************************************************************/
+    /* Add the record at offset to the indexes. Caller must hold m_mutex */
+    void IndexRecordLocked(size_t offset);
+
+    /*************************************************************************/
+    void CloseLocked();
+
+    mutable std::mutex m_mutex; /* Protects all of the below */
+    std::string m_path;
+    int m_fd                 = -1;
+    unsigned char *m_mapping = nullptr;
+    size_t m_mappingBytes    = 0;
+    std::unordered_map<std::string, size_t> m_byJobId; /* jobId -> offset of its latest record */
+    std::multimap<timelib64_t, size_t> m_byEndTime;    /* endTime -> offset of each record */
+};
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmJobStats.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+template <typename T>
+T BlankValue()
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return DCGM_FP64_BLANK;
+    }
+    else
+    {
+        return DCGM_INT64_BLANK;
+    }
+}
+} // namespace
+
+/*****************************************************************************/
+template <typename T>
+void DcgmJobFieldAccumulator<T>::Add(timelib64_t timestamp, T value, bool isBlank)
+{
+    m_summary.Add(value, isBlank);
+    if (isBlank)
+    {
+        /* No area is added on either side of a blank sample */
+        m_lastWasBlank = true;
+        return;
+    }
+
+    if (m_lastTimestamp == 0)
+    {
+        m_firstValue = value;
+    }
+    else if (!m_lastWasBlank)
+    {
+        /* Trapezoid between this sample and the previous one */
+        m_integral += (value + m_lastValue) / 2 * (timestamp - m_lastTimestamp);
+    }
+
+    m_lastValue     = value;
+    m_lastTimestamp = timestamp;
+    m_lastWasBlank  = false;
+}
+
+/*****************************************************************************/
+template <typename T>
+dcgmReturn_t DcgmJobFieldAccumulator<T>::Summarize(int numSummaryTypes,
+                                                   DcgmcmSummaryType_t const *summaryTypes,
+                                                   T *summaryValues) const
+{
+    for (int i = 0; i < numSummaryTypes; i++)
+    {
+        summaryValues[i] = BlankValue<T>();
+    }
+
+    if (m_summary.count == 0)
+    {
+        return DCGM_ST_NO_DATA;
+    }
+
+    if (m_summary.nonBlankCount == 0)
+    {
+        return DCGM_ST_OK;
+    }
+
+    for (int i = 0; i < numSummaryTypes; i++)
+    {
+        switch (summaryTypes[i])
+        {
+            case DcgmcmSummaryTypeMinimum:
+                summaryValues[i] = m_summary.minValue;
+                break;
+            case DcgmcmSummaryTypeMaximum:
+                summaryValues[i] = m_summary.maxValue;
+                break;
+            case DcgmcmSummaryTypeAverage:
+                /* Blank samples count toward the average, same as the cache manager's */
+                summaryValues[i] = m_summary.sumValue / static_cast<T>(m_summary.count);
+                break;
+            case DcgmcmSummaryTypeSum:
+                summaryValues[i] = m_summary.sumValue;
+                break;
+            case DcgmcmSummaryTypeCount:
+                summaryValues[i] = static_cast<T>(m_summary.count);
+                break;
+            case DcgmcmSummaryTypeIntegral:
+                summaryValues[i] = m_integral;
+                break;
+            case DcgmcmSummaryTypeDifference:
+                summaryValues[i] = m_lastValue - m_firstValue;
+                break;
+            default:
+                log_error("Unhandled summaryType {}", (int)summaryTypes[i]);
+                return DCGM_ST_BADPARAM;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+template class DcgmJobFieldAccumulator<long long>;
+template class DcgmJobFieldAccumulator<double>;
+
+/*****************************************************************************/
+std::vector<unsigned int> DcgmJobStats::StartJob(std::string const &jobId,
+                                                 timelib64_t startTime,
+                                                 std::vector<unsigned int> const &gpuIds)
+{
+    Job job;
+    job.startTime = startTime;
+    for (unsigned int gpuId : gpuIds)
+    {
+        job.gpus.try_emplace(gpuId);
+    }
+
+    std::vector<unsigned int> newlyWatchedGpuIds;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto [it, inserted] = m_jobs.try_emplace(jobId, std::move(job));
+    if (!inserted)
+    {
+        /* The host engine rejects duplicate job IDs before it gets here */
+        return newlyWatchedGpuIds;
+    }
+
+    for (auto const &[gpuId, gpuStats] : it->second.gpus)
+    {
+        if (m_runningJobsPerGpu[gpuId]++ == 0)
+        {
+            newlyWatchedGpuIds.push_back(gpuId);
+        }
+    }
+
+    return newlyWatchedGpuIds;
+}
+
+/*****************************************************************************/
+std::vector<unsigned int> DcgmJobStats::StopJobLocked(Job &job, timelib64_t endTime)
+{
+    std::vector<unsigned int> unwatchedGpuIds;
+
+    if (job.endTime != 0)
+    {
+        return unwatchedGpuIds;
+    }
+
+    job.endTime = endTime;
+
+    for (auto const &[gpuId, gpuStats] : job.gpus)
+    {
+        auto running = m_runningJobsPerGpu.find(gpuId);
+        if (running == m_runningJobsPerGpu.end())
+        {
+            continue;
+        }
+
+        if (--running->second == 0)
+        {
+            m_runningJobsPerGpu.erase(running);
+            unwatchedGpuIds.push_back(gpuId);
+        }
+    }
+
+    return unwatchedGpuIds;
+}
+
+/*****************************************************************************/
+std::vector<unsigned int> DcgmJobStats::StopJob(std::string const &jobId, timelib64_t endTime)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end())
+    {
+        return {};
+    }
+
+    return StopJobLocked(it->second, endTime);
+}
+
+/*****************************************************************************/
+std::vector<unsigned int> DcgmJobStats::RemoveJob(std::string const &jobId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end())
+    {
+        return {};
+    }
+
+    std::vector<unsigned int> unwatchedGpuIds = StopJobLocked(it->second, timelib_usecSince1970());
+    m_jobs.erase(it);
+    return unwatchedGpuIds;
+}
+
+/*****************************************************************************/
+std::vector<unsigned int> DcgmJobStats::RemoveAllJobs()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<unsigned int> unwatchedGpuIds;
+    for (auto const &[gpuId, numJobs] : m_runningJobsPerGpu)
+    {
+        unwatchedGpuIds.push_back(gpuId);
+    }
+
+    m_runningJobsPerGpu.clear();
+    m_jobs.clear();
+    return unwatchedGpuIds;
+}
+
+/*****************************************************************************/
+void DcgmJobStats::Update(DcgmFvBuffer &fvBuffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_runningJobsPerGpu.empty())
+    {
+        return;
+    }
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        if (fv->entityGroupId != DCGM_FE_GPU || !m_runningJobsPerGpu.contains(fv->entityId)
+            || std::ranges::find(c_fieldIds, fv->fieldId) == c_fieldIds.end())
+        {
+            continue;
+        }
+
+        for (auto &[jobId, job] : m_jobs)
+        {
+            if (job.endTime != 0 || fv->timestamp < job.startTime)
+            {
+                continue;
+            }
+
+            auto gpu = job.gpus.find(fv->entityId);
+            if (gpu == job.gpus.end())
+            {
+                continue;
+            }
+
+            GpuStats &gpuStats = gpu->second;
+            bool const isError = fv->status != DCGM_ST_OK;
+
+            if (fv->fieldType == DCGM_FT_DOUBLE)
+            {
+                gpuStats.fp64Fields[fv->fieldId].Add(
+                    fv->timestamp, fv->value.dbl, isError || DCGM_FP64_IS_BLANK(fv->value.dbl));
+            }
+            else if (fv->fieldType == DCGM_FT_INT64)
+            {
+                bool const isBlank = isError || DCGM_INT64_IS_BLANK(fv->value.i64);
+                gpuStats.int64Fields[fv->fieldId].Add(fv->timestamp, fv->value.i64, isBlank);
+
+                if (fv->fieldId == DCGM_FI_DEV_XID_ERRORS && !isBlank
+                    && gpuStats.xidTimestamps.size() < c_maxXidTimestamps)
+                {
+                    gpuStats.xidTimestamps.push_back(fv->timestamp);
+                }
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobStats::GetGpuIds(std::string const &jobId, std::vector<unsigned int> &gpuIds) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_jobs.find(jobId);
+    if (it == m_jobs.end())
+    {
+        return DCGM_ST_NO_DATA;
+    }
+
+    gpuIds.clear();
+    for (auto const &[gpuId, gpuStats] : it->second.gpus)
+    {
+        gpuIds.push_back(gpuId);
+    }
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+DcgmJobStats::GpuStats const *DcgmJobStats::FindGpuLocked(std::string const &jobId, unsigned int gpuId) const
+{
+    auto job = m_jobs.find(jobId);
+    if (job == m_jobs.end())
+    {
+        return nullptr;
+    }
+
+    auto gpu = job->second.gpus.find(gpuId);
+    if (gpu == job->second.gpus.end())
+    {
+        return nullptr;
+    }
+
+    return &gpu->second;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobStats::GetInt64Summary(std::string const &jobId,
+                                           unsigned int gpuId,
+                                           unsigned short fieldId,
+                                           int numSummaryTypes,
+                                           DcgmcmSummaryType_t const *summaryTypes,
+                                           long long *summaryValues) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    GpuStats const *gpuStats = FindGpuLocked(jobId, gpuId);
+    if (gpuStats != nullptr)
+    {
+        auto field = gpuStats->int64Fields.find(fieldId);
+        if (field != gpuStats->int64Fields.end())
+        {
+            return field->second.Summarize(numSummaryTypes, summaryTypes, summaryValues);
+        }
+    }
+
+    /* No sample yet */
+    return DcgmJobFieldAccumulator<long long> {}.Summarize(numSummaryTypes, summaryTypes, summaryValues);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmJobStats::GetFp64Summary(std::string const &jobId,
+                                          unsigned int gpuId,
+                                          unsigned short fieldId,
+                                          int numSummaryTypes,
+                                          DcgmcmSummaryType_t const *summaryTypes,
+                                          double *summaryValues) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    GpuStats const *gpuStats = FindGpuLocked(jobId, gpuId);
+    if (gpuStats != nullptr)
+    {
+        auto field = gpuStats->fp64Fields.find(fieldId);
+        if (field != gpuStats->fp64Fields.end())
+        {
+            return field->second.Summarize(numSummaryTypes, summaryTypes, summaryValues);
+        }
+    }
+
+    /* No sample yet */
+    return DcgmJobFieldAccumulator<double> {}.Summarize(numSummaryTypes, summaryTypes, summaryValues);
+}
+
+/*****************************************************************************/
+std::vector<timelib64_t> DcgmJobStats::GetXidTimestamps(std::string const &jobId, unsigned int gpuId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    GpuStats const *gpuStats = FindGpuLocked(jobId, gpuId);
+    if (gpuStats == nullptr)
+    {
+        return {};
+    }
+
+    return gpuStats->xidTimestamps;
+}
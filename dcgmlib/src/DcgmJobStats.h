@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmCacheManager.h"
+#include "DcgmFvBuffer.h"
+#include "DcgmSampleRollups.h"
+#include "dcgm_fields.h"
+#include "dcgm_structs.h"
+#include "timelib.h"
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Running summary of one field of one GPU over a job.
+ *
+ * Summarize() answers the same summary types as DcgmCacheManager::GetInt64SummaryData()
+ * and GetFp64SummaryData() would for the samples that were added, without keeping them.
+ */
+template <typename T>
+class DcgmJobFieldAccumulator
+{
+public:
+    /*************************************************************************/
+    /* Add a sample. Samples have to be added in timestamp order */
+    void Add(timelib64_t timestamp, T value, bool isBlank);
+
+    /*************************************************************************/
+    /*
+     * Fill summaryValues[i] with the summary of type summaryTypes[i] of the samples so far.
+     * Values are blank if every sample was blank.
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_NO_DATA if no sample was added
+     *          DCGM_ST_BADPARAM for an unknown summary type
+     */
+    dcgmReturn_t Summarize(int numSummaryTypes, DcgmcmSummaryType_t const *summaryTypes, T *summaryValues) const;
+
+private:
+    DcgmRollupSummary<T> m_summary {};
+    T m_integral {};
+    T m_firstValue {};
+    T m_lastValue {};
+    timelib64_t m_lastTimestamp = 0; /* Timestamp of m_lastValue. 0 if there is no non-blank sample yet */
+    bool m_lastWasBlank         = true;
+};
+
+/*****************************************************************************/
+/*
+ * Per-GPU running statistics of the jobs started with JobStartStats().
+ *
+ * Update() is given each cache manager update cycle's values between StartJob() and
+ * StopJob(), so GetInt64Summary() and friends answer in constant time however long the
+ * job ran and however few samples the cache still keeps.
+ */
+class DcgmJobStats
+{
+public:
+    /* Fields whose values are accumulated. The host engine subscribes for these on the GPUs of running jobs */
+    static constexpr std::array<unsigned short, 17> c_fieldIds {
+        DCGM_FI_DEV_POWER_USAGE,           DCGM_FI_DEV_TOTAL_ENERGY_CONSUMPTION, DCGM_FI_DEV_PCIE_RX_THROUGHPUT,
+        DCGM_FI_DEV_PCIE_TX_THROUGHPUT,    DCGM_FI_DEV_PCIE_REPLAY_COUNTER,      DCGM_FI_DEV_GPU_UTIL,
+        DCGM_FI_DEV_MEM_COPY_UTIL,         DCGM_FI_DEV_ECC_DBE_VOL_TOTAL,        DCGM_FI_DEV_SM_CLOCK,
+        DCGM_FI_DEV_MEM_CLOCK,             DCGM_FI_DEV_XID_ERRORS,               DCGM_FI_DEV_POWER_VIOLATION,
+        DCGM_FI_DEV_THERMAL_VIOLATION,     DCGM_FI_DEV_RELIABILITY_VIOLATION,    DCGM_FI_DEV_BOARD_LIMIT_VIOLATION,
+        DCGM_FI_DEV_LOW_UTIL_VIOLATION,    DCGM_FI_DEV_SYNC_BOOST_VIOLATION,
+    };
+
+    /* Number of XID timestamps kept per GPU. Matches dcgmGpuUsageInfo_t::xidCriticalErrorsTs */
+    static constexpr unsigned int c_maxXidTimestamps = 10;
+
+    /*************************************************************************/
+    /*
+     * Start accumulating values of gpuIds with timestamps from startTime on for jobId.
+     *
+     * RETURNS: The GPUs that had no other running job. Their fields need to be watched now
+     */
+    std::vector<unsigned int> StartJob(std::string const &jobId,
+                                       timelib64_t startTime,
+                                       std::vector<unsigned int> const &gpuIds);
+
+    /*************************************************************************/
+    /*
+     * Stop accumulating for jobId. Values after endTime are ignored.
+     *
+     * RETURNS: The GPUs that have no running job anymore. Their fields don't need to be watched any longer
+     */
+    std::vector<unsigned int> StopJob(std::string const &jobId, timelib64_t endTime);
+
+    /*************************************************************************/
+    /*
+     * Forget jobId, stopping it first if it is still running.
+     *
+     * RETURNS: Same as StopJob()
+     */
+    std::vector<unsigned int> RemoveJob(std::string const &jobId);
+
+    /*************************************************************************/
+    /*
+     * Forget all jobs.
+     *
+     * RETURNS: The GPUs that had a running job
+     */
+    std::vector<unsigned int> RemoveAllJobs();
+
+    /*************************************************************************/
+    /* Add the values in fvBuffer to the running jobs of their GPUs */
+    void Update(DcgmFvBuffer &fvBuffer);
+
+    /*************************************************************************/
+    /*
+     * Get the GPUs jobId was started on.
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_NO_DATA if jobId isn't known
+     */
+    dcgmReturn_t GetGpuIds(std::string const &jobId, std::vector<unsigned int> &gpuIds) const;
+
+    /*************************************************************************/
+    /*
+     * Summarize an int64 or double field of gpuId of jobId. See DcgmJobFieldAccumulator::Summarize()
+     * for the return codes. DCGM_ST_NO_DATA is also returned if jobId isn't known.
+     */
+    dcgmReturn_t GetInt64Summary(std::string const &jobId,
+                                 unsigned int gpuId,
+                                 unsigned short fieldId,
+                                 int numSummaryTypes,
+                                 DcgmcmSummaryType_t const *summaryTypes,
+                                 long long *summaryValues) const;
+    dcgmReturn_t GetFp64Summary(std::string const &jobId,
+                                unsigned int gpuId,
+                                unsigned short fieldId,
+                                int numSummaryTypes,
+                                DcgmcmSummaryType_t const *summaryTypes,
+                                double *summaryValues) const;
+
+    /*************************************************************************/
+    /* Get the timestamps of the first c_maxXidTimestamps XIDs of gpuId during jobId */
+    std::vector<timelib64_t> GetXidTimestamps(std::string const &jobId, unsigned int gpuId) const;
+
+private:
+    struct GpuStats
+    {
+        std::unordered_map<unsigned short, DcgmJobFieldAccumulator<long long>> int64Fields;
+        std::unordered_map<unsigned short, DcgmJobFieldAccumulator<double>> fp64Fields;
+        std::vector<timelib64_t> xidTimestamps;
+    };
+
+    struct Job
+    {
+        timelib64_t startTime = 0;
+        timelib64_t endTime   = 0; /* 0 while the job is running */
+        std::map<unsigned int, GpuStats> gpus;
+    };
+
+    /*************************************************************************/
+    /* Take jobs[jobId] off m_runningJobsPerGpu if it's running. Returns the GPUs left without a running job */
+    std::vector<unsigned int> StopJobLocked(Job &job, timelib64_t endTime);
+
+    /*************************************************************************/
+    GpuStats const *FindGpuLocked(std::string const &jobId, unsigned int gpuId) const;
+
+    mutable std::mutex m_mutex; /* Protects all of the below */
+    std::unordered_map<std::string, Job> m_jobs;
+    std::map<unsigned int, unsigned int> m_runningJobsPerGpu; /* gpuId -> number of running jobs on it */
+};
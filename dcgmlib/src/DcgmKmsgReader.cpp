@@ -115,6 +115,12 @@ long long GetTimeSinceEpochFromMonoticTs(const long long timestamp)
 
 std::unique_ptr<KmsgXidData> ParseKmsgLineForXid(std::string_view buffer)
 {
+    /* Nearly every kmsg record isn't an XID. Don't pay for the regex for those */
+    if (buffer.find("NVRM: Xid") == std::string_view::npos)
+    {
+        return nullptr;
+    }
+
     static boost::regex exp(R"(^\d+,\d+,(\d+),.*;NVRM: Xid \(PCI:(.*)\): (\d+),.*)");
     boost::cmatch match;
     if (boost::regex_match(buffer.begin(), buffer.end(), match, exp))
@@ -162,7 +168,8 @@ void ReadEnvKmsgFilenameAndUpdate(std::string &filename)
 }
 
 DcgmKmsgReaderThread::DcgmKmsgReaderThread()
-    : m_xidsToParse({ 79, 119, 120 })
+    : DcgmThread("dcgm_kmsg")
+    , m_xidsToParse({ 79, 119, 120 })
     , m_mutex(std::make_unique<DcgmMutex>(0))
     , m_kmsgFilename("/dev/kmsg")
 {
@@ -188,14 +195,38 @@ uint32_t DcgmKmsgReaderThread::GetPollInterval() const
     return m_pollIntervalUs;
 }
 
+bool DcgmKmsgReaderThread::WaitForXids(unsigned int timeoutMs, DcgmThread *waiter)
+{
+    DcgmLockGuard lg(m_mutex.get());
+    if (!m_parsedKmsgXids.empty())
+    {
+        return true;
+    }
+
+    m_mutex->CondWait(m_xidsCondition, timeoutMs, [this, waiter] {
+        return !m_parsedKmsgXids.empty() || ShouldStop() || (waiter != nullptr && waiter->ShouldStop());
+    });
+    return !m_parsedKmsgXids.empty();
+}
+
+void DcgmKmsgReaderThread::WakeXidWaiters()
+{
+    DcgmLockGuard lg(m_mutex.get());
+    m_xidsCondition.notify_all();
+}
+
+void DcgmKmsgReaderThread::OnStop()
+{
+    /* run() is woken up by the wake eventfd of DcgmThread::Stop(). Wake up WaitForXids() callers so they don't
+       wait on a reader that is going away */
+    WakeXidWaiters();
+}
+
 void DcgmKmsgReaderThread::run()
 {
-    struct pollfd pfds
-    {};
     constexpr uint32_t MAX_RECORD_SIZE = 2048; // Based on PRINTK_MESSAGE_MAX
-    auto pollBlockForMs                = 0;    // return immediately if not ready
     bool errorCondition                = false;
-    bool sleepNow                      = false;
+    bool atEndOfFile                   = false;
 
     int kmsgFd = open(m_kmsgFilename.c_str(), O_RDONLY | O_NONBLOCK);
     if (kmsgFd < 0)
@@ -205,76 +236,108 @@ void DcgmKmsgReaderThread::run()
     }
 
     DcgmNs::Utils::FileHandle kmsgFileHandle { kmsgFd };
-    pfds.fd     = kmsgFileHandle.Get();
-    pfds.events = POLLIN;
+
+    /* The wake eventfd is first so that it can be waited on by itself */
+    struct pollfd pfds[2] {};
+    pfds[0].fd     = GetWakeFd();
+    pfds[0].events = POLLIN;
+    pfds[1].fd     = kmsgFileHandle.Get();
+    pfds[1].events = POLLIN;
 
     while (!ShouldStop() && !errorCondition)
     {
-        if (sleepNow)
-        {
-            usleep(m_pollIntervalUs);
-            sleepNow = false;
-        }
-        int pollRet = poll(&pfds, 1, pollBlockForMs);
+        /* Block until the kernel emits a record or Stop() is called. Regular files and pipes without a writer
+           are always readable, so once one has been read to the end only wait for a stop until it's time to
+           check for more. This also covers not having a wake eventfd */
+        bool waitForStopOnly = atEndOfFile || pfds[0].fd < 0;
+        nfds_t numFds        = atEndOfFile ? 1 : 2;
+        int timeoutMs        = waitForStopOnly ? std::max(1U, m_pollIntervalUs / 1000) : -1;
+
+        int pollRet = poll(pfds, numFds, timeoutMs);
         if (pollRet < 0)
         {
+            if (errno == EINTR)
+            {
+                continue;
+            }
             log_debug("Poll returned error: {}", strerror(errno));
             errorCondition = true;
+            break;
+        }
+
+        if (pfds[0].revents & POLLIN)
+        {
+            if (ShouldStop())
+            {
+                log_debug("kmsg reader was asked to stop");
+                break;
+            }
+            ConsumeWake();
+            if (numFds == 1 || pfds[1].revents == 0)
+            {
+                continue;
+            }
         }
-        else if (pollRet == 0) // nothing to read at this time, sleep and try again
+
+        if (atEndOfFile)
         {
-            sleepNow = true;
+            atEndOfFile = false;
             continue;
         }
-        else // data available to read
+
+        if (pollRet == 0)
+        {
+            continue;
+        }
+
+        if (!(pfds[1].revents & POLLIN)) // POLLHUP or POLLERR
         {
-            if (pfds.revents & POLLIN)
+            log_debug("Poll kmsg revents error. Revents {}", pfds[1].revents);
+            errorCondition = true;
+            break;
+        }
+
+        /* Drain every record that is ready so that a burst is handled with a single wakeup */
+        char readBuffer[MAX_RECORD_SIZE];
+        while (!ShouldStop())
+        {
+            // /dev/kmsg reads are one record at a time
+            ssize_t readRet = read(kmsgFileHandle.Get(), readBuffer, sizeof(readBuffer));
+            if (readRet < 0)
             {
-                char readBuffer[MAX_RECORD_SIZE];
-                bool readAgain;
-                do
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
                 {
-                    readAgain = false;
-                    // /dev/kmsg reads are one record at a time
-                    ssize_t readRet = read(kmsgFileHandle.Get(), readBuffer, sizeof(readBuffer));
-                    if (readRet < 0)
-                    {
-                        if (errno == EAGAIN || errno == EWOULDBLOCK)
-                        {
-                            log_debug("EWOULDBLOCK recorded");
-                            sleepNow = true;
-                        }
-                        else if (errno == EPIPE)
-                        {
-                            log_debug("Read kmsg returned EPIPE, data overwritten in circular buffer, reading again");
-                            readAgain = true;
-                            continue;
-                        }
-                        else
-                        {
-                            log_debug("Read kmsg errored: {} ", strerror(errno));
-                            errorCondition = true;
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        std::string_view readBuffer_sv(readBuffer, readRet);
-                        std::unique_ptr<KmsgXidData> newXid = ParseKmsgLineForXid(readBuffer_sv);
-                        if (newXid && m_xidsToParse.contains(newXid->xid))
-                        {
-                            DcgmLockGuard lg(m_mutex.get());
-                            m_parsedKmsgXids.emplace_back(std::move(newXid));
-                            log_debug("Adding parsed XID {} to kmsg XIDs", m_parsedKmsgXids.back()->xid);
-                        }
-                    }
-                } while (readAgain && !ShouldStop());
+                    break;
+                }
+                else if (errno == EPIPE)
+                {
+                    log_debug("Read kmsg returned EPIPE, data overwritten in circular buffer, reading again");
+                    continue;
+                }
+                else if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                log_debug("Read kmsg errored: {} ", strerror(errno));
+                errorCondition = true;
+                break;
             }
-            else // POLLHUP or POLLERR
+            else if (readRet == 0)
             {
-                log_debug("Poll kmsg revents error. Revents {}", pfds.revents);
-                errorCondition = true;
+                atEndOfFile = true;
+                break;
+            }
+
+            std::string_view readBuffer_sv(readBuffer, readRet);
+            std::unique_ptr<KmsgXidData> newXid = ParseKmsgLineForXid(readBuffer_sv);
+            if (newXid && m_xidsToParse.contains(newXid->xid))
+            {
+                DcgmLockGuard lg(m_mutex.get());
+                m_parsedKmsgXids.emplace_back(std::move(newXid));
+                log_debug("Adding parsed XID {} to kmsg XIDs", m_parsedKmsgXids.back()->xid);
+                m_xidsCondition.notify_all();
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -18,7 +18,9 @@
 
 #include <DcgmMutex.h>
 #include <DcgmThread.h>
+#include <DcgmUtilities.h>
 
+#include <condition_variable>
 #include <cstdint>
 #include <unordered_set>
 #include <vector>
@@ -87,12 +89,18 @@ private:
     std::unique_ptr<DcgmMutex> m_mutex;
     std::string m_kmsgFilename;
     uint32_t m_pollIntervalUs = 5000;
+    std::condition_variable m_xidsCondition; /* Signalled when m_parsedKmsgXids becomes non-empty */
 
 public:
     DcgmKmsgReaderThread();
     ~DcgmKmsgReaderThread() override = default;
     void run() override;
 
+    /**
+     * @brief Wakes up WaitForXids() callers. run() itself is woken up by the wake eventfd of DcgmThread.
+     */
+    void OnStop() override;
+
     /**
      * @brief Returns the parsed XID vector, and clears it.
      * @return vector of unique_ptrs to the parsed KmsgXidData structs
@@ -100,7 +108,22 @@ public:
     std::vector<std::unique_ptr<KmsgXidData>> GetParsedKmsgXids();
 
     /**
-     * @brief Returns the file descriptor polling interval in microseconds.
+     * @brief Waits until there are parsed XIDs to get or the reader stops.
+     * @param timeoutMs - how long to wait at most
+     * @param waiter - also stop waiting once this thread is asked to stop. Its OnStop() should call
+     *                 WakeXidWaiters()
+     * @return true if GetParsedKmsgXids() has XIDs to return
+     */
+    bool WaitForXids(unsigned int timeoutMs, DcgmThread *waiter = nullptr);
+
+    /**
+     * @brief Wakes up WaitForXids() callers so that they check whether their waiter was stopped.
+     */
+    void WakeXidWaiters();
+
+    /**
+     * @brief Returns how often a kmsg file that has been read to the end is checked for more records, in
+     *        microseconds. /dev/kmsg itself is waited on without a timeout.
      * @return poll interval in us
      */
     unsigned int GetPollInterval() const;
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmLatestValueCache.h"
+
+/*****************************************************************************/
+std::unique_lock<std::mutex> DcgmLatestValueCache::LockStripe(dcgm_entity_key_t const &watchKey, Stripe *&stripe)
+{
+    /* Stripe by entity only so that all fields of an entity share a stripe */
+    unsigned int stripeIndex = (watchKey.entityGroupId * 31 + watchKey.entityId) % c_numStripes;
+    stripe                   = &m_stripes[stripeIndex];
+
+    std::unique_lock<std::mutex> lock(stripe->mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        m_contendedCount.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+
+    return lock;
+}
+
+/*****************************************************************************/
+void DcgmLatestValueCache::Publish(dcgm_entity_key_t const &watchKey, dcgmcm_latest_value_t const &value)
+{
+    Stripe *stripe = nullptr;
+    auto lock      = LockStripe(watchKey, stripe);
+
+    stripe->values[DcgmNs::PackEntityKey(watchKey)] = value;
+}
+
+/*****************************************************************************/
+void DcgmLatestValueCache::Unpublish(dcgm_entity_key_t const &watchKey)
+{
+    Stripe *stripe = nullptr;
+    auto lock      = LockStripe(watchKey, stripe);
+
+    stripe->values.erase(DcgmNs::PackEntityKey(watchKey));
+}
+
+/*****************************************************************************/
+void DcgmLatestValueCache::Clear()
+{
+    for (auto &stripe : m_stripes)
+    {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        stripe.values.clear();
+    }
+}
+
+/*****************************************************************************/
+bool DcgmLatestValueCache::Get(dcgm_entity_key_t const &watchKey, dcgmcm_latest_value_t &value)
+{
+    Stripe *stripe = nullptr;
+    auto lock      = LockStripe(watchKey, stripe);
+
+    auto it = stripe->values.find(DcgmNs::PackEntityKey(watchKey));
+    if (it == stripe->values.end())
+    {
+        m_missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    value = it->second;
+    m_hitCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/*****************************************************************************/
+long long DcgmLatestValueCache::GetHitCount() const
+{
+    return m_hitCount.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+long long DcgmLatestValueCache::GetMissCount() const
+{
+    return m_missCount.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+long long DcgmLatestValueCache::GetContendedCount() const
+{
+    return m_contendedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmWatchTable.h"
+#include "timelib.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+/*****************************************************************************/
+/* A numeric latest value as published by the cache manager update path */
+struct dcgmcm_latest_value_t
+{
+    timelib64_t timestamp = 0; /* usec since 1970 of the sample */
+    int tsType            = 0; /* TS_TYPE_INT64 or TS_TYPE_DOUBLE */
+    union
+    {
+        double d;
+        long long i64;
+    } val {};
+    union
+    {
+        double d;
+        long long i64;
+    } val2 {};
+};
+
+/*****************************************************************************/
+/*
+ * Striped table of the most recent numeric sample of each cached watch.
+ *
+ * Writers publish into it while holding the cache manager lock. Readers can
+ * use it without the cache manager lock. Each stripe has its own lock and all
+ * fields of an entity land on the same stripe, so a reader of one GPU only
+ * contends with the update of entities sharing its stripe.
+ */
+class DcgmLatestValueCache
+{
+public:
+    static constexpr unsigned int c_numStripes = 64;
+
+    /*************************************************************************/
+    /*
+     * Publish value as the latest value of watchKey, replacing any prior value
+     */
+    void Publish(dcgm_entity_key_t const &watchKey, dcgmcm_latest_value_t const &value);
+
+    /*************************************************************************/
+    /*
+     * Forget the latest value of watchKey. Must be called whenever the
+     * cached samples of a watch are discarded
+     */
+    void Unpublish(dcgm_entity_key_t const &watchKey);
+
+    /*************************************************************************/
+    /*
+     * Forget all published values
+     */
+    void Clear();
+
+    /*************************************************************************/
+    /*
+     * Look up the latest value of watchKey.
+     *
+     * RETURNS: true if a value was published for watchKey and copied to value
+     *          false if there is no published value
+     */
+    bool Get(dcgm_entity_key_t const &watchKey, dcgmcm_latest_value_t &value);
+
+    /*************************************************************************/
+    /* Statistics about the usage of this table */
+    long long GetHitCount() const;
+    long long GetMissCount() const;
+    long long GetContendedCount() const;
+
+private:
+    struct Stripe
+    {
+        std::mutex mutex;
+        std::unordered_map<DcgmNs::PackedEntityKey, dcgmcm_latest_value_t, DcgmNs::EntityKeyHash> values;
+    };
+
+    /*************************************************************************/
+    /*
+     * Lock the stripe that owns watchKey, counting the lock as contended if
+     * another thread was holding it
+     */
+    std::unique_lock<std::mutex> LockStripe(dcgm_entity_key_t const &watchKey, Stripe *&stripe);
+
+    std::array<Stripe, c_numStripes> m_stripes;
+
+    std::atomic_llong m_hitCount { 0 };       /* Lookups that found a published value */
+    std::atomic_llong m_missCount { 0 };      /* Lookups that found nothing */
+    std::atomic_llong m_contendedCount { 0 }; /* Stripe locks that had to wait for another thread */
+};
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmLatestValueSlots.h"
+
+#include "timeseries.h"
+
+#include <cstring>
+
+/*****************************************************************************/
+DcgmLatestValueSlots::DcgmLatestValueSlots(unsigned int capacity)
+    : m_slots(std::make_unique<Slot[]>(capacity))
+    , m_capacity(capacity)
+{}
+
+/*****************************************************************************/
+unsigned int DcgmLatestValueSlots::Reserve(dcgm_entity_key_t const &watchKey)
+{
+    std::lock_guard<std::mutex> lock(m_reserveMutex);
+
+    auto it = m_keyToSlot.find(DcgmNs::PackEntityKey(watchKey));
+    if (it != m_keyToSlot.end())
+    {
+        return it->second;
+    }
+
+    if (m_numReserved >= m_capacity)
+    {
+        return c_noSlot;
+    }
+
+    unsigned int slot              = m_numReserved++;
+    m_slots[slot].key              = watchKey;
+    m_keyToSlot[DcgmNs::PackEntityKey(watchKey)] = slot;
+    return slot;
+}
+
+/*****************************************************************************/
+unsigned int DcgmLatestValueSlots::Find(dcgm_entity_key_t const &watchKey)
+{
+    std::lock_guard<std::mutex> lock(m_reserveMutex);
+
+    auto it = m_keyToSlot.find(DcgmNs::PackEntityKey(watchKey));
+    if (it == m_keyToSlot.end())
+    {
+        return c_noSlot;
+    }
+
+    return it->second;
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlots::WriteSlot(Slot &slot, long long timestamp, int tsType, long long valueBits)
+{
+    std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.tsType.store(tsType, std::memory_order_relaxed);
+    slot.valueBits.store(valueBits, std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlots::Publish(unsigned int slot, dcgmcm_latest_value_t const &value)
+{
+    if (slot >= m_capacity)
+    {
+        return;
+    }
+
+    long long valueBits = value.val.i64;
+    if (value.tsType == TS_TYPE_DOUBLE)
+    {
+        memcpy(&valueBits, &value.val.d, sizeof(valueBits));
+    }
+
+    WriteSlot(m_slots[slot], value.timestamp, value.tsType, valueBits);
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlots::Unpublish(unsigned int slot)
+{
+    if (slot >= m_capacity)
+    {
+        return;
+    }
+
+    WriteSlot(m_slots[slot], 0, 0, 0);
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlots::UnpublishAll()
+{
+    unsigned int numReserved = GetNumReserved();
+
+    for (unsigned int slot = 0; slot < numReserved; slot++)
+    {
+        Unpublish(slot);
+    }
+}
+
+/*****************************************************************************/
+bool DcgmLatestValueSlots::ReadSlot(Slot const &slot, dcgmLatestValueSample_t &sample, unsigned int maxAttempts)
+{
+    long long timestamp;
+    int tsType;
+    long long valueBits;
+    std::uint64_t before;
+
+    for (unsigned int attempt = 0;; attempt++)
+    {
+        if (maxAttempts != 0 && attempt >= maxAttempts)
+        {
+            return false;
+        }
+
+        before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            continue; /* Writer is in the middle of an update */
+        }
+
+        timestamp = slot.timestamp.load(std::memory_order_relaxed);
+        tsType    = slot.tsType.load(std::memory_order_relaxed);
+        valueBits = slot.valueBits.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before)
+        {
+            break;
+        }
+    }
+
+    sample.entityGroupId = (dcgm_field_entity_group_t)slot.key.entityGroupId;
+    sample.entityId      = slot.key.entityId;
+    sample.fieldId       = slot.key.fieldId;
+
+    if (timestamp == 0)
+    {
+        sample.status = DCGM_ST_NO_DATA;
+        return true;
+    }
+
+    sample.status = DCGM_ST_OK;
+    sample.ts     = timestamp;
+    if (tsType == TS_TYPE_DOUBLE)
+    {
+        sample.fieldType = DCGM_FT_DOUBLE;
+        memcpy(&sample.value.dbl, &valueBits, sizeof(sample.value.dbl));
+    }
+    else
+    {
+        sample.fieldType = DCGM_FT_INT64;
+        sample.value.i64 = valueBits;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmLatestValueSlots::Read(unsigned int const slots[],
+                                unsigned int count,
+                                dcgmLatestValueSample_t samples[]) const
+{
+    for (unsigned int i = 0; i < count; i++)
+    {
+        dcgmLatestValueSample_t &sample = samples[i];
+
+        memset(&sample, 0, sizeof(sample));
+
+        if (slots[i] >= m_capacity)
+        {
+            sample.status = DCGM_ST_BADPARAM;
+            continue;
+        }
+
+        ReadSlot(m_slots[slots[i]], sample);
+    }
+}
+
+/*****************************************************************************/
+unsigned int DcgmLatestValueSlots::GetCapacity() const
+{
+    return m_capacity;
+}
+
+/*****************************************************************************/
+unsigned int DcgmLatestValueSlots::GetNumReserved()
+{
+    std::lock_guard<std::mutex> lock(m_reserveMutex);
+    return m_numReserved;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmLatestValueCache.h"
+#include "DcgmWatchTable.h"
+#include "dcgm_structs.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/*****************************************************************************/
+/*
+ * Fixed array of latest numeric values that embedded clients read in place.
+ *
+ * Slots are reserved per watch key and never move or get reused, so a slot
+ * index stays valid for the lifetime of this object. Each slot is guarded by
+ * a sequence lock: the single writer (the cache manager, under its lock)
+ * makes the sequence odd while it updates a slot and readers retry until they
+ * see the same even sequence before and after reading. Readers never block
+ * the writer and never take a lock.
+ */
+class DcgmLatestValueSlots
+{
+public:
+    static constexpr unsigned int c_noSlot          = DCGM_LATEST_VALUE_VIEW_NO_SLOT;
+    static constexpr unsigned int c_defaultCapacity = 16384;
+
+    explicit DcgmLatestValueSlots(unsigned int capacity = c_defaultCapacity);
+
+    /*************************************************************************/
+    /*
+     * Reserve the slot of watchKey, returning the slot that was already
+     * reserved for it if there is one.
+     *
+     * RETURNS: Index of the slot of watchKey
+     *          c_noSlot if every slot is reserved
+     */
+    unsigned int Reserve(dcgm_entity_key_t const &watchKey);
+
+    /*************************************************************************/
+    /*
+     * RETURNS: Index of the slot reserved for watchKey
+     *          c_noSlot if no slot was reserved for it
+     */
+    unsigned int Find(dcgm_entity_key_t const &watchKey);
+
+    /*************************************************************************/
+    /*
+     * Write value into slot or mark slot as having no value. Only one thread
+     * may write at a time
+     */
+    void Publish(unsigned int slot, dcgmcm_latest_value_t const &value);
+    void Unpublish(unsigned int slot);
+
+    /*************************************************************************/
+    /*
+     * Mark every reserved slot as having no value. The reservations are kept
+     */
+    void UnpublishAll();
+
+    /*************************************************************************/
+    /*
+     * Copy the values of slots[0..count-1] into samples[]. Safe to call from
+     * any thread at any time without locking
+     */
+    void Read(unsigned int const slots[], unsigned int count, dcgmLatestValueSample_t samples[]) const;
+
+    /*************************************************************************/
+    unsigned int GetCapacity() const;
+    unsigned int GetNumReserved();
+
+    /* One value and its sequence lock. Also the layout of the rows of DcgmSharedLatestValues, so it only holds
+       lock-free atomics that work across processes */
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence { 0 }; /* Odd while the slot is being written */
+        dcgm_entity_key_t key {};                  /* Set once when the slot is reserved */
+        std::atomic_llong timestamp { 0 };         /* 0 = no value */
+        std::atomic_int tsType { 0 };              /* TS_TYPE_INT64 or TS_TYPE_DOUBLE */
+        std::atomic_llong valueBits { 0 };         /* i64 or bits of the double, depending on tsType */
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic_llong::is_always_lock_free
+                  && std::atomic_int::is_always_lock_free);
+
+    /*************************************************************************/
+    /*
+     * Write a value into slot, or mark it as having no value if timestamp is 0. Only one thread may write a slot
+     * at a time
+     */
+    static void WriteSlot(Slot &slot, long long timestamp, int tsType, long long valueBits);
+
+    /*************************************************************************/
+    /*
+     * Copy the value of slot into sample. Gives up after maxAttempts reads that overlapped a write, or never if
+     * maxAttempts is 0.
+     *
+     * RETURNS: true if sample was set
+     *          false if every attempt overlapped a write
+     */
+    static bool ReadSlot(Slot const &slot, dcgmLatestValueSample_t &sample, unsigned int maxAttempts = 0);
+
+private:
+    std::unique_ptr<Slot[]> m_slots;
+    unsigned int m_capacity;
+
+    std::mutex m_reserveMutex;        /* Protects the members below */
+    unsigned int m_numReserved { 0 }; /* Slots [0, m_numReserved) are reserved */
+
+    /* Packed watch key -> slot index */
+    std::unordered_map<DcgmNs::PackedEntityKey, unsigned int, DcgmNs::EntityKeyHash> m_keyToSlot;
+};
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmMetricsExporter.h"
+
+#include <DcgmLogging.h>
+#include <cachealloc.h>
+#include <dcgm_fields.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <netinet/in.h>
+#include <numeric>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <tuple>
+#include <unistd.h>
+
+namespace
+{
+/* Longest request accepted. Scrapers send a request line and a few headers */
+constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+/* How long a client has to send its request */
+constexpr int REQUEST_TIMEOUT_MS = 2000;
+
+constexpr char OPENMETRICS_CONTENT_TYPE[] = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+/*****************************************************************************/
+bool SendAll(int fd, std::string_view data)
+{
+    while (!data.empty())
+    {
+        ssize_t const sent = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(sent);
+    }
+    return true;
+}
+
+/*****************************************************************************/
+void SendResponse(int fd, char const *status, char const *contentType, std::string_view body)
+{
+    std::string const header = fmt::format(
+        "HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n",
+        status,
+        contentType,
+        body.size());
+
+    if (!SendAll(fd, header) || !SendAll(fd, body))
+    {
+        log_debug("Unable to send a metrics response: {}", strerror(errno));
+    }
+}
+} // namespace
+
+/*****************************************************************************/
+DcgmMetricsExporter::DcgmMetricsExporter(DcgmCacheManager &cacheManager)
+    : DcgmThread("dcgm_metrics")
+    , m_cacheManager(cacheManager)
+    , m_fieldNames(DCGM_FI_MAX_FIELDS)
+    , m_stopEventFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+    /* Names only depend on the field metadata, so build them once */
+    for (unsigned short fieldId = 1; fieldId < DCGM_FI_MAX_FIELDS; fieldId++)
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (fieldMeta == nullptr || (fieldMeta->fieldType != DCGM_FT_INT64 && fieldMeta->fieldType != DCGM_FT_DOUBLE))
+        {
+            continue;
+        }
+
+        std::string metricName = "dcgm_";
+        for (char const *c = fieldMeta->tag; *c != '\0'; c++)
+        {
+            metricName += isalnum((unsigned char)*c) ? *c : '_';
+        }
+
+        char const *unit = fieldMeta->valueFormat != nullptr ? fieldMeta->valueFormat->unit : "";
+        m_fieldNames[fieldId].family
+            = fmt::format("# TYPE {0} gauge\n# HELP {0} DCGM field {1}{2}{3}\n",
+                          metricName,
+                          fieldId,
+                          unit[0] != '\0' ? ", in " : "",
+                          unit);
+        m_fieldNames[fieldId].metricName = std::move(metricName);
+    }
+}
+
+/*****************************************************************************/
+DcgmMetricsExporter::~DcgmMetricsExporter()
+{
+    try
+    {
+        StopAndWait(60000);
+    }
+    catch (std::exception const &ex)
+    {
+        log_error("Exception caught while stopping the metrics exporter: {}", ex.what());
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmMetricsExporter::Listen(unsigned short port, std::string const &bindAddress)
+{
+    DcgmNs::Utils::FileHandle listenFd(socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (listenFd.Get() < 0)
+    {
+        log_error("Unable to create the metrics socket: {}", strerror(errno));
+        return DCGM_ST_INIT_ERROR;
+    }
+
+    int const reuse = 1;
+    setsockopt(listenFd.Get(), SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (!bindAddress.empty() && inet_pton(AF_INET, bindAddress.c_str(), &addr.sin_addr) != 1)
+    {
+        log_error("Invalid metrics bind address {}", bindAddress);
+        return DCGM_ST_INIT_ERROR;
+    }
+
+    if (bind(listenFd.Get(), (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listenFd.Get(), 16) != 0)
+    {
+        log_error("Unable to listen for metrics scrapes on {}:{}: {}",
+                  bindAddress.empty() ? "*" : bindAddress,
+                  port,
+                  strerror(errno));
+        return DCGM_ST_INIT_ERROR;
+    }
+
+    m_listenFd = std::move(listenFd);
+    log_info("Serving metrics on {}:{}", bindAddress.empty() ? "*" : bindAddress, port);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::BuildLabels()
+{
+    std::vector<size_t> order(m_plan.keys.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    /* OpenMetrics wants all samples of a metric family together */
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        dcgm_entity_key_t const &ka = m_plan.keys[a];
+        dcgm_entity_key_t const &kb = m_plan.keys[b];
+        return std::tie(ka.fieldId, ka.entityGroupId, ka.entityId)
+               < std::tie(kb.fieldId, kb.entityGroupId, kb.entityId);
+    });
+
+    m_slots.clear();
+    m_labels.clear();
+    for (size_t i : order)
+    {
+        dcgm_entity_key_t const &key = m_plan.keys[i];
+        if (m_fieldNames[key.fieldId].metricName.empty())
+        {
+            continue;
+        }
+
+        auto const entityGroupId = (dcgm_field_entity_group_t)key.entityGroupId;
+        std::string labels;
+        if (entityGroupId == DCGM_FE_NONE)
+        {
+            labels = "entity=\"None\"";
+        }
+        else
+        {
+            labels = fmt::format(
+                "entity=\"{}\",entity_id=\"{}\"", DcgmFieldsGetEntityGroupString(entityGroupId), key.entityId);
+        }
+
+        if (entityGroupId == DCGM_FE_GPU && key.entityId < m_plan.gpuUuids.size()
+            && !m_plan.gpuUuids[key.entityId].empty())
+        {
+            fmt::format_to(std::back_inserter(labels), ",UUID=\"{}\"", m_plan.gpuUuids[key.entityId]);
+        }
+
+        m_slots.push_back(m_plan.slots[i]);
+        m_labels.push_back(std::move(labels));
+    }
+
+    m_samples.resize(m_slots.size());
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::Render(std::string &out)
+{
+    if (m_cacheManager.UpdateLatestValueExportPlan(m_plan))
+    {
+        BuildLabels();
+    }
+
+    /* Lock-free. Each slot is read consistently on its own */
+    m_plan.slotTable->Read(m_slots.data(), m_slots.size(), m_samples.data());
+
+    /* clear() keeps the capacity, so a reused out doesn't reallocate */
+    out.clear();
+    auto outIt = std::back_inserter(out);
+
+    unsigned short familyFieldId = 0;
+    for (size_t i = 0; i < m_samples.size(); i++)
+    {
+        dcgmLatestValueSample_t const &sample = m_samples[i];
+        if (sample.status != DCGM_ST_OK || sample.fieldId >= m_fieldNames.size())
+        {
+            continue;
+        }
+
+        FieldNames const &names = m_fieldNames[sample.fieldId];
+        if (sample.fieldId != familyFieldId)
+        {
+            out += names.family;
+            familyFieldId = sample.fieldId;
+        }
+
+        /* Blank values mean the value isn't available. Leave them out rather than export sentinels */
+        if (sample.fieldType == DCGM_FT_DOUBLE)
+        {
+            if (DCGM_FP64_IS_BLANK(sample.value.dbl))
+            {
+                continue;
+            }
+            fmt::format_to(outIt, "{}{{{}}} {}", names.metricName, m_labels[i], sample.value.dbl);
+        }
+        else
+        {
+            if (DCGM_INT64_IS_BLANK(sample.value.i64))
+            {
+                continue;
+            }
+            fmt::format_to(outIt, "{}{{{}}} {}", names.metricName, m_labels[i], sample.value.i64);
+        }
+
+        /* OpenMetrics timestamps are in seconds */
+        fmt::format_to(outIt, " {}.{:06}\n", sample.ts / 1000000, sample.ts % 1000000);
+    }
+
+    RenderMemoryBudget(out);
+    RenderCacheAlloc(out);
+
+    out += "# EOF\n";
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::RenderMemoryBudget(std::string &out)
+{
+    dcgmcm_memory_budget_stats_t stats;
+    m_cacheManager.GetMemoryBudgetStats(stats);
+    if (stats.budgetBytes == 0)
+    {
+        return;
+    }
+
+    fmt::format_to(std::back_inserter(out),
+                   "# TYPE dcgm_hostengine_cache_budget_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_budget_bytes Memory budget of the samples cached by the host engine\n"
+                   "dcgm_hostengine_cache_budget_bytes {}\n"
+                   "# TYPE dcgm_hostengine_cache_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_bytes Memory taken up by the samples cached by the host engine\n"
+                   "dcgm_hostengine_cache_bytes {}\n"
+                   "# TYPE dcgm_hostengine_cache_evictions counter\n"
+                   "# HELP dcgm_hostengine_cache_evictions Watches evicted to stay within the budget\n"
+                   "dcgm_hostengine_cache_evictions_total {}\n"
+                   "# TYPE dcgm_hostengine_cache_evicted_samples counter\n"
+                   "# HELP dcgm_hostengine_cache_evicted_samples Samples evicted to stay within the budget\n"
+                   "dcgm_hostengine_cache_evicted_samples_total {}\n"
+                   "# TYPE dcgm_hostengine_cache_evicted_bytes counter\n"
+                   "# HELP dcgm_hostengine_cache_evicted_bytes Bytes freed by evicting samples\n"
+                   "dcgm_hostengine_cache_evicted_bytes_total {}\n",
+                   stats.budgetBytes,
+                   stats.cachedBytes,
+                   stats.evictions,
+                   stats.evictedSamples,
+                   stats.evictedBytes);
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::RenderCacheAlloc(std::string &out)
+{
+    if (cachealloc_flags() == 0)
+    {
+        return;
+    }
+
+    cachealloc_stats_t stats;
+    cachealloc_stats(&stats);
+
+    fmt::format_to(std::back_inserter(out),
+                   "# TYPE dcgm_hostengine_cache_alloc_mapped_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_alloc_mapped_bytes Memory mapped for the cache's large allocations\n"
+                   "dcgm_hostengine_cache_alloc_mapped_bytes {}\n"
+                   "# TYPE dcgm_hostengine_cache_alloc_live_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_alloc_live_bytes Mapped memory that is in use\n"
+                   "dcgm_hostengine_cache_alloc_live_bytes {}\n"
+                   "# TYPE dcgm_hostengine_cache_alloc_hugetlb_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_alloc_hugetlb_bytes Mapped memory backed by reserved huge pages\n"
+                   "dcgm_hostengine_cache_alloc_hugetlb_bytes {}\n"
+                   "# TYPE dcgm_hostengine_cache_alloc_thp_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_alloc_thp_bytes Mapped memory advised to use transparent huge pages\n"
+                   "dcgm_hostengine_cache_alloc_thp_bytes {}\n"
+                   "# TYPE dcgm_hostengine_cache_alloc_numa_bound_bytes gauge\n"
+                   "# HELP dcgm_hostengine_cache_alloc_numa_bound_bytes Mapped memory bound to a NUMA node\n"
+                   "dcgm_hostengine_cache_alloc_numa_bound_bytes {}\n",
+                   stats.mappedBytes,
+                   stats.liveBytes,
+                   stats.hugetlbBytes,
+                   stats.thpBytes,
+                   stats.numaBoundBytes);
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::Serve(int clientFd)
+{
+    std::string request;
+    char buffer[1024];
+
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+    {
+        pollfd pfd { .fd = clientFd, .events = POLLIN, .revents = 0 };
+        if (poll(&pfd, 1, REQUEST_TIMEOUT_MS) <= 0)
+        {
+            return;
+        }
+
+        ssize_t const received = recv(clientFd, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+        {
+            return;
+        }
+        request.append(buffer, received);
+    }
+
+    std::string_view const requestLine = std::string_view(request).substr(0, request.find("\r\n"));
+    if (!requestLine.starts_with("GET "))
+    {
+        SendResponse(clientFd, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+        return;
+    }
+
+    std::string_view path = requestLine.substr(4, requestLine.find(' ', 4) - 4);
+    path                  = path.substr(0, path.find('?'));
+    if (path != "/metrics")
+    {
+        SendResponse(clientFd, "404 Not Found", "text/plain", "Metrics are at /metrics\n");
+        return;
+    }
+
+    Render(m_body);
+    SendResponse(clientFd, "200 OK", OPENMETRICS_CONTENT_TYPE, m_body);
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::run()
+{
+    /* The stop eventfd is first so that it can be waited on by itself */
+    pollfd pfds[2] {};
+    pfds[0].fd     = m_stopEventFd.Get();
+    pfds[0].events = POLLIN;
+    pfds[1].fd     = m_listenFd.Get();
+    pfds[1].events = POLLIN;
+
+    while (!ShouldStop())
+    {
+        /* Without a stop eventfd, check for a stop every second */
+        int const ready = poll(pfds, 2, pfds[0].fd < 0 ? 1000 : -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            log_error("poll() of the metrics socket failed: {}", strerror(errno));
+            break;
+        }
+
+        if (ready == 0 || (pfds[1].revents & POLLIN) == 0)
+        {
+            continue;
+        }
+
+        DcgmNs::Utils::FileHandle clientFd(accept4(m_listenFd.Get(), nullptr, nullptr, SOCK_CLOEXEC));
+        if (clientFd.Get() < 0)
+        {
+            log_debug("accept() of a metrics scrape failed: {}", strerror(errno));
+            continue;
+        }
+
+        Serve(clientFd.Get());
+    }
+}
+
+/*****************************************************************************/
+void DcgmMetricsExporter::OnStop()
+{
+    /* Wake up run() if it's blocked in poll() */
+    if (m_stopEventFd.Get() >= 0)
+    {
+        uint64_t one = 1;
+        if (write(m_stopEventFd.Get(), &one, sizeof(one)) < 0)
+        {
+            log_debug("Writing the metrics exporter stop eventfd failed: {}", strerror(errno));
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmCacheManager.h"
+
+#include <DcgmThread.h>
+#include <DcgmUtilities.h>
+
+#include <string>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Serves the latest cached value of every watched numeric field as
+ * OpenMetrics text over HTTP, from inside the host engine.
+ *
+ * A scrape of /metrics reads the values straight from the cache manager's
+ * latest value slots, so it makes no IPC round trip and doesn't take the
+ * cache manager lock unless the watches changed since the last scrape. Metric
+ * names are built once per field from its dcgm_fields metadata, and label
+ * sets once per watch whenever the watches change, so a scrape is one pass
+ * over the values.
+ *
+ * Metrics are named dcgm_<field tag>, are all gauges, and are labelled with
+ * the entity group and ID of the value, plus the UUID of GPUs.
+ *
+ * Requests are served one at a time on this thread.
+ */
+class DcgmMetricsExporter : public DcgmThread
+{
+public:
+    explicit DcgmMetricsExporter(DcgmCacheManager &cacheManager);
+    ~DcgmMetricsExporter() override;
+
+    /*************************************************************************/
+    /*
+     * Start listening for scrapes. Call before Start()
+     *
+     * port         IN: TCP port to listen on
+     * bindAddress  IN: IPv4 address to listen on. "" = all interfaces
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_INIT_ERROR if the port can't be listened on
+     */
+    dcgmReturn_t Listen(unsigned short port, std::string const &bindAddress);
+
+    /*************************************************************************/
+    /*
+     * Replace out with the OpenMetrics text of the latest values
+     */
+    void Render(std::string &out);
+
+    /*************************************************************************/
+    /*
+     * Append the usage and evictions of the cache's memory budget to out.
+     * Appends nothing if there is no budget
+     */
+    void RenderMemoryBudget(std::string &out);
+
+    /*************************************************************************/
+    /*
+     * Append the page usage of the cache's allocator to out. Appends nothing
+     * unless huge pages or NUMA-local allocations are turned on
+     */
+    void RenderCacheAlloc(std::string &out);
+
+    void run() override;
+    void OnStop() override;
+
+private:
+    struct FieldNames
+    {
+        std::string metricName; /* dcgm_<tag>. Empty if the field isn't exported */
+        std::string family;     /* # TYPE and # HELP lines of the metric family */
+    };
+
+    DcgmCacheManager &m_cacheManager;
+    std::vector<FieldNames> m_fieldNames; /* Indexed by field ID */
+
+    dcgmcm_export_plan_t m_plan;
+    std::vector<unsigned int> m_slots;              /* m_plan.slots ordered by field ID, then entity */
+    std::vector<std::string> m_labels;              /* Label set of each of m_slots */
+    std::vector<dcgmLatestValueSample_t> m_samples; /* Values read from m_slots */
+    std::string m_body;                             /* Last scrape. Reused so it's only allocated once */
+
+    DcgmNs::Utils::FileHandle m_listenFd;
+    DcgmNs::Utils::FileHandle m_stopEventFd; /* Written by OnStop() to wake up run() */
+
+    /*************************************************************************/
+    /* Rebuild m_slots and m_labels from m_plan */
+    void BuildLabels();
+
+    /*************************************************************************/
+    /* Read one request from clientFd and send the response */
+    void Serve(int clientFd);
+};
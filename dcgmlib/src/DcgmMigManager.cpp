@@ -63,6 +63,18 @@ dcgmReturn_t DcgmMigManager::RecordGpuComputeInstance(unsigned int gpuId,
     return DCGM_ST_OK;
 }
 
+/*************************************************************************/
+void DcgmMigManager::RemoveGpuInstance(DcgmNs::Mig::GpuInstanceId const &gpuInstanceId)
+{
+    m_instanceIdToGpuId.erase(gpuInstanceId);
+}
+
+/*************************************************************************/
+void DcgmMigManager::RemoveComputeInstance(DcgmNs::Mig::ComputeInstanceId const &computeInstanceId)
+{
+    m_ciIdToMigInfo.erase(computeInstanceId);
+}
+
 /*************************************************************************/
 dcgmReturn_t DcgmMigManager::GetGpuIdFromComputeInstanceId(DcgmNs::Mig::ComputeInstanceId const &computeInstanceId,
                                                            unsigned int &gpuId) const
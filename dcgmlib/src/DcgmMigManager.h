@@ -53,6 +53,12 @@ public:
                                           DcgmNs::Mig::GpuInstanceId const &gpuInstanceId,
                                           DcgmNs::Mig::ComputeInstanceId const &computeInstanceId);
 
+    /*************************************************************************/
+    void RemoveGpuInstance(DcgmNs::Mig::GpuInstanceId const &gpuInstanceId);
+
+    /*************************************************************************/
+    void RemoveComputeInstance(DcgmNs::Mig::ComputeInstanceId const &computeInstanceId);
+
     /*************************************************************************/
     dcgmReturn_t GetGpuIdFromComputeInstanceId(DcgmNs::Mig::ComputeInstanceId const &computeInstanceId,
                                                unsigned int &gpuId) const;
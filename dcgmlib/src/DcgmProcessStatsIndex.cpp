@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmProcessStatsIndex.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+/* Position of the first element with a timestamp after timestamp. Samples normally arrive in order,
+   so check the back first */
+template <typename Container>
+typename Container::iterator UpperBoundByTimestamp(Container &container, timelib64_t timestamp)
+{
+    if (container.empty() || container.back().timestamp <= timestamp)
+    {
+        return container.end();
+    }
+
+    return std::upper_bound(container.begin(),
+                            container.end(),
+                            timestamp,
+                            [](timelib64_t ts, auto const &element) { return ts < element.timestamp; });
+}
+
+/* [first, last) of the elements of container with timestamps in [startTime, endTime]. 0 leaves that end open */
+template <typename Container>
+auto GetTimestampRange(Container const &container, timelib64_t startTime, timelib64_t endTime)
+{
+    auto first = container.begin();
+    auto last  = container.end();
+
+    if (startTime)
+    {
+        first = std::lower_bound(first, last, startTime, [](auto const &element, timelib64_t ts) {
+            return element.timestamp < ts;
+        });
+    }
+    if (endTime)
+    {
+        last = std::upper_bound(
+            first, last, endTime, [](timelib64_t ts, auto const &element) { return ts < element.timestamp; });
+    }
+
+    return std::make_pair(first, last);
+}
+} // namespace
+
+/*****************************************************************************/
+void DcgmProcessStatsIndex::AddEntry(timelib64_t timestamp, unsigned int pid)
+{
+    m_entries.insert(UpperBoundByTimestamp(m_entries, timestamp), Entry { timestamp, pid });
+}
+
+/*****************************************************************************/
+void DcgmProcessStatsIndex::AddAccountingStats(timelib64_t timestamp, dcgmDevicePidAccountingStats_t const &stats)
+{
+    AddEntry(timestamp, stats.pid);
+
+    auto it = m_accounting.find(stats.pid);
+    if (it == m_accounting.end())
+    {
+        m_accounting.emplace(stats.pid, AccountingRecord { timestamp, stats });
+    }
+    else if (it->second.timestamp <= timestamp)
+    {
+        /* Same as walking the timeseries backwards: the last record appended at the latest timestamp wins */
+        it->second = AccountingRecord { timestamp, stats };
+    }
+}
+
+/*****************************************************************************/
+bool DcgmProcessStatsIndex::GetLatestAccountingStats(unsigned int pid,
+                                                     timelib64_t oldestTimestamp,
+                                                     dcgmDevicePidAccountingStats_t &stats) const
+{
+    auto it = m_accounting.find(pid);
+    if (it == m_accounting.end() || it->second.timestamp < oldestTimestamp)
+    {
+        return false;
+    }
+
+    stats = it->second.stats;
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmProcessStatsIndex::AddUtilSample(timelib64_t timestamp, unsigned int pid, double util)
+{
+    AddEntry(timestamp, pid);
+
+    std::deque<UtilSample> &samples = m_utilSamples[pid];
+    double const pruned             = samples.empty() ? 0.0 : samples.front().runningSum - samples.front().util;
+
+    auto it = samples.insert(UpperBoundByTimestamp(samples, timestamp), UtilSample { timestamp, util, 0.0 });
+
+    /* Samples normally arrive in order, so this only updates the new one */
+    double runningSum = it == samples.begin() ? pruned : std::prev(it)->runningSum;
+    for (; it != samples.end(); ++it)
+    {
+        runningSum += it->util;
+        it->runningSum = runningSum;
+    }
+}
+
+/*****************************************************************************/
+bool DcgmProcessStatsIndex::SumUtil(std::deque<UtilSample> const &samples,
+                                    timelib64_t startTime,
+                                    timelib64_t endTime,
+                                    double &utilSum,
+                                    timelib64_t &firstTimestamp)
+{
+    auto [first, last] = GetTimestampRange(samples, startTime, endTime);
+    if (first == last)
+    {
+        return false;
+    }
+
+    utilSum        = std::prev(last)->runningSum - first->runningSum + first->util;
+    firstTimestamp = first->timestamp;
+    return true;
+}
+
+/*****************************************************************************/
+long long DcgmProcessStatsIndex::CountEntries(timelib64_t startTime, timelib64_t endTime) const
+{
+    auto [first, last] = GetTimestampRange(m_entries, startTime, endTime);
+    return std::distance(first, last);
+}
+
+/*****************************************************************************/
+bool DcgmProcessStatsIndex::GetUtilSum(unsigned int pid,
+                                       timelib64_t startTime,
+                                       timelib64_t endTime,
+                                       double &utilSum,
+                                       long long &numSamples) const
+{
+    utilSum    = 0.0;
+    numSamples = 0;
+
+    auto it = m_utilSamples.find(pid);
+    timelib64_t firstTimestamp;
+    if (it == m_utilSamples.end() || !SumUtil(it->second, startTime, endTime, utilSum, firstTimestamp))
+    {
+        return false;
+    }
+
+    numSamples = CountEntries(startTime, endTime);
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmProcessStatsIndex::GetAllUtilSums(timelib64_t startTime,
+                                           timelib64_t endTime,
+                                           std::vector<PidUtilSum> &sums,
+                                           long long &numSamples) const
+{
+    sums.clear();
+    numSamples = 0;
+
+    for (auto const &[pid, samples] : m_utilSamples)
+    {
+        PidUtilSum sum { pid, 0, 0.0 };
+        if (SumUtil(samples, startTime, endTime, sum.utilSum, sum.firstTimestamp))
+        {
+            sums.push_back(sum);
+        }
+    }
+
+    if (!sums.empty())
+    {
+        numSamples = CountEntries(startTime, endTime);
+    }
+}
+
+/*****************************************************************************/
+void DcgmProcessStatsIndex::Prune(timelib64_t oldestKeepTimestamp)
+{
+    while (!m_entries.empty() && m_entries.front().timestamp < oldestKeepTimestamp)
+    {
+        Entry const &entry = m_entries.front();
+
+        auto accountingIt = m_accounting.find(entry.pid);
+        if (accountingIt != m_accounting.end() && accountingIt->second.timestamp <= entry.timestamp)
+        {
+            m_accounting.erase(accountingIt);
+        }
+
+        auto samplesIt = m_utilSamples.find(entry.pid);
+        if (samplesIt != m_utilSamples.end())
+        {
+            samplesIt->second.pop_front();
+            if (samplesIt->second.empty())
+            {
+                m_utilSamples.erase(samplesIt);
+            }
+        }
+
+        m_entries.pop_front();
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+#include "timelib.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Per-PID index of one GPU watch of DCGM_FI_DEV_ACCOUNTING_DATA or of
+ * DCGM_FI_DEV_GPU_UTIL_SAMPLES / DCGM_FI_DEV_MEM_COPY_UTIL_SAMPLES, kept next
+ * to the watch's timeseries so a query for one PID doesn't have to walk every
+ * record of every process.
+ *
+ * For accounting data, it keeps each PID's latest record. For utilization
+ * samples, it keeps each PID's samples with a running sum of their
+ * utilization, plus the timestamps of all samples, which the per-PID
+ * averages are divided by. The utilization of a PID over a range is the
+ * difference of two running sums, so it takes two binary searches however
+ * many samples are in the range.
+ *
+ * The timeseries can drop samples on its own (ring buffer capacity), so
+ * queries pass the timestamp of the timeseries' oldest sample and the index
+ * only answers from what is at or after it. Prune() drops what is older than
+ * the watch's max keep age so the index doesn't outgrow the timeseries.
+ *
+ * Not thread safe. DcgmCacheManager only touches it under its m_mutex.
+ */
+class DcgmProcessStatsIndex
+{
+public:
+    /* Utilization of one PID over a range of samples */
+    struct PidUtilSum
+    {
+        unsigned int pid;
+        timelib64_t firstTimestamp; /* Of the PID's first sample in the range */
+        double utilSum;
+    };
+
+    /*************************************************************************/
+    /* Index an accounting record that was appended to the timeseries at timestamp */
+    void AddAccountingStats(timelib64_t timestamp, dcgmDevicePidAccountingStats_t const &stats);
+
+    /*************************************************************************/
+    /*
+     * Get the latest accounting record of pid, if it was appended at or after
+     * oldestTimestamp.
+     *
+     * Returns: true if stats was set
+     *          false if pid has no such record
+     */
+    bool GetLatestAccountingStats(unsigned int pid,
+                                  timelib64_t oldestTimestamp,
+                                  dcgmDevicePidAccountingStats_t &stats) const;
+
+    /*************************************************************************/
+    /* Index a utilization sample of pid that was appended to the timeseries at timestamp */
+    void AddUtilSample(timelib64_t timestamp, unsigned int pid, double util);
+
+    /*************************************************************************/
+    /*
+     * Sum the utilization samples of pid with timestamps in [startTime, endTime]
+     * and count all of the samples in that range, whichever PID they are for.
+     * A startTime or endTime of 0 leaves that end open.
+     *
+     * Returns: true if pid has at least one sample in the range
+     *          false if not
+     */
+    bool GetUtilSum(unsigned int pid,
+                    timelib64_t startTime,
+                    timelib64_t endTime,
+                    double &utilSum,
+                    long long &numSamples) const;
+
+    /*************************************************************************/
+    /*
+     * Like GetUtilSum() for every PID with at least one sample in [startTime, endTime].
+     * sums is in no particular order
+     */
+    void GetAllUtilSums(timelib64_t startTime,
+                        timelib64_t endTime,
+                        std::vector<PidUtilSum> &sums,
+                        long long &numSamples) const;
+
+    /*************************************************************************/
+    /* Drop everything that was appended before oldestKeepTimestamp. 0 keeps everything */
+    void Prune(timelib64_t oldestKeepTimestamp);
+
+private:
+    struct Entry
+    {
+        timelib64_t timestamp;
+        unsigned int pid;
+    };
+
+    struct UtilSample
+    {
+        timelib64_t timestamp;
+        double util;
+        double runningSum; /* util of this sample and of every sample of the PID before it, pruned or not */
+    };
+
+    struct AccountingRecord
+    {
+        timelib64_t timestamp;
+        dcgmDevicePidAccountingStats_t stats;
+    };
+
+    /*************************************************************************/
+    /* Insert entry into m_entries, keeping it sorted by timestamp */
+    void AddEntry(timelib64_t timestamp, unsigned int pid);
+
+    /*************************************************************************/
+    /* Sum of the utilization of the samples of one PID in [startTime, endTime]. 0 leaves that end open */
+    static bool SumUtil(std::deque<UtilSample> const &samples,
+                        timelib64_t startTime,
+                        timelib64_t endTime,
+                        double &utilSum,
+                        timelib64_t &firstTimestamp);
+
+    /*************************************************************************/
+    long long CountEntries(timelib64_t startTime, timelib64_t endTime) const;
+
+    std::deque<Entry> m_entries; /* Every record or sample, sorted by timestamp */
+    std::unordered_map<unsigned int, AccountingRecord> m_accounting; /* pid -> latest accounting record */
+    std::unordered_map<unsigned int, std::deque<UtilSample>> m_utilSamples; /* pid -> its samples, sorted
+                                                                                by timestamp */
+};
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmProfMultiplexer.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+
+/*****************************************************************************/
+dcgmReturn_t DcgmProfMultiplexPlan::Build(dcgmProfGetMetricGroups_v3 const &metricGroups,
+                                          std::vector<unsigned short> const &fieldIds,
+                                          DcgmProfMultiplexPlan &plan)
+{
+    std::set<unsigned short> uncovered(fieldIds.begin(), fieldIds.end());
+    unsigned int const numMetricGroups
+        = std::min(metricGroups.numMetricGroups, (unsigned int)DCGM_PROF_MAX_NUM_GROUPS_V2);
+
+    /* Fields of each metric group that are part of the plan, by majorId */
+    std::map<unsigned short, std::vector<std::vector<unsigned short>>> groupsByMajorId;
+
+    /* Pick the metric group that collects the most of the remaining fields until they are all collected. This keeps
+       the number of metric groups, and with it the number of passes, low */
+    while (!uncovered.empty())
+    {
+        dcgmProfMetricGroupInfo_v2 const *best = nullptr;
+        std::vector<unsigned short> bestFields;
+
+        for (unsigned int i = 0; i < numMetricGroups; i++)
+        {
+            dcgmProfMetricGroupInfo_v2 const &metricGroup = metricGroups.metricGroups[i];
+            unsigned int const numFieldIds
+                = std::min(metricGroup.numFieldIds, (unsigned int)DCGM_PROF_MAX_FIELD_IDS_PER_GROUP_V2);
+
+            std::vector<unsigned short> fields;
+            for (unsigned int j = 0; j < numFieldIds; j++)
+            {
+                if (uncovered.contains(metricGroup.fieldIds[j]))
+                {
+                    fields.push_back(metricGroup.fieldIds[j]);
+                }
+            }
+
+            if (fields.size() > bestFields.size())
+            {
+                best       = &metricGroup;
+                bestFields = std::move(fields);
+            }
+        }
+
+        if (best == nullptr)
+        {
+            log_error("fieldId {} is not part of any of the {} metric groups", *uncovered.begin(), numMetricGroups);
+            return DCGM_ST_PROFILING_NOT_SUPPORTED;
+        }
+
+        for (unsigned short fieldId : bestFields)
+        {
+            uncovered.erase(fieldId);
+        }
+        std::ranges::sort(bestFields);
+        groupsByMajorId[best->majorId].push_back(std::move(bestFields));
+    }
+
+    std::size_t numPasses = 0;
+    for (auto const &[majorId, groups] : groupsByMajorId)
+    {
+        numPasses = std::max(numPasses, groups.size());
+    }
+
+    plan.m_passes.assign(numPasses, {});
+    for (std::size_t pass = 0; pass < numPasses; pass++)
+    {
+        auto &passFields = plan.m_passes[pass];
+        for (auto const &[majorId, groups] : groupsByMajorId)
+        {
+            auto const &groupFields = groups[pass % groups.size()];
+            passFields.insert(passFields.end(), groupFields.begin(), groupFields.end());
+        }
+        std::ranges::sort(passFields);
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+double DcgmProfMultiplexPlan::SampledFraction(unsigned short fieldId) const
+{
+    if (m_passes.empty())
+    {
+        return 0.0;
+    }
+
+    auto const numSampled = std::ranges::count_if(m_passes, [fieldId](std::vector<unsigned short> const &pass) {
+        return std::ranges::binary_search(pass, fieldId);
+    });
+    return (double)numSampled / m_passes.size();
+}
+
+/*****************************************************************************/
+std::vector<unsigned short> DcgmProfMultiplexPlan::FieldIds() const
+{
+    std::set<unsigned short> fieldIds;
+    for (auto const &pass : m_passes)
+    {
+        fieldIds.insert(pass.begin(), pass.end());
+    }
+    return { fieldIds.begin(), fieldIds.end() };
+}
+
+/*****************************************************************************/
+DcgmProfMultiplexer::DcgmProfMultiplexer(ApplyPassFn applyPass, bool ownThread)
+    : m_applyPass(std::move(applyPass))
+    , m_ownThread(ownThread)
+{}
+
+/*****************************************************************************/
+DcgmProfMultiplexer::~DcgmProfMultiplexer()
+{
+    Stop();
+}
+
+/*****************************************************************************/
+void DcgmProfMultiplexer::Stop()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.request_stop();
+        m_thread.join();
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmProfMultiplexer::Add(unsigned int groupId, DcgmProfMultiplexWatch watch, timelib64_t now)
+{
+    if (watch.plan.NumPasses() == 0)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    watch.windowUsec = std::max(watch.updateFreq * c_samplesPerWindow, c_minWindowUsec);
+    watch.pass       = 0;
+    watch.nextSwitch = now + watch.windowUsec;
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    m_watches.erase(groupId);
+
+    dcgmReturn_t dcgmReturn = m_applyPass(groupId, watch, watch.plan.FieldsOfPass(0));
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Unable to watch the first of {} passes of groupId {}: {}",
+                  watch.plan.NumPasses(),
+                  groupId,
+                  errorString(dcgmReturn));
+        return dcgmReturn;
+    }
+
+    log_info("Multiplexing the profiling fields of groupId {} over {} passes of {} usec",
+             groupId,
+             watch.plan.NumPasses(),
+             watch.windowUsec);
+
+    m_watches[groupId] = std::move(watch);
+    m_numAdds++;
+    StartThreadLocked();
+    m_wakeUp.notify_all();
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmProfMultiplexer::Remove(unsigned int groupId)
+{
+    std::lock_guard<std::mutex> lg(m_mutex);
+    m_watches.erase(groupId);
+}
+
+/*****************************************************************************/
+void DcgmProfMultiplexer::RemoveConnection(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lg(m_mutex);
+    std::erase_if(m_watches, [connectionId](auto const &entry) { return entry.second.connectionId == connectionId; });
+}
+
+/*****************************************************************************/
+std::optional<DcgmProfMultiplexWatch> DcgmProfMultiplexer::GetWatch(unsigned int groupId) const
+{
+    std::lock_guard<std::mutex> lg(m_mutex);
+    auto const it = m_watches.find(groupId);
+    if (it == m_watches.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+/*****************************************************************************/
+timelib64_t DcgmProfMultiplexer::SwitchDuePasses(timelib64_t now)
+{
+    timelib64_t nextSwitch = 0;
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    for (auto &[groupId, watch] : m_watches)
+    {
+        if (watch.nextSwitch <= now)
+        {
+            std::size_t const pass  = (watch.pass + 1) % watch.plan.NumPasses();
+            dcgmReturn_t dcgmReturn = m_applyPass(groupId, watch, watch.plan.FieldsOfPass(pass));
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                /* Stay on the current pass and try again next window */
+                log_error("Unable to switch groupId {} to pass {}: {}", groupId, pass, errorString(dcgmReturn));
+            }
+            else
+            {
+                watch.pass = pass;
+            }
+            watch.nextSwitch = now + watch.windowUsec;
+        }
+
+        if (nextSwitch == 0 || watch.nextSwitch < nextSwitch)
+        {
+            nextSwitch = watch.nextSwitch;
+        }
+    }
+
+    return nextSwitch;
+}
+
+/*****************************************************************************/
+void DcgmProfMultiplexer::StartThreadLocked()
+{
+    if (!m_ownThread || m_thread.joinable())
+    {
+        return;
+    }
+
+    m_thread = std::jthread([this](std::stop_token stopToken) {
+        pthread_setname_np(pthread_self(), "dcgm_prof_mux");
+
+        while (!stopToken.stop_requested())
+        {
+            SwitchDuePasses(timelib_usecSince1970());
+
+            /* Look at the watches again under the lock, so an Add() since can't be missed */
+            std::unique_lock<std::mutex> lock(m_mutex);
+            timelib64_t nextSwitch = 0;
+            for (auto const &[groupId, watch] : m_watches)
+            {
+                if (nextSwitch == 0 || watch.nextSwitch < nextSwitch)
+                {
+                    nextSwitch = watch.nextSwitch;
+                }
+            }
+
+            auto const numAdds = m_numAdds;
+            auto const added   = [this, numAdds] { return m_numAdds != numAdds; };
+            if (nextSwitch == 0)
+            {
+                m_wakeUp.wait(lock, stopToken, added);
+            }
+            else
+            {
+                timelib64_t const sleepUsec = std::max(nextSwitch - timelib_usecSince1970(), (timelib64_t)0);
+                m_wakeUp.wait_for(lock, stopToken, std::chrono::microseconds(sleepUsec), added);
+            }
+        }
+    });
+}
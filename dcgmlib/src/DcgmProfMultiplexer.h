@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+#include "dcgm_structs_internal.h"
+#include "timelib.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Split of a set of profiling fields into passes that the profiling module can
+ * collect one at a time.
+ *
+ * Metric groups with the same majorId can't be watched at the same time. Each
+ * pass watches at most one metric group per majorId, so a majorId whose fields
+ * are spread over N metric groups takes N passes. Metric groups of majorIds that
+ * fit in fewer passes are repeated in the remaining ones.
+ */
+class DcgmProfMultiplexPlan
+{
+public:
+    /*************************************************************************/
+    /*
+     * Build the plan that collects fieldIds from the metric groups of a GPU
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_PROFILING_NOT_SUPPORTED if a field is in none of the metric groups
+     */
+    static dcgmReturn_t Build(dcgmProfGetMetricGroups_v3 const &metricGroups,
+                              std::vector<unsigned short> const &fieldIds,
+                              DcgmProfMultiplexPlan &plan);
+
+    /*************************************************************************/
+    std::size_t NumPasses() const
+    {
+        return m_passes.size();
+    }
+
+    /*************************************************************************/
+    /* Fields watched during pass, which has to be < NumPasses() */
+    std::vector<unsigned short> const &FieldsOfPass(std::size_t pass) const
+    {
+        return m_passes[pass];
+    }
+
+    /*************************************************************************/
+    /* Fraction of the passes that collect fieldId. 0.0 if the plan doesn't collect it */
+    double SampledFraction(unsigned short fieldId) const;
+
+    /*************************************************************************/
+    /* Every field the plan collects, in ascending order */
+    std::vector<unsigned short> FieldIds() const;
+
+private:
+    std::vector<std::vector<unsigned short>> m_passes;
+};
+
+/*****************************************************************************/
+/* A profiling watch that is collected by rotating through the passes of its plan */
+struct DcgmProfMultiplexWatch
+{
+    dcgm_connection_id_t connectionId = DCGM_CONNECTION_ID_NONE; /* Connection that owns the watch */
+    DcgmProfMultiplexPlan plan;
+    timelib64_t updateFreq = 0; /* Arguments of the original watch request */
+    double maxKeepAge      = 0.0;
+    int maxKeepSamples     = 0;
+    timelib64_t windowUsec = 0; /* How long each pass is watched */
+    std::size_t pass       = 0; /* Pass that is watched now */
+    timelib64_t nextSwitch = 0; /* When to move on to the next pass */
+};
+
+/*****************************************************************************/
+/*
+ * Time-multiplexes the profiling watches of GPU groups whose fields can't be
+ * collected in a single pass.
+ *
+ * Each watch is given a window of c_samplesPerWindow update intervals per pass
+ * so that every pass yields samples before the next one replaces it. Profiling
+ * fields are rates and ratios over their sampling interval, so the samples of a
+ * pass are estimates for the whole window and are cached without scaling. The
+ * fraction of the time each field was collected is reported by GetWatch().
+ *
+ * Passes are switched on the multiplexer's own thread, which is started by the
+ * first Add().
+ */
+class DcgmProfMultiplexer
+{
+public:
+    /*
+     * Watch fieldIds of groupId on behalf of watch.connectionId, replacing what the profiling module
+     * watches for the group
+     */
+    using ApplyPassFn = std::function<dcgmReturn_t(unsigned int groupId,
+                                                   DcgmProfMultiplexWatch const &watch,
+                                                   std::vector<unsigned short> const &fieldIds)>;
+
+    /* Each pass lasts this many update intervals */
+    static constexpr timelib64_t c_samplesPerWindow = 2;
+
+    /* Shortest window, so fast watches don't make the module restart its counters all the time */
+    static constexpr timelib64_t c_minWindowUsec = 1000000;
+
+    /*************************************************************************/
+    /*
+     * ownThread=false leaves calling SwitchDuePasses() to the caller instead of starting a thread
+     */
+    explicit DcgmProfMultiplexer(ApplyPassFn applyPass, bool ownThread = true);
+
+    /*************************************************************************/
+    /* Stops the thread. The passes being watched are left to the caller */
+    ~DcgmProfMultiplexer();
+
+    DcgmProfMultiplexer(DcgmProfMultiplexer const &)            = delete;
+    DcgmProfMultiplexer &operator=(DcgmProfMultiplexer const &) = delete;
+
+    /*************************************************************************/
+    /*
+     * Start multiplexing the watch of groupId, replacing any earlier one. The window and pass of watch
+     * are set here. The first pass is applied before returning
+     *
+     * RETURNS: The result of applying the first pass. The watch is not added on error
+     */
+    dcgmReturn_t Add(unsigned int groupId, DcgmProfMultiplexWatch watch, timelib64_t now);
+
+    /*************************************************************************/
+    /* Stop multiplexing the watch of groupId. Does nothing if there is none */
+    void Remove(unsigned int groupId);
+
+    /*************************************************************************/
+    /* Stop multiplexing the watches of connectionId */
+    void RemoveConnection(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /* Copy of the watch of groupId. std::nullopt if groupId isn't multiplexed */
+    std::optional<DcgmProfMultiplexWatch> GetWatch(unsigned int groupId) const;
+
+    /*************************************************************************/
+    /*
+     * Move every watch whose window ended by now on to its next pass
+     *
+     * RETURNS: When the next window ends. 0 if there are no watches
+     */
+    timelib64_t SwitchDuePasses(timelib64_t now);
+
+    /*************************************************************************/
+    /* Stop the thread. Called by the destructor */
+    void Stop();
+
+private:
+    void StartThreadLocked();
+
+    ApplyPassFn m_applyPass;
+    bool const m_ownThread;
+
+    mutable std::mutex m_mutex; /* Protects m_watches. Held while passes are applied so a removed watch
+                                   can't be applied again */
+    std::map<unsigned int, DcgmProfMultiplexWatch> m_watches; /* Multiplexed watches by groupId */
+    unsigned long long m_numAdds = 0; /* Calls to Add() that succeeded. Wakes up the thread */
+    std::condition_variable_any m_wakeUp;
+    std::jthread m_thread;
+};
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmQuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/* Each bin covers (gamma^(index-1), gamma^index] */
+constexpr double c_accuracy = DcgmQuantileSketch::c_relativeAccuracy;
+double const c_gamma        = (1.0 + c_accuracy) / (1.0 - c_accuracy);
+double const c_logGamma     = std::log(c_gamma);
+} // namespace
+
+/*****************************************************************************/
+int DcgmQuantileSketch::GetIndex(double magnitude)
+{
+    return (int)std::ceil(std::log(magnitude) / c_logGamma);
+}
+
+/*****************************************************************************/
+double DcgmQuantileSketch::GetBinValue(int index)
+{
+    /* The point of the bin that is within c_relativeAccuracy of both of its edges */
+    return 2.0 * std::pow(c_gamma, index) / (c_gamma + 1.0);
+}
+
+/*****************************************************************************/
+void DcgmQuantileSketch::AddToBins(std::vector<Bin> &bins, int index, long long count)
+{
+    auto it = std::lower_bound(
+        bins.begin(), bins.end(), index, [](Bin const &bin, int binIndex) { return bin.index < binIndex; });
+    if (it != bins.end() && it->index == index)
+    {
+        it->count += count;
+        return;
+    }
+
+    bins.insert(it, Bin { index, count });
+    CollapseBins(bins);
+}
+
+/*****************************************************************************/
+void DcgmQuantileSketch::CollapseBins(std::vector<Bin> &bins)
+{
+    if (bins.size() <= c_maxBins)
+    {
+        return;
+    }
+
+    /* Fold the lowest bins into the lowest one that is kept */
+    size_t const numFolded = bins.size() - c_maxBins;
+    for (size_t i = 0; i < numFolded; i++)
+    {
+        bins[numFolded].count += bins[i].count;
+    }
+    bins.erase(bins.begin(), bins.begin() + numFolded);
+}
+
+/*****************************************************************************/
+void DcgmQuantileSketch::Add(double value)
+{
+    if (!std::isfinite(value))
+    {
+        return;
+    }
+
+    if (m_count == 0 || value < m_minValue)
+    {
+        m_minValue = value;
+    }
+    if (m_count == 0 || value > m_maxValue)
+    {
+        m_maxValue = value;
+    }
+    m_count++;
+
+    if (value > 0.0)
+    {
+        AddToBins(m_positiveBins, GetIndex(value), 1);
+    }
+    else if (value < 0.0)
+    {
+        AddToBins(m_negativeBins, GetIndex(-value), 1);
+    }
+    else
+    {
+        m_zeroCount++;
+    }
+}
+
+/*****************************************************************************/
+void DcgmQuantileSketch::Merge(DcgmQuantileSketch const &other)
+{
+    if (other.m_count == 0)
+    {
+        return;
+    }
+
+    if (m_count == 0 || other.m_minValue < m_minValue)
+    {
+        m_minValue = other.m_minValue;
+    }
+    if (m_count == 0 || other.m_maxValue > m_maxValue)
+    {
+        m_maxValue = other.m_maxValue;
+    }
+    m_count += other.m_count;
+    m_zeroCount += other.m_zeroCount;
+
+    auto mergeBins = [](std::vector<Bin> &bins, std::vector<Bin> const &otherBins) {
+        if (otherBins.empty())
+        {
+            return;
+        }
+
+        std::vector<Bin> merged;
+        merged.reserve(bins.size() + otherBins.size());
+
+        auto it      = bins.begin();
+        auto otherIt = otherBins.begin();
+        while (it != bins.end() || otherIt != otherBins.end())
+        {
+            if (otherIt == otherBins.end() || (it != bins.end() && it->index < otherIt->index))
+            {
+                merged.push_back(*it++);
+            }
+            else if (it == bins.end() || otherIt->index < it->index)
+            {
+                merged.push_back(*otherIt++);
+            }
+            else
+            {
+                merged.push_back(Bin { it->index, it->count + otherIt->count });
+                ++it;
+                ++otherIt;
+            }
+        }
+
+        CollapseBins(merged);
+        bins = std::move(merged);
+    };
+
+    mergeBins(m_positiveBins, other.m_positiveBins);
+    mergeBins(m_negativeBins, other.m_negativeBins);
+}
+
+/*****************************************************************************/
+template <typename Fn>
+void DcgmQuantileSketch::ForEachBin(Fn &&fn) const
+{
+    for (auto it = m_negativeBins.rbegin(); it != m_negativeBins.rend(); ++it)
+    {
+        if (fn(-GetBinValue(it->index), it->count))
+        {
+            return;
+        }
+    }
+
+    if (m_zeroCount > 0 && fn(0.0, m_zeroCount))
+    {
+        return;
+    }
+
+    for (Bin const &bin : m_positiveBins)
+    {
+        if (fn(GetBinValue(bin.index), bin.count))
+        {
+            return;
+        }
+    }
+}
+
+/*****************************************************************************/
+bool DcgmQuantileSketch::GetQuantile(double quantile, double &value) const
+{
+    if (m_count == 0)
+    {
+        return false;
+    }
+
+    if (quantile <= 0.0)
+    {
+        value = m_minValue;
+        return true;
+    }
+    if (quantile >= 1.0)
+    {
+        value = m_maxValue;
+        return true;
+    }
+
+    double const rank    = quantile * (double)(m_count - 1);
+    long long cumulative = 0;
+
+    value = m_maxValue;
+    ForEachBin([&](double binValue, long long count) {
+        cumulative += count;
+        if ((double)cumulative > rank)
+        {
+            value = binValue;
+            return true;
+        }
+        return false;
+    });
+
+    value = std::clamp(value, m_minValue, m_maxValue);
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmQuantileSketch::GetHistogram(double minValue,
+                                      double maxValue,
+                                      unsigned int numBuckets,
+                                      long long *counts) const
+{
+    if (numBuckets == 0)
+    {
+        return;
+    }
+
+    std::fill(counts, counts + numBuckets, 0);
+
+    double const width = (maxValue - minValue) / numBuckets;
+
+    ForEachBin([&](double binValue, long long count) {
+        double const value = std::clamp(binValue, m_minValue, m_maxValue);
+
+        long long bucket;
+        if (width > 0.0)
+        {
+            bucket = (long long)std::floor((value - minValue) / width);
+        }
+        else
+        {
+            bucket = value <= minValue ? 0 : numBuckets - 1;
+        }
+
+        counts[std::clamp(bucket, 0LL, (long long)numBuckets - 1)] += count;
+        return false;
+    });
+}
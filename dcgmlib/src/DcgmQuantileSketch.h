@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Mergeable quantile sketch (DDSketch) of a set of samples.
+ *
+ * Samples are counted in bins whose width grows with their distance from zero,
+ * so every quantile is answered within c_relativeAccuracy of a sample's value
+ * without keeping the samples, and two sketches merge by adding up their bins.
+ * At most c_maxBins bins are kept per sign. Past that the bins closest to zero
+ * are folded together, which only costs accuracy at the low end.
+ */
+class DcgmQuantileSketch
+{
+public:
+    static constexpr double c_relativeAccuracy = 0.01;
+    static constexpr size_t c_maxBins          = 512;
+
+    /*************************************************************************/
+    /* Add a sample */
+    void Add(double value);
+
+    /*************************************************************************/
+    /* Add all of other's samples */
+    void Merge(DcgmQuantileSketch const &other);
+
+    /*************************************************************************/
+    /* Number of samples added */
+    long long GetCount() const
+    {
+        return m_count;
+    }
+
+    /*************************************************************************/
+    /*
+     * Get the value at quantile (0.0 - 1.0) of the samples. 0.0 and 1.0 are the
+     * exact minimum and maximum.
+     *
+     * Returns: true on success
+     *          false if no sample was added
+     */
+    bool GetQuantile(double quantile, double &value) const;
+
+    /*************************************************************************/
+    /*
+     * Count the samples in numBuckets equally wide buckets from minValue to maxValue.
+     * Samples below minValue or above maxValue count toward the first or last bucket.
+     * Counts near a bucket edge may land in the neighboring bucket, same as the accuracy
+     * of GetQuantile()
+     */
+    void GetHistogram(double minValue, double maxValue, unsigned int numBuckets, long long *counts) const;
+
+private:
+    struct Bin
+    {
+        int index;
+        long long count;
+    };
+
+    /*************************************************************************/
+    static int GetIndex(double magnitude);
+    static double GetBinValue(int index);
+    static void AddToBins(std::vector<Bin> &bins, int index, long long count);
+    static void CollapseBins(std::vector<Bin> &bins);
+
+    /*************************************************************************/
+    /* Call fn(value, count) for each bin, from the lowest value to the highest */
+    template <typename Fn>
+    void ForEachBin(Fn &&fn) const;
+
+    std::vector<Bin> m_positiveBins; /* Sorted by index */
+    std::vector<Bin> m_negativeBins; /* Bins of -value. Sorted by index */
+    long long m_zeroCount = 0;
+    long long m_count     = 0;
+    double m_minValue     = 0.0;
+    double m_maxValue     = 0.0;
+};
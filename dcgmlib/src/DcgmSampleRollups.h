@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmQuantileSketch.h"
+#include "timelib.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+
+/*****************************************************************************/
+/* Min/max/sum/count of a set of samples. Blank samples only contribute to count */
+template <typename T>
+struct DcgmRollupSummary
+{
+    T minValue {};
+    T maxValue {};
+    T sumValue {};
+    long long count         = 0; /* All samples, including blank ones */
+    long long nonBlankCount = 0; /* Samples that contributed to minValue, maxValue and sumValue */
+
+    void Add(T value, bool isBlank)
+    {
+        count++;
+        if (isBlank)
+        {
+            return;
+        }
+
+        if (!nonBlankCount || value < minValue)
+        {
+            minValue = value;
+        }
+        if (!nonBlankCount || value > maxValue)
+        {
+            maxValue = value;
+        }
+        sumValue += value;
+        nonBlankCount++;
+    }
+
+    void Merge(DcgmRollupSummary const &other)
+    {
+        count += other.count;
+        if (!other.nonBlankCount)
+        {
+            return;
+        }
+
+        if (!nonBlankCount || other.minValue < minValue)
+        {
+            minValue = other.minValue;
+        }
+        if (!nonBlankCount || other.maxValue > maxValue)
+        {
+            maxValue = other.maxValue;
+        }
+        sumValue += other.sumValue;
+        nonBlankCount += other.nonBlankCount;
+    }
+};
+
+/*****************************************************************************/
+/*
+ * Downsampled tiers of one watch's samples, maintained as samples are appended.
+ *
+ * Each tier summarizes the samples in fixed-width, time-aligned buckets and keeps
+ * a bounded number of buckets, so coarse tiers retain summaries well beyond the
+ * raw samples' retention. Summarize() answers the whole buckets that fall in a
+ * time range from the coarsest tier that has any and leaves the partial buckets
+ * at either edge for the caller to read from the raw samples. Each bucket also
+ * keeps a quantile sketch of its non-blank samples for percentile summaries.
+ */
+template <typename T>
+class DcgmSampleRollups
+{
+public:
+    static constexpr unsigned int c_numTiers = 3;
+
+    /* Bucket width and number of buckets kept by each tier. That's 10 minutes of 1s buckets,
+       1 hour of 10s buckets and 24 hours of 60s buckets */
+    static constexpr std::array<timelib64_t, c_numTiers> c_tierWidthUsec { 1000000, 10000000, 60000000 };
+    static constexpr std::array<size_t, c_numTiers> c_tierMaxBuckets { 600, 360, 1440 };
+
+    /*************************************************************************/
+    /*
+     * Add a sample to every tier. Samples older than what a tier has already
+     * discarded are ignored by that tier
+     */
+    void Append(timelib64_t timestamp, T value, bool isBlank)
+    {
+        for (unsigned int tierIndex = 0; tierIndex < c_numTiers; tierIndex++)
+        {
+            AppendToTier(tierIndex, timestamp, value, isBlank);
+        }
+    }
+
+    /*************************************************************************/
+    /*
+     * Summarize the whole buckets of [startTime, endTime] of the coarsest tier that
+     * has any. 0 for startTime or endTime means unbounded.
+     *
+     * summary        OUT: Summary of the samples in [interiorStart, interiorEnd)
+     * interiorStart  OUT: Start of the range covered by summary
+     * interiorEnd    OUT: End (exclusive) of the range covered by summary
+     * sketch         OUT: Optional. Quantile sketch of the same samples as summary
+     *
+     * Returns: true if summary covers a non-empty range. The caller needs to add the samples
+     *               of [startTime, interiorStart) and [interiorEnd, endTime] itself
+     *          false if no tier has a whole bucket in the range
+     */
+    bool Summarize(timelib64_t startTime,
+                   timelib64_t endTime,
+                   DcgmRollupSummary<T> &summary,
+                   timelib64_t &interiorStart,
+                   timelib64_t &interiorEnd,
+                   DcgmQuantileSketch *sketch = nullptr) const
+    {
+        for (int tierIndex = c_numTiers - 1; tierIndex >= 0; tierIndex--)
+        {
+            Tier const &tier  = m_tiers[tierIndex];
+            timelib64_t width = c_tierWidthUsec[tierIndex];
+
+            if (tier.buckets.empty())
+            {
+                continue;
+            }
+
+            /* Round the range inward to bucket boundaries, but never before what the tier still covers */
+            timelib64_t start = std::max(RoundDown(startTime + width - 1, width), tier.coverageStartUsec);
+            timelib64_t end   = endTime ? RoundDown(endTime + 1, width) : tier.buckets.back().startUsec + width;
+            if (start >= end)
+            {
+                continue;
+            }
+
+            summary = {};
+            if (sketch != nullptr)
+            {
+                *sketch = {};
+            }
+            auto it = std::lower_bound(
+                tier.buckets.begin(), tier.buckets.end(), start, [](Bucket const &bucket, timelib64_t ts) {
+                    return bucket.startUsec < ts;
+                });
+            for (; it != tier.buckets.end() && it->startUsec < end; ++it)
+            {
+                summary.Merge(it->summary);
+                if (sketch != nullptr)
+                {
+                    sketch->Merge(it->sketch);
+                }
+            }
+
+            interiorStart = start;
+            interiorEnd   = end;
+            return true;
+        }
+
+        return false;
+    }
+
+    /*************************************************************************/
+    /* Number of buckets across all tiers */
+    size_t GetNumBuckets() const
+    {
+        size_t numBuckets = 0;
+        for (auto const &tier : m_tiers)
+        {
+            numBuckets += tier.buckets.size();
+        }
+        return numBuckets;
+    }
+
+private:
+    struct Bucket
+    {
+        timelib64_t startUsec = 0;
+        DcgmRollupSummary<T> summary {};
+        DcgmQuantileSketch sketch; /* Non-blank samples only */
+    };
+
+    struct Tier
+    {
+        std::deque<Bucket> buckets;        /* Sorted by startUsec */
+        timelib64_t coverageStartUsec = 0; /* Every sample at or after this time is in buckets */
+    };
+
+    /*************************************************************************/
+    static timelib64_t RoundDown(timelib64_t timestamp, timelib64_t width)
+    {
+        return timestamp - (timestamp % width);
+    }
+
+    /*************************************************************************/
+    static void AddToBucket(Bucket &bucket, T value, bool isBlank)
+    {
+        bucket.summary.Add(value, isBlank);
+        if (!isBlank)
+        {
+            bucket.sketch.Add((double)value);
+        }
+    }
+
+    /*************************************************************************/
+    void AppendToTier(unsigned int tierIndex, timelib64_t timestamp, T value, bool isBlank)
+    {
+        Tier &tier              = m_tiers[tierIndex];
+        timelib64_t width       = c_tierWidthUsec[tierIndex];
+        timelib64_t bucketStart = RoundDown(timestamp, width);
+
+        if (tier.buckets.empty())
+        {
+            if (tier.coverageStartUsec == 0)
+            {
+                tier.coverageStartUsec = bucketStart;
+            }
+        }
+        else if (timestamp < tier.coverageStartUsec)
+        {
+            return; /* Already discarded by this tier */
+        }
+
+        if (tier.buckets.empty() || tier.buckets.back().startUsec < bucketStart)
+        {
+            /* Common case. Samples arrive in time order */
+            tier.buckets.push_back(Bucket { bucketStart, {}, {} });
+            AddToBucket(tier.buckets.back(), value, isBlank);
+        }
+        else
+        {
+            auto it = std::lower_bound(
+                tier.buckets.begin(), tier.buckets.end(), bucketStart, [](Bucket const &bucket, timelib64_t ts) {
+                    return bucket.startUsec < ts;
+                });
+            if (it == tier.buckets.end() || it->startUsec != bucketStart)
+            {
+                it = tier.buckets.insert(it, Bucket { bucketStart, {}, {} });
+            }
+            AddToBucket(*it, value, isBlank);
+        }
+
+        while (tier.buckets.size() > c_tierMaxBuckets[tierIndex])
+        {
+            tier.coverageStartUsec = tier.buckets.front().startUsec + width;
+            tier.buckets.pop_front();
+        }
+    }
+
+    std::array<Tier, c_numTiers> m_tiers;
+};
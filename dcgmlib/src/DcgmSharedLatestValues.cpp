@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmSharedLatestValues.h"
+
+#include "timeseries.h"
+
+#include <DcgmLogging.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+/* shm_open() names are a slash followed by up to NAME_MAX characters that aren't slashes */
+bool IsValidShmName(std::string const &name)
+{
+    return name.size() > 1 && name.size() <= NAME_MAX + 1 && name[0] == '/'
+           && name.find('/', 1) == std::string::npos;
+}
+} // namespace
+
+/*****************************************************************************/
+DcgmSharedLatestValues::DcgmSharedLatestValues(std::string name, void *mapping, size_t mappingSize, bool isWriter)
+    : m_name(std::move(name))
+    , m_mapping(mapping)
+    , m_mappingSize(mappingSize)
+    , m_isWriter(isWriter)
+{}
+
+/*****************************************************************************/
+DcgmSharedLatestValues::~DcgmSharedLatestValues()
+{
+    if (m_isWriter)
+    {
+        GetHeader()->closed.store(1, std::memory_order_release);
+        if (shm_unlink(m_name.c_str()) != 0)
+        {
+            log_warning("Unable to unlink shared memory segment {}. errno {}", m_name, errno);
+        }
+    }
+
+    munmap(m_mapping, m_mappingSize);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmSharedLatestValues::Create(std::string const &name,
+                                            unsigned int capacity,
+                                            std::unique_ptr<DcgmSharedLatestValues> &values)
+{
+    if (!IsValidShmName(name) || capacity == 0)
+    {
+        log_error("Invalid shared memory segment name '{}' or capacity {}", name, capacity);
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* A segment of a host engine that didn't exit cleanly is replaced. Its readers still see it as open, but
+       their values stop updating */
+    shm_unlink(name.c_str());
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        log_error("Unable to create shared memory segment {}. errno {}", name, errno);
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    size_t const mappingSize = c_rowsOffset + (size_t)capacity * sizeof(DcgmLatestValueSlots::Slot);
+
+    /* The umask may have taken read access away from other users */
+    void *mapping = MAP_FAILED;
+    if (fchmod(fd, 0644) == 0 && ftruncate(fd, (off_t)mappingSize) == 0)
+    {
+        mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    int const savedErrno = errno;
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        log_error("Unable to size or map shared memory segment {}. errno {}", name, savedErrno);
+        shm_unlink(name.c_str());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    /* The segment starts out zeroed, which is what the constructors write. Running them makes the objects live */
+    auto *header     = new (mapping) Header {};
+    auto *rows       = reinterpret_cast<DcgmLatestValueSlots::Slot *>(static_cast<char *>(mapping) + c_rowsOffset);
+    header->version  = c_version;
+    header->rowSize  = sizeof(DcgmLatestValueSlots::Slot);
+    header->capacity = capacity;
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        new (&rows[i]) DcgmLatestValueSlots::Slot();
+    }
+
+    /* Readers check the magic last, once the rest of the header is set */
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = c_magic;
+
+    values.reset(new DcgmSharedLatestValues(name, mapping, mappingSize, true));
+    log_info("Publishing latest values to shared memory segment {} with {} rows", name, capacity);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmSharedLatestValues::Open(std::string const &name, std::unique_ptr<DcgmSharedLatestValues> &values)
+{
+    if (!IsValidShmName(name))
+    {
+        log_error("Invalid shared memory segment name '{}'", name);
+        return DCGM_ST_BADPARAM;
+    }
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        int const savedErrno = errno;
+        log_debug("Unable to open shared memory segment {}. errno {}", name, savedErrno);
+        return savedErrno == EACCES ? DCGM_ST_NO_PERMISSION : DCGM_ST_NO_DATA;
+    }
+
+    struct stat st {};
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= c_rowsOffset)
+    {
+        mapping = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        /* Also the case while the writer is still sizing the segment */
+        log_debug("Unable to map shared memory segment {}", name);
+        return DCGM_ST_NO_DATA;
+    }
+
+    std::unique_ptr<DcgmSharedLatestValues> reader(new DcgmSharedLatestValues(name, mapping, st.st_size, false));
+    Header const *header = reader->GetHeader();
+
+    if (header->magic != c_magic || header->version != c_version
+        || header->rowSize != sizeof(DcgmLatestValueSlots::Slot)
+        || c_rowsOffset + (size_t)header->capacity * header->rowSize > (size_t)st.st_size)
+    {
+        log_error("Shared memory segment {} has version {} and rows of {} bytes. Expected {} and {}",
+                  name,
+                  header->version,
+                  header->rowSize,
+                  c_version,
+                  sizeof(DcgmLatestValueSlots::Slot));
+        return DCGM_ST_VER_MISMATCH;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (header->closed.load(std::memory_order_acquire) != 0)
+    {
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    values = std::move(reader);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+DcgmSharedLatestValues::Header *DcgmSharedLatestValues::GetHeader() const
+{
+    return static_cast<Header *>(m_mapping);
+}
+
+/*****************************************************************************/
+DcgmLatestValueSlots::Slot *DcgmSharedLatestValues::GetRows() const
+{
+    return reinterpret_cast<DcgmLatestValueSlots::Slot *>(static_cast<char *>(m_mapping) + c_rowsOffset);
+}
+
+/*****************************************************************************/
+unsigned int DcgmSharedLatestValues::Reserve(dcgm_entity_key_t const &watchKey)
+{
+    if (!m_isWriter)
+    {
+        return c_noRow;
+    }
+
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+
+    auto it = m_keyToRow.find(DcgmNs::PackEntityKey(watchKey));
+    if (it != m_keyToRow.end())
+    {
+        return it->second;
+    }
+
+    Header *header = GetHeader();
+    if (m_numIndexed >= header->capacity)
+    {
+        return c_noRow;
+    }
+
+    unsigned int const row = m_numIndexed++;
+    GetRows()[row].key     = watchKey;
+    header->numRows.store(m_numIndexed, std::memory_order_release);
+    m_keyToRow[DcgmNs::PackEntityKey(watchKey)] = row;
+    return row;
+}
+
+/*****************************************************************************/
+void DcgmSharedLatestValues::Publish(unsigned int row, dcgmcm_latest_value_t const &value)
+{
+    if (!m_isWriter || row >= GetHeader()->capacity)
+    {
+        return;
+    }
+
+    long long valueBits = value.val.i64;
+    if (value.tsType == TS_TYPE_DOUBLE)
+    {
+        memcpy(&valueBits, &value.val.d, sizeof(valueBits));
+    }
+
+    DcgmLatestValueSlots::WriteSlot(GetRows()[row], value.timestamp, value.tsType, valueBits);
+}
+
+/*****************************************************************************/
+void DcgmSharedLatestValues::Unpublish(unsigned int row)
+{
+    if (!m_isWriter || row >= GetHeader()->capacity)
+    {
+        return;
+    }
+
+    DcgmLatestValueSlots::WriteSlot(GetRows()[row], 0, 0, 0);
+}
+
+/*****************************************************************************/
+void DcgmSharedLatestValues::UnpublishAll()
+{
+    unsigned int const numRows = GetNumRows();
+
+    for (unsigned int row = 0; row < numRows; row++)
+    {
+        Unpublish(row);
+    }
+}
+
+/*****************************************************************************/
+unsigned int DcgmSharedLatestValues::Find(dcgm_entity_key_t const &watchKey)
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+
+    /* Index the rows the writer appended since the last call. Their keys were set before numRows was */
+    unsigned int const numRows             = GetNumRows();
+    DcgmLatestValueSlots::Slot const *rows = GetRows();
+    for (; m_numIndexed < numRows; m_numIndexed++)
+    {
+        m_keyToRow[DcgmNs::PackEntityKey(rows[m_numIndexed].key)] = m_numIndexed;
+    }
+
+    auto it = m_keyToRow.find(DcgmNs::PackEntityKey(watchKey));
+    if (it == m_keyToRow.end())
+    {
+        return c_noRow;
+    }
+
+    return it->second;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmSharedLatestValues::Read(unsigned int const rows[],
+                                          unsigned int count,
+                                          dcgmLatestValueSample_t samples[]) const
+{
+    if (GetHeader()->closed.load(std::memory_order_acquire) != 0)
+    {
+        return DCGM_ST_CONNECTION_NOT_VALID;
+    }
+
+    unsigned int const numRows = GetNumRows();
+    for (unsigned int i = 0; i < count; i++)
+    {
+        dcgmLatestValueSample_t &sample = samples[i];
+
+        memset(&sample, 0, sizeof(sample));
+
+        if (rows[i] >= numRows)
+        {
+            sample.status = DCGM_ST_BADPARAM;
+            continue;
+        }
+
+        if (!DcgmLatestValueSlots::ReadSlot(GetRows()[rows[i]], sample, c_maxReadAttempts))
+        {
+            sample.status = DCGM_ST_STALE_DATA;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+unsigned int DcgmSharedLatestValues::GetCapacity() const
+{
+    return GetHeader()->capacity;
+}
+
+/*****************************************************************************/
+unsigned int DcgmSharedLatestValues::GetNumRows() const
+{
+    return GetHeader()->numRows.load(std::memory_order_acquire);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmLatestValueCache.h"
+#include "DcgmLatestValueSlots.h"
+#include "dcgm_structs.h"
+
+#include <DcgmEntityKey.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/*****************************************************************************/
+/*
+ * Table of latest numeric values in a POSIX shared memory segment, so that
+ * local processes can read them without connecting to the host engine.
+ *
+ * The host engine creates the segment and is its only writer. Rows are
+ * appended per entity + field and never move. Each row is a
+ * DcgmLatestValueSlots::Slot, guarded by the same sequence lock, so readers
+ * never block the writer and never take a lock. Other processes map the
+ * segment read-only with Open().
+ *
+ * The segment is unlinked when the writer is destroyed, after marking it
+ * closed. Readers then get DCGM_ST_CONNECTION_NOT_VALID and should open it
+ * again once the host engine is back.
+ */
+class DcgmSharedLatestValues
+{
+public:
+    static constexpr unsigned int c_noRow           = DCGM_LATEST_VALUE_VIEW_NO_SLOT;
+    static constexpr unsigned int c_defaultCapacity = 16384;
+
+    /* Reads of a row that overlap this many writes in a row give up. Only happens if the writer died mid-write */
+    static constexpr unsigned int c_maxReadAttempts = 1000000;
+
+    ~DcgmSharedLatestValues();
+
+    DcgmSharedLatestValues(DcgmSharedLatestValues const &)            = delete;
+    DcgmSharedLatestValues &operator=(DcgmSharedLatestValues const &) = delete;
+
+    /*************************************************************************/
+    /*
+     * Create the segment name (like /nvidia-dcgm-latest-values) with room for capacity rows, replacing any
+     * segment left behind with that name. It is readable by every local user.
+     *
+     * RETURNS: DCGM_ST_OK on success. values is set to the writer of the segment
+     *          DCGM_ST_BADPARAM if name isn't a valid shared memory name
+     *          DCGM_ST_GENERIC_ERROR if the segment couldn't be created
+     */
+    static dcgmReturn_t Create(std::string const &name,
+                               unsigned int capacity,
+                               std::unique_ptr<DcgmSharedLatestValues> &values);
+
+    /*************************************************************************/
+    /*
+     * Map an existing segment read-only.
+     *
+     * RETURNS: DCGM_ST_OK on success. values is set to a reader of the segment
+     *          DCGM_ST_NO_DATA if there is no segment with that name
+     *          DCGM_ST_NO_PERMISSION if the segment can't be opened for reading
+     *          DCGM_ST_VER_MISMATCH if the segment was created by an incompatible writer
+     *          DCGM_ST_CONNECTION_NOT_VALID if the segment's writer has closed it
+     */
+    static dcgmReturn_t Open(std::string const &name, std::unique_ptr<DcgmSharedLatestValues> &values);
+
+    /*************************************************************************/
+    /*
+     * Writer only. Append the row of watchKey, returning its row if it has one already.
+     *
+     * RETURNS: Index of the row of watchKey
+     *          c_noRow if the segment is full
+     */
+    unsigned int Reserve(dcgm_entity_key_t const &watchKey);
+
+    /*************************************************************************/
+    /*
+     * Writer only. Write value into row or mark row as having no value
+     */
+    void Publish(unsigned int row, dcgmcm_latest_value_t const &value);
+    void Unpublish(unsigned int row);
+    void UnpublishAll();
+
+    /*************************************************************************/
+    /*
+     * RETURNS: Index of the row of watchKey. Picks up rows the writer appended since the last call
+     *          c_noRow if the writer hasn't added one
+     */
+    unsigned int Find(dcgm_entity_key_t const &watchKey);
+
+    /*************************************************************************/
+    /*
+     * Copy the values of rows[0..count-1] into samples[]. Safe to call from any thread at any time without locking.
+     * Invalid rows get status DCGM_ST_BADPARAM.
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_CONNECTION_NOT_VALID if the writer has closed the segment
+     */
+    dcgmReturn_t Read(unsigned int const rows[], unsigned int count, dcgmLatestValueSample_t samples[]) const;
+
+    /*************************************************************************/
+    unsigned int GetCapacity() const;
+    unsigned int GetNumRows() const;
+
+private:
+    /* Start of the segment. The rows follow at c_rowsOffset */
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t rowSize;              /* sizeof(DcgmLatestValueSlots::Slot) */
+        std::uint32_t capacity;             /* Rows the segment has room for */
+        std::atomic<std::uint32_t> numRows; /* Rows [0, numRows) have their key set */
+        std::atomic<std::uint32_t> closed;  /* 1 once the writer is gone */
+    };
+
+    static constexpr std::uint64_t c_magic   = 0x53564c4d47434400ULL; /* "\0DCGMLVS" */
+    static constexpr std::uint32_t c_version = 1;
+    static constexpr size_t c_rowsOffset     = 64;
+
+    static_assert(sizeof(Header) <= c_rowsOffset);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    DcgmSharedLatestValues(std::string name, void *mapping, size_t mappingSize, bool isWriter);
+
+    Header *GetHeader() const;
+    DcgmLatestValueSlots::Slot *GetRows() const;
+
+    std::string m_name;
+    void *m_mapping;
+    size_t m_mappingSize;
+    bool m_isWriter;
+
+    std::mutex m_indexMutex;         /* Protects the members below */
+    unsigned int m_numIndexed { 0 }; /* Rows [0, m_numIndexed) are in m_keyToRow */
+
+    /* Packed watch key -> row index */
+    std::unordered_map<DcgmNs::PackedEntityKey, unsigned int, DcgmNs::EntityKeyHash> m_keyToRow;
+};
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmStaticFieldCache.h"
+
+#include <cstring>
+
+/*****************************************************************************/
+bool DcgmStaticFieldCache::IsStaticField(unsigned short fieldId)
+{
+    switch (fieldId)
+    {
+        case DCGM_FI_DEV_NAME:
+        case DCGM_FI_DEV_BRAND:
+        case DCGM_FI_DEV_SERIAL:
+        case DCGM_FI_DEV_UUID:
+        case DCGM_FI_DEV_VBIOS_VERSION:
+        case DCGM_FI_DEV_INFOROM_IMAGE_VER:
+        case DCGM_FI_DEV_ECC_INFOROM_VER:
+        case DCGM_FI_DEV_POWER_INFOROM_VER:
+        case DCGM_FI_DEV_PCI_BUSID:
+        case DCGM_FI_DEV_PCI_COMBINED_ID:
+        case DCGM_FI_DEV_PCI_SUBSYS_ID:
+        case DCGM_FI_DEV_SUPPORTED_CLOCKS:
+        case DCGM_FI_DEV_SUPPORTED_TYPE_INFO:
+        case DCGM_FI_DEV_BAR1_TOTAL:
+        case DCGM_FI_DEV_FB_TOTAL:
+        case DCGM_FI_DEV_SLOWDOWN_TEMP:
+        case DCGM_FI_DEV_SHUTDOWN_TEMP:
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT_DEF:
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT_MAX:
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT_MIN:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************/
+bool DcgmStaticFieldCache::Get(unsigned int gpuId, unsigned short fieldId, DcgmFvBuffer &fvBuffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_values.find(DcgmNs::PackEntityKey(DCGM_FE_GPU, gpuId, fieldId));
+    if (it == m_values.end())
+    {
+        m_missCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_hitCount.fetch_add(1, std::memory_order_relaxed);
+    return fvBuffer.AddBufferedFv(reinterpret_cast<dcgmBufferedFv_t const *>(it->second->data())) != nullptr;
+}
+
+/*****************************************************************************/
+std::shared_ptr<dcgmBufferedFv_t const> DcgmStaticFieldCache::Get(unsigned int gpuId, unsigned short fieldId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_values.find(DcgmNs::PackEntityKey(DCGM_FE_GPU, gpuId, fieldId));
+    if (it == m_values.end())
+    {
+        m_missCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    m_hitCount.fetch_add(1, std::memory_order_relaxed);
+    return std::shared_ptr<dcgmBufferedFv_t const>(it->second,
+                                                   reinterpret_cast<dcgmBufferedFv_t const *>(it->second->data()));
+}
+
+/*****************************************************************************/
+void DcgmStaticFieldCache::Store(dcgmBufferedFv_t const &fv)
+{
+    if (fv.status != DCGM_ST_OK || fv.entityGroupId != DCGM_FE_GPU || !IsStaticField(fv.fieldId))
+    {
+        return;
+    }
+
+    switch (fv.fieldType)
+    {
+        case DCGM_FT_INT64:
+            if (DCGM_INT64_IS_BLANK(fv.value.i64))
+            {
+                return;
+            }
+            break;
+
+        case DCGM_FT_DOUBLE:
+            if (DCGM_FP64_IS_BLANK(fv.value.dbl))
+            {
+                return;
+            }
+            break;
+
+        case DCGM_FT_STRING:
+            if (DCGM_STR_IS_BLANK(fv.value.str))
+            {
+                return;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    auto copy = std::make_shared<std::vector<char>>(fv.length);
+    memcpy(copy->data(), &fv, fv.length);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_values[DcgmNs::PackEntityKey(DCGM_FE_GPU, fv.entityId, fv.fieldId)] = std::move(copy);
+}
+
+/*****************************************************************************/
+void DcgmStaticFieldCache::InvalidateGpu(unsigned int gpuId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_values.begin(); it != m_values.end();)
+    {
+        if ((dcgm_field_eid_t)it->first == gpuId)
+        {
+            it = m_values.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/*****************************************************************************/
+void DcgmStaticFieldCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_values.clear();
+}
+
+/*****************************************************************************/
+long long DcgmStaticFieldCache::GetHitCount() const
+{
+    return m_hitCount.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+long long DcgmStaticFieldCache::GetMissCount() const
+{
+    return m_missCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <DcgmEntityKey.h>
+#include <DcgmFvBuffer.h>
+#include <dcgm_fields.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Live values of GPU fields that don't change while the driver is loaded:
+ * names, UUIDs, serials, VBIOS and inforom versions, PCI IDs, supported
+ * clocks, memory totals, power limit bounds and temperature thresholds.
+ *
+ * dcgmGetDeviceAttributes() asks for these live on every call. The first
+ * successful read of each GPU's value is kept here and served to later live
+ * requests and watch updates instead of calling the driver again. The cache
+ * manager forgets a GPU's values when its MIG configuration or application
+ * clocks change and all values when it detaches from or re-attaches to the GPUs.
+ *
+ * All methods are thread safe.
+ */
+class DcgmStaticFieldCache
+{
+public:
+    /*************************************************************************/
+    /* Is fieldId's value fixed for as long as the driver is loaded? */
+    static bool IsStaticField(unsigned short fieldId);
+
+    /*************************************************************************/
+    /*
+     * Append the cached value of fieldId for gpuId to fvBuffer
+     *
+     * RETURNS: true if a value was cached and appended
+     *          false if there is no cached value
+     */
+    bool Get(unsigned int gpuId, unsigned short fieldId, DcgmFvBuffer &fvBuffer);
+
+    /*************************************************************************/
+    /*
+     * Get the cached value of fieldId for gpuId. The value is shared with the
+     * cache rather than copied and stays valid after it is invalidated
+     *
+     * RETURNS: The cached value. nullptr if there is no cached value
+     */
+    std::shared_ptr<dcgmBufferedFv_t const> Get(unsigned int gpuId, unsigned short fieldId);
+
+    /*************************************************************************/
+    /*
+     * Cache fv if it's a successfully read, non-blank value of a static field
+     * of a GPU. Other values are ignored
+     */
+    void Store(dcgmBufferedFv_t const &fv);
+
+    /*************************************************************************/
+    /* Forget the cached values of gpuId */
+    void InvalidateGpu(unsigned int gpuId);
+
+    /*************************************************************************/
+    /* Forget all cached values */
+    void InvalidateAll();
+
+    /*************************************************************************/
+    /* Statistics about the usage of this cache */
+    long long GetHitCount() const;
+    long long GetMissCount() const;
+
+private:
+    std::mutex m_mutex; /* Guards m_values */
+
+    /* Copies of the dcgmBufferedFv_t of each value, keyed by their packed DCGM_FE_GPU key */
+    std::unordered_map<DcgmNs::PackedEntityKey, std::shared_ptr<std::vector<char> const>, DcgmNs::EntityKeyHash>
+        m_values;
+
+    std::atomic_llong m_hitCount { 0 };
+    std::atomic_llong m_missCount { 0 };
+};
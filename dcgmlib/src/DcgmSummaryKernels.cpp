@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmSummaryKernels.h"
+
+#include <algorithm>
+#include <limits>
+
+/* Clone the kernels for wider vectors and pick one at load time through an ifunc */
+#if defined(__x86_64__) && defined(__linux__)
+#define DCGM_SUMMARY_TARGET_CLONES __attribute__((target_clones("default", "avx2", "avx512f")))
+#else
+#define DCGM_SUMMARY_TARGET_CLONES
+#endif
+
+namespace
+{
+/* Independent accumulators per reduction. Enough to fill an AVX-512 register of 64-bit values */
+constexpr size_t c_lanes = 8;
+
+template <typename T>
+inline bool IsValue(T value)
+{
+    return !(value >= DcgmSummaryBlank<T>());
+}
+
+/*****************************************************************************/
+template <typename T>
+[[gnu::always_inline]] inline void SummarizeValues(T const *values, size_t count, DcgmSummaryState<T> &state)
+{
+    T minLanes[c_lanes];
+    T maxLanes[c_lanes];
+    T sumLanes[c_lanes];
+    long long lastLanes[c_lanes]; /* 1 + index of the lane's last non-blank sample. 0 = none */
+
+    for (size_t k = 0; k < c_lanes; k++)
+    {
+        minLanes[k]  = DcgmSummaryBlank<T>();
+        maxLanes[k]  = std::numeric_limits<T>::lowest();
+        sumLanes[k]  = 0;
+        lastLanes[k] = 0;
+    }
+
+    /* Blank values are never below the minimum, which starts out blank, so only max needs the mask */
+    size_t i = 0;
+    for (; i + c_lanes <= count; i += c_lanes)
+    {
+        for (size_t k = 0; k < c_lanes; k++)
+        {
+            T const value      = values[i + k];
+            bool const isValue = IsValue(value);
+            minLanes[k]        = value < minLanes[k] ? value : minLanes[k];
+            maxLanes[k]        = (isValue && value > maxLanes[k]) ? value : maxLanes[k];
+            sumLanes[k] += isValue ? value : 0;
+            lastLanes[k] = isValue ? (long long)(i + k + 1) : lastLanes[k];
+        }
+    }
+    for (; i < count; i++)
+    {
+        T const value      = values[i];
+        bool const isValue = IsValue(value);
+        minLanes[0]        = value < minLanes[0] ? value : minLanes[0];
+        maxLanes[0]        = (isValue && value > maxLanes[0]) ? value : maxLanes[0];
+        sumLanes[0] += isValue ? value : 0;
+        lastLanes[0] = isValue ? (long long)(i + 1) : lastLanes[0];
+    }
+
+    T minValue         = minLanes[0];
+    T maxValue         = maxLanes[0];
+    T sumValue         = sumLanes[0];
+    long long lastSeen = lastLanes[0];
+    for (size_t k = 1; k < c_lanes; k++)
+    {
+        minValue = std::min(minValue, minLanes[k]);
+        maxValue = std::max(maxValue, maxLanes[k]);
+        sumValue += sumLanes[k];
+        lastSeen = std::max(lastSeen, lastLanes[k]);
+    }
+
+    if (lastSeen == 0)
+    {
+        return; /* All blank */
+    }
+
+    if (state.numSeenAtLastValue == 0)
+    {
+        state.firstValue = *std::find_if(values, values + count, IsValue<T>);
+        state.minValue   = minValue;
+        state.maxValue   = maxValue;
+    }
+    else
+    {
+        state.minValue = std::min(state.minValue, minValue);
+        state.maxValue = std::max(state.maxValue, maxValue);
+    }
+
+    state.sumValue += sumValue;
+    state.lastValue          = values[lastSeen - 1];
+    state.numSeenAtLastValue = state.numSeen + lastSeen;
+}
+
+/*****************************************************************************/
+template <typename T>
+[[gnu::always_inline]] inline T TrapezoidArea(T value, T prevValue, timelib64_t timestamp, timelib64_t prevTimestamp)
+{
+    return IsValue(value) ? ((value + prevValue) / (T)2) * (T)(timestamp - prevTimestamp) : 0;
+}
+
+/*****************************************************************************/
+template <typename T>
+[[gnu::always_inline]] inline void SummarizeIntegral(T const *values,
+                                                     timelib64_t const *timestamps,
+                                                     size_t count,
+                                                     DcgmSummaryState<T> &state)
+{
+    /* The first sample has no area. It starts the integral at 0 unless it's blank */
+    if (state.prevTimestamp == 0)
+    {
+        if (IsValue(values[0]))
+        {
+            state.integral = 0;
+        }
+    }
+    else
+    {
+        state.integral += TrapezoidArea(values[0], state.prevValue, timestamps[0], state.prevTimestamp);
+    }
+
+    T areaLanes[c_lanes] = {};
+
+    size_t i = 1;
+    for (; i + c_lanes <= count; i += c_lanes)
+    {
+        for (size_t k = 0; k < c_lanes; k++)
+        {
+            areaLanes[k]
+                += TrapezoidArea(values[i + k], values[i + k - 1], timestamps[i + k], timestamps[i + k - 1]);
+        }
+    }
+    for (; i < count; i++)
+    {
+        areaLanes[0] += TrapezoidArea(values[i], values[i - 1], timestamps[i], timestamps[i - 1]);
+    }
+
+    for (size_t k = 0; k < c_lanes; k++)
+    {
+        state.integral += areaLanes[k];
+    }
+}
+
+/*****************************************************************************/
+template <typename T>
+[[gnu::always_inline]] inline void SummarizeChunk(T const *values,
+                                                  timelib64_t const *timestamps,
+                                                  size_t count,
+                                                  bool wantIntegral,
+                                                  DcgmSummaryState<T> &state)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    SummarizeValues(values, count, state);
+
+    if (wantIntegral)
+    {
+        SummarizeIntegral(values, timestamps, count, state);
+    }
+
+    state.numSeen += count;
+    state.prevValue     = values[count - 1];
+    state.prevTimestamp = timestamps[count - 1];
+}
+} // namespace
+
+/*****************************************************************************/
+DCGM_SUMMARY_TARGET_CLONES
+void DcgmSummarizeChunk(long long const *values,
+                        timelib64_t const *timestamps,
+                        size_t count,
+                        bool wantIntegral,
+                        DcgmSummaryState<long long> &state)
+{
+    SummarizeChunk(values, timestamps, count, wantIntegral, state);
+}
+
+/*****************************************************************************/
+DCGM_SUMMARY_TARGET_CLONES
+void DcgmSummarizeChunk(double const *values,
+                        timelib64_t const *timestamps,
+                        size_t count,
+                        bool wantIntegral,
+                        DcgmSummaryState<double> &state)
+{
+    SummarizeChunk(values, timestamps, count, wantIntegral, state);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "dcgm_structs.h"
+#include "timelib.h"
+
+#include <cstddef>
+
+/*****************************************************************************/
+template <typename T>
+constexpr T DcgmSummaryBlank();
+
+template <>
+constexpr long long DcgmSummaryBlank<long long>()
+{
+    return DCGM_INT64_BLANK;
+}
+
+template <>
+constexpr double DcgmSummaryBlank<double>()
+{
+    return DCGM_FP64_BLANK;
+}
+
+/*****************************************************************************/
+/*
+ * Running summary of the samples of a time series, fed to DcgmSummarizeChunk()
+ * as contiguous arrays of values and timestamps in time order.
+ *
+ * Blank samples are counted in numSeen and otherwise skipped. The average and
+ * count are as of the last non-blank sample. The integral follows the
+ * trapezoid rule from the first sample, and stays blank if that one is blank.
+ */
+template <typename T>
+struct DcgmSummaryState
+{
+    long long numSeen            = 0; /* Samples seen, including blank ones */
+    long long numSeenAtLastValue = 0; /* numSeen as of the last non-blank sample. 0 = none yet */
+    T minValue                   = DcgmSummaryBlank<T>();
+    T maxValue                   = DcgmSummaryBlank<T>();
+    T sumValue                   = 0;
+    T firstValue                 = DcgmSummaryBlank<T>(); /* First non-blank sample */
+    T lastValue                  = DcgmSummaryBlank<T>(); /* Last non-blank sample */
+    T integral                   = DcgmSummaryBlank<T>(); /* Only kept if wantIntegral is passed */
+    T prevValue                  = 0;                     /* Last sample, blank or not */
+    timelib64_t prevTimestamp    = 0;
+};
+
+/*****************************************************************************/
+/*
+ * Add count samples to state.
+ *
+ * The reductions run in independent lanes that the compiler keeps in vector
+ * registers. On x86-64 the kernels are built for AVX2 and AVX-512 as well,
+ * and the best one for the CPU is picked when the library is loaded.
+ *
+ * Floating point sums are added up in lanes, so they may differ in the last
+ * bits from adding the samples up one by one.
+ */
+void DcgmSummarizeChunk(long long const *values,
+                        timelib64_t const *timestamps,
+                        size_t count,
+                        bool wantIntegral,
+                        DcgmSummaryState<long long> &state);
+
+void DcgmSummarizeChunk(double const *values,
+                        timelib64_t const *timestamps,
+                        size_t count,
+                        bool wantIntegral,
+                        DcgmSummaryState<double> &state);
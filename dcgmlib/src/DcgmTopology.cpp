@@ -21,10 +21,13 @@
 #include "dcgm_structs.h"
 #include "dcgm_structs_internal.h"
 
+#include <algorithm>
 #include <bitset>
 #include <condition_variable>
 #include <dcgm_nvml.h>
+#include <functional>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -209,43 +212,317 @@ unsigned int RecordBestPath(std::vector<unsigned int> &bestPath,
 
 /*****************************************************************************/
 void MatchByIO(std::vector<std::vector<unsigned int>> &affinityGroups,
-               dcgmTopology_t *topPtr,
+               dcgmTopology_t const *topPtr,
                std::vector<size_t> &potentialCpuMatches,
                uint32_t numGpus,
                uint64_t &outputGpus)
 {
-    float scores[DCGM_MAX_NUM_DEVICES] = { 0 };
-    std::vector<unsigned int> bestList[DCGM_MAX_NUM_DEVICES];
-
     // Clear the output
     outputGpus = 0;
 
     if (topPtr == NULL)
         return;
 
-    for (size_t matchIndex = 0; matchIndex < potentialCpuMatches.size(); matchIndex++)
+    DcgmLinkScores linkScores;
+    BuildLinkScores(topPtr, linkScores);
+    MatchByIO(affinityGroups, linkScores, potentialCpuMatches, numGpus, outputGpus);
+}
+
+/*****************************************************************************/
+void MatchByIO(std::vector<std::vector<unsigned int>> &affinityGroups,
+               DcgmLinkScores const &linkScores,
+               std::vector<size_t> &potentialCpuMatches,
+               uint32_t numGpus,
+               uint64_t &outputGpus)
+{
+    std::optional<DcgmGpuSetCandidate> best;
+
+    // Clear the output
+    outputGpus = 0;
+
+    for (size_t matchIndex : potentialCpuMatches)
     {
-        unsigned int highestScore;
-        std::map<unsigned int, std::vector<DcgmGpuConnectionPair>> connectionLevel;
-        highestScore = SetIOConnectionLevels(affinityGroups[potentialCpuMatches[matchIndex]], topPtr, connectionLevel);
+        std::uint64_t groupGpus = 0;
+        ConvertVectorToBitmask(affinityGroups[matchIndex], groupGpus, affinityGroups[matchIndex].size());
 
-        scores[matchIndex] = RecordBestPath(bestList[matchIndex], connectionLevel, numGpus, highestScore);
+        std::vector<DcgmGpuSetCandidate> sets = FindBestGpuSets(linkScores, groupGpus, numGpus, 1);
+
+        // Ties go to the first group
+        if (!sets.empty() && (!best.has_value() || sets[0].score > best->score))
+        {
+            best = sets[0];
+        }
+    }
+
+    if (best.has_value())
+    {
+        outputGpus = best->gpus;
+    }
+}
+
+/*****************************************************************************/
+void BuildLinkScores(dcgmTopology_t const *topPtr, DcgmLinkScores &linkScores)
+{
+    for (auto &row : linkScores)
+    {
+        row.fill(0);
+    }
+
+    for (unsigned int elementIndex = 0; elementIndex < topPtr->numElements; elementIndex++)
+    {
+        unsigned int gpuA = topPtr->element[elementIndex].dcgmGpuA;
+        unsigned int gpuB = topPtr->element[elementIndex].dcgmGpuB;
+
+        if (gpuA >= DCGM_MAX_NUM_DEVICES || gpuB >= DCGM_MAX_NUM_DEVICES)
+        {
+            continue;
+        }
+
+        unsigned int score     = NvLinkScore(DCGM_TOPOLOGY_PATH_NVLINK(topPtr->element[elementIndex].path));
+        linkScores[gpuA][gpuB] = score;
+        linkScores[gpuB][gpuA] = score;
+    }
+}
+
+namespace
+{
+/*
+ * State of one FindBestGpuSets call. Sets are grown one GPU at a time in the order of gpuIds, so every set is
+ * visited once
+ */
+class GpuSetSearch
+{
+public:
+    GpuSetSearch(DcgmLinkScores const &linkScores,
+                 std::vector<unsigned int> gpuIds,
+                 unsigned int numGpus,
+                 unsigned int maxResults)
+        : m_linkScores(linkScores)
+        , m_gpuIds(std::move(gpuIds))
+        , m_numGpus(numGpus)
+        , m_maxResults(maxResults)
+    {
+        for (size_t i = 0; i < m_gpuIds.size(); i++)
+        {
+            for (size_t j = i + 1; j < m_gpuIds.size(); j++)
+            {
+                m_maxLinkScore = std::max(m_maxLinkScore, m_linkScores[m_gpuIds[i]][m_gpuIds[j]]);
+            }
+        }
+    }
+
+    std::vector<DcgmGpuSetCandidate> Run()
+    {
+        /* The greedy pick is usually good, which lets the bound cut most of the search right away */
+        if (auto greedy = GreedySet(); greedy.has_value())
+        {
+            Keep(*greedy);
+        }
+
+        std::array<unsigned int, DCGM_MAX_NUM_DEVICES> gainToChosen {};
+        Search(0, 0, 0, 0, gainToChosen);
+
+        return std::move(m_results);
+    }
+
+private:
+    DcgmLinkScores const &m_linkScores;
+    std::vector<unsigned int> const m_gpuIds;
+    unsigned int const m_numGpus;
+    unsigned int const m_maxResults;
+    unsigned int m_maxLinkScore = 0;
+    std::vector<DcgmGpuSetCandidate> m_results; /* Best first */
+
+    unsigned int ScoreOf(std::uint64_t gpus) const
+    {
+        unsigned int score = 0;
+        for (size_t i = 0; i < m_gpuIds.size(); i++)
+        {
+            for (size_t j = i + 1; j < m_gpuIds.size(); j++)
+            {
+                if ((gpus >> m_gpuIds[i] & 1) && (gpus >> m_gpuIds[j] & 1))
+                {
+                    score += m_linkScores[m_gpuIds[i]][m_gpuIds[j]];
+                }
+            }
+        }
+        return score;
+    }
+
+    /* What RecordBestPath picks: GPUs in the order they appear in the strongest links */
+    std::optional<DcgmGpuSetCandidate> GreedySet() const
+    {
+        std::uint64_t gpus = 0;
+        unsigned int count = 0;
+
+        for (unsigned int level = m_maxLinkScore; level > 0 && count < m_numGpus; level--)
+        {
+            for (size_t i = 0; i < m_gpuIds.size() && count < m_numGpus; i++)
+            {
+                for (size_t j = i + 1; j < m_gpuIds.size() && count < m_numGpus; j++)
+                {
+                    if (m_linkScores[m_gpuIds[i]][m_gpuIds[j]] != level)
+                    {
+                        continue;
+                    }
+
+                    for (unsigned int gpuId : { m_gpuIds[i], m_gpuIds[j] })
+                    {
+                        if (count < m_numGpus && !(gpus >> gpuId & 1))
+                        {
+                            gpus |= std::uint64_t { 1 } << gpuId;
+                            count++;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (count != m_numGpus)
+        {
+            return std::nullopt;
+        }
+
+        return DcgmGpuSetCandidate { gpus, ScoreOf(gpus) };
+    }
+
+    bool IsFull() const
+    {
+        return m_results.size() >= m_maxResults;
+    }
+
+    void Keep(DcgmGpuSetCandidate const &candidate)
+    {
+        for (auto const &result : m_results)
+        {
+            if (result.gpus == candidate.gpus)
+            {
+                return;
+            }
+        }
+
+        /* After the ones with the same score, which were found first */
+        auto it = std::upper_bound(
+            m_results.begin(), m_results.end(), candidate, [](auto const &a, auto const &b) { return a.score > b.score; });
+        m_results.insert(it, candidate);
+
+        if (m_results.size() > m_maxResults)
+        {
+            m_results.pop_back();
+        }
+    }
+
+    /*
+     * The most a set that has chosen and count GPUs, and adds GPUs from m_gpuIds[next...], can score.
+     * gainToChosen[i] is the sum of the link scores between m_gpuIds[i] and the chosen GPUs
+     */
+    unsigned int UpperBound(size_t next,
+                            unsigned int count,
+                            unsigned int score,
+                            std::array<unsigned int, DCGM_MAX_NUM_DEVICES> const &gainToChosen) const
+    {
+        unsigned int const remaining = m_numGpus - count;
+
+        std::array<unsigned int, DCGM_MAX_NUM_DEVICES> gains;
+        size_t numGains = 0;
+        for (size_t i = next; i < m_gpuIds.size(); i++)
+        {
+            gains[numGains++] = gainToChosen[i];
+        }
+
+        if (numGains < remaining)
+        {
+            /* Not enough GPUs left to complete a set */
+            return 0;
+        }
+
+        std::partial_sort(gains.begin(), gains.begin() + remaining, gains.begin() + numGains, std::greater<>());
+        for (unsigned int i = 0; i < remaining; i++)
+        {
+            score += gains[i];
+        }
+
+        /* Links among the GPUs still to be added */
+        return score + remaining * (remaining - 1) / 2 * m_maxLinkScore;
+    }
+
+    void Search(size_t next,
+                std::uint64_t chosen,
+                unsigned int count,
+                unsigned int score,
+                std::array<unsigned int, DCGM_MAX_NUM_DEVICES> &gainToChosen)
+    {
+        if (count == m_numGpus)
+        {
+            if (!IsFull() || score > m_results.back().score)
+            {
+                Keep({ chosen, score });
+            }
+            return;
+        }
+
+        if (m_gpuIds.size() - next < m_numGpus - count)
+        {
+            return;
+        }
+
+        if (IsFull() && UpperBound(next, count, score, gainToChosen) <= m_results.back().score)
+        {
+            return;
+        }
+
+        for (size_t i = next; i + (m_numGpus - count) <= m_gpuIds.size(); i++)
+        {
+            unsigned int const gpuId = m_gpuIds[i];
+
+            for (size_t j = i + 1; j < m_gpuIds.size(); j++)
+            {
+                gainToChosen[j] += m_linkScores[gpuId][m_gpuIds[j]];
+            }
+
+            Search(i + 1, chosen | std::uint64_t { 1 } << gpuId, count + 1, score + gainToChosen[i], gainToChosen);
+
+            for (size_t j = i + 1; j < m_gpuIds.size(); j++)
+            {
+                gainToChosen[j] -= m_linkScores[gpuId][m_gpuIds[j]];
+            }
+
+            if (IsFull() && UpperBound(i + 1, count, score, gainToChosen) <= m_results.back().score)
+            {
+                /* Nothing that skips m_gpuIds[i] as well can do better */
+                return;
+            }
+        }
+    }
+};
+} // namespace
+
+/*****************************************************************************/
+std::vector<DcgmGpuSetCandidate> FindBestGpuSets(DcgmLinkScores const &linkScores,
+                                                 std::uint64_t candidateGpus,
+                                                 unsigned int numGpus,
+                                                 unsigned int maxResults)
+{
+    std::vector<unsigned int> gpuIds;
+    for (unsigned int gpuId = 0; gpuId < DCGM_MAX_NUM_DEVICES; gpuId++)
+    {
+        if (candidateGpus >> gpuId & 1)
+        {
+            gpuIds.push_back(gpuId);
+        }
     }
 
-    // Choose the level with the highest score and mark it's best path
-    int bestScoreIndex = 0;
-    for (int i = 1; i < DCGM_MAX_NUM_DEVICES; i++)
+    if (numGpus == 0 || maxResults == 0 || gpuIds.size() < numGpus)
     {
-        if (scores[i] > scores[bestScoreIndex])
-            bestScoreIndex = i;
+        return {};
     }
 
-    ConvertVectorToBitmask(bestList[bestScoreIndex], outputGpus, numGpus);
+    return GpuSetSearch(linkScores, std::move(gpuIds), numGpus, maxResults).Run();
 }
 
 /*****************************************************************************/
 unsigned int SetIOConnectionLevels(std::vector<unsigned int> &affinityGroup,
-                                   dcgmTopology_t *topPtr,
+                                   dcgmTopology_t const *topPtr,
                                    std::map<unsigned int, std::vector<DcgmGpuConnectionPair>> &connectionLevel)
 
 {
@@ -404,7 +681,7 @@ dcgmReturn_t HelperSelectGpusByTopology(std::vector<unsigned int> &gpuIds,
                                         uint32_t numGpus,
                                         uint64_t &outputGpus,
                                         dcgmAffinity_t &affinity,
-                                        dcgmTopology_t *topology)
+                                        DcgmLinkScores const *linkScores)
 {
     dcgmReturn_t ret = DCGM_ST_OK;
 
@@ -431,10 +708,9 @@ dcgmReturn_t HelperSelectGpusByTopology(std::vector<unsigned int> &gpuIds,
     {
         // Find best interconnect within or among the matches.
 
-        if (topology != NULL)
+        if (linkScores != nullptr)
         {
-            MatchByIO(affinityGroups, topology, potentialCpuMatches, numGpus, outputGpus);
-            free(topology);
+            MatchByIO(affinityGroups, *linkScores, potentialCpuMatches, numGpus, outputGpus);
         }
         else
         {
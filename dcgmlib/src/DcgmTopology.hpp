@@ -19,6 +19,9 @@
 #include "dcgm_structs.h"
 #include "dcgm_structs_internal.h"
 
+#include <array>
+#include <cstdint>
+#include <cstdlib>
 #include <map>
 #include <memory>
 #include <vector>
@@ -65,6 +68,33 @@ typedef struct
 
 } dcgm_topology_helper_t;
 
+/* NvLinkScore() of the path between each pair of GPUs, indexed by gpuId. 0 if they are not connected by NvLink */
+using DcgmLinkScores = std::array<std::array<unsigned int, DCGM_MAX_NUM_DEVICES>, DCGM_MAX_NUM_DEVICES>;
+
+/* A set of GPUs considered by FindBestGpuSets */
+struct DcgmGpuSetCandidate
+{
+    std::uint64_t gpus; /* Bit N is set for gpuId N */
+    unsigned int score; /* Sum of the link scores of every pair of GPUs in the set */
+};
+
+/*
+ * CPU affinity and NvLink topology of all GPUs as of one point in time. A snapshot is never modified once it is
+ * published, so readers can keep using one after a newer one replaced it.
+ */
+struct DcgmTopologySnapshot
+{
+    std::uint64_t generation = 0; /* Which invalidation of the topology this was built after */
+
+    dcgmReturn_t affinityRet = DCGM_ST_OK; /* Return of PopulateTopologyAffinity */
+    dcgmAffinity_t affinity {};
+
+    dcgmReturn_t nvLinkRet = DCGM_ST_OK; /* Return of PopulateTopologyNvLink */
+    std::unique_ptr<dcgmTopology_t, decltype(&free)> nvLink { nullptr, &free }; /* nullptr if nvLinkRet != OK */
+    unsigned int nvLinkSize = 0;                                                  /* Size of *nvLink in bytes */
+    DcgmLinkScores linkScores {};                                                 /* From nvLink. All 0 without it */
+};
+
 
 /*************************************************************************/
 /*
@@ -119,18 +149,47 @@ unsigned int RecordBestPath(std::vector<unsigned int> &bestPath,
  * on CPU affinity.
  */
 void MatchByIO(std::vector<std::vector<unsigned int>> &affinityGroups,
-               dcgmTopology_t *topPtr,
+               dcgmTopology_t const *topPtr,
+               std::vector<size_t> &potentialCpuMatches,
+               uint32_t numGpus,
+               uint64_t &outputGpus);
+
+void MatchByIO(std::vector<std::vector<unsigned int>> &affinityGroups,
+               DcgmLinkScores const &linkScores,
                std::vector<size_t> &potentialCpuMatches,
                uint32_t numGpus,
                uint64_t &outputGpus);
 
+/*************************************************************************/
+/*
+ * Fill linkScores with the NvLinkScore of every pair of GPUs in topPtr
+ */
+void BuildLinkScores(dcgmTopology_t const *topPtr, DcgmLinkScores &linkScores);
+
+/*************************************************************************/
+/*
+ * Return up to maxResults sets of numGpus GPUs out of candidateGpus (bit N for gpuId N) with the highest scores,
+ * best first. Sets with the same score are in the order RecordBestPath and then a lowest-gpuId-first search
+ * reach them.
+ *
+ * The search walks the sets by branch and bound, starting from the set the greedy RecordBestPath picks, and skips
+ * every branch that cannot beat the worst result kept so far. A full mesh of equal links is therefore answered
+ * after the first maxResults sets.
+ *
+ * Returns an empty vector if candidateGpus has fewer than numGpus GPUs or numGpus is 0
+ */
+std::vector<DcgmGpuSetCandidate> FindBestGpuSets(DcgmLinkScores const &linkScores,
+                                                 std::uint64_t candidateGpus,
+                                                 unsigned int numGpus,
+                                                 unsigned int maxResults);
+
 /*************************************************************************/
 /*
  * Record the number of connections this topology has between GPUs at each level, 0-3.
  * 0 is the fastest and 3 is the slowest.
  */
 unsigned int SetIOConnectionLevels(std::vector<unsigned int> &affinityGroup,
-                                   dcgmTopology_t *topPtr,
+                                   dcgmTopology_t const *topPtr,
                                    std::map<unsigned int, std::vector<DcgmGpuConnectionPair>> &connectionLevel);
 
 /*************************************************************************/
@@ -155,11 +214,14 @@ bool HasStrongConnection(std::vector<DcgmGpuConnectionPair> &connections, uint32
 dcgmReturn_t PopulateTopologyAffinity(const std::vector<dcgm_topology_helper_t> &gpuInfo, dcgmAffinity_t &affinity);
 
 /*****************************************************************************/
+/*
+ * linkScores may be nullptr if the NvLink topology is unknown
+ */
 dcgmReturn_t HelperSelectGpusByTopology(std::vector<unsigned int> &gpuIds,
                                         uint32_t numGpus,
                                         uint64_t &outputGpus,
                                         dcgmAffinity_t &affinity,
-                                        dcgmTopology_t *topology);
+                                        DcgmLinkScores const *linkScores);
 
 /*************************************************************************/
 /*
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmValuesCursors.h"
+
+#include <DcgmLogging.h>
+
+#include <iterator>
+
+/*****************************************************************************/
+dcgmReturn_t DcgmValuesCursors::Open(dcgm_connection_id_t connectionId,
+                                     std::vector<dcgm_entity_key_t> keys,
+                                     timelib64_t sinceTs,
+                                     timelib64_t endTs,
+                                     unsigned int &cursorId)
+{
+    auto cursor      = std::make_shared<Cursor>();
+    cursor->keys     = std::move(keys);
+    cursor->sinceTs  = sinceTs;
+    cursor->endTs    = endTs;
+    cursor->resumeTs = sinceTs;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto first = m_cursors.lower_bound({ connectionId, 0 });
+    auto last  = m_cursors.upper_bound({ connectionId, UINT_MAX });
+    if (std::distance(first, last) >= (long)c_maxCursorsPerConnection)
+    {
+        log_error("connectionId {} already has {} cursors open", connectionId, c_maxCursorsPerConnection);
+        return DCGM_ST_MAX_LIMIT;
+    }
+
+    cursorId = m_nextCursorId++;
+    if (m_nextCursorId == 0)
+    {
+        m_nextCursorId = 1;
+    }
+
+    m_cursors[{ connectionId, cursorId }] = std::move(cursor);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+std::shared_ptr<DcgmValuesCursors::Cursor> DcgmValuesCursors::Find(dcgm_connection_id_t connectionId,
+                                                                  unsigned int cursorId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_cursors.find({ connectionId, cursorId });
+    if (it == m_cursors.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmValuesCursors::Next(dcgm_connection_id_t connectionId,
+                                     unsigned int cursorId,
+                                     Reader const &reader,
+                                     size_t maxBytes,
+                                     dcgm_values_cursor_chunk_t &chunk)
+{
+    /* Closing the cursor meanwhile only drops it from m_cursors. This keeps it alive until the chunk is read */
+    std::shared_ptr<Cursor> cursor = Find(connectionId, cursorId);
+    if (cursor == nullptr)
+    {
+        log_debug("connectionId {} has no cursor {}", connectionId, cursorId);
+        return DCGM_ST_BADPARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(cursor->mutex);
+
+    chunk.fvBytes.clear();
+    chunk.done               = false;
+    chunk.nextSinceTimestamp = 0;
+
+    while (cursor->keyIndex < cursor->keys.size())
+    {
+        dcgm_entity_key_t const &key = cursor->keys[cursor->keyIndex];
+
+        /* The values at resumeTs that were returned already come first. Read past them */
+        int const requested = c_valuesPerRead + (int)cursor->resumeSeq;
+        int count           = requested;
+        DcgmFvBuffer fvBuffer(0);
+
+        dcgmReturn_t dcgmReturn = reader(key, &count, cursor->resumeTs, cursor->endTs, fvBuffer);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            /* No data, not watched and so on all mean there is nothing (left) to return for this key */
+            log_debug("Got {} reading eg {} eid {} fieldId {}. Moving on to the next key",
+                      (int)dcgmReturn,
+                      key.entityGroupId,
+                      key.entityId,
+                      key.fieldId);
+            count = 0;
+        }
+
+        timelib64_t const readFromTs = cursor->resumeTs;
+        unsigned int alreadyReturned = cursor->resumeSeq;
+
+        dcgmBufferedFvCursor_t fvCursor = 0;
+        for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&fvCursor); fv; fv = fvBuffer.GetNextFv(&fvCursor))
+        {
+            if (alreadyReturned > 0 && fv->timestamp == readFromTs)
+            {
+                alreadyReturned--;
+                continue;
+            }
+
+            if (!chunk.fvBytes.empty() && chunk.fvBytes.size() + fv->length > maxBytes)
+            {
+                /* Full. The position is just past the last value that fit */
+                return DCGM_ST_OK;
+            }
+
+            /* Buffered FVs are self-describing, so copying them verbatim produces a valid serialized DcgmFvBuffer */
+            chunk.fvBytes.insert(chunk.fvBytes.end(), (char *)fv, (char *)fv + fv->length);
+
+            if (fv->timestamp == cursor->resumeTs)
+            {
+                cursor->resumeSeq++;
+            }
+            else
+            {
+                cursor->resumeTs  = fv->timestamp;
+                cursor->resumeSeq = 1;
+            }
+        }
+
+        if (count < requested)
+        {
+            /* Read everything this key has */
+            cursor->keyIndex++;
+            cursor->resumeTs  = cursor->sinceTs;
+            cursor->resumeSeq = 0;
+        }
+    }
+
+    chunk.done               = true;
+    chunk.nextSinceTimestamp = cursor->endTs + 1;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmValuesCursors::Close(dcgm_connection_id_t connectionId, unsigned int cursorId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_cursors.erase({ connectionId, cursorId }) == 0)
+    {
+        log_debug("connectionId {} has no cursor {}", connectionId, cursorId);
+        return DCGM_ST_BADPARAM;
+    }
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmValuesCursors::RemoveConnection(dcgm_connection_id_t connectionId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_cursors.erase(m_cursors.lower_bound({ connectionId, 0 }), m_cursors.upper_bound({ connectionId, UINT_MAX }));
+}
+
+/*****************************************************************************/
+unsigned int DcgmValuesCursors::GetCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (unsigned int)m_cursors.size();
+}
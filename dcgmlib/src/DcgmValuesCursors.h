@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmFvBuffer.h"
+#include "DcgmWatchTable.h"
+#include "dcgm_structs.h"
+#include "dcgm_structs_internal.h"
+#include "timelib.h"
+
+#include <climits>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*****************************************************************************/
+/* One chunk of a cursor's values */
+struct dcgm_values_cursor_chunk_t
+{
+    std::vector<char> fvBytes;              /* Serialized DcgmFvBuffer. Pass to DcgmFvBuffer::SetFromBuffer() */
+    bool done                      = false; /* Was this the cursor's last chunk? */
+    timelib64_t nextSinceTimestamp = 0;     /* Once done, the sinceTimestamp that continues where the cursor ended */
+};
+
+/*****************************************************************************/
+/*
+ * Table of client cursors over the cached values of (group, fieldGroup)s
+ * since a timestamp.
+ *
+ * A cursor walks its entity + field keys one at a time, each in ascending
+ * timestamp order, and hands out the values in chunks of bounded size. It
+ * only remembers where it stopped: the key, the last timestamp it returned
+ * and how many values with that timestamp it returned. Reading the next
+ * chunk looks that position up again, so nothing is held between chunks and
+ * a long history is never copied at once.
+ */
+class DcgmValuesCursors
+{
+public:
+    /*
+     * Reads up to *count values of key with timestamps in [startTs, endTs] in ascending order into fvBuffer, and
+     * sets *count to how many it read. Same contract as DcgmCacheManager::GetSamples()
+     */
+    using Reader = std::function<dcgmReturn_t(dcgm_entity_key_t const &key,
+                                              int *count,
+                                              timelib64_t startTs,
+                                              timelib64_t endTs,
+                                              DcgmFvBuffer &fvBuffer)>;
+
+    /* Cursors one connection can have open at once */
+    static constexpr unsigned int c_maxCursorsPerConnection = 16;
+
+    /* Values read from the cache at a time. This bounds how long each read holds the cache manager lock */
+    static constexpr int c_valuesPerRead = 1024;
+
+    /*************************************************************************/
+    /*
+     * Open a cursor of connectionId over the values of keys with timestamps from sinceTs through endTs.
+     *
+     * RETURNS: DCGM_ST_OK on success. cursorId is set to the new cursor
+     *          DCGM_ST_MAX_LIMIT if connectionId has c_maxCursorsPerConnection cursors open already
+     */
+    dcgmReturn_t Open(dcgm_connection_id_t connectionId,
+                      std::vector<dcgm_entity_key_t> keys,
+                      timelib64_t sinceTs,
+                      timelib64_t endTs,
+                      unsigned int &cursorId);
+
+    /*************************************************************************/
+    /*
+     * Read the next values of cursorId with reader into chunk. Values are added until the next one would make
+     * chunk.fvBytes larger than maxBytes. At least one value is added if any are left.
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_BADPARAM if connectionId has no such cursor
+     */
+    dcgmReturn_t Next(dcgm_connection_id_t connectionId,
+                      unsigned int cursorId,
+                      Reader const &reader,
+                      size_t maxBytes,
+                      dcgm_values_cursor_chunk_t &chunk);
+
+    /*************************************************************************/
+    /*
+     * Close cursorId of connectionId.
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_BADPARAM if connectionId has no such cursor
+     */
+    dcgmReturn_t Close(dcgm_connection_id_t connectionId, unsigned int cursorId);
+
+    /*************************************************************************/
+    /*
+     * Close all cursors of connectionId. Used when the connection goes away
+     */
+    void RemoveConnection(dcgm_connection_id_t connectionId);
+
+    /*************************************************************************/
+    /* Number of open cursors */
+    unsigned int GetCount() const;
+
+private:
+    struct Cursor
+    {
+        std::mutex mutex; /* Protects the position below. Held while a chunk is read */
+        std::vector<dcgm_entity_key_t> keys;
+        timelib64_t sinceTs    = 0;
+        timelib64_t endTs      = 0;
+        size_t keyIndex        = 0; /* Key that is being read */
+        timelib64_t resumeTs   = 0; /* Timestamp to read keys[keyIndex] from */
+        unsigned int resumeSeq = 0; /* Values at resumeTs that were returned already */
+    };
+
+    using CursorKey = std::pair<dcgm_connection_id_t, unsigned int>;
+
+    /*************************************************************************/
+    std::shared_ptr<Cursor> Find(dcgm_connection_id_t connectionId, unsigned int cursorId) const;
+
+    mutable std::mutex m_mutex; /* Protects the members below, not the cursors themselves */
+    std::map<CursorKey, std::shared_ptr<Cursor>> m_cursors;
+    unsigned int m_nextCursorId = 1;
+};
@@ -243,7 +243,7 @@ dcgmReturn_t BufferOrCacheLatestVgpuValue(DcgmCacheManager &cm,
 
     dcgmcm_watch_info_p watchInfo = threadCtx->watchInfo;
 
-    now = timelib_usecSince1970();
+    now = threadCtx->clock.Now();
 
     /* Expiration is either measured in absolute time or 0 */
     expireTime = 0;
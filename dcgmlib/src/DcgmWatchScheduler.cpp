@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmWatchScheduler.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+bool DcgmWatchScheduler::IsLater(Entry const &a, Entry const &b)
+{
+    if (a.dueUsec != b.dueUsec)
+    {
+        return a.dueUsec > b.dueUsec;
+    }
+
+    return a.sequence > b.sequence;
+}
+
+/*****************************************************************************/
+void DcgmWatchScheduler::Clear()
+{
+    m_heap.clear();
+    m_nextSequence = 0;
+}
+
+/*****************************************************************************/
+void DcgmWatchScheduler::Schedule(timelib64_t dueUsec, dcgmcm_watch_info_t *watchInfo)
+{
+    m_heap.push_back({ dueUsec, m_nextSequence++, watchInfo });
+    std::push_heap(m_heap.begin(), m_heap.end(), IsLater);
+}
+
+/*****************************************************************************/
+void DcgmWatchScheduler::PopDue(timelib64_t deadlineUsec, std::vector<dcgmcm_watch_info_t *> &dueWatches)
+{
+    while (!m_heap.empty() && m_heap.front().dueUsec <= deadlineUsec)
+    {
+        dueWatches.push_back(m_heap.front().watchInfo);
+        std::pop_heap(m_heap.begin(), m_heap.end(), IsLater);
+        m_heap.pop_back();
+    }
+}
+
+/*****************************************************************************/
+timelib64_t DcgmWatchScheduler::GetEarliestDue() const
+{
+    if (m_heap.empty())
+    {
+        return 0;
+    }
+
+    return m_heap.front().dueUsec;
+}
+
+/*****************************************************************************/
+std::size_t DcgmWatchScheduler::GetSize() const
+{
+    return m_heap.size();
+}
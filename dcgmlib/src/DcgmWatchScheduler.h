@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "timelib.h"
+
+#include <cstddef>
+#include <vector>
+
+struct dcgmcm_watch_info_t;
+
+/*****************************************************************************/
+/*
+ * Min-heap of watches keyed by the time each is next due for an update.
+ *
+ * This lets the cache manager update loop touch only the watches that are due
+ * instead of walking the whole watch table every cycle. It is not thread safe.
+ * The cache manager protects it with its own lock.
+ */
+class DcgmWatchScheduler
+{
+public:
+    /*************************************************************************/
+    /*
+     * Forget all scheduled watches
+     */
+    void Clear();
+
+    /*************************************************************************/
+    /*
+     * Schedule watchInfo to be due at dueUsec. A watch scheduled more than once
+     * will be returned once per Schedule() call
+     */
+    void Schedule(timelib64_t dueUsec, dcgmcm_watch_info_t *watchInfo);
+
+    /*************************************************************************/
+    /*
+     * Remove every watch due at or before deadlineUsec, appending them to
+     * dueWatches in due order
+     */
+    void PopDue(timelib64_t deadlineUsec, std::vector<dcgmcm_watch_info_t *> &dueWatches);
+
+    /*************************************************************************/
+    /*
+     * Returns: The due time of the earliest scheduled watch
+     *          0 if nothing is scheduled
+     */
+    timelib64_t GetEarliestDue() const;
+
+    /*************************************************************************/
+    std::size_t GetSize() const;
+
+private:
+    struct Entry
+    {
+        timelib64_t dueUsec;
+        unsigned long long sequence; /* Keeps watches that are due at the same time in FIFO order */
+        dcgmcm_watch_info_t *watchInfo;
+    };
+
+    /*************************************************************************/
+    /* Comparator for std::push_heap and friends that puts the earliest entry on top */
+    static bool IsLater(Entry const &a, Entry const &b);
+
+    std::vector<Entry> m_heap;
+    unsigned long long m_nextSequence = 0;
+};
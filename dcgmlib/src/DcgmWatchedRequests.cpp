@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmWatchedRequests.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <vector>
+
+/*****************************************************************************/
+DcgmWatchedRequests::DcgmWatchedRequests()
+    : m_nextRequestId(1)
+{}
+
+/*****************************************************************************/
+void DcgmWatchedRequests::EnableProfiling(char const *name)
+{
+    m_lock.EnableProfiling(name);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmWatchedRequests::Add(std::unique_ptr<DcgmRequest> request, dcgm_request_id_t &requestId)
+{
+    if (request == nullptr)
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    DcgmLockGuard lg(&m_lock);
+
+    m_nextRequestId++;
+
+    /* Search for a nonzero, unused request ID. This should only take more than one
+       loop if we've served more than 4 billion requests */
+    while (m_nextRequestId == DCGM_REQUEST_ID_NONE || m_requests.contains(m_nextRequestId))
+    {
+        m_nextRequestId++;
+    }
+
+    request->SetRequestId(m_nextRequestId);
+    requestId = m_nextRequestId;
+
+    /* Log while we still have the lock */
+    log_debug("Assigned requestId {} to request {}", requestId, (void *)request.get());
+
+    m_requests[requestId] = std::make_shared<Entry>(Entry { std::move(request) });
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+namespace
+{
+/* Entries whose messages are being delivered by this thread, innermost last */
+thread_local std::vector<void const *> t_delivering;
+} // namespace
+
+/*****************************************************************************/
+void DcgmWatchedRequests::WaitForDeliveries(Entry const &entry)
+{
+    auto const ownDeliveries = std::count(t_delivering.begin(), t_delivering.end(), &entry);
+
+    while (m_lock.CondWait(m_delivered, 0, [&] { return entry.inFlight <= ownDeliveries; }) != DCGM_MUTEX_ST_OK)
+    {
+        log_debug("Still waiting for {} deliveries to request {}", entry.inFlight, (void *)entry.request.get());
+    }
+}
+
+/*****************************************************************************/
+bool DcgmWatchedRequests::Remove(dcgm_request_id_t requestId)
+{
+    std::shared_ptr<Entry> removed;
+
+    {
+        DcgmLockGuard lg(&m_lock);
+
+        auto it = m_requests.find(requestId);
+        if (it == m_requests.end())
+        {
+            return false;
+        }
+        removed = std::move(it->second);
+        m_requests.erase(it);
+
+        WaitForDeliveries(*removed);
+    }
+
+    /* Destroy the request outside of the lock, in case its destructor calls back into us */
+    removed.reset();
+    return true;
+}
+
+/*****************************************************************************/
+void DcgmWatchedRequests::Clear()
+{
+    std::unordered_map<dcgm_request_id_t, std::shared_ptr<Entry>> removed;
+
+    {
+        DcgmLockGuard lg(&m_lock);
+        removed.swap(m_requests);
+
+        for (auto const &[requestId, entry] : removed)
+        {
+            WaitForDeliveries(*entry);
+        }
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmWatchedRequests::Deliver(dcgm_request_id_t requestId, std::unique_ptr<DcgmMessage> msg)
+{
+    std::shared_ptr<Entry> entry;
+
+    {
+        DcgmLockGuard lg(&m_lock);
+
+        auto it = m_requests.find(requestId);
+        if (it == m_requests.end())
+        {
+            return DCGM_ST_BADPARAM;
+        }
+        entry = it->second;
+        entry->inFlight++;
+    }
+
+    t_delivering.push_back(entry.get());
+    entry->request->ProcessMessage(std::move(msg));
+    t_delivering.pop_back();
+
+    {
+        DcgmLockGuard lg(&m_lock);
+        entry->inFlight--;
+        m_delivered.notify_all();
+    }
+
+    return DCGM_ST_OK;
+}
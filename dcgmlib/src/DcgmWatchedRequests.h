@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "DcgmMutex.h"
+#include "DcgmProtocol.h"
+#include "DcgmRequest.h"
+
+#include <condition_variable>
+#include <memory>
+#include <unordered_map>
+
+/*****************************************************************************/
+/*
+ * Requests of embedded clients that the host engine sends messages to, like
+ * policy callbacks. Indexed by the requestId they were assigned by Add().
+ *
+ * Messages are delivered to a request without holding the lock of this table,
+ * since a request's ProcessMessage() may call back into the host engine and
+ * add or remove requests, or take host engine locks that are ordered before
+ * this one. Remove() and Clear() wait for the deliveries in flight to the
+ * requests they remove, so no message is delivered to a request after its
+ * removal returns. They must not be called while holding a lock that a
+ * request's ProcessMessage() takes. A request that removes itself from its
+ * own ProcessMessage() is destroyed once that delivery returns.
+ */
+class DcgmWatchedRequests
+{
+public:
+    DcgmWatchedRequests();
+
+    /*************************************************************************/
+    /*
+     * Add request and assign it a nonzero requestId that isn't in use
+     *
+     * RETURNS: DCGM_ST_OK on success
+     *          DCGM_ST_BADPARAM if request is null
+     */
+    dcgmReturn_t Add(std::unique_ptr<DcgmRequest> request, dcgm_request_id_t &requestId);
+
+    /*************************************************************************/
+    /*
+     * Remove requestId. Waits for the messages being delivered to it by other
+     * threads to be processed
+     *
+     * RETURNS: true if it was removed. false if there was no such request
+     */
+    bool Remove(dcgm_request_id_t requestId);
+
+    /*************************************************************************/
+    /*
+     * Remove every request. Waits like Remove() does
+     */
+    void Clear();
+
+    /*************************************************************************/
+    /*
+     * Pass msg to the ProcessMessage() of requestId
+     *
+     * RETURNS: DCGM_ST_OK if the message was delivered
+     *          DCGM_ST_BADPARAM if there is no such request
+     */
+    dcgmReturn_t Deliver(dcgm_request_id_t requestId, std::unique_ptr<DcgmMessage> msg);
+
+    /*************************************************************************/
+    /*
+     * Record lock statistics of this table under name. See DcgmMutex::EnableProfiling()
+     */
+    void EnableProfiling(char const *name);
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<DcgmRequest> request;
+        unsigned int inFlight = 0; /* Deliveries of request in progress. Protected by m_lock */
+    };
+
+    /*************************************************************************/
+    /*
+     * Wait until the only deliveries in flight to entry are the ones made by
+     * this thread. m_lock must be held
+     */
+    void WaitForDeliveries(Entry const &entry);
+
+    DcgmMutex m_lock = DcgmMutex(0); /* Protects m_requests, m_nextRequestId and the inFlight counts */
+
+    /* Signalled under m_lock when a delivery returns */
+    std::condition_variable m_delivered;
+
+    dcgm_request_id_t m_nextRequestId;
+    std::unordered_map<dcgm_request_id_t, std::shared_ptr<Entry>> m_requests;
+};
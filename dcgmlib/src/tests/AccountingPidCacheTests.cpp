@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmAccountingPidCache.h>
+
+TEST_CASE("AccountingPidCache: Insert and look up")
+{
+    DcgmAccountingPidCache cache;
+
+    CHECK(cache.Refresh(100, 5000, 0) == false);
+
+    /* Enough to grow the table several times */
+    for (unsigned int pid = 1; pid <= 10000; pid++)
+    {
+        cache.Insert(pid, 1000 + pid, DcgmAccountingPidCache::c_keepForever);
+    }
+    /* Inserting again is a no-op */
+    cache.Insert(1, 1001, DcgmAccountingPidCache::c_keepForever);
+    CHECK(cache.GetSize() == 10000);
+
+    for (unsigned int pid = 1; pid <= 10000; pid++)
+    {
+        REQUIRE(cache.Refresh(pid, 1000 + pid, 0));
+    }
+
+    /* A reused PID has a different start time */
+    CHECK(cache.Refresh(1, 5000, 0) == false);
+    CHECK(cache.Refresh(10001, 11001, 0) == false);
+
+    cache.Clear();
+    CHECK(cache.GetSize() == 0);
+    CHECK(cache.Refresh(1, 1001, 0) == false);
+}
+
+TEST_CASE("AccountingPidCache: Eviction")
+{
+    DcgmAccountingPidCache cache;
+
+    for (unsigned int pid = 1; pid <= 1000; pid++)
+    {
+        cache.Insert(pid, 1, pid <= 500 ? 2000 : 4000);
+    }
+    cache.Insert(5000, 1, DcgmAccountingPidCache::c_keepForever);
+
+    /* Nothing is due yet */
+    cache.EvictExpired(2000);
+    CHECK(cache.GetSize() == 1001);
+
+    /* Refreshing pushes an entry out past the others */
+    REQUIRE(cache.Refresh(1, 1, 6000));
+    /* A later keepUntil is never pulled back in */
+    REQUIRE(cache.Refresh(2, 1, 1000));
+
+    cache.EvictExpired(3000);
+    CHECK(cache.GetSize() == 502);
+    CHECK(cache.Refresh(1, 1, 0));
+    CHECK(cache.Refresh(3, 1, 0) == false);
+    for (unsigned int pid = 501; pid <= 1000; pid++)
+    {
+        REQUIRE(cache.Refresh(pid, 1, 0));
+    }
+
+    cache.EvictExpired(5000);
+    CHECK(cache.GetSize() == 2);
+
+    cache.EvictExpired(7000);
+    CHECK(cache.GetSize() == 1);
+    CHECK(cache.Refresh(5000, 1, 0));
+
+    /* Still usable after shrinking */
+    cache.Insert(7, 8, 9000);
+    CHECK(cache.Refresh(7, 8, 0));
+    CHECK(cache.GetSize() == 2);
+}
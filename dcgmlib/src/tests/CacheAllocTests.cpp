@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <cachealloc.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+std::uintptr_t ChunkOf(void *ptr)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) & ~(std::uintptr_t)(CACHEALLOC_CHUNK_BYTES - 1);
+}
+} // namespace
+
+TEST_CASE("CacheAlloc: Blocks of the same size share chunks")
+{
+    unsigned int const flags = GENERATE(0, CACHEALLOC_F_HUGE_PAGES, CACHEALLOC_F_NUMA_LOCAL);
+    cachealloc_pool_p pool   = cachealloc_pool_create(flags);
+    REQUIRE(pool != nullptr);
+
+    std::vector<void *> blocks;
+    for (int i = 0; i < 100; i++)
+    {
+        void *block = cachealloc_pool_malloc(pool, 1000);
+        REQUIRE(block != nullptr);
+        CHECK(reinterpret_cast<std::uintptr_t>(block) % 16 == 0);
+        std::memset(block, i, 1000);
+        blocks.push_back(block);
+    }
+
+    /* Only 1 KB blocks, and they all fit in the first chunk. Blocks of one size are kept apart from other sizes */
+    void *other = cachealloc_pool_malloc(pool, 100);
+    REQUIRE(other != nullptr);
+    CHECK(ChunkOf(other) != ChunkOf(blocks[0]));
+    for (void *block : blocks)
+    {
+        CHECK(ChunkOf(block) == ChunkOf(blocks[0]));
+    }
+
+    cachealloc_stats_t stats;
+    cachealloc_pool_stats(pool, &stats);
+    CHECK(stats.numChunks == 2);
+    CHECK(stats.mappedBytes == 2 * CACHEALLOC_CHUNK_BYTES);
+    CHECK(stats.liveBytes == 100 * 1024 + 128);
+    if (flags & CACHEALLOC_F_HUGE_PAGES)
+    {
+        /* Either reserved huge pages or transparent ones, depending on the system */
+        CHECK(stats.hugetlbBytes + stats.thpBytes <= stats.mappedBytes);
+    }
+    else
+    {
+        CHECK(stats.hugetlbBytes == 0);
+        CHECK(stats.thpBytes == 0);
+    }
+    if ((flags & CACHEALLOC_F_NUMA_LOCAL) == 0)
+    {
+        CHECK(stats.numaBoundBytes == 0);
+    }
+
+    /* Freed blocks are handed out again */
+    cachealloc_pool_free(pool, blocks[50]);
+    CHECK(cachealloc_pool_malloc(pool, 1024) == blocks[50]);
+    CHECK(static_cast<unsigned char *>(blocks[99])[999] == 99);
+
+    for (void *block : blocks)
+    {
+        cachealloc_pool_free(pool, block);
+    }
+    cachealloc_pool_free(pool, other);
+
+    /* One empty chunk is kept for reuse */
+    cachealloc_pool_stats(pool, &stats);
+    CHECK(stats.liveBytes == 0);
+    CHECK(stats.numChunks == 1);
+
+    cachealloc_pool_destroy(pool);
+}
+
+TEST_CASE("CacheAlloc: Large allocations and realloc")
+{
+    cachealloc_pool_p pool = cachealloc_pool_create(0);
+    REQUIRE(pool != nullptr);
+
+    char *ptr = static_cast<char *>(cachealloc_pool_malloc(pool, 100));
+    REQUIRE(ptr != nullptr);
+    std::memcpy(ptr, "cached", 7);
+
+    /* Stays in place while it fits in its block */
+    CHECK(cachealloc_pool_realloc(pool, ptr, 128) == ptr);
+
+    /* Grows into an allocation of its own */
+    std::size_t const largeSize = CACHEALLOC_MAX_BLOCK_BYTES + 1;
+    char *large                 = static_cast<char *>(cachealloc_pool_realloc(pool, ptr, largeSize));
+    REQUIRE(large != nullptr);
+    CHECK(std::strcmp(large, "cached") == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(large) % 16 == 0);
+    large[largeSize - 1] = 'x';
+
+    cachealloc_stats_t stats;
+    cachealloc_pool_stats(pool, &stats);
+    CHECK(stats.liveBytes >= (long long)largeSize);
+
+    cachealloc_pool_free(pool, large);
+    cachealloc_pool_stats(pool, &stats);
+    CHECK(stats.liveBytes == 0);
+
+    CHECK(cachealloc_pool_malloc(pool, 0) == nullptr);
+    CHECK(cachealloc_pool_realloc(pool, nullptr, 0) == nullptr);
+    cachealloc_pool_free(pool, nullptr);
+
+    /* Unmaps allocations that were not freed */
+    CHECK(cachealloc_pool_malloc(pool, 5000) != nullptr);
+    cachealloc_pool_destroy(pool);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmCacheSnapshot.h>
+#include <dcgm_fields.h>
+#include <timeseries.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+std::string GetSnapshotTestPath()
+{
+    return "/tmp/dcgm_cache_snapshot_test_" + std::to_string(getpid());
+}
+} // namespace
+
+TEST_CASE("CacheSnapshot: Write and read back")
+{
+    std::string const path = GetSnapshotTestPath();
+    DcgmCacheSnapshot snapshot;
+
+    snapshot.driverVersion = "5500054";
+    snapshot.gpuUuids      = { "GPU-0000", "GPU-1111" };
+
+    dcgmcm_snapshot_watch_t watch {};
+    watch.watchKey            = { 1, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    watch.monitorIntervalUsec = 1000000;
+    watch.maxAgeUsec          = 30000000;
+    watch.tsType              = TS_TYPE_INT64;
+    watch.watcherTypes        = { DcgmWatcherTypeHostEngine, DcgmWatcherTypeHealthWatch };
+    watch.samples             = { { 1000, 40, 0 }, { 2000, 41, 0 } };
+    snapshot.watches.push_back(watch);
+
+    dcgmcm_snapshot_watch_t historyOnly {};
+    historyOnly.watchKey = { 0, DCGM_FI_DEV_POWER_USAGE, DCGM_FE_GPU };
+    historyOnly.tsType   = TS_TYPE_DOUBLE;
+    historyOnly.samples  = { { 3000, 7, 8 } };
+    snapshot.watches.push_back(historyOnly);
+
+    REQUIRE(snapshot.WriteToFile(path) == DCGM_ST_OK);
+
+    DcgmCacheSnapshot readBack;
+    REQUIRE(readBack.ReadFromFile(path) == DCGM_ST_OK);
+    CHECK(readBack.Matches("5500054", { "GPU-0000", "GPU-1111" }));
+    CHECK(!readBack.Matches("5500055", { "GPU-0000", "GPU-1111" }));
+    CHECK(!readBack.Matches("5500054", { "GPU-1111", "GPU-0000" }));
+
+    REQUIRE(readBack.watches.size() == 2);
+    CHECK(readBack.watches[0].watchKey.entityId == 1);
+    CHECK(readBack.watches[0].watchKey.fieldId == DCGM_FI_DEV_GPU_TEMP);
+    CHECK(readBack.watches[0].monitorIntervalUsec == 1000000);
+    CHECK(readBack.watches[0].maxAgeUsec == 30000000);
+    CHECK(readBack.watches[0].watcherTypes == watch.watcherTypes);
+    REQUIRE(readBack.watches[0].samples.size() == 2);
+    CHECK(readBack.watches[0].samples[1].timestamp == 2000);
+    CHECK(readBack.watches[0].samples[1].value == 41);
+    CHECK(readBack.watches[1].tsType == TS_TYPE_DOUBLE);
+    CHECK(readBack.watches[1].watcherTypes.empty());
+    REQUIRE(readBack.watches[1].samples.size() == 1);
+    CHECK(readBack.watches[1].samples[0].value2 == 8);
+
+    unlink(path.c_str());
+}
+
+TEST_CASE("CacheSnapshot: Missing and damaged files")
+{
+    std::string const path = GetSnapshotTestPath();
+    DcgmCacheSnapshot snapshot;
+
+    unlink(path.c_str());
+    CHECK(snapshot.ReadFromFile(path) == DCGM_ST_NO_DATA);
+
+    snapshot.driverVersion = "5500054";
+    dcgmcm_snapshot_watch_t watch {};
+    watch.samples = { { 1000, 40, 0 } };
+    snapshot.watches.push_back(watch);
+    REQUIRE(snapshot.WriteToFile(path) == DCGM_ST_OK);
+
+    /* Chop off the last sample */
+    REQUIRE(truncate(path.c_str(), 112 + 40 + 10) == 0);
+    DcgmCacheSnapshot readBack;
+    CHECK(readBack.ReadFromFile(path) == DCGM_ST_GENERIC_ERROR);
+    CHECK(readBack.watches.empty());
+
+    {
+        std::ofstream garbage(path, std::ios::trunc);
+        garbage << std::string(200, 'x');
+    }
+    CHECK(readBack.ReadFromFile(path) == DCGM_ST_GENERIC_ERROR);
+
+    unlink(path.c_str());
+}
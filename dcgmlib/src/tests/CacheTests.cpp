@@ -15,8 +15,11 @@
  */
 #include <catch2/catch_all.hpp>
 #include <dcgm_agent.h>
+#include <future>
 #include <sstream>
+#include <thread>
 
+#include <DcgmCMUtils.h>
 #include <DcgmCacheManager.h>
 #include <Defer.hpp>
 
@@ -131,6 +134,40 @@ TEST_CASE("CacheManager: Test VgpuManageList")
         }
     }
 }
+
+TEST_CASE("CacheManager: vGPU instance index")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId0 = cm.AddFakeGpu();
+    unsigned int gpuId1 = cm.AddFakeGpu();
+
+    /* First element is the count */
+    nvmlVgpuInstance_t gpu0Ids[] = { 3, 11, 12, 13 };
+    nvmlVgpuInstance_t gpu1Ids[] = { 2, 21, 22 };
+    REQUIRE(cm.ManageVgpuList(gpuId0, gpu0Ids) == DCGM_ST_OK);
+    REQUIRE(cm.ManageVgpuList(gpuId1, gpu1Ids) == DCGM_ST_OK);
+
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 12) == gpuId0);
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 22) == gpuId1);
+    CHECK(!cm.GetGpuIdForEntity(DCGM_FE_VGPU, 31).has_value());
+
+    /* 12 goes away, 14 appears and the rest are untouched */
+    nvmlVgpuInstance_t gpu0Refreshed[] = { 3, 13, 11, 14 };
+    REQUIRE(cm.ManageVgpuList(gpuId0, gpu0Refreshed) == DCGM_ST_OK);
+
+    CHECK(!cm.GetGpuIdForEntity(DCGM_FE_VGPU, 12).has_value());
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 14) == gpuId0);
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 11) == gpuId0);
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 21) == gpuId1);
+
+    nvmlVgpuInstance_t none[] = { 0 };
+    REQUIRE(cm.ManageVgpuList(gpuId0, none) == DCGM_ST_OK);
+    CHECK(!cm.GetGpuIdForEntity(DCGM_FE_VGPU, 11).has_value());
+    CHECK(cm.GetGpuIdForEntity(DCGM_FE_VGPU, 21) == gpuId1);
+}
 #endif
 
 TEST_CASE("CacheManager: Test GetGpuId")
@@ -197,7 +234,7 @@ TEST_CASE("CacheManager: Test GetGpuId")
     }
 }
 
-void callback(unsigned int gpuId, void *userData)
+void callback(unsigned int gpuId, DcgmMigHierarchyDelta const &, void *userData)
 {
     auto gpuIdPtr = (unsigned int *)userData;
     *gpuIdPtr     = gpuId;
@@ -217,18 +254,152 @@ TEST_CASE("CacheManager: Test Event Register")
 
     REQUIRE(cm.SubscribeForEvent(sub) == DCGM_ST_OK);
     unsigned int updated = 4;
-    cm.NotifyMigUpdateSubscribers(updated);
+    cm.NotifyMigUpdateSubscribers(updated, DcgmMigHierarchyDelta {});
     REQUIRE(gpuId == updated);
 
     updated = 6;
-    cm.NotifyMigUpdateSubscribers(updated);
+    cm.NotifyMigUpdateSubscribers(updated, DcgmMigHierarchyDelta {});
     REQUIRE(gpuId == updated);
 
     updated = 1;
-    cm.NotifyMigUpdateSubscribers(updated);
+    cm.NotifyMigUpdateSubscribers(updated, DcgmMigHierarchyDelta {});
     REQUIRE(gpuId == updated);
 }
 
+TEST_CASE("CacheManager: topology snapshot")
+{
+    DcgmCacheManager cm;
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    auto first = cm.GetTopologySnapshot();
+    REQUIRE(first != nullptr);
+    CHECK(cm.GetTopologySnapshot() == first);
+
+    cm.InvalidateTopologySnapshot();
+    auto second = cm.GetTopologySnapshot();
+    CHECK(second != first);
+    CHECK(second->generation > first->generation);
+    CHECK(cm.GetTopologySnapshot() == second);
+
+    /* Callers that still hold the old snapshot can keep reading it */
+    CHECK(first->nvLinkRet == DCGM_ST_NOT_SUPPORTED);
+
+    REQUIRE(cm.SetGpuNvLinkLinkState(gpuId, 0, DcgmNvLinkLinkStateUp) == DCGM_ST_OK);
+    CHECK(cm.GetTopologySnapshot() != second);
+}
+
+TEST_CASE("CacheManager: NvLink status snapshot")
+{
+    DcgmCacheManager cm;
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    auto status = std::make_unique<dcgmNvLinkStatus_v4>();
+    REQUIRE(cm.PopulateNvLinkLinkStatus(*status) == DCGM_ST_OK);
+    CHECK(status->version == dcgmNvLinkStatus_version4);
+    CHECK(status->numGpus == 1);
+    CHECK(status->gpus[0].entityId == gpuId);
+    CHECK(status->gpus[0].linkState[0] == DcgmNvLinkLinkStateNotSupported);
+    CHECK(status->numNvSwitches == 0);
+    CHECK(!cm.GetNvSwitchLinkStatusRet().has_value());
+
+    /* Setting a link state is seen by the next read without a refresh */
+    REQUIRE(cm.SetGpuNvLinkLinkState(gpuId, 0, DcgmNvLinkLinkStateUp) == DCGM_ST_OK);
+    REQUIRE(cm.PopulateNvLinkLinkStatus(*status) == DCGM_ST_OK);
+    CHECK(status->gpus[0].linkState[0] == DcgmNvLinkLinkStateUp);
+
+    dcgmNvLinkNvSwitchLinkStatus_t nvSwitch {};
+    nvSwitch.entityId     = 7;
+    nvSwitch.linkState[3] = DcgmNvLinkLinkStateDown;
+    REQUIRE(cm.SetNvSwitchLinkStatus(DCGM_ST_OK, 1, &nvSwitch) == DCGM_ST_OK);
+    REQUIRE(cm.GetNvSwitchLinkStatusRet() == DCGM_ST_OK);
+    REQUIRE(cm.PopulateNvLinkLinkStatus(*status) == DCGM_ST_OK);
+    CHECK(status->numNvSwitches == 1);
+    CHECK(status->nvSwitches[0].entityId == 7);
+    CHECK(status->nvSwitches[0].linkState[3] == DcgmNvLinkLinkStateDown);
+    CHECK(status->gpus[0].linkState[0] == DcgmNvLinkLinkStateUp);
+
+    CHECK(cm.SetNvSwitchLinkStatus(DCGM_ST_OK, DCGM_MAX_NUM_SWITCHES + 1, &nvSwitch) == DCGM_ST_BADPARAM);
+    CHECK(cm.SetNvSwitchLinkStatus(DCGM_ST_OK, 1, nullptr) == DCGM_ST_BADPARAM);
+}
+
+TEST_CASE("CacheManager: GPU inventory snapshot")
+{
+    DcgmCacheManager cm;
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    auto first = cm.GetGpuInventory();
+    REQUIRE(first != nullptr);
+    REQUIRE(first->gpus.size() == 1);
+    CHECK(first->gpus[0].gpuId == gpuId);
+    CHECK(first->gpus[0].status == DcgmEntityStatusFake);
+    CHECK(std::string(first->gpus[0].uuid) == "GPU-00000000-0000-0000-0000-000000000000");
+
+    /* Changes that don't touch the GPUs keep the same snapshot */
+    cm.InvalidateTopologySnapshot();
+    CHECK(cm.GetGpuInventory() == first);
+
+    unsigned int const secondGpuId = cm.AddFakeGpu();
+    auto second                    = cm.GetGpuInventory();
+    CHECK(second->version > first->version);
+    REQUIRE(second->gpus.size() == 2);
+    CHECK(second->gpus[1].gpuId == secondGpuId);
+
+    /* Callers that still hold the old snapshot see it unchanged */
+    CHECK(first->gpus.size() == 1);
+
+    std::vector<dcgmcm_gpu_info_cached_t> gpuInfo;
+    REQUIRE(cm.GetAllGpuInfo(gpuInfo) == DCGM_ST_OK);
+    REQUIRE(gpuInfo.size() == 2);
+    CHECK(std::string(gpuInfo[1].uuid) == second->gpus[1].uuid);
+}
+
+TEST_CASE("CacheManager: MIG ID diff")
+{
+    using DcgmNs::Mig::ComputeInstanceId;
+    using DcgmNs::Mig::GpuInstanceId;
+
+    DcgmMigIdSnapshot before;
+    before.gpuInstances[1]            = GpuInstanceId { 0 };
+    before.gpuInstances[2]            = GpuInstanceId { 1 };
+    before.computeInstances[{ 1, 0 }] = ComputeInstanceId { 0 };
+    before.computeInstances[{ 2, 0 }] = ComputeInstanceId { 1 };
+
+    SECTION("Nothing changed")
+    {
+        CHECK(DcgmCacheManager::DiffMigIds(before, before).IsEmpty());
+    }
+
+    SECTION("Entities that are left alone are not reported")
+    {
+        DcgmMigIdSnapshot after = before;
+        after.gpuInstances.erase(2);
+        after.computeInstances.erase({ 2, 0 });
+        after.gpuInstances[5]            = GpuInstanceId { 2 };
+        after.computeInstances[{ 5, 0 }] = ComputeInstanceId { 2 };
+        after.computeInstances[{ 1, 1 }] = ComputeInstanceId { 3 };
+
+        DcgmMigHierarchyDelta delta = DcgmCacheManager::DiffMigIds(before, after);
+        CHECK(delta.addedGpuInstances == std::vector { GpuInstanceId { 2 } });
+        CHECK(delta.removedGpuInstances == std::vector { GpuInstanceId { 1 } });
+        CHECK(delta.addedComputeInstances == std::vector { ComputeInstanceId { 3 }, ComputeInstanceId { 2 } });
+        CHECK(delta.removedComputeInstances == std::vector { ComputeInstanceId { 1 } });
+    }
+
+    SECTION("An ID that now belongs to another NVML entity is both removed and added")
+    {
+        DcgmMigIdSnapshot after;
+        after.gpuInstances[1]            = GpuInstanceId { 0 };
+        after.gpuInstances[3]            = GpuInstanceId { 1 };
+        after.computeInstances[{ 1, 0 }] = ComputeInstanceId { 0 };
+
+        DcgmMigHierarchyDelta delta = DcgmCacheManager::DiffMigIds(before, after);
+        CHECK(delta.addedGpuInstances == std::vector { GpuInstanceId { 1 } });
+        CHECK(delta.removedGpuInstances == std::vector { GpuInstanceId { 1 } });
+        CHECK(delta.addedComputeInstances.empty());
+        CHECK(delta.removedComputeInstances == std::vector { ComputeInstanceId { 1 } });
+    }
+}
+
 TEST_CASE("CacheManager: CUDA_VISIBLE_DEVICES")
 {
     DcgmCacheManager cm;
@@ -327,3 +498,656 @@ TEST_CASE("CacheManger::GetFMStatusFromStruct")
         }
     }
 }
+
+TEST_CASE("CacheManager: DcgmFieldGetBatchedNvmlFieldId")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(nullptr, true) == 0);
+
+    /* Fields with an nvmlFieldId are batched as themselves */
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_ECC_CURRENT);
+    REQUIRE(fieldMeta != nullptr);
+    REQUIRE(fieldMeta->nvmlFieldId > 0);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true) == (unsigned int)fieldMeta->nvmlFieldId);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, false) == (unsigned int)fieldMeta->nvmlFieldId);
+
+    /* Fields that r520+ drivers don't report through field values */
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L0);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true) == 0);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, false) == (unsigned int)fieldMeta->nvmlFieldId);
+
+    /* Fields without an nvmlFieldId that can still be batched */
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_MEMORY_TEMP);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true) == NVML_FI_DEV_MEMORY_TEMP);
+
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_POWER_USAGE_INSTANT);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true) == NVML_FI_DEV_POWER_INSTANT);
+
+    /* Fields that need their own driver call */
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NAME);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true) == 0);
+
+    unsigned int scopeId = 1234;
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true, scopeId) == 0);
+    CHECK(scopeId == 0);
+}
+
+TEST_CASE("CacheManager: Per-link NvLink error counters are batched as scoped field values")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+
+    unsigned int scopeId = 0;
+
+    dcgm_field_meta_p fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L13);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true, scopeId) == NVML_FI_DEV_NVLINK_ERROR_DL_CRC);
+    CHECK(scopeId == 13);
+
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_L7);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true, scopeId) == NVML_FI_DEV_NVLINK_ERROR_DL_REPLAY);
+    CHECK(scopeId == 7);
+
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_L17);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true, scopeId) == NVML_FI_DEV_NVLINK_ERROR_DL_RECOVERY);
+    CHECK(scopeId == 17);
+
+    /* There is no scoped field value for data CRC errors */
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L0);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, true, scopeId) == 0);
+
+    /* Older drivers keep batching the legacy per-link field ids */
+    fieldMeta = DcgmFieldGetById(DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_L0);
+    REQUIRE(fieldMeta != nullptr);
+    CHECK(DcgmFieldGetBatchedNvmlFieldId(fieldMeta, false, scopeId) == (unsigned int)fieldMeta->nvmlFieldId);
+    CHECK(scopeId == 0);
+
+    nvmlNvLinkErrorCounter_t counter {};
+    unsigned int linkId = 0;
+    CHECK(DcgmFieldGetNvLinkErrorCounter(DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_L15, counter, linkId));
+    CHECK(counter == NVML_NVLINK_ERROR_DL_CRC_DATA);
+    CHECK(linkId == 15);
+    CHECK(!DcgmFieldGetNvLinkErrorCounter(DCGM_FI_DEV_NVLINK_BANDWIDTH_L0, counter, linkId));
+}
+
+TEST_CASE("CacheManager: MIG watches are planned under their GPU")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuIds[2];
+    gpuIds[0]                     = cm.AddFakeGpu();
+    gpuIds[1]                     = cm.AddFakeGpu();
+    unsigned int instanceId        = cm.AddFakeInstance(gpuIds[1]);
+    unsigned int computeInstanceId = cm.AddFakeComputeInstance(instanceId);
+    REQUIRE(instanceId != DCGM_ENTITY_ID_BAD);
+    REQUIRE(computeInstanceId != DCGM_ENTITY_ID_BAD);
+    /* Would be a valid gpuId if the plan were indexed by the instance's own ID */
+    REQUIRE(instanceId < DCGM_MAX_NUM_DEVICES);
+    REQUIRE(instanceId != gpuIds[1]);
+
+    DcgmWatcher watcher(DcgmWatcherTypeClient, 1);
+    bool wereFirstWatcher = false;
+    std::vector<dcgmGroupEntityPair_t> entities { { DCGM_FE_GPU, gpuIds[0] },
+                                                  { DCGM_FE_GPU_I, instanceId },
+                                                  { DCGM_FE_GPU_CI, computeInstanceId } };
+    for (auto const &entity : entities)
+    {
+        REQUIRE(cm.AddFieldWatch(entity.entityGroupId,
+                                 entity.entityId,
+                                 DCGM_FI_DEV_ECC_CURRENT,
+                                 1000000,
+                                 3600.0,
+                                 0,
+                                 watcher,
+                                 false,
+                                 false,
+                                 wereFirstWatcher)
+                == DCGM_ST_OK);
+    }
+
+    /* Each plan only has watches that are read from its GPU */
+    auto plan = cm.GetFieldValuePlanKeys(gpuIds[0]);
+    REQUIRE(plan.size() == 1);
+    CHECK(plan[0].entityGroupId == DCGM_FE_GPU);
+    CHECK(plan[0].entityId == gpuIds[0]);
+
+    plan = cm.GetFieldValuePlanKeys(gpuIds[1]);
+    REQUIRE(plan.size() == 2);
+    for (auto const &key : plan)
+    {
+        CHECK((key.entityGroupId == DCGM_FE_GPU_I || key.entityGroupId == DCGM_FE_GPU_CI));
+        CHECK(key.fieldId == DCGM_FI_DEV_ECC_CURRENT);
+    }
+
+    for (unsigned int gpuId = 0; gpuId < DCGM_MAX_NUM_DEVICES; gpuId++)
+    {
+        if (gpuId != gpuIds[0] && gpuId != gpuIds[1])
+        {
+            CHECK(cm.GetFieldValuePlanKeys(gpuId).empty());
+        }
+    }
+}
+
+TEST_CASE("CacheManager: Inject a batch of samples")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+    dcgmcm_sample_t sample {};
+
+    unsigned int gpuIds[2];
+    gpuIds[0] = cm.AddFakeGpu();
+    gpuIds[1] = cm.AddFakeGpu();
+
+    CHECK(cm.InjectSamples(nullptr) == DCGM_ST_BADPARAM);
+
+    timelib64_t now = timelib_usecSince1970();
+    DcgmFvBuffer fvBuffer;
+    for (int i = 0; i < 100; i++)
+    {
+        for (unsigned int gpuId : gpuIds)
+        {
+            fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS, 43 + i, now + i, DCGM_ST_OK);
+            fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_POWER_USAGE, 100.0 + i, now + i, DCGM_ST_OK);
+        }
+    }
+    fvBuffer.AddStringValue(DCGM_FE_GPU, gpuIds[1], DCGM_FI_DEV_NAME, "nvidia", now, DCGM_ST_OK);
+
+    REQUIRE(cm.InjectSamples(&fvBuffer) == DCGM_ST_OK);
+
+    for (unsigned int gpuId : gpuIds)
+    {
+        REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS, &sample, 0) == DCGM_ST_OK);
+        CHECK(sample.val.i64 == 142);
+        CHECK(sample.timestamp == now + 99);
+
+        REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_POWER_USAGE, &sample, 0) == DCGM_ST_OK);
+        CHECK(sample.val.d == 199.0);
+    }
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuIds[1], DCGM_FI_DEV_NAME, &sample, 0) == DCGM_ST_OK);
+    CHECK(std::string(sample.val.str) == "nvidia");
+    REQUIRE(cm.FreeSamples(&sample, 1, DCGM_FI_DEV_NAME) == DCGM_ST_OK);
+
+    /* A bad value anywhere in the batch keeps all of it out of the cache */
+    SECTION("Invalid entity")
+    {
+        DcgmFvBuffer badBuffer;
+        badBuffer.AddInt64Value(DCGM_FE_GPU, gpuIds[0], DCGM_FI_DEV_XID_ERRORS, 7, now + 1000, DCGM_ST_OK);
+        badBuffer.AddInt64Value(DCGM_FE_GPU, DCGM_MAX_NUM_DEVICES, DCGM_FI_DEV_XID_ERRORS, 7, now + 1000, DCGM_ST_OK);
+        CHECK(cm.InjectSamples(&badBuffer) == DCGM_ST_BADPARAM);
+    }
+
+    SECTION("Wrong field type")
+    {
+        DcgmFvBuffer badBuffer;
+        badBuffer.AddInt64Value(DCGM_FE_GPU, gpuIds[0], DCGM_FI_DEV_XID_ERRORS, 7, now + 1000, DCGM_ST_OK);
+        badBuffer.AddDoubleValue(DCGM_FE_GPU, gpuIds[0], DCGM_FI_DEV_XID_ERRORS, 7.0, now + 1000, DCGM_ST_OK);
+        CHECK(cm.InjectSamples(&badBuffer) == DCGM_ST_BADPARAM);
+    }
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuIds[0], DCGM_FI_DEV_XID_ERRORS, &sample, 0) == DCGM_ST_OK);
+    CHECK(sample.val.i64 == 142);
+}
+
+TEST_CASE("CacheManager: Append samples of a serialized buffer")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+    dcgmcm_sample_t sample {};
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    /* Modules only publish fields that are already watched */
+    DcgmWatcher watcher(DcgmWatcherTypeNvSwitchManager, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+    for (unsigned short fieldId : { DCGM_FI_DEV_XID_ERRORS, DCGM_FI_DEV_POWER_USAGE, DCGM_FI_DEV_NAME })
+    {
+        REQUIRE(
+            cm.AddFieldWatch(DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher)
+            == DCGM_ST_OK);
+    }
+
+    timelib64_t now = timelib_usecSince1970();
+    DcgmFvBuffer fvBuffer;
+    for (int i = 0; i < 100; i++)
+    {
+        fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS, 43 + i, now + i, DCGM_ST_OK);
+        fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_POWER_USAGE, 100.0 + i, now + i, DCGM_ST_OK);
+    }
+    fvBuffer.AddStringValue(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_NAME, "nvidia", now, DCGM_ST_OK);
+
+    size_t bufferSize   = 0;
+    size_t elementCount = 0;
+    REQUIRE(fvBuffer.GetSize(&bufferSize, &elementCount) == DCGM_ST_OK);
+    CHECK(cm.AppendSamples(nullptr, bufferSize) == DCGM_ST_BADPARAM);
+    REQUIRE(cm.AppendSamples(fvBuffer.GetBuffer(), bufferSize) == DCGM_ST_OK);
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS, &sample, 0) == DCGM_ST_OK);
+    CHECK(sample.val.i64 == 142);
+    CHECK(sample.timestamp == now + 99);
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_POWER_USAGE, &sample, 0) == DCGM_ST_OK);
+    CHECK(sample.val.d == 199.0);
+
+    REQUIRE(cm.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_NAME, &sample, 0) == DCGM_ST_OK);
+    CHECK(std::string(sample.val.str) == "nvidia");
+    REQUIRE(cm.FreeSamples(&sample, 1, DCGM_FI_DEV_NAME) == DCGM_ST_OK);
+
+    /* The buffer is only read */
+    dcgmBufferedFvCursor_t cursor = 0;
+    dcgmBufferedFv_t *fv          = fvBuffer.GetNextFv(&cursor);
+    REQUIRE(fv != nullptr);
+    CHECK(fv->value.i64 == 43);
+}
+
+TEST_CASE("CacheManager: Resample a field to a grid of times")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    DcgmWatcher watcher(DcgmWatcherTypeClient, 1);
+    bool wereFirstWatcher = false;
+    unsigned short const fieldId = DCGM_FI_DEV_POWER_USAGE;
+    REQUIRE(cm.AddFieldWatch(DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher)
+            == DCGM_ST_OK);
+
+    timelib64_t now = timelib_usecSince1970();
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuId, fieldId, 10.0, now, DCGM_ST_OK);
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuId, fieldId, 20.0, now + 10, DCGM_ST_OK);
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuId, fieldId, 40.0, now + 30, DCGM_ST_OK);
+    REQUIRE(cm.AppendSamples(&fvBuffer) == DCGM_ST_OK);
+
+    /* Rows at now - 5, now + 5, now + 15, now + 25 and now + 35, in every other element */
+    auto resample = [&](dcgmResampleFill_t fill) {
+        std::vector<double> values(10, 0.0);
+        REQUIRE(cm.ResampleField(DCGM_FE_GPU, gpuId, fieldId, now - 5, 10, 5, fill, values.data(), 2) == DCGM_ST_OK);
+        for (size_t i = 1; i < values.size(); i += 2)
+        {
+            CHECK(values[i] == 0.0);
+        }
+        return values;
+    };
+
+    std::vector<double> values = resample(DCGM_RESAMPLE_FILL_NONE);
+    CHECK(DCGM_FP64_IS_BLANK(values[0]));
+    CHECK(values[2] == 10.0);
+    CHECK(values[4] == 20.0);
+    CHECK(DCGM_FP64_IS_BLANK(values[6]));
+    CHECK(values[8] == 40.0);
+
+    values = resample(DCGM_RESAMPLE_FILL_PREVIOUS);
+    CHECK(DCGM_FP64_IS_BLANK(values[0]));
+    CHECK(values[2] == 10.0);
+    CHECK(values[4] == 20.0);
+    CHECK(values[6] == 20.0);
+    CHECK(values[8] == 40.0);
+
+    values = resample(DCGM_RESAMPLE_FILL_LINEAR);
+    CHECK(DCGM_FP64_IS_BLANK(values[0]));
+    CHECK(values[2] == 15.0);
+    CHECK(values[4] == 25.0);
+    CHECK(values[6] == 35.0);
+    CHECK(DCGM_FP64_IS_BLANK(values[8]));
+
+    /* Fields without samples are blank */
+    values.assign(3, 0.0);
+    CHECK(cm.ResampleField(
+              DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, now, 10, 3, DCGM_RESAMPLE_FILL_PREVIOUS, values.data(), 1)
+          == DCGM_ST_NOT_WATCHED);
+    for (double value : values)
+    {
+        CHECK(DCGM_FP64_IS_BLANK(value));
+    }
+}
+
+TEST_CASE("CacheManager: NVML sample buffer fields are drained at the buffer interval")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+
+    /* Read by the constructor */
+    setenv("__DCGM_NVML_SAMPLE_BUFFER_USEC__", "1000000", 1);
+    DcgmNs::Defer unsetEnv([] { unsetenv("__DCGM_NVML_SAMPLE_BUFFER_USEC__"); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    DcgmWatcher watcher(DcgmWatcherTypeClient, 1);
+    bool wereFirstWatcher = false;
+    for (unsigned short fieldId : { DCGM_FI_DEV_POWER_USAGE, DCGM_FI_DEV_SM_CLOCK, DCGM_FI_DEV_GPU_TEMP })
+    {
+        REQUIRE(cm.AddFieldWatch(DCGM_FE_GPU, gpuId, fieldId, 10000, 3600.0, 0, watcher, false, false, wereFirstWatcher)
+                == DCGM_ST_OK);
+    }
+
+    /* Buffered fields are read once a second and get every sample the driver took in between */
+    dcgmcm_watch_info_t watchInfo;
+    REQUIRE(cm.GetEntityWatchInfoSnapshot(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_POWER_USAGE, &watchInfo) == DCGM_ST_OK);
+    CHECK(watchInfo.monitorIntervalUsec == 1000000);
+    CHECK(watchInfo.lastNvmlSampleTs == 0);
+    REQUIRE(cm.GetEntityWatchInfoSnapshot(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_SM_CLOCK, &watchInfo) == DCGM_ST_OK);
+    CHECK(watchInfo.monitorIntervalUsec == 1000000);
+
+    /* Other fields are polled as often as they're watched */
+    REQUIRE(cm.GetEntityWatchInfoSnapshot(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, &watchInfo) == DCGM_ST_OK);
+    CHECK(watchInfo.monitorIntervalUsec == 10000);
+}
+
+TEST_CASE("CacheManager: change-only fields")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+
+    /* Read by the constructor */
+    setenv("__DCGM_CHANGE_ONLY_FIELDS__", std::to_string(DCGM_FI_DEV_ECC_DBE_VOL_TOTAL).c_str(), 1);
+    DcgmNs::Defer unsetEnv([] { unsetenv("__DCGM_CHANGE_ONLY_FIELDS__"); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    timelib64_t now = timelib_usecSince1970();
+    DcgmFvBuffer fvBuffer;
+    long long const values[] = { 0, 0, 0, 1, 1, 0 };
+    for (int i = 0; i < 6; i++)
+    {
+        fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_ECC_DBE_VOL_TOTAL, values[i], now + i, DCGM_ST_OK);
+        fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_ECC_SBE_VOL_TOTAL, values[i], now + i, DCGM_ST_OK);
+    }
+    REQUIRE(cm.InjectSamples(&fvBuffer) == DCGM_ST_OK);
+
+    dcgmcm_sample_t samples[8] {};
+    int numSamples = 8;
+    REQUIRE(cm.GetSamples(DCGM_FE_GPU,
+                          gpuId,
+                          DCGM_FI_DEV_ECC_DBE_VOL_TOTAL,
+                          samples,
+                          &numSamples,
+                          0,
+                          0,
+                          DCGM_ORDER_ASCENDING,
+                          nullptr)
+            == DCGM_ST_OK);
+
+    /* Only the changes are kept, stamped with when they happened */
+    REQUIRE(numSamples == 3);
+    CHECK(samples[0].val.i64 == 0);
+    CHECK(samples[0].timestamp == now);
+    CHECK(samples[1].val.i64 == 1);
+    CHECK(samples[1].timestamp == now + 3);
+    CHECK(samples[2].val.i64 == 0);
+    CHECK(samples[2].timestamp == now + 5);
+
+    /* Other fields keep every sample */
+    numSamples = 8;
+    REQUIRE(cm.GetSamples(DCGM_FE_GPU,
+                          gpuId,
+                          DCGM_FI_DEV_ECC_SBE_VOL_TOTAL,
+                          samples,
+                          &numSamples,
+                          0,
+                          0,
+                          DCGM_ORDER_ASCENDING,
+                          nullptr)
+            == DCGM_ST_OK);
+    CHECK(numSamples == 6);
+}
+
+TEST_CASE("CacheManager: concurrent UpdateAllFields calls join one queued cycle")
+{
+    using namespace std::chrono_literals;
+
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    REQUIRE(cm.Init(1, 3600.0, false) == DCGM_ST_OK);
+    REQUIRE(cm.Start() == 0);
+    for (int i = 0; i < 5000 && !cm.HasRun(); i++)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(cm.HasRun());
+
+    /* Hold the update thread so that the cycle queued below can't start until every caller is waiting on it */
+    std::promise<void> release;
+    std::promise<void> holding;
+    auto const released = release.get_future().share();
+    auto holdTask       = cm.Enqueue(DcgmNs::make_task("HoldUpdateThread", [released, &holding] {
+        holding.set_value();
+        released.wait();
+    }));
+    REQUIRE(holdTask.has_value());
+    bool isReleased = false;
+    DcgmNs::Defer releaseOnExit([&] {
+        if (!isReleased)
+        {
+            release.set_value();
+        }
+    });
+    REQUIRE(holding.get_future().wait_for(5s) == std::future_status::ready);
+
+    dcgmcm_runtime_stats_t before;
+    cm.GetRuntimeStats(&before);
+
+    constexpr int numCallers = 8;
+    std::vector<std::future<dcgmReturn_t>> callers;
+    for (int i = 0; i < numCallers; i++)
+    {
+        callers.push_back(std::async(std::launch::async, [&cm] { return cm.UpdateAllFields(1); }));
+    }
+
+    /* One caller queues the cycle and the others join it */
+    dcgmcm_runtime_stats_t stats;
+    for (int i = 0; i < 5000; i++)
+    {
+        cm.GetRuntimeStats(&stats);
+        if (stats.updatesCoalesced - before.updatesCoalesced == numCallers - 1)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    CHECK(stats.updatesCoalesced - before.updatesCoalesced == numCallers - 1);
+    for (auto &caller : callers)
+    {
+        CHECK(caller.wait_for(0s) == std::future_status::timeout);
+    }
+
+    isReleased = true;
+    release.set_value();
+    for (auto &caller : callers)
+    {
+        REQUIRE(caller.wait_for(5s) == std::future_status::ready);
+        CHECK(caller.get() == DCGM_ST_OK);
+    }
+
+    /* That cycle is done, so the next caller queues its own */
+    cm.GetRuntimeStats(&before);
+    CHECK(cm.UpdateAllFields(1) == DCGM_ST_OK);
+    cm.GetRuntimeStats(&stats);
+    CHECK(stats.updatesCoalesced == before.updatesCoalesced);
+}
+
+TEST_CASE("CacheManager: per-GPU update workers update each watch once per cycle")
+{
+    using namespace std::chrono_literals;
+
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+
+    /* Read by the constructor */
+    setenv("__DCGM_PER_GPU_UPDATE_WORKERS__", "1", 1);
+    DcgmNs::Defer unsetEnv([] { unsetenv("__DCGM_PER_GPU_UPDATE_WORKERS__"); });
+    DcgmCacheManager cm;
+
+    /* Lock step, so that only our UpdateAllFields() calls run cycles */
+    REQUIRE(cm.Init(1, 3600.0, false) == DCGM_ST_OK);
+
+    /* The workers are started for the GPUs that exist when the cache manager starts */
+    constexpr unsigned int numGpus = 4;
+    std::vector<unsigned int> gpuIds;
+    for (unsigned int i = 0; i < numGpus; i++)
+    {
+        gpuIds.push_back(cm.AddFakeGpu());
+        REQUIRE(gpuIds.back() != DCGM_GPU_ID_BAD);
+    }
+    unsigned int instanceId = cm.AddFakeInstance(gpuIds[1]);
+    REQUIRE(instanceId != DCGM_ENTITY_ID_BAD);
+
+    DcgmWatcher watcher(DcgmWatcherTypeClient, 1);
+    bool wereFirstWatcher = false;
+    std::vector<dcgmGroupEntityPair_t> entities { { DCGM_FE_GPU_I, instanceId } };
+    for (unsigned int gpuId : gpuIds)
+    {
+        entities.push_back({ DCGM_FE_GPU, gpuId });
+    }
+    for (auto const &entity : entities)
+    {
+        for (unsigned short fieldId : { DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_MEM_CLOCK })
+        {
+            REQUIRE(cm.AddFieldWatch(entity.entityGroupId,
+                                     entity.entityId,
+                                     fieldId,
+                                     1000,
+                                     3600.0,
+                                     0,
+                                     watcher,
+                                     false,
+                                     false,
+                                     wereFirstWatcher)
+                    == DCGM_ST_OK);
+        }
+    }
+
+    /* Fake GPUs are skipped by the update loop. Have it read them. NVML isn't loaded, so each read caches a blank
+       value without a driver call */
+    for (unsigned int gpuId : gpuIds)
+    {
+        REQUIRE(cm.SetGpuStatus(gpuId, DcgmEntityStatusOk) == DCGM_ST_OK);
+    }
+
+    REQUIRE(cm.Start() == 0);
+    for (int i = 0; i < 5000 && !cm.HasRun(); i++)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(cm.HasRun());
+    REQUIRE(cm.UpdateAllFields(1) == DCGM_ST_OK);
+
+    auto const getFetchCounts = [&] {
+        std::vector<long long> fetchCounts;
+        for (auto const &entity : entities)
+        {
+            for (unsigned short fieldId : { DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_MEM_CLOCK })
+            {
+                dcgmcm_watch_info_t watchInfo;
+                REQUIRE(cm.GetEntityWatchInfoSnapshot(entity.entityGroupId, entity.entityId, fieldId, &watchInfo)
+                        == DCGM_ST_OK);
+                fetchCounts.push_back(watchInfo.fetchCount);
+            }
+        }
+        return fetchCounts;
+    };
+
+    auto const before = getFetchCounts();
+    for (long long fetchCount : before)
+    {
+        CHECK(fetchCount > 0);
+    }
+
+    /* Every watch is due again once its interval passed. Each cycle has to update it exactly once, no matter
+       which worker owns it */
+    constexpr int numCycles = 5;
+    for (int cycle = 0; cycle < numCycles; cycle++)
+    {
+        std::this_thread::sleep_for(5ms);
+        REQUIRE(cm.UpdateAllFields(1) == DCGM_ST_OK);
+    }
+
+    auto const after = getFetchCounts();
+    REQUIRE(after.size() == before.size());
+    for (std::size_t i = 0; i < after.size(); i++)
+    {
+        CHECK(after[i] - before[i] == numCycles);
+    }
+}
+
+TEST_CASE("CacheManager: memory budget")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuId = cm.AddFakeGpu();
+
+    /* The SM clock is watched by an internal module. The other fields only have injected samples */
+    DcgmWatcher watcher(DcgmWatcherTypeHealthWatch, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+    REQUIRE(cm.AddFieldWatch(
+                DCGM_FE_GPU, gpuId, DCGM_FI_DEV_SM_CLOCK, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher)
+            == DCGM_ST_OK);
+
+    int const numInjected           = 5000;
+    unsigned short const fieldIds[] = { DCGM_FI_DEV_SM_CLOCK, DCGM_FI_DEV_GPU_TEMP, DCGM_FI_DEV_MEM_CLOCK };
+    timelib64_t now                 = timelib_usecSince1970();
+    DcgmFvBuffer fvBuffer;
+    for (int i = 0; i < numInjected; i++)
+    {
+        for (unsigned short fieldId : fieldIds)
+        {
+            fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, fieldId, i, now + i, DCGM_ST_OK);
+        }
+    }
+    REQUIRE(cm.InjectSamples(&fvBuffer) == DCGM_ST_OK);
+
+    std::vector<dcgmcm_sample_t> samples(numInjected);
+    auto countSamples = [&](unsigned short fieldId) {
+        int numSamples = numInjected;
+        REQUIRE(cm.GetSamples(
+                    DCGM_FE_GPU, gpuId, fieldId, samples.data(), &numSamples, 0, 0, DCGM_ORDER_ASCENDING, nullptr)
+                == DCGM_ST_OK);
+        return numSamples;
+    };
+
+    /* Reading the memory clock makes the temperature the least recently read client watch */
+    REQUIRE(countSamples(DCGM_FI_DEV_MEM_CLOCK) == numInjected);
+
+    dcgmcm_memory_budget_stats_t stats;
+    cm.SetMemoryBudget(1LL << 40);
+    cm.EnforceMemoryBudget();
+    cm.GetMemoryBudgetStats(stats);
+    REQUIRE(stats.cachedBytes > 0);
+    CHECK(stats.evictions == 0);
+
+    cm.SetMemoryBudget(stats.cachedBytes * 3 / 4);
+    cm.EnforceMemoryBudget();
+    cm.GetMemoryBudgetStats(stats);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.evictedSamples == numInjected - 1);
+    CHECK(stats.evictedBytes > 0);
+    CHECK(stats.cachedBytes <= stats.budgetBytes);
+
+    /* Only the latest sample of the evicted watch is left */
+    REQUIRE(countSamples(DCGM_FI_DEV_GPU_TEMP) == 1);
+    CHECK(samples[0].val.i64 == numInjected - 1);
+
+    CHECK(countSamples(DCGM_FI_DEV_MEM_CLOCK) == numInjected);
+    CHECK(countSamples(DCGM_FI_DEV_SM_CLOCK) == numInjected);
+}
@@ -431,4 +431,32 @@ TEST_CASE("Nonexistent test kmsg filename")
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         CHECK(readerThread.HasExited() == 1);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Kmsg reader wakes XID waiters and stops promptly")
+{
+    std::string filename = "/tmp/kmsg_file";
+    {
+        FILE *file = fopen(filename.c_str(), "w");
+        REQUIRE(file != nullptr);
+        fprintf(file, "3,1,1000,-;NVRM: Xid (PCI:0000:2a:00): 79, pid='<unknown>', name=<unknown>, Fallen off\n");
+        fclose(file);
+    }
+    SetEnv(KmsgFilenameEnvKey, filename);
+
+    DcgmKmsgReaderThread readerThread {};
+    readerThread.Start();
+
+    REQUIRE(readerThread.WaitForXids(5000));
+    std::vector<std::unique_ptr<KmsgXidData>> parsedXids = readerThread.GetParsedKmsgXids();
+    REQUIRE(parsedXids.size() == 1);
+    CHECK(parsedXids[0]->xid == 79);
+
+    CHECK(!readerThread.WaitForXids(10));
+
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(readerThread.StopAndWait(1000) == 0);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+
+    UnsetEnv(KmsgFilenameEnvKey);
+    remove(filename.c_str());
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmProtocol.h>
+
+TEST_CASE("DcgmMessage: External segments count toward the length and hold their owners")
+{
+    DcgmMessage message;
+    message.GetMsgBytesPtr()->resize(16);
+
+    auto first  = std::make_shared<std::vector<char> const>(1000, 'a');
+    auto second = std::make_shared<std::vector<char> const>(24, 'b');
+
+    message.AddExternalSegment(first->data(), first->size(), first);
+    message.AddExternalSegment(second->data(), second->size(), second);
+    message.AddExternalSegment(second->data(), 0, second); /* Empty segments are dropped */
+
+    CHECK(message.GetLength() == 16 + 1000 + 24);
+    REQUIRE(message.GetExternalSegments().size() == 2);
+    CHECK(message.GetExternalSegments()[0].data == first->data());
+    CHECK(message.GetExternalSegments()[1].length == 24);
+    CHECK(first.use_count() == 2);
+    CHECK(second.use_count() == 2);
+
+    /* Moving the message moves the references rather than adding to them */
+    DcgmMessage moved(std::move(message));
+    CHECK(first.use_count() == 2);
+    CHECK(moved.GetLength() == 16 + 1000 + 24);
+
+    moved.ClearExternalSegments();
+    CHECK(moved.GetLength() == 16);
+    CHECK(first.use_count() == 1);
+    CHECK(second.use_count() == 1);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmDerivedFields.h>
+#include <dcgm_fields.h>
+
+#include <algorithm>
+
+TEST_CASE("DerivedFields: Definitions match the field table")
+{
+    DcgmFieldsInit();
+
+    for (auto const &def : DcgmDerivedFields::GetAllDefs())
+    {
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(def.fieldId);
+        REQUIRE(fieldMeta != nullptr);
+        CHECK(fieldMeta->fieldType == DCGM_FT_DOUBLE);
+        CHECK(DcgmDerivedFields::GetDef(def.fieldId) == &def);
+
+        CHECK(DcgmFieldGetById(def.inputs[0]) != nullptr);
+        CHECK(DcgmDerivedFields::GetDef(def.inputs[0]) == nullptr);
+        if (def.op == DcgmDerivedOp::Ratio)
+        {
+            CHECK(DcgmFieldGetById(def.inputs[1]) != nullptr);
+        }
+        else
+        {
+            CHECK(def.inputs[1] == 0);
+        }
+        CHECK((def.op == DcgmDerivedOp::Duration) == (def.mask != 0));
+
+        auto const triggered = DcgmDerivedFields::GetDefsTriggeredBy(def.inputs[0]);
+        CHECK(std::find(triggered.begin(), triggered.end(), &def) != triggered.end());
+    }
+
+    CHECK(DcgmDerivedFields::GetDef(DCGM_FI_DEV_POWER_USAGE) == nullptr);
+    CHECK(DcgmDerivedFields::GetDefsTriggeredBy(DCGM_FI_DEV_GPU_TEMP).empty());
+    CHECK(DcgmDerivedFields::GetDefsTriggeredBy(DCGM_FI_MAX_FIELDS).empty());
+    /* The denominator of a ratio does not trigger it */
+    CHECK(DcgmDerivedFields::GetDefsTriggeredBy(DCGM_FI_DEV_ENFORCED_POWER_LIMIT).empty());
+}
+
+TEST_CASE("DerivedFields: Rate")
+{
+    DcgmDerivedFieldDef const *def = DcgmDerivedFields::GetDef(DCGM_FI_DEV_PCIE_REPLAY_RATE);
+    REQUIRE(def != nullptr);
+
+    CHECK(DcgmDerivedFields::EvaluateRate(*def, 10, 1000000, 30, 3000000) == 10.0);
+    CHECK(DcgmDerivedFields::EvaluateRate(*def, 10, 1000000, 10, 1500000) == 0.0);
+
+    /* No earlier sample */
+    CHECK_FALSE(DcgmDerivedFields::EvaluateRate(*def, 0, 0, 30, 3000000).has_value());
+    /* Time did not move forward */
+    CHECK_FALSE(DcgmDerivedFields::EvaluateRate(*def, 10, 3000000, 30, 3000000).has_value());
+    /* The counter was reset */
+    CHECK_FALSE(DcgmDerivedFields::EvaluateRate(*def, 30, 1000000, 5, 2000000).has_value());
+}
+
+TEST_CASE("DerivedFields: Ratio")
+{
+    DcgmDerivedFieldDef const *def = DcgmDerivedFields::GetDef(DCGM_FI_DEV_POWER_USAGE_PERCENT);
+    REQUIRE(def != nullptr);
+
+    CHECK(DcgmDerivedFields::EvaluateRatio(*def, 150, 300) == 50.0);
+    CHECK(DcgmDerivedFields::EvaluateRatio(*def, 0, 300) == 0.0);
+    CHECK_FALSE(DcgmDerivedFields::EvaluateRatio(*def, 150, 0).has_value());
+}
+
+TEST_CASE("DerivedFields: Duration")
+{
+    DcgmDerivedFieldDef const *def = DcgmDerivedFields::GetDef(DCGM_FI_DEV_CLOCKS_EVENT_SW_THERMAL_TIME);
+    REQUIRE(def != nullptr);
+    REQUIRE(DcgmDerivedFields::GetDefsTriggeredBy(DCGM_FI_DEV_CLOCKS_EVENT_REASONS).size() == 6);
+
+    long long const thermal = DCGM_CLOCKS_EVENT_REASON_SW_THERMAL | DCGM_CLOCKS_EVENT_REASON_GPU_IDLE;
+    long long const idle    = DCGM_CLOCKS_EVENT_REASON_GPU_IDLE;
+
+    /* The first sample starts the total */
+    CHECK(DcgmDerivedFields::EvaluateDuration(*def, 0, 0, 1000000, 0.0) == 0.0);
+    /* The time until the next sample counts if the reason was set */
+    CHECK(DcgmDerivedFields::EvaluateDuration(*def, thermal, 1000000, 3500000, 1.0) == 3.5);
+    CHECK(DcgmDerivedFields::EvaluateDuration(*def, idle, 1000000, 3500000, 1.0) == 1.0);
+    /* Time did not move forward */
+    CHECK_FALSE(DcgmDerivedFields::EvaluateDuration(*def, thermal, 3000000, 3000000, 1.0).has_value());
+}
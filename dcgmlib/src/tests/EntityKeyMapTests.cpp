@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmEntityKeyMap.h>
+
+#include <set>
+#include <vector>
+
+namespace
+{
+dcgm_entity_key_t MakeKey(unsigned short entityGroupId, dcgm_field_eid_t entityId, unsigned short fieldId)
+{
+    dcgm_entity_key_t key {};
+    key.entityGroupId = entityGroupId;
+    key.entityId      = entityId;
+    key.fieldId       = fieldId;
+    return key;
+}
+} // namespace
+
+TEST_CASE("EntityKeyMap: Insert and find")
+{
+    DcgmEntityKeyMap<int> map;
+    std::vector<int> values(4 * 1000 * 8);
+
+    CHECK(map.Find(MakeKey(DCGM_FE_GPU, 0, 150)) == nullptr);
+    CHECK(map.begin() == map.end());
+
+    /* Enough to grow the table several times */
+    size_t i = 0;
+    for (unsigned short eg = 0; eg < 4; eg++)
+    {
+        for (unsigned short fieldId = 1; fieldId <= 1000; fieldId++)
+        {
+            for (dcgm_field_eid_t entityId = 0; entityId < 8; entityId++)
+            {
+                values[i] = (int)i;
+                REQUIRE(map.Insert(MakeKey(eg, entityId, fieldId), &values[i]));
+                i++;
+            }
+        }
+    }
+    CHECK(map.GetSize() == values.size());
+
+    /* Inserting again keeps the first value */
+    int other = -1;
+    CHECK(map.Insert(MakeKey(0, 0, 1), &other) == false);
+    CHECK(map.GetSize() == values.size());
+
+    i = 0;
+    for (unsigned short eg = 0; eg < 4; eg++)
+    {
+        for (unsigned short fieldId = 1; fieldId <= 1000; fieldId++)
+        {
+            for (dcgm_field_eid_t entityId = 0; entityId < 8; entityId++)
+            {
+                REQUIRE(map.Find(MakeKey(eg, entityId, fieldId)) == &values[i]);
+                i++;
+            }
+        }
+    }
+
+    /* Every part of the key counts */
+    CHECK(map.Find(MakeKey(4, 0, 1)) == nullptr);
+    CHECK(map.Find(MakeKey(0, 8, 1)) == nullptr);
+    CHECK(map.Find(MakeKey(0, 0, 1001)) == nullptr);
+
+    std::set<int *> seen;
+    for (int *value : map)
+    {
+        REQUIRE(value != nullptr);
+        seen.insert(value);
+    }
+    CHECK(seen.size() == values.size());
+
+    map.Clear();
+    CHECK(map.GetSize() == 0);
+    CHECK(map.begin() == map.end());
+    CHECK(map.Find(MakeKey(0, 0, 1)) == nullptr);
+
+    /* Still usable after clearing */
+    REQUIRE(map.Insert(MakeKey(1, 2, 3), &other));
+    CHECK(map.Find(MakeKey(1, 2, 3)) == &other);
+}
+
+TEST_CASE("EntityKeyMap: Packed keys and their hashes are distinct")
+{
+    std::set<DcgmNs::PackedEntityKey> keys;
+    std::set<std::size_t> buckets;
+    unsigned int numKeys = 0;
+
+    for (unsigned short entityGroupId : { DCGM_FE_GPU, DCGM_FE_GPU_I, DCGM_FE_LINK })
+    {
+        for (dcgm_field_eid_t entityId = 0; entityId < 64; entityId++)
+        {
+            for (unsigned short fieldId = 0; fieldId < 32; fieldId++)
+            {
+                DcgmNs::PackedEntityKey key = DcgmNs::PackEntityKey(MakeKey(entityGroupId, entityId, fieldId));
+                keys.insert(key);
+                /* Dense ids still spread over the low bits that pick a bucket */
+                buckets.insert(DcgmNs::HashPackedEntityKey(key) % 1024);
+                numKeys++;
+            }
+        }
+    }
+
+    CHECK(keys.size() == numKeys);
+    CHECK(buckets.size() > 900);
+
+    dcgmGroupEntityPair_t entity { DCGM_FE_GPU, 3 };
+    CHECK(DcgmNs::PackEntityKey(entity) == DcgmNs::PackEntityKey(MakeKey(DCGM_FE_GPU, 3, 0)));
+    CHECK(DcgmNs::EntityKeyHash {}(entity) == std::hash<dcgm_entity_key_t> {}(MakeKey(DCGM_FE_GPU, 3, 0)));
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmEntityStatusTable.h>
+
+#include <vector>
+
+using Entries = std::vector<DcgmEntityStatusTable::Entry>;
+
+TEST_CASE("EntityStatusTable: groups are only served once published")
+{
+    DcgmEntityStatusTable table;
+
+    CHECK(!table.Get(DCGM_FE_GPU, 0).has_value());
+    CHECK(!table.GetGpuStatus(0).has_value());
+    CHECK(!table.Get(DCGM_FE_SWITCH, 0).has_value());
+    CHECK(!table.Get(DCGM_FE_CPU_CORE, 0).has_value());
+
+    /* Not kept in the table at all */
+    CHECK(table.Publish(DCGM_FE_LINK, Entries {}) == DCGM_ST_NOT_SUPPORTED);
+    CHECK(!table.Get(DCGM_FE_LINK, 0).has_value());
+    CHECK(!table.Get(DCGM_FE_VGPU, 0).has_value());
+
+    REQUIRE(table.Publish(DCGM_FE_CPU_CORE, Entries { { 0, DcgmEntityStatusOk }, { 5, DcgmEntityStatusOk } })
+            == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_CPU_CORE, 5) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_CPU_CORE, 1) == DcgmEntityStatusUnknown);
+    CHECK(table.Get(DCGM_FE_CPU_CORE, DCGM_MAX_NUM_CPU_CORES) == DcgmEntityStatusUnknown);
+    CHECK(!table.Get(DCGM_FE_CPU, 0).has_value());
+
+    /* Republishing replaces the whole group */
+    REQUIRE(table.Publish(DCGM_FE_CPU_CORE, Entries { { 1, DcgmEntityStatusOk } }) == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_CPU_CORE, 1) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_CPU_CORE, 5) == DcgmEntityStatusUnknown);
+
+    /* An entity that doesn't fit sends callers back to the owner */
+    CHECK(table.Publish(DCGM_FE_CPU_CORE, Entries { { DCGM_MAX_NUM_CPU_CORES, DcgmEntityStatusOk } })
+          == DCGM_ST_BADPARAM);
+    CHECK(!table.Get(DCGM_FE_CPU_CORE, 1).has_value());
+}
+
+TEST_CASE("EntityStatusTable: instances follow their GPU")
+{
+    DcgmEntityStatusTable table;
+
+    REQUIRE(table.Publish(DCGM_FE_GPU_I, Entries { { 8, 1 } }) == DCGM_ST_OK);
+    REQUIRE(table.Publish(DCGM_FE_GPU_CI, Entries { { 9, 1 } }) == DCGM_ST_OK);
+
+    /* The GPUs aren't published yet */
+    CHECK(!table.Get(DCGM_FE_GPU_I, 8).has_value());
+
+    REQUIRE(table.Publish(DCGM_FE_GPU, Entries { { 0, DcgmEntityStatusOk }, { 1, DcgmEntityStatusOk } })
+            == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_GPU_I, 8) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_GPU_CI, 9) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_GPU_I, 0) == DcgmEntityStatusUnknown);
+
+    table.SetGpuQuarantined(1, true);
+    CHECK(table.Get(DCGM_FE_GPU, 1) == DcgmEntityStatusQuarantined);
+    CHECK(table.Get(DCGM_FE_GPU_I, 8) == DcgmEntityStatusQuarantined);
+    CHECK(table.Get(DCGM_FE_GPU_CI, 9) == DcgmEntityStatusQuarantined);
+    CHECK(table.GetGpuStatus(1) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_GPU, 0) == DcgmEntityStatusOk);
+
+    /* A lost GPU stays lost, quarantined or not */
+    REQUIRE(table.Publish(DCGM_FE_GPU, Entries { { 0, DcgmEntityStatusOk }, { 1, DcgmEntityStatusLost } })
+            == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_GPU_I, 8) == DcgmEntityStatusLost);
+
+    table.SetGpuQuarantined(1, false);
+    REQUIRE(table.Publish(DCGM_FE_GPU, Entries { { 0, DcgmEntityStatusOk }, { 1, DcgmEntityStatusDisabled } })
+            == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_GPU_CI, 9) == DcgmEntityStatusDisabled);
+    CHECK(table.Get(DCGM_FE_GPU, 2) == DcgmEntityStatusUnknown);
+}
+
+TEST_CASE("EntityStatusTable: switches are looked up by physical ID")
+{
+    DcgmEntityStatusTable table;
+
+    REQUIRE(table.Publish(DCGM_FE_SWITCH, Entries { { 1000, DcgmEntityStatusOk }, { 7, DcgmEntityStatusDisabled } })
+            == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_SWITCH, 1000) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_SWITCH, 7) == DcgmEntityStatusDisabled);
+    CHECK(table.Get(DCGM_FE_SWITCH, 0) == DcgmEntityStatusUnknown);
+
+    REQUIRE(table.Publish(DCGM_FE_SWITCH, Entries { { 7, DcgmEntityStatusOk } }) == DCGM_ST_OK);
+    CHECK(table.Get(DCGM_FE_SWITCH, 7) == DcgmEntityStatusOk);
+    CHECK(table.Get(DCGM_FE_SWITCH, 1000) == DcgmEntityStatusUnknown);
+
+    Entries tooMany(DCGM_MAX_NUM_SWITCHES + 1, { 0, DcgmEntityStatusOk });
+    CHECK(table.Publish(DCGM_FE_SWITCH, tooMany) == DCGM_ST_BADPARAM);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmFvDeliveryQueue.h>
+#include <dcgm_fields.h>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::shared_ptr<DcgmFvBuffer> MakeBatch(long long value)
+{
+    auto fvBuffer = std::make_shared<DcgmFvBuffer>();
+    fvBuffer->AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, value, 1000, DCGM_ST_OK);
+    return fvBuffer;
+}
+
+long long FirstValue(DcgmFvBuffer &fvBuffer)
+{
+    dcgmBufferedFvCursor_t cursor = 0;
+    dcgmBufferedFv_t *fv          = fvBuffer.GetNextFv(&cursor);
+    REQUIRE(fv != nullptr);
+    return fv->value.i64;
+}
+
+bool WaitForDelivered(DcgmFvDeliveryQueue const &queue, unsigned long long count)
+{
+    for (int i = 0; i < 5000 && queue.GetStats().delivered < count; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return queue.GetStats().delivered == count;
+}
+} // namespace
+
+TEST_CASE("FvDeliveryQueue: batches are delivered in order on the queue thread")
+{
+    std::mutex mutex;
+    std::vector<long long> values;
+    std::thread::id deliveryThreadId;
+
+    DcgmFvDeliveryQueue queue(16, [&](DcgmFvBuffer &fvBuffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.push_back(FirstValue(fvBuffer));
+        deliveryThreadId = std::this_thread::get_id();
+    });
+    REQUIRE(queue.Start() == 0);
+
+    for (long long i = 0; i < 10; i++)
+    {
+        REQUIRE(queue.Push(MakeBatch(i)));
+    }
+
+    REQUIRE(WaitForDelivered(queue, 10));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    REQUIRE(values == std::vector<long long> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    REQUIRE(deliveryThreadId != std::this_thread::get_id());
+
+    dcgm_fv_delivery_stats_t stats = queue.GetStats();
+    CHECK(stats.depth == 0);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.maxDepth == 16);
+}
+
+TEST_CASE("FvDeliveryQueue: batches are dropped while a slow subscriber is behind")
+{
+    std::promise<void> unblock;
+    std::shared_future<void> unblocked = unblock.get_future().share();
+    std::vector<long long> values;
+
+    DcgmFvDeliveryQueue queue(2, [&](DcgmFvBuffer &fvBuffer) {
+        unblocked.wait();
+        values.push_back(FirstValue(fvBuffer));
+    });
+    REQUIRE(queue.Start() == 0);
+
+    /* The first batch is being delivered and still counts towards the depth */
+    CHECK(queue.Push(MakeBatch(1)));
+    CHECK(queue.Push(MakeBatch(2)));
+    CHECK(!queue.Push(MakeBatch(3)));
+    CHECK(!queue.Push(MakeBatch(4)));
+
+    dcgm_fv_delivery_stats_t stats = queue.GetStats();
+    CHECK(stats.depth == 2);
+    CHECK(stats.highWaterDepth == 2);
+    CHECK(stats.dropped == 2);
+
+    unblock.set_value();
+    REQUIRE(WaitForDelivered(queue, 2));
+    CHECK(values == std::vector<long long> { 1, 2 });
+
+    /* There is room again once the subscriber catches up */
+    CHECK(queue.Push(MakeBatch(5)));
+    REQUIRE(WaitForDelivered(queue, 3));
+    CHECK(queue.GetStats().dropped == 2);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmFvStreams.h>
+#include <dcgm_fields.h>
+
+#include <vector>
+
+namespace
+{
+std::vector<dcgmBufferedFv_t> ReadNotification(dcgm_fv_stream_notification_t const &notification)
+{
+    DcgmFvBuffer fvBuffer(0);
+    std::vector<dcgmBufferedFv_t> values;
+
+    REQUIRE(fvBuffer.SetFromBuffer(notification.fvBytes.data(), notification.fvBytes.size()) == DCGM_ST_OK);
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        values.push_back(*fv);
+    }
+    return values;
+}
+} // namespace
+
+TEST_CASE("FvStreams: Dispatch splits updates by subscription")
+{
+    DcgmFvStreams streams;
+    DcgmFvBuffer fvBuffer;
+
+    std::vector<dcgm_entity_key_t> gpu0Keys { { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU },
+                                              { 0, DCGM_FI_DEV_POWER_USAGE, DCGM_FE_GPU } };
+    std::vector<dcgm_entity_key_t> gpu1Keys { { 1, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU },
+                                              { 7, DCGM_FI_DRIVER_VERSION, DCGM_FE_NONE } };
+
+    CHECK(streams.GetCount() == 0);
+    CHECK(streams.Add(1, 10, 100, 200, gpu0Keys) == DCGM_REQUEST_ID_NONE);
+    CHECK(streams.Add(2, 20, 101, 200, gpu1Keys) == DCGM_REQUEST_ID_NONE);
+    CHECK(streams.GetCount() == 2);
+
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 40, 1000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 1, DCGM_FI_DEV_GPU_TEMP, 41, 1000, DCGM_ST_OK);
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_POWER_USAGE, 100.5, 1000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 2, DCGM_FI_DEV_GPU_TEMP, 42, 1000, DCGM_ST_OK);
+    fvBuffer.AddStringValue(DCGM_FE_NONE, 0, DCGM_FI_DRIVER_VERSION, "550.00", 1000, DCGM_ST_OK);
+
+    auto notifications = streams.Dispatch(fvBuffer, DCGM_PROTO_MAX_MESSAGE_SIZE);
+    REQUIRE(notifications.size() == 2);
+
+    CHECK(notifications[0].connectionId == 1);
+    CHECK(notifications[0].requestId == 10);
+    auto values = ReadNotification(notifications[0]);
+    REQUIRE(values.size() == 2);
+    CHECK(values[0].fieldId == DCGM_FI_DEV_GPU_TEMP);
+    CHECK(values[0].value.i64 == 40);
+    CHECK(values[1].fieldId == DCGM_FI_DEV_POWER_USAGE);
+    CHECK(values[1].value.dbl == 100.5);
+
+    CHECK(notifications[1].connectionId == 2);
+    CHECK(notifications[1].requestId == 20);
+    values = ReadNotification(notifications[1]);
+    REQUIRE(values.size() == 2);
+    CHECK(values[0].entityId == 1);
+    CHECK(values[0].value.i64 == 41);
+    /* Global fields match regardless of the entityId they were subscribed with */
+    CHECK(values[1].fieldId == DCGM_FI_DRIVER_VERSION);
+}
+
+TEST_CASE("FvStreams: Replace, Remove and RemoveConnection")
+{
+    DcgmFvStreams streams;
+    DcgmFvBuffer fvBuffer;
+    std::vector<dcgm_entity_key_t> keys { { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU } };
+
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 40, 1000, DCGM_ST_OK);
+
+    CHECK(streams.Add(1, 10, 100, 200, keys) == DCGM_REQUEST_ID_NONE);
+    CHECK(streams.Add(1, 11, 100, 200, keys) == 10);
+    CHECK(streams.Add(1, 12, 100, 201, keys) == DCGM_REQUEST_ID_NONE);
+    CHECK(streams.Add(2, 13, 100, 200, keys) == DCGM_REQUEST_ID_NONE);
+    CHECK(streams.GetCount() == 3);
+    CHECK(streams.Dispatch(fvBuffer, DCGM_PROTO_MAX_MESSAGE_SIZE).size() == 3);
+
+    CHECK(streams.Remove(1, 100, 200) == 11);
+    CHECK(streams.Remove(1, 100, 200) == DCGM_REQUEST_ID_NONE);
+    CHECK(streams.GetCount() == 2);
+
+    streams.RemoveConnection(1);
+    CHECK(streams.GetCount() == 1);
+
+    auto notifications = streams.Dispatch(fvBuffer, DCGM_PROTO_MAX_MESSAGE_SIZE);
+    REQUIRE(notifications.size() == 1);
+    CHECK(notifications[0].requestId == 13);
+}
+
+TEST_CASE("FvStreams: Dispatch splits large updates")
+{
+    DcgmFvStreams streams;
+    DcgmFvBuffer fvBuffer;
+    std::vector<dcgm_entity_key_t> keys;
+
+    for (unsigned int gpuId = 0; gpuId < 10; gpuId++)
+    {
+        keys.push_back({ gpuId, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU });
+        fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_GPU_TEMP, gpuId, 1000, DCGM_ST_OK);
+    }
+
+    streams.Add(1, 10, 100, 200, keys);
+
+    /* Room for 3 values per notification */
+    auto notifications = streams.Dispatch(fvBuffer, 3 * DCGM_BUFFERED_FV1_MIN_ENTRY_SIZE);
+    REQUIRE(notifications.size() == 4);
+
+    size_t numValues = 0;
+    for (auto const &notification : notifications)
+    {
+        CHECK(notification.fvBytes.size() <= 3 * DCGM_BUFFERED_FV1_MIN_ENTRY_SIZE);
+        numValues += ReadNotification(notification).size();
+    }
+    CHECK(numValues == 10);
+}
@@ -2,6 +2,7 @@
 
 #define DCGM_GPM_TESTS
 #include <DcgmGpmManager.hpp>
+#include <Defer.hpp>
 
 TEST_CASE("GPM maxSampleAge")
 {
@@ -39,3 +40,106 @@ TEST_CASE("GPM maxSampleAge")
     CHECK(maxAge == maxAgeUsec);
     CHECK(gpmEntity.m_maxSampleAge == maxAgeUsec);
 }
+
+TEST_CASE("GPM sample ring")
+{
+    DcgmGpmSampleRing ring;
+    ring.Resize(4);
+    CHECK(ring.Size() == 0);
+    CHECK(ring.Capacity() == 4);
+    CHECK(!ring.FindAtOrBefore(100).has_value());
+
+    for (timelib64_t ts = 10; ts <= 40; ts += 10)
+    {
+        ring.PushBack(ts);
+    }
+    CHECK(ring.Size() == 4);
+
+    /* Wrap around the end of the slots */
+    ring.PopFrontUpTo(20);
+    CHECK(ring.Size() == 2);
+    CHECK(ring.At(0).timestamp == 30);
+    ring.PushBack(50);
+    ring.PushBack(60);
+    CHECK(ring.At(3).timestamp == 60);
+
+    /* A full ring drops its oldest sample */
+    ring.PushBack(70);
+    CHECK(ring.Size() == 4);
+    CHECK(ring.Capacity() == 4);
+    for (std::size_t i = 0; i < ring.Size(); i++)
+    {
+        CHECK(ring.At(i).timestamp == 40 + 10 * static_cast<timelib64_t>(i));
+    }
+
+    CHECK(!ring.FindAtOrBefore(39).has_value());
+    CHECK(ring.FindAtOrBefore(40) == 0);
+    CHECK(ring.FindAtOrBefore(55) == 1);
+    CHECK(ring.FindAtOrBefore(1000) == 3);
+
+    ring.DropBeforeNewest();
+    CHECK(ring.Size() == 3);
+    CHECK(ring.At(1).timestamp == 50);
+    CHECK(ring.At(2).timestamp == 70);
+
+    ring.PopBack();
+    CHECK(ring.Size() == 2);
+    CHECK(ring.FindAtOrBefore(1000) == 1);
+
+    /* Resizing keeps the newest samples */
+    ring.PushBack(80);
+    ring.Resize(2);
+    CHECK(ring.Size() == 2);
+    CHECK(ring.At(0).timestamp == 50);
+    CHECK(ring.At(1).timestamp == 80);
+    ring.Resize(8);
+    CHECK(ring.Size() == 2);
+    CHECK(ring.Capacity() == 8);
+    CHECK(ring.At(1).timestamp == 80);
+}
+
+TEST_CASE("GPM sample ring is sized from the watched intervals")
+{
+    DcgmGpmManagerEntity gpmEntity(dcgmGroupEntityPair_t { DCGM_FE_GPU, 0 });
+    DcgmWatcher watcher;
+
+    gpmEntity.AddWatcher(1001, watcher, 1000000, 10000000, 0);
+    CHECK(gpmEntity.m_gpmSamples.Capacity() == 4);
+    CHECK(gpmEntity.m_minSampleSpacing == 0);
+
+    gpmEntity.AddWatcher(1002, watcher, 10000000, 100000000, 0);
+    CHECK(gpmEntity.m_gpmSamples.Capacity() == 13);
+    CHECK(gpmEntity.m_minSampleSpacing == 0);
+
+    /* Too many samples to keep one per second for an hour. They are thinned out instead */
+    gpmEntity.AddWatcher(1003, watcher, 3600000000, 3600000000, 0);
+    CHECK(gpmEntity.m_gpmSamples.Capacity() == DcgmGpmSampleRing::MaxCapacity);
+    CHECK(gpmEntity.m_minSampleSpacing * (DcgmGpmSampleRing::MaxCapacity - 3) >= 3600000000);
+
+    gpmEntity.RemoveWatcher(1003, watcher);
+    CHECK(gpmEntity.m_gpmSamples.Capacity() == 13);
+    CHECK(gpmEntity.m_minSampleSpacing == 0);
+}
+
+TEST_CASE("GPM watched metrics follow the watchers")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmGpmManagerEntity gpmEntity(dcgmGroupEntityPair_t { DCGM_FE_GPU, 0 });
+    DcgmWatcher watcher;
+    timelib64_t updateIntervalUsec = 1000000;
+
+    CHECK(gpmEntity.m_watchedMetricIds.empty());
+
+    gpmEntity.AddWatcher(DCGM_FI_PROF_GR_ENGINE_ACTIVE, watcher, updateIntervalUsec, updateIntervalUsec * 2, 0);
+    gpmEntity.AddWatcher(DCGM_FI_PROF_SM_ACTIVE, watcher, updateIntervalUsec, updateIntervalUsec * 2, 0);
+    CHECK(gpmEntity.m_watchedMetricIds.size() == 2);
+
+    /* A second watcher of the same field doesn't add its metric again */
+    DcgmWatcher otherWatcher(DcgmWatcherTypeClient, 1);
+    gpmEntity.AddWatcher(DCGM_FI_PROF_SM_ACTIVE, otherWatcher, updateIntervalUsec, updateIntervalUsec * 2, 0);
+    CHECK(gpmEntity.m_watchedMetricIds.size() == 2);
+
+    gpmEntity.RemoveWatcher(DCGM_FI_PROF_GR_ENGINE_ACTIVE, watcher);
+    CHECK(gpmEntity.m_watchedMetricIds.size() == 1);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmGroupWatches.h>
+
+namespace
+{
+dcgmGroupEntityPair_t Gpu(dcgm_field_eid_t gpuId)
+{
+    return { DCGM_FE_GPU, gpuId };
+}
+
+dcgmGroupEntityPair_t GpuI(dcgm_field_eid_t instanceId)
+{
+    return { DCGM_FE_GPU_I, instanceId };
+}
+
+bool Contains(std::vector<dcgmGroupEntityPair_t> const &entities, dcgmGroupEntityPair_t const &entity)
+{
+    for (auto const &other : entities)
+    {
+        if (other.entityGroupId == entity.entityGroupId && other.entityId == entity.entityId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+dcgm_group_watch_params_t const c_params { 1000000, 3600.0, 0, false };
+} // namespace
+
+TEST_CASE("GroupWatches: binding again only returns what changed")
+{
+    DcgmGroupWatches watches;
+    DcgmWatcher const watcher(DcgmWatcherTypeClient, 1);
+
+    auto delta = watches.Bind(5, 2, watcher, c_params, { Gpu(1), Gpu(0), Gpu(1) });
+    CHECK(delta.added.size() == 2);
+    CHECK(delta.removed.empty());
+    CHECK(watches.GetCount() == 1);
+
+    delta = watches.Bind(5, 2, watcher, c_params, { Gpu(0), Gpu(1) });
+    CHECK(delta.Empty());
+
+    delta = watches.Bind(5, 2, watcher, c_params, { Gpu(1), Gpu(2) });
+    REQUIRE(delta.added.size() == 1);
+    CHECK(Contains(delta.added, Gpu(2)));
+    REQUIRE(delta.removed.size() == 1);
+    CHECK(Contains(delta.removed, Gpu(0)));
+    CHECK(watches.GetCount() == 1);
+
+    /* New params have to be applied to every entity */
+    dcgm_group_watch_params_t faster = c_params;
+    faster.monitorIntervalUsec       = 100000;
+    delta                            = watches.Bind(5, 2, watcher, faster, { Gpu(1), Gpu(2) });
+    CHECK(delta.added.size() == 2);
+    CHECK(delta.removed.empty());
+    CHECK(delta.params == faster);
+}
+
+TEST_CASE("GroupWatches: group changes reach every watch of the group")
+{
+    DcgmGroupWatches watches;
+    DcgmWatcher const first(DcgmWatcherTypeClient, 1);
+    DcgmWatcher const second(DcgmWatcherTypeClient, 2);
+
+    watches.Bind(5, 2, first, c_params, { Gpu(0) });
+    watches.Bind(5, 3, second, c_params, { Gpu(0) });
+    watches.Bind(6, 2, first, c_params, { Gpu(0) });
+    CHECK(watches.HasGroup(5));
+    CHECK(!watches.HasGroup(7));
+
+    auto deltas = watches.SetGroupEntities(5, { Gpu(0), GpuI(3) });
+    REQUIRE(deltas.size() == 2);
+    for (auto const &delta : deltas)
+    {
+        CHECK(delta.groupId == 5);
+        REQUIRE(delta.added.size() == 1);
+        CHECK(Contains(delta.added, GpuI(3)));
+        CHECK(delta.removed.empty());
+    }
+    CHECK(deltas[0].fieldGroupId != deltas[1].fieldGroupId);
+
+    /* Nothing changed since */
+    CHECK(watches.SetGroupEntities(5, { GpuI(3), Gpu(0) }).empty());
+
+    deltas = watches.SetGroupEntities(5, { GpuI(3) });
+    REQUIRE(deltas.size() == 2);
+    CHECK(deltas[0].added.empty());
+    REQUIRE(deltas[0].removed.size() == 1);
+    CHECK(Contains(deltas[0].removed, Gpu(0)));
+
+    /* The other group kept its entities */
+    std::vector<dcgmGroupEntityPair_t> entities;
+    REQUIRE(watches.Unbind(6, 2, first, entities));
+    REQUIRE(entities.size() == 1);
+    CHECK(Contains(entities, Gpu(0)));
+}
+
+TEST_CASE("GroupWatches: unbinding returns the watched entities")
+{
+    DcgmGroupWatches watches;
+    DcgmWatcher const watcher(DcgmWatcherTypeClient, 1);
+    std::vector<dcgmGroupEntityPair_t> entities;
+
+    CHECK(!watches.Unbind(5, 2, watcher, entities));
+
+    watches.Bind(5, 2, watcher, c_params, { Gpu(0) });
+    watches.SetGroupEntities(5, { Gpu(0), Gpu(1) });
+    REQUIRE(watches.Unbind(5, 2, watcher, entities));
+    CHECK(entities.size() == 2);
+    CHECK(watches.GetCount() == 0);
+    CHECK(!watches.Unbind(5, 2, watcher, entities));
+}
+
+TEST_CASE("GroupWatches: removing a group or connection drops its bindings")
+{
+    DcgmGroupWatches watches;
+    DcgmWatcher const first(DcgmWatcherTypeClient, 1);
+    DcgmWatcher const second(DcgmWatcherTypeClient, 2);
+
+    watches.Bind(5, 2, first, c_params, { Gpu(0) });
+    watches.Bind(5, 2, second, c_params, { Gpu(0) });
+    watches.Bind(6, 2, first, c_params, { Gpu(0) });
+    CHECK(watches.GetCount() == 3);
+
+    watches.RemoveConnection(1);
+    CHECK(watches.GetCount() == 1);
+    CHECK(!watches.HasGroup(6));
+
+    watches.RemoveGroup(5);
+    CHECK(watches.GetCount() == 0);
+    CHECK(watches.SetGroupEntities(5, { Gpu(1) }).empty());
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmInflightRequests.h>
+
+#include <thread>
+
+TEST_CASE("InflightRequests: cancelling stops the request of the calling thread")
+{
+    DcgmInflightRequests inflight;
+
+    CHECK(!DcgmInflightRequests::ShouldStop());
+    CHECK(inflight.Cancel(1, 10).empty());
+
+    {
+        DcgmInflightRequests::Scope scope(inflight, 1, 10, 0);
+        inflight.SetCurrentCommand(DcgmModuleIdDiag, 7);
+        CHECK(!DcgmInflightRequests::ShouldStop());
+
+        /* Other requests and connections are left alone */
+        CHECK(inflight.Cancel(1, 11).empty());
+        CHECK(inflight.Cancel(2, DCGM_REQUEST_ID_NONE).empty());
+        CHECK(!DcgmInflightRequests::ShouldStop());
+
+        auto commands = inflight.Cancel(1, 10);
+        REQUIRE(commands.size() == 1);
+        CHECK(commands[0].moduleId == DcgmModuleIdDiag);
+        CHECK(commands[0].subCommand == 7);
+        CHECK(DcgmInflightRequests::ShouldStop());
+    }
+
+    /* Done with the request */
+    CHECK(!DcgmInflightRequests::ShouldStop());
+    CHECK(inflight.Cancel(1, 10).empty());
+}
+
+TEST_CASE("InflightRequests: a closed connection stops all of its requests")
+{
+    DcgmInflightRequests inflight;
+
+    DcgmInflightRequests::Scope outer(inflight, 1, 10, 0);
+    {
+        std::vector<dcgm_inflight_command_t> commands;
+        std::thread other([&] {
+            DcgmInflightRequests::Scope scope(inflight, 1, 11, 0);
+            commands = inflight.Cancel(1, DCGM_REQUEST_ID_NONE);
+            CHECK(DcgmInflightRequests::ShouldStop());
+        });
+        other.join();
+        CHECK(commands.size() == 2);
+    }
+    CHECK(DcgmInflightRequests::ShouldStop());
+}
+
+TEST_CASE("InflightRequests: requests stop once their deadline passed")
+{
+    DcgmInflightRequests inflight;
+
+    DcgmInflightRequests::Scope outer(inflight, 1, 10, 60000);
+    CHECK(!DcgmInflightRequests::ShouldStop());
+
+    {
+        DcgmInflightRequests::Scope inner(inflight, 1, 11, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        CHECK(DcgmInflightRequests::ShouldStop());
+    }
+
+    /* Back to the outer request */
+    CHECK(!DcgmInflightRequests::ShouldStop());
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmIpcCompress.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace
+{
+std::vector<char> MakeFieldValueLikeBytes(size_t count)
+{
+    /* Fixed-size records with repeating IDs and slowly moving timestamps and values */
+    struct Record
+    {
+        std::int32_t entityId;
+        std::uint16_t fieldId;
+        std::uint16_t fieldType;
+        std::int64_t timestamp;
+        double value;
+    };
+
+    std::vector<char> bytes(count * sizeof(Record));
+    for (size_t i = 0; i < count; i++)
+    {
+        Record record { (std::int32_t)(i % 8), 150, 'd', 1700000000000000 + (std::int64_t)i * 1000, 35.0 + (i % 3) };
+        memcpy(bytes.data() + i * sizeof(Record), &record, sizeof(record));
+    }
+    return bytes;
+}
+} // namespace
+
+TEST_CASE("IpcCompress: Round trip")
+{
+    std::vector<char> compressed;
+    std::vector<char> decompressed;
+
+    SECTION("Compressible")
+    {
+        auto original = MakeFieldValueLikeBytes(5000);
+        REQUIRE(DcgmIpcCompress::Compress(original.data(), original.size(), compressed));
+        CHECK(compressed.size() < original.size() / 2);
+
+        REQUIRE(DcgmIpcCompress::Decompress(compressed.data(), compressed.size(), original.size(), decompressed)
+                == DCGM_ST_OK);
+        CHECK(decompressed == original);
+    }
+
+    SECTION("Long runs use extended lengths")
+    {
+        std::vector<char> original(100000, 'x');
+        original[50000] = 'y';
+        REQUIRE(DcgmIpcCompress::Compress(original.data(), original.size(), compressed));
+        CHECK(compressed.size() < 1000);
+
+        REQUIRE(DcgmIpcCompress::Decompress(compressed.data(), compressed.size(), original.size(), decompressed)
+                == DCGM_ST_OK);
+        CHECK(decompressed == original);
+    }
+
+    SECTION("Incompressible")
+    {
+        std::vector<char> original(4096);
+        std::mt19937 rng(7);
+        for (auto &c : original)
+        {
+            c = (char)rng();
+        }
+        CHECK(!DcgmIpcCompress::Compress(original.data(), original.size(), compressed));
+
+        /* Too small to bother with */
+        CHECK(!DcgmIpcCompress::Compress("aaaaaaaa", 8, compressed));
+    }
+}
+
+TEST_CASE("IpcCompress: Malformed input is rejected")
+{
+    auto original = MakeFieldValueLikeBytes(1000);
+    std::vector<char> compressed;
+    std::vector<char> decompressed;
+    REQUIRE(DcgmIpcCompress::Compress(original.data(), original.size(), compressed));
+
+    /* Wrong expected length */
+    CHECK(DcgmIpcCompress::Decompress(compressed.data(), compressed.size(), original.size() - 1, decompressed)
+          == DCGM_ST_BADPARAM);
+    CHECK(DcgmIpcCompress::Decompress(compressed.data(), compressed.size(), original.size() + 1, decompressed)
+          == DCGM_ST_BADPARAM);
+
+    /* Truncated */
+    CHECK(DcgmIpcCompress::Decompress(compressed.data(), compressed.size() / 2, original.size(), decompressed)
+          == DCGM_ST_BADPARAM);
+
+    /* A match that points before the start of the output */
+    char const badOffset[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+    CHECK(DcgmIpcCompress::Decompress(badOffset, sizeof(badOffset), 5, decompressed) == DCGM_ST_BADPARAM);
+
+    /* Literal length that runs past the input */
+    char const badLiterals[] = { (char)0xF0, (char)0xFF, (char)0xFF, 0x10 };
+    CHECK(DcgmIpcCompress::Decompress(badLiterals, sizeof(badLiterals), 1000, decompressed) == DCGM_ST_BADPARAM);
+}
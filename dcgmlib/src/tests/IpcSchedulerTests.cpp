@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmIpcScheduler.h>
+
+#include <thread>
+
+namespace
+{
+std::unique_ptr<DcgmMessage> MakeMessage(dcgm_request_id_t requestId, int timeoutMs = 0)
+{
+    auto message = std::make_unique<DcgmMessage>();
+    message->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, requestId, DCGM_ST_OK, 0);
+    message->GetMessageHdr()->timeoutMs = timeoutMs;
+    return message;
+}
+} // namespace
+
+TEST_CASE("IpcScheduler: Connections are served round-robin")
+{
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> processed;
+    std::vector<dcgm_connection_id_t> disconnected;
+    std::vector<dcgm_connection_id_t> resumed;
+
+    DcgmIpcScheduler scheduler(
+        4,
+        [&](dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message) {
+            processed.emplace_back(connectionId, message->GetRequestId());
+        },
+        [&](dcgm_connection_id_t connectionId) { disconnected.push_back(connectionId); },
+        [&](dcgm_connection_id_t connectionId) { resumed.push_back(connectionId); });
+
+    /* Connection 1 floods. It's throttled once it has 4 waiting */
+    CHECK(!scheduler.Push(1, MakeMessage(10)));
+    CHECK(!scheduler.Push(1, MakeMessage(11)));
+    CHECK(!scheduler.Push(1, MakeMessage(12)));
+    CHECK(scheduler.Push(1, MakeMessage(13)));
+    CHECK(!scheduler.Push(1, MakeMessage(14))); /* Already throttled */
+
+    /* Connection 2 shows up late and disconnects once its request was served */
+    CHECK(!scheduler.Push(2, MakeMessage(20)));
+
+    auto stats = scheduler.GetStats();
+    REQUIRE(stats.size() == 2);
+
+    scheduler.RunNext();
+    scheduler.RunNext();
+    scheduler.PushDisconnect(2);
+
+    for (int i = 0; i < 5; i++)
+    {
+        scheduler.RunNext();
+    }
+    scheduler.RunNext(); /* Nothing left. This is a no-op */
+
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> expected
+        = { { 1, 10 }, { 2, 20 }, { 1, 11 }, { 1, 12 }, { 1, 13 }, { 1, 14 } };
+    CHECK(processed == expected);
+
+    /* The disconnect came after connection 2's message, and 2 is no longer tracked */
+    CHECK(disconnected == std::vector<dcgm_connection_id_t> { 2 });
+
+    /* 1 was resumed once it drained to half of the bound */
+    CHECK(resumed == std::vector<dcgm_connection_id_t> { 1 });
+
+    stats = scheduler.GetStats();
+    REQUIRE(stats.size() == 1);
+    CHECK(stats[0].connectionId == 1);
+    CHECK(stats[0].depth == 0);
+    CHECK(stats[0].maxDepth == 5);
+    CHECK(stats[0].processed == 5);
+    CHECK(stats[0].throttled == 1);
+    CHECK(stats[0].maxWaitUsec * stats[0].processed >= stats[0].totalWaitUsec);
+}
+
+TEST_CASE("IpcScheduler: Per-connection serving")
+{
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> processed;
+    std::vector<dcgm_connection_id_t> disconnected;
+
+    DcgmIpcScheduler scheduler(
+        4,
+        [&](dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message) {
+            processed.emplace_back(connectionId, message->GetRequestId());
+        },
+        [&](dcgm_connection_id_t connectionId) { disconnected.push_back(connectionId); },
+        [](dcgm_connection_id_t) {},
+        true);
+
+    REQUIRE(scheduler.IsPerConnection());
+
+    CHECK(!scheduler.Push(1, MakeMessage(10)));
+    CHECK(!scheduler.Push(1, MakeMessage(11)));
+    CHECK(!scheduler.Push(2, MakeMessage(20)));
+
+    /* No round-robin line is kept */
+    scheduler.RunNext();
+    CHECK(processed.empty());
+
+    scheduler.RunNext(2);
+    scheduler.PushDisconnect(2);
+    scheduler.RunNext(2);
+    scheduler.RunNext(2); /* 2 is gone. This is a no-op */
+    scheduler.RunNext(1);
+    scheduler.RunNext(1);
+
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> expected = { { 2, 20 }, { 1, 10 }, { 1, 11 } };
+    CHECK(processed == expected);
+    CHECK(disconnected == std::vector<dcgm_connection_id_t> { 2 });
+
+    auto stats = scheduler.GetStats();
+    REQUIRE(stats.size() == 1);
+    CHECK(stats[0].connectionId == 1);
+    CHECK(stats[0].processed == 2);
+}
+
+TEST_CASE("IpcScheduler: Work nobody waits for is dropped")
+{
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> processed;
+    std::vector<int> timeouts;
+    std::vector<dcgm_connection_id_t> disconnected;
+    std::vector<dcgm_connection_id_t> resumed;
+
+    DcgmIpcScheduler scheduler(
+        4,
+        [&](dcgm_connection_id_t connectionId, std::unique_ptr<DcgmMessage> message) {
+            processed.emplace_back(connectionId, message->GetRequestId());
+            timeouts.push_back(message->GetMessageHdr()->timeoutMs);
+        },
+        [&](dcgm_connection_id_t connectionId) { disconnected.push_back(connectionId); },
+        [&](dcgm_connection_id_t connectionId) { resumed.push_back(connectionId); });
+
+    /* Cancelled while queued. Dropping enough of them resumes a throttled connection */
+    CHECK(!scheduler.Push(1, MakeMessage(10)));
+    CHECK(!scheduler.Push(1, MakeMessage(11)));
+    CHECK(!scheduler.Push(1, MakeMessage(12)));
+    CHECK(scheduler.Push(1, MakeMessage(13)));
+    CHECK(scheduler.Cancel(1, 11));
+    CHECK(!scheduler.Cancel(1, 11));
+    CHECK(!scheduler.Cancel(2, 11));
+    CHECK(resumed.empty());
+    CHECK(scheduler.Cancel(1, 12));
+    CHECK(resumed == std::vector<dcgm_connection_id_t> { 1 });
+    CHECK(scheduler.Cancel(1, 13));
+    CHECK(scheduler.Cancel(1, 10));
+
+    /* 1 has nothing left and is out of line */
+    scheduler.RunNext();
+    CHECK(processed.empty());
+
+    /* The timeout counts from when the request was read. The rest of it is passed on */
+    CHECK(!scheduler.Push(1, MakeMessage(14, 1)));
+    CHECK(!scheduler.Push(1, MakeMessage(15, 60000)));
+    CHECK(!scheduler.Push(1, MakeMessage(16)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    scheduler.RunNext();
+    scheduler.RunNext();
+    scheduler.RunNext();
+
+    std::vector<std::pair<dcgm_connection_id_t, dcgm_request_id_t>> expected = { { 1, 15 }, { 1, 16 } };
+    CHECK(processed == expected);
+    REQUIRE(timeouts.size() == 2);
+    CHECK(timeouts[0] > 0);
+    CHECK(timeouts[0] <= 60000 - 5);
+    CHECK(timeouts[1] == 0);
+
+    /* The rest of a connection is dropped once it's gone */
+    CHECK(!scheduler.Push(1, MakeMessage(17)));
+    CHECK(!scheduler.Push(1, MakeMessage(18)));
+
+    auto stats = scheduler.GetStats();
+    REQUIRE(stats.size() == 1);
+    CHECK(stats[0].processed == 2);
+    CHECK(stats[0].dropped == 5);
+
+    scheduler.PushDisconnect(1);
+    scheduler.RunNext();
+    scheduler.RunNext();
+    CHECK(processed.size() == 2);
+    CHECK(disconnected == std::vector<dcgm_connection_id_t> { 1 });
+    CHECK(scheduler.GetStats().empty());
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmIpcShmRing.h>
+
+#include <unistd.h>
+
+TEST_CASE("IpcShmRing: Payloads round trip in order and wrap")
+{
+    auto consumer = DcgmIpcShmRing::Create(1000);
+    REQUIRE(consumer != nullptr);
+
+    /* Wrong capacity, name or owner is refused */
+    CHECK(DcgmIpcShmRing::Attach(consumer->GetName(), 2000, getuid()) == nullptr);
+    CHECK(DcgmIpcShmRing::Attach("../etc/passwd", 1000, getuid()) == nullptr);
+    CHECK(DcgmIpcShmRing::Attach(consumer->GetName(), 1000, getuid() + 1) == nullptr);
+
+    auto producer = DcgmIpcShmRing::Attach(consumer->GetName(), 1000, getuid());
+    REQUIRE(producer != nullptr);
+
+    /* The name is gone once attached */
+    CHECK(DcgmIpcShmRing::Attach(consumer->GetName(), 1000, getuid()) == nullptr);
+
+    std::vector<char> payload(300);
+    std::vector<char> received;
+    std::uint64_t offsets[3] = {};
+
+    for (int i = 0; i < 3; i++)
+    {
+        std::fill(payload.begin(), payload.end(), (char)('a' + i));
+        REQUIRE(producer->Write(payload.data(), payload.size(), offsets[i]));
+    }
+
+    /* 900 of 1000 bytes are in use */
+    std::uint64_t fullOffset = 0;
+    CHECK(!producer->Write(payload.data(), payload.size(), fullOffset));
+
+    /* Payloads must be read in order */
+    CHECK(consumer->Read(offsets[1], payload.size(), received) == DCGM_ST_BADPARAM);
+
+    REQUIRE(consumer->Read(offsets[0], payload.size(), received) == DCGM_ST_OK);
+    CHECK(received == std::vector<char>(300, 'a'));
+
+    /* 300 bytes are free but not contiguous at the end of the ring. This one skips to the start */
+    std::uint64_t wrapOffset = 0;
+    std::fill(payload.begin(), payload.end(), 'd');
+    REQUIRE(producer->Write(payload.data(), payload.size(), wrapOffset));
+    CHECK(wrapOffset == 1000);
+
+    REQUIRE(consumer->Read(offsets[1], payload.size(), received) == DCGM_ST_OK);
+    CHECK(received == std::vector<char>(300, 'b'));
+    REQUIRE(consumer->Read(offsets[2], payload.size(), received) == DCGM_ST_OK);
+    CHECK(received == std::vector<char>(300, 'c'));
+    REQUIRE(consumer->Read(wrapOffset, payload.size(), received) == DCGM_ST_OK);
+    CHECK(received == std::vector<char>(300, 'd'));
+
+    /* Too big for the ring at all */
+    std::vector<char> huge(1001);
+    CHECK(!producer->Write(huge.data(), huge.size(), fullOffset));
+}
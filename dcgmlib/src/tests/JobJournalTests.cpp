@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmJobJournal.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+std::string GetJournalTestPath()
+{
+    return "/tmp/dcgm_job_journal_test_" + std::to_string(getpid());
+}
+
+std::unique_ptr<dcgmJobInfo_t> MakeJobInfo(int numGpus, long long endTime)
+{
+    auto jobInfo                    = std::make_unique<dcgmJobInfo_t>();
+    jobInfo->version                = dcgmJobInfo_version;
+    jobInfo->numGpus                = numGpus;
+    jobInfo->summary.startTime      = endTime - 1000;
+    jobInfo->summary.endTime        = endTime;
+    jobInfo->summary.energyConsumed = 100 * numGpus;
+    for (int i = 0; i < numGpus; i++)
+    {
+        jobInfo->gpus[i].gpuId          = i;
+        jobInfo->gpus[i].energyConsumed = 100;
+    }
+    return jobInfo;
+}
+} // namespace
+
+TEST_CASE("JobJournal: Append and get")
+{
+    std::string const path = GetJournalTestPath();
+    unlink(path.c_str());
+
+    DcgmJobJournal journal;
+    REQUIRE(journal.Open(path) == DCGM_ST_OK);
+    CHECK(journal.GetRecordCount() == 0);
+
+    REQUIRE(journal.Append("job1", *MakeJobInfo(2, 5000)) == DCGM_ST_OK);
+    REQUIRE(journal.Append("job2", *MakeJobInfo(8, 6000)) == DCGM_ST_OK);
+    CHECK(journal.GetRecordCount() == 2);
+
+    auto jobInfo = std::make_unique<dcgmJobInfo_t>();
+    REQUIRE(journal.Get("job2", *jobInfo) == DCGM_ST_OK);
+    CHECK(jobInfo->version == dcgmJobInfo_version);
+    CHECK(jobInfo->numGpus == 8);
+    CHECK(jobInfo->summary.endTime == 6000);
+    CHECK(jobInfo->summary.energyConsumed == 800);
+    CHECK(jobInfo->gpus[7].gpuId == 7);
+    CHECK(jobInfo->gpus[8].gpuId == 0);
+
+    CHECK(journal.Get("job3", *jobInfo) == DCGM_ST_NO_DATA);
+    CHECK(journal.Append(std::string(64, 'j'), *MakeJobInfo(1, 7000)) == DCGM_ST_BADPARAM);
+
+    unlink(path.c_str());
+}
+
+TEST_CASE("JobJournal: Reopen")
+{
+    std::string const path = GetJournalTestPath();
+    unlink(path.c_str());
+
+    {
+        DcgmJobJournal journal;
+        REQUIRE(journal.Open(path) == DCGM_ST_OK);
+        REQUIRE(journal.Append("job1", *MakeJobInfo(2, 5000)) == DCGM_ST_OK);
+        REQUIRE(journal.Append("job2", *MakeJobInfo(8, 6000)) == DCGM_ST_OK);
+    }
+
+    DcgmJobJournal journal;
+    REQUIRE(journal.Open(path) == DCGM_ST_OK);
+    CHECK(journal.GetRecordCount() == 2);
+
+    auto jobInfo = std::make_unique<dcgmJobInfo_t>();
+    REQUIRE(journal.Get("job1", *jobInfo) == DCGM_ST_OK);
+    CHECK(jobInfo->numGpus == 2);
+    CHECK(jobInfo->summary.startTime == 4000);
+
+    /* The latest record of a job ID wins */
+    REQUIRE(journal.Append("job1", *MakeJobInfo(1, 9000)) == DCGM_ST_OK);
+    REQUIRE(journal.Get("job1", *jobInfo) == DCGM_ST_OK);
+    CHECK(jobInfo->numGpus == 1);
+    CHECK((journal.GetJobIdsEndedBetween(0, 10000) == std::vector<std::string> { "job2", "job1" }));
+    CHECK((journal.GetJobIdsEndedBetween(5500, 6000) == std::vector<std::string> { "job2" }));
+
+    unlink(path.c_str());
+}
+
+TEST_CASE("JobJournal: Grows past the initial file size")
+{
+    std::string const path = GetJournalTestPath();
+    unlink(path.c_str());
+
+    DcgmJobJournal journal;
+    REQUIRE(journal.Open(path) == DCGM_ST_OK);
+    REQUIRE(journal.Append("first", *MakeJobInfo(2, 5000)) == DCGM_ST_OK);
+
+    auto jobInfo = MakeJobInfo(DCGM_MAX_NUM_DEVICES, 10000);
+    for (int i = 0; i < 100; i++)
+    {
+        REQUIRE(journal.Append("job" + std::to_string(i), *jobInfo) == DCGM_ST_OK);
+    }
+    CHECK(journal.GetRecordCount() == 101);
+
+    REQUIRE(journal.Get("first", *jobInfo) == DCGM_ST_OK);
+    CHECK(jobInfo->numGpus == 2);
+    REQUIRE(journal.Get("job99", *jobInfo) == DCGM_ST_OK);
+    CHECK(jobInfo->numGpus == DCGM_MAX_NUM_DEVICES);
+
+    unlink(path.c_str());
+}
+
+TEST_CASE("JobJournal: Not a journal")
+{
+    std::string const path = GetJournalTestPath();
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "not a job journal, but long enough to hold the header";
+    }
+
+    DcgmJobJournal journal;
+    CHECK(journal.Open(path) == DCGM_ST_VER_MISMATCH);
+    CHECK(journal.Append("job1", *MakeJobInfo(1, 1000)) == DCGM_ST_UNINITIALIZED);
+
+    unlink(path.c_str());
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmJobStats.h>
+#include <dcgm_fields.h>
+
+#include <vector>
+
+namespace
+{
+DcgmcmSummaryType_t const c_allTypes[] = { DcgmcmSummaryTypeMinimum, DcgmcmSummaryTypeMaximum,
+                                           DcgmcmSummaryTypeAverage, DcgmcmSummaryTypeSum,
+                                           DcgmcmSummaryTypeCount,   DcgmcmSummaryTypeIntegral,
+                                           DcgmcmSummaryTypeDifference };
+} // namespace
+
+TEST_CASE("JobStats: Accumulator summaries")
+{
+    DcgmJobFieldAccumulator<long long> accumulator;
+    long long values[7];
+
+    SECTION("No samples")
+    {
+        CHECK(accumulator.Summarize(7, c_allTypes, values) == DCGM_ST_NO_DATA);
+        CHECK(values[0] == DCGM_INT64_BLANK);
+    }
+
+    SECTION("Samples")
+    {
+        accumulator.Add(1000, 10, false);
+        accumulator.Add(2000, 30, false);
+        accumulator.Add(4000, 20, false);
+
+        REQUIRE(accumulator.Summarize(7, c_allTypes, values) == DCGM_ST_OK);
+        CHECK(values[0] == 10);
+        CHECK(values[1] == 30);
+        CHECK(values[2] == 20);
+        CHECK(values[3] == 60);
+        CHECK(values[4] == 3);
+        CHECK(values[5] == 20 * 1000 + 25 * 2000);
+        CHECK(values[6] == 10);
+    }
+
+    SECTION("Blank samples")
+    {
+        accumulator.Add(1000, 10, false);
+        accumulator.Add(2000, DCGM_INT64_BLANK, true);
+        accumulator.Add(3000, 20, false);
+        accumulator.Add(4000, 40, false);
+
+        REQUIRE(accumulator.Summarize(7, c_allTypes, values) == DCGM_ST_OK);
+        CHECK(values[0] == 10);
+        CHECK(values[1] == 40);
+        CHECK(values[2] == 70 / 4);
+        CHECK(values[4] == 4);
+        /* Nothing is integrated next to the blank */
+        CHECK(values[5] == 30 * 1000);
+        CHECK(values[6] == 30);
+    }
+
+    SECTION("Only blank samples")
+    {
+        accumulator.Add(1000, DCGM_INT64_BLANK, true);
+
+        CHECK(accumulator.Summarize(7, c_allTypes, values) == DCGM_ST_OK);
+        CHECK(values[0] == DCGM_INT64_BLANK);
+        CHECK(values[6] == DCGM_INT64_BLANK);
+    }
+}
+
+TEST_CASE("JobStats: Fields are watched while a job runs on their GPU")
+{
+    DcgmJobStats jobStats;
+
+    CHECK(jobStats.StartJob("a", 1000, { 0, 1 }) == std::vector<unsigned int> { 0, 1 });
+    CHECK(jobStats.StartJob("b", 1000, { 1, 2 }) == std::vector<unsigned int> { 2 });
+    CHECK(jobStats.StartJob("a", 1000, { 3 }).empty());
+
+    CHECK(jobStats.StopJob("a", 2000) == std::vector<unsigned int> { 0 });
+    CHECK(jobStats.StopJob("a", 3000).empty());
+    CHECK(jobStats.RemoveJob("a").empty());
+    CHECK(jobStats.RemoveJob("b") == std::vector<unsigned int> { 1, 2 });
+
+    std::vector<unsigned int> gpuIds;
+    CHECK(jobStats.GetGpuIds("b", gpuIds) == DCGM_ST_NO_DATA);
+
+    jobStats.StartJob("c", 1000, { 4 });
+    CHECK(jobStats.GetGpuIds("c", gpuIds) == DCGM_ST_OK);
+    CHECK(gpuIds == std::vector<unsigned int> { 4 });
+    CHECK(jobStats.RemoveAllJobs() == std::vector<unsigned int> { 4 });
+}
+
+TEST_CASE("JobStats: Update")
+{
+    DcgmJobStats jobStats;
+    DcgmcmSummaryType_t const maxType = DcgmcmSummaryTypeMaximum;
+    long long maxValue;
+    double maxPower;
+
+    jobStats.StartJob("a", 1000, { 0 });
+    jobStats.StartJob("b", 3000, { 0, 1 });
+
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_UTIL, 50, 2000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_UTIL, 70, 3000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 1, DCGM_FI_DEV_GPU_UTIL, 90, 3000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 2, DCGM_FI_DEV_GPU_UTIL, 99, 3000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 80, 3000, DCGM_ST_OK);
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, 1, DCGM_FI_DEV_POWER_USAGE, 200.0, 3000, DCGM_ST_OK);
+    for (int i = 0; i < 12; i++)
+    {
+        fvBuffer.AddInt64Value(DCGM_FE_GPU, 1, DCGM_FI_DEV_XID_ERRORS, 79, 3000 + i, DCGM_ST_OK);
+    }
+    jobStats.Update(fvBuffer);
+
+    REQUIRE(jobStats.GetInt64Summary("a", 0, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_OK);
+    CHECK(maxValue == 70);
+    /* Job b started after the first sample */
+    REQUIRE(jobStats.GetInt64Summary("b", 0, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_OK);
+    CHECK(maxValue == 70);
+    REQUIRE(jobStats.GetInt64Summary("b", 1, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_OK);
+    CHECK(maxValue == 90);
+    REQUIRE(jobStats.GetFp64Summary("b", 1, DCGM_FI_DEV_POWER_USAGE, 1, &maxType, &maxPower) == DCGM_ST_OK);
+    CHECK(maxPower == 200.0);
+
+    /* Neither a job field nor a job GPU */
+    CHECK(jobStats.GetInt64Summary("a", 0, DCGM_FI_DEV_GPU_TEMP, 1, &maxType, &maxValue) == DCGM_ST_NO_DATA);
+    CHECK(jobStats.GetInt64Summary("a", 1, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_NO_DATA);
+    CHECK(jobStats.GetInt64Summary("c", 0, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_NO_DATA);
+
+    std::vector<timelib64_t> xidTimestamps = jobStats.GetXidTimestamps("b", 1);
+    REQUIRE(xidTimestamps.size() == DcgmJobStats::c_maxXidTimestamps);
+    CHECK(xidTimestamps[0] == 3000);
+
+    /* Values after a job stopped are left out of it */
+    jobStats.StopJob("a", 4000);
+    DcgmFvBuffer laterBuffer;
+    laterBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_UTIL, 100, 5000, DCGM_ST_OK);
+    laterBuffer.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_UTIL, 0, 6000, DCGM_ST_NOT_SUPPORTED);
+    jobStats.Update(laterBuffer);
+
+    REQUIRE(jobStats.GetInt64Summary("a", 0, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_OK);
+    CHECK(maxValue == 70);
+    REQUIRE(jobStats.GetInt64Summary("b", 0, DCGM_FI_DEV_GPU_UTIL, 1, &maxType, &maxValue) == DCGM_ST_OK);
+    CHECK(maxValue == 100);
+
+    DcgmcmSummaryType_t const countType = DcgmcmSummaryTypeCount;
+    REQUIRE(jobStats.GetInt64Summary("b", 0, DCGM_FI_DEV_GPU_UTIL, 1, &countType, &maxValue) == DCGM_ST_OK);
+    CHECK(maxValue == 3);
+}
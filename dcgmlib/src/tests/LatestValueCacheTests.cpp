@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmLatestValueCache.h>
+#include <dcgm_fields.h>
+#include <timeseries.h>
+
+TEST_CASE("LatestValueCache: Publish, Get and Unpublish")
+{
+    DcgmLatestValueCache cache;
+    dcgm_entity_key_t gpu0Key { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    dcgm_entity_key_t gpu1Key { 1, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    dcgmcm_latest_value_t value {};
+
+    CHECK(cache.Get(gpu0Key, value) == false);
+    CHECK(cache.GetMissCount() == 1);
+
+    value.timestamp = 1000;
+    value.tsType    = TS_TYPE_INT64;
+    value.val.i64   = 42;
+    cache.Publish(gpu0Key, value);
+
+    dcgmcm_latest_value_t readValue {};
+    REQUIRE(cache.Get(gpu0Key, readValue) == true);
+    CHECK(readValue.timestamp == 1000);
+    CHECK(readValue.tsType == TS_TYPE_INT64);
+    CHECK(readValue.val.i64 == 42);
+    CHECK(cache.GetHitCount() == 1);
+
+    /* Other entities of the same field are independent */
+    CHECK(cache.Get(gpu1Key, readValue) == false);
+
+    value.timestamp = 2000;
+    value.val.i64   = 43;
+    cache.Publish(gpu0Key, value);
+    REQUIRE(cache.Get(gpu0Key, readValue) == true);
+    CHECK(readValue.val.i64 == 43);
+
+    cache.Unpublish(gpu0Key);
+    CHECK(cache.Get(gpu0Key, readValue) == false);
+
+    cache.Publish(gpu0Key, value);
+    cache.Publish(gpu1Key, value);
+    cache.Clear();
+    CHECK(cache.Get(gpu0Key, readValue) == false);
+    CHECK(cache.Get(gpu1Key, readValue) == false);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmLatestValueSlots.h>
+#include <dcgm_fields.h>
+#include <timeseries.h>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("LatestValueSlots: Reserve, Publish and Read")
+{
+    DcgmLatestValueSlots slots(2);
+    dcgm_entity_key_t gpu0Key { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    dcgm_entity_key_t gpu1Key { 1, DCGM_FI_DEV_POWER_USAGE, DCGM_FE_GPU };
+    dcgm_entity_key_t gpu2Key { 2, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+
+    CHECK(slots.Find(gpu0Key) == DcgmLatestValueSlots::c_noSlot);
+
+    unsigned int readSlots[3];
+    readSlots[0] = slots.Reserve(gpu0Key);
+    readSlots[1] = slots.Reserve(gpu1Key);
+    readSlots[2] = slots.Reserve(gpu2Key);
+    CHECK(readSlots[0] == 0);
+    CHECK(readSlots[1] == 1);
+    CHECK(readSlots[2] == DcgmLatestValueSlots::c_noSlot); /* Full */
+    CHECK(slots.Reserve(gpu0Key) == 0);                    /* Reserving again returns the same slot */
+    CHECK(slots.Find(gpu1Key) == 1);
+    CHECK(slots.GetNumReserved() == 2);
+
+    dcgmLatestValueSample_t samples[3];
+    slots.Read(readSlots, 3, samples);
+    CHECK(samples[0].status == DCGM_ST_NO_DATA);
+    CHECK(samples[0].entityId == 0);
+    CHECK(samples[0].fieldId == DCGM_FI_DEV_GPU_TEMP);
+    CHECK(samples[1].status == DCGM_ST_NO_DATA);
+    CHECK(samples[2].status == DCGM_ST_BADPARAM);
+
+    dcgmcm_latest_value_t value {};
+    value.timestamp = 1000;
+    value.tsType    = TS_TYPE_INT64;
+    value.val.i64   = 42;
+    slots.Publish(readSlots[0], value);
+
+    value.timestamp = 2000;
+    value.tsType    = TS_TYPE_DOUBLE;
+    value.val.d     = 123.5;
+    slots.Publish(readSlots[1], value);
+
+    slots.Read(readSlots, 2, samples);
+    CHECK(samples[0].status == DCGM_ST_OK);
+    CHECK(samples[0].fieldType == DCGM_FT_INT64);
+    CHECK(samples[0].ts == 1000);
+    CHECK(samples[0].value.i64 == 42);
+    CHECK(samples[1].status == DCGM_ST_OK);
+    CHECK(samples[1].entityGroupId == DCGM_FE_GPU);
+    CHECK(samples[1].entityId == 1);
+    CHECK(samples[1].fieldType == DCGM_FT_DOUBLE);
+    CHECK(samples[1].ts == 2000);
+    CHECK(samples[1].value.dbl == 123.5);
+
+    slots.Unpublish(readSlots[0]);
+    slots.Read(readSlots, 2, samples);
+    CHECK(samples[0].status == DCGM_ST_NO_DATA);
+    CHECK(samples[1].status == DCGM_ST_OK);
+
+    slots.UnpublishAll();
+    slots.Read(readSlots, 2, samples);
+    CHECK(samples[1].status == DCGM_ST_NO_DATA);
+    CHECK(slots.Find(gpu1Key) == 1); /* Reservations survive */
+}
+
+TEST_CASE("LatestValueSlots: Readers never see torn values")
+{
+    DcgmLatestValueSlots slots(1);
+    dcgm_entity_key_t gpu0Key { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    unsigned int slot = slots.Reserve(gpu0Key);
+    std::atomic_bool done { false };
+    bool torn = false;
+
+    /* The writer keeps the value equal to the timestamp so a mismatch means a torn read */
+    std::thread writer([&]() {
+        dcgmcm_latest_value_t value {};
+        value.tsType = TS_TYPE_INT64;
+        for (long long i = 1; i <= 100000; i++)
+        {
+            value.timestamp = i;
+            value.val.i64   = i;
+            slots.Publish(slot, value);
+        }
+        done = true;
+    });
+
+    dcgmLatestValueSample_t sample;
+    while (!done)
+    {
+        slots.Read(&slot, 1, &sample);
+        if (sample.status == DCGM_ST_OK && sample.ts != sample.value.i64)
+        {
+            torn = true;
+        }
+    }
+    writer.join();
+
+    CHECK(torn == false);
+    slots.Read(&slot, 1, &sample);
+    CHECK(sample.value.i64 == 100000);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmMessagePool.h>
+
+TEST_CASE("MessagePool: Messages are reused by size class")
+{
+    DcgmMessagePool pool;
+
+    auto small = pool.Get(100);
+    REQUIRE(small != nullptr);
+    CHECK(small->GetMsgBytesPtr()->capacity() >= 100);
+    small->UpdateMsgHdr(DCGM_MSG_MODULE_COMMAND, 5, DCGM_ST_OK, 100);
+    small->GetMsgBytesPtr()->resize(100);
+    DcgmMessage *smallPtr = small.get();
+
+    auto large = pool.Get(100000);
+    CHECK(large->GetMsgBytesPtr()->capacity() >= 100000);
+    DcgmMessage *largePtr = large.get();
+
+    pool.Put(std::move(small));
+    pool.Put(std::move(large));
+
+    auto stats = pool.GetStats();
+    CHECK(stats.gets == 2);
+    CHECK(stats.hits == 0);
+    CHECK(stats.retainedMessages == 2);
+
+    /* A small request doesn't get the large buffer, and what comes back is empty */
+    auto reused = pool.Get(200);
+    CHECK(reused.get() == smallPtr);
+    CHECK(reused->GetMsgBytesPtr()->empty());
+    CHECK(reused->GetMessageHdr()->requestId == 0);
+
+    auto reusedLarge = pool.Get(70000);
+    CHECK(reusedLarge.get() == largePtr);
+
+    /* Nothing left that fits */
+    auto fresh = pool.Get(100);
+    CHECK(fresh.get() != smallPtr);
+
+    stats = pool.GetStats();
+    CHECK(stats.gets == 5);
+    CHECK(stats.hits == 2);
+    CHECK(stats.retainedMessages == 0);
+    CHECK(stats.retainedBytes == 0);
+}
+
+TEST_CASE("MessagePool: Retained bytes are capped")
+{
+    DcgmMessagePool pool(64 * 1024);
+
+    auto first  = pool.Get(40000);
+    auto second = pool.Get(40000);
+    pool.Put(std::move(first));
+    pool.Put(std::move(second));
+
+    auto stats = pool.GetStats();
+    CHECK(stats.puts == 2);
+    CHECK(stats.discards == 1);
+    CHECK(stats.retainedMessages == 1);
+    CHECK(stats.retainedBytes <= 64 * 1024);
+
+    /* Bodies bigger than the largest class are never kept */
+    auto huge = std::make_unique<DcgmMessage>();
+    huge->GetMsgBytesPtr()->reserve(32 * 1024 * 1024);
+    DcgmMessagePool bigPool(64 * 1024 * 1024);
+    bigPool.Put(std::move(huge));
+    CHECK(bigPool.GetStats().discards == 1);
+
+    pool.Clear();
+    CHECK(pool.GetStats().retainedMessages == 0);
+    CHECK(pool.GetStats().retainedBytes == 0);
+}
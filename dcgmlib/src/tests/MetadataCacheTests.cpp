@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmClientMetadataCache.h>
+#include <dcgm_core_structs.h>
+
+namespace
+{
+dcgm_core_msg_fieldgroup_op_t MakeFieldGroupGetInfo(unsigned int fieldGroupId, unsigned int requestId)
+{
+    dcgm_core_msg_fieldgroup_op_t msg {};
+    msg.header.length        = sizeof(msg);
+    msg.header.moduleId      = DcgmModuleIdCore;
+    msg.header.subCommand    = DCGM_CORE_SR_FIELDGROUP_GET_INFO;
+    msg.header.version       = dcgm_core_msg_fieldgroup_op_version;
+    msg.header.connectionId  = 1;
+    msg.header.requestId     = requestId;
+    msg.info.fg.version      = dcgmFieldGroupInfo_version;
+    msg.info.fg.fieldGroupId = (dcgmFieldGrp_t)fieldGroupId;
+    return msg;
+}
+
+/* Answer msg like the host engine would */
+void Respond(dcgm_core_msg_fieldgroup_op_t &msg, unsigned short fieldId)
+{
+    msg.info.fg.numFieldIds = 1;
+    msg.info.fg.fieldIds[0] = fieldId;
+    msg.info.cmdRet         = DCGM_ST_OK;
+}
+} // namespace
+
+TEST_CASE("MetadataCache: only metadata requests are cacheable")
+{
+    auto msg = MakeFieldGroupGetInfo(1, 1);
+    CHECK(DcgmClientMetadataCache::IsCacheable(msg.header));
+
+    msg.header.subCommand = DCGM_CORE_SR_FIELDGROUP_CREATE;
+    CHECK(!DcgmClientMetadataCache::IsCacheable(msg.header));
+
+    msg.header.subCommand = DCGM_CORE_SR_FIELDGROUP_GET_INFO;
+    msg.header.moduleId   = DcgmModuleIdHealth;
+    CHECK(!DcgmClientMetadataCache::IsCacheable(msg.header));
+}
+
+TEST_CASE("MetadataCache: responses are kept until the generation changes")
+{
+    DcgmClientMetadataCache cache;
+    unsigned long long generation = 0;
+
+    auto request          = MakeFieldGroupGetInfo(5, 1);
+    std::string const key = DcgmClientMetadataCache::MakeKey(request.header);
+    CHECK(!cache.Lookup(1, key, &request.header, sizeof(request), generation));
+    CHECK(generation == 0);
+
+    cache.Enable(1, 7);
+    CHECK(cache.IsEnabled(1));
+    CHECK(!cache.IsEnabled(2));
+    CHECK(!cache.Lookup(1, key, &request.header, sizeof(request), generation));
+    CHECK(generation == 7);
+
+    Respond(request, DCGM_FI_DEV_GPU_TEMP);
+    cache.Store(1, generation, key, &request.header);
+
+    /* Another call of the same request only differs in its requestId */
+    auto again = MakeFieldGroupGetInfo(5, 2);
+    REQUIRE(cache.Lookup(1, DcgmClientMetadataCache::MakeKey(again.header), &again.header, sizeof(again), generation));
+    CHECK(again.info.fg.numFieldIds == 1);
+    CHECK(again.info.fg.fieldIds[0] == DCGM_FI_DEV_GPU_TEMP);
+
+    /* A different field group and a too-small buffer miss */
+    auto other = MakeFieldGroupGetInfo(6, 3);
+    CHECK(!cache.Lookup(1, DcgmClientMetadataCache::MakeKey(other.header), &other.header, sizeof(other), generation));
+    again = MakeFieldGroupGetInfo(5, 4);
+    CHECK(!cache.Lookup(1, key, &again.header, sizeof(again) - 1, generation));
+
+    /* Older generations arrive late and change nothing */
+    cache.SetGeneration(1, 6);
+    CHECK(cache.Lookup(1, key, &again.header, sizeof(again), generation));
+
+    cache.SetGeneration(1, 8);
+    again = MakeFieldGroupGetInfo(5, 5);
+    CHECK(!cache.Lookup(1, key, &again.header, sizeof(again), generation));
+    CHECK(generation == 8);
+
+    cache.Remove(1);
+    CHECK(!cache.IsEnabled(1));
+}
+
+TEST_CASE("MetadataCache: responses from before a change are not stored")
+{
+    DcgmClientMetadataCache cache;
+    unsigned long long generation = 0;
+    cache.Enable(1, 1);
+
+    auto request          = MakeFieldGroupGetInfo(5, 1);
+    std::string const key = DcgmClientMetadataCache::MakeKey(request.header);
+    CHECK(!cache.Lookup(1, key, &request.header, sizeof(request), generation));
+
+    /* The notification of a change arrives while the request is in flight */
+    cache.SetGeneration(1, 2);
+    Respond(request, DCGM_FI_DEV_GPU_TEMP);
+    cache.Store(1, generation, key, &request.header);
+
+    CHECK(!cache.Lookup(1, key, &request.header, sizeof(request), generation));
+    CHECK(generation == 2);
+}
+
+TEST_CASE("MetadataCache: a connection starts over once it is full")
+{
+    DcgmClientMetadataCache cache;
+    unsigned long long generation = 0;
+    cache.Enable(1, 1);
+
+    auto first = MakeFieldGroupGetInfo(0, 1);
+    for (unsigned int i = 0; i <= DcgmClientMetadataCache::c_maxEntries; i++)
+    {
+        auto request    = MakeFieldGroupGetInfo(i, i + 1);
+        std::string key = DcgmClientMetadataCache::MakeKey(request.header);
+        Respond(request, DCGM_FI_DEV_GPU_TEMP);
+        cache.Store(1, 1, std::move(key), &request.header);
+    }
+
+    auto last = MakeFieldGroupGetInfo(DcgmClientMetadataCache::c_maxEntries, 1);
+    CHECK(cache.Lookup(1, DcgmClientMetadataCache::MakeKey(last.header), &last.header, sizeof(last), generation));
+    CHECK(!cache.Lookup(1, DcgmClientMetadataCache::MakeKey(first.header), &first.header, sizeof(first), generation));
+}
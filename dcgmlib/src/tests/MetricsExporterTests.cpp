@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmCacheManager.h>
+#include <DcgmMetricsExporter.h>
+#include <Defer.hpp>
+
+#include <string>
+
+namespace
+{
+void WatchField(DcgmCacheManager &cm, unsigned int gpuId, unsigned short fieldId)
+{
+    DcgmWatcher watcher(DcgmWatcherTypeClient, DCGM_CONNECTION_ID_NONE);
+    bool wereFirstWatcher = false;
+
+    REQUIRE(cm.AddFieldWatch(DCGM_FE_GPU, gpuId, fieldId, 1000000, 3600.0, 0, watcher, false, false, wereFirstWatcher)
+            == DCGM_ST_OK);
+}
+} // namespace
+
+TEST_CASE("MetricsExporter: Render")
+{
+    DcgmFieldsInit();
+    DcgmNs::Defer defer([] { DcgmFieldsTerm(); });
+    DcgmCacheManager cm;
+
+    unsigned int gpuIds[2];
+    gpuIds[0] = cm.AddFakeGpu();
+    gpuIds[1] = cm.AddFakeGpu();
+
+    for (unsigned int gpuId : gpuIds)
+    {
+        WatchField(cm, gpuId, DCGM_FI_DEV_POWER_USAGE);
+        WatchField(cm, gpuId, DCGM_FI_DEV_GPU_TEMP);
+    }
+
+    DcgmFvBuffer fvBuffer;
+    fvBuffer.AddDoubleValue(DCGM_FE_GPU, gpuIds[0], DCGM_FI_DEV_POWER_USAGE, 150.5, 1000000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuIds[0], DCGM_FI_DEV_GPU_TEMP, 60, 2500000, DCGM_ST_OK);
+    fvBuffer.AddInt64Value(DCGM_FE_GPU, gpuIds[1], DCGM_FI_DEV_GPU_TEMP, 61, 2500000, DCGM_ST_OK);
+    REQUIRE(cm.InjectSamples(&fvBuffer) == DCGM_ST_OK);
+
+    DcgmMetricsExporter exporter(cm);
+    std::string out;
+    exporter.Render(out);
+
+    /* Each family is written once, before its samples */
+    std::string const tempFamily = "# TYPE dcgm_gpu_temp gauge\n";
+    size_t const tempFamilyPos   = out.find(tempFamily);
+    REQUIRE(tempFamilyPos != std::string::npos);
+    CHECK(out.find(tempFamily, tempFamilyPos + 1) == std::string::npos);
+
+    size_t const gpu0TempPos = out.find(fmt::format("dcgm_gpu_temp{{entity=\"GPU\",entity_id=\"{}\"", gpuIds[0]));
+    size_t const gpu1TempPos = out.find(fmt::format("dcgm_gpu_temp{{entity=\"GPU\",entity_id=\"{}\"", gpuIds[1]));
+    REQUIRE(gpu0TempPos != std::string::npos);
+    REQUIRE(gpu1TempPos != std::string::npos);
+    CHECK(tempFamilyPos < gpu0TempPos);
+    CHECK(gpu0TempPos < gpu1TempPos);
+    CHECK(out.find("} 60 2.500000\n", gpu0TempPos) != std::string::npos);
+
+    CHECK(out.find("# TYPE dcgm_power_usage gauge\n") != std::string::npos);
+    CHECK(out.find("} 150.5 1.000000\n") != std::string::npos);
+
+    /* Power of the second GPU has no value yet */
+    CHECK(out.find(fmt::format("dcgm_power_usage{{entity=\"GPU\",entity_id=\"{}\"", gpuIds[1])) == std::string::npos);
+
+    CHECK(out.ends_with("# EOF\n"));
+
+    SECTION("Watches added after the first render are exported")
+    {
+        WatchField(cm, gpuIds[1], DCGM_FI_DEV_SM_CLOCK);
+
+        DcgmFvBuffer clockBuffer;
+        clockBuffer.AddInt64Value(DCGM_FE_GPU, gpuIds[1], DCGM_FI_DEV_SM_CLOCK, 1410, 3000000, DCGM_ST_OK);
+        REQUIRE(cm.InjectSamples(&clockBuffer) == DCGM_ST_OK);
+
+        exporter.Render(out);
+        CHECK(out.find("# TYPE dcgm_sm_clock gauge\n") != std::string::npos);
+        CHECK(out.find("} 1410 3.000000\n") != std::string::npos);
+        CHECK(out.find("} 60 2.500000\n") != std::string::npos);
+    }
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmProcessStatsIndex.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+dcgmDevicePidAccountingStats_t MakeStats(unsigned int pid, unsigned long long maxMemoryUsage)
+{
+    dcgmDevicePidAccountingStats_t stats {};
+    stats.version        = dcgmDevicePidAccountingStats_version;
+    stats.pid            = pid;
+    stats.maxMemoryUsage = maxMemoryUsage;
+    return stats;
+}
+} // namespace
+
+TEST_CASE("ProcessStatsIndex: Latest accounting record")
+{
+    DcgmProcessStatsIndex index;
+    dcgmDevicePidAccountingStats_t stats {};
+
+    CHECK(index.GetLatestAccountingStats(1, 0, stats) == false);
+
+    index.AddAccountingStats(1000, MakeStats(1, 10));
+    index.AddAccountingStats(1000, MakeStats(2, 20));
+    index.AddAccountingStats(2000, MakeStats(1, 11));
+    /* Out of order. Not the latest */
+    index.AddAccountingStats(1500, MakeStats(1, 12));
+
+    REQUIRE(index.GetLatestAccountingStats(1, 0, stats));
+    CHECK(stats.maxMemoryUsage == 11);
+    REQUIRE(index.GetLatestAccountingStats(2, 0, stats));
+    CHECK(stats.maxMemoryUsage == 20);
+
+    /* The timeseries no longer has pid 2's record */
+    CHECK(index.GetLatestAccountingStats(2, 1001, stats) == false);
+    CHECK(index.GetLatestAccountingStats(1, 1001, stats));
+
+    /* Pruning keeps pid 1's newer record */
+    index.Prune(1600);
+    CHECK(index.GetLatestAccountingStats(2, 0, stats) == false);
+    REQUIRE(index.GetLatestAccountingStats(1, 0, stats));
+    CHECK(stats.maxMemoryUsage == 11);
+
+    index.Prune(3000);
+    CHECK(index.GetLatestAccountingStats(1, 0, stats) == false);
+}
+
+TEST_CASE("ProcessStatsIndex: Utilization samples")
+{
+    DcgmProcessStatsIndex index;
+    double utilSum;
+    long long numSamples;
+
+    CHECK(index.GetUtilSum(1, 0, 0, utilSum, numSamples) == false);
+
+    for (timelib64_t ts = 1000; ts <= 10000; ts += 1000)
+    {
+        index.AddUtilSample(ts, 1, 10.0);
+        index.AddUtilSample(ts, 2, 30.0);
+        index.AddUtilSample(ts, 3, 50.0);
+    }
+
+    /* Divided by the samples of every PID, like the timeseries walk */
+    REQUIRE(index.GetUtilSum(2, 0, 0, utilSum, numSamples));
+    CHECK(utilSum == 300.0);
+    CHECK(numSamples == 30);
+
+    REQUIRE(index.GetUtilSum(1, 3000, 5000, utilSum, numSamples));
+    CHECK(utilSum == 30.0);
+    CHECK(numSamples == 9);
+
+    REQUIRE(index.GetUtilSum(3, 9500, 0, utilSum, numSamples));
+    CHECK(utilSum == 50.0);
+    CHECK(numSamples == 3);
+
+    CHECK(index.GetUtilSum(4, 0, 0, utilSum, numSamples) == false);
+    CHECK(index.GetUtilSum(1, 10001, 0, utilSum, numSamples) == false);
+
+    /* Out of order samples land in their place */
+    index.AddUtilSample(4500, 4, 70.0);
+    REQUIRE(index.GetUtilSum(4, 4000, 5000, utilSum, numSamples));
+    CHECK(utilSum == 70.0);
+    CHECK(numSamples == 7);
+
+    index.Prune(8000);
+    REQUIRE(index.GetUtilSum(1, 0, 0, utilSum, numSamples));
+    CHECK(utilSum == 30.0);
+    CHECK(numSamples == 9);
+    CHECK(index.GetUtilSum(4, 0, 0, utilSum, numSamples) == false);
+}
+
+TEST_CASE("ProcessStatsIndex: Utilization of every PID")
+{
+    DcgmProcessStatsIndex index;
+    std::vector<DcgmProcessStatsIndex::PidUtilSum> sums;
+    long long numSamples;
+
+    index.GetAllUtilSums(0, 0, sums, numSamples);
+    CHECK(sums.empty());
+    CHECK(numSamples == 0);
+
+    for (timelib64_t ts = 1000; ts <= 10000; ts += 1000)
+    {
+        index.AddUtilSample(ts, 1, 10.0);
+        index.AddUtilSample(ts + 100, 2, 30.0);
+    }
+
+    /* Inserted before the PID's other samples, so every running sum after it moves */
+    index.AddUtilSample(500, 2, 5.0);
+
+    index.GetAllUtilSums(2000, 6000, sums, numSamples);
+    std::sort(sums.begin(), sums.end(), [](auto const &a, auto const &b) { return a.pid < b.pid; });
+    REQUIRE(sums.size() == 2);
+    CHECK(sums[0].pid == 1);
+    CHECK(sums[0].firstTimestamp == 2000);
+    CHECK(sums[0].utilSum == 50.0);
+    CHECK(sums[1].pid == 2);
+    CHECK(sums[1].firstTimestamp == 2100);
+    CHECK(sums[1].utilSum == 120.0);
+    CHECK(numSamples == 9);
+
+    double utilSum;
+    REQUIRE(index.GetUtilSum(2, 0, 0, utilSum, numSamples));
+    CHECK(utilSum == 305.0);
+
+    /* Pruned samples no longer count, but the running sums of the rest stay valid */
+    index.Prune(5000);
+    index.AddUtilSample(11000, 2, 40.0);
+    REQUIRE(index.GetUtilSum(2, 0, 0, utilSum, numSamples));
+    CHECK(utilSum == 220.0);
+    CHECK(numSamples == 13);
+
+    index.GetAllUtilSums(10500, 0, sums, numSamples);
+    REQUIRE(sums.size() == 1);
+    CHECK(sums[0].pid == 2);
+    CHECK(sums[0].utilSum == 40.0);
+    CHECK(numSamples == 1);
+}
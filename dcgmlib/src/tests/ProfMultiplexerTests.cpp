@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmProfMultiplexer.h>
+
+#include <cstring>
+
+namespace
+{
+void AddMetricGroup(dcgmProfGetMetricGroups_v3 &metricGroups,
+                    unsigned short majorId,
+                    unsigned short minorId,
+                    std::vector<unsigned short> const &fieldIds)
+{
+    dcgmProfMetricGroupInfo_v2 &metricGroup = metricGroups.metricGroups[metricGroups.numMetricGroups++];
+    metricGroup.majorId                     = majorId;
+    metricGroup.minorId                     = minorId;
+    metricGroup.numFieldIds                 = fieldIds.size();
+    std::memcpy(metricGroup.fieldIds, fieldIds.data(), fieldIds.size() * sizeof(fieldIds[0]));
+}
+
+/* Major 0 has three metric groups that can't be watched together. Major 1 has one */
+dcgmProfGetMetricGroups_v3 MakeMetricGroups()
+{
+    dcgmProfGetMetricGroups_v3 metricGroups {};
+    AddMetricGroup(metricGroups, 0, 0, { 1001, 1002, 1003 });
+    AddMetricGroup(metricGroups, 0, 1, { 1001, 1004 });
+    AddMetricGroup(metricGroups, 0, 2, { 1005 });
+    AddMetricGroup(metricGroups, 1, 0, { 1009, 1010 });
+    return metricGroups;
+}
+} // namespace
+
+TEST_CASE("ProfMultiplexPlan: Fields that fit in one pass")
+{
+    DcgmProfMultiplexPlan plan;
+    REQUIRE(DcgmProfMultiplexPlan::Build(MakeMetricGroups(), { 1002, 1001, 1009 }, plan) == DCGM_ST_OK);
+
+    REQUIRE(plan.NumPasses() == 1);
+    CHECK(plan.FieldsOfPass(0) == std::vector<unsigned short> { 1001, 1002, 1009 });
+    CHECK(plan.SampledFraction(1001) == 1.0);
+    CHECK(plan.SampledFraction(1004) == 0.0);
+}
+
+TEST_CASE("ProfMultiplexPlan: Metric groups of the same major are rotated")
+{
+    DcgmProfMultiplexPlan plan;
+    REQUIRE(DcgmProfMultiplexPlan::Build(MakeMetricGroups(), { 1001, 1002, 1004, 1005, 1010 }, plan)
+            == DCGM_ST_OK);
+
+    /* 1001 and 1002 come from the first group, so 1004 and 1005 each need their own pass */
+    REQUIRE(plan.NumPasses() == 3);
+    CHECK(plan.FieldsOfPass(0) == std::vector<unsigned short> { 1001, 1002, 1010 });
+    CHECK(plan.FieldsOfPass(1) == std::vector<unsigned short> { 1004, 1010 });
+    CHECK(plan.FieldsOfPass(2) == std::vector<unsigned short> { 1005, 1010 });
+
+    CHECK(plan.SampledFraction(1001) == 1.0 / 3);
+    CHECK(plan.SampledFraction(1005) == 1.0 / 3);
+    CHECK(plan.SampledFraction(1010) == 1.0);
+    CHECK(plan.FieldIds() == std::vector<unsigned short> { 1001, 1002, 1004, 1005, 1010 });
+}
+
+TEST_CASE("ProfMultiplexPlan: Unknown fields")
+{
+    DcgmProfMultiplexPlan plan;
+    CHECK(DcgmProfMultiplexPlan::Build(MakeMetricGroups(), { 1001, 1011 }, plan) == DCGM_ST_PROFILING_NOT_SUPPORTED);
+}
+
+TEST_CASE("ProfMultiplexer: Passes are switched when their window ends")
+{
+    std::vector<std::vector<unsigned short>> applied;
+    dcgmReturn_t applyResult = DCGM_ST_OK;
+
+    DcgmProfMultiplexer multiplexer(
+        [&](unsigned int groupId, DcgmProfMultiplexWatch const &watch, std::vector<unsigned short> const &fieldIds) {
+            CHECK(groupId == 5);
+            CHECK(watch.connectionId == 7);
+            applied.push_back(fieldIds);
+            return applyResult;
+        },
+        false);
+
+    DcgmProfMultiplexWatch watch;
+    watch.connectionId = 7;
+    watch.updateFreq   = 1000000;
+    REQUIRE(DcgmProfMultiplexPlan::Build(MakeMetricGroups(), { 1002, 1004 }, watch.plan) == DCGM_ST_OK);
+
+    timelib64_t const start = 1000000000;
+    REQUIRE(multiplexer.Add(5, watch, start) == DCGM_ST_OK);
+    REQUIRE(applied.size() == 1);
+    CHECK(applied[0] == std::vector<unsigned short> { 1002 });
+
+    auto const added = multiplexer.GetWatch(5);
+    REQUIRE(added.has_value());
+    timelib64_t const window = DcgmProfMultiplexer::c_samplesPerWindow * watch.updateFreq;
+    CHECK(added->windowUsec == window);
+
+    /* Not due yet */
+    CHECK(multiplexer.SwitchDuePasses(start + window - 1) == start + window);
+    CHECK(applied.size() == 1);
+
+    CHECK(multiplexer.SwitchDuePasses(start + window) == start + 2 * window);
+    REQUIRE(applied.size() == 2);
+    CHECK(applied[1] == std::vector<unsigned short> { 1004 });
+
+    /* A pass that can't be applied is retried next window */
+    applyResult = DCGM_ST_GENERIC_ERROR;
+    multiplexer.SwitchDuePasses(start + 2 * window);
+    CHECK(multiplexer.GetWatch(5)->pass == 1);
+
+    applyResult = DCGM_ST_OK;
+    multiplexer.SwitchDuePasses(start + 3 * window);
+    CHECK(multiplexer.GetWatch(5)->pass == 0);
+    CHECK(applied.back() == std::vector<unsigned short> { 1002 });
+
+    multiplexer.RemoveConnection(7);
+    CHECK_FALSE(multiplexer.GetWatch(5).has_value());
+    CHECK(multiplexer.SwitchDuePasses(start + 4 * window) == 0);
+}
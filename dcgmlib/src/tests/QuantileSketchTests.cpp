@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmQuantileSketch.h>
+
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+bool IsWithinAccuracy(double value, double expected)
+{
+    return std::abs(value - expected) <= std::abs(expected) * DcgmQuantileSketch::c_relativeAccuracy;
+}
+} // namespace
+
+TEST_CASE("QuantileSketch: Quantiles")
+{
+    DcgmQuantileSketch sketch;
+    double value = 0.0;
+
+    CHECK(sketch.GetQuantile(0.5, value) == false);
+
+    for (int i = 1; i <= 10000; i++)
+    {
+        sketch.Add(i);
+    }
+    CHECK(sketch.GetCount() == 10000);
+
+    REQUIRE(sketch.GetQuantile(0.5, value));
+    CHECK(IsWithinAccuracy(value, 5000.0));
+    REQUIRE(sketch.GetQuantile(0.95, value));
+    CHECK(IsWithinAccuracy(value, 9500.0));
+    REQUIRE(sketch.GetQuantile(0.99, value));
+    CHECK(IsWithinAccuracy(value, 9900.0));
+
+    /* The extremes are exact */
+    REQUIRE(sketch.GetQuantile(0.0, value));
+    CHECK(value == 1);
+    REQUIRE(sketch.GetQuantile(1.0, value));
+    CHECK(value == 10000);
+}
+
+TEST_CASE("QuantileSketch: Negative values and zeros")
+{
+    DcgmQuantileSketch sketch;
+    double value = 0.0;
+
+    for (int i = -100; i <= 100; i++)
+    {
+        sketch.Add(i);
+    }
+    sketch.Add(NAN); /* Ignored */
+
+    CHECK(sketch.GetCount() == 201);
+    REQUIRE(sketch.GetQuantile(0.5, value));
+    CHECK(value == 0.0);
+    REQUIRE(sketch.GetQuantile(0.1, value));
+    CHECK(IsWithinAccuracy(value, -80.0));
+    REQUIRE(sketch.GetQuantile(0.9, value));
+    CHECK(IsWithinAccuracy(value, 80.0));
+}
+
+TEST_CASE("QuantileSketch: Merge")
+{
+    DcgmQuantileSketch low;
+    DcgmQuantileSketch high;
+    DcgmQuantileSketch all;
+    double value       = 0.0;
+    double mergedValue = 0.0;
+
+    for (int i = 1; i <= 1000; i++)
+    {
+        (i <= 300 ? low : high).Add(i * 1.5);
+        all.Add(i * 1.5);
+    }
+
+    DcgmQuantileSketch merged;
+    merged.Merge(low);
+    merged.Merge(high);
+    merged.Merge(DcgmQuantileSketch {});
+    CHECK(merged.GetCount() == all.GetCount());
+
+    for (double quantile : { 0.0, 0.25, 0.5, 0.95, 0.99, 1.0 })
+    {
+        REQUIRE(all.GetQuantile(quantile, value));
+        REQUIRE(merged.GetQuantile(quantile, mergedValue));
+        CHECK(mergedValue == value);
+    }
+}
+
+TEST_CASE("QuantileSketch: Bins are bounded")
+{
+    DcgmQuantileSketch sketch;
+    double value = 0.0;
+
+    /* Far more distinct magnitudes than c_maxBins */
+    for (int exponent = -300; exponent <= 300; exponent++)
+    {
+        sketch.Add(std::pow(10.0, exponent));
+    }
+    for (int i = 0; i < 1000; i++)
+    {
+        sketch.Add(1e301);
+    }
+
+    /* The high end is still accurate */
+    REQUIRE(sketch.GetQuantile(0.99, value));
+    CHECK(IsWithinAccuracy(value, 1e301));
+    REQUIRE(sketch.GetQuantile(0.0, value));
+    CHECK(value == 1e-300);
+}
+
+TEST_CASE("QuantileSketch: Histogram")
+{
+    DcgmQuantileSketch sketch;
+    long long counts[10];
+
+    /* Away from the bucket edges, which are only as accurate as the quantiles */
+    for (int i = 0; i < 100; i++)
+    {
+        sketch.Add((i / 10) * 10 + 3 + (i % 10) * 0.4);
+    }
+    sketch.Add(-50.0);
+    sketch.Add(500.0);
+
+    sketch.GetHistogram(0.0, 100.0, 10, counts);
+    CHECK(std::accumulate(counts, counts + 10, 0LL) == 102);
+    /* Out of range values land in the edge buckets */
+    CHECK(counts[0] == 11);
+    CHECK(counts[9] == 11);
+    for (int i = 1; i < 9; i++)
+    {
+        CHECK(counts[i] == 10);
+    }
+}
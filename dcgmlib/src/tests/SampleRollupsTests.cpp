@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmSampleRollups.h>
+
+#include <cmath>
+
+TEST_CASE("SampleRollups: Summarize picks the coarsest tier with whole buckets")
+{
+    DcgmSampleRollups<long long> rollups;
+    DcgmRollupSummary<long long> summary;
+    timelib64_t interiorStart = 0;
+    timelib64_t interiorEnd   = 0;
+
+    CHECK(rollups.Summarize(0, 0, summary, interiorStart, interiorEnd) == false);
+
+    /* 10 minutes of 1 Hz samples starting on a minute boundary. Value == seconds since start */
+    timelib64_t const base = 60000000LL * 1000;
+    for (long long i = 0; i < 600; i++)
+    {
+        rollups.Append(base + i * 1000000, i, false);
+    }
+
+    /* A window of whole minutes is answered entirely by the 60s tier */
+    REQUIRE(rollups.Summarize(base, base + 300000000 - 1, summary, interiorStart, interiorEnd));
+    CHECK(interiorStart == base);
+    CHECK(interiorEnd == base + 300000000);
+    CHECK(summary.count == 300);
+    CHECK(summary.nonBlankCount == 300);
+    CHECK(summary.minValue == 0);
+    CHECK(summary.maxValue == 299);
+    CHECK(summary.sumValue == 299 * 300 / 2);
+
+    /* A window that doesn't line up leaves the partial buckets to the caller */
+    REQUIRE(rollups.Summarize(base + 5000000, base + 125000000, summary, interiorStart, interiorEnd));
+    CHECK(interiorStart == base + 60000000);
+    CHECK(interiorEnd == base + 120000000);
+    CHECK(summary.count == 60);
+    CHECK(summary.minValue == 60);
+    CHECK(summary.maxValue == 119);
+
+    /* Too short for a whole minute, so the 10s tier is used */
+    REQUIRE(rollups.Summarize(base + 5000000, base + 35000000, summary, interiorStart, interiorEnd));
+    CHECK(interiorStart == base + 10000000);
+    CHECK(interiorEnd == base + 30000000);
+    CHECK(summary.count == 20);
+
+    /* Open-ended ranges cover everything the tier has */
+    REQUIRE(rollups.Summarize(0, 0, summary, interiorStart, interiorEnd));
+    CHECK(interiorStart == base);
+    CHECK(summary.count == 600);
+
+    /* The sketch covers the same buckets as the summary */
+    DcgmQuantileSketch sketch;
+    double median = 0.0;
+    REQUIRE(rollups.Summarize(base + 5000000, base + 125000000, summary, interiorStart, interiorEnd, &sketch));
+    CHECK(sketch.GetCount() == 60);
+    REQUIRE(sketch.GetQuantile(0.5, median));
+    CHECK(std::abs(median - 90) <= 90 * DcgmQuantileSketch::c_relativeAccuracy);
+}
+
+TEST_CASE("SampleRollups: Blank values, out of order samples and retention")
+{
+    DcgmSampleRollups<double> rollups;
+    DcgmRollupSummary<double> summary;
+    timelib64_t interiorStart = 0;
+    timelib64_t interiorEnd   = 0;
+    timelib64_t const base    = 60000000LL * 1000;
+
+    rollups.Append(base + 2000000, 4.0, false);
+    rollups.Append(base + 1000000, 2.0, false); /* Out of order */
+    rollups.Append(base + 3000000, 0.0, true);  /* Blank */
+
+    REQUIRE(rollups.Summarize(base, base + 60000000 - 1, summary, interiorStart, interiorEnd));
+    CHECK(summary.count == 3);
+    CHECK(summary.nonBlankCount == 2);
+    CHECK(summary.minValue == 2.0);
+    CHECK(summary.maxValue == 4.0);
+    CHECK(summary.sumValue == 6.0);
+
+    /* The 1s tier only keeps a bounded number of buckets, dropping the oldest */
+    size_t const maxBuckets = DcgmSampleRollups<double>::c_tierMaxBuckets[0];
+    for (size_t i = 0; i < maxBuckets + 10; i++)
+    {
+        rollups.Append(base + 10000000 + i * 1000000, 1.0, false);
+    }
+    CHECK(rollups.GetNumBuckets() <= maxBuckets + DcgmSampleRollups<double>::c_tierMaxBuckets[1]
+                                         + DcgmSampleRollups<double>::c_tierMaxBuckets[2]);
+
+    /* Samples older than what the 1s tier kept are still in the coarser tiers */
+    REQUIRE(rollups.Summarize(base, base + 60000000 - 1, summary, interiorStart, interiorEnd));
+    CHECK(summary.count == 3 + 50);
+}
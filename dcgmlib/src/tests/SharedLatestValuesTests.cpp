@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmSharedLatestValues.h>
+#include <dcgm_fields.h>
+#include <timeseries.h>
+
+#include <fmt/format.h>
+
+#include <unistd.h>
+
+namespace
+{
+std::string TestSegmentName()
+{
+    return fmt::format("/dcgm-shared-latest-values-test-{}", getpid());
+}
+} // namespace
+
+TEST_CASE("SharedLatestValues: a reader sees the rows and values of the writer")
+{
+    std::string const name = TestSegmentName();
+    std::unique_ptr<DcgmSharedLatestValues> writer;
+    REQUIRE(DcgmSharedLatestValues::Create(name, 2, writer) == DCGM_ST_OK);
+
+    dcgm_entity_key_t gpu0Key { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    dcgm_entity_key_t gpu1Key { 1, DCGM_FI_DEV_POWER_USAGE, DCGM_FE_GPU };
+    dcgm_entity_key_t globalKey { 0, DCGM_FI_DRIVER_VERSION, DCGM_FE_NONE };
+
+    unsigned int rows[3];
+    rows[0] = writer->Reserve(gpu0Key);
+    CHECK(rows[0] == 0);
+    CHECK(writer->Reserve(gpu0Key) == 0);
+
+    std::unique_ptr<DcgmSharedLatestValues> reader;
+    REQUIRE(DcgmSharedLatestValues::Open(name, reader) == DCGM_ST_OK);
+    CHECK(reader->GetCapacity() == 2);
+    CHECK(reader->Find(gpu0Key) == 0);
+    CHECK(reader->Find(gpu1Key) == DcgmSharedLatestValues::c_noRow);
+    CHECK(reader->Reserve(gpu1Key) == DcgmSharedLatestValues::c_noRow); /* Readers can't append */
+
+    /* Rows appended after the reader opened the segment are found too */
+    rows[1] = writer->Reserve(gpu1Key);
+    rows[2] = writer->Reserve(globalKey);
+    CHECK(rows[1] == 1);
+    CHECK(rows[2] == DcgmSharedLatestValues::c_noRow); /* Full */
+    CHECK(reader->Find(gpu1Key) == 1);
+    rows[2] = 2;
+
+    dcgmLatestValueSample_t samples[3];
+    REQUIRE(reader->Read(rows, 3, samples) == DCGM_ST_OK);
+    CHECK(samples[0].status == DCGM_ST_NO_DATA);
+    CHECK(samples[0].fieldId == DCGM_FI_DEV_GPU_TEMP);
+    CHECK(samples[1].status == DCGM_ST_NO_DATA);
+    CHECK(samples[1].entityId == 1);
+    CHECK(samples[2].status == DCGM_ST_BADPARAM);
+
+    dcgmcm_latest_value_t value {};
+    value.timestamp = 1000;
+    value.tsType    = TS_TYPE_INT64;
+    value.val.i64   = 42;
+    writer->Publish(rows[0], value);
+
+    value.timestamp = 2000;
+    value.tsType    = TS_TYPE_DOUBLE;
+    value.val.d     = 250.5;
+    writer->Publish(rows[1], value);
+
+    REQUIRE(reader->Read(rows, 2, samples) == DCGM_ST_OK);
+    CHECK(samples[0].status == DCGM_ST_OK);
+    CHECK(samples[0].fieldType == DCGM_FT_INT64);
+    CHECK(samples[0].ts == 1000);
+    CHECK(samples[0].value.i64 == 42);
+    CHECK(samples[1].status == DCGM_ST_OK);
+    CHECK(samples[1].fieldType == DCGM_FT_DOUBLE);
+    CHECK(samples[1].ts == 2000);
+    CHECK(samples[1].value.dbl == 250.5);
+
+    writer->UnpublishAll();
+    REQUIRE(reader->Read(rows, 2, samples) == DCGM_ST_OK);
+    CHECK(samples[0].status == DCGM_ST_NO_DATA);
+    CHECK(samples[1].status == DCGM_ST_NO_DATA);
+
+    /* Readers keep their mapping once the writer is gone, but are told to reopen */
+    writer.reset();
+    CHECK(reader->Read(rows, 2, samples) == DCGM_ST_CONNECTION_NOT_VALID);
+
+    std::unique_ptr<DcgmSharedLatestValues> reopened;
+    CHECK(DcgmSharedLatestValues::Open(name, reopened) == DCGM_ST_NO_DATA);
+}
+
+TEST_CASE("SharedLatestValues: Create replaces a segment left behind")
+{
+    std::string const name = TestSegmentName();
+    std::unique_ptr<DcgmSharedLatestValues> oldWriter;
+    REQUIRE(DcgmSharedLatestValues::Create(name, 4, oldWriter) == DCGM_ST_OK);
+    dcgm_entity_key_t gpu0Key { 0, DCGM_FI_DEV_GPU_TEMP, DCGM_FE_GPU };
+    CHECK(oldWriter->Reserve(gpu0Key) == 0);
+
+    std::unique_ptr<DcgmSharedLatestValues> writer;
+    REQUIRE(DcgmSharedLatestValues::Create(name, 8, writer) == DCGM_ST_OK);
+
+    std::unique_ptr<DcgmSharedLatestValues> reader;
+    REQUIRE(DcgmSharedLatestValues::Open(name, reader) == DCGM_ST_OK);
+    CHECK(reader->GetCapacity() == 8);
+    CHECK(reader->GetNumRows() == 0);
+}
+
+TEST_CASE("SharedLatestValues: invalid names")
+{
+    std::unique_ptr<DcgmSharedLatestValues> values;
+    CHECK(DcgmSharedLatestValues::Create("no-leading-slash", 4, values) == DCGM_ST_BADPARAM);
+    CHECK(DcgmSharedLatestValues::Create("/nested/name", 4, values) == DCGM_ST_BADPARAM);
+    CHECK(DcgmSharedLatestValues::Create(TestSegmentName(), 0, values) == DCGM_ST_BADPARAM);
+    CHECK(DcgmSharedLatestValues::Open("/", values) == DCGM_ST_BADPARAM);
+    CHECK(DcgmSharedLatestValues::Open(TestSegmentName(), values) == DCGM_ST_NO_DATA);
+    CHECK(values == nullptr);
+}
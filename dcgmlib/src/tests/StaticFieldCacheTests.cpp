@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmStaticFieldCache.h>
+
+#include <cstring>
+#include <vector>
+
+TEST_CASE("StaticFieldCache: only static GPU values are stored")
+{
+    DcgmStaticFieldCache cache;
+    DcgmFvBuffer values;
+
+    values.AddStringValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_NAME, "Test GPU", 1000, DCGM_ST_OK);
+    values.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_FB_TOTAL, 81920, 1000, DCGM_ST_OK);
+    /* Not static */
+    values.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_FB_USED, 1024, 1000, DCGM_ST_OK);
+    /* Failed reads and blank values */
+    values.AddStringValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_SERIAL, "1234", 1000, DCGM_ST_NOT_SUPPORTED);
+    values.AddStringValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_VBIOS_VERSION, DCGM_STR_NOT_SUPPORTED, 1000, DCGM_ST_OK);
+    values.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_BAR1_TOTAL, DCGM_INT64_BLANK, 1000, DCGM_ST_OK);
+    /* Not a GPU */
+    values.AddInt64Value(DCGM_FE_GPU_I, 0, DCGM_FI_DEV_FB_TOTAL, 40960, 1000, DCGM_ST_OK);
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = values.GetNextFv(&cursor); fv != nullptr; fv = values.GetNextFv(&cursor))
+    {
+        cache.Store(*fv);
+    }
+
+    DcgmFvBuffer out;
+    REQUIRE(cache.Get(0, DCGM_FI_DEV_NAME, out));
+    REQUIRE(cache.Get(0, DCGM_FI_DEV_FB_TOTAL, out));
+    CHECK_FALSE(cache.Get(0, DCGM_FI_DEV_FB_USED, out));
+    CHECK_FALSE(cache.Get(0, DCGM_FI_DEV_SERIAL, out));
+    CHECK_FALSE(cache.Get(0, DCGM_FI_DEV_VBIOS_VERSION, out));
+    CHECK_FALSE(cache.Get(0, DCGM_FI_DEV_BAR1_TOTAL, out));
+    CHECK_FALSE(cache.Get(1, DCGM_FI_DEV_NAME, out));
+    CHECK(cache.GetHitCount() == 2);
+    CHECK(cache.GetMissCount() == 5);
+
+    cursor               = 0;
+    dcgmBufferedFv_t *fv = out.GetNextFv(&cursor);
+    REQUIRE(fv != nullptr);
+    CHECK(fv->fieldId == DCGM_FI_DEV_NAME);
+    CHECK(fv->entityId == 0);
+    CHECK(fv->timestamp == 1000);
+    CHECK(std::strcmp(fv->value.str, "Test GPU") == 0);
+
+    fv = out.GetNextFv(&cursor);
+    REQUIRE(fv != nullptr);
+    CHECK(fv->fieldId == DCGM_FI_DEV_FB_TOTAL);
+    CHECK(fv->value.i64 == 81920);
+    CHECK(out.GetNextFv(&cursor) == nullptr);
+}
+
+TEST_CASE("StaticFieldCache: invalidation")
+{
+    DcgmStaticFieldCache cache;
+    DcgmFvBuffer values;
+
+    values.AddStringValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_UUID, "GPU-0", 1000, DCGM_ST_OK);
+    values.AddStringValue(DCGM_FE_GPU, 1, DCGM_FI_DEV_UUID, "GPU-1", 1000, DCGM_ST_OK);
+    values.AddStringValue(DCGM_FE_GPU, 2, DCGM_FI_DEV_UUID, "GPU-2", 1000, DCGM_ST_OK);
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = values.GetNextFv(&cursor); fv != nullptr; fv = values.GetNextFv(&cursor))
+    {
+        cache.Store(*fv);
+    }
+
+    DcgmFvBuffer out;
+    cache.InvalidateGpu(1);
+    CHECK(cache.Get(0, DCGM_FI_DEV_UUID, out));
+    CHECK_FALSE(cache.Get(1, DCGM_FI_DEV_UUID, out));
+    CHECK(cache.Get(2, DCGM_FI_DEV_UUID, out));
+
+    cache.InvalidateAll();
+    CHECK_FALSE(cache.Get(0, DCGM_FI_DEV_UUID, out));
+    CHECK_FALSE(cache.Get(2, DCGM_FI_DEV_UUID, out));
+}
+
+TEST_CASE("StaticFieldCache: shared values outlive invalidation")
+{
+    DcgmStaticFieldCache cache;
+    DcgmFvBuffer values;
+
+    std::vector<char> clocks(1000, 'c');
+    values.AddBlobValue(DCGM_FE_GPU, 0, DCGM_FI_DEV_SUPPORTED_CLOCKS, clocks.data(), clocks.size(), 1000, DCGM_ST_OK);
+
+    dcgmBufferedFvCursor_t cursor = 0;
+    cache.Store(*values.GetNextFv(&cursor));
+
+    auto first  = cache.Get(0, DCGM_FI_DEV_SUPPORTED_CLOCKS);
+    auto second = cache.Get(0, DCGM_FI_DEV_SUPPORTED_CLOCKS);
+    REQUIRE(first != nullptr);
+    /* Both gets reference the same stored value */
+    CHECK(first.get() == second.get());
+    CHECK(first->fieldType == DCGM_FT_BINARY);
+    CHECK(std::memcmp(first->value.blob, clocks.data(), clocks.size()) == 0);
+
+    cache.InvalidateGpu(0);
+    CHECK(cache.Get(0, DCGM_FI_DEV_SUPPORTED_CLOCKS) == nullptr);
+    CHECK(std::memcmp(first->value.blob, clocks.data(), clocks.size()) == 0);
+}
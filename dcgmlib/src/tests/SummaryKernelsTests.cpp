@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmSummaryKernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+/* The summary the way the cache manager computed it before the kernels, one sample at a time */
+template <typename T>
+DcgmSummaryState<T> ReferenceSummary(std::vector<T> const &values, std::vector<timelib64_t> const &timestamps)
+{
+    DcgmSummaryState<T> state;
+    T const blank = DcgmSummaryBlank<T>();
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        T const value = values[i];
+        state.numSeen++;
+
+        if (value < blank)
+        {
+            if (state.numSeenAtLastValue == 0)
+            {
+                state.firstValue = value;
+                state.minValue   = value;
+                state.maxValue   = value;
+            }
+            state.minValue = std::min(state.minValue, value);
+            state.maxValue = std::max(state.maxValue, value);
+            state.sumValue += value;
+            state.lastValue          = value;
+            state.numSeenAtLastValue = state.numSeen;
+
+            if (!state.prevTimestamp)
+                state.integral = 0;
+            else
+                state.integral += ((value + state.prevValue) / (T)2) * (T)(timestamps[i] - state.prevTimestamp);
+        }
+
+        state.prevValue     = value;
+        state.prevTimestamp = timestamps[i];
+    }
+
+    return state;
+}
+
+/* Feed values to the kernel in chunks of random sizes */
+template <typename T>
+DcgmSummaryState<T> KernelSummary(std::vector<T> const &values,
+                                  std::vector<timelib64_t> const &timestamps,
+                                  std::mt19937 &random)
+{
+    DcgmSummaryState<T> state;
+    size_t offset = 0;
+
+    while (offset < values.size())
+    {
+        size_t count = std::min(values.size() - offset, (size_t)(random() % 100));
+        DcgmSummarizeChunk(values.data() + offset, timestamps.data() + offset, count, true, state);
+        offset += count;
+    }
+
+    return state;
+}
+
+template <typename T>
+void MakeSamples(size_t numSamples,
+                 double blankRatio,
+                 std::mt19937 &random,
+                 std::vector<T> &values,
+                 std::vector<timelib64_t> &timestamps)
+{
+    std::uniform_int_distribution<int> valueDist(-1000, 100000);
+    std::uniform_real_distribution<double> blankDist(0.0, 1.0);
+    timelib64_t timestamp = 1000000;
+
+    values.clear();
+    timestamps.clear();
+    for (size_t i = 0; i < numSamples; i++)
+    {
+        timestamp += 1000 + random() % 1000;
+        values.push_back(blankDist(random) < blankRatio ? DcgmSummaryBlank<T>() : (T)valueDist(random));
+        timestamps.push_back(timestamp);
+    }
+}
+} // namespace
+
+TEST_CASE("SummaryKernels: Int64 matches the per-sample summary")
+{
+    std::mt19937 random(1);
+    std::vector<long long> values;
+    std::vector<timelib64_t> timestamps;
+
+    for (double blankRatio : { 0.0, 0.1, 0.9, 1.0 })
+    {
+        for (size_t numSamples : { 1, 7, 8, 9, 1000, 10000 })
+        {
+            MakeSamples(numSamples, blankRatio, random, values, timestamps);
+            auto const expected = ReferenceSummary(values, timestamps);
+            auto const actual   = KernelSummary(values, timestamps, random);
+
+            CHECK(actual.numSeen == expected.numSeen);
+            CHECK(actual.numSeenAtLastValue == expected.numSeenAtLastValue);
+            CHECK(actual.minValue == expected.minValue);
+            CHECK(actual.maxValue == expected.maxValue);
+            CHECK(actual.sumValue == expected.sumValue);
+            CHECK(actual.firstValue == expected.firstValue);
+            CHECK(actual.lastValue == expected.lastValue);
+            CHECK(actual.integral == expected.integral);
+        }
+    }
+}
+
+TEST_CASE("SummaryKernels: Fp64 matches the per-sample summary")
+{
+    std::mt19937 random(2);
+    std::vector<double> values;
+    std::vector<timelib64_t> timestamps;
+
+    for (double blankRatio : { 0.0, 0.1, 0.9 })
+    {
+        for (size_t numSamples : { 1, 7, 8, 9, 1000, 10000 })
+        {
+            MakeSamples(numSamples, blankRatio, random, values, timestamps);
+            auto const expected = ReferenceSummary(values, timestamps);
+            auto const actual   = KernelSummary(values, timestamps, random);
+
+            CHECK(actual.numSeen == expected.numSeen);
+            CHECK(actual.numSeenAtLastValue == expected.numSeenAtLastValue);
+            CHECK(actual.minValue == expected.minValue);
+            CHECK(actual.maxValue == expected.maxValue);
+            CHECK(actual.firstValue == expected.firstValue);
+            CHECK(actual.lastValue == expected.lastValue);
+            /* Summed in a different order */
+            CHECK(std::fabs(actual.sumValue - expected.sumValue) <= 1e-9 * std::fabs(expected.sumValue));
+            CHECK(std::fabs(actual.integral - expected.integral) <= 1e-9 * std::fabs(expected.integral));
+        }
+    }
+}
+
+TEST_CASE("SummaryKernels: All blank")
+{
+    std::vector<double> const values(20, DCGM_FP64_BLANK);
+    std::vector<timelib64_t> timestamps(20);
+    for (size_t i = 0; i < timestamps.size(); i++)
+    {
+        timestamps[i] = 1000 + i;
+    }
+
+    DcgmSummaryState<double> state;
+    DcgmSummarizeChunk(values.data(), timestamps.data(), values.size(), true, state);
+
+    CHECK(state.numSeen == 20);
+    CHECK(state.numSeenAtLastValue == 0);
+    CHECK(DCGM_FP64_IS_BLANK(state.minValue));
+    CHECK(DCGM_FP64_IS_BLANK(state.maxValue));
+    CHECK(DCGM_FP64_IS_BLANK(state.integral));
+    CHECK(state.sumValue == 0);
+}
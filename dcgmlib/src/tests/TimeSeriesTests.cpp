@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <timeseries.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+TEST_CASE("TimeSeries: Ring buffer matches keyedvector behavior")
+{
+    int errorSt       = 0;
+    timeseries_p kv   = timeseries_alloc(TS_TYPE_INT64, &errorSt);
+    timeseries_p ring = timeseries_alloc_ring(TS_TYPE_INT64, 4, &errorSt);
+    REQUIRE(kv != nullptr);
+    REQUIRE(ring != nullptr);
+
+    /* In order, out of order and duplicate timestamps. 10 entries also forces the ring to grow */
+    timelib64_t const timestamps[] = { 100, 200, 300, 250, 300, 400, 500, 600, 50, 700 };
+    long long value                = 0;
+    for (auto ts : timestamps)
+    {
+        CHECK(timeseries_insert_int64(kv, ts, value, 0) == TS_ST_OK);
+        CHECK(timeseries_insert_int64(ring, ts, value, 0) == TS_ST_OK);
+        value++;
+    }
+
+    REQUIRE(timeseries_size(ring) == timeseries_size(kv));
+
+    timeseries_cursor_t kvCursor;
+    timeseries_cursor_t ringCursor;
+    timeseries_entry_p kvEntry   = timeseries_first(kv, &kvCursor);
+    timeseries_entry_p ringEntry = timeseries_first(ring, &ringCursor);
+    for (; kvEntry && ringEntry;
+         kvEntry = timeseries_next(kv, &kvCursor), ringEntry = timeseries_next(ring, &ringCursor))
+    {
+        CHECK(ringEntry->usecSince1970 == kvEntry->usecSince1970);
+        CHECK(ringEntry->val.i64 == kvEntry->val.i64);
+    }
+    CHECK(kvEntry == nullptr);
+    CHECK(ringEntry == nullptr);
+
+    for (int findOp : { TS_LGE_EQUAL, TS_LGE_LESSEQUAL, TS_LGE_GREATEQUAL, TS_LGE_LESS, TS_LGE_GREATER })
+    {
+        for (timelib64_t ts : { 25, 50, 250, 275, 301, 700, 800 })
+        {
+            kvEntry   = timeseries_find(kv, ts, findOp, nullptr);
+            ringEntry = timeseries_find(ring, ts, findOp, nullptr);
+            REQUIRE((kvEntry == nullptr) == (ringEntry == nullptr));
+            if (kvEntry)
+            {
+                CHECK(ringEntry->usecSince1970 == kvEntry->usecSince1970);
+            }
+        }
+    }
+
+    CHECK(timeseries_sum_int64(ring, 0, 0, &errorSt) == timeseries_sum_int64(kv, 0, 0, &errorSt));
+
+    /* Quota by time, then by count */
+    CHECK(timeseries_enforce_quota(kv, 300, 0) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(ring, 300, 0) == TS_ST_OK);
+    CHECK(timeseries_size(ring) == timeseries_size(kv));
+    CHECK(timeseries_first(ring, nullptr)->usecSince1970 == 300);
+
+    CHECK(timeseries_enforce_quota(kv, 0, 2) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(ring, 0, 2) == TS_ST_OK);
+    REQUIRE(timeseries_size(ring) == 2);
+    CHECK(timeseries_first(ring, nullptr)->usecSince1970 == timeseries_first(kv, nullptr)->usecSince1970);
+    CHECK(timeseries_last(ring, nullptr)->usecSince1970 == 700);
+
+    timeseries_destroy(kv);
+    timeseries_destroy(ring);
+}
+
+TEST_CASE("TimeSeries: Bulk append matches one insert at a time")
+{
+    int errorSt           = 0;
+    timeseries_p single   = timeseries_alloc(TS_TYPE_DOUBLE, &errorSt);
+    timeseries_p appended = timeseries_alloc(TS_TYPE_DOUBLE, &errorSt);
+    REQUIRE(single != nullptr);
+    REQUIRE(appended != nullptr);
+
+    /* Enough to span many keyedvector blocks, then a duplicate and an older timestamp that take the slow path */
+    std::vector<timeseries_entry_t> entries(1000);
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        entries[i].usecSince1970 = 1000 + 10 * (timelib64_t)i;
+        entries[i].val.dbl       = (double)i;
+        entries[i].val2.dbl      = 0.0;
+    }
+    entries.push_back(entries.back());
+    entries.push_back(entries.front());
+    entries.back().usecSince1970 = 5;
+
+    for (auto entry : entries)
+    {
+        CHECK(timeseries_insert_double(single, entry.usecSince1970, entry.val.dbl, entry.val2.dbl) == TS_ST_OK);
+    }
+    CHECK(timeseries_append(appended, entries.data(), (int)entries.size()) == TS_ST_OK);
+
+    auto const sameEntries = [&] {
+        REQUIRE(timeseries_size(appended) == timeseries_size(single));
+        timeseries_cursor_t singleCursor;
+        timeseries_cursor_t appendedCursor;
+        timeseries_entry_p singleEntry   = timeseries_first(single, &singleCursor);
+        timeseries_entry_p appendedEntry = timeseries_first(appended, &appendedCursor);
+        for (; singleEntry && appendedEntry; singleEntry = timeseries_next(single, &singleCursor),
+                                             appendedEntry = timeseries_next(appended, &appendedCursor))
+        {
+            CHECK(appendedEntry->usecSince1970 == singleEntry->usecSince1970);
+            CHECK(appendedEntry->val.dbl == singleEntry->val.dbl);
+        }
+    };
+    sameEntries();
+    CHECK(timeseries_size(appended) == 1002);
+
+    /* Quota by time evicts from the head, partway into a block, then by count */
+    CHECK(timeseries_enforce_quota(single, 2005, 0) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(appended, 2005, 0) == TS_ST_OK);
+    sameEntries();
+    CHECK(timeseries_first(appended, nullptr)->usecSince1970 == 2010);
+
+    CHECK(timeseries_enforce_quota(single, 0, 300) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(appended, 0, 300) == TS_ST_OK);
+    sameEntries();
+    CHECK(timeseries_size(appended) == 300);
+
+    CHECK(timeseries_enforce_quota(appended, 100000, 0) == TS_ST_OK);
+    CHECK(timeseries_size(appended) == 0);
+
+    timeseries_entry_t i64Entry {};
+    timeseries_p strings = timeseries_alloc(TS_TYPE_STRING, &errorSt);
+    REQUIRE(strings != nullptr);
+    CHECK(timeseries_append(strings, &i64Entry, 1) == TS_ST_WRONGTYPE);
+
+    timeseries_destroy(single);
+    timeseries_destroy(appended);
+    timeseries_destroy(strings);
+}
+
+TEST_CASE("TimeSeries: Ring buffer only supports numeric types")
+{
+    int errorSt = 0;
+    CHECK(timeseries_alloc_ring(TS_TYPE_STRING, 4, &errorSt) == nullptr);
+    CHECK(errorSt == TS_ST_BADPARAM);
+    CHECK(timeseries_alloc_ring(TS_TYPE_DOUBLE, 0, &errorSt) == nullptr);
+    CHECK(errorSt == TS_ST_BADPARAM);
+}
+
+TEST_CASE("TimeSeries: Compressed storage matches keyedvector behavior")
+{
+    int errorSt       = 0;
+    timeseries_p kv   = timeseries_alloc(TS_TYPE_DOUBLE, &errorSt);
+    timeseries_p comp = timeseries_alloc_compressed(TS_TYPE_DOUBLE, &errorSt);
+    REQUIRE(kv != nullptr);
+    REQUIRE(comp != nullptr);
+
+    /* Enough entries to seal several blocks, with some timestamp jitter and repeated values */
+    timelib64_t ts = 1000000;
+    for (int i = 0; i < 1000; i++)
+    {
+        ts += 1000000 + (i % 7) * 13;
+        double value = (i % 10 < 5) ? 42.0 : 42.0 + i * 0.25;
+        CHECK(timeseries_insert_double(kv, ts, value, -value) == TS_ST_OK);
+        CHECK(timeseries_insert_double(comp, ts, value, -value) == TS_ST_OK);
+    }
+
+    /* Out of order inserts into a sealed block and onto an existing timestamp */
+    CHECK(timeseries_insert_double(kv, 5000000, 1.5, 0.0) == TS_ST_OK);
+    CHECK(timeseries_insert_double(comp, 5000000, 1.5, 0.0) == TS_ST_OK);
+    CHECK(timeseries_insert_double(kv, 5000000, 2.5, 0.0) == TS_ST_OK);
+    CHECK(timeseries_insert_double(comp, 5000000, 2.5, 0.0) == TS_ST_OK);
+
+    auto compareAll = [&]() {
+        REQUIRE(timeseries_size(comp) == timeseries_size(kv));
+
+        timeseries_cursor_t kvCursor;
+        timeseries_cursor_t compCursor;
+        timeseries_entry_p kvEntry   = timeseries_first(kv, &kvCursor);
+        timeseries_entry_p compEntry = timeseries_first(comp, &compCursor);
+        for (; kvEntry && compEntry;
+             kvEntry = timeseries_next(kv, &kvCursor), compEntry = timeseries_next(comp, &compCursor))
+        {
+            REQUIRE(compEntry->usecSince1970 == kvEntry->usecSince1970);
+            REQUIRE(compEntry->val.dbl == kvEntry->val.dbl);
+            REQUIRE(compEntry->val2.dbl == kvEntry->val2.dbl);
+        }
+        CHECK(kvEntry == nullptr);
+        CHECK(compEntry == nullptr);
+
+        kvEntry   = timeseries_last(kv, &kvCursor);
+        compEntry = timeseries_last(comp, &compCursor);
+        for (; kvEntry && compEntry;
+             kvEntry = timeseries_prev(kv, &kvCursor), compEntry = timeseries_prev(comp, &compCursor))
+        {
+            REQUIRE(compEntry->usecSince1970 == kvEntry->usecSince1970);
+        }
+        CHECK(kvEntry == nullptr);
+        CHECK(compEntry == nullptr);
+    };
+
+    compareAll();
+
+    timeseries_cursor_t kvCursor;
+    timeseries_cursor_t compCursor;
+    for (int findOp : { TS_LGE_EQUAL, TS_LGE_LESSEQUAL, TS_LGE_GREATEQUAL, TS_LGE_LESS, TS_LGE_GREATER })
+    {
+        for (timelib64_t findTs : { (timelib64_t)0, (timelib64_t)5000000, (timelib64_t)5000001, ts - 1, ts, ts + 1 })
+        {
+            timeseries_entry_p kvEntry   = timeseries_find(kv, findTs, findOp, &kvCursor);
+            timeseries_entry_p compEntry = timeseries_find(comp, findTs, findOp, &compCursor);
+            REQUIRE((kvEntry == nullptr) == (compEntry == nullptr));
+            if (kvEntry)
+            {
+                CHECK(compEntry->usecSince1970 == kvEntry->usecSince1970);
+            }
+        }
+    }
+
+    CHECK(timeseries_average(comp, 0, 0, &errorSt) == timeseries_average(kv, 0, 0, &errorSt));
+
+    /* Repetitive samples should take far less than a plain entry each */
+    CHECK(timeseries_compressed_bytes(comp) > 0);
+    CHECK(timeseries_compressed_bytes(comp) < (long long)(sizeof(timeseries_entry_t) * 1000 / 2));
+
+    /* Quota by time lands in the middle of a sealed block. Then quota by count */
+    timelib64_t oldestKeep = 1000000 + 300 * 1000000;
+    CHECK(timeseries_enforce_quota(kv, oldestKeep, 0) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(comp, oldestKeep, 0) == TS_ST_OK);
+    compareAll();
+
+    CHECK(timeseries_enforce_quota(kv, 0, 50) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(comp, 0, 50) == TS_ST_OK);
+    compareAll();
+
+    timeseries_destroy(kv);
+    timeseries_destroy(comp);
+}
+
+TEST_CASE("TimeSeries: Arena string and blob storage")
+{
+    int errorSt        = 0;
+    timeseries_p arena = timeseries_alloc_arena(TS_TYPE_STRING, &errorSt);
+    REQUIRE(arena != nullptr);
+
+    CHECK(timeseries_alloc_arena(TS_TYPE_INT64, &errorSt) == nullptr);
+    CHECK(errorSt == TS_ST_BADPARAM);
+
+    char buffer[64];
+    for (int i = 0; i < 20000; i++)
+    {
+        snprintf(buffer, sizeof(buffer), "sample %d", i);
+        REQUIRE(timeseries_insert_string(arena, 1000000 + i * 1000000LL, buffer) == TS_ST_OK);
+    }
+
+    long long reservedBytes = 0;
+    long long liveBytes     = 0;
+    timeseries_arena_bytes(arena, &reservedBytes, &liveBytes);
+    CHECK(liveBytes > 0);
+    CHECK(reservedBytes >= liveBytes);
+
+    timeseries_cursor_t cursor;
+    timeseries_entry_p entry = timeseries_first(arena, &cursor);
+    REQUIRE(entry != nullptr);
+    CHECK(std::string((char *)entry->val.ptr) == "sample 0");
+    entry = timeseries_last(arena, &cursor);
+    REQUIRE(entry != nullptr);
+    CHECK(std::string((char *)entry->val.ptr) == "sample 19999");
+
+    /* Evicting most samples should give whole chunks back */
+    CHECK(timeseries_enforce_quota(arena, 0, 10) == TS_ST_OK);
+    long long trimmedReserved = 0;
+    long long trimmedLive     = 0;
+    timeseries_arena_bytes(arena, &trimmedReserved, &trimmedLive);
+    CHECK(trimmedLive < liveBytes / 100);
+    CHECK(trimmedReserved < reservedBytes / 2);
+    entry = timeseries_first(arena, &cursor);
+    REQUIRE(entry != nullptr);
+    CHECK(std::string((char *)entry->val.ptr) == "sample 19990");
+
+    CHECK(timeseries_enforce_quota(arena, 0, 1) == TS_ST_OK);
+    CHECK(timeseries_enforce_quota(arena, 1000000000000LL, 0) == TS_ST_OK);
+    timeseries_arena_bytes(arena, &trimmedReserved, &trimmedLive);
+    CHECK(timeseries_size(arena) == 0);
+    CHECK(trimmedLive == 0);
+
+    timeseries_destroy(arena);
+
+    /* Blobs bigger than a chunk get one of their own */
+    timeseries_p blobs = timeseries_alloc_arena(TS_TYPE_BLOB, &errorSt);
+    REQUIRE(blobs != nullptr);
+    std::vector<char> big(100000, 'x');
+    REQUIRE(timeseries_insert_blob(blobs, 1000000, big.data(), (int)big.size()) == TS_ST_OK);
+    REQUIRE(timeseries_insert_blob(blobs, 2000000, buffer, sizeof(buffer)) == TS_ST_OK);
+    entry = timeseries_first(blobs, &cursor);
+    REQUIRE(entry != nullptr);
+    CHECK(entry->val2.ptrSize == (long long)big.size());
+    CHECK(memcmp(entry->val.ptr, big.data(), big.size()) == 0);
+    CHECK(timeseries_bytes_used(blobs) > (long long)big.size());
+    timeseries_destroy(blobs);
+}
+
+TEST_CASE("TimeSeries: Arena shares repeated values")
+{
+    int errorSt        = 0;
+    timeseries_p blobs = timeseries_alloc_arena(TS_TYPE_BLOB, &errorSt);
+    REQUIRE(blobs != nullptr);
+
+    std::vector<char> value(4000, 'a');
+    REQUIRE(timeseries_insert_blob(blobs, 1000000, value.data(), (int)value.size()) == TS_ST_OK);
+    long long liveBytes = 0;
+    timeseries_arena_bytes(blobs, nullptr, &liveBytes);
+
+    for (int i = 1; i < 100; i++)
+    {
+        REQUIRE(timeseries_insert_blob(blobs, 1000000 + i * 1000000LL, value.data(), (int)value.size()) == TS_ST_OK);
+    }
+
+    /* All samples point at the first one's value */
+    long long sharedLiveBytes = 0;
+    timeseries_arena_bytes(blobs, nullptr, &sharedLiveBytes);
+    CHECK(sharedLiveBytes == liveBytes);
+
+    timeseries_cursor_t cursor;
+    timeseries_entry_p first = timeseries_first(blobs, &cursor);
+    timeseries_entry_p last  = timeseries_last(blobs, &cursor);
+    REQUIRE(first != nullptr);
+    REQUIRE(last != nullptr);
+    CHECK(first->val.ptr == last->val.ptr);
+
+    /* A changed value gets its own memory and later samples share that one */
+    value[0] = 'b';
+    REQUIRE(timeseries_insert_blob(blobs, 200000000, value.data(), (int)value.size()) == TS_ST_OK);
+    REQUIRE(timeseries_insert_blob(blobs, 201000000, value.data(), (int)value.size()) == TS_ST_OK);
+    timeseries_arena_bytes(blobs, nullptr, &sharedLiveBytes);
+    CHECK(sharedLiveBytes == 2 * liveBytes);
+
+    /* Evicting all but one reference keeps the value alive */
+    CHECK(timeseries_enforce_quota(blobs, 0, 3) == TS_ST_OK);
+    first = timeseries_first(blobs, &cursor);
+    REQUIRE(first != nullptr);
+    CHECK(((char *)first->val.ptr)[0] == 'a');
+    CHECK(((char *)first->val.ptr)[1] == 'a');
+
+    CHECK(timeseries_enforce_quota(blobs, 0, 2) == TS_ST_OK);
+    timeseries_arena_bytes(blobs, nullptr, &sharedLiveBytes);
+    CHECK(sharedLiveBytes == liveBytes);
+    timeseries_destroy(blobs);
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmTopology.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <random>
+
+namespace
+{
+void Link(DcgmLinkScores &linkScores, unsigned int gpuA, unsigned int gpuB, unsigned int score)
+{
+    linkScores[gpuA][gpuB] = score;
+    linkScores[gpuB][gpuA] = score;
+}
+
+/* Two pairs linked by one NvLink each, everything else by two */
+DcgmLinkScores FourGpus()
+{
+    DcgmLinkScores linkScores {};
+    Link(linkScores, 0, 1, 1);
+    Link(linkScores, 0, 2, 2);
+    Link(linkScores, 0, 3, 2);
+    Link(linkScores, 1, 2, 2);
+    Link(linkScores, 1, 3, 2);
+    Link(linkScores, 2, 3, 1);
+    return linkScores;
+}
+} // namespace
+
+TEST_CASE("Topology: BuildLinkScores")
+{
+    dcgmTopology_t top {};
+    top.numElements         = 2;
+    top.element[0].dcgmGpuA = 0;
+    top.element[0].dcgmGpuB = 1;
+    top.element[0].path     = (dcgmGpuTopologyLevel_t)(DCGM_TOPOLOGY_NVLINK2 | DCGM_TOPOLOGY_SINGLE);
+    top.element[1].dcgmGpuA = 1;
+    top.element[1].dcgmGpuB = 2;
+    top.element[1].path     = DCGM_TOPOLOGY_NVLINK4;
+
+    DcgmLinkScores linkScores;
+    BuildLinkScores(&top, linkScores);
+
+    CHECK(linkScores[0][1] == 2);
+    CHECK(linkScores[1][0] == 2);
+    CHECK(linkScores[1][2] == 4);
+    CHECK(linkScores[2][1] == 4);
+    CHECK(linkScores[0][2] == 0);
+}
+
+TEST_CASE("Topology: FindBestGpuSets")
+{
+    DcgmLinkScores linkScores = FourGpus();
+
+    SECTION("Bad requests")
+    {
+        CHECK(FindBestGpuSets(linkScores, 0xF, 0, 1).empty());
+        CHECK(FindBestGpuSets(linkScores, 0xF, 5, 1).empty());
+        CHECK(FindBestGpuSets(linkScores, 0xF, 2, 0).empty());
+    }
+
+    SECTION("Ties go to the GPUs that share the strongest links first")
+    {
+        auto sets = FindBestGpuSets(linkScores, 0xF, 2, 1);
+        REQUIRE(sets.size() == 1);
+        CHECK(sets[0].gpus == 0x5);
+        CHECK(sets[0].score == 2);
+
+        sets = FindBestGpuSets(linkScores, 0xF, 3, 1);
+        REQUIRE(sets.size() == 1);
+        CHECK(sets[0].gpus == 0xD);
+        CHECK(sets[0].score == 5);
+
+        sets = FindBestGpuSets(linkScores, 0xF, 4, 1);
+        REQUIRE(sets.size() == 1);
+        CHECK(sets[0].gpus == 0xF);
+        CHECK(sets[0].score == 10);
+    }
+
+    SECTION("Top K")
+    {
+        auto sets = FindBestGpuSets(linkScores, 0xF, 2, 10);
+        REQUIRE(sets.size() == 6);
+        CHECK(sets[0].gpus == 0x5);
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            CHECK(sets[i].score == 2);
+        }
+        CHECK(sets[4].score == 1);
+        CHECK(sets[5].score == 1);
+    }
+
+    SECTION("Only candidate GPUs are picked")
+    {
+        auto sets = FindBestGpuSets(linkScores, 0xB, 2, 1);
+        REQUIRE(sets.size() == 1);
+        CHECK((sets[0].gpus == 0x9 || sets[0].gpus == 0xA));
+        CHECK(sets[0].score == 2);
+    }
+
+    SECTION("No NvLinks")
+    {
+        DcgmLinkScores none {};
+        auto sets = FindBestGpuSets(none, 0xF0, 2, 1);
+        REQUIRE(sets.size() == 1);
+        CHECK(sets[0].gpus == 0x30);
+        CHECK(sets[0].score == 0);
+    }
+}
+
+TEST_CASE("Topology: FindBestGpuSets agrees with trying every set")
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<unsigned int> scoreDist(0, 4);
+
+    for (unsigned int round = 0; round < 20; round++)
+    {
+        DcgmLinkScores linkScores {};
+        unsigned int const numCandidates = 10;
+        for (unsigned int a = 0; a < numCandidates; a++)
+        {
+            for (unsigned int b = a + 1; b < numCandidates; b++)
+            {
+                Link(linkScores, a, b, scoreDist(rng));
+            }
+        }
+
+        /* Leave a couple of busy GPUs out */
+        std::uint64_t const candidates = ((std::uint64_t { 1 } << numCandidates) - 1) & ~std::uint64_t { 0x24 };
+        unsigned int const numGpus     = 2 + round % 5;
+
+        std::vector<unsigned int> expected;
+        for (std::uint64_t gpus = 0; gpus < (std::uint64_t { 1 } << numCandidates); gpus++)
+        {
+            if ((gpus & ~candidates) != 0 || std::popcount(gpus) != static_cast<int>(numGpus))
+            {
+                continue;
+            }
+
+            unsigned int score = 0;
+            for (unsigned int a = 0; a < numCandidates; a++)
+            {
+                for (unsigned int b = a + 1; b < numCandidates; b++)
+                {
+                    if ((gpus >> a & 1) && (gpus >> b & 1))
+                    {
+                        score += linkScores[a][b];
+                    }
+                }
+            }
+            expected.push_back(score);
+        }
+        std::ranges::sort(expected, std::greater<>());
+        expected.resize(5);
+
+        auto sets = FindBestGpuSets(linkScores, candidates, numGpus, 5);
+        REQUIRE(sets.size() == 5);
+        for (unsigned int i = 0; i < sets.size(); i++)
+        {
+            CHECK((sets[i].gpus & ~candidates) == 0);
+            CHECK(std::popcount(sets[i].gpus) == static_cast<int>(numGpus));
+            CHECK(sets[i].score == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("Topology: FindBestGpuSets on a full mesh of 32 GPUs")
+{
+    DcgmLinkScores linkScores {};
+    for (unsigned int a = 0; a < DCGM_MAX_NUM_DEVICES; a++)
+    {
+        for (unsigned int b = a + 1; b < DCGM_MAX_NUM_DEVICES; b++)
+        {
+            Link(linkScores, a, b, 18);
+        }
+    }
+
+    /* C(32, 16) sets. This only finishes because equal links are pruned */
+    auto sets = FindBestGpuSets(linkScores, 0xFFFFFFFF, 16, 4);
+    REQUIRE(sets.size() == 4);
+    CHECK(sets[0].score == 16 * 15 / 2 * 18);
+    CHECK(sets[3].score == sets[0].score);
+}
+
+TEST_CASE("Topology: MatchByIO picks the best connected affinity group")
+{
+    DcgmLinkScores linkScores = FourGpus();
+    Link(linkScores, 4, 5, 3);
+
+    std::vector<std::vector<unsigned int>> affinityGroups { { 0, 1, 2, 3 }, { 4, 5 } };
+    std::vector<size_t> potentialCpuMatches { 0, 1 };
+    uint64_t outputGpus = 0;
+
+    MatchByIO(affinityGroups, linkScores, potentialCpuMatches, 2, outputGpus);
+    CHECK(outputGpus == 0x30);
+
+    /* The second group is too small */
+    MatchByIO(affinityGroups, linkScores, potentialCpuMatches, 3, outputGpus);
+    CHECK(outputGpus == 0xD);
+}
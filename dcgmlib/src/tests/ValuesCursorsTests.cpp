@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmValuesCursors.h>
+#include <dcgm_fields.h>
+
+#include <map>
+#include <vector>
+
+namespace
+{
+struct Sample
+{
+    timelib64_t timestamp;
+    long long value;
+};
+
+/* Stands in for the cache manager. Samples of each fieldId are kept in timestamp order */
+class FakeCache
+{
+public:
+    std::map<unsigned short, std::vector<Sample>> samples;
+    int reads = 0;
+
+    DcgmValuesCursors::Reader GetReader()
+    {
+        return [this](dcgm_entity_key_t const &key,
+                      int *count,
+                      timelib64_t startTs,
+                      timelib64_t endTs,
+                      DcgmFvBuffer &fvBuffer) {
+            reads++;
+            auto it = samples.find(key.fieldId);
+            if (it == samples.end())
+            {
+                *count = 0;
+                return DCGM_ST_NOT_WATCHED;
+            }
+
+            int read = 0;
+            for (Sample const &sample : it->second)
+            {
+                if (sample.timestamp < startTs || sample.timestamp > endTs || read == *count)
+                {
+                    continue;
+                }
+                fvBuffer.AddInt64Value(
+                    DCGM_FE_GPU, key.entityId, key.fieldId, sample.value, sample.timestamp, DCGM_ST_OK);
+                read++;
+            }
+            *count = read;
+            return read == 0 ? DCGM_ST_NO_DATA : DCGM_ST_OK;
+        };
+    }
+};
+
+dcgm_entity_key_t MakeKey(unsigned short fieldId)
+{
+    dcgm_entity_key_t key {};
+    key.entityGroupId = DCGM_FE_GPU;
+    key.entityId      = 0;
+    key.fieldId       = fieldId;
+    return key;
+}
+
+/* Read cursorId to the end, maxBytes at a time. Returns the values in the order they were returned */
+std::vector<long long> ReadAll(DcgmValuesCursors &cursors,
+                               DcgmValuesCursors::Reader const &reader,
+                               unsigned int cursorId,
+                               size_t maxBytes,
+                               unsigned int &numChunks,
+                               timelib64_t &nextSinceTimestamp)
+{
+    std::vector<long long> values;
+    numChunks = 0;
+
+    dcgm_values_cursor_chunk_t chunk;
+    do
+    {
+        REQUIRE(cursors.Next(1, cursorId, reader, maxBytes, chunk) == DCGM_ST_OK);
+        REQUIRE(chunk.fvBytes.size() <= maxBytes);
+        numChunks++;
+
+        DcgmFvBuffer fvBuffer(0);
+        fvBuffer.SetFromBuffer(chunk.fvBytes.data(), chunk.fvBytes.size());
+        dcgmBufferedFvCursor_t fvCursor = 0;
+        for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&fvCursor); fv; fv = fvBuffer.GetNextFv(&fvCursor))
+        {
+            values.push_back(fv->value.i64);
+        }
+    } while (!chunk.done);
+
+    nextSinceTimestamp = chunk.nextSinceTimestamp;
+    return values;
+}
+} // namespace
+
+TEST_CASE("ValuesCursors: Chunks return every value once")
+{
+    FakeCache cache;
+    std::vector<long long> expected;
+    /* Several values per timestamp so chunks end in the middle of a timestamp */
+    for (long long i = 0; i < 3000; i++)
+    {
+        cache.samples[DCGM_FI_DEV_GPU_TEMP].push_back({ 1000 + i / 3, i });
+        expected.push_back(i);
+    }
+    for (long long i = 0; i < 10; i++)
+    {
+        cache.samples[DCGM_FI_DEV_POWER_USAGE].push_back({ 1000 + i, 10000 + i });
+        expected.push_back(10000 + i);
+    }
+
+    DcgmValuesCursors cursors;
+    unsigned int cursorId = 0;
+    REQUIRE(cursors.Open(1,
+                         { MakeKey(DCGM_FI_DEV_GPU_TEMP), MakeKey(DCGM_FI_DEV_SM_CLOCK), MakeKey(DCGM_FI_DEV_POWER_USAGE) },
+                         0,
+                         5000,
+                         cursorId)
+            == DCGM_ST_OK);
+
+    /* Room for 100 values a chunk */
+    DcgmFvBuffer oneValue;
+    oneValue.AddInt64Value(DCGM_FE_GPU, 0, DCGM_FI_DEV_GPU_TEMP, 0, 1000, DCGM_ST_OK);
+    size_t valueBytes = 0;
+    oneValue.GetSize(&valueBytes, nullptr);
+    size_t const maxBytes = 100 * valueBytes;
+    unsigned int numChunks;
+    timelib64_t nextSinceTimestamp;
+    CHECK(ReadAll(cursors, cache.GetReader(), cursorId, maxBytes, numChunks, nextSinceTimestamp) == expected);
+    CHECK(numChunks == 31);
+    CHECK(nextSinceTimestamp == 5001);
+
+    /* Reading past the end keeps saying done */
+    dcgm_values_cursor_chunk_t chunk;
+    REQUIRE(cursors.Next(1, cursorId, cache.GetReader(), maxBytes, chunk) == DCGM_ST_OK);
+    CHECK(chunk.done);
+    CHECK(chunk.fvBytes.empty());
+}
+
+TEST_CASE("ValuesCursors: Values are limited to the cursor's time range")
+{
+    FakeCache cache;
+    for (long long i = 0; i < 10; i++)
+    {
+        cache.samples[DCGM_FI_DEV_GPU_TEMP].push_back({ 1000 * i, i });
+    }
+
+    DcgmValuesCursors cursors;
+    unsigned int cursorId = 0;
+    REQUIRE(cursors.Open(1, { MakeKey(DCGM_FI_DEV_GPU_TEMP) }, 3000, 6500, cursorId) == DCGM_ST_OK);
+
+    unsigned int numChunks;
+    timelib64_t nextSinceTimestamp;
+    CHECK(ReadAll(cursors, cache.GetReader(), cursorId, 1 << 20, numChunks, nextSinceTimestamp)
+          == std::vector<long long> { 3, 4, 5, 6 });
+    CHECK(numChunks == 1);
+    CHECK(nextSinceTimestamp == 6501);
+}
+
+TEST_CASE("ValuesCursors: Open and close")
+{
+    FakeCache cache;
+    DcgmValuesCursors cursors;
+    unsigned int cursorId = 0;
+    dcgm_values_cursor_chunk_t chunk;
+
+    for (unsigned int i = 0; i < DcgmValuesCursors::c_maxCursorsPerConnection; i++)
+    {
+        REQUIRE(cursors.Open(1, {}, 0, 1000, cursorId) == DCGM_ST_OK);
+    }
+    CHECK(cursors.Open(1, {}, 0, 1000, cursorId) == DCGM_ST_MAX_LIMIT);
+
+    /* The limit is per connection */
+    REQUIRE(cursors.Open(2, {}, 0, 1000, cursorId) == DCGM_ST_OK);
+    CHECK(cursors.GetCount() == DcgmValuesCursors::c_maxCursorsPerConnection + 1);
+
+    /* Cursors belong to their connection */
+    CHECK(cursors.Next(1, cursorId, cache.GetReader(), 1024, chunk) == DCGM_ST_BADPARAM);
+    CHECK(cursors.Close(1, cursorId) == DCGM_ST_BADPARAM);
+    REQUIRE(cursors.Next(2, cursorId, cache.GetReader(), 1024, chunk) == DCGM_ST_OK);
+    CHECK(chunk.done);
+    CHECK(cursors.Close(2, cursorId) == DCGM_ST_OK);
+    CHECK(cursors.Close(2, cursorId) == DCGM_ST_BADPARAM);
+
+    cursors.RemoveConnection(1);
+    CHECK(cursors.GetCount() == 0);
+    CHECK(cursors.Open(1, {}, 0, 1000, cursorId) == DCGM_ST_OK);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmWatchScheduler.h>
+
+#include <vector>
+
+/* The scheduler never dereferences the watches, so any distinct addresses will do */
+static dcgmcm_watch_info_t *FakeWatch(std::vector<char> &storage, unsigned int index)
+{
+    return reinterpret_cast<dcgmcm_watch_info_t *>(&storage[index]);
+}
+
+TEST_CASE("WatchScheduler: Watches pop in due order")
+{
+    DcgmWatchScheduler scheduler;
+    std::vector<char> storage(8);
+    std::vector<dcgmcm_watch_info_t *> due;
+
+    CHECK(scheduler.GetEarliestDue() == 0);
+    CHECK(scheduler.GetSize() == 0);
+
+    scheduler.Schedule(3000, FakeWatch(storage, 3));
+    scheduler.Schedule(1000, FakeWatch(storage, 1));
+    scheduler.Schedule(2000, FakeWatch(storage, 2));
+    scheduler.Schedule(1000, FakeWatch(storage, 4));
+
+    CHECK(scheduler.GetSize() == 4);
+    CHECK(scheduler.GetEarliestDue() == 1000);
+
+    /* Nothing is due yet */
+    scheduler.PopDue(999, due);
+    CHECK(due.empty());
+
+    /* Equal due times come back in the order they were scheduled */
+    scheduler.PopDue(1000, due);
+    REQUIRE(due.size() == 2);
+    CHECK(due[0] == FakeWatch(storage, 1));
+    CHECK(due[1] == FakeWatch(storage, 4));
+    CHECK(scheduler.GetEarliestDue() == 2000);
+
+    /* PopDue appends */
+    scheduler.PopDue(5000, due);
+    REQUIRE(due.size() == 4);
+    CHECK(due[2] == FakeWatch(storage, 2));
+    CHECK(due[3] == FakeWatch(storage, 3));
+    CHECK(scheduler.GetSize() == 0);
+    CHECK(scheduler.GetEarliestDue() == 0);
+}
+
+TEST_CASE("WatchScheduler: Rescheduling and Clear")
+{
+    DcgmWatchScheduler scheduler;
+    std::vector<char> storage(4);
+    std::vector<dcgmcm_watch_info_t *> due;
+
+    /* Simulate a 100 usec and a 300 usec watch over a few cycles */
+    scheduler.Schedule(0, FakeWatch(storage, 0));
+    scheduler.Schedule(0, FakeWatch(storage, 1));
+
+    unsigned int numUpdates[2] = { 0, 0 };
+    for (timelib64_t now = 0; now < 600; now = scheduler.GetEarliestDue())
+    {
+        due.clear();
+        scheduler.PopDue(now, due);
+        for (auto *watch : due)
+        {
+            bool isFast = (watch == FakeWatch(storage, 0));
+            numUpdates[isFast ? 0 : 1]++;
+            scheduler.Schedule(now + (isFast ? 100 : 300), watch);
+        }
+    }
+
+    CHECK(numUpdates[0] == 6);
+    CHECK(numUpdates[1] == 2);
+    CHECK(scheduler.GetSize() == 2);
+
+    scheduler.Clear();
+    CHECK(scheduler.GetSize() == 0);
+    CHECK(scheduler.GetEarliestDue() == 0);
+}
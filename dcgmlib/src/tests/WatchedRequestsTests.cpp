@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <DcgmWatchedRequests.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+
+namespace
+{
+class CallbackRequest : public DcgmRequest
+{
+public:
+    CallbackRequest(std::function<void()> callback, std::atomic_int &destroyed)
+        : DcgmRequest(DCGM_REQUEST_ID_NONE)
+        , m_callback(std::move(callback))
+        , m_destroyed(destroyed)
+    {}
+
+    ~CallbackRequest() override
+    {
+        m_destroyed++;
+    }
+
+    int ProcessMessage(std::unique_ptr<DcgmMessage>) override
+    {
+        m_callback();
+        return DCGM_ST_OK;
+    }
+
+private:
+    std::function<void()> m_callback;
+    std::atomic_int &m_destroyed;
+};
+} // namespace
+
+TEST_CASE("WatchedRequests: a callback can remove its own request and add another")
+{
+    DcgmWatchedRequests requests;
+    std::atomic_int destroyed { 0 };
+    dcgm_request_id_t requestId = DCGM_REQUEST_ID_NONE;
+    dcgm_request_id_t addedId   = DCGM_REQUEST_ID_NONE;
+    bool removed                = false;
+    int destroyedInCallback     = -1;
+
+    auto callback = [&]() {
+        removed = requests.Remove(requestId);
+        requests.Add(std::make_unique<CallbackRequest>([] {}, destroyed), addedId);
+        destroyedInCallback = destroyed.load();
+    };
+    REQUIRE(requests.Add(std::make_unique<CallbackRequest>(callback, destroyed), requestId) == DCGM_ST_OK);
+    CHECK(requestId != DCGM_REQUEST_ID_NONE);
+
+    CHECK(requests.Deliver(requestId, std::make_unique<DcgmMessage>()) == DCGM_ST_OK);
+    CHECK(removed);
+    CHECK(addedId != DCGM_REQUEST_ID_NONE);
+    CHECK(addedId != requestId);
+
+    /* The request outlived its removal until its callback returned */
+    CHECK(destroyedInCallback == 0);
+    CHECK(destroyed == 1);
+
+    CHECK(requests.Deliver(requestId, std::make_unique<DcgmMessage>()) == DCGM_ST_BADPARAM);
+    CHECK(requests.Deliver(addedId, std::make_unique<DcgmMessage>()) == DCGM_ST_OK);
+
+    requests.Clear();
+    CHECK(destroyed == 2);
+    CHECK(!requests.Remove(addedId));
+}
+
+TEST_CASE("WatchedRequests: a callback that takes a host engine lock doesn't deadlock with its holder")
+{
+    using namespace std::chrono_literals;
+
+    /* Stands in for the host engine lock that module unload holds while it removes requests */
+    std::mutex engineLock;
+    DcgmWatchedRequests requests;
+    std::atomic_int destroyed { 0 };
+    std::promise<void> inCallback;
+    std::promise<void> engineLockHeld;
+
+    auto callback = [&]() {
+        inCallback.set_value();
+        engineLockHeld.get_future().wait_for(5s);
+        std::lock_guard<std::mutex> lg(engineLock);
+    };
+    dcgm_request_id_t requestId = DCGM_REQUEST_ID_NONE;
+    REQUIRE(requests.Add(std::make_unique<CallbackRequest>(callback, destroyed), requestId) == DCGM_ST_OK);
+
+    auto inCallbackFuture = inCallback.get_future();
+    auto delivery = std::async(std::launch::async, [&] {
+        return requests.Deliver(requestId, std::make_unique<DcgmMessage>());
+    });
+    REQUIRE(inCallbackFuture.wait_for(5s) == std::future_status::ready);
+
+    /* Take the engine lock, then the requests lock, while the callback waits for the engine lock */
+    std::unique_lock<std::mutex> engineLockGuard(engineLock);
+    engineLockHeld.set_value();
+    dcgm_request_id_t addedId = DCGM_REQUEST_ID_NONE;
+    auto add                  = std::async(std::launch::async, [&] {
+        return requests.Add(std::make_unique<CallbackRequest>([] {}, destroyed), addedId);
+    });
+    REQUIRE(add.wait_for(5s) == std::future_status::ready);
+    CHECK(add.get() == DCGM_ST_OK);
+    engineLockGuard.unlock();
+
+    REQUIRE(delivery.wait_for(5s) == std::future_status::ready);
+    CHECK(delivery.get() == DCGM_ST_OK);
+    requests.Clear();
+    CHECK(destroyed == 2);
+}
+
+TEST_CASE("WatchedRequests: Remove waits for the deliveries in flight to the request")
+{
+    using namespace std::chrono_literals;
+
+    DcgmWatchedRequests requests;
+    std::atomic_int destroyed { 0 };
+    std::atomic_bool callbackReturned { false };
+    std::promise<void> inCallback;
+    std::promise<void> finishCallback;
+    auto finishCallbackFuture = finishCallback.get_future();
+
+    auto callback = [&]() {
+        inCallback.set_value();
+        finishCallbackFuture.wait_for(5s);
+        callbackReturned = true;
+    };
+    dcgm_request_id_t requestId = DCGM_REQUEST_ID_NONE;
+    REQUIRE(requests.Add(std::make_unique<CallbackRequest>(callback, destroyed), requestId) == DCGM_ST_OK);
+
+    auto inCallbackFuture = inCallback.get_future();
+    auto delivery = std::async(std::launch::async, [&] {
+        return requests.Deliver(requestId, std::make_unique<DcgmMessage>());
+    });
+    REQUIRE(inCallbackFuture.wait_for(5s) == std::future_status::ready);
+
+    auto remove = std::async(std::launch::async, [&] { return requests.Remove(requestId); });
+    CHECK(remove.wait_for(100ms) == std::future_status::timeout);
+
+    /* No new deliveries while it waits */
+    CHECK(requests.Deliver(requestId, std::make_unique<DcgmMessage>()) == DCGM_ST_BADPARAM);
+
+    finishCallback.set_value();
+    REQUIRE(remove.wait_for(5s) == std::future_status::ready);
+    CHECK(callbackReturned);
+    CHECK(remove.get());
+
+    REQUIRE(delivery.wait_for(5s) == std::future_status::ready);
+    CHECK(delivery.get() == DCGM_ST_OK);
+    CHECK(destroyed == 1);
+}
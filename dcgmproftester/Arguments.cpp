@@ -17,6 +17,7 @@
 #include "DcgmLogging.h"
 #include "dcgm_fields_internal.hpp"
 
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <vector>
@@ -127,6 +128,8 @@ dcgmReturn_t ArgumentSet_t::ProcessFieldIds(void)
     arguments->m_parameters.m_noDcgmValidation  = m_noDcgmValidation.Value();
     arguments->m_parameters.m_dvsOutput         = m_dvsOutput.Value();
     arguments->m_parameters.m_cublas            = m_cublas.Value();
+    arguments->m_parameters.m_threaded          = m_threaded.Value();
+    arguments->m_parameters.m_persistentKernels = m_persistentKernels.Value();
 
     double minValue;
     double maxValue;
@@ -249,6 +252,10 @@ dcgmReturn_t ArgumentSet_t::ProcessFieldIds(void)
                           {
                               arguments->m_parameters.m_fast = setting;
                           }
+                          else if (mode.compare(pos, std::string::npos, "benchmark") == 0)
+                          {
+                              arguments->m_parameters.m_benchmark = setting;
+                          }
                           else
                           {
                               DCGM_LOG_ERROR << "Arguments -- bad mode " << mode;
@@ -259,6 +266,34 @@ dcgmReturn_t ArgumentSet_t::ProcessFieldIds(void)
                           return DCGM_ST_OK;
                       });
 
+    dcgmReturn_t intervalReturn = ProcessStringList(
+        m_benchmarkIntervalString.Value(),
+        arguments,
+        false,
+        [](ArgumentSet_t & /* self */,
+           std::shared_ptr<Arguments_t> arguments,
+           bool /* useDefaults */,
+           const std::string &interval) mutable -> dcgmReturn_t {
+            char *end { nullptr };
+            double seconds = strtod(interval.c_str(), &end);
+
+            if ((end == interval.c_str()) || (*end != '\0') || !(seconds > 0.0))
+            {
+                DCGM_LOG_ERROR << "Arguments -- bad benchmark interval " << interval;
+
+                return DCGM_ST_BADPARAM;
+            }
+
+            arguments->m_parameters.m_benchmarkIntervals.push_back(seconds);
+
+            return DCGM_ST_OK;
+        });
+
+    if (intervalReturn != DCGM_ST_OK)
+    {
+        return intervalReturn;
+    }
+
     arguments->m_parameters.m_logFile = m_logFileString.Value();
 
     arguments->m_parameters.m_logLevel
@@ -479,9 +514,12 @@ dcgmReturn_t ArgumentSet_t::Parse(int argc, char *argv[])
             m_noDcgmValidation.ArgReset();
             m_dvsOutput.ArgReset();
             m_cublas.ArgReset();
+            m_threaded.ArgReset();
+            m_persistentKernels.ArgReset();
             m_fieldIds.ArgReset();
             m_gpuIdString.ArgReset();
             m_modeString.ArgReset();
+            m_benchmarkIntervalString.ArgReset();
             m_reset.ArgReset();
             m_logFileString.ArgReset();
             m_logLevelString.ArgReset();
@@ -58,11 +58,16 @@ public:
 
         // Operational flags.
 
-        bool m_generate { true };  // whether to generate load
-        bool m_report { true };    // whether to produce report
-        bool m_validate { false }; // whether to validate
-        bool m_fast { false };     // whether to finish as soon as possible
-        bool m_cublas { false };   // whether to use cublas.
+        bool m_generate { true };           // whether to generate load
+        bool m_report { true };             // whether to produce report
+        bool m_validate { false };          // whether to validate
+        bool m_fast { false };              // whether to finish as soon as possible
+        bool m_cublas { false };            // whether to use cublas.
+        bool m_threaded { false };          // whether to run CUDA workers as threads.
+        bool m_persistentKernels { false }; // whether to keep sleep kernels resident across duty cycles.
+        bool m_benchmark { false };         // whether to benchmark profiling overhead.
+
+        std::vector<double> m_benchmarkIntervals; // <list> 1,0.1,0.01 --- benchmark watch intervals in seconds
 
         unsigned int m_fieldId; // <value> --- ---  profiling FieldId
     } m_parameters;
@@ -294,10 +299,13 @@ private:
     Argument_t<bool> m_noDcgmValidation;
     Argument_t<bool> m_dvsOutput;
     Argument_t<bool> m_cublas;
+    Argument_t<bool> m_threaded;
+    Argument_t<bool> m_persistentKernels;
     Argument_t<std::string> m_fieldIds;
     Argument_t<std::string> m_gpuIdString;
     Argument_t<bool> m_reset;
     Argument_t<std::string> m_modeString;
+    Argument_t<std::string> m_benchmarkIntervalString;
     Argument_t<unsigned int> m_syncCount;
     Argument_t<std::string> m_logFileString;
     Argument_t<std::string> m_logLevelString;
@@ -508,6 +516,24 @@ public:
                    m_shortMap,
                    m_longMap,
                    [](decltype(m_cublas) & /* arg */) { return; })
+        , m_threaded(m_cmd,
+                     false,
+                     false,
+                     std::string(""),
+                     std::string("threaded"),
+                     std::string("Run the CUDA workers of non-MIG GPUs as threads of this process"),
+                     m_shortMap,
+                     m_longMap,
+                     [](decltype(m_threaded) & /* arg */) { return; })
+        , m_persistentKernels(m_cmd,
+                              false,
+                              false,
+                              std::string(""),
+                              std::string("persistent-kernels"),
+                              std::string("Keep SM activity and occupancy kernels resident across duty cycles"),
+                              m_shortMap,
+                              m_longMap,
+                              [](decltype(m_persistentKernels) & /* arg */) { return; })
         ,
 
 #define xstr(s) str(s)
@@ -579,13 +605,27 @@ public:
             std::string(""),
             std::string("mode"),
             std::string("operational mode"),
-            std::string("operational mode: fast, generate load, report, validate"),
-            std::string("operational mode must be one of [no]fast, [no]generateload, [no]report, [no]validate"),
+            std::string("operational mode: benchmark, fast, generate load, report, validate"),
+            std::string(
+                "operational mode must be one of [no]benchmark, [no]fast, [no]generateload, [no]report, [no]validate"),
             [](decltype(m_modeString) & /* arg */, const decltype(m_modeString)::ArgType & /* value */) {
                 return true;
             })
         ,
 
+        m_benchmarkIntervalString(
+            m_cmd,
+            std::string("1,0.1,0.01"),
+            false,
+            std::string(""),
+            std::string("benchmark-intervals"),
+            std::string("benchmark watch intervals"),
+            std::string("List of intervals in seconds to watch profiling metric groups at in benchmark mode"),
+            std::string("Benchmark watch intervals must be positive numbers of seconds"),
+            [](decltype(m_benchmarkIntervalString) & /* arg */,
+               const decltype(m_benchmarkIntervalString)::ArgType & /* value */) { return true; })
+        ,
+
         m_syncCount(
             m_cmd,
             1,
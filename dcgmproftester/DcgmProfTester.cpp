@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <DcgmLogging.h>
+#include <DcgmUtilities.h>
 #include <cuda.h>
 
 #include "Arguments.h"
@@ -37,13 +38,16 @@
 #include <tclap/ValueArg.h>
 #include <tclap/ValuesConstraint.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <csignal>
 #include <cstdint>
+#include <fmt/format.h>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <sys/types.h>
 #include <system_error>
@@ -59,6 +63,35 @@ namespace DcgmNs::ProfTester
 std::atomic_bool g_signalCaught = false;
 }
 
+namespace
+{
+/* Throughput a GPU achieved in one benchmark run */
+struct BenchmarkStats
+{
+    double m_mean { 0.0 };  /* Mean over the worker ticks */
+    double m_worst { 0.0 }; /* Slowest worker tick */
+};
+
+BenchmarkStats GetBenchmarkStats(std::vector<double> const &samples)
+{
+    BenchmarkStats stats {};
+
+    if (!samples.empty())
+    {
+        stats.m_mean  = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        stats.m_worst = *std::min_element(samples.begin(), samples.end());
+    }
+
+    return stats;
+}
+
+/* Change of value over baseline, in percent */
+double PercentDelta(double value, double baseline)
+{
+    return (baseline > 0.0) ? 100.0 * (value - baseline) / baseline : 0.0;
+}
+} // namespace
+
 
 /*****************************************************************************/
 /* ctor/dtor */
@@ -180,7 +213,10 @@ dcgmReturn_t DcgmProfTester::DestroyDcgmGroups(void)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmProfTester::WatchFields(long long updateIntervalUsec, double maxKeepAge, unsigned int testFieldId)
+dcgmReturn_t DcgmProfTester::WatchFields(dcgmFieldGrp_t fieldGroupId,
+                                         long long updateIntervalUsec,
+                                         double maxKeepAge,
+                                         unsigned int testFieldId)
 {
     dcgmReturn_t dcgmReturn = DCGM_ST_OK;
 
@@ -194,7 +230,7 @@ dcgmReturn_t DcgmProfTester::WatchFields(long long updateIntervalUsec, double ma
     }
 
     dcgmReturn
-        = dcgmWatchFields(m_dcgmHandle, m_groupId, m_fieldGroupId, updateIntervalUsec, maxKeepAge, maxKeepSamples);
+        = dcgmWatchFields(m_dcgmHandle, m_groupId, fieldGroupId, updateIntervalUsec, maxKeepAge, maxKeepSamples);
     if (dcgmReturn == DCGM_ST_REQUIRES_ROOT)
     {
         DCGM_LOG_ERROR << "Profiling requires running as root.";
@@ -229,6 +265,11 @@ dcgmReturn_t DcgmProfTester::WatchFields(long long updateIntervalUsec, double ma
         DCGM_LOG_ERROR << "dcgmWatchFields() returned " << dcgmReturn << ".";
     }
 
+    if (dcgmReturn == DCGM_ST_OK)
+    {
+        m_watchedFieldGroupId = fieldGroupId;
+    }
+
     return dcgmReturn;
 }
 
@@ -244,7 +285,13 @@ dcgmReturn_t DcgmProfTester::UnwatchFields(void)
         return DCGM_ST_OK;
     }
 
-    dcgmReturn = dcgmUnwatchFields(m_dcgmHandle, m_groupId, m_fieldGroupId);
+    if (m_watchedFieldGroupId == 0)
+    {
+        return DCGM_ST_OK;
+    }
+
+    dcgmReturn            = dcgmUnwatchFields(m_dcgmHandle, m_groupId, m_watchedFieldGroupId);
+    m_watchedFieldGroupId = 0;
     if (dcgmReturn != DCGM_ST_OK)
     {
         DCGM_LOG_ERROR << "dcgmUnwatchFields() returned " << dcgmReturn << ".";
@@ -414,6 +461,11 @@ dcgmReturn_t DcgmProfTester::InitializeGpus(const Arguments_t &arguments)
     if (dcgmReturn != DCGM_ST_OK)
         return dcgmReturn;
 
+    if (arguments.m_parameters.m_threaded && HasMigGpus())
+    {
+        DCGM_LOG_WARNING << "Running CUDA workers as processes, since a GPU is in MIG mode.";
+    }
+
     dcgmReturn = CreateDcgmGroups(arguments.m_parameters.m_fieldId);
     if (dcgmReturn != DCGM_ST_OK)
         return dcgmReturn;
@@ -540,6 +592,21 @@ void DcgmProfTester::SetNextPart(unsigned int value)
 }
 
 
+/*****************************************************************************/
+bool DcgmProfTester::HasMigGpus(void) const
+{
+    for ([[maybe_unused]] auto &[gpuId, gpu] : m_gpus)
+    {
+        if (gpu->IsMIG())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
 /*****************************************************************************/
 void DcgmProfTester::ReportWorkerStarted(std::shared_ptr<DistributedCudaContext> worker)
 {
@@ -765,6 +832,15 @@ dcgmReturn_t DcgmProfTester::ProcessResponses(unsigned int maxGpusInParallel,
 
             rtSt = physicalGpu->ProcessResponse(worker);
 
+            /**
+             * A frame can carry several responses, but the file descriptor is
+             * only readable again once another frame arrives.
+             */
+            while ((rtSt == DCGM_ST_OK) && !physicalGpu->WorkerReported() && worker->HasBufferedLine())
+            {
+                rtSt = physicalGpu->ProcessResponse(worker);
+            }
+
             if (physicalGpu->WorkerReported())
             {
                 FD_CLR(fd, &m_parentReadFds);
@@ -865,6 +941,19 @@ dcgmReturn_t DcgmProfTester::RunTests(double reportingInterval,
                                       double duration,
                                       unsigned int testFieldId,
                                       unsigned int maxGpusInParallel)
+{
+    static const unsigned int cUsecInSec = 1000000;
+
+    return RunTests(duration, testFieldId, maxGpusInParallel, m_fieldGroupId, cUsecInSec * reportingInterval);
+}
+
+
+/*****************************************************************************/
+dcgmReturn_t DcgmProfTester::RunTests(double duration,
+                                      unsigned int testFieldId,
+                                      unsigned int maxGpusInParallel,
+                                      dcgmFieldGrp_t fieldGroupId,
+                                      long long updateIntervalUsec)
 {
     dcgmReturn_t rtSt { DCGM_ST_OK };
 
@@ -904,9 +993,8 @@ dcgmReturn_t DcgmProfTester::RunTests(double reportingInterval,
         return rtSt;
     }
 
-    static const unsigned int cUsecInSec = 1000000;
-
-    if ((rtSt = WatchFields(cUsecInSec * reportingInterval, duration, testFieldId)) != DCGM_ST_OK)
+    if ((fieldGroupId != 0)
+        && ((rtSt = WatchFields(fieldGroupId, updateIntervalUsec, duration, testFieldId)) != DCGM_ST_OK))
     {
         NukeChildren(true);
 
@@ -968,6 +1056,188 @@ dcgmReturn_t DcgmProfTester::RunTests(double reportingInterval,
 }
 
 
+/*****************************************************************************/
+dcgmReturn_t DcgmProfTester::RunBenchmark(const Arguments_t::Parameters &parameters)
+{
+    static const unsigned int cUsecInSec = 1000000;
+
+    const char *unit { nullptr };
+
+    switch (parameters.m_fieldId)
+    {
+        case DCGM_FI_PROF_PCIE_TX_BYTES:
+        case DCGM_FI_PROF_PCIE_RX_BYTES:
+        case DCGM_FI_PROF_NVLINK_TX_BYTES:
+        case DCGM_FI_PROF_NVLINK_RX_BYTES:
+            unit = "MiB/sec";
+            break;
+
+        case DCGM_FI_PROF_DRAM_ACTIVE:
+            unit = "GB/sec";
+            break;
+
+        case DCGM_FI_PROF_PIPE_FP32_ACTIVE:
+        case DCGM_FI_PROF_PIPE_FP64_ACTIVE:
+        case DCGM_FI_PROF_PIPE_FP16_ACTIVE:
+            /* Without cuBLAS, these only target an activity level */
+            unit = parameters.m_cublas ? "gflops" : nullptr;
+            break;
+
+        case DCGM_FI_PROF_PIPE_TENSOR_ACTIVE:
+            unit = "gflops";
+            break;
+
+        default:
+            break;
+    }
+
+    if (unit == nullptr)
+    {
+        warn_reporter << "TestField " << parameters.m_fieldId
+                      << " can't be benchmarked, since its workload does not measure its throughput."
+                      << ReporterBase::new_line;
+
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    if (!m_startDcgm)
+    {
+        error_reporter << "Benchmarking watches profiling metrics, so it can't be run with --no-dcgm-validation."
+                       << ReporterBase::new_line;
+
+        return DCGM_ST_BADPARAM;
+    }
+
+    if (m_gpus.empty())
+    {
+        DCGM_LOG_ERROR << "There are no GPUs to benchmark.";
+
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    /* dcgmproftester only tests identical GPUs, so the first one speaks for all of them */
+    dcgmProfGetMetricGroups_t metricGroups {};
+
+    metricGroups.version = dcgmProfGetMetricGroups_version;
+    metricGroups.gpuId   = m_gpus.begin()->first;
+
+    dcgmReturn_t rtSt = dcgmProfGetSupportedMetricGroups(m_dcgmHandle, &metricGroups);
+
+    if (rtSt != DCGM_ST_OK)
+    {
+        DCGM_LOG_ERROR << "dcgmProfGetSupportedMetricGroups() returned " << rtSt << ".";
+
+        return rtSt;
+    }
+
+    auto const runPass = [this, &parameters](dcgmFieldGrp_t fieldGroupId,
+                                             double watchInterval,
+                                             std::map<unsigned int, BenchmarkStats> &stats) -> dcgmReturn_t {
+        dcgmReturn_t passSt = RunTests(parameters.m_duration,
+                                       parameters.m_fieldId,
+                                       parameters.m_maxGpusInParallel,
+                                       fieldGroupId,
+                                       cUsecInSec * watchInterval);
+
+        for (auto &[gpuId, gpu] : m_gpus)
+        {
+            stats[gpuId] = GetBenchmarkStats(gpu->TakeBenchmarkSamples());
+        }
+
+        return passSt;
+    };
+
+    std::map<unsigned int, BenchmarkStats> baseline;
+
+    if ((rtSt = runPass(0, 0.0, baseline)) != DCGM_ST_OK)
+    {
+        return rtSt;
+    }
+
+    for (auto &[gpuId, stats] : baseline)
+    {
+        info_reporter << fmt::format("Benchmark GPU {:d}, TestField {:d}, nothing watched: {:#.4} {} mean, "
+                                     "{:#.4} {} slowest tick.",
+                                     gpuId,
+                                     parameters.m_fieldId,
+                                     stats.m_mean,
+                                     unit,
+                                     stats.m_worst,
+                                     unit)
+                      << ReporterBase::new_line;
+    }
+
+    for (unsigned int i = 0; i < metricGroups.numMetricGroups; i++)
+    {
+        dcgmProfMetricGroupInfo_v2 &metricGroup = metricGroups.metricGroups[i];
+        dcgmFieldGrp_t fieldGroupId { 0 };
+        std::string fieldIds;
+
+        for (unsigned int j = 0; j < metricGroup.numFieldIds; j++)
+        {
+            fieldIds += fmt::format("{}{:d}", (j == 0) ? "" : ",", metricGroup.fieldIds[j]);
+        }
+
+        char groupName[32] = { 0 };
+        snprintf(groupName, sizeof(groupName), "dpt_%d_%u", getpid(), i);
+
+        rtSt = dcgmFieldGroupCreate(
+            m_dcgmHandle, metricGroup.numFieldIds, metricGroup.fieldIds, groupName, &fieldGroupId);
+
+        if (rtSt != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "dcgmFieldGroupCreate() returned " << rtSt << ".";
+
+            return rtSt;
+        }
+
+        for (double watchInterval : parameters.m_benchmarkIntervals)
+        {
+            std::map<unsigned int, BenchmarkStats> watched;
+
+            if ((rtSt = runPass(fieldGroupId, watchInterval, watched)) != DCGM_ST_OK)
+            {
+                break;
+            }
+
+            for (auto &[gpuId, stats] : watched)
+            {
+                info_reporter << fmt::format("Benchmark GPU {:d}, TestField {:d}, metric group {:d}.{:d} ({}) "
+                                             "watched every {:g} sec: {:#.4} {} mean ({:+.2f}%), "
+                                             "{:#.4} {} slowest tick ({:+.2f}%).",
+                                             gpuId,
+                                             parameters.m_fieldId,
+                                             metricGroup.majorId,
+                                             metricGroup.minorId,
+                                             fieldIds,
+                                             watchInterval,
+                                             stats.m_mean,
+                                             unit,
+                                             PercentDelta(stats.m_mean, baseline[gpuId].m_mean),
+                                             stats.m_worst,
+                                             unit,
+                                             PercentDelta(stats.m_worst, baseline[gpuId].m_worst))
+                              << ReporterBase::new_line;
+            }
+        }
+
+        dcgmReturn_t destroySt = dcgmFieldGroupDestroy(m_dcgmHandle, fieldGroupId);
+
+        if (destroySt != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "dcgmFieldGroupDestroy() returned " << destroySt << ".";
+        }
+
+        if (rtSt != DCGM_ST_OK)
+        {
+            return rtSt;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+
 /**
  * Initializes CUDA contexts - one per physical CPU or one per MIG slice.
  *
@@ -1093,6 +1363,9 @@ int main(int argc, char **argv)
 
         dcgmReturn_t dcgmReturn;
 
+        /* Our kernels are PTX. Keep what the driver compiles them to even if $HOME is read-only */
+        DcgmNs::Utils::EnsureWritableCudaJitCache();
+
         int cudaLoaded = 0;
         auto cuResult  = cuDriverGetVersion(&cudaLoaded);
         if (cuResult != CUDA_SUCCESS)
@@ -1154,10 +1427,12 @@ int main(int argc, char **argv)
                 return dcgmReturn;
             }
 
-            dcgmReturn_t st = dpt->RunTests(arguments->m_parameters.m_reportInterval,
-                                            arguments->m_parameters.m_duration,
-                                            arguments->m_parameters.m_fieldId,
-                                            arguments->m_parameters.m_maxGpusInParallel);
+            dcgmReturn_t st = arguments->m_parameters.m_benchmark
+                                  ? dpt->RunBenchmark(arguments->m_parameters)
+                                  : dpt->RunTests(arguments->m_parameters.m_reportInterval,
+                                                  arguments->m_parameters.m_duration,
+                                                  arguments->m_parameters.m_fieldId,
+                                                  arguments->m_parameters.m_maxGpusInParallel);
 
             if (st != DCGM_ST_OK)
             {
@@ -81,6 +81,24 @@ public:
                           unsigned int testFieldId,
                           unsigned int maxGpusInParallel);
 
+    /*************************************************************************/
+    /*
+     * Measure how much watching profiling metrics slows down the workload of
+     * the test. The workload is run at a fixed intensity with nothing watched,
+     * and then with each supported profiling metric group watched at each
+     * benchmark interval. The throughput achieved in each run is reported
+     * against the unwatched one.
+     *
+     * Only tests whose workers measure their throughput (PCIe, NvLink, DRAM
+     * and the cuBLAS GEMM tests) can be benchmarked.
+     *
+     * Arguments:
+     *     parameters - test parameters, including the benchmark intervals.
+     *
+     * Returns 0 on success. !0 on failure.
+     */
+    dcgmReturn_t RunBenchmark(const DcgmNs::ProfTester::Arguments_t::Parameters &parameters);
+
     /*************************************************************************/
     /*
      * Reports that a worker has started. This is generally used so we can ask
@@ -103,6 +121,12 @@ public:
      */
     void ReportWorkerFailed(std::shared_ptr<DcgmNs::ProfTester::DistributedCudaContext> worker);
 
+    /*************************************************************************/
+    /*
+     * Whether any GPU being tested is in MIG mode.
+     */
+    bool HasMigGpus(void) const;
+
     /* Child reporting control. */
 
     bool IsFirstTick(void) const;
@@ -138,9 +162,23 @@ private:
     dcgmReturn_t CreateDcgmGroups(short unsigned int fieldId);
     dcgmReturn_t DestroyDcgmGroups(void);
 
-    dcgmReturn_t WatchFields(long long updateIntervalUsec, double maxKeepAge, unsigned int testFieldId);
+    dcgmReturn_t WatchFields(dcgmFieldGrp_t fieldGroupId,
+                             long long updateIntervalUsec,
+                             double maxKeepAge,
+                             unsigned int testFieldId);
 
-    dcgmReturn_t UnwatchFields(void);
+    dcgmReturn_t UnwatchFields(void); /* Unwatch what WatchFields() last watched */
+
+    /*************************************************************************/
+    /*
+     * Run the tests, watching fieldGroupId every updateIntervalUsec while
+     * they run. A fieldGroupId of 0 watches nothing.
+     */
+    dcgmReturn_t RunTests(double duration,
+                          unsigned int testFieldId,
+                          unsigned int maxGpusInParallel,
+                          dcgmFieldGrp_t fieldGroupId,
+                          long long updateIntervalUsec);
 
     /* Child process control. */
     dcgmReturn_t CreateWorkers(unsigned int testFieldId); /* Create workers (MIG and whole GPU) */
@@ -228,6 +266,8 @@ private:
     dcgmGpuGrp_t m_groupId { (uintptr_t) nullptr };        /* GPUs we're watching */
     dcgmFieldGrp_t m_fieldGroupId { (uintptr_t) nullptr }; /* Fields watched */
 
+    dcgmFieldGrp_t m_watchedFieldGroupId { (uintptr_t) nullptr }; /* Fields being watched now */
+
     std::vector<dcgmFieldValue_v1> m_dcgmValues; /* Cache of values that have been fetched so far. */
 
     long long m_sinceTimestamp { 0 }; /* Cursor for fetching field values from DCGM. */
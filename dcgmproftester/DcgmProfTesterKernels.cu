@@ -303,4 +303,39 @@ __global__ void doWorkloadFP16(__half *pretendSideEffect, uint64_t runForNs)
     {
         *pretendSideEffect = dummyValue;
     }
-}
\ No newline at end of file
+}
+
+/** Stays resident until the host asks it to stop, so duty cycles don't pay a launch and
+    synchronize per period. control is host memory mapped into the device:
+    control[0] is set nonzero to stop and control[1] is a heartbeat the host bumps while it
+    still wants the kernel running. If the heartbeat doesn't change for timeoutNs, the kernel
+    exits on its own so a host that went away can't leave it spinning forever.
+*/
+extern "C"
+__global__ void waitForStop(volatile uint32_t *control, uint32_t pollNs, uint64_t timeoutNs)
+{
+    if (threadIdx.x == 0)
+    {
+        uint64_t now = __globaltimer();
+        uint64_t lastBeatNs = now;
+        uint32_t heartbeat = control[1];
+
+        while (control[0] == 0)
+        {
+            const uint64_t nextPollNs = now + pollNs;
+            while ((now = __globaltimer()) < nextPollNs);
+
+            const uint32_t beat = control[1];
+            if (beat != heartbeat)
+            {
+                heartbeat = beat;
+                lastBeatNs = now;
+            }
+            else if (now - lastBeatNs > timeoutNs)
+            {
+                break;
+            }
+        }
+    }
+    __syncthreads();
+}
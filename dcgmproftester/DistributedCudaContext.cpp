@@ -26,11 +26,15 @@
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fcntl.h>
 #include <iomanip>
 #include <iostream> // for debugging
 #include <libgen.h> // for dirname
+#include <poll.h>
+#include <string_view>
 #include <sys/prctl.h>
+#include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <system_error>
@@ -73,15 +77,18 @@ dcgmReturn_t DistributedCudaContext::Init(int inFd, int outFd)
      * we set the device ID properly.
      */
 
-    st = setenv("CUDA_VISIBLE_DEVICES", m_cudaVisibleDevices.c_str(), 1);
-    if (st != 0)
+    if (!m_inProcess)
     {
-        m_error << "std::setenv returned" << st << '\n';
+        st = setenv("CUDA_VISIBLE_DEVICES", m_cudaVisibleDevices.c_str(), 1);
+        if (st != 0)
+        {
+            m_error << "std::setenv returned" << st << '\n';
 
-        return DCGM_ST_GENERIC_ERROR;
-    }
+            return DCGM_ST_GENERIC_ERROR;
+        }
 
-    m_message << "std::setenv successfully set CUDA_VISIBLE_DEVICES to " << m_cudaVisibleDevices.c_str() << '\n';
+        m_message << "std::setenv successfully set CUDA_VISIBLE_DEVICES to " << m_cudaVisibleDevices.c_str() << '\n';
+    }
 
     cuSt = cuInit(0);
     if (cuSt)
@@ -269,6 +276,9 @@ void DistributedCudaContext::Reset(bool keepDcgmGroups)
         m_input.swap(temp);
     }
 
+    m_frame.clear();
+    m_peerClosed = false;
+
     {
         std::stringstream temp;
         m_message << "";
@@ -303,13 +313,70 @@ void DistributedCudaContext::Reset(bool keepDcgmGroups)
 
 // Send a command.
 //
-// This can also be used to send a response, since the parent and child pipe
+// This can also be used to send a response, since the parent and child socket
 // file descriptors are symmetrical. But, it is better to use the Respond()
 // function as it throws an exception on error. That is usually catastrophic
 // in the child.
 int DistributedCudaContext::Command(const char *format, std::va_list args)
 {
-    return vdprintf(m_outFd, format, args);
+    std::va_list argsCopy;
+
+    va_copy(argsCopy, args);
+    int length = vsnprintf(nullptr, 0, format, argsCopy);
+    va_end(argsCopy);
+
+    if (length < 0)
+    {
+        return length;
+    }
+
+    std::string payload(length, '\0');
+
+    vsnprintf(payload.data(), payload.size() + 1, format, args);
+
+    return WriteFrame(payload);
+}
+
+// Send one frame: the payload length followed by the payload.
+//
+// The whole frame is written, waiting for room if the peer is slow to read,
+// so frames never interleave.
+int DistributedCudaContext::WriteFrame(const std::string &payload)
+{
+    FrameLength const length = payload.size();
+    std::string frame(sizeof(length), '\0');
+
+    std::memcpy(frame.data(), &length, sizeof(length));
+    frame += payload;
+
+    size_t written = 0;
+
+    while (written < frame.size())
+    {
+        ssize_t st = send(m_outFd, frame.data() + written, frame.size() - written, MSG_NOSIGNAL);
+
+        if (st >= 0)
+        {
+            written += st;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            struct pollfd pfd = { m_outFd, POLLOUT, 0 };
+
+            // Give up on a peer that stopped reading rather than hang.
+            if (poll(&pfd, 1, 10000) == 0)
+            {
+                errno = ETIMEDOUT;
+                return -1;
+            }
+        }
+        else if (errno != EINTR)
+        {
+            return -1;
+        }
+    }
+
+    return static_cast<int>(payload.size());
 }
 
 // Send a command.
@@ -331,44 +398,39 @@ int DistributedCudaContext::Command(const char *format, ...)
 // Read from peer.
 //
 // If we're the child, we read from the parent. If we're the parent,
-// we read from the child. As this is a blocking call, the parent may wish
-// to use select() on an fd_set before reading. We read up to 1000 bytes at a
-// time. We return true when the requested data has been read, or false on
-// error.
+// we read from the child. We return true when the requested data has been
+// read, or false on error.
 //
 // This is really intended for the parent process to read a known number
-// of bytes (such as an indicated E(rror) or M(essage) response. It does mean
-// the parent process is "greedy" in that once it is notified that such a
-// response is available, it will block read it until it has it all, but
-// it avoids the parent having to keep partial response state for a number of
-// workers.
+// of bytes (such as an indicated E(rror) or M(essage) response. Those are
+// sent in the same frame as the line announcing them, so normally they were
+// all read along with it. If not, the parent is "greedy" and blocks until
+// the rest arrives, which avoids it having to keep partial response state
+// for a number of workers.
 //
 bool DistributedCudaContext::Read(size_t toRead)
 {
-    char buffer[1001];
-    int rtSt;
+    size_t const wanted = UnreadSize() + toRead;
 
-    do
+    while (UnreadSize() < wanted)
     {
-        size_t thisRead = toRead;
-
-        if (thisRead > (sizeof(buffer) - 1))
-        {
-            thisRead = sizeof(buffer) - 1;
-        }
-
-        rtSt = read(m_inFd, &buffer, thisRead);
+        int rtSt = ReadFrame();
 
-        if (rtSt <= 0)
+        if ((rtSt < 0) || m_peerClosed)
         {
             return false;
         }
 
-        buffer[rtSt] = '\0';
+        if (rtSt == 0)
+        {
+            struct pollfd pfd = { m_inFd, POLLIN, 0 };
 
-        m_input << buffer;
-        toRead -= rtSt;
-    } while (toRead > 0);
+            if ((poll(&pfd, 1, -1) < 0) && (errno != EINTR))
+            {
+                return false;
+            }
+        }
+    }
 
     return true;
 }
@@ -377,31 +439,106 @@ bool DistributedCudaContext::Read(size_t toRead)
 // Read from our peer.
 //
 // If we're the child, we read a command from the parent. If we're the parent,
-// we read a response from the child.
+// we read a response from the child. Lines left from an earlier frame are
+// handed out before another frame is read.
 //
 // Returns 1 on a successful read, 0 on no data (if non-blocking), and negative
 // on error.
 int DistributedCudaContext::ReadLn(void)
 {
-    char c;
-    int rtSt;
+    if (HasBufferedLine())
+    {
+        return 1;
+    }
+
+    int rtSt = ReadFrame();
+
+    if (rtSt <= 0)
+    {
+        return rtSt;
+    }
+
+    return HasBufferedLine() ? 1 : 0;
+}
+
 
-    while (((rtSt = read(m_inFd, &c, 1)) > 0))
+// Read what is available of the next frame.
+//
+// We read the length first, then no more than the rest of the frame, so data
+// for later frames stays in the socket and keeps it readable for select().
+int DistributedCudaContext::ReadFrame(void)
+{
+    for (;;)
     {
-        m_input << c;
+        size_t frameSize = sizeof(FrameLength);
 
-        if (c == '\n')
+        if (m_frame.size() >= sizeof(FrameLength))
         {
-            break;
+            FrameLength length;
+
+            std::memcpy(&length, m_frame.data(), sizeof(length));
+            frameSize += length;
+
+            if (m_frame.size() == frameSize)
+            {
+                m_input.write(m_frame.data() + sizeof(FrameLength), length);
+                m_frame.clear();
+
+                return 1;
+            }
+        }
+
+        char buffer[4096];
+        ssize_t rtSt = read(m_inFd, buffer, std::min(sizeof(buffer), frameSize - m_frame.size()));
+
+        if (rtSt > 0)
+        {
+            m_frame.append(buffer, rtSt);
+        }
+        else if (rtSt == 0) // peer closed its end
+        {
+            m_peerClosed = true;
+
+            return 0;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) // no data
+        {
+            return 0;
+        }
+        else if (errno != EINTR)
+        {
+            return -1;
         }
     }
+}
 
-    if ((rtSt == -1) && (errno == EAGAIN)) // no data
+
+// Number of bytes in the input stream that haven't been parsed yet.
+std::size_t DistributedCudaContext::UnreadSize(void)
+{
+    std::streamoff pos = m_input.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+    std::string_view input = m_input.view();
+
+    if ((pos < 0) || (static_cast<size_t>(pos) >= input.size()))
     {
-        rtSt = 0;
+        return 0;
     }
 
-    return rtSt;
+    return input.size() - pos;
+}
+
+
+// Whether a whole line that hasn't been parsed yet is in the input stream.
+//
+// Whitespace left over after parsing the previous line doesn't count.
+bool DistributedCudaContext::HasBufferedLine(void)
+{
+    std::string_view input = m_input.view();
+    std::string_view unread = input.substr(input.size() - UnreadSize());
+
+    size_t start = unread.find_first_not_of(" \t\r\n");
+
+    return (start != std::string_view::npos) && (unread.find('\n', start) != std::string_view::npos);
 }
 
 // Check for synchronization command.
@@ -495,6 +632,8 @@ void DistributedCudaContext::Exit(void)
 {
     Command("X\nX\n"); // Request exit;
     m_pid = 0;         // Forget about child.
+
+    m_threadRunning = false;
 }
 
 // Tell this worker it is finished processing data.
@@ -607,6 +746,19 @@ void DistributedCudaContext::MoveFrom(DistributedCudaContext &&other)
     std::swap(m_inFd, other.m_inFd);
     std::swap(m_outFd, other.m_outFd);
 
+    m_frame      = std::move(other.m_frame);
+    m_peerClosed = other.m_peerClosed;
+
+    if (m_workerThread.joinable())
+    {
+        m_workerThread.join();
+    }
+
+    m_threadWorker  = std::move(other.m_threadWorker);
+    m_workerThread  = std::move(other.m_workerThread);
+    m_threadRunning = other.m_threadRunning;
+    m_inProcess     = other.m_inProcess;
+
     m_physicalGpu       = other.m_physicalGpu;
     other.m_physicalGpu = nullptr;
 
@@ -645,6 +797,20 @@ DistributedCudaContext::DistributedCudaContext(
 }
 
 
+DistributedCudaContext::DistributedCudaContext(
+    WorkerThreadTag,
+    std::shared_ptr<PhysicalGpu> physicalGpu,
+    std::shared_ptr<std::map<dcgm_field_entity_group_t, dcgm_field_eid_t>> entities,
+    const dcgmGroupEntityPair_t &entity,
+    const std::string &cudaVisibleDevices)
+    : m_physicalGpu(physicalGpu)
+    , m_cudaVisibleDevices(cudaVisibleDevices)
+    , m_entity(entity)
+    , m_entities(std::move(entities))
+    , m_inProcess(true)
+{}
+
+
 DistributedCudaContext::DistributedCudaContext(DistributedCudaContext &&other)
     : m_entity({})
 {
@@ -656,6 +822,12 @@ DistributedCudaContext::~DistributedCudaContext()
 {
     Reset();
 
+    /* Closing our ends makes a worker thread exit once it next reads or responds */
+    if (m_workerThread.joinable())
+    {
+        m_workerThread.join();
+    }
+
     if (m_pid != 0) // We are the parent process, kill child if necessary
     {
         usleep(200000); // Wait a little bit.
@@ -1505,6 +1677,8 @@ int DistributedCudaContext::RunTest(void)
         return -1;
     }
 
+    m_cudaWorker.SetPersistentKernels(m_physicalGpu->UsePersistentKernels());
+
     switch (m_testFieldId)
     {
         case DCGM_FI_PROF_GR_ENGINE_ACTIVE:
@@ -1566,28 +1740,29 @@ int DistributedCudaContext::RunTest(void)
 // Are we already running?
 bool DistributedCudaContext::IsRunning(void) const
 {
-    return m_pid != 0;
+    return (m_pid != 0) || m_threadRunning;
 }
 
 
-// Run a test in a sub-process.
+// Run a test in a sub-process, or a thread with --threaded.
 int DistributedCudaContext::Run(void)
 {
-    extern std::atomic_bool g_signalCaught;
-
-    int retSt     = 0;
-    int exitValue = 0;
+    int retSt = 0;
     int toChildPipe[2];  // parent writes to this, child reads from this
     int toParentPipe[2]; // parent reads from this, child writes to this
 
     // TODO: SET GPU CUDA environment here or before entry.
 
-    if ((retSt = pipe(toChildPipe)) != 0)
+    /**
+     * These are socket pairs rather than pipes so writing to a closed one
+     * fails with EPIPE (see MSG_NOSIGNAL) instead of raising SIGPIPE.
+     */
+    if ((retSt = socketpair(AF_UNIX, SOCK_STREAM, 0, toChildPipe)) != 0)
     {
         return retSt;
     }
 
-    if ((retSt = pipe(toParentPipe)) != 0)
+    if ((retSt = socketpair(AF_UNIX, SOCK_STREAM, 0, toParentPipe)) != 0)
     {
         close(toChildPipe[0]);
         close(toChildPipe[1]);
@@ -1600,6 +1775,22 @@ int DistributedCudaContext::Run(void)
      */
     Reset(true);
 
+    /**
+     * A previous worker thread sees the file descriptors we just closed and
+     * exits.
+     */
+    if (m_workerThread.joinable())
+    {
+        m_workerThread.join();
+    }
+
+    m_threadWorker.reset();
+
+    if (GetPhysicalGpu()->UseWorkerThreads())
+    {
+        return RunThread(toChildPipe, toParentPipe);
+    }
+
     pid_t pid = fork();
 
     if (pid < 0) // error
@@ -1660,6 +1851,94 @@ int DistributedCudaContext::Run(void)
         m_failed = true;
     }
 
+    int exitValue = ServeCommands();
+
+    /* Note : No longer calling Reset() here before shutdown because that call hangs */
+
+    /* Make sure our worker thread is inactive before exiting to avoid queuing cuda work
+       at the same time the cuda atexit() handlers are running */
+    m_cudaWorker.Shutdown();
+
+    /* In the future, we shouldn't exit here, but that will require a more substantial
+       refactor of DistributedCudaContext and our forked worker */
+    exit(exitValue);
+}
+
+
+// Start the worker as a thread of this process.
+int DistributedCudaContext::RunThread(const int toChild[2], const int toParent[2])
+{
+    /**
+     * Without MIG, every worker has the same CUDA_VISIBLE_DEVICES and finds
+     * its device by bus ID. Set it here, before this worker's thread starts,
+     * and leave it alone if an earlier worker already did.
+     */
+    const char *cudaVisibleDevices = getenv("CUDA_VISIBLE_DEVICES");
+
+    if (((cudaVisibleDevices == nullptr) || (m_cudaVisibleDevices != cudaVisibleDevices))
+        && (setenv("CUDA_VISIBLE_DEVICES", m_cudaVisibleDevices.c_str(), 1) != 0))
+    {
+        close(toChild[0]);
+        close(toChild[1]);
+        close(toParent[0]);
+        close(toParent[1]);
+        return -1;
+    }
+
+    m_inFd  = toParent[0];
+    m_outFd = toChild[1];
+
+    // Make I/O in parent non-blocking.
+    if ((fcntl(m_inFd, F_SETFL, O_NONBLOCK) == -1) || (fcntl(m_outFd, F_SETFL, O_NONBLOCK) == -1))
+    {
+        close(toChild[0]);
+        close(toParent[1]);
+        return -1;
+    }
+
+    m_threadWorker.reset(
+        new DistributedCudaContext(WorkerThreadTag {}, m_physicalGpu, m_entities, m_entity, m_cudaVisibleDevices));
+
+    DistributedCudaContext *worker = m_threadWorker.get();
+    int workerInFd                 = toChild[0];
+    int workerOutFd                = toParent[1];
+
+    m_workerThread
+        = std::thread([worker, workerInFd, workerOutFd]() { worker->ServeThread(workerInFd, workerOutFd); });
+    m_threadRunning = true;
+    m_input.str("");
+    m_input.clear();
+
+    return 0;
+}
+
+
+// Body of a worker thread.
+void DistributedCudaContext::ServeThread(int inFd, int outFd)
+{
+    if (Init(inFd, outFd) != DCGM_ST_OK)
+    {
+        m_error << "failed to initialize, waiting to be told to exit." << '\n';
+        m_failed = true;
+    }
+
+    ServeCommands();
+
+    m_cudaWorker.Shutdown();
+
+    /* Close our ends, so the parent sees us go */
+    Reset(true);
+}
+
+
+// Serve commands from the parent until told to exit.
+int DistributedCudaContext::ServeCommands(void)
+{
+    extern std::atomic_bool g_signalCaught;
+
+    int retSt     = 0;
+    int exitValue = 0;
+
     try
     {
         /* Tell parent we are ready for commands and convey our initialization
@@ -1673,12 +1952,12 @@ int DistributedCudaContext::Run(void)
         {
             retSt = ReadLn();
 
-            if ((retSt < 0) || g_signalCaught) // FD reading error or signal interrupt
+            if ((retSt < 0) || g_signalCaught || m_peerClosed) // FD error, signal interrupt or parent went away
             {
                 /* Parent will see write pipe closed and get SIGCHLD. No point
                  * to setting m_failed, or an error, as process is gone. This
                  * is a bad one. Of course, parent could have died, closing
-                 * the write end of the pipe, and that causes us to die.
+                 * the write end of the pipe, and that causes us to exit.
                  */
                 exitValue = (int)DCGM_ST_GENERIC_ERROR;
                 break;
@@ -1755,15 +2034,7 @@ int DistributedCudaContext::Run(void)
         exitValue = (int)DCGM_ST_GENERIC_ERROR;
     }
 
-    /* Note : No longer calling Reset() here before shutdown because that call hangs */
-
-    /* Make sure our worker thread is inactive before exiting to avoid queuing cuda work
-       at the same time the cuda atexit() handlers are running */
-    m_cudaWorker.Shutdown();
-
-    /* In the future, we shouldn't exit here, but that will require a more substantial
-       refactor of DistributedCudaContext and our forked worker */
-    exit(exitValue);
+    return exitValue;
 }
 
 } // namespace DcgmNs::ProfTester
@@ -18,12 +18,14 @@
 #include <dcgm_structs.h>
 
 #include <cstdarg>
+#include <cstdint>
 #include <cuda.h>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "CudaWorker/CudaWorkerThread.hpp"
@@ -36,7 +38,19 @@
  * It is replicated between a DCGM parent process and (for each GPU instance)
  * CUDA worker process via a fork made in the DCGM parent process. After
  * forking, communication between the two processes takes place over unnamed
- * pipes created in the parent process prior to the fork.
+ * socket pairs created in the parent process prior to the fork.
+ *
+ * With --threaded, the workers of non-MIG GPUs are instead threads of the
+ * parent process, each with its own copy of this object, talking over the
+ * same kind of socket pairs. MIG slices are always forked: CUDA enumerates a
+ * single MIG instance per process, and CUDA can't be used in a process forked
+ * after CUDA was initialized, so no worker is a thread if any GPU is in MIG
+ * mode.
+ *
+ * Every command and response is sent as one frame: its length, as a native
+ * std::uint32_t, followed by that many bytes of the text described below. A
+ * frame can carry several lines. Frames let the reader take a whole message
+ * in a couple of reads instead of one read per byte.
  *
  * The worker process will respond with "P\n" (pass) or "F\n" fail over the
  * pipe to the parent when it forks. In both cases, it will wait for commands,
@@ -106,10 +120,9 @@
  * <error of length specified>", respectively. These commands should only be
  * sent once a test completes to gather forensics.
  *
- * Because reading from, or writing to, a closed pipe results in a SIGPIPE
- * signal, uncerimoniously closing the pipe (say on the unexpected exit of a
- * crashed peer process) will cause the current process to crash instead of
- * leaving behind a zombie. This is currently intentional. It should not happen.
+ * Writing to a socket whose peer closed it fails with EPIPE rather than
+ * raising SIGPIPE, so a worker thread can't take the parent process with it.
+ * A worker that can't respond, or sees the parent close its end, exits.
  */
 
 namespace DcgmNs::ProfTester
@@ -241,7 +254,8 @@ public:
      * descriptors in both parent and worker process.
      *
      * @return An int is returned, negative for error, zero in the worker
-     *          process, and the process ID in the parent process.
+     *          process, and the process ID in the parent process. When the
+     *          worker is a thread, zero is returned in the parent process.
      */
     int Run(void);
 
@@ -321,6 +335,18 @@ public:
      */
     int ReadLn(void);
 
+    /**
+     * \brief Whether a whole line that hasn't been parsed yet was read.
+     *
+     * A frame can carry several lines, but select() only reports the file
+     * descriptor as readable once per frame. The parent process calls this
+     * after handling a response to see if another one is waiting in the
+     * input stringstream.
+     *
+     * @return true if ReadLn() would return a line without reading.
+     */
+    bool HasBufferedLine(void);
+
     /**
      * \brief Get the input file descriptor.
      *
@@ -542,6 +568,23 @@ public:
 
 
 private:
+    using FrameLength = std::uint32_t; //!< length prefix of every frame
+
+    struct WorkerThreadTag
+    {};
+
+    /**
+     * \brief Construct the worker side of a threaded worker.
+     *
+     * Unlike the public constructor, this creates no DCGM groups. Those are
+     * only used by the parent side.
+     */
+    DistributedCudaContext(WorkerThreadTag,
+                           std::shared_ptr<DcgmNs::ProfTester::PhysicalGpu>,
+                           std::shared_ptr<std::map<dcgm_field_entity_group_t, dcgm_field_eid_t>>,
+                           const dcgmGroupEntityPair_t &,
+                           const std::string &);
+
     /** @name ExceptionClass
      * Exception class.
      * @{
@@ -633,6 +676,57 @@ private:
      */
     int ReadLnCheck(unsigned int &activity, bool &quitEarly);
 
+    /**
+     * \brief Read what is available of the next frame.
+     *
+     * Never reads past the end of the frame, so the file descriptor stays
+     * readable for select() while more frames are waiting.
+     *
+     * @return 1 when a whole frame was appended to the input stringstream,
+     *         0 if it isn't all here yet (or the peer closed its end), and
+     *         negative on error.
+     */
+    int ReadFrame(void);
+
+    /**
+     * \brief Send payload as one frame.
+     *
+     * @return The payload length, or negative on error.
+     */
+    int WriteFrame(const std::string &payload);
+
+    /**
+     * \brief Number of bytes in the input stringstream not yet parsed.
+     */
+    std::size_t UnreadSize(void);
+
+    /**
+     * \brief Serve commands from the parent until told to exit.
+     *
+     * This is the body of the worker, forked or threaded.
+     *
+     * @return The exit value of the worker.
+     */
+    int ServeCommands(void);
+
+    /**
+     * \brief Start the worker as a thread of this process.
+     *
+     * @param toChild  socket pair the parent writes commands to.
+     * @param toParent socket pair the worker writes responses to.
+     *
+     * @return zero on success, negative on error.
+     */
+    int RunThread(const int toChild[2], const int toParent[2]);
+
+    /**
+     * \brief Body of a worker thread.
+     *
+     * @param inFd  An int specifying the input file descriptor for commands.
+     * @param outFd An int specifying the output file descriptor for responses.
+     */
+    void ServeThread(int inFd, int outFd);
+
     /**
      * \brief Move DistributedCudaContext rvalue into another.
      *
@@ -735,6 +829,10 @@ private:
     // Input stream, filled by Read*. Called from Run() in worker.
     std::stringstream m_input {};
 
+    // Frame being read. Moved to m_input once it is all here.
+    std::string m_frame {};
+    bool m_peerClosed { false }; //!< peer closed its end of the socket
+
     // Message and error streams, filled by subtests, above.
     std::stringstream m_message {}; //!< message to return
     std::stringstream m_error {};   //!< error to return
@@ -758,6 +856,10 @@ private:
     bool m_isInitialized { false }; //<! whether initialized
     bool m_failed { false };        //<! whether passed startup
 
+    // Worker side of a threaded worker: CUDA_VISIBLE_DEVICES was set by the
+    // parent thread, since setenv() isn't safe once other threads run.
+    bool m_inProcess { false };
+
     // These only make sense on the parent side, controlling the worker.
     int m_pid { 0 };            //<! worker process pid
     unsigned int m_tries { 0 }; //<! synchronous tries available
@@ -771,6 +873,11 @@ private:
     bool m_finished { false };  //<! worker is finished
     bool m_validated { true };  //<! last test passed
 
+    // Threaded worker, instead of m_pid.
+    std::unique_ptr<DistributedCudaContext> m_threadWorker; //<! worker side
+    std::thread m_workerThread;                             //<! worker thread
+    bool m_threadRunning { false };                         //<! worker thread was started
+
     /**@}*/
 
     /** @name PerTestParameters
@@ -53,6 +53,7 @@
 #include <system_error>
 #include <unistd.h>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace DcgmNs::ProfTester
@@ -1272,6 +1273,15 @@ dcgmReturn_t PhysicalGpu::ProcessRunningResponse(std::shared_ptr<DistributedCuda
 
             dcgmReturn = m_tickHandler(workerIdx, true, workerValues, *worker);
 
+            if (m_parameters.m_benchmark && (dcgmReturn == DCGM_ST_PENDING))
+            {
+                /**
+                 * Benchmarks run at a fixed intensity and may not watch the
+                 * test's field at all, so there is nothing to retry for.
+                 */
+                dcgmReturn = DCGM_ST_OK;
+            }
+
             if (dcgmReturn == DCGM_ST_OK)
             {
                 /**
@@ -1470,11 +1480,16 @@ dcgmReturn_t PhysicalGpu::ProcessFinishedResponse(std::shared_ptr<DistributedCud
             std::size_t length;
             worker->Input() >> length;
             worker->Input().ignore(MaxStreamLength, '\n');
-            length -= (worker->Input().tellp() - worker->Input().tellg());
 
             if (length > 0)
             {
-                worker->Read(length); // read
+                // The body normally came in the same frame as its length.
+                std::size_t buffered = worker->Input().tellp() - worker->Input().tellg();
+
+                if (length > buffered)
+                {
+                    worker->Read(length - buffered); // read
+                }
 
                 /**
                  * Yes, this is a bit inefficient, but we expect no more than 8
@@ -1570,6 +1585,20 @@ bool PhysicalGpu::UseCublas(void) const
     return (m_parameters.m_cublas);
 }
 
+bool PhysicalGpu::UseWorkerThreads(void) const
+{
+    /**
+     * MIG slices need a process each, and CUDA can't be used in them if this
+     * process initialized it before forking, so it's all or nothing.
+     */
+    return m_parameters.m_threaded && !m_tester->HasMigGpus();
+}
+
+bool PhysicalGpu::UsePersistentKernels(void) const
+{
+    return (m_parameters.m_persistentKernels);
+}
+
 unsigned int PhysicalGpu::GetGpuId(void) const
 {
     return m_gpuId;
@@ -1801,6 +1830,22 @@ dcgmReturn_t PhysicalGpu::AppendSubtestRecord(double generatedValue, double dcgm
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void PhysicalGpu::AppendBenchmarkSample(unsigned int activity, double achieved)
+{
+    /* The first tick comes before a full duty cycle ran, so it doesn't count */
+    if (m_parameters.m_benchmark && (activity > 0))
+    {
+        m_benchmarkSamples.push_back(achieved);
+    }
+}
+
+/*****************************************************************************/
+std::vector<double> PhysicalGpu::TakeBenchmarkSamples(void)
+{
+    return std::exchange(m_benchmarkSamples, {});
+}
+
 struct cbData
 {
     unsigned int m_gpuId;
@@ -2392,6 +2437,8 @@ dcgmReturn_t PhysicalGpu::RunSubtestPcieBandwidth(void)
             worker.Input() >> curPerSecond;
             worker.Input().ignore(MaxStreamLength, '\n');
 
+            AppendBenchmarkSample(activity, curPerSecond);
+
             /*
              * We need to compare across the whole GPU, so we update whole-GPU
              * activity, subtracting the previous activity, and adding the
@@ -2772,6 +2819,8 @@ dcgmReturn_t PhysicalGpu::RunSubtestNvLinkBandwidth(void)
         worker.Input() >> curPerSecond;
         worker.Input().ignore(MaxStreamLength, '\n');
 
+        AppendBenchmarkSample(activity, curPerSecond);
+
         if (valid)
         {
             if (m_parameters.m_report)
@@ -2912,6 +2961,8 @@ dcgmReturn_t PhysicalGpu::RunSubtestDramUtil(void)
         worker.Input() >> eccAffectsBandwidth;
         worker.Input().ignore(MaxStreamLength, '\n');
 
+        AppendBenchmarkSample(activity, curDramAct * maxCiBandwidth / 1000000000.0);
+
         double bandwidthDivisor = 1.0;
 
         if (eccAffectsBandwidth != 0)
@@ -3240,6 +3291,8 @@ dcgmReturn_t PhysicalGpu::RunSubtestGemmUtil(void)
             worker.Input() >> gflops2;
             worker.Input().ignore(MaxStreamLength, '\n');
 
+            AppendBenchmarkSample(activity, gflops);
+
             if (valid)
             {
                 if (m_parameters.m_report)
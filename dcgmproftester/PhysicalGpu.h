@@ -129,6 +129,8 @@ public:
 
     bool IsMIG(void) const;                     // Are we MIG mode (call Init first)
     bool UseCublas(void) const;                 // Use Cublas for FP tests?
+    bool UseWorkerThreads(void) const;          // Run CUDA workers as threads?
+    bool UsePersistentKernels(void) const;      // Keep sleep kernels resident?
     unsigned int GetGpuId(void) const;          // Return GPU Id.
     std::string GetGpuBusId(void) const;        // Get the BUS ID of our GPU
     dcgmHandle_t GetHandle(void) const;         // return DCGM handle
@@ -157,6 +159,13 @@ public:
 
     bool IsValidated(void) const; // Did all workers pass validation?
 
+    /*************************************************************************/
+    /*
+     * Return and clear the throughput workers reported in benchmark mode, in
+     * the unit of the test (GFLOPS, GB/s or MiB/s), one sample per tick.
+     */
+    std::vector<double> TakeBenchmarkSamples(void);
+
     // Get all visible non-MIG GPUs for this entity
     dcgmReturn_t HelperGetCudaVisibleGPUs(std::string &cudaVisibleGPUs, dcgmGroupEntityPair_t &entity);
 
@@ -184,6 +193,9 @@ private:
     dcgmReturn_t EndSubtest(void);
     dcgmReturn_t AppendSubtestRecord(double generatedValue, double dcgmValue);
 
+    /* Record a worker's achieved throughput in benchmark mode */
+    void AppendBenchmarkSample(unsigned int activity, double achieved);
+
     /*************************************************************************/
     /**
      *
@@ -359,6 +371,8 @@ private:
     std::vector<double> m_subtestDcgmValues; /* subtest DCGM values */
     std::vector<double> m_subtestGenValues;  /* subtest generated values */
 
+    std::vector<double> m_benchmarkSamples; /* Throughput reported by workers in benchmark mode */
+
     /* Worker tracking */
 
     dcgmReturn_t (PhysicalGpu::*m_responseFn)(std::shared_ptr<DistributedCudaContext>);
@@ -20,6 +20,8 @@
 #include <DcgmBuildInfo.hpp>
 #include <DcgmLogging.h>
 #include <DcgmStringHelpers.h>
+#include <DcgmThreadPlacement.h>
+#include <dcgm_fields.h>
 #include <dcgm_structs_internal.h>
 
 #include <tclap/ArgException.h>
@@ -31,6 +33,7 @@
 #include <iostream>
 #include <set>
 #include <stdexcept>
+#include <vector>
 
 struct HostEngineCommandLine::Impl
 {
@@ -42,15 +45,26 @@ struct HostEngineCommandLine::Impl
                                                   instance from running */
     std::string m_serviceAccount;            /*!< Service account that will be used for unprivileged processes */
     std::string m_homeDir;                   /*!< Home directory for the DCGM diagnostic. */
+    std::string m_threadCpus;                /*!< CPUs of each thread class. "" = not pinned */
+    std::string m_threadNumaNodes;           /*!< Preferred NUMA node of each thread class. "" = none */
+    std::string m_shmLatestValuesName;       /*!< Name of the shared memory segment of latest values */
+
+    std::vector<unsigned short> m_shmLatestValueFieldIds; /*!< Fields to share in memory. Empty = disabled */
 
     std::set<dcgmModuleId_t> m_denylistModules; /*!< Modules to add to the denylist */
 
     std::uint16_t m_hostEnginePort; /*!< Host engine port number */
+    std::uint16_t m_metricsPort;    /*!< OpenMetrics port number. 0 = disabled */
+
+    std::uint32_t m_cacheMemoryBudgetMb; /*!< Budget in MB of the samples cached by the host engine. 0 = unlimited */
+    std::uint32_t m_shmLatestValuesIntervalMs; /*!< How often the shared fields are updated */
 
     bool m_isHostEngineConnTCP; /*!< Flag to indicate that connection is TCP */
     bool m_isTermHostEngine;    /*!< Terminate Daemon */
     bool m_shouldDaemonize;     /*!< Has the user requested that we do not daemonize? 1=yes. 0=no */
     bool m_isLogRotate;         /*!< Rotate log file */
+    bool m_useCacheHugePages;   /*!< Back the cache's large allocations with huge pages */
+    bool m_useCacheNumaLocal;   /*!< Keep the cache's large allocations on the NUMA node of their thread */
 };
 
 void HostEngineCommandLine::ImplDeleter::operator()(HostEngineCommandLine::Impl *ptr) const
@@ -88,6 +102,51 @@ std::string const &HostEngineCommandLine::GetBindInterface() const
     return m_pimpl->m_hostEngineBindInterfaceIp;
 }
 
+std::uint16_t HostEngineCommandLine::GetMetricsPort() const
+{
+    return m_pimpl->m_metricsPort;
+}
+
+std::uint32_t HostEngineCommandLine::GetCacheMemoryBudgetMb() const
+{
+    return m_pimpl->m_cacheMemoryBudgetMb;
+}
+
+bool HostEngineCommandLine::UseCacheHugePages() const
+{
+    return m_pimpl->m_useCacheHugePages;
+}
+
+bool HostEngineCommandLine::UseCacheNumaLocal() const
+{
+    return m_pimpl->m_useCacheNumaLocal;
+}
+
+std::string const &HostEngineCommandLine::GetThreadCpus() const
+{
+    return m_pimpl->m_threadCpus;
+}
+
+std::string const &HostEngineCommandLine::GetThreadNumaNodes() const
+{
+    return m_pimpl->m_threadNumaNodes;
+}
+
+std::vector<unsigned short> const &HostEngineCommandLine::GetShmLatestValueFieldIds() const
+{
+    return m_pimpl->m_shmLatestValueFieldIds;
+}
+
+std::string const &HostEngineCommandLine::GetShmLatestValuesName() const
+{
+    return m_pimpl->m_shmLatestValuesName;
+}
+
+std::uint32_t HostEngineCommandLine::GetShmLatestValuesIntervalMs() const
+{
+    return m_pimpl->m_shmLatestValuesIntervalMs;
+}
+
 std::string const &HostEngineCommandLine::GetPidFilePath() const
 {
     return m_pimpl->m_pidFilePath;
@@ -140,6 +199,18 @@ std::set<dcgmModuleId_t> ParseDenylist(std::string const &value)
     return result;
 }
 
+std::vector<unsigned short> ParseFieldIds(std::string const &value)
+{
+    std::vector<unsigned short> result;
+    auto tokens = dcgmTokenizeString(value, ",");
+
+    for (auto const &token : tokens)
+    {
+        result.push_back(static_cast<unsigned short>(std::stoi(token)));
+    }
+    return result;
+}
+
 std::string ParseBindIp(std::string const &value)
 {
     if (value == "all"s || value == "ALL"s)
@@ -183,6 +254,83 @@ public:
     }
 };
 
+class FieldIdsConstraint : public TCLAP::Constraint<std::string>
+{
+public:
+    std::string description() const override
+    {
+        return "Validate that --shm-latest-values has proper format and values"s;
+    }
+
+    std::string shortID() const override
+    {
+        return "FIELDID[,FIELDID...]"s;
+    }
+
+    bool check(std::string const &value) const override
+    {
+        auto tokens = dcgmTokenizeString(value, ",");
+        if (tokens.empty() || tokens.size() > DCGM_MAX_FIELD_IDS_PER_FIELD_GROUP)
+        {
+            return false;
+        }
+
+        for (auto const &token : tokens)
+        {
+            if (token.empty() || token.find_first_not_of("0123456789") != std::string::npos)
+            {
+                return false;
+            }
+
+            auto fieldId = std::stoi(token);
+            if (fieldId <= 0 || fieldId >= DCGM_FI_MAX_FIELDS)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+class ThreadCpusConstraint : public TCLAP::Constraint<std::string>
+{
+public:
+    std::string description() const override
+    {
+        return "Validate that --thread-cpus has proper format and values"s;
+    }
+
+    std::string shortID() const override
+    {
+        return "CLASS=CPULIST[;CLASS=CPULIST...]"s;
+    }
+
+    bool check(std::string const &value) const override
+    {
+        return DcgmNs::ThreadPlacement::IsValidCpusSpec(value);
+    }
+};
+
+class ThreadNumaNodesConstraint : public TCLAP::Constraint<std::string>
+{
+public:
+    std::string description() const override
+    {
+        return "Validate that --thread-numa-nodes has proper format and values"s;
+    }
+
+    std::string shortID() const override
+    {
+        return "CLASS=NODE[;CLASS=NODE...]"s;
+    }
+
+    bool check(std::string const &value) const override
+    {
+        return DcgmNs::ThreadPlacement::IsValidNumaNodesSpec(value);
+    }
+};
+
 
 } // namespace
 
@@ -388,6 +536,78 @@ HostEngineCommandLine ParseCommandLine(int argc, char *argv[])
                                                /*typedesc*/ "IP_ADDRESS",
                                                cmdLine);
 
+        auto metricsPortArg = ValueArg<std::uint16_t>("",
+                                                      "metrics-port",
+                                                      "Serve the latest values of watched fields as OpenMetrics text"
+                                                      " at http://<bind-interface>:PORT/metrics."
+                                                      "\nDefault: 0 = disabled.",
+                                                      /*req*/ false,
+                                                      /*default*/ 0,
+                                                      /*typedesc*/ "PORT",
+                                                      cmdLine);
+
+        auto shmLatestValuesConstraint = FieldIdsConstraint {};
+
+        auto shmLatestValuesArg
+            = ValueArg<std::string>("",
+                                    "shm-latest-values",
+                                    "Watch these numeric fields on all GPUs and publish their latest values in a"
+                                    " shared memory segment that local processes can read without connecting"
+                                    " (dcgmSharedLatestValuesOpen). Pass a comma-separated list of field IDs like"
+                                    " 150,155.",
+                                    /*req*/ false,
+                                    /*default*/ "",
+                                    &shmLatestValuesConstraint,
+                                    cmdLine);
+
+        auto shmLatestValuesNameArg = ValueArg<std::string>("",
+                                                            "shm-latest-values-name",
+                                                            "Name of the shared memory segment of --shm-latest-values."
+                                                            "\nDefault: " DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME,
+                                                            /*req*/ false,
+                                                            /*default*/ DCGM_SHARED_LATEST_VALUES_DEFAULT_NAME,
+                                                            /*typedesc*/ "NAME",
+                                                            cmdLine);
+
+        auto shmLatestValuesIntervalArg
+            = ValueArg<std::uint32_t>("",
+                                      "shm-latest-values-interval",
+                                      "How often to update the fields of --shm-latest-values in milliseconds."
+                                      "\nDefault: 1000.",
+                                      /*req*/ false,
+                                      /*default*/ 1000,
+                                      /*typedesc*/ "MS",
+                                      cmdLine);
+
+        auto cacheMemoryBudgetArg
+            = ValueArg<std::uint32_t>("",
+                                      "cache-memory-budget",
+                                      "Limit the memory that samples cached for all watches can take up to MB."
+                                      " Once it is exceeded, the samples of the watches that were read least"
+                                      " recently are evicted first, keeping the latest sample of each. Watches of"
+                                      " internal modules are evicted last."
+                                      "\nDefault: 0 = unlimited.",
+                                      /*req*/ false,
+                                      /*default*/ 0,
+                                      /*typedesc*/ "MB",
+                                      cmdLine);
+
+        auto cacheHugePagesArg = SwitchArg("",
+                                           "cache-huge-pages",
+                                           "Back the largest allocations of the cache, such as the blocks of cached"
+                                           " samples, with 2 MB huge pages. Pages reserved in"
+                                           " /proc/sys/vm/nr_hugepages are used first, then transparent huge pages.",
+                                           cmdLine,
+                                           /*default*/ false);
+
+        auto cacheNumaLocalArg = SwitchArg("",
+                                           "cache-numa-local",
+                                           "Keep the largest allocations of the cache on the NUMA node of the thread"
+                                           " that allocates and updates them. Combine with --thread-cpus to choose"
+                                           " the node of the cache threads.",
+                                           cmdLine,
+                                           /*default*/ false);
+
         auto pidFileArg = ValueArg<std::string>("",
                                                 "pid",
                                                 "Specify the PID filename nv-hostengine should use"
@@ -460,6 +680,39 @@ HostEngineCommandLine ParseCommandLine(int argc, char *argv[])
                                              /*typedesc*/ "Diagnostic home",
                                              cmdLine);
 
+        auto threadCpusConstraint = ThreadCpusConstraint {};
+
+        auto threadCpusArg
+            = ValueArg<std::string>("",
+                                    "thread-cpus",
+                                    "Pin each class of host engine threads to a set of CPUs."
+                                    "
+Pass semicolon-separated CLASS=CPULIST pairs like 'cache=0-3;ipc=4,5'."
+                                    " CPULIST is either a list like 0-3,8 or 'auto' for the CPUs local to the GPUs."
+                                    "
+Classes: cache, ipc, modules, kmsg, metrics and default for the main thread"
+                                    " and any thread it starts that has no class of its own.",
+                                    /*req*/ false,
+                                    /*default*/ "",
+                                    &threadCpusConstraint,
+                                    cmdLine);
+
+        auto threadNumaNodesConstraint = ThreadNumaNodesConstraint {};
+
+        auto threadNumaNodesArg
+            = ValueArg<std::string>("",
+                                    "thread-numa-nodes",
+                                    "Prefer a NUMA node for the memory allocated by each class of host engine threads."
+                                    "
+Pass semicolon-separated CLASS=NODE pairs like 'cache=0;ipc=0'. NODE is either"
+                                    " a node number or 'auto' for the node of the GPUs."
+                                    "
+Classes are the same as for --thread-cpus.",
+                                    /*req*/ false,
+                                    /*default*/ "",
+                                    &threadNumaNodesConstraint,
+                                    cmdLine);
+
         cmdLine.parse(argc, argv);
 
         impl->m_hostEngineSockPath        = domainSockArg.getValue();
@@ -469,12 +722,21 @@ HostEngineCommandLine ParseCommandLine(int argc, char *argv[])
         impl->m_pidFilePath               = pidFileArg.getValue();
         impl->m_denylistModules           = ParseDenylist(denylistArg.getValue());
         impl->m_hostEnginePort            = portArg.getValue();
+        impl->m_metricsPort               = metricsPortArg.getValue();
+        impl->m_cacheMemoryBudgetMb       = cacheMemoryBudgetArg.getValue();
+        impl->m_shmLatestValueFieldIds    = ParseFieldIds(shmLatestValuesArg.getValue());
+        impl->m_shmLatestValuesName       = shmLatestValuesNameArg.getValue();
+        impl->m_shmLatestValuesIntervalMs = shmLatestValuesIntervalArg.getValue();
+        impl->m_useCacheHugePages         = cacheHugePagesArg.getValue();
+        impl->m_useCacheNumaLocal         = cacheNumaLocalArg.getValue();
         impl->m_isHostEngineConnTCP       = not domainSockArg.isSet();
         impl->m_isTermHostEngine          = termArg.getValue();
         impl->m_shouldDaemonize           = not daemonizeArg.getValue();
         impl->m_isLogRotate               = logRotateArg.getValue();
         impl->m_serviceAccount            = serviceAccount.getValue();
         impl->m_homeDir                   = homeDir.getValue();
+        impl->m_threadCpus                = threadCpusArg.getValue();
+        impl->m_threadNumaNodes           = threadNumaNodesArg.getValue();
     }
     catch (TCLAP::ArgException const &ex)
     {
@@ -22,6 +22,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <cstdint>
 #include <sys/un.h>
@@ -43,6 +44,15 @@ public:
     [[nodiscard]] std::uint16_t GetPort() const;                //!< Host Engine port number
     [[nodiscard]] bool ShouldDaemonize() const;                 //!< Flag to daemonize
     [[nodiscard]] std::string const &GetBindInterface() const;  //!< IP address to bind to. "" = all interfaces
+    [[nodiscard]] std::uint16_t GetMetricsPort() const;         //!< OpenMetrics port number. 0 = disabled
+    [[nodiscard]] std::uint32_t GetCacheMemoryBudgetMb() const; //!< Budget of the cached samples. 0 = unlimited
+    [[nodiscard]] bool UseCacheHugePages() const;               //!< Back the cache's large allocations with huge pages
+    [[nodiscard]] bool UseCacheNumaLocal() const;               //!< Keep the cache's large allocations NUMA-local
+
+    //! Fields to publish in shared memory. Empty = disabled
+    [[nodiscard]] std::vector<unsigned short> const &GetShmLatestValueFieldIds() const;
+    [[nodiscard]] std::string const &GetShmLatestValuesName() const;  //!< Name of the shared memory segment
+    [[nodiscard]] std::uint32_t GetShmLatestValuesIntervalMs() const; //!< Update interval of the shared fields
 
     //! PID filename to use to prevent more than one Host Engine instance from running
     [[nodiscard]] std::string const &GetPidFilePath() const;
@@ -57,6 +67,9 @@ public:
 
     [[nodiscard]] std::string const &GetHomeDir() const; //!< Home directory for the host engine
 
+    [[nodiscard]] std::string const &GetThreadCpus() const;      //!< CPUs of each thread class. "" = not pinned
+    [[nodiscard]] std::string const &GetThreadNumaNodes() const; //!< Preferred NUMA node of each thread class
+
 private:
     struct Impl;
     struct ImplDeleter
@@ -15,7 +15,9 @@
  */
 #include "DcgmLogging.h"
 #include "DcgmSettings.h"
+#include "DcgmThreadPlacement.h"
 #include "HostEngineCommandLine.h"
+#include "cachealloc.h"
 
 #define DCGM_INIT_UUID
 #include "dcgm_agent.h"
@@ -33,6 +35,7 @@
 
 #include <DcgmBuildInfo.hpp>
 #include <fcntl.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -421,6 +424,40 @@ static void TryCreateDcgmHomeDir()
     }
 }
 
+/*****************************************************************************
+ * Returns the listening socket passed by systemd socket activation, or -1 if
+ * nv-hostengine wasn't socket activated
+ *****************************************************************************/
+static int TakeSystemdListenFd()
+{
+    char const *listenPid = getenv("LISTEN_PID");
+    char const *listenFds = getenv("LISTEN_FDS");
+    if (listenPid == nullptr || listenFds == nullptr || strtol(listenPid, nullptr, 10) != (long)getpid())
+    {
+        return -1;
+    }
+
+    long const numFds = strtol(listenFds, nullptr, 10);
+
+    /* They are meant for this process only, not for the ones it starts */
+    unsetenv("LISTEN_PID");
+    unsetenv("LISTEN_FDS");
+    unsetenv("LISTEN_FDNAMES");
+
+    if (numFds < 1)
+    {
+        return -1;
+    }
+    if (numFds > 1)
+    {
+        syslog(LOG_NOTICE, "nv-hostengine was passed %ld sockets. Only the first one is listened on.", numFds);
+    }
+
+    int const listenFd = 3; /* SD_LISTEN_FDS_START */
+    (void)fcntl(listenFd, F_SETFD, FD_CLOEXEC);
+    return listenFd;
+}
+
 int main(int argc, char **argv)
 {
     dcgmReturn_t ret;
@@ -453,6 +490,9 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    /* Daemonizing closes every file descriptor. Socket activated services run in the foreground */
+    int const systemdListenFd = cmdLine.ShouldDaemonize() ? -1 : TakeSystemdListenFd();
+
     // Should we daemonize?
     if (cmdLine.ShouldDaemonize())
     {
@@ -507,8 +547,41 @@ int main(int argc, char **argv)
         setenv(DCGM_HOME_DIR_VAR_NAME, diagHomeDir.c_str(), 1);
     }
 
+    if (cmdLine.GetCacheMemoryBudgetMb() != 0)
+    {
+        /* Read by the cache manager when the embedded engine starts */
+        setenv(DCGM_ENV_CACHE_MEMORY_BUDGET_MB, std::to_string(cmdLine.GetCacheMemoryBudgetMb()).c_str(), 1);
+    }
+
+    /* Read by the first cache allocation, which happens once the embedded engine starts */
+    if (cmdLine.UseCacheHugePages())
+    {
+        setenv(CACHEALLOC_ENV_HUGE_PAGES, "1", 1);
+    }
+    if (cmdLine.UseCacheNumaLocal())
+    {
+        setenv(CACHEALLOC_ENV_NUMA_LOCAL, "1", 1);
+    }
+
+    /* Read by every thread as it starts. The main thread is placed first so that the threads it starts without a
+       class of their own inherit the default placement */
+    if (!cmdLine.GetThreadCpus().empty())
+    {
+        setenv(DCGM_ENV_THREAD_CPUS, cmdLine.GetThreadCpus().c_str(), 1);
+    }
+    if (!cmdLine.GetThreadNumaNodes().empty())
+    {
+        setenv(DCGM_ENV_THREAD_NUMA_NODES, cmdLine.GetThreadNumaNodes().c_str(), 1);
+    }
+    DcgmNs::ThreadPlacement::ApplyClass("default");
+
     TryCreateDcgmHomeDir();
+
+    /* Attach the GPUs in the background so that clients can connect as soon as the server below is started. Only
+       for this process: the processes it starts use the embedded engine synchronously */
+    setenv(DCGM_ENV_BACKGROUND_INIT, "1", 1);
     ret = dcgmStartEmbedded_v2((dcgmStartEmbeddedV2Params_v1 *)&params);
+    unsetenv(DCGM_ENV_BACKGROUND_INIT);
 
     dcgmHandle = params.dcgmHandle;
     if (DCGM_ST_OK != ret)
@@ -518,13 +591,23 @@ int main(int argc, char **argv)
         return cleanup(dcgmHandle, -1, parentPid);
     }
 
-
-    syslog(LOG_NOTICE, "DCGM initialized");
-
     InstallCtrlHandler();
 
+    /* Should we start on a socket passed by systemd? */
+    if (systemdListenFd >= 0)
+    {
+        sockaddr_storage listenAddr {};
+        socklen_t listenAddrLen = sizeof(listenAddr);
+        if (getsockname(systemdListenFd, (sockaddr *)&listenAddr, &listenAddrLen) != 0)
+        {
+            printf("Err: Unable to get the address of the socket passed by systemd: %d\n", errno);
+            syslog(LOG_NOTICE, "Err: Unable to get the address of the socket passed by systemd");
+            return cleanup(dcgmHandle, -1, parentPid);
+        }
+        ret = dcgmEngineRunOnSocket(systemdListenFd, listenAddr.ss_family == AF_UNIX ? 0 : 1);
+    }
     /* Should we start in TCP mode? */
-    if (cmdLine.IsConnectionTcp())
+    else if (cmdLine.IsConnectionTcp())
     {
         ret = dcgmEngineRun(cmdLine.GetPort(), cmdLine.GetBindInterface().c_str(), cmdLine.IsConnectionTcp() ? 1 : 0);
     }
@@ -543,7 +626,13 @@ int main(int argc, char **argv)
 
     {
         auto version = DcgmNs::DcgmBuildInfo().GetVersion();
-        if (cmdLine.IsConnectionTcp())
+        if (systemdListenFd >= 0)
+        {
+            printf("Started host engine version %.*s using the socket passed by systemd \n",
+                   (int)version.size(),
+                   version.data());
+        }
+        else if (cmdLine.IsConnectionTcp())
         {
             printf("Started host engine version %.*s using port number: %u \n",
                    (int)version.size(),
@@ -561,15 +650,64 @@ int main(int argc, char **argv)
         }
     }
 
-    if (cmdLine.ShouldDaemonize())
-    {
-        create_daemon_pid_file(cmdLine.GetPidFilePath().c_str(), parentPid);
-        daemonCloseConsoleOutput(parentPid);
-    }
-
+    /* Requests that need the GPUs are queued by the server until they are attached */
+    bool initialized = false;
     while (g_stopLoop == 0)
     {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (initialized)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        ret = dcgmEngineWaitForInit(100);
+        if (DCGM_ST_TIMEOUT == ret)
+        {
+            continue;
+        }
+        if (DCGM_ST_OK != ret)
+        {
+            // assume that error message has already been printed
+            syslog(LOG_NOTICE, "Error: DCGM failed to attach the GPUs");
+            return cleanup(dcgmHandle, -1, parentPid);
+        }
+
+        initialized = true;
+        syslog(LOG_NOTICE, "DCGM initialized");
+
+        if (cmdLine.GetMetricsPort() != 0)
+        {
+            ret = dcgmEngineRunMetricsServer(cmdLine.GetMetricsPort(), cmdLine.GetBindInterface().c_str());
+            if (DCGM_ST_OK != ret)
+            {
+                printf("Err: Failed to start the metrics server on port %u: %d\n", cmdLine.GetMetricsPort(), ret);
+                syslog(LOG_NOTICE, "Err: Failed to start the metrics server");
+                return cleanup(dcgmHandle, -1, parentPid);
+            }
+        }
+
+        if (auto const &fieldIds = cmdLine.GetShmLatestValueFieldIds(); !fieldIds.empty())
+        {
+            ret = dcgmEngineRunSharedLatestValues(cmdLine.GetShmLatestValuesName().c_str(),
+                                                  fieldIds.data(),
+                                                  fieldIds.size(),
+                                                  cmdLine.GetShmLatestValuesIntervalMs() * 1000LL);
+            if (DCGM_ST_OK != ret)
+            {
+                printf("Err: Failed to publish latest values in shared memory %s: %d\n",
+                       cmdLine.GetShmLatestValuesName().c_str(),
+                       ret);
+                syslog(LOG_NOTICE, "Err: Failed to publish latest values in shared memory");
+                return cleanup(dcgmHandle, -1, parentPid);
+            }
+        }
+
+        /* The parent of the daemon reports errors to the terminal until the GPUs are attached */
+        if (cmdLine.ShouldDaemonize())
+        {
+            create_daemon_pid_file(cmdLine.GetPidFilePath().c_str(), parentPid);
+            daemonCloseConsoleOutput(parentPid);
+        }
     }
 
     return cleanup(dcgmHandle, 0, parentPid);
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "dcgm_module_structs.h"
+#include "dcgm_structs.h"
+#include <DcgmLogging.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace DcgmNs
+{
+namespace details
+{
+    /**
+     * @brief Deduces the module and message types of a module command handler.
+     * @note Handlers take the message either by reference or by pointer:
+     *       <b><tt>dcgmReturn_t TModule::Process(TMessage &)</tt></b> or
+     *       <b><tt>dcgmReturn_t TModule::Process(TMessage *)</tt></b>
+     */
+    template <typename TMethod>
+    struct CommandMethod;
+
+    template <typename TModule, typename TMessage>
+    struct CommandMethod<dcgmReturn_t (TModule::*)(TMessage &)>
+    {
+        using Module  = TModule;
+        using Message = TMessage;
+
+        template <auto Method>
+        static dcgmReturn_t Invoke(TModule &module, dcgm_module_command_header_t *header)
+        {
+            return (module.*Method)(*reinterpret_cast<TMessage *>(header));
+        }
+    };
+
+    template <typename TModule, typename TMessage>
+    struct CommandMethod<dcgmReturn_t (TModule::*)(TMessage *)>
+    {
+        using Module  = TModule;
+        using Message = TMessage;
+
+        template <auto Method>
+        static dcgmReturn_t Invoke(TModule &module, dcgm_module_command_header_t *header)
+        {
+            return (module.*Method)(reinterpret_cast<TMessage *>(header));
+        }
+    };
+} // namespace details
+
+/**
+ * @brief One entry of a CommandTable: the handler of a subcommand at one message version.
+ * @tparam TModule The module that handles the command.
+ */
+template <typename TModule>
+struct CommandHandler
+{
+    unsigned int subCommand; //!< Subcommand of dcgm_module_command_header_t
+    unsigned int version;    //!< The only header version the handler is called with
+    std::size_t minLength;   //!< The shortest header length the handler is called with
+    dcgmReturn_t (*invoke)(TModule &, dcgm_module_command_header_t *); //!< Calls the handler with the typed message
+};
+
+/**
+ * @brief Creates the CommandHandler of a handler method.
+ * @tparam Method Pointer to the handler method. The message type is deduced from its parameter.
+ * @param[in] subCommand    Subcommand the handler serves.
+ * @param[in] version       Version of the message the handler expects.
+ * @param[in] minLength     Shortest header length the handler accepts. Defaults to the size of the message. Messages
+ *                          with a trailing buffer that is truncated in requests pass the size without that buffer.
+ */
+template <auto Method, typename TTraits = details::CommandMethod<decltype(Method)>>
+consteval CommandHandler<typename TTraits::Module> Handle(unsigned int subCommand,
+                                                          unsigned int version,
+                                                          std::size_t minLength = sizeof(typename TTraits::Message))
+{
+    return { subCommand, version, minLength, &TTraits::template Invoke<Method> };
+}
+
+/**
+ * @brief Dispatches module commands to their handlers by subcommand and version.
+ *
+ * The table is built at compile time. Dispatch is an index lookup by subcommand followed by a match of the version
+ * among the handlers of that subcommand, which is usually one. The header of the message is validated in place
+ * before the handler is called, so handlers receive a message of the version and at least the length they expect
+ * and don't need to check them again.
+ *
+ * @tparam TModule          The module that handles the commands.
+ * @tparam NumHandlers      Number of handlers in the table.
+ */
+template <typename TModule, std::size_t NumHandlers>
+class CommandTable
+{
+public:
+    /* Subcommands of a table must be smaller than this */
+    static constexpr unsigned int c_maxSubCommands = 128;
+
+    /**
+     * @brief Builds the table. Fails to compile if a subcommand is out of range or registered twice for a version.
+     */
+    consteval explicit CommandTable(std::array<CommandHandler<TModule>, NumHandlers> const &handlers)
+        : m_handlers(handlers)
+    {
+        static_assert(NumHandlers < c_none, "Too many handlers for the index type");
+
+        m_first.fill(c_none);
+        m_next.fill(c_none);
+
+        /* Link backwards so that the handlers of a subcommand are tried in the order they were given */
+        for (std::size_t i = NumHandlers; i-- > 0;)
+        {
+            unsigned int const subCommand = handlers[i].subCommand;
+            if (subCommand >= c_maxSubCommands)
+            {
+                throw std::out_of_range("Subcommand is out of the range of the command table");
+            }
+
+            for (std::uint16_t j = m_first[subCommand]; j != c_none; j = m_next[j])
+            {
+                if (handlers[j].version == handlers[i].version)
+                {
+                    throw std::logic_error("Subcommand is registered twice for the same version");
+                }
+            }
+
+            m_next[i]           = m_first[subCommand];
+            m_first[subCommand] = static_cast<std::uint16_t>(i);
+        }
+    }
+
+    /**
+     * @brief Validates the header of moduleCommand and passes it to the handler of its subcommand and version.
+     *
+     * @return DCGM_ST_FUNCTION_NOT_FOUND if no handler serves the subcommand
+     *         DCGM_ST_VER_MISMATCH if no handler serves the version of the message
+     *         DCGM_ST_BADPARAM if the message is shorter than the handler expects
+     *         The return of the handler otherwise
+     */
+    dcgmReturn_t Dispatch(TModule &module, dcgm_module_command_header_t *moduleCommand) const
+    {
+        unsigned int const subCommand = moduleCommand->subCommand;
+        if (subCommand >= c_maxSubCommands || m_first[subCommand] == c_none)
+        {
+            DCGM_LOG_DEBUG << "Unknown subcommand: " << subCommand;
+            return DCGM_ST_FUNCTION_NOT_FOUND;
+        }
+
+        for (std::uint16_t i = m_first[subCommand]; i != c_none; i = m_next[i])
+        {
+            CommandHandler<TModule> const &handler = m_handlers[i];
+            if (handler.version != moduleCommand->version)
+            {
+                continue;
+            }
+
+            if (moduleCommand->length < handler.minLength)
+            {
+                DCGM_LOG_ERROR << "Module command of " << moduleCommand->length << " bytes is shorter than "
+                               << handler.minLength << " for module " << moduleCommand->moduleId << " subCommand "
+                               << subCommand;
+                return DCGM_ST_BADPARAM;
+            }
+
+            return handler.invoke(module, moduleCommand);
+        }
+
+        DCGM_LOG_ERROR << "Version mismatch " << std::hex << moduleCommand->version << " for module " << std::dec
+                       << moduleCommand->moduleId << " subCommand " << subCommand;
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+private:
+    static constexpr std::uint16_t c_none = UINT16_MAX;
+
+    std::array<CommandHandler<TModule>, NumHandlers> m_handlers {};
+    std::array<std::uint16_t, c_maxSubCommands> m_first {}; //!< First handler of each subcommand. c_none if none
+    std::array<std::uint16_t, NumHandlers> m_next {};       //!< Next handler of the same subcommand. c_none if none
+};
+
+/**
+ * @brief Creates a CommandTable, deducing the module and the number of handlers.
+ * @code
+ *     static constexpr auto c_commands = DcgmNs::MakeCommandTable<DcgmModuleFoo>({
+ *         DcgmNs::Handle<&DcgmModuleFoo::ProcessBar>(DCGM_FOO_SR_BAR, dcgm_foo_msg_bar_version),
+ *     });
+ *     return c_commands.Dispatch(*this, moduleCommand);
+ * @endcode
+ */
+template <typename TModule, std::size_t NumHandlers>
+consteval CommandTable<TModule, NumHandlers> MakeCommandTable(CommandHandler<TModule> const (&handlers)[NumHandlers])
+{
+    std::array<CommandHandler<TModule>, NumHandlers> array {};
+    for (std::size_t i = 0; i < NumHandlers; i++)
+    {
+        array[i] = handlers[i];
+    }
+    return CommandTable<TModule, NumHandlers>(array);
+}
+} // namespace DcgmNs
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cstring>
 #include <fmt/format.h>
 
@@ -22,7 +23,14 @@
 
 DcgmCoreProxy::DcgmCoreProxy(const dcgmCoreCallbacks_t coreCallbacks)
     : m_coreCallbacks(coreCallbacks)
-{}
+{
+    /* Callbacks of older hostengines, and the ones tests build by hand, only have the message form */
+    if (m_coreCallbacks.version == dcgmCoreCallbacks_version2 && m_coreCallbacks.direct != nullptr
+        && m_coreCallbacks.direct->version == dcgmCoreDirectInterface_version)
+    {
+        m_direct = m_coreCallbacks.direct;
+    }
+}
 
 void initializeCoreHeader(dcgm_module_command_header_t &header,
                           dcgmCoreReqCmd_t cmd,
@@ -118,6 +126,17 @@ unsigned int DcgmCoreProxy::GetGpuCount(int activeOnly)
 
 dcgmReturn_t DcgmCoreProxy::GetAllGpuInfo(std::vector<dcgmcm_gpu_info_cached_t> &gpuInfo)
 {
+    if (m_direct != nullptr)
+    {
+        std::shared_ptr<DcgmGpuInventorySnapshot const> inventory;
+        dcgmReturn_t ret = m_direct->getGpuInventory(m_direct->context, inventory);
+        if (ret == DCGM_ST_OK)
+        {
+            gpuInfo.insert(gpuInfo.end(), inventory->gpus.begin(), inventory->gpus.end());
+        }
+        return ret;
+    }
+
     dcgmCoreQueryGpuInfo_t qgi = {};
     initializeCoreHeader(qgi.header, DcgmCoreReqIdCMGetAllGpuInfo, dcgmCoreQueryGpuInfo_version, sizeof(qgi));
 
@@ -141,6 +160,23 @@ dcgmReturn_t DcgmCoreProxy::GetAllGpuInfo(std::vector<dcgmcm_gpu_info_cached_t>
     return ret;
 }
 
+dcgmReturn_t DcgmCoreProxy::GetGpuInventory(std::shared_ptr<DcgmGpuInventorySnapshot const> &inventory)
+{
+    if (m_direct != nullptr)
+    {
+        return m_direct->getGpuInventory(m_direct->context, inventory);
+    }
+
+    auto snapshot    = std::make_shared<DcgmGpuInventorySnapshot>();
+    dcgmReturn_t ret = GetAllGpuInfo(snapshot->gpus);
+    if (ret == DCGM_ST_OK)
+    {
+        inventory = std::move(snapshot);
+    }
+
+    return ret;
+}
+
 unsigned int DcgmCoreProxy::NvmlIndexToGpuId(int nvmlIndex)
 {
     dcgmCoreBasicQuery_t bq = {};
@@ -280,6 +316,20 @@ dcgmReturn_t DcgmCoreProxy::GetInt64SummaryData(dcgm_field_entity_group_t entity
                                                 pfUseEntryForSummary pfUseEntryCB,
                                                 void *userData)
 {
+    if (m_direct != nullptr && numSummaryTypes >= 0)
+    {
+        return m_direct->getInt64SummaryData(m_direct->context,
+                                             entityGroupId,
+                                             entityId,
+                                             fieldId,
+                                             { summaryTypes, static_cast<size_t>(numSummaryTypes) },
+                                             { summaryValues, static_cast<size_t>(numSummaryTypes) },
+                                             startTime,
+                                             endTime,
+                                             pfUseEntryCB,
+                                             userData);
+    }
+
     dcgmCoreGetInt64SummaryData_t gisd = {};
     gisd.request.entityGroupId         = entityGroupId;
     gisd.request.entityId              = entityId;
@@ -322,6 +372,11 @@ dcgmReturn_t DcgmCoreProxy::GetLatestSample(dcgm_field_entity_group_t entityGrou
                                             dcgmcm_sample_p sample,
                                             DcgmFvBuffer *fvBuffer)
 {
+    if (m_direct != nullptr)
+    {
+        return m_direct->getLatestSample(m_direct->context, entityGroupId, entityId, fieldId, sample, fvBuffer);
+    }
+
     dcgmCoreGetLatestSample_t gls = {};
     gls.request.entityGroupId     = entityGroupId;
     gls.request.entityId          = entityId;
@@ -365,6 +420,19 @@ dcgmReturn_t DcgmCoreProxy::GetSamples(dcgm_field_entity_group_t entityGroupId,
                                        timelib64_t endTime,
                                        dcgmOrder_t order)
 {
+    if (m_direct != nullptr && *Msamples >= 0)
+    {
+        return m_direct->getSamples(m_direct->context,
+                                    entityGroupId,
+                                    entityId,
+                                    fieldId,
+                                    { samples, static_cast<size_t>(*Msamples) },
+                                    Msamples,
+                                    startTime,
+                                    endTime,
+                                    order);
+    }
+
     dcgmCoreGetSamples_t gs = {};
     initializeCoreHeader(gs.header, DcgmCoreReqIdCMGetSamples, dcgmCoreGetSamples_version, sizeof(gs));
     gs.request.entityGroupId = entityGroupId;
@@ -464,6 +532,17 @@ dcgmReturn_t DcgmCoreProxy::GetMultipleLatestLiveSamples(std::vector<dcgmGroupEn
         return DCGM_ST_MAX_LIMIT;
     }
 
+    if (m_direct != nullptr)
+    {
+        dcgmReturn_t ret = m_direct->getMultipleLatestLiveSamples(m_direct->context, entities, fieldIds, fvBuffer);
+        if (ret != DCGM_ST_OK)
+        {
+            DCGM_LOG_ERROR << "Error '" << errorString(ret) << "' while attempting to get latest samples for "
+                           << fieldIds.size() << " fields of " << entities.size() << " entities";
+        }
+        return ret;
+    }
+
     std::unique_ptr<dcgmCoreGetMultipleLatestLiveSamples_t> gml
         = std::make_unique<dcgmCoreGetMultipleLatestLiveSamples_t>();
     memset(gml.get(), 0, sizeof(*gml));
@@ -1085,3 +1164,128 @@ dcgmReturn_t DcgmCoreProxy::GetServiceAccount(std::string &serviceAccount) const
 
     return DCGM_ST_OK;
 }
+
+dcgmReturn_t DcgmCoreProxy::GetCompressedSampleBytes(long long &compressedSampleBytes) const
+{
+    dcgmCoreGetCompressedSampleBytes_t query {};
+    initializeCoreHeader(query.header,
+                         DcgmCoreReqIdCMGetCompressedSampleBytes,
+                         dcgmCoreGetCompressedSampleBytes_version1,
+                         sizeof(query));
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query.header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("[CoreProxy] Got error: {}, while getting the compressed sample bytes.", errorString(ret));
+        return ret;
+    }
+
+    compressedSampleBytes = query.response.compressedSampleBytes;
+    return query.response.ret;
+}
+
+dcgmReturn_t DcgmCoreProxy::GetFieldCosts(dcgmIntrospectFieldCosts_v1 &fieldCosts) const
+{
+    auto query = std::make_unique<dcgmCoreGetFieldCosts_t>();
+    initializeCoreHeader(query->header, DcgmCoreReqIdCMGetFieldCosts, dcgmCoreGetFieldCosts_version1, sizeof(*query));
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query->header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("[CoreProxy] Got error: {}, while getting the field costs.", errorString(ret));
+        return ret;
+    }
+
+    memcpy(&fieldCosts, &query->response.fieldCosts, sizeof(fieldCosts));
+    return query->response.ret;
+}
+
+dcgmReturn_t DcgmCoreProxy::GetLockProfile(dcgmIntrospectLockProfile_v1 &lockProfile) const
+{
+    auto query = std::make_unique<dcgmCoreGetLockProfile_t>();
+    initializeCoreHeader(query->header, DcgmCoreReqIdGetLockProfile, dcgmCoreGetLockProfile_version1, sizeof(*query));
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query->header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("[CoreProxy] Got error: {}, while getting the lock profile.", errorString(ret));
+        return ret;
+    }
+
+    memcpy(&lockProfile, &query->response.lockProfile, sizeof(lockProfile));
+    return query->response.ret;
+}
+
+dcgmReturn_t DcgmCoreProxy::GetRuntimeStats(dcgmIntrospectRuntimeStats_v1 &runtimeStats) const
+{
+    dcgmCoreGetRuntimeStats_t query {};
+    initializeCoreHeader(query.header, DcgmCoreReqIdCMGetRuntimeStats, dcgmCoreGetRuntimeStats_version1, sizeof(query));
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query.header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("[CoreProxy] Got error: {}, while getting the runtime stats.", errorString(ret));
+        return ret;
+    }
+
+    runtimeStats = query.response.runtimeStats;
+    return query.response.ret;
+}
+
+dcgmReturn_t DcgmCoreProxy::SetNvSwitchLinkStatus(unsigned int numNvSwitches,
+                                                  dcgmNvLinkNvSwitchLinkStatus_t const *nvSwitches)
+{
+    if (numNvSwitches > DCGM_MAX_NUM_SWITCHES || (numNvSwitches > 0 && nvSwitches == nullptr))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    auto query                    = std::make_unique<dcgmCoreSetNvSwitchLinkStatus_t>();
+    query->request.numNvSwitches = numNvSwitches;
+    if (numNvSwitches > 0)
+    {
+        memcpy(query->request.nvSwitches, nvSwitches, numNvSwitches * sizeof(nvSwitches[0]));
+    }
+    initializeCoreHeader(
+        query->header, DcgmCoreReqIdCMSetNvSwitchLinkStatus, dcgmCoreSetNvSwitchLinkStatus_version1, sizeof(*query));
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query->header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("[CoreProxy] Got error: {}, while setting the NvSwitch link states.", errorString(ret));
+        return ret;
+    }
+
+    return query->response.ret;
+}
+
+dcgmReturn_t DcgmCoreProxy::SetEntityStatuses(dcgm_field_entity_group_t entityGroupId,
+                                              std::vector<dcgmCoreEntityStatus_t> const &entities)
+{
+    auto query = std::make_unique<dcgmCoreSetEntityStatuses_t>();
+    if (entities.size() > std::size(query->request.entities))
+    {
+        return DCGM_ST_BADPARAM;
+    }
+
+    query->request.entityGroupId = entityGroupId;
+    query->request.numEntities   = entities.size();
+    std::ranges::copy(entities, query->request.entities);
+    initializeCoreHeader(
+        query->header, DcgmCoreReqIdCMSetEntityStatuses, dcgmCoreSetEntityStatuses_version1, sizeof(*query));
+
+    // coverity[overrun-buffer-val]
+    dcgmReturn_t ret = m_coreCallbacks.postfunc(&query->header, m_coreCallbacks.poster);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("[CoreProxy] Got error: {}, while setting the statuses of eg {}.", errorString(ret), entityGroupId);
+        return ret;
+    }
+
+    return query->response.ret;
+}
@@ -55,6 +55,14 @@ public:
      */
     dcgmReturn_t GetAllGpuInfo(std::vector<dcgmcm_gpu_info_cached_t> &gpuInfo);
 
+    /**
+     * Get the GPU inventory without copying it. In-process modules share the cache manager's snapshot. Otherwise
+     * it is built from the response of a request.
+     *
+     * @param[out] inventory - immutable list of all the GPU information. Never nullptr on success
+     */
+    dcgmReturn_t GetGpuInventory(std::shared_ptr<DcgmGpuInventorySnapshot const> &inventory);
+
     /**
      * @param[in] nvmlIndex - the NVML index to translate to a DCGM GPU id
      */
@@ -377,8 +385,68 @@ public:
 
     dcgmReturn_t GetServiceAccount(std::string &serviceAccount) const;
 
+    /**
+     * Returns the number of bytes of encoded samples held by the cache manager's compressed timeseries.
+     * @param compressedSampleBytes[out]    number of bytes. 0 if compressed timeseries are not enabled
+     * @return
+     *      \ref DCGM_ST_OK         Value was set successfully<br>
+     *      \ref DCGM_ST_*          Other generic errors<br>
+     */
+    dcgmReturn_t GetCompressedSampleBytes(long long &compressedSampleBytes) const;
+
+    /**
+     * Returns what each watch costs the cache manager, most expensive first.
+     * @param fieldCosts[out]    the costs. fieldCosts.version is set by this call
+     * @return
+     *      \ref DCGM_ST_OK         Value was set successfully<br>
+     *      \ref DCGM_ST_*          Other generic errors<br>
+     */
+    dcgmReturn_t GetFieldCosts(dcgmIntrospectFieldCosts_v1 &fieldCosts) const;
+
+    /**
+     * Returns the contention profile of the host engine's profiled mutexes, longest waits first.
+     * @param lockProfile[out]   the profile. lockProfile.version is set by this call
+     * @return
+     *      \ref DCGM_ST_OK         Value was set successfully<br>
+     *      \ref DCGM_ST_*          Other generic errors<br>
+     */
+    dcgmReturn_t GetLockProfile(dcgmIntrospectLockProfile_v1 &lockProfile) const;
+
+    /**
+     * Returns the counters of the cache manager since the host engine started.
+     * @param runtimeStats[out]   the counters. runtimeStats.version is set by this call
+     * @return
+     *      \ref DCGM_ST_OK         Value was set successfully<br>
+     *      \ref DCGM_ST_*          Other generic errors<br>
+     */
+    dcgmReturn_t GetRuntimeStats(dcgmIntrospectRuntimeStats_v1 &runtimeStats) const;
+
+    /**
+     * Hands the NvLink link states of every NvSwitch to the cache manager, which serves them to
+     * dcgmGetNvLinkLinkStatus() until the next call.
+     * @param numNvSwitches[in]  number of entries in nvSwitches
+     * @param nvSwitches[in]     link states of each NvSwitch
+     * @return
+     *      \ref DCGM_ST_OK         The link states were stored<br>
+     *      \ref DCGM_ST_*          Other generic errors<br>
+     */
+    dcgmReturn_t SetNvSwitchLinkStatus(unsigned int numNvSwitches, dcgmNvLinkNvSwitchLinkStatus_t const *nvSwitches);
+
+    /**
+     * Hands the statuses of every entity of a group the module owns to the cache manager, which serves
+     * them to status checks without asking the module again.
+     * @param entityGroupId[in]  DCGM_FE_SWITCH, DCGM_FE_CPU or DCGM_FE_CPU_CORE
+     * @param entities[in]       every entity of the group and its status
+     * @return
+     *      \ref DCGM_ST_OK         The statuses were stored<br>
+     *      \ref DCGM_ST_*          Other generic errors<br>
+     */
+    dcgmReturn_t SetEntityStatuses(dcgm_field_entity_group_t entityGroupId,
+                                   std::vector<dcgmCoreEntityStatus_t> const &entities);
+
 private:
     dcgmCoreCallbacks_t m_coreCallbacks;
+    dcgmCoreDirectInterface_t const *m_direct = nullptr; //!< Typed calls into libdcgm. nullptr when messages are used
 
     dcgmReturn_t GetMigInstanceEntityIdHelper(unsigned int gpuId,
                                               DcgmNs::Mig::Nvml::GpuInstanceId const &instanceId,
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch_all.hpp>
+
+#include <DcgmCommandTable.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <string>
+
+namespace
+{
+constexpr unsigned int c_srFoo = 1;
+constexpr unsigned int c_srBar = 2;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    int cmdRet;
+    char buffer[64];
+} fake_msg_v1;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    int cmdRet;
+    unsigned int value;
+} fake_msg_v2;
+
+constexpr unsigned int fake_msg_version1 = MAKE_DCGM_VERSION(fake_msg_v1, 1);
+constexpr unsigned int fake_msg_version2 = MAKE_DCGM_VERSION(fake_msg_v2, 2);
+
+class FakeModule
+{
+public:
+    dcgmReturn_t ProcessFooV1(fake_msg_v1 &msg)
+    {
+        m_lastCall = "FooV1";
+        msg.cmdRet = DCGM_ST_OK;
+        return DCGM_ST_OK;
+    }
+
+    dcgmReturn_t ProcessFooV2(fake_msg_v2 *msg)
+    {
+        m_lastCall = "FooV2";
+        msg->value = 42;
+        return DCGM_ST_OK;
+    }
+
+    dcgmReturn_t ProcessBar(fake_msg_v1 &)
+    {
+        m_lastCall = "Bar";
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    dcgmReturn_t Dispatch(dcgm_module_command_header_t *moduleCommand)
+    {
+        using DcgmNs::Handle;
+
+        static constexpr auto c_commands = DcgmNs::MakeCommandTable<FakeModule>({
+            Handle<&FakeModule::ProcessFooV1>(c_srFoo, fake_msg_version1),
+            Handle<&FakeModule::ProcessFooV2>(c_srFoo, fake_msg_version2),
+            Handle<&FakeModule::ProcessBar>(c_srBar, fake_msg_version1, offsetof(fake_msg_v1, buffer)),
+        });
+
+        m_lastCall.clear();
+        return c_commands.Dispatch(*this, moduleCommand);
+    }
+
+    std::string m_lastCall;
+};
+
+template <typename TMessage>
+TMessage MakeMessage(unsigned int subCommand, unsigned int version, std::size_t length = sizeof(TMessage))
+{
+    TMessage msg {};
+    msg.header.length     = length;
+    msg.header.subCommand = subCommand;
+    msg.header.version    = version;
+    return msg;
+}
+} // namespace
+
+TEST_CASE("CommandTable: dispatches by subcommand and version")
+{
+    FakeModule module;
+
+    auto v1   = MakeMessage<fake_msg_v1>(c_srFoo, fake_msg_version1);
+    v1.cmdRet = DCGM_ST_GENERIC_ERROR;
+    CHECK(module.Dispatch(&v1.header) == DCGM_ST_OK);
+    CHECK(module.m_lastCall == "FooV1");
+    CHECK(v1.cmdRet == DCGM_ST_OK);
+
+    auto v2 = MakeMessage<fake_msg_v2>(c_srFoo, fake_msg_version2);
+    CHECK(module.Dispatch(&v2.header) == DCGM_ST_OK);
+    CHECK(module.m_lastCall == "FooV2");
+    CHECK(v2.value == 42);
+
+    /* The handler's return is passed through */
+    auto bar = MakeMessage<fake_msg_v1>(c_srBar, fake_msg_version1);
+    CHECK(module.Dispatch(&bar.header) == DCGM_ST_NOT_SUPPORTED);
+    CHECK(module.m_lastCall == "Bar");
+}
+
+TEST_CASE("CommandTable: unknown subcommands are not found")
+{
+    FakeModule module;
+
+    auto msg = MakeMessage<fake_msg_v1>(0, fake_msg_version1);
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_FUNCTION_NOT_FOUND);
+
+    msg.header.subCommand = 3;
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_FUNCTION_NOT_FOUND);
+
+    /* Past the end of the table */
+    msg.header.subCommand = DcgmNs::CommandTable<FakeModule, 1>::c_maxSubCommands;
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_FUNCTION_NOT_FOUND);
+
+    msg.header.subCommand = UINT_MAX;
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_FUNCTION_NOT_FOUND);
+    CHECK(module.m_lastCall.empty());
+}
+
+TEST_CASE("CommandTable: versions without a handler are a mismatch")
+{
+    FakeModule module;
+
+    auto msg = MakeMessage<fake_msg_v1>(c_srFoo, MAKE_DCGM_VERSION(fake_msg_v1, 3));
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_VER_MISMATCH);
+
+    /* c_srBar only has a handler for version 1 */
+    auto bar = MakeMessage<fake_msg_v2>(c_srBar, fake_msg_version2);
+    CHECK(module.Dispatch(&bar.header) == DCGM_ST_VER_MISMATCH);
+    CHECK(module.m_lastCall.empty());
+}
+
+TEST_CASE("CommandTable: messages shorter than the handler expects are rejected")
+{
+    FakeModule module;
+
+    auto msg = MakeMessage<fake_msg_v1>(c_srFoo, fake_msg_version1, sizeof(fake_msg_v1) - 1);
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_BADPARAM);
+    CHECK(module.m_lastCall.empty());
+
+    msg.header.length = sizeof(dcgm_module_command_header_t);
+    CHECK(module.Dispatch(&msg.header) == DCGM_ST_BADPARAM);
+    CHECK(module.m_lastCall.empty());
+
+    /* c_srBar takes the message without its trailing buffer, but not any shorter */
+    auto bar = MakeMessage<fake_msg_v1>(c_srBar, fake_msg_version1, offsetof(fake_msg_v1, buffer));
+    CHECK(module.Dispatch(&bar.header) == DCGM_ST_NOT_SUPPORTED);
+    CHECK(module.m_lastCall == "Bar");
+
+    bar.header.length = offsetof(fake_msg_v1, buffer) - 1;
+    CHECK(module.Dispatch(&bar.header) == DCGM_ST_BADPARAM);
+}
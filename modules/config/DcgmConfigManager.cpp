@@ -23,8 +23,21 @@
 
 #include <dcgm_nvml.h>
 #include <nvcmvalue.h>
+#include <timelib.h>
 
+#include <future>
+#include <optional>
 #include <sstream>
+#include <utility>
+
+namespace
+{
+/* Fields that make up the current config of a GPU */
+constexpr unsigned short c_currentConfigFieldIds[] = {
+    DCGM_FI_DEV_ECC_CURRENT,      DCGM_FI_DEV_APP_MEM_CLOCK, DCGM_FI_DEV_APP_SM_CLOCK,
+    DCGM_FI_DEV_POWER_MGMT_LIMIT, DCGM_FI_DEV_COMPUTE_MODE,  DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK,
+};
+} // namespace
 
 DcgmConfigManager::DcgmConfigManager(dcgmCoreCallbacks_t &dcc)
     : mpCoreProxy(dcc)
@@ -34,6 +47,8 @@ DcgmConfigManager::DcgmConfigManager(dcgmCoreCallbacks_t &dcc)
     m_mutex = new DcgmMutex(0);
 
     memset(m_activeConfig, 0, sizeof(m_activeConfig));
+    memset(m_currentConfigWatched, 0, sizeof(m_currentConfigWatched));
+    memset(m_configChangedUsec, 0, sizeof(m_configChangedUsec));
 }
 
 /*****************************************************************************/
@@ -104,7 +119,9 @@ dcgmReturn_t DcgmConfigManager::HelperSetEccMode(unsigned int gpuId,
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmConfigManager::HelperSetPowerLimit(unsigned int gpuId, dcgmConfig_t *setConfig)
+dcgmReturn_t DcgmConfigManager::HelperSetPowerLimit(unsigned int gpuId,
+                                                    dcgmConfig_t *setConfig,
+                                                    dcgmConfig_t const *currentConfig)
 {
     dcgmReturn_t dcgmRet;
 
@@ -114,6 +131,12 @@ dcgmReturn_t DcgmConfigManager::HelperSetPowerLimit(unsigned int gpuId, dcgmConf
         return DCGM_ST_OK;
     }
 
+    if (currentConfig->powerLimit.val == setConfig->powerLimit.val)
+    {
+        log_debug("Power limit {} already matches for gpuId {}.", setConfig->powerLimit.val, gpuId);
+        return DCGM_ST_OK;
+    }
+
     dcgmcm_sample_t value;
     memset(&value, 0, sizeof(value));
     value.val.d = setConfig->powerLimit.val;
@@ -130,7 +153,9 @@ dcgmReturn_t DcgmConfigManager::HelperSetPowerLimit(unsigned int gpuId, dcgmConf
 
 
 /*****************************************************************************/
-dcgmReturn_t DcgmConfigManager::HelperSetPerfState(unsigned int gpuId, dcgmConfig_t *setConfig)
+dcgmReturn_t DcgmConfigManager::HelperSetPerfState(unsigned int gpuId,
+                                                   dcgmConfig_t *setConfig,
+                                                   dcgmConfig_t const *currentConfig)
 {
     dcgmReturn_t dcgmRet;
     unsigned int targetMemClock, targetSmClock;
@@ -149,6 +174,15 @@ dcgmReturn_t DcgmConfigManager::HelperSetPerfState(unsigned int gpuId, dcgmConfi
     /* Update the Clock Configured to 1 */
     mClocksConfigured = 1;
 
+    /* A reset (0, 0) is always done since the current clocks don't tell whether app clocks are in use */
+    if ((targetMemClock != 0 || targetSmClock != 0)
+        && targetMemClock == currentConfig->perfState.targetClocks.memClock
+        && targetSmClock == currentConfig->perfState.targetClocks.smClock)
+    {
+        log_debug("Clocks {}, {} already match for gpuId {}.", targetMemClock, targetSmClock, gpuId);
+        return DCGM_ST_OK;
+    }
+
     /* Are both 0s? That means reset target clocks */
     if (targetMemClock == 0 && targetSmClock == 0)
     {
@@ -219,7 +253,9 @@ dcgmReturn_t DcgmConfigManager::HelperSetPerfState(unsigned int gpuId, dcgmConfi
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmConfigManager::HelperSetComputeMode(unsigned int gpuId, dcgmConfig_t *config)
+dcgmReturn_t DcgmConfigManager::HelperSetComputeMode(unsigned int gpuId,
+                                                     dcgmConfig_t *config,
+                                                     dcgmConfig_t const *currentConfig)
 {
     dcgmReturn_t dcgmRet;
 
@@ -229,6 +265,12 @@ dcgmReturn_t DcgmConfigManager::HelperSetComputeMode(unsigned int gpuId, dcgmCon
         return DCGM_ST_OK;
     }
 
+    if (currentConfig->computeMode == config->computeMode)
+    {
+        log_debug("Compute mode {} already matches for gpuId {}.", config->computeMode, gpuId);
+        return DCGM_ST_OK;
+    }
+
     dcgmcm_sample_t value;
     memset(&value, 0, sizeof(value));
     value.val.i64 = config->computeMode;
@@ -324,11 +366,10 @@ dcgmConfig_t *DcgmConfigManager::HelperGetTargetConfig(unsigned int gpuId)
 }
 
 /*****************************************************************************/
-void DcgmConfigManager::HelperMergeTargetConfiguration(unsigned int gpuId,
+void DcgmConfigManager::HelperMergeTargetConfiguration(dcgmConfig_t *targetConfig,
                                                        unsigned int fieldId,
                                                        dcgmConfig_t *setConfig)
 {
-    dcgmConfig_t *targetConfig = HelperGetTargetConfig(gpuId);
     if (targetConfig == setConfig)
     {
         log_warning("Caller tried to set targetConfig to identical setConfig.");
@@ -432,6 +473,7 @@ void DcgmConfigManager::HelperMergeTargetConfiguration(unsigned int gpuId,
 /*****************************************************************************/
 dcgmReturn_t DcgmConfigManager::SetConfigGpu(unsigned int gpuId,
                                              dcgmConfig_t *setConfig,
+                                             dcgmConfig_t *targetConfig,
                                              DcgmConfigManagerStatusList *statusList)
 {
     unsigned int multiPropertyRetCode = 0;
@@ -474,11 +516,11 @@ dcgmReturn_t DcgmConfigManager::SetConfigGpu(unsigned int gpuId,
         statusList->AddStatus(gpuId, DCGM_FI_DEV_ECC_CURRENT, dcgmRet);
 
         if ((dcgmRet != DCGM_ST_BADPARAM) && (dcgmRet != DCGM_ST_NOT_SUPPORTED))
-            HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_ECC_CURRENT, setConfig);
+            HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_ECC_CURRENT, setConfig);
     }
     else
     {
-        HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_ECC_CURRENT, setConfig);
+        HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_ECC_CURRENT, setConfig);
     }
 
     /* Check if GPU reset is needed after GPU reset */
@@ -491,22 +533,22 @@ dcgmReturn_t DcgmConfigManager::SetConfigGpu(unsigned int gpuId,
     }
 
     /* Set Power Limit */
-    dcgmRet = HelperSetPowerLimit(gpuId, setConfig);
+    dcgmRet = HelperSetPowerLimit(gpuId, setConfig, &currentConfig);
     if (DCGM_ST_OK != dcgmRet)
     {
         multiPropertyRetCode++;
         statusList->AddStatus(gpuId, DCGM_FI_DEV_POWER_MGMT_LIMIT, dcgmRet);
 
         if ((dcgmRet != DCGM_ST_BADPARAM) && (dcgmRet != DCGM_ST_NOT_SUPPORTED))
-            HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_POWER_MGMT_LIMIT, setConfig);
+            HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_POWER_MGMT_LIMIT, setConfig);
     }
     else
     {
-        HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_POWER_MGMT_LIMIT, setConfig);
+        HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_POWER_MGMT_LIMIT, setConfig);
     }
 
     /* Set Perf States */
-    dcgmRet = HelperSetPerfState(gpuId, setConfig);
+    dcgmRet = HelperSetPerfState(gpuId, setConfig, &currentConfig);
     if (DCGM_ST_OK != dcgmRet)
     {
         multiPropertyRetCode++;
@@ -514,25 +556,25 @@ dcgmReturn_t DcgmConfigManager::SetConfigGpu(unsigned int gpuId,
         statusList->AddStatus(gpuId, DCGM_FI_DEV_APP_MEM_CLOCK, dcgmRet);
 
         if ((dcgmRet != DCGM_ST_BADPARAM) && (dcgmRet != DCGM_ST_NOT_SUPPORTED))
-            HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_APP_SM_CLOCK, setConfig);
+            HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_APP_SM_CLOCK, setConfig);
     }
     else
     {
-        HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_APP_SM_CLOCK, setConfig);
+        HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_APP_SM_CLOCK, setConfig);
     }
 
-    dcgmRet = HelperSetComputeMode(gpuId, setConfig);
+    dcgmRet = HelperSetComputeMode(gpuId, setConfig, &currentConfig);
     if (DCGM_ST_OK != dcgmRet)
     {
         multiPropertyRetCode++;
         statusList->AddStatus(gpuId, DCGM_FI_DEV_COMPUTE_MODE, dcgmRet);
 
         if ((dcgmRet != DCGM_ST_BADPARAM) && (dcgmRet != DCGM_ST_NOT_SUPPORTED))
-            HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_COMPUTE_MODE, setConfig);
+            HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_COMPUTE_MODE, setConfig);
     }
     else
     {
-        HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_COMPUTE_MODE, setConfig);
+        HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_COMPUTE_MODE, setConfig);
     }
 
     /* Set Workload Power Profiles */
@@ -543,11 +585,11 @@ dcgmReturn_t DcgmConfigManager::SetConfigGpu(unsigned int gpuId,
         statusList->AddStatus(gpuId, DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK, dcgmRet);
 
         if ((dcgmRet != DCGM_ST_BADPARAM) && (dcgmRet != DCGM_ST_NOT_SUPPORTED))
-            HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK, setConfig);
+            HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK, setConfig);
     }
     else
     {
-        HelperMergeTargetConfiguration(gpuId, DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK, setConfig);
+        HelperMergeTargetConfiguration(targetConfig, DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK, setConfig);
     }
 
     /* If any of the operation failed. Return it as an generic error */
@@ -573,12 +615,7 @@ dcgmReturn_t DcgmConfigManager::GetCurrentConfigGpu(unsigned int gpuId, dcgmConf
     entityPair.entityId      = gpuId;
     entities.push_back(entityPair);
 
-    fieldIds.push_back(DCGM_FI_DEV_ECC_CURRENT);
-    fieldIds.push_back(DCGM_FI_DEV_APP_MEM_CLOCK);
-    fieldIds.push_back(DCGM_FI_DEV_APP_SM_CLOCK);
-    fieldIds.push_back(DCGM_FI_DEV_POWER_MGMT_LIMIT);
-    fieldIds.push_back(DCGM_FI_DEV_COMPUTE_MODE);
-    fieldIds.push_back(DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK);
+    fieldIds.assign(std::begin(c_currentConfigFieldIds), std::end(c_currentConfigFieldIds));
 
     dcgmReturn = mpCoreProxy.GetMultipleLatestLiveSamples(entities, fieldIds, &fvBuffer);
     if (dcgmReturn != DCGM_ST_OK)
@@ -599,47 +636,149 @@ dcgmReturn_t DcgmConfigManager::GetCurrentConfigGpu(unsigned int gpuId, dcgmConf
             continue;
         }
 
-        switch (fv->fieldId)
+        HelperApplyConfigFv(config, *fv);
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void DcgmConfigManager::HelperApplyConfigFv(dcgmConfig_t *config, dcgmBufferedFv_t const &fv)
+{
+    switch (fv.fieldId)
+    {
+        case DCGM_FI_DEV_ECC_CURRENT:
+            config->eccMode = nvcmvalue_int64_to_int32(fv.value.i64);
+            break;
+
+        case DCGM_FI_DEV_APP_MEM_CLOCK:
+            config->perfState.targetClocks.memClock = nvcmvalue_int64_to_int32(fv.value.i64);
+            break;
+
+        case DCGM_FI_DEV_APP_SM_CLOCK:
+            config->perfState.targetClocks.smClock = nvcmvalue_int64_to_int32(fv.value.i64);
+            break;
+
+        case DCGM_FI_DEV_POWER_MGMT_LIMIT:
+            config->powerLimit.type = DCGM_CONFIG_POWER_CAP_INDIVIDUAL;
+            config->powerLimit.val  = nvcmvalue_double_to_int32(fv.value.dbl);
+            break;
+
+        case DCGM_FI_DEV_COMPUTE_MODE:
+            config->computeMode = nvcmvalue_int64_to_int32(fv.value.i64);
+            break;
+
+        case DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK:
+            memcpy(config->workloadPowerProfiles, fv.value.blob, sizeof(config->workloadPowerProfiles));
+            break;
+
+        default:
+            log_error("Unexpected fieldId {}", fv.fieldId);
+            break;
+    }
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmConfigManager::WatchCurrentConfigFields(std::vector<unsigned int> const &gpuIds)
+{
+    DcgmWatcher watcher(DcgmWatcherTypeConfigManager);
+    bool updateOnFirstWatch = false; /* We call UpdateAllFields() once at the end */
+    bool wereFirstWatcher   = false;
+    bool haveNewWatches     = false;
+
+    for (unsigned int gpuId : gpuIds)
+    {
+        if (gpuId >= DCGM_MAX_NUM_DEVICES || m_currentConfigWatched[gpuId])
+        {
+            continue;
+        }
+
+        for (unsigned short fieldId : c_currentConfigFieldIds)
         {
-            case DCGM_FI_DEV_ECC_CURRENT:
-                config->eccMode = nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
-
-            case DCGM_FI_DEV_APP_MEM_CLOCK:
-                config->perfState.targetClocks.memClock = nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
-
-            case DCGM_FI_DEV_APP_SM_CLOCK:
-                config->perfState.targetClocks.smClock = nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
-
-            case DCGM_FI_DEV_POWER_MGMT_LIMIT:
-                config->powerLimit.type = DCGM_CONFIG_POWER_CAP_INDIVIDUAL;
-                config->powerLimit.val  = nvcmvalue_double_to_int32(fv->value.dbl);
-                break;
-
-            case DCGM_FI_DEV_COMPUTE_MODE:
-                config->computeMode = nvcmvalue_int64_to_int32(fv->value.i64);
-                break;
-
-            case DCGM_FI_DEV_REQUESTED_POWER_PROFILE_MASK:
-                memcpy(config->workloadPowerProfiles, fv->value.blob, sizeof(config->workloadPowerProfiles));
-                break;
-
-            default:
-                log_error("Unexpected fieldId {}", fv->fieldId);
-                break;
+            dcgmReturn_t dcgmReturn = mpCoreProxy.AddFieldWatch(DCGM_FE_GPU,
+                                                                gpuId,
+                                                                fieldId,
+                                                                CurrentConfigWatchFreqUsec,
+                                                                CurrentConfigMaxAgeUsec / 1000000.0,
+                                                                0,
+                                                                watcher,
+                                                                false,
+                                                                updateOnFirstWatch,
+                                                                wereFirstWatcher);
+            if (dcgmReturn != DCGM_ST_OK)
+            {
+                log_error("AddFieldWatch returned {} for gpuId {} fieldId {}", dcgmReturn, gpuId, fieldId);
+                return dcgmReturn;
+            }
         }
+
+        m_currentConfigWatched[gpuId] = true;
+        haveNewWatches                = true;
+    }
+
+    if (haveNewWatches)
+    {
+        mpCoreProxy.UpdateAllFields(1);
     }
 
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+bool DcgmConfigManager::GetCachedConfigGpu(unsigned int gpuId, dcgmConfig_t *config)
+{
+    if (gpuId >= DCGM_MAX_NUM_DEVICES || !m_currentConfigWatched[gpuId])
+    {
+        return false;
+    }
+
+    /* Samples read before the last change we made or past the freshness bound don't count */
+    timelib64_t const oldestUsec = std::max(timelib_usecSince1970() - CurrentConfigMaxAgeUsec,
+                                            m_configChangedUsec[gpuId] + 1);
+
+    dcmBlankConfig(config, gpuId);
+    config->gpuId = gpuId;
+
+    for (unsigned short fieldId : c_currentConfigFieldIds)
+    {
+        DcgmFvBuffer fvBuffer;
+        mpCoreProxy.GetLatestSample(DCGM_FE_GPU, gpuId, fieldId, nullptr, &fvBuffer);
+
+        dcgmBufferedFvCursor_t cursor = 0;
+        dcgmBufferedFv_t *fv          = fvBuffer.GetNextFv(&cursor);
+        if (fv == nullptr)
+        {
+            return false;
+        }
+
+        if (fv->status == DCGM_ST_NOT_SUPPORTED)
+        {
+            /* The cache already knows the driver can't read it. Leave it blank like a live read would */
+            continue;
+        }
+
+        if (fv->status != DCGM_ST_OK || fv->timestamp < oldestUsec)
+        {
+            log_debug("gpuId {} fieldId {} has status {} and timestamp {}. Reading live",
+                      gpuId,
+                      fieldId,
+                      fv->status,
+                      fv->timestamp);
+            return false;
+        }
+
+        HelperApplyConfigFv(config, *fv);
+    }
+
+    return true;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmConfigManager::GetCurrentConfig(unsigned int groupId,
                                                  unsigned int *numConfigs,
                                                  dcgmConfig_t *configs,
-                                                 DcgmConfigManagerStatusList *statusList)
+                                                 DcgmConfigManagerStatusList *statusList,
+                                                 bool live)
 {
     dcgmReturn_t dcgmReturn;
     unsigned int multiRetCode = 0;
@@ -677,19 +816,56 @@ dcgmReturn_t DcgmConfigManager::GetCurrentConfig(unsigned int groupId,
         return DCGM_ST_BADPARAM;
     }
 
-    for (size_t i = 0; i < gpuIds.size(); ++i)
+    if (gpuIds.size() > DCGM_MAX_NUM_DEVICES)
     {
-        unsigned int gpuId;
+        log_error("Config Get Err: group id {} has {} GPUs", groupId, gpuIds.size());
+        statusList->AddStatus(DCGM_INT32_BLANK, DCGM_FI_UNKNOWN, DCGM_ST_BADPARAM);
+        return DCGM_ST_BADPARAM;
+    }
 
-        gpuId = gpuIds[i];
+    /* Keeps SetConfig and EnforceConfig from changing the GPUs while we read them */
+    DcgmLockGuard lockGuard(m_mutex);
+
+    /* Read whatever the cache doesn't have fresh live, all GPUs at the same time */
+    std::vector<unsigned int> liveGpuIds;
+    std::vector<dcgmConfig_t *> liveConfigByGpu(DCGM_MAX_NUM_DEVICES, nullptr);
 
-        dcgmReturn = GetCurrentConfigGpu(gpuId, &configs[*numConfigs]);
+    if (!live)
+    {
+        dcgmReturn = WatchCurrentConfigFields(gpuIds);
         if (dcgmReturn != DCGM_ST_OK)
+        {
+            log_debug("Reading the config of group id {} live after {} from WatchCurrentConfigFields",
+                      groupId,
+                      dcgmReturn);
+        }
+    }
+
+    for (size_t i = 0; i < gpuIds.size(); ++i)
+    {
+        unsigned int const gpuId = gpuIds[i];
+        if (gpuId >= DCGM_MAX_NUM_DEVICES)
+        {
+            log_error("GetCurrentConfig got invalid gpuId {}", gpuId);
+            dcmBlankConfig(&configs[i], gpuId);
             multiRetCode++;
+            continue;
+        }
 
-        (*numConfigs)++;
+        if (live || !GetCachedConfigGpu(gpuId, &configs[i]))
+        {
+            liveGpuIds.push_back(gpuId);
+            liveConfigByGpu[gpuId] = &configs[i];
+        }
     }
 
+    auto getCurrentConfigGpu = [this, &liveConfigByGpu](unsigned int gpuId, DcgmConfigManagerStatusList *) {
+        return GetCurrentConfigGpu(gpuId, liveConfigByGpu[gpuId]);
+    };
+    multiRetCode += RunForEachGpu(liveGpuIds, statusList, getCurrentConfigGpu);
+
+    *numConfigs = gpuIds.size();
+
     /* Sync boost is no longer supported. Set it to BLANK */
     for (unsigned int i = 0; i < (*numConfigs); i++)
     {
@@ -808,7 +984,7 @@ dcgmReturn_t DcgmConfigManager::HelperEnforceConfig(unsigned int gpuId, DcgmConf
     }
 
     /* Set Power Limit */
-    dcgmReturn = HelperSetPowerLimit(gpuId, activeConfig);
+    dcgmReturn = HelperSetPowerLimit(gpuId, activeConfig, &currentConfig);
     if (DCGM_ST_OK != dcgmReturn)
     {
         multiPropertyRetCode++;
@@ -816,7 +992,7 @@ dcgmReturn_t DcgmConfigManager::HelperEnforceConfig(unsigned int gpuId, DcgmConf
     }
 
     /* Set Perf States */
-    dcgmReturn = HelperSetPerfState(gpuId, activeConfig);
+    dcgmReturn = HelperSetPerfState(gpuId, activeConfig, &currentConfig);
     if (DCGM_ST_OK != dcgmReturn)
     {
         multiPropertyRetCode++;
@@ -825,7 +1001,7 @@ dcgmReturn_t DcgmConfigManager::HelperEnforceConfig(unsigned int gpuId, DcgmConf
     }
 
     /* Set Compute Mode */
-    dcgmReturn = HelperSetComputeMode(gpuId, activeConfig);
+    dcgmReturn = HelperSetComputeMode(gpuId, activeConfig, &currentConfig);
     if (DCGM_ST_OK != dcgmReturn)
     {
         multiPropertyRetCode++;
@@ -851,6 +1027,15 @@ dcgmReturn_t DcgmConfigManager::HelperEnforceConfig(unsigned int gpuId, DcgmConf
 
 /*****************************************************************************/
 dcgmReturn_t DcgmConfigManager::EnforceConfigGpu(unsigned int gpuId, DcgmConfigManagerStatusList *statusList)
+{
+    /* Get the lock for the remainder of this call */
+    DcgmLockGuard lockGuard(m_mutex);
+
+    return EnforceConfigGpuLocked(gpuId, statusList);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmConfigManager::EnforceConfigGpuLocked(unsigned int gpuId, DcgmConfigManagerStatusList *statusList)
 {
     dcgmReturn_t dcgmRet;
 
@@ -868,10 +1053,8 @@ dcgmReturn_t DcgmConfigManager::EnforceConfigGpu(unsigned int gpuId, DcgmConfigM
         return DCGM_ST_BADPARAM;
     }
 
-    /* Get the lock for the remainder of this call */
-    DcgmLockGuard lockGuard(m_mutex);
-
-    dcgmRet = HelperEnforceConfig(gpuId, statusList);
+    dcgmRet                    = HelperEnforceConfig(gpuId, statusList);
+    m_configChangedUsec[gpuId] = timelib_usecSince1970();
     if (DCGM_ST_OK != dcgmRet)
     {
         log_error("Failed to enforce configuration for the GPU Id: {}. Error: {}", gpuId, dcgmRet);
@@ -959,18 +1142,36 @@ dcgmReturn_t DcgmConfigManager::SetConfig(unsigned int groupId,
         }
     }
 
-    /* Loop through the group to set configuration for each GPU */
-    for (index = 0; index < gpuIds.size(); index++)
+    /* The target configs are created here since the GPUs are configured without taking m_mutex */
+    std::vector<dcgmConfig_t *> targetConfigs(DCGM_MAX_NUM_DEVICES, nullptr);
+    for (unsigned int gpuId : gpuIds)
     {
-        unsigned int gpuId = gpuIds[index];
-        dcgmReturn         = SetConfigGpu(gpuId, setConfig, statusList);
-        if (DCGM_ST_OK != dcgmReturn)
+        if (gpuId < DCGM_MAX_NUM_DEVICES)
         {
-            log_error("SetConfig failed with {} for gpuId {}", dcgmReturn, gpuId);
-            grpRetCode++;
+            targetConfigs[gpuId] = HelperGetTargetConfig(gpuId);
         }
     }
 
+    /* Configure all the GPUs of the group at the same time */
+    auto setConfigGpu = [this, setConfig, &targetConfigs](unsigned int gpuId,
+                                                          DcgmConfigManagerStatusList *gpuStatusList) {
+        if (gpuId >= DCGM_MAX_NUM_DEVICES)
+        {
+            log_error("SetConfig got invalid gpuId {}", gpuId);
+            gpuStatusList->AddStatus(DCGM_INT32_BLANK, DCGM_FI_UNKNOWN, DCGM_ST_BADPARAM);
+            return DCGM_ST_BADPARAM;
+        }
+
+        dcgmReturn_t gpuReturn     = SetConfigGpu(gpuId, setConfig, targetConfigs[gpuId], gpuStatusList);
+        m_configChangedUsec[gpuId] = timelib_usecSince1970();
+        if (DCGM_ST_OK != gpuReturn)
+        {
+            log_error("SetConfig failed with {} for gpuId {}", gpuReturn, gpuId);
+        }
+        return gpuReturn;
+    };
+    grpRetCode += RunForEachGpu(gpuIds, statusList, setConfigGpu);
+
     /* Special handling for sync boost */
     dcgmReturn = SetSyncBoost(&gpuIds[0], gpuIds.size(), setConfig, statusList);
     if (DCGM_ST_OK != dcgmReturn)
@@ -1021,15 +1222,11 @@ dcgmReturn_t DcgmConfigManager::EnforceConfigGroup(unsigned int groupId, DcgmCon
     /* Acquire the lock for the remainder of the function */
     DcgmLockGuard lockGuard(m_mutex);
 
-    /* Loop through the group to set configuration for each GPU */
-    for (index = 0; index < (int)gpuIds.size(); index++)
-    {
-        unsigned int gpuId;
-        gpuId      = gpuIds[index];
-        dcgmReturn = EnforceConfigGpu(gpuId, statusList);
-        if (DCGM_ST_OK != dcgmReturn)
-            grpRetCode++;
-    }
+    /* Enforce the configuration of all the GPUs of the group at the same time */
+    auto enforceConfigGpu = [this](unsigned int gpuId, DcgmConfigManagerStatusList *gpuStatusList) {
+        return EnforceConfigGpuLocked(gpuId, gpuStatusList);
+    };
+    grpRetCode = RunForEachGpu(gpuIds, statusList, enforceConfigGpu);
 
     if (0 == grpRetCode)
         return DCGM_ST_OK;
@@ -1038,3 +1235,72 @@ dcgmReturn_t DcgmConfigManager::EnforceConfigGroup(unsigned int groupId, DcgmCon
 }
 
 /*****************************************************************************/
+unsigned int DcgmConfigManager::RunForEachGpu(
+    std::vector<unsigned int> const &gpuIds,
+    DcgmConfigManagerStatusList *statusList,
+    std::function<dcgmReturn_t(unsigned int, DcgmConfigManagerStatusList *)> const &gpuFunc)
+{
+    struct GpuResult
+    {
+        unsigned int errorCount = 0;
+        std::vector<dcgm_config_status_t> statuses;
+        dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+    };
+
+    std::vector<GpuResult> results(gpuIds.size());
+    std::vector<std::optional<std::shared_future<void>>> futures(gpuIds.size());
+
+    if (gpuIds.size() > 1 && m_gpuThreadPool == nullptr)
+    {
+        m_gpuThreadPool = std::make_unique<DcgmNs::WorkStealingThreadPool>(GpuThreadCount, "dcgm_config");
+    }
+
+    for (size_t i = 0; i < gpuIds.size(); i++)
+    {
+        auto runOne = [&gpuFunc, &result = results[i], gpuId = gpuIds[i], maxNumErrors = statusList->m_maxNumErrors]() {
+            result.statuses.resize(maxNumErrors);
+            DcgmConfigManagerStatusList gpuStatusList(maxNumErrors, &result.errorCount, result.statuses.data());
+            result.dcgmReturn = gpuFunc(gpuId, &gpuStatusList);
+        };
+
+        if (gpuIds.size() > 1)
+        {
+            futures[i] = m_gpuThreadPool->Enqueue(runOne);
+        }
+        if (!futures[i].has_value())
+        {
+            runOne();
+        }
+    }
+
+    /* Every call has to be done before returning, even if one of them threw, since they use results */
+    for (auto const &future : futures)
+    {
+        if (future.has_value())
+        {
+            future->wait();
+        }
+    }
+
+    unsigned int failureCount = 0;
+    for (size_t i = 0; i < gpuIds.size(); i++)
+    {
+        if (futures[i].has_value())
+        {
+            futures[i]->get();
+        }
+
+        for (unsigned int j = 0; j < results[i].errorCount; j++)
+        {
+            auto const &status = results[i].statuses[j];
+            statusList->AddStatus(status.gpuId, status.fieldId, status.errorCode);
+        }
+
+        if (results[i].dcgmReturn != DCGM_ST_OK)
+        {
+            failureCount++;
+        }
+    }
+
+    return failureCount;
+}
@@ -25,8 +25,14 @@
 #include "dcgm_agent.h"
 #include "dcgm_config_structs.h"
 #include <DcgmCoreProxy.h>
+#include <DcgmFvBuffer.h>
+#include <WorkStealingThreadPool.hpp>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 
 #include <DcgmModule.h>
@@ -102,13 +108,16 @@ public:
      * @param groupId       IN: Group ID
      * @param numConfigs   OUT: How many configs were written to configs[]
      * @param statuses     OUT: Per-GPU status codes resulting from this operation
+     * @param live          IN: Read every GPU from the driver. Otherwise, GPUs are served from the
+     *                          cache manager when it has samples that are fresh enough
      *
      * @return
      */
     dcgmReturn_t GetCurrentConfig(unsigned int groupId,
                                   unsigned int *numConfigs,
                                   dcgmConfig_t *configs,
-                                  DcgmConfigManagerStatusList *statusList);
+                                  DcgmConfigManagerStatusList *statusList,
+                                  bool live);
 
     /*****************************************************************************
      * Used to enforce previously set configuration for the specified GPU or group. The method is to enforce
@@ -129,9 +138,9 @@ private:
     /*****************************************************************************
      * This method is used to merge setConfig into the target configuration for a GPU
      * for a given field. If fieldId is non-blank in setConfig, it will be applied
-     * to our local configuration
+     * to targetConfig, which came from HelperGetTargetConfig()
      *****************************************************************************/
-    void HelperMergeTargetConfiguration(unsigned int gpuId, unsigned int fieldId, dcgmConfig_t *setConfig);
+    void HelperMergeTargetConfiguration(dcgmConfig_t *targetConfig, unsigned int fieldId, dcgmConfig_t *setConfig);
 
     /*****************************************************************************
      * Helper method to configure ECC Mode
@@ -144,18 +153,21 @@ private:
 
     /*****************************************************************************
      * Helper method to set power limit for the GPU
+     * Nothing is set if currentConfig already has it
      *****************************************************************************/
-    dcgmReturn_t HelperSetPowerLimit(unsigned int gpuId, dcgmConfig_t *setConfig);
+    dcgmReturn_t HelperSetPowerLimit(unsigned int gpuId, dcgmConfig_t *setConfig, dcgmConfig_t const *currentConfig);
 
     /*****************************************************************************
      * Helper method to set the perf state
+     * Nothing is set if currentConfig already has it
      *****************************************************************************/
-    dcgmReturn_t HelperSetPerfState(unsigned int gpuId, dcgmConfig_t *setConfig);
+    dcgmReturn_t HelperSetPerfState(unsigned int gpuId, dcgmConfig_t *setConfig, dcgmConfig_t const *currentConfig);
 
     /*****************************************************************************
      * Helper method to set Compute Mode
+     * Nothing is set if currentConfig already has it
      *****************************************************************************/
-    dcgmReturn_t HelperSetComputeMode(unsigned int gpuId, dcgmConfig_t *setConfig);
+    dcgmReturn_t HelperSetComputeMode(unsigned int gpuId, dcgmConfig_t *setConfig, dcgmConfig_t const *currentConfig);
 
     /*****************************************************************************
      * Helper method to set requested workload power profiles
@@ -182,18 +194,74 @@ private:
      *****************************************************************************/
     dcgmReturn_t GetCurrentConfigGpu(unsigned int gpuId, dcgmConfig_t *config);
 
+    /*****************************************************************************
+     * Populate a dcgmConfig_t with the current config for a GPU from the samples of
+     * WatchCurrentConfigFields(). The caller must hold m_mutex.
+     *
+     * Returns false if any of them is missing, older than CurrentConfigMaxAgeUsec or
+     * older than our last change to the GPU. The config has to be read live then
+     *****************************************************************************/
+    bool GetCachedConfigGpu(unsigned int gpuId, dcgmConfig_t *config);
+
+    /*****************************************************************************
+     * Watch the current config fields of any of gpuIds that aren't watched yet,
+     * waiting for their first samples. The caller must hold m_mutex
+     *****************************************************************************/
+    dcgmReturn_t WatchCurrentConfigFields(std::vector<unsigned int> const &gpuIds);
+
+    /*****************************************************************************
+     * Set the member of config that fv holds. fv must have a status of DCGM_ST_OK
+     *****************************************************************************/
+    static void HelperApplyConfigFv(dcgmConfig_t *config, dcgmBufferedFv_t const &fv);
+
     /******************************************************************************
-     * Helper to set the config for a single GPU
+     * Helper to set the config for a single GPU. targetConfig is the GPU's
+     * target config from HelperGetTargetConfig()
      *****************************************************************************/
-    dcgmReturn_t SetConfigGpu(unsigned int gpuId, dcgmConfig_t *setConfig, DcgmConfigManagerStatusList *statusList);
+    dcgmReturn_t SetConfigGpu(unsigned int gpuId,
+                              dcgmConfig_t *setConfig,
+                              dcgmConfig_t *targetConfig,
+                              DcgmConfigManagerStatusList *statusList);
+
+    /******************************************************************************
+     * EnforceConfigGpu() for a caller that already holds m_mutex
+     *****************************************************************************/
+    dcgmReturn_t EnforceConfigGpuLocked(unsigned int gpuId, DcgmConfigManagerStatusList *statusList);
+
+    /******************************************************************************
+     * Run gpuFunc for every GPU in gpuIds at the same time, on m_gpuThreadPool.
+     * Each call gets a status list of its own. Their statuses are added to
+     * statusList in the order of gpuIds once all of them are done.
+     *
+     * The caller must hold m_mutex. gpuFunc may only touch the state of its own GPU
+     * and must not take m_mutex.
+     *
+     * Returns the number of calls that did not return DCGM_ST_OK
+     *****************************************************************************/
+    unsigned int RunForEachGpu(std::vector<unsigned int> const &gpuIds,
+                               DcgmConfigManagerStatusList *statusList,
+                               std::function<dcgmReturn_t(unsigned int, DcgmConfigManagerStatusList *)> const &gpuFunc);
 
     /* Array of currently-active target configs. These can be null, so you may have to alloc them */
     dcgmConfig_t *m_activeConfig[DCGM_MAX_NUM_DEVICES];
 
     DcgmCoreProxy mpCoreProxy;
-    unsigned int mClocksConfigured;
+    std::atomic_uint mClocksConfigured;
 
     DcgmMutex *m_mutex; /* Lock used for accessing default config data structure */
+
+    /* The config fields change rarely and mostly through us, so they are sampled slowly.
+       Cached samples older than CurrentConfigMaxAgeUsec are not used */
+    static constexpr timelib64_t CurrentConfigWatchFreqUsec = 30000000;
+    static constexpr timelib64_t CurrentConfigMaxAgeUsec    = 2 * CurrentConfigWatchFreqUsec;
+
+    /* Protected by m_mutex. RunForEachGpu() calls only touch the entry of their own GPU */
+    bool m_currentConfigWatched[DCGM_MAX_NUM_DEVICES];     /* Are the current config fields of the GPU watched? */
+    timelib64_t m_configChangedUsec[DCGM_MAX_NUM_DEVICES]; /* When we last set or enforced the config of the GPU */
+
+    static constexpr std::size_t GpuThreadCount = 8;
+    std::unique_ptr<DcgmNs::WorkStealingThreadPool> m_gpuThreadPool; /* Created by the first RunForEachGpu()
+                                                                         call. Protected by m_mutex */
 };
 
 #endif /* DCGMCONFIGMANAGER_H */
@@ -88,7 +88,9 @@ dcgmReturn_t DcgmModuleConfig::ProcessGetConfig(dcgm_config_msg_get_v1 *msg)
     if (msg->reqType == DCGM_CONFIG_TARGET_STATE)
         dcgmReturn = mpConfigManager->GetTargetConfig(groupId, &msg->numConfigs, msg->configs, &statusList);
     else if (msg->reqType == DCGM_CONFIG_CURRENT_STATE)
-        dcgmReturn = mpConfigManager->GetCurrentConfig(groupId, &msg->numConfigs, msg->configs, &statusList);
+        dcgmReturn = mpConfigManager->GetCurrentConfig(groupId, &msg->numConfigs, msg->configs, &statusList, false);
+    else if (msg->reqType == DCGM_CONFIG_CURRENT_STATE_LIVE)
+        dcgmReturn = mpConfigManager->GetCurrentConfig(groupId, &msg->numConfigs, msg->configs, &statusList, true);
     else
     {
         log_error("Bad reqType {}", msg->reqType);
@@ -17,6 +17,8 @@
 #include "../profiling/dcgm_profiling_structs.h"
 #include "DcgmLogging.h"
 #include "nvswitch/dcgm_nvswitch_structs.h"
+#include <DcgmCommandTable.hpp>
+#include <DcgmFvColumns.h>
 #include <DcgmGroupManager.h>
 #include <DcgmHostEngineHandler.h>
 #include <DcgmStringHelpers.h>
@@ -44,7 +46,160 @@ DcgmModuleCore::~DcgmModuleCore()
 
 dcgmReturn_t DcgmModuleCore::ProcessMessage(dcgm_module_command_header_t *moduleCommand)
 {
-    dcgmReturn_t dcgmReturn = DCGM_ST_OK;
+    using DcgmNs::Handle;
+
+    static constexpr auto c_commands = DcgmNs::MakeCommandTable<DcgmModuleCore>({
+        Handle<&DcgmModuleCore::ProcessSetLoggingSeverity>(
+            DCGM_CORE_SR_SET_LOGGING_SEVERITY, dcgm_core_msg_set_severity_version),
+        Handle<&DcgmModuleCore::ProcessCreateMigEntity>(
+            DCGM_CORE_SR_MIG_ENTITY_CREATE, dcgm_core_msg_create_mig_entity_version),
+        Handle<&DcgmModuleCore::ProcessDeleteMigEntity>(
+            DCGM_CORE_SR_MIG_ENTITY_DELETE, dcgm_core_msg_delete_mig_entity_version),
+        Handle<&DcgmModuleCore::ProcessGetGpuStatus>(DCGM_CORE_SR_GET_GPU_STATUS, dcgm_core_msg_get_gpu_status_version),
+        Handle<&DcgmModuleCore::ProcessHostengineVersion>(
+            DCGM_CORE_SR_HOSTENGINE_VERSION, dcgm_core_msg_hostengine_version_version),
+        Handle<&DcgmModuleCore::ProcessCreateGroup>(DCGM_CORE_SR_CREATE_GROUP, dcgm_core_msg_create_group_version),
+        Handle<&DcgmModuleCore::ProcessAddRemoveEntity>(
+            DCGM_CORE_SR_REMOVE_ENTITY, dcgm_core_msg_add_remove_entity_version),
+        Handle<&DcgmModuleCore::ProcessAddRemoveEntity>(
+            DCGM_CORE_SR_GROUP_ADD_ENTITY, dcgm_core_msg_add_remove_entity_version),
+        Handle<&DcgmModuleCore::ProcessGroupDestroy>(DCGM_CORE_SR_GROUP_DESTROY, dcgm_core_msg_group_destroy_version),
+        Handle<&DcgmModuleCore::ProcessGetEntityGroupEntities>(
+            DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES, dcgm_core_msg_get_entity_group_entities_version),
+        Handle<&DcgmModuleCore::ProcessGroupGetAllIds>(
+            DCGM_CORE_SR_GROUP_GET_ALL_IDS, dcgm_core_msg_group_get_all_ids_version),
+        Handle<&DcgmModuleCore::ProcessGroupGetInfo>(DCGM_CORE_SR_GROUP_GET_INFO, dcgm_core_msg_group_get_info_version),
+        Handle<&DcgmModuleCore::ProcessJobStartStats>(DCGM_CORE_SR_JOB_START_STATS, dcgm_core_msg_job_cmd_version),
+        Handle<&DcgmModuleCore::ProcessJobStopStats>(DCGM_CORE_SR_JOB_STOP_STATS, dcgm_core_msg_job_cmd_version),
+        Handle<&DcgmModuleCore::ProcessJobGetStats>(DCGM_CORE_SR_JOB_GET_STATS, dcgm_core_msg_job_get_stats_version),
+        Handle<&DcgmModuleCore::ProcessJobRemove>(DCGM_CORE_SR_JOB_REMOVE, dcgm_core_msg_job_cmd_version),
+        Handle<&DcgmModuleCore::ProcessJobRemoveAll>(DCGM_CORE_SR_JOB_REMOVE_ALL, dcgm_core_msg_job_cmd_version),
+        Handle<&DcgmModuleCore::ProcessEntitiesGetLatestValuesV1>(
+            DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V1,
+            dcgm_core_msg_entities_get_latest_values_version1,
+            sizeof(dcgm_core_msg_entities_get_latest_values_v1) - SAMPLES_BUFFER_SIZE_V1),
+        Handle<&DcgmModuleCore::ProcessEntitiesGetLatestValuesV2>(
+            DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V2,
+            dcgm_core_msg_entities_get_latest_values_version2,
+            sizeof(dcgm_core_msg_entities_get_latest_values_v2) - SAMPLES_BUFFER_SIZE_V2),
+        Handle<&DcgmModuleCore::ProcessEntitiesGetLatestValuesV3>(
+            DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V3,
+            dcgm_core_msg_entities_get_latest_values_version3,
+            sizeof(dcgm_core_msg_entities_get_latest_values_v3) - SAMPLES_BUFFER_SIZE_V2),
+        Handle<&DcgmModuleCore::ProcessGetMultipleValuesForFieldV1>(
+            DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V1,
+            dcgm_core_msg_get_multiple_values_for_field_version1,
+            sizeof(dcgm_core_msg_get_multiple_values_for_field_v1) - SAMPLES_BUFFER_SIZE_V1),
+        Handle<&DcgmModuleCore::ProcessGetMultipleValuesForFieldV2>(
+            DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V2,
+            dcgm_core_msg_get_multiple_values_for_field_version2,
+            sizeof(dcgm_core_msg_get_multiple_values_for_field_v2) - SAMPLES_BUFFER_SIZE_V2),
+        Handle<&DcgmModuleCore::ProcessWatchFieldValueV1>(
+            DCGM_CORE_SR_WATCH_FIELD_VALUE_V1, dcgm_core_msg_watch_field_value_version1),
+        Handle<&DcgmModuleCore::ProcessWatchFieldValueV2>(
+            DCGM_CORE_SR_WATCH_FIELD_VALUE_V2, dcgm_core_msg_watch_field_value_version2),
+        Handle<&DcgmModuleCore::ProcessUpdateAllFields>(
+            DCGM_CORE_SR_UPDATE_ALL_FIELDS, dcgm_core_msg_update_all_fields_version),
+        Handle<&DcgmModuleCore::ProcessUpdateFields>(DCGM_CORE_SR_UPDATE_FIELDS, dcgm_core_msg_update_fields_version),
+        Handle<&DcgmModuleCore::ProcessSnapshotFields>(
+            DCGM_CORE_SR_SNAPSHOT_FIELDS, dcgm_core_msg_snapshot_fields_version),
+        Handle<&DcgmModuleCore::ProcessResampleValues>(
+            DCGM_CORE_SR_RESAMPLE_VALUES, dcgm_core_msg_resample_values_version),
+        Handle<&DcgmModuleCore::ProcessMetadataSubscribe>(
+            DCGM_CORE_SR_METADATA_SUBSCRIBE, dcgm_core_msg_metadata_subscribe_version),
+        Handle<&DcgmModuleCore::ProcessRequestCancelSupport>(
+            DCGM_CORE_SR_REQUEST_CANCEL_SUPPORT, dcgm_core_msg_request_cancel_support_version),
+        Handle<&DcgmModuleCore::ProcessUnwatchFieldValue>(
+            DCGM_CORE_SR_UNWATCH_FIELD_VALUE, dcgm_core_msg_unwatch_field_value_version),
+        Handle<&DcgmModuleCore::ProcessInjectFieldValue>(
+            DCGM_CORE_SR_INJECT_FIELD_VALUE, dcgm_core_msg_inject_field_value_version),
+        Handle<&DcgmModuleCore::ProcessInjectFieldValues>(
+            DCGM_CORE_SR_INJECT_FIELD_VALUES,
+            dcgm_core_msg_inject_field_values_version,
+            sizeof(dcgm_core_msg_inject_field_values_t) - DCGM_INJECT_FIELD_VALUES_BUFFER_SIZE),
+        Handle<&DcgmModuleCore::ProcessGetCacheManagerFieldInfo>(
+            DCGM_CORE_SR_GET_CACHE_MANAGER_FIELD_INFO, dcgm_core_msg_get_cache_manager_field_info_version2),
+        Handle<&DcgmModuleCore::ProcessWatchFields>(DCGM_CORE_SR_WATCH_FIELDS, dcgm_core_msg_watch_fields_version),
+        Handle<&DcgmModuleCore::ProcessUnwatchFields>(DCGM_CORE_SR_UNWATCH_FIELDS, dcgm_core_msg_watch_fields_version),
+        Handle<&DcgmModuleCore::ProcessSubscribeFields>(
+            DCGM_CORE_SR_SUBSCRIBE_FIELDS, dcgm_core_msg_watch_fields_version),
+        Handle<&DcgmModuleCore::ProcessUnsubscribeFields>(
+            DCGM_CORE_SR_UNSUBSCRIBE_FIELDS, dcgm_core_msg_watch_fields_version),
+        Handle<&DcgmModuleCore::ProcessValuesCursorOpen>(
+            DCGM_CORE_SR_VALUES_CURSOR_OPEN, dcgm_core_msg_values_cursor_version),
+        Handle<&DcgmModuleCore::ProcessValuesCursorNext>(
+            DCGM_CORE_SR_VALUES_CURSOR_NEXT, dcgm_core_msg_values_cursor_version),
+        Handle<&DcgmModuleCore::ProcessValuesCursorClose>(
+            DCGM_CORE_SR_VALUES_CURSOR_CLOSE, dcgm_core_msg_values_cursor_version),
+        Handle<&DcgmModuleCore::ProcessGetTopology>(DCGM_CORE_SR_GET_TOPOLOGY, dcgm_core_msg_get_topology_version),
+        Handle<&DcgmModuleCore::ProcessGetTopologyAffinity>(
+            DCGM_CORE_SR_GET_TOPOLOGY_AFFINITY, dcgm_core_msg_get_topology_affinity_version),
+        Handle<&DcgmModuleCore::ProcessSelectGpusByTopology>(
+            DCGM_CORE_SR_SELECT_TOPOLOGY_GPUS, dcgm_core_msg_select_topology_gpus_version),
+        Handle<&DcgmModuleCore::ProcessGetAllDevices>(
+            DCGM_CORE_SR_GET_ALL_DEVICES, dcgm_core_msg_get_all_devices_version),
+        Handle<&DcgmModuleCore::ProcessClientLogin>(DCGM_CORE_SR_CLIENT_LOGIN, dcgm_core_msg_client_login_version),
+        Handle<&DcgmModuleCore::ProcessSetEntityNvLinkState>(
+            DCGM_CORE_SR_SET_ENTITY_LINK_STATE, dcgm_core_msg_set_entity_nvlink_state_version),
+        Handle<&DcgmModuleCore::ProcessGetNvLinkStatus>(
+            DCGM_CORE_SR_GET_NVLINK_STATUS, dcgm_core_msg_get_nvlink_status_version),
+        Handle<&DcgmModuleCore::ProcessFieldgroupOp>(
+            DCGM_CORE_SR_FIELDGROUP_CREATE, dcgm_core_msg_fieldgroup_op_version),
+        Handle<&DcgmModuleCore::ProcessFieldgroupOp>(
+            DCGM_CORE_SR_FIELDGROUP_DESTROY, dcgm_core_msg_fieldgroup_op_version),
+        Handle<&DcgmModuleCore::ProcessFieldgroupOp>(
+            DCGM_CORE_SR_FIELDGROUP_GET_INFO, dcgm_core_msg_fieldgroup_op_version),
+        Handle<&DcgmModuleCore::ProcessGetFieldSummary>(
+            DCGM_CORE_SR_GET_FIELD_SUMMARY, dcgm_core_msg_get_field_summary_version),
+        Handle<&DcgmModuleCore::ProcessGetFieldSummaryV2>(
+            DCGM_CORE_SR_GET_FIELD_SUMMARY_V2, dcgm_core_msg_get_field_summary_version2),
+        Handle<&DcgmModuleCore::ProcessPidGetInfo>(DCGM_CORE_SR_PID_GET_INFO, dcgm_core_msg_pid_get_info_version),
+        Handle<&DcgmModuleCore::ProcessCreateFakeEntities>(
+            DCGM_CORE_SR_CREATE_FAKE_ENTITIES, dcgm_core_msg_create_fake_entities_version),
+        Handle<&DcgmModuleCore::ProcessWatchPredefinedFields>(
+            DCGM_CORE_SR_WATCH_PREDEFINED_FIELDS, dcgm_core_msg_watch_predefined_fields_version),
+        Handle<&DcgmModuleCore::ProcessModuleDenylist>(
+            DCGM_CORE_SR_MODULE_DENYLIST, dcgm_core_msg_module_denylist_version),
+        Handle<&DcgmModuleCore::ProcessModuleStatus>(DCGM_CORE_SR_MODULE_STATUS, dcgm_core_msg_module_status_version),
+        Handle<&DcgmModuleCore::ProcessModuleStatusV2>(
+            DCGM_CORE_SR_MODULE_STATUS_V2, dcgm_core_msg_module_status_version2),
+        Handle<&DcgmModuleCore::ProcessHostEngineHealth>(
+            DCGM_CORE_SR_HOSTENGINE_HEALTH, dcgm_core_msg_hostengine_health_version),
+        Handle<&DcgmModuleCore::ProcessFieldGroupGetAll>(
+            DCGM_CORE_SR_FIELDGROUP_GET_ALL, dcgm_core_msg_fieldgroup_get_all_version),
+        Handle<&DcgmModuleCore::ProcessGetGpuInstanceHierarchy>(
+            DCGM_CORE_SR_GET_GPU_INSTANCE_HIERARCHY, dcgm_core_msg_get_gpu_instance_hierarchy_version),
+        Handle<&DcgmModuleCore::ProcessProfGetMetricGroups>(
+            DCGM_CORE_SR_PROF_GET_METRIC_GROUPS, dcgm_core_msg_get_metric_groups_version),
+        Handle<&DcgmModuleCore::ProcessProfGetMultiplexInfo>(
+            DCGM_CORE_SR_PROF_GET_MULTIPLEX_INFO, dcgm_core_msg_prof_multiplex_info_version),
+        Handle<&DcgmModuleCore::ProcessNvmlInjectFieldValue>(
+            DCGM_CORE_SR_NVML_INJECT_FIELD_VALUE, dcgm_core_msg_nvml_inject_field_value_version),
+        Handle<&DcgmModuleCore::ProcessNvmlCreateFakeEntity>(
+            DCGM_CORE_SR_NVML_CREATE_FAKE_ENTITY, dcgm_core_msg_nvml_create_injection_gpu_version),
+        Handle<&DcgmModuleCore::ProcessPauseResume>(DCGM_CORE_SR_PAUSE_RESUME, dcgm_core_msg_pause_resume_version1),
+        Handle<&DcgmModuleCore::ProcessGetDeviceWorkloadPowerProfilesInfo>(
+            DCGM_CORE_SR_GET_WORKLOAD_POWER_PROFILES_STATUS, dcgm_core_msg_get_workload_power_profiles_status_version),
+#ifdef INJECTION_LIBRARY_AVAILABLE
+        Handle<&DcgmModuleCore::ProcessNvmlInjectDevice>(
+            DCGM_CORE_SR_NVML_INJECT_DEVICE, dcgm_core_msg_nvml_inject_device_version),
+        Handle<&DcgmModuleCore::ProcessNvmlInjectDeviceForFollowingCalls>(
+            DCGM_CORE_SR_NVML_INJECT_DEVICE_FOR_FOLLOWING_CALLS,
+            dcgm_core_msg_nvml_inject_device_for_following_calls_version),
+        Handle<&DcgmModuleCore::ProcessNvmlInjectedDeviceReset>(
+            DCGM_CORE_SR_NVML_INJECTED_DEVICE_RESET, dcgm_core_msg_nvml_injected_device_reset_version),
+        Handle<&DcgmModuleCore::ProcessGetNvmlInjectFuncCallCount>(
+            DCGM_CORE_SR_GET_NVML_INJECT_FUNC_CALL_COUNT, dcgm_core_msg_get_nvml_inject_func_call_count_version),
+        Handle<&DcgmModuleCore::ProcessResetNvmlInjectFuncCallCount>(
+            DCGM_CORE_SR_RESET_NVML_FUNC_CALL_COUNT, dcgm_core_msg_reset_nvml_inject_func_call_count_version),
+        Handle<&DcgmModuleCore::ProcessRemoveNvmlInjectedGpu>(
+            DCGM_CORE_SR_REMOVE_NVML_INJECTED_GPU, dcgm_core_msg_remove_restore_nvml_injected_gpu_version),
+        Handle<&DcgmModuleCore::ProcessRestoreNvmlInjectedGpu>(
+            DCGM_CORE_SR_RESTORE_NVML_INJECTED_GPU, dcgm_core_msg_remove_restore_nvml_injected_gpu_version),
+        Handle<&DcgmModuleCore::ProcessNvswitchGetBackend>(
+            DCGM_CORE_SR_NVSWITCH_GET_BACKEND, dcgm_core_msg_nvswitch_get_backend_version1),
+#endif
+    });
 
     if (moduleCommand == nullptr)
     {
@@ -56,220 +211,10 @@ dcgmReturn_t DcgmModuleCore::ProcessMessage(dcgm_module_command_header_t *module
         DCGM_LOG_ERROR << "Unexpected module command for module " << moduleCommand->moduleId;
         return DCGM_ST_BADPARAM;
     }
-    else
-    {
-        switch (moduleCommand->subCommand)
-        {
-            case DCGM_CORE_SR_SET_LOGGING_SEVERITY:
-                dcgmReturn = ProcessSetLoggingSeverity(*(dcgm_core_msg_set_severity_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_MIG_ENTITY_CREATE:
-                dcgmReturn = ProcessCreateMigEntity(*(dcgm_core_msg_create_mig_entity_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_MIG_ENTITY_DELETE:
-                dcgmReturn = ProcessDeleteMigEntity(*(dcgm_core_msg_delete_mig_entity_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_GPU_STATUS:
-                dcgmReturn = ProcessGetGpuStatus(*(dcgm_core_msg_get_gpu_status_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_HOSTENGINE_VERSION:
-                dcgmReturn = ProcessHostengineVersion(*(dcgm_core_msg_hostengine_version_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_CREATE_GROUP:
-                dcgmReturn = ProcessCreateGroup(*(dcgm_core_msg_create_group_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_REMOVE_ENTITY:
-            case DCGM_CORE_SR_GROUP_ADD_ENTITY:
-                dcgmReturn = ProcessAddRemoveEntity(*(dcgm_core_msg_add_remove_entity_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GROUP_DESTROY:
-                dcgmReturn = ProcessGroupDestroy(*(dcgm_core_msg_group_destroy_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_ENTITY_GROUP_ENTITIES:
-                dcgmReturn = ProcessGetEntityGroupEntities(*(dcgm_core_msg_get_entity_group_entities_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GROUP_GET_ALL_IDS:
-                dcgmReturn = ProcessGroupGetAllIds(*(dcgm_core_msg_group_get_all_ids_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GROUP_GET_INFO:
-                dcgmReturn = ProcessGroupGetInfo(*(dcgm_core_msg_group_get_info_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_JOB_START_STATS:
-                dcgmReturn = ProcessJobStartStats(*(dcgm_core_msg_job_cmd_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_JOB_STOP_STATS:
-                dcgmReturn = ProcessJobStopStats(*(dcgm_core_msg_job_cmd_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_JOB_GET_STATS:
-                dcgmReturn = ProcessJobGetStats(*(dcgm_core_msg_job_get_stats_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_JOB_REMOVE:
-                dcgmReturn = ProcessJobRemove(*(dcgm_core_msg_job_cmd_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_JOB_REMOVE_ALL:
-                dcgmReturn = ProcessJobRemoveAll(*(dcgm_core_msg_job_cmd_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V1:
-                dcgmReturn
-                    = ProcessEntitiesGetLatestValuesV1(*(dcgm_core_msg_entities_get_latest_values_v1 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V2:
-                dcgmReturn
-                    = ProcessEntitiesGetLatestValuesV2(*(dcgm_core_msg_entities_get_latest_values_v2 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_ENTITIES_GET_LATEST_VALUES_V3:
-                dcgmReturn
-                    = ProcessEntitiesGetLatestValuesV3(*(dcgm_core_msg_entities_get_latest_values_v3 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V1:
-                dcgmReturn = ProcessGetMultipleValuesForFieldV1(
-                    *(dcgm_core_msg_get_multiple_values_for_field_v1 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_MULTIPLE_VALUES_FOR_FIELD_V2:
-                dcgmReturn = ProcessGetMultipleValuesForFieldV2(
-                    *(dcgm_core_msg_get_multiple_values_for_field_v2 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_WATCH_FIELD_VALUE_V1:
-                dcgmReturn = ProcessWatchFieldValueV1(*(dcgm_core_msg_watch_field_value_v1 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_WATCH_FIELD_VALUE_V2:
-                dcgmReturn = ProcessWatchFieldValueV2(*(dcgm_core_msg_watch_field_value_v2 *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_UPDATE_ALL_FIELDS:
-                dcgmReturn = ProcessUpdateAllFields(*(dcgm_core_msg_update_all_fields_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_UNWATCH_FIELD_VALUE:
-                dcgmReturn = ProcessUnwatchFieldValue(*(dcgm_core_msg_unwatch_field_value_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_INJECT_FIELD_VALUE:
-                dcgmReturn = ProcessInjectFieldValue(*(dcgm_core_msg_inject_field_value_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_CACHE_MANAGER_FIELD_INFO:
-                dcgmReturn
-                    = ProcessGetCacheManagerFieldInfo(*(dcgm_core_msg_get_cache_manager_field_info_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_WATCH_FIELDS:
-                dcgmReturn = ProcessWatchFields(*(dcgm_core_msg_watch_fields_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_UNWATCH_FIELDS:
-                dcgmReturn = ProcessUnwatchFields(*(dcgm_core_msg_watch_fields_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_TOPOLOGY:
-                dcgmReturn = ProcessGetTopology(*(dcgm_core_msg_get_topology_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_TOPOLOGY_AFFINITY:
-                dcgmReturn = ProcessGetTopologyAffinity(*(dcgm_core_msg_get_topology_affinity_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_SELECT_TOPOLOGY_GPUS:
-                dcgmReturn = ProcessSelectGpusByTopology(*(dcgm_core_msg_select_topology_gpus_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_ALL_DEVICES:
-                dcgmReturn = ProcessGetAllDevices(*(dcgm_core_msg_get_all_devices_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_CLIENT_LOGIN:
-                dcgmReturn = ProcessClientLogin(*(dcgm_core_msg_client_login_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_SET_ENTITY_LINK_STATE:
-                dcgmReturn = ProcessSetEntityNvLinkState(*(dcgm_core_msg_set_entity_nvlink_state_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_NVLINK_STATUS:
-                dcgmReturn = ProcessGetNvLinkStatus(*(dcgm_core_msg_get_nvlink_status_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_FIELDGROUP_CREATE:
-            case DCGM_CORE_SR_FIELDGROUP_DESTROY:
-            case DCGM_CORE_SR_FIELDGROUP_GET_INFO:
-                dcgmReturn = ProcessFieldgroupOp(*(dcgm_core_msg_fieldgroup_op_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_FIELD_SUMMARY:
-                dcgmReturn = ProcessGetFieldSummary(*(dcgm_core_msg_get_field_summary_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_PID_GET_INFO:
-                dcgmReturn = ProcessPidGetInfo(*(dcgm_core_msg_pid_get_info_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_CREATE_FAKE_ENTITIES:
-                dcgmReturn = ProcessCreateFakeEntities(*(dcgm_core_msg_create_fake_entities_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_WATCH_PREDEFINED_FIELDS:
-                dcgmReturn = ProcessWatchPredefinedFields(*(dcgm_core_msg_watch_predefined_fields_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_MODULE_DENYLIST:
-                dcgmReturn = ProcessModuleDenylist(*(dcgm_core_msg_module_denylist_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_MODULE_STATUS:
-                dcgmReturn = ProcessModuleStatus(*(dcgm_core_msg_module_status_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_HOSTENGINE_HEALTH:
-                dcgmReturn = ProcessHostEngineHealth(*(dcgm_core_msg_hostengine_health_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_FIELDGROUP_GET_ALL:
-                dcgmReturn = ProcessFieldGroupGetAll(*(dcgm_core_msg_fieldgroup_get_all_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_GPU_INSTANCE_HIERARCHY:
-                dcgmReturn
-                    = ProcessGetGpuInstanceHierarchy(*(dcgm_core_msg_get_gpu_instance_hierarchy_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_PROF_GET_METRIC_GROUPS:
-                dcgmReturn = ProcessProfGetMetricGroups(*(dcgm_core_msg_get_metric_groups_t *)moduleCommand);
-                break;
-
-            case DCGM_CORE_SR_NVML_INJECT_FIELD_VALUE:
-                dcgmReturn = ProcessNvmlInjectFieldValue(*(dcgm_core_msg_nvml_inject_field_value_t *)moduleCommand);
-                break;
-
-            case DCGM_CORE_SR_NVML_CREATE_FAKE_ENTITY:
-                dcgmReturn = ProcessNvmlCreateFakeEntity(*(dcgm_core_msg_nvml_create_injection_gpu_t *)moduleCommand);
-                break;
-
-            case DCGM_CORE_SR_PAUSE_RESUME:
-                dcgmReturn = ProcessPauseResume(*(dcgm_core_msg_pause_resume_v1 *)moduleCommand);
-                break;
-
-            case DCGM_CORE_SR_GET_WORKLOAD_POWER_PROFILES_STATUS:
-                dcgmReturn = ProcessGetDeviceWorkloadPowerProfilesInfo(
-                    *(dcgm_core_msg_get_workload_power_profiles_status_v1 *)moduleCommand);
-                break;
 
-#ifdef INJECTION_LIBRARY_AVAILABLE
-            case DCGM_CORE_SR_NVML_INJECT_DEVICE:
-                dcgmReturn = ProcessNvmlInjectDevice(*(dcgm_core_msg_nvml_inject_device_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_NVML_INJECT_DEVICE_FOR_FOLLOWING_CALLS:
-                dcgmReturn = ProcessNvmlInjectDeviceForFollowingCalls(
-                    *(dcgm_core_msg_nvml_inject_device_for_following_calls_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_NVML_INJECTED_DEVICE_RESET:
-                dcgmReturn
-                    = ProcessNvmlInjectedDeviceReset(*(dcgm_core_msg_nvml_injected_device_reset_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_GET_NVML_INJECT_FUNC_CALL_COUNT:
-                dcgmReturn = ProcessGetNvmlInjectFuncCallCount(
-                    *(dcgm_core_msg_get_nvml_inject_func_call_count_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_RESET_NVML_FUNC_CALL_COUNT:
-                dcgmReturn = ProcessResetNvmlInjectFuncCallCount(
-                    *(dcgm_core_msg_reset_nvml_inject_func_call_count_t *)moduleCommand);
-                break;
-            case DCGM_CORE_SR_REMOVE_NVML_INJECTED_GPU:
-                dcgmReturn = ProcessRemoveNvmlInjectedGpu(
-                    *(reinterpret_cast<dcgm_core_msg_remove_restore_nvml_injected_gpu_t *>(moduleCommand)));
-                break;
-            case DCGM_CORE_SR_RESTORE_NVML_INJECTED_GPU:
-                dcgmReturn = ProcessRestoreNvmlInjectedGpu(
-                    *(reinterpret_cast<dcgm_core_msg_remove_restore_nvml_injected_gpu_t *>(moduleCommand)));
-                break;
-            case DCGM_CORE_SR_NVSWITCH_GET_BACKEND:
-                dcgmReturn = ProcessNvswitchGetBackend(
-                    *(reinterpret_cast<dcgm_core_msg_nvswitch_get_backend_v1 *>(moduleCommand)));
-                break;
-#endif
+    dcgmReturn_t dcgmReturn = c_commands.Dispatch(*this, moduleCommand);
 
-            default:
-                DCGM_LOG_DEBUG << "Unknown subcommand: " << static_cast<int>(moduleCommand->subCommand);
-                return DCGM_ST_FUNCTION_NOT_FOUND;
-        }
-    }
-
-    if (dcgmReturn != DCGM_ST_OK)
+    if (dcgmReturn != DCGM_ST_OK && dcgmReturn != DCGM_ST_FUNCTION_NOT_FOUND)
     {
         DCGM_LOG_ERROR << "Core module subcommand " << (int)moduleCommand->subCommand
                        << " returned: " << errorString(dcgmReturn);
@@ -290,12 +235,7 @@ void DcgmModuleCore::SetGroupManager(DcgmGroupManager *gm)
 
 dcgmReturn_t DcgmModuleCore::ProcessCreateGroup(dcgm_core_msg_create_group_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_create_group_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupId;
     dcgm_connection_id_t connectionId = msg.header.connectionId;
@@ -322,12 +262,7 @@ dcgmReturn_t DcgmModuleCore::ProcessCreateGroup(dcgm_core_msg_create_group_t &ms
 
 dcgmReturn_t DcgmModuleCore::ProcessAddRemoveEntity(dcgm_core_msg_add_remove_entity_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_add_remove_entity_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     dcgm_connection_id_t connectionId = msg.header.connectionId;
     if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
@@ -375,12 +310,7 @@ dcgmReturn_t DcgmModuleCore::ProcessAddRemoveEntity(dcgm_core_msg_add_remove_ent
 
 dcgmReturn_t DcgmModuleCore::ProcessGroupDestroy(dcgm_core_msg_group_destroy_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_group_destroy_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupId = msg.gd.groupId;
     ret                  = m_groupManager->verifyAndUpdateGroupId(&groupId);
@@ -415,12 +345,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGetEntityGroupEntities(dcgm_core_msg_get_ent
 {
     std::vector<dcgmGroupEntityPair_t> entities;
 
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_entity_group_entities_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     int onlySupported = (msg.entities.flags & DCGM_GEGE_FLAG_ONLY_SUPPORTED) ? 1 : 0;
 
@@ -455,12 +380,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGroupGetAllIds(dcgm_core_msg_group_get_all_i
 {
     std::vector<dcgmGroupEntityPair_t> entities;
 
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_group_get_all_ids_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupIdList[DCGM_MAX_NUM_GROUPS + 1];
     unsigned int count = 0;
@@ -495,12 +415,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGroupGetInfo(dcgm_core_msg_group_get_info_t
 {
     std::vector<dcgmGroupEntityPair_t> entities;
 
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_group_get_info_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupId = msg.gi.groupId;
 
@@ -556,13 +471,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGroupGetInfo(dcgm_core_msg_group_get_info_t
 
 dcgmReturn_t DcgmModuleCore::ProcessJobStartStats(dcgm_core_msg_job_cmd_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_job_cmd_version);
-
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupId = msg.jc.groupId;
     ret                  = m_groupManager->verifyAndUpdateGroupId(&groupId);
@@ -584,14 +493,6 @@ dcgmReturn_t DcgmModuleCore::ProcessJobStartStats(dcgm_core_msg_job_cmd_t &msg)
 
 dcgmReturn_t DcgmModuleCore::ProcessJobStopStats(dcgm_core_msg_job_cmd_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_job_cmd_version);
-
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     std::string jobName(msg.jc.jobId, sizeof(msg.jc.jobId));
 
     msg.jc.cmdRet = DcgmHostEngineHandler::Instance()->JobStopStats(jobName);
@@ -601,14 +502,6 @@ dcgmReturn_t DcgmModuleCore::ProcessJobStopStats(dcgm_core_msg_job_cmd_t &msg)
 
 dcgmReturn_t DcgmModuleCore::ProcessJobGetStats(dcgm_core_msg_job_get_stats_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_job_get_stats_version);
-
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     std::string jobName(msg.jc.jobId, sizeof(msg.jc.jobId));
 
     msg.jc.cmdRet = DcgmHostEngineHandler::Instance()->JobGetStats(jobName, &msg.jc.jobStats);
@@ -617,14 +510,6 @@ dcgmReturn_t DcgmModuleCore::ProcessJobGetStats(dcgm_core_msg_job_get_stats_t &m
 
 dcgmReturn_t DcgmModuleCore::ProcessJobRemove(dcgm_core_msg_job_cmd_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_job_cmd_version);
-
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     std::string jobName(msg.jc.jobId, sizeof(msg.jc.jobId));
 
     msg.jc.cmdRet = DcgmHostEngineHandler::Instance()->JobRemove(jobName);
@@ -634,39 +519,19 @@ dcgmReturn_t DcgmModuleCore::ProcessJobRemove(dcgm_core_msg_job_cmd_t &msg)
 
 dcgmReturn_t DcgmModuleCore::ProcessJobRemoveAll(dcgm_core_msg_job_cmd_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_job_cmd_version);
-
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     msg.jc.cmdRet = DcgmHostEngineHandler::Instance()->JobRemoveAll();
     return DCGM_ST_OK;
 }
 
 dcgmReturn_t DcgmModuleCore::ProcessHostengineVersion(dcgm_core_msg_hostengine_version_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_hostengine_version_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     GetVersionInfo(&msg.version);
     return DCGM_ST_OK;
 }
 
 dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV1(dcgm_core_msg_entities_get_latest_values_v1 &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_entities_get_latest_values_version1);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     /* initialize length of response to handle failure cases */
     msg.header.length = sizeof(dcgm_core_msg_entities_get_latest_values_v1) - SAMPLES_BUFFER_SIZE_V1;
@@ -788,12 +653,7 @@ dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV1(dcgm_core_msg_enti
 
 dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV2(dcgm_core_msg_entities_get_latest_values_v2 &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_entities_get_latest_values_version2);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     /* initialize length of response to handle failure cases */
     msg.header.length = sizeof(dcgm_core_msg_entities_get_latest_values_v2) - SAMPLES_BUFFER_SIZE_V2;
@@ -921,12 +781,7 @@ dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV2(dcgm_core_msg_enti
 
 dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV3(dcgm_core_msg_entities_get_latest_values_v3 &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_entities_get_latest_values_version3);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     /* initialize length of response to handle failure cases */
     msg.header.length = sizeof(dcgm_core_msg_entities_get_latest_values_v3) - SAMPLES_BUFFER_SIZE_V2;
@@ -1032,6 +887,14 @@ dcgmReturn_t DcgmModuleCore::ProcessEntitiesGetLatestValuesV3(dcgm_core_msg_enti
         return DCGM_ST_OK;
     }
 
+    /* Send columns instead if the client can read them. Fall back to the fvBuffer if they can't hold its values */
+    std::vector<char> columns;
+    if ((msg.ev.flags & DCGM_FV_FLAG_COLUMNAR_RESPONSE) != 0 && DcgmFvColumns::Encode(fvBuffer, columns) == DCGM_ST_OK)
+    {
+        fvBufferBytes     = columns.data();
+        msg.ev.bufferSize = columns.size();
+    }
+
     if (msg.ev.bufferSize > sizeof(msg.ev.buffer))
     {
         DCGM_LOG_ERROR << "Buffer size too small, consider smaller request: " << msg.ev.bufferSize << ">"
@@ -1066,13 +929,6 @@ dcgmReturn_t DcgmModuleCore::ProcessGetMultipleValuesForFieldV1(dcgm_core_msg_ge
     dcgmOrder_t order;
     DcgmFvBuffer fvBuffer(0);
 
-    ret = CheckVersion(&msg.header, dcgm_core_msg_get_multiple_values_for_field_version1);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     /* initialize length of response to handle failure cases */
     msg.header.length = sizeof(dcgm_core_msg_get_multiple_values_for_field_v1) - SAMPLES_BUFFER_SIZE_V1;
 
@@ -1172,13 +1028,6 @@ dcgmReturn_t DcgmModuleCore::ProcessGetMultipleValuesForFieldV2(dcgm_core_msg_ge
     dcgmOrder_t order;
     DcgmFvBuffer fvBuffer(0);
 
-    ret = CheckVersion(&msg.header, dcgm_core_msg_get_multiple_values_for_field_version2);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     /* initialize length of response to handle failure cases */
     msg.header.length = sizeof(dcgm_core_msg_get_multiple_values_for_field_v2) - SAMPLES_BUFFER_SIZE_V2;
 
@@ -1267,13 +1116,6 @@ dcgmReturn_t DcgmModuleCore::ProcessGetMultipleValuesForFieldV2(dcgm_core_msg_ge
 
 dcgmReturn_t DcgmModuleCore::ProcessWatchFieldValueV1(dcgm_core_msg_watch_field_value_v1 &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_watch_field_value_version1);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     dcgm_connection_id_t connectionId = msg.header.connectionId;
     if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
     {
@@ -1299,13 +1141,6 @@ dcgmReturn_t DcgmModuleCore::ProcessWatchFieldValueV1(dcgm_core_msg_watch_field_
 
 dcgmReturn_t DcgmModuleCore::ProcessWatchFieldValueV2(dcgm_core_msg_watch_field_value_v2 &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_watch_field_value_version2);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     dcgm_connection_id_t connectionId = msg.header.connectionId;
     if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
     {
@@ -1333,27 +1168,103 @@ dcgmReturn_t DcgmModuleCore::ProcessWatchFieldValueV2(dcgm_core_msg_watch_field_
 
 dcgmReturn_t DcgmModuleCore::ProcessUpdateAllFields(dcgm_core_msg_update_all_fields_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_update_all_fields_version);
+    msg.uf.cmdRet = m_cacheManager->UpdateAllFields(msg.uf.waitForUpdate);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessUpdateFields(dcgm_core_msg_update_fields_t &msg)
+{
+    unsigned int groupId = msg.uf.groupId;
+    /* Verify group id is valid */
+    dcgmReturn_t ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
     if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
+        msg.uf.cmdRet = ret;
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return DCGM_ST_OK;
     }
 
-    msg.uf.cmdRet = m_cacheManager->UpdateAllFields(msg.uf.waitForUpdate);
+    msg.uf.cmdRet = DcgmHostEngineHandler::Instance()->UpdateFieldGroup(
+        groupId, (dcgmFieldGrp_t)msg.uf.fieldGroupId, msg.uf.waitForUpdate);
 
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessUnwatchFieldValue(dcgm_core_msg_unwatch_field_value_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessSnapshotFields(dcgm_core_msg_snapshot_fields_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_unwatch_field_value_version);
+    unsigned int groupId = msg.sf.groupId;
+    /* Verify group id is valid */
+    dcgmReturn_t ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
     if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
+        msg.sf.cmdRet = ret;
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return DCGM_ST_OK;
+    }
+
+    timelib64_t snapshotId = 0;
+    msg.sf.cmdRet = DcgmHostEngineHandler::Instance()->SnapshotFieldGroup(
+        groupId, (dcgmFieldGrp_t)msg.sf.fieldGroupId, snapshotId);
+    msg.sf.snapshotId = snapshotId;
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessResampleValues(dcgm_core_msg_resample_values_t &msg)
+{
+    /* initialize length of response to handle failure cases */
+    msg.header.length = sizeof(msg) - sizeof(msg.rv.values);
+    msg.rv.numColumns = 0;
+
+    unsigned int groupId = msg.rv.groupId;
+    /* Verify group id is valid */
+    dcgmReturn_t ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (DCGM_ST_OK != ret)
+    {
+        msg.rv.cmdRet = ret;
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return DCGM_ST_OK;
     }
 
+    if (msg.rv.stepUsec <= 0 || msg.rv.fill > DCGM_RESAMPLE_FILL_LINEAR)
+    {
+        DCGM_LOG_ERROR << "Bad stepUsec " << msg.rv.stepUsec << " or fill " << msg.rv.fill;
+        msg.rv.cmdRet = DCGM_ST_BADPARAM;
+        return DCGM_ST_OK;
+    }
+
+    std::vector<dcgm_entity_key_t> columns;
+    msg.rv.cmdRet = DcgmHostEngineHandler::Instance()->ResampleFieldGroup(groupId,
+                                                                          (dcgmFieldGrp_t)msg.rv.fieldGroupId,
+                                                                          msg.rv.startTime,
+                                                                          msg.rv.stepUsec,
+                                                                          (dcgmResampleFill_t)msg.rv.fill,
+                                                                          msg.rv.numRows,
+                                                                          columns,
+                                                                          msg.rv.values,
+                                                                          DCGM_RESAMPLE_BUFFER_VALUES);
+    msg.rv.numColumns = (unsigned int)columns.size();
+    if (msg.rv.cmdRet != DCGM_ST_OK)
+    {
+        return DCGM_ST_OK;
+    }
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        msg.rv.columns[i].entityGroupId = columns[i].entityGroupId;
+        msg.rv.columns[i].entityId      = columns[i].entityId;
+        msg.rv.columns[i].fieldId       = columns[i].fieldId;
+    }
+
+    /* calculate actual message size to avoid transferring extra data */
+    msg.header.length += sizeof(double) * msg.rv.numRows * msg.rv.numColumns;
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessUnwatchFieldValue(dcgm_core_msg_unwatch_field_value_t &msg)
+{
     dcgm_connection_id_t connectionId = msg.header.connectionId;
     if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
     {
@@ -1370,13 +1281,6 @@ dcgmReturn_t DcgmModuleCore::ProcessUnwatchFieldValue(dcgm_core_msg_unwatch_fiel
 
 dcgmReturn_t DcgmModuleCore::ProcessInjectFieldValue(dcgm_core_msg_inject_field_value_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_inject_field_value_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     dcgm_field_entity_group_t entityGroupId = (dcgm_field_entity_group_t)msg.iv.entityGroupId;
     dcgm_field_eid_t entityId               = msg.iv.entityId;
     dcgmcm_sample_t sample                  = {};
@@ -1457,15 +1361,38 @@ dcgmReturn_t DcgmModuleCore::ProcessInjectFieldValue(dcgm_core_msg_inject_field_
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessGetCacheManagerFieldInfo(dcgm_core_msg_get_cache_manager_field_info_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessInjectFieldValues(dcgm_core_msg_inject_field_values_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_cache_manager_field_info_version2);
+    /* The request is truncated to the values it carries. The command table checked that it has all of the header */
+    size_t const headerSize = sizeof(msg) - sizeof(msg.iv.buffer);
+
+    if (msg.iv.bufferSize > sizeof(msg.iv.buffer) || headerSize + msg.iv.bufferSize > msg.header.length)
+    {
+        DCGM_LOG_ERROR << "Bad bufferSize " << msg.iv.bufferSize << " for a request of " << msg.header.length
+                       << " bytes";
+        return DCGM_ST_BADPARAM;
+    }
+
+    DcgmFvBuffer fvBuffer(0);
+    dcgmReturn_t ret = fvBuffer.SetFromBuffer(msg.iv.buffer, msg.iv.bufferSize);
+
+    /* Only respond with the status */
+    msg.header.length = headerSize;
+
     if (ret != DCGM_ST_OK)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
+        DCGM_LOG_ERROR << "Got " << ret << " from fvBuffer.SetFromBuffer()";
+        msg.iv.cmdRet = ret;
+        return DCGM_ST_OK;
     }
 
+    msg.iv.cmdRet = m_cacheManager->InjectSamples(&fvBuffer);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetCacheManagerFieldInfo(dcgm_core_msg_get_cache_manager_field_info_t &msg)
+{
     msg.fi.cmdRet = m_cacheManager->GetCacheManagerFieldInfo(&msg.fi.fieldInfo);
 
     return DCGM_ST_OK;
@@ -1473,12 +1400,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGetCacheManagerFieldInfo(dcgm_core_msg_get_c
 
 dcgmReturn_t DcgmModuleCore::ProcessWatchFields(dcgm_core_msg_watch_fields_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_watch_fields_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupId = msg.watchInfo.groupId;
     /* Verify group id is valid */
@@ -1510,12 +1432,7 @@ dcgmReturn_t DcgmModuleCore::ProcessWatchFields(dcgm_core_msg_watch_fields_t &ms
 
 dcgmReturn_t DcgmModuleCore::ProcessUnwatchFields(dcgm_core_msg_watch_fields_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_watch_fields_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     unsigned int groupId = msg.watchInfo.groupId;
     /* Verify group id is valid */
@@ -1541,69 +1458,161 @@ dcgmReturn_t DcgmModuleCore::ProcessUnwatchFields(dcgm_core_msg_watch_fields_t &
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessGetGpuStatus(dcgm_core_msg_get_gpu_status_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessMetadataSubscribe(dcgm_core_msg_metadata_subscribe_t &msg)
 {
-    if (m_cacheManager == nullptr)
+    msg.cmdRet = DcgmHostEngineHandler::Instance()->SubscribeMetadata(
+        msg.header.connectionId, msg.header.requestId, msg.generation);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleCore::ProcessRequestCancelSupport(dcgm_core_msg_request_cancel_support_t &msg)
+{
+    /* DcgmIpc handles DCGM_MSG_REQUEST_CANCEL before it reaches any module */
+    msg.cmdRet = DCGM_ST_OK;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleCore::ProcessSubscribeFields(dcgm_core_msg_watch_fields_t &msg)
+{
+    dcgmReturn_t ret;
+
+    unsigned int groupId = msg.watchInfo.groupId;
+    /* Verify group id is valid */
+    ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "m_cacheManager not initialized.";
-        return DCGM_ST_UNINITIALIZED;
+        msg.watchInfo.cmdRet = ret;
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        if (msg.header.connectionId != DCGM_CONNECTION_ID_NONE)
+        {
+            /* The client won't get any notifications for this request */
+            DcgmHostEngineHandler::Instance()->NotifyRequestOfCompletion(msg.header.connectionId,
+                                                                         msg.header.requestId);
+        }
+        return DCGM_ST_OK;
     }
 
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_gpu_status_version);
-    if (ret != DCGM_ST_OK)
+    msg.watchInfo.cmdRet = DcgmHostEngineHandler::Instance()->SubscribeFieldGroup(msg.header.connectionId,
+                                                                                  msg.header.requestId,
+                                                                                  groupId,
+                                                                                  msg.watchInfo.fieldGroupId,
+                                                                                  msg.watchInfo.updateFreq,
+                                                                                  msg.watchInfo.maxKeepAge,
+                                                                                  msg.watchInfo.maxKeepSamples);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessUnsubscribeFields(dcgm_core_msg_watch_fields_t &msg)
+{
+    dcgmReturn_t ret;
+
+    unsigned int groupId = msg.watchInfo.groupId;
+    /* Verify group id is valid */
+    ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
+        msg.watchInfo.cmdRet = ret;
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return DCGM_ST_OK;
     }
 
-    msg.status = m_cacheManager->GetGpuStatus(msg.gpuId);
+    msg.watchInfo.cmdRet = DcgmHostEngineHandler::Instance()->UnsubscribeFieldGroup(
+        msg.header.connectionId, groupId, msg.watchInfo.fieldGroupId);
+
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessGetTopology(dcgm_core_msg_get_topology_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessValuesCursorOpen(dcgm_core_msg_values_cursor_t &msg)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_get_topology_version);
+    dcgmReturn_t ret;
+
+    /* Only NEXT responds with the buffer */
+    msg.header.length = sizeof(msg) - sizeof(msg.vc.buffer);
 
-    if (dcgmReturn != DCGM_ST_OK)
+    unsigned int groupId = msg.vc.groupId;
+    /* Verify group id is valid */
+    ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn;
+        msg.vc.cmdRet = ret;
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return DCGM_ST_OK;
     }
 
-    unsigned int groupId = msg.topo.groupId;
-
-    msg.topo.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetTopologyIO(groupId, msg.topo.topology);
+    msg.vc.cmdRet = DcgmHostEngineHandler::Instance()->OpenValuesCursor(
+        msg.header.connectionId, groupId, msg.vc.fieldGroupId, msg.vc.sinceTimestamp, msg.vc.cursorId);
 
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessGetTopologyAffinity(dcgm_core_msg_get_topology_affinity_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessValuesCursorNext(dcgm_core_msg_values_cursor_t &msg)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_get_topology_affinity_version);
+    /* initialize length of response to handle failure cases */
+    msg.header.length = sizeof(msg) - sizeof(msg.vc.buffer);
+    msg.vc.bufferSize = 0;
 
-    if (dcgmReturn != DCGM_ST_OK)
+    dcgm_values_cursor_chunk_t chunk;
+    msg.vc.cmdRet = DcgmHostEngineHandler::Instance()->NextValuesCursor(
+        msg.header.connectionId, msg.vc.cursorId, sizeof(msg.vc.buffer), chunk);
+    if (msg.vc.cmdRet != DCGM_ST_OK)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn;
+        return DCGM_ST_OK;
     }
 
-    unsigned int groupId = msg.affinity.groupId;
+    memcpy(msg.vc.buffer, chunk.fvBytes.data(), chunk.fvBytes.size());
+    msg.vc.bufferSize         = chunk.fvBytes.size();
+    msg.vc.done               = chunk.done ? 1 : 0;
+    msg.vc.nextSinceTimestamp = chunk.nextSinceTimestamp;
 
-    msg.affinity.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetTopologyAffinity(groupId, msg.affinity.affinity);
+    /* calculate actual message size to avoid transferring extra data */
+    msg.header.length = sizeof(msg) - sizeof(msg.vc.buffer) + msg.vc.bufferSize;
 
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessSelectGpusByTopology(dcgm_core_msg_select_topology_gpus_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessValuesCursorClose(dcgm_core_msg_values_cursor_t &msg)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_select_topology_gpus_version);
+    msg.header.length = sizeof(msg) - sizeof(msg.vc.buffer);
+    msg.vc.cmdRet = DcgmHostEngineHandler::Instance()->CloseValuesCursor(msg.header.connectionId, msg.vc.cursorId);
 
-    if (dcgmReturn != DCGM_ST_OK)
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetGpuStatus(dcgm_core_msg_get_gpu_status_t &msg)
+{
+    if (m_cacheManager == nullptr)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn;
+        DCGM_LOG_ERROR << "m_cacheManager not initialized.";
+        return DCGM_ST_UNINITIALIZED;
     }
 
+    msg.status = m_cacheManager->GetGpuStatus(msg.gpuId);
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetTopology(dcgm_core_msg_get_topology_t &msg)
+{
+    unsigned int groupId = msg.topo.groupId;
+
+    msg.topo.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetTopologyIO(groupId, msg.topo.topology);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessGetTopologyAffinity(dcgm_core_msg_get_topology_affinity_t &msg)
+{
+    unsigned int groupId = msg.affinity.groupId;
+
+    msg.affinity.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetTopologyAffinity(groupId, msg.affinity.affinity);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessSelectGpusByTopology(dcgm_core_msg_select_topology_gpus_t &msg)
+{
     msg.sgt.cmdRet = DcgmHostEngineHandler::Instance()->HelperSelectGpusByTopology(
         msg.sgt.numGpus, msg.sgt.inputGpus, msg.sgt.flags, msg.sgt.outputGpus);
 
@@ -1613,14 +1622,6 @@ dcgmReturn_t DcgmModuleCore::ProcessSelectGpusByTopology(dcgm_core_msg_select_to
 dcgmReturn_t DcgmModuleCore::ProcessGetAllDevices(dcgm_core_msg_get_all_devices_t &msg)
 {
     unsigned int index;
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_get_all_devices_version);
-
-    if (dcgmReturn != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn;
-    }
-
     std::vector<unsigned int> gpuIds;
 
     msg.dev.cmdRet = (dcgmReturn_t)m_cacheManager->GetGpuIds(msg.dev.supported, gpuIds);
@@ -1637,14 +1638,6 @@ dcgmReturn_t DcgmModuleCore::ProcessGetAllDevices(dcgm_core_msg_get_all_devices_
 
 dcgmReturn_t DcgmModuleCore::ProcessClientLogin(dcgm_core_msg_client_login_t &msg)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_client_login_version);
-
-    if (dcgmReturn != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn;
-    }
-
     unsigned int connectionId = msg.header.connectionId;
 
     if (msg.info.persistAfterDisconnect)
@@ -1665,13 +1658,7 @@ dcgmReturn_t DcgmModuleCore::ProcessClientLogin(dcgm_core_msg_client_login_t &ms
 
 dcgmReturn_t DcgmModuleCore::ProcessSetEntityNvLinkState(dcgm_core_msg_set_entity_nvlink_state_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_set_entity_nvlink_state_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     if (msg.state.version != dcgmSetNvLinkLinkState_version1)
     {
@@ -1707,14 +1694,6 @@ dcgmReturn_t DcgmModuleCore::ProcessSetEntityNvLinkState(dcgm_core_msg_set_entit
 dcgmReturn_t DcgmModuleCore::ProcessGetDeviceWorkloadPowerProfilesInfo(
     dcgm_core_msg_get_workload_power_profiles_status_v1 &msg)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_get_workload_power_profiles_status_version);
-
-    if (dcgmReturn != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn;
-    }
-
     msg.cmdRet
         = m_cacheManager->GetWorkloadPowerProfilesInfo(msg.pp.gpuId, &msg.pp.profilesInfo, &msg.pp.profilesStatus);
 
@@ -1723,13 +1702,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGetDeviceWorkloadPowerProfilesInfo(
 
 dcgmReturn_t DcgmModuleCore::ProcessGetNvLinkStatus(dcgm_core_msg_get_nvlink_status_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_nvlink_status_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret;
 
     if (msg.info.ls.version != dcgmNvLinkStatus_version4)
     {
@@ -1740,6 +1713,14 @@ dcgmReturn_t DcgmModuleCore::ProcessGetNvLinkStatus(dcgm_core_msg_get_nvlink_sta
 
     ret = m_cacheManager->PopulateNvLinkLinkStatus(msg.info.ls);
 
+    /* Once the NvSwitch module has reported its link states, it pushes every change to the cache manager and they
+       are part of the snapshot above. Until then, ask it directly. This also loads the module */
+    if (std::optional<dcgmReturn_t> const nvSwitchRet = m_cacheManager->GetNvSwitchLinkStatusRet())
+    {
+        msg.info.cmdRet = *nvSwitchRet;
+        return DCGM_ST_OK;
+    }
+
     dcgm_nvswitch_msg_get_all_link_states_t nvsMsg {};
     nvsMsg.header.length     = sizeof(nvsMsg);
     nvsMsg.header.moduleId   = DcgmModuleIdNvSwitch;
@@ -1750,6 +1731,8 @@ dcgmReturn_t DcgmModuleCore::ProcessGetNvLinkStatus(dcgm_core_msg_get_nvlink_sta
     if (cmdRet == DCGM_ST_MODULE_NOT_LOADED)
     {
         DCGM_LOG_WARNING << "Not populating NvSwitches since the module couldn't be loaded.";
+        /* The module won't be loaded later either. Remember that instead of asking again */
+        m_cacheManager->SetNvSwitchLinkStatus(cmdRet, 0, nullptr);
     }
     else if (cmdRet != DCGM_ST_OK)
     {
@@ -1767,13 +1750,7 @@ dcgmReturn_t DcgmModuleCore::ProcessGetNvLinkStatus(dcgm_core_msg_get_nvlink_sta
 
 dcgmReturn_t DcgmModuleCore::ProcessFieldgroupOp(dcgm_core_msg_fieldgroup_op_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_fieldgroup_op_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    dcgmReturn_t ret = DCGM_ST_OK;
 
     if (msg.info.fg.version != dcgmFieldGroupInfo_version)
     {
@@ -1825,14 +1802,6 @@ dcgmReturn_t DcgmModuleCore::ProcessFieldgroupOp(dcgm_core_msg_fieldgroup_op_t &
 
 dcgmReturn_t DcgmModuleCore::ProcessPidGetInfo(dcgm_core_msg_pid_get_info_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_pid_get_info_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     if (msg.info.pidInfo.version != dcgmPidInfo_version)
     {
         log_error("PidGetInfo version mismatch {} != {}", msg.info.pidInfo.version, dcgmPidInfo_version);
@@ -1850,14 +1819,6 @@ dcgmReturn_t DcgmModuleCore::ProcessPidGetInfo(dcgm_core_msg_pid_get_info_t &msg
 
 dcgmReturn_t DcgmModuleCore::ProcessGetFieldSummary(dcgm_core_msg_get_field_summary_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_field_summary_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     if (msg.info.fsr.version != dcgmFieldSummaryRequest_version1)
     {
         log_error("dcgmFieldSummaryRequest version mismatch {} != {}",
@@ -1868,21 +1829,45 @@ dcgmReturn_t DcgmModuleCore::ProcessGetFieldSummary(dcgm_core_msg_get_field_summ
         return DCGM_ST_OK;
     }
 
-    msg.info.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetFieldSummary(msg.info.fsr);
+    /* Answer it as a v2 request without the summaries that v1 has no room for */
+    dcgmFieldSummaryRequest_v2 fsr {};
+    fsr.version         = dcgmFieldSummaryRequest_version2;
+    fsr.fieldId         = msg.info.fsr.fieldId;
+    fsr.entityGroupId   = msg.info.fsr.entityGroupId;
+    fsr.entityId        = msg.info.fsr.entityId;
+    fsr.summaryTypeMask = msg.info.fsr.summaryTypeMask & ((1 << DCGM_SUMMARY_SIZE) - 1);
+    fsr.startTime       = msg.info.fsr.startTime;
+    fsr.endTime         = msg.info.fsr.endTime;
+
+    msg.info.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetFieldSummary(fsr);
+
+    msg.info.fsr.response.fieldType    = fsr.response.fieldType;
+    msg.info.fsr.response.summaryCount = fsr.response.summaryCount;
+    /* The values are laid out the same. v1 just has fewer of them */
+    memcpy(msg.info.fsr.response.values, fsr.response.values, sizeof(msg.info.fsr.response.values));
 
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessCreateFakeEntities(dcgm_core_msg_create_fake_entities_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessGetFieldSummaryV2(dcgm_core_msg_get_field_summary_v2 &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_create_fake_entities_version);
-
-    if (ret != DCGM_ST_OK)
+    if (msg.info.fsr.version != dcgmFieldSummaryRequest_version2)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
+        log_error("dcgmFieldSummaryRequest version mismatch {} != {}",
+                  msg.info.fsr.version,
+                  dcgmFieldSummaryRequest_version2);
+
+        msg.info.cmdRet = DCGM_ST_VER_MISMATCH;
+        return DCGM_ST_OK;
     }
 
+    msg.info.cmdRet = DcgmHostEngineHandler::Instance()->HelperGetFieldSummary(msg.info.fsr);
+
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessCreateFakeEntities(dcgm_core_msg_create_fake_entities_t &msg)
+{
     if (msg.info.fe.version != dcgmCreateFakeEntities_version)
     {
         log_error(
@@ -1899,14 +1884,6 @@ dcgmReturn_t DcgmModuleCore::ProcessCreateFakeEntities(dcgm_core_msg_create_fake
 
 dcgmReturn_t DcgmModuleCore::ProcessWatchPredefinedFields(dcgm_core_msg_watch_predefined_fields_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_watch_predefined_fields_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     dcgm_connection_id_t connectionId = msg.header.connectionId;
     if (DcgmHostEngineHandler::Instance()->GetPersistAfterDisconnect(msg.header.connectionId))
     {
@@ -1922,14 +1899,6 @@ dcgmReturn_t DcgmModuleCore::ProcessWatchPredefinedFields(dcgm_core_msg_watch_pr
 
 dcgmReturn_t DcgmModuleCore::ProcessModuleDenylist(dcgm_core_msg_module_denylist_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_module_denylist_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     msg.bl.cmdRet = DcgmHostEngineHandler::Instance()->HelperModuleDenylist((dcgmModuleId_t)msg.bl.moduleId);
 
     return DCGM_ST_OK;
@@ -1937,14 +1906,13 @@ dcgmReturn_t DcgmModuleCore::ProcessModuleDenylist(dcgm_core_msg_module_denylist
 
 dcgmReturn_t DcgmModuleCore::ProcessModuleStatus(dcgm_core_msg_module_status_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_module_status_version);
+    msg.info.cmdRet = DcgmHostEngineHandler::Instance()->HelperModuleStatus(msg.info.st);
 
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
+    return DCGM_ST_OK;
+}
 
+dcgmReturn_t DcgmModuleCore::ProcessModuleStatusV2(dcgm_core_msg_module_status_v2 &msg)
+{
     msg.info.cmdRet = DcgmHostEngineHandler::Instance()->HelperModuleStatus(msg.info.st);
 
     return DCGM_ST_OK;
@@ -1952,14 +1920,6 @@ dcgmReturn_t DcgmModuleCore::ProcessModuleStatus(dcgm_core_msg_module_status_t &
 
 dcgmReturn_t DcgmModuleCore::ProcessHostEngineHealth(dcgm_core_msg_hostengine_health_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_hostengine_health_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     msg.info.overallHealth = DcgmHostEngineHandler::Instance()->GetHostEngineHealth();
     msg.info.cmdRet        = DCGM_ST_OK;
 
@@ -1968,14 +1928,6 @@ dcgmReturn_t DcgmModuleCore::ProcessHostEngineHealth(dcgm_core_msg_hostengine_he
 
 dcgmReturn_t DcgmModuleCore::ProcessFieldGroupGetAll(dcgm_core_msg_fieldgroup_get_all_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_fieldgroup_get_all_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     if (msg.info.fg.version != dcgmAllFieldGroup_version)
     {
         DCGM_LOG_ERROR << "Struct version mismatch";
@@ -1992,14 +1944,6 @@ dcgmReturn_t DcgmModuleCore::ProcessFieldGroupGetAll(dcgm_core_msg_fieldgroup_ge
 
 dcgmReturn_t DcgmModuleCore::ProcessGetGpuInstanceHierarchy(dcgm_core_msg_get_gpu_instance_hierarchy_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_gpu_instance_hierarchy_version);
-
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     if (msg.info.data.version != dcgmMigHierarchy_version2)
     {
         DCGM_LOG_ERROR << "Struct version2 mismatch";
@@ -2012,15 +1956,25 @@ dcgmReturn_t DcgmModuleCore::ProcessGetGpuInstanceHierarchy(dcgm_core_msg_get_gp
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmModuleCore::ProcessProfGetMetricGroups(dcgm_core_msg_get_metric_groups_t &msg)
+dcgmReturn_t DcgmModuleCore::ProcessProfGetMultiplexInfo(dcgm_core_msg_prof_multiplex_info_t &msg)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_get_metric_groups_version);
-    if (dcgmReturn != DCGM_ST_OK)
+    unsigned int groupId = (unsigned int)msg.multiplexInfo.groupId;
+    /* Verify group id is valid */
+    dcgmReturn_t ret = m_groupManager->verifyAndUpdateGroupId(&groupId);
+    if (DCGM_ST_OK != ret)
     {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn; /* Logging handled by caller (DcgmModuleCore::ProcessMessage) */
+        DCGM_LOG_ERROR << "Error: Bad group id parameter";
+        return ret;
     }
 
+    DcgmHostEngineHandler::Instance()->GetProfMultiplexInfo(groupId, msg.multiplexInfo);
+    return DCGM_ST_OK;
+}
+
+dcgmReturn_t DcgmModuleCore::ProcessProfGetMetricGroups(dcgm_core_msg_get_metric_groups_t &msg)
+{
+    dcgmReturn_t dcgmReturn;
+
     dcgmGroupEntityPair_t entityPair;
     entityPair.entityId      = msg.metricGroups.gpuId;
     entityPair.entityGroupId = DCGM_FE_GPU;
@@ -2080,13 +2034,6 @@ dcgmReturn_t DcgmModuleCore::ProcessProfGetMetricGroups(dcgm_core_msg_get_metric
 
 dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectFieldValue(dcgm_core_msg_nvml_inject_field_value_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_nvml_inject_field_value_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     auto hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     // If the injection library isn't loaded and active, return unsupported here.
@@ -2147,13 +2094,6 @@ dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectFieldValue(dcgm_core_msg_nvml_inje
 #ifdef INJECTION_LIBRARY_AVAILABLE
 dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectDevice(dcgm_core_msg_nvml_inject_device_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_nvml_inject_device_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2208,13 +2148,6 @@ dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectDevice(dcgm_core_msg_nvml_inject_d
 dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectDeviceForFollowingCalls(
     dcgm_core_msg_nvml_inject_device_for_following_calls_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_nvml_inject_device_for_following_calls_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2275,13 +2208,6 @@ dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectDeviceForFollowingCalls(
 
 dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectedDeviceReset(dcgm_core_msg_nvml_injected_device_reset_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_nvml_injected_device_reset_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2305,13 +2231,6 @@ dcgmReturn_t DcgmModuleCore::ProcessNvmlInjectedDeviceReset(dcgm_core_msg_nvml_i
 
 dcgmReturn_t DcgmModuleCore::ProcessGetNvmlInjectFuncCallCount(dcgm_core_msg_get_nvml_inject_func_call_count_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_get_nvml_inject_func_call_count_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2327,13 +2246,6 @@ dcgmReturn_t DcgmModuleCore::ProcessGetNvmlInjectFuncCallCount(dcgm_core_msg_get
 
 dcgmReturn_t DcgmModuleCore::ProcessResetNvmlInjectFuncCallCount(dcgm_core_msg_reset_nvml_inject_func_call_count_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_reset_nvml_inject_func_call_count_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2349,13 +2261,6 @@ dcgmReturn_t DcgmModuleCore::ProcessResetNvmlInjectFuncCallCount(dcgm_core_msg_r
 
 dcgmReturn_t DcgmModuleCore::ProcessRemoveNvmlInjectedGpu(dcgm_core_msg_remove_restore_nvml_injected_gpu_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_remove_restore_nvml_injected_gpu_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2371,13 +2276,6 @@ dcgmReturn_t DcgmModuleCore::ProcessRemoveNvmlInjectedGpu(dcgm_core_msg_remove_r
 
 dcgmReturn_t DcgmModuleCore::ProcessRestoreNvmlInjectedGpu(dcgm_core_msg_remove_restore_nvml_injected_gpu_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_remove_restore_nvml_injected_gpu_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     DcgmHostEngineHandler *hostEngineHandler = DcgmHostEngineHandler::Instance();
 
     if (!hostEngineHandler->UsingInjectionNvml())
@@ -2394,13 +2292,6 @@ dcgmReturn_t DcgmModuleCore::ProcessRestoreNvmlInjectedGpu(dcgm_core_msg_remove_
 
 dcgmReturn_t DcgmModuleCore::ProcessNvmlCreateFakeEntity(dcgm_core_msg_nvml_create_injection_gpu_t &msg)
 {
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_nvml_create_injection_gpu_version);
-    if (DCGM_ST_OK != ret)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     if (!DcgmHostEngineHandler::Instance()->UsingInjectionNvml())
     {
         DCGM_LOG_ERROR << "Cannot create injection NVML device because we are using live NVML. "
@@ -2421,15 +2312,6 @@ dcgmReturn_t DcgmModuleCore::ProcessSetLoggingSeverity(dcgm_core_msg_set_severit
     dcgmReturn_t dcgmReturn                   = DCGM_ST_OK;
     dcgmSettingsSetLoggingSeverity_t &logging = msg.logging;
 
-
-    dcgmReturn = CheckVersion(&msg.header, dcgm_core_msg_set_severity_version);
-
-    if (dcgmReturn != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return dcgmReturn; /* Logging handled by caller (DcgmModuleCore::ProcessMessage) */
-    }
-
     std::unique_lock<std::mutex> loggingSeverityLock = LoggerLockSeverity();
 
     switch (logging.targetLogger)
@@ -2469,13 +2351,6 @@ dcgmReturn_t DcgmModuleCore::ProcessCreateMigEntity(dcgm_core_msg_create_mig_ent
         return DCGM_ST_UNINITIALIZED;
     }
 
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_create_mig_entity_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     return m_cacheManager->CreateMigEntity(msg.cme);
 }
 
@@ -2488,13 +2363,6 @@ dcgmReturn_t DcgmModuleCore::ProcessDeleteMigEntity(dcgm_core_msg_delete_mig_ent
         return DCGM_ST_UNINITIALIZED;
     }
 
-    dcgmReturn_t ret = CheckVersion(&msg.header, dcgm_core_msg_delete_mig_entity_version);
-    if (ret != DCGM_ST_OK)
-    {
-        DCGM_LOG_ERROR << "Version mismatch";
-        return ret;
-    }
-
     return m_cacheManager->DeleteMigEntity(msg.dme);
 }
 
@@ -2510,22 +2378,11 @@ dcgmReturn_t DcgmModuleCore::ProcessPauseResume(dcgm_core_msg_pause_resume_v1 &m
         log_error("m_cacheManager not initialized");
         return DCGM_ST_UNINITIALIZED;
     }
-    if (auto const ret = CheckVersion(&msg.header, dcgm_core_msg_pause_resume_version1); ret != DCGM_ST_OK)
-    {
-        log_error("Version mismatch");
-        return ret;
-    }
     return msg.pause ? m_cacheManager->Pause() : m_cacheManager->Resume();
 }
 
 dcgmReturn_t DcgmModuleCore::ProcessNvswitchGetBackend(dcgm_core_msg_nvswitch_get_backend_v1 &msg)
 {
-    if (auto const ret = CheckVersion(&msg.header, dcgm_core_msg_nvswitch_get_backend_version1); ret != DCGM_ST_OK)
-    {
-        log_error("Version mismatch");
-        return ret;
-    }
-
     dcgm_nvswitch_msg_get_backend_t nvsMsg = {};
     nvsMsg.header.length                   = sizeof(msg);
     nvsMsg.header.moduleId                 = DcgmModuleIdNvSwitch;
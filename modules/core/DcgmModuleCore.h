@@ -58,11 +58,22 @@ public:
     dcgmReturn_t ProcessWatchFieldValueV1(dcgm_core_msg_watch_field_value_v1 &msg);
     dcgmReturn_t ProcessWatchFieldValueV2(dcgm_core_msg_watch_field_value_v2 &msg);
     dcgmReturn_t ProcessUpdateAllFields(dcgm_core_msg_update_all_fields_t &msg);
+    dcgmReturn_t ProcessUpdateFields(dcgm_core_msg_update_fields_t &msg);
+    dcgmReturn_t ProcessSnapshotFields(dcgm_core_msg_snapshot_fields_t &msg);
+    dcgmReturn_t ProcessResampleValues(dcgm_core_msg_resample_values_t &msg);
+    dcgmReturn_t ProcessMetadataSubscribe(dcgm_core_msg_metadata_subscribe_t &msg);
+    dcgmReturn_t ProcessRequestCancelSupport(dcgm_core_msg_request_cancel_support_t &msg);
     dcgmReturn_t ProcessUnwatchFieldValue(dcgm_core_msg_unwatch_field_value_t &msg);
     dcgmReturn_t ProcessInjectFieldValue(dcgm_core_msg_inject_field_value_t &msg);
+    dcgmReturn_t ProcessInjectFieldValues(dcgm_core_msg_inject_field_values_t &msg);
     dcgmReturn_t ProcessGetCacheManagerFieldInfo(dcgm_core_msg_get_cache_manager_field_info_t &msg);
     dcgmReturn_t ProcessWatchFields(dcgm_core_msg_watch_fields_t &msg);
     dcgmReturn_t ProcessUnwatchFields(dcgm_core_msg_watch_fields_t &msg);
+    dcgmReturn_t ProcessSubscribeFields(dcgm_core_msg_watch_fields_t &msg);
+    dcgmReturn_t ProcessUnsubscribeFields(dcgm_core_msg_watch_fields_t &msg);
+    dcgmReturn_t ProcessValuesCursorOpen(dcgm_core_msg_values_cursor_t &msg);
+    dcgmReturn_t ProcessValuesCursorNext(dcgm_core_msg_values_cursor_t &msg);
+    dcgmReturn_t ProcessValuesCursorClose(dcgm_core_msg_values_cursor_t &msg);
     dcgmReturn_t ProcessGetTopology(dcgm_core_msg_get_topology_t &msg);
     dcgmReturn_t ProcessGetTopologyAffinity(dcgm_core_msg_get_topology_affinity_t &msg);
     dcgmReturn_t ProcessSelectGpusByTopology(dcgm_core_msg_select_topology_gpus_t &msg);
@@ -74,14 +85,17 @@ public:
     dcgmReturn_t ProcessFieldgroupOp(dcgm_core_msg_fieldgroup_op_t &msg);
     dcgmReturn_t ProcessPidGetInfo(dcgm_core_msg_pid_get_info_t &msg);
     dcgmReturn_t ProcessGetFieldSummary(dcgm_core_msg_get_field_summary_t &msg);
+    dcgmReturn_t ProcessGetFieldSummaryV2(dcgm_core_msg_get_field_summary_v2 &msg);
     dcgmReturn_t ProcessCreateFakeEntities(dcgm_core_msg_create_fake_entities_t &msg);
     dcgmReturn_t ProcessWatchPredefinedFields(dcgm_core_msg_watch_predefined_fields_t &msg);
     dcgmReturn_t ProcessModuleDenylist(dcgm_core_msg_module_denylist_t &msg);
     dcgmReturn_t ProcessModuleStatus(dcgm_core_msg_module_status_t &msg);
+    dcgmReturn_t ProcessModuleStatusV2(dcgm_core_msg_module_status_v2 &msg);
     dcgmReturn_t ProcessHostEngineHealth(dcgm_core_msg_hostengine_health_t &msg);
     dcgmReturn_t ProcessFieldGroupGetAll(dcgm_core_msg_fieldgroup_get_all_t &msg);
     dcgmReturn_t ProcessGetGpuInstanceHierarchy(dcgm_core_msg_get_gpu_instance_hierarchy_t &msg);
     dcgmReturn_t ProcessProfGetMetricGroups(dcgm_core_msg_get_metric_groups_t &msg);
+    dcgmReturn_t ProcessProfGetMultiplexInfo(dcgm_core_msg_prof_multiplex_info_t &msg);
     dcgmReturn_t ProcessNvmlInjectFieldValue(dcgm_core_msg_nvml_inject_field_value_t &msg);
     dcgmReturn_t ProcessPauseResume(dcgm_core_msg_pause_resume_v1 &msg);
 #ifdef INJECTION_LIBRARY_AVAILABLE
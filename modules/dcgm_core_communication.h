@@ -20,6 +20,8 @@
 #include <timelib.h>
 #include <timeseries.h>
 
+#include <span>
+
 #include "DcgmProtocol.h"
 #include "dcgm_module_structs.h"
 
@@ -59,6 +61,12 @@ typedef enum
     DcgmCoreReqMigIndicesForEntity              = 47, // DcgmCacheManager::GetMigIndicesForEntity()
     DcgmCoreReqGetServiceAccount                = 48, // DcgmHostEngineHandler::GetServiceAccount()
     DcgmCoreReqPopulateMigHierarchy             = 49, // DcgmCacheManager::PopulateMigHierarchy()
+    DcgmCoreReqIdCMGetCompressedSampleBytes     = 50, // DcgmCacheManager::GetCompressedSampleBytes()
+    DcgmCoreReqIdCMGetFieldCosts                = 51, // DcgmCacheManager::GetFieldCosts()
+    DcgmCoreReqIdGetLockProfile                 = 52, // DcgmMutex::GetProfiles()
+    DcgmCoreReqIdCMSetNvSwitchLinkStatus        = 53, // DcgmCacheManager::SetNvSwitchLinkStatus()
+    DcgmCoreReqIdCMGetRuntimeStats              = 54, // DcgmCacheManager::GetRuntimeStats()
+    DcgmCoreReqIdCMSetEntityStatuses            = 55, // DcgmCacheManager::SetEntityStatuses()
     DcgmCoreReqIdCount                                // Always keep this one last
 } dcgmCoreReqCmd_t;
 
@@ -66,6 +74,66 @@ typedef enum
    in the modules' shared library with dlsym */
 typedef dcgmReturn_t (*dcgmCoreReqPost_f)(dcgm_module_command_header_t *req, void *);
 typedef dcgmReturn_t (*dcgmCoreGetResponse_f)(dcgmCoreReqId_t reqId, unsigned int timeout);
+
+/**
+ * Typed entry points into libdcgm for modules that live in the hostengine process. Each one calls the cache
+ * manager directly with the caller's buffers instead of packing a request struct, so the hot read paths skip
+ * the copies in and out of the message and its fixed-size staging arrays. The message form posted through
+ * dcgmCoreCallbacks_t::postfunc stays available for every request, including these.
+ *
+ * Every function takes the context member as its first argument.
+ */
+typedef struct
+{
+    unsigned int version; // !< the version of this structure
+    void *context;        // !< the object that serves the calls. Passed back as the first argument
+
+    // DcgmCacheManager::GetLatestSample()
+    dcgmReturn_t (*getLatestSample)(void *context,
+                                    dcgm_field_entity_group_t entityGroupId,
+                                    dcgm_field_eid_t entityId,
+                                    unsigned short fieldId,
+                                    dcgmcm_sample_p sample,
+                                    DcgmFvBuffer *fvBuffer);
+
+    // DcgmCacheManager::GetSamples()
+    dcgmReturn_t (*getSamples)(void *context,
+                               dcgm_field_entity_group_t entityGroupId,
+                               dcgm_field_eid_t entityId,
+                               unsigned short fieldId,
+                               std::span<dcgmcm_sample_t> samples,
+                               int *numSamples,
+                               timelib64_t startTime,
+                               timelib64_t endTime,
+                               dcgmOrder_t order);
+
+    // DcgmCacheManager::GetInt64SummaryData()
+    dcgmReturn_t (*getInt64SummaryData)(void *context,
+                                        dcgm_field_entity_group_t entityGroupId,
+                                        dcgm_field_eid_t entityId,
+                                        unsigned short fieldId,
+                                        std::span<DcgmcmSummaryType_t const> summaryTypes,
+                                        std::span<long long> summaryValues,
+                                        timelib64_t startTime,
+                                        timelib64_t endTime,
+                                        pfUseEntryForSummary useEntryCB,
+                                        void *userData);
+
+    // DcgmCacheManager::GetMultipleLatestLiveSamples()
+    dcgmReturn_t (*getMultipleLatestLiveSamples)(void *context,
+                                                 std::span<dcgmGroupEntityPair_t const> entities,
+                                                 std::span<unsigned short const> fieldIds,
+                                                 DcgmFvBuffer *fvBuffer);
+
+    // DcgmCacheManager::GetGpuInventory(). Added in version 2
+    dcgmReturn_t (*getGpuInventory)(void *context, std::shared_ptr<DcgmGpuInventorySnapshot const> &inventory);
+} dcgmCoreDirectInterface_v2;
+
+/* Version 1 lacked getGpuInventory. Modules given one fall back to posting requests */
+#define dcgmCoreDirectInterface_version2 MAKE_DCGM_VERSION(dcgmCoreDirectInterface_v2, 2)
+#define dcgmCoreDirectInterface_version  dcgmCoreDirectInterface_version2
+typedef dcgmCoreDirectInterface_v2 dcgmCoreDirectInterface_t;
+
 /**
  * Contains the callbacks that should be used for communicating between the modules and libdcgm
  */
@@ -79,9 +147,20 @@ typedef struct
 
 #define dcgmCoreCallbacks_version1 MAKE_DCGM_VERSION(dcgmCoreCallbacks_v1, 1)
 
-#define dcgmCoreCallbacks_version dcgmCoreCallbacks_version1
+typedef struct
+{
+    unsigned int version;                    // !< the version of the callback structure
+    dcgmCoreReqPost_f postfunc;              // !< function pointer to post a request to the core library
+    void *poster;                            // !< pointer to the object that forwards requests to the core modules
+    dcgmLoggerCallback_f loggerfunc;         // !< function pointer to send logging messages to the hostengine
+    dcgmCoreDirectInterface_t const *direct; // !< typed calls into the core library. nullptr if not available
+} dcgmCoreCallbacks_v2;
+
+#define dcgmCoreCallbacks_version2 MAKE_DCGM_VERSION(dcgmCoreCallbacks_v2, 2)
+
+#define dcgmCoreCallbacks_version dcgmCoreCallbacks_version2
 
-typedef dcgmCoreCallbacks_v1 dcgmCoreCallbacks_t;
+typedef dcgmCoreCallbacks_v2 dcgmCoreCallbacks_t;
 
 /**
  * Basic information covering simple requests that just specify an ID and maybe an entity group as well
@@ -280,7 +359,7 @@ typedef struct
  */
 typedef struct
 {
-    const char *buffer; // !< Pointer to a raw DcgmFvBuffer. Owned by the object.
+    const char *buffer; // !< Pointer to a raw DcgmFvBuffer. Owned by the caller and read in place by the core
     size_t bufferSize;  // !< Size of the buffer
 } dcgmCoreAppendSamplesParams_t;
 
@@ -349,9 +428,9 @@ typedef struct
 
 typedef struct
 {
-    dcgmReturn_t ret;                           // !< The status of the function call
-    unsigned int numSummaryTypes;               // !< The number of summary types stored in this response
-    long long summaryValues[DCGM_SUMMARY_SIZE]; // !< Array for storing each summary value
+    dcgmReturn_t ret;                               // !< The status of the function call
+    unsigned int numSummaryTypes;                   // !< The number of summary types stored in this response
+    long long summaryValues[DcgmcmSummaryTypeSize]; // !< Array for storing each summary value
 } dcgmCoreGetSummaryResponse_t;
 
 typedef struct
@@ -759,4 +838,108 @@ typedef struct
 
 #define dcgmCoreGetGpuInstanceHierarchy_version1 MAKE_DCGM_VERSION(dcgmCoreGetGpuInstanceHierarchy_v1, 1)
 #define dcgmCoreGetGpuInstanceHierarchy_version  dcgmCoreGetGpuInstanceHierarchy_version1
-typedef dcgmCoreGetGpuInstanceHierarchy_v1 dcgmCoreGetGpuInstanceHierarchy_t;
\ No newline at end of file
+typedef dcgmCoreGetGpuInstanceHierarchy_v1 dcgmCoreGetGpuInstanceHierarchy_t;
+
+typedef struct
+{
+    dcgmReturn_t ret;                // !< dcgmReturn_t from libdcgm, if any
+    long long compressedSampleBytes; // !< Bytes of encoded samples held by compressed timeseries
+} dcgmCoreGetCompressedSampleBytesResponse_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreGetCompressedSampleBytesResponse_t response;
+} dcgmCoreGetCompressedSampleBytes_v1;
+
+#define dcgmCoreGetCompressedSampleBytes_version1 MAKE_DCGM_VERSION(dcgmCoreGetCompressedSampleBytes_v1, 1)
+#define dcgmCoreGetCompressedSampleBytes_version  dcgmCoreGetCompressedSampleBytes_version1
+typedef dcgmCoreGetCompressedSampleBytes_v1 dcgmCoreGetCompressedSampleBytes_t;
+
+typedef struct
+{
+    dcgmReturn_t ret;                       // !< dcgmReturn_t from libdcgm, if any
+    dcgmIntrospectFieldCosts_v1 fieldCosts; // !< What each watch costs the cache manager
+} dcgmCoreGetFieldCostsResponse_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreGetFieldCostsResponse_t response;
+} dcgmCoreGetFieldCosts_v1;
+
+#define dcgmCoreGetFieldCosts_version1 MAKE_DCGM_VERSION(dcgmCoreGetFieldCosts_v1, 1)
+#define dcgmCoreGetFieldCosts_version  dcgmCoreGetFieldCosts_version1
+typedef dcgmCoreGetFieldCosts_v1 dcgmCoreGetFieldCosts_t;
+
+typedef struct
+{
+    dcgmReturn_t ret;                         // !< dcgmReturn_t from libdcgm, if any
+    dcgmIntrospectLockProfile_v1 lockProfile; // !< Contention profile of the host engine's mutexes
+} dcgmCoreGetLockProfileResponse_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreGetLockProfileResponse_t response;
+} dcgmCoreGetLockProfile_v1;
+
+#define dcgmCoreGetLockProfile_version1 MAKE_DCGM_VERSION(dcgmCoreGetLockProfile_v1, 1)
+#define dcgmCoreGetLockProfile_version  dcgmCoreGetLockProfile_version1
+typedef dcgmCoreGetLockProfile_v1 dcgmCoreGetLockProfile_t;
+
+typedef struct
+{
+    unsigned int numNvSwitches;                                       // !< Number of entries in nvSwitches[]
+    dcgmNvLinkNvSwitchLinkStatus_t nvSwitches[DCGM_MAX_NUM_SWITCHES]; // !< Link states of each NvSwitch
+} dcgmCoreSetNvSwitchLinkStatusRequest_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreSetNvSwitchLinkStatusRequest_t request;
+    dcgmCoreBasicResponse_t response;
+} dcgmCoreSetNvSwitchLinkStatus_v1;
+
+#define dcgmCoreSetNvSwitchLinkStatus_version1 MAKE_DCGM_VERSION(dcgmCoreSetNvSwitchLinkStatus_v1, 1)
+#define dcgmCoreSetNvSwitchLinkStatus_version  dcgmCoreSetNvSwitchLinkStatus_version1
+typedef dcgmCoreSetNvSwitchLinkStatus_v1 dcgmCoreSetNvSwitchLinkStatus_t;
+
+typedef struct
+{
+    dcgmReturn_t ret;                           // !< dcgmReturn_t from libdcgm, if any
+    dcgmIntrospectRuntimeStats_v1 runtimeStats; // !< Counters of the cache manager
+} dcgmCoreGetRuntimeStatsResponse_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreGetRuntimeStatsResponse_t response;
+} dcgmCoreGetRuntimeStats_v1;
+
+#define dcgmCoreGetRuntimeStats_version1 MAKE_DCGM_VERSION(dcgmCoreGetRuntimeStats_v1, 1)
+#define dcgmCoreGetRuntimeStats_version  dcgmCoreGetRuntimeStats_version1
+typedef dcgmCoreGetRuntimeStats_v1 dcgmCoreGetRuntimeStats_t;
+typedef struct
+{
+    dcgm_field_eid_t entityId; // !< ID of the entity
+    unsigned int status;       // !< DcgmEntityStatus_t of the entity
+} dcgmCoreEntityStatus_t;
+
+typedef struct
+{
+    dcgm_field_entity_group_t entityGroupId;                 // !< DCGM_FE_SWITCH, DCGM_FE_CPU or DCGM_FE_CPU_CORE
+    unsigned int numEntities;                                // !< Number of entries in entities[]
+    dcgmCoreEntityStatus_t entities[DCGM_MAX_NUM_CPU_CORES]; // !< Every entity of the group and its status
+} dcgmCoreSetEntityStatusesRequest_t;
+
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmCoreSetEntityStatusesRequest_t request;
+    dcgmCoreBasicResponse_t response;
+} dcgmCoreSetEntityStatuses_v1;
+
+#define dcgmCoreSetEntityStatuses_version1 MAKE_DCGM_VERSION(dcgmCoreSetEntityStatuses_v1, 1)
+#define dcgmCoreSetEntityStatuses_version  dcgmCoreSetEntityStatuses_version1
+typedef dcgmCoreSetEntityStatuses_v1 dcgmCoreSetEntityStatuses_t;
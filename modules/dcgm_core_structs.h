@@ -88,6 +88,20 @@
 #define DCGM_CORE_SR_REMOVE_NVML_INJECTED_GPU               65 /* Remove nvml injected GPU from injection library */
 #define DCGM_CORE_SR_RESTORE_NVML_INJECTED_GPU              66 /* Restore nvml injected GPU to injection library */
 #define DCGM_CORE_SR_NVSWITCH_GET_BACKEND                   67 /* Get name for active NVSwitch backend */
+#define DCGM_CORE_SR_SUBSCRIBE_FIELDS                       68 /* Watch a group of fields and push their updates */
+#define DCGM_CORE_SR_UNSUBSCRIBE_FIELDS                     69 /* Stop pushing and unwatch a group of fields */
+#define DCGM_CORE_SR_VALUES_CURSOR_OPEN                     70 /* Open a cursor over values since a timestamp */
+#define DCGM_CORE_SR_VALUES_CURSOR_NEXT                     71 /* Get the next chunk of values of a cursor */
+#define DCGM_CORE_SR_VALUES_CURSOR_CLOSE                    72 /* Close a values cursor */
+#define DCGM_CORE_SR_GET_FIELD_SUMMARY_V2                   73 /* Get summary of a particular field (V2) */
+#define DCGM_CORE_SR_INJECT_FIELD_VALUES                    74 /* Inject a batch of field values */
+#define DCGM_CORE_SR_MODULE_STATUS_V2                       75 /* Get the status and init time of modules */
+#define DCGM_CORE_SR_UPDATE_FIELDS                          76 /* Update the watches of a field group */
+#define DCGM_CORE_SR_SNAPSHOT_FIELDS                        77 /* Sample a field group on all GPUs at once */
+#define DCGM_CORE_SR_PROF_GET_MULTIPLEX_INFO                78 /* Get how the prof fields of a group are multiplexed */
+#define DCGM_CORE_SR_RESAMPLE_VALUES                        79 /* Get values resampled to a grid of times */
+#define DCGM_CORE_SR_METADATA_SUBSCRIBE                     80 /* Get notified of metadata changes */
+#define DCGM_CORE_SR_REQUEST_CANCEL_SUPPORT                 81 /* Does the host engine act on request cancels? */
 
 /*****************************************************************************/
 /* Subrequest message definitions */
@@ -126,9 +140,28 @@ typedef struct dcgm_core_msg_mig_updated_v1
 } dcgm_core_msg_mig_updated_v1;
 
 #define dcgm_core_msg_mig_updated_version1 MAKE_DCGM_VERSION(dcgm_core_msg_mig_updated_v1, 1)
-#define dcgm_core_msg_mig_updated_version  dcgm_core_msg_mig_updated_version1
 
-typedef dcgm_core_msg_mig_updated_v1 dcgm_core_msg_mig_updated_t;
+/* v2 also says which MIG entities of the GPU were added and removed. Entities that are in neither list kept their
+   IDs, so modules only need to drop and re-create state for the ones that are listed */
+typedef struct dcgm_core_msg_mig_updated_v2
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    unsigned int gpuId;                      /* The ID of the GPU that had a MIG update */
+    unsigned int numAddedGpuInstances;       /* Number of entries in addedGpuInstances */
+    unsigned int numRemovedGpuInstances;     /* Number of entries in removedGpuInstances */
+    unsigned int numAddedComputeInstances;   /* Number of entries in addedComputeInstances */
+    unsigned int numRemovedComputeInstances; /* Number of entries in removedComputeInstances */
+    unsigned int addedGpuInstances[DCGM_MAX_INSTANCES_PER_GPU];              /* DCGM GPU instance IDs */
+    unsigned int removedGpuInstances[DCGM_MAX_INSTANCES_PER_GPU];            /* DCGM GPU instance IDs */
+    unsigned int addedComputeInstances[DCGM_MAX_COMPUTE_INSTANCES_PER_GPU];   /* DCGM compute instance IDs */
+    unsigned int removedComputeInstances[DCGM_MAX_COMPUTE_INSTANCES_PER_GPU]; /* DCGM compute instance IDs */
+} dcgm_core_msg_mig_updated_v2;
+
+#define dcgm_core_msg_mig_updated_version2 MAKE_DCGM_VERSION(dcgm_core_msg_mig_updated_v2, 2)
+#define dcgm_core_msg_mig_updated_version  dcgm_core_msg_mig_updated_version2
+
+typedef dcgm_core_msg_mig_updated_v2 dcgm_core_msg_mig_updated_t;
 
 typedef struct dcgm_core_msg_group_removed_v1
 {
@@ -388,6 +421,17 @@ typedef struct
 #define dcgm_core_msg_get_multiple_values_for_field_version2 \
     MAKE_DCGM_VERSION(dcgm_core_msg_get_multiple_values_for_field_v2, 2)
 
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmValuesCursor_v1 vc;
+} dcgm_core_msg_values_cursor_v1;
+
+#define dcgm_core_msg_values_cursor_version1 MAKE_DCGM_VERSION(dcgm_core_msg_values_cursor_v1, 1)
+#define dcgm_core_msg_values_cursor_version  dcgm_core_msg_values_cursor_version1
+
+typedef dcgm_core_msg_values_cursor_v1 dcgm_core_msg_values_cursor_t;
+
 /* Used by DCGM 2.x clients */
 typedef struct
 {
@@ -417,6 +461,82 @@ typedef struct
 
 typedef dcgm_core_msg_update_all_fields_v1 dcgm_core_msg_update_all_fields_t;
 
+/**
+ * Subrequest DCGM_CORE_SR_UPDATE_FIELDS
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmUpdateFields_v1 uf;
+} dcgm_core_msg_update_fields_v1;
+
+#define dcgm_core_msg_update_fields_version1 MAKE_DCGM_VERSION(dcgm_core_msg_update_fields_v1, 1)
+#define dcgm_core_msg_update_fields_version  dcgm_core_msg_update_fields_version1
+
+typedef dcgm_core_msg_update_fields_v1 dcgm_core_msg_update_fields_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_SNAPSHOT_FIELDS
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmSnapshotFields_v1 sf;
+} dcgm_core_msg_snapshot_fields_v1;
+
+#define dcgm_core_msg_snapshot_fields_version1 MAKE_DCGM_VERSION(dcgm_core_msg_snapshot_fields_v1, 1)
+#define dcgm_core_msg_snapshot_fields_version  dcgm_core_msg_snapshot_fields_version1
+
+typedef dcgm_core_msg_snapshot_fields_v1 dcgm_core_msg_snapshot_fields_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_RESAMPLE_VALUES
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmResampleValues_v1 rv;
+} dcgm_core_msg_resample_values_v1;
+
+#define dcgm_core_msg_resample_values_version1 MAKE_DCGM_VERSION(dcgm_core_msg_resample_values_v1, 1)
+#define dcgm_core_msg_resample_values_version  dcgm_core_msg_resample_values_version1
+
+typedef dcgm_core_msg_resample_values_v1 dcgm_core_msg_resample_values_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_METADATA_SUBSCRIBE. The connection is sent a DCGM_MSG_METADATA_NOTIFY with the
+ * requestId of this request whenever the metadata generation changes, until it disconnects
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    unsigned long long generation; /* OUT: Current metadata generation of the host engine */
+    int cmdRet;                     /* OUT: Error code generated */
+    unsigned int unused;
+} dcgm_core_msg_metadata_subscribe_v1;
+
+#define dcgm_core_msg_metadata_subscribe_version1 MAKE_DCGM_VERSION(dcgm_core_msg_metadata_subscribe_v1, 1)
+#define dcgm_core_msg_metadata_subscribe_version  dcgm_core_msg_metadata_subscribe_version1
+
+typedef dcgm_core_msg_metadata_subscribe_v1 dcgm_core_msg_metadata_subscribe_t;
+
+/**
+ * Subrequest DCGM_CORE_SR_REQUEST_CANCEL_SUPPORT. Host engines that answer it drop or stop requests when they
+ * get a DCGM_MSG_REQUEST_CANCEL. Older ones log an error for each DCGM_MSG_REQUEST_CANCEL, so clients only
+ * send them once this succeeded
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    int cmdRet; /* OUT: Error code generated */
+    unsigned int unused;
+} dcgm_core_msg_request_cancel_support_v1;
+
+#define dcgm_core_msg_request_cancel_support_version1 MAKE_DCGM_VERSION(dcgm_core_msg_request_cancel_support_v1, 1)
+#define dcgm_core_msg_request_cancel_support_version  dcgm_core_msg_request_cancel_support_version1
+
+typedef dcgm_core_msg_request_cancel_support_v1 dcgm_core_msg_request_cancel_support_t;
+
 typedef struct
 {
     dcgm_module_command_header_t header;
@@ -439,6 +559,17 @@ typedef struct
 
 typedef dcgm_core_msg_inject_field_value_v1 dcgm_core_msg_inject_field_value_t;
 
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmInjectFieldValues_v1 iv;
+} dcgm_core_msg_inject_field_values_v1;
+
+#define dcgm_core_msg_inject_field_values_version1 MAKE_DCGM_VERSION(dcgm_core_msg_inject_field_values_v1, 1)
+#define dcgm_core_msg_inject_field_values_version  dcgm_core_msg_inject_field_values_version1
+
+typedef dcgm_core_msg_inject_field_values_v1 dcgm_core_msg_inject_field_values_t;
+
 /* For now the NVML injection API has the same interface as the DCGM injection API,
  * so we can copy these. */
 typedef dcgm_core_msg_inject_field_value_v1 dcgm_core_msg_nvml_inject_field_value_t;
@@ -577,6 +708,14 @@ typedef struct
 
 typedef dcgm_core_msg_get_field_summary_v1 dcgm_core_msg_get_field_summary_t;
 
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmGetFieldSummary_v2 info;
+} dcgm_core_msg_get_field_summary_v2;
+
+#define dcgm_core_msg_get_field_summary_version2 MAKE_DCGM_VERSION(dcgm_core_msg_get_field_summary_v2, 2)
+
 typedef struct
 {
     dcgm_module_command_header_t header;
@@ -621,6 +760,14 @@ typedef struct
 
 typedef dcgm_core_msg_module_status_v1 dcgm_core_msg_module_status_t;
 
+typedef struct
+{
+    dcgm_module_command_header_t header;
+    dcgmMsgModuleStatus_v2 info;
+} dcgm_core_msg_module_status_v2;
+
+#define dcgm_core_msg_module_status_version2 MAKE_DCGM_VERSION(dcgm_core_msg_module_status_v2, 2)
+
 typedef struct
 {
     dcgm_module_command_header_t header;
@@ -670,6 +817,21 @@ typedef struct
 
 typedef dcgm_core_msg_get_metric_groups_v1 dcgm_core_msg_get_metric_groups_t;
 
+/**
+ * Subrequest DCGM_CORE_SR_PROF_GET_MULTIPLEX_INFO
+ */
+typedef struct
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmProfMultiplexInfo_t multiplexInfo; /* IN/OUT user request to process */
+} dcgm_core_msg_prof_multiplex_info_v1;
+
+#define dcgm_core_msg_prof_multiplex_info_version1 MAKE_DCGM_VERSION(dcgm_core_msg_prof_multiplex_info_v1, 1)
+#define dcgm_core_msg_prof_multiplex_info_version  dcgm_core_msg_prof_multiplex_info_version1
+
+typedef dcgm_core_msg_prof_multiplex_info_v1 dcgm_core_msg_prof_multiplex_info_t;
+
 typedef struct
 {
     dcgm_module_command_header_t header;   /* Command header */
@@ -782,6 +944,7 @@ typedef dcgm_core_msg_nvswitch_get_backend_v1 dcgm_core_msg_nvswitch_get_backend
 DCGM_CASSERT(dcgm_core_msg_client_disconnect_version1 == (long)0x100001c, 1);
 DCGM_CASSERT(dcgm_core_msg_logging_changed_version1 == (long)0x1000018, 1);
 DCGM_CASSERT(dcgm_core_msg_mig_updated_version1 == (long)0x100001c, 1);
+DCGM_CASSERT(dcgm_core_msg_mig_updated_version2 == (long)0x20000ac, 2);
 DCGM_CASSERT(dcgm_core_msg_group_removed_version1 == (long)0x100001c, 1);
 DCGM_CASSERT(dcgm_core_msg_field_values_updated_version1 == (long)0x1000028, 1);
 DCGM_CASSERT(dcgm_core_msg_set_severity_version1 == (long)0x1000020, 1);
@@ -802,6 +965,11 @@ DCGM_CASSERT(dcgm_core_msg_entities_get_latest_values_version1 == (long)0x100433
 DCGM_CASSERT(dcgm_core_msg_get_multiple_values_for_field_version1 == (long)0x1004048, 1);
 DCGM_CASSERT(dcgm_core_msg_watch_field_value_version1 == (long)0x1000040, 1);
 DCGM_CASSERT(dcgm_core_msg_update_all_fields_version1 == (long)0x1000020, 1);
+DCGM_CASSERT(dcgm_core_msg_update_fields_version1 == (long)0x1000028, 1);
+DCGM_CASSERT(dcgm_core_msg_snapshot_fields_version1 == (long)0x1000030, 1);
+DCGM_CASSERT(dcgm_core_msg_resample_values_version1 == (long)0x1042040, 1);
+DCGM_CASSERT(dcgm_core_msg_metadata_subscribe_version1 == (long)0x1000028, 1);
+DCGM_CASSERT(dcgm_core_msg_request_cancel_support_version1 == (long)0x1000020, 1);
 DCGM_CASSERT(dcgm_core_msg_unwatch_field_value_version1 == (long)0x100002c, 1);
 DCGM_CASSERT(dcgm_core_msg_inject_field_value_version1 == (long)0x1001040, 1);
 DCGM_CASSERT(dcgm_core_msg_get_cache_manager_field_info_version2 == (long)0x2000160, 1);
@@ -820,12 +988,14 @@ DCGM_CASSERT(dcgm_core_msg_create_fake_entities_version1 == (long)0x1002324, 1);
 DCGM_CASSERT(dcgm_core_msg_watch_predefined_fields_version1 == (long)0x1000048, 1);
 DCGM_CASSERT(dcgm_core_msg_module_denylist_version1 == (long)0x1000020, 1);
 DCGM_CASSERT(dcgm_core_msg_module_status_version1 == (long)0x10000a4, 1);
+DCGM_CASSERT(dcgm_core_msg_module_status_version2 == (long)0x20001a8, 2);
 DCGM_CASSERT(dcgm_core_msg_hostengine_health_version1 == (long)0x1000020, 1);
 DCGM_CASSERT(dcgm_core_msg_fieldgroup_get_all_version1 == (long)0x1008428, 1);
 DCGM_CASSERT(dcgm_core_msg_fieldgroup_get_all_version == (long)0x1008428, 1);
 DCGM_CASSERT(dcgm_core_msg_get_gpu_instance_hierarchy_version == (long)0x1011f24, 1);
 DCGM_CASSERT(dcgm_core_msg_get_metric_groups_version1 == (long)0x1000578, 1);
 DCGM_CASSERT(dcgm_core_msg_get_metric_groups_version == (long)0x1000578, 1);
+DCGM_CASSERT(dcgm_core_msg_prof_multiplex_info_version1 == (long)0x10002c0, 1);
 
 #ifdef INJECTION_LIBRARY_AVAILABLE
 DCGM_CASSERT(dcgm_core_msg_nvml_inject_device_version1 == (long)0x101e370, 1);
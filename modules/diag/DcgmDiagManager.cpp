@@ -24,28 +24,34 @@
 #include <Defer.hpp>
 #include <EntityListHelpers.h>
 #include <NvvsExitCode.h>
-#include <UniquePtrUtil.h>
 #include <dcgm_config_structs.h>
 #include <dcgm_core_structs.h>
 #include <dcgm_structs.h>
+#include <dcgm_structs_internal.h>
 
 #include <algorithm>
 #include <charconv>
 #include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <filesystem>
 #include <fmt/format.h>
 #include <iterator>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
 
-#define NVVS_CHANNEL_FD 3
+#define NVVS_CHANNEL_FD  3
+#define NVVS_RESPONSE_FD 4
+#define NVVS_WORKER_FD   5
 
 namespace
 {
@@ -82,8 +88,151 @@ std::string SanitizedString(std::string const &str)
     });
     return sanitized;
 }
+
+unsigned int GetStructVersion(std::string_view data)
+{
+    // Get the version from the first four bytes of data. If data
+    // is smaller than expected, return a blank value.
+    if (data.size() < sizeof(unsigned int))
+    {
+        return DCGM_INT32_BLANK;
+    }
+
+    unsigned int version;
+    std::memcpy(&version, data.data(), sizeof(version));
+    return version;
+}
+
+constexpr size_t c_responseRegionSize = std::max({ sizeof(dcgmDiagResponse_v11),
+                                                   sizeof(dcgmDiagResponse_v10),
+                                                   sizeof(dcgmDiagResponse_v9),
+                                                   sizeof(dcgmDiagResponse_v8),
+                                                   sizeof(dcgmDiagResponse_v7) });
+
+/*
+ * Create the shared memory region NVVS writes its response to. It is sealed against resizing so that neither
+ * side can have the mapping cut short under it. Returns an invalid handle if the region can't be created; NVVS
+ * then sends the response over the channel instead.
+ */
+DcgmNs::Utils::FileHandle CreateResponseRegion()
+{
+    DcgmNs::Utils::FileHandle fd(memfd_create("nvvs-response", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+    if (fd.Get() == -1)
+    {
+        log_debug("memfd_create failed: {}", strerror(errno));
+        return {};
+    }
+    if (ftruncate(fd.Get(), c_responseRegionSize) != 0
+        || fcntl(fd.Get(), F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+    {
+        log_debug("failed to set up the response region: {}", strerror(errno));
+        return {};
+    }
+    return fd;
+}
+
+bool UseNvvsWorker()
+{
+    char const *workerEnvStr = getenv("__DCGM_NVVS_WORKER__");
+    bool const useWorker     = workerEnvStr && workerEnvStr[0] == '1';
+    log_debug("Run diags with an nvvs worker: {}", useWorker);
+    return useWorker;
+}
+
+timelib64_t ResultCacheMaxAgeUsec()
+{
+    char const *maxAgeEnvStr = getenv("__DCGM_DIAG_RESULT_CACHE_SEC__");
+    unsigned int maxAgeSec   = 0;
+    if (maxAgeEnvStr != nullptr)
+    {
+        std::from_chars(maxAgeEnvStr, maxAgeEnvStr + strlen(maxAgeEnvStr), maxAgeSec);
+    }
+    log_debug("Reuse diag results for up to {} seconds", maxAgeSec);
+    return (timelib64_t)maxAgeSec * 1000000;
+}
+
+/* Write all of buf to fd */
+bool WriteAll(int fd, std::span<char const> buf)
+{
+    while (!buf.empty())
+    {
+        if (auto written = write(fd, buf.data(), buf.size()); written >= 0)
+        {
+            buf = buf.subspan(written);
+            continue;
+        }
+        if (errno != EINTR && errno != EAGAIN)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Send args, without the executable, to an nvvs worker as a run request. See RunWorker() in NvvsMain.cpp */
+bool SendNvvsWorkerRequest(int requestFd, std::vector<std::string> const &args)
+{
+    std::string request;
+    for (auto it = args.begin() + 1; it != args.end(); ++it)
+    {
+        request += *it;
+        request += '\0';
+    }
+
+    std::uint32_t const len = request.size();
+    if (!WriteAll(requestFd, { reinterpret_cast<char const *>(&len), sizeof(len) }) || !WriteAll(requestFd, request))
+    {
+        log_error("failed to send a request to the nvvs worker: {}", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/* Set response from the region NVVS said it wrote its response to */
+dcgmReturn_t SetResultFromResponseRegion(DcgmNs::Utils::FileHandle const &regionFd,
+                                         std::string_view readyData,
+                                         DcgmDiagResponseWrapper &response)
+{
+    dcgmDiagResponseReady_v1 ready {};
+    if (regionFd.Get() == -1 || readyData.size() != sizeof(ready))
+    {
+        log_error("Unexpected response ready frame of {} bytes from nvvs channel", readyData.size());
+        return DCGM_ST_NVVS_ERROR;
+    }
+    memcpy(&ready, readyData.data(), sizeof(ready));
+    if (ready.responseSize > c_responseRegionSize || ready.responseSize < sizeof(ready.responseVersion))
+    {
+        log_error("Response of {} bytes doesn't fit the response region", ready.responseSize);
+        return DCGM_ST_NVVS_ERROR;
+    }
+
+    void *region = mmap(nullptr, ready.responseSize, PROT_READ, MAP_SHARED, regionFd.Get(), 0);
+    if (region == MAP_FAILED)
+    {
+        log_error("failed to map the response region: {}", strerror(errno));
+        return DCGM_ST_NVVS_ERROR;
+    }
+    DcgmNs::Defer unmap([&] { munmap(region, ready.responseSize); });
+
+    std::string_view data(static_cast<char const *>(region), ready.responseSize);
+    if (GetStructVersion(data) != ready.responseVersion)
+    {
+        log_error("The response region holds version {}, not {}", GetStructVersion(data), ready.responseVersion);
+        return DCGM_ST_NVVS_ERROR;
+    }
+    return response.SetResult(data);
+}
 } // namespace
 
+/*****************************************************************************/
+struct DcgmDiagManager::NvvsWorker
+{
+    DcgmNs::Common::Subprocess::ChildProcess process;
+    DcgmNs::Utils::FileHandle requestFd;        /* Write end of the worker's NVVS_WORKER_FD */
+    DcgmNs::Utils::FileHandle responseRegionFd; /* Shared as the worker's NVVS_RESPONSE_FD */
+    std::optional<std::string> serviceAccount;  /* Who the worker runs as */
+};
+
 /*****************************************************************************/
 DcgmDiagManager::DcgmDiagManager(dcgmCoreCallbacks_t &dcc)
     : m_nvvsPath(GetNvvsBinPath())
@@ -92,6 +241,8 @@ DcgmDiagManager::DcgmDiagManager(dcgmCoreCallbacks_t &dcc)
     , m_ticket(0)
     , m_coreProxy(dcc)
     , m_amShuttingDown(false)
+    , m_useNvvsWorker(UseNvvsWorker())
+    , m_resultCache(ResultCacheMaxAgeUsec())
 {}
 
 DcgmDiagManager::~DcgmDiagManager()
@@ -519,6 +670,8 @@ dcgmReturn_t DcgmDiagManager::CreateNvvsCommand(std::vector<std::string> &cmdArg
     cmdArgs.push_back(m_nvvsPath);
     cmdArgs.push_back("--channel-fd");
     cmdArgs.push_back(std::to_string(NVVS_CHANNEL_FD));
+    cmdArgs.push_back("--response-fd");
+    cmdArgs.push_back(std::to_string(NVVS_RESPONSE_FD));
     cmdArgs.push_back("--response-version");
     cmdArgs.push_back(std::to_string(diagResponseVersion));
 
@@ -597,18 +750,66 @@ void DcgmDiagManager::UpdateChildPID(pid_t value, uint64_t myTicket) const
     m_nvvsPID = value;
 }
 
-static unsigned int GetStructVersion(std::string_view data)
+/*****************************************************************************/
+DcgmDiagManager::NvvsWorker *DcgmDiagManager::GetNvvsWorker(std::optional<std::string> const &serviceAccount) const
 {
-    // Get the version from the first four bytes of data. If data
-    // is smaller than expected, return a blank value.
-    if (data.size() < sizeof(unsigned int))
+    assert(m_mutex.Poll() == DCGM_MUTEX_ST_LOCKEDBYME);
+
+    if (m_nvvsWorker && m_nvvsWorker->process.IsAlive() && m_nvvsWorker->serviceAccount == serviceAccount)
     {
-        return DCGM_INT32_BLANK;
+        return m_nvvsWorker.get();
     }
+    m_nvvsWorker.reset();
 
-    unsigned int version;
-    std::memcpy(&version, data.data(), sizeof(version));
-    return version;
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0)
+    {
+        log_error("failed to create the nvvs worker request pipe: {}", strerror(errno));
+        return nullptr;
+    }
+    DcgmNs::Utils::FileHandle requestReadFd(pipeFds[0]);
+
+    auto worker              = std::make_unique<NvvsWorker>();
+    worker->requestFd        = DcgmNs::Utils::FileHandle(pipeFds[1]);
+    worker->responseRegionFd = CreateResponseRegion();
+    worker->serviceAccount   = serviceAccount;
+
+    try
+    {
+        DcgmNs::Common::Subprocess::ChildProcessBuilder builder;
+        builder.SetExecutable(m_nvvsPath)
+            .SetChannelFd(NVVS_CHANNEL_FD)
+            .ShareFd(NVVS_WORKER_FD, requestReadFd.Get())
+            .AddArgs({ "--worker-fd",
+                       std::to_string(NVVS_WORKER_FD),
+                       "--channel-fd",
+                       std::to_string(NVVS_CHANNEL_FD) });
+        if (worker->responseRegionFd.Get() != -1)
+        {
+            builder.ShareFd(NVVS_RESPONSE_FD, worker->responseRegionFd.Get());
+        }
+        if (serviceAccount.has_value())
+        {
+            builder.SetRunningUser(*serviceAccount);
+        }
+        worker->process = builder.Build();
+        worker->process.Run();
+    }
+    catch (std::exception const &e)
+    {
+        log_error("Unable to start an nvvs worker: {}", e.what());
+        return nullptr;
+    }
+
+    if (!worker->process.GetPid().has_value())
+    {
+        log_error("The nvvs worker exited on startup.");
+        return nullptr;
+    }
+
+    log_debug("Started nvvs worker (PID: {})", *worker->process.GetPid());
+    m_nvvsWorker = std::move(worker);
+    return m_nvvsWorker.get();
 }
 
 static void PrintDiagStatus(dcgmDiagStatus_v1 const &diagStatus)
@@ -677,8 +878,11 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
     int statSt;
     DcgmNs::Utils::FileHandle stdoutFd;
     DcgmNs::Utils::FileHandle stderrFd;
-    pid_t pid = -1;
+    DcgmNs::Utils::FileHandle responseRegionFd;
+    NvvsWorker *worker = nullptr;
+    pid_t pid          = -1;
     uint64_t myTicket;
+    std::chrono::steady_clock::time_point launchStart;
 
     AppendDummyArgs(args);
     std::string nvvsPath = args[0];
@@ -763,18 +967,44 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
             }
         }
 
-        // skip args[0] as it is executable path
-        builder.SetExecutable(nvvsPath)
-            .SetChannelFd(NVVS_CHANNEL_FD)
-            .AddArgs(std::vector(args.begin() + 1, args.end()));
-        if (serviceAccount.has_value())
+        launchStart = std::chrono::steady_clock::now();
+        if (m_useNvvsWorker && nvvsPath == m_nvvsPath)
         {
-            builder.SetRunningUser(*serviceAccount);
+            worker = GetNvvsWorker(serviceAccount);
+            if (worker != nullptr && !SendNvvsWorkerRequest(worker->requestFd.Get(), args))
+            {
+                // The worker is gone. Run this diag with its own nvvs and start a new worker next time
+                m_nvvsWorker.reset();
+                worker = nullptr;
+            }
+        }
+
+        if (worker != nullptr)
+        {
+            auto pidOpt = worker->process.GetPid();
+            pid         = pidOpt.has_value() ? *pidOpt : -1;
+        }
+        else
+        {
+            // skip args[0] as it is executable path
+            builder.SetExecutable(nvvsPath)
+                .SetChannelFd(NVVS_CHANNEL_FD)
+                .AddArgs(std::vector(args.begin() + 1, args.end()));
+            // NVVS copies its response here and only signals over the channel, instead of streaming the whole struct
+            responseRegionFd = CreateResponseRegion();
+            if (responseRegionFd.Get() != -1)
+            {
+                builder.ShareFd(NVVS_RESPONSE_FD, responseRegionFd.Get());
+            }
+            if (serviceAccount.has_value())
+            {
+                builder.SetRunningUser(*serviceAccount);
+            }
+            process = builder.Build();
+            process.Run();
+            auto pidOpt = process.GetPid();
+            pid         = pidOpt.has_value() ? *pidOpt : -1;
         }
-        process = builder.Build();
-        process.Run();
-        auto pidOpt = process.GetPid();
-        pid         = pidOpt.has_value() ? *pidOpt : -1;
         // Update the nvvs pid
         myTicket = GetTicket();
         UpdateChildPID(pid, myTicket);
@@ -789,25 +1019,47 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
     /* Do not return DCGM_ST_DIAG_BAD_LAUNCH for errors after this point since the child has been launched - use
        DCGM_ST_NVVS_ERROR or DCGM_ST_GENERIC_ERROR instead */
     log_debug("Launched external command '{}' (PID: {})", fmt::to_string(fmt::join(args, " ")), pid);
+    auto const launched = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration responseHandlingTime {};
+
+    /* A worker that didn't finish the run can't take another one: its remaining frames would be read as the next
+       run's. Stop it; the next diag starts a new one */
+    std::optional<int> workerReturnCode;
+    DcgmNs::Defer stopUnfinishedWorker([&] {
+        if (worker != nullptr && !workerReturnCode.has_value())
+        {
+            DcgmLockGuard lock(&m_mutex);
+            m_nvvsWorker.reset();
+        }
+    });
 
     unsigned int receivedResultFrameNum = 0;
-    auto &frameChannel                  = process.GetFdChannel();
-    for (auto const &frame : frameChannel)
+
+    auto &frameChannel   = worker != nullptr ? worker->process.GetFdChannel() : process.GetFdChannel();
+    auto const &regionFd = worker != nullptr ? worker->responseRegionFd : responseRegionFd;
+    // Frames are viewed in the channel's buffer and are only valid until the next one is read
+    auto frames = frameChannel.Frames();
+    while (auto const frame = frames.Next())
     {
-        std::string_view data(reinterpret_cast<char const *>(frame.data()), frame.size());
+        std::string_view data(reinterpret_cast<char const *>(frame->data()), frame->size());
         auto const &version = GetStructVersion(data);
         switch (version)
         {
             case dcgmDiagStatus_version1:
                 UpdateDiagStatus(data);
                 break;
+            case dcgmDiagTestCompletion_version1:
+                response.NotifyTestCompleted(data);
+                break;
             case dcgmDiagResponse_version11:
             case dcgmDiagResponse_version10:
             case dcgmDiagResponse_version9:
             case dcgmDiagResponse_version8:
             case dcgmDiagResponse_version7:
             {
-                auto const &ret = response.SetResult(data);
+                auto const handlingStart = std::chrono::steady_clock::now();
+                auto const &ret          = response.SetResult(data);
+                responseHandlingTime += std::chrono::steady_clock::now() - handlingStart;
                 if (ret != DCGM_ST_OK)
                 {
                     log_error("failed to set results, err: [{}]", ret);
@@ -816,11 +1068,35 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
                 receivedResultFrameNum += 1;
                 break;
             }
+            case dcgmDiagResponseReady_version1:
+            {
+                auto const handlingStart = std::chrono::steady_clock::now();
+                auto const ret           = SetResultFromResponseRegion(regionFd, data, response);
+                responseHandlingTime += std::chrono::steady_clock::now() - handlingStart;
+                if (ret != DCGM_ST_OK)
+                {
+                    log_error("failed to set results from the response region, err: [{}]", ret);
+                    return ret;
+                }
+                receivedResultFrameNum += 1;
+                break;
+            }
+            case dcgmNvvsRunDone_version1:
+            {
+                dcgmNvvsRunDone_v1 done {};
+                if (data.size() == sizeof(done))
+                {
+                    memcpy(&done, data.data(), sizeof(done));
+                    workerReturnCode = done.returnCode;
+                }
+                break;
+            }
             default:
                 log_error("Unexpected struct with version {} from nvvs channel", version);
         }
-        // Discard any results received beyond the first result; this is unexpected
-        if (receivedResultFrameNum == 1)
+        // Discard any results received beyond the first result; this is unexpected.
+        // A worker is read up to the end of the run so that the next run starts with its own frames.
+        if ((worker == nullptr && receivedResultFrameNum == 1) || workerReturnCode.has_value())
         {
             break;
         }
@@ -830,6 +1106,51 @@ dcgmReturn_t DcgmDiagManager::PerformExternalCommand(std::vector<std::string> &a
         log_error("Diag result struct not received from NVVS.");
     }
 
+    {
+        /* The phases within NVVS are reported with each test. These are the ones it can't see */
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        auto const runTime = std::chrono::steady_clock::now() - launched - responseHandlingTime;
+        log_info("NVVS (PID {}) took {} ms to launch{}, {} ms to run and {} ms to hand over its response",
+                 pid,
+                 duration_cast<milliseconds>(launched - launchStart).count(),
+                 worker != nullptr ? " as a worker" : "",
+                 duration_cast<milliseconds>(runTime).count(),
+                 duration_cast<milliseconds>(responseHandlingTime).count());
+    }
+
+    if (worker != nullptr && workerReturnCode.has_value())
+    {
+        // The worker keeps running, so only take what it has written so far
+        auto const stdoutLines = worker->process.StdOut().TakeBuffered();
+        *stdoutStr             = fmt::to_string(fmt::join(stdoutLines, "\n"));
+        auto const stderrLines = worker->process.StdErr().TakeBuffered();
+        *stderrStr             = fmt::to_string(fmt::join(stderrLines, "\n"));
+        DCGM_LOG_DEBUG << "nvvs worker stdout: " << SanitizedString(*stdoutStr);
+        DCGM_LOG_DEBUG << "nvvs worker stderr: " << SanitizedString(*stderrStr);
+
+        UpdateChildPID(-1, myTicket);
+
+        if (*workerReturnCode == NVVS_ST_TEST_NOT_FOUND)
+        {
+            return DCGM_ST_NVVS_NO_AVAILABLE_TEST;
+        }
+        if (*workerReturnCode != 0)
+        {
+            log_error("The nvvs worker returned a non-zero exit code: {}", *workerReturnCode);
+        }
+        return DCGM_ST_OK;
+    }
+
+    if (worker != nullptr)
+    {
+        // The worker stopped in the middle of the run. Report it like an nvvs that exited
+        DcgmLockGuard lock(&m_mutex);
+        process = std::move(worker->process);
+        m_nvvsWorker.reset();
+        worker = nullptr;
+    }
+
     // Set output string in caller's context
     // Do this before the error check so that if there are errors, we have more useful error messages
     auto &stdoutLines = process.StdOut();
@@ -914,6 +1235,7 @@ dcgmReturn_t DcgmDiagManager::ResetGpuAndEnforceConfig(unsigned int gpuId,
 {
     if (action == DCGM_POLICY_ACTION_GPURESET)
     {
+        m_resultCache.Clear();
         EnforceGPUConfiguration(gpuId, connectionId);
         return DCGM_ST_OK;
     }
@@ -1025,15 +1347,15 @@ std::vector<std::uint32_t> ParseEntityIdsAndFilterGpu(DcgmCoreProxy &coreProxy,
 {
     dcgmReturn_t ret;
 
-    std::vector<dcgmcm_gpu_info_cached_t> gpuInfos;
-    ret = coreProxy.GetAllGpuInfo(gpuInfos);
+    std::shared_ptr<DcgmGpuInventorySnapshot const> inventory;
+    ret = coreProxy.GetGpuInventory(inventory);
     if (ret != DCGM_ST_OK)
     {
         log_error("failed to get gpu info from core proxy: {}", errorString(ret));
         return {};
     }
     std::vector<std::pair<unsigned, std::string>> gpuIdUuids;
-    for (auto const &gpuInfo : gpuInfos)
+    for (auto const &gpuInfo : inventory->gpus)
     {
         // Skip GPUs that are lost to the CM
         if (gpuInfo.status == DcgmEntityStatusLost)
@@ -1146,41 +1468,19 @@ std::tuple<WasExecuted_t, dcgmReturn_t> DcgmDiagManager::RerunEudDiagAsRoot(
         return { wasExecuted, DCGM_ST_OK };
     }
 
-    std::unique_ptr<dcgmDiagResponse_v11> v11;
-    std::unique_ptr<dcgmDiagResponse_v10> v10;
-    std::unique_ptr<dcgmDiagResponse_v9> v9;
-    std::unique_ptr<dcgmDiagResponse_v8> v8;
-    DcgmDiagResponseWrapper eudResponse;
+    if (response.GetVersion() == dcgmDiagResponse_version7)
+    {
+        log_error("dcgmDiagResponse_version7 does not support eud.");
+        return { wasExecuted, DCGM_ST_OK };
+    }
 
-    switch (response.GetVersion())
+    DcgmDiagResponseWrapper eudResponse;
+    if (eudResponse.SetVersionLike(response) != DCGM_ST_OK)
     {
-        case dcgmDiagResponse_version11:
-            v11          = MakeUniqueZero<dcgmDiagResponse_v11>();
-            v11->version = dcgmDiagResponse_version11;
-            eudResponse.SetVersion11(v11.get());
-            break;
-        case dcgmDiagResponse_version10:
-            v10          = MakeUniqueZero<dcgmDiagResponse_v10>();
-            v10->version = dcgmDiagResponse_version10;
-            eudResponse.SetVersion10(v10.get());
-            break;
-        case dcgmDiagResponse_version9:
-            v9          = MakeUniqueZero<dcgmDiagResponse_v9>();
-            v9->version = dcgmDiagResponse_version9;
-            eudResponse.SetVersion9(v9.get());
-            break;
-        case dcgmDiagResponse_version8:
-            v8          = MakeUniqueZero<dcgmDiagResponse_v8>();
-            v8->version = dcgmDiagResponse_version8;
-            eudResponse.SetVersion8(v8.get());
-            break;
-        case dcgmDiagResponse_version7:
-            log_error("dcgmDiagResponse_version7 does not support eud.");
-            return { wasExecuted, DCGM_ST_OK };
-        default:
-            log_error("unknown version: [{}].", response.GetVersion());
-            return { wasExecuted, DCGM_ST_VER_MISMATCH };
+        log_error("unknown version: [{}].", response.GetVersion());
+        return { wasExecuted, DCGM_ST_VER_MISMATCH };
     }
+    eudResponse.SetTestCompletedCallback(response.GetTestCompletedCallback());
 
     auto serviceAccount = GetServiceAccount(m_coreProxy);
     if (!serviceAccount.has_value())
@@ -1304,6 +1604,26 @@ dcgmReturn_t DcgmDiagManager::RunDiag(dcgmRunDiag_v9 *drd, DcgmDiagResponseWrapp
         return DCGM_ST_OK;
     }
 
+    /* The health is read before the diag runs, so that anything that happens while it runs invalidates its result */
+    std::string resultCacheKey;
+    std::vector<DcgmDiagGpuHealth> gpuHealth;
+    bool const useResultCache = m_resultCache.Enabled() && DcgmDiagResultCache::IsCacheable(*drd)
+                                && response.GetVersion() == dcgmDiagResponse_version11
+                                && GetResultCacheKey(*drd, gpuIds, resultCacheKey, gpuHealth) == DCGM_ST_OK;
+    if (useResultCache)
+    {
+        if (auto hit = m_resultCache.Get(resultCacheKey, gpuHealth, timelib_usecSince1970()); hit.has_value())
+        {
+            timelib64_t const ageSec = (timelib_usecSince1970() - hit->completedAt) / 1000000;
+            log_info("Returning the cached result of the same diag that completed {} seconds ago", ageSec);
+            return response.SetCachedResponse(
+                *hit->response,
+                fmt::format("Cached result of the same diag that completed {} seconds ago. The GPUs had no XIDs, "
+                            "ECC errors, resets or MIG changes since.",
+                            ageSec));
+        }
+    }
+
     auto nvvsResults = ExecuteAndParseNvvs(*this, response, drd, fakeGpuIds, entityIds);
     // Some tests require root access. If no tests are found to run, consider re-running them
     // with root privileges to attempt execution again. Need to check again below for NO_AVAILABLE_TEST.
@@ -1355,6 +1675,18 @@ dcgmReturn_t DcgmDiagManager::RunDiag(dcgmRunDiag_v9 *drd, DcgmDiagResponseWrapp
         return nvvsResults.ret;
     }
 
+    if (useResultCache)
+    {
+        auto cachedResponse = std::make_shared<dcgmDiagResponse_v11>();
+        if (response.CopyResponseTo(*cachedResponse) == DCGM_ST_OK)
+        {
+            m_resultCache.Put(std::move(resultCacheKey),
+                              std::move(gpuHealth),
+                              std::move(cachedResponse),
+                              timelib_usecSince1970());
+        }
+    }
+
     return DCGM_ST_OK;
 }
 
@@ -1513,3 +1845,147 @@ dcgmReturn_t DcgmDiagManager::PauseResumeHostEngine(bool pause = false)
     log_debug("PauseResumeHostEngine({}) returns {} ({})", pause, ret, errorString(ret));
     return ret;
 }
+
+dcgmReturn_t DcgmDiagManager::GetResultCacheKey(dcgmRunDiag_v9 const &drd,
+                                                std::vector<unsigned int> const &gpuIds,
+                                                std::string &key,
+                                                std::vector<DcgmDiagGpuHealth> &health)
+{
+    std::shared_ptr<DcgmGpuInventorySnapshot const> inventory;
+    dcgmReturn_t ret = m_coreProxy.GetGpuInventory(inventory);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Got st {} from GetGpuInventory()", ret);
+        return ret;
+    }
+    auto const &gpuInfo = inventory->gpus;
+
+    auto migHierarchy     = std::make_unique<dcgmMigHierarchy_v2>();
+    migHierarchy->version = dcgmMigHierarchy_version2;
+    ret                   = m_coreProxy.GetGpuInstanceHierarchy(*migHierarchy);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Got st {} from GetGpuInstanceHierarchy()", ret);
+        return ret;
+    }
+    unsigned int const numMigEntities = std::min(migHierarchy->count, (unsigned int)DCGM_MAX_HIERARCHY_INFO);
+
+    health.clear();
+    std::vector<dcgmGroupEntityPair_t> entities;
+    for (unsigned int const gpuId : gpuIds)
+    {
+        auto it = std::ranges::find_if(gpuInfo, [gpuId](auto const &info) { return info.gpuId == gpuId; });
+        if (it == gpuInfo.end())
+        {
+            log_debug("gpuId {} is unknown to the cache manager", gpuId);
+            return DCGM_ST_BADPARAM;
+        }
+
+        /* XIDs are only seen by the cache manager while they are watched. Keep the latest one as long as a result
+           can be reused */
+        bool wereFirstWatcher = false;
+
+        ret = m_coreProxy.AddFieldWatch(DCGM_FE_GPU,
+                                        gpuId,
+                                        DCGM_FI_DEV_XID_ERRORS,
+                                        1000000,
+                                        (double)m_resultCache.MaxAgeUsec() / 1000000,
+                                        1,
+                                        DcgmWatcher(DcgmWatcherTypeDiagManager),
+                                        false,
+                                        true,
+                                        wereFirstWatcher);
+        if (ret != DCGM_ST_OK)
+        {
+            log_error("Got st {} from AddFieldWatch() of XIDs of gpuId {}", ret, gpuId);
+            return ret;
+        }
+
+        DcgmDiagGpuHealth gpuHealth;
+        gpuHealth.uuid = it->uuid;
+        for (unsigned int i = 0; i < numMigEntities; i++)
+        {
+            dcgmMigEntityInfo_t const &info = migHierarchy->entityList[i].info;
+            if (gpuHealth.uuid == info.gpuUuid)
+            {
+                gpuHealth.migInstances += fmt::format(
+                    "{}/{}:{},", info.nvmlInstanceId, info.nvmlComputeInstanceId, info.nvmlMigProfileId);
+            }
+        }
+
+        dcgmcm_sample_t sample {};
+        ret = m_coreProxy.GetLatestSample(DCGM_FE_GPU, gpuId, DCGM_FI_DEV_XID_ERRORS, &sample, nullptr);
+        if (ret == DCGM_ST_OK)
+        {
+            gpuHealth.lastXidTimestamp = sample.timestamp;
+        }
+        else if (ret != DCGM_ST_NO_DATA)
+        {
+            log_error("Got st {} from GetLatestSample() of XIDs of gpuId {}", ret, gpuId);
+            return ret;
+        }
+
+        health.push_back(std::move(gpuHealth));
+        entities.push_back({ DCGM_FE_GPU, gpuId });
+    }
+
+    std::vector<unsigned short> const fieldIds = { DCGM_FI_DRIVER_VERSION,
+                                                   DCGM_FI_DEV_ECC_SBE_VOL_TOTAL,
+                                                   DCGM_FI_DEV_ECC_DBE_VOL_TOTAL,
+                                                   DCGM_FI_DEV_ECC_DBE_AGG_TOTAL,
+                                                   DCGM_FI_DEV_MIG_MODE };
+    DcgmFvBuffer fvBuffer;
+    ret = m_coreProxy.GetMultipleLatestLiveSamples(entities, fieldIds, &fvBuffer);
+    if (ret != DCGM_ST_OK)
+    {
+        log_error("Got st {} from GetMultipleLatestLiveSamples()", ret);
+        return ret;
+    }
+
+    std::string driverVersion;
+    dcgmBufferedFvCursor_t cursor = 0;
+    for (dcgmBufferedFv_t *fv = fvBuffer.GetNextFv(&cursor); fv != nullptr; fv = fvBuffer.GetNextFv(&cursor))
+    {
+        auto it = std::ranges::find(gpuIds, fv->entityId);
+        if (it == gpuIds.end())
+        {
+            continue;
+        }
+        DcgmDiagGpuHealth &gpuHealth = health[std::distance(gpuIds.begin(), it)];
+
+        /* Fields that can't be read stay blank, which is part of the health as well */
+        long long const value = fv->status == DCGM_ST_OK ? fv->value.i64 : DCGM_INT64_BLANK;
+        switch (fv->fieldId)
+        {
+            case DCGM_FI_DRIVER_VERSION:
+                if (fv->status == DCGM_ST_OK)
+                {
+                    driverVersion = fv->value.str;
+                }
+                break;
+            case DCGM_FI_DEV_ECC_SBE_VOL_TOTAL:
+                gpuHealth.eccSbeVolTotal = value;
+                break;
+            case DCGM_FI_DEV_ECC_DBE_VOL_TOTAL:
+                gpuHealth.eccDbeVolTotal = value;
+                break;
+            case DCGM_FI_DEV_ECC_DBE_AGG_TOTAL:
+                gpuHealth.eccDbeAggTotal = value;
+                break;
+            case DCGM_FI_DEV_MIG_MODE:
+                gpuHealth.migMode = value;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (driverVersion.empty())
+    {
+        log_debug("The driver version is unknown. Not using cached diag results");
+        return DCGM_ST_NO_DATA;
+    }
+
+    key = DcgmDiagResultCache::MakeKey(drd, driverVersion, health);
+    return DCGM_ST_OK;
+}
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "DcgmDiagResponseWrapper.h"
+#include "DcgmDiagResultCache.h"
 #include "DcgmMutex.h"
 #include "DcgmUtilities.h"
 #include "PluginStrings.h"
@@ -28,6 +29,8 @@
 #include <DcgmCoreProxy.h>
 #include <fmt/format.h>
 #include <json/json.h>
+#include <memory>
+#include <optional>
 #include <unordered_set>
 
 #define NVVS_PLUGIN_DIR "NVVS_PLUGIN_DIR"
@@ -159,6 +162,15 @@ private:
     bool m_amShuttingDown; /* Is the diag manager in the process of shutting down?. This
                               is guarded by m_mutex and only set by ~DcgmDiagManager() */
 
+    /* A long-lived nvvs that runs one diag per request instead of exiting after it */
+    struct NvvsWorker;
+    bool const m_useNvvsWorker;                       /* Run diags with an NvvsWorker. __DCGM_NVVS_WORKER__=1 */
+    mutable std::unique_ptr<NvvsWorker> m_nvvsWorker; /* Guarded by m_mutex while no diag is running */
+
+    /* Results of earlier diags that repeated diags on unchanged GPUs return instead of running.
+       Enabled by __DCGM_DIAG_RESULT_CACHE_SEC__=<max age of a result in seconds> */
+    DcgmDiagResultCache m_resultCache;
+
     /* Map to hold plugin name - plugin test result mapping */
     std::unordered_map<std::string, unsigned short> const m_testNameResultFieldId
         = { { MEMORY_PLUGIN_NAME, DCGM_FI_DEV_DIAG_MEMORY_RESULT },
@@ -242,4 +254,24 @@ private:
      * @param data - dcgmDiagStatus_t struct data
      */
     void UpdateDiagStatus(std::string_view data) const;
+
+    /**
+     * Get the nvvs worker running as serviceAccount, starting one if needed.
+     *
+     * Caller MUST ensure that m_mutex is locked by the calling thread before calling this method.
+     *
+     * @return the worker, or nullptr if one can't be started
+     */
+    NvvsWorker *GetNvvsWorker(std::optional<std::string> const &serviceAccount) const;
+
+    /**
+     * Snapshot the health of gpuIds and make the key of the results of drd on them for m_resultCache.
+     *
+     * @return DCGM_ST_OK on success
+     *         DCGM_ST_* if the health of the GPUs can't be read, in which case no cached result may be used
+     */
+    dcgmReturn_t GetResultCacheKey(dcgmRunDiag_v9 const &drd,
+                                   std::vector<unsigned int> const &gpuIds,
+                                   std::string &key,
+                                   std::vector<DcgmDiagGpuHealth> &health);
 };
@@ -20,14 +20,18 @@
 #include <CpuHelpers.h>
 #include <DcgmLogging.h>
 #include <DcgmStringHelpers.h>
+#include <UniquePtrUtil.h>
 #include <dcgm_errors.h>
 
 #include <cstring>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <sstream>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
 
 const std::string_view denylistName("Denylist");
 const std::string_view nvmlLibName("NVML Library");
@@ -55,6 +59,36 @@ const std::string_view swTestNames[]
 namespace
 {
 
+unsigned int VersionOf(std::monostate)
+{
+    return 0;
+}
+
+unsigned int VersionOf(dcgmDiagResponse_v11 const *)
+{
+    return dcgmDiagResponse_version11;
+}
+
+unsigned int VersionOf(dcgmDiagResponse_v10 const *)
+{
+    return dcgmDiagResponse_version10;
+}
+
+unsigned int VersionOf(dcgmDiagResponse_v9 const *)
+{
+    return dcgmDiagResponse_version9;
+}
+
+unsigned int VersionOf(dcgmDiagResponse_v8 const *)
+{
+    return dcgmDiagResponse_version8;
+}
+
+unsigned int VersionOf(dcgmDiagResponse_v7 const *)
+{
+    return dcgmDiagResponse_version7;
+}
+
 std::optional<unsigned int> FindTestIdxByName(dcgmDiagResponse_v11 const &diagResponse, std::string_view name)
 {
     for (unsigned int i = 0; i < diagResponse.numTests; ++i)
@@ -397,15 +431,50 @@ dcgmReturn_t MergeEudResponseLegacy(T &dest, T const &src)
 
 } //namespace
 
-DcgmDiagResponseWrapper::DcgmDiagResponseWrapper()
-    : m_version(0)
+DcgmDiagResponseWrapper::DcgmDiagResponseWrapper() = default;
+
+bool DcgmDiagResponseWrapper::StateIsValid() const
 {
-    memset(&m_response, 0, sizeof(m_response));
+    return !std::holds_alternative<std::monostate>(m_response);
 }
 
-bool DcgmDiagResponseWrapper::StateIsValid() const
+template <typename Response>
+dcgmReturn_t DcgmDiagResponseWrapper::SetResponse(Response *response)
 {
-    return m_version != 0;
+    if (StateIsValid())
+    {
+        log_warning(DDRW_VER_ALREADY_SET_FMT, VersionOf(response), GetVersion());
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    m_response = response;
+
+    return DCGM_ST_OK;
+}
+
+template <typename Response>
+Response *DcgmDiagResponseWrapper::Get() const
+{
+    Response *const *response = std::get_if<Response *>(&m_response);
+    return response == nullptr ? nullptr : *response;
+}
+
+template <typename Fn>
+bool DcgmDiagResponseWrapper::VisitResponse(Fn &&fn) const
+{
+    return std::visit(
+        [&](auto response) {
+            if constexpr (std::is_same_v<decltype(response), std::monostate>)
+            {
+                return false;
+            }
+            else
+            {
+                fn(response);
+                return true;
+            }
+        },
+        m_response);
 }
 
 /**
@@ -531,183 +600,95 @@ static void AddMessage(dcgmDiagResponse_v11 &response,
  */
 void DcgmDiagResponseWrapper::RecordSystemError(std::string const &sysError) const
 {
-    if (m_version == dcgmDiagResponse_version11)
-    {
-        AddMessage(*(m_response.v11ptr), std::nullopt, sysError, std::nullopt, MsgType::Error);
-    }
-    else if (m_version == dcgmDiagResponse_version10)
-    {
-        SafeCopyTo(m_response.v10ptr->systemError.msg, sysError.c_str());
-        m_response.v10ptr->systemError.code = DCGM_FR_INTERNAL;
-    }
-    else if (m_version == dcgmDiagResponse_version9)
-    {
-        SafeCopyTo(m_response.v9ptr->systemError.msg, sysError.c_str());
-        m_response.v9ptr->systemError.code = DCGM_FR_INTERNAL;
-    }
-    else if (m_version == dcgmDiagResponse_version8)
-    {
-        SafeCopyTo(m_response.v8ptr->systemError.msg, sysError.c_str());
-        m_response.v8ptr->systemError.code = DCGM_FR_INTERNAL;
-    }
-    else if (m_version == dcgmDiagResponse_version7)
-    {
-        SafeCopyTo(m_response.v7ptr->systemError.msg, sysError.c_str());
-        m_response.v7ptr->systemError.code = DCGM_FR_INTERNAL;
-    }
-    else
+    bool const isSet = VisitResponse([&](auto *response) {
+        if constexpr (std::is_same_v<decltype(response), dcgmDiagResponse_v11 *>)
+        {
+            AddMessage(*response, std::nullopt, sysError, std::nullopt, MsgType::Error);
+        }
+        else
+        {
+            SafeCopyTo(response->systemError.msg, sysError.c_str());
+            response->systemError.code = DCGM_FR_INTERNAL;
+        }
+    });
+
+    if (!isSet)
     {
-        log_error(DDRW_VER_NOT_HANDLED_FMT, m_version);
+        log_error(DDRW_VER_NOT_HANDLED_FMT, GetVersion());
     }
 }
 
 dcgmReturn_t DcgmDiagResponseWrapper::SetVersion11(dcgmDiagResponse_v11 *response)
 {
-    if (m_version != 0)
-    {
-        // We don't support setting the version twice
-        return DCGM_ST_NOT_SUPPORTED;
-    }
-
-    m_version         = dcgmDiagResponse_version11;
-    m_response.v11ptr = response;
-
-    return DCGM_ST_OK;
+    return SetResponse(response);
 }
 
 dcgmReturn_t DcgmDiagResponseWrapper::SetVersion10(dcgmDiagResponse_v10 *response)
 {
-    if (m_version != 0)
-    {
-        log_warning(DDRW_VER_ALREADY_SET_FMT, dcgmDiagResponse_version10, m_version);
-        return DCGM_ST_NOT_SUPPORTED;
-    }
-
-    m_version         = dcgmDiagResponse_version10;
-    m_response.v10ptr = response;
-
-    return DCGM_ST_OK;
+    return SetResponse(response);
 }
 
 dcgmReturn_t DcgmDiagResponseWrapper::SetVersion9(dcgmDiagResponse_v9 *response)
 {
-    if (m_version != 0)
-    {
-        log_warning(DDRW_VER_ALREADY_SET_FMT, dcgmDiagResponse_version9, m_version);
-        return DCGM_ST_NOT_SUPPORTED;
-    }
-
-    m_version        = dcgmDiagResponse_version9;
-    m_response.v9ptr = response;
-
-    return DCGM_ST_OK;
+    return SetResponse(response);
 }
 
 dcgmReturn_t DcgmDiagResponseWrapper::SetVersion8(dcgmDiagResponse_v8 *response)
 {
-    if (m_version != 0)
-    {
-        log_warning(DDRW_VER_ALREADY_SET_FMT, dcgmDiagResponse_version8, m_version);
-        return DCGM_ST_NOT_SUPPORTED;
-    }
-
-    m_version        = dcgmDiagResponse_version8;
-    m_response.v8ptr = response;
-
-    return DCGM_ST_OK;
+    return SetResponse(response);
 }
 
 dcgmReturn_t DcgmDiagResponseWrapper::SetVersion7(dcgmDiagResponse_v7 *response)
 {
-    if (m_version != 0)
-    {
-        log_warning(DDRW_VER_ALREADY_SET_FMT, dcgmDiagResponse_version7, m_version);
-        return DCGM_ST_NOT_SUPPORTED;
-    }
-
-    m_version        = dcgmDiagResponse_version7;
-    m_response.v7ptr = response;
-
-    return DCGM_ST_OK;
+    return SetResponse(response);
 }
 
-dcgmReturn_t DcgmDiagResponseWrapper::SetResult(std::string_view data) const
+dcgmReturn_t DcgmDiagResponseWrapper::SetVersionLike(DcgmDiagResponseWrapper const &other)
 {
     dcgmReturn_t ret = DCGM_ST_OK;
 
-    switch (m_version)
-    {
-        case dcgmDiagResponse_version11:
-            if (sizeof(*m_response.v11ptr) != data.size())
-            {
-                log_error(
-                    "Cannot set the response via API for version {} due to size mismatch, expected: [{}], got: [{}].",
-                    m_version,
-                    sizeof(*m_response.v11ptr),
-                    data.size());
-                return DCGM_ST_GENERIC_ERROR;
-            }
-            memcpy(m_response.v11ptr, data.data(), data.size());
-            break;
-
-        case dcgmDiagResponse_version10:
-            if (sizeof(*m_response.v10ptr) != data.size())
-            {
-                log_error(
-                    "Cannot set the response via API for version {} due to size mismatch, expected: [{}], got: [{}].",
-                    m_version,
-                    sizeof(*m_response.v10ptr),
-                    data.size());
-                return DCGM_ST_GENERIC_ERROR;
-            }
-            memcpy(m_response.v10ptr, data.data(), data.size());
-            break;
+    bool const isSet = other.VisitResponse([&](auto const *otherResponse) {
+        using Response = std::remove_cvref_t<decltype(*otherResponse)>;
 
-        case dcgmDiagResponse_version9:
-            if (sizeof(*m_response.v9ptr) != data.size())
-            {
-                log_error(
-                    "Cannot set the response via API for version {} due to size mismatch, expected: [{}], got: [{}].",
-                    m_version,
-                    sizeof(*m_response.v9ptr),
-                    data.size());
-                return DCGM_ST_GENERIC_ERROR;
-            }
-            memcpy(m_response.v9ptr, data.data(), data.size());
-            break;
+        auto response     = MakeUniqueZero<Response>();
+        response->version = VersionOf(otherResponse);
+        ret               = SetResponse(response.get());
+        if (ret == DCGM_ST_OK)
+        {
+            m_ownedResponse = std::move(response);
+        }
+    });
 
+    if (!isSet)
+    {
+        log_error(DDRW_NOT_INITIALIZED_FMT);
+        return DCGM_ST_UNINITIALIZED;
+    }
 
-        case dcgmDiagResponse_version8:
-            if (sizeof(*m_response.v8ptr) != data.size())
-            {
-                log_error(
-                    "Cannot set the response via API for version {} due to size mismatch, expected: [{}], got: [{}].",
-                    m_version,
-                    sizeof(*m_response.v8ptr),
-                    data.size());
-                return DCGM_ST_GENERIC_ERROR;
-            }
-            memcpy(m_response.v8ptr, data.data(), data.size());
-            break;
+    return ret;
+}
 
-        case dcgmDiagResponse_version7:
-            if (sizeof(*m_response.v7ptr) != data.size())
-            {
-                log_error(
-                    "Cannot set the response via API for version {} due to size mismatch, expected: [{}], got: [{}].",
-                    m_version,
-                    sizeof(*m_response.v7ptr),
-                    data.size());
-                return DCGM_ST_GENERIC_ERROR;
-            }
-            memcpy(m_response.v7ptr, data.data(), data.size());
-            break;
+dcgmReturn_t DcgmDiagResponseWrapper::SetResult(std::string_view data) const
+{
+    dcgmReturn_t ret = DCGM_ST_GENERIC_ERROR;
 
-        default:
+    bool const isSet = VisitResponse([&](auto *response) {
+        if (sizeof(*response) != data.size())
         {
-            log_error("Cannot set the response via API for version {}", m_version);
-            ret = DCGM_ST_GENERIC_ERROR;
+            log_error(
+                "Cannot set the response via API for version {} due to size mismatch, expected: [{}], got: [{}].",
+                VersionOf(response),
+                sizeof(*response),
+                data.size());
+            return;
         }
+        memcpy(response, data.data(), data.size());
+        ret = DCGM_ST_OK;
+    });
+
+    if (!isSet)
+    {
+        log_error("Cannot set the response via API for version {}", GetVersion());
     }
 
     return ret;
@@ -715,15 +696,16 @@ dcgmReturn_t DcgmDiagResponseWrapper::SetResult(std::string_view data) const
 
 bool DcgmDiagResponseWrapper::HasTest(const std::string &pluginName) const
 {
-    if (m_version != dcgmDiagResponse_version11)
+    dcgmDiagResponse_v11 const *response = Get<dcgmDiagResponse_v11>();
+    if (response == nullptr)
     {
         log_error("HasTest is only supported for version 11 responses - returning false");
         return false;
     }
 
-    for (unsigned int i = 0; i < m_response.v11ptr->numTests; i++)
+    for (unsigned int i = 0; i < response->numTests; i++)
     {
-        if (pluginName == m_response.v11ptr->tests[i].name)
+        if (pluginName == response->tests[i].name)
         {
             return true;
         }
@@ -734,79 +716,59 @@ bool DcgmDiagResponseWrapper::HasTest(const std::string &pluginName) const
 
 dcgmReturn_t DcgmDiagResponseWrapper::MergeEudResponse(DcgmDiagResponseWrapper &eudResponse)
 {
-    if (eudResponse.m_version != m_version)
+    if (eudResponse.GetVersion() != GetVersion())
     {
-        log_error(
-            "Cannot merge EUD results from response version '{}' (must be '{}').", eudResponse.m_version, m_version);
+        log_error("Cannot merge EUD results from response version '{}' (must be '{}').",
+                  eudResponse.GetVersion(),
+                  GetVersion());
         return DCGM_ST_VER_MISMATCH;
     }
 
-    switch (m_version)
-    {
-        case dcgmDiagResponse_version11:
-            return ::MergeEudResponse(*m_response.v11ptr, *eudResponse.m_response.v11ptr);
-        case dcgmDiagResponse_version10:
-            if (m_response.v10ptr->systemError.msg[0] == '\0')
-            {
-                std::memcpy(&m_response.v10ptr->systemError,
-                            &eudResponse.m_response.v10ptr->systemError,
-                            sizeof(eudResponse.m_response.v10ptr->systemError));
-            }
-            ::MergeEudAuxFieldLegacy(*m_response.v10ptr, *eudResponse.m_response.v10ptr);
-            return ::MergeEudResponseLegacy(*m_response.v10ptr, *eudResponse.m_response.v10ptr);
-        case dcgmDiagResponse_version9:
-            if (m_response.v9ptr->systemError.msg[0] == '\0')
+    dcgmReturn_t ret = DCGM_ST_OK;
+
+    VisitResponse([&](auto *dest) {
+        using Response      = std::remove_pointer_t<decltype(dest)>;
+        Response const &src = *eudResponse.Get<Response>();
+
+        if constexpr (std::is_same_v<Response, dcgmDiagResponse_v11>)
+        {
+            ret = ::MergeEudResponse(*dest, src);
+        }
+        else if constexpr (!std::is_same_v<Response, dcgmDiagResponse_v7>) // version7 does not have eud
+        {
+            if (dest->systemError.msg[0] == '\0')
             {
-                std::memcpy(&m_response.v9ptr->systemError,
-                            &eudResponse.m_response.v9ptr->systemError,
-                            sizeof(eudResponse.m_response.v9ptr->systemError));
+                std::memcpy(&dest->systemError, &src.systemError, sizeof(src.systemError));
             }
-            return ::MergeEudResponseLegacy(*m_response.v9ptr, *eudResponse.m_response.v9ptr);
-        case dcgmDiagResponse_version8:
-            if (m_response.v8ptr->systemError.msg[0] == '\0')
+            if constexpr (std::is_same_v<Response, dcgmDiagResponse_v10>)
             {
-                std::memcpy(&m_response.v8ptr->systemError,
-                            &eudResponse.m_response.v8ptr->systemError,
-                            sizeof(eudResponse.m_response.v8ptr->systemError));
+                ::MergeEudAuxFieldLegacy(*dest, src);
             }
-            return ::MergeEudResponseLegacy(*m_response.v8ptr, *eudResponse.m_response.v8ptr);
-        case dcgmDiagResponse_version7:
-            // version7 does not have eud
-        default:
-            break;
-    }
+            ret = ::MergeEudResponseLegacy(*dest, src);
+        }
+    });
 
-    return DCGM_ST_OK;
+    return ret;
 }
 
 dcgmReturn_t DcgmDiagResponseWrapper::AdoptEudResponse(DcgmDiagResponseWrapper &eudResponse)
 {
-    if (eudResponse.m_version != m_version)
+    if (eudResponse.GetVersion() != GetVersion())
     {
-        log_error(
-            "Cannot adopt EUD results from response version '{}' (must be '{}').", eudResponse.m_version, m_version);
+        log_error("Cannot adopt EUD results from response version '{}' (must be '{}').",
+                  eudResponse.GetVersion(),
+                  GetVersion());
         return DCGM_ST_VER_MISMATCH;
     }
 
-    switch (m_version)
-    {
-        case dcgmDiagResponse_version11:
-            std::memcpy(m_response.v11ptr, eudResponse.m_response.v11ptr, sizeof(*m_response.v11ptr));
-            break;
-        case dcgmDiagResponse_version10:
-            std::memcpy(m_response.v10ptr, eudResponse.m_response.v10ptr, sizeof(*m_response.v10ptr));
-            break;
-        case dcgmDiagResponse_version9:
-            std::memcpy(m_response.v9ptr, eudResponse.m_response.v9ptr, sizeof(*m_response.v9ptr));
-            break;
-        case dcgmDiagResponse_version8:
-            std::memcpy(m_response.v8ptr, eudResponse.m_response.v8ptr, sizeof(*m_response.v8ptr));
-            break;
-        case dcgmDiagResponse_version7:
-            // version7 does not have eud
-        default:
-            break;
-    }
+    VisitResponse([&](auto *dest) {
+        using Response = std::remove_pointer_t<decltype(dest)>;
+
+        if constexpr (!std::is_same_v<Response, dcgmDiagResponse_v7>) // version7 does not have eud
+        {
+            std::memcpy(dest, eudResponse.Get<Response>(), sizeof(*dest));
+        }
+    });
 
     return DCGM_ST_OK;
 }
@@ -835,18 +797,19 @@ bool DcgmDiagResponseWrapper::AddCpuSerials()
         return false;
     }
 
-    if (m_version != dcgmDiagResponse_version11)
+    dcgmDiagResponse_v11 *response = Get<dcgmDiagResponse_v11>();
+    if (response == nullptr)
     {
         log_error("AddCpuSerials is only supported for version 11 responses - returning false");
         return false;
     }
 
-    unsigned int const numEntities = std::min(static_cast<unsigned int>(m_response.v11ptr->numEntities),
+    unsigned int const numEntities = std::min(static_cast<unsigned int>(response->numEntities),
                                               static_cast<unsigned int>(DCGM_DIAG_RESPONSE_ENTITIES_MAX));
     bool hasCpuEntities            = false;
     for (unsigned int i = 0; i < numEntities; ++i)
     {
-        if (m_response.v11ptr->entities[i].entity.entityGroupId == DCGM_FE_CPU)
+        if (response->entities[i].entity.entityGroupId == DCGM_FE_CPU)
         {
             hasCpuEntities = true;
             break;
@@ -869,19 +832,19 @@ bool DcgmDiagResponseWrapper::AddCpuSerials()
 
     for (unsigned int i = 0; i < numEntities; ++i)
     {
-        if (m_response.v11ptr->entities[i].entity.entityGroupId != DCGM_FE_CPU)
+        if (response->entities[i].entity.entityGroupId != DCGM_FE_CPU)
         {
             continue;
         }
-        if (m_response.v11ptr->entities[i].entity.entityId >= cpuSerials->size())
+        if (response->entities[i].entity.entityId >= cpuSerials->size())
         {
             log_error("CPU entity id [{}] is not expected and exceed the size of serials [{}].",
-                      m_response.v11ptr->entities[i].entity.entityId,
+                      response->entities[i].entity.entityId,
                       cpuSerials->size());
             return false;
         }
-        SafeCopyTo(m_response.v11ptr->entities[i].serialNum,
-                   cpuSerials.value()[m_response.v11ptr->entities[i].entity.entityId].c_str());
+        SafeCopyTo(response->entities[i].serialNum,
+                   cpuSerials.value()[response->entities[i].entity.entityId].c_str());
     }
     return true;
 }
@@ -893,24 +856,92 @@ std::string DcgmDiagResponseWrapper::GetSystemErr() const
         return "ERROR: Must initialize DcgmDiagResponseWrapper before using.";
     }
 
-    switch (m_version)
+    std::string sysErr;
+    VisitResponse([&](auto const *response) {
+        if constexpr (std::is_same_v<decltype(response), dcgmDiagResponse_v11 const *>)
+        {
+            sysErr = GetSystemErrV11(*response);
+        }
+        else
+        {
+            sysErr = response->systemError.msg;
+        }
+    });
+    return sysErr;
+}
+
+unsigned int DcgmDiagResponseWrapper::GetVersion() const
+{
+    return std::visit([](auto const &response) { return VersionOf(response); }, m_response);
+}
+
+dcgmReturn_t DcgmDiagResponseWrapper::CopyResponseTo(dcgmDiagResponse_v11 &out) const
+{
+    if (!StateIsValid())
     {
-        case dcgmDiagResponse_version11:
-            return GetSystemErrV11(*m_response.v11ptr);
-        case dcgmDiagResponse_version10:
-            return m_response.v10ptr->systemError.msg;
-        case dcgmDiagResponse_version9:
-            return m_response.v9ptr->systemError.msg;
-        case dcgmDiagResponse_version8:
-            return m_response.v8ptr->systemError.msg;
-        case dcgmDiagResponse_version7:
-            return m_response.v7ptr->systemError.msg;
-        default:
-            return fmt::format("Unknown version [{}].", m_version);
+        log_error("ERROR: Must initialize DcgmDiagResponseWrapper before using.");
+        return DCGM_ST_UNINITIALIZED;
     }
+    dcgmDiagResponse_v11 const *response = Get<dcgmDiagResponse_v11>();
+    if (response == nullptr)
+    {
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    std::memcpy(&out, response, sizeof(out));
+    return DCGM_ST_OK;
 }
 
-unsigned int DcgmDiagResponseWrapper::GetVersion() const
+dcgmReturn_t DcgmDiagResponseWrapper::SetCachedResponse(dcgmDiagResponse_v11 const &cached, std::string const &msg)
+{
+    if (!StateIsValid())
+    {
+        log_error("ERROR: Must initialize DcgmDiagResponseWrapper before using.");
+        return DCGM_ST_UNINITIALIZED;
+    }
+    dcgmDiagResponse_v11 *response = Get<dcgmDiagResponse_v11>();
+    if (response == nullptr)
+    {
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    std::memcpy(response, &cached, sizeof(cached));
+    unsigned int const numTests = std::min(static_cast<unsigned int>(response->numTests),
+                                           static_cast<unsigned int>(DCGM_DIAG_RESPONSE_TESTS_MAX));
+    for (unsigned int i = 0; i < numTests; i++)
+    {
+        AddInfoMessage(*response, i, msg, std::nullopt);
+    }
+    return DCGM_ST_OK;
+}
+
+void DcgmDiagResponseWrapper::SetTestCompletedCallback(TestCompletedCallback callback)
+{
+    m_testCompletedCallback = std::move(callback);
+}
+
+DcgmDiagResponseWrapper::TestCompletedCallback const &DcgmDiagResponseWrapper::GetTestCompletedCallback() const
 {
-    return m_version;
+    return m_testCompletedCallback;
+}
+
+dcgmReturn_t DcgmDiagResponseWrapper::NotifyTestCompleted(std::string_view data) const
+{
+    if (!m_testCompletedCallback)
+    {
+        return DCGM_ST_OK;
+    }
+
+    if (data.size() != sizeof(dcgmDiagTestCompletion_v1))
+    {
+        log_error("Test completion size mismatch, expected: [{}], got: [{}].",
+                  sizeof(dcgmDiagTestCompletion_v1),
+                  data.size());
+        return DCGM_ST_GENERIC_ERROR;
+    }
+
+    auto completion = std::make_unique<dcgmDiagTestCompletion_v1>();
+    memcpy(completion.get(), data.data(), data.size());
+    m_testCompletedCallback(*completion);
+    return DCGM_ST_OK;
 }
@@ -16,7 +16,10 @@
 #ifndef DCGM_DIAG_RESPONSE_WRAPPER_H
 #define DCGM_DIAG_RESPONSE_WRAPPER_H
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <variant>
 
 #include "dcgm_structs.h"
 #include "json/json.h"
@@ -46,11 +49,19 @@ enum class MsgType
 
 /*****************************************************************************/
 /*
- * Class for handling the different versions of the diag response
+ * Class for handling the different versions of the diag response.
+ *
+ * NVVS writes the response in the version the client asked for, so the
+ * response is never converted between versions. Each method handles every
+ * version it supports with one visit of m_response.
  */
 class DcgmDiagResponseWrapper
 {
 public:
+    /*****************************************************************************/
+    /* Called with the results of each test as NVVS completes it */
+    using TestCompletedCallback = std::function<void(dcgmDiagTestCompletion_v1 const &)>;
+
     /*****************************************************************************/
     DcgmDiagResponseWrapper();
 
@@ -64,6 +75,13 @@ public:
     dcgmReturn_t SetVersion8(dcgmDiagResponse_v8 *response);
     dcgmReturn_t SetVersion7(dcgmDiagResponse_v7 *response);
 
+    /*****************************************************************************/
+    /*
+     * Set the response to a zeroed response of the same version as other's.
+     * The response is owned by this wrapper
+     */
+    dcgmReturn_t SetVersionLike(DcgmDiagResponseWrapper const &other);
+
     /*****************************************************************************/
     dcgmReturn_t SetResult(std::string_view data) const;
 
@@ -81,22 +99,68 @@ public:
 
     unsigned int GetVersion() const;
 
+    /*****************************************************************************/
+    /*
+     * Copy the response to out. Only version 11 responses can be copied
+     */
+    dcgmReturn_t CopyResponseTo(dcgmDiagResponse_v11 &out) const;
+
+    /*****************************************************************************/
+    /*
+     * Replace the response with cached, the response of an earlier run, and add
+     * msg as info to each of its tests to mark them as cached
+     */
+    dcgmReturn_t SetCachedResponse(dcgmDiagResponse_v11 const &cached, std::string const &msg);
+
+    /*****************************************************************************/
+    void SetTestCompletedCallback(TestCompletedCallback callback);
+    TestCompletedCallback const &GetTestCompletedCallback() const;
+
+    /*****************************************************************************/
+    /*
+     * Pass data, a dcgmDiagTestCompletion_v1 from NVVS, to the test completed
+     * callback. Does nothing if there is no callback
+     */
+    dcgmReturn_t NotifyTestCompleted(std::string_view data) const;
+
 #ifndef __DIAG_UNIT_TESTING__
 private:
 #endif
-    union
-    {
-        dcgmDiagResponse_v11 *v11ptr; // A pointer to the version11 struct
-        dcgmDiagResponse_v10 *v10ptr; //!< Deprecated. A pointer to the version10 struct
-        dcgmDiagResponse_v9 *v9ptr;   //!< Deprecated. A pointer to the version9 struct
-        dcgmDiagResponse_v8 *v8ptr;   //!< Deprecated. A pointer to the version8 struct
-        dcgmDiagResponse_v7 *v7ptr;   //!< Deprecated. A pointer to the version7 struct
-    } m_response;
+    /* The response, whose version is its type. Versions 10 and below are deprecated */
+    std::variant<std::monostate,
+                 dcgmDiagResponse_v11 *,
+                 dcgmDiagResponse_v10 *,
+                 dcgmDiagResponse_v9 *,
+                 dcgmDiagResponse_v8 *,
+                 dcgmDiagResponse_v7 *>
+        m_response;
 
-    unsigned int m_version; //!< records the version of our dcgmDiagResponse_t
+    std::shared_ptr<void> m_ownedResponse; //!< Set if the response was allocated by SetVersionLike()
+
+    TestCompletedCallback m_testCompletedCallback; //!< Empty unless the caller streams per-test results
 
     /*****************************************************************************/
     bool StateIsValid() const;
+
+    /*****************************************************************************/
+    template <typename Response>
+    dcgmReturn_t SetResponse(Response *response);
+
+    /*****************************************************************************/
+    /*
+     * RETURNS: The response if it is a Response, nullptr otherwise
+     */
+    template <typename Response>
+    Response *Get() const;
+
+    /*****************************************************************************/
+    /*
+     * Call fn with the response, whatever its version
+     *
+     * RETURNS: false if there is no response
+     */
+    template <typename Fn>
+    bool VisitResponse(Fn &&fn) const;
 };
 
 #endif
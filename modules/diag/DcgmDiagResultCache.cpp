@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmDiagResultCache.h"
+
+#include <DcgmLogging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+
+/*****************************************************************************/
+DcgmDiagResultCache::DcgmDiagResultCache(timelib64_t maxAgeUsec, std::size_t maxEntries)
+    : m_maxAgeUsec(std::max(maxAgeUsec, (timelib64_t)0))
+    , m_maxEntries(std::max(maxEntries, (std::size_t)1))
+{}
+
+/*****************************************************************************/
+bool DcgmDiagResultCache::IsCacheable(dcgmRunDiag_v9 const &drd)
+{
+    if (drd.totalIterations > 1)
+    {
+        return false;
+    }
+    return (drd.flags & (DCGM_RUN_FLAGS_TRAIN | DCGM_RUN_FLAGS_FORCE_TRAIN)) == 0;
+}
+
+/*****************************************************************************/
+std::string DcgmDiagResultCache::MakeKey(dcgmRunDiag_v9 const &drd,
+                                         std::string const &driverVersion,
+                                         std::vector<DcgmDiagGpuHealth> const &health)
+{
+    /* Fields are separated by a character that can't be part of any of them */
+    std::string key = fmt::format("{}\x1f{}\x1f{}\x1f{}\x1f{}\x1f{}",
+                                  driverVersion,
+                                  static_cast<int>(drd.validate),
+                                  drd.flags,
+                                  drd.timeoutSeconds,
+                                  drd.failCheckInterval,
+                                  drd.watchFrequency);
+
+    auto append = [&key](char const *str, std::size_t maxLen) {
+        key += '\x1f';
+        key.append(str, strnlen(str, maxLen));
+    };
+
+    for (auto const &gpu : health)
+    {
+        append(gpu.uuid.c_str(), gpu.uuid.size());
+    }
+    for (auto const &testName : drd.testNames)
+    {
+        append(testName, sizeof(testName));
+    }
+    for (auto const &testParm : drd.testParms)
+    {
+        append(testParm, sizeof(testParm));
+    }
+    append(drd.clocksEventMask, sizeof(drd.clocksEventMask));
+    append(drd.configFileContents, sizeof(drd.configFileContents));
+    return key;
+}
+
+/*****************************************************************************/
+std::optional<DcgmDiagResultCache::Hit> DcgmDiagResultCache::Get(std::string const &key,
+                                                                 std::vector<DcgmDiagGpuHealth> const &health,
+                                                                 timelib64_t now)
+{
+    if (!Enabled())
+    {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return std::nullopt;
+    }
+
+    if (now - it->second.completedAt > m_maxAgeUsec)
+    {
+        log_debug("Dropping the cached diag result from {} usec ago: too old", now - it->second.completedAt);
+        m_entries.erase(it);
+        return std::nullopt;
+    }
+
+    if (it->second.health != health)
+    {
+        log_info("Dropping the cached diag result: the GPUs had XIDs, ECC errors, a reset or a MIG change since");
+        m_entries.erase(it);
+        return std::nullopt;
+    }
+
+    return Hit { it->second.response, it->second.completedAt };
+}
+
+/*****************************************************************************/
+void DcgmDiagResultCache::Put(std::string key,
+                              std::vector<DcgmDiagGpuHealth> health,
+                              std::shared_ptr<dcgmDiagResponse_v11 const> response,
+                              timelib64_t completedAt)
+{
+    if (!Enabled() || response == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+
+    if (response->numErrors > 0)
+    {
+        /* Failures are always run again */
+        m_entries.erase(key);
+        return;
+    }
+
+    if (!m_entries.contains(key) && m_entries.size() >= m_maxEntries)
+    {
+        auto oldest = std::ranges::min_element(
+            m_entries, [](auto const &a, auto const &b) { return a.second.completedAt < b.second.completedAt; });
+        m_entries.erase(oldest);
+    }
+
+    m_entries[std::move(key)] = Entry { std::move(health), std::move(response), completedAt };
+}
+
+/*****************************************************************************/
+void DcgmDiagResultCache::Clear()
+{
+    std::lock_guard<std::mutex> lg(m_mutex);
+    m_entries.clear();
+}
+
+/*****************************************************************************/
+std::size_t DcgmDiagResultCache::Size() const
+{
+    std::lock_guard<std::mutex> lg(m_mutex);
+    return m_entries.size();
+}
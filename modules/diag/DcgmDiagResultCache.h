@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <dcgm_structs.h>
+#include <timelib.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Health state of a GPU that a diag result depends on. The result of a diag is
+ * reused only while all of this stays the same
+ */
+struct DcgmDiagGpuHealth
+{
+    std::string uuid;
+    timelib64_t lastXidTimestamp = 0;                /* Timestamp of the latest XID of the GPU. 0 if there was none */
+    long long eccSbeVolTotal     = DCGM_INT64_BLANK; /* Volatile counters are cleared by a GPU reset */
+    long long eccDbeVolTotal     = DCGM_INT64_BLANK;
+    long long eccDbeAggTotal     = DCGM_INT64_BLANK;
+    long long migMode            = DCGM_INT64_BLANK;
+    std::string migInstances;                        /* GPU and compute instances with their profiles */
+
+    bool operator==(DcgmDiagGpuHealth const &) const = default;
+};
+
+/*****************************************************************************/
+/*
+ * Results of earlier diags, so that a diag repeated on GPUs that haven't
+ * changed since can return right away. Results are keyed by the GPUs, the
+ * tests and their parameters, and the driver version. Thread safe.
+ */
+class DcgmDiagResultCache
+{
+public:
+    static constexpr std::size_t c_defaultMaxEntries = 8;
+
+    struct Hit
+    {
+        std::shared_ptr<dcgmDiagResponse_v11 const> response;
+        timelib64_t completedAt; /* When the diag that produced response completed */
+    };
+
+    /*************************************************************************/
+    /*
+     * maxAgeUsec: How long a result can be reused for. 0 disables the cache
+     */
+    explicit DcgmDiagResultCache(timelib64_t maxAgeUsec, std::size_t maxEntries = c_defaultMaxEntries);
+
+    bool Enabled() const
+    {
+        return m_maxAgeUsec > 0;
+    }
+
+    timelib64_t MaxAgeUsec() const
+    {
+        return m_maxAgeUsec;
+    }
+
+    /*************************************************************************/
+    /*
+     * Whether the result of drd can be reused. Runs of several iterations and
+     * training runs always run
+     */
+    static bool IsCacheable(dcgmRunDiag_v9 const &drd);
+
+    /*************************************************************************/
+    /*
+     * Key of the results of drd on the GPUs of health with the given driver
+     */
+    static std::string MakeKey(dcgmRunDiag_v9 const &drd,
+                               std::string const &driverVersion,
+                               std::vector<DcgmDiagGpuHealth> const &health);
+
+    /*************************************************************************/
+    /*
+     * Get the result stored for key if it is younger than the max age and
+     * health, the current health of its GPUs, is what it was when the diag
+     * started. Stale results are dropped
+     */
+    std::optional<Hit> Get(std::string const &key, std::vector<DcgmDiagGpuHealth> const &health, timelib64_t now);
+
+    /*************************************************************************/
+    /*
+     * Store the response of a diag that completed at completedAt. health is
+     * the health of its GPUs from before the diag started, so that anything
+     * that happened while it ran invalidates the result. Responses with
+     * errors are not stored. The oldest result is dropped when the cache is
+     * full
+     */
+    void Put(std::string key,
+             std::vector<DcgmDiagGpuHealth> health,
+             std::shared_ptr<dcgmDiagResponse_v11 const> response,
+             timelib64_t completedAt);
+
+    /*************************************************************************/
+    /* Drop all results, e.g. after a GPU was reset */
+    void Clear();
+
+    std::size_t Size() const;
+
+private:
+    struct Entry
+    {
+        std::vector<DcgmDiagGpuHealth> health;
+        std::shared_ptr<dcgmDiagResponse_v11 const> response;
+        timelib64_t completedAt;
+    };
+
+    timelib64_t const m_maxAgeUsec;
+    std::size_t const m_maxEntries;
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Entry> m_entries; /* Guarded by m_mutex */
+};
@@ -20,6 +20,7 @@
 #include <DcgmDiagResponseWrapper.h>
 #include <DcgmLogging.h>
 #include <DcgmStringHelpers.h>
+#include <Defer.hpp>
 #include <dcgm_api_export.h>
 #include <dcgm_structs.h>
 
@@ -317,7 +318,8 @@ dcgmReturn_t DcgmModuleDiag::ProcessRun_v9(dcgm_diag_msg_run_v9 *msg)
     return dcgmReturn;
 }
 
-dcgmReturn_t DcgmModuleDiag::ProcessRun_v10(dcgm_diag_msg_run_v10 *msg)
+dcgmReturn_t DcgmModuleDiag::ProcessRun_v10(dcgm_diag_msg_run_v10 *msg,
+                                            DcgmDiagResponseWrapper::TestCompletedCallback onTestCompleted)
 {
     dcgmReturn_t dcgmReturn;
     DcgmDiagResponseWrapper drw;
@@ -329,6 +331,7 @@ dcgmReturn_t DcgmModuleDiag::ProcessRun_v10(dcgm_diag_msg_run_v10 *msg)
     }
 
     drw.SetVersion11(&msg->diagResponse);
+    drw.SetTestCompletedCallback(std::move(onTestCompleted));
 
     /* Sanitize the inputs */
     dcgmTerminateCharBuffer(msg->runDiag.fakeGpuList);
@@ -360,6 +363,54 @@ dcgmReturn_t DcgmModuleDiag::ProcessRun_v10(dcgm_diag_msg_run_v10 *msg)
     return dcgmReturn;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleDiag::ProcessRunStreaming(dcgm_module_command_header_t *moduleCommand)
+{
+    dcgm_connection_id_t const connectionId = moduleCommand->connectionId;
+    dcgm_request_id_t const requestId       = moduleCommand->requestId;
+
+    if (requestId == DCGM_REQUEST_ID_NONE)
+    {
+        log_error("A streaming diagnostic needs a request to send its tests to");
+        return DCGM_ST_BADPARAM;
+    }
+
+    /* The request gets no more tests, whether or not the diag ran. Sent before the response so that it arrives
+       after the last test */
+    DcgmNs::Defer completeRequest([&] { m_coreProxy.NotifyRequestOfCompletion(connectionId, requestId); });
+
+    if (m_isPaused.load(std::memory_order_relaxed))
+    {
+        log_info("The Diag module is paused. Ignoring the run command.");
+        return DCGM_ST_PAUSED;
+    }
+    if (moduleCommand->version != dcgm_diag_msg_run_version10)
+    {
+        log_error("Version mismatch {} != {}", moduleCommand->version, dcgm_diag_msg_run_version10);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    auto onTestCompleted = [this, connectionId, requestId](dcgmDiagTestCompletion_v1 const &completion) {
+        log_debug("Sending completed test {} to connectionId {} requestId {}",
+                  completion.testName,
+                  connectionId,
+                  requestId);
+        dcgmReturn_t ret = m_coreProxy.SendRawMessageToClient(connectionId,
+                                                              DCGM_MSG_DIAG_TEST_NOTIFY,
+                                                              requestId,
+                                                              const_cast<dcgmDiagTestCompletion_v1 *>(&completion),
+                                                              sizeof(completion),
+                                                              DCGM_ST_OK);
+        if (ret != DCGM_ST_OK)
+        {
+            /* The client may have gone away. The run itself goes on */
+            log_debug("Unable to send completed test {}: {}", completion.testName, errorString(ret));
+        }
+    };
+
+    return ProcessRun_v10(std::bit_cast<dcgm_diag_msg_run_v10 *>(moduleCommand), onTestCompleted);
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleDiag::ProcessStop(dcgm_diag_msg_stop_t * /* msg */)
 {
@@ -454,6 +505,10 @@ dcgmReturn_t DcgmModuleDiag::ProcessMessage(dcgm_module_command_header_t *module
                 }
                 break;
 
+            case DCGM_DIAG_SR_RUN_STREAMING:
+                retSt = ProcessRunStreaming(moduleCommand);
+                break;
+
             case DCGM_DIAG_SR_STOP:
                 retSt = ProcessStop((dcgm_diag_msg_stop_t *)moduleCommand);
                 break;
@@ -17,6 +17,7 @@
 #define DCGMMODULEDIAG_H
 
 #include "DcgmDiagManager.h"
+#include "DcgmDiagResponseWrapper.h"
 #include "DcgmModule.h"
 #include "dcgm_diag_structs.h"
 
@@ -42,7 +43,9 @@ private:
     /*************************************************************************/
     /* Subrequest helpers
      */
-    dcgmReturn_t ProcessRun_v10(dcgm_diag_msg_run_v10 *msg);
+    dcgmReturn_t ProcessRun_v10(dcgm_diag_msg_run_v10 *msg,
+                                DcgmDiagResponseWrapper::TestCompletedCallback onTestCompleted = {});
+    dcgmReturn_t ProcessRunStreaming(dcgm_module_command_header_t *moduleCommand);
     dcgmReturn_t ProcessRun_v9(dcgm_diag_msg_run_v9 *msg);
     dcgmReturn_t ProcessRun_v8(dcgm_diag_msg_run_v8 *msg);
     dcgmReturn_t ProcessRun_v7(dcgm_diag_msg_run_v7 *msg);
@@ -20,9 +20,11 @@
 
 /*****************************************************************************/
 /* Introspect Subrequest IDs */
-#define DCGM_DIAG_SR_RUN   1
-#define DCGM_DIAG_SR_STOP  2
-#define DCGM_DIAG_SR_COUNT 2 /* Keep as last entry with same value as highest number */
+#define DCGM_DIAG_SR_RUN           1
+#define DCGM_DIAG_SR_STOP          2
+#define DCGM_DIAG_SR_RUN_STREAMING 3 /* DCGM_DIAG_SR_RUN that also sends each completed test to the requester as a
+                                        DCGM_MSG_DIAG_TEST_NOTIFY. Only takes dcgm_diag_msg_run_v10 */
+#define DCGM_DIAG_SR_COUNT         3 /* Keep as last entry with same value as highest number */
 
 /*****************************************************************************/
 /* Subrequest message definitions */
@@ -36,7 +36,8 @@ TEST_CASE("DcgmDiagResponseWrapper: HasTest")
 
         REQUIRE(ddr.SetVersion11(&dr11) == DCGM_ST_OK);
 
-        ddr.m_version = dcgmDiagResponse_version9;
+        auto dr9       = std::make_unique<dcgmDiagResponse_v9>();
+        ddr.m_response = dr9.get();
         CHECK(ddr.HasTest(capoo) == false);
         CHECK(ddr.HasTest("dogdog") == false);
     }
@@ -675,4 +676,55 @@ TEST_CASE("DcgmDiagResponseWrapper: AdoptEudResponse")
 
         REQUIRE(dest.AdoptEudResponse(src) == DCGM_ST_VER_MISMATCH);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("DcgmDiagResponseWrapper: SetCachedResponse")
+{
+    auto cached      = MakeUniqueZero<dcgmDiagResponse_v11>();
+    cached->version  = dcgmDiagResponse_version11;
+    cached->numTests = 2;
+    SafeCopyTo(cached->tests[0].name, "software");
+    SafeCopyTo(cached->tests[1].name, "memory");
+
+    DcgmDiagResponseWrapper ddr;
+    auto dr11 = MakeUniqueZero<dcgmDiagResponse_v11>();
+    REQUIRE(ddr.SetVersion11(dr11.get()) == DCGM_ST_OK);
+    REQUIRE(ddr.SetCachedResponse(*cached, "cached") == DCGM_ST_OK);
+
+    CHECK(ddr.HasTest("memory"));
+    REQUIRE(dr11->numInfo == 2);
+    CHECK(std::string_view(dr11->info[0].msg) == "cached");
+    CHECK(dr11->info[1].testId == 1);
+    CHECK(dr11->tests[1].numInfo == 1);
+
+    auto copy = MakeUniqueZero<dcgmDiagResponse_v11>();
+    REQUIRE(ddr.CopyResponseTo(*copy) == DCGM_ST_OK);
+    CHECK(copy->numInfo == 2);
+
+    DcgmDiagResponseWrapper ddr10;
+    auto dr10 = MakeUniqueZero<dcgmDiagResponse_v10>();
+    REQUIRE(ddr10.SetVersion10(dr10.get()) == DCGM_ST_OK);
+    CHECK(ddr10.SetCachedResponse(*cached, "cached") == DCGM_ST_VER_MISMATCH);
+    CHECK(ddr10.CopyResponseTo(*copy) == DCGM_ST_VER_MISMATCH);
+}
+
+TEST_CASE("DcgmDiagResponseWrapper: SetVersionLike")
+{
+    DcgmDiagResponseWrapper empty;
+    DcgmDiagResponseWrapper like;
+    CHECK(like.SetVersionLike(empty) == DCGM_ST_UNINITIALIZED);
+
+    DcgmDiagResponseWrapper ddr;
+    auto dr10 = MakeUniqueZero<dcgmDiagResponse_v10>();
+    SafeCopyTo(dr10->systemError.msg, "capoo");
+    REQUIRE(ddr.SetVersion10(dr10.get()) == DCGM_ST_OK);
+
+    REQUIRE(like.SetVersionLike(ddr) == DCGM_ST_OK);
+    CHECK(like.GetVersion() == dcgmDiagResponse_version10);
+    CHECK(like.GetSystemErr().empty());
+    CHECK(like.SetVersionLike(ddr) == DCGM_ST_NOT_SUPPORTED);
+
+    like.RecordSystemError("dogdog");
+    REQUIRE(ddr.AdoptEudResponse(like) == DCGM_ST_OK);
+    CHECK(ddr.GetSystemErr() == "dogdog");
+    CHECK(dr10->version == dcgmDiagResponse_version10);
+}
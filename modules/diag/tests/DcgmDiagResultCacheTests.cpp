@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch_all.hpp>
+
+#include <DcgmDiagResultCache.h>
+#include <DcgmStringHelpers.h>
+#include <UniquePtrUtil.h>
+
+namespace
+{
+std::shared_ptr<dcgmDiagResponse_v11 const> MakeResponse(unsigned char numErrors = 0)
+{
+    std::shared_ptr<dcgmDiagResponse_v11> response = MakeUniqueZero<dcgmDiagResponse_v11>();
+    response->version                              = dcgmDiagResponse_version11;
+    response->numTests                             = 1;
+    response->numErrors                            = numErrors;
+    return response;
+}
+
+std::vector<DcgmDiagGpuHealth> MakeHealth()
+{
+    DcgmDiagGpuHealth gpu0;
+    gpu0.uuid           = "GPU-0";
+    gpu0.eccSbeVolTotal = 3;
+    gpu0.eccDbeVolTotal = 0;
+    DcgmDiagGpuHealth gpu1;
+    gpu1.uuid = "GPU-1";
+    return { gpu0, gpu1 };
+}
+} // namespace
+
+TEST_CASE("DcgmDiagResultCache: Keys")
+{
+    auto drd      = MakeUniqueZero<dcgmRunDiag_v9>();
+    drd->version  = dcgmRunDiag_version9;
+    drd->validate = DCGM_POLICY_VALID_SV_SHORT;
+    CHECK(DcgmDiagResultCache::IsCacheable(*drd));
+
+    std::string const key = DcgmDiagResultCache::MakeKey(*drd, "550.54", MakeHealth());
+    CHECK(key == DcgmDiagResultCache::MakeKey(*drd, "550.54", MakeHealth()));
+    CHECK(key != DcgmDiagResultCache::MakeKey(*drd, "560.28", MakeHealth()));
+    CHECK(key != DcgmDiagResultCache::MakeKey(*drd, "550.54", { MakeHealth()[1], MakeHealth()[0] }));
+
+    SafeCopyTo(drd->testParms[0], "diagnostic.test_duration=30");
+    CHECK(key != DcgmDiagResultCache::MakeKey(*drd, "550.54", MakeHealth()));
+
+    drd->totalIterations = 3;
+    CHECK_FALSE(DcgmDiagResultCache::IsCacheable(*drd));
+}
+
+TEST_CASE("DcgmDiagResultCache: Results are reused while the GPUs are unchanged")
+{
+    timelib64_t const maxAge = 600 * 1000000LL;
+    timelib64_t const start  = 1000000000;
+    DcgmDiagResultCache cache(maxAge);
+    REQUIRE(cache.Enabled());
+
+    auto const response = MakeResponse();
+    cache.Put("key", MakeHealth(), response, start);
+
+    auto hit = cache.Get("key", MakeHealth(), start + 1000);
+    REQUIRE(hit.has_value());
+    CHECK(hit->response == response);
+    CHECK(hit->completedAt == start);
+    CHECK_FALSE(cache.Get("other", MakeHealth(), start + 1000).has_value());
+
+    SECTION("Too old")
+    {
+        CHECK_FALSE(cache.Get("key", MakeHealth(), start + maxAge + 1).has_value());
+        CHECK(cache.Size() == 0);
+    }
+
+    SECTION("XID")
+    {
+        auto health                = MakeHealth();
+        health[1].lastXidTimestamp = start + 10;
+        CHECK_FALSE(cache.Get("key", health, start + 1000).has_value());
+        CHECK_FALSE(cache.Get("key", MakeHealth(), start + 1000).has_value());
+    }
+
+    SECTION("ECC errors or reset")
+    {
+        auto health              = MakeHealth();
+        health[0].eccSbeVolTotal = 0;
+        CHECK_FALSE(cache.Get("key", health, start + 1000).has_value());
+    }
+
+    SECTION("MIG change")
+    {
+        auto health            = MakeHealth();
+        health[0].migMode      = 1;
+        health[0].migInstances = "0/4294967295:19,";
+        CHECK_FALSE(cache.Get("key", health, start + 1000).has_value());
+    }
+
+    SECTION("Clear")
+    {
+        cache.Clear();
+        CHECK_FALSE(cache.Get("key", MakeHealth(), start + 1000).has_value());
+    }
+}
+
+TEST_CASE("DcgmDiagResultCache: Failures and eviction")
+{
+    DcgmDiagResultCache cache(600 * 1000000LL, 2);
+
+    cache.Put("a", MakeHealth(), MakeResponse(), 1);
+    cache.Put("a", MakeHealth(), MakeResponse(1), 2);
+    CHECK(cache.Size() == 0);
+
+    cache.Put("a", MakeHealth(), MakeResponse(), 1);
+    cache.Put("b", MakeHealth(), MakeResponse(), 2);
+    cache.Put("c", MakeHealth(), MakeResponse(), 3);
+    CHECK(cache.Size() == 2);
+    CHECK_FALSE(cache.Get("a", MakeHealth(), 4).has_value());
+    CHECK(cache.Get("c", MakeHealth(), 4).has_value());
+
+    DcgmDiagResultCache disabled(0);
+    CHECK_FALSE(disabled.Enabled());
+    disabled.Put("a", MakeHealth(), MakeResponse(), 1);
+    CHECK(disabled.Size() == 0);
+}
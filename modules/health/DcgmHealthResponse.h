@@ -34,6 +34,11 @@ public:
                      dcgm_field_entity_group_t entityGroupId,
                      dcgm_field_eid_t entityId);
 
+    /*
+     * Record every incident of other for this response
+     */
+    void Append(DcgmHealthResponse const &other);
+
     /*
      * Populate the health response version 5 struct based on the incidents recorded
      */
@@ -24,6 +24,10 @@
 #include <sstream>
 #include <stdexcept>
 
+/* Incidents are found over a window of recent samples, so a verdict becomes stale once samples age out of the
+   window even if no values update */
+#define HEALTH_VERDICT_MAX_AGE_USEC 5000000
+
 const char *EntityToString(dcgm_field_entity_group_t entityGroupId)
 {
     switch (entityGroupId)
@@ -49,6 +53,7 @@ const char *EntityToString(dcgm_field_entity_group_t entityGroupId)
 }
 
 // Adds a watch for the specified field that will poll every 10 seconds for the last hour's events
+// The watch is subscribed so that OnFieldValuesUpdate() can invalidate the cached verdicts of the entity
 #define ADD_WATCH(fieldId)                                                                                \
     do                                                                                                    \
     {                                                                                                     \
@@ -61,7 +66,7 @@ const char *EntityToString(dcgm_field_entity_group_t entityGroupId)
                                         maxKeepAge,                                   \
                                         0,                                            \
                                         watcher,                                      \
-                                        false,                                        \
+                                        true,                                         \
                                         updateOnFirstWatch,                           \
                                         wereFirstWatcher);                            \
         if (DCGM_ST_OK != ret)                                                                            \
@@ -133,7 +138,7 @@ dcgmReturn_t DcgmHealthWatch::SetNvSwitchWatches(std::vector<unsigned int> &grou
                                                        maxKeepAge,
                                                        0,
                                                        watcher,
-                                                       false,
+                                                       true,
                                                        updateOnFirstWatch,
                                                        wereFirstWatcher);
                 if (dcgmReturn != DCGM_ST_OK)
@@ -155,7 +160,7 @@ dcgmReturn_t DcgmHealthWatch::SetNvSwitchWatches(std::vector<unsigned int> &grou
                                                        maxKeepAge,
                                                        0,
                                                        watcher,
-                                                       false,
+                                                       true,
                                                        updateOnFirstWatch,
                                                        wereFirstWatcher);
                 if (dcgmReturn != DCGM_ST_OK)
@@ -193,6 +198,8 @@ dcgmReturn_t DcgmHealthWatch::SetWatches(unsigned int groupId,
 
     dcgm_mutex_lock(m_mutex);
     mGroupWatchState[groupId] = systems;
+    /* Verdicts of systems that are no longer watched would otherwise linger */
+    m_verdicts.clear();
     dcgm_mutex_unlock(m_mutex);
 
     /* Capture the entities that are GPUs as a separate list */
@@ -476,6 +483,9 @@ dcgmReturn_t DcgmHealthWatch::MonitorWatches(unsigned int groupId,
     if (healthSystemsMask == 0)
         return DCGM_ST_OK; /* This is the same as walking over the loops below and doing nothing */
 
+    /* Verdicts are only cached for the default window, which is relative to now */
+    bool const useVerdictCache = (startTime == 0 && endTime == 0);
+
     for (size_t entityIndex = 0; entityIndex < entities.size(); entityIndex++)
     {
         dcgm_field_entity_group_t entityGroupId = entities[entityIndex].entityGroupId;
@@ -485,65 +495,18 @@ dcgmReturn_t DcgmHealthWatch::MonitorWatches(unsigned int groupId,
         {
             unsigned int bit = 1 << index;
 
-            switch (bit)
+            if (!(bit & healthSystemsMask))
             {
-                case DCGM_HEALTH_WATCH_PCIE:
-                    if (bit & healthSystemsMask && FitsGpuHardwareCheck(entityGroupId))
-                        ret = MonitorPcie(entityGroupId, entityId, startTime, endTime, response);
-                    break;
-                case DCGM_HEALTH_WATCH_MEM:
-                    if (bit & healthSystemsMask && FitsGpuHardwareCheck(entityGroupId))
-                        ret = MonitorMem(entityGroupId, entityId, startTime, endTime, response);
-                    break;
-                case DCGM_HEALTH_WATCH_INFOROM:
-                    if (bit & healthSystemsMask && FitsGpuHardwareCheck(entityGroupId))
-                        ret = MonitorInforom(entityGroupId, entityId, startTime, endTime, response);
-                    break;
-                case DCGM_HEALTH_WATCH_THERMAL:
-                    if (bit & healthSystemsMask && FitsGpuHardwareCheck(entityGroupId))
-                    {
-                        ret = MonitorThermal(entityGroupId, entityId, startTime, endTime, response);
-                        if (ret != DCGM_ST_OK)
-                        {
-                            break;
-                        }
-                    }
-                    if (bit & healthSystemsMask && entityGroupId == DCGM_FE_CPU)
-                    {
-                        ret = MonitorCpuThermal(entityGroupId, entityId, startTime, endTime, response);
-                    }
-                    break;
-                case DCGM_HEALTH_WATCH_POWER:
-                    if (bit & healthSystemsMask && FitsGpuHardwareCheck(entityGroupId))
-                    {
-                        ret = MonitorPower(entityGroupId, entityId, startTime, endTime, response);
-                        if (ret != DCGM_ST_OK)
-                        {
-                            break;
-                        }
-                    }
-                    if (bit & healthSystemsMask && entityGroupId == DCGM_FE_CPU)
-                    {
-                        ret = MonitorCpuPower(entityGroupId, entityId, startTime, endTime, response);
-                    }
-                    break;
-                case DCGM_HEALTH_WATCH_NVLINK:
-                    if (bit & healthSystemsMask && FitsGpuHardwareCheck(entityGroupId))
-                        ret = MonitorNVLink(entityGroupId, entityId, startTime, endTime, response);
-                    break;
-                case DCGM_HEALTH_WATCH_NVSWITCH_NONFATAL:
-                    if (bit & healthSystemsMask && entityGroupId == DCGM_FE_SWITCH)
-                        ret = MonitorNvSwitchErrorCounts(false, entityGroupId, entityId, startTime, endTime, response);
-                    break;
-                case DCGM_HEALTH_WATCH_NVSWITCH_FATAL:
-                    if (bit & healthSystemsMask && entityGroupId == DCGM_FE_SWITCH)
-                        ret = MonitorNvSwitchErrorCounts(true, entityGroupId, entityId, startTime, endTime, response);
-                    break;
-                default:
-                    // reduce the logging level as this may pollute the log file if unsupported fields are watched
-                    // continuously.
-                    log_debug("Unhandled health bit {}", bit);
-                    break;
+                continue;
+            }
+
+            if (useVerdictCache)
+            {
+                ret = MonitorSystemCached(entityGroupId, entityId, (dcgmHealthSystems_t)bit, response);
+            }
+            else
+            {
+                ret = MonitorSystem(entityGroupId, entityId, (dcgmHealthSystems_t)bit, startTime, endTime, response);
             }
         }
     }
@@ -551,6 +514,111 @@ dcgmReturn_t DcgmHealthWatch::MonitorWatches(unsigned int groupId,
     return ret;
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmHealthWatch::MonitorSystem(dcgm_field_entity_group_t entityGroupId,
+                                            dcgm_field_eid_t entityId,
+                                            dcgmHealthSystems_t system,
+                                            long long startTime,
+                                            long long endTime,
+                                            DcgmHealthResponse &response)
+{
+    dcgmReturn_t ret = DCGM_ST_OK;
+
+    switch (system)
+    {
+        case DCGM_HEALTH_WATCH_PCIE:
+            if (FitsGpuHardwareCheck(entityGroupId))
+                ret = MonitorPcie(entityGroupId, entityId, startTime, endTime, response);
+            break;
+        case DCGM_HEALTH_WATCH_MEM:
+            if (FitsGpuHardwareCheck(entityGroupId))
+                ret = MonitorMem(entityGroupId, entityId, startTime, endTime, response);
+            break;
+        case DCGM_HEALTH_WATCH_INFOROM:
+            if (FitsGpuHardwareCheck(entityGroupId))
+                ret = MonitorInforom(entityGroupId, entityId, startTime, endTime, response);
+            break;
+        case DCGM_HEALTH_WATCH_THERMAL:
+            if (FitsGpuHardwareCheck(entityGroupId))
+            {
+                ret = MonitorThermal(entityGroupId, entityId, startTime, endTime, response);
+            }
+            else if (entityGroupId == DCGM_FE_CPU)
+            {
+                ret = MonitorCpuThermal(entityGroupId, entityId, startTime, endTime, response);
+            }
+            break;
+        case DCGM_HEALTH_WATCH_POWER:
+            if (FitsGpuHardwareCheck(entityGroupId))
+            {
+                ret = MonitorPower(entityGroupId, entityId, startTime, endTime, response);
+            }
+            else if (entityGroupId == DCGM_FE_CPU)
+            {
+                ret = MonitorCpuPower(entityGroupId, entityId, startTime, endTime, response);
+            }
+            break;
+        case DCGM_HEALTH_WATCH_NVLINK:
+            if (FitsGpuHardwareCheck(entityGroupId))
+                ret = MonitorNVLink(entityGroupId, entityId, startTime, endTime, response);
+            break;
+        case DCGM_HEALTH_WATCH_NVSWITCH_NONFATAL:
+            if (entityGroupId == DCGM_FE_SWITCH)
+                ret = MonitorNvSwitchErrorCounts(false, entityGroupId, entityId, startTime, endTime, response);
+            break;
+        case DCGM_HEALTH_WATCH_NVSWITCH_FATAL:
+            if (entityGroupId == DCGM_FE_SWITCH)
+                ret = MonitorNvSwitchErrorCounts(true, entityGroupId, entityId, startTime, endTime, response);
+            break;
+        default:
+            // reduce the logging level as this may pollute the log file if unsupported fields are watched
+            // continuously.
+            log_debug("Unhandled health bit {}", (unsigned int)system);
+            break;
+    }
+
+    return ret;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmHealthWatch::MonitorSystemCached(dcgm_field_entity_group_t entityGroupId,
+                                                  dcgm_field_eid_t entityId,
+                                                  dcgmHealthSystems_t system,
+                                                  DcgmHealthResponse &response)
+{
+    std::uint64_t entityKey  = PackEntityKey(entityGroupId, entityId);
+    timelib64_t now          = timelib_usecSince1970();
+    unsigned long long epoch = 0;
+
+    {
+        DcgmLockGuard dlg(m_mutex);
+
+        epoch   = m_entityFvEpochs[entityKey];
+        auto it = m_verdicts.find({ entityKey, system });
+        if (it != m_verdicts.end() && it->second.fvEpoch == epoch
+            && now - it->second.evaluatedAt < HEALTH_VERDICT_MAX_AGE_USEC)
+        {
+            response.Append(it->second.response);
+            return it->second.ret;
+        }
+    }
+
+    /* Evaluate outside of the lock since this reads samples from the cache manager */
+    HealthVerdict verdict;
+    verdict.evaluatedAt = now;
+    verdict.fvEpoch     = epoch;
+    verdict.ret         = MonitorSystem(entityGroupId, entityId, system, 0, 0, verdict.response);
+    response.Append(verdict.response);
+
+    dcgmReturn_t ret = verdict.ret;
+
+    DcgmLockGuard dlg(m_mutex);
+    /* If any of the entity's values updated while evaluating, the verdict isn't reusable. The next check will see
+       a newer epoch and evaluate again */
+    m_verdicts[{ entityKey, system }] = std::move(verdict);
+    return ret;
+}
+
 std::string DcgmHealthWatch::GetHealthSystemAsString(dcgmHealthSystems_t system)
 {
     switch (system)
@@ -688,7 +756,7 @@ dcgmReturn_t DcgmHealthWatch::SetMem(dcgm_field_entity_group_t entityGroupId,
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -707,7 +775,7 @@ dcgmReturn_t DcgmHealthWatch::SetMem(dcgm_field_entity_group_t entityGroupId,
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -726,7 +794,7 @@ dcgmReturn_t DcgmHealthWatch::SetMem(dcgm_field_entity_group_t entityGroupId,
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -766,7 +834,7 @@ dcgmReturn_t DcgmHealthWatch::SetMem(dcgm_field_entity_group_t entityGroupId,
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -809,7 +877,7 @@ dcgmReturn_t DcgmHealthWatch::SetInforom(dcgm_field_entity_group_t entityGroupId
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -853,7 +921,7 @@ dcgmReturn_t DcgmHealthWatch::SetThermal(dcgm_field_entity_group_t entityGroupId
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -896,7 +964,7 @@ dcgmReturn_t DcgmHealthWatch::SetPower(dcgm_field_entity_group_t entityGroupId,
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -915,7 +983,7 @@ dcgmReturn_t DcgmHealthWatch::SetPower(dcgm_field_entity_group_t entityGroupId,
                                     maxKeepAge,
                                     0,
                                     watcher,
-                                    false,
+                                    true,
                                     updateOnFirstWatch,
                                     wereFirstWatcher);
     if (DCGM_ST_OK != ret)
@@ -2103,6 +2171,9 @@ void DcgmHealthWatch::OnFieldValuesUpdate(DcgmFvBuffer *fvBuffer)
 
     for (fv = fvBuffer->GetNextFv(&cursor); fv; fv = fvBuffer->GetNextFv(&cursor))
     {
+        /* Any new value of the entity makes its cached verdicts stale */
+        m_entityFvEpochs[PackEntityKey((dcgm_field_entity_group_t)fv->entityGroupId, fv->entityId)]++;
+
         /* Policy only pertains to GPUs for now */
         if (fv->entityGroupId != DCGM_FE_GPU)
         {
@@ -17,12 +17,18 @@
 #define _DCGM_HEALTH_WATCH_H
 
 #include "DcgmCoreProxy.h"
+#include "DcgmEntityKey.h"
 #include "DcgmError.h"
 #include "DcgmGPUHardwareLimits.h"
 #include "DcgmHealthResponse.h"
 #include "dcgm_core_communication.h"
 #include "dcgm_test_apis.h"
+#include "timelib.h"
+#include <cstdint>
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 /* This class is implements the background health check methods
  * within the hostengine
@@ -109,6 +115,23 @@ private:
         m_gpuHadUncontainedErrorXid; /* If a GPU has had an XID 95, its value is set here.
                                        This data structure is protected by m_mutex. */
 
+    /* Result of evaluating one health system of one entity with the default time window. These are reused by
+       MonitorWatches() until a value of the entity updates or HEALTH_VERDICT_MAX_AGE_USEC passes */
+    struct HealthVerdict
+    {
+        timelib64_t evaluatedAt    = 0; /* When the verdict was evaluated */
+        unsigned long long fvEpoch = 0; /* m_entityFvEpochs of the entity when the verdict was evaluated */
+        dcgmReturn_t ret           = DCGM_ST_OK;
+        DcgmHealthResponse response; /* Incidents found by the evaluation */
+    };
+
+    /* Map of (PackEntityKey(), health system bit) -> last verdict. Protected by m_mutex */
+    std::map<std::pair<std::uint64_t, unsigned int>, HealthVerdict> m_verdicts;
+
+    /* Map of PackEntityKey() -> count of value updates of the entity seen by OnFieldValuesUpdate().
+       Protected by m_mutex */
+    std::unordered_map<DcgmNs::PackedEntityKey, unsigned long long, DcgmNs::EntityKeyHash> m_entityFvEpochs;
+
     /* Prepopulated lists of fields used by various internal methods */
     std::vector<unsigned int> m_nvSwitchNonFatalFieldIds; /* NvSwitch non-fatal errors */
     std::vector<unsigned int> m_nvSwitchFatalFieldIds;    /* NvSwitch fatal errors */
@@ -257,6 +280,26 @@ private:
 
     bool FitsGpuHardwareCheck(dcgm_field_entity_group_t entityGroupId);
 
+    static DcgmNs::PackedEntityKey PackEntityKey(dcgm_field_entity_group_t entityGroupId, dcgm_field_eid_t entityId)
+    {
+        return DcgmNs::PackEntityKey(entityGroupId, entityId, 0);
+    }
+
+    /* Evaluate one health system of one entity. This is the body of MonitorWatches() */
+    dcgmReturn_t MonitorSystem(dcgm_field_entity_group_t entityGroupId,
+                               dcgm_field_eid_t entityId,
+                               dcgmHealthSystems_t system,
+                               long long startTime,
+                               long long endTime,
+                               DcgmHealthResponse &response);
+
+    /* MonitorSystem() with the default time window, reusing the last verdict if none of the values of the entity
+       have updated since it was evaluated */
+    dcgmReturn_t MonitorSystemCached(dcgm_field_entity_group_t entityGroupId,
+                                     dcgm_field_eid_t entityId,
+                                     dcgmHealthSystems_t system,
+                                     DcgmHealthResponse &response);
+
     /* Helpers called by MonitorPcie() */
     dcgmReturn_t GetExpectedPcieReplayRate(dcgm_field_entity_group_t entityGroupId,
                                            dcgm_field_eid_t entityId,
@@ -16,6 +16,7 @@
 #include "DcgmModuleHealth.h"
 #include "DcgmHealthResponse.h"
 #include "DcgmLogging.h"
+#include <DcgmCommandTable.hpp>
 #include <dcgm_api_export.h>
 #include <dcgm_structs.h>
 
@@ -36,10 +37,6 @@ dcgmReturn_t DcgmModuleHealth::ProcessSetSystems(dcgm_health_msg_set_systems_t *
     unsigned int groupId;
     dcgmReturn_t dcgmReturn;
 
-    dcgmReturn = CheckVersion(&msg->header, dcgm_health_msg_set_systems_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     groupId = (uintptr_t)msg->healthSet.groupId;
 
     /* Verify group id is valid */
@@ -69,10 +66,6 @@ dcgmReturn_t DcgmModuleHealth::ProcessGetSystems(dcgm_health_msg_get_systems_t *
     unsigned int groupId;
     dcgmReturn_t dcgmReturn;
 
-    dcgmReturn = CheckVersion(&msg->header, dcgm_health_msg_get_systems_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     groupId = (uintptr_t)msg->groupId;
 
     /* Verify group id is valid */
@@ -98,10 +91,6 @@ dcgmReturn_t DcgmModuleHealth::ProcessCheckV5(dcgm_health_msg_check_v5 *msg)
     unsigned int groupId;
     dcgmReturn_t dcgmReturn;
 
-    dcgmReturn = CheckVersion(&msg->header, dcgm_health_msg_check_version5);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     groupId = (uintptr_t)msg->groupId;
 
     /* Verify group id is valid */
@@ -129,10 +118,6 @@ dcgmReturn_t DcgmModuleHealth::ProcessCheckGpus(dcgm_health_msg_check_gpus_t *ms
     unsigned int gpuIdIndex;
     dcgmReturn_t dcgmReturn;
 
-    dcgmReturn = CheckVersion(&msg->header, dcgm_health_msg_check_gpus_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     if (!msg->systems)
     {
         DCGM_LOG_ERROR << "Systems was missing";
@@ -223,40 +208,22 @@ dcgmReturn_t DcgmModuleHealth::ProcessCoreMessage(dcgm_module_command_header_t *
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleHealth::ProcessMessage(dcgm_module_command_header_t *moduleCommand)
 {
-    dcgmReturn_t retSt = DCGM_ST_OK;
+    using DcgmNs::Handle;
+
+    static constexpr auto c_commands = DcgmNs::MakeCommandTable<DcgmModuleHealth>({
+        Handle<&DcgmModuleHealth::ProcessGetSystems>(DCGM_HEALTH_SR_GET_SYSTEMS, dcgm_health_msg_get_systems_version),
+        Handle<&DcgmModuleHealth::ProcessSetSystems>(DCGM_HEALTH_SR_SET_SYSTEMS_V2,
+                                                     dcgm_health_msg_set_systems_version),
+        Handle<&DcgmModuleHealth::ProcessCheckV5>(DCGM_HEALTH_SR_CHECK_V5, dcgm_health_msg_check_version5),
+        Handle<&DcgmModuleHealth::ProcessCheckGpus>(DCGM_HEALTH_SR_CHECK_GPUS, dcgm_health_msg_check_gpus_version),
+    });
 
     if (moduleCommand->moduleId == DcgmModuleIdCore)
     {
-        retSt = ProcessCoreMessage(moduleCommand);
-    }
-    else
-    {
-        switch (moduleCommand->subCommand)
-        {
-            case DCGM_HEALTH_SR_GET_SYSTEMS:
-                retSt = ProcessGetSystems((dcgm_health_msg_get_systems_t *)moduleCommand);
-                break;
-
-            case DCGM_HEALTH_SR_SET_SYSTEMS_V2:
-                retSt = ProcessSetSystems((dcgm_health_msg_set_systems_t *)moduleCommand);
-                break;
-
-            case DCGM_HEALTH_SR_CHECK_V5:
-                retSt = ProcessCheckV5(reinterpret_cast<dcgm_health_msg_check_v5 *>(moduleCommand));
-                break;
-
-            case DCGM_HEALTH_SR_CHECK_GPUS:
-                retSt = ProcessCheckGpus((dcgm_health_msg_check_gpus_t *)moduleCommand);
-                break;
-
-            default:
-                DCGM_LOG_DEBUG << "Unknown subcommand: " << static_cast<int>(moduleCommand->subCommand);
-                return DCGM_ST_FUNCTION_NOT_FOUND;
-                break;
-        }
+        return ProcessCoreMessage(moduleCommand);
     }
 
-    return retSt;
+    return c_commands.Dispatch(*this, moduleCommand);
 }
 
 extern "C" {
@@ -16,24 +16,49 @@
 #include "DcgmMetadataMgr.h"
 #include "DcgmLogging.h"
 #include "DcgmMutex.h"
-#include <DcgmStringConversions.h>
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
-#include <fstream>
+#include <dirent.h>
+#include <fcntl.h>
 #include <functional>
 #include <limits>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <sys/resource.h>
 #include <unistd.h>
+#include <unordered_set>
 #include <vector>
 
 DcgmMetadataManager::DcgmMetadataManager(dcgmCoreCallbacks_t &dcc)
-    : m_coreProxy(dcc)
-{}
+    : m_clockTicksPerSecond(sysconf(_SC_CLK_TCK))
+    , m_coreProxy(dcc)
+{
+    if (m_clockTicksPerSecond <= 0)
+    {
+        /* USER_HZ has been 100 on every Linux architecture we run on */
+        m_clockTicksPerSecond = 100;
+    }
+}
 
 DcgmMetadataManager::~DcgmMetadataManager()
-{}
+{
+    for (int fd : { m_procStatFd, m_selfStatusFd })
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+
+    for (auto const &[tid, fd] : m_threadStatFds)
+    {
+        close(fd);
+    }
+}
 
 dcgmReturn_t DcgmMetadataManager::GetHostEngineBytesUsed(long long &bytesUsed, bool /* waitIfNoData */)
 {
@@ -42,14 +67,37 @@ dcgmReturn_t DcgmMetadataManager::GetHostEngineBytesUsed(long long &bytesUsed, b
     return DCGM_ST_OK;
 }
 
+dcgmReturn_t DcgmMetadataManager::GetCompressedSampleBytes(long long &compressedSampleBytes)
+{
+    return m_coreProxy.GetCompressedSampleBytes(compressedSampleBytes);
+}
+
+dcgmReturn_t DcgmMetadataManager::GetFieldCosts(dcgmIntrospectFieldCosts_v1 &fieldCosts)
+{
+    return m_coreProxy.GetFieldCosts(fieldCosts);
+}
+
+dcgmReturn_t DcgmMetadataManager::GetLockProfile(dcgmIntrospectLockProfile_v1 &lockProfile)
+{
+    return m_coreProxy.GetLockProfile(lockProfile);
+}
+
+dcgmReturn_t DcgmMetadataManager::GetRuntimeStats(dcgmIntrospectRuntimeStats_v1 &runtimeStats)
+{
+    return m_coreProxy.GetRuntimeStats(runtimeStats);
+}
+
 dcgmReturn_t DcgmMetadataManager::GetCpuUtilization(CpuUtil &cpuUtil, bool waitIfNoData)
 {
     long long totalCpuTicks  = 0;
     long long systemCpuTicks = 0;
     long long userCpuTicks   = 0;
 
+    std::unordered_map<pid_t, ThreadTicks> threadTicks;
+
     GetSystemTotalCpuTicks(totalCpuTicks);
     RetrieveProcessCpuTime(userCpuTicks, systemCpuTicks);
+    RetrieveThreadCpuTimes(threadTicks);
 
     /* Prevent infinite recursion */
     if (totalCpuTicks == 0)
@@ -64,6 +112,7 @@ dcgmReturn_t DcgmMetadataManager::GetCpuUtilization(CpuUtil &cpuUtil, bool waitI
         m_previousTotalCpuTicks = totalCpuTicks;
         m_previousUserTicks     = userCpuTicks;
         m_previousSystemTicks   = systemCpuTicks;
+        m_previousThreadTicks   = std::move(threadTicks);
 
         /* Will the user wait for a record? */
         if (!waitIfNoData)
@@ -91,38 +140,110 @@ dcgmReturn_t DcgmMetadataManager::GetCpuUtilization(CpuUtil &cpuUtil, bool waitI
     cpuUtil.kernel = systemCpuDiff / totalCpuDiff;
     cpuUtil.total  = cpuUtil.user + cpuUtil.kernel;
 
+    ComputeThreadCpuUtil(threadTicks, totalCpuDiff, cpuUtil.threads);
+    m_previousThreadTicks = std::move(threadTicks);
+
     return DCGM_ST_OK;
 }
 
+void DcgmMetadataManager::ComputeThreadCpuUtil(std::unordered_map<pid_t, ThreadTicks> const &threadTicks,
+                                               double totalCpuDiff,
+                                               std::vector<ThreadCpuUtil> &threads) const
+{
+    std::unordered_map<std::string_view, ThreadCpuUtil> byName;
+
+    for (auto const &[tid, ticks] : threadTicks)
+    {
+        long long userDiff   = ticks.userTicks;
+        long long systemDiff = ticks.systemTicks;
+
+        /* Threads that weren't around last time started since then, so all their ticks count */
+        auto previous = m_previousThreadTicks.find(tid);
+        if (previous != m_previousThreadTicks.end())
+        {
+            userDiff   = std::max(0LL, userDiff - previous->second.userTicks);
+            systemDiff = std::max(0LL, systemDiff - previous->second.systemTicks);
+        }
+
+        ThreadCpuUtil &threadUtil = byName[ticks.name];
+        threadUtil.numThreads++;
+        threadUtil.user += (double)userDiff / totalCpuDiff;
+        threadUtil.kernel += (double)systemDiff / totalCpuDiff;
+    }
+
+    threads.clear();
+    threads.reserve(byName.size());
+    for (auto &[name, threadUtil] : byName)
+    {
+        threadUtil.name  = name;
+        threadUtil.total = threadUtil.user + threadUtil.kernel;
+        threads.push_back(std::move(threadUtil));
+    }
+
+    std::sort(threads.begin(), threads.end(), [](ThreadCpuUtil const &a, ThreadCpuUtil const &b) {
+        return a.total != b.total ? a.total > b.total : a.name < b.name;
+    });
+}
+
+size_t DcgmMetadataManager::ReadProcFile(int &fd, char const *path)
+{
+    if (fd < 0)
+    {
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            log_error("Unable to open {}: {}", path, strerror(errno));
+            return 0;
+        }
+    }
+
+    /* procfs regenerates the contents on each read from offset 0 */
+    ssize_t bytesRead = pread(fd, m_readBuffer, sizeof(m_readBuffer) - 1, 0);
+    if (bytesRead <= 0)
+    {
+        log_error("Unable to read {}: {}", path, bytesRead < 0 ? strerror(errno) : "empty file");
+        close(fd);
+        fd = -1;
+        return 0;
+    }
+
+    m_readBuffer[bytesRead] = '\0';
+    return (size_t)bytesRead;
+}
+
 void DcgmMetadataManager::RetrieveProcessMemoryUsage(long long &totalKB)
 {
     // parse /proc/self/status instead of /proc/self/stat since the swap related
     // fields in "man proc" for /proc/self/stat say (not maintained)
     // /status is also displayed in KB values instead of pages for RSS which is easier to use
-    std::ifstream statusStream("/proc/self/status");
-
     long long rssKB = 0;
     long long swpKB = 0;
 
-    std::string line;
-    while (getline(statusStream, line))
-    {
-        std::stringstream ss(line);
-        std::string first, second;
+    totalKB = 0;
 
-        ss >> first >> second;
+    if (ReadProcFile(m_selfStatusFd, "/proc/self/status") == 0)
+    {
+        return;
+    }
 
-        if (first == "VmRSS:")
+    for (char const *line = m_readBuffer; line != nullptr && *line != '\0';)
+    {
+        if (strncmp(line, "VmRSS:", 6) == 0)
         {
-            rssKB = strTo<long long>(second);
+            rssKB = strtoll(line + 6, nullptr, 10);
         }
         // VmSwap shows up but is no longer documented in "man proc" so we might not always get this
-        else if (first == "VmSwap:")
+        else if (strncmp(line, "VmSwap:", 7) == 0)
+        {
+            swpKB = strtoll(line + 7, nullptr, 10);
+        }
+
+        line = strchr(line, '\n');
+        if (line != nullptr)
         {
-            swpKB = strTo<long long>(second);
+            line++;
         }
     }
-    statusStream.close();
 
     totalKB = rssKB + swpKB;
     DCGM_LOG_DEBUG << "Read rssKB " << rssKB << ", swpKB " << swpKB << ", totalKB " << totalKB;
@@ -130,55 +251,124 @@ void DcgmMetadataManager::RetrieveProcessMemoryUsage(long long &totalKB)
 
 void DcgmMetadataManager::RetrieveProcessCpuTime(long long &userTime, long long &systemTime)
 {
-    // parse /proc/self/stat for this process's CPU usage
-    std::ifstream statStream("/proc/self/stat");
-
-    std::vector<std::string> stats;
-    std::string statVal;
-    while (statStream >> statVal)
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
     {
-        stats.push_back(statVal);
+        log_error("getrusage failed: {}", strerror(errno));
+        return;
     }
-    statStream.close();
 
-    if (stats.size() <= 14)
+    // Convert to the clock ticks that /proc/stat counts in
+    auto toTicks = [this](struct timeval const &tv) {
+        return (long long)tv.tv_sec * m_clockTicksPerSecond + (long long)tv.tv_usec * m_clockTicksPerSecond / 1000000;
+    };
+
+    userTime   = toTicks(usage.ru_utime);
+    systemTime = toTicks(usage.ru_stime);
+}
+
+void DcgmMetadataManager::RetrieveThreadCpuTimes(std::unordered_map<pid_t, ThreadTicks> &threadTicks)
+{
+    DIR *taskDir = opendir("/proc/self/task");
+    if (taskDir == nullptr)
     {
-        log_error("could not retrieve expected fields from /proc/self/stat");
+        log_error("Unable to open /proc/self/task: {}", strerror(errno));
         return;
     }
 
-    // use indices from "man 5 proc" section "/proc/[pid]/stat" minus 1 (they start at 1 instead of 0)
-    // user and system (kernel) time of the process in clock ticks
-    userTime   = strTo<long long>(stats.at(13));
-    systemTime = strTo<long long>(stats.at(14));
+    std::unordered_set<pid_t> liveThreads;
+
+    for (struct dirent *entry = readdir(taskDir); entry != nullptr; entry = readdir(taskDir))
+    {
+        char *end = nullptr;
+        pid_t tid = (pid_t)strtol(entry->d_name, &end, 10);
+        if (end == entry->d_name || *end != '\0')
+        {
+            continue; /* . and .. */
+        }
+
+        liveThreads.insert(tid);
+
+        auto fdIt = m_threadStatFds.try_emplace(tid, -1).first;
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/self/task/%d/stat", (int)tid);
+        if (ReadProcFile(fdIt->second, path) == 0)
+        {
+            m_threadStatFds.erase(fdIt); /* The thread likely exited while we were reading */
+            continue;
+        }
+
+        // The name is in parens and may contain spaces or parens itself, so look for the last ')'
+        char const *nameStart = strchr(m_readBuffer, '(');
+        char const *nameEnd   = strrchr(m_readBuffer, ')');
+        if (nameStart == nullptr || nameEnd == nullptr || nameEnd < nameStart)
+        {
+            log_error("could not parse {}", path);
+            continue;
+        }
+
+        // Fields after the name start at field 3 of "man 5 proc" section "/proc/[pid]/stat".
+        // utime and stime are fields 14 and 15
+        char const *field = nameEnd + 1;
+        for (int fieldNum = 3; fieldNum < 14 && field != nullptr; fieldNum++)
+        {
+            field = strchr(field + 1, ' ');
+        }
+        if (field == nullptr)
+        {
+            log_error("could not retrieve expected fields from {}", path);
+            continue;
+        }
+
+        ThreadTicks &ticks = threadTicks[tid];
+        ticks.name.assign(nameStart + 1, nameEnd);
+
+        char *stimeStart  = nullptr;
+        ticks.userTicks   = strtoll(field, &stimeStart, 10);
+        ticks.systemTicks = strtoll(stimeStart, nullptr, 10);
+    }
+
+    closedir(taskDir);
+
+    std::erase_if(m_threadStatFds, [&liveThreads](auto const &tidAndFd) {
+        if (liveThreads.contains(tidAndFd.first))
+        {
+            return false;
+        }
+        close(tidAndFd.second);
+        return true;
+    });
 }
 
 void DcgmMetadataManager::GetSystemTotalCpuTicks(long long &totalCpuTicks)
 {
-    std::ifstream sysStatStream("/proc/stat");
-    std::string line;
-
     totalCpuTicks = 0;
 
-    while (getline(sysStatStream, line))
+    if (ReadProcFile(m_procStatFd, "/proc/stat") == 0)
     {
-        std::stringstream ss(line);
-        std::string entry;
+        return;
+    }
 
-        ss >> entry;
+    // The aggregate "cpu" line is always first
+    if (strncmp(m_readBuffer, "cpu ", 4) != 0)
+    {
+        log_error("could not find the cpu line in /proc/stat");
+        return;
+    }
 
-        if (entry == "cpu")
+    // sum all the different break-downs of cpu time
+    char const *cursor = m_readBuffer + 4;
+    while (*cursor != '\n' && *cursor != '\0')
+    {
+        char *end                = nullptr;
+        unsigned long long ticks = strtoull(cursor, &end, 10);
+        if (end == cursor)
         {
-            // sum all the different break-downs of cpu time
-            unsigned long long ticks;
-            while (ss >> ticks)
-            {
-                totalCpuTicks += ticks;
-            }
-            break; /* We processed the only line we care about */
+            break;
         }
+        totalCpuTicks += ticks;
+        cursor = end;
     }
-    sysStatStream.close();
 
     DCGM_LOG_DEBUG << "Got " << totalCpuTicks << " totalCpuTicks";
 }
@@ -22,6 +22,9 @@
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
 
 
 /******************************************************************
@@ -30,12 +33,22 @@
 class DcgmMetadataManager
 {
 public:
-    typedef struct
+    struct ThreadCpuUtil
     {
-        double total; // kernel + user
-        double kernel;
-        double user;
-    } CpuUtil;
+        std::string name;            // Thread name. Threads with the same name are summed
+        unsigned int numThreads = 0; // Number of threads with this name
+        double total            = 0; // kernel + user
+        double kernel           = 0;
+        double user             = 0;
+    };
+
+    struct CpuUtil
+    {
+        double total  = 0; // kernel + user
+        double kernel = 0;
+        double user   = 0;
+        std::vector<ThreadCpuUtil> threads; // Highest total first
+    };
 
     explicit DcgmMetadataManager(dcgmCoreCallbacks_t &dcc);
     virtual ~DcgmMetadataManager();
@@ -70,16 +83,89 @@ public:
      */
     dcgmReturn_t GetCpuUtilization(CpuUtil &cpuUtil, bool waitIfNoData = true);
 
+    /*************************************************************************/
+    /**
+     * Get the number of bytes of cached samples the DCGM host engine holds in
+     * compressed timeseries
+     *
+     * compressedSampleBytes        OUT: Number of bytes. 0 if compressed timeseries are not enabled
+     *
+     * Returns: 0 on success
+     *         <0 on error. See DCGM_ST_? enums
+     */
+    dcgmReturn_t GetCompressedSampleBytes(long long &compressedSampleBytes);
+
+    /*************************************************************************/
+    /**
+     * Get what each watched field of each entity costs the DCGM host engine
+     *
+     * fieldCosts        OUT: The costs, most expensive first
+     *
+     * Returns: 0 on success
+     *         <0 on error. See DCGM_ST_? enums
+     */
+    dcgmReturn_t GetFieldCosts(dcgmIntrospectFieldCosts_v1 &fieldCosts);
+
+    /*************************************************************************/
+    /**
+     * Get how long the DCGM host engine waits for and holds its profiled mutexes
+     *
+     * lockProfile       OUT: One entry per place that locks a profiled mutex, longest waits first
+     *
+     * Returns: 0 on success
+     *         <0 on error. See DCGM_ST_? enums
+     */
+    dcgmReturn_t GetLockProfile(dcgmIntrospectLockProfile_v1 &lockProfile);
+
+    /*************************************************************************/
+    /**
+     * Get the counters of the DCGM host engine's cache manager
+     *
+     * runtimeStats      OUT: Update cycles, time awake and asleep and mutex contention since the start
+     *
+     * Returns: 0 on success
+     *         <0 on error. See DCGM_ST_? enums
+     */
+    dcgmReturn_t GetRuntimeStats(dcgmIntrospectRuntimeStats_v1 &runtimeStats);
+
 private:
+    struct ThreadTicks
+    {
+        std::string name;
+        long long userTicks   = 0;
+        long long systemTicks = 0;
+    };
+
     /* Previously-read values for total CPU ticks done by the system and our process */
     long long m_previousTotalCpuTicks = 0;
     long long m_previousUserTicks     = 0;
     long long m_previousSystemTicks   = 0;
 
+    /* Previously-read CPU ticks of each of our threads, by thread ID */
+    std::unordered_map<pid_t, ThreadTicks> m_previousThreadTicks;
+
+    /* procfs files are kept open and re-read with pread. -1 if not open */
+    int m_procStatFd   = -1; /* /proc/stat */
+    int m_selfStatusFd = -1; /* /proc/self/status */
+    std::unordered_map<pid_t, int> m_threadStatFds; /* /proc/self/task/<tid>/stat by thread ID */
+    char m_readBuffer[4096];                         /* Only the start of /proc/stat is needed */
+
+    long m_clockTicksPerSecond; /* Unit of the ticks in /proc/stat */
+
     DcgmCoreProxy m_coreProxy; /* Core proxy manager */
 
     // all private methods with prefix "retrieve" populate metadata without using existing metadata
     void RetrieveProcessMemoryUsage(long long &totalKB);
     void RetrieveProcessCpuTime(long long &userTime, long long &systemTime);
+    void RetrieveThreadCpuTimes(std::unordered_map<pid_t, ThreadTicks> &threadTicks);
     void GetSystemTotalCpuTicks(long long &totalCpuTicks);
+
+    /* Fill m_readBuffer from the start of path, opening it into fd if it isn't open yet.
+       Returns the number of bytes read. 0 on error, in which case fd is closed */
+    size_t ReadProcFile(int &fd, char const *path);
+
+    /* Group the ticks used since m_previousThreadTicks by thread name */
+    void ComputeThreadCpuUtil(std::unordered_map<pid_t, ThreadTicks> const &threadTicks,
+                              double totalCpuDiff,
+                              std::vector<ThreadCpuUtil> &threads) const;
 };
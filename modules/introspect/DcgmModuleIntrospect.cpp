@@ -15,6 +15,7 @@
  */
 #include "DcgmModuleIntrospect.h"
 #include "DcgmLogging.h"
+#include "DcgmStringHelpers.h"
 #include "DcgmTaskRunner.h"
 #include "TaskRunner.hpp"
 #include "dcgm_introspect_structs.h"
@@ -43,6 +44,7 @@ DcgmModuleIntrospect::DcgmModuleIntrospect(dcgmCoreCallbacks_t &dcc)
         SetDebugLogging(true);
     }
 
+    SetThreadName("mod_introspect");
     Start();
 }
 
@@ -75,7 +77,7 @@ void DcgmModuleIntrospect::run()
     }
 }
 
-std::optional<dcgmReturn_t> DcgmModuleIntrospect::GetMemUsageForHostengine(dcgmIntrospectMemory_t *memInfo,
+std::optional<dcgmReturn_t> DcgmModuleIntrospect::GetMemUsageForHostengine(dcgmIntrospectMemory_v2 *memInfo,
                                                                            int waitIfNoData)
 {
     auto st = mpMetadataManager->GetHostEngineBytesUsed(memInfo->bytesUsed, waitIfNoData);
@@ -84,10 +86,15 @@ std::optional<dcgmReturn_t> DcgmModuleIntrospect::GetMemUsageForHostengine(dcgmI
         return std::nullopt;
     }
 
-    return st;
+    if (DCGM_ST_OK != st)
+    {
+        return st;
+    }
+
+    return mpMetadataManager->GetCompressedSampleBytes(memInfo->compressedSampleBytes);
 }
 
-std::optional<dcgmReturn_t> DcgmModuleIntrospect::GetCpuUtilizationForHostengine(dcgmIntrospectCpuUtil_t *cpuUtil,
+std::optional<dcgmReturn_t> DcgmModuleIntrospect::GetCpuUtilizationForHostengine(dcgmIntrospectCpuUtil_v2 *cpuUtil,
                                                                                  int waitIfNoData)
 {
     dcgmReturn_t st;
@@ -109,22 +116,66 @@ std::optional<dcgmReturn_t> DcgmModuleIntrospect::GetCpuUtilizationForHostengine
     cpuUtil->user   = mgrCpuUtil.user;
     cpuUtil->total  = mgrCpuUtil.total;
 
+    cpuUtil->numThreadUtils = 0;
+    for (auto const &threadUtil : mgrCpuUtil.threads)
+    {
+        if (cpuUtil->numThreadUtils >= DCGM_INTROSPECT_MAX_THREAD_CPU_UTILS)
+        {
+            break;
+        }
+
+        dcgmIntrospectThreadCpuUtil_v1 &dest = cpuUtil->threads[cpuUtil->numThreadUtils];
+        SafeCopyTo(dest.name, threadUtil.name.c_str());
+        dest.numThreads = threadUtil.numThreads;
+        dest.kernel     = threadUtil.kernel;
+        dest.user       = threadUtil.user;
+        dest.total      = threadUtil.total;
+        cpuUtil->numThreadUtils++;
+    }
+
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
 std::optional<dcgmReturn_t> DcgmModuleIntrospect::ProcessMetadataHostEngineCpuUtil(
-    dcgm_introspect_msg_he_cpu_util_v1 *msg)
+    dcgm_module_command_header_t *moduleCommand)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_cpu_util_version1);
+    if (moduleCommand->version == dcgm_introspect_msg_he_cpu_util_version1)
+    {
+        auto *msg = (dcgm_introspect_msg_he_cpu_util_v1 *)moduleCommand;
+
+        dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_cpu_util_version1);
+        if (DCGM_ST_OK != dcgmReturn)
+        {
+            return dcgmReturn; /* Logging handled by helper method */
+        }
+
+        if (msg->cpuUtil.version != dcgmIntrospectCpuUtil_version1)
+        {
+            log_warning("Version mismatch. expected {}. Got {}", dcgmIntrospectCpuUtil_version1, msg->cpuUtil.version);
+            return DCGM_ST_VER_MISMATCH;
+        }
+
+        auto cpuUtil = std::make_unique<dcgmIntrospectCpuUtil_v2>();
+        auto st      = GetCpuUtilizationForHostengine(cpuUtil.get(), msg->waitIfNoData);
+
+        msg->cpuUtil.kernel = cpuUtil->kernel;
+        msg->cpuUtil.user   = cpuUtil->user;
+        msg->cpuUtil.total  = cpuUtil->total;
+        return st;
+    }
+
+    auto *msg = (dcgm_introspect_msg_he_cpu_util_v2 *)moduleCommand;
+
+    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_cpu_util_version2);
     if (DCGM_ST_OK != dcgmReturn)
     {
         return dcgmReturn; /* Logging handled by helper method */
     }
 
-    if (msg->cpuUtil.version != dcgmIntrospectCpuUtil_version1)
+    if (msg->cpuUtil.version != dcgmIntrospectCpuUtil_version2)
     {
-        log_warning("Version mismatch. expected {}. Got {}", dcgmIntrospectCpuUtil_version1, msg->cpuUtil.version);
+        log_warning("Version mismatch. expected {}. Got {}", dcgmIntrospectCpuUtil_version2, msg->cpuUtil.version);
         return DCGM_ST_VER_MISMATCH;
     }
 
@@ -133,21 +184,101 @@ std::optional<dcgmReturn_t> DcgmModuleIntrospect::ProcessMetadataHostEngineCpuUt
 
 /*****************************************************************************/
 std::optional<dcgmReturn_t> DcgmModuleIntrospect::ProcessMetadataHostEngineMemUsage(
-    dcgm_introspect_msg_he_mem_usage_v1 *msg)
+    dcgm_module_command_header_t *moduleCommand)
 {
-    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_mem_usage_version1);
+    if (moduleCommand->version == dcgm_introspect_msg_he_mem_usage_version1)
+    {
+        auto *msg = (dcgm_introspect_msg_he_mem_usage_v1 *)moduleCommand;
+
+        dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_mem_usage_version1);
+        if (DCGM_ST_OK != dcgmReturn)
+            return dcgmReturn; /* Logging handled by helper method */
+
+        if (msg->memoryInfo.version != dcgmIntrospectMemory_version1)
+        {
+            log_warning(
+                "Version mismatch. expected {}. Got {}", dcgmIntrospectMemory_version1, msg->memoryInfo.version);
+            return DCGM_ST_VER_MISMATCH;
+        }
+
+        dcgmIntrospectMemory_v2 memInfo {};
+        auto st                   = GetMemUsageForHostengine(&memInfo, msg->waitIfNoData);
+        msg->memoryInfo.bytesUsed = memInfo.bytesUsed;
+        return st;
+    }
+
+    auto *msg = (dcgm_introspect_msg_he_mem_usage_v2 *)moduleCommand;
+
+    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_he_mem_usage_version2);
     if (DCGM_ST_OK != dcgmReturn)
         return dcgmReturn; /* Logging handled by helper method */
 
-    if (msg->memoryInfo.version != dcgmIntrospectMemory_version1)
+    if (msg->memoryInfo.version != dcgmIntrospectMemory_version2)
     {
-        log_warning("Version mismatch. expected {}. Got {}", dcgmIntrospectMemory_version1, msg->memoryInfo.version);
+        log_warning("Version mismatch. expected {}. Got {}", dcgmIntrospectMemory_version2, msg->memoryInfo.version);
         return DCGM_ST_VER_MISMATCH;
     }
 
     return GetMemUsageForHostengine(&msg->memoryInfo, msg->waitIfNoData);
 }
 
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleIntrospect::ProcessFieldCosts(dcgm_introspect_msg_field_costs_v1 *msg)
+{
+    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_field_costs_version1);
+    if (DCGM_ST_OK != dcgmReturn)
+    {
+        return dcgmReturn; /* Logging handled by helper method */
+    }
+
+    if (msg->fieldCosts.version != dcgmIntrospectFieldCosts_version1)
+    {
+        log_warning(
+            "Version mismatch. expected {}. Got {}", dcgmIntrospectFieldCosts_version1, msg->fieldCosts.version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    return mpMetadataManager->GetFieldCosts(msg->fieldCosts);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleIntrospect::ProcessLockProfile(dcgm_introspect_msg_lock_profile_v1 *msg)
+{
+    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_lock_profile_version1);
+    if (DCGM_ST_OK != dcgmReturn)
+    {
+        return dcgmReturn; /* Logging handled by helper method */
+    }
+
+    if (msg->lockProfile.version != dcgmIntrospectLockProfile_version1)
+    {
+        log_warning(
+            "Version mismatch. expected {}. Got {}", dcgmIntrospectLockProfile_version1, msg->lockProfile.version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    return mpMetadataManager->GetLockProfile(msg->lockProfile);
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmModuleIntrospect::ProcessRuntimeStats(dcgm_introspect_msg_runtime_stats_v1 *msg)
+{
+    dcgmReturn_t dcgmReturn = CheckVersion(&msg->header, dcgm_introspect_msg_runtime_stats_version1);
+    if (DCGM_ST_OK != dcgmReturn)
+    {
+        return dcgmReturn; /* Logging handled by helper method */
+    }
+
+    if (msg->runtimeStats.version != dcgmIntrospectRuntimeStats_version1)
+    {
+        log_warning(
+            "Version mismatch. expected {}. Got {}", dcgmIntrospectRuntimeStats_version1, msg->runtimeStats.version);
+        return DCGM_ST_VER_MISMATCH;
+    }
+
+    return mpMetadataManager->GetRuntimeStats(msg->runtimeStats);
+}
+
 /*****************************************************************************/
 template <std::invocable Fn>
 dcgmReturn_t DcgmModuleIntrospect::ProcessInTaskRunner(Fn action)
@@ -253,13 +384,31 @@ dcgmReturn_t DcgmModuleIntrospect::ProcessMessage(dcgm_module_command_header_t *
         {
             case DCGM_INTROSPECT_SR_HOSTENGINE_MEM_USAGE:
                 retSt = ProcessInTaskRunnerWithAttempts(5, [this, moduleCommand]() mutable {
-                    return ProcessMetadataHostEngineMemUsage((dcgm_introspect_msg_he_mem_usage_v1 *)moduleCommand);
+                    return ProcessMetadataHostEngineMemUsage(moduleCommand);
                 });
                 break;
 
             case DCGM_INTROSPECT_SR_HOSTENGINE_CPU_UTIL:
                 retSt = ProcessInTaskRunnerWithAttempts(5, [this, moduleCommand]() mutable {
-                    return ProcessMetadataHostEngineCpuUtil((dcgm_introspect_msg_he_cpu_util_v1 *)moduleCommand);
+                    return ProcessMetadataHostEngineCpuUtil(moduleCommand);
+                });
+                break;
+
+            case DCGM_INTROSPECT_SR_FIELD_COSTS:
+                retSt = ProcessInTaskRunner([this, moduleCommand]() mutable {
+                    return ProcessFieldCosts((dcgm_introspect_msg_field_costs_v1 *)moduleCommand);
+                });
+                break;
+
+            case DCGM_INTROSPECT_SR_LOCK_PROFILE:
+                retSt = ProcessInTaskRunner([this, moduleCommand]() mutable {
+                    return ProcessLockProfile((dcgm_introspect_msg_lock_profile_v1 *)moduleCommand);
+                });
+                break;
+
+            case DCGM_INTROSPECT_SR_RUNTIME_STATS:
+                retSt = ProcessInTaskRunner([this, moduleCommand]() mutable {
+                    return ProcessRuntimeStats((dcgm_introspect_msg_runtime_stats_v1 *)moduleCommand);
                 });
                 break;
 
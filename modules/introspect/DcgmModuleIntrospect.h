@@ -52,14 +52,17 @@ private:
 
     /*************************************************************************/
     /* Request Processing helper methods */
-    std::optional<dcgmReturn_t> GetMemUsageForHostengine(dcgmIntrospectMemory_t *memInfo, int waitIfNoData);
-    std::optional<dcgmReturn_t> GetCpuUtilizationForHostengine(dcgmIntrospectCpuUtil_t *cpuUtil, int waitIfNoData);
+    std::optional<dcgmReturn_t> GetMemUsageForHostengine(dcgmIntrospectMemory_v2 *memInfo, int waitIfNoData);
+    std::optional<dcgmReturn_t> GetCpuUtilizationForHostengine(dcgmIntrospectCpuUtil_v2 *cpuUtil, int waitIfNoData);
 
     /*************************************************************************/
     /* Subrequest helpers
      */
-    std::optional<dcgmReturn_t> ProcessMetadataHostEngineCpuUtil(dcgm_introspect_msg_he_cpu_util_v1 *msg);
-    std::optional<dcgmReturn_t> ProcessMetadataHostEngineMemUsage(dcgm_introspect_msg_he_mem_usage_v1 *msg);
+    std::optional<dcgmReturn_t> ProcessMetadataHostEngineCpuUtil(dcgm_module_command_header_t *moduleCommand);
+    std::optional<dcgmReturn_t> ProcessMetadataHostEngineMemUsage(dcgm_module_command_header_t *moduleCommand);
+    dcgmReturn_t ProcessFieldCosts(dcgm_introspect_msg_field_costs_v1 *msg);
+    dcgmReturn_t ProcessLockProfile(dcgm_introspect_msg_lock_profile_v1 *msg);
+    dcgmReturn_t ProcessRuntimeStats(dcgm_introspect_msg_runtime_stats_v1 *msg);
 
     dcgmReturn_t ProcessCoreMessage(dcgm_module_command_header_t *moduleCommand);
 
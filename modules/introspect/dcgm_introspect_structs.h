@@ -24,7 +24,10 @@
 #define DCGM_INTROSPECT_SR_HOSTENGINE_MEM_USAGE 4
 #define DCGM_INTROSPECT_SR_HOSTENGINE_CPU_UTIL  5
 /* 6-7 are deprecated */
-#define DCGM_INTROSPECT_SR_COUNT 8 /* Keep as last entry and 1 greater */
+#define DCGM_INTROSPECT_SR_FIELD_COSTS  8
+#define DCGM_INTROSPECT_SR_LOCK_PROFILE  9
+#define DCGM_INTROSPECT_SR_RUNTIME_STATS 10
+#define DCGM_INTROSPECT_SR_COUNT         11 /* Keep as last entry and 1 greater */
 
 /*****************************************************************************/
 /* Subrequest message definitions */
@@ -37,13 +40,24 @@ typedef struct dcgm_introspect_msg_he_mem_usage_v1
 {
     dcgm_module_command_header_t header; /* Command header */
 
-    dcgmIntrospectMemory_t memoryInfo; /* Info about the host engine's memory usage */
+    dcgmIntrospectMemory_v1 memoryInfo; /* Info about the host engine's memory usage */
     int waitIfNoData; /* Should this request return immediately (0) or wait for data to be present if there is none (1)
                        */
 } dcgm_introspect_msg_he_mem_usage_v1;
 
 #define dcgm_introspect_msg_he_mem_usage_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_he_mem_usage_v1, 1)
 
+typedef struct dcgm_introspect_msg_he_mem_usage_v2
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmIntrospectMemory_v2 memoryInfo; /* Info about the host engine's memory usage */
+    int waitIfNoData; /* Should this request return immediately (0) or wait for data to be present if there is none (1)
+                       */
+} dcgm_introspect_msg_he_mem_usage_v2;
+
+#define dcgm_introspect_msg_he_mem_usage_version2 MAKE_DCGM_VERSION(dcgm_introspect_msg_he_mem_usage_v2, 2)
+
 /**
  * Subrequest DCGM_INTROSPECT_SR_HOSTENGINE_CPU_UTIL
  */
@@ -51,13 +65,60 @@ typedef struct dcgm_introspect_msg_he_cpu_util_v1
 {
     dcgm_module_command_header_t header; /* Command header */
 
-    dcgmIntrospectCpuUtil_t cpuUtil; /* Info about the host engine's CPU utilization */
+    dcgmIntrospectCpuUtil_v1 cpuUtil; /* Info about the host engine's CPU utilization */
     int waitIfNoData; /* Should this request return immediately (0) or wait for data to be present if there is none (1)
                        */
 } dcgm_introspect_msg_he_cpu_util_v1;
 
 #define dcgm_introspect_msg_he_cpu_util_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_he_cpu_util_v1, 1)
 
+typedef struct dcgm_introspect_msg_he_cpu_util_v2
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmIntrospectCpuUtil_v2 cpuUtil; /* Info about the host engine's CPU utilization */
+    int waitIfNoData; /* Should this request return immediately (0) or wait for data to be present if there is none (1)
+                       */
+} dcgm_introspect_msg_he_cpu_util_v2;
+
+#define dcgm_introspect_msg_he_cpu_util_version2 MAKE_DCGM_VERSION(dcgm_introspect_msg_he_cpu_util_v2, 2)
+
+/**
+ * Subrequest DCGM_INTROSPECT_SR_FIELD_COSTS
+ */
+typedef struct dcgm_introspect_msg_field_costs_v1
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmIntrospectFieldCosts_v1 fieldCosts; /* What each watched field of each entity costs the host engine */
+} dcgm_introspect_msg_field_costs_v1;
+
+#define dcgm_introspect_msg_field_costs_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_field_costs_v1, 1)
+
+/**
+ * Subrequest DCGM_INTROSPECT_SR_LOCK_PROFILE
+ */
+typedef struct dcgm_introspect_msg_lock_profile_v1
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmIntrospectLockProfile_v1 lockProfile; /* Contention profile of the host engine's mutexes */
+} dcgm_introspect_msg_lock_profile_v1;
+
+#define dcgm_introspect_msg_lock_profile_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_lock_profile_v1, 1)
+
+/**
+ * Subrequest DCGM_INTROSPECT_SR_RUNTIME_STATS
+ */
+typedef struct dcgm_introspect_msg_runtime_stats_v1
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmIntrospectRuntimeStats_v1 runtimeStats; /* Counters of the host engine's cache manager */
+} dcgm_introspect_msg_runtime_stats_v1;
+
+#define dcgm_introspect_msg_runtime_stats_version1 MAKE_DCGM_VERSION(dcgm_introspect_msg_runtime_stats_v1, 1)
+
 /*****************************************************************************/
 
 #endif // DCGM_INTROSPECT_STRUCTS_H
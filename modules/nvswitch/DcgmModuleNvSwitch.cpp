@@ -61,6 +61,7 @@ DcgmModuleNvSwitch::DcgmModuleNvSwitch(dcgmCoreCallbacks_t &dcc)
      *   - use NSCQ to rescan devices
      * That is undefined behaviour and causes lockups most of the time.
      */
+    SetThreadName("mod_nvswitch");
     int st = Start();
     if (st)
     {
@@ -195,6 +196,11 @@ dcgmReturn_t DcgmModuleNvSwitch::ProcessMessageFromTaskRunner(dcgm_module_comman
                 dcgm_nvswitch_msg_create_fake_switch_v1 *cfs = (dcgm_nvswitch_msg_create_fake_switch_v1 *)moduleCommand;
                 cfs->numCreated                              = cfs->numToCreate;
                 retSt = m_nvswitchMgr.CreateFakeSwitches(cfs->numCreated, cfs->switchIds);
+                if (retSt == DCGM_ST_OK)
+                {
+                    m_nvswitchMgr.PublishLinkStatesIfChanged();
+                    m_nvswitchMgr.PublishEntityStatusesIfChanged();
+                }
                 break;
             }
 
@@ -380,7 +386,13 @@ dcgmReturn_t DcgmModuleNvSwitch::ProcessGetLinkStates(dcgm_nvswitch_msg_get_link
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleNvSwitch::ProcessGetAllLinkStates(dcgm_nvswitch_msg_get_all_link_states_t *msg)
 {
-    return m_nvswitchMgr.GetAllLinkStates(msg);
+    dcgmReturn_t dcgmReturn = m_nvswitchMgr.GetAllLinkStates(msg);
+    if (dcgmReturn == DCGM_ST_OK)
+    {
+        /* Core only asks until we have pushed the link states once */
+        m_nvswitchMgr.PublishLinkStatesIfChanged();
+    }
+    return dcgmReturn;
 }
 
 /*****************************************************************************/
@@ -392,13 +404,22 @@ dcgmReturn_t DcgmModuleNvSwitch::SetEntityNvLinkLinkState(dcgm_nvswitch_msg_set_
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleNvSwitch::ProcessGetEntityStatus(dcgm_nvswitch_msg_get_entity_status_t *msg)
 {
-    return m_nvswitchMgr.GetEntityStatus(msg);
+    dcgmReturn_t dcgmReturn = m_nvswitchMgr.GetEntityStatus(msg);
+
+    /* Core only asks about switches until we have pushed their statuses once */
+    m_nvswitchMgr.PublishEntityStatusesIfChanged();
+    return dcgmReturn;
 }
 
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleNvSwitch::ProcessSetEntityNvLinkLinkState(dcgm_nvswitch_msg_set_link_state_t *msg)
 {
-    return m_nvswitchMgr.SetEntityNvLinkLinkState(msg);
+    dcgmReturn_t dcgmReturn = m_nvswitchMgr.SetEntityNvLinkLinkState(msg);
+    if (dcgmReturn == DCGM_ST_OK)
+    {
+        m_nvswitchMgr.PublishLinkStatesIfChanged();
+    }
+    return dcgmReturn;
 }
 
 /*****************************************************************************/
@@ -454,6 +475,8 @@ unsigned int DcgmModuleNvSwitch::RunOnce()
         {
             DCGM_LOG_WARNING << "ReadNvSwitchStatusAllSwitches() returned " << errorString(dcgmReturn);
         }
+        m_nvswitchMgr.PublishLinkStatesIfChanged();
+        m_nvswitchMgr.PublishEntityStatusesIfChanged();
 
         m_lastLinkStatusUpdateUsec = now;
         untilNextLinkStatusUsec    = linkStatusRescanIntervalUsec;
@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <optional>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <DcgmLogging.h>
 #include <DcgmSettings.h>
@@ -302,11 +305,6 @@ dcgmReturn_t DcgmNscqManager::UpdateFatalErrorsAllSwitches()
     return ret;
 }
 
-/**
- * Map of fieldIds to the entities for which we want the data for that field.
- */
-using fieldEntityMapType = std::map<unsigned short, std::vector<dcgm_field_update_info_t>>;
-
 /*************************************************************************/
 dcgmReturn_t DcgmNscqManager::UpdateFieldsFromNvswitchLibrary(unsigned short fieldId,
                                                               DcgmFvBuffer &buf,
@@ -327,6 +325,130 @@ dcgmReturn_t DcgmNscqManager::UpdateFieldsFromNvswitchLibrary(unsigned short fie
     return (this->*internalFieldId->UpdateFunc())(fieldId, buf, entities, now);
 }
 
+/*************************************************************************/
+dcgmReturn_t DcgmNscqManager::UpdateAllFieldsFromNvswitchLibrary(const fieldEntityMapType &fieldEntityMap,
+                                                                 DcgmFvBuffer &buf,
+                                                                 timelib64_t now)
+{
+    dcgmReturn_t ret = DCGM_ST_OK;
+    std::vector<unsigned short> done;
+
+    m_cycleObservations.emplace();
+
+    /* Go path by path so that the data of a path can be dropped as soon as its fields are updated */
+    for (auto const &[nscqPath, fieldIds] : m_watchedPaths)
+    {
+        for (auto fieldId : fieldIds)
+        {
+            auto it = fieldEntityMap.find(fieldId);
+            if (it == fieldEntityMap.end())
+            {
+                continue;
+            }
+
+            ret = UpdateFieldsFromNvswitchLibrary(fieldId, buf, it->second, now);
+            done.push_back(fieldId);
+            if (ret != DCGM_ST_OK)
+            {
+                break;
+            }
+        }
+
+        m_cycleObservations->erase(nscqPath);
+
+        if (ret != DCGM_ST_OK)
+        {
+            break;
+        }
+    }
+
+    /* Fields NSCQ doesn't provide, blanked one by one */
+    for (auto const &[fieldId, entities] : fieldEntityMap)
+    {
+        if (ret != DCGM_ST_OK)
+        {
+            break;
+        }
+
+        if (std::find(done.begin(), done.end(), fieldId) == done.end())
+        {
+            ret = UpdateFieldsFromNvswitchLibrary(fieldId, buf, entities, now);
+        }
+    }
+
+    m_cycleObservations.reset();
+
+    return ret;
+}
+
+/*************************************************************************/
+void DcgmNscqManager::OnWatchesChanged()
+{
+    std::vector<dcgm_entity_key_t> watched;
+    m_watchTable.GetWatchedKeys(DcgmModuleIdNvSwitch, watched);
+
+    m_watchedPaths.clear();
+
+    for (auto const &watchKey : watched)
+    {
+        const FieldIdControlType<DCGM_FI_UNKNOWN> *internalFieldId = FieldIdFind(watchKey.fieldId);
+
+        if (internalFieldId == nullptr || internalFieldId->NscqPath() == nullptr)
+        {
+            continue;
+        }
+
+        auto &fieldIds = m_watchedPaths[internalFieldId->NscqPath()];
+
+        if (std::find(fieldIds.begin(), fieldIds.end(), watchKey.fieldId) == fieldIds.end())
+        {
+            fieldIds.push_back(watchKey.fieldId);
+        }
+    }
+
+    log_debug("{} watches need {} NSCQ paths", watched.size(), m_watchedPaths.size());
+}
+
+/*************************************************************************/
+nscq_rc_t DcgmNscqManager::ObservePath(const char *nscqPath, nscq_fn_t callback, void *data)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    nscq_rc_t ret = nscq_session_path_observe(m_nscqSession, nscqPath, callback, data, 0);
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::uint64_t const usec = elapsed.count();
+
+    NscqPathStats &stats = m_pathStats[nscqPath];
+    stats.observeCount++;
+    stats.totalUsec += usec;
+    stats.maxUsec  = std::max(stats.maxUsec, usec);
+    stats.lastUsec = usec;
+
+    return ret;
+}
+
+/*************************************************************************/
+void DcgmNscqManager::LogPathStats() const
+{
+    std::vector<std::pair<std::string, NscqPathStats>> sorted(m_pathStats.begin(), m_pathStats.end());
+
+    std::sort(sorted.begin(), sorted.end(), [](auto const &a, auto const &b) {
+        return a.second.totalUsec > b.second.totalUsec;
+    });
+
+    for (auto const &[nscqPath, stats] : sorted)
+    {
+        log_debug("NSCQ path {}: {} observes, {} usec total, {} usec avg, {} usec max, {} usec last",
+                  nscqPath,
+                  stats.observeCount,
+                  stats.totalUsec,
+                  stats.totalUsec / stats.observeCount,
+                  stats.maxUsec,
+                  stats.lastUsec);
+    }
+}
+
 /*************************************************************************/
 dcgmReturn_t DcgmNscqManager::Init()
 {
@@ -586,7 +708,7 @@ dcgmReturn_t DcgmNscqManager::AttachNvSwitches()
         dest->data.push_back(item);
     };
 
-    nscq_rc_t ret = nscq_session_path_observe(m_nscqSession, nscqPath, NSCQ_FN(*cb), &collector, 0);
+    nscq_rc_t ret = ObservePath(nscqPath, NSCQ_FN(*cb), &collector);
 
     log_debug("Callback called {} times", collector.callCounter);
 
@@ -715,7 +837,7 @@ dcgmReturn_t DcgmNscqManager::ReadNvSwitchStatusAllSwitches()
         dest->data.push_back(item);
     };
 
-    nscq_rc_t ret = nscq_session_path_observe(m_nscqSession, nscqPath, NSCQ_FN(*cb), &collector, 0);
+    nscq_rc_t ret = ObservePath(nscqPath, NSCQ_FN(*cb), &collector);
 
     log_debug("Callback called {} times", collector.callCounter);
 
@@ -752,6 +874,7 @@ dcgmReturn_t DcgmNscqManager::ReadNvSwitchStatusAllSwitches()
     }
 
     UpdateFatalErrorsAllSwitches();
+    LogPathStats();
     return dcgmReturn;
 }
 
@@ -812,7 +935,7 @@ dcgmReturn_t DcgmNscqManager::ReadLinkStatesAllSwitches()
         dest->data.push_back(item);
     };
 
-    nscq_rc_t ret = nscq_session_path_observe(m_nscqSession, nscqPath, NSCQ_FN(*cb), &collector, 0);
+    nscq_rc_t ret = ObservePath(nscqPath, NSCQ_FN(*cb), &collector);
 
     if (NSCQ_ERROR(ret))
     {
@@ -949,7 +1072,7 @@ dcgmReturn_t DcgmNscqManager::ReadNvSwitchFatalErrorsAllSwitches()
         dest->data.push_back(item);
     };
 
-    nscq_rc_t ret = nscq_session_path_observe(m_nscqSession, nscqPath, NSCQ_FN(*cb), &collector, 0);
+    nscq_rc_t ret = ObservePath(nscqPath, NSCQ_FN(*cb), &collector);
 
     log_debug("Callback called {} times", collector.callCounter);
 
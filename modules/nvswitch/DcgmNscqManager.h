@@ -15,7 +15,12 @@
  */
 #pragma once
 
+#include <any>
+#include <cstdint>
 #include <map>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "dcgm_nvswitch_structs.h"
 
@@ -33,6 +38,17 @@ using uuid_p       = nscq_uuid_t *;
 using link_id_t    = uint32_t;
 using lane_vc_id_t = uint32_t;
 
+/**
+ * How long nscq_session_path_observe took for one NSCQ path
+ */
+struct NscqPathStats
+{
+    std::uint64_t observeCount = 0; // Number of observes of the path
+    std::uint64_t totalUsec    = 0; // Time spent in all of them
+    std::uint64_t maxUsec      = 0; // The slowest one
+    std::uint64_t lastUsec     = 0; // The most recent one
+};
+
 class DcgmNscqManager : public DcgmNvSwitchManagerBase
 {
 public:
@@ -131,6 +147,38 @@ public:
                                                  const std::vector<dcgm_field_update_info_t> &entities,
                                                  timelib64_t now) override;
 
+    /*************************************************************************/
+    /**
+     * Update all the fields in fieldEntityMap, observing every NSCQ path they
+     * need once. Fields that share a path (lanes, virtual circuits, the
+     * members of one NSCQ structure) are filled in from the same observation.
+     *
+     * Returns DCGM_ST_OK on success.
+     *         DCGM_ST_? on error.
+     */
+    dcgmReturn_t UpdateAllFieldsFromNvswitchLibrary(const fieldEntityMapType &fieldEntityMap,
+                                                    DcgmFvBuffer &buf,
+                                                    timelib64_t now) override;
+
+    /*************************************************************************/
+    /**
+     * Returns the NSCQ paths needed by the watched fields, each with the
+     * fields it provides. Rebuilt whenever watches change.
+     */
+    const std::map<std::string, std::vector<unsigned short>> &GetWatchedPaths() const
+    {
+        return m_watchedPaths;
+    }
+
+    /*************************************************************************/
+    /**
+     * Returns the time spent observing each NSCQ path so far
+     */
+    const std::map<std::string, NscqPathStats> &GetPathStats() const
+    {
+        return m_pathStats;
+    }
+
     /*************************************************************************/
     /**
      * Initialize Switch Manager
@@ -182,12 +230,35 @@ public:
 protected:
     uuid_p m_nvSwitchNscqDevices[DCGM_MAX_NUM_SWITCHES];    // Pointers to NSCQ device objects
     label_t m_nvSwitchUuids[DCGM_MAX_NUM_SWITCHES];         // UUID labels associated with each NvSwitch
-    DcgmWatchTable m_watchTable;                            // Our internal watch table
     nscq_session_t m_nscqSession;                           // NSCQ session for communicating with driver
     bool m_attachedToNscq = false;                          // Have we attached to nscq yet? */
     DcgmNvSwitchError m_fatalErrors[DCGM_MAX_NUM_SWITCHES]; // Fatal errors. Max 1 per switch
     bool m_paused = false;                                  // Is the Switch Manager paused?
 
+    std::map<std::string, std::vector<unsigned short>> m_watchedPaths; // NSCQ path -> watched fields it provides
+    std::map<std::string, NscqPathStats> m_pathStats;                  // NSCQ path -> observe timings
+
+    /* NSCQ path -> collected data. Only set during UpdateAllFieldsFromNvswitchLibrary */
+    std::optional<std::map<std::string, std::any>> m_cycleObservations;
+
+    /*************************************************************************/
+    /**
+     * Rebuild m_watchedPaths from the watch table
+     */
+    void OnWatchesChanged() override;
+
+    /*************************************************************************/
+    /**
+     * nscq_session_path_observe(), timed into m_pathStats
+     */
+    nscq_rc_t ObservePath(const char *nscqPath, nscq_fn_t callback, void *data);
+
+    /*************************************************************************/
+    /**
+     * Log the paths that took the most time so far, slowest first
+     */
+    void LogPathStats() const;
+
     /*************************************************************************/
     /**
      * Returns a pointer to the internal NvSwitch object by looking up its
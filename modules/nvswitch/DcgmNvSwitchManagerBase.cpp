@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <optional>
 #include <string>
 
@@ -226,6 +228,8 @@ dcgmReturn_t DcgmNvSwitchManagerBase::WatchField(const dcgm_field_entity_group_t
         m_watchTable.AddWatcher(entityGroupId, entityId, fieldIds[i], watcher, updateIntervalUsec, maxAgeUsec, false);
     }
 
+    OnWatchesChanged();
+
     return DCGM_ST_OK;
 }
 
@@ -234,7 +238,11 @@ dcgmReturn_t DcgmNvSwitchManagerBase::UnwatchField(DcgmWatcherType_t watcherType
 {
     DcgmWatcher watcher(watcherType, connectionId);
     /* No call to Cache Manager to avoid infinite loop */
-    return m_watchTable.RemoveWatches(watcher, nullptr);
+    dcgmReturn_t ret = m_watchTable.RemoveWatches(watcher, nullptr);
+
+    OnWatchesChanged();
+
+    return ret;
 }
 
 /*************************************************************************/
@@ -295,11 +303,6 @@ dcgmReturn_t DcgmNvSwitchManagerBase::UpdateFatalErrorsAllSwitches()
     return ret;
 }
 
-/**
- * Map of fieldIds to the entities for which we want the data for that field.
- */
-using fieldEntityMapType = std::map<unsigned short, std::vector<dcgm_field_update_info_t>>;
-
 /*************************************************************************/
 /* Helper to buffer up a blank value for every entity. This is useful when
    the fieldId in question isn't supported by DCGM or NSCQ yet */
@@ -360,16 +363,17 @@ dcgmReturn_t DcgmNvSwitchManagerBase::UpdateFields(timelib64_t &nextUpdateTime)
         fieldEntityMap[fieldInfo.fieldMeta->fieldId].push_back(fieldInfo);
     }
 
-    for (const auto &[fieldId, entities] : fieldEntityMap)
+    if (m_paused)
     {
-        if (m_paused)
+        for (const auto &[fieldId, entities] : fieldEntityMap)
         {
             log_debug("The NvSwitch module is paused. Filling fieldId {} with blank values", fieldId);
             BufferBlankValueForAllEntities(fieldId, buf, entities);
-            continue;
         }
-
-        ret = this->UpdateFieldsFromNvswitchLibrary(fieldId, buf, entities, now);
+    }
+    else
+    {
+        ret = UpdateAllFieldsFromNvswitchLibrary(fieldEntityMap, buf, now);
 
         if (ret != DCGM_ST_OK)
         {
@@ -403,6 +407,127 @@ dcgmReturn_t DcgmNvSwitchManagerBase::UpdateFields(timelib64_t &nextUpdateTime)
     return ret;
 }
 
+/*************************************************************************/
+dcgmReturn_t DcgmNvSwitchManagerBase::UpdateAllFieldsFromNvswitchLibrary(const fieldEntityMapType &fieldEntityMap,
+                                                                         DcgmFvBuffer &buf,
+                                                                         timelib64_t now)
+{
+    for (const auto &[fieldId, entities] : fieldEntityMap)
+    {
+        dcgmReturn_t ret = UpdateFieldsFromNvswitchLibrary(fieldId, buf, entities, now);
+
+        if (ret != DCGM_ST_OK)
+        {
+            return ret;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*************************************************************************/
+static void RecordSwitchRead(NvSwitchReadStats &stats, std::uint64_t usec)
+{
+    stats.reads++;
+    stats.lastUsec = usec;
+    stats.maxUsec  = std::max(stats.maxUsec, usec);
+}
+
+/*************************************************************************/
+dcgmReturn_t DcgmNvSwitchManagerBase::RunSwitchReads(std::vector<NvSwitchRead> const &reads,
+                                                     std::vector<unsigned int> &timedOut)
+{
+    using namespace std::chrono;
+
+    if (m_switchReadPool == nullptr)
+    {
+        m_switchReadPool = std::make_unique<WorkStealingThreadPool>(m_switchReadThreads, "nvswitch_read");
+    }
+
+    /* Reads that overran an earlier cycle only count towards the stats once they finish */
+    for (auto it = m_switchReadsInFlight.begin(); it != m_switchReadsInFlight.end();)
+    {
+        if (it->second.wait_for(seconds(0)) != std::future_status::ready)
+        {
+            ++it;
+            continue;
+        }
+
+        RecordSwitchRead(m_switchReadStats[it->first], it->second.get().second);
+        it = m_switchReadsInFlight.erase(it);
+    }
+
+    auto const deadline = steady_clock::now() + m_switchReadTimeout;
+    std::vector<std::pair<NvSwitchRead const *, std::shared_future<std::pair<dcgmReturn_t, std::uint64_t>>>> started;
+
+    for (auto const &read : reads)
+    {
+        if (m_switchReadsInFlight.contains(read.switchId))
+        {
+            log_warning("NvSwitch {} is still busy with the read of an earlier update. Skipping it", read.switchId);
+            m_switchReadStats[read.switchId].timeouts++;
+            timedOut.push_back(read.switchId);
+            continue;
+        }
+
+        auto result = m_switchReadPool->Enqueue([func = read.read]() {
+            auto const start = steady_clock::now();
+            dcgmReturn_t ret = func();
+            auto const usec  = duration_cast<microseconds>(steady_clock::now() - start).count();
+            return std::make_pair(ret, static_cast<std::uint64_t>(usec));
+        });
+
+        if (!result.has_value())
+        {
+            log_error("Could not queue the read of NvSwitch {}", read.switchId);
+            return DCGM_ST_GENERIC_ERROR;
+        }
+
+        started.emplace_back(&read, std::move(*result));
+    }
+
+    dcgmReturn_t ret = DCGM_ST_OK;
+
+    for (auto &[read, result] : started)
+    {
+        if (result.wait_until(deadline) != std::future_status::ready)
+        {
+            log_warning("NvSwitch {} was not read within {} usec. Its fields are blank this time",
+                        read->switchId,
+                        m_switchReadTimeout.count());
+            m_switchReadStats[read->switchId].timeouts++;
+            m_switchReadsInFlight[read->switchId] = result;
+            timedOut.push_back(read->switchId);
+            continue;
+        }
+
+        auto const [readRet, usec] = result.get();
+        RecordSwitchRead(m_switchReadStats[read->switchId], usec);
+        log_debug("Read NvSwitch {} in {} usec", read->switchId, usec);
+
+        read->commit();
+
+        if (readRet != DCGM_ST_OK && ret == DCGM_ST_OK)
+        {
+            ret = readRet;
+        }
+    }
+
+    return ret;
+}
+
+/*************************************************************************/
+void DcgmNvSwitchManagerBase::WaitForSwitchReads()
+{
+    for (auto &[switchId, result] : m_switchReadsInFlight)
+    {
+        log_debug("Waiting for the read of NvSwitch {}", switchId);
+        RecordSwitchRead(m_switchReadStats[switchId], result.get().second);
+    }
+
+    m_switchReadsInFlight.clear();
+}
+
 /*************************************************************************/
 dcgmReturn_t DcgmNvSwitchManagerBase::GetLinkStates(dcgm_nvswitch_msg_get_link_states_t *msg)
 {
@@ -447,6 +572,68 @@ dcgmReturn_t DcgmNvSwitchManagerBase::GetAllLinkStates(dcgm_nvswitch_msg_get_all
     return DCGM_ST_OK;
 }
 
+/*************************************************************************/
+dcgmReturn_t DcgmNvSwitchManagerBase::PublishLinkStatesIfChanged()
+{
+    auto msg                = std::make_unique<dcgm_nvswitch_msg_get_all_link_states_t>();
+    dcgmReturn_t dcgmReturn = GetAllLinkStates(msg.get());
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    dcgmNvLinkStatus_v4 const &linkStatus = msg->linkStatus;
+    if (m_publishedLinkStatus != nullptr && m_publishedLinkStatus->numNvSwitches == linkStatus.numNvSwitches
+        && memcmp(m_publishedLinkStatus->nvSwitches, linkStatus.nvSwitches, sizeof(linkStatus.nvSwitches)) == 0)
+    {
+        return DCGM_ST_OK;
+    }
+
+    dcgmReturn = m_coreProxy.SetNvSwitchLinkStatus(linkStatus.numNvSwitches, linkStatus.nvSwitches);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error(
+            "Unable to push the link states of {} NvSwitches: {}", linkStatus.numNvSwitches, errorString(dcgmReturn));
+        return dcgmReturn;
+    }
+
+    if (m_publishedLinkStatus == nullptr)
+    {
+        m_publishedLinkStatus = std::make_unique<dcgmNvLinkStatus_v4>();
+    }
+    *m_publishedLinkStatus = linkStatus;
+    return DCGM_ST_OK;
+}
+
+/*************************************************************************/
+dcgmReturn_t DcgmNvSwitchManagerBase::PublishEntityStatusesIfChanged()
+{
+    std::vector<dcgmCoreEntityStatus_t> statuses;
+    statuses.reserve(m_numNvSwitches);
+    for (unsigned int i = 0; i < m_numNvSwitches; i++)
+    {
+        statuses.push_back({ m_nvSwitches[i].physicalId, static_cast<unsigned int>(m_nvSwitches[i].status) });
+    }
+
+    auto const sameStatus = [](dcgmCoreEntityStatus_t const &a, dcgmCoreEntityStatus_t const &b) {
+        return a.entityId == b.entityId && a.status == b.status;
+    };
+    if (m_publishedEntityStatuses.has_value() && std::ranges::equal(*m_publishedEntityStatuses, statuses, sameStatus))
+    {
+        return DCGM_ST_OK;
+    }
+
+    dcgmReturn_t dcgmReturn = m_coreProxy.SetEntityStatuses(DCGM_FE_SWITCH, statuses);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        log_error("Unable to push the statuses of {} NvSwitches: {}", statuses.size(), errorString(dcgmReturn));
+        return dcgmReturn;
+    }
+
+    m_publishedEntityStatuses = std::move(statuses);
+    return DCGM_ST_OK;
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmNvSwitchManagerBase::GetEntityStatus(dcgm_nvswitch_msg_get_entity_status_t *msg)
 {
@@ -15,17 +15,31 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "dcgm_nvswitch_structs.h"
 
 #include <DcgmCoreProxy.h>
 #include <DcgmMutex.h>
 #include <DcgmWatchTable.h>
+#include <WorkStealingThreadPool.hpp>
 #include <dcgm_structs.h>
 
 namespace DcgmNs
 {
+/**
+ * Map of fieldIds to the entities for which we want the data for that field.
+ */
+using fieldEntityMapType = std::map<unsigned short, std::vector<dcgm_field_update_info_t>>;
+
 
 class DcgmNvSwitchFieldWatch
 {
@@ -44,6 +58,29 @@ public:
     int port           = -1; // -1 indicates not port-specific
 };
 
+/**
+ * How long the library reads of one NvSwitch took
+ */
+struct NvSwitchReadStats
+{
+    std::uint64_t reads    = 0; // Reads that finished
+    std::uint64_t lastUsec = 0; // The last one that finished
+    std::uint64_t maxUsec  = 0; // The slowest one that finished
+    std::uint64_t timeouts = 0; // Update cycles that went on without this switch
+};
+
+/**
+ * The part of an update cycle that reads one NvSwitch. read runs on a worker
+ * of the switch read pool and must not touch the manager. commit runs on the
+ * updating thread afterwards, and only if read finished in time.
+ */
+struct NvSwitchRead
+{
+    unsigned int switchId;
+    std::function<dcgmReturn_t()> read;
+    std::function<void()> commit;
+};
+
 class DcgmNvSwitchManagerBase
 {
 public:
@@ -154,6 +191,28 @@ public:
      */
     virtual dcgmReturn_t GetAllLinkStates(dcgm_nvswitch_msg_get_all_link_states_t *msg);
 
+    /*************************************************************************/
+    /**
+     * Push the NvLink link states of every NvSwitch to the cache manager if
+     * they changed since the last push. dcgmGetNvLinkLinkStatus() is served
+     * from what was pushed rather than by asking this module each time
+     *
+     * @return DCGM_ST_OK:            Link states pushed or unchanged
+     *         DCGM_ST_*:             Indicating any other return
+     */
+    dcgmReturn_t PublishLinkStatesIfChanged();
+
+    /*************************************************************************/
+    /**
+     * Push the status of every NvSwitch to the cache manager if any changed
+     * since the last push. Status checks of switches are then served by the
+     * cache manager without asking this module
+     *
+     * @return DCGM_ST_OK:            Statuses pushed or unchanged
+     *         DCGM_ST_*:             Indicating any other return
+     */
+    dcgmReturn_t PublishEntityStatusesIfChanged();
+
     /*************************************************************************/
     /**
      * Updates the fatal error fields in CacheManager
@@ -175,6 +234,16 @@ public:
      */
     virtual dcgmReturn_t UpdateFields(timelib64_t &nextUpdateTime);
 
+    /*************************************************************************/
+    /**
+     * Returns the read latency of every NvSwitch read by RunSwitchReads()
+     * so far, by switch id
+     */
+    const std::map<unsigned int, NvSwitchReadStats> &GetSwitchReadStats() const
+    {
+        return m_switchReadStats;
+    }
+
     /*************************************************************************/
     /*
      * Process a dcgm_nvswitch_msg_set_link_state_t message.
@@ -245,12 +314,43 @@ public:
 #ifndef DCGM_NVSWITCH_TEST // Allow tests to peek in
 protected:
 #endif
-    unsigned int m_numNvSwitches;                             // Number of entries in m_nvSwitches that are valid
-    dcgm_nvswitch_info_t m_nvSwitches[DCGM_MAX_NUM_SWITCHES]; // All of the NvSwitches we know about
-    DcgmWatchTable m_watchTable;                              // Our internal watch table
-    DcgmCoreProxy m_coreProxy;                                // Proxy class for communication with DCGM core
-    DcgmNvSwitchError m_fatalErrors[DCGM_MAX_NUM_SWITCHES];   // Fatal errors. Max 1 per switch
-    bool m_paused = false;                                    // Is the Switch Manager paused?
+    unsigned int m_numNvSwitches;                               // Number of entries in m_nvSwitches that are valid
+    dcgm_nvswitch_info_t m_nvSwitches[DCGM_MAX_NUM_SWITCHES];   // All of the NvSwitches we know about
+    DcgmWatchTable m_watchTable;                                // Our internal watch table
+    DcgmCoreProxy m_coreProxy;                                  // Proxy class for communication with DCGM core
+    DcgmNvSwitchError m_fatalErrors[DCGM_MAX_NUM_SWITCHES];     // Fatal errors. Max 1 per switch
+    bool m_paused = false;                                      // Is the Switch Manager paused?
+    std::unique_ptr<dcgmNvLinkStatus_v4> m_publishedLinkStatus; // Last pushed by PublishLinkStatesIfChanged()
+    std::optional<std::vector<dcgmCoreEntityStatus_t>> m_publishedEntityStatuses; // By PublishEntityStatusesIfChanged()
+
+    std::unique_ptr<WorkStealingThreadPool> m_switchReadPool;  // Runs NvSwitchRead::read. Created on first use
+    unsigned int m_switchReadThreads = 8;                      // Size of m_switchReadPool
+    std::chrono::microseconds m_switchReadTimeout { 2000000 }; // How long an update cycle waits for a switch
+    std::map<unsigned int, NvSwitchReadStats> m_switchReadStats;
+    std::map<unsigned int, std::shared_future<std::pair<dcgmReturn_t, std::uint64_t>>> m_switchReadsInFlight;
+
+    /*************************************************************************/
+    /**
+     * Run the reads of several NvSwitches at the same time and wait for them,
+     * but no longer than m_switchReadTimeout. The reads that finish in time
+     * are committed in the order they were given. A switch whose read from
+     * an earlier cycle is still running is not read again until it finishes.
+     *
+     * @param reads[in]     - One read per switch
+     * @param timedOut[out] - Switches that weren't read in time and whose
+     *                        commit wasn't called
+     *
+     * @return DCGM_ST_OK if every read that finished in time succeeded
+     *         The error of the first one that failed otherwise
+     */
+    dcgmReturn_t RunSwitchReads(std::vector<NvSwitchRead> const &reads, std::vector<unsigned int> &timedOut);
+
+    /*************************************************************************/
+    /**
+     * Wait for the switch reads that are still running. Call this before
+     * detaching from the library they use.
+     */
+    void WaitForSwitchReads();
 
     /*************************************************************************/
     /**
@@ -331,6 +431,31 @@ protected:
                                                          timelib64_t now)
         = 0;
 
+    /*************************************************************************/
+    /**
+     * Update every due field from external library.
+     *
+     * The default calls UpdateFieldsFromNvswitchLibrary() once per fieldId. Backends that can read several
+     * fields in one library call override this.
+     *
+     * @param fieldEntityMap[in] - Due entities of each fieldId
+     * @param buf[out]           - DcgmFvBuffer type which needs to be populated with the field values.
+     * @param now[in]            - Current time
+     *
+     * Returns DCGM_ST_OK on success.
+     *         DCGM_ST_? on error.
+     */
+    virtual dcgmReturn_t UpdateAllFieldsFromNvswitchLibrary(const fieldEntityMapType &fieldEntityMap,
+                                                            DcgmFvBuffer &buf,
+                                                            timelib64_t now);
+
+    /*************************************************************************/
+    /**
+     * Called after watches were added to or removed from m_watchTable
+     */
+    virtual void OnWatchesChanged()
+    {}
+
     /*************************************************************************/
     /**
      * Perform pre checks before adding a watch on fields.
@@ -15,6 +15,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -50,11 +53,6 @@ DcgmNvsdmManager::~DcgmNvsdmManager()
     DetachFromNvsdm();
 }
 
-/**
- * Map of fieldIds to the entities for which we want the data for that field.
- */
-using fieldEntityMapType = std::map<unsigned short, std::vector<dcgm_field_update_info_t>>;
-
 /*************************************************************************/
 static unsigned int getNvsdmPortFieldId(unsigned int dcgmFieldId)
 {
@@ -258,89 +256,189 @@ static dcgmReturn_t nvsdmAddValToFvBuffer(const dcgm_field_entity_group_t entity
 }
 
 /*************************************************************************/
-dcgmReturn_t DcgmNvsdmManager::HandleCompositeFieldId(const dcgm_field_entity_group_t entityGroupId,
-                                                      const unsigned int entityId,
-                                                      unsigned short fieldId,
-                                                      nvsdmTelemParam_t &param,
-                                                      timelib64_t now,
-                                                      DcgmFvBuffer &buf)
+void DcgmNvsdmManager::GetTelemSources(dcgm_field_entity_group_t entityGroupId,
+                                       dcgm_field_eid_t entityId,
+                                       unsigned short fieldId,
+                                       std::vector<NvsdmTelemSource> &sources)
 {
-    unsigned int portId;
-    nvsdmVal_t compositeNvsdmVal;
-    unsigned int nvsdmPortFieldId = getNvsdmPortFieldId(fieldId);
-    if (nvsdmPortFieldId == NVSDM_PORT_TELEM_CTR_NONE)
+    if (entityGroupId == DCGM_FE_LINK)
     {
-        log_error("DCGM fieldId {} doesn't map to any of the nvsdm port field ids.", fieldId);
-        return DCGM_ST_UNKNOWN_FIELD;
+        unsigned int nvsdmPortFieldId = getNvsdmPortFieldId(fieldId);
+        if (entityId < m_numNvsdmPorts && nvsdmPortFieldId != NVSDM_PORT_TELEM_CTR_NONE)
+        {
+            sources.push_back({ entityId, NVSDM_TELEM_TYPE_PORT, (uint16_t)nvsdmPortFieldId });
+        }
     }
-
-    param.telemValsArray[0].telemType = NVSDM_TELEM_TYPE_PORT;
-    param.telemValsArray[0].telemCtr  = nvsdmPortFieldId;
-    compositeNvsdmVal.u64Val          = 0;
-
-    for (unsigned int i = 0; i < m_nvsdmDevices[entityId].numOfPorts; i++)
+    else if (entityGroupId == DCGM_FE_SWITCH)
     {
-        if (m_nvSwitches[entityId].nvLinkLinkState[i] != DcgmNvLinkLinkStateUp)
+        if (entityId >= m_numNvSwitches || entityId >= m_nvsdmDevices.size())
         {
-            continue;
+            return;
         }
 
-        param.telemValsArray[0].val.u64Val = 0; /* Reset val before querying. */
+        if (isCompositeFieldId(fieldId))
+        {
+            unsigned int nvsdmPortFieldId = getNvsdmPortFieldId(fieldId);
+            for (unsigned int i = 0; i < m_nvsdmDevices[entityId].numOfPorts; i++)
+            {
+                if (m_nvSwitches[entityId].nvLinkLinkState[i] == DcgmNvLinkLinkStateUp)
+                {
+                    sources.push_back(
+                        { m_nvsdmDevices[entityId].portIds[i], NVSDM_TELEM_TYPE_PORT, (uint16_t)nvsdmPortFieldId });
+                }
+            }
+            return;
+        }
 
-        portId         = m_nvsdmDevices[entityId].portIds[i];
-        nvsdmRet_t ret = nvsdmPortGetTelemetryValues(m_nvsdmPorts[portId].port, &param);
-        if (ret != NVSDM_SUCCESS || param.telemValsArray[0].status != NVSDM_SUCCESS)
+        unsigned int nvsdmPlatformFieldId = getNvsdmPlatformFieldId(fieldId);
+        if (nvsdmPlatformFieldId != NVSDM_PLATFORM_TELEM_CTR_NONE)
         {
-            log_error(
-                "Failed to get telemetry values from nvsdm for telemetry type {}, counter {} and status {}, returned {}",
-                param.telemValsArray[0].telemType,
-                param.telemValsArray[0].telemCtr,
-                param.telemValsArray[0].status,
-                ret);
-            return DCGM_ST_NVML_ERROR;
+            /* TODO(DCGM-4299): Using port 0 from switch for stub testing. Revisit after nvsdm library is live. */
+            sources.push_back(
+                { m_nvsdmDevices[entityId].portIds[0], NVSDM_TELEM_TYPE_PLATFORM, (uint16_t)nvsdmPlatformFieldId });
         }
+    }
+}
+
+/*************************************************************************/
+nvsdmTelem_v1_t &DcgmNvsdmManager::FindOrAddTelem(NvsdmTelemSource const &source)
+{
+    if (source.portId >= m_portTelemRequests.size())
+    {
+        m_portTelemRequests.resize(source.portId + 1);
+    }
 
-        /* TODO: For stub we are only using u64Val. We will need to handle more val types for live testing. */
-        if ((UINT64_MAX - compositeNvsdmVal.u64Val) < param.telemValsArray[0].val.u64Val)
+    auto &telemVals = m_portTelemRequests[source.portId].telemVals;
+    for (auto &telem : telemVals)
+    {
+        if (telem.telemType == source.telemType && telem.telemCtr == source.telemCtr)
         {
-            log_error("Overflow detected for u64 addition while adding value [{}] to composite value [{}].",
-                      param.telemValsArray[0].val.u64Val,
-                      compositeNvsdmVal.u64Val);
-            return DCGM_ST_MAX_LIMIT;
+            return telem;
         }
-        compositeNvsdmVal.u64Val += param.telemValsArray[0].val.u64Val;
     }
 
-    dcgmReturn_t dcgmReturn
-        = nvsdmAddValToFvBuffer(entityGroupId, entityId, fieldId, compositeNvsdmVal, NVSDM_VAL_TYPE_UINT64, now, buf);
-    if (dcgmReturn != DCGM_ST_OK)
+    nvsdmTelem_v1_t telem {};
+    telem.telemType = source.telemType;
+    telem.telemCtr  = source.telemCtr;
+    telem.status    = NVSDM_ERROR_TELEMETRY_READ; /* Not read yet */
+    return telemVals.emplace_back(telem);
+}
+
+/*************************************************************************/
+void DcgmNvsdmManager::OnWatchesChanged()
+{
+    std::vector<dcgm_entity_key_t> watched;
+    m_watchTable.GetWatchedKeys(DcgmModuleIdNvSwitch, watched);
+
+    m_portTelemRequests.clear();
+    m_portTelemRequests.resize(m_numNvsdmPorts);
+
+    std::vector<NvsdmTelemSource> sources;
+    for (auto const &watchKey : watched)
     {
-        log_error("Failed to add value to buffer for eg {}, entityId {}, fieldId {} and type {}",
-                  entityGroupId,
-                  entityId,
-                  fieldId,
-                  param.telemValsArray[0].valType);
-        return dcgmReturn;
+        GetTelemSources(
+            (dcgm_field_entity_group_t)watchKey.entityGroupId, watchKey.entityId, watchKey.fieldId, sources);
     }
 
-    return DCGM_ST_OK;
+    for (auto const &source : sources)
+    {
+        FindOrAddTelem(source);
+    }
+
+    log_debug("Rebuilt NVSDM telemetry requests for {} watches", watched.size());
 }
 
 /*************************************************************************/
-dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fieldId,
-                                                               DcgmFvBuffer &buf,
-                                                               const std::vector<dcgm_field_update_info_t> &entities,
-                                                               timelib64_t now)
+dcgmReturn_t DcgmNvsdmManager::ReadPortTelemetry(unsigned int portId)
+{
+    NvsdmPortRead portRead { .portId = portId, .port = m_nvsdmPorts[portId].port, .request = {} };
+    std::swap(portRead.request, m_portTelemRequests[portId]);
+
+    dcgmReturn_t dcgmReturn = ReadPortTelemetry(portRead);
+
+    std::swap(portRead.request, m_portTelemRequests[portId]);
+    return dcgmReturn;
+}
+
+/*************************************************************************/
+dcgmReturn_t DcgmNvsdmManager::ReadPortTelemetry(NvsdmPortRead &portRead)
 {
+    NvsdmPortTelemRequest &request = portRead.request;
+
+    for (auto &telem : request.telemVals)
+    {
+        telem.val.u64Val = 0; /* Reset val before querying. */
+        telem.status     = NVSDM_ERROR_TELEMETRY_READ;
+    }
+
     nvsdmTelemParam_t param;
-    unsigned int nvsdmEntityId;
-    dcgmReturn_t dcgmReturn;
-    nvsdmRet_t nvsdmReturn;
+    param.version         = nvsdmTelemParam_v1;
+    param.numTelemEntries = request.telemVals.size();
+    param.telemValsArray  = request.telemVals.data();
+
+    nvsdmRet_t nvsdmReturn = nvsdmPortGetTelemetryValues(portRead.port, &param);
+    request.readOk         = nvsdmReturn == NVSDM_SUCCESS;
+    if (!request.readOk)
+    {
+        log_error("Failed to get {} telemetry values from nvsdm for port {}, returned {}",
+                  request.telemVals.size(),
+                  portRead.portId,
+                  nvsdmReturn);
+        return DCGM_ST_NVML_ERROR;
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*************************************************************************/
+std::optional<unsigned int> DcgmNvsdmManager::GetSwitchIdOfEntity(dcgm_field_entity_group_t entityGroupId,
+                                                                  dcgm_field_eid_t entityId) const
+{
+    unsigned int nvsdmDeviceId;
+
+    if (entityGroupId == DCGM_FE_SWITCH)
+    {
+        nvsdmDeviceId = entityId;
+    }
+    else if (entityGroupId == DCGM_FE_LINK && entityId < m_numNvsdmPorts)
+    {
+        nvsdmDeviceId = m_nvsdmPorts[entityId].nvsdmDeviceId;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    if (nvsdmDeviceId >= m_nvsdmDevices.size())
+    {
+        return std::nullopt;
+    }
+
+    return m_nvsdmDevices[nvsdmDeviceId].id;
+}
+
+/*************************************************************************/
+static dcgmReturn_t CheckTelem(nvsdmTelem_v1_t const &telem, bool readOk)
+{
+    if (!readOk || telem.status != NVSDM_SUCCESS)
+    {
+        log_error("Failed to get telemetry values from nvsdm for telemetry type {}, counter {} and status {}",
+                  telem.telemType,
+                  telem.telemCtr,
+                  telem.status);
+        return DCGM_ST_NVML_ERROR;
+    }
+    return DCGM_ST_OK;
+}
 
-    param.version                     = nvsdmTelemParam_v1;
-    param.numTelemEntries             = 1;
-    nvsdmTelem_v1_t telemValsArray[1] = {};
-    param.telemValsArray              = telemValsArray;
+/*************************************************************************/
+dcgmReturn_t DcgmNvsdmManager::BufferTelemValues(unsigned short fieldId,
+                                                 const std::vector<dcgm_field_update_info_t> &entities,
+                                                 timelib64_t now,
+                                                 DcgmFvBuffer &buf)
+{
+    std::vector<NvsdmTelemSource> sources;
+    dcgmReturn_t dcgmReturn;
 
     for (auto &entity : entities)
     {
@@ -364,16 +462,11 @@ dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fi
                 continue;
             }
 
-            unsigned int nvsdmPortFieldId = getNvsdmPortFieldId(fieldId);
-            if (nvsdmPortFieldId == NVSDM_PORT_TELEM_CTR_NONE)
+            if (getNvsdmPortFieldId(fieldId) == NVSDM_PORT_TELEM_CTR_NONE)
             {
                 log_error("DCGM fieldId {} doesn't map to any of the nvsdm port field ids.", fieldId);
                 return DCGM_ST_UNKNOWN_FIELD;
             }
-
-            param.telemValsArray[0].telemType = NVSDM_TELEM_TYPE_PORT;
-            param.telemValsArray[0].telemCtr  = nvsdmPortFieldId;
-            nvsdmEntityId                     = entity.entityId;
         }
         else if (entity.entityGroupId == DCGM_FE_SWITCH)
         {
@@ -382,6 +475,7 @@ dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fi
                 log_error("entityId [{}] for NvSwitch is not valid.", entity.entityId);
                 return DCGM_ST_BADPARAM;
             }
+
             /*
              * Composite fields refer to the fields where telemetry counter values are aggregated.
              * For fields like NVSWITCH throughput, we would want to loop over each of it's link and aggregate each
@@ -389,14 +483,46 @@ dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fi
              */
             if (isCompositeFieldId(fieldId))
             {
-                /*
-                 * Handle composite fieldId and continue the loop. It takes care of querying nvsdm for field
-                 * values and adding it to buffer, ensuring there's no need for further actions to proceed.
-                 */
-                dcgmReturn = HandleCompositeFieldId(entity.entityGroupId, entity.entityId, fieldId, param, now, buf);
+                sources.clear();
+                GetTelemSources(entity.entityGroupId, entity.entityId, fieldId, sources);
+
+                nvsdmVal_t compositeNvsdmVal;
+                compositeNvsdmVal.u64Val = 0;
+                for (auto const &source : sources)
+                {
+                    nvsdmTelem_v1_t const &telem = FindOrAddTelem(source);
+                    dcgmReturn = CheckTelem(telem, m_portTelemRequests[source.portId].readOk);
+                    if (dcgmReturn != DCGM_ST_OK)
+                    {
+                        return dcgmReturn;
+                    }
+
+                    /* TODO: For stub we are only using u64Val. We will need to handle more val types for live
+                       testing. */
+                    if ((UINT64_MAX - compositeNvsdmVal.u64Val) < telem.val.u64Val)
+                    {
+                        log_error(
+                            "Overflow detected for u64 addition while adding value [{}] to composite value [{}].",
+                            telem.val.u64Val,
+                            compositeNvsdmVal.u64Val);
+                        return DCGM_ST_MAX_LIMIT;
+                    }
+                    compositeNvsdmVal.u64Val += telem.val.u64Val;
+                }
+
+                dcgmReturn = nvsdmAddValToFvBuffer(entity.entityGroupId,
+                                                   entity.entityId,
+                                                   fieldId,
+                                                   compositeNvsdmVal,
+                                                   NVSDM_VAL_TYPE_UINT64,
+                                                   now,
+                                                   buf);
                 if (dcgmReturn != DCGM_ST_OK)
                 {
-                    log_error("Error while handling nvsdm composite field, returned {}.", dcgmReturn);
+                    log_error("Failed to add value to buffer for eg {}, entityId {}, fieldId {}",
+                              entity.entityGroupId,
+                              entity.entityId,
+                              fieldId);
                     return dcgmReturn;
                 }
                 continue;
@@ -412,16 +538,11 @@ dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fi
                 continue;
             }
 
-            unsigned int nvsdmPlatformFieldId = getNvsdmPlatformFieldId(fieldId);
-            if (nvsdmPlatformFieldId == NVSDM_PLATFORM_TELEM_CTR_NONE)
+            if (getNvsdmPlatformFieldId(fieldId) == NVSDM_PLATFORM_TELEM_CTR_NONE)
             {
                 log_error("DCGM fieldId {} doesn't map to any of the nvsdm platform field ids.", fieldId);
                 return DCGM_ST_UNKNOWN_FIELD;
             }
-            param.telemValsArray[0].telemType = NVSDM_TELEM_TYPE_PLATFORM;
-            param.telemValsArray[0].telemCtr  = nvsdmPlatformFieldId;
-            /* TODO(DCGM-4299): Using port 0 from switch for stub testing. Revisit after nvsdm library is live. */
-            nvsdmEntityId = m_nvsdmDevices[entity.entityId].portIds[0];
         }
         else
         {
@@ -429,32 +550,33 @@ dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fi
             return DCGM_ST_BADPARAM;
         }
 
-        nvsdmReturn = nvsdmPortGetTelemetryValues(m_nvsdmPorts[nvsdmEntityId].port, &param);
-        if (nvsdmReturn != NVSDM_SUCCESS || param.telemValsArray[0].status != NVSDM_SUCCESS)
+        sources.clear();
+        GetTelemSources(entity.entityGroupId, entity.entityId, fieldId, sources);
+        if (sources.size() != 1)
         {
-            log_error(
-                "Failed to get telemetry values from nvsdm for telemetry type {}, counter {} and status {}, returned {}",
-                param.telemValsArray[0].telemType,
-                param.telemValsArray[0].telemCtr,
-                param.telemValsArray[0].status,
-                nvsdmReturn);
-            return DCGM_ST_NVML_ERROR;
+            log_error("No telemetry source for eg {}, entityId {}, fieldId {}",
+                      entity.entityGroupId,
+                      entity.entityId,
+                      fieldId);
+            return DCGM_ST_BADPARAM;
         }
 
-        dcgmReturn = nvsdmAddValToFvBuffer(entity.entityGroupId,
-                                           entity.entityId,
-                                           fieldId,
-                                           param.telemValsArray[0].val,
-                                           param.telemValsArray[0].valType,
-                                           now,
-                                           buf);
+        nvsdmTelem_v1_t const &telem = FindOrAddTelem(sources[0]);
+        dcgmReturn = CheckTelem(telem, m_portTelemRequests[sources[0].portId].readOk);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+
+        dcgmReturn
+            = nvsdmAddValToFvBuffer(entity.entityGroupId, entity.entityId, fieldId, telem.val, telem.valType, now, buf);
         if (dcgmReturn != DCGM_ST_OK)
         {
             log_error("Failed to add value to buffer for eg {}, entityId {}, fieldId {} and type {}",
                       entity.entityGroupId,
                       entity.entityId,
                       fieldId,
-                      param.telemValsArray[0].valType);
+                      telem.valType);
             return dcgmReturn;
         }
     }
@@ -462,6 +584,128 @@ dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fi
     return DCGM_ST_OK;
 }
 
+/*************************************************************************/
+dcgmReturn_t DcgmNvsdmManager::UpdateAllFieldsFromNvswitchLibrary(const fieldEntityMapType &fieldEntityMap,
+                                                                  DcgmFvBuffer &buf,
+                                                                  timelib64_t now)
+{
+    /*
+     * Find every port with a due counter first. Counters missing from the request of their port, like ones of
+     * links that were attached after the watch, are added to it so that they are read from now on
+     */
+    std::vector<NvsdmTelemSource> sources;
+    for (const auto &[fieldId, entities] : fieldEntityMap)
+    {
+        for (auto &entity : entities)
+        {
+            GetTelemSources(entity.entityGroupId, entity.entityId, fieldId, sources);
+        }
+    }
+
+    std::vector<bool> portsToRead(m_portTelemRequests.size(), false);
+    for (auto const &source : sources)
+    {
+        FindOrAddTelem(source);
+        portsToRead.resize(m_portTelemRequests.size(), false);
+        portsToRead[source.portId] = true;
+    }
+
+    /*
+     * One library call per port for all of its watched counters, whether they are due or not. The ports of
+     * different switches are read at the same time, on copies of their requests
+     */
+    std::map<unsigned int, std::shared_ptr<std::vector<NvsdmPortRead>>> portReadsBySwitch;
+    for (unsigned int portId = 0; portId < portsToRead.size(); portId++)
+    {
+        if (!portsToRead[portId])
+        {
+            continue;
+        }
+
+        auto switchId = GetSwitchIdOfEntity(DCGM_FE_LINK, portId);
+        if (!switchId.has_value())
+        {
+            log_error("Port {} doesn't belong to any NvSwitch", portId);
+            return DCGM_ST_BADPARAM;
+        }
+
+        auto &portReads = portReadsBySwitch[*switchId];
+        if (portReads == nullptr)
+        {
+            portReads = std::make_shared<std::vector<NvsdmPortRead>>();
+        }
+        portReads->push_back(
+            { .portId = portId, .port = m_nvsdmPorts[portId].port, .request = m_portTelemRequests[portId] });
+    }
+
+    std::vector<NvSwitchRead> reads;
+    for (auto const &[switchId, portReads] : portReadsBySwitch)
+    {
+        auto read = [portReads]() {
+            for (auto &portRead : *portReads)
+            {
+                dcgmReturn_t dcgmReturn = ReadPortTelemetry(portRead);
+                if (dcgmReturn != DCGM_ST_OK)
+                {
+                    return dcgmReturn;
+                }
+            }
+            return DCGM_ST_OK;
+        };
+
+        auto commit = [this, portReads]() {
+            for (auto &portRead : *portReads)
+            {
+                m_portTelemRequests[portRead.portId] = std::move(portRead.request);
+            }
+        };
+
+        reads.push_back({ .switchId = switchId, .read = std::move(read), .commit = std::move(commit) });
+    }
+
+    std::vector<unsigned int> timedOut;
+    dcgmReturn_t dcgmReturn = RunSwitchReads(reads, timedOut);
+    if (dcgmReturn != DCGM_ST_OK)
+    {
+        return dcgmReturn;
+    }
+
+    /* The entities of switches that were not read in time are blanked instead of holding back the others */
+    for (const auto &[fieldId, entities] : fieldEntityMap)
+    {
+        std::vector<dcgm_field_update_info_t> readEntities;
+        std::vector<dcgm_field_update_info_t> blankEntities;
+
+        for (auto const &entity : entities)
+        {
+            auto switchId = GetSwitchIdOfEntity(entity.entityGroupId, entity.entityId);
+            bool const late
+                = switchId.has_value() && std::find(timedOut.begin(), timedOut.end(), *switchId) != timedOut.end();
+
+            (late ? blankEntities : readEntities).push_back(entity);
+        }
+
+        BufferBlankValueForAllEntities(fieldId, buf, blankEntities);
+
+        dcgmReturn = BufferTelemValues(fieldId, readEntities, now, buf);
+        if (dcgmReturn != DCGM_ST_OK)
+        {
+            return dcgmReturn;
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*************************************************************************/
+dcgmReturn_t DcgmNvsdmManager::UpdateFieldsFromNvswitchLibrary(unsigned short fieldId,
+                                                               DcgmFvBuffer &buf,
+                                                               const std::vector<dcgm_field_update_info_t> &entities,
+                                                               timelib64_t now)
+{
+    return UpdateAllFieldsFromNvswitchLibrary({ { fieldId, entities } }, buf, now);
+}
+
 /*************************************************************************/
 dcgmReturn_t DcgmNvsdmManager::Init()
 {
@@ -520,6 +764,7 @@ dcgmReturn_t DcgmNvsdmManager::DetachFromNvsdm()
         log_warning("Not attached to NVSDM");
         return DCGM_ST_UNINITIALIZED;
     }
+    WaitForSwitchReads();
     nvsdmFinalize();
     m_attachedToNvsdm = false;
     return DCGM_ST_OK;
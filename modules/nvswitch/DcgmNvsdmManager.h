@@ -16,6 +16,8 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <vector>
 
 #include <DcgmCoreProxy.h>
 #include <DcgmNvSwitchManagerBase.h>
@@ -38,6 +40,30 @@ struct NvsdmPort
     uint8_t gid[16];
 };
 
+/* Every watched telemetry counter that is read from one port, so that they all take one
+   nvsdmPortGetTelemetryValues() call */
+struct NvsdmPortTelemRequest
+{
+    std::vector<nvsdmTelem_v1_t> telemVals; // telemType and telemCtr are set. The rest is filled by each read
+    bool readOk = false;                    // Did the last read of telemVals succeed?
+};
+
+/* A copy of the request of one port, so that it can be read on a switch read worker */
+struct NvsdmPortRead
+{
+    unsigned int portId;
+    nvsdmPort_t port;
+    NvsdmPortTelemRequest request;
+};
+
+/* Where a field value of an entity is read from */
+struct NvsdmTelemSource
+{
+    unsigned int portId;
+    uint8_t telemType;
+    uint16_t telemCtr;
+};
+
 struct NvsdmDevice
 {
     unsigned int id;
@@ -100,6 +126,16 @@ public:
                                                  const std::vector<dcgm_field_update_info_t> &entities,
                                                  timelib64_t now) override;
 
+    /*************************************************************************/
+    /**
+     * Update every due field, reading all the due counters of a port with one nvsdmPortGetTelemetryValues() call
+     *
+     * @sa DcgmNvSwitchManagerBase::UpdateAllFieldsFromNvswitchLibrary()
+     */
+    dcgmReturn_t UpdateAllFieldsFromNvswitchLibrary(const fieldEntityMapType &fieldEntityMap,
+                                                    DcgmFvBuffer &buf,
+                                                    timelib64_t now) override;
+
     /*************************************************************************/
     /**
      * Initialize Switch Manager
@@ -157,6 +193,7 @@ protected:
     DcgmNvSwitchError m_fatalErrors[DCGM_MAX_NUM_SWITCHES]; // Fatal errors. Max 1 per switch
     bool m_paused                = false;                   // Is the Switch Manager paused?
     unsigned int m_numNvsdmPorts = 0;                       // Number of entries in m_nvsdmPorts that are valid
+    std::vector<NvsdmPortTelemRequest> m_portTelemRequests; // Watched counters of each port. Indexed by port id
 
     /*************************************************************************/
     /**
@@ -172,14 +209,61 @@ protected:
 
     /*************************************************************************/
     /**
-     * Handles composite fieldIds to aggregate telemetry values.
+     * Get the ports and counters that a field value of an entity is read from. Composite fields are read from
+     * every port of the switch whose link is up. Nothing is added for invalid entities or fields that are not
+     * read from telemetry counters
+     */
+    void GetTelemSources(dcgm_field_entity_group_t entityGroupId,
+                         dcgm_field_eid_t entityId,
+                         unsigned short fieldId,
+                         std::vector<NvsdmTelemSource> &sources);
+
+    /*************************************************************************/
+    /**
+     * Find the entry of a counter in the request of its port, adding it if needed
+     */
+    nvsdmTelem_v1_t &FindOrAddTelem(NvsdmTelemSource const &source);
+
+    /*************************************************************************/
+    /**
+     * Read all the counters of m_portTelemRequests[portId] with one library call
+     *
+     * Returns DCGM_ST_OK on success.
+     *         DCGM_ST_NVML_ERROR if the library call failed
+     */
+    dcgmReturn_t ReadPortTelemetry(unsigned int portId);
+
+    /*************************************************************************/
+    /**
+     * Read all the counters of portRead.request with one library call. Doesn't touch the manager, so it can run
+     * on a switch read worker
+     *
+     * Returns DCGM_ST_OK on success.
+     *         DCGM_ST_NVML_ERROR if the library call failed
+     */
+    static dcgmReturn_t ReadPortTelemetry(NvsdmPortRead &portRead);
+
+    /*************************************************************************/
+    /**
+     * Returns the id of the switch an entity belongs to, or std::nullopt for an invalid entity
+     */
+    std::optional<unsigned int> GetSwitchIdOfEntity(dcgm_field_entity_group_t entityGroupId,
+                                                    dcgm_field_eid_t entityId) const;
+
+    /*************************************************************************/
+    /**
+     * Add the values of fieldId for entities to buf from what ReadPortTelemetry() read
+     */
+    dcgmReturn_t BufferTelemValues(unsigned short fieldId,
+                                   const std::vector<dcgm_field_update_info_t> &entities,
+                                   timelib64_t now,
+                                   DcgmFvBuffer &buf);
+
+    /*************************************************************************/
+    /**
+     * Rebuild m_portTelemRequests from the watched fields
      */
-    dcgmReturn_t HandleCompositeFieldId(const dcgm_field_entity_group_t entityGroupId,
-                                        const unsigned int entityId,
-                                        unsigned short fieldId,
-                                        nvsdmTelemParam_t &param,
-                                        timelib64_t now,
-                                        DcgmFvBuffer &buf);
+    void OnWatchesChanged() override;
 
     /*************************************************************************/
     /**
@@ -16,6 +16,10 @@
 
 #include "FieldDefinitions.h"
 
+#include <any>
+#include <optional>
+#include <type_traits>
+
 #include <dcgm_fields.h>
 
 #include "FieldIds.h"
@@ -133,48 +137,79 @@ dcgmReturn_t DcgmNscqManager::UpdateFields(unsigned short fieldId,
         return DCGM_ST_BADPARAM;
     }
 
-    NscqDataCollector<TempData<nscqFieldType, storageType, is_vector, indexTypes...>> collector(fieldId, nscqPath);
+    /**
+     * The raw NSCQ values are collected rather than storageType so that every
+     * field sharing the path can pick its own member out of the same
+     * observation. An empty optional marks an index NSCQ returned an error for.
+     */
+    using rawValue_t     = std::optional<std::remove_cv_t<nscqFieldType>>;
+    using rawData_t      = TempData<nscqFieldType, rawValue_t, is_vector, indexTypes...>;
+    using rawCollector_t = NscqDataCollector<rawData_t>;
 
-    auto cb = [](const indexTypes... indicies,
-                 nscq_rc_t rc,
-                 TempData<nscqFieldType, storageType, is_vector, indexTypes...>::cbType in,
-                 NscqDataCollector<TempData<nscqFieldType, storageType, is_vector, indexTypes...>> *dest) {
-        if (dest == nullptr)
-        {
-            log_error("NSCQ passed dest = nullptr");
+    const rawCollector_t *collector = nullptr;
 
-            return;
+    if (m_cycleObservations.has_value())
+    {
+        auto cached = m_cycleObservations->find(nscqPath);
+
+        if (cached != m_cycleObservations->end())
+        {
+            collector = std::any_cast<rawCollector_t>(&cached->second);
         }
+    }
 
-        dest->callCounter++;
+    rawCollector_t observed(fieldId, nscqPath);
 
-        if (NSCQ_ERROR(rc))
-        {
-            log_error("NSCQ {} passed error {}", dest->nscqPath, (int)rc);
+    if (collector == nullptr)
+    {
+        auto cb = [](const indexTypes... indicies,
+                     nscq_rc_t rc,
+                     typename rawData_t::cbType in,
+                     rawCollector_t *dest) {
+            if (dest == nullptr)
+            {
+                log_error("NSCQ passed dest = nullptr");
 
-            TempData<nscqFieldType, storageType, is_vector, indexTypes...> item;
+                return;
+            }
 
-            item.CollectFunc(dest, indicies...);
+            dest->callCounter++;
 
-            return;
-        }
+            rawData_t item;
 
-        TempData<nscqFieldType, storageType, is_vector, indexTypes...> item;
+            if (NSCQ_ERROR(rc))
+            {
+                log_error("NSCQ {} passed error {}", dest->nscqPath, (int)rc);
 
-        item.CollectFunc(dest, in, indicies...);
-    };
+                item.CollectFunc(dest, indicies...);
 
-    nscq_rc_t ret = nscq_session_path_observe(m_nscqSession, nscqPath, NSCQ_FN(*cb), &collector, 0);
+                return;
+            }
 
-    log_debug("Callback called {} times for fieldId {}", collector.callCounter, fieldId);
+            item.CollectFunc(dest, in, indicies...);
+        };
 
-    if (NSCQ_ERROR(ret))
-    {
-        log_error("Could not read fieldId {}, fatal errors. NSCQ ret: {}", fieldId, ret);
+        nscq_rc_t ret = ObservePath(nscqPath, NSCQ_FN(*cb), &observed);
 
-        return DCGM_ST_3RD_PARTY_LIBRARY_ERROR;
+        log_debug("Callback called {} times for fieldId {}", observed.callCounter, fieldId);
+
+        if (NSCQ_ERROR(ret))
+        {
+            log_error("Could not read fieldId {}, fatal errors. NSCQ ret: {}", fieldId, ret);
+
+            return DCGM_ST_3RD_PARTY_LIBRARY_ERROR;
+        }
+
+        collector = &observed;
+
+        if (m_cycleObservations.has_value())
+        {
+            auto [it, inserted] = m_cycleObservations->insert_or_assign(nscqPath, std::move(observed));
+            collector           = std::any_cast<rawCollector_t>(&it->second);
+        }
     }
-    else if (collector.callCounter == 0)
+
+    if (collector->callCounter == 0)
     {
         /**
          * We got called 0 times with no error. Assume there was an error and
@@ -185,16 +220,18 @@ dcgmReturn_t DcgmNscqManager::UpdateFields(unsigned short fieldId,
         return DCGM_ST_OK;
     }
 
-    for (const auto &data : collector.data)
+    for (const auto &data : collector->data)
     {
         auto entity = Find<indexTypes...>(fieldId, entities, data.index);
 
         if (entity.has_value())
         {
-            data.data.BufferAdd(entity->entityGroupId, entity->entityId, fieldId, now, buf);
+            storageType value = data.data.has_value() ? storageType(*data.data) : storageType();
+
+            value.BufferAdd(entity->entityGroupId, entity->entityId, fieldId, now, buf);
             log_debug("Retrieved fieldId {} value {} eg {} eid {}",
                       fieldId,
-                      data.data.Str(),
+                      value.Str(),
                       entity->entityGroupId,
                       entity->entityId);
         }
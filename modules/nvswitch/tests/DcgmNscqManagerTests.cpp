@@ -183,6 +183,50 @@ SCENARIO("Setting and unsetting watches")
     }
 }
 
+TEST_CASE("Watched fields are grouped by NSCQ path")
+{
+    dcgmCoreCallbacks_t dcc = {};
+    DcgmNscqManager nsm(&dcc);
+    DcgmWatcher watcher;
+    unsigned int fakeCount = 1;
+    unsigned int fakeSwitchIds[1];
+
+    REQUIRE(nsm.CreateFakeSwitches(fakeCount, fakeSwitchIds) == DCGM_ST_OK);
+
+    unsigned short fieldIds[] = { DCGM_FI_DEV_NVSWITCH_LINK_CRC_ERRORS_LANE0,
+                                  DCGM_FI_DEV_NVSWITCH_LINK_CRC_ERRORS_LANE1,
+                                  DCGM_FI_DEV_NVSWITCH_LINK_CRC_ERRORS_LANE2,
+                                  DCGM_FI_DEV_NVSWITCH_LINK_CRC_ERRORS_LANE3,
+                                  DCGM_FI_DEV_NVSWITCH_TEMPERATURE_CURRENT };
+
+    REQUIRE(nsm.WatchField(DCGM_FE_SWITCH,
+                           fakeSwitchIds[0],
+                           5,
+                           fieldIds,
+                           1000,
+                           watcher.watcherType,
+                           watcher.connectionId,
+                           true)
+            == DCGM_ST_OK);
+
+    auto const &paths = nsm.GetWatchedPaths();
+    REQUIRE(paths.size() == 2);
+
+    auto lanes = paths.find(nscq_nvswitch_port_lane_crc_err_count);
+    REQUIRE(lanes != paths.end());
+    CHECK(lanes->second.size() == 4);
+
+    auto temperature = paths.find(nscq_nvswitch_temperature_current);
+    REQUIRE(temperature != paths.end());
+    CHECK(temperature->second == std::vector<unsigned short> { DCGM_FI_DEV_NVSWITCH_TEMPERATURE_CURRENT });
+
+    /* Nothing was observed yet */
+    CHECK(nsm.GetPathStats().empty());
+
+    REQUIRE(nsm.UnwatchField(watcher.watcherType, watcher.connectionId) == DCGM_ST_OK);
+    CHECK(nsm.GetWatchedPaths().empty());
+}
+
 SCENARIO("Validating Fully Specialized entity matching methods")
 {
     GIVEN("matching uuid_p")
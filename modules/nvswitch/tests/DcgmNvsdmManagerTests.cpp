@@ -13,9 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
 #include <catch2/catch_all.hpp>
+#include <chrono>
 #include <cstdlib>
 #include <fmt/core.h>
+#include <future>
+#include <set>
 
 #define DCGM_NVSWITCH_TEST
 #include <DcgmNvSwitchManagerBase.h>
@@ -359,3 +363,120 @@ SCENARIO("Setting and unsetting watches for Nvsdm")
         }
     }
 }
+
+TEST_CASE("Nvsdm telemetry requests are built per port when watches change")
+{
+    dcgmCoreCallbacks_t dcc = {};
+    DcgmNvsdmManager nsm(&dcc);
+    REQUIRE(initNvsdmManager(nsm) == DCGM_ST_OK);
+    REQUIRE(nsm.m_numNvsdmPorts > 1);
+
+    DcgmWatcher watcher;
+    unsigned short fieldIds[] = { DCGM_FI_DEV_NVSWITCH_LINK_THROUGHPUT_TX,
+                                  DCGM_FI_DEV_NVSWITCH_LINK_THROUGHPUT_RX,
+                                  DCGM_FI_DEV_NVSWITCH_DEVICE_UUID };
+
+    dcgmReturn_t retSt
+        = nsm.WatchField(DCGM_FE_LINK, 0, 3, fieldIds, 1000, watcher.watcherType, watcher.connectionId, true);
+    REQUIRE(retSt == DCGM_ST_OK);
+
+    /* Both counters of link 0 are read with one call. The UUID is cached and isn't read */
+    REQUIRE(nsm.m_portTelemRequests.size() == nsm.m_numNvsdmPorts);
+    REQUIRE(nsm.m_portTelemRequests[0].telemVals.size() == 2);
+    CHECK(nsm.m_portTelemRequests[0].telemVals[0].telemType == NVSDM_TELEM_TYPE_PORT);
+    CHECK(nsm.m_portTelemRequests[1].telemVals.empty());
+
+    REQUIRE(nsm.ReadPortTelemetry(0) == DCGM_ST_OK);
+    CHECK(nsm.m_portTelemRequests[0].readOk);
+    for (auto const &telem : nsm.m_portTelemRequests[0].telemVals)
+    {
+        CHECK(telem.status == NVSDM_SUCCESS);
+    }
+
+    REQUIRE(nsm.UnwatchField(watcher.watcherType, watcher.connectionId) == DCGM_ST_OK);
+    CHECK(nsm.m_portTelemRequests[0].telemVals.empty());
+}
+
+TEST_CASE("NvSwitch reads that overrun the timeout don't hold back the others")
+{
+    dcgmCoreCallbacks_t dcc = {};
+    DcgmNvsdmManager nsm(&dcc);
+    nsm.m_switchReadTimeout = std::chrono::milliseconds(50);
+
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::atomic_int slowReads     = 0;
+    bool slowCommitted            = false;
+    bool fastCommitted            = false;
+
+    std::vector<NvSwitchRead> reads;
+    reads.push_back({ .switchId = 0,
+                      .read =
+                          [&slowReads, gate]() {
+                              slowReads++;
+                              gate.wait();
+                              return DCGM_ST_OK;
+                          },
+                      .commit = [&slowCommitted]() { slowCommitted = true; } });
+    reads.push_back(
+        { .switchId = 1, .read = []() { return DCGM_ST_OK; }, .commit = [&fastCommitted]() { fastCommitted = true; } });
+
+    std::vector<unsigned int> timedOut;
+    REQUIRE(nsm.RunSwitchReads(reads, timedOut) == DCGM_ST_OK);
+    CHECK(timedOut == std::vector<unsigned int> { 0 });
+    CHECK(fastCommitted);
+    CHECK_FALSE(slowCommitted);
+    CHECK(nsm.GetSwitchReadStats().at(0).timeouts == 1);
+    CHECK(nsm.GetSwitchReadStats().at(1).reads == 1);
+
+    /* Switch 0 is still busy, so it isn't read again */
+    timedOut.clear();
+    REQUIRE(nsm.RunSwitchReads(reads, timedOut) == DCGM_ST_OK);
+    CHECK(timedOut == std::vector<unsigned int> { 0 });
+    CHECK(slowReads == 1);
+    CHECK(nsm.GetSwitchReadStats().at(0).timeouts == 2);
+    CHECK(nsm.GetSwitchReadStats().at(1).reads == 2);
+
+    release.set_value();
+    nsm.WaitForSwitchReads();
+    CHECK(nsm.GetSwitchReadStats().at(0).reads == 1);
+    CHECK_FALSE(slowCommitted);
+}
+
+TEST_CASE("Nvsdm ports of every switch are read in one update")
+{
+    dcgmCoreCallbacks_t dcc = {};
+    DcgmNvsdmManager nsm(&dcc);
+    REQUIRE(initNvsdmManager(nsm) == DCGM_ST_OK);
+    REQUIRE(nsm.m_numNvsdmPorts > 1);
+
+    fieldEntityMapType fieldEntityMap;
+    std::set<unsigned int> switchIds;
+    for (unsigned int portId = 0; portId < nsm.m_numNvsdmPorts; portId++)
+    {
+        dcgm_field_update_info_t entity {};
+        entity.entityGroupId = DCGM_FE_LINK;
+        entity.entityId      = portId;
+        fieldEntityMap[DCGM_FI_DEV_NVSWITCH_LINK_THROUGHPUT_TX].push_back(entity);
+
+        auto switchId = nsm.GetSwitchIdOfEntity(DCGM_FE_LINK, portId);
+        REQUIRE(switchId.has_value());
+        switchIds.insert(*switchId);
+    }
+
+    DcgmFvBuffer buf;
+    REQUIRE(nsm.UpdateAllFieldsFromNvswitchLibrary(fieldEntityMap, buf, 0) == DCGM_ST_OK);
+
+    size_t size  = 0;
+    size_t count = 0;
+    REQUIRE(buf.GetSize(&size, &count) == DCGM_ST_OK);
+    CHECK(count == nsm.m_numNvsdmPorts);
+
+    REQUIRE(nsm.GetSwitchReadStats().size() == switchIds.size());
+    for (auto const &[switchId, stats] : nsm.GetSwitchReadStats())
+    {
+        CHECK(switchIds.contains(switchId));
+        CHECK(stats.reads == 1);
+        CHECK(stats.timeouts == 0);
+    }
+}
@@ -16,6 +16,7 @@
 #include "DcgmModulePolicy.h"
 #include "DcgmLogging.h"
 #include "dcgm_structs.h"
+#include <DcgmCommandTable.hpp>
 #include <dcgm_api_export.h>
 
 /*****************************************************************************/
@@ -34,48 +35,35 @@ DcgmModulePolicy::~DcgmModulePolicy()
 /*****************************************************************************/
 dcgmReturn_t DcgmModulePolicy::ProcessGetPolicies(dcgm_policy_msg_get_policies_t *msg)
 {
-    dcgmReturn_t dcgmReturn;
-
-    dcgmReturn = CheckVersion(&msg->header, dcgm_policy_msg_get_policies_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     return mpPolicyManager->ProcessGetPolicies(msg);
 }
 
 /*****************************************************************************/
 dcgmReturn_t DcgmModulePolicy::ProcessSetPolicy(dcgm_policy_msg_set_policy_t *msg)
 {
-    dcgmReturn_t dcgmReturn;
-
-    dcgmReturn = CheckVersion(&msg->header, dcgm_policy_msg_set_policy_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     return mpPolicyManager->ProcessSetPolicy(msg);
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmModulePolicy::ProcessRegister(dcgm_policy_msg_register_t *msg)
+dcgmReturn_t DcgmModulePolicy::ProcessRegisterV1(dcgm_policy_msg_register_v1 *msg)
 {
-    dcgmReturn_t dcgmReturn;
-
-    dcgmReturn = CheckVersion(&msg->header, dcgm_policy_msg_register_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
+    /* A v1 registration is a v2 one without a coalescing window */
+    dcgm_policy_msg_register_t msgV2 = {};
+    msgV2.header                     = msg->header;
+    msgV2.groupId                    = msg->groupId;
+    msgV2.condition                  = msg->condition;
+    return mpPolicyManager->RegisterForPolicy(&msgV2);
+}
 
+/*****************************************************************************/
+dcgmReturn_t DcgmModulePolicy::ProcessRegister(dcgm_policy_msg_register_t *msg)
+{
     return mpPolicyManager->RegisterForPolicy(msg);
 }
 
 /*****************************************************************************/
 dcgmReturn_t DcgmModulePolicy::ProcessUnregister(dcgm_policy_msg_unregister_t *msg)
 {
-    dcgmReturn_t dcgmReturn;
-
-    dcgmReturn = CheckVersion(&msg->header, dcgm_policy_msg_unregister_version);
-    if (DCGM_ST_OK != dcgmReturn)
-        return dcgmReturn; /* Logging handled by helper method */
-
     return mpPolicyManager->UnregisterForPolicy(msg);
 }
 
@@ -141,40 +129,23 @@ dcgmReturn_t DcgmModulePolicy::ProcessCoreMessage(dcgm_module_command_header_t *
 /*****************************************************************************/
 dcgmReturn_t DcgmModulePolicy::ProcessMessage(dcgm_module_command_header_t *moduleCommand)
 {
-    dcgmReturn_t retSt = DCGM_ST_OK;
+    using DcgmNs::Handle;
+
+    static constexpr auto c_commands = DcgmNs::MakeCommandTable<DcgmModulePolicy>({
+        Handle<&DcgmModulePolicy::ProcessGetPolicies>(DCGM_POLICY_SR_GET_POLICIES,
+                                                      dcgm_policy_msg_get_policies_version),
+        Handle<&DcgmModulePolicy::ProcessSetPolicy>(DCGM_POLICY_SR_SET_POLICY, dcgm_policy_msg_set_policy_version),
+        Handle<&DcgmModulePolicy::ProcessRegisterV1>(DCGM_POLICY_SR_REGISTER, dcgm_policy_msg_register_version1),
+        Handle<&DcgmModulePolicy::ProcessRegister>(DCGM_POLICY_SR_REGISTER, dcgm_policy_msg_register_version),
+        Handle<&DcgmModulePolicy::ProcessUnregister>(DCGM_POLICY_SR_UNREGISTER, dcgm_policy_msg_unregister_version),
+    });
 
     if (moduleCommand->moduleId == DcgmModuleIdCore)
     {
-        retSt = ProcessCoreMessage(moduleCommand);
-    }
-    else
-    {
-        switch (moduleCommand->subCommand)
-        {
-            case DCGM_POLICY_SR_GET_POLICIES:
-                retSt = ProcessGetPolicies((dcgm_policy_msg_get_policies_t *)moduleCommand);
-                break;
-
-            case DCGM_POLICY_SR_SET_POLICY:
-                retSt = ProcessSetPolicy((dcgm_policy_msg_set_policy_t *)moduleCommand);
-                break;
-
-            case DCGM_POLICY_SR_REGISTER:
-                retSt = ProcessRegister((dcgm_policy_msg_register_t *)moduleCommand);
-                break;
-
-            case DCGM_POLICY_SR_UNREGISTER:
-                retSt = ProcessUnregister((dcgm_policy_msg_unregister_t *)moduleCommand);
-                break;
-
-            default:
-                DCGM_LOG_DEBUG << "Unknown subcommand: " << static_cast<int>(moduleCommand->subCommand);
-                return DCGM_ST_FUNCTION_NOT_FOUND;
-                break;
-        }
+        return ProcessCoreMessage(moduleCommand);
     }
 
-    return retSt;
+    return c_commands.Dispatch(*this, moduleCommand);
 }
 
 extern "C" {
@@ -50,6 +50,7 @@ private:
      */
     dcgmReturn_t ProcessGetPolicies(dcgm_policy_msg_get_policies_t *msg);
     dcgmReturn_t ProcessSetPolicy(dcgm_policy_msg_set_policy_t *msg);
+    dcgmReturn_t ProcessRegisterV1(dcgm_policy_msg_register_v1 *msg);
     dcgmReturn_t ProcessRegister(dcgm_policy_msg_register_t *msg);
     dcgmReturn_t ProcessUnregister(dcgm_policy_msg_unregister_t *msg);
     dcgmReturn_t ProcessCoreMessage(dcgm_module_command_header_t *moduleCommand);
@@ -17,6 +17,9 @@
 #include "DcgmLogging.h"
 #include "dcgm_structs.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -38,6 +41,12 @@ DcgmPolicyManager::DcgmPolicyManager(dcgmCoreCallbacks_t &dcc)
  *****************************************************************************/
 DcgmPolicyManager::~DcgmPolicyManager()
 {
+    if (m_batchThread.joinable())
+    {
+        m_batchThread.request_stop();
+        m_batchThread.join();
+    }
+
     delete (m_mutex);
     m_mutex = 0;
 }
@@ -66,80 +75,144 @@ dcgmReturn_t DcgmPolicyManager::Init(void)
     }
     m_numGpus = deviceCount;
 
+    PublishRuleTable();
+
     dcgm_mutex_unlock(m_mutex);
 
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+DcgmViolationPolicyAlert_t DcgmPolicyManager::GetAlertTypeOfField(unsigned short fieldId)
+{
+    static std::array<unsigned char, DCGM_FI_MAX_FIELDS> const alertTypes = [] {
+        std::array<unsigned char, DCGM_FI_MAX_FIELDS> table {};
+        table.fill(DCGM_VIOLATION_POLICY_FAIL_COUNT);
+
+        table[DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_TOTAL] = DCGM_VIOLATION_POLICY_FAIL_NVLINK;
+        table[DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_TOTAL] = DCGM_VIOLATION_POLICY_FAIL_NVLINK;
+        table[DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_TOTAL]   = DCGM_VIOLATION_POLICY_FAIL_NVLINK;
+        table[DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_TOTAL] = DCGM_VIOLATION_POLICY_FAIL_NVLINK;
+        table[DCGM_FI_DEV_ECC_DBE_VOL_DEV]                   = DCGM_VIOLATION_POLICY_FAIL_ECC_DBE;
+        table[DCGM_FI_DEV_RETIRED_SBE]                       = DCGM_VIOLATION_POLICY_FAIL_MAX_RETIRED_PAGES;
+        table[DCGM_FI_DEV_RETIRED_DBE]                       = DCGM_VIOLATION_POLICY_FAIL_MAX_RETIRED_PAGES;
+        table[DCGM_FI_DEV_GPU_TEMP]                          = DCGM_VIOLATION_POLICY_FAIL_THERMAL;
+        table[DCGM_FI_DEV_XID_ERRORS]                        = DCGM_VIOLATION_POLICY_FAIL_XID;
+        table[DCGM_FI_DEV_POWER_USAGE]                       = DCGM_VIOLATION_POLICY_FAIL_POWER;
+        table[DCGM_FI_DEV_PCIE_REPLAY_COUNTER]               = DCGM_VIOLATION_POLICY_FAIL_PCIE;
+        return table;
+    }();
+
+    if (fieldId >= DCGM_FI_MAX_FIELDS)
+    {
+        return DCGM_VIOLATION_POLICY_FAIL_COUNT;
+    }
+
+    return (DcgmViolationPolicyAlert_t)alertTypes[fieldId];
+}
+
+/*****************************************************************************/
+void DcgmPolicyManager::PublishRuleTable()
+{
+    auto table = std::make_shared<dpm_rule_table_t>();
+
+    for (unsigned int gpuId = 0; gpuId < DCGM_MAX_NUM_DEVICES; gpuId++)
+    {
+        dpm_gpu_rules_t &rules = table->gpus[gpuId];
+        dpm_gpu_t const &gpu   = m_gpus[gpuId];
+
+        rules.conditionMask = gpu.policiesHaveBeenSet ? gpu.currentPolicies.condition : 0;
+        for (unsigned int i = 0; i < DCGM_VIOLATION_POLICY_FAIL_COUNT; i++)
+        {
+            rules.thresholds[i] = gpu.currentPolicies.parms[i].val.llval;
+        }
+    }
+
+    m_ruleTable.store(std::move(table));
+}
+
 /*****************************************************************************/
 void DcgmPolicyManager::OnFieldValuesUpdate(DcgmFvBuffer *fvBuffer)
 {
     dcgmBufferedFv_t *fv;
     dcgmBufferedFvCursor_t cursor = 0;
 
-    /* This is a bit coarse-grained for now, but it's clean */
-    dcgmMutexReturn_t mutexSt = dcgm_mutex_lock(m_mutex);
+    /* Evaluate against a snapshot so that the cache manager thread doesn't wait on m_mutex. m_mutex is only
+       taken by SetViolation() once a value has violated a policy */
+    std::shared_ptr<dpm_rule_table_t const> table = m_ruleTable.load();
+    if (!table)
+    {
+        return;
+    }
 
     for (fv = fvBuffer->GetNextFv(&cursor); fv; fv = fvBuffer->GetNextFv(&cursor))
     {
         /* Policy only pertains to GPUs for now */
-        if (fv->entityGroupId != DCGM_FE_GPU)
+        if (fv->entityGroupId != DCGM_FE_GPU || fv->entityId >= DCGM_MAX_NUM_DEVICES)
+        {
+            log_debug("Ignored eg {} eid {}", fv->entityGroupId, fv->entityId);
+            continue;
+        }
+
+        DcgmViolationPolicyAlert_t alertType = GetAlertTypeOfField(fv->fieldId);
+        if (alertType == DCGM_VIOLATION_POLICY_FAIL_COUNT)
+        {
+            /* This is partially expected since the cache manager will broadcast
+               any FVs that updated during the same loop as FVs we care about */
+            log_debug("Ignoring unhandled field {}", fv->fieldId);
+            continue;
+        }
+
+        dpm_gpu_rules_t const &rules = table->gpus[fv->entityId];
+
+        /* DCGM_VIOLATION_POLICY_FAIL_* are the bit indexes of DCGM_POLICY_COND_* */
+        if (!(rules.conditionMask & (1U << alertType)))
         {
-            log_debug("Ignored non-GPU eg {}", fv->entityGroupId);
             continue;
         }
 
-        /* Does this GPU have an active policy? */
-        if (!m_gpus[fv->entityId].policiesHaveBeenSet)
+        bool isBlank = (fv->fieldType == DCGM_FT_DOUBLE) ? DCGM_FP64_IS_BLANK(fv->value.dbl)
+                                                         : DCGM_INT64_IS_BLANK(fv->value.i64);
+        if (fv->status != DCGM_ST_OK || isBlank)
         {
-            log_debug("Ignored gpuId {} without policies set", fv->entityId);
+            log_debug("Skipping gpuId {} fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
             continue;
         }
 
-        switch (fv->fieldId)
+        switch (alertType)
         {
-            case DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_COUNT_TOTAL:
-            case DCGM_FI_DEV_NVLINK_CRC_DATA_ERROR_COUNT_TOTAL:
-            case DCGM_FI_DEV_NVLINK_REPLAY_ERROR_COUNT_TOTAL:
-            case DCGM_FI_DEV_NVLINK_RECOVERY_ERROR_COUNT_TOTAL:
+            case DCGM_VIOLATION_POLICY_FAIL_NVLINK:
                 CheckNVLinkErrors(fv);
                 break;
 
-            case DCGM_FI_DEV_ECC_DBE_VOL_DEV:
+            case DCGM_VIOLATION_POLICY_FAIL_ECC_DBE:
                 CheckEccErrors(fv);
                 break;
 
-            case DCGM_FI_DEV_RETIRED_SBE:
-            case DCGM_FI_DEV_RETIRED_DBE:
-                CheckRetiredPages(fv);
+            case DCGM_VIOLATION_POLICY_FAIL_MAX_RETIRED_PAGES:
+                CheckRetiredPages(fv, rules);
                 break;
 
-            case DCGM_FI_DEV_GPU_TEMP:
-                CheckThermalValues(fv);
+            case DCGM_VIOLATION_POLICY_FAIL_THERMAL:
+                CheckThermalValues(fv, rules);
                 break;
 
-            case DCGM_FI_DEV_XID_ERRORS:
+            case DCGM_VIOLATION_POLICY_FAIL_XID:
                 CheckXIDErrors(fv);
                 break;
 
-            case DCGM_FI_DEV_POWER_USAGE:
-                CheckPowerValues(fv);
+            case DCGM_VIOLATION_POLICY_FAIL_POWER:
+                CheckPowerValues(fv, rules);
                 break;
 
-            case DCGM_FI_DEV_PCIE_REPLAY_COUNTER:
+            case DCGM_VIOLATION_POLICY_FAIL_PCIE:
                 CheckPcieErrors(fv);
                 break;
 
             default:
-                /* This is partially expected since the cache manager will broadcast
-                   any FVs that updated during the same loop as FVs we care about */
-                log_debug("Ignoring unhandled field {}", fv->fieldId);
                 break;
         }
     }
-
-    if (mutexSt != DCGM_MUTEX_ST_LOCKEDBYME)
-        dcgm_mutex_unlock(m_mutex);
 }
 
 /****************************************************************************/
@@ -158,6 +231,9 @@ void DcgmPolicyManager::SetViolation(DcgmViolationPolicyAlert_t alertType,
                                                 can bypass this with injection since we use the fv timestamp
                                                 and not the system time */
     std::vector<dpm_watcher_t>::iterator watcherIt;
+    std::vector<dpm_outgoing_batch_t> outgoing; /* Batches that filled up */
+
+    DcgmLockGuard dlg(m_mutex);
 
     /* Walk the callbacks for this gpuId and trigger any that match our mask */
     for (watcherIt = m_gpus[gpuId].watchers.begin(); watcherIt != m_gpus[gpuId].watchers.end(); ++watcherIt)
@@ -181,12 +257,178 @@ void DcgmPolicyManager::SetViolation(DcgmViolationPolicyAlert_t alertType,
                   watcherIt->requestId,
                   (long long)timestamp);
 
-        mpCoreProxy.SendRawMessageToClient(
-            watcherIt->connectionId, DCGM_MSG_POLICY_NOTIFY, watcherIt->requestId, &notify, sizeof(notify), DCGM_ST_OK);
+        if (watcherIt->batched)
+        {
+            if (!QueueBatchedViolation(*watcherIt, alertType, *response, outgoing))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            mpCoreProxy.SendRawMessageToClient(watcherIt->connectionId,
+                                               DCGM_MSG_POLICY_NOTIFY,
+                                               watcherIt->requestId,
+                                               &notify,
+                                               sizeof(notify),
+                                               DCGM_ST_OK);
+        }
 
         /* Set the last seen time so we don't spam this watcher */
         watcherIt->lastSentTimestamp[alertType] = timestamp;
     }
+
+    SendBatches(outgoing);
+}
+
+/****************************************************************************/
+bool DcgmPolicyManager::QueueBatchedViolation(dpm_watcher_t const &watcher,
+                                              DcgmViolationPolicyAlert_t alertType,
+                                              dcgmPolicyCallbackResponse_t const &response,
+                                              std::vector<dpm_outgoing_batch_t> &outgoing)
+{
+    std::lock_guard<std::mutex> lg(m_batchMutex);
+
+    auto batchIt = m_batches.find({ watcher.connectionId, watcher.requestId });
+    if (batchIt == m_batches.end())
+    {
+        return false;
+    }
+
+    dpm_batch_t &batch    = batchIt->second;
+    timelib64_t const now = timelib_usecSince1970();
+    bool queued           = false;
+
+    /* The rate limit is on the system time, so that it holds however far apart the field values are */
+    if (now - batch.rateWindowUsec[alertType] >= 1000000)
+    {
+        batch.rateWindowUsec[alertType]  = now;
+        batch.numInRateWindow[alertType] = 0;
+    }
+
+    if (batch.maxPerConditionPerSec != 0 && batch.numInRateWindow[alertType] >= batch.maxPerConditionPerSec)
+    {
+        batch.numDropped++;
+    }
+    else
+    {
+        batch.numInRateWindow[alertType]++;
+        batch.pending.push_back(response);
+        queued = true;
+    }
+
+    if (batch.pending.size() >= DCGM_MSG_POLICY_NOTIFY_BATCH_MAX)
+    {
+        TakeBatch(watcher.connectionId, watcher.requestId, batch, outgoing);
+    }
+    else if (batch.flushUsec == 0)
+    {
+        batch.flushUsec = now + batch.coalesceWindowUsec;
+        m_batchFlushNeeded.notify_all();
+    }
+
+    return queued;
+}
+
+/****************************************************************************/
+void DcgmPolicyManager::TakeBatch(dcgm_connection_id_t connectionId,
+                                  dcgm_request_id_t requestId,
+                                  dpm_batch_t &batch,
+                                  std::vector<dpm_outgoing_batch_t> &outgoing)
+{
+    dpm_outgoing_batch_t &out = outgoing.emplace_back();
+    out.connectionId          = connectionId;
+    out.requestId             = requestId;
+    out.notify.numResponses   = batch.pending.size();
+    out.notify.numDropped     = batch.numDropped;
+    std::copy(batch.pending.begin(), batch.pending.end(), out.notify.responses);
+
+    batch.pending.clear();
+    batch.numDropped = 0;
+    batch.flushUsec  = 0;
+}
+
+/****************************************************************************/
+void DcgmPolicyManager::SendBatches(std::vector<dpm_outgoing_batch_t> const &outgoing)
+{
+    for (auto const &out : outgoing)
+    {
+        log_debug("Notifying connectionId {}, requestId {} of {} violations. {} were dropped",
+                  out.connectionId,
+                  out.requestId,
+                  out.notify.numResponses,
+                  out.notify.numDropped);
+
+        /* Only the responses that are set go over the wire */
+        std::size_t const length = offsetof(dcgm_msg_policy_notify_batch_t, responses)
+                                   + out.notify.numResponses * sizeof(out.notify.responses[0]);
+        mpCoreProxy.SendRawMessageToClient(
+            out.connectionId, DCGM_MSG_POLICY_NOTIFY_BATCH, out.requestId, &out.notify, length, DCGM_ST_OK);
+    }
+}
+
+/****************************************************************************/
+void DcgmPolicyManager::StartBatchThreadLocked()
+{
+    if (m_batchThread.joinable())
+    {
+        return;
+    }
+
+    m_batchThread = std::jthread([this](std::stop_token stopToken) { BatchThreadMain(stopToken); });
+}
+
+/****************************************************************************/
+void DcgmPolicyManager::BatchThreadMain(std::stop_token stopToken)
+{
+    pthread_setname_np(pthread_self(), "dcgm_policy_bat");
+
+    while (!stopToken.stop_requested())
+    {
+        std::vector<dpm_outgoing_batch_t> outgoing;
+        timelib64_t nextFlushUsec = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_batchMutex);
+            timelib64_t const now = timelib_usecSince1970();
+
+            for (auto &[key, batch] : m_batches)
+            {
+                if (batch.flushUsec != 0 && batch.flushUsec <= now)
+                {
+                    TakeBatch(key.first, key.second, batch, outgoing);
+                }
+                else if (batch.flushUsec != 0 && (nextFlushUsec == 0 || batch.flushUsec < nextFlushUsec))
+                {
+                    nextFlushUsec = batch.flushUsec;
+                }
+            }
+
+            if (outgoing.empty())
+            {
+                /* Anything queued from here on sets flushUsec and signals us under the lock, so it can't be missed */
+                auto const flushPending = [this, nextFlushUsec] {
+                    return std::ranges::any_of(m_batches, [nextFlushUsec](auto const &entry) {
+                        return entry.second.flushUsec != 0
+                               && (nextFlushUsec == 0 || entry.second.flushUsec < nextFlushUsec);
+                    });
+                };
+
+                if (nextFlushUsec == 0)
+                {
+                    m_batchFlushNeeded.wait(lock, stopToken, flushPending);
+                }
+                else
+                {
+                    timelib64_t const sleepUsec = std::max(nextFlushUsec - now, (timelib64_t)0);
+                    m_batchFlushNeeded.wait_for(lock, stopToken, std::chrono::microseconds(sleepUsec), flushPending);
+                }
+                continue;
+            }
+        }
+
+        SendBatches(outgoing);
+    }
 }
 
 
@@ -213,21 +455,6 @@ dcgmReturn_t DcgmPolicyManager::UnregisterForPolicy(dcgm_policy_msg_unregister_t
 /*****************************************************************************/
 dcgmReturn_t DcgmPolicyManager::CheckEccErrors(dcgmBufferedFv_t *fv)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} ECC fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_DBE))
-    {
-        log_debug("Skipping gpuId {} ECC fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     unsigned int errorCount = fv->value.i64;
     log_debug("CheckEccErrors gpuId {}, errorCount {}", fv->entityId, errorCount);
 
@@ -255,21 +482,6 @@ dcgmReturn_t DcgmPolicyManager::CheckEccErrors(dcgmBufferedFv_t *fv)
 /*****************************************************************************/
 dcgmReturn_t DcgmPolicyManager::CheckPcieErrors(dcgmBufferedFv_t *fv)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} PCIe fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_PCI))
-    {
-        log_debug("Skipping gpuId {} PCIe fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     unsigned int errorCount = (unsigned int)fv->value.i64;
     if (errorCount > 0)
     {
@@ -293,23 +505,8 @@ dcgmReturn_t DcgmPolicyManager::CheckPcieErrors(dcgmBufferedFv_t *fv)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmPolicyManager::CheckRetiredPages(dcgmBufferedFv_t *fv)
+dcgmReturn_t DcgmPolicyManager::CheckRetiredPages(dcgmBufferedFv_t *fv, dpm_gpu_rules_t const &rules)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} retired pages fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_MAX_PAGES_RETIRED))
-    {
-        log_debug("Skipping gpuId {} retired pages fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     unsigned int pageCountSbe = 0, pageCountDbe = 0;
     dcgmcm_sample_t sample;
     dcgmReturn_t dcgmReturn;
@@ -368,9 +565,7 @@ dcgmReturn_t DcgmPolicyManager::CheckRetiredPages(dcgmBufferedFv_t *fv)
     // use the oldest error timestamp
     timestamp = std::min(sbeTimestamp, dbeTimestamp);
 
-    unsigned int maxRetiredPages = (unsigned int)m_gpus[fv->entityId]
-                                       .currentPolicies.parms[DCGM_VIOLATION_POLICY_FAIL_MAX_RETIRED_PAGES]
-                                       .val.llval;
+    unsigned int maxRetiredPages = (unsigned int)rules.thresholds[DCGM_VIOLATION_POLICY_FAIL_MAX_RETIRED_PAGES];
 
     if (pageCountDbe + pageCountSbe > maxRetiredPages)
     {
@@ -397,26 +592,10 @@ dcgmReturn_t DcgmPolicyManager::CheckRetiredPages(dcgmBufferedFv_t *fv)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmPolicyManager::CheckThermalValues(dcgmBufferedFv_t *fv)
+dcgmReturn_t DcgmPolicyManager::CheckThermalValues(dcgmBufferedFv_t *fv, dpm_gpu_rules_t const &rules)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} temperature fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_THERMAL))
-    {
-        log_debug("Skipping gpuId {} temperature fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     unsigned int gpuTemp = (unsigned int)fv->value.i64;
-    unsigned int maxTemp
-        = (unsigned int)m_gpus[fv->entityId].currentPolicies.parms[DCGM_VIOLATION_POLICY_FAIL_THERMAL].val.llval;
+    unsigned int maxTemp = (unsigned int)rules.thresholds[DCGM_VIOLATION_POLICY_FAIL_THERMAL];
     if ((unsigned int)gpuTemp > maxTemp)
     {
         dcgmPolicyCallbackResponse_t callbackResponse;
@@ -438,26 +617,10 @@ dcgmReturn_t DcgmPolicyManager::CheckThermalValues(dcgmBufferedFv_t *fv)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmPolicyManager::CheckPowerValues(dcgmBufferedFv_t *fv)
+dcgmReturn_t DcgmPolicyManager::CheckPowerValues(dcgmBufferedFv_t *fv, dpm_gpu_rules_t const &rules)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} power fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_POWER))
-    {
-        log_debug("Skipping gpuId {} power fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     unsigned int gpuPower = (unsigned int)fv->value.dbl;
-    unsigned int maxPower
-        = (unsigned int)m_gpus[fv->entityId].currentPolicies.parms[DCGM_VIOLATION_POLICY_FAIL_POWER].val.llval;
+    unsigned int maxPower = (unsigned int)rules.thresholds[DCGM_VIOLATION_POLICY_FAIL_POWER];
     if (gpuPower > maxPower)
     {
         dcgmPolicyCallbackResponse_t callbackResponse;
@@ -481,21 +644,6 @@ dcgmReturn_t DcgmPolicyManager::CheckPowerValues(dcgmBufferedFv_t *fv)
 /*****************************************************************************/
 dcgmReturn_t DcgmPolicyManager::CheckNVLinkErrors(dcgmBufferedFv_t *fv)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} NvLink counter fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_NVLINK))
-    {
-        log_debug("Skipping gpuId {} NvLink counter fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     if (fv->value.i64 > 0)
     {
         dcgmPolicyCallbackResponse_t callbackResponse;
@@ -522,21 +670,6 @@ dcgmReturn_t DcgmPolicyManager::CheckNVLinkErrors(dcgmBufferedFv_t *fv)
 /*****************************************************************************/
 dcgmReturn_t DcgmPolicyManager::CheckXIDErrors(dcgmBufferedFv_t *fv)
 {
-    if (fv->status != DCGM_ST_OK || DCGM_INT64_IS_BLANK(fv->value.i64))
-    {
-        log_debug("Skipping gpuId {} XID fieldId {} with status {}", fv->entityId, fv->fieldId, fv->status);
-        return DCGM_ST_OK;
-    }
-
-    if (!(m_gpus[fv->entityId].currentPolicies.condition & DCGM_POLICY_COND_XID))
-    {
-        log_debug("Skipping gpuId {} XID fieldId {} with condition mask x{:X}",
-                  fv->entityId,
-                  fv->fieldId,
-                  m_gpus[fv->entityId].currentPolicies.condition);
-        return DCGM_ST_OK;
-    }
-
     dcgmPolicyCallbackResponse_t callbackResponse;
     dcgmPolicyConditionXID_t xidResponse;
 
@@ -684,9 +817,21 @@ dcgmReturn_t DcgmPolicyManager::RegisterForPolicy(dcgm_policy_msg_register_t *ms
     newWatcher.requestId    = msg->header.requestId;
     memset(&newWatcher.lastSentTimestamp, 0, sizeof(newWatcher.lastSentTimestamp));
     newWatcher.conditions = msg->condition;
+    newWatcher.batched    = msg->coalesceWindowMs != 0;
 
     dcgm_mutex_lock(m_mutex);
 
+    if (newWatcher.batched)
+    {
+        dpm_batch_t batch {};
+        batch.coalesceWindowUsec    = (timelib64_t)msg->coalesceWindowMs * 1000;
+        batch.maxPerConditionPerSec = msg->maxPerConditionPerSec;
+
+        std::lock_guard<std::mutex> lg(m_batchMutex);
+        m_batches[{ newWatcher.connectionId, newWatcher.requestId }] = std::move(batch);
+        StartBatchThreadLocked();
+    }
+
     for (unsigned int i = 0; i < entities.size(); i++)
     {
         /* Policy manager only supports GPUs for now */
@@ -762,6 +907,8 @@ dcgmReturn_t DcgmPolicyManager::ProcessSetPolicy(dcgm_policy_msg_set_policy_t *m
                   gpuId);
     }
 
+    PublishRuleTable();
+
     dcgm_mutex_unlock(m_mutex);
 
     return DCGM_ST_OK;
@@ -849,6 +996,27 @@ void DcgmPolicyManager::RemoveWatchersForConnection(dcgm_connection_id_t connect
         }
     }
 
+    /* Deliver what batched registrations still have before they go away */
+    std::vector<dpm_outgoing_batch_t> outgoing;
+    {
+        std::lock_guard<std::mutex> lg(m_batchMutex);
+        for (dcgm_request_id_t requestId : seenRequestIds)
+        {
+            auto batchIt = m_batches.find({ connectionId, requestId });
+            if (batchIt == m_batches.end())
+            {
+                continue;
+            }
+
+            if (batchIt->second.flushUsec != 0)
+            {
+                TakeBatch(connectionId, requestId, batchIt->second, outgoing);
+            }
+            m_batches.erase(batchIt);
+        }
+    }
+    SendBatches(outgoing);
+
     /* notify each seenRequestIds for connectionId that it's gone */
     std::set<dcgm_request_id_t>::iterator requestIt;
     for (requestIt = seenRequestIds.begin(); requestIt != seenRequestIds.end(); ++requestIt)
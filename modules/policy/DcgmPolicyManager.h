@@ -20,6 +20,17 @@
 #include "DcgmProtocol.h"
 #include "dcgm_policy_structs.h"
 #include <DcgmCoreProxy.h>
+#include <timelib.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 /* These are array indexes that correspond with DCGM_POLICY_COND_* bitmasks */
 typedef enum DcgmViolationPolicyAlert_enum
@@ -53,8 +64,33 @@ typedef struct
                                           notifications */
     dcgmPolicyCondition_t conditions; /* A mask of policy conditions that this
                                           connection+request wants callbacks for */
+    bool batched;                     /* Are violations collected in DcgmPolicyManager::m_batches rather than
+                                         sent to the client one by one? */
 } dpm_watcher_t;
 
+/* Violations of a batched registration that haven't been sent yet, and its rate limit. A registration covers all
+   the GPUs of its group, so this is shared by its watchers on each GPU */
+typedef struct
+{
+    timelib64_t coalesceWindowUsec;                     /* How long violations are collected before they are sent */
+    unsigned int maxPerConditionPerSec;                 /* Most violations of a condition sent per second. 0 = no
+                                                           limit */
+    std::vector<dcgmPolicyCallbackResponse_t> pending; /* Violations to send, oldest first */
+    unsigned int numDropped;                           /* Violations dropped by the rate limit since the last send */
+    timelib64_t flushUsec;                             /* When pending and numDropped are sent. 0 if there is
+                                                          nothing to send */
+    timelib64_t rateWindowUsec[DCGM_VIOLATION_POLICY_FAIL_COUNT]; /* Start of the current second of each condition */
+    unsigned int numInRateWindow[DCGM_VIOLATION_POLICY_FAIL_COUNT]; /* Violations of each condition queued in it */
+} dpm_batch_t;
+
+/* A batch taken out of dpm_batch_t to be sent once no lock is held */
+typedef struct
+{
+    dcgm_connection_id_t connectionId;
+    dcgm_request_id_t requestId;
+    dcgm_msg_policy_notify_batch_t notify;
+} dpm_outgoing_batch_t;
+
 /* Per-GPU Policy context information */
 typedef struct
 {
@@ -68,6 +104,20 @@ typedef struct
     std::vector<dpm_watcher_t> watchers; /* connectionId+requestIds that care about this */
 } dpm_gpu_t;
 
+/* Compiled policy of one GPU */
+typedef struct
+{
+    unsigned int conditionMask; /* Mask of DCGM_POLICY_COND_* to evaluate. 0 if policies haven't been set */
+    long long thresholds[DCGM_VIOLATION_POLICY_FAIL_COUNT]; /* parms[].val.llval of each condition */
+} dpm_gpu_rules_t;
+
+/* Snapshot of the compiled policies of every GPU. OnFieldValuesUpdate() evaluates field values against this
+   without taking m_mutex. It is never modified once published. A new one is swapped in when policies change */
+typedef struct
+{
+    std::array<dpm_gpu_rules_t, DCGM_MAX_NUM_DEVICES> gpus;
+} dpm_rule_table_t;
+
 /******************************************************************
  * Class to implement the compute side policy manager
  ******************************************************************/
@@ -138,18 +188,59 @@ private:
     int m_numGpus;
     dpm_gpu_t m_gpus[DCGM_MAX_NUM_DEVICES]; /* Per-GPU information */
 
+    /* Compiled from m_gpus[].currentPolicies by PublishRuleTable(). Read without holding m_mutex */
+    std::atomic<std::shared_ptr<dpm_rule_table_t const>> m_ruleTable;
+
+    /* Batched registrations by connectionId+requestId. Protected by m_batchMutex, which is taken after m_mutex */
+    std::mutex m_batchMutex;
+    std::map<std::pair<dcgm_connection_id_t, dcgm_request_id_t>, dpm_batch_t> m_batches;
+    std::condition_variable_any m_batchFlushNeeded; /* Signaled when a batch gets something to send */
+    std::jthread m_batchThread; /* Sends batches whose window ended. Started by the first batched registration */
+
     /* methods */
+
+    /* Compile m_gpus[].currentPolicies into a new rule table and publish it. m_mutex must be held */
+    void PublishRuleTable();
+
+    /* Map a fieldId to the DcgmViolationPolicyAlert_t OnFieldValuesUpdate() evaluates it against.
+       Returns DCGM_VIOLATION_POLICY_FAIL_COUNT for fields that aren't policy fields */
+    static DcgmViolationPolicyAlert_t GetAlertTypeOfField(unsigned short fieldId);
+
+    /* Queue a violation for the batched watcher. Violations beyond the rate limit of the watcher are dropped.
+       Moves the batch to outgoing if it is full. m_mutex must be held. Returns whether the violation was queued */
+    bool QueueBatchedViolation(dpm_watcher_t const &watcher,
+                               DcgmViolationPolicyAlert_t alertType,
+                               dcgmPolicyCallbackResponse_t const &response,
+                               std::vector<dpm_outgoing_batch_t> &outgoing);
+
+    /* Move what batch has to send to outgoing and clear it. m_batchMutex must be held */
+    static void TakeBatch(dcgm_connection_id_t connectionId,
+                          dcgm_request_id_t requestId,
+                          dpm_batch_t &batch,
+                          std::vector<dpm_outgoing_batch_t> &outgoing);
+
+    /* Send batches to their clients as DCGM_MSG_POLICY_NOTIFY_BATCH */
+    void SendBatches(std::vector<dpm_outgoing_batch_t> const &outgoing);
+
+    /* Start m_batchThread if it isn't running. m_batchMutex must be held */
+    void StartBatchThreadLocked();
+
+    /* Body of m_batchThread */
+    void BatchThreadMain(std::stop_token stopToken);
+
+    /* Notifies the watchers of gpuId that asked for alertType. Takes m_mutex */
     void SetViolation(DcgmViolationPolicyAlert_t alertType,
                       unsigned int gpuId,
                       int64_t timestamp,
                       dcgmPolicyCallbackResponse_t *callbackResponse);
 
-    /* error checking functions */
+    /* error checking functions. These are only called for FVs with a valid value whose condition is in
+       rules.conditionMask */
     dcgmReturn_t CheckEccErrors(dcgmBufferedFv_t *fv);
     dcgmReturn_t CheckPcieErrors(dcgmBufferedFv_t *fv);
-    dcgmReturn_t CheckRetiredPages(dcgmBufferedFv_t *fv);
-    dcgmReturn_t CheckThermalValues(dcgmBufferedFv_t *fv);
-    dcgmReturn_t CheckPowerValues(dcgmBufferedFv_t *fv);
+    dcgmReturn_t CheckRetiredPages(dcgmBufferedFv_t *fv, dpm_gpu_rules_t const &rules);
+    dcgmReturn_t CheckThermalValues(dcgmBufferedFv_t *fv, dpm_gpu_rules_t const &rules);
+    dcgmReturn_t CheckPowerValues(dcgmBufferedFv_t *fv, dpm_gpu_rules_t const &rules);
     dcgmReturn_t CheckNVLinkErrors(dcgmBufferedFv_t *fv);
     dcgmReturn_t CheckXIDErrors(dcgmBufferedFv_t *fv);
 
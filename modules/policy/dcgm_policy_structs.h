@@ -70,6 +70,8 @@ typedef dcgm_policy_msg_set_policy_v1 dcgm_policy_msg_set_policy_t;
 /*****************************************************************************/
 /**
  * Subrequest DCGM_POLICY_SR_REGISTER
+ *
+ * V1 registrations are notified of each violation with its own DCGM_MSG_POLICY_NOTIFY
  */
 typedef struct dcgm_policy_msg_register_v1
 {
@@ -79,10 +81,25 @@ typedef struct dcgm_policy_msg_register_v1
     dcgmPolicyCondition_t condition; /*  IN: Policy condition to register for */
 } dcgm_policy_msg_register_v1;
 
+/**
+ * V2 adds batched notifications. Violations are sent as DCGM_MSG_POLICY_NOTIFY_BATCH if coalesceWindowMs is set
+ */
+typedef struct dcgm_policy_msg_register_v2
+{
+    dcgm_module_command_header_t header; /* Command header */
+
+    dcgmGpuGrp_t groupId;               /*  IN: Group ID to register for policy updates from */
+    dcgmPolicyCondition_t condition;    /*  IN: Policy condition to register for */
+    unsigned int coalesceWindowMs;      /*  IN: How long violations are collected before they are sent together.
+                                                0 = send each one as DCGM_MSG_POLICY_NOTIFY, like v1 */
+    unsigned int maxPerConditionPerSec; /*  IN: Most violations of a condition sent per second. 0 = no limit */
+} dcgm_policy_msg_register_v2;
+
 #define dcgm_policy_msg_register_version1 MAKE_DCGM_VERSION(dcgm_policy_msg_register_v1, 1)
-#define dcgm_policy_msg_register_version  dcgm_policy_msg_register_version1
+#define dcgm_policy_msg_register_version2 MAKE_DCGM_VERSION(dcgm_policy_msg_register_v2, 2)
+#define dcgm_policy_msg_register_version  dcgm_policy_msg_register_version2
 
-typedef dcgm_policy_msg_register_v1 dcgm_policy_msg_register_t;
+typedef dcgm_policy_msg_register_v2 dcgm_policy_msg_register_t;
 
 /*****************************************************************************/
 /**
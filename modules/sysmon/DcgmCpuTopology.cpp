@@ -238,7 +238,8 @@ dcgmReturn_t DcgmCpuTopology::MatchNumaNodesAndCpus(const std::vector<dcgm_sysmo
     return DCGM_ST_OK;
 }
 
-dcgmReturn_t DcgmCpuTopology::Initialize(const std::vector<dcgm_sysmon_cpu_t> &cpuList)
+dcgmReturn_t DcgmCpuTopology::Initialize(const std::vector<dcgm_sysmon_cpu_t> &cpuList,
+                                         const std::vector<HwInventoryNumaNode> &numaNodes)
 {
     if (m_initialized)
     {
@@ -258,7 +259,19 @@ dcgmReturn_t DcgmCpuTopology::Initialize(const std::vector<dcgm_sysmon_cpu_t> &c
     for (auto &numaToCoreRange : m_numaNodeToCoreRange)
     {
         unsigned int firstCore = std::stoi(numaToCoreRange.second);
-        ret                    = ReadCoresPhysicalLocation(firstCore, numaToCoreRange.first);
+
+        auto const node = std::find_if(numaNodes.begin(), numaNodes.end(), [&](HwInventoryNumaNode const &node) {
+            return node.nodeId == numaToCoreRange.first && node.physicalPackageId.has_value();
+        });
+        if (node != numaNodes.end())
+        {
+            m_physicalLocationToNumaNodes[*node->physicalPackageId].emplace_back(numaToCoreRange.first);
+            ret = DCGM_ST_OK;
+        }
+        else
+        {
+            ret = ReadCoresPhysicalLocation(firstCore, numaToCoreRange.first);
+        }
         if (ret != DCGM_ST_OK)
         {
             log_error("Couldn't read the physical location for core {}", firstCore);
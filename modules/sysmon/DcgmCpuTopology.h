@@ -20,6 +20,7 @@
 
 #include "dcgm_sysmon_structs.h"
 #include <DcgmEntityTypes.hpp>
+#include <HwInventory.h>
 #include <dcgm_structs.h>
 
 namespace DcgmNs
@@ -65,9 +66,12 @@ public:
      * Generates the topology for the CPUs, sockets, NUMA nodes, and cores on this system.
      *
      * @param cpuList - a list of structs describing which CPUs belong to which cores
+     * @param numaNodes - the NUMA nodes of the hardware inventory. The physical location of the
+     *                    nodes that have one isn't read from sysfs again
      * @return DCGM_ST_OK if we successfully initialized, or DCGM_ST_* on a failure
      */
-    dcgmReturn_t Initialize(const std::vector<dcgm_sysmon_cpu_t> &cpuList);
+    dcgmReturn_t Initialize(const std::vector<dcgm_sysmon_cpu_t> &cpuList,
+                            const std::vector<HwInventoryNumaNode> &numaNodes = {});
 
     /*
      * Return the Socket number for the specified CPU
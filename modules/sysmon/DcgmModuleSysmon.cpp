@@ -19,6 +19,7 @@
 #include <DcgmEntityTypes.hpp>
 #include <DcgmLogging.h>
 #include <DcgmStringHelpers.h>
+#include <HwInventory.h>
 #include <dcgm_api_export.h>
 #include <dcgm_helpers.h>
 #include <dcgm_structs.h>
@@ -47,9 +48,147 @@ unsigned long long SysmonUtilizationSampleCore::GetActive() const
     return GetTotal() - m_idle;
 }
 
+/*****************************************************************************/
+void SysmonUtilizationRing::Reset(size_t numCores)
+{
+    m_head = 0;
+    m_size = 0;
+
+    if (numCores != m_numCores)
+    {
+        m_numCores = numCores;
+        m_capacity = 0;
+        m_timestamps.clear();
+        for (auto &counter : m_counters)
+        {
+            counter.clear();
+        }
+    }
+}
+
+/*****************************************************************************/
+void SysmonUtilizationRing::Grow()
+{
+    size_t const newCapacity = std::max(m_capacity * 2, c_initialCapacity);
+
+    std::vector<Timelib::TimePoint> timestamps(newCapacity);
+    for (size_t age = 0; age < m_size; age++)
+    {
+        timestamps[age] = m_timestamps[ToSlot(age)];
+    }
+    m_timestamps = std::move(timestamps);
+
+    for (auto &counter : m_counters)
+    {
+        std::vector<unsigned long long> values(newCapacity * m_numCores);
+        for (size_t age = 0; age < m_size; age++)
+        {
+            std::copy_n(counter.data() + ToSlot(age) * m_numCores, m_numCores, values.data() + age * m_numCores);
+        }
+        counter = std::move(values);
+    }
+
+    m_capacity = newCapacity;
+    m_head     = 0;
+}
+
+/*****************************************************************************/
+size_t SysmonUtilizationRing::Append(Timelib::TimePoint timestamp)
+{
+    if (m_size > 0 && timestamp < m_timestamps[ToSlot(m_size - 1)])
+    {
+        log_debug("Dropping {} utilization samples newer than the new one", m_size);
+        m_head = 0;
+        m_size = 0;
+    }
+
+    if (m_size == m_capacity)
+    {
+        Grow();
+    }
+
+    size_t const slot = ToSlot(m_size);
+    m_size++;
+
+    m_timestamps[slot] = timestamp;
+    for (auto &counter : m_counters)
+    {
+        std::fill_n(counter.data() + slot * m_numCores, m_numCores, 0ULL);
+    }
+
+    return slot;
+}
+
+/*****************************************************************************/
+std::optional<size_t> SysmonUtilizationRing::FindAtOrBefore(Timelib::TimePoint timestamp) const
+{
+    /* Binary search for the oldest sample after timestamp */
+    size_t low  = 0;
+    size_t high = m_size;
+    while (low < high)
+    {
+        size_t const mid = low + (high - low) / 2;
+        if (m_timestamps[ToSlot(mid)] <= timestamp)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    if (low == 0)
+    {
+        return std::nullopt;
+    }
+    return ToSlot(low - 1);
+}
+
+/*****************************************************************************/
+std::optional<size_t> SysmonUtilizationRing::GetLatest() const
+{
+    if (m_size == 0)
+    {
+        return std::nullopt;
+    }
+    return ToSlot(m_size - 1);
+}
+
+/*****************************************************************************/
+void SysmonUtilizationRing::Prune(Timelib::TimePoint cutOff)
+{
+    while (m_size > 0 && m_timestamps[m_head] <= cutOff)
+    {
+        m_head = ToSlot(1);
+        m_size--;
+    }
+}
+
+/*****************************************************************************/
+SysmonUtilizationSampleCore SysmonUtilizationRing::GetCore(size_t slot, size_t core) const
+{
+    return SysmonUtilizationSampleCore { .m_user   = GetCounters(slot, COUNTER_USER)[core],
+                                         .m_nice   = GetCounters(slot, COUNTER_NICE)[core],
+                                         .m_system = GetCounters(slot, COUNTER_SYSTEM)[core],
+                                         .m_idle   = GetCounters(slot, COUNTER_IDLE)[core],
+                                         .m_irq    = GetCounters(slot, COUNTER_IRQ)[core],
+                                         .m_other  = GetCounters(slot, COUNTER_OTHER)[core] };
+}
+
+/*****************************************************************************/
+void SysmonUtilizationRing::SetCore(size_t slot, size_t core, SysmonUtilizationSampleCore const &values)
+{
+    GetCounters(slot, COUNTER_USER)[core]   = values.m_user;
+    GetCounters(slot, COUNTER_NICE)[core]   = values.m_nice;
+    GetCounters(slot, COUNTER_SYSTEM)[core] = values.m_system;
+    GetCounters(slot, COUNTER_IDLE)[core]   = values.m_idle;
+    GetCounters(slot, COUNTER_IRQ)[core]    = values.m_irq;
+    GetCounters(slot, COUNTER_OTHER)[core]  = values.m_other;
+}
+
 DcgmModuleSysmon::DcgmModuleSysmon(dcgmCoreCallbacks_t &dcc)
     : DcgmModuleWithCoreProxy(dcc)
-    , m_procStat("/proc/stat")
     , m_paused(true)
     , m_sysmonThreadId(0)
 {
@@ -58,6 +197,7 @@ DcgmModuleSysmon::DcgmModuleSysmon(dcgmCoreCallbacks_t &dcc)
     PopulateCpusIfNeeded();
     m_sysmon.Init();
 
+    SetThreadName("mod_sysmon");
     int st = Start();
     if (st)
     {
@@ -198,6 +338,7 @@ dcgmReturn_t DcgmModuleSysmon::ProcessMessageFromTaskRunner(dcgm_module_command_
             case DCGM_SYSMON_SR_CREATE_FAKE_ENTITIES:
             {
                 ProcessCreateFakeEntities(moduleCommand);
+                PublishEntityStatuses();
                 break;
             }
 
@@ -341,9 +482,19 @@ dcgmReturn_t DcgmModuleSysmon::ProcessUnwatchFields(UnwatchFieldsMessage msg)
     m_watchTable.RemoveWatches(msg->watcher, postWatchInfo);
     m_watchTable.GetMaxAgeUsecAllWatches(minSampleAgeUsec, maxSampleAgeUsec);
     m_maxSampleAge = TimePoint(FromLegacyTimestamp<microseconds>(maxSampleAgeUsec));
+    CloseSampledFiles();
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmModuleSysmon::CloseSampledFiles()
+{
+    ASSERT_IS_SYSMON_THREAD;
+
+    m_sysfs.CloseAll();
+    m_sysmon.ClosePowerFiles();
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleSysmon::ProcessGetEntityStatus(GetEntityStatusMessage msg)
 {
@@ -380,9 +531,43 @@ dcgmReturn_t DcgmModuleSysmon::ProcessGetEntityStatus(GetEntityStatusMessage msg
             log_error("Received eg {} eid {}", msg->entityGroupId, msg->entityId);
             return DCGM_ST_BADPARAM;
     }
+
+    /* Core only asks about CPUs until we have pushed their statuses once */
+    if (!m_entityStatusesPublished)
+    {
+        PublishEntityStatuses();
+    }
     return DCGM_ST_OK;
 }
 
+/*****************************************************************************/
+void DcgmModuleSysmon::PublishEntityStatuses()
+{
+    ASSERT_IS_SYSMON_THREAD;
+
+    std::vector<dcgmCoreEntityStatus_t> cpus;
+    std::vector<dcgmCoreEntityStatus_t> cores;
+    for (auto const &cpu : m_cpus.GetCpus())
+    {
+        cpus.push_back({ cpu.cpuId, DcgmEntityStatusOk });
+        for (unsigned int coreId : m_cpus.GetCoreIdList(cpu.cpuId))
+        {
+            cores.push_back({ coreId, DcgmEntityStatusOk });
+        }
+    }
+
+    /* Not retried on failure. Core keeps asking this module about the groups it couldn't take */
+    m_entityStatusesPublished = true;
+    if (dcgmReturn_t ret = m_coreProxy.SetEntityStatuses(DCGM_FE_CPU, cpus); ret != DCGM_ST_OK)
+    {
+        log_debug("Couldn't push the statuses of {} CPUs: {}", cpus.size(), errorString(ret));
+    }
+    if (dcgmReturn_t ret = m_coreProxy.SetEntityStatuses(DCGM_FE_CPU_CORE, cores); ret != DCGM_ST_OK)
+    {
+        log_debug("Couldn't push the statuses of {} cores: {}", cores.size(), errorString(ret));
+    }
+}
+
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleSysmon::ProcessCreateFakeEntities(CreateFakeEntitiesMessage msg)
 {
@@ -472,36 +657,6 @@ dcgmReturn_t DcgmModuleSysmon::ProcessCoreMessage(dcgm_module_command_header_t *
     return retSt;
 }
 
-/*****************************************************************************/
-static std::tuple<unsigned int, unsigned int> getFirstLastSystemNodes()
-{
-    std::ifstream file;
-    file.open("/sys/devices/system/node/has_cpu");
-
-    // Node range expected to be in the form "x-y" or "x"
-    std::string nodeRange;
-    file >> nodeRange;
-
-    auto firstLastNode = DcgmNs::Split(nodeRange, '-');
-
-    if (firstLastNode.size() == 2)
-    {
-        unsigned int firstNode = strtoul(std::string(firstLastNode[0]).c_str(), nullptr, 10);
-        unsigned int lastNode  = strtoul(std::string(firstLastNode[1]).c_str(), nullptr, 10);
-        return { firstNode, lastNode };
-    }
-    else if (firstLastNode.size() == 1)
-    {
-        unsigned int node = strtoul(nodeRange.c_str(), nullptr, 10);
-        return { node, node };
-    }
-    else
-    {
-        log_error("Could not enumerate NODEs");
-        throw std::runtime_error("Coud not enumerate NODEs");
-    }
-}
-
 /*****************************************************************************/
 dcgmReturn_t DcgmModuleSysmon::PopulateOwnedCoresBitmaskFromRangeString(dcgm_sysmon_cpu_t &cpu,
                                                                         const std::string &rangeStr)
@@ -563,15 +718,8 @@ dcgmReturn_t DcgmModuleSysmon::PopulateOwnedCoresBitmaskFromRangeString(dcgm_sys
 }
 
 /*****************************************************************************/
-void DcgmModuleSysmon::PopulateOwnedCoresBitmask(dcgm_sysmon_cpu_t &cpu)
+void DcgmModuleSysmon::PopulateOwnedCoresBitmask(dcgm_sysmon_cpu_t &cpu, const std::string &cpuRange)
 {
-    std::ifstream file;
-    std::string filename = fmt::format("/sys/devices/system/node/node{}/cpulist", cpu.cpuId);
-    file.open(filename);
-
-    std::string cpuRange;
-    file >> cpuRange;
-
     dcgmReturn_t ret = PopulateOwnedCoresBitmaskFromRangeString(cpu, cpuRange);
     if (ret == DCGM_ST_BADPARAM)
     {
@@ -596,30 +744,37 @@ dcgmReturn_t DcgmModuleSysmon::PopulateCpusIfNeeded()
     {
         return DCGM_ST_ALREADY_INITIALIZED;
     }
-    auto [firstNode, lastNode] = getFirstLastSystemNodes();
-    CpuHelpers cpuHelpers;
-    auto cpuSerialNumbers      = cpuHelpers.GetCpuSerials();
-    bool getSerialNumberFailed = false;
-    if (!cpuSerialNumbers.has_value() || cpuSerialNumbers->size() != (lastNode - firstNode + 1))
+
+    /* The nodes, their CPUs and the serials are read once per boot and shared with the rest of DCGM */
+    auto const inventory = HwInventory::Instance().Get();
+    if (inventory->numaNodes.empty())
+    {
+        log_error("Could not enumerate NODEs");
+        throw std::runtime_error("Coud not enumerate NODEs");
+    }
+
+    auto const &cpuSerialNumbers = inventory->cpuSerials;
+    bool getSerialNumberFailed   = false;
+    if (!cpuSerialNumbers.has_value() || cpuSerialNumbers->size() != inventory->numaNodes.size())
     {
         log_warning("Could not retrieve serial numbers for CPUs");
         getSerialNumberFailed = true;
     }
 
-    for (unsigned int cpuId = firstNode; cpuId <= lastNode; cpuId++)
+    for (auto const &numaNode : inventory->numaNodes)
     {
         dcgm_sysmon_cpu_t cpu {};
-        cpu.cpuId = cpuId;
-        PopulateOwnedCoresBitmask(cpu);
-        if (!getSerialNumberFailed)
+        cpu.cpuId = numaNode.nodeId;
+        PopulateOwnedCoresBitmask(cpu, numaNode.cpuList);
+        if (!getSerialNumberFailed && cpu.cpuId < cpuSerialNumbers->size())
         {
-            SafeCopyTo(cpu.serial, cpuSerialNumbers->at(cpuId).c_str());
+            SafeCopyTo(cpu.serial, cpuSerialNumbers->at(cpu.cpuId).c_str());
         }
 
         m_cpus.AddCpu(cpu);
     }
 
-    m_cpuTopology.Initialize(m_cpus.GetCpus());
+    m_cpuTopology.Initialize(m_cpus.GetCpus(), inventory->numaNodes);
 
     return DCGM_ST_OK;
 }
@@ -634,97 +789,128 @@ static std::string readEntireFile(std::ifstream &file)
 }
 
 /*****************************************************************************/
-dcgmReturn_t DcgmModuleSysmon::ParseProcStatCpuLine(const std::string &line, SysmonUtilizationSample &sample)
+dcgmReturn_t DcgmModuleSysmon::ParseProcStatCpuLine(std::string_view line, size_t slot)
 {
     /*
      * Looking for lines in the format (some systems might not have info after softirq):
      * cpu0 9718962 9988 2368503 659591203 177159 0 8903 0 0 0
      * cpu<index> user nice system idle iowait irq softirq steal guest guest_nice
      */
-    if (line.compare(0, 3, "cpu") != 0)
+    if (!line.starts_with("cpu"))
     {
         return DCGM_ST_OK;
     }
 
-    std::string cpuUtilSubstring = line.substr(3);
+    std::string_view cpuUtilSubstring = line.substr(3);
 
-    unsigned int coreIndex;
-    unsigned long long user   = 0;
-    unsigned long long nice   = 0;
-    unsigned long long system = 0;
-    unsigned long long idle   = 0;
-    unsigned long long iowait = 0;
-    unsigned long long irq    = 0;
-    unsigned long long other  = 0;
-    unsigned long long temp   = 0;
+    unsigned long long coreIndex = 0;
+    unsigned long long user      = 0;
+    unsigned long long nice      = 0;
+    unsigned long long system    = 0;
+    unsigned long long idle      = 0;
+    unsigned long long iowait    = 0;
+    unsigned long long irq       = 0;
+    unsigned long long other     = 0;
+    unsigned long long temp      = 0;
 
-    std::istringstream cpuUtilStream(cpuUtilSubstring);
-    cpuUtilStream >> coreIndex >> user >> nice >> system >> idle >> iowait >> irq;
+    /* The core index and the first four counters are always present. The rest depend on the kernel version */
+    if (!DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, coreIndex)
+        || !DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, user)
+        || !DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, nice)
+        || !DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, system)
+        || !DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, idle))
+    {
+        log_error("Could not parse stat line: {}", line);
+        return DCGM_ST_BADPARAM;
+    }
+
+    DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, iowait);
+    DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, irq);
 
     // other sums up the counters we don't expose as metrics
     other = iowait;
-    while (cpuUtilStream >> temp)
+    while (DcgmSysfsReader::ParseUnsigned(cpuUtilSubstring, temp))
     {
         other += temp;
     }
 
     // We should stop reading because the line ended
-    if (!cpuUtilStream.eof())
+    if (cpuUtilSubstring.find_first_not_of(" \t\r\n") != std::string_view::npos)
     {
         log_error("Could not parse stat line: {}", line);
         return DCGM_ST_BADPARAM;
     }
 
-    if (coreIndex >= sample.m_cores.size())
+    if (coreIndex >= m_utilizationSamples.GetNumCores())
     {
-        log_error("Core index {} >= sample core count {}", coreIndex, sample.m_cores.size());
+        log_error("Core index {} >= sample core count {}", coreIndex, m_utilizationSamples.GetNumCores());
         return DCGM_ST_BADPARAM;
     }
 
-    auto &coreObj    = sample.m_cores[coreIndex];
-    coreObj.m_user   = user;
-    coreObj.m_nice   = nice;
-    coreObj.m_idle   = idle;
-    coreObj.m_system = system;
-    coreObj.m_irq    = irq;
-    coreObj.m_other  = other;
+    m_utilizationSamples.GetCounters(slot, SysmonUtilizationRing::COUNTER_USER)[coreIndex]   = user;
+    m_utilizationSamples.GetCounters(slot, SysmonUtilizationRing::COUNTER_NICE)[coreIndex]   = nice;
+    m_utilizationSamples.GetCounters(slot, SysmonUtilizationRing::COUNTER_SYSTEM)[coreIndex] = system;
+    m_utilizationSamples.GetCounters(slot, SysmonUtilizationRing::COUNTER_IDLE)[coreIndex]   = idle;
+    m_utilizationSamples.GetCounters(slot, SysmonUtilizationRing::COUNTER_IRQ)[coreIndex]    = irq;
+    m_utilizationSamples.GetCounters(slot, SysmonUtilizationRing::COUNTER_OTHER)[coreIndex]  = other;
 
     return DCGM_ST_OK;
 }
 
 /*****************************************************************************/
-const SysmonUtilizationSample &DcgmModuleSysmon::ReadUtilizationSample(DcgmNs::Timelib::TimePoint now)
+size_t DcgmModuleSysmon::ReadUtilizationSample(DcgmNs::Timelib::TimePoint now)
 {
     ASSERT_IS_SYSMON_THREAD;
 
     // Check if we have already read the sample
-    auto currentSampleIt = m_utilizationSamples.find(now);
-    if (currentSampleIt != m_utilizationSamples.end())
+    auto const latest = m_utilizationSamples.GetLatest();
+    if (latest.has_value() && m_utilizationSamples.GetTimestamp(*latest) == now)
     {
-        return currentSampleIt->second;
+        return *latest;
     }
 
-    std::string statContents = readEntireFile(m_procStat);
-    std::istringstream statStream(statContents);
-    std::string line;
-    SysmonUtilizationSample sample;
-    sample.m_timestamp = now;
-    // Allocate space in the sample for all the cores
-    sample.m_cores.resize(m_cpus.GetTotalCoreCount());
+    // Samples have room for all the cores
+    size_t const numCores = m_cpus.GetTotalCoreCount();
+    if (m_utilizationSamples.GetNumCores() != numCores)
+    {
+        m_utilizationSamples.Reset(numCores);
+    }
+    size_t const slot = m_utilizationSamples.Append(now);
 
-    std::getline(statStream, line); // Skip first line which lists aggregate stats for the system
+    // Every core is parsed from a single read of /proc/stat
+    std::string_view statContents;
+    if (m_sysfs.Read(SYSMON_PROC_STAT_PATH, statContents) != DCGM_ST_OK)
+    {
+        SYSMON_LOG_IFSTREAM_ERROR("CPU utilization", SYSMON_PROC_STAT_PATH);
+    }
 
-    while (std::getline(statStream, line))
+    bool firstLine = true;
+    while (!statContents.empty())
     {
-        dcgmReturn_t ret = ParseProcStatCpuLine(line, sample);
+        size_t lineEnd        = statContents.find('\n');
+        std::string_view line = statContents.substr(0, lineEnd);
+        statContents.remove_prefix(lineEnd == std::string_view::npos ? statContents.size() : lineEnd + 1);
+
+        if (firstLine)
+        {
+            firstLine = false; // Skip first line which lists aggregate stats for the system
+            continue;
+        }
+
+        // Past the per-core lines
+        if (!line.starts_with("cpu"))
+        {
+            break;
+        }
+
+        dcgmReturn_t ret = ParseProcStatCpuLine(line, slot);
         if (ret != DCGM_ST_OK)
         {
             log_error("Couldn't parse proc stat line: '{}': {}", line, errorString(ret));
         }
     }
 
-    m_utilizationSamples.emplace(now, sample);
-    return m_utilizationSamples[now];
+    return slot;
 }
 
 dcgmReturn_t DcgmModuleSysmon::UpdateField(DcgmNs::Timelib::TimePoint now, const dcgm_field_update_info_t &updateInfo)
@@ -744,22 +930,19 @@ dcgmReturn_t DcgmModuleSysmon::UpdateField(DcgmNs::Timelib::TimePoint now, const
         case DCGM_FI_DEV_CPU_UTIL_SYS:
         case DCGM_FI_DEV_CPU_UTIL_IRQ:
         {
-            const SysmonUtilizationSample &currentSample = ReadUtilizationSample(now);
+            size_t const currentSlot = ReadUtilizationSample(now);
 
-            // upper_bound returns the first element with a key above upper_bound
-            auto baselineSamplePlusOneIt = m_utilizationSamples.upper_bound(baselineTime);
-            if (baselineSamplePlusOneIt == m_utilizationSamples.begin())
+            auto const baselineSlot = m_utilizationSamples.FindAtOrBefore(baselineTime);
+            if (!baselineSlot.has_value())
             {
                 return DCGM_ST_NO_DATA;
             }
-            auto baselineSampleIt                         = std::prev(baselineSamplePlusOneIt);
-            const SysmonUtilizationSample &baselineSample = baselineSampleIt->second;
 
             double value = CalculateUtilizationForEntity(updateInfo.entityGroupId,
                                                          updateInfo.entityId,
                                                          updateInfo.fieldMeta->fieldId,
-                                                         baselineSample,
-                                                         currentSample);
+                                                         *baselineSlot,
+                                                         currentSlot);
 
             if (value == -1)
             {
@@ -802,15 +985,8 @@ void DcgmModuleSysmon::ProcessPruneSamples(DcgmNs::Timelib::TimePoint now)
 
     TimePoint cutOffMinimumExclusive = TimePoint(now - m_maxSampleAge);
 
-    auto upperBound = m_utilizationSamples.upper_bound(cutOffMinimumExclusive);
-
-    if (upperBound == m_utilizationSamples.end())
-    {
-        log_debug("Pruning all samples (upper_bound > now)");
-    }
-
-    m_utilizationSamples.erase(m_utilizationSamples.begin(), upperBound);
-    log_debug("Pruned old samples. utilizationSamples.size = {}", m_utilizationSamples.size());
+    m_utilizationSamples.Prune(cutOffMinimumExclusive);
+    log_debug("Pruned old samples. utilizationSamples.size = {}", m_utilizationSamples.GetSize());
 }
 
 /*****************************************************************************/
@@ -870,10 +1046,10 @@ void DcgmModuleSysmon::UpdateFields(timelib64_t &nextUpdateTimeUsec)
 /*****************************************************************************/
 double DcgmModuleSysmon::CalculateCoreUtilization(CoreId core,
                                                   unsigned int fieldId,
-                                                  const SysmonUtilizationSample &baselineSample,
-                                                  const SysmonUtilizationSample &currentSample)
+                                                  size_t baselineSlot,
+                                                  size_t currentSlot)
 {
-    if (currentSample.m_cores.size() <= core.id || baselineSample.m_cores.size() <= core.id)
+    if (m_utilizationSamples.GetNumCores() <= core.id)
     {
         log_error("Invalid core {}", core.id);
         return -1;
@@ -881,8 +1057,8 @@ double DcgmModuleSysmon::CalculateCoreUtilization(CoreId core,
 
     double value = 0;
 
-    auto &baselineCore = baselineSample.m_cores[core.id];
-    auto &currentCore  = currentSample.m_cores[core.id];
+    auto const baselineCore = m_utilizationSamples.GetCore(baselineSlot, core.id);
+    auto const currentCore  = m_utilizationSamples.GetCore(currentSlot, core.id);
 
     switch (fieldId)
     {
@@ -923,8 +1099,8 @@ double DcgmModuleSysmon::CalculateCoreUtilization(CoreId core,
 /*****************************************************************************/
 double DcgmModuleSysmon::CalculateCpuUtilization(CpuId cpu,
                                                  unsigned int fieldId,
-                                                 const SysmonUtilizationSample &baselineSample,
-                                                 const SysmonUtilizationSample &currentSample)
+                                                 size_t baselineSlot,
+                                                 size_t currentSlot)
 {
     ASSERT_IS_SYSMON_THREAD;
 
@@ -932,7 +1108,7 @@ double DcgmModuleSysmon::CalculateCpuUtilization(CpuId cpu,
     std::vector<unsigned int> coreIds = m_cpus.GetCoreIdList(cpu.id);
     for (auto &coreId : coreIds)
     {
-        value += CalculateCoreUtilization(CoreId { coreId }, fieldId, baselineSample, currentSample);
+        value += CalculateCoreUtilization(CoreId { coreId }, fieldId, baselineSlot, currentSlot);
     }
     return value / coreIds.size();
 }
@@ -941,8 +1117,8 @@ double DcgmModuleSysmon::CalculateCpuUtilization(CpuId cpu,
 double DcgmModuleSysmon::CalculateUtilizationForEntity(unsigned int entityGroupId,
                                                        unsigned int entityId,
                                                        unsigned int fieldId,
-                                                       const SysmonUtilizationSample &baselineSample,
-                                                       const SysmonUtilizationSample &currentSample)
+                                                       size_t baselineSlot,
+                                                       size_t currentSlot)
 {
     switch (fieldId)
     {
@@ -959,11 +1135,11 @@ double DcgmModuleSysmon::CalculateUtilizationForEntity(unsigned int entityGroupI
 
     if (entityGroupId == DCGM_FE_CPU_CORE)
     {
-        return CalculateCoreUtilization(CoreId { entityId }, fieldId, baselineSample, currentSample);
+        return CalculateCoreUtilization(CoreId { entityId }, fieldId, baselineSlot, currentSlot);
     }
     else if (entityGroupId == DCGM_FE_CPU)
     {
-        return CalculateCpuUtilization(CpuId { entityId }, fieldId, baselineSample, currentSample);
+        return CalculateCpuUtilization(CpuId { entityId }, fieldId, baselineSlot, currentSlot);
     }
 
     log_error("Invalid eg {}", entityGroupId);
@@ -989,20 +1165,22 @@ double DcgmModuleSysmon::ReadTemperature(unsigned int cpuId, short fieldId)
             log_error("Unknown CPU temperature field id {}", fieldId);
             return 0.0;
     }
-    std::ifstream file(path);
-    if (file)
+    long long tempAdjusted = 0;
+    dcgmReturn_t ret       = m_sysfs.ReadInt64(path, tempAdjusted);
+    if (ret == DCGM_ST_OK)
     {
-        std::string contents = readEntireFile(file);
         // Format is 43900 for 43.9 degrees, or 104500 for 104.5 degrees
-        unsigned int tempAdjusted = std::stoi(contents);
-
         return static_cast<double>(tempAdjusted) / 1000.0;
     }
-    else
+    else if (ret == DCGM_ST_NO_DATA)
     {
         SYSMON_LOG_IFSTREAM_ERROR("CPU temperature", path);
-        return 0.0;
     }
+    else
+    {
+        log_error("Couldn't read a temperature from '{}'", path);
+    }
+    return 0.0;
 }
 
 /*****************************************************************************/
@@ -1167,15 +1345,20 @@ uint64_t DcgmModuleSysmon::ReadCoreSpeed(unsigned int entityGroupId, unsigned in
     {
         auto path
             = fmt::format("{}/sys/devices/system/cpu/cpu{}/cpufreq/scaling_cur_freq", m_coreSpeedBaseDir, entityId);
-        std::ifstream file(path);
-        if (file)
+        long long coreSpeed = 0;
+        dcgmReturn_t ret    = m_sysfs.ReadInt64(path, coreSpeed);
+        if (ret == DCGM_ST_OK)
         {
-            std::string contents;
-            file >> contents;
-            uint64_t coreSpeed = std::stoi(contents);
-            return coreSpeed;
+            return static_cast<uint64_t>(coreSpeed);
+        }
+        else if (ret == DCGM_ST_NO_DATA)
+        {
+            SYSMON_LOG_IFSTREAM_ERROR("cpu frequency", path);
+        }
+        else
+        {
+            log_error("Couldn't read a cpu frequency from '{}'", path);
         }
-        SYSMON_LOG_IFSTREAM_ERROR("cpu frequency", path);
         return DCGM_INT64_BLANK;
     }
     // CPU speeds currently require dmidecode calls to retrieve, and that is
@@ -1523,7 +1706,7 @@ dcgmReturn_t DcgmModuleSysmon::GetUtilizationSampleSize(size_t &numSamples)
 {
     auto task = Enqueue(DcgmNs::make_task("GetUtilizationSampleSize", [this]() {
         ASSERT_IS_SYSMON_THREAD;
-        return m_utilizationSamples.size();
+        return m_utilizationSamples.GetSize();
     }));
 
     if (!task.has_value())
@@ -1540,7 +1723,15 @@ dcgmReturn_t DcgmModuleSysmon::AddUtilizationSample(SysmonUtilizationSample &ite
 {
     auto task = Enqueue(DcgmNs::make_task("AddUtilizationSample", [this, &item]() {
         ASSERT_IS_SYSMON_THREAD;
-        m_utilizationSamples.emplace(item.m_timestamp, item);
+        if (m_utilizationSamples.GetNumCores() != item.m_cores.size())
+        {
+            m_utilizationSamples.Reset(item.m_cores.size());
+        }
+        size_t const slot = m_utilizationSamples.Append(item.m_timestamp);
+        for (size_t core = 0; core < item.m_cores.size(); core++)
+        {
+            m_utilizationSamples.SetCore(slot, core, item.m_cores[core]);
+        }
     }));
 
     if (!task.has_value())
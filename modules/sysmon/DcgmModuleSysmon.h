@@ -17,6 +17,7 @@
 
 #include "DcgmCpuManager.h"
 #include "DcgmCpuTopology.h"
+#include "DcgmSysfsReader.h"
 #include "DcgmSystemMonitor.h"
 #include "MessageGuard.hpp"
 #include "dcgm_sysmon_structs.h"
@@ -26,11 +27,16 @@
 #include <TimeLib.hpp>
 #include <dcgm_core_structs.h>
 
+#include <array>
 #include <fstream>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 #define __DCGM_SYSMON_SKIP_HARDWARE_CHECK__ "DCGM_SKIP_SYSMON_HARDWARE_CHECK"
 
+#define SYSMON_PROC_STAT_PATH "/proc/stat"
+
 namespace DcgmNs
 {
 
@@ -61,7 +67,97 @@ public:
     std::vector<SysmonUtilizationSampleCore> m_cores;
 };
 
-typedef std::map<Timelib::TimePoint, SysmonUtilizationSample> sysmonUtilSampleMap_t;
+/*****************************************************************************/
+/*
+ * Ring of /proc/stat samples, oldest first. Each counter of a sample is an
+ * array of per-core values, so a sample is parsed into and read from
+ * preallocated storage. The ring only allocates when it grows, which stops
+ * once it holds every sample that is younger than the max sample age.
+ *
+ * Samples are addressed by slot. A slot is valid until the next call to
+ * Append(), Prune() or Reset().
+ */
+class SysmonUtilizationRing
+{
+public:
+    enum Counter
+    {
+        COUNTER_USER = 0,
+        COUNTER_NICE,
+        COUNTER_SYSTEM,
+        COUNTER_IDLE,
+        COUNTER_IRQ,
+        COUNTER_OTHER,
+        COUNTER_COUNT,
+    };
+
+    /* Drop every sample and size new samples for numCores cores. Keeps the storage when numCores doesn't change */
+    void Reset(size_t numCores);
+
+    /*
+     * Add a sample at timestamp with all counters set to 0 and return its
+     * slot. Samples must be added in time order. If timestamp is older than
+     * the latest sample, as after the clock was set back, the older samples
+     * are dropped
+     */
+    size_t Append(Timelib::TimePoint timestamp);
+
+    /* Slot of the latest sample at or before timestamp */
+    std::optional<size_t> FindAtOrBefore(Timelib::TimePoint timestamp) const;
+
+    /* Slot of the latest sample */
+    std::optional<size_t> GetLatest() const;
+
+    /* Drop the samples at or before cutOff */
+    void Prune(Timelib::TimePoint cutOff);
+
+    Timelib::TimePoint GetTimestamp(size_t slot) const
+    {
+        return m_timestamps[slot];
+    }
+
+    /* The values of counter for each core of the sample at slot */
+    unsigned long long *GetCounters(size_t slot, Counter counter)
+    {
+        return m_counters[counter].data() + slot * m_numCores;
+    }
+
+    unsigned long long const *GetCounters(size_t slot, Counter counter) const
+    {
+        return m_counters[counter].data() + slot * m_numCores;
+    }
+
+    SysmonUtilizationSampleCore GetCore(size_t slot, size_t core) const;
+    void SetCore(size_t slot, size_t core, SysmonUtilizationSampleCore const &values);
+
+    size_t GetNumCores() const
+    {
+        return m_numCores;
+    }
+
+    size_t GetSize() const
+    {
+        return m_size;
+    }
+
+private:
+    static constexpr size_t c_initialCapacity = 16;
+
+    size_t m_numCores = 0;
+    size_t m_capacity = 0;
+    size_t m_head     = 0; /* Slot of the oldest sample */
+    size_t m_size     = 0;
+    std::vector<Timelib::TimePoint> m_timestamps;
+    std::array<std::vector<unsigned long long>, COUNTER_COUNT> m_counters;
+
+    size_t ToSlot(size_t age) const
+    {
+        return (m_head + age) % m_capacity;
+    }
+
+    /* Double the capacity, moving the samples to the start of the storage */
+    void Grow();
+};
 
 class DcgmModuleSysmon
 
@@ -103,7 +199,11 @@ public:
      * @param rangeStr - a string representing ranges in the format \d[,-\d][,\d[-\d]]...
      */
     static dcgmReturn_t PopulateOwnedCoresBitmaskFromRangeString(dcgm_sysmon_cpu_t &cpu, const std::string &rangeStr);
-    static void PopulateOwnedCoresBitmask(dcgm_sysmon_cpu_t &cpu);
+
+    /*
+     * Same as PopulateOwnedCoresBitmaskFromRangeString(), but throws if cpuRange can't be parsed
+     */
+    static void PopulateOwnedCoresBitmask(dcgm_sysmon_cpu_t &cpu, const std::string &cpuRange);
 
 #ifndef DCGM_SYSMON_TEST // Allow sysmon tests to peek in
 private:
@@ -125,8 +225,8 @@ private:
                                                      the TryRunOnce method.  */
     DcgmCpuManager m_cpus;
     DcgmCpuTopology m_cpuTopology;
-    std::ifstream m_procStat;
-    sysmonUtilSampleMap_t m_utilizationSamples;
+    DcgmSysfsReader m_sysfs; /* Keeps /proc/stat, clock and temperature files open between samples */
+    SysmonUtilizationRing m_utilizationSamples;
     DcgmWatchTable m_watchTable; /* Table of watchers */
     DcgmSystemMonitor m_sysmon;
     std::string m_coreSpeedBaseDir;
@@ -135,6 +235,7 @@ private:
     std::thread::id m_sysmonThreadId;
 
     bool m_enabledMonitoring[SYSMON_MONITORING_SWITCH_COUNT];
+    bool m_entityStatusesPublished = false; /* Set by PublishEntityStatuses() */
     std::vector<double> m_cpuUtilization;
     std::string m_tzBaseDir;
     std::unordered_map<unsigned int, std::string> m_socketTemperatureFileMap;
@@ -147,26 +248,29 @@ private:
     dcgmReturn_t ProcessWatchFields(WatchFieldsMessage msg);
     dcgmReturn_t ProcessUnwatchFields(UnwatchFieldsMessage msg);
     dcgmReturn_t ProcessCreateFakeEntities(CreateFakeEntitiesMessage msg);
+    /* Push the status of every CPU and core to the cache manager, which then answers status checks without us */
+    void PublishEntityStatuses();
     dcgmReturn_t ProcessPauseResumeMessage(PauseResumeMessage msg);
     dcgmReturn_t ProcessClientDisconnect(dcgm_core_msg_client_disconnect_t *msg);
     dcgmReturn_t ProcessCoreMessage(dcgm_module_command_header_t *moduleCommand);
     std::chrono::system_clock::time_point ProcessTryRunOnce(bool forceRun);
-    const SysmonUtilizationSample &ReadUtilizationSample(DcgmNs::Timelib::TimePoint now);
+    /* Returns the slot of the sample at now in m_utilizationSamples, reading /proc/stat if there isn't one yet */
+    size_t ReadUtilizationSample(DcgmNs::Timelib::TimePoint now);
     dcgmReturn_t UpdateField(DcgmNs::Timelib::TimePoint now, const dcgm_field_update_info_t &updateInfo);
     void UpdateFields(timelib64_t &nextUpdateTimeUsec);
     double CalculateCoreUtilization(DcgmNs::Cpu::CoreId core,
                                     unsigned int fieldId,
-                                    const SysmonUtilizationSample &baselineSample,
-                                    const SysmonUtilizationSample &currentSample);
+                                    size_t baselineSlot,
+                                    size_t currentSlot);
     double CalculateCpuUtilization(DcgmNs::Cpu::CpuId cpu,
                                    unsigned int fieldId,
-                                   const SysmonUtilizationSample &baselineSample,
-                                   const SysmonUtilizationSample &currentSample);
+                                   size_t baselineSlot,
+                                   size_t currentSlot);
     double CalculateUtilizationForEntity(unsigned int entityGroupId,
                                          unsigned int entityId,
                                          unsigned int fieldId,
-                                         const SysmonUtilizationSample &baselineSample,
-                                         const SysmonUtilizationSample &currentSample);
+                                         size_t baselineSlot,
+                                         size_t currentSlot);
     unsigned int GetSocketFromThermalZoneFileContents(const std::string &path, const std::string &contents);
     unsigned int GetSocketIdFromThermalFile(const std::string &path);
     void PopulateTemperatureFileMap();
@@ -177,7 +281,13 @@ private:
     // Probably going to be replaced by a mechanism that relies on the watch table
     dcgmReturn_t EnableMonitoring(unsigned int monitoringSwitch);
     void ProcessPruneSamples(DcgmNs::Timelib::TimePoint now);
-    dcgmReturn_t ParseProcStatCpuLine(const std::string &line, SysmonUtilizationSample &sample);
+    /* Parse a cpu<index> line of /proc/stat into the sample at slot in m_utilizationSamples */
+    dcgmReturn_t ParseProcStatCpuLine(std::string_view line, size_t slot);
+
+    /*
+     * Close the files kept open for sampling. Files that are still watched are reopened on their next sample
+     */
+    void CloseSampledFiles();
 
     /*
      * Returns the socket that the specified entity belongs to
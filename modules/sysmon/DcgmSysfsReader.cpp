@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DcgmSysfsReader.h"
+
+#include <DcgmLogging.h>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+/* Most sysfs attributes are a page at most. /proc/stat grows the buffer as needed */
+constexpr size_t SYSFS_READER_INITIAL_BUFFER_SIZE = 4096;
+
+bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+void SkipBlanks(std::string_view &str)
+{
+    while (!str.empty() && IsBlank(str.front()))
+    {
+        str.remove_prefix(1);
+    }
+}
+} // namespace
+
+/*****************************************************************************/
+bool DcgmSysfsReader::ParseUnsigned(std::string_view &str, unsigned long long &value)
+{
+    value = 0;
+
+    std::string_view remaining = str;
+    SkipBlanks(remaining);
+
+    size_t digits = 0;
+    while (digits < remaining.size() && remaining[digits] >= '0' && remaining[digits] <= '9')
+    {
+        value = value * 10 + static_cast<unsigned long long>(remaining[digits] - '0');
+        digits++;
+    }
+
+    if (digits == 0)
+    {
+        value = 0;
+        return false;
+    }
+
+    remaining.remove_prefix(digits);
+    str = remaining;
+    return true;
+}
+
+/*****************************************************************************/
+bool DcgmSysfsReader::ParseSigned(std::string_view &str, long long &value)
+{
+    value = 0;
+
+    std::string_view remaining = str;
+    SkipBlanks(remaining);
+
+    bool negative = false;
+    if (!remaining.empty() && remaining.front() == '-')
+    {
+        negative = true;
+        remaining.remove_prefix(1);
+    }
+
+    unsigned long long magnitude = 0;
+    if (remaining.empty() || IsBlank(remaining.front()) || !ParseUnsigned(remaining, magnitude))
+    {
+        return false;
+    }
+
+    value = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+    str   = remaining;
+    return true;
+}
+
+/*****************************************************************************/
+int DcgmSysfsReader::GetFd(const std::string &path)
+{
+    auto it = m_files.find(path);
+    if (it != m_files.end())
+    {
+        return it->second.Get();
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    m_files.emplace(path, DcgmNs::Utils::FileHandle(fd));
+    return fd;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmSysfsReader::Read(const std::string &path, std::string_view &contents)
+{
+    contents = {};
+
+    int fd = GetFd(path);
+    if (fd < 0)
+    {
+        return DCGM_ST_NO_DATA;
+    }
+
+    if (m_buffer.empty())
+    {
+        m_buffer.resize(SYSFS_READER_INITIAL_BUFFER_SIZE);
+    }
+
+    size_t total = 0;
+    while (true)
+    {
+        ssize_t bytesRead = pread(fd, m_buffer.data() + total, m_buffer.size() - total, static_cast<off_t>(total));
+        if (bytesRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            /* The attribute may have gone away. Reopen it on the next read */
+            int savedErrno = errno;
+            Close(path);
+            errno = savedErrno;
+            return DCGM_ST_NO_DATA;
+        }
+        else if (bytesRead == 0)
+        {
+            break;
+        }
+
+        total += static_cast<size_t>(bytesRead);
+        if (total == m_buffer.size())
+        {
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+    }
+
+    contents = std::string_view(m_buffer.data(), total);
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+dcgmReturn_t DcgmSysfsReader::ReadInt64(const std::string &path, long long &value)
+{
+    value = 0;
+
+    std::string_view contents;
+    dcgmReturn_t ret = Read(path, contents);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    std::string_view remaining = contents;
+    if (ParseSigned(remaining, value))
+    {
+        SkipBlanks(remaining);
+        if (remaining.empty())
+        {
+            return DCGM_ST_OK;
+        }
+    }
+
+    log_debug("Couldn't parse an integer from '{}'; contents were: '{}'", path, contents);
+
+    /* Reopen it on the next read in case it has been replaced */
+    Close(path);
+    value = 0;
+    return DCGM_ST_BADPARAM;
+}
+
+/*****************************************************************************/
+void DcgmSysfsReader::Close(const std::string &path)
+{
+    m_files.erase(path);
+}
+
+/*****************************************************************************/
+void DcgmSysfsReader::CloseAll()
+{
+    m_files.clear();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <DcgmUtilities.h>
+#include <dcgm_structs.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Reads small sysfs and procfs files that are sampled over and over again,
+ * like scaling_cur_freq, thermal zone temperatures, hwmon power files and
+ * /proc/stat.
+ *
+ * Each file is opened once and kept open until Close() or CloseAll(). Every
+ * read is a pread() from offset 0 into a buffer that is reused between reads,
+ * so sampling a file costs one syscall instead of an open/read/close triple.
+ * A file that is deleted and created again isn't seen until it's closed.
+ *
+ * This class is not thread safe.
+ */
+class DcgmSysfsReader
+{
+public:
+    /*************************************************************************/
+    /*
+     * Read the whole file at path. contents points into an internal buffer
+     * and is only valid until the next call to this object.
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NO_DATA if the file couldn't be opened or read. errno is
+     *                         left as set by the failed call
+     */
+    dcgmReturn_t Read(const std::string &path, std::string_view &contents);
+
+    /*************************************************************************/
+    /*
+     * Read the file at path and parse it as a single integer. A file that
+     * doesn't parse is closed so that the next read opens it again.
+     *
+     * Returns DCGM_ST_OK on success
+     *         DCGM_ST_NO_DATA if the file couldn't be opened or read
+     *         DCGM_ST_BADPARAM if the contents aren't an integer
+     */
+    dcgmReturn_t ReadInt64(const std::string &path, long long &value);
+
+    /*************************************************************************/
+    /*
+     * Close the file at path. The next read of path opens it again
+     */
+    void Close(const std::string &path);
+
+    /*************************************************************************/
+    /*
+     * Close every open file
+     */
+    void CloseAll();
+
+    /*************************************************************************/
+    /* Number of files that are currently open */
+    size_t GetOpenCount() const
+    {
+        return m_files.size();
+    }
+
+    /*************************************************************************/
+    /*
+     * Parse the unsigned decimal number at the start of str, skipping leading
+     * blanks. On success, str is advanced past the number.
+     *
+     * Returns true if a number was parsed, false otherwise. value is 0 if
+     * nothing was parsed
+     */
+    static bool ParseUnsigned(std::string_view &str, unsigned long long &value);
+
+    /*************************************************************************/
+    /*
+     * Parse the optionally negative decimal number at the start of str.
+     * See ParseUnsigned()
+     */
+    static bool ParseSigned(std::string_view &str, long long &value);
+
+private:
+    std::unordered_map<std::string, DcgmNs::Utils::FileHandle> m_files; /* Open files by path */
+    std::vector<char> m_buffer;                                          /* Reused by every read */
+
+    /*************************************************************************/
+    /*
+     * Returns the open fd for path, opening it if needed. -1 if it can't be opened
+     */
+    int GetFd(const std::string &path);
+};
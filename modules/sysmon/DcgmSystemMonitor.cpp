@@ -174,30 +174,29 @@ void DcgmSystemMonitor::PopulateSocketPowerMap(const std::string &baseDir)
 
 double DcgmSystemMonitor::GetPowerValueFromFile(const std::string &path)
 {
-    std::ifstream file(path);
     static const double ONE_MILLION = 1000000.0;
 
-    if (file)
+    long long usage  = 0;
+    dcgmReturn_t ret = m_powerFiles.ReadInt64(path, usage);
+    if (ret == DCGM_ST_OK)
     {
-        std::string contents;
-        file >> contents;
-        try
-        {
-            // The power files are in microwatts
-            unsigned long long usage = std::stoll(contents);
-            return static_cast<double>(usage) / ONE_MILLION;
-        }
-        catch (...)
-        {
-            log_error("Couldn't read a number from the power usage file '{}'; contents were: '{}'", path, contents);
-            return DCGM_FP64_BLANK;
-        }
+        // The power files are in microwatts
+        return static_cast<double>(usage) / ONE_MILLION;
     }
-    else
+    else if (ret == DCGM_ST_NO_DATA)
     {
         SYSMON_LOG_IFSTREAM_ERROR(path, "CPU Power info file");
-        return DCGM_FP64_BLANK;
     }
+    else
+    {
+        log_error("Couldn't read a number from the power usage file '{}'", path);
+    }
+    return DCGM_FP64_BLANK;
+}
+
+void DcgmSystemMonitor::ClosePowerFiles()
+{
+    m_powerFiles.CloseAll();
 }
 
 dcgmReturn_t DcgmSystemMonitor::GetCurrentCPUPowerUsage(unsigned int socketId, double &usage)
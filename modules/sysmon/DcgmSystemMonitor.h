@@ -16,6 +16,7 @@
 #pragma once
 
 #include "CpuHelpers.h"
+#include "DcgmSysfsReader.h"
 #include <unordered_map>
 
 #include <dcgm_structs.h>
@@ -86,6 +87,12 @@ public:
      */
     dcgmReturn_t GetCurrentPowerCap(unsigned int socketId, double &cap);
 
+    /*************************************************************************/
+    /*
+     * Closes the power files that are kept open between samples
+     */
+    void ClosePowerFiles();
+
     /*************************************************************************/
     /*
      * Reads the entire file and returns the contents
@@ -119,6 +126,7 @@ private:
     std::unordered_map<unsigned int, std::string> m_moduleSocketToPowerUsagePath;
     std::unordered_map<unsigned int, std::string> m_sysioSocketToPowerUsagePath;
     std::unordered_map<unsigned int, std::string> m_socketToPowerCapPath;
+    DcgmSysfsReader m_powerFiles; /* Keeps the power files in the maps above open between samples */
     CpuHelpers cpuHelpers;
 
     /*************************************************************************/
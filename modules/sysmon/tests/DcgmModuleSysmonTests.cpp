@@ -144,45 +144,46 @@ TEST_CASE("DcgmModuleSysmon::PopulateOwnedCoresBitmaskFromRangeString")
 
 TEST_CASE("DcgmModuleSysmon::ParseProcStatCpuLine")
 {
+    using namespace DcgmNs::Timelib;
+
     REQUIRE_FALSE(SetTestEnv());
 
     DcgmModuleSysmon sysmon(g_coreCallbacks);
     sysmon.m_cpus.AddFakeCpu(); // Make sure 0 is a valid CPU
 
-    SysmonUtilizationSample sample = {};
+    auto &samples = sysmon.m_utilizationSamples;
+    size_t slot   = samples.Append(Now());
     // Not enough room
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 25", sample) == DCGM_ST_BADPARAM);
-
-    sample.m_cores.resize(12);
-
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 bad line", sample) == DCGM_ST_BADPARAM);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 bad line with enough tokens for checking", sample) == DCGM_ST_BADPARAM);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 bad", sample) == DCGM_ST_BADPARAM);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 badusertime 5 6 76", sample) == DCGM_ST_BADPARAM);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 25 0 8", sample) == DCGM_ST_OK);
-    CHECK(sample.m_cores[0].m_user == 75);
-    CHECK(sample.m_cores[0].m_nice == 5);
-    CHECK(sample.m_cores[0].m_system == 6);
-    CHECK(sample.m_cores[0].m_idle == 25);
-    CHECK(sample.m_cores[0].m_irq == 8);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 25", slot) == DCGM_ST_BADPARAM);
+
+    samples.Reset(12);
+    slot = samples.Append(Now());
+
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 bad line", slot) == DCGM_ST_BADPARAM);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 bad line with enough tokens for checking", slot) == DCGM_ST_BADPARAM);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 bad", slot) == DCGM_ST_BADPARAM);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 badusertime 5 6 76", slot) == DCGM_ST_BADPARAM);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 75 5 6 25 0 8", slot) == DCGM_ST_OK);
+    CHECK(samples.GetCore(slot, 0).m_user == 75);
+    CHECK(samples.GetCore(slot, 0).m_nice == 5);
+    CHECK(samples.GetCore(slot, 0).m_system == 6);
+    CHECK(samples.GetCore(slot, 0).m_idle == 25);
+    CHECK(samples.GetCore(slot, 0).m_irq == 8);
+    CHECK(samples.GetCounters(slot, SysmonUtilizationRing::COUNTER_USER)[0] == 75);
 
     // Some lines from my system should pass
-    CHECK(sysmon.ParseProcStatCpuLine("cpu0 9733046 9991 2371910 659811695 177306 0 8925 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu1 9772560 8585 2085158 660512731 161268 0 2882 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu2 11007090 10098 2076304 659320474 148554 0 1324 0 0 0", sample)
-          == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu3 11113132 10638 2004824 659242757 134281 0 797 0 0 0", sample)
-          == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu4 8031834 7531 2880138 660798436 113679 0 583 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu5 9078527 7740 2196453 660871019 132242 0 460 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu6 9460076 7303 2144416 660593573 108288 0 469 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu7 8886171 5701 2491062 660719039 107810 0 540 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu8 9981141 8746 2026270 660452649 104743 0 514 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu9 9197158 8551 2146646 661044381 102656 0 375 0 0 0", sample) == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu10 8317451 9040 1924201 661743503 425237 0 23118 0 0 0", sample)
-          == DCGM_ST_OK);
-    CHECK(sysmon.ParseProcStatCpuLine("cpu11 8233975 7082 2741281 660626374 273765 0 78044 0 0 0", sample)
-          == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu0 9733046 9991 2371910 659811695 177306 0 8925 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu1 9772560 8585 2085158 660512731 161268 0 2882 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu2 11007090 10098 2076304 659320474 148554 0 1324 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu3 11113132 10638 2004824 659242757 134281 0 797 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu4 8031834 7531 2880138 660798436 113679 0 583 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu5 9078527 7740 2196453 660871019 132242 0 460 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu6 9460076 7303 2144416 660593573 108288 0 469 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu7 8886171 5701 2491062 660719039 107810 0 540 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu8 9981141 8746 2026270 660452649 104743 0 514 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu9 9197158 8551 2146646 661044381 102656 0 375 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu10 8317451 9040 1924201 661743503 425237 0 23118 0 0 0", slot) == DCGM_ST_OK);
+    CHECK(sysmon.ParseProcStatCpuLine("cpu11 8233975 7082 2741281 660626374 273765 0 78044 0 0 0", slot) == DCGM_ST_OK);
     REQUIRE_FALSE(UnsetTestEnv());
 }
 
@@ -380,36 +381,34 @@ TEST_CASE("DcgmModuleSysmon maxSampleAge")
 
 TEST_CASE("DcgmModuleSysmon::CalculateCoreUtilization")
 {
+    using namespace DcgmNs::Timelib;
+
     REQUIRE_FALSE(SetTestEnv());
     DcgmModuleSysmon sysmon(g_coreCallbacks);
 
     unsigned int numCores = 2;
     CoreId core           = CoreId { 0 };
 
-    double user = 1, nice = 2, system = 3, idle = 4, irq = 5, other = 6;
-
-    SysmonUtilizationSample baselineSample;
-    baselineSample.m_cores.resize(numCores);
-    baselineSample.m_cores[0].m_user   = user;
-    baselineSample.m_cores[0].m_nice   = nice;
-    baselineSample.m_cores[0].m_system = system;
-    baselineSample.m_cores[0].m_idle   = idle;
-    baselineSample.m_cores[0].m_irq    = irq;
-    baselineSample.m_cores[0].m_other  = other;
-
-    SysmonUtilizationSample currentSample;
-    currentSample.m_cores.resize(numCores);
-    currentSample.m_cores[0].m_user   = baselineSample.m_cores[0].m_user + user;
-    currentSample.m_cores[0].m_nice   = baselineSample.m_cores[0].m_nice + nice;
-    currentSample.m_cores[0].m_system = baselineSample.m_cores[0].m_system + system;
-    currentSample.m_cores[0].m_idle   = baselineSample.m_cores[0].m_idle + idle;
-    currentSample.m_cores[0].m_irq    = baselineSample.m_cores[0].m_irq + irq;
-    currentSample.m_cores[0].m_other  = baselineSample.m_cores[0].m_other + other;
+    unsigned long long user = 1, nice = 2, system = 3, idle = 4, irq = 5, other = 6;
+
+    auto &samples = sysmon.m_utilizationSamples;
+    samples.Reset(numCores);
+    TimePoint const now = Now();
+
+    size_t const baselineSample = samples.Append(now);
+    samples.SetCore(baselineSample, 0, { user, nice, system, idle, irq, other });
+
+    size_t const currentSample = samples.Append(now + std::chrono::seconds(1));
+    samples.SetCore(currentSample, 0, { 2 * user, 2 * nice, 2 * system, 2 * idle, 2 * irq, 2 * other });
 
     double activeCycles = user + nice + system + irq + other;
     double totalCycles  = activeCycles + idle;
-    CHECK(totalCycles == baselineSample.m_cores[0].GetTotal());
-    CHECK(activeCycles == baselineSample.m_cores[0].GetActive());
+    CHECK(totalCycles == samples.GetCore(baselineSample, 0).GetTotal());
+    CHECK(activeCycles == samples.GetCore(baselineSample, 0).GetActive());
+
+    // Invalid core
+    CoreId const invalidCore = CoreId { numCores };
+    CHECK(-1 == sysmon.CalculateCoreUtilization(invalidCore, DCGM_FI_DEV_CPU_UTIL_USER, baselineSample, currentSample));
 
     // No change in denominator -> error
     CHECK(-1 == sysmon.CalculateCoreUtilization(core, DCGM_FI_DEV_CPU_UTIL_USER, baselineSample, baselineSample));
@@ -428,6 +427,54 @@ TEST_CASE("DcgmModuleSysmon::CalculateCoreUtilization")
     REQUIRE_FALSE(UnsetTestEnv());
 }
 
+TEST_CASE("SysmonUtilizationRing")
+{
+    using namespace DcgmNs::Timelib;
+    using namespace std::chrono;
+
+    SysmonUtilizationRing ring;
+    ring.Reset(4);
+    CHECK_FALSE(ring.GetLatest().has_value());
+
+    TimePoint const start = Now();
+
+    // Enough samples to grow the ring, then wrap around it after pruning
+    for (unsigned long long i = 0; i < 40; i++)
+    {
+        size_t const slot = ring.Append(start + seconds(i));
+        CHECK(ring.GetCounters(slot, SysmonUtilizationRing::COUNTER_IDLE)[3] == 0);
+        ring.SetCore(slot, 3, { i, 0, 0, 100 * i, 0, 0 });
+    }
+    CHECK(ring.GetSize() == 40);
+
+    ring.Prune(start + seconds(29));
+    CHECK(ring.GetSize() == 10);
+    for (unsigned long long i = 40; i < 80; i++)
+    {
+        ring.SetCore(ring.Append(start + seconds(i)), 3, { i, 0, 0, 100 * i, 0, 0 });
+    }
+    REQUIRE(ring.GetSize() == 50);
+
+    CHECK_FALSE(ring.FindAtOrBefore(start + seconds(29)).has_value());
+    auto slot = ring.FindAtOrBefore(start + milliseconds(70500));
+    REQUIRE(slot.has_value());
+    CHECK(ring.GetTimestamp(*slot) == start + seconds(70));
+    CHECK(ring.GetCore(*slot, 3).m_user == 70);
+    CHECK(ring.GetCore(*slot, 3).m_idle == 7000);
+
+    slot = ring.GetLatest();
+    REQUIRE(slot.has_value());
+    CHECK(ring.GetCore(*slot, 3).m_user == 79);
+
+    // A sample older than the latest one, as after the clock was set back, drops the newer ones
+    slot = ring.Append(start);
+    CHECK(ring.GetSize() == 1);
+    CHECK(ring.GetLatest() == slot);
+
+    ring.Prune(start);
+    CHECK(ring.GetSize() == 0);
+}
+
 static int makeCpuFreqEntry(const std::string &baseDir, const int cpuIndex, const int value)
 {
     std::string cpuDir = fmt::format("{}/sys/devices/system/cpu/cpu{}", baseDir, cpuIndex);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <DcgmSysfsReader.h>
+#include <tests/DcgmSysmonTestUtils.h>
+
+TEST_CASE("DcgmSysfsReader::ParseUnsigned")
+{
+    std::string_view str("  42 7\n");
+    unsigned long long value = 0;
+
+    CHECK(DcgmSysfsReader::ParseUnsigned(str, value));
+    CHECK(value == 42);
+    CHECK(DcgmSysfsReader::ParseUnsigned(str, value));
+    CHECK(value == 7);
+    CHECK(!DcgmSysfsReader::ParseUnsigned(str, value));
+    CHECK(value == 0);
+    CHECK(str == "\n");
+
+    str = "bob";
+    CHECK(!DcgmSysfsReader::ParseUnsigned(str, value));
+    CHECK(str == "bob");
+
+    str = "18446744073709551615";
+    CHECK(DcgmSysfsReader::ParseUnsigned(str, value));
+    CHECK(value == 18446744073709551615ULL);
+
+    long long signedValue = 0;
+    str                   = "-4500\n";
+    CHECK(DcgmSysfsReader::ParseSigned(str, signedValue));
+    CHECK(signedValue == -4500);
+    str = "- 4500";
+    CHECK(!DcgmSysfsReader::ParseSigned(str, signedValue));
+    str = "-";
+    CHECK(!DcgmSysfsReader::ParseSigned(str, signedValue));
+}
+
+TEST_CASE("DcgmSysfsReader::ReadInt64")
+{
+    DcgmSysfsReader reader;
+    std::string path("Kaladin");
+    long long value = 0;
+
+    WRITE_VALUE_TO_FILE_CHECKED(path, "2100000");
+    CHECK(reader.ReadInt64(path, value) == DCGM_ST_OK);
+    CHECK(value == 2100000);
+    CHECK(reader.GetOpenCount() == 1);
+
+    // Rewriting the file in place is seen through the open fd
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "3400000\n";
+    }
+    CHECK(reader.ReadInt64(path, value) == DCGM_ST_OK);
+    CHECK(value == 3400000);
+    CHECK(reader.GetOpenCount() == 1);
+
+    // Replacing the file isn't seen until it's closed
+    WRITE_VALUE_TO_FILE_CHECKED(path, "Syl");
+    CHECK(reader.ReadInt64(path, value) == DCGM_ST_OK);
+    CHECK(value == 3400000);
+    reader.Close(path);
+    CHECK(reader.GetOpenCount() == 0);
+    CHECK(reader.ReadInt64(path, value) == DCGM_ST_BADPARAM);
+    CHECK(reader.GetOpenCount() == 0);
+
+    REMOVE_CHECKED(path.c_str());
+    CHECK(reader.ReadInt64(path, value) == DCGM_ST_NO_DATA);
+    CHECK(reader.GetOpenCount() == 0);
+
+    WRITE_VALUE_TO_FILE_CHECKED(path, "-12");
+    CHECK(reader.ReadInt64(path, value) == DCGM_ST_OK);
+    CHECK(value == -12);
+
+    reader.CloseAll();
+    CHECK(reader.GetOpenCount() == 0);
+    REMOVE_CHECKED(path.c_str());
+}
+
+TEST_CASE("DcgmSysfsReader::Read grows past the initial buffer")
+{
+    DcgmSysfsReader reader;
+    std::string path("Shallan");
+    std::string contents(20000, 'x');
+
+    WRITE_VALUE_TO_FILE_CHECKED(path, contents);
+
+    std::string_view readBack;
+    CHECK(reader.Read(path, readBack) == DCGM_ST_OK);
+    CHECK(readBack == contents);
+
+    REMOVE_CHECKED(path.c_str());
+}
@@ -98,8 +98,12 @@ TEST_CASE("DcgmSystemMonitor::GetPowerValueFromFile")
     // The value should be converted from microwatts to watts
     CHECK(val == 26.1);
 
+    // Power files stay open between reads, so a replaced file is only seen once they're closed
     WRITE_VALUE_TO_FILE_CHECKED(path, "Naomi");
     val = dsm.GetPowerValueFromFile(path);
+    CHECK(val == 26.1);
+    dsm.ClosePowerFiles();
+    val = dsm.GetPowerValueFromFile(path);
     CHECK(DCGM_FP64_IS_BLANK(val));
 
     // Delete the file
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FleetAggregator.h"
+
+#include <dcgm_agent.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+/* How long the host engines keep the subscribed values. They're only read as they're pushed */
+constexpr double SUBSCRIPTION_KEEP_AGE = 30.0;
+
+std::int64_t UsecSince1970()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+/*****************************************************************************/
+FleetAggregator::FleetAggregator(std::vector<AggregatorNode> const &nodes,
+                                 FleetAggregatorOptions const &options,
+                                 FleetRollups &rollups)
+    : m_nodes(nodes)
+    , m_options(options)
+    , m_rollups(rollups)
+{
+    m_nodeStates.reserve(m_nodes.size());
+    for (unsigned int i = 0; i < m_nodes.size(); i++)
+    {
+        auto node       = std::make_unique<Node>();
+        node->node      = &m_nodes[i];
+        node->rollups   = &m_rollups;
+        node->nodeIndex = i;
+        m_nodeStates.push_back(std::move(node));
+    }
+}
+
+/*****************************************************************************/
+FleetAggregator::~FleetAggregator()
+{
+    for (auto &node : m_nodeStates)
+    {
+        Disconnect(*node);
+    }
+}
+
+/*****************************************************************************/
+int FleetAggregator::OnValues(dcgm_field_entity_group_t /* entityGroupId */,
+                              dcgm_field_eid_t /* entityId */,
+                              dcgmFieldValue_v1 *values,
+                              int numValues,
+                              void *userData)
+{
+    auto const *node = static_cast<Node const *>(userData);
+    node->rollups->AddValues(node->nodeIndex, values, numValues, UsecSince1970());
+    return 0;
+}
+
+/*****************************************************************************/
+dcgmReturn_t FleetAggregator::Connect(Node &node)
+{
+    dcgmConnectV2Params_t connectParams {};
+    connectParams.version   = dcgmConnectV2Params_version;
+    connectParams.timeoutMs = m_options.connectTimeoutMs;
+
+    dcgmHandle_t handle = 0;
+    dcgmReturn_t ret    = dcgmConnect_v2(node.node->address.c_str(), &connectParams, &handle);
+    if (ret != DCGM_ST_OK)
+    {
+        return ret;
+    }
+
+    /* Named after the process so that aggregators sharing a node don't collide */
+    std::string const fieldGroupName = fmt::format("dcgm_aggregator_{}", getpid());
+    std::vector<unsigned short> fieldIds(m_options.fieldIds);
+    dcgmFieldGrp_t fieldGroupId = 0;
+
+    ret = dcgmFieldGroupCreate(handle, fieldIds.size(), fieldIds.data(), fieldGroupName.c_str(), &fieldGroupId);
+    if (ret == DCGM_ST_OK)
+    {
+        ret = dcgmFieldValueSubscribe(handle,
+                                      DCGM_GROUP_ALL_GPUS,
+                                      fieldGroupId,
+                                      m_options.updateIntervalUsec,
+                                      SUBSCRIPTION_KEEP_AGE,
+                                      0,
+                                      OnValues,
+                                      &node);
+    }
+    if (ret == DCGM_ST_OK)
+    {
+        ret = dcgmHealthSet(handle, DCGM_GROUP_ALL_GPUS, DCGM_HEALTH_WATCH_ALL);
+    }
+
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "Unable to set up {}: {}\n", node.node->address, errorString(ret));
+        dcgmDisconnect(handle);
+        return ret;
+    }
+
+    node.handle = handle;
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+void FleetAggregator::Disconnect(Node &node)
+{
+    if (node.handle != 0)
+    {
+        /* Subscriptions and the field group go away with the connection */
+        dcgmDisconnect(node.handle);
+        node.handle = 0;
+    }
+}
+
+/*****************************************************************************/
+void FleetAggregator::CheckNode(Node &node)
+{
+    if (node.handle == 0 && Connect(node) != DCGM_ST_OK)
+    {
+        m_rollups.SetNodeHealth(node.nodeIndex, NodeHealthState::Unreachable, 0);
+        return;
+    }
+
+    auto response     = std::make_unique<dcgmHealthResponse_t>();
+    response->version = dcgmHealthResponse_version;
+
+    dcgmReturn_t ret = dcgmHealthCheck(node.handle, DCGM_GROUP_ALL_GPUS, response.get());
+    if (ret == DCGM_ST_CONNECTION_NOT_VALID)
+    {
+        /* Reconnected on the next check */
+        Disconnect(node);
+        m_rollups.SetNodeHealth(node.nodeIndex, NodeHealthState::Unreachable, 0);
+        return;
+    }
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "Health check of {} failed: {}\n", node.node->address, errorString(ret));
+        m_rollups.SetNodeHealth(node.nodeIndex, NodeHealthState::Unknown, 0);
+        return;
+    }
+
+    NodeHealthState state;
+    switch (response->overallHealth)
+    {
+        case DCGM_HEALTH_RESULT_PASS:
+            state = NodeHealthState::Pass;
+            break;
+        case DCGM_HEALTH_RESULT_WARN:
+            state = NodeHealthState::Warn;
+            break;
+        default:
+            state = NodeHealthState::Fail;
+            break;
+    }
+    m_rollups.SetNodeHealth(node.nodeIndex, state, response->incidentCount);
+}
+
+/*****************************************************************************/
+void FleetAggregator::CheckAllNodes()
+{
+    std::atomic<size_t> nextNode { 0 };
+    auto worker = [this, &nextNode] {
+        for (size_t i = nextNode++; i < m_nodeStates.size(); i = nextNode++)
+        {
+            CheckNode(*m_nodeStates[i]);
+        }
+    };
+
+    size_t const numThreads = std::min<size_t>(std::max(m_options.maxParallel, 1u), m_nodeStates.size());
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+/*****************************************************************************/
+void FleetAggregator::Run()
+{
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+
+    while (!m_stop)
+    {
+        lock.unlock();
+        CheckAllNodes();
+        lock.lock();
+
+        m_stopCondition.wait_for(lock, std::chrono::seconds(m_options.healthIntervalSec), [this] { return m_stop; });
+    }
+}
+
+/*****************************************************************************/
+void FleetAggregator::Stop()
+{
+    std::lock_guard<std::mutex> lock(m_stopMutex);
+    m_stop = true;
+    m_stopCondition.notify_all();
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "FleetRollups.h"
+
+#include <dcgm_structs.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*****************************************************************************/
+struct FleetAggregatorOptions
+{
+    std::vector<unsigned short> fieldIds; /* Fields to subscribe to on every node */
+    long long updateIntervalUsec;         /* Update interval of the subscribed fields */
+    unsigned int healthIntervalSec;       /* How often to check health and reconnect lost nodes */
+    unsigned int connectTimeoutMs;        /* dcgmConnect_v2 timeout */
+    unsigned int maxParallel;             /* Nodes connected to or checked at once */
+};
+
+/*****************************************************************************/
+/*
+ * Keeps a connection to the host engine of every node and feeds FleetRollups.
+ *
+ * Each node's connection subscribes to the fields with
+ * dcgmFieldValueSubscribe, so values are pushed by the host engines as they
+ * update rather than polled. All connections share the DCGM client's
+ * connection thread. Every health interval, the nodes are health checked and
+ * lost connections are reopened, maxParallel nodes at a time.
+ */
+class FleetAggregator
+{
+public:
+    FleetAggregator(std::vector<AggregatorNode> const &nodes,
+                    FleetAggregatorOptions const &options,
+                    FleetRollups &rollups);
+    ~FleetAggregator();
+
+    /*************************************************************************/
+    /* Connect to and health check the nodes until Stop() is called */
+    void Run();
+
+    /*************************************************************************/
+    /* Make Run() return. May be called from any thread */
+    void Stop();
+
+private:
+    struct Node
+    {
+        AggregatorNode const *node = nullptr;
+        FleetRollups *rollups      = nullptr; /* Passed to the subscription callback with nodeIndex */
+        unsigned int nodeIndex     = 0;
+        dcgmHandle_t handle        = 0;       /* 0 = not connected */
+    };
+
+    std::vector<AggregatorNode> const &m_nodes;
+    FleetAggregatorOptions const m_options;
+    FleetRollups &m_rollups;
+
+    /* unique_ptr so that the addresses passed to the subscription callbacks don't move */
+    std::vector<std::unique_ptr<Node>> m_nodeStates;
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stop = false;
+
+    /*************************************************************************/
+    /* Connect node, subscribe to the fields and enable health watches */
+    dcgmReturn_t Connect(Node &node);
+
+    /*************************************************************************/
+    /* Reconnect node if needed, then check its health */
+    void CheckNode(Node &node);
+
+    /*************************************************************************/
+    /* Close node's connection */
+    void Disconnect(Node &node);
+
+    /*************************************************************************/
+    /* Call CheckNode() for every node, maxParallel at a time */
+    void CheckAllNodes();
+
+    /*************************************************************************/
+    static int OnValues(dcgm_field_entity_group_t entityGroupId,
+                        dcgm_field_eid_t entityId,
+                        dcgmFieldValue_v1 *values,
+                        int numValues,
+                        void *userData);
+};
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FleetRollups.h"
+
+#include <dcgm_fields.h>
+
+#include <utility>
+
+namespace
+{
+char const *HealthStateToString(NodeHealthState state)
+{
+    switch (state)
+    {
+        case NodeHealthState::Unreachable:
+            return "unreachable";
+        case NodeHealthState::Pass:
+            return "pass";
+        case NodeHealthState::Warn:
+            return "warn";
+        case NodeHealthState::Fail:
+            return "fail";
+        case NodeHealthState::Unknown:
+        default:
+            return "unknown";
+    }
+}
+
+/*****************************************************************************/
+Json::Value RollupToJson(DcgmQuantileSketch const &sketch)
+{
+    Json::Value rollup;
+    rollup["count"] = (Json::Int64)sketch.GetCount();
+
+    static std::pair<char const *, double> const quantiles[]
+        = { { "min", 0.0 }, { "p50", 0.5 }, { "p90", 0.9 }, { "p99", 0.99 }, { "max", 1.0 } };
+    for (auto const &[name, quantile] : quantiles)
+    {
+        double value = 0.0;
+        if (sketch.GetQuantile(quantile, value))
+        {
+            rollup[name] = value;
+        }
+    }
+    return rollup;
+}
+
+/*****************************************************************************/
+void CountHealth(Json::Value &counts, NodeHealthState state)
+{
+    char const *name = HealthStateToString(state);
+    counts[name]     = counts.get(name, 0).asUInt() + 1;
+}
+} // namespace
+
+/*****************************************************************************/
+FleetRollups::FleetRollups(std::vector<AggregatorNode> nodes, std::int64_t windowUsec)
+    : m_nodes(std::move(nodes))
+    , m_windowUsec(windowUsec)
+    , m_nodeStates(m_nodes.size())
+{}
+
+/*****************************************************************************/
+void FleetRollups::Rotate(Rollup &rollup, std::int64_t now) const
+{
+    if (now - rollup.currentStart < m_windowUsec)
+    {
+        return;
+    }
+
+    /* Nothing was added during the window before this one either */
+    if (now - rollup.currentStart >= 2 * m_windowUsec)
+    {
+        rollup.previous = DcgmQuantileSketch();
+    }
+    else
+    {
+        rollup.previous = std::move(rollup.current);
+    }
+
+    rollup.current      = DcgmQuantileSketch();
+    rollup.currentStart = now;
+}
+
+/*****************************************************************************/
+void FleetRollups::AddToRollup(RollupKey const &key, double value, std::int64_t now)
+{
+    Rollup &rollup = m_rollups[key];
+    Rotate(rollup, now);
+    rollup.current.Add(value);
+}
+
+/*****************************************************************************/
+void FleetRollups::AddValues(unsigned int nodeIndex, dcgmFieldValue_v1 const *values, int numValues, std::int64_t now)
+{
+    if (nodeIndex >= m_nodes.size())
+    {
+        return;
+    }
+
+    AggregatorNode const &node = m_nodes[nodeIndex];
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (int i = 0; i < numValues; i++)
+    {
+        dcgmFieldValue_v1 const &fv = values[i];
+        if (fv.status != DCGM_ST_OK)
+        {
+            continue;
+        }
+
+        double value;
+        if (fv.fieldType == DCGM_FT_DOUBLE && !DCGM_FP64_IS_BLANK(fv.value.dbl))
+        {
+            value = fv.value.dbl;
+        }
+        else if (fv.fieldType == DCGM_FT_INT64 && !DCGM_INT64_IS_BLANK(fv.value.i64))
+        {
+            value = (double)fv.value.i64;
+        }
+        else
+        {
+            continue;
+        }
+
+        AddToRollup({ Scope::Fleet, "", fv.fieldId }, value, now);
+        if (!node.rack.empty())
+        {
+            AddToRollup({ Scope::Rack, node.rack, fv.fieldId }, value, now);
+        }
+        if (!node.job.empty())
+        {
+            AddToRollup({ Scope::Job, node.job, fv.fieldId }, value, now);
+        }
+    }
+}
+
+/*****************************************************************************/
+void FleetRollups::SetNodeHealth(unsigned int nodeIndex, NodeHealthState state, unsigned int incidentCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (nodeIndex < m_nodeStates.size())
+    {
+        m_nodeStates[nodeIndex].health        = state;
+        m_nodeStates[nodeIndex].incidentCount = incidentCount;
+    }
+}
+
+/*****************************************************************************/
+Json::Value FleetRollups::GetRollups(std::int64_t now)
+{
+    Json::Value result;
+    result["window_usec"] = (Json::Int64)m_windowUsec;
+    result["fleet"]       = Json::objectValue;
+    result["racks"]       = Json::objectValue;
+    result["jobs"]        = Json::objectValue;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto &[key, rollup] : m_rollups)
+    {
+        Rotate(rollup, now);
+
+        DcgmQuantileSketch merged = rollup.previous;
+        merged.Merge(rollup.current);
+        if (merged.GetCount() == 0)
+        {
+            continue;
+        }
+
+        auto const &[scope, name, fieldId] = key;
+        std::string const fieldKey         = std::to_string(fieldId);
+        switch (scope)
+        {
+            case Scope::Fleet:
+                result["fleet"][fieldKey] = RollupToJson(merged);
+                break;
+            case Scope::Rack:
+                result["racks"][name][fieldKey] = RollupToJson(merged);
+                break;
+            case Scope::Job:
+                result["jobs"][name][fieldKey] = RollupToJson(merged);
+                break;
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+Json::Value FleetRollups::GetHealth()
+{
+    Json::Value result;
+    result["nodes"] = (Json::UInt)m_nodes.size();
+    for (NodeHealthState state : { NodeHealthState::Pass,
+                                   NodeHealthState::Warn,
+                                   NodeHealthState::Fail,
+                                   NodeHealthState::Unreachable,
+                                   NodeHealthState::Unknown })
+    {
+        result[HealthStateToString(state)] = 0;
+    }
+    result["racks"]     = Json::objectValue;
+    result["unhealthy"] = Json::arrayValue;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+        AggregatorNode const &node = m_nodes[i];
+        NodeState const &state     = m_nodeStates[i];
+
+        CountHealth(result, state.health);
+        if (!node.rack.empty())
+        {
+            CountHealth(result["racks"][node.rack], state.health);
+        }
+
+        if (state.health != NodeHealthState::Pass)
+        {
+            Json::Value unhealthy;
+            unhealthy["node"]      = node.address;
+            unhealthy["rack"]      = node.rack;
+            unhealthy["job"]       = node.job;
+            unhealthy["health"]    = HealthStateToString(state.health);
+            unhealthy["incidents"] = state.incidentCount;
+            result["unhealthy"].append(std::move(unhealthy));
+        }
+    }
+
+    return result;
+}
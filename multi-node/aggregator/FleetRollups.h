@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <DcgmQuantileSketch.h>
+#include <dcgm_structs.h>
+
+#include <json/json.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*****************************************************************************/
+/* A host engine the aggregator connects to, and the groups it's rolled up in */
+struct AggregatorNode
+{
+    std::string address; /* host[:port] passed to dcgmConnect_v2 */
+    std::string rack;    /* "" = not in a rack */
+    std::string job;     /* "" = not in a job */
+};
+
+/*****************************************************************************/
+/* Last known health of a node */
+enum class NodeHealthState
+{
+    Unknown,     /* Not checked yet */
+    Unreachable, /* Couldn't connect, or the connection was lost */
+    Pass,
+    Warn,
+    Fail,
+};
+
+/*****************************************************************************/
+/*
+ * Merged rollups of the field values and health of every node.
+ *
+ * Each value is added to the fleet rollup of its field and to the rollups of
+ * its node's rack and job. A rollup is a quantile sketch of the values added
+ * during the last one to two windows: values go into the current sketch,
+ * which becomes the previous one once it's a window old, so a report always
+ * covers at least a full window without keeping any values.
+ *
+ * All methods are thread safe. AddValues() is called from the DCGM
+ * connection thread, so it only takes a short lock.
+ */
+class FleetRollups
+{
+public:
+    /*************************************************************************/
+    /*
+     * nodes       IN: Every node. Indexes into it identify nodes in the other methods
+     * windowUsec  IN: Length of a rollup window in usec
+     */
+    FleetRollups(std::vector<AggregatorNode> nodes, std::int64_t windowUsec);
+
+    /*************************************************************************/
+    /*
+     * Add the values of one entity of node nodeIndex. Values that aren't
+     * numeric, are blank or have a bad status are ignored.
+     *
+     * now  IN: Current time in usec since 1970
+     */
+    void AddValues(unsigned int nodeIndex, dcgmFieldValue_v1 const *values, int numValues, std::int64_t now);
+
+    /*************************************************************************/
+    /*
+     * Record the health of node nodeIndex
+     *
+     * incidentCount  IN: Number of health incidents the node reported
+     */
+    void SetNodeHealth(unsigned int nodeIndex, NodeHealthState state, unsigned int incidentCount);
+
+    /*************************************************************************/
+    /*
+     * Get the rollups as JSON:
+     *   { "window_usec": N, "fleet": { "<field ID>": <rollup> },
+     *     "racks": { "<rack>": { "<field ID>": <rollup> } }, "jobs": { same as racks } }
+     * where <rollup> is { "count", "min", "p50", "p90", "p99", "max" }.
+     *
+     * now  IN: Current time in usec since 1970
+     */
+    Json::Value GetRollups(std::int64_t now);
+
+    /*************************************************************************/
+    /*
+     * Get a health summary as JSON:
+     *   { "nodes": N, "pass": N, "warn": N, "fail": N, "unreachable": N, "unknown": N,
+     *     "racks": { "<rack>": { same counts } },
+     *     "unhealthy": [ { "node", "rack", "job", "health", "incidents" } ] }
+     * where unhealthy lists every node that isn't passing.
+     */
+    Json::Value GetHealth();
+
+private:
+    struct Rollup
+    {
+        std::int64_t currentStart = 0;
+        DcgmQuantileSketch current;
+        DcgmQuantileSketch previous;
+    };
+
+    enum class Scope
+    {
+        Fleet,
+        Rack,
+        Job,
+    };
+
+    /* (scope, rack or job name, field ID). The name is "" for the fleet */
+    using RollupKey = std::tuple<Scope, std::string, unsigned short>;
+
+    struct NodeState
+    {
+        NodeHealthState health     = NodeHealthState::Unknown;
+        unsigned int incidentCount = 0;
+    };
+
+    std::vector<AggregatorNode> const m_nodes;
+    std::int64_t const m_windowUsec;
+
+    std::mutex m_mutex; /* Guards everything below */
+    std::map<RollupKey, Rollup> m_rollups;
+    std::vector<NodeState> m_nodeStates;
+
+    /*************************************************************************/
+    /* Move rollup's current sketch to previous if it's a window old. Call with m_mutex held */
+    void Rotate(Rollup &rollup, std::int64_t now) const;
+
+    /*************************************************************************/
+    /* Add value to the rollup of key. Call with m_mutex held */
+    void AddToRollup(RollupKey const &key, double value, std::int64_t now);
+};
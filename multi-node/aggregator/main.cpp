@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * dcgm-aggregator keeps a connection to the host engine of every node of a
+ * fleet and serves merged rollups of their field values and health over HTTP:
+ *
+ *   GET /rollups  Percentiles of each field over the fleet, each rack and each job
+ *   GET /health   Health counts of the fleet and each rack, and the nodes that aren't healthy
+ *
+ * The nodes are listed in a hosts file, one per line:
+ *
+ *   <host[:port]> [rack] [job]
+ *
+ * Empty lines and lines starting with # are ignored. Use - for a node that
+ * is in a job but not a rack.
+ */
+
+#include "FleetAggregator.h"
+#include "FleetRollups.h"
+
+#include <DcgmUtilities.h>
+#include <dcgm_agent.h>
+#include <dcgm_fields.h>
+
+#include <fmt/format.h>
+#include <tclap/ArgException.h>
+#include <tclap/CmdLine.h>
+#include <tclap/ValueArg.h>
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+volatile sig_atomic_t g_stop = 0;
+
+/* Longest request accepted */
+constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+/* How long a client has to send its request */
+constexpr int REQUEST_TIMEOUT_MS = 2000;
+
+/*****************************************************************************/
+struct AggregatorOptions
+{
+    std::string hostsFile;
+    std::string bindAddress;
+    unsigned short port;
+    unsigned int windowSec;
+    FleetAggregatorOptions aggregator;
+};
+
+/*****************************************************************************/
+void OnSignal(int)
+{
+    g_stop = 1;
+}
+
+/*****************************************************************************/
+/* Parse a comma-separated list of numeric field IDs like "150,155,203" */
+bool ParseFieldIds(std::string const &list, std::vector<unsigned short> &fieldIds)
+{
+    std::stringstream ss(list);
+    std::string item;
+
+    fieldIds.clear();
+    while (std::getline(ss, item, ','))
+    {
+        unsigned long fieldId;
+        try
+        {
+            fieldId = std::stoul(item);
+        }
+        catch (std::exception const &)
+        {
+            return false;
+        }
+
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (fieldMeta == nullptr || (fieldMeta->fieldType != DCGM_FT_INT64 && fieldMeta->fieldType != DCGM_FT_DOUBLE))
+        {
+            std::cerr << "Field " << item << " is unknown or not numeric" << std::endl;
+            return false;
+        }
+        fieldIds.push_back(fieldId);
+    }
+
+    return !fieldIds.empty();
+}
+
+/*****************************************************************************/
+bool ReadHostsFile(std::string const &path, std::vector<AggregatorNode> &nodes)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Unable to open " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream ss(line);
+        AggregatorNode node;
+        if (!(ss >> node.address) || node.address[0] == '#')
+        {
+            continue;
+        }
+
+        ss >> node.rack >> node.job;
+        if (node.rack == "-")
+        {
+            node.rack.clear();
+        }
+        nodes.push_back(std::move(node));
+    }
+
+    if (nodes.empty())
+    {
+        std::cerr << "No nodes in " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+bool ParseOptions(int argc, char *argv[], AggregatorOptions &options)
+{
+    using TCLAP::CmdLine;
+    using TCLAP::ValueArg;
+
+    try
+    {
+        CmdLine cmdLine("Aggregates the field values and health of many DCGM host engines", ' ', "1.0");
+
+        ValueArg<std::string> hostsArg(
+            "f", "hosts-file", "File of <host[:port]> [rack] [job] lines, one per node", true, "", "FILE", cmdLine);
+        ValueArg<std::string> fieldsArg("",
+                                        "fields",
+                                        "Comma-separated numeric field IDs to roll up",
+                                        false,
+                                        fmt::format("{},{},{},{}",
+                                                    DCGM_FI_DEV_GPU_TEMP,
+                                                    DCGM_FI_DEV_POWER_USAGE,
+                                                    DCGM_FI_DEV_GPU_UTIL,
+                                                    DCGM_FI_DEV_FB_USED),
+                                        "IDS",
+                                        cmdLine);
+        ValueArg<unsigned int> intervalArg(
+            "", "interval-ms", "Update interval of the fields in milliseconds", false, 1000, "MS", cmdLine);
+        ValueArg<unsigned int> windowArg(
+            "", "window", "Seconds of values each rollup covers, at least", false, 60, "SECONDS", cmdLine);
+        ValueArg<unsigned int> healthArg("",
+                                         "health-interval",
+                                         "Seconds between health checks, and reconnects of lost nodes",
+                                         false,
+                                         30,
+                                         "SECONDS",
+                                         cmdLine);
+        ValueArg<unsigned int> timeoutArg(
+            "", "timeout-ms", "Timeout of connecting to a node in milliseconds", false, 2000, "MS", cmdLine);
+        ValueArg<unsigned int> parallelArg(
+            "", "parallel", "Nodes to connect to or check at once", false, 64, "COUNT", cmdLine);
+        ValueArg<unsigned short> portArg("p", "port", "Port to serve rollups on", false, 5557, "PORT", cmdLine);
+        ValueArg<std::string> bindArg("b",
+                                      "bind-interface",
+                                      "IPv4 address to serve rollups on. ALL = all interfaces",
+                                      false,
+                                      "127.0.0.1",
+                                      "IP_ADDRESS",
+                                      cmdLine);
+
+        cmdLine.parse(argc, argv);
+
+        options.hostsFile                     = hostsArg.getValue();
+        options.bindAddress                   = bindArg.getValue() == "ALL" ? "" : bindArg.getValue();
+        options.port                          = portArg.getValue();
+        options.windowSec                     = windowArg.getValue();
+        options.aggregator.updateIntervalUsec = intervalArg.getValue() * 1000LL;
+        options.aggregator.healthIntervalSec  = healthArg.getValue();
+        options.aggregator.connectTimeoutMs   = timeoutArg.getValue();
+        options.aggregator.maxParallel        = parallelArg.getValue();
+
+        if (!ParseFieldIds(fieldsArg.getValue(), options.aggregator.fieldIds))
+        {
+            std::cerr << "Bad field list " << fieldsArg.getValue() << std::endl;
+            return false;
+        }
+        if (options.aggregator.updateIntervalUsec == 0 || options.windowSec == 0
+            || options.aggregator.healthIntervalSec == 0 || options.aggregator.maxParallel == 0)
+        {
+            std::cerr << "--interval-ms, --window, --health-interval and --parallel must be greater than 0"
+                      << std::endl;
+            return false;
+        }
+    }
+    catch (TCLAP::ArgException const &ex)
+    {
+        std::cerr << "Argument parsing error: " << ex.error() << " for argument " << ex.argId() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+bool SendAll(int fd, std::string_view data)
+{
+    while (!data.empty())
+    {
+        ssize_t const sent = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(sent);
+    }
+    return true;
+}
+
+/*****************************************************************************/
+void SendResponse(int fd, char const *status, char const *contentType, std::string_view body)
+{
+    std::string const header = fmt::format(
+        "HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n",
+        status,
+        contentType,
+        body.size());
+
+    SendAll(fd, header) && SendAll(fd, body);
+}
+
+/*****************************************************************************/
+void Serve(int clientFd, FleetRollups &rollups)
+{
+    std::string request;
+    char buffer[1024];
+
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+    {
+        pollfd pfd { .fd = clientFd, .events = POLLIN, .revents = 0 };
+        if (poll(&pfd, 1, REQUEST_TIMEOUT_MS) <= 0)
+        {
+            return;
+        }
+
+        ssize_t const received = recv(clientFd, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+        {
+            return;
+        }
+        request.append(buffer, received);
+    }
+
+    std::string_view const requestLine = std::string_view(request).substr(0, request.find("\r\n"));
+    if (!requestLine.starts_with("GET "))
+    {
+        SendResponse(clientFd, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+        return;
+    }
+
+    std::string_view path = requestLine.substr(4, requestLine.find(' ', 4) - 4);
+    path                  = path.substr(0, path.find('?'));
+
+    Json::Value body;
+    if (path == "/rollups")
+    {
+        using namespace std::chrono;
+        body = rollups.GetRollups(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+    }
+    else if (path == "/health")
+    {
+        body = rollups.GetHealth();
+    }
+    else
+    {
+        SendResponse(clientFd, "404 Not Found", "text/plain", "Rollups are at /rollups and /health\n");
+        return;
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    SendResponse(clientFd, "200 OK", "application/json", Json::writeString(builder, body));
+}
+
+/*****************************************************************************/
+/* Serve scrapes on listenFd until a signal stops the aggregator */
+void ServeUntilStopped(int listenFd, FleetRollups &rollups)
+{
+    while (g_stop == 0)
+    {
+        /* Wake up every second to check for a stop */
+        pollfd pfd { .fd = listenFd, .events = POLLIN, .revents = 0 };
+        if (poll(&pfd, 1, 1000) <= 0)
+        {
+            continue;
+        }
+
+        DcgmNs::Utils::FileHandle clientFd(accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC));
+        if (clientFd.Get() >= 0)
+        {
+            Serve(clientFd.Get(), rollups);
+        }
+    }
+}
+
+/*****************************************************************************/
+DcgmNs::Utils::FileHandle Listen(std::string const &bindAddress, unsigned short port)
+{
+    DcgmNs::Utils::FileHandle listenFd(socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (listenFd.Get() < 0)
+    {
+        return listenFd;
+    }
+
+    int const reuse = 1;
+    setsockopt(listenFd.Get(), SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if ((!bindAddress.empty() && inet_pton(AF_INET, bindAddress.c_str(), &addr.sin_addr) != 1)
+        || bind(listenFd.Get(), (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listenFd.Get(), 64) != 0)
+    {
+        return DcgmNs::Utils::FileHandle(-1);
+    }
+
+    return listenFd;
+}
+} // namespace
+
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    if (DcgmFieldsInit() != 0)
+    {
+        fmt::print(stderr, "DcgmFieldsInit failed\n");
+        return 1;
+    }
+
+    AggregatorOptions options;
+    std::vector<AggregatorNode> nodes;
+    if (!ParseOptions(argc, argv, options) || !ReadHostsFile(options.hostsFile, nodes))
+    {
+        return 1;
+    }
+
+    DcgmNs::Utils::FileHandle listenFd = Listen(options.bindAddress, options.port);
+    if (listenFd.Get() < 0)
+    {
+        fmt::print(stderr,
+                   "Unable to listen on {}:{}: {}\n",
+                   options.bindAddress.empty() ? "*" : options.bindAddress,
+                   options.port,
+                   strerror(errno));
+        return 1;
+    }
+
+    dcgmReturn_t ret = dcgmInit();
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "Unable to initialize DCGM: {}\n", errorString(ret));
+        return 1;
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    {
+        FleetRollups rollups(nodes, options.windowSec * 1000000LL);
+        FleetAggregator aggregator(nodes, options.aggregator, rollups);
+
+        std::thread aggregatorThread([&aggregator] { aggregator.Run(); });
+
+        fmt::print("Aggregating {} nodes. Serving rollups on {}:{}\n",
+                   nodes.size(),
+                   options.bindAddress.empty() ? "*" : options.bindAddress,
+                   options.port);
+        fflush(stdout);
+
+        ServeUntilStopped(listenFd.Get(), rollups);
+
+        aggregator.Stop();
+        aggregatorThread.join();
+    }
+
+    dcgmShutdown();
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <FleetRollups.h>
+
+#include <dcgm_fields.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::int64_t WINDOW_USEC = 1000000;
+
+dcgmFieldValue_v1 MakeValue(unsigned short fieldId, long long value)
+{
+    dcgmFieldValue_v1 fv {};
+    fv.fieldId   = fieldId;
+    fv.fieldType = DCGM_FT_INT64;
+    fv.status    = DCGM_ST_OK;
+    fv.value.i64 = value;
+    return fv;
+}
+
+std::vector<AggregatorNode> MakeNodes()
+{
+    return { { "node0", "rack0", "jobA" }, { "node1", "rack0", "" }, { "node2", "rack1", "jobA" } };
+}
+} // namespace
+
+TEST_CASE("FleetRollups: values roll up to the fleet, racks and jobs")
+{
+    FleetRollups rollups(MakeNodes(), WINDOW_USEC);
+
+    for (unsigned int node = 0; node < 3; node++)
+    {
+        dcgmFieldValue_v1 fv = MakeValue(DCGM_FI_DEV_GPU_TEMP, 10 * (node + 1));
+        rollups.AddValues(node, &fv, 1, 0);
+    }
+
+    Json::Value result = rollups.GetRollups(1);
+    std::string const field = std::to_string(DCGM_FI_DEV_GPU_TEMP);
+
+    CHECK(result["fleet"][field]["count"].asInt64() == 3);
+    CHECK(result["fleet"][field]["min"].asDouble() == Catch::Approx(10).epsilon(0.01));
+    CHECK(result["fleet"][field]["max"].asDouble() == Catch::Approx(30).epsilon(0.01));
+    CHECK(result["racks"]["rack0"][field]["count"].asInt64() == 2);
+    CHECK(result["racks"]["rack1"][field]["count"].asInt64() == 1);
+    CHECK(result["jobs"]["jobA"][field]["count"].asInt64() == 2);
+    CHECK(result["jobs"]["jobA"][field]["max"].asDouble() == Catch::Approx(30).epsilon(0.01));
+}
+
+TEST_CASE("FleetRollups: blank and failed values are ignored")
+{
+    FleetRollups rollups(MakeNodes(), WINDOW_USEC);
+
+    dcgmFieldValue_v1 values[3] = { MakeValue(DCGM_FI_DEV_GPU_TEMP, 50),
+                                    MakeValue(DCGM_FI_DEV_GPU_TEMP, DCGM_INT64_BLANK),
+                                    MakeValue(DCGM_FI_DEV_GPU_TEMP, 60) };
+    values[2].status = DCGM_ST_NOT_SUPPORTED;
+    rollups.AddValues(0, values, 3, 0);
+
+    /* Out of range nodes are ignored too */
+    rollups.AddValues(3, values, 1, 0);
+
+    Json::Value result = rollups.GetRollups(1);
+    CHECK(result["fleet"][std::to_string(DCGM_FI_DEV_GPU_TEMP)]["count"].asInt64() == 1);
+}
+
+TEST_CASE("FleetRollups: rollups cover one to two windows")
+{
+    FleetRollups rollups(MakeNodes(), WINDOW_USEC);
+    std::string const field = std::to_string(DCGM_FI_DEV_GPU_TEMP);
+
+    dcgmFieldValue_v1 fv = MakeValue(DCGM_FI_DEV_GPU_TEMP, 1);
+    rollups.AddValues(0, &fv, 1, 0);
+
+    /* A window later, the first value is in the previous sketch */
+    fv = MakeValue(DCGM_FI_DEV_GPU_TEMP, 2);
+    rollups.AddValues(0, &fv, 1, WINDOW_USEC);
+    CHECK(rollups.GetRollups(WINDOW_USEC)["fleet"][field]["count"].asInt64() == 2);
+
+    /* Another window later, only the second value is left */
+    CHECK(rollups.GetRollups(2 * WINDOW_USEC)["fleet"][field]["count"].asInt64() == 1);
+
+    /* Rollups with nothing in the last two windows aren't reported */
+    CHECK(rollups.GetRollups(4 * WINDOW_USEC)["fleet"].isMember(field) == false);
+}
+
+TEST_CASE("FleetRollups: health counts")
+{
+    FleetRollups rollups(MakeNodes(), WINDOW_USEC);
+
+    Json::Value health = rollups.GetHealth();
+    CHECK(health["nodes"].asUInt() == 3);
+    CHECK(health["unknown"].asUInt() == 3);
+    CHECK(health["unhealthy"].size() == 3);
+
+    rollups.SetNodeHealth(0, NodeHealthState::Pass, 0);
+    rollups.SetNodeHealth(1, NodeHealthState::Fail, 2);
+    rollups.SetNodeHealth(2, NodeHealthState::Unreachable, 0);
+
+    health = rollups.GetHealth();
+    CHECK(health["pass"].asUInt() == 1);
+    CHECK(health["fail"].asUInt() == 1);
+    CHECK(health["unreachable"].asUInt() == 1);
+    CHECK(health["unknown"].asUInt() == 0);
+    CHECK(health["racks"]["rack0"]["pass"].asUInt() == 1);
+    CHECK(health["racks"]["rack0"]["fail"].asUInt() == 1);
+    CHECK(health["racks"]["rack1"]["unreachable"].asUInt() == 1);
+
+    REQUIRE(health["unhealthy"].size() == 2);
+    CHECK(health["unhealthy"][0]["node"].asString() == "node1");
+    CHECK(health["unhealthy"][0]["incidents"].asUInt() == 2);
+    CHECK(health["unhealthy"][1]["health"].asString() == "unreachable");
+}
@@ -78,4 +78,10 @@ NVML_INJECTION_ENTRY_POINT(nvmlDeviceInjectFieldValue,
 
 NVML_INJECTION_ENTRY_POINT(nvmlRemoveGpu, nvmlRemoveGpu, (const char *uuid), "(%p)", uuid)
 
-NVML_INJECTION_ENTRY_POINT(nvmlRestoreGpu, nvmlRestoreGpu, (const char *uuid), "(%p)", uuid)
\ No newline at end of file
+NVML_INJECTION_ENTRY_POINT(nvmlRestoreGpu, nvmlRestoreGpu, (const char *uuid), "(%p)", uuid)
+
+NVML_INJECTION_ENTRY_POINT(nvmlReplaySetTime,
+                           nvmlReplaySetTime,
+                           (unsigned long long timeUsec),
+                           "(%llu)",
+                           timeUsec)
\ No newline at end of file
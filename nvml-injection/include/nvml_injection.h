@@ -148,6 +148,16 @@ nvmlReturn_t nvmlRemoveGpu(const char *uuid);
  */
 nvmlReturn_t nvmlRestoreGpu(const char *uuid);
 
+/*
+ * Serves the recorded values of the Replay section at a virtual time
+ * instead of the time since loading. Every later call sees the samples
+ * at or before timeUsec.
+ *
+ * @param timeUsec - time into the recording, in microseconds
+ * @return NVML_SUCCESS or NVML_* to indicate an error
+ */
+nvmlReturn_t nvmlReplaySetTime(unsigned long long timeUsec);
+
 #ifdef __cplusplus
 }
 #endif
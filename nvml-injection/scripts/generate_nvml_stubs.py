@@ -1772,6 +1772,7 @@ def write_linux_defs(output_dir, func_dict):
         'nvmlResetFuncCallCount',
         'nvmlRemoveGpu',
         'nvmlRestoreGpu',
+        'nvmlReplaySetTime',
     ]
 
     with open(linux_defs_path, 'w') as linux_defs_file:
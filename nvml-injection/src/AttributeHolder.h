@@ -15,9 +15,13 @@
  */
 #pragma once
 
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include <nvml.h>
 #include <timelib.h>
@@ -47,6 +51,15 @@ void EraseIfEmpty(T &container, const K &key)
 
 } //namespace
 
+struct StringHash : std::hash<std::string_view>
+{
+    using is_transparent = void;
+};
+
+// Attributes are looked up by key on every injected NVML call, so they are hashed rather than kept in order
+template <class V>
+using AttributeMap_t = std::unordered_map<std::string, V, StringHash, std::equal_to<>>;
+
 template <class T>
 class AttributeHolder
 {
@@ -57,11 +70,24 @@ public:
         : m_identifier(identifier)
     {}
 
+    using LazyLoader_t = std::function<void(std::string_view, AttributeHolder<T> &)>;
+
+    /*
+     * Defer loading keys until they are used. loader is called once with the data of a key, before the key is
+     * first read or changed.
+     */
+    void SetLazyAttributes(std::unordered_map<std::string, std::string_view> lazyAttributes, LazyLoader_t loader)
+    {
+        m_lazyAttributes = std::move(lazyAttributes);
+        m_lazyLoader     = std::move(loader);
+    }
+
     NvmlFuncReturn GetAttribute(const std::string &key)
     {
-        if (m_injectedAttributes.contains(key))
+        LoadLazyAttribute(key);
+        if (auto injectedIt = m_injectedAttributes.find(key); injectedIt != m_injectedAttributes.end())
         {
-            auto &[cleanAfterUsed, injectedVals] = m_injectedAttributes[key];
+            auto &[cleanAfterUsed, injectedVals] = injectedIt->second;
             if (!injectedVals.empty())
             {
                 auto ret = injectedVals.front();
@@ -70,40 +96,49 @@ public:
                     injectedVals.pop_front();
                     if (injectedVals.empty())
                     {
-                        m_injectedAttributes.erase(key);
+                        m_injectedAttributes.erase(injectedIt);
                     }
                 }
                 return ret;
             }
         }
-        if (!m_attributes[key].HasValue())
+        NvmlFuncReturn const &attribute = m_attributes[key];
+        if (!attribute.HasValue())
         {
             NVML_LOG_ERR("key [%s] is not injected, the result is meaningless", key.c_str());
         }
-        return m_attributes[key];
+        return attribute;
     }
 
     NvmlFuncReturn GetAttribute(const std::string &key, const InjectionArgument &key2)
     {
-        if (m_injectedTwoKeyAttributes.contains(key) && m_injectedTwoKeyAttributes[key].contains(key2))
+        LoadLazyAttribute(key);
+        if (auto injectedIt = m_injectedTwoKeyAttributes.find(key); injectedIt != m_injectedTwoKeyAttributes.end())
         {
-            auto &[cleanAfterUsed, injectedVals] = m_injectedTwoKeyAttributes[key][key2];
-            if (!injectedVals.empty())
+            if (auto injectedIt2 = injectedIt->second.find(key2); injectedIt2 != injectedIt->second.end())
             {
-                auto ret = injectedVals.front();
-                if (cleanAfterUsed)
+                auto &[cleanAfterUsed, injectedVals] = injectedIt2->second;
+                if (!injectedVals.empty())
                 {
-                    injectedVals.pop_front();
-                    if (injectedVals.empty())
+                    auto ret = injectedVals.front();
+                    if (cleanAfterUsed)
                     {
-                        m_injectedTwoKeyAttributes[key].erase(key2);
-                        EraseIfEmpty(m_injectedTwoKeyAttributes, key);
+                        injectedVals.pop_front();
+                        if (injectedVals.empty())
+                        {
+                            injectedIt->second.erase(injectedIt2);
+                            if (injectedIt->second.empty())
+                            {
+                                m_injectedTwoKeyAttributes.erase(injectedIt);
+                            }
+                        }
                     }
+                    return ret;
                 }
-                return ret;
             }
         }
-        if (!m_twoKeyAttributes[key][key2].HasValue())
+        NvmlFuncReturn const &attribute = m_twoKeyAttributes[key][key2];
+        if (!attribute.HasValue())
         {
             // dcgm tests nvmlDeviceGetGpuInstanceProfileInfo till it returns NVML_ERROR_INVALID_ARGUMENT
             // dcgm tries to call nvmlDeviceGetMigDeviceHandleByIndex for getting relate devices
@@ -113,11 +148,12 @@ public:
                 NVML_LOG_ERR("key [%s] is not injected, the result is meaningless", key.c_str());
             }
         }
-        return m_twoKeyAttributes[key][key2];
+        return attribute;
     }
 
     NvmlFuncReturn GetAttribute(const std::string &key, const InjectionArgument &key2, const InjectionArgument &key3)
     {
+        LoadLazyAttribute(key);
         if (m_injectedThreeKeyAttributes.contains(key) && m_injectedThreeKeyAttributes[key].contains(key2)
             && m_injectedThreeKeyAttributes[key][key2].contains(key3))
         {
@@ -155,6 +191,7 @@ public:
                                 const InjectionArgument &key3,
                                 const InjectionArgument &key4)
     {
+        LoadLazyAttribute(key);
         if (m_injectedFourKeyAttributes.contains(key) && m_injectedFourKeyAttributes[key].contains(key2)
             && m_injectedFourKeyAttributes[key][key2].contains(key3)
             && m_injectedFourKeyAttributes[key][key2][key3].contains(key4))
@@ -191,12 +228,14 @@ public:
 
     void SetAttribute(const std::string &key, const NvmlFuncReturn &val)
     {
+        LoadLazyAttribute(key);
         m_attributes[key].Clear();
         m_attributes[key] = val;
     }
 
     void SetAttribute(const std::string &key, const InjectionArgument &key2, const NvmlFuncReturn &val)
     {
+        LoadLazyAttribute(key);
         m_twoKeyAttributes[key][key2].Clear();
         m_twoKeyAttributes[key][key2] = val;
     }
@@ -206,6 +245,7 @@ public:
                       const InjectionArgument &key3,
                       const NvmlFuncReturn &val)
     {
+        LoadLazyAttribute(key);
         m_threeKeyAttributes[key][key2][key3].Clear();
         m_threeKeyAttributes[key][key2][key3] = val;
     }
@@ -216,6 +256,7 @@ public:
                       const InjectionArgument &key4,
                       const NvmlFuncReturn &val)
     {
+        LoadLazyAttribute(key);
         m_fourKeyAttributes[key][key2][key3][key4].Clear();
         m_fourKeyAttributes[key][key2][key3][key4] = val;
     }
@@ -322,6 +363,7 @@ public:
 
     nvmlReturn_t ClearAttribute(const std::string &key)
     {
+        LoadLazyAttribute(key);
         if (m_attributes[key].GetCompoundValue().IsSingleton())
         {
             m_attributes[key].Clear();
@@ -335,6 +377,7 @@ public:
 
     nvmlReturn_t ClearAttribute(const std::string &key, const InjectionArgument &key2)
     {
+        LoadLazyAttribute(key);
         if (m_twoKeyAttributes[key][key2].GetCompoundValue().IsSingleton())
         {
             m_twoKeyAttributes[key][key2].Clear();
@@ -348,6 +391,7 @@ public:
 
     nvmlReturn_t ClearAttribute(const std::string &key, const InjectionArgument &key2, const InjectionArgument &key3)
     {
+        LoadLazyAttribute(key);
         if (m_threeKeyAttributes[key][key2][key3].GetCompoundValue().IsSingleton())
         {
             m_threeKeyAttributes[key][key2][key3].Clear();
@@ -361,6 +405,7 @@ public:
 
     nvmlReturn_t ClearCompoundAttribute(const std::string &key)
     {
+        LoadLazyAttribute(key);
         if (!m_attributes[key].GetCompoundValue().IsSingleton())
         {
             m_attributes[key].Clear();
@@ -374,6 +419,7 @@ public:
 
     nvmlReturn_t ClearCompoundAttribute(const std::string &key, const InjectionArgument &key2)
     {
+        LoadLazyAttribute(key);
         if (!m_twoKeyAttributes[key][key2].GetCompoundValue().IsSingleton())
         {
             m_twoKeyAttributes[key][key2].Clear();
@@ -389,6 +435,7 @@ public:
                                         const InjectionArgument &key2,
                                         const InjectionArgument &key3)
     {
+        LoadLazyAttribute(key);
         if (!m_threeKeyAttributes[key][key2][key3].GetCompoundValue().IsSingleton())
         {
             m_threeKeyAttributes[key][key2][key3].Clear();
@@ -412,6 +459,7 @@ public:
 
     void Clear()
     {
+        m_lazyAttributes.clear();
         ResetInjectedAttribute();
         for (auto &[_, value] : m_attributes)
         {
@@ -455,13 +503,13 @@ public:
 
     nvmlFieldValue_t GetFieldValue(unsigned int nvmlFieldId)
     {
-        if (m_injectedFieldValues.count(nvmlFieldId) == 1)
+        if (auto it = m_injectedFieldValues.find(nvmlFieldId); it != m_injectedFieldValues.end())
         {
-            return m_injectedFieldValues[nvmlFieldId];
+            return it->second;
         }
-        if (m_fieldValues.count(nvmlFieldId) == 1)
+        if (auto it = m_fieldValues.find(nvmlFieldId); it != m_fieldValues.end())
         {
-            return m_fieldValues[nvmlFieldId];
+            return it->second;
         }
 
         nvmlFieldValue_t fieldValue {};
@@ -582,28 +630,26 @@ public:
 
 private:
     T m_identifier;
-    std::map<std::string, NvmlFuncReturn> m_attributes;
-    std::map<std::string, std::map<InjectionArgument, NvmlFuncReturn>> m_twoKeyAttributes;
-    std::map<std::string, std::map<InjectionArgument, std::map<InjectionArgument, NvmlFuncReturn>>>
-        m_threeKeyAttributes;
-    std::map<std::string,
-             std::map<InjectionArgument, std::map<InjectionArgument, std::map<InjectionArgument, NvmlFuncReturn>>>>
+    AttributeMap_t<NvmlFuncReturn> m_attributes;
+    AttributeMap_t<std::map<InjectionArgument, NvmlFuncReturn>> m_twoKeyAttributes;
+    AttributeMap_t<std::map<InjectionArgument, std::map<InjectionArgument, NvmlFuncReturn>>> m_threeKeyAttributes;
+    AttributeMap_t<
+        std::map<InjectionArgument, std::map<InjectionArgument, std::map<InjectionArgument, NvmlFuncReturn>>>>
         m_fourKeyAttributes;
 
-    std::map<std::string, std::tuple<bool, std::list<NvmlFuncReturn>>> m_injectedAttributes;
-    std::map<std::string, std::map<InjectionArgument, std::tuple<bool, std::list<NvmlFuncReturn>>>>
+    AttributeMap_t<std::tuple<bool, std::list<NvmlFuncReturn>>> m_injectedAttributes;
+    AttributeMap_t<std::map<InjectionArgument, std::tuple<bool, std::list<NvmlFuncReturn>>>>
         m_injectedTwoKeyAttributes;
-    std::map<std::string,
-             std::map<InjectionArgument, std::map<InjectionArgument, std::tuple<bool, std::list<NvmlFuncReturn>>>>>
+    AttributeMap_t<
+        std::map<InjectionArgument, std::map<InjectionArgument, std::tuple<bool, std::list<NvmlFuncReturn>>>>>
         m_injectedThreeKeyAttributes;
-    std::map<
-        std::string,
-        std::map<InjectionArgument,
-                 std::map<InjectionArgument, std::map<InjectionArgument, std::tuple<bool, std::list<NvmlFuncReturn>>>>>>
+    AttributeMap_t<std::map<InjectionArgument,
+                            std::map<InjectionArgument,
+                                     std::map<InjectionArgument, std::tuple<bool, std::list<NvmlFuncReturn>>>>>>
         m_injectedFourKeyAttributes;
 
-    std::map<unsigned int, nvmlFieldValue_t> m_fieldValues;
-    std::map<unsigned int, nvmlFieldValue_t> m_injectedFieldValues;
+    std::unordered_map<unsigned int, nvmlFieldValue_t> m_fieldValues;
+    std::unordered_map<unsigned int, nvmlFieldValue_t> m_injectedFieldValues;
 
     // timestamp -> nvmlProcessUtilizationSample_t
     std::multimap<unsigned long long, nvmlProcessUtilizationSample_t> m_processUtilization;
@@ -612,4 +658,25 @@ private:
     // timestamp -> [nvmlValueType_t, nvmlVgpuInstanceUtilizationSample_t]
     std::multimap<unsigned long long, std::tuple<nvmlValueType_t, nvmlVgpuInstanceUtilizationSample_t>>
         m_vgpuInstanceUtilization;
+
+    // key -> data of keys not loaded yet
+    std::unordered_map<std::string, std::string_view> m_lazyAttributes;
+    LazyLoader_t m_lazyLoader;
+
+    void LoadLazyAttribute(const std::string &key)
+    {
+        if (m_lazyAttributes.empty())
+        {
+            return;
+        }
+        auto it = m_lazyAttributes.find(key);
+        if (it == m_lazyAttributes.end())
+        {
+            return;
+        }
+        // Forget the key first. Loading it sets its attributes through this class
+        std::string_view data = it->second;
+        m_lazyAttributes.erase(it);
+        m_lazyLoader(data, *this);
+    }
 };
\ No newline at end of file
@@ -19,45 +19,107 @@
 #include "nvml_injection_structs.h"
 #include <InjectedNvml.h>
 #include <InjectionKeys.h>
+#include <NvmlInjectionSnapshot.h>
 #include <NvmlLogging.h>
 #include <NvmlReturnDeserializer.h>
 #include <TimestampedData.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <tuple>
 #include <unordered_map>
-#include <unordered_set>
 #include <yaml-cpp/node/node.h>
 
 namespace
 {
 
-bool IsDeviceFunc(const std::string &funcname, const std::vector<InjectionArgument> &args)
+InjectedFuncInfo MakeFuncInfo(std::string_view funcname)
 {
-    return (funcname.starts_with("nvmlDeviceGet") || funcname.starts_with("nvmlGpmQueryDevice")
-            || funcname == "nvmlDeviceValidateInforom")
-           && args.size() >= 1 && args[0].GetType() == INJECTION_DEVICE;
+    InjectedFuncInfo info;
+
+    if (funcname.starts_with("nvmlDeviceGet") || funcname.starts_with("nvmlGpmQueryDevice")
+        || funcname == "nvmlDeviceValidateInforom")
+    {
+        info.target = InjectedFuncTarget::Device;
+    }
+    else if (funcname.starts_with("nvmlGpuInstanceGet"))
+    {
+        info.target = InjectedFuncTarget::GpuInstance;
+    }
+    else if (funcname.starts_with("nvmlComputeInstanceGet"))
+    {
+        info.target = InjectedFuncTarget::ComputeInstance;
+    }
+    else if (funcname.starts_with("nvmlVgpuTypeGet"))
+    {
+        info.target = InjectedFuncTarget::VgpuType;
+    }
+    else if (funcname.starts_with("nvmlVgpuInstanceGet"))
+    {
+        info.target = InjectedFuncTarget::VgpuInstance;
+    }
+
+    // funcname -> return NVML_ERROR_INSUFFICIENT_SIZE when has element
+    static std::unordered_map<std::string_view, bool> const queryArraySizeFuncs {
+        { "nvmlDeviceGetSupportedVgpus", true },         { "nvmlDeviceGetActiveVgpus", true },
+        { "nvmlDeviceGetFBCSessions", false },           { "nvmlDeviceGetCreatableVgpus", true },
+        { "nvmlVgpuInstanceGetEncoderSessions", false }, { "nvmlVgpuInstanceGetFBCSessions", false },
+    };
+    static std::unordered_map<std::string_view, InjectedFuncSpecialCase> const specialCaseFuncs {
+        { "nvmlEventSetWait_v2", InjectedFuncSpecialCase::EventSetWait },
+        { "nvmlGpuInstanceGetComputeInstances", InjectedFuncSpecialCase::GpuInstanceGetComputeInstances },
+        { "nvmlDeviceGetGpuInstances", InjectedFuncSpecialCase::DeviceGetGpuInstances },
+        { "nvmlVgpuInstanceGetVmID", InjectedFuncSpecialCase::VgpuInstanceGetVmID },
+        { "nvmlDeviceGetProcessUtilization", InjectedFuncSpecialCase::DeviceGetProcessUtilization },
+        { "nvmlDeviceGetVgpuProcessUtilization", InjectedFuncSpecialCase::DeviceGetVgpuProcessUtilization },
+        { "nvmlDeviceGetVgpuUtilization", InjectedFuncSpecialCase::DeviceGetVgpuUtilization },
+        { "nvmlDeviceGetMemoryInfo", InjectedFuncSpecialCase::DeviceGetMemoryInfo },
+    };
+
+    if (auto it = queryArraySizeFuncs.find(funcname); it != queryArraySizeFuncs.end())
+    {
+        info.specialCase                  = InjectedFuncSpecialCase::QueryArraySize;
+        info.insufficientSizeWhenHasValue = it->second;
+    }
+    else if (auto it = specialCaseFuncs.find(funcname); it != specialCaseFuncs.end())
+    {
+        info.specialCase = it->second;
+    }
+
+    // dcgm may try to call the following functions for testing, using the list to avoid misleading infomation
+    info.allowNotInjected = funcname == "nvmlGpuInstanceGetComputeInstanceProfileInfo"
+                            || funcname == "nvmlDeviceGetGpuInstanceProfileInfo"
+                            || funcname == "nvmlDeviceGetMigDeviceHandleByIndex";
+
+    return info;
 }
 
-bool IsGpuInstanceFunc(const std::string &funcname, const std::vector<InjectionArgument> &args)
+bool IsDeviceFunc(InjectedFuncInfo const &funcInfo, const std::vector<InjectionArgument> &args)
 {
-    return funcname.starts_with("nvmlGpuInstanceGet") && args.size() >= 1 && args[0].GetType() == INJECTION_GPUINSTANCE;
+    return funcInfo.target == InjectedFuncTarget::Device && args.size() >= 1 && args[0].GetType() == INJECTION_DEVICE;
 }
 
-bool IsComputeInstanceFunc(const std::string &funcname, const std::vector<InjectionArgument> &args)
+bool IsGpuInstanceFunc(InjectedFuncInfo const &funcInfo, const std::vector<InjectionArgument> &args)
 {
-    return funcname.starts_with("nvmlComputeInstanceGet") && args.size() >= 1
+    return funcInfo.target == InjectedFuncTarget::GpuInstance && args.size() >= 1
+           && args[0].GetType() == INJECTION_GPUINSTANCE;
+}
+
+bool IsComputeInstanceFunc(InjectedFuncInfo const &funcInfo, const std::vector<InjectionArgument> &args)
+{
+    return funcInfo.target == InjectedFuncTarget::ComputeInstance && args.size() >= 1
            && args[0].GetType() == INJECTION_COMPUTEINSTANCE;
 }
 
-bool IsVgpuTypeFunc(const std::string &funcname, const std::vector<InjectionArgument> &args)
+bool IsVgpuTypeFunc(InjectedFuncInfo const &funcInfo, const std::vector<InjectionArgument> &args)
 {
-    return funcname.starts_with("nvmlVgpuTypeGet") && args.size() >= 1;
+    return funcInfo.target == InjectedFuncTarget::VgpuType && args.size() >= 1;
 }
 
-bool IsVgpuInstanceFunc(const std::string &funcname, const std::vector<InjectionArgument> &args)
+bool IsVgpuInstanceFunc(InjectedFuncInfo const &funcInfo, const std::vector<InjectionArgument> &args)
 {
-    return funcname.starts_with("nvmlVgpuInstanceGet") && args.size() >= 1;
+    return funcInfo.target == InjectedFuncTarget::VgpuInstance && args.size() >= 1;
 }
 
 template <typename underlyType, typename resultType>
@@ -654,61 +716,71 @@ bool InjectedNvml::FieldValuesParser(const std::string &key, const YAML::Node &n
     return true;
 }
 
+std::unordered_map<std::string, InjectedNvml::DeviceKeyParser_t> InjectedNvml::GetDeviceKeyParsers()
+{
+    // key -> value parser
+    return {
+        { INJECTION_ACTIVEVGPUS_KEY,
+          std::bind(&InjectedNvml::ActiveVgpusParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { INJECTION_GPUINSTANCES_KEY,
+          std::bind(&InjectedNvml::GpuInstancesParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { INJECTION_TOPOLOGYCOMMONANCESTOR_KEY,
+          std::bind(&InjectedNvml::TopologyCommonAncestorParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { INJECTION_TOPOLOGYNEARESTGPUS_KEY,
+          std::bind(&InjectedNvml::TopologyNearestGpuParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { "MigDeviceUUID",
+          std::bind(&InjectedNvml::MigDeviceUUIDParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { INJECTION_ONSAMEBOARD_KEY,
+          std::bind(&InjectedNvml::OnSameBoardParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { INJECTION_FIELDVALUES_KEY,
+          std::bind(&InjectedNvml::FieldValuesParser,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3) },
+        { INJECTION_MEMORYERRORCOUNTER_KEY, MemoryErrorCounterParser },
+        { INJECTION_REMAPPEDROWS_KEY, RemappedRowsParser },
+        { INJECTION_PROCESSUTILIZATION_KEY, ProcessUtilizationParser },
+        { INJECTION_VGPUPROCESSUTILIZATION_KEY, VgpuProcessUtilizationParser },
+        { INJECTION_VGPUUTILIZATION_KEY, VgpuInstanceUtilizationParser },
+    };
+}
+
 bool InjectedNvml::ParseOneDevice(const YAML::Node &device, AttributeHolder<nvmlDevice_t> &ah)
 {
     NvmlReturnDeserializer nvmlReturnDeserializer;
-    // key -> value parser
-    std::unordered_map<std::string,
-                       std::function<bool(const std::string &, const YAML::Node &, AttributeHolder<nvmlDevice_t> &)>>
-        handlers {
-            { INJECTION_ACTIVEVGPUS_KEY,
-              std::bind(&InjectedNvml::ActiveVgpusParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { INJECTION_GPUINSTANCES_KEY,
-              std::bind(&InjectedNvml::GpuInstancesParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { INJECTION_TOPOLOGYCOMMONANCESTOR_KEY,
-              std::bind(&InjectedNvml::TopologyCommonAncestorParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { INJECTION_TOPOLOGYNEARESTGPUS_KEY,
-              std::bind(&InjectedNvml::TopologyNearestGpuParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { "MigDeviceUUID",
-              std::bind(&InjectedNvml::MigDeviceUUIDParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { INJECTION_ONSAMEBOARD_KEY,
-              std::bind(&InjectedNvml::OnSameBoardParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { INJECTION_FIELDVALUES_KEY,
-              std::bind(&InjectedNvml::FieldValuesParser,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::placeholders::_3) },
-            { INJECTION_MEMORYERRORCOUNTER_KEY, MemoryErrorCounterParser },
-            { INJECTION_REMAPPEDROWS_KEY, RemappedRowsParser },
-            { INJECTION_PROCESSUTILIZATION_KEY, ProcessUtilizationParser },
-            { INJECTION_VGPUPROCESSUTILIZATION_KEY, VgpuProcessUtilizationParser },
-            { INJECTION_VGPUUTILIZATION_KEY, VgpuInstanceUtilizationParser },
-        };
+    return ParseOneDevice(device, ah, nvmlReturnDeserializer);
+}
+
+bool InjectedNvml::ParseOneDevice(const YAML::Node &device,
+                                  AttributeHolder<nvmlDevice_t> &ah,
+                                  NvmlReturnDeserializer &nvmlReturnDeserializer)
+{
+    auto handlers = GetDeviceKeyParsers();
 
     // key -> [key2 parser, value parser]
     std::unordered_map<std::string,
@@ -778,40 +850,328 @@ bool InjectedNvml::ParseDevices(const YAML::Node &devices)
         return true;
     }
 
-    for (auto iter = m_deviceCollection.begin(); iter != m_deviceCollection.end(); iter++)
+    unsigned int index = 0;
+    for (auto iter = m_deviceCollection.begin(); iter != m_deviceCollection.end(); iter++, index++)
     {
         auto &ah = *iter;
         std::string deviceUUID
             = ah.GetAttribute(INJECTION_UUID_KEY).GetCompoundValue().AsInjectionArgument().AsString();
+        std::string const &recordedUUID = GetRecordedDeviceUUID(deviceUUID);
 
-        if (!devices[deviceUUID])
+        if (!devices[recordedUUID])
+        {
+            NVML_LOG_ERR("missing UUID [%s] in device section", recordedUUID.c_str());
+            return false;
+        }
+        if (!ParseOneDevice(devices[recordedUUID], ah))
         {
-            NVML_LOG_ERR("missing UUID [%s] in device section", deviceUUID.c_str());
+            NVML_LOG_ERR("failed to parse UUID [%s] in device section", recordedUUID.c_str());
             return false;
         }
-        if (!ParseOneDevice(devices[deviceUUID], ah))
+        if (recordedUUID != deviceUUID)
+        {
+            SetSyntheticIdentifiers(ah, deviceUUID, index);
+        }
+
+        AddDeviceIdentifiers(iter);
+    }
+
+    return true;
+}
+
+bool InjectedNvml::ParseSnapshotDevices()
+{
+    auto handlers = GetDeviceKeyParsers();
+    auto loader   = [this](std::string_view yaml, AttributeHolder<nvmlDevice_t> &ah) {
+        LoadSnapshotDeviceKey(yaml, ah);
+    };
+
+    unsigned int index = 0;
+    for (auto iter = m_deviceCollection.begin(); iter != m_deviceCollection.end(); iter++, index++)
+    {
+        auto &ah = *iter;
+        std::string deviceUUID
+            = ah.GetAttribute(INJECTION_UUID_KEY).GetCompoundValue().AsInjectionArgument().AsString();
+        std::string const &recordedUUID = GetRecordedDeviceUUID(deviceUUID);
+
+        auto const *keys = m_snapshot->GetDeviceKeys(recordedUUID);
+        if (keys == nullptr)
         {
-            NVML_LOG_ERR("failed to parse UUID [%s] in device section", deviceUUID.c_str());
+            NVML_LOG_ERR("missing UUID [%s] in device section", recordedUUID.c_str());
             return false;
         }
 
-        std::string deviceSerial
-            = ah.GetAttribute(INJECTION_SERIAL_KEY).GetCompoundValue().AsInjectionArgument().AsString();
-        if (!deviceSerial.empty()) // Some GPUs do not support serial number
+        // Keys with their own parsers set up other objects, and the identifiers are needed for the lookup maps.
+        // Parse those now and the rest when they are used.
+        std::unordered_map<std::string, std::string_view> lazyKeys;
+        for (auto const &[key, yaml] : *keys)
         {
-            m_serialToDevice[deviceSerial] = iter;
+            if (handlers.contains(key) || key == INJECTION_SERIAL_KEY || key == INJECTION_PCIINFO_KEY)
+            {
+                LoadSnapshotDeviceKey(yaml, ah);
+            }
+            else
+            {
+                lazyKeys.emplace(key, yaml);
+            }
         }
-        nvmlPciInfo_t *pciInfo
-            = ah.GetAttribute(INJECTION_PCIINFO_KEY).GetCompoundValue().AsInjectionArgument().AsPciInfoPtr();
-        if (pciInfo != nullptr)
+        ah.SetLazyAttributes(std::move(lazyKeys), loader);
+        if (recordedUUID != deviceUUID)
         {
-            m_busIdToDevice[pciInfo->busId] = iter;
+            SetSyntheticIdentifiers(ah, deviceUUID, index);
         }
+
+        AddDeviceIdentifiers(iter);
+    }
+
+    return true;
+}
+
+void InjectedNvml::LoadSnapshotDeviceKey(std::string_view yaml, AttributeHolder<nvmlDevice_t> &ah)
+{
+    YAML::Node node;
+
+    try
+    {
+        node = YAML::Load(std::string(yaml));
+    }
+    catch (const std::exception &e)
+    {
+        NVML_LOG_ERR("failed to YAML load [%s], reason [%s]", std::string(yaml).c_str(), e.what());
+        return;
+    }
+
+    if (!ParseOneDevice(node, ah, *m_deserializer))
+    {
+        NVML_LOG_ERR("failed to parse [%s]", std::string(yaml).c_str());
+    }
+}
+
+void InjectedNvml::AddDeviceIdentifiers(std::list<AttributeHolder<nvmlDevice_t>>::iterator iter)
+{
+    std::string deviceSerial
+        = iter->GetAttribute(INJECTION_SERIAL_KEY).GetCompoundValue().AsInjectionArgument().AsString();
+    if (!deviceSerial.empty()) // Some GPUs do not support serial number
+    {
+        m_serialToDevice[deviceSerial] = iter;
+    }
+    // GetAttribute() returns a copy that owns the PCI info, so keep it while reading
+    auto pciInfoRet        = iter->GetAttribute(INJECTION_PCIINFO_KEY);
+    nvmlPciInfo_t *pciInfo = pciInfoRet.GetCompoundValue().AsInjectionArgument().AsPciInfoPtr();
+    if (pciInfo != nullptr)
+    {
+        m_busIdToDevice[pciInfo->busId] = iter;
     }
+}
 
+bool InjectedNvml::AddSyntheticDevices(const YAML::Node &deviceCount, YAML::Node &global)
+{
+    auto recordedUUIDs = global["DeviceOrder"].as<std::vector<std::string>>();
+    auto count         = deviceCount.as<unsigned int>();
+
+    if (recordedUUIDs.empty())
+    {
+        NVML_LOG_ERR("synthetic devices need at least one recorded device");
+        return false;
+    }
+
+    // Synthetic devices copy the recorded ones in turn
+    for (unsigned int i = recordedUUIDs.size(); i < count; i++)
+    {
+        char uuid[64];
+        snprintf(uuid, sizeof(uuid), "GPU-5e1f0000-0000-0000-0000-%012x", i);
+        global["DeviceOrder"].push_back(std::string(uuid));
+        m_syntheticDeviceSources[uuid] = recordedUUIDs[i % recordedUUIDs.size()];
+    }
+    global[INJECTION_COUNT_KEY][FunctionReturn] = static_cast<int>(NVML_SUCCESS);
+    global[INJECTION_COUNT_KEY][ReturnValue]    = std::max<std::size_t>(count, recordedUUIDs.size());
     return true;
 }
 
+std::string const &InjectedNvml::GetRecordedDeviceUUID(std::string const &uuid) const
+{
+    auto it = m_syntheticDeviceSources.find(uuid);
+    return it == m_syntheticDeviceSources.end() ? uuid : it->second;
+}
+
+void InjectedNvml::SetSyntheticIdentifiers(AttributeHolder<nvmlDevice_t> &ah,
+                                           std::string const &uuid,
+                                           unsigned int index)
+{
+    char serial[32];
+    snprintf(serial, sizeof(serial), "5e1f%09u", index);
+
+    ah.SetAttribute(INJECTION_UUID_KEY, NvmlFuncReturn(NVML_SUCCESS, uuid));
+    ah.SetAttribute(INJECTION_SERIAL_KEY, NvmlFuncReturn(NVML_SUCCESS, std::string(serial)));
+    ah.SetAttribute(INJECTION_INDEX_KEY, NvmlFuncReturn(NVML_SUCCESS, index));
+    ah.SetAttribute(INJECTION_MINORNUMBER_KEY, NvmlFuncReturn(NVML_SUCCESS, index));
+
+    // Copy the recorded PCI info with a new address. GetAttribute() returns a copy, so keep it while reading
+    auto recordedRet = ah.GetAttribute(INJECTION_PCIINFO_KEY);
+    if (!recordedRet.HasValue())
+    {
+        return;
+    }
+    nvmlPciInfo_t const *recorded = recordedRet.GetCompoundValue().AsInjectionArgument().AsPciInfoPtr();
+    auto *pciInfo                 = reinterpret_cast<nvmlPciInfo_t *>(malloc(sizeof(nvmlPciInfo_t)));
+    if (recorded == nullptr || pciInfo == nullptr)
+    {
+        free(pciInfo);
+        return;
+    }
+    *pciInfo        = *recorded;
+    pciInfo->domain = 0x5e00 + (index >> 8);
+    pciInfo->bus    = index & 0xff;
+    snprintf(pciInfo->busId,
+             sizeof(pciInfo->busId),
+             "%08X:%02X:%02X.0",
+             pciInfo->domain,
+             pciInfo->bus,
+             pciInfo->device);
+    snprintf(pciInfo->busIdLegacy,
+             sizeof(pciInfo->busIdLegacy),
+             "%04X:%02X:%02X.0",
+             pciInfo->domain,
+             pciInfo->bus,
+             pciInfo->device);
+    ah.SetAttribute(INJECTION_PCIINFO_KEY, NvmlFuncReturn(NVML_SUCCESS, InjectionArgument(pciInfo, true)));
+}
+
+bool InjectedNvml::ParseReplay(const YAML::Node &replay)
+{
+    if (!replay)
+    {
+        return true;
+    }
+
+    YAML::Node devices = replay[DEVICE];
+    double phaseOffset = replay["PhaseOffset"].as<double>(0.0);
+    m_replaySpeed      = replay["Speed"].as<double>(1.0);
+    if (m_replaySpeed <= 0.0)
+    {
+        NVML_LOG_ERR("replay speed [%f] must be positive", m_replaySpeed);
+        return false;
+    }
+
+    // Tracks of one entry in the Replay device section are shared by every device that uses it
+    std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<const ReplaySamples_t>>> entries;
+    double lastSampleTime = 0.0;
+    for (YAML::const_iterator it = devices.begin(); it != devices.end(); ++it)
+    {
+        auto &tracks = entries[it->first.as<std::string>()];
+        for (YAML::const_iterator trackIt = it->second.begin(); trackIt != it->second.end(); ++trackIt)
+        {
+            auto key     = trackIt->first.as<std::string>();
+            auto samples = std::make_shared<ReplaySamples_t>();
+            for (auto const &sample : trackIt->second)
+            {
+                YAML::Node value;
+                value[key] = sample["Value"];
+                samples->emplace_back(sample["Time"].as<double>(), value);
+            }
+            std::stable_sort(samples->begin(), samples->end(), [](auto const &a, auto const &b) {
+                return a.first < b.first;
+            });
+            if (!samples->empty())
+            {
+                lastSampleTime = std::max(lastSampleTime, samples->back().first);
+            }
+            tracks[key] = std::move(samples);
+        }
+    }
+
+    m_replayPeriod = replay["Loop"].as<bool>(true) ? replay["Duration"].as<double>(lastSampleTime) : 0.0;
+
+    // A device uses the entry of its UUID, of the recorded device it copies, or "*"
+    for (unsigned int index = 0; index < m_indexToDevice.size(); index++)
+    {
+        auto &ah = *m_indexToDevice[index];
+        std::string deviceUUID
+            = ah.GetAttribute(INJECTION_UUID_KEY).GetCompoundValue().AsInjectionArgument().AsString();
+
+        auto entryIt = entries.find(deviceUUID);
+        if (entryIt == entries.end())
+        {
+            entryIt = entries.find(GetRecordedDeviceUUID(deviceUUID));
+        }
+        if (entryIt == entries.end())
+        {
+            entryIt = entries.find("*");
+        }
+        if (entryIt == entries.end())
+        {
+            continue;
+        }
+
+        auto &deviceTracks = m_replayTracks[ah.GetIdentifier()];
+        for (auto const &[key, samples] : entryIt->second)
+        {
+            deviceTracks[key] = ReplayTrack { samples, phaseOffset * index };
+        }
+    }
+
+    m_replayStart = std::chrono::steady_clock::now();
+    return true;
+}
+
+double InjectedNvml::GetReplayTime() const
+{
+    if (m_replayTime)
+    {
+        return *m_replayTime;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_replayStart;
+    return elapsed.count() * m_replaySpeed;
+}
+
+void InjectedNvml::ApplyReplay(nvmlDevice_t device, const std::string &key)
+{
+    auto tracksIt = m_replayTracks.find(device);
+    if (tracksIt == m_replayTracks.end() || !m_devices.contains(device))
+    {
+        return;
+    }
+    auto trackIt = tracksIt->second.find(key);
+    if (trackIt == tracksIt->second.end() || trackIt->second.samples->empty())
+    {
+        return;
+    }
+
+    ReplayTrack &track             = trackIt->second;
+    ReplaySamples_t const &samples = *track.samples;
+    double time                    = GetReplayTime() + track.offset;
+    bool startedOver               = false;
+
+    if (m_replayPeriod > 0.0 && time >= m_replayPeriod)
+    {
+        time        = std::fmod(time, m_replayPeriod);
+        startedOver = true;
+    }
+
+    auto next = std::upper_bound(
+        samples.begin(), samples.end(), time, [](double t, auto const &sample) { return t < sample.first; });
+    std::size_t applied = next - samples.begin();
+    if (applied == 0)
+    {
+        // Keep the loaded value until the first sample, and the last sample until the first again after that
+        if (!startedOver)
+        {
+            return;
+        }
+        applied = samples.size();
+    }
+    if (applied == track.applied)
+    {
+        return;
+    }
+
+    track.applied = applied;
+    if (!ParseOneDevice(samples[applied - 1].second, *m_devices[device], *m_deserializer))
+    {
+        NVML_LOG_ERR("failed to replay key [%s]", key.c_str());
+    }
+}
+
 bool InjectedNvml::ComputeInstancesParser(const std::string &key,
                                           const YAML::Node &node,
                                           AttributeHolder<nvmlGpuInstance_t> &ah)
@@ -1214,6 +1574,11 @@ bool InjectedNvml::ParseMigDevices(const YAML::Node &migDevices)
 /*****************************************************************************/
 bool InjectedNvml::LoadFromFile(const std::string &path)
 {
+    if (NvmlInjectionSnapshot::IsSnapshot(path))
+    {
+        return LoadFromSnapshot(path);
+    }
+
     YAML::Node root;
 
     try
@@ -1257,16 +1622,66 @@ bool InjectedNvml::LoadFromString(const std::string &yamlContent)
     return true;
 }
 
+/*****************************************************************************/
+bool InjectedNvml::LoadFromSnapshot(const std::string &path)
+{
+    auto snapshot = std::make_unique<NvmlInjectionSnapshot>();
+    YAML::Node root;
+
+    if (!snapshot->Open(path))
+    {
+        return false;
+    }
+
+    try
+    {
+        root = YAML::Load(std::string(snapshot->GetSectionsYaml()));
+    }
+    catch (const std::exception &e)
+    {
+        NVML_LOG_ERR("failed to YAML load [%s], reason [%s]", path.c_str(), e.what());
+        return false;
+    }
+
+    m_snapshot = std::move(snapshot);
+
+    if (!LoadFromYamlNode(root))
+    {
+        NVML_LOG_ERR("failed to parse snapshot [%s]", path.c_str());
+        return false;
+    }
+    return true;
+}
+
 /*****************************************************************************/
 bool InjectedNvml::LoadFromYamlNode(const YAML::Node &root)
 {
-    if (!ParseGlobal(root[GLOBAL]))
+    YAML::Node global = root[GLOBAL];
+
+    if (root[REPLAY] && root[REPLAY]["SyntheticDevices"])
+    {
+        // Add the synthetic devices to the device order before the devices are created from it
+        global = YAML::Clone(root[GLOBAL]);
+        if (!AddSyntheticDevices(root[REPLAY]["SyntheticDevices"], global))
+        {
+            NVML_LOG_ERR("failed to add synthetic devices");
+            return false;
+        }
+    }
+
+    if (!m_deserializer)
+    {
+        m_deserializer = std::make_unique<NvmlReturnDeserializer>();
+    }
+
+    if (!ParseGlobal(global))
     {
         NVML_LOG_ERR("failed to parse global part");
         return false;
     }
 
-    if (!ParseDevices(root[DEVICE]))
+    // A snapshot has no Device section. Its devices come from the snapshot index
+    if (m_snapshot ? !ParseSnapshotDevices() : !ParseDevices(root[DEVICE]))
     {
         NVML_LOG_ERR("failed to parse device part");
         return false;
@@ -1301,6 +1716,12 @@ bool InjectedNvml::LoadFromYamlNode(const YAML::Node &root)
         NVML_LOG_ERR("failed to parse vGPU instance part");
         return false;
     }
+
+    if (!ParseReplay(root[REPLAY]))
+    {
+        NVML_LOG_ERR("failed to parse replay part");
+        return false;
+    }
     return true;
 }
 
@@ -1324,23 +1745,28 @@ bool InjectedNvml::IsSetter(const std::string & /* funcname */) const
 }
 
 /*****************************************************************************/
-std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::string &funcname,
+InjectedFuncInfo const &InjectedNvml::GetFuncInfo(const std::string &funcname)
+{
+    auto it = m_funcInfos.find(funcname);
+    if (it == m_funcInfos.end())
+    {
+        it = m_funcInfos.emplace(funcname, MakeFuncInfo(funcname)).first;
+    }
+    return it->second;
+}
+
+/*****************************************************************************/
+std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(InjectedFuncInfo const &funcInfo,
                                                                 const std::string &key,
                                                                 std::vector<InjectionArgument> &args,
                                                                 std::vector<InjectionArgument> &values)
 {
-    // funcname -> return NVML_ERROR_INSUFFICIENT_SIZE when has element
-    std::unordered_map<std::string, bool> queryArraySizeFuncs {
-        { "nvmlDeviceGetSupportedVgpus", true },         { "nvmlDeviceGetActiveVgpus", true },
-        { "nvmlDeviceGetFBCSessions", false },           { "nvmlDeviceGetCreatableVgpus", true },
-        { "nvmlVgpuInstanceGetEncoderSessions", false }, { "nvmlVgpuInstanceGetFBCSessions", false },
-    };
     auto queryArraySizeHandler = [&](const bool returnInsufficientSizeWhenHasValue) -> std::optional<nvmlReturn_t> {
-        if (IsDeviceFunc(funcname, args) && !m_devices.contains(args[0].AsDevice()))
+        if (IsDeviceFunc(funcInfo, args) && !m_devices.contains(args[0].AsDevice()))
         {
             return NVML_ERROR_INVALID_ARGUMENT;
         }
-        if (IsVgpuInstanceFunc(funcname, args) && !m_vgpuInstances.contains(args[0].AsUInt()))
+        if (IsVgpuInstanceFunc(funcInfo, args) && !m_vgpuInstances.contains(args[0].AsUInt()))
         {
             return NVML_ERROR_INVALID_ARGUMENT;
         }
@@ -1351,7 +1777,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         if (*values[0].AsUIntPtr() == 0)
         {
             NvmlFuncReturn nvmlFuncReturn;
-            if (IsDeviceFunc(funcname, args))
+            if (IsDeviceFunc(funcInfo, args))
             {
                 nvmlFuncReturn = m_devices[args[0].AsDevice()]->GetAttribute(key);
             }
@@ -1377,16 +1803,19 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         return std::nullopt;
     };
 
-    auto it = queryArraySizeFuncs.find(funcname);
-    if (it != queryArraySizeFuncs.end())
-    {
-        return queryArraySizeHandler(it->second);
-    }
-    if (funcname == "nvmlEventSetWait_v2")
+    switch (funcInfo.specialCase)
     {
-        return NVML_ERROR_TIMEOUT;
+        case InjectedFuncSpecialCase::None:
+            return std::nullopt;
+        case InjectedFuncSpecialCase::QueryArraySize:
+            return queryArraySizeHandler(funcInfo.insufficientSizeWhenHasValue);
+        case InjectedFuncSpecialCase::EventSetWait:
+            return NVML_ERROR_TIMEOUT;
+        default:
+            break;
     }
-    if (funcname == "nvmlGpuInstanceGetComputeInstances")
+
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::GpuInstanceGetComputeInstances)
     {
         nvmlGpuInstance_t gpuInstance           = args[0].AsGpuInstance();
         nvmlComputeInstance_t *computeInstances = values[0].AsComputeInstancePtr();
@@ -1407,7 +1836,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         *count = actualCount;
         return NVML_SUCCESS;
     }
-    if (funcname == "nvmlDeviceGetGpuInstances")
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::DeviceGetGpuInstances)
     {
         if (args.size() != 2 || args[0].GetType() != INJECTION_DEVICE || args[1].GetType() != INJECTION_UINT
             || values.size() != 2 || values[0].GetType() != INJECTION_GPUINSTANCE_PTR
@@ -1431,7 +1860,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         values[1].SetValueFrom(nvmlFuncRet.GetCompoundValue().RawValues()[1]);
         return NVML_SUCCESS;
     }
-    if (funcname == "nvmlVgpuInstanceGetVmID")
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::VgpuInstanceGetVmID)
     {
         if (args.size() != 2 || values.size() != 2 || values[0].GetType() != INJECTION_CHAR_PTR
             || !m_vgpuInstances.contains(args[0].AsUInt()))
@@ -1456,7 +1885,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         values[1].SetValueFrom(nvmlFuncReturn.GetCompoundValue().RawValues()[1]);
         return NVML_SUCCESS;
     }
-    if (funcname == "nvmlDeviceGetProcessUtilization")
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::DeviceGetProcessUtilization)
     {
         if (args.size() != 2 || args[0].GetType() != INJECTION_DEVICE || args[1].GetType() != INJECTION_ULONG_LONG
             || values.size() != 2 || values[0].GetType() != INJECTION_PROCESSUTILIZATIONSAMPLE_PTR
@@ -1484,7 +1913,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         }
         return NVML_SUCCESS;
     }
-    if (funcname == "nvmlDeviceGetVgpuProcessUtilization")
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::DeviceGetVgpuProcessUtilization)
     {
         if (args.size() != 2 || args[0].GetType() != INJECTION_DEVICE || args[1].GetType() != INJECTION_ULONG_LONG
             || values.size() != 2 || values[0].GetType() != INJECTION_UINT_PTR
@@ -1512,7 +1941,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         }
         return NVML_SUCCESS;
     }
-    if (funcname == "nvmlDeviceGetVgpuUtilization")
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::DeviceGetVgpuUtilization)
     {
         if (args.size() != 2 || args[0].GetType() != INJECTION_DEVICE || args[1].GetType() != INJECTION_ULONG_LONG
             || values.size() != 3 || values[0].GetType() != INJECTION_VALUETYPE_PTR
@@ -1547,7 +1976,7 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
         }
         return NVML_SUCCESS;
     }
-    if (funcname == "nvmlDeviceGetMemoryInfo")
+    if (funcInfo.specialCase == InjectedFuncSpecialCase::DeviceGetMemoryInfo)
     {
         if (args.size() != 1 || args[0].GetType() != INJECTION_DEVICE || values.size() != 1
             || values[0].GetType() != INJECTION_MEMORY_PTR || !m_devices.contains(args[0].AsDevice()))
@@ -1574,25 +2003,30 @@ std::optional<nvmlReturn_t> InjectedNvml::GetWrapperSpecialCase(const std::strin
 
 NvmlFuncReturn InjectedNvml::DeviceGetWrapper(const std::string &key, std::vector<InjectionArgument> &args)
 {
-    if (args.size() < 1 || args[0].GetType() != INJECTION_DEVICE || !m_devices.contains(args[0].AsDevice()))
+    if (args.size() < 1 || args[0].GetType() != INJECTION_DEVICE)
+    {
+        return NvmlFuncReturn(NVML_ERROR_INVALID_ARGUMENT);
+    }
+    auto deviceIt = m_devices.find(args[0].AsDevice());
+    if (deviceIt == m_devices.end())
     {
         return NvmlFuncReturn(NVML_ERROR_INVALID_ARGUMENT);
     }
     if (args.size() == 1)
     {
-        return m_devices[args[0].AsDevice()]->GetAttribute(key);
+        return deviceIt->second->GetAttribute(key);
     }
     if (args.size() == 2)
     {
-        return m_devices[args[0].AsDevice()]->GetAttribute(key, args[1]);
+        return deviceIt->second->GetAttribute(key, args[1]);
     }
     if (args.size() == 3)
     {
-        return m_devices[args[0].AsDevice()]->GetAttribute(key, args[1], args[2]);
+        return deviceIt->second->GetAttribute(key, args[1], args[2]);
     }
     if (args.size() == 4)
     {
-        return m_devices[args[0].AsDevice()]->GetAttribute(key, args[1], args[2], args[3]);
+        return deviceIt->second->GetAttribute(key, args[1], args[2], args[3]);
     }
     return NvmlFuncReturn(NVML_ERROR_INVALID_ARGUMENT);
 }
@@ -1673,38 +2107,39 @@ nvmlReturn_t InjectedNvml::GetWrapper(const std::string &funcname,
                                       std::vector<InjectionArgument> &args,
                                       std::vector<InjectionArgument> &values)
 {
-    // dcgm may try to call the following functions for testing, using the list to avoid misleading infomation
-    std::unordered_set<std::string> allowNotInjectedFuncs {
-        "nvmlGpuInstanceGetComputeInstanceProfileInfo",
-        "nvmlDeviceGetGpuInstanceProfileInfo",
-        "nvmlDeviceGetMigDeviceHandleByIndex",
-    };
     std::lock_guard<std::mutex> guard(m_mutex);
 
-    std::optional<nvmlReturn_t> nvmlRetOpt = GetWrapperSpecialCase(funcname, key, args, values);
+    InjectedFuncInfo const &funcInfo = GetFuncInfo(funcname);
+
+    if (!m_replayTracks.empty() && IsDeviceFunc(funcInfo, args))
+    {
+        ApplyReplay(args[0].AsDevice(), key);
+    }
+
+    std::optional<nvmlReturn_t> nvmlRetOpt = GetWrapperSpecialCase(funcInfo, key, args, values);
     if (nvmlRetOpt.has_value())
     {
         return nvmlRetOpt.value();
     }
 
     NvmlFuncReturn nvmlFuncReturn;
-    if (IsDeviceFunc(funcname, args))
+    if (IsDeviceFunc(funcInfo, args))
     {
         nvmlFuncReturn = DeviceGetWrapper(key, args);
     }
-    else if (IsGpuInstanceFunc(funcname, args))
+    else if (IsGpuInstanceFunc(funcInfo, args))
     {
         nvmlFuncReturn = GpuInstanceGetWrapper(key, args);
     }
-    else if (IsComputeInstanceFunc(funcname, args))
+    else if (IsComputeInstanceFunc(funcInfo, args))
     {
         nvmlFuncReturn = ComputeInstanceGetWrapper(key, args);
     }
-    else if (IsVgpuTypeFunc(funcname, args))
+    else if (IsVgpuTypeFunc(funcInfo, args))
     {
         nvmlFuncReturn = VgpuTypeIdGetWrapper(key, args);
     }
-    else if (IsVgpuInstanceFunc(funcname, args))
+    else if (IsVgpuInstanceFunc(funcInfo, args))
     {
         nvmlFuncReturn = VgpuInstanceGetWrapper(key, args);
     }
@@ -1716,7 +2151,7 @@ nvmlReturn_t InjectedNvml::GetWrapper(const std::string &funcname,
 
     if (!nvmlFuncReturn.HasValue())
     {
-        if (!allowNotInjectedFuncs.contains(funcname))
+        if (!funcInfo.allowNotInjected)
         {
             NVML_LOG_ERR("calling a function [%s] without injection.", funcname.c_str());
         }
@@ -2255,6 +2690,7 @@ nvmlReturn_t InjectedNvml::GetFieldValues(nvmlDevice_t nvmlDevice, int valuesCou
         return NVML_ERROR_INVALID_ARGUMENT;
     }
 
+    ApplyReplay(nvmlDevice, INJECTION_FIELDVALUES_KEY);
     auto funcRet = m_devices[nvmlDevice]->GetAttribute(INJECTION_FIELDVALUES_KEY);
     if (!funcRet.IsNvmlSucces())
     {
@@ -2270,6 +2706,13 @@ nvmlReturn_t InjectedNvml::GetFieldValues(nvmlDevice_t nvmlDevice, int valuesCou
     return NVML_SUCCESS;
 }
 
+nvmlReturn_t InjectedNvml::ReplaySetTime(unsigned long long timeUsec)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_replayTime = timeUsec / 1000000.0;
+    return NVML_SUCCESS;
+}
+
 void InjectedNvml::SetupDefaultEnv()
 {
     // Set baseline global data
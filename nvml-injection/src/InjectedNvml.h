@@ -15,8 +15,12 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -32,6 +36,9 @@
 #include "InjectionArgument.h"
 #include "NvmlFuncReturn.h"
 
+class NvmlInjectionSnapshot;
+class NvmlReturnDeserializer;
+
 typedef struct
 {
     std::string pciBusId;
@@ -41,11 +48,6 @@ typedef struct
     AttributeHolder<nvmlDevice_t> ah;
 } nvmlDeviceWithIdentifiers;
 
-struct StringHash : std::hash<std::string_view>
-{
-    using is_transparent = void;
-};
-
 using funcCallMap_t = std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>;
 
 #define GLOBAL            "Global"
@@ -55,9 +57,46 @@ using funcCallMap_t = std::unordered_map<std::string, uint32_t, StringHash, std:
 #define VGPU_TYPE         "vGPUType"
 #define VGPU_INSTANCE     "vGPUInstance"
 #define MIG_DEVICE        "MigDevice"
+#define REPLAY            "Replay"
 #define FunctionReturn    "FunctionReturn"
 #define ReturnValue       "ReturnValue"
 
+// Object whose attributes a getter reads, going by the prefix of the function name
+enum class InjectedFuncTarget : std::uint8_t
+{
+    None,
+    Device,
+    GpuInstance,
+    ComputeInstance,
+    VgpuType,
+    VgpuInstance,
+};
+
+// Getters that InjectedNvml::GetWrapper() doesn't serve from a plain attribute
+enum class InjectedFuncSpecialCase : std::uint8_t
+{
+    None,
+    QueryArraySize, // the first value is the size of an array, which is queried by passing 0
+    EventSetWait,
+    GpuInstanceGetComputeInstances,
+    DeviceGetGpuInstances,
+    VgpuInstanceGetVmID,
+    DeviceGetProcessUtilization,
+    DeviceGetVgpuProcessUtilization,
+    DeviceGetVgpuUtilization,
+    DeviceGetMemoryInfo,
+};
+
+// What InjectedNvml::GetWrapper() needs to know about a function. It's worked out from the function name once and
+// cached, so that calls don't compare the name against every prefix and special case
+struct InjectedFuncInfo
+{
+    InjectedFuncTarget target           = InjectedFuncTarget::None;
+    InjectedFuncSpecialCase specialCase = InjectedFuncSpecialCase::None;
+    bool insufficientSizeWhenHasValue   = false; // QueryArraySize returns NVML_ERROR_INSUFFICIENT_SIZE for size > 0
+    bool allowNotInjected               = false; // dcgm probes it, so don't log calls that aren't injected
+};
+
 class InjectedNvml
 {
 public:
@@ -78,6 +117,20 @@ public:
     /*****************************************************************************/
     bool LoadFromString(const std::string &yamlContent);
 
+    /**
+     * Load a snapshot written by NvmlInjectionSnapshot::Convert(). Device keys are parsed the first time they are
+     * used instead of up front. LoadFromFile() calls this for snapshots.
+     * @param[in]  path                 Path of the snapshot
+     */
+    bool LoadFromSnapshot(const std::string &path);
+
+    /**
+     * Serve the tracks of the Replay section at a virtual time from now on, instead of at the time since loading
+     * scaled by its Speed. Calls see the samples at or before timeUsec.
+     * @param[in]  timeUsec             Time into the recording, in microseconds
+     */
+    nvmlReturn_t ReplaySetTime(unsigned long long timeUsec);
+
     /*****************************************************************************/
     void SetupDefaultEnv();
 
@@ -211,7 +264,7 @@ private:
 
     std::map<nvmlVgpuInstance_t, AttributeHolder<nvmlVgpuInstance_t>> m_vgpuInstances;
     std::map<nvmlVgpuTypeId_t, AttributeHolder<nvmlVgpuTypeId_t>> m_vgpuTypeIds;
-    std::map<nvmlDevice_t, std::list<AttributeHolder<nvmlDevice_t>>::iterator> m_devices;
+    std::unordered_map<nvmlDevice_t, std::list<AttributeHolder<nvmlDevice_t>>::iterator> m_devices;
     std::map<nvmlGpuInstance_t, AttributeHolder<nvmlGpuInstance_t>> m_gpuInstances;
     std::map<nvmlComputeInstance_t, AttributeHolder<nvmlComputeInstance_t>> m_computeInstances;
 
@@ -246,6 +299,35 @@ private:
 
     funcCallMap_t m_nvmlFuncCallCounts;
 
+    // function name -> how GetWrapper() handles it. Protected by m_mutex
+    std::unordered_map<std::string, InjectedFuncInfo, StringHash, std::equal_to<>> m_funcInfos;
+
+    // The loaded snapshot, if any. Device keys not parsed yet point into it
+    std::unique_ptr<NvmlInjectionSnapshot> m_snapshot;
+    // Parses device keys after loading, for the snapshot and the Replay section
+    std::unique_ptr<NvmlReturnDeserializer> m_deserializer;
+
+    // Samples of one key in the Replay section, sorted by time in seconds. Each sample is { key: value } in the
+    // layout of the Device section
+    using ReplaySamples_t = std::vector<std::pair<double, YAML::Node>>;
+
+    struct ReplayTrack
+    {
+        std::shared_ptr<const ReplaySamples_t> samples;
+        double offset       = 0.0; // added to the replay time for this device
+        std::size_t applied = 0;   // samples[applied - 1] is the value loaded in the device, or none if 0
+    };
+
+    // device -> key -> track
+    std::map<nvmlDevice_t, std::unordered_map<std::string, ReplayTrack>> m_replayTracks;
+    double m_replaySpeed  = 1.0;
+    double m_replayPeriod = 0.0; // tracks start over after this many seconds, or play once if 0
+    std::chrono::steady_clock::time_point m_replayStart;
+    std::optional<double> m_replayTime; // set by ReplaySetTime()
+
+    // UUID of a synthetic device -> UUID of the recorded device it copies
+    std::unordered_map<std::string, std::string> m_syntheticDeviceSources;
+
     nvmlDevice_t GenNextNvmlDevice() const;
 
     /*****************************************************************************/
@@ -253,8 +335,23 @@ private:
 
     // The following functions used for parsing YAML file and preparing behavior of NVML
     bool ParseGlobal(const YAML::Node &global);
+    using DeviceKeyParser_t
+        = std::function<bool(const std::string &, const YAML::Node &, AttributeHolder<nvmlDevice_t> &)>;
+    std::unordered_map<std::string, DeviceKeyParser_t> GetDeviceKeyParsers();
     bool ParseOneDevice(const YAML::Node &device, AttributeHolder<nvmlDevice_t> &ah);
+    bool ParseOneDevice(const YAML::Node &device,
+                        AttributeHolder<nvmlDevice_t> &ah,
+                        NvmlReturnDeserializer &nvmlReturnDeserializer);
     bool ParseDevices(const YAML::Node &devices);
+    bool ParseSnapshotDevices();
+    void LoadSnapshotDeviceKey(std::string_view yaml, AttributeHolder<nvmlDevice_t> &ah);
+    void AddDeviceIdentifiers(std::list<AttributeHolder<nvmlDevice_t>>::iterator iter);
+    bool AddSyntheticDevices(const YAML::Node &deviceCount, YAML::Node &global);
+    std::string const &GetRecordedDeviceUUID(std::string const &uuid) const;
+    void SetSyntheticIdentifiers(AttributeHolder<nvmlDevice_t> &ah, std::string const &uuid, unsigned int index);
+    bool ParseReplay(const YAML::Node &replay);
+    double GetReplayTime() const;
+    void ApplyReplay(nvmlDevice_t device, const std::string &key);
     bool ParseOneGpuInstance(const YAML::Node &gpuInstance, AttributeHolder<nvmlGpuInstance_t> &ah);
     bool ParseGpuInstances(const YAML::Node &gpuInstances);
     bool ParseOneComputeInstance(const YAML::Node &computeInstance, AttributeHolder<nvmlComputeInstance_t> &ah);
@@ -282,7 +379,8 @@ private:
                                    const YAML::Node &node,
                                    AttributeHolder<nvmlComputeInstance_t> &ah);
 
-    std::optional<nvmlReturn_t> GetWrapperSpecialCase(const std::string &funcname,
+    InjectedFuncInfo const &GetFuncInfo(const std::string &funcname);
+    std::optional<nvmlReturn_t> GetWrapperSpecialCase(InjectedFuncInfo const &funcInfo,
                                                       const std::string &key,
                                                       std::vector<InjectionArgument> &args,
                                                       std::vector<InjectionArgument> &values);
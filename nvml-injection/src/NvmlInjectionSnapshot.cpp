@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "NvmlInjectionSnapshot.h"
+
+#include "InjectedNvml.h"
+#include "NvmlLogging.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <yaml-cpp/yaml.h>
+
+namespace
+{
+
+constexpr char c_snapshotMagic[8]         = { 'N', 'V', 'M', 'L', 'I', 'S', 'N', 'P' };
+constexpr std::uint32_t c_snapshotVersion = 1;
+
+template <typename T>
+void AppendValue(std::string &index, T value)
+{
+    index.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+void AppendString(std::string &index, std::string_view value)
+{
+    AppendValue(index, static_cast<std::uint32_t>(value.size()));
+    index.append(value);
+}
+
+/* Reads the index, failing rather than reading past the end of the mapping */
+class IndexReader
+{
+public:
+    IndexReader(char const *data, std::size_t length)
+        : m_data(data)
+        , m_length(length)
+    {}
+
+    template <typename T>
+    bool Read(T &value)
+    {
+        if (m_length - m_offset < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string_view &value)
+    {
+        std::uint32_t length;
+        if (!Read(length) || m_length - m_offset < length)
+        {
+            return false;
+        }
+        value = std::string_view(m_data + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+    bool ReadRange(std::string_view &value)
+    {
+        std::uint64_t offset;
+        std::uint64_t length;
+        if (!Read(offset) || !Read(length) || offset > m_length || length > m_length - offset)
+        {
+            return false;
+        }
+        value = std::string_view(m_data + offset, length);
+        return true;
+    }
+
+private:
+    char const *m_data;
+    std::size_t m_length;
+    std::size_t m_offset = 0;
+};
+
+} //namespace
+
+NvmlInjectionSnapshot::~NvmlInjectionSnapshot()
+{
+    Close();
+}
+
+/*****************************************************************************/
+bool NvmlInjectionSnapshot::IsSnapshot(const std::string &path)
+{
+    char magic[sizeof(c_snapshotMagic)] {};
+    std::ifstream in(path, std::ios::binary);
+
+    if (!in.read(magic, sizeof(magic)))
+    {
+        return false;
+    }
+    return std::memcmp(magic, c_snapshotMagic, sizeof(magic)) == 0;
+}
+
+/*****************************************************************************/
+bool NvmlInjectionSnapshot::Convert(const std::string &yamlPath, const std::string &snapshotPath)
+{
+    struct KeyYaml
+    {
+        std::string key;
+        std::string yaml;
+    };
+    std::vector<std::pair<std::string, std::vector<KeyYaml>>> devices;
+    std::string sectionsYaml;
+
+    try
+    {
+        YAML::Node root = YAML::LoadFile(yamlPath);
+        YAML::Node sections(YAML::NodeType::Map);
+
+        for (YAML::const_iterator it = root.begin(); it != root.end(); ++it)
+        {
+            auto section = it->first.as<std::string>();
+            if (section != DEVICE)
+            {
+                sections[section] = it->second;
+                continue;
+            }
+
+            for (YAML::const_iterator deviceIt = it->second.begin(); deviceIt != it->second.end(); ++deviceIt)
+            {
+                auto &[uuid, keys] = devices.emplace_back(deviceIt->first.as<std::string>(), std::vector<KeyYaml> {});
+                for (YAML::const_iterator keyIt = deviceIt->second.begin(); keyIt != deviceIt->second.end(); ++keyIt)
+                {
+                    auto key = keyIt->first.as<std::string>();
+                    YAML::Node document(YAML::NodeType::Map);
+                    document[key] = keyIt->second;
+                    keys.push_back({ key, YAML::Dump(document) });
+                }
+            }
+        }
+        sectionsYaml = YAML::Dump(sections);
+    }
+    catch (const std::exception &e)
+    {
+        NVML_LOG_ERR("failed to YAML load [%s], reason [%s]", yamlPath.c_str(), e.what());
+        return false;
+    }
+
+    // Every field of the index has a fixed size, so the offset of the data is known before writing it
+    std::size_t indexLength = sizeof(c_snapshotMagic) + 2 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t);
+    for (auto const &[uuid, keys] : devices)
+    {
+        indexLength += 2 * sizeof(std::uint32_t) + uuid.size();
+        for (auto const &[key, yaml] : keys)
+        {
+            indexLength += sizeof(std::uint32_t) + key.size() + 2 * sizeof(std::uint64_t);
+        }
+    }
+
+    std::string index;
+    index.reserve(indexLength);
+    std::uint64_t dataOffset = indexLength;
+
+    index.append(c_snapshotMagic, sizeof(c_snapshotMagic));
+    AppendValue(index, c_snapshotVersion);
+    AppendValue(index, static_cast<std::uint32_t>(devices.size()));
+    AppendValue(index, dataOffset);
+    AppendValue(index, static_cast<std::uint64_t>(sectionsYaml.size()));
+    dataOffset += sectionsYaml.size();
+
+    for (auto const &[uuid, keys] : devices)
+    {
+        AppendString(index, uuid);
+        AppendValue(index, static_cast<std::uint32_t>(keys.size()));
+        for (auto const &[key, yaml] : keys)
+        {
+            AppendString(index, key);
+            AppendValue(index, dataOffset);
+            AppendValue(index, static_cast<std::uint64_t>(yaml.size()));
+            dataOffset += yaml.size();
+        }
+    }
+
+    std::ofstream out(snapshotPath, std::ios::binary | std::ios::trunc);
+    out << index << sectionsYaml;
+    for (auto const &[uuid, keys] : devices)
+    {
+        for (auto const &[key, yaml] : keys)
+        {
+            out << yaml;
+        }
+    }
+    out.close();
+
+    if (!out)
+    {
+        NVML_LOG_ERR("failed to write snapshot [%s]", snapshotPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+bool NvmlInjectionSnapshot::Open(const std::string &path)
+{
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        NVML_LOG_ERR("failed to open [%s], reason [%s]", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        NVML_LOG_ERR("failed to get the size of [%s]", path.c_str());
+        close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NVML_LOG_ERR("failed to map [%s], reason [%s]", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_length  = st.st_size;
+
+    if (!ReadIndex())
+    {
+        NVML_LOG_ERR("[%s] is not a valid snapshot", path.c_str());
+        Close();
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+bool NvmlInjectionSnapshot::ReadIndex()
+{
+    IndexReader reader(static_cast<char const *>(m_mapping), m_length);
+    char magic[sizeof(c_snapshotMagic)];
+    std::uint32_t version;
+    std::uint32_t deviceCount;
+
+    if (!reader.Read(magic) || std::memcmp(magic, c_snapshotMagic, sizeof(magic)) != 0 || !reader.Read(version)
+        || version != c_snapshotVersion || !reader.Read(deviceCount) || !reader.ReadRange(m_sectionsYaml))
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < deviceCount; i++)
+    {
+        std::string_view uuid;
+        std::uint32_t keyCount;
+        if (!reader.ReadString(uuid) || !reader.Read(keyCount))
+        {
+            return false;
+        }
+
+        DeviceKeys_t &keys = m_devices[std::string(uuid)];
+        keys.reserve(keyCount);
+        for (std::uint32_t j = 0; j < keyCount; j++)
+        {
+            std::string_view key;
+            std::string_view yaml;
+            if (!reader.ReadString(key) || !reader.ReadRange(yaml))
+            {
+                return false;
+            }
+            keys.emplace(key, yaml);
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************/
+std::string_view NvmlInjectionSnapshot::GetSectionsYaml() const
+{
+    return m_sectionsYaml;
+}
+
+/*****************************************************************************/
+const NvmlInjectionSnapshot::DeviceKeys_t *NvmlInjectionSnapshot::GetDeviceKeys(const std::string &uuid) const
+{
+    auto it = m_devices.find(uuid);
+    return it == m_devices.end() ? nullptr : &it->second;
+}
+
+/*****************************************************************************/
+void NvmlInjectionSnapshot::Close()
+{
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, m_length);
+    }
+    m_mapping      = nullptr;
+    m_length       = 0;
+    m_sectionsYaml = {};
+    m_devices.clear();
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/*
+ * Binary snapshot of an NVML injection YAML capture, so that loading it doesn't parse the whole capture.
+ *
+ * The Device section is split into one small YAML document per device and key, indexed by device UUID and
+ * key. Every other section is kept together in one YAML document. Opening a snapshot mmaps it and reads only
+ * the index, so a device key is parsed the first time it is used.
+ *
+ * Layout, in host byte order:
+ *  header     - magic, version, device count, offset and length of the YAML without the Device section
+ *  devices    - for each device: UUID, key count, then key, offset and length of each key's YAML
+ *  data       - the YAML documents
+ *
+ * Strings in the index are a uint32_t length followed by the characters.
+ */
+class NvmlInjectionSnapshot
+{
+public:
+    /* key -> YAML document { key: value } of one device, pointing into the mapping */
+    using DeviceKeys_t = std::unordered_map<std::string, std::string_view>;
+
+    NvmlInjectionSnapshot() = default;
+    ~NvmlInjectionSnapshot();
+
+    NvmlInjectionSnapshot(NvmlInjectionSnapshot const &)            = delete;
+    NvmlInjectionSnapshot &operator=(NvmlInjectionSnapshot const &) = delete;
+
+    /*****************************************************************************/
+    /* Returns true if the file at path starts like a snapshot */
+    static bool IsSnapshot(const std::string &path);
+
+    /*****************************************************************************/
+    /* Write the snapshot of the YAML capture at yamlPath to snapshotPath */
+    static bool Convert(const std::string &yamlPath, const std::string &snapshotPath);
+
+    /*****************************************************************************/
+    /* Map the snapshot at path and read its index. The mapping lives as long as this object */
+    bool Open(const std::string &path);
+
+    /*****************************************************************************/
+    /* The YAML document with every section but Device */
+    std::string_view GetSectionsYaml() const;
+
+    /*****************************************************************************/
+    /* The keys of the device with uuid, or nullptr if the snapshot doesn't have it */
+    const DeviceKeys_t *GetDeviceKeys(const std::string &uuid) const;
+
+private:
+    void *m_mapping      = nullptr;
+    std::size_t m_length = 0;
+
+    std::string_view m_sectionsYaml;
+    std::unordered_map<std::string, DeviceKeys_t> m_devices;
+
+    bool ReadIndex();
+    void Close();
+};
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Converts an NVML injection YAML capture into a snapshot that loads without parsing the whole capture.
+ *
+ * Usage: nvml_injection_snapshot <yaml-file> <snapshot-file>
+ */
+
+#include "NvmlInjectionSnapshot.h"
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <yaml-file> <snapshot-file>\n", argv[0]);
+        return 1;
+    }
+
+    return NvmlInjectionSnapshot::Convert(argv[1], argv[2]) ? 0 : 1;
+}
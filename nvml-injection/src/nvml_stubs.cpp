@@ -318,6 +318,17 @@ nvmlReturn_t nvmlRestoreGpu(const char *uuid)
     return NVML_SUCCESS;
 }
 
+nvmlReturn_t nvmlReplaySetTime(unsigned long long timeUsec)
+{
+    auto *injectedNvml = InjectedNvml::GetInstance();
+    if (injectedNvml)
+    {
+        return injectedNvml->ReplaySetTime(timeUsec);
+    }
+
+    return NVML_SUCCESS;
+}
+
 #ifdef __cplusplus
 }
 #endif
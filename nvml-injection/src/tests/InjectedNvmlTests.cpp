@@ -15,11 +15,16 @@
  */
 #include "nvml.h"
 #include <catch2/catch_all.hpp>
+#include <filesystem>
 #include <fmt/format.h>
+#include <fstream>
+#include <set>
+#include <unistd.h>
 #include <vector>
 
 #include <InjectedNvml.h>
 #include <InjectionKeys.h>
+#include <NvmlInjectionSnapshot.h>
 #include <nvml_injection.h>
 
 namespace
@@ -544,6 +549,169 @@ TEST_CASE("InjectedNvml: Load Device With Extra Key Entry")
     Teardown();
 }
 
+TEST_CASE("InjectedNvml: Load From Snapshot")
+{
+    auto *injectedNvml = InjectedNvml::Init();
+    std::vector<std::string> uuids {
+        "GPU-1ae4048a-9b19-f6c5-a7ed-1160943cdd18",
+        "GPU-26a0ce63-ce32-b34e-acf2-5a0273328ee5",
+    };
+    YAML::Node root           = GetYamlContentWithDevices(uuids);
+    constexpr int clockTypeSM = 1;
+
+    root["Device"][uuids[1]]["Serial"]["FunctionReturn"]                         = 0;
+    root["Device"][uuids[1]]["Serial"]["ReturnValue"]                            = "1560921106578";
+    root["Device"][uuids[1]]["ApplicationsClock"][clockTypeSM]["FunctionReturn"] = 0;
+    root["Device"][uuids[1]]["ApplicationsClock"][clockTypeSM]["ReturnValue"]    = 1980;
+    root["Device"][uuids[1]]["BoardPartNumber"]["FunctionReturn"]                = 0;
+    root["Device"][uuids[1]]["BoardPartNumber"]["ReturnValue"]                   = "900-2G500-0000-000";
+    root["Device"][uuids[1]]["Name"]["FunctionReturn"]                           = 0;
+    root["Device"][uuids[1]]["Name"]["ReturnValue"]                              = "NVIDIA H100";
+
+    auto const tmpDir       = std::filesystem::temp_directory_path();
+    auto const yamlPath     = tmpDir / fmt::format("nvmlicoretests-{}.yaml", getpid());
+    auto const snapshotPath = tmpDir / fmt::format("nvmlicoretests-{}.snapshot", getpid());
+    {
+        std::ofstream yamlFile(yamlPath);
+        yamlFile << YamlNodeToString(root);
+    }
+
+    REQUIRE(NvmlInjectionSnapshot::Convert(yamlPath, snapshotPath));
+    CHECK(!NvmlInjectionSnapshot::IsSnapshot(yamlPath));
+    CHECK(NvmlInjectionSnapshot::IsSnapshot(snapshotPath));
+
+    REQUIRE(injectedNvml->LoadFromFile(snapshotPath));
+    REQUIRE(injectedNvml->ObjectlessGet(INJECTION_COUNT_KEY).AsUInt() == 2);
+
+    // Serial is loaded up front for looking devices up
+    auto arg    = InjectionArgument(std::string("1560921106578"));
+    auto device = injectedNvml->GetNvmlDevice(arg, INJECTION_SERIAL_KEY);
+    REQUIRE(device != nullptr);
+    arg = InjectionArgument(uuids[1]);
+    REQUIRE(injectedNvml->GetNvmlDevice(arg, INJECTION_UUID_KEY) == device);
+
+    // The rest is loaded when used
+    InjectionArgument deviceArg { device };
+    auto [nvmlRet, partNumber] = injectedNvml->GetString(deviceArg, INJECTION_BOARDPARTNUMBER_KEY);
+    REQUIRE(nvmlRet == NVML_SUCCESS);
+    REQUIRE(partNumber == "900-2G500-0000-000");
+
+    std::vector<InjectionArgument> args { device, NVML_CLOCK_SM };
+    unsigned int clockMHz;
+    std::vector<InjectionArgument> values { &clockMHz };
+    REQUIRE(injectedNvml->GetWrapper("nvmlDeviceGetApplicationsClock", INJECTION_APPLICATIONSCLOCK_KEY, args, values)
+            == NVML_SUCCESS);
+    REQUIRE(clockMHz == 1980);
+
+    // Setting a key that wasn't used yet isn't undone by loading it later
+    REQUIRE(injectedNvml->DeviceSet(device, INJECTION_NAME_KEY, {}, NvmlFuncReturn(NVML_SUCCESS, "Renamed"))
+            == NVML_SUCCESS);
+    std::string name;
+    std::tie(nvmlRet, name) = injectedNvml->GetString(deviceArg, INJECTION_NAME_KEY);
+    REQUIRE(nvmlRet == NVML_SUCCESS);
+    REQUIRE(name == "Renamed");
+
+    std::filesystem::remove(yamlPath);
+    std::filesystem::remove(snapshotPath);
+    Teardown();
+}
+
+TEST_CASE("InjectedNvml: Replay")
+{
+    auto *injectedNvml = InjectedNvml::Init();
+    std::vector<std::string> uuids {
+        "GPU-1ae4048a-9b19-f6c5-a7ed-1160943cdd18",
+        "GPU-26a0ce63-ce32-b34e-acf2-5a0273328ee5",
+    };
+    YAML::Node root = GetYamlContentWithDevices(uuids);
+
+    for (unsigned int i = 0; i < uuids.size(); i++)
+    {
+        YAML::Node pciInfo;
+        pciInfo["busId"]          = fmt::format("00000000:{:02X}:00.0", i + 1);
+        pciInfo["busIdLegacy"]    = fmt::format("0000:{:02X}:00.0", i + 1);
+        pciInfo["domain"]         = 0;
+        pciInfo["bus"]            = i + 1;
+        pciInfo["device"]         = 0;
+        pciInfo["pciDeviceId"]    = 0x233010de;
+        pciInfo["pciSubSystemId"] = 0x16c110de;
+
+        root["Device"][uuids[i]]["Index"]["FunctionReturn"]      = 0;
+        root["Device"][uuids[i]]["Index"]["ReturnValue"]         = i;
+        root["Device"][uuids[i]]["PowerUsage"]["FunctionReturn"] = 0;
+        root["Device"][uuids[i]]["PowerUsage"]["ReturnValue"]    = 50;
+        root["Device"][uuids[i]]["PciInfo"]["FunctionReturn"]    = 0;
+        root["Device"][uuids[i]]["PciInfo"]["ReturnValue"]       = pciInfo;
+    }
+
+    root["Replay"]["SyntheticDevices"] = 4;
+    root["Replay"]["Duration"]         = 3;
+    for (unsigned int i = 1; i <= 2; i++)
+    {
+        YAML::Node sample;
+        sample["Time"]                    = i;
+        sample["Value"]["FunctionReturn"] = 0;
+        sample["Value"]["ReturnValue"]    = i * 100;
+        root["Replay"]["Device"]["*"]["PowerUsage"].push_back(sample);
+    }
+
+    REQUIRE(injectedNvml->LoadFromString(YamlNodeToString(root)));
+    REQUIRE(injectedNvml->ObjectlessGet(INJECTION_COUNT_KEY).AsUInt() == 4);
+
+    // Synthetic devices copy the recorded ones with their own identifiers
+    std::vector<nvmlDevice_t> devices;
+    std::set<std::string> busIds;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        auto arg    = InjectionArgument(i);
+        auto device = injectedNvml->GetNvmlDevice(arg, INJECTION_INDEX_KEY);
+        REQUIRE(device != nullptr);
+        devices.push_back(device);
+
+        InjectionArgument deviceArg { device };
+        auto [nvmlRet, uuid] = injectedNvml->GetString(deviceArg, INJECTION_UUID_KEY);
+        REQUIRE(nvmlRet == NVML_SUCCESS);
+        arg = InjectionArgument(uuid);
+        REQUIRE(injectedNvml->GetNvmlDevice(arg, INJECTION_UUID_KEY) == device);
+
+        unsigned int index;
+        std::vector<InjectionArgument> args { device };
+        std::vector<InjectionArgument> values { &index };
+        REQUIRE(injectedNvml->GetWrapper("nvmlDeviceGetIndex", INJECTION_INDEX_KEY, args, values) == NVML_SUCCESS);
+        REQUIRE(index == i);
+
+        nvmlPciInfo_t pciInfo;
+        values = std::vector<InjectionArgument> { &pciInfo };
+        REQUIRE(injectedNvml->GetWrapper("nvmlDeviceGetPciInfo", INJECTION_PCIINFO_KEY, args, values)
+                == NVML_SUCCESS);
+        busIds.insert(pciInfo.busId);
+        arg = InjectionArgument(std::string(pciInfo.busId));
+        REQUIRE(injectedNvml->GetNvmlDevice(arg, INJECTION_PCIBUSID_KEY) == device);
+    }
+    REQUIRE(busIds.size() == 4);
+
+    auto powerAt = [&](unsigned long long timeUsec, nvmlDevice_t device) {
+        unsigned int power = 0;
+        std::vector<InjectionArgument> args { device };
+        std::vector<InjectionArgument> values { &power };
+        REQUIRE(injectedNvml->ReplaySetTime(timeUsec) == NVML_SUCCESS);
+        REQUIRE(injectedNvml->GetWrapper("nvmlDeviceGetPowerUsage", INJECTION_POWERUSAGE_KEY, args, values)
+                == NVML_SUCCESS);
+        return power;
+    };
+
+    // The loaded value until the first sample, then each sample in turn, starting over after Duration
+    REQUIRE(powerAt(500000, devices[0]) == 50);
+    REQUIRE(powerAt(1000000, devices[0]) == 100);
+    REQUIRE(powerAt(2500000, devices[0]) == 200);
+    REQUIRE(powerAt(3500000, devices[0]) == 200);
+    REQUIRE(powerAt(4000000, devices[0]) == 100);
+    REQUIRE(powerAt(1500000, devices[3]) == 100);
+    REQUIRE(powerAt(2000000, devices[3]) == 200);
+
+    Teardown();
+}
+
 TEST_CASE("InjectedNvml: Device Injection")
 {
     auto *injectedNvml = InjectedNvml::Init();
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <iterator>
 #include <string>
 #include <unordered_map>
@@ -23,6 +25,7 @@
 #include "json/json.h"
 #include <DcgmMutex.h>
 #include <PluginInterface.h>
+#include <StatsJsonLinesWriter.h>
 #include <dcgm_structs.h>
 
 #define DCGM_ITERATING_TYPE_GPU_DATA     0
@@ -48,6 +51,7 @@ class CustomStatHolder
 {
 public:
     CustomStatHolder();
+    ~CustomStatHolder();
 
     /*
      * Gives the CustomStatHolder a list of the GPUs being used. This is needed later for the stat
@@ -65,6 +69,11 @@ public:
      */
     void AddCustomData(Json::Value &jv);
 
+    /*
+     * Write the data stored in this object as JSON Lines, in the same layout as AddCustomData()
+     */
+    void WriteCustomDataJsonLines(StatsJsonLinesWriter &writer);
+
     /*
      * Add the vector of timeseries information to the json value
      */
@@ -78,6 +87,9 @@ public:
     /*
      * Add a double timerseries stat to this object that is grouped by the name instead of a GPU
      * (The name will usually refer to a subtest.)
+     *
+     * This and SetGpuStat() don't take a lock, so plugin threads reporting stats never wait on each other.
+     * The stats are merged into the stored data when it is read.
      */
     void SetGroupedStat(const std::string &groupName, const std::string &name, double value);
 
@@ -142,7 +154,7 @@ private:
 
     // All these members are for holding state across calls to PopulateCustomStats(). They are needed because the buffer
     // is a fixed size, and the interface calling them is C, so we maintain the state on the Plugin end.
-    bool m_currentlyIterating = false;
+    std::atomic<bool> m_currentlyIterating = false;
     unsigned int m_statPopulationType;
     std::unordered_map<unsigned int, std::unordered_map<std::string, std::vector<dcgmTimeseriesInfo_t>>>::iterator
         m_gpuDataIter;
@@ -153,6 +165,28 @@ private:
     std::vector<dcgmTimeseriesInfo_t>::iterator m_vecIter;
     std::unordered_map<std::string, std::string>::iterator m_singleIter;
 
+    /* A stat that was reported but isn't in m_gpuData or m_groupedData yet */
+    struct PendingStat
+    {
+        std::string groupName; /* Empty for GPU stats */
+        std::string name;
+        dcgmTimeseriesInfo_t data;
+        PendingStat *next;
+    };
+
+    // Lock-free lists of reported stats, newest first: one per GPU id and one for the grouped stats. Reporting
+    // pushes onto a list and reading the stats moves the lists into the maps above.
+    std::array<std::atomic<PendingStat *>, DCGM_MAX_NUM_DEVICES> m_pendingGpuStats {};
+    std::atomic<PendingStat *> m_pendingGroupedStats = nullptr;
+
+    void PushPendingStat(std::atomic<PendingStat *> &list, PendingStat *stat);
+    /* Take the whole list, oldest first */
+    PendingStat *TakePendingStats(std::atomic<PendingStat *> &list);
+    /* Move the pending GPU stats into m_gpuData. The caller must hold m_gpuDataMutex */
+    void MergePendingGpuStats();
+    /* Move the pending grouped stats into m_groupedData. The caller must hold m_groupedDataMutex */
+    void MergePendingGroupedStats();
+
     void AddGpuDataToJson(Json::Value &jv);
     void AddNonTimeseriesDataToJson(Json::Value &jv);
     void AddGroupedDataToJson(Json::Value &jv);
@@ -57,6 +57,7 @@ public:
     void SetSystemError(std::string const &msg, unsigned int code);
     bool TestSlotsFull() const;
     dcgmReturn_t AddTestCategory(std::string_view testName, std::string_view category);
+    dcgmReturn_t GetTestCompletion(std::string_view testName, dcgmDiagTestCompletion_v1 &completion) const;
     void Print() const;
 
 private:
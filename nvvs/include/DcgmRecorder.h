@@ -51,6 +51,14 @@ typedef struct
 extern errorType_t standardErrorFields[];
 extern unsigned short standardInfoFields[];
 
+/* What DcgmRecorder::MayHaveCommonErrors() keeps between calls */
+struct CommonErrorsScreen
+{
+    std::map<std::pair<unsigned int, unsigned short>, long long> firstValues; //!< First value since the start time of
+                                                                              //!< fields checked by their difference
+    std::map<unsigned int, long long> maxTemps;                              //!< Max operating temperature of each GPU
+};
+
 class DcgmRecorder
 {
 public:
@@ -159,6 +167,9 @@ public:
      * Makes a stateful query for the specified entity's fieldId since ts. If we have already stored the data
      * for the specified entity's fieldId in m_valuesHolder, then no work is done, unless force is set.
      *
+     * With force set, m_valuesHolder is made to hold every sample since ts. If it already holds every sample
+     * since that same ts, only the newer samples are queried, so checks repeated during a test stay incremental.
+     *
      * @return:
      *
      * DCGM_ST_OK     : on success
@@ -314,6 +325,21 @@ public:
                                              nvvsPluginResult_t &result,
                                              std::vector<dcgmDiagPluginEntityInfo_v1> const &entityInfos);
 
+    /**
+     * Cheap screen for CheckCommonErrors() that only looks at the latest values of the fields it checks, so its cost
+     * doesn't depend on how long ago startTime was. The first value since startTime of each field that is checked by
+     * its difference is read once and kept in screen.
+     *
+     * Transient values between two calls, like a temperature spike, are not seen. CheckCommonErrors() still has to
+     * run at the end of the test.
+     *
+     * @return true if CheckCommonErrors() may find an error, or if the latest values can't be read
+     */
+    bool MayHaveCommonErrors(TestParameters &tp,
+                             timelib64_t startTime,
+                             std::vector<dcgmDiagPluginEntityInfo_v1> const &entityInfos,
+                             CommonErrorsScreen &screen);
+
     /*
      */
     long long DetermineMaxTemp(const dcgmDiagPluginEntityInfo_v1 &entityInfo);
@@ -374,6 +400,7 @@ private:
     DcgmValuesSinceHolder m_valuesHolder;
 
     long long m_nextValuesSinceTs;
+    long long m_valuesHolderSinceTs; //!< m_valuesHolder has every sample since this ts. -1 if it may have gaps
     long long m_watchFrequency;
 
     CustomStatHolder m_customStatHolder;
@@ -405,6 +432,22 @@ private:
      */
     std::string GetWatchedFieldsAsJson(Json::Value &jv, long long ts);
 
+    /*
+     * Helper method to write the watched fields to a stream as JSON Lines, one sample per line
+     */
+    std::string WriteWatchedFieldsAsJsonLines(std::ostream &out, long long ts);
+
+    /*
+     * Helper method to write the watched fields to a stream in the layout of GetWatchedFieldsAsJson(),
+     * without building the whole json object first
+     */
+    std::string WriteWatchedFieldsAsJson(std::ostream &out, long long ts);
+
+    /*
+     * Helper method to make sure we have all of the watched fields' values since ts
+     */
+    std::string QueryWatchedFields(long long ts);
+
     /*
      * Helper method to create a group in DCGM
      */
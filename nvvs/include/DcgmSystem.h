@@ -91,6 +91,20 @@ public:
                                    unsigned int flags,
                                    dcgmFieldValue_v2 &value);
 
+    /*
+     * Retrieves the latest field values for the specified gpus in one request. values is filled with one
+     * dcgmFieldValue_v2 per gpu and field, identified by their entityId and fieldId.
+     * @return:
+     *
+     * DCGM_ST_OK       : success
+     * DCGM_ST_BADPARAM : if the handle hasn't been initialized
+     * DCGM_ST_*        : if returned from calls to DCGM
+     */
+    dcgmReturn_t GetLatestValuesForGpus(const std::vector<unsigned int> &gpuIds,
+                                        std::vector<unsigned short> &fieldIds,
+                                        unsigned int flags,
+                                        std::vector<dcgmFieldValue_v2> &values);
+
     /*
      * Retrieves the latest field values for the specified gpus and calls the given
      * dcgmFieldValueEntityEnumeration_f (checker) with the retrieved data and userData.
@@ -24,6 +24,8 @@
 
 #include "DcgmError.h"
 #include "DcgmFvBuffer.h"
+#include "DcgmJsonWriter.hpp"
+#include "StatsJsonLinesWriter.h"
 #include "dcgm_agent.h"
 #include "dcgm_fields.h"
 #include "dcgm_structs.h"
@@ -57,6 +59,8 @@ public:
      * Returns the first non-zero value in the cache for the specified field id.
      * If mask is non-zero and this is an int 64 type, then the bitmask is applied and the value is only
      * returned if it is non-zero after applying the bitmask.
+     *
+     * Answered from the state kept by AddValue() rather than by walking the timeseries
      */
     void GetFirstNonZero(unsigned short fieldId, dcgmFieldValue_v1 &dfv, uint64_t mask);
 
@@ -65,14 +69,53 @@ public:
      */
     void AddToJson(Json::Value &jv, unsigned int jsonIndex);
 
+    /*
+     * Write this timeseries as JSON Lines for the GPU at the specified index
+     */
+    void WriteJsonLines(StatsJsonLinesWriter &writer, unsigned int jsonIndex);
+
+    /*
+     * Write this timeseries as the object AddToJson() would build, merged with the members of custom.
+     * Members of custom named like one of the fields are appended to that field's samples
+     */
+    void WriteJson(DcgmNs::JsonSerialize::JsonWriter &writer, Json::Value const &custom);
+
     friend class DcgmValuesSinceHolder;
 
 private:
+    /*
+     * What the checks need to know about one field's timeseries, updated as each value is added so
+     * that repeated checks during a test don't rescan every sample
+     */
+    struct FieldState
+    {
+        bool hasPrev = false;
+        dcgmFieldValue_v1 prev {}; //!< The last value added
+
+        bool hasFirstNonZero = false;
+        dcgmFieldValue_v1 firstNonZero {}; //!< The first non-zero, non-blank value
+
+        uint64_t seenBits = 0;                  //!< OR of every non-blank int64 value
+        std::vector<dcgmFieldValue_v1> newBits; //!< The int64 values that set a bit no earlier value had
+
+        /*
+         * Differences from the previous value that are larger than every earlier difference, with the timestamp
+         * of the later value. The first difference at or above any threshold is always one of these.
+         * Both views of the value are kept since the threshold's type decides which one is compared
+         */
+        std::vector<std::pair<timelib64_t, int64_t>> i64DeltaRecords;
+        std::vector<std::pair<timelib64_t, double>> dblDeltaRecords;
+
+        void Update(dcgmFieldValue_v1 const &value);
+    };
+
     dcgm_field_eid_t m_entityId = { 0 }; //!< entity id that we're dealing with
     // Map of fieldIds to values in timeseries order
     std::unordered_map<unsigned short, DcgmFvBuffer> m_fieldValueTimeSeries;
     // Map of fieldIds to the timestamps we've seen for that fieldId
     std::unordered_map<unsigned short, std::unordered_set<timelib64_t>> m_seenTimestamps;
+    // Map of fieldIds to the state of their timeseries
+    std::unordered_map<unsigned short, FieldState> m_fieldStates;
 
     inline bool IsValueInCache(unsigned short fieldId, dcgmFieldValue_v1 const &value);
     inline void AddValueToCache(unsigned short fieldId, dcgmFieldValue_v1 const &value);
@@ -115,9 +158,20 @@ public:
      */
     void AddToJson(Json::Value &jv);
 
+    /*
+     * Write the stored values as JSON Lines, in the same layout as AddToJson()
+     */
+    void WriteJsonLines(StatsJsonLinesWriter &writer);
+
+    /*
+     * Write the JSON GPUs array that AddToJson() would build, without building it. Elements of customGpus
+     * are merged into the GPU at the same index
+     */
+    void WriteJson(DcgmNs::JsonSerialize::JsonWriter &writer, Json::Value const &customGpus);
+
     /*
      * Returns true if the specified field value for the specified GPU ever meets or exceeds the threshold given
-     * in the field value
+     * in the field value. Only looks at the record differences kept as values are added
      */
     bool DoesValuePassPerSecondThreshold(unsigned short fieldId,
                                          const dcgmFieldValue_v1 &dfv,
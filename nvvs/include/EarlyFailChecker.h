@@ -45,4 +45,5 @@ protected:
     unsigned long m_lastCheckTime     = ULONG_MAX;
     std::vector<DcgmError> m_errors;
     std::vector<dcgmDiagPluginEntityInfo_v1> m_entityInfos;
+    CommonErrorsScreen m_screen;
 };
@@ -51,6 +51,19 @@ public:
         return true;
     }
 
+    /**
+     * @brief Hand the diag response back to the caller.
+     *
+     * If responseFd is a sealed shared memory region big enough for the response, the response is copied
+     * there and only a small dcgmDiagResponseReady_v1 frame is written to m_channelFd. Otherwise the whole
+     * response is written as a frame, like Write().
+     *
+     * @param response The diag response, starting with its version.
+     * @param responseFd The region passed with --response-fd, or -1.
+     * @return true if the caller was sent the response.
+     */
+    [[nodiscard]] bool WriteResponse(std::span<char const> response, int responseFd) const;
+
 private:
     /**
      * @brief Write a buffer to m_channelFd and returns an error_code if an error occurs.
@@ -16,9 +16,9 @@
 #ifndef GOLDEN_VALUE_CALCULATOR_H
 #define GOLDEN_VALUE_CALCULATOR_H
 
+#include <cstdint>
 #include <map>
 #include <string>
-#include <vector>
 
 #include "Plugin.h"
 #include "dcgm_structs.h"
@@ -35,8 +35,77 @@ typedef struct
     valueWithVariance_t calculatedValue; //!< The value and its variance
 } dcgmGpuToValue_t;
 
-typedef std::map<std::string, std::map<unsigned int, std::vector<double>>> paramToGpuToValues_t;
-typedef std::map<std::string, std::vector<double>> paramToValues_t;
+/*****************************************************************************/
+/*
+ * Running mean and variance of a series of observations, kept with Welford's
+ * algorithm so that the observations themselves don't have to be stored.
+ * Accumulators of disjoint sets of observations can be merged, which is how the
+ * partial results of many nodes are combined.
+ */
+class GoldenValueAccumulator
+{
+public:
+    /*************************************************************************/
+    void Add(double value)
+    {
+        m_count++;
+        double const delta = value - m_mean;
+        m_mean += delta / m_count;
+        m_m2 += delta * (value - m_mean);
+    }
+
+    /*************************************************************************/
+    /*
+     * Add the observations of other, as if each of them had been passed to Add()
+     */
+    void Merge(GoldenValueAccumulator const &other)
+    {
+        if (other.m_count == 0)
+        {
+            return;
+        }
+        if (m_count == 0)
+        {
+            *this = other;
+            return;
+        }
+
+        std::uint64_t const count = m_count + other.m_count;
+        double const delta        = other.m_mean - m_mean;
+        m_mean += delta * other.m_count / count;
+        m_m2 += other.m_m2 + delta * delta * ((double)m_count * other.m_count / count);
+        m_count = count;
+    }
+
+    /*************************************************************************/
+    std::uint64_t Count() const
+    {
+        return m_count;
+    }
+
+    /*************************************************************************/
+    double Mean() const
+    {
+        return m_mean;
+    }
+
+    /*************************************************************************/
+    /*
+     * Population variance of the observations. 0 if there are none
+     */
+    double Variance() const
+    {
+        return m_count == 0 ? 0.0 : m_m2 / m_count;
+    }
+
+private:
+    std::uint64_t m_count = 0;
+    double m_mean         = 0.0;
+    double m_m2           = 0.0; //!< Sum of the squared differences from the mean
+};
+
+typedef std::map<std::string, std::map<unsigned int, GoldenValueAccumulator>> paramToGpuToValues_t;
+typedef std::map<std::string, GoldenValueAccumulator> paramToValues_t;
 
 class GoldenValueCalculator
 {
@@ -55,6 +124,31 @@ public:
      */
     void RecordGoldenValueInputs(const std::string &testName, const observedMetrics_t &metrics);
 
+    /*************************************************************************/
+    /*
+     * Add the inputs recorded by other, e.g. the partial results of another node
+     */
+    void Merge(GoldenValueCalculator const &other)
+    {
+        for (auto const &[testname, params] : other.m_inputs)
+        {
+            for (auto const &[paramName, acc] : params)
+            {
+                m_inputs[testname][paramName].Merge(acc);
+            }
+        }
+        for (auto const &[testname, params] : other.m_inputsPerGpu)
+        {
+            for (auto const &[paramName, gpus] : params)
+            {
+                for (auto const &[gpuId, acc] : gpus)
+                {
+                    m_inputsPerGpu[testname][paramName][gpuId].Merge(acc);
+                }
+            }
+        }
+    }
+
     /*************************************************************************/
     /*
      * Calculate and write the golden values and store them in m_calculatedGoldenValues using the inputs
@@ -67,9 +161,9 @@ public:
     dcgmReturn_t CalculateAndWriteGoldenValues(const std::string &filename);
 
 protected:
-    // "testname.parameter" -> array of values
+    // "testname.parameter" -> running mean and variance of the values
     std::map<std::string, paramToValues_t> m_inputs;
-    // "testname.parameter" -> gpuId -> array of values
+    // "testname.parameter" -> gpuId -> running mean and variance of the values
     std::map<std::string, paramToGpuToValues_t> m_inputsPerGpu;
     // "testname.parameter" -> gpuId -> average value
     std::map<std::string, std::map<std::string, dcgmGpuToValue_t>> m_averageGpuValues;
@@ -96,7 +190,7 @@ protected:
      */
     inline void AddToAllInputs(const std::string &testname, const std::string &paramName, double value)
     {
-        m_inputs[testname][paramName].push_back(value);
+        m_inputs[testname][paramName].Add(value);
     }
 
     /*************************************************************************/
@@ -108,14 +202,17 @@ protected:
                                   unsigned int gpuId,
                                   double value)
     {
-        m_inputsPerGpu[testname][paramName][gpuId].push_back(value);
+        m_inputsPerGpu[testname][paramName][gpuId].Add(value);
     }
 
     /*************************************************************************/
     /*
-     * Returns a calculated mean and variance for the data in the vector
+     * Returns the mean and variance of the values recorded in the accumulator
      */
-    valueWithVariance_t CalculateMeanAndVariance(std::vector<double> &data) const;
+    valueWithVariance_t CalculateMeanAndVariance(GoldenValueAccumulator const &acc) const
+    {
+        return { acc.Mean(), acc.Variance() };
+    }
 
     /*************************************************************************/
     /*
@@ -28,6 +28,7 @@
 #include "Gpu.h"
 #include "NvvsCommon.h"
 #include "ParameterValidator.h"
+#include "PhaseTimings.h"
 #include "Test.h"
 #include "TestFramework.h"
 #include "TestParameters.h"
@@ -121,6 +122,7 @@ protected:
     struct sigaction restoreSigAction;
     unsigned int initWaitTime;
     ParameterValidator m_pv;
+    PhaseTimings m_phaseTimings; /* Of the phases of Go() before the tests run */
 
     /***************************PROTECTED********************************/
 protected:
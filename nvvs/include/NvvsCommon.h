@@ -51,7 +51,8 @@ enum logFileType_enum
 {
     NVVS_LOGFILE_TYPE_JSON,  /* JSON data without line breaks */
     NVVS_LOGFILE_TYPE_TEXT,  /* Indented plain text */
-    NVVS_LOGFILE_TYPE_BINARY /* Binary log format */
+    NVVS_LOGFILE_TYPE_BINARY,    /* Binary log format */
+    NVVS_LOGFILE_TYPE_JSON_LINES /* JSON Lines, one sample per line. See StatsJsonLinesWriter */
     /* Note if you add values here, you must change the ranges where this
      * is used in tp->AddDouble(). Currently NvidiaValidationSuite.cpp */
 };
@@ -115,6 +116,7 @@ public:
     unsigned int totalIterations;     /* the total number of iterations of the diagnostic that will run. */
     std::string entityIds;            // Comma-separated list of entity ids.
     int channelFd;                    // A file description used to send back response to caller.
+    int responseFd;                   // Shared memory region to write the diag response to, or -1.
     unsigned int diagResponseVersion; // The version of diag response to be returned via channel-fd.
     bool rerunAsRoot;                 // Flag indicating if this round is the second attemping or not.
     unsigned int watchFrequency;      // The watch frequency for fields being watched
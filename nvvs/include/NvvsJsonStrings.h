@@ -51,5 +51,9 @@
 #define NVVS_ENTITY_DEVICE_ID "device_id"
 #define NVVS_TEST_SUMMARY     "test_summary"
 #define NVVS_METADATA         "metadata"
+#define NVVS_PHASE_TIMINGS    "phase_timings_usec"
+#define NVVS_PHASE_SUITE      "suite"
+#define NVVS_PHASE_PLUGIN     "plugin"
+#define NVVS_PHASE_TEST       "test"
 
 #endif
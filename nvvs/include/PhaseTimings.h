@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "json/json.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Wall time spent in each named phase of a diag run, such as connecting to the host
+ * engine, loading a plugin or running a test. Reported in the aux data of each test
+ * under NVVS_PHASE_TIMINGS so that slow runs show where the time went.
+ */
+class PhaseTimings
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /*
+     * Adds the time from its construction to its destruction to phase
+     */
+    class Scope
+    {
+    public:
+        Scope(PhaseTimings &timings, std::string phase);
+        ~Scope();
+
+        Scope(Scope const &)            = delete;
+        Scope &operator=(Scope const &) = delete;
+
+    private:
+        PhaseTimings &m_timings;
+        std::string m_phase;
+        Clock::time_point m_start;
+    };
+
+    /********************************************************************/
+    /*
+     * Adds elapsed to phase. A phase that is timed more than once gets the total
+     */
+    void Add(std::string const &phase, Clock::duration elapsed);
+
+    /********************************************************************/
+    /*
+     * Returns the microseconds spent in phase. 0 if it was never timed
+     */
+    long long GetUsec(std::string const &phase) const;
+
+    /********************************************************************/
+    bool Empty() const;
+    void Clear();
+
+    /********************************************************************/
+    /*
+     * Returns an object of phase name -> microseconds
+     */
+    Json::Value ToJson() const;
+
+private:
+    std::vector<std::pair<std::string, long long>> m_usec; /* In the order phases were first timed */
+};
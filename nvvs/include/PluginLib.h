@@ -64,6 +64,17 @@ public:
     /*****************************************************************************/
     dcgmReturn_t LoadPlugin(const std::string &path, const std::string &name);
 
+    /*****************************************************************************/
+    /*
+     * Keep plugin libraries in memory after they are closed, so loading one again only looks it up instead of
+     * relocating it and running its initializers again. Used by the NVVS worker, which loads the plugins for every run.
+     */
+    static void SetKeepLoaded(bool keepLoaded);
+
+    /*****************************************************************************/
+    /* The dlopen() flags for plugin libraries */
+    static int GetDlopenFlags();
+
     /*****************************************************************************/
     /** For testing. Register the specified callbacks without loading plugin library.*/
     void RegisterCallbacks(PluginCallbacks_v1 const &cb);
@@ -112,6 +123,13 @@ public:
 
     const std::optional<std::any> &GetAuxData(std::string const &testName) const;
 
+    /*****************************************************************************/
+    /*
+     * Time spent loading, initializing and querying the plugin, and in each phase of the last run of testName
+     */
+    PhaseTimings const &GetLoadTimings() const;
+    PhaseTimings const &GetPhaseTimings(std::string const &testName) const;
+
     dcgm_field_entity_group_t GetTargetEntityGroup(std::string const &testName) const;
 
     const dcgmDiagEntityResults_v1 &GetEntityResults(std::string const &testName) const;
@@ -134,6 +152,7 @@ private:
     std::string m_pluginName;
     std::string m_description;
     std::vector<unsigned short> m_statFieldIds;
+    PhaseTimings m_loadTimings;
 
     std::unordered_map<std::string, PluginLibTest> m_tests;
 
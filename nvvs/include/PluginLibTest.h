@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "PhaseTimings.h"
 #include "PluginInterface.h"
 #include "TestParameters.h"
 #include "dcgm_fields.h"
@@ -46,6 +47,8 @@ public:
     std::string const &GetTestCategory() const;
     dcgmDiagEntityResults_v1 const &GetEntityResults() const;
     std::optional<std::any> const &GetAuxData() const;
+    PhaseTimings const &GetPhaseTimings() const;
+    PhaseTimings &GetPhaseTimings();
     nvvsPluginResult_t GetResult() const;
     dcgm_field_entity_group_t GetTargetEntityGroup() const;
     std::vector<dcgmDiagPluginParameterInfo_t> GetParameterInfo() const;
@@ -71,6 +74,7 @@ private:
     std::vector<dcgmDiagPluginParameterInfo_t> m_parameterInfo;
     TestParameters m_testParameters;
     std::optional<std::any> m_auxData;
+    PhaseTimings m_phaseTimings; /* Of the last run */
     dcgmDiagEntityResults_v1 m_entityResult {};
     TestRuningState m_testRunningState = TestRuningState::Pending;
 };
\ No newline at end of file
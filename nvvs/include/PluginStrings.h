@@ -68,6 +68,7 @@
 #define PCIE_STR_DISABLE_TESTS            "disable_tests"
 #define PCIE_STR_AER_THRESHOLD            "aer_threshold" /* max pci aer errors before test fails */
 #define PCIE_STR_DONT_BIND_NUMA           "dont_bind_numa"
+#define PCIE_STR_CONCURRENT_PAIRS         "concurrent_pairs" /* measure disjoint GPU pairs of P2P matrices at once */
 
 /* Private parameters */
 #define PCIE_STR_IS_ALLOWED "is_allowed" /* Is the busgrind plugin allowed to run? */
@@ -213,6 +214,10 @@
 #define TS_STR_USE_DGEMM            "use_dgemm"
 #define TS_STR_CUDA_STREAMS_PER_GPU "cuda_streams_per_gpu"
 #define TS_STR_CUDA_OPS_PER_STREAM  "ops_per_stream_queue"
+#define TS_STR_AUTOTUNE             "autotune" /* Time a few gemm configurations and use the fastest */
+#define TS_STR_AUTOTUNE_CACHE                                                                                     \
+    "autotune_cache" /* File the chosen gemm configuration is saved to per GPU name so later runs can skip the \
+                        timing. Empty to always time them */
 
 #define TS_STR_MAX_PCIE_REPLAYS                                                                                     \
     "max_pcie_replays" /* Maximum PCIe replays allowed per device while the plugin runs. If more replays occur than \
@@ -254,6 +259,7 @@
 #define MEMORY_L1TAG_STR_IS_ALLOWED              "l1_is_allowed" /* Is the l1tag subtest allowed to run? */
 #define MEMORY_L1TAG_STR_TEST_DURATION           "test_duration"
 #define MEMORY_L1TAG_STR_TEST_LOOPS              "test_loops"
+#define MEMORY_L1TAG_STR_LAUNCHES_PER_SYNC       "launches_per_sync" /* Kernel launches between host syncs. 0 = auto */
 #define MEMORY_L1TAG_STR_INNER_ITERATIONS        "inner_iterations"
 #define MEMORY_L1TAG_STR_ERROR_LOG_LEN           "log_len"
 #define MEMORY_L1TAG_STR_DUMP_MISCOMPARES        "dump_miscompares"
@@ -319,6 +325,9 @@
 #define DIAGNOSTIC_STR_PRECISION           "precision"       /* The precision to use: half, single, or double */
 #define DIAGNOSTIC_STR_GFLOPS_TOLERANCE_PCNT \
     "gflops_tolerance_pcnt" /* % of mean below which gflops are treated as errors */
+#define DIAGNOSTIC_STR_DEVICE_STATS                                                                                  \
+    "device_stats" /* Keep the error counters on the GPU and read them back about once per second, running the GEMM \
+                      and compare loop as a CUDA graph */
 
 /****************************************************************************
  * CONTEXT CREATE PLUGIN
@@ -372,6 +381,9 @@
 
 #define NVBANDWIDTH_STR_IS_ALLOWED "is_allowed" /* Is the plugin allowed to run */
 #define NVBANDWIDTH_STR_TESTCASES  "testcases"  /* test case separated by , e.g, 0,1,2 */
+#define NVBANDWIDTH_STR_CACHE_FILE "cache_file" /* File that keeps the results of passed testcases. When set, only \
+                                                   testcases whose GPUs changed since they were cached are run. \
+                                                   Cached testcases are looked up by name */
 
 /*****************************************************************************
  * PER PLUGIN ERROR DEFINITIONS AND THEIR BITMASKS
@@ -23,9 +23,13 @@
 #include "TestParameters.h"
 #include <DcgmRecorder.h>
 #include <NvvsStructs.h>
+#include <future>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 class Software : public Plugin
@@ -52,6 +56,15 @@ public:
      */
     bool CountDevEntry(const std::string &entryName);
 
+    /*
+     * Start the library loads, file system scans and DCGM field reads the checks need in the background, so they
+     * overlap each other instead of running one check at a time. The field values of every GPU are read in one
+     * request. A check that finds nothing prefetched does its own work, so this is optional.
+     *
+     * @param entityList - the entities the checks will run on
+     */
+    void Prefetch(dcgmDiagPluginEntityList_v1 const &entityList);
+
     std::string GetSoftwareTestName() const;
     std::string GetSoftwareTestCategory() const;
 
@@ -65,6 +78,16 @@ private:
         CHECK_CUDATK, // CUDA toolkit libraries (blas, fft, etc.)
     };
 
+    /* The driver symlink of a PCI device in sysfs */
+    struct DriverLink
+    {
+        std::string path;   // Path of the symlink
+        int error = 0;      // errno from reading it, or 0
+        std::string driver; // Name of the driver it points to if error is 0
+    };
+
+    using FieldValueKey = std::pair<unsigned int, unsigned short>; // gpuId, fieldId
+
     // variables
     std::string myArgs;
     std::string m_subtestName;
@@ -74,13 +97,26 @@ private:
     dcgmHandle_t m_handle;
     std::unique_ptr<dcgmDiagPluginEntityList_v1> m_entityInfo;
 
+    // Results started by Prefetch(). Invalid until then
+    std::map<std::string, std::shared_future<std::string>> m_libraryErrors; // library -> dlopen error, empty if found
+    std::shared_future<std::vector<DriverLink>> m_driverLinks;
+    std::shared_future<std::optional<std::vector<std::string>>> m_devEntries;
+    std::shared_future<std::map<FieldValueKey, dcgmFieldValue_v2>> m_fieldValues;
+
     // methods
     void addError(DcgmError &d);
     bool checkPermissions(bool checkFileCreation, bool skipDevTest);
     bool checkLibraries(libraryCheck_t libs);
     bool checkDenylist();
-    bool findLib(std::string, std::string &error);
-    int checkDriverPathDenylist(std::string, std::vector<std::string> const &);
+    static bool findLib(std::string, std::string &error);
+    int checkDriverPathDenylist(DriverLink const &, std::vector<std::string> const &);
+    static std::vector<DriverLink> ScanDriverLinks();
+    static std::optional<std::vector<std::string>> ScanDevEntries();
+    static std::string FindLibCached(std::string const &library);
+    dcgmReturn_t GetFieldValue(unsigned int gpuId,
+                               unsigned short fieldId,
+                               dcgmFieldValue_v2 &value,
+                               unsigned int flags);
     int checkPersistenceMode(dcgmDiagPluginEntityList_v1 const &entityList);
     int checkForGraphicsProcesses();
     int checkForBadEnvVaribles();
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "json/json.h"
+
+/*
+ * Writes a stats file as JSON Lines: one small JSON object per line, each naming where it goes in the
+ * layout of the JSON stats file. Nothing is buffered beyond the line being written, so the memory used
+ * doesn't grow with the length of the test.
+ *
+ * Lines are one of:
+ *  {"gpuIndex": i, "gpuId": id}                                    - jv[GPUS][i]["gpuId"] = id
+ *  {"gpuIndex": i, "stat": s}                                      - jv[GPUS][i][s] is an (empty) array
+ *  {"gpuIndex": i, "stat": s, "timestamp": ts, "value": v}         - appended to jv[GPUS][i][s]
+ *  {"group": g, "stat": s, "timestamp": ts, "value": v}            - appended to jv[g][s]
+ *  {"group": g, "stat": s, "value": "v"}                           - jv[g][s] = "v"
+ *
+ * ConvertToJson() rebuilds the JSON stats file layout from them.
+ */
+class StatsJsonLinesWriter
+{
+public:
+    explicit StatsJsonLinesWriter(std::ostream &out);
+
+    /*
+     * Record that the GPU at gpuIndex in the JSON layout is gpuId
+     */
+    void WriteGpu(unsigned int gpuIndex, unsigned int gpuId);
+
+    /*
+     * Start the timeseries stat for the GPU at gpuIndex, even if no samples follow
+     */
+    void WriteGpuStat(unsigned int gpuIndex, std::string const &stat);
+
+    /*
+     * Add a sample to the timeseries stat for the GPU at gpuIndex
+     */
+    void WriteGpuSample(unsigned int gpuIndex, std::string const &stat, long long timestamp, Json::Value const &value);
+
+    /*
+     * Add a sample to the timeseries stat grouped by name instead of by GPU
+     */
+    void WriteGroupSample(std::string const &group,
+                          std::string const &stat,
+                          long long timestamp,
+                          Json::Value const &value);
+
+    /*
+     * Set a non-timeseries stat of the group
+     */
+    void WriteGroupString(std::string const &group, std::string const &stat, std::string const &value);
+
+    /*
+     * Rebuild the JSON stats file layout from JSON Lines written by this class
+     *
+     * @return: true on success
+     *          false if a line can't be parsed. error is set to why
+     */
+    static bool ConvertToJson(std::istream &in, Json::Value &jv, std::string &error);
+
+private:
+    std::ostream &m_out;
+    std::unique_ptr<Json::StreamWriter> m_writer;
+
+    void WriteLine(Json::Value const &line);
+};
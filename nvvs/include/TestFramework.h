@@ -22,6 +22,8 @@
 #ifndef _NVVS_NVVS_TestFramework_H
 #define _NVVS_NVVS_TestFramework_H
 
+#include <atomic>
+#include <mutex>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -31,9 +33,11 @@
 #include "GoldenValueCalculator.h"
 #include "GpuSet.h"
 #include "NvvsStructs.h"
+#include "PhaseTimings.h"
 #include "PluginLib.h"
 #include "SoftwarePluginFramework.h"
 #include "Test.h"
+#include "TestResourceLocks.h"
 
 #include <DcgmNvvsResponseWrapper.h>
 #include <dcgm_structs.h>
@@ -84,11 +88,17 @@ public:
 
     dcgmReturn_t SetDiagResponseVersion(unsigned int version);
 
+    /********************************************************************/
+    /*
+     * Sets the timings of the phases before the tests, which are reported with the timings of each test
+     */
+    void SetSuiteTimings(PhaseTimings const &timings);
+
 protected:
     std::vector<Test *> m_testList;
     std::map<std::string, std::vector<Test *>> m_testCategories;
     std::list<void *> dlList;
-    bool skipRest;
+    std::atomic_bool skipRest;
     mode_t m_nvvsBinaryMode;
     uid_t m_nvvsOwnerUid;
     gid_t m_nvvsOwnerGid;
@@ -97,6 +107,11 @@ protected:
     DcgmNvvsResponseWrapper m_diagResponse;
     unsigned int m_completedTests;
     unsigned int m_numTestsToRun;
+    // Protects m_diagResponse and m_completedTests while entity sets run concurrently
+    std::mutex m_responseMutex;
+    // Keeps tests that share a plugin or a resource from overlapping
+    TestResourceLocks m_resourceLocks;
+    PhaseTimings m_suiteTimings;
 
     // new plugin loading
     std::vector<std::unique_ptr<PluginLib>> m_plugins;
@@ -110,6 +125,12 @@ protected:
                 std::vector<Test *> testsList,
                 EntitySet *entitySet,
                 bool checkFileCreation);
+
+    /********************************************************************/
+    /*
+     * Runs every test class of entitySet in order. Called on its own thread for each entity set
+     */
+    void GoEntitySet(EntitySet *entitySet, bool checkFileCreation);
     void LoadLibrary(const char *libPath, const char *libName);
     void StartStatWatches(DcgmRecorder &dcgmRecorder, int pluginIndex, std::vector<Gpu *> gpuList);
     void EndStatWatches(DcgmRecorder &dcgmRecorder,
@@ -166,6 +187,13 @@ protected:
      * Writes dcgmDiagStatus_t to the NVVS channel
      */
     void WriteDiagStatusToChannel(std::string_view pluginName, unsigned int errorCode) const;
+
+    /********************************************************************/
+    /*
+     * Writes the dcgmDiagTestCompletion_t of testName to the NVVS channel.
+     * The caller must hold m_responseMutex if entity sets are running
+     */
+    void WriteTestCompletionToChannel(std::string_view testName) const;
 };
 
 #endif //  _NVVS_NVVS_TestFramework_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <string_view>
+
+/*
+ * Shared resources that a test stresses beyond the entities it runs on. Two tests that
+ * share one of these must not run at the same time even when their entities are disjoint
+ */
+enum TestResource : unsigned int
+{
+    TEST_RESOURCE_NONE   = 0x0,
+    TEST_RESOURCE_PCIE   = 0x1, /* PCIe bus bandwidth */
+    TEST_RESOURCE_NVLINK = 0x2, /* NVLink fabric bandwidth */
+    TEST_RESOURCE_POWER  = 0x4, /* The node's power budget */
+};
+
+/*
+ * Lets tests on disjoint entity sets run concurrently. A test holds its plugin and its
+ * resources while it runs. Tests that share a plugin or a resource wait for each other.
+ */
+class TestResourceLocks
+{
+public:
+    /********************************************************************/
+    /*
+     * Returns the TEST_RESOURCE_* mask of the resources the named test stresses
+     */
+    static unsigned int GetTestResources(std::string_view testName);
+
+    /********************************************************************/
+    /*
+     * Blocks until no other test holds pluginIndex or any of resources, then takes all of them.
+     * Everything is taken at once so that two tests can't each wait on what the other holds
+     */
+    void Acquire(unsigned int pluginIndex, unsigned int resources);
+
+    /********************************************************************/
+    /*
+     * Gives back what Acquire() took
+     */
+    void Release(unsigned int pluginIndex, unsigned int resources);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    unsigned int m_heldResources = TEST_RESOURCE_NONE;
+    std::set<unsigned int> m_heldPlugins;
+};
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <sstream>
+#include <thread>
 
 #include "ContextCreate.h"
 #include "ContextCreatePlugin.h"
@@ -142,21 +143,38 @@ void ContextCreate::Cleanup()
 int ContextCreate::CanCreateContext()
 {
     int created = CTX_CREATED;
-    CUresult cuSt;
-    std::stringstream err;
     std::string error;
 
+    /* Context creation takes long enough on each GPU that doing them one after another dominates the test.
+       Create them all at once and report the results in GPU order afterwards */
+    std::vector<CUresult> results(m_device.size(), CUDA_SUCCESS);
+    {
+        std::vector<std::jthread> createThreads;
+        createThreads.reserve(m_device.size());
+        for (size_t i = 0; i < m_device.size(); i++)
+        {
+            createThreads.emplace_back([this, &results, i] {
+                ContextCreateDevice *device = m_device[i];
+                results[i]                  = cuCtxCreate(&device->cuContext, 0, device->cuDevice);
+                if (results[i] == CUDA_SUCCESS)
+                {
+                    cuCtxDestroy(device->cuContext);
+                }
+            });
+        }
+    } // Joins the threads
+
     for (size_t i = 0; i < m_device.size(); i++)
     {
-        cuSt = cuCtxCreate(&m_device[i]->cuContext, 0, m_device[i]->cuDevice);
+        CUresult const cuSt = results[i];
 
         if (cuSt == CUDA_SUCCESS)
         {
-            cuCtxDestroy(m_device[i]->cuContext);
             continue;
         }
         else if (cuSt == CUDA_ERROR_UNKNOWN)
         {
+            std::stringstream err;
             err << "GPU " << m_device[i]->gpuId << " is in prohibted mode; skipping test.";
             m_plugin->AddInfo(m_plugin->GetCtxCreateTestName(), err.str());
             log_debug(err.str());
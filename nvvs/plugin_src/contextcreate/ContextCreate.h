@@ -128,7 +128,8 @@ public:
 
     /*************************************************************************/
     /*
-     * Attempt to create a context for each GPU in the list
+     * Attempt to create a context for each GPU in the list. The GPUs are tried
+     * in parallel, one thread each, and their results are reported in order
      *
      * @return:  0 on success
      *           1 for skipping
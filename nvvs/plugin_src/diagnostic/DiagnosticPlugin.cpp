@@ -19,6 +19,8 @@
 #include <fmt/format.h>
 #include <numeric>
 #include <stdint.h>
+#include <thread>
+#include <vector>
 
 #include "DiagnosticPlugin.h"
 #include "gpuburn_ptx_string.h"
@@ -81,6 +83,7 @@ GpuBurnPlugin::GpuBurnPlugin(dcgmHandle_t handle)
     , m_gflopsTolerancePcnt(0.0)
     , m_precision(DIAG_SINGLE_PRECISION)
     , m_matrixDim(2048)
+    , m_deviceStats(false)
 {
     m_infoStruct.testIndex      = DCGM_DIAGNOSTIC_INDEX;
     m_infoStruct.testCategories = "Hardware";
@@ -97,6 +100,7 @@ GpuBurnPlugin::GpuBurnPlugin(dcgmHandle_t handle)
     m_testParameters->AddString(DIAGNOSTIC_STR_IS_ALLOWED, "False");
     m_testParameters->AddDouble(DIAGNOSTIC_STR_MATRIX_DIM, 2048.0);
     m_testParameters->AddDouble(DIAGNOSTIC_STR_GFLOPS_TOLERANCE_PCNT, 0.0);
+    m_testParameters->AddString(DIAGNOSTIC_STR_DEVICE_STATS, "False");
     m_testParameters->AddString(PS_LOGFILE, "stats_diagnostic.json");
     m_testParameters->AddDouble(PS_LOGFILE_TYPE, 0.0);
 
@@ -352,6 +356,7 @@ void GpuBurnPlugin::Go(std::string const &testName,
     m_sbeFailureThreshold = m_testParameters->GetDouble(DIAGNOSTIC_STR_SBE_ERROR_THRESHOLD);
     m_matrixDim           = static_cast<unsigned int>(m_testParameters->GetDouble(DIAGNOSTIC_STR_MATRIX_DIM));
     m_gflopsTolerancePcnt = m_testParameters->GetDouble(DIAGNOSTIC_STR_GFLOPS_TOLERANCE_PCNT);
+    m_deviceStats         = m_testParameters->GetBoolFromString(DIAGNOSTIC_STR_DEVICE_STATS);
 
     std::string useDoubles = m_testParameters->GetString(DIAGNOSTIC_STR_USE_DOUBLES);
     bool supportsDoubles   = false;
@@ -455,20 +460,51 @@ bool GpuBurnPlugin::RunTest(dcgmDiagPluginEntityList_v1 const *entityInfo)
     /* Catch any runtime errors */
     try
     {
-        /* Create and initialize worker threads */
+        /* Create worker threads */
         for (size_t i = 0; i < m_device.size(); i++)
         {
-            unsigned int gpuId = m_device[i]->gpuId; /* Cache for logging as the device may get freed */
-            DCGM_LOG_DEBUG << "Creating worker thread for GPU " << gpuId;
-            workerThreads[i] = new GpuBurnWorker(
-                m_device[i], *this, m_precision, m_testDuration, m_matrixDim, m_dcgmRecorder, failEarly, checkInterval);
-            // initialize the worker
-            st = workerThreads[i]->InitBuffers();
+            DCGM_LOG_DEBUG << "Creating worker thread for GPU " << m_device[i]->gpuId;
+            workerThreads[i] = new GpuBurnWorker(m_device[i],
+                                                 *this,
+                                                 m_precision,
+                                                 m_testDuration,
+                                                 m_matrixDim,
+                                                 m_dcgmRecorder,
+                                                 failEarly,
+                                                 checkInterval,
+                                                 m_deviceStats);
+        }
+
+        /* Initialize every worker at once. Loading the compare kernel JIT-compiles it for each GPU */
+        std::vector<int> initResults(m_device.size(), 0);
+        {
+            std::vector<std::jthread> initThreads;
+            initThreads.reserve(m_device.size());
+            for (size_t i = 0; i < m_device.size(); i++)
+            {
+                initThreads.emplace_back([&initResults, &workerThreads, i] {
+                    try
+                    {
+                        initResults[i] = workerThreads[i]->InitBuffers();
+                    }
+                    catch (std::exception const &ex)
+                    {
+                        log_error("Unable to initialize worker {}: {}", i, ex.what());
+                        initResults[i] = -1;
+                    }
+                });
+            }
+        } // Joins the threads
+
+        for (size_t i = 0; i < m_device.size(); i++)
+        {
+            st = initResults[i];
             if (st)
             {
+                unsigned int gpuId = m_device[i]->gpuId; /* Cache for logging as the device may get freed */
                 log_debug("workerThreads[{}]->InitBuffers() st={}, stopping workers", i, st);
-                // Couldn't initialize the worker - stop all launched workers and exit
-                for (size_t j = 0; j <= i; j++)
+                // Couldn't initialize the worker - stop all workers and exit
+                for (size_t j = 0; j < m_device.size(); j++)
                 {
                     if (workerThreads[j] == nullptr)
                     {
@@ -504,6 +540,10 @@ bool GpuBurnPlugin::RunTest(dcgmDiagPluginEntityList_v1 const *entityInfo)
                 log_error(ss.str());
                 return false;
             }
+        }
+
+        for (size_t i = 0; i < m_device.size(); i++)
+        {
             // Start the worker thread
             workerThreads[i]->Start();
             activeThreadCount++;
@@ -703,7 +743,8 @@ GpuBurnWorker::GpuBurnWorker(GpuBurnDevice *device,
                              unsigned int matrixDim,
                              DcgmRecorder &dr,
                              bool failEarly,
-                             unsigned long /* failCheckInterval */)
+                             unsigned long /* failCheckInterval */,
+                             bool deviceStats)
     : m_device(device)
     , m_plugin(plugin)
     , m_precision(precision)
@@ -741,6 +782,7 @@ GpuBurnWorker::GpuBurnWorker(GpuBurnDevice *device,
     , m_totalNaNs(0)
     , m_dcgmRecorder(dr)
     , m_failEarly(failEarly)
+    , m_deviceStats(deviceStats)
 {
     memset(m_params, 0, sizeof(m_params));
     if (m_precision & DIAG_HALF_PRECISION)
@@ -997,34 +1039,12 @@ int GpuBurnWorker::Compare(int precisionIndex)
 {
     int faultyElems = 0;
     int nanElems    = 0;
-    CUfunction compare;
     CHECK_CUDA_ERROR("cuMemsetD32", cuMemsetD32(m_faultyElemData, 0, 1));
     CHECK_CUDA_ERROR("cuMemsetD32", cuMemsetD32(m_nanElemData, 0, 1));
-    if (precisionIndex == DIAG_HALF_PRECISION)
+    if (LaunchCompare(precisionIndex, 0) != 0)
     {
-        compare = m_f16CompareFunc;
-    }
-    else if (precisionIndex == DIAG_SINGLE_PRECISION)
-    {
-        compare = m_f32CompareFunc;
-    }
-    else
-    {
-        compare = m_f64CompareFunc;
+        return -1;
     }
-
-    CHECK_CUDA_ERROR("cuLaunchKernel",
-                     cuLaunchKernel(compare,
-                                    m_gridDim.x,
-                                    m_gridDim.y,
-                                    m_gridDim.z,
-                                    m_blockDim.x,
-                                    m_blockDim.y,
-                                    m_blockDim.z,
-                                    0,
-                                    0,
-                                    m_params,
-                                    0));
     CHECK_CUDA_ERROR("cuMemcpyDtoH", cuMemcpyDtoH(&faultyElems, m_faultyElemData, sizeof(int)));
     CHECK_CUDA_ERROR("cuMemcpyDtoH", cuMemcpyDtoH(&nanElems, m_nanElemData, sizeof(int)));
     if (faultyElems)
@@ -1050,6 +1070,38 @@ int GpuBurnWorker::Compare(int precisionIndex)
     return 0;
 }
 
+/****************************************************************************/
+int GpuBurnWorker::LaunchCompare(int precisionIndex, CUstream stream)
+{
+    CUfunction compare;
+    if (precisionIndex == DIAG_HALF_PRECISION)
+    {
+        compare = m_f16CompareFunc;
+    }
+    else if (precisionIndex == DIAG_SINGLE_PRECISION)
+    {
+        compare = m_f32CompareFunc;
+    }
+    else
+    {
+        compare = m_f64CompareFunc;
+    }
+
+    CHECK_CUDA_ERROR("cuLaunchKernel",
+                     cuLaunchKernel(compare,
+                                    m_gridDim.x,
+                                    m_gridDim.y,
+                                    m_gridDim.z,
+                                    m_blockDim.x,
+                                    m_blockDim.y,
+                                    m_blockDim.z,
+                                    0,
+                                    stream,
+                                    m_params,
+                                    0));
+    return 0;
+}
+
 /****************************************************************************/
 int GpuBurnWorker::Compute(int precisionIndex)
 {
@@ -1156,6 +1208,14 @@ void GpuBurnWorker::run()
     m_plugin.AddInfoVerboseForGpu(m_plugin.GetDiagnosticTestName(), m_device->gpuId, ss.str());
 
     startTime = timelib_dsecSince1970();
+    if (m_deviceStats)
+    {
+        RunWithDeviceStats(startTime, iterations);
+        ReleaseDeviceStats();
+        m_stopTime = timelib_secSince1970();
+        return;
+    }
+
     std::vector<DcgmError> errorList;
     bool hintedTensorCores = false; /* Have we hinted cublas to use tensor cores yet? */
 
@@ -1221,3 +1281,233 @@ void GpuBurnWorker::run()
     } while (iterEnd - startTime < m_testDuration && !ShouldStop() && !st);
     m_stopTime = timelib_secSince1970();
 }
+
+/****************************************************************************/
+size_t GpuBurnWorker::ItersForPrecision(int32_t precision, size_t iterations)
+{
+    /* The number of compute/compare iterations depends on the data type */
+    if (precision == DIAG_HALF_PRECISION)
+    {
+        return iterations * 4;
+    }
+    if (precision == DIAG_SINGLE_PRECISION)
+    {
+        return iterations * 2;
+    }
+    return iterations;
+}
+
+/****************************************************************************/
+int GpuBurnWorker::CaptureGraph(int32_t precision, size_t iterations)
+{
+    CUgraph graph {};
+
+    /* The compare kernel gets m_iters by value when it is captured */
+    m_iters = ItersForPrecision(precision, iterations);
+    CHECK_CUDA_ERROR("cuStreamBeginCapture", cuStreamBeginCapture(m_stream, CU_STREAM_CAPTURE_MODE_THREAD_LOCAL));
+    int st = Compute(precision);
+    if (st == 0 && !ShouldStop())
+    {
+        st = LaunchCompare(precision, m_stream);
+    }
+
+    /* End the capture even if it failed, so that the stream can be used again */
+    CUresult cuSt = cuStreamEndCapture(m_stream, &graph);
+    if (st != 0 || ShouldStop())
+    {
+        if (graph)
+        {
+            cuGraphDestroy(graph);
+        }
+        return st;
+    }
+    CHECK_CUDA_ERROR("cuStreamEndCapture", cuSt);
+
+    CUgraphExec graphExec {};
+    cuSt = cuGraphInstantiateWithFlags(&graphExec, graph, 0);
+    cuGraphDestroy(graph);
+    CHECK_CUDA_ERROR("cuGraphInstantiateWithFlags", cuSt);
+    m_graphs[precision] = graphExec;
+    return 0;
+}
+
+/****************************************************************************/
+int GpuBurnWorker::QueueStatsReadback()
+{
+    CHECK_CUDA_ERROR("cuMemcpyDtoHAsync",
+                     cuMemcpyDtoHAsync(&m_hostStats[0], m_faultyElemData, sizeof(int), m_stream));
+    CHECK_CUDA_ERROR("cuMemcpyDtoHAsync", cuMemcpyDtoHAsync(&m_hostStats[1], m_nanElemData, sizeof(int), m_stream));
+    CHECK_CUDA_ERROR("cuMemsetD32Async", cuMemsetD32Async(m_faultyElemData, 0, 1, m_stream));
+    CHECK_CUDA_ERROR("cuMemsetD32Async", cuMemsetD32Async(m_nanElemData, 0, 1, m_stream));
+    CHECK_CUDA_ERROR("cuEventRecord", cuEventRecord(m_statsReady, m_stream));
+    m_statsPending = true;
+    return 0;
+}
+
+/****************************************************************************/
+int GpuBurnWorker::CollectStats()
+{
+    if (!m_statsPending)
+    {
+        return 0;
+    }
+
+    CHECK_CUDA_ERROR("cuEventSynchronize", cuEventSynchronize(m_statsReady));
+    m_statsPending = false;
+    m_error        = m_hostStats[0];
+    m_nan          = m_hostStats[1];
+    m_totalErrors += m_error;
+    m_totalNaNs += m_nan;
+
+    if (m_failEarly && (m_error > 0 || m_nan > 0))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/****************************************************************************/
+int GpuBurnWorker::RunWithDeviceStats(double startTime, size_t iterations)
+{
+    using namespace Dcgm;
+    std::string const gflopsKey(PERF_STAT_NAME);
+
+    CHECK_CUDA_ERROR("cuStreamCreate", cuStreamCreate(&m_stream, CU_STREAM_NON_BLOCKING));
+    CHECK_CUBLAS_ERROR_AND_RETURN("cublasSetStream", CublasProxy::CublasSetStream(m_cublas, m_stream));
+    for (auto &roundDone : m_roundDone)
+    {
+        CHECK_CUDA_ERROR("cuEventCreate", cuEventCreate(&roundDone, CU_EVENT_DISABLE_TIMING));
+    }
+    CHECK_CUDA_ERROR("cuEventCreate", cuEventCreate(&m_statsReady, CU_EVENT_DISABLE_TIMING));
+    CHECK_CUDA_ERROR("cuMemHostAlloc", cuMemHostAlloc((void **)&m_hostStats, 2 * sizeof(int), 0));
+    CHECK_CUDA_ERROR("cuMemsetD32", cuMemsetD32(m_faultyElemData, 0, 1));
+    CHECK_CUDA_ERROR("cuMemsetD32", cuMemsetD32(m_nanElemData, 0, 1));
+
+    for (auto const precision : m_precisions)
+    {
+        if (int st = CaptureGraph(precision, iterations); st != 0 || ShouldStop())
+        {
+            return st;
+        }
+    }
+
+    bool hintedTensorCores     = false; /* Have we hinted cublas to use tensor cores yet? */
+    double lastReadback        = startTime;
+    long long opsSinceReadback = 0;
+    size_t round               = 0;
+    bool done                  = false;
+    int st                     = 0;
+
+    while (!done && st == 0)
+    {
+        /* Wait for the round before the last one, so that two rounds are queued at most */
+        CUevent const roundDone = m_roundDone[round % 2];
+        if (round >= 2)
+        {
+            CHECK_CUDA_ERROR("cuEventSynchronize", cuEventSynchronize(roundDone));
+        }
+        for (auto const precision : m_precisions)
+        {
+            CHECK_CUDA_ERROR("cuGraphLaunch", cuGraphLaunch(m_graphs[precision], m_stream));
+            opsSinceReadback += ItersForPrecision(precision, iterations);
+        }
+        CHECK_CUDA_ERROR("cuEventRecord", cuEventRecord(roundDone, m_stream));
+        round++;
+
+        double const now = timelib_dsecSince1970();
+        done             = now - startTime > m_testDuration || ShouldStop();
+
+        if (done || now - lastReadback >= c_statsReadbackSec)
+        {
+            /* The copy queued by the last readback finished long ago, unless this is the last one */
+            st = CollectStats();
+            if (st == 0)
+            {
+                st = QueueStatsReadback();
+            }
+            if (st == 0 && done)
+            {
+                st = CollectStats();
+            }
+
+            m_totalOperations += opsSinceReadback;
+            double gflops = opsSinceReadback * OPS_PER_MUL / (1024 * 1024 * 1024) / (now - lastReadback);
+            m_plugin.SetGpuStat(m_plugin.GetDiagnosticTestName(), m_device->gpuId, gflopsKey, gflops);
+            opsSinceReadback = 0;
+            lastReadback     = now;
+        }
+
+        /* Give cublas a hint to use tensor cores at the halfway point. The graphs have to be captured again to pick
+           it up. Graphs that are still queued are freed once they complete */
+        if (!done && st == 0 && !hintedTensorCores && (now - startTime > m_testDuration / 2.0))
+        {
+            DCGM_LOG_DEBUG << "Enabling tensor math for GPU " << m_device->gpuId;
+            CHECK_CUBLAS_ERROR("cublasSetMathMode", CublasProxy::CublasSetMathMode(m_cublas, CUBLAS_TENSOR_OP_MATH));
+            hintedTensorCores = true;
+
+            for (auto const &[precision, graphExec] : m_graphs)
+            {
+                cuGraphExecDestroy(graphExec);
+            }
+            m_graphs.clear();
+            for (auto const precision : m_precisions)
+            {
+                if (st = CaptureGraph(precision, iterations); st != 0 || ShouldStop())
+                {
+                    return st;
+                }
+            }
+        }
+    }
+
+    return st;
+}
+
+/****************************************************************************/
+void GpuBurnWorker::ReleaseDeviceStats()
+{
+    using namespace Dcgm;
+
+    if (m_stream)
+    {
+        /* Nothing may still use the graphs, events or counters */
+        CUresult cuSt = cuStreamSynchronize(m_stream);
+        if (cuSt != CUDA_SUCCESS)
+        {
+            LOG_CUDA_ERROR_FOR_PLUGIN(
+                &m_plugin, m_plugin.GetDiagnosticTestName(), "cuStreamSynchronize", cuSt, m_device->gpuId);
+        }
+    }
+
+    for (auto const &[precision, graphExec] : m_graphs)
+    {
+        cuGraphExecDestroy(graphExec);
+    }
+    m_graphs.clear();
+
+    for (auto &event : { &m_roundDone[0], &m_roundDone[1], &m_statsReady })
+    {
+        if (*event)
+        {
+            cuEventDestroy(*event);
+            *event = nullptr;
+        }
+    }
+
+    if (m_hostStats)
+    {
+        cuMemFreeHost(m_hostStats);
+        m_hostStats = nullptr;
+    }
+
+    if (m_stream)
+    {
+        if (m_cublas)
+        {
+            CublasProxy::CublasSetStream(m_cublas, nullptr);
+        }
+        cuStreamDestroy(m_stream);
+        m_stream = nullptr;
+    }
+    m_statsPending = false;
+}
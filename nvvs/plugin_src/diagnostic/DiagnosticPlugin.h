@@ -29,6 +29,7 @@
 #include <cublas_proxy.hpp>
 #include <cuda.h>
 #include <fmt/format.h>
+#include <map>
 
 #define PERF_STAT_NAME "perf_gflops"
 
@@ -273,6 +274,7 @@ private:
     double m_gflopsTolerancePcnt; /* % of mean gflops below which an error is reported */
     int32_t m_precision;          /* bitmap for what precision we should use (half, single, double) */
     unsigned int m_matrixDim;     /* The dimension size of the matrix */
+    bool m_deviceStats;           /* Keep the error counters on the GPU. See GpuBurnWorker::RunWithDeviceStats() */
 
     friend GpuBurnPluginTester;
 };
@@ -314,7 +316,8 @@ public:
                   unsigned int matrixDim,
                   DcgmRecorder &dcgmRecorder,
                   bool failEarly,
-                  unsigned long failCheckInterval);
+                  unsigned long failCheckInterval,
+                  bool deviceStats = false);
 
     /*************************************************************************/
     /*
@@ -416,6 +419,12 @@ public:
      */
     int Compare(int precision);
 
+    /*************************************************************************/
+    /*
+     * Launch the compare kernel for precision on stream. It adds to the error counters without reading them back
+     */
+    int LaunchCompare(int precision, CUstream stream);
+
     /*************************************************************************/
     /*
      * Perform some matrix math
@@ -429,6 +438,51 @@ public:
     void run() override;
 
 private:
+    /*************************************************************************/
+    /*
+     * Run the test with the error counters kept on the GPU.
+     *
+     * The GEMMs and the compare of each precision are captured once into a CUDA graph, and a round launches one graph
+     * per precision. Up to two rounds are queued, so the GPU doesn't wait for the host between them. The counters are
+     * not reset or read after each compare; they are copied into pinned host memory about once a second and read at
+     * the next readback, when the copy has long finished.
+     *
+     * Returns 0 when the test ran until the end, 1 when failing early, -1 on CUDA or cuBLAS errors
+     */
+    int RunWithDeviceStats(double startTime, size_t iterations);
+
+    /*************************************************************************/
+    /*
+     * Capture the GEMMs and the compare of precision into m_graphs[precision]
+     */
+    int CaptureGraph(int32_t precision, size_t iterations);
+
+    /*************************************************************************/
+    /*
+     * Queue the copy of the error counters into m_hostStats and their reset
+     */
+    int QueueStatsReadback();
+
+    /*************************************************************************/
+    /*
+     * Add the counters of the last queued readback, if any, to the totals. Waits for the copy to finish.
+     *
+     * Returns 1 when failing early, 0 or -1 as CHECK_CUDA_ERROR
+     */
+    int CollectStats();
+
+    /*************************************************************************/
+    /*
+     * Release the stream, events, graphs and pinned memory of RunWithDeviceStats()
+     */
+    void ReleaseDeviceStats();
+
+    /*************************************************************************/
+    /*
+     * Number of matrix multiplications per compare of precision, which is larger for smaller data types
+     */
+    static size_t ItersForPrecision(int32_t precision, size_t iterations);
+
     GpuBurnDevice *m_device {};
     GpuBurnPlugin &m_plugin;
     int32_t m_precision {};
@@ -475,6 +529,16 @@ private:
     long long m_totalNaNs {};
     DcgmRecorder &m_dcgmRecorder;
     bool m_failEarly {};
+
+    /* State of RunWithDeviceStats() */
+    static constexpr double c_statsReadbackSec = 1.0; /* How often the error counters are read back */
+    bool m_deviceStats {};
+    CUstream m_stream {};
+    CUevent m_roundDone[2] {};               /* Recorded after each of the last two rounds */
+    CUevent m_statsReady {};                 /* Recorded after the copy of the counters */
+    bool m_statsPending {};                  /* Was a copy of the counters queued since the last CollectStats()? */
+    int *m_hostStats {};                     /* Pinned copy of the faulty and NaN counters */
+    std::map<int32_t, CUgraphExec> m_graphs; /* GEMMs and compare of each precision */
     friend GpuBurnWorkerTester;
 };
 /*****************************************************************************/
@@ -486,6 +550,11 @@ public:
     {
         return gbw.m_nElemsPerIter;
     }
+
+    static size_t ItersForPrecision(int32_t precision, size_t iterations)
+    {
+        return GpuBurnWorker::ItersForPrecision(precision, iterations);
+    }
 };
 
 #endif // DIAGNOSTICPLUGIN_H
@@ -40,10 +40,12 @@ dcgmReturn_t GetPluginInfo(unsigned int /* pluginInterfaceVersion */, dcgmDiagPl
                                      DIAGNOSTIC_STR_MATRIX_DIM,
                                      DIAGNOSTIC_STR_PRECISION,
                                      DIAGNOSTIC_STR_GFLOPS_TOLERANCE_PCNT,
+                                     DIAGNOSTIC_STR_DEVICE_STATS,
                                      nullptr };
     const dcgmPluginValue_t paramTypes[]
-        = { DcgmPluginParamInt, DcgmPluginParamInt,  DcgmPluginParamBool,   DcgmPluginParamFloat, DcgmPluginParamBool,
-            DcgmPluginParamInt, DcgmPluginParamNone, DcgmPluginParamString, DcgmPluginParamFloat };
+        = { DcgmPluginParamInt,    DcgmPluginParamInt,   DcgmPluginParamBool, DcgmPluginParamFloat,
+            DcgmPluginParamBool,   DcgmPluginParamInt,   DcgmPluginParamNone, DcgmPluginParamString,
+            DcgmPluginParamBool,   DcgmPluginParamFloat };
     char const *descripton = "This plugin will stress the framebuffer of a list of GPUs.";
     DCGM_CASSERT(sizeof(parameterNames) / sizeof(const char *) == sizeof(paramTypes) / sizeof(const dcgmPluginValue_t),
                  1);
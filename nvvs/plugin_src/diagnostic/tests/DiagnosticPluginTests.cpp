@@ -135,4 +135,11 @@ TEST_CASE("Diagnostic: GpuBurnDevice parameters")
     DcgmRecorder dr;
     GpuBurnWorker gbw(&gbd, gbp, DIAG_SINGLE_PRECISION, 15.0, 2048, dr, false, 1001);
     CHECK(GpuBurnWorkerTester::GetNElemsPerIter(gbw) == (2048 * 2048));
+}
+
+TEST_CASE("Diagnostic: Iterations per graph with device stats")
+{
+    CHECK(GpuBurnWorkerTester::ItersForPrecision(DIAG_HALF_PRECISION, 10) == 40);
+    CHECK(GpuBurnWorkerTester::ItersForPrecision(DIAG_SINGLE_PRECISION, 10) == 20);
+    CHECK(GpuBurnWorkerTester::ItersForPrecision(DIAG_DOUBLE_PRECISION, 10) == 10);
 }
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include <CudaCommon.h>
 #include <assert.h>
 #include <cuda.h>
+#include <algorithm>
 #include <dcgm_structs.h>
 #include <string.h>
 
@@ -159,6 +160,8 @@ nvvsPluginResult_t L1TagCuda::RunTest(void)
     double durationSec       = 0.0; /* Will be set later.  */
     uint64_t totalNumErrors  = 0;
     uint64_t kernLaunchCount = 0;
+    uint64_t syncCount       = 0;
+    uint64_t launchesPerSync = 0;
     CUevent startEvent       = nullptr;
     CUevent stopEvent        = nullptr;
     CUstream stream          = nullptr;
@@ -319,42 +322,28 @@ nvvsPluginResult_t L1TagCuda::RunTest(void)
         goto CLEANUP;
     }
 
+    // Errors of every launch are appended to the same device log, so the counter is cleared once and only read back
+    // at the end of each batch of launches. In loop mode without a batch size, all loops are a single batch.
+    // In duration mode, batches are sized from the time the previous one took.
+    cuRes = cuMemsetD32Async(m_devMiscompareCount, 0, sizeof(uint64_t) / sizeof(uint32_t), stream);
+    if (CUDA_SUCCESS != cuRes)
+    {
+        retVal = LogCudaFail("Failed to clear m_devMiscompareCount", "cuMemsetD32Async", cuRes);
+        goto CLEANUP;
+    }
+
+    launchesPerSync = m_launchesPerSync;
+    if (launchesPerSync == 0)
+    {
+        launchesPerSync = m_runtimeMs ? 1 : std::max(m_testLoops, (uint64_t)1);
+    }
+
     // Run for runtimeMs if it is nonzero.
     // Otherwise run for m_testLoops loops.
-    for (uint64_t loop = 0; m_runtimeMs ? durationMs < static_cast<double>(m_runtimeMs) : loop < m_testLoops; loop++)
+    for (uint64_t loop = 0; m_runtimeMs ? durationMs < static_cast<double>(m_runtimeMs) : loop < m_testLoops;)
     {
-        // Clear error counter
-        uint64_t zeroVal = 0;
-        cuRes            = cuMemcpyHtoDAsync(m_devMiscompareCount, &zeroVal, sizeof(uint64_t), stream);
-        if (CUDA_SUCCESS != cuRes)
-        {
-            retVal = LogCudaFail("Failed to clear m_devMiscompareCount", "cuMemsetD32Async", cuRes);
-            goto CLEANUP;
-        }
+        uint64_t const numLaunches = m_runtimeMs ? launchesPerSync : std::min(launchesPerSync, m_testLoops - loop);
 
-        // Use a different RNG seed each loop
-        m_kernelParams.randSeed = (uint32_t)rand();
-
-        // Run the init data buffer kernel
-        void *paramPtrs[] = { &m_kernelParams };
-        cuRes             = cuLaunchKernel(initL1DataFunc,
-                               numBlocks,  // gridDimX
-                               1,          // gridDimY
-                               1,          // gridDimZ
-                               numThreads, // blockDimX
-                               1,          // blockDimY
-                               1,          // blockDimZ
-                               0,          // sharedMemSize
-                               stream,
-                               paramPtrs,
-                               NULL);
-        if (CUDA_SUCCESS != cuRes)
-        {
-            retVal = LogCudaFail("Failed to launch InitL1Data kernel", "cuLaunchKernel", cuRes);
-            goto CLEANUP;
-        }
-
-        // The run the test kernel, recording elaspsed time with events
         cuRes = cuEventRecord(startEvent, stream);
         if (CUDA_SUCCESS != cuRes)
         {
@@ -362,23 +351,48 @@ nvvsPluginResult_t L1TagCuda::RunTest(void)
             goto CLEANUP;
         }
 
-        cuRes = cuLaunchKernel(testRunDataFunc,
-                               numBlocks,  // gridDimX
-                               1,          // gridDimY
-                               1,          // gridDimZ
-                               numThreads, // blockDimX
-                               1,          // blockDimY
-                               1,          // blockDimZ
-                               0,          // sharedMemSize
-                               stream,
-                               paramPtrs,
-                               NULL);
-        if (CUDA_SUCCESS != cuRes)
+        for (uint64_t launch = 0; launch < numLaunches; launch++)
         {
-            retVal = LogCudaFail("Failed to launch L1TagTest kernel", "cuLaunchKernel", cuRes);
-            goto CLEANUP;
+            // Use a different RNG seed each loop. The parameters are copied when the kernels are launched
+            m_kernelParams.randSeed = (uint32_t)rand();
+
+            // Run the init data buffer kernel, then the test kernel
+            void *paramPtrs[] = { &m_kernelParams };
+            cuRes             = cuLaunchKernel(initL1DataFunc,
+                                   numBlocks,  // gridDimX
+                                   1,          // gridDimY
+                                   1,          // gridDimZ
+                                   numThreads, // blockDimX
+                                   1,          // blockDimY
+                                   1,          // blockDimZ
+                                   0,          // sharedMemSize
+                                   stream,
+                                   paramPtrs,
+                                   NULL);
+            if (CUDA_SUCCESS != cuRes)
+            {
+                retVal = LogCudaFail("Failed to launch InitL1Data kernel", "cuLaunchKernel", cuRes);
+                goto CLEANUP;
+            }
+
+            cuRes = cuLaunchKernel(testRunDataFunc,
+                                   numBlocks,  // gridDimX
+                                   1,          // gridDimY
+                                   1,          // gridDimZ
+                                   numThreads, // blockDimX
+                                   1,          // blockDimY
+                                   1,          // blockDimZ
+                                   0,          // sharedMemSize
+                                   stream,
+                                   paramPtrs,
+                                   NULL);
+            if (CUDA_SUCCESS != cuRes)
+            {
+                retVal = LogCudaFail("Failed to launch L1TagTest kernel", "cuLaunchKernel", cuRes);
+                goto CLEANUP;
+            }
+            kernLaunchCount++;
         }
-        kernLaunchCount++;
 
         cuRes = cuEventRecord(stopEvent, stream);
         if (CUDA_SUCCESS != cuRes)
@@ -395,7 +409,7 @@ nvvsPluginResult_t L1TagCuda::RunTest(void)
             goto CLEANUP;
         }
 
-        // Synchronize and get time for kernel completion
+        // Synchronize and get time for the batch completion
         cuRes = cuStreamSynchronize(stream);
         if (CUDA_SUCCESS != cuRes)
         {
@@ -411,12 +425,14 @@ nvvsPluginResult_t L1TagCuda::RunTest(void)
             goto CLEANUP;
         }
         durationMs += elapsedMs;
+        loop += numLaunches;
+        syncCount++;
 
         // Handle errors
-        totalNumErrors += hostMiscompareCount;
+        totalNumErrors = hostMiscompareCount;
         if (hostMiscompareCount > 0)
         {
-            log_error("CudaL1Tag found {} miscompare(s) on loop {}", hostMiscompareCount, loop);
+            log_error("CudaL1Tag found {} miscompare(s) by loop {}", hostMiscompareCount, loop - 1);
 
             cuRes = cuMemcpyDtoH(m_hostErrorLog, m_devErrorLog, sizeof(L1TagError) * m_errorLogLen);
             if (CUDA_SUCCESS != cuRes)
@@ -466,9 +482,17 @@ nvvsPluginResult_t L1TagCuda::RunTest(void)
             retVal = NVVS_RESULT_FAIL;
             goto CLEANUP;
         }
+
+        if (m_runtimeMs && m_launchesPerSync == 0 && elapsedMs > 0)
+        {
+            // Size the next batch to take c_syncIntervalMs, without running much past the requested duration
+            double const launchMs = elapsedMs / numLaunches;
+            double const targetMs = std::min(c_syncIntervalMs, static_cast<double>(m_runtimeMs) - durationMs);
+            launchesPerSync       = std::max((uint64_t)(targetMs / launchMs), (uint64_t)1);
+        }
     }
 
-    log_info("Complete  durationMs = {}", durationMs);
+    log_info("Complete  durationMs = {}, {} launches over {} syncs", durationMs, kernLaunchCount, syncCount);
 
     // Kernel runtime and error prints useful for debugging
     // Guard against divide-by-zero errors (that shouldn't occur)
@@ -515,8 +539,9 @@ nvvsPluginResult_t L1TagCuda::TestMain(unsigned int dcgmGpuIndex)
 
     m_gpuIndex = dcgmGpuIndex;
 
-    m_runtimeMs       = 1000 * (uint32_t)m_testParameters->GetDouble(MEMORY_L1TAG_STR_TEST_DURATION);
+    m_runtimeMs       = (uint32_t)(1000 * m_testParameters->GetDouble(MEMORY_L1TAG_STR_TEST_DURATION));
     m_testLoops       = (uint64_t)m_testParameters->GetDouble(MEMORY_L1TAG_STR_TEST_LOOPS);
+    m_launchesPerSync = (uint64_t)m_testParameters->GetDouble(MEMORY_L1TAG_STR_LAUNCHES_PER_SYNC);
     m_innerIterations = (uint64_t)m_testParameters->GetDouble(MEMORY_L1TAG_STR_INNER_ITERATIONS);
     m_errorLogLen     = (uint32_t)m_testParameters->GetDouble(MEMORY_L1TAG_STR_ERROR_LOG_LEN);
     m_dumpMiscompares = m_testParameters->GetBoolFromString(MEMORY_L1TAG_STR_DUMP_MISCOMPARES);
@@ -76,6 +76,7 @@ public:
         , m_devErrorLog((CUdeviceptr)NULL)
         , m_runtimeMs(0)
         , m_testLoops(0)
+        , m_launchesPerSync(0)
         , m_innerIterations(0)
         , m_errorLogLen(0)
         , m_dumpMiscompares(false)
@@ -86,6 +87,9 @@ public:
     nvvsPluginResult_t TestMain(unsigned int dcgmGpuIndex);
 
 private:
+    /* How long a batch of launches runs between host syncs when batches are sized automatically in duration mode */
+    static constexpr double c_syncIntervalMs = 100.0;
+
     int Setup(void);
     void Cleanup(void);
     nvvsPluginResult_t RunTest(void);
@@ -117,6 +121,7 @@ private:
     // Test parameters
     uint32_t m_runtimeMs;
     uint64_t m_testLoops;
+    uint64_t m_launchesPerSync; // 0 sizes the batches of launches between host syncs automatically
     uint64_t m_innerIterations;
     uint32_t m_errorLogLen;
     bool m_dumpMiscompares;
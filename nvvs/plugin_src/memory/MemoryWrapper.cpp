@@ -37,6 +37,7 @@ dcgmReturn_t GetPluginInfo(unsigned int /* pluginInterfaceVersion */, dcgmDiagPl
                                      MEMORY_L1TAG_STR_IS_ALLOWED,
                                      MEMORY_L1TAG_STR_TEST_DURATION,
                                      MEMORY_L1TAG_STR_TEST_LOOPS,
+                                     MEMORY_L1TAG_STR_LAUNCHES_PER_SYNC,
                                      MEMORY_L1TAG_STR_INNER_ITERATIONS,
                                      MEMORY_L1TAG_STR_ERROR_LOG_LEN,
                                      MEMORY_L1TAG_STR_DUMP_MISCOMPARES,
@@ -44,8 +45,9 @@ dcgmReturn_t GetPluginInfo(unsigned int /* pluginInterfaceVersion */, dcgmDiagPl
                                      nullptr };
     char const *description      = "This plugin will test the memory of a given GPU.";
     const dcgmPluginValue_t paramTypes[]
-        = { DcgmPluginParamBool, DcgmPluginParamInt, DcgmPluginParamBool, DcgmPluginParamInt, DcgmPluginParamInt,
-            DcgmPluginParamInt,  DcgmPluginParamInt, DcgmPluginParamBool, DcgmPluginParamInt, DcgmPluginParamNone };
+        = { DcgmPluginParamBool, DcgmPluginParamInt, DcgmPluginParamBool, DcgmPluginParamFloat,
+            DcgmPluginParamInt,  DcgmPluginParamInt, DcgmPluginParamInt,  DcgmPluginParamInt,
+            DcgmPluginParamBool, DcgmPluginParamInt, DcgmPluginParamNone };
     DCGM_CASSERT(sizeof(parameterNames) / sizeof(const char *) == sizeof(paramTypes) / sizeof(const dcgmPluginValue_t),
                  1);
 
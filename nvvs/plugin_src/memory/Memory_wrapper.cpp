@@ -35,6 +35,7 @@ Memory::Memory(dcgmHandle_t handle)
     tp->AddString(MEMORY_L1TAG_STR_IS_ALLOWED, "False");
     tp->AddDouble(MEMORY_L1TAG_STR_TEST_DURATION, 1.0);
     tp->AddDouble(MEMORY_L1TAG_STR_TEST_LOOPS, 0);
+    tp->AddDouble(MEMORY_L1TAG_STR_LAUNCHES_PER_SYNC, 0);
     tp->AddDouble(MEMORY_L1TAG_STR_INNER_ITERATIONS, 1024);
     tp->AddDouble(MEMORY_L1TAG_STR_ERROR_LOG_LEN, 8192);
     tp->AddString(MEMORY_L1TAG_STR_DUMP_MISCOMPARES, "True");
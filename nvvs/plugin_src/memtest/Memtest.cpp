@@ -49,6 +49,7 @@
 #include <fmt/ostream.h>
 #include <random>
 #include <span>
+#include <thread>
 
 const unsigned int NUM_ITERATIONS = 1000;
 
@@ -218,6 +219,8 @@ void Memtest::Cleanup()
     {
         if (gpu.cuModule != nullptr)
         {
+            /* The contexts may have been created on other threads, so this thread may have none current */
+            cuCtxSetCurrent(gpu.cuContext);
             if (auto cuSt = cuModuleUnload(gpu.cuModule); cuSt != CUDA_SUCCESS)
             {
                 LOG_CUDA_ERROR_FOR_PLUGIN(m_plugin, m_plugin->GetMmeTestTestName(), "cuModuleUnload", cuSt, gpu.gpuId);
@@ -435,34 +438,59 @@ int Memtest::LoadCudaModule(memtest_device_p gpu)
 /*****************************************************************************/
 int Memtest::CudaInit()
 {
-    /* Do per-device initialization */
-    for (auto &gpu : m_device)
+    if (m_device.size() == 1)
     {
-        // Reset the device before context creation
-        if (auto cuSt = cuDevicePrimaryCtxReset(gpu.cuDevice); cuSt != CUDA_SUCCESS)
+        return CudaInitDevice(m_device[0]);
+    }
+
+    /* Context creation and module loading dominate a short run. Do every GPU at once */
+    std::vector<int> results(m_device.size(), 0);
+    {
+        std::vector<std::jthread> initThreads;
+        initThreads.reserve(m_device.size());
+        for (size_t i = 0; i < m_device.size(); i++)
         {
-            LOG_CUDA_ERROR_FOR_PLUGIN(
-                m_plugin, m_plugin->GetMmeTestTestName(), "cuDevicePrimaryCtxReset", cuSt, gpu.gpuId);
-            return -1;
+            initThreads.emplace_back([this, &results, i] { results[i] = CudaInitDevice(m_device[i]); });
         }
-        {
-            if (auto cuSt = cuCtxCreate(&gpu.cuContext, 0, gpu.cuDevice); cuSt != CUDA_SUCCESS)
-            {
-                LOG_CUDA_ERROR_FOR_PLUGIN(m_plugin, m_plugin->GetMmeTestTestName(), "cuCtxCreate", cuSt, gpu.gpuId);
-                return -1;
-            }
+    } // Joins the threads
 
-            /* The modules must be loaded after we've created our contexts */
-            if (LoadCudaModule(&gpu) != 0)
-            {
-                DCGM_LOG_ERROR << "LoadCudaModule failed, see log for more information";
-                return -1;
-            }
+    for (auto const result : results)
+    {
+        if (result != 0)
+        {
+            return result;
         }
     }
     return 0;
 }
 
+/*****************************************************************************/
+int Memtest::CudaInitDevice(memtest_device_t &gpu)
+{
+    // Reset the device before context creation
+    if (auto cuSt = cuDevicePrimaryCtxReset(gpu.cuDevice); cuSt != CUDA_SUCCESS)
+    {
+        LOG_CUDA_ERROR_FOR_PLUGIN(
+            m_plugin, m_plugin->GetMmeTestTestName(), "cuDevicePrimaryCtxReset", cuSt, gpu.gpuId);
+        return -1;
+    }
+
+    if (auto cuSt = cuCtxCreate(&gpu.cuContext, 0, gpu.cuDevice); cuSt != CUDA_SUCCESS)
+    {
+        LOG_CUDA_ERROR_FOR_PLUGIN(m_plugin, m_plugin->GetMmeTestTestName(), "cuCtxCreate", cuSt, gpu.gpuId);
+        return -1;
+    }
+
+    /* The modules must be loaded after we've created our contexts */
+    if (LoadCudaModule(&gpu) != 0)
+    {
+        DCGM_LOG_ERROR << "LoadCudaModule failed, see log for more information";
+        return -1;
+    }
+
+    return 0;
+}
+
 /*****************************************************************************/
 dcgmReturn_t Memtest::Init(const dcgmDiagPluginEntityList_v1 &entityList)
 {
@@ -823,7 +851,12 @@ void MemtestWorker::run()
 }
 
 
-unsigned int error_checking(const char * /*msg*/, unsigned int blockidx)
+/*
+ * Read and reset the error count that the kernels accumulate on the device. The tests call this once per
+ * pass rather than once per grid so that the kernels of a pass are queued back to back without host round
+ * trips in between. The error records are only copied back when there are errors
+ */
+unsigned int error_checking(const char *msg)
 {
     unsigned int err = 0;
     unsigned long host_err_addr[MAX_ERR_RECORD_COUNT];
@@ -834,6 +867,12 @@ unsigned int error_checking(const char * /*msg*/, unsigned int blockidx)
 
     cudaMemcpy((void *)&err, (void *)err_count, sizeof(unsigned int), cudaMemcpyDeviceToHost);
     CUERR;
+
+    if (err == 0)
+    {
+        return 0;
+    }
+
     cudaMemcpy((void *)&host_err_addr[0],
                (void *)err_addr,
                sizeof(unsigned long) * MAX_ERR_RECORD_COUNT,
@@ -855,33 +894,30 @@ unsigned int error_checking(const char * /*msg*/, unsigned int blockidx)
                cudaMemcpyDeviceToHost);
     CUERR;
 
-    if (err)
-    {
-        DCGM_LOG_ERROR << err << " errors found in block " << blockidx;
-        DCGM_LOG_ERROR << "the last " << std::min((unsigned int)MAX_ERR_RECORD_COUNT, err) << " error addresses are:\t";
+    DCGM_LOG_ERROR << err << " errors found in " << msg;
+    DCGM_LOG_ERROR << "the last " << std::min((unsigned int)MAX_ERR_RECORD_COUNT, err) << " error addresses are:\t";
 
-        for (i = 0; i < std::min((unsigned int)MAX_ERR_RECORD_COUNT, err); i++)
-        {
-            DCGM_LOG_ERROR << host_err_addr[i] << "\t";
-        }
-
-        for (i = 0; i < std::min((unsigned int)MAX_ERR_RECORD_COUNT, err); i++)
-        {
-            DCGM_LOG_ERROR << ":" << i << "th error, expected value=" << host_err_expect[i]
-                           << ", current value=" << host_err_current[i];
-            DCGM_LOG_ERROR << "(second_read=" << host_err_second_read[i] << ", expect=" << host_err_expect[i];
-        }
+    for (i = 0; i < std::min((unsigned int)MAX_ERR_RECORD_COUNT, err); i++)
+    {
+        DCGM_LOG_ERROR << host_err_addr[i] << "\t";
+    }
 
-        cudaMemset(err_count, 0, sizeof(unsigned int));
-        CUERR;
-        cudaMemset((void *)&err_addr[0], 0, sizeof(unsigned long) * MAX_ERR_RECORD_COUNT);
-        CUERR;
-        cudaMemset((void *)&err_expect[0], 0, sizeof(unsigned long) * MAX_ERR_RECORD_COUNT);
-        CUERR;
-        cudaMemset((void *)&err_current[0], 0, sizeof(unsigned long) * MAX_ERR_RECORD_COUNT);
-        CUERR;
+    for (i = 0; i < std::min((unsigned int)MAX_ERR_RECORD_COUNT, err); i++)
+    {
+        DCGM_LOG_ERROR << ":" << i << "th error, expected value=" << host_err_expect[i]
+                       << ", current value=" << host_err_current[i];
+        DCGM_LOG_ERROR << "(second_read=" << host_err_second_read[i] << ", expect=" << host_err_expect[i];
     }
 
+    cudaMemset(err_count, 0, sizeof(unsigned int));
+    CUERR;
+    cudaMemset((void *)&err_addr[0], 0, sizeof(unsigned long) * MAX_ERR_RECORD_COUNT);
+    CUERR;
+    cudaMemset((void *)&err_expect[0], 0, sizeof(unsigned long) * MAX_ERR_RECORD_COUNT);
+    CUERR;
+    cudaMemset((void *)&err_current[0], 0, sizeof(unsigned long) * MAX_ERR_RECORD_COUNT);
+    CUERR;
+
     return err;
 }
 
@@ -944,7 +980,7 @@ int test0(memtest_device_p gpu, char *ptr, unsigned int tot_num_blocks)
         goto cleanup;
     }
 
-    err += error_checking("test0 on global address", 0);
+    err += error_checking("test0 on global address");
 
     for (unsigned int ite = 0; ite < NUM_ITERATIONS; ite++)
     {
@@ -974,9 +1010,9 @@ int test0(memtest_device_p gpu, char *ptr, unsigned int tot_num_blocks)
                 DCGM_LOG_ERROR << "Could not launch kernel " << test0_read_func_name << ": " << cuRes;
                 goto cleanup;
             }
-
-            err += error_checking(__FUNCTION__, i);
         }
+
+        err += error_checking(__FUNCTION__);
     }
 
 cleanup:
@@ -1039,10 +1075,10 @@ int test1(memtest_device_p gpu, char *ptr, unsigned int tot_num_blocks)
             DCGM_LOG_ERROR << "Could not launch kernel " << test1_read_func_name << ": " << cuRes;
             goto cleanup;
         }
-
-        err += error_checking("test1 on reading", i);
     }
 
+    err += error_checking("test1 on reading");
+
 cleanup:
     return err;
 }
@@ -1119,9 +1155,10 @@ unsigned int move_inv_test(memtest_device_p gpu,
             DCGM_LOG_ERROR << "Could not launch kernel move_inv_readwrite: " << cuRes;
             goto cleanup;
         }
-        err += error_checking("move_inv_readwrite", i);
     }
 
+    err += error_checking("move_inv_readwrite");
+
     if (sleepSeconds > 0)
     {
         DCGM_LOG_INFO << "move_inv_test sleeping for " << sleepSeconds << " seconds";
@@ -1140,9 +1177,10 @@ unsigned int move_inv_test(memtest_device_p gpu,
             DCGM_LOG_ERROR << "Could not launch kernel move_inv_read: " << cuRes;
             goto cleanup;
         }
-        err += error_checking("move_inv_read", i);
     }
 
+    err += error_checking("move_inv_read");
+
 cleanup:
     return err;
 }
@@ -1288,9 +1326,10 @@ int test5(memtest_device_p gpu, char *ptr, unsigned int tot_num_blocks)
             DCGM_LOG_ERROR << "Could not launch kernel " << test5_check_func_name << ": " << cuRes;
             goto cleanup;
         }
-        err += error_checking("test5[check]", i);
     }
 
+    err += error_checking("test5[check]");
+
 cleanup:
     return err;
 }
@@ -1359,10 +1398,10 @@ unsigned int movinv32(memtest_device_p gpu,
             DCGM_LOG_ERROR << "Could not launch kernel moveinv32_readwrite: " << cuRes;
             goto cleanup;
         }
-
-        err += error_checking("test6[moving inversion 32 readwrite]", i);
     }
 
+    err += error_checking("test6[moving inversion 32 readwrite]");
+
     for (i = 0; i < tot_num_blocks; i += GRIDSIZE)
     {
         dim3 grid;
@@ -1375,10 +1414,10 @@ unsigned int movinv32(memtest_device_p gpu,
             DCGM_LOG_ERROR << "Could not launch kernel moveinv32_read: " << cuRes;
             goto cleanup;
         }
-
-        err += error_checking("test6[moving inversion 32 read]", i);
     }
 
+    err += error_checking("test6[moving inversion 32 read]");
+
 cleanup:
     return err;
 }
@@ -1479,9 +1518,10 @@ int test7(memtest_device_p gpu, char *ptr, unsigned int tot_num_blocks)
             DCGM_LOG_ERROR << "Could not launch kernel test7func_readwrite: " << cuRes;
             goto cleanup;
         }
-        err += error_checking("test7_readwrite", i);
     }
 
+    err += error_checking("test7_readwrite");
+
     for (i = 1; i < tot_num_blocks; i += GRIDSIZE)
     {
         dim3 grid;
@@ -1494,10 +1534,10 @@ int test7(memtest_device_p gpu, char *ptr, unsigned int tot_num_blocks)
             DCGM_LOG_ERROR << "Could not launch kernel test7func_read: " << cuRes;
             goto cleanup;
         }
-
-        err += error_checking("test7_read", i);
     }
 
+    err += error_checking("test7_read");
+
 cleanup:
 
     free(host_buf);
@@ -1564,10 +1604,10 @@ unsigned int modtest(memtest_device_p gpu,
             DCGM_LOG_ERROR << "Could not launch kernel modtest_read: " << cuRes;
             goto cleanup;
         }
-
-        err += error_checking("test8[mod test, read", i);
     }
 
+    err += error_checking("test8[mod test, read");
+
 cleanup:
     return err;
 }
@@ -1750,7 +1790,7 @@ cleanup:
         DCGM_LOG_WARNING << "cuEventRecord() in test10 failed: " << cuRes;
     }
     cuEventSynchronize(stop);
-    err = error_checking("test10[Memory stress test]", 0);
+    err = error_checking("test10[Memory stress test]");
     cuEventElapsedTime(&elapsedtime, start, stop);
     DCGM_LOG_DEBUG << "test10: elapsedtime=" << elapsedtime
                    << ", bandwidth=" << ((2 * NUM_ITERATIONS + 1) * tot_num_blocks / elapsedtime) << "GB/s";
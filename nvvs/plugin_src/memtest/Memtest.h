@@ -163,6 +163,16 @@ private:
      */
     int CudaInit(void);
 
+    /*************************************************************************/
+    /*
+     * Reset gpu's primary context, then create its context and load its module.
+     * CudaInit() runs this for every GPU at once since each GPU's setup is independent
+     *
+     * Returns: 0 on success
+     *         <0 on error
+     */
+    int CudaInitDevice(memtest_device_t &gpu);
+
     /*************************************************************************/
     /*
      * Check to see if serious errors occurred during the test run
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "NVBandwidthCache.h"
+
+#include <DcgmLogging.h>
+
+#include <fstream>
+
+
+namespace DcgmNs::Nvvs::Plugins::NVBandwidth
+{
+
+NVBandwidthCache::NVBandwidthCache(std::vector<std::string> gpuUuids)
+    : m_gpuUuids(std::move(gpuUuids))
+{}
+
+void NVBandwidthCache::Load(std::string const &path)
+{
+    m_root = Json::Value { Json::objectValue };
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        log_debug("No nvbandwidth cache at '{}'", path);
+        return;
+    }
+
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(file, root) || !root.isObject())
+    {
+        log_warning("Ignoring the invalid nvbandwidth cache '{}': {}", path, reader.getFormattedErrorMessages());
+        return;
+    }
+    m_root = std::move(root);
+}
+
+bool NVBandwidthCache::Save(std::string const &path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        log_warning("Couldn't open the nvbandwidth cache '{}' for writing", path);
+        return false;
+    }
+    file << Json::FastWriter {}.write(m_root);
+    return file.good();
+}
+
+bool NVBandwidthCache::IsSameGpus(Json::Value const &entry) const
+{
+    Json::Value const &gpus = entry["gpus"];
+    if (!gpus.isArray() || gpus.size() != m_gpuUuids.size())
+    {
+        return false;
+    }
+    for (Json::ArrayIndex i = 0; i < gpus.size(); i++)
+    {
+        if (!gpus[i].isString() || gpus[i].asString() != m_gpuUuids[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<TestCase> NVBandwidthCache::Get(std::string const &name) const
+{
+    Json::Value const &testCases = m_root["testcases"];
+    if (!testCases.isObject() || !testCases.isMember(name))
+    {
+        return std::nullopt;
+    }
+    Json::Value const &entry = testCases[name];
+    if (!IsSameGpus(entry))
+    {
+        log_debug("The GPUs of testcase {} changed since it was cached", name);
+        return std::nullopt;
+    }
+    return DcgmNs::JsonSerialize::TryDeserialize<TestCase>(entry["result"]);
+}
+
+void NVBandwidthCache::Put(TestCase const &testCase, Json::Value const &json)
+{
+    if (testCase.status != TestCaseStatus::PASSED && testCase.status != TestCaseStatus::WAIVED)
+    {
+        if (m_root.isMember("testcases") && m_root["testcases"].isObject())
+        {
+            m_root["testcases"].removeMember(testCase.name);
+        }
+        return;
+    }
+
+    Json::Value entry;
+    entry["gpus"] = Json::Value { Json::arrayValue };
+    for (auto const &uuid : m_gpuUuids)
+    {
+        entry["gpus"].append(uuid);
+    }
+    entry["result"]                    = json;
+    m_root["testcases"][testCase.name] = std::move(entry);
+}
+
+std::vector<std::string> NVBandwidthCache::AllTestCases() const
+{
+    std::vector<std::string> names;
+    Json::Value const &all = m_root["all_testcases"];
+    if (!all.isObject() || !IsSameGpus(all) || !all["names"].isArray())
+    {
+        return names;
+    }
+    for (auto const &name : all["names"])
+    {
+        if (name.isString())
+        {
+            names.push_back(name.asString());
+        }
+    }
+    return names;
+}
+
+void NVBandwidthCache::SetAllTestCases(std::vector<std::string> const &names)
+{
+    Json::Value all;
+    all["gpus"]  = Json::Value { Json::arrayValue };
+    all["names"] = Json::Value { Json::arrayValue };
+    for (auto const &uuid : m_gpuUuids)
+    {
+        all["gpus"].append(uuid);
+    }
+    for (auto const &name : names)
+    {
+        all["names"].append(name);
+    }
+    m_root["all_testcases"] = std::move(all);
+}
+
+} //namespace DcgmNs::Nvvs::Plugins::NVBandwidth
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "NVBandwidthResult.h"
+
+#include <json/json.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace DcgmNs::Nvvs::Plugins::NVBandwidth
+{
+
+/**
+ * @brief Results of earlier nvbandwidth runs, kept in a JSON file between runs of the plugin.
+ *
+ * A testcase measures every pair of the GPUs visible to nvbandwidth, and their order gives the rows and columns of
+ * its matrix. A cached result is therefore only reused if it was measured on the same GPUs, in the same order.
+ * Only testcases that passed or were waived are kept.
+ */
+class NVBandwidthCache
+{
+public:
+    /* gpuUuids: UUIDs of the GPUs of this run, in the order of CUDA_VISIBLE_DEVICES */
+    explicit NVBandwidthCache(std::vector<std::string> gpuUuids);
+
+    /**
+     * @brief Read the cache from path. A missing or invalid file leaves the cache empty.
+     */
+    void Load(std::string const &path);
+
+    /**
+     * @brief Write the cache to path
+     * @return false if the file couldn't be written
+     */
+    bool Save(std::string const &path) const;
+
+    /**
+     * @brief The cached result of a testcase, if it was measured on the GPUs of this run
+     */
+    std::optional<TestCase> Get(std::string const &name) const;
+
+    /**
+     * @brief Keep the result of a testcase measured on the GPUs of this run
+     */
+    void Put(TestCase const &testCase, Json::Value const &json);
+
+    /**
+     * @brief Names of the testcases that the last run without a list of testcases on these GPUs reported. Empty if
+     *        there was none.
+     */
+    std::vector<std::string> AllTestCases() const;
+
+    void SetAllTestCases(std::vector<std::string> const &names);
+
+private:
+    bool IsSameGpus(Json::Value const &entry) const;
+
+    std::vector<std::string> m_gpuUuids;
+    Json::Value m_root { Json::objectValue };
+};
+
+} //namespace DcgmNs::Nvvs::Plugins::NVBandwidth
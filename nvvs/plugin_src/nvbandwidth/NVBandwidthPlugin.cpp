@@ -14,16 +14,19 @@
  * limitations under the License.
  */
 #include "NVBandwidthPlugin.h"
+#include "NVBandwidthCache.h"
 #include "NVBandwidthResult.h"
 #include "NvvsCommon.h"
 
 #include <DcgmStringHelpers.h>
+#include <array>
 #include <dlfcn.h>
 #include <errno.h>
 #include <filesystem>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
 namespace DcgmNs::Nvvs::Plugins::NVBandwidth
 {
@@ -41,6 +44,7 @@ NVBandwidthPlugin::NVBandwidthPlugin(dcgmHandle_t handle)
     m_infoStruct.logFileTag     = NVBANDWIDTH_PLUGIN_NAME;
 
     m_testParameters.AddString(NVBANDWIDTH_STR_IS_ALLOWED, "False");
+    m_testParameters.AddString(NVBANDWIDTH_STR_CACHE_FILE, "");
 
     // Set all the defaults for the parameters
     m_testParameters.AddString(PS_LOGFILE, "stats_nvbandwidth.json");
@@ -186,18 +190,55 @@ void NVBandwidthPlugin::SetCudaDriverMajorVersion()
     }
 }
 
-void NVBandwidthPlugin::appendExtraArgv(std::vector<std::string> &execArgv) const
+void NVBandwidthPlugin::appendExtraArgv(std::vector<std::string> &execArgv,
+                                        std::vector<std::string> const &testCases) const
 {
-    std::string nvbandwidthTestcases = m_testParameters.GetString(NVBANDWIDTH_STR_TESTCASES);
-    if (!nvbandwidthTestcases.empty())
+    for (auto const &testCase : testCases)
     {
-        std::vector<std::string> tokens = dcgmTokenizeString(nvbandwidthTestcases, ",");
-        for (auto const &token : tokens)
+        execArgv.push_back("-t");
+        execArgv.push_back(testCase);
+    }
+}
+
+void NVBandwidthPlugin::ReportTestCase(std::string const &testName, TestCase const &testCase, bool cached)
+{
+    std::string_view const source = cached ? " (cached)" : "";
+    switch (testCase.status)
+    {
+        case TestCaseStatus::PASSED:
+            AddInfoVerbose(testName,
+                           fmt::format("Testcase {} passed{}: {} min {:.2f} max {:.2f} average {:.2f}",
+                                       testCase.name,
+                                       source,
+                                       testCase.bandwidthDescription,
+                                       testCase.min,
+                                       testCase.max,
+                                       testCase.avg));
+            break;
+
+        case TestCaseStatus::WAIVED:
+            AddInfoVerbose(testName, fmt::format("Testcase {} was waived{}", testCase.name, source));
+            break;
+
+        case TestCaseStatus::NOTFOUND:
+            AddInfoVerbose(testName, fmt::format("Testcase {} was not found", testCase.name));
+            break;
+
+        case TestCaseStatus::ERROR:
         {
-            execArgv.push_back("-t");
-            execArgv.push_back(token);
+            DcgmError d { DcgmError::GpuIdTag::Unknown };
+            std::string const err = fmt::format("The NVBandwidth testcase {} failed", testCase.name);
+            DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_INTERNAL, d, err.c_str());
+            AddError(testName, d);
+            break;
         }
     }
+    log_debug("nvbandwidth testcase {}: status {}{}", testCase.name, static_cast<int>(testCase.status), source);
+
+    if (!cached)
+    {
+        m_reportedTestCases.push_back(testCase.name);
+    }
 }
 
 
@@ -234,6 +275,7 @@ void NVBandwidthPlugin::Go(std::string const &testName,
     }
 
     std::ostringstream visibleDevices;
+    std::vector<std::string> gpuUuids;
     for (unsigned int entityIdx = 0; entityIdx < entityInfo->numEntities; entityIdx++)
     {
         if (entityInfo->entities[entityIdx].entity.entityGroupId != DCGM_FE_GPU)
@@ -245,6 +287,7 @@ void NVBandwidthPlugin::Go(std::string const &testName,
             visibleDevices << ",";
         }
         visibleDevices << entityInfo->entities[entityIdx].auxField.gpu.attributes.identifiers.uuid;
+        gpuUuids.emplace_back(entityInfo->entities[entityIdx].auxField.gpu.attributes.identifiers.uuid);
     }
 
     int rc = setenv("CUDA_VISIBLE_DEVICES", visibleDevices.str().c_str(), 1);
@@ -264,9 +307,52 @@ void NVBandwidthPlugin::Go(std::string const &testName,
     // Verbose output with argument "-v"
     execArgv.push_back("-v");
 
-    appendExtraArgv(execArgv);
+    std::vector<std::string> testCases;
+    if (std::string const param = m_testParameters.GetString(NVBANDWIDTH_STR_TESTCASES); !param.empty())
+    {
+        testCases = dcgmTokenizeString(param, ",");
+    }
+    bool const runAll = testCases.empty();
+
+    m_reportedTestCases.clear();
+    m_cache.reset();
+    std::string const cacheFile = m_testParameters.GetString(NVBANDWIDTH_STR_CACHE_FILE);
+    if (!cacheFile.empty())
+    {
+        m_cache.emplace(gpuUuids);
+        m_cache->Load(cacheFile);
+
+        /* Without a list of testcases, run the ones that the last such run on these GPUs reported */
+        std::vector<std::string> const wanted = runAll ? m_cache->AllTestCases() : testCases;
+        testCases.clear();
+        for (auto const &name : wanted)
+        {
+            if (auto cached = m_cache->Get(name); cached.has_value())
+            {
+                ReportTestCase(testName, *cached, true);
+            }
+            else
+            {
+                testCases.push_back(name);
+            }
+        }
+
+        if (!wanted.empty() && testCases.empty())
+        {
+            log_info("All {} nvbandwidth testcases were cached for these GPUs; not running nvbandwidth.",
+                     wanted.size());
+            SetResult(testName, NVVS_RESULT_PASS);
+            return;
+        }
+        log_debug("Running {} of {} nvbandwidth testcases that aren't cached for these GPUs.",
+                  testCases.size(),
+                  wanted.size());
+    }
 
-    if (LaunchExecutable(testName, execArgv))
+    appendExtraArgv(execArgv, testCases);
+
+    bool const failed = LaunchExecutable(testName, execArgv);
+    if (failed)
     {
         SetResult(testName, NVVS_RESULT_FAIL);
     }
@@ -275,6 +361,15 @@ void NVBandwidthPlugin::Go(std::string const &testName,
         SetResult(testName, NVVS_RESULT_PASS);
     }
 
+    if (m_cache.has_value())
+    {
+        if (runAll && testCases.empty() && !failed)
+        {
+            m_cache->SetAllTestCases(m_reportedTestCases);
+        }
+        m_cache->Save(cacheFile);
+    }
+
     return;
 }
 
@@ -297,23 +392,46 @@ bool NVBandwidthPlugin::LaunchExecutable(std::string const &testName, std::vecto
     bool errorCondition { false };
     log_debug("Launched the nvbandwidth ({}) with pid {}", execArgv[0], childPid);
 
-    fmt::memory_buffer stdoutStream;
-
-    std::string stdoutStr;
+    // Parse the json output from NVBandwidth executable while it runs, reporting each testcase as it completes
+    NVBandwidthStreamParser parser([&](TestCase const &testCase, Json::Value const &json) {
+        ReportTestCase(testName, testCase, false);
+        if (testCase.status == TestCaseStatus::ERROR)
+        {
+            errorCondition = true;
+        }
+        if (m_cache.has_value())
+        {
+            m_cache->Put(testCase, json);
+        }
+    });
 
-    if (auto const ret = DcgmNs::Utils::ReadProcessOutput(stdoutStream, std::move(outputFd)); ret != 0)
+    std::array<char, 4096> buff {};
+    for (;;)
     {
-        DcgmError d { DcgmError::GpuIdTag::Unknown };
-        const std::string err = fmt::format("Error while reading output from the NVBandwidth: '{}'", strerror(errno));
-        DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_INTERNAL, d, err.c_str());
-        AddError(testName, d);
-        errorCondition = true;
-    }
+        ssize_t const bytesRead = read(outputFd.Get(), buff.data(), buff.size());
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytesRead < 0)
+        {
+            DcgmError d { DcgmError::GpuIdTag::Unknown };
+            const std::string err
+                = fmt::format("Error while reading output from the NVBandwidth: '{}'", strerror(errno));
+            DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_INTERNAL, d, err.c_str());
+            AddError(testName, d);
+            errorCondition = true;
+            break;
+        }
+        if (bytesRead == 0)
+        {
+            break;
+        }
 
-    // Set output string in caller's context
-    // Do this before the error check so that if there are errors, we have more useful error messages
-    stdoutStr = fmt::to_string(stdoutStream);
-    log_debug("External command stdout: \n {}", stdoutStr);
+        std::string_view const chunk { buff.data(), static_cast<size_t>(bytesRead) };
+        log_debug("External command stdout: \n {}", chunk);
+        parser.Feed(chunk);
+    }
 
     // Get exit status of child
     int childStatus { 0 };
@@ -359,15 +477,15 @@ bool NVBandwidthPlugin::LaunchExecutable(std::string const &testName, std::vecto
         errorCondition = true;
     }
 
-    // Parse the json output from NVBandwidth executable
-    auto parsedResult = AttemptToReadOutput(stdoutStr);
-    if (parsedResult.first)
+    // Failed testcases were reported as they completed
+    auto result = parser.Finish();
+    if (!result.has_value() || (errorCondition && result->overallError.has_value()))
     {
         DcgmError d { DcgmError::GpuIdTag::Unknown };
         std::string err = "Error found in the NVBandwidth JSON output. ";
-        if (parsedResult.second.has_value() && parsedResult.second.value().overallError.has_value())
+        if (result.has_value())
         {
-            err += parsedResult.second.value().overallError.value();
+            err += result->overallError.value();
         }
         DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_INTERNAL, d, err.c_str());
         AddError(testName, d);
@@ -376,81 +494,16 @@ bool NVBandwidthPlugin::LaunchExecutable(std::string const &testName, std::vecto
     return errorCondition;
 }
 
-static std::string_view sanitizeOutput(std::string_view output)
-{
-    auto is_only_char_in_line = [](std::string_view line, char c) {
-        if (line.empty())
-            return false;
-        return line.find_first_not_of("\t") == line.find(c) && line.find_last_not_of("\t\n") == line.find(c);
-    };
-
-    size_t start = std::string_view::npos;
-    size_t end   = std::string_view::npos;
-    size_t pos   = 0;
-
-    // Find the start position of the valid json object
-    while (pos < output.length())
-    {
-        size_t newline_pos = output.find('\n', pos);
-        if (newline_pos == std::string_view::npos)
-        {
-            break;
-        }
-        std::string_view line = output.substr(pos, newline_pos - pos + 1);
-        if (is_only_char_in_line(line, '{'))
-        {
-            start = pos;
-            break;
-        }
-        pos = newline_pos + 1;
-    }
-
-    if (start == std::string_view::npos)
-    {
-        return {};
-    }
-
-    // Find the end position of the valid json object
-    pos = output.length() - 1;
-    while (pos > 0)
-    {
-        size_t newline_pos = output.rfind('\n', pos);
-        if (newline_pos == std::string_view::npos)
-        {
-            break;
-        }
-        std::string_view line = output.substr(newline_pos + 1, pos - newline_pos);
-        if (is_only_char_in_line(line, '}'))
-        {
-            end = newline_pos + 1;
-            break;
-        }
-        pos = newline_pos - 1;
-    }
-
-    if (end != std::string_view::npos && start < end)
-    {
-        return output.substr(start, end - start + 1);
-    }
-    return {};
-}
-
 std::pair<bool, std::optional<NVBandwidthResult>> NVBandwidthPlugin::AttemptToReadOutput(std::string_view output)
 {
-    std::string_view jsonObj = sanitizeOutput(output);
-    log_debug("Sanitized nvbandwidth stdout string: \n{}", jsonObj);
-    if (jsonObj.empty())
+    NVBandwidthStreamParser parser;
+    parser.Feed(output);
+    auto resultOpt = parser.Finish();
+    if (!resultOpt.has_value())
     {
-        log_error("The nvbandwidth binary output doesn't contain valid JSON object.");
         return std::make_pair(true, std::nullopt);
     }
     bool errorFound { false };
-    auto resultOpt = DcgmNs::JsonSerialize::TryDeserialize<NVBandwidthResult>(jsonObj);
-    if (!resultOpt.has_value())
-    {
-        errorFound = true;
-        return std::make_pair(errorFound, std::nullopt);
-    }
     auto &tcs = resultOpt.value().testCases;
     if (std::any_of(tcs.begin(), tcs.end(), [](TestCase const &tc) { return tc.status == TestCaseStatus::ERROR; }))
     {
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include "NVBandwidthCache.h"
+
 #include <DcgmError.h>
 #include <DcgmRecorder.h>
 #include <DcgmUtilities.h>
@@ -27,8 +29,6 @@
 
 namespace DcgmNs::Nvvs::Plugins::NVBandwidth
 {
-// Forward declaration
-struct NVBandwidthResult;
 class NVBandwidthPlugin : public Plugin
 {
 public:
@@ -82,7 +82,14 @@ private:
 
     std::string GetNvBandwidthTestName() const;
 
-    void appendExtraArgv(std::vector<std::string> &execArgv) const;
+    void appendExtraArgv(std::vector<std::string> &execArgv, std::vector<std::string> const &testCases) const;
+
+    /*************************************************************************/
+    /*
+     * Report the result of a testcase as soon as it is known: as info if it passed, was waived or not found, and as
+     * an error if it failed. cached is true for results taken from the cache instead of this run.
+     */
+    void ReportTestCase(std::string const &testName, TestCase const &testCase, bool cached);
 
     /*************************************************************************/
     TestParameters m_testParameters; /* Parameters for this test, passed in from the framework.
@@ -93,5 +100,7 @@ private:
     unsigned int m_cudaDriverMajorVersion;                     /* Cuda driver major version */
     std::unique_ptr<dcgmDiagPluginEntityList_v1> m_entityInfo; // The information about each GPU
     std::string m_nvbandwidthDir;
+    std::optional<NVBandwidthCache> m_cache;      /* Set when NVBANDWIDTH_STR_CACHE_FILE is */
+    std::vector<std::string> m_reportedTestCases; /* Testcases this run of nvbandwidth reported so far */
 };
 } //namespace DcgmNs::Nvvs::Plugins::NVBandwidth
\ No newline at end of file
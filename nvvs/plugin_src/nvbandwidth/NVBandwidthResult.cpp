@@ -209,4 +209,197 @@ std::optional<NVBandwidthResult> ParseJson(Json::Value const &root, DcgmNs::Json
     return result;
 }
 
+NVBandwidthStreamParser::NVBandwidthStreamParser(TestCaseCallback onTestCase)
+    : m_onTestCase(std::move(onTestCase))
+{}
+
+bool NVBandwidthStreamParser::Feed(std::string_view chunk)
+{
+    for (std::size_t pos = 0; pos < chunk.size() && m_state != State::Invalid; pos++)
+    {
+        char const c = chunk[pos];
+        if (m_state == State::InDocument)
+        {
+            ScanChar(c);
+        }
+        else if (m_state == State::SeekingDocument)
+        {
+            if (c != '\n')
+            {
+                m_line += c;
+                continue;
+            }
+            if (boost::algorithm::trim_copy(m_line) == "{")
+            {
+                m_state = State::InDocument;
+                ScanChar('{');
+                ScanChar('\n');
+            }
+            else
+            {
+                log_debug("Skipping nvbandwidth output before the JSON document: {}", m_line);
+            }
+            m_line.clear();
+        }
+        else
+        {
+            /* Trailing output after the document */
+            break;
+        }
+    }
+    return m_state != State::Invalid;
+}
+
+void NVBandwidthStreamParser::ScanChar(char c)
+{
+    /* Characters of a testcase go to its own text. The ones between testcases are dropped, so that the skeleton has
+       an empty "testcases" array */
+    std::string *out = &m_skeleton;
+    if (m_testCasesDepth != 0 && m_stack.size() > m_testCasesDepth)
+    {
+        out = &m_testCaseText;
+    }
+    else if (m_testCasesDepth != 0 && m_stack.size() == m_testCasesDepth && (m_inString || c != ']'))
+    {
+        out = nullptr;
+    }
+
+    if (m_inString)
+    {
+        if (m_escaped)
+        {
+            m_escaped = false;
+        }
+        else if (c == '\\')
+        {
+            m_escaped = true;
+        }
+        else if (c == '"')
+        {
+            m_inString   = false;
+            m_lastString = std::move(m_string);
+            m_string.clear();
+        }
+        if (m_inString)
+        {
+            m_string += c;
+        }
+    }
+    else
+    {
+        switch (c)
+        {
+            case '"':
+                m_inString = true;
+                break;
+
+            case ':':
+                m_key = std::move(m_lastString);
+                m_lastString.clear();
+                break;
+
+            case ',':
+                m_key.clear();
+                break;
+
+            case '{':
+            case '[':
+                if (c == '{' && m_testCasesDepth != 0 && m_stack.size() == m_testCasesDepth)
+                {
+                    m_testCaseText.clear();
+                    out = &m_testCaseText;
+                }
+                m_stack.push_back({ c == '{' ? '}' : ']', std::move(m_key) });
+                m_key.clear();
+                if (c == '[' && m_stack.size() == 3 && m_stack[1].key == "nvbandwidth"
+                    && m_stack[2].key == "testcases")
+                {
+                    m_testCasesDepth = m_stack.size();
+                }
+                break;
+
+            case '}':
+            case ']':
+                if (m_stack.empty() || m_stack.back().close != c)
+                {
+                    log_error("Unbalanced '{}' in the nvbandwidth JSON output.", c);
+                    m_state = State::Invalid;
+                    return;
+                }
+                if (m_stack.size() == m_testCasesDepth)
+                {
+                    m_testCasesDepth = 0;
+                }
+                m_stack.pop_back();
+                m_key.clear();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (out != nullptr)
+    {
+        *out += c;
+    }
+
+    if (!m_inString && c == '}' && m_testCasesDepth != 0 && m_stack.size() == m_testCasesDepth)
+    {
+        EndTestCase();
+    }
+    if (m_stack.empty())
+    {
+        m_state = State::Done;
+    }
+}
+
+void NVBandwidthStreamParser::EndTestCase()
+{
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(m_testCaseText, root))
+    {
+        log_error("Invalid testcase in the nvbandwidth JSON output: {}", reader.getFormattedErrorMessages());
+        m_state = State::Invalid;
+        return;
+    }
+    m_testCaseText.clear();
+
+    auto testCase = DcgmNs::JsonSerialize::TryDeserialize<TestCase>(root);
+    if (!testCase.has_value())
+    {
+        m_state = State::Invalid;
+        return;
+    }
+    if (m_onTestCase)
+    {
+        m_onTestCase(*testCase, root);
+    }
+    m_testCases.emplace_back(std::move(*testCase));
+}
+
+std::optional<NVBandwidthResult> NVBandwidthStreamParser::Finish()
+{
+    if (m_state != State::Done)
+    {
+        log_error("The nvbandwidth binary output doesn't contain a complete JSON object.");
+        return std::nullopt;
+    }
+
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(m_skeleton, root))
+    {
+        log_error("Invalid nvbandwidth JSON output: {}", reader.getFormattedErrorMessages());
+        return std::nullopt;
+    }
+    auto result = DcgmNs::JsonSerialize::TryDeserialize<NVBandwidthResult>(root);
+    if (result.has_value())
+    {
+        result->testCases = std::move(m_testCases);
+    }
+    return result;
+}
+
 } //namespace DcgmNs::Nvvs::Plugins::NVBandwidth
@@ -15,14 +15,13 @@
  */
 #pragma once
 
-#include "NVBandwidthPlugin.h"
-
 #include <DcgmJsonSerialize.hpp>
 
 #include <fmt/format.h>
 #include <json/json.h>
 
 #include <cmath>
+#include <functional>
 #include <optional>
 #include <string>
 #include <variant>
@@ -80,4 +79,65 @@ struct NVBandwidthResult
 
 std::optional<NVBandwidthResult> ParseJson(Json::Value const &root, DcgmNs::JsonSerialize::To<NVBandwidthResult>);
 
+/**
+ * @brief Parses the output of nvbandwidth -j while it is being read.
+ *
+ * Lines before the document, such as warnings, are skipped. The document starts at the first line that only holds
+ * '{' and ends with its matching '}'; anything after it is ignored. Each object of "testcases" is parsed and handed
+ * to the callback as soon as its closing brace is fed. Its text is dropped then, so only one testcase is held as
+ * text at any time, however large the bandwidth matrices get.
+ */
+class NVBandwidthStreamParser
+{
+public:
+    /* Called with each testcase and the JSON it was parsed from */
+    using TestCaseCallback = std::function<void(TestCase const &, Json::Value const &)>;
+
+    explicit NVBandwidthStreamParser(TestCaseCallback onTestCase = {});
+
+    /**
+     * @brief Parse the next chunk of output
+     * @return false once the output can't be parsed any further
+     */
+    bool Feed(std::string_view chunk);
+
+    /**
+     * @brief The result with every testcase that was fed
+     * @return std::nullopt if the document didn't end or isn't valid
+     */
+    std::optional<NVBandwidthResult> Finish();
+
+private:
+    enum class State
+    {
+        SeekingDocument, /* Skipping lines until one only holds '{' */
+        InDocument,
+        Done,            /* The document ended */
+        Invalid,
+    };
+
+    struct Container
+    {
+        char close;      /* '}' or ']' */
+        std::string key; /* Key of the member it is the value of. Empty for array elements */
+    };
+
+    void ScanChar(char c);
+    void EndTestCase();
+
+    TestCaseCallback m_onTestCase;
+    State m_state { State::SeekingDocument };
+    std::string m_line;                 /* Partial line while seeking the document */
+    std::string m_skeleton;             /* The document without the objects of "testcases" */
+    std::string m_testCaseText;         /* The testcase being read */
+    std::vector<Container> m_stack;     /* Open objects and arrays */
+    std::size_t m_testCasesDepth { 0 }; /* Depth of the "testcases" array while it is open, 0 otherwise */
+    bool m_inString { false };
+    bool m_escaped { false };
+    std::string m_string;     /* The string being read */
+    std::string m_lastString; /* The last string that was read, which is the key when ':' follows */
+    std::string m_key;        /* Key of the value that comes next */
+    std::vector<TestCase> m_testCases;
+};
+
 } //namespace DcgmNs::Nvvs::Plugins::NVBandwidth
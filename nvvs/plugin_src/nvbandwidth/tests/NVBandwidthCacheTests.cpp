@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <NVBandwidthCache.h>
+
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+#include <fmt/format.h>
+#include <unistd.h>
+
+namespace
+{
+using namespace DcgmNs::Nvvs::Plugins::NVBandwidth;
+
+std::pair<TestCase, Json::Value> MakeTestCase(std::string const &name, std::string const &status)
+{
+    Json::Value json;
+    json["name"]    = name;
+    json["status"]  = status;
+    json["average"] = 12.5;
+    return { DcgmNs::JsonSerialize::TryDeserialize<TestCase>(json).value(), json };
+}
+} // namespace
+
+TEST_CASE("NVBandwidthCache: Results are reused on the same GPUs only")
+{
+    std::vector<std::string> const gpus { "GPU-0", "GPU-1" };
+    NVBandwidthCache cache(gpus);
+
+    auto const [passed, passedJson] = MakeTestCase("host_to_device_memcpy_ce", "Passed");
+    auto const [failed, failedJson] = MakeTestCase("device_to_device_memcpy_read_ce", "Error");
+    cache.Put(passed, passedJson);
+    cache.Put(failed, failedJson);
+    cache.SetAllTestCases({ passed.name, failed.name });
+
+    auto const cached = cache.Get(passed.name);
+    REQUIRE(cached.has_value());
+    REQUIRE(cached->status == TestCaseStatus::PASSED);
+    REQUIRE(cached->avg == 12.5);
+
+    /* Failed testcases are always run again */
+    REQUIRE_FALSE(cache.Get(failed.name).has_value());
+
+    std::string const path = std::filesystem::temp_directory_path() / fmt::format("nvbandwidth_cache_{}", getpid());
+    REQUIRE(cache.Save(path));
+
+    SECTION("Same GPUs")
+    {
+        NVBandwidthCache loaded(gpus);
+        loaded.Load(path);
+        REQUIRE(loaded.Get(passed.name).has_value());
+        REQUIRE(loaded.AllTestCases() == std::vector<std::string> { passed.name, failed.name });
+    }
+
+    SECTION("Other GPUs or order")
+    {
+        auto const otherGpus = GENERATE(std::vector<std::string> { "GPU-1", "GPU-0" },
+                                        std::vector<std::string> { "GPU-0", "GPU-1", "GPU-2" },
+                                        std::vector<std::string> { "GPU-0" });
+        NVBandwidthCache loaded(otherGpus);
+        loaded.Load(path);
+        REQUIRE_FALSE(loaded.Get(passed.name).has_value());
+        REQUIRE(loaded.AllTestCases().empty());
+    }
+
+    SECTION("A failure replaces a cached result")
+    {
+        NVBandwidthCache loaded(gpus);
+        loaded.Load(path);
+        auto const [failedNow, failedNowJson] = MakeTestCase(passed.name, "Error");
+        loaded.Put(failedNow, failedNowJson);
+        REQUIRE_FALSE(loaded.Get(passed.name).has_value());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("NVBandwidthCache: Missing or invalid file")
+{
+    NVBandwidthCache cache({ "GPU-0" });
+    cache.Load("/nonexistent/nvbandwidth_cache");
+    REQUIRE_FALSE(cache.Get("host_to_device_memcpy_ce").has_value());
+    REQUIRE(cache.AllTestCases().empty());
+}
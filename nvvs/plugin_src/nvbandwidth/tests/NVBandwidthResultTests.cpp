@@ -20,6 +20,8 @@
 #include <PluginInterface.h>
 #include <catch2/catch_all.hpp>
 
+extern const char *verboseFullOutputWithErrors;
+
 TEST_CASE("NVBandwidthResult: Deserialize TestCaseStatus")
 {
     using namespace DcgmNs::Nvvs::Plugins::NVBandwidth;
@@ -408,4 +410,102 @@ TEST_CASE("NVBandwidthResult: Deserialize NVBandwidthResult with valid testcase"
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("NVBandwidthStreamParser: Testcases are reported as they complete")
+{
+    using namespace DcgmNs::Nvvs::Plugins::NVBandwidth;
+    std::string_view const output { verboseFullOutputWithErrors };
+    std::vector<std::string> reported;
+    NVBandwidthStreamParser parser([&](TestCase const &testCase, Json::Value const &json) {
+        REQUIRE(json["name"].asString() == testCase.name);
+        reported.push_back(testCase.name);
+    });
+
+    /* Everything up to the closing brace of the first testcase */
+    auto const firstEnd = output.find("\n\t\t\t},") + 5;
+    REQUIRE(parser.Feed(output.substr(0, firstEnd - 1)));
+    REQUIRE(reported.empty());
+    REQUIRE(parser.Feed(output.substr(firstEnd - 1, 1)));
+    REQUIRE(reported == std::vector<std::string> { "host_to_device_memcpy_ce" });
+
+    /* The rest in small chunks, like reads from a pipe */
+    for (auto pos = firstEnd; pos < output.size(); pos += 7)
+    {
+        REQUIRE(parser.Feed(output.substr(pos, 7)));
+    }
+
+    auto const result = parser.Finish();
+    REQUIRE(result.has_value());
+    REQUIRE(result->driverVersion == "565.02");
+    REQUIRE(result->cudaRuntimeVersion == 12070);
+    REQUIRE(result->testCases.size() == reported.size());
+    REQUIRE(reported.back() == "device_to_device_latency_sm");
+    REQUIRE(result->testCases[0].status == TestCaseStatus::PASSED);
+    REQUIRE(result->testCases[0].bandwidthMatrix.data.size() == 1);
+}
+
+TEST_CASE("NVBandwidthStreamParser: Braces in strings")
+{
+    using namespace DcgmNs::Nvvs::Plugins::NVBandwidth;
+    std::string_view const output = R"(WARNING: {
+{
+    "nvbandwidth" : {
+        "CUDA Runtime Version" : 12070,
+        "Driver Version" : "565.02",
+        "git_version" : "}]\"",
+        "testcases" : [
+            { "name" : "a}", "status" : "Passed", "bandwidth_description" : "{[" },
+            { "name" : "b", "status" : "Error" }
+        ]
+    }
+}
+WARNING: }
+)";
+    NVBandwidthStreamParser parser;
+    REQUIRE(parser.Feed(output));
+    auto const result = parser.Finish();
+    REQUIRE(result.has_value());
+    REQUIRE(result->gitVersion == "}]\"");
+    REQUIRE(result->testCases.size() == 2);
+    REQUIRE(result->testCases[0].name == "a}");
+    REQUIRE(result->testCases[0].bandwidthDescription == "{[");
+    REQUIRE(result->testCases[1].status == TestCaseStatus::ERROR);
+}
+
+TEST_CASE("NVBandwidthStreamParser: Incomplete or invalid output")
+{
+    using namespace DcgmNs::Nvvs::Plugins::NVBandwidth;
+    std::string_view const output { verboseFullOutputWithErrors };
+
+    SECTION("No document")
+    {
+        NVBandwidthStreamParser parser;
+        REQUIRE(parser.Feed("WARNING: no JSON {}\n"));
+        REQUIRE_FALSE(parser.Finish().has_value());
+    }
+
+    SECTION("Truncated document")
+    {
+        NVBandwidthStreamParser parser;
+        REQUIRE(parser.Feed(output.substr(0, output.size() / 2)));
+        REQUIRE_FALSE(parser.Finish().has_value());
+    }
+
+    SECTION("Unbalanced brackets")
+    {
+        NVBandwidthStreamParser parser;
+        REQUIRE_FALSE(parser.Feed("{\n\"nvbandwidth\" : ]\n"));
+        REQUIRE_FALSE(parser.Finish().has_value());
+    }
+
+    SECTION("Invalid testcase")
+    {
+        NVBandwidthStreamParser parser;
+        REQUIRE_FALSE(parser.Feed(R"({
+"nvbandwidth" : { "testcases" : [ { "name" : "a", "status" : "unknown" } ] }
+}
+)"));
+        REQUIRE_FALSE(parser.Finish().has_value());
+    }
+}
@@ -50,6 +50,8 @@ Brokenp2p::Brokenp2p(BusGrind *bg, std::vector<PluginDevice *> &gpus, size_t siz
 
 void Brokenp2p::ResetCudaDevices(int cudaId1, int cudaId2)
 {
+    // The shared cuBLAS handles belong to the primary contexts that are about to be destroyed
+    Dcgm::CublasProxy::CublasDestroySharedHandles();
     cudaSetDevice(cudaId1);
     cudaDeviceReset();
     cudaSetDevice(cudaId2);
@@ -66,6 +66,7 @@ BusGrind::BusGrind(dcgmHandle_t handle)
     , m_testDuration(.0)
     , m_gpuNvlinksExpectedUp(0)
     , m_nvSwitchNvlinksExpectedUp(0)
+    , m_p2pEnabled(false)
     , m_useDgemm(0)
     , m_matrixDim(0)
     , m_maxAer(1)
@@ -103,6 +104,7 @@ BusGrind::BusGrind(dcgmHandle_t handle)
     tp->AddDouble(PCIE_STR_AER_THRESHOLD, 480.0); /* 32/minute * 15 minutes */
     tp->AddDouble(PCIE_STR_PARALLEL_BW_CHECK_DURATION, 15.0);
     tp->AddString(PCIE_STR_DONT_BIND_NUMA, "False");
+    tp->AddString(PCIE_STR_CONCURRENT_PAIRS, "False");
 
     tp->AddSubTestDouble(PCIE_SUBTEST_H2D_D2H_SINGLE_PINNED, PCIE_STR_INTS_PER_COPY, PCIE_DEFAULT_INTS_PER_COPY);
     tp->AddSubTestDouble(PCIE_SUBTEST_H2D_D2H_SINGLE_PINNED, PCIE_STR_ITERATIONS, PCIE_DEFAULT_ITERATIONS);
@@ -515,7 +517,7 @@ int BusGrind::CudaInit(void)
         }
 
         /* Initialize cublas */
-        cubSt = Dcgm::CublasProxy::CublasCreate(&device->cublasHandle);
+        cubSt = Dcgm::CublasProxy::CublasAcquireSharedHandle(device->cudaDeviceIdx, &device->cublasHandle);
         if (cubSt != CUBLAS_STATUS_SUCCESS)
         {
             LOG_CUBLAS_ERROR(GetPcieTestName(), "cublasCreate", cubSt, device->gpuId);
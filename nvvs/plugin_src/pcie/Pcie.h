@@ -22,6 +22,7 @@
 
 
 #include <cublas_proxy.hpp>
+#include <array>
 #include <dcgm_structs.h>
 #include <iostream>
 #include <string>
@@ -63,7 +64,7 @@ public:
         if (allocatedCublasHandle != 0)
         {
             log_debug("cublasDestroy cudaDeviceIdx {}, handle {}", cudaDeviceIdx, (void *)cublasHandle);
-            CublasProxy::CublasDestroy(cublasHandle);
+            CublasProxy::CublasReleaseSharedHandle(cublasHandle);
             cublasHandle          = 0;
             allocatedCublasHandle = 0;
         }
@@ -88,6 +89,23 @@ public:
     }
 };
 
+/*****************************************************************************/
+/* CUDA resources of one GPU that the subtests share instead of creating their own. See AcquireGpuResources() */
+struct PcieGpuResources
+{
+    cudaEvent_t start    = nullptr;
+    cudaEvent_t stop     = nullptr;
+    cudaStream_t stream0 = nullptr;
+    cudaStream_t stream1 = nullptr;
+
+    int *deviceBuffer       = nullptr;
+    size_t deviceBufferSize = 0; /* In bytes */
+    int *pinnedBuffer       = nullptr; /* Pinned host memory on the GPU's local NUMA nodes */
+    size_t pinnedBufferSize = 0;       /* In bytes */
+
+    std::array<unsigned long long, 4> memAffinity {}; /* Mask of the GPU's local NUMA nodes. All 0 if unknown */
+};
+
 namespace
 {
 constexpr double PCIE_DEFAULT_INTS_PER_COPY    = (512.0 / sizeof(int)) * 1024.0 * 1024.0;
@@ -138,6 +156,9 @@ public:
 
     std::vector<PluginDevice *> gpu; /* Per-gpu information */
 
+    std::vector<PcieGpuResources> m_gpuResources; /* Per-gpu resources shared by the subtests. Parallel to gpu */
+    bool m_p2pEnabled;                            /* Is peer access currently enabled between the GPUs? */
+
     void Go(std::string const &testName,
             dcgmDiagPluginEntityList_v1 const *entityInfo,
             unsigned int numParameters,
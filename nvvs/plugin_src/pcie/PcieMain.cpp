@@ -31,7 +31,9 @@
 #include <algorithm>
 #include <cstdio>
 #include <errno.h>
+#include <linux/mempolicy.h>
 #include <sstream>
+#include <sys/syscall.h>
 #include <sys/wait.h>
 #include <thread>
 #include <unistd.h>
@@ -182,6 +184,29 @@ void disableP2P(BusGrind *bg)
     }
 }
 
+/*****************************************************************************/
+// enables or disables P2P for all GPUs, unless it already is. P2P is left as the last subtest set it
+// so that consecutive subtests with the same setting don't toggle it
+void setP2P(BusGrind *bg, bool enable)
+{
+    if (enable == bg->m_p2pEnabled)
+    {
+        return;
+    }
+
+    /* Set first: if enabling fails part way, disabling later still has to undo the rest */
+    bg->m_p2pEnabled = enable;
+
+    if (enable)
+    {
+        enableP2P(bg);
+    }
+    else
+    {
+        disableP2P(bg);
+    }
+}
+
 /*****************************************************************************/
 // outputs latency information to addInfo for verbose reporting
 void addLatencyInfo(BusGrind *bg, unsigned int gpu, std::string key, double latency)
@@ -388,69 +413,195 @@ MemoryToGpuMap_t GetGpuMemoryAffinities(BusGrind &bg)
     return memoryNodeToGpuList;
 }
 
+/*****************************************************************************/
+/*
+ * cudaMallocHost() with the pages placed on the NUMA nodes in nodeMask. It runs on its own thread so the memory
+ * policy of the calling thread is left alone; cudaMallocHost() touches the pages, so they are placed under the
+ * policy of that thread. Falls back to an unbound allocation if the nodes can't be used
+ */
+static cudaError_t MallocHostOnNodes(void **ptr, size_t size, memAffinity_t const &nodeMask)
+{
+    cudaError_t ret = cudaSuccess;
+
+    std::jthread allocThread([&]() {
+        bool const bound = std::any_of(nodeMask.begin(), nodeMask.end(), [](unsigned long long m) { return m != 0; })
+                           /* The kernel ignores the last bit of maxnode */
+                           && syscall(SYS_set_mempolicy, MPOL_BIND, nodeMask.data(), nodeMask.size() * 64 + 1) == 0;
+
+        ret = cudaMallocHost(ptr, size);
+        if (ret != cudaSuccess && bound)
+        {
+            log_debug("Couldn't allocate {} pinned bytes on the GPU's NUMA nodes. Allocating on any node.", size);
+            cudaGetLastError();
+            syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+            ret = cudaMallocHost(ptr, size);
+        }
+    });
+
+    allocThread.join();
+    return ret;
+}
+
+/*****************************************************************************/
+// creates each GPU's events and streams, and grows its buffers to at least the given sizes
+static int CreateGpuResources(BusGrind *bg, size_t deviceBytes, size_t pinnedBytes)
+{
+    if (bg->m_gpuResources.empty())
+    {
+        bg->m_gpuResources.resize(bg->gpu.size());
+
+        for (auto const &[nodeMask, gpuIds] : GetGpuMemoryAffinities(*bg))
+        {
+            for (size_t d = 0; d < bg->gpu.size(); d++)
+            {
+                if (std::find(gpuIds.begin(), gpuIds.end(), bg->gpu[d]->gpuId) != gpuIds.end())
+                {
+                    bg->m_gpuResources[d].memAffinity = nodeMask;
+                }
+            }
+        }
+
+        for (size_t d = 0; d < bg->gpu.size(); d++)
+        {
+            PcieGpuResources &res = bg->m_gpuResources[d];
+            cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
+            cudaCheckError(cudaEventCreate, (&res.start), PCIE_ERR_CUDA_EVENT_FAIL, d);
+            cudaCheckError(cudaEventCreate, (&res.stop), PCIE_ERR_CUDA_EVENT_FAIL, d);
+            cudaCheckError(cudaStreamCreate, (&res.stream0), PCIE_ERR_CUDA_STREAM_FAIL, d);
+            cudaCheckError(cudaStreamCreate, (&res.stream1), PCIE_ERR_CUDA_STREAM_FAIL, d);
+        }
+    }
+
+    for (size_t d = 0; d < bg->gpu.size(); d++)
+    {
+        PcieGpuResources &res = bg->m_gpuResources[d];
+        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
+
+        if (res.deviceBufferSize < deviceBytes)
+        {
+            cudaFree(res.deviceBuffer);
+            res.deviceBuffer     = nullptr;
+            res.deviceBufferSize = 0;
+            cudaCheckError(cudaMalloc, ((void **)&res.deviceBuffer, deviceBytes), PCIE_ERR_CUDA_ALLOC_FAIL, d);
+            res.deviceBufferSize = deviceBytes;
+        }
+
+        if (res.pinnedBufferSize < pinnedBytes)
+        {
+            cudaFreeHost(res.pinnedBuffer);
+            res.pinnedBuffer     = nullptr;
+            res.pinnedBufferSize = 0;
+            cudaCheckError(MallocHostOnNodes,
+                           ((void **)&res.pinnedBuffer, pinnedBytes, res.memAffinity),
+                           PCIE_ERR_CUDA_ALLOC_FAIL,
+                           d);
+            res.pinnedBufferSize = pinnedBytes;
+        }
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+// frees every GPU's shared resources and disables P2P
+void ReleaseGpuResources(BusGrind *bg)
+{
+    setP2P(bg, false);
+
+    for (size_t d = 0; d < bg->m_gpuResources.size(); d++)
+    {
+        PcieGpuResources &res = bg->m_gpuResources[d];
+        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
+
+        cudaFreeHost(res.pinnedBuffer);
+        cudaFree(res.deviceBuffer);
+        if (res.start != nullptr)
+        {
+            cudaEventDestroy(res.start);
+        }
+        if (res.stop != nullptr)
+        {
+            cudaEventDestroy(res.stop);
+        }
+        if (res.stream0 != nullptr)
+        {
+            cudaStreamDestroy(res.stream0);
+        }
+        if (res.stream1 != nullptr)
+        {
+            cudaStreamDestroy(res.stream1);
+        }
+    }
+
+    bg->m_gpuResources.clear();
+}
+
+/*****************************************************************************/
+/*
+ * Get the events, streams and buffers that the subtests share, one set per GPU in bg->m_gpuResources. They are
+ * created on first use and kept until ReleaseGpuResources(), so the multi-GB pinned buffers are allocated once per
+ * GPU rather than once per subtest. Each GPU's pinned buffer is on its local NUMA nodes.
+ *
+ * deviceBytes and pinnedBytes are the minimum buffer sizes that the caller needs.
+ *
+ * Returns: 0 on success
+ *         -1 on a CUDA error. Everything is released
+ */
+int AcquireGpuResources(BusGrind *bg, size_t deviceBytes, size_t pinnedBytes)
+{
+    if (CreateGpuResources(bg, deviceBytes, pinnedBytes) != 0)
+    {
+        ReleaseGpuResources(bg);
+        return -1;
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
 int performHostToDeviceWork(BusGrind &bg, bool pinned, const std::string &groupName)
 {
-    std::vector<int *> d_buffers(bg.gpu.size());
-    int *h_buffer = 0;
-    std::vector<cudaEvent_t> start(bg.gpu.size());
-    std::vector<cudaEvent_t> stop(bg.gpu.size());
-    std::vector<cudaStream_t> stream1(bg.gpu.size());
-    std::vector<cudaStream_t> stream2(bg.gpu.size());
+    int *unpinnedBuffer = 0;
     float time_ms;
     double time_s;
     double gb;
     std::string key;
 
-    /* Initialize buffers to make valgrind happy */
-    for (size_t i = 0; i < bg.gpu.size(); i++)
-    {
-        d_buffers[i] = 0;
-        stream1[i]   = 0;
-        stream2[i]   = 0;
-    }
-
     int numElems = (int)bg.m_testParameters->GetSubTestDouble(groupName, PCIE_STR_INTS_PER_COPY);
     int repeat   = (int)bg.m_testParameters->GetSubTestDouble(groupName, PCIE_STR_ITERATIONS);
 
-    for (size_t d = 0; d < bg.gpu.size(); d++)
+    if (AcquireGpuResources(&bg, numElems * sizeof(int), pinned ? numElems * sizeof(int) : 0) != 0)
     {
-        cudaSetDevice(bg.gpu[d]->cudaDeviceIdx);
-        cudaCheckErrorRef(cudaMalloc, (&d_buffers[d], numElems * sizeof(int)), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckErrorRef(cudaEventCreate, (&start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorRef(cudaEventCreate, (&stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorRef(cudaStreamCreate, (&stream1[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckErrorRef(cudaStreamCreate, (&stream2[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
+        return -1;
     }
 
-    if (pinned)
+    if (!pinned)
     {
-        cudaCheckErrorGeneralRef(cudaMallocHost, (&h_buffer, numElems * sizeof(int)), PCIE_ERR_CUDA_ALLOC_FAIL);
-    }
-    else
-    {
-        h_buffer = (int *)malloc(numElems * sizeof(int));
+        unpinnedBuffer = (int *)malloc(numElems * sizeof(int));
     }
 
     std::vector<double> bandwidthMatrix(6 * bg.gpu.size());
 
     for (size_t i = 0; i < bg.gpu.size(); i++)
     {
+        PcieGpuResources &res = bg.m_gpuResources[i];
+        int *h_buffer         = pinned ? res.pinnedBuffer : unpinnedBuffer;
         cudaSetDevice(bg.gpu[i]->cudaDeviceIdx);
 
         // D2H bandwidth test
-        // coverity[leaked_storage] this macro can exit the function without freeing h_buffer
+        // coverity[leaked_storage] this macro can exit the function without freeing unpinnedBuffer
         cudaCheckErrorRef(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-        cudaEventRecord(start[i]);
+        cudaEventRecord(res.start);
 
         for (int r = 0; r < repeat; r++)
         {
-            cudaMemcpyAsync(h_buffer, d_buffers[i], sizeof(int) * numElems, cudaMemcpyDeviceToHost);
+            cudaMemcpyAsync(h_buffer, res.deviceBuffer, sizeof(int) * numElems, cudaMemcpyDeviceToHost);
         }
 
-        cudaEventRecord(stop[i]);
+        cudaEventRecord(res.stop);
         cudaCheckErrorRef(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
 
-        cudaEventElapsedTime(&time_ms, start[i], stop[i]);
+        cudaEventElapsedTime(&time_ms, res.start, res.stop);
         time_s = time_ms / 1e3;
 
         gb                                     = numElems * sizeof(int) * repeat / (double)1e9;
@@ -458,16 +609,16 @@ int performHostToDeviceWork(BusGrind &bg, bool pinned, const std::string &groupN
 
         // H2D bandwidth test
         cudaCheckErrorRef(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-        cudaEventRecord(start[i]);
+        cudaEventRecord(res.start);
 
         for (int r = 0; r < repeat; r++)
         {
-            cudaMemcpyAsync(d_buffers[i], h_buffer, sizeof(int) * numElems, cudaMemcpyHostToDevice);
+            cudaMemcpyAsync(res.deviceBuffer, h_buffer, sizeof(int) * numElems, cudaMemcpyHostToDevice);
         }
-        cudaEventRecord(stop[i]);
+        cudaEventRecord(res.stop);
         cudaCheckErrorRef(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
 
-        cudaEventElapsedTime(&time_ms, start[i], stop[i]);
+        cudaEventElapsedTime(&time_ms, res.start, res.stop);
         time_s = time_ms / 1e3;
 
         gb                                     = numElems * sizeof(int) * repeat / (double)1e9;
@@ -475,18 +626,18 @@ int performHostToDeviceWork(BusGrind &bg, bool pinned, const std::string &groupN
 
         // Bidirectional
         cudaCheckErrorRef(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-        cudaEventRecord(start[i]);
+        cudaEventRecord(res.start);
 
         for (int r = 0; r < repeat; r++)
         {
-            cudaMemcpyAsync(d_buffers[i], h_buffer, sizeof(int) * numElems, cudaMemcpyHostToDevice, stream1[i]);
-            cudaMemcpyAsync(h_buffer, d_buffers[i], sizeof(int) * numElems, cudaMemcpyDeviceToHost, stream2[i]);
+            cudaMemcpyAsync(res.deviceBuffer, h_buffer, sizeof(int) * numElems, cudaMemcpyHostToDevice, res.stream0);
+            cudaMemcpyAsync(h_buffer, res.deviceBuffer, sizeof(int) * numElems, cudaMemcpyDeviceToHost, res.stream1);
         }
 
-        cudaEventRecord(stop[i]);
+        cudaEventRecord(res.stop);
         cudaCheckErrorRef(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
 
-        cudaEventElapsedTime(&time_ms, start[i], stop[i]);
+        cudaEventElapsedTime(&time_ms, res.start, res.stop);
         time_s = time_ms / 1e3;
 
         gb                                     = 2 * numElems * sizeof(int) * repeat / (double)1e9;
@@ -533,25 +684,7 @@ int performHostToDeviceWork(BusGrind &bg, bool pinned, const std::string &groupN
         }
     }
 
-
-    if (pinned)
-    {
-        cudaFreeHost(h_buffer);
-    }
-    else
-    {
-        free(h_buffer);
-    }
-
-    for (size_t d = 0; d < bg.gpu.size(); d++)
-    {
-        cudaSetDevice(bg.gpu[d]->cudaDeviceIdx);
-        cudaCheckErrorRef(cudaFree, (d_buffers[d]), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckErrorRef(cudaEventDestroy, (start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorRef(cudaEventDestroy, (stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorRef(cudaStreamDestroy, (stream1[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckErrorRef(cudaStreamDestroy, (stream2[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-    }
+    free(unpinnedBuffer);
 
     return failedTests;
 }
@@ -893,7 +1026,10 @@ int ForkAndLaunchBandwidthTests(BusGrind &bg,
     DcgmNs::Utils::FileHandle outputFds[DCGM_MAX_NUM_DEVICES];
     unsigned int fdsIndex = 0;
 
-    // Reset cuda context before forking out child processes
+    // Reset cuda context before forking out child processes. That also destroys the shared resources
+    ReleaseGpuResources(&bg);
+    Dcgm::CublasProxy::CublasDestroySharedHandles();
+
     for (size_t i = 0; i < bg.gpu.size(); i++)
     {
         int cudaStatus = cudaSetDevice(bg.gpu[i]->cudaDeviceIdx);
@@ -1039,27 +1175,26 @@ int outputConcurrentHostDeviceBandwidthMatrix(BusGrind *bg, bool pinned)
     int numElems = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_INTS_PER_COPY);
     int repeat   = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_ITERATIONS);
 
+    if (AcquireGpuResources(bg, numElems * sizeof(int), pinned ? numElems * sizeof(int) : 0) != 0)
+    {
+        return -1;
+    }
+
     // one thread per GPU
     /* Lambda run for each gpuGlobals->gpu[d] */
     auto worker = [&myBarrier, bg, pinned, numElems, repeat, &bandwidthMatrix](int d) {
-        int *buffer { nullptr };
-        int *d_buffer { nullptr };
-        cudaEvent_t start;
-        cudaEvent_t stop;
-        cudaStream_t stream1 { 0 };
-        cudaStream_t stream2 { 0 };
+        PcieGpuResources &res = bg->m_gpuResources[d];
+        int *buffer { res.pinnedBuffer };
+        int *d_buffer { res.deviceBuffer };
+        cudaEvent_t start { res.start };
+        cudaEvent_t stop { res.stop };
+        cudaStream_t stream1 { res.stream0 };
+        cudaStream_t stream2 { res.stream1 };
 
         cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
 
-        if (pinned)
-            cudaMallocHost(&buffer, numElems * sizeof(int));
-        else
+        if (!pinned)
             buffer = (int *)malloc(numElems * sizeof(int));
-        cudaCheckErrorOmp(cudaMalloc, (&d_buffer, numElems * sizeof(int)), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckErrorOmp(cudaEventCreate, (&start), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorOmp(cudaEventCreate, (&stop), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorOmp(cudaStreamCreate, (&stream1), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckErrorOmp(cudaStreamCreate, (&stream2), PCIE_ERR_CUDA_STREAM_FAIL, d);
 
         cudaDeviceSynchronize();
         myBarrier.arrive_and_wait();
@@ -1118,19 +1253,10 @@ int outputConcurrentHostDeviceBandwidthMatrix(BusGrind *bg, bool pinned)
 
         bandwidthMatrix[2 * bg->gpu.size() + d] = gb / time_s;
 
-        if (pinned)
-        {
-            cudaFreeHost(buffer);
-        }
-        else
+        if (!pinned)
         {
             free(buffer);
         }
-        cudaCheckErrorOmp(cudaFree, (d_buffer), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckErrorOmp(cudaEventDestroy, (start), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorOmp(cudaEventDestroy, (stop), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckErrorOmp(cudaStreamDestroy, (stream1), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckErrorOmp(cudaStreamDestroy, (stream2), PCIE_ERR_CUDA_STREAM_FAIL, d);
     }; // end lambda
 
     /* Use a block so all jthreads are auto-joined */
@@ -1197,24 +1323,11 @@ int outputConcurrentHostDeviceBandwidthMatrix(BusGrind *bg, bool pinned)
 //        bool pinned:   Indicates if the host memory should be pinned or not
 int outputHostDeviceLatencyMatrix(BusGrind *bg, bool pinned)
 {
-    int *h_buffer = 0;
-    std::vector<int *> d_buffers(bg->gpu.size());
-    std::vector<cudaEvent_t> start(bg->gpu.size());
-    std::vector<cudaEvent_t> stop(bg->gpu.size());
-    std::vector<cudaStream_t> stream1(bg->gpu.size());
-    std::vector<cudaStream_t> stream2(bg->gpu.size());
+    int *unpinnedBuffer = 0;
     float time_ms;
     std::string key;
     std::string groupName;
 
-    /* Initialize buffers to make valgrind happy */
-    for (size_t i = 0; i < bg->gpu.size(); i++)
-    {
-        d_buffers[i] = 0;
-        stream1[i]   = 0;
-        stream2[i]   = 0;
-    }
-
     if (pinned)
     {
         groupName = PCIE_SUBTEST_H2D_D2H_LATENCY_PINNED;
@@ -1226,77 +1339,70 @@ int outputHostDeviceLatencyMatrix(BusGrind *bg, bool pinned)
 
     int repeat = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_ITERATIONS);
 
-    for (size_t d = 0; d < bg->gpu.size(); d++)
+    if (AcquireGpuResources(bg, 1, pinned ? sizeof(int) : 0) != 0)
     {
-        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
-        cudaCheckError(cudaMalloc, (&d_buffers[d], 1), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckError(cudaEventCreate, (&start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaEventCreate, (&stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaStreamCreate, (&stream1[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckError(cudaStreamCreate, (&stream2[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
+        return -1;
     }
 
-    if (pinned)
+    if (!pinned)
     {
-        cudaCheckErrorGeneral(cudaMallocHost, (&h_buffer, sizeof(int)), PCIE_ERR_CUDA_ALLOC_FAIL);
-    }
-    else
-    {
-        h_buffer = (int *)malloc(sizeof(int));
+        unpinnedBuffer = (int *)malloc(sizeof(int));
     }
     std::vector<double> latencyMatrix(3 * bg->gpu.size());
 
     for (size_t i = 0; i < bg->gpu.size(); i++)
     {
+        PcieGpuResources &res = bg->m_gpuResources[i];
+        int *h_buffer         = pinned ? res.pinnedBuffer : unpinnedBuffer;
         cudaSetDevice(bg->gpu[i]->cudaDeviceIdx);
 
         // D2H tests
-        // coverity[leaked_storage] this macro can exit the function without freeing h_buffer
+        // coverity[leaked_storage] this macro can exit the function without freeing unpinnedBuffer
         cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-        cudaEventRecord(start[i]);
+        cudaEventRecord(res.start);
 
         for (int r = 0; r < repeat; r++)
         {
-            cudaMemcpyAsync(h_buffer, d_buffers[i], 1, cudaMemcpyDeviceToHost);
+            cudaMemcpyAsync(h_buffer, res.deviceBuffer, 1, cudaMemcpyDeviceToHost);
         }
 
-        cudaEventRecord(stop[i]);
+        cudaEventRecord(res.stop);
         cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
 
-        cudaEventElapsedTime(&time_ms, start[i], stop[i]);
+        cudaEventElapsedTime(&time_ms, res.start, res.stop);
 
         latencyMatrix[0 * bg->gpu.size() + i] = time_ms * 1e3 / repeat;
 
         // H2D tests
         cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-        cudaEventRecord(start[i]);
+        cudaEventRecord(res.start);
 
         for (int r = 0; r < repeat; r++)
         {
-            cudaMemcpyAsync(d_buffers[i], h_buffer, 1, cudaMemcpyHostToDevice);
+            cudaMemcpyAsync(res.deviceBuffer, h_buffer, 1, cudaMemcpyHostToDevice);
         }
 
-        cudaEventRecord(stop[i]);
+        cudaEventRecord(res.stop);
         cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
 
-        cudaEventElapsedTime(&time_ms, start[i], stop[i]);
+        cudaEventElapsedTime(&time_ms, res.start, res.stop);
 
         latencyMatrix[1 * bg->gpu.size() + i] = time_ms * 1e3 / repeat;
 
         // Bidirectional tests
         cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-        cudaEventRecord(start[i]);
+        cudaEventRecord(res.start);
 
         for (int r = 0; r < repeat; r++)
         {
-            cudaMemcpyAsync(d_buffers[i], h_buffer, 1, cudaMemcpyHostToDevice, stream1[i]);
-            cudaMemcpyAsync(h_buffer, d_buffers[i], 1, cudaMemcpyDeviceToHost, stream2[i]);
+            cudaMemcpyAsync(res.deviceBuffer, h_buffer, 1, cudaMemcpyHostToDevice, res.stream0);
+            cudaMemcpyAsync(h_buffer, res.deviceBuffer, 1, cudaMemcpyDeviceToHost, res.stream1);
         }
 
-        cudaEventRecord(stop[i]);
+        cudaEventRecord(res.stop);
         cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
 
-        cudaEventElapsedTime(&time_ms, start[i], stop[i]);
+        cudaEventElapsedTime(&time_ms, res.start, res.stop);
 
         latencyMatrix[2 * bg->gpu.size() + i] = time_ms * 1e3 / repeat;
     }
@@ -1341,34 +1447,130 @@ int outputHostDeviceLatencyMatrix(BusGrind *bg, bool pinned)
         }
     }
 
+    free(unpinnedBuffer);
 
-    if (pinned)
+    if (Nfailures > 0)
     {
-        cudaFreeHost(h_buffer);
+        return 1;
     }
     else
     {
-        free(h_buffer);
+        return 0;
     }
+}
 
-    for (size_t d = 0; d < bg->gpu.size(); d++)
+/*****************************************************************************/
+std::vector<std::vector<std::pair<size_t, size_t>>> GetRoundRobinPairSchedule(size_t numGpus)
+{
+    std::vector<std::vector<std::pair<size_t, size_t>>> rounds;
+
+    /* Circle method: fix the first slot and rotate the rest. An odd count gets a bye slot */
+    size_t const numSlots = numGpus + (numGpus % 2);
+    size_t const bye      = numGpus;
+    std::vector<size_t> slots(numSlots);
+    for (size_t i = 0; i < numSlots; i++)
     {
-        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
-        cudaCheckError(cudaFree, (d_buffers[d]), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckError(cudaEventDestroy, (start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaEventDestroy, (stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaStreamDestroy, (stream1[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckError(cudaStreamDestroy, (stream2[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
+        slots[i] = i;
     }
 
-    if (Nfailures > 0)
+    for (size_t round = 0; round + 1 < numSlots; round++)
     {
-        return 1;
+        std::vector<std::pair<size_t, size_t>> pairs;
+        for (size_t k = 0; k < numSlots / 2; k++)
+        {
+            size_t const a = slots[k];
+            size_t const b = slots[numSlots - 1 - k];
+            if (a != bye && b != bye)
+            {
+                pairs.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+        rounds.push_back(std::move(pairs));
+
+        std::rotate(slots.begin() + 1, slots.end() - 1, slots.end());
     }
-    else
+
+    return rounds;
+}
+
+/*****************************************************************************/
+std::vector<std::vector<std::pair<size_t, size_t>>> GetP2PMatrixSteps(size_t numGpus, bool concurrent)
+{
+    std::vector<std::vector<std::pair<size_t, size_t>>> steps;
+
+    if (!concurrent)
     {
-        return 0;
+        for (size_t i = 0; i < numGpus; i++)
+        {
+            for (size_t j = 0; j < numGpus; j++)
+            {
+                steps.push_back({ { i, j } });
+            }
+        }
+        return steps;
     }
+
+    std::vector<std::pair<size_t, size_t>> self;
+    for (size_t i = 0; i < numGpus; i++)
+    {
+        self.emplace_back(i, i);
+    }
+    if (!self.empty())
+    {
+        steps.push_back(std::move(self));
+    }
+
+    /* Each direction of a pair gets its own step so that no GPU is in two transfers at once */
+    for (auto const &round : GetRoundRobinPairSchedule(numGpus))
+    {
+        std::vector<std::pair<size_t, size_t>> reversed;
+        for (auto const &[a, b] : round)
+        {
+            reversed.emplace_back(b, a);
+        }
+        steps.push_back(round);
+        steps.push_back(std::move(reversed));
+    }
+
+    return steps;
+}
+
+/*****************************************************************************/
+/*
+ * Times the transfers of each step of a P2P matrix. issue(i, j) queues GPU i's transfers with GPU j on device i,
+ * which is current when it is called. The transfers of a step are queued together and then waited on, so they
+ * overlap when a step has more than one. Each (i, j) is timed with GPU i's own events from bg->m_gpuResources.
+ *
+ * Returns: 0 on success
+ *         -1 on a CUDA error
+ */
+template <typename IssueFn>
+static int TimeP2PMatrixSteps(BusGrind *bg,
+                              std::vector<std::vector<std::pair<size_t, size_t>>> const &steps,
+                              IssueFn issue,
+                              std::vector<float> &timeMsMatrix)
+{
+    for (auto const &step : steps)
+    {
+        for (auto const &[i, j] : step)
+        {
+            cudaSetDevice(bg->gpu[i]->cudaDeviceIdx);
+            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
+            cudaEventRecord(bg->m_gpuResources[i].start);
+            issue(i, j);
+            cudaEventRecord(bg->m_gpuResources[i].stop);
+        }
+
+        for (auto const &[i, j] : step)
+        {
+            cudaSetDevice(bg->gpu[i]->cudaDeviceIdx);
+            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
+            cudaEventElapsedTime(
+                &timeMsMatrix[i * bg->gpu.size() + j], bg->m_gpuResources[i].start, bg->m_gpuResources[i].stop);
+        }
+    }
+
+    return 0;
 }
 
 /*****************************************************************************/
@@ -1378,22 +1580,9 @@ int outputHostDeviceLatencyMatrix(BusGrind *bg, bool pinned)
 //        bool p2p:   Indicates if GPUDirect P2P should be enabled or not
 int outputP2PBandwidthMatrix(BusGrind *bg, bool p2p)
 {
-    std::vector<int *> buffers(bg->gpu.size());
-    std::vector<cudaEvent_t> start(bg->gpu.size());
-    std::vector<cudaEvent_t> stop(bg->gpu.size());
-    std::vector<cudaStream_t> stream0(bg->gpu.size());
-    std::vector<cudaStream_t> stream1(bg->gpu.size());
     std::string key;
     std::string groupName;
 
-    /* Initialize buffers to make valgrind happy */
-    for (size_t i = 0; i < bg->gpu.size(); i++)
-    {
-        buffers[i] = 0;
-        stream0[i] = 0;
-        stream1[i] = 0;
-    }
-
     if (p2p)
     {
         groupName = PCIE_SUBTEST_P2P_BW_P2P_ENABLED;
@@ -1406,54 +1595,42 @@ int outputP2PBandwidthMatrix(BusGrind *bg, bool p2p)
     int numElems = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_INTS_PER_COPY);
     int repeat   = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_ITERATIONS);
 
-    for (size_t d = 0; d < bg->gpu.size(); d++)
+    if (AcquireGpuResources(bg, numElems * sizeof(int), 0) != 0)
     {
-        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
-        cudaCheckError(cudaMalloc, (&buffers[d], numElems * sizeof(int)), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckError(cudaEventCreate, (&start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaEventCreate, (&stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaStreamCreate, (&stream0[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckError(cudaStreamCreate, (&stream1[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
+        return -1;
     }
+    std::vector<PcieGpuResources> const &res = bg->m_gpuResources;
 
     std::vector<double> bandwidthMatrix(bg->gpu.size() * bg->gpu.size());
+    std::vector<float> timeMsMatrix(bg->gpu.size() * bg->gpu.size());
 
-    if (p2p)
-    {
-        enableP2P(bg);
-    }
+    /* Either one pair at a time, or disjoint pairs at once when trading isolation for runtime */
+    auto const steps
+        = GetP2PMatrixSteps(bg->gpu.size(), bg->m_testParameters->GetBoolFromString(PCIE_STR_CONCURRENT_PAIRS));
 
-    // for each device
-    for (size_t i = 0; i < bg->gpu.size(); i++)
-    {
-        cudaSetDevice(bg->gpu[i]->cudaDeviceIdx);
+    setP2P(bg, p2p);
 
-        // for each device
-        for (size_t j = 0; j < bg->gpu.size(); j++)
+    // measure bandwidth between each device i and device j
+    auto issueOneDir = [&](size_t i, size_t j) {
+        for (int r = 0; r < repeat; r++)
         {
-            // measure bandwidth between device i and device j
-            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-            cudaEventRecord(start[i]);
-
-            for (int r = 0; r < repeat; r++)
-            {
-                cudaMemcpyPeerAsync(buffers[i],
-                                    bg->gpu[i]->cudaDeviceIdx,
-                                    buffers[j],
-                                    bg->gpu[j]->cudaDeviceIdx,
-                                    sizeof(int) * numElems);
-            }
-
-            cudaEventRecord(stop[i]);
-            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-
-            float time_ms;
-            cudaEventElapsedTime(&time_ms, start[i], stop[i]);
-            double time_s = time_ms / 1e3;
-
-            double gb                               = numElems * sizeof(int) * repeat / (double)1e9;
-            bandwidthMatrix[i * bg->gpu.size() + j] = gb / time_s;
+            cudaMemcpyPeerAsync(res[i].deviceBuffer,
+                                bg->gpu[i]->cudaDeviceIdx,
+                                res[j].deviceBuffer,
+                                bg->gpu[j]->cudaDeviceIdx,
+                                sizeof(int) * numElems);
         }
+    };
+    if (TimeP2PMatrixSteps(bg, steps, issueOneDir, timeMsMatrix) != 0)
+    {
+        return -1;
+    }
+
+    for (size_t cell = 0; cell < bandwidthMatrix.size(); cell++)
+    {
+        double time_s         = timeMsMatrix[cell] / 1e3;
+        double gb             = numElems * sizeof(int) * repeat / (double)1e9;
+        bandwidthMatrix[cell] = gb / time_s;
     }
 
     std::stringstream ss;
@@ -1473,41 +1650,33 @@ int outputP2PBandwidthMatrix(BusGrind *bg, bool p2p)
         }
     }
 
-    for (size_t i = 0; i < bg->gpu.size(); i++)
-    {
-        cudaSetDevice(bg->gpu[i]->cudaDeviceIdx);
-
-        for (size_t j = 0; j < bg->gpu.size(); j++)
+    auto issueBiDir = [&](size_t i, size_t j) {
+        for (int r = 0; r < repeat; r++)
         {
-            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-            cudaEventRecord(start[i]);
-
-            for (int r = 0; r < repeat; r++)
-            {
-                cudaMemcpyPeerAsync(buffers[i],
-                                    bg->gpu[i]->cudaDeviceIdx,
-                                    buffers[j],
-                                    bg->gpu[j]->cudaDeviceIdx,
-                                    sizeof(int) * numElems,
-                                    stream0[i]);
-                cudaMemcpyPeerAsync(buffers[j],
-                                    bg->gpu[j]->cudaDeviceIdx,
-                                    buffers[i],
-                                    bg->gpu[i]->cudaDeviceIdx,
-                                    sizeof(int) * numElems,
-                                    stream1[i]);
-            }
-
-            cudaEventRecord(stop[i]);
-            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-
-            float time_ms;
-            cudaEventElapsedTime(&time_ms, start[i], stop[i]);
-            double time_s = time_ms / 1e3;
-
-            double gb                               = 2.0 * numElems * sizeof(int) * repeat / (double)1e9;
-            bandwidthMatrix[i * bg->gpu.size() + j] = gb / time_s;
+            cudaMemcpyPeerAsync(res[i].deviceBuffer,
+                                bg->gpu[i]->cudaDeviceIdx,
+                                res[j].deviceBuffer,
+                                bg->gpu[j]->cudaDeviceIdx,
+                                sizeof(int) * numElems,
+                                res[i].stream0);
+            cudaMemcpyPeerAsync(res[j].deviceBuffer,
+                                bg->gpu[j]->cudaDeviceIdx,
+                                res[i].deviceBuffer,
+                                bg->gpu[i]->cudaDeviceIdx,
+                                sizeof(int) * numElems,
+                                res[i].stream1);
         }
+    };
+    if (TimeP2PMatrixSteps(bg, steps, issueBiDir, timeMsMatrix) != 0)
+    {
+        return -1;
+    }
+
+    for (size_t cell = 0; cell < bandwidthMatrix.size(); cell++)
+    {
+        double time_s         = timeMsMatrix[cell] / 1e3;
+        double gb             = 2.0 * numElems * sizeof(int) * repeat / (double)1e9;
+        bandwidthMatrix[cell] = gb / time_s;
     }
 
     for (size_t i = 0; i < bg->gpu.size(); i++)
@@ -1525,21 +1694,6 @@ int outputP2PBandwidthMatrix(BusGrind *bg, bool p2p)
         }
     }
 
-    if (p2p)
-    {
-        disableP2P(bg);
-    }
-
-    for (size_t d = 0; d < bg->gpu.size(); d++)
-    {
-        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
-        cudaCheckError(cudaFree, (buffers[d]), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckError(cudaEventDestroy, (start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaEventDestroy, (stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaStreamDestroy, (stream0[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-        cudaCheckError(cudaStreamDestroy, (stream1[d]), PCIE_ERR_CUDA_STREAM_FAIL, d);
-    }
-
     return 0;
 }
 
@@ -1553,10 +1707,7 @@ int outputConcurrentPairsP2PBandwidthMatrix(BusGrind *bg, bool p2p)
 {
     // only run this test if p2p tests are enabled
     int numGPUs = bg->gpu.size() / 2 * 2; // round to the neared even number of GPUs
-    if (p2p)
-    {
-        enableP2P(bg);
-    }
+    setP2P(bg, p2p);
     std::vector<int *> buffers(numGPUs);
     std::vector<cudaEvent_t> start(numGPUs);
     std::vector<cudaEvent_t> stop(numGPUs);
@@ -1747,10 +1898,6 @@ int outputConcurrentPairsP2PBandwidthMatrix(BusGrind *bg, bool p2p)
         key = ss.str();
         bg->SetGroupedStat(bg->GetPcieTestName(), groupName, key, sum);
     }
-    if (p2p)
-    {
-        disableP2P(bg);
-    }
 
     for (int d = 0; d < numGPUs; d++)
     {
@@ -1809,10 +1956,7 @@ int outputConcurrent1DExchangeBandwidthMatrix(BusGrind *bg, bool p2p)
     int numElems = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_INTS_PER_COPY);
     int repeat   = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_ITERATIONS);
 
-    if (p2p)
-    {
-        enableP2P(bg);
-    }
+    setP2P(bg, p2p);
 
     std::barrier myBarrier(numGPUs);
 
@@ -1930,11 +2074,6 @@ int outputConcurrent1DExchangeBandwidthMatrix(BusGrind *bg, bool p2p)
         cudaCheckError(cudaFree, (buffers[d]), PCIE_ERR_CUDA_ALLOC_FAIL, d);
     }
 
-    if (p2p)
-    {
-        disableP2P(bg);
-    }
-
     return 0;
 }
 
@@ -1945,18 +2084,9 @@ int outputConcurrent1DExchangeBandwidthMatrix(BusGrind *bg, bool p2p)
 //        bool p2p:   Indicates if GPUDirect P2P should be enabled or not
 int outputP2PLatencyMatrix(BusGrind *bg, bool p2p)
 {
-    std::vector<int *> buffers(bg->gpu.size());
-    std::vector<cudaEvent_t> start(bg->gpu.size());
-    std::vector<cudaEvent_t> stop(bg->gpu.size());
     std::string key;
     std::string groupName;
 
-    /* Initialize buffers to make valgrind happy */
-    for (size_t i = 0; i < bg->gpu.size(); i++)
-    {
-        buffers[i] = 0;
-    }
-
     if (p2p)
     {
         groupName = PCIE_SUBTEST_P2P_LATENCY_P2P_ENABLED;
@@ -1968,43 +2098,35 @@ int outputP2PLatencyMatrix(BusGrind *bg, bool p2p)
 
     int repeat = (int)bg->m_testParameters->GetSubTestDouble(groupName, PCIE_STR_ITERATIONS);
 
-    if (p2p)
-    {
-        enableP2P(bg);
-    }
+    setP2P(bg, p2p);
 
-    for (size_t d = 0; d < bg->gpu.size(); d++)
+    if (AcquireGpuResources(bg, 1, 0) != 0)
     {
-        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
-        cudaCheckError(cudaMalloc, (&buffers[d], 1), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckError(cudaEventCreate, (&start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaEventCreate, (&stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
+        return -1;
     }
+    std::vector<PcieGpuResources> const &res = bg->m_gpuResources;
 
     std::vector<double> latencyMatrix(bg->gpu.size() * bg->gpu.size());
+    std::vector<float> timeMsMatrix(bg->gpu.size() * bg->gpu.size());
 
-    for (size_t i = 0; i < bg->gpu.size(); i++)
-    {
-        cudaSetDevice(bg->gpu[i]->cudaDeviceIdx);
+    auto const steps
+        = GetP2PMatrixSteps(bg->gpu.size(), bg->m_testParameters->GetBoolFromString(PCIE_STR_CONCURRENT_PAIRS));
 
-        for (size_t j = 0; j < bg->gpu.size(); j++)
+    auto issueLatency = [&](size_t i, size_t j) {
+        for (int r = 0; r < repeat; r++)
         {
-            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-            cudaEventRecord(start[i]);
-
-            for (int r = 0; r < repeat; r++)
-            {
-                cudaMemcpyPeerAsync(buffers[i], bg->gpu[i]->cudaDeviceIdx, buffers[j], bg->gpu[j]->cudaDeviceIdx, 1);
-            }
-
-            cudaEventRecord(stop[i]);
-            cudaCheckError(cudaDeviceSynchronize, (), PCIE_ERR_CUDA_SYNC_FAIL, i);
-
-            float time_ms;
-            cudaEventElapsedTime(&time_ms, start[i], stop[i]);
-
-            latencyMatrix[i * bg->gpu.size() + j] = time_ms * 1e3 / repeat;
+            cudaMemcpyPeerAsync(
+                res[i].deviceBuffer, bg->gpu[i]->cudaDeviceIdx, res[j].deviceBuffer, bg->gpu[j]->cudaDeviceIdx, 1);
         }
+    };
+    if (TimeP2PMatrixSteps(bg, steps, issueLatency, timeMsMatrix) != 0)
+    {
+        return -1;
+    }
+
+    for (size_t cell = 0; cell < latencyMatrix.size(); cell++)
+    {
+        latencyMatrix[cell] = timeMsMatrix[cell] * 1e3 / repeat;
     }
 
     std::stringstream ss;
@@ -2021,18 +2143,6 @@ int outputP2PLatencyMatrix(BusGrind *bg, bool p2p)
             bg->SetGroupedStat(bg->GetPcieTestName(), groupName, key, latencyMatrix[i * bg->gpu.size() + j]);
         }
     }
-    if (p2p)
-    {
-        disableP2P(bg);
-    }
-
-    for (size_t d = 0; d < bg->gpu.size(); d++)
-    {
-        cudaSetDevice(bg->gpu[d]->cudaDeviceIdx);
-        cudaCheckError(cudaFree, (buffers[d]), PCIE_ERR_CUDA_ALLOC_FAIL, d);
-        cudaCheckError(cudaEventDestroy, (start[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-        cudaCheckError(cudaEventDestroy, (stop[d]), PCIE_ERR_CUDA_EVENT_FAIL, d);
-    }
 
     return 0;
 }
@@ -2632,6 +2742,8 @@ int main_entry_wrapped(BusGrind *bg, const dcgmDiagPluginEntityList_v1 &entityIn
 /* This should come after all of the tests have run */
 NO_MORE_TESTS:
 
+    ReleaseGpuResources(bg);
+
     endTime = timelib_usecSince1970();
 
     if (bg->check_errors)
@@ -2666,6 +2778,7 @@ int main_entry(BusGrind *bg, const dcgmDiagPluginEntityList_v1 &entityInfo)
         log_error("Caught runtime_error {}", err_str);
         bg->AddError(bg->GetPcieTestName(), d);
         bg->SetResult(bg->GetPcieTestName(), NVVS_RESULT_FAIL);
+        ReleaseGpuResources(bg);
         // Let the TestFramework report the exception information.
         throw;
     }
@@ -53,6 +53,24 @@ unsigned int ProcessChildrenOutputs(std::vector<dcgmChildInfo_t> &childrenInfo,
                                     BusGrind &bg,
                                     const std::string &groupName);
 
+/*****************************************************************************/
+/*
+ * Round robin tournament schedule of numGpus GPU indices. Each round is a set of
+ * disjoint (lower, higher) index pairs, so no GPU is in two of them, and every
+ * pair of distinct GPUs is in exactly one round. With an odd numGpus, one GPU
+ * sits out each round
+ */
+std::vector<std::vector<std::pair<size_t, size_t>>> GetRoundRobinPairSchedule(size_t numGpus);
+
+/*****************************************************************************/
+/*
+ * Order in which a P2P matrix measures its (i, j) cells. The cells of a step are
+ * measured at once. Without concurrent, every step is one cell in row order.
+ * With it, the first step is every GPU to itself, then each round of
+ * GetRoundRobinPairSchedule() is two steps, one per direction
+ */
+std::vector<std::vector<std::pair<size_t, size_t>>> GetP2PMatrixSteps(size_t numGpus, bool concurrent);
+
 std::unique_ptr<DcgmGroup> StartDcgmGroupWatch(BusGrind *bg,
                                                std::vector<unsigned short> const &fieldIds,
                                                std::vector<unsigned int> const &gpuIds);
@@ -77,6 +77,7 @@ dcgmReturn_t GetPluginInfo(unsigned int /* pluginInterfaceVersion */, dcgmDiagPl
                                      PCIE_STR_NVSWITCH_NVLINKS_EXPECTED_UP,
                                      PCIE_STR_PARALLEL_BW_CHECK_DURATION,
                                      PCIE_STR_DONT_BIND_NUMA,
+                                     PCIE_STR_CONCURRENT_PAIRS,
                                      PCIE_STR_MAX_NVLINK_RECOVERY_ERRORS,
                                      nullptr };
     char const *description      = "This plugin will exercise the PCIe bus for a given list of GPUs.";
@@ -18,6 +18,7 @@
 
 #include <Pcie.h>
 #include <PcieMain.h>
+#include <set>
 #include <sstream>
 
 unsigned int failingGpuId    = DCGM_MAX_NUM_DEVICES;
@@ -332,3 +333,63 @@ TEST_CASE("Pcie: StartDcgmGroupWatch")
         REQUIRE(dcgmGroupPtr.get() == nullptr);
     }
 }
+
+TEST_CASE("Pcie: GetRoundRobinPairSchedule")
+{
+    for (size_t numGpus = 0; numGpus <= 16; numGpus++)
+    {
+        auto const rounds = GetRoundRobinPairSchedule(numGpus);
+        std::set<std::pair<size_t, size_t>> seen;
+
+        for (auto const &round : rounds)
+        {
+            std::set<size_t> busy;
+            for (auto const &[a, b] : round)
+            {
+                REQUIRE(a < b);
+                REQUIRE(b < numGpus);
+                /* No GPU is in two pairs of one round */
+                CHECK(busy.insert(a).second);
+                CHECK(busy.insert(b).second);
+                /* Every pair is in one round only */
+                CHECK(seen.insert({ a, b }).second);
+            }
+        }
+
+        CHECK(seen.size() == numGpus * (numGpus - (numGpus > 0 ? 1 : 0)) / 2);
+    }
+}
+
+TEST_CASE("Pcie: GetP2PMatrixSteps")
+{
+    size_t const numGpus = 5;
+
+    for (bool concurrent : { false, true })
+    {
+        auto const steps = GetP2PMatrixSteps(numGpus, concurrent);
+        std::set<std::pair<size_t, size_t>> cells;
+
+        for (auto const &step : steps)
+        {
+            if (!concurrent)
+            {
+                CHECK(step.size() == 1);
+            }
+            std::set<size_t> busy;
+            for (auto const &[i, j] : step)
+            {
+                CHECK(busy.insert(i).second);
+                if (i != j)
+                {
+                    CHECK(busy.insert(j).second);
+                }
+                CHECK(cells.insert({ i, j }).second);
+            }
+        }
+
+        /* Every cell of the matrix is measured exactly once */
+        CHECK(cells.size() == numGpus * numGpus);
+    }
+
+    CHECK(GetP2PMatrixSteps(4, true).size() == 1 + 2 * 3);
+}
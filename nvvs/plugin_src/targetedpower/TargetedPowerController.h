@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+/*****************************************************************************/
+/*
+ * PID controller that picks the matrix dimension needed to hold a GPU at a target power.
+ *
+ * The controller works on the log of the matrix dimension, so a given power error changes the amount of
+ * work by the same ratio whether the matrices are small or large. It is written in velocity form: each
+ * update adds a step to the output rather than recomputing it from an accumulated integral, which keeps
+ * the integral from winding up while the output sits at one of its limits.
+ */
+class TargetedPowerController
+{
+public:
+    static constexpr double c_kp         = 0.5;  /* Gain on the change of the normalized error */
+    static constexpr double c_ki         = 2.0;  /* Gain on the normalized error, per second */
+    static constexpr double c_kd         = 0.02; /* Gain on the change of the power slope, in seconds */
+    static constexpr double c_maxStep    = 0.25; /* Largest change of log(matrixDim) in one update */
+    static constexpr double c_powerAlpha = 0.5;  /* Weight of a new power sample in the smoothed power */
+
+    TargetedPowerController(double targetPower, int minMatrixDim, int maxMatrixDim, int startingMatrixDim)
+        : m_targetPower(targetPower)
+        , m_minLogDim(std::log((double)std::max(minMatrixDim, 1)))
+        , m_maxLogDim(std::log((double)std::max(maxMatrixDim, 1)))
+        , m_logDim(std::clamp(std::log((double)std::max(startingMatrixDim, 1)), m_minLogDim, m_maxLogDim))
+    {}
+
+    /*************************************************************************/
+    /*
+     * Feed a power sample in watts taken at now (seconds). Samples < 0.0 mean the power couldn't be read and
+     * leave the output as it is.
+     *
+     * Returns the matrix dimension to use until the next update
+     */
+    int Update(double power, double now)
+    {
+        if (power < 0.0 || m_targetPower <= 0.0)
+        {
+            return GetMatrixDim();
+        }
+
+        m_power = m_havePower ? (c_powerAlpha * power + (1.0 - c_powerAlpha) * m_power) : power;
+
+        double const error = (m_targetPower - m_power) / m_targetPower;
+
+        if (!m_havePower)
+        {
+            m_havePower = true;
+            m_lastPower = m_power;
+            m_lastError = error;
+            m_lastTime  = now;
+            return GetMatrixDim();
+        }
+
+        double const dt = now - m_lastTime;
+        if (dt <= 0.0)
+        {
+            return GetMatrixDim();
+        }
+
+        /* Derivative on the measurement so a target change doesn't kick the output */
+        double const slope = (m_lastPower - m_power) / m_targetPower / dt;
+        double step        = c_kp * (error - m_lastError) + c_ki * error * dt + c_kd * (slope - m_lastSlope);
+        step               = std::clamp(step, -c_maxStep, c_maxStep);
+
+        m_logDim    = std::clamp(m_logDim + step, m_minLogDim, m_maxLogDim);
+        m_lastError = error;
+        m_lastSlope = slope;
+        m_lastTime  = now;
+        m_lastPower = m_power;
+
+        return GetMatrixDim();
+    }
+
+    /*************************************************************************/
+    int GetMatrixDim() const
+    {
+        return (int)std::lround(std::exp(m_logDim));
+    }
+
+    /*************************************************************************/
+    /* Smoothed power in watts, or 0.0 before the first sample */
+    double GetPower() const
+    {
+        return m_power;
+    }
+
+private:
+    double m_targetPower;
+    double m_minLogDim;
+    double m_maxLogDim;
+    double m_logDim;
+
+    bool m_havePower   = false;
+    double m_power     = 0.0;
+    double m_lastPower = 0.0;
+    double m_lastError = 0.0;
+    double m_lastSlope = 0.0;
+    double m_lastTime  = 0.0;
+};
@@ -18,6 +18,7 @@
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
 
+#include "TargetedPowerController.h"
 #include "TargetedPower_wrapper.h"
 #include <fmt/format.h>
 #include <stdexcept>
@@ -287,8 +288,7 @@ int ConstantPower::CudaInit()
     /* Do per-device initialization */
     for (size_t deviceIdx = 0; deviceIdx < m_device.size(); deviceIdx++)
     {
-        device               = m_device[deviceIdx];
-        device->minMatrixDim = 1;
+        device = m_device[deviceIdx];
 
         /* Make all subsequent cuda calls link to this device */
         cudaSetDevice(device->cudaDeviceIdx);
@@ -318,7 +318,7 @@ int ConstantPower::CudaInit()
         }
 
         /* Initialize cublas */
-        cubSt = CublasProxy::CublasCreate(&device->cublasHandle);
+        cubSt = CublasProxy::CublasAcquireSharedHandle(device->cudaDeviceIdx, &device->cublasHandle);
         if (cubSt != CUBLAS_STATUS_SUCCESS)
         {
             LOG_CUBLAS_ERROR(GetTargetedPowerTestName(), "cublasCreate", cubSt, device->gpuId);
@@ -548,12 +548,12 @@ bool ConstantPower::CheckPassFail(timelib64_t startTime, timelib64_t earliestSto
     std::vector<DcgmError> errorList;
     char buf[256] = { 0 };
 
-    if (m_testDuration < 30.0)
+    if (m_testDuration < 10.0)
     {
         snprintf(buf,
                  sizeof(buf),
                  "Test duration of %.1f will not produce useful results as "
-                 "this test takes at least 30 seconds to get to target power.",
+                 "this test takes at least 10 seconds to get to target power.",
                  m_testDuration);
         AddInfo(GetTargetedPowerTestName(), buf);
     }
@@ -619,7 +619,7 @@ private:
     double m_targetPower;      /* Target stress in gflops */
     double m_testDuration;     /* Target test duration in seconds */
     timelib64_t m_stopTime;    /* Timestamp when run() finished */
-    double m_reAdjustInterval; /* How often to change the matrix size in seconds */
+    double m_reAdjustInterval; /* Longest time between changes of the matrix size in seconds */
     double m_printInterval;    /* How often to print out status to stdout */
     int m_opsPerRequeue;       /* How many cublas operations to queue to each stream each time we queue work
                                            to it */
@@ -682,15 +682,34 @@ private:
 
     /*****************************************************************************/
     /*
-     * Calculate the percent difference between a and b
+     * Queue m_opsPerRequeue cublas operations of size matrixDim to stream streamIdx.
+     *
+     * Returns CUBLAS_STATUS_SUCCESS on success. Otherwise failedCall is set to the cublas call that failed
      */
-    static double PercentDiff(double a, double b);
+    cublasStatus_t QueueOps(int streamIdx,
+                            int useNstreams,
+                            int matrixDim,
+                            double *alpha,
+                            double *beta,
+                            float *floatAlpha,
+                            float *floatBeta,
+                            char const *&failedCall);
 
     /*****************************************************************************/
     /*
-     * Return the new matrix dimension to use for ramping up to the target power.
+     * Launch the operations for stream streamIdx as a CUDA graph, capturing them first if there's no graph
+     * for matrixDim yet. Launching a graph costs one call instead of one per operation.
+     *
+     * Returns true if the graph was launched
+     *         false if the operations couldn't be captured or launched. The caller should queue them directly
      */
-    int RecalcMatrixDim(int currentMatrixDim, double power);
+    bool LaunchGraph(int streamIdx,
+                     int useNstreams,
+                     int matrixDim,
+                     double *alpha,
+                     double *beta,
+                     float *floatAlpha,
+                     float *floatBeta);
 };
 
 /****************************************************************************/
@@ -875,6 +894,15 @@ double ConstantPowerWorker::ReadPower()
     dcgmReturn_t st;
     dcgmFieldValue_v2 powerUsage;
 
+    /* Read the instantaneous power straight from the driver so the controller sees the effect of its last
+       change instead of a cached, averaged sample. Not every GPU has it, so fall back to the average */
+    st = m_dcgmRecorder.GetCurrentFieldValue(
+        m_device->gpuId, DCGM_FI_DEV_POWER_USAGE_INSTANT, powerUsage, DCGM_FV_FLAG_LIVE_DATA);
+    if (st == DCGM_ST_OK && !DCGM_FP64_IS_BLANK(powerUsage.value.dbl))
+    {
+        return powerUsage.value.dbl;
+    }
+
     st = m_dcgmRecorder.GetCurrentFieldValue(m_device->gpuId, DCGM_FI_DEV_POWER_USAGE, powerUsage, 0);
     if (st)
     {
@@ -889,102 +917,172 @@ double ConstantPowerWorker::ReadPower()
 }
 
 /****************************************************************************/
-double ConstantPowerWorker::PercentDiff(double a, double b)
-{
-    double retVal = a - b;
-    retVal /= (a + b);
-    retVal *= 200.0;
-    return retVal;
-}
-
-/****************************************************************************/
-int ConstantPowerWorker::RecalcMatrixDim(int currentMatrixDim, double power)
+cublasStatus_t ConstantPowerWorker::QueueOps(int streamIdx,
+                                             int useNstreams,
+                                             int matrixDim,
+                                             double *alpha,
+                                             double *beta,
+                                             float *floatAlpha,
+                                             float *floatBeta,
+                                             char const *&failedCall)
 {
-    int matrixDim;
-    double pctDiff, workPctDiff;
+    using namespace Dcgm;
+    cublasStatus_t cubSt;
 
-    /* if we're targeting close to max power, just go for it  */
-    if (m_targetPower >= (0.90 * m_device->maxPowerTarget))
+    cubSt = CublasProxy::CublasSetStream(m_device->cublasHandle, m_device->cudaStream[streamIdx]);
+    if (cubSt != CUBLAS_STATUS_SUCCESS)
     {
-        // return TP_MAX_DIMENSION;
-        return m_maxMatrixDim;
+        failedCall = "cublasSetStream";
+        return cubSt;
     }
 
-    pctDiff = PercentDiff(power, m_targetPower);
-
-    matrixDim = currentMatrixDim;
-
-    /* If we are below our target power, set a floor so that we never go below this matrix size */
-    if (pctDiff < 0.0)
+    for (int j = 0; j < m_opsPerRequeue; j++)
     {
-        m_device->minMatrixDim = std::max(currentMatrixDim, m_device->minMatrixDim);
-        log_debug("device {}, minMatrixDim: {}", m_device->gpuId, currentMatrixDim);
-    }
+        int Cindex = ((streamIdx * useNstreams) + j) % m_device->NdeviceC;
 
-    /* Ramp up */
-    if (!m_device->onlySmallAdjustments && pctDiff <= -50.0)
-    {
-        matrixDim += 20; /* Ramp up */
-    }
-    else if (!m_device->onlySmallAdjustments && (pctDiff <= -5.0 || pctDiff >= 5.0))
-    {
-        /* Try to guess jump in load based on pct change desired and pct change in matrix ops */
-        if (pctDiff < 0.0)
+        /* Make sure all streams have work. These are async calls, so they will
+           return immediately */
+        if (m_useDgemv)
         {
-            // for (workPctDiff = 0.0; workPctDiff < (-pctDiff) && matrixDim < TP_MAX_DIMENSION; matrixDim++)
-            for (workPctDiff = 0.0; workPctDiff < (-pctDiff) && matrixDim < m_maxMatrixDim; matrixDim++)
-            {
-                workPctDiff = PercentDiff(matrixDim * matrixDim, currentMatrixDim * currentMatrixDim);
-                // printf("loop pctdiff %.2f. workPctDiff %.2f\n", pctDiff, workPctDiff);
-            }
+            // Only the first column vector of matrix deviceB is used
+            failedCall = "cublasDgemv";
+            cubSt      = CublasProxy::CublasDgemv(m_device->cublasHandle,
+                                                  CUBLAS_OP_N,
+                                                  matrixDim,
+                                                  matrixDim,
+                                                  alpha,
+                                                  (double *)m_device->deviceA,
+                                                  matrixDim,
+                                                  (double *)(m_device->deviceB),
+                                                  1,
+                                                  beta,
+                                                  (double *)(m_device->deviceC[Cindex]),
+                                                  1);
+        }
+        else if (m_useDgemm)
+        {
+            failedCall = "cublasDgemm";
+            cubSt      = CublasProxy::CublasDgemm(m_device->cublasHandle,
+                                                  CUBLAS_OP_T,
+                                                  CUBLAS_OP_T,
+                                                  matrixDim,
+                                                  matrixDim,
+                                                  matrixDim,
+                                                  alpha,
+                                                  (double *)m_device->deviceA,
+                                                  matrixDim,
+                                                  (double *)m_device->deviceB,
+                                                  matrixDim,
+                                                  beta,
+                                                  (double *)m_device->deviceC[Cindex],
+                                                  matrixDim);
         }
         else
         {
-            for (workPctDiff = 0.0; workPctDiff > (-pctDiff) && matrixDim > m_device->minMatrixDim; matrixDim--)
-            {
-                workPctDiff = PercentDiff(matrixDim * matrixDim, currentMatrixDim * currentMatrixDim);
-                // printf("loop2 pctdiff %.2f. workPctDiff %.2f\n", pctDiff, workPctDiff);
-            }
+            failedCall = "cublasSgemm";
+            cubSt      = CublasProxy::CublasSgemm(m_device->cublasHandle,
+                                                  CUBLAS_OP_T,
+                                                  CUBLAS_OP_T,
+                                                  matrixDim,
+                                                  matrixDim,
+                                                  matrixDim,
+                                                  floatAlpha,
+                                                  (float *)m_device->deviceA,
+                                                  matrixDim,
+                                                  (float *)m_device->deviceB,
+                                                  matrixDim,
+                                                  floatBeta,
+                                                  (float *)m_device->deviceC[Cindex],
+                                                  matrixDim);
+        }
+
+        if (cubSt != CUBLAS_STATUS_SUCCESS)
+        {
+            return cubSt;
         }
-    }
-    else if (pctDiff < 0.0)
-    {
-        matrixDim++; /* Very small adjustment */
-        // m_device->onlySmallAdjustments = 1; /* Continue to make large adjustments if need be */
-    }
-    else
-    {
-        matrixDim--; /* Very small adjustment */
-        // m_device->onlySmallAdjustments = 1; /* Continue to make large adjustments if need be */
     }
 
-    // printf("pctdiff %.2f\n", pctDiff);
+    return CUBLAS_STATUS_SUCCESS;
+}
+
+/****************************************************************************/
+bool ConstantPowerWorker::LaunchGraph(int streamIdx,
+                                      int useNstreams,
+                                      int matrixDim,
+                                      double *alpha,
+                                      double *beta,
+                                      float *floatAlpha,
+                                      float *floatBeta)
+{
+    cudaStream_t stream = m_device->cudaStream[streamIdx];
+    cudaError_t cuSt;
 
-    if (matrixDim < 1)
+    if (m_device->graphExec[streamIdx] == 0 || m_device->graphMatrixDim[streamIdx] != matrixDim)
     {
-        matrixDim = 1;
+        if (m_device->graphExec[streamIdx])
+        {
+            cudaGraphExecDestroy(m_device->graphExec[streamIdx]);
+            m_device->graphExec[streamIdx] = 0;
+        }
+
+        /* Relaxed so cublas can allocate its workspace while the stream is being captured */
+        cuSt = cudaStreamBeginCapture(stream, cudaStreamCaptureModeRelaxed);
+        if (cuSt != cudaSuccess)
+        {
+            log_debug("cudaStreamBeginCapture returned {} for GPU {}", cudaGetErrorString(cuSt), m_device->gpuId);
+            cudaGetLastError();
+            return false;
+        }
+
+        char const *failedCall = nullptr;
+        cublasStatus_t cubSt
+            = QueueOps(streamIdx, useNstreams, matrixDim, alpha, beta, floatAlpha, floatBeta, failedCall);
+
+        /* Always end the capture, or the stream is left unusable */
+        cudaGraph_t graph = 0;
+        cuSt              = cudaStreamEndCapture(stream, &graph);
+        if (cubSt == CUBLAS_STATUS_SUCCESS && cuSt == cudaSuccess)
+        {
+            cuSt = cudaGraphInstantiateWithFlags(&m_device->graphExec[streamIdx], graph, 0);
+        }
+        if (graph)
+        {
+            cudaGraphDestroy(graph);
+        }
+
+        if (cubSt != CUBLAS_STATUS_SUCCESS || cuSt != cudaSuccess)
+        {
+            log_debug("Couldn't capture a graph for GPU {}: {} returned {}, CUDA returned {}",
+                      m_device->gpuId,
+                      failedCall != nullptr ? failedCall : "cublas",
+                      (int)cubSt,
+                      cudaGetErrorString(cuSt));
+            m_device->graphExec[streamIdx] = 0;
+            cudaGetLastError();
+            return false;
+        }
+
+        m_device->graphMatrixDim[streamIdx] = matrixDim;
     }
-    // if (matrixDim > TP_MAX_DIMENSION)
-    // {
-    //     matrixDim = TP_MAX_DIMENSION;
-    // }
-    if (matrixDim > m_maxMatrixDim)
+
+    cuSt = cudaGraphLaunch(m_device->graphExec[streamIdx], stream);
+    if (cuSt != cudaSuccess)
     {
-        matrixDim = m_maxMatrixDim;
+        log_debug("cudaGraphLaunch returned {} for GPU {}", cudaGetErrorString(cuSt), m_device->gpuId);
+        cudaGetLastError();
+        return false;
     }
 
-    return matrixDim;
+    return true;
 }
 
 /****************************************************************************/
 void ConstantPowerWorker::run()
 {
-    using namespace Dcgm;
-    int j;
     double alpha, beta;
     float floatAlpha, floatBeta;
     double startTime;
-    double lastAdjustTime       = 0.0; /* Last time we changed matrixDim */
+    double lastAdjustTime       = 0.0; /* Last time we updated the power controller */
     double lastPrintTime        = 0.0; /* last time we printed out the current power */
     double lastFailureCheckTime = 0.0; /* last time we checked for failures */
     double now;
@@ -992,6 +1090,7 @@ void ConstantPowerWorker::run()
     int useNstreams;
     int NstreamsRequeued = 0;
     int matrixDim        = 1; /* Dimension of the matrix. Start small */
+    bool useGraphs       = true; /* Launch the operations as CUDA graphs until that fails */
     cublasStatus_t cubSt;
 
     /* Set initial test values */
@@ -1002,6 +1101,17 @@ void ConstantPowerWorker::run()
     floatAlpha  = (float)alpha;
     floatBeta   = (float)beta;
 
+    /* Sample the power often enough to reach the target within a few seconds */
+    double const controlInterval = std::min(m_reAdjustInterval, TP_CONTROL_INTERVAL);
+    TargetedPowerController controller(m_targetPower, 1, m_maxMatrixDim, matrixDim);
+
+    /* If we're targeting close to max power, just go for it */
+    bool const maxPower = m_targetPower >= (0.90 * m_device->maxPowerTarget);
+    if (maxPower)
+    {
+        matrixDim = m_maxMatrixDim;
+    }
+
     /* Lock to our assigned GPU */
     cudaSetDevice(m_device->cudaDeviceIdx);
 
@@ -1020,101 +1130,25 @@ void ConstantPowerWorker::run()
             /* Query each stream to see if it's idle (cudaSuccess return) */
             if (cudaSuccess == cudaStreamQuery(m_device->cudaStream[i]))
             {
-                for (j = 0; j < m_opsPerRequeue; j++)
+                /* Launching a graph is a single call. Only queue the operations one by one if the graphs
+                   can't be used on this GPU */
+                if (!useGraphs || !LaunchGraph(i, useNstreams, matrixDim, &alpha, &beta, &floatAlpha, &floatBeta))
                 {
-                    int Cindex = ((i * useNstreams) + j) % m_device->NdeviceC;
+                    if (useGraphs)
+                    {
+                        log_debug("Queueing cublas operations directly for GPU {}", m_device->gpuId);
+                        useGraphs = false;
+                    }
 
-                    cubSt = CublasProxy::CublasSetStream(m_device->cublasHandle, m_device->cudaStream[i]);
+                    char const *failedCall = nullptr;
+                    cubSt = QueueOps(i, useNstreams, matrixDim, &alpha, &beta, &floatAlpha, &floatBeta, failedCall);
                     if (cubSt != CUBLAS_STATUS_SUCCESS)
                     {
                         LOG_CUBLAS_ERROR_FOR_PLUGIN(
-                            &m_plugin, m_plugin.GetTargetedPowerTestName(), "cublasSetStream", cubSt, m_device->gpuId);
+                            &m_plugin, m_plugin.GetTargetedPowerTestName(), failedCall, cubSt, m_device->gpuId);
                         m_stopTime = timelib_usecSince1970();
                         return;
                     }
-                    /* Make sure all streams have work. These are async calls, so they will
-                       return immediately */
-                    if (m_useDgemv)
-                    {
-                        // Only the first column vector of matrix deviceB is used
-                        cubSt = CublasProxy::CublasDgemv(m_device->cublasHandle,
-                                                         CUBLAS_OP_N,
-                                                         matrixDim,
-                                                         matrixDim,
-                                                         &alpha,
-                                                         (double *)m_device->deviceA,
-                                                         matrixDim,
-                                                         (double *)(m_device->deviceB),
-                                                         1,
-                                                         &beta,
-                                                         (double *)(m_device->deviceC[Cindex]),
-                                                         1);
-
-                        if (cubSt != CUBLAS_STATUS_SUCCESS)
-                        {
-                            LOG_CUBLAS_ERROR_FOR_PLUGIN(
-                                &m_plugin, m_plugin.GetTargetedPowerTestName(), "cublasDgemv", cubSt, m_device->gpuId);
-                            m_stopTime = timelib_usecSince1970();
-                            return;
-                        }
-                    }
-                    else
-                    {
-                        if (m_useDgemm)
-                        {
-                            cubSt = CublasProxy::CublasDgemm(m_device->cublasHandle,
-                                                             CUBLAS_OP_T,
-                                                             CUBLAS_OP_T,
-                                                             matrixDim,
-                                                             matrixDim,
-                                                             matrixDim,
-                                                             &alpha,
-                                                             (double *)m_device->deviceA,
-                                                             matrixDim,
-                                                             (double *)m_device->deviceB,
-                                                             matrixDim,
-                                                             &beta,
-                                                             (double *)m_device->deviceC[Cindex],
-                                                             matrixDim);
-                            if (cubSt != CUBLAS_STATUS_SUCCESS)
-                            {
-                                LOG_CUBLAS_ERROR_FOR_PLUGIN(&m_plugin,
-                                                            m_plugin.GetTargetedPowerTestName(),
-                                                            "cublasDgemm",
-                                                            cubSt,
-                                                            m_device->gpuId);
-                                m_stopTime = timelib_usecSince1970();
-                                return;
-                            }
-                        }
-                        else
-                        {
-                            cubSt = CublasProxy::CublasSgemm(m_device->cublasHandle,
-                                                             CUBLAS_OP_T,
-                                                             CUBLAS_OP_T,
-                                                             matrixDim,
-                                                             matrixDim,
-                                                             matrixDim,
-                                                             &floatAlpha,
-                                                             (float *)m_device->deviceA,
-                                                             matrixDim,
-                                                             (float *)m_device->deviceB,
-                                                             matrixDim,
-                                                             &floatBeta,
-                                                             (float *)m_device->deviceC[Cindex],
-                                                             matrixDim);
-                            if (cubSt != CUBLAS_STATUS_SUCCESS)
-                            {
-                                LOG_CUBLAS_ERROR_FOR_PLUGIN(&m_plugin,
-                                                            m_plugin.GetTargetedPowerTestName(),
-                                                            "cublasSgemm",
-                                                            cubSt,
-                                                            m_device->gpuId);
-                                m_stopTime = timelib_usecSince1970();
-                                return;
-                            }
-                        }
-                    }
                 }
                 NstreamsRequeued++;
             }
@@ -1129,10 +1163,9 @@ void ConstantPowerWorker::run()
         now = timelib_dsecSince1970();
 
         /* Time to adjust? */
-        if (now - lastAdjustTime > m_reAdjustInterval)
+        if (!maxPower && now - lastAdjustTime > controlInterval)
         {
-            power          = ReadPower();
-            matrixDim      = RecalcMatrixDim(matrixDim, power);
+            matrixDim      = controller.Update(ReadPower(), now);
             lastAdjustTime = now;
         }
 
@@ -1140,11 +1173,8 @@ void ConstantPowerWorker::run()
         if (now - lastPrintTime > m_printInterval)
         {
             power = ReadPower();
-            log_debug("DeviceIdx {}, Power {:.2f} W. dim: {}. minDim: {}",
-                      m_device->gpuId,
-                      power,
-                      matrixDim,
-                      m_device->minMatrixDim);
+            log_debug(
+                "DeviceIdx {}, Power {:.2f} W. dim: {}. graphs: {}", m_device->gpuId, power, matrixDim, useGraphs);
             lastPrintTime = now;
         }
         /* Time to check for failure? */
@@ -34,6 +34,7 @@
 
 #define TP_MAX_DIMENSION 8192 /* Maximum single dimension */
 #define TP_MAX_DEVICES   16   /* Maximum number of devices to run this on concurrently */
+#define TP_CONTROL_INTERVAL 0.1 /* Longest time between power controller updates in seconds */
 #define TP_MAX_STREAMS_PER_DEVICE                           \
     24 /* Maximum number of Cuda streams to use to pipeline \
                                          operations to the card */
@@ -57,14 +58,11 @@ public:
     int allocatedCublasHandle;   /* Have we allocated cublasHandle yet? */
     cublasHandle_t cublasHandle; /* Handle to cuBlas */
 
-    /* Minimum adjusted value for our matrix dimension. 1 <= X <= MAX_DIMENSION */
-    int minMatrixDim;
-
-    /* Should we only make small adjustments in matrix size? This is set to 1 after
-     * cp_recalc_matrix_dim has gotten close enough that it thinks it's in the right
-     * range
+    /* Each stream's burst of cublas operations captured as a CUDA graph, and the matrix dimension
+     * it was captured with. graphExec[i] is 0 until the burst for cudaStream[i] has been captured
      */
-    int onlySmallAdjustments;
+    cudaGraphExec_t graphExec[TP_MAX_STREAMS_PER_DEVICE];
+    int graphMatrixDim[TP_MAX_STREAMS_PER_DEVICE];
 
     /* Device pointers */
     void *deviceA;
@@ -81,14 +79,14 @@ public:
         , NcudaStreams(0)
         , allocatedCublasHandle(0)
         , cublasHandle(0)
-        , minMatrixDim(0)
-        , onlySmallAdjustments(0)
         , deviceA(0)
         , deviceB(0)
         , NdeviceC(0)
         , m_lowPowerLimit(false)
     {
         memset(cudaStream, 0, sizeof(cudaStream));
+        memset(graphExec, 0, sizeof(graphExec));
+        memset(graphMatrixDim, 0, sizeof(graphMatrixDim));
         memset(deviceC, 0, sizeof(deviceC));
     }
 
@@ -97,11 +95,20 @@ public:
         using namespace Dcgm;
         if (allocatedCublasHandle)
         {
-            CublasProxy::CublasDestroy(cublasHandle);
+            CublasProxy::CublasReleaseSharedHandle(cublasHandle);
             cublasHandle          = 0;
             allocatedCublasHandle = 0;
         }
 
+        for (int i = 0; i < TP_MAX_STREAMS_PER_DEVICE; i++)
+        {
+            if (graphExec[i])
+            {
+                cudaGraphExecDestroy(graphExec[i]);
+                graphExec[i] = 0;
+            }
+        }
+
         for (int i = 0; i < NcudaStreams; i++)
         {
             cudaError_t cuSt = cudaStreamDestroy(cudaStream[i]);
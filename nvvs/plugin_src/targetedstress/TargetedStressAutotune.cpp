@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "TargetedStressAutotune.h"
+
+#include <DcgmLogging.h>
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace
+{
+/* Workers for several GPUs may read and update the cache at once */
+std::mutex g_cacheMutex;
+
+/*
+ * Each line of the cache file is:
+ *   <gpu name>\t<dgemm|sgemm>\t<dim>\t<transA transB, each N or T>\t<tf32|default>
+ * GPU names contain spaces, so fields are separated by tabs.
+ */
+char const *PrecisionName(bool useDgemm)
+{
+    return useDgemm ? "dgemm" : "sgemm";
+}
+
+std::string FormatLine(std::string const &gpuName, bool useDgemm, TsGemmConfig const &config)
+{
+    std::string line = gpuName + '\t' + PrecisionName(useDgemm) + '\t' + std::to_string(config.dim) + '\t';
+    line += config.transA ? 'T' : 'N';
+    line += config.transB ? 'T' : 'N';
+    line += config.tensorOps ? "\ttf32" : "\tdefault";
+    return line;
+}
+
+std::vector<std::string> SplitTabs(std::string const &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, '\t'))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/* Parse line if it is for gpuName and useDgemm */
+std::optional<TsGemmConfig> ParseLine(std::string const &line, std::string const &gpuName, bool useDgemm)
+{
+    std::vector<std::string> fields = SplitTabs(line);
+    if (fields.size() != 5 || fields[0] != gpuName || fields[1] != PrecisionName(useDgemm))
+    {
+        return std::nullopt;
+    }
+
+    TsGemmConfig config;
+    try
+    {
+        config.dim = std::stoi(fields[2]);
+    }
+    catch (std::exception const &)
+    {
+        return std::nullopt;
+    }
+
+    std::string const &trans = fields[3];
+    if (config.dim <= 0 || trans.size() != 2 || (trans[0] != 'N' && trans[0] != 'T')
+        || (trans[1] != 'N' && trans[1] != 'T') || (fields[4] != "tf32" && fields[4] != "default"))
+    {
+        return std::nullopt;
+    }
+
+    config.transA    = trans[0] == 'T';
+    config.transB    = trans[1] == 'T';
+    config.tensorOps = fields[4] == "tf32";
+    return config;
+}
+} // namespace
+
+/*****************************************************************************/
+std::vector<TsGemmConfig> TsGetGemmCandidates(bool useDgemm, int maxDim)
+{
+    std::vector<TsGemmConfig> candidates;
+
+    /* Multiples of 256 keep every tile of the common gemm kernels full */
+    std::vector<int> dims;
+    for (int dim : { 1024, 1280, 1536, 2048 })
+    {
+        if (dim <= maxDim)
+        {
+            dims.push_back(dim);
+        }
+    }
+    if (dims.empty() || dims.back() != maxDim)
+    {
+        dims.push_back(maxDim);
+    }
+
+    for (int dim : dims)
+    {
+        for (int trans = 0; trans < 4; trans++)
+        {
+            TsGemmConfig config;
+            config.dim    = dim;
+            config.transA = (trans & 1) != 0;
+            config.transB = (trans & 2) != 0;
+            candidates.push_back(config);
+
+            if (!useDgemm)
+            {
+                config.tensorOps = true;
+                candidates.push_back(config);
+            }
+        }
+    }
+
+    return candidates;
+}
+
+/*****************************************************************************/
+std::optional<TsGemmConfig> TsPickGemmConfig(std::vector<TsGemmConfig> const &candidates,
+                                             std::vector<double> const &gflops)
+{
+    std::optional<TsGemmConfig> best;
+    double bestGflops = 0.0;
+
+    for (size_t i = 0; i < candidates.size() && i < gflops.size(); i++)
+    {
+        if (gflops[i] > bestGflops)
+        {
+            best       = candidates[i];
+            bestGflops = gflops[i];
+        }
+    }
+
+    return best;
+}
+
+/*****************************************************************************/
+std::optional<TsGemmConfig> TsReadAutotuneCache(std::string const &path, std::string const &gpuName, bool useDgemm)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (auto config = ParseLine(line, gpuName, useDgemm))
+        {
+            return config;
+        }
+    }
+
+    return std::nullopt;
+}
+
+/*****************************************************************************/
+bool TsWriteAutotuneCache(std::string const &path,
+                          std::string const &gpuName,
+                          bool useDgemm,
+                          TsGemmConfig const &config)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+
+    std::vector<std::string> lines;
+    {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::vector<std::string> fields = SplitTabs(line);
+            if (fields.size() >= 2 && fields[0] == gpuName && fields[1] == PrecisionName(useDgemm))
+            {
+                continue;
+            }
+            lines.push_back(line);
+        }
+    }
+    lines.push_back(FormatLine(gpuName, useDgemm, config));
+
+    /* Write a new file and rename it over the old one so a reader never sees half of it */
+    std::string const tmpPath = path + "." + std::to_string(getpid());
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        for (auto const &line : lines)
+        {
+            out << line << '\n';
+        }
+        out.flush();
+        if (!out)
+        {
+            log_debug("Couldn't write the autotune cache '{}'", tmpPath);
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        log_debug("Couldn't replace the autotune cache '{}'", path);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
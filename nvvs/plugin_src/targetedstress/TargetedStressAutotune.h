@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+/*****************************************************************************/
+/* Shape, transposes and math mode of the gemm the targeted stress workers queue */
+struct TsGemmConfig
+{
+    int dim        = 0;     /* Dimension of the square matrices */
+    bool transA    = false; /* Transpose A */
+    bool transB    = false; /* Transpose B */
+    bool tensorOps = false; /* Let sgemm use TF32 tensor cores. Ignored for dgemm */
+
+    bool operator==(TsGemmConfig const &other) const = default;
+};
+
+/*****************************************************************************/
+/*
+ * Get the gemm configurations worth timing. Dimensions are no larger than maxDim, which the buffers are sized for.
+ * The precision family is fixed by useDgemm, so only sgemm gets the tensor core candidates.
+ */
+std::vector<TsGemmConfig> TsGetGemmCandidates(bool useDgemm, int maxDim);
+
+/*****************************************************************************/
+/*
+ * Pick the configuration with the highest measured gflops. gflops[i] is the throughput of candidates[i], or < 0.0
+ * if it couldn't be measured. Ties go to the earlier candidate.
+ *
+ * Returns std::nullopt if nothing was measured
+ */
+std::optional<TsGemmConfig> TsPickGemmConfig(std::vector<TsGemmConfig> const &candidates,
+                                             std::vector<double> const &gflops);
+
+/*****************************************************************************/
+/*
+ * Look up the configuration chosen earlier for gpuName in the cache file at path.
+ *
+ * Returns std::nullopt if there isn't one or the file can't be read
+ */
+std::optional<TsGemmConfig> TsReadAutotuneCache(std::string const &path, std::string const &gpuName, bool useDgemm);
+
+/*****************************************************************************/
+/*
+ * Save config as the configuration for gpuName to the cache file at path, keeping the entries of other GPUs.
+ *
+ * Returns true on success
+ *         false if the file couldn't be written
+ */
+bool TsWriteAutotuneCache(std::string const &path,
+                          std::string const &gpuName,
+                          bool useDgemm,
+                          TsGemmConfig const &config);
@@ -62,6 +62,8 @@ ConstantPerf::ConstantPerf(dcgmHandle_t handle)
     m_testParameters->AddDouble(TS_STR_MAX_MEMORY_CLOCK, 0.0);
     m_testParameters->AddDouble(TS_STR_MAX_GRAPHICS_CLOCK, 0.0);
     m_testParameters->AddDouble(TS_STR_SBE_ERROR_THRESHOLD, DCGM_FP64_BLANK);
+    m_testParameters->AddString(TS_STR_AUTOTUNE, "True");
+    m_testParameters->AddString(TS_STR_AUTOTUNE_CACHE, TS_AUTOTUNE_CACHE_PATH);
     m_testParameters->AddString(PS_LOGFILE, "stats_targeted_stress.json");
     m_testParameters->AddDouble(PS_LOGFILE_TYPE, 0.0);
     m_infoStruct.defaultTestParameters = new TestParameters(*m_testParameters);
@@ -317,7 +319,7 @@ int ConstantPerf::CudaInit()
         }
 
         /* Initialize cublas */
-        cubSt = CublasProxy::CublasCreate(&device->cublasHandle);
+        cubSt = CublasProxy::CublasAcquireSharedHandle(device->cudaDeviceIdx, &device->cublasHandle);
         if (cubSt != CUBLAS_STATUS_SUCCESS)
         {
             LOG_CUBLAS_ERROR(GetTargetedStressTestName(), "cublasCreate", cubSt, device->gpuId);
@@ -553,6 +555,8 @@ private:
     DcgmRecorder &m_dcgmRecorder;      /* Object for interacting with DCGM */
     bool m_failEarly;                  /* true if we should end the first time we detect a failure */
     unsigned long m_failCheckInterval; /* number of seconds between which we should checks */
+    bool m_autotune;                   /* Whether to time gemm configurations before starting */
+    std::string m_autotuneCache;       /* File to save the chosen gemm configuration to. Empty for none */
 
 public:
     /*************************************************************************/
@@ -626,6 +630,38 @@ private:
                  float *floatBeta,
                  double *doubleBeta);
 
+    /*****************************************************************************/
+    /*
+     * Queue one gemm with config to a stream. The math mode must already be set for config.
+     *
+     * Returns the status of the cublas call
+     */
+    cublasStatus_t QueueGemm(cperf_stream_p cpStream,
+                             TsGemmConfig const &config,
+                             float *floatAlpha,
+                             double *doubleAlpha,
+                             float *floatBeta,
+                             double *doubleBeta);
+
+    /*****************************************************************************/
+    /*
+     * Time TS_AUTOTUNE_OPS gemms with config on the first stream.
+     *
+     * Returns the gflops they ran at, or < 0.0 on error
+     */
+    double TimeGemm(TsGemmConfig const &config,
+                    float *floatAlpha,
+                    double *doubleAlpha,
+                    float *floatBeta,
+                    double *doubleBeta);
+
+    /*****************************************************************************/
+    /*
+     * Set m_device->gemmConfig to the configuration cached for this GPU's name, or else to the fastest of
+     * TsGetGemmCandidates(), saving it to the cache. Keeps the default configuration if nothing can be timed.
+     */
+    void Autotune(float *floatAlpha, double *doubleAlpha, float *floatBeta, double *doubleBeta);
+
     std::string GetTargetedStressTestName()
     {
         return TS_PLUGIN_NAME;
@@ -780,10 +816,12 @@ ConstantPerfWorker::ConstantPerfWorker(CPerfDevice *device,
     , m_failEarly(failEarly)
     , m_failCheckInterval(failCheckInterval)
 {
-    m_useDgemm     = tp->GetBoolFromString(TS_STR_USE_DGEMM);
-    m_targetPerf   = tp->GetDouble(TS_STR_TARGET_PERF);
-    m_testDuration = tp->GetDouble(TS_STR_TEST_DURATION);
-    m_atATime      = tp->GetDouble(TS_STR_CUDA_OPS_PER_STREAM);
+    m_useDgemm      = tp->GetBoolFromString(TS_STR_USE_DGEMM);
+    m_targetPerf    = tp->GetDouble(TS_STR_TARGET_PERF);
+    m_testDuration  = tp->GetDouble(TS_STR_TEST_DURATION);
+    m_atATime       = tp->GetDouble(TS_STR_CUDA_OPS_PER_STREAM);
+    m_autotune      = tp->GetBoolFromString(TS_STR_AUTOTUNE);
+    m_autotuneCache = tp->GetString(TS_STR_AUTOTUNE_CACHE);
 }
 
 /****************************************************************************/
@@ -855,7 +893,7 @@ int ConstantPerfWorker::QueueOne(int streamIdx,
         valueSize = sizeof(float);
     }
 
-    arrayByteSize = valueSize * TS_TEST_DIMENSION * TS_TEST_DIMENSION;
+    arrayByteSize = valueSize * m_device->gemmConfig.dim * m_device->gemmConfig.dim;
 
     cuSt = cudaEventRecord(cpStream->beforeCopyH2D[opIdx], cpStream->cudaStream);
     if (cuSt != cudaSuccess)
@@ -899,51 +937,15 @@ int ConstantPerfWorker::QueueOne(int streamIdx,
         return -1;
     }
 
-    if (m_useDgemm)
-    {
-        cubSt = CublasProxy::CublasDgemm(m_device->cublasHandle,
-                                         CUBLAS_OP_N,
-                                         CUBLAS_OP_N,
-                                         TS_TEST_DIMENSION,
-                                         TS_TEST_DIMENSION,
-                                         TS_TEST_DIMENSION,
-                                         doubleAlpha,
-                                         (double *)cpStream->deviceA,
-                                         TS_TEST_DIMENSION,
-                                         (double *)cpStream->deviceB,
-                                         TS_TEST_DIMENSION,
-                                         doubleBeta,
-                                         (double *)cpStream->deviceC,
-                                         TS_TEST_DIMENSION);
-        if (cubSt != CUBLAS_STATUS_SUCCESS)
-        {
-            LOG_CUBLAS_ERROR_FOR_PLUGIN(
-                &m_plugin, m_plugin.GetTargetedStressTestName(), "cublasDgemm", cubSt, m_device->gpuId);
-            return -1;
-        }
-    }
-    else
+    cubSt = QueueGemm(cpStream, m_device->gemmConfig, floatAlpha, doubleAlpha, floatBeta, doubleBeta);
+    if (cubSt != CUBLAS_STATUS_SUCCESS)
     {
-        cubSt = CublasProxy::CublasSgemm(m_device->cublasHandle,
-                                         CUBLAS_OP_N,
-                                         CUBLAS_OP_N,
-                                         TS_TEST_DIMENSION,
-                                         TS_TEST_DIMENSION,
-                                         TS_TEST_DIMENSION,
-                                         floatAlpha,
-                                         (float *)cpStream->deviceA,
-                                         TS_TEST_DIMENSION,
-                                         (float *)cpStream->deviceB,
-                                         TS_TEST_DIMENSION,
-                                         floatBeta,
-                                         (float *)cpStream->deviceC,
-                                         TS_TEST_DIMENSION);
-        if (cubSt != CUBLAS_STATUS_SUCCESS)
-        {
-            LOG_CUBLAS_ERROR_FOR_PLUGIN(
-                &m_plugin, m_plugin.GetTargetedStressTestName(), "cublasSgemm", cubSt, m_device->gpuId);
-            return -1;
-        }
+        LOG_CUBLAS_ERROR_FOR_PLUGIN(&m_plugin,
+                                    m_plugin.GetTargetedStressTestName(),
+                                    m_useDgemm ? "cublasDgemm" : "cublasSgemm",
+                                    cubSt,
+                                    m_device->gpuId);
+        return -1;
     }
 
     cuSt = cudaEventRecord(cpStream->beforeCopyD2H[opIdx], cpStream->cudaStream);
@@ -975,6 +977,163 @@ int ConstantPerfWorker::QueueOne(int streamIdx,
     return 0;
 }
 
+/****************************************************************************/
+cublasStatus_t ConstantPerfWorker::QueueGemm(cperf_stream_p cpStream,
+                                             TsGemmConfig const &config,
+                                             float *floatAlpha,
+                                             double *doubleAlpha,
+                                             float *floatBeta,
+                                             double *doubleBeta)
+{
+    using namespace Dcgm;
+    cublasOperation_t transA = config.transA ? CUBLAS_OP_T : CUBLAS_OP_N;
+    cublasOperation_t transB = config.transB ? CUBLAS_OP_T : CUBLAS_OP_N;
+    int dim                  = config.dim;
+
+    if (m_useDgemm)
+    {
+        return CublasProxy::CublasDgemm(m_device->cublasHandle,
+                                        transA,
+                                        transB,
+                                        dim,
+                                        dim,
+                                        dim,
+                                        doubleAlpha,
+                                        (double *)cpStream->deviceA,
+                                        dim,
+                                        (double *)cpStream->deviceB,
+                                        dim,
+                                        doubleBeta,
+                                        (double *)cpStream->deviceC,
+                                        dim);
+    }
+
+    return CublasProxy::CublasSgemm(m_device->cublasHandle,
+                                    transA,
+                                    transB,
+                                    dim,
+                                    dim,
+                                    dim,
+                                    floatAlpha,
+                                    (float *)cpStream->deviceA,
+                                    dim,
+                                    (float *)cpStream->deviceB,
+                                    dim,
+                                    floatBeta,
+                                    (float *)cpStream->deviceC,
+                                    dim);
+}
+
+/****************************************************************************/
+double ConstantPerfWorker::TimeGemm(TsGemmConfig const &config,
+                                    float *floatAlpha,
+                                    double *doubleAlpha,
+                                    float *floatBeta,
+                                    double *doubleBeta)
+{
+    using namespace Dcgm;
+    cperf_stream_p cpStream = &m_device->streams[0];
+    float elapsedMs         = 0.0;
+
+    cublasMath_t mathMode = config.tensorOps ? CUBLAS_TF32_TENSOR_OP_MATH : CUBLAS_DEFAULT_MATH;
+    if (CublasProxy::CublasSetMathMode(m_device->cublasHandle, mathMode) != CUBLAS_STATUS_SUCCESS
+        || CublasProxy::CublasSetStream(m_device->cublasHandle, cpStream->cudaStream) != CUBLAS_STATUS_SUCCESS)
+    {
+        return -1.0;
+    }
+
+    /* The first call for a configuration may load its kernel, so leave it out of the timing */
+    if (QueueGemm(cpStream, config, floatAlpha, doubleAlpha, floatBeta, doubleBeta) != CUBLAS_STATUS_SUCCESS
+        || cudaEventRecord(cpStream->beforeGemm[0], cpStream->cudaStream) != cudaSuccess)
+    {
+        return -1.0;
+    }
+
+    for (int i = 0; i < TS_AUTOTUNE_OPS; i++)
+    {
+        if (QueueGemm(cpStream, config, floatAlpha, doubleAlpha, floatBeta, doubleBeta) != CUBLAS_STATUS_SUCCESS)
+        {
+            return -1.0;
+        }
+    }
+
+    if (cudaEventRecord(cpStream->beforeCopyD2H[0], cpStream->cudaStream) != cudaSuccess
+        || cudaStreamSynchronize(cpStream->cudaStream) != cudaSuccess
+        || cudaEventElapsedTime(&elapsedMs, cpStream->beforeGemm[0], cpStream->beforeCopyD2H[0]) != cudaSuccess
+        || elapsedMs <= 0.0)
+    {
+        return -1.0;
+    }
+
+    double flops = 2.0 * (double)config.dim * (double)config.dim * (double)config.dim * TS_AUTOTUNE_OPS;
+    return flops / (1000000.0 * (double)elapsedMs);
+}
+
+/****************************************************************************/
+void ConstantPerfWorker::Autotune(float *floatAlpha, double *doubleAlpha, float *floatBeta, double *doubleBeta)
+{
+    using namespace Dcgm;
+    std::string gpuName = m_device->cudaDevProp.name;
+    TsGemmConfig config = m_device->gemmConfig;
+
+    std::optional<TsGemmConfig> cached;
+    if (!m_autotuneCache.empty())
+    {
+        cached = TsReadAutotuneCache(m_autotuneCache, gpuName, m_useDgemm);
+    }
+
+    if (cached && cached->dim <= TS_TEST_DIMENSION)
+    {
+        config = *cached;
+        log_debug("Using the cached gemm configuration for GPU {} ({})", m_device->gpuId, gpuName);
+    }
+    else if (m_device->Nstreams > 0 && m_device->streams[0].NeventsInitalized > 0)
+    {
+        cperf_stream_p cpStream = &m_device->streams[0];
+        size_t valueSize        = m_useDgemm ? sizeof(double) : sizeof(float);
+        size_t arrayByteSize    = valueSize * TS_TEST_DIMENSION * TS_TEST_DIMENSION;
+
+        /* Time with real values rather than whatever the device memory held */
+        if (cudaMemcpy(cpStream->deviceA, cpStream->hostA, arrayByteSize, cudaMemcpyHostToDevice) == cudaSuccess
+            && cudaMemcpy(cpStream->deviceB, cpStream->hostB, arrayByteSize, cudaMemcpyHostToDevice) == cudaSuccess)
+        {
+            std::vector<TsGemmConfig> candidates = TsGetGemmCandidates(m_useDgemm, TS_TEST_DIMENSION);
+            std::vector<double> gflops;
+            for (auto const &candidate : candidates)
+            {
+                gflops.push_back(TimeGemm(candidate, floatAlpha, doubleAlpha, floatBeta, doubleBeta));
+            }
+
+            std::optional<TsGemmConfig> best = TsPickGemmConfig(candidates, gflops);
+            if (best)
+            {
+                config = *best;
+                if (!m_autotuneCache.empty() && !TsWriteAutotuneCache(m_autotuneCache, gpuName, m_useDgemm, config))
+                {
+                    log_debug("Couldn't save the gemm configuration for {} to '{}'", gpuName, m_autotuneCache);
+                }
+            }
+            else
+            {
+                log_debug("Couldn't time any gemm configuration for GPU {}. Using the default", m_device->gpuId);
+            }
+        }
+        /* Timing may have left an error behind. The test itself reports any real problem */
+        cudaGetLastError();
+    }
+
+    m_device->gemmConfig = config;
+    CublasProxy::CublasSetMathMode(m_device->cublasHandle,
+                                   config.tensorOps ? CUBLAS_TF32_TENSOR_OP_MATH : CUBLAS_DEFAULT_MATH);
+
+    log_debug("GPU {} gemm configuration: dim {}, transA {}, transB {}, tensor ops {}",
+              m_device->gpuId,
+              config.dim,
+              config.transA,
+              config.transB,
+              config.tensorOps);
+}
+
 /****************************************************************************/
 void ConstantPerfWorker::run(void)
 {
@@ -1001,11 +1160,6 @@ void ConstantPerfWorker::run(void)
         valueSize = sizeof(float);
     }
 
-    double copyBytesPerOp = 3.0 * (double)valueSize * (double)TS_TEST_DIMENSION * (double)TS_TEST_DIMENSION;
-    double flopsPerOp     = 2.0 * (double)TS_TEST_DIMENSION * (double)TS_TEST_DIMENSION * (double)TS_TEST_DIMENSION;
-    double opsPerSec      = m_targetPerf / (flopsPerOp / 1000000000.0);
-    long long maxOpsSoFar;
-
     /* Set initial test values */
     useNstreams = TS_MAX_STREAMS_PER_DEVICE;
     doubleAlpha = 1.01 + ((double)(rand() % 100) / 10.0);
@@ -1013,6 +1167,20 @@ void ConstantPerfWorker::run(void)
     floatAlpha  = (float)doubleAlpha;
     floatBeta   = (float)doubleBeta;
 
+    /* Lock to our assigned GPU */
+    cudaSetDevice(m_device->cudaDeviceIdx);
+
+    if (m_autotune)
+    {
+        Autotune(&floatAlpha, &doubleAlpha, &floatBeta, &doubleBeta);
+    }
+
+    double dim            = (double)m_device->gemmConfig.dim;
+    double copyBytesPerOp = 3.0 * (double)valueSize * dim * dim;
+    double flopsPerOp     = 2.0 * dim * dim * dim;
+    double opsPerSec      = m_targetPerf / (flopsPerOp / 1000000000.0);
+    long long maxOpsSoFar;
+
     std::string gflopsKey;
     gflopsKey = std::string(PERF_STAT_NAME);
 
@@ -1023,9 +1191,8 @@ void ConstantPerfWorker::run(void)
     m_plugin.SetGpuStat(
         GetTargetedStressTestName(), m_device->gpuId, std::string("num_cuda_streams"), (long long)useNstreams);
     m_plugin.SetGpuStat(GetTargetedStressTestName(), m_device->gpuId, std::string("try_ops_per_sec"), opsPerSec);
-
-    /* Lock to our assigned GPU */
-    cudaSetDevice(m_device->cudaDeviceIdx);
+    m_plugin.SetGpuStat(
+        GetTargetedStressTestName(), m_device->gpuId, std::string("gemm_dim"), (long long)m_device->gemmConfig.dim);
 
     std::stringstream ss;
     ss << "Running for " << m_testDuration << " seconds";
@@ -27,6 +27,7 @@
 #include "Plugin.h"
 #include "PluginCommon.h"
 #include "PluginDevice.h"
+#include "TargetedStressAutotune.h"
 
 #include <DcgmRecorder.h>
 #include <NvvsStructs.h>
@@ -43,6 +44,9 @@
     100 /* Maximum number of concurrent ops \
                                                    that can be queued per stream per GPU */
 
+#define TS_AUTOTUNE_OPS        4 /* Number of gemms to time for each configuration when autotuning */
+#define TS_AUTOTUNE_CACHE_PATH "/etc/datacenter-gpu-manager-4/targeted_stress_autotune.txt"
+
 /*****************************************************************************/
 /* String constants */
 
@@ -103,6 +107,8 @@ public:
     double usecInCopies; /* How long (microseconds) have we spent copying data to and from the GPU */
     double usecInGemm;   /* How long (microseconds) have we spent running gemm */
 
+    TsGemmConfig gemmConfig; /* Gemm to queue. Picked by autotuning */
+
     CPerfDevice(std::string const &testName, unsigned int ndi, const char *pciBusId, Plugin *p)
         : PluginDevice(testName, ndi, pciBusId, p)
         , Nstreams(0)
@@ -112,6 +118,7 @@ public:
         , usecInGemm(.0)
     {
         memset(streams, 0, sizeof(streams));
+        gemmConfig.dim = TS_TEST_DIMENSION;
     }
 
     ~CPerfDevice()
@@ -119,7 +126,7 @@ public:
         using namespace Dcgm;
         if (allocatedCublasHandle)
         {
-            CublasProxy::CublasDestroy(cublasHandle);
+            CublasProxy::CublasReleaseSharedHandle(cublasHandle);
             cublasHandle          = 0;
             allocatedCublasHandle = 0;
         }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <TargetedStressAutotune.h>
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+TEST_CASE("TargetedStressAutotune: Candidates")
+{
+    auto dgemm = TsGetGemmCandidates(true, 1280);
+    REQUIRE(dgemm.size() == 8);
+    for (auto const &config : dgemm)
+    {
+        CHECK(config.dim <= 1280);
+        CHECK(config.tensorOps == false);
+    }
+
+    /* sgemm also tries the tensor cores */
+    auto sgemm = TsGetGemmCandidates(false, 1280);
+    CHECK(sgemm.size() == 16);
+
+    /* The buffer size is always a candidate */
+    auto small = TsGetGemmCandidates(true, 512);
+    REQUIRE(small.size() == 4);
+    CHECK(small[0].dim == 512);
+}
+
+TEST_CASE("TargetedStressAutotune: Pick the fastest")
+{
+    auto candidates = TsGetGemmCandidates(true, 1280);
+
+    CHECK(TsPickGemmConfig(candidates, std::vector<double>(candidates.size(), -1.0)) == std::nullopt);
+
+    std::vector<double> gflops(candidates.size(), 100.0);
+    gflops[3] = 150.0;
+    gflops[5] = -1.0;
+    auto best = TsPickGemmConfig(candidates, gflops);
+    REQUIRE(best);
+    CHECK(*best == candidates[3]);
+}
+
+TEST_CASE("TargetedStressAutotune: Cache")
+{
+    std::string path = "/tmp/ts_autotune_test." + std::to_string(getpid());
+    std::remove(path.c_str());
+
+    CHECK(TsReadAutotuneCache(path, "NVIDIA H100 80GB HBM3", true) == std::nullopt);
+
+    TsGemmConfig h100 { 1024, true, false, false };
+    TsGemmConfig b200 { 1280, false, true, true };
+    REQUIRE(TsWriteAutotuneCache(path, "NVIDIA H100 80GB HBM3", true, h100));
+    REQUIRE(TsWriteAutotuneCache(path, "NVIDIA B200", false, b200));
+
+    CHECK(TsReadAutotuneCache(path, "NVIDIA H100 80GB HBM3", true) == h100);
+    CHECK(TsReadAutotuneCache(path, "NVIDIA B200", false) == b200);
+    /* Keyed by precision as well as name */
+    CHECK(TsReadAutotuneCache(path, "NVIDIA H100 80GB HBM3", false) == std::nullopt);
+
+    /* Rewriting replaces the entry and keeps the others */
+    h100.dim = 1280;
+    REQUIRE(TsWriteAutotuneCache(path, "NVIDIA H100 80GB HBM3", true, h100));
+    CHECK(TsReadAutotuneCache(path, "NVIDIA H100 80GB HBM3", true) == h100);
+    CHECK(TsReadAutotuneCache(path, "NVIDIA B200", false) == b200);
+
+    /* Malformed lines are skipped */
+    {
+        std::ofstream out(path, std::ios::app);
+        out << "NVIDIA A100\tdgemm\tbig\tNN\tdefault\n";
+        out << "NVIDIA A100\tsgemm\t1024\tNX\tdefault\n";
+    }
+    CHECK(TsReadAutotuneCache(path, "NVIDIA A100", true) == std::nullopt);
+    CHECK(TsReadAutotuneCache(path, "NVIDIA A100", false) == std::nullopt);
+
+    CHECK(TsWriteAutotuneCache("/nonexistent/dir/cache", "NVIDIA B200", false, b200) == false);
+
+    std::remove(path.c_str());
+}
@@ -69,6 +69,19 @@ cublasStatus_t CublasDestroy(cublasHandle_t /* handle */)
     return CUBLAS_STATUS_SUCCESS;
 }
 
+cublasStatus_t CublasAcquireSharedHandle(int /* cudaDeviceIdx */, cublasHandle_t * /* handle */)
+{
+    return CUBLAS_STATUS_SUCCESS;
+}
+
+cublasStatus_t CublasReleaseSharedHandle(cublasHandle_t /* handle */)
+{
+    return CUBLAS_STATUS_SUCCESS;
+}
+
+void CublasDestroySharedHandles()
+{}
+
 cublasStatus_t CublasSetMathMode(cublasHandle_t /* handle */, cublasMath_t /* mode */)
 {
     return CUBLAS_STATUS_SUCCESS;
@@ -191,3 +191,55 @@ CUresult cuStreamDestroy(CUstream /* hStream */)
 {
     return CUDA_SUCCESS;
 }
+
+CUresult cuStreamBeginCapture(CUstream /* hStream */, CUstreamCaptureMode /* mode */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuStreamEndCapture(CUstream /* hStream */, CUgraph * /* phGraph */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuGraphInstantiateWithFlags(CUgraphExec * /* phGraphExec */,
+                                     CUgraph /* hGraph */,
+                                     unsigned long long /* flags */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuGraphLaunch(CUgraphExec /* hGraphExec */, CUstream /* hStream */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuGraphExecDestroy(CUgraphExec /* hGraphExec */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuGraphDestroy(CUgraph /* hGraph */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuEventSynchronize(CUevent /* hEvent */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuMemsetD32Async(CUdeviceptr /* dstDevice */, unsigned int /* ui */, size_t /* N */, CUstream /* hStream */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuMemHostAlloc(void ** /* pp */, size_t /* bytesize */, unsigned int /* flags */)
+{
+    return CUDA_SUCCESS;
+}
+
+CUresult cuMemFreeHost(void * /* p */)
+{
+    return CUDA_SUCCESS;
+}
@@ -17,6 +17,8 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <unordered_set>
@@ -190,6 +192,25 @@ bool FrameworkConfig::SetFrameworkConfigValue(nvvs_fwcfg_enum field, const std::
     return true;
 }
 
+/*****************************************************************************/
+/* The packaged YAML only changes with the package, so a process that parses the config
+ * for several runs (the NVVS worker) reads it once. Each caller gets its own copy.
+ */
+static YAML::Node LoadPackageYaml(std::filesystem::path const &path)
+{
+    static std::mutex cacheMutex;
+    static std::filesystem::path cachedPath;
+    static std::optional<YAML::Node> cachedYaml;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (!cachedYaml || cachedPath != path)
+    {
+        cachedYaml = YAML::LoadFile(path);
+        cachedPath = path;
+    }
+    return YAML::Clone(*cachedYaml);
+}
+
 /*****************************************************************************/
 /* ctor saves off the input parameters to local copies/references and opens
  * the config file
@@ -224,7 +245,7 @@ ConfigFileParser_v2::ConfigFileParser_v2(const std::string &configFile, const Fr
         }();
 
         DCGM_LOG_DEBUG << "Loading package YAML from " << packageYamlLocation.string();
-        m_fallbackYaml = YAML::LoadFile(packageYamlLocation);
+        m_fallbackYaml = LoadPackageYaml(packageYamlLocation);
         DCGM_LOG_DEBUG << "Loaded package YAML";
     }
     catch (const std::exception &e)
@@ -581,7 +602,10 @@ void ConfigFileParser_v2::legacyGlobalStructHelper()
 {
     NvvsFrameworkConfig fwcfg = m_fwcfg.GetFWCFG();
     nvvsCommon.logFile        = fwcfg.dataFile;
-    nvvsCommon.logFileType    = fwcfg.dataFileType;
+    if (nvvsCommon.logFileType != NVVS_LOGFILE_TYPE_JSON_LINES) // if it was picked on the command line, keep it
+    {
+        nvvsCommon.logFileType = fwcfg.dataFileType;
+    }
     nvvsCommon.serialize      = fwcfg.overrideSerial;
     if (nvvsCommon.parse == false) // if it was turned on in the command line, don't overwrite it
     {
@@ -16,6 +16,8 @@
 #include <CustomStatHolder.h>
 #include <timelib.h>
 
+#include <utility>
+
 CustomStatHolder::CustomStatHolder()
     : m_gpus()
     , m_gpuData()
@@ -28,11 +30,66 @@ CustomStatHolder::CustomStatHolder()
     , m_statPopulationType(0)
 {}
 
+CustomStatHolder::~CustomStatHolder()
+{
+    // Frees the pending lists
+    MergePendingGpuStats();
+    MergePendingGroupedStats();
+}
+
 void CustomStatHolder::ClearCustomData()
 {
+    DcgmLockGuard lock(&m_gpuDataMutex);
+    MergePendingGpuStats();
     m_gpuData.clear();
 }
 
+void CustomStatHolder::PushPendingStat(std::atomic<PendingStat *> &list, PendingStat *stat)
+{
+    stat->next = list.load(std::memory_order_relaxed);
+    while (!list.compare_exchange_weak(stat->next, stat, std::memory_order_release, std::memory_order_relaxed))
+        ;
+}
+
+CustomStatHolder::PendingStat *CustomStatHolder::TakePendingStats(std::atomic<PendingStat *> &list)
+{
+    PendingStat *stat    = list.exchange(nullptr, std::memory_order_acquire);
+    PendingStat *ordered = nullptr;
+
+    while (stat != nullptr)
+    {
+        PendingStat *next = stat->next;
+        stat->next        = ordered;
+        ordered           = stat;
+        stat              = next;
+    }
+
+    return ordered;
+}
+
+void CustomStatHolder::MergePendingGpuStats()
+{
+    for (unsigned int gpuId = 0; gpuId < m_pendingGpuStats.size(); gpuId++)
+    {
+        PendingStat *stat = TakePendingStats(m_pendingGpuStats[gpuId]);
+        while (stat != nullptr)
+        {
+            m_gpuData[gpuId][stat->name].push_back(stat->data);
+            delete std::exchange(stat, stat->next);
+        }
+    }
+}
+
+void CustomStatHolder::MergePendingGroupedStats()
+{
+    PendingStat *stat = TakePendingStats(m_pendingGroupedStats);
+    while (stat != nullptr)
+    {
+        m_groupedData[stat->groupName][stat->name].push_back(stat->data);
+        delete std::exchange(stat, stat->next);
+    }
+}
+
 void CustomStatHolder::AddCustomTimeseriesVector(Json::Value &jv, std::vector<dcgmTimeseriesInfo_t> &vec)
 {
     Json::ArrayIndex next = 0;
@@ -53,6 +110,7 @@ void CustomStatHolder::AddCustomTimeseriesVector(Json::Value &jv, std::vector<dc
 std::vector<dcgmTimeseriesInfo_t> CustomStatHolder::GetCustomGpuStat(unsigned int gpuId, const std::string &name)
 {
     DcgmLockGuard lock(&m_gpuDataMutex);
+    MergePendingGpuStats();
     return m_gpuData[gpuId][name];
 }
 
@@ -106,27 +164,32 @@ dcgmReturn_t CustomStatHolder::InsertGroupedData(const std::string &groupName,
                                                  const std::string &name,
                                                  dcgmTimeseriesInfo_t &data)
 {
-    DcgmLockGuard lock(&m_groupedDataMutex);
     if (m_currentlyIterating)
     {
         DCGM_LOG_ERROR << "Cannot insert data because we're in the middle of reporting on the data";
         return DCGM_ST_IN_USE;
     }
 
-    m_groupedData[groupName][name].push_back(data);
+    PushPendingStat(m_pendingGroupedStats, new PendingStat { groupName, name, data, nullptr });
     return DCGM_ST_OK;
 }
 
 dcgmReturn_t CustomStatHolder::InsertCustomData(unsigned int gpuId, const std::string &name, dcgmTimeseriesInfo_t &data)
 {
-    DcgmLockGuard lock(&m_gpuDataMutex);
     if (m_currentlyIterating)
     {
         DCGM_LOG_ERROR << "Cannot insert data because we're in the middle of reporting on the data";
         return DCGM_ST_IN_USE;
     }
 
-    m_gpuData[gpuId][name].push_back(data);
+    if (gpuId >= m_pendingGpuStats.size())
+    {
+        DcgmLockGuard lock(&m_gpuDataMutex);
+        m_gpuData[gpuId][name].push_back(data);
+        return DCGM_ST_OK;
+    }
+
+    PushPendingStat(m_pendingGpuStats[gpuId], new PendingStat { {}, name, data, nullptr });
     return DCGM_ST_OK;
 }
 
@@ -159,6 +222,7 @@ unsigned int CustomStatHolder::GpuIdToJsonStatsIndex(unsigned int gpuId)
 void CustomStatHolder::AddGpuDataToJson(Json::Value &jv)
 {
     DcgmLockGuard lock(&m_gpuDataMutex);
+    MergePendingGpuStats();
     for (auto mapMapIt = m_gpuData.begin(); mapMapIt != m_gpuData.end(); mapMapIt++)
     {
         unsigned int jsonIndex = GpuIdToJsonStatsIndex(mapMapIt->first);
@@ -186,6 +250,7 @@ void CustomStatHolder::AddNonTimeseriesDataToJson(Json::Value &jv)
 void CustomStatHolder::AddGroupedDataToJson(Json::Value &jv)
 {
     DcgmLockGuard lock(&m_groupedDataMutex);
+    MergePendingGroupedStats();
     for (auto gMapMapIt = m_groupedData.begin(); gMapMapIt != m_groupedData.end(); ++gMapMapIt)
     {
         std::string groupName = gMapMapIt->first;
@@ -201,6 +266,7 @@ std::vector<dcgmTimeseriesInfo_t> CustomStatHolder::GetGroupedStat(const std::st
                                                                    const std::string &name)
 {
     DcgmLockGuard lock(&m_groupedDataMutex);
+    MergePendingGroupedStats();
     return m_groupedData[groupName][name];
 }
 
@@ -411,6 +477,8 @@ void CustomStatHolder::PopulateCustomStats(dcgmDiagCustomStats_t &stats)
         DcgmLockGuard gpuDataLock(&m_gpuDataMutex);
         DcgmLockGuard groupedDataLock(&m_groupedDataMutex);
         DcgmLockGuard singleDataLock(&m_groupSingleDataMutex);
+        MergePendingGpuStats();
+        MergePendingGroupedStats();
         m_currentlyIterating  = true;
         m_gpuDataIter         = m_gpuData.begin();
         m_groupedDataIter     = m_groupedData.begin();
@@ -534,6 +602,53 @@ void CustomStatHolder::AddCustomData(Json::Value &jv)
     AddGroupedDataToJson(jv);
 }
 
+void CustomStatHolder::WriteCustomDataJsonLines(StatsJsonLinesWriter &writer)
+{
+    auto toJson = [](dcgmTimeseriesInfo_t const &data) {
+        return data.isInt ? Json::Value(static_cast<Json::Int64>(data.val.i64)) : Json::Value(data.val.fp64);
+    };
+
+    {
+        DcgmLockGuard lock(&m_gpuDataMutex);
+        MergePendingGpuStats();
+        for (auto const &[gpuId, stats] : m_gpuData)
+        {
+            unsigned int jsonIndex = GpuIdToJsonStatsIndex(gpuId);
+            for (auto const &[name, vec] : stats)
+            {
+                for (auto const &data : vec)
+                {
+                    writer.WriteGpuSample(jsonIndex, name, data.timestamp, toJson(data));
+                }
+            }
+        }
+    }
+
+    {
+        DcgmLockGuard lock(&m_groupSingleDataMutex);
+        for (auto const &[category, stats] : m_groupSingleData)
+        {
+            for (auto const &[name, value] : stats)
+            {
+                writer.WriteGroupString(category, name, value);
+            }
+        }
+    }
+
+    DcgmLockGuard lock(&m_groupedDataMutex);
+    MergePendingGroupedStats();
+    for (auto const &[groupName, stats] : m_groupedData)
+    {
+        for (auto const &[name, vec] : stats)
+        {
+            for (auto const &data : vec)
+            {
+                writer.WriteGroupSample(groupName, name, data.timestamp, toJson(data));
+            }
+        }
+    }
+}
+
 void CustomStatHolder::InitGpus(const std::vector<unsigned int> &gpus)
 {
     m_gpus = gpus;
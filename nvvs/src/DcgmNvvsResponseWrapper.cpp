@@ -20,6 +20,7 @@
 #include <DcgmStringHelpers.h>
 #include <GpuSet.h>
 #include <NvvsCommon.h>
+#include <NvvsJsonStrings.h>
 #include <PluginStrings.h>
 #include <ResultHelpers.h>
 #include <dcgm_errors.h>
@@ -45,6 +46,23 @@ inline void AddSystemErrorV11(dcgmDiagResponse_v11 &response, std::string const
     response.numErrors += 1;
 }
 
+/* auxData as compact JSON. The phase timings NVVS adds are dropped if they would not leave room for the rest */
+std::string SerializeAuxData(Json::Value auxData, size_t bufferSize)
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    std::string aux        = Json::writeString(builder, auxData);
+
+    if (aux.size() >= bufferSize && auxData.isObject() && auxData.isMember(NVVS_PHASE_TIMINGS))
+    {
+        log_debug("Dropping phase timings from aux data of {} bytes", aux.size());
+        auxData.removeMember(NVVS_PHASE_TIMINGS);
+        aux = Json::writeString(builder, auxData);
+    }
+
+    return aux;
+}
+
 bool ForAllGpus(dcgmGroupEntityPair_t const &entity)
 {
     return entity.entityGroupId == DCGM_FE_NONE && entity.entityId == 0;
@@ -648,10 +666,8 @@ dcgmReturn_t SetTestResult(std::string_view pluginName,
     {
         try
         {
-            auto auxData = std::any_cast<Json::Value>(*pluginSpecificData);
-            Json::StreamWriterBuilder builder;
-            builder["indentation"] = "";
-            std::string const aux  = Json::writeString(builder, auxData);
+            std::string const aux = SerializeAuxData(std::any_cast<Json::Value>(*pluginSpecificData),
+                                                     sizeof(diagResponse.tests[targetTest].auxData.data));
 
             diagResponse.tests[targetTest].auxData.version = dcgmDiagTestAuxData_version1;
             SafeCopyTo(diagResponse.tests[targetTest].auxData.data, aux.c_str());
@@ -789,10 +805,8 @@ void SetAuxFieldLegacy(std::string_view testName,
     {
         try
         {
-            auto auxData = std::any_cast<Json::Value>(*pluginSpecificData);
-            Json::StreamWriterBuilder builder;
-            builder["indentation"] = "";
-            std::string const aux  = Json::writeString(builder, auxData);
+            std::string const aux = SerializeAuxData(std::any_cast<Json::Value>(*pluginSpecificData),
+                                                     sizeof(diagResponse.auxDataPerTest[testIdx].data));
 
             diagResponse.auxDataPerTest[testIdx].version = dcgmDiagTestAuxData_version1;
             SafeCopyTo(diagResponse.auxDataPerTest[testIdx].data, aux.c_str());
@@ -1451,6 +1465,50 @@ dcgmReturn_t DcgmNvvsResponseWrapper::AddTestCategory(std::string_view testName,
     }
 }
 
+dcgmReturn_t DcgmNvvsResponseWrapper::GetTestCompletion(std::string_view testName,
+                                                        dcgmDiagTestCompletion_v1 &completion) const
+{
+    if (m_version != dcgmDiagResponse_version11)
+    {
+        // Older responses don't keep per-test errors and results
+        return DCGM_ST_NOT_SUPPORTED;
+    }
+
+    auto const &resp = ConstResponse<dcgmDiagResponse_v11>();
+    // The most recent run of the test is the one that just completed
+    for (unsigned int i = std::min(static_cast<unsigned int>(std::size(resp.tests)),
+                                   static_cast<unsigned int>(resp.numTests));
+         i > 0;
+         --i)
+    {
+        auto const &test = resp.tests[i - 1];
+        if (testName != test.name)
+        {
+            continue;
+        }
+
+        completion = {};
+        SafeCopyTo(completion.testName, test.name);
+        SafeCopyTo(completion.pluginName, test.pluginName);
+        completion.result = test.result;
+        for (unsigned int j = 0; j < std::min<unsigned int>(test.numErrors, DCGM_DIAG_TEST_RUN_ERROR_INDICES_MAX); ++j)
+        {
+            completion.errors[completion.numErrors++] = resp.errors[test.errorIndices[j]];
+        }
+        for (unsigned int j = 0; j < std::min<unsigned int>(test.numInfo, DCGM_DIAG_TEST_RUN_INFO_INDICES_MAX); ++j)
+        {
+            completion.info[completion.numInfo++] = resp.info[test.infoIndices[j]];
+        }
+        for (unsigned int j = 0; j < std::min<unsigned int>(test.numResults, DCGM_DIAG_TEST_RUN_RESULTS_MAX); ++j)
+        {
+            completion.results[completion.numResults++] = resp.results[test.resultIndices[j]];
+        }
+        return DCGM_ST_OK;
+    }
+
+    return DCGM_ST_NO_DATA;
+}
+
 bool DcgmNvvsResponseWrapper::IsVersionSet() const
 {
     return m_version != 0;
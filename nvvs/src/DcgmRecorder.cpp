@@ -62,6 +62,7 @@ DcgmRecorder::DcgmRecorder()
     , m_dcgmSystem()
     , m_valuesHolder()
     , m_nextValuesSinceTs(0)
+    , m_valuesHolderSinceTs(-1)
     , m_watchFrequency(defaultFrequency)
 
 {}
@@ -75,6 +76,7 @@ DcgmRecorder::DcgmRecorder(dcgmHandle_t handle)
     , m_dcgmSystem()
     , m_valuesHolder()
     , m_nextValuesSinceTs(0)
+    , m_valuesHolderSinceTs(-1)
     , m_watchFrequency(defaultFrequency)
 
 {
@@ -90,6 +92,7 @@ DcgmRecorder::DcgmRecorder(DcgmRecorder &&other) noexcept
     , m_dcgmSystem(other.m_dcgmSystem)
     , m_valuesHolder(other.m_valuesHolder)
     , m_nextValuesSinceTs(other.m_nextValuesSinceTs)
+    , m_valuesHolderSinceTs(other.m_valuesHolderSinceTs)
     , m_watchFrequency(other.m_watchFrequency)
 {}
 
@@ -269,27 +272,37 @@ dcgmReturn_t DcgmRecorder::GetFieldValuesSince(dcgm_field_entity_group_t /*entit
                                                long long ts,
                                                bool force)
 {
-    // Use the timestamp to prevent asking for something that we've already grabbed, unless force is true
-    if (force == true)
+    // Use the timestamp to prevent asking for something that we've already grabbed, unless force is true and
+    // we don't already hold everything since ts
+    if (force == true && ts != m_valuesHolderSinceTs)
     {
         m_valuesHolder.ClearCache();
+        m_valuesHolderSinceTs = ts;
     }
     else if (ts < m_nextValuesSinceTs)
     {
         ts = m_nextValuesSinceTs;
     }
+    else if (ts > m_nextValuesSinceTs)
+    {
+        // Skipping ahead leaves a gap
+        m_valuesHolderSinceTs = -1;
+    }
 
     dcgmReturn_t ret = m_dcgmGroup.GetValuesSince(ts, storeValues, &m_valuesHolder, &m_nextValuesSinceTs);
+    if (ret != DCGM_ST_OK)
+    {
+        m_valuesHolderSinceTs = -1;
+    }
 
     return ret;
 }
 
-std::string DcgmRecorder::GetWatchedFieldsAsJson(Json::Value &jv, long long ts)
+std::string DcgmRecorder::QueryWatchedFields(long long ts)
 {
     std::string errStr;
     dcgmReturn_t ret = DCGM_ST_OK;
 
-    // Make sure we have all of our values queried
     for (size_t i = 0; i < m_gpuIds.size(); i++)
     {
         for (size_t j = 0; j < m_fieldIds.size(); j++)
@@ -304,12 +317,70 @@ std::string DcgmRecorder::GetWatchedFieldsAsJson(Json::Value &jv, long long ts)
         }
     }
 
+    return errStr;
+}
+
+std::string DcgmRecorder::GetWatchedFieldsAsJson(Json::Value &jv, long long ts)
+{
+    // Make sure we have all of our values queried
+    std::string errStr = QueryWatchedFields(ts);
+    if (errStr.size() > 0)
+    {
+        return errStr;
+    }
+
     m_valuesHolder.AddToJson(jv);
     m_customStatHolder.AddCustomData(jv);
 
     return errStr;
 }
 
+std::string DcgmRecorder::WriteWatchedFieldsAsJsonLines(std::ostream &out, long long ts)
+{
+    std::string errStr = QueryWatchedFields(ts);
+    if (errStr.size() > 0)
+    {
+        return errStr;
+    }
+
+    // Written a line at a time instead of building the whole document first
+    StatsJsonLinesWriter writer(out);
+    m_valuesHolder.WriteJsonLines(writer);
+    m_customStatHolder.WriteCustomDataJsonLines(writer);
+
+    return errStr;
+}
+
+std::string DcgmRecorder::WriteWatchedFieldsAsJson(std::ostream &out, long long ts)
+{
+    std::string errStr = QueryWatchedFields(ts);
+    if (errStr.size() > 0)
+    {
+        return errStr;
+    }
+
+    // Plugins' custom stats are few, so they still go through a json object. The field samples are streamed
+    Json::Value custom;
+    m_customStatHolder.AddCustomData(custom);
+
+    DcgmNs::JsonSerialize::JsonWriter writer(out, true);
+    writer.StartObject();
+    writer.Key(GPUS);
+    m_valuesHolder.WriteJson(writer, custom[GPUS]);
+    for (auto it = custom.begin(); it != custom.end(); ++it)
+    {
+        if (it.name() != GPUS)
+        {
+            writer.Key(it.name());
+            writer.Value(*it);
+        }
+    }
+    writer.EndObject();
+    writer.Flush();
+
+    return errStr;
+}
+
 /*
  * GPUs Json is in the format:
  *
@@ -378,15 +449,20 @@ int DcgmRecorder::WriteToFile(const std::string &filename, int logFileType, long
             break;
         }
 
+        case NVVS_LOGFILE_TYPE_JSON_LINES:
+        {
+            std::string error = WriteWatchedFieldsAsJsonLines(f, testStart);
+            if (error.size() > 0)
+                f << error;
+
+            break;
+        }
+
         case NVVS_LOGFILE_TYPE_JSON:
         default:
         {
-            Json::Value jv;
-            std::string error = GetWatchedFieldsAsJson(jv, testStart);
-
-            if (error.size() == 0)
-                f << jv.toStyledString();
-            else
+            std::string error = WriteWatchedFieldsAsJson(f, testStart);
+            if (error.size() > 0)
                 f << error;
         }
 
@@ -798,13 +874,19 @@ dcgmReturn_t DcgmRecorder::CheckPerSecondErrorConditions(const std::vector<unsig
         return DCGM_ST_BADPARAM;
     }
 
+    // Make sure we have the timeseries data for these fields. This queries every watched field at once
+    dcgmReturn_t valuesSt = DCGM_ST_OK;
+    if (!fieldIds.empty())
+    {
+        valuesSt = GetFieldValuesSince(DCGM_FE_GPU, gpuId, fieldIds[0], startTime, true);
+    }
+
     for (size_t i = 0; i < fieldIds.size(); i++)
     {
         std::string tag;
         GetTagFromFieldId(fieldIds[i], tag);
 
-        // Make sure we have the timeseries data for these fields
-        st = GetFieldValuesSince(DCGM_FE_GPU, gpuId, fieldIds[i], startTime, true);
+        st = valuesSt;
 
         if (st == DCGM_ST_NOT_SUPPORTED)
         {
@@ -994,6 +1076,9 @@ int DcgmRecorder::GetLatestValuesForWatchedFields(unsigned int flags, std::vecto
 {
     dcgmReturn_t ret = m_dcgmSystem.GetLatestValuesForGpus(m_gpuIds, m_fieldIds, flags, storeValues, &m_valuesHolder);
 
+    // The latest values can be ahead of samples that a since query would still add
+    m_valuesHolderSinceTs = -1;
+
     if (ret != DCGM_ST_OK)
     {
         DcgmError d { DcgmError::GpuIdTag::Unknown };
@@ -1162,6 +1247,114 @@ std::vector<DcgmError> DcgmRecorder::CheckCommonErrors(TestParameters &tp,
     return errors;
 }
 
+bool DcgmRecorder::MayHaveCommonErrors(TestParameters &tp,
+                                       timelib64_t startTime,
+                                       std::vector<dcgmDiagPluginEntityInfo_v1> const &entityInfos,
+                                       CommonErrorsScreen &screen)
+{
+    std::vector<unsigned short> fieldIds { DCGM_FI_DEV_GPU_TEMP };
+    std::map<unsigned short, long long> thresholds;
+
+    for (unsigned int i = 0; standardErrorFields[i].fieldId != 0; i++)
+    {
+        if (standardErrorFields[i].thresholdName == nullptr)
+        {
+            fieldIds.push_back(standardErrorFields[i].fieldId);
+            thresholds[standardErrorFields[i].fieldId] = 0;
+        }
+        else if (tp.HasKey(standardErrorFields[i].thresholdName))
+        {
+            fieldIds.push_back(standardErrorFields[i].fieldId);
+            thresholds[standardErrorFields[i].fieldId] = tp.GetDouble(standardErrorFields[i].thresholdName);
+        }
+    }
+
+    std::vector<unsigned int> gpuIds;
+    for (auto const &entityInfo : entityInfos)
+    {
+        if (entityInfo.entity.entityGroupId != DCGM_FE_GPU)
+        {
+            continue;
+        }
+        gpuIds.push_back(entityInfo.entity.entityId);
+        if (!screen.maxTemps.contains(entityInfo.entity.entityId))
+        {
+            screen.maxTemps[entityInfo.entity.entityId] = DetermineMaxTemp(entityInfo);
+        }
+    }
+
+    if (gpuIds.empty())
+    {
+        return false;
+    }
+
+    std::vector<dcgmFieldValue_v2> values;
+    if (m_dcgmSystem.GetLatestValuesForGpus(gpuIds, fieldIds, 0, values) != DCGM_ST_OK)
+    {
+        // Let CheckCommonErrors() report why the values can't be read
+        return true;
+    }
+
+    for (auto const &value : values)
+    {
+        if (value.status != DCGM_ST_OK || value.fieldType != DCGM_FT_INT64 || DCGM_INT64_IS_BLANK(value.value.i64)
+            || value.ts < startTime)
+        {
+            // CheckCommonErrors() only looks at samples since startTime, and only fails int64 fields here
+            continue;
+        }
+
+        if (value.fieldId == DCGM_FI_DEV_GPU_TEMP)
+        {
+            if (value.value.i64 > screen.maxTemps[value.entityId])
+            {
+                return true;
+            }
+            continue;
+        }
+
+        if (value.fieldId == DCGM_FI_DEV_XID_ERRORS)
+        {
+            // Any XID since startTime
+            return true;
+        }
+
+        long long checked = value.value.i64;
+        if (GetValueIndex(value.fieldId) == 2)
+        {
+            // Checked by its difference since startTime, i.e. against the first sample since then
+            auto const key = std::make_pair(value.entityId, value.fieldId);
+            auto it        = screen.firstValues.find(key);
+            if (it == screen.firstValues.end())
+            {
+                int count               = 1;
+                dcgmFieldValue_v1 first = {};
+                dcgmReturn_t ret        = dcgmGetMultipleValuesForField(m_dcgmHandle.GetHandle(),
+                                                                        value.entityId,
+                                                                        value.fieldId,
+                                                                        &count,
+                                                                        startTime,
+                                                                        0,
+                                                                        DCGM_ORDER_ASCENDING,
+                                                                        &first);
+                if (ret != DCGM_ST_OK || count != 1 || DCGM_INT64_IS_BLANK(first.value.i64))
+                {
+                    return true;
+                }
+                it = screen.firstValues.emplace(key, first.value.i64).first;
+            }
+            checked -= it->second;
+        }
+
+        if (checked > thresholds[value.fieldId])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 std::string DcgmRecorder::ErrorAsString(dcgmReturn_t ret)
 {
     const char *str = errorString(ret);
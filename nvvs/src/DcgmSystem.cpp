@@ -161,8 +161,7 @@ dcgmReturn_t DcgmSystem::GetGpuLatestValue(unsigned int gpuId,
 dcgmReturn_t DcgmSystem::GetLatestValuesForGpus(const std::vector<unsigned int> &gpuIds,
                                                 std::vector<unsigned short> &fieldIds,
                                                 unsigned int flags,
-                                                dcgmFieldValueEntityEnumeration_f checker,
-                                                void *userData)
+                                                std::vector<dcgmFieldValue_v2> &values)
 {
     if (m_handle == 0)
     {
@@ -174,8 +173,8 @@ dcgmReturn_t DcgmSystem::GetLatestValuesForGpus(const std::vector<unsigned int>
     unsigned int fieldCount  = fieldIds.size();
     unsigned int numValues   = entityCount * fieldCount;
     std::vector<dcgmGroupEntityPair_t> entities;
-    std::vector<dcgmFieldValue_v2> values;
 
+    values.clear();
     entities.reserve(entityCount);
     values.resize(numValues);
     memset(values.data(), 0, sizeof(dcgmFieldValue_v2) * numValues);
@@ -194,10 +193,28 @@ dcgmReturn_t DcgmSystem::GetLatestValuesForGpus(const std::vector<unsigned int>
     if (ret != DCGM_ST_OK)
     {
         log_error("Failed to retrieve the latest values from DCGM: '{}'", errorString(ret));
+        values.clear();
+    }
+
+    return ret;
+}
+
+dcgmReturn_t DcgmSystem::GetLatestValuesForGpus(const std::vector<unsigned int> &gpuIds,
+                                                std::vector<unsigned short> &fieldIds,
+                                                unsigned int flags,
+                                                dcgmFieldValueEntityEnumeration_f checker,
+                                                void *userData)
+{
+    std::vector<dcgmFieldValue_v2> values;
+
+    dcgmReturn_t ret = GetLatestValuesForGpus(gpuIds, fieldIds, flags, values);
+
+    if (ret != DCGM_ST_OK)
+    {
         return ret;
     }
 
-    for (unsigned int i = 0; i < numValues; i++)
+    for (unsigned int i = 0; i < values.size(); i++)
     {
         // Create a copy of the value since the call back function expects dcgmFieldValue_v1
         dcgmFieldValue_v1 val_copy {};
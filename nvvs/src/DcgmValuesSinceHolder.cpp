@@ -17,6 +17,7 @@
 #include "DcgmError.h"
 #include "DcgmRecorder.h"
 
+#include <algorithm>
 #include <sstream>
 
 DcgmEntityTimeSeries::DcgmEntityTimeSeries() = default;
@@ -30,6 +31,7 @@ DcgmEntityTimeSeries::DcgmEntityTimeSeries(
     const DcgmEntityTimeSeries &other)
     : m_entityId(other.m_entityId)
     , m_fieldValueTimeSeries(other.m_fieldValueTimeSeries)
+    , m_fieldStates(other.m_fieldStates)
 {}
 
 DcgmEntityTimeSeries &DcgmEntityTimeSeries::operator=(const DcgmEntityTimeSeries &ets)
@@ -38,6 +40,7 @@ DcgmEntityTimeSeries &DcgmEntityTimeSeries::operator=(const DcgmEntityTimeSeries
     {
         m_entityId             = ets.m_entityId;
         m_fieldValueTimeSeries = ets.m_fieldValueTimeSeries;
+        m_fieldStates          = ets.m_fieldStates;
     }
     return *this;
 }
@@ -65,11 +68,65 @@ void DcgmEntityTimeSeries::AddValue(dcgm_field_entity_group_t entityGroupId,
         return;
     }
     m_fieldValueTimeSeries[fieldId].SetGrowExponentially(true);
-    auto const *ptr = m_fieldValueTimeSeries[fieldId].AddFV1Value(entityGroupId, entityId, &val);
+    auto *ptr = m_fieldValueTimeSeries[fieldId].AddFV1Value(entityGroupId, entityId, &val);
     if (ptr != nullptr)
     {
         AddValueToCache(fieldId, val);
+
+        /* Use the stored copy so what the state hands back matches what a walk of the buffer would */
+        dcgmFieldValue_v1 stored {};
+        DcgmFvBuffer::ConvertBufferedFvToFv1(ptr, &stored);
+        m_fieldStates[fieldId].Update(stored);
+    }
+}
+
+void DcgmEntityTimeSeries::FieldState::Update(dcgmFieldValue_v1 const &value)
+{
+    switch (value.fieldType)
+    {
+        case DCGM_FT_DOUBLE:
+            if (!hasFirstNonZero && value.value.dbl != 0.0 && !DCGM_FP64_IS_BLANK(value.value.dbl))
+            {
+                hasFirstNonZero = true;
+                firstNonZero    = value;
+            }
+            break;
+
+        case DCGM_FT_INT64:
+            if (!hasFirstNonZero && value.value.i64 != 0 && !DCGM_INT64_IS_BLANK(value.value.i64))
+            {
+                hasFirstNonZero = true;
+                firstNonZero    = value;
+            }
+            if (!DCGM_INT64_IS_BLANK(value.value.i64) && (value.value.i64 & ~seenBits) != 0)
+            {
+                seenBits |= value.value.i64;
+                newBits.push_back(value);
+            }
+            break;
+
+        default:
+            /* Not numeric. Nothing to check */
+            return;
+    }
+
+    if (hasPrev)
+    {
+        int64_t const i64Delta = value.value.i64 - prev.value.i64;
+        if (i64DeltaRecords.empty() || i64Delta > i64DeltaRecords.back().second)
+        {
+            i64DeltaRecords.emplace_back(value.ts, i64Delta);
+        }
+
+        double const dblDelta = value.value.dbl - prev.value.dbl;
+        if (dblDeltaRecords.empty() || dblDelta > dblDeltaRecords.back().second)
+        {
+            dblDeltaRecords.emplace_back(value.ts, dblDelta);
+        }
     }
+
+    hasPrev = true;
+    prev    = value;
 }
 
 bool DcgmEntityTimeSeries::IsFieldStored(unsigned short fieldId) const
@@ -79,41 +136,31 @@ bool DcgmEntityTimeSeries::IsFieldStored(unsigned short fieldId) const
 
 void DcgmEntityTimeSeries::GetFirstNonZero(unsigned short fieldId, dcgmFieldValue_v1 &dfv, uint64_t mask)
 {
-    DcgmFvBuffer &fvBuffer = m_fieldValueTimeSeries[fieldId];
-
-    size_t bufferSize   = 0;
-    size_t elementCount = 0;
-    fvBuffer.GetSize(&bufferSize, &elementCount);
+    auto it = m_fieldStates.find(fieldId);
+    if (it == m_fieldStates.end())
+    {
+        return;
+    }
 
-    dcgmBufferedFvCursor_t fvCursor = 0;
+    FieldState const &state = it->second;
 
-    for (auto *fv = fvBuffer.GetNextFv(&fvCursor); fv != nullptr; fv = fvBuffer.GetNextFv(&fvCursor))
+    // The mask only applies to int64 values
+    if (mask == 0 || (state.hasFirstNonZero && state.firstNonZero.fieldType == DCGM_FT_DOUBLE))
     {
-        switch (fv->fieldType)
+        if (state.hasFirstNonZero)
         {
-            case DCGM_FT_DOUBLE:
-                if (fv->value.dbl != 0.0 && !DCGM_FP64_IS_BLANK(fv->value.dbl))
-                {
-                    DcgmFvBuffer::ConvertBufferedFvToFv1(fv, &dfv);
-                    return;
-                }
-                break;
-            case DCGM_FT_INT64:
-                // Ignore values that are 0 after applying the mask
-                if (mask != 0 && (fv->value.i64 & mask) == 0)
-                {
-                    continue;
-                }
+            dfv = state.firstNonZero;
+        }
+        return;
+    }
 
-                if (fv->value.i64 != 0 && !DCGM_INT64_IS_BLANK(fv->value.i64))
-                {
-                    DcgmFvBuffer::ConvertBufferedFvToFv1(fv, &dfv);
-                    return;
-                }
-                break;
-            default:
-                // Unsupported type, return immediately
-                return;
+    // The first value with a bit in the mask is the first to set one of those bits
+    for (auto const &value : state.newBits)
+    {
+        if ((value.value.i64 & mask) != 0)
+        {
+            dfv = value;
+            return;
         }
     }
 }
@@ -160,6 +207,102 @@ void DcgmEntityTimeSeries::AddToJson(Json::Value &jv, unsigned int jsonIndex)
     }
 }
 
+void DcgmEntityTimeSeries::WriteJsonLines(StatsJsonLinesWriter &writer, unsigned int jsonIndex)
+{
+    writer.WriteGpu(jsonIndex, m_entityId);
+    for (auto &iter : m_fieldValueTimeSeries)
+    {
+        std::string tag;
+        DcgmRecorder::GetTagFromFieldId(iter.first, tag);
+
+        writer.WriteGpuStat(jsonIndex, tag);
+
+        dcgmBufferedFvCursor_t fvCursor = 0;
+
+        for (auto const *fv = iter.second.GetNextFv(&fvCursor); fv != nullptr; fv = iter.second.GetNextFv(&fvCursor))
+        {
+            switch (fv->fieldType)
+            {
+                case DCGM_FT_INT64:
+                    writer.WriteGpuSample(jsonIndex, tag, fv->timestamp, static_cast<Json::Int64>(fv->value.i64));
+                    break;
+
+                case DCGM_FT_DOUBLE:
+                    writer.WriteGpuSample(jsonIndex, tag, fv->timestamp, fv->value.dbl);
+                    break;
+
+                default:
+                    log_debug("Unsupported field type {} for field {}", fv->fieldType, iter.first);
+                    break;
+            }
+        }
+    }
+}
+
+void DcgmEntityTimeSeries::WriteJson(DcgmNs::JsonSerialize::JsonWriter &writer, Json::Value const &custom)
+{
+    std::vector<std::string> tags;
+
+    writer.StartObject();
+    writer.Key("gpuId");
+    writer.Uint(m_entityId);
+    for (auto &iter : m_fieldValueTimeSeries)
+    {
+        std::string &tag = tags.emplace_back();
+        DcgmRecorder::GetTagFromFieldId(iter.first, tag);
+
+        writer.Key(tag);
+        writer.StartArray();
+
+        dcgmBufferedFvCursor_t fvCursor = 0;
+
+        for (auto const *fv = iter.second.GetNextFv(&fvCursor); fv != nullptr; fv = iter.second.GetNextFv(&fvCursor))
+        {
+            switch (fv->fieldType)
+            {
+                case DCGM_FT_INT64:
+                    writer.StartObject();
+                    writer.Key("timestamp");
+                    writer.Int(fv->timestamp);
+                    writer.Key("value");
+                    writer.Int(fv->value.i64);
+                    writer.EndObject();
+                    break;
+
+                case DCGM_FT_DOUBLE:
+                    writer.StartObject();
+                    writer.Key("timestamp");
+                    writer.Int(fv->timestamp);
+                    writer.Key("value");
+                    writer.Double(fv->value.dbl);
+                    writer.EndObject();
+                    break;
+
+                default:
+                    log_debug("Unsupported field type {} for field {}", fv->fieldType, iter.first);
+                    break;
+            }
+        }
+
+        for (auto const &entry : custom[tag])
+        {
+            writer.Value(entry);
+        }
+        writer.EndArray();
+    }
+
+    for (auto it = custom.begin(); it != custom.end(); ++it)
+    {
+        std::string const name = it.name();
+        if (name != "gpuId" && std::find(tags.begin(), tags.end(), name) == tags.end())
+        {
+            writer.Key(name);
+            writer.Value(*it);
+        }
+    }
+    writer.EndObject();
+}
+
 bool DcgmEntityTimeSeries::IsValueInCache(unsigned short fieldId, const dcgmFieldValue_v1 &value)
 {
     auto iter = m_seenTimestamps.find(fieldId);
@@ -207,6 +350,7 @@ void DcgmValuesSinceHolder::ClearEntries(dcgm_field_entity_group_t entityGroupId
                                          unsigned short fieldId)
 {
     m_values[entityGroupId][entityId].m_fieldValueTimeSeries.erase(fieldId);
+    m_values[entityGroupId][entityId].m_fieldStates.erase(fieldId);
 }
 
 void DcgmValuesSinceHolder::ClearCache()
@@ -231,6 +375,44 @@ void DcgmValuesSinceHolder::AddToJson(Json::Value &jv)
     }
 }
 
+void DcgmValuesSinceHolder::WriteJsonLines(StatsJsonLinesWriter &writer)
+{
+    unsigned int jsonIndex = 0;
+
+    for (auto &m_value : m_values)
+    {
+        for (auto &entityIter : m_value.second)
+        {
+            entityIter.second.m_entityId = entityIter.first; // Make sure the entity id is set
+            entityIter.second.WriteJsonLines(writer, jsonIndex);
+            jsonIndex++;
+        }
+    }
+}
+
+void DcgmValuesSinceHolder::WriteJson(DcgmNs::JsonSerialize::JsonWriter &writer, Json::Value const &customGpus)
+{
+    unsigned int jsonIndex = 0;
+
+    writer.StartArray();
+    for (auto &m_value : m_values)
+    {
+        for (auto &entityIter : m_value.second)
+        {
+            entityIter.second.m_entityId = entityIter.first; // Make sure the entity id is set
+            entityIter.second.WriteJson(writer, customGpus[jsonIndex]);
+            jsonIndex++;
+        }
+    }
+
+    // GPUs that only have custom stats
+    for (; jsonIndex < customGpus.size(); jsonIndex++)
+    {
+        writer.Value(customGpus[jsonIndex]);
+    }
+    writer.EndArray();
+}
+
 bool DcgmValuesSinceHolder::DoesValuePassPerSecondThreshold(unsigned short fieldId,
                                                             const dcgmFieldValue_v1 &dfv,
                                                             unsigned int gpuId,
@@ -238,60 +420,50 @@ bool DcgmValuesSinceHolder::DoesValuePassPerSecondThreshold(unsigned short field
                                                             std::vector<DcgmError> &errorList,
                                                             timelib64_t startTime)
 {
-    DcgmFvBuffer &values = m_values[DCGM_FE_GPU][gpuId].m_fieldValueTimeSeries[fieldId];
-
-    size_t bufferSize   = 0;
-    size_t elementCount = 0;
-    values.GetSize(&bufferSize, &elementCount);
-
-    dcgmBufferedFvCursor_t fvCursor = 0;
-    dcgmBufferedFv_t const *prevFv  = nullptr;
-
-    /* We're doing differences so skip the first element and set it to previous */
-    prevFv = values.GetNextFv(&fvCursor);
+    DcgmEntityTimeSeries &timeSeries = m_values[DCGM_FE_GPU][gpuId];
+    auto it                          = timeSeries.m_fieldStates.find(fieldId);
+    if (it == timeSeries.m_fieldStates.end())
+    {
+        return false;
+    }
 
-    for (auto const *fv = values.GetNextFv(&fvCursor); fv != nullptr; prevFv = fv, fv = values.GetNextFv(&fvCursor))
+    // These values are watched with a refresh of once per second, so comparing with the previous value
+    // should be sufficient. The first difference at or above the threshold is one of the record differences.
+    switch (dfv.fieldType)
     {
-        // These values are watched with a refresh of once per second, so comparing with the previous value
-        // should be sufficient.
-        switch (dfv.fieldType)
-        {
-            case DCGM_FT_DOUBLE:
+        case DCGM_FT_DOUBLE:
+            for (auto const &[timestamp, delta] : it->second.dblDeltaRecords)
             {
-                // coverity[dereference] - if prevFv is nullptr, fv should be nullptr and the loop shouldn't be entered
-                double delta = fv->value.dbl - prevFv->value.dbl;
                 if (delta >= dfv.value.dbl)
                 {
-                    double timeDelta = double(fv->timestamp - startTime) / 1000000.0;
+                    double timeDelta = double(timestamp - startTime) / 1000000.0;
                     DcgmError d { gpuId };
                     DCGM_ERROR_FORMAT_MESSAGE(
                         DCGM_FR_FIELD_THRESHOLD_TS_DBL, d, fieldName, dfv.value.dbl, delta, timeDelta);
                     errorList.push_back(d);
                     return true;
                 }
-                break;
             }
+            break;
 
-            case DCGM_FT_INT64:
+        case DCGM_FT_INT64:
+            for (auto const &[timestamp, delta] : it->second.i64DeltaRecords)
             {
-                // coverity[dereference] - if prevFv is nullptr, fv should be nullptr and the loop shouldn't be entered
-                int64_t delta = fv->value.i64 - prevFv->value.i64;
                 if (delta >= dfv.value.i64)
                 {
-                    double timeDelta = double(fv->timestamp - startTime) / 1000000.0;
+                    double timeDelta = double(timestamp - startTime) / 1000000.0;
                     DcgmError d { gpuId };
                     DCGM_ERROR_FORMAT_MESSAGE(
                         DCGM_FR_FIELD_THRESHOLD_TS, d, fieldName, dfv.value.i64, delta, timeDelta);
                     errorList.push_back(d);
                     return true;
                 }
-                break;
             }
+            break;
 
-            default:
-                log_debug("Unsupported field type {} for field {}", dfv.fieldType, fieldId);
-                continue;
-        }
+        default:
+            log_debug("Unsupported field type {} for field {}", dfv.fieldType, fieldId);
+            break;
     }
 
     return false;
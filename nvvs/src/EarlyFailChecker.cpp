@@ -48,7 +48,15 @@ nvvsPluginResult_t EarlyFailChecker::CheckCommonErrors(unsigned long checkTime,
     if (checkTime - m_lastCheckTime > m_failCheckInterval)
     {
         m_lastCheckTime = checkTime;
-        m_errors        = dcgmRecorder.CheckCommonErrors(*m_testParameters, startTime, result, m_entityInfos);
+
+        /* Scanning the history since startTime gets slower the longer the test runs. Only do it once the latest values
+           show that there may be an error */
+        if (!dcgmRecorder.MayHaveCommonErrors(*m_testParameters, startTime, m_entityInfos, m_screen))
+        {
+            return result;
+        }
+
+        m_errors = dcgmRecorder.CheckCommonErrors(*m_testParameters, startTime, result, m_entityInfos);
         if (result == NVVS_RESULT_FAIL)
         {
             std::stringstream buf;
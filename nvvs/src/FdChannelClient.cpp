@@ -16,6 +16,13 @@
 
 #include <FdChannelClient.h>
 
+#include <dcgm_structs_internal.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 FdChannelClient::FdChannelClient(int const channelFd)
     : m_channelFd(channelFd)
 {}
@@ -44,3 +51,40 @@ std::error_code FdChannelClient::WriteAll(std::span<char const> buf) const
     }
     return {};
 }
+
+bool FdChannelClient::WriteResponse(std::span<char const> response, int const responseFd) const
+{
+    if (responseFd == -1)
+    {
+        return Write(response);
+    }
+
+    /* Only trust a region that can't shrink under us while it's mapped */
+    int const seals = fcntl(responseFd, F_GET_SEALS);
+    struct stat st {};
+    if (seals == -1 || !(seals & F_SEAL_SHRINK) || fstat(responseFd, &st) != 0 || response.size() < sizeof(unsigned int)
+        || st.st_size < static_cast<off_t>(response.size()))
+    {
+        log_error("response fd {} can't hold a response of {} bytes. Writing it to the channel instead.",
+                  responseFd,
+                  response.size());
+        return Write(response);
+    }
+
+    void *region = mmap(nullptr, response.size(), PROT_READ | PROT_WRITE, MAP_SHARED, responseFd, 0);
+    if (region == MAP_FAILED)
+    {
+        log_error("failed to map response fd {}: {}. Writing the response to the channel instead.",
+                  responseFd,
+                  strerror(errno));
+        return Write(response);
+    }
+    memcpy(region, response.data(), response.size());
+    munmap(region, response.size());
+
+    dcgmDiagResponseReady_v1 ready {};
+    ready.version = dcgmDiagResponseReady_version1;
+    memcpy(&ready.responseVersion, response.data(), sizeof(ready.responseVersion));
+    ready.responseSize = response.size();
+    return Write({ reinterpret_cast<char const *>(&ready), sizeof(ready) });
+}
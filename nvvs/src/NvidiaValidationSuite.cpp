@@ -335,6 +335,8 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
         DCGM_LOG_DEBUG << "argc: " << argc << ". argv: " << out.str();
     }
 
+    /* Before any plugin initializes CUDA and JIT-compiles its kernels */
+    DcgmNs::Utils::EnsureWritableCudaJitCache();
 
     parser = new ConfigFileParser_v2("", fwcfg);
 
@@ -356,7 +358,11 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
     }
     */
 
-    dcgmReturn_t ret = dcgmHandle.ConnectToDcgm(nvvsCommon.dcgmHostname);
+    dcgmReturn_t ret;
+    {
+        PhaseTimings::Scope timed(m_phaseTimings, "connect");
+        ret = dcgmHandle.ConnectToDcgm(nvvsCommon.dcgmHostname);
+    }
     if (ret != DCGM_ST_OK)
     {
         std::stringstream buf;
@@ -368,6 +374,7 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
     stopTimer();
     */
 
+    auto const configStart = PhaseTimings::Clock::now();
     if (configFile.size() > 0)
         parser->setConfigFile(configFile);
     if (!parser->Init() && !nvvsCommon.configless)
@@ -394,9 +401,11 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
 
     parser->PrepareEntitySets(dcgmHandle.GetHandle());
     parser->legacyGlobalStructHelper();
+    m_phaseTimings.Add("config_parse", PhaseTimings::Clock::now() - configStart);
 
     std::vector<std::unique_ptr<EntitySet>> &entitySets = parser->GetEntitySets();
     bool hasGpuEntity                                   = false;
+    auto const gpuInitStart                             = PhaseTimings::Clock::now();
 
     for (size_t i = 0; i < entitySets.size(); i++)
     {
@@ -423,6 +432,7 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
         }
         InitializeAndCheckGpuObjs(gpuSet);
     }
+    m_phaseTimings.Add("gpu_init", PhaseTimings::Clock::now() - gpuInitStart);
 
     if (listGpus)
     {
@@ -449,7 +459,10 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
     }
 
     m_tf = new TestFramework(entitySets);
-    m_tf->loadPlugins();
+    {
+        PhaseTimings::Scope timed(m_phaseTimings, "plugin_load");
+        m_tf->loadPlugins();
+    }
     if (auto ret = m_tf->SetDiagResponseVersion(nvvsCommon.diagResponseVersion); ret != DCGM_ST_OK)
     {
         std::string const errMsg
@@ -476,6 +489,7 @@ std::string NvidiaValidationSuite::Go(int argc, char *argv[])
     }
 
     DistributeTests(entitySets);
+    m_tf->SetSuiteTimings(m_phaseTimings);
 
     // Execute the tests... let the TF catch all exceptions and decide
     // whether to throw them higher.
@@ -1257,6 +1271,12 @@ void NvidiaValidationSuite::processCommandLine(int argc, char *argv[])
             "t", "listTests", "List the tests available to be executed through NVVS.", cmd, false);
         TCLAP::SwitchArg statsOnFailArg(
             "", "statsonfail", "Output statistic logs only if a test failure is encountered.", cmd, false);
+        TCLAP::SwitchArg statsJsonLinesArg(
+            "",
+            "stats-json-lines",
+            "Write statistic logs as JSON Lines, one sample per line, instead of as a single JSON document.",
+            cmd,
+            false);
         TCLAP::ValueArg<std::string> hwdiaglogfileArg(
             "",
             "hwdiaglogfile",
@@ -1404,6 +1424,13 @@ void NvidiaValidationSuite::processCommandLine(int argc, char *argv[])
             "", "entity-id", " Comma-separated list of entities to run the diag on.", false, "", "entityId", cmd);
         TCLAP::ValueArg<int> channelFd(
             "", "channel-fd", "A file description used to send back response to caller.", false, -1, "channel fd", cmd);
+        TCLAP::ValueArg<int> responseFd("",
+                                        "response-fd",
+                                        "A shared memory region to write the diag response to instead of channel-fd.",
+                                        false,
+                                        -1,
+                                        "response fd",
+                                        cmd);
         TCLAP::ValueArg<unsigned int> responseVersion("",
                                                       "response-version",
                                                       "The version of diag response to be returned via channel-fd.",
@@ -1446,6 +1473,10 @@ void NvidiaValidationSuite::processCommandLine(int argc, char *argv[])
         nvvsCommon.configless          = configLessArg.getValue();
         nvvsCommon.fakegpusString      = fakeGpusArg.getValue();
         nvvsCommon.statsOnlyOnFail     = statsOnFailArg.getValue();
+        if (statsJsonLinesArg.getValue())
+        {
+            nvvsCommon.logFileType = NVVS_LOGFILE_TYPE_JSON_LINES;
+        }
         nvvsCommon.indexString         = indexArg.getValue();
         nvvsCommon.parmsString         = parms.getValue();
         nvvsCommon.dcgmHostname        = dcgmHost.getValue();
@@ -1453,6 +1484,7 @@ void NvidiaValidationSuite::processCommandLine(int argc, char *argv[])
         nvvsCommon.totalIterations     = totalIterations.getValue();
         nvvsCommon.entityIds           = entityIds.getValue();
         nvvsCommon.channelFd           = channelFd.getValue();
+        nvvsCommon.responseFd          = responseFd.getValue();
         nvvsCommon.diagResponseVersion = responseVersion.getValue();
         nvvsCommon.rerunAsRoot         = rerunAsRoot.isSet();
         nvvsCommon.SetStatsPath(statsPathArg.getValue());
@@ -53,6 +53,7 @@ NvvsCommon::NvvsCommon()
     , currentIteration(0)
     , totalIterations(1)
     , channelFd(-1)
+    , responseFd(-1)
     , diagResponseVersion(dcgmDiagResponse_version11)
     , rerunAsRoot(false)
     , watchFrequency(DEFAULT_WATCH_FREQUENCY_IN_MICROSECONDS)
@@ -85,6 +86,7 @@ NvvsCommon::NvvsCommon(const NvvsCommon &other)
     , currentIteration(other.currentIteration)
     , totalIterations(other.totalIterations)
     , channelFd(other.channelFd)
+    , responseFd(other.responseFd)
     , diagResponseVersion(other.diagResponseVersion)
     , rerunAsRoot(other.rerunAsRoot)
     , watchFrequency(other.watchFrequency)
@@ -118,6 +120,7 @@ NvvsCommon &NvvsCommon::operator=(const NvvsCommon &other)
     currentIteration       = other.currentIteration;
     totalIterations        = other.totalIterations;
     channelFd              = other.channelFd;
+    responseFd             = other.responseFd;
     diagResponseVersion    = other.diagResponseVersion;
     rerunAsRoot            = other.rerunAsRoot;
     watchFrequency         = other.watchFrequency;
@@ -153,6 +156,7 @@ void NvvsCommon::Init()
     currentIteration      = 0;
     totalIterations       = 1;
     channelFd             = -1;
+    responseFd            = -1;
     watchFrequency        = DEFAULT_WATCH_FREQUENCY_IN_MICROSECONDS;
 }
 
@@ -17,21 +17,36 @@
 #include "NvidiaValidationSuite.h"
 #include "NvvsCommon.h"
 #include "Plugin.h"
+#include "PluginLib.h"
 #include <DcgmBuildInfo.hpp>
 #include <DcgmNvvsResponseWrapper.h>
 #include <FdChannelClient.h>
 #include <NvvsException.hpp>
 #include <NvvsExitCode.h>
 #include <dcgm_structs.h>
+#include <dcgm_structs_internal.h>
 
+#include <atomic>
+#include <charconv>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
 
 namespace
 {
 const size_t SUCCESS                   = 0;
 const size_t ERROR_IN_COMMAND_LINE     = 1;
 const size_t ERROR_UNHANDLED_EXCEPTION = 2;
+
+/* Largest run request a worker accepts */
+const std::uint32_t MAX_WORKER_REQUEST_SIZE = 1024 * 1024;
+
+/* Set by the signal handler. Unlike main_should_stop, it isn't reset between runs of a worker */
+std::atomic_bool workerShouldStop = false;
 } // namespace
 
 using namespace DcgmNs::Nvvs;
@@ -47,6 +62,7 @@ static void main_sig_handler(int signo)
         case SIGKILL:
         case SIGTERM:
             main_should_stop.store(1);
+            workerShouldStop.store(true);
             nvvsCommon.mainReturnCode = NVVS_ST_SUCCESS; /* Still counts as an error */
             break;
 
@@ -85,7 +101,8 @@ void OutputMainError(const std::string &error, nvvsReturn_t errorCode = NVVS_ST_
     }
     else
     {
-        if (!FdChannelClient(nvvsCommon.channelFd).Write(diagResponse.RawBinaryBlob()))
+        if (!FdChannelClient(nvvsCommon.channelFd)
+                 .WriteResponse(diagResponse.RawBinaryBlob(), nvvsCommon.responseFd))
         {
             log_error("failed to write diag response to caller.");
         }
@@ -96,21 +113,11 @@ void OutputMainError(const std::string &error, nvvsReturn_t errorCode = NVVS_ST_
 }
 
 /*****************************************************************************/
-int main(int argc, char **argv)
+/* Run the diag described by argv, like a standalone nvvs would */
+static void RunNvvs(int argc, char **argv)
 {
     std::unique_ptr<NvidiaValidationSuite> nvvs;
 
-    struct sigaction sigHandler = {};
-
-    sigHandler.sa_handler = main_sig_handler;
-    sigemptyset(&sigHandler.sa_mask);
-    sigHandler.sa_flags       = 0;
-    nvvsCommon.mainReturnCode = NVVS_ST_SUCCESS; /* Set by NvidiaValidationSuite constructor, but not until later */
-
-    /* Install signal handlers */
-    sigaction(SIGINT, &sigHandler, nullptr);
-    sigaction(SIGTERM, &sigHandler, nullptr);
-
     try
     {
         // declare new NVVS object
@@ -136,6 +143,132 @@ int main(int argc, char **argv)
         OutputMainError(e.what());
         nvvsCommon.mainReturnCode = NVVS_ST_SUCCESS;
     }
+}
+
+/*****************************************************************************/
+/* Get the value of "name <fd>" from the command line, if it's there */
+static std::optional<int> GetFdArg(int argc, char **argv, std::string_view name)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        int fd                = -1;
+        std::string_view text = argv[i + 1];
+        if (argv[i] == name && std::from_chars(text.data(), text.data() + text.size(), fd).ec == std::errc())
+        {
+            return fd;
+        }
+    }
+    return std::nullopt;
+}
+
+/*****************************************************************************/
+/* Read exactly size bytes from fd. Returns false at the end of the stream, on error or when asked to stop */
+static bool ReadAll(int fd, char *buf, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t const bytesRead = read(fd, buf, size);
+        if (bytesRead > 0)
+        {
+            buf += bytesRead;
+            size -= bytesRead;
+            continue;
+        }
+        if (bytesRead < 0 && errno == EINTR && !workerShouldStop)
+        {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/*
+ * Serve run requests from requestFd until it's closed or we're signaled to stop.
+ *
+ * A request is a 32-bit length followed by that many bytes of command line arguments, each terminated by '\0'.
+ * Each request is run like a standalone nvvs run with those arguments would be, then a dcgmNvvsRunDone_v1
+ * frame is written to channelFd. The plugin libraries and the packaged configuration stay loaded
+ * between runs.
+ */
+static int RunWorker(char *programName, int requestFd, int channelFd)
+{
+    std::vector<char> request;
+
+    PluginLib::SetKeepLoaded(true);
+    log_debug("NVVS worker waiting for requests on fd {}", requestFd);
+
+    while (!workerShouldStop)
+    {
+        std::uint32_t len = 0;
+        if (!ReadAll(requestFd, reinterpret_cast<char *>(&len), sizeof(len)))
+        {
+            break;
+        }
+        if (len == 0 || len > MAX_WORKER_REQUEST_SIZE)
+        {
+            log_error("Ignoring the rest of the requests after one of {} bytes", len);
+            break;
+        }
+        request.resize(len);
+        if (!ReadAll(requestFd, request.data(), len) || request.back() != '\0')
+        {
+            log_error("Unable to read a complete request of {} bytes", len);
+            break;
+        }
+
+        std::vector<char *> argv { programName };
+        for (size_t pos = 0; pos < request.size(); pos += strlen(&request[pos]) + 1)
+        {
+            argv.push_back(&request[pos]);
+        }
+        argv.push_back(nullptr);
+
+        main_should_stop.store(0);
+        nvvsCommon.mainReturnCode = NVVS_ST_SUCCESS;
+        RunNvvs(argv.size() - 1, argv.data());
+
+        dcgmNvvsRunDone_v1 done {};
+        done.version    = dcgmNvvsRunDone_version1;
+        done.returnCode = nvvsCommon.mainReturnCode;
+        if (!FdChannelClient(channelFd).Write({ reinterpret_cast<char const *>(&done), sizeof(done) }))
+        {
+            break;
+        }
+    }
+
+    log_debug("NVVS worker exiting");
+    return NVVS_ST_SUCCESS;
+}
+
+/*****************************************************************************/
+int main(int argc, char **argv)
+{
+    struct sigaction sigHandler = {};
+
+    sigHandler.sa_handler = main_sig_handler;
+    sigemptyset(&sigHandler.sa_mask);
+    sigHandler.sa_flags       = 0;
+    nvvsCommon.mainReturnCode = NVVS_ST_SUCCESS; /* Set by NvidiaValidationSuite constructor, but not until later */
+
+    /* Install signal handlers */
+    sigaction(SIGINT, &sigHandler, nullptr);
+    sigaction(SIGTERM, &sigHandler, nullptr);
+
+    /* nvvs --worker-fd <fd> --channel-fd <fd> runs diags on request instead of once */
+    if (auto requestFd = GetFdArg(argc, argv, "--worker-fd"); requestFd.has_value())
+    {
+        auto channelFd = GetFdArg(argc, argv, "--channel-fd");
+        if (!channelFd.has_value())
+        {
+            fmt::print(stderr, "--worker-fd requires --channel-fd\n");
+            return NVVS_ST_GENERIC_ERROR;
+        }
+        return RunWorker(argv[0], *requestFd, *channelFd);
+    }
+
+    RunNvvs(argc, argv);
 
     return nvvsCommon.mainReturnCode;
 }
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PhaseTimings.h"
+
+#include <algorithm>
+
+/*****************************************************************************/
+PhaseTimings::Scope::Scope(PhaseTimings &timings, std::string phase)
+    : m_timings(timings)
+    , m_phase(std::move(phase))
+    , m_start(Clock::now())
+{}
+
+/*****************************************************************************/
+PhaseTimings::Scope::~Scope()
+{
+    m_timings.Add(m_phase, Clock::now() - m_start);
+}
+
+/*****************************************************************************/
+void PhaseTimings::Add(std::string const &phase, Clock::duration elapsed)
+{
+    long long const usec = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    auto it = std::find_if(m_usec.begin(), m_usec.end(), [&phase](auto const &entry) { return entry.first == phase; });
+    if (it == m_usec.end())
+    {
+        m_usec.emplace_back(phase, usec);
+    }
+    else
+    {
+        it->second += usec;
+    }
+}
+
+/*****************************************************************************/
+long long PhaseTimings::GetUsec(std::string const &phase) const
+{
+    auto it = std::find_if(m_usec.begin(), m_usec.end(), [&phase](auto const &entry) { return entry.first == phase; });
+    return it == m_usec.end() ? 0 : it->second;
+}
+
+/*****************************************************************************/
+bool PhaseTimings::Empty() const
+{
+    return m_usec.empty();
+}
+
+/*****************************************************************************/
+void PhaseTimings::Clear()
+{
+    m_usec.clear();
+}
+
+/*****************************************************************************/
+Json::Value PhaseTimings::ToJson() const
+{
+    Json::Value json(Json::objectValue);
+
+    for (auto const &[phase, usec] : m_usec)
+    {
+        json[phase] = static_cast<Json::Int64>(usec);
+    }
+
+    return json;
+}
@@ -25,6 +25,8 @@
 namespace
 {
 
+bool g_keepLoaded = false;
+
 std::unique_ptr<dcgmDiagPluginEntityList_v1> PopulateEntityList(
     std::vector<dcgmDiagPluginEntityInfo_v1> const &entityInfos)
 {
@@ -78,6 +80,7 @@ PluginLib::PluginLib(PluginLib &&other) noexcept
     , m_userData(other.m_userData)
     , m_pluginName(other.m_pluginName)
     , m_description(other.m_description)
+    , m_loadTimings(std::move(other.m_loadTimings))
     , m_coreFunctionality(std::move(other.m_coreFunctionality))
 {
     other.m_pluginPtr                   = nullptr;
@@ -107,6 +110,7 @@ PluginLib &PluginLib::operator=(PluginLib &&other) noexcept
         m_userData                    = other.m_userData;
         m_pluginName                  = other.m_pluginName;
         m_description                 = other.m_description;
+        m_loadTimings                 = std::move(other.m_loadTimings);
 
         other.m_pluginPtr                   = nullptr;
         other.m_initialized                 = false;
@@ -120,11 +124,25 @@ PluginLib &PluginLib::operator=(PluginLib &&other) noexcept
     return *this;
 }
 
+/*****************************************************************************/
+void PluginLib::SetKeepLoaded(bool keepLoaded)
+{
+    g_keepLoaded = keepLoaded;
+}
+
+/*****************************************************************************/
+int PluginLib::GetDlopenFlags()
+{
+    return g_keepLoaded ? (RTLD_LAZY | RTLD_NODELETE) : RTLD_LAZY;
+}
+
 /*****************************************************************************/
 dcgmReturn_t PluginLib::LoadPlugin(const std::string &path, const std::string &name)
 {
+    PhaseTimings::Scope timed(m_loadTimings, "load");
+
     m_pluginName = name;
-    m_pluginPtr  = dlopen(path.c_str(), RTLD_LAZY);
+    m_pluginPtr  = dlopen(path.c_str(), GetDlopenFlags());
 
     if (m_pluginPtr == nullptr)
     {
@@ -299,6 +317,8 @@ bool PluginLib::VerifyTerminated(const char *str, unsigned int bufSize)
 /*****************************************************************************/
 dcgmReturn_t PluginLib::GetPluginInfo()
 {
+    PhaseTimings::Scope timed(m_loadTimings, "get_info");
+
     dcgmDiagPluginInfo_t pluginInfo {};
     dcgmReturn_t ret;
 
@@ -355,6 +375,8 @@ dcgm_field_entity_group_t PluginLib::GetTargetEntityGroup(std::string const &tes
 /*****************************************************************************/
 dcgmReturn_t PluginLib::InitializePlugin(dcgmHandle_t handle, int pluginId)
 {
+    PhaseTimings::Scope timed(m_loadTimings, "init");
+
     dcgmDiagPluginStatFieldIds_t statFieldIds = {};
     dcgmDiagPluginAttr_v1 pluginAttr          = {};
 
@@ -420,6 +442,9 @@ void PluginLib::RunTest(std::string const &testName,
                         unsigned int timeout,
                         TestParameters *tp)
 {
+    PhaseTimings &timings = m_tests.at(testName).GetPhaseTimings();
+    timings.Clear();
+
     std::unique_ptr<dcgmDiagPluginEntityList_v1> pEntityList = PopulateEntityList(entityInfos);
     std::vector<dcgmDiagPluginTestParameter_t> parameters;
     if (tp != nullptr)
@@ -475,6 +500,7 @@ void PluginLib::RunTest(std::string const &testName,
     // We don't need to set this up for the software or eud plugin
     if (m_pluginName != "software" && m_pluginName != "eud")
     {
+        PhaseTimings::Scope timed(timings, "pre_start");
         dcgmReturn_t dcgmRet = m_coreFunctionality.PluginPreStart(m_statFieldIds, entityInfos, m_pluginName);
         if (dcgmRet != DCGM_ST_OK)
         {
@@ -501,6 +527,7 @@ void PluginLib::RunTest(std::string const &testName,
      */
     try
     {
+        PhaseTimings::Scope timed(timings, "run");
         m_runTestCB(testName.c_str(), timeout, numParameters, parms, pEntityList.get(), m_userData);
     }
     catch (std::runtime_error &e)
@@ -528,6 +555,7 @@ void PluginLib::RunTest(std::string const &testName,
 
     try
     {
+        PhaseTimings::Scope timed(timings, "retrieve_stats");
         std::unique_ptr<dcgmDiagCustomStats_t> pCustomStats = std::make_unique<dcgmDiagCustomStats_t>();
         dcgmDiagCustomStats_t &customStats                  = *pCustomStats;
         do
@@ -562,6 +590,7 @@ void PluginLib::RunTest(std::string const &testName,
 
     try
     {
+        PhaseTimings::Scope timed(timings, "retrieve_results");
         auto pEntityResults                     = MakeUniqueZero<dcgmDiagEntityResults_v1>();
         dcgmDiagEntityResults_v1 &entityResults = *(pEntityResults.get());
 
@@ -596,6 +625,7 @@ void PluginLib::RunTest(std::string const &testName,
     // We don't write a stats file or perform these checks for the software or eud plugin
     if (m_pluginName != "software" && m_pluginName != "eud")
     {
+        PhaseTimings::Scope timed(timings, "write_stats");
         auto customStats    = m_tests.at(testName).GetCustomStats();
         auto testParameters = m_tests.at(testName).GetTestParameters();
         m_coreFunctionality.PluginEnded(GetFullLogFileName(), testParameters, GetResult(testName), customStats);
@@ -645,6 +675,9 @@ std::string PluginLib::GetFullLogFileName() const
         case NVVS_LOGFILE_TYPE_BINARY:
             retStr += ".stats";
             break;
+        case NVVS_LOGFILE_TYPE_JSON_LINES:
+            retStr += ".jsonl";
+            break;
     }
 
     return retStr;
@@ -695,6 +728,18 @@ const std::optional<std::any> &PluginLib::GetAuxData(std::string const &testName
     return m_tests.at(testName).GetAuxData();
 }
 
+/*****************************************************************************/
+PhaseTimings const &PluginLib::GetLoadTimings() const
+{
+    return m_loadTimings;
+}
+
+/*****************************************************************************/
+PhaseTimings const &PluginLib::GetPhaseTimings(std::string const &testName) const
+{
+    return m_tests.at(testName).GetPhaseTimings();
+}
+
 std::unordered_map<std::string, PluginLibTest> const &PluginLib::GetSupportedTests() const
 {
     return m_tests;
@@ -81,6 +81,16 @@ std::optional<std::any> const &PluginLibTest::GetAuxData() const
     return m_auxData;
 }
 
+PhaseTimings const &PluginLibTest::GetPhaseTimings() const
+{
+    return m_phaseTimings;
+}
+
+PhaseTimings &PluginLibTest::GetPhaseTimings()
+{
+    return m_phaseTimings;
+}
+
 nvvsPluginResult_t PluginLibTest::GetResult() const
 {
     if (m_testRunningState == TestRuningState::Pending)
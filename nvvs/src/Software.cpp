@@ -29,6 +29,8 @@
 #include <errno.h>
 #include <fmt/format.h>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <stdexcept>
 #include <string.h>
 #include <unistd.h>
@@ -213,8 +215,6 @@ bool Software::checkPermissions(bool checkFileCreation, bool skipDeviceTest)
     unsigned int gpuCount    = 0;
     unsigned int deviceCount = 0;
 
-    DIR *dir;
-    struct dirent *ent;
     std::string dirName = "/dev";
 
     setSubtestName(SW_SUBTEST_PERMS);
@@ -232,18 +232,16 @@ bool Software::checkPermissions(bool checkFileCreation, bool skipDeviceTest)
     SetResult(GetSoftwareTestName(), NVVS_RESULT_PASS);
     if (skipDeviceTest == false)
     {
-        dir = opendir(dirName.c_str());
+        std::optional<std::vector<std::string>> const devEntries
+            = m_devEntries.valid() ? m_devEntries.get() : ScanDevEntries();
 
-        if (NULL == dir)
+        if (!devEntries)
             return false;
 
-        ent = readdir(dir);
-
         std::vector<DcgmError> accessWarnings;
 
-        while (NULL != ent)
+        for (std::string const &entryName : *devEntries)
         {
-            std::string entryName = ent->d_name;
             if (CountDevEntry(entryName))
             {
                 std::stringstream ss;
@@ -259,10 +257,7 @@ bool Software::checkPermissions(bool checkFileCreation, bool skipDeviceTest)
                     deviceCount++;
                 }
             }
-
-            ent = readdir(dir);
         }
-        closedir(dir);
 
         if (deviceCount < gpuCount)
         {
@@ -306,11 +301,13 @@ bool Software::checkLibraries(libraryCheck_t checkLib)
 
     auto const check = [this](span_t const libraries, span_t const diagnostics, result_t const failureCode) {
         bool failure = false;
-        std::string error;
 
         for (char const *const library : libraries)
         {
-            if (!findLib(library, error))
+            auto const prefetched   = m_libraryErrors.find(library);
+            std::string const error = prefetched != m_libraryErrors.end() ? prefetched->second.get()
+                                                                          : FindLibCached(library);
+            if (!error.empty())
             {
                 DcgmError d { DcgmError::GpuIdTag::Unknown };
                 DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_CANNOT_OPEN_LIB, d, library, error.c_str());
@@ -382,100 +379,176 @@ bool Software::checkDenylist()
     // check whether the nouveau driver is installed and if so, fail this test
     bool status = false;
 
-    std::string const searchPaths[] = { "/sys/bus/pci/devices", "/sys/bus/pci_express/devices" };
-    std::string const driverDirs[]  = { "driver", "subsystem/drivers" };
-
     std::vector<std::string> const denyList = { "nouveau" };
 
     setSubtestName(SW_SUBTEST_DENYLIST);
 
-    for (unsigned long i = 0; i < sizeof(searchPaths) / sizeof(searchPaths[0]); ++i)
+    std::vector<DriverLink> const driverLinks = m_driverLinks.valid() ? m_driverLinks.get() : ScanDriverLinks();
+    for (DriverLink const &driverLink : driverLinks)
+    {
+        if (checkDriverPathDenylist(driverLink, denyList))
+        {
+            SetResult(GetSoftwareTestName(), NVVS_RESULT_FAIL);
+            status = true;
+        }
+    }
+    if (!status)
+        SetResult(GetSoftwareTestName(), NVVS_RESULT_PASS);
+    return status;
+}
+
+std::vector<Software::DriverLink> Software::ScanDriverLinks()
+{
+    // Drivers are bound before nvvs starts, so one scan serves every run of a long-lived nvvs worker
+    static std::mutex cacheMutex;
+    static std::optional<std::vector<DriverLink>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache)
     {
-        DIR *dir;
-        struct dirent *ent;
+        return *cache;
+    }
 
-        dir = opendir(searchPaths[i].c_str());
+    std::string const searchPaths[] = { "/sys/bus/pci/devices", "/sys/bus/pci_express/devices" };
+    std::string const driverDirs[]  = { "driver", "subsystem/drivers" };
+
+    std::vector<DriverLink> driverLinks;
+
+    for (std::string const &searchPath : searchPaths)
+    {
+        DIR *dir = opendir(searchPath.c_str());
 
         if (NULL == dir)
             continue;
 
-        ent = readdir(dir);
-        while (NULL != ent)
+        for (struct dirent *ent = readdir(dir); NULL != ent; ent = readdir(dir))
         {
             if ((strcmp(ent->d_name, ".") == 0) || (strcmp(ent->d_name, "..") == 0))
             {
-                ent = readdir(dir);
                 continue;
             }
-            for (unsigned long j = 0; j < sizeof(driverDirs) / sizeof(driverDirs[0]); ++j)
+            for (std::string const &driverDir : driverDirs)
             {
-                std::string baseDir = searchPaths[i];
-                std::stringstream testPath;
-                testPath << baseDir << "/" << ent->d_name << "/" << driverDirs[j];
-                if (checkDriverPathDenylist(testPath.str(), denyList))
+                DriverLink driverLink;
+                driverLink.path = fmt::format("{}/{}/{}", searchPath, ent->d_name, driverDir);
+
+                char symlinkTarget[1024];
+                int ret = readlink(driverLink.path.c_str(), symlinkTarget, sizeof(symlinkTarget));
+                if (ret >= (signed int)sizeof(symlinkTarget))
                 {
-                    SetResult(GetSoftwareTestName(), NVVS_RESULT_FAIL);
-                    status = true;
+                    assert(0);
+                    driverLink.error = ENAMETOOLONG;
                 }
+                else if (ret < 0)
+                {
+                    driverLink.error = errno;
+
+                    switch (driverLink.error)
+                    {
+                        case ENOENT:
+                            // driverPath does not exist, ignore it
+                            // this driver doesn't use this path format
+                            continue;
+                        case EINVAL: // not a symlink
+                            continue;
+
+                        case EACCES:
+                        case ENOTDIR:
+                        case ELOOP:
+                        case ENAMETOOLONG:
+                        case EIO:
+                        default:
+                            // Something bad happened
+                            break;
+                    }
+                }
+                else
+                {
+                    symlinkTarget[ret] = '\0'; // readlink doesn't null terminate
+                    driverLink.driver  = basename(symlinkTarget);
+                }
+                driverLinks.push_back(std::move(driverLink));
             }
-            ent = readdir(dir);
         }
         closedir(dir);
     }
-    if (!status)
-        SetResult(GetSoftwareTestName(), NVVS_RESULT_PASS);
-    return status;
+
+    cache = driverLinks;
+    return driverLinks;
 }
 
-int Software::checkDriverPathDenylist(std::string driverPath, std::vector<std::string> const &denyList)
+int Software::checkDriverPathDenylist(DriverLink const &driverLink, std::vector<std::string> const &denyList)
 {
-    int ret;
-    char symlinkTarget[1024];
-    ret = readlink(driverPath.c_str(), symlinkTarget, sizeof(symlinkTarget));
-    if (ret >= (signed int)sizeof(symlinkTarget))
+    if (driverLink.error != 0)
     {
-        assert(0);
-        return ENAMETOOLONG;
+        return driverLink.error;
     }
-    else if (ret < 0)
-    {
-        int errorno = errno;
 
-        switch (errorno)
+    for (auto const &item : denyList)
+    {
+        if (item == driverLink.driver)
         {
-            case ENOENT:
-                // driverPath does not exist, ignore it
-                // this driver doesn't use this path format
-                return 0;
-            case EINVAL: // not a symlink
-                return 0;
-
-            case EACCES:
-            case ENOTDIR:
-            case ELOOP:
-            case ENAMETOOLONG:
-            case EIO:
-            default:
-                // Something bad happened
-                return errorno;
+            DcgmError d { DcgmError::GpuIdTag::Unknown };
+            DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_DENYLISTED_DRIVER, d, item.c_str());
+            addError(d);
+            return 1;
         }
     }
-    else
+
+    return 0;
+}
+
+std::optional<std::vector<std::string>> Software::ScanDevEntries()
+{
+    // The device nodes are created when the driver loads, so one scan serves every run of a long-lived nvvs worker
+    static std::mutex cacheMutex;
+    static std::optional<std::vector<std::string>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache)
+    {
+        return cache;
+    }
+
+    DIR *dir = opendir("/dev");
+
+    if (NULL == dir)
+        return std::nullopt;
+
+    std::vector<std::string> entries;
+    for (struct dirent *ent = readdir(dir); NULL != ent; ent = readdir(dir))
     {
-        symlinkTarget[ret] = '\0'; // readlink doesn't null terminate
-        for (auto const &item : denyList)
+        entries.emplace_back(ent->d_name);
+    }
+    closedir(dir);
+
+    cache = std::move(entries);
+    return cache;
+}
+
+std::string Software::FindLibCached(std::string const &library)
+{
+    // A library that loaded once keeps loading, so it isn't loaded again. A library that didn't is retried
+    static std::mutex cacheMutex;
+    static std::set<std::string> found;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (found.contains(library))
         {
-            if (strcmp(item.c_str(), basename(symlinkTarget)) == 0)
-            {
-                DcgmError d { DcgmError::GpuIdTag::Unknown };
-                DCGM_ERROR_FORMAT_MESSAGE(DCGM_FR_DENYLISTED_DRIVER, d, item.c_str());
-                addError(d);
-                return 1;
-            }
+            return "";
         }
     }
 
-    return 0;
+    std::string error;
+    if (!findLib(library, error))
+    {
+        return error;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    found.insert(library);
+    return "";
 }
 
 bool Software::findLib(std::string library, std::string &error)
@@ -497,6 +570,84 @@ bool Software::findLib(std::string library, std::string &error)
     return true;
 }
 
+void Software::Prefetch(dcgmDiagPluginEntityList_v1 const &entityList)
+{
+    for (char const *const library : { DCGM_NVML_SONAME, DCGM_CUDA_SONAME, DCGM_CUDART_SONAME, DCGM_CUBLAS_SONAME })
+    {
+        m_libraryErrors[library] = std::async(std::launch::async, FindLibCached, std::string(library)).share();
+    }
+    m_driverLinks = std::async(std::launch::async, ScanDriverLinks).share();
+    m_devEntries  = std::async(std::launch::async, ScanDevEntries).share();
+
+    unsigned const numEntities = std::min(
+        entityList.numEntities, static_cast<unsigned>(sizeof(entityList.entities) / sizeof(entityList.entities[0])));
+
+    std::vector<unsigned int> gpuIds;
+    for (unsigned int i = 0; i < numEntities; i++)
+    {
+        if (entityList.entities[i].entity.entityGroupId != DCGM_FE_GPU)
+        {
+            continue;
+        }
+        if (entityList.entities[i].auxField.gpu.status == DcgmEntityStatusFake)
+        {
+            // Fake GPUs don't have live data. Their checks read cached values one at a time
+            return;
+        }
+        gpuIds.push_back(entityList.entities[i].entity.entityId);
+    }
+
+    if (gpuIds.empty())
+    {
+        return;
+    }
+
+    auto const readFieldValues = [this, gpuIds]() {
+        std::vector<unsigned short> fieldIds = { DCGM_FI_DEV_GRAPHICS_PIDS,
+                                                 DCGM_FI_DEV_RETIRED_PENDING,
+                                                 DCGM_FI_DEV_ECC_DBE_VOL_TOTAL,
+                                                 DCGM_FI_DEV_RETIRED_DBE,
+                                                 DCGM_FI_DEV_RETIRED_SBE,
+                                                 DCGM_FI_DEV_ROW_REMAP_FAILURE,
+                                                 DCGM_FI_DEV_ROW_REMAP_PENDING,
+                                                 DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS,
+                                                 DCGM_FI_DEV_INFOROM_CONFIG_VALID,
+                                                 DCGM_FI_DEV_FABRIC_MANAGER_STATUS };
+        std::vector<dcgmFieldValue_v2> values;
+        std::map<FieldValueKey, dcgmFieldValue_v2> fieldValues;
+
+        // On failure the checks read the fields one at a time and report the error themselves
+        if (m_dcgmSystem.GetLatestValuesForGpus(gpuIds, fieldIds, DCGM_FV_FLAG_LIVE_DATA, values) == DCGM_ST_OK)
+        {
+            for (auto const &value : values)
+            {
+                fieldValues.emplace(FieldValueKey(value.entityId, value.fieldId), value);
+            }
+        }
+        return fieldValues;
+    };
+
+    m_fieldValues = std::async(std::launch::async, readFieldValues).share();
+}
+
+dcgmReturn_t Software::GetFieldValue(unsigned int gpuId,
+                                     unsigned short fieldId,
+                                     dcgmFieldValue_v2 &value,
+                                     unsigned int flags)
+{
+    if (flags == DCGM_FV_FLAG_LIVE_DATA && m_fieldValues.valid())
+    {
+        auto const &fieldValues = m_fieldValues.get();
+        if (auto it = fieldValues.find(FieldValueKey(gpuId, fieldId)); it != fieldValues.end())
+        {
+            value = it->second;
+            return DCGM_ST_OK;
+        }
+    }
+
+    return m_dcgmRecorder.GetCurrentFieldValue(gpuId, fieldId, value, flags);
+}
+
 int Software::checkForGraphicsProcesses()
 {
     unsigned int flags = DCGM_FV_FLAG_LIVE_DATA;
@@ -508,8 +659,7 @@ int Software::checkForGraphicsProcesses()
 
     for (auto const gpuId : gpuList)
     {
-        dcgmReturn_t ret
-            = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_GRAPHICS_PIDS, graphicsPidsVal, flags);
+        dcgmReturn_t ret = GetFieldValue(gpuId, DCGM_FI_DEV_GRAPHICS_PIDS, graphicsPidsVal, flags);
 
         if (ret != DCGM_ST_OK)
         {
@@ -602,8 +752,7 @@ int Software::checkPageRetirement()
     for (auto const gpuId : gpuList)
     {
         // Check for pending page retirements
-        ret = m_dcgmRecorder.GetCurrentFieldValue(
-            gpuId, DCGM_FI_DEV_RETIRED_PENDING, pendingRetirementsFieldValue, flags);
+        ret = GetFieldValue(gpuId, DCGM_FI_DEV_RETIRED_PENDING, pendingRetirementsFieldValue, flags);
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -623,7 +772,7 @@ int Software::checkPageRetirement()
         else if (pendingRetirementsFieldValue.value.i64 > 0)
         {
             dcgmFieldValue_v2 volDbeVal = {};
-            ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_ECC_DBE_VOL_TOTAL, volDbeVal, flags);
+            ret = GetFieldValue(gpuId, DCGM_FI_DEV_ECC_DBE_VOL_TOTAL, volDbeVal, flags);
             if (ret == DCGM_ST_OK && (volDbeVal.value.i64 > 0 && !DCGM_INT64_IS_BLANK(volDbeVal.value.i64)))
             {
                 DcgmError d { gpuId };
@@ -650,7 +799,7 @@ int Software::checkPageRetirement()
         retiredPagesTotal = 0;
 
         // DBE retired pages
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_RETIRED_DBE, dbeFieldValue, flags);
+        ret = GetFieldValue(gpuId, DCGM_FI_DEV_RETIRED_DBE, dbeFieldValue, flags);
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -671,7 +820,7 @@ int Software::checkPageRetirement()
         }
 
         // SBE retired pages
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_RETIRED_SBE, sbeFieldValue, flags);
+        ret = GetFieldValue(gpuId, DCGM_FI_DEV_RETIRED_SBE, sbeFieldValue, flags);
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -729,7 +878,7 @@ int Software::checkRowRemapping()
         memset(&rowRemapFailure, 0, sizeof(rowRemapFailure));
 
         // Row remap failure
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_ROW_REMAP_FAILURE, rowRemapFailure, flags);
+        ret = GetFieldValue(gpuId, DCGM_FI_DEV_ROW_REMAP_FAILURE, rowRemapFailure, flags);
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -762,7 +911,7 @@ int Software::checkRowRemapping()
         memset(&pendingRowRemap, 0, sizeof(pendingRowRemap));
 
         // Check for pending row remappings
-        ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_ROW_REMAP_PENDING, pendingRowRemap, flags);
+        ret = GetFieldValue(gpuId, DCGM_FI_DEV_ROW_REMAP_PENDING, pendingRowRemap, flags);
         if (ret != DCGM_ST_OK)
         {
             DcgmError d { gpuId };
@@ -780,7 +929,7 @@ int Software::checkRowRemapping()
         else if (pendingRowRemap.value.i64 > 0)
         {
             dcgmFieldValue_v2 uncRemap = {};
-            ret = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS, uncRemap, flags);
+            ret = GetFieldValue(gpuId, DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS, uncRemap, flags);
             if (ret == DCGM_ST_OK && (uncRemap.value.i64 > 0 && !DCGM_INT64_IS_BLANK(uncRemap.value.i64)))
             {
                 DcgmError d { gpuId };
@@ -813,8 +962,7 @@ int Software::checkInforom()
 
     for (auto const gpuId : gpuList)
     {
-        dcgmReturn_t ret
-            = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_INFOROM_CONFIG_VALID, inforomValidVal, flags);
+        dcgmReturn_t ret = GetFieldValue(gpuId, DCGM_FI_DEV_INFOROM_CONFIG_VALID, inforomValidVal, flags);
 
         if (ret != DCGM_ST_OK)
         {
@@ -908,8 +1056,7 @@ void Software::checkFabricManager()
     {
         unsigned int gpuId = *gpuIt;
 
-        dcgmReturn_t ret
-            = m_dcgmRecorder.GetCurrentFieldValue(gpuId, DCGM_FI_DEV_FABRIC_MANAGER_STATUS, fmStatusVal, flags);
+        dcgmReturn_t ret = GetFieldValue(gpuId, DCGM_FI_DEV_FABRIC_MANAGER_STATUS, fmStatusVal, flags);
 
         if (ret != DCGM_ST_OK)
         {
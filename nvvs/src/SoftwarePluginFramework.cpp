@@ -194,6 +194,10 @@ void SoftwarePluginFramework::Run(DcgmNvvsResponseWrapper &diagResponse, dcgmDia
     m_softwareObj = std::make_unique<Software>(dcgmHandle.GetHandle());
     m_softwareObj->SetPluginAttr(pluginAttr);
 
+    // ------------------------------------------
+    // start the I/O of every test while they run one after another
+    m_softwareObj->Prefetch(*m_entityList);
+
     // ---------------------------------
     // init map gpu set
     initTestParametersMap();
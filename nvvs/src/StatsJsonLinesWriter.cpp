@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <StatsJsonLinesWriter.h>
+
+#include <CustomStatHolder.h>
+
+#include <fmt/format.h>
+
+namespace
+{
+const char *c_gpuIndex  = "gpuIndex";
+const char *c_gpuId     = "gpuId";
+const char *c_group     = "group";
+const char *c_stat      = "stat";
+const char *c_timestamp = "timestamp";
+const char *c_value     = "value";
+
+Json::Value MakeSample(long long timestamp, Json::Value const &value)
+{
+    Json::Value sample;
+    sample[c_timestamp] = static_cast<Json::Int64>(timestamp);
+    sample[c_value]     = value;
+    return sample;
+}
+} // namespace
+
+StatsJsonLinesWriter::StatsJsonLinesWriter(std::ostream &out)
+    : m_out(out)
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    m_writer.reset(builder.newStreamWriter());
+}
+
+void StatsJsonLinesWriter::WriteLine(Json::Value const &line)
+{
+    m_writer->write(line, &m_out);
+    m_out << '\n';
+}
+
+void StatsJsonLinesWriter::WriteGpu(unsigned int gpuIndex, unsigned int gpuId)
+{
+    Json::Value line;
+    line[c_gpuIndex] = gpuIndex;
+    line[c_gpuId]    = gpuId;
+    WriteLine(line);
+}
+
+void StatsJsonLinesWriter::WriteGpuStat(unsigned int gpuIndex, std::string const &stat)
+{
+    Json::Value line;
+    line[c_gpuIndex] = gpuIndex;
+    line[c_stat]     = stat;
+    WriteLine(line);
+}
+
+void StatsJsonLinesWriter::WriteGpuSample(unsigned int gpuIndex,
+                                          std::string const &stat,
+                                          long long timestamp,
+                                          Json::Value const &value)
+{
+    Json::Value line = MakeSample(timestamp, value);
+    line[c_gpuIndex] = gpuIndex;
+    line[c_stat]     = stat;
+    WriteLine(line);
+}
+
+void StatsJsonLinesWriter::WriteGroupSample(std::string const &group,
+                                            std::string const &stat,
+                                            long long timestamp,
+                                            Json::Value const &value)
+{
+    Json::Value line = MakeSample(timestamp, value);
+    line[c_group]    = group;
+    line[c_stat]     = stat;
+    WriteLine(line);
+}
+
+void StatsJsonLinesWriter::WriteGroupString(std::string const &group,
+                                            std::string const &stat,
+                                            std::string const &value)
+{
+    Json::Value line;
+    line[c_group] = group;
+    line[c_stat]  = stat;
+    line[c_value] = value;
+    WriteLine(line);
+}
+
+bool StatsJsonLinesWriter::ConvertToJson(std::istream &in, Json::Value &jv, std::string &error)
+{
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    std::string text;
+    unsigned int lineNumber = 0;
+
+    while (std::getline(in, text))
+    {
+        lineNumber++;
+        if (text.empty())
+        {
+            continue;
+        }
+
+        Json::Value line;
+        std::string parseError;
+        if (!reader->parse(text.data(), text.data() + text.size(), &line, &parseError) || !line.isObject())
+        {
+            error = fmt::format("Unable to parse line {} of the stats: '{}'", lineNumber, parseError);
+            return false;
+        }
+
+        Json::Value *dest = nullptr;
+        if (line.isMember(c_gpuIndex))
+        {
+            Json::Value &gpu = jv[GPUS][line[c_gpuIndex].asUInt()];
+            if (line.isMember(c_gpuId))
+            {
+                gpu[c_gpuId] = line[c_gpuId];
+                continue;
+            }
+
+            dest = &gpu[line[c_stat].asString()];
+            if (!line.isMember(c_timestamp))
+            {
+                *dest = Json::Value(Json::arrayValue);
+                continue;
+            }
+        }
+        else if (line.isMember(c_group))
+        {
+            dest = &jv[line[c_group].asString()][line[c_stat].asString()];
+            if (!line.isMember(c_timestamp))
+            {
+                *dest = line[c_value];
+                continue;
+            }
+        }
+        else
+        {
+            error = fmt::format("Line {} of the stats is neither a GPU nor a group stat", lineNumber);
+            return false;
+        }
+
+        Json::Value sample;
+        sample[c_timestamp] = line[c_timestamp];
+        sample[c_value]     = line[c_value];
+        dest->append(sample);
+    }
+
+    return true;
+}
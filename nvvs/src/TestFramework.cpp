@@ -21,9 +21,11 @@
 #include <DcgmHandle.h>
 #include <DcgmRecorder.h>
 #include <DcgmSystem.h>
+#include <Defer.hpp>
 #include <FdChannelClient.h>
 #include <Gpu.h>
 #include <NvvsCommon.h>
+#include <NvvsJsonStrings.h>
 #include <PluginLib.h>
 #include <PluginStrings.h>
 #include <TestFramework.h>
@@ -36,16 +38,19 @@
 #include <cstring>
 #include <dirent.h>
 #include <dlfcn.h>
+#include <exception>
 #include <filesystem>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
@@ -93,6 +98,24 @@ std::unordered_set<unsigned int> GetGpuIds(EntitySet *entitySet)
     return res;
 }
 
+/* auxData with the phase timings of its test added. Aux data that isn't a JSON object is returned as is */
+std::optional<std::any> WithPhaseTimings(std::optional<std::any> const &auxData, Json::Value phaseTimings)
+{
+    Json::Value aux(Json::objectValue);
+    if (auxData.has_value())
+    {
+        auto const *json = std::any_cast<Json::Value>(&*auxData);
+        if (json == nullptr || !json->isObject())
+        {
+            return auxData;
+        }
+        aux = *json;
+    }
+
+    aux[NVVS_PHASE_TIMINGS] = std::move(phaseTimings);
+    return std::make_any<Json::Value>(std::move(aux));
+}
+
 } //namespace
 
 
@@ -297,7 +320,7 @@ void TestFramework::LoadLibrary(const char *libraryPath, const char *libraryName
     {
         /* libpluginCommon.so is a resource for the plugins, so it won't contain the symbols a pure plugin has.
            Process it separately and load it immediately. */
-        void *dlib = dlopen(libraryPath, RTLD_LAZY);
+        void *dlib = dlopen(libraryPath, PluginLib::GetDlopenFlags());
         if (dlib == NULL)
         {
             std::string const dlopen_error = dlerror();
@@ -576,6 +599,13 @@ void TestFramework::InsertIntoTestCategory(std::string groupName, Test *testObje
     }
 }
 
+/*****************************************************************************/
+void TestFramework::SetSuiteTimings(PhaseTimings const &timings)
+{
+    m_suiteTimings = timings;
+}
+
+/*****************************************************************************/
 dcgmReturn_t TestFramework::SetDiagResponseVersion(unsigned int version)
 {
     return m_diagResponse.SetVersion(version);
@@ -636,33 +666,41 @@ void TestFramework::Go(std::vector<std::unique_ptr<EntitySet>> &entitySets)
     // run software External plugin
     runSoftwarePlugin(entitySets, &pluginAttr);
 
-    // iterate through all entity sets
-    for (auto &entitySet : entitySets)
+    if (entitySets.size() == 1)
     {
-        std::optional<std::vector<Test *>> testList;
-
-        testList = entitySet->GetTestObjList(HARDWARE_TEST_OBJS);
-        if (testList && testList->size() > 0)
-        {
-            GoList(Test::NVVS_CLASS_HARDWARE, *testList, entitySet.get(), pulseTestWillExecute);
-        }
-
-        testList = entitySet->GetTestObjList(INTEGRATION_TEST_OBJS);
-        if (testList && testList->size() > 0)
-        {
-            GoList(Test::NVVS_CLASS_INTEGRATION, *testList, entitySet.get(), pulseTestWillExecute);
-        }
-
-        testList = entitySet->GetTestObjList(PERFORMANCE_TEST_OBJS);
-        if (testList && testList->size() > 0)
+        GoEntitySet(entitySets[0].get(), pulseTestWillExecute);
+    }
+    else
+    {
+        /*
+         * Entity sets are disjoint, so each runs its tests on its own thread. Tests that share a
+         * plugin or a resource such as the power budget still wait for each other in GoList()
+         */
+        std::vector<std::exception_ptr> errors(entitySets.size());
         {
-            GoList(Test::NVVS_CLASS_PERFORMANCE, *testList, entitySet.get(), pulseTestWillExecute);
-        }
+            std::vector<std::jthread> runners;
+            runners.reserve(entitySets.size());
+            for (size_t i = 0; i < entitySets.size(); i++)
+            {
+                runners.emplace_back([this, &errors, i, entitySet = entitySets[i].get(), pulseTestWillExecute] {
+                    try
+                    {
+                        GoEntitySet(entitySet, pulseTestWillExecute);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                });
+            }
+        } // Joins the runners
 
-        testList = entitySet->GetTestObjList(CUSTOM_TEST_OBJS);
-        if (testList && testList->size() > 0)
+        for (auto const &error : errors)
         {
-            GoList(Test::NVVS_CLASS_CUSTOM, *testList, entitySet.get(), pulseTestWillExecute);
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
         }
     }
 
@@ -672,13 +710,44 @@ void TestFramework::Go(std::vector<std::unique_ptr<EntitySet>> &entitySets)
     }
     else
     {
-        if (!FdChannelClient(nvvsCommon.channelFd).Write(m_diagResponse.RawBinaryBlob()))
+        if (!FdChannelClient(nvvsCommon.channelFd)
+                 .WriteResponse(m_diagResponse.RawBinaryBlob(), nvvsCommon.responseFd))
         {
             log_error("failed to write diag response to caller.");
         }
     }
 }
 
+/*****************************************************************************/
+void TestFramework::GoEntitySet(EntitySet *entitySet, bool checkFileCreation)
+{
+    std::optional<std::vector<Test *>> testList;
+
+    testList = entitySet->GetTestObjList(HARDWARE_TEST_OBJS);
+    if (testList && testList->size() > 0)
+    {
+        GoList(Test::NVVS_CLASS_HARDWARE, *testList, entitySet, checkFileCreation);
+    }
+
+    testList = entitySet->GetTestObjList(INTEGRATION_TEST_OBJS);
+    if (testList && testList->size() > 0)
+    {
+        GoList(Test::NVVS_CLASS_INTEGRATION, *testList, entitySet, checkFileCreation);
+    }
+
+    testList = entitySet->GetTestObjList(PERFORMANCE_TEST_OBJS);
+    if (testList && testList->size() > 0)
+    {
+        GoList(Test::NVVS_CLASS_PERFORMANCE, *testList, entitySet, checkFileCreation);
+    }
+
+    testList = entitySet->GetTestObjList(CUSTOM_TEST_OBJS);
+    if (testList && testList->size() > 0)
+    {
+        GoList(Test::NVVS_CLASS_CUSTOM, *testList, entitySet, checkFileCreation);
+    }
+}
+
 /*****************************************************************************/
 std::vector<dcgmDiagPluginEntityInfo_v1> TestFramework::PopulateEntityInfoForPlugins(EntitySet *entitySet)
 {
@@ -798,6 +867,27 @@ void TestFramework::WriteDiagStatusToChannel(std::string_view testName, unsigned
     }
 }
 
+void TestFramework::WriteTestCompletionToChannel(std::string_view testName) const
+{
+    auto completion = std::make_unique<dcgmDiagTestCompletion_v1>();
+    if (m_diagResponse.GetTestCompletion(testName, *completion) != DCGM_ST_OK)
+    {
+        // Nothing to stream for responses older than v11 or for tests that didn't record a result
+        return;
+    }
+
+    completion->version        = dcgmDiagTestCompletion_version1;
+    completion->totalTests     = m_numTestsToRun;
+    completion->completedTests = m_completedTests;
+
+    std::span<char const> completionBinary(reinterpret_cast<char const *>(completion.get()), sizeof(*completion));
+    log_debug("Writing test completion for test {}", testName);
+    if (!FdChannelClient(nvvsCommon.channelFd).Write(completionBinary))
+    {
+        log_error("Failed to write test completion to caller.");
+    }
+}
+
 template <class T>
 static unsigned int GetFirstError(std::vector<T> const &errors)
     requires(std::is_same_v<T, dcgmDiagErrorDetail_v2> || std::is_same_v<T, dcgmDiagError_v1>)
@@ -823,16 +913,24 @@ void TestFramework::GoList(Test::testClasses_enum classNum,
     {
         Test *test = (*testItr); // readability
 
+        unsigned int const pluginIndex = test->GetPluginIndex();
+        std::string const &testName    = test->GetTestName();
+        unsigned int const resources   = TestResourceLocks::GetTestResources(testName);
+
         unsigned int vecSize = test->getArgVectorSize(classNum);
         for (unsigned int i = 0; i < vecSize; i++)
         {
+            /* Other entity sets may be running tests. Wait for any that share this plugin or its resources */
+            auto const waitStart = PhaseTimings::Clock::now();
+            m_resourceLocks.Acquire(pluginIndex, resources);
+            DcgmNs::Defer releaseResources([&] { m_resourceLocks.Release(pluginIndex, resources); });
+            auto const waitTime = PhaseTimings::Clock::now() - waitStart;
+
             bool testSkipped       = false;
             TestParameters *tp     = test->popArgVectorElement(classNum);
             std::string pluginName = tp->GetString(PS_PLUGIN_NAME);
 
-            unsigned int pluginIndex    = test->GetPluginIndex();
-            std::string const &testName = test->GetTestName();
-
+            std::unique_lock<std::mutex> responseLock(m_responseMutex);
             if (pluginIndex >= m_plugins.size() || m_diagResponse.TestSlotsFull())
             {
                 std::string errMsg = fmt::format("Invalid index {} or too many tests", pluginIndex);
@@ -849,6 +947,7 @@ void TestFramework::GoList(Test::testClasses_enum classNum,
                 m_diagResponse.SetSystemError(errMsg, DCGM_ST_GENERIC_ERROR);
                 continue;
             }
+            responseLock.unlock();
 
             if (testName == std::string(PULSE_TEST_PLUGIN_NAME))
             {
@@ -867,8 +966,17 @@ void TestFramework::GoList(Test::testClasses_enum classNum,
                 m_plugins[pluginIndex]->RunTest(testName, entityInfos, 600, tp);
                 m_plugins[pluginIndex]->SetTestRunningState(testName, TestRuningState::Done);
 
-                if (auto ret = m_diagResponse.SetTestResult(
-                        pluginName, testName, entityResults, m_plugins[pluginIndex]->GetAuxData(testName));
+                PhaseTimings testTimings = m_plugins[pluginIndex]->GetPhaseTimings(testName);
+                testTimings.Add("resource_wait", waitTime);
+
+                Json::Value phaseTimings;
+                phaseTimings[NVVS_PHASE_SUITE]  = m_suiteTimings.ToJson();
+                phaseTimings[NVVS_PHASE_PLUGIN] = m_plugins[pluginIndex]->GetLoadTimings().ToJson();
+                phaseTimings[NVVS_PHASE_TEST]   = testTimings.ToJson();
+                auto const auxData = WithPhaseTimings(m_plugins[pluginIndex]->GetAuxData(testName), phaseTimings);
+
+                responseLock.lock();
+                if (auto ret = m_diagResponse.SetTestResult(pluginName, testName, entityResults, auxData);
                     ret != DCGM_ST_OK)
                 {
                     log_error("failed to set test result to test [{}], ret: [{}].", testName, ret);
@@ -876,6 +984,7 @@ void TestFramework::GoList(Test::testClasses_enum classNum,
             }
             else
             {
+                responseLock.lock();
                 if (auto ret = m_diagResponse.SetTestSkipped(pluginName, testName); ret != DCGM_ST_OK)
                 {
                     log_error("failed to set skipped result to test [{}], ret: [{}].", testName, ret);
@@ -901,6 +1010,7 @@ void TestFramework::GoList(Test::testClasses_enum classNum,
                 firstError = GetFirstError(m_plugins[pluginIndex]->GetErrors(testName));
             }
             m_completedTests++;
+            WriteTestCompletionToChannel(testName);
             WriteDiagStatusToChannel(testName, firstError);
         }
     }
@@ -960,5 +1070,6 @@ void TestFramework::runSoftwarePlugin(std::vector<std::unique_ptr<EntitySet>> co
         firstError = GetFirstError(m_softwarePluginFramework->GetErrors());
     }
     m_completedTests++;
+    WriteTestCompletionToChannel(SW_PLUGIN_NAME);
     WriteDiagStatusToChannel(SW_PLUGIN_NAME, firstError);
 }
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "TestResourceLocks.h"
+
+#include <PluginStrings.h>
+
+/*****************************************************************************/
+unsigned int TestResourceLocks::GetTestResources(std::string_view testName)
+{
+    if (testName == PCIE_PLUGIN_NAME || testName == NVBANDWIDTH_PLUGIN_NAME)
+    {
+        return TEST_RESOURCE_PCIE | TEST_RESOURCE_NVLINK;
+    }
+
+    if (testName == TP_PLUGIN_NAME || testName == TS_PLUGIN_NAME || testName == SMSTRESS_PLUGIN_NAME
+        || testName == DIAGNOSTIC_PLUGIN_NAME || testName == PULSE_TEST_PLUGIN_NAME || testName == EUD_PLUGIN_NAME
+        || testName == CPU_EUD_TEST_NAME)
+    {
+        return TEST_RESOURCE_POWER;
+    }
+
+    /* memory, memtest, memory_bandwidth, context_create and unknown tests only stress their own entities */
+    return TEST_RESOURCE_NONE;
+}
+
+/*****************************************************************************/
+void TestResourceLocks::Acquire(unsigned int pluginIndex, unsigned int resources)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_released.wait(lock, [&] {
+        return (m_heldResources & resources) == 0 && !m_heldPlugins.contains(pluginIndex);
+    });
+
+    m_heldResources |= resources;
+    m_heldPlugins.insert(pluginIndex);
+}
+
+/*****************************************************************************/
+void TestResourceLocks::Release(unsigned int pluginIndex, unsigned int resources)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_heldResources &= ~resources;
+        m_heldPlugins.erase(pluginIndex);
+    }
+
+    m_released.notify_all();
+}
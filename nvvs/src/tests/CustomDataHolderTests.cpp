@@ -15,7 +15,9 @@
  */
 #include <catch2/catch_all.hpp>
 
+#include <thread>
 #include <unordered_set>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 #include "DcgmDiagUnitTestCommon.h"
@@ -181,3 +183,57 @@ TEST_CASE("CustomStatHolder : Storing Values and Outputting in structs / JSON")
         CHECK(jv[bridgemen][lost][i]["value"].asInt64() == i);
     }
 }
+
+TEST_CASE("CustomStatHolder : Stats reported from many threads")
+{
+    CustomStatHolder cdh;
+    unsigned int const numThreads = 8;
+    long long const numStats      = 2000;
+    std::vector<std::thread> threads;
+
+    // Two threads per GPU, plus GPU 100 which is past the lock-free lists
+    for (unsigned int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&cdh, t, numStats]() {
+            unsigned int const gpuId = t == 0 ? 100 : t / 2;
+            std::string const name   = "thread" + std::to_string(t);
+            for (long long i = 0; i < numStats; i++)
+            {
+                cdh.SetGpuStat(gpuId, name, i);
+                cdh.SetGroupedStat(bridgemen, name, i);
+            }
+        });
+    }
+
+    // Reading merges what has been reported so far
+    CHECK(cdh.GetCustomGpuStat(3, "thread6").size() <= static_cast<size_t>(numStats));
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (unsigned int t = 0; t < numThreads; t++)
+    {
+        unsigned int const gpuId = t == 0 ? 100 : t / 2;
+        std::string const name   = "thread" + std::to_string(t);
+
+        // Each thread's stats keep the order it reported them in
+        std::vector<dcgmTimeseriesInfo_t> gpuStats = cdh.GetCustomGpuStat(gpuId, name);
+        REQUIRE(gpuStats.size() == static_cast<size_t>(numStats));
+        std::vector<dcgmTimeseriesInfo_t> groupedStats = cdh.GetGroupedStat(bridgemen, name);
+        REQUIRE(groupedStats.size() == static_cast<size_t>(numStats));
+        for (long long i = 0; i < numStats; i++)
+        {
+            REQUIRE(gpuStats[i].val.i64 == static_cast<uint64_t>(i));
+            REQUIRE(groupedStats[i].val.i64 == static_cast<uint64_t>(i));
+        }
+    }
+
+    // Reported after a read
+    cdh.SetGpuStat(1, "thread2", 5.0);
+    CHECK(cdh.GetCustomGpuStat(1, "thread2").size() == static_cast<size_t>(numStats) + 1);
+
+    cdh.ClearCustomData();
+    CHECK(cdh.GetCustomGpuStat(1, "thread2").empty());
+}
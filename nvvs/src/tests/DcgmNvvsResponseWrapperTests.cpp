@@ -23,6 +23,7 @@
 #include <DcgmStringHelpers.h>
 #include <GpuSet.h>
 #include <NvvsCommon.h>
+#include <NvvsJsonStrings.h>
 #include <PluginStrings.h>
 #include <dcgm_errors.h>
 #include <dcgm_fields.h>
@@ -1487,3 +1488,29 @@ TEST_CASE("DcgmNvvsResponseWrapper::AddTestCategory")
         TestAddTestCategory(dcgmDiagResponse_version7);
     }
 }
+
+TEST_CASE("DcgmNvvsResponseWrapper::SetTestResult drops phase timings that don't fit")
+{
+    auto entitySets = CreateFakeEntitySets("545.29.06", 2, 2);
+
+    DcgmNvvsResponseWrapper wrapper;
+    wrapper.SetVersion(dcgmDiagResponse_version11);
+    REQUIRE(wrapper.PopulateDefault(entitySets));
+
+    std::unique_ptr<dcgmDiagEntityResults_v1> entityResultsPtr = CreateFakeEntityResults(1, 2, 2);
+
+    ::Json::Value auxData;
+    auxData["hello"]                           = "eud";
+    auxData[NVVS_PHASE_TIMINGS]["test"]["run"] = 1000;
+    REQUIRE(wrapper.SetTestResult("eud", "eud", *entityResultsPtr, auxData) == DCGM_ST_OK);
+
+    auxData["hello"] = std::string(DCGM_DIAG_AUX_DATA_LEN - 20, 'x');
+    REQUIRE(wrapper.SetTestResult("memory", "memory", *entityResultsPtr, auxData) == DCGM_ST_OK);
+
+    auto const &rawResponse = wrapper.ConstResponse<dcgmDiagResponse_v11>();
+    REQUIRE(rawResponse.numTests == 2);
+    CHECK(std::string_view(rawResponse.tests[0].auxData.data)
+          == "{\"hello\":\"eud\",\"" NVVS_PHASE_TIMINGS "\":{\"test\":{\"run\":1000}}}");
+    CHECK(std::string_view(rawResponse.tests[1].auxData.data)
+          == fmt::format("{{\"hello\":\"{}\"}}", std::string(DCGM_DIAG_AUX_DATA_LEN - 20, 'x')));
+}
@@ -18,6 +18,7 @@
 #include <NvvsCommon.h>
 #include <catch2/catch_all.hpp>
 #include <fstream>
+#include <sstream>
 #include <unistd.h>
 #include <yaml-cpp/yaml.h>
 
@@ -198,6 +199,37 @@ SCENARIO("int DcgmRecorder::WriteToFile(const std::string &filename, int logFile
     CHECK(json[singleGroupKeys[1]][singleGroupGpus[1]].asString() == singleGroupVals[1]);
 }
 
+SCENARIO("DcgmRecorder::WriteToFile writes JSON Lines that convert to the JSON layout")
+{
+    DcgmRecorder dr;
+    Json::Value json;
+    Json::Value converted;
+    std::string error;
+
+    std::string jsonFileName  = createTmpFile("json");
+    std::string linesFileName = createTmpFile("jsonl");
+
+    fillGpuStats(dr);
+    fillGroupStats(dr);
+    fillSingleGroupStats(dr);
+
+    dr.WriteToFile(jsonFileName, NVVS_LOGFILE_TYPE_JSON, 0);
+    dr.WriteToFile(linesFileName, NVVS_LOGFILE_TYPE_JSON_LINES, 0);
+
+    std::ifstream jsonStream(jsonFileName);
+    jsonStream >> json;
+
+    std::ifstream linesStream(linesFileName);
+    REQUIRE(StatsJsonLinesWriter::ConvertToJson(linesStream, converted, error));
+    CHECK(error.empty());
+    CHECK(converted.toStyledString() == json.toStyledString());
+
+    std::istringstream bad("{\"gpuIndex\": 0, \"gpuId\": 0}\nnot json\n");
+    Json::Value partial;
+    CHECK(!StatsJsonLinesWriter::ConvertToJson(bad, partial, error));
+    CHECK(error.find("line 2") != std::string::npos);
+}
+
 SCENARIO("int DcgmRecorder::GetValueIndex(unsigned short fieldId)")
 {
     DcgmRecorder dr;
@@ -15,6 +15,7 @@
  */
 #include <DcgmValuesSinceHolder.h>
 #include <catch2/catch_all.hpp>
+#include <sstream>
 #include <unistd.h>
 #include <yaml-cpp/yaml.h>
 
@@ -257,6 +258,41 @@ SCENARIO("void DcgmValuesSinceHolder::AddToJson(Json::Value &jv)")
     CHECK(field2[0][c_value].asInt() == 0);
 }
 
+SCENARIO("void DcgmValuesSinceHolder::WriteJsonLines(StatsJsonLinesWriter &writer)")
+{
+    Json::Value jv;
+    Json::Value converted;
+    DcgmValuesSinceHolder dvsh;
+    dcgmFieldValue_v1 fv = {};
+    std::stringstream lines;
+    std::string error;
+
+    fv.fieldType = DCGM_FT_INT64;
+    for (int64_t i = 0; i < 3; i++)
+    {
+        fv.value.i64 = i;
+        fv.ts += 1;
+        dvsh.AddValue(DCGM_FE_GPU, 2, 1, fv);
+        dvsh.AddValue(DCGM_FE_GPU, 5, 1, fv);
+    }
+
+    fv.fieldType = DCGM_FT_DOUBLE;
+    fv.value.dbl = 0.1;
+    dvsh.AddValue(DCGM_FE_GPU, 5, 2, fv);
+
+    dvsh.AddToJson(jv);
+
+    StatsJsonLinesWriter writer(lines);
+    dvsh.WriteJsonLines(writer);
+
+    REQUIRE(StatsJsonLinesWriter::ConvertToJson(lines, converted, error));
+    // Same file contents. Parsed numbers can differ from the originals in signedness only
+    CHECK(converted.toStyledString() == jv.toStyledString());
+    REQUIRE(converted[c_GPUS].size() == 2);
+    unsigned int const index = converted[c_GPUS][0]["gpuId"].asUInt() == 5 ? 0 : 1;
+    CHECK(converted[c_GPUS][index]["2"][0][c_value].asDouble() == 0.1);
+}
+
 SCENARIO("bool DcgmValuesSinceHolder::DoesValuePassPerSecondThreshold(unsigned short fieldId, "
          "const dcgmFieldValue_v1 &dfv, unsigned int gpuId, const char *fieldName, "
          "std::vector<DcgmError> &errorList, timelib64_t startTime)")
@@ -314,3 +350,65 @@ SCENARIO("bool DcgmValuesSinceHolder::DoesValuePassPerSecondThreshold(unsigned s
     dvsh.AddValue(DCGM_FE_GPU, entityId, fieldId, fv);
     CHECK(dvsh.DoesValuePassPerSecondThreshold(fieldId, threshold, entityId, "field name", errorList, 0));
 }
+
+SCENARIO("DcgmValuesSinceHolder answers from values added over several pulls")
+{
+    std::vector<DcgmError> errorList;
+    DcgmValuesSinceHolder dvsh;
+    dcgmFieldValue_v1 fv         = {};
+    dcgmFieldValue_v1 threshold  = {};
+    const unsigned short fieldId = 1;
+
+    fv.fieldId   = fieldId;
+    fv.fieldType = DCGM_FT_INT64;
+
+    // Counter deltas of 1, 5, 2, 9 and 1. The first at or above 4 is the second one, not the largest
+    const int64_t counters[] = { 0, 1, 6, 8, 17, 18 };
+    for (int64_t counter : counters)
+    {
+        fv.value.i64 = counter;
+        fv.ts += 1000000;
+        dvsh.AddValue(DCGM_FE_GPU, 0, fieldId, fv);
+    }
+
+    threshold.fieldId   = fieldId;
+    threshold.fieldType = DCGM_FT_INT64;
+    threshold.value.i64 = 4;
+    REQUIRE(dvsh.DoesValuePassPerSecondThreshold(fieldId, threshold, 0, "field name", errorList, 0));
+    REQUIRE(errorList.size() == 1);
+    // Reported for the third sample, 3 seconds after startTime
+    CHECK(errorList[0].GetMessage().find("5 at 3.0 seconds") != std::string::npos);
+
+    threshold.value.i64 = 10;
+    CHECK(!dvsh.DoesValuePassPerSecondThreshold(fieldId, threshold, 0, "field name", errorList, 0));
+
+    // Clocks event style bitmasks: each mask finds the first value with one of its bits set
+    const unsigned short maskFieldId = 2;
+    fv.fieldId                       = maskFieldId;
+    const int64_t reasons[]          = { 0, 0x1, 0x1, 0x4, 0x5, 0x8, 0x0, 0x2 };
+    for (int64_t reason : reasons)
+    {
+        fv.value.i64 = reason;
+        fv.ts += 1;
+        dvsh.AddValue(DCGM_FE_GPU, 0, maskFieldId, fv);
+    }
+
+    dcgmFieldValue_v1 found = {};
+    dvsh.GetFirstNonZero(DCGM_FE_GPU, 0, maskFieldId, found, 0x4);
+    CHECK(found.value.i64 == 0x4);
+    memset(&found, 0, sizeof(found));
+    dvsh.GetFirstNonZero(DCGM_FE_GPU, 0, maskFieldId, found, 0xA);
+    CHECK(found.value.i64 == 0x8);
+    memset(&found, 0, sizeof(found));
+    dvsh.GetFirstNonZero(DCGM_FE_GPU, 0, maskFieldId, found, 0x10);
+    CHECK(found.value.i64 == 0);
+
+    // Clearing drops what was learned from the old values
+    dvsh.ClearEntries(DCGM_FE_GPU, 0, maskFieldId);
+    fv.value.i64 = 0x2;
+    fv.ts += 1;
+    dvsh.AddValue(DCGM_FE_GPU, 0, maskFieldId, fv);
+    memset(&found, 0, sizeof(found));
+    dvsh.GetFirstNonZero(DCGM_FE_GPU, 0, maskFieldId, found, 0xA);
+    CHECK(found.value.i64 == 0x2);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch_all.hpp>
+
+#include "GoldenValueCalculator.h"
+
+#include <vector>
+
+namespace
+{
+class GoldenValueCalculatorTester : public GoldenValueCalculator
+{
+public:
+    using GoldenValueCalculator::AddToAllInputs;
+    using GoldenValueCalculator::AddToInputsPerGpu;
+    using GoldenValueCalculator::m_inputs;
+    using GoldenValueCalculator::m_inputsPerGpu;
+};
+} // namespace
+
+TEST_CASE("GoldenValueAccumulator: Mean and variance")
+{
+    GoldenValueAccumulator acc;
+    CHECK(acc.Count() == 0);
+    CHECK(acc.Variance() == 0.0);
+
+    for (double value : { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 })
+    {
+        acc.Add(value);
+    }
+    CHECK(acc.Count() == 8);
+    CHECK(acc.Mean() == Catch::Approx(5.0));
+    CHECK(acc.Variance() == Catch::Approx(4.0));
+}
+
+TEST_CASE("GoldenValueAccumulator: Merged partial results match a single pass")
+{
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++)
+    {
+        values.push_back(1e6 + (i * 37) % 101);
+    }
+
+    GoldenValueAccumulator all;
+    GoldenValueAccumulator parts[3];
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        all.Add(values[i]);
+        parts[i % 3].Add(values[i]);
+    }
+
+    GoldenValueAccumulator merged;
+    merged.Merge(GoldenValueAccumulator {});
+    for (auto const &part : parts)
+    {
+        merged.Merge(part);
+    }
+    CHECK(merged.Count() == all.Count());
+    CHECK(merged.Mean() == Catch::Approx(all.Mean()));
+    CHECK(merged.Variance() == Catch::Approx(all.Variance()));
+}
+
+TEST_CASE("GoldenValueCalculator: Merge")
+{
+    GoldenValueCalculatorTester node1;
+    GoldenValueCalculatorTester node2;
+
+    node1.AddToAllInputs("diagnostic", "perf_gflops", 10.0);
+    node1.AddToInputsPerGpu("diagnostic", "perf_gflops", 0, 10.0);
+    node2.AddToAllInputs("diagnostic", "perf_gflops", 20.0);
+    node2.AddToInputsPerGpu("diagnostic", "perf_gflops", 1, 20.0);
+    node2.AddToAllInputs("pcie", "h2d_bw", 5.0);
+
+    node1.Merge(node2);
+
+    auto const &gflops = node1.m_inputs["diagnostic"]["perf_gflops"];
+    CHECK(gflops.Count() == 2);
+    CHECK(gflops.Mean() == Catch::Approx(15.0));
+    CHECK(gflops.Variance() == Catch::Approx(25.0));
+    CHECK(node1.m_inputs["pcie"]["h2d_bw"].Count() == 1);
+    CHECK(node1.m_inputsPerGpu["diagnostic"]["perf_gflops"].size() == 2);
+    CHECK(node1.m_inputsPerGpu["diagnostic"]["perf_gflops"][1].Mean() == Catch::Approx(20.0));
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <PhaseTimings.h>
+
+#include <chrono>
+#include <thread>
+
+TEST_CASE("PhaseTimings: phases add up")
+{
+    using namespace std::chrono_literals;
+    PhaseTimings timings;
+
+    CHECK(timings.Empty());
+    CHECK(timings.GetUsec("run") == 0);
+
+    timings.Add("run", 1500us);
+    timings.Add("connect", 2ms);
+    timings.Add("run", 500us);
+    CHECK(timings.GetUsec("run") == 2000);
+    CHECK(timings.GetUsec("connect") == 2000);
+
+    Json::Value const json = timings.ToJson();
+    CHECK(json.size() == 2);
+    CHECK(json["run"].asInt64() == 2000);
+    CHECK(json["connect"].asInt64() == 2000);
+
+    timings.Clear();
+    CHECK(timings.Empty());
+    CHECK(timings.ToJson().isObject());
+}
+
+TEST_CASE("PhaseTimings: Scope")
+{
+    PhaseTimings timings;
+    {
+        PhaseTimings::Scope timed(timings, "sleep");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    CHECK(timings.GetUsec("sleep") >= 2000);
+}
@@ -112,4 +112,34 @@ TEST_CASE("Software Subtest Context")
         std::string_view expected = "Subtest: Message. Next Steps. Detail.";
         CHECK(entityResults.errors[0].msg == expected);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Software: checkDriverPathDenylist")
+{
+    dcgmHandle_t handle = (dcgmHandle_t)0;
+    Software s(handle);
+
+    std::unique_ptr<dcgmDiagPluginEntityList_v1> pEntityList = std::make_unique<dcgmDiagPluginEntityList_v1>();
+    std::unique_ptr<dcgmDiagEntityResults_v1> pEntityResults = std::make_unique<dcgmDiagEntityResults_v1>();
+
+    s.InitializeForEntityList(SW_PLUGIN_NAME, *pEntityList);
+
+    std::vector<std::string> const denyList = { "nouveau" };
+
+    Software::DriverLink driverLink;
+    driverLink.path   = "/sys/bus/pci/devices/0000:01:00.0/driver";
+    driverLink.driver = "nvidia";
+    CHECK(s.checkDriverPathDenylist(driverLink, denyList) == 0);
+
+    // Errors reading the link are passed on
+    driverLink.error = EACCES;
+    CHECK(s.checkDriverPathDenylist(driverLink, denyList) == EACCES);
+
+    driverLink.error  = 0;
+    driverLink.driver = "nouveau";
+    CHECK(s.checkDriverPathDenylist(driverLink, denyList) == 1);
+
+    memset(pEntityResults.get(), 0, sizeof(*pEntityResults));
+    dcgmReturn_t ret = s.GetResults(s.GetSoftwareTestName(), pEntityResults.get());
+    CHECK(ret == DCGM_ST_OK);
+    CHECK(pEntityResults->numErrors == 1);
+}
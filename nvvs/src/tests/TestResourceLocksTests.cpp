@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <catch2/catch_all.hpp>
+
+#include <PluginStrings.h>
+#include <TestResourceLocks.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("TestResourceLocks: GetTestResources")
+{
+    CHECK(TestResourceLocks::GetTestResources(PCIE_PLUGIN_NAME) == (TEST_RESOURCE_PCIE | TEST_RESOURCE_NVLINK));
+    CHECK(TestResourceLocks::GetTestResources(TP_PLUGIN_NAME) == TEST_RESOURCE_POWER);
+    CHECK(TestResourceLocks::GetTestResources(CPU_EUD_TEST_NAME) == TEST_RESOURCE_POWER);
+    CHECK(TestResourceLocks::GetTestResources(MEMTEST_PLUGIN_NAME) == TEST_RESOURCE_NONE);
+    CHECK(TestResourceLocks::GetTestResources("not_a_test") == TEST_RESOURCE_NONE);
+}
+
+TEST_CASE("TestResourceLocks: Disjoint tests don't wait")
+{
+    TestResourceLocks locks;
+
+    locks.Acquire(0, TEST_RESOURCE_POWER);
+    /* Would block forever if it had to wait */
+    locks.Acquire(1, TEST_RESOURCE_PCIE | TEST_RESOURCE_NVLINK);
+    locks.Acquire(2, TEST_RESOURCE_NONE);
+
+    locks.Release(0, TEST_RESOURCE_POWER);
+    locks.Release(1, TEST_RESOURCE_PCIE | TEST_RESOURCE_NVLINK);
+    locks.Release(2, TEST_RESOURCE_NONE);
+}
+
+TEST_CASE("TestResourceLocks: Conflicting tests wait")
+{
+    auto waitsFor = [](unsigned int pluginIndex, unsigned int resources) {
+        TestResourceLocks locks;
+        std::atomic_bool acquired = false;
+
+        locks.Acquire(0, TEST_RESOURCE_POWER);
+        std::jthread other([&] {
+            locks.Acquire(pluginIndex, resources);
+            acquired = true;
+            locks.Release(pluginIndex, resources);
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        bool const acquiredWhileHeld = acquired;
+        locks.Release(0, TEST_RESOURCE_POWER);
+        other.join();
+
+        return !acquiredWhileHeld && acquired;
+    };
+
+    SECTION("Same resource")
+    {
+        CHECK(waitsFor(1, TEST_RESOURCE_POWER | TEST_RESOURCE_PCIE));
+    }
+    SECTION("Same plugin")
+    {
+        CHECK(waitsFor(0, TEST_RESOURCE_NONE));
+    }
+}
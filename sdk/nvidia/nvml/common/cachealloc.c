@@ -0,0 +1,518 @@
+#include "cachealloc.h"
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*****************************************************************************/
+#define CACHEALLOC_MAGIC 0xCAC4EA11
+
+/* Bytes at the start of each chunk that hold its cachealloc_chunk_t */
+#define CACHEALLOC_HEADER_BYTES 128
+
+/* Block sizes go from 16 bytes to CACHEALLOC_MAX_BLOCK_BYTES */
+#define CACHEALLOC_MIN_BLOCK_SHIFT 4
+#define CACHEALLOC_MAX_BLOCK_SHIFT 18
+#define CACHEALLOC_NUM_SIZE_CLASSES (CACHEALLOC_MAX_BLOCK_SHIFT - CACHEALLOC_MIN_BLOCK_SHIFT + 1)
+
+/* NUMA nodes that get chunks of their own. Threads on higher nodes share the chunks of node 0 */
+#define CACHEALLOC_MAX_NODES 64
+
+/* How a chunk was mapped */
+#define CACHEALLOC_MAP_HUGETLB 0x1
+#define CACHEALLOC_MAP_THP 0x2
+#define CACHEALLOC_MAP_NUMA_BOUND 0x4
+
+#define CACHEALLOC_ROUND_UP(x, align) (((x) + (align) - 1) & ~((size_t)(align) - 1))
+
+/*****************************************************************************/
+typedef struct cachealloc_chunk_t
+{
+    unsigned int magic;              /* CACHEALLOC_MAGIC */
+    struct cachealloc_pool_t *pool;  /* Pool the chunk belongs to */
+    int sizeClass;                   /* Index of the block size. -1 for a chunk of a single allocation */
+    int nodeIndex;                   /* Index in cachealloc_pool_t::nodes */
+    unsigned int mapFlags;           /* Mask of CACHEALLOC_MAP_? */
+    size_t mappedBytes;              /* Size of the mapping, starting at this struct */
+    size_t blockSize;                /* Bytes of each block. Usable bytes of a single allocation */
+    int numBlocks;                   /* Blocks that fit in the chunk */
+    int usedBlocks;                  /* Blocks handed out at least once. The rest follow them */
+    int liveBlocks;                  /* Blocks handed out and not freed yet */
+    void *freeBlocks;                /* Freed blocks, each pointing at the next */
+    struct cachealloc_chunk_t *prev; /* Chunks with free blocks of the same node and size class */
+    struct cachealloc_chunk_t *next;
+    struct cachealloc_chunk_t *allPrev; /* Every chunk of the pool */
+    struct cachealloc_chunk_t *allNext;
+} cachealloc_chunk_t, *cachealloc_chunk_p;
+
+typedef char cachealloc_header_fits[sizeof(cachealloc_chunk_t) <= CACHEALLOC_HEADER_BYTES ? 1 : -1];
+
+typedef struct cachealloc_node_t
+{
+    cachealloc_chunk_p partial[CACHEALLOC_NUM_SIZE_CLASSES]; /* Chunks with free blocks by size class */
+    cachealloc_chunk_p spare;                                /* Empty chunk kept for reuse. NULL if none */
+} cachealloc_node_t;
+
+typedef struct cachealloc_pool_t
+{
+    unsigned int flags;   /* Mask of CACHEALLOC_F_? */
+    pthread_mutex_t lock; /* Protects everything below */
+    cachealloc_node_t nodes[CACHEALLOC_MAX_NODES];
+    cachealloc_chunk_p chunks; /* Every chunk of the pool */
+    cachealloc_stats_t stats;
+} cachealloc_pool_t;
+
+/*****************************************************************************/
+/* NUMA node the calling thread runs on. -1 if the pool is not NUMA-local or the node is unknown */
+static int cachealloc_current_node(cachealloc_pool_p pool)
+{
+    unsigned int cpu  = 0;
+    unsigned int node = 0;
+
+    if (!(pool->flags & CACHEALLOC_F_NUMA_LOCAL))
+        return -1;
+
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= CACHEALLOC_MAX_NODES)
+        return -1;
+
+    return (int)node;
+}
+
+/*****************************************************************************/
+/* Map bytes at a CACHEALLOC_CHUNK_BYTES boundary. node is the NUMA node to bind them to or -1 */
+static void *cachealloc_map(cachealloc_pool_p pool, size_t bytes, int node, unsigned int *mapFlags)
+{
+    void *addr = MAP_FAILED;
+    unsigned char *raw;
+    size_t head;
+    size_t mapBytes;
+
+    *mapFlags = 0;
+
+#ifdef MAP_HUGETLB
+    if ((pool->flags & CACHEALLOC_F_HUGE_PAGES) && bytes % CACHEALLOC_CHUNK_BYTES == 0)
+    {
+        /* Fails unless enough huge pages are reserved. The mapping is aligned to the default huge page size */
+        addr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED && ((uintptr_t)addr & (CACHEALLOC_CHUNK_BYTES - 1)) != 0)
+        {
+            munmap(addr, bytes);
+            addr = MAP_FAILED;
+        }
+        if (addr != MAP_FAILED)
+            *mapFlags |= CACHEALLOC_MAP_HUGETLB;
+    }
+#endif
+
+    if (addr == MAP_FAILED)
+    {
+        /* Map an extra chunk's worth and trim it down to the aligned part */
+        mapBytes = bytes + CACHEALLOC_CHUNK_BYTES;
+        raw      = (unsigned char *)mmap(NULL, mapBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == (unsigned char *)MAP_FAILED)
+            return NULL;
+
+        head = CACHEALLOC_ROUND_UP((uintptr_t)raw, CACHEALLOC_CHUNK_BYTES) - (uintptr_t)raw;
+        if (head > 0)
+            munmap(raw, head);
+        if (mapBytes - head - bytes > 0)
+            munmap(raw + head + bytes, mapBytes - head - bytes);
+        addr = raw + head;
+
+#ifdef MADV_HUGEPAGE
+        if ((pool->flags & CACHEALLOC_F_HUGE_PAGES) && madvise(addr, bytes, MADV_HUGEPAGE) == 0)
+            *mapFlags |= CACHEALLOC_MAP_THP;
+#endif
+    }
+
+    if (node >= 0)
+    {
+        /* Bind before anything touches the pages. libnuma is not a dependency, so call mbind() directly. The
+           kernel ignores the last bit of maxnode */
+        unsigned long nodeMask[CACHEALLOC_MAX_NODES / (8 * sizeof(unsigned long))] = { 0 };
+        nodeMask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+        if (syscall(SYS_mbind, addr, bytes, MPOL_PREFERRED, nodeMask, CACHEALLOC_MAX_NODES + 1, 0) == 0)
+            *mapFlags |= CACHEALLOC_MAP_NUMA_BOUND;
+    }
+
+    return addr;
+}
+
+/*****************************************************************************/
+/* Map a chunk of bytes and add it to the pool. Must be called with the pool locked */
+static cachealloc_chunk_p cachealloc_chunk_map(cachealloc_pool_p pool, size_t bytes, int node)
+{
+    unsigned int mapFlags;
+    cachealloc_chunk_p chunk = (cachealloc_chunk_p)cachealloc_map(pool, bytes, node, &mapFlags);
+    if (!chunk)
+        return NULL;
+
+    memset(chunk, 0, sizeof(*chunk));
+    chunk->magic       = CACHEALLOC_MAGIC;
+    chunk->pool        = pool;
+    chunk->nodeIndex   = node < 0 ? 0 : node;
+    chunk->mapFlags    = mapFlags;
+    chunk->mappedBytes = bytes;
+
+    chunk->allNext = pool->chunks;
+    if (pool->chunks)
+        pool->chunks->allPrev = chunk;
+    pool->chunks = chunk;
+
+    pool->stats.mappedBytes += (long long)bytes;
+    pool->stats.numChunks++;
+    if (mapFlags & CACHEALLOC_MAP_HUGETLB)
+        pool->stats.hugetlbBytes += (long long)bytes;
+    if (mapFlags & CACHEALLOC_MAP_THP)
+        pool->stats.thpBytes += (long long)bytes;
+    if (mapFlags & CACHEALLOC_MAP_NUMA_BOUND)
+        pool->stats.numaBoundBytes += (long long)bytes;
+
+    return chunk;
+}
+
+/*****************************************************************************/
+/* Remove a chunk from the pool and unmap it. Must be called with the pool locked */
+static void cachealloc_chunk_unmap(cachealloc_pool_p pool, cachealloc_chunk_p chunk)
+{
+    if (chunk->allPrev)
+        chunk->allPrev->allNext = chunk->allNext;
+    else
+        pool->chunks = chunk->allNext;
+    if (chunk->allNext)
+        chunk->allNext->allPrev = chunk->allPrev;
+
+    pool->stats.mappedBytes -= (long long)chunk->mappedBytes;
+    pool->stats.numChunks--;
+    if (chunk->mapFlags & CACHEALLOC_MAP_HUGETLB)
+        pool->stats.hugetlbBytes -= (long long)chunk->mappedBytes;
+    if (chunk->mapFlags & CACHEALLOC_MAP_THP)
+        pool->stats.thpBytes -= (long long)chunk->mappedBytes;
+    if (chunk->mapFlags & CACHEALLOC_MAP_NUMA_BOUND)
+        pool->stats.numaBoundBytes -= (long long)chunk->mappedBytes;
+
+    munmap(chunk, chunk->mappedBytes);
+}
+
+/*****************************************************************************/
+static void cachealloc_partial_add(cachealloc_node_t *node, cachealloc_chunk_p chunk)
+{
+    chunk->prev = NULL;
+    chunk->next = node->partial[chunk->sizeClass];
+    if (chunk->next)
+        chunk->next->prev = chunk;
+    node->partial[chunk->sizeClass] = chunk;
+}
+
+/*****************************************************************************/
+static void cachealloc_partial_remove(cachealloc_node_t *node, cachealloc_chunk_p chunk)
+{
+    if (chunk->prev)
+        chunk->prev->next = chunk->next;
+    else
+        node->partial[chunk->sizeClass] = chunk->next;
+    if (chunk->next)
+        chunk->next->prev = chunk->prev;
+    chunk->prev = NULL;
+    chunk->next = NULL;
+}
+
+/*****************************************************************************/
+static cachealloc_chunk_p cachealloc_chunk_of(void *ptr)
+{
+    return (cachealloc_chunk_p)((uintptr_t)ptr & ~((uintptr_t)CACHEALLOC_CHUNK_BYTES - 1));
+}
+
+/*****************************************************************************/
+cachealloc_pool_p cachealloc_pool_create(unsigned int flags)
+{
+    cachealloc_pool_p pool = (cachealloc_pool_p)malloc(sizeof(*pool));
+    if (!pool)
+        return NULL;
+
+    memset(pool, 0, sizeof(*pool));
+    pool->flags = flags;
+    pthread_mutex_init(&pool->lock, NULL);
+    return pool;
+}
+
+/*****************************************************************************/
+void cachealloc_pool_destroy(cachealloc_pool_p pool)
+{
+    if (!pool)
+        return;
+
+    while (pool->chunks)
+        cachealloc_chunk_unmap(pool, pool->chunks);
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+/*****************************************************************************/
+static void *cachealloc_pool_malloc_single(cachealloc_pool_p pool, size_t size, int node)
+{
+    size_t bytes = CACHEALLOC_ROUND_UP(CACHEALLOC_HEADER_BYTES + size, (size_t)getpagesize());
+    cachealloc_chunk_p chunk;
+
+    /* Round up to whole huge pages once that wastes less than half of one */
+    if ((pool->flags & CACHEALLOC_F_HUGE_PAGES) && bytes > CACHEALLOC_CHUNK_BYTES / 2)
+        bytes = CACHEALLOC_ROUND_UP(bytes, CACHEALLOC_CHUNK_BYTES);
+
+    pthread_mutex_lock(&pool->lock);
+
+    chunk = cachealloc_chunk_map(pool, bytes, node);
+    if (!chunk)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+
+    chunk->sizeClass  = -1;
+    chunk->blockSize  = bytes - CACHEALLOC_HEADER_BYTES;
+    chunk->numBlocks  = 1;
+    chunk->usedBlocks = 1;
+    chunk->liveBlocks = 1;
+    pool->stats.liveBytes += (long long)chunk->blockSize;
+
+    pthread_mutex_unlock(&pool->lock);
+    return (unsigned char *)chunk + CACHEALLOC_HEADER_BYTES;
+}
+
+/*****************************************************************************/
+void *cachealloc_pool_malloc(cachealloc_pool_p pool, size_t size)
+{
+    cachealloc_node_t *nodeInfo;
+    cachealloc_chunk_p chunk;
+    void *block;
+    int sizeClass    = 0;
+    size_t blockSize = (size_t)1 << CACHEALLOC_MIN_BLOCK_SHIFT;
+    int node;
+
+    if (!pool || size == 0)
+        return NULL;
+
+    node = cachealloc_current_node(pool);
+
+    if (size > CACHEALLOC_MAX_BLOCK_BYTES)
+        return cachealloc_pool_malloc_single(pool, size, node);
+
+    while (blockSize < size)
+    {
+        blockSize <<= 1;
+        sizeClass++;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+
+    nodeInfo = &pool->nodes[node < 0 ? 0 : node];
+    chunk    = nodeInfo->partial[sizeClass];
+    if (!chunk)
+    {
+        chunk = nodeInfo->spare;
+        if (chunk)
+            nodeInfo->spare = NULL;
+        else
+            chunk = cachealloc_chunk_map(pool, CACHEALLOC_CHUNK_BYTES, node);
+
+        if (!chunk)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+
+        chunk->sizeClass  = sizeClass;
+        chunk->blockSize  = blockSize;
+        chunk->numBlocks  = (int)((CACHEALLOC_CHUNK_BYTES - CACHEALLOC_HEADER_BYTES) / blockSize);
+        chunk->usedBlocks = 0;
+        chunk->liveBlocks = 0;
+        chunk->freeBlocks = NULL;
+        cachealloc_partial_add(nodeInfo, chunk);
+    }
+
+    if (chunk->freeBlocks)
+    {
+        block             = chunk->freeBlocks;
+        chunk->freeBlocks = *(void **)block;
+    }
+    else
+    {
+        block = (unsigned char *)chunk + CACHEALLOC_HEADER_BYTES + (size_t)chunk->usedBlocks * blockSize;
+        chunk->usedBlocks++;
+    }
+
+    chunk->liveBlocks++;
+    if (chunk->liveBlocks == chunk->numBlocks)
+        cachealloc_partial_remove(nodeInfo, chunk);
+
+    pool->stats.liveBytes += (long long)blockSize;
+
+    pthread_mutex_unlock(&pool->lock);
+    return block;
+}
+
+/*****************************************************************************/
+void cachealloc_pool_free(cachealloc_pool_p pool, void *ptr)
+{
+    cachealloc_chunk_p chunk;
+    cachealloc_node_t *nodeInfo;
+
+    if (!ptr)
+        return;
+
+    /* The pool of the chunk rather than the one passed in. Modules link their own copy of this allocator, and memory
+       allocated by one copy can be freed by another */
+    chunk = cachealloc_chunk_of(ptr);
+    pool  = chunk->pool;
+
+    pthread_mutex_lock(&pool->lock);
+
+    pool->stats.liveBytes -= (long long)chunk->blockSize;
+
+    if (chunk->sizeClass < 0)
+    {
+        cachealloc_chunk_unmap(pool, chunk);
+        pthread_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    nodeInfo = &pool->nodes[chunk->nodeIndex];
+    if (chunk->liveBlocks == chunk->numBlocks)
+        cachealloc_partial_add(nodeInfo, chunk);
+
+    *(void **)ptr     = chunk->freeBlocks;
+    chunk->freeBlocks = ptr;
+    chunk->liveBlocks--;
+
+    if (chunk->liveBlocks == 0)
+    {
+        cachealloc_partial_remove(nodeInfo, chunk);
+        if (!nodeInfo->spare)
+            nodeInfo->spare = chunk;
+        else
+            cachealloc_chunk_unmap(pool, chunk);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/*****************************************************************************/
+void *cachealloc_pool_realloc(cachealloc_pool_p pool, void *ptr, size_t size)
+{
+    size_t usable;
+    void *newPtr;
+
+    if (!ptr)
+        return cachealloc_pool_malloc(pool, size);
+
+    if (size == 0)
+    {
+        cachealloc_pool_free(pool, ptr);
+        return NULL;
+    }
+
+    /* The block size of memory that is handed out doesn't change, so there is no need to lock */
+    usable = cachealloc_chunk_of(ptr)->blockSize;
+    if (size <= usable)
+        return ptr;
+
+    newPtr = cachealloc_pool_malloc(cachealloc_chunk_of(ptr)->pool, size);
+    if (!newPtr)
+        return NULL;
+
+    memcpy(newPtr, ptr, usable);
+    cachealloc_pool_free(pool, ptr);
+    return newPtr;
+}
+
+/*****************************************************************************/
+void cachealloc_pool_stats(cachealloc_pool_p pool, cachealloc_stats_t *stats)
+{
+    if (!stats)
+        return;
+
+    if (!pool)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    *stats = pool->stats;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/*****************************************************************************/
+static pthread_once_t g_cacheallocOnce    = PTHREAD_ONCE_INIT;
+static cachealloc_pool_p g_cacheallocPool = NULL;
+
+/*****************************************************************************/
+static int cachealloc_env_is_set(const char *name)
+{
+    const char *value = getenv(name);
+    return value && strcmp(value, "1") == 0;
+}
+
+/*****************************************************************************/
+static void cachealloc_init_global(void)
+{
+    unsigned int flags = 0;
+
+    if (cachealloc_env_is_set(CACHEALLOC_ENV_HUGE_PAGES))
+        flags |= CACHEALLOC_F_HUGE_PAGES;
+    if (cachealloc_env_is_set(CACHEALLOC_ENV_NUMA_LOCAL))
+        flags |= CACHEALLOC_F_NUMA_LOCAL;
+
+    /* Stays NULL, and passes through to the C library, if no flags are set. Whether memory came from the pool is
+       decided once so that it is always freed the way it was allocated */
+    if (flags)
+        g_cacheallocPool = cachealloc_pool_create(flags);
+}
+
+/*****************************************************************************/
+static cachealloc_pool_p cachealloc_global(void)
+{
+    pthread_once(&g_cacheallocOnce, cachealloc_init_global);
+    return g_cacheallocPool;
+}
+
+/*****************************************************************************/
+void *cachealloc_malloc(size_t size)
+{
+    cachealloc_pool_p pool = cachealloc_global();
+    return pool ? cachealloc_pool_malloc(pool, size) : malloc(size);
+}
+
+/*****************************************************************************/
+void *cachealloc_realloc(void *ptr, size_t size)
+{
+    cachealloc_pool_p pool = cachealloc_global();
+    return pool ? cachealloc_pool_realloc(pool, ptr, size) : realloc(ptr, size);
+}
+
+/*****************************************************************************/
+void cachealloc_free(void *ptr)
+{
+    cachealloc_pool_p pool = cachealloc_global();
+    if (pool)
+        cachealloc_pool_free(pool, ptr);
+    else
+        free(ptr);
+}
+
+/*****************************************************************************/
+unsigned int cachealloc_flags(void)
+{
+    cachealloc_pool_p pool = cachealloc_global();
+    return pool ? pool->flags : 0;
+}
+
+/*****************************************************************************/
+void cachealloc_stats(cachealloc_stats_t *stats)
+{
+    cachealloc_pool_stats(cachealloc_global(), stats);
+}
@@ -0,0 +1,130 @@
+/*
+ * cachealloc.h
+ *
+ * Allocator for the large, long-lived structures of the cache manager: the
+ * blocks of keyedvectors and timeseries rings, the update thread context and
+ * the buffers of DcgmFvBuffer.
+ *
+ * Memory comes from 2 MB-aligned chunks that can be backed by huge pages and
+ * bound to the NUMA node of the thread that allocates them, which is the
+ * thread that keeps updating them.
+ */
+
+#ifndef CACHEALLOC_H
+#define CACHEALLOC_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*****************************************************************************/
+/* Flags of a pool */
+#define CACHEALLOC_F_HUGE_PAGES 0x1 /* Back chunks with huge pages. Pages reserved in hugetlbfs are used when there
+                                       are any. Otherwise the chunks are advised to be backed by transparent huge
+                                       pages */
+#define CACHEALLOC_F_NUMA_LOCAL 0x2 /* Keep the chunks of each NUMA node apart and bind them to their node. A thread
+                                       gets memory from the node it runs on */
+
+/* Environment variables that turn on the flags of the process-wide pool when set to 1. They are read by the first
+   call to cachealloc_malloc() */
+#define CACHEALLOC_ENV_HUGE_PAGES "__DCGM_CACHE_HUGE_PAGES__"
+#define CACHEALLOC_ENV_NUMA_LOCAL "__DCGM_CACHE_NUMA_LOCAL__"
+
+/* Size and alignment of a chunk, which is the size of a huge page on x86_64 and aarch64 with 4 KB pages */
+#define CACHEALLOC_CHUNK_BYTES (2 * 1024 * 1024)
+
+/* Largest allocation carved from a shared chunk. Larger ones get chunks of their own */
+#define CACHEALLOC_MAX_BLOCK_BYTES (256 * 1024)
+
+    /*****************************************************************************/
+    /*
+ * Allocations of up to CACHEALLOC_MAX_BLOCK_BYTES are rounded up to a power of
+ * two and carved from chunks that only hold blocks of that size. A chunk is
+ * returned to the kernel once all of its blocks are freed, except for one empty
+ * chunk per NUMA node that is kept for reuse.
+ */
+    typedef struct cachealloc_pool_t *cachealloc_pool_p;
+
+    /*****************************************************************************/
+    /* Page usage of a pool */
+    typedef struct cachealloc_stats_t
+    {
+        long long mappedBytes;    /* Bytes mapped for chunks */
+        long long liveBytes;      /* Bytes handed out and not freed yet, rounded up to their block size */
+        long long hugetlbBytes;   /* Bytes of mappedBytes backed by reserved huge pages */
+        long long thpBytes;       /* Bytes of mappedBytes advised to be backed by transparent huge pages. Whether
+                                     the kernel did is in AnonHugePages of /proc/self/smaps */
+        long long numaBoundBytes; /* Bytes of mappedBytes bound to the NUMA node of the thread that mapped them */
+        long long numChunks;      /* Chunks mapped, including the ones of single allocations */
+    } cachealloc_stats_t;
+
+    /*****************************************************************************/
+    /*
+ * Create a pool
+ *
+ * flags IN: Mask of CACHEALLOC_F_? flags
+ *
+ * Returns the pool on success
+ *         NULL if out of memory
+ */
+    cachealloc_pool_p cachealloc_pool_create(unsigned int flags);
+
+    /*****************************************************************************/
+    /* Unmap every chunk of the pool, including the ones of allocations that were not freed, and free the pool */
+    void cachealloc_pool_destroy(cachealloc_pool_p pool);
+
+    /*****************************************************************************/
+    /*
+ * Allocate size bytes from a pool
+ *
+ * Returns pointer to the memory on success. The memory is 16-byte aligned
+ *         NULL if size is 0 or out of memory
+ */
+    void *cachealloc_pool_malloc(cachealloc_pool_p pool, size_t size);
+
+    /*****************************************************************************/
+    /*
+ * realloc() for memory of a pool. Memory stays in place as long as size fits
+ * in its block. pool is only used if ptr is NULL
+ */
+    void *cachealloc_pool_realloc(cachealloc_pool_p pool, void *ptr, size_t size);
+
+    /*****************************************************************************/
+    /*
+ * Release memory returned by cachealloc_pool_malloc() or
+ * cachealloc_pool_realloc(). The memory goes back to the pool it came from,
+ * whichever pool is passed. ptr can be NULL
+ */
+    void cachealloc_pool_free(cachealloc_pool_p pool, void *ptr);
+
+    /*****************************************************************************/
+    void cachealloc_pool_stats(cachealloc_pool_p pool, cachealloc_stats_t *stats);
+
+    /*****************************************************************************/
+    /*
+ * malloc(), realloc() and free() of the process-wide pool. Its flags come
+ * from CACHEALLOC_ENV_HUGE_PAGES and CACHEALLOC_ENV_NUMA_LOCAL. Without any,
+ * these call the C library directly.
+ */
+    void *cachealloc_malloc(size_t size);
+    void *cachealloc_realloc(void *ptr, size_t size);
+    void cachealloc_free(void *ptr);
+
+    /*****************************************************************************/
+    /*
+ * Flags of the process-wide pool. 0 if it passes through to the C library
+ */
+    unsigned int cachealloc_flags(void);
+
+    /*****************************************************************************/
+    /* Page usage of the process-wide pool. All 0 if it passes through to the C library */
+    void cachealloc_stats(cachealloc_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CACHEALLOC_H */
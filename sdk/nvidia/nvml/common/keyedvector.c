@@ -141,7 +141,7 @@ void keyedvector_destroy(keyedvector_p kv)
 
     if (kv->blockNelem)
     {
-        free(kv->blockNelem);
+        kv_free(kv->blockNelem);
         kv->blockNelem = 0;
     }
 
@@ -588,6 +588,55 @@ int keyedvector_insert(keyedvector_p kv, void *element, kv_cursor_p cursor)
     return KV_ST_OK;
 }
 
+/*****************************************************************************/
+int keyedvector_append(keyedvector_p kv, void *elements, int Nelements)
+{
+    int elementsPerBlock, lastBlock, Nappended;
+    int st;
+    char *element, *previous, *block;
+    kv_cursor_t cursor;
+
+    if (!kv || Nelements < 0 || (!elements && Nelements > 0))
+        return KV_ST_BADPARAM;
+
+    elementsPerBlock = kv->subBlockSize / kv->elemSize;
+    previous         = (char *)keyedvector_last(kv, &cursor);
+    element          = (char *)elements;
+
+    for (Nappended = 0; Nappended < Nelements; Nappended++, element += kv->elemSize)
+    {
+        if (previous && kv->compareCB(element, previous) <= 0)
+            break; /* Not past the end. Has to be inserted by the caller */
+
+        lastBlock = kv->Nblocks - 1;
+        if (kv->blockNelem[lastBlock] >= elementsPerBlock)
+        {
+            /* Last block is full. Start a new one after it */
+            if (kv->Nblocks >= kv->maxBlocks)
+            {
+                st = keyedvector_grow_blocks(kv, kv->maxBlocks * 2);
+                if (st)
+                    return st;
+            }
+
+            lastBlock++;
+            kv->blocks[lastBlock] = kv_malloc(kv->subBlockSize);
+            if (!kv->blocks[lastBlock])
+                return KV_ST_MEMORY;
+            kv->blockNelem[lastBlock] = 0;
+            kv->Nblocks++;
+        }
+
+        block    = (char *)kv->blocks[lastBlock];
+        previous = &block[kv->blockNelem[lastBlock] * kv->elemSize];
+        memcpy(previous, element, kv->elemSize);
+        kv->blockNelem[lastBlock]++;
+        kv->Nelem++;
+    }
+
+    return Nappended;
+}
+
 /*****************************************************************************/
 void *keyedvector_prev(keyedvector_p kv, kv_cursor_p cursor)
 {
@@ -1038,6 +1087,69 @@ int keyedvector_remove_range_by_cursor(keyedvector_p kv, kv_cursor_p startCursor
     return KV_ST_OK;
 }
 
+/*****************************************************************************/
+int keyedvector_truncate_head(keyedvector_p kv, int Nelements)
+{
+    int NwholeBlocks, NfromFirstBlock, Nremaining;
+    int blockIndex, subIndex;
+    char *block;
+
+    if (!kv || Nelements < 0)
+        return KV_ST_BADPARAM;
+
+    if (!Nelements)
+        return KV_ST_OK;
+    if (Nelements >= kv->Nelem)
+        return keyedvector_remove_range_by_cursor(kv, NULL, NULL);
+
+    /* Count the leading blocks that are entirely removed. At least one element is kept, so this stops before the
+       last block */
+    NwholeBlocks    = 0;
+    NfromFirstBlock = Nelements;
+    while (kv->blockNelem[NwholeBlocks] <= NfromFirstBlock)
+    {
+        NfromFirstBlock -= kv->blockNelem[NwholeBlocks];
+        NwholeBlocks++;
+    }
+
+    if (kv->freeCB)
+    {
+        for (blockIndex = 0; blockIndex <= NwholeBlocks; blockIndex++)
+        {
+            block      = (char *)kv->blocks[blockIndex];
+            Nremaining = blockIndex < NwholeBlocks ? kv->blockNelem[blockIndex] : NfromFirstBlock;
+            for (subIndex = 0; subIndex < Nremaining; subIndex++)
+                kv->freeCB(&block[subIndex * kv->elemSize], kv->user);
+        }
+    }
+
+    if (NwholeBlocks > 0)
+    {
+        for (blockIndex = 0; blockIndex < NwholeBlocks; blockIndex++)
+        {
+            kv->Nelem -= kv->blockNelem[blockIndex];
+            kv_free(kv->blocks[blockIndex]);
+        }
+
+        Nremaining = kv->Nblocks - NwholeBlocks;
+        memmove(&kv->blocks[0], &kv->blocks[NwholeBlocks], sizeof(kv->blocks[0]) * Nremaining);
+        memmove(&kv->blockNelem[0], &kv->blockNelem[NwholeBlocks], sizeof(kv->blockNelem[0]) * Nremaining);
+        memset(&kv->blocks[Nremaining], 0, sizeof(kv->blocks[0]) * NwholeBlocks);
+        memset(&kv->blockNelem[Nremaining], 0, sizeof(kv->blockNelem[0]) * NwholeBlocks);
+        kv->Nblocks = Nremaining;
+    }
+
+    if (NfromFirstBlock > 0)
+    {
+        block = (char *)kv->blocks[0];
+        memmove(block, &block[NfromFirstBlock * kv->elemSize], (kv->blockNelem[0] - NfromFirstBlock) * kv->elemSize);
+        kv->blockNelem[0] -= NfromFirstBlock;
+        kv->Nelem -= NfromFirstBlock;
+    }
+
+    return KV_ST_OK;
+}
+
 /*****************************************************************************/
 int keyedvector_remove(keyedvector_p kv, void *key)
 {
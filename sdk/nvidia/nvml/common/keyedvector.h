@@ -16,9 +16,10 @@ extern "C"
 /* Use macros for alloc/free to allow redefining for other projects. 
    Redefine all malloc/frees if you redefine one */
 #ifndef kv_malloc
-#define kv_malloc malloc
-#define kv_free free
-#define kv_realloc realloc
+#include "cachealloc.h"
+#define kv_malloc cachealloc_malloc
+#define kv_free cachealloc_free
+#define kv_realloc cachealloc_realloc
 #endif //kv_malloc
 
 /* Status codes */
@@ -209,6 +210,23 @@ Returns: 0 if OK (including if a successful merge occurred via mergeCB)
 */
     int keyedvector_insert(keyedvector_p kv, void *element, kv_cursor_p cursor);
 
+    /*************************************************************************/
+    /*
+Append elements after the last element without searching for where they go.
+elements is an array of Nelements elements sorted by key. They are copied into
+the last block, and into new blocks once it is full.
+
+Appending stops at the first element that doesn't come after the one before
+it (or after the last element of the collection for the first one). The rest
+have to go through keyedvector_insert(), which also merges duplicates.
+
+Note that this operation invalidates other cursors
+
+Returns: >= 0 Number of elements that were appended
+          <0 KV_ST_? #define on error
+*/
+    int keyedvector_append(keyedvector_p kv, void *elements, int Nelements);
+
     /*************************************************************************/
     /*
 Remove an element by key
@@ -246,6 +264,19 @@ Returns: 0 if OK
         <0 KV_ST_? #define on error
 */
 
+    /*************************************************************************/
+    /*
+Remove the first Nelements elements. This is the same as removing the range
+from the first element to element Nelements-1, but without finding either of
+them: the leading blocks that are entirely removed are freed, the blocks after
+them are moved forward at once and only the elements left in the new first
+block are moved. Removing more elements than there are empties the collection
+
+Returns: 0 if OK
+        <0 KV_ST_? #define on error
+*/
+    int keyedvector_truncate_head(keyedvector_p kv, int Nelements);
+
     /*************************************************************************/
     /*
 Return the number of elements in the collection
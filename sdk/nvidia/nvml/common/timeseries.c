@@ -1,5 +1,8 @@
 
 #include "timeseries.h"
+#include "cachealloc.h"
+#include "timeseries_arena.h"
+#include "timeseries_compressed.h"
 #include "logging.h"
 #include "nvcmvalue.h"
 #include <stdlib.h>
@@ -39,13 +42,155 @@ static void timeseries_freeCB(timeseries_entry_p elem, timeseries_p ts)
     /* Free any allocated memory within the element that is being freed */
     if (ts->tsType == TS_TYPE_STRING || ts->tsType == TS_TYPE_BLOB)
     {
-        if (elem->val.ptr)
+        if (elem->val.ptr && ts->arena)
+            timeseries_arena_free(ts->arena, elem->val.ptr);
+        else if (elem->val.ptr)
             free(elem->val.ptr);
         elem->val.ptr      = 0;
         elem->val2.ptrSize = 0;
     }
 }
 
+/*****************************************************************************/
+/* Ring buffer helpers. Indexes passed to these are logical (0 = oldest) */
+static timeseries_entry_p timeseries_ring_at(timeseries_ring_p ring, int index)
+{
+    return &ring->entries[(ring->head + index) % ring->capacity];
+}
+
+/*****************************************************************************/
+/* Return the logical index of the first entry >= time (lower bound) */
+static int timeseries_ring_lower_bound(timeseries_ring_p ring, timelib64_t time)
+{
+    int low  = 0;
+    int high = ring->count;
+
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (timeseries_ring_at(ring, mid)->usecSince1970 < time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+/*****************************************************************************/
+/* Double the capacity of the ring, moving the entries to the start of the new array */
+static int timeseries_ring_grow(timeseries_ring_p ring)
+{
+    int i;
+    int newCapacity                = ring->capacity * 2;
+    timeseries_entry_t *newEntries
+        = (timeseries_entry_t *)cachealloc_malloc(sizeof(timeseries_entry_t) * newCapacity);
+    if (!newEntries)
+        return TS_ST_MEMORY;
+
+    for (i = 0; i < ring->count; i++)
+        newEntries[i] = *timeseries_ring_at(ring, i);
+
+    cachealloc_free(ring->entries);
+    ring->entries  = newEntries;
+    ring->capacity = newCapacity;
+    ring->head     = 0;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+static int timeseries_ring_insert(timeseries_ring_p ring, timeseries_entry_p entry)
+{
+    int index, i;
+
+    if (ring->count == ring->capacity)
+    {
+        int st = timeseries_ring_grow(ring);
+        if (st)
+            return st;
+    }
+
+    /* Fast path: appending in time order is O(1) */
+    if (!ring->count || timeseries_ring_at(ring, ring->count - 1)->usecSince1970 < entry->usecSince1970)
+    {
+        *timeseries_ring_at(ring, ring->count) = *entry;
+        ring->count++;
+        return TS_ST_OK;
+    }
+
+    /* Out of order. Resolve duplicate timestamps the same way the keyedvector path does,
+       by incrementing the timestamp until it is unique */
+    index = timeseries_ring_lower_bound(ring, entry->usecSince1970);
+    while (index < ring->count && timeseries_ring_at(ring, index)->usecSince1970 == entry->usecSince1970)
+    {
+        entry->usecSince1970++;
+        index++;
+    }
+
+    /* Shift newer entries up by one to make room */
+    for (i = ring->count; i > index; i--)
+        *timeseries_ring_at(ring, i) = *timeseries_ring_at(ring, i - 1);
+
+    *timeseries_ring_at(ring, index) = *entry;
+    ring->count++;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+static timeseries_entry_p timeseries_ring_cursor_entry(timeseries_ring_p ring, timeseries_cursor_p cursor, int index)
+{
+    cursor->blockIndex = 0;
+    if (index < 0)
+    {
+        cursor->subIndex = KV_CURSOR_BEFORE;
+        return NULL;
+    }
+    else if (index >= ring->count)
+    {
+        cursor->subIndex = KV_CURSOR_AFTER;
+        return NULL;
+    }
+
+    cursor->subIndex = index;
+    return timeseries_ring_at(ring, index);
+}
+
+/*****************************************************************************/
+static timeseries_entry_p timeseries_ring_find(timeseries_ring_p ring,
+                                               timelib64_t time,
+                                               int findOp,
+                                               timeseries_cursor_p cursor)
+{
+    int index = timeseries_ring_lower_bound(ring, time);
+    int exact = index < ring->count && timeseries_ring_at(ring, index)->usecSince1970 == time;
+
+    switch (findOp)
+    {
+        case TS_LGE_EQUAL:
+            if (!exact)
+                index = ring->count;
+            break;
+        case TS_LGE_LESSEQUAL:
+            if (!exact)
+                index--;
+            break;
+        case TS_LGE_GREATEQUAL:
+            break;
+        case TS_LGE_LESS:
+            index--;
+            break;
+        case TS_LGE_GREATER:
+            if (exact)
+                index++;
+            break;
+        default:
+            index = ring->count;
+            break;
+    }
+
+    return timeseries_ring_cursor_entry(ring, cursor, index);
+}
+
 /*****************************************************************************/
 void timeseries_destroy(timeseries_p ts)
 {
@@ -58,6 +203,26 @@ void timeseries_destroy(timeseries_p ts)
         ts->keyedVector = 0;
     }
 
+    if (ts->ring)
+    {
+        cachealloc_free(ts->ring->entries);
+        free(ts->ring);
+        ts->ring = 0;
+    }
+
+    if (ts->compressed)
+    {
+        timeseries_compressed_destroy(ts->compressed);
+        ts->compressed = 0;
+    }
+
+    /* After the keyedvector, whose free callback releases into the arena */
+    if (ts->arena)
+    {
+        timeseries_arena_destroy(ts->arena);
+        ts->arena = 0;
+    }
+
     free(ts);
 }
 
@@ -106,10 +271,127 @@ timeseries_p timeseries_alloc(int tsType, int *errorSt)
     return ts;
 }
 
+/*****************************************************************************/
+timeseries_p timeseries_alloc_ring(int tsType, int capacity, int *errorSt)
+{
+    timeseries_p ts = 0;
+
+    if (!errorSt)
+        return NULL;
+
+    *errorSt = TS_ST_OK;
+
+    if ((tsType != TS_TYPE_INT64 && tsType != TS_TYPE_DOUBLE) || capacity < 1)
+    {
+        *errorSt = TS_ST_BADPARAM;
+        return NULL;
+    }
+
+    ts = (timeseries_p)malloc(sizeof(*ts));
+    if (!ts)
+    {
+        *errorSt = TS_ST_MEMORY;
+        return NULL;
+    }
+    memset(ts, 0, sizeof(*ts));
+
+    ts->tsType = tsType;
+
+    ts->ring = (timeseries_ring_p)malloc(sizeof(*ts->ring));
+    if (!ts->ring)
+    {
+        *errorSt = TS_ST_MEMORY;
+        timeseries_destroy(ts);
+        return NULL;
+    }
+    memset(ts->ring, 0, sizeof(*ts->ring));
+
+    ts->ring->entries = (timeseries_entry_t *)cachealloc_malloc(sizeof(timeseries_entry_t) * capacity);
+    if (!ts->ring->entries)
+    {
+        *errorSt = TS_ST_MEMORY;
+        timeseries_destroy(ts);
+        return NULL;
+    }
+    ts->ring->capacity = capacity;
+
+    return ts;
+}
+
+/*****************************************************************************/
+timeseries_p timeseries_alloc_compressed(int tsType, int *errorSt)
+{
+    timeseries_p ts = 0;
+
+    if (!errorSt)
+        return NULL;
+
+    *errorSt = TS_ST_OK;
+
+    if (tsType != TS_TYPE_INT64 && tsType != TS_TYPE_DOUBLE)
+    {
+        *errorSt = TS_ST_BADPARAM;
+        return NULL;
+    }
+
+    ts = (timeseries_p)malloc(sizeof(*ts));
+    if (!ts)
+    {
+        *errorSt = TS_ST_MEMORY;
+        return NULL;
+    }
+    memset(ts, 0, sizeof(*ts));
+
+    ts->tsType     = tsType;
+    ts->compressed = timeseries_compressed_alloc(errorSt);
+    if (!ts->compressed)
+    {
+        timeseries_destroy(ts);
+        return NULL;
+    }
+
+    return ts;
+}
+
+/*****************************************************************************/
+timeseries_p timeseries_alloc_arena(int tsType, int *errorSt)
+{
+    timeseries_p ts = 0;
+
+    if (!errorSt)
+        return NULL;
+
+    if (tsType != TS_TYPE_STRING && tsType != TS_TYPE_BLOB)
+    {
+        *errorSt = TS_ST_BADPARAM;
+        return NULL;
+    }
+
+    ts = timeseries_alloc(tsType, errorSt);
+    if (!ts)
+        return NULL;
+
+    ts->arena = timeseries_arena_alloc();
+    if (!ts->arena)
+    {
+        *errorSt = TS_ST_MEMORY;
+        timeseries_destroy(ts);
+        return NULL;
+    }
+
+    return ts;
+}
+
 /*****************************************************************************/
 int timeseries_size(timeseries_p ts)
 {
-    if (!ts || !ts->keyedVector)
+    if (!ts)
+        return 0;
+    if (ts->ring)
+        return ts->ring->count;
+    if (ts->compressed)
+        return ts->compressed->count;
+    if (!ts->keyedVector)
         return 0;
 
     return keyedvector_size(ts->keyedVector);
@@ -126,6 +408,11 @@ static int timeseries_insert(timeseries_p ts, timeseries_entry_p entry)
     if (!entry->usecSince1970)
         entry->usecSince1970 = timelib_usecSince1970();
 
+    if (ts->ring)
+        return timeseries_ring_insert(ts->ring, entry);
+    if (ts->compressed)
+        return timeseries_compressed_insert(ts->compressed, entry);
+
     for (tries = 0; tries < maxTries; tries++)
     {
         insertSt = keyedvector_insert(ts->keyedVector, entry, &cursor);
@@ -147,6 +434,49 @@ static int timeseries_insert(timeseries_p ts, timeseries_entry_p entry)
     return TS_ST_UNKNOWN;
 }
 
+/*****************************************************************************/
+int timeseries_append(timeseries_p ts, timeseries_entry_p entries, int Nentries)
+{
+    int i, Nappended = 0;
+    int st;
+    timelib64_t now = 0;
+
+    if (!ts || Nentries < 0 || (!entries && Nentries > 0))
+        return TS_ST_BADPARAM;
+    if (ts->tsType != TS_TYPE_INT64 && ts->tsType != TS_TYPE_DOUBLE)
+        return TS_ST_WRONGTYPE;
+
+    for (i = 0; i < Nentries; i++)
+    {
+        if (!entries[i].usecSince1970)
+        {
+            if (!now)
+                now = timelib_usecSince1970();
+            entries[i].usecSince1970 = now;
+        }
+    }
+
+    if (ts->keyedVector)
+    {
+        Nappended = keyedvector_append(ts->keyedVector, entries, Nentries);
+        if (Nappended < 0)
+        {
+            PRINT_ERROR("%d", "Error %d from keyedvector_append\n", Nappended);
+            return TS_ST_UNKNOWN;
+        }
+    }
+
+    /* Entries that didn't go past the end take the slow path, which also resolves duplicate timestamps */
+    for (i = Nappended; i < Nentries; i++)
+    {
+        st = timeseries_insert(ts, &entries[i]);
+        if (st)
+            return st;
+    }
+
+    return TS_ST_OK;
+}
+
 /*****************************************************************************/
 int timeseries_insert_int64(timeseries_p ts, timelib64_t timestamp, long long value1, long long value2)
 {
@@ -165,6 +495,28 @@ int timeseries_insert_int64(timeseries_p ts, timelib64_t timestamp, long long va
     return retSt;
 }
 
+/*****************************************************************************/
+/*
+ * Arena series share one value between consecutive samples that are equal.
+ * Returns the newest value if it matches value/valueSize, NULL otherwise
+ */
+static void *timeseries_arena_share(timeseries_p ts, const void *value, long long valueSize)
+{
+    timeseries_cursor_t cursor;
+    timeseries_entry_p newest;
+
+    if (!ts->arena || !ts->keyedVector)
+        return NULL;
+
+    newest = (timeseries_entry_p)keyedvector_last(ts->keyedVector, &cursor);
+    if (!newest || !newest->val.ptr || newest->val2.ptrSize != valueSize
+        || memcmp(newest->val.ptr, value, valueSize) != 0)
+        return NULL;
+
+    timeseries_arena_retain(ts->arena, newest->val.ptr);
+    return newest->val.ptr;
+}
+
 /*****************************************************************************/
 int timeseries_insert_string(timeseries_p ts, timelib64_t timestamp, const char *value)
 {
@@ -177,9 +529,18 @@ int timeseries_insert_string(timeseries_p ts, timelib64_t timestamp, const char
         return TS_ST_WRONGTYPE;
 
     entry.usecSince1970 = timestamp;
-    entry.val.ptr       = strdup(value);
     entry.val2.ptrSize  = strlen(value) + 1;
-    retSt               = timeseries_insert(ts, &entry);
+    entry.val.ptr       = timeseries_arena_share(ts, value, entry.val2.ptrSize);
+    if (!entry.val.ptr && ts->arena)
+    {
+        entry.val.ptr = timeseries_arena_malloc(ts->arena, entry.val2.ptrSize);
+        if (!entry.val.ptr)
+            return TS_ST_MEMORY;
+        memcpy(entry.val.ptr, value, entry.val2.ptrSize);
+    }
+    else if (!entry.val.ptr)
+        entry.val.ptr = strdup(value);
+    retSt = timeseries_insert(ts, &entry);
     return retSt;
 }
 
@@ -195,11 +556,18 @@ int timeseries_insert_blob(timeseries_p ts, timelib64_t timestamp, void *value,
         return TS_ST_WRONGTYPE;
 
     entry.usecSince1970 = timestamp;
-    entry.val.ptr       = malloc(valueSize);
+    entry.val.ptr       = timeseries_arena_share(ts, value, valueSize);
     if (!entry.val.ptr)
-        return TS_ST_MEMORY;
-
-    memcpy(entry.val.ptr, value, valueSize);
+    {
+        if (ts->arena)
+            entry.val.ptr = timeseries_arena_malloc(ts->arena, valueSize);
+        else
+            entry.val.ptr = malloc(valueSize);
+        if (!entry.val.ptr)
+            return TS_ST_MEMORY;
+
+        memcpy(entry.val.ptr, value, valueSize);
+    }
 
     entry.val2.ptrSize = valueSize;
     retSt              = timeseries_insert(ts, &entry);
@@ -245,7 +613,7 @@ int timeseries_insert_double(timeseries_p ts, timelib64_t timestamp, double valu
     int retSt;
     timeseries_entry_t entry;
 
-    if (!ts || !ts->keyedVector)
+    if (!ts)
         return TS_ST_BADPARAM;
     if (ts->tsType != TS_TYPE_DOUBLE)
         return TS_ST_WRONGTYPE;
@@ -263,7 +631,7 @@ int timeseries_insert_double_coerce(timeseries_p ts, timelib64_t timestamp, doub
     int retSt;
     timeseries_entry_t entry;
 
-    if (!ts || !ts->keyedVector)
+    if (!ts)
         return TS_ST_BADPARAM;
 
     switch (ts->tsType)
@@ -291,33 +659,58 @@ int timeseries_insert_double_coerce(timeseries_p ts, timelib64_t timestamp, doub
 /*****************************************************************************/
 int timeseries_enforce_quota(timeseries_p ts, timelib64_t oldestKeepTimestamp, int maxKeepEntries)
 {
-    timeseries_entry_t key, *elem;
-    kv_cursor_t firstElemCursor;
-    kv_cursor_t lastDeleteCursor;
+    timeseries_entry_t *elem;
+    kv_cursor_t cursor;
     int st;
     int currentCount, NtoDelete;
 
-    if (!ts || !ts->keyedVector)
+    if (!ts)
         return TS_ST_BADPARAM;
 
-    memset(&key, 0, sizeof(key));
+    if (ts->ring)
+    {
+        timeseries_ring_p ring = ts->ring;
+
+        /* Evicting from the head of the ring is O(1) per entry and doesn't free anything */
+        while (oldestKeepTimestamp && ring->count && timeseries_ring_at(ring, 0)->usecSince1970 < oldestKeepTimestamp)
+        {
+            ring->head = (ring->head + 1) % ring->capacity;
+            ring->count--;
+        }
+
+        if (maxKeepEntries && ring->count > maxKeepEntries)
+        {
+            ring->head  = (ring->head + ring->count - maxKeepEntries) % ring->capacity;
+            ring->count = maxKeepEntries;
+        }
+
+        return TS_ST_OK;
+    }
+
+    if (ts->compressed)
+        return timeseries_compressed_enforce_quota(ts->compressed, oldestKeepTimestamp, maxKeepEntries);
+
+    if (!ts->keyedVector)
+        return TS_ST_BADPARAM;
 
-    elem = (timeseries_entry_t *)keyedvector_first(ts->keyedVector, &firstElemCursor);
+    elem = (timeseries_entry_t *)keyedvector_first(ts->keyedVector, &cursor);
     if (!elem)
         return TS_ST_OK; /* Nothing to do */
 
-    /* Timestamp enforcement */
+    /* Timestamp enforcement. Samples are evicted from the head about as fast as they are appended, so walking the
+       expired ones is cheaper than searching for the oldest one to keep */
     if (oldestKeepTimestamp && elem->usecSince1970 < oldestKeepTimestamp)
     {
-        key.usecSince1970 = oldestKeepTimestamp;
-        elem = (timeseries_entry_t *)keyedvector_find_by_key(ts->keyedVector, &key, KV_LGE_LESS, &lastDeleteCursor);
-        /* If elem is null, there is nothing to free less than our timestamp */
-        if (elem)
+        NtoDelete = 0;
+        while (elem && elem->usecSince1970 < oldestKeepTimestamp)
         {
-            st = keyedvector_remove_range_by_cursor(ts->keyedVector, &firstElemCursor, &lastDeleteCursor);
-            if (st)
-                return st;
+            NtoDelete++;
+            elem = (timeseries_entry_t *)keyedvector_next(ts->keyedVector, &cursor);
         }
+
+        st = keyedvector_truncate_head(ts->keyedVector, NtoDelete);
+        if (st)
+            return st;
     }
 
     /* Check (or recheck) the size to make sure we're under our quota */
@@ -332,17 +725,8 @@ int timeseries_enforce_quota(timeseries_p ts, timelib64_t oldestKeepTimestamp, i
 
     NtoDelete = currentCount - maxKeepEntries;
 
-    /* Refind the first element in case elements were deleted above */
-    elem = (timeseries_entry_t *)keyedvector_first(ts->keyedVector, &firstElemCursor);
-    if (!elem)
-        return TS_ST_OK; /* Nothing to do */
-
-    elem = (timeseries_entry_t *)keyedvector_find_by_index(ts->keyedVector, NtoDelete - 1, &lastDeleteCursor);
-    if (!elem)
-        return TS_ST_OK; /* Nothing to do */
-
     /* Delete the elements from the first to elem[NtoDelete] */
-    st = keyedvector_remove_range_by_cursor(ts->keyedVector, &firstElemCursor, &lastDeleteCursor);
+    st = keyedvector_truncate_head(ts->keyedVector, NtoDelete);
     if (st)
         return st;
 
@@ -362,12 +746,11 @@ timeseries_simple_calc_int64(timeseries_p ts, int tsCalc, timelib64_t startTime,
     long long retVal = TS_EMPTY_INT64;
     int Nsamples     = 0;
     kv_cursor_t cursor;
-    timeseries_entry_t searchEntry;
     timeseries_entry_p elem;
 
     if (!errorSt)
         return TS_EMPTY_INT64;
-    if (!ts || !ts->keyedVector)
+    if (!ts || (!ts->keyedVector && !ts->ring && !ts->compressed))
     {
         *errorSt = TS_ST_BADPARAM;
         return TS_EMPTY_INT64;
@@ -381,12 +764,11 @@ timeseries_simple_calc_int64(timeseries_p ts, int tsCalc, timelib64_t startTime,
     /* Get the starting iteration point */
     if (startTime)
     {
-        searchEntry.usecSince1970 = startTime;
-        elem = (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &searchEntry, KV_LGE_GREATEQUAL, &cursor);
+        elem = timeseries_find(ts, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
     {
-        elem = (timeseries_entry_p)keyedvector_first(ts->keyedVector, &cursor);
+        elem = timeseries_first(ts, &cursor);
     }
 
     if (!elem)
@@ -395,7 +777,7 @@ timeseries_simple_calc_int64(timeseries_p ts, int tsCalc, timelib64_t startTime,
         return retVal; /* No records >= start time. Easy enough */
     }
 
-    for (; elem; elem = (timeseries_entry_p)keyedvector_next(ts->keyedVector, &cursor))
+    for (; elem; elem = timeseries_next(ts, &cursor))
     {
         /* Past end of our time searching range? */
         if (endTime && elem->usecSince1970 > endTime)
@@ -437,12 +819,11 @@ timeseries_simple_calc_double(timeseries_p ts, int tsCalc, timelib64_t startTime
     double retVal = TS_EMPTY_DOUBLE;
     int Nsamples  = 0;
     kv_cursor_t cursor;
-    timeseries_entry_t searchEntry;
     timeseries_entry_p elem;
 
     if (!errorSt)
         return TS_EMPTY_DOUBLE;
-    if (!ts || !ts->keyedVector)
+    if (!ts || (!ts->keyedVector && !ts->ring && !ts->compressed))
     {
         *errorSt = TS_ST_BADPARAM;
         return TS_EMPTY_DOUBLE;
@@ -456,12 +837,11 @@ timeseries_simple_calc_double(timeseries_p ts, int tsCalc, timelib64_t startTime
     /* Get the starting iteration point */
     if (startTime)
     {
-        searchEntry.usecSince1970 = startTime;
-        elem = (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &searchEntry, KV_LGE_GREATEQUAL, &cursor);
+        elem = timeseries_find(ts, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
     {
-        elem = (timeseries_entry_p)keyedvector_first(ts->keyedVector, &cursor);
+        elem = timeseries_first(ts, &cursor);
     }
 
     if (!elem)
@@ -470,7 +850,7 @@ timeseries_simple_calc_double(timeseries_p ts, int tsCalc, timelib64_t startTime
         return retVal; /* No records >= start time. Easy enough */
     }
 
-    for (; elem; elem = (timeseries_entry_p)keyedvector_next(ts->keyedVector, &cursor))
+    for (; elem; elem = timeseries_next(ts, &cursor))
     {
         /* Past end of our time searching range? */
         if (endTime && elem->usecSince1970 > endTime)
@@ -523,12 +903,11 @@ double timeseries_average(timeseries_p ts, timelib64_t startTime, timelib64_t en
     double retVal = 0;
     int Nsamples  = 0;
     kv_cursor_t cursor;
-    timeseries_entry_t searchEntry;
     timeseries_entry_p elem;
 
     if (!errorSt)
         return TS_EMPTY_DOUBLE;
-    if (!ts || !ts->keyedVector)
+    if (!ts || (!ts->keyedVector && !ts->ring && !ts->compressed))
     {
         *errorSt = TS_ST_BADPARAM;
         return TS_EMPTY_DOUBLE;
@@ -542,12 +921,11 @@ double timeseries_average(timeseries_p ts, timelib64_t startTime, timelib64_t en
     /* Get the starting iteration point */
     if (startTime)
     {
-        searchEntry.usecSince1970 = startTime;
-        elem = (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &searchEntry, KV_LGE_GREATEQUAL, &cursor);
+        elem = timeseries_find(ts, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
     {
-        elem = (timeseries_entry_p)keyedvector_first(ts->keyedVector, &cursor);
+        elem = timeseries_first(ts, &cursor);
     }
 
     if (!elem)
@@ -555,7 +933,7 @@ double timeseries_average(timeseries_p ts, timelib64_t startTime, timelib64_t en
         *errorSt = TS_ST_NODATA;
         return TS_EMPTY_DOUBLE; /* Undefined if no samples. Beats dividing by 0 */
     }
-    for (; elem; elem = (timeseries_entry_p)keyedvector_next(ts->keyedVector, &cursor))
+    for (; elem; elem = timeseries_next(ts, &cursor))
     {
         /* Past end of our time searching range? */
         if (endTime && elem->usecSince1970 > endTime)
@@ -595,12 +973,11 @@ double timeseries_moving_average(timeseries_p ts, timelib64_t endTime, int maxSa
     double retVal = 0;
     int Nsamples  = 0;
     kv_cursor_t cursor;
-    timeseries_entry_t searchEntry;
     timeseries_entry_p elem;
 
     if (!errorSt)
         return TS_EMPTY_DOUBLE;
-    if (!ts || !ts->keyedVector || maxSamples < 0)
+    if (!ts || (!ts->keyedVector && !ts->ring && !ts->compressed) || maxSamples < 0)
     {
         *errorSt = TS_ST_BADPARAM;
         return TS_EMPTY_DOUBLE;
@@ -614,12 +991,11 @@ double timeseries_moving_average(timeseries_p ts, timelib64_t endTime, int maxSa
     /* Get the starting iteration point */
     if (endTime)
     {
-        searchEntry.usecSince1970 = endTime;
-        elem = (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &searchEntry, KV_LGE_LESSEQUAL, &cursor);
+        elem = timeseries_find(ts, endTime, TS_LGE_LESSEQUAL, &cursor);
     }
     else
     {
-        elem = (timeseries_entry_p)keyedvector_last(ts->keyedVector, &cursor);
+        elem = timeseries_last(ts, &cursor);
     }
 
     if (!elem)
@@ -628,7 +1004,7 @@ double timeseries_moving_average(timeseries_p ts, timelib64_t endTime, int maxSa
         return TS_EMPTY_DOUBLE; /* Undefined if no samples. Beats dividing by 0 */
     }
 
-    for (; elem; elem = (timeseries_entry_p)keyedvector_prev(ts->keyedVector, &cursor))
+    for (; elem; elem = timeseries_prev(ts, &cursor))
     {
         /* Collected enough samples yet? */
         if (Nsamples >= maxSamples)
@@ -697,27 +1073,25 @@ int timeseries_threshold_count(timeseries_p ts,
     int Nsamples        = 0;
     int NmatchedSamples = 0;
     kv_cursor_t cursor;
-    timeseries_entry_t searchEntry;
     timeseries_entry_p elem;
 
-    if (!ts || !ts->keyedVector)
+    if (!ts || (!ts->keyedVector && !ts->ring && !ts->compressed))
         return TS_ST_BADPARAM;
 
     /* Get the starting iteration point */
     if (startTime)
     {
-        searchEntry.usecSince1970 = startTime;
-        elem = (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &searchEntry, KV_LGE_GREATEQUAL, &cursor);
+        elem = timeseries_find(ts, startTime, TS_LGE_GREATEQUAL, &cursor);
     }
     else
     {
-        elem = (timeseries_entry_p)keyedvector_first(ts->keyedVector, &cursor);
+        elem = timeseries_first(ts, &cursor);
     }
 
     if (!elem)
         return 0; /* No data */
 
-    for (; elem; elem = (timeseries_entry_p)keyedvector_next(ts->keyedVector, &cursor))
+    for (; elem; elem = timeseries_next(ts, &cursor))
     {
         /* Past end of our time searching range? */
         if (endTime && elem->usecSince1970 > endTime)
@@ -775,17 +1149,50 @@ long long timeseries_bytes_used(timeseries_p ts)
     if (!ts)
         return 0;
 
-    long long bytesUsed = sizeof(*ts) + keyedvector_bytes_used(ts->keyedVector);
+    long long bytesUsed = sizeof(*ts);
+
+    if (ts->ring)
+        bytesUsed += sizeof(*ts->ring) + sizeof(timeseries_entry_t) * (long long)ts->ring->capacity;
+    else if (ts->compressed)
+        bytesUsed += timeseries_compressed_bytes_used(ts->compressed);
+    else
+        bytesUsed += keyedvector_bytes_used(ts->keyedVector);
+
+    if (ts->arena)
+    {
+        long long reservedBytes = 0;
+        timeseries_arena_usage(ts->arena, &reservedBytes, NULL);
+        bytesUsed += reservedBytes;
+    }
 
     return bytesUsed;
 }
 
+/*****************************************************************************/
+long long timeseries_compressed_bytes(timeseries_p ts)
+{
+    if (!ts || !ts->compressed)
+        return 0;
+
+    return ts->compressed->compressedBytes;
+}
+
+/*****************************************************************************/
+void timeseries_arena_bytes(timeseries_p ts, long long *reservedBytes, long long *liveBytes)
+{
+    timeseries_arena_usage(ts ? ts->arena : NULL, reservedBytes, liveBytes);
+}
+
 /*****************************************************************************/
 timeseries_entry_p timeseries_first(timeseries_p ts, timeseries_cursor_p cursor)
 {
     timeseries_cursor_t tempCursor;
     if (NULL == cursor)
         cursor = &tempCursor;
+    if (ts->ring)
+        return timeseries_ring_cursor_entry(ts->ring, cursor, 0);
+    if (ts->compressed)
+        return timeseries_compressed_first(ts->compressed, cursor);
     return (timeseries_entry_p)keyedvector_first(ts->keyedVector, cursor);
 }
 
@@ -795,18 +1202,38 @@ timeseries_entry_p timeseries_last(timeseries_p ts, timeseries_cursor_p cursor)
     timeseries_cursor_t tempCursor;
     if (NULL == cursor)
         cursor = &tempCursor;
+    if (ts->ring)
+        return timeseries_ring_cursor_entry(ts->ring, cursor, ts->ring->count - 1);
+    if (ts->compressed)
+        return timeseries_compressed_last(ts->compressed, cursor);
     return (timeseries_entry_p)keyedvector_last(ts->keyedVector, cursor);
 }
 
 /*****************************************************************************/
 timeseries_entry_p timeseries_next(timeseries_p ts, timeseries_cursor_p cursor)
 {
+    if (ts->ring)
+    {
+        if (cursor->subIndex < 0)
+            return NULL;
+        return timeseries_ring_cursor_entry(ts->ring, cursor, cursor->subIndex + 1);
+    }
+    if (ts->compressed)
+        return timeseries_compressed_next(ts->compressed, cursor);
     return (timeseries_entry_p)keyedvector_next(ts->keyedVector, cursor);
 }
 
 /*****************************************************************************/
 timeseries_entry_p timeseries_prev(timeseries_p ts, timeseries_cursor_p cursor)
 {
+    if (ts->ring)
+    {
+        if (cursor->subIndex < 0)
+            return NULL;
+        return timeseries_ring_cursor_entry(ts->ring, cursor, cursor->subIndex - 1);
+    }
+    if (ts->compressed)
+        return timeseries_compressed_prev(ts->compressed, cursor);
     return (timeseries_entry_p)keyedvector_prev(ts->keyedVector, cursor);
 }
 
@@ -816,5 +1243,9 @@ timeseries_entry_p timeseries_find(timeseries_p ts, timelib64_t time, int findOp
     timeseries_cursor_t tempCursor;
     if (NULL == cursor)
         cursor = &tempCursor;
+    if (ts->ring)
+        return timeseries_ring_find(ts->ring, time, findOp, cursor);
+    if (ts->compressed)
+        return timeseries_compressed_find(ts->compressed, time, findOp, cursor);
     return (timeseries_entry_p)keyedvector_find_by_key(ts->keyedVector, &time, findOp, cursor);
 }
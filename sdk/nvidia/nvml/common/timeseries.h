@@ -57,22 +57,7 @@ extern "C"
 #define TS_LGE_LESS KV_LGE_LESS             /* return nearest < time */
 #define TS_LGE_GREATER KV_LGE_GREATER       /* return nearest > time */
 
-    /*****************************************************************************/
-    /* Handle to a timeseries structure */
-    typedef struct timeseries_t
-    {
-        int tsType;                /* TS_TYPE_? #define of the type of value stored
-                                  in keyedVector */
-        keyedvector_p keyedVector; /* Data structure to hold the time series */
-    } timeseries_t, *timeseries_p;
-
-    /* Cursor into a timeseries enumeration. Note that these cursors are only
- * valid as long as the timeseries is not modified (inserting or removing elements).
- */
-    typedef kv_cursor_t timeseries_cursor_t;
-    typedef kv_cursor_p timeseries_cursor_p;
-
-    /* Entry stored in keyed vector */
+    /* Entry stored in keyed vector or ring */
     typedef struct timeseries_entry_t
     {
         timelib64_t usecSince1970; /* Key field. When did this entry happen */
@@ -91,6 +76,45 @@ extern "C"
         } val2;                /* To store any additional Information at time usecSince1970 */
     } timeseries_entry_t, *timeseries_entry_p;
 
+    /*****************************************************************************/
+    /* Fixed-capacity ring of entries that can be used instead of a keyedvector
+ * for numeric series. Entries are kept sorted by usecSince1970 in one
+ * contiguous array. Logical index i lives at entries[(head + i) % capacity]
+ */
+    typedef struct timeseries_ring_t
+    {
+        timeseries_entry_t *entries; /* Array of capacity entries */
+        int capacity;                /* Number of entries allocated in entries */
+        int head;                    /* Array index of the oldest entry */
+        int count;                   /* Number of entries currently stored */
+    } timeseries_ring_t, *timeseries_ring_p;
+
+    /* Compressed storage. See timeseries_compressed.h */
+    typedef struct timeseries_compressed_t *timeseries_compressed_p;
+
+    /* Arena for string and blob values. See timeseries_arena.h */
+    typedef struct timeseries_arena_t *timeseries_arena_p;
+
+    /*****************************************************************************/
+    /* Handle to a timeseries structure */
+    typedef struct timeseries_t
+    {
+        int tsType;                         /* TS_TYPE_? #define of the type of value stored
+                                           in keyedVector */
+        keyedvector_p keyedVector;          /* Data structure to hold the time series. NULL if ring or
+                                           compressed is used */
+        timeseries_ring_p ring;             /* Ring buffer holding the time series. NULL if not used */
+        timeseries_compressed_p compressed; /* Compressed blocks holding the time series. NULL if not used */
+        timeseries_arena_p arena;           /* Arena holding the values of a string or blob series. NULL if
+                                           values are individually malloc'd */
+    } timeseries_t, *timeseries_p;
+
+    /* Cursor into a timeseries enumeration. Note that these cursors are only
+ * valid as long as the timeseries is not modified (inserting or removing elements).
+ */
+    typedef kv_cursor_t timeseries_cursor_t;
+    typedef kv_cursor_p timeseries_cursor_p;
+
     /*****************************************************************************/
     /*
  * Allocate a timeseries collection
@@ -101,6 +125,51 @@ extern "C"
  */
     timeseries_p timeseries_alloc(int tsType, int *errorSt);
 
+    /*****************************************************************************/
+    /*
+ * Allocate a timeseries collection backed by a ring buffer rather than a
+ * keyedvector. Only TS_TYPE_INT64 and TS_TYPE_DOUBLE are supported.
+ *
+ * Appending entries in timestamp order and trimming them with
+ * timeseries_enforce_quota() does not allocate memory. The ring doubles in
+ * size if more than capacity entries are ever kept at once.
+ *
+ * tsType    IN: TS_TYPE_INT64 or TS_TYPE_DOUBLE
+ * capacity  IN: Number of entries to reserve up front. Must be > 0
+ * errorSt  OUT: Where to store the error
+ */
+    timeseries_p timeseries_alloc_ring(int tsType, int capacity, int *errorSt);
+
+    /*****************************************************************************/
+    /*
+ * Allocate a timeseries collection that stores its entries compressed.
+ * Only TS_TYPE_INT64 and TS_TYPE_DOUBLE are supported.
+ *
+ * Entries are buffered uncompressed until a block of them is full. Full blocks
+ * are sealed with delta-of-delta encoded timestamps and XOR encoded values.
+ * Entries returned by timeseries_first/last/next/prev/find() on such a series
+ * are decoded copies. They are only valid until the next call on the series.
+ *
+ * tsType    IN: TS_TYPE_INT64 or TS_TYPE_DOUBLE
+ * errorSt  OUT: Where to store the error
+ */
+    timeseries_p timeseries_alloc_compressed(int tsType, int *errorSt);
+
+    /*****************************************************************************/
+    /*
+ * Allocate a keyedvector timeseries collection whose values are allocated
+ * from a per-series arena rather than individually from the heap.
+ * Only TS_TYPE_STRING and TS_TYPE_BLOB are supported.
+ *
+ * The arena is carved into chunks. A chunk goes back to the heap once all of
+ * the values in it were removed by timeseries_enforce_quota(), so trimming
+ * the oldest samples releases memory in bulk.
+ *
+ * tsType    IN: TS_TYPE_STRING or TS_TYPE_BLOB
+ * errorSt  OUT: Where to store the error
+ */
+    timeseries_p timeseries_alloc_arena(int tsType, int *errorSt);
+
     /*****************************************************************************/
     /*
  * Destroy an allocated timeseries collection
@@ -173,6 +242,22 @@ extern "C"
  */
     int timeseries_insert_blob(timeseries_p ts, timelib64_t timestamp, void *value, int valueSize);
 
+    /*****************************************************************************/
+    /*
+ * Insert Nentries entries, sorted by timestamp, into a TS_TYPE_INT64 or
+ * TS_TYPE_DOUBLE time series. The values of the entries must already be of
+ * the type of the series.
+ *
+ * Entries past the newest one of the series are appended in bulk. The others
+ * are inserted one at a time like timeseries_insert_int64() does. Timestamps
+ * of 0 in entries are replaced by the current time
+ *
+ * Returns: 0 if OK
+ *         <0 TS_ST_? #define on error
+ *
+ */
+    int timeseries_append(timeseries_p ts, timeseries_entry_p entries, int Nentries);
+
     /*****************************************************************************/
     /*
  * Enforce a quota on this time series on both number of records kept and
@@ -313,6 +398,23 @@ extern "C"
  */
     long long timeseries_bytes_used(timeseries_p ts);
 
+    /*****************************************************************************/
+    /* Number of bytes of encoded sample data in a timeseries allocated with
+ * timeseries_alloc_compressed(). This doesn't count the uncompressed tail.
+ *
+ * Returns >= 0 Number of bytes. 0 for other kinds of timeseries
+ */
+    long long timeseries_compressed_bytes(timeseries_p ts);
+
+    /*****************************************************************************/
+    /* Arena usage of a timeseries allocated with timeseries_alloc_arena().
+ * Both are set to 0 for other kinds of timeseries.
+ *
+ * reservedBytes OUT: Bytes the arena holds from the heap. Can be NULL
+ * liveBytes     OUT: Bytes of those that hold values still in the series. Can be NULL
+ */
+    void timeseries_arena_bytes(timeseries_p ts, long long *reservedBytes, long long *liveBytes);
+
     /*************************************************************************/
     /*
  * Get the first element in the timeseries and a cursor that can be used to get the
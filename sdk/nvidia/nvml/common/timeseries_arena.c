@@ -0,0 +1,203 @@
+#include "timeseries_arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************/
+typedef struct timeseries_arena_chunk_t
+{
+    struct timeseries_arena_chunk_t *prev; /* Previous chunk in the arena's list */
+    struct timeseries_arena_chunk_t *next; /* Next chunk in the arena's list */
+    size_t capacity;                       /* Bytes available in data */
+    size_t used;                           /* Bytes of data handed out so far */
+    size_t liveBytes;                      /* Bytes of data handed out and not freed yet */
+    int liveCount;                         /* Number of values handed out and not freed yet */
+    unsigned char *data;                   /* Follows this struct in the same allocation */
+} timeseries_arena_chunk_t, *timeseries_arena_chunk_p;
+
+/* Each value is preceded by a header pointing back at its chunk */
+typedef struct timeseries_arena_header_t
+{
+    timeseries_arena_chunk_p chunk;
+    size_t size;  /* Size of the value including this header and padding */
+    int refCount; /* Number of samples referencing the value */
+} timeseries_arena_header_t;
+
+typedef struct timeseries_arena_t
+{
+    timeseries_arena_chunk_p chunks;  /* All chunks of the arena */
+    timeseries_arena_chunk_p current; /* Chunk values are bump-allocated from. NULL if none */
+    size_t nextChunkBytes;            /* Capacity of the next chunk to allocate */
+    long long reservedBytes;          /* Sum of the chunks' allocation sizes */
+    long long liveBytes;              /* Sum of the chunks' liveBytes */
+} timeseries_arena_t;
+
+#define TS_ARENA_ALIGN(x) (((x) + 7) & ~((size_t)7))
+
+/*****************************************************************************/
+static timeseries_arena_chunk_p timeseries_arena_chunk_alloc(timeseries_arena_p arena, size_t capacity)
+{
+    size_t headerBytes             = TS_ARENA_ALIGN(sizeof(timeseries_arena_chunk_t));
+    timeseries_arena_chunk_p chunk = (timeseries_arena_chunk_p)malloc(headerBytes + capacity);
+    if (!chunk)
+        return NULL;
+
+    memset(chunk, 0, sizeof(*chunk));
+    chunk->capacity = capacity;
+    chunk->data     = (unsigned char *)chunk + headerBytes;
+
+    chunk->next = arena->chunks;
+    if (arena->chunks)
+        arena->chunks->prev = chunk;
+    arena->chunks = chunk;
+
+    arena->reservedBytes += (long long)(headerBytes + capacity);
+    return chunk;
+}
+
+/*****************************************************************************/
+static void timeseries_arena_chunk_release(timeseries_arena_p arena, timeseries_arena_chunk_p chunk)
+{
+    if (chunk->prev)
+        chunk->prev->next = chunk->next;
+    else
+        arena->chunks = chunk->next;
+    if (chunk->next)
+        chunk->next->prev = chunk->prev;
+
+    if (arena->current == chunk)
+        arena->current = NULL;
+
+    arena->reservedBytes -= (long long)(TS_ARENA_ALIGN(sizeof(timeseries_arena_chunk_t)) + chunk->capacity);
+    free(chunk);
+}
+
+/*****************************************************************************/
+timeseries_arena_p timeseries_arena_alloc(void)
+{
+    timeseries_arena_p arena = (timeseries_arena_p)malloc(sizeof(*arena));
+    if (!arena)
+        return NULL;
+
+    memset(arena, 0, sizeof(*arena));
+    arena->nextChunkBytes = TS_ARENA_MIN_CHUNK_BYTES;
+    return arena;
+}
+
+/*****************************************************************************/
+void timeseries_arena_destroy(timeseries_arena_p arena)
+{
+    if (!arena)
+        return;
+
+    while (arena->chunks)
+        timeseries_arena_chunk_release(arena, arena->chunks);
+
+    free(arena);
+}
+
+/*****************************************************************************/
+void *timeseries_arena_malloc(timeseries_arena_p arena, size_t size)
+{
+    timeseries_arena_chunk_p chunk;
+    timeseries_arena_header_t *header;
+    size_t needed;
+
+    if (!arena)
+        return NULL;
+
+    needed = TS_ARENA_ALIGN(sizeof(timeseries_arena_header_t)) + TS_ARENA_ALIGN(size);
+
+    if (needed > TS_ARENA_MAX_CHUNK_BYTES / 2)
+    {
+        /* Dedicated chunk. Leave the current chunk alone */
+        chunk = timeseries_arena_chunk_alloc(arena, needed);
+        if (!chunk)
+            return NULL;
+    }
+    else
+    {
+        chunk = arena->current;
+        if (!chunk || chunk->capacity - chunk->used < needed)
+        {
+            while (arena->nextChunkBytes < needed)
+                arena->nextChunkBytes *= 2;
+
+            chunk = timeseries_arena_chunk_alloc(arena, arena->nextChunkBytes);
+            if (!chunk)
+                return NULL;
+
+            arena->current = chunk;
+            if (arena->nextChunkBytes < TS_ARENA_MAX_CHUNK_BYTES)
+                arena->nextChunkBytes *= 2;
+        }
+    }
+
+    header           = (timeseries_arena_header_t *)(chunk->data + chunk->used);
+    header->chunk    = chunk;
+    header->size     = needed;
+    header->refCount = 1;
+
+    chunk->used += needed;
+    chunk->liveBytes += needed;
+    chunk->liveCount++;
+    arena->liveBytes += (long long)needed;
+
+    return (unsigned char *)header + TS_ARENA_ALIGN(sizeof(timeseries_arena_header_t));
+}
+
+/*****************************************************************************/
+static timeseries_arena_header_t *timeseries_arena_header(void *ptr)
+{
+    return (timeseries_arena_header_t *)((unsigned char *)ptr - TS_ARENA_ALIGN(sizeof(timeseries_arena_header_t)));
+}
+
+/*****************************************************************************/
+void timeseries_arena_retain(timeseries_arena_p arena, void *ptr)
+{
+    if (!arena || !ptr)
+        return;
+
+    timeseries_arena_header(ptr)->refCount++;
+}
+
+/*****************************************************************************/
+void timeseries_arena_free(timeseries_arena_p arena, void *ptr)
+{
+    timeseries_arena_header_t *header;
+    timeseries_arena_chunk_p chunk;
+
+    if (!arena || !ptr)
+        return;
+
+    header = timeseries_arena_header(ptr);
+    if (--header->refCount > 0)
+        return;
+
+    chunk = header->chunk;
+
+    chunk->liveBytes -= header->size;
+    chunk->liveCount--;
+    arena->liveBytes -= (long long)header->size;
+
+    if (chunk->liveCount > 0)
+        return;
+
+    if (chunk == arena->current)
+    {
+        /* Keep the current chunk around and start over at its beginning */
+        chunk->used = 0;
+        return;
+    }
+
+    timeseries_arena_chunk_release(arena, chunk);
+}
+
+/*****************************************************************************/
+void timeseries_arena_usage(timeseries_arena_p arena, long long *reservedBytes, long long *liveBytes)
+{
+    if (reservedBytes)
+        *reservedBytes = arena ? arena->reservedBytes : 0;
+    if (liveBytes)
+        *liveBytes = arena ? arena->liveBytes : 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * timeseries_arena.h
+ *
+ * Arena for the variable-length values of string and blob timeseries. This is
+ * internal to timeseries.c. Use timeseries_alloc_arena() to get a timeseries
+ * that uses it.
+ */
+
+#ifndef TIMESERIES_ARENA_H
+#define TIMESERIES_ARENA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*****************************************************************************/
+/* Size of the first chunk of an arena. Each new chunk doubles in size up to
+   TS_ARENA_MAX_CHUNK_BYTES so that series with few samples stay small */
+#define TS_ARENA_MIN_CHUNK_BYTES 1024
+#define TS_ARENA_MAX_CHUNK_BYTES (64 * 1024)
+
+    /*****************************************************************************/
+    /*
+ * Values are bump-allocated from the newest chunk. Each chunk counts its live
+ * values and is released as a whole once its last value is freed. Since
+ * samples are evicted oldest first, this releases memory in bulk and keeps
+ * long-lived series from fragmenting the heap.
+ */
+    typedef struct timeseries_arena_t *timeseries_arena_p;
+
+    /*****************************************************************************/
+    timeseries_arena_p timeseries_arena_alloc(void);
+    void timeseries_arena_destroy(timeseries_arena_p arena);
+
+    /*****************************************************************************/
+    /*
+ * Allocate size bytes from the arena. Values larger than half of
+ * TS_ARENA_MAX_CHUNK_BYTES get a chunk of their own.
+ *
+ * Returns pointer to the memory on success. The memory is 8-byte aligned
+ *         NULL if out of memory
+ */
+    void *timeseries_arena_malloc(timeseries_arena_p arena, size_t size);
+
+    /*****************************************************************************/
+    /*
+ * Add a reference to memory returned by timeseries_arena_malloc() so that
+ * several samples can share one value. Each reference is released by its own
+ * timeseries_arena_free() and the memory is freed with the last one.
+ */
+    void timeseries_arena_retain(timeseries_arena_p arena, void *ptr);
+
+    /*****************************************************************************/
+    /* Release memory returned by timeseries_arena_malloc() */
+    void timeseries_arena_free(timeseries_arena_p arena, void *ptr);
+
+    /*****************************************************************************/
+    /*
+ * reservedBytes OUT: Bytes allocated from the heap for chunks
+ * liveBytes     OUT: Bytes of those chunks that hold live values
+ */
+    void timeseries_arena_usage(timeseries_arena_p arena, long long *reservedBytes, long long *liveBytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMESERIES_ARENA_H */
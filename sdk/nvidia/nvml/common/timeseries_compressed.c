@@ -0,0 +1,763 @@
+#include "timeseries_compressed.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************/
+/* Bit-level writer and reader for the encoded blocks. Bits are packed MSB first */
+typedef struct timeseries_bitwriter_t
+{
+    unsigned char *buf; /* Output buffer */
+    int capacity;       /* Allocated size of buf in bytes */
+    long long numBits;  /* Number of bits written so far */
+    int error;          /* Set if an allocation failed */
+} timeseries_bitwriter_t;
+
+typedef struct timeseries_bitreader_t
+{
+    const unsigned char *buf; /* Input buffer */
+    long long numBits;        /* Number of valid bits in buf */
+    long long pos;            /* Next bit to read */
+} timeseries_bitreader_t;
+
+/* Previous-value state of the XOR encoding of one value column */
+typedef struct timeseries_xorstate_t
+{
+    unsigned long long prev; /* Bits of the previous value */
+    int leading;             /* Leading zero count of the current meaningful-bit window */
+    int trailing;            /* Trailing zero count of the current meaningful-bit window */
+    int haveWindow;          /* Has a window been established yet? */
+} timeseries_xorstate_t;
+
+/*****************************************************************************/
+static void timeseries_write_bits(timeseries_bitwriter_t *bw, unsigned long long value, int numBits)
+{
+    int i;
+
+    for (i = numBits - 1; i >= 0; i--)
+    {
+        int byteIndex = (int)(bw->numBits >> 3);
+
+        if (byteIndex >= bw->capacity)
+        {
+            int newCapacity       = bw->capacity ? bw->capacity * 2 : 64;
+            unsigned char *newBuf = (unsigned char *)realloc(bw->buf, newCapacity);
+            if (!newBuf)
+            {
+                bw->error = 1;
+                return;
+            }
+            bw->buf      = newBuf;
+            bw->capacity = newCapacity;
+        }
+
+        if (!(bw->numBits & 7))
+            bw->buf[byteIndex] = 0;
+        if ((value >> i) & 1)
+            bw->buf[byteIndex] |= (unsigned char)(0x80 >> (bw->numBits & 7));
+        bw->numBits++;
+    }
+}
+
+/*****************************************************************************/
+static unsigned long long timeseries_read_bits(timeseries_bitreader_t *br, int numBits)
+{
+    unsigned long long value = 0;
+    int i;
+
+    for (i = 0; i < numBits; i++)
+    {
+        unsigned long long bit = 0;
+        if (br->pos < br->numBits)
+            bit = (br->buf[br->pos >> 3] >> (7 - (br->pos & 7))) & 1;
+        value = (value << 1) | bit;
+        br->pos++;
+    }
+
+    return value;
+}
+
+/*****************************************************************************/
+static long long timeseries_read_signed_bits(timeseries_bitreader_t *br, int numBits)
+{
+    unsigned long long value = timeseries_read_bits(br, numBits);
+
+    if (numBits < 64 && (value & (1ULL << (numBits - 1))))
+        value |= ~((1ULL << numBits) - 1); /* Sign extend */
+
+    return (long long)value;
+}
+
+/*****************************************************************************/
+static void timeseries_encode_xor(timeseries_bitwriter_t *bw, timeseries_xorstate_t *state, unsigned long long bits)
+{
+    unsigned long long xorValue = bits ^ state->prev;
+    int leading, trailing, meaningful;
+
+    state->prev = bits;
+
+    if (!xorValue)
+    {
+        timeseries_write_bits(bw, 0, 1);
+        return;
+    }
+
+    timeseries_write_bits(bw, 1, 1);
+
+    leading  = __builtin_clzll(xorValue);
+    trailing = __builtin_ctzll(xorValue);
+    if (leading > 31)
+        leading = 31; /* Only 5 bits are available to store it */
+
+    if (state->haveWindow && leading >= state->leading && trailing >= state->trailing)
+    {
+        /* Fits in the previous window. Just write the meaningful bits */
+        meaningful = 64 - state->leading - state->trailing;
+        timeseries_write_bits(bw, 0, 1);
+        timeseries_write_bits(bw, xorValue >> state->trailing, meaningful);
+        return;
+    }
+
+    meaningful = 64 - leading - trailing;
+    timeseries_write_bits(bw, 1, 1);
+    timeseries_write_bits(bw, (unsigned long long)leading, 5);
+    timeseries_write_bits(bw, (unsigned long long)(meaningful & 63), 6); /* 64 is stored as 0 */
+    timeseries_write_bits(bw, xorValue >> trailing, meaningful);
+
+    state->leading    = leading;
+    state->trailing   = trailing;
+    state->haveWindow = 1;
+}
+
+/*****************************************************************************/
+static unsigned long long timeseries_decode_xor(timeseries_bitreader_t *br, timeseries_xorstate_t *state)
+{
+    unsigned long long xorValue;
+    int meaningful;
+
+    if (!timeseries_read_bits(br, 1))
+        return state->prev; /* Same as the previous value */
+
+    if (timeseries_read_bits(br, 1))
+    {
+        state->leading    = (int)timeseries_read_bits(br, 5);
+        meaningful        = (int)timeseries_read_bits(br, 6);
+        meaningful        = meaningful ? meaningful : 64;
+        state->trailing   = 64 - state->leading - meaningful;
+        state->haveWindow = 1;
+    }
+    else
+    {
+        meaningful = 64 - state->leading - state->trailing;
+    }
+
+    xorValue = timeseries_read_bits(br, meaningful) << state->trailing;
+    state->prev ^= xorValue;
+    return state->prev;
+}
+
+/*****************************************************************************/
+static void timeseries_encode_timestamp_dod(timeseries_bitwriter_t *bw, long long dod)
+{
+    if (dod == 0)
+        timeseries_write_bits(bw, 0, 1);
+    else if (dod >= -64 && dod <= 63)
+    {
+        timeseries_write_bits(bw, 0x2, 2);
+        timeseries_write_bits(bw, (unsigned long long)dod, 7);
+    }
+    else if (dod >= -256 && dod <= 255)
+    {
+        timeseries_write_bits(bw, 0x6, 3);
+        timeseries_write_bits(bw, (unsigned long long)dod, 9);
+    }
+    else if (dod >= -2048 && dod <= 2047)
+    {
+        timeseries_write_bits(bw, 0xE, 4);
+        timeseries_write_bits(bw, (unsigned long long)dod, 12);
+    }
+    else
+    {
+        timeseries_write_bits(bw, 0xF, 4);
+        timeseries_write_bits(bw, (unsigned long long)dod, 64);
+    }
+}
+
+/*****************************************************************************/
+static long long timeseries_decode_timestamp_dod(timeseries_bitreader_t *br)
+{
+    if (!timeseries_read_bits(br, 1))
+        return 0;
+    if (!timeseries_read_bits(br, 1))
+        return timeseries_read_signed_bits(br, 7);
+    if (!timeseries_read_bits(br, 1))
+        return timeseries_read_signed_bits(br, 9);
+    if (!timeseries_read_bits(br, 1))
+        return timeseries_read_signed_bits(br, 12);
+    return timeseries_read_signed_bits(br, 64);
+}
+
+/*****************************************************************************/
+/* Encode entries[0..count) into block. Returns TS_ST_OK or TS_ST_MEMORY */
+static int timeseries_encode_block(const timeseries_entry_t *entries, int count, timeseries_cblock_p block)
+{
+    timeseries_bitwriter_t bw;
+    timeseries_xorstate_t valState, val2State;
+    long long prevDelta = 0;
+    int i;
+
+    memset(&bw, 0, sizeof(bw));
+    memset(&valState, 0, sizeof(valState));
+    memset(&val2State, 0, sizeof(val2State));
+
+    for (i = 0; i < count; i++)
+    {
+        unsigned long long valBits, val2Bits;
+
+        if (i == 0)
+            timeseries_write_bits(&bw, (unsigned long long)entries[0].usecSince1970, 64);
+        else
+        {
+            long long delta = entries[i].usecSince1970 - entries[i - 1].usecSince1970;
+            timeseries_encode_timestamp_dod(&bw, delta - prevDelta);
+            prevDelta = delta;
+        }
+
+        /* i64 and dbl share storage. Encode the raw 64 bits either way */
+        memcpy(&valBits, &entries[i].val, sizeof(valBits));
+        memcpy(&val2Bits, &entries[i].val2, sizeof(val2Bits));
+        timeseries_encode_xor(&bw, &valState, valBits);
+        timeseries_encode_xor(&bw, &val2State, val2Bits);
+    }
+
+    if (bw.error)
+    {
+        free(bw.buf);
+        return TS_ST_MEMORY;
+    }
+
+    block->numBytes = (int)((bw.numBits + 7) >> 3);
+    block->bits     = (unsigned char *)realloc(bw.buf, block->numBytes ? block->numBytes : 1);
+    if (!block->bits)
+        block->bits = bw.buf; /* Shrinking failed. Keep the bigger buffer */
+
+    block->count               = count;
+    block->firstIndex          = 0;
+    block->firstValidTimestamp = entries[0].usecSince1970;
+    block->lastTimestamp       = entries[count - 1].usecSince1970;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+/* Decode block blockIndex into comp->decoded unless it is already there */
+static int timeseries_decode_block(timeseries_compressed_p comp, int blockIndex)
+{
+    timeseries_cblock_p block = &comp->blocks[blockIndex];
+    timeseries_bitreader_t br;
+    timeseries_xorstate_t valState, val2State;
+    long long prevDelta = 0;
+    int i;
+
+    if (comp->decodedBlock == blockIndex)
+        return TS_ST_OK;
+
+    if (block->count > comp->decodedCapacity)
+    {
+        timeseries_entry_t *newDecoded
+            = (timeseries_entry_t *)realloc(comp->decoded, sizeof(timeseries_entry_t) * block->count);
+        if (!newDecoded)
+            return TS_ST_MEMORY;
+        comp->decoded         = newDecoded;
+        comp->decodedCapacity = block->count;
+    }
+
+    br.buf     = block->bits;
+    br.numBits = (long long)block->numBytes * 8;
+    br.pos     = 0;
+    memset(&valState, 0, sizeof(valState));
+    memset(&val2State, 0, sizeof(val2State));
+
+    for (i = 0; i < block->count; i++)
+    {
+        unsigned long long valBits, val2Bits;
+        timeseries_entry_p entry = &comp->decoded[i];
+
+        if (i == 0)
+            entry->usecSince1970 = (timelib64_t)timeseries_read_bits(&br, 64);
+        else
+        {
+            prevDelta += timeseries_decode_timestamp_dod(&br);
+            entry->usecSince1970 = comp->decoded[i - 1].usecSince1970 + prevDelta;
+        }
+
+        valBits  = timeseries_decode_xor(&br, &valState);
+        val2Bits = timeseries_decode_xor(&br, &val2State);
+        memcpy(&entry->val, &valBits, sizeof(valBits));
+        memcpy(&entry->val2, &val2Bits, sizeof(val2Bits));
+    }
+
+    comp->decodedBlock = blockIndex;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+/* Positions are (blockIndex, subIndex). blockIndex == numBlocks is the tail */
+static int timeseries_compressed_begin(timeseries_compressed_p comp, int blockIndex)
+{
+    return blockIndex < comp->numBlocks ? comp->blocks[blockIndex].firstIndex : 0;
+}
+
+/*****************************************************************************/
+static int timeseries_compressed_end(timeseries_compressed_p comp, int blockIndex)
+{
+    return blockIndex < comp->numBlocks ? comp->blocks[blockIndex].count : comp->tailCount;
+}
+
+/*****************************************************************************/
+static timeseries_entry_p timeseries_compressed_at(timeseries_compressed_p comp, int blockIndex, int subIndex)
+{
+    if (blockIndex == comp->numBlocks)
+        return &comp->tail[subIndex];
+
+    if (timeseries_decode_block(comp, blockIndex))
+        return NULL;
+
+    return &comp->decoded[subIndex];
+}
+
+/*****************************************************************************/
+/* Move (blockIndex, subIndex) forward to the next valid position at or after it
+   and return the entry there. Returns NULL and marks cursor if we ran off the end */
+static timeseries_entry_p timeseries_compressed_seek_forward(timeseries_compressed_p comp,
+                                                             int blockIndex,
+                                                             int subIndex,
+                                                             timeseries_cursor_p cursor)
+{
+    while (blockIndex <= comp->numBlocks && subIndex >= timeseries_compressed_end(comp, blockIndex))
+    {
+        blockIndex++;
+        if (blockIndex <= comp->numBlocks)
+            subIndex = timeseries_compressed_begin(comp, blockIndex);
+    }
+
+    if (blockIndex > comp->numBlocks)
+    {
+        cursor->blockIndex = KV_CURSOR_AFTER;
+        cursor->subIndex   = KV_CURSOR_AFTER;
+        return NULL;
+    }
+
+    cursor->blockIndex = blockIndex;
+    cursor->subIndex   = subIndex;
+    return timeseries_compressed_at(comp, blockIndex, subIndex);
+}
+
+/*****************************************************************************/
+static timeseries_entry_p timeseries_compressed_seek_backward(timeseries_compressed_p comp,
+                                                              int blockIndex,
+                                                              int subIndex,
+                                                              timeseries_cursor_p cursor)
+{
+    while (blockIndex >= 0 && subIndex < timeseries_compressed_begin(comp, blockIndex))
+    {
+        blockIndex--;
+        if (blockIndex >= 0)
+            subIndex = timeseries_compressed_end(comp, blockIndex) - 1;
+    }
+
+    if (blockIndex < 0)
+    {
+        cursor->blockIndex = KV_CURSOR_BEFORE;
+        cursor->subIndex   = KV_CURSOR_BEFORE;
+        return NULL;
+    }
+
+    cursor->blockIndex = blockIndex;
+    cursor->subIndex   = subIndex;
+    return timeseries_compressed_at(comp, blockIndex, subIndex);
+}
+
+/*****************************************************************************/
+/* Find the position of the first entry >= time. Sets *blockIndex to numBlocks
+   and *subIndex to tailCount if there isn't one */
+static int timeseries_compressed_lower_bound(timeseries_compressed_p comp,
+                                             timelib64_t time,
+                                             int *blockIndex,
+                                             int *subIndex)
+{
+    int low  = 0;
+    int high = comp->numBlocks;
+    timeseries_entry_t *entries;
+
+    /* First sealed block whose last timestamp is >= time */
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (comp->blocks[mid].lastTimestamp < time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    *blockIndex = low;
+    if (low < comp->numBlocks)
+    {
+        int st = timeseries_decode_block(comp, low);
+        if (st)
+            return st;
+        entries = comp->decoded;
+    }
+    else
+        entries = comp->tail;
+
+    low  = timeseries_compressed_begin(comp, *blockIndex);
+    high = timeseries_compressed_end(comp, *blockIndex);
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (entries[mid].usecSince1970 < time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    *subIndex = low;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+static timelib64_t timeseries_compressed_last_timestamp(timeseries_compressed_p comp)
+{
+    if (comp->tailCount)
+        return comp->tail[comp->tailCount - 1].usecSince1970;
+    return comp->blocks[comp->numBlocks - 1].lastTimestamp;
+}
+
+/*****************************************************************************/
+static void timeseries_compressed_drop_first_block(timeseries_compressed_p comp)
+{
+    timeseries_cblock_p block = &comp->blocks[0];
+
+    comp->count -= block->count - block->firstIndex;
+    comp->compressedBytes -= block->numBytes;
+    free(block->bits);
+
+    comp->numBlocks--;
+    memmove(&comp->blocks[0], &comp->blocks[1], sizeof(timeseries_cblock_t) * comp->numBlocks);
+
+    /* Keep the decoded block cached if it is still around */
+    comp->decodedBlock = comp->decodedBlock > 0 ? comp->decodedBlock - 1 : -1;
+}
+
+/*****************************************************************************/
+static void timeseries_compressed_trim_tail(timeseries_compressed_p comp, int numToRemove)
+{
+    comp->tailCount -= numToRemove;
+    comp->count -= numToRemove;
+    memmove(&comp->tail[0], &comp->tail[numToRemove], sizeof(timeseries_entry_t) * comp->tailCount);
+}
+
+/*****************************************************************************/
+/* Compress the tail into a new sealed block */
+static int timeseries_compressed_seal(timeseries_compressed_p comp)
+{
+    int st;
+
+    if (comp->numBlocks == comp->maxBlocks)
+    {
+        int newMaxBlocks = comp->maxBlocks ? comp->maxBlocks * 2 : 8;
+        timeseries_cblock_t *newBlocks
+            = (timeseries_cblock_t *)realloc(comp->blocks, sizeof(timeseries_cblock_t) * newMaxBlocks);
+        if (!newBlocks)
+            return TS_ST_MEMORY;
+        comp->blocks    = newBlocks;
+        comp->maxBlocks = newMaxBlocks;
+    }
+
+    st = timeseries_encode_block(comp->tail, comp->tailCount, &comp->blocks[comp->numBlocks]);
+    if (st)
+        return st;
+
+    comp->compressedBytes += comp->blocks[comp->numBlocks].numBytes;
+    comp->numBlocks++;
+    comp->tailCount = 0;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+/* Insert entry into the middle of sealed block blockIndex by re-encoding it */
+static int timeseries_compressed_insert_sealed(timeseries_compressed_p comp,
+                                               int blockIndex,
+                                               int subIndex,
+                                               timeseries_entry_p entry)
+{
+    timeseries_cblock_p block = &comp->blocks[blockIndex];
+    timeseries_cblock_t newBlock;
+    timeseries_entry_t *entries;
+    int numValid, numBefore, st;
+
+    st = timeseries_decode_block(comp, blockIndex);
+    if (st)
+        return st;
+
+    /* Only the entries that haven't been trimmed are kept in the new block */
+    numValid  = block->count - block->firstIndex;
+    numBefore = subIndex - block->firstIndex;
+    entries   = (timeseries_entry_t *)malloc(sizeof(timeseries_entry_t) * (numValid + 1));
+    if (!entries)
+        return TS_ST_MEMORY;
+
+    memcpy(&entries[0], &comp->decoded[block->firstIndex], sizeof(timeseries_entry_t) * numBefore);
+    entries[numBefore] = *entry;
+    memcpy(&entries[numBefore + 1], &comp->decoded[subIndex], sizeof(timeseries_entry_t) * (numValid - numBefore));
+
+    memset(&newBlock, 0, sizeof(newBlock));
+    st = timeseries_encode_block(entries, numValid + 1, &newBlock);
+    free(entries);
+    if (st)
+        return st;
+
+    comp->compressedBytes += newBlock.numBytes - block->numBytes;
+    free(block->bits);
+    *block = newBlock;
+
+    comp->decodedBlock = -1;
+    comp->count++;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+timeseries_compressed_p timeseries_compressed_alloc(int *errorSt)
+{
+    timeseries_compressed_p comp = (timeseries_compressed_p)malloc(sizeof(*comp));
+    if (!comp)
+    {
+        *errorSt = TS_ST_MEMORY;
+        return NULL;
+    }
+
+    memset(comp, 0, sizeof(*comp));
+    comp->decodedBlock = -1;
+    return comp;
+}
+
+/*****************************************************************************/
+void timeseries_compressed_destroy(timeseries_compressed_p comp)
+{
+    int i;
+
+    if (!comp)
+        return;
+
+    for (i = 0; i < comp->numBlocks; i++)
+        free(comp->blocks[i].bits);
+
+    free(comp->blocks);
+    free(comp->decoded);
+    free(comp);
+}
+
+/*****************************************************************************/
+int timeseries_compressed_insert(timeseries_compressed_p comp, timeseries_entry_p entry)
+{
+    int blockIndex, subIndex, st;
+    timeseries_entry_p found;
+
+    if (comp->count && entry->usecSince1970 <= timeseries_compressed_last_timestamp(comp))
+    {
+        /* Out of order. Resolve duplicates the same way the keyedvector path does,
+           by incrementing the timestamp until it is unique */
+        for (;;)
+        {
+            st = timeseries_compressed_lower_bound(comp, entry->usecSince1970, &blockIndex, &subIndex);
+            if (st)
+                return st;
+            if (blockIndex == comp->numBlocks && subIndex == comp->tailCount)
+                break; /* Newer than everything after all */
+
+            found = timeseries_compressed_at(comp, blockIndex, subIndex);
+            if (!found)
+                return TS_ST_MEMORY;
+            if (found->usecSince1970 != entry->usecSince1970)
+                break;
+            entry->usecSince1970++;
+        }
+
+        if (blockIndex < comp->numBlocks)
+            return timeseries_compressed_insert_sealed(comp, blockIndex, subIndex, entry);
+
+        if (subIndex < comp->tailCount)
+        {
+            if (comp->tailCount == TS_COMPRESSED_BLOCK_ENTRIES)
+            {
+                /* The entry now belongs to the block we are about to seal */
+                st = timeseries_compressed_seal(comp);
+                if (st)
+                    return st;
+                return timeseries_compressed_insert_sealed(comp, comp->numBlocks - 1, subIndex, entry);
+            }
+
+            memmove(&comp->tail[subIndex + 1],
+                    &comp->tail[subIndex],
+                    sizeof(timeseries_entry_t) * (comp->tailCount - subIndex));
+            comp->tail[subIndex] = *entry;
+            comp->tailCount++;
+            comp->count++;
+            return TS_ST_OK;
+        }
+    }
+
+    /* Appending in time order */
+    if (comp->tailCount == TS_COMPRESSED_BLOCK_ENTRIES)
+    {
+        st = timeseries_compressed_seal(comp);
+        if (st)
+            return st;
+    }
+
+    comp->tail[comp->tailCount] = *entry;
+    comp->tailCount++;
+    comp->count++;
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+int timeseries_compressed_enforce_quota(timeseries_compressed_p comp,
+                                        timelib64_t oldestKeepTimestamp,
+                                        int maxKeepEntries)
+{
+    int st, numToRemove;
+
+    if (oldestKeepTimestamp)
+    {
+        while (comp->numBlocks && comp->blocks[0].lastTimestamp < oldestKeepTimestamp)
+            timeseries_compressed_drop_first_block(comp);
+
+        if (comp->numBlocks && comp->blocks[0].firstValidTimestamp < oldestKeepTimestamp)
+        {
+            timeseries_cblock_p block = &comp->blocks[0];
+
+            st = timeseries_decode_block(comp, 0);
+            if (st)
+                return st;
+
+            /* lastTimestamp >= oldestKeepTimestamp, so this stops inside the block */
+            while (comp->decoded[block->firstIndex].usecSince1970 < oldestKeepTimestamp)
+            {
+                block->firstIndex++;
+                comp->count--;
+            }
+            block->firstValidTimestamp = comp->decoded[block->firstIndex].usecSince1970;
+        }
+
+        /* The tail is only older than oldestKeepTimestamp if every block is gone */
+        if (!comp->numBlocks)
+        {
+            numToRemove = 0;
+            while (numToRemove < comp->tailCount && comp->tail[numToRemove].usecSince1970 < oldestKeepTimestamp)
+                numToRemove++;
+            timeseries_compressed_trim_tail(comp, numToRemove);
+        }
+    }
+
+    if (!maxKeepEntries || comp->count <= maxKeepEntries)
+        return TS_ST_OK;
+
+    numToRemove = comp->count - maxKeepEntries;
+
+    while (numToRemove && comp->numBlocks)
+    {
+        timeseries_cblock_p block = &comp->blocks[0];
+        int numValid              = block->count - block->firstIndex;
+
+        if (numValid <= numToRemove)
+        {
+            timeseries_compressed_drop_first_block(comp);
+            numToRemove -= numValid;
+            continue;
+        }
+
+        st = timeseries_decode_block(comp, 0);
+        if (st)
+            return st;
+
+        block->firstIndex += numToRemove;
+        block->firstValidTimestamp = comp->decoded[block->firstIndex].usecSince1970;
+        comp->count -= numToRemove;
+        numToRemove = 0;
+    }
+
+    if (numToRemove)
+        timeseries_compressed_trim_tail(comp, numToRemove);
+
+    return TS_ST_OK;
+}
+
+/*****************************************************************************/
+long long timeseries_compressed_bytes_used(timeseries_compressed_p comp)
+{
+    return sizeof(*comp) + sizeof(timeseries_cblock_t) * (long long)comp->maxBlocks + comp->compressedBytes
+           + sizeof(timeseries_entry_t) * (long long)comp->decodedCapacity;
+}
+
+/*****************************************************************************/
+timeseries_entry_p timeseries_compressed_first(timeseries_compressed_p comp, timeseries_cursor_p cursor)
+{
+    return timeseries_compressed_seek_forward(comp, 0, timeseries_compressed_begin(comp, 0), cursor);
+}
+
+/*****************************************************************************/
+timeseries_entry_p timeseries_compressed_last(timeseries_compressed_p comp, timeseries_cursor_p cursor)
+{
+    return timeseries_compressed_seek_backward(comp, comp->numBlocks, comp->tailCount - 1, cursor);
+}
+
+/*****************************************************************************/
+timeseries_entry_p timeseries_compressed_next(timeseries_compressed_p comp, timeseries_cursor_p cursor)
+{
+    if (cursor->blockIndex < 0)
+        return NULL;
+    return timeseries_compressed_seek_forward(comp, cursor->blockIndex, cursor->subIndex + 1, cursor);
+}
+
+/*****************************************************************************/
+timeseries_entry_p timeseries_compressed_prev(timeseries_compressed_p comp, timeseries_cursor_p cursor)
+{
+    if (cursor->blockIndex < 0)
+        return NULL;
+    return timeseries_compressed_seek_backward(comp, cursor->blockIndex, cursor->subIndex - 1, cursor);
+}
+
+/*****************************************************************************/
+timeseries_entry_p timeseries_compressed_find(timeseries_compressed_p comp,
+                                              timelib64_t time,
+                                              int findOp,
+                                              timeseries_cursor_p cursor)
+{
+    int blockIndex, subIndex;
+    int exact                = 0;
+    timeseries_entry_p entry = NULL;
+
+    if (timeseries_compressed_lower_bound(comp, time, &blockIndex, &subIndex))
+        return NULL;
+
+    entry = timeseries_compressed_seek_forward(comp, blockIndex, subIndex, cursor);
+    exact = entry && entry->usecSince1970 == time;
+
+    switch (findOp)
+    {
+        case TS_LGE_EQUAL:
+            return exact ? entry : NULL;
+        case TS_LGE_GREATEQUAL:
+            return entry;
+        case TS_LGE_GREATER:
+            return exact ? timeseries_compressed_next(comp, cursor) : entry;
+        case TS_LGE_LESSEQUAL:
+            if (exact)
+                return entry;
+            return timeseries_compressed_seek_backward(comp, blockIndex, subIndex - 1, cursor);
+        case TS_LGE_LESS:
+            return timeseries_compressed_seek_backward(comp, blockIndex, subIndex - 1, cursor);
+        default:
+            return NULL;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * timeseries_compressed.h
+ *
+ * Compressed storage backend for numeric timeseries. This is internal to
+ * timeseries.c. Use timeseries_alloc_compressed() to get a timeseries that
+ * uses it.
+ */
+
+#ifndef TIMESERIES_COMPRESSED_H
+#define TIMESERIES_COMPRESSED_H
+
+#include "timeseries.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*****************************************************************************/
+/* Number of entries that are buffered uncompressed before being sealed into
+   a compressed block */
+#define TS_COMPRESSED_BLOCK_ENTRIES 128
+
+    /*****************************************************************************/
+    /* A sealed block of entries. Timestamps are delta-of-delta encoded and
+ * values are XOR encoded against the previous value, Gorilla style.
+ */
+    typedef struct timeseries_cblock_t
+    {
+        unsigned char *bits;             /* Encoded bitstream */
+        int numBytes;                    /* Size of bits in bytes */
+        int count;                       /* Number of entries encoded in bits */
+        int firstIndex;                  /* Entries before this index were removed by quota enforcement */
+        timelib64_t firstValidTimestamp; /* Timestamp of the entry at firstIndex */
+        timelib64_t lastTimestamp;       /* Timestamp of the entry at count - 1 */
+    } timeseries_cblock_t, *timeseries_cblock_p;
+
+    /*****************************************************************************/
+    typedef struct timeseries_compressed_t
+    {
+        timeseries_cblock_t *blocks; /* Sealed blocks, oldest first */
+        int numBlocks;               /* Number of valid entries in blocks */
+        int maxBlocks;               /* Number of entries allocated in blocks */
+
+        timeseries_entry_t tail[TS_COMPRESSED_BLOCK_ENTRIES]; /* Newest entries, not compressed yet */
+        int tailCount;                                        /* Number of valid entries in tail */
+
+        timeseries_entry_t *decoded; /* Scratch space holding the entries of one decoded block */
+        int decodedCapacity;         /* Number of entries allocated in decoded */
+        int decodedBlock;            /* Index into blocks of what is in decoded. -1 = nothing */
+
+        int count;                 /* Number of entries in the whole series */
+        long long compressedBytes; /* Sum of numBytes across all blocks */
+    } timeseries_compressed_t;
+
+    /*****************************************************************************/
+    timeseries_compressed_p timeseries_compressed_alloc(int *errorSt);
+    void timeseries_compressed_destroy(timeseries_compressed_p comp);
+
+    /*****************************************************************************/
+    /*
+ * Insert entry, resolving duplicate timestamps by incrementing entry's
+ * timestamp until it is unique
+ */
+    int timeseries_compressed_insert(timeseries_compressed_p comp, timeseries_entry_p entry);
+    int timeseries_compressed_enforce_quota(timeseries_compressed_p comp,
+                                            timelib64_t oldestKeepTimestamp,
+                                            int maxKeepEntries);
+
+    /*****************************************************************************/
+    long long timeseries_compressed_bytes_used(timeseries_compressed_p comp);
+
+    /*****************************************************************************/
+    /*
+ * Cursor navigation. The returned entries point into either the uncompressed
+ * tail or the decode scratch space, so they are only valid until the next
+ * call on this series.
+ */
+    timeseries_entry_p timeseries_compressed_first(timeseries_compressed_p comp, timeseries_cursor_p cursor);
+    timeseries_entry_p timeseries_compressed_last(timeseries_compressed_p comp, timeseries_cursor_p cursor);
+    timeseries_entry_p timeseries_compressed_next(timeseries_compressed_p comp, timeseries_cursor_p cursor);
+    timeseries_entry_p timeseries_compressed_prev(timeseries_compressed_p comp, timeseries_cursor_p cursor);
+    timeseries_entry_p timeseries_compressed_find(timeseries_compressed_p comp,
+                                                  timelib64_t time,
+                                                  int findOp,
+                                                  timeseries_cursor_p cursor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMESERIES_COMPRESSED_H */
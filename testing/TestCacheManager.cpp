@@ -16,9 +16,11 @@
 
 #include "TestCacheManager.h"
 #include "DcgmCacheManager.h"
+#include "DcgmEntityKeyMap.h"
 #include "DcgmTopology.hpp"
 #include "dcgm_fields.h"
 #include "dcgm_structs.h"
+#include <algorithm>
 #include <bitset>
 #include <chrono>
 #include <iostream>
@@ -2173,6 +2175,68 @@ int TestCacheManager::TestUpdatePerf()
     return retSt;
 }
 
+/*****************************************************************************/
+int TestCacheManager::TestWatchLookupPerf()
+{
+    /* Lookups through the same map type as the watch table, at watch counts well past a real host's */
+    int const numWatchCounts              = 3;
+    int const watchCounts[numWatchCounts] = { 10000, 100000, 1000000 };
+    int const numLookups                  = 10000000;
+
+    for (int i = 0; i < numWatchCounts; i++)
+    {
+        int const numWatches = watchCounts[i];
+        std::vector<dcgm_entity_key_t> keys(numWatches);
+        std::vector<dcgmcm_watch_info_t> watchInfos(numWatches);
+        DcgmEntityKeyMap<dcgmcm_watch_info_t> watchTable;
+
+        /* Spread the watches over GPUs and fields like a big fleet of entities would be */
+        for (int j = 0; j < numWatches; j++)
+        {
+            keys[j].entityGroupId = DCGM_FE_GPU;
+            keys[j].entityId      = j / DCGM_FI_MAX_FIELDS;
+            keys[j].fieldId       = j % DCGM_FI_MAX_FIELDS;
+            if (!watchTable.Insert(keys[j], &watchInfos[j]))
+            {
+                fprintf(stderr, "Unexpected duplicate watch key at %d\n", j);
+                return 100;
+            }
+        }
+
+        /* Visit the keys in a scattered order so the timing isn't just sequential slot access */
+        unsigned int keyIndex = 0;
+        long long numFound    = 0;
+        timelib64_t startTime = timelib_usecSince1970();
+
+        for (int j = 0; j < numLookups; j++)
+        {
+            keyIndex = (keyIndex + 7919) % numWatches;
+            if (watchTable.Find(keys[keyIndex]) == &watchInfos[keyIndex])
+            {
+                numFound++;
+            }
+        }
+
+        timelib64_t endTime = timelib_usecSince1970();
+
+        if (numFound != numLookups)
+        {
+            fprintf(stderr, "Found %lld of %d watches\n", numFound, numLookups);
+            return 200;
+        }
+
+        long long elapsedUsec = std::max((long long)(endTime - startTime), 1LL);
+        printf("TestWatchLookupPerf %d watches: %d lookups in %lld usec, %.1f million lookups/sec (IsDebug %d)\n",
+               numWatches,
+               numLookups,
+               elapsedUsec,
+               (double)numLookups / (double)elapsedUsec,
+               IsDebugBuild());
+    }
+
+    return 0;
+}
+
 /*****************************************************************************/
 int TestCacheManager::TestSimulatedAttachDetach()
 {
@@ -2603,6 +2667,7 @@ int TestCacheManager::Run()
     try
     {
         CompleteTest("TestUpdatePerf", TestUpdatePerf(), Nfailed);
+        CompleteTest("TestWatchLookupPerf", TestWatchLookupPerf(), Nfailed);
         CompleteTest("TestLockstepModeAwakeTime", TestLockstepModeAwakeTime(), Nfailed);
         CompleteTest("TestTimedModeAwakeTime", TestTimedModeAwakeTime(), Nfailed);
         CompleteTest("TestWatchesVisited", TestWatchesVisited(), Nfailed);
@@ -63,6 +63,7 @@ private:
     int TestTimedModeAwakeTime();
     int TestLockstepModeAwakeTime();
     int TestUpdatePerf();
+    int TestWatchLookupPerf();
     int TestWatchesVisited();
     int TestFieldValueConversion();
     int TestConvertVectorToBitmask();
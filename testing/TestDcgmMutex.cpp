@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "TestDcgmMutex.h"
+#include <atomic>
 #include <fmt/format.h>
 #include <iostream>
 #include <stdexcept>
@@ -74,6 +75,9 @@ int TestDcgmMutex::Run()
         CompleteTest("TestPerf", TestPerf(), Nfailed);
         CompleteTest("TestDoubleLock", TestDoubleLock(), Nfailed);
         CompleteTest("TestDoubleUnlock", TestDoubleUnlock(), Nfailed);
+        CompleteTest("TestShared", TestShared(), Nfailed);
+        CompleteTest("TestSharedRecursion", TestSharedRecursion(), Nfailed);
+        CompleteTest("TestProfiling", TestProfiling(), Nfailed);
     }
     // fatal test return ocurred
     catch (const std::runtime_error &e)
@@ -205,3 +209,170 @@ int TestDcgmMutex::TestDoubleUnlock(void)
 
 
 /*****************************************************************************/
+
+/*****************************************************************************/
+int TestDcgmMutex::TestShared(void)
+{
+    int Nfailed = 0;
+    DcgmMutex mutex(0);
+    std::atomic_int sharedHolders    = 0;
+    std::atomic_int maxSharedHolders = 0;
+    std::atomic_bool exclusiveHeld   = false;
+    std::atomic_int overlaps         = 0;
+
+    auto reader = [&]() {
+        for (int i = 0; i < 2000; i++)
+        {
+            DcgmSharedLockGuard guard(&mutex);
+            if (exclusiveHeld)
+            {
+                overlaps++;
+            }
+            int holders = ++sharedHolders;
+            int prevMax = maxSharedHolders;
+            while (holders > prevMax && !maxSharedHolders.compare_exchange_weak(prevMax, holders))
+            {
+            }
+            std::this_thread::yield();
+            sharedHolders--;
+        }
+    };
+
+    auto writer = [&]() {
+        for (int i = 0; i < 500; i++)
+        {
+            DcgmLockGuard guard(&mutex);
+            exclusiveHeld = true;
+            if (sharedHolders != 0)
+            {
+                overlaps++;
+            }
+            exclusiveHeld = false;
+        }
+    };
+
+    std::thread reader1(reader);
+    std::thread reader2(reader);
+    std::thread reader3(reader);
+    std::thread writer1(writer);
+    reader1.join();
+    reader2.join();
+    reader3.join();
+    writer1.join();
+
+    if (overlaps != 0)
+    {
+        std::cerr << "TestShared saw " << overlaps << " overlaps of shared and exclusive holders" << std::endl;
+        Nfailed++;
+    }
+
+    if (maxSharedHolders < 2)
+    {
+        /* Not a failure. The scheduler may never have overlapped the readers */
+        std::cout << "TestShared never saw concurrent shared holders" << std::endl;
+    }
+
+    if (mutex.Poll() != DCGM_MUTEX_ST_NOTLOCKED)
+    {
+        std::cerr << "TestShared left the mutex locked" << std::endl;
+        Nfailed++;
+    }
+
+    return Nfailed;
+}
+
+/*****************************************************************************/
+int TestDcgmMutex::TestSharedRecursion(void)
+{
+    int Nfailed = 0;
+    DcgmMutex mutex(0);
+
+    if (dcgm_mutex_lock_shared(&mutex) != DCGM_MUTEX_ST_OK || dcgm_mutex_lock_shared(&mutex) != DCGM_MUTEX_ST_OK)
+    {
+        std::cerr << "TestSharedRecursion couldn't lock shared twice" << std::endl;
+        Nfailed++;
+    }
+
+    /* No upgrades */
+    if (dcgm_mutex_lock(&mutex) != DCGM_MUTEX_ST_ERROR)
+    {
+        std::cerr << "TestSharedRecursion locked exclusively while holding shared" << std::endl;
+        Nfailed++;
+    }
+
+    dcgm_mutex_unlock_shared(&mutex);
+    dcgm_mutex_unlock_shared(&mutex);
+
+    if (dcgm_mutex_unlock_shared(&mutex) != DCGM_MUTEX_ST_NOTLOCKED)
+    {
+        std::cerr << "TestSharedRecursion unlocked shared more than locked" << std::endl;
+        Nfailed++;
+    }
+
+    /* Shared under exclusive is a no-op */
+    dcgm_mutex_lock(&mutex);
+    if (dcgm_mutex_lock_shared(&mutex) != DCGM_MUTEX_ST_LOCKEDBYME)
+    {
+        std::cerr << "TestSharedRecursion expected DCGM_MUTEX_ST_LOCKEDBYME" << std::endl;
+        Nfailed++;
+    }
+    dcgm_mutex_unlock(&mutex);
+
+    return Nfailed;
+}
+
+/*****************************************************************************/
+int TestDcgmMutex::TestProfiling(void)
+{
+    int Nfailed = 0;
+    DcgmMutex mutex(0);
+    mutex.EnableProfiling("TestProfiling");
+
+    int const exclusiveLine = __LINE__ + 3;
+    for (int i = 0; i < 10; i++)
+    {
+        dcgm_mutex_lock(&mutex);
+        dcgm_mutex_unlock(&mutex);
+    }
+
+    int const sharedLine = __LINE__ + 1;
+    dcgm_mutex_lock_shared(&mutex);
+    dcgm_mutex_unlock_shared(&mutex);
+
+    int found = 0;
+    for (auto const &site : DcgmMutex::GetProfiles())
+    {
+        if (site.mutexName != "TestProfiling")
+        {
+            continue;
+        }
+
+        long long holds = 0;
+        for (long long count : site.holdHistogram)
+        {
+            holds += count;
+        }
+
+        if (site.line == exclusiveLine && site.lockCount == 10 && holds == 10)
+        {
+            found++;
+        }
+        else if (site.line == sharedLine && site.sharedLockCount == 1 && holds == 1)
+        {
+            found++;
+        }
+        else
+        {
+            std::cerr << "TestProfiling unexpected site " << site.file << ":" << site.line << std::endl;
+            Nfailed++;
+        }
+    }
+
+    if (found != 2)
+    {
+        std::cerr << "TestProfiling found " << found << " of 2 sites" << std::endl;
+        Nfailed++;
+    }
+
+    return Nfailed;
+}
@@ -49,6 +49,9 @@ private:
     int TestDoubleLock();
     int TestDoubleUnlock();
     int TestPerf();
+    int TestShared();
+    int TestSharedRecursion();
+    int TestProfiling();
 
     /*************************************************************************/
     /*
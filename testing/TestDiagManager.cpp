@@ -225,12 +225,12 @@ int TestDiagManager::TestCreateNvvsCommand()
         nvvsBinPath = "/usr/libexec/datacenter-gpu-manager-4/nvvs";
 
     std::string diagResponseVersionArg = fmt::format("--response-version {}", dcgmDiagResponse_version11);
-    expected.push_back(nvvsBinPath + " --channel-fd 3 " + diagResponseVersionArg
+    expected.push_back(nvvsBinPath + " --channel-fd 3 --response-fd 4 " + diagResponseVersionArg
                        + " --specifiedtest long --configless -d NONE");
-    expected.push_back(nvvsBinPath + " --channel-fd 3 " + diagResponseVersionArg
+    expected.push_back(nvvsBinPath + " --channel-fd 3 --response-fd 4 " + diagResponseVersionArg
                        + " --specifiedtest \"memory bandwidth,sm stress,targeted stress\" --configless -d WARN");
     expected.push_back(
-        nvvsBinPath + " --channel-fd 3 " + diagResponseVersionArg
+        nvvsBinPath + " --channel-fd 3 --response-fd 4 " + diagResponseVersionArg
         + " --specifiedtest \"memory bandwidth,sm stress,targeted stress\" --parameters \"memory bandwidth.minimum_bandwidth=5000;sm perf.target_stress=8500;targeted stress.test_duration=600\" --configless -d DEBUG");
 
     // When no test names are specified, none isn't valid
@@ -1146,6 +1146,214 @@ int TestKeyedVector::TestFindByKey()
     return 0;
 }
 
+/*****************************************************************************/
+int TestKeyedVector::TestAppendTruncateHead()
+{
+    int retSt = 0;
+    int i, st, testNelems;
+    kv_test_t testElems[1000];
+    kv_test_user_t userData;
+    kv_test_p elem;
+    kv_cursor_t cursor;
+    keyedvector_p kv;
+
+    memset(&userData, 0, sizeof(userData));
+    userData.elemBeingFreed.key = -1;
+
+    kv = keyedvector_alloc(sizeof(kv_test_t), 0, kv_test_cmpCB, kv_test_mergeCB, kv_test_freeCB, &userData, &st);
+    if (!kv)
+    {
+        fprintf(stderr, "keyedvector_alloc failed with %d\n", st);
+        retSt = 100;
+        goto CLEANUP;
+    }
+
+    testNelems = sizeof(testElems) / sizeof(testElems[0]);
+    for (i = 0; i < testNelems; i++)
+    {
+        testElems[i].key    = i * 2;
+        testElems[i].value  = i;
+        testElems[i].value2 = 0;
+    }
+
+    /* Spans many blocks */
+    st = keyedvector_append(kv, testElems, testNelems);
+    if (st != testNelems)
+    {
+        fprintf(stderr, "Expected %d appended. Got %d\n", testNelems, st);
+        retSt = 200;
+        goto CLEANUP;
+    }
+
+    /* Stops at the first element that isn't past the end */
+    testElems[0].key = testNelems * 2;
+    testElems[1].key = testNelems * 2 + 2;
+    testElems[2].key = testNelems * 2 + 1;
+    st               = keyedvector_append(kv, testElems, 3);
+    if (st != 2)
+    {
+        fprintf(stderr, "Expected 2 appended. Got %d\n", st);
+        retSt = 300;
+        goto CLEANUP;
+    }
+
+    testNelems += 2;
+    if (HelperVerifyOrder(kv) || HelperVerifySize(kv) || keyedvector_size(kv) != testNelems)
+    {
+        fprintf(stderr, "Bad keyedvector after append. size %d\n", keyedvector_size(kv));
+        retSt = 400;
+        goto CLEANUP;
+    }
+
+    /* Part of the first block, whole blocks plus part of the next one, then nothing */
+    for (int Nremove : { 3, 300, 0 })
+    {
+        st = keyedvector_truncate_head(kv, Nremove);
+        if (st)
+        {
+            fprintf(stderr, "keyedvector_truncate_head(%d) failed with %d\n", Nremove, st);
+            retSt = 500;
+            goto CLEANUP;
+        }
+
+        testNelems -= Nremove;
+        elem = (kv_test_p)keyedvector_first(kv, &cursor);
+        if (!elem || elem->key != (1002 - testNelems) * 2 || keyedvector_size(kv) != testNelems
+            || HelperVerifyOrder(kv) || HelperVerifySize(kv))
+        {
+            fprintf(stderr, "Bad keyedvector after removing %d. first %d\n", Nremove, elem ? elem->key : -1);
+            retSt = 600;
+            goto CLEANUP;
+        }
+    }
+
+    /* More than there are empties it */
+    st = keyedvector_truncate_head(kv, testNelems + 1);
+    if (st || keyedvector_size(kv) != 0 || keyedvector_first(kv, &cursor))
+    {
+        fprintf(stderr, "truncate past the end returned %d, size %d\n", st, keyedvector_size(kv));
+        retSt = 700;
+        goto CLEANUP;
+    }
+
+    if (userData.NfreeCBCalls != 1002)
+    {
+        fprintf(stderr, "Expected 1002 freeCB calls. Got %d\n", userData.NfreeCBCalls);
+        retSt = 800;
+        goto CLEANUP;
+    }
+
+    /* Still usable */
+    st = keyedvector_append(kv, testElems, 2);
+    if (st != 2 || HelperVerifyOrder(kv) || HelperVerifySize(kv))
+    {
+        fprintf(stderr, "Append after truncate returned %d\n", st);
+        retSt = 900;
+        goto CLEANUP;
+    }
+
+CLEANUP:
+    if (kv)
+    {
+        keyedvector_destroy(kv);
+        kv = 0;
+    }
+    return retSt;
+}
+
+/*****************************************************************************/
+int TestKeyedVector::TestTimingSlidingWindow()
+{
+    int retSt = 0;
+    int i, j, st, pass;
+    kv_test_t testElems[64];
+    kv_cursor_t cursor, endCursor;
+    keyedvector_p kv = 0;
+    timelib64_t t1, diff;
+    int const windowNelems = 10000;   /* Elements kept, like the samples of a watch within its max age */
+    int const testNelems   = 2000000; /* Elements pushed through the window */
+    int const batchNelems  = sizeof(testElems) / sizeof(testElems[0]);
+
+    /* Pass 0 inserts and removes one element at a time like timeseries used to. Pass 1 appends a batch at a time
+       and truncates the head */
+    for (pass = 0; pass < 2; pass++)
+    {
+        kv = keyedvector_alloc(sizeof(kv_test_t), 2048, kv_test_cmpCB, kv_test_mergeCB, 0, 0, &st);
+        if (!kv)
+        {
+            fprintf(stderr, "keyedvector_alloc failed with %d\n", st);
+            retSt = 100;
+            goto CLEANUP;
+        }
+
+        t1 = timelib_usecSince1970();
+
+        for (i = 0; i < testNelems; i += batchNelems)
+        {
+            for (j = 0; j < batchNelems; j++)
+            {
+                testElems[j].key    = i + j;
+                testElems[j].value  = 0;
+                testElems[j].value2 = 0;
+            }
+
+            if (pass == 0)
+            {
+                for (j = 0; j < batchNelems; j++)
+                {
+                    st = keyedvector_insert(kv, &testElems[j], &cursor);
+                    if (!st && keyedvector_size(kv) > windowNelems)
+                    {
+                        keyedvector_find_by_index(kv, keyedvector_size(kv) - windowNelems - 1, &endCursor);
+                        st = keyedvector_remove_range_by_cursor(kv, NULL, &endCursor);
+                    }
+                    if (st)
+                        break;
+                }
+            }
+            else
+            {
+                st = keyedvector_append(kv, testElems, batchNelems);
+                st = st == batchNelems ? 0 : KV_ST_CORRUPT;
+                if (!st && keyedvector_size(kv) > windowNelems)
+                    st = keyedvector_truncate_head(kv, keyedvector_size(kv) - windowNelems);
+            }
+
+            if (st)
+            {
+                fprintf(stderr, "Error %d in pass %d at %d\n", st, pass, i);
+                retSt = 200;
+                goto CLEANUP;
+            }
+        }
+
+        diff = timelib_usecSince1970() - t1;
+        printf("Sliding window pass %d: %d elements in %lld usec (%f Melem/sec)\n",
+               pass,
+               testNelems,
+               (long long)diff,
+               diff ? (double)testNelems / (double)diff : 0.0);
+
+        if (keyedvector_size(kv) != windowNelems || HelperVerifySize(kv))
+        {
+            fprintf(stderr, "Expected %d elements. Got %d\n", windowNelems, keyedvector_size(kv));
+            retSt = 300;
+            goto CLEANUP;
+        }
+
+        keyedvector_destroy(kv);
+        kv = 0;
+    }
+
+CLEANUP:
+    if (kv)
+    {
+        keyedvector_destroy(kv);
+        kv = 0;
+    }
+    return retSt;
+}
+
 /*****************************************************************************/
 int TestKeyedVector::Run()
 {
@@ -1216,6 +1424,15 @@ int TestKeyedVector::Run()
         printf("TestLinearRemoveForward PASSED\n");
 
 
+    st = TestAppendTruncateHead();
+    if (st)
+    {
+        fprintf(stderr, "TestAppendTruncateHead failed with %d\n", st);
+        Nfailed++;
+    }
+    else
+        printf("TestAppendTruncateHead PASSED\n");
+
     st = TestTimingRandomInsert();
     if (st)
     {
@@ -1234,6 +1451,15 @@ int TestKeyedVector::Run()
     else
         printf("TestTimingLinearInsert PASSED\n");
 
+    st = TestTimingSlidingWindow();
+    if (st)
+    {
+        fprintf(stderr, "TestTimingSlidingWindow failed with %d\n", st);
+        Nfailed++;
+    }
+    else
+        printf("TestTimingSlidingWindow PASSED\n");
+
     return 0;
 }
 
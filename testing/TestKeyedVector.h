@@ -59,6 +59,8 @@ private:
     int TestFindByKey();
     int TestFindByIndex();
     int TestLinearInsertForward();
+    int TestAppendTruncateHead();
+    int TestTimingSlidingWindow();
 
     /*************************************************************************/
     /*
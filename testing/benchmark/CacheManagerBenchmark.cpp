@@ -0,0 +1,590 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Stress benchmark for the cache manager at scale. Fills a DcgmCacheManager
+ * with fake GPUs, GPU instances and compute instances the way TestCacheManager
+ * does, watches a field set on every entity and feeds the watches at their
+ * update interval, while concurrent readers query the cache. Reports the
+ * update loop duration, how long each batch of samples held the cache manager
+ * lock, lock contention, memory per retained sample and reader latency
+ * percentiles, so cache layout changes can be compared run to run.
+ *
+ * The cache manager only watches fields when NVML is loaded. On hosts without
+ * GPUs, run it with nvml-injection:
+ *   NVML_INJECTION_MODE=True NVML_YAML_FILE=<file> dcgm_cache_benchmark
+ * The GPUs NVML reports count against DCGM_MAX_NUM_DEVICES with the fake ones.
+ */
+#include "LatencyStats.h"
+
+#include <DcgmCacheManager.h>
+#include <DcgmFvBuffer.h>
+#include <DcgmLogging.h>
+#include <dcgm_fields.h>
+#include <dcgm_structs.h>
+#include <nvml.h>
+#include <timelib.h>
+
+#include <fmt/format.h>
+#include <tclap/ArgException.h>
+#include <tclap/CmdLine.h>
+#include <tclap/ValueArg.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/*****************************************************************************/
+enum BenchmarkRead
+{
+    BenchmarkReadLatest = 0, /* GetLatestSample of one entity and field */
+    BenchmarkReadMultiple,   /* GetMultipleLatestSamples of every entity and field */
+    BenchmarkReadRange,      /* GetSamples of the newest samples of one entity and field */
+    BenchmarkReadCount
+};
+
+constexpr std::array<char const *, BenchmarkReadCount> READ_NAMES = { "latest", "multiple", "range" };
+
+/* Samples fetched by each range read */
+constexpr int RANGE_READ_SAMPLES = 100;
+
+/*****************************************************************************/
+struct BenchmarkOptions
+{
+    unsigned int gpus;                    /* Fake GPUs to add */
+    unsigned int instancesPerGpu;         /* Fake GPU instances to add to each fake GPU */
+    unsigned int computeInstances;        /* Fake compute instances to add to each fake GPU instance */
+    std::vector<unsigned short> fieldIds; /* Watched on every entity */
+    unsigned int intervalMs;              /* Update interval of the watches */
+    unsigned int keepSamples;             /* maxKeepSamples of the watches */
+    unsigned int readers;                 /* Concurrent reader threads */
+    unsigned int durationSec;             /* How long to run for */
+};
+
+/*****************************************************************************/
+struct ReaderResult
+{
+    std::array<LatencyStats, BenchmarkReadCount> stats;
+};
+
+/*****************************************************************************/
+struct WriterResult
+{
+    LatencyStats injectStats; /* One batch of every watch per update interval. Holds the lock throughout */
+    long long samples = 0;    /* Samples injected */
+};
+
+/*****************************************************************************/
+/* Parse a comma-separated list of numeric field IDs like "150,155,100" */
+bool ParseFieldIds(std::string const &list, std::vector<unsigned short> &fieldIds)
+{
+    std::stringstream ss(list);
+    std::string item;
+
+    fieldIds.clear();
+    while (std::getline(ss, item, ','))
+    {
+        unsigned long fieldId;
+        try
+        {
+            fieldId = std::stoul(item);
+        }
+        catch (std::exception const &)
+        {
+            return false;
+        }
+
+        dcgm_field_meta_p fieldMeta = DcgmFieldGetById(fieldId);
+        if (fieldMeta == nullptr || (fieldMeta->fieldType != DCGM_FT_INT64 && fieldMeta->fieldType != DCGM_FT_DOUBLE))
+        {
+            std::cerr << "Field " << item << " is unknown or not numeric" << std::endl;
+            return false;
+        }
+        fieldIds.push_back(fieldId);
+    }
+
+    return !fieldIds.empty();
+}
+
+/*****************************************************************************/
+bool ParseOptions(int argc, char *argv[], BenchmarkOptions &options)
+{
+    using TCLAP::CmdLine;
+    using TCLAP::ValueArg;
+
+    try
+    {
+        CmdLine cmdLine("DCGM cache manager scale-out benchmark", ' ', "1.0");
+
+        ValueArg<unsigned int> gpusArg(
+            "g", "gpus", "Fake GPUs to add, up to DCGM_MAX_NUM_DEVICES in all", false, 32, "COUNT", cmdLine);
+        ValueArg<unsigned int> instancesArg("i",
+                                            "instances",
+                                            "Fake GPU instances to add to each fake GPU",
+                                            false,
+                                            DCGM_MAX_INSTANCES_PER_GPU,
+                                            "COUNT",
+                                            cmdLine);
+        ValueArg<unsigned int> computeInstancesArg(
+            "", "compute-instances", "Fake compute instances to add to each GPU instance", false, 1, "COUNT", cmdLine);
+        ValueArg<std::string> fieldsArg("f",
+                                        "fields",
+                                        "Comma-separated numeric field IDs to watch on every entity",
+                                        false,
+                                        fmt::format("{},{},{},{},{},{}",
+                                                    DCGM_FI_DEV_GPU_TEMP,
+                                                    DCGM_FI_DEV_POWER_USAGE,
+                                                    DCGM_FI_DEV_SM_CLOCK,
+                                                    DCGM_FI_DEV_MEM_CLOCK,
+                                                    DCGM_FI_DEV_GPU_UTIL,
+                                                    DCGM_FI_DEV_FB_USED),
+                                        "IDS",
+                                        cmdLine);
+        ValueArg<unsigned int> intervalArg(
+            "", "interval-ms", "Update interval of the watches in milliseconds", false, 100, "MS", cmdLine);
+        ValueArg<unsigned int> keepArg(
+            "", "keep-samples", "Samples each watch keeps", false, 1000, "COUNT", cmdLine);
+        ValueArg<unsigned int> readersArg("r", "readers", "Concurrent reader threads", false, 4, "COUNT", cmdLine);
+        ValueArg<unsigned int> durationArg("d", "duration", "Seconds to run for", false, 10, "SECONDS", cmdLine);
+
+        cmdLine.parse(argc, argv);
+
+        options.gpus             = gpusArg.getValue();
+        options.instancesPerGpu  = std::min<unsigned int>(instancesArg.getValue(), DCGM_MAX_INSTANCES_PER_GPU);
+        options.computeInstances = computeInstancesArg.getValue();
+        options.intervalMs       = intervalArg.getValue();
+        options.keepSamples      = keepArg.getValue();
+        options.readers          = readersArg.getValue();
+        options.durationSec      = durationArg.getValue();
+
+        if (!ParseFieldIds(fieldsArg.getValue(), options.fieldIds))
+        {
+            std::cerr << "Bad field list " << fieldsArg.getValue() << std::endl;
+            return false;
+        }
+        if (options.intervalMs == 0 || options.keepSamples == 0 || options.durationSec == 0)
+        {
+            std::cerr << "--interval-ms, --keep-samples and --duration must be greater than 0" << std::endl;
+            return false;
+        }
+    }
+    catch (TCLAP::ArgException const &ex)
+    {
+        std::cerr << "Argument parsing error: " << ex.error() << " for argument " << ex.argId() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+/* Resident set size of this process in KB, or 0 if it can't be read */
+long long GetRssKb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status, line))
+    {
+        if (line.starts_with("VmRSS:"))
+        {
+            return std::strtoll(line.c_str() + 6, nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* Add the fake entities. Returns every entity that was added */
+std::vector<dcgmGroupEntityPair_t> AddFakeEntities(BenchmarkOptions const &options, DcgmCacheManager &cacheManager)
+{
+    std::vector<dcgmGroupEntityPair_t> entities;
+
+    for (unsigned int i = 0; i < options.gpus; i++)
+    {
+        unsigned int gpuId = cacheManager.AddFakeGpu();
+        if (gpuId == DCGM_GPU_ID_BAD)
+        {
+            fmt::print(stderr, "Stopped at {} fake GPUs. The cache manager is full\n", i);
+            break;
+        }
+        entities.push_back({ DCGM_FE_GPU, gpuId });
+
+        for (unsigned int j = 0; j < options.instancesPerGpu; j++)
+        {
+            dcgm_field_eid_t instanceId = cacheManager.AddFakeInstance(gpuId);
+            if (instanceId == DCGM_ENTITY_ID_BAD)
+            {
+                break;
+            }
+            entities.push_back({ DCGM_FE_GPU_I, instanceId });
+
+            for (unsigned int k = 0; k < options.computeInstances; k++)
+            {
+                dcgm_field_eid_t computeInstanceId = cacheManager.AddFakeComputeInstance(instanceId);
+                if (computeInstanceId == DCGM_ENTITY_ID_BAD)
+                {
+                    break;
+                }
+                entities.push_back({ DCGM_FE_GPU_CI, computeInstanceId });
+            }
+        }
+    }
+
+    return entities;
+}
+
+/*****************************************************************************/
+dcgmReturn_t WatchFields(BenchmarkOptions const &options,
+                         DcgmCacheManager &cacheManager,
+                         std::vector<dcgmGroupEntityPair_t> const &entities)
+{
+    DcgmWatcher watcher(DcgmWatcherTypeClient, DCGM_CONNECTION_ID_NONE);
+
+    for (auto const &entity : entities)
+    {
+        for (unsigned short fieldId : options.fieldIds)
+        {
+            bool wereFirstWatcher = false;
+            dcgmReturn_t ret      = cacheManager.AddFieldWatch(entity.entityGroupId,
+                                                          entity.entityId,
+                                                          fieldId,
+                                                          options.intervalMs * 1000LL,
+                                                          86400.0,
+                                                          options.keepSamples,
+                                                          watcher,
+                                                          false,
+                                                          false,
+                                                          wereFirstWatcher);
+            if (ret != DCGM_ST_OK)
+            {
+                fmt::print(stderr,
+                           "AddFieldWatch of field {} on entity {}:{} failed: {}\n",
+                           fieldId,
+                           (int)entity.entityGroupId,
+                           entity.entityId,
+                           errorString(ret));
+                return ret;
+            }
+        }
+    }
+
+    return DCGM_ST_OK;
+}
+
+/*****************************************************************************/
+/*
+ * Fake entities aren't polled, so stand in for the polling: once per update
+ * interval, inject one sample of every watch as one batch
+ */
+void RunWriter(BenchmarkOptions const &options,
+               DcgmCacheManager &cacheManager,
+               std::vector<dcgmGroupEntityPair_t> const &entities,
+               std::atomic_bool const &stop,
+               WriterResult &result)
+{
+    auto nextBatch = std::chrono::steady_clock::now();
+    long long tick = 0;
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        DcgmFvBuffer fvBuffer;
+        timelib64_t now = timelib_usecSince1970();
+
+        for (auto const &entity : entities)
+        {
+            for (unsigned short fieldId : options.fieldIds)
+            {
+                if (DcgmFieldGetById(fieldId)->fieldType == DCGM_FT_DOUBLE)
+                {
+                    fvBuffer.AddDoubleValue(
+                        entity.entityGroupId, entity.entityId, fieldId, 100.0 + tick % 50, now, DCGM_ST_OK);
+                }
+                else
+                {
+                    fvBuffer.AddInt64Value(entity.entityGroupId, entity.entityId, fieldId, tick, now, DCGM_ST_OK);
+                }
+                result.samples++;
+            }
+        }
+
+        auto start       = std::chrono::steady_clock::now();
+        dcgmReturn_t ret = cacheManager.InjectSamples(&fvBuffer);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        result.injectStats.Add(elapsed.count(), ret != DCGM_ST_OK);
+
+        tick++;
+        nextBatch += std::chrono::milliseconds(options.intervalMs);
+        std::this_thread::sleep_until(nextBatch);
+    }
+}
+
+/*****************************************************************************/
+void RunReader(unsigned int readerIndex,
+               DcgmCacheManager &cacheManager,
+               std::vector<dcgmGroupEntityPair_t> const &entities,
+               std::vector<unsigned short> const &fieldIds,
+               std::atomic_bool const &stop,
+               ReaderResult &result)
+{
+    std::mt19937 rng(readerIndex);
+    std::uniform_int_distribution<size_t> pickEntity(0, entities.size() - 1);
+    std::uniform_int_distribution<size_t> pickField(0, fieldIds.size() - 1);
+    std::vector<dcgmcm_sample_t> samples(RANGE_READ_SAMPLES);
+    auto allEntities = entities;
+    auto allFieldIds = fieldIds;
+    unsigned int i   = 0;
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        /* Mostly single reads, like exporters polling one value at a time */
+        int read = BenchmarkReadLatest;
+        if (i % 20 == 0)
+        {
+            read = BenchmarkReadMultiple;
+        }
+        else if (i % 10 == 0)
+        {
+            read = BenchmarkReadRange;
+        }
+
+        dcgmGroupEntityPair_t const &e = entities[pickEntity(rng)];
+        unsigned short fieldId         = fieldIds[pickField(rng)];
+        dcgmReturn_t ret               = DCGM_ST_OK;
+        auto start                     = std::chrono::steady_clock::now();
+
+        switch (read)
+        {
+            case BenchmarkReadLatest:
+                ret = cacheManager.GetLatestSample(e.entityGroupId, e.entityId, fieldId, samples.data(), nullptr);
+                break;
+
+            case BenchmarkReadMultiple:
+            {
+                DcgmFvBuffer fvBuffer;
+                ret = cacheManager.GetMultipleLatestSamples(allEntities, allFieldIds, &fvBuffer);
+                break;
+            }
+
+            case BenchmarkReadRange:
+            {
+                int count = RANGE_READ_SAMPLES;
+                ret       = cacheManager.GetSamples(
+                    e.entityGroupId, e.entityId, fieldId, samples.data(), &count, 0, 0, DCGM_ORDER_DESCENDING, nullptr);
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        /* Before the first batch lands there is nothing to read yet. That isn't an error */
+        result.stats[read].Add(elapsed.count(), ret != DCGM_ST_OK && ret != DCGM_ST_NO_DATA);
+        i++;
+    }
+}
+
+/*****************************************************************************/
+void PrintReport(BenchmarkOptions const &options,
+                 std::vector<dcgmGroupEntityPair_t> const &entities,
+                 std::vector<ReaderResult> &readerResults,
+                 WriterResult &writerResult,
+                 dcgmcm_runtime_stats_t const &statsBefore,
+                 dcgmcm_runtime_stats_t const &statsAfter,
+                 long long rssGrowthKb,
+                 double elapsedSec)
+{
+    std::array<unsigned int, DCGM_FE_COUNT> entityCounts {};
+    for (auto const &entity : entities)
+    {
+        entityCounts[entity.entityGroupId]++;
+    }
+
+    size_t const watches = entities.size() * options.fieldIds.size();
+    fmt::print("{} GPUs, {} GPU instances, {} compute instances. {} watches every {} ms, {} readers, {:.1f} s\n\n",
+               entityCounts[DCGM_FE_GPU],
+               entityCounts[DCGM_FE_GPU_I],
+               entityCounts[DCGM_FE_GPU_CI],
+               watches,
+               options.intervalMs,
+               options.readers,
+               elapsedSec);
+
+    fmt::print("{:<16} {:>10} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+               "operation",
+               "count",
+               "errors",
+               "ops/s",
+               "p50 us",
+               "p99 us",
+               "p999 us",
+               "max us");
+
+    auto printRow = [elapsedSec](char const *name, LatencyStats &stats) {
+        fmt::print("{:<16} {:>10} {:>8} {:>10.0f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n",
+                   name,
+                   stats.GetCount(),
+                   stats.GetErrorCount(),
+                   stats.GetCount() / elapsedSec,
+                   stats.GetPercentile(0.50) / 1000.0,
+                   stats.GetPercentile(0.99) / 1000.0,
+                   stats.GetPercentile(0.999) / 1000.0,
+                   stats.GetMax() / 1000.0);
+    };
+
+    /* InjectSamples() holds the cache manager lock for the whole batch */
+    printRow("inject (locked)", writerResult.injectStats);
+    for (unsigned int i = 0; i < BenchmarkReadCount; i++)
+    {
+        LatencyStats total;
+        for (auto &result : readerResults)
+        {
+            total.Merge(result.stats[i]);
+        }
+        printRow(READ_NAMES[i], total);
+    }
+
+    long long cycles    = statsAfter.updateCycleFinished - statsBefore.updateCycleFinished;
+    long long awakeUsec = statsAfter.awakeTimeUsec - statsBefore.awakeTimeUsec;
+    long long contended = statsAfter.lockContendedCount - statsBefore.lockContendedCount;
+    long long waitUsec  = statsAfter.lockContendedWaitUsec - statsBefore.lockContendedWaitUsec;
+
+    fmt::print("\nupdate loop: {} cycles, {:.1f} us awake per cycle\n",
+               cycles,
+               cycles > 0 ? (double)awakeUsec / cycles : 0.0);
+    fmt::print("lock: {} locks, {} contended, {:.1f} us average wait when contended\n",
+               statsAfter.lockCount - statsBefore.lockCount,
+               contended,
+               contended > 0 ? (double)waitUsec / contended : 0.0);
+    fmt::print("latest values: {} lock-free hits, {} misses\n",
+               statsAfter.latestValueHits - statsBefore.latestValueHits,
+               statsAfter.latestValueMisses - statsBefore.latestValueMisses);
+
+    /* Each watch keeps at most keepSamples, so later samples replace earlier ones */
+    long long retained = std::min<long long>(writerResult.samples, (long long)watches * options.keepSamples);
+    fmt::print("memory: {} samples retained, {} KB RSS growth, {:.1f} bytes per sample\n",
+               retained,
+               rssGrowthKb,
+               retained > 0 ? rssGrowthKb * 1024.0 / retained : 0.0);
+}
+} // namespace
+
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    DcgmLoggingInit("-", DcgmLoggingSeverityError, DcgmLoggingSeverityNone);
+
+    if (DcgmFieldsInit() != 0)
+    {
+        fmt::print(stderr, "DcgmFieldsInit failed\n");
+        return 1;
+    }
+
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    /* The cache manager needs NVML to watch GPU fields */
+    if (nvmlInit_v2() != NVML_SUCCESS)
+    {
+        fmt::print(stderr, "Unable to load NVML. Use NVML_INJECTION_MODE on hosts without GPUs\n");
+        return 1;
+    }
+
+    /* Watched in timed mode so the update loop runs on its own schedule like in the host engine */
+    auto cacheManager = std::make_unique<DcgmCacheManager>();
+    dcgmReturn_t ret  = cacheManager->Init(0, 86400.0, true);
+    if (ret == DCGM_ST_OK)
+    {
+        ret = cacheManager->Start() == 0 ? DCGM_ST_OK : DCGM_ST_GENERIC_ERROR;
+    }
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "Unable to start the cache manager: {}\n", errorString(ret));
+        nvmlShutdown();
+        return 1;
+    }
+
+    std::vector<dcgmGroupEntityPair_t> entities = AddFakeEntities(options, *cacheManager);
+    if (entities.empty() || WatchFields(options, *cacheManager, entities) != DCGM_ST_OK)
+    {
+        cacheManager.reset();
+        nvmlShutdown();
+        return 1;
+    }
+
+    dcgmcm_runtime_stats_t statsBefore {};
+    cacheManager->GetRuntimeStats(&statsBefore);
+    long long rssBeforeKb = GetRssKb();
+
+    std::atomic_bool stop { false };
+    WriterResult writerResult;
+    std::vector<ReaderResult> readerResults(options.readers);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    threads.emplace_back(RunWriter,
+                         std::cref(options),
+                         std::ref(*cacheManager),
+                         std::cref(entities),
+                         std::cref(stop),
+                         std::ref(writerResult));
+    for (unsigned int i = 0; i < options.readers; i++)
+    {
+        threads.emplace_back(RunReader,
+                             i,
+                             std::ref(*cacheManager),
+                             std::cref(entities),
+                             std::cref(options.fieldIds),
+                             std::cref(stop),
+                             std::ref(readerResults[i]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(options.durationSec));
+
+    /* Sample before stopping so that the figures reflect the load */
+    dcgmcm_runtime_stats_t statsAfter {};
+    cacheManager->GetRuntimeStats(&statsAfter);
+    long long rssGrowthKb = GetRssKb() - rssBeforeKb;
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    PrintReport(options, entities, readerResults, writerResult, statsBefore, statsAfter, rssGrowthKb, elapsedSec);
+
+    cacheManager.reset();
+    nvmlShutdown();
+    return 0;
+}
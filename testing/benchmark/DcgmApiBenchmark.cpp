@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Load generator for the host engine's transport and API layers. Runs a number
+ * of concurrent clients that issue a weighted mix of requests against an
+ * embedded host engine or a standalone nv-hostengine over TCP or a unix socket
+ * and reports the latency percentiles and throughput of each kind of request
+ * along with the host engine's CPU use.
+ *
+ * Pair it with nvml-injection to run without real GPUs:
+ *   NVML_INJECTION_MODE=True NVML_YAML_FILE=<file> nv-hostengine -n
+ * or pass --nvml-injection-yaml in embedded mode. --fake-gpus creates fake
+ * GPUs through the test API instead.
+ */
+#include "LatencyStats.h"
+
+#include <dcgm_agent.h>
+#include <dcgm_fields.h>
+#include <dcgm_structs.h>
+#include <dcgm_test_apis.h>
+
+#include <fmt/format.h>
+#include <tclap/ArgException.h>
+#include <tclap/CmdLine.h>
+#include <tclap/ValueArg.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/*****************************************************************************/
+enum BenchmarkRequest
+{
+    BenchmarkRequestLatestValues = 0, /* dcgmEntitiesGetLatestValues */
+    BenchmarkRequestValuesSince,      /* dcgmGetValuesSince_v2 */
+    BenchmarkRequestWatch,            /* dcgmWatchFields + dcgmUnwatchFields */
+    BenchmarkRequestPolicy,           /* dcgmPolicyRegister_v2 + dcgmPolicyUnregister */
+    BenchmarkRequestCount
+};
+
+constexpr std::array<char const *, BenchmarkRequestCount> REQUEST_NAMES = { "latest", "since", "watch", "policy" };
+
+/* Fields read by the latest and since requests. These are watched for the whole run */
+constexpr std::array<unsigned short, 5> READ_FIELD_IDS = { DCGM_FI_DEV_GPU_TEMP,
+                                                           DCGM_FI_DEV_POWER_USAGE,
+                                                           DCGM_FI_DEV_SM_CLOCK,
+                                                           DCGM_FI_DEV_MEM_CLOCK,
+                                                           DCGM_FI_DEV_GPU_UTIL };
+
+/* Fields that the watch request watches and unwatches. They must not overlap READ_FIELD_IDS */
+constexpr std::array<unsigned short, 2> WATCH_FIELD_IDS = { DCGM_FI_DEV_FB_USED, DCGM_FI_DEV_FB_FREE };
+
+/*****************************************************************************/
+struct BenchmarkOptions
+{
+    std::string mode;              /* embedded, tcp or unix */
+    std::string address;           /* Host engine address for tcp and unix */
+    unsigned int clients;          /* Number of concurrent clients */
+    unsigned int durationSec;      /* How long to issue requests for */
+    unsigned int fakeGpus;         /* Number of fake GPUs to create. 0 = use the GPUs the host engine has */
+    unsigned int compressMinBytes; /* dcgmConnectV2Params_v3.compressMinBytes for tcp */
+    std::string injectionYaml;     /* NVML injection file for embedded mode. "" = use the real NVML */
+    std::array<unsigned int, BenchmarkRequestCount> weights {}; /* Relative frequency of each request */
+};
+
+/*****************************************************************************/
+/* Objects created once by the setup connection and used by every client */
+struct BenchmarkSetup
+{
+    dcgmHandle_t handle         = 0;
+    dcgmGpuGrp_t groupId        = 0;
+    dcgmFieldGrp_t fieldGroupId = 0;
+    std::vector<dcgmGroupEntityPair_t> entities;
+};
+
+/*****************************************************************************/
+struct ClientResult
+{
+    dcgmReturn_t connectStatus = DCGM_ST_OK;
+    std::array<LatencyStats, BenchmarkRequestCount> stats;
+};
+
+/*****************************************************************************/
+/* Parse a mix like "latest:70,since:20,watch:5,policy:5". Requests that aren't listed get 0 */
+bool ParseMix(std::string const &mix, std::array<unsigned int, BenchmarkRequestCount> &weights)
+{
+    weights.fill(0);
+
+    std::stringstream ss(mix);
+    std::string item;
+    unsigned int total = 0;
+
+    while (std::getline(ss, item, ','))
+    {
+        auto colon = item.find(':');
+        if (colon == std::string::npos)
+        {
+            return false;
+        }
+
+        std::string name = item.substr(0, colon);
+        unsigned int i   = 0;
+        while (i < BenchmarkRequestCount && name != REQUEST_NAMES[i])
+        {
+            i++;
+        }
+        if (i == BenchmarkRequestCount)
+        {
+            return false;
+        }
+
+        try
+        {
+            weights[i] = std::stoul(item.substr(colon + 1));
+        }
+        catch (std::exception const &)
+        {
+            return false;
+        }
+        total += weights[i];
+    }
+
+    return total > 0;
+}
+
+/*****************************************************************************/
+bool ParseOptions(int argc, char *argv[], BenchmarkOptions &options)
+{
+    using TCLAP::CmdLine;
+    using TCLAP::ValueArg;
+
+    try
+    {
+        CmdLine cmdLine("DCGM transport and API latency benchmark", ' ', "1.0");
+
+        ValueArg<std::string> modeArg("m", "mode", "embedded, tcp or unix", false, "embedded", "MODE", cmdLine);
+        ValueArg<std::string> addressArg("a",
+                                         "address",
+                                         "Host engine address. IP[:PORT] for tcp or a socket path for unix",
+                                         false,
+                                         "",
+                                         "ADDRESS",
+                                         cmdLine);
+        ValueArg<unsigned int> clientsArg("c", "clients", "Number of concurrent clients", false, 4, "COUNT", cmdLine);
+        ValueArg<unsigned int> durationArg(
+            "d", "duration", "Seconds to issue requests for", false, 10, "SECONDS", cmdLine);
+        ValueArg<std::string> mixArg("",
+                                     "mix",
+                                     "Relative frequency of each request: latest, since, watch and policy",
+                                     false,
+                                     "latest:70,since:20,watch:5,policy:5",
+                                     "MIX",
+                                     cmdLine);
+        ValueArg<unsigned int> fakeGpusArg("",
+                                           "fake-gpus",
+                                           "Create this many fake GPUs to run against. 0 = use existing GPUs",
+                                           false,
+                                           0,
+                                           "COUNT",
+                                           cmdLine);
+        ValueArg<unsigned int> compressArg("",
+                                           "compress-min-bytes",
+                                           "Compress tcp messages of at least this many bytes. 0 = don't compress",
+                                           false,
+                                           0,
+                                           "BYTES",
+                                           cmdLine);
+        ValueArg<std::string> injectionArg("",
+                                           "nvml-injection-yaml",
+                                           "NVML injection file to start the embedded host engine with",
+                                           false,
+                                           "",
+                                           "FILE",
+                                           cmdLine);
+
+        cmdLine.parse(argc, argv);
+
+        options.mode             = modeArg.getValue();
+        options.address          = addressArg.getValue();
+        options.clients          = clientsArg.getValue();
+        options.durationSec      = durationArg.getValue();
+        options.fakeGpus         = fakeGpusArg.getValue();
+        options.compressMinBytes = compressArg.getValue();
+        options.injectionYaml    = injectionArg.getValue();
+
+        if (options.mode != "embedded" && options.mode != "tcp" && options.mode != "unix")
+        {
+            std::cerr << "Unknown mode " << options.mode << std::endl;
+            return false;
+        }
+        if (!ParseMix(mixArg.getValue(), options.weights))
+        {
+            std::cerr << "Bad request mix " << mixArg.getValue() << std::endl;
+            return false;
+        }
+        if (options.clients == 0 || options.durationSec == 0)
+        {
+            std::cerr << "--clients and --duration must be greater than 0" << std::endl;
+            return false;
+        }
+        if (options.address.empty())
+        {
+            options.address = options.mode == "unix" ? "/tmp/nv-hostengine" : "127.0.0.1";
+        }
+    }
+    catch (TCLAP::ArgException const &ex)
+    {
+        std::cerr << "Argument parsing error: " << ex.error() << " for argument " << ex.argId() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+dcgmReturn_t Connect(BenchmarkOptions const &options, dcgmHandle_t &handle)
+{
+    dcgmConnectV2Params_v3 params {};
+    params.version             = dcgmConnectV2Params_version3;
+    params.timeoutMs           = 5000;
+    params.addressIsUnixSocket = options.mode == "unix" ? 1 : 0;
+    params.compressMinBytes    = options.compressMinBytes;
+
+    return dcgmConnect_v2(options.address.c_str(), &params, &handle);
+}
+
+/*****************************************************************************/
+dcgmReturn_t StartEmbedded(BenchmarkOptions const &options, dcgmHandle_t &handle)
+{
+    if (!options.injectionYaml.empty())
+    {
+        /* Read by the host engine when it loads NVML */
+        setenv("NVML_INJECTION_MODE", "True", 1);
+        setenv("NVML_YAML_FILE", options.injectionYaml.c_str(), 1);
+    }
+
+    dcgmStartEmbeddedV2Params_v1 params {};
+    params.version  = dcgmStartEmbeddedV2Params_version1;
+    params.opMode   = DCGM_OPERATION_MODE_AUTO;
+    params.logFile  = nullptr;
+    params.severity = DcgmLoggingSeverityWarning;
+
+    dcgmReturn_t ret = dcgmStartEmbedded_v2(&params);
+    handle           = params.dcgmHandle;
+    return ret;
+}
+
+/*****************************************************************************/
+dcgmReturn_t SetUp(BenchmarkOptions const &options, BenchmarkSetup &setup)
+{
+    dcgmReturn_t ret
+        = options.mode == "embedded" ? StartEmbedded(options, setup.handle) : Connect(options, setup.handle);
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "Unable to start or connect to the host engine: {}\n", errorString(ret));
+        return ret;
+    }
+
+    if (options.fakeGpus > 0)
+    {
+        dcgmCreateFakeEntities_t cfe {};
+        cfe.version     = dcgmCreateFakeEntities_version;
+        cfe.numToCreate = std::min<unsigned int>(options.fakeGpus, DCGM_MAX_HIERARCHY_INFO);
+        for (unsigned int i = 0; i < cfe.numToCreate; i++)
+        {
+            cfe.entityList[i].entity.entityGroupId = DCGM_FE_GPU;
+        }
+
+        ret = dcgmCreateFakeEntities(setup.handle, &cfe);
+        if (ret != DCGM_ST_OK)
+        {
+            fmt::print(stderr, "Unable to create {} fake GPUs: {}\n", cfe.numToCreate, errorString(ret));
+            return ret;
+        }
+
+        for (unsigned int i = 0; i < cfe.numToCreate; i++)
+        {
+            setup.entities.push_back(cfe.entityList[i].entity);
+        }
+    }
+    else
+    {
+        unsigned int gpuIds[DCGM_MAX_NUM_DEVICES];
+        int count = 0;
+
+        ret = dcgmGetAllSupportedDevices(setup.handle, gpuIds, &count);
+        if (ret != DCGM_ST_OK || count == 0)
+        {
+            fmt::print(stderr, "The host engine has no supported GPUs. Use --fake-gpus or NVML injection\n");
+            return ret != DCGM_ST_OK ? ret : DCGM_ST_GPU_NOT_SUPPORTED;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            setup.entities.push_back({ DCGM_FE_GPU, gpuIds[i] });
+        }
+    }
+
+    char groupName[]      = "dcgm_api_benchmark";
+    char fieldGroupName[] = "dcgm_api_benchmark";
+    auto fieldIds         = READ_FIELD_IDS;
+
+    ret = dcgmGroupCreate(setup.handle, DCGM_GROUP_EMPTY, groupName, &setup.groupId);
+    for (size_t i = 0; ret == DCGM_ST_OK && i < setup.entities.size(); i++)
+    {
+        ret = dcgmGroupAddEntity(
+            setup.handle, setup.groupId, setup.entities[i].entityGroupId, setup.entities[i].entityId);
+    }
+    if (ret == DCGM_ST_OK)
+    {
+        ret = dcgmFieldGroupCreate(setup.handle, fieldIds.size(), fieldIds.data(), fieldGroupName, &setup.fieldGroupId);
+    }
+    if (ret == DCGM_ST_OK)
+    {
+        /* 100 ms updates so that since requests have a steady trickle of new values */
+        ret = dcgmWatchFields(setup.handle, setup.groupId, setup.fieldGroupId, 100000, 60.0, 0);
+    }
+    if (ret == DCGM_ST_OK)
+    {
+        ret = dcgmUpdateAllFields(setup.handle, 1);
+    }
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "Unable to set up the benchmark group and watches: {}\n", errorString(ret));
+    }
+
+    return ret;
+}
+
+/*****************************************************************************/
+int CountValues(dcgm_field_entity_group_t, dcgm_field_eid_t, dcgmFieldValue_v1 *, int numValues, void *userData)
+{
+    *(size_t *)userData += numValues;
+    return 0;
+}
+
+/*****************************************************************************/
+int IgnorePolicyViolation(dcgmPolicyCallbackResponse_t *, uint64_t)
+{
+    return 0;
+}
+
+/*****************************************************************************/
+void RunClient(unsigned int clientIndex,
+               BenchmarkOptions const &options,
+               BenchmarkSetup const &setup,
+               std::atomic_bool const &stop,
+               ClientResult &result)
+{
+    dcgmHandle_t handle = setup.handle;
+
+    if (options.mode != "embedded")
+    {
+        result.connectStatus = Connect(options, handle);
+        if (result.connectStatus != DCGM_ST_OK)
+        {
+            return;
+        }
+    }
+
+    std::string watchGroupName       = fmt::format("dcgm_api_benchmark_watch_{}", clientIndex);
+    auto watchFieldIds               = WATCH_FIELD_IDS;
+    dcgmFieldGrp_t watchFieldGroupId = 0;
+    dcgmReturn_t watchGroupRet       = dcgmFieldGroupCreate(
+        handle, watchFieldIds.size(), watchFieldIds.data(), watchGroupName.data(), &watchFieldGroupId);
+
+    size_t const valueCount = setup.entities.size() * READ_FIELD_IDS.size();
+    std::vector<dcgmFieldValue_v2> values(valueCount);
+    auto entities         = setup.entities;
+    auto readFieldIds     = READ_FIELD_IDS;
+    long long sinceTs     = 0;
+    size_t valuesReceived = 0;
+
+    std::mt19937 rng(clientIndex);
+    std::discrete_distribution<int> pickRequest(options.weights.begin(), options.weights.end());
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        int request      = pickRequest(rng);
+        dcgmReturn_t ret = DCGM_ST_OK;
+        auto start       = std::chrono::steady_clock::now();
+
+        switch (request)
+        {
+            case BenchmarkRequestLatestValues:
+                ret = dcgmEntitiesGetLatestValues(handle,
+                                                  entities.data(),
+                                                  entities.size(),
+                                                  readFieldIds.data(),
+                                                  readFieldIds.size(),
+                                                  0,
+                                                  values.data());
+                break;
+
+            case BenchmarkRequestValuesSince:
+                /* Poll incrementally like a real client does */
+                ret = dcgmGetValuesSince_v2(
+                    handle, setup.groupId, setup.fieldGroupId, sinceTs, &sinceTs, CountValues, &valuesReceived);
+                break;
+
+            case BenchmarkRequestWatch:
+                ret = watchGroupRet;
+                if (ret == DCGM_ST_OK)
+                {
+                    ret = dcgmWatchFields(handle, setup.groupId, watchFieldGroupId, 1000000, 10.0, 0);
+                }
+                if (ret == DCGM_ST_OK)
+                {
+                    ret = dcgmUnwatchFields(handle, setup.groupId, watchFieldGroupId);
+                }
+                break;
+
+            case BenchmarkRequestPolicy:
+                ret = dcgmPolicyRegister_v2(handle, setup.groupId, DCGM_POLICY_COND_DBE, IgnorePolicyViolation, 0);
+                if (ret == DCGM_ST_OK)
+                {
+                    ret = dcgmPolicyUnregister(handle, setup.groupId, DCGM_POLICY_COND_DBE);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        result.stats[request].Add(elapsed.count(), ret != DCGM_ST_OK);
+    }
+
+    if (watchGroupRet == DCGM_ST_OK)
+    {
+        dcgmFieldGroupDestroy(handle, watchFieldGroupId);
+    }
+
+    if (options.mode != "embedded")
+    {
+        dcgmDisconnect(handle);
+    }
+}
+
+/*****************************************************************************/
+void PrintReport(BenchmarkOptions const &options,
+                 std::vector<ClientResult> &results,
+                 double elapsedSec,
+                 dcgmIntrospectCpuUtil_t const *cpuUtil)
+{
+    std::array<LatencyStats, BenchmarkRequestCount> totals;
+    LatencyStats all;
+    unsigned int connectFailures = 0;
+
+    for (auto &result : results)
+    {
+        if (result.connectStatus != DCGM_ST_OK)
+        {
+            connectFailures++;
+        }
+        for (unsigned int i = 0; i < BenchmarkRequestCount; i++)
+        {
+            totals[i].Merge(result.stats[i]);
+            all.Merge(result.stats[i]);
+        }
+    }
+
+    fmt::print("{} clients over {} for {:.1f} s", options.clients, options.mode, elapsedSec);
+    if (connectFailures > 0)
+    {
+        fmt::print(" ({} failed to connect)", connectFailures);
+    }
+    fmt::print("\n\n{:<8} {:>10} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+               "request",
+               "count",
+               "errors",
+               "req/s",
+               "p50 us",
+               "p99 us",
+               "p999 us",
+               "max us");
+
+    auto printRow = [elapsedSec](char const *name, LatencyStats &stats) {
+        fmt::print("{:<8} {:>10} {:>8} {:>10.0f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n",
+                   name,
+                   stats.GetCount(),
+                   stats.GetErrorCount(),
+                   stats.GetCount() / elapsedSec,
+                   stats.GetPercentile(0.50) / 1000.0,
+                   stats.GetPercentile(0.99) / 1000.0,
+                   stats.GetPercentile(0.999) / 1000.0,
+                   stats.GetMax() / 1000.0);
+    };
+
+    for (unsigned int i = 0; i < BenchmarkRequestCount; i++)
+    {
+        if (options.weights[i] > 0)
+        {
+            printRow(REQUEST_NAMES[i], totals[i]);
+        }
+    }
+    printRow("all", all);
+
+    if (cpuUtil)
+    {
+        /* An embedded host engine shares its process with the clients, so they are included */
+        fmt::print("\nhost engine CPU: {:.1f}% total, {:.1f}% user, {:.1f}% kernel{}\n",
+                   cpuUtil->total * 100,
+                   cpuUtil->user * 100,
+                   cpuUtil->kernel * 100,
+                   options.mode == "embedded" ? " (includes the clients)" : "");
+    }
+}
+} // namespace
+
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    dcgmReturn_t ret = dcgmInit();
+    if (ret != DCGM_ST_OK)
+    {
+        fmt::print(stderr, "dcgmInit failed: {}\n", errorString(ret));
+        return 1;
+    }
+
+    BenchmarkSetup setup;
+    ret = SetUp(options, setup);
+    if (ret != DCGM_ST_OK)
+    {
+        dcgmShutdown();
+        return 1;
+    }
+
+    std::atomic_bool stop { false };
+    std::vector<ClientResult> results(options.clients);
+    std::vector<std::thread> clients;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < options.clients; i++)
+    {
+        clients.emplace_back(RunClient, i, std::cref(options), std::cref(setup), std::cref(stop), std::ref(results[i]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(options.durationSec));
+
+    /* Sample the CPU while the clients are still running so that it reflects the load */
+    dcgmIntrospectCpuUtil_t cpuUtil {};
+    cpuUtil.version     = dcgmIntrospectCpuUtil_version;
+    dcgmReturn_t cpuRet = dcgmIntrospectGetHostengineCpuUtilization(setup.handle, &cpuUtil, 1);
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto &client : clients)
+    {
+        client.join();
+    }
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    PrintReport(options, results, elapsedSec, cpuRet == DCGM_ST_OK ? &cpuUtil : nullptr);
+
+    dcgmUnwatchFields(setup.handle, setup.groupId, setup.fieldGroupId);
+    dcgmFieldGroupDestroy(setup.handle, setup.fieldGroupId);
+    dcgmGroupDestroy(setup.handle, setup.groupId);
+
+    if (options.mode == "embedded")
+    {
+        dcgmStopEmbedded(setup.handle);
+    }
+    else
+    {
+        dcgmDisconnect(setup.handle);
+    }
+    dcgmShutdown();
+    return 0;
+}
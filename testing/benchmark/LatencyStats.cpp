@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*****************************************************************************/
+void LatencyStats::Add(std::uint64_t nsec, bool failed)
+{
+    m_samples.push_back(nsec);
+    m_sorted = false;
+    if (failed)
+    {
+        m_errorCount++;
+    }
+}
+
+/*****************************************************************************/
+void LatencyStats::Merge(LatencyStats const &other)
+{
+    m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+    m_errorCount += other.m_errorCount;
+    m_sorted = m_samples.empty();
+}
+
+/*****************************************************************************/
+std::uint64_t LatencyStats::GetPercentile(double fraction)
+{
+    if (m_samples.empty())
+    {
+        return 0;
+    }
+
+    if (!m_sorted)
+    {
+        std::sort(m_samples.begin(), m_samples.end());
+        m_sorted = true;
+    }
+
+    auto rank = (std::size_t)std::ceil(fraction * m_samples.size());
+    rank      = std::clamp<std::size_t>(rank, 1, m_samples.size());
+    return m_samples[rank - 1];
+}
+
+/*****************************************************************************/
+std::uint64_t LatencyStats::GetMax()
+{
+    return GetPercentile(1.0);
+}
+
+/*****************************************************************************/
+std::size_t LatencyStats::GetCount() const
+{
+    return m_samples.size();
+}
+
+/*****************************************************************************/
+std::size_t LatencyStats::GetErrorCount() const
+{
+    return m_errorCount;
+}
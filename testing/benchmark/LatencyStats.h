@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/*****************************************************************************/
+/*
+ * Latency samples of one kind of request. Percentiles are computed from every
+ * sample rather than estimated, which is fine for the sample counts of a
+ * benchmark run.
+ */
+class LatencyStats
+{
+public:
+    /*************************************************************************/
+    /* Record one request that took nsec nanoseconds, failed or not */
+    void Add(std::uint64_t nsec, bool failed);
+
+    /*************************************************************************/
+    /* Add the samples of other to these */
+    void Merge(LatencyStats const &other);
+
+    /*************************************************************************/
+    /*
+     * Latency below which fraction of the samples are, in nanoseconds. Uses
+     * the nearest sample rank. Returns 0 if there are no samples
+     */
+    std::uint64_t GetPercentile(double fraction);
+
+    /*************************************************************************/
+    std::uint64_t GetMax();
+    std::size_t GetCount() const;
+    std::size_t GetErrorCount() const;
+
+private:
+    std::vector<std::uint64_t> m_samples;
+    std::size_t m_errorCount = 0;
+    bool m_sorted            = true;
+};
@@ -192,6 +192,24 @@ class DcgmGroupSamples:
 
         return dfvec
 
+    '''
+    Gets the values of each numeric field since the last call as flat arrays
+
+    columns:    DcgmFieldValueColumns() instance. Pass None for the first call
+                to get one for subsequent calls. On subsequent calls, pass what
+                was returned. Its arrays are overwritten by each call.
+
+    fieldGroup: DcgmFieldGroup() instance tracking the fields we want to watch.
+
+    Returns DcgmFieldValueColumns object. Use its .timestamps, .int64Values etc. to access values
+    '''
+    def GetAllSinceLastCallColumns(self, columns, fieldGroup):
+        if columns == None:
+            columns = dcgm_field_helpers.DcgmFieldValueColumns(self._dcgmHandle.handle, self._groupId)
+
+        columns.GetAllSinceLastCall(fieldGroup)
+        return columns
+
     '''
     Convenience alias for DcgmHandle.UpdateAllFields(). All fields on the system will be updated, not
     just this group's.
@@ -311,6 +329,23 @@ class DcgmGroupPolicy:
         if callback is None:
             raise pydcgm.DcgmException("Callback must be provided to register that is not None")
         dcgm_agent.dcgmPolicyRegister_v2(self._dcgmHandle.handle, self._groupId, condition, callback, userData)
+
+    '''
+    Register a function to be called for each violation of a policy condition, like Register() does, with the
+    violations that occur within coalesceWindowMs of each other sent to the client as one message.
+
+    @param coalesceWindowMs              IN: How long violations are collected before they are sent.
+                                             0 = dcgm_structs.DCGM_POLICY_COALESCE_WINDOW_MS_DEFAULT
+    @param maxPerConditionPerSec         IN: Most violations of a condition delivered per second. Further ones
+                                             are dropped. 0 = no limit
+
+    Returns Nothing. Throws an exception on error.
+    '''
+    def RegisterBatched(self, condition, callback=None, userData=None, coalesceWindowMs=0, maxPerConditionPerSec=0):
+        if callback is None:
+            raise pydcgm.DcgmException("Callback must be provided to register that is not None")
+        dcgm_agent.dcgmPolicyRegisterBatched(self._dcgmHandle.handle, self._groupId, condition, callback, userData,
+                                             coalesceWindowMs, maxPerConditionPerSec)
     
     '''
     Unregister a function to be called for a specific policy condition (see dcgm_structs.c_dcgmPolicy_v1.condition) .
@@ -543,6 +578,15 @@ class DcgmGroupProfiling:
         ret = dcgm_agent.dcgmProfGetSupportedMetricGroups(self._dcgmHandle.handle, gpuIds[0])
         return ret
 
+    def GetMultiplexInfo(self):
+        """
+         Get how the profiling fields watched by this group are time-multiplexed
+
+         :return: dcgm_structs.c_dcgmProfMultiplexInfo_v1. numPasses is 0 if the watch needs a single pass
+         :throws: dcgm_structs.DCGMError on error
+         """
+        return dcgm_agent.dcgmProfGetMultiplexInfo(self._dcgmHandle.handle, self._groupId)
+
 class DcgmGroup:
     '''
     Constructor.
@@ -61,7 +61,7 @@ class DcgmHandle:
             return        
         
         #Set up connection parameters. We're connecting to something
-        connectParams = dcgm_structs.c_dcgmConnectV2Params_v2()
+        connectParams = dcgm_structs.c_dcgmConnectV2Params_v4()
         connectParams.version = dcgm_structs.c_dcgmConnectV2Params_version
         connectParams.timeoutMs = timeoutMs
         if self._persistAfterDisconnect:
@@ -219,6 +219,7 @@ class DcgmReader(object):
         self.egfvs = None
         self.dfvc = None
         self.dfvec = None
+        self.columns = None
 
     ###########################################################################
     '''
@@ -264,6 +265,9 @@ class DcgmReader(object):
     on shutdown.
     '''
     def SetDisconnected(self):
+        #The columns belong to the old handle
+        self.columns = None
+
         #Force destructors since DCGM currently doesn't support more than one client connection per process
         if self.m_dcgmGroup is not None:
             del(self.m_dcgmGroup)
@@ -640,6 +644,29 @@ class DcgmReader(object):
 
         return systemDictionary
 
+    ###########################################################################
+    '''
+    This function gets the values of all numeric fields since the last call as
+    a DcgmFieldValueColumns: flat arrays of entity group, entity, field,
+    timestamp and value with one element per value. It doesn't create a python
+    object per value, so it's much cheaper than
+    GetAllEntityValuesAsDictSinceLastCall() for many values.
+
+    The arrays are overwritten by the next call. Returns None if DCGM can't be
+    reached.
+    '''
+    def GetAllEntityValuesAsColumnsSinceLastCall(self):
+        with self.m_lock:
+            try:
+                self.Reconnect()
+                self.columns = self.m_dcgmGroup.samples.GetAllSinceLastCallColumns(self.columns, self.m_fieldGroup)
+                return self.columns
+            except dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_CONNECTION_NOT_VALID):
+                self.LogError("Can't connection to nv-hostengine. Please verify that it is running.")
+                self.SetDisconnected()
+
+        return None
+
     """
     Gpu-based convenience calls (mostly for non-MIG)
     """
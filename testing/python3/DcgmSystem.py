@@ -54,6 +54,14 @@ class DcgmSystemDiscovery:
     def GetGpuAttributes(self, gpuId):
         return dcgm_agent.dcgmGetDeviceAttributes(self._dcgmHandle.handle, gpuId)
 
+    '''
+    Get the basic GPU attributes of every GPU with a single request.
+
+    Returns a dictionary of gpuId -> dcgm_structs.c_dcgmDeviceAttributes_v3() object
+    '''
+    def GetAllGpuAttributes(self):
+        return dcgm_agent.dcgmGetAllDeviceAttributes(self._dcgmHandle.handle)
+
     '''
     Get topology information for a given GPU ID
 
@@ -148,7 +156,7 @@ class DcgmSystemIntrospectCpuUtil:
         
         waitIfNoData:      wait for metadata to be updated if it's not available
                       
-        Returns a dcgm_structs.c_dcgmIntrospectCpuUtil_v1 object
+        Returns a dcgm_structs.c_dcgmIntrospectCpuUtil_v2 object
         Raises an exception for DCGM_ST_NO_DATA if no data is available yet and \ref waitIfNoData is False
         '''
         return dcgm_agent.dcgmIntrospectGetHostengineCpuUtilization(self._dcgmHandle.handle, waitIfNoData)
@@ -145,6 +145,23 @@ def dcgmGetDeviceAttributes(dcgm_handle, gpuId, version=dcgm_structs.dcgmDeviceA
     dcgm_structs._dcgmCheckReturn(ret)
     return device_values
 
+@ensure_byte_strings()
+def dcgmGetAllDeviceAttributes(dcgm_handle):
+    '''
+    Returns a dictionary of gpuId -> c_dcgmDeviceAttributes_v3 for every GPU on the system,
+    fetched with a single request to the host engine
+    '''
+    capacity = dcgm_structs.DCGM_MAX_NUM_DEVICES
+    c_attributes = (dcgm_structs.c_dcgmDeviceAttributes_v3 * capacity)()
+    for attributes in c_attributes:
+        attributes.version = dcgm_structs.dcgmDeviceAttributes_version3
+    c_gpuid_list = (c_uint * capacity)()
+    c_count = c_uint(0)
+    fn = dcgmFP("dcgmGetAllDeviceAttributes")
+    ret = fn(dcgm_handle, c_uint(capacity), c_gpuid_list, c_attributes, byref(c_count))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return {int(c_gpuid_list[i]): c_attributes[i] for i in range(int(c_count.value))}
+
 @ensure_byte_strings()
 def dcgmGetEntityGroupEntities(dcgm_handle, entityGroup, flags):
     capacity = dcgm_structs.DCGM_GROUP_MAX_ENTITIES_V2
@@ -425,6 +442,21 @@ def dcgmUpdateAllFields(dcgm_handle, waitForUpdate):
     dcgm_structs._dcgmCheckReturn(ret)
     return ret
 
+# This method is used to update the watches of one field group on one group of entities
+@ensure_byte_strings()
+def dcgmUpdateFields(dcgm_handle, groupId, fieldGroupId, waitForUpdate):
+    fn = dcgmFP("dcgmUpdateFields")
+    ret = fn(dcgm_handle, groupId, fieldGroupId, c_int(waitForUpdate))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return ret
+
+def dcgmSnapshotFields(dcgm_handle, groupId, fieldGroupId):
+    fn = dcgmFP("dcgmSnapshotFields")
+    snapshotId = c_longlong(0)
+    ret = fn(dcgm_handle, groupId, fieldGroupId, byref(snapshotId))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return snapshotId.value
+
 # This method is used to get the policy information
 @ensure_byte_strings()
 def dcgmPolicyGet(dcgm_handle, group_id, count, status_handle):
@@ -468,6 +500,63 @@ def dcgmGetValuesSince_v2(dcgm_handle, groupId, fieldGroupId, sinceTimestamp, en
     dcgm_structs._dcgmCheckReturn(ret)
     return c_nextSinceTimestamp.value
 
+# Returns the nextSinceTimestamp to pass on the next call. columns is a c_dcgmFieldValueColumns_v1 whose arrays are
+# populated. Raises DCGM_ST_INSUFFICIENT_SIZE if columns.count values don't fit in columns.capacity
+@ensure_byte_strings()
+def dcgmGetValuesSinceColumns(dcgm_handle, groupId, fieldGroupId, sinceTimestamp, columns):
+    fn = dcgmFP("dcgmGetValuesSinceColumns")
+    c_nextSinceTimestamp = c_int64()
+    ret = fn(dcgm_handle, groupId, fieldGroupId, c_int64(sinceTimestamp), byref(c_nextSinceTimestamp), byref(columns))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return c_nextSinceTimestamp.value
+
+# Returns (columns, rows). columns is a list of (entityGroupId, entityId, fieldId) and rows is a list of a list of
+# column values for each time from startTime to endTime, stepUsec apart. Values without a sample are DCGM_FP64_BLANK
+def dcgmGetResampledValues(dcgm_handle, groupId, fieldGroupId, startTime, endTime, stepUsec, fill):
+    fn = dcgmFP("dcgmGetResampledValues")
+    resampled = dcgm_structs.c_dcgmResampledValues_v1()
+    resampled.version = dcgm_structs.dcgmResampledValues_version1
+    resampled.fill = fill
+    resampled.startTime = startTime
+    resampled.endTime = endTime
+    resampled.stepUsec = stepUsec
+
+    #The first call returns the size of the matrix
+    ret = fn(dcgm_handle, groupId, fieldGroupId, byref(resampled))
+    if ret == dcgm_structs.DCGM_ST_INSUFFICIENT_SIZE:
+        columnEntities = (dcgm_structs.c_dcgmGroupEntityPair_t * resampled.numColumns)()
+        columnFieldIds = (c_ushort * resampled.numColumns)()
+        values = (c_double * (resampled.numRows * resampled.numColumns))()
+        resampled.columnCapacity = resampled.numColumns
+        resampled.capacity = resampled.numRows * resampled.numColumns
+        resampled.columnEntities = columnEntities
+        resampled.columnFieldIds = columnFieldIds
+        resampled.values = values
+        ret = fn(dcgm_handle, groupId, fieldGroupId, byref(resampled))
+    dcgm_structs._dcgmCheckReturn(ret)
+
+    numColumns = resampled.numColumns
+    columns = [(resampled.columnEntities[i].entityGroupId, resampled.columnEntities[i].entityId,
+                resampled.columnFieldIds[i]) for i in range(numColumns)]
+    if numColumns == 0:
+        return columns, [[] for row in range(resampled.numRows)]
+    rows = [resampled.values[row * numColumns:(row + 1) * numColumns] for row in range(resampled.numRows)]
+    return columns, rows
+
+@ensure_byte_strings()
+def dcgmExportValues(dcgm_handle, groupId, fieldGroupId, filename, startTime=0, endTime=0,
+                     exportFormat=dcgm_structs.DCGM_EXPORT_FORMAT_ARROW_IPC):
+    fn = dcgmFP("dcgmExportValues")
+    exportValues = dcgm_structs.c_dcgmExportValues_v1()
+    exportValues.version = dcgm_structs.dcgmExportValues_version1
+    exportValues.format = exportFormat
+    exportValues.startTime = startTime
+    exportValues.endTime = endTime
+    exportValues.filename = filename
+    ret = fn(dcgm_handle, groupId, fieldGroupId, byref(exportValues))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return exportValues
+
 @ensure_byte_strings()
 def dcgmGetLatestValues(dcgm_handle, groupId, fieldGroupId, enumCB, userData):
     fn = dcgmFP("dcgmGetLatestValues")
@@ -544,6 +633,18 @@ def dcgmPolicyRegister_v2(dcgm_handle, groupId, condition, callback, userData):
     dcgm_structs._dcgmCheckReturn(ret)
     return ret
 
+@ensure_byte_strings()
+def dcgmPolicyRegisterBatched(dcgm_handle, groupId, condition, callback, userData, coalesceWindowMs=0,
+                              maxPerConditionPerSec=0):
+    c_options = dcgm_structs.c_dcgmPolicyNotifyOptions_v1()
+    c_options.version = dcgm_structs.dcgmPolicyNotifyOptions_version1
+    c_options.coalesceWindowMs = coalesceWindowMs
+    c_options.maxPerConditionPerSec = maxPerConditionPerSec
+    fn = dcgmFP("dcgmPolicyRegisterBatched")
+    ret = fn(dcgm_handle, groupId, condition, callback, py_object(userData), byref(c_options))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return ret
+
 @ensure_byte_strings()
 def dcgmPolicyUnregister(dcgm_handle, groupId, condition):
     fn = dcgmFP("dcgmPolicyUnregister")
@@ -620,6 +721,28 @@ def dcgmActionValidate_v2(dcgm_handle, runDiagInfo, runDiagVersion=dcgm_structs.
 
     return helperDiagCheckReturn(ret, response)
 
+dcgmDiagTestCompleted_f = CFUNCTYPE(None, POINTER(dcgm_structs.c_dcgmDiagTestCompletion_v1), c_void_p)
+
+def dcgmRunDiagnosticWithCallback(dcgm_handle, runDiagInfo, callback, userData=None):
+    '''
+    Run the diagnostic described by runDiagInfo, calling callback(completion, userData) with a
+    c_dcgmDiagTestCompletion_v1 as each test completes. Returns the full dcgmDiagResponse_v11
+    '''
+    response = dcgm_structs.c_dcgmDiagResponse_v11()
+    response.version = dcgm_structs.dcgmDiagResponse_version11
+
+    def onTestCompleted(completion, _):
+        callback(completion.contents, userData)
+
+    # Keep a reference to the ctypes callback until the run completes
+    cb = dcgmDiagTestCompleted_f(onTestCompleted)
+
+    runDiagInfo.version = dcgm_structs.dcgmRunDiag_version9
+    fn = dcgmFP("dcgmRunDiagnosticWithCallback")
+    ret = fn(dcgm_handle, byref(runDiagInfo), cb, None, byref(response))
+
+    return helperDiagCheckReturn(ret, response)
+
 @ensure_byte_strings()
 def dcgmActionValidate(dcgm_handle, group_id, validate):
     response = dcgm_structs.c_dcgmDiagResponse_v11()
@@ -730,8 +853,8 @@ def dcgmJobRemoveAll(dcgm_handle):
 def dcgmIntrospectGetHostengineMemoryUsage(dcgm_handle, waitIfNoData=True):
     fn = dcgmFP("dcgmIntrospectGetHostengineMemoryUsage")
     
-    memInfo = dcgm_structs.c_dcgmIntrospectMemory_v1()
-    memInfo.version = dcgm_structs.dcgmIntrospectMemory_version1
+    memInfo = dcgm_structs.c_dcgmIntrospectMemory_v2()
+    memInfo.version = dcgm_structs.dcgmIntrospectMemory_version2
     
     ret = fn(dcgm_handle, byref(memInfo), waitIfNoData)
     dcgm_structs._dcgmCheckReturn(ret)
@@ -741,13 +864,46 @@ def dcgmIntrospectGetHostengineMemoryUsage(dcgm_handle, waitIfNoData=True):
 def dcgmIntrospectGetHostengineCpuUtilization(dcgm_handle, waitIfNoData=True):
     fn = dcgmFP("dcgmIntrospectGetHostengineCpuUtilization")
     
-    cpuUtil = dcgm_structs.c_dcgmIntrospectCpuUtil_v1()
-    cpuUtil.version = dcgm_structs.dcgmIntrospectCpuUtil_version1
+    cpuUtil = dcgm_structs.c_dcgmIntrospectCpuUtil_v2()
+    cpuUtil.version = dcgm_structs.dcgmIntrospectCpuUtil_version2
     
     ret = fn(dcgm_handle, byref(cpuUtil), waitIfNoData)
     dcgm_structs._dcgmCheckReturn(ret)
     return cpuUtil
     
+@ensure_byte_strings()
+def dcgmIntrospectGetFieldCosts(dcgm_handle):
+    fn = dcgmFP("dcgmIntrospectGetFieldCosts")
+
+    fieldCosts = dcgm_structs.c_dcgmIntrospectFieldCosts_v1()
+    fieldCosts.version = dcgm_structs.dcgmIntrospectFieldCosts_version1
+
+    ret = fn(dcgm_handle, byref(fieldCosts))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return fieldCosts
+
+@ensure_byte_strings()
+def dcgmIntrospectGetLockProfile(dcgm_handle):
+    fn = dcgmFP("dcgmIntrospectGetLockProfile")
+
+    lockProfile = dcgm_structs.c_dcgmIntrospectLockProfile_v1()
+    lockProfile.version = dcgm_structs.dcgmIntrospectLockProfile_version1
+
+    ret = fn(dcgm_handle, byref(lockProfile))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return lockProfile
+
+@ensure_byte_strings()
+def dcgmIntrospectGetRuntimeStats(dcgm_handle):
+    fn = dcgmFP("dcgmIntrospectGetRuntimeStats")
+
+    runtimeStats = dcgm_structs.c_dcgmIntrospectRuntimeStats_v1()
+    runtimeStats.version = dcgm_structs.dcgmIntrospectRuntimeStats_version1
+
+    ret = fn(dcgm_handle, byref(runtimeStats))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return runtimeStats
+
 @ensure_byte_strings()
 def dcgmEntityGetLatestValues(dcgmHandle, entityGroup, entityId, fieldIds):
     fn = dcgmFP("dcgmEntityGetLatestValues")
@@ -800,8 +956,8 @@ def dcgmModuleDenylist(dcgmHandle, moduleId):
 
 @ensure_byte_strings()
 def dcgmModuleGetStatuses(dcgmHandle):
-    moduleStatuses = dcgm_structs.c_dcgmModuleGetStatuses_v1()
-    moduleStatuses.version = dcgm_structs.dcgmModuleGetStatuses_version1
+    moduleStatuses = dcgm_structs.c_dcgmModuleGetStatuses_v2()
+    moduleStatuses.version = dcgm_structs.dcgmModuleGetStatuses_version2
     fn = dcgmFP("dcgmModuleGetStatuses")
     ret = fn(dcgmHandle, byref(moduleStatuses))
     dcgm_structs._dcgmCheckReturn(ret)
@@ -817,6 +973,15 @@ def dcgmProfGetSupportedMetricGroups(dcgmHandle, gpuId):
     dcgm_structs._dcgmCheckReturn(ret)
     return msg
 
+def dcgmProfGetMultiplexInfo(dcgmHandle, groupId):
+    msg = dcgm_structs.c_dcgmProfMultiplexInfo_v1()
+    msg.version = dcgm_structs.dcgmProfMultiplexInfo_version1
+    msg.groupId = groupId
+    fn = dcgmFP("dcgmProfGetMultiplexInfo")
+    ret = fn(dcgmHandle, byref(msg))
+    dcgm_structs._dcgmCheckReturn(ret)
+    return msg
+
 @ensure_byte_strings()
 def dcgmProfPause(dcgmHandle):
     fn = dcgmFP("dcgmProfPause")
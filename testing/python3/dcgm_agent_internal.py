@@ -92,6 +92,13 @@ def dcgmInjectEntityFieldValue(dcgmHandle, entityGroupId, entityId, value):
     _dcgmIntCheckReturn(ret)
     return ret
 
+def dcgmInjectEntityFieldValues(dcgmHandle, values):
+    fn = dcgm_structs._dcgmGetFunctionPointer("dcgmInjectEntityFieldValues")
+    valuesArray = (dcgm_structs.c_dcgmFieldValue_v2 * len(values))(*values)
+    ret = fn(dcgmHandle, valuesArray, c_uint(len(values)))
+    _dcgmIntCheckReturn(ret)
+    return ret
+
 @dcgm_agent.ensure_byte_strings()
 def dcgmInjectEntityFieldValueToNvml(dcgmHandle, entityGroupId, entityId, value):
     fn = dcgm_structs._dcgmGetFunctionPointer("dcgmInjectEntityFieldValueToNvml")
@@ -354,6 +354,97 @@ class DcgmFieldValueEntityCollection:
         self._numValuesSeen = 0
 
 
+'''
+Helper class that retrieves numeric field values in bulk as flat, typed arrays rather than one python object per value
+
+Value i is described by element i of each of entityGroupIds, entityIds, fieldIds, fieldTypes, timestamps and values.
+These are memoryviews, so they can be wrapped without copying, like numpy.frombuffer(columns.timestamps, numpy.int64).
+int64Values holds the values of DCGM_FT_INT64 and DCGM_FT_TIMESTAMP fields and doubleValues those of DCGM_FT_DOUBLE
+fields. The other one is blank for each value. String and binary fields are left out.
+
+The arrays are reused by the next call, so copy anything that needs to outlive it.
+'''
+class DcgmFieldValueColumns:
+    def __init__(self, handle, groupId, capacity=4096):
+        self._handle = handle
+        self._groupId = groupId
+        self._nextSinceTimestamp = 0
+        self._count = 0
+        self._Allocate(capacity)
+
+    def _Allocate(self, capacity):
+        self._entityGroupIds = (ctypes.c_uint8 * capacity)()
+        self._entityIds = (ctypes.c_uint * capacity)()
+        self._fieldIds = (ctypes.c_ushort * capacity)()
+        self._fieldTypes = (ctypes.c_uint8 * capacity)()
+        self._timestamps = (ctypes.c_int64 * capacity)()
+        self._int64Values = (ctypes.c_int64 * capacity)()
+        self._doubleValues = (ctypes.c_double * capacity)()
+
+        self._columns = dcgm_structs.c_dcgmFieldValueColumns_v1()
+        self._columns.version = dcgm_structs.dcgmFieldValueColumns_version1
+        self._columns.capacity = capacity
+        self._columns.entityGroupIds = self._entityGroupIds
+        self._columns.entityIds = self._entityIds
+        self._columns.fieldIds = self._fieldIds
+        self._columns.fieldTypes = self._fieldTypes
+        self._columns.timestamps = self._timestamps
+        self._columns.int64Values = self._int64Values
+        self._columns.doubleValues = self._doubleValues
+
+    '''
+    Retrieve the values of fieldGroup that updated since the last call. Returns the number of values retrieved.
+    The arrays grow if the values don't fit.
+    '''
+    def GetAllSinceLastCall(self, fieldGroup):
+        while True:
+            try:
+                self._nextSinceTimestamp = dcgm_agent.dcgmGetValuesSinceColumns(self._handle, self._groupId, fieldGroup.fieldGroupId,
+                                                                                 self._nextSinceTimestamp, self._columns)
+                break
+            except dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_INSUFFICIENT_SIZE):
+                #Leave room for values that update before the next attempt
+                self._Allocate(self._columns.count * 2)
+
+        self._count = self._columns.count
+        return self._count
+
+    def __len__(self):
+        return self._count
+
+    #ctypes arrays export formats like '<q' that memoryview can't slice, so view them as native types
+    def _View(self, array, format):
+        return memoryview(array).cast('B').cast(format)[:self._count]
+
+    @property
+    def entityGroupIds(self):
+        return self._View(self._entityGroupIds, 'B')
+
+    @property
+    def entityIds(self):
+        return self._View(self._entityIds, 'I')
+
+    @property
+    def fieldIds(self):
+        return self._View(self._fieldIds, 'H')
+
+    @property
+    def fieldTypes(self):
+        return self._View(self._fieldTypes, 'B')
+
+    @property
+    def timestamps(self):
+        return self._View(self._timestamps, 'q')
+
+    @property
+    def int64Values(self):
+        return self._View(self._int64Values, 'q')
+
+    @property
+    def doubleValues(self):
+        return self._View(self._doubleValues, 'd')
+
+
 '''
 Helper class for watching a field group and storing fields values returned from it
 '''
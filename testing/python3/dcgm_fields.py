@@ -666,8 +666,29 @@ DCGM_FI_DEV_NVLINK_COUNT_RX_SYMBOL_ERRORS = 1214
 # BER for symbol errors
 DCGM_FI_DEV_NVLINK_COUNT_SYMBOL_BER = 1215
 
+# Derived fields, computed by the cache manager from other fields of the same GPU
+# DCGM_FI_DEV_POWER_USAGE as a percentage of DCGM_FI_DEV_ENFORCED_POWER_LIMIT
+DCGM_FI_DEV_POWER_USAGE_PERCENT = 1216
+# PCIe replays per second
+DCGM_FI_DEV_PCIE_REPLAY_RATE = 1217
+# Volatile single-bit ECC errors per second
+DCGM_FI_DEV_ECC_SBE_VOL_RATE = 1218
+# Volatile double-bit ECC errors per second
+DCGM_FI_DEV_ECC_DBE_VOL_RATE = 1219
+# NVLink flow-control CRC errors per second
+DCGM_FI_DEV_NVLINK_CRC_FLIT_ERROR_RATE = 1220
+# NVLink replay errors per second
+DCGM_FI_DEV_NVLINK_REPLAY_ERROR_RATE = 1221
+# Seconds spent with each clocks event reason set since the field was watched
+DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME = 1222
+DCGM_FI_DEV_CLOCKS_EVENT_HW_SLOWDOWN_TIME = 1223
+DCGM_FI_DEV_CLOCKS_EVENT_SYNC_BOOST_TIME = 1224
+DCGM_FI_DEV_CLOCKS_EVENT_SW_THERMAL_TIME = 1225
+DCGM_FI_DEV_CLOCKS_EVENT_HW_THERMAL_TIME = 1226
+DCGM_FI_DEV_CLOCKS_EVENT_HW_POWER_BRAKE_TIME = 1227
+
 #greater than maximum fields above. This value can increase in the future
-DCGM_FI_MAX_FIELDS         = 1216
+DCGM_FI_MAX_FIELDS         = 1228
 
 
 class struct_c_dcgm_field_meta_t(dcgm_structs._DcgmStructure):
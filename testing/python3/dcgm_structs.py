@@ -145,6 +145,7 @@ DCGM_GROUP_MAX_ENTITIES_V2 = 1024 #Maximum number of entities per entity group
 
 DCGM_CONFIG_TARGET_STATE  = 0          # The target configuration values to be applied
 DCGM_CONFIG_CURRENT_STATE = 1          # The current configuration state
+DCGM_CONFIG_CURRENT_STATE_LIVE = 2     # The current configuration state, read from every GPU by this call
 
 DCGM_CONFIG_POWER_CAP_INDIVIDUAL = 0 # Represents the power cap to be applied for each member of the group
 DCGM_CONFIG_POWER_BUDGET_GROUP   = 1 # Represents the power budget for the entire group
@@ -676,7 +677,30 @@ class c_dcgmConnectV2Params_v2(_PrintableStructure):
     ]
 
 c_dcgmConnectV2Params_version2 = make_dcgm_version(c_dcgmConnectV2Params_v2, 2)
-c_dcgmConnectV2Params_version = c_dcgmConnectV2Params_version2
+
+class c_dcgmConnectV2Params_v3(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('persistAfterDisconnect', c_uint),
+        ('timeoutMs', c_uint),
+        ('addressIsUnixSocket', c_uint),
+        ('compressMinBytes', c_uint)
+    ]
+
+c_dcgmConnectV2Params_version3 = make_dcgm_version(c_dcgmConnectV2Params_v3, 3)
+
+class c_dcgmConnectV2Params_v4(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('persistAfterDisconnect', c_uint),
+        ('timeoutMs', c_uint),
+        ('addressIsUnixSocket', c_uint),
+        ('compressMinBytes', c_uint),
+        ('metadataCache', c_uint)
+    ]
+
+c_dcgmConnectV2Params_version4 = make_dcgm_version(c_dcgmConnectV2Params_v4, 4)
+c_dcgmConnectV2Params_version = c_dcgmConnectV2Params_version4
 
 class c_dcgmHostengineHealth_v1(_PrintableStructure):
     _fields_ = [
@@ -1537,6 +1561,18 @@ class c_dcgmPolicyCallbackResponse_v2(_PrintableStructure):
         ("gpuId", c_uint)
     ]
 
+DCGM_POLICY_COALESCE_WINDOW_MS_DEFAULT = 100
+DCGM_POLICY_COALESCE_WINDOW_MS_MAX = 10000
+
+class c_dcgmPolicyNotifyOptions_v1(_PrintableStructure):
+    _fields_ = [
+        ("version", c_uint),
+        ("coalesceWindowMs", c_uint),      # 0 = DCGM_POLICY_COALESCE_WINDOW_MS_DEFAULT
+        ("maxPerConditionPerSec", c_uint)  # 0 = no limit
+    ]
+
+dcgmPolicyNotifyOptions_version1 = make_dcgm_version(c_dcgmPolicyNotifyOptions_v1, 1)
+
 class c_dcgmFieldValue_v1_value(DcgmUnion):
     _fields_ = [
         ('i64', c_int64),
@@ -1576,6 +1612,68 @@ class c_dcgmFieldValue_v2(_PrintableStructure):
 
 dcgmFieldValue_version2 = make_dcgm_version(c_dcgmFieldValue_v2, 2)
 
+# Parallel arrays of field values returned by dcgm_agent.dcgmGetValuesSinceColumns(). See dcgmFieldValueColumns_v1
+class c_dcgmFieldValueColumns_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('capacity', c_uint),
+        ('count', c_uint),
+        ('numSkipped', c_uint),
+        ('entityGroupIds', POINTER(c_uint8)),
+        ('entityIds', POINTER(c_uint)),
+        ('fieldIds', POINTER(c_ushort)),
+        ('fieldTypes', POINTER(c_uint8)),
+        ('timestamps', POINTER(c_int64)),
+        ('int64Values', POINTER(c_int64)),
+        ('doubleValues', POINTER(c_double))
+    ]
+
+dcgmFieldValueColumns_version1 = make_dcgm_version(c_dcgmFieldValueColumns_v1, 1)
+dcgmFieldValueColumns_version = dcgmFieldValueColumns_version1
+
+#How dcgm_agent.dcgmGetResampledValues() fills cells without a sample at their time. See dcgmResampleFill_t
+DCGM_RESAMPLE_FILL_NONE     = 0
+DCGM_RESAMPLE_FILL_PREVIOUS = 1
+DCGM_RESAMPLE_FILL_LINEAR   = 2
+
+DCGM_RESAMPLE_MAX_COLUMNS = 1024
+
+class c_dcgmResampledValues_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('fill', c_uint),
+        ('startTime', c_int64),
+        ('endTime', c_int64),
+        ('stepUsec', c_int64),
+        ('columnCapacity', c_uint),
+        ('capacity', c_uint),
+        ('numRows', c_uint),
+        ('numColumns', c_uint),
+        ('columnEntities', POINTER(c_dcgmGroupEntityPair_t)),
+        ('columnFieldIds', POINTER(c_ushort)),
+        ('values', POINTER(c_double))
+    ]
+
+dcgmResampledValues_version1 = make_dcgm_version(c_dcgmResampledValues_v1, 1)
+dcgmResampledValues_version = dcgmResampledValues_version1
+
+#File formats dcgm_agent.dcgmExportValues() can write. See dcgmExportFormat_t
+DCGM_EXPORT_FORMAT_ARROW_IPC = 0
+
+class c_dcgmExportValues_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('format', c_uint),
+        ('startTime', c_int64),
+        ('endTime', c_int64),
+        ('filename', c_char * (DCGM_MAX_STR_LENGTH * 2)),
+        ('numValues', c_uint64),
+        ('numSkipped', c_uint64)
+    ]
+
+dcgmExportValues_version1 = make_dcgm_version(c_dcgmExportValues_v1, 1)
+dcgmExportValues_version = dcgmExportValues_version1
+
 
 #Field value flags used by dcgm_agent.dcgmEntitiesGetLatestValues()
 DCGM_FV_FLAG_LIVE_DATA = 0x00000001
@@ -2046,6 +2144,15 @@ class c_dcgmIntrospectMemory_v1(_PrintableStructure):
 
 dcgmIntrospectMemory_version1 = make_dcgm_version(c_dcgmIntrospectMemory_v1, 1)
 
+class c_dcgmIntrospectMemory_v2(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('bytesUsed', c_longlong),  # The total number of bytes being used to store all of the fields being watched
+        ('compressedSampleBytes', c_longlong)  # Bytes of cached samples held compressed. 0 unless compression is enabled
+    ]
+
+dcgmIntrospectMemory_version2 = make_dcgm_version(c_dcgmIntrospectMemory_v2, 2)
+
 class c_dcgmIntrospectCpuUtil_v1(_PrintableStructure):
     _fields_ = [
         ('version', c_uint32),  #!< version number (dcgmIntrospectCpuUtil_version)                     
@@ -2056,6 +2163,110 @@ class c_dcgmIntrospectCpuUtil_v1(_PrintableStructure):
 
 dcgmIntrospectCpuUtil_version1 = make_dcgm_version(c_dcgmIntrospectCpuUtil_v1, 1)
 
+DCGM_INTROSPECT_MAX_THREAD_CPU_UTILS = 64
+DCGM_INTROSPECT_THREAD_NAME_LEN = 16
+
+class c_dcgmIntrospectThreadCpuUtil_v1(_PrintableStructure):
+    _fields_ = [
+        ('name', c_char * DCGM_INTROSPECT_THREAD_NAME_LEN), # Name of the threads. Threads with the same name are summed
+        ('numThreads', c_uint32),                           # Number of threads that currently have this name
+        ('total', c_double),
+        ('kernel', c_double),
+        ('user', c_double),
+    ]
+
+class c_dcgmIntrospectCpuUtil_v2(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),  #!< version number (dcgmIntrospectCpuUtil_version)
+        ('total', c_double),    #!< fraction of device's CPU resources that were used
+        ('kernel', c_double),   #!< fraction of device's CPU resources that were used in kernel mode
+        ('user', c_double),     #!< fraction of device's CPU resources that were used in user mode
+        ('numThreadUtils', c_uint32), #!< Number of entries of threads[] that are populated
+        ('threads', c_dcgmIntrospectThreadCpuUtil_v1 * DCGM_INTROSPECT_MAX_THREAD_CPU_UTILS), #!< Highest total first
+    ]
+
+dcgmIntrospectCpuUtil_version2 = make_dcgm_version(c_dcgmIntrospectCpuUtil_v2, 2)
+
+DCGM_INTROSPECT_MAX_FIELD_COSTS = 2048
+
+# Flags for c_dcgmIntrospectFieldCost_v1.flags
+DCGM_INTROSPECT_FIELD_COST_F_PUSHED = 0x0001  # Samples are pushed by a module. Exec times aren't measured
+
+class c_dcgmIntrospectFieldCost_v1(_PrintableStructure):
+    _fields_ = [
+        ('entityGroupId', c_uint32),
+        ('entityId', c_uint32),
+        ('fieldId', c_uint16),
+        ('flags', c_uint16),
+        ('fetchCount', c_longlong),
+        ('execTimeUsec', c_longlong),
+        ('maxExecTimeUsec', c_longlong),
+        ('bytesUsed', c_longlong)
+    ]
+
+class c_dcgmIntrospectFieldCosts_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('numFieldCosts', c_uint32),
+        ('numWatches', c_uint32),
+        ('fieldCosts', c_dcgmIntrospectFieldCost_v1 * DCGM_INTROSPECT_MAX_FIELD_COSTS)
+    ]
+
+dcgmIntrospectFieldCosts_version1 = make_dcgm_version(c_dcgmIntrospectFieldCosts_v1, 1)
+
+DCGM_INTROSPECT_MAX_LOCK_SITES = 256
+DCGM_INTROSPECT_LOCK_HIST_BUCKETS = 16
+
+class c_dcgmIntrospectLockSite_v1(_PrintableStructure):
+    _fields_ = [
+        ('mutexName', c_char * 32),
+        ('file', c_char * 64),
+        ('line', c_uint32),
+        ('unused', c_uint32),
+        ('lockCount', c_longlong),
+        ('sharedLockCount', c_longlong),
+        ('waitUsec', c_longlong),
+        ('holdUsec', c_longlong),
+        ('maxWaitUsec', c_longlong),
+        ('maxHoldUsec', c_longlong),
+        ('waitHistogram', c_uint32 * DCGM_INTROSPECT_LOCK_HIST_BUCKETS),
+        ('holdHistogram', c_uint32 * DCGM_INTROSPECT_LOCK_HIST_BUCKETS)
+    ]
+
+class c_dcgmIntrospectLockProfile_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('numSites', c_uint32),
+        ('numSitesTotal', c_uint32),
+        ('unused', c_uint32),
+        ('sites', c_dcgmIntrospectLockSite_v1 * DCGM_INTROSPECT_MAX_LOCK_SITES)
+    ]
+
+dcgmIntrospectLockProfile_version1 = make_dcgm_version(c_dcgmIntrospectLockProfile_v1, 1)
+
+class c_dcgmIntrospectRuntimeStats_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('unused', c_uint32),
+        ('updateCycles', c_longlong),
+        ('awakeTimeUsec', c_longlong),
+        ('sleepTimeUsec', c_longlong),
+        ('numSleepsDone', c_longlong),
+        ('numSleepsSkipped', c_longlong),
+        ('updatesCoalesced', c_longlong),
+        ('lockCount', c_longlong),
+        ('lockContendedCount', c_longlong),
+        ('lockContendedWaitUsec', c_longlong),
+        ('latestValueHits', c_longlong),
+        ('latestValueMisses', c_longlong),
+        ('latestValueContended', c_longlong),
+        ('compressedSampleBytes', c_longlong),
+        ('arenaReservedBytes', c_longlong),
+        ('arenaLiveBytes', c_longlong)
+    ]
+
+dcgmIntrospectRuntimeStats_version1 = make_dcgm_version(c_dcgmIntrospectRuntimeStats_v1, 1)
+
 DCGM_MAX_CONFIG_FILE_LEN = 10000
 DCGM_MAX_TEST_NAMES = 20
 DCGM_MAX_TEST_NAMES_LEN = 50
@@ -2265,6 +2476,14 @@ DCGM_SUMMARY_INTEGRAL = 0x00000020
 DCGM_SUMMARY_DIFF     = 0x00000040
 DCGM_SUMMARY_SIZE     = 7
 
+# Percentiles. Only answered for c_dcgmFieldSummaryRequest_v2
+DCGM_SUMMARY_P50      = 0x00000080
+DCGM_SUMMARY_P95      = 0x00000100
+DCGM_SUMMARY_P99      = 0x00000200
+DCGM_SUMMARY_SIZE_V2  = 10
+
+DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS = 32
+
 class c_dcgmSummaryResponse_t(_PrintableStructure):
     class ResponseValue(DcgmUnion):
         _fields_ = [
@@ -2292,6 +2511,31 @@ class c_dcgmFieldSummaryRequest_v1(_PrintableStructure):
 
 dcgmFieldSummaryRequest_version1 = make_dcgm_version(c_dcgmFieldSummaryRequest_v1, 1)
 
+class c_dcgmSummaryResponse_v2(_PrintableStructure):
+    _fields_ = [
+        ('fieldType', c_uint),
+        ('summaryCount', c_uint),
+        ('values', c_dcgmSummaryResponse_t.ResponseValue * DCGM_SUMMARY_SIZE_V2),
+        ('histogramCounts', c_int64 * DCGM_SUMMARY_HISTOGRAM_MAX_BUCKETS),
+    ]
+
+class c_dcgmFieldSummaryRequest_v2(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('fieldId', c_ushort),
+        ('entityGroupType', c_uint32),
+        ('entityId', c_uint),
+        ('summaryTypeMask', c_uint32),
+        ('startTime', c_uint64),
+        ('endTime', c_uint64),
+        ('histogramBucketCount', c_uint),
+        ('histogramMin', c_double),
+        ('histogramMax', c_double),
+        ('response', c_dcgmSummaryResponse_v2),
+    ]
+
+dcgmFieldSummaryRequest_version2 = make_dcgm_version(c_dcgmFieldSummaryRequest_v2, 2)
+
 # Module IDs
 DcgmModuleIdCore           = 0  # Core DCGM
 DcgmModuleIdNvSwitch       = 1  # NvSwitch Module
@@ -2330,6 +2574,28 @@ class c_dcgmModuleGetStatuses_v1(_PrintableStructure):
 
 dcgmModuleGetStatuses_version1 = make_dcgm_version(c_dcgmModuleGetStatuses_v1, 1)
 
+# Module load policies
+DcgmModuleLoadOnDemand = 0 # Module is loaded by the first request that needs it
+DcgmModuleLoadPrewarm  = 1 # Module is loaded in the background once the host engine serves requests
+
+class c_dcgmModuleGetStatusesModule_v2(_PrintableStructure):
+    _fields_ = [
+        ('id', c_uint32),           #One of DcgmModuleId*
+        ('status', c_uint32),       #One of DcgmModuleStatus*
+        ('loadPolicy', c_uint32),   #One of DcgmModuleLoad*
+        ('unused', c_uint32),
+        ('initTimeUsec', c_int64),  #Time spent loading the module in usec. 0 if not loaded
+    ]
+
+class c_dcgmModuleGetStatuses_v2(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint),
+        ('numStatuses', c_uint32),
+        ('statuses', c_dcgmModuleGetStatusesModule_v2 * DCGM_MODULE_STATUSES_CAPACITY),
+    ]
+
+dcgmModuleGetStatuses_version2 = make_dcgm_version(c_dcgmModuleGetStatuses_v2, 2)
+
 
 DCGM_PROF_MAX_NUM_GROUPS_V2          = 10 # Maximum number of metric ID groups that can exist in DCGM
 DCGM_PROF_MAX_FIELD_IDS_PER_GROUP_V2 = 64 # Maximum number of field IDs that can be in a single DCGM profiling metric group
@@ -2353,6 +2619,21 @@ class c_dcgmProfGetMetricGroups_v3(_PrintableStructure):
 
 dcgmProfGetMetricGroups_version3 = make_dcgm_version(c_dcgmProfGetMetricGroups_v3, 3)
 
+DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS = 64 # Maximum number of fields dcgmProfGetMultiplexInfo can report
+
+class c_dcgmProfMultiplexInfo_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('groupId', c_void_p),
+        ('numPasses', c_uint32),
+        ('windowUsec', c_int64),
+        ('numFieldIds', c_uint32),
+        ('fieldIds', c_ushort * DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS),
+        ('sampledFraction', c_double * DCGM_PROF_MAX_MULTIPLEX_FIELD_IDS),
+    ]
+
+dcgmProfMultiplexInfo_version1 = make_dcgm_version(c_dcgmProfMultiplexInfo_v1, 1)
+
 class c_dcgmVersionInfo_v2(_PrintableStructure):
     _fields_ = [
         ('version', c_uint32),
@@ -2382,3 +2663,21 @@ class c_dcgmDiagStatus_v1(_PrintableStructure):
     ]
 dcgmDiagStatus_version1 = make_dcgm_version(c_dcgmDiagStatus_v1, 1)
 dcgmDiagStatus_version = dcgmDiagStatus_version1
+
+class c_dcgmDiagTestCompletion_v1(_PrintableStructure):
+    _fields_ = [
+        ('version', c_uint32),
+        ('totalTests', c_uint32),
+        ('completedTests', c_uint32),
+        ('testName', c_char * DCGM_DIAG_TEST_RUN_NAME_LEN),
+        ('pluginName', c_char * DCGM_DIAG_TEST_RUN_NAME_LEN),
+        ('result', c_int),
+        ('numErrors', c_ubyte),
+        ('numInfo', c_ubyte),
+        ('numResults', c_ushort),
+        ('errors', c_dcgmDiagError_v1 * DCGM_DIAG_TEST_RUN_ERROR_INDICES_MAX),
+        ('info', c_dcgmDiagInfo_v1 * DCGM_DIAG_TEST_RUN_INFO_INDICES_MAX),
+        ('results', c_dcgmDiagEntityResult_v1 * DCGM_DIAG_TEST_RUN_RESULTS_MAX),
+    ]
+dcgmDiagTestCompletion_version1 = make_dcgm_version(c_dcgmDiagTestCompletion_v1, 1)
+dcgmDiagTestCompletion_version = dcgmDiagTestCompletion_version1
@@ -102,6 +102,7 @@ DcgmWatcherTypePolicyManager    = 3 # Watcher is NvcmPolicyMgr
 DcgmWatcherTypeCacheManager     = 4 # Watcher is DcgmCacheManager
 DcgmWatcherTypeConfigManager    = 5 # Watcher is NvcmConfigMgr
 DcgmWatcherTypeNvSwitchManager  = 6 # Watcher is NvSwitchManager
+DcgmWatcherTypeDiagManager      = 7 # Watcher is DcgmDiagManager
 
 
 # ID of a remote client connection within the host engine
@@ -171,3 +172,4 @@ DcgmEntityStatusLost         = 4  # Entity has been lost. Usually set from NVML
 DcgmEntityStatusFake         = 5  # Entity is a fake, injection-only entity for testing
 DcgmEntityStatusDisabled     = 6  # Don't collect values from this GPU
 DcgmEntityStatusDetached     = 7  # Entity is detached, not good for any uses
+DcgmEntityStatusQuarantined  = 8  # Driver calls to the GPU keep timing out. Only a periodic probe updates its fields
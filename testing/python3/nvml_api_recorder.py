@@ -44,6 +44,7 @@ GPU_INSTANCE = "GpuInstance"
 COMPUTE_INSTANCE = "ComputeInstance"
 MIG_DEVICE = "MigDevice"
 GPM = "GPM"
+REPLAY = "Replay"
 
 def run_nvml_func(func, *args, **kwargs):
     try:
@@ -1646,7 +1647,7 @@ class NVMLApiRecorder(object):
         for mig_device_uuid, mig_device in self._mig_devices_collector:
             self._attrs[MIG_DEVICE][mig_device_uuid] = self._get_device_attrs(mig_device, mig_device_uuid)
 
-    def record(self, out_file_path):
+    def _record_all(self):
         self._record_global_attr()
         self._record_devices_funcs()
         self._record_vgpu_types_funcs()
@@ -1656,10 +1657,52 @@ class NVMLApiRecorder(object):
         self._record_compute_instance()
         self._record_mig_devices_funcs()
 
+    def record(self, out_file_path):
+        self._record_all()
+
         # print(self._attrs)
         with open(out_file_path, "w") as outfile:
             yaml.dump(self._attrs, outfile)
 
+    def record_replay(self, out_file_path, duration_sec, interval_sec, keys=None):
+        """
+        Record like record(), then sample the devices every interval_sec for duration_sec. Each key whose value
+        changes goes into the Replay section as one sample per change, for nvml-injection to play back.
+        keys limits the sampled keys, which keeps each sample short. All device keys are sampled if None.
+        """
+        self._record_all()
+
+        device_samples = {uuid: [] for uuid in self._attrs[DEVICE]}
+        start = time.monotonic()
+        while True:
+            sample_time = time.monotonic() - start
+            if sample_time >= duration_sec:
+                break
+            for uuid in device_samples:
+                nvml_device = nvmlDeviceGetHandleByUUID(uuid)
+                attrs = self._get_device_attrs(nvml_device, uuid)
+                if keys is not None:
+                    attrs = {key: attrs[key] for key in keys if key in attrs}
+                device_samples[uuid].append((sample_time, attrs))
+            time.sleep(max(0, interval_sec - (time.monotonic() - start - sample_time)))
+
+        replay_devices = {}
+        for uuid, samples in device_samples.items():
+            tracks = {}
+            for key in samples[0][1] if samples else []:
+                track = []
+                for sample_time, attrs in samples:
+                    value = attrs.get(key)
+                    if not track or value != track[-1]["Value"]:
+                        track.append({"Time": round(sample_time, 6), "Value": value})
+                if len(track) > 1:
+                    tracks[key] = track
+            replay_devices[uuid] = tracks
+
+        self._attrs[REPLAY] = {"Duration": duration_sec, DEVICE: replay_devices}
+        with open(out_file_path, "w") as outfile:
+            yaml.dump(self._attrs, outfile)
+
     def captured_funcs_list(self):
         funcs = []
         for func in self._nvml_global_attr_funcs:
@@ -1735,5 +1778,18 @@ class NVMLApiRecorder(object):
         return has_not_handled
 
 if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Record NVML for nvml-injection")
+    parser.add_argument("--output", default="out.yaml")
+    parser.add_argument("--replay-duration", type=float, default=0,
+                        help="Seconds to sample the devices for the Replay section. No Replay section if 0")
+    parser.add_argument("--replay-interval", type=float, default=1.0, help="Seconds between samples")
+    parser.add_argument("--replay-keys", nargs="*", default=None, help="Device keys to sample. All if not given")
+    args = parser.parse_args()
+
     with NVMLApiRecorder() as recorder:
-        recorder.record("out.yaml")
+        if args.replay_duration > 0:
+            recorder.record_replay(args.output, args.replay_duration, args.replay_interval, args.replay_keys)
+        else:
+            recorder.record(args.output)
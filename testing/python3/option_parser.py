@@ -177,6 +177,43 @@ def parse_options():
             )
     parser.add_option_group(debug_group)
 
+    perf_group = OptionGroup(parser, "Performance suite")
+    perf_group.add_option(
+            "--perf-suite",
+            dest="perf_suite",
+            action="store_true",
+            default=False,
+            help="Run the host engine overhead scenarios of test_perf_suite and compare them to --perf-baseline"
+            )
+    perf_group.add_option(
+            "--perf-baseline",
+            dest="perf_baseline",
+            default="perf_baseline.json",
+            help="Baseline file of the performance suite. Scenarios missing from it are added to it"
+            )
+    perf_group.add_option(
+            "--perf-update-baseline",
+            dest="perf_update_baseline",
+            action="store_true",
+            default=False,
+            help="Overwrite --perf-baseline with the results of this run instead of comparing to it"
+            )
+    perf_group.add_option(
+            "--perf-tolerance",
+            dest="perf_tolerance",
+            type="float",
+            default=10.0,
+            help="Percent a metric may exceed its baseline by before it is reported as a regression"
+            )
+    perf_group.add_option(
+            "--perf-duration",
+            dest="perf_duration",
+            type="int",
+            default=60,
+            help="Seconds each performance suite scenario runs for"
+            )
+    parser.add_option_group(perf_group)
+
     parser.add_option(
             "--no-library-check",
             dest="no_library_check",
@@ -309,6 +346,11 @@ class OptionParserStub():
         self.ignore_loadavg_checks = False
         self.ignore_mem_checks = False
         self.ignore_init_diag = False
+        self.perf_suite = False
+        self.perf_baseline = "perf_baseline.json"
+        self.perf_update_baseline = False
+        self.perf_tolerance = 10.0
+        self.perf_duration = 60
 
 def initialize_as_stub():
     """
@@ -0,0 +1,218 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# Measures what the host engine costs while a client workload runs and compares it to a baseline file.
+# Used by tests/test_perf_suite.py when run_tests.py is started with --perf-suite
+import json
+import math
+import os
+import time
+
+import dcgm_agent
+import logger
+import option_parser
+import stats
+
+BASELINE_FORMAT_VERSION = 1
+
+# Every metric is lower-is-better. A metric regresses once it exceeds its baseline by the tolerance plus
+# this much, so that metrics near 0 don't flag on noise. Keyed by the metric's unit suffix
+_ABSOLUTE_SLACK = {
+    '_pct'  : 0.5,
+    '_usec' : 50.0,
+    '_kb'   : 4096.0,
+    '_bytes': 1024.0 * 1024.0,
+    '_count': 1.0,
+}
+
+def percentile(samples, pct):
+    '''Nearest-rank percentile of samples. 0 if there are none'''
+    if not samples:
+        return 0
+    ordered = sorted(samples)
+    rank = max(1, int(math.ceil(pct / 100.0 * len(ordered))))
+    return ordered[rank - 1]
+
+def read_rss_kb(pid):
+    '''Resident set size of pid in KiB. None if it can't be read'''
+    try:
+        with open('/proc/%d/status' % pid) as f:
+            for line in f:
+                if line.startswith('VmRSS:'):
+                    return int(line.split()[1])
+    except (IOError, OSError, ValueError):
+        pass
+    return None
+
+class HostengineSampler(object):
+    '''
+    Periodically samples the host engine's CPU use per thread and its RSS, and snapshots the cache manager's
+    runtime stats at the start and end of a scenario
+    '''
+    def __init__(self, handle, pid=None):
+        self._handle = handle
+        self._pid = pid
+        self._cpuTotal = []
+        self._cpuByThread = {}
+        self._rssKb = []
+        self._cacheBytes = []
+        self._startStats = None
+        self._endStats = None
+
+    def Start(self):
+        self._startStats = dcgm_agent.dcgmIntrospectGetRuntimeStats(self._handle)
+
+    def Sample(self):
+        cpuUtil = dcgm_agent.dcgmIntrospectGetHostengineCpuUtilization(self._handle)
+        self._cpuTotal.append(cpuUtil.total * 100.0)
+        for i in range(cpuUtil.numThreadUtils):
+            thread = cpuUtil.threads[i]
+            name = thread.name.decode('utf-8', 'replace') if isinstance(thread.name, bytes) else thread.name
+            self._cpuByThread.setdefault(name, []).append(thread.total * 100.0)
+
+        memUsage = dcgm_agent.dcgmIntrospectGetHostengineMemoryUsage(self._handle)
+        self._cacheBytes.append(memUsage.bytesUsed)
+
+        if self._pid is not None:
+            rssKb = read_rss_kb(self._pid)
+            if rssKb is not None:
+                self._rssKb.append(rssKb)
+
+    def Stop(self):
+        self._endStats = dcgm_agent.dcgmIntrospectGetRuntimeStats(self._handle)
+
+    def GetMetrics(self):
+        metrics = {
+            'cpu_total_pct'   : stats.mean(self._cpuTotal),
+            'cache_max_bytes' : max(self._cacheBytes) if self._cacheBytes else 0,
+        }
+        for name, samples in self._cpuByThread.items():
+            metrics['cpu_thread_%s_pct' % name] = stats.mean(samples)
+        if self._rssKb:
+            metrics['rss_max_kb'] = max(self._rssKb)
+            metrics['rss_growth_kb'] = self._rssKb[-1] - self._rssKb[0]
+
+        start, end = self._startStats, self._endStats
+        if start is not None and end is not None:
+            cycles = end.updateCycles - start.updateCycles
+            awakeUsec = end.awakeTimeUsec - start.awakeTimeUsec
+            metrics['update_cycle_mean_usec'] = awakeUsec / cycles if cycles > 0 else 0
+            metrics['sleeps_skipped_count'] = end.numSleepsSkipped - start.numSleepsSkipped
+            metrics['lock_contended_wait_usec'] = end.lockContendedWaitUsec - start.lockContendedWaitUsec
+        return metrics
+
+def run_scenario(handle, pid, pollFn, pollIntervalSec, durationSec=None):
+    '''
+    Call pollFn every pollIntervalSec for durationSec while sampling the host engine once a second.
+    durationSec defaults to --perf-duration
+
+    Returns a dict of metric name -> value, including the latency percentiles of pollFn
+    '''
+    if durationSec is None:
+        durationSec = option_parser.options.perf_duration
+
+    sampler = HostengineSampler(handle, pid)
+    latenciesUsec = []
+
+    sampler.Start()
+    # Let the first CPU measurement interval start with the workload
+    sampler.Sample()
+
+    start = time.time()
+    nextPoll = start
+    nextSample = start + 1.0
+    while time.time() - start < durationSec:
+        now = time.time()
+        if now >= nextPoll:
+            callStart = time.perf_counter()
+            pollFn()
+            latenciesUsec.append((time.perf_counter() - callStart) * 1000000.0)
+            nextPoll += pollIntervalSec
+        if now >= nextSample:
+            sampler.Sample()
+            nextSample += 1.0
+        time.sleep(max(0, min(nextPoll, nextSample) - time.time()))
+
+    sampler.Stop()
+
+    metrics = sampler.GetMetrics()
+    metrics['api_p50_usec'] = percentile(latenciesUsec, 50)
+    metrics['api_p95_usec'] = percentile(latenciesUsec, 95)
+    metrics['api_p99_usec'] = percentile(latenciesUsec, 99)
+    return metrics
+
+def _absolute_slack(metricName):
+    for suffix, slack in _ABSOLUTE_SLACK.items():
+        if metricName.endswith(suffix):
+            return slack
+    return 0.0
+
+def find_regressions(metrics, baseline, tolerancePct):
+    '''
+    Returns a list of messages, one per metric of metrics that exceeds its value in baseline by more than
+    tolerancePct percent. Metrics that aren't in baseline are not compared
+    '''
+    regressions = []
+    for name in sorted(metrics):
+        if name not in baseline:
+            continue
+        limit = baseline[name] * (1.0 + tolerancePct / 100.0) + _absolute_slack(name)
+        if metrics[name] > limit:
+            regressions.append("%s is %.2f. The baseline is %.2f and the limit %.2f"
+                               % (name, metrics[name], baseline[name], limit))
+    return regressions
+
+def load_baseline(path):
+    '''Returns scenario name -> metrics of the baseline at path. Empty if there is no file yet'''
+    if not os.path.isfile(path):
+        return {}
+    with open(path) as f:
+        baseline = json.load(f)
+    if baseline.get('version') != BASELINE_FORMAT_VERSION:
+        raise ValueError("Baseline %s has version %s. Expected %d"
+                         % (path, baseline.get('version'), BASELINE_FORMAT_VERSION))
+    return baseline.get('scenarios', {})
+
+def save_baseline(path, scenarios):
+    with open(path, 'w') as f:
+        json.dump({ 'version' : BASELINE_FORMAT_VERSION, 'scenarios' : scenarios }, f, indent=4, sort_keys=True)
+
+def record_scenario(scenario, metrics):
+    '''
+    Compare the metrics of scenario to the baseline file and fail if any regressed past --perf-tolerance.
+    The scenario's baseline is written instead if --perf-update-baseline was given or it has none yet
+    '''
+    options = option_parser.options
+    for name in sorted(metrics):
+        logger.info("%s: %s = %.2f" % (scenario, name, metrics[name]))
+
+    if logger.log_dir:
+        resultsPath = os.path.join(logger.log_dir, 'perf_suite_results.json')
+        results = {}
+        if os.path.isfile(resultsPath):
+            with open(resultsPath) as f:
+                results = json.load(f)
+        results[scenario] = metrics
+        with open(resultsPath, 'w') as f:
+            json.dump(results, f, indent=4, sort_keys=True)
+
+    scenarios = load_baseline(options.perf_baseline)
+    if options.perf_update_baseline or scenario not in scenarios:
+        logger.info("Writing the baseline of %s to %s" % (scenario, options.perf_baseline))
+        scenarios[scenario] = metrics
+        save_baseline(options.perf_baseline, scenarios)
+        return
+
+    regressions = find_regressions(metrics, scenarios[scenario], options.perf_tolerance)
+    assert not regressions, "%s regressed beyond %.1f%%: %s" \
+        % (scenario, options.perf_tolerance, "; ".join(regressions))
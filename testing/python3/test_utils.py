@@ -1236,7 +1236,7 @@ class RunClientInitShutdown:
         self.persistAfterDisconnect = persistAfterDisconnect
 
     def __enter__(self):
-        connectParams = dcgm_structs.c_dcgmConnectV2Params_v1()
+        connectParams = dcgm_structs.c_dcgmConnectV2Params_v4()
         if self.persistAfterDisconnect:
             connectParams.persistAfterDisconnect = 1
         else:
@@ -2378,6 +2378,20 @@ def run_with_developer_mode(msg="Use developer mode to enable this test."):
         return wrapper
     return decorator
 
+def run_only_in_perf_suite():
+    """
+    Run test only when the performance suite was requested with --perf-suite.
+    """
+    def decorator(fn):
+        @wraps(fn)
+        def wrapper(*args, **kwds):
+            if not option_parser.options.perf_suite:
+                skip_test("Use --perf-suite to enable this test.")
+            fn(*args, **kwds)
+            return
+        return wrapper
+    return decorator
+
 def are_any_nvlinks_down(handle):
     handleObj = pydcgm.DcgmHandle(handle=handle)
     systemObj = handleObj.GetSystem()
@@ -265,12 +265,12 @@ def test_dcgm_config_powerbudget_standalone(handle, gpuIds):
     """
     helper_dcgm_config_powerbudget(handle, gpuIds)
 
-def helper_verify_power_value(groupObj, expected_power):
+def helper_verify_power_value(groupObj, expected_power, configType=dcgm_structs.DCGM_CONFIG_CURRENT_STATE):
     """
     Helper Method to verify power value
     """
     gpuIds = groupObj.GetGpuIds()
-    config_values = groupObj.config.Get(dcgm_structs.DCGM_CONFIG_CURRENT_STATE)
+    config_values = groupObj.config.Get(configType)
     assert len(config_values) > 0, "Failed to get configuration using dcgmClientConfigGet"
 
     for x in range(0, len(gpuIds)):
@@ -324,8 +324,9 @@ def helper_test_config_config_power_enforce(handle, gpuIds):
     assert 0 == apps.NvidiaSmiApp(["-pl", str(powerLimit_set_nvsmi), "-i", str(gpuIds[0])]).run(), \
         "Nvidia smi couldn't set the power limit"
 
+    ## DCGM only samples the current config periodically. Read it live to see the change right away
     logger.info("Verify if nvsmi configured value has taken effect")
-    helper_verify_power_value(groupObj, powerLimit_set_nvsmi)
+    helper_verify_power_value(groupObj, powerLimit_set_nvsmi, dcgm_structs.DCGM_CONFIG_CURRENT_STATE_LIVE)
 
     groupObj.config.Enforce()
 
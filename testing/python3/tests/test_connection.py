@@ -101,7 +101,7 @@ def test_dcgm_connection_client_cleanup(handle, gpuIds):
     fieldGroupFieldIds = [dcgm_fields.DCGM_FI_DEV_GPU_TEMP, ]
     
     #Get a 2nd connection which we'll check for cleanup. Use the raw APIs so we can explicitly cleanup
-    connectParams = dcgm_structs.c_dcgmConnectV2Params_v1()
+    connectParams = dcgm_structs.c_dcgmConnectV2Params_v4()
     connectParams.version = dcgm_structs.c_dcgmConnectV2Params_version
     connectParams.persistAfterDisconnect = 0
     cleanupHandle = dcgm_agent.dcgmConnect_v2('localhost', connectParams)
@@ -144,13 +144,49 @@ def test_dcgm_connection_versions(handle):
     #These APIs throw exceptions on error
     v2Handle = dcgm_agent.dcgmConnect_v2(localhostStr, v2Struct, dcgm_structs.c_dcgmConnectV2Params_version2)
 
+    v3Struct = dcgm_structs.c_dcgmConnectV2Params_v3()
+    v3Struct.version = dcgm_structs.c_dcgmConnectV2Params_version3
+    #These APIs throw exceptions on error
+    v3Handle = dcgm_agent.dcgmConnect_v2(localhostStr, v3Struct, dcgm_structs.c_dcgmConnectV2Params_version3)
+
     #Do a basic request with each handle
     gpuIds = dcgm_agent.dcgmGetAllSupportedDevices(v1Handle)
     gpuIds2 = dcgm_agent.dcgmGetAllSupportedDevices(v2Handle)
+    gpuIds3 = dcgm_agent.dcgmGetAllSupportedDevices(v3Handle)
 
     #Clean up the handles
     dcgm_agent.dcgmDisconnect(v1Handle)
     dcgm_agent.dcgmDisconnect(v2Handle)
+    dcgm_agent.dcgmDisconnect(v3Handle)
+
+@test_utils.run_with_standalone_host_engine(20)
+def test_dcgm_connection_metadata_cache(handle):
+    '''
+    Test that a connection that caches metadata sees changes made by another connection
+    '''
+    connectParams = dcgm_structs.c_dcgmConnectV2Params_v4()
+    connectParams.version = dcgm_structs.c_dcgmConnectV2Params_version
+    connectParams.metadataCache = 1
+    cachingHandle = dcgm_agent.dcgmConnect_v2('127.0.0.1', connectParams)
+
+    try:
+        fieldIds = [dcgm_fields.DCGM_FI_DEV_GPU_TEMP, ]
+        fieldGroupId = dcgm_agent.dcgmFieldGroupCreate(handle, fieldIds, 'metadatacachefieldgroup')
+
+        #The second call is answered from the cache
+        for i in range(2):
+            fieldGroupInfo = dcgm_agent.dcgmFieldGroupGetInfo(cachingHandle, fieldGroupId)
+            assert fieldGroupInfo.numFieldIds == 1, fieldGroupInfo.numFieldIds
+            assert fieldGroupInfo.fieldIds[0] == dcgm_fields.DCGM_FI_DEV_GPU_TEMP
+
+        dcgm_agent.dcgmFieldGroupDestroy(handle, fieldGroupId)
+
+        time.sleep(0.5) #The change is pushed to the caching connection asynchronously
+
+        with test_utils.assert_raises(dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_NO_DATA)):
+            dcgm_agent.dcgmFieldGroupGetInfo(cachingHandle, fieldGroupId)
+    finally:
+        dcgm_agent.dcgmDisconnect(cachingHandle)
 
 
 def _test_connection_helper(domainSocketName):
@@ -193,6 +193,25 @@ def test_multiple_xid_errors(handle, gpuIds):
                                          map(lambda errIdx: response.errors[errIdx], test.errorIndices[:min(test.numErrors, dcgm_structs.DCGM_DIAG_TEST_RUN_ERROR_INDICES_MAX)])))
     assert num_errors == 2, "Expected 2 errors but found %d" % (num_errors)
 
+@test_utils.run_with_standalone_host_engine(120)
+@test_utils.run_with_injection_gpus(2)
+def test_dcgm_run_diagnostic_with_callback(handle, gpuIds):
+    dd = DcgmDiag.DcgmDiag(gpuIds=gpuIds, testNamesStr=TEST_DIAGNOSTIC, paramsStr='diagnostic.test_duration=5')
+    dd.UseFakeGpus()
+
+    completions = []
+    def onTestCompleted(completion, userData):
+        completions.append((completion.testName, completion.completedTests, completion.totalTests, completion.result))
+
+    response = dcgm_agent.dcgmRunDiagnosticWithCallback(handle, dd.GetStruct(), onTestCompleted)
+
+    tests = { test.name : test for test in response.tests[:min(response.numTests, dcgm_structs.DCGM_DIAG_RESPONSE_TESTS_MAX)] }
+    assert TEST_DIAGNOSTIC in [ name for name, _, _, _ in completions ], "No completion for %s: %s" % (TEST_DIAGNOSTIC, completions)
+    for name, completed, total, result in completions:
+        assert name in tests, "Completion of '%s' isn't in the response" % name
+        assert result == tests[name].result, "Test '%s' completed with %d but ended with %d" % (name, result, tests[name].result)
+        assert completed <= total, "Completed %d of %d tests" % (completed, total)
+
 """
 @test_utils.run_with_injection_nvml()
 @test_utils.run_with_embedded_host_engine()
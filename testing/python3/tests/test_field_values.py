@@ -159,6 +159,173 @@ def helper_dcgm_values_since(handle, gpuIds):
     assert numRead > 0, "Expected callbacks to be called from dcgmEngineGetValuesSince"
     assert secondReadSize > firstReadSize, "Expected more records. 2nd %d. 1st %d" % (secondReadSize, firstReadSize)
 
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_field_values_since_columns(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    gpuId = gpuIds[0]
+    groupObj.AddGpu(gpuId)
+
+    fieldIds = [dcgm_fields.DCGM_FI_DEV_POWER_USAGE, dcgm_fields.DCGM_FI_DEV_GPU_TEMP, dcgm_fields.DCGM_FI_DEV_NAME]
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", fieldIds)
+    groupObj.samples.WatchFields(fieldGroupObj, 1000000, 86400.0, 0)
+
+    #Start with arrays that are too small so that they have to grow
+    columns = dcgm_field_helpers.DcgmFieldValueColumns(handle, groupObj.GetId(), capacity=1)
+    columns.GetAllSinceLastCall(fieldGroupObj)
+
+    now = get_usec_since_1970()
+    numValues = 10
+    for i in range(numValues):
+        fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+        fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+        fv.fieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+        fv.fieldType = ord(dcgm_fields.DCGM_FT_DOUBLE)
+        fv.ts = now + i
+        fv.value.dbl = 100.0 + i
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+        fv.fieldId = dcgm_fields.DCGM_FI_DEV_GPU_TEMP
+        fv.fieldType = ord(dcgm_fields.DCGM_FT_INT64)
+        fv.value.i64 = 40 + i
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    fv.fieldId = dcgm_fields.DCGM_FI_DEV_NAME
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_STRING)
+    fv.value.str = b"injected"
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    count = columns.GetAllSinceLastCall(fieldGroupObj)
+    assert count >= 2 * numValues, "count %d < %d" % (count, 2 * numValues)
+    assert len(columns) == count
+
+    power = []
+    temp = []
+    for i in range(count):
+        assert columns.entityGroupIds[i] == dcgm_fields.DCGM_FE_GPU
+        assert columns.entityIds[i] == gpuId
+        if columns.timestamps[i] < now:
+            continue
+        if columns.fieldIds[i] == dcgm_fields.DCGM_FI_DEV_POWER_USAGE:
+            assert columns.fieldTypes[i] == ord(dcgm_fields.DCGM_FT_DOUBLE)
+            assert dcgmvalue.DCGM_INT64_IS_BLANK(columns.int64Values[i])
+            power.append((columns.timestamps[i], columns.doubleValues[i]))
+        else:
+            assert columns.fieldIds[i] == dcgm_fields.DCGM_FI_DEV_GPU_TEMP, "Unexpected fieldId %d" % columns.fieldIds[i]
+            assert columns.fieldTypes[i] == ord(dcgm_fields.DCGM_FT_INT64)
+            temp.append((columns.timestamps[i], columns.int64Values[i]))
+
+    assert power == [(now + i, 100.0 + i) for i in range(numValues)], str(power)
+    assert temp == [(now + i, 40 + i) for i in range(numValues)], str(temp)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(2)
+def test_dcgm_get_resampled_values(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    for gpuId in gpuIds:
+        groupObj.AddGpu(gpuId)
+
+    fieldIds = [dcgm_fields.DCGM_FI_DEV_POWER_USAGE, dcgm_fields.DCGM_FI_DEV_GPU_TEMP, dcgm_fields.DCGM_FI_DEV_NAME]
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", fieldIds)
+    groupObj.samples.WatchFields(fieldGroupObj, 3600 * 1000000, 86400.0, 0)
+
+    #A sample every 10 seconds, in the future so that the update loop can't add any in between
+    now = get_usec_since_1970() + 3600 * 1000000
+    step = 10 * 1000000
+    for gpuId in gpuIds:
+        for i in range(3):
+            fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+            fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+            fv.fieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+            fv.fieldType = ord(dcgm_fields.DCGM_FT_DOUBLE)
+            fv.ts = now + i * step
+            fv.value.dbl = 100.0 * (i + 1) + gpuId
+            dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+            fv.fieldId = dcgm_fields.DCGM_FI_DEV_GPU_TEMP
+            fv.fieldType = ord(dcgm_fields.DCGM_FT_INT64)
+            fv.value.i64 = 40 + i
+            dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    #Rows halfway between the samples. The string field gets no column
+    columns, rows = dcgm_agent.dcgmGetResampledValues(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId,
+                                                      now + step // 2, now + 2 * step, step,
+                                                      dcgm_structs.DCGM_RESAMPLE_FILL_LINEAR)
+    expectedColumns = []
+    for gpuId in gpuIds:
+        expectedColumns.append((dcgm_fields.DCGM_FE_GPU, gpuId, dcgm_fields.DCGM_FI_DEV_POWER_USAGE))
+        expectedColumns.append((dcgm_fields.DCGM_FE_GPU, gpuId, dcgm_fields.DCGM_FI_DEV_GPU_TEMP))
+    assert columns == expectedColumns, str(columns)
+    assert len(rows) == 2, str(rows)
+    for gpuIndex, gpuId in enumerate(gpuIds):
+        assert rows[0][2 * gpuIndex] == 150.0 + gpuId, str(rows)
+        assert rows[0][2 * gpuIndex + 1] == 40.5, str(rows)
+        assert rows[1][2 * gpuIndex] == 250.0 + gpuId, str(rows)
+        assert rows[1][2 * gpuIndex + 1] == 41.5, str(rows)
+
+    columns, rows = dcgm_agent.dcgmGetResampledValues(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId,
+                                                      now + step // 2, now + 3 * step, step,
+                                                      dcgm_structs.DCGM_RESAMPLE_FILL_PREVIOUS)
+    assert len(rows) == 3, str(rows)
+    assert [row[1] for row in rows] == [40, 41, 42], str(rows)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_export_values(handle, gpuIds):
+    import tempfile
+    gpuId = gpuIds[0]
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    groupObj.AddGpu(gpuId)
+
+    fieldIds = [dcgm_fields.DCGM_FI_DEV_POWER_USAGE, dcgm_fields.DCGM_FI_DEV_GPU_TEMP, dcgm_fields.DCGM_FI_DEV_NAME]
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, "my_field_group", fieldIds)
+    groupObj.samples.WatchFields(fieldGroupObj, 3600 * 1000000, 86400.0, 0)
+
+    #Samples in the past, since the export only covers values that were cached when it started
+    start = get_usec_since_1970() - 100 * 1000000
+    for i in range(5):
+        fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+        fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+        fv.fieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+        fv.fieldType = ord(dcgm_fields.DCGM_FT_DOUBLE)
+        fv.ts = start + i
+        fv.value.dbl = 100.0 + i
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+        fv.fieldId = dcgm_fields.DCGM_FI_DEV_GPU_TEMP
+        fv.fieldType = ord(dcgm_fields.DCGM_FT_INT64)
+        fv.value.i64 = 40 + i
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    fv.fieldId = dcgm_fields.DCGM_FI_DEV_NAME
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_STRING)
+    fv.ts = start + 1
+    fv.value.str = b"injected"
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, fv)
+
+    with tempfile.TemporaryDirectory() as tempDir:
+        filename = os.path.join(tempDir, "export.arrow")
+        #The last sample of each field is after endTime. The string value is skipped
+        exportValues = dcgm_agent.dcgmExportValues(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId, filename,
+                                                   startTime=start, endTime=start + 3)
+        assert exportValues.numValues == 8, exportValues.numValues
+        assert exportValues.numSkipped == 1, exportValues.numSkipped
+
+        with open(filename, "rb") as exportFile:
+            data = exportFile.read()
+        assert data[:8] == b"ARROW1\0\0" and data[-6:] == b"ARROW1", data[:8]
+
+        #A file that can't be written fails the export
+        with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_GENERIC_ERROR)):
+            dcgm_agent.dcgmExportValues(handle, groupObj.GetId(), fieldGroupObj.fieldGroupId,
+                                        os.path.join(tempDir, "missing", "export.arrow"))
+
 @test_utils.run_with_embedded_host_engine()
 @test_utils.run_only_with_live_gpus()
 def test_dcgm_values_since_agent(handle, gpuIds):
@@ -1046,6 +1213,93 @@ def test_dcgm_device_attributes_bad_gpuid(handle, gpuIds):
     for gpuId in gpuIds:
         gpuAttrib = systemObj.discovery.GetGpuAttributes(gpuId)
 
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_update_fields_only_updates_field_group(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    gpuId = gpuIds[0]
+    groupObj.AddGpu(gpuId)
+
+    updatedFieldId = dcgm_fields.DCGM_FI_DEV_POWER_USAGE
+    otherFieldId = dcgm_fields.DCGM_FI_DEV_GPU_TEMP
+    updatedFieldGroup = pydcgm.DcgmFieldGroup(handleObj, "updated_fields", [updatedFieldId, ])
+    otherFieldGroup = pydcgm.DcgmFieldGroup(handleObj, "other_fields", [otherFieldId, ])
+
+    #Long enough that the update loop won't sample either field during the test
+    updateFreq = 3600 * 1000000
+    groupObj.samples.WatchFields(updatedFieldGroup, updateFreq, 86400.0, 0)
+    groupObj.samples.WatchFields(otherFieldGroup, updateFreq, 86400.0, 0)
+    dcgm_agent.dcgmUpdateAllFields(handle, 1)
+
+    def count_samples(fieldId):
+        return len(dcgm_agent_internal.dcgmGetMultipleValuesForField(
+            handle, gpuId, fieldId, 100, 0, 0, dcgm_structs.DCGM_ORDER_ASCENDING))
+
+    updatedBefore = count_samples(updatedFieldId)
+    otherBefore = count_samples(otherFieldId)
+
+    dcgm_agent.dcgmUpdateFields(handle, groupObj.GetId(), updatedFieldGroup.fieldGroupId, 1)
+
+    assert count_samples(updatedFieldId) == updatedBefore + 1, \
+        "%d != %d + 1" % (count_samples(updatedFieldId), updatedBefore)
+    assert count_samples(otherFieldId) == otherBefore, "%d != %d" % (count_samples(otherFieldId), otherBefore)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(2)
+def test_dcgm_snapshot_fields_share_timestamp(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+    groupObj = systemObj.GetEmptyGroup("test1")
+    for gpuId in gpuIds:
+        groupObj.AddGpu(gpuId)
+
+    fieldIds = [dcgm_fields.DCGM_FI_DEV_POWER_USAGE, dcgm_fields.DCGM_FI_DEV_GPU_TEMP]
+    fieldGroup = pydcgm.DcgmFieldGroup(handleObj, "snapshot_fields", fieldIds)
+
+    #Long enough that the update loop won't sample the fields during the test
+    updateFreq = 3600 * 1000000
+    groupObj.samples.WatchFields(fieldGroup, updateFreq, 86400.0, 0)
+    dcgm_agent.dcgmUpdateAllFields(handle, 1)
+
+    firstId = dcgm_agent.dcgmSnapshotFields(handle, groupObj.GetId(), fieldGroup.fieldGroupId)
+    snapshotId = dcgm_agent.dcgmSnapshotFields(handle, groupObj.GetId(), fieldGroup.fieldGroupId)
+    assert snapshotId > firstId, "%d <= %d" % (snapshotId, firstId)
+
+    for gpuId in gpuIds:
+        for fieldId in fieldIds:
+            values = dcgm_agent_internal.dcgmGetMultipleValuesForField(
+                handle, gpuId, fieldId, 1, 0, 0, dcgm_structs.DCGM_ORDER_DESCENDING)
+            assert len(values) == 1, "gpuId %d fieldId %d has no samples" % (gpuId, fieldId)
+            assert values[0].ts == snapshotId, \
+                "gpuId %d fieldId %d: %d != %d" % (gpuId, fieldId, values[0].ts, snapshotId)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_only_with_live_gpus()
+def test_dcgm_all_device_attributes(handle, gpuIds):
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    systemObj = handleObj.GetSystem()
+
+    allAttrib = systemObj.discovery.GetAllGpuAttributes()
+
+    for gpuId in gpuIds:
+        assert gpuId in allAttrib, "GPU %d is missing from %s" % (gpuId, str(list(allAttrib.keys())))
+
+        #Reading twice also exercises the host engine's cache of static attributes
+        for gpuAttrib in (systemObj.discovery.GetGpuAttributes(gpuId), systemObj.discovery.GetGpuAttributes(gpuId)):
+            bulkAttrib = allAttrib[gpuId]
+            assert bulkAttrib.identifiers.uuid == gpuAttrib.identifiers.uuid, \
+                "%s != %s" % (bulkAttrib.identifiers.uuid, gpuAttrib.identifiers.uuid)
+            assert bulkAttrib.identifiers.pciBusId == gpuAttrib.identifiers.pciBusId, \
+                "%s != %s" % (bulkAttrib.identifiers.pciBusId, gpuAttrib.identifiers.pciBusId)
+            assert bulkAttrib.identifiers.deviceName == gpuAttrib.identifiers.deviceName, \
+                "%s != %s" % (bulkAttrib.identifiers.deviceName, gpuAttrib.identifiers.deviceName)
+            assert bulkAttrib.identifiers.driverVersion == gpuAttrib.identifiers.driverVersion, \
+                "%s != %s" % (bulkAttrib.identifiers.driverVersion, gpuAttrib.identifiers.driverVersion)
+            assert bulkAttrib.clockSets.count == gpuAttrib.clockSets.count, \
+                "%d != %d" % (bulkAttrib.clockSets.count, gpuAttrib.clockSets.count)
+
 
 @test_utils.run_with_embedded_host_engine()
 @test_utils.run_only_with_live_gpus()
@@ -366,3 +366,151 @@ def test_dcgm_injection_summaries_embedded(handle, gpuIds):
 
 
 
+
+def helper_make_entity_fv(gpuId, fieldId, ts, i64):
+    fv = dcgm_structs.c_dcgmFieldValue_v2()
+    fv.version = dcgm_structs.dcgmFieldValue_version2
+    fv.entityGroupId = dcgm_fields.DCGM_FE_GPU
+    fv.entityId = gpuId
+    fv.fieldId = fieldId
+    fv.fieldType = ord(dcgm_fields.DCGM_FT_INT64)
+    fv.status = 0
+    fv.ts = ts
+    fv.value.i64 = i64
+    return fv
+
+def helper_test_dcgm_injection_batch(handle, gpuIds):
+    fieldIds = [dcgm_fields.DCGM_FI_DEV_XID_ERRORS, dcgm_fields.DCGM_FI_DEV_ECC_CURRENT]
+    NinjectValues = 1000 #Enough to take several requests to the host engine
+
+    numSamplesBefore = {}
+    for gpuId in gpuIds:
+        for fieldId in fieldIds:
+            dcgm_agent_internal.dcgmWatchFieldValue(handle, gpuId, fieldId, 1, 3600.0, 10000)
+            fieldInfo = dcgm_agent_internal.dcgmGetCacheManagerFieldInfo(handle, gpuId, dcgm_fields.DCGM_FE_GPU, fieldId)
+            numSamplesBefore[(gpuId, fieldId)] = fieldInfo.numSamples
+
+    baseTime = get_usec_since_1970()
+    values = []
+    for i in range(NinjectValues):
+        for gpuId in gpuIds:
+            for fieldId in fieldIds:
+                values.append(helper_make_entity_fv(gpuId, fieldId, baseTime + i, i))
+
+    dcgm_agent_internal.dcgmInjectEntityFieldValues(handle, values)
+
+    for gpuId in gpuIds:
+        for fieldId in fieldIds:
+            fieldInfo = dcgm_agent_internal.dcgmGetCacheManagerFieldInfo(handle, gpuId, dcgm_fields.DCGM_FE_GPU, fieldId)
+            expected = numSamplesBefore[(gpuId, fieldId)] + NinjectValues
+            assert fieldInfo.numSamples == expected, "Expected %d samples. Got %d" % (expected, fieldInfo.numSamples)
+
+    #A bad value anywhere keeps the whole batch out
+    badValues = [helper_make_entity_fv(gpuIds[0], fieldIds[0], baseTime + NinjectValues, 1),
+                 helper_make_entity_fv(dcgm_structs.DCGM_MAX_NUM_DEVICES, fieldIds[0], baseTime + NinjectValues, 1)]
+    with test_utils.assert_raises(dcgmExceptionClass(dcgm_structs.DCGM_ST_BADPARAM)):
+        dcgm_agent_internal.dcgmInjectEntityFieldValues(handle, badValues)
+
+    fieldInfo = dcgm_agent_internal.dcgmGetCacheManagerFieldInfo(handle, gpuIds[0], dcgm_fields.DCGM_FE_GPU, fieldIds[0])
+    expected = numSamplesBefore[(gpuIds[0], fieldIds[0])] + NinjectValues
+    assert fieldInfo.numSamples == expected, "Expected %d samples. Got %d" % (expected, fieldInfo.numSamples)
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(2)
+def test_dcgm_injection_batch_embedded(handle, gpuIds):
+    """
+    Verifies that a batch of values for several GPUs and fields can be injected at once
+    """
+    helper_test_dcgm_injection_batch(handle, gpuIds)
+
+@test_utils.run_with_standalone_host_engine()
+@test_utils.run_with_injection_gpus(2)
+def test_dcgm_injection_batch_standalone(handle, gpuIds):
+    """
+    Verifies that a batch of values for several GPUs and fields can be injected at once
+    """
+    helper_test_dcgm_injection_batch(handle, gpuIds)
+
+def helper_make_inject_fv(fieldId, fieldType, ts, value):
+    fv = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+    fv.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+    fv.fieldId = fieldId
+    fv.status = 0
+    fv.fieldType = ord(fieldType)
+    fv.ts = ts
+    if fieldType == dcgm_fields.DCGM_FT_DOUBLE:
+        fv.value.dbl = value
+    else:
+        fv.value.i64 = value
+    return fv
+
+def helper_test_dcgm_injection_derived_fields(handle, gpuIds):
+    gpuId = gpuIds[0]
+
+    #Watching a derived field watches its inputs
+    for fieldId in [dcgm_fields.DCGM_FI_DEV_PCIE_REPLAY_RATE, dcgm_fields.DCGM_FI_DEV_POWER_USAGE_PERCENT]:
+        dcgm_agent_internal.dcgmWatchFieldValue(handle, gpuId, fieldId, 1000000, 3600.0, 0)
+
+    baseTime = get_usec_since_1970()
+
+    #A rate needs two samples of its counter
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, helper_make_inject_fv(
+        dcgm_fields.DCGM_FI_DEV_PCIE_REPLAY_COUNTER, dcgm_fields.DCGM_FT_INT64, baseTime, 10))
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, helper_make_inject_fv(
+        dcgm_fields.DCGM_FI_DEV_PCIE_REPLAY_COUNTER, dcgm_fields.DCGM_FT_INT64, baseTime + 2000000, 30))
+
+    #A ratio is evaluated when its numerator is updated
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, helper_make_inject_fv(
+        dcgm_fields.DCGM_FI_DEV_ENFORCED_POWER_LIMIT, dcgm_fields.DCGM_FT_DOUBLE, baseTime, 300.0))
+    dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, helper_make_inject_fv(
+        dcgm_fields.DCGM_FI_DEV_POWER_USAGE, dcgm_fields.DCGM_FT_DOUBLE, baseTime + 1, 150.0))
+
+    values = dcgm_agent_internal.dcgmGetLatestValuesForFields(handle, gpuId,
+        [dcgm_fields.DCGM_FI_DEV_PCIE_REPLAY_RATE, dcgm_fields.DCGM_FI_DEV_POWER_USAGE_PERCENT])
+    assert values[0].status == dcgm_structs.DCGM_ST_OK, "Got status %d" % values[0].status
+    assert values[0].ts == baseTime + 2000000, "Got ts %d" % values[0].ts
+    assert values[0].value.dbl == 10.0, "Expected 10 replays/sec. Got %f" % values[0].value.dbl
+    assert values[1].status == dcgm_structs.DCGM_ST_OK, "Got status %d" % values[1].status
+    assert values[1].value.dbl == 50.0, "Expected 50%%. Got %f" % values[1].value.dbl
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_injection_derived_fields_embedded(handle, gpuIds):
+    """
+    Verifies that derived fields are computed from injected values of their inputs
+    """
+    helper_test_dcgm_injection_derived_fields(handle, gpuIds)
+
+def helper_test_dcgm_injection_clocks_event_durations(handle, gpuIds):
+    gpuId = gpuIds[0]
+    reasonsFieldId = dcgm_fields.DCGM_FI_DEV_CLOCKS_EVENT_REASONS
+
+    durationFieldIds = [dcgm_fields.DCGM_FI_DEV_CLOCKS_EVENT_SW_THERMAL_TIME,
+                        dcgm_fields.DCGM_FI_DEV_CLOCKS_EVENT_SW_POWER_CAP_TIME]
+    for fieldId in durationFieldIds:
+        dcgm_agent_internal.dcgmWatchFieldValue(handle, gpuId, fieldId, 1000000, 3600.0, 0)
+
+    baseTime = get_usec_since_1970()
+
+    #Thermal for 2 seconds, then power capped for 1 second
+    reasons = [(0, dcgm_fields.DCGM_CLOCKS_EVENT_REASON_SW_THERMAL),
+               (2000000, dcgm_fields.DCGM_CLOCKS_EVENT_REASON_SW_POWER_CAP),
+               (3000000, 0)]
+    for offset, value in reasons:
+        dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, helper_make_inject_fv(
+            reasonsFieldId, dcgm_fields.DCGM_FT_INT64, baseTime + offset, value))
+
+    values = dcgm_agent_internal.dcgmGetLatestValuesForFields(handle, gpuId, durationFieldIds)
+    for value in values:
+        assert value.status == dcgm_structs.DCGM_ST_OK, "Got status %d" % value.status
+        assert value.ts == baseTime + 3000000, "Got ts %d" % value.ts
+    assert values[0].value.dbl == 2.0, "Expected 2 seconds thermal. Got %f" % values[0].value.dbl
+    assert values[1].value.dbl == 1.0, "Expected 1 second power capped. Got %f" % values[1].value.dbl
+
+@test_utils.run_with_embedded_host_engine()
+@test_utils.run_with_injection_gpus(1)
+def test_dcgm_injection_clocks_event_durations_embedded(handle, gpuIds):
+    """
+    Verifies that the time spent in each clocks event reason is accumulated from injected reasons
+    """
+    helper_test_dcgm_injection_clocks_event_durations(handle, gpuIds)
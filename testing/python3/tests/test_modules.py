@@ -39,6 +39,8 @@ def test_dcgm_modules_get_statuses(handle):
         #because creating default groups causes a RPC to the NvSwitch manager
         if ms.statuses[i].id != dcgm_structs.DcgmModuleIdNvSwitch:
             assert ms.statuses[i].status == dcgm_structs.DcgmModuleStatusNotLoaded, "%d != %d" % (ms.statuses[i].status, dcgm_structs.DcgmModuleStatusNotLoaded)
+            assert ms.statuses[i].initTimeUsec == 0, "%d != 0" % ms.statuses[i].initTimeUsec
+        assert ms.statuses[i].loadPolicy == dcgm_structs.DcgmModuleLoadOnDemand, "%d != %d" % (ms.statuses[i].loadPolicy, dcgm_structs.DcgmModuleLoadOnDemand)
 
 @test_utils.run_with_embedded_host_engine()
 def test_dcgm_modules_in_use_introspection(handle):
@@ -55,6 +57,7 @@ def test_dcgm_modules_in_use_introspection(handle):
     #Make sure the module was loaded
     ms = dcgmSystem.modules.GetStatuses()
     assert ms.statuses[moduleId].status == dcgm_structs.DcgmModuleStatusLoaded, "%d != %d" % (ms.statuses[moduleId].status, dcgm_structs.DcgmModuleStatusLoaded)
+    assert ms.statuses[moduleId].initTimeUsec > 0, "%d <= 0" % ms.statuses[moduleId].initTimeUsec
     
     #Make sure we can't add the module to the denylist after it's loaded
     with test_utils.assert_raises(dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_IN_USE)):
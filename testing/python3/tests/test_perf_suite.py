@@ -0,0 +1,158 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.  All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# Host engine overhead scenarios. Only run with --perf-suite. See perf_suite.py
+from ctypes import CFUNCTYPE, POINTER, c_uint64
+
+import dcgm_agent
+import dcgm_fields
+import dcgm_structs
+import option_parser
+import perf_suite
+import pydcgm
+import test_utils
+
+# The fields dcgm-exporter watches by default
+EXPORTER_FIELD_IDS = [
+    dcgm_fields.DCGM_FI_DEV_SM_CLOCK,
+    dcgm_fields.DCGM_FI_DEV_MEM_CLOCK,
+    dcgm_fields.DCGM_FI_DEV_MEMORY_TEMP,
+    dcgm_fields.DCGM_FI_DEV_GPU_TEMP,
+    dcgm_fields.DCGM_FI_DEV_POWER_USAGE,
+    dcgm_fields.DCGM_FI_DEV_TOTAL_ENERGY_CONSUMPTION,
+    dcgm_fields.DCGM_FI_DEV_PCIE_REPLAY_COUNTER,
+    dcgm_fields.DCGM_FI_DEV_GPU_UTIL,
+    dcgm_fields.DCGM_FI_DEV_MEM_COPY_UTIL,
+    dcgm_fields.DCGM_FI_DEV_ENC_UTIL,
+    dcgm_fields.DCGM_FI_DEV_DEC_UTIL,
+    dcgm_fields.DCGM_FI_DEV_XID_ERRORS,
+    dcgm_fields.DCGM_FI_DEV_FB_FREE,
+    dcgm_fields.DCGM_FI_DEV_FB_USED,
+    dcgm_fields.DCGM_FI_DEV_FB_RESERVED,
+    dcgm_fields.DCGM_FI_DEV_NVLINK_BANDWIDTH_TOTAL,
+    dcgm_fields.DCGM_FI_DEV_UNCORRECTABLE_REMAPPED_ROWS,
+    dcgm_fields.DCGM_FI_DEV_CORRECTABLE_REMAPPED_ROWS,
+    dcgm_fields.DCGM_FI_DEV_ROW_REMAP_FAILURE,
+]
+
+# The fields dcgmi dmon shows by default
+DMON_FIELD_IDS = [
+    dcgm_fields.DCGM_FI_DEV_POWER_USAGE,
+    dcgm_fields.DCGM_FI_DEV_GPU_TEMP,
+    dcgm_fields.DCGM_FI_DEV_SM_CLOCK,
+    dcgm_fields.DCGM_FI_DEV_GPU_UTIL,
+]
+
+MIG_SLICES = 7
+
+@CFUNCTYPE(None, POINTER(dcgm_structs.c_dcgmPolicyCallbackResponse_v2), c_uint64)
+def _ignore_policy_violation(response, userData):
+    pass
+
+def helper_watched_fields_scenario(scenario, handle, hostengineApp, groupObj, fieldIds, updateFreqUsec):
+    '''Watch fieldIds of groupObj every updateFreqUsec and read their latest values as often'''
+    handleObj = pydcgm.DcgmHandle(handle=handle)
+    fieldGroupObj = pydcgm.DcgmFieldGroup(handleObj, scenario, fieldIds)
+    groupObj.samples.WatchFields(fieldGroupObj, updateFreqUsec, 3600.0, 0)
+
+    metrics = perf_suite.run_scenario(handle,
+                                      hostengineApp.getpid(),
+                                      lambda: groupObj.samples.GetLatest(fieldGroupObj),
+                                      updateFreqUsec / 1000000.0)
+    perf_suite.record_scenario(scenario, metrics)
+
+def test_perf_suite_find_regressions():
+    baseline = { 'cpu_total_pct' : 10.0, 'api_p99_usec' : 1000.0, 'rss_max_kb' : 100000 }
+
+    # Within the tolerance, or only over it by less than the absolute slack
+    metrics = { 'cpu_total_pct' : 11.4, 'api_p99_usec' : 1140.0, 'rss_max_kb' : 110000, 'new_usec' : 5.0 }
+    assert perf_suite.find_regressions(metrics, baseline, 10.0) == []
+
+    metrics = { 'cpu_total_pct' : 11.6, 'api_p99_usec' : 1200.0, 'rss_max_kb' : 110000 }
+    regressions = perf_suite.find_regressions(metrics, baseline, 10.0)
+    assert len(regressions) == 2, regressions
+    assert regressions[0].startswith('api_p99_usec'), regressions
+    assert regressions[1].startswith('cpu_total_pct'), regressions
+
+    assert perf_suite.percentile([], 99) == 0
+    assert perf_suite.percentile(list(range(1, 101)), 50) == 50
+    assert perf_suite.percentile(list(range(1, 101)), 99) == 99
+    assert perf_suite.percentile([7], 95) == 7
+
+@test_utils.run_only_in_perf_suite()
+@test_utils.run_with_standalone_host_engine(passAppAsArg=True)
+@test_utils.run_only_with_live_gpus()
+def test_perf_suite_exporter_1s(handle, gpuIds, hostengineApp):
+    groupObj = pydcgm.DcgmHandle(handle=handle).GetSystem().GetGroupWithGpuIds('perf_exporter', gpuIds)
+    helper_watched_fields_scenario('exporter_1s', handle, hostengineApp, groupObj, EXPORTER_FIELD_IDS, 1000000)
+
+@test_utils.run_only_in_perf_suite()
+@test_utils.run_with_standalone_host_engine(passAppAsArg=True)
+@test_utils.run_only_with_live_gpus()
+def test_perf_suite_dmon_100ms(handle, gpuIds, hostengineApp):
+    groupObj = pydcgm.DcgmHandle(handle=handle).GetSystem().GetGroupWithGpuIds('perf_dmon', gpuIds)
+    helper_watched_fields_scenario('dmon_100ms', handle, hostengineApp, groupObj, DMON_FIELD_IDS, 100000)
+
+@test_utils.run_only_in_perf_suite()
+@test_utils.run_with_standalone_host_engine(passAppAsArg=True)
+@test_utils.run_only_with_live_gpus()
+def test_perf_suite_health_policy(handle, gpuIds, hostengineApp):
+    groupObj = pydcgm.DcgmHandle(handle=handle).GetSystem().GetGroupWithGpuIds('perf_health', gpuIds)
+    groupObj.health.Set(dcgm_structs.DCGM_HEALTH_WATCH_ALL)
+    conditions = dcgm_structs.DCGM_POLICY_COND_DBE | dcgm_structs.DCGM_POLICY_COND_PCI \
+                 | dcgm_structs.DCGM_POLICY_COND_XID | dcgm_structs.DCGM_POLICY_COND_THERMAL \
+                 | dcgm_structs.DCGM_POLICY_COND_POWER
+    groupObj.policy.Register(conditions, _ignore_policy_violation)
+
+    metrics = perf_suite.run_scenario(handle, hostengineApp.getpid(), lambda: groupObj.health.Check(), 1.0)
+    perf_suite.record_scenario('health_policy', metrics)
+
+@test_utils.run_only_in_perf_suite()
+@test_utils.run_with_standalone_host_engine(passAppAsArg=True)
+@test_utils.run_only_with_live_gpus()
+def test_perf_suite_job_stats(handle, gpuIds, hostengineApp):
+    '''
+    Job stats keep their samples for as long as the job runs. Use --perf-duration to run this for hours
+    '''
+    groupObj = pydcgm.DcgmHandle(handle=handle).GetSystem().GetGroupWithGpuIds('perf_job_stats', gpuIds)
+    groupObj.stats.WatchJobFields(1000000, option_parser.options.perf_duration + 3600.0, 0)
+    jobId = "perf_suite_job"
+    groupObj.stats.StartJobStats(jobId)
+
+    metrics = perf_suite.run_scenario(handle, hostengineApp.getpid(), lambda: groupObj.stats.GetJobStats(jobId), 10.0)
+    groupObj.stats.StopJobStats(jobId)
+    perf_suite.record_scenario('job_stats', metrics)
+
+@test_utils.run_only_in_perf_suite()
+@test_utils.run_with_standalone_host_engine(passAppAsArg=True)
+@test_utils.run_only_with_live_gpus()
+@test_utils.run_only_if_mig_is_enabled()
+def test_perf_suite_mig_7_slice(handle, gpuIds, hostengineApp):
+    hierarchy = dcgm_agent.dcgmGetGpuInstanceHierarchy(handle)
+    instancesByGpu = {}
+    for i in range(hierarchy.count):
+        info = hierarchy.entityList[i]
+        if info.entity.entityGroupId == dcgm_fields.DCGM_FE_GPU_I:
+            instancesByGpu.setdefault(info.parent.entityId, []).append(info.entity.entityId)
+
+    slicedGpus = [ gpuId for gpuId, instances in instancesByGpu.items() if len(instances) == MIG_SLICES ]
+    if not slicedGpus:
+        test_utils.skip_test("Needs a GPU split into %d GPU instances" % MIG_SLICES)
+
+    groupObj = pydcgm.DcgmHandle(handle=handle).GetSystem().GetEmptyGroup('perf_mig')
+    for gpuId in slicedGpus:
+        groupObj.AddGpu(gpuId)
+        for instanceId in instancesByGpu[gpuId]:
+            groupObj.AddEntity(dcgm_fields.DCGM_FE_GPU_I, instanceId)
+
+    helper_watched_fields_scenario('mig_7_slice', handle, hostengineApp, groupObj, EXPORTER_FIELD_IDS, 1000000)
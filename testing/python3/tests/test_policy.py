@@ -326,6 +326,68 @@ def helper_dcgm_policy_inject_pcierror(handle, gpuIds):
 def test_dcgm_policy_inject_pcierror_standalone(handle, gpuIds):
     helper_dcgm_policy_inject_pcierror(handle, gpuIds)
 
+def helper_dcgm_policy_batched_pcierrors(handle, gpuIds):
+    """
+    Verifies that violations of several GPUs reach a batched registration, and that its rate limit drops
+    the ones beyond it
+    """
+    newPolicy = dcgm_structs.c_dcgmPolicy_v1()
+
+    newPolicy.version = dcgm_structs.dcgmPolicy_version1
+    newPolicy.condition = dcgm_structs.DCGM_POLICY_COND_PCI
+    newPolicy.parms[dcgm_structs.DCGM_POLICY_COND_IDX_PCI].tag = 1
+    newPolicy.parms[dcgm_structs.DCGM_POLICY_COND_IDX_PCI].val.llval = 0
+
+    group = pydcgm.DcgmGroup(pydcgm.DcgmHandle(handle), groupName="test1", groupType=dcgm_structs.DCGM_GROUP_EMPTY)
+    for gpuId in gpuIds:
+        group.AddGpu(gpuId)
+    group.policy.Set(newPolicy)
+
+    callbackQueue = queue.Queue()
+    c_callback = create_c_callback(callbackQueue)
+    maxPerConditionPerSec = len(gpuIds) - 1
+    group.policy.RegisterBatched(dcgm_structs.DCGM_POLICY_COND_PCI, c_callback,
+                                 coalesceWindowMs=500, maxPerConditionPerSec=maxPerConditionPerSec)
+
+    field = dcgm_structs_internal.c_dcgmInjectFieldValue_v1()
+    field.version = dcgm_structs_internal.dcgmInjectFieldValue_version1
+    field.fieldId = dcgm_fields.DCGM_FI_DEV_PCIE_REPLAY_COUNTER
+    field.status = 0
+    field.fieldType = ord(dcgm_fields.DCGM_FT_INT64)
+    field.ts = int((time.time()+60) * 1000000.0) # set the injected data into the future
+    field.value.i64 = 1
+
+    for gpuId in gpuIds:
+        ret = dcgm_agent_internal.dcgmInjectFieldValue(handle, gpuId, field)
+        assert (ret == dcgm_structs.DCGM_ST_OK)
+
+    seenGpuIds = set()
+    for i in range(maxPerConditionPerSec):
+        try:
+            callbackResp = callbackQueue.get(timeout=POLICY_CALLBACK_TIMEOUT_SECS)
+        except queue.Empty:
+            assert False, "Callback %d of %d never happened" % (i + 1, maxPerConditionPerSec)
+        callbackQueue.get() # userData
+
+        assert(dcgm_structs.DCGM_POLICY_COND_PCI == callbackResp.condition), \
+                ("PCI error callback was not for a PCI error, got: %s" % callbackResp.condition)
+        seenGpuIds.add(callbackResp.gpuId)
+
+    assert len(seenGpuIds) == maxPerConditionPerSec, "Expected callbacks for %d GPUs but got %s" % \
+            (maxPerConditionPerSec, seenGpuIds)
+
+    # The violation beyond the rate limit was dropped
+    try:
+        callbackResp = callbackQueue.get(timeout=2)
+        assert False, "Got a callback for gpuId %d beyond the rate limit" % callbackResp.gpuId
+    except queue.Empty:
+        pass
+
+@test_utils.run_with_standalone_host_engine(40)
+@test_utils.run_with_injection_gpus(gpuCount=3)
+def test_dcgm_policy_batched_pcierrors_standalone(handle, gpuIds):
+    helper_dcgm_policy_batched_pcierrors(handle, gpuIds)
+
 @test_utils.run_with_standalone_host_engine(40)
 @test_utils.run_with_injection_gpus()
 def test_dcgm_policy_inject_retiredpages_standalone(handle, gpuIds):
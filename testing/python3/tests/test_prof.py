@@ -264,22 +264,35 @@ def test_dcgm_prof_watch_multipass(handle, gpuIds):
         dcgmGroup.samples.UnwatchFields(fieldGroup)
         fieldGroup.Delete()
 
+        assert dcgmGroup.profiling.GetMultiplexInfo().numPasses == 0
+
     if len(mpFieldIds) <= DLG_MAX_METRIC_GROUPS:
-        test_utils.skip_test("Skipping multipass failure test since there are %d <= %d multipass groups." %
+        test_utils.skip_test("Skipping multiplexing test since there are %d <= %d multipass groups." %
                              (len(mpFieldIds), DLG_MAX_METRIC_GROUPS))
 
+    #Watches that don't fit in the profiling module's passes are time-multiplexed by the host engine
     for i in range(DLG_MAX_METRIC_GROUPS+1, len(mpFieldIds)+1):
         fieldIds = []
         for j in range(i):
             fieldIds.extend(mpFieldIds[j])
 
-        logger.info("Negative testing multipass fieldIds %s" % str(fieldIds))
+        logger.info("Multiplexing multipass fieldIds %s" % str(fieldIds))
 
         fieldGroup = pydcgm.DcgmFieldGroup(dcgmHandle, "my_field_group_%d" % i, fieldIds)
 
-        with test_utils.assert_raises(dcgm_structs.dcgmExceptionClass(dcgm_structs.DCGM_ST_PROFILING_MULTI_PASS)):    
-            dcgmGroup.samples.WatchFields(fieldGroup, 1000000, 3600.0, 0)
-            dcgmGroup.samples.UnwatchFields(fieldGroup)
+        dcgmGroup.samples.WatchFields(fieldGroup, 1000000, 3600.0, 0)
+
+        multiplexInfo = dcgmGroup.profiling.GetMultiplexInfo()
+        assert multiplexInfo.numPasses > 1, "numPasses %d" % multiplexInfo.numPasses
+        assert multiplexInfo.windowUsec >= 1000000, "windowUsec %d" % multiplexInfo.windowUsec
+        assert multiplexInfo.numFieldIds == len(set(fieldIds)), \
+            "numFieldIds %d != %d" % (multiplexInfo.numFieldIds, len(set(fieldIds)))
+        for j in range(multiplexInfo.numFieldIds):
+            assert 0.0 < multiplexInfo.sampledFraction[j] <= 1.0, \
+                "fieldId %d sampledFraction %f" % (multiplexInfo.fieldIds[j], multiplexInfo.sampledFraction[j])
+
+        dcgmGroup.samples.UnwatchFields(fieldGroup)
+        assert dcgmGroup.profiling.GetMultiplexInfo().numPasses == 0
 
         fieldGroup.Delete()
 